@@ -8,6 +8,7 @@
 #include <ExampleBase.h>
 #include <stb/stb_image.h>
 #include <LLGL/Display.h>
+#include <LLGL/Utils/DrawQueue.h>
 
 
 class Example_Instancing : public ExampleBase
@@ -16,6 +17,7 @@ class Example_Instancing : public ExampleBase
     // Static configuration for this demo
     static const std::uint32_t  numPlantInstances   = 20000;
     static const std::uint32_t  numPlantImages      = 10;
+    static const std::uint32_t  numPlantBatches     = 100;
     const float                 positionRange       = 40.0f;
 
     LLGL::Shader*               vertexShader        = nullptr;
@@ -37,6 +39,9 @@ class Example_Instancing : public ExampleBase
 
     LLGL::Sampler*              samplers[2]         = {};
 
+    // Draw queue to sort and merge the draw packets of each frame
+    LLGL::DrawQueue             drawQueue;
+
     float                       viewRotation        = 0.0f;
 
     struct Settings
@@ -376,11 +381,42 @@ private:
                 std::cout << "Alpha-To-Coverage Disabled" << std::endl;
         }
 
-        commands->Begin();
+        // Push plant instances in batches as a culling pass would emit them; the draw queue merges them back into a single instanced draw
+        drawQueue.Clear();
+
+        LLGL::DrawPacket packet;
         {
-            // Set buffer array, texture, and sampler
-            commands->SetVertexBufferArray(*vertexBufferArray);
+            packet.pipelineState        = pipeline[alphaToCoverageEnabled ? 1 : 0];
+            packet.resourceHeap         = resourceHeap;
+            packet.vertexBufferArray    = vertexBufferArray;
+            packet.numVertices          = 4;
+        }
 
+        for (std::uint32_t batch = 0; batch < numPlantBatches; ++batch)
+        {
+            packet.sortKey          = 0;
+            packet.descriptorSet    = 0;
+            packet.firstVertex      = 0;
+            packet.numInstances     = numPlantInstances / numPlantBatches;
+            packet.firstInstance    = batch * packet.numInstances;
+            drawQueue.Push(packet);
+        }
+
+        // Push grass plane (vertices: 4, first vertex: 4, instances: 1, instance offset: numPlantInstances)
+        if (renderer->GetRenderingCaps().features.hasOffsetInstancing)
+        {
+            packet.sortKey          = 1;
+            packet.descriptorSet    = 1;
+            packet.firstVertex      = 4;
+            packet.numInstances     = 1;
+            packet.firstInstance    = numPlantInstances;
+            drawQueue.Push(packet);
+        }
+
+        drawQueue.Sort();
+
+        commands->Begin();
+        {
             // Upload new data to the constant buffer on the GPU
             commands->UpdateBuffer(*constantBuffer, 0, &settings, sizeof(settings));
 
@@ -393,19 +429,8 @@ private:
                 // Set viewport
                 commands->SetViewport(swapChain->GetResolution());
 
-                // Set graphics pipeline state
-                commands->SetPipelineState(*pipeline[alphaToCoverageEnabled ? 1 : 0]);
-
-                // Draw all plant instances (vertices: 4, first vertex: 0, instances: numPlantInstances)
-                commands->SetResourceHeap(*resourceHeap, 0);
-                commands->DrawInstanced(4, 0, numPlantInstances);
-
-                // Draw grass plane (vertices: 4, first vertex: 4, instances: 1, instance offset: numPlantInstances)
-                if (renderer->GetRenderingCaps().features.hasOffsetInstancing)
-                {
-                    commands->SetResourceHeap(*resourceHeap, 1);
-                    commands->DrawInstanced(4, 4, 1, numPlantInstances);
-                }
+                // Encode all sorted and merged draws with pipeline state, vertex buffer array, and resource heap
+                drawQueue.Encode(*commands);
             }
             commands->EndRenderPass();
         }
@@ -18,15 +18,18 @@
 LLGL_C_EXPORT void llglBegin(LLGLCommandBuffer commandBuffer);
 LLGL_C_EXPORT void llglEnd();
 LLGL_C_EXPORT void llglExecute(LLGLCommandBuffer deferredCommandBuffer);
+LLGL_C_EXPORT void llglTrimCommandBufferMemory(LLGLCommandBuffer commandBuffer);
 LLGL_C_EXPORT void llglUpdateBuffer(LLGLBuffer dstBuffer, uint64_t dstOffset, const void* data, uint16_t dataSize);
 LLGL_C_EXPORT void llglCopyBuffer(LLGLBuffer dstBuffer, uint64_t dstOffset, LLGLBuffer srcBuffer, uint64_t srcOffset, uint64_t size);
 LLGL_C_EXPORT void llglCopyBufferFromTexture(LLGLBuffer dstBuffer, uint64_t dstOffset, LLGLTexture srcTexture, const LLGLTextureRegion* srcRegion, uint32_t rowStride, uint32_t layerStride);
 LLGL_C_EXPORT void llglFillBuffer(LLGLBuffer dstBuffer, uint64_t dstOffset, uint32_t value, uint64_t fillSize);
+LLGL_C_EXPORT void llglFillBufferPattern(LLGLBuffer dstBuffer, uint64_t dstOffset, const void* pattern, uint32_t patternSize, uint64_t fillSize);
 LLGL_C_EXPORT void llglCopyTexture(LLGLTexture dstTexture, const LLGLTextureLocation* dstLocation, LLGLTexture srcTexture, const LLGLTextureLocation* srcLocation, const LLGLExtent3D* extent);
 LLGL_C_EXPORT void llglCopyTextureFromBuffer(LLGLTexture dstTexture, const LLGLTextureRegion* dstRegion, LLGLBuffer srcBuffer, uint64_t srcOffset, uint32_t rowStride, uint32_t layerStride);
 LLGL_C_EXPORT void llglCopyTextureFromFramebuffer(LLGLTexture dstTexture, const LLGLTextureRegion* dstRegion, const LLGLOffset2D* srcOffset);
 LLGL_C_EXPORT void llglGenerateMips(LLGLTexture texture);
 LLGL_C_EXPORT void llglGenerateMipsRange(LLGLTexture texture, const LLGLTextureSubresource* subresource);
+LLGL_C_EXPORT void llglCompressTexture(LLGLTexture dstTexture, LLGLTexture srcTexture, const LLGLTextureSubresource* subresource);
 LLGL_C_EXPORT void llglSetViewport(const LLGLViewport* viewport);
 LLGL_C_EXPORT void llglSetViewports(uint32_t numViewports, const LLGLViewport* viewports);
 LLGL_C_EXPORT void llglSetScissor(const LLGLScissor* scissor);
@@ -37,6 +40,7 @@ LLGL_C_EXPORT void llglSetIndexBuffer(LLGLBuffer buffer);
 LLGL_C_EXPORT void llglSetIndexBufferExt(LLGLBuffer buffer, LLGLFormat format, uint64_t offset);
 LLGL_C_EXPORT void llglSetResourceHeap(LLGLResourceHeap resourceHeap, uint32_t descriptorSet);
 LLGL_C_EXPORT void llglSetResource(uint32_t descriptor, LLGLResource resource);
+LLGL_C_EXPORT void llglSetResourceExt(uint32_t descriptor, LLGLBuffer buffer, uint64_t offset, uint64_t size);
 LLGL_C_EXPORT void llglResetResourceSlots(LLGLResourceType resourceType, uint32_t firstSlot, uint32_t numSlots, long bindFlags, long stageFlags);
 LLGL_C_EXPORT void llglBeginRenderPass(LLGLRenderTarget renderTarget);
 LLGL_C_EXPORT void llglBeginRenderPassWithClear(LLGLRenderTarget renderTarget, LLGLRenderPass renderPass, uint32_t numClearValues, const LLGLClearValue* clearValues, uint32_t swapBufferIndex);
@@ -64,14 +68,200 @@ LLGL_C_EXPORT void llglDrawIndirect(LLGLBuffer buffer, uint64_t offset);
 LLGL_C_EXPORT void llglDrawIndirectExt(LLGLBuffer buffer, uint64_t offset, uint32_t numCommands, uint32_t stride);
 LLGL_C_EXPORT void llglDrawIndexedIndirect(LLGLBuffer buffer, uint64_t offset);
 LLGL_C_EXPORT void llglDrawIndexedIndirectExt(LLGLBuffer buffer, uint64_t offset, uint32_t numCommands, uint32_t stride);
+LLGL_C_EXPORT void llglDrawIndirectCount(LLGLBuffer argsBuffer, uint64_t argsOffset, LLGLBuffer countBuffer, uint64_t countOffset, uint32_t maxNumCommands, uint32_t stride);
+LLGL_C_EXPORT void llglDrawIndexedIndirectCount(LLGLBuffer argsBuffer, uint64_t argsOffset, LLGLBuffer countBuffer, uint64_t countOffset, uint32_t maxNumCommands, uint32_t stride);
+LLGL_C_EXPORT void llglDrawMeshTasks(uint32_t numWorkGroupsX, uint32_t numWorkGroupsY, uint32_t numWorkGroupsZ);
+LLGL_C_EXPORT void llglDrawMeshTasksIndirect(LLGLBuffer buffer, uint64_t offset, uint32_t numCommands, uint32_t stride);
+LLGL_C_EXPORT void llglDrawStreamOutput();
 LLGL_C_EXPORT void llglDispatch(uint32_t numWorkGroupsX, uint32_t numWorkGroupsY, uint32_t numWorkGroupsZ);
 LLGL_C_EXPORT void llglDispatchIndirect(LLGLBuffer buffer, uint64_t offset);
+LLGL_C_EXPORT void llglCompactIndirectArguments(LLGLBuffer dstBuffer, uint64_t dstOffset, LLGLBuffer countBuffer, uint64_t countOffset, LLGLBuffer srcBuffer, uint64_t srcOffset, LLGLBuffer visibilityBuffer, uint64_t visibilityOffset, uint32_t numCommands, uint32_t stride);
 LLGL_C_EXPORT void llglPushDebugGroup(const char* name);
 LLGL_C_EXPORT void llglPopDebugGroup();
 LLGL_C_EXPORT void llglDoNativeCommand(const void* nativeCommand, size_t nativeCommandSize);
 LLGL_C_EXPORT bool llglGetNativeHandle(void* nativeHandle, size_t nativeHandleSize);
 
 
+/* ----- Command streams ----- */
+
+/*
+A command stream is a tightly packed array of commands that is decoded and encoded into the current command buffer with a single call to llglExecuteCommandStream.
+Each command begins with an LLGLCommandStreamHeader followed by the command structure that corresponds to its opcode, e.g. LLGLCommandDraw for LLGLCommandOpcodeDraw.
+The 'size' field of the header denotes the size (in bytes) of the entire command including its header and any trailing data and must be a multiple of 8.
+The command stream itself must be 8-byte aligned, so all command structures can be read in place.
+*/
+
+typedef enum LLGLCommandOpcode
+{
+    LLGLCommandOpcodeUpdateBuffer = 1,      /* LLGLCommandUpdateBuffer followed by 'dataSize' bytes. */
+    LLGLCommandOpcodeSetViewport,           /* LLGLCommandSetViewport */
+    LLGLCommandOpcodeSetScissor,            /* LLGLCommandSetScissor */
+    LLGLCommandOpcodeSetVertexBuffer,       /* LLGLCommandSetVertexBuffer */
+    LLGLCommandOpcodeSetVertexBufferArray,  /* LLGLCommandSetVertexBufferArray */
+    LLGLCommandOpcodeSetIndexBuffer,        /* LLGLCommandSetIndexBuffer */
+    LLGLCommandOpcodeSetIndexBufferExt,     /* LLGLCommandSetIndexBufferExt */
+    LLGLCommandOpcodeSetResourceHeap,       /* LLGLCommandSetResourceHeap */
+    LLGLCommandOpcodeSetResource,           /* LLGLCommandSetResource */
+    LLGLCommandOpcodeSetPipelineState,      /* LLGLCommandSetPipelineState */
+    LLGLCommandOpcodeSetUniforms,           /* LLGLCommandSetUniforms followed by 'dataSize' bytes. */
+    LLGLCommandOpcodeDraw,                  /* LLGLCommandDraw */
+    LLGLCommandOpcodeDrawIndexed,           /* LLGLCommandDrawIndexed */
+    LLGLCommandOpcodeDrawInstanced,         /* LLGLCommandDrawInstanced */
+    LLGLCommandOpcodeDrawIndexedInstanced,  /* LLGLCommandDrawIndexedInstanced */
+    LLGLCommandOpcodeDrawIndirect,          /* LLGLCommandDrawIndirect */
+    LLGLCommandOpcodeDrawIndexedIndirect,   /* LLGLCommandDrawIndirect */
+    LLGLCommandOpcodeDispatch,              /* LLGLCommandDispatch */
+    LLGLCommandOpcodeDispatchIndirect,      /* LLGLCommandDispatchIndirect */
+}
+LLGLCommandOpcode;
+
+typedef struct LLGLCommandStreamHeader
+{
+    uint16_t opcode;    /* Command opcode. This is one of the LLGLCommandOpcode entries. */
+    uint16_t reserved;  /* Reserved for future use. Must be zero. */
+    uint32_t size;      /* Size (in bytes) of the entire command including this header. Must be a multiple of 8. */
+}
+LLGLCommandStreamHeader;
+
+typedef struct LLGLCommandUpdateBuffer
+{
+    LLGLBuffer  dstBuffer;
+    uint64_t    dstOffset;
+    uint16_t    dataSize;
+}
+LLGLCommandUpdateBuffer;
+
+typedef struct LLGLCommandSetViewport
+{
+    LLGLViewport viewport;
+}
+LLGLCommandSetViewport;
+
+typedef struct LLGLCommandSetScissor
+{
+    LLGLScissor scissor;
+}
+LLGLCommandSetScissor;
+
+typedef struct LLGLCommandSetVertexBuffer
+{
+    LLGLBuffer buffer;
+}
+LLGLCommandSetVertexBuffer;
+
+typedef struct LLGLCommandSetVertexBufferArray
+{
+    LLGLBufferArray bufferArray;
+}
+LLGLCommandSetVertexBufferArray;
+
+typedef struct LLGLCommandSetIndexBuffer
+{
+    LLGLBuffer buffer;
+}
+LLGLCommandSetIndexBuffer;
+
+typedef struct LLGLCommandSetIndexBufferExt
+{
+    LLGLBuffer  buffer;
+    LLGLFormat  format;
+    uint64_t    offset;
+}
+LLGLCommandSetIndexBufferExt;
+
+typedef struct LLGLCommandSetResourceHeap
+{
+    LLGLResourceHeap    resourceHeap;
+    uint32_t            descriptorSet;
+}
+LLGLCommandSetResourceHeap;
+
+typedef struct LLGLCommandSetResource
+{
+    uint32_t        descriptor;
+    LLGLResource    resource;
+}
+LLGLCommandSetResource;
+
+typedef struct LLGLCommandSetPipelineState
+{
+    LLGLPipelineState pipelineState;
+}
+LLGLCommandSetPipelineState;
+
+typedef struct LLGLCommandSetUniforms
+{
+    uint32_t first;
+    uint16_t dataSize;
+}
+LLGLCommandSetUniforms;
+
+typedef struct LLGLCommandDraw
+{
+    uint32_t numVertices;
+    uint32_t firstVertex;
+}
+LLGLCommandDraw;
+
+typedef struct LLGLCommandDrawIndexed
+{
+    uint32_t numIndices;
+    uint32_t firstIndex;
+    int32_t  vertexOffset;
+}
+LLGLCommandDrawIndexed;
+
+typedef struct LLGLCommandDrawInstanced
+{
+    uint32_t numVertices;
+    uint32_t firstVertex;
+    uint32_t numInstances;
+    uint32_t firstInstance;
+}
+LLGLCommandDrawInstanced;
+
+typedef struct LLGLCommandDrawIndexedInstanced
+{
+    uint32_t numIndices;
+    uint32_t numInstances;
+    uint32_t firstIndex;
+    int32_t  vertexOffset;
+    uint32_t firstInstance;
+}
+LLGLCommandDrawIndexedInstanced;
+
+typedef struct LLGLCommandDrawIndirect
+{
+    LLGLBuffer  buffer;
+    uint64_t    offset;
+    uint32_t    numCommands;
+    uint32_t    stride;
+}
+LLGLCommandDrawIndirect;
+
+typedef struct LLGLCommandDispatch
+{
+    uint32_t numWorkGroupsX;
+    uint32_t numWorkGroupsY;
+    uint32_t numWorkGroupsZ;
+}
+LLGLCommandDispatch;
+
+typedef struct LLGLCommandDispatchIndirect
+{
+    LLGLBuffer  buffer;
+    uint64_t    offset;
+}
+LLGLCommandDispatchIndirect;
+
+/*
+Decodes the specified command stream and encodes all of its commands into the current command buffer, i.e. between llglBegin and llglEnd.
+Decoding stops at the first malformed command or unknown opcode.
+Returns the number of commands that have been encoded.
+*/
+LLGL_C_EXPORT size_t llglExecuteCommandStream(const void* commands, size_t commandsSize);
+
+
 #endif
 
 
@@ -10,16 +10,22 @@
 
 
 #include <LLGL-C/Export.h>
-#include <LLGL-C/Types.h>
+#include <LLGL-C/LLGLWrapper.h>
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
 
 
 LLGL_C_EXPORT void llglSubmitCommandBuffer(LLGLCommandBuffer commandBuffer);
+LLGL_C_EXPORT void llglUpdateTextureTileMappings(LLGLTexture texture, uint32_t numMappings, const LLGLTextureTileMapping* mappings);
+LLGL_C_EXPORT void llglUpdateBufferTileMappings(LLGLBuffer buffer, uint32_t numMappings, const LLGLBufferTileMapping* mappings);
 LLGL_C_EXPORT bool llglQueryResult(LLGLQueryHeap queryHeap, uint32_t firstQuery, uint32_t numQueries, void* data, size_t dataSize);
+LLGL_C_EXPORT bool llglGetCalibratedTimestamps(LLGLCalibratedTimestamps* outTimestamps);
 LLGL_C_EXPORT void llglSubmitFence(LLGLFence fence);
+LLGL_C_EXPORT void llglSubmitFenceValue(LLGLFence fence, uint64_t value);
+LLGL_C_EXPORT void llglSubmitWaitFence(LLGLFence fence, uint64_t value);
 LLGL_C_EXPORT bool llglWaitFence(LLGLFence fence, uint64_t timeout);
+LLGL_C_EXPORT bool llglWaitFenceValue(LLGLFence fence, uint64_t value, uint64_t timeout);
 LLGL_C_EXPORT void llglWaitIdle();
 
 
@@ -61,6 +61,14 @@ typedef enum LLGLStencilFace
 }
 LLGLStencilFace;
 
+typedef enum LLGLCommandQueueType
+{
+    LLGLCommandQueueTypeGraphics,
+    LLGLCommandQueueTypeCompute,
+    LLGLCommandQueueTypeCopy,
+}
+LLGLCommandQueueType;
+
 typedef enum LLGLFormat
 {
     LLGLFormatUndefined,
@@ -539,6 +547,27 @@ typedef enum LLGLTessellationPartition
 }
 LLGLTessellationPartition;
 
+typedef enum LLGLShadingRate
+{
+    LLGLShadingRateRate1x1,
+    LLGLShadingRateRate1x2,
+    LLGLShadingRateRate2x1,
+    LLGLShadingRateRate2x2,
+    LLGLShadingRateRate2x4,
+    LLGLShadingRateRate4x2,
+    LLGLShadingRateRate4x4,
+}
+LLGLShadingRate;
+
+typedef enum LLGLShadingRateCombiner
+{
+    LLGLShadingRateCombinerKeep,
+    LLGLShadingRateCombinerReplace,
+    LLGLShadingRateCombinerMin,
+    LLGLShadingRateCombinerMax,
+}
+LLGLShadingRateCombiner;
+
 typedef enum LLGLQueryType
 {
     LLGLQueryTypeSamplesPassed,
@@ -548,6 +577,7 @@ typedef enum LLGLQueryType
     LLGLQueryTypeStreamOutPrimitivesWritten,
     LLGLQueryTypeStreamOutOverflow,
     LLGLQueryTypePipelineStatistics,
+    LLGLQueryTypeTimestamp,
 }
 LLGLQueryType;
 
@@ -642,6 +672,7 @@ typedef enum LLGLResourceType
     LLGLResourceTypeBuffer,
     LLGLResourceTypeTexture,
     LLGLResourceTypeSampler,
+    LLGLResourceTypeAccelerationStructure,
 }
 LLGLResourceType;
 
@@ -671,6 +702,8 @@ typedef enum LLGLShaderType
     LLGLShaderTypeGeometry,
     LLGLShaderTypeFragment,
     LLGLShaderTypeCompute,
+    LLGLShaderTypeTask,
+    LLGLShaderTypeMesh,
 }
 LLGLShaderType;
 
@@ -744,6 +777,16 @@ typedef enum LLGLTextureSwizzle
 }
 LLGLTextureSwizzle;
 
+typedef enum LLGLPresentMode
+{
+    LLGLPresentModeDefault,
+    LLGLPresentModeFifo,
+    LLGLPresentModeFifoRelaxed,
+    LLGLPresentModeMailbox,
+    LLGLPresentModeImmediate,
+}
+LLGLPresentMode;
+
 
 /* ----- Flags ----- */
 
@@ -806,6 +849,19 @@ typedef enum LLGLRenderSystemFlags
 }
 LLGLRenderSystemFlags;
 
+typedef enum LLGLSubgroupOperationFlags
+{
+    LLGLSubgroupOperationBasic           = (1 << 0),
+    LLGLSubgroupOperationVote            = (1 << 1),
+    LLGLSubgroupOperationArithmetic      = (1 << 2),
+    LLGLSubgroupOperationBallot          = (1 << 3),
+    LLGLSubgroupOperationShuffle         = (1 << 4),
+    LLGLSubgroupOperationShuffleRelative = (1 << 5),
+    LLGLSubgroupOperationClustered       = (1 << 6),
+    LLGLSubgroupOperationQuad            = (1 << 7),
+}
+LLGLSubgroupOperationFlags;
+
 typedef enum LLGLBindFlags
 {
     LLGLBindVertexBuffer           = (1 << 0),
@@ -820,6 +876,8 @@ typedef enum LLGLBindFlags
     LLGLBindCombinedSampler        = (1 << 9),
     LLGLBindCopySrc                = (1 << 10),
     LLGLBindCopyDst                = (1 << 11),
+    LLGLBindShadingRateAttachment  = (1 << 12),
+    LLGLBindDeviceAddress          = (1 << 13),
 }
 LLGLBindFlags;
 
@@ -838,6 +896,9 @@ typedef enum LLGLMiscFlags
     LLGLMiscNoInitialData = (1 << 3),
     LLGLMiscAppend        = (1 << 4),
     LLGLMiscCounter       = (1 << 5),
+    LLGLMiscSparse        = (1 << 6),
+    LLGLMiscTransient     = (1 << 7),
+    LLGLMiscHostVisible   = (1 << 8),
 }
 LLGLMiscFlags;
 
@@ -859,6 +920,7 @@ typedef enum LLGLShaderCompileFlags
     LLGLShaderCompileWarningsAreErrors   = (1 << 5),
     LLGLShaderCompilePatchClippingOrigin = (1 << 6),
     LLGLShaderCompileSeparateShader      = (1 << 7),
+    LLGLShaderCompileStripBinary         = (1 << 8),
 }
 LLGLShaderCompileFlags;
 
@@ -870,8 +932,11 @@ typedef enum LLGLStageFlags
     LLGLStageGeometryStage       = (1 << 3),
     LLGLStageFragmentStage       = (1 << 4),
     LLGLStageComputeStage        = (1 << 5),
+    LLGLStageTaskStage           = (1 << 6),
+    LLGLStageMeshStage           = (1 << 7),
     LLGLStageAllTessStages       = (LLGLStageTessControlStage | LLGLStageTessEvaluationStage),
     LLGLStageAllGraphicsStages   = (LLGLStageVertexStage | LLGLStageAllTessStages | LLGLStageGeometryStage | LLGLStageFragmentStage),
+    LLGLStageAllMeshStages       = (LLGLStageTaskStage | LLGLStageMeshStage),
     LLGLStageAllStages           = (LLGLStageAllGraphicsStages | LLGLStageComputeStage),
 }
 LLGLStageFlags;
@@ -904,9 +969,12 @@ LLGLClearValue;
 
 typedef struct LLGLCommandBufferDescriptor
 {
-    long     flags;              /* = 0 */
-    uint32_t numNativeBuffers;   /* = 2 */
-    uint64_t minStagingPoolSize; /* = (0xFFFF+1) */
+    long                 flags;                 /* = 0 */
+    uint32_t             numNativeBuffers;      /* = 2 */
+    uint64_t             minStagingPoolSize;    /* = (0xFFFF+1) */
+    uint32_t             stagingPoolTrimFrames; /* = 120 */
+    LLGLCommandQueueType queueType;             /* = LLGLCommandQueueTypeGraphics */
+    LLGLRenderPass       renderPass;            /* = LLGL_NULL_OBJECT */
 }
 LLGLCommandBufferDescriptor;
 
@@ -944,6 +1012,12 @@ typedef struct LLGLDispatchIndirectArguments
 }
 LLGLDispatchIndirectArguments;
 
+typedef struct LLGLDrawMeshTasksIndirectArguments
+{
+    uint32_t numThreadGroups[3];
+}
+LLGLDrawMeshTasksIndirectArguments;
+
 typedef struct LLGLBindingSlot
 {
     uint32_t index; /* = 0 */
@@ -981,8 +1055,9 @@ LLGLDepthBiasDescriptor;
 
 typedef struct LLGLComputePipelineDescriptor
 {
-    LLGLPipelineLayout pipelineLayout; /* = LLGL_NULL_OBJECT */
-    LLGLShader         computeShader;  /* = LLGL_NULL_OBJECT */
+    LLGLPipelineLayout pipelineLayout;       /* = LLGL_NULL_OBJECT */
+    LLGLShader         computeShader;        /* = LLGL_NULL_OBJECT */
+    uint32_t           requiredSubgroupSize; /* = 0 */
 }
 LLGLComputePipelineDescriptor;
 
@@ -1002,6 +1077,14 @@ typedef struct LLGLQueryPipelineStatistics
 }
 LLGLQueryPipelineStatistics;
 
+typedef struct LLGLCalibratedTimestamps
+{
+    uint64_t cpuTicks;     /* = 0 */
+    uint64_t gpuTimestamp; /* = 0 */
+    uint64_t maxDeviation; /* = 0 */
+}
+LLGLCalibratedTimestamps;
+
 typedef struct LLGLRendererInfo
 {
     const char*        rendererName;
@@ -1036,12 +1119,26 @@ typedef struct LLGLRenderingFeatures
     bool hasInstancing;                /* = false */
     bool hasOffsetInstancing;          /* = false */
     bool hasIndirectDrawing;           /* = false */
+    bool hasIndirectCountDrawing;      /* = false */
     bool hasViewportArrays;            /* = false */
     bool hasConservativeRasterization; /* = false */
     bool hasStreamOutputs;             /* = false */
     bool hasLogicOp;                   /* = false */
     bool hasPipelineStatistics;        /* = false */
     bool hasRenderCondition;           /* = false */
+    bool hasBindlessResources;         /* = false */
+    bool hasSparseResources;           /* = false */
+    bool hasThreadSafeResourceCreation; /* = false */
+    bool hasVariableRateShading;       /* = false */
+    bool hasShadingRateImage;          /* = false */
+    bool hasMeshShaders;               /* = false */
+    bool hasTextureCompression;        /* = false */
+    bool hasSubgroupSizeControl;       /* = false */
+    bool hasNativeIOQueue;             /* = false */
+    bool hasMultiview;                 /* = false */
+    bool hasRayTracing;                /* = false */
+    bool hasIndirectArgumentCompaction; /* = false */
+    bool hasBufferDeviceAddress;       /* = false */
 }
 LLGLRenderingFeatures;
 
@@ -1071,6 +1168,13 @@ typedef struct LLGLRenderingLimits
     uint32_t maxDepthBufferSamples;            /* = 0 */
     uint32_t maxStencilBufferSamples;          /* = 0 */
     uint32_t maxNoAttachmentSamples;           /* = 0 */
+    uint32_t shadingRateImageTileSize;         /* = 0 */
+    uint32_t maxMultiviewViewCount;            /* = 0 */
+    uint32_t minSubgroupSize;                  /* = 0 */
+    uint32_t maxSubgroupSize;                  /* = 0 */
+    long     subgroupOperations;               /* = 0 */
+    long     subgroupStages;                   /* = 0 */
+    uint32_t maxAccelerationStructureInstances; /* = 0 */
 }
 LLGLRenderingLimits;
 
@@ -1079,6 +1183,7 @@ typedef struct LLGLResourceHeapDescriptor
     LLGLPipelineLayout pipelineLayout;   /* = LLGL_NULL_OBJECT */
     uint32_t           numResourceViews; /* = 0 */
     long               barrierFlags;     /* = 0 */
+    uint32_t           numVersions;      /* = 0 */
 }
 LLGLResourceHeapDescriptor;
 
@@ -1089,6 +1194,13 @@ typedef struct LLGLShaderMacro
 }
 LLGLShaderMacro;
 
+typedef struct LLGLShaderSpecializationConstant
+{
+    uint32_t id;    /* = 0 */
+    uint32_t value; /* = 0 */
+}
+LLGLShaderSpecializationConstant;
+
 typedef struct LLGLTextureSubresource
 {
     uint32_t baseArrayLayer; /* = 0 */
@@ -1154,6 +1266,14 @@ typedef struct LLGLBufferViewDescriptor
 }
 LLGLBufferViewDescriptor;
 
+typedef struct LLGLBufferTileMapping
+{
+    uint64_t offset;   /* = 0 */
+    uint64_t size;     /* = 0 */
+    bool     resident; /* = true */
+}
+LLGLBufferTileMapping;
+
 typedef struct LLGLAttachmentClear
 {
     long           flags;           /* = 0 */
@@ -1364,13 +1484,14 @@ LLGLComputeShaderAttributes;
 
 typedef struct LLGLSwapChainDescriptor
 {
-    LLGLExtent2D resolution;
-    int          colorBits;   /* = 32 */
-    int          depthBits;   /* = 24 */
-    int          stencilBits; /* = 8 */
-    uint32_t     samples;     /* = 1 */
-    uint32_t     swapBuffers; /* = 2 */
-    bool         fullscreen;  /* = false */
+    LLGLExtent2D    resolution;
+    int             colorBits;   /* = 32 */
+    int             depthBits;   /* = 24 */
+    int             stencilBits; /* = 8 */
+    uint32_t        samples;     /* = 1 */
+    uint32_t        swapBuffers; /* = 2 */
+    bool            fullscreen;  /* = false */
+    LLGLPresentMode presentMode; /* = LLGLPresentModeDefault */
 }
 LLGLSwapChainDescriptor;
 
@@ -1399,6 +1520,13 @@ typedef struct LLGLTextureRegion
 }
 LLGLTextureRegion;
 
+typedef struct LLGLTextureTileMapping
+{
+    LLGLTextureRegion region;
+    bool              resident; /* = true */
+}
+LLGLTextureTileMapping;
+
 typedef struct LLGLTextureDescriptor
 {
     LLGLTextureType type;        /* = LLGLTextureTypeTexture2D */
@@ -1437,6 +1565,7 @@ typedef struct LLGLWindowDescriptor
     bool         resizable;       /* = false */
     bool         acceptDropFiles; /* = false */
     bool         centered;        /* = false */
+    bool         threadedEvents;  /* = false */
     const void*  windowContext;   /* = NULL */
 }
 LLGLWindowDescriptor;
@@ -1472,6 +1601,13 @@ typedef struct LLGLStencilDescriptor
 }
 LLGLStencilDescriptor;
 
+typedef struct LLGLShadingRateDescriptor
+{
+    LLGLShadingRate         rate;          /* = LLGLShadingRateRate1x1 */
+    LLGLShadingRateCombiner imageCombiner; /* = LLGLShadingRateCombinerKeep */
+}
+LLGLShadingRateDescriptor;
+
 typedef struct LLGLBlendDescriptor
 {
     bool                      alphaToCoverageEnabled;  /* = false */
@@ -1490,6 +1626,7 @@ typedef struct LLGLRenderPassDescriptor
     LLGLAttachmentFormatDescriptor depthAttachment;
     LLGLAttachmentFormatDescriptor stencilAttachment;
     uint32_t                       samples;             /* = 1 */
+    uint32_t                       viewMask;            /* = 0 */
 }
 LLGLRenderPassDescriptor;
 
@@ -1501,6 +1638,7 @@ typedef struct LLGLRenderTargetDescriptor
     LLGLAttachmentDescriptor colorAttachments[8];
     LLGLAttachmentDescriptor resolveAttachments[8];
     LLGLAttachmentDescriptor depthStencilAttachment;
+    LLGLTexture              shadingRateImage;       /* = LLGL_NULL_OBJECT */
 }
 LLGLRenderTargetDescriptor;
 
@@ -1547,6 +1685,7 @@ typedef struct LLGLPipelineLayoutDescriptor
     const LLGLStaticSamplerDescriptor* staticSamplers;    /* = NULL */
     size_t                             numUniforms;       /* = 0 */
     const LLGLUniformDescriptor*       uniforms;          /* = NULL */
+    bool                               bindlessHeap;      /* = false */
 }
 LLGLPipelineLayoutDescriptor;
 
@@ -1559,6 +1698,8 @@ typedef struct LLGLGraphicsPipelineDescriptor
     LLGLShader                 tessEvaluationShader; /* = LLGL_NULL_OBJECT */
     LLGLShader                 geometryShader;       /* = LLGL_NULL_OBJECT */
     LLGLShader                 fragmentShader;       /* = LLGL_NULL_OBJECT */
+    LLGLShader                 taskShader;           /* = LLGL_NULL_OBJECT */
+    LLGLShader                 meshShader;           /* = LLGL_NULL_OBJECT */
     LLGLPrimitiveTopology      primitiveTopology;    /* = LLGLPrimitiveTopologyTriangleList */
     size_t                     numViewports;         /* = 0 */
     const LLGLViewport*        viewports;            /* = NULL */
@@ -1569,6 +1710,8 @@ typedef struct LLGLGraphicsPipelineDescriptor
     LLGLRasterizerDescriptor   rasterizer;
     LLGLBlendDescriptor        blend;
     LLGLTessellationDescriptor tessellation;
+    LLGLShadingRateDescriptor  shadingRate;
+    uint32_t                   viewMask;             /* = 0 */
 }
 LLGLGraphicsPipelineDescriptor;
 
@@ -1583,17 +1726,19 @@ LLGLResourceViewDescriptor;
 
 typedef struct LLGLShaderDescriptor
 {
-    LLGLShaderType               type;       /* = LLGLShaderTypeUndefined */
-    const char*                  source;     /* = NULL */
-    size_t                       sourceSize; /* = 0 */
-    LLGLShaderSourceType         sourceType; /* = LLGLShaderSourceTypeCodeFile */
-    const char*                  entryPoint; /* = NULL */
-    const char*                  profile;    /* = NULL */
-    const LLGLShaderMacro*       defines;    /* = NULL */
-    long                         flags;      /* = 0 */
-    LLGLVertexShaderAttributes   vertex;
-    LLGLFragmentShaderAttributes fragment;
-    LLGLComputeShaderAttributes  compute;
+    LLGLShaderType                          type;                       /* = LLGLShaderTypeUndefined */
+    const char*                             source;                     /* = NULL */
+    size_t                                  sourceSize;                 /* = 0 */
+    LLGLShaderSourceType                    sourceType;                 /* = LLGLShaderSourceTypeCodeFile */
+    const char*                             entryPoint;                 /* = NULL */
+    const char*                             profile;                    /* = NULL */
+    const LLGLShaderMacro*                  defines;                    /* = NULL */
+    long                                    flags;                      /* = 0 */
+    LLGLVertexShaderAttributes              vertex;
+    LLGLFragmentShaderAttributes            fragment;
+    LLGLComputeShaderAttributes             compute;
+    size_t                                  numSpecializationConstants; /* = 0 */
+    const LLGLShaderSpecializationConstant* specializationConstants;    /* = NULL */
 }
 LLGLShaderDescriptor;
 
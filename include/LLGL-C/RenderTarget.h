@@ -20,6 +20,8 @@ LLGL_C_EXPORT uint32_t llglGetRenderTargetNumColorAttachments(LLGLRenderTarget r
 LLGL_C_EXPORT bool llglHasRenderTargetDepthAttachment(LLGLRenderTarget renderTarget);
 LLGL_C_EXPORT bool llglHasRenderTargetStencilAttachment(LLGLRenderTarget renderTarget);
 LLGL_C_EXPORT LLGLRenderPass llglGetRenderTargetRenderPass(LLGLRenderTarget renderTarget);
+LLGL_C_EXPORT void llglSetRenderTargetActiveExtent(LLGLRenderTarget renderTarget, const LLGLExtent2D* extent);
+LLGL_C_EXPORT void llglGetRenderTargetActiveExtent(LLGLRenderTarget renderTarget, LLGLExtent2D* outExtent);
 
 
 #endif
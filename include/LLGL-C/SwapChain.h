@@ -21,6 +21,8 @@ LLGL_C_EXPORT LLGLFormat llglGetColorFormat(LLGLSwapChain swapChain);
 LLGL_C_EXPORT LLGLFormat llglGetDepthStencilFormat(LLGLSwapChain swapChain);
 LLGL_C_EXPORT bool llglResizeBuffers(LLGLSwapChain swapChain, const LLGLExtent2D* resolution, long flags);
 LLGL_C_EXPORT bool llglSetVsyncInterval(LLGLSwapChain swapChain, uint32_t vsyncInterval);
+LLGL_C_EXPORT bool llglSetMaxFrameLatency(LLGLSwapChain swapChain, uint32_t maxFrameLatency);
+LLGL_C_EXPORT bool llglIsPresentModeSupported(LLGLSwapChain swapChain, LLGLPresentMode presentMode);
 LLGL_C_EXPORT bool llglSwitchFullscreen(LLGLSwapChain swapChain, bool enable);
 LLGL_C_EXPORT LLGLSurface llglGetSurface(LLGLSwapChain swapChain);
 
@@ -19,6 +19,7 @@ LLGL_C_EXPORT void llglGetTextureDesc(LLGLTexture texture, LLGLTextureDescriptor
 LLGL_C_EXPORT LLGLFormat llglGetTextureFormat(LLGLTexture texture);
 LLGL_C_EXPORT void llglGetTextureMipExtent(LLGLTexture texture, uint32_t mipLevel, LLGLExtent3D* outExtent);
 LLGL_C_EXPORT void llglGetTextureSubresourceFootprint(LLGLTexture texture, uint32_t mipLevel, LLGLSubresourceFootprint* outFootprint);
+LLGL_C_EXPORT void llglGetTextureSparseTileExtent(LLGLTexture texture, LLGLExtent3D* outExtent);
 
 
 #endif
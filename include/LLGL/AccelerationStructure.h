@@ -0,0 +1,71 @@
+/*
+ * AccelerationStructure.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_ACCELERATION_STRUCTURE_H
+#define LLGL_ACCELERATION_STRUCTURE_H
+
+
+#include <LLGL/Resource.h>
+#include <LLGL/AccelerationStructureFlags.h>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Ray tracing acceleration structure interface.
+\remarks Top-level acceleration structures are bound to shaders like any other resource with a binding of type ResourceType::AccelerationStructure,
+i.e. \c RaytracingAccelerationStructure in HLSL and \c accelerationStructureEXT in GLSL.
+\see RenderSystem::CreateAccelerationStructure
+\see CommandBuffer::BuildAccelerationStructure
+\see RenderingFeatures::hasRayTracing
+*/
+class LLGL_EXPORT AccelerationStructure : public Resource
+{
+
+        LLGL_DECLARE_INTERFACE( InterfaceID::AccelerationStructure );
+
+    public:
+
+        //! Returns ResourceType::AccelerationStructure.
+        ResourceType GetResourceType() const override final;
+
+        //! Returns the type of this acceleration structure.
+        inline AccelerationStructureType GetType() const
+        {
+            return type_;
+        }
+
+        /**
+        \brief Returns the size (in bytes) this acceleration structure requires after compaction or 0 if the size is not available yet.
+        \remarks The size is only available after the command buffer that built this acceleration structure has been completed by the GPU.
+        This requires the acceleration structure to have been created with AccelerationStructureFlags::AllowCompaction.
+        \see AccelerationStructureDescriptor::compactedSize
+        \see CommandBuffer::CopyAccelerationStructure
+        */
+        virtual std::uint64_t GetCompactedSize() = 0;
+
+    protected:
+
+        AccelerationStructure(const AccelerationStructureType type);
+
+    private:
+
+        AccelerationStructureType type_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,259 @@
+/*
+ * AccelerationStructureFlags.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_ACCELERATION_STRUCTURE_FLAGS_H
+#define LLGL_ACCELERATION_STRUCTURE_FLAGS_H
+
+
+#include <LLGL/Format.h>
+#include <LLGL/Container/ArrayView.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class Buffer;
+class AccelerationStructure;
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Acceleration structure type enumeration.
+\see AccelerationStructureDescriptor::type
+*/
+enum class AccelerationStructureType
+{
+    /**
+    \brief Bottom-level acceleration structure (BLAS) that contains triangle geometry.
+    \see AccelerationStructureDescriptor::geometries
+    */
+    BottomLevel,
+
+    /**
+    \brief Top-level acceleration structure (TLAS) that contains instances of bottom-level acceleration structures.
+    This is the type of acceleration structure that is bound to shaders for ray queries.
+    \see AccelerationStructureDescriptor::maxInstances
+    */
+    TopLevel,
+};
+
+
+/* ----- Flags ----- */
+
+/**
+\brief Acceleration structure creation flags.
+\see AccelerationStructureDescriptor::flags
+*/
+struct AccelerationStructureFlags
+{
+    enum
+    {
+        /**
+        \brief The acceleration structure can be updated (also called "refit") after it has been built.
+        \remarks An update is considerably faster than a full rebuild, since the hierarchy of the acceleration structure is kept and only its bounding volumes are recomputed.
+        This is intended for dynamic scenes where the geometry or instance transformations change every frame but their topology does not.
+        \see AccelerationStructureBuildDescriptor::update
+        */
+        AllowUpdate         = (1 << 0),
+
+        /**
+        \brief The acceleration structure can be compacted after it has been built.
+        \see AccelerationStructure::GetCompactedSize
+        \see CommandBuffer::CopyAccelerationStructure
+        */
+        AllowCompaction     = (1 << 1),
+
+        /**
+        \brief Hint to the renderer that trace performance is preferred over build performance.
+        \remarks This cannot be combined with AccelerationStructureFlags::PreferFastBuild.
+        */
+        PreferFastTrace     = (1 << 2),
+
+        /**
+        \brief Hint to the renderer that build performance is preferred over trace performance.
+        \remarks This cannot be combined with AccelerationStructureFlags::PreferFastTrace.
+        */
+        PreferFastBuild     = (1 << 3),
+    };
+};
+
+/**
+\brief Acceleration structure instance flags.
+\remarks These flags have the same values as their native counterparts in Vulkan and Direct3D 12.
+\see AccelerationStructureInstance::flags
+*/
+struct AccelerationStructureInstanceFlags
+{
+    enum
+    {
+        //! Disables face culling for all triangles of this instance.
+        DisableTriangleCulling      = (1 << 0),
+
+        //! Triangles with counter-clockwise winding order are front facing for this instance. By default, clockwise triangles are front facing.
+        FrontCounterClockwise       = (1 << 1),
+
+        //! All geometries of this instance are treated as opaque, regardless of AccelerationStructureGeometryDescriptor::opaque.
+        ForceOpaque                 = (1 << 2),
+
+        //! All geometries of this instance are treated as non-opaque, regardless of AccelerationStructureGeometryDescriptor::opaque.
+        ForceNonOpaque              = (1 << 3),
+    };
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Triangle geometry descriptor for bottom-level acceleration structures.
+\remarks The vertex and index buffers must have been created with the binding flags BindFlags::VertexBuffer, BindFlags::IndexBuffer, or BindFlags::Storage.
+\see AccelerationStructureDescriptor::geometries
+\see AccelerationStructureBuildDescriptor::geometries
+*/
+struct AccelerationStructureGeometryDescriptor
+{
+    //! Specifies the buffer that contains the vertex positions. This must not be null when the acceleration structure is built.
+    Buffer*         vertexBuffer    = nullptr;
+
+    //! Specifies the offset (in bytes) of the first vertex position within the vertex buffer. By default 0.
+    std::uint64_t   vertexOffset    = 0;
+
+    /**
+    \brief Specifies the format of the vertex positions. By default Format::RGB32Float.
+    \remarks This must be one of the following formats: Format::RG32Float, Format::RGB32Float, Format::RG16Float, Format::RGBA16Float.
+    */
+    Format          vertexFormat    = Format::RGB32Float;
+
+    //! Specifies the stride (in bytes) between consecutive vertex positions. By default 12.
+    std::uint32_t   vertexStride    = 12;
+
+    //! Specifies the number of vertices.
+    std::uint32_t   numVertices     = 0;
+
+    //! Specifies the optional buffer that contains the triangle indices. If this is null, the vertices are not indexed. By default null.
+    Buffer*         indexBuffer     = nullptr;
+
+    //! Specifies the offset (in bytes) of the first index within the index buffer. By default 0.
+    std::uint64_t   indexOffset     = 0;
+
+    //! Specifies the format of the indices. This must be either Format::R16UInt or Format::R32UInt. By default Format::R32UInt.
+    Format          indexFormat     = Format::R32UInt;
+
+    //! Specifies the number of indices. This must be a multiple of 3. Ignored if \c indexBuffer is null.
+    std::uint32_t   numIndices      = 0;
+
+    //! Specifies whether the geometry is opaque, i.e. whether ray queries can skip the candidate evaluation for its triangles. By default true.
+    bool            opaque          = true;
+};
+
+/**
+\brief Instance of a bottom-level acceleration structure within a top-level acceleration structure.
+\see AccelerationStructureBuildDescriptor::instances
+*/
+struct AccelerationStructureInstance
+{
+    //! Specifies the row-major 3x4 affine transformation matrix from object space into world space. By default the identity matrix.
+    float                   transform[3][4]         =
+    {
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+    };
+
+    //! Specifies the user defined instance ID that is returned by the ray query. Only the lower 24 bits are used. By default 0.
+    std::uint32_t           instanceID              = 0;
+
+    //! Specifies the 8-bit visibility mask. The instance is skipped if the bitwise AND of this mask and the ray mask is zero. By default 0xFF.
+    std::uint32_t           mask                    = 0xFF;
+
+    /**
+    \brief Specifies the instance flags. This can be a bitwise OR combination of the entries of the AccelerationStructureInstanceFlags enumeration. By default 0.
+    \see AccelerationStructureInstanceFlags
+    */
+    long                    flags                   = 0;
+
+    //! Specifies the bottom-level acceleration structure of this instance. This must not be null.
+    AccelerationStructure*  accelerationStructure   = nullptr;
+};
+
+/**
+\brief Acceleration structure descriptor.
+\see RenderSystem::CreateAccelerationStructure
+*/
+struct AccelerationStructureDescriptor
+{
+    //! Specifies the type of acceleration structure. By default AccelerationStructureType::BottomLevel.
+    AccelerationStructureType                           type            = AccelerationStructureType::BottomLevel;
+
+    /**
+    \brief Specifies the creation flags. This can be a bitwise OR combination of the entries of the AccelerationStructureFlags enumeration. By default 0.
+    \see AccelerationStructureFlags
+    */
+    long                                                flags           = 0;
+
+    /**
+    \brief Specifies the geometries of a bottom-level acceleration structure to determine its memory requirements.
+    \remarks Only the number of geometries, their formats, and their number of vertices and indices are used here. The buffers can be null.
+    Subsequent builds must specify the same number of geometries with the same formats and must not exceed their number of vertices and indices.
+    \remarks This is ignored for top-level acceleration structures or if \c compactedSize is non-zero.
+    */
+    ArrayView<AccelerationStructureGeometryDescriptor>  geometries;
+
+    /**
+    \brief Specifies the maximum number of instances of a top-level acceleration structure. By default 0.
+    \remarks This is ignored for bottom-level acceleration structures or if \c compactedSize is non-zero.
+    */
+    std::uint32_t                                       maxInstances    = 0;
+
+    /**
+    \brief Specifies the size (in bytes) of an acceleration structure that is only used as destination of a compaction. By default 0.
+    \remarks If this is non-zero, the acceleration structure can only be written by CommandBuffer::CopyAccelerationStructure.
+    This should be equal to the size returned by AccelerationStructure::GetCompactedSize of the source acceleration structure.
+    \see CommandBuffer::CopyAccelerationStructure
+    */
+    std::uint64_t                                       compactedSize   = 0;
+};
+
+/**
+\brief Acceleration structure build descriptor.
+\see CommandBuffer::BuildAccelerationStructure
+*/
+struct AccelerationStructureBuildDescriptor
+{
+    /**
+    \brief Specifies whether the acceleration structure is updated (also called "refit") instead of being rebuilt. By default false.
+    \remarks This requires the acceleration structure to have been created with AccelerationStructureFlags::AllowUpdate and to have been built before.
+    An update must specify the same number of geometries with the same number of vertices and indices, or the same number of instances, as the previous build.
+    \see AccelerationStructureFlags::AllowUpdate
+    */
+    bool                                                update      = false;
+
+    /**
+    \brief Specifies the triangle geometries of a bottom-level acceleration structure.
+    \remarks This must have the same number of geometries as specified at creation time (see AccelerationStructureDescriptor::geometries).
+    */
+    ArrayView<AccelerationStructureGeometryDescriptor>  geometries;
+
+    /**
+    \brief Specifies the instances of a top-level acceleration structure.
+    \remarks This must not have more instances than specified at creation time (see AccelerationStructureDescriptor::maxInstances).
+    All bottom-level acceleration structures must have been built before, either in a previous submission or earlier in the same command buffer.
+    */
+    ArrayView<AccelerationStructureInstance>            instances;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
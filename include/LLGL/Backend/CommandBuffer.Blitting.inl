@@ -38,6 +38,14 @@ virtual void FillBuffer(
     std::uint64_t                   fillSize    = LLGL::Constants::wholeSize
 ) override final;
 
+virtual void FillBufferPattern(
+    LLGL::Buffer&                   dstBuffer,
+    std::uint64_t                   dstOffset,
+    const void*                     pattern,
+    std::uint32_t                   patternSize,
+    std::uint64_t                   fillSize    = LLGL::Constants::wholeSize
+) override final;
+
 virtual void CopyTexture(
     LLGL::Texture&                  dstTexture,
     const LLGL::TextureLocation&    dstLocation,
@@ -70,6 +78,12 @@ virtual void GenerateMips(
     const LLGL::TextureSubresource& subresource
 ) override final;
 
+virtual void CompressTexture(
+    LLGL::Texture&                  dstTexture,
+    LLGL::Texture&                  srcTexture,
+    const LLGL::TextureSubresource& subresource
+) override final;
+
 
 
 // ================================================================================
@@ -18,6 +18,19 @@ virtual void DispatchIndirect(
     std::uint64_t   offset
 ) override final;
 
+virtual void CompactIndirectArguments(
+    LLGL::Buffer&   dstBuffer,
+    std::uint64_t   dstOffset,
+    LLGL::Buffer&   countBuffer,
+    std::uint64_t   countOffset,
+    LLGL::Buffer&   srcBuffer,
+    std::uint64_t   srcOffset,
+    LLGL::Buffer&   visibilityBuffer,
+    std::uint64_t   visibilityOffset,
+    std::uint32_t   numCommands,
+    std::uint32_t   stride
+) override final;
+
 
 
 // ================================================================================
@@ -19,6 +19,10 @@ virtual void Execute(
     LLGL::CommandBuffer& deferredCommandBuffer
 ) override final;
 
+virtual void TrimMemory(
+    void
+) override final;
+
 
 
 // ================================================================================
@@ -0,0 +1,23 @@
+/*
+ * CommandBuffer.RayTracing.inl
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+/* ----- Ray Tracing ----- */
+
+virtual void BuildAccelerationStructure(
+    LLGL::AccelerationStructure&                        accelerationStructure,
+    const LLGL::AccelerationStructureBuildDescriptor&   buildDesc
+) override final;
+
+virtual void CopyAccelerationStructure(
+    LLGL::AccelerationStructure&                        dstAccelerationStructure,
+    LLGL::AccelerationStructure&                        srcAccelerationStructure,
+    bool                                                compact
+) override final;
+
+
+
+// ================================================================================
@@ -17,6 +17,13 @@ virtual void SetResource(
     LLGL::Resource&             resource
 ) override final;
 
+virtual void SetResource(
+    std::uint32_t               descriptor,
+    LLGL::Buffer&               buffer,
+    std::uint64_t               offset,
+    std::uint64_t               size            = LLGL::Constants::wholeSize
+) override final;
+
 virtual void ResetResourceSlots(
     const LLGL::ResourceType    resourceType,
     std::uint32_t               firstSlot,
@@ -11,6 +11,20 @@ virtual void Submit(
     LLGL::CommandBuffer&    commandBuffer
 ) override final;
 
+/* ----- Sparse Resources ----- */
+
+virtual void UpdateTileMappings(
+    LLGL::Texture&                      texture,
+    std::uint32_t                       numMappings,
+    const LLGL::TextureTileMapping*     mappings
+) override final;
+
+virtual void UpdateTileMappings(
+    LLGL::Buffer&                       buffer,
+    std::uint32_t                       numMappings,
+    const LLGL::BufferTileMapping*      mappings
+) override final;
+
 /* ----- Queries ----- */
 
 virtual bool QueryResult(
@@ -21,14 +35,38 @@ virtual bool QueryResult(
     std::size_t             dataSize
 ) override final;
 
+virtual bool QueryFrameCounters(
+    LLGL::FrameProfile&     outProfile
+) override final;
+
+virtual bool GetCalibratedTimestamps(
+    LLGL::CalibratedTimestamps& outTimestamps
+) override final;
+
 /* ----- Fences ----- */
 
 virtual void Submit(
     LLGL::Fence&            fence
 ) override final;
 
+virtual void Submit(
+    LLGL::Fence&            fence,
+    std::uint64_t           value
+) override final;
+
+virtual void SubmitWait(
+    LLGL::Fence&            fence,
+    std::uint64_t           value
+) override final;
+
+virtual bool WaitFence(
+    LLGL::Fence&            fence,
+    std::uint64_t           timeout
+) override final;
+
 virtual bool WaitFence(
     LLGL::Fence&            fence,
+    std::uint64_t           value,
     std::uint64_t           timeout
 ) override final;
 
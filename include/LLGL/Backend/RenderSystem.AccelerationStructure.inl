@@ -0,0 +1,20 @@
+/*
+ * RenderSystem.AccelerationStructure.inl
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+/* ----- Acceleration structures ----- */
+
+virtual LLGL::AccelerationStructure* CreateAccelerationStructure(
+    const LLGL::AccelerationStructureDescriptor&    accelerationStructureDesc
+) override final;
+
+virtual void Release(
+    LLGL::AccelerationStructure&                    accelerationStructure
+) override final;
+
+
+
+// ================================================================================
@@ -12,6 +12,13 @@ virtual LLGL::Buffer* CreateBuffer(
     const void*                     initialData = nullptr
 ) override final;
 
+virtual void CreateBuffers(
+    std::uint32_t                   numBuffers,
+    const LLGL::BufferDescriptor*   bufferDescs,
+    const void* const *             initialData,
+    LLGL::Buffer**                  outBuffers
+) override final;
+
 virtual LLGL::BufferArray* CreateBufferArray(
     std::uint32_t                   numBuffers,
     LLGL::Buffer* const *           bufferArray
@@ -8,7 +8,7 @@
 /* ----- Command queues ----- */
 
 virtual LLGL::CommandQueue* GetCommandQueue(
-    void
+    const LLGL::CommandQueueType type = LLGL::CommandQueueType::Graphics
 ) override final;
 
 
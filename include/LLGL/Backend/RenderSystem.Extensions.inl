@@ -12,6 +12,37 @@ virtual bool GetNativeHandle(
     std::size_t nativeHandleSize
 ) override final;
 
+virtual std::uint64_t ReleaseRetainedMemory(
+    std::uint64_t budget
+) override final;
+
+virtual bool QueryMemoryStatistics(
+    MemoryStatistics& outStatistics
+) override final;
+
+virtual bool SetMemoryPriority(
+    Resource&   resource,
+    float       priority
+) override final;
+
+virtual Blob GetPipelineCache(
+) override final;
+
+virtual bool ExportMemoryHandle(
+    Resource&       resource,
+    ExternalHandle& outHandle
+) override final;
+
+virtual bool ExportFenceHandle(
+    Fence&          fence,
+    ExternalHandle& outHandle
+) override final;
+
+virtual bool SubmitFileLoads(
+    const ArrayView<FileLoadDescriptor>&    loads,
+    Fence*                                  fence
+) override final;
+
 
 
 // ================================================================================
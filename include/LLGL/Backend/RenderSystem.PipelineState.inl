@@ -21,6 +21,16 @@ virtual LLGL::PipelineState* CreatePipelineState(
     LLGL::Blob*                             serializedCache = nullptr
 ) override final;
 
+virtual LLGL::PipelineState* CreatePipelineStateAsync(
+    const LLGL::GraphicsPipelineDescriptor& pipelineStateDesc,
+    LLGL::PipelineState*                    fallbackPipelineState = nullptr
+) override final;
+
+virtual LLGL::PipelineState* CreatePipelineStateAsync(
+    const LLGL::ComputePipelineDescriptor&  pipelineStateDesc,
+    LLGL::PipelineState*                    fallbackPipelineState = nullptr
+) override final;
+
 virtual void Release(
     LLGL::PipelineState&                    pipelineState
 ) override final;
@@ -12,6 +12,13 @@ virtual LLGL::Texture* CreateTexture(
     const LLGL::SrcImageDescriptor* imageDesc       = nullptr
 ) override final;
 
+virtual void CreateTextures(
+    std::uint32_t                           numTextures,
+    const LLGL::TextureDescriptor*          textureDescs,
+    const LLGL::SrcImageDescriptor* const * imageDescs,
+    LLGL::Texture**                         outTextures
+) override final;
+
 virtual void Release(
     LLGL::Texture&                  texture
 ) override final;
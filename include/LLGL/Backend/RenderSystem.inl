@@ -18,6 +18,7 @@
 #include <LLGL/Backend/RenderSystem.PipelineLayout.inl>
 #include <LLGL/Backend/RenderSystem.PipelineState.inl>
 #include <LLGL/Backend/RenderSystem.QueryHeap.inl>
+#include <LLGL/Backend/RenderSystem.AccelerationStructure.inl>
 #include <LLGL/Backend/RenderSystem.Fence.inl>
 #include <LLGL/Backend/RenderSystem.Extensions.inl>
 
@@ -21,6 +21,10 @@ virtual LLGL::SubresourceFootprint GetSubresourceFootprint(
     std::uint32_t mipLevel
 ) const override final;
 
+virtual LLGL::Extent3D GetSparseTileExtent(
+    void
+) const override final;
+
 
 
 // ================================================================================
@@ -58,6 +58,20 @@ class LLGL_EXPORT Buffer : public Resource
         */
         virtual BufferDescriptor GetDesc() const = 0;
 
+        /**
+        \brief Returns the GPU virtual address of this buffer.
+        \return Address of the first byte of this buffer in the GPU address space,
+        or zero if the buffer was not created with BindFlags::DeviceAddress or the backend does not support buffer device addresses.
+        \remarks The address remains valid for the lifetime of this buffer. It can be passed to shaders via CommandBuffer::SetUniforms,
+        so that vertices and per-object data can be fetched from pointers instead of binding the buffer for each draw call.
+        The shader is responsible for synchronizing its access through such a pointer, i.e. LLGL does not track these accesses for barriers.
+        \remarks With Direct3D 12, this returns the value of \c ID3D12Resource::GetGPUVirtualAddress, which can be used for native root descriptors but not for shader access.
+        \note Only supported with: Vulkan, Direct3D 12, Metal, OpenGL.
+        \see BindFlags::DeviceAddress
+        \see RenderingFeatures::hasBufferDeviceAddress
+        */
+        virtual std::uint64_t GetDeviceAddress() const;
+
     protected:
 
         Buffer(long bindFlags);
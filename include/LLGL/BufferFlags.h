@@ -146,6 +146,30 @@ struct BufferViewDescriptor
     std::uint64_t   size    = Constants::wholeSize;
 };
 
+/**
+\brief Tile mapping structure for sparse buffers.
+\see CommandQueue::UpdateTileMappings(Buffer&, std::uint32_t, const BufferTileMapping*)
+\see MiscFlags::Sparse
+*/
+struct BufferTileMapping
+{
+    /**
+    \brief Specifies the memory offset (in bytes) of the range whose residency is to be changed. By default 0.
+    \remarks Ranges that are made resident are extended to the next tile boundaries, and ranges that are released are shrunk to the next tile boundaries.
+    The tile size of buffers is 64 KB with Direct3D 12 and the memory alignment of the buffer with Vulkan, which is usually also 64 KB.
+    */
+    std::uint64_t   offset      = 0;
+
+    //! Specifies the size (in bytes) of the range whose residency is to be changed. By default 0.
+    std::uint64_t   size        = 0;
+
+    /**
+    \brief Specifies whether memory is to be committed for the range or released. By default true.
+    \remarks The content of tiles that are newly committed is undefined.
+    */
+    bool            resident    = true;
+};
+
 
 /* ----- Functions ----- */
 
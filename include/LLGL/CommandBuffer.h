@@ -24,6 +24,7 @@
 #include <LLGL/Shader.h>
 #include <LLGL/PipelineState.h>
 #include <LLGL/QueryHeap.h>
+#include <LLGL/AccelerationStructure.h>
 
 #include <cstdint>
 
@@ -77,6 +78,19 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void Execute(CommandBuffer& deferredCommandBuffer) = 0;
 
+        /**
+        \brief Releases the internal staging memory of this command buffer down to CommandBufferDescriptor::minStagingPoolSize.
+        \remarks In contrast to all other functions of this interface, this must be called \e outside of a Begin/End pair.
+        Use this after a load spike such as a level transition to return the staging memory immediately,
+        instead of waiting for the number of recordings specified by CommandBufferDescriptor::stagingPoolTrimFrames.
+        Memory that is still referenced by submissions in flight is released once the GPU has completed them.
+        \remarks With Direct3D 11, all immediate command buffers share the staging pool of the immediate device context, so this trims the pool for all of them.
+        \note Only supported with: Direct3D 12, Direct3D 11, Metal. For all other backends, this function has no effect.
+        \see CommandBufferDescriptor::stagingPoolTrimFrames
+        \see RenderSystem::ReleaseRetainedMemory
+        */
+        virtual void TrimMemory() = 0;
+
         /* ----- Blitting ----- */
 
         /**
@@ -201,6 +215,38 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
             std::uint64_t   fillSize    = Constants::wholeSize
         ) = 0;
 
+        /**
+        \brief Fills the destination buffer with copies of the specified 32-, 64-, or 128-bit pattern.
+
+        \param[in,out] dstBuffer Specifies the destination buffer whose data is to be updated.
+        This buffer must have been created with the binding flag BindFlags::CopyDst.
+        In contrast to FillBuffer, this command never stages the pattern through CPU memory.
+        If the destination buffer cannot be written directly by the GPU, an intermediate GPU buffer is filled and copied by LLGL.
+
+        \param[in] dstOffset Specifies the destination offset (in bytes) at which the destination buffer is to be updated.
+        This \b must be a multiple of \c patternSize.
+
+        \param[in] pattern Pointer to the pattern the buffer is filled with. This must not be null.
+
+        \param[in] patternSize Specifies the size (in bytes) of the pattern. This \b must be 4, 8, or 16.
+
+        \param[in] fillSize Specifies the fill size (in bytes) of the buffer region. This \b must be a multiple of \c patternSize. By default Constants::wholeSize.
+        If this is equal to \c Constants::wholeSize, \c dstOffset is ignored and the entire buffer will be filled.
+
+        \remarks This is the preferred way to reset large counter or visibility buffers every frame.
+        A pattern that consists of a single repeated 32-bit value is equivalent to FillBuffer.
+        \remarks For performance reasons, it is recommended to encode this command outside of a render pass.
+        Otherwise, render pass interruptions might be inserted by LLGL.
+        \see FillBuffer
+        */
+        virtual void FillBufferPattern(
+            Buffer&         dstBuffer,
+            std::uint64_t   dstOffset,
+            const void*     pattern,
+            std::uint32_t   patternSize,
+            std::uint64_t   fillSize    = Constants::wholeSize
+        ) = 0;
+
         /**
         \brief Encodes a texture copy command for the specified texture regions.
 
@@ -341,6 +387,32 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void GenerateMips(Texture& texture, const TextureSubresource& subresource) = 0;
 
+        /**
+        \brief Compresses a subresource of an uncompressed texture into a block compressed texture with a real-time GPU encoder.
+
+        \param[out] dstTexture Specifies the destination texture whose texels are to be written.
+        This texture must have been created with the binding flag BindFlags::Storage
+        and one of the formats Format::BC1UNorm, Format::BC1UNorm_sRGB, Format::BC3UNorm, Format::BC3UNorm_sRGB, Format::BC4UNorm, or Format::BC5UNorm.
+
+        \param[in] srcTexture Specifies the source texture whose texels are to be compressed.
+        This texture must have been created with the binding flag BindFlags::Sampled and a normalized color format.
+        Its extent must be equal to the extent of the destination texture.
+
+        \param[in] subresource Specifies the MIP-map levels and array layers that are compressed from the source into the same subresource of the destination.
+
+        \remarks Only the texture types TextureType::Texture2D and TextureType::Texture2DArray are supported.
+        The texel values are compressed as they are stored in the source texture, i.e. sRGB sources remain in sRGB color space,
+        the alpha channel is ignored for BC1, and only the red, or red and green channels are used for BC4 and BC5 respectively.
+
+        \remarks The encoder favors speed over quality, e.g. to compress render targets or procedurally generated textures at runtime.
+        Assets that are known in advance should be compressed offline instead.
+
+        \remarks This command must be encoded outside of a render pass and it replaces the compute pipeline binding, just like a dispatch command of a different PSO.
+
+        \see RenderingFeatures::hasTextureCompression
+        */
+        virtual void CompressTexture(Texture& dstTexture, Texture& srcTexture, const TextureSubresource& subresource) = 0;
+
         /* ----- Viewport and Scissor ----- */
 
         /**
@@ -447,6 +519,26 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void SetResource(std::uint32_t descriptor, Resource& resource) = 0;
 
+        /**
+        \brief Binds a range of the specified buffer as root parameter to the respective pipeline.
+        \param[in] descriptor Specifies the zero-based index of the descriptor in the currently bound pipeline layout.
+        This \b must be in the half-open range <code>[0, PipelineLayout::GetNumBindings)</code>.
+        \param[in] buffer Specifies the buffer whose range is to be bound to the shader pipeline.
+        \param[in] offset Specifies the offset (in bytes) into the buffer where the range begins.
+        This \b must be a multiple of RenderingLimits::minConstantBufferAlignment for constant buffers and RenderingLimits::minStorageBufferAlignment for storage buffers.
+        \param[in] size Specifies the size (in bytes) of the range. If this is Constants::wholeSize, the range extends to the end of the buffer.
+        By default Constants::wholeSize.
+        \remarks This is intended for per-draw constants: A single large buffer can be filled once per frame and each draw call binds its own range of that buffer
+        without updating any buffer or resource heap in between.
+        Binding the same buffer again with only a different offset is the fastest path on all backends.
+        \remarks Only constant buffers and storage buffers can be bound with an offset. Other bindings are bound with the entire buffer.
+        Direct3D 11 only supports offsets for constant buffers, which requires Direct3D 11.1 and binds the range in units of 16 constants, i.e. 256 bytes.
+        \see SetResource(std::uint32_t, Resource&)
+        \see RenderingLimits::minConstantBufferAlignment
+        \see RenderingLimits::minStorageBufferAlignment
+        */
+        virtual void SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t size = Constants::wholeSize) = 0;
+
         /**
         \brief Resets the binding slots for the specified resources.
 
@@ -531,7 +623,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
 
         \remarks
         The following commands \b must only be used \b inside a render pass section:
-        - Drawing commands (i.e. \c Draw, \c DrawInstanced, \c DrawIndexed, \c DrawIndexedInstanced, \c DrawIndirect and \c DrawIndexedIndirect).
+        - Drawing commands (i.e. \c Draw, \c DrawInstanced, \c DrawIndexed, \c DrawIndexedInstanced, \c DrawIndirect, \c DrawIndexedIndirect, \c DrawIndirectCount, \c DrawIndexedIndirectCount, \c DrawMeshTasks, and \c DrawMeshTasksIndirect).
         - Clear attachment commands (i.e. \c Clear and \c ClearAttachments).
         - Query block (i.e. \c BeginQuery and \c EndQuery).
         - Conditional render block (i.e. \c BeginRenderCondition and \c EndRenderCondition).
@@ -906,6 +998,99 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) = 0;
 
+        /**
+        \brief Draws an unknown amount of instances of primitives whose draw command arguments and number of draw commands are taken from buffer objects.
+
+        \param[in] argsBuffer Specifies the buffer from which the draw command arguments are taken. This buffer must have been created with the BindFlags::IndirectBuffer binding flag.
+        \param[in] argsOffset Specifies an offset within the argument buffer from which the arguments are to be taken. This offset must be a multiple of 4.
+        \param[in] countBuffer Specifies the buffer from which the number of draw commands is taken as 32-bit unsigned integer.
+        This buffer must have been created with the BindFlags::IndirectBuffer binding flag.
+        \param[in] countOffset Specifies an offset within the count buffer from which the number of draw commands is to be taken. This offset must be a multiple of 4.
+        \param[in] maxNumCommands Specifies the maximum number of draw commands. The actual number is the minimum of this value and the number taken from the count buffer.
+        \param[in] stride Specifies the stride (in bytes) betweeen consecutive sets of arguments,
+        which is commonly greater than or euqal to <code>sizeof(DrawIndirectArguments)</code>. This stride must be a multiple of 4.
+
+        \remarks This allows GPU-driven rendering where the number of draw commands is determined by a compute shader,
+        without reading the number of visible objects back to the CPU.
+
+        \see DrawIndirectArguments
+        \see RenderingFeatures::hasIndirectCountDrawing
+        */
+        virtual void DrawIndirectCount(
+            Buffer&         argsBuffer,
+            std::uint64_t   argsOffset,
+            Buffer&         countBuffer,
+            std::uint64_t   countOffset,
+            std::uint32_t   maxNumCommands,
+            std::uint32_t   stride
+        ) = 0;
+
+        /**
+        \brief Draws an unknown amount of instances of primitives whose indexed draw command arguments and number of draw commands are taken from buffer objects.
+
+        \param[in] argsBuffer Specifies the buffer from which the draw command arguments are taken. This buffer must have been created with the BindFlags::IndirectBuffer binding flag.
+        \param[in] argsOffset Specifies an offset within the argument buffer from which the arguments are to be taken. This offset must be a multiple of 4.
+        \param[in] countBuffer Specifies the buffer from which the number of draw commands is taken as 32-bit unsigned integer.
+        This buffer must have been created with the BindFlags::IndirectBuffer binding flag.
+        \param[in] countOffset Specifies an offset within the count buffer from which the number of draw commands is to be taken. This offset must be a multiple of 4.
+        \param[in] maxNumCommands Specifies the maximum number of draw commands. The actual number is the minimum of this value and the number taken from the count buffer.
+        \param[in] stride Specifies the stride (in bytes) betweeen consecutive sets of arguments,
+        which is commonly greater than or euqal to <code>sizeof(DrawIndexedIndirectArguments)</code>. This stride must be a multiple of 4.
+
+        \see DrawIndexedIndirectArguments
+        \see RenderingFeatures::hasIndirectCountDrawing
+        */
+        virtual void DrawIndexedIndirectCount(
+            Buffer&         argsBuffer,
+            std::uint64_t   argsOffset,
+            Buffer&         countBuffer,
+            std::uint64_t   countOffset,
+            std::uint32_t   maxNumCommands,
+            std::uint32_t   stride
+        ) = 0;
+
+        /**
+        \brief Draws primitives with the currently bound mesh pipeline by launching the specified number of task shader thread groups.
+        \param[in] numWorkGroupsX Specifies the number of thread groups in the X-dimension.
+        \param[in] numWorkGroupsY Specifies the number of thread groups in the Y-dimension.
+        \param[in] numWorkGroupsZ Specifies the number of thread groups in the Z-dimension.
+        \remarks If the mesh pipeline has no task shader, the number of thread groups refers to the mesh shader.
+        \remarks The currently bound graphics pipeline must have been created with a mesh shader. Vertex and index buffers are not used by this command.
+        \see GraphicsPipelineDescriptor::meshShader
+        \see RenderingFeatures::hasMeshShaders
+        */
+        virtual void DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) = 0;
+
+        /**
+        \brief Draws primitives with the currently bound mesh pipeline whose thread group counts are taken from a buffer object.
+
+        \param[in] buffer Specifies the buffer from which the draw command arguments are taken. This buffer must have been created with the BindFlags::IndirectBuffer binding flag.
+        \param[in] offset Specifies an offset within the argument buffer from which the arguments are to be taken. This offset must be a multiple of 4.
+        \param[in] numCommands Specifies the number of draw commands that are to be taken from the argument buffer.
+        \param[in] stride Specifies the stride (in bytes) betweeen consecutive sets of arguments,
+        which is commonly greater than or euqal to <code>sizeof(DrawMeshTasksIndirectArguments)</code>. This stride must be a multiple of 4.
+
+        \remarks This allows a compute shader to determine the number of visible meshlets without reading them back to the CPU.
+        With Metal, multiple draw commands are emulated with a simple loop.
+
+        \see DrawMeshTasksIndirectArguments
+        \see RenderingFeatures::hasMeshShaders
+        */
+        virtual void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands = 1, std::uint32_t stride = 12) = 0;
+
+        /**
+        \brief Draws all vertices that have been captured by a previous stream-output section into the vertex buffer that is bound to slot 0.
+        \remarks The number of vertices is determined on the GPU from the amount of data that was written into the stream-output buffer,
+        so geometry that was expanded or culled by a shader can be replayed without reading the vertex count back to the CPU.
+        The vertex buffer must have been created with the binding flags BindFlags::VertexBuffer and BindFlags::StreamOutputBuffer
+        and it must have been the first stream-output buffer of the most recent BeginStreamOutput/EndStreamOutput section it was bound to.
+        \note Only supported with: OpenGL (if \c GL_ARB_transform_feedback2 is available), Vulkan (if \c VK_EXT_transform_feedback is available), Direct3D 11.
+        \see BeginStreamOutput
+        \see SetVertexBuffer
+        \see RenderingFeatures::hasStreamOutputs
+        */
+        virtual void DrawStreamOutput() = 0;
+
         /* ----- Compute ----- */
 
         /**
@@ -926,6 +1111,98 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void DispatchIndirect(Buffer& buffer, std::uint64_t offset) = 0;
 
+        /**
+        \brief Compacts indirect draw arguments with a visibility bitmask and writes the number of visible draw commands, all on the GPU.
+
+        \param[out] dstBuffer Specifies the buffer the arguments of all visible draw commands are written to.
+        This buffer must have been created with the binding flags BindFlags::Storage and BindFlags::IndirectBuffer.
+        \param[in] dstOffset Specifies the offset (in bytes) within the destination buffer. This offset must be a multiple of 4.
+
+        \param[out] countBuffer Specifies the buffer the number of visible draw commands is written to as a single 32-bit unsigned integer.
+        This buffer must have been created with the binding flags BindFlags::Storage and BindFlags::IndirectBuffer.
+        \param[in] countOffset Specifies the offset (in bytes) within the count buffer. This offset must be a multiple of 4.
+
+        \param[in] srcBuffer Specifies the buffer the arguments of all draw commands are read from. This buffer must have been created with the binding flag BindFlags::Storage.
+        \param[in] srcOffset Specifies the offset (in bytes) within the source buffer. This offset must be a multiple of 4.
+
+        \param[in] visibilityBuffer Specifies the buffer with the visibility bitmask. Draw command \c i is visible if bit <code>i % 32</code> of the 32-bit word <code>i / 32</code> is set.
+        This buffer must have been created with the binding flag BindFlags::Storage.
+        \param[in] visibilityOffset Specifies the offset (in bytes) within the visibility buffer. This offset must be a multiple of 4.
+
+        \param[in] numCommands Specifies the number of draw commands in the source buffer.
+        \param[in] stride Specifies the stride (in bytes) between consecutive sets of arguments in both the source and destination buffer.
+        This is commonly <code>sizeof(DrawIndirectArguments)</code> or <code>sizeof(DrawIndexedIndirectArguments)</code> and must be a multiple of 4.
+
+        \remarks The arguments are copied as they are, so the output can be passed to DrawIndirectCount or DrawIndexedIndirectCount
+        with \c numCommands as maximum number of draw commands. The order of the visible draw commands is not preserved;
+        shaders that need to identify the original draw command should encode it in the \c firstInstance argument.
+
+        \remarks Draw and dispatch commands that read arguments from a buffer are implicitly synchronized with this command and with previous dispatch commands,
+        i.e. no barrier is required between a compute shader that writes indirect arguments and the indirect command that reads them.
+
+        \remarks This command must be encoded outside of a render pass and it replaces the compute pipeline binding, just like a dispatch command of a different PSO.
+
+        \code
+        // Compact the arguments of all objects that passed a culling compute shader and draw them without CPU readback.
+        myCmdBuffer->SetPipelineState(*myCullingPipeline);
+        myCmdBuffer->Dispatch((myNumObjects + 63) / 64, 1, 1); // Writes myVisibilityBuffer
+        myCmdBuffer->CompactIndirectArguments(*myDrawArgsBuffer, 0, *myDrawCountBuffer, 0, *myAllArgsBuffer, 0, *myVisibilityBuffer, 0, myNumObjects, sizeof(LLGL::DrawIndexedIndirectArguments));
+        myCmdBuffer->BeginRenderPass(*mySwapChain);
+        myCmdBuffer->SetPipelineState(*mySceneGraphicsPipeline);
+        myCmdBuffer->DrawIndexedIndirectCount(*myDrawArgsBuffer, 0, *myDrawCountBuffer, 0, myNumObjects, sizeof(LLGL::DrawIndexedIndirectArguments));
+        \endcode
+
+        \see DrawIndirectArguments
+        \see DrawIndexedIndirectArguments
+        \see DrawIndirectCount
+        \see DrawIndexedIndirectCount
+        \see RenderingFeatures::hasIndirectArgumentCompaction
+        */
+        virtual void CompactIndirectArguments(
+            Buffer&         dstBuffer,
+            std::uint64_t   dstOffset,
+            Buffer&         countBuffer,
+            std::uint64_t   countOffset,
+            Buffer&         srcBuffer,
+            std::uint64_t   srcOffset,
+            Buffer&         visibilityBuffer,
+            std::uint64_t   visibilityOffset,
+            std::uint32_t   numCommands,
+            std::uint32_t   stride
+        ) = 0;
+
+        /* ----- Ray Tracing ----- */
+
+        /**
+        \brief Builds or updates the specified acceleration structure.
+        \param[in] accelerationStructure Specifies the acceleration structure that is to be built.
+        \param[in] buildDesc Specifies the geometries or instances the acceleration structure is built from.
+        If \c buildDesc.update is true, the acceleration structure is updated (also called "refit") instead of being rebuilt.
+        \remarks This must not be called inside a render pass. Subsequent commands, such as builds of top-level acceleration structures and shaders with ray queries,
+        are implicitly synchronized with this build.
+        \remarks The instances of a top-level acceleration structure are copied into the command buffer, i.e. the \c instances array does not need to remain valid after this call.
+        The vertex and index buffers of bottom-level acceleration structures are read when the command buffer is executed.
+        \remarks If the acceleration structure has been created with AccelerationStructureFlags::AllowCompaction,
+        its compacted size is available via AccelerationStructure::GetCompactedSize after the command buffer has been completed.
+        \see AccelerationStructureBuildDescriptor
+        \see RenderingFeatures::hasRayTracing
+        */
+        virtual void BuildAccelerationStructure(AccelerationStructure& accelerationStructure, const AccelerationStructureBuildDescriptor& buildDesc) = 0;
+
+        /**
+        \brief Copies the content of an acceleration structure into another one.
+        \param[in] dstAccelerationStructure Specifies the destination acceleration structure. This must have the same type as the source acceleration structure.
+        \param[in] srcAccelerationStructure Specifies the source acceleration structure. It must have been built before.
+        \param[in] compact Specifies whether the source is compacted into the destination.
+        This requires the source to have been created with AccelerationStructureFlags::AllowCompaction and the destination to have been created
+        with at least the compacted size of the source (see AccelerationStructureDescriptor::compactedSize).
+        \remarks This must not be called inside a render pass.
+        Compaction is typically used once for static geometry: The compacted size of a new acceleration structure is queried after its first build,
+        then the acceleration structure is compacted into a smaller one and the original acceleration structure is released.
+        \see AccelerationStructure::GetCompactedSize
+        */
+        virtual void CopyAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure, bool compact = false) = 0;
+
         /* ----- Debugging ----- */
 
         /**
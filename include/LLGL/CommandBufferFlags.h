@@ -9,6 +9,7 @@
 #define LLGL_COMMAND_BUFFER_FLAGS_H
 
 
+#include <LLGL/ForwardDecls.h>
 #include <cstdint>
 
 
@@ -58,6 +59,32 @@ enum class StencilFace
     Back,
 };
 
+/**
+\brief Command queue type enumeration.
+\remarks Backends that do not support dedicated queues for a certain type return the graphics queue instead.
+\see RenderSystem::GetCommandQueue
+\see CommandBufferDescriptor::queueType
+*/
+enum class CommandQueueType
+{
+    //! Graphics queue that supports all commands. This is the default queue.
+    Graphics,
+
+    /**
+    \brief Asynchronous compute queue that supports compute and copy commands.
+    \remarks This allows compute work to overlap with rendering on the graphics queue.
+    \note Only supported with: Vulkan, Direct3D 12, Metal.
+    */
+    Compute,
+
+    /**
+    \brief Transfer queue that only supports copy commands.
+    \remarks This allows streaming uploads and other copy commands to overlap with rendering on the graphics queue.
+    \note Only supported with: Vulkan, Direct3D 12, Metal.
+    */
+    Copy,
+};
+
 
 /* ----- Flags ----- */
 
@@ -83,6 +110,8 @@ struct CommandBufferFlags
         \brief Specifies that the encoded command buffer can be submitted multiple times.
         \remarks If this is not specified, the command buffer must be encoded again after it has been submitted to the command queue.
         \remarks This cannot be used in combination with the \c ImmediateSubmit flag.
+        \remarks For the Metal backend, runs of consecutive draw commands without state changes in between are encoded once into an indirect command buffer,
+        if the bound graphics PSO neither uses tessellation nor binds textures or samplers outside of a bindless resource heap.
         \see CommandQueue::Submit(CommandBuffer&)
         */
         MultiSubmit     = (1 << 1),
@@ -263,7 +292,7 @@ struct CommandBufferDescriptor
     the command buffer must be encoded again after it has been submitted to the command queue.
     \see CommandBufferFlags
     */
-    long            flags               = 0;
+    long                flags                   = 0;
 
     /**
     \brief Specifies the number of internal native command buffers. By default 2.
@@ -272,18 +301,62 @@ struct CommandBufferDescriptor
     These native command buffers are then switched everytime encoding begins with the CommandBuffer::Begin function.
     The benefit of having multiple native command buffers is that it reduces the time the GPU is idle
     because it waits for a command buffer to be completed before it can be reused.
+    \remarks The Direct3D 12 backend only uses this as the initial number of command allocators.
+    It creates more of them on demand while the GPU has not completed the previous ones,
+    and releases the surplus again after they have been idle for a while.
     \see CommandBuffer::Begin
     */
-    std::uint32_t   numNativeBuffers    = 2;
+    std::uint32_t       numNativeBuffers        = 2;
 
     /**
     \brief Specifies the minimum size (in bytes) for the staging pool (if supported). By default 65536 (or <tt>0xFFFF + 1</tt>).
     \remarks This is only a hint to the framework, since not all rendering APIs support command buffers natively.
     For the D3D12 backend for instance, this will specify the initial buffer size for the staging pool, i.e. for buffer updates during command encoding.
     For command buffers that will make many and large buffer updates, increase this size to fine-tune performance.
+    \remarks This is also the floor the staging pool is trimmed down to. The Direct3D 11 backend only uses this and \c stagingPoolTrimFrames for deferred command buffers,
+    since all immediate command buffers share the staging pool of the immediate device context.
     \see CommandBuffer::UpdateBuffer
+    \see stagingPoolTrimFrames
+    */
+    std::uint64_t       minStagingPoolSize      = (0xFFFF + 1);
+
+    /**
+    \brief Specifies the number of recordings after which unused staging pool memory is released. By default 120.
+    \remarks Staging pools grow to accommodate large buffer and constant updates, e.g. during a loading screen.
+    If only a fraction of that memory has been used over this number of recordings (i.e. CommandBuffer::Begin/End pairs),
+    the staging pool releases the surplus but never shrinks below \c minStagingPoolSize.
+    \remarks If this is 0, staging pools only shrink with explicit calls to CommandBuffer::TrimMemory.
+    \note Only supported with: Direct3D 12, Direct3D 11, Metal.
+    \see CommandBuffer::TrimMemory
+    */
+    std::uint32_t       stagingPoolTrimFrames   = 120;
+
+    /**
+    \brief Specifies the type of command queue this command buffer will be submitted to. By default CommandQueueType::Graphics.
+    \remarks The command buffer must only be submitted to the command queue that is returned by RenderSystem::GetCommandQueue for the same type.
+    Command buffers for the CommandQueueType::Compute queue must not contain any graphics commands
+    and command buffers for the CommandQueueType::Copy queue must only contain copy commands.
+    \see RenderSystem::GetCommandQueue
+    */
+    CommandQueueType    queueType               = CommandQueueType::Graphics;
+
+    /**
+    \brief Specifies the render pass a secondary command buffer is encoded into in parallel to other secondary command buffers. By default null.
+    \remarks This is only used for secondary command buffers, i.e. with the CommandBufferFlags::Secondary flag but without the CommandBufferFlags::MultiSubmit flag.
+    A primary command buffer that begins a render pass with the same RenderPass object encodes that render pass in parallel mode.
+    Each such secondary command buffer then encodes its commands into its own sub-encoder of that render pass between its CommandBuffer::Begin and CommandBuffer::End calls,
+    which can be done on different threads. The secondary command buffers are executed in the order of their CommandBuffer::Begin calls and after the commands of the primary command buffer within that render pass.
+    All these secondary command buffers must have been ended before the primary command buffer ends the render pass and must be passed to CommandBuffer::Execute of the primary command buffer.
+    Such secondary command buffers must neither begin their own render pass nor encode copy or compute commands.
+    \remarks For the Metal backend, this maps to sub-encoders of a \c MTLParallelRenderCommandEncoder.
+    \remarks For the Vulkan backend, such secondary command buffers inherit the render pass with \c VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
+    and the primary command buffer begins that render pass with \c VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS.
+    The primary command buffer must therefore not encode any commands other than CommandBuffer::Execute within that render pass
+    and the secondary command buffers are executed in the order of the CommandBuffer::Execute calls.
+    \note Only supported with: Metal, Vulkan.
+    \see CommandBuffer::BeginRenderPass
     */
-    std::uint64_t   minStagingPoolSize  = (0xFFFF + 1);
+    const RenderPass*   renderPass              = nullptr;
 };
 
 
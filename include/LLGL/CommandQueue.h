@@ -51,13 +51,68 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual void Submit(CommandBuffer& commandBuffer) = 0;
 
-        #if 0
         /**
         \brief Submits all command buffers in the specified array to the command queue at once.
+        \param[in] numCommandBuffers Specifies the number of command buffers in the array \c commandBuffers.
+        \param[in] commandBuffers Pointer to an array of command buffers that are to be submitted in the order they appear in this array.
+        Command buffers that were created with the CommandBufferFlags::ImmediateSubmit flag are ignored.
+        \remarks The default implementation submits each command buffer individually via Submit(CommandBuffer&).
+        Backends that support it submit all command buffers with a single native call, which reduces the submission overhead
+        when the command buffers have been recorded on multiple threads.
+        \note Only natively supported with: Direct3D 12.
         \see Submit(CommandBuffer&)
         */
         virtual void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers);
-        #endif
+
+        /* ----- Presentation ----- */
+
+        /**
+        \brief Presents all swap-chains in the specified array at once.
+        \param[in] numSwapChains Specifies the number of swap-chains in the array \c swapChains.
+        \param[in] swapChains Pointer to an array of swap-chains that are to be presented. Null pointers are ignored.
+        \remarks This is equivalent to calling SwapChain::Present for each swap-chain, but backends that support it
+        present all swap-chains with a single native call, so that frames on multiple displays are presented in lockstep with less CPU overhead.
+        \remarks The default implementation presents each swap-chain individually via SwapChain::Present.
+        With Vulkan, all swap-chains are presented with a single submission and a single call to \c vkQueuePresentKHR.
+        With Direct3D 12, all DXGI swap-chains are presented back-to-back before any of them waits for its next frame.
+        \note Only natively supported with: Vulkan, Direct3D 12.
+        \see SwapChain::Present
+        */
+        virtual void Present(std::uint32_t numSwapChains, SwapChain* const * swapChains);
+
+        /* ----- Sparse Resources ----- */
+
+        /**
+        \brief Commits or releases the memory of the specified tiles of a sparse texture.
+        \param[in] texture Specifies the texture whose tile mappings are to be updated. This must have been created with the MiscFlags::Sparse flag.
+        \param[in] numMappings Specifies the number of entries in the array \c mappings.
+        \param[in] mappings Pointer to an array of tile mappings. Each mapping either commits the memory of a texel region or releases it.
+        \remarks The render system manages the memory of all tiles internally. Tile mappings are updated in submission order of this queue,
+        i.e. command buffers that have been submitted before this call still see the previous mappings and all command buffers that are submitted afterwards see the new mappings.
+        \remarks Here is a usage example that makes a single tile of the base MIP-map resident:
+        \code
+        LLGL::TextureTileMapping mapping;
+        mapping.region.offset = { 0, 0, 0 };
+        mapping.region.extent = myTexture->GetSparseTileExtent();
+        mapping.resident      = true;
+        myCmdQueue->UpdateTileMappings(*myTexture, 1, &mapping);
+        \endcode
+        \note Only supported with: Direct3D 12, Vulkan.
+        \see RenderingFeatures::hasSparseResources
+        \see Texture::GetSparseTileExtent
+        */
+        virtual void UpdateTileMappings(Texture& texture, std::uint32_t numMappings, const TextureTileMapping* mappings) = 0;
+
+        /**
+        \brief Commits or releases the memory of the specified tiles of a sparse buffer.
+        \param[in] buffer Specifies the buffer whose tile mappings are to be updated. This must have been created with the MiscFlags::Sparse flag.
+        \param[in] numMappings Specifies the number of entries in the array \c mappings.
+        \param[in] mappings Pointer to an array of tile mappings. Each mapping either commits the memory of a byte range or releases it.
+        \remarks Tile mappings are updated in submission order of this queue.
+        \note Only supported with: Direct3D 12, Vulkan.
+        \see RenderingFeatures::hasSparseResources
+        */
+        virtual void UpdateTileMappings(Buffer& buffer, std::uint32_t numMappings, const BufferTileMapping* mappings) = 0;
 
         /* ----- Queries ----- */
 
@@ -96,11 +151,76 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
             std::size_t     dataSize
         ) = 0;
 
+        /**
+        \brief Retrieves the frame counters of all command buffers that have been submitted to this queue since the last call and resets them.
+        \param[out] outProfile Specifies the output profile. Only the counter values are written, i.e. the time and scope records remain empty.
+        \return True if LLGL was built with \c LLGL_ENABLE_FRAME_COUNTERS. Otherwise, the output profile is cleared and the return value is false.
+        \remarks Unlike the RenderingProfiler, these counters are bumped directly by the backend command buffers and do not require the debug layer.
+        Each command buffer resets its counters in CommandBuffer::Begin and they are accumulated every time the command buffer is submitted.
+        Only the counters for command encoding and submission are available,
+        i.e. the counters for operations outside of command buffers (such as FrameProfile::bufferWrites) are always zero.
+        Command buffers that were created with CommandBufferFlags::ImmediateSubmit are only accumulated if they are passed to Submit as well.
+        \remarks Resource bindings via CommandBuffer::SetResource are categorized by the binding flags of the resource rather than the binding slot,
+        e.g. a buffer with BindFlags::Storage is always counted as FrameProfile::storageBufferBindings.
+        \see FrameProfile
+        */
+        virtual bool QueryFrameCounters(FrameProfile& outProfile) = 0;
+
+        /**
+        \brief Samples a pair of correlated CPU and GPU timestamps for this command queue.
+        \param[out] outTimestamps Specifies the output timestamps. If the function returns false, this output is left unchanged.
+        \return True if the timestamps have been sampled. Otherwise, the backend does not provide GPU timestamps.
+        \remarks The native implementations are as follows:
+        - Vulkan: \c vkGetCalibratedTimestampsEXT if \c VK_EXT_calibrated_timestamps is supported.
+        - Direct3D 12: \c ID3D12CommandQueue::GetClockCalibration.
+        - Metal: <code>MTLDevice sampleTimestamps:gpuTimestamp:</code>.
+        - OpenGL: \c GL_TIMESTAMP query via \c glGetInteger64v.
+        - Direct3D 11: Timestamp query that is flushed and waited for on the CPU.
+        \remarks Vulkan and Direct3D 12 sample both timestamps in the driver, i.e. CalibratedTimestamps::maxDeviation is the deviation reported by Vulkan and zero for Direct3D 12.
+        The other backends measure the CPU time before and after the GPU timestamp is sampled and report that range as CalibratedTimestamps::maxDeviation.
+        For OpenGL and Direct3D 11, this may stall the CPU until all previously submitted commands have been flushed.
+        \see CalibratedTimestamps
+        \see QueryType::Timestamp
+        */
+        virtual bool GetCalibratedTimestamps(CalibratedTimestamps& outTimestamps) = 0;
+
         /* ----- Fences ----- */
 
-        //! Submits the specified fence to the command queue for CPU/GPU synchronization.
+        /**
+        \brief Submits the specified fence to the command queue for CPU/GPU synchronization.
+        \remarks Each fence holds a 64-bit value that is signaled by the GPU once all previously submitted commands of this queue have been completed.
+        This function signals the next value, i.e. the last submitted value plus one.
+        \see Submit(Fence&, std::uint64_t)
+        */
         virtual void Submit(Fence& fence) = 0;
 
+        /**
+        \brief Submits the specified fence to the command queue and lets the GPU signal the specified value.
+        \param[in] fence Specifies the fence that is to be signaled.
+        \param[in] value Specifies the value that is to be signaled. This must be greater than any value previously submitted for the same fence.
+        \remarks This can be used to track multiple points of GPU progress with a single fence, e.g. one value per frame.
+        \see WaitFence(Fence&, std::uint64_t, std::uint64_t)
+        \see SubmitWait
+        */
+        virtual void Submit(Fence& fence, std::uint64_t value) = 0;
+
+        /**
+        \brief Lets the GPU wait on this command queue until the specified fence has reached the specified value.
+        \param[in] fence Specifies the fence for which the GPU needs to wait.
+        \param[in] value Specifies the value the fence must have reached.
+        \remarks All command buffers that are submitted to this queue after this call will not be executed before the fence has reached the specified value.
+        This is used to synchronize work between different command queues, e.g. to let the graphics queue wait for the results of the compute queue:
+        \code
+        myComputeQueue->Submit(*myComputeCmdBuffer);
+        myComputeQueue->Submit(*myFence, frameIndex);
+        myGraphicsQueue->SubmitWait(*myFence, frameIndex);
+        myGraphicsQueue->Submit(*myGraphicsCmdBuffer);
+        \endcode
+        \note For backends that only provide a single hardware queue, this function has no effect since all work is executed in submission order.
+        If the Vulkan device does not support \c VK_KHR_timeline_semaphore, this wait is performed on the CPU.
+        */
+        virtual void SubmitWait(Fence& fence, std::uint64_t value) = 0;
+
         /**
         \brief Blocks the CPU execution until the specified fence has been signaled.
         \param[in] fence Specifies the fence for which the CPU needs to wait to be signaled.
@@ -111,6 +231,17 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual bool WaitFence(Fence& fence, std::uint64_t timeout) = 0;
 
+        /**
+        \brief Blocks the CPU execution until the specified fence has reached the specified value.
+        \param[in] fence Specifies the fence for which the CPU needs to wait.
+        \param[in] value Specifies the value the fence must have reached.
+        \param[in] timeout Specifies the waiting timeout (in nanoseconds). If this is zero, the function only polls the state of the fence.
+        \return True if the fence has reached the specified value, or false if the timeout has expired or the device is lost.
+        \remarks Returns false immediately if the specified value has not been submitted yet for backends that emulate fence values with binary fences.
+        \see Submit(Fence&, std::uint64_t)
+        */
+        virtual bool WaitFence(Fence& fence, std::uint64_t value, std::uint64_t timeout) = 0;
+
         /**
         \brief Blocks the CPU execution until the entire GPU command queue has been completed.
         \remarks To wait for a specific point in the command queue, use fences.
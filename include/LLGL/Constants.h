@@ -63,6 +63,12 @@ constexpr std::uint32_t invalidTimerID      = 0u;
 */
 constexpr std::uint32_t currentSwapIndex    = -1;
 
+/**
+\brief Specifies to let the render system select the video adapter.
+\see RenderSystemDescriptor::adapterIndex
+*/
+constexpr std::uint32_t defaultAdapter      = -1;
+
 
 } // /namespace Constants
 
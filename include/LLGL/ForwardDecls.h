@@ -13,6 +13,7 @@ namespace LLGL
 {
 
 
+class AccelerationStructure;
 class Buffer;
 class BufferArray;
 class Canvas;
@@ -36,6 +37,10 @@ class SwapChain;
 class Texture;
 class Window;
 
+struct AccelerationStructureBuildDescriptor;
+struct AccelerationStructureDescriptor;
+struct AccelerationStructureGeometryDescriptor;
+struct AccelerationStructureInstance;
 struct ApplicationDescriptor;
 struct AttachmentClear;
 struct AttachmentDescriptor;
@@ -44,7 +49,9 @@ struct BindingDescriptor;
 struct BlendDescriptor;
 struct BlendTargetDescriptor;
 struct BufferDescriptor;
+struct BufferTileMapping;
 struct BufferViewDescriptor;
+struct CalibratedTimestamps;
 struct CanvasDescriptor;
 struct CommandBufferDescriptor;
 struct ComputePipelineDescriptor;
@@ -58,12 +65,17 @@ struct DstImageDescriptor;
 struct Extent2D;
 struct Extent3D;
 struct FragmentAttribute;
+struct FrameProfile;
 struct GraphicsPipelineDescriptor;
 struct MetalDependentStateDescriptor;
 struct PipelineLayoutDescriptor;
 struct QueryHeapDescriptor;
 struct QueryPipelineStatistics;
 struct RasterizerDescriptor;
+struct RendererConfigurationDirect3D11;
+struct RendererConfigurationDirect3D12;
+struct RendererConfigurationMetal;
+struct RendererConfigurationNull;
 struct RendererConfigurationOpenGL;
 struct RendererConfigurationVulkan;
 struct RendererInfo;
@@ -87,6 +99,7 @@ struct StencilFaceDescriptor;
 struct SwapChainDescriptor;
 struct TextureDescriptor;
 struct TextureRegion;
+struct TextureTileMapping;
 struct TextureViewDescriptor;
 struct UniformDescriptor;
 struct VertexAttribute;
@@ -165,14 +165,55 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     unsigned                    threadCount = 0
 );
 
+/**
+\brief Callback for each band of rows that has been converted by ConvertImageBufferBands.
+\param[in] slice Specifies the zero-based slice the band belongs to. Bands never cross slice boundaries.
+\param[in] firstRow Specifies the zero-based first row of the band within its slice.
+\param[in] numRows Specifies the number of rows in the band.
+\param[in] data Pointer to the converted image data of this band. This is only valid until the callback returns.
+\param[in] dataSize Specifies the size (in bytes) of the converted image data of this band.
+\see ConvertImageBufferBands
+*/
+using ImageBandCallback = std::function<void(std::uint32_t slice, std::uint32_t firstRow, std::uint32_t numRows, const void* data, std::size_t dataSize)>;
+
+/**
+\brief Converts the source image in bands of rows into a caller-provided staging buffer, so the memory for the conversion is bounded by the staging buffer size.
+\param[in] srcImageDesc Specifies the source image descriptor. The image data must be tightly packed.
+\param[in] extent Specifies the image extent. The depth denotes the number of slices, e.g. the depth of a 3D image times the number of array layers.
+\param[in] dstFormat Specifies the destination image format.
+\param[in] dstDataType Specifies the destination image data type.
+\param[out] stagingBuffer Pointer to the staging buffer that receives the converted bands. This must not be null.
+\param[in] stagingBufferSize Specifies the size (in bytes) of the staging buffer. This must be large enough for at least one row of the destination image.
+\param[in] callback Specifies the callback that is invoked for each converted band, e.g. to upload it into a texture region.
+\param[in] threadCount Specifies the number of threads to use for the conversion of each band. See ConvertImageBuffer for details.
+\return True if the image was converted. Otherwise, no conversion is necessary and the callback is not invoked.
+\remarks This is used by texture uploads to avoid allocating an intermediate buffer for the entire converted image.
+\throw std::invalid_argument If the source buffer is too small for the specified extent.
+\throw std::invalid_argument If the staging buffer is null or too small for one row of the destination image.
+\see ConvertImageBuffer
+*/
+LLGL_EXPORT bool ConvertImageBufferBands(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    void*                       stagingBuffer,
+    std::size_t                 stagingBufferSize,
+    const ImageBandCallback&    callback,
+    unsigned                    threadCount = 0
+);
+
 /**
 \brief Decompresses the specified image buffer to RGBA format with 8-bit unsigned normalized integers.
 \param[in] srcImageDesc Specifies the source image descriptor.
 \param[in] extent Specifies the image extent. This is required as most compression formats work in block sizes.
+If the extent is not a multiple of the block size, the source image must still contain all partial blocks at the right and bottom border.
 \param[in] threadCount Specifies the number of threads to use for decompression.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
 \return Byte buffer with the decompressed image data or null if the compression format is not supported for decompression.
+\remarks Supported compression formats are ImageFormat::BC1, ImageFormat::BC2, ImageFormat::BC3, ImageFormat::BC4, and ImageFormat::BC5.
+BC4 and BC5 are decoded as unsigned normalized red and red-green channels respectively, while the remaining channels are set to (0, 0, 1).
 */
 LLGL_EXPORT ByteBuffer DecompressImageBufferToRGBA8UNorm(
     const SrcImageDescriptor&   srcImageDesc,
@@ -262,6 +303,18 @@ LLGL_EXPORT ByteBuffer AllocateByteBuffer(std::size_t bufferSize);
 */
 LLGL_EXPORT ByteBuffer AllocateByteBuffer(std::size_t bufferSize, UninitializeTag);
 
+/**
+\brief Sets the number of worker threads that are shared by all multi-threaded image utility functions, such as ConvertImageBuffer,
+and by the background compilation of RenderSystem::CreatePipelineStateAsync.
+\param[in] threadCount Specifies the number of worker threads. If this is 0, all work is done on the calling thread.
+If this is 'Constants::maxThreadCount', one worker thread is used for each hardware thread except for the calling thread, which is the default.
+\remarks The worker threads are created the first time multi-threading is used and are kept alive until the process exits.
+The \c threadCount parameter of the image utility functions only determines into how many parts the work is split.
+\remarks This must not be called while any of the image utility functions are running on another thread.
+\see Constants::maxThreadCount
+*/
+LLGL_EXPORT void SetWorkerThreadCount(unsigned threadCount);
+
 /** @} */
 
 
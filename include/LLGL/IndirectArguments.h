@@ -141,6 +141,21 @@ struct DispatchIndirectArguments
     std::uint32_t numThreadGroups[3];
 };
 
+/**
+\brief Format structure for the arguments of an indirect mesh draw command.
+\remarks This structure is byte aligned, i.e. it can be reinterpret casted to a buffer in CPU memory space.
+\note This is a plain-old-data (POD) structure, so it has no default constructor to make it easily compatible with the GPU memory space.
+\see CommandBuffer::DrawMeshTasksIndirect
+\see Vulkan counterpart \c VkDrawMeshTasksIndirectCommandEXT: https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDrawMeshTasksIndirectCommandEXT.html
+\see Direct3D12 counterpart \c D3D12_DISPATCH_MESH_ARGUMENTS: https://learn.microsoft.com/en-us/windows/win32/api/d3d12/ns-d3d12-d3d12_dispatch_mesh_arguments
+\see Metal counterpart \c MTLDispatchThreadgroupsIndirectArguments: https://developer.apple.com/documentation/metal/mtldispatchthreadgroupsindirectarguments?language=objc
+*/
+struct DrawMeshTasksIndirectArguments
+{
+    //! Number of task (or mesh) thread groups in X, Y, and Z dimension.
+    std::uint32_t numThreadGroups[3];
+};
+
 /** @} */
 
 
@@ -52,6 +52,7 @@ struct InterfaceID
         Texture,                //!< Extends RenderSystemChild. \see Texture
         RenderTarget,           //!< Extends RenderSystemChild. \see RenderTarget
         SwapChain,              //!< Extends RenderTarget. \see SwapChain
+        AccelerationStructure,  //!< Extends Resource. \see AccelerationStructure
 
         /**
         \brief Maximum reserved ID for interfaces.
@@ -42,6 +42,33 @@ enum class ReportType
     Error,
 };
 
+/**
+\brief Log dispatch mode enumeration.
+\remarks This determines on which thread the registered log callbacks are invoked.
+\see SetDispatchMode
+*/
+enum class DispatchMode
+{
+    /**
+    \brief Log callbacks are invoked on the thread that generates the report, before Printf or Errorf returns. This is the default mode.
+    \remarks All reports are serialized with a single lock in this mode.
+    */
+    Immediate = 0,
+
+    /**
+    \brief Reports are appended to a lock-free queue and the log callbacks are only invoked by the next call to Flush.
+    \remarks Use this mode to keep the threads that generate reports from blocking each other, e.g. when several threads record command buffers.
+    The application is responsible for calling Flush regularly, e.g. once per frame.
+    */
+    Deferred,
+
+    /**
+    \brief Reports are appended to a lock-free queue and the log callbacks are invoked by a dedicated dispatch thread.
+    \remarks Flush can still be called to invoke the log callbacks for all pending reports on the calling thread.
+    */
+    Background,
+};
+
 
 /* ----- Types ----- */
 
@@ -123,6 +150,23 @@ LLGL_EXPORT LogHandle RegisterCallbackStd();
 */
 LLGL_EXPORT void UnregisterCallback(LogHandle handle);
 
+/**
+\brief Specifies how reports are dispatched to the registered log callbacks. By default, DispatchMode::Immediate.
+\remarks When switching back to DispatchMode::Immediate, all pending reports are flushed before this function returns.
+If the queue of pending reports is full, the reporting thread flushes it before it appends its own report.
+\see DispatchMode
+\see Flush
+*/
+LLGL_EXPORT void SetDispatchMode(const DispatchMode mode);
+
+/**
+\brief Invokes the registered log callbacks for all pending reports on the calling thread.
+\remarks This has no effect if there are no pending reports, which is always the case in DispatchMode::Immediate.
+Reports that are generated inside a log callback during a flush are ignored, just like recursive calls to Printf and Errorf.
+\see SetDispatchMode
+*/
+LLGL_EXPORT void Flush();
+
 
 } // /namespace Log
 
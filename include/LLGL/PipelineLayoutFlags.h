@@ -365,6 +365,27 @@ struct PipelineLayoutDescriptor
     \see CommandBuffer::SetUniforms
     */
     std::vector<UniformDescriptor>          uniforms;
+
+    /**
+    \brief Specifies whether the heap bindings form a bindless resource heap. By default false.
+    \remarks If enabled, each heap binding describes an array of BindingDescriptor::arraySize descriptors (or a single descriptor if the array size is zero)
+    and each element of these arrays occupies its own descriptor in a ResourceHeap, in the same order as the heap bindings are declared.
+    Elements that are never written may remain unbound as long as the shaders don't access them,
+    and elements that are not accessed by any command buffer in flight may be written without waiting for the GPU to become idle.
+    \remarks This is meant to bind large arrays of resources once and select individual elements in the shaders with indices that are passed via uniforms.
+    \remarks For OpenGL, the elements of an array binding occupy consecutive binding slots, starting at BindingDescriptor::slot.
+    Sampled textures are the exception: their resident texture handles (\c GL_ARB_bindless_texture) are stored in a uniform block at the binding slot,
+    which must be declared with \c std140 layout, e.g. <code>layout(std140, binding = 2) uniform Textures { sampler2D textures[64]; };</code>.
+    Each texture is combined with the sampler that is written to the heap binding of type ResourceType::Sampler at the same slot (if any),
+    either per array element or a single sampler for all elements. Binding a texture handle makes the texture and sampler state immutable.
+    \remarks For Metal, the heap bindings are encoded into an argument buffer which is bound to buffer slot 29 of each shader stage that has heap bindings.
+    The argument index of each array element is BindingDescriptor::slot plus the array element index,
+    e.g. <code>struct Heap { array<texture2d<float>, 64> textures [[id(2)]]; }; fragment float4 PS(constant Heap& heap [[buffer(29)]])</code>.
+    \see RenderSystem::WriteResourceHeap
+    \see RenderingFeatures::hasBindlessResources
+    \note Only supported with: Vulkan, Direct3D 12, OpenGL, Metal.
+    */
+    bool                                    bindlessHeap = false;
 };
 
 
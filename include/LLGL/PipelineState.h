@@ -36,6 +36,23 @@ class LLGL_EXPORT PipelineState : public RenderSystemChild
         */
         virtual const Report* GetReport() const = 0;
 
+        /**
+        \brief Returns true if this pipeline state has finished compiling, i.e. querying its report or binding it will not block.
+        \remarks This query never blocks. Backends that compile pipeline states synchronously always return true.
+        With OpenGL, shaders and programs are compiled asynchronously by the driver if \c GL_KHR_parallel_shader_compile or \c GL_ARB_parallel_shader_compile is supported.
+        In that case, the compile and link status is only queried when the report is requested or the PSO is bound for the first time.
+        \see GetReport
+        */
+        virtual bool IsReady() const;
+
+        /**
+        \brief Blocks the calling thread until this pipeline state has finished compiling, i.e. until IsReady returns true.
+        \remarks Backends that compile pipeline states synchronously return immediately.
+        \see IsReady
+        \see RenderSystem::CreatePipelineStateAsync
+        */
+        virtual void Wait();
+
 };
 
 
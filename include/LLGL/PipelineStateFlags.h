@@ -269,6 +269,70 @@ enum class TessellationPartition
     FractionalEven,
 };
 
+/**
+\brief Fragment shading rate enumeration for variable rate shading (VRS).
+\remarks Each entry specifies the size of a block of pixels (width x height) that is covered by a single fragment shader invocation.
+\see ShadingRateDescriptor::rate
+\see RenderingFeatures::hasVariableRateShading
+*/
+enum class ShadingRate
+{
+    //! One fragment shader invocation per pixel. This is the default.
+    Rate1x1 = 0,
+
+    //! One fragment shader invocation per 1x2 pixel block.
+    Rate1x2,
+
+    //! One fragment shader invocation per 2x1 pixel block.
+    Rate2x1,
+
+    //! One fragment shader invocation per 2x2 pixel block.
+    Rate2x2,
+
+    /**
+    \brief One fragment shader invocation per 2x4 pixel block.
+    \remarks With Direct3D 12, this requires \c AdditionalShadingRatesSupported. Otherwise, the rate is clamped by the driver.
+    */
+    Rate2x4,
+
+    /**
+    \brief One fragment shader invocation per 4x2 pixel block.
+    \remarks With Direct3D 12, this requires \c AdditionalShadingRatesSupported. Otherwise, the rate is clamped by the driver.
+    */
+    Rate4x2,
+
+    /**
+    \brief One fragment shader invocation per 4x4 pixel block.
+    \remarks With Direct3D 12, this requires \c AdditionalShadingRatesSupported. Otherwise, the rate is clamped by the driver.
+    */
+    Rate4x4,
+};
+
+/**
+\brief Enumeration of operations to combine the shading rate of a graphics pipeline with the shading rate of a shading-rate image.
+\see ShadingRateDescriptor::imageCombiner
+*/
+enum class ShadingRateCombiner
+{
+    //! Keeps the shading rate of the pipeline and ignores the shading-rate image. This is the default.
+    Keep = 0,
+
+    //! Replaces the shading rate of the pipeline by the shading rate of the image.
+    Replace,
+
+    /**
+    \brief Selects the finer shading rate of both, i.e. the one with more fragment shader invocations.
+    \remarks With Vulkan, this requires \c fragmentShadingRateNonTrivialCombinerOps. Otherwise, it falls back to ShadingRateCombiner::Replace.
+    */
+    Min,
+
+    /**
+    \brief Selects the coarser shading rate of both, i.e. the one with less fragment shader invocations.
+    \remarks With Vulkan, this requires \c fragmentShadingRateNonTrivialCombinerOps. Otherwise, it falls back to ShadingRateCombiner::Replace.
+    */
+    Max,
+};
+
 
 /* ----- Flags ----- */
 
@@ -746,6 +810,29 @@ struct TessellationDescriptor
     bool                    outputWindingCCW    = false;
 };
 
+/**
+\brief Variable rate shading (VRS) state descriptor structure.
+\remarks Fragment-bound passes, such as post-processing or dense foliage, can reduce their fragment shader invocations with a coarser shading rate.
+\see GraphicsPipelineDescriptor::shadingRate
+\see RenderingFeatures::hasVariableRateShading
+*/
+struct ShadingRateDescriptor
+{
+    /**
+    \brief Specifies the shading rate for all draw commands with this pipeline. By default ShadingRate::Rate1x1.
+    \remarks If this is not ShadingRate::Rate1x1, the feature RenderingFeatures::hasVariableRateShading is required.
+    */
+    ShadingRate         rate            = ShadingRate::Rate1x1;
+
+    /**
+    \brief Specifies how the shading rate of this pipeline is combined with the shading-rate image of the current render target. By default ShadingRateCombiner::Keep.
+    \remarks Use ShadingRateCombiner::Replace or ShadingRateCombiner::Max to apply the shading-rate image, e.g. to shade peripheral regions at a coarser rate.
+    If the current render target has no shading-rate image, it is treated as if it contained ShadingRate::Rate1x1 everywhere.
+    \see RenderTargetDescriptor::shadingRateImage
+    */
+    ShadingRateCombiner imageCombiner   = ShadingRateCombiner::Keep;
+};
+
 /**
 \brief Graphics pipeline state descriptor structure.
 \remarks This structure describes the entire graphics pipeline:
@@ -773,7 +860,7 @@ struct GraphicsPipelineDescriptor
 
     /**
     \brief Specifies the vertex shader.
-    \remarks Each graphics pipeline must have at least a vertex shader. Therefore, this must never be null when a graphics PSO is created.
+    \remarks Each graphics pipeline must have either a vertex shader or a mesh shader (see \c meshShader), but not both.
     With OpenGL, this shader may also have a stream output.
     */
     Shader*                 vertexShader            = nullptr;
@@ -806,6 +893,25 @@ struct GraphicsPipelineDescriptor
     */
     Shader*                 fragmentShader          = nullptr;
 
+    /**
+    \brief Specifies an optional task shader (also referred to as "Amplification Shader" or "Object Shader").
+    \remarks If this is used, \c meshShader must also be specified.
+    The task shader determines how many mesh shader thread groups are launched, which allows to cull meshlets on the GPU.
+    \see RenderingFeatures::hasMeshShaders
+    */
+    Shader*                 taskShader              = nullptr;
+
+    /**
+    \brief Specifies the mesh shader for a mesh pipeline.
+    \remarks If this is used, the pipeline replaces the vertex input, vertex, tessellation, and geometry shader stages by the task and mesh shader stages.
+    Such pipelines must only be used with CommandBuffer::DrawMeshTasks and CommandBuffer::DrawMeshTasksIndirect
+    and the members \c vertexShader, \c tessControlShader, \c tessEvaluationShader, and \c geometryShader must be null.
+    The primitive topology is determined by the mesh shader, but \c primitiveTopology must still specify a list topology of the same primitive type.
+    \remarks With Direct3D 12, task and mesh shaders must be loaded from precompiled DXIL byte code (shader model 6.5 or later).
+    \see RenderingFeatures::hasMeshShaders
+    */
+    Shader*                 meshShader              = nullptr;
+
     /**
     \brief Specifies the primitive topology and ordering of the primitive data. By default PrimitiveTopology::TriangleList.
     \see PrimitiveTopology
@@ -847,6 +953,23 @@ struct GraphicsPipelineDescriptor
     \note Only supported with: Metal.
     */
     TessellationDescriptor  tessellation;
+
+    /**
+    \brief Specifies the variable rate shading state.
+    \note Only supported with: Direct3D 12, Vulkan (if the extension \c VK_KHR_fragment_shading_rate is supported).
+    \see RenderingFeatures::hasVariableRateShading
+    */
+    ShadingRateDescriptor   shadingRate;
+
+    /**
+    \brief Specifies the bitmask of views this pipeline renders with multiview rendering. By default 0.
+    \remarks This must be equal to the view mask of the render pass this pipeline is used in (see RenderPassDescriptor::viewMask).
+    If this is 0, multiview rendering is disabled for this pipeline.
+    \remarks With Metal, the vertex shader must write the output \c [[render_target_array_index]],
+    which is offset with the view index by the vertex amplification, and with OpenGL, the vertex shader must declare <code>layout(num_views = N) in;</code>.
+    \see RenderingFeatures::hasMultiview
+    */
+    std::uint32_t           viewMask                = 0;
 };
 
 /**
@@ -860,13 +983,23 @@ struct ComputePipelineDescriptor
     \remarks This layout determines at which slots buffer resources can be bound.
     This is ignored by render systems which do not support pipeline layouts.
     */
-    const PipelineLayout*   pipelineLayout  = nullptr;
+    const PipelineLayout*   pipelineLayout          = nullptr;
 
     /**
     \brief Specifies the compute shader.
     \remarks This must never be null when a compute PSO is created.
     */
-    Shader*                 computeShader   = nullptr;
+    Shader*                 computeShader           = nullptr;
+
+    /**
+    \brief Specifies the subgroup size the compute shader must be executed with. By default 0.
+    \remarks If this is 0, the render system chooses the subgroup size. Otherwise, this must be a power of two
+    in the range [RenderingLimits::minSubgroupSize, RenderingLimits::maxSubgroupSize], and the compute shader is also dispatched with full subgroups,
+    so kernels can select a wave-optimized variant and rely on a known number of invocations per subgroup.
+    \remarks This is ignored by render systems that do not support RenderingFeatures::hasSubgroupSizeControl.
+    \see RenderingFeatures::hasSubgroupSizeControl
+    */
+    std::uint32_t           requiredSubgroupSize    = 0;
 };
 
 
@@ -49,6 +49,15 @@ enum class QueryType
     \see RenderingFeatures::hasPipelineStatistics
     */
     PipelineStatistics,
+
+    /**
+    \brief GPU timestamp (in nanoseconds) that is written when all previous commands have been completed.
+    \remarks Timestamps are written with CommandBuffer::EndQuery only, i.e. CommandBuffer::BeginQuery must not be called for this query type.
+    The results must be retrieved as 64-bit values and are only meaningful relative to other timestamps of the same command queue.
+    In contrast to TimeElapsed, timestamps can be nested and interleaved arbitrarily, which makes them suitable for hierarchical profiling.
+    \note Only supported with: Direct3D 11, Direct3D 12, Vulkan, OpenGL, Metal.
+    */
+    Timestamp,
 };
 
 
@@ -100,6 +109,37 @@ struct QueryPipelineStatistics
     std::uint64_t computeShaderInvocations          = 0;
 };
 
+/**
+\brief Pair of CPU and GPU timestamps that have been sampled at the same point in time.
+\remarks This is used to map GPU timestamps from QueryType::Timestamp queries onto the CPU timeline of Timer::Tick, e.g. to align CPU submissions with GPU execution in a trace:
+\code
+LLGL::CalibratedTimestamps calibration;
+if (myCmdQueue->GetCalibratedTimestamps(calibration))
+{
+    // Convert GPU timestamp from query (in nanoseconds) into CPU ticks
+    const double gpuTimeOffset = static_cast<double>(static_cast<std::int64_t>(myGPUTimestamp - calibration.gpuTimestamp));
+    const double ticksPerNanosecond = static_cast<double>(LLGL::Timer::Frequency()) / 1.0e9;
+    const std::uint64_t cpuTickOfGPUTimestamp = calibration.cpuTicks + static_cast<std::int64_t>(gpuTimeOffset * ticksPerNanosecond);
+}
+\endcode
+\remarks GPU and CPU clocks may drift apart over time, so the calibration should be repeated periodically, e.g. once per second.
+\see CommandQueue::GetCalibratedTimestamps
+*/
+struct CalibratedTimestamps
+{
+    //! CPU timestamp in the same domain as Timer::Tick, i.e. it is measured in ticks of Timer::Frequency.
+    std::uint64_t   cpuTicks        = 0;
+
+    //! GPU timestamp (in nanoseconds) in the same domain as the results of QueryType::Timestamp queries that are submitted to the same command queue.
+    std::uint64_t   gpuTimestamp    = 0;
+
+    /**
+    \brief Upper bound (in nanoseconds) of the time between the CPU and GPU timestamp samples.
+    \remarks This is zero if the native API samples both timestamps atomically or if it does not provide an upper bound.
+    */
+    std::uint64_t   maxDeviation    = 0;
+};
+
 /**
 \brief Query heap descriptor structure.
 \see RenderSystem::CreateQueryHeap
@@ -25,7 +25,11 @@ namespace LLGL
 */
 enum class AttachmentLoadOp
 {
-    //! We don't care about the previous content of the respective render target attachment.
+    /**
+    \brief We don't care about the previous content of the respective render target attachment.
+    \remarks For OpenGL, the attachment is invalidated via \c glInvalidateFramebuffer (if supported) when the render pass begins,
+    which allows tile-based GPUs to skip loading its content from memory.
+    */
     Undefined,
 
     //! Loads the previous content of the respective render target attachment.
@@ -48,6 +52,8 @@ enum class AttachmentStoreOp
     /**
     \brief We don't care about the outcome of the respective render target attachment.
     \remarks Can be used, for example, if we only need the depth buffer for the depth test, but nothing is written to it.
+    \remarks For OpenGL, the attachment is invalidated via \c glInvalidateFramebuffer (if supported) after multi-sampled attachments have been resolved when the render pass ends,
+    which allows tile-based GPUs to skip storing its content to memory.
     */
     Undefined,
 
@@ -152,6 +158,23 @@ struct RenderPassDescriptor
     \see RenderingLimits::maxNoAttachmentSamples
     */
     std::uint32_t               samples             = 1;
+
+    /**
+    \brief Specifies the bitmask of views that are rendered with multiview rendering. By default 0.
+    \remarks If this is 0, multiview rendering is disabled. Otherwise, each draw call is broadcast to all views whose bit is set,
+    and the view with index \c i renders into the array layer <code>AttachmentDescriptor::arrayLayer + i</code> of each attachment.
+    The shaders can determine the current view with \c gl_ViewIndex (GLSL), \c SV_ViewID (HLSL), or \c [[amplification_id]] (Metal).
+    This is typically used for stereo rendering with a view mask of 0x3, so each draw call is recorded only once for both eyes.
+    \remarks The number of views, i.e. the number of bits that are set, must not be greater than RenderingLimits::maxMultiviewViewCount.
+    With OpenGL, the bits must be consecutive, starting with the least significant bit.
+    With Metal, layered rendering ignores the array layer of the attachments, i.e. the view with index \c i always renders into the array layer \c i.
+    \remarks Render targets that are used with a multiview render pass must specify that render pass in RenderTargetDescriptor::renderPass
+    and all their attachments must provide enough array layers for the highest view index.
+    Graphics pipelines that are used within this render pass must specify the same view mask (see GraphicsPipelineDescriptor::viewMask).
+    \note Only supported with: Vulkan (requires \c VK_KHR_multiview), OpenGL (requires \c GL_OVR_multiview2), Metal (requires vertex amplification).
+    \see RenderingFeatures::hasMultiview
+    */
+    std::uint32_t               viewMask            = 0;
 };
 
 
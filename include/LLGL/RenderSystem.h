@@ -41,6 +41,8 @@
 #include <LLGL/PipelineStateFlags.h>
 #include <LLGL/QueryHeap.h>
 #include <LLGL/QueryHeapFlags.h>
+#include <LLGL/AccelerationStructure.h>
+#include <LLGL/AccelerationStructureFlags.h>
 #include <LLGL/Fence.h>
 
 #include <string>
@@ -235,8 +237,16 @@ class LLGL_EXPORT RenderSystem : public Interface
 
         /* ----- Command queues ----- */
 
-        //! Returns the single instance of the command queue.
-        virtual CommandQueue* GetCommandQueue() = 0;
+        /**
+        \brief Returns the command queue of the specified type.
+        \param[in] type Specifies the type of command queue. By default CommandQueueType::Graphics.
+        \remarks If the backend or the hardware does not provide a dedicated queue for the specified type,
+        the graphics queue is returned, i.e. multiple types can refer to the same CommandQueue instance.
+        Commands submitted to different queues are not ordered with respect to each other.
+        Use a Fence that is submitted to one queue and waited upon on the CPU to synchronize work between queues.
+        \see CommandBufferDescriptor::queueType
+        */
+        virtual CommandQueue* GetCommandQueue(const CommandQueueType type = CommandQueueType::Graphics) = 0;
 
         /* ----- Command buffers ----- */
 
@@ -266,6 +276,21 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) = 0;
 
+        /**
+        \brief Creates multiple generic hardware buffers at once.
+        \param[in] numBuffers Specifies the number of buffers that are to be created.
+        \param[in] bufferDescs Pointer to an array of \c numBuffers buffer descriptors.
+        \param[in] initialData Optional pointer to an array of \c numBuffers raw pointers to the initial data of each buffer.
+        Individual entries of this array may be null. If the array itself is null, none of the buffers will be initialized.
+        \param[out] outBuffers Pointer to an array of \c numBuffers entries that receive the new buffer objects.
+        \remarks This is equivalent to calling CreateBuffer for each descriptor, but the Vulkan and Direct3D 12 backends
+        share their staging memory between all buffers and perform all initial uploads with a single submission.
+        This should be preferred when a large number of buffers is created at once, e.g. when a scene is loaded.
+        Each buffer must still be released individually.
+        \see CreateBuffer
+        */
+        virtual void CreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, const void* const * initialData, Buffer** outBuffers) = 0;
+
         /**
         \brief Creates a new buffer array.
         \param[in] numBuffers Specifies the number of buffers in the array. This must be greater than 0.
@@ -306,7 +331,10 @@ class LLGL_EXPORT RenderSystem : public Interface
         \param[in] offset Specifies the offset (in bytes) at which the buffer is to be read.
         \param[out] data Raw pointer to a memory block in CPU memory space where the data will be written to.
         \param[in] dataSize Specifies the size (in bytes) of the data block given by the \c data parameter.
+        \remarks This function waits until the GPU has finished all previously submitted work.
+        To read back data without stalling the GPU, copy it into a buffer that was created with MiscFlags::HostVisible and map that buffer once its fence has been signaled.
         \see WriteBuffer
+        \see MiscFlags::HostVisible
         */
         virtual void ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize) = 0;
 
@@ -362,6 +390,21 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) = 0;
 
+        /**
+        \brief Creates multiple textures at once.
+        \param[in] numTextures Specifies the number of textures that are to be created.
+        \param[in] textureDescs Pointer to an array of \c numTextures texture descriptors.
+        \param[in] imageDescs Optional pointer to an array of \c numTextures pointers to the image data descriptor of each texture.
+        Individual entries of this array may be null, in which case the respective texture is initialized as described for CreateTexture.
+        If the array itself is null, this applies to all textures.
+        \param[out] outTextures Pointer to an array of \c numTextures entries that receive the new texture objects.
+        \remarks This is equivalent to calling CreateTexture for each descriptor, but the Vulkan and Direct3D 12 backends
+        perform all initial uploads and MIP-map generations with a single submission.
+        Each texture must still be released individually.
+        \see CreateTexture
+        */
+        virtual void CreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, const SrcImageDescriptor* const * imageDescs, Texture** outTextures) = 0;
+
         //! Releases the specified texture object. After this call, the specified object must no longer be used.
         virtual void Release(Texture& texture) = 0;
 
@@ -403,8 +446,11 @@ class LLGL_EXPORT RenderSystem : public Interface
         or <code>imageDesc.data</code> points to a buffer that is smaller than specified by <code>imageDesc.dataSize</code>,
         or <code>imageDesc.dataSize</code> is less than the required size.
         \throws std::invalid_argument If <code>imageDesc.data</code> is null.
+        \remarks This function waits until the GPU has finished all previously submitted work.
+        To read back texture data without stalling the GPU, use CommandBuffer::CopyBufferFromTexture with a buffer that was created with MiscFlags::HostVisible.
         \see Texture::GetDesc
         \see Texture::GetMipExtent
+        \see MiscFlags::HostVisible
         */
         virtual void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) = 0;
 
@@ -450,7 +496,10 @@ class LLGL_EXPORT RenderSystem : public Interface
         multiplied by the number of descriptor sets in the resource heap (ResourceHeap::GetNumDescriptorSets).
         \param[in] resourceViews Array of resource view descriptors.
         \remarks The type of a resource view, i.e. whether it's a buffer, texture, or sampler, must not be changed with this function.
+        \remarks If the resource heap was created with more than one version per descriptor set, this function can be called from any thread
+        and it does not wait for pending command buffers that refer to the resource heap. Only command buffers that bind the resource heap afterwards see the new resource views.
         \return Number of resource views that have been updated by this call. Any resource view descriptor with a \c resource field that is null will be ignored silently.
+        \see ResourceHeapDescriptor::numVersions
         \see ResourceHeap::GetNumDescriptorSets
         \see PipelineLayout::GetNumHeapBindings
         */
@@ -561,6 +610,11 @@ class LLGL_EXPORT RenderSystem : public Interface
         \param[out] serializedCache Optional pointer to a Blob instance. If this is not null, the renderer returns the pipeline state as serialized cache.
         This cache may be unique to the respective hardware and driver the application is running on. The behavior is undefined if this cache is used in a different software environment.
         It can be used to faster restore a pipeline state on next application run.
+        \remarks The OpenGL backend also reads from \c serializedCache: If it is not empty, the shader programs are restored from the program binaries it contains
+        instead of being linked from source. Binaries that were created with different shaders or a different driver are ignored transparently.
+        \remarks The Metal backend stores the compiled pipeline functions in \c serializedCache as \c MTLBinaryArchive (macOS 11 and iOS 14 or later) and loads them from it if it is not empty.
+        Metal PSOs are created in the background: This function returns immediately and the PSO is waited on when it is bound or when its report is queried.
+        Creation errors are therefore written to the PSO report (see PipelineState::GetReport) instead of being thrown as exception.
         \see GraphicsPipelineDescriptor
         \see CreatePipelineState(const Blob&)
         */
@@ -573,11 +627,44 @@ class LLGL_EXPORT RenderSystem : public Interface
         \param[out] serializedCache Optional pointer to a Blob instance. If this is not null, the renderer returns the pipeline state as serialized cache.
         This cache may be unique to the respective hardware and driver the application is running on. The behavior is undefined if this cache is used in a different software environment.
         It can be used to faster restore a pipeline state on next application run.
+        \remarks The OpenGL backend also reads from \c serializedCache: If it is not empty, the shader programs are restored from the program binaries it contains
+        instead of being linked from source. Binaries that were created with different shaders or a different driver are ignored transparently.
+        \remarks The Metal backend stores the compiled pipeline functions in \c serializedCache as \c MTLBinaryArchive (macOS 11 and iOS 14 or later) and loads them from it if it is not empty.
+        Metal PSOs are created in the background: This function returns immediately and the PSO is waited on when it is bound or when its report is queried.
+        Creation errors are therefore written to the PSO report (see PipelineState::GetReport) instead of being thrown as exception.
         \see ComputePipelineDescriptor
         \see CreatePipelineState(const Blob&)
         */
         virtual PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* serializedCache = nullptr) = 0;
 
+        /**
+        \brief Creates a new graphics pipeline state object (PSO) that is compiled in the background.
+        \param[in] pipelineStateDesc Specifies the graphics PSO descriptor. The descriptor itself is copied,
+        but the shaders, pipeline layout, and render pass it refers to must not be released until the PSO is ready.
+        \param[in] fallbackPipelineState Optional pointer to a graphics PSO that is bound in place of the new PSO as long as the new PSO is not ready.
+        This should be created with the same pipeline layout and a compatible render pass, since all subsequent bindings use the fallback's layout. By default null.
+        \remarks This function returns immediately and the native PSO is compiled on the internal worker threads (see SetWorkerThreadCount).
+        Use PipelineState::IsReady to poll for completion and PipelineState::Wait to block until the PSO is compiled.
+        Binding the PSO before it is ready either binds the fallback PSO or, if there is none, blocks until the PSO is compiled.
+        Creation errors are written to the PSO report (see PipelineState::GetReport) instead of being thrown as exception.
+        \remarks Backends without background compilation create the PSO the same way as CreatePipelineState, i.e. the PSO is ready when this function returns.
+        The OpenGL backend still compiles shaders in parallel if \c GL_KHR_parallel_shader_compile or \c GL_ARB_parallel_shader_compile is supported.
+        \note Only supported with: Vulkan, Direct3D 12, Metal.
+        \see CreatePipelineState(const GraphicsPipelineDescriptor&, Blob*)
+        \see PipelineState::IsReady
+        */
+        virtual PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState = nullptr) = 0;
+
+        /**
+        \brief Creates a new compute pipeline state object (PSO) that is compiled in the background.
+        \param[in] pipelineStateDesc Specifies the compute PSO descriptor. The compute shader and pipeline layout it refers to must not be released until the PSO is ready.
+        \param[in] fallbackPipelineState Optional pointer to a compute PSO that is bound in place of the new PSO as long as the new PSO is not ready. By default null.
+        \remarks This behaves the same way as the overload for graphics PSOs.
+        \note Only supported with: Vulkan, Direct3D 12, Metal.
+        \see CreatePipelineStateAsync(const GraphicsPipelineDescriptor&, PipelineState*)
+        */
+        virtual PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState = nullptr) = 0;
+
         //! Releases the specified PipelineState object. After this call, the specified object must no longer be used.
         virtual void Release(PipelineState& pipelineState) = 0;
 
@@ -589,6 +676,19 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Releases the specified QueryHeap object. After this call, the specified object must no longer be used.
         virtual void Release(QueryHeap& queryHeap) = 0;
 
+        /* ----- Acceleration structures ----- */
+
+        /**
+        \brief Creates a new ray tracing acceleration structure.
+        \remarks The acceleration structure is empty until it has been built with CommandBuffer::BuildAccelerationStructure.
+        \note Only supported with: Vulkan (requires \c VK_KHR_acceleration_structure), Direct3D 12 (requires DXR tier 1.1).
+        \see RenderingFeatures::hasRayTracing
+        */
+        virtual AccelerationStructure* CreateAccelerationStructure(const AccelerationStructureDescriptor& accelerationStructureDesc) = 0;
+
+        //! Releases the specified AccelerationStructure object. After this call, the specified object must no longer be used.
+        virtual void Release(AccelerationStructure& accelerationStructure) = 0;
+
         /* ----- Fences ----- */
 
         /**
@@ -641,6 +741,125 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual bool GetNativeHandle(void* nativeHandle, std::size_t nativeHandleSize) = 0;
 
+        /**
+        \brief Releases device memory the backend retains for reuse after its resources have been released, up to the specified budget.
+        \param[in] budget Specifies the maximum number of bytes that can be released with this call.
+        This allows long-running applications to return retained device memory incrementally, e.g. once per frame.
+        \return Number of bytes that have been released.
+        \remarks The Vulkan backend keeps one empty device memory chunk per memory type
+        to avoid re-allocating device memory when resources are frequently created and released.
+        This function only releases those retained chunks.
+        It does \e not relocate resources that are still alive, so partially used chunks remain allocated,
+        since Vulkan memory bindings are immutable and the native handles of buffers and textures must remain valid.
+        The Direct3D 12 backend likewise retains one empty ID3D12Heap per heap type and category for placed resources,
+        and also shrinks the staging buffers of its internal command context if the budget has not been exhausted by the heaps.
+        Use CommandBuffer::TrimMemory to shrink the staging buffers of command buffers.
+        \note Only supported with: Vulkan, Direct3D 12. All other backends let the driver manage device memory and return 0.
+        */
+        virtual std::uint64_t ReleaseRetainedMemory(std::uint64_t budget) = 0;
+
+        /**
+        \brief Queries the current memory statistics of all GPU memory heaps.
+        \param[out] outStatistics Specifies the output structure the statistics are written to. Previous content is discarded.
+        \return True if the statistics could be queried. Otherwise, \c outStatistics.heaps is empty.
+        \remarks This can be used to throttle resource streaming before the device runs out of memory,
+        e.g. by comparing MemoryHeapStatistics::usage against MemoryHeapStatistics::budget of each device local heap.
+        \remarks The budget with Vulkan is only available if the device supports \c VK_EXT_memory_budget.
+        Direct3D reports the budget of the local and non-local memory segment groups via \c IDXGIAdapter3::QueryVideoMemoryInfo.
+        Metal reports a single heap with \c MTLDevice.recommendedMaxWorkingSetSize as budget and \c MTLDevice.currentAllocatedSize as usage.
+        \note Only supported with: Vulkan, Direct3D 12, Direct3D 11, Metal.
+        \see MemoryStatistics
+        */
+        virtual bool QueryMemoryStatistics(MemoryStatistics& outStatistics) = 0;
+
+        /**
+        \brief Sets the priority hint of the device memory of the specified buffer or texture.
+        \param[in] resource Specifies the buffer or texture whose memory priority is to be changed.
+        \param[in] priority Specifies the priority in the range [0, 1]. Values outside this range are clamped.
+        All resources start with a priority of 0.5. Resources with a higher priority, e.g. render targets that are used every frame,
+        are more likely to remain in video memory when the OS has to demote allocations into system memory under memory oversubscription.
+        \return True if the priority hint has been applied. Otherwise, the backend or device does not support memory priorities.
+        \remarks The Vulkan backend requires \c VK_EXT_pageable_device_local_memory and changes the priority of the entire device memory chunk the resource has been allocated from.
+        Since small resources share their chunks, the priority of a shared chunk is only ever raised, so that a hot resource is not demoted with the cold resources next to it.
+        The Direct3D 12 backend calls \c ID3D12Device1::SetResidencyPriority on committed resources, or on the heap of placed resources with the same rule as for shared chunks.
+        The Direct3D 11 backend calls \c IDXGIResource::SetEvictionPriority.
+        \note Only supported with: Vulkan, Direct3D 12, Direct3D 11.
+        */
+        virtual bool SetMemoryPriority(Resource& resource, float priority) = 0;
+
+        /**
+        \brief Returns the serialized content of the device-wide pipeline cache.
+        \remarks This is meant to be called right before the render system is unloaded.
+        The returned Blob can be stored on disk and passed to the next render system via RendererConfigurationVulkan::pipelineCacheData
+        or RendererConfigurationDirect3D12::pipelineLibraryData to reduce the time it takes to create pipeline states on subsequent runs.
+        \return Blob with the serialized pipeline cache or an empty Blob if this backend does not support a device-wide pipeline cache.
+        For Direct3D 12, the pipeline library must be enabled via RendererConfigurationDirect3D12::pipelineLibraryEnabled.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see RendererConfigurationVulkan::pipelineCacheData
+        \see RendererConfigurationDirect3D12::pipelineLibraryData
+        */
+        virtual Blob GetPipelineCache() = 0;
+
+        /**
+        \brief Exports the memory of the specified buffer or texture as native handle to share it with other APIs without copying.
+        \param[in] resource Specifies the buffer or texture whose memory is to be exported. This must have been created with MiscFlags::External.
+        \param[out] outHandle Specifies the output structure the native handle is written to.
+        \return True if the handle has been exported. Otherwise, the resource was not created with MiscFlags::External or the device does not support exporting memory.
+        \remarks Each call creates a new native handle, which is owned by the caller. The resource must not be released while its memory is used by another API.
+        Synchronize access between the APIs with a Fence that has been exported with ExportFenceHandle.
+        \remarks Vulkan exports the dedicated \c VkDeviceMemory of the resource as ExternalHandleType::OpaqueFD (or ExternalHandleType::OpaqueWin32 on Windows).
+        Direct3D 12 exports the committed resource as ExternalHandleType::D3D12Resource.
+        Importers must use the same image layout as the native resource, e.g. \c cudaExternalMemoryGetMappedMipmappedArray with the texture's format and extent.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see MiscFlags::External
+        \see ExternalHandle
+        */
+        virtual bool ExportMemoryHandle(Resource& resource, ExternalHandle& outHandle) = 0;
+
+        /**
+        \brief Exports the specified fence as native handle, so other APIs can wait for and signal the same values as CommandQueue::Submit(Fence&, std::uint64_t).
+        \param[in] fence Specifies the fence that is to be exported.
+        \param[out] outHandle Specifies the output structure the native handle is written to.
+        \return True if the handle has been exported. Otherwise, the device does not support exporting fences.
+        \remarks Each call creates a new native handle, which is owned by the caller.
+        \remarks Vulkan exports the timeline semaphore of the fence as ExternalHandleType::OpaqueFD (or ExternalHandleType::OpaqueWin32 on Windows).
+        This requires \c VK_KHR_timeline_semaphore and \c VK_KHR_external_semaphore_fd (or \c VK_KHR_external_semaphore_win32 on Windows).
+        Direct3D 12 exports the shared \c ID3D12Fence as ExternalHandleType::D3D12Fence.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see ExternalHandle
+        */
+        virtual bool ExportFenceHandle(Fence& fence, ExternalHandle& outHandle) = 0;
+
+        /**
+        \brief Submits the specified file loads, which read ranges of files into buffers and texture regions.
+        \param[in] loads Specifies the file loads. Each destination range must not be accessed by the CPU or the GPU until the loads have completed.
+        \param[in] fence Optional fence that is signaled once all loads have been written into their destination resources.
+        This is signaled with the next value, like CommandQueue::Submit(Fence&), so the client can wait for the loads with CommandQueue::WaitFence(Fence&, std::uint64_t).
+        \return True if all loads have been submitted. Otherwise, at least one load is invalid or its file could not be opened, and none of the loads have been submitted.
+        \remarks If RenderingFeatures::hasNativeIOQueue is true, the files are read directly into the GPU resources by a native IO command queue without staging them in CPU memory,
+        and this function returns as soon as the loads have been enqueued. Read errors that occur after this function has returned are not reported in that case.
+        \remarks Otherwise, the files are read by the worker threads of LLGL (see SetWorkerThreadCount), in batches of limited size,
+        and each batch is uploaded with WriteBuffer and WriteTexture before this function returns.
+        Loads whose range exceeds the end of their file are skipped in that case and this function returns false.
+        \remarks Example:
+        \code
+        LLGL::FileLoadDescriptor myLoads[2];
+        myLoads[0].filename     = "Assets/Mesh.bin";
+        myLoads[0].size         = myVertexBufferSize;
+        myLoads[0].resource     = myVertexBuffer;
+        myLoads[1].filename     = "Assets/Mesh.bin";
+        myLoads[1].fileOffset   = myVertexBufferSize;
+        myLoads[1].size         = myIndexBufferSize;
+        myLoads[1].resource     = myIndexBuffer;
+        myRenderer->SubmitFileLoads(myLoads, myLoadFence);
+
+        // Poll the fence in each frame until the mesh is available:
+        bool isMeshLoaded = myRenderer->GetCommandQueue()->WaitFence(*myLoadFence, 0);
+        \endcode
+        \see RenderingFeatures::hasNativeIOQueue
+        */
+        virtual bool SubmitFileLoads(const ArrayView<FileLoadDescriptor>& loads, Fence* fence = nullptr) = 0;
+
     protected:
 
         //! Allocates the internal data.
@@ -663,6 +882,12 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Validates the specified arguments to be used for buffer array creation.
         static void AssertCreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray);
 
+        //! Validates the array arguments to be used for batched buffer creation. The descriptors must still be validated individually.
+        static void AssertCreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, Buffer* const * outBuffers);
+
+        //! Validates the array arguments to be used for batched texture creation. The descriptors must still be validated individually.
+        static void AssertCreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, Texture* const * outTextures);
+
         //! Validates the specified shader descriptor.
         static void AssertCreateShader(const ShaderDescriptor& shaderDesc);
 
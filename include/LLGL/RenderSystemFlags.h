@@ -14,6 +14,7 @@
 #include <LLGL/TextureFlags.h>
 #include <LLGL/Constants.h>
 #include <LLGL/RendererConfiguration.h>
+#include <LLGL/VideoAdapter.h>
 
 #include <LLGL/Platform/Platform.h>
 #if defined LLGL_OS_ANDROID
@@ -35,6 +36,7 @@ namespace LLGL
 
 class RenderingProfiler;
 class RenderingDebugger;
+class Resource;
 
 /* ----- Enumerations ----- */
 
@@ -174,6 +176,40 @@ enum class CPUAccess
     ReadWrite,
 };
 
+/**
+\brief Enumeration of native handle types for memory and fences that are shared with other APIs.
+\see ExternalHandle::type
+*/
+enum class ExternalHandleType
+{
+    //! Undefined handle type, i.e. no handle has been exported.
+    Undefined,
+
+    /**
+    \brief POSIX file descriptor of opaque device memory or a semaphore from Vulkan.
+    \remarks The file descriptor must be closed with \c close() unless the importing API takes ownership of it, e.g. \c cudaImportExternalMemory.
+    */
+    OpaqueFD,
+
+    /**
+    \brief Win32 NT handle of opaque device memory or a semaphore from Vulkan.
+    \remarks The handle must be closed with \c CloseHandle() once it has been imported.
+    */
+    OpaqueWin32,
+
+    /**
+    \brief Win32 NT handle of a shared \c ID3D12Resource, e.g. for \c cudaExternalMemoryHandleTypeD3D12Resource.
+    \remarks The handle must be closed with \c CloseHandle() once it has been imported.
+    */
+    D3D12Resource,
+
+    /**
+    \brief Win32 NT handle of a shared \c ID3D12Fence, e.g. for \c cudaExternalSemaphoreHandleTypeD3D12Fence.
+    \remarks The handle must be closed with \c CloseHandle() once it has been imported.
+    */
+    D3D12Fence,
+};
+
 
 /* ----- Flags ----- */
 
@@ -199,7 +235,69 @@ struct RenderSystemFlags
           See https://www.khronos.org/opengl/wiki/Debug_Output
         - Metal: Not supported.
         */
-        DebugDevice = (1 << 0),
+        DebugDevice     = (1 << 0),
+
+        /**
+        \brief Specifies that command buffers write breadcrumb markers for device-lost post-mortems.
+        \remarks If this is specified, the command buffers write a marker into host-visible memory after each draw and compute command and each debug group.
+        When the device is lost, LLGL reports the last started and the last completed command of each command buffer together with its debug group path (see Log::Errorf).
+        The overhead is small enough to leave this enabled in release builds. Here is an overview of what impact this flag has to the respective renderer:
+        - Direct3D 12: Markers are written with \c ID3D12GraphicsCommandList2::WriteBufferImmediate. Not supported for secondary command buffers (bundles).
+        - Vulkan: Markers are written with \c vkCmdWriteBufferMarkerAMD if the Vulkan extension \c "VK_AMD_buffer_marker" is available. Not supported for secondary command buffers.
+        - Other renderers: Not supported.
+        \see CommandBuffer::PushDebugGroup
+        */
+        GPUBreadcrumbs  = (1 << 1),
+
+        /**
+        \brief Specifies that the render system is created without any window system, e.g. for offscreen rendering on servers without a display.
+        \remarks If this is specified, no swap-chain can be created and all rendering must be done into render targets.
+        Here is an overview of what impact this flag has to the respective renderer:
+        - OpenGL: The GL context is created with EGL on the surfaceless platform (\c EGL_PLATFORM_SURFACELESS_MESA) instead of GLX, so no X11 display is required.
+          This is only supported on GNU/Linux if LLGL was built with the \c LLGL_GL_ENABLE_EGL_HEADLESS option.
+          Worker contexts (see RendererConfigurationOpenGL::numWorkerContexts) are not created in this mode.
+        - Vulkan: The Vulkan instance is created without any surface extensions and \c VK_KHR_swapchain is no longer required for the physical device.
+        - Other renderers: No effect, since they don't require a window system to create a device.
+        \see RenderSystem::CreateSwapChain
+        */
+        Headless        = (1 << 2),
+    };
+};
+
+/**
+\brief Subgroup operation flags enumeration.
+\remarks A subgroup is the set of shader invocations that are executed together on a single SIMD unit,
+which is also known as a \e wave in HLSL, a \e warp on NVIDIA hardware, and a \e SIMD-group in Metal.
+The bits of this enumeration match \c VkSubgroupFeatureFlagBits and the features of \c GL_KHR_shader_subgroup.
+\see RenderingLimits::subgroupOperations
+*/
+struct SubgroupOperationFlags
+{
+    enum
+    {
+        //! Specifies that subgroup elections and barriers are supported, e.g. \c subgroupElect in GLSL and \c WaveIsFirstLane in HLSL.
+        Basic           = (1 << 0),
+
+        //! Specifies that subgroup votes are supported, e.g. \c subgroupAll in GLSL and \c WaveActiveAllTrue in HLSL.
+        Vote            = (1 << 1),
+
+        //! Specifies that subgroup reductions and prefix operations are supported, e.g. \c subgroupAdd in GLSL and \c WaveActiveSum in HLSL.
+        Arithmetic      = (1 << 2),
+
+        //! Specifies that subgroup ballots and broadcasts are supported, e.g. \c subgroupBallot in GLSL and \c WaveActiveBallot in HLSL.
+        Ballot          = (1 << 3),
+
+        //! Specifies that reading values from arbitrary invocations is supported, e.g. \c subgroupShuffle in GLSL and \c WaveReadLaneAt in HLSL.
+        Shuffle         = (1 << 4),
+
+        //! Specifies that reading values from relative invocations is supported, e.g. \c subgroupShuffleUp in GLSL and \c simd_shuffle_up in Metal.
+        ShuffleRelative = (1 << 5),
+
+        //! Specifies that reductions over clusters of invocations are supported, e.g. \c subgroupClusteredAdd in GLSL.
+        Clustered       = (1 << 6),
+
+        //! Specifies that operations within quads of invocations are supported, e.g. \c subgroupQuadBroadcast in GLSL and \c QuadReadAcrossX in HLSL.
+        Quad            = (1 << 7),
     };
 };
 
@@ -239,19 +337,31 @@ struct RendererID
 struct RendererInfo
 {
     //! Rendering API name and version (e.g. "OpenGL 4.6").
-    std::string                 rendererName;
+    std::string                         rendererName;
 
     //! Renderer device name (e.g. "GeForce GTX 1070/PCIe/SSE2").
-    std::string                 deviceName;
+    std::string                         deviceName;
 
     //! Vendor name of the renderer device (e.g. "NVIDIA Corporation").
-    std::string                 vendorName;
+    std::string                         vendorName;
 
     //! Shading language version (e.g. "GLSL 4.50").
-    std::string                 shadingLanguageName;
+    std::string                         shadingLanguageName;
 
     //! List of enabled renderer extensions (e.g. "GL_ARB_direct_state_access" or "VK_EXT_conditional_rendering").
-    std::vector<std::string>    extensionNames;
+    std::vector<std::string>            extensionNames;
+
+    /**
+    \brief List of all video adapters the render system can be created with.
+    \remarks The render system is only created with the adapter at index \c adapterIndex.
+    An application can load another instance of the render system with a different RenderSystemDescriptor::adapterIndex to use another adapter.
+    \remarks OpenGL and the Null renderer only report the adapter of the current context.
+    \see RenderSystemDescriptor::adapterIndex
+    */
+    std::vector<VideoAdapterDescriptor> videoAdapters;
+
+    //! Index into \c videoAdapters of the adapter the render system has been created with.
+    std::uint32_t                       adapterIndex    = 0;
 };
 
 /**
@@ -328,6 +438,9 @@ struct RenderSystemDescriptor
     \endcode
     \see rendererConfigSize
     \see RendererConfigurationVulkan
+    \see RendererConfigurationDirect3D11
+    \see RendererConfigurationDirect3D12
+    \see RendererConfigurationMetal
     \see RendererConfigurationOpenGL
     \see RendererConfigurationOpenGLES3
     */
@@ -340,6 +453,27 @@ struct RenderSystemDescriptor
     */
     std::size_t         rendererConfigSize  = 0;
 
+    /**
+    \brief Specifies the index of the video adapter the render system is to be created with. By default Constants::defaultAdapter.
+    \remarks The list of adapters is ordered the same way as RendererInfo::videoAdapters.
+    If this is Constants::defaultAdapter, the render system selects the adapter, which is typically the primary GPU of the system.
+    \remarks If the index is out of range, the render system fails to load.
+    \remarks This is ignored if \c adapterLUID is non-zero.
+    \note Only supported with: Direct3D 11, Direct3D 12, Vulkan, Metal.
+    \see RendererInfo::videoAdapters
+    \see Constants::defaultAdapter
+    */
+    std::uint32_t       adapterIndex        = Constants::defaultAdapter;
+
+    /**
+    \brief Specifies the locally unique identifier (LUID) of the video adapter the render system is to be created with. By default 0.
+    \remarks This can be used to create the render system on the same adapter as another API interoperates with, e.g. via \c IDXGIAdapter::GetDesc.
+    If no adapter with this LUID is found, the render system fails to load.
+    \note Only supported with: Direct3D 11, Direct3D 12, Vulkan, Metal.
+    \see VideoAdapterDescriptor::luid
+    */
+    std::uint64_t       adapterLUID         = 0;
+
     #ifdef LLGL_OS_ANDROID
 
     /**
@@ -534,6 +668,14 @@ struct RenderingFeatures
     */
     bool hasIndirectDrawing             = false;
 
+    /**
+    \brief Specifies whether indirect draw commands with a GPU-side number of draw commands are supported.
+    \note Only supported with: Direct3D 12, Vulkan (requires extension \c VK_KHR_draw_indirect_count).
+    \see CommandBuffer::DrawIndirectCount
+    \see CommandBuffer::DrawIndexedIndirectCount
+    */
+    bool hasIndirectCountDrawing        = false;
+
     /**
     \brief Specifies whether multiple viewports, depth-ranges, and scissors at once are supported.
     \see RenderingLimits::maxViewports
@@ -574,6 +716,114 @@ struct RenderingFeatures
     \see CommandBuffer:BeginRenderCondition
     */
     bool hasRenderCondition             = false;
+
+    /**
+    \brief Specifies whether bindless resource heaps are supported.
+    \remarks This is only supported by the Vulkan backend with extension \c VK_EXT_descriptor_indexing, the Direct3D 12 backend with resource binding tier 3,
+    the OpenGL backend with extension \c GL_ARB_bindless_texture, and the Metal backend with argument buffers tier 2.
+    \see PipelineLayoutDescriptor::bindlessHeap
+    */
+    bool hasBindlessResources           = false;
+
+    /**
+    \brief Specifies whether sparse (also "tiled" or "reserved") buffers and 2D textures are supported.
+    \note Only supported with: Direct3D 12 (requires tiled resources tier 1), Vulkan (requires the features \c sparseResidencyBuffer and \c sparseResidencyImage2D).
+    \see MiscFlags::Sparse
+    \see CommandQueue::UpdateTileMappings
+    */
+    bool hasSparseResources             = false;
+
+    /**
+    \brief Specifies whether resources can be created and released concurrently from multiple threads.
+    \remarks If this is true, the functions RenderSystem::CreateBuffer, RenderSystem::CreateTexture, RenderSystem::CreateSampler, RenderSystem::CreateShader,
+    and their respective RenderSystem::Release functions can be called from any thread at the same time.
+    All other functions of the render system must still be synchronized by the client programmer.
+    \note Only supported with: Vulkan, Direct3D 12.
+    */
+    bool hasThreadSafeResourceCreation  = false;
+
+    /**
+    \brief Specifies whether variable rate shading (VRS) with a per-pipeline shading rate is supported.
+    \note Only supported with: Direct3D 12 (requires VRS tier 1), Vulkan (requires the feature \c pipelineFragmentShadingRate of \c VK_KHR_fragment_shading_rate).
+    \see GraphicsPipelineDescriptor::shadingRate
+    */
+    bool hasVariableRateShading         = false;
+
+    /**
+    \brief Specifies whether shading-rate images for variable rate shading are supported.
+    \note Only supported with: Direct3D 12 (requires VRS tier 2), Vulkan (requires \c VK_KHR_dynamic_rendering and the feature \c attachmentFragmentShadingRate).
+    \see RenderTargetDescriptor::shadingRateImage
+    \see RenderingLimits::shadingRateImageTileSize
+    */
+    bool hasShadingRateImage            = false;
+
+    /**
+    \brief Specifies whether mesh pipelines with task and mesh shaders are supported.
+    \note Only supported with: Direct3D 12 (requires mesh shader tier 1), Vulkan (requires extension \c VK_EXT_mesh_shader), Metal (requires Metal 3).
+    \see GraphicsPipelineDescriptor::meshShader
+    \see CommandBuffer::DrawMeshTasks
+    \see CommandBuffer::DrawMeshTasksIndirect
+    */
+    bool hasMeshShaders                 = false;
+
+    /**
+    \brief Specifies whether textures can be block compressed on the GPU with CommandBuffer::CompressTexture.
+    \note Only supported with: Vulkan (requires the built-in shaders, \c VK_KHR_push_descriptor, \c VK_KHR_maintenance2, and the feature \c shaderStorageImageWriteWithoutFormat).
+    \see CommandBuffer::CompressTexture
+    */
+    bool hasTextureCompression          = false;
+
+    /**
+    \brief Specifies whether compute PSOs can require a subgroup size with ComputePipelineDescriptor::requiredSubgroupSize.
+    \note Only supported with: Vulkan (requires \c VK_EXT_subgroup_size_control or Vulkan 1.3).
+    \see ComputePipelineDescriptor::requiredSubgroupSize
+    \see RenderingLimits::minSubgroupSize
+    */
+    bool hasSubgroupSizeControl         = false;
+
+    /**
+    \brief Specifies whether RenderSystem::SubmitFileLoads reads files directly into GPU resources with a native IO command queue.
+    \remarks If this is false, file loads are still supported but emulated with threaded file reads that are uploaded in batches.
+    \note Only supported with: Metal (requires macOS 13 or iOS 16).
+    \see RenderSystem::SubmitFileLoads
+    */
+    bool hasNativeIOQueue               = false;
+
+    /**
+    \brief Specifies whether multiview rendering is supported, i.e. broadcasting each draw call to multiple array layers of the attachments.
+    \note Only supported with: Vulkan (requires \c VK_KHR_multiview), OpenGL (requires \c GL_OVR_multiview2), Metal (requires vertex amplification).
+    \see RenderPassDescriptor::viewMask
+    \see GraphicsPipelineDescriptor::viewMask
+    \see RenderingLimits::maxMultiviewViewCount
+    */
+    bool hasMultiview                   = false;
+
+    /**
+    \brief Specifies whether hardware ray tracing with acceleration structures and inline ray queries in all shader stages is supported.
+    \remarks Ray queries are written with \c RayQuery in HLSL (shader model 6.5) and \c GL_EXT_ray_query in GLSL.
+    \note Only supported with: Vulkan (requires \c VK_KHR_acceleration_structure and \c VK_KHR_ray_query), Direct3D 12 (requires DXR tier 1.1).
+    \see RenderSystem::CreateAccelerationStructure
+    \see CommandBuffer::BuildAccelerationStructure
+    \see RenderingLimits::maxAccelerationStructureInstances
+    */
+    bool hasRayTracing                  = false;
+
+    /**
+    \brief Specifies whether indirect draw arguments can be compacted on the GPU with a visibility bitmask.
+    \note Only supported with: Vulkan (requires \c VK_KHR_push_descriptor and built-in shaders).
+    \see CommandBuffer::CompactIndirectArguments
+    */
+    bool hasIndirectArgumentCompaction  = false;
+
+    /**
+    \brief Specifies whether buffers can be accessed in shaders by their GPU virtual addresses.
+    \remarks Buffer addresses are accessed with \c GL_EXT_buffer_reference in GLSL and \c vk::RawBufferLoad in HLSL with SPIR-V.
+    \remarks Direct3D 12 provides buffer addresses via Buffer::GetDeviceAddress as well, but HLSL cannot dereference them. Hence this is always false for Direct3D 12.
+    \note Only supported with: Vulkan (requires \c VK_KHR_buffer_device_address), Metal (requires Metal 3), OpenGL (requires \c GL_NV_shader_buffer_load).
+    \see BindFlags::DeviceAddress
+    \see Buffer::GetDeviceAddress
+    */
+    bool hasBufferDeviceAddress         = false;
 };
 
 /**
@@ -753,6 +1003,62 @@ struct RenderingLimits
     \see RenderTargetDescriptor::samples
     */
     std::uint32_t   maxNoAttachmentSamples              = 0;
+
+    /**
+    \brief Specifies the size (in pixels) of the square tile that is covered by each texel of a shading-rate image. Common values are 8 or 16.
+    \remarks This is 0 if RenderingFeatures::hasShadingRateImage is false.
+    \see RenderTargetDescriptor::shadingRateImage
+    */
+    std::uint32_t   shadingRateImageTileSize            = 0;
+
+    /**
+    \brief Specifies the maximum number of views that can be rendered with multiview rendering. Common values are 2, 4, or 6.
+    \remarks This is 0 if RenderingFeatures::hasMultiview is false.
+    \see RenderPassDescriptor::viewMask
+    */
+    std::uint32_t   maxMultiviewViewCount               = 0;
+
+    /**
+    \brief Specifies the minimum number of invocations in a subgroup. Common values are 4, 8, 16, 32, or 64.
+    \remarks This is 0 if subgroup operations are not supported, i.e. if \c subgroupOperations is 0.
+    On most hardware the subgroup size is fixed and \c minSubgroupSize equals \c maxSubgroupSize.
+    If they differ, the actual size of each dispatch is only known in the shader, unless it is required by ComputePipelineDescriptor::requiredSubgroupSize.
+    \see maxSubgroupSize
+    */
+    std::uint32_t   minSubgroupSize                     = 0;
+
+    /**
+    \brief Specifies the maximum number of invocations in a subgroup. Common values are 4, 8, 16, 32, or 64.
+    \remarks This is 0 if subgroup operations are not supported.
+    \see minSubgroupSize
+    */
+    std::uint32_t   maxSubgroupSize                     = 0;
+
+    /**
+    \brief Specifies the subgroup operations that are supported by the shaders of the stages in \c subgroupStages. This can be a bitwise OR combination of SubgroupOperationFlags entries.
+    \remarks Here is an overview of how this is determined by the respective renderer:
+    - Vulkan: From \c VkPhysicalDeviceSubgroupProperties (requires Vulkan 1.1).
+    - Direct3D 12: All operations except SubgroupOperationFlags::ShuffleRelative and SubgroupOperationFlags::Clustered if \c D3D12_FEATURE_DATA_D3D12_OPTIONS1::WaveOps is true,
+      since HLSL wave intrinsics require shader model 6.0.
+    - OpenGL: From \c GL_SUBGROUP_SUPPORTED_FEATURES_KHR (requires \c GL_KHR_shader_subgroup).
+    - Metal: SIMD-group and quad-group functions of the GPU family.
+    - Direct3D 11: Not supported.
+    \see SubgroupOperationFlags
+    */
+    long            subgroupOperations                  = 0;
+
+    /**
+    \brief Specifies the shader stages that support the operations in \c subgroupOperations. This can be a bitwise OR combination of StageFlags entries.
+    \see StageFlags
+    */
+    long            subgroupStages                      = 0;
+
+    /**
+    \brief Specifies the maximum number of instances in a top-level acceleration structure. Common values are 2^24 or 2^32-1.
+    \remarks This is 0 if RenderingFeatures::hasRayTracing is false.
+    \see AccelerationStructureDescriptor::maxInstances
+    */
+    std::uint32_t   maxAccelerationStructureInstances   = 0;
 };
 
 /**
@@ -798,6 +1104,103 @@ struct RenderingCapabilities
     RenderingLimits                 limits;
 };
 
+/**
+\brief Memory statistics of a single GPU memory heap.
+\see MemoryStatistics
+*/
+struct MemoryHeapStatistics
+{
+    //! Specifies whether this heap is local to the GPU, i.e. video memory. Otherwise, it is system memory that is visible to the GPU.
+    bool            deviceLocal     = false;
+
+    /**
+    \brief Number of bytes LLGL has allocated from this heap, including the unused space within memory chunks.
+    \remarks This is only tracked by backends that sub-allocate resources from larger memory chunks, i.e. Vulkan and Direct3D 12. Otherwise, this is 0.
+    \remarks With Direct3D 12, this only includes the pooled heaps of placed resources but not committed resources.
+    */
+    std::uint64_t   allocatedSize   = 0;
+
+    //! Number of bytes within the allocated memory chunks that are bound to resources. This is only tracked with Vulkan and Direct3D 12.
+    std::uint64_t   usedSize        = 0;
+
+    //! Number of memory chunks LLGL has allocated from this heap. This is only tracked with Vulkan and Direct3D 12.
+    std::uint32_t   numChunks       = 0;
+
+    /**
+    \brief Number of bytes the operating system grants this process for this heap before it may experience performance degradation or out-of-memory errors.
+    \remarks This is 0 if the budget is unknown, e.g. if the Vulkan device does not support \c VK_EXT_memory_budget.
+    \remarks This value may change at any time, e.g. when other processes allocate or release GPU memory.
+    */
+    std::uint64_t   budget          = 0;
+
+    /**
+    \brief Number of bytes the operating system reports as currently used by this process for this heap.
+    \remarks This includes allocations that were not made by LLGL, e.g. internal driver allocations. This is 0 if the usage is unknown.
+    */
+    std::uint64_t   usage           = 0;
+};
+
+/**
+\brief Memory statistics of the render system.
+\see RenderSystem::QueryMemoryStatistics
+*/
+struct MemoryStatistics
+{
+    //! List of statistics for each memory heap of the GPU.
+    std::vector<MemoryHeapStatistics>   heaps;
+};
+
+/**
+\brief Native handle of memory or a fence that has been exported to share it with other APIs.
+\remarks The caller takes ownership of the handle, i.e. it must be released once it is no longer needed.
+\see RenderSystem::ExportMemoryHandle
+\see RenderSystem::ExportFenceHandle
+*/
+struct ExternalHandle
+{
+    //! Specifies the type of the native handle. This also determines how the handle must be released.
+    ExternalHandleType  type    = ExternalHandleType::Undefined;
+
+    //! Native handle, i.e. either a POSIX file descriptor or a Win32 \c HANDLE cast to an integer.
+    std::intptr_t       handle  = 0;
+
+    /**
+    \brief Size (in bytes) of the exported memory allocation. This is 0 for fences.
+    \remarks This is the size of the underlying allocation, which can be larger than the buffer size or the texture data.
+    External APIs usually require this size to import the memory, e.g. \c cudaExternalMemoryHandleDesc::size.
+    */
+    std::uint64_t       size    = 0;
+};
+
+/**
+\brief Descriptor structure to load a range of a file into a buffer or a texture region.
+\see RenderSystem::SubmitFileLoads
+*/
+struct FileLoadDescriptor
+{
+    //! Specifies the path of the file that is read. This must not be null.
+    const char*     filename        = nullptr;
+
+    //! Specifies the offset (in bytes) into the file where the data starts. By default 0.
+    std::uint64_t   fileOffset      = 0;
+
+    /**
+    \brief Specifies the number of bytes that are read from the file. This must not be zero.
+    \remarks For textures, this must be the size of the tightly packed texel data of all array layers of the destination region in the format of the texture.
+    Compressed formats must be specified in whole blocks. Only a single MIP-map level can be loaded per descriptor.
+    */
+    std::uint64_t   size            = 0;
+
+    //! Specifies the destination resource. This must be either a Buffer or a Texture.
+    Resource*       resource        = nullptr;
+
+    //! Specifies the offset (in bytes) into the destination buffer. This is ignored for textures. By default 0.
+    std::uint64_t   bufferOffset    = 0;
+
+    //! Specifies the destination region of the texture. This is ignored for buffers.
+    TextureRegion   textureRegion;
+};
+
 
 /* ----- Functions ----- */
 
@@ -87,6 +87,33 @@ class LLGL_EXPORT RenderTarget : public RenderSystemChild
         */
         virtual const RenderPass* GetRenderPass() const = 0;
 
+        /**
+        \brief Sets the active extent of this render target for dynamic resolution scaling.
+        \param[in] extent Specifies the extent of the active region, which starts at the upper-left corner of the attachments.
+        If either of its components is zero, the active extent is reset to the entire render target resolution.
+        Extents that exceed the resolution are clamped.
+        \remarks This allows a render target to be created once at its maximum resolution and to be rendered at a smaller resolution
+        that can change with every frame without reallocating any attachments.
+        The active extent determines the render area of subsequent render passes, i.e. the region that is cleared by the load operations of a render pass or CommandBuffer::Clear,
+        and the region that is resolved into the resolve attachments at the end of a multi-sampled render pass.
+        Viewports and scissors are not modified; the client is responsible for setting them within the active extent (see GetActiveExtent).
+        \remarks The active extent is read when a render pass begins, so it must not be changed between encoding a command buffer that renders into this render target and submitting it.
+        \note Direct3D 11 has no notion of a render area and always clears and resolves the entire attachments,
+        which produces the same image content within the active extent. Metal only constrains the render area of render targets but not of swap-chains.
+        \see GetActiveExtent
+        \see CommandBuffer::BeginRenderPass
+        */
+        virtual void SetActiveExtent(const Extent2D& extent);
+
+        /**
+        \brief Returns the active extent of this render target.
+        \remarks This is the resolution of the render target unless a smaller region has been specified with SetActiveExtent.
+        The return value is suitable as default viewport, e.g. \c Viewport{ renderTarget->GetActiveExtent() }.
+        \see SetActiveExtent
+        \see GetResolution
+        */
+        virtual Extent2D GetActiveExtent() const;
+
     protected:
 
         /**
@@ -102,6 +129,10 @@ class LLGL_EXPORT RenderTarget : public RenderSystemChild
         */
         void ValidateMipResolution(const Texture& texture, std::uint32_t mipLevel);
 
+    private:
+
+        Extent2D activeExtent_;
+
 };
 
 
@@ -106,7 +106,9 @@ struct RenderTargetDescriptor
     \brief Optional render pass object that will be used with the render target. By default null.
     \remarks If this is null, a default render pass is created for the render target.
     The default render pass determines the attachment formats by the render target attachments and keeps the load and store operations at its default values.
+    \remarks Attachments without a texture are created as transient attachments if this render pass neither loads nor stores their content.
     \see RenderSystem::CreateRenderPass
+    \see MiscFlags::Transient
     \see AttachmentFormatDescriptor::loadOp
     \see AttachmentFormatDescriptor::storeOp
     */
@@ -157,6 +159,18 @@ struct RenderTargetDescriptor
     \see TextureDescriptor::samples
     */
     AttachmentDescriptor    depthStencilAttachment;
+
+    /**
+    \brief Specifies an optional shading-rate image for variable rate shading. By default null.
+    \remarks If this is specified, the texture must be a 2D texture with format Format::R8UInt and it must have been created with the binding flag BindFlags::ShadingRateAttachment.
+    Each texel determines the shading rate of a tile of RenderingLimits::shadingRateImageTileSize pixels and it is encoded as <code>((log2(width) << 2) | log2(height))</code>,
+    i.e. 0x0 for a 1x1 shading rate, 0x5 for a 2x2 shading rate, and 0xA for a 4x4 shading rate.
+    The resolution of this texture must cover the resolution of the render target divided by the tile size, rounded up.
+    \remarks The shading-rate image is only applied for pipelines whose ShadingRateDescriptor::imageCombiner is not ShadingRateCombiner::Keep.
+    \note Only supported with: Direct3D 12 (requires VRS tier 2), Vulkan (requires \c VK_KHR_dynamic_rendering and the feature \c attachmentFragmentShadingRate).
+    \see RenderingFeatures::hasShadingRateImage
+    */
+    Texture*                shadingRateImage    = nullptr;
 };
 
 
@@ -38,6 +38,25 @@ enum class OpenGLContextProfile
     ESProfile,
 };
 
+/**
+\brief Override enumeration for options of the vendor tuning profile.
+\remarks Each backend selects a tuning profile by the vendor of the GPU it is created with, i.e. a set of parameters such as buffer sizes and strategies
+that are known to perform well with the drivers of that vendor. Options that are not a size can be overridden with this enumeration.
+\see RendererConfigurationVulkan::splitBarriers
+\see RendererConfigurationOpenGL::mappedBufferUpdates
+*/
+enum class TuningOverride
+{
+    //! Use the value of the vendor tuning profile.
+    Default,
+
+    //! Enable the option regardless of the vendor tuning profile.
+    Enabled,
+
+    //! Disable the option regardless of the vendor tuning profile.
+    Disabled,
+};
+
 
 /* ----- Structures ----- */
 
@@ -85,18 +104,189 @@ struct RendererConfigurationVulkan
     \remarks Vulkan only allows a limited set of device memory objects (e.g. 4096 on a GPU with 8 GB of VRAM).
     This member specifies the minimum size used for hardware memory allocation of such a memory chunk.
     The Vulkan render system automatically manages sub-region allocation and defragmentation.
-    \todo Remove this as soon as Vulkan memory manage has been improved.
+    Buffers and images that are at least as large as this size are allocated in their own dedicated memory chunk.
     */
     std::uint64_t               minDeviceMemoryAllocationSize   = 1024*1024;
 
     /**
     \brief Specifies whether fragmentation of the device memory blocks shall be kept low. By default false.
-    \remarks If this is true, each buffer and image allocation first tries to find a reusable device memory block
-    within a single VkDeviceMemory chunk (which might be potentially slower).
-    Whenever a VkDeviceMemory chunk is full, the memory manager tries to reduce fragmentation anyways.
-    \todo Remove this as soon as Vulkan memory manage has been improved.
+    \remarks If this is true, each buffer and image allocation first tries to find a free device memory block
+    in the oldest VkDeviceMemory chunks, so that newer chunks are more likely to become empty and to be released.
+    Otherwise, the newest chunks are tried first.
+    Allocation within a chunk takes constant time in either case.
     */
     bool                        reduceDeviceMemoryFragmentation = false;
+
+    /**
+    \brief Specifies the size (in bytes) of the persistent staging ring for deferred uploads. By default 0.
+    \remarks If this is non-zero, RenderSystem::WriteBuffer and RenderSystem::WriteTexture no longer block until the upload has been completed by the GPU.
+    Instead, the data is copied into a persistently mapped staging ring and all copy commands are batched into a single transfer command buffer,
+    which is submitted right before the next command buffer or fence is submitted to the command queue.
+    Submit a fence via CommandQueue::Submit(Fence&) to get notified when all previous uploads have been completed.
+    Uploads that are larger than half of this size fall back to the blocking path.
+    \remarks Recommended sizes are in the range of 16 MB to 64 MB.
+    */
+    std::uint64_t               deferredUploadRingSize          = 0;
+
+    /**
+    \brief Optional initial data for the device-wide pipeline cache. By default empty.
+    \remarks All graphics and compute pipeline states are created with a single pipeline cache that is shared across the entire render system.
+    This data is usually the content of a Blob that was previously returned by RenderSystem::GetPipelineCache and stored on disk by the client programmer.
+    \remarks The data is ignored if its header does not match the vendor ID, device ID, and pipeline cache UUID of the selected physical device,
+    e.g. when the data was created on a different GPU or with a different driver version.
+    \see RenderSystem::GetPipelineCache
+    */
+    ArrayView<char>             pipelineCacheData;
+
+    /**
+    \brief Specifies whether MIP-maps are generated with a compute shader instead of a chain of blit commands. By default false.
+    \remarks If this is true, CommandBuffer::GenerateMips reduces up to 6 MIP levels with a single dispatch,
+    which uses the same box filter and sRGB conversion as the compute shaders of the Direct3D 12 backend.
+    This only applies to 2D, 2D-array, and cube textures whose format supports storage images.
+    It requires the \c VK_KHR_push_descriptor extension, and the \c VK_KHR_maintenance2 extension for sRGB formats.
+    All other textures fall back to blit commands.
+    \remarks This member is ignored if LLGL was built without a GLSL-to-SPIR-V compiler (i.e. \c glslangValidator).
+    */
+    bool                        computeMipGeneration            = false;
+
+    /**
+    \brief Specifies the minimal number of descriptor sets and descriptors per type of each descriptor pool that command buffers allocate descriptor sets from. By default 0.
+    \remarks If this is zero, the capacity is taken from the vendor tuning profile.
+    Descriptor pools grow beyond this capacity to fit the descriptor usage of recent recordings.
+    */
+    std::uint32_t               descriptorPoolCapacity          = 0;
+
+    /**
+    \brief Specifies whether buffer barriers are split into \c vkCmdSetEvent and \c vkCmdWaitEvents commands. By default TuningOverride::Default.
+    \remarks Split barriers give the GPU more room to overlap work between the source and destination commands, but each event adds some overhead.
+    They are only used in command buffers that are recorded for a single submission.
+    \see TuningOverride
+    */
+    TuningOverride              splitBarriers                   = TuningOverride::Default;
+};
+
+/**
+\brief Structure for a Direct3D 11 renderer specific configuration.
+\see RenderSystemDescriptor::rendererConfig
+*/
+struct RendererConfigurationDirect3D11
+{
+    /**
+    \brief Optional directory where the bytecode of HLSL shaders is cached across multiple runs. By default null.
+    \remarks If this is specified, shaders created from ShaderSourceType::CodeString or ShaderSourceType::CodeFile are looked up in this directory
+    by a hash of their source code, macro definitions, entry point, profile, compilation flags, and the version of the D3D compiler, before they are compiled with \c D3DCompile.
+    Successfully compiled shaders are stored in this directory. The directory is created if it does not exist.
+    \remarks Include directives are not supported by the D3D backends, so the source code is the only input of the compiler that is not part of the shader descriptor.
+    The cache can be shared between multiple processes and render systems, but it is never pruned. Delete the directory to clear the cache.
+    */
+    const char*                 shaderCachePath         = nullptr;
+
+    /**
+    \brief Specifies the chunk size (in bytes) of the dynamic buffer ring that CommandBuffer::UpdateBuffer writes into. By default 0.
+    \remarks If this is zero, the chunk size is taken from the vendor tuning profile. Updates that are larger than a chunk get a dedicated chunk.
+    */
+    std::uint64_t               stagingChunkSize        = 0;
+};
+
+/**
+\brief Structure for a Direct3D 12 renderer specific configuration.
+\see RenderSystemDescriptor::rendererConfig
+*/
+struct RendererConfigurationDirect3D12
+{
+    /**
+    \brief Specifies whether all graphics and compute pipeline states are created through a device-wide pipeline library. By default false.
+    \remarks A pipeline library stores all PSOs under a name that is derived from a hash of their descriptor,
+    so they can be found again in the serialized library on subsequent runs without having to manage a Blob for each PSO.
+    This requires the \c ID3D12Device1 interface. If it is not available, this member is ignored.
+    \see RenderSystem::GetPipelineCache
+    */
+    bool                        pipelineLibraryEnabled  = false;
+
+    /**
+    \brief Optional initial data for the device-wide pipeline library. By default empty.
+    \remarks This data is usually the content of a Blob that was previously returned by RenderSystem::GetPipelineCache and stored on disk by the client programmer.
+    \remarks The data is ignored if it was created with a different adapter or driver version. This member is ignored if \c pipelineLibraryEnabled is false.
+    \see pipelineLibraryEnabled
+    */
+    ArrayView<char>             pipelineLibraryData;
+
+    /**
+    \brief Optional directory where the bytecode of HLSL shaders is cached across multiple runs. By default null.
+    \see RendererConfigurationDirect3D11::shaderCachePath
+    */
+    const char*                 shaderCachePath         = nullptr;
+
+    /**
+    \brief Specifies the initial size (in bytes) of the staging ring buffers of the command queue and the render system. By default 0.
+    \remarks If this is zero, the size is taken from the vendor tuning profile. The staging ring buffers grow on demand and are trimmed when they are idle.
+    \remarks The staging pools of command buffers are configured with CommandBufferDescriptor::minStagingPoolSize instead.
+    */
+    std::uint64_t               stagingChunkSize        = 0;
+};
+
+/**
+\brief Structure for a Metal renderer specific configuration.
+\see RenderSystemDescriptor::rendererConfig
+*/
+struct RendererConfigurationMetal
+{
+    /**
+    \brief Specifies the size (in bytes) of each \c MTLHeap that buffers and textures are sub-allocated from. By default 0.
+    \remarks If this is non-zero, buffers and textures are allocated from a pool of heaps per storage mode instead of allocating each one from the device,
+    which reduces the driver overhead of creating many small resources. Resources that are larger than half of this size and
+    resources with managed storage mode (i.e. most non-dynamic resources on macOS) are still allocated from the device.
+    \remarks Resources in these heaps are not hazard tracked by Metal. Instead, each command queue synchronizes all of its command encoders with an \c MTLFence,
+    i.e. an encoder does not start before the previous encoder of the same queue has finished its work on these resources.
+    Synchronization between the graphics and the asynchronous command queue must be done with Fence objects.
+    \remarks Textures with private storage mode, such as depth-stencil and multi-sampled render targets, are made aliasable when they are released,
+    so transient render targets can reuse the same heap memory right away without waiting for the command buffers in flight to complete.
+    Such textures must therefore not be released while they are still used by the other command queue.
+    \remarks Recommended sizes are in the range of 16 MB to 64 MB.
+    \note This requires macOS 10.13 or iOS 10.0 and it is ignored on earlier versions.
+    */
+    std::uint64_t               heapBlockSize   = 0;
+};
+
+/**
+\brief Structure for a Null renderer specific configuration.
+\remarks The Null renderer records all commands into a virtual command buffer and executes them on the CPU when the command buffer is submitted.
+Its synthetic cost model emulates the driver overhead of a real backend with a fixed amount of time per command,
+so the CPU overhead of LLGL itself can be measured deterministically on machines without a GPU.
+All costs are specified in nanoseconds and are spent by busy-waiting on the submitting thread once per command buffer execution.
+\see RenderSystemDescriptor::rendererConfig
+*/
+struct RendererConfigurationNull
+{
+    /**
+    \brief Specifies whether each command buffer is validated when it is executed. By default false.
+    \remarks If this is true, invalid command sequences are reported via Log::Errorf, such as draw commands outside of a render pass or without a graphics PSO,
+    indexed draw commands without an index buffer, dispatch commands without a compute PSO, or buffer updates that exceed the buffer size.
+    This is much faster than the RenderingDebugger but only validates the command stream itself.
+    */
+    bool            validateCommands    = false;
+
+    //! Synthetic cost (in nanoseconds) of each draw command. By default 0.
+    std::uint32_t   drawCost            = 0;
+
+    //! Synthetic cost (in nanoseconds) of each dispatch command. By default 0.
+    std::uint32_t   dispatchCost        = 0;
+
+    /**
+    \brief Synthetic cost (in nanoseconds) of each state change. By default 0.
+    \remarks This is applied to each binding of a PSO, resource heap, individual resource, vertex or index buffer, as well as each update of uniforms, viewports, and scissors.
+    Redundant bindings of the same object are free of charge, just like most drivers filter them out.
+    */
+    std::uint32_t   stateChangeCost     = 0;
+
+    //! Synthetic cost (in nanoseconds) of each render pass, including its clear commands. By default 0.
+    std::uint32_t   renderPassCost      = 0;
+
+    //! Synthetic cost (in nanoseconds) of each command buffer submission. By default 0.
+    std::uint32_t   submitCost          = 0;
+
+    //! Synthetic cost (in nanoseconds) for each 1024 bytes that are updated or copied by a command buffer. By default 0.
+    std::uint32_t   transferCostPerKB   = 0;
 };
 
 /**
@@ -128,6 +318,42 @@ struct RendererConfigurationOpenGL
     the repesctive extension and procedure name is printed to standard error output.
     */
     bool                    suppressFailedExtensions    = false;
+
+    /**
+    \brief Specifies whether to create GL contexts without error checking. By default false.
+    \remarks If this is true, GL contexts are created with \c GL_KHR_no_error semantics if the platform supports it,
+    i.e. with \c GLX_CONTEXT_OPENGL_NO_ERROR_ARB, \c WGL_CONTEXT_OPENGL_NO_ERROR_ARB, or \c EGL_CONTEXT_OPENGL_NO_ERROR_KHR.
+    The driver can then skip the validation of every GL call, which reduces the CPU overhead of draw-heavy applications.
+    In such contexts, the behavior of invalid GL calls is undefined and \c glGetError only reports \c GL_OUT_OF_MEMORY.
+    \remarks This is ignored if the render system is created with RenderSystemFlags::DebugDevice or a RenderingDebugger and in debug builds of LLGL.
+    It is also ignored on macOS, since NSOpenGL does not support contexts without error checking.
+    */
+    bool                    noErrorContext              = false;
+
+    /**
+    \brief Specifies the number of worker threads with shared GL contexts for background resource creation. By default 0.
+    \remarks If this is greater than zero, the following functions can also be called from threads that have no current GL context,
+    in which case they are executed on one of the worker threads and the calling thread waits until their GL commands have completed:
+    RenderSystem::CreateTexture, RenderSystem::WriteTexture, RenderSystem::CreateBuffer (except for vertex buffers), and RenderSystem::CreateShader.
+    This allows to stream textures and compile shaders off the render thread.
+    All other functions must still be called on the thread that created the first swap-chain.
+    \remarks On GNU/Linux, \c XInitThreads must be called by the client programmer before LLGL is loaded when this feature is used.
+    */
+    std::uint32_t           numWorkerContexts           = 0;
+
+    /**
+    \brief Specifies whether buffer updates are streamed through persistently mapped memory instead of \c glBufferSubData. By default TuningOverride::Default.
+    \remarks This applies to dynamic vertex, index, and constant buffers and it requires the \c GL_ARB_buffer_storage extension.
+    \see TuningOverride
+    */
+    TuningOverride          mappedBufferUpdates         = TuningOverride::Default;
+
+    /**
+    \brief Specifies the segment size (in bytes) of the persistently mapped ring buffer for buffer updates. By default 0.
+    \remarks If this is zero, the segment size is taken from the vendor tuning profile. Larger updates fall back to \c glBufferSubData.
+    \see mappedBufferUpdates
+    */
+    std::uint64_t           stagingChunkSize            = 0;
 };
 
 /**
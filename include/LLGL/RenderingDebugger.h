@@ -11,6 +11,7 @@
 
 #include <LLGL/Export.h>
 #include <LLGL/Container/Strings.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -33,6 +34,62 @@ enum class WarningType
     ImproperState,      //!< Warning due to improper state (e.g. rendering while viewport is not visible).
     PointlessOperation, //!< Warning due to a operation without any effect (e.g. drawing with 0 vertices).
     VaryingBehavior,    //!< Warning due to a varying behavior between the native APIs (e.g. \c SV_VertexID in HLSL behaves different to \c gl_VertexID in GLSL or \c gl_VertexIndex in SPIRV).
+    PerformanceIssue,   //!< Warning due to inefficient usage (e.g. binding the same PSO twice). Only posted if performance lints are enabled. \see RenderingDebugger::SetPerformanceLintEnabled
+};
+
+/**
+\brief Rendering debugger performance lint enumeration.
+\remarks Each lint is posted as a warning of type WarningType::PerformanceIssue and counted per frame.
+\see RenderingDebugger::PostPerformanceLint
+\see PerformanceLintReport
+*/
+enum class PerformanceLint
+{
+    RedundantPipelineState,     //!< CommandBuffer::SetPipelineState with the PSO that is already bound in the current render pass.
+    RedundantResource,          //!< CommandBuffer::SetResource with the resource that is already bound to the same descriptor.
+    MapBufferInFlight,          //!< RenderSystem::MapBuffer with read access on a buffer that is still referenced by a submitted command buffer, which stalls the CPU.
+    ReadTextureInFrame,         //!< RenderSystem::ReadTexture while a frame is being encoded, which stalls the CPU until the GPU is idle.
+    RedundantClear,             //!< CommandBuffer::Clear or CommandBuffer::ClearAttachments before any draw call in a render pass that already clears its attachments.
+    LargeBufferUpdate,          //!< CommandBuffer::UpdateBuffer with more data than the threshold for cheap updates. \see RenderingDebugger::SetBufferUpdateThreshold
+    PipelineCreationInFrame,    //!< RenderSystem::CreatePipelineState while a frame is being encoded, which can cause a hitch.
+};
+
+/**
+\brief Number of performance lints that occurred during a single frame.
+\remarks A frame starts with the first encoding of a command buffer and ends with SwapChain::Present.
+\see RenderingDebugger::GetPerformanceLintReport
+*/
+struct PerformanceLintReport
+{
+    std::uint32_t redundantPipelineStates   = 0; //!< Number of PerformanceLint::RedundantPipelineState lints.
+    std::uint32_t redundantResources        = 0; //!< Number of PerformanceLint::RedundantResource lints.
+    std::uint32_t mapBuffersInFlight        = 0; //!< Number of PerformanceLint::MapBufferInFlight lints.
+    std::uint32_t readTexturesInFrame       = 0; //!< Number of PerformanceLint::ReadTextureInFrame lints.
+    std::uint32_t redundantClears           = 0; //!< Number of PerformanceLint::RedundantClear lints.
+    std::uint32_t largeBufferUpdates        = 0; //!< Number of PerformanceLint::LargeBufferUpdate lints.
+    std::uint32_t pipelineCreationsInFrame  = 0; //!< Number of PerformanceLint::PipelineCreationInFrame lints.
+};
+
+/**
+\brief Rendering debugger validation level enumeration.
+\remarks This only affects the validation of command buffer encoding and submission. Resource and pipeline creation is always validated.
+\see RenderingDebugger::SetValidationLevel
+*/
+enum class DebugValidationLevel
+{
+    Off,                //!< Command buffers are not validated.
+    Sampled,            //!< Only one out of N encodings of each command buffer is validated and per-draw validation results are cached until the PSO, vertex buffers, or resource bindings change. \see RenderingDebugger::SetSamplingInterval
+    Full,               //!< Every encoding of each command buffer is fully validated. This is the default.
+
+    /**
+    \brief Every encoding of each command buffer is validated, but the per-draw and per-dispatch validation runs on a worker thread.
+    \remarks Only inexpensive state checks, such as whether a PSO is bound, are performed while the command buffer is encoded.
+    The remaining checks are recorded into a compact validation log and validated asynchronously after CommandBuffer::End.
+    Their reports are posted from the worker thread with the source and debug group of the respective command,
+    so RenderingDebugger::OnError and RenderingDebugger::OnWarning must be thread-safe in this mode.
+    Like DebugValidationLevel::Sampled, draw commands with unchanged PSO, vertex buffers, and resource bindings only validate these once per encoding.
+    */
+    Asynchronous,
 };
 
 
@@ -79,6 +136,82 @@ class LLGL_EXPORT RenderingDebugger
         */
         void PostWarning(const WarningType type, const StringView& message);
 
+        /**
+        \brief Sets the new validation level. By default DebugValidationLevel::Full.
+        \remarks The new level takes effect with the next call to CommandBuffer::Begin.
+        This can be used to keep the debug layer enabled in long running tests without the CPU overhead of a full validation for every draw call.
+        */
+        void SetValidationLevel(const DebugValidationLevel level);
+
+        //! Returns the current validation level. By default DebugValidationLevel::Full.
+        DebugValidationLevel GetValidationLevel() const;
+
+        /**
+        \brief Sets the sampling interval for DebugValidationLevel::Sampled. By default 16.
+        \param[in] interval Specifies how many encodings of each command buffer are recorded per validated encoding.
+        Since a command buffer is typically encoded once per frame, this is equivalent to validating one out of \c interval frames.
+        A value of 0 is treated as 1, i.e. every encoding is validated.
+        */
+        void SetSamplingInterval(std::uint32_t interval);
+
+        //! Returns the sampling interval for DebugValidationLevel::Sampled. By default 16.
+        std::uint32_t GetSamplingInterval() const;
+
+        /**
+        \brief Schedules a capture of all command buffers and resources that are used by the next frames.
+        \param[in] filename Specifies the file the capture is written to once it is finished.
+        \param[in] numFrames Specifies the number of frames that are captured. If this is 0, the capture continues until EndCapture is called.
+        \remarks The capture starts with the next call to SwapChain::Present and includes all command buffers that are encoded after that.
+        Objects are written to the capture the first time they are referenced, including a snapshot of the current buffer and texture contents.
+        The capture can be replayed offline with the CaptureReplay utility, e.g. to compare the performance of the captured frames across drivers.
+        \remarks Capture files are only compatible with the same LLGL version and platform, since most descriptors are stored as raw memory.
+        \see CaptureReplay
+        */
+        void BeginCapture(const char* filename, std::uint32_t numFrames = 1);
+
+        /**
+        \brief Finishes the current capture and writes it to file.
+        \remarks The capture finishes with the next command buffer submission or swap-chain presentation.
+        This is only necessary if the capture was started with an unlimited number of frames.
+        */
+        void EndCapture();
+
+        //! Returns true if a capture has been scheduled with BeginCapture and has not been written to file yet.
+        bool IsCapturing() const;
+
+        /**
+        \brief Enables or disables the performance lints. By default disabled.
+        \remarks Performance lints report inefficient usage of the render system, such as redundant state changes or CPU stalls.
+        Like the validation of command buffers, they are only checked for encodings that are validated (see SetValidationLevel).
+        \see PerformanceLint
+        */
+        void SetPerformanceLintEnabled(bool enable);
+
+        //! Returns true if performance lints are enabled. By default false.
+        bool IsPerformanceLintEnabled() const;
+
+        /**
+        \brief Sets the maximum size (in bytes) of CommandBuffer::UpdateBuffer that is considered cheap. By default 4096.
+        \remarks Larger updates are reported with PerformanceLint::LargeBufferUpdate, since the data is usually copied into the command buffer first.
+        */
+        void SetBufferUpdateThreshold(std::uint32_t size);
+
+        //! Returns the maximum size (in bytes) of CommandBuffer::UpdateBuffer that is considered cheap. By default 4096.
+        std::uint32_t GetBufferUpdateThreshold() const;
+
+        /**
+        \brief Counts the specified performance lint for the current frame and posts it as warning of type WarningType::PerformanceIssue.
+        \remarks The call site is taken from the source function name (see SetSource), so the warning message identifies where the lint occurred.
+        This has no effect if performance lints are disabled.
+        */
+        void PostPerformanceLint(const PerformanceLint lint, const StringView& message);
+
+        /**
+        \brief Returns the number of performance lints that occurred during the last finished frame.
+        \see PerformanceLintReport
+        */
+        PerformanceLintReport GetPerformanceLintReport() const;
+
     protected:
 
         /**
@@ -183,6 +316,41 @@ class LLGL_EXPORT RenderingDebugger
         */
         virtual void OnWarning(WarningType type, Message& message);
 
+    private:
+
+        friend class DbgCapture;
+        friend class DbgCommandBuffer;
+        friend class DbgSwapChain;
+        friend class DbgRenderSystem;
+        friend class DbgDrawValidator;
+
+        // Returns true and the parameters of the capture that was scheduled with BeginCapture if it has not been started yet.
+        bool FetchScheduledCapture(UTF8String& outFilename, std::uint32_t& outNumFrames);
+
+        // Returns true if EndCapture has been called since the current capture was started.
+        bool FetchCaptureEndRequest();
+
+        // Notifies the debugger that the current capture has been written to file.
+        void NotifyCaptureFinished();
+
+        // Notifies the debugger that a command buffer has begun encoding, which starts a new frame for the performance lints if none is active.
+        void NotifyFrameEncoding();
+
+        // Notifies the debugger that a frame has been presented. The lint counters of this frame are kept for GetPerformanceLintReport.
+        void NotifyFramePresented();
+
+        // Returns true if a frame is currently being encoded, i.e. after the first command buffer encoding since the last presentation.
+        bool IsFrameEncoding() const;
+
+        // Returns the source function name that was last specified with SetSource. The string has static storage duration.
+        const char* GetSource() const;
+
+        // Posts an error message with the specified context instead of the current source and debug group.
+        void PostErrorInContext(const ErrorType type, const StringView& message, const StringView& source, const StringView& groupName);
+
+        // Posts a warning message with the specified context instead of the current source and debug group.
+        void PostWarningInContext(const WarningType type, const StringView& message, const StringView& source, const StringView& groupName);
+
     private:
 
         struct Pimpl;
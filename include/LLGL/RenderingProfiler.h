@@ -9,9 +9,13 @@
 #define LLGL_RENDERING_PROFILER_H
 
 
+#include <LLGL/Export.h>
 #include <LLGL/SwapChainFlags.h>
 #include <LLGL/PipelineStateFlags.h>
+#include <LLGL/QueryHeapFlags.h>
 #include <cstdint>
+#include <string>
+#include <vector>
 #include <string.h>
 
 
@@ -32,6 +36,70 @@ struct ProfileTimeRecord
     std::uint64_t   elapsedTime = 0;
 };
 
+/**
+\brief Structure with CPU and GPU times for a scope that was enclosed by \c PushDebugGroup and \c PopDebugGroup.
+\remarks All times are specified in nanoseconds. CPU times are relative to LLGL::Timer::Tick and GPU times are relative to the command queue's timestamp domain,
+i.e. CPU and GPU times can only be compared with themselves.
+\see FrameProfile::scopeRecords
+\see CommandBuffer::PushDebugGroup
+\see CommandBuffer::PopDebugGroup
+*/
+struct ProfileScopeRecord
+{
+    //! Name of the debug group that was passed to CommandBuffer::PushDebugGroup.
+    std::string     name;
+
+    //! Index of the parent scope within the same list of scope records. This is \c ~0u for root scopes.
+    std::uint32_t   parent          = ~0u;
+
+    //! Zero-based nesting depth of this scope. This is 0 for root scopes.
+    std::uint32_t   depth           = 0;
+
+    //! CPU time (in nanoseconds) when the scope was pushed during command encoding.
+    std::uint64_t   cpuBeginTime    = 0;
+
+    //! CPU time (in nanoseconds) when the scope was popped during command encoding.
+    std::uint64_t   cpuEndTime      = 0;
+
+    //! GPU timestamp (in nanoseconds) when the scope began executing. This is 0 if the backend does not support timestamp queries.
+    std::uint64_t   gpuBeginTime    = 0;
+
+    //! GPU timestamp (in nanoseconds) when the scope finished executing. This is 0 if the backend does not support timestamp queries.
+    std::uint64_t   gpuEndTime      = 0;
+
+    /**
+    \brief Pipeline statistics of all commands within this scope, including the commands of its nested scopes.
+    \remarks All values are zero unless RenderingProfiler::pipelineStatisticsEnabled is true and the backend supports pipeline statistics queries.
+    \see RenderingProfiler::pipelineStatisticsEnabled
+    */
+    QueryPipelineStatistics pipelineStatistics;
+};
+
+/**
+\brief Structure with CPU times for a host-side span of an LLGL entry point, such as RenderSystem::CreatePipelineState or SwapChain::Present.
+\remarks All times are specified in nanoseconds and are in the same time domain as the CPU times of ProfileScopeRecord.
+Host records are only recorded if LLGL was built with \c LLGL_ENABLE_HOST_TRACE.
+\see FrameProfile::hostRecords
+\see CollectHostRecords
+*/
+struct ProfileHostRecord
+{
+    //! Name of the entry point that was recorded, e.g. "CreateShader". This always points to a static string.
+    const char*     name        = "";
+
+    //! Zero-based index of the thread that entered this span. Indices are assigned in the order threads first enter an instrumented entry point.
+    std::uint32_t   threadID    = 0;
+
+    //! Zero-based nesting depth of this span within its thread, e.g. 1 for a shader compiled from within a PSO creation.
+    std::uint32_t   depth       = 0;
+
+    //! CPU time (in nanoseconds) when the entry point was entered.
+    std::uint64_t   beginTime   = 0;
+
+    //! CPU time (in nanoseconds) when the entry point returned.
+    std::uint64_t   endTime     = 0;
+};
+
 /**
 \brief Profile of a rendered frame.
 \see RenderingProfiler::NextFrame
@@ -49,6 +117,8 @@ struct FrameProfile
     {
         ::memset(values, 0, sizeof(values));
         timeRecords.clear();
+        scopeRecords.clear();
+        hostRecords.clear();
     }
 
     //! Accumulates the specified profile with this profile.
@@ -60,6 +130,19 @@ struct FrameProfile
 
         /* Append time records */
         timeRecords.insert(timeRecords.end(), rhs.timeRecords.begin(), rhs.timeRecords.end());
+
+        /* Append scope records and offset their parent indices */
+        const std::uint32_t parentOffset = static_cast<std::uint32_t>(scopeRecords.size());
+        scopeRecords.reserve(scopeRecords.size() + rhs.scopeRecords.size());
+        for (const ProfileScopeRecord& record : rhs.scopeRecords)
+        {
+            scopeRecords.push_back(record);
+            if (record.parent != ~0u)
+                scopeRecords.back().parent += parentOffset;
+        }
+
+        /* Append host records */
+        hostRecords.insert(hostRecords.end(), rhs.hostRecords.begin(), rhs.hostRecords.end());
     }
 
     union
@@ -271,9 +354,25 @@ struct FrameProfile
 
     /**
     \brief List of all time records for this frame profile.
+    \remarks Timer queries are resolved asynchronously, so the time records of a command buffer are delivered with a later frame profile
+    once the GPU has finished executing that command buffer, but no later than three submissions of the same command buffer afterwards.
     \see RenderingProfiler::timeRecordingEnabled
     */
     std::vector<ProfileTimeRecord> timeRecords;
+
+    /**
+    \brief List of all scope records for this frame profile in the order they were pushed.
+    \remarks GPU times are resolved asynchronously, so the scope records of a command buffer are delivered with a later frame profile
+    once the GPU has finished executing that command buffer.
+    \see RenderingProfiler::scopeProfilingEnabled
+    */
+    std::vector<ProfileScopeRecord> scopeRecords;
+
+    /**
+    \brief List of all host-side spans of LLGL entry points in the order they were completed.
+    \see CollectHostRecords
+    */
+    std::vector<ProfileHostRecord> hostRecords;
 };
 
 /**
@@ -319,10 +418,50 @@ class RenderingProfiler
         \brief Specifis whether the command buffer time recording is enabled or disabled. By default disabled.
         \see FrameProfile::timeRecords
         */
-        bool            timeRecordingEnabled    = false;
+        bool            timeRecordingEnabled        = false;
+
+        /**
+        \brief Specifies whether the scope profiling of debug groups is enabled or disabled. By default disabled.
+        \remarks Other than time recording, this only inserts two timestamp queries for each debug group
+        and does not require the rendering debugger to be enabled.
+        \see FrameProfile::scopeRecords
+        \see CommandBuffer::PushDebugGroup
+        */
+        bool            scopeProfilingEnabled       = false;
+
+        /**
+        \brief Specifies whether the scope profiler also collects pipeline statistics for each debug group. By default disabled.
+        \remarks This only has an effect if \c scopeProfilingEnabled is true and the renderer supports pipeline statistics queries (see RenderingFeatures::hasPipelineStatistics).
+        Since queries of the same type cannot be nested, the commands between two consecutive calls to \c PushDebugGroup or \c PopDebugGroup are measured by a separate query
+        and the results of nested debug groups are accumulated into their parent groups. Like the timestamps, these results are resolved asynchronously.
+        For backends that don't allow queries to cross render pass boundaries (e.g. Vulkan), debug groups must either be pushed and popped within the same render pass
+        or entirely outside of render passes while this is enabled.
+        \see ProfileScopeRecord::pipelineStatistics
+        */
+        bool            pipelineStatisticsEnabled   = false;
 
 };
 
+/**
+\brief Moves all host records that have been recorded since the last call into the specified frame profile.
+\param[in,out] outProfile Specifies the frame profile whose FrameProfile::hostRecords list will be appended.
+\return True if LLGL was built with \c LLGL_ENABLE_HOST_TRACE. Otherwise, no records are available and the return value is false.
+\remarks Host records are collected globally for all threads and render systems.
+To bound memory consumption, spans that are completed while more than 65536 records are pending are discarded.
+\see FrameProfile::hostRecords
+*/
+LLGL_EXPORT bool CollectHostRecords(FrameProfile& outProfile);
+
+/**
+\brief Writes the scope and host records of the specified frame profile into a JSON string in the Chrome trace event format.
+\remarks The output can be loaded with the \c chrome://tracing or Perfetto trace viewers.
+CPU and GPU scopes are written as separate threads of the same process and GPU times are aligned to the CPU time of the first scope.
+Host records are written as one additional thread per recorded LLGL::ProfileHostRecord::threadID on the same timeline as the CPU scopes.
+\see FrameProfile::scopeRecords
+\see FrameProfile::hostRecords
+*/
+LLGL_EXPORT std::string WriteChromeTrace(const FrameProfile& profile);
+
 
 } // /namespace LLGL
 
@@ -47,6 +47,14 @@ enum class ResourceType
     \see RenderSystem::CreateSampler
     */
     Sampler,
+
+    /**
+    \brief Ray tracing acceleration structure resource.
+    \remarks Only top-level acceleration structures can be bound to shaders.
+    \see AccelerationStructure
+    \see RenderSystem::CreateAccelerationStructure
+    */
+    AccelerationStructure,
 };
 
 
@@ -161,6 +169,23 @@ struct BindFlags
         \see CommandBuffer::FillBuffer
         */
         CopyDst                 = (1 << 11),
+
+        /**
+        \brief Specifies a texture can be used as shading-rate image for variable rate shading.
+        \remarks This can only be used for 2D textures with format Format::R8UInt.
+        \see RenderTargetDescriptor::shadingRateImage
+        \see RenderingFeatures::hasShadingRateImage
+        */
+        ShadingRateAttachment   = (1 << 12),
+
+        /**
+        \brief Specifies a buffer can be accessed in shaders by its GPU virtual address.
+        \remarks This can only be used for Buffer resources. The address is queried with Buffer::GetDeviceAddress
+        and can be passed to shaders via uniforms or other buffers, e.g. to fetch vertices and per-object data without binding the buffer for each draw call.
+        \see Buffer::GetDeviceAddress
+        \see RenderingFeatures::hasBufferDeviceAddress
+        */
+        DeviceAddress           = (1 << 13),
     };
 };
 
@@ -259,6 +284,92 @@ struct MiscFlags
         \see https://docs.microsoft.com/en-us/windows/win32/api/d3d11/ne-d3d11-d3d11_buffer_uav_flag
         */
         Counter         = (1 << 5),
+
+        /**
+        \brief Creates the resource as sparse resource, i.e. only virtual address space is reserved but no memory is committed at creation time.
+        \remarks Memory is committed and released per tile with the CommandQueue::UpdateTileMappings functions,
+        so the residency of a large resource can follow what is actually used instead of its total size.
+        Accessing regions that are not resident returns undefined values on the GPU, and writes to them are discarded.
+        \remarks Sparse textures must be of type TextureType::Texture2D or TextureType::Texture2DArray and cannot be multi-sampled.
+        Their initial image data is ignored. MIP-map levels that are smaller than a single tile (the MIP-map tail) are always resident.
+        \remarks Sparse buffers cannot have CPU access flags, and their initial data is ignored.
+        \note Only supported with: Direct3D 12, Vulkan.
+        \see RenderingFeatures::hasSparseResources
+        \see CommandQueue::UpdateTileMappings
+        \see Texture::GetSparseTileExtent
+        */
+        Sparse          = (1 << 6),
+
+        /**
+        \brief Creates the texture as transient attachment, i.e. its content is only valid within a single render pass and is never stored to memory.
+        \remarks This allows tile-based GPUs to keep the attachment entirely in on-chip memory, such as for multi-sampled depth buffers that are only used during rendering.
+        Transient textures can only be used as render target attachments, i.e. they must be created with the binding flag
+        BindFlags::ColorAttachment or BindFlags::DepthStencilAttachment but cannot be sampled, copied, or used as storage resources.
+        Their initial image data is ignored. Render passes must not load nor store the content of transient attachments,
+        i.e. AttachmentFormatDescriptor::loadOp must not be AttachmentLoadOp::Load and AttachmentFormatDescriptor::storeOp must be AttachmentStoreOp::Undefined.
+        \remarks On Metal, transient textures are created with \c MTLStorageModeMemoryless if the device supports it.
+        Render passes with memoryless attachments must therefore not be interrupted by copy or compute commands.
+        On Vulkan, transient textures are created with \c VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT
+        and bound to \c VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT memory if the device provides such a memory type.
+        All other renderers ignore this flag and allocate regular texture memory.
+        \remarks Internal attachments of a render target (i.e. attachments without a texture) are created as transient attachments implicitly,
+        if the render pass of that render target neither loads nor stores their content.
+        \see RenderTargetDescriptor::renderPass
+        */
+        Transient       = (1 << 7),
+
+        /**
+        \brief Hint to the renderer that a buffer with CPU access is to be placed in memory that is directly visible to the host.
+        \remarks If this is specified for a buffer with CPU access flags, RenderSystem::MapBuffer returns a pointer to the memory the GPU accesses,
+        i.e. the buffer has no intermediate staging buffer and neither RenderSystem::MapBuffer nor RenderSystem::UnmapBuffer copy any data or wait for the GPU.
+        The client is therefore responsible to not access a range of the buffer that is still used by a command buffer in flight, e.g. by ring-buffering the content of each frame.
+        \remarks Buffers with CPUAccessFlags::Write are placed in memory for CPU-to-GPU uploads:
+        On Vulkan, they are allocated from device-local and host-visible memory if available, e.g. on UMA devices and with resizable BAR,
+        and from host-visible memory otherwise. On Direct3D 12, they are created in an upload heap and bound directly as vertex, index, or constant buffers.
+        Upload heaps cannot be written by the GPU, so Direct3D 12 ignores this flag for such buffers with the binding flags BindFlags::Storage or BindFlags::StreamOutputBuffer,
+        and they must not be the destination of any copy, update, or fill command on Direct3D 12.
+        \remarks Buffers with CPUAccessFlags::Read only are placed in memory for GPU-to-CPU readbacks:
+        On Vulkan, they are allocated from host-cached memory if available. On Direct3D 12, they are created in a readback heap,
+        which can only be the destination of copy commands, so Direct3D 12 ignores this flag for such buffers with any binding flags other than BindFlags::CopyDst.
+        This allows to read back buffers and textures asynchronously, since the copy commands are executed with all other commands of a command buffer
+        and the client only waits for the fence of that command buffer:
+        \code
+        // Record copy into readback buffer, created with CPUAccessFlags::Read and MiscFlags::HostVisible
+        myCmdBuffer->CopyBufferFromTexture(*myReadbackBuffer, 0, *myTexture, myRegion);
+        myCmdBuffer->End();
+        myCmdQueue->Submit(*myCmdBuffer);
+        myCmdQueue->Submit(*myReadbackFence);
+
+        // Some frames later: poll fence and read data without stalling
+        if (myCmdQueue->WaitFence(*myReadbackFence, 0))
+        {
+            if (const void* data = myRenderer->MapBuffer(*myReadbackBuffer, LLGL::CPUAccess::ReadOnly))
+            {
+                // Read from 'data' ...
+                myRenderer->UnmapBuffer(*myReadbackBuffer);
+            }
+        }
+        \endcode
+        \remarks All other renderers ignore this flag. This flag is also ignored for buffers without CPU access flags and for sparse buffers.
+        \see RenderSystem::MapBuffer
+        \see CommandBuffer::CopyBuffer
+        \see CommandBuffer::CopyBufferFromTexture
+        \see CommandQueue::WaitFence
+        \see BufferDescriptor::cpuAccessFlags
+        */
+        HostVisible     = (1 << 8),
+
+        /**
+        \brief Allocates the resource in its own memory block that can be exported as native handle, to share it with other APIs without copying.
+        \remarks This allows interoperability with other APIs, e.g. to process the content of a texture with CUDA or to pass it to a video encoder.
+        The native handle of such a resource can be retrieved with RenderSystem::ExportMemoryHandle.
+        \remarks This cannot be combined with MiscFlags::Sparse or MiscFlags::Transient.
+        On Direct3D 12, host-visible buffers cannot be shared, i.e. this flag is ignored for buffers that are created in an upload or readback heap.
+        \note Only supported with: Vulkan, Direct3D 12.
+        On Vulkan, the device must support \c VK_KHR_external_memory_fd (or \c VK_KHR_external_memory_win32 on Windows).
+        \see RenderSystem::ExportMemoryHandle
+        */
+        External        = (1 << 9),
     };
 };
 
@@ -173,6 +173,20 @@ struct ResourceHeapDescriptor
     \see BarrierFlags
     */
     long            barrierFlags        = 0;
+
+    /**
+    \brief Specifies the number of versions each descriptor set can have at once. By default 0.
+    \remarks If this is greater than 1, the resource heap can be written with RenderSystem::WriteResourceHeap while command buffers that refer to it are still pending,
+    and it can be written from multiple threads. Modified descriptor sets that are still referenced by a pending command buffer are copied into a free version,
+    the new resource views are written into that version, and only subsequent calls to CommandBuffer::SetResourceHeap will bind it.
+    This avoids having to keep multiple copies of the same resource heap, one for each frame in flight.
+    \remarks If this is 0 or 1, writing a descriptor set that is used by a pending command buffer may stall until the GPU is idle.
+    \remarks A good value is the number of frames in flight plus one.
+    Only the Vulkan backend allocates multiple versions. The Direct3D 12 backend copies descriptors into a shader-visible heap whenever a resource heap is bound,
+    so it only synchronizes concurrent writes for values greater than 1. All other backends ignore this value.
+    \see RenderSystem::WriteResourceHeap
+    */
+    std::uint32_t   numVersions         = 0;
 };
 
 
@@ -36,6 +36,8 @@ enum class ShaderType
     Geometry,       //!< Geometry shader type.
     Fragment,       //!< Fragment shader type (also "Pixel Shader").
     Compute,        //!< Compute shader type.
+    Task,           //!< Task shader type (also "Amplification Shader" or "Object Shader"). Only used in mesh pipelines.
+    Mesh,           //!< Mesh shader type. Only used in mesh pipelines.
 };
 
 /**
@@ -145,6 +147,15 @@ struct ShaderCompileFlags
         \note Only supported with: GLSL.
         */
         SeparateShader          = (1 << 7),
+
+        /**
+        \brief Strips the shader binary from all instructions that don't contribute to the shader program before the native shader module is created.
+        \remarks This removes all debug instructions (such as names and source line information) and all functions that are not reachable from any entry point.
+        Smaller modules reduce the time the driver needs to compile PSOs, but debug names will no longer show up in graphics debuggers.
+        Shader reflection is not affected by this flag, since it's performed on the original shader binary.
+        \note Only supported with: SPIR-V (Vulkan) and only if LLGL was built with \c LLGL_ENABLE_SPIRV_REFLECT.
+        */
+        StripBinary             = (1 << 8),
     };
 };
 
@@ -176,13 +187,25 @@ struct StageFlags
         //! Specifies the compute shader stage.
         ComputeStage        = (1 << 5),
 
+        //! Specifies the task shader stage (also referred to as "Amplification Shader" or "Object Shader").
+        TaskStage           = (1 << 6),
+
+        //! Specifies the mesh shader stage.
+        MeshStage           = (1 << 7),
+
         //! Specifies all tessellation stages, i.e. tessellation-control-, tessellation-evaluation shader stages.
         AllTessStages       = (TessControlStage | TessEvaluationStage),
 
         //! Specifies all graphics pipeline shader stages, i.e. vertex-, tessellation-, geometry-, and fragment shader stages.
         AllGraphicsStages   = (VertexStage | AllTessStages | GeometryStage | FragmentStage),
 
-        //! Specifies all shader stages.
+        //! Specifies all mesh pipeline shader stages, i.e. task- and mesh shader stages.
+        AllMeshStages       = (TaskStage | MeshStage),
+
+        /**
+        \brief Specifies all shader stages of the classic graphics and compute pipelines.
+        \remarks This does not include the mesh pipeline stages, since they require RenderingFeatures::hasMeshShaders. Use \c AllMeshStages in addition to make a binding visible to them.
+        */
         AllStages           = (AllGraphicsStages | ComputeStage),
     };
 };
@@ -214,6 +237,24 @@ struct ShaderMacro
     const char* definition  = nullptr;
 };
 
+/**
+\brief Shader specialization constant with an identifier and a 32-bit value.
+\remarks For Metal, this specifies the value of a function constant, i.e. a global constant declared with <code>[[function_constant(id)]]</code>.
+The value is converted to the type the constant is declared with in the shader:
+- For \c bool types, any non-zero value is interpreted as \c true.
+- For signed and unsigned integral types, the value is interpreted as 32-bit integer and truncated to the size of the constant.
+- For \c float and \c half types, the value is interpreted as the bit pattern of a 32-bit floating-point.
+\see ShaderDescriptor::specializationConstants
+*/
+struct ShaderSpecializationConstant
+{
+    //! Specifies the identifier of the constant. For Metal, this is the index of the function constant.
+    std::uint32_t   id      = 0;
+
+    //! Specifies the bit pattern of the constant value. By default 0.
+    std::uint32_t   value   = 0;
+};
+
 /**
 \brief Vertex (or geometry) shader specific structure.
 \see ShaderDescriptor::vertex
@@ -265,6 +306,8 @@ struct ComputeShaderAttributes
     If not used for shader reflection, all other renderers need to specified the workgroup size within the shader code:
     - For GLSL: <code>layout(local_size_x = X, local_size_y = Y, local_size_z = Z)</code>
     - For HLSL: <code>[numthreads(X, Y, Z)]</code>
+    \remarks With the Metal backend, this is also used for task and mesh shaders (i.e. ShaderType::Task and ShaderType::Mesh),
+    since their number of threads per threadgroup is specified with each draw command.
     */
     Extent3D workGroupSize = { 1, 1, 1 };
 };
@@ -385,6 +428,17 @@ struct ShaderDescriptor
     \note Only supported with: Metal.
     */
     ComputeShaderAttributes     compute;
+
+    /**
+    \brief Optional list of specialization constants. By default empty.
+    \remarks This allows an uber-shader to be specialized into multiple permutations without compiling its source for each permutation.
+    Shaders that are created from the same source share the same shader library,
+    and each specialized function is compiled only once for each unique combination of entry point and constant values.
+    \remarks Constants that are not specified take the default value they are declared with in the shader.
+    \note Only supported with: Metal.
+    \see ShaderSpecializationConstant
+    */
+    std::vector<ShaderSpecializationConstant> specializationConstants;
 };
 
 
@@ -147,6 +147,38 @@ class LLGL_EXPORT SwapChain : public RenderTarget
         */
         virtual bool SetVsyncInterval(std::uint32_t vsyncInterval) = 0;
 
+        /**
+        \brief Sets the maximum number of frames that can be queued for presentation before Present blocks the calling thread.
+        \param[in] maxFrameLatency Specifies the new maximum frame latency. This must be greater than zero.
+        A value of 1 results in the lowest input-to-photon latency, but leaves the least room for CPU and GPU work to overlap.
+        \return True on success. Otherwise, the value is out of range or the swap-chain does not support frame latency control.
+        \remarks Present waits until the number of queued frames has dropped below this value, so the application samples its input for the next frame as late as possible.
+        Without this call, the frame latency is determined by the backend (typically 2 or 3 frames).
+        \remarks Backend specific behavior:
+        - Direct3D 11: Sets the maximum frame latency of the DXGI device, which affects all swap-chains. Range is [1, 16].
+        - Direct3D 12: Waits on the frame latency waitable object of the DXGI swap-chain. Range is [1, 16].
+        - Vulkan: Limits the frames in flight with fences that are waited on when the next swap-chain image is acquired, i.e. on the first use of the back buffer. At most 3 frames can be in flight.
+        Additionally waits for previous presentations via \c VK_KHR_present_wait if \c VK_KHR_present_id and \c VK_KHR_present_wait are supported.
+        - Metal: Limits the number of drawables of the Metal layer, which only distinguishes between 1 (two drawables) and 2 or more (three drawables).
+        - OpenGL: Waits on a fence that is inserted after each presentation. Returns false if sync objects are not supported.
+        \see SetVsyncInterval
+        */
+        virtual bool SetMaxFrameLatency(std::uint32_t maxFrameLatency) = 0;
+
+        /**
+        \brief Returns true if the specified presentation mode is supported by this swap-chain and its surface.
+        \remarks PresentMode::Default and PresentMode::Fifo are always supported.
+        \remarks Backend specific behavior:
+        - Direct3D 11: Supports Immediate, which is a sync interval of zero.
+        - Direct3D 12: Supports Mailbox and Immediate. Immediate requires \c DXGI_FEATURE_PRESENT_ALLOW_TEARING and is only effective in windowed mode.
+        - Vulkan: Supports all modes the surface reports via \c vkGetPhysicalDeviceSurfacePresentModesKHR.
+        - Metal: Supports Immediate on macOS, which disables display synchronization of the Metal layer.
+        - OpenGL: Supports Immediate. FifoRelaxed is only reported as supported after the swap-chain has been created with it
+        and the platform accepted a negative swap interval, e.g. via \c WGL_EXT_swap_control_tear.
+        \see SwapChainDescriptor::presentMode
+        */
+        virtual bool IsPresentModeSupported(PresentMode presentMode) const = 0;
+
     public:
 
         /* ----- Surface & Display ----- */
@@ -17,6 +17,50 @@ namespace LLGL
 {
 
 
+/* ----- Enumerations ----- */
+
+/**
+\brief Swap-chain presentation mode enumeration.
+\remarks Not all presentation modes are supported by all backends and surfaces. Use SwapChain::IsPresentModeSupported to query whether a mode is available.
+\see SwapChainDescriptor::presentMode
+\see SwapChain::IsPresentModeSupported
+*/
+enum class PresentMode
+{
+    /**
+    \brief The presentation mode is determined by the V-sync interval.
+    \remarks An interval of zero selects the first available non-blocking mode (mailbox or immediate), otherwise frames are presented in FIFO mode.
+    \see SwapChain::SetVsyncInterval
+    */
+    Default = 0,
+
+    /**
+    \brief Frames are queued and presented on vertical blank. Present blocks when the queue is full. This is the only mode that is supported on all backends.
+    \remarks This corresponds to \c VK_PRESENT_MODE_FIFO_KHR in Vulkan.
+    */
+    Fifo,
+
+    /**
+    \brief Like Fifo, but a late frame is presented immediately instead of waiting for the next vertical blank, which can result in tearing.
+    \remarks This corresponds to \c VK_PRESENT_MODE_FIFO_RELAXED_KHR in Vulkan and adaptive V-sync (negative swap interval) in OpenGL.
+    */
+    FifoRelaxed,
+
+    /**
+    \brief Frames are presented on vertical blank, but Present never blocks. A pending frame is replaced by a newer one, so there is no tearing.
+    \remarks This corresponds to \c VK_PRESENT_MODE_MAILBOX_KHR in Vulkan and a sync interval of zero for flip-model swap-chains in Direct3D 12.
+    */
+    Mailbox,
+
+    /**
+    \brief Frames are presented immediately without waiting for vertical blank, which can result in tearing. Present never blocks.
+    \remarks This corresponds to \c VK_PRESENT_MODE_IMMEDIATE_KHR in Vulkan, \c DXGI_PRESENT_ALLOW_TEARING in Direct3D 12,
+    and disabling display synchronization of the Metal layer.
+    */
+    Immediate,
+};
+
+
 /* ----- Flags ----- */
 
 /**
@@ -110,6 +154,15 @@ struct SwapChainDescriptor
 
     //! Specifies whether to enable fullscreen mode or windowed mode. By default windowed mode.
     bool            fullscreen      = false;
+
+    /**
+    \brief Specifies the presentation mode. By default PresentMode::Default.
+    \remarks If the specified mode is not supported by the swap-chain, LLGL will silently fall back to PresentMode::Default.
+    For the explicit modes, the V-sync interval only determines the number of vertical blanks to wait in Fifo and FifoRelaxed mode where the backend supports it.
+    \see SwapChain::IsPresentModeSupported
+    \see SwapChain::SetVsyncInterval
+    */
+    PresentMode     presentMode     = PresentMode::Default;
 };
 
 
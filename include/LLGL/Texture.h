@@ -101,6 +101,15 @@ class LLGL_EXPORT Texture : public Resource
         */
         virtual SubresourceFootprint GetSubresourceFootprint(std::uint32_t mipLevel) const = 0;
 
+        /**
+        \brief Returns the extent of a single tile of this texture if it was created as sparse texture.
+        \return Extent of a single tile in texels, or (0, 0, 0) if this texture is not a sparse texture.
+        \remarks Each tile occupies 64 KB of memory on most hardware, so the extent depends on the texture format, e.g. 128x128 texels for Format::RGBA8UNorm.
+        \see MiscFlags::Sparse
+        \see CommandQueue::UpdateTileMappings(Texture&, std::uint32_t, const TextureTileMapping*)
+        */
+        virtual Extent3D GetSparseTileExtent() const = 0;
+
     protected:
 
         Texture(const TextureType type, long bindFlags);
@@ -259,6 +259,29 @@ struct TextureRegion
     Extent3D            extent;
 };
 
+/**
+\brief Tile mapping structure for sparse textures.
+\see CommandQueue::UpdateTileMappings(Texture&, std::uint32_t, const TextureTileMapping*)
+\see MiscFlags::Sparse
+*/
+struct TextureTileMapping
+{
+    /**
+    \brief Specifies the texel region whose residency is to be changed. Only the first MIP-map level of the subresource is used, but all of its array layers.
+    \remarks Regions that are made resident are extended to the next tile boundaries, and regions that are released are shrunk to the next tile boundaries,
+    so tiles that are only partially covered by a released region stay resident.
+    \remarks MIP-map levels in the MIP-map tail are ignored, since they are always resident.
+    \see Texture::GetSparseTileExtent
+    */
+    TextureRegion   region;
+
+    /**
+    \brief Specifies whether memory is to be committed for the region or released. By default true.
+    \remarks The content of tiles that are newly committed is undefined.
+    */
+    bool            resident    = true;
+};
+
 /**
 \brief Texture descriptor structure.
 \remarks Contains all information about type, format, and dimension to create a texture resource.
@@ -0,0 +1,177 @@
+/*
+ * AssetPack.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_ASSET_PACK_H
+#define LLGL_ASSET_PACK_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/ShaderFlags.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/RenderSystemFlags.h>
+#include <LLGL/Container/ArrayView.h>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Writer for asset packs that bundle precompiled shaders and the MIP-map levels of textures in a single file.
+\remarks A shader can be added multiple times with the same name but for different shading languages, e.g. as DXBC, DXIL, SPIR-V, and metallib.
+AssetPack::CreateShader then selects the first variant, in the order they were added, whose shading language is supported by the render system.
+\remarks Each payload is aligned to 256 bytes within the file, so texel data and SPIR-V modules can be read directly from the memory mapping.
+\see AssetPack
+*/
+class LLGL_EXPORT AssetPackWriter : public NonCopyable
+{
+
+    public:
+
+        AssetPackWriter();
+        ~AssetPackWriter();
+
+    public:
+
+        /**
+        \brief Adds a shader to the pack.
+        \param[in] name Specifies the name of the shader within the pack. This must not be null.
+        \param[in] shaderDesc Specifies the shader type, source, entry point, and profile.
+        Only the source types ShaderSourceType::BinaryBuffer and ShaderSourceType::CodeString are supported; code strings are stored with their null terminator.
+        All other members, such as the vertex attributes, are not stored and must be passed to AssetPack::CreateShader.
+        \param[in] language Specifies the shading language of the source, which must be listed in RenderingCapabilities::shadingLanguages to load this variant.
+        \return True if the shader has been added, or false if the source type is not supported or the source is empty.
+        */
+        bool AddShader(const char* name, const ShaderDescriptor& shaderDesc, const ShadingLanguage language);
+
+        /**
+        \brief Adds a texture with all its MIP-map levels to the pack.
+        \param[in] name Specifies the name of the texture within the pack. This must not be null and must be unique among all textures of the pack.
+        \param[in] textureDesc Specifies the type, format, extent, number of array layers, and number of MIP-map levels of the texture.
+        If \c mipLevels is zero, the full MIP-map chain is stored. Multi-sampled texture types are not supported.
+        \param[in] data Specifies the texel data of all MIP-map levels, beginning with level zero.
+        Each level must be tightly packed in the hardware format of the texture, for all array layers, and compressed formats are specified in whole blocks.
+        \param[in] dataSize Specifies the size (in bytes) of the texel data, which must match the size of all MIP-map levels.
+        \return True if the texture has been added, or false if the name is already used, the texture type or format is not supported, or the data size does not match.
+        */
+        bool AddTexture(const char* name, const TextureDescriptor& textureDesc, const void* data, std::size_t dataSize);
+
+        /**
+        \brief Writes all assets that have been added so far into the specified file.
+        \return True if the file has been written successfully.
+        */
+        bool WriteFile(const char* filename) const;
+
+        //! Removes all assets that have been added to this writer.
+        void Clear();
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+/**
+\brief Read-only asset pack that is memory-mapped from a file written by AssetPackWriter.
+\remarks Shaders and textures are created directly from the memory mapping, i.e. their bytecode and texel data are passed to the render system without being copied into intermediate buffers.
+The texel data is stored in the hardware format of each texture, so it is uploaded without any format conversion.
+\remarks Example:
+\code
+LLGL::AssetPack myPack{ "Assets.llpack" };
+LLGL::ShaderDescriptor myVSDesc;
+myVSDesc.vertex.inputAttribs = myVertexFormat.attributes;
+LLGL::Shader* myVS = myPack.CreateShader(*myRenderer, "Scene.VS", myVSDesc);
+LLGL::Texture* myTexture = myPack.CreateTexture(*myRenderer, "Terrain.Albedo");
+\endcode
+\see AssetPackWriter
+*/
+class LLGL_EXPORT AssetPack : public NonCopyable
+{
+
+    public:
+
+        AssetPack();
+
+        //! Opens the specified asset pack. Use IsOpen to check if this succeeded.
+        explicit AssetPack(const char* filename);
+
+        //! Unmaps the file of this asset pack.
+        ~AssetPack();
+
+    public:
+
+        /**
+        \brief Maps the specified asset pack file into memory and validates its index.
+        \remarks Any previously opened file is closed first. Shaders and textures that have been created from it remain valid.
+        \return True if the file has been opened, or false if it cannot be mapped or is not a valid asset pack.
+        */
+        bool Open(const char* filename);
+
+        //! Unmaps the file of this asset pack. All shader descriptors returned by GetShaderDescriptor become invalid.
+        void Close();
+
+        //! Returns true if an asset pack file is currently open.
+        bool IsOpen() const;
+
+        /**
+        \brief Returns the descriptor of the first variant of the specified shader whose shading language is in the specified list.
+        \param[in] name Specifies the name of the shader within the pack.
+        \param[in] languages Specifies the shading languages that are accepted, e.g. RenderingCapabilities::shadingLanguages.
+        \param[in,out] outShaderDesc Specifies the descriptor whose type, source, source size, source type, entry point, and profile are replaced.
+        The source and strings point into the memory mapping, so they are only valid until this asset pack is closed.
+        \return True if a matching variant has been found.
+        */
+        bool GetShaderDescriptor(const char* name, const ArrayView<ShadingLanguage>& languages, ShaderDescriptor& outShaderDesc) const;
+
+        /**
+        \brief Creates the specified shader from the first variant whose shading language is supported by the render system.
+        \param[in] renderSystem Specifies the render system to create the shader with.
+        \param[in] name Specifies the name of the shader within the pack.
+        \param[in] shaderDesc Specifies the descriptor for all members that are not stored in the pack, such as vertex attributes and compilation flags.
+        \return Pointer to the new shader, or null if there is no variant for any supported shading language.
+        Shaders that fail to compile are returned as well, so their report can be inspected.
+        */
+        Shader* CreateShader(RenderSystem& renderSystem, const char* name, const ShaderDescriptor& shaderDesc = {}) const;
+
+        /**
+        \brief Returns the descriptor of the specified texture.
+        \param[in] name Specifies the name of the texture within the pack.
+        \param[out] outTextureDesc Specifies the output descriptor. Only the type, format, extent, number of array layers, and number of MIP-map levels are modified.
+        \return True if the texture has been found.
+        */
+        bool GetTextureDescriptor(const char* name, TextureDescriptor& outTextureDesc) const;
+
+        /**
+        \brief Creates the specified texture and uploads all its MIP-map levels directly from the memory mapping.
+        \param[in] renderSystem Specifies the render system to create the texture with.
+        \param[in] name Specifies the name of the texture within the pack.
+        \param[in] bindFlags Specifies the binding flags of the new texture. By default BindFlags::Sampled.
+        \return Pointer to the new texture, or null if the texture has not been found or its format cannot be uploaded without conversion.
+        */
+        Texture* CreateTexture(RenderSystem& renderSystem, const char* name, long bindFlags = BindFlags::Sampled) const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
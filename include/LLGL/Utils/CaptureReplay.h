@@ -0,0 +1,103 @@
+/*
+ * CaptureReplay.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_CAPTURE_REPLAY_H
+#define LLGL_CAPTURE_REPLAY_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/Types.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Replays the frames of a capture file that has been recorded with RenderingDebugger::BeginCapture.
+\remarks A capture contains all command buffer encodings, submissions, and resource updates of the captured frames
+together with the definitions and initial contents of all objects they refer to.
+This allows to replay the exact same workload without the application, e.g. to compare the performance of two builds or backends.
+\remarks The capture must be replayed with the same version of LLGL on the same platform it has been recorded with,
+since most descriptors are stored as raw memory. The render system does not need to be the same, but shaders are only portable between backends with compatible shading languages.
+\remarks Resources are not restored between replayed frames, i.e. each frame operates on the resource contents the previous frame has left behind.
+\remarks Example:
+\code
+LLGL::CaptureReplay myReplay;
+if (myReplay.LoadFromFile("MyCapture.llgl-capture") && myReplay.Prepare(*myRenderer, *mySwapChain))
+{
+    for (std::uint32_t frame = 0; frame < myReplay.GetNumFrames(); ++frame)
+        myReplay.ReplayFrame(frame);
+}
+\endcode
+\see RenderingDebugger::BeginCapture
+*/
+class LLGL_EXPORT CaptureReplay : public NonCopyable
+{
+
+    public:
+
+        CaptureReplay();
+
+        //! Releases all objects that have been created by Prepare.
+        ~CaptureReplay();
+
+    public:
+
+        /**
+        \brief Loads the specified capture file.
+        \return True on success. Otherwise, the file could not be read or it has been recorded with an incompatible version or platform and an error is written to the log.
+        \remarks This releases all objects that have been created for a previously loaded capture.
+        */
+        bool LoadFromFile(const char* filename);
+
+        //! Returns the number of frames in the loaded capture. Events after the last presentation are counted as an additional frame.
+        std::uint32_t GetNumFrames() const;
+
+        //! Returns the renderer ID (see RendererID) the loaded capture has been recorded with.
+        int GetRendererID() const;
+
+        //! Returns the resolution of the first swap-chain that is referred to in the loaded capture or an empty extent if there is none.
+        Extent2D GetResolution() const;
+
+        /**
+        \brief Creates all objects of the loaded capture with the specified render system.
+        \param[in] renderSystem Specifies the render system that is used to create all objects and to submit the replayed command buffers.
+        \param[in] swapChain Specifies the swap-chain that replaces all swap-chains of the capture. Frames are presented with this swap-chain.
+        \return True on success. Otherwise, an object of the capture could not be created and an error is written to the log.
+        */
+        bool Prepare(RenderSystem& renderSystem, SwapChain& swapChain);
+
+        /**
+        \brief Replays all events of the specified frame, i.e. resource updates, command buffer encodings, submissions, and presentations.
+        \remarks Command buffers whose encoding has not been captured are not submitted.
+        \remarks This must only be called after Prepare has succeeded.
+        */
+        void ReplayFrame(std::uint32_t frame);
+
+        //! Releases all objects that have been created by Prepare.
+        void Release();
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,156 @@
+/*
+ * CommandBufferPool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_COMMAND_BUFFER_POOL_H
+#define LLGL_COMMAND_BUFFER_POOL_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Command buffer pool statistics structure.
+\see CommandBufferPool::GetStatistics
+*/
+struct CommandBufferPoolStatistics
+{
+    //! Number of command buffers that have been created by the pool.
+    std::uint32_t numCommandBuffers          = 0;
+
+    //! Number of command buffers that are ready to be acquired.
+    std::uint32_t numAvailableCommandBuffers = 0;
+
+    //! Number of command buffers that have been submitted and whose submission fence has not been signaled yet.
+    std::uint32_t numPendingCommandBuffers   = 0;
+
+    //! Number of fences that have been created by the pool.
+    std::uint32_t numFences                  = 0;
+};
+
+/**
+\brief Pool of command buffers that are recycled automatically once the GPU has finished their submission.
+\remarks Instead of keeping one command buffer per frame and thread, or creating and releasing command buffers every frame,
+clients acquire a command buffer from the pool, encode it, and submit it through the pool.
+The pool signals a fence after each submission and hands out the command buffer again only after that fence has been signaled,
+so that CommandBuffer::Begin of a recycled command buffer does not have to wait for the GPU.
+\remarks All functions of this class are thread-safe, i.e. worker threads can acquire and encode command buffers concurrently.
+Submissions are serialized by the pool, so the command queue must not be used by other threads at the same time.
+Acquire only creates a new command buffer if no recycled one is available; use Reserve to create them up front on the thread that owns the render system.
+\remarks For OpenGL, the pool must only be used on the thread the GL context is current on, because fences are polled with CommandQueue::WaitFence.
+\remarks Example:
+\code
+LLGL::CommandBufferPool myCmdBufferPool{ *myRenderer };
+myCmdBufferPool.Reserve(std::thread::hardware_concurrency());
+// On each worker thread:
+LLGL::CommandBuffer* myCmdBuffer = myCmdBufferPool.Acquire();
+myCmdBuffer->Begin();
+// ...
+myCmdBuffer->End();
+myCmdBufferPool.Submit(*myCmdBuffer);
+\endcode
+\see RenderSystem::CreateCommandBuffer
+\see CommandQueue::Submit(Fence&)
+*/
+class LLGL_EXPORT CommandBufferPool : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes the command buffer pool.
+        \param[in] renderSystem Specifies the render system that is used to create the command buffers and fences.
+        \param[in] commandBufferDesc Specifies the descriptor for all command buffers of this pool.
+        This must not contain the CommandBufferFlags::Secondary flag, since secondary command buffers are not submitted to a command queue.
+        \param[in] commandQueue Optional command queue the command buffers are submitted to. If this is null, the graphics queue of the render system is used.
+        */
+        CommandBufferPool(
+            RenderSystem&                   renderSystem,
+            const CommandBufferDescriptor&  commandBufferDesc   = {},
+            CommandQueue*                   commandQueue        = nullptr
+        );
+
+        /**
+        \brief Waits for all pending submissions and releases all command buffers and fences of this pool.
+        \remarks Command buffers that have been acquired but were neither submitted nor returned are released as well.
+        */
+        ~CommandBufferPool();
+
+    public:
+
+        /**
+        \brief Creates command buffers until the pool contains at least the specified number of command buffers.
+        \remarks Use this to avoid calls to RenderSystem::CreateCommandBuffer when worker threads acquire command buffers.
+        */
+        void Reserve(std::uint32_t numCommandBuffers);
+
+        /**
+        \brief Returns a command buffer that is not in use by the GPU.
+        \remarks This first recycles all command buffers whose submission has completed without blocking.
+        If no command buffer is available, a new one is created.
+        \remarks The returned command buffer must either be passed to Submit or returned with Discard.
+        */
+        CommandBuffer* Acquire();
+
+        /**
+        \brief Submits the specified command buffer, which has been acquired from this pool, to the command queue.
+        \remarks The command buffer is recycled once the fence that is submitted right after it has been signaled.
+        Command buffers with the CommandBufferFlags::ImmediateSubmit flag have already been submitted by CommandBuffer::End, so only the fence is submitted for them.
+        */
+        void Submit(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Submits all specified command buffers at once and signals a single fence for all of them.
+        \see Submit(CommandBuffer&)
+        \see CommandQueue::Submit(std::uint32_t, CommandBuffer* const *)
+        */
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers);
+
+        /**
+        \brief Returns the specified command buffer to the pool without submitting it.
+        \remarks The command buffer must not have been submitted, since it is handed out again immediately.
+        */
+        void Discard(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Recycles all command buffers whose submission has completed without blocking.
+        \remarks This is called implicitly by Acquire.
+        */
+        void Recycle();
+
+        /**
+        \brief Waits until all pending submissions of this pool have completed and recycles their command buffers.
+        \remarks Unlike CommandQueue::WaitIdle, this only waits for the fences of this pool.
+        */
+        void WaitIdle();
+
+        //! Returns the statistics of this pool.
+        CommandBufferPoolStatistics GetStatistics() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,175 @@
+/*
+ * DrawQueue.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_DRAW_QUEUE_H
+#define LLGL_DRAW_QUEUE_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/Format.h>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Draw packet structure for the DrawQueue.
+\remarks A draw packet describes a single (instanced) draw command together with the states it needs.
+If \c indexBuffer is null, the packet is encoded with CommandBuffer::DrawInstanced, otherwise with CommandBuffer::DrawIndexedInstanced.
+\see DrawQueue::Push
+*/
+struct DrawPacket
+{
+    /**
+    \brief Specifies the key by which the packets are sorted in ascending order. By default 0.
+    \remarks Clients typically encode the PSO in the most significant bits and the resource heap and material in the following bits,
+    so that the number of state changes between sorted packets is minimized.
+    */
+    std::uint64_t   sortKey           = 0;
+
+    //! Pipeline state for this draw. This must not be null.
+    PipelineState*  pipelineState     = nullptr;
+
+    //! Optional resource heap for this draw. By default null.
+    ResourceHeap*   resourceHeap      = nullptr;
+
+    //! Descriptor set of the resource heap. By default 0.
+    std::uint32_t   descriptorSet     = 0;
+
+    //! Optional vertex buffer. This must be null if \c vertexBufferArray is specified. By default null.
+    Buffer*         vertexBuffer      = nullptr;
+
+    //! Optional vertex buffer array, e.g. for a per-vertex and a per-instance buffer. This must be null if \c vertexBuffer is specified. By default null.
+    BufferArray*    vertexBufferArray = nullptr;
+
+    //! Optional index buffer. If this is null, the draw is not indexed. By default null.
+    Buffer*         indexBuffer       = nullptr;
+
+    //! Format of the index buffer. This must be either Format::R16UInt or Format::R32UInt. By default Format::R32UInt.
+    Format          indexFormat       = Format::R32UInt;
+
+    //! Number of vertices, or number of indices if \c indexBuffer is specified. By default 0.
+    std::uint32_t   numVertices       = 0;
+
+    //! First vertex, or first index if \c indexBuffer is specified. By default 0.
+    std::uint32_t   firstVertex       = 0;
+
+    //! Base vertex offset for indexed draws. By default 0.
+    std::int32_t    vertexOffset      = 0;
+
+    //! Number of instances. By default 1.
+    std::uint32_t   numInstances      = 1;
+
+    /**
+    \brief First instance. By default 0.
+    \remarks Packets are merged into a single instanced draw if they only differ in their sort keys and their instance ranges are adjacent,
+    i.e. clients write per-instance data of each packet at \c firstInstance of an instance buffer.
+    */
+    std::uint32_t   firstInstance     = 0;
+};
+
+/**
+\brief Draw queue statistics structure.
+\see DrawQueue::GetStatistics
+*/
+struct DrawQueueStatistics
+{
+    //! Number of packets that have been pushed into the queue.
+    std::uint32_t numPackets             = 0;
+
+    //! Number of draw commands after the packets have been merged by DrawQueue::Sort.
+    std::uint32_t numDraws               = 0;
+
+    //! Number of pipeline state changes when all draws are encoded into a single command buffer.
+    std::uint32_t numPipelineChanges     = 0;
+
+    //! Number of resource heap changes when all draws are encoded into a single command buffer.
+    std::uint32_t numResourceHeapChanges = 0;
+};
+
+/**
+\brief Draw-submission queue that sorts draw packets by their sort keys, merges them into instanced draws, and encodes them into command buffers.
+\remarks Usage per frame: call Clear, Push all packets, call Sort, then either call Encode to record them into one command buffer,
+or call EncodeParallel to record them in chunks into several secondary command buffers that are executed by a primary command buffer.
+The packets are sorted with a stable radix sort over their 64-bit keys, which skips every byte that is equal for all keys.
+\remarks Redundant state changes between consecutive draws are skipped during encoding, i.e. the same PSO, resource heap, vertex and index buffers are only bound once.
+\see CommandBuffer::Execute
+*/
+class LLGL_EXPORT DrawQueue : public NonCopyable
+{
+
+    public:
+
+        DrawQueue();
+        ~DrawQueue();
+
+    public:
+
+        //! Removes all packets from this queue. The allocated memory is kept for the next frame.
+        void Clear();
+
+        //! Reserves memory for the specified number of packets.
+        void Reserve(std::size_t numPackets);
+
+        //! Appends the specified packet to this queue.
+        void Push(const DrawPacket& packet);
+
+        /**
+        \brief Sorts all packets by their sort keys and merges adjacent packets into instanced draws.
+        \remarks This must be called after all packets have been pushed and before the queue is encoded.
+        */
+        void Sort();
+
+        /**
+        \brief Encodes all draws into the specified command buffer.
+        \remarks The command buffer must be inside a render pass.
+        This does not call CommandBuffer::Begin and CommandBuffer::End.
+        */
+        void Encode(CommandBuffer& commandBuffer) const;
+
+        /**
+        \brief Encodes all draws in contiguous chunks into the specified command buffers in parallel.
+        \param[in] numCommandBuffers Specifies the number of command buffers. The draws are distributed evenly across them.
+        \param[in] commandBuffers Pointer to the array of command buffers. These are typically secondary command buffers,
+        i.e. they have been created with the CommandBufferFlags::Secondary flag and the render pass they are executed in.
+        \param[in] beginEncoding Optional function that is invoked after CommandBuffer::Begin for each command buffer,
+        e.g. to set the viewports, since secondary command buffers do not inherit the states of the primary command buffer.
+        \remarks Each command buffer is encoded between CommandBuffer::Begin and CommandBuffer::End on a worker thread.
+        The client must then execute them in order with CommandBuffer::Execute inside the render pass of the primary command buffer.
+        Command buffers whose chunk is empty are still begun and ended.
+        */
+        void EncodeParallel(
+            std::uint32_t                               numCommandBuffers,
+            CommandBuffer* const *                      commandBuffers,
+            const std::function<void(CommandBuffer&)>&  beginEncoding = nullptr
+        ) const;
+
+        //! Returns the statistics of this queue. The number of draws and state changes are only valid after Sort has been called.
+        const DrawQueueStatistics& GetStatistics() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,250 @@
+/*
+ * FrameGraph.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_FRAME_GRAPH_H
+#define LLGL_FRAME_GRAPH_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/BufferFlags.h>
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class FrameGraph;
+
+/**
+\brief Handle of a virtual resource in a FrameGraph.
+\remarks A value of zero denotes an invalid handle.
+\see FrameGraph::CreateTexture
+\see FrameGraph::CreateBuffer
+\see FrameGraph::ImportTexture
+\see FrameGraph::ImportBuffer
+*/
+using FrameGraphResource = std::uint32_t;
+
+/**
+\brief Frame graph pass context structure. This is passed to the callback of each pass during FrameGraph::Execute.
+\see FrameGraphPassDescriptor::execute
+*/
+struct FrameGraphPassContext
+{
+    //! Reference to the frame graph that executes this pass. Use this to resolve the physical resources of the pass.
+    const FrameGraph&   frameGraph;
+
+    /**
+    \brief Render target of this pass, or null if the pass has neither attachments nor an external render target.
+    \remarks If this is non-null, the frame graph has already called CommandBuffer::BeginRenderPass with this render target and will call CommandBuffer::EndRenderPass after the callback returns.
+    */
+    RenderTarget*       renderTarget;
+
+    //! Zero-based index of this pass as returned by FrameGraph::AddPass.
+    std::uint32_t       passIndex;
+};
+
+//! Frame graph pass callback function interface.
+using FrameGraphPassFunction = std::function<void(CommandBuffer& commandBuffer, const FrameGraphPassContext& context)>;
+
+/**
+\brief Frame graph pass descriptor structure.
+\see FrameGraph::AddPass
+*/
+struct FrameGraphPassDescriptor
+{
+    //! Optional name of the pass. This is used as debug group name. By default null.
+    const char*                     debugName               = nullptr;
+
+    //! Specifies the list of resources this pass reads from, for instance to sample a texture resource.
+    std::vector<FrameGraphResource> reads;
+
+    //! Specifies the list of resources this pass writes to other than its attachments, for instance via storage bindings.
+    std::vector<FrameGraphResource> writes;
+
+    /**
+    \brief Specifies the list of texture resources this pass renders into as color attachments.
+    \remarks Each of these textures must have been declared with the binding flag BindFlags::ColorAttachment.
+    \remarks This must not exceed \c LLGL_MAX_NUM_COLOR_ATTACHMENTS entries.
+    */
+    std::vector<FrameGraphResource> colorAttachments;
+
+    /**
+    \brief Optional texture resource this pass renders into as depth-stencil attachment. By default zero.
+    \remarks This texture must have been declared with the binding flag BindFlags::DepthStencilAttachment.
+    */
+    FrameGraphResource              depthStencilAttachment  = 0;
+
+    /**
+    \brief Optional render pass for the render target the frame graph creates for the attachments of this pass. By default null.
+    \remarks Use this if the pipeline states of this pass must be compatible with a specific render pass.
+    \see RenderTargetDescriptor::renderPass
+    */
+    const RenderPass*               renderPass              = nullptr;
+
+    /**
+    \brief Optional external render target, such as a SwapChain, this pass renders into. By default null.
+    \remarks If this is specified, \c colorAttachments and \c depthStencilAttachment must be empty.
+    \remarks Passes with an external render target are never culled.
+    */
+    RenderTarget*                   renderTarget            = nullptr;
+
+    //! Callback function that encodes the commands of this pass. This must not be empty.
+    FrameGraphPassFunction          execute;
+};
+
+/**
+\brief Frame graph statistics structure.
+\see FrameGraph::GetStatistics
+*/
+struct FrameGraphStatistics
+{
+    //! Number of passes that have been added to the graph.
+    std::uint32_t numPasses                 = 0;
+
+    //! Number of passes that have been culled because none of their outputs was consumed.
+    std::uint32_t numCulledPasses           = 0;
+
+    //! Number of transient resources that are used by at least one pass that has not been culled.
+    std::uint32_t numTransientResources     = 0;
+
+    //! Number of physical textures and buffers that have been assigned to these transient resources.
+    std::uint32_t numPhysicalResources      = 0;
+
+    //! Accumulated memory footprint (in bytes) of all used transient resources as if each of them had its own allocation.
+    std::uint64_t transientMemorySize       = 0;
+
+    //! Accumulated memory footprint (in bytes) of all physical resources that have been assigned to the transient resources.
+    std::uint64_t physicalMemorySize        = 0;
+};
+
+/**
+\brief Frame graph to schedule render passes and to alias their transient resources.
+\remarks A frame graph is built each frame by first declaring the transient resources and the passes that read and write them.
+FrameGraph::Compile then culls all passes whose outputs are never consumed, determines the lifetime of each transient resource,
+and assigns physical resources such that transient resources with non-overlapping lifetimes and compatible descriptors share the same texture or buffer.
+Physical resources are kept across frames, so rebuilding the same graph every frame does not allocate any new resources.
+\remarks Passes are executed in the order they are added. Resource transitions between passes are handled by the backends as with any other LLGL command.
+\remarks A pass is kept alive if it renders into an external render target, writes to an imported resource, or writes to a resource that is consumed by another pass that is kept alive.
+\see RenderSystem::CreateTexture
+\see RenderSystem::CreateBuffer
+*/
+class LLGL_EXPORT FrameGraph : public NonCopyable
+{
+
+    public:
+
+        //! Initializes the frame graph with the render system that is used to create the physical resources.
+        FrameGraph(RenderSystem& renderSystem);
+
+        //! Releases all physical resources that have been created by this frame graph.
+        ~FrameGraph();
+
+    public:
+
+        /**
+        \brief Declares a new transient texture for the current frame.
+        \param[in] textureDesc Specifies the texture descriptor. Initial image data is not supported for transient resources.
+        \return Handle of the new virtual resource.
+        */
+        FrameGraphResource CreateTexture(const TextureDescriptor& textureDesc);
+
+        /**
+        \brief Declares a new transient buffer for the current frame.
+        \param[in] bufferDesc Specifies the buffer descriptor. This must not have any CPU access flags.
+        \return Handle of the new virtual resource.
+        \remarks The vertex attributes of the descriptor are ignored, i.e. transient buffers cannot be used as vertex buffers.
+        */
+        FrameGraphResource CreateBuffer(const BufferDescriptor& bufferDesc);
+
+        /**
+        \brief Imports an external texture, whose lifetime is managed by the client, into the current frame.
+        \remarks Passes that write to an imported resource are never culled.
+        */
+        FrameGraphResource ImportTexture(Texture& texture);
+
+        /**
+        \brief Imports an external buffer, whose lifetime is managed by the client, into the current frame.
+        \remarks Passes that write to an imported resource are never culled.
+        */
+        FrameGraphResource ImportBuffer(Buffer& buffer);
+
+        /**
+        \brief Adds a new pass to the current frame.
+        \param[in] passDesc Specifies the pass descriptor.
+        \return Zero-based index of the new pass.
+        */
+        std::uint32_t AddPass(const FrameGraphPassDescriptor& passDesc);
+
+        /**
+        \brief Compiles the current frame, i.e. culls unused passes and assigns physical resources to all transient resources.
+        \remarks This must be called after all resources and passes have been declared and before the graph is executed.
+        Physical resources are allocated from the render system if no compatible resource that is not in use is available.
+        */
+        void Compile();
+
+        /**
+        \brief Encodes all passes that have not been culled into the specified command buffer.
+        \remarks The command buffer must be in recording state, i.e. between CommandBuffer::Begin and CommandBuffer::End, and outside of any render pass.
+        */
+        void Execute(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Clears all declared resources and passes to start building a new frame.
+        \remarks The physical resources are kept for the next call to Compile.
+        */
+        void Reset();
+
+        /**
+        \brief Releases all physical resources that were not used by the most recent call to Compile.
+        \remarks Use this when the graph has changed significantly, e.g. after the resolution has changed.
+        */
+        void ReleaseUnusedResources();
+
+    public:
+
+        /**
+        \brief Returns the physical texture of the specified resource, or null if the resource was not assigned a physical texture.
+        \remarks The physical texture of a transient resource is only valid between the call to Compile and the next call to Reset,
+        and it must only be used by the passes that declared to read or write it.
+        */
+        Texture* GetTexture(FrameGraphResource resource) const;
+
+        /**
+        \brief Returns the physical buffer of the specified resource, or null if the resource was not assigned a physical buffer.
+        \see GetTexture
+        */
+        Buffer* GetBuffer(FrameGraphResource resource) const;
+
+        //! Returns true if the specified pass has been culled by the most recent call to Compile.
+        bool IsPassCulled(std::uint32_t passIndex) const;
+
+        //! Returns the statistics of the most recent call to Compile.
+        const FrameGraphStatistics& GetStatistics() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
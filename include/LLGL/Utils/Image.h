@@ -13,6 +13,7 @@
 #include <LLGL/Types.h>
 #include <LLGL/ImageFlags.h>
 #include <LLGL/SamplerFlags.h>
+#include <LLGL/TextureFlags.h>
 #include <LLGL/Utils/ColorRGBA.h>
 
 
@@ -20,6 +21,20 @@ namespace LLGL
 {
 
 
+/**
+\brief Filter enumeration to generate MIP-map levels on the CPU.
+\see Image::GenerateMipChain
+*/
+enum class MipMapFilter
+{
+    //! Box filter that averages all source pixels covered by each destination pixel. This is the fastest filter.
+    Box,
+
+    //! Kaiser-windowed sinc filter with a radius of 3 destination pixels. This preserves more detail than the box filter at higher cost.
+    Kaiser,
+};
+
+
 /**
 \brief Utility class to manage the storage and attributes of an image.
 
@@ -106,6 +121,32 @@ class LLGL_EXPORT Image
         */
         void Resize(const Extent3D& extent, const ColorRGBAf& fillColor, const Offset3D& offset);
 
+        /**
+        \brief Generates the MIP-map chain of this image on the CPU and returns it in a single buffer.
+        \param[in] type Specifies the texture type the image is meant for. This determines which dimensions are reduced,
+        e.g. the depth of a TextureType::Texture2DArray denotes the array layers and is not reduced (see GetMipExtent).
+        \param[in] filter Specifies the filter to reduce each MIP-map level. By default MipMapFilter::Box.
+        \param[in] numMipLevels Specifies the number of MIP-map levels to generate, including the first level.
+        If this is zero or larger than the maximum number of levels, the entire MIP-map chain is generated. By default 0.
+        \param[in] isSRGB Specifies whether the color components are in non-linear sRGB color space.
+        If true, each level is filtered in linear color space and converted back to sRGB. Alpha components are always filtered linearly. By default false.
+        \param[in] threadCount Specifies the number of threads to use for filtering and conversion (see ConvertImageBuffer for more details). By default 0.
+        \return Byte buffer with all MIP-map levels in the format and data type of this image.
+        All levels are tightly packed one after another, starting with a copy of this image as the first level,
+        so each level can be passed to RenderSystem::WriteTexture with an offset of the sum of the previous level sizes.
+        \throw std::runtime_error If this image has a compressed or depth-stencil format,
+        or if its extent does not match the texture type, i.e. if GetMipExtent returns a different extent for the first MIP-map level.
+        \see GetMipExtent(const TextureType, const Extent3D&, std::uint32_t)
+        \see NumMipLevels(const TextureType, const Extent3D&)
+        */
+        ByteBuffer GenerateMipChain(
+            const TextureType   type,
+            const MipMapFilter  filter          = MipMapFilter::Box,
+            std::uint32_t       numMipLevels    = 0,
+            bool                isSRGB          = false,
+            unsigned            threadCount     = 0
+        ) const;
+
         //! Swaps all attributes with the specified image.
         void Swap(Image& rhs);
 
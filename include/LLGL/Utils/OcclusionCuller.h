@@ -0,0 +1,204 @@
+/*
+ * OcclusionCuller.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_OCCLUSION_CULLER_H
+#define LLGL_OCCLUSION_CULLER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Occlusion culler descriptor structure.
+\see OcclusionCuller::OcclusionCuller
+*/
+struct OcclusionCullerDescriptor
+{
+    //! Specifies the maximum number of objects. Each object is identified by an index in the range [0, \c maxObjects). By default 1024.
+    std::uint32_t   maxObjects          = 1024;
+
+    /**
+    \brief Specifies the type of the occlusion queries. By default QueryType::AnySamplesPassed.
+    \remarks This must be either QueryType::SamplesPassed, QueryType::AnySamplesPassed, or QueryType::AnySamplesPassedConservative.
+    */
+    QueryType       queryType           = QueryType::AnySamplesPassed;
+
+    /**
+    \brief Specifies the number of frames after which the bounding box of an unchanged object is queried again. By default 1.
+    \remarks With an interval of N, only every N-th object is queried per frame and all other objects reuse the result of their previous query.
+    This exploits the temporal coherence of visibility to reduce the number of queries, but an object that becomes visible may appear up to N-1 frames late.
+    Objects whose bounding box changes with OcclusionCuller::SetBoundingBox are always queried in the next frame.
+    */
+    std::uint32_t   queryInterval       = 1;
+
+    /**
+    \brief Specifies the number of frames the application has in flight on the GPU. By default 2.
+    \remarks The bounding boxes are written into one vertex buffer per frame in flight,
+    so the vertices of a frame are not overwritten before the GPU has finished the queries of that frame.
+    */
+    std::uint32_t   numFramesInFlight   = 2;
+
+    /**
+    \brief Specifies the distance (in world units) by which all bounding boxes are expanded. By default 0.
+    \remarks This should be at least the distance of the near clipping plane, so boxes that intersect the near plane are never falsely reported as occluded.
+    */
+    float           boxExpansion        = 0.0f;
+};
+
+/**
+\brief Occlusion culler statistics structure.
+\see OcclusionCuller::GetStatistics
+*/
+struct OcclusionCullerStatistics
+{
+    //! Number of objects with a bounding box.
+    std::uint32_t numObjects            = 0;
+
+    //! Number of queries that have been encoded with the last call to OcclusionCuller::EncodeQueries.
+    std::uint32_t numQueries            = 0;
+
+    //! Number of objects whose previous query result has been reused with the last call to OcclusionCuller::EncodeQueries.
+    std::uint32_t numReusedQueries      = 0;
+
+    //! Number of objects that are always drawn, because their expanded bounding box contains the view position.
+    std::uint32_t numUnconditional      = 0;
+};
+
+/**
+\brief Issues occlusion queries for the bounding boxes of many objects and uses their results as render conditions.
+\remarks All queries are encoded into a single QueryHeap that has been created for render conditions, and each bounding box is drawn with a single draw command
+from a shared vertex buffer, so no result is ever read back by the CPU.
+The objects are then drawn between OcclusionCuller::BeginRenderCondition and OcclusionCuller::EndRenderCondition, which lets the GPU skip occluded objects.
+\remarks The bounding boxes are drawn with a pipeline state that is provided by the client. Only the vertex position is provided as vertex attribute (see GetBoundingBoxVertexFormat);
+the vertex shader transforms it from world space into clip space and the fragment shader can be omitted if the backend supports it.
+Use InitBoundingBoxPipeline to set up the remaining pipeline states of such a pipeline.
+\remarks Example:
+\code
+LLGL::GraphicsPipelineDescriptor myBoxPipelineDesc;
+myBoxPipelineDesc.vertexShader = myBoxVertexShader; // Created with OcclusionCuller::GetBoundingBoxVertexFormat()
+LLGL::OcclusionCuller::InitBoundingBoxPipeline(myBoxPipelineDesc);
+LLGL::OcclusionCuller myCuller{ *myRenderer };
+myCuller.SetBoundingBox(myObjectIndex, myObjectMinCorner, myObjectMaxCorner);
+// Each frame inside the render pass, after the occluders have been drawn:
+myCmdBuffer->SetPipelineState(*myBoxPipeline);
+myCmdBuffer->SetResource(0, *myViewProjectionBuffer);
+myCuller.EncodeQueries(*myCmdBuffer, myCameraPosition);
+myCuller.BeginRenderCondition(*myCmdBuffer, myObjectIndex);
+MyDrawObject(myObjectIndex);
+myCuller.EndRenderCondition(*myCmdBuffer);
+\endcode
+\remarks Writing the query results into a buffer for indirect draw arguments requires a command to resolve queries into a buffer, which is not provided by the CommandBuffer interface.
+\see RenderingFeatures::hasRenderCondition
+\see CommandBuffer::BeginRenderCondition
+*/
+class LLGL_EXPORT OcclusionCuller : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes the occlusion culler with its query heap and vertex buffers.
+        \param[in] renderSystem Specifies the render system that is used to create the query heap and the buffers.
+        \param[in] cullerDesc Specifies the descriptor of the culler.
+        \remarks If the render system does not support render conditions (see RenderingFeatures::hasRenderCondition),
+        the queries are still encoded, but BeginRenderCondition never begins a render condition, i.e. all objects are drawn.
+        */
+        OcclusionCuller(RenderSystem& renderSystem, const OcclusionCullerDescriptor& cullerDesc = {});
+
+        //! Releases the query heap and the vertex buffers.
+        ~OcclusionCuller();
+
+    public:
+
+        /**
+        \brief Sets the axis-aligned bounding box (in world space) of the specified object.
+        \param[in] object Specifies the index of the object. This must be less than OcclusionCullerDescriptor::maxObjects.
+        \param[in] minCorner Specifies the minimum corner of the box, i.e. an array of three floats.
+        \param[in] maxCorner Specifies the maximum corner of the box, i.e. an array of three floats.
+        \remarks The object is queried in the next call to EncodeQueries. Until then, it is drawn without render condition.
+        */
+        void SetBoundingBox(std::uint32_t object, const float minCorner[3], const float maxCorner[3]);
+
+        //! Removes the bounding box of the specified object, which is then neither queried nor culled anymore.
+        void RemoveBoundingBox(std::uint32_t object);
+
+        /**
+        \brief Encodes the occlusion queries of all objects whose results are not reused from previous frames.
+        \param[in] commandBuffer Specifies the command buffer to encode the queries into.
+        This must be inside a render pass with the depth buffer of the occluders and a bounding box pipeline state must be bound.
+        \param[in] viewPosition Optional pointer to the view position (in world space), i.e. an array of three floats.
+        Objects whose expanded bounding box contains this position are not queried and always drawn. By default null.
+        \remarks This overrides the vertex and index buffer bindings of the command buffer and begins a new frame of the culler,
+        so it must be called exactly once per frame and before the render conditions of that frame.
+        */
+        void EncodeQueries(CommandBuffer& commandBuffer, const float* viewPosition = nullptr);
+
+        /**
+        \brief Begins the render condition of the specified object.
+        \param[in] commandBuffer Specifies the command buffer to encode the render condition into.
+        \param[in] object Specifies the index of the object.
+        \param[in] mode Specifies whether the GPU waits for the query result. Only the non-inverted modes are allowed. By default RenderConditionMode::Wait.
+        \remarks Objects without a valid query result are drawn without render condition.
+        Every call must be followed by EndRenderCondition, regardless of whether a render condition has been begun.
+        */
+        void BeginRenderCondition(CommandBuffer& commandBuffer, std::uint32_t object, const RenderConditionMode mode = RenderConditionMode::Wait);
+
+        //! Ends the render condition that has been begun with the previous call to BeginRenderCondition.
+        void EndRenderCondition(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Returns the index of the query within the query heap that holds the latest result of the specified object.
+        \return Index of the query, which is equal to the index of the object, or -1 if the object has no valid query result.
+        \remarks This can be used to retrieve the results with CommandQueue::QueryResult, e.g. for debugging.
+        */
+        std::int32_t GetQuery(std::uint32_t object) const;
+
+        //! Returns the query heap that contains the occlusion queries of all objects.
+        QueryHeap& GetQueryHeap() const;
+
+        //! Returns the statistics of this culler.
+        OcclusionCullerStatistics GetStatistics() const;
+
+    public:
+
+        //! Returns the vertex format of the bounding box vertices, which only has the attribute "position" with format Format::RGB32Float.
+        static VertexFormat GetBoundingBoxVertexFormat();
+
+        /**
+        \brief Initializes the states of the specified graphics pipeline descriptor to draw bounding boxes for occlusion queries.
+        \remarks This enables depth tests without depth writes, disables all color writes and face culling, and sets the primitive topology to PrimitiveTopology::TriangleList.
+        The shaders, pipeline layout, and render pass are left unchanged.
+        */
+        static void InitBoundingBoxPipeline(GraphicsPipelineDescriptor& pipelineDesc);
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
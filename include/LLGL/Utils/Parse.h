@@ -292,6 +292,23 @@ inline ParseContext Parse(const StringView& s)
     return ParseContext{ s };
 }
 
+/**
+\brief Returns the pipeline layout descriptor for the specified source, parsing it only once for each distinct source string.
+\remarks The result is memoized in a process-wide cache that is keyed by the hash of the source string.
+Subsequent calls with the same source string return the cached descriptor without tokenizing, parsing, or allocating memory.
+This function is thread-safe and the returned reference remains valid until the application terminates.
+\see ParseContext::AsPipelineLayoutDesc
+*/
+LLGL_EXPORT const PipelineLayoutDescriptor& ParsePipelineLayoutDescCached(const StringView& s);
+
+/**
+\brief Returns the sampler descriptor for the specified source, parsing it only once for each distinct source string.
+\remarks This function is thread-safe and the returned reference remains valid until the application terminates.
+\see ParsePipelineLayoutDescCached
+\see ParseContext::AsSamplerDesc
+*/
+LLGL_EXPORT const SamplerDescriptor& ParseSamplerDescCached(const StringView& s);
+
 /** @} */
 
 
@@ -0,0 +1,120 @@
+/*
+ * TextureContainer.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_TEXTURE_CONTAINER_H
+#define LLGL_TEXTURE_CONTAINER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/ImageFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Enumeration of supported texture container file formats.
+\see TextureContainer::GetFileFormat
+*/
+enum class TextureContainerFormat
+{
+    Undefined,  //!< No container has been opened.
+    DDS,        //!< DirectDraw Surface (.dds), including the DX10 header extension.
+    KTX2,       //!< Khronos Texture 2.0 (.ktx2) without supercompression.
+};
+
+/**
+\brief Read-only texture container that is memory-mapped from a DDS or KTX2 file.
+\remarks The texel data of all MIP-map levels and array layers is uploaded directly from the memory mapping, i.e. without any intermediate copy or pixel conversion.
+Therefore, only containers whose format maps to a hardware format of LLGL are supported, which are the block compression formats BC1 to BC5 and uncompressed color formats.
+KTX2 files with supercompression, including Basis Universal, are rejected since they would require transcoding.
+\remarks Example:
+\code
+LLGL::TextureContainer myContainer{ "Terrain.Albedo.ktx2" };
+LLGL::Texture* myTexture = myContainer.CreateTexture(*myRenderer);
+\endcode
+\see AssetPack
+*/
+class LLGL_EXPORT TextureContainer : public NonCopyable
+{
+
+    public:
+
+        TextureContainer();
+
+        //! Opens the specified texture container. Use IsOpen to check if this succeeded.
+        explicit TextureContainer(const char* filename);
+
+        //! Unmaps the file of this texture container.
+        ~TextureContainer();
+
+    public:
+
+        /**
+        \brief Maps the specified DDS or KTX2 file into memory and validates its header and MIP-map levels.
+        \remarks The container format is determined by the file identifier, not the file extension. Any previously opened file is closed first.
+        \return True if the file has been opened, or false if it cannot be mapped, is not a valid container, or its format cannot be uploaded without conversion.
+        */
+        bool Open(const char* filename);
+
+        //! Unmaps the file of this texture container. All image descriptors returned by GetImageDesc become invalid.
+        void Close();
+
+        //! Returns true if a texture container file is currently open.
+        bool IsOpen() const;
+
+        //! Returns the file format of the currently open container or TextureContainerFormat::Undefined if no container is open.
+        TextureContainerFormat GetFileFormat() const;
+
+        /**
+        \brief Returns the texture descriptor of the currently open container.
+        \remarks Only the type, format, extent, number of array layers, and number of MIP-map levels are specified by the container.
+        Cube textures have an array layer for each face, i.e. six layers per cube.
+        */
+        const TextureDescriptor& GetTextureDesc() const;
+
+        /**
+        \brief Returns the source image descriptor for the specified MIP-map level and array layer.
+        \param[in] mipLevel Specifies the MIP-map level. This must be less than TextureDescriptor::mipLevels.
+        \param[in] arrayLayer Specifies the array layer or cube face. This must be less than TextureDescriptor::arrayLayers.
+        \param[out] outImageDesc Receives the image descriptor whose data points into the memory mapping.
+        It is only valid until this container is closed.
+        \return True if the subresource exists.
+        */
+        bool GetImageDesc(std::uint32_t mipLevel, std::uint32_t arrayLayer, SrcImageDescriptor& outImageDesc) const;
+
+        /**
+        \brief Creates a texture and uploads all MIP-map levels and array layers directly from the memory mapping.
+        \param[in] renderSystem Specifies the render system to create the texture with.
+        \param[in] bindFlags Specifies the binding flags of the new texture. By default BindFlags::Sampled.
+        \return Pointer to the new texture, or null if no container is open or the render system does not support the texture format.
+        \remarks If all array layers of a MIP-map level are stored contiguously, as with KTX2 files, each level is uploaded with a single write.
+        DDS files store the MIP-map chain of each array layer one after another, so their layers are uploaded individually.
+        */
+        Texture* CreateTexture(RenderSystem& renderSystem, long bindFlags = BindFlags::Sampled) const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
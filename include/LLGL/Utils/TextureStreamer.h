@@ -0,0 +1,243 @@
+/*
+ * TextureStreamer.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_TEXTURE_STREAMER_H
+#define LLGL_TEXTURE_STREAMER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Handle of a streamed texture in a TextureStreamer.
+\remarks A value of zero denotes an invalid handle.
+\see TextureStreamer::CreateTexture
+*/
+using StreamedTexture = std::uint32_t;
+
+/**
+\brief Texture streaming load callback function interface.
+\param[in] mipLevel Specifies the MIP-map level that is to be loaded. Level zero denotes the most detailed level of the full texture.
+\param[out] data Specifies the destination the texel data is to be written to. This may point into mapped GPU memory, so it should only be written to.
+\param[in] dataSize Specifies the size (in bytes) of the destination.
+The texel data must be tightly packed in the format of the texture, for all array layers of the MIP-map level, and compressed formats are specified in whole blocks.
+\return True if the data has been written. If the data is not available yet, e.g. because it is still being read from disk, return false and the level is requested again with the next update.
+\see TextureStreamer::CreateTexture
+*/
+using TextureStreamingLoadFunction = std::function<bool(std::uint32_t mipLevel, void* data, std::size_t dataSize)>;
+
+/**
+\brief Texture streaming residency callback function interface.
+\param[in] texture Specifies the streamed texture whose resident MIP-map levels have changed.
+\param[in] resourceView Specifies the new resource view that must be used to bind the texture, e.g. with RenderSystem::WriteResourceHeap.
+\see TextureStreamerDescriptor::residencyChanged
+*/
+using TextureStreamingResidencyFunction = std::function<void(StreamedTexture texture, const ResourceViewDescriptor& resourceView)>;
+
+/**
+\brief Texture streamer descriptor structure.
+\see TextureStreamer::TextureStreamer
+*/
+struct TextureStreamerDescriptor
+{
+    /**
+    \brief Specifies the maximum size (in bytes) of video memory that all streamed textures may occupy together. By default 256 MB.
+    \remarks The coarse MIP-map levels of the tail (see \c mipTailSize) are always resident, even if they alone exceed this budget.
+    */
+    std::uint64_t                       memoryBudget        = 256ull * 1024ull * 1024ull;
+
+    /**
+    \brief Specifies whether the memory budget is reduced to the headroom that the driver reports for video memory. By default true.
+    \remarks If enabled, the effective budget is limited by \c budget minus \c usage of all device-local heaps, as reported by RenderSystem::QueryMemoryStatistics,
+    so textures are evicted when other resources or applications take away video memory.
+    \see MemoryHeapStatistics::budget
+    */
+    bool                                adaptToSystemBudget = true;
+
+    /**
+    \brief Specifies the size (in bytes) of each staging buffer, which limits the amount of texel data that is uploaded with a single update. By default 16 MB.
+    \remarks MIP-map levels that are larger than this are never streamed in.
+    */
+    std::uint64_t                       uploadBudget        = 16ull * 1024ull * 1024ull;
+
+    /**
+    \brief Specifies the number of updates whose uploads can be in flight at the same time. By default 2.
+    \remarks Each of them has its own staging buffer, command buffer, and fence.
+    If all of them are still in use by the GPU, TextureStreamer::Update returns without changing any residency instead of waiting.
+    */
+    std::uint32_t                       numUploadsInFlight  = 2;
+
+    /**
+    \brief Specifies the largest width and height (in texels) of the MIP-map levels that are always resident. By default 64.
+    \remarks These levels are loaded when a texture is created and are never evicted, so shaders can always sample a coarse version of each texture.
+    */
+    std::uint32_t                       mipTailSize         = 64;
+
+    /**
+    \brief Specifies whether sparse textures are used if the render system supports them. By default true.
+    \remarks Sparse textures keep their resource and only commit and release the memory of their MIP-map levels.
+    Streamed textures that cannot be sparse are re-created with the resident MIP-map levels instead, whenever their residency changes.
+    \see RenderingFeatures::hasSparseResources
+    \see MiscFlags::Sparse
+    */
+    bool                                useSparse           = true;
+
+    /**
+    \brief Optional callback that is invoked whenever the resource view of a streamed texture has changed.
+    \remarks This is invoked by TextureStreamer::Update before the memory of evicted levels is released, so all bindings can be updated before the next command buffer is encoded.
+    */
+    TextureStreamingResidencyFunction   residencyChanged;
+};
+
+/**
+\brief Texture streamer statistics structure.
+\see TextureStreamer::GetStatistics
+*/
+struct TextureStreamerStatistics
+{
+    //! Number of streamed textures.
+    std::uint32_t numTextures         = 0;
+
+    //! Number of streamed textures that are sparse textures.
+    std::uint32_t numSparseTextures   = 0;
+
+    //! Number of streamed textures whose resident MIP-map levels are still coarser than the budget allows.
+    std::uint32_t numPendingTextures  = 0;
+
+    //! Size (in bytes) of all resident MIP-map levels.
+    std::uint64_t residentSize        = 0;
+
+    //! Effective memory budget (in bytes) of the last update.
+    std::uint64_t effectiveBudget     = 0;
+
+    //! Size (in bytes) of texel data that has been uploaded with the last update.
+    std::uint64_t uploadedSize        = 0;
+
+    //! Size (in bytes) of MIP-map levels that have been evicted with the last update.
+    std::uint64_t evictedSize         = 0;
+};
+
+/**
+\brief Manages the residency of MIP-map levels of textures within a video memory budget.
+\remarks Each streamed texture is created with only the coarse MIP-map levels of its tail resident (see TextureStreamerDescriptor::mipTailSize).
+With every call to Update, the streamer distributes the memory budget among all textures by their priority, evicts levels that no longer fit into the budget,
+and streams in finer levels through host-visible staging buffers and CommandBuffer::CopyTextureFromBuffer without waiting for the GPU.
+\remarks Shaders only see resident levels: the resource view of a sparse texture is restricted to the resident levels with TextureViewDescriptor::subresource,
+and non-sparse textures are re-created with only the resident levels.
+Always bind streamed textures with the resource view returned by GetResourceView or passed to TextureStreamerDescriptor::residencyChanged.
+\remarks Only the texture types TextureType::Texture2D and TextureType::Texture2DArray with color formats are supported.
+Compressed formats are uploaded with RenderSystem::WriteTexture, since CommandBuffer::CopyTextureFromBuffer does not support them.
+\remarks All functions of this class are thread-safe, but Update submits to the command queue of the render system, so it must not be used by other threads at the same time.
+\remarks Example:
+\code
+LLGL::TextureStreamerDescriptor myStreamerDesc;
+myStreamerDesc.residencyChanged = [&](LLGL::StreamedTexture texture, const LLGL::ResourceViewDescriptor& view)
+{
+    myRenderer->WriteResourceHeap(*myResourceHeap, myDescriptorIndices[texture], { view });
+};
+LLGL::TextureStreamer myStreamer{ *myRenderer, myStreamerDesc };
+LLGL::StreamedTexture myTexture = myStreamer.CreateTexture(myTextureDesc, MyLoadMipLevelFromDisk);
+// Each frame before encoding any commands:
+myStreamer.SetPriority(myTexture, MyPriorityFromScreenCoverage());
+myStreamer.Update();
+\endcode
+\see RenderSystem::QueryMemoryStatistics
+\see CommandQueue::UpdateTileMappings
+*/
+class LLGL_EXPORT TextureStreamer : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes the texture streamer.
+        \param[in] renderSystem Specifies the render system that is used to create the textures and the staging resources.
+        \param[in] streamerDesc Specifies the descriptor of the streamer.
+        */
+        TextureStreamer(RenderSystem& renderSystem, const TextureStreamerDescriptor& streamerDesc = {});
+
+        //! Waits for all pending uploads and releases all streamed textures and staging resources.
+        ~TextureStreamer();
+
+    public:
+
+        /**
+        \brief Creates a streamed texture whose MIP-map tail is loaded immediately.
+        \param[in] textureDesc Specifies the descriptor of the full texture. The binding flags BindFlags::Sampled, BindFlags::CopySrc, and BindFlags::CopyDst are added implicitly.
+        If \c mipLevels is zero, the full MIP-map chain is used.
+        \param[in] loadFunc Specifies the callback that loads the texel data of MIP-map levels. This is invoked within CreateTexture and Update and must not call this streamer.
+        \return Handle of the new streamed texture, or zero if the texture type or format is not supported or the MIP-map tail could not be loaded.
+        */
+        StreamedTexture CreateTexture(const TextureDescriptor& textureDesc, const TextureStreamingLoadFunction& loadFunc);
+
+        /**
+        \brief Releases the specified streamed texture once the GPU no longer uses it.
+        \remarks After this call, the texture must no longer be bound for new command buffers.
+        */
+        void ReleaseTexture(StreamedTexture texture);
+
+        /**
+        \brief Sets the priority of the specified texture. By default 1.
+        \param[in] priority Specifies the priority to distribute the memory budget. Textures with a higher priority are streamed in first and evicted last.
+        A priority of zero or less keeps only the MIP-map tail resident.
+        \param[in] mostDetailedMipLevel Specifies the most detailed MIP-map level that is requested, e.g. by the screen coverage of the texture. By default 0.
+        */
+        void SetPriority(StreamedTexture texture, float priority, std::uint32_t mostDetailedMipLevel = 0);
+
+        /**
+        \brief Updates the residency of all streamed textures.
+        \remarks This should be called once per frame before any command buffer that uses streamed textures is encoded.
+        The uploads are submitted to the command queue without waiting for them, and the resource views only include new levels for command buffers that are submitted afterwards.
+        \remarks This returns without any changes if all staging buffers are still in use by the GPU.
+        */
+        void Update();
+
+        /**
+        \brief Waits until all uploads of this streamer have completed.
+        \remarks Unlike CommandQueue::WaitIdle, this only waits for the fences of this streamer.
+        */
+        void WaitIdle();
+
+        //! Returns the resource view to bind the resident MIP-map levels of the specified texture.
+        ResourceViewDescriptor GetResourceView(StreamedTexture texture) const;
+
+        //! Returns the hardware texture of the specified streamed texture. This changes whenever a non-sparse texture is re-created.
+        Texture* GetTexture(StreamedTexture texture) const;
+
+        //! Returns the most detailed MIP-map level of the specified texture that is resident, with respect to the full texture.
+        std::uint32_t GetResidentMipLevel(StreamedTexture texture) const;
+
+        //! Returns the statistics of this streamer.
+        TextureStreamerStatistics GetStatistics() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -14,6 +14,7 @@
 #include <LLGL/VertexAttribute.h>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 #include <algorithm>
 
 
@@ -130,6 +131,93 @@ struct VertexFormat
 };
 
 
+/* ----- Vertex quantization ----- */
+
+/**
+\brief Scale and bias to reconstruct quantized vertex positions.
+\remarks The original position is reconstructed in the vertex shader as <code>position.xyz * scale + bias</code>.
+\see QuantizePositionsSNorm16
+*/
+struct VertexQuantizationBounds
+{
+    //! Half extent of the bounding box of all positions. This is at least a small epsilon for each dimension.
+    float scale[3]  = { 1.0f, 1.0f, 1.0f };
+
+    //! Center of the bounding box of all positions.
+    float bias[3]   = { 0.0f, 0.0f, 0.0f };
+};
+
+/**
+\brief Quantizes 3D vertex positions into 16-bit signed normalized integers relative to their bounding box.
+\param[out] dst Pointer to the first destination vertex. Each position is written as four \c std::int16_t components, the fourth component being 1.0.
+\param[in] dstStride Specifies the stride (in bytes) between two destination vertices. This must be at least 8.
+\param[in] src Pointer to the first source position. Each position must consist of three \c float components.
+\param[in] srcStride Specifies the stride (in bytes) between two source positions. This must be at least 12.
+\param[in] numVertices Specifies the number of vertices to convert.
+\param[out] outBounds Receives the scale and bias to reconstruct the original positions.
+\return Vertex attribute format of the quantized positions, which is Format::RGBA16SNorm.
+\remarks The four-component format is used because three-component 16-bit formats are not supported by all backends.
+Positions are quantized with SSE2 on x86 and NEON on ARM64.
+*/
+LLGL_EXPORT Format QuantizePositionsSNorm16(
+    void*                       dst,
+    std::size_t                 dstStride,
+    const float*                src,
+    std::size_t                 srcStride,
+    std::size_t                 numVertices,
+    VertexQuantizationBounds&   outBounds
+);
+
+/**
+\brief Encodes 3D unit vectors, e.g. vertex normals or tangents, with octahedral mapping into two signed normalized components.
+\param[out] dst Pointer to the first destination vertex.
+\param[in] dstStride Specifies the stride (in bytes) between two destination vertices.
+This must be at least 4 for Format::RG16SNorm and Format::RGBA8SNorm.
+\param[in] src Pointer to the first source vector. Each vector must consist of three \c float components and must not be zero.
+\param[in] srcStride Specifies the stride (in bytes) between two source vectors. This must be at least 12.
+\param[in] numVertices Specifies the number of vertices to convert.
+\param[in] format Specifies the destination format. This must be either Format::RG16SNorm or Format::RGBA8SNorm.
+For Format::RGBA8SNorm, the third and fourth component are set to zero. By default Format::RG16SNorm.
+\return Vertex attribute format of the encoded vectors, i.e. \c format, or Format::Undefined if the format is not supported, in which case nothing is written.
+\remarks The original vector is reconstructed in the vertex shader as follows:
+\code
+vec3 DecodeOctahedral(vec2 e) {
+    vec3 n = vec3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+\endcode
+Vectors are encoded with SSE2 on x86 and NEON on ARM64.
+*/
+LLGL_EXPORT Format EncodeNormalsOctahedral(
+    void*           dst,
+    std::size_t     dstStride,
+    const float*    src,
+    std::size_t     srcStride,
+    std::size_t     numVertices,
+    Format          format = Format::RG16SNorm
+);
+
+/**
+\brief Converts 2D texture coordinates into 16-bit floating-point components.
+\param[out] dst Pointer to the first destination vertex. Each texture coordinate is written as two 16-bit floats.
+\param[in] dstStride Specifies the stride (in bytes) between two destination vertices. This must be at least 4.
+\param[in] src Pointer to the first source texture coordinate. Each texture coordinate must consist of two \c float components.
+\param[in] srcStride Specifies the stride (in bytes) between two source texture coordinates. This must be at least 8.
+\param[in] numVertices Specifies the number of vertices to convert.
+\return Vertex attribute format of the converted texture coordinates, which is Format::RG16Float.
+\remarks Tightly packed arrays, i.e. a source stride of 8 and a destination stride of 4, are converted with F16C on x86 if the CPU supports it and NEON on ARM64.
+*/
+LLGL_EXPORT Format CompressTexCoordsFloat16(
+    void*           dst,
+    std::size_t     dstStride,
+    const float*    src,
+    std::size_t     srcStride,
+    std::size_t     numVertices
+);
+
+
 } // /namespace LLGL
 
 
@@ -20,14 +20,11 @@ namespace LLGL
 {
 
 
-//TODO: this header is currently only included by internal classes
-
 /* ----- Structures ----- */
 
 /**
 \brief Video output structure.
 \see VideoAdapterDescriptor::outputs
-\todo Currently unused in the interface.
 */
 struct VideoOutputDescriptor
 {
@@ -38,7 +35,7 @@ struct VideoOutputDescriptor
 /**
 \brief Video adapter descriptor structure.
 \remarks A video adapter determines the output capabilities of a GPU.
-\todo Currently unused in the interface.
+\see RendererInfo::videoAdapters
 */
 struct VideoAdapterDescriptor
 {
@@ -51,6 +48,28 @@ struct VideoAdapterDescriptor
     //! Video memory size (in bytes).
     std::uint64_t                       videoMemory = 0;
 
+    /**
+    \brief Locally unique identifier (LUID) of this adapter. This is 0 if the adapter has no LUID.
+    \remarks This identifies the adapter only until the system is restarted.
+    On Metal, this is the registry ID of the device.
+    \see RenderSystemDescriptor::adapterLUID
+    */
+    std::uint64_t                       luid        = 0;
+
+    /**
+    \brief Universally unique identifier (UUID) of this adapter. This is all zero if the adapter has no UUID.
+    \remarks This identifies the same adapter across different processes and APIs.
+    \note Only supported with: Vulkan.
+    */
+    std::uint8_t                        uuid[16]    = {};
+
+    /**
+    \brief Number of physical GPU nodes this adapter consists of, e.g. two for a linked SLI or CrossFire configuration. By default 1.
+    \remarks Resources are only created on the first node of linked adapters.
+    \note Only supported with: Direct3D 12.
+    */
+    std::uint32_t                       numNodes    = 1;
+
     //! List of all adapter output descriptors.
     std::vector<VideoOutputDescriptor>  outputs;
 };
@@ -71,6 +71,16 @@ struct WindowDescriptor
     //! Specifies whether the window is centered within the desktop screen. By default false.
     bool            centered            = false;
 
+    /**
+    \brief Specifies whether window events are received on a separate thread. By default false.
+    \remarks If enabled, native events are read by a dedicated event thread as soon as they arrive and consecutive mouse motion events are merged into a single event.
+    The event listeners are still invoked on the thread that calls Surface::ProcessEvents, but that function no longer performs any system calls.
+    If LLGL was built with \c LLGL_LINUX_ENABLE_XINPUT2, the \c OnGlobalMotion callback receives unaccelerated raw mouse motion while the window has the input focus.
+    \note Only supported on: Linux.
+    \see Window::EventListener::OnGlobalMotion
+    */
+    bool            threadedEvents      = false;
+
     /**
     \brief Window context handle.
     \remarks If used, this must be casted from a platform specific structure:
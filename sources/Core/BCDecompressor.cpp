@@ -6,8 +6,11 @@
  */
 
 #include "BCDecompressor.h"
+#include "Threading.h"
 #include <LLGL/Types.h>
 #include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <functional>
 #include <cstring>
 
 
@@ -15,106 +18,263 @@ namespace LLGL
 {
 
 
+// Decoded 4x4 block with RGBA8 pixels in row-major order.
+using BCPixelBlock = std::uint8_t[16][4];
+
+static std::uint16_t ReadUInt16(const std::uint8_t* data)
+{
+    return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+}
+
+static std::uint32_t ReadUInt32(const std::uint8_t* data)
+{
+    return
+    (
+        (static_cast<std::uint32_t>(data[0])      ) |
+        (static_cast<std::uint32_t>(data[1]) <<  8) |
+        (static_cast<std::uint32_t>(data[2]) << 16) |
+        (static_cast<std::uint32_t>(data[3]) << 24)
+    );
+}
+
+// Expands the specified RGB565 color to 8-bit components.
 static void DecompressRGBColor16Bit(std::uint8_t* dst, std::uint16_t src)
 {
-    dst[0] = ((src >> 12) & 0x000F) * 0xFF / 0x0F;
-    dst[1] = ((src >>  6) & 0x001F) * 0xFF / 0x1F;
-    dst[2] = ((src >>  1) & 0x000F) * 0xFF / 0x0F;
+    const std::uint32_t r = (src >> 11) & 0x1F;
+    const std::uint32_t g = (src >>  5) & 0x3F;
+    const std::uint32_t b = (src      ) & 0x1F;
+    dst[0] = static_cast<std::uint8_t>((r << 3) | (r >> 2));
+    dst[1] = static_cast<std::uint8_t>((g << 2) | (g >> 4));
+    dst[2] = static_cast<std::uint8_t>((b << 3) | (b >> 2));
+    dst[3] = 0xFF;
 }
 
-#if 0 //UNUSED
-static void DecompressRGBAColor16Bit(std::uint8_t* dst, std::uint16_t src)
+// Returns the weighted average (a*wa + b*wb)/(wa + wb) rounded to the nearest integer.
+static std::uint8_t InterpolateComponent(std::uint32_t a, std::uint32_t b, std::uint32_t wa, std::uint32_t wb)
 {
-    DecompressRGBColor16Bit(dst, src);
-    dst[3] = (src & 0x0001) * 0xFF;
+    const std::uint32_t w = wa + wb;
+    return static_cast<std::uint8_t>((a * wa + b * wb + w / 2) / w);
 }
 
-static std::uint8_t DecompressAlphaChannel4Bit(std::uint32_t& src)
+static void InterpolateColor(std::uint8_t* dst, const std::uint8_t* src0, const std::uint8_t* src1, std::uint32_t w0, std::uint32_t w1)
 {
-    auto alpha = static_cast<std::uint8_t >((src & 0x0000000F) * 0xFF / 0x0F);
-    src >>= 4;
-    return alpha;
+    dst[0] = InterpolateComponent(src0[0], src1[0], w0, w1);
+    dst[1] = InterpolateComponent(src0[1], src1[1], w0, w1);
+    dst[2] = InterpolateComponent(src0[2], src1[2], w0, w1);
+    dst[3] = 0xFF;
 }
 
-static void Decompress16AlphaChannels4Bit(std::uint8_t* dst, std::uint32_t src0, std::uint32_t src1)
+/*
+Decodes the 64-bit BC1 color block into the RGBA components of the output block.
+The 3-color mode with transparent black is only available for BC1, i.e. BC2 and BC3 always use the 4-color mode.
+*/
+static void DecodeColorBlock(const std::uint8_t* block, BCPixelBlock& output, bool allowTransparency)
 {
-    for (int i = 0; i < 8; ++i)
+    std::uint8_t palette[4][4];
+
+    /* Decompress two 16 bit colors and generate two more colors by interpolating them */
+    const std::uint16_t color0 = ReadUInt16(block);
+    const std::uint16_t color1 = ReadUInt16(block + 2);
+
+    DecompressRGBColor16Bit(palette[0], color0);
+    DecompressRGBColor16Bit(palette[1], color1);
+
+    if (color0 > color1 || !allowTransparency)
+    {
+        InterpolateColor(palette[2], palette[0], palette[1], 2, 1);
+        InterpolateColor(palette[3], palette[0], palette[1], 1, 2);
+    }
+    else
     {
-        dst[i    ] = DecompressAlphaChannel4Bit(src0);
-        dst[i + 8] = DecompressAlphaChannel4Bit(src1);
+        InterpolateColor(palette[2], palette[0], palette[1], 1, 1);
+        std::memset(palette[3], 0, sizeof(palette[3]));
     }
+
+    /* Generate 4x4 pixel block from palette bitmask; 2 bits per pixel */
+    const std::uint32_t indices = ReadUInt32(block + 4);
+    for_range(i, 16u)
+        std::memcpy(output[i], palette[(indices >> (i * 2)) & 0x3], 4);
 }
-#endif
 
-static std::uint8_t InterpolateColorComponent(std::uint16_t a, std::uint16_t b)
+// Decodes the 64-bit BC2 block of explicit 4-bit alpha values into the specified component of the output block.
+static void DecodeExplicitAlphaBlock(const std::uint8_t* block, BCPixelBlock& output, std::size_t component)
 {
-    if (a > b)
-        return static_cast<std::uint8_t>((2 * a + b + 1) / 3);
-    else
-        return static_cast<std::uint8_t>((a + b) / 2);
+    for_range(i, 16u)
+    {
+        const std::uint32_t alpha = (block[i / 2] >> ((i % 2) * 4)) & 0x0F;
+        output[i][component] = static_cast<std::uint8_t>(alpha * 0x11);
+    }
 }
 
-static void InterpolateColor(std::uint8_t* dst, const std::uint8_t* src0, const std::uint8_t* src1)
+// Decodes the 64-bit BC3 alpha block (also used for the channels of BC4 and BC5) into the specified component of the output block.
+static void DecodeInterpolatedAlphaBlock(const std::uint8_t* block, BCPixelBlock& output, std::size_t component)
 {
-    dst[0] = InterpolateColorComponent(src0[0], src1[0]);
-    dst[1] = InterpolateColorComponent(src0[1], src1[1]);
-    dst[2] = InterpolateColorComponent(src0[2], src1[2]);
+    std::uint8_t palette[8];
+
+    const std::uint32_t alpha0 = block[0];
+    const std::uint32_t alpha1 = block[1];
+
+    palette[0] = static_cast<std::uint8_t>(alpha0);
+    palette[1] = static_cast<std::uint8_t>(alpha1);
+
+    if (alpha0 > alpha1)
+    {
+        /* 8-value mode: 6 interpolated values */
+        for_subrange(i, 1u, 7u)
+            palette[i + 1] = InterpolateComponent(alpha0, alpha1, 7 - i, i);
+    }
+    else
+    {
+        /* 6-value mode: 4 interpolated values plus explicit 0 and 1 */
+        for_subrange(i, 1u, 5u)
+            palette[i + 1] = InterpolateComponent(alpha0, alpha1, 5 - i, i);
+        palette[6] = 0x00;
+        palette[7] = 0xFF;
+    }
+
+    /* Read 48-bit index bitfield with 3 bits per pixel */
+    std::uint64_t indices = 0;
+    for_range(i, 6u)
+        indices |= (static_cast<std::uint64_t>(block[2 + i]) << (i * 8));
+
+    for_range(i, 16u)
+        output[i][component] = palette[(indices >> (i * 3)) & 0x7];
 }
 
-ByteBuffer DecompressBC1ToRGBA8UNorm(
-    const Extent2D& extent,
-    const char*     data,
-    std::size_t     dataSize,
-    unsigned        /*threadCount*/)
+static void DecodeBlockBC1(const std::uint8_t* block, BCPixelBlock& output)
 {
-    /* Return null on invalid arguments */
-    if (extent.width % 4 != 0 || extent.height % 4 != 0 || data == nullptr || dataSize < extent.width * extent.height / 2)
-        return nullptr;
+    DecodeColorBlock(block, output, true);
+}
 
-    ByteBuffer dstImage = AllocateByteBuffer(extent.width * extent.height * 4, UninitializeTag{});
+static void DecodeBlockBC2(const std::uint8_t* block, BCPixelBlock& output)
+{
+    DecodeColorBlock(block + 8, output, false);
+    DecodeExplicitAlphaBlock(block, output, 3);
+}
 
-    std::uint8_t* output = reinterpret_cast<std::uint8_t*>(dstImage.get());
-    std::uint16_t compressedColor[2];
-    std::uint8_t decompressedColor[4][3];
+static void DecodeBlockBC3(const std::uint8_t* block, BCPixelBlock& output)
+{
+    DecodeColorBlock(block + 8, output, false);
+    DecodeInterpolatedAlphaBlock(block, output, 3);
+}
 
-    const std::size_t formatByteSize = 4;
+static void DecodeBlockBC4(const std::uint8_t* block, BCPixelBlock& output)
+{
+    for_range(i, 16u)
+    {
+        output[i][1] = 0x00;
+        output[i][2] = 0x00;
+        output[i][3] = 0xFF;
+    }
+    DecodeInterpolatedAlphaBlock(block, output, 0);
+}
 
-    for_range(y, extent.height / 4u)
+static void DecodeBlockBC5(const std::uint8_t* block, BCPixelBlock& output)
+{
+    for_range(i, 16u)
     {
-        for_range(x, extent.width / 4u)
-        {
-            /* Decompress two 16 bit colors */
-            for_range(i, 2)
-            {
-                compressedColor[i] = *reinterpret_cast<const std::uint16_t*>(data);
-                DecompressRGBColor16Bit(decompressedColor[i], compressedColor[i]);
-                data += 2;
-            }
+        output[i][2] = 0x00;
+        output[i][3] = 0xFF;
+    }
+    DecodeInterpolatedAlphaBlock(block, output, 0);
+    DecodeInterpolatedAlphaBlock(block + 8, output, 1);
+}
 
-            /* Generate two more colors by interpolating the previous two */
-            InterpolateColor(decompressedColor[2], decompressedColor[0], decompressedColor[1]);
-            InterpolateColor(decompressedColor[3], decompressedColor[1], decompressedColor[0]);
+using BCBlockDecoder = void (*)(const std::uint8_t* block, BCPixelBlock& output);
 
-            /* Read palette bitfield */
-            std::uint32_t palette = *reinterpret_cast<const std::uint32_t*>(data);
-            data += 4;
+// Worker thread procedure for the "DecompressBCToRGBA8UNorm" function; decodes the block rows in the range [blockRowBegin, blockRowEnd).
+static void DecompressBCBlockRows(
+    BCBlockDecoder      decoder,
+    std::size_t         blockSize,
+    const Extent2D&     extent,
+    const std::uint8_t* input,
+    std::uint8_t*       output,
+    std::size_t         blockRowBegin,
+    std::size_t         blockRowEnd)
+{
+    const std::size_t   numBlocksX      = (extent.width + 3) / 4;
+    const std::size_t   formatByteSize  = 4;
+    BCPixelBlock        pixels;
+
+    for_subrange(y, blockRowBegin, blockRowEnd)
+    {
+        const std::uint8_t* block       = input + y * numBlocksX * blockSize;
+        const std::size_t   blockHeight = std::min<std::size_t>(4, extent.height - y * 4);
 
-            /* Generate 4x4 pixel block from palette bitmask */
-            for_range(i, 16u)
+        for_range(x, numBlocksX)
+        {
+            decoder(block, pixels);
+            block += blockSize;
+
+            /* Copy decoded pixels into output image and clip partial blocks at the image border */
+            const std::size_t blockWidth = std::min<std::size_t>(4, extent.width - x * 4);
+            for_range(row, blockHeight)
             {
-                /* Get palette index from last two bits */
-                const std::uint32_t paletteIndex = palette & 0x00000003;
-                palette >>= 2;
-
-                /* Write out image color */
-                const std::size_t outputOffset = (((y * 4 + i/4) * extent.width) + (x*4 + i%4)) * formatByteSize;
-                output[outputOffset + 0] = decompressedColor[paletteIndex][0];
-                output[outputOffset + 1] = decompressedColor[paletteIndex][1];
-                output[outputOffset + 2] = decompressedColor[paletteIndex][2];
-                output[outputOffset + 3] = 0xFF;
+                const std::size_t outputOffset = ((y * 4 + row) * extent.width + x * 4) * formatByteSize;
+                std::memcpy(output + outputOffset, pixels[row * 4], blockWidth * formatByteSize);
             }
         }
     }
+}
+
+ByteBuffer DecompressBCToRGBA8UNorm(
+    ImageFormat     format,
+    const Extent2D& extent,
+    const char*     data,
+    std::size_t     dataSize,
+    unsigned        threadCount)
+{
+    /* Select block decoder for compression format */
+    BCBlockDecoder  decoder     = nullptr;
+    std::size_t     blockSize   = 16;
+
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            decoder     = DecodeBlockBC1;
+            blockSize   = 8;
+            break;
+        case ImageFormat::BC2:
+            decoder     = DecodeBlockBC2;
+            break;
+        case ImageFormat::BC3:
+            decoder     = DecodeBlockBC3;
+            break;
+        case ImageFormat::BC4:
+            decoder     = DecodeBlockBC4;
+            blockSize   = 8;
+            break;
+        case ImageFormat::BC5:
+            decoder     = DecodeBlockBC5;
+            break;
+        default:
+            return nullptr;
+    }
+
+    /* Return null on invalid arguments */
+    const std::size_t numBlocksX = (extent.width  + 3) / 4;
+    const std::size_t numBlocksY = (extent.height + 3) / 4;
+
+    if (data == nullptr || dataSize < numBlocksX * numBlocksY * blockSize)
+        return nullptr;
+
+    ByteBuffer dstImage = AllocateByteBuffer(extent.width * extent.height * 4, UninitializeTag{});
+
+    DoConcurrentRange(
+        std::bind(
+            DecompressBCBlockRows,
+            decoder,
+            blockSize,
+            std::cref(extent),
+            reinterpret_cast<const std::uint8_t*>(data),
+            reinterpret_cast<std::uint8_t*>(dstImage.get()),
+            std::placeholders::_1,
+            std::placeholders::_2
+        ),
+        numBlocksY,
+        threadCount,
+        4
+    );
 
     return dstImage;
 }
@@ -22,10 +22,13 @@ struct Extent2D;
 /* ----- Functions ----- */
 
 /*
-Returns an image buffer in the Format::RGBA8UNorm format for the specified BC1 encoded data, or null on failure
-Width and height of the input image must be a multiple of 4.
+Returns an image buffer in the Format::RGBA8UNorm format for the specified BC1, BC2, BC3, BC4, or BC5 encoded data, or null on failure.
+The input data must contain all 4x4 blocks that cover the image extent, i.e. partial blocks at the right and bottom border are clipped.
+BC4 and BC5 are decoded as unsigned normalized red and red-green channels respectively; the remaining channels are (0, 0, 1).
+Block rows are decoded concurrently with the specified number of threads.
 */
-ByteBuffer DecompressBC1ToRGBA8UNorm(
+ByteBuffer DecompressBCToRGBA8UNorm(
+    ImageFormat     format,
     const Extent2D& extent,
     const char*     data,
     std::size_t     dataSize,
@@ -216,6 +216,50 @@ T Clamp(T x, T minimum, T maximum)
 }
 
 
+/* ----- Hashing ----- */
+
+// Offset basis of the 64-bit FNV-1a hash.
+static constexpr std::uint64_t g_fnv1aOffsetBasis = 0xCBF29CE484222325ull;
+
+// Returns the 64-bit FNV-1a hash of the specified memory block, continuing with the specified hash value. The hash is stable across multiple runs and platforms.
+inline std::uint64_t HashFNV1a(const void* data, std::size_t size, std::uint64_t hash = g_fnv1aOffsetBasis)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Accumulates a 64-bit FNV-1a hash over multiple values, e.g. of a descriptor whose hash identifies a cache entry across multiple runs.
+struct FNV1aHasher
+{
+    std::uint64_t value = g_fnv1aOffsetBasis;
+
+    void Append(const void* data, std::size_t size)
+    {
+        value = HashFNV1a(data, size, value);
+    }
+
+    template <typename T>
+    void AppendValue(const T& data)
+    {
+        Append(&data, sizeof(data));
+    }
+
+    // Appends the specified string including its null terminator, or a single null terminator if the string is null.
+    void AppendString(const char* str)
+    {
+        if (str != nullptr)
+            Append(str, ::strlen(str) + 1);
+        else
+            AppendValue('\0');
+    }
+};
+
+
 } // /namespace LLGL
 
 
@@ -7,6 +7,18 @@
 
 #include "Float16Compressor.h"
 
+#if defined __aarch64__ || defined _M_ARM64
+#   define LLGL_FLOAT16_NEON
+#   include <arm_neon.h>
+#elif defined _MSC_VER && defined __AVX2__
+#   define LLGL_FLOAT16_F16C
+#   include <immintrin.h>
+#elif (defined __GNUC__ || defined __clang__) && (defined __x86_64__ || defined __i386__)
+#   define LLGL_FLOAT16_F16C
+#   define LLGL_FLOAT16_F16C_TARGET __attribute__((target("f16c")))
+#   include <immintrin.h>
+#endif
+
 
 namespace LLGL
 {
@@ -39,6 +51,27 @@ class Float16Compressor
             return (v.ui | sign);
         }
 
+        #ifdef LLGL_FLOAT16_NEON
+
+        // Compresses four values with the same truncation as the scalar version, since vcvt_f16_f32 would round to nearest.
+        static uint16x4_t Compress(float32x4_t value)
+        {
+            int32x4_t v = vreinterpretq_s32_f32(value);
+            int32x4_t sign = vandq_s32(v, vdupq_n_s32(signN));
+            v = veorq_s32(v, sign);
+            sign = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(sign), shiftSign)); // logical shift
+            const int32x4_t s = vcvtq_s32_f32(vmulq_f32(vreinterpretq_f32_s32(vdupq_n_s32(mulN)), vreinterpretq_f32_s32(v))); // correct subnormals
+            v = vbslq_s32(vcgtq_s32(vdupq_n_s32(minN), v), s, v);
+            v = vbslq_s32(vandq_u32(vcgtq_s32(vdupq_n_s32(infN), v), vcgtq_s32(v, vdupq_n_s32(maxN))), vdupq_n_s32(infN), v);
+            v = vbslq_s32(vandq_u32(vcgtq_s32(vdupq_n_s32(nanN), v), vcgtq_s32(v, vdupq_n_s32(infN))), vdupq_n_s32(nanN), v);
+            v = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), shift)); // logical shift
+            v = vbslq_s32(vcgtq_s32(v, vdupq_n_s32(maxC)), vsubq_s32(v, vdupq_n_s32(maxD)), v);
+            v = vbslq_s32(vcgtq_s32(v, vdupq_n_s32(subC)), vsubq_s32(v, vdupq_n_s32(minD)), v);
+            return vmovn_u32(vreinterpretq_u32_s32(vorrq_s32(v, sign)));
+        }
+
+        #endif // /LLGL_FLOAT16_NEON
+
         static float Decompress(std::uint16_t value)
         {
             Bits v;
@@ -103,6 +136,83 @@ LLGL_EXPORT float DecompressFloat16(std::uint16_t value)
     return Float16Compressor::Decompress(value);
 }
 
+#ifdef LLGL_FLOAT16_F16C
+
+#ifndef LLGL_FLOAT16_F16C_TARGET
+#   define LLGL_FLOAT16_F16C_TARGET
+#endif
+
+// Returns true if the F16C instructions can be used on the host CPU. With MSVC, these are implied by the /arch:AVX2 compiler option.
+static bool IsF16CSupported()
+{
+    #ifdef _MSC_VER
+    return true;
+    #else
+    static const bool isSupported = (__builtin_cpu_supports("f16c") != 0);
+    return isSupported;
+    #endif
+}
+
+LLGL_FLOAT16_F16C_TARGET
+static std::size_t CompressFloat16ArrayF16C(std::uint16_t* dst, const float* src, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 values = _mm256_loadu_ps(src + i);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(values, _MM_FROUND_TO_ZERO));
+    }
+    return i;
+}
+
+LLGL_FLOAT16_F16C_TARGET
+static std::size_t DecompressFloat16ArrayF16C(float* dst, const std::uint16_t* src, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(values));
+    }
+    return i;
+}
+
+#endif // /LLGL_FLOAT16_F16C
+
+LLGL_EXPORT void CompressFloat16Array(std::uint16_t* dst, const float* src, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_FLOAT16_F16C
+    if (IsF16CSupported())
+        i = CompressFloat16ArrayF16C(dst, src, count);
+    #elif defined LLGL_FLOAT16_NEON
+    for (; i + 4 <= count; i += 4)
+        vst1_u16(dst + i, Float16Compressor::Compress(vld1q_f32(src + i)));
+    #endif
+
+    /* Compress remaining values with scalar conversion */
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Compress(src[i]);
+}
+
+LLGL_EXPORT void DecompressFloat16Array(float* dst, const std::uint16_t* src, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_FLOAT16_F16C
+    if (IsF16CSupported())
+        i = DecompressFloat16ArrayF16C(dst, src, count);
+    #elif defined LLGL_FLOAT16_NEON
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+    #endif
+
+    /* Decompress remaining values with scalar conversion */
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Decompress(src[i]);
+}
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/Export.h>
 #include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
@@ -23,6 +24,20 @@ LLGL_EXPORT std::uint16_t CompressFloat16(float value);
 // Decompresses the specified 16-bit float (represented as 16-bit unsigned integer) into a 32-bit float.
 LLGL_EXPORT float DecompressFloat16(std::uint16_t value);
 
+/*
+Compresses the specified array of 32-bit floats into 16-bit floats.
+This uses F16C instructions on x86 if the CPU supports them and NEON on ARM64.
+Values are truncated toward zero like with CompressFloat16 on all paths.
+With F16C, finite values beyond the 16-bit float range are clamped to the largest finite value instead of infinity.
+*/
+LLGL_EXPORT void CompressFloat16Array(std::uint16_t* dst, const float* src, std::size_t count);
+
+/*
+Decompresses the specified array of 16-bit floats into 32-bit floats.
+This uses F16C instructions on x86 if the CPU supports them and NEON on ARM64.
+*/
+LLGL_EXPORT void DecompressFloat16Array(float* dst, const std::uint16_t* src, std::size_t count);
+
 
 } // /namespace LLGL
 
@@ -7,6 +7,7 @@
 
 #include <LLGL/Utils/Image.h>
 #include "ImageUtils.h"
+#include "ImageMipChain.h"
 #include "Exception.h"
 #include "PrintfUtils.h"
 #include <algorithm>
@@ -150,6 +151,11 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAf& fillColor, const Of
     }
 }
 
+ByteBuffer Image::GenerateMipChain(const TextureType type, const MipMapFilter filter, std::uint32_t numMipLevels, bool isSRGB, unsigned threadCount) const
+{
+    return GenerateImageMipChain(GetSrcDesc(), type, GetExtent(), numMipLevels, filter, isSRGB, threadCount);
+}
+
 void Image::Swap(Image& rhs)
 {
     std::swap(extent_,   rhs.extent_  );
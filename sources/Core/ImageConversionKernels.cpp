@@ -0,0 +1,360 @@
+/*
+ * ImageConversionKernels.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "ImageConversionKernels.h"
+#include "Float16Compressor.h"
+#include <LLGL/Utils/ForRange.h>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_IMAGE_KERNELS_SSE2
+#   include <emmintrin.h>
+#elif defined __ARM_NEON || defined __ARM_NEON__ || defined _M_ARM64
+#   define LLGL_IMAGE_KERNELS_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+All SIMD kernels below process the bulk of their range in blocks and the remainder with the same scalar code as the fallback kernels.
+Only instruction sets that are part of the target's baseline are used (SSE2 on x86-64, NEON on ARM64), so no runtime dispatch is required.
+*/
+
+/* ----- Format kernels for 8-bit components ----- */
+
+// Converts RGB to RGBA or BGR to BGRA; the alpha channel is set to its maximum as in the generic conversion.
+static void ExpandRGB8ToRGBA8(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(srcBuffer) + begin * 3;
+    std::uint8_t*       dst = static_cast<std::uint8_t*>(dstBuffer) + begin * 4;
+    std::size_t         i   = begin;
+
+    #ifdef LLGL_IMAGE_KERNELS_NEON
+    for (; i + 16 <= end; i += 16, src += 16*3, dst += 16*4)
+    {
+        const uint8x16x3_t rgb = vld3q_u8(src);
+        const uint8x16x4_t rgba = { { rgb.val[0], rgb.val[1], rgb.val[2], vdupq_n_u8(0xFF) } };
+        vst4q_u8(dst, rgba);
+    }
+    #endif
+
+    for (; i < end; ++i, src += 3, dst += 4)
+    {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = 0xFF;
+    }
+}
+
+// Converts RGB to BGRA or BGR to RGBA; the alpha channel is set to its maximum as in the generic conversion.
+static void ExpandRGB8ToBGRA8(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(srcBuffer) + begin * 3;
+    std::uint8_t*       dst = static_cast<std::uint8_t*>(dstBuffer) + begin * 4;
+    std::size_t         i   = begin;
+
+    #ifdef LLGL_IMAGE_KERNELS_NEON
+    for (; i + 16 <= end; i += 16, src += 16*3, dst += 16*4)
+    {
+        const uint8x16x3_t rgb = vld3q_u8(src);
+        const uint8x16x4_t bgra = { { rgb.val[2], rgb.val[1], rgb.val[0], vdupq_n_u8(0xFF) } };
+        vst4q_u8(dst, bgra);
+    }
+    #endif
+
+    for (; i < end; ++i, src += 3, dst += 4)
+    {
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = src[0];
+        dst[3] = 0xFF;
+    }
+}
+
+// Converts RGBA to BGRA or vice versa by swapping the first and third component of each pixel.
+static void SwizzleRGBA8ToBGRA8(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(srcBuffer) + begin * 4;
+    std::uint8_t*       dst = static_cast<std::uint8_t*>(dstBuffer) + begin * 4;
+    std::size_t         i   = begin;
+
+    #if defined LLGL_IMAGE_KERNELS_SSE2
+
+    const __m128i maskGA = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const __m128i maskR  = _mm_set1_epi32(0x000000FF);
+
+    for (; i + 4 <= end; i += 4, src += 4*4, dst += 4*4)
+    {
+        /* Keep G and A components in place and swap R and B within each 32-bit pixel */
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i ga     = _mm_and_si128(pixels, maskGA);
+        const __m128i r      = _mm_slli_epi32(_mm_and_si128(pixels, maskR), 16);
+        const __m128i b      = _mm_and_si128(_mm_srli_epi32(pixels, 16), maskR);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(ga, _mm_or_si128(r, b)));
+    }
+
+    #elif defined LLGL_IMAGE_KERNELS_NEON
+
+    for (; i + 16 <= end; i += 16, src += 16*4, dst += 16*4)
+    {
+        uint8x16x4_t pixels = vld4q_u8(src);
+        const uint8x16_t r = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = r;
+        vst4q_u8(dst, pixels);
+    }
+
+    #endif
+
+    for (; i < end; ++i, src += 4, dst += 4)
+    {
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = src[0];
+        dst[3] = src[3];
+    }
+}
+
+// Converts RGBA to RGB or BGRA to BGR by dropping the alpha channel.
+static void ShrinkRGBA8ToRGB8(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(srcBuffer) + begin * 4;
+    std::uint8_t*       dst = static_cast<std::uint8_t*>(dstBuffer) + begin * 3;
+    std::size_t         i   = begin;
+
+    #ifdef LLGL_IMAGE_KERNELS_NEON
+    for (; i + 16 <= end; i += 16, src += 16*4, dst += 16*3)
+    {
+        const uint8x16x4_t rgba = vld4q_u8(src);
+        const uint8x16x3_t rgb = { { rgba.val[0], rgba.val[1], rgba.val[2] } };
+        vst3q_u8(dst, rgb);
+    }
+    #endif
+
+    for (; i < end; ++i, src += 4, dst += 3)
+    {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+    }
+}
+
+// Converts RGBA to BGR or BGRA to RGB by dropping the alpha channel and swapping the first and third component.
+static void ShrinkRGBA8ToBGR8(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(srcBuffer) + begin * 4;
+    std::uint8_t*       dst = static_cast<std::uint8_t*>(dstBuffer) + begin * 3;
+    std::size_t         i   = begin;
+
+    #ifdef LLGL_IMAGE_KERNELS_NEON
+    for (; i + 16 <= end; i += 16, src += 16*4, dst += 16*3)
+    {
+        const uint8x16x4_t rgba = vld4q_u8(src);
+        const uint8x16x3_t bgr = { { rgba.val[2], rgba.val[1], rgba.val[0] } };
+        vst3q_u8(dst, bgr);
+    }
+    #endif
+
+    for (; i < end; ++i, src += 4, dst += 3)
+    {
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = src[0];
+    }
+}
+
+
+/* ----- Data type kernels ----- */
+
+// Returns the lookup table for normalized 8-bit unsigned integers to 16-bit floats, computed with the same formula as the generic conversion.
+static const std::uint16_t* GetUNorm8ToFloat16Table()
+{
+    static const struct Table
+    {
+        Table()
+        {
+            for_range(i, 256u)
+                values[i] = CompressFloat16(static_cast<float>(static_cast<double>(i) / 255.0));
+        }
+        std::uint16_t values[256];
+    }
+    table;
+    return table.values;
+}
+
+// Returns the lookup table for normalized 8-bit unsigned integers to 32-bit floats, computed with the same formula as the generic conversion.
+static const float* GetUNorm8ToFloat32Table()
+{
+    static const struct Table
+    {
+        Table()
+        {
+            for_range(i, 256u)
+                values[i] = static_cast<float>(static_cast<double>(i) / 255.0);
+        }
+        float values[256];
+    }
+    table;
+    return table.values;
+}
+
+static void ConvertUNorm8ToFloat16(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const std::uint8_t*     src     = static_cast<const std::uint8_t*>(srcBuffer);
+    std::uint16_t*          dst     = static_cast<std::uint16_t*>(dstBuffer);
+    const std::uint16_t*    table   = GetUNorm8ToFloat16Table();
+
+    for_subrange(i, begin, end)
+        dst[i] = table[src[i]];
+}
+
+static void ConvertUNorm8ToFloat32(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const std::uint8_t* src     = static_cast<const std::uint8_t*>(srcBuffer);
+    float*              dst     = static_cast<float*>(dstBuffer);
+    const float*        table   = GetUNorm8ToFloat32Table();
+
+    for_subrange(i, begin, end)
+        dst[i] = table[src[i]];
+}
+
+static void ConvertFloat32ToUNorm8(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const float*    src = static_cast<const float*>(srcBuffer);
+    std::uint8_t*   dst = static_cast<std::uint8_t*>(dstBuffer);
+    std::size_t     i   = begin;
+
+    #ifdef LLGL_IMAGE_KERNELS_SSE2
+
+    /*
+    Scale in double precision and truncate like the generic conversion, so both produce the same values.
+    Clamp before truncation like the scalar loop below, so out-of-range values and NaN don't depend on their position in the buffer.
+    */
+    const __m128d scale     = _mm_set1_pd(255.0);
+    const __m128d minValue  = _mm_setzero_pd();
+
+    auto ScaleAndClamp = [&scale, &minValue](__m128 v) -> __m128d
+    {
+        /* MAXPD returns the second operand if the first one is NaN, so NaN is mapped to 0 */
+        return _mm_min_pd(_mm_max_pd(_mm_mul_pd(_mm_cvtps_pd(v), scale), minValue), scale);
+    };
+
+    auto ConvertFloat4ToInt4 = [&ScaleAndClamp](const float* values) -> __m128i
+    {
+        const __m128  v  = _mm_loadu_ps(values);
+        const __m128i lo = _mm_cvttpd_epi32(ScaleAndClamp(v));
+        const __m128i hi = _mm_cvttpd_epi32(ScaleAndClamp(_mm_movehl_ps(v, v)));
+        return _mm_unpacklo_epi64(lo, hi);
+    };
+
+    for (; i + 16 <= end; i += 16)
+    {
+        const __m128i v0 = ConvertFloat4ToInt4(src + i);
+        const __m128i v1 = ConvertFloat4ToInt4(src + i + 4);
+        const __m128i v2 = ConvertFloat4ToInt4(src + i + 8);
+        const __m128i v3 = ConvertFloat4ToInt4(src + i + 12);
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+
+    #endif
+
+    /* Clamp to [0, 255] before truncation, since out-of-range float-to-integer conversions are undefined; NaN is mapped to 0 */
+    for (; i < end; ++i)
+        dst[i] = static_cast<std::uint8_t>(std::min(std::max(0.0, static_cast<double>(src[i]) * 255.0), 255.0));
+}
+
+static void ConvertFloat32ToFloat16(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const float*    src = static_cast<const float*>(srcBuffer);
+    std::uint16_t*  dst = static_cast<std::uint16_t*>(dstBuffer);
+    CompressFloat16Array(dst + begin, src + begin, end - begin);
+}
+
+static void ConvertFloat16ToFloat32(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end)
+{
+    const std::uint16_t*    src = static_cast<const std::uint16_t*>(srcBuffer);
+    float*                  dst = static_cast<float*>(dstBuffer);
+    DecompressFloat16Array(dst + begin, src + begin, end - begin);
+}
+
+
+/* ----- Functions ----- */
+
+ImageConversionKernel FindImageFormatConversionKernel(ImageFormat srcFormat, ImageFormat dstFormat, DataType dataType)
+{
+    if (!(dataType == DataType::UInt8 || dataType == DataType::Int8))
+        return nullptr;
+
+    auto IsFormatPair = [srcFormat, dstFormat](ImageFormat src, ImageFormat dst) -> bool
+    {
+        return (srcFormat == src && dstFormat == dst);
+    };
+
+    if (IsFormatPair(ImageFormat::RGB, ImageFormat::RGBA) || IsFormatPair(ImageFormat::BGR, ImageFormat::BGRA))
+    {
+        /* Alpha channel maximum is only 0xFF for unsigned components */
+        if (dataType == DataType::UInt8)
+            return ExpandRGB8ToRGBA8;
+    }
+    else if (IsFormatPair(ImageFormat::RGB, ImageFormat::BGRA) || IsFormatPair(ImageFormat::BGR, ImageFormat::RGBA))
+    {
+        if (dataType == DataType::UInt8)
+            return ExpandRGB8ToBGRA8;
+    }
+    else if (IsFormatPair(ImageFormat::RGBA, ImageFormat::BGRA) || IsFormatPair(ImageFormat::BGRA, ImageFormat::RGBA))
+        return SwizzleRGBA8ToBGRA8;
+    else if (IsFormatPair(ImageFormat::RGBA, ImageFormat::RGB) || IsFormatPair(ImageFormat::BGRA, ImageFormat::BGR))
+        return ShrinkRGBA8ToRGB8;
+    else if (IsFormatPair(ImageFormat::RGBA, ImageFormat::BGR) || IsFormatPair(ImageFormat::BGRA, ImageFormat::RGB))
+        return ShrinkRGBA8ToBGR8;
+
+    return nullptr;
+}
+
+ImageConversionKernel FindImageDataTypeConversionKernel(DataType srcDataType, DataType dstDataType)
+{
+    switch (srcDataType)
+    {
+        case DataType::UInt8:
+            if (dstDataType == DataType::Float16)
+                return ConvertUNorm8ToFloat16;
+            if (dstDataType == DataType::Float32)
+                return ConvertUNorm8ToFloat32;
+            break;
+
+        case DataType::Float16:
+            if (dstDataType == DataType::Float32)
+                return ConvertFloat16ToFloat32;
+            break;
+
+        case DataType::Float32:
+            if (dstDataType == DataType::UInt8)
+                return ConvertFloat32ToUNorm8;
+            if (dstDataType == DataType::Float16)
+                return ConvertFloat32ToFloat16;
+            break;
+
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
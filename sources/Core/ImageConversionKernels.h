@@ -0,0 +1,48 @@
+/*
+ * ImageConversionKernels.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_IMAGE_CONVERSION_KERNELS_H
+#define LLGL_IMAGE_CONVERSION_KERNELS_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Types ----- */
+
+// Kernel function to convert the image data in the range [begin, end). This range denotes pixels for format kernels and components for data type kernels.
+using ImageConversionKernel = void (*)(const void* srcBuffer, void* dstBuffer, std::size_t begin, std::size_t end);
+
+
+/* ----- Functions ----- */
+
+/*
+Returns a kernel to convert the image format for the specified data type or null if there is no kernel for this conversion.
+Kernels produce the same results as the generic conversion, i.e. a missing alpha channel is set to its maximum value.
+*/
+ImageConversionKernel FindImageFormatConversionKernel(ImageFormat srcFormat, ImageFormat dstFormat, DataType dataType);
+
+/*
+Returns a kernel to convert the image data type or null if there is no kernel for this conversion.
+Kernels produce the same results as the generic conversion for values within the normalized range [0, 1].
+*/
+ImageConversionKernel FindImageDataTypeConversionKernel(DataType srcDataType, DataType dstDataType);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
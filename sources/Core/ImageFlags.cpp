@@ -13,6 +13,7 @@
 #include <thread>
 #include <cstring>
 #include "ImageUtils.h"
+#include "ImageConversionKernels.h"
 #include "../Core/CoreUtils.h"
 #include "../Core/Assertion.h"
 #include "../Core/Threading.h"
@@ -212,6 +213,17 @@ static void ConvertImageBufferDataType(
     if (dstBufferSize != requiredDstBufferSize)
         LLGL_TRAP("cannot convert image data type with destination buffer size mismatch");
 
+    /* Use specialized kernel for common conversions if available */
+    if (ImageConversionKernel kernel = FindImageDataTypeConversionKernel(srcDataType, dstDataType))
+    {
+        DoConcurrentRange(
+            std::bind(kernel, srcBuffer, dstBuffer, std::placeholders::_1, std::placeholders::_2),
+            imageSize,
+            threadCount
+        );
+        return;
+    }
+
     /* Get variant buffer for source and destination images */
     DoConcurrentRange(
         std::bind(
@@ -524,6 +536,20 @@ static void ConvertImageBufferFormat(
     if (dstImageDesc.dataSize != requiredDstBufferSize)
         LLGL_TRAP("cannot convert image format with destination buffer size mismatch");
 
+    /* Use specialized kernel for common conversions if available */
+    if (srcImageDesc.dataType == dstImageDesc.dataType)
+    {
+        if (ImageConversionKernel kernel = FindImageFormatConversionKernel(srcImageDesc.format, dstImageDesc.format, srcImageDesc.dataType))
+        {
+            DoConcurrentRange(
+                std::bind(kernel, srcImageDesc.data, dstImageDesc.data, std::placeholders::_1, std::placeholders::_2),
+                imageSize,
+                threadCount
+            );
+            return;
+        }
+    }
+
     /* Get variant buffer for source and destination images */
     DoConcurrentRange(
         std::bind(
@@ -720,6 +746,58 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     return dstImage;
 }
 
+LLGL_EXPORT bool ConvertImageBufferBands(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    void*                       stagingBuffer,
+    std::size_t                 stagingBufferSize,
+    const ImageBandCallback&    callback,
+    unsigned                    threadCount)
+{
+    if (srcImageDesc.format == dstFormat && srcImageDesc.dataType == dstDataType)
+        return false;
+
+    /* Validate input parameters */
+    ValidateSourceImageDesc(srcImageDesc);
+    ValidateImageConversionParams(srcImageDesc, dstFormat, dstDataType);
+
+    const std::size_t srcRowSize = GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, extent.width);
+    const std::size_t dstRowSize = GetMemoryFootprint(dstFormat, dstDataType, extent.width);
+
+    if (srcImageDesc.dataSize < srcRowSize * extent.height * extent.depth)
+        LLGL_TRAP("cannot convert image buffer in bands with source buffer size (%zu) being too small for image extent", srcImageDesc.dataSize);
+    if (stagingBuffer == nullptr || stagingBufferSize < dstRowSize)
+        LLGL_TRAP("cannot convert image buffer in bands with staging buffer being too small for a single row");
+
+    if (dstRowSize == 0)
+        return true;
+
+    /* Convert each slice in bands of as many rows as fit into the staging buffer */
+    const std::uint32_t maxRowsPerBand = static_cast<std::uint32_t>(std::min<std::size_t>(stagingBufferSize / dstRowSize, extent.height));
+
+    const char* srcData = static_cast<const char*>(srcImageDesc.data);
+
+    for_range(slice, extent.depth)
+    {
+        for (std::uint32_t firstRow = 0; firstRow < extent.height; firstRow += maxRowsPerBand)
+        {
+            const std::uint32_t numRows = std::min(maxRowsPerBand, extent.height - firstRow);
+
+            const SrcImageDescriptor bandSrcDesc{ srcImageDesc.format, srcImageDesc.dataType, srcData, srcRowSize * numRows };
+            const DstImageDescriptor bandDstDesc{ dstFormat, dstDataType, stagingBuffer, dstRowSize * numRows };
+            ConvertImageBuffer(bandSrcDesc, bandDstDesc, threadCount);
+
+            callback(slice, firstRow, numRows, stagingBuffer, bandDstDesc.dataSize);
+
+            srcData += bandSrcDesc.dataSize;
+        }
+    }
+
+    return true;
+}
+
 LLGL_EXPORT ByteBuffer DecompressImageBufferToRGBA8UNorm(
     const SrcImageDescriptor&   srcImageDesc,
     const Extent2D&             extent,
@@ -729,10 +807,17 @@ LLGL_EXPORT ByteBuffer DecompressImageBufferToRGBA8UNorm(
         threadCount = std::thread::hardware_concurrency();
 
     /* Check for BC compression */
-    if (srcImageDesc.format == ImageFormat::BC1)
-        return DecompressBC1ToRGBA8UNorm(extent, reinterpret_cast<const char*>(srcImageDesc.data), srcImageDesc.dataSize, threadCount);
-
-    return nullptr;
+    switch (srcImageDesc.format)
+    {
+        case ImageFormat::BC1:
+        case ImageFormat::BC2:
+        case ImageFormat::BC3:
+        case ImageFormat::BC4:
+        case ImageFormat::BC5:
+            return DecompressBCToRGBA8UNorm(srcImageDesc.format, extent, reinterpret_cast<const char*>(srcImageDesc.data), srcImageDesc.dataSize, threadCount);
+        default:
+            return nullptr;
+    }
 }
 
 // Returns the 1D flattened buffer position for a 3D image coordinate ('bpp' denotes the bytes per pixel)
@@ -0,0 +1,368 @@
+/*
+ * ImageMipChain.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "ImageMipChain.h"
+#include "Threading.h"
+#include "Exception.h"
+#include <LLGL/TextureFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Number of float components per pixel of the intermediate MIP-map levels (RGBA).
+static constexpr std::size_t g_numComponents = 4;
+
+// Radius of the Kaiser filter (in destination pixels) and its shape parameter.
+static constexpr double g_kaiserRadius  = 3.0;
+static constexpr double g_kaiserAlpha   = 4.0;
+
+// Filter tap for a single axis: source pixel index and its weight.
+struct ResampleTap
+{
+    std::uint32_t   index;
+    float           weight;
+};
+
+// Filter taps of all destination pixels along a single axis.
+struct ResampleAxis
+{
+    std::vector<std::uint32_t>  offsets;    // Start of the taps for each destination pixel; has one more entry than there are destination pixels.
+    std::vector<ResampleTap>    taps;
+};
+
+// Zeroth-order modified Bessel function of the first kind.
+static double BesselI0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; ++k)
+    {
+        const double t = x / (2.0 * k);
+        term *= t * t;
+        sum += term;
+        if (term < sum * 1.0e-12)
+            break;
+    }
+    return sum;
+}
+
+// Returns the Kaiser-windowed sinc function for the specified distance (in destination pixels).
+static double KaiserFilter(double x)
+{
+    if (std::abs(x) >= g_kaiserRadius)
+        return 0.0;
+
+    const double pi     = 3.14159265358979323846;
+    const double sinc   = (std::abs(x) < 1.0e-6 ? 1.0 : std::sin(pi * x) / (pi * x));
+    const double t      = x / g_kaiserRadius;
+
+    return sinc * BesselI0(g_kaiserAlpha * std::sqrt(1.0 - t * t)) / BesselI0(g_kaiserAlpha);
+}
+
+// Builds the filter taps to reduce an axis from 'srcSize' to 'dstSize' pixels. Source pixels outside the axis are clamped to the edge.
+static ResampleAxis BuildResampleAxis(std::uint32_t srcSize, std::uint32_t dstSize, MipMapFilter filter)
+{
+    ResampleAxis axis;
+    axis.offsets.reserve(dstSize + 1);
+
+    const double scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+
+    for_range(i, dstSize)
+    {
+        axis.offsets.push_back(static_cast<std::uint32_t>(axis.taps.size()));
+
+        const std::size_t firstTap = axis.taps.size();
+        double weightSum = 0.0;
+
+        auto AddTap = [&](std::int64_t index, double weight)
+        {
+            if (weight != 0.0)
+            {
+                const std::int64_t clampedIndex = std::max<std::int64_t>(0, std::min<std::int64_t>(index, srcSize - 1));
+                axis.taps.push_back(ResampleTap{ static_cast<std::uint32_t>(clampedIndex), static_cast<float>(weight) });
+                weightSum += weight;
+            }
+        };
+
+        if (filter == MipMapFilter::Kaiser)
+        {
+            /* Sample windowed sinc function at source pixel centers */
+            const double center = (i + 0.5) * scale;
+            const double radius = g_kaiserRadius * scale;
+            const std::int64_t first = static_cast<std::int64_t>(std::floor(center - radius));
+            const std::int64_t last  = static_cast<std::int64_t>(std::ceil(center + radius));
+            for (std::int64_t j = first; j <= last; ++j)
+                AddTap(j, KaiserFilter((j + 0.5 - center) / scale));
+        }
+        else
+        {
+            /* Weight source pixels by their coverage of the destination pixel */
+            const double lo = i * scale;
+            const double hi = (i + 1) * scale;
+            const std::int64_t first = static_cast<std::int64_t>(std::floor(lo));
+            const std::int64_t last  = static_cast<std::int64_t>(std::ceil(hi));
+            for (std::int64_t j = first; j < last; ++j)
+                AddTap(j, std::min<double>(static_cast<double>(j + 1), hi) - std::max<double>(static_cast<double>(j), lo));
+        }
+
+        /* Normalize weights */
+        for_subrange(t, firstTap, axis.taps.size())
+            axis.taps[t].weight = static_cast<float>(axis.taps[t].weight / weightSum);
+    }
+
+    axis.offsets.push_back(static_cast<std::uint32_t>(axis.taps.size()));
+
+    return axis;
+}
+
+static std::uint32_t GetExtentComponent(const Extent3D& extent, int axis)
+{
+    return (axis == 0 ? extent.width : axis == 1 ? extent.height : extent.depth);
+}
+
+static void SetExtentComponent(Extent3D& extent, int axis, std::uint32_t value)
+{
+    (axis == 0 ? extent.width : axis == 1 ? extent.height : extent.depth) = value;
+}
+
+// Worker thread procedure to resample the rows in the range [rowBegin, rowEnd) of the destination image along the specified axis.
+static void ResampleAxisRows(
+    const float*        src,
+    const Extent3D&     srcExtent,
+    float*              dst,
+    const Extent3D&     dstExtent,
+    int                 axis,
+    const ResampleAxis& resampleAxis,
+    std::size_t         rowBegin,
+    std::size_t         rowEnd)
+{
+    const std::size_t srcStrides[3] = { 1, srcExtent.width, static_cast<std::size_t>(srcExtent.width) * srcExtent.height };
+
+    for_subrange(row, rowBegin, rowEnd)
+    {
+        const std::size_t y = row % dstExtent.height;
+        const std::size_t z = row / dstExtent.height;
+        float* dstPixel = dst + row * dstExtent.width * g_numComponents;
+
+        for_range(x, static_cast<std::size_t>(dstExtent.width))
+        {
+            /* Get source pixel with the coordinate along the filter axis set to zero */
+            const std::size_t coords[3] = { x, y, z };
+            const std::size_t srcBase   = (coords[0] * srcStrides[0] + coords[1] * srcStrides[1] + coords[2] * srcStrides[2]) - coords[axis] * srcStrides[axis];
+            const std::size_t dstCoord  = coords[axis];
+
+            float color[g_numComponents] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+            for_subrange(t, resampleAxis.offsets[dstCoord], resampleAxis.offsets[dstCoord + 1])
+            {
+                const ResampleTap&  tap         = resampleAxis.taps[t];
+                const float*        srcPixel    = src + (srcBase + tap.index * srcStrides[axis]) * g_numComponents;
+                for_range(c, g_numComponents)
+                    color[c] += srcPixel[c] * tap.weight;
+            }
+
+            std::memcpy(dstPixel, color, sizeof(color));
+            dstPixel += g_numComponents;
+        }
+    }
+}
+
+// Reduces the specified RGBA image to the destination extent with a separable filter; each axis must either be reduced or remain the same.
+static std::vector<float> DownsampleImage(
+    std::vector<float>& src,
+    Extent3D            srcExtent,
+    const Extent3D&     dstExtent,
+    MipMapFilter        filter,
+    unsigned            threadCount)
+{
+    std::vector<float> image = std::move(src);
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const std::uint32_t srcSize = GetExtentComponent(srcExtent, axis);
+        const std::uint32_t dstSize = GetExtentComponent(dstExtent, axis);
+        if (srcSize == dstSize)
+            continue;
+
+        Extent3D passExtent = srcExtent;
+        SetExtentComponent(passExtent, axis, dstSize);
+
+        const ResampleAxis resampleAxis = BuildResampleAxis(srcSize, dstSize, filter);
+        std::vector<float> output(static_cast<std::size_t>(passExtent.width) * passExtent.height * passExtent.depth * g_numComponents);
+
+        const float* srcImage = image.data();
+        float* dstImage = output.data();
+
+        DoConcurrentRange(
+            [&](std::size_t begin, std::size_t end)
+            {
+                ResampleAxisRows(srcImage, srcExtent, dstImage, passExtent, axis, resampleAxis, begin, end);
+            },
+            static_cast<std::size_t>(passExtent.height) * passExtent.depth,
+            threadCount,
+            1
+        );
+
+        image       = std::move(output);
+        srcExtent   = passExtent;
+    }
+
+    return image;
+}
+
+static float SRGBToLinear(float value)
+{
+    return (value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f));
+}
+
+static float LinearToSRGB(float value)
+{
+    return (value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f);
+}
+
+// Returns the number of steps of the normalized range for integer data types, or zero for floating-point types.
+static double GetNormalizedRangeSteps(DataType dataType)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+        case DataType::UInt8:
+            return 255.0;
+        case DataType::Int16:
+        case DataType::UInt16:
+            return 65535.0;
+        case DataType::Int32:
+        case DataType::UInt32:
+            return 4294967295.0;
+        default:
+            return 0.0;
+    }
+}
+
+// Converts the specified linear RGBA level into the output image format and writes it to the destination buffer.
+static void StoreMipLevel(
+    const std::vector<float>&   level,
+    ImageFormat                 format,
+    DataType                    dataType,
+    bool                        isSRGB,
+    char*                       dst,
+    std::size_t                 dstSize,
+    unsigned                    threadCount)
+{
+    std::vector<float> output = level;
+
+    /* Clamp to normalized range for integer data types, since Kaiser filter can overshoot, and round to nearest value since the conversion truncates */
+    const double steps = GetNormalizedRangeSteps(dataType);
+    const float bias = (steps > 0.0 ? static_cast<float>(0.5 / steps) : 0.0f);
+
+    for (std::size_t i = 0; i < output.size(); i += g_numComponents)
+    {
+        for_range(c, g_numComponents)
+        {
+            float value = output[i + c];
+            if (isSRGB && c < 3)
+                value = LinearToSRGB(std::max(0.0f, value));
+            if (steps > 0.0)
+                value = std::max(0.0f, std::min(value + bias, 1.0f));
+            output[i + c] = value;
+        }
+    }
+
+    const SrcImageDescriptor srcImageDesc{ ImageFormat::RGBA, DataType::Float32, output.data(), output.size() * sizeof(float) };
+    const DstImageDescriptor dstImageDesc{ format, dataType, dst, dstSize };
+
+    if (!ConvertImageBuffer(srcImageDesc, dstImageDesc, threadCount))
+        std::memcpy(dst, output.data(), dstSize);
+}
+
+ByteBuffer GenerateImageMipChain(
+    const SrcImageDescriptor&   srcImageDesc,
+    TextureType                 type,
+    const Extent3D&             extent,
+    std::uint32_t               numMipLevels,
+    MipMapFilter                filter,
+    bool                        isSRGB,
+    unsigned                    threadCount)
+{
+    if (IsCompressedFormat(srcImageDesc.format) || IsDepthOrStencilFormat(srcImageDesc.format))
+        LLGL_TRAP("cannot generate MIP-map chain for compressed or depth-stencil image formats");
+
+    /* First MIP-map level must match the extent convention of the texture type, e.g. a Texture1DArray has a depth of 1 */
+    if (GetMipExtent(type, extent, 0) != extent)
+        LLGL_TRAP("cannot generate MIP-map chain with image extent that does not match texture type");
+
+    const std::size_t srcDataSize = GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, static_cast<std::size_t>(extent.width) * extent.height * extent.depth);
+    if (srcImageDesc.data == nullptr || srcImageDesc.dataSize < srcDataSize)
+        LLGL_TRAP("cannot generate MIP-map chain with source image data being too small for image extent");
+
+    /* Determine number of MIP-map levels and size of entire MIP-map chain */
+    const std::uint32_t maxNumMipLevels = NumMipLevels(type, extent);
+    if (numMipLevels == 0 || numMipLevels > maxNumMipLevels)
+        numMipLevels = maxNumMipLevels;
+
+    std::size_t mipChainSize = 0;
+    for_range(mip, numMipLevels)
+    {
+        const Extent3D mipExtent = GetMipExtent(type, extent, mip);
+        mipChainSize += GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, static_cast<std::size_t>(mipExtent.width) * mipExtent.height * mipExtent.depth);
+    }
+
+    ByteBuffer mipChain = AllocateByteBuffer(mipChainSize, UninitializeTag{});
+    char* dst = mipChain.get();
+
+    /* Copy first MIP-map level */
+    std::memcpy(dst, srcImageDesc.data, srcDataSize);
+    dst += srcDataSize;
+
+    if (numMipLevels > 1)
+    {
+        /* Convert source image into linear floating-point RGBA */
+        std::vector<float> level(static_cast<std::size_t>(extent.width) * extent.height * extent.depth * g_numComponents);
+        const DstImageDescriptor levelImageDesc{ ImageFormat::RGBA, DataType::Float32, level.data(), level.size() * sizeof(float) };
+
+        if (!ConvertImageBuffer(SrcImageDescriptor{ srcImageDesc.format, srcImageDesc.dataType, srcImageDesc.data, srcDataSize }, levelImageDesc, threadCount))
+            std::memcpy(level.data(), srcImageDesc.data, srcDataSize);
+
+        if (isSRGB)
+        {
+            for (std::size_t i = 0; i < level.size(); i += g_numComponents)
+            {
+                for_range(c, 3u)
+                    level[i + c] = SRGBToLinear(level[i + c]);
+            }
+        }
+
+        /* Filter each MIP-map level from the previous one */
+        Extent3D levelExtent = extent;
+
+        for_subrange(mip, 1u, numMipLevels)
+        {
+            const Extent3D mipExtent = GetMipExtent(type, extent, mip);
+            level       = DownsampleImage(level, levelExtent, mipExtent, filter, threadCount);
+            levelExtent = mipExtent;
+
+            const std::size_t mipSize = GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, static_cast<std::size_t>(mipExtent.width) * mipExtent.height * mipExtent.depth);
+            StoreMipLevel(level, srcImageDesc.format, srcImageDesc.dataType, isSRGB, dst, mipSize, threadCount);
+            dst += mipSize;
+        }
+    }
+
+    return mipChain;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,45 @@
+/*
+ * ImageMipChain.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_IMAGE_MIP_CHAIN_H
+#define LLGL_IMAGE_MIP_CHAIN_H
+
+
+#include <LLGL/Utils/Image.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+/*
+Generates the MIP-map chain for the specified source image and returns it in a single buffer.
+All MIP-map levels are tightly packed one after another, starting with a copy of the source image as the first level.
+Each level is filtered from the previous one in linear floating-point RGBA, i.e. converted from sRGB first if 'isSRGB' is true.
+*/
+ByteBuffer GenerateImageMipChain(
+    const SrcImageDescriptor&   srcImageDesc,
+    TextureType                 type,
+    const Extent3D&             extent,
+    std::uint32_t               numMipLevels,
+    MipMapFilter                filter,
+    bool                        isSRGB,
+    unsigned                    threadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
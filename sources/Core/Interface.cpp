@@ -53,6 +53,7 @@ LLGL_IMPLEMENT_INTERFACE( RenderTarget,             RenderSystemChild )
 LLGL_IMPLEMENT_INTERFACE( RenderPass,               RenderSystemChild )
 LLGL_IMPLEMENT_INTERFACE( Shader,                   RenderSystemChild )
 LLGL_IMPLEMENT_INTERFACE( SwapChain,                RenderTarget      )
+LLGL_IMPLEMENT_INTERFACE( AccelerationStructure,    Resource          )
 
 
 } // /namespace LLGL
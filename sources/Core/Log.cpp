@@ -9,8 +9,12 @@
 #include "CoreUtils.h"
 #include "StringUtils.h"
 #include "../Renderer/ContainerTypes.h"
+#include <LLGL/Utils/ForRange.h>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <atomic>
+#include <chrono>
 #include <string>
 #include <stdio.h>
 #include <stdarg.h>
@@ -47,11 +51,108 @@ struct LogListener
 
 using LogListenerPtr = std::unique_ptr<LogListener>;
 
+/*
+Bounded lock-free queue for pending reports with multiple producers and a single consumer at a time.
+Each slot has a sequence number that tells producers and the consumer whether it is free or filled for the current lap around the ring.
+*/
+class LogMessageQueue
+{
+
+    public:
+
+        LogMessageQueue()
+        {
+            for_range(i, capacity)
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // Appends the specified report to the queue. Returns false if the queue is full.
+        bool Push(ReportType type, std::string&& text)
+        {
+            std::size_t pos = writePos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Slot& slot = slots_[pos % capacity];
+                const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0)
+                {
+                    /* Slot is free for this lap: claim it and fill it before publishing it to the consumer */
+                    if (writePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        slot.type = type;
+                        slot.text = std::move(text);
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    /* Slot has not been consumed since the previous lap */
+                    return false;
+                }
+                else
+                    pos = writePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Takes the next report from the queue. Returns false if the queue is empty. Must only be called by one thread at a time.
+        bool Pop(ReportType& outType, std::string& outText)
+        {
+            const std::size_t pos = readPos_.load(std::memory_order_relaxed);
+            Slot& slot = slots_[pos % capacity];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+                return false;
+
+            outType = slot.type;
+            outText = std::move(slot.text);
+            slot.text.clear();
+            slot.sequence.store(pos + capacity, std::memory_order_release);
+            readPos_.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Returns true if there are no reports in the queue. This is only a hint while producers are appending reports.
+        bool Empty() const
+        {
+            const std::size_t pos = readPos_.load(std::memory_order_relaxed);
+            return (slots_[pos % capacity].sequence.load(std::memory_order_acquire) != pos + 1);
+        }
+
+    private:
+
+        static constexpr std::size_t capacity = 1024;
+
+        struct Slot
+        {
+            std::atomic<std::size_t>    sequence;
+            ReportType                  type        = ReportType::Default;
+            std::string                 text;
+        };
+
+    private:
+
+        Slot                        slots_[capacity];
+        std::atomic<std::size_t>    writePos_   { 0 };
+        std::atomic<std::size_t>    readPos_    { 0 };
+
+};
+
 struct LogState
 {
+    ~LogState();
+
     std::mutex                              lock;
     UnorderedUniquePtrVector<LogListener>   listeners;
     LogListenerPtr                          listenerStd;
+
+    std::atomic<DispatchMode>               mode            { DispatchMode::Immediate };
+    LogMessageQueue                         queue;
+    std::mutex                              flushLock;      // Only one thread at a time consumes the queue
+    std::mutex                              dispatchLock;   // Guards the dispatch thread and its state
+    std::condition_variable                 dispatchSignal;
+    std::thread                             dispatchThread;
+    bool                                    dispatchStop    = false;
 };
 
 class TrivialLock
@@ -84,7 +185,7 @@ static LogState                 g_logState;
 static thread_local TrivialLock g_logRecursionLock;
 
 
-/* ----- Functions ----- */
+/* ----- Internal functions ----- */
 
 static void PostReport(ReportType type, const char* text)
 {
@@ -97,6 +198,95 @@ static void PostReport(ReportType type, const char* text)
         listener->Invoke(type, text);
 }
 
+// Dispatches all pending reports. The caller must hold the recursion lock of its thread.
+static void FlushPendingReports()
+{
+    std::lock_guard<std::mutex> guard{ g_logState.flushLock };
+    ReportType type = ReportType::Default;
+    std::string text;
+    while (g_logState.queue.Pop(type, text))
+        PostReport(type, text.c_str());
+}
+
+static void DispatchThreadMain()
+{
+    std::lock_guard<TrivialLock> recursionGuard{ g_logRecursionLock };
+    std::unique_lock<std::mutex> lock{ g_logState.dispatchLock };
+    while (!g_logState.dispatchStop)
+    {
+        /* Reporting threads don't hold the lock when they signal, so wake up periodically in case a signal was missed */
+        g_logState.dispatchSignal.wait_for(
+            lock,
+            std::chrono::milliseconds(10),
+            []() -> bool
+            {
+                return (g_logState.dispatchStop || !g_logState.queue.Empty());
+            }
+        );
+        lock.unlock();
+        {
+            FlushPendingReports();
+        }
+        lock.lock();
+    }
+}
+
+static void StartDispatchThread()
+{
+    std::lock_guard<std::mutex> guard{ g_logState.dispatchLock };
+    if (!g_logState.dispatchThread.joinable())
+    {
+        g_logState.dispatchStop     = false;
+        g_logState.dispatchThread   = std::thread{ DispatchThreadMain };
+    }
+}
+
+static void StopDispatchThread()
+{
+    std::thread dispatchThread;
+    {
+        std::lock_guard<std::mutex> guard{ g_logState.dispatchLock };
+        g_logState.dispatchStop = true;
+        dispatchThread = std::move(g_logState.dispatchThread);
+    }
+    g_logState.dispatchSignal.notify_one();
+    if (dispatchThread.joinable())
+        dispatchThread.join();
+}
+
+LogState::~LogState()
+{
+    /* Don't lose pending reports on shutdown */
+    StopDispatchThread();
+    std::lock_guard<TrivialLock> guard{ g_logRecursionLock };
+    FlushPendingReports();
+}
+
+static void SubmitReport(ReportType type, std::string&& text)
+{
+    const DispatchMode mode = g_logState.mode.load(std::memory_order_acquire);
+    if (mode != DispatchMode::Immediate)
+    {
+        /* Append report to queue without blocking; only if the queue is full, flush it on this thread and try again */
+        if (!g_logState.queue.Push(type, std::move(text)))
+        {
+            FlushPendingReports();
+            if (!g_logState.queue.Push(type, std::move(text)))
+            {
+                PostReport(type, text.c_str());
+                return;
+            }
+        }
+        if (mode == DispatchMode::Background)
+            g_logState.dispatchSignal.notify_one();
+    }
+    else
+        PostReport(type, text.c_str());
+}
+
+
+/* ----- Functions ----- */
+
 LLGL_EXPORT void Printf(const char* format, ...)
 {
     if (!g_logRecursionLock)
@@ -104,7 +294,7 @@ LLGL_EXPORT void Printf(const char* format, ...)
         std::lock_guard<TrivialLock> guard{ g_logRecursionLock };
         std::string str;
         LLGL_STRING_PRINTF(str, format);
-        PostReport(ReportType::Default, str.c_str());
+        SubmitReport(ReportType::Default, std::move(str));
     }
 }
 
@@ -115,7 +305,7 @@ LLGL_EXPORT void Errorf(const char* format, ...)
         std::lock_guard<TrivialLock> guard{ g_logRecursionLock };
         std::string str;
         LLGL_STRING_PRINTF(str, format);
-        PostReport(ReportType::Error, str.c_str());
+        SubmitReport(ReportType::Error, std::move(str));
     }
 }
 
@@ -181,6 +371,33 @@ LLGL_EXPORT void UnregisterCallback(LogHandle handle)
     }
 }
 
+LLGL_EXPORT void SetDispatchMode(const DispatchMode mode)
+{
+    if (!g_logRecursionLock)
+    {
+        std::lock_guard<TrivialLock> guard{ g_logRecursionLock };
+        const DispatchMode prevMode = g_logState.mode.exchange(mode, std::memory_order_acq_rel);
+        if (prevMode != mode)
+        {
+            if (prevMode == DispatchMode::Background)
+                StopDispatchThread();
+            if (mode == DispatchMode::Background)
+                StartDispatchThread();
+            else if (mode == DispatchMode::Immediate)
+                FlushPendingReports();
+        }
+    }
+}
+
+LLGL_EXPORT void Flush()
+{
+    if (!g_logRecursionLock)
+    {
+        std::lock_guard<TrivialLock> guard{ g_logRecursionLock };
+        FlushPendingReports();
+    }
+}
+
 
 } // /namespace Log
 
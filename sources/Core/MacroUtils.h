@@ -35,6 +35,8 @@
 #define LLGL_GS_STAGE(FLAGS) ( ((FLAGS) & StageFlags::GeometryStage      ) != 0 )
 #define LLGL_PS_STAGE(FLAGS) ( ((FLAGS) & StageFlags::FragmentStage      ) != 0 )
 #define LLGL_CS_STAGE(FLAGS) ( ((FLAGS) & StageFlags::ComputeStage       ) != 0 )
+#define LLGL_TS_STAGE(FLAGS) ( ((FLAGS) & StageFlags::TaskStage          ) != 0 )
+#define LLGL_MS_STAGE(FLAGS) ( ((FLAGS) & StageFlags::MeshStage          ) != 0 )
 
 
 #endif
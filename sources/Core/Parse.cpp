@@ -12,7 +12,10 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <mutex>
+#include <unordered_map>
 #include "Exception.h"
+#include "CoreUtils.h"
 
 
 namespace LLGL
@@ -412,6 +415,8 @@ static long ParseLayoutSignatureStageFlag(Parser& parser, long& bitmask)
         { StageFlags::GeometryStage,        "geom" },
         { StageFlags::FragmentStage,        "frag" },
         { StageFlags::ComputeStage,         "comp" },
+        { StageFlags::TaskStage,            "task" },
+        { StageFlags::MeshStage,            "mesh" },
     };
 
     /* Parse identifier (find end of alphabetic characters) */
@@ -1437,6 +1442,78 @@ StencilDescriptor ParseContext::AsStencilDesc() const
 }
 
 
+/*
+ * Cached parsing
+ */
+
+// Returns the 64-bit FNV-1a hash of the specified string.
+static std::uint64_t HashSourceString(const StringView& s)
+{
+    return HashFNV1a(s.data(), s.size());
+}
+
+// Process-wide cache of parsed descriptors. Entries are never removed, so references to cached descriptors remain valid.
+template <typename TDesc>
+class ParseCache
+{
+
+    public:
+
+        using ParseFunc = TDesc (ParseContext::*)() const;
+
+    public:
+
+        const TDesc& GetOrParse(const StringView& source, ParseFunc parseFunc)
+        {
+            const std::uint64_t hash = HashSourceString(source);
+
+            std::lock_guard<std::mutex> guard{ lock_ };
+
+            /* Compare full source string to resolve hash collisions */
+            auto range = entries_.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (StringView{ it->second.source } == source)
+                    return it->second.desc;
+            }
+
+            /* Parse descriptor before it is inserted, so nothing is cached if parsing fails */
+            Entry entry;
+            {
+                entry.desc      = (ParseContext{ source }.*parseFunc)();
+                entry.source    = std::string{ source.begin(), source.end() };
+            }
+            return entries_.emplace(hash, std::move(entry))->second.desc;
+        }
+
+    private:
+
+        struct Entry
+        {
+            std::string source;
+            TDesc       desc;
+        };
+
+    private:
+
+        std::mutex                                      lock_;
+        std::unordered_multimap<std::uint64_t, Entry>   entries_;
+
+};
+
+LLGL_EXPORT const PipelineLayoutDescriptor& ParsePipelineLayoutDescCached(const StringView& s)
+{
+    static ParseCache<PipelineLayoutDescriptor> cache;
+    return cache.GetOrParse(s, &ParseContext::AsPipelineLayoutDesc);
+}
+
+LLGL_EXPORT const SamplerDescriptor& ParseSamplerDescCached(const StringView& s)
+{
+    static ParseCache<SamplerDescriptor> cache;
+    return cache.GetOrParse(s, &ParseContext::AsSamplerDesc);
+}
+
+
 } // /namespace LLGL
 
 
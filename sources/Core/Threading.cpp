@@ -6,8 +6,14 @@
  */
 
 #include "Threading.h"
+#include <LLGL/ImageFlags.h>
 #include <LLGL/Utils/ForRange.h>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <deque>
 #include <vector>
 #include <algorithm>
 
@@ -16,6 +22,320 @@ namespace LLGL
 {
 
 
+/*
+ * AsyncTask class
+ */
+
+AsyncTask::AsyncTask(std::function<void()>&& task) :
+    task_ { std::move(task) }
+{
+}
+
+bool AsyncTask::IsDone() const
+{
+    return (state_.load() == StateDone);
+}
+
+void AsyncTask::Wait()
+{
+    /* Run task on this thread if no worker has started it yet */
+    Run();
+    WaitUntilDone();
+    if (exception_)
+        std::rethrow_exception(exception_);
+}
+
+void AsyncTask::Cancel()
+{
+    if (TryLeavePendingState(StateDone))
+        task_ = nullptr;
+    else
+        WaitUntilDone();
+}
+
+void AsyncTask::Run()
+{
+    if (!TryLeavePendingState(StateRunning))
+        return;
+
+    std::exception_ptr exception;
+    try
+    {
+        task_();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    /* Release captured state of the task before waiting threads are notified */
+    task_ = nullptr;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        exception_ = exception;
+        state_.store(StateDone);
+    }
+    doneSignal_.notify_all();
+}
+
+bool AsyncTask::TryLeavePendingState(int state)
+{
+    int expected = StatePending;
+    return state_.compare_exchange_strong(expected, state);
+}
+
+void AsyncTask::WaitUntilDone()
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    doneSignal_.wait(lock, [this]() { return (state_.load() == StateDone); });
+}
+
+
+/*
+Process-wide pool of worker threads for DoConcurrentRange and DoAsync.
+Each job is split into a fixed number of ranges; the calling thread and all idle workers take the next range of the oldest unfinished job,
+so threads that finish early take over the remaining ranges from slower ones. Worker threads are kept alive until the process exits.
+Asynchronous tasks are only taken when no job has ranges left, since the callers of DoConcurrentRange are blocked until their jobs are done.
+*/
+class WorkerThreadPool
+{
+
+    public:
+
+        WorkerThreadPool(const WorkerThreadPool&) = delete;
+        WorkerThreadPool& operator = (const WorkerThreadPool&) = delete;
+
+        ~WorkerThreadPool()
+        {
+            Resize(0);
+        }
+
+        // Returns the instance of this singleton. One worker thread is created for each hardware thread except for the calling thread.
+        static WorkerThreadPool& Get()
+        {
+            static WorkerThreadPool instance;
+            return instance;
+        }
+
+        // Stops all worker threads and launches the specified number of new ones. This must not be called while a job is running.
+        void Resize(unsigned numWorkers)
+        {
+            /* Stop previous worker threads */
+            {
+                std::lock_guard<std::mutex> guard{ queueMutex_ };
+                quit_ = true;
+            }
+            queueSignal_.notify_all();
+
+            for (std::thread& worker : workers_)
+                worker.join();
+
+            workers_.clear();
+            quit_ = false;
+
+            /* Run pending asynchronous tasks on the calling thread if there are no more workers to take them */
+            if (numWorkers == 0)
+            {
+                std::deque<AsyncTaskSPtr> pendingTasks;
+                {
+                    std::lock_guard<std::mutex> guard{ queueMutex_ };
+                    pendingTasks.swap(asyncQueue_);
+                }
+                for (const AsyncTaskSPtr& task : pendingTasks)
+                    task->Run();
+            }
+
+            /* Launch new worker threads */
+            workers_.reserve(numWorkers);
+            for_range(i, numWorkers)
+                workers_.emplace_back(&WorkerThreadPool::WorkerMain, this);
+        }
+
+        // Runs the specified task for 'numRanges' many ranges of [0, count) and blocks until all of them are done.
+        void Run(const std::function<void(std::size_t begin, std::size_t end)>& task, std::size_t count, std::size_t numRanges)
+        {
+            Job job;
+            {
+                job.task        = &task;
+                job.count       = count;
+                job.numRanges   = numRanges;
+            }
+
+            /* Schedule job for idle workers, then take ranges of this job on the calling thread as well */
+            {
+                std::lock_guard<std::mutex> guard{ queueMutex_ };
+                queue_.push_back(&job);
+            }
+            queueSignal_.notify_all();
+
+            while (RunNextRange(job))
+            {
+                // continue
+            }
+
+            /* Wait until all workers that took ranges of this job are done, since the job only lives on this stack frame */
+            {
+                std::unique_lock<std::mutex> lock{ queueMutex_ };
+                auto it = std::find(queue_.begin(), queue_.end(), &job);
+                if (it != queue_.end())
+                    queue_.erase(it);
+                completionSignal_.wait(lock, [&job]() { return (job.numWorkers == 0); });
+            }
+
+            if (job.exception)
+                std::rethrow_exception(job.exception);
+        }
+
+        // Schedules the specified asynchronous task for the next idle worker. Returns false if there are no worker threads.
+        bool Post(const AsyncTaskSPtr& task)
+        {
+            if (workers_.empty())
+                return false;
+            {
+                std::lock_guard<std::mutex> guard{ queueMutex_ };
+                asyncQueue_.push_back(task);
+            }
+            queueSignal_.notify_one();
+            return true;
+        }
+
+    private:
+
+        struct Job
+        {
+            const std::function<void(std::size_t begin, std::size_t end)>* task = nullptr;
+            std::size_t                 count       = 0;
+            std::size_t                 numRanges   = 0;
+            std::atomic<std::size_t>    nextRange   { 0 };
+            unsigned                    numWorkers  = 0;    // Guarded by 'queueMutex_'
+            std::exception_ptr          exception;          // Guarded by 'queueMutex_'
+        };
+
+    private:
+
+        WorkerThreadPool()
+        {
+            const unsigned numThreads = std::thread::hardware_concurrency();
+            Resize(numThreads > 1 ? numThreads - 1 : 0);
+        }
+
+        // Runs the next range of the specified job and returns false if all ranges have already been taken.
+        bool RunNextRange(Job& job)
+        {
+            const std::size_t range = job.nextRange.fetch_add(1);
+            if (range >= job.numRanges)
+                return false;
+
+            try
+            {
+                const std::size_t begin = job.count * range / job.numRanges;
+                const std::size_t end   = job.count * (range + 1) / job.numRanges;
+                (*job.task)(begin, end);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard{ queueMutex_ };
+                if (!job.exception)
+                    job.exception = std::current_exception();
+            }
+
+            return true;
+        }
+
+        /*
+        Waits for the oldest job that still has ranges left or, if there is none, the oldest asynchronous task.
+        Returns false if the pool is about to quit. 'lock' must hold 'queueMutex_'.
+        */
+        bool WaitForNextWork(std::unique_lock<std::mutex>& lock, Job*& outJob, AsyncTaskSPtr& outTask)
+        {
+            for (;;)
+            {
+                if (quit_)
+                    return false;
+
+                /* Drop jobs whose ranges have all been taken; their owners wait for the workers that are still running */
+                while (!queue_.empty() && queue_.front()->nextRange.load() >= queue_.front()->numRanges)
+                    queue_.pop_front();
+
+                if (!queue_.empty())
+                {
+                    outJob = queue_.front();
+                    return true;
+                }
+
+                if (!asyncQueue_.empty())
+                {
+                    outTask = std::move(asyncQueue_.front());
+                    asyncQueue_.pop_front();
+                    return true;
+                }
+
+                queueSignal_.wait(lock);
+            }
+        }
+
+        void WorkerMain()
+        {
+            std::unique_lock<std::mutex> lock{ queueMutex_ };
+            Job*            job = nullptr;
+            AsyncTaskSPtr   task;
+            while (WaitForNextWork(lock, job, task))
+            {
+                if (task)
+                {
+                    /* Run asynchronous task; tasks that have been cancelled or taken by a waiting thread return immediately */
+                    lock.unlock();
+                    {
+                        task->Run();
+                        task.reset();
+                    }
+                    lock.lock();
+                    continue;
+                }
+
+                /* Take ranges from this job until all of them have been taken */
+                ++job->numWorkers;
+                lock.unlock();
+                {
+                    while (RunNextRange(*job))
+                    {
+                        // continue
+                    }
+                }
+                lock.lock();
+
+                /* Notify the owner of the job after the last worker has left it */
+                if (--job->numWorkers == 0)
+                    completionSignal_.notify_all();
+
+                job = nullptr;
+            }
+        }
+
+    private:
+
+        std::vector<std::thread>    workers_;
+
+        std::mutex                  queueMutex_;
+        std::condition_variable     queueSignal_;
+        std::condition_variable     completionSignal_;
+        std::deque<Job*>            queue_;
+        std::deque<AsyncTaskSPtr>   asyncQueue_;
+        bool                        quit_               = false;
+
+};
+
+LLGL_EXPORT void SetWorkerThreadCount(unsigned threadCount)
+{
+    if (threadCount >= Constants::maxThreadCount)
+    {
+        /* Reserve one hardware thread for the caller of DoConcurrentRange */
+        const unsigned numThreads = std::thread::hardware_concurrency();
+        threadCount = (numThreads > 1 ? numThreads - 1 : 0);
+    }
+    WorkerThreadPool::Get().Resize(threadCount);
+}
+
 LLGL_EXPORT void DoConcurrentRange(
     const std::function<void(std::size_t begin, std::size_t end)>&  task,
     std::size_t                                                     count,
@@ -29,27 +349,8 @@ LLGL_EXPORT void DoConcurrentRange(
 
     if (threadCount > 1)
     {
-        /* Launch worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        const std::size_t workSize          = count / threadCount;
-        const std::size_t workSizeRemain    = count % threadCount;
-
-        std::size_t offset = 0;
-
-        for_range(i, threadCount)
-        {
-            workers[i] = std::thread(task, offset, offset + workSize);
-            offset += workSize;
-        }
-
-        /* Execute task of remaining work on main thread */
-        if (workSizeRemain > 0)
-            task(offset, offset + workSizeRemain);
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
+        /* Split work into one range per thread and share them with the worker thread pool */
+        WorkerThreadPool::Get().Run(task, count, threadCount);
     }
     else
     {
@@ -58,6 +359,14 @@ LLGL_EXPORT void DoConcurrentRange(
     }
 }
 
+LLGL_EXPORT AsyncTaskSPtr DoAsync(std::function<void()>&& task)
+{
+    auto asyncTask = std::make_shared<AsyncTask>(std::move(task));
+    if (!WorkerThreadPool::Get().Post(asyncTask))
+        asyncTask->Run();
+    return asyncTask;
+}
+
 LLGL_EXPORT void DoConcurrent(
     const std::function<void(std::size_t index)>&   task,
     std::size_t                                     count,
@@ -12,6 +12,11 @@
 #include <LLGL/Export.h>
 #include <LLGL/Constants.h>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
 #include <cstddef>
 
 
@@ -33,6 +38,69 @@ LLGL_EXPORT void DoConcurrent(
     unsigned                                        threadMinWorkSize   = 64
 );
 
+/*
+Task that is run asynchronously by the worker thread pool (see DoAsync).
+Waiting for a task that has not been started by any worker yet runs it on the waiting thread instead,
+so waiting never depends on the number of idle workers.
+*/
+class LLGL_EXPORT AsyncTask
+{
+
+    public:
+
+        AsyncTask(const AsyncTask&) = delete;
+        AsyncTask& operator = (const AsyncTask&) = delete;
+
+        AsyncTask(std::function<void()>&& task);
+
+        // Returns true if this task has finished or was cancelled. This never blocks.
+        bool IsDone() const;
+
+        // Blocks until this task has finished and rethrows any exception that was thrown by the task.
+        void Wait();
+
+        // Cancels this task if it has not been started yet or blocks until it has finished otherwise. Exceptions of the task are discarded.
+        void Cancel();
+
+        // Runs this task on the calling thread unless it has already been started or cancelled. This is used by the worker thread pool.
+        void Run();
+
+    private:
+
+        enum State
+        {
+            StatePending = 0,
+            StateRunning,
+            StateDone,
+        };
+
+    private:
+
+        // Transitions this task from pending to the specified state and returns false if it has already left the pending state.
+        bool TryLeavePendingState(int state);
+
+        // Blocks until this task has reached the done state.
+        void WaitUntilDone();
+
+    private:
+
+        std::function<void()>   task_;
+        std::atomic<int>        state_      { StatePending };
+        std::mutex              mutex_;
+        std::condition_variable doneSignal_;
+        std::exception_ptr      exception_;
+
+};
+
+using AsyncTaskSPtr = std::shared_ptr<AsyncTask>;
+
+/*
+Schedules the specified task to be run asynchronously by the worker thread pool and returns immediately.
+Asynchronous tasks are only taken by idle workers after all ranges of the jobs from DoConcurrentRange have been taken.
+If there are no worker threads (see SetWorkerThreadCount), the task is run on the calling thread before this function returns.
+*/
+LLGL_EXPORT AsyncTaskSPtr DoAsync(std::function<void()>&& task);
+
 
 } // /namespace LLGL
 
@@ -25,6 +25,8 @@ LLGL_EXPORT const char* ToString(const ShaderType t)
         case T::Geometry:       return "geometry";
         case T::Fragment:       return "fragment";
         case T::Compute:        return "compute";
+        case T::Task:           return "task";
+        case T::Mesh:           return "mesh";
     }
 
     return nullptr;
@@ -55,6 +57,7 @@ LLGL_EXPORT const char* ToString(const WarningType t)
         case T::ImproperState:      return "improper state";
         case T::PointlessOperation: return "pointless operation";
         case T::VaryingBehavior:    return "varying behavior";
+        case T::PerformanceIssue:   return "performance issue";
     }
 
     return nullptr;
@@ -254,10 +257,11 @@ LLGL_EXPORT const char* ToString(const ResourceType t)
     using T = ResourceType;
     switch (t)
     {
-        case T::Undefined:  return "undefined";
-        case T::Buffer:     return "buffer";
-        case T::Texture:    return "texture";
-        case T::Sampler:    return "sampler";
+        case T::Undefined:              return "undefined";
+        case T::Buffer:                 return "buffer";
+        case T::Texture:                return "texture";
+        case T::Sampler:                return "sampler";
+        case T::AccelerationStructure:  return "acceleration structure";
     }
     return nullptr;
 }
@@ -6,6 +6,7 @@
  */
 
 #include "Vendor.h"
+#include <string.h>
 
 
 namespace LLGL
@@ -29,6 +30,41 @@ LLGL_EXPORT DeviceVendor GetVendorByID(std::uint16_t id)
     }
 }
 
+LLGL_EXPORT DeviceVendor GetVendorByName(const char* name)
+{
+    if (name == nullptr)
+        return DeviceVendor::Undefined;
+
+    /* Compare with the vendor names of GetVendorName() and the common GL_VENDOR strings, e.g. "ATI Technologies Inc." and "VMware, Inc." */
+    struct VendorNamePair
+    {
+        const char*     name;
+        DeviceVendor    vendor;
+    };
+
+    static const VendorNamePair vendorNamePairs[] =
+    {
+        { "Apple",                  DeviceVendor::Apple     },
+        { "AMD",                    DeviceVendor::AMD       },
+        { "ATI",                    DeviceVendor::AMD       },
+        { "Advanced Micro Devices", DeviceVendor::AMD       },
+        { "Intel",                  DeviceVendor::Intel     },
+        { "Matrox",                 DeviceVendor::Matrox    },
+        { "Microsoft",              DeviceVendor::Microsoft },
+        { "NVIDIA",                 DeviceVendor::NVIDIA    },
+        { "Oracle",                 DeviceVendor::Oracle    },
+        { "VMware",                 DeviceVendor::VMware    },
+    };
+
+    for (const VendorNamePair& pair : vendorNamePairs)
+    {
+        if (::strncmp(name, pair.name, ::strlen(pair.name)) == 0)
+            return pair.vendor;
+    }
+
+    return DeviceVendor::Undefined;
+}
+
 LLGL_EXPORT const char* GetVendorName(DeviceVendor vendor)
 {
     switch (vendor)
@@ -36,6 +36,9 @@ enum class DeviceVendor
 // Returns the device vendor by the specified ID number.
 LLGL_EXPORT DeviceVendor GetVendorByID(std::uint16_t id);
 
+// Returns the device vendor by the specified name, e.g. from GL_VENDOR or VideoAdapterDescriptor::vendor. Returns DeviceVendor::Undefined if the name is unknown.
+LLGL_EXPORT DeviceVendor GetVendorByName(const char* name);
+
 // Returns the name of the hardware vendor by the specified ID number.
 LLGL_EXPORT const char* GetVendorName(DeviceVendor vendor);
 
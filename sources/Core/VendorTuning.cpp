@@ -0,0 +1,73 @@
+/*
+ * VendorTuning.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VendorTuning.h"
+
+
+namespace LLGL
+{
+
+
+/*
+These values are starting points for each vendor and are meant to be refined with the benchmark suites on the respective hardware.
+Only members that deviate from the default profile are listed here.
+*/
+LLGL_EXPORT VendorTuningProfile GetVendorTuningProfile(DeviceVendor vendor)
+{
+    VendorTuningProfile profile;
+
+    switch (vendor)
+    {
+        case DeviceVendor::NVIDIA:
+            /* Larger staging chunks for fewer map/unmap calls; events don't overlap more work than pipeline barriers on these drivers */
+            profile.stagingChunkSize        = 1024 * 1024;
+            profile.descriptorPoolCapacity  = 64;
+            profile.splitBarriers           = false;
+            break;
+
+        case DeviceVendor::AMD:
+            /* Split barriers let the GPU overlap the cache flushes with independent work */
+            profile.descriptorPoolCapacity  = 64;
+            break;
+
+        case DeviceVendor::Intel:
+            /* Integrated GPUs share system memory, so smaller staging chunks reduce the footprint without extra copies */
+            profile.stagingChunkSize        = 128 * 1024;
+            profile.splitBarriers           = false;
+            break;
+
+        case DeviceVendor::Microsoft:
+        case DeviceVendor::Oracle:
+        case DeviceVendor::VMware:
+            /* Software rasterizers and virtual GPUs where events and persistently mapped memory are emulated by the host */
+            profile.splitBarriers           = false;
+            profile.mappedBufferUpdates     = false;
+            break;
+
+        default:
+            break;
+    }
+
+    return profile;
+}
+
+LLGL_EXPORT bool GetTuningOverride(TuningOverride override, bool profileValue)
+{
+    switch (override)
+    {
+        case TuningOverride::Enabled:   return true;
+        case TuningOverride::Disabled:  return false;
+        default:                        return profileValue;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,62 @@
+/*
+ * VendorTuning.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VENDOR_TUNING_H
+#define LLGL_VENDOR_TUNING_H
+
+
+#include "Vendor.h"
+#include <LLGL/RendererConfiguration.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Backend parameters that are selected by the GPU vendor when a render system is created.
+Each backend only consults the members that apply to it and each member can be overridden by the respective RendererConfiguration* structure.
+*/
+struct VendorTuningProfile
+{
+    // Chunk size (in bytes) of staging buffers for buffer updates. Zero to keep the default of the backend.
+    std::uint64_t   stagingChunkSize        = 0;
+
+    // Minimal number of descriptor sets and descriptors per type of each staging descriptor pool.
+    std::uint32_t   descriptorPoolCapacity  = 16;
+
+    // Specifies whether resource barriers can be split into a begin and end barrier, e.g. with Vulkan events.
+    bool            splitBarriers           = true;
+
+    // Specifies whether buffer updates are written into persistently mapped memory instead of being passed to the driver, e.g. glBufferSubData.
+    bool            mappedBufferUpdates     = true;
+};
+
+
+// Returns the tuning profile for the specified GPU vendor. Unknown vendors get the default profile.
+LLGL_EXPORT VendorTuningProfile GetVendorTuningProfile(DeviceVendor vendor);
+
+// Returns the value of the specified override, or the value of the tuning profile for TuningOverride::Default.
+LLGL_EXPORT bool GetTuningOverride(TuningOverride override, bool profileValue);
+
+// Returns the specified size if it is non-zero, or the value of the tuning profile otherwise.
+template <typename T>
+T GetTuningSize(std::uint64_t size, T profileValue)
+{
+    return (size > 0 ? static_cast<T>(size) : profileValue);
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
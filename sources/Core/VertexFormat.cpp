@@ -0,0 +1,325 @@
+/*
+ * VertexFormat.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/VertexFormat.h>
+#include "Float16Compressor.h"
+#include <cmath>
+#include <cstring>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_VERTEX_KERNELS_SSE2
+#   include <emmintrin.h>
+#elif defined __aarch64__ || defined _M_ARM64
+#   define LLGL_VERTEX_KERNELS_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+The SIMD kernels below only use instruction sets that are part of the target's baseline (SSE2 on x86-64, NEON on ARM64), so no runtime dispatch is required.
+Source and destination vertices can be interleaved with other attributes, so all components are loaded and stored individually.
+*/
+
+static const float* GetSrcVertex(const float* src, std::size_t srcStride, std::size_t i)
+{
+    return reinterpret_cast<const float*>(reinterpret_cast<const char*>(src) + i * srcStride);
+}
+
+static char* GetDstVertex(void* dst, std::size_t dstStride, std::size_t i)
+{
+    return static_cast<char*>(dst) + i * dstStride;
+}
+
+// Converts the specified value from [-1, 1] into a signed normalized integer with the specified maximum, e.g. 32767 for 16-bit.
+static int FloatToSNorm(float value, float maxValue)
+{
+    const float clamped = (value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value));
+    return static_cast<int>(std::lround(clamped * maxValue));
+}
+
+static void StoreSNorm16x2(char* dst, int x, int y)
+{
+    const std::int16_t components[2] = { static_cast<std::int16_t>(x), static_cast<std::int16_t>(y) };
+    ::memcpy(dst, components, sizeof(components));
+}
+
+static void StoreSNorm8x4(char* dst, int x, int y)
+{
+    const std::int8_t components[4] = { static_cast<std::int8_t>(x), static_cast<std::int8_t>(y), 0, 0 };
+    ::memcpy(dst, components, sizeof(components));
+}
+
+
+/* ----- Positions ----- */
+
+static void ComputePositionBounds(const float* src, std::size_t srcStride, std::size_t numVertices, float outMin[3], float outMax[3])
+{
+    for (int c = 0; c < 3; ++c)
+    {
+        outMin[c] = src[c];
+        outMax[c] = src[c];
+    }
+
+    for (std::size_t i = 1; i < numVertices; ++i)
+    {
+        const float* pos = GetSrcVertex(src, srcStride, i);
+        for (int c = 0; c < 3; ++c)
+        {
+            outMin[c] = (std::min)(outMin[c], pos[c]);
+            outMax[c] = (std::max)(outMax[c], pos[c]);
+        }
+    }
+}
+
+LLGL_EXPORT Format QuantizePositionsSNorm16(
+    void*                       dst,
+    std::size_t                 dstStride,
+    const float*                src,
+    std::size_t                 srcStride,
+    std::size_t                 numVertices,
+    VertexQuantizationBounds&   outBounds)
+{
+    if (numVertices == 0)
+    {
+        outBounds = VertexQuantizationBounds{};
+        return Format::RGBA16SNorm;
+    }
+
+    /* Determine bounding box, so the quantized positions use the full range of 16-bit integers */
+    float minPos[3], maxPos[3];
+    ComputePositionBounds(src, srcStride, numVertices, minPos, maxPos);
+
+    constexpr float minExtent = 1.0e-6f;
+
+    float invScale[3];
+    for (int c = 0; c < 3; ++c)
+    {
+        outBounds.bias[c]   = (minPos[c] + maxPos[c]) * 0.5f;
+        outBounds.scale[c]  = (std::max)((maxPos[c] - minPos[c]) * 0.5f, minExtent);
+        invScale[c]         = 1.0f / outBounds.scale[c];
+    }
+
+    std::size_t i = 0;
+
+    #if defined LLGL_VERTEX_KERNELS_SSE2
+
+    /* Fourth component is mapped to 1.0 by multiplying 1.0 with 1.0 */
+    const __m128 bias       = _mm_setr_ps(outBounds.bias[0], outBounds.bias[1], outBounds.bias[2], 0.0f);
+    const __m128 scale      = _mm_setr_ps(invScale[0], invScale[1], invScale[2], 1.0f);
+    const __m128 minValue   = _mm_set1_ps(-1.0f);
+    const __m128 maxValue   = _mm_set1_ps(1.0f);
+    const __m128 snormMax   = _mm_set1_ps(32767.0f);
+
+    for (; i < numVertices; ++i)
+    {
+        const float* pos = GetSrcVertex(src, srcStride, i);
+        const __m128 p = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(pos[0], pos[1], pos[2], 1.0f), bias), scale);
+        const __m128i q = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(p, minValue), maxValue), snormMax));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(GetDstVertex(dst, dstStride, i)), _mm_packs_epi32(q, q));
+    }
+
+    #elif defined LLGL_VERTEX_KERNELS_NEON
+
+    const float biasValues[4]   = { outBounds.bias[0], outBounds.bias[1], outBounds.bias[2], 0.0f };
+    const float scaleValues[4]  = { invScale[0], invScale[1], invScale[2], 1.0f };
+    const float32x4_t bias      = vld1q_f32(biasValues);
+    const float32x4_t scale     = vld1q_f32(scaleValues);
+
+    for (; i < numVertices; ++i)
+    {
+        const float* pos = GetSrcVertex(src, srcStride, i);
+        const float posValues[4] = { pos[0], pos[1], pos[2], 1.0f };
+        float32x4_t p = vmulq_f32(vsubq_f32(vld1q_f32(posValues), bias), scale);
+        p = vminq_f32(vmaxq_f32(p, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+        const int16x4_t q = vqmovn_s32(vcvtnq_s32_f32(vmulq_n_f32(p, 32767.0f)));
+        vst1_u8(reinterpret_cast<std::uint8_t*>(GetDstVertex(dst, dstStride, i)), vreinterpret_u8_s16(q));
+    }
+
+    #endif
+
+    for (; i < numVertices; ++i)
+    {
+        const float* pos = GetSrcVertex(src, srcStride, i);
+        const std::int16_t components[4] =
+        {
+            static_cast<std::int16_t>(FloatToSNorm((pos[0] - outBounds.bias[0]) * invScale[0], 32767.0f)),
+            static_cast<std::int16_t>(FloatToSNorm((pos[1] - outBounds.bias[1]) * invScale[1], 32767.0f)),
+            static_cast<std::int16_t>(FloatToSNorm((pos[2] - outBounds.bias[2]) * invScale[2], 32767.0f)),
+            32767,
+        };
+        ::memcpy(GetDstVertex(dst, dstStride, i), components, sizeof(components));
+    }
+
+    return Format::RGBA16SNorm;
+}
+
+
+/* ----- Normals ----- */
+
+// Encodes the specified vector with octahedral mapping into the range [-1, 1].
+static void EncodeOctahedral(const float* n, float& outX, float& outY)
+{
+    const float invL1Norm = 1.0f / (std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]));
+    const float x = n[0] * invL1Norm;
+    const float y = n[1] * invL1Norm;
+    if (n[2] < 0.0f)
+    {
+        /* Fold lower hemisphere over the diagonals */
+        outX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        outY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    }
+    else
+    {
+        outX = x;
+        outY = y;
+    }
+}
+
+LLGL_EXPORT Format EncodeNormalsOctahedral(
+    void*           dst,
+    std::size_t     dstStride,
+    const float*    src,
+    std::size_t     srcStride,
+    std::size_t     numVertices,
+    Format          format)
+{
+    if (format != Format::RG16SNorm && format != Format::RGBA8SNorm)
+        return Format::Undefined;
+
+    const bool  isSNorm16   = (format == Format::RG16SNorm);
+    const float snormMax    = (isSNorm16 ? 32767.0f : 127.0f);
+
+    std::size_t i = 0;
+
+    #if defined LLGL_VERTEX_KERNELS_SSE2 || defined LLGL_VERTEX_KERNELS_NEON
+
+    /* Encode four vectors at a time in structure-of-arrays layout */
+    for (; i + 4 <= numVertices; i += 4)
+    {
+        float vx[4], vy[4], vz[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            const float* n = GetSrcVertex(src, srcStride, i + j);
+            vx[j] = n[0];
+            vy[j] = n[1];
+            vz[j] = n[2];
+        }
+
+        std::int32_t qx[4], qy[4];
+
+        #if defined LLGL_VERTEX_KERNELS_SSE2
+
+        const __m128 signMask   = _mm_set1_ps(-0.0f);
+        const __m128 one        = _mm_set1_ps(1.0f);
+
+        const __m128 nx         = _mm_loadu_ps(vx);
+        const __m128 ny         = _mm_loadu_ps(vy);
+        const __m128 nz         = _mm_loadu_ps(vz);
+        const __m128 l1Norm     = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, nx), _mm_andnot_ps(signMask, ny)), _mm_andnot_ps(signMask, nz));
+        const __m128 x          = _mm_div_ps(nx, l1Norm);
+        const __m128 y          = _mm_div_ps(ny, l1Norm);
+
+        /* Fold lower hemisphere over the diagonals; sign(0) is treated as +1 */
+        const __m128 signX      = _mm_or_ps(_mm_and_ps(x, signMask), one);
+        const __m128 signY      = _mm_or_ps(_mm_and_ps(y, signMask), one);
+        const __m128 foldedX    = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, y)), signX);
+        const __m128 foldedY    = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, x)), signY);
+        const __m128 lower      = _mm_cmplt_ps(nz, _mm_setzero_ps());
+        const __m128 ex         = _mm_or_ps(_mm_and_ps(lower, foldedX), _mm_andnot_ps(lower, x));
+        const __m128 ey         = _mm_or_ps(_mm_and_ps(lower, foldedY), _mm_andnot_ps(lower, y));
+
+        const __m128 scale      = _mm_set1_ps(snormMax);
+        const __m128 minValue   = _mm_set1_ps(-1.0f);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(qx), _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(ex, minValue), one), scale)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(qy), _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(ey, minValue), one), scale)));
+
+        #else
+
+        const float32x4_t one       = vdupq_n_f32(1.0f);
+
+        const float32x4_t nx        = vld1q_f32(vx);
+        const float32x4_t ny        = vld1q_f32(vy);
+        const float32x4_t nz        = vld1q_f32(vz);
+        const float32x4_t l1Norm    = vaddq_f32(vaddq_f32(vabsq_f32(nx), vabsq_f32(ny)), vabsq_f32(nz));
+        const float32x4_t x         = vdivq_f32(nx, l1Norm);
+        const float32x4_t y         = vdivq_f32(ny, l1Norm);
+
+        /* Fold lower hemisphere over the diagonals; sign(0) is treated as +1 */
+        const float32x4_t foldedX   = vbslq_f32(vdupq_n_u32(0x80000000u), x, vsubq_f32(one, vabsq_f32(y)));
+        const float32x4_t foldedY   = vbslq_f32(vdupq_n_u32(0x80000000u), y, vsubq_f32(one, vabsq_f32(x)));
+        const uint32x4_t  lower     = vcltq_f32(nz, vdupq_n_f32(0.0f));
+        const float32x4_t ex        = vbslq_f32(lower, foldedX, x);
+        const float32x4_t ey        = vbslq_f32(lower, foldedY, y);
+
+        vst1q_s32(qx, vcvtnq_s32_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(ex, vdupq_n_f32(-1.0f)), one), snormMax)));
+        vst1q_s32(qy, vcvtnq_s32_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(ey, vdupq_n_f32(-1.0f)), one), snormMax)));
+
+        #endif
+
+        for (int j = 0; j < 4; ++j)
+        {
+            char* dstVertex = GetDstVertex(dst, dstStride, i + j);
+            if (isSNorm16)
+                StoreSNorm16x2(dstVertex, qx[j], qy[j]);
+            else
+                StoreSNorm8x4(dstVertex, qx[j], qy[j]);
+        }
+    }
+
+    #endif
+
+    for (; i < numVertices; ++i)
+    {
+        float x, y;
+        EncodeOctahedral(GetSrcVertex(src, srcStride, i), x, y);
+        char* dstVertex = GetDstVertex(dst, dstStride, i);
+        if (isSNorm16)
+            StoreSNorm16x2(dstVertex, FloatToSNorm(x, snormMax), FloatToSNorm(y, snormMax));
+        else
+            StoreSNorm8x4(dstVertex, FloatToSNorm(x, snormMax), FloatToSNorm(y, snormMax));
+    }
+
+    return format;
+}
+
+
+/* ----- Texture coordinates ----- */
+
+LLGL_EXPORT Format CompressTexCoordsFloat16(
+    void*           dst,
+    std::size_t     dstStride,
+    const float*    src,
+    std::size_t     srcStride,
+    std::size_t     numVertices)
+{
+    if (srcStride == sizeof(float)*2 && dstStride == sizeof(std::uint16_t)*2)
+    {
+        /* Convert tightly packed arrays in one batch */
+        CompressFloat16Array(static_cast<std::uint16_t*>(dst), src, numVertices * 2);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < numVertices; ++i)
+        {
+            const float* texCoord = GetSrcVertex(src, srcStride, i);
+            const std::uint16_t components[2] = { CompressFloat16(texCoord[0]), CompressFloat16(texCoord[1]) };
+            ::memcpy(GetDstVertex(dst, dstStride, i), components, sizeof(components));
+        }
+    }
+    return Format::RG16Float;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
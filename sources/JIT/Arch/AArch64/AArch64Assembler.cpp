@@ -0,0 +1,488 @@
+/*
+ * AArch64Assembler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "AArch64Assembler.h"
+#include "AArch64Opcode.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+/*
+ * Internal members
+ */
+
+/*
+List of registers that are used for the first couple of arguments.
+see https://github.com/ARM-software/abi-aa/blob/main/aapcs64/aapcs64.rst
+Preserved for caller: X19-X29, V8-V15 (lower 64 bits)
+*/
+static const Reg g_aarch64IntParams[] = { Reg::X0, Reg::X1, Reg::X2, Reg::X3, Reg::X4, Reg::X5, Reg::X6, Reg::X7 };
+static const Reg g_aarch64FltParams[] = { Reg::V0, Reg::V1, Reg::V2, Reg::V3, Reg::V4, Reg::V5, Reg::V6, Reg::V7 };
+
+// Intra-procedure-call scratch registers that are never used for parameters.
+static const Reg g_aarch64CallReg       = Reg::X16;
+static const Reg g_aarch64TempReg       = Reg::X17;
+static const Reg g_aarch64TempFltReg    = Reg::V16;
+
+static const std::size_t g_aarch64IntParamsCount = sizeof(g_aarch64IntParams)/sizeof(g_aarch64IntParams[0]);
+static const std::size_t g_aarch64FltParamsCount = sizeof(g_aarch64FltParams)/sizeof(g_aarch64FltParams[0]);
+
+
+/*
+ * Internal functions
+ */
+
+// Size of byte (1), word (2), dword (4), qword (8), ptr (8), stack-ptr (8), float (4), double (8)
+static std::uint8_t GetArgSize(const ArgType t)
+{
+    static const std::uint8_t sizes[] = { 1, 2, 4, 8, 8, 8, 4, 8 };
+    return sizes[static_cast<std::uint8_t>(t)];
+}
+
+// Returns the specified size aligned to the stack alignment of 16 bytes, which is mandatory for SP on AArch64.
+static std::uint32_t AlignStackSize(std::uint32_t size)
+{
+    return ((size + 15u) & ~15u);
+}
+
+// Size of a stack argument in the outgoing parameter area.
+static std::uint8_t GetStackArgSize(const ArgType t)
+{
+    #ifdef __APPLE__
+    /* Apple's ARM64 ABI packs stack arguments with their natural size and alignment */
+    return GetArgSize(t);
+    #else
+    /* AAPCS64 rounds each stack argument up to 8 bytes */
+    (void)t;
+    return 8;
+    #endif
+}
+
+
+/*
+ * AArch64Assembler class
+ */
+
+void AArch64Assembler::Begin()
+{
+    /* Reset data about local stack */
+    localStackSize_ = 0;
+    varArgDisp_.clear();
+    stackChunkOffsets_.clear();
+
+    /* Write entry point prologue */
+    WritePrologue();
+    WriteStackFrame(GetEntryVarArgs(), GetStackAllocs());
+}
+
+void AArch64Assembler::End()
+{
+    /* Write entry point epilogue, which also pops the local stack */
+    WriteEpilogue();
+}
+
+void AArch64Assembler::WriteFuncCall(const void* addr, JITCallConv /*conv*/, bool /*farCall*/)
+{
+    const auto& args = GetArgs();
+    const std::size_t num = args.size();
+
+    /* Assign parameter registers to the first couple of arguments and stack offsets to the remaining ones */
+    std::vector<Reg>            argRegs(num, g_aarch64TempReg);
+    std::vector<std::uint32_t>  argStackOffsets(num, 0);
+    std::vector<bool>           argOnStack(num, false);
+
+    std::size_t     numIntRegs  = 0, numFltRegs = 0;
+    std::uint32_t   stackSize   = 0;
+
+    for (std::size_t i = 0; i < num; ++i)
+    {
+        const auto& arg = args[i];
+        bool isFloat = IsFloat(arg.type);
+
+        if (isFloat && numFltRegs < g_aarch64FltParamsCount)
+            argRegs[i] = g_aarch64FltParams[numFltRegs++];
+        else if (!isFloat && numIntRegs < g_aarch64IntParamsCount)
+            argRegs[i] = g_aarch64IntParams[numIntRegs++];
+        else
+        {
+            /* Determine offset within outgoing parameter area (next stacked argument address) */
+            const std::uint32_t size = GetStackArgSize(arg.type);
+            stackSize = (stackSize + size - 1u) & ~(size - 1u);
+            argStackOffsets[i]  = stackSize;
+            argOnStack[i]       = true;
+            stackSize += size;
+        }
+    }
+
+    /* Allocate outgoing parameter area and store remaining arguments */
+    stackSize = AlignStackSize(stackSize);
+    if (stackSize > 0)
+    {
+        SubImm(Reg::SP, Reg::SP, stackSize);
+        for (std::size_t i = 0; i < num; ++i)
+        {
+            if (argOnStack[i])
+                StoreArgToStack(args[i], argStackOffsets[i]);
+        }
+    }
+
+    /* Move first couple of arguments into registers */
+    for (std::size_t i = 0; i < num; ++i)
+    {
+        if (!argOnStack[i])
+            MovArgToReg(argRegs[i], args[i]);
+    }
+
+    /* Write 'blr' instruction */
+    MovRegImm64(g_aarch64CallReg, reinterpret_cast<std::uint64_t>(addr));
+    BranchLinkReg(g_aarch64CallReg);
+
+    /* Release outgoing parameter area */
+    if (stackSize > 0)
+        AddImm(Reg::SP, Reg::SP, stackSize);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool AArch64Assembler::IsLittleEndian() const
+{
+    #ifdef __AARCH64EB__
+    return false;
+    #else
+    return true;
+    #endif
+}
+
+void AArch64Assembler::WritePrologue()
+{
+    /* Store frame pointer (X29) and link register (X30), and set up new frame pointer */
+    WriteInstr(Opcode_StpPreFPLR);
+    MovReg(Reg::X29, Reg::SP);
+}
+
+void AArch64Assembler::WriteEpilogue()
+{
+    /* Pop local stack, restore frame pointer (X29) and link register (X30) */
+    MovReg(Reg::SP, Reg::X29);
+    WriteInstr(Opcode_LdpPostFPLR);
+    Ret();
+}
+
+void AArch64Assembler::WriteStackFrame(
+    const std::vector<JIT::ArgType>&    varArgTypes,
+    const std::vector<std::uint32_t>&   stackChunks)
+{
+    /* Determine frame pointer offsets of stack allocations below the variadic arguments */
+    std::uint32_t frameOffset = static_cast<std::uint32_t>(varArgTypes.size()) * 8;
+
+    stackChunkOffsets_.reserve(stackChunks.size());
+    for (auto chunk : stackChunks)
+    {
+        frameOffset += AlignStackSize(chunk);
+        stackChunkOffsets_.push_back(frameOffset);
+    }
+
+    /* Allocate local stack */
+    localStackSize_ = AlignStackSize(frameOffset);
+    if (localStackSize_ > 0)
+        SubImm(Reg::SP, Reg::SP, localStackSize_);
+
+    /* Store parameters in local stack */
+    std::size_t numIntRegs = 0, numFltRegs = 0;
+    std::int32_t paramStackOffset = 16; // first stack parameter at [X29+16]
+    std::int32_t localStackOffset = 0;
+
+    for (auto type : varArgTypes)
+    {
+        bool isFloat = IsFloat(type);
+        Reg srcReg = (isFloat ? g_aarch64TempFltReg : g_aarch64TempReg);
+
+        #ifndef __APPLE__
+        if (isFloat && numFltRegs < g_aarch64FltParamsCount)
+        {
+            /* Get parameter from floating-point register */
+            srcReg = g_aarch64FltParams[numFltRegs++];
+        }
+        else if (!isFloat && numIntRegs < g_aarch64IntParamsCount)
+        {
+            /* Get parameter from integer register */
+            srcReg = g_aarch64IntParams[numIntRegs++];
+        }
+        else
+        #endif // /__APPLE__
+        {
+            /* Load parameter from stack; Apple's ARM64 ABI passes all variadic arguments on the stack */
+            LoadRegMem(srcReg, Reg::X29, paramStackOffset);
+            paramStackOffset += 8;
+        }
+
+        /* Variadic floating-point arguments are promoted to double */
+        if (type == ArgType::Float)
+            FCvtSD(srcReg, srcReg);
+
+        /* Store parameter in local stack */
+        localStackOffset -= 8;
+        StoreMemReg(Reg::X29, srcReg, localStackOffset);
+
+        /* Store parameter offset within stack frame */
+        varArgDisp_.push_back(localStackOffset);
+    }
+
+    (void)numIntRegs;
+    (void)numFltRegs;
+}
+
+void AArch64Assembler::MovArgToReg(Reg dstReg, const Arg& arg)
+{
+    if (arg.param < 0xF)
+    {
+        /* Move parameter from local stack into destination register */
+        if (arg.param < varArgDisp_.size())
+            LoadRegMem(dstReg, Reg::X29, varArgDisp_[arg.param]);
+    }
+    else
+    {
+        /* Move value into destination register */
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+            case ArgType::Word:
+            case ArgType::DWord:
+                MovRegImm32(dstReg, arg.value.i32);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+                MovRegImm64(dstReg, arg.value.i64);
+                break;
+            case ArgType::StackPtr:
+                SubImm(dstReg, Reg::X29, stackChunkOffsets_[arg.value.i8]);
+                break;
+            case ArgType::Float:
+                MovFltRegImm32(dstReg, arg.value.f32);
+                break;
+            case ArgType::Double:
+                MovFltRegImm64(dstReg, arg.value.f64);
+                break;
+        }
+    }
+}
+
+void AArch64Assembler::StoreArgToStack(const Arg& arg, std::uint32_t offset)
+{
+    /* Move value into temporary register; floating-point values are stored by their bit pattern */
+    if (arg.param < 0xF)
+    {
+        if (arg.param < varArgDisp_.size())
+            LoadRegMem(g_aarch64TempReg, Reg::X29, varArgDisp_[arg.param]);
+    }
+    else
+    {
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+            case ArgType::Word:
+            case ArgType::DWord:
+            case ArgType::Float:
+                MovRegImm32(g_aarch64TempReg, arg.value.i32);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+            case ArgType::Double:
+                MovRegImm64(g_aarch64TempReg, arg.value.i64);
+                break;
+            case ArgType::StackPtr:
+                SubImm(g_aarch64TempReg, Reg::X29, stackChunkOffsets_[arg.value.i8]);
+                break;
+        }
+    }
+
+    /* Store temporary register in outgoing parameter area */
+    StoreMemRegSized(Reg::SP, g_aarch64TempReg, offset, GetStackArgSize(arg.type));
+}
+
+// Instructions are always executed on the host, so they are written in native byte order.
+void AArch64Assembler::WriteInstr(std::uint32_t instr)
+{
+    WriteDWord(instr);
+}
+
+/* ----- MOV ----- */
+
+// MOVZ Wd, #imm16; MOVK Wd, #imm16, LSL #16
+void AArch64Assembler::MovRegImm32(Reg dstReg, std::uint32_t dword)
+{
+    WriteInstr(Opcode_MovZ32 | ((dword & 0xFFFF) << 5) | RegBits(dstReg));
+    if ((dword >> 16) != 0)
+        WriteInstr(Opcode_MovK32 | (1u << 21) | ((dword >> 16) << 5) | RegBits(dstReg));
+}
+
+// MOVZ Xd, #imm16, LSL #(hw*16); MOVK Xd, #imm16, LSL #(hw*16) for each remaining non-zero half-word
+void AArch64Assembler::MovRegImm64(Reg dstReg, std::uint64_t qword)
+{
+    bool isFirst = true;
+    for (std::uint32_t hw = 0; hw < 4; ++hw)
+    {
+        const std::uint32_t imm16 = static_cast<std::uint32_t>((qword >> (hw * 16)) & 0xFFFF);
+        if (imm16 != 0 || (hw == 3 && isFirst))
+        {
+            WriteInstr((isFirst ? Opcode_MovZ64 : Opcode_MovK64) | (hw << 21) | (imm16 << 5) | RegBits(dstReg));
+            isFirst = false;
+        }
+    }
+}
+
+void AArch64Assembler::MovFltRegImm32(Reg dstReg, float f32)
+{
+    std::uint32_t dword = 0;
+    ::memcpy(&dword, &f32, sizeof(dword));
+    MovRegImm32(g_aarch64CallReg, dword);
+    WriteInstr(Opcode_FMovSW | (RegBits(g_aarch64CallReg) << 5) | RegBits(dstReg));
+}
+
+void AArch64Assembler::MovFltRegImm64(Reg dstReg, double f64)
+{
+    std::uint64_t qword = 0;
+    ::memcpy(&qword, &f64, sizeof(qword));
+    MovRegImm64(g_aarch64CallReg, qword);
+    WriteInstr(Opcode_FMovDX | (RegBits(g_aarch64CallReg) << 5) | RegBits(dstReg));
+}
+
+// MOV Xd|SP, Xn|SP (alias of ADD Xd|SP, Xn|SP, #0)
+void AArch64Assembler::MovReg(Reg dstReg, Reg srcReg)
+{
+    AddImm(dstReg, srcReg, 0);
+}
+
+/* ----- ADD/SUB ----- */
+
+static std::uint32_t EncodeAddSubImm(std::uint32_t opcode, Reg dstReg, Reg srcReg, std::uint32_t imm)
+{
+    if (imm > 0xFFF)
+    {
+        /* Use shifted immediate (LSL #12) */
+        opcode |= (1u << 22);
+        imm >>= 12;
+    }
+    return (opcode | (imm << 10) | (RegBits(srcReg) << 5) | RegBits(dstReg));
+}
+
+static bool IsAddSubImmEncodable(std::uint32_t imm)
+{
+    return (imm <= 0xFFF || ((imm & 0xFFF) == 0 && imm <= 0xFFF000));
+}
+
+void AArch64Assembler::AddImm(Reg dstReg, Reg srcReg, std::uint32_t imm)
+{
+    if (IsAddSubImmEncodable(imm))
+        WriteInstr(EncodeAddSubImm(Opcode_AddImm64, dstReg, srcReg, imm));
+    else
+    {
+        MovRegImm64(g_aarch64CallReg, imm);
+        WriteInstr(Opcode_AddReg64 | (RegBits(g_aarch64CallReg) << 16) | (RegBits(srcReg) << 5) | RegBits(dstReg));
+    }
+}
+
+void AArch64Assembler::SubImm(Reg dstReg, Reg srcReg, std::uint32_t imm)
+{
+    if (IsAddSubImmEncodable(imm))
+        WriteInstr(EncodeAddSubImm(Opcode_SubImm64, dstReg, srcReg, imm));
+    else
+    {
+        MovRegImm64(g_aarch64CallReg, imm);
+        WriteInstr(Opcode_SubReg64 | (RegBits(g_aarch64CallReg) << 16) | (RegBits(srcReg) << 5) | RegBits(dstReg));
+    }
+}
+
+/* ----- LDR/STR ----- */
+
+// LDUR Xt|Dt, [Xn|SP, #simm9]
+void AArch64Assembler::LoadRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp)
+{
+    if (disp < -256 || disp > 255)
+    {
+        /* Compute address in scratch register if displacement exceeds 9 bits */
+        if (disp < 0)
+            SubImm(g_aarch64CallReg, srcMemReg, static_cast<std::uint32_t>(-disp));
+        else
+            AddImm(g_aarch64CallReg, srcMemReg, static_cast<std::uint32_t>(disp));
+        srcMemReg   = g_aarch64CallReg;
+        disp        = 0;
+    }
+    const std::uint32_t opcode = (IsFltReg(dstReg) ? Opcode_LdurD : Opcode_LdurX);
+    WriteInstr(opcode | ((static_cast<std::uint32_t>(disp) & 0x1FF) << 12) | (RegBits(srcMemReg) << 5) | RegBits(dstReg));
+}
+
+// STUR Xt|Dt, [Xn|SP, #simm9]
+void AArch64Assembler::StoreMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp)
+{
+    if (disp < -256 || disp > 255)
+    {
+        /* Compute address in scratch register if displacement exceeds 9 bits */
+        if (disp < 0)
+            SubImm(g_aarch64CallReg, dstMemReg, static_cast<std::uint32_t>(-disp));
+        else
+            AddImm(g_aarch64CallReg, dstMemReg, static_cast<std::uint32_t>(disp));
+        dstMemReg   = g_aarch64CallReg;
+        disp        = 0;
+    }
+    const std::uint32_t opcode = (IsFltReg(srcReg) ? Opcode_SturD : Opcode_SturX);
+    WriteInstr(opcode | ((static_cast<std::uint32_t>(disp) & 0x1FF) << 12) | (RegBits(dstMemReg) << 5) | RegBits(srcReg));
+}
+
+// STRB|STRH|STR Wt|STR Xt, [Xn|SP, #imm12*size]
+void AArch64Assembler::StoreMemRegSized(Reg dstMemReg, Reg srcReg, std::uint32_t offset, std::uint8_t size)
+{
+    std::uint32_t opcode = Opcode_StrXImm;
+    switch (size)
+    {
+        case 1: opcode = Opcode_StrbImm; break;
+        case 2: opcode = Opcode_StrhImm; break;
+        case 4: opcode = Opcode_StrWImm; break;
+        default: break;
+    }
+    WriteInstr(opcode | ((offset / size) << 10) | (RegBits(dstMemReg) << 5) | RegBits(srcReg));
+}
+
+/* ----- FCVT ----- */
+
+// FCVT Sd, Dn
+void AArch64Assembler::FCvtSD(Reg dstReg, Reg srcReg)
+{
+    WriteInstr(Opcode_FCvtSD | (RegBits(srcReg) << 5) | RegBits(dstReg));
+}
+
+/* ----- BLR/RET ----- */
+
+// BLR Xn
+void AArch64Assembler::BranchLinkReg(Reg reg)
+{
+    WriteInstr(Opcode_Blr | (RegBits(reg) << 5));
+}
+
+// RET
+void AArch64Assembler::Ret()
+{
+    WriteInstr(Opcode_Ret);
+}
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,100 @@
+/*
+ * AArch64Assembler.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_AARCH64_ASSEMBLER_H
+#define LLGL_AARCH64_ASSEMBLER_H
+
+
+#include "AArch64Register.h"
+#include "../../JITCompiler.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+// AArch64 (a.k.a. ARM64) assembly code generator for the AAPCS64 calling convention.
+class AArch64Assembler final : public JITCompiler
+{
+
+    public:
+
+        void Begin() override;
+        void End() override;
+
+    private:
+
+        bool IsLittleEndian() const override;
+        void WriteFuncCall(const void* addr, JITCallConv conv, bool farCall) override;
+
+    private:
+
+        void WritePrologue();
+        void WriteEpilogue();
+
+        void WriteStackFrame(
+            const std::vector<JIT::ArgType>&    varArgTypes,
+            const std::vector<std::uint32_t>&   stackChunks
+        );
+
+        // Moves the specified argument into an integer or floating-point parameter register.
+        void MovArgToReg(Reg dstReg, const Arg& arg);
+
+        // Stores the specified argument in the outgoing parameter area at the specified offset from the stack pointer.
+        void StoreArgToStack(const Arg& arg, std::uint32_t offset);
+
+    private:
+
+        void WriteInstr(std::uint32_t instr);
+
+        void MovRegImm32(Reg dstReg, std::uint32_t dword);
+        void MovRegImm64(Reg dstReg, std::uint64_t qword);
+        void MovFltRegImm32(Reg dstReg, float f32);
+        void MovFltRegImm64(Reg dstReg, double f64);
+        void MovReg(Reg dstReg, Reg srcReg);
+
+        void AddImm(Reg dstReg, Reg srcReg, std::uint32_t imm);
+        void SubImm(Reg dstReg, Reg srcReg, std::uint32_t imm);
+
+        void LoadRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp);
+        void StoreMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp);
+        void StoreMemRegSized(Reg dstMemReg, Reg srcReg, std::uint32_t offset, std::uint8_t size);
+
+        void FCvtSD(Reg dstReg, Reg srcReg);
+
+        void BranchLinkReg(Reg reg);
+        void Ret();
+
+    private:
+
+        // Size of the local stack frame below the frame pointer (X29).
+        std::uint32_t               localStackSize_ = 0;
+
+        // Frame pointer offsets of variadic arguments of the entry point.
+        std::vector<std::int32_t>   varArgDisp_;
+
+        // Frame pointer offsets of stack allocations.
+        std::vector<std::uint32_t>  stackChunkOffsets_;
+
+};
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
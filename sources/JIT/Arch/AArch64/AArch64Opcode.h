@@ -0,0 +1,65 @@
+/*
+ * AArch64Opcode.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_AARCH64_OPCODE_H
+#define LLGL_AARCH64_OPCODE_H
+
+
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+/*
+All AArch64 instructions are 32 bits wide and stored in little-endian byte order.
+The opcodes below only contain the fixed bits of each instruction; the assembler inserts the operands,
+i.e. Rd/Rt at bits [4:0], Rn at bits [9:5], Rm at bits [20:16], imm12 at bits [21:10], imm9 at bits [20:12],
+and imm16 at bits [20:5] with the shift (hw) at bits [22:21].
+*/
+
+enum Opcode : std::uint32_t
+{
+    Opcode_AddImm64     = 0x91000000, // ADD  Xd|SP, Xn|SP, #imm12 {, LSL #12}
+    Opcode_SubImm64     = 0xD1000000, // SUB  Xd|SP, Xn|SP, #imm12 {, LSL #12}
+    Opcode_AddReg64     = 0x8B206000, // ADD  Xd|SP, Xn|SP, Xm, UXTX
+    Opcode_SubReg64     = 0xCB206000, // SUB  Xd|SP, Xn|SP, Xm, UXTX
+    Opcode_MovZ32       = 0x52800000, // MOVZ Wd, #imm16, LSL #(hw*16)
+    Opcode_MovK32       = 0x72800000, // MOVK Wd, #imm16, LSL #(hw*16)
+    Opcode_MovZ64       = 0xD2800000, // MOVZ Xd, #imm16, LSL #(hw*16)
+    Opcode_MovK64       = 0xF2800000, // MOVK Xd, #imm16, LSL #(hw*16)
+    Opcode_FMovSW       = 0x1E270000, // FMOV Sd, Wn
+    Opcode_FMovDX       = 0x9E670000, // FMOV Dd, Xn
+    Opcode_LdurX        = 0xF8400000, // LDUR Xt, [Xn|SP, #simm9]
+    Opcode_SturX        = 0xF8000000, // STUR Xt, [Xn|SP, #simm9]
+    Opcode_LdurD        = 0xFC400000, // LDUR Dt, [Xn|SP, #simm9]
+    Opcode_SturD        = 0xFC000000, // STUR Dt, [Xn|SP, #simm9]
+    Opcode_StrbImm      = 0x39000000, // STRB Wt, [Xn|SP, #imm12]
+    Opcode_StrhImm      = 0x79000000, // STRH Wt, [Xn|SP, #imm12*2]
+    Opcode_StrWImm      = 0xB9000000, // STR  Wt, [Xn|SP, #imm12*4]
+    Opcode_StrXImm      = 0xF9000000, // STR  Xt, [Xn|SP, #imm12*8]
+    Opcode_FCvtSD       = 0x1E624000, // FCVT Sd, Dn
+    Opcode_StpPreFPLR   = 0xA9BF7BFD, // STP  X29, X30, [SP, #-16]!
+    Opcode_LdpPostFPLR  = 0xA8C17BFD, // LDP  X29, X30, [SP], #16
+    Opcode_Blr          = 0xD63F0000, // BLR  Xn
+    Opcode_Ret          = 0xD65F03C0, // RET  X30
+};
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -8,6 +8,8 @@
 #include "AMD64Assembler.h"
 #include "AMD64Opcode.h"
 #include <limits.h>
+#include <limits>
+#include <string.h>
 
 #include <fstream>//!!!
 #include <iomanip>
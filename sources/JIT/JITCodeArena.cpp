@@ -0,0 +1,191 @@
+/*
+ * JITCodeArena.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "JITCodeArena.h"
+#include "../Core/CoreUtils.h"
+#include "../Core/Assertion.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Alignment of each program within a chunk; 16 bytes is the preferred function alignment on all supported architectures.
+static constexpr std::size_t g_codeAlignment    = 16;
+
+// Default size of each chunk; larger programs get a chunk of their own.
+static constexpr std::size_t g_defaultChunkSize = 64 * 1024;
+
+JITCodeArena& JITCodeArena::Get()
+{
+    static JITCodeArena instance;
+    return instance;
+}
+
+JITCodeArena::~JITCodeArena()
+{
+    for (const Chunk& chunk : chunks_)
+        UnmapChunk(chunk);
+}
+
+void* JITCodeArena::Allocate(const void* code, std::size_t size)
+{
+    LLGL_ASSERT(code != nullptr && size > 0);
+
+    const std::size_t alignedSize = GetAlignedSize(size, g_codeAlignment);
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Find first chunk with enough space left or allocate a new one */
+    Chunk* chunk = nullptr;
+    std::size_t offset = 0;
+
+    for (Chunk& c : chunks_)
+    {
+        if (AllocateRange(c, alignedSize, offset))
+        {
+            chunk = &c;
+            break;
+        }
+    }
+
+    if (chunk == nullptr)
+    {
+        chunk = &AllocateChunk(alignedSize);
+        AllocateRange(*chunk, alignedSize, offset);
+    }
+
+    /* Copy code into executable memory */
+    BeginWrite(*chunk, offset, size);
+    ::memcpy(chunk->writeAddr + offset, code, size);
+    EndWrite(*chunk, offset, size);
+
+    return chunk->addr + offset;
+}
+
+void JITCodeArena::Free(void* addr, std::size_t size)
+{
+    if (addr == nullptr)
+        return;
+
+    const std::size_t alignedSize = GetAlignedSize(size, g_codeAlignment);
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Find chunk that contains the specified address */
+    char* byteAddr = static_cast<char*>(addr);
+    auto it = std::find_if(
+        chunks_.begin(), chunks_.end(),
+        [byteAddr](const Chunk& c)
+        {
+            return (byteAddr >= c.addr && byteAddr < c.addr + c.size);
+        }
+    );
+    LLGL_ASSERT(it != chunks_.end(), "address of JIT program does not belong to code arena");
+
+    FreeRange(*it, static_cast<std::size_t>(byteAddr - it->addr), alignedSize);
+
+    /* Release empty chunks except for the last one to avoid remapping pages when programs are recreated frequently */
+    if (it->allocatedSize == 0 && chunks_.size() > 1)
+    {
+        UnmapChunk(*it);
+        chunks_.erase(it);
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool JITCodeArena::AllocateRange(Chunk& chunk, std::size_t size, std::size_t& outOffset)
+{
+    for (auto it = chunk.freeRanges.begin(); it != chunk.freeRanges.end(); ++it)
+    {
+        if (it->size >= size)
+        {
+            /* Take range from the beginning of the free range (first fit) */
+            outOffset = it->offset;
+            it->offset += size;
+            it->size -= size;
+            if (it->size == 0)
+                chunk.freeRanges.erase(it);
+            chunk.allocatedSize += size;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JITCodeArena::FreeRange(Chunk& chunk, std::size_t offset, std::size_t size)
+{
+    LLGL_ASSERT(chunk.allocatedSize >= size);
+    chunk.allocatedSize -= size;
+
+    /* Find first free range behind the released range */
+    auto next = std::lower_bound(
+        chunk.freeRanges.begin(), chunk.freeRanges.end(), offset,
+        [](const Range& range, std::size_t value)
+        {
+            return (range.offset < value);
+        }
+    );
+
+    /* Merge with previous free range */
+    if (next != chunk.freeRanges.begin())
+    {
+        auto prev = next - 1;
+        if (prev->offset + prev->size == offset)
+        {
+            prev->size += size;
+
+            /* Merge with next free range as well */
+            if (next != chunk.freeRanges.end() && offset + size == next->offset)
+            {
+                prev->size += next->size;
+                chunk.freeRanges.erase(next);
+            }
+            return;
+        }
+    }
+
+    /* Merge with next free range */
+    if (next != chunk.freeRanges.end() && offset + size == next->offset)
+    {
+        next->offset = offset;
+        next->size += size;
+        return;
+    }
+
+    chunk.freeRanges.insert(next, Range{ offset, size });
+}
+
+JITCodeArena::Chunk& JITCodeArena::AllocateChunk(std::size_t minSize)
+{
+    Chunk chunk;
+    {
+        chunk.size = GetAlignedSize(std::max(minSize, g_defaultChunkSize), GetAllocationGranularity());
+    }
+    if (!MapChunk(chunk))
+        throw std::runtime_error("failed to map " + std::to_string(chunk.size) + " byte(s) of executable memory");
+
+    chunk.freeRanges.push_back(Range{ 0, chunk.size });
+    chunks_.push_back(std::move(chunk));
+
+    return chunks_.back();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
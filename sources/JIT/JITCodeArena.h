@@ -0,0 +1,108 @@
+/*
+ * JITCodeArena.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_JIT_CODE_ARENA_H
+#define LLGL_JIT_CODE_ARENA_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Process wide arena of executable memory for JIT programs.
+Many small programs are packed into shared chunks of executable pages instead of mapping at least one page per program,
+and freed regions are recycled for subsequent programs. Empty chunks are released except for a single spare chunk.
+Memory is never writable and executable at the same time (W^X) at the same address:
+Each chunk is either mapped twice, once for execution and once for writing, or the protection of the written pages is changed while a program is copied.
+*/
+class JITCodeArena final : public NonCopyable
+{
+
+    public:
+
+        // Returns the instance of the process wide code arena.
+        static JITCodeArena& Get();
+
+        // Copies the specified code into executable memory and returns its address. Throws std::runtime_error on failure.
+        void* Allocate(const void* code, std::size_t size);
+
+        // Returns the memory of a program that has been allocated with Allocate back to the arena.
+        void Free(void* addr, std::size_t size);
+
+    private:
+
+        struct Range
+        {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        struct Chunk
+        {
+            char*               addr            = nullptr;  // Executable address of the chunk
+            char*               writeAddr       = nullptr;  // Writable alias of the chunk, or equal to 'addr' if the chunk is only mapped once
+            std::size_t         size            = 0;
+            std::size_t         allocatedSize   = 0;
+            std::vector<Range>  freeRanges;                 // Sorted by offset and never adjacent to each other
+        };
+
+    private:
+
+        JITCodeArena() = default;
+        ~JITCodeArena();
+
+        // Allocates a range of the specified size from the free ranges of the specified chunk. Returns false if the chunk has not enough space left.
+        static bool AllocateRange(Chunk& chunk, std::size_t size, std::size_t& outOffset);
+
+        // Returns the specified range to the free ranges of the chunk and merges it with its adjacent free ranges.
+        static void FreeRange(Chunk& chunk, std::size_t offset, std::size_t size);
+
+        // Maps a new chunk with at least the specified size and appends it to the list of chunks.
+        Chunk& AllocateChunk(std::size_t minSize);
+
+    private:
+
+        /* ----- Platform specific functions ----- */
+
+        // Returns the granularity of virtual memory allocations.
+        static std::size_t GetAllocationGranularity();
+
+        // Maps the executable memory of the specified chunk with 'chunk.size' bytes. Returns false on failure.
+        static bool MapChunk(Chunk& chunk);
+
+        // Unmaps the memory of the specified chunk.
+        static void UnmapChunk(const Chunk& chunk);
+
+        // Makes the specified range of the chunk writable via 'chunk.writeAddr' for the calling thread.
+        static void BeginWrite(const Chunk& chunk, std::size_t offset, std::size_t size);
+
+        // Makes the specified range of the chunk executable again and invalidates the instruction cache for that range.
+        static void EndWrite(const Chunk& chunk, std::size_t offset, std::size_t size);
+
+    private:
+
+        std::mutex          mutex_;
+        std::vector<Chunk>  chunks_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -17,7 +17,9 @@
 #   include "Platform/POSIX/POSIXJITProgram.h"
 #endif
 
-#if defined LLGL_ARCH_ARM
+#if defined LLGL_ARCH_ARM64
+#   include "Arch/AArch64/AArch64Assembler.h"
+#elif defined LLGL_ARCH_ARM
 //#   include "Arch/ARM/ARMAssembler.h"
 #elif defined LLGL_ARCH_AMD64
 #   include "Arch/AMD64/AMD64Assembler.h"
@@ -37,7 +39,9 @@ std::unique_ptr<JITCompiler> JITCompiler::Create()
     std::unique_ptr<JITCompiler> compiler;
 
     /* Create JIT compiler for current CPU architecture */
-    #if defined LLGL_ARCH_ARM
+    #if defined LLGL_ARCH_ARM64
+    compiler = MakeUnique<AArch64Assembler>();
+    #elif defined LLGL_ARCH_ARM
     //TODO
     #elif defined LLGL_ARCH_AMD64
     compiler = MakeUnique<AMD64Assembler>();
@@ -0,0 +1,155 @@
+/*
+ * POSIXJITCodeArena.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "../../JITCodeArena.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Platform/Platform.h>
+#include <unistd.h> // sysconf, ftruncate, close
+#include <sys/mman.h> // mmap, mprotect
+
+#if defined __APPLE__ && defined LLGL_ARCH_ARM64
+#   include <pthread.h> // pthread_jit_write_protect_np
+#   include <libkern/OSCacheControl.h> // sys_icache_invalidate
+#elif defined __linux__
+#   include <sys/syscall.h> // SYS_memfd_create
+#   if defined SYS_memfd_create
+#       define LLGL_JIT_DUAL_MAPPING
+#   endif
+#endif
+
+
+namespace LLGL
+{
+
+
+#ifdef LLGL_JIT_DUAL_MAPPING
+
+// Maps the chunk twice into the same anonymous memory file, once with read/execute and once with read/write protection.
+static bool MapDualChunk(char*& outAddr, char*& outWriteAddr, std::size_t size)
+{
+    const int fd = static_cast<int>(::syscall(SYS_memfd_create, "LLGL.JITCodeArena", 0x0001u /*MFD_CLOEXEC*/));
+    if (fd == -1)
+        return false;
+
+    void* addr      = MAP_FAILED;
+    void* writeAddr = MAP_FAILED;
+
+    if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+    {
+        addr = ::mmap(nullptr, size, (PROT_READ | PROT_EXEC), MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            writeAddr = ::mmap(nullptr, size, (PROT_READ | PROT_WRITE), MAP_SHARED, fd, 0);
+            if (writeAddr == MAP_FAILED)
+                ::munmap(addr, size);
+        }
+    }
+
+    /* Mappings keep the memory file alive */
+    ::close(fd);
+
+    if (writeAddr == MAP_FAILED)
+        return false;
+
+    outAddr         = static_cast<char*>(addr);
+    outWriteAddr    = static_cast<char*>(writeAddr);
+    return true;
+}
+
+#endif // /LLGL_JIT_DUAL_MAPPING
+
+#if !(defined __APPLE__ && defined LLGL_ARCH_ARM64)
+
+// Changes the protection of all pages that overlap the specified range of the chunk.
+static void ProtectChunkPages(char* addr, std::size_t offset, std::size_t size, int prot)
+{
+    const std::size_t pageSize  = static_cast<std::size_t>(::sysconf(_SC_PAGE_SIZE));
+    const std::size_t begin     = (offset / pageSize) * pageSize;
+    const std::size_t end       = GetAlignedSize(offset + size, pageSize);
+    ::mprotect(addr + begin, end - begin, prot);
+}
+
+#endif // /!(__APPLE__ && LLGL_ARCH_ARM64)
+
+std::size_t JITCodeArena::GetAllocationGranularity()
+{
+    return static_cast<std::size_t>(::sysconf(_SC_PAGE_SIZE));
+}
+
+bool JITCodeArena::MapChunk(Chunk& chunk)
+{
+    #ifdef LLGL_JIT_DUAL_MAPPING
+    if (MapDualChunk(chunk.addr, chunk.writeAddr, chunk.size))
+        return true;
+    #endif
+
+    /* Fall back to a single mapping that changes its protection while code is written */
+    void* addr = ::mmap(
+        nullptr,
+        chunk.size,
+        #if defined __APPLE__ && defined LLGL_ARCH_ARM64
+        (PROT_READ | PROT_WRITE | PROT_EXEC),
+        (MAP_PRIVATE | MAP_ANONYMOUS | MAP_JIT), // Apple silicon only allows RWX pages with MAP_JIT, and write access is toggled per thread
+        #else
+        (PROT_READ | PROT_EXEC),
+        (MAP_PRIVATE | MAP_ANONYMOUS),
+        #endif
+        -1, // must be -1 if MAP_ANONYMOUS is used
+        0
+    );
+
+    if (addr == MAP_FAILED)
+        return false;
+
+    chunk.addr      = static_cast<char*>(addr);
+    chunk.writeAddr = chunk.addr;
+    return true;
+}
+
+void JITCodeArena::UnmapChunk(const Chunk& chunk)
+{
+    ::munmap(chunk.addr, chunk.size);
+    if (chunk.writeAddr != chunk.addr)
+        ::munmap(chunk.writeAddr, chunk.size);
+}
+
+void JITCodeArena::BeginWrite(const Chunk& chunk, std::size_t offset, std::size_t size)
+{
+    #if defined __APPLE__ && defined LLGL_ARCH_ARM64
+    pthread_jit_write_protect_np(0);
+    #else
+    /*
+    Without a writable alias, the pages that are shared with other programs are not executable until EndWrite,
+    so programs in the same pages must not be executed by other threads while a new program is allocated.
+    */
+    if (chunk.writeAddr == chunk.addr)
+        ProtectChunkPages(chunk.addr, offset, size, (PROT_READ | PROT_WRITE));
+    #endif
+}
+
+void JITCodeArena::EndWrite(const Chunk& chunk, std::size_t offset, std::size_t size)
+{
+    #if defined __APPLE__ && defined LLGL_ARCH_ARM64
+    pthread_jit_write_protect_np(1);
+    sys_icache_invalidate(chunk.addr + offset, size);
+    #else
+    if (chunk.writeAddr == chunk.addr)
+        ProtectChunkPages(chunk.addr, offset, size, (PROT_READ | PROT_EXEC));
+    #endif
+
+    /* Instruction cache is not coherent with data cache on ARM */
+    #if (defined LLGL_ARCH_ARM64 || defined LLGL_ARCH_ARM) && !defined __APPLE__
+    __builtin___clear_cache(chunk.addr + offset, chunk.addr + offset + size);
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -6,11 +6,8 @@
  */
 
 #include "POSIXJITProgram.h"
+#include "../../JITCodeArena.h"
 #include "../../../Core/CoreUtils.h"
-#include <cstdlib>
-#include <stdexcept>
-#include <unistd.h> // sysconf
-#include <sys/mman.h> // mmap
 
 
 namespace LLGL
@@ -23,31 +20,16 @@ std::unique_ptr<JITProgram> JITProgram::Create(const void* code, std::size_t siz
 }
 
 POSIXJITProgram::POSIXJITProgram(const void* code, std::size_t size) :
-    size_ { GetAlignedSize(size, std::size_t(sysconf(_SC_PAGE_SIZE))) }
+    addr_ { JITCodeArena::Get().Allocate(code, size) },
+    size_ { size                                     }
 {
-    /* Map executable memory space */
-    addr_ = ::mmap(
-        nullptr,
-        size_,
-        (PROT_READ | PROT_WRITE | PROT_EXEC),
-        (MAP_PRIVATE | MAP_ANONYMOUS),
-        -1, // must be -1 if MAP_ANONYMOUS is used
-        0
-    );
-
-    if (addr_ == MAP_FAILED)
-        throw std::runtime_error("failed to map executable virtual memory with read/write protection mode");
-
-    /* Copy code into executable memory space */
-    ::memcpy(addr_, code, size);
-
     /* Set function pointer to executable memory address */
     SetEntryPoint(addr_);
 }
 
-POSIXJITProgram::POSIXJITProgram()
+POSIXJITProgram::~POSIXJITProgram()
 {
-    munmap(addr_, size_);
+    JITCodeArena::Get().Free(addr_, size_);
 }
 
 
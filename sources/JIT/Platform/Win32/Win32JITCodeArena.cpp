@@ -0,0 +1,80 @@
+/*
+ * Win32JITCodeArena.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "../../JITCodeArena.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+
+namespace LLGL
+{
+
+
+std::size_t JITCodeArena::GetAllocationGranularity()
+{
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return static_cast<std::size_t>(systemInfo.dwAllocationGranularity);
+}
+
+bool JITCodeArena::MapChunk(Chunk& chunk)
+{
+    /* Create pagefile-backed section that is mapped twice, once with execute/read and once with read/write access */
+    const ULONGLONG size = static_cast<ULONGLONG>(chunk.size);
+    HANDLE section = CreateFileMappingW(
+        INVALID_HANDLE_VALUE,
+        NULL,
+        PAGE_EXECUTE_READWRITE,
+        static_cast<DWORD>(size >> 32),
+        static_cast<DWORD>(size & 0xFFFFFFFFull),
+        NULL
+    );
+    if (section == NULL)
+        return false;
+
+    void* addr      = MapViewOfFile(section, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, chunk.size);
+    void* writeAddr = (addr != nullptr ? MapViewOfFile(section, FILE_MAP_WRITE, 0, 0, chunk.size) : nullptr);
+
+    /* Views keep the section alive */
+    CloseHandle(section);
+
+    if (writeAddr == nullptr)
+    {
+        if (addr != nullptr)
+            UnmapViewOfFile(addr);
+        return false;
+    }
+
+    chunk.addr      = static_cast<char*>(addr);
+    chunk.writeAddr = static_cast<char*>(writeAddr);
+    return true;
+}
+
+void JITCodeArena::UnmapChunk(const Chunk& chunk)
+{
+    UnmapViewOfFile(chunk.writeAddr);
+    UnmapViewOfFile(chunk.addr);
+}
+
+void JITCodeArena::BeginWrite(const Chunk& /*chunk*/, std::size_t /*offset*/, std::size_t /*size*/)
+{
+    // dummy - chunk is always written via its writable view
+}
+
+void JITCodeArena::EndWrite(const Chunk& chunk, std::size_t offset, std::size_t size)
+{
+    /* Instruction cache is not coherent with data cache on ARM */
+    FlushInstructionCache(GetCurrentProcess(), chunk.addr + offset, size);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -104,6 +104,17 @@ void AndroidCanvas::OnProcessEvents()
         if (appState->destroyRequested != 0)
             PostQuit();
     }
+
+    /*
+    The native window is released when the app is moved into the background (APP_CMD_TERM_WINDOW) and a new one is
+    provided when it is resumed (APP_CMD_INIT_WINDOW). Keep track of the current window, so swap-chains can detach from
+    and re-attach to the native window while the GL context and all its resources stay alive.
+    */
+    if (window_ != appState->window)
+    {
+        window_         = appState->window;
+        contentSize_    = GetAndroidWindowRect();
+    }
 }
 
 
@@ -41,7 +41,7 @@ class AndroidCanvas : public Canvas
     private:
 
         CanvasDescriptor    desc_;
-        ANativeWindow*      window_         = nullptr;
+        ANativeWindow*      window_         = nullptr; // Null while the app is in the background.
         Extent2D            contentSize_;
 
 };
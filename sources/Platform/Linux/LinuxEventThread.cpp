@@ -0,0 +1,316 @@
+/*
+ * LinuxEventThread.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "LinuxEventThread.h"
+#include "MapKey.h"
+#include <stdexcept>
+#include <poll.h>
+#include <unistd.h>
+
+#ifdef LLGL_LINUX_ENABLE_XINPUT2
+#   include <X11/extensions/XInput2.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+LinuxEventThread::LinuxEventThread(::Display* display) :
+    display_ { XOpenDisplay(DisplayString(display)) }
+{
+    if (!display_)
+        throw std::runtime_error("failed to open X11 display for event thread");
+    if (::pipe(wakeFds_) != 0)
+    {
+        XCloseDisplay(display_);
+        throw std::runtime_error("failed to create pipe for X11 event thread");
+    }
+}
+
+LinuxEventThread::~LinuxEventThread()
+{
+    /* Wake up and join event thread */
+    if (thread_.joinable())
+    {
+        quit_ = true;
+        const char wakeByte = 0;
+        (void)::write(wakeFds_[1], &wakeByte, 1);
+        thread_.join();
+    }
+
+    ::close(wakeFds_[0]);
+    ::close(wakeFds_[1]);
+
+    /* Window is owned by this connection */
+    if (wnd_ != 0)
+        XDestroyWindow(display_, wnd_);
+    XCloseDisplay(display_);
+}
+
+void LinuxEventThread::Start(::Window wnd)
+{
+    wnd_            = wnd;
+    closeWndAtom_   = XInternAtom(display_, "WM_DELETE_WINDOW", False);
+
+    #ifdef LLGL_LINUX_ENABLE_XINPUT2
+    SelectRawInput();
+    #endif
+
+    thread_ = std::thread(&LinuxEventThread::Run, this);
+}
+
+bool LinuxEventThread::PopEvent(LinuxWindowEvent& outEvent)
+{
+    const std::size_t readPos = queueReadPos_.load(std::memory_order_relaxed);
+    if (readPos == queueWritePos_.load(std::memory_order_acquire))
+        return false;
+    outEvent = queue_[readPos % queueSize];
+    queueReadPos_.store(readPos + 1, std::memory_order_release);
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void LinuxEventThread::Run()
+{
+    const int connectionFd = ConnectionNumber(display_);
+
+    while (!quit_)
+    {
+        /* Read all events that have arrived so far and merge their mouse motion into a single event */
+        while (XPending(display_) > 0)
+        {
+            XEvent event;
+            XNextEvent(display_, &event);
+            ProcessEvent(event);
+        }
+        FlushMotion();
+
+        /* Wait until new events arrive or the thread is stopped */
+        ::pollfd fds[2] =
+        {
+            { connectionFd, POLLIN, 0 },
+            { wakeFds_[0],  POLLIN, 0 },
+        };
+        ::poll(fds, 2, -1);
+    }
+}
+
+void LinuxEventThread::ProcessEvent(XEvent& event)
+{
+    if (event.type == MotionNotify)
+    {
+        ProcessMotionEvent(event.xmotion);
+        return;
+    }
+
+    #ifdef LLGL_LINUX_ENABLE_XINPUT2
+    if (event.type == GenericEvent && event.xcookie.extension == xiOpcode_)
+    {
+        ProcessRawMotionEvent(event.xcookie);
+        return;
+    }
+    #endif
+
+    /* Mouse motion must be received before any other event to preserve the order of events */
+    FlushMotion();
+
+    switch (event.type)
+    {
+        case KeyPress:
+            PushEvent(LinuxWindowEvent::KeyDown, MapKey(event.xkey));
+            break;
+
+        case KeyRelease:
+            PushEvent(LinuxWindowEvent::KeyUp, MapKey(event.xkey));
+            break;
+
+        case ButtonPress:
+        case ButtonRelease:
+        {
+            const LinuxWindowEvent::Type type = (event.type == ButtonPress ? LinuxWindowEvent::KeyDown : LinuxWindowEvent::KeyUp);
+            switch (event.xbutton.button)
+            {
+                case Button1:
+                    PushEvent(type, Key::LButton);
+                    break;
+                case Button2:
+                    PushEvent(type, Key::MButton);
+                    break;
+                case Button3:
+                    PushEvent(type, Key::RButton);
+                    break;
+                case Button4:
+                    if (event.type == ButtonPress)
+                        PushEvent(LinuxWindowEvent::WheelMotion, Key::Any, 1);
+                    break;
+                case Button5:
+                    if (event.type == ButtonPress)
+                        PushEvent(LinuxWindowEvent::WheelMotion, Key::Any, -1);
+                    break;
+            }
+        }
+        break;
+
+        case Expose:
+        {
+            XWindowAttributes attribs;
+            XGetWindowAttributes(display_, wnd_, &attribs);
+            PushEvent(LinuxWindowEvent::Resize, Key::Any, attribs.width, attribs.height);
+        }
+        break;
+
+        case FocusIn:
+            hasFocus_ = true;
+            PushEvent(LinuxWindowEvent::GetFocus);
+            break;
+
+        case FocusOut:
+            hasFocus_ = false;
+            PushEvent(LinuxWindowEvent::LostFocus);
+            break;
+
+        case DestroyNotify:
+            PushEvent(LinuxWindowEvent::Quit);
+            break;
+
+        case ClientMessage:
+            if (static_cast<Atom>(event.xclient.data.l[0]) == closeWndAtom_)
+                PushEvent(LinuxWindowEvent::Quit);
+            break;
+    }
+}
+
+void LinuxEventThread::ProcessMotionEvent(const XMotionEvent& event)
+{
+    const Offset2D mousePos{ event.x, event.y };
+
+    localMotion_        = mousePos;
+    localMotionPending_ = true;
+
+    /* Global motion is derived from the cursor position unless raw input is available */
+    #ifdef LLGL_LINUX_ENABLE_XINPUT2
+    if (xiOpcode_ == -1)
+    #endif
+    {
+        globalMotion_.x += mousePos.x - prevMousePos_.x;
+        globalMotion_.y += mousePos.y - prevMousePos_.y;
+    }
+
+    prevMousePos_ = mousePos;
+}
+
+#ifdef LLGL_LINUX_ENABLE_XINPUT2
+
+void LinuxEventThread::SelectRawInput()
+{
+    int event = 0, error = 0;
+    if (!XQueryExtension(display_, "XInputExtension", &xiOpcode_, &event, &error))
+    {
+        xiOpcode_ = -1;
+        return;
+    }
+
+    int major = 2, minor = 0;
+    if (XIQueryVersion(display_, &major, &minor) != Success)
+    {
+        xiOpcode_ = -1;
+        return;
+    }
+
+    /* Raw events are only delivered to the root window */
+    unsigned char maskBits[XIMaskLen(XI_LASTEVENT)] = {};
+    XISetMask(maskBits, XI_RawMotion);
+
+    XIEventMask mask;
+    {
+        mask.deviceid   = XIAllMasterDevices;
+        mask.mask_len   = sizeof(maskBits);
+        mask.mask       = maskBits;
+    }
+    XISelectEvents(display_, DefaultRootWindow(display_), &mask, 1);
+}
+
+void LinuxEventThread::ProcessRawMotionEvent(XGenericEventCookie& cookie)
+{
+    if (!XGetEventData(display_, &cookie))
+        return;
+
+    /* Raw motion is received regardless of the input focus, so only forward it while the window is focused */
+    if (cookie.evtype == XI_RawMotion && hasFocus_)
+    {
+        const XIRawEvent* rawEvent = static_cast<const XIRawEvent*>(cookie.data);
+        const double* values = rawEvent->raw_values;
+
+        /* Valuators 0 and 1 denote the relative X and Y axes; values are only stored for valuators that are set */
+        for (int axis = 0; axis < 2 && axis < rawEvent->valuators.mask_len * 8; ++axis)
+        {
+            if (XIMaskIsSet(rawEvent->valuators.mask, axis))
+                rawMotionRemainder_[axis] += *values++;
+        }
+
+        /* Keep fractional motion of high-resolution mice for the next event */
+        const int motionX = static_cast<int>(rawMotionRemainder_[0]);
+        const int motionY = static_cast<int>(rawMotionRemainder_[1]);
+        rawMotionRemainder_[0] -= motionX;
+        rawMotionRemainder_[1] -= motionY;
+
+        globalMotion_.x += motionX;
+        globalMotion_.y += motionY;
+    }
+
+    XFreeEventData(display_, &cookie);
+}
+
+#endif // /LLGL_LINUX_ENABLE_XINPUT2
+
+void LinuxEventThread::FlushMotion()
+{
+    if (localMotionPending_)
+    {
+        PushEvent(LinuxWindowEvent::LocalMotion, Key::Any, localMotion_.x, localMotion_.y);
+        localMotionPending_ = false;
+    }
+    if (globalMotion_.x != 0 || globalMotion_.y != 0)
+    {
+        PushEvent(LinuxWindowEvent::GlobalMotion, Key::Any, globalMotion_.x, globalMotion_.y);
+        globalMotion_ = Offset2D{};
+    }
+}
+
+void LinuxEventThread::PushEvent(LinuxWindowEvent::Type type, Key key, std::int32_t x, std::int32_t y)
+{
+    const std::size_t writePos = queueWritePos_.load(std::memory_order_relaxed);
+
+    /* Wait for the window to process its events if the ring buffer is full */
+    while (writePos - queueReadPos_.load(std::memory_order_acquire) >= queueSize)
+    {
+        if (quit_)
+            return;
+        std::this_thread::yield();
+    }
+
+    LinuxWindowEvent& event = queue_[writePos % queueSize];
+    {
+        event.type  = type;
+        event.key   = key;
+        event.x     = x;
+        event.y     = y;
+    }
+    queueWritePos_.store(writePos + 1, std::memory_order_release);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
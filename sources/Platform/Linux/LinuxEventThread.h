@@ -0,0 +1,128 @@
+/*
+ * LinuxEventThread.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_LINUX_EVENT_THREAD_H
+#define LLGL_LINUX_EVENT_THREAD_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <LLGL/Types.h>
+#include <LLGL/Key.h>
+#include <X11/Xlib.h>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Window event that is forwarded from the event thread to the thread that processes the window events.
+struct LinuxWindowEvent
+{
+    enum Type : std::uint8_t
+    {
+        KeyDown,
+        KeyUp,
+        WheelMotion,    // x = wheel motion
+        LocalMotion,    // x, y = mouse position
+        GlobalMotion,   // x, y = mouse motion
+        Resize,         // x, y = client area size
+        GetFocus,
+        LostFocus,
+        Quit,
+    };
+
+    Type            type;
+    Key             key;
+    std::int32_t    x;
+    std::int32_t    y;
+};
+
+/*
+Dedicated thread that reads the events of an X11 window with its own X11 display connection.
+The window is created on that connection, so the window manager sends its client messages (e.g. WM_DELETE_WINDOW) to this thread as well.
+Events are passed to the window via a single-producer/single-consumer ring buffer, so popping events requires neither locks nor system calls.
+Consecutive mouse motion events are coalesced before they are pushed into the ring buffer.
+*/
+class LinuxEventThread final : public NonCopyable
+{
+
+    public:
+
+        // Opens a new connection to the X server of the specified display. Throws std::runtime_error on failure.
+        LinuxEventThread(::Display* display);
+        ~LinuxEventThread();
+
+        // Starts reading the events of the specified window. The window must have been created on the connection returned by GetNative().
+        void Start(::Window wnd);
+
+        // Pops the next event from the ring buffer. Returns false if there are no more events.
+        bool PopEvent(LinuxWindowEvent& outEvent);
+
+        // Returns the native X11 display connection of this event thread.
+        inline ::Display* GetNative() const
+        {
+            return display_;
+        }
+
+    private:
+
+        void Run();
+        void ProcessEvent(XEvent& event);
+        void ProcessMotionEvent(const XMotionEvent& event);
+
+        #ifdef LLGL_LINUX_ENABLE_XINPUT2
+        void SelectRawInput();
+        void ProcessRawMotionEvent(XGenericEventCookie& cookie);
+        #endif
+
+        // Pushes the pending mouse motion into the ring buffer.
+        void FlushMotion();
+
+        // Pushes the specified event into the ring buffer and waits until there is enough space if the buffer is full.
+        void PushEvent(LinuxWindowEvent::Type type, Key key = Key::Any, std::int32_t x = 0, std::int32_t y = 0);
+
+    private:
+
+        static constexpr std::size_t    queueSize               = 1024;
+
+        ::Display*                      display_                = nullptr;
+        ::Window                        wnd_                    = 0;
+        ::Atom                          closeWndAtom_           = 0;
+        int                             wakeFds_[2]             = { -1, -1 }; // Pipe to wake up the event thread when it is stopped
+
+        std::thread                     thread_;
+        std::atomic<bool>               quit_                   { false };
+
+        LinuxWindowEvent                queue_[queueSize];
+        std::atomic<std::size_t>        queueReadPos_           { 0 };
+        std::atomic<std::size_t>        queueWritePos_          { 0 };
+
+        bool                            hasFocus_               = false;
+        bool                            localMotionPending_     = false;
+        Offset2D                        localMotion_;
+        Offset2D                        globalMotion_;
+        Offset2D                        prevMousePos_;
+
+        #ifdef LLGL_LINUX_ENABLE_XINPUT2
+        int                             xiOpcode_               = -1;
+        double                          rawMotionRemainder_[2]  = { 0.0, 0.0 };
+        #endif
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -44,7 +44,14 @@ LinuxWindow::LinuxWindow(const WindowDescriptor& desc) :
 
 LinuxWindow::~LinuxWindow()
 {
-    XDestroyWindow(display_, wnd_);
+    if (eventThread_)
+    {
+        /* Window is destroyed by the event thread, so all pending requests for this window must be processed first */
+        XSync(display_, False);
+        eventThread_.reset();
+    }
+    else
+        XDestroyWindow(display_, wnd_);
 }
 
 bool LinuxWindow::GetNativeHandle(void* nativeHandle, std::size_t nativeHandleSize)
@@ -145,6 +152,12 @@ WindowDescriptor LinuxWindow::GetDesc() const
 
 void LinuxWindow::OnProcessEvents()
 {
+    if (eventThread_)
+    {
+        PostThreadedEvents();
+        return;
+    }
+
     XEvent event;
 
     XPending(display_);
@@ -218,6 +231,15 @@ void LinuxWindow::OpenWindow()
     if (!display_)
         throw std::runtime_error("failed to open X11 display");
 
+    /*
+    Create window on the connection of the event thread, so it receives all input events and client messages of this window.
+    X11 resource IDs are valid across all connections to the same server, so the window can still be used with the primary display.
+    */
+    if (desc_.threadedEvents)
+        eventThread_ = MakeUnique<LinuxEventThread>(display_);
+
+    ::Display* eventDisplay = (eventThread_ ? eventThread_->GetNative() : display_);
+
     /* Setup common parameters for window creation */
     ::Window    rootWnd     = (nativeHandle != nullptr ? nativeHandle->parentWindow : DefaultRootWindow(display_));
     int         screen      = (nativeHandle != nullptr ? nativeHandle->screen : DefaultScreen(display_));
@@ -231,6 +253,9 @@ void LinuxWindow::OpenWindow()
     attribs.border_pixel        = 0;
     attribs.event_mask          = (ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask);
 
+    if (eventThread_)
+        attribs.event_mask |= FocusChangeMask;
+
     unsigned long valueMask     = CWEventMask | CWBorderPixel;//(CWColormap | CWEventMask | CWOverrideRedirect)
 
     if (nativeHandle)
@@ -253,7 +278,7 @@ void LinuxWindow::OpenWindow()
 
     /* Create X11 window */
     wnd_ = XCreateWindow(
-        display_,
+        eventDisplay,
         rootWnd,
         desc_.position.x,
         desc_.position.y,
@@ -267,6 +292,14 @@ void LinuxWindow::OpenWindow()
         (&attribs)
     );
 
+    /* Enable WM_DELETE_WINDOW protocol */
+    closeWndAtom_ = XInternAtom(eventDisplay, "WM_DELETE_WINDOW", False);
+    XSetWMProtocols(eventDisplay, wnd_, &closeWndAtom_, 1);
+
+    /* Window must exist on the server before it is used with the primary display */
+    if (eventThread_)
+        XSync(eventDisplay, False);
+
     /* Set title and show window (if enabled) */
     SetTitle(desc_.title);
 
@@ -277,13 +310,15 @@ void LinuxWindow::OpenWindow()
     /* Prepare borderless window */
     if (desc_.borderless)
     {
-        XGrabKeyboard(display_, wnd_, True, GrabModeAsync, GrabModeAsync, CurrentTime);
-        XGrabPointer(display_, wnd_, True, ButtonPressMask, GrabModeAsync, GrabModeAsync, wnd_, None, CurrentTime);
+        if (eventThread_)
+            XSync(display_, False);
+        XGrabKeyboard(eventDisplay, wnd_, True, GrabModeAsync, GrabModeAsync, CurrentTime);
+        XGrabPointer(eventDisplay, wnd_, True, ButtonPressMask, GrabModeAsync, GrabModeAsync, wnd_, None, CurrentTime);
     }
 
-    /* Enable WM_DELETE_WINDOW protocol */
-    closeWndAtom_ = XInternAtom(display_, "WM_DELETE_WINDOW", False);
-    XSetWMProtocols(display_, wnd_, &closeWndAtom_, 1);
+    /* Start reading events after the window has been set up */
+    if (eventThread_)
+        eventThread_->Start(wnd_);
 }
 
 void LinuxWindow::ProcessKeyEvent(XKeyEvent& event, bool down)
@@ -354,6 +389,44 @@ void LinuxWindow::PostMouseKeyEvent(Key key, bool down)
         PostKeyUp(key);
 }
 
+void LinuxWindow::PostThreadedEvents()
+{
+    LinuxWindowEvent event;
+    while (eventThread_->PopEvent(event))
+    {
+        switch (event.type)
+        {
+            case LinuxWindowEvent::KeyDown:
+                PostKeyDown(event.key);
+                break;
+            case LinuxWindowEvent::KeyUp:
+                PostKeyUp(event.key);
+                break;
+            case LinuxWindowEvent::WheelMotion:
+                PostWheelMotion(event.x);
+                break;
+            case LinuxWindowEvent::LocalMotion:
+                PostLocalMotion({ event.x, event.y });
+                break;
+            case LinuxWindowEvent::GlobalMotion:
+                PostGlobalMotion({ event.x, event.y });
+                break;
+            case LinuxWindowEvent::Resize:
+                PostResize({ static_cast<std::uint32_t>(event.x), static_cast<std::uint32_t>(event.y) });
+                break;
+            case LinuxWindowEvent::GetFocus:
+                PostGetFocus();
+                break;
+            case LinuxWindowEvent::LostFocus:
+                PostLostFocus();
+                break;
+            case LinuxWindowEvent::Quit:
+                PostQuit();
+                break;
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -11,7 +11,9 @@
 
 #include <LLGL/Window.h>
 #include "LinuxDisplay.h"
+#include "LinuxEventThread.h"
 #include <X11/Xlib.h>
+#include <memory>
 
 
 namespace LLGL
@@ -60,6 +62,9 @@ class LinuxWindow : public Window
         void ProcessMotionEvent(XMotionEvent& event);
 
         void PostMouseKeyEvent(Key key, bool down);
+
+        // Posts all events that have been received by the event thread.
+        void PostThreadedEvents();
         
     private:
     
@@ -77,6 +82,8 @@ class LinuxWindow : public Window
         
         Offset2D                    prevMousePos_;
 
+        std::unique_ptr<LinuxEventThread> eventThread_;    // Only used if WindowDescriptor::threadedEvents is enabled
+
 };
 
 
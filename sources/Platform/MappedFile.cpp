@@ -0,0 +1,127 @@
+/*
+ * MappedFile.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#   include "Win32/Win32LeanAndMean.h"
+#   include <Windows.h>
+#else
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+#ifdef _WIN32
+
+std::unique_ptr<MappedFile> MappedFile::Open(const char* filename)
+{
+    if (filename == nullptr || *filename == '\0')
+        return nullptr;
+
+    HANDLE file = ::CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    /* Empty files cannot be mapped */
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+    {
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    const void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    std::unique_ptr<MappedFile> mappedFile{ new MappedFile{} };
+    {
+        mappedFile->data_           = data;
+        mappedFile->size_           = static_cast<std::size_t>(fileSize.QuadPart);
+        mappedFile->fileHandle_     = file;
+        mappedFile->mappingHandle_  = mapping;
+    }
+    return mappedFile;
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+        ::UnmapViewOfFile(data_);
+    if (mappingHandle_ != nullptr)
+        ::CloseHandle(mappingHandle_);
+    if (fileHandle_ != nullptr)
+        ::CloseHandle(fileHandle_);
+}
+
+#else // _WIN32
+
+std::unique_ptr<MappedFile> MappedFile::Open(const char* filename)
+{
+    if (filename == nullptr || *filename == '\0')
+        return nullptr;
+
+    const int file = ::open(filename, O_RDONLY);
+    if (file == -1)
+        return nullptr;
+
+    /* Empty files cannot be mapped */
+    struct stat fileStat;
+    if (::fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        ::close(file);
+        return nullptr;
+    }
+
+    /* File descriptor is no longer needed once the mapping has been created */
+    const std::size_t fileSize = static_cast<std::size_t>(fileStat.st_size);
+    void* data = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+
+    if (data == MAP_FAILED)
+        return nullptr;
+
+    std::unique_ptr<MappedFile> mappedFile{ new MappedFile{} };
+    {
+        mappedFile->data_ = data;
+        mappedFile->size_ = fileSize;
+    }
+    return mappedFile;
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+        ::munmap(const_cast<void*>(data_), size_);
+}
+
+#endif // /_WIN32
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
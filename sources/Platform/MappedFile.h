@@ -0,0 +1,69 @@
+/*
+ * MappedFile.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_MAPPED_FILE_H
+#define LLGL_MAPPED_FILE_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <memory>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Read-only memory mapping of an entire file. The mapped memory remains valid until this object is destroyed.
+class MappedFile : public NonCopyable
+{
+
+    public:
+
+        // Maps the specified file into memory or returns null if it cannot be opened or is empty.
+        static std::unique_ptr<MappedFile> Open(const char* filename);
+
+        // Unmaps the file and closes its handles.
+        ~MappedFile();
+
+        // Returns the start of the mapped file content.
+        inline const void* GetData() const
+        {
+            return data_;
+        }
+
+        // Returns the size (in bytes) of the mapped file content.
+        inline std::size_t GetSize() const
+        {
+            return size_;
+        }
+
+    private:
+
+        MappedFile() = default;
+
+    private:
+
+        const void*     data_           = nullptr;
+        std::size_t     size_           = 0;
+
+        #ifdef _WIN32
+        void*           fileHandle_     = nullptr;
+        void*           mappingHandle_  = nullptr;
+        #endif
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
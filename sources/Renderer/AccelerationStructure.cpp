@@ -0,0 +1,30 @@
+/*
+ * AccelerationStructure.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/AccelerationStructure.h>
+
+
+namespace LLGL
+{
+
+
+AccelerationStructure::AccelerationStructure(const AccelerationStructureType type) :
+    type_ { type }
+{
+}
+
+ResourceType AccelerationStructure::GetResourceType() const
+{
+    return ResourceType::AccelerationStructure;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,663 @@
+/*
+ * AssetPack.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/AssetPack.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/Shader.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Format.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include "TextureUtils.h"
+#include "../Platform/MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+static constexpr char           g_assetPackMagic[4]         = { 'L', 'L', 'P', 'K' };
+static constexpr std::uint32_t  g_assetPackVersion          = 1;
+static constexpr std::uint64_t  g_assetPackAlignment        = 256;
+static constexpr std::uint32_t  g_assetPackInvalidString    = ~0u;
+
+enum AssetPackEntryKind : std::uint32_t
+{
+    AssetPackEntryShader    = 1,
+    AssetPackEntryTexture   = 2,
+};
+
+/*
+File layout: The header is followed by the entry index and the string table of all names, entry points, and profiles.
+The payloads follow at offsets aligned to 'g_assetPackAlignment'. All values are stored in the byte order of the host.
+*/
+struct AssetPackHeader
+{
+    char            magic[4];
+    std::uint32_t   version;
+    std::uint32_t   numEntries;
+    std::uint32_t   stringTableSize;
+    std::uint64_t   indexOffset;
+    std::uint64_t   stringTableOffset;
+};
+
+struct AssetPackEntry
+{
+    std::uint32_t   kind;               // AssetPackEntryKind
+    std::uint32_t   nameOffset;         // Offset into the string table
+    std::uint64_t   dataOffset;         // Offset of the payload within the file
+    std::uint64_t   dataSize;           // Size of the payload
+    std::uint32_t   type;               // ShaderType or TextureType
+    std::uint32_t   format;             // ShadingLanguage or Format
+    std::uint32_t   sourceType;         // ShaderSourceType (shaders only)
+    std::uint32_t   entryPointOffset;   // Offset into the string table or 'g_assetPackInvalidString' (shaders only)
+    std::uint32_t   profileOffset;      // Offset into the string table or 'g_assetPackInvalidString' (shaders only)
+    std::uint32_t   extent[3];          // Texture extent (textures only)
+    std::uint32_t   arrayLayers;        // Number of array layers (textures only)
+    std::uint32_t   mipLevels;          // Number of stored MIP-map levels (textures only)
+};
+
+static_assert(sizeof(AssetPackHeader) == 32, "AssetPackHeader must be 32 bytes");
+static_assert(sizeof(AssetPackEntry) == 64, "AssetPackEntry must be 64 bytes");
+
+
+/*
+ * Internal functions
+ */
+
+static bool IsAssetPackTextureType(const TextureType type)
+{
+    return (type != TextureType::Texture2DMS && type != TextureType::Texture2DMSArray);
+}
+
+static TextureDescriptor GetAssetPackTextureDesc(const AssetPackEntry& entry)
+{
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.type        = static_cast<TextureType>(entry.type);
+        textureDesc.format      = static_cast<Format>(entry.format);
+        textureDesc.extent      = Extent3D{ entry.extent[0], entry.extent[1], entry.extent[2] };
+        textureDesc.arrayLayers = entry.arrayLayers;
+        textureDesc.mipLevels   = entry.mipLevels;
+    }
+    return textureDesc;
+}
+
+// Returns the size of a tightly packed MIP-map level; compressed formats are rounded up to whole blocks.
+static std::uint64_t GetAssetPackMipDataSize(const TextureDescriptor& textureDesc, std::uint32_t mipLevel)
+{
+    const FormatAttributes& formatAttribs = GetFormatAttribs(textureDesc.format);
+    const Extent3D extent = GetMipExtent(textureDesc, mipLevel);
+    const std::uint64_t numBlocksX = (extent.width  + formatAttribs.blockWidth  - 1) / formatAttribs.blockWidth;
+    const std::uint64_t numBlocksY = (extent.height + formatAttribs.blockHeight - 1) / formatAttribs.blockHeight;
+    return (numBlocksX * numBlocksY * extent.depth * formatAttribs.bitSize / 8);
+}
+
+static std::uint64_t GetAssetPackTextureDataSize(const TextureDescriptor& textureDesc)
+{
+    std::uint64_t size = 0;
+    for_range(mipLevel, textureDesc.mipLevels)
+        size += GetAssetPackMipDataSize(textureDesc, mipLevel);
+    return size;
+}
+
+// Returns the region of the specified MIP-map level for all array layers.
+static TextureRegion GetAssetPackMipRegion(const TextureDescriptor& textureDesc, std::uint32_t mipLevel)
+{
+    const Extent3D extent = GetMipExtent(textureDesc.type, textureDesc.extent, mipLevel);
+    return TextureRegion
+    {
+        TextureSubresource{ 0, textureDesc.arrayLayers, mipLevel, 1 },
+        Offset3D{ 0, 0, 0 },
+        Extent3D
+        {
+            extent.width,
+            (textureDesc.type == TextureType::Texture1DArray ? 1u : extent.height),
+            (textureDesc.type == TextureType::Texture3D ? extent.depth : 1u)
+        }
+    };
+}
+
+static std::uint64_t GetAlignedAssetPackOffset(std::uint64_t offset)
+{
+    return ((offset + g_assetPackAlignment - 1) / g_assetPackAlignment) * g_assetPackAlignment;
+}
+
+
+/*
+ * AssetPackWriter::Pimpl struct
+ */
+
+struct AssetPackWriterEntry
+{
+    AssetPackEntry      header;
+    std::string         name;
+    std::string         entryPoint;
+    std::string         profile;
+    bool                hasEntryPoint   = false;
+    bool                hasProfile      = false;
+    std::vector<char>   data;
+};
+
+struct AssetPackWriter::Pimpl
+{
+    std::vector<AssetPackWriterEntry> entries;
+};
+
+
+/*
+ * AssetPackWriter class
+ */
+
+AssetPackWriter::AssetPackWriter() :
+    pimpl_ { new Pimpl{} }
+{
+}
+
+AssetPackWriter::~AssetPackWriter()
+{
+    delete pimpl_;
+}
+
+bool AssetPackWriter::AddShader(const char* name, const ShaderDescriptor& shaderDesc, const ShadingLanguage language)
+{
+    if (name == nullptr || shaderDesc.source == nullptr)
+        return false;
+
+    /* Store code strings with their null terminator, so they can be passed straight from the mapping */
+    std::size_t sourceSize = 0;
+    switch (shaderDesc.sourceType)
+    {
+        case ShaderSourceType::CodeString:
+            sourceSize = (shaderDesc.sourceSize > 0 ? shaderDesc.sourceSize : std::strlen(shaderDesc.source)) + 1;
+            break;
+        case ShaderSourceType::BinaryBuffer:
+            sourceSize = shaderDesc.sourceSize;
+            break;
+        default:
+            return false;
+    }
+
+    if (sourceSize == 0)
+        return false;
+
+    AssetPackWriterEntry entry;
+    {
+        entry.header                = {};
+        entry.header.kind           = AssetPackEntryShader;
+        entry.header.type           = static_cast<std::uint32_t>(shaderDesc.type);
+        entry.header.format         = static_cast<std::uint32_t>(language);
+        entry.header.sourceType     = static_cast<std::uint32_t>(shaderDesc.sourceType);
+        entry.name                  = name;
+        entry.hasEntryPoint         = (shaderDesc.entryPoint != nullptr);
+        entry.hasProfile            = (shaderDesc.profile != nullptr);
+        if (entry.hasEntryPoint)
+            entry.entryPoint = shaderDesc.entryPoint;
+        if (entry.hasProfile)
+            entry.profile = shaderDesc.profile;
+        entry.data.assign(shaderDesc.source, shaderDesc.source + sourceSize);
+        if (shaderDesc.sourceType == ShaderSourceType::CodeString)
+            entry.data.back() = '\0';
+    }
+    pimpl_->entries.push_back(std::move(entry));
+
+    return true;
+}
+
+bool AssetPackWriter::AddTexture(const char* name, const TextureDescriptor& textureDesc, const void* data, std::size_t dataSize)
+{
+    if (name == nullptr || data == nullptr || !IsAssetPackTextureType(textureDesc.type))
+        return false;
+
+    /* Texture names must be unique, since there are no variants of textures */
+    for (const AssetPackWriterEntry& entry : pimpl_->entries)
+    {
+        if (entry.header.kind == AssetPackEntryTexture && entry.name == name)
+            return false;
+    }
+
+    /* Only accept formats that every backend can upload without conversion */
+    ImageFormat imageFormat;
+    DataType dataType;
+    if (!GetPassthroughImageFormat(textureDesc.format, imageFormat, dataType))
+        return false;
+
+    TextureDescriptor packedDesc = textureDesc;
+    {
+        const std::uint32_t maxMipLevels = NumMipLevels(textureDesc.type, textureDesc.extent);
+        packedDesc.mipLevels = (textureDesc.mipLevels == 0 ? maxMipLevels : std::min(textureDesc.mipLevels, maxMipLevels));
+        if (textureDesc.type == TextureType::TextureCube)
+            packedDesc.arrayLayers = 6;
+    }
+
+    if (packedDesc.mipLevels == 0 || packedDesc.arrayLayers == 0 || GetAssetPackTextureDataSize(packedDesc) != dataSize)
+        return false;
+
+    AssetPackWriterEntry entry;
+    {
+        entry.header                = {};
+        entry.header.kind           = AssetPackEntryTexture;
+        entry.header.type           = static_cast<std::uint32_t>(packedDesc.type);
+        entry.header.format         = static_cast<std::uint32_t>(packedDesc.format);
+        entry.header.extent[0]      = packedDesc.extent.width;
+        entry.header.extent[1]      = packedDesc.extent.height;
+        entry.header.extent[2]      = packedDesc.extent.depth;
+        entry.header.arrayLayers    = packedDesc.arrayLayers;
+        entry.header.mipLevels      = packedDesc.mipLevels;
+        entry.name                  = name;
+        entry.data.assign(static_cast<const char*>(data), static_cast<const char*>(data) + dataSize);
+    }
+    pimpl_->entries.push_back(std::move(entry));
+
+    return true;
+}
+
+static std::uint32_t AppendAssetPackString(std::string& stringTable, const std::string& str)
+{
+    const std::uint32_t offset = static_cast<std::uint32_t>(stringTable.size());
+    stringTable.append(str.c_str(), str.size() + 1);
+    return offset;
+}
+
+bool AssetPackWriter::WriteFile(const char* filename) const
+{
+    /* Build entry index and string table */
+    std::vector<AssetPackEntry> index;
+    std::string stringTable;
+
+    index.reserve(pimpl_->entries.size());
+    for (const AssetPackWriterEntry& entry : pimpl_->entries)
+    {
+        AssetPackEntry header = entry.header;
+        {
+            header.nameOffset       = AppendAssetPackString(stringTable, entry.name);
+            header.entryPointOffset = (entry.hasEntryPoint ? AppendAssetPackString(stringTable, entry.entryPoint) : g_assetPackInvalidString);
+            header.profileOffset    = (entry.hasProfile ? AppendAssetPackString(stringTable, entry.profile) : g_assetPackInvalidString);
+            header.dataSize         = entry.data.size();
+        }
+        index.push_back(header);
+    }
+
+    AssetPackHeader header;
+    {
+        ::memcpy(header.magic, g_assetPackMagic, sizeof(header.magic));
+        header.version              = g_assetPackVersion;
+        header.numEntries           = static_cast<std::uint32_t>(index.size());
+        header.stringTableSize      = static_cast<std::uint32_t>(stringTable.size());
+        header.indexOffset          = sizeof(AssetPackHeader);
+        header.stringTableOffset    = header.indexOffset + sizeof(AssetPackEntry) * index.size();
+    }
+
+    /* Assign aligned payload offsets behind the string table */
+    std::uint64_t offset = header.stringTableOffset + stringTable.size();
+    for (AssetPackEntry& entry : index)
+    {
+        entry.dataOffset = GetAlignedAssetPackOffset(offset);
+        offset = entry.dataOffset + entry.dataSize;
+    }
+
+    std::ofstream file{ filename, std::ios_base::out | std::ios_base::binary };
+    if (!file.good())
+        return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(sizeof(AssetPackEntry) * index.size()));
+    file.write(stringTable.data(), static_cast<std::streamsize>(stringTable.size()));
+
+    offset = header.stringTableOffset + stringTable.size();
+    const char padding[g_assetPackAlignment] = {};
+
+    for_range(i, index.size())
+    {
+        file.write(padding, static_cast<std::streamsize>(index[i].dataOffset - offset));
+        file.write(pimpl_->entries[i].data.data(), static_cast<std::streamsize>(index[i].dataSize));
+        offset = index[i].dataOffset + index[i].dataSize;
+    }
+
+    return file.good();
+}
+
+void AssetPackWriter::Clear()
+{
+    pimpl_->entries.clear();
+}
+
+
+/*
+ * AssetPack::Pimpl struct
+ */
+
+struct AssetPack::Pimpl
+{
+    std::unique_ptr<MappedFile>         file;
+    const char*                         data            = nullptr;
+    const char*                         strings         = nullptr;
+    std::uint32_t                       stringTableSize = 0;
+    std::vector<const AssetPackEntry*>  index;          // Sorted by kind and name; variants with the same name keep their order of the file
+
+    bool Load(std::unique_ptr<MappedFile>&& mappedFile);
+    bool ValidateEntry(const AssetPackEntry& entry, std::size_t fileSize) const;
+    bool IsValidString(std::uint32_t offset, bool optional) const;
+
+    const char* GetString(std::uint32_t offset) const;
+    const char* GetData(const AssetPackEntry& entry) const;
+    void FindEntries(std::uint32_t kind, const char* name, const AssetPackEntry* const *& outBegin, const AssetPackEntry* const *& outEnd) const;
+};
+
+bool AssetPack::Pimpl::Load(std::unique_ptr<MappedFile>&& mappedFile)
+{
+    data = static_cast<const char*>(mappedFile->GetData());
+    const std::size_t size = mappedFile->GetSize();
+
+    /* Validate header and bounds of entry index and string table */
+    if (size < sizeof(AssetPackHeader))
+        return false;
+
+    AssetPackHeader header;
+    ::memcpy(&header, data, sizeof(header));
+
+    if (::memcmp(header.magic, g_assetPackMagic, sizeof(header.magic)) != 0 || header.version != g_assetPackVersion)
+        return false;
+
+    if (header.indexOffset % alignof(AssetPackEntry) != 0 ||
+        header.indexOffset > size ||
+        header.numEntries > (size - header.indexOffset) / sizeof(AssetPackEntry))
+    {
+        return false;
+    }
+
+    if (header.stringTableOffset > size ||
+        header.stringTableSize > size - header.stringTableOffset ||
+        (header.stringTableSize > 0 && data[header.stringTableOffset + header.stringTableSize - 1] != '\0'))
+    {
+        return false;
+    }
+
+    strings         = data + header.stringTableOffset;
+    stringTableSize = header.stringTableSize;
+
+    /* Validate all entries before any of them is used */
+    const AssetPackEntry* entries = reinterpret_cast<const AssetPackEntry*>(data + header.indexOffset);
+    for_range(i, header.numEntries)
+    {
+        if (!ValidateEntry(entries[i], size))
+            return false;
+    }
+
+    index.resize(header.numEntries);
+    for_range(i, header.numEntries)
+        index[i] = &entries[i];
+
+    std::stable_sort(
+        index.begin(),
+        index.end(),
+        [this](const AssetPackEntry* lhs, const AssetPackEntry* rhs)
+        {
+            if (lhs->kind != rhs->kind)
+                return (lhs->kind < rhs->kind);
+            return (std::strcmp(GetString(lhs->nameOffset), GetString(rhs->nameOffset)) < 0);
+        }
+    );
+
+    file = std::move(mappedFile);
+
+    return true;
+}
+
+bool AssetPack::Pimpl::ValidateEntry(const AssetPackEntry& entry, std::size_t fileSize) const
+{
+    if (!IsValidString(entry.nameOffset, false))
+        return false;
+
+    if (entry.dataOffset > fileSize || entry.dataSize > fileSize - entry.dataOffset)
+        return false;
+
+    switch (entry.kind)
+    {
+        case AssetPackEntryShader:
+        {
+            if (!IsValidString(entry.entryPointOffset, true) || !IsValidString(entry.profileOffset, true) || entry.dataSize == 0)
+                return false;
+
+            /* Code strings are passed through the mapping, so they must be null-terminated */
+            const ShaderSourceType sourceType = static_cast<ShaderSourceType>(entry.sourceType);
+            if (sourceType == ShaderSourceType::CodeString)
+                return (GetData(entry)[entry.dataSize - 1] == '\0');
+            return (sourceType == ShaderSourceType::BinaryBuffer);
+        }
+
+        case AssetPackEntryTexture:
+        {
+            /* The texture descriptor must describe exactly the stored texel data */
+            const TextureDescriptor textureDesc = GetAssetPackTextureDesc(entry);
+            ImageFormat imageFormat;
+            DataType dataType;
+            if (!IsAssetPackTextureType(textureDesc.type) ||
+                !GetPassthroughImageFormat(textureDesc.format, imageFormat, dataType) ||
+                textureDesc.arrayLayers == 0 ||
+                textureDesc.mipLevels == 0 ||
+                textureDesc.mipLevels > NumMipLevels(textureDesc.type, textureDesc.extent))
+            {
+                return false;
+            }
+            return (GetAssetPackTextureDataSize(textureDesc) == entry.dataSize);
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool AssetPack::Pimpl::IsValidString(std::uint32_t offset, bool optional) const
+{
+    if (offset == g_assetPackInvalidString)
+        return optional;
+    return (offset < stringTableSize);
+}
+
+const char* AssetPack::Pimpl::GetString(std::uint32_t offset) const
+{
+    return (offset != g_assetPackInvalidString ? strings + offset : nullptr);
+}
+
+const char* AssetPack::Pimpl::GetData(const AssetPackEntry& entry) const
+{
+    return (data + entry.dataOffset);
+}
+
+void AssetPack::Pimpl::FindEntries(std::uint32_t kind, const char* name, const AssetPackEntry* const *& outBegin, const AssetPackEntry* const *& outEnd) const
+{
+    auto range = std::equal_range(
+        index.begin(),
+        index.end(),
+        nullptr,
+        [this, kind, name](const AssetPackEntry* lhs, const AssetPackEntry* rhs) -> bool
+        {
+            /* Null pointers denote the searched key */
+            const std::uint32_t lhsKind = (lhs != nullptr ? lhs->kind : kind);
+            const std::uint32_t rhsKind = (rhs != nullptr ? rhs->kind : kind);
+            if (lhsKind != rhsKind)
+                return (lhsKind < rhsKind);
+            const char* lhsName = (lhs != nullptr ? GetString(lhs->nameOffset) : name);
+            const char* rhsName = (rhs != nullptr ? GetString(rhs->nameOffset) : name);
+            return (std::strcmp(lhsName, rhsName) < 0);
+        }
+    );
+    outBegin    = index.data() + (range.first - index.begin());
+    outEnd      = index.data() + (range.second - index.begin());
+}
+
+
+/*
+ * AssetPack class
+ */
+
+AssetPack::AssetPack() :
+    pimpl_ { new Pimpl{} }
+{
+}
+
+AssetPack::AssetPack(const char* filename) :
+    AssetPack {}
+{
+    Open(filename);
+}
+
+AssetPack::~AssetPack()
+{
+    delete pimpl_;
+}
+
+bool AssetPack::Open(const char* filename)
+{
+    Close();
+
+    if (filename == nullptr)
+        return false;
+
+    std::unique_ptr<MappedFile> mappedFile = MappedFile::Open(filename);
+    if (!mappedFile)
+        return false;
+
+    if (!pimpl_->Load(std::move(mappedFile)))
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void AssetPack::Close()
+{
+    pimpl_->index.clear();
+    pimpl_->data            = nullptr;
+    pimpl_->strings         = nullptr;
+    pimpl_->stringTableSize = 0;
+    pimpl_->file.reset();
+}
+
+bool AssetPack::IsOpen() const
+{
+    return (pimpl_->file != nullptr);
+}
+
+bool AssetPack::GetShaderDescriptor(const char* name, const ArrayView<ShadingLanguage>& languages, ShaderDescriptor& outShaderDesc) const
+{
+    if (name == nullptr || !IsOpen())
+        return false;
+
+    const AssetPackEntry* const * begin = nullptr;
+    const AssetPackEntry* const * end   = nullptr;
+    pimpl_->FindEntries(AssetPackEntryShader, name, begin, end);
+
+    for (const AssetPackEntry* const * it = begin; it != end; ++it)
+    {
+        const AssetPackEntry& entry = **it;
+        const ShadingLanguage language = static_cast<ShadingLanguage>(entry.format);
+        if (std::find(languages.begin(), languages.end(), language) != languages.end())
+        {
+            const ShaderSourceType sourceType = static_cast<ShaderSourceType>(entry.sourceType);
+            outShaderDesc.type          = static_cast<ShaderType>(entry.type);
+            outShaderDesc.source        = pimpl_->GetData(entry);
+            outShaderDesc.sourceSize    = static_cast<std::size_t>(sourceType == ShaderSourceType::CodeString ? entry.dataSize - 1 : entry.dataSize);
+            outShaderDesc.sourceType    = sourceType;
+            outShaderDesc.entryPoint    = pimpl_->GetString(entry.entryPointOffset);
+            outShaderDesc.profile       = pimpl_->GetString(entry.profileOffset);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Shader* AssetPack::CreateShader(RenderSystem& renderSystem, const char* name, const ShaderDescriptor& shaderDesc) const
+{
+    ShaderDescriptor packedShaderDesc = shaderDesc;
+    if (!GetShaderDescriptor(name, renderSystem.GetRenderingCaps().shadingLanguages, packedShaderDesc))
+        return nullptr;
+    return renderSystem.CreateShader(packedShaderDesc);
+}
+
+bool AssetPack::GetTextureDescriptor(const char* name, TextureDescriptor& outTextureDesc) const
+{
+    if (name == nullptr || !IsOpen())
+        return false;
+
+    const AssetPackEntry* const * begin = nullptr;
+    const AssetPackEntry* const * end   = nullptr;
+    pimpl_->FindEntries(AssetPackEntryTexture, name, begin, end);
+
+    if (begin == end)
+        return false;
+
+    const TextureDescriptor packedDesc = GetAssetPackTextureDesc(**begin);
+    outTextureDesc.type         = packedDesc.type;
+    outTextureDesc.format       = packedDesc.format;
+    outTextureDesc.extent       = packedDesc.extent;
+    outTextureDesc.arrayLayers  = packedDesc.arrayLayers;
+    outTextureDesc.mipLevels    = packedDesc.mipLevels;
+
+    return true;
+}
+
+Texture* AssetPack::CreateTexture(RenderSystem& renderSystem, const char* name, long bindFlags) const
+{
+    TextureDescriptor textureDesc;
+    if (!GetTextureDescriptor(name, textureDesc))
+        return nullptr;
+
+    ImageFormat imageFormat;
+    DataType dataType;
+    if (!GetPassthroughImageFormat(textureDesc.format, imageFormat, dataType))
+        return nullptr;
+
+    const AssetPackEntry* const * begin = nullptr;
+    const AssetPackEntry* const * end   = nullptr;
+    pimpl_->FindEntries(AssetPackEntryTexture, name, begin, end);
+    const char* data = pimpl_->GetData(**begin);
+
+    /* Create texture with the first MIP-map level from the mapping; all levels are stored, so none must be generated */
+    textureDesc.bindFlags   = bindFlags;
+    textureDesc.miscFlags   = MiscFlags::FixedSamples;
+
+    const std::size_t mip0DataSize = static_cast<std::size_t>(GetAssetPackMipDataSize(textureDesc, 0));
+    const SrcImageDescriptor mip0ImageDesc{ imageFormat, dataType, data, mip0DataSize };
+
+    Texture* texture = renderSystem.CreateTexture(textureDesc, &mip0ImageDesc);
+    if (texture == nullptr)
+        return nullptr;
+
+    /* Upload remaining MIP-map levels straight from the mapping */
+    std::size_t offset = mip0DataSize;
+    for_subrange(mipLevel, 1u, textureDesc.mipLevels)
+    {
+        const std::size_t mipDataSize = static_cast<std::size_t>(GetAssetPackMipDataSize(textureDesc, mipLevel));
+        const SrcImageDescriptor mipImageDesc{ imageFormat, dataType, data + offset, mipDataSize };
+        renderSystem.WriteTexture(*texture, GetAssetPackMipRegion(textureDesc, mipLevel), mipImageDesc);
+        offset += mipDataSize;
+    }
+
+    return texture;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -9,6 +9,7 @@
 #include <LLGL/Buffer.h>
 #include <LLGL/Texture.h>
 #include <LLGL/Sampler.h>
+#include <LLGL/AccelerationStructure.h>
 #include "../Core/StringUtils.h"
 #include "../Core/Exception.h"
 #include <algorithm>
@@ -65,10 +66,11 @@ static const char* ResourceTypeToString(const ResourceType t)
 {
     switch (t)
     {
-        case ResourceType::Buffer:  return "Buffer";
-        case ResourceType::Texture: return "Texture";
-        case ResourceType::Sampler: return "Sampler";
-        default:                    return "Undefined";
+        case ResourceType::Buffer:                  return "Buffer";
+        case ResourceType::Texture:                 return "Texture";
+        case ResourceType::Sampler:                 return "Sampler";
+        case ResourceType::AccelerationStructure:   return "AccelerationStructure";
+        default:                                    return "Undefined";
     }
 }
 
@@ -130,6 +132,11 @@ LLGL_EXPORT Sampler* GetAsExpectedSampler(Resource* resource)
     return GetAsExpectedResource<Sampler, ResourceType::Sampler>(resource);
 }
 
+LLGL_EXPORT AccelerationStructure* GetAsExpectedAccelerationStructure(Resource* resource)
+{
+    return GetAsExpectedResource<AccelerationStructure, ResourceType::AccelerationStructure>(resource);
+}
+
 
 } // /namespace LLGL
 
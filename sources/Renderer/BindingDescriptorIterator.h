@@ -55,6 +55,7 @@ class LLGL_EXPORT BindingDescriptorIterator
 LLGL_EXPORT Buffer* GetAsExpectedBuffer(Resource* resource, long anyBindFlags = 0);
 LLGL_EXPORT Texture* GetAsExpectedTexture(Resource* resource, long anyBindFlags = 0);
 LLGL_EXPORT Sampler* GetAsExpectedSampler(Resource* resource);
+LLGL_EXPORT AccelerationStructure* GetAsExpectedAccelerationStructure(Resource* resource);
 
 
 } // /namespace LLGL
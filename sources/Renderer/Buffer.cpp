@@ -22,6 +22,11 @@ ResourceType Buffer::GetResourceType() const
     return ResourceType::Buffer;
 }
 
+std::uint64_t Buffer::GetDeviceAddress() const
+{
+    return 0; // dummy
+}
+
 
 } // /namespace LLGL
 
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/BufferFlags.h>
+#include <cstring>
 
 
 namespace LLGL
@@ -40,6 +41,47 @@ inline bool IsBufferViewEnabled(const BufferViewDescriptor& bufferViewDesc)
     );
 }
 
+// Returns the size (in bytes) of the buffer range that begins at <offset>. If <size> is Constants::wholeSize, the range extends to the end of the buffer.
+inline std::uint64_t GetBufferRangeSize(std::uint64_t bufferSize, std::uint64_t offset, std::uint64_t size)
+{
+    if (offset >= bufferSize)
+        return 0;
+    return (size == Constants::wholeSize ? bufferSize - offset : size);
+}
+
+// Returns true if the specified buffer is to be placed in host-visible memory, i.e. it has CPU access flags and the MiscFlags::HostVisible hint but is not sparse.
+inline bool IsHostVisibleBuffer(const BufferDescriptor& desc)
+{
+    return
+    (
+        (desc.miscFlags & MiscFlags::HostVisible) != 0 &&
+        (desc.miscFlags & MiscFlags::Sparse) == 0 &&
+        desc.cpuAccessFlags != 0
+    );
+}
+
+// Returns true if the specified buffer is a host-visible readback buffer, i.e. a host-visible buffer with CPU read access only.
+inline bool IsReadbackBuffer(const BufferDescriptor& desc)
+{
+    return (IsHostVisibleBuffer(desc) && (desc.cpuAccessFlags & CPUAccessFlags::Write) == 0);
+}
+
+/*
+Returns true if the buffer fill pattern consists of a single repeated 32-bit value and writes that value to <outValue>.
+Such patterns can be forwarded to the native 32-bit fill commands (see CommandBuffer::FillBufferPattern).
+*/
+inline bool GetUniformFillPatternValue(const void* pattern, std::uint32_t patternSize, std::uint32_t& outValue)
+{
+    const char* patternBytes = static_cast<const char*>(pattern);
+    std::memcpy(&outValue, patternBytes, sizeof(outValue));
+    for (std::uint32_t offset = sizeof(outValue); offset + sizeof(outValue) <= patternSize; offset += sizeof(outValue))
+    {
+        if (std::memcmp(&outValue, patternBytes + offset, sizeof(outValue)) != 0)
+            return false;
+    }
+    return true;
+}
+
 
 } // /namespace LLGL
 
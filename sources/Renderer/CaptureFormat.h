@@ -0,0 +1,199 @@
+/*
+ * CaptureFormat.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_CAPTURE_FORMAT_H
+#define LLGL_CAPTURE_FORMAT_H
+
+
+#include "Serialization.h"
+#include <LLGL/BufferFlags.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/SamplerFlags.h>
+#include <LLGL/RenderPassFlags.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace Capture
+{
+
+
+/*
+A capture file is a flat list of serialization segments that is written by the debug layer (see RenderingDebugger::BeginCapture)
+and read by the CaptureReplay utility. The first segment is always the file header:
+
+    Header              CaptureHeader
+    DefXXX              Object definition, written right before an object is referenced for the first time
+    EvtXXX              Event that is replayed in the same order, e.g. EvtEncoding or EvtPresent
+    ...
+
+An EvtEncoding segment contains the object ID of the command buffer followed by a nested list of CmdXXX segments,
+one for each CommandBuffer function that was called between CommandBuffer::Begin and CommandBuffer::End.
+Objects are referred to by their ID, which is never zero; the ID zero denotes a null pointer.
+Descriptors without pointers or strings are written as raw memory, which is why GetLayoutSignature() must match between capture and replay.
+*/
+
+// Magic number at the beginning of each capture file ("LLGC").
+static constexpr std::uint32_t magic    = 0x43474C4C;
+static constexpr std::uint32_t version  = 5;
+
+// Object identifier within a capture file. Zero denotes a null pointer.
+using ObjectID = std::uint32_t;
+
+enum Ident : Serialization::IdentType
+{
+    Header                      = 0x0001,
+
+    /* ----- Object definitions ----- */
+    DefBuffer                   = 0x0100,
+    DefBufferArray,
+    DefTexture,
+    DefSampler,
+    DefRenderPass,
+    DefRenderTarget,
+    DefSwapChain,
+    DefShader,
+    DefPipelineLayout,
+    DefPipelineState,
+    DefResourceHeap,
+    DefQueryHeap,
+    DefCommandBuffer,
+
+    /* ----- Events ----- */
+    EvtEncoding                 = 0x0200,
+    EvtSubmit,
+    EvtPresent,
+    EvtWriteBuffer,
+    EvtWriteTexture,
+    EvtWriteResourceHeap,
+
+    /* ----- Commands ----- */
+    CmdExecute                  = 0x0300,
+    CmdUpdateBuffer,
+    CmdCopyBuffer,
+    CmdCopyBufferFromTexture,
+    CmdFillBuffer,
+    CmdCopyTexture,
+    CmdCopyTextureFromBuffer,
+    CmdCopyTextureFromFramebuffer,
+    CmdGenerateMips,
+    CmdGenerateMipsRange,
+    CmdSetViewport,
+    CmdSetViewports,
+    CmdSetScissor,
+    CmdSetScissors,
+    CmdSetVertexBuffer,
+    CmdSetVertexBufferArray,
+    CmdSetIndexBuffer,
+    CmdSetIndexBufferFormat,
+    CmdSetResourceHeap,
+    CmdSetResource,
+    CmdSetResourceRange,
+    CmdResetResourceSlots,
+    CmdBeginRenderPass,
+    CmdEndRenderPass,
+    CmdClear,
+    CmdClearAttachments,
+    CmdSetPipelineState,
+    CmdSetBlendFactor,
+    CmdSetStencilReference,
+    CmdSetUniforms,
+    CmdBeginQuery,
+    CmdEndQuery,
+    CmdBeginRenderCondition,
+    CmdEndRenderCondition,
+    CmdBeginStreamOutput,
+    CmdEndStreamOutput,
+    CmdDraw,
+    CmdDrawIndexed,
+    CmdDrawIndexedOffset,
+    CmdDrawInstanced,
+    CmdDrawInstancedFirst,
+    CmdDrawIndexedInstanced,
+    CmdDrawIndexedInstancedOffset,
+    CmdDrawIndexedInstancedFirst,
+    CmdDrawIndirect,
+    CmdDrawIndirectMulti,
+    CmdDrawIndexedIndirect,
+    CmdDrawIndexedIndirectMulti,
+    CmdDrawIndirectCount,
+    CmdDrawIndexedIndirectCount,
+    CmdDispatch,
+    CmdDispatchIndirect,
+    CmdPushDebugGroup,
+    CmdPopDebugGroup,
+    CmdDrawMeshTasks,
+    CmdDrawMeshTasksIndirect,
+    CmdCompressTexture,
+    CmdCompactIndirectArguments,
+    CmdDrawStreamOutput,
+    CmdFillBufferPattern,
+};
+
+// Render pass kinds of a pipeline state definition (see DefPipelineState).
+enum class RenderPassKind : std::uint8_t
+{
+    None,       // No render pass was specified
+    Custom,     // Render pass is described by a RenderPassDescriptor
+    SwapChain,  // Render pass of the swap-chain, which is replaced by the render pass of the replay swap-chain
+};
+
+// Header segment of a capture file.
+struct CaptureHeader
+{
+    std::uint32_t   magic;
+    std::uint32_t   version;
+    std::uint32_t   layoutSignature;
+    std::int32_t    rendererID;
+};
+
+// Returns the signature of all descriptor memory layouts that are serialized as raw memory.
+inline std::uint32_t GetLayoutSignature()
+{
+    std::uint32_t signature = static_cast<std::uint32_t>(sizeof(Serialization::SizeType));
+    auto Combine = [&signature](std::size_t size)
+    {
+        signature = signature * 31u + static_cast<std::uint32_t>(size);
+    };
+    Combine(sizeof(long));
+    Combine(sizeof(TextureDescriptor));
+    Combine(sizeof(SamplerDescriptor));
+    Combine(sizeof(RenderPassDescriptor));
+    Combine(sizeof(DepthDescriptor));
+    Combine(sizeof(StencilDescriptor));
+    Combine(sizeof(RasterizerDescriptor));
+    Combine(sizeof(BlendDescriptor));
+    Combine(sizeof(TessellationDescriptor));
+    Combine(sizeof(ShadingRateDescriptor));
+    Combine(sizeof(QueryHeapDescriptor));
+    Combine(sizeof(TextureViewDescriptor));
+    Combine(sizeof(BufferViewDescriptor));
+    Combine(sizeof(TextureRegion));
+    Combine(sizeof(TextureLocation));
+    Combine(sizeof(Viewport));
+    Combine(sizeof(Scissor));
+    Combine(sizeof(ClearValue));
+    Combine(sizeof(AttachmentClear));
+    return signature;
+}
+
+
+} // /namespace Capture
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
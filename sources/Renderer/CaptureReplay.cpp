@@ -0,0 +1,1626 @@
+/*
+ * CaptureReplay.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/CaptureReplay.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/CommandQueue.h>
+#include <LLGL/SwapChain.h>
+#include <LLGL/Log.h>
+#include <LLGL/Report.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/StaticLimits.h>
+#include <LLGL/Utils/ForRange.h>
+#include "CaptureFormat.h"
+#include "Serialization.h"
+#include "../Core/Assertion.h"
+#include "../Core/StringUtils.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Reads the arguments of a single capture segment. Reading beyond the segment invalidates the reader instead of trapping.
+class CaptureReader
+{
+
+    public:
+
+        CaptureReader(const void* data, std::size_t size) :
+            pos_ { static_cast<const char*>(data) },
+            end_ { static_cast<const char*>(data) + size }
+        {
+        }
+
+        template <typename T>
+        void Read(T& outValue)
+        {
+            static_assert(std::is_standard_layout<T>::value, "LLGL::CaptureReader::Read<T> only accepts standard layout types");
+            ReadBytes(&outValue, sizeof(T));
+        }
+
+        template <typename T>
+        T Read()
+        {
+            T value;
+            Read(value);
+            return value;
+        }
+
+        const char* ReadCString()
+        {
+            const char* str = pos_;
+            while (pos_ < end_ && *pos_ != '\0')
+                ++pos_;
+            if (pos_ == end_)
+            {
+                valid_ = false;
+                return "";
+            }
+            ++pos_;
+            return str;
+        }
+
+        // Reads a 64-bit size followed by the raw bytes and returns a pointer to them.
+        const char* ReadData(std::size_t& outSize)
+        {
+            const std::uint64_t size = Read<std::uint64_t>();
+            if (size > GetRemainingSize())
+            {
+                valid_ = false;
+                outSize = 0;
+                return nullptr;
+            }
+            const char* data = pos_;
+            pos_ += size;
+            outSize = static_cast<std::size_t>(size);
+            return data;
+        }
+
+        // Reads an array that has been written with DbgCaptureStream::Array and copies it into aligned memory.
+        template <typename T>
+        void ReadArray(std::vector<T>& outArray)
+        {
+            std::size_t size = 0;
+            const char* data = ReadData(size);
+            outArray.resize(size / sizeof(T));
+            if (!outArray.empty())
+                ::memcpy(outArray.data(), data, outArray.size() * sizeof(T));
+        }
+
+        // Reads an array of the specified length that has been written as raw memory.
+        template <typename T>
+        void ReadRaw(std::vector<T>& outArray, std::size_t count)
+        {
+            outArray.resize(count);
+            for (T& entry : outArray)
+                Read(entry);
+        }
+
+        inline const char* GetPosition() const
+        {
+            return pos_;
+        }
+
+        inline std::size_t GetRemainingSize() const
+        {
+            return static_cast<std::size_t>(end_ - pos_);
+        }
+
+        inline bool IsValid() const
+        {
+            return valid_;
+        }
+
+    private:
+
+        void ReadBytes(void* data, std::size_t size)
+        {
+            if (size > GetRemainingSize())
+            {
+                valid_ = false;
+                ::memset(data, 0, size);
+                return;
+            }
+            ::memcpy(data, pos_, size);
+            pos_ += size;
+        }
+
+    private:
+
+        const char* pos_    = nullptr;
+        const char* end_    = nullptr;
+        bool        valid_  = true;
+
+};
+
+// Segment of a capture file that is either an object definition or an event.
+struct CaptureSegment
+{
+    Capture::Ident  ident;
+    const char*     data;
+    std::size_t     size;
+};
+
+// Object that has been created for a definition of the capture.
+struct CaptureObject
+{
+    Capture::Ident  ident;
+    void*           object;
+};
+
+// Information about a command buffer of the capture that is required to submit it.
+struct CaptureCommandBufferInfo
+{
+    long                flags       = 0;
+    CommandQueueType    queueType   = CommandQueueType::Graphics;
+    bool                encoded     = false;
+};
+
+struct CaptureReplay::Pimpl
+{
+    bool CreateObject(const CaptureSegment& segment);
+    bool CreateBuffer(CaptureReader& reader);
+    bool CreateBufferArray(CaptureReader& reader);
+    bool CreateTexture(CaptureReader& reader);
+    bool CreateSampler(CaptureReader& reader);
+    bool CreateRenderPass(CaptureReader& reader);
+    bool CreateRenderTarget(CaptureReader& reader);
+    bool CreateSwapChain(CaptureReader& reader);
+    bool CreateShader(CaptureReader& reader);
+    bool CreatePipelineLayout(CaptureReader& reader);
+    bool CreatePipelineState(CaptureReader& reader);
+    bool CreateResourceHeap(CaptureReader& reader);
+    bool CreateQueryHeap(CaptureReader& reader);
+    bool CreateCommandBuffer(CaptureReader& reader);
+
+    void AddObject(Capture::ObjectID id, Capture::Ident ident, void* object);
+    void* FindObject(Capture::ObjectID id, Capture::Ident ident) const;
+
+    template <typename T>
+    T* Find(Capture::ObjectID id, Capture::Ident ident) const
+    {
+        return static_cast<T*>(FindObject(id, ident));
+    }
+
+    template <typename T>
+    T& Get(Capture::ObjectID id, Capture::Ident ident) const
+    {
+        T* object = Find<T>(id, ident);
+        LLGL_ASSERT(object != nullptr, "invalid object ID in capture: %u", id);
+        return *object;
+    }
+
+    Resource* FindResource(Capture::ObjectID id) const;
+    RenderTarget* FindRenderTarget(Capture::ObjectID id) const;
+
+    void ReadResourceViews(CaptureReader& reader, std::vector<ResourceViewDescriptor>& outResourceViews) const;
+
+    void ReplayEvent(const CaptureSegment& segment);
+    void ReplayEncoding(CaptureReader& reader);
+    void ReplayCommand(CommandBuffer& cmdBuffer, Capture::Ident ident, CaptureReader& reader);
+
+    void ReleaseObjects();
+
+    std::vector<char>                                                   fileData;
+    Capture::CaptureHeader                                              header          = {};
+    Extent2D                                                            resolution;
+    std::vector<CaptureSegment>                                         definitions;
+    std::vector<CaptureSegment>                                         events;
+    std::vector<std::size_t>                                            frameOffsets;   // Index of the first event of each frame and the end of the last one
+
+    RenderSystem*                                                       renderSystem    = nullptr;
+    SwapChain*                                                          swapChain       = nullptr;
+    std::unordered_map<Capture::ObjectID, CaptureObject>                objects;
+    std::vector<Capture::ObjectID>                                      creationOrder;  // Objects are released in reverse order
+    std::unordered_map<Capture::ObjectID, CaptureCommandBufferInfo>     commandBuffers;
+
+    // Scratch memory to copy unaligned arrays out of the capture
+    std::vector<Viewport>                                               viewports;
+    std::vector<Scissor>                                                scissors;
+    std::vector<ClearValue>                                             clearValues;
+    std::vector<AttachmentClear>                                        attachmentClears;
+};
+
+static bool IsCaptureHeaderCompatible(const Capture::CaptureHeader& header, const char* filename)
+{
+    if (header.magic != Capture::magic)
+    {
+        Log::Errorf("error: file is not a capture: %s\n", filename);
+        return false;
+    }
+    if (header.version != Capture::version)
+    {
+        Log::Errorf("error: capture version %u is not supported (expected %u): %s\n", header.version, Capture::version, filename);
+        return false;
+    }
+    if (header.layoutSignature != Capture::GetLayoutSignature())
+    {
+        Log::Errorf("error: capture was recorded with an incompatible version of LLGL or platform: %s\n", filename);
+        return false;
+    }
+    return true;
+}
+
+static bool IsDefinition(Capture::Ident ident)
+{
+    return (ident >= Capture::DefBuffer && ident < Capture::EvtEncoding);
+}
+
+
+/*
+ * CaptureReplay class
+ */
+
+CaptureReplay::CaptureReplay() :
+    pimpl_ { new Pimpl{} }
+{
+}
+
+CaptureReplay::~CaptureReplay()
+{
+    Release();
+    delete pimpl_;
+}
+
+bool CaptureReplay::LoadFromFile(const char* filename)
+{
+    LLGL_ASSERT_PTR(filename);
+
+    Release();
+    pimpl_->definitions.clear();
+    pimpl_->events.clear();
+    pimpl_->frameOffsets.clear();
+    pimpl_->resolution = Extent2D{};
+
+    /* Read entire file into memory; all segments refer to this memory */
+    std::ifstream file{ filename, std::ios_base::in | std::ios_base::binary };
+    if (!file.good())
+    {
+        Log::Errorf("error: failed to open capture file: %s\n", filename);
+        return false;
+    }
+    pimpl_->fileData = std::vector<char>{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+    /* Validate header segment */
+    Serialization::Deserializer deserializer{ pimpl_->fileData.data(), pimpl_->fileData.size() };
+    Serialization::Segment headerSeg = deserializer.Begin();
+    if (headerSeg.ident != Capture::Header || headerSeg.size != sizeof(Capture::CaptureHeader))
+    {
+        Log::Errorf("error: file is not a capture: %s\n", filename);
+        return false;
+    }
+    ::memcpy(&(pimpl_->header), headerSeg.data, sizeof(Capture::CaptureHeader));
+    deserializer.End();
+
+    if (!IsCaptureHeaderCompatible(pimpl_->header, filename))
+        return false;
+
+    /* Split all segments into object definitions and events, and start a new frame after each presentation */
+    pimpl_->frameOffsets.push_back(0);
+
+    for (Serialization::Segment seg = deserializer.Begin(); seg.ident != 0; seg = deserializer.Begin())
+    {
+        const CaptureSegment segment{ static_cast<Capture::Ident>(seg.ident), seg.data, static_cast<std::size_t>(seg.size) };
+        deserializer.End();
+
+        if (IsDefinition(segment.ident))
+        {
+            if (segment.ident == Capture::DefSwapChain && pimpl_->resolution.width == 0)
+            {
+                CaptureReader reader{ segment.data, segment.size };
+                reader.Read<Capture::ObjectID>();
+                reader.Read(pimpl_->resolution);
+            }
+            pimpl_->definitions.push_back(segment);
+        }
+        else
+        {
+            pimpl_->events.push_back(segment);
+            if (segment.ident == Capture::EvtPresent)
+                pimpl_->frameOffsets.push_back(pimpl_->events.size());
+        }
+    }
+
+    /* Events after the last presentation form another frame */
+    if (pimpl_->frameOffsets.back() != pimpl_->events.size())
+        pimpl_->frameOffsets.push_back(pimpl_->events.size());
+
+    return true;
+}
+
+std::uint32_t CaptureReplay::GetNumFrames() const
+{
+    return (pimpl_->frameOffsets.empty() ? 0 : static_cast<std::uint32_t>(pimpl_->frameOffsets.size() - 1));
+}
+
+int CaptureReplay::GetRendererID() const
+{
+    return pimpl_->header.rendererID;
+}
+
+Extent2D CaptureReplay::GetResolution() const
+{
+    return pimpl_->resolution;
+}
+
+bool CaptureReplay::Prepare(RenderSystem& renderSystem, SwapChain& swapChain)
+{
+    Release();
+
+    pimpl_->renderSystem    = &renderSystem;
+    pimpl_->swapChain       = &swapChain;
+
+    for (const CaptureSegment& segment : pimpl_->definitions)
+    {
+        if (!pimpl_->CreateObject(segment))
+        {
+            Release();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CaptureReplay::ReplayFrame(std::uint32_t frame)
+{
+    LLGL_ASSERT(pimpl_->renderSystem != nullptr, "capture replay has not been prepared");
+    LLGL_ASSERT(frame < GetNumFrames(), "capture frame %u out of range [0, %u)", frame, GetNumFrames());
+
+    for_subrange(i, pimpl_->frameOffsets[frame], pimpl_->frameOffsets[frame + 1])
+        pimpl_->ReplayEvent(pimpl_->events[i]);
+}
+
+void CaptureReplay::Release()
+{
+    pimpl_->ReleaseObjects();
+}
+
+
+/*
+ * Pimpl object creation
+ */
+
+bool CaptureReplay::Pimpl::CreateObject(const CaptureSegment& segment)
+{
+    CaptureReader reader{ segment.data, segment.size };
+
+    bool result = false;
+    switch (segment.ident)
+    {
+        case Capture::DefBuffer:            result = CreateBuffer(reader);          break;
+        case Capture::DefBufferArray:       result = CreateBufferArray(reader);     break;
+        case Capture::DefTexture:           result = CreateTexture(reader);         break;
+        case Capture::DefSampler:           result = CreateSampler(reader);         break;
+        case Capture::DefRenderPass:        result = CreateRenderPass(reader);      break;
+        case Capture::DefRenderTarget:      result = CreateRenderTarget(reader);    break;
+        case Capture::DefSwapChain:         result = CreateSwapChain(reader);       break;
+        case Capture::DefShader:            result = CreateShader(reader);          break;
+        case Capture::DefPipelineLayout:    result = CreatePipelineLayout(reader);  break;
+        case Capture::DefPipelineState:     result = CreatePipelineState(reader);   break;
+        case Capture::DefResourceHeap:      result = CreateResourceHeap(reader);    break;
+        case Capture::DefQueryHeap:         result = CreateQueryHeap(reader);       break;
+        case Capture::DefCommandBuffer:     result = CreateCommandBuffer(reader);   break;
+        default:                            result = true;                          break;
+    }
+
+    if (!reader.IsValid())
+    {
+        Log::Errorf("error: corrupted object definition in capture\n");
+        return false;
+    }
+
+    return result;
+}
+
+static void ReadVertexAttributes(CaptureReader& reader, std::vector<VertexAttribute>& outAttribs)
+{
+    outAttribs.resize(reader.Read<std::uint32_t>());
+    for (VertexAttribute& attrib : outAttribs)
+    {
+        attrib.name = reader.ReadCString();
+        reader.Read(attrib.format);
+        reader.Read(attrib.location);
+        reader.Read(attrib.semanticIndex);
+        reader.Read(attrib.systemValue);
+        reader.Read(attrib.slot);
+        reader.Read(attrib.offset);
+        reader.Read(attrib.stride);
+        reader.Read(attrib.instanceDivisor);
+    }
+}
+
+static void ReadBindingDescriptors(CaptureReader& reader, std::vector<BindingDescriptor>& outBindings)
+{
+    outBindings.resize(reader.Read<std::uint32_t>());
+    for (BindingDescriptor& binding : outBindings)
+    {
+        binding.name = reader.ReadCString();
+        reader.Read(binding.type);
+        reader.Read(binding.bindFlags);
+        reader.Read(binding.stageFlags);
+        reader.Read(binding.slot.index);
+        reader.Read(binding.slot.set);
+        reader.Read(binding.arraySize);
+    }
+}
+
+bool CaptureReplay::Pimpl::CreateBuffer(CaptureReader& reader)
+{
+    const auto id = reader.Read<Capture::ObjectID>();
+
+    std::vector<VertexAttribute> vertexAttribs;
+
+    BufferDescriptor bufferDesc;
+    {
+        reader.Read(bufferDesc.size);
+        reader.Read(bufferDesc.stride);
+        reader.Read(bufferDesc.format);
+        reader.Read(bufferDesc.bindFlags);
+        reader.Read(bufferDesc.cpuAccessFlags);
+        reader.Read(bufferDesc.miscFlags);
+        ReadVertexAttributes(reader, vertexAttribs);
+        bufferDesc.vertexAttribs = vertexAttribs;
+    }
+
+    std::size_t initialDataSize = 0;
+    const char* initialData = reader.ReadData(initialDataSize);
+
+    if (!reader.IsValid())
+        return false;
+
+    Buffer* buffer = renderSystem->CreateBuffer(bufferDesc, (initialDataSize == bufferDesc.size ? initialData : nullptr));
+    AddObject(id, Capture::DefBuffer, buffer);
+    return (buffer != nullptr);
+}
+
+bool CaptureReplay::Pimpl::CreateBufferArray(CaptureReader& reader)
+{
+    const auto id = reader.Read<Capture::ObjectID>();
+
+    std::vector<Buffer*> buffers(reader.Read<std::uint32_t>());
+    for (Buffer*& buffer : buffers)
+    {
+        buffer = Find<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+        if (buffer == nullptr)
+            return false;
+    }
+
+    BufferArray* bufferArray = renderSystem->CreateBufferArray(static_cast<std::uint32_t>(buffers.size()), buffers.data());
+    AddObject(id, Capture::DefBufferArray, bufferArray);
+    return (bufferArray != nullptr);
+}
+
+bool CaptureReplay::Pimpl::CreateTexture(CaptureReader& reader)
+{
+    const auto id           = reader.Read<Capture::ObjectID>();
+    const auto textureDesc  = reader.Read<TextureDescriptor>();
+
+    Texture* texture = renderSystem->CreateTexture(textureDesc);
+    AddObject(id, Capture::DefTexture, texture);
+    if (texture == nullptr)
+        return false;
+
+    /* Restore texture content from snapshot */
+    const auto numSnapshots = reader.Read<std::uint32_t>();
+    for_range(i, numSnapshots)
+    {
+        const auto region = reader.Read<TextureRegion>();
+
+        SrcImageDescriptor imageDesc;
+        {
+            reader.Read(imageDesc.format);
+            reader.Read(imageDesc.dataType);
+            imageDesc.data = reader.ReadData(imageDesc.dataSize);
+        }
+
+        if (!reader.IsValid())
+            return false;
+
+        renderSystem->WriteTexture(*texture, region, imageDesc);
+    }
+
+    return true;
+}
+
+bool CaptureReplay::Pimpl::CreateSampler(CaptureReader& reader)
+{
+    const auto id           = reader.Read<Capture::ObjectID>();
+    const auto samplerDesc  = reader.Read<SamplerDescriptor>();
+
+    Sampler* sampler = renderSystem->CreateSampler(samplerDesc);
+    AddObject(id, Capture::DefSampler, sampler);
+    return (sampler != nullptr);
+}
+
+bool CaptureReplay::Pimpl::CreateRenderPass(CaptureReader& reader)
+{
+    const auto id               = reader.Read<Capture::ObjectID>();
+    const auto renderPassDesc   = reader.Read<RenderPassDescriptor>();
+
+    RenderPass* renderPass = renderSystem->CreateRenderPass(renderPassDesc);
+    AddObject(id, Capture::DefRenderPass, renderPass);
+    return (renderPass != nullptr);
+}
+
+bool CaptureReplay::Pimpl::CreateRenderTarget(CaptureReader& reader)
+{
+    const auto id = reader.Read<Capture::ObjectID>();
+
+    RenderTargetDescriptor renderTargetDesc;
+    {
+        renderTargetDesc.renderPass = Find<RenderPass>(reader.Read<Capture::ObjectID>(), Capture::DefRenderPass);
+        reader.Read(renderTargetDesc.resolution);
+        reader.Read(renderTargetDesc.samples);
+
+        /* Attachments are stored in the order: color attachments, resolve attachments, depth-stencil attachment */
+        AttachmentDescriptor* attachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1];
+        for_range(i, LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+        {
+            attachments[i]                                  = &(renderTargetDesc.colorAttachments[i]);
+            attachments[i + LLGL_MAX_NUM_COLOR_ATTACHMENTS] = &(renderTargetDesc.resolveAttachments[i]);
+        }
+        attachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS*2] = &(renderTargetDesc.depthStencilAttachment);
+
+        const auto numAttachments = reader.Read<std::uint32_t>();
+        if (numAttachments != LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1)
+            return false;
+
+        for (AttachmentDescriptor* attachment : attachments)
+        {
+            reader.Read(attachment->format);
+            attachment->texture = Find<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            reader.Read(attachment->mipLevel);
+            reader.Read(attachment->arrayLayer);
+        }
+
+        renderTargetDesc.shadingRateImage = Find<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+    }
+
+    if (!reader.IsValid())
+        return false;
+
+    RenderTarget* renderTarget = renderSystem->CreateRenderTarget(renderTargetDesc);
+    AddObject(id, Capture::DefRenderTarget, renderTarget);
+    return (renderTarget != nullptr);
+}
+
+bool CaptureReplay::Pimpl::CreateSwapChain(CaptureReader& reader)
+{
+    /* All swap-chains of the capture are replaced by the replay swap-chain */
+    const auto id = reader.Read<Capture::ObjectID>();
+    AddObject(id, Capture::DefSwapChain, swapChain);
+    return true;
+}
+
+bool CaptureReplay::Pimpl::CreateShader(CaptureReader& reader)
+{
+    const auto id = reader.Read<Capture::ObjectID>();
+
+    std::string                 source;
+    std::vector<std::string>    defineStrings;
+    std::vector<ShaderMacro>    defines;
+
+    ShaderDescriptor shaderDesc;
+    {
+        reader.Read(shaderDesc.type);
+        reader.Read(shaderDesc.sourceType);
+
+        std::size_t sourceSize = 0;
+        const char* sourceData = reader.ReadData(sourceSize);
+        source.assign(sourceData != nullptr ? sourceData : "", sourceSize);
+
+        shaderDesc.source       = source.c_str();
+        shaderDesc.sourceSize   = source.size();
+
+        const char* entryPoint  = reader.ReadCString();
+        const char* profile     = reader.ReadCString();
+        shaderDesc.entryPoint   = (*entryPoint != '\0' ? entryPoint : nullptr);
+        shaderDesc.profile      = (*profile != '\0' ? profile : nullptr);
+
+        reader.Read(shaderDesc.flags);
+
+        const auto numDefines = reader.Read<std::uint32_t>();
+        if (numDefines > 0)
+        {
+            for_range(i, numDefines)
+            {
+                const char* name        = reader.ReadCString();
+                const char* definition  = reader.ReadCString();
+                defines.push_back(ShaderMacro{ name, definition });
+            }
+            defines.push_back(ShaderMacro{});
+            shaderDesc.defines = defines.data();
+        }
+
+        ReadVertexAttributes(reader, shaderDesc.vertex.inputAttribs);
+        ReadVertexAttributes(reader, shaderDesc.vertex.outputAttribs);
+
+        shaderDesc.fragment.outputAttribs.resize(reader.Read<std::uint32_t>());
+        for (FragmentAttribute& attrib : shaderDesc.fragment.outputAttribs)
+        {
+            attrib.name = reader.ReadCString();
+            reader.Read(attrib.format);
+            reader.Read(attrib.location);
+            reader.Read(attrib.systemValue);
+        }
+
+        reader.Read(shaderDesc.compute.workGroupSize);
+    }
+
+    if (!reader.IsValid())
+        return false;
+
+    Shader* shader = renderSystem->CreateShader(shaderDesc);
+    AddObject(id, Capture::DefShader, shader);
+    if (shader == nullptr)
+        return false;
+
+    if (const Report* report = shader->GetReport())
+    {
+        if (report->HasErrors())
+        {
+            Log::Errorf("error: failed to compile shader from capture:\n%s", report->GetText());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CaptureReplay::Pimpl::CreatePipelineLayout(CaptureReader& reader)
+{
+    const auto id = reader.Read<Capture::ObjectID>();
+
+    PipelineLayoutDescriptor layoutDesc;
+    {
+        ReadBindingDescriptors(reader, layoutDesc.heapBindings);
+        ReadBindingDescriptors(reader, layoutDesc.bindings);
+
+        layoutDesc.staticSamplers.resize(reader.Read<std::uint32_t>());
+        for (StaticSamplerDescriptor& staticSampler : layoutDesc.staticSamplers)
+        {
+            staticSampler.name = reader.ReadCString();
+            reader.Read(staticSampler.stageFlags);
+            reader.Read(staticSampler.slot.index);
+            reader.Read(staticSampler.slot.set);
+            reader.Read(staticSampler.sampler);
+        }
+
+        layoutDesc.uniforms.resize(reader.Read<std::uint32_t>());
+        for (UniformDescriptor& uniform : layoutDesc.uniforms)
+        {
+            uniform.name = reader.ReadCString();
+            reader.Read(uniform.type);
+            reader.Read(uniform.arraySize);
+        }
+
+        layoutDesc.bindlessHeap = (reader.Read<std::uint8_t>() != 0);
+    }
+
+    if (!reader.IsValid())
+        return false;
+
+    PipelineLayout* pipelineLayout = renderSystem->CreatePipelineLayout(layoutDesc);
+    AddObject(id, Capture::DefPipelineLayout, pipelineLayout);
+    return (pipelineLayout != nullptr);
+}
+
+bool CaptureReplay::Pimpl::CreatePipelineState(CaptureReader& reader)
+{
+    const auto id               = reader.Read<Capture::ObjectID>();
+    const bool isGraphicsPSO    = (reader.Read<std::uint8_t>() != 0);
+    const auto pipelineLayout   = Find<PipelineLayout>(reader.Read<Capture::ObjectID>(), Capture::DefPipelineLayout);
+
+    PipelineState* pipelineState = nullptr;
+
+    if (isGraphicsPSO)
+    {
+        GraphicsPipelineDescriptor psoDesc;
+        {
+            psoDesc.pipelineLayout = pipelineLayout;
+
+            const auto renderPassKind   = reader.Read<Capture::RenderPassKind>();
+            const auto renderPassID     = reader.Read<Capture::ObjectID>();
+            if (renderPassKind == Capture::RenderPassKind::SwapChain)
+                psoDesc.renderPass = swapChain->GetRenderPass();
+            else if (renderPassKind == Capture::RenderPassKind::Custom)
+                psoDesc.renderPass = Find<RenderPass>(renderPassID, Capture::DefRenderPass);
+
+            Shader** shaders[] =
+            {
+                &(psoDesc.vertexShader),
+                &(psoDesc.tessControlShader),
+                &(psoDesc.tessEvaluationShader),
+                &(psoDesc.geometryShader),
+                &(psoDesc.fragmentShader),
+                &(psoDesc.taskShader),
+                &(psoDesc.meshShader),
+            };
+            for (Shader** shader : shaders)
+                *shader = Find<Shader>(reader.Read<Capture::ObjectID>(), Capture::DefShader);
+
+            reader.Read(psoDesc.primitiveTopology);
+            reader.ReadRaw(psoDesc.viewports, reader.Read<std::uint32_t>());
+            reader.ReadRaw(psoDesc.scissors, reader.Read<std::uint32_t>());
+            reader.Read(psoDesc.depth);
+            reader.Read(psoDesc.stencil);
+            reader.Read(psoDesc.rasterizer);
+            reader.Read(psoDesc.blend);
+            reader.Read(psoDesc.tessellation);
+            reader.Read(psoDesc.shadingRate);
+            reader.Read(psoDesc.viewMask);
+        }
+
+        if (!reader.IsValid())
+            return false;
+
+        pipelineState = renderSystem->CreatePipelineState(psoDesc);
+    }
+    else
+    {
+        ComputePipelineDescriptor psoDesc;
+        {
+            psoDesc.pipelineLayout          = pipelineLayout;
+            psoDesc.computeShader           = Find<Shader>(reader.Read<Capture::ObjectID>(), Capture::DefShader);
+            psoDesc.requiredSubgroupSize    = reader.Read<std::uint32_t>();
+        }
+
+        if (!reader.IsValid())
+            return false;
+
+        pipelineState = renderSystem->CreatePipelineState(psoDesc);
+    }
+
+    AddObject(id, Capture::DefPipelineState, pipelineState);
+    if (pipelineState == nullptr)
+        return false;
+
+    if (const Report* report = pipelineState->GetReport())
+    {
+        if (report->HasErrors())
+        {
+            Log::Errorf("error: failed to create pipeline state from capture:\n%s", report->GetText());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CaptureReplay::Pimpl::ReadResourceViews(CaptureReader& reader, std::vector<ResourceViewDescriptor>& outResourceViews) const
+{
+    outResourceViews.resize(reader.Read<std::uint32_t>());
+    for (ResourceViewDescriptor& resourceView : outResourceViews)
+    {
+        resourceView.resource = FindResource(reader.Read<Capture::ObjectID>());
+        reader.Read(resourceView.textureView);
+        reader.Read(resourceView.bufferView);
+        reader.Read(resourceView.initialCount);
+    }
+}
+
+bool CaptureReplay::Pimpl::CreateResourceHeap(CaptureReader& reader)
+{
+    const auto id = reader.Read<Capture::ObjectID>();
+
+    ResourceHeapDescriptor resourceHeapDesc;
+    {
+        resourceHeapDesc.pipelineLayout = Find<PipelineLayout>(reader.Read<Capture::ObjectID>(), Capture::DefPipelineLayout);
+        reader.Read(resourceHeapDesc.numResourceViews);
+        reader.Read(resourceHeapDesc.barrierFlags);
+    }
+
+    std::vector<ResourceViewDescriptor> resourceViews;
+    ReadResourceViews(reader, resourceViews);
+
+    if (!reader.IsValid())
+        return false;
+
+    /* Initial resource views must not contain null pointers, so incomplete heaps are written after they have been created */
+    const bool isComplete = std::all_of(
+        resourceViews.begin(), resourceViews.end(),
+        [](const ResourceViewDescriptor& resourceView) -> bool
+        {
+            return (resourceView.resource != nullptr);
+        }
+    );
+
+    ResourceHeap* resourceHeap = nullptr;
+    if (isComplete)
+        resourceHeap = renderSystem->CreateResourceHeap(resourceHeapDesc, resourceViews);
+    else
+    {
+        resourceHeapDesc.numResourceViews = static_cast<std::uint32_t>(resourceViews.size());
+        resourceHeap = renderSystem->CreateResourceHeap(resourceHeapDesc);
+        if (resourceHeap != nullptr)
+            renderSystem->WriteResourceHeap(*resourceHeap, 0, resourceViews);
+    }
+
+    AddObject(id, Capture::DefResourceHeap, resourceHeap);
+    return (resourceHeap != nullptr);
+}
+
+bool CaptureReplay::Pimpl::CreateQueryHeap(CaptureReader& reader)
+{
+    const auto id               = reader.Read<Capture::ObjectID>();
+    const auto queryHeapDesc    = reader.Read<QueryHeapDescriptor>();
+
+    QueryHeap* queryHeap = renderSystem->CreateQueryHeap(queryHeapDesc);
+    AddObject(id, Capture::DefQueryHeap, queryHeap);
+    return (queryHeap != nullptr);
+}
+
+bool CaptureReplay::Pimpl::CreateCommandBuffer(CaptureReader& reader)
+{
+    const auto id = reader.Read<Capture::ObjectID>();
+
+    CommandBufferDescriptor cmdBufferDesc;
+    {
+        reader.Read(cmdBufferDesc.flags);
+        reader.Read(cmdBufferDesc.numNativeBuffers);
+        reader.Read(cmdBufferDesc.queueType);
+        cmdBufferDesc.renderPass = Find<RenderPass>(reader.Read<Capture::ObjectID>(), Capture::DefRenderPass);
+    }
+
+    if (!reader.IsValid())
+        return false;
+
+    CommandBuffer* cmdBuffer = renderSystem->CreateCommandBuffer(cmdBufferDesc);
+    AddObject(id, Capture::DefCommandBuffer, cmdBuffer);
+
+    CaptureCommandBufferInfo& info = commandBuffers[id];
+    {
+        info.flags      = cmdBufferDesc.flags;
+        info.queueType  = cmdBufferDesc.queueType;
+        info.encoded    = false;
+    }
+
+    return (cmdBuffer != nullptr);
+}
+
+void CaptureReplay::Pimpl::AddObject(Capture::ObjectID id, Capture::Ident ident, void* object)
+{
+    if (object != nullptr)
+    {
+        objects[id] = CaptureObject{ ident, object };
+        creationOrder.push_back(id);
+    }
+}
+
+void* CaptureReplay::Pimpl::FindObject(Capture::ObjectID id, Capture::Ident ident) const
+{
+    auto it = objects.find(id);
+    if (it != objects.end() && it->second.ident == ident)
+        return it->second.object;
+    return nullptr;
+}
+
+Resource* CaptureReplay::Pimpl::FindResource(Capture::ObjectID id) const
+{
+    auto it = objects.find(id);
+    if (it == objects.end())
+        return nullptr;
+
+    switch (it->second.ident)
+    {
+        case Capture::DefBuffer:    return static_cast<Buffer*>(it->second.object);
+        case Capture::DefTexture:   return static_cast<Texture*>(it->second.object);
+        case Capture::DefSampler:   return static_cast<Sampler*>(it->second.object);
+        default:                    return nullptr;
+    }
+}
+
+RenderTarget* CaptureReplay::Pimpl::FindRenderTarget(Capture::ObjectID id) const
+{
+    auto it = objects.find(id);
+    if (it == objects.end())
+        return nullptr;
+
+    switch (it->second.ident)
+    {
+        case Capture::DefRenderTarget:  return static_cast<RenderTarget*>(it->second.object);
+        case Capture::DefSwapChain:     return static_cast<SwapChain*>(it->second.object);
+        default:                        return nullptr;
+    }
+}
+
+void CaptureReplay::Pimpl::ReleaseObjects()
+{
+    if (renderSystem == nullptr)
+        return;
+
+    for (auto it = creationOrder.rbegin(); it != creationOrder.rend(); ++it)
+    {
+        const CaptureObject& entry = objects[*it];
+        switch (entry.ident)
+        {
+            case Capture::DefBuffer:            renderSystem->Release(*static_cast<Buffer*>(entry.object));         break;
+            case Capture::DefBufferArray:       renderSystem->Release(*static_cast<BufferArray*>(entry.object));    break;
+            case Capture::DefTexture:           renderSystem->Release(*static_cast<Texture*>(entry.object));        break;
+            case Capture::DefSampler:           renderSystem->Release(*static_cast<Sampler*>(entry.object));        break;
+            case Capture::DefRenderPass:        renderSystem->Release(*static_cast<RenderPass*>(entry.object));     break;
+            case Capture::DefRenderTarget:      renderSystem->Release(*static_cast<RenderTarget*>(entry.object));   break;
+            case Capture::DefShader:            renderSystem->Release(*static_cast<Shader*>(entry.object));         break;
+            case Capture::DefPipelineLayout:    renderSystem->Release(*static_cast<PipelineLayout*>(entry.object)); break;
+            case Capture::DefPipelineState:     renderSystem->Release(*static_cast<PipelineState*>(entry.object));  break;
+            case Capture::DefResourceHeap:      renderSystem->Release(*static_cast<ResourceHeap*>(entry.object));   break;
+            case Capture::DefQueryHeap:         renderSystem->Release(*static_cast<QueryHeap*>(entry.object));      break;
+            case Capture::DefCommandBuffer:     renderSystem->Release(*static_cast<CommandBuffer*>(entry.object));  break;
+            default:                                                                                                break;
+        }
+    }
+
+    objects.clear();
+    creationOrder.clear();
+    commandBuffers.clear();
+
+    renderSystem    = nullptr;
+    swapChain       = nullptr;
+}
+
+
+/*
+ * Pimpl event replay
+ */
+
+void CaptureReplay::Pimpl::ReplayEvent(const CaptureSegment& segment)
+{
+    CaptureReader reader{ segment.data, segment.size };
+
+    switch (segment.ident)
+    {
+        case Capture::EvtEncoding:
+        {
+            ReplayEncoding(reader);
+        }
+        break;
+
+        case Capture::EvtSubmit:
+        {
+            /* Only submit command buffers that have been encoded by the replay; immediate command buffers are submitted by CommandBuffer::End */
+            const auto id = reader.Read<Capture::ObjectID>();
+            auto it = commandBuffers.find(id);
+            if (it != commandBuffers.end() && it->second.encoded && (it->second.flags & CommandBufferFlags::ImmediateSubmit) == 0)
+            {
+                if (CommandBuffer* cmdBuffer = Find<CommandBuffer>(id, Capture::DefCommandBuffer))
+                    renderSystem->GetCommandQueue(it->second.queueType)->Submit(*cmdBuffer);
+            }
+        }
+        break;
+
+        case Capture::EvtPresent:
+        {
+            swapChain->Present();
+        }
+        break;
+
+        case Capture::EvtWriteBuffer:
+        {
+            const auto id       = reader.Read<Capture::ObjectID>();
+            const auto offset   = reader.Read<std::uint64_t>();
+
+            std::size_t dataSize = 0;
+            const char* data = reader.ReadData(dataSize);
+
+            if (reader.IsValid())
+                renderSystem->WriteBuffer(Get<Buffer>(id, Capture::DefBuffer), offset, data, dataSize);
+        }
+        break;
+
+        case Capture::EvtWriteTexture:
+        {
+            const auto id       = reader.Read<Capture::ObjectID>();
+            const auto region   = reader.Read<TextureRegion>();
+
+            SrcImageDescriptor imageDesc;
+            {
+                reader.Read(imageDesc.format);
+                reader.Read(imageDesc.dataType);
+                imageDesc.data = reader.ReadData(imageDesc.dataSize);
+            }
+
+            if (reader.IsValid())
+                renderSystem->WriteTexture(Get<Texture>(id, Capture::DefTexture), region, imageDesc);
+        }
+        break;
+
+        case Capture::EvtWriteResourceHeap:
+        {
+            const auto id               = reader.Read<Capture::ObjectID>();
+            const auto firstDescriptor  = reader.Read<std::uint32_t>();
+
+            std::vector<ResourceViewDescriptor> resourceViews;
+            ReadResourceViews(reader, resourceViews);
+
+            if (reader.IsValid())
+                renderSystem->WriteResourceHeap(Get<ResourceHeap>(id, Capture::DefResourceHeap), firstDescriptor, resourceViews);
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void CaptureReplay::Pimpl::ReplayEncoding(CaptureReader& reader)
+{
+    const auto id = reader.Read<Capture::ObjectID>();
+    CommandBuffer& cmdBuffer = Get<CommandBuffer>(id, Capture::DefCommandBuffer);
+
+    cmdBuffer.Begin();
+    {
+        Serialization::Deserializer deserializer{ reader.GetPosition(), reader.GetRemainingSize() };
+        for (Serialization::Segment seg = deserializer.Begin(); seg.ident != 0; seg = deserializer.Begin())
+        {
+            CaptureReader cmdReader{ seg.data, static_cast<std::size_t>(seg.size) };
+            ReplayCommand(cmdBuffer, static_cast<Capture::Ident>(seg.ident), cmdReader);
+            LLGL_ASSERT(cmdReader.IsValid(), "corrupted command in capture: %s", IntToHex(seg.ident));
+            deserializer.End();
+        }
+    }
+    cmdBuffer.End();
+
+    commandBuffers[id].encoded = true;
+}
+
+void CaptureReplay::Pimpl::ReplayCommand(CommandBuffer& cmdBuffer, Capture::Ident ident, CaptureReader& reader)
+{
+    switch (ident)
+    {
+        case Capture::CmdExecute:
+        {
+            cmdBuffer.Execute(Get<CommandBuffer>(reader.Read<Capture::ObjectID>(), Capture::DefCommandBuffer));
+        }
+        break;
+
+        case Capture::CmdUpdateBuffer:
+        {
+            Buffer&     dstBuffer   = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  dstOffset   = reader.Read<std::uint64_t>();
+            std::size_t dataSize    = 0;
+            const char* data        = reader.ReadData(dataSize);
+            cmdBuffer.UpdateBuffer(dstBuffer, dstOffset, data, static_cast<std::uint16_t>(dataSize));
+        }
+        break;
+
+        case Capture::CmdCopyBuffer:
+        {
+            Buffer&     dstBuffer   = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  dstOffset   = reader.Read<std::uint64_t>();
+            Buffer&     srcBuffer   = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  srcOffset   = reader.Read<std::uint64_t>();
+            const auto  size        = reader.Read<std::uint64_t>();
+            cmdBuffer.CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
+        }
+        break;
+
+        case Capture::CmdCopyBufferFromTexture:
+        {
+            Buffer&     dstBuffer   = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  dstOffset   = reader.Read<std::uint64_t>();
+            Texture&    srcTexture  = Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            const auto  srcRegion   = reader.Read<TextureRegion>();
+            const auto  rowStride   = reader.Read<std::uint32_t>();
+            const auto  layerStride = reader.Read<std::uint32_t>();
+            cmdBuffer.CopyBufferFromTexture(dstBuffer, dstOffset, srcTexture, srcRegion, rowStride, layerStride);
+        }
+        break;
+
+        case Capture::CmdFillBuffer:
+        {
+            Buffer&     dstBuffer   = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  dstOffset   = reader.Read<std::uint64_t>();
+            const auto  value       = reader.Read<std::uint32_t>();
+            const auto  fillSize    = reader.Read<std::uint64_t>();
+            cmdBuffer.FillBuffer(dstBuffer, dstOffset, value, fillSize);
+        }
+        break;
+
+        case Capture::CmdFillBufferPattern:
+        {
+            Buffer&     dstBuffer   = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  dstOffset   = reader.Read<std::uint64_t>();
+            std::size_t patternSize = 0;
+            const char* pattern     = reader.ReadData(patternSize);
+            const auto  fillSize    = reader.Read<std::uint64_t>();
+            cmdBuffer.FillBufferPattern(dstBuffer, dstOffset, pattern, static_cast<std::uint32_t>(patternSize), fillSize);
+        }
+        break;
+
+        case Capture::CmdCopyTexture:
+        {
+            Texture&    dstTexture  = Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            const auto  dstLocation = reader.Read<TextureLocation>();
+            Texture&    srcTexture  = Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            const auto  srcLocation = reader.Read<TextureLocation>();
+            const auto  extent      = reader.Read<Extent3D>();
+            cmdBuffer.CopyTexture(dstTexture, dstLocation, srcTexture, srcLocation, extent);
+        }
+        break;
+
+        case Capture::CmdCopyTextureFromBuffer:
+        {
+            Texture&    dstTexture  = Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            const auto  dstRegion   = reader.Read<TextureRegion>();
+            Buffer&     srcBuffer   = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  srcOffset   = reader.Read<std::uint64_t>();
+            const auto  rowStride   = reader.Read<std::uint32_t>();
+            const auto  layerStride = reader.Read<std::uint32_t>();
+            cmdBuffer.CopyTextureFromBuffer(dstTexture, dstRegion, srcBuffer, srcOffset, rowStride, layerStride);
+        }
+        break;
+
+        case Capture::CmdCopyTextureFromFramebuffer:
+        {
+            Texture&    dstTexture  = Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            const auto  dstRegion   = reader.Read<TextureRegion>();
+            const auto  srcOffset   = reader.Read<Offset2D>();
+            cmdBuffer.CopyTextureFromFramebuffer(dstTexture, dstRegion, srcOffset);
+        }
+        break;
+
+        case Capture::CmdGenerateMips:
+        {
+            cmdBuffer.GenerateMips(Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture));
+        }
+        break;
+
+        case Capture::CmdGenerateMipsRange:
+        {
+            Texture&    texture     = Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            const auto  subresource = reader.Read<TextureSubresource>();
+            cmdBuffer.GenerateMips(texture, subresource);
+        }
+        break;
+
+        case Capture::CmdCompressTexture:
+        {
+            Texture&    dstTexture  = Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            Texture&    srcTexture  = Get<Texture>(reader.Read<Capture::ObjectID>(), Capture::DefTexture);
+            const auto  subresource = reader.Read<TextureSubresource>();
+            cmdBuffer.CompressTexture(dstTexture, srcTexture, subresource);
+        }
+        break;
+
+        case Capture::CmdSetViewport:
+        {
+            cmdBuffer.SetViewport(reader.Read<Viewport>());
+        }
+        break;
+
+        case Capture::CmdSetViewports:
+        {
+            reader.ReadArray(viewports);
+            cmdBuffer.SetViewports(static_cast<std::uint32_t>(viewports.size()), viewports.data());
+        }
+        break;
+
+        case Capture::CmdSetScissor:
+        {
+            cmdBuffer.SetScissor(reader.Read<Scissor>());
+        }
+        break;
+
+        case Capture::CmdSetScissors:
+        {
+            reader.ReadArray(scissors);
+            cmdBuffer.SetScissors(static_cast<std::uint32_t>(scissors.size()), scissors.data());
+        }
+        break;
+
+        case Capture::CmdSetVertexBuffer:
+        {
+            cmdBuffer.SetVertexBuffer(Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer));
+        }
+        break;
+
+        case Capture::CmdSetVertexBufferArray:
+        {
+            cmdBuffer.SetVertexBufferArray(Get<BufferArray>(reader.Read<Capture::ObjectID>(), Capture::DefBufferArray));
+        }
+        break;
+
+        case Capture::CmdSetIndexBuffer:
+        {
+            cmdBuffer.SetIndexBuffer(Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer));
+        }
+        break;
+
+        case Capture::CmdSetIndexBufferFormat:
+        {
+            Buffer&     buffer  = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  format  = reader.Read<Format>();
+            const auto  offset  = reader.Read<std::uint64_t>();
+            cmdBuffer.SetIndexBuffer(buffer, format, offset);
+        }
+        break;
+
+        case Capture::CmdSetResourceHeap:
+        {
+            ResourceHeap&   resourceHeap    = Get<ResourceHeap>(reader.Read<Capture::ObjectID>(), Capture::DefResourceHeap);
+            const auto      descriptorSet   = reader.Read<std::uint32_t>();
+            cmdBuffer.SetResourceHeap(resourceHeap, descriptorSet);
+        }
+        break;
+
+        case Capture::CmdSetResource:
+        {
+            const auto descriptor = reader.Read<std::uint32_t>();
+            if (Resource* resource = FindResource(reader.Read<Capture::ObjectID>()))
+                cmdBuffer.SetResource(descriptor, *resource);
+        }
+        break;
+
+        case Capture::CmdSetResourceRange:
+        {
+            const auto  descriptor  = reader.Read<std::uint32_t>();
+            Buffer&     buffer      = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  offset      = reader.Read<std::uint64_t>();
+            const auto  size        = reader.Read<std::uint64_t>();
+            cmdBuffer.SetResource(descriptor, buffer, offset, size);
+        }
+        break;
+
+        case Capture::CmdResetResourceSlots:
+        {
+            const auto resourceType = reader.Read<ResourceType>();
+            const auto firstSlot    = reader.Read<std::uint32_t>();
+            const auto numSlots     = reader.Read<std::uint32_t>();
+            const auto bindFlags    = reader.Read<long>();
+            const auto stageFlags   = reader.Read<long>();
+            cmdBuffer.ResetResourceSlots(resourceType, firstSlot, numSlots, bindFlags, stageFlags);
+        }
+        break;
+
+        case Capture::CmdBeginRenderPass:
+        {
+            const auto  renderTargetID  = reader.Read<Capture::ObjectID>();
+            RenderPass* renderPass      = Find<RenderPass>(reader.Read<Capture::ObjectID>(), Capture::DefRenderPass);
+            reader.ReadArray(clearValues);
+            const auto  swapBufferIndex = reader.Read<std::uint32_t>();
+
+            RenderTarget* renderTarget = FindRenderTarget(renderTargetID);
+            LLGL_ASSERT(renderTarget != nullptr, "invalid render target ID in capture: %u", renderTargetID);
+
+            /* Swap-chains are always rendered into their current back buffer, since swap indices are not reproducible */
+            const bool isSwapChain = (renderTarget == swapChain);
+            cmdBuffer.BeginRenderPass(
+                *renderTarget,
+                renderPass,
+                static_cast<std::uint32_t>(clearValues.size()),
+                (clearValues.empty() ? nullptr : clearValues.data()),
+                (isSwapChain ? Constants::currentSwapIndex : swapBufferIndex)
+            );
+        }
+        break;
+
+        case Capture::CmdEndRenderPass:
+        {
+            cmdBuffer.EndRenderPass();
+        }
+        break;
+
+        case Capture::CmdClear:
+        {
+            const auto flags        = reader.Read<long>();
+            const auto clearValue   = reader.Read<ClearValue>();
+            cmdBuffer.Clear(flags, clearValue);
+        }
+        break;
+
+        case Capture::CmdClearAttachments:
+        {
+            reader.ReadArray(attachmentClears);
+            cmdBuffer.ClearAttachments(static_cast<std::uint32_t>(attachmentClears.size()), attachmentClears.data());
+        }
+        break;
+
+        case Capture::CmdSetPipelineState:
+        {
+            cmdBuffer.SetPipelineState(Get<PipelineState>(reader.Read<Capture::ObjectID>(), Capture::DefPipelineState));
+        }
+        break;
+
+        case Capture::CmdSetBlendFactor:
+        {
+            std::vector<float> color;
+            reader.ReadArray(color);
+            color.resize(4, 0.0f);
+            cmdBuffer.SetBlendFactor(color.data());
+        }
+        break;
+
+        case Capture::CmdSetStencilReference:
+        {
+            const auto reference    = reader.Read<std::uint32_t>();
+            const auto stencilFace  = reader.Read<StencilFace>();
+            cmdBuffer.SetStencilReference(reference, stencilFace);
+        }
+        break;
+
+        case Capture::CmdSetUniforms:
+        {
+            const auto  first       = reader.Read<std::uint32_t>();
+            std::size_t dataSize    = 0;
+            const char* data        = reader.ReadData(dataSize);
+            cmdBuffer.SetUniforms(first, data, static_cast<std::uint16_t>(dataSize));
+        }
+        break;
+
+        case Capture::CmdBeginQuery:
+        {
+            QueryHeap&  queryHeap   = Get<QueryHeap>(reader.Read<Capture::ObjectID>(), Capture::DefQueryHeap);
+            const auto  query       = reader.Read<std::uint32_t>();
+            cmdBuffer.BeginQuery(queryHeap, query);
+        }
+        break;
+
+        case Capture::CmdEndQuery:
+        {
+            QueryHeap&  queryHeap   = Get<QueryHeap>(reader.Read<Capture::ObjectID>(), Capture::DefQueryHeap);
+            const auto  query       = reader.Read<std::uint32_t>();
+            cmdBuffer.EndQuery(queryHeap, query);
+        }
+        break;
+
+        case Capture::CmdBeginRenderCondition:
+        {
+            QueryHeap&  queryHeap   = Get<QueryHeap>(reader.Read<Capture::ObjectID>(), Capture::DefQueryHeap);
+            const auto  query       = reader.Read<std::uint32_t>();
+            const auto  mode        = reader.Read<RenderConditionMode>();
+            cmdBuffer.BeginRenderCondition(queryHeap, query, mode);
+        }
+        break;
+
+        case Capture::CmdEndRenderCondition:
+        {
+            cmdBuffer.EndRenderCondition();
+        }
+        break;
+
+        case Capture::CmdBeginStreamOutput:
+        {
+            std::vector<Capture::ObjectID> bufferIDs;
+            reader.ReadArray(bufferIDs);
+
+            Buffer* buffers[LLGL_MAX_NUM_SO_BUFFERS];
+            const std::uint32_t numBuffers = std::min(static_cast<std::uint32_t>(bufferIDs.size()), LLGL_MAX_NUM_SO_BUFFERS);
+            for_range(i, numBuffers)
+                buffers[i] = &(Get<Buffer>(bufferIDs[i], Capture::DefBuffer));
+
+            cmdBuffer.BeginStreamOutput(numBuffers, buffers);
+        }
+        break;
+
+        case Capture::CmdEndStreamOutput:
+        {
+            cmdBuffer.EndStreamOutput();
+        }
+        break;
+
+        case Capture::CmdDraw:
+        {
+            const auto numVertices  = reader.Read<std::uint32_t>();
+            const auto firstVertex  = reader.Read<std::uint32_t>();
+            cmdBuffer.Draw(numVertices, firstVertex);
+        }
+        break;
+
+        case Capture::CmdDrawIndexed:
+        {
+            const auto numIndices   = reader.Read<std::uint32_t>();
+            const auto firstIndex   = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawIndexed(numIndices, firstIndex);
+        }
+        break;
+
+        case Capture::CmdDrawIndexedOffset:
+        {
+            const auto numIndices   = reader.Read<std::uint32_t>();
+            const auto firstIndex   = reader.Read<std::uint32_t>();
+            const auto vertexOffset = reader.Read<std::int32_t>();
+            cmdBuffer.DrawIndexed(numIndices, firstIndex, vertexOffset);
+        }
+        break;
+
+        case Capture::CmdDrawInstanced:
+        {
+            const auto numVertices  = reader.Read<std::uint32_t>();
+            const auto firstVertex  = reader.Read<std::uint32_t>();
+            const auto numInstances = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawInstanced(numVertices, firstVertex, numInstances);
+        }
+        break;
+
+        case Capture::CmdDrawInstancedFirst:
+        {
+            const auto numVertices      = reader.Read<std::uint32_t>();
+            const auto firstVertex      = reader.Read<std::uint32_t>();
+            const auto numInstances     = reader.Read<std::uint32_t>();
+            const auto firstInstance    = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
+        }
+        break;
+
+        case Capture::CmdDrawIndexedInstanced:
+        {
+            const auto numIndices   = reader.Read<std::uint32_t>();
+            const auto numInstances = reader.Read<std::uint32_t>();
+            const auto firstIndex   = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex);
+        }
+        break;
+
+        case Capture::CmdDrawIndexedInstancedOffset:
+        {
+            const auto numIndices   = reader.Read<std::uint32_t>();
+            const auto numInstances = reader.Read<std::uint32_t>();
+            const auto firstIndex   = reader.Read<std::uint32_t>();
+            const auto vertexOffset = reader.Read<std::int32_t>();
+            cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset);
+        }
+        break;
+
+        case Capture::CmdDrawIndexedInstancedFirst:
+        {
+            const auto numIndices       = reader.Read<std::uint32_t>();
+            const auto numInstances     = reader.Read<std::uint32_t>();
+            const auto firstIndex       = reader.Read<std::uint32_t>();
+            const auto vertexOffset     = reader.Read<std::int32_t>();
+            const auto firstInstance    = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+        }
+        break;
+
+        case Capture::CmdDrawIndirect:
+        {
+            Buffer&     buffer  = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  offset  = reader.Read<std::uint64_t>();
+            cmdBuffer.DrawIndirect(buffer, offset);
+        }
+        break;
+
+        case Capture::CmdDrawIndirectMulti:
+        {
+            Buffer&     buffer      = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  offset      = reader.Read<std::uint64_t>();
+            const auto  numCommands = reader.Read<std::uint32_t>();
+            const auto  stride      = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawIndirect(buffer, offset, numCommands, stride);
+        }
+        break;
+
+        case Capture::CmdDrawIndexedIndirect:
+        {
+            Buffer&     buffer  = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  offset  = reader.Read<std::uint64_t>();
+            cmdBuffer.DrawIndexedIndirect(buffer, offset);
+        }
+        break;
+
+        case Capture::CmdDrawIndexedIndirectMulti:
+        {
+            Buffer&     buffer      = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  offset      = reader.Read<std::uint64_t>();
+            const auto  numCommands = reader.Read<std::uint32_t>();
+            const auto  stride      = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawIndexedIndirect(buffer, offset, numCommands, stride);
+        }
+        break;
+
+        case Capture::CmdDrawIndirectCount:
+        case Capture::CmdDrawIndexedIndirectCount:
+        {
+            Buffer&     argsBuffer      = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  argsOffset      = reader.Read<std::uint64_t>();
+            Buffer&     countBuffer     = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  countOffset     = reader.Read<std::uint64_t>();
+            const auto  maxNumCommands  = reader.Read<std::uint32_t>();
+            const auto  stride          = reader.Read<std::uint32_t>();
+            if (ident == Capture::CmdDrawIndirectCount)
+                cmdBuffer.DrawIndirectCount(argsBuffer, argsOffset, countBuffer, countOffset, maxNumCommands, stride);
+            else
+                cmdBuffer.DrawIndexedIndirectCount(argsBuffer, argsOffset, countBuffer, countOffset, maxNumCommands, stride);
+        }
+        break;
+
+        case Capture::CmdDispatch:
+        {
+            const auto numWorkGroupsX = reader.Read<std::uint32_t>();
+            const auto numWorkGroupsY = reader.Read<std::uint32_t>();
+            const auto numWorkGroupsZ = reader.Read<std::uint32_t>();
+            cmdBuffer.Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+        }
+        break;
+
+        case Capture::CmdDispatchIndirect:
+        {
+            Buffer&     buffer  = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  offset  = reader.Read<std::uint64_t>();
+            cmdBuffer.DispatchIndirect(buffer, offset);
+        }
+        break;
+
+        case Capture::CmdCompactIndirectArguments:
+        {
+            Buffer&     dstBuffer           = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  dstOffset           = reader.Read<std::uint64_t>();
+            Buffer&     countBuffer         = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  countOffset         = reader.Read<std::uint64_t>();
+            Buffer&     srcBuffer           = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  srcOffset           = reader.Read<std::uint64_t>();
+            Buffer&     visibilityBuffer    = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  visibilityOffset    = reader.Read<std::uint64_t>();
+            const auto  numCommands         = reader.Read<std::uint32_t>();
+            const auto  stride              = reader.Read<std::uint32_t>();
+            cmdBuffer.CompactIndirectArguments(dstBuffer, dstOffset, countBuffer, countOffset, srcBuffer, srcOffset, visibilityBuffer, visibilityOffset, numCommands, stride);
+        }
+        break;
+
+        case Capture::CmdDrawMeshTasks:
+        {
+            const auto numWorkGroupsX = reader.Read<std::uint32_t>();
+            const auto numWorkGroupsY = reader.Read<std::uint32_t>();
+            const auto numWorkGroupsZ = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawMeshTasks(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+        }
+        break;
+
+        case Capture::CmdDrawMeshTasksIndirect:
+        {
+            Buffer&     buffer      = Get<Buffer>(reader.Read<Capture::ObjectID>(), Capture::DefBuffer);
+            const auto  offset      = reader.Read<std::uint64_t>();
+            const auto  numCommands = reader.Read<std::uint32_t>();
+            const auto  stride      = reader.Read<std::uint32_t>();
+            cmdBuffer.DrawMeshTasksIndirect(buffer, offset, numCommands, stride);
+        }
+        break;
+
+        case Capture::CmdDrawStreamOutput:
+        {
+            cmdBuffer.DrawStreamOutput();
+        }
+        break;
+
+        case Capture::CmdPushDebugGroup:
+        {
+            cmdBuffer.PushDebugGroup(reader.ReadCString());
+        }
+        break;
+
+        case Capture::CmdPopDebugGroup:
+        {
+            cmdBuffer.PopDebugGroup();
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,217 @@
+/*
+ * CommandBufferPool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/CommandBufferPool.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/CommandQueue.h>
+#include <LLGL/Fence.h>
+#include "../Core/Assertion.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Command buffers that have been submitted together and are recycled once their fence has been signaled.
+struct CommandBufferPoolSubmission
+{
+    Fence*                      fence           = nullptr;
+    std::vector<CommandBuffer*> commandBuffers;
+};
+
+struct CommandBufferPool::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem, const CommandBufferDescriptor& commandBufferDesc, CommandQueue* commandQueue) :
+        renderSystem      { renderSystem      },
+        commandBufferDesc { commandBufferDesc },
+        commandQueue      { commandQueue      }
+    {
+    }
+
+    CommandBuffer* CreateCommandBuffer();
+    Fence* AcquireFence();
+    void RecycleSubmissions(std::uint64_t timeout);
+
+    RenderSystem&                           renderSystem;
+    CommandBufferDescriptor                 commandBufferDesc;
+    CommandQueue*                           commandQueue        = nullptr;
+
+    mutable std::mutex                      mutex;
+    std::vector<CommandBuffer*>             commandBuffers;     // All command buffers owned by this pool
+    std::vector<CommandBuffer*>             availableCommandBuffers;
+    std::vector<Fence*>                     fences;             // All fences owned by this pool
+    std::vector<Fence*>                     availableFences;
+    std::deque<CommandBufferPoolSubmission> pendingSubmissions; // Submissions in the order they have been submitted to the queue
+};
+
+
+CommandBuffer* CommandBufferPool::Pimpl::CreateCommandBuffer()
+{
+    CommandBuffer* commandBuffer = renderSystem.CreateCommandBuffer(commandBufferDesc);
+    LLGL_ASSERT_PTR(commandBuffer);
+    commandBuffers.push_back(commandBuffer);
+    return commandBuffer;
+}
+
+Fence* CommandBufferPool::Pimpl::AcquireFence()
+{
+    if (!availableFences.empty())
+    {
+        Fence* fence = availableFences.back();
+        availableFences.pop_back();
+        return fence;
+    }
+
+    Fence* fence = renderSystem.CreateFence();
+    LLGL_ASSERT_PTR(fence);
+    fences.push_back(fence);
+    return fence;
+}
+
+// Recycles pending submissions while their fences are signaled. Fences are signaled in submission order, so this stops at the first pending one.
+void CommandBufferPool::Pimpl::RecycleSubmissions(std::uint64_t timeout)
+{
+    while (!pendingSubmissions.empty())
+    {
+        CommandBufferPoolSubmission& submission = pendingSubmissions.front();
+        if (!commandQueue->WaitFence(*submission.fence, timeout))
+            break;
+
+        availableCommandBuffers.insert(availableCommandBuffers.end(), submission.commandBuffers.begin(), submission.commandBuffers.end());
+        availableFences.push_back(submission.fence);
+        pendingSubmissions.pop_front();
+    }
+}
+
+
+/*
+ * CommandBufferPool class
+ */
+
+CommandBufferPool::CommandBufferPool(
+    RenderSystem&                   renderSystem,
+    const CommandBufferDescriptor&  commandBufferDesc,
+    CommandQueue*                   commandQueue)
+:
+    pimpl_ { new Pimpl{ renderSystem, commandBufferDesc, (commandQueue != nullptr ? commandQueue : renderSystem.GetCommandQueue()) } }
+{
+    LLGL_ASSERT_PTR(pimpl_->commandQueue);
+    LLGL_ASSERT((commandBufferDesc.flags & CommandBufferFlags::Secondary) == 0, "command buffer pool cannot manage secondary command buffers");
+}
+
+CommandBufferPool::~CommandBufferPool()
+{
+    WaitIdle();
+    for (CommandBuffer* commandBuffer : pimpl_->commandBuffers)
+        pimpl_->renderSystem.Release(*commandBuffer);
+    for (Fence* fence : pimpl_->fences)
+        pimpl_->renderSystem.Release(*fence);
+    delete pimpl_;
+}
+
+void CommandBufferPool::Reserve(std::uint32_t numCommandBuffers)
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    while (pimpl_->commandBuffers.size() < numCommandBuffers)
+        pimpl_->availableCommandBuffers.push_back(pimpl_->CreateCommandBuffer());
+}
+
+CommandBuffer* CommandBufferPool::Acquire()
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+
+    /* Recycle completed submissions without blocking */
+    pimpl_->RecycleSubmissions(0);
+
+    if (!pimpl_->availableCommandBuffers.empty())
+    {
+        CommandBuffer* commandBuffer = pimpl_->availableCommandBuffers.back();
+        pimpl_->availableCommandBuffers.pop_back();
+        return commandBuffer;
+    }
+
+    return pimpl_->CreateCommandBuffer();
+}
+
+void CommandBufferPool::Submit(CommandBuffer& commandBuffer)
+{
+    CommandBuffer* commandBuffers[] = { &commandBuffer };
+    Submit(1, commandBuffers);
+}
+
+void CommandBufferPool::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    if (numCommandBuffers == 0)
+        return;
+
+    LLGL_ASSERT_PTR(commandBuffers);
+
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+
+    /* Submit command buffers followed by a fence that retires all of them */
+    CommandBufferPoolSubmission submission;
+    {
+        submission.fence = pimpl_->AcquireFence();
+        submission.commandBuffers.assign(commandBuffers, commandBuffers + numCommandBuffers);
+    }
+    pimpl_->commandQueue->Submit(numCommandBuffers, commandBuffers);
+    pimpl_->commandQueue->Submit(*submission.fence);
+    pimpl_->pendingSubmissions.push_back(std::move(submission));
+}
+
+void CommandBufferPool::Discard(CommandBuffer& commandBuffer)
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    LLGL_ASSERT(
+        std::find(pimpl_->commandBuffers.begin(), pimpl_->commandBuffers.end(), &commandBuffer) != pimpl_->commandBuffers.end(),
+        "command buffer was not acquired from this pool"
+    );
+    pimpl_->availableCommandBuffers.push_back(&commandBuffer);
+}
+
+void CommandBufferPool::Recycle()
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    pimpl_->RecycleSubmissions(0);
+}
+
+void CommandBufferPool::WaitIdle()
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    pimpl_->RecycleSubmissions(~0ull);
+}
+
+CommandBufferPoolStatistics CommandBufferPool::GetStatistics() const
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+
+    CommandBufferPoolStatistics stats;
+    {
+        stats.numCommandBuffers             = static_cast<std::uint32_t>(pimpl_->commandBuffers.size());
+        stats.numAvailableCommandBuffers    = static_cast<std::uint32_t>(pimpl_->availableCommandBuffers.size());
+        for (const CommandBufferPoolSubmission& submission : pimpl_->pendingSubmissions)
+            stats.numPendingCommandBuffers += static_cast<std::uint32_t>(submission.commandBuffers.size());
+        stats.numFences                     = static_cast<std::uint32_t>(pimpl_->fences.size());
+    }
+    return stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
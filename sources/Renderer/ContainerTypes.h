@@ -17,6 +17,7 @@
 #include <utility>
 #include <type_traits>
 #include <unordered_set>
+#include <mutex>
 #include <cstdint>
 
 
@@ -208,7 +209,11 @@ struct IndexPayload
 template <typename T>
 using IndexedUniquePtr = PayloadUniquePtr<T, IndexPayload>;
 
-// Container class for an array of unordered unique pointers. Used by RenderSystem implementations for all child objects.
+/*
+Container class for an array of unordered unique pointers. Used by RenderSystem implementations for all child objects.
+Insertion and removal are synchronized, so objects can be created and released on multiple threads.
+Objects are constructed and destroyed outside the lock. Iterating the container is not synchronized.
+*/
 template <typename T>
 class UnorderedUniquePtrVector
 {
@@ -225,11 +230,14 @@ class UnorderedUniquePtrVector
         template <typename TSub, typename... Args>
         TSub* emplace(Args&&... args)
         {
-            /* Allocate object and assign index from container in payload */
-            const IndexPayload payload{ container_.size() };
-            IndexedUniquePtr<TSub> object = IndexedUniquePtr<TSub>::Alloc(payload, std::forward<Args>(args)...);
+            /* Allocate object first, then assign index from container in payload */
+            IndexedUniquePtr<TSub> object = IndexedUniquePtr<TSub>::Alloc(IndexPayload{ 0 }, std::forward<Args>(args)...);
             TSub* ref = object.get();
-            container_.push_back(std::move(object));
+            {
+                std::lock_guard<std::mutex> guard{ mutex_ };
+                object.payload().index = container_.size();
+                container_.push_back(std::move(object));
+            }
             return ref;
         }
 
@@ -239,28 +247,38 @@ class UnorderedUniquePtrVector
         {
             if (object != nullptr)
             {
-                /* Locate object in container with index from payload */
-                T* subTypedObject = ObjectCast<T*>(object);
-                auto* payload = reinterpret_cast<IndexPayload*>(reinterpret_cast<char*>(subTypedObject) - sizeof(IndexPayload));
-                LLGL_ASSERT(payload->index < container_.size());
-
-                if (payload->index + 1 < container_.size())
+                IndexedUniquePtr<T> removedObject;
                 {
-                    /* Move last element to location of the input object in order to delete it */
-                    std::swap(container_[payload->index], container_.back());
+                    std::lock_guard<std::mutex> guard{ mutex_ };
 
-                    /* Update payload for moved object */
-                    container_[payload->index].payload() = *payload;
-                }
+                    /* Locate object in container with index from payload */
+                    T* subTypedObject = ObjectCast<T*>(object);
+                    auto* payload = reinterpret_cast<IndexPayload*>(reinterpret_cast<char*>(subTypedObject) - sizeof(IndexPayload));
+                    LLGL_ASSERT(payload->index < container_.size());
+
+                    if (payload->index + 1 < container_.size())
+                    {
+                        /* Move last element to location of the input object in order to delete it */
+                        std::swap(container_[payload->index], container_.back());
+
+                        /* Update payload for moved object */
+                        container_[payload->index].payload() = *payload;
+                    }
 
-                /* Remove last element in container; it's either input object or the one moved that object's location */
-                container_.pop_back();
+                    /* Remove last element in container; it's either input object or the one moved that object's location */
+                    removedObject = std::move(container_.back());
+                    container_.pop_back();
+                }
             }
         }
 
         void clear()
         {
-            container_.clear();
+            container_type removedObjects;
+            {
+                std::lock_guard<std::mutex> guard{ mutex_ };
+                removedObjects.swap(container_);
+            }
         }
 
         bool empty() const
@@ -302,11 +320,15 @@ class UnorderedUniquePtrVector
 
     private:
 
-        container_type container_;
+        container_type  container_;
+        std::mutex      mutex_;
 
 };
 
-// Container class for a set of unordered unique pointers. Used by RenderSystem implementations for all child objects.
+/*
+Container class for a set of unordered unique pointers. Used by RenderSystem implementations for all child objects.
+Insertion and removal are synchronized the same way as in UnorderedUniquePtrVector, except that objects are destroyed inside the lock.
+*/
 template <typename T>
 class UnorderedUniquePtrSet
 {
@@ -323,19 +345,26 @@ class UnorderedUniquePtrSet
         template <typename TSub, typename... Args>
         TSub* emplace(Args&&... args)
         {
-            return TakeOwnership(container_, MakeUnique<TSub>(std::forward<Args>(args)...));
+            std::unique_ptr<TSub> object = MakeUnique<TSub>(std::forward<Args>(args)...);
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            return TakeOwnership(container_, std::move(object));
         }
 
         // Releases the memory for the specified object in that list.
         template <typename TBase>
         void erase(TBase* object)
         {
+            std::lock_guard<std::mutex> guard{ mutex_ };
             RemoveFromUniqueSet(container_, object);
         }
 
         void clear()
         {
-            container_.clear();
+            container_type removedObjects;
+            {
+                std::lock_guard<std::mutex> guard{ mutex_ };
+                removedObjects.swap(container_);
+            }
         }
 
         bool empty() const
@@ -377,7 +406,8 @@ class UnorderedUniquePtrSet
 
     private:
 
-        container_type container_;
+        container_type  container_;
+        std::mutex      mutex_;
 
 };
 
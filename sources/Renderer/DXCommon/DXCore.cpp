@@ -7,6 +7,7 @@
 
 #include "DXCore.h"
 #include "ComPtr.h"
+#include "../GPUBreadcrumbs.h"
 #include "../../Core/Exception.h"
 #include "../../Core/StringUtils.h"
 #include "../../Core/MacroUtils.h"
@@ -15,6 +16,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <d3dcompiler.h>
+#include <dxgi1_4.h>
 
 
 #ifndef LLGL_BUILD_STATIC_LIB
@@ -123,6 +125,10 @@ static std::string DXErrorToStrOrHex(const HRESULT hr)
 [[noreturn]]
 static void TrapDXErrorCode(const HRESULT hr, const char* details)
 {
+    /* Report the last commands that were executed by the GPU before the device was lost */
+    if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET || hr == DXGI_ERROR_DEVICE_HUNG)
+        ReportGPUBreadcrumbs();
+
     std::string errCode = DXErrorToStrOrHex(hr);
     if (details != nullptr && *details != '\0')
         LLGL_TRAP("%s (error code = %s)", details, errCode.c_str());
@@ -361,11 +367,22 @@ void DXGetRenderingCaps(RenderingCapabilities& caps, D3D_FEATURE_LEVEL featureLe
     caps.features.hasInstancing                     = (featureLevel >= D3D_FEATURE_LEVEL_9_3);
     caps.features.hasOffsetInstancing               = (featureLevel >= D3D_FEATURE_LEVEL_9_3);
     caps.features.hasIndirectDrawing                = (featureLevel >= D3D_FEATURE_LEVEL_10_0);//???
+    caps.features.hasIndirectCountDrawing           = false;
     caps.features.hasViewportArrays                 = true;
     caps.features.hasStreamOutputs                  = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
     caps.features.hasLogicOp                        = (featureLevel >= D3D_FEATURE_LEVEL_11_1);
     caps.features.hasPipelineStatistics             = true;
     caps.features.hasRenderCondition                = true;
+    caps.features.hasBindlessResources              = false;
+    caps.features.hasSparseResources                = false;
+    caps.features.hasThreadSafeResourceCreation     = false;
+    caps.features.hasVariableRateShading            = false;
+    caps.features.hasShadingRateImage               = false;
+    caps.features.hasMeshShaders                    = false;
+    caps.features.hasTextureCompression             = false;
+    caps.features.hasSubgroupSizeControl            = false;
+    caps.features.hasNativeIOQueue                  = false;
+    caps.features.hasMultiview                      = false;
 
     /* Query limits */
     caps.limits.lineWidthRange[0]                   = 1.0f;
@@ -495,6 +512,7 @@ VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter)
     videoAdapterDesc.name           = std::wstring(desc.Description);
     videoAdapterDesc.vendor         = GetVendorName(GetVendorByID(desc.VendorId));
     videoAdapterDesc.videoMemory    = static_cast<uint64_t>(desc.DedicatedVideoMemory);
+    videoAdapterDesc.luid           = DXGetLUIDValue(desc.AdapterLuid);
 
     /* Enumerate over all adapter outputs */
     for (UINT j = 0; adapter->EnumOutputs(j, &output) != DXGI_ERROR_NOT_FOUND; ++j)
@@ -544,6 +562,63 @@ VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter)
     return videoAdapterDesc;
 }
 
+std::uint64_t DXGetLUIDValue(const LUID& luid)
+{
+    return ((static_cast<std::uint64_t>(static_cast<std::uint32_t>(luid.HighPart)) << 32) | static_cast<std::uint64_t>(luid.LowPart));
+}
+
+std::uint32_t DXFindOrAppendVideoAdapter(std::vector<VideoAdapterDescriptor>& videoAdapters, IDXGIAdapter* adapter)
+{
+    DXGI_ADAPTER_DESC desc;
+    adapter->GetDesc(&desc);
+
+    const std::uint64_t luid = DXGetLUIDValue(desc.AdapterLuid);
+    for (std::size_t i = 0; i < videoAdapters.size(); ++i)
+    {
+        if (videoAdapters[i].luid == luid)
+            return static_cast<std::uint32_t>(i);
+    }
+
+    videoAdapters.push_back(DXGetVideoAdapterDesc(adapter));
+    return static_cast<std::uint32_t>(videoAdapters.size() - 1);
+}
+
+bool DXQueryVideoMemoryInfo(IDXGIAdapter* adapter, MemoryStatistics& outStatistics)
+{
+    outStatistics.heaps.clear();
+
+    /* QueryVideoMemoryInfo requires DXGI 1.4 */
+    ComPtr<IDXGIAdapter3> adapter3;
+    if (adapter == nullptr || FAILED(adapter->QueryInterface(IID_PPV_ARGS(adapter3.ReleaseAndGetAddressOf()))))
+        return false;
+
+    for (DXGI_MEMORY_SEGMENT_GROUP segmentGroup : { DXGI_MEMORY_SEGMENT_GROUP_LOCAL, DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL })
+    {
+        DXGI_QUERY_VIDEO_MEMORY_INFO info;
+        if (FAILED(adapter3->QueryVideoMemoryInfo(0, segmentGroup, &info)))
+            return false;
+
+        MemoryHeapStatistics heap;
+        {
+            heap.deviceLocal    = (segmentGroup == DXGI_MEMORY_SEGMENT_GROUP_LOCAL);
+            heap.budget         = info.Budget;
+            heap.usage          = info.CurrentUsage;
+        }
+        outStatistics.heaps.push_back(heap);
+    }
+
+    return true;
+}
+
+UINT DXGetResidencyPriority(float priority)
+{
+    /* Interpolate linearly between minimum and maximum priority, so the center matches the normal priority */
+    const float t = std::max(0.0f, std::min(priority, 1.0f));
+    const float minPriority = static_cast<float>(DXGI_RESOURCE_PRIORITY_MINIMUM);
+    const float maxPriority = static_cast<float>(DXGI_RESOURCE_PRIORITY_MAXIMUM);
+    return static_cast<UINT>(minPriority + (maxPriority - minPriority) * t);
+}
+
 Format DXGetSignatureParameterType(D3D_REGISTER_COMPONENT_TYPE componentType, BYTE componentMask)
 {
     switch (componentType)
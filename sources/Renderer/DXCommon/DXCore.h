@@ -85,6 +85,18 @@ UINT DXGetCompilerFlags(int flags);
 // Returns the video adapter descriptor from the specified DXGI adapter.
 VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter);
 
+// Returns the specified LUID as 64-bit integer to be stored in VideoAdapterDescriptor::luid.
+std::uint64_t DXGetLUIDValue(const LUID& luid);
+
+// Returns the index of the video adapter with the specified LUID. The adapter is appended to the list if it has not been enumerated, e.g. the WARP adapter.
+std::uint32_t DXFindOrAppendVideoAdapter(std::vector<VideoAdapterDescriptor>& videoAdapters, IDXGIAdapter* adapter);
+
+// Queries the budget and usage of the local and non-local memory segment groups of the specified DXGI adapter. Returns false if IDXGIAdapter3 is not supported.
+bool DXQueryVideoMemoryInfo(IDXGIAdapter* adapter, MemoryStatistics& outStatistics);
+
+// Returns the DXGI eviction priority (which is shared with D3D12_RESIDENCY_PRIORITY) for the specified priority in the range [0, 1]. A priority of 0.5 maps to DXGI_RESOURCE_PRIORITY_NORMAL.
+UINT DXGetResidencyPriority(float priority);
+
 // Returns the format for the specified signature parameter type (by its component type and mask).
 Format DXGetSignatureParameterType(D3D_REGISTER_COMPONENT_TYPE componentType, BYTE componentMask);
 
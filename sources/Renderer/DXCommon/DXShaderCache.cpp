@@ -0,0 +1,248 @@
+/*
+ * DXShaderCache.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "DXShaderCache.h"
+#include "DXCore.h"
+#include "../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <d3dcompiler.h>
+#include <fstream>
+#include <string.h>
+#include <stdio.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+static constexpr char   g_shaderCacheMagic[4]   = { 'L', 'L', 'S', 'C' };
+static constexpr UINT32 g_shaderCacheVersion    = 1;
+
+// Header of each cache entry file, followed by the bytecode and the warnings of the compiler.
+struct DXShaderCacheEntryHeader
+{
+    char    magic[4];
+    UINT32  version;
+    UINT64  hash[2];
+    UINT64  byteCodeSize;
+    UINT64  errorsSize;
+};
+
+static bool IsPathSeparator(char c)
+{
+    return (c == '/' || c == '\\');
+}
+
+// Creates all directories of the specified path, which must end with a path separator.
+static void CreateDirectories(const std::string& path)
+{
+    for_range(i, path.size())
+    {
+        if (i > 0 && IsPathSeparator(path[i]) && path[i - 1] != ':')
+            ::CreateDirectoryA(path.substr(0, i).c_str(), nullptr);
+    }
+}
+
+
+/*
+ * DXShaderCache class
+ */
+
+void DXShaderCache::SetDirectory(const char* path)
+{
+    directory_.clear();
+    if (path != nullptr && *path != '\0')
+    {
+        directory_ = path;
+        if (!IsPathSeparator(directory_.back()))
+            directory_ += '\\';
+        CreateDirectories(directory_);
+    }
+}
+
+HRESULT DXShaderCache::Compile(
+    const char*             source,
+    SIZE_T                  sourceLength,
+    const D3D_SHADER_MACRO* defines,
+    const char*             entryPoint,
+    const char*             target,
+    UINT                    flags,
+    ID3DBlob**              outByteCode,
+    ID3DBlob**              outErrors) const
+{
+    Key key = {};
+    if (IsEnabled())
+    {
+        /* Try to load bytecode from cache first */
+        key = MakeKey(source, sourceLength, defines, entryPoint, target, flags);
+        if (LoadEntry(key, outByteCode, outErrors))
+            return S_OK;
+    }
+
+    HRESULT hr = D3DCompile(
+        source,
+        sourceLength,
+        nullptr,        // LPCSTR               pSourceName
+        defines,        // D3D_SHADER_MACRO*    pDefines
+        nullptr,        // ID3DInclude*         pInclude
+        entryPoint,     // LPCSTR               pEntrypoint
+        target,         // LPCSTR               pTarget
+        flags,          // UINT                 Flags1
+        0,              // UINT                 Flags2 (recommended to always be 0)
+        outByteCode,    // ID3DBlob**           ppCode
+        outErrors       // ID3DBlob**           ppErrorMsgs
+    );
+
+    /* Only store successful compilations, so errors are always reported by the compiler */
+    if (IsEnabled() && SUCCEEDED(hr) && *outByteCode != nullptr)
+        StoreEntry(key, *outByteCode, *outErrors);
+
+    return hr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+DXShaderCache::Key DXShaderCache::MakeKey(
+    const char*             source,
+    SIZE_T                  sourceLength,
+    const D3D_SHADER_MACRO* defines,
+    const char*             entryPoint,
+    const char*             target,
+    UINT                    flags)
+{
+    /* Two 64-bit FNV-1a hashes with different offset bases form the key of each entry */
+    const UINT64 offsetBases[2] = { g_fnv1aOffsetBasis, 0x84222325CBF29CE4ull };
+
+    Key key;
+    for_range(i, 2)
+    {
+        FNV1aHasher hasher;
+        hasher.value = offsetBases[i];
+        {
+            hasher.AppendValue(static_cast<UINT32>(D3D_COMPILER_VERSION));
+            hasher.AppendValue(static_cast<UINT64>(sourceLength));
+            hasher.Append(source, sourceLength);
+            if (defines != nullptr)
+            {
+                for (const D3D_SHADER_MACRO* macro = defines; macro->Name != nullptr; ++macro)
+                {
+                    hasher.AppendString(macro->Name);
+                    hasher.AppendString(macro->Definition);
+                }
+            }
+            hasher.AppendValue('\0');
+            hasher.AppendString(entryPoint);
+            hasher.AppendString(target);
+            hasher.AppendValue(flags);
+        }
+        key.hash[i] = hasher.value;
+    }
+    return key;
+}
+
+std::string DXShaderCache::GetEntryFilename(const Key& key) const
+{
+    char name[40];
+    ::sprintf_s(name, sizeof(name), "%016llX%016llX.dxsc", key.hash[0], key.hash[1]);
+    return directory_ + name;
+}
+
+bool DXShaderCache::LoadEntry(const Key& key, ID3DBlob** outByteCode, ID3DBlob** outErrors) const
+{
+    std::ifstream file{ GetEntryFilename(key).c_str(), std::ios_base::in | std::ios_base::binary };
+    if (!file.good())
+        return false;
+
+    /* Validate header; a mismatching entry is treated as a cache miss and overwritten */
+    DXShaderCacheEntryHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file.good() ||
+        ::memcmp(header.magic, g_shaderCacheMagic, sizeof(header.magic)) != 0 ||
+        header.version != g_shaderCacheVersion ||
+        header.hash[0] != key.hash[0] ||
+        header.hash[1] != key.hash[1] ||
+        header.byteCodeSize == 0)
+    {
+        return false;
+    }
+
+    ComPtr<ID3DBlob> byteCode;
+    if (FAILED(D3DCreateBlob(static_cast<SIZE_T>(header.byteCodeSize), byteCode.GetAddressOf())))
+        return false;
+
+    file.read(static_cast<char*>(byteCode->GetBufferPointer()), static_cast<std::streamsize>(header.byteCodeSize));
+    if (!file.good())
+        return false;
+
+    ComPtr<ID3DBlob> errors;
+    if (header.errorsSize > 0)
+    {
+        if (FAILED(D3DCreateBlob(static_cast<SIZE_T>(header.errorsSize), errors.GetAddressOf())))
+            return false;
+
+        file.read(static_cast<char*>(errors->GetBufferPointer()), static_cast<std::streamsize>(header.errorsSize));
+        if (!file.good())
+            return false;
+    }
+
+    *outByteCode = byteCode.Detach();
+    if (outErrors != nullptr)
+        *outErrors = errors.Detach();
+
+    return true;
+}
+
+void DXShaderCache::StoreEntry(const Key& key, ID3DBlob* byteCode, ID3DBlob* errors) const
+{
+    DXShaderCacheEntryHeader header;
+    {
+        ::memcpy(header.magic, g_shaderCacheMagic, sizeof(header.magic));
+        header.version      = g_shaderCacheVersion;
+        header.hash[0]      = key.hash[0];
+        header.hash[1]      = key.hash[1];
+        header.byteCodeSize = byteCode->GetBufferSize();
+        header.errorsSize   = (errors != nullptr ? errors->GetBufferSize() : 0);
+    }
+
+    /* Write into a file that is unique to this thread and rename it, so readers never see a partially written entry */
+    const std::string filename = GetEntryFilename(key);
+    const std::string tempFilename = filename + '.' + std::to_string(::GetCurrentProcessId()) + '.' + std::to_string(::GetCurrentThreadId());
+    {
+        std::ofstream file{ tempFilename.c_str(), std::ios_base::out | std::ios_base::binary };
+        if (!file.good())
+            return;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(byteCode->GetBufferPointer()), static_cast<std::streamsize>(header.byteCodeSize));
+        if (errors != nullptr)
+            file.write(static_cast<const char*>(errors->GetBufferPointer()), static_cast<std::streamsize>(header.errorsSize));
+
+        if (!file.good())
+        {
+            file.close();
+            ::DeleteFileA(tempFilename.c_str());
+            return;
+        }
+    }
+
+    if (!::MoveFileExA(tempFilename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING))
+        ::DeleteFileA(tempFilename.c_str());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,97 @@
+/*
+ * DXShaderCache.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_DX_SHADER_CACHE_H
+#define LLGL_DX_SHADER_CACHE_H
+
+
+#include "ComPtr.h"
+#include <string>
+#include <Windows.h>
+#include <d3dcommon.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Disk-backed cache of HLSL bytecode that was compiled with D3DCompile.
+Each entry is stored in its own file, named after a hash of the source code, macro definitions, entry point, target profile, compiler flags, and compiler version.
+Entries are written to a temporary file first and then renamed, so multiple threads and processes can share the same cache directory.
+*/
+class DXShaderCache
+{
+
+    public:
+
+        DXShaderCache() = default;
+
+        DXShaderCache(const DXShaderCache&) = delete;
+        DXShaderCache& operator = (const DXShaderCache&) = delete;
+
+        // Enables the cache with the specified directory, which is created if it does not exist. A null pointer or empty string disables the cache.
+        void SetDirectory(const char* path);
+
+        // Returns true if this cache has a directory.
+        inline bool IsEnabled() const
+        {
+            return !directory_.empty();
+        }
+
+        /*
+        Loads the bytecode for the specified compiler inputs from the cache or compiles it with D3DCompile and stores it in the cache.
+        Only successful compilations are stored; their warnings are stored as well and returned in 'outErrors'.
+        If the cache is disabled, this is equivalent to D3DCompile.
+        */
+        HRESULT Compile(
+            const char*             source,
+            SIZE_T                  sourceLength,
+            const D3D_SHADER_MACRO* defines,
+            const char*             entryPoint,
+            const char*             target,
+            UINT                    flags,
+            ID3DBlob**              outByteCode,
+            ID3DBlob**              outErrors
+        ) const;
+
+    private:
+
+        struct Key
+        {
+            UINT64 hash[2];
+        };
+
+        static Key MakeKey(
+            const char*             source,
+            SIZE_T                  sourceLength,
+            const D3D_SHADER_MACRO* defines,
+            const char*             entryPoint,
+            const char*             target,
+            UINT                    flags
+        );
+
+        std::string GetEntryFilename(const Key& key) const;
+
+        bool LoadEntry(const Key& key, ID3DBlob** outByteCode, ID3DBlob** outErrors) const;
+        void StoreEntry(const Key& key, ID3DBlob* byteCode, ID3DBlob* errors) const;
+
+    private:
+
+        std::string directory_; // Cache directory including trailing path separator
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
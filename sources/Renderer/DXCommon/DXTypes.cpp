@@ -486,7 +486,30 @@ DXGI_FORMAT ToDXGIFormatUInt(const DXGI_FORMAT format)
         case DXGI_FORMAT_R10G10B10A2_UNORM:         /* pass */
         case DXGI_FORMAT_R10G10B10A2_UINT:          return DXGI_FORMAT_R10G10B10A2_UINT;
         case DXGI_FORMAT_R11G11B10_FLOAT:           break; // not supported
-        case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:        break; // not supported
+        case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:        return DXGI_FORMAT_R32_UINT;
+
+        /* --- Depth-stencil formats --- */
+        case DXGI_FORMAT_R16_TYPELESS:              /* pass */
+        case DXGI_FORMAT_D16_UNORM:                 return DXGI_FORMAT_R16_UINT;
+        case DXGI_FORMAT_R32_TYPELESS:              /* pass */
+        case DXGI_FORMAT_D32_FLOAT:                 return DXGI_FORMAT_R32_UINT;
+
+        /* --- Block compression (BC) formats --- */
+        case DXGI_FORMAT_BC1_UNORM:                 /* pass */
+        case DXGI_FORMAT_BC1_UNORM_SRGB:            /* pass */
+        case DXGI_FORMAT_BC4_UNORM:                 /* pass */
+        case DXGI_FORMAT_BC4_SNORM:                 return DXGI_FORMAT_R32G32_UINT;
+
+        case DXGI_FORMAT_BC2_UNORM:                 /* pass */
+        case DXGI_FORMAT_BC2_UNORM_SRGB:            /* pass */
+        case DXGI_FORMAT_BC3_UNORM:                 /* pass */
+        case DXGI_FORMAT_BC3_UNORM_SRGB:            /* pass */
+        case DXGI_FORMAT_BC5_UNORM:                 /* pass */
+        case DXGI_FORMAT_BC5_SNORM:                 /* pass */
+        case DXGI_FORMAT_BC6H_UF16:                 /* pass */
+        case DXGI_FORMAT_BC6H_SF16:                 /* pass */
+        case DXGI_FORMAT_BC7_UNORM:                 /* pass */
+        case DXGI_FORMAT_BC7_UNORM_SRGB:            return DXGI_FORMAT_R32G32B32A32_UINT;
 
         default:                                    break;
     }
@@ -48,7 +48,11 @@ inline DXGI_FORMAT ToDXGIFormatRTV(const DXGI_FORMAT format)
     return ToDXGIFormatSRV(format);
 }
 
-// Returns the specified DXGI_FORMAT as typeless format or DXGI_FORMAT_UNKNOWN if the format cannot be converted to a typeless format.
+/*
+Returns the specified DXGI_FORMAT as unsigned integer format of the same size or DXGI_FORMAT_UNKNOWN if the format cannot be converted.
+Depth formats, RGB9E5, and block compressed formats are mapped to the unsigned integer formats they can be copied to with CopySubresourceRegion,
+e.g. BC1 is mapped to DXGI_FORMAT_R32G32_UINT where each texel represents an entire 4x4 block.
+*/
 DXGI_FORMAT ToDXGIFormatUInt(const DXGI_FORMAT format);
 
 // Returns the specified DXGI_FORMAT as typeless format or DXGI_FORMAT_UNKNOWN if the format cannot be converted to a typeless format.
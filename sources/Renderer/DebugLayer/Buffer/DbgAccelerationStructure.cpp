@@ -0,0 +1,53 @@
+/*
+ * DbgAccelerationStructure.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "DbgAccelerationStructure.h"
+#include "DbgBuffer.h"
+#include "../DbgCore.h"
+
+
+namespace LLGL
+{
+
+
+DbgAccelerationStructure::DbgAccelerationStructure(AccelerationStructure& instance, const AccelerationStructureDescriptor& desc) :
+    AccelerationStructure { desc.type                                       },
+    instance              { instance                                        },
+    flags                 { desc.flags                                      },
+    geometries            { desc.geometries.begin(), desc.geometries.end()  },
+    maxInstances          { desc.maxInstances                               },
+    compactedSize         { desc.compactedSize                              }
+{
+}
+
+void DbgAccelerationStructure::SetName(const char* name)
+{
+    DbgSetObjectName(*this, name);
+}
+
+std::uint64_t DbgAccelerationStructure::GetCompactedSize()
+{
+    return instance.GetCompactedSize();
+}
+
+std::vector<AccelerationStructureGeometryDescriptor> DbgGetGeometryInstanceCopy(const ArrayView<AccelerationStructureGeometryDescriptor>& geometries)
+{
+    std::vector<AccelerationStructureGeometryDescriptor> instanceGeometries(geometries.begin(), geometries.end());
+    for (AccelerationStructureGeometryDescriptor& geometry : instanceGeometries)
+    {
+        geometry.vertexBuffer   = DbgGetInstance<DbgBuffer>(geometry.vertexBuffer);
+        geometry.indexBuffer    = DbgGetInstance<DbgBuffer>(geometry.indexBuffer);
+    }
+    return instanceGeometries;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
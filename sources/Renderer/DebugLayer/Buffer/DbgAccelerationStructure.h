@@ -0,0 +1,58 @@
+/*
+ * DbgAccelerationStructure.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_DBG_ACCELERATION_STRUCTURE_H
+#define LLGL_DBG_ACCELERATION_STRUCTURE_H
+
+
+#include <LLGL/AccelerationStructure.h>
+#include <vector>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+class DbgAccelerationStructure final : public AccelerationStructure
+{
+
+    public:
+
+        void SetName(const char* name) override;
+
+        std::uint64_t GetCompactedSize() override;
+
+    public:
+
+        DbgAccelerationStructure(AccelerationStructure& instance, const AccelerationStructureDescriptor& desc);
+
+    public:
+
+        AccelerationStructure&                                        instance;
+        const long                                                    flags;
+        const std::vector<AccelerationStructureGeometryDescriptor>    geometries;  // Copy of the geometry descriptors to validate subsequent builds
+        const std::uint32_t                                           maxInstances;
+        const std::uint64_t                                           compactedSize;
+        std::string                                                   label;
+        std::uint32_t                                                 numBuiltInstances   = 0;
+        bool                                                          built               = false;
+
+};
+
+// Returns a copy of the specified geometries with their buffers replaced by the instances of their debug wrappers.
+std::vector<AccelerationStructureGeometryDescriptor> DbgGetGeometryInstanceCopy(const ArrayView<AccelerationStructureGeometryDescriptor>& geometries);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -38,6 +38,11 @@ BufferDescriptor DbgBuffer::GetDesc() const
     return instance.GetDesc();
 }
 
+std::uint64_t DbgBuffer::GetDeviceAddress() const
+{
+    return instance.GetDeviceAddress();
+}
+
 void DbgBuffer::OnMap(const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
     mappedAccess_   = access;
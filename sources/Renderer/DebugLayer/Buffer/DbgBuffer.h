@@ -18,6 +18,8 @@ namespace LLGL
 {
 
 
+class DbgCommandQueue;
+
 class DbgBuffer final : public Buffer
 {
 
@@ -29,6 +31,8 @@ class DbgBuffer final : public Buffer
 
         BufferDescriptor GetDesc() const override;
 
+        std::uint64_t GetDeviceAddress() const override;
+
     public:
 
         DbgBuffer(Buffer& instance, const BufferDescriptor& desc);
@@ -47,6 +51,10 @@ class DbgBuffer final : public Buffer
         std::uint64_t           elements    = 0;
         bool                    initialized = false;
 
+        // Last submission that wrote to this buffer; used to detect CPU stalls for performance lints.
+        DbgCommandQueue*        pendingQueue        = nullptr;
+        std::uint64_t           pendingSubmission   = 0;
+
     private:
 
         CPUAccess               mappedAccess_   = CPUAccess::ReadOnly;
@@ -0,0 +1,910 @@
+/*
+ * DbgCapture.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "DbgCapture.h"
+#include "DbgCommandBuffer.h"
+#include "DbgSwapChain.h"
+#include "Buffer/DbgBuffer.h"
+#include "Buffer/DbgBufferArray.h"
+#include "RenderState/DbgPipelineLayout.h"
+#include "RenderState/DbgPipelineState.h"
+#include "RenderState/DbgQueryHeap.h"
+#include "RenderState/DbgRenderPass.h"
+#include "RenderState/DbgResourceHeap.h"
+#include "Shader/DbgShader.h"
+#include "Texture/DbgRenderTarget.h"
+#include "Texture/DbgTexture.h"
+#include "../CheckedCast.h"
+#include "../RenderTargetUtils.h"
+#include <LLGL/RenderSystem.h>
+#include <LLGL/RenderingDebugger.h>
+#include <LLGL/TypeInfo.h>
+#include <LLGL/Format.h>
+#include <LLGL/Log.h>
+#include <LLGL/StaticLimits.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal functions
+ */
+
+static void WriteVertexAttribute(Serialization::Serializer& serial, const VertexAttribute& attrib)
+{
+    serial.WriteCString(attrib.name.c_str());
+    serial.WriteTyped(attrib.format);
+    serial.WriteTyped(attrib.location);
+    serial.WriteTyped(attrib.semanticIndex);
+    serial.WriteTyped(attrib.systemValue);
+    serial.WriteTyped(attrib.slot);
+    serial.WriteTyped(attrib.offset);
+    serial.WriteTyped(attrib.stride);
+    serial.WriteTyped(attrib.instanceDivisor);
+}
+
+static void WriteBindingDescriptors(Serialization::Serializer& serial, const std::vector<BindingDescriptor>& bindings)
+{
+    serial.WriteTyped(static_cast<std::uint32_t>(bindings.size()));
+    for (const BindingDescriptor& binding : bindings)
+    {
+        serial.WriteCString(binding.name.c_str());
+        serial.WriteTyped(binding.type);
+        serial.WriteTyped(binding.bindFlags);
+        serial.WriteTyped(binding.stageFlags);
+        serial.WriteTyped(binding.slot.index);
+        serial.WriteTyped(binding.slot.set);
+        serial.WriteTyped(binding.arraySize);
+    }
+}
+
+// Returns true if the content of the specified texture can be read back for a capture, i.e. it is an uncompressed color texture with a single sample.
+static bool IsTextureSnapshotSupported(const DbgTexture& textureDbg)
+{
+    const TextureDescriptor& desc = textureDbg.desc;
+    if ((desc.bindFlags & (BindFlags::Sampled | BindFlags::Storage | BindFlags::CopySrc)) == 0 || IsMultiSampleTexture(desc.type))
+        return false;
+
+    const FormatAttributes& formatAttribs = GetFormatAttribs(desc.format);
+    const long unsupportedFlags = (FormatFlags::HasDepth | FormatFlags::HasStencil | FormatFlags::IsCompressed | FormatFlags::IsPacked);
+    return (formatAttribs.bitSize > 0 && (formatAttribs.flags & unsupportedFlags) == 0);
+}
+
+// Returns the extent of the specified MIP-map for a single array layer.
+static Extent3D GetSnapshotMipExtent(const TextureDescriptor& desc, std::uint32_t mipLevel)
+{
+    auto GetMipSize = [mipLevel](std::uint32_t size) -> std::uint32_t
+    {
+        return std::max(1u, size >> mipLevel);
+    };
+
+    const std::uint32_t numDims = NumTextureDimensions(desc.type);
+    return Extent3D
+    {
+        GetMipSize(desc.extent.width),
+        (numDims >= 2 ? GetMipSize(desc.extent.height) : 1u),
+        (numDims >= 3 ? GetMipSize(desc.extent.depth) : 1u)
+    };
+}
+
+
+/*
+ * DbgCapture class
+ */
+
+DbgCapture::DbgCapture(RenderSystem& renderSystemInstance, RenderingDebugger& debugger) :
+    renderSystemInstance_ { renderSystemInstance },
+    debugger_             { debugger             },
+    active_               { false                }
+{
+}
+
+DbgCapture::~DbgCapture()
+{
+    /* Write pending capture to file if the render system is released while capturing */
+    if (IsActive())
+        FinishCapture();
+}
+
+void DbgCapture::Poll(bool afterPresent)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+
+    if (IsActive())
+    {
+        if (afterPresent)
+            ++frame_;
+
+        const bool endRequested = debugger_.FetchCaptureEndRequest();
+        if (endRequested || (numFrames_ > 0 && frame_ >= numFrames_))
+            FinishCapture();
+    }
+
+    /* Only start new captures at the beginning of a frame */
+    if (!IsActive() && afterPresent)
+    {
+        UTF8String filename;
+        std::uint32_t numFrames = 0;
+        if (debugger_.FetchScheduledCapture(filename, numFrames))
+            StartCapture(filename, numFrames);
+    }
+}
+
+template <typename T>
+Capture::ObjectID DbgCapture::GetOrDefineID(const T* object, Capture::ObjectID (DbgCapture::*defineFunc)(const T&))
+{
+    if (object == nullptr)
+        return 0;
+
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+
+    if (Capture::ObjectID id = FindID(object))
+        return id;
+
+    return (this->*defineFunc)(*object);
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgBuffer* bufferDbg)
+{
+    return GetOrDefineID(bufferDbg, &DbgCapture::DefineBuffer);
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgBufferArray* bufferArrayDbg)
+{
+    return GetOrDefineID(bufferArrayDbg, &DbgCapture::DefineBufferArray);
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgTexture* textureDbg)
+{
+    return GetOrDefineID(textureDbg, &DbgCapture::DefineTexture);
+}
+
+Capture::ObjectID DbgCapture::GetID(const Sampler* sampler)
+{
+    return GetOrDefineID(sampler, &DbgCapture::DefineSampler);
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgRenderPass* renderPassDbg)
+{
+    return GetOrDefineID(renderPassDbg, &DbgCapture::DefineRenderPass);
+}
+
+Capture::ObjectID DbgCapture::GetID(const RenderTarget* renderTarget)
+{
+    if (renderTarget != nullptr && LLGL::IsInstanceOf<SwapChain>(renderTarget))
+        return GetOrDefineID(LLGL_CAST(const DbgSwapChain*, renderTarget), &DbgCapture::DefineSwapChain);
+    else
+        return GetOrDefineID(LLGL_CAST(const DbgRenderTarget*, renderTarget), &DbgCapture::DefineRenderTarget);
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgPipelineState* pipelineStateDbg)
+{
+    return GetOrDefineID(pipelineStateDbg, &DbgCapture::DefinePipelineState);
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgResourceHeap* resourceHeapDbg)
+{
+    return GetOrDefineID(resourceHeapDbg, &DbgCapture::DefineResourceHeap);
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgQueryHeap* queryHeapDbg)
+{
+    return GetOrDefineID(queryHeapDbg, &DbgCapture::DefineQueryHeap);
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgCommandBuffer* commandBufferDbg)
+{
+    return GetOrDefineID(commandBufferDbg, &DbgCapture::DefineCommandBuffer);
+}
+
+Capture::ObjectID DbgCapture::GetID(const Resource* resource)
+{
+    if (resource == nullptr)
+        return 0;
+
+    switch (resource->GetResourceType())
+    {
+        case ResourceType::Buffer:
+            return GetID(LLGL_CAST(const DbgBuffer*, resource));
+        case ResourceType::Texture:
+            return GetID(LLGL_CAST(const DbgTexture*, resource));
+        case ResourceType::Sampler:
+            return GetID(LLGL_CAST(const Sampler*, resource));
+        default:
+            return 0;
+    }
+}
+
+void DbgCapture::RecordEncoding(const DbgCommandBuffer& commandBufferDbg, const Blob& commands)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    if (!IsActive())
+        return;
+
+    const Capture::ObjectID id = GetID(&commandBufferDbg);
+    serial_.Begin(Capture::EvtEncoding);
+    {
+        serial_.WriteTyped(id);
+        serial_.Write(commands.GetData(), commands.GetSize());
+    }
+    serial_.End();
+}
+
+void DbgCapture::RecordSubmit(const DbgCommandBuffer& commandBufferDbg)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    if (!IsActive())
+        return;
+
+    const Capture::ObjectID id = GetID(&commandBufferDbg);
+    serial_.WriteSegment(Capture::EvtSubmit, &id, sizeof(id));
+}
+
+void DbgCapture::RecordPresent(const DbgSwapChain& swapChainDbg)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    if (!IsActive())
+        return;
+
+    const Capture::ObjectID id = GetID(&swapChainDbg);
+    serial_.WriteSegment(Capture::EvtPresent, &id, sizeof(id));
+}
+
+void DbgCapture::RecordWriteBuffer(const DbgBuffer& bufferDbg, std::uint64_t offset, const void* data, std::uint64_t dataSize)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    if (!IsActive() || data == nullptr)
+        return;
+
+    /* A new buffer definition already contains the written data in its snapshot */
+    if (FindID(&bufferDbg) == 0)
+    {
+        GetID(&bufferDbg);
+        return;
+    }
+
+    const Capture::ObjectID id = GetID(&bufferDbg);
+    serial_.Begin(Capture::EvtWriteBuffer);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(offset);
+        serial_.WriteTyped(dataSize);
+        serial_.Write(data, static_cast<std::size_t>(dataSize));
+    }
+    serial_.End();
+}
+
+void DbgCapture::RecordWriteTexture(const DbgTexture& textureDbg, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    if (!IsActive() || imageDesc.data == nullptr)
+        return;
+
+    /* A new texture definition already contains the written data if a snapshot is supported for its format */
+    if (FindID(&textureDbg) == 0 && IsTextureSnapshotSupported(textureDbg))
+    {
+        GetID(&textureDbg);
+        return;
+    }
+
+    const Capture::ObjectID id = GetID(&textureDbg);
+    serial_.Begin(Capture::EvtWriteTexture);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(textureRegion);
+        serial_.WriteTyped(imageDesc.format);
+        serial_.WriteTyped(imageDesc.dataType);
+        serial_.WriteTyped(static_cast<std::uint64_t>(imageDesc.dataSize));
+        serial_.Write(imageDesc.data, imageDesc.dataSize);
+    }
+    serial_.End();
+}
+
+void DbgCapture::RecordWriteResourceHeap(const DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    if (!IsActive())
+        return;
+
+    /* A new resource heap definition already contains the current resource views */
+    if (FindID(&resourceHeapDbg) == 0)
+    {
+        GetID(&resourceHeapDbg);
+        return;
+    }
+
+    /* Resolve all resource IDs before the event is written, since they might write new object definitions */
+    for (const ResourceViewDescriptor& resourceView : resourceViews)
+        GetID(resourceView.resource);
+
+    const Capture::ObjectID id = GetID(&resourceHeapDbg);
+    serial_.Begin(Capture::EvtWriteResourceHeap);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(firstDescriptor);
+        WriteResourceViews(resourceViews);
+    }
+    serial_.End();
+}
+
+void DbgCapture::RecordMapBuffer(const DbgBuffer& bufferDbg, const CPUAccess access, std::uint64_t offset, std::uint64_t length, const void* data)
+{
+    if (access == CPUAccess::ReadOnly || data == nullptr)
+        return;
+
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    if (IsActive())
+        mappedBuffers_.push_back(MappedBufferRange{ &bufferDbg, offset, length, data });
+}
+
+void DbgCapture::RecordUnmapBuffer(const DbgBuffer& bufferDbg)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+
+    auto it = std::find_if(
+        mappedBuffers_.begin(), mappedBuffers_.end(),
+        [&bufferDbg](const MappedBufferRange& entry) -> bool
+        {
+            return (entry.buffer == &bufferDbg);
+        }
+    );
+
+    if (it != mappedBuffers_.end())
+    {
+        /* Record mapped range as buffer write, since the written bytes cannot be tracked */
+        const MappedBufferRange range = *it;
+        mappedBuffers_.erase(it);
+        RecordWriteBuffer(bufferDbg, range.offset, range.data, range.length);
+    }
+}
+
+void DbgCapture::RegisterSampler(const Sampler& sampler, const SamplerDescriptor& samplerDesc)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    samplerDescs_[&sampler] = samplerDesc;
+}
+
+void DbgCapture::RegisterSwapChain(const DbgSwapChain& swapChainDbg)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    swapChains_.push_back(&swapChainDbg);
+}
+
+void DbgCapture::ReleaseObject(const void* object)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    objectIDs_.erase(object);
+    samplerDescs_.erase(static_cast<const Sampler*>(object));
+    swapChains_.erase(std::remove(swapChains_.begin(), swapChains_.end(), object), swapChains_.end());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void DbgCapture::StartCapture(const UTF8String& filename, std::uint32_t numFrames)
+{
+    filename_   = filename;
+    numFrames_  = numFrames;
+    frame_      = 0;
+    nextID_     = 1;
+
+    objectIDs_.clear();
+    mappedBuffers_.clear();
+
+    Capture::CaptureHeader header;
+    {
+        header.magic            = Capture::magic;
+        header.version          = Capture::version;
+        header.layoutSignature  = Capture::GetLayoutSignature();
+        header.rendererID       = renderSystemInstance_.GetRendererID();
+    }
+    serial_.WriteSegment(Capture::Header, &header, sizeof(header));
+
+    active_ = true;
+}
+
+void DbgCapture::FinishCapture()
+{
+    active_ = false;
+
+    objectIDs_.clear();
+    mappedBuffers_.clear();
+
+    const Blob capture = serial_.Finalize();
+
+    std::ofstream file{ filename_.c_str(), std::ios_base::out | std::ios_base::binary };
+    if (file.good())
+    {
+        file.write(static_cast<const char*>(capture.GetData()), static_cast<std::streamsize>(capture.GetSize()));
+        Log::Printf("Capture written to file: %s (%u frame(s), %zu bytes)\n", filename_.c_str(), frame_, capture.GetSize());
+    }
+    else
+        debugger_.PostError(ErrorType::InvalidState, std::string("failed to write capture to file: ") + filename_.c_str());
+
+    debugger_.NotifyCaptureFinished();
+}
+
+Capture::ObjectID DbgCapture::FindID(const void* object) const
+{
+    auto it = objectIDs_.find(object);
+    return (it != objectIDs_.end() ? it->second : 0);
+}
+
+Capture::ObjectID DbgCapture::NewID(const void* object)
+{
+    const Capture::ObjectID id = nextID_++;
+    objectIDs_[object] = id;
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineBuffer(const DbgBuffer& bufferDbg)
+{
+    const BufferDescriptor& desc = bufferDbg.desc;
+    const Capture::ObjectID id = NewID(&bufferDbg);
+
+    /* Read current buffer content as initial data; uninitialized buffers are only written by the GPU */
+    std::vector<char> data;
+    if (bufferDbg.initialized && !bufferDbg.IsMappedForCPUAccess() && desc.size > 0)
+    {
+        data.resize(static_cast<std::size_t>(desc.size));
+        renderSystemInstance_.ReadBuffer(bufferDbg.instance, 0, data.data(), desc.size);
+    }
+
+    serial_.Begin(Capture::DefBuffer);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(desc.size);
+        serial_.WriteTyped(desc.stride);
+        serial_.WriteTyped(desc.format);
+        serial_.WriteTyped(desc.bindFlags);
+        serial_.WriteTyped(desc.cpuAccessFlags);
+        serial_.WriteTyped(desc.miscFlags);
+        serial_.WriteTyped(static_cast<std::uint32_t>(desc.vertexAttribs.size()));
+        for (const VertexAttribute& attrib : desc.vertexAttribs)
+            WriteVertexAttribute(serial_, attrib);
+        serial_.WriteTyped(static_cast<std::uint64_t>(data.size()));
+        serial_.Write(data.data(), data.size());
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineBufferArray(const DbgBufferArray& bufferArrayDbg)
+{
+    std::vector<Capture::ObjectID> bufferIDs;
+    bufferIDs.reserve(bufferArrayDbg.buffers.size());
+    for (const DbgBuffer* bufferDbg : bufferArrayDbg.buffers)
+        bufferIDs.push_back(GetID(bufferDbg));
+
+    const Capture::ObjectID id = NewID(&bufferArrayDbg);
+
+    serial_.Begin(Capture::DefBufferArray);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(static_cast<std::uint32_t>(bufferIDs.size()));
+        serial_.Write(bufferIDs.data(), bufferIDs.size() * sizeof(Capture::ObjectID));
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineTexture(const DbgTexture& textureDbg)
+{
+    const Capture::ObjectID id = NewID(&textureDbg);
+
+    serial_.Begin(Capture::DefTexture);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(textureDbg.desc);
+        WriteTextureSnapshot(textureDbg);
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineSampler(const Sampler& sampler)
+{
+    auto it = samplerDescs_.find(&sampler);
+    const SamplerDescriptor samplerDesc = (it != samplerDescs_.end() ? it->second : SamplerDescriptor{});
+
+    const Capture::ObjectID id = NewID(&sampler);
+
+    serial_.Begin(Capture::DefSampler);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(samplerDesc);
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineRenderPass(const DbgRenderPass& renderPassDbg)
+{
+    const Capture::ObjectID id = NewID(&renderPassDbg);
+
+    serial_.Begin(Capture::DefRenderPass);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(renderPassDbg.desc);
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineRenderTarget(const DbgRenderTarget& renderTargetDbg)
+{
+    const RenderTargetDescriptor& desc = renderTargetDbg.desc;
+
+    /* Attachments are serialized in the order: color attachments, resolve attachments, depth-stencil attachment */
+    const AttachmentDescriptor* attachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1];
+    for_range(i, LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+    {
+        attachments[i]                                  = &(desc.colorAttachments[i]);
+        attachments[i + LLGL_MAX_NUM_COLOR_ATTACHMENTS] = &(desc.resolveAttachments[i]);
+    }
+    attachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS*2] = &(desc.depthStencilAttachment);
+
+    Capture::ObjectID textureIDs[LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1];
+    for_range(i, LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1)
+        textureIDs[i] = GetID(LLGL_CAST(const DbgTexture*, attachments[i]->texture));
+
+    const Capture::ObjectID shadingRateImageID = GetID(LLGL_CAST(const DbgTexture*, desc.shadingRateImage));
+    const Capture::ObjectID renderPassID = GetID(LLGL_CAST(const DbgRenderPass*, desc.renderPass));
+    const Capture::ObjectID id = NewID(&renderTargetDbg);
+
+    serial_.Begin(Capture::DefRenderTarget);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(renderPassID);
+        serial_.WriteTyped(desc.resolution);
+        serial_.WriteTyped(desc.samples);
+        serial_.WriteTyped(static_cast<std::uint32_t>(LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1));
+        for_range(i, LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1)
+        {
+            serial_.WriteTyped(attachments[i]->format);
+            serial_.WriteTyped(textureIDs[i]);
+            serial_.WriteTyped(attachments[i]->mipLevel);
+            serial_.WriteTyped(attachments[i]->arrayLayer);
+        }
+        serial_.WriteTyped(shadingRateImageID);
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineSwapChain(const DbgSwapChain& swapChainDbg)
+{
+    const Capture::ObjectID id = NewID(&swapChainDbg);
+
+    serial_.Begin(Capture::DefSwapChain);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(swapChainDbg.GetResolution());
+        serial_.WriteTyped(swapChainDbg.desc.samples);
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgShader* shaderDbg)
+{
+    return GetOrDefineID(shaderDbg, &DbgCapture::DefineShader);
+}
+
+Capture::ObjectID DbgCapture::DefineShader(const DbgShader& shaderDbg)
+{
+    const ShaderDescriptor& desc = shaderDbg.desc;
+    const Capture::ObjectID id = NewID(&shaderDbg);
+
+    serial_.Begin(Capture::DefShader);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(desc.type);
+        serial_.WriteTyped(desc.sourceType);
+        serial_.WriteTyped(static_cast<std::uint64_t>(desc.source != nullptr ? desc.sourceSize : 0));
+        serial_.Write(desc.source, (desc.source != nullptr ? desc.sourceSize : 0));
+        serial_.WriteCString(desc.entryPoint != nullptr ? desc.entryPoint : "");
+        serial_.WriteCString(desc.profile != nullptr ? desc.profile : "");
+        serial_.WriteTyped(desc.flags);
+
+        std::uint32_t numDefines = 0;
+        for (const ShaderMacro* macro = desc.defines; macro != nullptr && macro->name != nullptr; ++macro)
+            ++numDefines;
+
+        serial_.WriteTyped(numDefines);
+        for_range(i, numDefines)
+        {
+            serial_.WriteCString(desc.defines[i].name);
+            serial_.WriteCString(desc.defines[i].definition);
+        }
+
+        serial_.WriteTyped(static_cast<std::uint32_t>(desc.vertex.inputAttribs.size()));
+        for (const VertexAttribute& attrib : desc.vertex.inputAttribs)
+            WriteVertexAttribute(serial_, attrib);
+
+        serial_.WriteTyped(static_cast<std::uint32_t>(desc.vertex.outputAttribs.size()));
+        for (const VertexAttribute& attrib : desc.vertex.outputAttribs)
+            WriteVertexAttribute(serial_, attrib);
+
+        serial_.WriteTyped(static_cast<std::uint32_t>(desc.fragment.outputAttribs.size()));
+        for (const FragmentAttribute& attrib : desc.fragment.outputAttribs)
+        {
+            serial_.WriteCString(attrib.name.c_str());
+            serial_.WriteTyped(attrib.format);
+            serial_.WriteTyped(attrib.location);
+            serial_.WriteTyped(attrib.systemValue);
+        }
+
+        serial_.WriteTyped(desc.compute.workGroupSize);
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::GetID(const DbgPipelineLayout* pipelineLayoutDbg)
+{
+    return GetOrDefineID(pipelineLayoutDbg, &DbgCapture::DefinePipelineLayout);
+}
+
+Capture::ObjectID DbgCapture::DefinePipelineLayout(const DbgPipelineLayout& pipelineLayoutDbg)
+{
+    const PipelineLayoutDescriptor& desc = pipelineLayoutDbg.desc;
+    const Capture::ObjectID id = NewID(&pipelineLayoutDbg);
+
+    serial_.Begin(Capture::DefPipelineLayout);
+    {
+        serial_.WriteTyped(id);
+        WriteBindingDescriptors(serial_, desc.heapBindings);
+        WriteBindingDescriptors(serial_, desc.bindings);
+
+        serial_.WriteTyped(static_cast<std::uint32_t>(desc.staticSamplers.size()));
+        for (const StaticSamplerDescriptor& staticSampler : desc.staticSamplers)
+        {
+            serial_.WriteCString(staticSampler.name.c_str());
+            serial_.WriteTyped(staticSampler.stageFlags);
+            serial_.WriteTyped(staticSampler.slot.index);
+            serial_.WriteTyped(staticSampler.slot.set);
+            serial_.WriteTyped(staticSampler.sampler);
+        }
+
+        serial_.WriteTyped(static_cast<std::uint32_t>(desc.uniforms.size()));
+        for (const UniformDescriptor& uniform : desc.uniforms)
+        {
+            serial_.WriteCString(uniform.name.c_str());
+            serial_.WriteTyped(uniform.type);
+            serial_.WriteTyped(uniform.arraySize);
+        }
+
+        serial_.WriteTyped(static_cast<std::uint8_t>(desc.bindlessHeap ? 1 : 0));
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefinePipelineState(const DbgPipelineState& pipelineStateDbg)
+{
+    const Capture::ObjectID pipelineLayoutID = GetID(pipelineStateDbg.pipelineLayout);
+
+    if (pipelineStateDbg.isGraphicsPSO)
+    {
+        const GraphicsPipelineDescriptor& desc = pipelineStateDbg.graphicsDesc;
+
+        /* Swap-chain render passes are replaced by the render pass of the swap-chain that is used for the replay */
+        Capture::RenderPassKind renderPassKind = Capture::RenderPassKind::None;
+        if (desc.renderPass != nullptr)
+        {
+            auto IsSwapChainRenderPass = [&desc](const DbgSwapChain* swapChainDbg) -> bool
+            {
+                return (swapChainDbg->GetRenderPass() == desc.renderPass);
+            };
+            if (std::find_if(swapChains_.begin(), swapChains_.end(), IsSwapChainRenderPass) != swapChains_.end())
+                renderPassKind = Capture::RenderPassKind::SwapChain;
+            else
+                renderPassKind = Capture::RenderPassKind::Custom;
+        }
+
+        const Capture::ObjectID renderPassID = (renderPassKind == Capture::RenderPassKind::Custom ? GetID(LLGL_CAST(const DbgRenderPass*, desc.renderPass)) : 0);
+
+        const Capture::ObjectID shaderIDs[] =
+        {
+            GetID(LLGL_CAST(const DbgShader*, desc.vertexShader)),
+            GetID(LLGL_CAST(const DbgShader*, desc.tessControlShader)),
+            GetID(LLGL_CAST(const DbgShader*, desc.tessEvaluationShader)),
+            GetID(LLGL_CAST(const DbgShader*, desc.geometryShader)),
+            GetID(LLGL_CAST(const DbgShader*, desc.fragmentShader)),
+            GetID(LLGL_CAST(const DbgShader*, desc.taskShader)),
+            GetID(LLGL_CAST(const DbgShader*, desc.meshShader)),
+        };
+
+        const Capture::ObjectID id = NewID(&pipelineStateDbg);
+
+        serial_.Begin(Capture::DefPipelineState);
+        {
+            serial_.WriteTyped(id);
+            serial_.WriteTyped(static_cast<std::uint8_t>(1));
+            serial_.WriteTyped(pipelineLayoutID);
+            serial_.WriteTyped(renderPassKind);
+            serial_.WriteTyped(renderPassID);
+            serial_.Write(shaderIDs, sizeof(shaderIDs));
+            serial_.WriteTyped(desc.primitiveTopology);
+            serial_.WriteTyped(static_cast<std::uint32_t>(desc.viewports.size()));
+            serial_.Write(desc.viewports.data(), desc.viewports.size() * sizeof(Viewport));
+            serial_.WriteTyped(static_cast<std::uint32_t>(desc.scissors.size()));
+            serial_.Write(desc.scissors.data(), desc.scissors.size() * sizeof(Scissor));
+            serial_.WriteTyped(desc.depth);
+            serial_.WriteTyped(desc.stencil);
+            serial_.WriteTyped(desc.rasterizer);
+            serial_.WriteTyped(desc.blend);
+            serial_.WriteTyped(desc.tessellation);
+            serial_.WriteTyped(desc.shadingRate);
+            serial_.WriteTyped(desc.viewMask);
+        }
+        serial_.End();
+
+        return id;
+    }
+    else
+    {
+        const ComputePipelineDescriptor& desc = pipelineStateDbg.computeDesc;
+
+        const Capture::ObjectID shaderID = GetID(LLGL_CAST(const DbgShader*, desc.computeShader));
+        const Capture::ObjectID id = NewID(&pipelineStateDbg);
+
+        serial_.Begin(Capture::DefPipelineState);
+        {
+            serial_.WriteTyped(id);
+            serial_.WriteTyped(static_cast<std::uint8_t>(0));
+            serial_.WriteTyped(pipelineLayoutID);
+            serial_.WriteTyped(shaderID);
+            serial_.WriteTyped(desc.requiredSubgroupSize);
+        }
+        serial_.End();
+
+        return id;
+    }
+}
+
+Capture::ObjectID DbgCapture::DefineResourceHeap(const DbgResourceHeap& resourceHeapDbg)
+{
+    const Capture::ObjectID pipelineLayoutID = GetID(LLGL_CAST(const DbgPipelineLayout*, resourceHeapDbg.desc.pipelineLayout));
+
+    /* Resolve all resource IDs before the definition is written, since they might write new object definitions */
+    for (const ResourceViewDescriptor& resourceView : resourceHeapDbg.resourceViews)
+        GetID(resourceView.resource);
+
+    const Capture::ObjectID id = NewID(&resourceHeapDbg);
+
+    serial_.Begin(Capture::DefResourceHeap);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(pipelineLayoutID);
+        serial_.WriteTyped(resourceHeapDbg.desc.numResourceViews);
+        serial_.WriteTyped(resourceHeapDbg.desc.barrierFlags);
+        WriteResourceViews(resourceHeapDbg.resourceViews);
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineQueryHeap(const DbgQueryHeap& queryHeapDbg)
+{
+    const Capture::ObjectID id = NewID(&queryHeapDbg);
+
+    serial_.Begin(Capture::DefQueryHeap);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(queryHeapDbg.desc);
+    }
+    serial_.End();
+
+    return id;
+}
+
+Capture::ObjectID DbgCapture::DefineCommandBuffer(const DbgCommandBuffer& commandBufferDbg)
+{
+    const CommandBufferDescriptor& desc = commandBufferDbg.desc;
+
+    const Capture::ObjectID renderPassID = GetID(LLGL_CAST(const DbgRenderPass*, desc.renderPass));
+    const Capture::ObjectID id = NewID(&commandBufferDbg);
+
+    serial_.Begin(Capture::DefCommandBuffer);
+    {
+        serial_.WriteTyped(id);
+        serial_.WriteTyped(desc.flags);
+        serial_.WriteTyped(desc.numNativeBuffers);
+        serial_.WriteTyped(desc.queueType);
+        serial_.WriteTyped(renderPassID);
+    }
+    serial_.End();
+
+    return id;
+}
+
+// All resource IDs must have been resolved before this is called, since it writes into the current segment.
+void DbgCapture::WriteResourceViews(const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    serial_.WriteTyped(static_cast<std::uint32_t>(resourceViews.size()));
+    for (const ResourceViewDescriptor& resourceView : resourceViews)
+    {
+        serial_.WriteTyped(FindID(resourceView.resource));
+        serial_.WriteTyped(resourceView.textureView);
+        serial_.WriteTyped(resourceView.bufferView);
+        serial_.WriteTyped(resourceView.initialCount);
+    }
+}
+
+void DbgCapture::WriteTextureSnapshot(const DbgTexture& textureDbg)
+{
+    const TextureDescriptor& desc = textureDbg.desc;
+
+    if (!IsTextureSnapshotSupported(textureDbg))
+    {
+        serial_.WriteTyped(static_cast<std::uint32_t>(0));
+        return;
+    }
+
+    const FormatAttributes& formatAttribs = GetFormatAttribs(desc.format);
+
+    /* Read back each MIP-map with all array layers */
+    serial_.WriteTyped(textureDbg.mipLevels);
+
+    std::vector<char> data;
+    for_range(mipLevel, textureDbg.mipLevels)
+    {
+        TextureRegion region;
+        {
+            region.subresource.baseArrayLayer   = 0;
+            region.subresource.numArrayLayers   = desc.arrayLayers;
+            region.subresource.baseMipLevel     = mipLevel;
+            region.subresource.numMipLevels     = 1;
+            region.extent                       = GetSnapshotMipExtent(desc, mipLevel);
+        }
+
+        const std::size_t numTexels = region.extent.width * region.extent.height * region.extent.depth * desc.arrayLayers;
+        data.resize(GetMemoryFootprint(formatAttribs.format, formatAttribs.dataType, numTexels));
+
+        DstImageDescriptor imageDesc;
+        {
+            imageDesc.format    = formatAttribs.format;
+            imageDesc.dataType  = formatAttribs.dataType;
+            imageDesc.data      = data.data();
+            imageDesc.dataSize  = data.size();
+        }
+        renderSystemInstance_.ReadTexture(textureDbg.instance, region, imageDesc);
+
+        serial_.WriteTyped(region);
+        serial_.WriteTyped(imageDesc.format);
+        serial_.WriteTyped(imageDesc.dataType);
+        serial_.WriteTyped(static_cast<std::uint64_t>(data.size()));
+        serial_.Write(data.data(), data.size());
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,254 @@
+/*
+ * DbgCapture.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_DBG_CAPTURE_H
+#define LLGL_DBG_CAPTURE_H
+
+
+#include <LLGL/Container/ArrayView.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/SamplerFlags.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/BufferFlags.h>
+#include <LLGL/Container/Strings.h>
+#include "../CaptureFormat.h"
+#include "../Serialization.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class RenderingDebugger;
+class RenderTarget;
+class Resource;
+class Sampler;
+class DbgBuffer;
+class DbgBufferArray;
+class DbgTexture;
+class DbgRenderPass;
+class DbgRenderTarget;
+class DbgSwapChain;
+class DbgShader;
+class DbgPipelineLayout;
+class DbgPipelineState;
+class DbgResourceHeap;
+class DbgQueryHeap;
+class DbgCommandBuffer;
+
+/*
+Records all command buffer encodings, submissions, presentations, and resource updates into a capture file (see CaptureFormat.h)
+while a capture is requested by the RenderingDebugger. Objects are defined lazily the first time they are referenced during a capture,
+which includes a snapshot of the current buffer and texture contents, so the captured frames can be replayed without the application.
+*/
+class DbgCapture
+{
+
+    public:
+
+        DbgCapture(RenderSystem& renderSystemInstance, RenderingDebugger& debugger);
+        ~DbgCapture();
+
+        // Starts or finishes a capture as requested by the debugger. Captures only start after a swap-chain presentation, so they always begin with a new frame.
+        void Poll(bool afterPresent);
+
+        // Returns true while a capture is being recorded.
+        inline bool IsActive() const
+        {
+            return active_.load();
+        }
+
+    public:
+
+        // Returns the capture ID of the specified object and writes its definition on first reference. Null pointers are mapped to zero.
+        Capture::ObjectID GetID(const DbgBuffer* bufferDbg);
+        Capture::ObjectID GetID(const DbgBufferArray* bufferArrayDbg);
+        Capture::ObjectID GetID(const DbgTexture* textureDbg);
+        Capture::ObjectID GetID(const Sampler* sampler);
+        Capture::ObjectID GetID(const DbgRenderPass* renderPassDbg);
+        Capture::ObjectID GetID(const RenderTarget* renderTarget);
+        Capture::ObjectID GetID(const DbgPipelineState* pipelineStateDbg);
+        Capture::ObjectID GetID(const DbgResourceHeap* resourceHeapDbg);
+        Capture::ObjectID GetID(const DbgQueryHeap* queryHeapDbg);
+        Capture::ObjectID GetID(const DbgCommandBuffer* commandBufferDbg);
+        Capture::ObjectID GetID(const Resource* resource);
+
+    public:
+
+        void RecordEncoding(const DbgCommandBuffer& commandBufferDbg, const Blob& commands);
+        void RecordSubmit(const DbgCommandBuffer& commandBufferDbg);
+        void RecordPresent(const DbgSwapChain& swapChainDbg);
+        void RecordWriteBuffer(const DbgBuffer& bufferDbg, std::uint64_t offset, const void* data, std::uint64_t dataSize);
+        void RecordWriteTexture(const DbgTexture& textureDbg, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc);
+        void RecordWriteResourceHeap(const DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
+
+        // Keeps track of mapped buffer ranges, so the written data can be recorded when the buffer is unmapped.
+        void RecordMapBuffer(const DbgBuffer& bufferDbg, const CPUAccess access, std::uint64_t offset, std::uint64_t length, const void* data);
+        void RecordUnmapBuffer(const DbgBuffer& bufferDbg);
+
+    public:
+
+        // Samplers are not wrapped by the debug layer, so their descriptors are stored separately.
+        void RegisterSampler(const Sampler& sampler, const SamplerDescriptor& samplerDesc);
+
+        // Swap-chains are registered to detect their render passes in pipeline state definitions.
+        void RegisterSwapChain(const DbgSwapChain& swapChainDbg);
+
+        // Removes the specified object from all tables, since a new object might be allocated at the same address.
+        void ReleaseObject(const void* object);
+
+    private:
+
+        struct MappedBufferRange
+        {
+            const DbgBuffer*    buffer;
+            std::uint64_t       offset;
+            std::uint64_t       length;
+            const void*         data;
+        };
+
+    private:
+
+        void StartCapture(const UTF8String& filename, std::uint32_t numFrames);
+        void FinishCapture();
+
+        Capture::ObjectID FindID(const void* object) const;
+        Capture::ObjectID NewID(const void* object);
+
+        template <typename T>
+        Capture::ObjectID GetOrDefineID(const T* object, Capture::ObjectID (DbgCapture::*defineFunc)(const T&));
+
+        Capture::ObjectID DefineBuffer(const DbgBuffer& bufferDbg);
+        Capture::ObjectID DefineBufferArray(const DbgBufferArray& bufferArrayDbg);
+        Capture::ObjectID DefineTexture(const DbgTexture& textureDbg);
+        Capture::ObjectID DefineSampler(const Sampler& sampler);
+        Capture::ObjectID DefineRenderPass(const DbgRenderPass& renderPassDbg);
+        Capture::ObjectID DefineRenderTarget(const DbgRenderTarget& renderTargetDbg);
+        Capture::ObjectID DefineSwapChain(const DbgSwapChain& swapChainDbg);
+        Capture::ObjectID DefineShader(const DbgShader& shaderDbg);
+        Capture::ObjectID DefinePipelineLayout(const DbgPipelineLayout& pipelineLayoutDbg);
+        Capture::ObjectID DefinePipelineState(const DbgPipelineState& pipelineStateDbg);
+        Capture::ObjectID DefineResourceHeap(const DbgResourceHeap& resourceHeapDbg);
+        Capture::ObjectID DefineQueryHeap(const DbgQueryHeap& queryHeapDbg);
+        Capture::ObjectID DefineCommandBuffer(const DbgCommandBuffer& commandBufferDbg);
+
+        Capture::ObjectID GetID(const DbgShader* shaderDbg);
+        Capture::ObjectID GetID(const DbgPipelineLayout* pipelineLayoutDbg);
+
+        void WriteResourceViews(const ArrayView<ResourceViewDescriptor>& resourceViews);
+        void WriteTextureSnapshot(const DbgTexture& textureDbg);
+
+    private:
+
+        RenderSystem&                                           renderSystemInstance_;
+        RenderingDebugger&                                      debugger_;
+
+        std::recursive_mutex                                    mutex_;         // Guards all members below; recursive, since definitions refer to other objects
+        std::atomic<bool>                                       active_;
+        Serialization::Serializer                               serial_;
+        UTF8String                                              filename_;
+        std::uint32_t                                           numFrames_      = 0;
+        std::uint32_t                                           frame_          = 0;
+        Capture::ObjectID                                       nextID_         = 1;
+        std::unordered_map<const void*, Capture::ObjectID>      objectIDs_;
+        std::unordered_map<const Sampler*, SamplerDescriptor>   samplerDescs_;
+        std::vector<const DbgSwapChain*>                        swapChains_;
+        std::vector<MappedBufferRange>                          mappedBuffers_;
+
+};
+
+/*
+Command stream of a single command buffer encoding. All arguments are written as raw memory,
+so object references must be converted into their capture IDs (see DbgCapture::GetID) and arrays must be wrapped into DbgCaptureData.
+*/
+class DbgCaptureStream
+{
+
+    public:
+
+        struct DbgCaptureData
+        {
+            const void* data;
+            std::size_t size;
+        };
+
+    public:
+
+        template <typename... TArgs>
+        void Record(Capture::Ident ident, const TArgs&... args)
+        {
+            serial_.Begin(ident);
+            WriteArgs(args...);
+            serial_.End();
+        }
+
+        // Returns the recorded command stream and resets this stream for the next encoding.
+        inline Blob Finalize()
+        {
+            return serial_.Finalize();
+        }
+
+    public:
+
+        // Wraps the specified array of standard layout types to be written as raw memory.
+        template <typename T>
+        static DbgCaptureData Array(const T* data, std::size_t count)
+        {
+            static_assert(std::is_standard_layout<T>::value, "LLGL::DbgCaptureStream::Array<T> only accepts standard layout types");
+            return DbgCaptureData{ data, sizeof(T) * count };
+        }
+
+    private:
+
+        inline void WriteArgs()
+        {
+        }
+
+        template <typename TFirst, typename... TNext>
+        void WriteArgs(const TFirst& first, const TNext&... next)
+        {
+            WriteArg(first);
+            WriteArgs(next...);
+        }
+
+        template <typename T>
+        void WriteArg(const T& arg)
+        {
+            serial_.WriteTyped(arg);
+        }
+
+        void WriteArg(const DbgCaptureData& arg)
+        {
+            serial_.WriteTyped(static_cast<std::uint64_t>(arg.size));
+            serial_.Write(arg.data, arg.size);
+        }
+
+        void WriteArg(const char* arg)
+        {
+            serial_.WriteCString(arg != nullptr ? arg : "");
+        }
+
+    private:
+
+        Serialization::Serializer serial_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
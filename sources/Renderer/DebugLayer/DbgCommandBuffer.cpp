@@ -9,13 +9,17 @@
 #include "DbgCore.h"
 #include "../CheckedCast.h"
 #include "../ResourceUtils.h"
+#include "../BufferUtils.h"
 #include "../PipelineStateUtils.h"
 #include "../../Core/StringUtils.h"
 #include "../../Core/Assertion.h"
 
 #include "DbgSwapChain.h"
+#include "DbgCommandQueue.h"
+#include "DbgCapture.h"
 #include "Buffer/DbgBuffer.h"
 #include "Buffer/DbgBufferArray.h"
+#include "Buffer/DbgAccelerationStructure.h"
 #include "RenderState/DbgQueryHeap.h"
 #include "RenderState/DbgPipelineState.h"
 #include "RenderState/DbgPipelineLayout.h"
@@ -51,6 +55,12 @@ namespace LLGL
 #define LLGL_DBG_ASSERT_PTR(NAME) \
     AssertNullPointer(NAME, #NAME)
 
+#define LLGL_DBG_CAPTURE(IDENT, ...)                                        \
+    if (capturing_)                                                         \
+    {                                                                       \
+        captureStream_.Record(Capture::IDENT LLGL_VA_ARGS(__VA_ARGS__));    \
+    }
+
 static const char* GetLabelOrDefault(const std::string& label, const char* defaultLabel)
 {
     if (label.empty())
@@ -62,19 +72,28 @@ static const char* GetLabelOrDefault(const std::string& label, const char* defau
 DbgCommandBuffer::DbgCommandBuffer(
     RenderSystem&                   renderSystemInstance,
     CommandQueue&                   commandQueueInstance,
+    DbgCommandQueue*                commandQueueDbg,
     CommandBuffer&                  commandBufferInstance,
     RenderingDebugger*              debugger,
     RenderingProfiler*              profiler,
+    DbgCapture*                     capture,
+    DbgValidationWorker*            validationWorker,
     const CommandBufferDescriptor&  desc,
     const RenderingCapabilities&    caps)
 :
-    instance   { commandBufferInstance                                             },
-    desc       { desc                                                              },
-    debugger_  { debugger                                                          },
-    profiler_  { profiler                                                          },
-    features_  { caps.features                                                     },
-    limits_    { caps.limits                                                       },
-    timerMngr_ { renderSystemInstance, commandQueueInstance, commandBufferInstance }
+    instance                { commandBufferInstance                                             },
+    desc                    { desc                                                              },
+    debugger_               { debugger                                                          },
+    attachedDebugger_       { debugger                                                          },
+    profiler_               { profiler                                                          },
+    commandQueueInstance_   { commandQueueInstance                                              },
+    commandQueueDbg_        { commandQueueDbg                                                   },
+    features_               { caps.features                                                     },
+    limits_                 { caps.limits                                                       },
+    timerMngr_              { renderSystemInstance, commandQueueInstance, commandBufferInstance },
+    scopeProfiler_          { renderSystemInstance, commandQueueInstance, commandBufferInstance },
+    capture_                { capture                                                           },
+    validationWorker_       { validationWorker                                                  }
 {
 }
 
@@ -86,30 +105,69 @@ void DbgCommandBuffer::Begin()
     ResetStates();
     ResetRecords();
 
+    /* Determine whether this encoding is validated */
+    SelectValidationForEncoding();
+    validationGroup_        = 0;
+    validationGroupDirty_   = true;
+
+    /* Performance lints are only checked for validated encodings, but every encoding begins a new frame */
+    lintEnabled_ = DbgIsPerformanceLintEnabled(debugger_);
+    if (attachedDebugger_ != nullptr)
+        attachedDebugger_->NotifyFrameEncoding();
+
     /* Enable performance profiler if it was scheduled */
     perfProfilerEnabled_ = (profiler_ != nullptr && profiler_->timeRecordingEnabled);
     if (perfProfilerEnabled_)
-        timerMngr_.Reset();
+        timerMngr_.Begin();
 
     /* Begin with command recording  */
     if (debugger_)
         EnableRecording(true);
 
+    /* Record commands of this encoding if a capture is active */
+    capturing_ = (capture_ != nullptr && capture_->IsActive());
+
     instance.Begin();
 
+    /* Enable scope profiler after the instance has begun encoding, since it records timestamp queries */
+    scopeProfilerEnabled_ = (profiler_ != nullptr && profiler_->scopeProfilingEnabled);
+    if (scopeProfilerEnabled_)
+        scopeProfiler_.Begin(profiler_->pipelineStatisticsEnabled);
+
     profile_.commandBufferEncodings++;
 }
 
 void DbgCommandBuffer::End()
 {
+    /* Close remaining scopes before the instance ends encoding */
+    if (scopeProfilerEnabled_)
+        scopeProfiler_.End();
+
     /* End with command recording */
     if (debugger_)
         EnableRecording(false);
     instance.End();
 
-    /* Resolve timer query results for performance profiler */
+    /* Schedule timer queries to be resolved once the GPU has finished this command buffer */
     if (perfProfilerEnabled_)
-        timerMngr_.TakeRecords(profile_.timeRecords);
+        timerMngr_.End();
+
+    /* Pass recorded commands to capture; immediate command buffers are implicitly submitted */
+    if (capturing_)
+    {
+        capture_->RecordEncoding(*this, captureStream_.Finalize());
+        if ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0)
+            capture_->RecordSubmit(*this);
+        capturing_ = false;
+    }
+
+    /* Hand over the draw and dispatch commands of this encoding to the validation worker */
+    if (asyncValidation_)
+        validationWorker_->Submit(validationLog_);
+
+    /* Immediate command buffers are implicitly submitted, so their buffer writes are pending from now on */
+    if (commandQueueDbg_ != nullptr && (desc.flags & CommandBufferFlags::ImmediateSubmit) != 0)
+        commandQueueDbg_->RecordBufferWrites(records_.writtenBuffers);
 }
 
 void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
@@ -131,9 +189,21 @@ void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
         );
     }
 
+    LLGL_DBG_CAPTURE( CmdExecute, capture_->GetID(&commandBufferDbg) );
     LLGL_DBG_COMMAND( "Execute", instance.Execute(commandBufferDbg.instance) );
 }
 
+void DbgCommandBuffer::TrimMemory()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (states_.recording)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot trim memory of command buffer while it is in record mode; missing call to <LLGL::CommandBuffer::End>");
+    }
+    instance.TrimMemory();
+}
+
 /* ----- Blitting ----- */
 
 void DbgCommandBuffer::UpdateBuffer(
@@ -149,8 +219,23 @@ void DbgCommandBuffer::UpdateBuffer(
         LLGL_DBG_SOURCE;
         AssertRecording();
         ValidateBufferRange(dstBufferDbg, dstOffset, dataSize, "destination range");
+        ValidateCopyDestinationBuffer(dstBufferDbg);
+
+        if (lintEnabled_)
+        {
+            RecordBufferWrite(dstBufferDbg);
+            if (dataSize > debugger_->GetBufferUpdateThreshold())
+            {
+                LLGL_DBG_LINT(
+                    PerformanceLint::LargeBufferUpdate,
+                    "updating " + std::to_string(dataSize) + " bytes exceeds threshold of " + std::to_string(debugger_->GetBufferUpdateThreshold()) +
+                    " bytes for cheap buffer updates; consider RenderSystem::WriteBuffer or a persistently mapped buffer"
+                );
+            }
+        }
     }
 
+    LLGL_DBG_CAPTURE( CmdUpdateBuffer, capture_->GetID(&dstBufferDbg), dstOffset, DbgCaptureStream::Array(static_cast<const char*>(data), dataSize) );
     LLGL_DBG_COMMAND( "UpdateBuffer", instance.UpdateBuffer(dstBufferDbg.instance, dstOffset, data, dataSize) );
 
     profile_.bufferUpdates++;
@@ -174,8 +259,11 @@ void DbgCommandBuffer::CopyBuffer(
         ValidateBufferRange(srcBufferDbg, srcOffset, size, "source range");
         ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
         ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
+        ValidateCopyDestinationBuffer(dstBufferDbg);
+        RecordBufferWrite(dstBufferDbg);
     }
 
+    LLGL_DBG_CAPTURE( CmdCopyBuffer, capture_->GetID(&dstBufferDbg), dstOffset, capture_->GetID(&srcBufferDbg), srcOffset, size );
     LLGL_DBG_COMMAND( "CopyBuffer", instance.CopyBuffer(dstBufferDbg.instance, dstOffset, srcBufferDbg.instance, srcOffset, size) );
 
     profile_.bufferCopies++;
@@ -204,12 +292,15 @@ void DbgCommandBuffer::CopyBufferFromTexture(
         LLGL_DBG_SOURCE;
         AssertRecording();
         ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+        ValidateCopyDestinationBuffer(dstBufferDbg);
         ValidateBufferRange(dstBufferDbg, dstOffset, GetTextureRegionMinFootprint(srcTextureDbg, srcRegion));
         ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
         ValidateTextureRegion(srcTextureDbg, srcRegion);
         ValidateTextureBufferCopyStrides(srcTextureDbg, rowStride, layerStride, srcRegion.extent);
+        RecordBufferWrite(dstBufferDbg);
     }
 
+    LLGL_DBG_CAPTURE( CmdCopyBufferFromTexture, capture_->GetID(&dstBufferDbg), dstOffset, capture_->GetID(&srcTextureDbg), srcRegion, rowStride, layerStride );
     LLGL_DBG_COMMAND( "CopyBufferFromTexture", instance.CopyBufferFromTexture(dstBufferDbg.instance, dstOffset, srcTextureDbg.instance, srcRegion, rowStride, layerStride) );
 
     profile_.bufferCopies++;
@@ -228,6 +319,7 @@ void DbgCommandBuffer::FillBuffer(
         LLGL_DBG_SOURCE;
         AssertRecording();
         ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+        ValidateCopyDestinationBuffer(dstBufferDbg);
 
         if (fillSize == Constants::wholeSize)
         {
@@ -240,13 +332,64 @@ void DbgCommandBuffer::FillBuffer(
                 LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill size is not a multiple of 4");
             ValidateBufferRange(dstBufferDbg, dstOffset, fillSize);
         }
+
+        RecordBufferWrite(dstBufferDbg);
     }
 
+    LLGL_DBG_CAPTURE( CmdFillBuffer, capture_->GetID(&dstBufferDbg), dstOffset, value, fillSize );
     LLGL_DBG_COMMAND( "FillBuffer", instance.FillBuffer(dstBufferDbg.instance, dstOffset, value, fillSize) );
 
     profile_.bufferFills++;
 }
 
+void DbgCommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+        ValidateCopyDestinationBuffer(dstBufferDbg);
+
+        if (pattern == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill pattern must not be null");
+
+        if (!(patternSize == 4 || patternSize == 8 || patternSize == 16))
+        {
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill pattern size must be 4, 8, or 16, but " + std::to_string(patternSize) + " was specified");
+        }
+        else if (fillSize == Constants::wholeSize)
+        {
+            if (dstOffset != 0)
+                LLGL_DBG_WARN(WarningType::ImproperArgument, "non-zero argument for 'dstOffset' is ignored because 'fillSize' is set to LLGL::wholeSize");
+            if (dstBufferDbg.desc.size % patternSize != 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer size is not a multiple of the fill pattern size " + std::to_string(patternSize));
+        }
+        else
+        {
+            if (dstOffset % patternSize != 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill offset is not a multiple of the fill pattern size " + std::to_string(patternSize));
+            if (fillSize % patternSize != 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill size is not a multiple of the fill pattern size " + std::to_string(patternSize));
+            ValidateBufferRange(dstBufferDbg, dstOffset, fillSize);
+        }
+
+        RecordBufferWrite(dstBufferDbg);
+    }
+
+    LLGL_DBG_CAPTURE( CmdFillBufferPattern, capture_->GetID(&dstBufferDbg), dstOffset, DbgCaptureStream::Array(static_cast<const char*>(pattern), patternSize), fillSize );
+    LLGL_DBG_COMMAND( "FillBufferPattern", instance.FillBufferPattern(dstBufferDbg.instance, dstOffset, pattern, patternSize, fillSize) );
+
+    profile_.bufferFills++;
+}
+
 void DbgCommandBuffer::CopyTexture(
     Texture&                dstTexture,
     const TextureLocation&  dstLocation,
@@ -265,6 +408,7 @@ void DbgCommandBuffer::CopyTexture(
         ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
     }
 
+    LLGL_DBG_CAPTURE( CmdCopyTexture, capture_->GetID(&dstTextureDbg), dstLocation, capture_->GetID(&srcTextureDbg), srcLocation, extent );
     LLGL_DBG_COMMAND( "CopyTexture", instance.CopyTexture(dstTextureDbg.instance, dstLocation, srcTextureDbg.instance, srcLocation, extent) );
 
     profile_.textureCopies++;
@@ -292,6 +436,7 @@ void DbgCommandBuffer::CopyTextureFromBuffer(
         ValidateTextureBufferCopyStrides(dstTextureDbg, rowStride, layerStride, dstRegion.extent);
     }
 
+    LLGL_DBG_CAPTURE( CmdCopyTextureFromBuffer, capture_->GetID(&dstTextureDbg), dstRegion, capture_->GetID(&srcBufferDbg), srcOffset, rowStride, layerStride );
     LLGL_DBG_COMMAND( "CopyTextureFromBuffer", instance.CopyTextureFromBuffer(dstTextureDbg.instance, dstRegion, srcBufferDbg.instance, srcOffset, rowStride, layerStride) );
 
     profile_.textureCopies++;
@@ -320,6 +465,7 @@ void DbgCommandBuffer::CopyTextureFromFramebuffer(
             ValidateRenderTargetRange(*renderTargetDbg, srcOffset, Extent2D{ dstRegion.extent.width, dstRegion.extent.height });
     }
 
+    LLGL_DBG_CAPTURE( CmdCopyTextureFromFramebuffer, capture_->GetID(&dstTextureDbg), dstRegion, srcOffset );
     LLGL_DBG_COMMAND( "CopyTextureFromFramebuffer", instance.CopyTextureFromFramebuffer(dstTextureDbg.instance, dstRegion, srcOffset) );
 
     profile_.textureCopies++;
@@ -336,6 +482,7 @@ void DbgCommandBuffer::GenerateMips(Texture& texture)
         ValidateGenerateMips(textureDbg);
     }
 
+    LLGL_DBG_CAPTURE( CmdGenerateMips, capture_->GetID(&textureDbg) );
     LLGL_DBG_COMMAND( "GenerateMips", instance.GenerateMips(textureDbg.instance) );
 
     profile_.mipMapsGenerations++;
@@ -352,11 +499,33 @@ void DbgCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource&
         ValidateGenerateMips(textureDbg, &subresource);
     }
 
+    LLGL_DBG_CAPTURE( CmdGenerateMipsRange, capture_->GetID(&textureDbg), subresource );
     LLGL_DBG_COMMAND( "GenerateMips", instance.GenerateMips(textureDbg.instance, subresource) );
 
     profile_.mipMapsGenerations++;
 }
 
+void DbgCommandBuffer::CompressTexture(Texture& dstTexture, Texture& srcTexture, const TextureSubresource& subresource)
+{
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+    auto& srcTextureDbg = LLGL_CAST(DbgTexture&, srcTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        AssertTextureCompressionSupported();
+        if (states_.insideRenderPass)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot compress texture inside a render pass");
+        ValidateBindTextureFlags(dstTextureDbg, BindFlags::Storage);
+        ValidateBindTextureFlags(srcTextureDbg, BindFlags::Sampled);
+        ValidateCompressTexture(dstTextureDbg, srcTextureDbg, subresource);
+    }
+
+    LLGL_DBG_CAPTURE( CmdCompressTexture, capture_->GetID(&dstTextureDbg), capture_->GetID(&srcTextureDbg), subresource );
+    LLGL_DBG_COMMAND( "CompressTexture", instance.CompressTexture(dstTextureDbg.instance, srcTextureDbg.instance, subresource) );
+}
+
 /* ----- Viewport and Scissor ----- */
 
 void DbgCommandBuffer::SetViewport(const Viewport& viewport)
@@ -371,6 +540,7 @@ void DbgCommandBuffer::SetViewport(const Viewport& viewport)
         bindings_.numViewports = 1;
     }
 
+    LLGL_DBG_CAPTURE( CmdSetViewport, viewport );
     LLGL_DBG_COMMAND( "SetViewport", instance.SetViewport(viewport) );
 }
 
@@ -406,6 +576,7 @@ void DbgCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport*
         bindings_.numViewports = numViewports;
     }
 
+    LLGL_DBG_CAPTURE( CmdSetViewports, DbgCaptureStream::Array(viewports, numViewports) );
     LLGL_DBG_COMMAND( "SetViewports", instance.SetViewports(numViewports, viewports) );
 }
 
@@ -413,6 +584,7 @@ void DbgCommandBuffer::SetScissor(const Scissor& scissor)
 {
     LLGL_DBG_SOURCE;
     AssertRecording();
+    LLGL_DBG_CAPTURE( CmdSetScissor, scissor );
     LLGL_DBG_COMMAND( "SetScissor", instance.SetScissor(scissor) );
 }
 
@@ -427,6 +599,7 @@ void DbgCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* sci
             LLGL_DBG_WARN(WarningType::PointlessOperation, "no scissor rectangles are specified");
     }
 
+    LLGL_DBG_CAPTURE( CmdSetScissors, DbgCaptureStream::Array(scissors, numScissors) );
     LLGL_DBG_COMMAND( "SetScissors", instance.SetScissors(numScissors, scissors) );
 }
 
@@ -445,8 +618,10 @@ void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer)
         bindings_.vertexBufferStore[0]  = (&bufferDbg);
         bindings_.vertexBuffers         = bindings_.vertexBufferStore;
         bindings_.numVertexBuffers      = 1;
+        bindings_.vertexLayoutValidated = false;
     }
 
+    LLGL_DBG_CAPTURE( CmdSetVertexBuffer, capture_->GetID(&bufferDbg) );
     LLGL_DBG_COMMAND( "SetVertexBuffer", instance.SetVertexBuffer(bufferDbg.instance) );
 
     profile_.vertexBufferBindings++;
@@ -463,9 +638,11 @@ void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         ValidateBindFlags(bufferArrayDbg.GetBindFlags(), BindFlags::VertexBuffer, BindFlags::VertexBuffer, "LLGL::BufferArray");
 
         bindings_.vertexBuffers     = bufferArrayDbg.buffers.data();
-        bindings_.numVertexBuffers  = static_cast<std::uint32_t>(bufferArrayDbg.buffers.size());
+        bindings_.numVertexBuffers      = static_cast<std::uint32_t>(bufferArrayDbg.buffers.size());
+        bindings_.vertexLayoutValidated = false;
     }
 
+    LLGL_DBG_CAPTURE( CmdSetVertexBufferArray, capture_->GetID(&bufferArrayDbg) );
     LLGL_DBG_COMMAND( "SetVertexBufferArray", instance.SetVertexBufferArray(bufferArrayDbg.instance) );
 
     profile_.vertexBufferBindings++;
@@ -488,6 +665,7 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
         bindings_.indexBufferOffset     = 0;
     }
 
+    LLGL_DBG_CAPTURE( CmdSetIndexBuffer, capture_->GetID(&bufferDbg) );
     LLGL_DBG_COMMAND( "SetIndexBuffer", instance.SetIndexBuffer(bufferDbg.instance) );
 
     profile_.indexBufferBindings++;
@@ -520,6 +698,7 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::
         }
     }
 
+    LLGL_DBG_CAPTURE( CmdSetIndexBufferFormat, capture_->GetID(&bufferDbg), format, offset );
     LLGL_DBG_COMMAND( "SetIndexBuffer", instance.SetIndexBuffer(bufferDbg.instance, format, offset) );
 
     profile_.indexBufferBindings++;
@@ -538,8 +717,10 @@ void DbgCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t
         AssertRecording();
         ValidateDescriptorSetIndex(descriptorSet, resourceHeapDbg.GetNumDescriptorSets(), resourceHeapDbg.label.c_str());
         bindings_.bindingTable.resourceHeap = &resourceHeap;
+        bindings_.bindingTableValidated     = false;
     }
 
+    LLGL_DBG_CAPTURE( CmdSetResourceHeap, capture_->GetID(&resourceHeapDbg), descriptorSet );
     LLGL_DBG_COMMAND( "SetResourceHeap", instance.SetResourceHeap(resourceHeapDbg.instance, descriptorSet) );
 
     profile_.resourceHeapBindings++;
@@ -563,9 +744,16 @@ void DbgCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
             LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot bind resource without pipeline state");
 
         if (descriptor < bindings_.bindingTable.resources.size())
+        {
+            if (lintEnabled_ && bindings_.bindingTable.resources[descriptor] == &resource)
+                LLGL_DBG_LINT(PerformanceLint::RedundantResource, "resource is already bound to descriptor " + std::to_string(descriptor));
             bindings_.bindingTable.resources[descriptor] = &resource;
+            bindings_.bindingTableValidated = false;
+        }
     }
 
+    LLGL_DBG_CAPTURE( CmdSetResource, descriptor, capture_->GetID(&resource) );
+
     switch (resource.GetResourceType())
     {
         case ResourceType::Undefined:
@@ -584,6 +772,8 @@ void DbgCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
                     (BindFlags::ConstantBuffer | BindFlags::Sampled | BindFlags::Storage),
                     GetLabelOrDefault(bufferDbg.label, "LLGL::Buffer")
                 );
+                if ((bindingDesc->bindFlags & BindFlags::Storage) != 0)
+                    RecordBufferWrite(bufferDbg);
             }
 
             LLGL_DBG_COMMAND( "SetResource", instance.SetResource(descriptor, bufferDbg.instance) );
@@ -643,6 +833,85 @@ void DbgCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
             profile_.samplerBindings++;
         }
         break;
+
+        case ResourceType::AccelerationStructure:
+        {
+            /* Forward acceleration structure resource to wrapped instance */
+            auto& accelStructDbg = LLGL_CAST(DbgAccelerationStructure&, resource);
+
+            if (debugger_)
+            {
+                LLGL_DBG_SOURCE;
+                if (accelStructDbg.GetType() != AccelerationStructureType::TopLevel)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "only top-level acceleration structures can be bound to shaders");
+                else if (!accelStructDbg.built)
+                    LLGL_DBG_ERROR(ErrorType::InvalidState, "binding acceleration structure that has not been built");
+            }
+
+            LLGL_DBG_COMMAND( "SetResource", instance.SetResource(descriptor, accelStructDbg.instance) );
+        }
+        break;
+    }
+}
+
+void DbgCommandBuffer::SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t size)
+{
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+    const BindingDescriptor* bindingDesc = nullptr;
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+
+        if (auto* pso = bindings_.pipelineState)
+        {
+            if (auto* psoLayout = pso->pipelineLayout)
+                bindingDesc = GetAndValidateResourceDescFromPipeline(*psoLayout, descriptor, buffer);
+        }
+        else
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot bind resource without pipeline state");
+
+        if (bindingDesc != nullptr)
+        {
+            ValidateBindFlags(
+                bufferDbg.desc.bindFlags,
+                bindingDesc->bindFlags,
+                (BindFlags::ConstantBuffer | BindFlags::Storage),
+                GetLabelOrDefault(bufferDbg.label, "LLGL::Buffer")
+            );
+
+            /* Validate offset alignment for the respective binding */
+            if ((bindingDesc->bindFlags & BindFlags::ConstantBuffer) != 0)
+                ValidateAddressAlignment(offset, limits_.minConstantBufferAlignment, "constant buffer offset");
+            else if ((bindingDesc->bindFlags & BindFlags::Storage) != 0)
+                ValidateAddressAlignment(offset, limits_.minStorageBufferAlignment, "storage buffer offset");
+            else
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer ranges can only be bound to constant buffer and storage buffer bindings");
+
+            if ((bindingDesc->bindFlags & BindFlags::Storage) != 0)
+                RecordBufferWrite(bufferDbg);
+        }
+
+        ValidateBufferRange(bufferDbg, offset, GetBufferRangeSize(bufferDbg.desc.size, offset, size), "buffer range");
+
+        if (descriptor < bindings_.bindingTable.resources.size())
+        {
+            bindings_.bindingTable.resources[descriptor] = &buffer;
+            bindings_.bindingTableValidated = false;
+        }
+    }
+
+    LLGL_DBG_CAPTURE( CmdSetResourceRange, descriptor, capture_->GetID(&bufferDbg), offset, size );
+    LLGL_DBG_COMMAND( "SetResource", instance.SetResource(descriptor, bufferDbg.instance, offset, size) );
+
+    /* Record binding for profiling */
+    if (bindingDesc != nullptr)
+    {
+        if ((bindingDesc->bindFlags & BindFlags::ConstantBuffer) != 0)
+            profile_.constantBufferBindings++;
+        if ((bindingDesc->bindFlags & BindFlags::Storage) != 0)
+            profile_.storageBufferBindings++;
     }
 }
 
@@ -661,6 +930,7 @@ void DbgCommandBuffer::ResetResourceSlots(
         ValidateStageFlags(stageFlags, StageFlags::AllStages);
     }
 
+    LLGL_DBG_CAPTURE( CmdResetResourceSlots, resourceType, firstSlot, numSlots, bindFlags, stageFlags );
     LLGL_DBG_COMMAND( "ResetResourceSlots", instance.ResetResourceSlots(resourceType, firstSlot, numSlots, bindFlags, stageFlags) );
 }
 
@@ -681,8 +951,19 @@ void DbgCommandBuffer::BeginRenderPass(
         if (states_.insideRenderPass)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot begin new render pass while previous render pass is still active");
         states_.insideRenderPass = true;
+
+        if (lintEnabled_)
+            LintRenderPassClears(renderPass);
     }
 
+    LLGL_DBG_CAPTURE(
+        CmdBeginRenderPass,
+        capture_->GetID(&renderTarget),
+        capture_->GetID(LLGL_CAST(const DbgRenderPass*, renderPass)),
+        DbgCaptureStream::Array(clearValues, (clearValues != nullptr ? numClearValues : 0)),
+        swapBufferIndex
+    );
+
     renderPass = DbgGetInstance<DbgRenderPass>(renderPass);
 
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
@@ -724,8 +1005,10 @@ void DbgCommandBuffer::EndRenderPass()
         if (!states_.insideRenderPass)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot end render pass while no render pass is currently active");
         states_.insideRenderPass = false;
+        lints_ = Lints{};
     }
 
+    LLGL_DBG_CAPTURE( CmdEndRenderPass );
     instance.EndRenderPass();
 }
 
@@ -736,8 +1019,11 @@ void DbgCommandBuffer::Clear(long flags, const ClearValue& clearValue)
         LLGL_DBG_SOURCE;
         AssertRecording();
         AssertInsideRenderPass();
+        if (lintEnabled_)
+            LintRedundantClear(flags);
     }
 
+    LLGL_DBG_CAPTURE( CmdClear, flags, clearValue );
     LLGL_DBG_COMMAND( "Clear", instance.Clear(flags, clearValue) );
 
     profile_.attachmentClears++;
@@ -752,8 +1038,16 @@ void DbgCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Atta
         AssertInsideRenderPass();
         for_range(i, numAttachments)
             ValidateAttachmentClear(attachments[i]);
+        if (lintEnabled_ && attachments != nullptr)
+        {
+            long clearFlags = 0;
+            for_range(i, numAttachments)
+                clearFlags |= attachments[i].flags;
+            LintRedundantClear(clearFlags);
+        }
     }
 
+    LLGL_DBG_CAPTURE( CmdClearAttachments, DbgCaptureStream::Array(attachments, numAttachments) );
     LLGL_DBG_COMMAND( "ClearAttachments", instance.ClearAttachments(numAttachments, attachments) );
 
     profile_.attachmentClears++;
@@ -770,9 +1064,17 @@ void DbgCommandBuffer::SetPipelineState(PipelineState& pipelineState)
         LLGL_DBG_SOURCE;
         AssertRecording();
 
+        if (lintEnabled_)
+        {
+            if (lints_.pipelineState == &pipelineStateDbg)
+                LLGL_DBG_LINT(PerformanceLint::RedundantPipelineState, "PSO is already bound in the current render pass");
+            lints_.pipelineState = &pipelineStateDbg;
+        }
+
         /* Bind graphics pipeline and unbind compute pipeline */
         bindings_.pipelineState         = (&pipelineStateDbg);
         bindings_.anyShaderAttributes   = false;
+        bindings_.vertexLayoutValidated = false;
 
         if (pipelineStateDbg.isGraphicsPSO)
         {
@@ -813,6 +1115,7 @@ void DbgCommandBuffer::SetPipelineState(PipelineState& pipelineState)
         topology_ = pipelineStateDbg.graphicsDesc.primitiveTopology;
 
     /* Call wrapped function */
+    LLGL_DBG_CAPTURE( CmdSetPipelineState, capture_->GetID(&pipelineStateDbg) );
     LLGL_DBG_COMMAND( "SetPipelineState", instance.SetPipelineState(pipelineStateDbg.instance) );
 
     if (pipelineStateDbg.isGraphicsPSO)
@@ -835,6 +1138,7 @@ void DbgCommandBuffer::SetBlendFactor(const float color[4])
         }
     }
 
+    LLGL_DBG_CAPTURE( CmdSetBlendFactor, DbgCaptureStream::Array(color, 4) );
     LLGL_DBG_COMMAND( "SetBlendFactor", instance.SetBlendFactor(color) );
 }
 
@@ -852,6 +1156,7 @@ void DbgCommandBuffer::SetStencilReference(std::uint32_t reference, const Stenci
         }
     }
 
+    LLGL_DBG_CAPTURE( CmdSetStencilReference, reference, stencilFace );
     LLGL_DBG_COMMAND( "SetStencilReference", instance.SetStencilReference(reference, stencilFace) );
 }
 
@@ -871,6 +1176,7 @@ void DbgCommandBuffer::SetUniforms(std::uint32_t first, const void* data, std::u
             LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot set uniforms without pipeline state");
     }
 
+    LLGL_DBG_CAPTURE( CmdSetUniforms, first, DbgCaptureStream::Array(static_cast<const char*>(data), dataSize) );
     LLGL_DBG_COMMAND( "SetUniforms", instance.SetUniforms(first, data, dataSize) );
 }
 
@@ -884,7 +1190,9 @@ void DbgCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        if (auto state = GetAndValidateQueryState(queryHeapDbg, query))
+        if (queryHeapDbg.GetType() == QueryType::Timestamp)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot begin query of type LLGL::QueryType::Timestamp; timestamps are only written with EndQuery()");
+        else if (auto state = GetAndValidateQueryState(queryHeapDbg, query))
         {
             if (*state == DbgQueryHeap::State::Busy)
                 LLGL_DBG_ERROR(ErrorType::InvalidState, "query is already busy");
@@ -892,6 +1200,7 @@ void DbgCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
         }
     }
 
+    LLGL_DBG_CAPTURE( CmdBeginQuery, capture_->GetID(&queryHeapDbg), query );
     instance.BeginQuery(queryHeapDbg.instance, query);
 
     profile_.querySections++;
@@ -907,12 +1216,13 @@ void DbgCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
         AssertRecording();
         if (auto state = GetAndValidateQueryState(queryHeapDbg, query))
         {
-            if (*state != DbgQueryHeap::State::Busy)
+            if (*state != DbgQueryHeap::State::Busy && queryHeapDbg.GetType() != QueryType::Timestamp)
                 LLGL_DBG_ERROR(ErrorType::InvalidState, "query has not started");
             *state = DbgQueryHeap::State::Ready;
         }
     }
 
+    LLGL_DBG_CAPTURE( CmdEndQuery, capture_->GetID(&queryHeapDbg), query );
     instance.EndQuery(queryHeapDbg.instance, query);
 }
 
@@ -927,6 +1237,7 @@ void DbgCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t
         ValidateRenderCondition(queryHeapDbg, query);
     }
 
+    LLGL_DBG_CAPTURE( CmdBeginRenderCondition, capture_->GetID(&queryHeapDbg), query, mode );
     instance.BeginRenderCondition(queryHeapDbg.instance, query, mode);
 
     profile_.renderConditionSections++;
@@ -939,6 +1250,7 @@ void DbgCommandBuffer::EndRenderCondition()
         LLGL_DBG_SOURCE;
         AssertRecording();
     }
+    LLGL_DBG_CAPTURE( CmdEndRenderCondition );
     instance.EndRenderCondition();
 }
 
@@ -964,6 +1276,7 @@ void DbgCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const
             if (bufferDbg != nullptr)
             {
                 ValidateBindBufferFlags(*bufferDbg, BindFlags::StreamOutputBuffer);
+                RecordBufferWrite(*bufferDbg);
                 bindings_.streamOutputs[i] = bufferDbg;
                 bufferInstances[i] = &(bufferDbg->instance);
             }
@@ -998,6 +1311,14 @@ void DbgCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const
         }
     }
 
+    if (capturing_ && !validationFailed)
+    {
+        Capture::ObjectID bufferIDs[LLGL_MAX_NUM_SO_BUFFERS];
+        for_range(i, numBuffers)
+            bufferIDs[i] = capture_->GetID(LLGL_CAST(const DbgBuffer*, buffers[i]));
+        captureStream_.Record(Capture::CmdBeginStreamOutput, DbgCaptureStream::Array(bufferIDs, numBuffers));
+    }
+
     if (!validationFailed)
         instance.BeginStreamOutput(numBuffers, bufferInstances);
 
@@ -1019,6 +1340,7 @@ void DbgCommandBuffer::EndStreamOutput()
         bindings_.numStreamOutputs = 0;
     }
 
+    LLGL_DBG_CAPTURE( CmdEndStreamOutput );
     instance.EndStreamOutput();
 }
 
@@ -1032,6 +1354,7 @@ void DbgCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex
         ValidateDrawCmd(numVertices, firstVertex, 1, 0);
     }
 
+    LLGL_DBG_CAPTURE( CmdDraw, numVertices, firstVertex );
     LLGL_DBG_COMMAND( "Draw", instance.Draw(numVertices, firstVertex) );
 
     profile_.drawCommands++;
@@ -1045,6 +1368,7 @@ void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t first
         ValidateDrawIndexedCmd(numIndices, 1, firstIndex, 0, 0);
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndexed, numIndices, firstIndex );
     LLGL_DBG_COMMAND( "DrawIndexed", instance.DrawIndexed(numIndices, firstIndex) );
 
     profile_.drawCommands++;
@@ -1058,6 +1382,7 @@ void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t first
         ValidateDrawIndexedCmd(numIndices, 1, firstIndex, vertexOffset, 0);
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndexedOffset, numIndices, firstIndex, vertexOffset );
     LLGL_DBG_COMMAND( "DrawIndexed", instance.DrawIndexed(numIndices, firstIndex, vertexOffset) );
 
     profile_.drawCommands++;
@@ -1072,6 +1397,7 @@ void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fi
         ValidateDrawCmd(numVertices, firstVertex, numInstances, 0);
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawInstanced, numVertices, firstVertex, numInstances );
     LLGL_DBG_COMMAND( "DrawInstanced", instance.DrawInstanced(numVertices, firstVertex, numInstances) );
 
     profile_.drawCommands++;
@@ -1087,6 +1413,7 @@ void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fi
         ValidateDrawCmd(numVertices, firstVertex, numInstances, firstInstance);
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawInstancedFirst, numVertices, firstVertex, numInstances, firstInstance );
     LLGL_DBG_COMMAND( "DrawInstanced", instance.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance) );
 
     profile_.drawCommands++;
@@ -1101,6 +1428,7 @@ void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint3
         ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, 0, 0);
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndexedInstanced, numIndices, numInstances, firstIndex );
     LLGL_DBG_COMMAND( "DrawIndexedInstanced", instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex) );
 
     profile_.drawCommands++;
@@ -1115,6 +1443,7 @@ void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint3
         ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, vertexOffset, 0);
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndexedInstancedOffset, numIndices, numInstances, firstIndex, vertexOffset );
     LLGL_DBG_COMMAND( "DrawIndexedInstanced", instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset) );
 
     profile_.drawCommands++;
@@ -1130,6 +1459,7 @@ void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint3
         ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndexedInstancedFirst, numIndices, numInstances, firstIndex, vertexOffset, firstInstance );
     LLGL_DBG_COMMAND( "DrawIndexedInstanced", instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance) );
 
     profile_.drawCommands++;
@@ -1148,6 +1478,7 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndirect, capture_->GetID(&bufferDbg), offset );
     LLGL_DBG_COMMAND( "DrawIndirect", instance.DrawIndirect(bufferDbg.instance, offset) );
 
     profile_.drawCommands++;
@@ -1167,6 +1498,7 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::u
         ValidateAddressAlignment(stride, 4, "<stride> parameter");
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndirectMulti, capture_->GetID(&bufferDbg), offset, numCommands, stride );
     LLGL_DBG_COMMAND( "DrawIndirect", instance.DrawIndirect(bufferDbg.instance, offset, numCommands, stride) );
 
     profile_.drawCommands += numCommands;
@@ -1185,6 +1517,7 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndexedIndirect, capture_->GetID(&bufferDbg), offset );
     LLGL_DBG_COMMAND( "DrawIndexedIndirect", instance.DrawIndexedIndirect(bufferDbg.instance, offset) );
 
     profile_.drawCommands++;
@@ -1204,11 +1537,130 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
         ValidateAddressAlignment(stride, 4, "<stride> parameter");
     }
 
+    LLGL_DBG_CAPTURE( CmdDrawIndexedIndirectMulti, capture_->GetID(&bufferDbg), offset, numCommands, stride );
     LLGL_DBG_COMMAND( "DrawIndexedIndirect", instance.DrawIndexedIndirect(bufferDbg.instance, offset, numCommands, stride) );
 
     profile_.drawCommands += numCommands;
 }
 
+void DbgCommandBuffer::DrawIndirectCount(
+    Buffer&         argsBuffer,
+    std::uint64_t   argsOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    std::uint32_t   maxNumCommands,
+    std::uint32_t   stride)
+{
+    auto& argsBufferDbg     = LLGL_CAST(DbgBuffer&, argsBuffer);
+    auto& countBufferDbg    = LLGL_CAST(DbgBuffer&, countBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertIndirectCountDrawingSupported();
+        ValidateBindBufferFlags(argsBufferDbg, BindFlags::IndirectBuffer);
+        ValidateBufferRange(argsBufferDbg, argsOffset, stride*maxNumCommands);
+        ValidateAddressAlignment(argsOffset, 4, "<argsOffset> parameter");
+        ValidateAddressAlignment(stride, 4, "<stride> parameter");
+        if (stride < sizeof(DrawIndirectArguments))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "<stride> parameter must be greater than or equal to sizeof(DrawIndirectArguments)");
+        ValidateBindBufferFlags(countBufferDbg, BindFlags::IndirectBuffer);
+        ValidateBufferRange(countBufferDbg, countOffset, sizeof(std::uint32_t));
+        ValidateAddressAlignment(countOffset, 4, "<countOffset> parameter");
+    }
+
+    LLGL_DBG_CAPTURE( CmdDrawIndirectCount, capture_->GetID(&argsBufferDbg), argsOffset, capture_->GetID(&countBufferDbg), countOffset, maxNumCommands, stride );
+    LLGL_DBG_COMMAND( "DrawIndirectCount", instance.DrawIndirectCount(argsBufferDbg.instance, argsOffset, countBufferDbg.instance, countOffset, maxNumCommands, stride) );
+
+    profile_.drawCommands++;
+}
+
+void DbgCommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         argsBuffer,
+    std::uint64_t   argsOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    std::uint32_t   maxNumCommands,
+    std::uint32_t   stride)
+{
+    auto& argsBufferDbg     = LLGL_CAST(DbgBuffer&, argsBuffer);
+    auto& countBufferDbg    = LLGL_CAST(DbgBuffer&, countBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertIndirectCountDrawingSupported();
+        ValidateBindBufferFlags(argsBufferDbg, BindFlags::IndirectBuffer);
+        ValidateBufferRange(argsBufferDbg, argsOffset, stride*maxNumCommands);
+        ValidateAddressAlignment(argsOffset, 4, "<argsOffset> parameter");
+        ValidateAddressAlignment(stride, 4, "<stride> parameter");
+        if (stride < sizeof(DrawIndexedIndirectArguments))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "<stride> parameter must be greater than or equal to sizeof(DrawIndexedIndirectArguments)");
+        ValidateBindBufferFlags(countBufferDbg, BindFlags::IndirectBuffer);
+        ValidateBufferRange(countBufferDbg, countOffset, sizeof(std::uint32_t));
+        ValidateAddressAlignment(countOffset, 4, "<countOffset> parameter");
+    }
+
+    LLGL_DBG_CAPTURE( CmdDrawIndexedIndirectCount, capture_->GetID(&argsBufferDbg), argsOffset, capture_->GetID(&countBufferDbg), countOffset, maxNumCommands, stride );
+    LLGL_DBG_COMMAND( "DrawIndexedIndirectCount", instance.DrawIndexedIndirectCount(argsBufferDbg.instance, argsOffset, countBufferDbg.instance, countOffset, maxNumCommands, stride) );
+
+    profile_.drawCommands++;
+}
+
+void DbgCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+
+        if (numWorkGroupsX * numWorkGroupsY * numWorkGroupsZ == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "thread group size has volume of 0 units");
+
+        ValidateDrawMeshTasksCmd();
+    }
+
+    LLGL_DBG_CAPTURE( CmdDrawMeshTasks, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ );
+    LLGL_DBG_COMMAND( "DrawMeshTasks", instance.DrawMeshTasks(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ) );
+
+    profile_.drawCommands++;
+}
+
+void DbgCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDrawMeshTasksCmd();
+        ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        ValidateBufferRange(bufferDbg, offset, stride*numCommands);
+        ValidateAddressAlignment(offset, 4, "<offset> parameter");
+        ValidateAddressAlignment(stride, 4, "<stride> parameter");
+        if (numCommands > 1 && stride < sizeof(DrawMeshTasksIndirectArguments))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "<stride> parameter must be greater than or equal to sizeof(DrawMeshTasksIndirectArguments)");
+    }
+
+    LLGL_DBG_CAPTURE( CmdDrawMeshTasksIndirect, capture_->GetID(&bufferDbg), offset, numCommands, stride );
+    LLGL_DBG_COMMAND( "DrawMeshTasksIndirect", instance.DrawMeshTasksIndirect(bufferDbg.instance, offset, numCommands, stride) );
+
+    profile_.drawCommands += numCommands;
+}
+
+void DbgCommandBuffer::DrawStreamOutput()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDrawStreamOutputCmd();
+    }
+
+    LLGL_DBG_CAPTURE( CmdDrawStreamOutput );
+    LLGL_DBG_COMMAND( "DrawStreamOutput", instance.DrawStreamOutput() );
+
+    profile_.drawCommands++;
+}
+
 /* ----- Compute ----- */
 
 void DbgCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
@@ -1227,6 +1679,7 @@ void DbgCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numW
         ValidateBindingTable();
     }
 
+    LLGL_DBG_CAPTURE( CmdDispatch, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ );
     LLGL_DBG_COMMAND( "Dispatch", instance.Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ) );
 
     profile_.dispatchCommands++;
@@ -1245,11 +1698,134 @@ void DbgCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
         ValidateBindingTable();
     }
 
+    LLGL_DBG_CAPTURE( CmdDispatchIndirect, capture_->GetID(&bufferDbg), offset );
     LLGL_DBG_COMMAND( "DispatchIndirect", instance.DispatchIndirect(bufferDbg.instance, offset) );
 
     profile_.dispatchCommands++;
 }
 
+void DbgCommandBuffer::CompactIndirectArguments(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    Buffer&         srcBuffer,
+    std::uint64_t   srcOffset,
+    Buffer&         visibilityBuffer,
+    std::uint64_t   visibilityOffset,
+    std::uint32_t   numCommands,
+    std::uint32_t   stride)
+{
+    auto& dstBufferDbg          = LLGL_CAST(DbgBuffer&, dstBuffer);
+    auto& countBufferDbg        = LLGL_CAST(DbgBuffer&, countBuffer);
+    auto& srcBufferDbg          = LLGL_CAST(DbgBuffer&, srcBuffer);
+    auto& visibilityBufferDbg   = LLGL_CAST(DbgBuffer&, visibilityBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        AssertIndirectArgumentCompactionSupported();
+        if (states_.insideRenderPass)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot compact indirect arguments inside a render pass");
+        ValidateCompactIndirectArguments(
+            dstBufferDbg, dstOffset,
+            countBufferDbg, countOffset,
+            srcBufferDbg, srcOffset,
+            visibilityBufferDbg, visibilityOffset,
+            numCommands, stride
+        );
+        RecordBufferWrite(dstBufferDbg);
+        RecordBufferWrite(countBufferDbg);
+    }
+
+    LLGL_DBG_CAPTURE(
+        CmdCompactIndirectArguments,
+        capture_->GetID(&dstBufferDbg), dstOffset,
+        capture_->GetID(&countBufferDbg), countOffset,
+        capture_->GetID(&srcBufferDbg), srcOffset,
+        capture_->GetID(&visibilityBufferDbg), visibilityOffset,
+        numCommands, stride
+    );
+    LLGL_DBG_COMMAND(
+        "CompactIndirectArguments",
+        instance.CompactIndirectArguments(
+            dstBufferDbg.instance, dstOffset,
+            countBufferDbg.instance, countOffset,
+            srcBufferDbg.instance, srcOffset,
+            visibilityBufferDbg.instance, visibilityOffset,
+            numCommands, stride
+        )
+    );
+
+    profile_.dispatchCommands++;
+}
+
+/* ----- Ray Tracing ----- */
+
+void DbgCommandBuffer::BuildAccelerationStructure(AccelerationStructure& accelerationStructure, const AccelerationStructureBuildDescriptor& buildDesc)
+{
+    auto& accelStructDbg = LLGL_CAST(DbgAccelerationStructure&, accelerationStructure);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        if (states_.insideRenderPass)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot build acceleration structure inside a render pass");
+        ValidateAccelerationStructureBuild(accelStructDbg, buildDesc);
+    }
+
+    /* Replace debug objects of the geometries and instances by their instances */
+    const std::vector<AccelerationStructureGeometryDescriptor> instanceGeometries = DbgGetGeometryInstanceCopy(buildDesc.geometries);
+    std::vector<AccelerationStructureInstance> instanceInstances(buildDesc.instances.begin(), buildDesc.instances.end());
+    for (AccelerationStructureInstance& instanceEntry : instanceInstances)
+        instanceEntry.accelerationStructure = DbgGetInstance<DbgAccelerationStructure>(instanceEntry.accelerationStructure);
+
+    AccelerationStructureBuildDescriptor instanceBuildDesc;
+    {
+        instanceBuildDesc.update        = buildDesc.update;
+        instanceBuildDesc.geometries    = instanceGeometries;
+        instanceBuildDesc.instances     = instanceInstances;
+    }
+    LLGL_DBG_COMMAND( "BuildAccelerationStructure", instance.BuildAccelerationStructure(accelStructDbg.instance, instanceBuildDesc) );
+
+    accelStructDbg.built                = true;
+    accelStructDbg.numBuiltInstances    = static_cast<std::uint32_t>(buildDesc.instances.size());
+}
+
+void DbgCommandBuffer::CopyAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure, bool compact)
+{
+    auto& dstAccelStructDbg = LLGL_CAST(DbgAccelerationStructure&, dstAccelerationStructure);
+    auto& srcAccelStructDbg = LLGL_CAST(DbgAccelerationStructure&, srcAccelerationStructure);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        if (states_.insideRenderPass)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot copy acceleration structure inside a render pass");
+        if (&dstAccelStructDbg == &srcAccelStructDbg)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "source and destination of acceleration structure copy must not be the same");
+        if (dstAccelStructDbg.GetType() != srcAccelStructDbg.GetType())
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy between top-level and bottom-level acceleration structures");
+        if (!srcAccelStructDbg.built)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "copying acceleration structure that has not been built");
+        if (compact)
+        {
+            if ((srcAccelStructDbg.flags & AccelerationStructureFlags::AllowCompaction) == 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot compact acceleration structure that was not created with 'LLGL::AccelerationStructureFlags::AllowCompaction'");
+            if (dstAccelStructDbg.compactedSize == 0)
+                LLGL_DBG_WARN(WarningType::ImproperArgument, "destination of acceleration structure compaction was not created with a compacted size");
+        }
+    }
+
+    LLGL_DBG_COMMAND( "CopyAccelerationStructure", instance.CopyAccelerationStructure(dstAccelStructDbg.instance, srcAccelStructDbg.instance, compact) );
+
+    dstAccelStructDbg.built             = srcAccelStructDbg.built;
+    dstAccelStructDbg.numBuiltInstances = srcAccelStructDbg.numBuiltInstances;
+}
+
 /* ----- Debugging ----- */
 
 void DbgCommandBuffer::PushDebugGroup(const char* name)
@@ -1265,13 +1841,23 @@ void DbgCommandBuffer::PushDebugGroup(const char* name)
         name = "<null pointer>";
 
     debugGroups_.push(name);
+    validationGroupDirty_ = true;
+    LLGL_DBG_CAPTURE( CmdPushDebugGroup, name );
     instance.PushDebugGroup(name);
+
+    if (scopeProfilerEnabled_)
+        scopeProfiler_.PushScope(name);
 }
 
 void DbgCommandBuffer::PopDebugGroup()
 {
+    if (scopeProfilerEnabled_)
+        scopeProfiler_.PopScope();
+
+    LLGL_DBG_CAPTURE( CmdPopDebugGroup );
     instance.PopDebugGroup();
     debugGroups_.pop();
+    validationGroupDirty_ = true;
 
     if (debugger_)
     {
@@ -1300,11 +1886,20 @@ void DbgCommandBuffer::NextProfile(FrameProfile& outputProfile)
 {
     /* Copy frame profile values to output profile */
     ::memcpy(outputProfile.values, profile_.values, sizeof(profile_.values));
-    outputProfile.timeRecords = std::move(profile_.timeRecords);
+    timerMngr_.TakeRecords(outputProfile.timeRecords);
+    scopeProfiler_.TakeRecords(outputProfile.scopeRecords);
 }
 
-void DbgCommandBuffer::ValidateSubmit()
+void DbgCommandBuffer::ValidateSubmit(const CommandQueue& commandQueueInstance)
 {
+    if (&commandQueueInstance != &commandQueueInstance_)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "command buffer submitted to a command queue that does not match CommandBufferDescriptor::queueType"
+        );
+    }
+
     for (const SwapChainFramePair& pair : records_.swapChainFrames)
     {
         if (pair.swapChain->GetCurrentSwapIndex() != pair.frame)
@@ -1321,6 +1916,7 @@ void DbgCommandBuffer::ValidateSubmit()
 }
 
 #undef LLGL_DBG_COMMAND
+#undef LLGL_DBG_CAPTURE
 
 
 /*
@@ -1405,14 +2001,100 @@ void DbgCommandBuffer::ValidateGenerateMips(DbgTexture& textureDbg, const Textur
     }
 }
 
-void DbgCommandBuffer::ValidateViewport(const Viewport& viewport)
+// Returns true if the specified format can be written by CommandBuffer::CompressTexture.
+static bool IsTextureCompressionFormat(const Format format)
 {
-    if (viewport.width < 0.0f || viewport.height < 0.0f)
-        LLGL_DBG_ERROR(ErrorType::UndefinedBehavior, "viewport of negative width or negative height");
-    if (viewport.width == 0.0f || viewport.height == 0.0f)
-        LLGL_DBG_WARN(WarningType::PointlessOperation, "viewport of empty size (width or height is zero)");
-
-    const auto w = static_cast<std::uint32_t>(viewport.width);
+    switch (format)
+    {
+        case Format::BC1UNorm:
+        case Format::BC1UNorm_sRGB:
+        case Format::BC3UNorm:
+        case Format::BC3UNorm_sRGB:
+        case Format::BC4UNorm:
+        case Format::BC5UNorm:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void DbgCommandBuffer::ValidateCompressTexture(DbgTexture& dstTextureDbg, DbgTexture& srcTextureDbg, const TextureSubresource& subresource)
+{
+    /* Validate texture types and formats */
+    for (DbgTexture* textureDbg : { &dstTextureDbg, &srcTextureDbg })
+    {
+        if (!(textureDbg->desc.type == TextureType::Texture2D || textureDbg->desc.type == TextureType::Texture2DArray))
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "cannot compress texture of type LLGL::TextureType::" + std::string(ToString(textureDbg->desc.type)) +
+                "; only Texture2D and Texture2DArray are supported"
+            );
+        }
+    }
+
+    if (!IsTextureCompressionFormat(dstTextureDbg.desc.format))
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "cannot compress texture into destination format LLGL::Format::" + std::string(ToString(dstTextureDbg.desc.format)) +
+            "; only BC1UNorm, BC1UNorm_sRGB, BC3UNorm, BC3UNorm_sRGB, BC4UNorm, and BC5UNorm are supported"
+        );
+    }
+
+    if (IsCompressedFormat(srcTextureDbg.desc.format) || !IsNormalizedFormat(srcTextureDbg.desc.format) || IsDepthOrStencilFormat(srcTextureDbg.desc.format))
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "cannot compress texture from source format LLGL::Format::" + std::string(ToString(srcTextureDbg.desc.format)) +
+            "; only uncompressed normalized color formats are supported"
+        );
+    }
+
+    if (dstTextureDbg.desc.extent != srcTextureDbg.desc.extent)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "cannot compress texture with source extent " +
+            std::to_string(srcTextureDbg.desc.extent.width) + "x" + std::to_string(srcTextureDbg.desc.extent.height) +
+            " being different from destination extent " +
+            std::to_string(dstTextureDbg.desc.extent.width) + "x" + std::to_string(dstTextureDbg.desc.extent.height)
+        );
+    }
+
+    /* Validate subresource range for both textures */
+    const std::uint32_t numMipLevels    = std::min(dstTextureDbg.mipLevels, srcTextureDbg.mipLevels);
+    const std::uint32_t numArrayLayers  = std::min(dstTextureDbg.desc.arrayLayers, srcTextureDbg.desc.arrayLayers);
+
+    if (subresource.numMipLevels == 0 || subresource.numArrayLayers == 0)
+    {
+        LLGL_DBG_WARN(
+            WarningType::PointlessOperation,
+            "compressing texture with a total number of 0 MIP-maps or array layers has no effect"
+        );
+    }
+    else if (subresource.baseMipLevel + subresource.numMipLevels > numMipLevels ||
+             subresource.baseArrayLayer + subresource.numArrayLayers > numArrayLayers)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "cannot compress texture with subresource being out of bounds: "
+            "MIP-map range is [0, " + std::to_string(numMipLevels) + ") and array layer range is [0, " + std::to_string(numArrayLayers) +
+            "), but [" + std::to_string(subresource.baseMipLevel) + ", " + std::to_string(subresource.baseMipLevel + subresource.numMipLevels) +
+            ") and [" + std::to_string(subresource.baseArrayLayer) + ", " + std::to_string(subresource.baseArrayLayer + subresource.numArrayLayers) +
+            ") were specified"
+        );
+    }
+}
+
+void DbgCommandBuffer::ValidateViewport(const Viewport& viewport)
+{
+    if (viewport.width < 0.0f || viewport.height < 0.0f)
+        LLGL_DBG_ERROR(ErrorType::UndefinedBehavior, "viewport of negative width or negative height");
+    if (viewport.width == 0.0f || viewport.height == 0.0f)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "viewport of empty size (width or height is zero)");
+
+    const auto w = static_cast<std::uint32_t>(viewport.width);
     const auto h = static_cast<std::uint32_t>(viewport.height);
 
     if ( ( viewport.width  > 0.0f && w > limits_.maxViewportSize[0] ) ||
@@ -1459,213 +2141,236 @@ void DbgCommandBuffer::ValidateAttachmentClear(const AttachmentClear& attachment
         LLGL_DBG_ERROR(ErrorType::InvalidState, "no render target is bound");
 }
 
-void DbgCommandBuffer::ValidateVertexLayout()
+void DbgCommandBuffer::ValidateDrawCmd(
+    std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
-    if (auto pso = bindings_.pipelineState)
+    AssertRecording();
+    AssertInsideRenderPass();
+    AssertGraphicsPipelineBound();
+    AssertVertexBufferBound();
+    AssertViewportBound();
+
+    DbgDrawRecord record = MakeDrawRecord(
+        DbgDrawValidation::DynamicStates    |
+        DbgDrawValidation::VertexLayout     |
+        DbgDrawValidation::Vertices         |
+        DbgDrawValidation::VertexID         |
+        DbgDrawValidation::InstanceID       |
+        DbgDrawValidation::BindingTable
+    );
     {
-        if (pso->isGraphicsPSO && bindings_.numVertexBuffers > 0)
-        {
-            if (auto vertexShader = pso->graphicsDesc.vertexShader)
-            {
-                auto vertexShaderDbg = LLGL_CAST(const DbgShader*, vertexShader);
-                const auto& inputAttribs = vertexShaderDbg->desc.vertex.inputAttribs;
-                if (!inputAttribs.empty())
-                    ValidateVertexLayoutAttributes(inputAttribs, bindings_.vertexBuffers, bindings_.numVertexBuffers);
-            }
-        }
+        record.numVertices      = numVertices;
+        record.firstVertex      = firstVertex;
+        record.numInstances     = numInstances;
+        record.firstInstance    = firstInstance;
+        record.vertexCount      = numVertices + firstVertex;
+        if (bindings_.numVertexBuffers > 0 && bindings_.anyShaderAttributes)
+            record.vertexLimit = static_cast<std::uint32_t>(bindings_.vertexBuffers[0]->elements);
     }
+    ValidateDrawRecord(record);
 }
 
-void DbgCommandBuffer::ValidateVertexLayoutAttributes(const ArrayView<VertexAttribute>& shaderVertexAttribs, DbgBuffer* const * vertexBuffers, std::uint32_t numVertexBuffers)
+void DbgCommandBuffer::ValidateDrawIndexedCmd(
+    std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
-    /* Check if all vertex attributes are served by active vertex buffer(s) */
-    std::size_t attribIndex = 0;
+    AssertRecording();
+    AssertInsideRenderPass();
+    AssertGraphicsPipelineBound();
+    AssertVertexBufferBound();
+    AssertIndexBufferBound();
+    AssertViewportBound();
 
-    for (std::uint32_t bufferIndex = 0; attribIndex < shaderVertexAttribs.size() && bufferIndex < numVertexBuffers; ++bufferIndex)
+    DbgDrawRecord record = MakeDrawRecord(
+        DbgDrawValidation::DynamicStates    |
+        DbgDrawValidation::VertexLayout     |
+        DbgDrawValidation::Vertices         |
+        DbgDrawValidation::InstanceID       |
+        DbgDrawValidation::BindingTable
+    );
     {
-        /* Compare remaining shader attributes with next vertex buffer attributes */
-        const auto& bufferVertexAttribs = vertexBuffers[bufferIndex]->desc.vertexAttribs;
-
-        for (std::size_t i = 0; i < bufferVertexAttribs.size() && attribIndex < shaderVertexAttribs.size(); ++i, ++attribIndex)
+        record.numVertices      = numVertices;
+        record.numInstances     = numInstances;
+        record.firstInstance    = firstInstance;
+        record.vertexCount      = numVertices + firstIndex;
+        if (bindings_.indexBuffer)
         {
-            /* Compare current vertex attributes */
-            const auto& attribLhs = shaderVertexAttribs[attribIndex];
-            const auto& attribRhs = bufferVertexAttribs[i];
-
-            if (attribLhs != attribRhs)
-                LLGL_DBG_ERROR(ErrorType::InvalidState, "vertex layout mismatch between shader program and vertex buffer(s)");
+            if (bindings_.indexBufferFormatSize > 0)
+                record.vertexLimit = static_cast<std::uint32_t>((bindings_.indexBuffer->desc.size - bindings_.indexBufferOffset) / bindings_.indexBufferFormatSize);
+            else
+                record.vertexLimit = static_cast<std::uint32_t>(bindings_.indexBuffer->elements);
         }
     }
-
-    if (attribIndex < shaderVertexAttribs.size())
-        LLGL_DBG_ERROR(ErrorType::InvalidState, "not all vertex attributes in the shader pipeline are covered by the bound vertex buffer(s)");
+    ValidateDrawRecord(record);
 }
 
-void DbgCommandBuffer::ValidateNumVertices(std::uint32_t numVertices)
+void DbgCommandBuffer::ValidateDrawMeshTasksCmd()
 {
-    if (numVertices == 0)
-        LLGL_DBG_WARN(WarningType::PointlessOperation, "no vertices will be generated");
-
-    switch (topology_)
-    {
-        case PrimitiveTopology::PointList:
-            break;
-
-        case PrimitiveTopology::LineList:
-            if (numVertices % 2 != 0)
-                WarnImproperVertices("line list", (numVertices % 2));
-            break;
-
-        case PrimitiveTopology::LineStrip:
-            if (numVertices < 2)
-                WarnImproperVertices("line strip", numVertices);
-            break;
-
-        case PrimitiveTopology::LineListAdjacency:
-            if (numVertices % 2 != 0)
-                WarnImproperVertices("line list adjacency", (numVertices % 2));
-            break;
-
-        case PrimitiveTopology::LineStripAdjacency:
-            if (numVertices < 2)
-                WarnImproperVertices("line strip adjacency", numVertices);
-            break;
-
-        case PrimitiveTopology::TriangleList:
-            if (numVertices % 3 != 0)
-                WarnImproperVertices("triangle list", (numVertices % 3));
-            break;
-
-        case PrimitiveTopology::TriangleStrip:
-            if (numVertices < 3)
-                WarnImproperVertices("triangle strip", numVertices);
-            break;
-
-        case PrimitiveTopology::TriangleListAdjacency:
-            if (numVertices % 3 != 0)
-                WarnImproperVertices("triangle list adjacency", (numVertices % 3));
-            break;
-
-        case PrimitiveTopology::TriangleStripAdjacency:
-            if (numVertices < 3)
-                WarnImproperVertices("triangle strip adjacency", numVertices);
-            break;
+    AssertRecording();
+    AssertInsideRenderPass();
+    AssertMeshShadersSupported();
+    AssertMeshPipelineBound();
+    AssertViewportBound();
 
-        default:
-            if (topology_ >= PrimitiveTopology::Patches1 && topology_ <= PrimitiveTopology::Patches32)
-            {
-                auto numPatchVertices = static_cast<std::uint32_t>(topology_) - static_cast<std::uint32_t>(PrimitiveTopology::Patches1) + 1;
-                if (numVertices % numPatchVertices != 0)
-                    WarnImproperVertices("patches" + std::to_string(numPatchVertices), (numVertices % numPatchVertices));
-            }
-            break;
-    }
+    DbgDrawRecord record = MakeDrawRecord(DbgDrawValidation::DynamicStates | DbgDrawValidation::BindingTable);
+    ValidateDrawRecord(record);
 }
 
-void DbgCommandBuffer::ValidateNumInstances(std::uint32_t numInstances)
+void DbgCommandBuffer::ValidateDrawStreamOutputCmd()
 {
-    if (numInstances == 0)
-        LLGL_DBG_WARN(WarningType::PointlessOperation, "no instances will be generated");
-}
+    AssertRecording();
+    AssertInsideRenderPass();
+    AssertStreamOutputsSupported();
+    AssertGraphicsPipelineBound();
+    AssertVertexBufferBound();
+    AssertViewportBound();
 
-void DbgCommandBuffer::ValidateVertexID(std::uint32_t firstVertex)
-{
-    if (firstVertex > 0)
+    if (bindings_.numVertexBuffers > 0)
     {
-        if (auto vertexShaderDbg = bindings_.vertexShader)
-        {
-            if (auto vertexID = vertexShaderDbg->GetVertexID())
-            {
-                LLGL_DBG_WARN(
-                    WarningType::VaryingBehavior,
-                    "bound shader program uses '" + std::string(vertexID) + "' while firstVertex > 0, which may result in varying behavior between different native APIs"
-                );
-            }
-        }
-    }
-}
+        /* Vertex count is taken from the stream-output counter of the first vertex buffer */
+        DbgBuffer* bufferDbg = bindings_.vertexBuffers[0];
+        ValidateBindBufferFlags(*bufferDbg, BindFlags::StreamOutputBuffer);
 
-void DbgCommandBuffer::ValidateInstanceID(std::uint32_t firstInstance)
-{
-    if (firstInstance > 0)
-    {
-        if (auto vertexShaderDbg = bindings_.vertexShader)
+        for_range(i, bindings_.numStreamOutputs)
         {
-            if (auto instanceID = vertexShaderDbg->GetInstanceID())
-            {
-                LLGL_DBG_WARN(
-                    WarningType::VaryingBehavior,
-                    "bound shader program uses '" + std::string(instanceID) + "' while firstInstance > 0, which may result in varying behavior between different native APIs"
-                );
-            }
+            if (bindings_.streamOutputs[i] == bufferDbg)
+                LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot draw stream-output from vertex buffer while it is bound as stream-output buffer at slot " + std::to_string(i));
         }
     }
-}
 
-void DbgCommandBuffer::ValidateDrawCmd(
-    std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
-{
-    AssertRecording();
-    AssertInsideRenderPass();
-    AssertGraphicsPipelineBound();
-    AssertVertexBufferBound();
-    AssertViewportBound();
-    ValidateDynamicStates();
-    ValidateVertexLayout();
-    ValidateNumVertices(numVertices);
-    ValidateNumInstances(numInstances);
-    ValidateVertexID(firstVertex);
-    ValidateInstanceID(firstInstance);
-    ValidateBindingTable();
-
-    if (bindings_.numVertexBuffers > 0 && bindings_.anyShaderAttributes)
-        ValidateVertexLimit(numVertices + firstVertex, static_cast<std::uint32_t>(bindings_.vertexBuffers[0]->elements));
+    DbgDrawRecord record = MakeDrawRecord(
+        DbgDrawValidation::DynamicStates    |
+        DbgDrawValidation::VertexLayout     |
+        DbgDrawValidation::BindingTable
+    );
+    ValidateDrawRecord(record);
 }
 
-void DbgCommandBuffer::ValidateDrawIndexedCmd(
-    std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+void DbgCommandBuffer::ValidateAccelerationStructureBuild(DbgAccelerationStructure& accelStructDbg, const AccelerationStructureBuildDescriptor& buildDesc)
 {
-    AssertRecording();
-    AssertInsideRenderPass();
-    AssertGraphicsPipelineBound();
-    AssertVertexBufferBound();
-    AssertIndexBufferBound();
-    AssertViewportBound();
-    ValidateDynamicStates();
-    ValidateVertexLayout();
-    ValidateNumVertices(numVertices);
-    ValidateNumInstances(numInstances);
-    ValidateInstanceID(firstInstance);
-    ValidateBindingTable();
+    if (accelStructDbg.compactedSize > 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot build acceleration structure that was created as compaction destination");
 
-    if (bindings_.indexBuffer)
+    if (buildDesc.update)
     {
-        if (bindings_.indexBufferFormatSize > 0)
+        if ((accelStructDbg.flags & AccelerationStructureFlags::AllowUpdate) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot update acceleration structure that was not created with 'LLGL::AccelerationStructureFlags::AllowUpdate'");
+        if (!accelStructDbg.built)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot update acceleration structure that has not been built");
+    }
+
+    if (accelStructDbg.GetType() == AccelerationStructureType::TopLevel)
+    {
+        if (buildDesc.instances.size() > accelStructDbg.maxInstances)
         {
-            ValidateVertexLimit(
-                numVertices + firstIndex,
-                static_cast<std::uint32_t>((bindings_.indexBuffer->desc.size - bindings_.indexBufferOffset) / bindings_.indexBufferFormatSize)
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "too many instances for top-level acceleration structure: " + std::to_string(buildDesc.instances.size()) +
+                " specified but limit is " + std::to_string(accelStructDbg.maxInstances)
             );
         }
-        else
+        if (buildDesc.update && buildDesc.instances.size() != accelStructDbg.numBuiltInstances)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "update of top-level acceleration structure must have the same number of instances as its previous build");
+
+        for_range(i, buildDesc.instances.size())
+        {
+            const AccelerationStructureInstance& instanceDesc = buildDesc.instances[i];
+            auto* blasDbg = DbgGetWrapper<DbgAccelerationStructure>(instanceDesc.accelerationStructure);
+            if (blasDbg == nullptr)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "acceleration structure of instance [" + std::to_string(i) + "] must not be null");
+            else if (blasDbg->GetType() != AccelerationStructureType::BottomLevel)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "acceleration structure of instance [" + std::to_string(i) + "] must be a bottom-level acceleration structure");
+            else if (!blasDbg->built)
+                LLGL_DBG_ERROR(ErrorType::InvalidState, "acceleration structure of instance [" + std::to_string(i) + "] has not been built");
+        }
+    }
+    else
+    {
+        if (buildDesc.geometries.size() != accelStructDbg.geometries.size())
         {
-            ValidateVertexLimit(
-                numVertices + firstIndex,
-                static_cast<std::uint32_t>(bindings_.indexBuffer->elements)
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "mismatch between number of geometries for bottom-level acceleration structure build: " + std::to_string(buildDesc.geometries.size()) +
+                " specified but " + std::to_string(accelStructDbg.geometries.size()) + " required"
             );
+            return;
+        }
+
+        for_range(i, buildDesc.geometries.size())
+        {
+            const AccelerationStructureGeometryDescriptor& geometryDesc = buildDesc.geometries[i];
+            const AccelerationStructureGeometryDescriptor& createDesc   = accelStructDbg.geometries[i];
+            const std::string geometryName = "acceleration structure geometry [" + std::to_string(i) + "]";
+
+            if (auto* vertexBufferDbg = DbgGetWrapper<DbgBuffer>(geometryDesc.vertexBuffer))
+                ValidateBufferRange(*vertexBufferDbg, geometryDesc.vertexOffset, static_cast<std::uint64_t>(geometryDesc.numVertices) * geometryDesc.vertexStride, "vertex range");
+            else
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "vertex buffer of " + geometryName + " must not be null");
+
+            if (auto* indexBufferDbg = DbgGetWrapper<DbgBuffer>(geometryDesc.indexBuffer))
+                ValidateBufferRange(*indexBufferDbg, geometryDesc.indexOffset, static_cast<std::uint64_t>(geometryDesc.numIndices) * (geometryDesc.indexFormat == Format::R16UInt ? 2u : 4u), "index range");
+
+            if (geometryDesc.vertexFormat != createDesc.vertexFormat || (geometryDesc.indexBuffer != nullptr && geometryDesc.indexFormat != createDesc.indexFormat))
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "formats of " + geometryName + " must match the formats specified at creation time");
+            if (geometryDesc.numVertices > createDesc.numVertices || geometryDesc.numIndices > createDesc.numIndices)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "number of vertices or indices of " + geometryName + " exceeds the number specified at creation time");
         }
     }
 }
 
-void DbgCommandBuffer::ValidateVertexLimit(std::uint32_t vertexCount, std::uint32_t vertexLimit)
+void DbgCommandBuffer::ValidateCompactIndirectArguments(
+    DbgBuffer&      dstBufferDbg,
+    std::uint64_t   dstOffset,
+    DbgBuffer&      countBufferDbg,
+    std::uint64_t   countOffset,
+    DbgBuffer&      srcBufferDbg,
+    std::uint64_t   srcOffset,
+    DbgBuffer&      visibilityBufferDbg,
+    std::uint64_t   visibilityOffset,
+    std::uint32_t   numCommands,
+    std::uint32_t   stride)
 {
-    if (vertexCount > vertexLimit)
+    if (numCommands == 0)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "no indirect arguments to compact");
+
+    ValidateAddressAlignment(stride, 4, "<stride> parameter");
+    if (stride == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "<stride> parameter must not be zero");
+
+    /* Destination and count are read by indirect commands, source and visibility only by the compute shader */
+    const std::uint64_t argsSize        = static_cast<std::uint64_t>(stride) * numCommands;
+    const std::uint64_t visibilitySize  = (static_cast<std::uint64_t>(numCommands) + 31) / 32 * sizeof(std::uint32_t);
+
+    ValidateBindBufferFlags(dstBufferDbg, BindFlags::Storage | BindFlags::IndirectBuffer);
+    ValidateBufferRange(dstBufferDbg, dstOffset, argsSize, "destination range");
+    ValidateAddressAlignment(dstOffset, 4, "<dstOffset> parameter");
+
+    ValidateBindBufferFlags(countBufferDbg, BindFlags::Storage | BindFlags::IndirectBuffer);
+    ValidateBufferRange(countBufferDbg, countOffset, sizeof(std::uint32_t), "count range");
+    ValidateAddressAlignment(countOffset, 4, "<countOffset> parameter");
+
+    ValidateBindBufferFlags(srcBufferDbg, BindFlags::Storage);
+    ValidateBufferRange(srcBufferDbg, srcOffset, argsSize, "source range");
+    ValidateAddressAlignment(srcOffset, 4, "<srcOffset> parameter");
+
+    ValidateBindBufferFlags(visibilityBufferDbg, BindFlags::Storage);
+    ValidateBufferRange(visibilityBufferDbg, visibilityOffset, visibilitySize, "visibility range");
+    ValidateAddressAlignment(visibilityOffset, 4, "<visibilityOffset> parameter");
+
+    /* Written ranges must not overlap with any other range, since the compute shader reads and writes them concurrently */
+    auto IsOverlapping = [](DbgBuffer& lhsBuffer, std::uint64_t lhsOffset, std::uint64_t lhsSize, DbgBuffer& rhsBuffer, std::uint64_t rhsOffset, std::uint64_t rhsSize) -> bool
     {
-        LLGL_DBG_ERROR(
-            ErrorType::InvalidArgument,
-            "vertex count out of bounds: " + std::to_string(vertexCount) +
-            " specified but limit is " + std::to_string(vertexLimit)
-        );
+        return (&lhsBuffer == &rhsBuffer && lhsOffset < rhsOffset + rhsSize && rhsOffset < lhsOffset + lhsSize);
+    };
+
+    if (IsOverlapping(dstBufferDbg, dstOffset, argsSize, srcBufferDbg, srcOffset, argsSize))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "destination range must not overlap with source range for compaction of indirect arguments");
+    if (IsOverlapping(dstBufferDbg, dstOffset, argsSize, visibilityBufferDbg, visibilityOffset, visibilitySize))
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "destination range must not overlap with visibility range for compaction of indirect arguments");
+    if (IsOverlapping(countBufferDbg, countOffset, sizeof(std::uint32_t), dstBufferDbg, dstOffset, argsSize) ||
+        IsOverlapping(countBufferDbg, countOffset, sizeof(std::uint32_t), srcBufferDbg, srcOffset, argsSize) ||
+        IsOverlapping(countBufferDbg, countOffset, sizeof(std::uint32_t), visibilityBufferDbg, visibilityOffset, visibilitySize))
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "count range must not overlap with any other range for compaction of indirect arguments");
     }
 }
 
@@ -1796,6 +2501,18 @@ void DbgCommandBuffer::ValidateBindBufferFlags(DbgBuffer& bufferDbg, long bindFl
     ValidateBindFlags(bufferDbg.desc.bindFlags, bindFlags, bindFlags, GetLabelOrDefault(bufferDbg.label, "LLGL::Buffer"));
 }
 
+void DbgCommandBuffer::ValidateCopyDestinationBuffer(DbgBuffer& bufferDbg)
+{
+    if ((bufferDbg.desc.miscFlags & MiscFlags::HostVisible) != 0 && (bufferDbg.desc.cpuAccessFlags & CPUAccessFlags::Write) != 0)
+    {
+        LLGL_DBG_WARN(
+            WarningType::VaryingBehavior,
+            "host-visible buffer '" + std::string(GetLabelOrDefault(bufferDbg.label, "LLGL::Buffer")) +
+            "' is used as copy destination, which is not supported by all backends: buffer was created with 'LLGL::MiscFlags::HostVisible'"
+        );
+    }
+}
+
 void DbgCommandBuffer::ValidateBindTextureFlags(DbgTexture& textureDbg, long bindFlags)
 {
     ValidateBindFlags(textureDbg.desc.bindFlags, bindFlags, bindFlags, GetLabelOrDefault(textureDbg.label, "LLGL::Texture"));
@@ -2151,86 +2868,66 @@ void DbgCommandBuffer::ValidateUniforms(const DbgPipelineLayout& pipelineLayoutD
     }
 }
 
-void DbgCommandBuffer::ValidateDynamicStates()
+void DbgCommandBuffer::ValidateBindingTable()
 {
-    if (!bindings_.blendFactorSet)
-    {
-        LLGL_DBG_ERROR(
-            ErrorType::InvalidState,
-            "blend factor is not set; missing call to <LLGL::CommandBuffer::SetBlendFactor>"
-            " or PSO must be created with 'LLGL::BlendDescriptor::blendFactorDynamic' being disabled"
-        );
-    }
-    if (!bindings_.stencilRefSet)
-    {
-        LLGL_DBG_ERROR(
-            ErrorType::InvalidState,
-            "stencil reference blend factor is not set; missing call to <LLGL::CommandBuffer::SetStencilReference>"
-            " or PSO must be created with 'LLGL::StencilDescriptor::referenceDynamic' being disabled"
-        );
-    }
+    DbgDrawRecord record = MakeDrawRecord(DbgDrawValidation::BindingTable);
+    ValidateDrawRecord(record);
 }
 
-// Returns a descriptive string for the specified binding
-static std::string GetBindingDescStr(const BindingDescriptor& binding)
+DbgDrawRecord DbgCommandBuffer::MakeDrawRecord(long flags)
 {
-    std::string s;
-
-    s = "slot ";
-    s += std::to_string(binding.slot.index);
-
-    if (binding.slot.set != 0)
+    /* Skip validation if the combination of PSO and vertex buffers or resource bindings has already been validated */
+    if (validationCacheEnabled_)
     {
-        s += ", set ";
-        s += std::to_string(binding.slot.set);
+        if ((flags & DbgDrawValidation::VertexLayout) != 0)
+        {
+            if (bindings_.vertexLayoutValidated)
+                flags &= ~DbgDrawValidation::VertexLayout;
+            bindings_.vertexLayoutValidated = true;
+        }
+        if ((flags & DbgDrawValidation::BindingTable) != 0)
+        {
+            if (bindings_.bindingTableValidated)
+                flags &= ~DbgDrawValidation::BindingTable;
+            bindings_.bindingTableValidated = true;
+        }
     }
 
-    if (!binding.name.empty())
+    DbgDrawRecord record;
     {
-        s += ", name '";
-        s += binding.name;
-        s += "'";
+        record.source           = debugger_->GetSource();
+        record.flags            = flags;
+        record.topology         = topology_;
+        record.pipelineState    = bindings_.pipelineState;
+        record.vertexShader     = bindings_.vertexShader;
+        record.blendFactorSet   = bindings_.blendFactorSet;
+        record.stencilRefSet    = bindings_.stencilRefSet;
+        record.numVertexBuffers = bindings_.numVertexBuffers;
+        record.numResources     = bindings_.bindingTable.resources.size();
     }
-
-    return s;
+    return record;
 }
 
-static std::string GetPipelineBindingDescStr(const DbgPipelineState& pso, const PipelineLayoutDescriptor& layoutDesc, std::size_t bindingIndex)
+void DbgCommandBuffer::ValidateDrawRecord(DbgDrawRecord& record)
 {
-    std::string s;
+    if (record.flags == 0)
+        return;
 
-    s = "missing descriptor [";
-    s += std::to_string(bindingIndex);
-    s += "] in pipeline state ";
-    if (!pso.label.empty())
+    if (asyncValidation_)
     {
-        s += "'";
-        s += pso.label;
-        s += "' ";
-    }
-    s += "for binding (";
-    s += GetBindingDescStr(layoutDesc.bindings[bindingIndex]);
-    s += ")";
-
-    return s;
-}
-
-void DbgCommandBuffer::ValidateBindingTable()
-{
-    auto ValidateBindingTableWithLayout = [this](const DbgPipelineState& pso, const Bindings::BindingTable& table, const PipelineLayoutDescriptor& layoutDesc)
-    {
-        LLGL_ASSERT(table.resources.size() == layoutDesc.bindings.size());
-        for_range(i, table.resources.size())
+        /* Append current debug group to the log only when it has changed since the last record */
+        if (validationGroupDirty_)
         {
-            if (table.resources[i] == nullptr)
-                LLGL_DBG_ERROR(ErrorType::InvalidState, GetPipelineBindingDescStr(pso, layoutDesc, i));
+            validationGroup_        = (debugGroups_.empty() ? 0 : validationLog_.AppendDebugGroup(debugGroups_.top()));
+            validationGroupDirty_   = false;
         }
-    };
-
-    if (auto pso = bindings_.pipelineState)
+        record.debugGroup = validationGroup_;
+        validationLog_.Append(record, bindings_.vertexBuffers, bindings_.bindingTable.resources.data());
+    }
+    else
     {
-        if (auto pipelineLayout = pso->pipelineLayout)
-            ValidateBindingTableWithLayout(*pso, bindings_.bindingTable, pipelineLayout->desc);
+        DbgDrawValidator validator{ debugger_ };
+        validator.Validate(record, bindings_.vertexBuffers, bindings_.bindingTable.resources.data());
     }
 }
 
@@ -2278,7 +2975,20 @@ void DbgCommandBuffer::AssertInsideRenderPass()
 
 void DbgCommandBuffer::AssertGraphicsPipelineBound()
 {
-    AssertAndGetGraphicsPSO();
+    if (auto pipelineStateDbg = AssertAndGetGraphicsPSO())
+    {
+        if (pipelineStateDbg->graphicsDesc.meshShader != nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "mesh pipeline is bound but it can only be used with <LLGL::CommandBuffer::DrawMeshTasks>");
+    }
+}
+
+void DbgCommandBuffer::AssertMeshPipelineBound()
+{
+    if (auto pipelineStateDbg = AssertAndGetGraphicsPSO())
+    {
+        if (pipelineStateDbg->graphicsDesc.meshShader == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "graphics pipeline without mesh shader is bound but mesh pipeline is required");
+    }
 }
 
 void DbgCommandBuffer::AssertComputePipelineBound()
@@ -2341,6 +3051,36 @@ void DbgCommandBuffer::AssertIndirectDrawingSupported()
         LLGL_DBG_ERROR_NOT_SUPPORTED("indirect drawing");
 }
 
+void DbgCommandBuffer::AssertIndirectCountDrawingSupported()
+{
+    if (!features_.hasIndirectCountDrawing)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("indirect drawing with count buffer");
+}
+
+void DbgCommandBuffer::AssertMeshShadersSupported()
+{
+    if (!features_.hasMeshShaders)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("mesh shaders");
+}
+
+void DbgCommandBuffer::AssertStreamOutputsSupported()
+{
+    if (!features_.hasStreamOutputs)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("stream-outputs");
+}
+
+void DbgCommandBuffer::AssertTextureCompressionSupported()
+{
+    if (!features_.hasTextureCompression)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("GPU texture compression");
+}
+
+void DbgCommandBuffer::AssertIndirectArgumentCompactionSupported()
+{
+    if (!features_.hasIndirectArgumentCompaction)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("indirect argument compaction");
+}
+
 void DbgCommandBuffer::AssertNullPointer(const void* ptr, const char* name)
 {
     if (ptr == nullptr)
@@ -2352,13 +3092,41 @@ void DbgCommandBuffer::AssertNullPointer(const void* ptr, const char* name)
     }
 }
 
-void DbgCommandBuffer::WarnImproperVertices(const std::string& topologyName, std::uint32_t unusedVertices)
+void DbgCommandBuffer::RecordBufferWrite(DbgBuffer& bufferDbg)
 {
-    LLGL_DBG_WARN(
-        WarningType::ImproperArgument,
-        "improper number of vertices for " + topologyName + " (" + std::to_string(unusedVertices) +
-        " unused " + std::string(unusedVertices > 1 ? "vertices" : "vertex") + ")"
-    );
+    if (lintEnabled_)
+        records_.writtenBuffers.push_back(&bufferDbg);
+}
+
+void DbgCommandBuffer::LintRedundantClear(long clearFlags)
+{
+    /* Clearing attachments before any draw command is redundant if the render pass has already cleared them with its load operations */
+    if ((clearFlags & lints_.renderPassClearFlags) != 0 && profile_.drawCommands == lints_.renderPassDrawCommands)
+    {
+        LLGL_DBG_LINT(
+            PerformanceLint::RedundantClear,
+            "attachments are cleared again before any draw command although the render pass already clears them"
+        );
+    }
+}
+
+void DbgCommandBuffer::LintRenderPassClears(const RenderPass* renderPass)
+{
+    lints_ = Lints{};
+    lints_.renderPassDrawCommands = profile_.drawCommands;
+
+    if (auto* renderPassDbg = LLGL_CAST(const DbgRenderPass*, renderPass))
+    {
+        for (const AttachmentFormatDescriptor& colorAttachment : renderPassDbg->desc.colorAttachments)
+        {
+            if (colorAttachment.loadOp == AttachmentLoadOp::Clear)
+                lints_.renderPassClearFlags |= ClearFlags::Color;
+        }
+        if (renderPassDbg->desc.depthAttachment.loadOp == AttachmentLoadOp::Clear)
+            lints_.renderPassClearFlags |= ClearFlags::Depth;
+        if (renderPassDbg->desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
+            lints_.renderPassClearFlags |= ClearFlags::Stencil;
+    }
 }
 
 void DbgCommandBuffer::ResetStates()
@@ -2367,11 +3135,51 @@ void DbgCommandBuffer::ResetStates()
     ::memset(profile_.values, 0, sizeof(profile_.values));
     ::memset(&bindings_, 0, sizeof(bindings_));
     ::memset(&states_, 0, sizeof(states_));
+    lints_ = Lints{};
 }
 
 void DbgCommandBuffer::ResetRecords()
 {
     records_.swapChainFrames.clear();
+    records_.writtenBuffers.clear();
+    validationLog_.Clear();
+}
+
+void DbgCommandBuffer::SelectValidationForEncoding()
+{
+    /* Only forward the attached debugger to the validation functions if this encoding is validated */
+    debugger_               = nullptr;
+    validationCacheEnabled_ = false;
+    asyncValidation_        = false;
+
+    if (attachedDebugger_ == nullptr)
+        return;
+
+    switch (attachedDebugger_->GetValidationLevel())
+    {
+        case DebugValidationLevel::Off:
+            break;
+
+        case DebugValidationLevel::Sampled:
+        {
+            const std::uint64_t interval = std::max<std::uint64_t>(1u, attachedDebugger_->GetSamplingInterval());
+            if (encodingCounter_ % interval == 0)
+                debugger_ = attachedDebugger_;
+            validationCacheEnabled_ = true;
+            ++encodingCounter_;
+        }
+        break;
+
+        case DebugValidationLevel::Full:
+            debugger_ = attachedDebugger_;
+            break;
+
+        case DebugValidationLevel::Asynchronous:
+            debugger_               = attachedDebugger_;
+            validationCacheEnabled_ = true;
+            asyncValidation_        = (validationWorker_ != nullptr);
+            break;
+    }
 }
 
 void DbgCommandBuffer::ResetBindingTable(const DbgPipelineLayout* pipelineLayoutDbg)
@@ -2392,6 +3200,8 @@ void DbgCommandBuffer::ResetBindingTable(const DbgPipelineLayout* pipelineLayout
         table.uniforms.clear();
     };
 
+    bindings_.bindingTableValidated = false;
+
     if (pipelineLayoutDbg != nullptr)
         ResetBindingTableWithLayout(bindings_.bindingTable, pipelineLayoutDbg->desc);
     else
@@ -15,6 +15,9 @@
 #include <LLGL/Container/ArrayView.h>
 #include "RenderState/DbgQueryHeap.h"
 #include "DbgQueryTimerManager.h"
+#include "DbgScopeProfiler.h"
+#include "DbgCapture.h"
+#include "DbgValidationWorker.h"
 #include <cstdint>
 #include <string>
 #include <stack>
@@ -25,6 +28,8 @@ namespace LLGL
 
 
 class DbgBuffer;
+class DbgAccelerationStructure;
+class DbgCommandQueue;
 class DbgTexture;
 class DbgSwapChain;
 class DbgRenderTarget;
@@ -46,9 +51,12 @@ class DbgCommandBuffer final : public CommandBuffer
         DbgCommandBuffer(
             RenderSystem&                   renderSystemInstance,
             CommandQueue&                   commandQueueInstance,
+            DbgCommandQueue*                commandQueueDbg,
             CommandBuffer&                  commandBufferInstance,
             RenderingDebugger*              debugger,
             RenderingProfiler*              profiler,
+            DbgCapture*                     capture,
+            DbgValidationWorker*            validationWorker,
             const CommandBufferDescriptor&  desc,
             const RenderingCapabilities&    caps
         );
@@ -57,7 +65,19 @@ class DbgCommandBuffer final : public CommandBuffer
 
         void NextProfile(FrameProfile& outputProfile);
 
-        void ValidateSubmit();
+        void ValidateSubmit(const CommandQueue& commandQueueInstance);
+
+        // Returns true if the current encoding of this command buffer is validated. See DebugValidationLevel.
+        inline bool IsValidated() const
+        {
+            return (debugger_ != nullptr);
+        }
+
+        // Returns the buffers that are written by the current encoding of this command buffer. Only recorded if performance lints are enabled.
+        inline const std::vector<DbgBuffer*>& GetWrittenBuffers() const
+        {
+            return records_.writtenBuffers;
+        }
 
     public:
 
@@ -69,27 +89,36 @@ class DbgCommandBuffer final : public CommandBuffer
         void EnableRecording(bool enable);
 
         void ValidateGenerateMips(DbgTexture& textureDbg, const TextureSubresource* subresource = nullptr);
+        void ValidateCompressTexture(DbgTexture& dstTextureDbg, DbgTexture& srcTextureDbg, const TextureSubresource& subresource);
         void ValidateViewport(const Viewport& viewport);
         void ValidateAttachmentClear(const AttachmentClear& attachment);
 
-        void ValidateVertexLayout();
-        void ValidateVertexLayoutAttributes(const ArrayView<VertexAttribute>& shaderVertexAttribs, DbgBuffer* const * vertexBuffers, std::uint32_t numVertexBuffers);
-
-        void ValidateNumVertices(std::uint32_t numVertices);
-        void ValidateNumInstances(std::uint32_t numInstances);
-        void ValidateVertexID(std::uint32_t firstVertex);
-        void ValidateInstanceID(std::uint32_t firstInstance);
-
         void ValidateDrawCmd(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance);
         void ValidateDrawIndexedCmd(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance);
-
-        void ValidateVertexLimit(std::uint32_t vertexCount, std::uint32_t vertexLimit);
+        void ValidateDrawMeshTasksCmd();
+        void ValidateDrawStreamOutputCmd();
+
+        void ValidateAccelerationStructureBuild(DbgAccelerationStructure& accelStructDbg, const AccelerationStructureBuildDescriptor& buildDesc);
+
+        void ValidateCompactIndirectArguments(
+            DbgBuffer&      dstBufferDbg,
+            std::uint64_t   dstOffset,
+            DbgBuffer&      countBufferDbg,
+            std::uint64_t   countOffset,
+            DbgBuffer&      srcBufferDbg,
+            std::uint64_t   srcOffset,
+            DbgBuffer&      visibilityBufferDbg,
+            std::uint64_t   visibilityOffset,
+            std::uint32_t   numCommands,
+            std::uint32_t   stride
+        );
         void ValidateThreadGroupLimit(std::uint32_t size, std::uint32_t limit);
         void ValidateAttachmentLimit(std::uint32_t attachmentIndex, std::uint32_t attachmentUpperBound);
         void ValidateDescriptorSetIndex(std::uint32_t setIndex, std::uint32_t setUpperBound, const char* resourceHeapName = nullptr);
 
         void ValidateBindFlags(long resourceFlags, long bindFlags, long validFlags, const char* resourceName = nullptr);
         void ValidateBindBufferFlags(DbgBuffer& bufferDbg, long bindFlags);
+        void ValidateCopyDestinationBuffer(DbgBuffer& bufferDbg);
         void ValidateBindTextureFlags(DbgTexture& textureDbg, long bindFlags);
         void ValidateTextureRegion(DbgTexture& textureDbg, const TextureRegion& region);
         void ValidateIndexType(const Format format);
@@ -113,9 +142,14 @@ class DbgCommandBuffer final : public CommandBuffer
 
         void ValidateUniforms(const DbgPipelineLayout& pipelineLayoutDbg, std::uint32_t first, std::uint16_t dataSize);
 
-        void ValidateDynamicStates();
         void ValidateBindingTable();
 
+        // Returns a snapshot of the current bindings for the specified validation flags. Flags of checks whose result is cached are removed.
+        DbgDrawRecord MakeDrawRecord(long flags);
+
+        // Validates the specified record immediately or appends it to the validation log if this encoding is validated asynchronously.
+        void ValidateDrawRecord(DbgDrawRecord& record);
+
         DbgPipelineState* AssertAndGetGraphicsPSO();
         DbgPipelineState* AssertAndGetComputePSO();
 
@@ -123,6 +157,7 @@ class DbgCommandBuffer final : public CommandBuffer
         void AssertInsideRenderPass();
         void AssertGraphicsPipelineBound();
         void AssertComputePipelineBound();
+        void AssertMeshPipelineBound();
         void AssertVertexBufferBound();
         void AssertIndexBufferBound();
         void AssertViewportBound();
@@ -130,13 +165,21 @@ class DbgCommandBuffer final : public CommandBuffer
         void AssertInstancingSupported();
         void AssertOffsetInstancingSupported();
         void AssertIndirectDrawingSupported();
+        void AssertIndirectCountDrawingSupported();
+        void AssertMeshShadersSupported();
+        void AssertStreamOutputsSupported();
+        void AssertTextureCompressionSupported();
+        void AssertIndirectArgumentCompactionSupported();
 
         void AssertNullPointer(const void* ptr, const char* name);
 
-        void WarnImproperVertices(const std::string& topologyName, std::uint32_t unusedVertices);
+        void RecordBufferWrite(DbgBuffer& bufferDbg);
+        void LintRedundantClear(long clearFlags);
+        void LintRenderPassClears(const RenderPass* renderPass);
 
         void ResetStates();
         void ResetRecords();
+        void SelectValidationForEncoding();
         void ResetBindingTable(const DbgPipelineLayout* pipelineLayoutDbg);
 
         void StartTimer(const char* annotation);
@@ -154,8 +197,13 @@ class DbgCommandBuffer final : public CommandBuffer
 
         /* ----- Common objects ----- */
 
-        RenderingDebugger*          debugger_                               = nullptr;
+        RenderingDebugger*          debugger_                               = nullptr; // Attached debugger if the current encoding is validated, null otherwise
+        RenderingDebugger*          attachedDebugger_                       = nullptr;
+        std::uint64_t               encodingCounter_                        = 0;
+        bool                        validationCacheEnabled_                 = false;
         RenderingProfiler*          profiler_                               = nullptr;
+        const CommandQueue&         commandQueueInstance_;
+        DbgCommandQueue*            commandQueueDbg_                        = nullptr;
 
         const RenderingFeatures&    features_;
         const RenderingLimits&      limits_;
@@ -165,6 +213,21 @@ class DbgCommandBuffer final : public CommandBuffer
         DbgQueryTimerManager        timerMngr_;
         bool                        perfProfilerEnabled_                    = false;
 
+        DbgScopeProfiler            scopeProfiler_;
+        bool                        scopeProfilerEnabled_                   = false;
+
+        DbgCapture*                 capture_                                = nullptr;
+        DbgCaptureStream            captureStream_;
+        bool                        capturing_                              = false; // Commands of the current encoding are recorded for a capture
+
+        bool                        lintEnabled_                            = false; // Performance lints are checked for the current encoding
+
+        DbgValidationWorker*        validationWorker_                       = nullptr;
+        DbgValidationLog            validationLog_;
+        bool                        asyncValidation_                        = false; // Draw and dispatch commands of the current encoding are validated by the worker
+        std::uint32_t               validationGroup_                        = 0;
+        bool                        validationGroupDirty_                   = false; // Debug group has changed since the last record of the validation log
+
         /* ----- Render states ----- */
 
         FrameProfile                profile_;
@@ -183,6 +246,7 @@ class DbgCommandBuffer final : public CommandBuffer
             DbgBuffer* const *      vertexBuffers                           = nullptr;
             std::uint32_t           numVertexBuffers                        = 0;
             bool                    anyShaderAttributes                     = false;
+            bool                    vertexLayoutValidated                   = false;
             DbgBuffer*              indexBuffer                             = nullptr;
             std::uint64_t           indexBufferFormatSize                   = 0;
             std::uint64_t           indexBufferOffset                       = 0;
@@ -194,6 +258,7 @@ class DbgCommandBuffer final : public CommandBuffer
             const DbgShader*        vertexShader                            = nullptr;
             bool                    blendFactorSet                          = false;
             bool                    stencilRefSet                           = false;
+            bool                    bindingTableValidated                   = false;
 
             struct BindingTable
             {
@@ -216,9 +281,18 @@ class DbgCommandBuffer final : public CommandBuffer
         struct Records
         {
             std::vector<SwapChainFramePair> swapChainFrames;
+            std::vector<DbgBuffer*>         writtenBuffers;
         }
         records_;
 
+        struct Lints
+        {
+            const DbgPipelineState* pipelineState                           = nullptr; // Last PSO bound in the current render pass
+            long                    renderPassClearFlags                    = 0;       // Attachments cleared by the load operations of the current render pass
+            std::uint32_t           renderPassDrawCommands                  = 0;       // Number of draw commands when the current render pass began
+        }
+        lints_;
+
 };
 
 
@@ -7,20 +7,28 @@
 
 #include "DbgCommandQueue.h"
 #include "DbgCommandBuffer.h"
+#include "DbgCapture.h"
+#include "DbgSwapChain.h"
 #include "DbgCore.h"
+#include "Buffer/DbgBuffer.h"
+#include "Texture/DbgTexture.h"
 #include "../CheckedCast.h"
 #include <LLGL/RenderingProfiler.h>
 #include <LLGL/RenderingDebugger.h>
+#include <LLGL/Container/SmallVector.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-DbgCommandQueue::DbgCommandQueue(CommandQueue& instance, RenderingProfiler* profiler, RenderingDebugger* debugger) :
+DbgCommandQueue::DbgCommandQueue(CommandQueue& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, DbgCapture* capture) :
     instance  { instance },
     profiler_ { profiler },
-    debugger_ { debugger }
+    debugger_ { debugger },
+    capture_  { capture  }
 {
 }
 
@@ -30,14 +38,16 @@ void DbgCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, commandBuffer);
 
-    if (debugger_)
+    if (debugger_ && commandBufferDbg.IsValidated())
     {
         LLGL_DBG_SOURCE;
-        commandBufferDbg.ValidateSubmit();
+        commandBufferDbg.ValidateSubmit(instance);
     }
 
     instance.Submit(commandBufferDbg.instance);
 
+    RecordBufferWrites(commandBufferDbg.GetWrittenBuffers());
+
     if (profiler_)
     {
         /* Merge frame profile values into rendering profiler */
@@ -47,6 +57,124 @@ void DbgCommandQueue::Submit(CommandBuffer& commandBuffer)
 
         profiler_->Accumulate(profile);
     }
+
+    if (capture_)
+    {
+        capture_->RecordSubmit(commandBufferDbg);
+        capture_->Poll(false);
+    }
+}
+
+void DbgCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    /* Validate and unwrap all command buffers, so the backend can submit them at once */
+    SmallVector<CommandBuffer*, 8> instanceCommandBuffers;
+    instanceCommandBuffers.reserve(numCommandBuffers);
+
+    for_range(i, numCommandBuffers)
+    {
+        auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, *commandBuffers[i]);
+
+        if (debugger_ && commandBufferDbg.IsValidated())
+        {
+            LLGL_DBG_SOURCE;
+            commandBufferDbg.ValidateSubmit(instance);
+        }
+
+        instanceCommandBuffers.push_back(&(commandBufferDbg.instance));
+    }
+
+    instance.Submit(static_cast<std::uint32_t>(instanceCommandBuffers.size()), instanceCommandBuffers.data());
+
+    for_range(i, numCommandBuffers)
+        RecordBufferWrites(LLGL_CAST(DbgCommandBuffer&, *commandBuffers[i]).GetWrittenBuffers());
+
+    if (profiler_)
+    {
+        /* Merge frame profile values of all command buffers into rendering profiler */
+        for_range(i, numCommandBuffers)
+        {
+            auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, *commandBuffers[i]);
+            FrameProfile profile;
+            commandBufferDbg.NextProfile(profile);
+            profile.commandBufferSubmittions++;
+            profiler_->Accumulate(profile);
+        }
+    }
+
+    if (capture_)
+    {
+        for_range(i, numCommandBuffers)
+            capture_->RecordSubmit(LLGL_CAST(DbgCommandBuffer&, *commandBuffers[i]));
+        capture_->Poll(false);
+    }
+}
+
+/* ----- Presentation ----- */
+
+void DbgCommandQueue::Present(std::uint32_t numSwapChains, SwapChain* const * swapChains)
+{
+    /* Unwrap all swap-chains, so the backend can present them at once */
+    SmallVector<SwapChain*, 8> instanceSwapChains;
+    instanceSwapChains.reserve(numSwapChains);
+
+    for_range(i, numSwapChains)
+    {
+        if (swapChains[i] != nullptr)
+            instanceSwapChains.push_back(&(LLGL_CAST(DbgSwapChain*, swapChains[i])->instance));
+    }
+
+    instance.Present(static_cast<std::uint32_t>(instanceSwapChains.size()), instanceSwapChains.data());
+
+    for_range(i, numSwapChains)
+    {
+        if (swapChains[i] != nullptr)
+            LLGL_CAST(DbgSwapChain*, swapChains[i])->NotifyPresented();
+    }
+}
+
+/* ----- Sparse Resources ----- */
+
+void DbgCommandQueue::UpdateTileMappings(Texture& texture, std::uint32_t numMappings, const TextureTileMapping* mappings)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if ((textureDbg.desc.miscFlags & MiscFlags::Sparse) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot update tile mappings of texture that was not created with 'LLGL::MiscFlags::Sparse'");
+        else if (numMappings > 0 && mappings == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot update tile mappings with <mappings> parameter being a null pointer");
+        else
+        {
+            for_range(i, numMappings)
+                ValidateTextureTileMapping(textureDbg, mappings[i]);
+        }
+    }
+
+    instance.UpdateTileMappings(textureDbg.instance, numMappings, mappings);
+}
+
+void DbgCommandQueue::UpdateTileMappings(Buffer& buffer, std::uint32_t numMappings, const BufferTileMapping* mappings)
+{
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if ((bufferDbg.desc.miscFlags & MiscFlags::Sparse) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot update tile mappings of buffer that was not created with 'LLGL::MiscFlags::Sparse'");
+        else if (numMappings > 0 && mappings == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot update tile mappings with <mappings> parameter being a null pointer");
+        else
+        {
+            for_range(i, numMappings)
+                ValidateBufferTileMapping(bufferDbg, mappings[i]);
+        }
+    }
+
+    instance.UpdateTileMappings(bufferDbg.instance, numMappings, mappings);
 }
 
 /* ----- Queries ----- */
@@ -64,23 +192,88 @@ bool DbgCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery
     return instance.QueryResult(queryHeapDbg.instance, firstQuery, numQueries, data, dataSize);
 }
 
+bool DbgCommandQueue::QueryFrameCounters(FrameProfile& outProfile)
+{
+    return instance.QueryFrameCounters(outProfile);
+}
+
+bool DbgCommandQueue::GetCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    return instance.GetCalibratedTimestamps(outTimestamps);
+}
+
 /* ----- Fences ----- */
 
 void DbgCommandQueue::Submit(Fence& fence)
 {
     instance.Submit(fence);
+    if (DbgIsPerformanceLintEnabled(debugger_))
+        fenceSubmissions_[&fence] = submissionCounter_;
+    if (profiler_)
+        profiler_->frameProfile.fenceSubmissions++;
+}
+
+void DbgCommandQueue::Submit(Fence& fence, std::uint64_t value)
+{
+    instance.Submit(fence, value);
+    if (DbgIsPerformanceLintEnabled(debugger_))
+        fenceSubmissions_[&fence] = submissionCounter_;
     if (profiler_)
         profiler_->frameProfile.fenceSubmissions++;
 }
 
+void DbgCommandQueue::SubmitWait(Fence& fence, std::uint64_t value)
+{
+    instance.SubmitWait(fence, value);
+}
+
+// Returns the last submission before the specified fence was signaled, or 0 if it was never signaled by this queue.
+static std::uint64_t FindFenceSubmission(const std::map<const Fence*, std::uint64_t>& fenceSubmissions, const Fence& fence)
+{
+    auto it = fenceSubmissions.find(&fence);
+    return (it != fenceSubmissions.end() ? it->second : 0);
+}
+
 bool DbgCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
-    return instance.WaitFence(fence, timeout);
+    const bool result = instance.WaitFence(fence, timeout);
+    if (result)
+        completedSubmission_ = std::max(completedSubmission_, FindFenceSubmission(fenceSubmissions_, fence));
+    return result;
+}
+
+bool DbgCommandQueue::WaitFence(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    const bool result = instance.WaitFence(fence, value, timeout);
+    if (result)
+        completedSubmission_ = std::max(completedSubmission_, FindFenceSubmission(fenceSubmissions_, fence));
+    return result;
 }
 
 void DbgCommandQueue::WaitIdle()
 {
     instance.WaitIdle();
+    completedSubmission_ = submissionCounter_;
+}
+
+/* ----- Performance lints ----- */
+
+void DbgCommandQueue::RecordBufferWrites(const std::vector<DbgBuffer*>& buffers)
+{
+    if (buffers.empty())
+        return;
+
+    const std::uint64_t submission = ++submissionCounter_;
+    for (DbgBuffer* bufferDbg : buffers)
+    {
+        bufferDbg->pendingQueue         = this;
+        bufferDbg->pendingSubmission    = submission;
+    }
+}
+
+bool DbgCommandQueue::IsBufferWritePending(const DbgBuffer& bufferDbg) const
+{
+    return (bufferDbg.pendingQueue == this && bufferDbg.pendingSubmission > completedSubmission_);
 }
 
 
@@ -88,6 +281,70 @@ void DbgCommandQueue::WaitIdle()
  * ======= Private: =======
  */
 
+void DbgCommandQueue::ValidateTextureTileMapping(DbgTexture& textureDbg, const TextureTileMapping& mapping)
+{
+    const TextureRegion& region = mapping.region;
+
+    /* Validate MIP-map level and array layer range */
+    if (region.subresource.baseMipLevel >= textureDbg.mipLevels)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "invalid tile mapping with MIP-map level " + std::to_string(region.subresource.baseMipLevel) +
+            " for texture with " + std::to_string(textureDbg.mipLevels) + " MIP-maps"
+        );
+        return;
+    }
+
+    if (region.subresource.numArrayLayers == 0 ||
+        region.subresource.baseArrayLayer + region.subresource.numArrayLayers > textureDbg.desc.arrayLayers)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "invalid tile mapping with array range [" + std::to_string(region.subresource.baseArrayLayer) +
+            ", +" + std::to_string(region.subresource.numArrayLayers) +
+            ") for texture with " + std::to_string(textureDbg.desc.arrayLayers) + " layers"
+        );
+    }
+
+    /* Validate region is inside the bounds of the MIP-map level */
+    const Extent3D mipExtent = textureDbg.GetMipExtent(region.subresource.baseMipLevel);
+
+    if (region.offset.x < 0 || region.offset.y < 0 || region.offset.z < 0)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "invalid tile mapping with negative offset (" + std::to_string(region.offset.x) +
+            ", " + std::to_string(region.offset.y) + ", " + std::to_string(region.offset.z) + ")"
+        );
+    }
+    else if (static_cast<std::uint32_t>(region.offset.x) + region.extent.width  > mipExtent.width  ||
+             static_cast<std::uint32_t>(region.offset.y) + region.extent.height > mipExtent.height ||
+             static_cast<std::uint32_t>(region.offset.z) + region.extent.depth  > mipExtent.depth)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "invalid tile mapping with region out of bounds for MIP-level " + std::to_string(region.subresource.baseMipLevel)
+        );
+    }
+    else if (region.extent.width == 0 || region.extent.height == 0 || region.extent.depth == 0)
+        LLGL_DBG_WARN(WarningType::ImproperArgument, "tile mapping has no effect: texture region has zero extent");
+}
+
+void DbgCommandQueue::ValidateBufferTileMapping(DbgBuffer& bufferDbg, const BufferTileMapping& mapping)
+{
+    if (mapping.offset + mapping.size > bufferDbg.desc.size)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "invalid tile mapping with buffer range out of bounds: " + std::to_string(mapping.offset + mapping.size) +
+            " specified but limit is " + std::to_string(bufferDbg.desc.size)
+        );
+    }
+    else if (mapping.size == 0)
+        LLGL_DBG_WARN(WarningType::ImproperArgument, "tile mapping has no effect: buffer range has zero size");
+}
+
 void DbgCommandQueue::ValidateQueryResult(
     DbgQueryHeap&   queryHeap,
     std::uint32_t   firstQuery,
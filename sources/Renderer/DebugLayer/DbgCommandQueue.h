@@ -10,6 +10,9 @@
 
 
 #include <LLGL/CommandQueue.h>
+#include <map>
+#include <vector>
+#include <cstdint>
 
 
 namespace LLGL
@@ -19,6 +22,9 @@ namespace LLGL
 class RenderingProfiler;
 class RenderingDebugger;
 class DbgQueryHeap;
+class DbgTexture;
+class DbgBuffer;
+class DbgCapture;
 
 class DbgCommandQueue final : public CommandQueue
 {
@@ -27,20 +33,36 @@ class DbgCommandQueue final : public CommandQueue
 
         #include <LLGL/Backend/CommandQueue.inl>
 
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers) override;
+
+        void Present(std::uint32_t numSwapChains, SwapChain* const * swapChains) override;
+
     public:
 
         DbgCommandQueue(
             CommandQueue&       instance,
             RenderingProfiler*  profiler,
-            RenderingDebugger*  debugger
+            RenderingDebugger*  debugger,
+            DbgCapture*         capture
         );
 
     public:
 
         CommandQueue& instance;
 
+    public:
+
+        // Marks the specified buffers as written by a new submission of this queue.
+        void RecordBufferWrites(const std::vector<DbgBuffer*>& buffers);
+
+        // Returns true if the specified buffer was written by a submission that is not known to be completed yet.
+        bool IsBufferWritePending(const DbgBuffer& bufferDbg) const;
+
     private:
 
+        void ValidateTextureTileMapping(DbgTexture& textureDbg, const TextureTileMapping& mapping);
+        void ValidateBufferTileMapping(DbgBuffer& bufferDbg, const BufferTileMapping& mapping);
+
         void ValidateQueryResult(
             DbgQueryHeap&   queryHeap,
             std::uint32_t   firstQuery,
@@ -51,8 +73,13 @@ class DbgCommandQueue final : public CommandQueue
 
     private:
 
-        RenderingProfiler* profiler_ = nullptr;
-        RenderingDebugger* debugger_ = nullptr;
+        RenderingProfiler*                      profiler_               = nullptr;
+        RenderingDebugger*                      debugger_               = nullptr;
+        DbgCapture*                             capture_                = nullptr;
+
+        std::uint64_t                           submissionCounter_      = 0;
+        std::uint64_t                           completedSubmission_    = 0; // Last submission that is known to be completed by WaitIdle or WaitFence
+        std::map<const Fence*, std::uint64_t>   fenceSubmissions_;           // Last submission before each fence was signaled
 
 };
 
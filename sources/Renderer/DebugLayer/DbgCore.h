@@ -32,6 +32,9 @@ namespace LLGL
 #define LLGL_DBG_ERROR_NOT_SUPPORTED(FEATURE) \
     LLGL_DBG_ERROR(ErrorType::UnsupportedFeature, UTF8String(FEATURE) + " not supported")
 
+#define LLGL_DBG_LINT(LINT, MESSAGE) \
+    DbgPostPerformanceLint(debugger_, (LINT), (MESSAGE))
+
 
 inline void DbgSetSource(RenderingDebugger* debugger, const char* source)
 {
@@ -51,6 +54,18 @@ inline void DbgPostWarning(RenderingDebugger* debugger, WarningType type, const
         debugger->PostWarning(type, message);
 }
 
+inline void DbgPostPerformanceLint(RenderingDebugger* debugger, PerformanceLint lint, const StringView& message)
+{
+    if (debugger)
+        debugger->PostPerformanceLint(lint, message);
+}
+
+// Returns true if the specified debugger is not null and has performance lints enabled.
+inline bool DbgIsPerformanceLintEnabled(const RenderingDebugger* debugger)
+{
+    return (debugger != nullptr && debugger->IsPerformanceLintEnabled());
+}
+
 // Sets the name of the specified debug layer object.
 template <typename T>
 inline void DbgSetObjectName(T& obj, const char* name)
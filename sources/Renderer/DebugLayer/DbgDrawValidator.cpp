@@ -0,0 +1,325 @@
+/*
+ * DbgDrawValidator.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "DbgDrawValidator.h"
+#include "DbgCore.h"
+#include "Buffer/DbgBuffer.h"
+#include "Shader/DbgShader.h"
+#include "RenderState/DbgPipelineState.h"
+#include "RenderState/DbgPipelineLayout.h"
+#include "../../Core/Assertion.h"
+#include <LLGL/Utils/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+DbgDrawValidator::DbgDrawValidator(RenderingDebugger* debugger) :
+    debugger_ { debugger }
+{
+}
+
+void DbgDrawValidator::Validate(const DbgDrawRecord& record, DbgBuffer* const * vertexBuffers, Resource* const * resources)
+{
+    source_     = nullptr;
+    groupName_  = nullptr;
+    ValidateRecord(record, vertexBuffers, resources);
+}
+
+void DbgDrawValidator::ValidateInContext(const DbgDrawRecord& record, DbgBuffer* const * vertexBuffers, Resource* const * resources, const char* groupName)
+{
+    source_     = (record.source != nullptr ? record.source : "");
+    groupName_  = (groupName != nullptr ? groupName : "");
+    ValidateRecord(record, vertexBuffers, resources);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void DbgDrawValidator::ValidateRecord(const DbgDrawRecord& record, DbgBuffer* const * vertexBuffers, Resource* const * resources)
+{
+    /* Run checks in the same order as they were run by the command buffer, so reports are identical for both synchronous and asynchronous validation */
+    if ((record.flags & DbgDrawValidation::DynamicStates) != 0)
+        ValidateDynamicStates(record);
+    if ((record.flags & DbgDrawValidation::VertexLayout) != 0)
+        ValidateVertexLayout(record, vertexBuffers);
+    if ((record.flags & DbgDrawValidation::Vertices) != 0)
+    {
+        ValidateNumVertices(record.topology, record.numVertices);
+        ValidateNumInstances(record.numInstances);
+    }
+    if ((record.flags & DbgDrawValidation::VertexID) != 0)
+        ValidateVertexID(record.vertexShader, record.firstVertex);
+    if ((record.flags & DbgDrawValidation::InstanceID) != 0)
+        ValidateInstanceID(record.vertexShader, record.firstInstance);
+    if ((record.flags & DbgDrawValidation::BindingTable) != 0 && record.pipelineState != nullptr)
+        ValidateBindingTable(*record.pipelineState, resources + record.firstResource, record.numResources);
+    if ((record.flags & DbgDrawValidation::Vertices) != 0)
+        ValidateVertexLimit(record.vertexCount, record.vertexLimit);
+}
+
+void DbgDrawValidator::ValidateDynamicStates(const DbgDrawRecord& record)
+{
+    if (!record.blendFactorSet)
+    {
+        PostError(
+            ErrorType::InvalidState,
+            "blend factor is not set; missing call to <LLGL::CommandBuffer::SetBlendFactor>"
+            " or PSO must be created with 'LLGL::BlendDescriptor::blendFactorDynamic' being disabled"
+        );
+    }
+    if (!record.stencilRefSet)
+    {
+        PostError(
+            ErrorType::InvalidState,
+            "stencil reference blend factor is not set; missing call to <LLGL::CommandBuffer::SetStencilReference>"
+            " or PSO must be created with 'LLGL::StencilDescriptor::referenceDynamic' being disabled"
+        );
+    }
+}
+
+void DbgDrawValidator::ValidateVertexLayout(const DbgDrawRecord& record, DbgBuffer* const * vertexBuffers)
+{
+    if (auto pso = record.pipelineState)
+    {
+        if (pso->isGraphicsPSO && record.numVertexBuffers > 0)
+        {
+            if (auto vertexShader = pso->graphicsDesc.vertexShader)
+            {
+                auto vertexShaderDbg = LLGL_CAST(const DbgShader*, vertexShader);
+                const auto& inputAttribs = vertexShaderDbg->desc.vertex.inputAttribs;
+                if (!inputAttribs.empty())
+                    ValidateVertexLayoutAttributes(inputAttribs, vertexBuffers + record.firstVertexBuffer, record.numVertexBuffers);
+            }
+        }
+    }
+}
+
+void DbgDrawValidator::ValidateVertexLayoutAttributes(const ArrayView<VertexAttribute>& shaderVertexAttribs, DbgBuffer* const * vertexBuffers, std::uint32_t numVertexBuffers)
+{
+    /* Check if all vertex attributes are served by active vertex buffer(s) */
+    std::size_t attribIndex = 0;
+
+    for (std::uint32_t bufferIndex = 0; attribIndex < shaderVertexAttribs.size() && bufferIndex < numVertexBuffers; ++bufferIndex)
+    {
+        /* Compare remaining shader attributes with next vertex buffer attributes */
+        const auto& bufferVertexAttribs = vertexBuffers[bufferIndex]->desc.vertexAttribs;
+
+        for (std::size_t i = 0; i < bufferVertexAttribs.size() && attribIndex < shaderVertexAttribs.size(); ++i, ++attribIndex)
+        {
+            /* Compare current vertex attributes */
+            const auto& attribLhs = shaderVertexAttribs[attribIndex];
+            const auto& attribRhs = bufferVertexAttribs[i];
+
+            if (attribLhs != attribRhs)
+                PostError(ErrorType::InvalidState, "vertex layout mismatch between shader program and vertex buffer(s)");
+        }
+    }
+
+    if (attribIndex < shaderVertexAttribs.size())
+        PostError(ErrorType::InvalidState, "not all vertex attributes in the shader pipeline are covered by the bound vertex buffer(s)");
+}
+
+void DbgDrawValidator::ValidateNumVertices(PrimitiveTopology topology, std::uint32_t numVertices)
+{
+    if (numVertices == 0)
+        PostWarning(WarningType::PointlessOperation, "no vertices will be generated");
+
+    switch (topology)
+    {
+        case PrimitiveTopology::PointList:
+            break;
+
+        case PrimitiveTopology::LineList:
+            if (numVertices % 2 != 0)
+                WarnImproperVertices("line list", (numVertices % 2));
+            break;
+
+        case PrimitiveTopology::LineStrip:
+            if (numVertices < 2)
+                WarnImproperVertices("line strip", numVertices);
+            break;
+
+        case PrimitiveTopology::LineListAdjacency:
+            if (numVertices % 2 != 0)
+                WarnImproperVertices("line list adjacency", (numVertices % 2));
+            break;
+
+        case PrimitiveTopology::LineStripAdjacency:
+            if (numVertices < 2)
+                WarnImproperVertices("line strip adjacency", numVertices);
+            break;
+
+        case PrimitiveTopology::TriangleList:
+            if (numVertices % 3 != 0)
+                WarnImproperVertices("triangle list", (numVertices % 3));
+            break;
+
+        case PrimitiveTopology::TriangleStrip:
+            if (numVertices < 3)
+                WarnImproperVertices("triangle strip", numVertices);
+            break;
+
+        case PrimitiveTopology::TriangleListAdjacency:
+            if (numVertices % 3 != 0)
+                WarnImproperVertices("triangle list adjacency", (numVertices % 3));
+            break;
+
+        case PrimitiveTopology::TriangleStripAdjacency:
+            if (numVertices < 3)
+                WarnImproperVertices("triangle strip adjacency", numVertices);
+            break;
+
+        default:
+            if (topology >= PrimitiveTopology::Patches1 && topology <= PrimitiveTopology::Patches32)
+            {
+                auto numPatchVertices = static_cast<std::uint32_t>(topology) - static_cast<std::uint32_t>(PrimitiveTopology::Patches1) + 1;
+                if (numVertices % numPatchVertices != 0)
+                    WarnImproperVertices("patches" + std::to_string(numPatchVertices), (numVertices % numPatchVertices));
+            }
+            break;
+    }
+}
+
+void DbgDrawValidator::ValidateNumInstances(std::uint32_t numInstances)
+{
+    if (numInstances == 0)
+        PostWarning(WarningType::PointlessOperation, "no instances will be generated");
+}
+
+void DbgDrawValidator::ValidateVertexID(const DbgShader* vertexShaderDbg, std::uint32_t firstVertex)
+{
+    if (firstVertex > 0 && vertexShaderDbg != nullptr)
+    {
+        if (auto vertexID = vertexShaderDbg->GetVertexID())
+        {
+            PostWarning(
+                WarningType::VaryingBehavior,
+                "bound shader program uses '" + std::string(vertexID) + "' while firstVertex > 0, which may result in varying behavior between different native APIs"
+            );
+        }
+    }
+}
+
+void DbgDrawValidator::ValidateInstanceID(const DbgShader* vertexShaderDbg, std::uint32_t firstInstance)
+{
+    if (firstInstance > 0 && vertexShaderDbg != nullptr)
+    {
+        if (auto instanceID = vertexShaderDbg->GetInstanceID())
+        {
+            PostWarning(
+                WarningType::VaryingBehavior,
+                "bound shader program uses '" + std::string(instanceID) + "' while firstInstance > 0, which may result in varying behavior between different native APIs"
+            );
+        }
+    }
+}
+
+// Returns a descriptive string for the specified binding
+static std::string GetBindingDescStr(const BindingDescriptor& binding)
+{
+    std::string s;
+
+    s = "slot ";
+    s += std::to_string(binding.slot.index);
+
+    if (binding.slot.set != 0)
+    {
+        s += ", set ";
+        s += std::to_string(binding.slot.set);
+    }
+
+    if (!binding.name.empty())
+    {
+        s += ", name '";
+        s += binding.name;
+        s += "'";
+    }
+
+    return s;
+}
+
+static std::string GetPipelineBindingDescStr(const DbgPipelineState& pso, const PipelineLayoutDescriptor& layoutDesc, std::size_t bindingIndex)
+{
+    std::string s;
+
+    s = "missing descriptor [";
+    s += std::to_string(bindingIndex);
+    s += "] in pipeline state ";
+    if (!pso.label.empty())
+    {
+        s += "'";
+        s += pso.label;
+        s += "' ";
+    }
+    s += "for binding (";
+    s += GetBindingDescStr(layoutDesc.bindings[bindingIndex]);
+    s += ")";
+
+    return s;
+}
+
+void DbgDrawValidator::ValidateBindingTable(const DbgPipelineState& pso, Resource* const * resources, std::size_t numResources)
+{
+    if (auto pipelineLayout = pso.pipelineLayout)
+    {
+        const PipelineLayoutDescriptor& layoutDesc = pipelineLayout->desc;
+        LLGL_ASSERT(numResources == layoutDesc.bindings.size());
+        for_range(i, numResources)
+        {
+            if (resources[i] == nullptr)
+                PostError(ErrorType::InvalidState, GetPipelineBindingDescStr(pso, layoutDesc, i));
+        }
+    }
+}
+
+void DbgDrawValidator::ValidateVertexLimit(std::uint32_t vertexCount, std::uint32_t vertexLimit)
+{
+    if (vertexCount > vertexLimit)
+    {
+        PostError(
+            ErrorType::InvalidArgument,
+            "vertex count out of bounds: " + std::to_string(vertexCount) +
+            " specified but limit is " + std::to_string(vertexLimit)
+        );
+    }
+}
+
+void DbgDrawValidator::WarnImproperVertices(const std::string& topologyName, std::uint32_t unusedVertices)
+{
+    PostWarning(
+        WarningType::ImproperArgument,
+        "improper number of vertices for " + topologyName + " (" + std::to_string(unusedVertices) +
+        " unused " + std::string(unusedVertices > 1 ? "vertices" : "vertex") + ")"
+    );
+}
+
+void DbgDrawValidator::PostError(const ErrorType type, const StringView& message)
+{
+    if (source_ != nullptr)
+        debugger_->PostErrorInContext(type, message, source_, groupName_);
+    else
+        debugger_->PostError(type, message);
+}
+
+void DbgDrawValidator::PostWarning(const WarningType type, const StringView& message)
+{
+    if (source_ != nullptr)
+        debugger_->PostWarningInContext(type, message, source_, groupName_);
+    else
+        debugger_->PostWarning(type, message);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
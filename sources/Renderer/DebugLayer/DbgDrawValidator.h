@@ -0,0 +1,123 @@
+/*
+ * DbgDrawValidator.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_DBG_DRAW_VALIDATOR_H
+#define LLGL_DBG_DRAW_VALIDATOR_H
+
+
+#include <LLGL/RenderingDebugger.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/VertexAttribute.h>
+#include <LLGL/Container/ArrayView.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+class Resource;
+class DbgBuffer;
+class DbgShader;
+class DbgPipelineState;
+
+// Draw and dispatch validation flags, i.e. which checks of a DbgDrawRecord are performed.
+struct DbgDrawValidation
+{
+    enum
+    {
+        DynamicStates   = (1 << 0), // Blend factor and stencil reference must be set if the PSO has them as dynamic states.
+        VertexLayout    = (1 << 1), // Bound vertex buffers must cover the vertex attributes of the vertex shader.
+        Vertices        = (1 << 2), // Number of vertices and instances must fit the topology and vertex limit.
+        VertexID        = (1 << 3), // Vertex ID must not be used with an offset of the first vertex.
+        InstanceID      = (1 << 4), // Instance ID must not be used with an offset of the first instance.
+        BindingTable    = (1 << 5), // All bindings of the pipeline layout must be set.
+    };
+};
+
+/*
+Snapshot of the bindings and parameters a draw or dispatch command is validated against.
+Vertex buffers and resources are referenced by their range in the arrays that are passed to DbgDrawValidator::Validate,
+so the record stays valid when it is copied into a DbgValidationLog.
+*/
+struct DbgDrawRecord
+{
+    const char*             source              = nullptr;  // Function name of the command, e.g. "LLGL::DbgCommandBuffer::Draw"
+    std::uint32_t           debugGroup          = 0;        // Index of the debug group in the validation log plus one, or 0 if no debug group is active
+    long                    flags               = 0;        // Bitwise OR combination of DbgDrawValidation entries
+    PrimitiveTopology       topology            = PrimitiveTopology::TriangleList;
+    const DbgPipelineState* pipelineState       = nullptr;
+    const DbgShader*        vertexShader        = nullptr;
+    bool                    blendFactorSet      = false;
+    bool                    stencilRefSet       = false;
+    std::size_t             firstVertexBuffer   = 0;
+    std::uint32_t           numVertexBuffers    = 0;
+    std::size_t             firstResource       = 0;
+    std::size_t             numResources        = 0;
+    std::uint32_t           numVertices         = 0;
+    std::uint32_t           firstVertex         = 0;
+    std::uint32_t           numInstances        = 0;
+    std::uint32_t           firstInstance       = 0;
+    std::uint32_t           vertexCount         = 0;        // Number of vertices or indices including the first one
+    std::uint32_t           vertexLimit         = UINT32_MAX;
+};
+
+/*
+Validates draw and dispatch commands from their DbgDrawRecord snapshot.
+This is used by DbgCommandBuffer to validate commands while they are encoded and by DbgValidationWorker to validate them asynchronously.
+*/
+class DbgDrawValidator
+{
+
+    public:
+
+        explicit DbgDrawValidator(RenderingDebugger* debugger);
+
+        // Validates the specified record and posts reports with the current source and debug group of the debugger.
+        void Validate(const DbgDrawRecord& record, DbgBuffer* const * vertexBuffers, Resource* const * resources);
+
+        // Validates the specified record and posts reports with its source and the specified debug group. Used when the record is validated asynchronously.
+        void ValidateInContext(const DbgDrawRecord& record, DbgBuffer* const * vertexBuffers, Resource* const * resources, const char* groupName);
+
+    private:
+
+        void ValidateRecord(const DbgDrawRecord& record, DbgBuffer* const * vertexBuffers, Resource* const * resources);
+
+        void ValidateDynamicStates(const DbgDrawRecord& record);
+        void ValidateVertexLayout(const DbgDrawRecord& record, DbgBuffer* const * vertexBuffers);
+        void ValidateVertexLayoutAttributes(const ArrayView<VertexAttribute>& shaderVertexAttribs, DbgBuffer* const * vertexBuffers, std::uint32_t numVertexBuffers);
+        void ValidateNumVertices(PrimitiveTopology topology, std::uint32_t numVertices);
+        void ValidateNumInstances(std::uint32_t numInstances);
+        void ValidateVertexID(const DbgShader* vertexShaderDbg, std::uint32_t firstVertex);
+        void ValidateInstanceID(const DbgShader* vertexShaderDbg, std::uint32_t firstInstance);
+        void ValidateBindingTable(const DbgPipelineState& pso, Resource* const * resources, std::size_t numResources);
+        void ValidateVertexLimit(std::uint32_t vertexCount, std::uint32_t vertexLimit);
+
+        void WarnImproperVertices(const std::string& topologyName, std::uint32_t unusedVertices);
+
+        void PostError(const ErrorType type, const StringView& message);
+        void PostWarning(const WarningType type, const StringView& message);
+
+    private:
+
+        RenderingDebugger*  debugger_   = nullptr;
+        const char*         source_     = nullptr;  // Context to post reports with, or null to use the current context of the debugger
+        const char*         groupName_  = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -11,6 +11,7 @@
 #include <LLGL/CommandQueue.h>
 #include <LLGL/QueryHeap.h>
 #include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 #include <thread>
 
 
@@ -20,6 +21,9 @@ namespace LLGL
 
 static constexpr std::uint32_t g_queryTimerHeapSize = 64;
 
+// Maximum number of batches that are waiting for their query results. Older batches are resolved by waiting for the GPU.
+static constexpr std::size_t g_maxPendingTimerBatches = 3;
+
 DbgQueryTimerManager::DbgQueryTimerManager(
     RenderSystem&   renderSystemInstance,
     CommandQueue&   commandQueueInstance,
@@ -31,58 +35,98 @@ DbgQueryTimerManager::DbgQueryTimerManager(
 {
 }
 
-void DbgQueryTimerManager::Reset()
+DbgQueryTimerManager::~DbgQueryTimerManager()
 {
-    records_.clear();
-    currentQuery_       = 0;
-    currentQueryHeap_   = 0;
+    for (Batch& batch : pendingBatches_)
+        freeQueryHeaps_.insert(freeQueryHeaps_.end(), batch.queryHeaps.begin(), batch.queryHeaps.end());
+    freeQueryHeaps_.insert(freeQueryHeaps_.end(), currentBatch_.queryHeaps.begin(), currentBatch_.queryHeaps.end());
+    for (QueryHeap* queryHeap : freeQueryHeaps_)
+        renderSystem_.Release(*queryHeap);
+}
+
+void DbgQueryTimerManager::Begin()
+{
+    /* Schedule previous batch if the command buffer is encoded again without End() */
+    if (!currentBatch_.records.empty())
+        End();
+}
+
+void DbgQueryTimerManager::End()
+{
+    if (!currentBatch_.records.empty())
+    {
+        pendingBatches_.push_back(std::move(currentBatch_));
+        currentBatch_ = Batch{};
+    }
 }
 
 void DbgQueryTimerManager::Start(const char* annotation)
 {
+    const std::uint32_t query       = static_cast<std::uint32_t>(currentBatch_.records.size());
+    const std::uint32_t heapIndex   = query / g_queryTimerHeapSize;
+
     /* Store annotation only first */
     ProfileTimeRecord record;
     {
         record.annotation   = annotation;
         record.elapsedTime  = 0;
     }
-    records_.push_back(record);
+    currentBatch_.records.push_back(record);
 
-    /* Check if end of query heap has been reached */
-    if (currentQuery_ == g_queryTimerHeapSize)
+    /* Take query heap from free list or create a new one */
+    if (heapIndex == currentBatch_.queryHeaps.size())
     {
-        currentQuery_ = 0;
-        ++currentQueryHeap_;
-    }
-
-    /* Check if new query heap must be created */
-    if (currentQueryHeap_ == queryHeaps_.size())
-    {
-        QueryHeapDescriptor queryDesc;
+        if (!freeQueryHeaps_.empty())
         {
-            queryDesc.type          = QueryType::TimeElapsed;
-            queryDesc.numQueries    = g_queryTimerHeapSize;
+            currentBatch_.queryHeaps.push_back(freeQueryHeaps_.back());
+            freeQueryHeaps_.pop_back();
+        }
+        else
+        {
+            QueryHeapDescriptor queryDesc;
+            {
+                queryDesc.type          = QueryType::TimeElapsed;
+                queryDesc.numQueries    = g_queryTimerHeapSize;
+            }
+            currentBatch_.queryHeaps.push_back(renderSystem_.CreateQueryHeap(queryDesc));
         }
-        queryHeaps_.push_back(renderSystem_.CreateQueryHeap(queryDesc));
     }
 
     /* Begin timer query */
-    commandBuffer_.BeginQuery(*queryHeaps_[currentQueryHeap_], currentQuery_);
+    commandBuffer_.BeginQuery(*currentBatch_.queryHeaps[heapIndex], query % g_queryTimerHeapSize);
 }
 
 void DbgQueryTimerManager::Stop()
 {
     /* Stop timer query */
-    commandBuffer_.EndQuery(*queryHeaps_[currentQueryHeap_], currentQuery_);
-
-    /* Increase query index */
-    ++currentQuery_;
+    const std::uint32_t query = static_cast<std::uint32_t>(currentBatch_.records.size()) - 1;
+    commandBuffer_.EndQuery(*currentBatch_.queryHeaps[query / g_queryTimerHeapSize], query % g_queryTimerHeapSize);
 }
 
 void DbgQueryTimerManager::TakeRecords(std::vector<ProfileTimeRecord>& outRecords)
 {
-    ResolveQueryResults();
-    outRecords = std::move(records_);
+    constexpr int maxAttempts = 100;
+
+    /* Resolve pending batches in order until the first batch that is not available yet */
+    while (!pendingBatches_.empty())
+    {
+        Batch& batch = pendingBatches_.front();
+        if (!ResolveBatch(batch))
+        {
+            if (pendingBatches_.size() <= g_maxPendingTimerBatches)
+                break;
+
+            /* Wait for results of the oldest batch to bound the latency; deliver the batch with incomplete times if they are still unavailable */
+            for_range(attempt, maxAttempts)
+            {
+                std::this_thread::yield();
+                if (ResolveBatch(batch))
+                    break;
+            }
+        }
+        ReleaseBatch(batch, outRecords);
+        pendingBatches_.pop_front();
+    }
 }
 
 
@@ -90,24 +134,30 @@ void DbgQueryTimerManager::TakeRecords(std::vector<ProfileTimeRecord>& outRecord
  * ======= Private: =======
  */
 
-void DbgQueryTimerManager::ResolveQueryResults()
+bool DbgQueryTimerManager::ResolveBatch(Batch& batch)
 {
-    constexpr int maxAttempts = 100;
+    /* Query all timer values of this batch with one call per query heap */
+    const std::uint32_t numRecords = static_cast<std::uint32_t>(batch.records.size());
+    std::vector<std::uint64_t> results(numRecords, 0);
 
-    for_range(i, records_.size())
+    for_range(heapIndex, static_cast<std::uint32_t>(batch.queryHeaps.size()))
     {
-        auto&   rec         = records_[i];
-        auto    query       = static_cast<std::uint32_t>(i % g_queryTimerHeapSize);
-        auto    queryHeap   = static_cast<std::uint32_t>(i / g_queryTimerHeapSize);
-
-        for_range(i, maxAttempts)
-        {
-            if (!commandQueue_.QueryResult(*queryHeaps_[queryHeap], query, 1, &(rec.elapsedTime), sizeof(rec.elapsedTime)))
-                std::this_thread::yield();
-            else
-                break;
-        }
+        const std::uint32_t firstQuery  = heapIndex * g_queryTimerHeapSize;
+        const std::uint32_t numQueries  = std::min(g_queryTimerHeapSize, numRecords - firstQuery);
+        if (!commandQueue_.QueryResult(*batch.queryHeaps[heapIndex], 0, numQueries, &results[firstQuery], numQueries * sizeof(std::uint64_t)))
+            return false;
     }
+
+    for_range(i, numRecords)
+        batch.records[i].elapsedTime = results[i];
+
+    return true;
+}
+
+void DbgQueryTimerManager::ReleaseBatch(Batch& batch, std::vector<ProfileTimeRecord>& outRecords)
+{
+    outRecords.insert(outRecords.end(), batch.records.begin(), batch.records.end());
+    freeQueryHeaps_.insert(freeQueryHeaps_.end(), batch.queryHeaps.begin(), batch.queryHeaps.end());
 }
 
 
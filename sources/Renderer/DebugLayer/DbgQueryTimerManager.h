@@ -12,12 +12,19 @@
 #include <LLGL/ForwardDecls.h>
 #include <LLGL/RenderingProfiler.h>
 #include <vector>
+#include <deque>
 
 
 namespace LLGL
 {
 
 
+/*
+Records the elapsed GPU time of individual commands with one timer query per command.
+The records of each command buffer encoding form a batch that is resolved without stalling the CPU once the GPU has finished it.
+Only when more than a fixed number of batches are pending, the oldest one is resolved by waiting for its results,
+i.e. the time records of submission k are delivered at submission k+N at the latest. Query heaps are recycled after their batch has been resolved.
+*/
 //TODO: rename to DbgQueryTimerPool
 class DbgQueryTimerManager
 {
@@ -29,9 +36,16 @@ class DbgQueryTimerManager
             CommandQueue&   commandQueueInstance,
             CommandBuffer&  commandBufferInstance
         );
+        ~DbgQueryTimerManager();
+
+        DbgQueryTimerManager(const DbgQueryTimerManager&) = delete;
+        DbgQueryTimerManager& operator = (const DbgQueryTimerManager&) = delete;
 
-        // Resets all records in this timer manager.
-        void Reset();
+        // Starts a new batch of time records for the next command buffer encoding.
+        void Begin();
+
+        // Schedules the current batch to be resolved.
+        void End();
 
         // Starts measuring the time with the specified annotation.
         void Start(const char* annotation);
@@ -39,13 +53,24 @@ class DbgQueryTimerManager
         // Stops measing the time and stores the current record.
         void Stop();
 
-        // Moves the internal records to the specified output container.
+        // Appends the records of all resolved batches to the specified output container.
         void TakeRecords(std::vector<ProfileTimeRecord>& outRecords);
 
     private:
 
-        // Resolves all timer values into the output records.
-        void ResolveQueryResults();
+        struct Batch
+        {
+            std::vector<ProfileTimeRecord>  records;
+            std::vector<QueryHeap*>         queryHeaps;
+        };
+
+    private:
+
+        // Tries to resolve all timer values of the specified batch. Returns false if not all query results are available yet.
+        bool ResolveBatch(Batch& batch);
+
+        // Moves the records of the specified batch into the output container and recycles its query heaps.
+        void ReleaseBatch(Batch& batch, std::vector<ProfileTimeRecord>& outRecords);
 
     private:
 
@@ -53,11 +78,10 @@ class DbgQueryTimerManager
         CommandQueue&                   commandQueue_;
         CommandBuffer&                  commandBuffer_;
 
-        std::vector<QueryHeap*>         queryHeaps_;
-        std::uint32_t                   currentQuery_       = 0;
-        std::uint32_t                   currentQueryHeap_   = 0;
+        std::vector<QueryHeap*>         freeQueryHeaps_;
 
-        std::vector<ProfileTimeRecord>  records_;
+        Batch                           currentBatch_;
+        std::deque<Batch>               pendingBatches_;
 
 };
 
@@ -9,8 +9,10 @@
 #include "DbgCore.h"
 #include "../BufferUtils.h"
 #include "../TextureUtils.h"
+#include "../FileLoadUtils.h"
 #include "../CheckedCast.h"
 #include "../RenderTargetUtils.h"
+#include "../RenderPassUtils.h"
 #include "../../Core/CoreUtils.h"
 #include "../../Core/StringUtils.h"
 #include <LLGL/ImageFlags.h>
@@ -42,6 +44,14 @@ DbgRenderSystem::DbgRenderSystem(RenderSystemPtr&& instance, RenderingProfiler*
 {
     /* Initialize rendering capabilities from wrapped instance */
     UpdateRenderingCaps();
+
+    /* Captures can only be requested via the debugger */
+    if (debugger_ != nullptr)
+        capture_ = MakeUnique<DbgCapture>(*instance_, *debugger_);
+
+    /* Worker thread is only started once a command buffer is validated with DebugValidationLevel::Asynchronous */
+    if (debugger_ != nullptr)
+        validationWorker_ = MakeUnique<DbgValidationWorker>(*debugger_);
 }
 
 /* ----- Swap-chain ----- */
@@ -55,10 +65,15 @@ SwapChain* DbgRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChain
     if (!commandQueue_)
     {
         UpdateRenderingCaps();
-        commandQueue_ = MakeUnique<DbgCommandQueue>(*(instance_->GetCommandQueue()), profiler_, debugger_);
+        commandQueue_ = MakeUnique<DbgCommandQueue>(*(instance_->GetCommandQueue()), profiler_, debugger_, capture_.get());
     }
 
-    return swapChains_.emplace<DbgSwapChain>(*swapChainInstance, swapChainDesc);
+    auto* swapChainDbg = swapChains_.emplace<DbgSwapChain>(*swapChainInstance, swapChainDesc, debugger_, capture_.get());
+
+    if (capture_)
+        capture_->RegisterSwapChain(*swapChainDbg);
+
+    return swapChainDbg;
 }
 
 void DbgRenderSystem::Release(SwapChain& swapChain)
@@ -68,9 +83,25 @@ void DbgRenderSystem::Release(SwapChain& swapChain)
 
 /* ----- Command queues ----- */
 
-CommandQueue* DbgRenderSystem::GetCommandQueue()
+CommandQueue* DbgRenderSystem::GetCommandQueue(const CommandQueueType type)
 {
-    return commandQueue_.get();
+    if (!commandQueue_ || type == CommandQueueType::Graphics)
+        return commandQueue_.get();
+
+    /* Share the wrapper between all queue types the backend maps onto the same command queue */
+    CommandQueue* queueInstance = instance_->GetCommandQueue(type);
+    if (queueInstance == &(commandQueue_->instance))
+        return commandQueue_.get();
+
+    HWObjectInstance<DbgCommandQueue>& queueDbg         = (type == CommandQueueType::Compute ? computeQueue_ : copyQueue_);
+    HWObjectInstance<DbgCommandQueue>& otherQueueDbg    = (type == CommandQueueType::Compute ? copyQueue_ : computeQueue_);
+    if (otherQueueDbg && queueInstance == &(otherQueueDbg->instance))
+        return otherQueueDbg.get();
+
+    if (!queueDbg)
+        queueDbg = MakeUnique<DbgCommandQueue>(*queueInstance, profiler_, debugger_, capture_.get());
+
+    return queueDbg.get();
 }
 
 /* ----- Command buffers ----- */
@@ -80,10 +111,13 @@ CommandBuffer* DbgRenderSystem::CreateCommandBuffer(const CommandBufferDescripto
     ValidateCommandBufferDesc(commandBufferDesc);
     return commandBuffers_.emplace<DbgCommandBuffer>(
         *instance_,
-        commandQueue_->instance,
+        *instance_->GetCommandQueue(commandBufferDesc.queueType),
+        LLGL_CAST(DbgCommandQueue*, GetCommandQueue(commandBufferDesc.queueType)),
         *instance_->CreateCommandBuffer(commandBufferDesc),
         debugger_,
         profiler_,
+        capture_.get(),
+        validationWorker_.get(),
         commandBufferDesc,
         GetRenderingCaps()
     );
@@ -116,6 +150,35 @@ Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const
     return bufferDbg;
 }
 
+void DbgRenderSystem::CreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, const void* const * initialData, Buffer** outBuffers)
+{
+    RenderSystem::AssertCreateBuffers(numBuffers, bufferDescs, outBuffers);
+
+    /* Validate and store format sizes (if supported) */
+    std::vector<std::uint32_t> formatSizes(numBuffers, 0);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        for_range(i, numBuffers)
+            ValidateBufferDesc(bufferDescs[i], &formatSizes[i]);
+    }
+
+    /* Create all buffer instances with a single batch, then wrap them into debug buffer objects */
+    instance_->CreateBuffers(numBuffers, bufferDescs, initialData, outBuffers);
+
+    for_range(i, numBuffers)
+    {
+        const BufferDescriptor& bufferDesc = bufferDescs[i];
+        auto* bufferDbg = buffers_.emplace<DbgBuffer>(*outBuffers[i], bufferDesc);
+        {
+            bufferDbg->elements     = (formatSizes[i] > 0 ? bufferDesc.size / formatSizes[i] : 0);
+            bufferDbg->initialized  = (initialData != nullptr && initialData[i] != nullptr);
+        }
+        outBuffers[i] = bufferDbg;
+    }
+}
+
 BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
     RenderSystem::AssertCreateBufferArray(numBuffers, bufferArray);
@@ -168,6 +231,9 @@ void DbgRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const vo
 
     instance_->WriteBuffer(bufferDbg.instance, offset, data, dataSize);
 
+    if (capture_)
+        capture_->RecordWriteBuffer(bufferDbg, offset, data, dataSize);
+
     if (profiler_)
         profiler_->frameProfile.bufferWrites++;
 }
@@ -203,12 +269,17 @@ void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
         LLGL_DBG_SOURCE;
         ValidateResourceCPUAccess(bufferDbg.desc.cpuAccessFlags, access, "buffer");
         ValidateBufferMapping(bufferDbg, true);
+        LintBufferMapping(bufferDbg, access);
     }
 
     auto result = instance_->MapBuffer(bufferDbg.instance, access);
 
     if (result != nullptr)
+    {
         bufferDbg.OnMap(access, 0, bufferDbg.desc.size);
+        if (capture_)
+            capture_->RecordMapBuffer(bufferDbg, access, 0, bufferDbg.desc.size, result);
+    }
 
     if (profiler_)
         profiler_->frameProfile.bufferMappings++;
@@ -225,13 +296,18 @@ void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::ui
         LLGL_DBG_SOURCE;
         ValidateResourceCPUAccess(bufferDbg.desc.cpuAccessFlags, access, "buffer");
         ValidateBufferMapping(bufferDbg, true);
+        LintBufferMapping(bufferDbg, access);
         ValidateBufferBoundary(bufferDbg.desc.size, offset, length);
     }
 
     auto result = instance_->MapBuffer(bufferDbg.instance, access, offset, length);
 
     if (result != nullptr)
+    {
         bufferDbg.OnMap(access, offset, length);
+        if (capture_)
+            capture_->RecordMapBuffer(bufferDbg, access, offset, length, result);
+    }
 
     if (profiler_)
         profiler_->frameProfile.bufferMappings++;
@@ -249,6 +325,10 @@ void DbgRenderSystem::UnmapBuffer(Buffer& buffer)
         ValidateBufferMapping(bufferDbg, false);
     }
 
+    /* Record mapped range before it is unmapped, since the mapped memory is only valid until then */
+    if (capture_)
+        capture_->RecordUnmapBuffer(bufferDbg);
+
     instance_->UnmapBuffer(bufferDbg.instance);
 
     bufferDbg.OnUnmap();
@@ -266,6 +346,24 @@ Texture* DbgRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, co
     return textures_.emplace<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc);
 }
 
+void DbgRenderSystem::CreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, const SrcImageDescriptor* const * imageDescs, Texture** outTextures)
+{
+    RenderSystem::AssertCreateTextures(numTextures, textureDescs, outTextures);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        for_range(i, numTextures)
+            ValidateTextureDesc(textureDescs[i], (imageDescs != nullptr ? imageDescs[i] : nullptr));
+    }
+
+    /* Create all texture instances with a single batch, then wrap them into debug texture objects */
+    instance_->CreateTextures(numTextures, textureDescs, imageDescs, outTextures);
+
+    for_range(i, numTextures)
+        outTextures[i] = textures_.emplace<DbgTexture>(*outTextures[i], textureDescs[i]);
+}
+
 void DbgRenderSystem::Release(Texture& texture)
 {
     ReleaseDbg(textures_, texture);
@@ -284,6 +382,9 @@ void DbgRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textur
 
     instance_->WriteTexture(textureDbg.instance, textureRegion, imageDesc);
 
+    if (capture_)
+        capture_->RecordWriteTexture(textureDbg, textureRegion, imageDesc);
+
     if (profiler_)
         profiler_->frameProfile.textureWrites++;
 }
@@ -297,6 +398,8 @@ void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& texture
         LLGL_DBG_SOURCE;
         ValidateTextureRegion(textureDbg, textureRegion);
         ValidateImageDataSize(textureDbg, textureRegion, imageDesc.format, imageDesc.dataType, imageDesc.dataSize);
+        if (DbgIsPerformanceLintEnabled(debugger_) && debugger_->IsFrameEncoding())
+            LLGL_DBG_LINT(PerformanceLint::ReadTextureInFrame, "reading texture while a frame is being encoded stalls the CPU until the GPU is idle");
     }
 
     instance_->ReadTexture(textureDbg.instance, textureRegion, imageDesc);
@@ -309,12 +412,19 @@ void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& texture
 
 Sampler* DbgRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    return instance_->CreateSampler(samplerDesc);
+    auto* sampler = instance_->CreateSampler(samplerDesc);
+
+    if (capture_ && sampler != nullptr)
+        capture_->RegisterSampler(*sampler, samplerDesc);
+
+    return sampler;
     //return samplers_.emplace<DbgSampler>();
 }
 
 void DbgRenderSystem::Release(Sampler& sampler)
 {
+    if (capture_)
+        capture_->ReleaseObject(&sampler);
     instance_->Release(sampler);
     //ReleaseDbg(samplers_, sampler);
 }
@@ -343,6 +453,9 @@ std::vector<ResourceViewDescriptor> DbgRenderSystem::GetResourceViewInstanceCopy
                 case ResourceType::Sampler:
                     //TODO: DbgSampler
                     break;
+                case ResourceType::AccelerationStructure:
+                    resourceViewCopy.resource = &(LLGL_CAST(DbgAccelerationStructure*, resourceViewCopy.resource)->instance);
+                    break;
                 default:
                     LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid resource type passed to <ResourceViewDescriptor>");
                     break;
@@ -388,10 +501,19 @@ ResourceHeap* DbgRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
         auto pipelineLayoutDbg = LLGL_CAST(DbgPipelineLayout*, resourceHeapDesc.pipelineLayout);
         instanceDesc.pipelineLayout = &(pipelineLayoutDbg->instance);
     }
-    return resourceHeaps_.emplace<DbgResourceHeap>(
+    auto* resourceHeapDbg = resourceHeaps_.emplace<DbgResourceHeap>(
         *instance_->CreateResourceHeap(instanceDesc, instanceResourceViews),
         resourceHeapDesc
     );
+
+    /* Keep track of resource views with debug layer objects for captures */
+    if (capture_)
+    {
+        resourceHeapDbg->resourceViews.resize(std::max<std::size_t>(resourceHeapDesc.numResourceViews, initialResourceViews.size()));
+        std::copy(initialResourceViews.begin(), initialResourceViews.end(), resourceHeapDbg->resourceViews.begin());
+    }
+
+    return resourceHeapDbg;
 }
 
 void DbgRenderSystem::Release(ResourceHeap& resourceHeap)
@@ -410,13 +532,32 @@ std::uint32_t DbgRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std
     }
 
     auto instanceResourceViews = GetResourceViewInstanceCopy(resourceViews);
-    return instance_->WriteResourceHeap(resourceHeapDbg.instance, firstDescriptor, instanceResourceViews);
+    const std::uint32_t numWritten = instance_->WriteResourceHeap(resourceHeapDbg.instance, firstDescriptor, instanceResourceViews);
+
+    if (capture_)
+    {
+        /* Null resources denote unchanged resource views */
+        for_range(i, resourceViews.size())
+        {
+            const std::size_t index = firstDescriptor + i;
+            if (resourceViews[i].resource != nullptr && index < resourceHeapDbg.resourceViews.size())
+                resourceHeapDbg.resourceViews[index] = resourceViews[i];
+        }
+        capture_->RecordWriteResourceHeap(resourceHeapDbg, firstDescriptor, resourceViews);
+    }
+
+    return numWritten;
 }
 
 /* ----- Render Passes ----- */
 
 RenderPass* DbgRenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
 {
+    LLGL_DBG_SOURCE;
+
+    if (debugger_ && renderPassDesc.viewMask != 0)
+        ValidateMultiviewMask(renderPassDesc.viewMask);
+
     return renderPasses_.emplace<DbgRenderPass>(*instance_->CreateRenderPass(renderPassDesc), renderPassDesc);
 }
 
@@ -426,6 +567,8 @@ void DbgRenderSystem::Release(RenderPass& renderPass)
     auto& renderPassDbg = LLGL_CAST(DbgRenderPass&, renderPass);
     if (auto instance = renderPassDbg.mutableInstance)
     {
+        if (capture_)
+            capture_->ReleaseObject(&renderPassDbg);
         instance_->Release(*instance);
         renderPasses_.erase(&renderPass);
     }
@@ -441,12 +584,18 @@ RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
     {
         instanceDesc.renderPass = DbgGetInstance<DbgRenderPass>(renderTargetDesc.renderPass);
 
-        auto TransferDbgAttachment = [this](AttachmentDescriptor& attachmentDesc, std::uint32_t colorTarget, bool isResolveAttachment, bool isDepthStencilAttachment)
+        const std::uint32_t viewMask = (renderTargetDesc.renderPass != nullptr ? LLGL_CAST(const DbgRenderPass*, renderTargetDesc.renderPass)->desc.viewMask : 0);
+
+        auto TransferDbgAttachment = [this, viewMask](AttachmentDescriptor& attachmentDesc, std::uint32_t colorTarget, bool isResolveAttachment, bool isDepthStencilAttachment)
         {
             if (IsAttachmentEnabled(attachmentDesc))
             {
                 if (debugger_)
+                {
                     ValidateAttachmentDesc(attachmentDesc, colorTarget, isResolveAttachment, isDepthStencilAttachment);
+                    if (viewMask != 0)
+                        ValidateMultiviewAttachment(attachmentDesc, viewMask);
+                }
                 attachmentDesc.texture = DbgGetInstance<DbgTexture>(attachmentDesc.texture);
             }
         };
@@ -457,6 +606,13 @@ RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
             TransferDbgAttachment(instanceDesc.resolveAttachments[colorTarget], colorTarget, /*isResolveAttachment:*/ true, /*isDepthStencilAttachment:*/ false);
         }
         TransferDbgAttachment(instanceDesc.depthStencilAttachment, 0, /*isResolveAttachment:*/ false, /*isDepthStencilAttachment:*/ true);
+
+        if (renderTargetDesc.shadingRateImage != nullptr)
+        {
+            if (debugger_)
+                ValidateShadingRateImage(*renderTargetDesc.shadingRateImage, renderTargetDesc.resolution);
+            instanceDesc.shadingRateImage = DbgGetInstance<DbgTexture>(renderTargetDesc.shadingRateImage);
+        }
     }
     return renderTargets_.emplace<DbgRenderTarget>(*instance_->CreateRenderTarget(instanceDesc), debugger_, renderTargetDesc);
 }
@@ -482,6 +638,12 @@ void DbgRenderSystem::Release(Shader& shader)
 
 PipelineLayout* DbgRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& pipelineLayoutDesc)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (pipelineLayoutDesc.bindlessHeap && !features_.hasBindlessResources)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("bindless resource heaps");
+    }
     return pipelineLayouts_.emplace<DbgPipelineLayout>(*instance_->CreatePipelineLayout(pipelineLayoutDesc), pipelineLayoutDesc);
 }
 
@@ -497,13 +659,8 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const Blob& serializedCache)
     return nullptr;//TODO
 }
 
-PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* serializedCache)
+static GraphicsPipelineDescriptor GetInstancePipelineDesc(const GraphicsPipelineDescriptor& pipelineStateDesc)
 {
-    LLGL_DBG_SOURCE;
-
-    if (debugger_)
-        ValidateGraphicsPipelineDesc(pipelineStateDesc);
-
     auto instanceDesc = pipelineStateDesc;
     {
         if (pipelineStateDesc.pipelineLayout != nullptr)
@@ -516,6 +673,32 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescri
         instanceDesc.geometryShader         = DbgGetInstance<DbgShader>(pipelineStateDesc.geometryShader);
         instanceDesc.fragmentShader         = DbgGetInstance<DbgShader>(pipelineStateDesc.fragmentShader);
     }
+    return instanceDesc;
+}
+
+static ComputePipelineDescriptor GetInstancePipelineDesc(const ComputePipelineDescriptor& pipelineStateDesc)
+{
+    auto instanceDesc = pipelineStateDesc;
+    {
+        if (pipelineStateDesc.pipelineLayout != nullptr)
+            instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, pipelineStateDesc.pipelineLayout)->instance);
+
+        instanceDesc.computeShader = DbgGetInstance<DbgShader>(pipelineStateDesc.computeShader);
+    }
+    return instanceDesc;
+}
+
+PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* serializedCache)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
+    {
+        ValidateGraphicsPipelineDesc(pipelineStateDesc);
+        LintPipelineCreation();
+    }
+
+    const GraphicsPipelineDescriptor instanceDesc = GetInstancePipelineDesc(pipelineStateDesc);
     return pipelineStates_.emplace<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), pipelineStateDesc);
 }
 
@@ -524,16 +707,43 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const ComputePipelineDescrip
     LLGL_DBG_SOURCE;
 
     if (debugger_)
+    {
         ValidateComputePipelineDesc(pipelineStateDesc);
+        LintPipelineCreation();
+    }
 
-    auto instanceDesc = pipelineStateDesc;
+    const ComputePipelineDescriptor instanceDesc = GetInstancePipelineDesc(pipelineStateDesc);
+    return pipelineStates_.emplace<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), pipelineStateDesc);
+}
+
+PipelineState* DbgRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
     {
-        if (pipelineStateDesc.pipelineLayout != nullptr)
-            instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, pipelineStateDesc.pipelineLayout)->instance);
+        ValidateGraphicsPipelineDesc(pipelineStateDesc);
+        ValidateFallbackPipelineState(fallbackPipelineState, /*isGraphicsPSO:*/ true);
+    }
 
-        instanceDesc.computeShader = DbgGetInstance<DbgShader>(pipelineStateDesc.computeShader);
+    const GraphicsPipelineDescriptor instanceDesc = GetInstancePipelineDesc(pipelineStateDesc);
+    PipelineState* fallbackInstance = DbgGetInstance<DbgPipelineState>(fallbackPipelineState);
+    return pipelineStates_.emplace<DbgPipelineState>(*instance_->CreatePipelineStateAsync(instanceDesc, fallbackInstance), pipelineStateDesc);
+}
+
+PipelineState* DbgRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
+    {
+        ValidateComputePipelineDesc(pipelineStateDesc);
+        ValidateFallbackPipelineState(fallbackPipelineState, /*isGraphicsPSO:*/ false);
     }
-    return pipelineStates_.emplace<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), pipelineStateDesc);
+
+    const ComputePipelineDescriptor instanceDesc = GetInstancePipelineDesc(pipelineStateDesc);
+    PipelineState* fallbackInstance = DbgGetInstance<DbgPipelineState>(fallbackPipelineState);
+    return pipelineStates_.emplace<DbgPipelineState>(*instance_->CreatePipelineStateAsync(instanceDesc, fallbackInstance), pipelineStateDesc);
 }
 
 void DbgRenderSystem::Release(PipelineState& pipelineState)
@@ -553,6 +763,29 @@ void DbgRenderSystem::Release(QueryHeap& queryHeap)
     ReleaseDbg(queryHeaps_, queryHeap);
 }
 
+/* ----- Acceleration structures ----- */
+
+AccelerationStructure* DbgRenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& accelerationStructureDesc)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateAccelerationStructureDesc(accelerationStructureDesc);
+    }
+
+    /* Replace debug buffers of the geometries by their instances */
+    const std::vector<AccelerationStructureGeometryDescriptor> instanceGeometries = DbgGetGeometryInstanceCopy(accelerationStructureDesc.geometries);
+    AccelerationStructureDescriptor instanceDesc = accelerationStructureDesc;
+    instanceDesc.geometries = instanceGeometries;
+
+    return accelStructs_.emplace<DbgAccelerationStructure>(*instance_->CreateAccelerationStructure(instanceDesc), accelerationStructureDesc);
+}
+
+void DbgRenderSystem::Release(AccelerationStructure& accelerationStructure)
+{
+    ReleaseDbg(accelStructs_, accelerationStructure);
+}
+
 /* ----- Fences ----- */
 
 Fence* DbgRenderSystem::CreateFence()
@@ -572,6 +805,127 @@ bool DbgRenderSystem::GetNativeHandle(void* nativeHandle, std::size_t nativeHand
     return instance_->GetNativeHandle(nativeHandle, nativeHandleSize);
 }
 
+std::uint64_t DbgRenderSystem::ReleaseRetainedMemory(std::uint64_t budget)
+{
+    return instance_->ReleaseRetainedMemory(budget);
+}
+
+bool DbgRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStatistics)
+{
+    return instance_->QueryMemoryStatistics(outStatistics);
+}
+
+bool DbgRenderSystem::SetMemoryPriority(Resource& resource, float priority)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!(priority >= 0.0f && priority <= 1.0f))
+            LLGL_DBG_WARN(WarningType::ImproperArgument, "memory priority is clamped to the range [0, 1]");
+    }
+
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+            return instance_->SetMemoryPriority(LLGL_CAST(DbgBuffer&, resource).instance, priority);
+
+        case ResourceType::Texture:
+            return instance_->SetMemoryPriority(LLGL_CAST(DbgTexture&, resource).instance, priority);
+
+        default:
+        {
+            if (debugger_)
+            {
+                LLGL_DBG_SOURCE;
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot set memory priority of resource other than buffers and textures");
+            }
+            return false;
+        }
+    }
+}
+
+Blob DbgRenderSystem::GetPipelineCache()
+{
+    return instance_->GetPipelineCache();
+}
+
+bool DbgRenderSystem::ExportMemoryHandle(Resource& resource, ExternalHandle& outHandle)
+{
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            auto& bufferDbg = LLGL_CAST(DbgBuffer&, resource);
+            if (debugger_)
+            {
+                LLGL_DBG_SOURCE;
+                if ((bufferDbg.desc.miscFlags & MiscFlags::External) == 0)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot export memory of buffer that was not created with 'LLGL::MiscFlags::External'");
+            }
+            return instance_->ExportMemoryHandle(bufferDbg.instance, outHandle);
+        }
+
+        case ResourceType::Texture:
+        {
+            auto& textureDbg = LLGL_CAST(DbgTexture&, resource);
+            if (debugger_)
+            {
+                LLGL_DBG_SOURCE;
+                if ((textureDbg.desc.miscFlags & MiscFlags::External) == 0)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot export memory of texture that was not created with 'LLGL::MiscFlags::External'");
+            }
+            return instance_->ExportMemoryHandle(textureDbg.instance, outHandle);
+        }
+
+        default:
+        {
+            if (debugger_)
+            {
+                LLGL_DBG_SOURCE;
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot export memory of resource other than buffers and textures");
+            }
+            return false;
+        }
+    }
+}
+
+bool DbgRenderSystem::ExportFenceHandle(Fence& fence, ExternalHandle& outHandle)
+{
+    return instance_->ExportFenceHandle(fence, outHandle);
+}
+
+bool DbgRenderSystem::SubmitFileLoads(const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    std::vector<FileLoadDescriptor> instanceLoads(loads.begin(), loads.end());
+
+    for (FileLoadDescriptor& load : instanceLoads)
+    {
+        if (debugger_)
+        {
+            LLGL_DBG_SOURCE;
+            ValidateFileLoad(load);
+        }
+
+        /* Replace wrapped resources by their instances; the data is assumed to initialize the destination range */
+        if (load.resource != nullptr)
+        {
+            if (load.resource->GetResourceType() == ResourceType::Buffer)
+            {
+                auto& bufferDbg = LLGL_CAST(DbgBuffer&, *load.resource);
+                bufferDbg.initialized = true;
+                load.resource = &(bufferDbg.instance);
+            }
+            else if (load.resource->GetResourceType() == ResourceType::Texture)
+            {
+                auto& textureDbg = LLGL_CAST(DbgTexture&, *load.resource);
+                load.resource = &(textureDbg.instance);
+            }
+        }
+    }
+
+    return instance_->SubmitFileLoads(instanceLoads, fence);
+}
+
 
 /*
  * ======= Private: =======
@@ -591,7 +945,8 @@ void DbgRenderSystem::ValidateBindFlags(long flags)
     constexpr long textureOnlyFlags =
     (
         BindFlags::ColorAttachment          |
-        BindFlags::DepthStencilAttachment
+        BindFlags::DepthStencilAttachment   |
+        BindFlags::ShadingRateAttachment
     );
 
     constexpr long validFlags =
@@ -707,7 +1062,33 @@ void DbgRenderSystem::ValidateBufferDesc(const BufferDescriptor& bufferDesc, std
     /* Validate flags */
     ValidateBindFlags(bufferDesc.bindFlags);
     ValidateCPUAccessFlags(bufferDesc.cpuAccessFlags, CPUAccessFlags::ReadWrite, "buffer");
-    ValidateMiscFlags(bufferDesc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::NoInitialData), "buffer");
+    ValidateMiscFlags(bufferDesc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::NoInitialData | MiscFlags::Sparse | MiscFlags::HostVisible | MiscFlags::External), "buffer");
+
+    /* Validate sparse buffers are supported and have no CPU access */
+    if ((bufferDesc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        AssertSparseResources();
+        if (bufferDesc.cpuAccessFlags != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "sparse buffers must not have any CPU access flags");
+        if ((bufferDesc.miscFlags & MiscFlags::External) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "'LLGL::MiscFlags::External' cannot be combined with 'LLGL::MiscFlags::Sparse'");
+    }
+
+    /* Validate host-visible buffers have CPU access and are only used in a way all backends support */
+    if ((bufferDesc.miscFlags & MiscFlags::HostVisible) != 0)
+    {
+        if ((bufferDesc.miscFlags & MiscFlags::Sparse) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "'LLGL::MiscFlags::HostVisible' cannot be combined with 'LLGL::MiscFlags::Sparse'");
+        else if (bufferDesc.cpuAccessFlags == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "'LLGL::MiscFlags::HostVisible' is ignored for buffers without CPU access flags");
+        else if ((bufferDesc.cpuAccessFlags & CPUAccessFlags::Write) == 0)
+        {
+            if ((bufferDesc.bindFlags & ~BindFlags::CopyDst) != 0)
+                LLGL_DBG_WARN(WarningType::VaryingBehavior, "'LLGL::MiscFlags::HostVisible' is ignored by some backends for readback buffers with binding flags other than 'LLGL::BindFlags::CopyDst'");
+        }
+        else if ((bufferDesc.bindFlags & (BindFlags::Storage | BindFlags::StreamOutputBuffer)) != 0)
+            LLGL_DBG_WARN(WarningType::VaryingBehavior, "'LLGL::MiscFlags::HostVisible' is ignored by some backends for buffers with 'LLGL::BindFlags::Storage' or 'LLGL::BindFlags::StreamOutputBuffer'");
+    }
 
     /* Validate (constant-) buffer size */
     if ((bufferDesc.bindFlags & BindFlags::ConstantBuffer) != 0)
@@ -953,7 +1334,32 @@ void DbgRenderSystem::ValidateTextureDesc(const TextureDescriptor& textureDesc,
     ValidateTextureDescMipLevels(textureDesc);
     ValidateArrayTextureLayers(textureDesc.type, textureDesc.arrayLayers);
     ValidateBindFlags(textureDesc.bindFlags);
-    ValidateMiscFlags(textureDesc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::FixedSamples | MiscFlags::GenerateMips | MiscFlags::NoInitialData), "texture");
+    ValidateMiscFlags(textureDesc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::FixedSamples | MiscFlags::GenerateMips | MiscFlags::NoInitialData | MiscFlags::Sparse | MiscFlags::Transient | MiscFlags::External), "texture");
+
+    /* Validate sparse textures are supported and of a compatible type */
+    if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        AssertSparseResources();
+        if (textureDesc.type != TextureType::Texture2D && textureDesc.type != TextureType::Texture2DArray)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "sparse textures must be of type LLGL::TextureType::Texture2D or LLGL::TextureType::Texture2DArray");
+        if (imageDesc != nullptr)
+            LLGL_DBG_WARN(WarningType::ImproperArgument, "initial image data is ignored for sparse textures: 'LLGL::MiscFlags::Sparse' specified with initial image data");
+        if ((textureDesc.miscFlags & MiscFlags::External) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "'LLGL::MiscFlags::External' cannot be combined with 'LLGL::MiscFlags::Sparse'");
+    }
+
+    /* Validate transient textures are only used as attachments */
+    if ((textureDesc.miscFlags & MiscFlags::Transient) != 0)
+    {
+        if ((textureDesc.bindFlags & (BindFlags::ColorAttachment | BindFlags::DepthStencilAttachment)) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "transient textures must have binding flag LLGL::BindFlags::ColorAttachment or LLGL::BindFlags::DepthStencilAttachment");
+        if ((textureDesc.bindFlags & (BindFlags::Sampled | BindFlags::Storage | BindFlags::CopySrc | BindFlags::CopyDst)) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "transient textures cannot be sampled, copied, or used as storage resources");
+        if ((textureDesc.miscFlags & (MiscFlags::Sparse | MiscFlags::GenerateMips | MiscFlags::External)) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "'LLGL::MiscFlags::Transient' cannot be combined with 'LLGL::MiscFlags::Sparse', 'LLGL::MiscFlags::GenerateMips', or 'LLGL::MiscFlags::External'");
+        if (imageDesc != nullptr)
+            LLGL_DBG_WARN(WarningType::ImproperArgument, "initial image data is ignored for transient textures: 'LLGL::MiscFlags::Transient' specified with initial image data");
+    }
 
     /* Check if MIP-map generation is requested  */
     if ((textureDesc.miscFlags & MiscFlags::GenerateMips) != 0)
@@ -1165,6 +1571,56 @@ void DbgRenderSystem::ValidateImageDataSize(const DbgTexture& textureDbg, const
     }
 }
 
+void DbgRenderSystem::ValidateFileLoad(const FileLoadDescriptor& load)
+{
+    if (load.filename == nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'filename' of file load");
+    if (load.size == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "file load must not have a size of zero");
+
+    if (load.resource == nullptr)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'resource' of file load");
+        return;
+    }
+
+    switch (load.resource->GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            auto& bufferDbg = LLGL_CAST(const DbgBuffer&, *load.resource);
+            ValidateBufferBoundary(bufferDbg.desc.size, load.bufferOffset, load.size);
+        }
+        break;
+
+        case ResourceType::Texture:
+        {
+            auto& textureDbg = LLGL_CAST(const DbgTexture&, *load.resource);
+            ValidateTextureRegion(textureDbg, load.textureRegion);
+
+            if (load.textureRegion.subresource.numMipLevels > 1)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "file load cannot write more than one MIP-map level of a texture");
+
+            const std::uint64_t requiredSize = GetFileLoadTextureDataSize(textureDbg, load.textureRegion);
+            if (load.size != requiredSize)
+            {
+                LLGL_DBG_ERROR(
+                    ErrorType::InvalidArgument,
+                    "file load size mismatch for texture region: " + std::to_string(load.size) +
+                    " byte(s) specified but required is " + std::to_string(requiredSize) + " byte(s) of tightly packed texel data"
+                );
+            }
+        }
+        break;
+
+        default:
+        {
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "file loads can only write into buffers and textures");
+        }
+        break;
+    }
+}
+
 void DbgRenderSystem::ValidateTextureArrayRange(const DbgTexture& textureDbg, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers)
 {
     if (IsArrayTexture(textureDbg.GetType()))
@@ -1300,6 +1756,85 @@ void DbgRenderSystem::ValidateTextureViewType(const TextureType sharedTextureTyp
     }
 }
 
+void DbgRenderSystem::ValidateAccelerationStructureDesc(const AccelerationStructureDescriptor& accelerationStructureDesc)
+{
+    if (!features_.hasRayTracing)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("acceleration structures");
+
+    const long validFlags =
+    (
+        AccelerationStructureFlags::AllowUpdate     |
+        AccelerationStructureFlags::AllowCompaction |
+        AccelerationStructureFlags::PreferFastTrace |
+        AccelerationStructureFlags::PreferFastBuild
+    );
+    if ((accelerationStructureDesc.flags & ~validFlags) != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "unknown acceleration structure flags specified: " + std::string(IntToHex(static_cast<std::uint32_t>(accelerationStructureDesc.flags & ~validFlags))));
+
+    const long fastTraceAndBuildFlags = (AccelerationStructureFlags::PreferFastTrace | AccelerationStructureFlags::PreferFastBuild);
+    if ((accelerationStructureDesc.flags & fastTraceAndBuildFlags) == fastTraceAndBuildFlags)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "acceleration structure flags 'PreferFastTrace' and 'PreferFastBuild' are mutually exclusive");
+
+    /* Compaction destinations don't require any geometry or instances */
+    if (accelerationStructureDesc.compactedSize > 0)
+        return;
+
+    if (accelerationStructureDesc.type == AccelerationStructureType::TopLevel)
+    {
+        if (accelerationStructureDesc.maxInstances == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "top-level acceleration structure must have at least one instance");
+        else if (accelerationStructureDesc.maxInstances > limits_.maxAccelerationStructureInstances)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "too many instances for top-level acceleration structure: " + std::to_string(accelerationStructureDesc.maxInstances) +
+                " specified but limit is " + std::to_string(limits_.maxAccelerationStructureInstances)
+            );
+        }
+        if (!accelerationStructureDesc.geometries.empty())
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "geometries are ignored for top-level acceleration structures");
+    }
+    else
+    {
+        if (accelerationStructureDesc.geometries.empty())
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "bottom-level acceleration structure must have at least one geometry");
+        for_range(i, accelerationStructureDesc.geometries.size())
+            ValidateAccelerationStructureGeometry(accelerationStructureDesc.geometries[i], i);
+    }
+}
+
+void DbgRenderSystem::ValidateAccelerationStructureGeometry(const AccelerationStructureGeometryDescriptor& geometryDesc, std::size_t idx)
+{
+    const std::string geometryName = "acceleration structure geometry [" + std::to_string(idx) + "]";
+
+    switch (geometryDesc.vertexFormat)
+    {
+        case Format::RG32Float:
+        case Format::RGB32Float:
+        case Format::RG16Float:
+        case Format::RGBA16Float:
+            break;
+        default:
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid vertex format for " + geometryName + ": LLGL::Format::" + std::string(ToString(geometryDesc.vertexFormat)));
+            break;
+    }
+
+    if (geometryDesc.vertexStride == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "vertex stride of " + geometryName + " must not be zero");
+    if (geometryDesc.numVertices == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, geometryName + " must have at least one vertex");
+
+    if (geometryDesc.indexBuffer != nullptr || geometryDesc.numIndices > 0)
+    {
+        if (geometryDesc.indexFormat != Format::R16UInt && geometryDesc.indexFormat != Format::R32UInt)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid index format for " + geometryName + ": LLGL::Format::" + std::string(ToString(geometryDesc.indexFormat)));
+        if (geometryDesc.numIndices % 3 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "number of indices of " + geometryName + " must be a multiple of 3, but " + std::to_string(geometryDesc.numIndices) + " specified");
+    }
+    else if (geometryDesc.numVertices % 3 != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "number of non-indexed vertices of " + geometryName + " must be a multiple of 3, but " + std::to_string(geometryDesc.numVertices) + " specified");
+}
+
 void DbgRenderSystem::ValidateAttachmentDesc(const AttachmentDescriptor& attachmentDesc, std::uint32_t colorTarget, bool isResolveAttachment, bool isDepthStencilAttachment)
 {
     if (auto texture = attachmentDesc.texture)
@@ -1383,15 +1918,110 @@ void DbgRenderSystem::ValidateAttachmentDesc(const AttachmentDescriptor& attachm
     }
 }
 
+void DbgRenderSystem::ValidateMultiviewMask(std::uint32_t viewMask)
+{
+    if (!features_.hasMultiview)
+    {
+        LLGL_DBG_ERROR_NOT_SUPPORTED("multiview rendering");
+        return;
+    }
+
+    const std::uint32_t numViews = NumMultiviewViews(viewMask);
+    if (numViews > limits_.maxMultiviewViewCount)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "multiview mask " + std::string(IntToHex(viewMask)) + " exceeded limit of views (" +
+            std::to_string(numViews) + " specified but limit is " + std::to_string(limits_.maxMultiviewViewCount) + ")"
+        );
+    }
+}
+
+void DbgRenderSystem::ValidateMultiviewAttachment(const AttachmentDescriptor& attachmentDesc, std::uint32_t viewMask)
+{
+    auto textureDbg = LLGL_CAST(const DbgTexture*, attachmentDesc.texture);
+    if (textureDbg == nullptr)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "cannot have multiview render-target attachment without texture"
+        );
+        return;
+    }
+
+    /* Each view renders into the array layer that is offset by its view index */
+    const std::uint32_t numArrayLayers = NumMultiviewArrayLayers(viewMask);
+    if (!IsArrayTexture(textureDbg->desc.type))
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "cannot have multiview render-target attachment with non-array texture of type LLGL::TextureType::" + std::string(ToString(textureDbg->desc.type))
+        );
+    }
+    else if (attachmentDesc.arrayLayer + numArrayLayers > textureDbg->desc.arrayLayers)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "multiview render-target attachment exceeded number of array layers (" +
+            std::to_string(attachmentDesc.arrayLayer + numArrayLayers) + " required but upper bound is " + std::to_string(textureDbg->desc.arrayLayers) + ")"
+        );
+    }
+}
+
+void DbgRenderSystem::ValidateShadingRateImage(const Texture& texture, const Extent2D& resolution)
+{
+    if (!features_.hasShadingRateImage)
+    {
+        LLGL_DBG_ERROR_NOT_SUPPORTED("shading-rate images");
+        return;
+    }
+
+    auto& textureDbg = LLGL_CAST(const DbgTexture&, texture);
+
+    if ((textureDbg.desc.bindFlags & BindFlags::ShadingRateAttachment) == 0)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "cannot have shading-rate image with texture that was not created with the 'LLGL::BindFlags::ShadingRateAttachment' flag"
+        );
+    }
+
+    if (textureDbg.desc.type != TextureType::Texture2D || textureDbg.desc.format != Format::R8UInt)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "shading-rate image must be a 2D texture with format LLGL::Format::R8UInt"
+        );
+    }
+
+    /* Validate that the shading-rate image covers the entire render target */
+    if (const std::uint32_t tileSize = limits_.shadingRateImageTileSize)
+    {
+        const Extent2D minExtent
+        {
+            (resolution.width  + tileSize - 1) / tileSize,
+            (resolution.height + tileSize - 1) / tileSize,
+        };
+        if (textureDbg.desc.extent.width < minExtent.width || textureDbg.desc.extent.height < minExtent.height)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "shading-rate image of size " + std::to_string(textureDbg.desc.extent.width) + "x" + std::to_string(textureDbg.desc.extent.height) +
+                " does not cover render target with tile size " + std::to_string(tileSize) +
+                " (at least " + std::to_string(minExtent.width) + "x" + std::to_string(minExtent.height) + " required)"
+            );
+        }
+    }
+}
+
 void DbgRenderSystem::ValidateResourceHeapDesc(const ResourceHeapDescriptor& resourceHeapDesc, const ArrayView<ResourceViewDescriptor>& initialResourceViews)
 {
     if (resourceHeapDesc.pipelineLayout != nullptr)
     {
         auto pipelineLayoutDbg = LLGL_CAST(DbgPipelineLayout*, resourceHeapDesc.pipelineLayout);
-        const auto& bindings = pipelineLayoutDbg->desc.heapBindings;
 
         const auto numResourceViews = (resourceHeapDesc.numResourceViews > 0 ? resourceHeapDesc.numResourceViews : static_cast<std::uint32_t>(initialResourceViews.size()));
-        const auto numBindings      = bindings.size();
+        const auto numBindings      = pipelineLayoutDbg->GetNumHeapDescriptors();
 
         if (numBindings == 0)
         {
@@ -1429,7 +2059,7 @@ void DbgRenderSystem::ValidateResourceHeapDesc(const ResourceHeapDescriptor& res
             {
                 /* Validate all resource view descriptors against their respective binding descriptor */
                 for_range(i, resourceHeapDesc.numResourceViews)
-                    ValidateResourceViewForBinding(initialResourceViews[i], bindings[i % bindings.size()]);
+                    ValidateResourceViewForBinding(initialResourceViews[i], pipelineLayoutDbg->GetHeapBindingForDescriptor(i % numBindings));
             }
             else
             {
@@ -1496,6 +2126,14 @@ void DbgRenderSystem::ValidateResourceViewForBinding(const ResourceViewDescripto
             }
             break;
 
+            case ResourceType::AccelerationStructure:
+            {
+                auto accelStructDbg = LLGL_CAST(DbgAccelerationStructure*, resource);
+                if (accelStructDbg->GetType() != AccelerationStructureType::TopLevel)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "only top-level acceleration structures can be bound to shaders");
+            }
+            break;
+
             default:
             break;
         }
@@ -1601,7 +2239,9 @@ void DbgRenderSystem::ValidateGraphicsPipelineDesc(const GraphicsPipelineDescrip
 
     /* Validate shader pipeline stages */
     bool hasSeparableShaders = false;
-    if (auto vertexShaderDbg = DbgGetWrapper<DbgShader>(pipelineStateDesc.vertexShader))
+    if (pipelineStateDesc.meshShader != nullptr)
+        ValidateMeshPipelineShaders(pipelineStateDesc);
+    else if (auto vertexShaderDbg = DbgGetWrapper<DbgShader>(pipelineStateDesc.vertexShader))
         hasSeparableShaders = ((vertexShaderDbg->desc.flags & ShaderCompileFlags::SeparateShader) != 0);
     else
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics PSO without vertex shader");
@@ -1621,6 +2261,8 @@ void DbgRenderSystem::ValidateGraphicsPipelineDesc(const GraphicsPipelineDescrip
                        ShaderTypePair{ pipelineStateDesc.tessControlShader,    ShaderType::TessControl    },
                        ShaderTypePair{ pipelineStateDesc.tessEvaluationShader, ShaderType::TessEvaluation },
                        ShaderTypePair{ pipelineStateDesc.geometryShader,       ShaderType::Geometry       },
+                       ShaderTypePair{ pipelineStateDesc.taskShader,           ShaderType::Task           },
+                       ShaderTypePair{ pipelineStateDesc.meshShader,           ShaderType::Mesh           },
                        ShaderTypePair{ pipelineStateDesc.fragmentShader,       ShaderType::Fragment       } })
     {
         if (auto shader = pair.shader)
@@ -1658,6 +2300,45 @@ void DbgRenderSystem::ValidateGraphicsPipelineDesc(const GraphicsPipelineDescrip
         ValidateFragmentShaderOutput(*fragmentShaderDbg, pipelineStateDesc.renderPass);
 
     ValidateBlendDescriptor(pipelineStateDesc.blend, hasFragmentShader);
+
+    if (pipelineStateDesc.shadingRate.rate != ShadingRate::Rate1x1 && !features_.hasVariableRateShading)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("variable rate shading");
+    if (pipelineStateDesc.shadingRate.imageCombiner != ShadingRateCombiner::Keep && !features_.hasShadingRateImage)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("shading-rate images");
+
+    /* Validate multiview mask against the render pass this pipeline is compatible with */
+    if (pipelineStateDesc.viewMask != 0)
+        ValidateMultiviewMask(pipelineStateDesc.viewMask);
+
+    const std::uint32_t renderPassViewMask = (pipelineStateDesc.renderPass != nullptr ? LLGL_CAST(const DbgRenderPass*, pipelineStateDesc.renderPass)->desc.viewMask : 0);
+    if (pipelineStateDesc.viewMask != renderPassViewMask)
+    {
+        const std::string psoViewMaskStr = IntToHex(pipelineStateDesc.viewMask);
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "mismatch between multiview mask of graphics PSO (" + psoViewMaskStr +
+            ") and its render pass (" + std::string(IntToHex(renderPassViewMask)) + ")"
+        );
+    }
+}
+
+void DbgRenderSystem::ValidateMeshPipelineShaders(const GraphicsPipelineDescriptor& pipelineStateDesc)
+{
+    if (!features_.hasMeshShaders)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("mesh shaders");
+
+    if (pipelineStateDesc.vertexShader         != nullptr ||
+        pipelineStateDesc.tessControlShader    != nullptr ||
+        pipelineStateDesc.tessEvaluationShader != nullptr ||
+        pipelineStateDesc.geometryShader       != nullptr)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics PSO with mesh shader and any of the vertex, tessellation, or geometry shader stages");
+    }
+
+    if (pipelineStateDesc.primitiveTopology != PrimitiveTopology::PointList &&
+        pipelineStateDesc.primitiveTopology != PrimitiveTopology::LineList  &&
+        pipelineStateDesc.primitiveTopology != PrimitiveTopology::TriangleList)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics PSO with mesh shader and primitive topology other than point, line, or triangle lists");
 }
 
 void DbgRenderSystem::ValidateComputePipelineDesc(const ComputePipelineDescriptor& pipelineStateDesc)
@@ -1676,6 +2357,41 @@ void DbgRenderSystem::ValidateComputePipelineDesc(const ComputePipelineDescripto
     }
     else
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create compute PSO without compute shader");
+
+    /* Validate required subgroup size */
+    if (const std::uint32_t subgroupSize = pipelineStateDesc.requiredSubgroupSize)
+    {
+        if (!features_.hasSubgroupSizeControl)
+        {
+            LLGL_DBG_WARN(
+                WarningType::VaryingBehavior,
+                "required subgroup size " + std::to_string(subgroupSize) + " is ignored, because subgroup size control is not supported"
+            );
+        }
+        else if ((subgroupSize & (subgroupSize - 1)) != 0 || subgroupSize < limits_.minSubgroupSize || subgroupSize > limits_.maxSubgroupSize)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "required subgroup size " + std::to_string(subgroupSize) + " must be a power of two in the range [" +
+                std::to_string(limits_.minSubgroupSize) + ", " + std::to_string(limits_.maxSubgroupSize) + "]"
+            );
+        }
+    }
+}
+
+void DbgRenderSystem::ValidateFallbackPipelineState(const PipelineState* fallbackPipelineState, bool isGraphicsPSO)
+{
+    if (auto fallbackPipelineStateDbg = DbgGetWrapper<DbgPipelineState>(fallbackPipelineState))
+    {
+        if (fallbackPipelineStateDbg->isGraphicsPSO != isGraphicsPSO)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                std::string("cannot use ") + (isGraphicsPSO ? "compute" : "graphics") +
+                " PSO as fallback for asynchronous " + (isGraphicsPSO ? "graphics" : "compute") + " PSO"
+            );
+        }
+    }
 }
 
 void DbgRenderSystem::ValidateFragmentShaderOutput(DbgShader& fragmentShaderDbg, const RenderPass* renderPass)
@@ -1814,10 +2530,46 @@ void DbgRenderSystem::AssertMultiSampleTextures()
         LLGL_DBG_ERROR_NOT_SUPPORTED("multi-sample textures");
 }
 
+void DbgRenderSystem::AssertSparseResources()
+{
+    if (!features_.hasSparseResources)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("sparse resources");
+}
+
+void DbgRenderSystem::LintBufferMapping(const DbgBuffer& bufferDbg, const CPUAccess access)
+{
+    if (!DbgIsPerformanceLintEnabled(debugger_) || bufferDbg.pendingQueue == nullptr)
+        return;
+
+    const bool isReadAccess = (access == CPUAccess::ReadOnly || access == CPUAccess::ReadWrite);
+    if (isReadAccess && bufferDbg.pendingQueue->IsBufferWritePending(bufferDbg))
+    {
+        LLGL_DBG_LINT(
+            PerformanceLint::MapBufferInFlight,
+            "mapping buffer for reading while it is still written by a submitted command buffer stalls the CPU; wait for a fence first"
+        );
+    }
+}
+
+void DbgRenderSystem::LintPipelineCreation()
+{
+    if (DbgIsPerformanceLintEnabled(debugger_) && debugger_->IsFrameEncoding())
+    {
+        LLGL_DBG_LINT(
+            PerformanceLint::PipelineCreationInFrame,
+            "creating PSO while a frame is being encoded can cause a hitch; create PSOs ahead of time or with CreatePipelineStateAsync"
+        );
+    }
+}
+
 template <typename T, typename TBase>
 void DbgRenderSystem::ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry)
 {
     auto& entryDbg = LLGL_CAST(T&, entry);
+    if (validationWorker_)
+        validationWorker_->WaitIdle();
+    if (capture_)
+        capture_->ReleaseObject(&entryDbg);
     instance_->Release(entryDbg.instance);
     cont.erase(&entry);
 }
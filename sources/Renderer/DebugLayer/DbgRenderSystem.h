@@ -13,9 +13,12 @@
 #include "DbgSwapChain.h"
 #include "DbgCommandBuffer.h"
 #include "DbgCommandQueue.h"
+#include "DbgCapture.h"
+#include "DbgValidationWorker.h"
 
 #include "Buffer/DbgBuffer.h"
 #include "Buffer/DbgBufferArray.h"
+#include "Buffer/DbgAccelerationStructure.h"
 #include "RenderState/DbgPipelineLayout.h"
 #include "RenderState/DbgPipelineState.h"
 #include "RenderState/DbgQueryHeap.h"
@@ -78,8 +81,15 @@ class DbgRenderSystem final : public RenderSystem
         void ValidateTextureView(const DbgTexture& sharedTextureDbg, const TextureViewDescriptor& textureViewDesc);
         void ValidateTextureViewType(const TextureType sharedTextureType, const TextureType textureViewType, const std::initializer_list<TextureType>& validTypes);
         void ValidateImageDataSize(const DbgTexture& textureDbg, const TextureRegion& textureRegion, ImageFormat imageFormat, DataType dataType, std::size_t dataSize);
+        void ValidateFileLoad(const FileLoadDescriptor& load);
+
+        void ValidateAccelerationStructureDesc(const AccelerationStructureDescriptor& accelerationStructureDesc);
+        void ValidateAccelerationStructureGeometry(const AccelerationStructureGeometryDescriptor& geometryDesc, std::size_t idx);
 
         void ValidateAttachmentDesc(const AttachmentDescriptor& attachmentDesc, std::uint32_t colorTarget, bool isResolveAttachment, bool isDepthStencilAttachment);
+        void ValidateMultiviewMask(std::uint32_t viewMask);
+        void ValidateMultiviewAttachment(const AttachmentDescriptor& attachmentDesc, std::uint32_t viewMask);
+        void ValidateShadingRateImage(const Texture& texture, const Extent2D& resolution);
 
         void ValidateResourceHeapDesc(const ResourceHeapDescriptor& resourceHeapDesc, const ArrayView<ResourceViewDescriptor>& initialResourceViews);
         void ValidateResourceHeapRange(const DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
@@ -90,7 +100,9 @@ class DbgRenderSystem final : public RenderSystem
         void ValidateColorMaskIsDisabled(const BlendTargetDescriptor& blendTargetDesc, std::size_t idx);
         void ValidateBlendDescriptor(const BlendDescriptor& blendDesc, bool hasFragmentShader);
         void ValidateGraphicsPipelineDesc(const GraphicsPipelineDescriptor& pipelineStateDesc);
+        void ValidateMeshPipelineShaders(const GraphicsPipelineDescriptor& pipelineStateDesc);
         void ValidateComputePipelineDesc(const ComputePipelineDescriptor& pipelineStateDesc);
+        void ValidateFallbackPipelineState(const PipelineState* fallbackPipelineState, bool isGraphicsPSO);
         void ValidateFragmentShaderOutput(DbgShader& fragmentShaderDbg, const RenderPass* renderPass);
         void ValidateFragmentShaderOutputWithRenderPass(DbgShader& fragmentShaderDbg, const FragmentShaderAttributes& fragmentAttribs, const DbgRenderPass& renderPass);
         void ValidateFragmentShaderOutputWithoutRenderPass(DbgShader& fragmentShaderDbg, const FragmentShaderAttributes& fragmentAttribs);
@@ -100,6 +112,10 @@ class DbgRenderSystem final : public RenderSystem
         void AssertArrayTextures();
         void AssertCubeArrayTextures();
         void AssertMultiSampleTextures();
+        void AssertSparseResources();
+
+        void LintBufferMapping(const DbgBuffer& bufferDbg, const CPUAccess access);
+        void LintPipelineCreation();
 
         template <typename T, typename TBase>
         void ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry);
@@ -116,6 +132,7 @@ class DbgRenderSystem final : public RenderSystem
 
         RenderingProfiler*                      profiler_   = nullptr;
         RenderingDebugger*                      debugger_   = nullptr;
+        std::unique_ptr<DbgCapture>             capture_;
 
         const RenderingCapabilities&            caps_;
         const RenderingFeatures&                features_;
@@ -125,6 +142,8 @@ class DbgRenderSystem final : public RenderSystem
 
         HWObjectContainer<DbgSwapChain>         swapChains_;
         HWObjectInstance<DbgCommandQueue>       commandQueue_;
+        HWObjectInstance<DbgCommandQueue>       computeQueue_;
+        HWObjectInstance<DbgCommandQueue>       copyQueue_;
         HWObjectContainer<DbgCommandBuffer>     commandBuffers_;
         HWObjectContainer<DbgBuffer>            buffers_;
         HWObjectContainer<DbgBufferArray>       bufferArrays_;
@@ -137,6 +156,11 @@ class DbgRenderSystem final : public RenderSystem
         HWObjectContainer<DbgResourceHeap>      resourceHeaps_;
         //HWObjectContainer<DbgSampler>           samplers_;
         HWObjectContainer<DbgQueryHeap>         queryHeaps_;
+        HWObjectContainer<DbgAccelerationStructure> accelStructs_;
+
+        /* ----- Validation ----- */
+
+        std::unique_ptr<DbgValidationWorker>    validationWorker_;  // Declared last, so pending validations are finished before any object is destroyed
 
 };
 
@@ -0,0 +1,308 @@
+/*
+ * DbgScopeProfiler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "DbgScopeProfiler.h"
+#include "../HostTrace.h"
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandQueue.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/QueryHeap.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Number of timestamp and pipeline statistics queries per heap.
+static constexpr std::uint32_t g_scopeQueryHeapSize = 64;
+
+// Maximum number of batches that are waiting for their query results. Older batches are delivered without GPU times.
+static constexpr std::size_t g_maxPendingScopeBatches = 8;
+
+static void AccumulatePipelineStatistics(QueryPipelineStatistics& dst, const QueryPipelineStatistics& src)
+{
+    dst.inputAssemblyVertices           += src.inputAssemblyVertices;
+    dst.inputAssemblyPrimitives         += src.inputAssemblyPrimitives;
+    dst.vertexShaderInvocations         += src.vertexShaderInvocations;
+    dst.geometryShaderInvocations       += src.geometryShaderInvocations;
+    dst.geometryShaderPrimitives        += src.geometryShaderPrimitives;
+    dst.clippingInvocations             += src.clippingInvocations;
+    dst.clippingPrimitives              += src.clippingPrimitives;
+    dst.fragmentShaderInvocations       += src.fragmentShaderInvocations;
+    dst.tessControlShaderInvocations    += src.tessControlShaderInvocations;
+    dst.tessEvaluationShaderInvocations += src.tessEvaluationShaderInvocations;
+    dst.computeShaderInvocations        += src.computeShaderInvocations;
+}
+
+DbgScopeProfiler::DbgScopeProfiler(
+    RenderSystem&   renderSystemInstance,
+    CommandQueue&   commandQueueInstance,
+    CommandBuffer&  commandBufferInstance)
+:
+    renderSystem_        { renderSystemInstance  },
+    commandQueue_        { commandQueueInstance  },
+    commandBuffer_       { commandBufferInstance },
+    statisticsSupported_ { renderSystemInstance.GetRenderingCaps().features.hasPipelineStatistics }
+{
+}
+
+DbgScopeProfiler::~DbgScopeProfiler()
+{
+    for (Batch& batch : pendingBatches_)
+    {
+        freeQueryHeaps_.insert(freeQueryHeaps_.end(), batch.queryHeaps.begin(), batch.queryHeaps.end());
+        freeStatisticsHeaps_.insert(freeStatisticsHeaps_.end(), batch.statisticsHeaps.begin(), batch.statisticsHeaps.end());
+    }
+    freeQueryHeaps_.insert(freeQueryHeaps_.end(), currentBatch_.queryHeaps.begin(), currentBatch_.queryHeaps.end());
+    freeStatisticsHeaps_.insert(freeStatisticsHeaps_.end(), currentBatch_.statisticsHeaps.begin(), currentBatch_.statisticsHeaps.end());
+    for (QueryHeap* queryHeap : freeQueryHeaps_)
+        renderSystem_.Release(*queryHeap);
+    for (QueryHeap* queryHeap : freeStatisticsHeaps_)
+        renderSystem_.Release(*queryHeap);
+}
+
+void DbgScopeProfiler::Begin(bool pipelineStatisticsEnabled)
+{
+    /* Schedule previous batch if the command buffer is encoded again without End() */
+    if (!currentBatch_.records.empty())
+        End();
+
+    statisticsEnabled_ = (pipelineStatisticsEnabled && statisticsSupported_);
+}
+
+void DbgScopeProfiler::End()
+{
+    /* Close all scopes that have not been popped */
+    while (!scopeStack_.empty())
+        PopScope();
+
+    if (!currentBatch_.records.empty())
+    {
+        pendingBatches_.push_back(std::move(currentBatch_));
+        currentBatch_ = Batch{};
+    }
+}
+
+void DbgScopeProfiler::PushScope(const char* name)
+{
+    const std::uint32_t recordIndex = static_cast<std::uint32_t>(currentBatch_.records.size());
+
+    /* End pipeline statistics segment of the parent scope */
+    EndStatisticsSegment();
+
+    ProfileScopeRecord record;
+    {
+        record.name         = name;
+        record.parent       = (scopeStack_.empty() ? ~0u : scopeStack_.back());
+        record.depth        = static_cast<std::uint32_t>(scopeStack_.size());
+        record.cpuBeginTime = GetHostTimeInNanosecs();
+    }
+    currentBatch_.records.push_back(std::move(record));
+    scopeStack_.push_back(recordIndex);
+
+    /* Write beginning timestamp; ending timestamp is determined in PopScope() */
+    currentBatch_.timestamps.push_back(WriteTimestamp());
+    currentBatch_.timestamps.push_back(~0u);
+
+    BeginStatisticsSegment();
+}
+
+void DbgScopeProfiler::PopScope()
+{
+    if (scopeStack_.empty())
+        return;
+
+    EndStatisticsSegment();
+
+    const std::uint32_t recordIndex = scopeStack_.back();
+    scopeStack_.pop_back();
+
+    currentBatch_.timestamps[recordIndex * 2 + 1] = WriteTimestamp();
+    currentBatch_.records[recordIndex].cpuEndTime = GetHostTimeInNanosecs();
+
+    /* Continue pipeline statistics of the parent scope with a new segment */
+    if (!scopeStack_.empty())
+        BeginStatisticsSegment();
+}
+
+void DbgScopeProfiler::TakeRecords(std::vector<ProfileScopeRecord>& outRecords)
+{
+    /* Resolve pending batches in order until the first batch that is not available yet */
+    while (!pendingBatches_.empty())
+    {
+        Batch& batch = pendingBatches_.front();
+        if (!ResolveBatch(batch) && pendingBatches_.size() <= g_maxPendingScopeBatches)
+            break;
+        ReleaseBatch(batch);
+        pendingBatches_.pop_front();
+    }
+
+    /* Append resolved records and offset parent indices by the records that are already in the output */
+    const std::uint32_t parentOffset = static_cast<std::uint32_t>(outRecords.size());
+    for (ProfileScopeRecord& record : resolvedRecords_)
+    {
+        if (record.parent != ~0u)
+            record.parent += parentOffset;
+        outRecords.push_back(std::move(record));
+    }
+    resolvedRecords_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+QueryHeap* DbgScopeProfiler::AcquireQueryHeap(std::vector<QueryHeap*>& freeQueryHeaps, QueryType type)
+{
+    if (!freeQueryHeaps.empty())
+    {
+        QueryHeap* queryHeap = freeQueryHeaps.back();
+        freeQueryHeaps.pop_back();
+        return queryHeap;
+    }
+
+    QueryHeapDescriptor queryHeapDesc;
+    {
+        queryHeapDesc.type          = type;
+        queryHeapDesc.numQueries    = g_scopeQueryHeapSize;
+    }
+    return renderSystem_.CreateQueryHeap(queryHeapDesc);
+}
+
+std::uint32_t DbgScopeProfiler::WriteTimestamp()
+{
+    if (!timestampsSupported_)
+        return ~0u;
+
+    const std::uint32_t timestamp   = currentBatch_.numTimestamps;
+    const std::uint32_t heapIndex   = timestamp / g_scopeQueryHeapSize;
+
+    /* Take query heap from free list or create a new one */
+    if (heapIndex == currentBatch_.queryHeaps.size())
+    {
+        QueryHeap* queryHeap = AcquireQueryHeap(freeQueryHeaps_, QueryType::Timestamp);
+        if (queryHeap == nullptr)
+        {
+            /* Disable GPU times if the backend does not support timestamp queries */
+            timestampsSupported_ = false;
+            return ~0u;
+        }
+        currentBatch_.queryHeaps.push_back(queryHeap);
+    }
+
+    commandBuffer_.EndQuery(*currentBatch_.queryHeaps[heapIndex], timestamp % g_scopeQueryHeapSize);
+    ++currentBatch_.numTimestamps;
+
+    return timestamp;
+}
+
+void DbgScopeProfiler::BeginStatisticsSegment()
+{
+    if (!statisticsEnabled_)
+        return;
+
+    const std::uint32_t segment     = static_cast<std::uint32_t>(currentBatch_.segments.size());
+    const std::uint32_t heapIndex   = segment / g_scopeQueryHeapSize;
+
+    /* Take query heap from free list or create a new one */
+    if (heapIndex == currentBatch_.statisticsHeaps.size())
+    {
+        QueryHeap* queryHeap = AcquireQueryHeap(freeStatisticsHeaps_, QueryType::PipelineStatistics);
+        if (queryHeap == nullptr)
+        {
+            /* Disable pipeline statistics if the backend cannot create any more queries */
+            statisticsSupported_    = false;
+            statisticsEnabled_      = false;
+            return;
+        }
+        currentBatch_.statisticsHeaps.push_back(queryHeap);
+    }
+
+    commandBuffer_.BeginQuery(*currentBatch_.statisticsHeaps[heapIndex], segment % g_scopeQueryHeapSize);
+    currentBatch_.segments.push_back(scopeStack_.back());
+    statisticsSegmentOpen_ = true;
+}
+
+void DbgScopeProfiler::EndStatisticsSegment()
+{
+    if (!statisticsSegmentOpen_)
+        return;
+
+    const std::uint32_t segment = static_cast<std::uint32_t>(currentBatch_.segments.size()) - 1;
+    commandBuffer_.EndQuery(*currentBatch_.statisticsHeaps[segment / g_scopeQueryHeapSize], segment % g_scopeQueryHeapSize);
+    statisticsSegmentOpen_ = false;
+}
+
+bool DbgScopeProfiler::ResolveBatch(Batch& batch)
+{
+    /* Query all timestamps of this batch with one call per query heap */
+    std::vector<std::uint64_t> results(batch.numTimestamps, 0);
+
+    for_range(heapIndex, static_cast<std::uint32_t>(batch.queryHeaps.size()))
+    {
+        const std::uint32_t firstTimestamp  = heapIndex * g_scopeQueryHeapSize;
+        const std::uint32_t numTimestamps   = std::min(g_scopeQueryHeapSize, batch.numTimestamps - firstTimestamp);
+        if (!commandQueue_.QueryResult(*batch.queryHeaps[heapIndex], 0, numTimestamps, &results[firstTimestamp], numTimestamps * sizeof(std::uint64_t)))
+            return false;
+    }
+
+    /* Query all pipeline statistics of this batch with one call per query heap */
+    const std::uint32_t numSegments = static_cast<std::uint32_t>(batch.segments.size());
+    std::vector<QueryPipelineStatistics> statistics(numSegments);
+
+    for_range(heapIndex, static_cast<std::uint32_t>(batch.statisticsHeaps.size()))
+    {
+        const std::uint32_t firstSegment    = heapIndex * g_scopeQueryHeapSize;
+        const std::uint32_t numQueries      = std::min(g_scopeQueryHeapSize, numSegments - firstSegment);
+        if (!commandQueue_.QueryResult(*batch.statisticsHeaps[heapIndex], 0, numQueries, &statistics[firstSegment], numQueries * sizeof(QueryPipelineStatistics)))
+            return false;
+    }
+
+    /* Assign timestamps to the scope records */
+    for_range(i, batch.records.size())
+    {
+        const std::uint32_t beginTimestamp  = batch.timestamps[i * 2];
+        const std::uint32_t endTimestamp    = batch.timestamps[i * 2 + 1];
+        if (beginTimestamp < batch.numTimestamps && endTimestamp < batch.numTimestamps)
+        {
+            batch.records[i].gpuBeginTime   = results[beginTimestamp];
+            batch.records[i].gpuEndTime     = results[endTimestamp];
+        }
+    }
+
+    /* Accumulate pipeline statistics of each segment into its scope and all parent scopes */
+    for_range(segment, numSegments)
+    {
+        for (std::uint32_t recordIndex = batch.segments[segment]; recordIndex != ~0u; recordIndex = batch.records[recordIndex].parent)
+            AccumulatePipelineStatistics(batch.records[recordIndex].pipelineStatistics, statistics[segment]);
+    }
+
+    return true;
+}
+
+void DbgScopeProfiler::ReleaseBatch(Batch& batch)
+{
+    const std::uint32_t parentOffset = static_cast<std::uint32_t>(resolvedRecords_.size());
+    for (ProfileScopeRecord& record : batch.records)
+    {
+        if (record.parent != ~0u)
+            record.parent += parentOffset;
+        resolvedRecords_.push_back(std::move(record));
+    }
+    freeQueryHeaps_.insert(freeQueryHeaps_.end(), batch.queryHeaps.begin(), batch.queryHeaps.end());
+    freeStatisticsHeaps_.insert(freeStatisticsHeaps_.end(), batch.statisticsHeaps.begin(), batch.statisticsHeaps.end());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
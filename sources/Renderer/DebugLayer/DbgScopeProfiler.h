@@ -0,0 +1,120 @@
+/*
+ * DbgScopeProfiler.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_DBG_SCOPE_PROFILER_H
+#define LLGL_DBG_SCOPE_PROFILER_H
+
+
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <vector>
+#include <deque>
+
+
+namespace LLGL
+{
+
+
+/*
+Records the CPU and GPU times of nested debug groups with two timestamp queries per scope.
+Optionally, pipeline statistics are recorded for each segment between two consecutive scope boundaries,
+since queries of the same type cannot be nested, and then accumulated into the scope of each segment and all its parents.
+Query results are resolved without stalling the CPU, i.e. the records of a command buffer are only delivered
+once the GPU has finished executing it. Query heaps are recycled after their batch has been resolved.
+*/
+class DbgScopeProfiler
+{
+
+    public:
+
+        DbgScopeProfiler(
+            RenderSystem&   renderSystemInstance,
+            CommandQueue&   commandQueueInstance,
+            CommandBuffer&  commandBufferInstance
+        );
+        ~DbgScopeProfiler();
+
+        DbgScopeProfiler(const DbgScopeProfiler&) = delete;
+        DbgScopeProfiler& operator = (const DbgScopeProfiler&) = delete;
+
+        // Starts a new batch of scope records for the next command buffer encoding.
+        void Begin(bool pipelineStatisticsEnabled);
+
+        // Closes all remaining scopes and schedules the current batch to be resolved.
+        void End();
+
+        // Pushes a new scope and writes its beginning timestamp.
+        void PushScope(const char* name);
+
+        // Pops the current scope and writes its ending timestamp.
+        void PopScope();
+
+        // Appends all records of resolved batches to the specified output container.
+        void TakeRecords(std::vector<ProfileScopeRecord>& outRecords);
+
+    private:
+
+        struct Batch
+        {
+            std::vector<ProfileScopeRecord> records;
+            std::vector<std::uint32_t>      timestamps;         // Beginning and ending timestamp index for each record.
+            std::uint32_t                   numTimestamps       = 0;
+            std::vector<QueryHeap*>         queryHeaps;
+            std::vector<std::uint32_t>      segments;           // Record index for each pipeline statistics query.
+            std::vector<QueryHeap*>         statisticsHeaps;
+        };
+
+    private:
+
+        // Returns a query heap of the specified type from the free list or creates a new one. Returns null if the query type is not supported.
+        QueryHeap* AcquireQueryHeap(std::vector<QueryHeap*>& freeQueryHeaps, QueryType type);
+
+        // Writes the next timestamp of the current batch and returns its index.
+        std::uint32_t WriteTimestamp();
+
+        // Begins a new pipeline statistics query for the current scope.
+        void BeginStatisticsSegment();
+
+        // Ends the current pipeline statistics query if there is one.
+        void EndStatisticsSegment();
+
+        // Tries to resolve all queries of the specified batch. Returns false if not all query results are available yet.
+        bool ResolveBatch(Batch& batch);
+
+        // Moves the records of the specified batch into the resolved records and recycles its query heaps.
+        void ReleaseBatch(Batch& batch);
+
+    private:
+
+        RenderSystem&                   renderSystem_;
+        CommandQueue&                   commandQueue_;
+        CommandBuffer&                  commandBuffer_;
+
+        std::vector<QueryHeap*>         freeQueryHeaps_;
+        std::vector<QueryHeap*>         freeStatisticsHeaps_;
+        bool                            timestampsSupported_    = true;
+        bool                            statisticsSupported_    = false;
+        bool                            statisticsEnabled_      = false;
+        bool                            statisticsSegmentOpen_  = false;
+
+        Batch                           currentBatch_;
+        std::deque<Batch>               pendingBatches_;
+        std::vector<std::uint32_t>      scopeStack_;
+        std::vector<ProfileScopeRecord> resolvedRecords_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,8 @@
 
 #include "DbgSwapChain.h"
 #include "DbgCore.h"
+#include "DbgCapture.h"
+#include <LLGL/RenderingDebugger.h>
 #include "../../Core/CoreUtils.h"
 
 
@@ -36,9 +38,11 @@ static RenderPassDescriptor MakeRenderPassDesc(const SwapChain& swapChain)
     return renderPassDesc;
 }
 
-DbgSwapChain::DbgSwapChain(SwapChain& instance, const SwapChainDescriptor& desc) :
-    instance { instance },
-    desc     { desc     }
+DbgSwapChain::DbgSwapChain(SwapChain& instance, const SwapChainDescriptor& desc, RenderingDebugger* debugger, DbgCapture* capture) :
+    instance  { instance },
+    desc      { desc     },
+    debugger_ { debugger },
+    capture_  { capture  }
 {
     ShareSurfaceAndConfig(instance);
     if (const auto* renderPass = instance.GetRenderPass())
@@ -53,6 +57,18 @@ void DbgSwapChain::SetName(const char* name)
 void DbgSwapChain::Present()
 {
     instance.Present();
+    NotifyPresented();
+}
+
+void DbgSwapChain::NotifyPresented()
+{
+    if (debugger_ != nullptr)
+        debugger_->NotifyFramePresented();
+    if (capture_ != nullptr)
+    {
+        capture_->RecordPresent(*this);
+        capture_->Poll(true);
+    }
 }
 
 std::uint32_t DbgSwapChain::GetCurrentSwapIndex() const
@@ -85,11 +101,31 @@ bool DbgSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
     return instance.SetVsyncInterval(vsyncInterval);
 }
 
+bool DbgSwapChain::SetMaxFrameLatency(std::uint32_t maxFrameLatency)
+{
+    return instance.SetMaxFrameLatency(maxFrameLatency);
+}
+
+bool DbgSwapChain::IsPresentModeSupported(PresentMode presentMode) const
+{
+    return instance.IsPresentModeSupported(presentMode);
+}
+
 const RenderPass* DbgSwapChain::GetRenderPass() const
 {
     return renderPass_.get();
 }
 
+void DbgSwapChain::SetActiveExtent(const Extent2D& extent)
+{
+    instance.SetActiveExtent(extent);
+}
+
+Extent2D DbgSwapChain::GetActiveExtent() const
+{
+    return instance.GetActiveExtent();
+}
+
 bool DbgSwapChain::ResizeBuffersPrimary(const Extent2D& resolution)
 {
     return instance.ResizeBuffers(resolution);
@@ -20,6 +20,8 @@ namespace LLGL
 
 
 class DbgBuffer;
+class DbgCapture;
+class RenderingDebugger;
 
 class DbgSwapChain final : public SwapChain
 {
@@ -38,12 +40,20 @@ class DbgSwapChain final : public SwapChain
         Format GetDepthStencilFormat() const override;
 
         bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+        bool SetMaxFrameLatency(std::uint32_t maxFrameLatency) override;
+        bool IsPresentModeSupported(PresentMode presentMode) const override;
 
         const RenderPass* GetRenderPass() const override;
 
+        void SetActiveExtent(const Extent2D& extent) override;
+        Extent2D GetActiveExtent() const override;
+
     public:
 
-        DbgSwapChain(SwapChain& instance, const SwapChainDescriptor& desc);
+        DbgSwapChain(SwapChain& instance, const SwapChainDescriptor& desc, RenderingDebugger* debugger, DbgCapture* capture);
+
+        // Notifies the debugger and capture that the instance has been presented, either by Present or by CommandQueue::Present.
+        void NotifyPresented();
 
     public:
 
@@ -57,7 +67,9 @@ class DbgSwapChain final : public SwapChain
 
     private:
 
-        std::unique_ptr<DbgRenderPass> renderPass_;
+        std::unique_ptr<DbgRenderPass>  renderPass_;
+        RenderingDebugger*              debugger_   = nullptr;
+        DbgCapture*                     capture_    = nullptr;
 
 };
 
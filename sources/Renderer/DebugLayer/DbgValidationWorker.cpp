@@ -0,0 +1,180 @@
+/*
+ * DbgValidationWorker.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "DbgValidationWorker.h"
+#include <utility>
+
+
+namespace LLGL
+{
+
+
+/*
+ * DbgValidationLog class
+ */
+
+void DbgValidationLog::Append(
+    const DbgDrawRecord&    record,
+    DbgBuffer* const *      vertexBuffers,
+    Resource* const *       resources)
+{
+    records_.push_back(record);
+    DbgDrawRecord& entry = records_.back();
+
+    /* Only copy the bindings the record is validated against */
+    if ((record.flags & DbgDrawValidation::VertexLayout) != 0 && record.numVertexBuffers > 0)
+    {
+        entry.firstVertexBuffer = vertexBuffers_.size();
+        vertexBuffers = vertexBuffers + record.firstVertexBuffer;
+        vertexBuffers_.insert(vertexBuffers_.end(), vertexBuffers, vertexBuffers + record.numVertexBuffers);
+    }
+    else
+    {
+        entry.firstVertexBuffer = 0;
+        entry.numVertexBuffers  = 0;
+    }
+
+    if ((record.flags & DbgDrawValidation::BindingTable) != 0 && record.numResources > 0)
+    {
+        entry.firstResource = resources_.size();
+        resources = resources + record.firstResource;
+        resources_.insert(resources_.end(), resources, resources + record.numResources);
+    }
+    else
+        entry.firstResource = 0;
+}
+
+std::uint32_t DbgValidationLog::AppendDebugGroup(const std::string& name)
+{
+    debugGroups_.push_back(name);
+    return static_cast<std::uint32_t>(debugGroups_.size());
+}
+
+void DbgValidationLog::Validate(DbgDrawValidator& validator) const
+{
+    for (const DbgDrawRecord& record : records_)
+    {
+        const char* groupName = (record.debugGroup > 0 ? debugGroups_[record.debugGroup - 1].c_str() : "");
+        validator.ValidateInContext(record, vertexBuffers_.data(), resources_.data(), groupName);
+    }
+}
+
+void DbgValidationLog::Clear()
+{
+    records_.clear();
+    vertexBuffers_.clear();
+    resources_.clear();
+    debugGroups_.clear();
+}
+
+
+/*
+ * DbgValidationWorker class
+ */
+
+DbgValidationWorker::DbgValidationWorker(RenderingDebugger& debugger) :
+    debugger_ { debugger }
+{
+}
+
+DbgValidationWorker::~DbgValidationWorker()
+{
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        stop_ = true;
+    }
+    queueSignal_.notify_one();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void DbgValidationWorker::Submit(DbgValidationLog& log)
+{
+    if (log.Empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+
+        queue_.push_back(std::move(log));
+
+        /* Recycle memory of logs that have already been validated */
+        if (!freeLogs_.empty())
+        {
+            log = std::move(freeLogs_.back());
+            freeLogs_.pop_back();
+        }
+        else
+            log = DbgValidationLog{};
+
+        if (!thread_.joinable())
+            thread_ = std::thread{ &DbgValidationWorker::ThreadMain, this };
+    }
+    queueSignal_.notify_one();
+}
+
+void DbgValidationWorker::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    idleSignal_.wait(
+        lock,
+        [this]() -> bool
+        {
+            return (queue_.empty() && !busy_);
+        }
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void DbgValidationWorker::ThreadMain()
+{
+    DbgDrawValidator validator{ &debugger_ };
+
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    for (;;)
+    {
+        queueSignal_.wait(
+            lock,
+            [this]() -> bool
+            {
+                return (stop_ || !queue_.empty());
+            }
+        );
+
+        /* Validate all pending logs before the worker is stopped, so no report is lost */
+        if (queue_.empty())
+            break;
+
+        DbgValidationLog log = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+
+        lock.unlock();
+        {
+            log.Validate(validator);
+            log.Clear();
+        }
+        lock.lock();
+
+        freeLogs_.push_back(std::move(log));
+        busy_ = false;
+
+        if (queue_.empty())
+            idleSignal_.notify_all();
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
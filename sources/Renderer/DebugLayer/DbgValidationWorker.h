@@ -0,0 +1,110 @@
+/*
+ * DbgValidationWorker.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_DBG_VALIDATION_WORKER_H
+#define LLGL_DBG_VALIDATION_WORKER_H
+
+
+#include "DbgDrawValidator.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Compact log of the draw and dispatch commands of a command buffer encoding that are validated asynchronously.
+Vertex buffers, resource bindings, and debug groups are only appended when they have changed since the last record.
+*/
+class DbgValidationLog
+{
+
+    public:
+
+        // Appends a record that is validated against the specified vertex buffers and resource bindings if it has the respective validation flag.
+        void Append(
+            const DbgDrawRecord&    record,
+            DbgBuffer* const *      vertexBuffers,
+            Resource* const *       resources
+        );
+
+        // Appends a new debug group and returns the index to refer to it in DbgDrawRecord::debugGroup.
+        std::uint32_t AppendDebugGroup(const std::string& name);
+
+        // Validates all records of this log in the order they were appended.
+        void Validate(DbgDrawValidator& validator) const;
+
+        // Clears all records but keeps the allocated memory.
+        void Clear();
+
+        // Returns true if this log has no records.
+        inline bool Empty() const
+        {
+            return records_.empty();
+        }
+
+    private:
+
+        std::vector<DbgDrawRecord>  records_;
+        std::vector<DbgBuffer*>     vertexBuffers_;
+        std::vector<Resource*>      resources_;
+        std::vector<std::string>    debugGroups_;
+
+};
+
+/*
+Worker thread that validates the logs of command buffer encodings with DebugValidationLevel::Asynchronous.
+The thread is started with the first submitted log and joined when the worker is destroyed.
+*/
+class DbgValidationWorker
+{
+
+    public:
+
+        DbgValidationWorker(RenderingDebugger& debugger);
+        ~DbgValidationWorker();
+
+        // Moves the specified log into the queue of this worker and replaces it with an empty log whose memory is recycled.
+        void Submit(DbgValidationLog& log);
+
+        // Blocks until all submitted logs have been validated. Must be called before any object that these logs refer to is released.
+        void WaitIdle();
+
+    private:
+
+        void ThreadMain();
+
+    private:
+
+        RenderingDebugger&              debugger_;
+
+        std::mutex                      mutex_;
+        std::condition_variable         queueSignal_;
+        std::condition_variable         idleSignal_;
+        std::deque<DbgValidationLog>    queue_;
+        std::vector<DbgValidationLog>   freeLogs_;
+        bool                            busy_       = false;    // Worker is validating a log that has already been removed from the queue
+        bool                            stop_       = false;
+        std::thread                     thread_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
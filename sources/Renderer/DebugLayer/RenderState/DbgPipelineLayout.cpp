@@ -7,6 +7,7 @@
 
 #include "DbgPipelineLayout.h"
 #include "../DbgCore.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -44,6 +45,33 @@ std::uint32_t DbgPipelineLayout::GetNumUniforms() const
     return instance.GetNumUniforms();
 }
 
+std::uint32_t DbgPipelineLayout::GetNumHeapDescriptors() const
+{
+    if (!desc.bindlessHeap)
+        return static_cast<std::uint32_t>(desc.heapBindings.size());
+
+    std::uint32_t numDescriptors = 0;
+    for (const auto& binding : desc.heapBindings)
+        numDescriptors += std::max(1u, binding.arraySize);
+    return numDescriptors;
+}
+
+const BindingDescriptor& DbgPipelineLayout::GetHeapBindingForDescriptor(std::uint32_t descriptor) const
+{
+    if (!desc.bindlessHeap)
+        return desc.heapBindings[descriptor];
+
+    /* Find heap binding whose array range contains the specified descriptor */
+    for (const auto& binding : desc.heapBindings)
+    {
+        const std::uint32_t numElements = std::max(1u, binding.arraySize);
+        if (descriptor < numElements)
+            return binding;
+        descriptor -= numElements;
+    }
+    return desc.heapBindings.back();
+}
+
 
 } // /namespace LLGL
 
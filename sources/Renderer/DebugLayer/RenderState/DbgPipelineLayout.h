@@ -33,6 +33,12 @@ class DbgPipelineLayout final : public PipelineLayout
 
         DbgPipelineLayout(PipelineLayout& instance, const PipelineLayoutDescriptor& desc);
 
+        // Returns the number of descriptors per set in a resource heap. For bindless heaps, this is the sum of all array elements.
+        std::uint32_t GetNumHeapDescriptors() const;
+
+        // Returns the heap binding the specified descriptor (per set) in a resource heap refers to.
+        const BindingDescriptor& GetHeapBindingForDescriptor(std::uint32_t descriptor) const;
+
     public:
 
         PipelineLayout&                 instance;
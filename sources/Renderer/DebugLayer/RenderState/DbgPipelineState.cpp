@@ -57,6 +57,16 @@ const Report* DbgPipelineState::GetReport() const
     return instance.GetReport();
 }
 
+bool DbgPipelineState::IsReady() const
+{
+    return instance.IsReady();
+}
+
+void DbgPipelineState::Wait()
+{
+    instance.Wait();
+}
+
 
 } // /namespace LLGL
 
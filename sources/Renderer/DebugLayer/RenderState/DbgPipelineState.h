@@ -27,6 +27,8 @@ class DbgPipelineState final : public PipelineState
 
         void SetName(const char* name) override;
         const Report* GetReport() const override;
+        bool IsReady() const override;
+        void Wait() override;
 
     public:
 
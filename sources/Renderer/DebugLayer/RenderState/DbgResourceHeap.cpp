@@ -18,7 +18,7 @@ namespace LLGL
 static std::uint32_t GetNumPipelineLayoutBindings(const PipelineLayout* pipelineLayout)
 {
     auto pipelineLayoutDbg = LLGL_CAST(const DbgPipelineLayout*, pipelineLayout);
-    return std::max(1u, static_cast<std::uint32_t>(pipelineLayoutDbg->desc.heapBindings.size()));
+    return std::max(1u, pipelineLayoutDbg->GetNumHeapDescriptors());
 }
 
 DbgResourceHeap::DbgResourceHeap(ResourceHeap& instance, const ResourceHeapDescriptor& desc) :
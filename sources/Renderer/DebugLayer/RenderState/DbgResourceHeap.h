@@ -12,6 +12,7 @@
 #include <LLGL/ResourceHeap.h>
 #include <LLGL/ResourceHeapFlags.h>
 #include <string>
+#include <vector>
 
 
 namespace LLGL
@@ -40,6 +41,7 @@ class DbgResourceHeap final : public ResourceHeap
         const ResourceHeapDescriptor    desc;
         std::string                     label;
         const std::uint32_t             numBindings = 1;
+        std::vector<ResourceViewDescriptor> resourceViews; // Current resource views with debug layer objects; only used for captures
 
 };
 
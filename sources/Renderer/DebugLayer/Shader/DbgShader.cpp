@@ -7,16 +7,105 @@
 
 #include "DbgShader.h"
 #include "../DbgCore.h"
+#include <fstream>
+#include <iterator>
 
 
 namespace LLGL
 {
 
 
+static std::string ReadShaderFile(const char* filename, std::ios_base::openmode mode)
+{
+    std::ifstream file{ filename, mode };
+    if (!file.good())
+        return {};
+    return std::string{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+// Returns the shader code or binary. Files are read into memory, so the shader can be recreated after the files have changed (e.g. for a capture).
+static std::string CopyShaderSource(const ShaderDescriptor& desc)
+{
+    if (desc.source == nullptr)
+        return {};
+
+    switch (desc.sourceType)
+    {
+        case ShaderSourceType::CodeString:
+            return (desc.sourceSize > 0 ? std::string{ desc.source, desc.sourceSize } : std::string{ desc.source });
+        case ShaderSourceType::BinaryBuffer:
+            return std::string{ desc.source, desc.sourceSize };
+        case ShaderSourceType::CodeFile:
+            return ReadShaderFile(desc.source, std::ios_base::in);
+        case ShaderSourceType::BinaryFile:
+            return ReadShaderFile(desc.source, std::ios_base::in | std::ios_base::binary);
+    }
+
+    return {};
+}
+
+static std::vector<std::string> CopyShaderDefineStrings(const ShaderMacro* defines)
+{
+    std::vector<std::string> defineStrings;
+    if (defines != nullptr)
+    {
+        for (; defines->name != nullptr; ++defines)
+        {
+            defineStrings.push_back(defines->name);
+            defineStrings.push_back(defines->definition != nullptr ? defines->definition : "");
+        }
+    }
+    return defineStrings;
+}
+
+// Returns the list of shader macros that refer to the specified strings in pairs of name and definition, including the terminating null entry.
+static std::vector<ShaderMacro> MakeShaderDefines(const ShaderMacro* defines, const std::vector<std::string>& defineStrings)
+{
+    std::vector<ShaderMacro> outDefines;
+    if (defines != nullptr)
+    {
+        outDefines.reserve(defineStrings.size() / 2 + 1);
+        for (std::size_t i = 0; i + 1 < defineStrings.size(); i += 2)
+            outDefines.push_back(ShaderMacro{ defineStrings[i].c_str(), defineStrings[i + 1].c_str() });
+        outDefines.push_back(ShaderMacro{});
+    }
+    return outDefines;
+}
+
+static ShaderDescriptor CopyShaderDescWithOwnedStrings(
+    const ShaderDescriptor&         inDesc,
+    const std::string&              source,
+    const std::string&              entryPoint,
+    const std::string&              profile,
+    const std::vector<ShaderMacro>& defines)
+{
+    auto outDesc = inDesc;
+    {
+        if (inDesc.source != nullptr)
+        {
+            outDesc.source      = source.c_str();
+            outDesc.sourceSize  = source.size();
+            if (inDesc.sourceType == ShaderSourceType::CodeFile)
+                outDesc.sourceType = ShaderSourceType::CodeString;
+            else if (inDesc.sourceType == ShaderSourceType::BinaryFile)
+                outDesc.sourceType = ShaderSourceType::BinaryBuffer;
+        }
+        outDesc.entryPoint  = (inDesc.entryPoint != nullptr ? entryPoint.c_str() : nullptr);
+        outDesc.profile     = (inDesc.profile != nullptr ? profile.c_str() : nullptr);
+        outDesc.defines     = (inDesc.defines != nullptr ? defines.data() : nullptr);
+    }
+    return outDesc;
+}
+
 DbgShader::DbgShader(Shader& instance, const ShaderDescriptor& desc) :
-    Shader    { desc.type },
-    instance  { instance  },
-    desc      { desc      }
+    Shader          { desc.type                                                                     },
+    source_         { CopyShaderSource(desc)                                                        },
+    entryPoint_     { desc.entryPoint != nullptr ? desc.entryPoint : ""                             },
+    profile_        { desc.profile != nullptr ? desc.profile : ""                                   },
+    defineStrings_  { CopyShaderDefineStrings(desc.defines)                                         },
+    defines_        { MakeShaderDefines(desc.defines, defineStrings_)                               },
+    instance        { instance                                                                      },
+    desc            { CopyShaderDescWithOwnedStrings(desc, source_, entryPoint_, profile_, defines_) }
 {
     if (GetType() == ShaderType::Vertex)
         QueryInstanceAndVertexIDs();
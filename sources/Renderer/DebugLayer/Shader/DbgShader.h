@@ -12,6 +12,7 @@
 #include <LLGL/Shader.h>
 #include <LLGL/RenderingDebugger.h>
 #include <string>
+#include <vector>
 
 
 namespace LLGL
@@ -21,6 +22,13 @@ namespace LLGL
 class DbgShader final : public Shader
 {
 
+        // Owned copies of all strings of the shader descriptor, which must be declared before 'desc'.
+        const std::string               source_;
+        const std::string               entryPoint_;
+        const std::string               profile_;
+        const std::vector<std::string>  defineStrings_;
+        const std::vector<ShaderMacro>  defines_;
+
     public:
 
         #include <LLGL/Backend/Shader.inl>
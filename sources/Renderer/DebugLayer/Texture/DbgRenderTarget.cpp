@@ -103,6 +103,16 @@ const RenderPass* DbgRenderTarget::GetRenderPass() const
     return renderPass_.get();
 }
 
+void DbgRenderTarget::SetActiveExtent(const Extent2D& extent)
+{
+    instance.SetActiveExtent(extent);
+}
+
+Extent2D DbgRenderTarget::GetActiveExtent() const
+{
+    return instance.GetActiveExtent();
+}
+
 
 } // /namespace LLGL
 
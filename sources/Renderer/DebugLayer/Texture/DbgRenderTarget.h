@@ -32,6 +32,9 @@ class DbgRenderTarget final : public RenderTarget
 
         void SetName(const char* name) override;
 
+        void SetActiveExtent(const Extent2D& extent) override;
+        Extent2D GetActiveExtent() const override;
+
     public:
 
         DbgRenderTarget(RenderTarget& instance, RenderingDebugger* debugger, const RenderTargetDescriptor& desc);
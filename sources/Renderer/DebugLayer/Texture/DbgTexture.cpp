@@ -70,6 +70,11 @@ SubresourceFootprint DbgTexture::GetSubresourceFootprint(std::uint32_t mipLevel)
     return instance.GetSubresourceFootprint(mipLevel);
 }
 
+Extent3D DbgTexture::GetSparseTileExtent() const
+{
+    return instance.GetSparseTileExtent();
+}
+
 
 } // /namespace LLGL
 
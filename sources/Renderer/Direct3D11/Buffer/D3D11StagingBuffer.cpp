@@ -81,14 +81,20 @@ bool D3D11StagingBuffer::Capacity(UINT dataSize) const
 void D3D11StagingBuffer::Write(
     ID3D11DeviceContext*    context,
     const void*             data,
-    UINT                    dataSize)
+    UINT                    dataSize,
+    bool                    noOverwrite)
 {
     if (usage_ == D3D11_USAGE_DYNAMIC)
     {
-        /* D3D11_USAGE_DYNAMIC only supports map-write with discard */
+        /*
+        D3D11_USAGE_DYNAMIC only supports map-write with discard or no-overwrite.
+        The buffer is discarded whenever writing starts at the beginning again, so previous ranges that are still in flight are never overwritten.
+        */
+        const D3D11_MAP mapType = (noOverwrite && offset_ > 0 ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD);
+
         /* Update partial subresource by mapping buffer from GPU into CPU memory space */
         D3D11_MAPPED_SUBRESOURCE subresource;
-        if (SUCCEEDED(context->Map(GetNative(), 0, D3D11_MAP_WRITE_DISCARD, 0, &subresource)))
+        if (SUCCEEDED(context->Map(GetNative(), 0, mapType, 0, &subresource)))
         {
             ::memcpy(reinterpret_cast<char*>(subresource.pData) + offset_, data, dataSize);
             context->Unmap(GetNative(), 0);
@@ -106,9 +112,10 @@ void D3D11StagingBuffer::WriteAndIncrementOffset(
     ID3D11DeviceContext*    context,
     const void*             data,
     UINT                    dataSize,
-    UINT                    stride)
+    UINT                    stride,
+    bool                    noOverwrite)
 {
-    Write(context, data, dataSize);
+    Write(context, data, dataSize, noOverwrite);
     offset_ += std::max(dataSize, stride);
 }
 
@@ -44,11 +44,15 @@ class D3D11StagingBuffer
         // Returns true if the remaining buffer size can fit the specified data size.
         bool Capacity(UINT dataSize) const;
 
-        // Writes the specified data to the native D3D intermediate buffer at the current offset.
+        /*
+        Writes the specified data to the native D3D intermediate buffer at the current offset.
+        If 'noOverwrite' is true, dynamic buffers are only discarded when the offset is zero and mapped with D3D11_MAP_WRITE_NO_OVERWRITE otherwise.
+        */
         void Write(
             ID3D11DeviceContext*    context,
             const void*             data,
-            UINT                    dataSize
+            UINT                    dataSize,
+            bool                    noOverwrite = false
         );
 
         // Writes the specified data to the native D3D intermediate buffer and increments the write offset.
@@ -56,7 +60,8 @@ class D3D11StagingBuffer
             ID3D11DeviceContext*    context,
             const void*             data,
             UINT                    dataSize,
-            UINT                    stride = 0
+            UINT                    stride      = 0,
+            bool                    noOverwrite = false
         );
 
         // Returns the native ID3D11Buffer object.
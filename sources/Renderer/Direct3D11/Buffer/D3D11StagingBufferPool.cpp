@@ -7,6 +7,7 @@
 
 #include "D3D11StagingBufferPool.h"
 #include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
 
 
 namespace LLGL
@@ -29,25 +30,51 @@ D3D11StagingBufferPool::D3D11StagingBufferPool(
     UINT                    chunkSize,
     D3D11_USAGE             usage,
     UINT                    cpuAccessFlags,
-    UINT                    bindFlags)
+    UINT                    bindFlags,
+    bool                    noOverwrite)
 :
-    device_           { device                              },
-    context_          { context                             },
-    chunkSize_        { chunkSize                           },
-    usage_            { usage                               },
-    cpuAccessFlags_   { cpuAccessFlags                      },
-    bindFlags_        { bindFlags                           },
-    incrementOffsets_ { IsSegmentedStagingRequired(context) }
+    device_           { device                                             },
+    context_          { context                                            },
+    chunkSize_        { chunkSize                                          },
+    usage_            { usage                                              },
+    cpuAccessFlags_   { cpuAccessFlags                                     },
+    bindFlags_        { bindFlags                                          },
+    incrementOffsets_ { noOverwrite || IsSegmentedStagingRequired(context) },
+    noOverwrite_      { noOverwrite && usage == D3D11_USAGE_DYNAMIC        }
 {
 }
 
+void D3D11StagingBufferPool::SetTrimPolicy(UINT64 minSize, UINT trimFrames)
+{
+    minSize_    = minSize;
+    trimFrames_ = trimFrames;
+}
+
 void D3D11StagingBufferPool::Reset()
 {
+    /* Release chunks that were only needed for a burst of updates, e.g. during a loading screen */
+    if (!chunks_.empty())
+        peakNumChunks_ = std::max(peakNumChunks_, chunkIdx_ + 1);
+
+    if (trimFrames_ > 0 && ++numTrimFrames_ >= trimFrames_)
+    {
+        ReleaseChunks(peakNumChunks_);
+        peakNumChunks_ = 0;
+        numTrimFrames_ = 0;
+    }
+
     for (auto& chunk : chunks_)
         chunk.Reset();
     chunkIdx_ = 0;
 }
 
+UINT64 D3D11StagingBufferPool::Trim()
+{
+    peakNumChunks_ = 0;
+    numTrimFrames_ = 0;
+    return ReleaseChunks(0);
+}
+
 D3D11BufferRange D3D11StagingBufferPool::Write(const void* data, UINT dataSize, UINT alignment)
 {
     const auto alignedSize = GetAlignedSize(dataSize, alignment);
@@ -67,7 +94,7 @@ D3D11BufferRange D3D11StagingBufferPool::Write(const void* data, UINT dataSize,
     D3D11BufferRange range = { chunk.GetNative(), chunk.GetOffset(), alignedSize };
     {
         if (incrementOffsets_)
-            chunk.WriteAndIncrementOffset(context_, data, dataSize, alignedSize);
+            chunk.WriteAndIncrementOffset(context_, data, dataSize, alignedSize, noOverwrite_);
         else
             chunk.Write(context_, data, dataSize);
     }
@@ -85,6 +112,25 @@ void D3D11StagingBufferPool::AllocChunk(UINT minChunkSize)
     chunkIdx_ = chunks_.size() - 1;
 }
 
+UINT64 D3D11StagingBufferPool::ReleaseChunks(std::size_t minNumChunks)
+{
+    /* Keep leading chunks until both the number of chunks and the minimum size are satisfied */
+    std::size_t numChunks   = 0;
+    UINT64      keptSize    = 0;
+
+    while (numChunks < chunks_.size() && (numChunks < minNumChunks || keptSize < minSize_))
+        keptSize += chunks_[numChunks++].GetSize();
+
+    UINT64 releasedSize = 0;
+    for_subrange(i, numChunks, chunks_.size())
+        releasedSize += chunks_[i].GetSize();
+
+    chunks_.erase(chunks_.begin() + numChunks, chunks_.end());
+    chunkIdx_ = std::min(chunkIdx_, chunks_.size());
+
+    return releasedSize;
+}
+
 
 } // /namespace LLGL
 
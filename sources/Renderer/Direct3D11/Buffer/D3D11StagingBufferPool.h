@@ -26,6 +26,11 @@ struct D3D11BufferRange
     UINT            size;
 };
 
+/*
+Pool of intermediate buffer chunks that are reset with each command buffer recording.
+Chunks that have not been needed for a number of recordings are released again, but never below the minimum size of the pool.
+Chunks can be released while the GPU still reads from them, since command lists and the device context keep references to them.
+*/
 class D3D11StagingBufferPool
 {
 
@@ -37,12 +42,19 @@ class D3D11StagingBufferPool
             UINT                    chunkSize,
             D3D11_USAGE             usage           = D3D11_USAGE_STAGING,
             UINT                    cpuAccessFlags  = D3D11_CPU_ACCESS_WRITE | D3D11_CPU_ACCESS_READ,
-            UINT                    bindFlags       = 0
+            UINT                    bindFlags       = 0,
+            bool                    noOverwrite     = false
         );
 
-        // Resets all chunks in the pool.
+        // Specifies the minimum size (in bytes) that is retained when the pool is trimmed and the number of recordings between two trim checks. Zero disables automatic trimming.
+        void SetTrimPolicy(UINT64 minSize, UINT trimFrames);
+
+        // Resets all chunks in the pool. This also releases the chunks that have not been used in any of the recent recordings.
         void Reset();
 
+        // Releases all chunks down to the minimum size of the pool. Returns the number of bytes that are released.
+        UINT64 Trim();
+
         // Writes the specified data to the destination buffer using the staging pool.
         D3D11BufferRange Write(const void* data, UINT dataSize, UINT alignment = 0);
 
@@ -51,6 +63,9 @@ class D3D11StagingBufferPool
         // Allocates a new chunk with the specified minimal size.
         void AllocChunk(UINT minChunkSize);
 
+        // Releases all chunks after the specified number of chunks and the minimum size of the pool.
+        UINT64 ReleaseChunks(std::size_t minNumChunks);
+
     private:
 
         ID3D11Device*                   device_             = nullptr;
@@ -63,6 +78,12 @@ class D3D11StagingBufferPool
         UINT                            cpuAccessFlags_     = D3D11_CPU_ACCESS_WRITE | D3D11_CPU_ACCESS_READ;
         UINT                            bindFlags_          = 0;
         bool                            incrementOffsets_   = false;
+        bool                            noOverwrite_        = false;
+
+        UINT64                          minSize_            = 0;
+        UINT                            trimFrames_         = 120;
+        UINT                            numTrimFrames_      = 0;
+        std::size_t                     peakNumChunks_      = 0;    // Highest number of chunks used by a single recording since the last trim check.
 
 };
 
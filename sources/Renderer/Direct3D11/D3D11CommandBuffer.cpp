@@ -12,6 +12,8 @@
 #include "../DXCommon/DXTypes.h"
 #include "../CheckedCast.h"
 #include "../ResourceUtils.h"
+#include "../BufferUtils.h"
+#include "../FrameCounters.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include <LLGL/TypeInfo.h>
 #include "../../Core/CoreUtils.h"
@@ -68,6 +70,11 @@ D3D11CommandBuffer::D3D11CommandBuffer(
         hasDeferredContext_ = true;
         if ((desc.flags & CommandBufferFlags::Secondary) != 0)
             isSecondaryCmdBuffer_ = true;
+        if ((desc.flags & CommandBufferFlags::MultiSubmit) != 0)
+            isMultiSubmitCmdBuffer_ = true;
+
+        /* Only deferred contexts have a dedicated state manager; the one of the immediate context keeps its default trim policy */
+        stateMngr_->SetStagingBufferPoolTrimPolicy(desc.minStagingPoolSize, desc.stagingPoolTrimFrames);
     }
 
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
@@ -76,10 +83,20 @@ D3D11CommandBuffer::D3D11CommandBuffer(
     #endif
 }
 
+D3D11CommandBuffer::~D3D11CommandBuffer()
+{
+    // dummy; required to destroy the constants cache with its complete type
+}
+
 /* ----- Encoding ----- */
 
 void D3D11CommandBuffer::Begin()
 {
+    LLGL_FRAME_COUNTER_BEGIN();
+
+    /* Release previous command list before encoding a new one, since the staging buffers it refers to are about to be reused */
+    if (hasDeferredContext_)
+        commandList_.Reset();
     stateMngr_->ResetStagingBufferPools();
 }
 
@@ -87,8 +104,12 @@ void D3D11CommandBuffer::End()
 {
     if (hasDeferredContext_)
     {
-        /* Encode commands from deferred context into command list */
-        context_->FinishCommandList(TRUE, commandList_.ReleaseAndGetAddressOf());
+        /*
+        Encode commands from deferred context into command list. Don't restore the deferred context state,
+        since a command list always starts with the default state when it is executed, and invalidate the state cache accordingly.
+        */
+        context_->FinishCommandList(FALSE, commandList_.ReleaseAndGetAddressOf());
+        stateMngr_->ResetCachedStates();
     }
     ResetBindingStates();
 }
@@ -103,9 +124,16 @@ void D3D11CommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
             /* Execute encoded command list with immediate context */
             context_->ExecuteCommandList(commandList, TRUE);
         }
+        LLGL_FRAME_COUNTER_EXECUTE(cmdBufferD3D.GetFrameCounters());
     }
 }
 
+void D3D11CommandBuffer::TrimMemory()
+{
+    /* Chunks are reference counted by command lists and the device context, so they can be released while they are still in use */
+    stateMngr_->TrimStagingBufferPools();
+}
+
 /* ----- Blitting ----- */
 
 void D3D11CommandBuffer::UpdateBuffer(
@@ -114,8 +142,24 @@ void D3D11CommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferUpdates);
+
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
-    dstBufferD3D.WriteSubresource(context_.Get(), data, static_cast<UINT>(dataSize), static_cast<UINT>(dstOffset));
+
+    const UINT offset = static_cast<UINT>(dstOffset);
+    const UINT size   = static_cast<UINT>(dataSize);
+
+    if (dstBufferD3D.GetDXUsage() == D3D11_USAGE_DYNAMIC && offset == 0 && size == dstBufferD3D.GetSize())
+    {
+        /* Discard dynamic buffers that are updated entirely */
+        dstBufferD3D.WriteSubresource(context_.Get(), data, size, offset);
+    }
+    else
+    {
+        /* Copy all other updates from the dynamic buffer ring, so each update merely costs a memcpy and a GPU copy */
+        LLGL_ASSERT_RANGE(size + offset, dstBufferD3D.GetSize());
+        stateMngr_->UpdateBufferFromRing(dstBufferD3D.GetNative(), offset, data, size);
+    }
 }
 
 void D3D11CommandBuffer::CopyBuffer(
@@ -125,6 +169,8 @@ void D3D11CommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
     auto& srcBufferD3D = LLGL_CAST(D3D11Buffer&, srcBuffer);
     CD3D11_BOX box =     CD3D11_BOX(
@@ -145,15 +191,21 @@ void D3D11CommandBuffer::CopyBuffer(
 }
 
 // private
-void D3D11CommandBuffer::ClearWithIntermediateUAV(ID3D11Buffer* buffer, UINT offset, UINT size, const UINT (&valuesVec4)[4])
+void D3D11CommandBuffer::ClearWithIntermediateUAV(
+    ID3D11Buffer*   buffer,
+    UINT            offset,
+    UINT            size,
+    const UINT      (&valuesVec4)[4],
+    DXGI_FORMAT     format,
+    UINT            stride)
 {
     /* Create intermediate UAV for fill range */
     D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc;
     {
-        uavDesc.Format              = DXGI_FORMAT_R32_UINT;
+        uavDesc.Format              = format;
         uavDesc.ViewDimension       = D3D11_UAV_DIMENSION_BUFFER;
-        uavDesc.Buffer.FirstElement = offset / sizeof(UINT);
-        uavDesc.Buffer.NumElements  = size / sizeof(UINT);
+        uavDesc.Buffer.FirstElement = offset / stride;
+        uavDesc.Buffer.NumElements  = size / stride;
         uavDesc.Buffer.Flags        = 0;
     };
     ComPtr<ID3D11UnorderedAccessView> intermediateUAV;
@@ -163,6 +215,38 @@ void D3D11CommandBuffer::ClearWithIntermediateUAV(ID3D11Buffer* buffer, UINT off
     context_->ClearUnorderedAccessViewUint(intermediateUAV.Get(), valuesVec4);
 }
 
+// private
+void D3D11CommandBuffer::ClearWithIntermediateBuffer(
+    D3D11Buffer&    dstBufferD3D,
+    UINT            offset,
+    UINT            size,
+    const UINT      (&valuesVec4)[4],
+    DXGI_FORMAT     format,
+    UINT            stride)
+{
+    /* Create intermediate buffer with UAV */
+    D3D11_BUFFER_DESC bufferDesc;
+    {
+        bufferDesc.ByteWidth            = size;
+        bufferDesc.Usage                = D3D11_USAGE_DEFAULT;
+        bufferDesc.BindFlags            = D3D11_BIND_UNORDERED_ACCESS;
+        bufferDesc.CPUAccessFlags       = 0;
+        bufferDesc.MiscFlags            = 0;
+        bufferDesc.StructureByteStride  = stride;
+    }
+    ComPtr<ID3D11Buffer> intermediateBuffer;
+    device_->CreateBuffer(&bufferDesc, nullptr, &intermediateBuffer);
+
+    /* Fill destination buffer with intermediate UAV */
+    ClearWithIntermediateUAV(intermediateBuffer.Get(), 0, size, valuesVec4, format, stride);
+
+    /* Copy intermediate buffer into destination buffer */
+    if (offset == 0 && size == dstBufferD3D.GetSize())
+        context_->CopyResource(dstBufferD3D.GetNative(), intermediateBuffer.Get());
+    else
+        context_->CopySubresourceRegion(dstBufferD3D.GetNative(), 0, offset, 0, 0, intermediateBuffer.Get(), 0, nullptr);
+}
+
 // Internal use only (see D3D11CommandBuffer::CopyTextureFromBuffer)
 struct CopyTextureBufferCbuffer
 {
@@ -199,6 +283,179 @@ static TextureType ToArrayTextureType(const TextureType type)
     }
 }
 
+// Element layout of texture data for the builtin copy shaders (see D3D11CommandBuffer::CopyTextureFromBuffer).
+struct CopyTextureBufferLayout
+{
+    std::uint32_t   formatSize      = 0;        // Bytes per element, i.e. per texel or per compressed block
+    std::uint32_t   components      = 0;        // Unsigned integer components per element: 1, 2, 3, 4
+    std::uint32_t   componentBits   = 0;        // Bits per component: 8, 16, 32
+    std::uint32_t   blockSize       = 1;        // Width and height of each element in texels: 1 or 4 for block compressed formats
+    bool            isRaw           = false;    // Texture must be reinterpreted through an intermediate texture with an equivalent unsigned integer format
+    bool            isDepth         = false;    // Texture has a depth format, i.e. only entire subresources can be copied
+};
+
+/*
+Returns the element layout for the builtin copy shaders or false if the format is not supported.
+Formats without a component-wise unsigned integer equivalent are copied as raw elements instead,
+e.g. each BC1 block is copied as one element of DXGI_FORMAT_R32G32_UINT.
+*/
+static bool GetCopyTextureBufferLayout(const Format format, CopyTextureBufferLayout& outLayout)
+{
+    const FormatAttributes& formatAttribs = GetFormatAttribs(format);
+    if (formatAttribs.components == 0 || formatAttribs.bitSize == 0)
+        return false;
+
+    if ((formatAttribs.flags & FormatFlags::IsCompressed) != 0)
+    {
+        /* Copy 64-bit (BC1, BC4) and 128-bit (BC2, BC3, BC5, BC6H, BC7) blocks as R32G32_UINT and R32G32B32A32_UINT elements */
+        if (formatAttribs.bitSize != 64 && formatAttribs.bitSize != 128)
+            return false;
+        outLayout.formatSize    = formatAttribs.bitSize / 8;
+        outLayout.components    = outLayout.formatSize / 4;
+        outLayout.componentBits = 32;
+        outLayout.blockSize     = formatAttribs.blockWidth;
+        outLayout.isRaw         = true;
+    }
+    else if ((formatAttribs.flags & FormatFlags::IsPacked) != 0)
+    {
+        /* Only RGB9E5 can be reinterpreted as R32_UINT; other packed formats would have to be packed and unpacked by the shaders */
+        if (format == Format::RGB9E5Float)
+        {
+            outLayout.formatSize    = 4;
+            outLayout.components    = 1;
+            outLayout.componentBits = 32;
+            outLayout.isRaw         = true;
+        }
+        else
+            return false;
+    }
+    else if ((formatAttribs.flags & FormatFlags::HasStencil) != 0)
+    {
+        /* Depth-stencil formats have no unsigned integer equivalent with both aspects */
+        return false;
+    }
+    else if ((formatAttribs.flags & FormatFlags::HasDepth) != 0)
+    {
+        /* Copy D16 and D32 as R16_UINT and R32_UINT elements */
+        outLayout.formatSize    = formatAttribs.bitSize / 8;
+        outLayout.components    = 1;
+        outLayout.componentBits = formatAttribs.bitSize;
+        outLayout.isRaw         = true;
+        outLayout.isDepth       = true;
+    }
+    else
+    {
+        outLayout.formatSize    = formatAttribs.bitSize / 8;
+        outLayout.components    = formatAttribs.components;
+        outLayout.componentBits = formatAttribs.bitSize / formatAttribs.components;
+        outLayout.isRaw         =
+        (
+            /* An intermediate texture copy is required if the format is not unsigned integer or it is normalized */
+            (formatAttribs.flags & FormatFlags::IsUnsignedInteger) != FormatFlags::IsUnsignedInteger ||
+            (formatAttribs.flags & FormatFlags::IsNormalized) != 0
+        );
+    }
+
+    return true;
+}
+
+// Returns the extent in elements of the copy shaders, i.e. the number of blocks for compressed formats.
+static Extent3D GetCopyTextureBufferElementExtent(const Extent3D& extent, const CopyTextureBufferLayout& layout)
+{
+    return Extent3D
+    {
+        (extent.width  + layout.blockSize - 1) / layout.blockSize,
+        (extent.height + layout.blockSize - 1) / layout.blockSize,
+        extent.depth
+    };
+}
+
+// Returns the region for the intermediate texture. Depth textures can only be copied as entire subresources, so the intermediate texture must cover the entire MIP-map.
+static TextureRegion GetCopyTextureBufferIntermediateRegion(
+    const D3D11Texture&             textureD3D,
+    const TextureRegion&            region,
+    const Extent3D&                 elementExtent,
+    const CopyTextureBufferLayout&  layout)
+{
+    TextureRegion intermediateRegion = region;
+    intermediateRegion.offset = Offset3D{ 0, 0, 0 };
+    if (layout.isDepth)
+    {
+        const Extent3D mipExtent = textureD3D.GetMipExtent(region.subresource.baseMipLevel);
+        intermediateRegion.extent = Extent3D{ mipExtent.width, mipExtent.height, 1 };
+    }
+    else
+        intermediateRegion.extent = elementExtent;
+    return intermediateRegion;
+}
+
+// Copies the specified region between the texture and the intermediate texture; The intermediate texture is in units of copy elements.
+static void CopyTextureBufferIntermediateSubresources(
+    ID3D11DeviceContext*            context,
+    D3D11Texture&                   textureD3D,
+    const TextureRegion&            region,
+    const Extent3D&                 elementExtent,
+    const CopyTextureBufferLayout&  layout,
+    ID3D11Resource*                 intermediateTexture,
+    bool                            toIntermediate)
+{
+    const auto&     subresource = region.subresource;
+    const UINT      mipLevel    = subresource.baseMipLevel;
+    const Offset3D& offset      = region.offset;
+
+    for_range(i, subresource.numArrayLayers)
+    {
+        const UINT texSubresource           = D3D11CalcSubresource(mipLevel, subresource.baseArrayLayer + i, textureD3D.GetNumMipLevels());
+        const UINT intermediateSubresource  = D3D11CalcSubresource(0, i, 1);
+
+        if (layout.isDepth)
+        {
+            /* Depth-stencil resources can only be copied as entire subresources */
+            if (toIntermediate)
+                context->CopySubresourceRegion(intermediateTexture, intermediateSubresource, 0, 0, 0, textureD3D.GetNative().resource.Get(), texSubresource, nullptr);
+            else
+                context->CopySubresourceRegion(textureD3D.GetNative().resource.Get(), texSubresource, 0, 0, 0, intermediateTexture, intermediateSubresource, nullptr);
+        }
+        else if (toIntermediate)
+        {
+            /* Source box is in texels of the texture, destination is in elements of the intermediate texture */
+            D3D11_BOX srcBox =
+            {
+                static_cast<UINT>(offset.x),
+                static_cast<UINT>(offset.y),
+                static_cast<UINT>(offset.z),
+                static_cast<UINT>(offset.x) + elementExtent.width  * layout.blockSize,
+                static_cast<UINT>(offset.y) + elementExtent.height * layout.blockSize,
+                static_cast<UINT>(offset.z) + elementExtent.depth
+            };
+
+            if (layout.blockSize > 1)
+            {
+                /* Partial blocks are only allowed at the border of the MIP-map */
+                const Extent3D mipExtent = textureD3D.GetMipExtent(mipLevel);
+                srcBox.right    = std::min(srcBox.right, mipExtent.width);
+                srcBox.bottom   = std::min(srcBox.bottom, mipExtent.height);
+            }
+            context->CopySubresourceRegion(intermediateTexture, intermediateSubresource, 0, 0, 0, textureD3D.GetNative().resource.Get(), texSubresource, &srcBox);
+        }
+        else
+        {
+            /* Source box is in elements of the intermediate texture, destination is in texels of the texture */
+            const D3D11_BOX srcBox = { 0, 0, 0, elementExtent.width, elementExtent.height, elementExtent.depth };
+            context->CopySubresourceRegion(
+                textureD3D.GetNative().resource.Get(),
+                texSubresource,
+                static_cast<UINT>(offset.x),
+                static_cast<UINT>(offset.y),
+                static_cast<UINT>(offset.z),
+                intermediateTexture,
+                intermediateSubresource,
+                &srcBox
+            );
+        }
+    }
+}
+
 /*
 D3D11 does not support copying data between buffers and textures natively,
 so this function dispatches a builtin compute shader to achieve the desired effect.
@@ -213,6 +470,8 @@ void D3D11CommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
     auto& srcTextureD3D = LLGL_CAST(D3D11Texture&, srcTexture);
 
@@ -230,28 +489,23 @@ void D3D11CommandBuffer::CopyBufferFromTexture(
 
     const UINT dstOffsetU32 = static_cast<UINT>(dstOffset);
 
-    /* Get destination texture attributes */
-    const auto& formatAttribs = GetFormatAttribs(srcTextureD3D.GetFormat());
-    if ((formatAttribs.flags & (FormatFlags::IsCompressed | FormatFlags::IsPacked)) != 0 || formatAttribs.components == 0)
+    /* Get element layout of source texture */
+    CopyTextureBufferLayout layout;
+    if (!GetCopyTextureBufferLayout(srcTextureD3D.GetFormat(), layout))
         return;
 
-    /* An intermediate texture copy is required if the destination texture's format is not unsigned integer or it is normalized */
-    const bool useIntermediateTexture =
-    (
-        (formatAttribs.flags & FormatFlags::IsUnsignedInteger) != FormatFlags::IsUnsignedInteger ||
-        (formatAttribs.flags & FormatFlags::IsNormalized) != 0
-    );
+    const Extent3D elementExtent = GetCopyTextureBufferElementExtent(srcExtent, layout);
 
     /* Get actual row and layer stride */
     if (rowStride == 0 || layerStride == 0)
     {
         if (rowStride == 0)
-            rowStride = (srcExtent.width * formatAttribs.bitSize / 8);
+            rowStride = (elementExtent.width * layout.formatSize);
         if (layerStride == 0)
-            layerStride = (srcExtent.height * rowStride);
+            layerStride = (elementExtent.height * rowStride);
     }
 
-    const std::uint32_t copySize = (layerStride * srcExtent.depth);
+    const std::uint32_t copySize = (layerStride * elementExtent.depth);
 
     /* Create intermediate SRV for source texture (RWTexture1D/2D/3D) */
     const auto& subresource = srcRegion.subresource;
@@ -260,48 +514,24 @@ void D3D11CommandBuffer::CopyBufferFromTexture(
     D3D11NativeTexture intermediateTexture;
     ComPtr<ID3D11ShaderResourceView> intermediateSRV;
 
-    if (useIntermediateTexture)
+    if (layout.isRaw)
     {
-        /* Create an intermediate copy of the destination texture with unsigned integer format */
+        /* Create an intermediate copy of the source texture with unsigned integer format */
         srcTextureD3D.CreateSubresourceCopyWithUIntFormat(
             device_,
             intermediateTexture,
             intermediateSRV.GetAddressOf(),
             nullptr,
-            srcRegion,
+            GetCopyTextureBufferIntermediateRegion(srcTextureD3D, srcRegion, elementExtent, layout),
             textureArrayType
         );
 
         /* Copy source texture into intermediate texture */
-        const UINT      mipLevel    = subresource.baseMipLevel;
-        const D3D11_BOX srcBox      =
-        {
-            static_cast<UINT>(srcOffset.x),
-            static_cast<UINT>(srcOffset.y),
-            static_cast<UINT>(srcOffset.z),
-            static_cast<UINT>(srcOffset.x) + srcExtent.width,
-            static_cast<UINT>(srcOffset.y) + srcExtent.height,
-            static_cast<UINT>(srcOffset.z) + srcExtent.depth
-        };
-
-        for_range(i, subresource.numArrayLayers)
-        {
-            const UINT arrayLayer = subresource.baseArrayLayer + i;
-            context_->CopySubresourceRegion(
-                intermediateTexture.resource.Get(),                                             // pDstResource
-                D3D11CalcSubresource(0, i, 1),                                                  // DstSubresource
-                0,                                                                              // DstX
-                0,                                                                              // DstY
-                0,                                                                              // DstZ
-                srcTextureD3D.GetNative().resource.Get(),                                       // pSrcResource
-                D3D11CalcSubresource(mipLevel, arrayLayer, srcTextureD3D.GetNumMipLevels()),    // SrcSubresource
-                &srcBox                                                                         // pSrcBox
-            );
-        }
+        CopyTextureBufferIntermediateSubresources(context_.Get(), srcTextureD3D, srcRegion, elementExtent, layout, intermediateTexture.resource.Get(), true);
     }
     else
     {
-        /* Create intermediate UAV directly from destination texture if the texture already has an unsigned integer format */
+        /* Create intermediate SRV directly from source texture if the texture already has an unsigned integer format */
         srcTextureD3D.CreateSubresourceSRV(
             device_,
             intermediateSRV.GetAddressOf(),
@@ -331,7 +561,7 @@ void D3D11CommandBuffer::CopyBufferFromTexture(
     /* Set shader parameters with intermediate constant buffer */
     CopyTextureBufferCbuffer cbufferData;
     {
-        if (useIntermediateTexture)
+        if (layout.isRaw && !layout.isDepth)
         {
             cbufferData.texOffset[0]    = 0;
             cbufferData.texOffset[1]    = 0;
@@ -344,13 +574,13 @@ void D3D11CommandBuffer::CopyBufferFromTexture(
             cbufferData.texOffset[2]    = static_cast<std::uint32_t>(srcOffset.z);
         }
         cbufferData.bufOffset           = 0;
-        cbufferData.texExtent[0]        = srcExtent.width;
-        cbufferData.texExtent[1]        = srcExtent.height;
-        cbufferData.texExtent[2]        = srcExtent.depth;
-        cbufferData.bufIndexStride      = std::max(4u, formatAttribs.bitSize / 8u);
-        cbufferData.formatSize          = formatAttribs.bitSize / 8;
-        cbufferData.components          = formatAttribs.components;
-        cbufferData.componentBits       = formatAttribs.bitSize / formatAttribs.components;
+        cbufferData.texExtent[0]        = elementExtent.width;
+        cbufferData.texExtent[1]        = elementExtent.height;
+        cbufferData.texExtent[2]        = elementExtent.depth;
+        cbufferData.bufIndexStride      = std::max(4u, layout.formatSize);
+        cbufferData.formatSize          = layout.formatSize;
+        cbufferData.components          = layout.components;
+        cbufferData.componentBits       = layout.componentBits;
         cbufferData.rowStride           = rowStride;
         cbufferData.layerStride         = layerStride;
     }
@@ -371,13 +601,13 @@ void D3D11CommandBuffer::CopyBufferFromTexture(
     switch (textureArrayType)
     {
         case TextureType::Texture1DArray:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture1DCS, srcExtent.width, srcExtent.height, 1u);
+            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture1DCS, elementExtent.width, elementExtent.height, 1u);
             break;
         case TextureType::Texture2DArray:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture2DCS, srcExtent.width, srcExtent.height, srcExtent.depth);
+            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture2DCS, elementExtent.width, elementExtent.height, elementExtent.depth);
             break;
         case TextureType::Texture3D:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture3DCS, srcExtent.width, srcExtent.height, srcExtent.depth);
+            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture3DCS, elementExtent.width, elementExtent.height, elementExtent.depth);
             break;
         default:
             break;
@@ -402,6 +632,8 @@ void D3D11CommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
 
     /* Copy value to 4D vector to be used with native D3D11 clear functions */
@@ -438,27 +670,56 @@ void D3D11CommandBuffer::FillBuffer(
     }
     else
     {
-        /* Create intermediate buffer with UAV */
-        D3D11_BUFFER_DESC bufferDesc;
-        {
-            bufferDesc.ByteWidth            = static_cast<UINT>(fillSize);
-            bufferDesc.Usage                = D3D11_USAGE_DEFAULT;
-            bufferDesc.BindFlags            = D3D11_BIND_UNORDERED_ACCESS;
-            bufferDesc.CPUAccessFlags       = 0;
-            bufferDesc.MiscFlags            = 0;
-            bufferDesc.StructureByteStride  = sizeof(UINT);
-        }
-        ComPtr<ID3D11Buffer> intermediateBuffer;
-        device_->CreateBuffer(&bufferDesc, nullptr, &intermediateBuffer);
+        /* Fill intermediate buffer and copy it into destination buffer */
+        ClearWithIntermediateBuffer(dstBufferD3D, offset, size, valuesVec4);
+    }
+}
 
-        /* Fill destination buffer with intermediate UAV */
-        ClearWithIntermediateUAV(intermediateBuffer.Get(), 0, size, valuesVec4);
+void D3D11CommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    /* Forward patterns of a single 32-bit value to the default fill command */
+    std::uint32_t value = 0;
+    if (GetUniformFillPatternValue(pattern, patternSize, value))
+        return FillBuffer(dstBuffer, dstOffset, value, fillSize);
 
-        /* Copy intermediate buffer into destination buffer */
-        if (isWholeBufferRange)
-            context_->CopyResource(dstBufferD3D.GetNative(), intermediateBuffer.Get());
-        else
-            context_->CopySubresourceRegion(dstBufferD3D.GetNative(), 0, offset, 0, 0, intermediateBuffer.Get(), 0, nullptr);
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
+    auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
+
+    /* Copy 64- or 128-bit pattern to 4D vector to be used with native D3D11 clear functions */
+    UINT valuesVec4[4] = {};
+    ::memcpy(valuesVec4, pattern, patternSize);
+
+    /* Clamp range to buffer size if whole buffer is meant to be filled */
+    if (fillSize == Constants::wholeSize)
+    {
+        dstOffset   = 0;
+        fillSize    = dstBufferD3D.GetSize();
+    }
+
+    const UINT          offset  = static_cast<UINT>(dstOffset);
+    const UINT          size    = static_cast<UINT>(fillSize);
+    const DXGI_FORMAT   format  = (patternSize == 16 ? DXGI_FORMAT_R32G32B32A32_UINT : DXGI_FORMAT_R32G32_UINT);
+
+    /* Structured buffers cannot have typed UAVs, so they are filled via an intermediate buffer as well */
+    D3D11_BUFFER_DESC nativeDesc;
+    dstBufferD3D.GetNative()->GetDesc(&nativeDesc);
+
+    if ((nativeDesc.BindFlags & D3D11_BIND_UNORDERED_ACCESS) != 0 &&
+        (nativeDesc.MiscFlags & D3D11_RESOURCE_MISC_BUFFER_STRUCTURED) == 0)
+    {
+        /* Fill destination buffer with intermediate UAV */
+        ClearWithIntermediateUAV(dstBufferD3D.GetNative(), offset, size, valuesVec4, format, patternSize);
+    }
+    else
+    {
+        /* Fill intermediate buffer and copy it into destination buffer */
+        ClearWithIntermediateBuffer(dstBufferD3D, offset, size, valuesVec4, format, patternSize);
     }
 }
 
@@ -469,6 +730,8 @@ void D3D11CommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
     auto& srcTextureD3D = LLGL_CAST(D3D11Texture&, srcTexture);
 
@@ -501,6 +764,8 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
     auto& srcBufferD3D = LLGL_CAST(D3D11Buffer&, srcBuffer);
 
@@ -518,28 +783,23 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
 
     const UINT srcOffsetU32 = static_cast<UINT>(srcOffset);
 
-    /* Get destination texture attributes */
-    const auto& formatAttribs = GetFormatAttribs(dstTextureD3D.GetFormat());
-    if ((formatAttribs.flags & (FormatFlags::IsCompressed | FormatFlags::IsPacked)) != 0 || formatAttribs.components == 0)
+    /* Get element layout of destination texture */
+    CopyTextureBufferLayout layout;
+    if (!GetCopyTextureBufferLayout(dstTextureD3D.GetFormat(), layout))
         return;
 
-    /* An intermediate texture copy is required if the destination texture's format is not unsigned integer or it is normalized */
-    const bool useIntermediateTexture =
-    (
-        (formatAttribs.flags & FormatFlags::IsUnsignedInteger) != FormatFlags::IsUnsignedInteger ||
-        (formatAttribs.flags & FormatFlags::IsNormalized) != 0
-    );
+    const Extent3D elementExtent = GetCopyTextureBufferElementExtent(dstExtent, layout);
 
     /* Get actual row and layer stride */
     if (rowStride == 0 || layerStride == 0)
     {
         if (rowStride == 0)
-            rowStride = (dstExtent.width * formatAttribs.bitSize / 8);
+            rowStride = (elementExtent.width * layout.formatSize);
         if (layerStride == 0)
-            layerStride = (dstExtent.height * rowStride);
+            layerStride = (elementExtent.height * rowStride);
     }
 
-    const std::uint32_t copySize = (layerStride * dstExtent.depth);
+    const std::uint32_t copySize = (layerStride * elementExtent.depth);
 
     /* Create intermediate UAV for destination texture (RWTexture1D/2D/3D) */
     const auto& subresource = dstRegion.subresource;
@@ -548,7 +808,7 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
     D3D11NativeTexture intermediateTexture;
     ComPtr<ID3D11UnorderedAccessView> intermediateUAV;
 
-    if (useIntermediateTexture)
+    if (layout.isRaw)
     {
         /* Create an intermediate copy of the destination texture with unsigned integer format */
         dstTextureD3D.CreateSubresourceCopyWithUIntFormat(
@@ -556,9 +816,13 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
             intermediateTexture,
             nullptr,
             intermediateUAV.GetAddressOf(),
-            dstRegion,
+            GetCopyTextureBufferIntermediateRegion(dstTextureD3D, dstRegion, elementExtent, layout),
             textureArrayType
         );
+
+        /* Depth textures are copied back as entire subresources, so the texels outside the destination region must be preserved */
+        if (layout.isDepth)
+            CopyTextureBufferIntermediateSubresources(context_.Get(), dstTextureD3D, dstRegion, elementExtent, layout, intermediateTexture.resource.Get(), true);
     }
     else
     {
@@ -595,7 +859,7 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
     /* Set shader parameters with intermediate constant buffer */
     CopyTextureBufferCbuffer cbufferData;
     {
-        if (useIntermediateTexture)
+        if (layout.isRaw && !layout.isDepth)
         {
             cbufferData.texOffset[0]    = 0;
             cbufferData.texOffset[1]    = 0;
@@ -608,13 +872,13 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
             cbufferData.texOffset[2]    = static_cast<std::uint32_t>(dstOffset.z);
         }
         cbufferData.bufOffset           = 0;
-        cbufferData.texExtent[0]        = dstExtent.width;
-        cbufferData.texExtent[1]        = dstExtent.height;
-        cbufferData.texExtent[2]        = dstExtent.depth;
-        cbufferData.bufIndexStride      = std::max(4u, formatAttribs.bitSize / 8u);
-        cbufferData.formatSize          = formatAttribs.bitSize / 8;
-        cbufferData.components          = formatAttribs.components;
-        cbufferData.componentBits       = formatAttribs.bitSize / formatAttribs.components;
+        cbufferData.texExtent[0]        = elementExtent.width;
+        cbufferData.texExtent[1]        = elementExtent.height;
+        cbufferData.texExtent[2]        = elementExtent.depth;
+        cbufferData.bufIndexStride      = std::max(4u, layout.formatSize);
+        cbufferData.formatSize          = layout.formatSize;
+        cbufferData.components          = layout.components;
+        cbufferData.componentBits       = layout.componentBits;
         cbufferData.rowStride           = rowStride;
         cbufferData.layerStride         = layerStride;
     }
@@ -635,13 +899,13 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
     switch (textureArrayType)
     {
         case TextureType::Texture1DArray:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture1DFromBufferCS, dstExtent.width, dstExtent.height, 1u);
+            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture1DFromBufferCS, elementExtent.width, elementExtent.height, 1u);
             break;
         case TextureType::Texture2DArray:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture2DFromBufferCS, dstExtent.width, dstExtent.height, dstExtent.depth);
+            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture2DFromBufferCS, elementExtent.width, elementExtent.height, elementExtent.depth);
             break;
         case TextureType::Texture3D:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture3DFromBufferCS, dstExtent.width, dstExtent.height, dstExtent.depth);
+            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture3DFromBufferCS, elementExtent.width, elementExtent.height, elementExtent.depth);
             break;
         default:
             break;
@@ -652,26 +916,8 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
     context_->CSSetShaderResources(0, 1, prevSRVs);
 
     /* Copy UAV content into destination texture, if an intermediate texture was used */
-    if (useIntermediateTexture)
-    {
-        const UINT      mipLevel    = subresource.baseMipLevel;
-        const D3D11_BOX srcBox      = { 0, 0, 0, dstExtent.width, dstExtent.height, dstExtent.depth };
-
-        for_range(i, subresource.numArrayLayers)
-        {
-            const UINT arrayLayer = subresource.baseArrayLayer + i;
-            context_->CopySubresourceRegion(
-                dstTextureD3D.GetNative().resource.Get(),                                       // pDstResource
-                D3D11CalcSubresource(mipLevel, arrayLayer, dstTextureD3D.GetNumMipLevels()),    // DstSubresource
-                static_cast<UINT>(dstOffset.x),                                                 // DstX
-                static_cast<UINT>(dstOffset.y),                                                 // DstY
-                static_cast<UINT>(dstOffset.z),                                                 // DstZ
-                intermediateTexture.resource.Get(),                                             // pSrcResource
-                D3D11CalcSubresource(0, i, 1),                                                  // SrcSubresource
-                &srcBox                                                                         // pSrcBox
-            );
-        }
-    }
+    if (layout.isRaw)
+        CopyTextureBufferIntermediateSubresources(context_.Get(), dstTextureD3D, dstRegion, elementExtent, layout, intermediateTexture.resource.Get(), false);
 }
 
 void D3D11CommandBuffer::CopyTextureFromFramebuffer(
@@ -679,6 +925,8 @@ void D3D11CommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     if (dstRegion.extent.depth != 1 ||
         dstRegion.offset.x < 0      ||
         dstRegion.offset.y < 0      ||
@@ -715,12 +963,16 @@ void D3D11CommandBuffer::CopyTextureFromFramebuffer(
 
 void D3D11CommandBuffer::GenerateMips(Texture& texture)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     D3D11MipGenerator::Get().GenerateMips(context_.Get(), textureD3D);
 }
 
 void D3D11CommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     D3D11MipGenerator::Get().GenerateMipsRange(
         context_.Get(),
@@ -732,6 +984,11 @@ void D3D11CommandBuffer::GenerateMips(Texture& texture, const TextureSubresource
     );
 }
 
+void D3D11CommandBuffer::CompressTexture(Texture& /*dstTexture*/, Texture& /*srcTexture*/, const TextureSubresource& /*subresource*/)
+{
+    // dummy
+}
+
 /* ----- Viewport and Scissor ----- */
 
 void D3D11CommandBuffer::SetViewport(const Viewport& viewport)
@@ -758,6 +1015,8 @@ void D3D11CommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* s
 
 void D3D11CommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
 
     ID3D11Buffer* buffers[] = { bufferD3D.GetNative() };
@@ -769,6 +1028,8 @@ void D3D11CommandBuffer::SetVertexBuffer(Buffer& buffer)
 
 void D3D11CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferArrayD3D = LLGL_CAST(D3D11BufferArray&, bufferArray);
     context_->IASetVertexBuffers(
         0,
@@ -781,12 +1042,16 @@ void D3D11CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->IASetIndexBuffer(bufferD3D.GetNative(), bufferD3D.GetDXFormat(), 0);
 }
 
 void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->IASetIndexBuffer(bufferD3D.GetNative(), DXTypes::ToDXGIFormat(format), static_cast<UINT>(offset));
 }
@@ -795,11 +1060,17 @@ void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std
 
 void D3D11CommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
+    LLGL_FRAME_COUNTER_INC(resourceHeapBindings);
+
     if (boundPipelineState_ == nullptr)
         return /*E_POINTER*/;
 
     auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
 
+    /* Resource heaps bind their segments directly with the device context, so submit pending bindings first and invalidate the binding cache */
+    stateMngr_->FlushResourceBindings();
+    stateMngr_->InvalidateResourceBindings();
+
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
     if (context1_.Get() != nullptr)
     {
@@ -820,6 +1091,8 @@ void D3D11CommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32
 
 void D3D11CommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
+    LLGL_FRAME_COUNTER_RESOURCE(resource);
+
     if (boundPipelineLayout_ == nullptr)
         return /*E_POINTER*/;
 
@@ -883,6 +1156,38 @@ void D3D11CommandBuffer::SetResource(std::uint32_t descriptor, Resource& resourc
     }
 }
 
+void D3D11CommandBuffer::SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t size)
+{
+    LLGL_FRAME_COUNTER_RESOURCE(buffer);
+
+    if (boundPipelineLayout_ == nullptr)
+        return /*E_POINTER*/;
+
+    const auto& bindingList = boundPipelineLayout_->GetBindings();
+    if (!(descriptor < bindingList.size()))
+        return /*E_INVALIDARG*/;
+
+    const auto& binding = bindingList[descriptor];
+    if (binding.type == D3DResourceType_CBV)
+    {
+        /* Bind constant buffer range in units of 16 constants, i.e. 256 bytes, as required by ID3D11DeviceContext1 */
+        constexpr UINT cbufferRangeAlignment = 16*16;
+        auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+        const UINT rangeSize = static_cast<UINT>(GetBufferRangeSize(bufferD3D.GetSize(), offset, size));
+
+        ID3D11Buffer*   buffers[]           = { bufferD3D.GetNative() };
+        const UINT      firstConstants[]    = { static_cast<UINT>(offset / 16) };
+        const UINT      numConstants[]      = { GetAlignedSize(rangeSize, cbufferRangeAlignment) / 16 };
+
+        stateMngr_->SetConstantBuffersRange(binding.slot, 1, buffers, firstConstants, numConstants, binding.stageFlags);
+    }
+    else
+    {
+        /* Shader resource and unordered access views cannot be bound with an offset, so bind the entire buffer */
+        SetResource(descriptor, static_cast<Resource&>(buffer));
+    }
+}
+
 void D3D11CommandBuffer::ResetResourceSlots(
     const ResourceType  resourceType,
     std::uint32_t       firstSlot,
@@ -896,6 +1201,7 @@ void D3D11CommandBuffer::ResetResourceSlots(
         switch (resourceType)
         {
             case ResourceType::Undefined:
+            case ResourceType::AccelerationStructure:
                 break;
             case ResourceType::Buffer:
                 ResetBufferResourceSlots(firstSlot, numSlots, bindFlags, stageFlags);
@@ -919,6 +1225,8 @@ void D3D11CommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       /*swapBufferIndex*/)
 {
+    LLGL_FRAME_COUNTER_INC(renderPassSections);
+
     /* Bind render target/context */
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
         BindSwapChain(LLGL_CAST(D3D11SwapChain&, renderTarget));
@@ -952,6 +1260,8 @@ static UINT GetClearFlagsDSV(long flags)
 
 void D3D11CommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     /* Clear color buffers */
     if ((flags & ClearFlags::Color) != 0)
     {
@@ -976,6 +1286,8 @@ void D3D11CommandBuffer::Clear(long flags, const ClearValue& clearValue)
 
 void D3D11CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     for (; numAttachments-- > 0; ++attachments)
     {
         if ((attachments->flags & ClearFlags::Color) != 0)
@@ -1010,14 +1322,30 @@ void D3D11CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const At
 void D3D11CommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
     auto pipelineStateD3D = LLGL_CAST(D3D11PipelineState*, &pipelineState);
+
+    if (pipelineStateD3D->IsGraphicsPSO())
+        LLGL_FRAME_COUNTER_INC(graphicsPipelineBindings);
+    else
+        LLGL_FRAME_COUNTER_INC(computePipelineBindings);
+
     if (boundPipelineState_ != pipelineStateD3D)
     {
         boundPipelineState_ = pipelineStateD3D;
         boundPipelineState_->Bind(*stateMngr_);
         boundPipelineLayout_ = boundPipelineState_->GetPipelineLayout();
-        boundConstantsCache_ = boundPipelineState_->GetConstantsCache();
-        if (boundConstantsCache_ != nullptr)
+
+        if (const D3D11ConstantsCache* constantsCacheTemplate = boundPipelineState_->GetConstantsCache())
+        {
+            /* Copy constants cache from PSO, so command buffers that are encoded on different threads never share CPU data */
+            if (constantsCache_)
+                *constantsCache_ = *constantsCacheTemplate;
+            else
+                constantsCache_ = MakeUnique<D3D11ConstantsCache>(*constantsCacheTemplate);
+            boundConstantsCache_ = constantsCache_.get();
             boundConstantsCache_->Reset();
+        }
+        else
+            boundConstantsCache_ = nullptr;
     }
 }
 
@@ -1041,6 +1369,8 @@ void D3D11CommandBuffer::SetUniforms(std::uint32_t first, const void* data, std:
 
 void D3D11CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_FRAME_COUNTER_INC(querySections);
+
     auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
 
     query *= queryHeapD3D.GetGroupSize();
@@ -1051,6 +1381,10 @@ void D3D11CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
         context_->Begin(queryHeapD3D.GetNative(query));
         context_->End(queryHeapD3D.GetNative(query + 1));
     }
+    else if (queryHeapD3D.GetNativeType() == D3D11_QUERY_TIMESTAMP)
+    {
+        // dummy; single timestamps are only written in EndQuery()
+    }
     else
     {
         /* Begin standard query */
@@ -1070,6 +1404,13 @@ void D3D11CommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
         context_->End(queryHeapD3D.GetNative(query + 2));
         context_->End(queryHeapD3D.GetNative(query));
     }
+    else if (queryHeapD3D.GetNativeType() == D3D11_QUERY_TIMESTAMP)
+    {
+        /* Enclose timestamp query with its own disjoint query to determine the timestamp frequency */
+        context_->Begin(queryHeapD3D.GetNative(query));
+        context_->End(queryHeapD3D.GetNative(query + 1));
+        context_->End(queryHeapD3D.GetNative(query));
+    }
     else
     {
         /* End standard query */
@@ -1079,6 +1420,8 @@ void D3D11CommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 
 void D3D11CommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_FRAME_COUNTER_INC(renderConditionSections);
+
     auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
     context_->SetPredication(
         queryHeapD3D.GetPredicate(query * queryHeapD3D.GetGroupSize()),
@@ -1095,6 +1438,8 @@ void D3D11CommandBuffer::EndRenderCondition()
 
 void D3D11CommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
+    LLGL_FRAME_COUNTER_INC(streamOutputSections);
+
     ID3D11Buffer* soTargets[LLGL_MAX_NUM_SO_BUFFERS];
     UINT offsets[LLGL_MAX_NUM_SO_BUFFERS];
 
@@ -1119,62 +1464,82 @@ void D3D11CommandBuffer::EndStreamOutput()
 
 void D3D11CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     context_->Draw(numVertices, firstVertex);
 }
 
 void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     context_->DrawIndexed(numIndices, firstIndex, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     context_->DrawIndexed(numIndices, firstIndex, vertexOffset);
 }
 
 void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     context_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
 }
 
 void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     context_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->DrawInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
 
 void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     while (numCommands-- > 0)
     {
@@ -1185,14 +1550,18 @@ void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std:
 
 void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->DrawIndexedInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
 
 void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushPendingBindings();
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     while (numCommands-- > 0)
     {
@@ -1201,21 +1570,101 @@ void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offse
     }
 }
 
+void D3D11CommandBuffer::DrawIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void D3D11CommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void D3D11CommandBuffer::DrawMeshTasks(std::uint32_t /*numWorkGroupsX*/, std::uint32_t /*numWorkGroupsY*/, std::uint32_t /*numWorkGroupsZ*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void D3D11CommandBuffer::DrawMeshTasksIndirect(Buffer& /*buffer*/, std::uint64_t /*offset*/, std::uint32_t /*numCommands*/, std::uint32_t /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void D3D11CommandBuffer::DrawStreamOutput()
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    /* Vertex count is taken from the filled size the stream-output stage has stored with the vertex buffer in slot 0 */
+    FlushPendingBindings();
+    context_->DrawAuto();
+}
+
 /* ----- Compute ----- */
 
 void D3D11CommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
+    FlushPendingBindings();
     context_->Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void D3D11CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
-    FlushConstantsCache();
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
+    FlushPendingBindings();
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     context_->DispatchIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
 
+void D3D11CommandBuffer::CompactIndirectArguments(
+    Buffer&         /*dstBuffer*/,
+    std::uint64_t   /*dstOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    Buffer&         /*srcBuffer*/,
+    std::uint64_t   /*srcOffset*/,
+    Buffer&         /*visibilityBuffer*/,
+    std::uint64_t   /*visibilityOffset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    // dummy
+}
+
+/* ----- Ray Tracing ----- */
+
+void D3D11CommandBuffer::BuildAccelerationStructure(AccelerationStructure& /*accelerationStructure*/, const AccelerationStructureBuildDescriptor& /*buildDesc*/)
+{
+    // dummy
+}
+
+void D3D11CommandBuffer::CopyAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/, bool /*compact*/)
+{
+    // dummy
+}
+
 /* ----- Debugging ----- */
 
 void D3D11CommandBuffer::PushDebugGroup(const char* name)
@@ -1418,8 +1867,9 @@ void D3D11CommandBuffer::ResetDeferredCommandList()
 {
     if (commandList_)
     {
-        context_->FinishCommandList(TRUE, commandList_.ReleaseAndGetAddressOf());
+        context_->FinishCommandList(FALSE, commandList_.ReleaseAndGetAddressOf());
         commandList_.Reset();
+        stateMngr_->ResetCachedStates();
     }
 }
 
@@ -1592,8 +2042,9 @@ void D3D11CommandBuffer::CreateByteAddressBufferR32Typeless(
     }
 }
 
-void D3D11CommandBuffer::FlushConstantsCache()
+void D3D11CommandBuffer::FlushPendingBindings()
 {
+    stateMngr_->FlushResourceBindings();
     if (boundConstantsCache_ != nullptr)
         boundConstantsCache_->Flush(*stateMngr_);
 }
@@ -10,11 +10,13 @@
 
 
 #include <LLGL/CommandBuffer.h>
+#include <LLGL/RenderingProfiler.h>
 #include "../DXCommon/ComPtr.h"
 #include "../DXCommon/DXCore.h"
 #include "Direct3D11.h"
 #include <dxgi.h>
 #include <vector>
+#include <memory>
 #include <cstddef>
 
 
@@ -47,6 +49,8 @@ class D3D11CommandBuffer final : public CommandBuffer
             const CommandBufferDescriptor&              desc
         );
 
+        ~D3D11CommandBuffer();
+
     public:
 
         /* ----- Internal ----- */
@@ -72,6 +76,18 @@ class D3D11CommandBuffer final : public CommandBuffer
             return isSecondaryCmdBuffer_;
         }
 
+        // Returns true if this command buffer keeps its command list after submission, so it can be submitted multiple times without encoding it again.
+        inline bool IsMultiSubmitCmdBuffer() const
+        {
+            return isMultiSubmitCmdBuffer_;
+        }
+
+        // Returns the frame counters of the current encoding. See LLGL_ENABLE_FRAME_COUNTERS.
+        inline const FrameProfile& GetFrameCounters() const
+        {
+            return frameCounters_;
+        }
+
     private:
 
         // Wrapper structure for the framebuffer resource views.
@@ -107,7 +123,24 @@ class D3D11CommandBuffer final : public CommandBuffer
             const ClearValue*   clearValues
         );
 
-        void ClearWithIntermediateUAV(ID3D11Buffer* buffer, UINT offset, UINT size, const UINT (&valuesVec4)[4]);
+        void ClearWithIntermediateUAV(
+            ID3D11Buffer*   buffer,
+            UINT            offset,
+            UINT            size,
+            const UINT      (&valuesVec4)[4],
+            DXGI_FORMAT     format  = DXGI_FORMAT_R32_UINT,
+            UINT            stride  = sizeof(UINT)
+        );
+
+        // Clears an intermediate buffer with a UAV and copies it into the destination buffer range; used for buffers without UAV binding.
+        void ClearWithIntermediateBuffer(
+            D3D11Buffer&    dstBufferD3D,
+            UINT            offset,
+            UINT            size,
+            const UINT      (&valuesVec4)[4],
+            DXGI_FORMAT     format  = DXGI_FORMAT_R32_UINT,
+            UINT            stride  = sizeof(UINT)
+        );
 
         // Creates a copy of this buffer as ByteAddressBuffer; 'size' must be a multiple of 4.
         void CreateByteAddressBufferR32Typeless(
@@ -120,7 +153,8 @@ class D3D11CommandBuffer final : public CommandBuffer
             D3D11_USAGE                 usage           = D3D11_USAGE_DEFAULT
         );
 
-        void FlushConstantsCache();
+        // Submits pending resource bindings and dynamic uniforms before a draw or dispatch command.
+        void FlushPendingBindings();
 
         void ResetBindingStates();
 
@@ -141,6 +175,7 @@ class D3D11CommandBuffer final : public CommandBuffer
 
         bool                                hasDeferredContext_     = false;
         bool                                isSecondaryCmdBuffer_   = false;
+        bool                                isMultiSubmitCmdBuffer_ = false;
 
         #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
         ComPtr<ID3DUserDefinedAnnotation>   annotation_;
@@ -155,6 +190,11 @@ class D3D11CommandBuffer final : public CommandBuffer
         D3D11PipelineState*                 boundPipelineState_     = nullptr;
         D3D11ConstantsCache*                boundConstantsCache_    = nullptr;
 
+        // Copy of the constants cache of the bound PSO that this command buffer encodes its uniforms into.
+        std::unique_ptr<D3D11ConstantsCache> constantsCache_;
+
+        FrameProfile                        frameCounters_;
+
 };
 
 
@@ -9,17 +9,22 @@
 #include "D3D11CommandBuffer.h"
 #include "RenderState/D3D11Fence.h"
 #include "RenderState/D3D11QueryHeap.h"
+#include "RenderState/D3D11StateManager.h"
 #include "../CheckedCast.h"
+#include "../HostTrace.h"
+#include "../TimestampUtils.h"
 #include <LLGL/Utils/ForRange.h>
+#include <thread>
 
 
 namespace LLGL
 {
 
 
-D3D11CommandQueue::D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceContext>& context) :
-    context_           { context },
-    intermediateFence_ { device  }
+D3D11CommandQueue::D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceContext>& context, D3D11StateManager& stateMngr) :
+    context_           { context   },
+    stateMngr_         { stateMngr },
+    intermediateFence_ { device    }
 {
 }
 
@@ -27,15 +32,35 @@ D3D11CommandQueue::D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceCo
 
 void D3D11CommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_HOST_TRACE_SCOPE("Submit");
+
     auto& cmdBufferD3D = LLGL_CAST(D3D11CommandBuffer&, commandBuffer);
     if (!cmdBufferD3D.IsSecondaryCmdBuffer())
     {
         if (auto commandList = cmdBufferD3D.GetDeferredCommandList())
         {
-            /* Execute encoded command list with immediate context but don't restore previous state */
+            /*
+            Execute encoded command list with immediate context but don't restore previous state.
+            The command list is retained by the command buffer, so multi-submit command buffers can be replayed without encoding them again.
+            The immediate context is left in its default state afterwards, so the cached states of its state manager must be invalidated.
+            */
             context_->ExecuteCommandList(commandList, FALSE);
+            stateMngr_.ResetCachedStates();
         }
     }
+    frameCounters_.SubmitCommandBuffer(cmdBufferD3D.GetFrameCounters());
+}
+
+/* ----- Sparse Resources ----- */
+
+void D3D11CommandQueue::UpdateTileMappings(Texture& /*texture*/, std::uint32_t /*numMappings*/, const TextureTileMapping* /*mappings*/)
+{
+    // dummy
+}
+
+void D3D11CommandQueue::UpdateTileMappings(Buffer& /*buffer*/, std::uint32_t /*numMappings*/, const BufferTileMapping* /*mappings*/)
+{
+    // dummy
 }
 
 /* ----- Queries ----- */
@@ -52,12 +77,74 @@ bool D3D11CommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQue
     return false;
 }
 
+bool D3D11CommandQueue::QueryFrameCounters(FrameProfile& outProfile)
+{
+    return frameCounters_.Query(outProfile);
+}
+
+bool D3D11CommandQueue::GetCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    if (!CreateCalibrationQueries())
+        return false;
+
+    /* Wait until all previous commands have been completed, so the timestamp is written as soon as it is flushed */
+    WaitIdle();
+
+    /* Bracket timestamp query with CPU timestamps while waiting for its result */
+    CalibratedTimestamps timestamps;
+    context_->Begin(calibrationDisjointQuery_.Get());
+    const bool sampled = SampleCalibratedTimestamps(
+        timestamps,
+        [this](std::uint64_t& outGPUTimestamp) -> bool
+        {
+            context_->End(calibrationTimestampQuery_.Get());
+            context_->Flush();
+            UINT64 timestamp = 0;
+            if (!WaitQueryData(calibrationTimestampQuery_.Get(), &timestamp, sizeof(timestamp)))
+                return false;
+            outGPUTimestamp = timestamp;
+            return true;
+        }
+    );
+    context_->End(calibrationDisjointQuery_.Get());
+
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
+    if (!WaitQueryData(calibrationDisjointQuery_.Get(), &disjointData, sizeof(disjointData)) || !sampled)
+        return false;
+    if (disjointData.Disjoint != FALSE || disjointData.Frequency == 0)
+        return false;
+
+    /* Normalize timestamp to nanoseconds the same way as the results of timestamp queries */
+    static const UINT64 nanosecondFrequency = 1000000000;
+    if (disjointData.Frequency != nanosecondFrequency)
+    {
+        const auto scale = (static_cast<double>(nanosecondFrequency) / static_cast<double>(disjointData.Frequency));
+        timestamps.gpuTimestamp = static_cast<std::uint64_t>(static_cast<double>(timestamps.gpuTimestamp) * scale + 0.5);
+    }
+
+    outTimestamps = timestamps;
+    return true;
+}
+
 /* ----- Fences ----- */
 
 void D3D11CommandQueue::Submit(Fence& fence)
 {
     auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
     fenceD3D.Submit(context_.Get());
+    frameCounters_.SubmitFence();
+}
+
+void D3D11CommandQueue::Submit(Fence& fence, std::uint64_t value)
+{
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
+    fenceD3D.Submit(context_.Get(), value);
+    frameCounters_.SubmitFence();
+}
+
+void D3D11CommandQueue::SubmitWait(Fence& /*fence*/, std::uint64_t /*value*/)
+{
+    // dummy; D3D11 only has a single immediate context that executes all commands in submission order
 }
 
 bool D3D11CommandQueue::WaitFence(Fence& fence, std::uint64_t /*timeout*/)
@@ -67,10 +154,16 @@ bool D3D11CommandQueue::WaitFence(Fence& fence, std::uint64_t /*timeout*/)
     return true;
 }
 
+bool D3D11CommandQueue::WaitFence(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
+    return fenceD3D.Wait(context_.Get(), value, timeout);
+}
+
 void D3D11CommandQueue::WaitIdle()
 {
     /* Submit intermediate fence and wait for it to be signaled */
-    Submit(intermediateFence_);
+    intermediateFence_.Submit(context_.Get());
     WaitFence(intermediateFence_, ~0ull);
 }
 
@@ -79,6 +172,42 @@ void D3D11CommandQueue::WaitIdle()
  * ======= Private: =======
  */
 
+bool D3D11CommandQueue::CreateCalibrationQueries()
+{
+    if (calibrationDisjointQuery_ && calibrationTimestampQuery_)
+        return true;
+
+    ComPtr<ID3D11Device> device;
+    context_->GetDevice(device.GetAddressOf());
+
+    D3D11_QUERY_DESC queryDesc;
+    {
+        queryDesc.Query     = D3D11_QUERY_TIMESTAMP_DISJOINT;
+        queryDesc.MiscFlags = 0;
+    }
+    if (FAILED(device->CreateQuery(&queryDesc, calibrationDisjointQuery_.ReleaseAndGetAddressOf())))
+        return false;
+
+    queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+    if (FAILED(device->CreateQuery(&queryDesc, calibrationTimestampQuery_.ReleaseAndGetAddressOf())))
+        return false;
+
+    return true;
+}
+
+bool D3D11CommandQueue::WaitQueryData(ID3D11Query* query, void* data, UINT dataSize)
+{
+    for (;;)
+    {
+        const HRESULT hr = context_->GetData(query, data, dataSize, 0);
+        if (hr == S_OK)
+            return true;
+        if (hr != S_FALSE)
+            return false;
+        std::this_thread::yield();
+    }
+}
+
 bool D3D11CommandQueue::QueryResultSingleUInt64(
     D3D11QueryHeap& queryHeapD3D,
     std::uint32_t   query,
@@ -136,6 +265,38 @@ bool D3D11CommandQueue::QueryResultSingleUInt64(
         }
         break;
 
+        /* Query result from special case query type: Timestamp */
+        case D3D11_QUERY_TIMESTAMP:
+        {
+            query *= queryHeapD3D.GetGroupSize();
+
+            UINT64 timestamp = 0;
+            if (context_->GetData(queryHeapD3D.GetNative(query + 1), &timestamp, sizeof(timestamp), 0) == S_OK)
+            {
+                D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
+                if (context_->GetData(queryHeapD3D.GetNative(query), &disjointData, sizeof(disjointData), 0) == S_OK)
+                {
+                    /* Normalize timestamp to nanoseconds */
+                    static const UINT64 nanosecondFrequency = 1000000000;
+
+                    if (disjointData.Disjoint == FALSE && disjointData.Frequency != 0)
+                    {
+                        if (disjointData.Frequency != nanosecondFrequency)
+                        {
+                            const auto scale = (static_cast<double>(nanosecondFrequency) / static_cast<double>(disjointData.Frequency));
+                            data = static_cast<std::uint64_t>(static_cast<double>(timestamp) * scale + 0.5);
+                        }
+                        else
+                            data = timestamp;
+                    }
+                    else
+                        data = 0;
+                    return true;
+                }
+            }
+        }
+        break;
+
         /* Query result from data of type: BOOL */
         case D3D11_QUERY_OCCLUSION_PREDICATE:
         case D3D11_QUERY_SO_OVERFLOW_PREDICATE:
@@ -13,6 +13,7 @@
 #include <LLGL/ForwardDecls.h>
 #include "RenderState/D3D11Fence.h"
 #include "../DXCommon/ComPtr.h"
+#include "../FrameCounters.h"
 #include <d3d11.h>
 
 
@@ -21,6 +22,7 @@ namespace LLGL
 
 
 class D3D11QueryHeap;
+class D3D11StateManager;
 
 class D3D11CommandQueue final : public CommandQueue
 {
@@ -31,10 +33,16 @@ class D3D11CommandQueue final : public CommandQueue
 
     public:
 
-        D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceContext>& context);
+        D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceContext>& context, D3D11StateManager& stateMngr);
 
     private:
 
+        // Creates the disjoint and timestamp queries for GetCalibratedTimestamps() on first use.
+        bool CreateCalibrationQueries();
+
+        // Blocks until the data of the specified query is available.
+        bool WaitQueryData(ID3D11Query* query, void* data, UINT dataSize);
+
         bool QueryResultSingleUInt64(
             D3D11QueryHeap& queryHeapD3D,
             std::uint32_t   query,
@@ -65,7 +73,12 @@ class D3D11CommandQueue final : public CommandQueue
     private:
 
         ComPtr<ID3D11DeviceContext> context_;
+        D3D11StateManager&          stateMngr_;
         D3D11Fence                  intermediateFence_;
+        FrameCounterAccumulator     frameCounters_;
+
+        ComPtr<ID3D11Query>         calibrationDisjointQuery_;
+        ComPtr<ID3D11Query>         calibrationTimestampQuery_;
 
 };
 
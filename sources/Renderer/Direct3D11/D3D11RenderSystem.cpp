@@ -13,10 +13,13 @@
 #include "../DXCommon/DXCore.h"
 #include "../CheckedCast.h"
 #include "../TextureUtils.h"
+#include "../RenderSystemUtils.h"
+#include "../FileLoadUtils.h"
 #include "../../Core/Vendor.h"
 #include "../../Core/CoreUtils.h"
 #include "../../Core/StringUtils.h"
 #include "../../Core/Assertion.h"
+#include <LLGL/Container/ArrayView.h>
 #include <sstream>
 #include <iomanip>
 #include <limits.h>
@@ -29,6 +32,7 @@
 #include "RenderState/D3D11GraphicsPSO1.h"
 #include "RenderState/D3D11GraphicsPSO3.h"
 #include "RenderState/D3D11ComputePSO.h"
+#include "../HostTrace.h"
 
 #include <LLGL/Backend/Direct3D11/NativeHandle.h>
 
@@ -58,7 +62,25 @@ D3D11RenderSystem::D3D11RenderSystem(const RenderSystemDescriptor& renderSystemD
     /* Create DXGU factory, query video adapters, and create D3D11 device */
     CreateFactory();
     QueryVideoAdapters();
-    CreateDevice(nullptr, debugDevice);
+
+    /* Use default adapter (null) unless an adapter was explicitly selected */
+    ComPtr<IDXGIAdapter> adapter;
+    const std::uint32_t selectedAdapter = FindSelectedVideoAdapter(renderSystemDesc, videoAdatperDescs_);
+    if (selectedAdapter != Constants::defaultAdapter)
+    {
+        HRESULT hr = factory_->EnumAdapters(selectedAdapter, adapter.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to enumerate selected DXGI adapter");
+    }
+
+    CreateDevice(adapter.Get(), debugDevice);
+
+    /* Enable shader cache to skip HLSL compilation on subsequent runs */
+    auto rendererConfigD3D = GetRendererConfiguration<RendererConfigurationDirect3D11>(renderSystemDesc);
+    if (rendererConfigD3D != nullptr)
+        shaderCache_.SetDirectory(rendererConfigD3D->shaderCachePath);
+
+    /* Select tuning profile before the state managers allocate their staging buffers */
+    SelectTuningProfile(rendererConfigD3D);
 
     /* Initialize states and renderer information */
     CreateStateManagerAndCommandQueue();
@@ -93,7 +115,7 @@ void D3D11RenderSystem::Release(SwapChain& swapChain)
 
 /* ----- Command queues ----- */
 
-CommandQueue* D3D11RenderSystem::GetCommandQueue()
+CommandQueue* D3D11RenderSystem::GetCommandQueue(const CommandQueueType /*type*/)
 {
     return commandQueue_.get();
 }
@@ -115,7 +137,7 @@ CommandBuffer* D3D11RenderSystem::CreateCommandBuffer(const CommandBufferDescrip
         DXThrowIfCreateFailed(hr, "ID3D11DeviceContext", "for deferred command buffer");
 
         /* Create state manager dedicated to deferred context */
-        auto deferredStateMngr = std::make_shared<D3D11StateManager>(device_.Get(), deferredContext);
+        auto deferredStateMngr = std::make_shared<D3D11StateManager>(device_.Get(), deferredContext, tuningProfile_.stagingChunkSize);
 
         /* Create command buffer with deferred context and dedicated state manager */
         return commandBuffers_.emplace<D3D11CommandBuffer>(device_.Get(), deferredContext, deferredStateMngr, commandBufferDesc);
@@ -138,6 +160,13 @@ Buffer* D3D11RenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, cons
         return buffers_.emplace<D3D11Buffer>(device_.Get(), bufferDesc, initialData);
 }
 
+void D3D11RenderSystem::CreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, const void* const * initialData, Buffer** outBuffers)
+{
+    RenderSystem::AssertCreateBuffers(numBuffers, bufferDescs, outBuffers);
+    for_range(i, numBuffers)
+        outBuffers[i] = CreateBuffer(bufferDescs[i], (initialData != nullptr ? initialData[i] : nullptr));
+}
+
 BufferArray* D3D11RenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
     RenderSystem::AssertCreateBufferArray(numBuffers, bufferArray);
@@ -201,6 +230,13 @@ Texture* D3D11RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
     return textureD3D;
 }
 
+void D3D11RenderSystem::CreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, const SrcImageDescriptor* const * imageDescs, Texture** outTextures)
+{
+    RenderSystem::AssertCreateTextures(numTextures, textureDescs, outTextures);
+    for_range(i, numTextures)
+        outTextures[i] = CreateTexture(textureDescs[i], (imageDescs != nullptr ? imageDescs[i] : nullptr));
+}
+
 void D3D11RenderSystem::Release(Texture& texture)
 {
     textures_.erase(&texture);
@@ -208,6 +244,8 @@ void D3D11RenderSystem::Release(Texture& texture)
 
 void D3D11RenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("WriteTexture");
+
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     switch (texture.GetType())
     {
@@ -371,8 +409,10 @@ void D3D11RenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* D3D11RenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateShader");
+
     RenderSystem::AssertCreateShader(shaderDesc);
-    return shaders_.emplace<D3D11Shader>(device_.Get(), shaderDesc);
+    return shaders_.emplace<D3D11Shader>(device_.Get(), shaderDesc, shaderCache_);
 }
 
 void D3D11RenderSystem::Release(Shader& shader)
@@ -401,6 +441,8 @@ PipelineState* D3D11RenderSystem::CreatePipelineState(const Blob& /*serializedCa
 
 PipelineState* D3D11RenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineState");
+
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
     if (device3_)
     {
@@ -431,9 +473,23 @@ PipelineState* D3D11RenderSystem::CreatePipelineState(const GraphicsPipelineDesc
 
 PipelineState* D3D11RenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineState");
+
     return pipelineStates_.emplace<D3D11ComputePSO>(pipelineStateDesc);
 }
 
+PipelineState* D3D11RenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, PipelineState* /*fallbackPipelineState*/)
+{
+    /* D3D11 state objects are cheap to create, so the PSO is created synchronously */
+    return CreatePipelineState(pipelineStateDesc);
+}
+
+PipelineState* D3D11RenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, PipelineState* /*fallbackPipelineState*/)
+{
+    /* D3D11 state objects are cheap to create, so the PSO is created synchronously */
+    return CreatePipelineState(pipelineStateDesc);
+}
+
 void D3D11RenderSystem::Release(PipelineState& pipelineState)
 {
     pipelineStates_.erase(&pipelineState);
@@ -451,6 +507,18 @@ void D3D11RenderSystem::Release(QueryHeap& queryHeap)
     queryHeaps_.erase(&queryHeap);
 }
 
+/* ----- Acceleration structures ----- */
+
+AccelerationStructure* D3D11RenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& /*accelerationStructureDesc*/)
+{
+    LLGL_TRAP_FEATURE_NOT_SUPPORTED("acceleration structures");
+}
+
+void D3D11RenderSystem::Release(AccelerationStructure& /*accelerationStructure*/)
+{
+    // dummy
+}
+
 /* ----- Fences ----- */
 
 Fence* D3D11RenderSystem::CreateFence()
@@ -477,6 +545,66 @@ bool D3D11RenderSystem::GetNativeHandle(void* nativeHandle, std::size_t nativeHa
     return false;
 }
 
+std::uint64_t D3D11RenderSystem::ReleaseRetainedMemory(std::uint64_t /*budget*/)
+{
+    return 0; // dummy
+}
+
+bool D3D11RenderSystem::QueryMemoryStatistics(MemoryStatistics& outStatistics)
+{
+    /* Get adapter the device was created with */
+    ComPtr<IDXGIDevice> deviceDXGI;
+    ComPtr<IDXGIAdapter> adapter;
+    if (SUCCEEDED(device_->QueryInterface(IID_PPV_ARGS(deviceDXGI.ReleaseAndGetAddressOf()))) &&
+        SUCCEEDED(deviceDXGI->GetAdapter(adapter.ReleaseAndGetAddressOf())))
+    {
+        return DXQueryVideoMemoryInfo(adapter.Get(), outStatistics);
+    }
+    outStatistics.heaps.clear();
+    return false;
+}
+
+bool D3D11RenderSystem::SetMemoryPriority(Resource& resource, float priority)
+{
+    ID3D11Resource* nativeResource = nullptr;
+
+    if (resource.GetResourceType() == ResourceType::Buffer)
+        nativeResource = LLGL_CAST(D3D11Buffer&, resource).GetNative();
+    else if (resource.GetResourceType() == ResourceType::Texture)
+        nativeResource = LLGL_CAST(D3D11Texture&, resource).GetNativeResource();
+
+    if (nativeResource == nullptr)
+        return false;
+
+    /* Direct3D 11 exposes the residency priority as eviction priority of the DXGI resource */
+    ComPtr<IDXGIResource> resourceDXGI;
+    if (FAILED(nativeResource->QueryInterface(IID_PPV_ARGS(resourceDXGI.ReleaseAndGetAddressOf()))))
+        return false;
+
+    resourceDXGI->SetEvictionPriority(DXGetResidencyPriority(priority));
+    return true;
+}
+
+Blob D3D11RenderSystem::GetPipelineCache()
+{
+    return Blob{}; // dummy
+}
+
+bool D3D11RenderSystem::ExportMemoryHandle(Resource& /*resource*/, ExternalHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool D3D11RenderSystem::ExportFenceHandle(Fence& /*fence*/, ExternalHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool D3D11RenderSystem::SubmitFileLoads(const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    return SubmitFileLoadsEmulated(*this, loads, fence);
+}
+
 
 /*
  * ======= Internal: =======
@@ -581,7 +709,17 @@ void D3D11RenderSystem::CreateDevice(IDXGIAdapter* adapter, bool debugDevice)
 
 bool D3D11RenderSystem::CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, UINT flags, HRESULT& hr)
 {
-    for (D3D_DRIVER_TYPE driver : { D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP, D3D_DRIVER_TYPE_SOFTWARE })
+    /* An explicit adapter requires the unknown driver type; otherwise, fall back to the WARP and software drivers */
+    static const D3D_DRIVER_TYPE adapterDriverTypes[] = { D3D_DRIVER_TYPE_UNKNOWN };
+    static const D3D_DRIVER_TYPE defaultDriverTypes[] = { D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP, D3D_DRIVER_TYPE_SOFTWARE };
+
+    const ArrayView<D3D_DRIVER_TYPE> driverTypes =
+    (
+        adapter != nullptr
+            ? ArrayView<D3D_DRIVER_TYPE>{ adapterDriverTypes }
+            : ArrayView<D3D_DRIVER_TYPE>{ defaultDriverTypes }
+    );
+    for (D3D_DRIVER_TYPE driver : driverTypes)
     {
         hr = D3D11CreateDevice(
             adapter,                                    // Video adapter
@@ -603,8 +741,24 @@ bool D3D11RenderSystem::CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::
 
 void D3D11RenderSystem::CreateStateManagerAndCommandQueue()
 {
-    stateMngr_ = std::make_shared<D3D11StateManager>(device_.Get(), context_);
-    commandQueue_ = MakeUnique<D3D11CommandQueue>(device_.Get(), context_);
+    stateMngr_ = std::make_shared<D3D11StateManager>(device_.Get(), context_, tuningProfile_.stagingChunkSize);
+    commandQueue_ = MakeUnique<D3D11CommandQueue>(device_.Get(), context_, *stateMngr_);
+}
+
+void D3D11RenderSystem::SelectTuningProfile(const RendererConfigurationDirect3D11* config)
+{
+    /* Find adapter the device was created with, since the default adapter might have been selected by the runtime */
+    DeviceVendor vendor = DeviceVendor::Undefined;
+
+    ComPtr<IDXGIDevice> deviceDXGI;
+    ComPtr<IDXGIAdapter> adapter;
+    DXGI_ADAPTER_DESC adapterDesc;
+    if (SUCCEEDED(device_.As(&deviceDXGI)) && SUCCEEDED(deviceDXGI->GetAdapter(adapter.ReleaseAndGetAddressOf())) && SUCCEEDED(adapter->GetDesc(&adapterDesc)))
+        vendor = GetVendorByID(static_cast<std::uint16_t>(adapterDesc.VendorId));
+
+    tuningProfile_ = GetVendorTuningProfile(vendor);
+    if (config != nullptr)
+        tuningProfile_.stagingChunkSize = GetTuningSize(config->stagingChunkSize, tuningProfile_.stagingChunkSize);
 }
 
 void D3D11RenderSystem::QueryRendererInfo()
@@ -632,16 +786,24 @@ void D3D11RenderSystem::QueryRendererInfo()
     /* Initialize HLSL version string */
     info.shadingLanguageName = "HLSL " + std::string(DXFeatureLevelToShaderModel(GetFeatureLevel()));
 
+    /* Find adapter the device was created with */
+    ComPtr<IDXGIDevice> deviceDXGI;
+    ComPtr<IDXGIAdapter> adapter;
+    if (SUCCEEDED(device_.As(&deviceDXGI)) && SUCCEEDED(deviceDXGI->GetAdapter(adapter.ReleaseAndGetAddressOf())))
+        info.adapterIndex = DXFindOrAppendVideoAdapter(videoAdatperDescs_, adapter.Get());
+
     /* Initialize video adapter strings */
-    if (!videoAdatperDescs_.empty())
+    if (info.adapterIndex < videoAdatperDescs_.size())
     {
-        const auto& videoAdapterDesc = videoAdatperDescs_.front();
+        const auto& videoAdapterDesc = videoAdatperDescs_[info.adapterIndex];
         info.deviceName = ToUTF8String(videoAdapterDesc.name);
         info.vendorName = videoAdapterDesc.vendor;
     }
     else
         info.deviceName = info.vendorName = "<no adapter found>";
 
+    info.videoAdapters = videoAdatperDescs_;
+
     SetRendererInfo(info);
 }
 
@@ -35,6 +35,8 @@
 
 #include "../ContainerTypes.h"
 #include "../DXCommon/ComPtr.h"
+#include "../DXCommon/DXShaderCache.h"
+#include "../../Core/VendorTuning.h"
 
 #include <dxgi.h>
 #include "Direct3D11.h"
@@ -84,6 +86,9 @@ class D3D11RenderSystem final : public RenderSystem
         bool CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, UINT flags, HRESULT& hr);
         void CreateStateManagerAndCommandQueue();
 
+        // Selects the tuning profile by the vendor of the adapter the device was created with.
+        void SelectTuningProfile(const RendererConfigurationDirect3D11* config);
+
         void QueryRendererInfo();
         void QueryRenderingCaps();
 
@@ -122,6 +127,8 @@ class D3D11RenderSystem final : public RenderSystem
 
         std::shared_ptr<D3D11StateManager>      stateMngr_;
 
+        DXShaderCache                           shaderCache_;
+
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<D3D11SwapChain>       swapChains_;
@@ -143,6 +150,7 @@ class D3D11RenderSystem final : public RenderSystem
         /* ----- Other members ----- */
 
         std::vector<VideoAdapterDescriptor>     videoAdatperDescs_;
+        VendorTuningProfile                     tuningProfile_;
 
 };
 
@@ -10,8 +10,10 @@
 #include "D3D11ObjectUtils.h"
 #include "../DXCommon/DXTypes.h"
 #include "../../Core/CoreUtils.h"
+#include "../HostTrace.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include <LLGL/Log.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -31,6 +33,10 @@ D3D11SwapChain::D3D11SwapChain(
     /* Setup surface for the swap-chain */
     SetOrCreateSurface(surface, desc.resolution, desc.fullscreen, nullptr);
 
+    /* Only keep explicit presentation mode if it's supported */
+    if (IsPresentModeSupported(desc.presentMode))
+        presentMode_ = desc.presentMode;
+
     /* Create D3D objects */
     CreateSwapChain(factory, desc.resolution, desc.samples, desc.swapBuffers);
     CreateBackBuffer();
@@ -64,7 +70,21 @@ void D3D11SwapChain::SetName(const char* name)
 
 void D3D11SwapChain::Present()
 {
-    swapChain_->Present(swapChainInterval_, 0);
+    LLGL_HOST_TRACE_SCOPE("Present");
+
+    /* Bit-block transfer swap-chains tear with a sync interval of zero, which is used for the immediate presentation mode */
+    switch (presentMode_)
+    {
+        case PresentMode::Immediate:
+            swapChain_->Present(0, 0);
+            break;
+        case PresentMode::Fifo:
+            swapChain_->Present(std::max(1u, swapChainInterval_), 0);
+            break;
+        default:
+            swapChain_->Present(swapChainInterval_, 0);
+            break;
+    }
 }
 
 std::uint32_t D3D11SwapChain::GetCurrentSwapIndex() const
@@ -102,6 +122,24 @@ bool D3D11SwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
     return SetPresentSyncInterval(vsyncInterval);
 }
 
+bool D3D11SwapChain::SetMaxFrameLatency(std::uint32_t maxFrameLatency)
+{
+    /* IDXGIDevice1::SetMaximumFrameLatency expects a frame latency in the range [1, 16]; this applies to all swap-chains of the device */
+    if (maxFrameLatency == 0 || maxFrameLatency > 16)
+        return false;
+
+    ComPtr<IDXGIDevice1> deviceDXGI;
+    if (FAILED(device_.As(&deviceDXGI)))
+        return false;
+
+    return SUCCEEDED(deviceDXGI->SetMaximumFrameLatency(maxFrameLatency));
+}
+
+bool D3D11SwapChain::IsPresentModeSupported(PresentMode presentMode) const
+{
+    return (presentMode == PresentMode::Default || presentMode == PresentMode::Fifo || presentMode == PresentMode::Immediate);
+}
+
 void D3D11SwapChain::BindFramebufferView(D3D11CommandBuffer* commandBuffer)
 {
     /* Bind framebuffer of this swap-chain in command buffer */
@@ -47,6 +47,8 @@ class D3D11SwapChain final : public SwapChain
         const RenderPass* GetRenderPass() const override;
 
         bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+        bool SetMaxFrameLatency(std::uint32_t maxFrameLatency) override;
+        bool IsPresentModeSupported(PresentMode presentMode) const override;
 
     public:
 
@@ -81,6 +83,7 @@ class D3D11SwapChain final : public SwapChain
 
         ComPtr<IDXGISwapChain>          swapChain_;
         UINT                            swapChainInterval_      = 0;
+        PresentMode                     presentMode_            = PresentMode::Default;
         DXGI_SAMPLE_DESC                swapChainSampleDesc_    = { 1, 0 };
 
         ComPtr<ID3D11Texture2D>         colorBuffer_;
@@ -0,0 +1,159 @@
+/*
+ * D3D11BindingSlotCache.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_D3D11_BINDING_SLOT_CACHE_H
+#define LLGL_D3D11_BINDING_SLOT_CACHE_H
+
+
+#include <d3d11.h>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Shadow copy of the objects bound to the slots of a single shader stage, e.g. all SRVs of the pixel shader stage.
+Each slot has a 'known' bit, which means the cached object matches the one bound to the device context,
+and a 'dirty' bit, which means the cached object must still be submitted to the device context.
+*/
+template <typename T, std::size_t N>
+class D3D11BindingSlotCache
+{
+
+    public:
+
+        static constexpr UINT numSlots = static_cast<UINT>(N);
+
+    public:
+
+        // Resets all slots to null. This must only be used when the device context is known to be in its default state.
+        void Reset()
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                objects_[i] = nullptr;
+            for (std::size_t i = 0; i < numMaskWords; ++i)
+            {
+                known_[i] = ~std::uint64_t(0);
+                dirty_[i] = 0;
+            }
+        }
+
+        // Stores the specified objects for the slots [startSlot, startSlot + count) and returns true if any slot has become dirty.
+        bool Set(UINT startSlot, UINT count, T* const* objects)
+        {
+            bool modified = false;
+            for (UINT i = 0; i < count && startSlot + i < numSlots; ++i)
+            {
+                const UINT slot = startSlot + i;
+                if (!(IsKnown(slot) && objects_[slot] == objects[i]))
+                {
+                    objects_[slot] = objects[i];
+                    dirty_[slot / 64] |= (std::uint64_t(1) << (slot % 64));
+                    modified = true;
+                }
+            }
+            return modified;
+        }
+
+        // Marks the slots [startSlot, startSlot + count) as unknown, which must be used when they have been bound directly with the device context.
+        void Invalidate(UINT startSlot, UINT count)
+        {
+            for (UINT slot = startSlot; slot < startSlot + count && slot < numSlots; ++slot)
+            {
+                const std::uint64_t bit = (std::uint64_t(1) << (slot % 64));
+                known_[slot / 64] &= ~bit;
+                dirty_[slot / 64] &= ~bit;
+            }
+        }
+
+        // Marks all slots as unknown.
+        void InvalidateAll()
+        {
+            for (std::size_t i = 0; i < numMaskWords; ++i)
+            {
+                known_[i] = 0;
+                dirty_[i] = 0;
+            }
+        }
+
+        /*
+        Calls the specified function for each contiguous range of dirty slots and marks them as known afterwards.
+        The function must have the signature void(UINT startSlot, UINT count, T* const* objects).
+        */
+        template <typename TFunc>
+        void Flush(const TFunc& func)
+        {
+            UINT slot = 0;
+            while (slot < numSlots)
+            {
+                /* Skip entire mask words without dirty slots */
+                if (dirty_[slot / 64] == 0)
+                {
+                    slot = (slot / 64 + 1) * 64;
+                    continue;
+                }
+
+                if (!IsDirty(slot))
+                {
+                    ++slot;
+                    continue;
+                }
+
+                /* Find end of contiguous range of dirty slots */
+                UINT endSlot = slot + 1;
+                while (endSlot < numSlots && IsDirty(endSlot))
+                    ++endSlot;
+
+                func(slot, endSlot - slot, &(objects_[slot]));
+
+                for (UINT i = slot; i < endSlot; ++i)
+                {
+                    const std::uint64_t bit = (std::uint64_t(1) << (i % 64));
+                    known_[i / 64] |= bit;
+                    dirty_[i / 64] &= ~bit;
+                }
+
+                slot = endSlot;
+            }
+        }
+
+    private:
+
+        static constexpr std::size_t numMaskWords = (N + 63) / 64;
+
+    private:
+
+        inline bool IsKnown(UINT slot) const
+        {
+            return ((known_[slot / 64] >> (slot % 64)) & 1) != 0;
+        }
+
+        inline bool IsDirty(UINT slot) const
+        {
+            return ((dirty_[slot / 64] >> (slot % 64)) & 1) != 0;
+        }
+
+    private:
+
+        T*              objects_[N]             = {};
+        std::uint64_t   known_[numMaskWords]    = {};
+        std::uint64_t   dirty_[numMaskWords]    = {};
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
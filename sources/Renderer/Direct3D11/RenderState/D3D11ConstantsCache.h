@@ -28,14 +28,17 @@ namespace LLGL
 class D3D11Shader;
 class D3D11StateManager;
 
-// Manages the CPU data of a D3D11 constant buffer for dynamic uniforms; See 'PipelineLayoutDescriptor::uniforms'.
+/*
+Manages the CPU data of a D3D11 constant buffer for dynamic uniforms; See 'PipelineLayoutDescriptor::uniforms'.
+The instance owned by a PSO only serves as template; each command buffer encodes uniforms into its own copy.
+*/
 class D3D11ConstantsCache
 {
 
     public:
 
-        D3D11ConstantsCache(const D3D11ConstantsCache&) = delete;
-        D3D11ConstantsCache& operator = (const D3D11ConstantsCache&) = delete;
+        D3D11ConstantsCache(const D3D11ConstantsCache&) = default;
+        D3D11ConstantsCache& operator = (const D3D11ConstantsCache&) = default;
 
         D3D11ConstantsCache(
             const ArrayView<D3D11Shader*>&      shaders,
@@ -27,7 +27,7 @@ D3D11Fence::D3D11Fence(ID3D11Device* device)
 
 void D3D11Fence::Submit(ID3D11DeviceContext* context)
 {
-    context->End(query_.Get());
+    Submit(context, value_ + 1);
 }
 
 void D3D11Fence::Wait(ID3D11DeviceContext* context)
@@ -35,6 +35,25 @@ void D3D11Fence::Wait(ID3D11DeviceContext* context)
     while (context->GetData(query_.Get(), nullptr, 0, 0) == S_FALSE) { /* dummy */ }
 }
 
+void D3D11Fence::Submit(ID3D11DeviceContext* context, std::uint64_t value)
+{
+    context->End(query_.Get());
+    value_ = value;
+}
+
+bool D3D11Fence::Wait(ID3D11DeviceContext* context, std::uint64_t value, std::uint64_t timeout)
+{
+    if (value > value_)
+        return false;
+
+    /* Only poll the event query if no timeout is specified */
+    if (timeout == 0)
+        return (context->GetData(query_.Get(), nullptr, 0, 0) == S_OK);
+
+    Wait(context);
+    return true;
+}
+
 
 } // /namespace LLGL
 
@@ -29,9 +29,22 @@ class D3D11Fence final : public Fence
         void Submit(ID3D11DeviceContext* context);
         void Wait(ID3D11DeviceContext* context);
 
+        // Submits the event query and stores the specified value as the last signaled value.
+        void Submit(ID3D11DeviceContext* context, std::uint64_t value);
+
+        // Waits until the specified value has been signaled. Only the last submitted value can be tracked by the event query.
+        bool Wait(ID3D11DeviceContext* context, std::uint64_t value, std::uint64_t timeout);
+
+        // Returns the last submitted value.
+        inline std::uint64_t GetSignaledValue() const
+        {
+            return value_;
+        }
+
     private:
 
         ComPtr<ID3D11Query> query_;
+        std::uint64_t       value_  = 0;
 
 };
 
@@ -46,8 +46,8 @@ class D3D11PipelineState : public PipelineState
             return pipelineLayout_;
         }
 
-        // Returns a pointer to the constants cache for this PSO or null if this PSO was created without global uniforms.
-        inline D3D11ConstantsCache* GetConstantsCache() const
+        // Returns a pointer to the constants cache template for this PSO or null if this PSO was created without global uniforms.
+        inline const D3D11ConstantsCache* GetConstantsCache() const
         {
             return constantsCache_.get();
         }
@@ -40,6 +40,9 @@ static std::uint32_t GetDXQueryGroupSize(D3D11_QUERY queryType)
     /* For timestamp, use group size of 3: one primary and two secondary <ID3D11Query> objects */
     if (queryType == D3D11_QUERY_TIMESTAMP_DISJOINT)
         return 3u;
+    /* For single timestamps, use group size of 2: one disjoint query to determine the frequency and one timestamp query */
+    else if (queryType == D3D11_QUERY_TIMESTAMP)
+        return 2u;
     else
         return 1u;
 }
@@ -83,6 +86,20 @@ D3D11QueryHeap::D3D11QueryHeap(ID3D11Device* device, const QueryHeapDescriptor&
             nativeQueries_.push_back(DXCreateQuery(device, timerQueryDesc));
         }
     }
+    else if (nativeType_ == D3D11_QUERY_TIMESTAMP)
+    {
+        D3D11_QUERY_DESC disjointQueryDesc;
+        {
+            disjointQueryDesc.Query     = D3D11_QUERY_TIMESTAMP_DISJOINT;
+            disjointQueryDesc.MiscFlags = 0;
+        }
+
+        for (std::uint32_t i = 0; i < numNativeQueries; i += groupSize_)
+        {
+            nativeQueries_.push_back(DXCreateQuery(device, disjointQueryDesc));
+            nativeQueries_.push_back(DXCreateQuery(device, queryDesc));
+        }
+    }
     else
     {
         for (std::uint32_t i = 0; i < numNativeQueries; i += groupSize_)
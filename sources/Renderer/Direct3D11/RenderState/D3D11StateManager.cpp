@@ -17,23 +17,73 @@ namespace LLGL
 {
 
 
-static constexpr UINT g_cbufferChunkSize = 4096u;
+static constexpr UINT g_cbufferChunkSize       = 4096u;
+static constexpr UINT g_cbufferRingChunkSize   = 65536u;
 
-D3D11StateManager::D3D11StateManager(ID3D11Device* device, const ComPtr<ID3D11DeviceContext>& context) :
+// Default chunk size and alignment (in bytes) of the ring of dynamic buffers for buffer updates (see D3D11StateManager::UpdateBufferFromRing).
+static constexpr UINT g_updateRingChunkSize    = 262144u;
+static constexpr UINT g_updateRingAlignment    = 16u;
+
+/*
+Returns true if intermediate constant buffers can be sub-allocated like a ring buffer,
+i.e. mapped with D3D11_MAP_WRITE_NO_OVERWRITE and bound with an offset via *SSetConstantBuffers1.
+*/
+static bool IsConstantBufferRingSupported(ID3D11Device* device, ID3D11DeviceContext* context)
+{
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    ComPtr<ID3D11DeviceContext1> context1;
+    if (FAILED(context->QueryInterface(IID_PPV_ARGS(&context1))))
+        return false;
+
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+    if (FAILED(device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+        return false;
+
+    return (options.ConstantBufferOffsetting != FALSE && options.MapNoOverwriteOnDynamicConstantBuffer != FALSE);
+    #else
+    return false;
+    #endif
+}
+
+D3D11StateManager::D3D11StateManager(ID3D11Device* device, const ComPtr<ID3D11DeviceContext>& context, UINT64 updateRingChunkSize) :
+    D3D11StateManager { device, context, updateRingChunkSize, IsConstantBufferRingSupported(device, context.Get()) }
+{
+}
+
+D3D11StateManager::D3D11StateManager(ID3D11Device* device, const ComPtr<ID3D11DeviceContext>& context, UINT64 updateRingChunkSize, bool isCbufferRing) :
     context_ { context },
     stagingCbufferPool_
     {
         device,
         context.Get(),
-        g_cbufferChunkSize,
+        (isCbufferRing ? g_cbufferRingChunkSize : g_cbufferChunkSize),
         D3D11_USAGE_DYNAMIC,
         D3D11_CPU_ACCESS_WRITE,
-        D3D11_BIND_CONSTANT_BUFFER
+        D3D11_BIND_CONSTANT_BUFFER,
+        isCbufferRing
+    },
+    stagingUpdatePool_
+    {
+        device,
+        context.Get(),
+        (updateRingChunkSize > 0 ? static_cast<UINT>(updateRingChunkSize) : g_updateRingChunkSize),
+        D3D11_USAGE_DYNAMIC,
+        D3D11_CPU_ACCESS_WRITE,
+        D3D11_BIND_VERTEX_BUFFER, // Dynamic vertex buffers support D3D11_MAP_WRITE_NO_OVERWRITE on all feature levels
+        true
     }
 {
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
     context_->QueryInterface(IID_PPV_ARGS(&context1_));
     #endif
+
+    /* Device contexts start with all resource slots unbound */
+    for (D3DStageBindings& bindings : stageBindings_)
+    {
+        bindings.constantBuffers.Reset();
+        bindings.shaderResources.Reset();
+        bindings.samplers.Reset();
+    }
 }
 
 // Check if D3D11_VIEWPORT and Viewport structures can be safely reinterpret-casted
@@ -265,12 +315,12 @@ void D3D11StateManager::SetConstantBuffers(
     ID3D11Buffer* const*    buffers,
     long                    stageFlags)
 {
-    if (LLGL_VS_STAGE(stageFlags)) { context_->VSSetConstantBuffers(startSlot, count, buffers); }
-    if (LLGL_HS_STAGE(stageFlags)) { context_->HSSetConstantBuffers(startSlot, count, buffers); }
-    if (LLGL_DS_STAGE(stageFlags)) { context_->DSSetConstantBuffers(startSlot, count, buffers); }
-    if (LLGL_GS_STAGE(stageFlags)) { context_->GSSetConstantBuffers(startSlot, count, buffers); }
-    if (LLGL_PS_STAGE(stageFlags)) { context_->PSSetConstantBuffers(startSlot, count, buffers); }
-    if (LLGL_CS_STAGE(stageFlags)) { context_->CSSetConstantBuffers(startSlot, count, buffers); }
+    const UINT stageMask = GetShaderStageMask(stageFlags);
+    for_range(stage, D3DShaderStage_Count)
+    {
+        if ((stageMask & (1u << stage)) != 0 && stageBindings_[stage].constantBuffers.Set(startSlot, count, buffers))
+            dirtyStages_ |= (1u << stage);
+    }
 }
 
 void D3D11StateManager::SetConstantBuffersRange(
@@ -281,6 +331,14 @@ void D3D11StateManager::SetConstantBuffersRange(
     const UINT*             numConstants,
     long                    stageFlags)
 {
+    /* Buffer ranges are bound immediately, so pending bindings for these slots are overridden */
+    const UINT stageMask = GetShaderStageMask(stageFlags);
+    for_range(stage, D3DShaderStage_Count)
+    {
+        if ((stageMask & (1u << stage)) != 0)
+            stageBindings_[stage].constantBuffers.Invalidate(startSlot, count);
+    }
+
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
     if (context1_ != nullptr)
     {
@@ -320,12 +378,12 @@ void D3D11StateManager::SetShaderResources(
     ID3D11ShaderResourceView* const*    views,
     long                                stageFlags)
 {
-    if (LLGL_VS_STAGE(stageFlags)) { context_->VSSetShaderResources(startSlot, count, views); }
-    if (LLGL_HS_STAGE(stageFlags)) { context_->HSSetShaderResources(startSlot, count, views); }
-    if (LLGL_DS_STAGE(stageFlags)) { context_->DSSetShaderResources(startSlot, count, views); }
-    if (LLGL_GS_STAGE(stageFlags)) { context_->GSSetShaderResources(startSlot, count, views); }
-    if (LLGL_PS_STAGE(stageFlags)) { context_->PSSetShaderResources(startSlot, count, views); }
-    if (LLGL_CS_STAGE(stageFlags)) { context_->CSSetShaderResources(startSlot, count, views); }
+    const UINT stageMask = GetShaderStageMask(stageFlags);
+    for_range(stage, D3DShaderStage_Count)
+    {
+        if ((stageMask & (1u << stage)) != 0 && stageBindings_[stage].shaderResources.Set(startSlot, count, views))
+            dirtyStages_ |= (1u << stage);
+    }
 }
 
 void D3D11StateManager::SetUnorderedAccessViews(
@@ -362,32 +420,47 @@ void D3D11StateManager::SetSamplers(
     ID3D11SamplerState* const*  samplers,
     long                        stageFlags)
 {
-    if (LLGL_VS_STAGE(stageFlags)) { context_->VSSetSamplers(startSlot, count, samplers); }
-    if (LLGL_HS_STAGE(stageFlags)) { context_->HSSetSamplers(startSlot, count, samplers); }
-    if (LLGL_DS_STAGE(stageFlags)) { context_->DSSetSamplers(startSlot, count, samplers); }
-    if (LLGL_GS_STAGE(stageFlags)) { context_->GSSetSamplers(startSlot, count, samplers); }
-    if (LLGL_PS_STAGE(stageFlags)) { context_->PSSetSamplers(startSlot, count, samplers); }
-    if (LLGL_CS_STAGE(stageFlags)) { context_->CSSetSamplers(startSlot, count, samplers); }
+    const UINT stageMask = GetShaderStageMask(stageFlags);
+    for_range(stage, D3DShaderStage_Count)
+    {
+        if ((stageMask & (1u << stage)) != 0 && stageBindings_[stage].samplers.Set(startSlot, count, samplers))
+            dirtyStages_ |= (1u << stage);
+    }
 }
 
 void D3D11StateManager::SetGraphicsStaticSampler(const D3D11StaticSampler& staticSamplerD3D)
 {
-    if (LLGL_VS_STAGE(staticSamplerD3D.stageFlags))
-        context_->VSSetSamplers(staticSamplerD3D.slot, 1, staticSamplerD3D.native.GetAddressOf());
-    if (LLGL_HS_STAGE(staticSamplerD3D.stageFlags))
-        context_->HSSetSamplers(staticSamplerD3D.slot, 1, staticSamplerD3D.native.GetAddressOf());
-    if (LLGL_DS_STAGE(staticSamplerD3D.stageFlags))
-        context_->DSSetSamplers(staticSamplerD3D.slot, 1, staticSamplerD3D.native.GetAddressOf());
-    if (LLGL_GS_STAGE(staticSamplerD3D.stageFlags))
-        context_->GSSetSamplers(staticSamplerD3D.slot, 1, staticSamplerD3D.native.GetAddressOf());
-    if (LLGL_PS_STAGE(staticSamplerD3D.stageFlags))
-        context_->PSSetSamplers(staticSamplerD3D.slot, 1, staticSamplerD3D.native.GetAddressOf());
+    SetSamplers(staticSamplerD3D.slot, 1, staticSamplerD3D.native.GetAddressOf(), staticSamplerD3D.stageFlags & StageFlags::AllGraphicsStages);
 }
 
 void D3D11StateManager::SetComputeStaticSampler(const D3D11StaticSampler& staticSamplerD3D)
 {
-    if (LLGL_CS_STAGE(staticSamplerD3D.stageFlags))
-        context_->CSSetSamplers(staticSamplerD3D.slot, 1, staticSamplerD3D.native.GetAddressOf());
+    SetSamplers(staticSamplerD3D.slot, 1, staticSamplerD3D.native.GetAddressOf(), staticSamplerD3D.stageFlags & StageFlags::ComputeStage);
+}
+
+void D3D11StateManager::FlushResourceBindings()
+{
+    if (dirtyStages_ == 0)
+        return;
+
+    for_range(stage, D3DShaderStage_Count)
+    {
+        if ((dirtyStages_ & (1u << stage)) != 0)
+            FlushStageBindings(static_cast<D3DShaderStage>(stage), stageBindings_[stage]);
+    }
+
+    dirtyStages_ = 0;
+}
+
+void D3D11StateManager::InvalidateResourceBindings()
+{
+    for (D3DStageBindings& bindings : stageBindings_)
+    {
+        bindings.constantBuffers.InvalidateAll();
+        bindings.shaderResources.InvalidateAll();
+        bindings.samplers.InvalidateAll();
+    }
+    dirtyStages_ = 0;
 }
 
 void D3D11StateManager::SetConstants(UINT slot, const void* data, UINT dataSize, long stageFlags)
@@ -404,6 +477,16 @@ void D3D11StateManager::SetConstants(UINT slot, const void* data, UINT dataSize,
     SetConstantBuffersRange(slot, 1, buffers, firstConstants, numConstants, stageFlags);
 }
 
+void D3D11StateManager::UpdateBufferFromRing(ID3D11Buffer* dstBuffer, UINT dstOffset, const void* data, UINT dataSize)
+{
+    /* Write data into the next range of the dynamic buffer ring; only the first write into each chunk discards it */
+    const D3D11BufferRange srcRange = stagingUpdatePool_.Write(data, dataSize, g_updateRingAlignment);
+
+    /* Copy range from ring into destination buffer on the GPU */
+    const D3D11_BOX srcBox{ srcRange.offset, 0, 0, srcRange.offset + dataSize, 1, 1 };
+    context_->CopySubresourceRegion(dstBuffer, 0, dstOffset, 0, 0, srcRange.native, 0, &srcBox);
+}
+
 void D3D11StateManager::DispatchBuiltin(const D3D11BuiltinShader builtinShader, UINT numWorkGroupsX, UINT numWorkGroupsY, UINT numWorkGroupsZ)
 {
     ID3D11ComputeShader* cs = D3D11BuiltinShaderFactory::Get().GetBulitinShader(builtinShader).cs.Get();
@@ -415,8 +498,90 @@ void D3D11StateManager::DispatchBuiltin(const D3D11BuiltinShader builtinShader,
 void D3D11StateManager::ResetStagingBufferPools()
 {
     stagingCbufferPool_.Reset();
+    stagingUpdatePool_.Reset();
 }
 
+void D3D11StateManager::SetStagingBufferPoolTrimPolicy(UINT64 minSize, UINT trimFrames)
+{
+    stagingCbufferPool_.SetTrimPolicy(minSize, trimFrames);
+    stagingUpdatePool_.SetTrimPolicy(minSize, trimFrames);
+}
+
+void D3D11StateManager::TrimStagingBufferPools()
+{
+    stagingCbufferPool_.Trim();
+    stagingUpdatePool_.Trim();
+}
+
+void D3D11StateManager::ResetCachedStates()
+{
+    inputAssemblyState_ = D3DInputAssemblyState{};
+    shaderState_        = D3DShaderState{};
+    renderState_        = D3DRenderState{};
+
+    /* Device context is in its default state, i.e. all resource slots are unbound */
+    for (D3DStageBindings& bindings : stageBindings_)
+    {
+        bindings.constantBuffers.Reset();
+        bindings.shaderResources.Reset();
+        bindings.samplers.Reset();
+    }
+    dirtyStages_ = 0;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+UINT D3D11StateManager::GetShaderStageMask(long stageFlags)
+{
+    UINT mask = 0;
+    if (LLGL_VS_STAGE(stageFlags)) { mask |= (1u << D3DShaderStage_VS); }
+    if (LLGL_HS_STAGE(stageFlags)) { mask |= (1u << D3DShaderStage_HS); }
+    if (LLGL_DS_STAGE(stageFlags)) { mask |= (1u << D3DShaderStage_DS); }
+    if (LLGL_GS_STAGE(stageFlags)) { mask |= (1u << D3DShaderStage_GS); }
+    if (LLGL_PS_STAGE(stageFlags)) { mask |= (1u << D3DShaderStage_PS); }
+    if (LLGL_CS_STAGE(stageFlags)) { mask |= (1u << D3DShaderStage_CS); }
+    return mask;
+}
+
+#define LLGL_D3D11_FLUSH_STAGE_BINDINGS(STAGE)                                                                                      \
+    bindings.constantBuffers.Flush(                                                                                                 \
+        [this](UINT startSlot, UINT count, ID3D11Buffer* const* buffers)                                                            \
+        {                                                                                                                           \
+            context_->STAGE##SetConstantBuffers(startSlot, count, buffers);                                                         \
+        }                                                                                                                           \
+    );                                                                                                                              \
+    bindings.shaderResources.Flush(                                                                                                 \
+        [this](UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views)                                                  \
+        {                                                                                                                           \
+            context_->STAGE##SetShaderResources(startSlot, count, views);                                                           \
+        }                                                                                                                           \
+    );                                                                                                                              \
+    bindings.samplers.Flush(                                                                                                        \
+        [this](UINT startSlot, UINT count, ID3D11SamplerState* const* samplers)                                                     \
+        {                                                                                                                           \
+            context_->STAGE##SetSamplers(startSlot, count, samplers);                                                               \
+        }                                                                                                                           \
+    )
+
+void D3D11StateManager::FlushStageBindings(D3DShaderStage stage, D3DStageBindings& bindings)
+{
+    switch (stage)
+    {
+        case D3DShaderStage_VS: LLGL_D3D11_FLUSH_STAGE_BINDINGS(VS); break;
+        case D3DShaderStage_HS: LLGL_D3D11_FLUSH_STAGE_BINDINGS(HS); break;
+        case D3DShaderStage_DS: LLGL_D3D11_FLUSH_STAGE_BINDINGS(DS); break;
+        case D3DShaderStage_GS: LLGL_D3D11_FLUSH_STAGE_BINDINGS(GS); break;
+        case D3DShaderStage_PS: LLGL_D3D11_FLUSH_STAGE_BINDINGS(PS); break;
+        case D3DShaderStage_CS: LLGL_D3D11_FLUSH_STAGE_BINDINGS(CS); break;
+        default:                                                     break;
+    }
+}
+
+#undef LLGL_D3D11_FLUSH_STAGE_BINDINGS
+
 
 } // /namespace LLGL
 
@@ -12,6 +12,7 @@
 #include "../../DXCommon/ComPtr.h"
 #include "../Shader/D3D11BuiltinShaderFactory.h"
 #include "../Buffer/D3D11StagingBufferPool.h"
+#include "D3D11BindingSlotCache.h"
 #include <LLGL/PipelineStateFlags.h>
 #include <vector>
 #include <cstdint>
@@ -29,7 +30,8 @@ class D3D11StateManager
 
     public:
 
-        D3D11StateManager(ID3D11Device* device, const ComPtr<ID3D11DeviceContext>& context);
+        // Initializes the state manager with the chunk size of the buffer update ring. Zero selects the default chunk size.
+        D3D11StateManager(ID3D11Device* device, const ComPtr<ID3D11DeviceContext>& context, UINT64 updateRingChunkSize = 0);
 
         void SetViewports(std::uint32_t numViewports, const Viewport* viewportArray);
         void SetScissors(std::uint32_t numScissors, const Scissor* scissorArray);
@@ -54,6 +56,10 @@ class D3D11StateManager
         void SetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask);
         void SetBlendFactor(const FLOAT blendFactor[4]);
 
+        /*
+        Constant buffers, shader resource views, and samplers are not bound immediately.
+        Only the slots that differ from what is bound to the device context are submitted with the next call to FlushResourceBindings().
+        */
         void SetConstantBuffers(
             UINT                    startSlot,
             UINT                    count,
@@ -61,6 +67,7 @@ class D3D11StateManager
             long                    stageFlags
         );
 
+        // Binds the constant buffer ranges immediately.
         void SetConstantBuffersRange(
             UINT                    startSlot,
             UINT                    count,
@@ -77,6 +84,7 @@ class D3D11StateManager
             long                                stageFlags
         );
 
+        // Binds the UAVs immediately.
         void SetUnorderedAccessViews(
             UINT                                startSlot,
             UINT                                count,
@@ -95,21 +103,50 @@ class D3D11StateManager
         void SetGraphicsStaticSampler(const D3D11StaticSampler& staticSamplerD3D);
         void SetComputeStaticSampler(const D3D11StaticSampler& staticSamplerD3D);
 
+        // Submits all pending constant buffers, SRVs, and samplers in contiguous slot ranges. Must be called before each draw and dispatch command.
+        void FlushResourceBindings();
+
+        // Invalidates the cached resource bindings. Must be called after resources have been bound directly with the device context, e.g. by a resource heap.
+        void InvalidateResourceBindings();
+
         // Binds an intermediate constant buffer and updates its content with the specified data.
         void SetConstants(UINT slot, const void* data, UINT dataSize, long stageFlags);
 
+        /*
+        Writes the specified data into a ring of dynamic buffers with D3D11_MAP_WRITE_NO_OVERWRITE and copies it into the destination buffer.
+        This avoids renaming the destination buffer or allocating an intermediate buffer for each update.
+        */
+        void UpdateBufferFromRing(ID3D11Buffer* dstBuffer, UINT dstOffset, const void* data, UINT dataSize);
+
         // Executes the specified builtin compute shader.
         void DispatchBuiltin(const D3D11BuiltinShader builtinShader, UINT numWorkGroupsX, UINT numWorkGroupsY, UINT numWorkGroupsZ);
 
         // Must be called in D3D11CommandBuffer::Begin().
         void ResetStagingBufferPools();
 
+        // Specifies the trim policy of the staging buffer pools (see CommandBufferDescriptor::minStagingPoolSize and stagingPoolTrimFrames).
+        void SetStagingBufferPoolTrimPolicy(UINT64 minSize, UINT trimFrames);
+
+        // Releases the memory of the staging buffer pools down to their minimum size.
+        void TrimStagingBufferPools();
+
+        /*
+        Invalidates the cached input-assembly, shader, render states, and resource bindings.
+        Must be called whenever the device context is cleared behind the state manager's back,
+        e.g. after FinishCommandList() or ExecuteCommandList() without restoring the previous context state.
+        */
+        void ResetCachedStates();
+
         // Returns the ID3D11DeviceContext that this state manager is associated with.
         inline ID3D11DeviceContext* GetContext() const
         {
             return context_.Get();
         }
 
+    private:
+
+        D3D11StateManager(ID3D11Device* device, const ComPtr<ID3D11DeviceContext>& context, UINT64 updateRingChunkSize, bool isCbufferRing);
+
     private:
 
         struct D3DInputAssemblyState
@@ -138,6 +175,34 @@ class D3D11StateManager
             UINT                        sampleMask          = 0xffffffff;
         };
 
+        // Resource bindings of a single shader stage.
+        struct D3DStageBindings
+        {
+            D3D11BindingSlotCache<ID3D11Buffer, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT>              constantBuffers;
+            D3D11BindingSlotCache<ID3D11ShaderResourceView, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT>       shaderResources;
+            D3D11BindingSlotCache<ID3D11SamplerState, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT>                    samplers;
+        };
+
+        // Shader stages in the order of 'stageBindings_'.
+        enum D3DShaderStage
+        {
+            D3DShaderStage_VS = 0,
+            D3DShaderStage_HS,
+            D3DShaderStage_DS,
+            D3DShaderStage_GS,
+            D3DShaderStage_PS,
+            D3DShaderStage_CS,
+
+            D3DShaderStage_Count,
+        };
+
+    private:
+
+        // Returns the bitmask of D3DShaderStage entries for the specified stage flags.
+        static UINT GetShaderStageMask(long stageFlags);
+
+        void FlushStageBindings(D3DShaderStage stage, D3DStageBindings& bindings);
+
     private:
 
         ComPtr<ID3D11DeviceContext>     context_;
@@ -147,11 +212,15 @@ class D3D11StateManager
         #endif
 
         D3D11StagingBufferPool          stagingCbufferPool_;
+        D3D11StagingBufferPool          stagingUpdatePool_;
 
         D3DInputAssemblyState           inputAssemblyState_;
         D3DShaderState                  shaderState_;
         D3DRenderState                  renderState_;
 
+        D3DStageBindings                stageBindings_[D3DShaderStage_Count];
+        UINT                            dirtyStages_        = 0; // Bitmask of D3DShaderStage entries with pending resource bindings
+
 };
 
 
@@ -10,6 +10,7 @@
 #include "../D3D11ObjectUtils.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../DXCommon/DXTypes.h"
+#include "../../DXCommon/DXShaderCache.h"
 #include "../../../Core/CoreUtils.h"
 #include "../../../Core/StringUtils.h"
 #include "../../../Core/ReportUtils.h"
@@ -24,10 +25,10 @@ namespace LLGL
 {
 
 
-D3D11Shader::D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc) :
+D3D11Shader::D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc, const DXShaderCache& shaderCache) :
     Shader { desc.type }
 {
-    if (BuildShader(device, desc))
+    if (BuildShader(device, desc, shaderCache))
     {
         if (GetType() == ShaderType::Vertex)
         {
@@ -79,10 +80,10 @@ HRESULT D3D11Shader::ReflectAndCacheConstantBuffers(const std::vector<D3D11Const
  * ======= Private: =======
  */
 
-bool D3D11Shader::BuildShader(ID3D11Device* device, const ShaderDescriptor& shaderDesc)
+bool D3D11Shader::BuildShader(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const DXShaderCache& shaderCache)
 {
     if (IsShaderSourceCode(shaderDesc.sourceType))
-        return CompileSource(device, shaderDesc);
+        return CompileSource(device, shaderDesc, shaderCache);
     else
         return LoadBinary(device, shaderDesc);
 }
@@ -150,7 +151,7 @@ void D3D11Shader::BuildInputLayout(ID3D11Device* device, UINT numVertexAttribs,
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/dd607324(v=vs.85).aspx
-bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc)
+bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const DXShaderCache& shaderCache)
 {
     /* Get source code */
     std::string fileContent;
@@ -175,20 +176,17 @@ bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& sh
     auto        defines = reinterpret_cast<const D3D_SHADER_MACRO*>(shaderDesc.defines);
     auto        flags   = shaderDesc.flags;
 
-    /* Compile shader code */
+    /* Compile shader code or load it from the shader cache */
     ComPtr<ID3DBlob> errors;
-    auto hr = D3DCompile(
+    auto hr = shaderCache.Compile(
         sourceCode,
         sourceLength,
-        nullptr,                            // LPCSTR               pSourceName
-        defines,                            // D3D_SHADER_MACRO*    pDefines
-        nullptr,                            // ID3DInclude*         pInclude
-        entry,                              // LPCSTR               pEntrypoint
-        target,                             // LPCSTR               pTarget
-        DXGetCompilerFlags(flags),          // UINT                 Flags1
-        0,                                  // UINT                 Flags2 (recommended to always be 0)
-        byteCode_.ReleaseAndGetAddressOf(), // ID3DBlob**           ppCode
-        errors.ReleaseAndGetAddressOf()     // ID3DBlob**           ppErrorMsgs
+        defines,
+        entry,
+        target,
+        DXGetCompilerFlags(flags),
+        byteCode_.ReleaseAndGetAddressOf(),
+        errors.ReleaseAndGetAddressOf()
     );
 
     /* Get byte code from blob */
@@ -306,6 +304,9 @@ D3D11NativeShader D3D11Shader::CreateNativeShaderFromBlob(
             DXThrowIfCreateFailed(hr, "ID3D11ComputeShader");
         }
         break;
+
+        default:
+        break;
     }
 
     return native;
@@ -53,6 +53,8 @@ union D3D11NativeShader
     ComPtr<ID3D11ComputeShader>     cs;
 };
 
+class DXShaderCache;
+
 struct D3D11ConstantReflection
 {
     std::string name;   // Name of the constant buffer field.
@@ -80,7 +82,7 @@ class D3D11Shader final : public Shader
 
     public:
 
-        D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc);
+        D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc, const DXShaderCache& shaderCache);
 
         // Returns a list of all reflected constant buffers including their fields.
         HRESULT ReflectAndCacheConstantBuffers(const std::vector<D3D11ConstantBufferReflection>** outConstantBuffers);
@@ -117,10 +119,10 @@ class D3D11Shader final : public Shader
 
     private:
 
-        bool BuildShader(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
+        bool BuildShader(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const DXShaderCache& shaderCache);
         void BuildInputLayout(ID3D11Device* device, UINT numVertexAttribs, const VertexAttribute* vertexAttribs);
 
-        bool CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
+        bool CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const DXShaderCache& shaderCache);
         bool LoadBinary(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
 
         void CreateNativeShader(
@@ -14,12 +14,16 @@
 #include "../../TextureUtils.h"
 #include "../../../Core/Exception.h"
 #include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+// Maximum size (in bytes) of the staging buffer to convert image data for texture updates.
+static constexpr std::size_t g_maxConversionStagingSize = 4 * 1024 * 1024;
+
 D3D11Texture::D3D11Texture(ID3D11Device* device, const TextureDescriptor& desc) :
     Texture     { desc.type, desc.bindFlags },
     baseFormat_ { desc.format               }
@@ -185,6 +189,12 @@ SubresourceFootprint D3D11Texture::GetSubresourceFootprint(std::uint32_t mipLeve
     return CalcPackedSubresourceFootprint(GetType(), GetBaseFormat(), GetMipExtent(0), mipLevel, GetNumArrayLayers());
 }
 
+Extent3D D3D11Texture::GetSparseTileExtent() const
+{
+    /* Sparse textures are not supported by this backend */
+    return {};
+}
+
 static ComPtr<ID3D11Texture1D> DXCreateTexture1D(
     ID3D11Device*                   device,
     const D3D11_TEXTURE1D_DESC&     desc,
@@ -248,26 +258,57 @@ void D3D11Texture::UpdateSubresource(
         numArrayLayers
     );
 
-    ByteBuffer intermediateData;
     const char* srcData = reinterpret_cast<const char*>(imageDesc.data);
 
     if ((formatAttribs.flags & FormatFlags::IsCompressed) == 0 &&
         (formatAttribs.format != imageDesc.format || formatAttribs.dataType != imageDesc.dataType))
     {
-        /* Convert image data (e.g. from RGB to RGBA), and redirect initial data to new buffer */
-        intermediateData    = ConvertImageBuffer(imageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
-        srcData             = intermediateData.get();
-    }
-    else
-    {
-        /* Validate input data is large enough */
-        if (imageDesc.dataSize < dataLayout.dataSize)
+        /* Convert image data (e.g. from RGB to RGBA) in bands of rows, so the intermediate buffer does not grow with the texture size */
+        const UINT          depth               = dstBox.back - dstBox.front;
+        const std::size_t   stagingBufferSize   = std::min<std::size_t>(dataLayout.dataSize, g_maxConversionStagingSize);
+        ByteBuffer          stagingBuffer       = AllocateByteBuffer(stagingBufferSize, UninitializeTag{});
+
+        auto UpdateSubresourceBand = [&](std::uint32_t slice, std::uint32_t firstRow, std::uint32_t numRows, const void* data, std::size_t /*dataSize*/)
         {
-            LLGL_TRAP(
-                "image data size (%zu) is too small to update subresource of D3D11 texture (%u is required)",
-                imageDesc.dataSize, dataLayout.dataSize
+            D3D11_BOX bandBox = dstBox;
+            {
+                bandBox.top     = dstBox.top + firstRow;
+                bandBox.bottom  = bandBox.top + numRows;
+                bandBox.front   = dstBox.front + slice % depth;
+                bandBox.back    = bandBox.front + 1;
+            }
+            UINT dstSubresource = CalcSubresource(mipLevel, baseArrayLayer + slice / depth);
+            context->UpdateSubresource(
+                native_.resource.Get(),
+                dstSubresource,
+                &bandBox,
+                data,
+                dataLayout.rowStride,
+                dataLayout.rowStride * numRows
             );
-        }
+        };
+
+        const Extent3D extent{ dstBox.right - dstBox.left, dstBox.bottom - dstBox.top, depth * numArrayLayers };
+        ConvertImageBufferBands(
+            imageDesc,
+            extent,
+            formatAttribs.format,
+            formatAttribs.dataType,
+            stagingBuffer.get(),
+            stagingBufferSize,
+            UpdateSubresourceBand,
+            Constants::maxThreadCount
+        );
+        return;
+    }
+
+    /* Validate input data is large enough */
+    if (imageDesc.dataSize < dataLayout.dataSize)
+    {
+        LLGL_TRAP(
+            "image data size (%zu) is too small to update subresource of D3D11 texture (%u is required)",
+            imageDesc.dataSize, dataLayout.dataSize
+        );
     }
 
     /* Update subresource with specified image data */
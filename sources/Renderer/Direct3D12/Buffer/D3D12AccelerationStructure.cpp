@@ -0,0 +1,414 @@
+/*
+ * D3D12AccelerationStructure.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "D3D12AccelerationStructure.h"
+#include "D3D12Buffer.h"
+#include "../D3DX12/d3dx12.h"
+#include "../D3D12ObjectUtils.h"
+#include "../Command/D3D12CommandContext.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../DXCommon/DXTypes.h"
+#include "../../ContainerTypes.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+static D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS GetD3DBuildFlags(long flags)
+{
+    UINT d3dFlags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE;
+
+    if ((flags & AccelerationStructureFlags::AllowUpdate) != 0)
+        d3dFlags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+    if ((flags & AccelerationStructureFlags::AllowCompaction) != 0)
+        d3dFlags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
+    if ((flags & AccelerationStructureFlags::PreferFastTrace) != 0)
+        d3dFlags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
+    if ((flags & AccelerationStructureFlags::PreferFastBuild) != 0)
+        d3dFlags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_BUILD;
+
+    return static_cast<D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS>(d3dFlags);
+}
+
+static D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE GetD3DAccelerationStructureType(const AccelerationStructureType type)
+{
+    return (type == AccelerationStructureType::TopLevel ? D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL : D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL);
+}
+
+static ComPtr<ID3D12Resource> DXCreateBufferResource(
+    ID3D12Device*           device,
+    D3D12_HEAP_TYPE         heapType,
+    UINT64                  size,
+    D3D12_RESOURCE_FLAGS    flags,
+    D3D12_RESOURCE_STATES   initialState,
+    const char*             contextInfo)
+{
+    ComPtr<ID3D12Resource> resource;
+
+    auto hr = device->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(heapType),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(size, flags),
+        initialState,
+        nullptr,
+        IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfCreateFailed(hr, "ID3D12Resource", contextInfo);
+
+    return resource;
+}
+
+static D3D12_GPU_VIRTUAL_ADDRESS GetBufferGPUVirtualAddress(Buffer* buffer, std::uint64_t offset)
+{
+    if (buffer == nullptr)
+        return 0;
+    auto* bufferD3D = LLGL_CAST(D3D12Buffer*, buffer);
+    return bufferD3D->GetNative()->GetGPUVirtualAddress() + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(offset);
+}
+
+// Converts the specified triangle geometry. Buffer addresses are zero for null buffers, which is only valid for prebuild info queries.
+static void ConvertGeometry(D3D12_RAYTRACING_GEOMETRY_DESC& dst, const AccelerationStructureGeometryDescriptor& src)
+{
+    dst.Type                                    = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
+    dst.Flags                                   = (src.opaque ? D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE : D3D12_RAYTRACING_GEOMETRY_FLAG_NONE);
+
+    D3D12_RAYTRACING_GEOMETRY_TRIANGLES_DESC& triangles = dst.Triangles;
+    triangles.Transform3x4                      = 0;
+    triangles.VertexFormat                      = DXTypes::ToDXGIFormat(src.vertexFormat);
+    triangles.VertexCount                       = src.numVertices;
+    triangles.VertexBuffer.StartAddress         = GetBufferGPUVirtualAddress(src.vertexBuffer, src.vertexOffset);
+    triangles.VertexBuffer.StrideInBytes        = src.vertexStride;
+
+    if (src.indexBuffer != nullptr || src.numIndices > 0)
+    {
+        triangles.IndexFormat                   = DXTypes::ToDXGIFormat(src.indexFormat);
+        triangles.IndexCount                    = src.numIndices;
+        triangles.IndexBuffer                   = GetBufferGPUVirtualAddress(src.indexBuffer, src.indexOffset);
+    }
+    else
+    {
+        triangles.IndexFormat                   = DXGI_FORMAT_UNKNOWN;
+        triangles.IndexCount                    = 0;
+        triangles.IndexBuffer                   = 0;
+    }
+}
+
+static void ConvertInstance(D3D12_RAYTRACING_INSTANCE_DESC& dst, const AccelerationStructureInstance& src)
+{
+    auto* blasD3D = LLGL_CAST(D3D12AccelerationStructure*, src.accelerationStructure);
+    static_assert(sizeof(dst.Transform) == sizeof(src.transform), "D3D12_RAYTRACING_INSTANCE_DESC::Transform must have the same size as AccelerationStructureInstance::transform");
+    ::memcpy(dst.Transform, src.transform, sizeof(src.transform));
+    dst.InstanceID                              = (src.instanceID & 0x00FFFFFFu);
+    dst.InstanceMask                            = (src.mask & 0xFFu);
+    dst.InstanceContributionToHitGroupIndex     = 0;
+    dst.Flags                                   = static_cast<UINT>(src.flags & 0xFF); // Bits of AccelerationStructureInstanceFlags match D3D12_RAYTRACING_INSTANCE_FLAGS
+    dst.AccelerationStructure                   = blasD3D->GetGPUVirtualAddress();
+}
+
+// Transitions the vertex and index buffers of the specified geometries into the state that is required for build inputs.
+static void TransitionGeometryBuffers(D3D12CommandContext& commandContext, const ArrayView<AccelerationStructureGeometryDescriptor>& geometries, bool restoreUsageState)
+{
+    auto TransitionBuffer = [&commandContext, restoreUsageState](Buffer* buffer)
+    {
+        if (buffer != nullptr)
+        {
+            D3D12Resource& resource = LLGL_CAST(D3D12Buffer*, buffer)->GetResource();
+            commandContext.TransitionResource(resource, (restoreUsageState ? resource.usageState : D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
+        }
+    };
+
+    for (const AccelerationStructureGeometryDescriptor& geometry : geometries)
+    {
+        TransitionBuffer(geometry.vertexBuffer);
+        TransitionBuffer(geometry.indexBuffer);
+    }
+}
+
+D3D12AccelerationStructure::D3D12AccelerationStructure(ID3D12Device5* device, const AccelerationStructureDescriptor& desc) :
+    AccelerationStructure { desc.type                    },
+    buildFlags_           { GetD3DBuildFlags(desc.flags) }
+{
+    UINT64 resultDataSize   = 0;
+    UINT64 scratchDataSize  = 0;
+
+    if (desc.compactedSize > 0)
+    {
+        /* Compaction destinations are only written by CopyRaytracingAccelerationStructure and don't need a scratch buffer */
+        resultDataSize = desc.compactedSize;
+    }
+    else
+    {
+        /* Determine memory requirements with the maximum number of primitives */
+        SmallVector<D3D12_RAYTRACING_GEOMETRY_DESC, 4u> geometries;
+
+        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputs = {};
+        {
+            inputs.Type         = GetD3DAccelerationStructureType(desc.type);
+            inputs.Flags        = buildFlags_;
+            inputs.DescsLayout  = D3D12_ELEMENTS_LAYOUT_ARRAY;
+        }
+
+        if (desc.type == AccelerationStructureType::TopLevel)
+        {
+            CreateInstanceBuffer(device, desc.maxInstances);
+            inputs.NumDescs         = desc.maxInstances;
+            inputs.InstanceDescs    = instanceBuffer_.Get()->GetGPUVirtualAddress();
+        }
+        else
+        {
+            geometries.resize(desc.geometries.size());
+            for_range(i, desc.geometries.size())
+                ConvertGeometry(geometries[i], desc.geometries[i]);
+            inputs.NumDescs         = static_cast<UINT>(geometries.size());
+            inputs.pGeometryDescs   = geometries.data();
+        }
+
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO prebuildInfo = {};
+        device->GetRaytracingAccelerationStructurePrebuildInfo(&inputs, &prebuildInfo);
+
+        resultDataSize  = prebuildInfo.ResultDataMaxSizeInBytes;
+        scratchDataSize = std::max(prebuildInfo.ScratchDataSizeInBytes, prebuildInfo.UpdateScratchDataSizeInBytes);
+    }
+
+    /* Create storage and a single scratch buffer that is large enough for both builds and updates; acceleration structures never leave their initial state */
+    storage_ = D3D12Resource
+    {
+        DXCreateBufferResource(
+            device,
+            D3D12_HEAP_TYPE_DEFAULT,
+            GetAlignedSize<UINT64>(resultDataSize, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT),
+            D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+            "for acceleration structure storage"
+        ),
+        D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE
+    };
+
+    if (scratchDataSize > 0)
+    {
+        scratchBuffer_ = D3D12Resource
+        {
+            DXCreateBufferResource(
+                device,
+                D3D12_HEAP_TYPE_DEFAULT,
+                GetAlignedSize<UINT64>(scratchDataSize, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT),
+                D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+                D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                "for acceleration structure scratch buffer"
+            ),
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS
+        };
+    }
+
+    if (desc.compactedSize == 0 && (desc.flags & AccelerationStructureFlags::AllowCompaction) != 0)
+        CreateCompactedSizeBuffers(device);
+}
+
+void D3D12AccelerationStructure::SetName(const char* name)
+{
+    D3D12SetObjectName(storage_.Get(), name);
+    D3D12SetObjectNameSubscript(scratchBuffer_.Get(), name, ".Scratch");
+    D3D12SetObjectNameSubscript(instanceBuffer_.Get(), name, ".Instances");
+}
+
+std::uint64_t D3D12AccelerationStructure::GetCompactedSize()
+{
+    if (!readbackBuffer_)
+        return 0;
+
+    /* Committed resources are zero-initialized, so the size reads as 0 until the command buffer with the first build has been completed */
+    const D3D12_RANGE readRange{ 0, sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC) };
+    void* mappedData = nullptr;
+    if (FAILED(readbackBuffer_->Map(0, &readRange, &mappedData)))
+        return 0;
+
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC compactedSizeDesc;
+    ::memcpy(&compactedSizeDesc, mappedData, sizeof(compactedSizeDesc));
+
+    const D3D12_RANGE writtenRange{ 0, 0 };
+    readbackBuffer_->Unmap(0, &writtenRange);
+
+    return compactedSizeDesc.CompactedSizeInBytes;
+}
+
+void D3D12AccelerationStructure::CreateShaderResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle)
+{
+    /* Acceleration structure SRVs are created without resource, since the view is fully specified by its GPU virtual address */
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    {
+        srvDesc.Format                                      = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension                               = D3D12_SRV_DIMENSION_RAYTRACING_ACCELERATION_STRUCTURE;
+        srvDesc.Shader4ComponentMapping                     = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.RaytracingAccelerationStructure.Location    = GetGPUVirtualAddress();
+    }
+    device->CreateShaderResourceView(nullptr, &srvDesc, cpuDescHandle);
+}
+
+void D3D12AccelerationStructure::Build(D3D12CommandContext& commandContext, const AccelerationStructureBuildDescriptor& buildDesc)
+{
+    SmallVector<D3D12_RAYTRACING_GEOMETRY_DESC, 4u> geometries;
+
+    /* Updates read the previous build of the same acceleration structure */
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC d3dBuildDesc = {};
+    {
+        d3dBuildDesc.DestAccelerationStructureData      = GetGPUVirtualAddress();
+        d3dBuildDesc.Inputs.Type                        = GetD3DAccelerationStructureType(GetType());
+        d3dBuildDesc.Inputs.Flags                       = buildFlags_;
+        d3dBuildDesc.Inputs.DescsLayout                 = D3D12_ELEMENTS_LAYOUT_ARRAY;
+        d3dBuildDesc.SourceAccelerationStructureData    = 0;
+        d3dBuildDesc.ScratchAccelerationStructureData   = scratchBuffer_.Get()->GetGPUVirtualAddress();
+    }
+
+    if (buildDesc.update)
+    {
+        d3dBuildDesc.Inputs.Flags                       |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+        d3dBuildDesc.SourceAccelerationStructureData    = d3dBuildDesc.DestAccelerationStructureData;
+    }
+
+    if (GetType() == AccelerationStructureType::TopLevel)
+    {
+        WriteInstances(commandContext, buildDesc.instances);
+        d3dBuildDesc.Inputs.NumDescs        = static_cast<UINT>(buildDesc.instances.size());
+        d3dBuildDesc.Inputs.InstanceDescs   = instanceBuffer_.Get()->GetGPUVirtualAddress();
+    }
+    else
+    {
+        geometries.resize(buildDesc.geometries.size());
+        for_range(i, buildDesc.geometries.size())
+            ConvertGeometry(geometries[i], buildDesc.geometries[i]);
+        d3dBuildDesc.Inputs.NumDescs        = static_cast<UINT>(geometries.size());
+        d3dBuildDesc.Inputs.pGeometryDescs  = geometries.data();
+        TransitionGeometryBuffers(commandContext, buildDesc.geometries, false);
+    }
+
+    /* Emit the compacted size alongside the build */
+    if (compactedSizeBuffer_.Get() != nullptr)
+    {
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuildInfoDesc;
+        {
+            postbuildInfoDesc.DestBuffer    = compactedSizeBuffer_.Get()->GetGPUVirtualAddress();
+            postbuildInfoDesc.InfoType      = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+        }
+        commandContext.BuildRaytracingAccelerationStructure(d3dBuildDesc, 1, &postbuildInfoDesc);
+    }
+    else
+        commandContext.BuildRaytracingAccelerationStructure(d3dBuildDesc);
+
+    /* Subsequent builds, copies, and shaders read this acceleration structure; the next build of this acceleration structure also reuses its scratch buffer */
+    commandContext.InsertUAVBarrier(storage_);
+    commandContext.InsertUAVBarrier(scratchBuffer_);
+
+    if (GetType() == AccelerationStructureType::BottomLevel)
+        TransitionGeometryBuffers(commandContext, buildDesc.geometries, true);
+
+    if (compactedSizeBuffer_.Get() != nullptr)
+        ReadbackCompactedSize(commandContext);
+}
+
+void D3D12AccelerationStructure::Copy(D3D12CommandContext& commandContext, D3D12AccelerationStructure& source, bool compact)
+{
+    commandContext.CopyRaytracingAccelerationStructure(
+        GetGPUVirtualAddress(),
+        source.GetGPUVirtualAddress(),
+        (compact ? D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT : D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_CLONE)
+    );
+    commandContext.InsertUAVBarrier(storage_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12AccelerationStructure::CreateInstanceBuffer(ID3D12Device* device, UINT maxInstances)
+{
+    /* Instance descriptors must be in the same state as other build inputs */
+    instanceBuffer_ = D3D12Resource
+    {
+        DXCreateBufferResource(
+            device,
+            D3D12_HEAP_TYPE_DEFAULT,
+            std::max<UINT64>(1u, maxInstances) * sizeof(D3D12_RAYTRACING_INSTANCE_DESC),
+            D3D12_RESOURCE_FLAG_NONE,
+            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+            "for acceleration structure instance buffer"
+        ),
+        D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE
+    };
+}
+
+void D3D12AccelerationStructure::CreateCompactedSizeBuffers(ID3D12Device* device)
+{
+    compactedSizeBuffer_ = D3D12Resource
+    {
+        DXCreateBufferResource(
+            device,
+            D3D12_HEAP_TYPE_DEFAULT,
+            sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC),
+            D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+            "for acceleration structure postbuild info"
+        ),
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS
+    };
+    readbackBuffer_ = DXCreateBufferResource(
+        device,
+        D3D12_HEAP_TYPE_READBACK,
+        sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC),
+        D3D12_RESOURCE_FLAG_NONE,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        "for acceleration structure postbuild info readback"
+    );
+}
+
+void D3D12AccelerationStructure::WriteInstances(D3D12CommandContext& commandContext, const ArrayView<AccelerationStructureInstance>& instances)
+{
+    if (instances.empty())
+        return;
+
+    std::vector<D3D12_RAYTRACING_INSTANCE_DESC> instanceDescs;
+    instanceDescs.resize(instances.size());
+    for_range(i, instances.size())
+        ConvertInstance(instanceDescs[i], instances[i]);
+
+    commandContext.UpdateSubresource(
+        instanceBuffer_,
+        0,
+        instanceDescs.data(),
+        instanceDescs.size() * sizeof(D3D12_RAYTRACING_INSTANCE_DESC),
+        D3D12_RAYTRACING_INSTANCE_DESCS_BYTE_ALIGNMENT
+    );
+}
+
+void D3D12AccelerationStructure::ReadbackCompactedSize(D3D12CommandContext& commandContext)
+{
+    commandContext.TransitionResource(compactedSizeBuffer_, D3D12_RESOURCE_STATE_COPY_SOURCE, true);
+    {
+        commandContext.GetCommandList()->CopyBufferRegion(
+            readbackBuffer_.Get(),
+            0,
+            compactedSizeBuffer_.Get(),
+            0,
+            sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC)
+        );
+    }
+    commandContext.TransitionResource(compactedSizeBuffer_, compactedSizeBuffer_.usageState);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,92 @@
+/*
+ * D3D12AccelerationStructure.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_D3D12_ACCELERATION_STRUCTURE_H
+#define LLGL_D3D12_ACCELERATION_STRUCTURE_H
+
+
+#include <LLGL/AccelerationStructure.h>
+#include "../D3D12Resource.h"
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+class D3D12CommandContext;
+
+/*
+D3D12 ray tracing acceleration structure (see ID3D12Device5::GetRaytracingAccelerationStructurePrebuildInfo).
+The acceleration structure, its scratch buffer, and the instance buffer of top-level acceleration structures are allocated once at creation time
+with the sizes reported by the prebuild info, so builds and updates never allocate memory.
+*/
+class D3D12AccelerationStructure final : public AccelerationStructure
+{
+
+    public:
+
+        void SetName(const char* name) override;
+
+        std::uint64_t GetCompactedSize() override;
+
+    public:
+
+        D3D12AccelerationStructure(ID3D12Device5* device, const AccelerationStructureDescriptor& desc);
+
+        /*
+        Records the build or update of this acceleration structure, including the upload of its instances for top-level acceleration structures.
+        A UAV barrier is inserted after the build, so subsequent builds and shaders can read the result.
+        */
+        void Build(D3D12CommandContext& commandContext, const AccelerationStructureBuildDescriptor& buildDesc);
+
+        // Records a copy from the specified acceleration structure into this one, which is compacted if 'compact' is true.
+        void Copy(D3D12CommandContext& commandContext, D3D12AccelerationStructure& source, bool compact);
+
+        // Creates a shader resource view (SRV) of this acceleration structure. Only top-level acceleration structures can be bound to shaders.
+        void CreateShaderResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle);
+
+        // Returns the GPU virtual address of this acceleration structure, which is also used for its SRV and root descriptors.
+        inline D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const
+        {
+            return storage_.Get()->GetGPUVirtualAddress();
+        }
+
+    private:
+
+        void CreateInstanceBuffer(ID3D12Device* device, UINT maxInstances);
+        void CreateCompactedSizeBuffers(ID3D12Device* device);
+
+        // Uploads the instances into the instance buffer via the staging buffer pool of the command context.
+        void WriteInstances(D3D12CommandContext& commandContext, const ArrayView<AccelerationStructureInstance>& instances);
+
+        // Copies the compacted size that is emitted by the build into the readback buffer.
+        void ReadbackCompactedSize(D3D12CommandContext& commandContext);
+
+    private:
+
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS buildFlags_         = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_NONE;
+
+        D3D12Resource                                       storage_;
+        D3D12Resource                                       scratchBuffer_;
+        D3D12Resource                                       instanceBuffer_;
+
+        D3D12Resource                                       compactedSizeBuffer_;   // UAV buffer for the postbuild info
+        ComPtr<ID3D12Resource>                              readbackBuffer_;        // CPU readable copy of the postbuild info
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -14,7 +14,10 @@
 #include "../../BufferUtils.h"
 #include "../../../Core/Assertion.h"
 #include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 #include <stdexcept>
+#include <string.h>
 
 
 namespace LLGL
@@ -32,19 +35,49 @@ static DXGI_FORMAT GetDXFormatForBuffer(const BufferDescriptor& desc)
     return (IsStructuredBuffer(desc) ? DXGI_FORMAT_UNKNOWN : DXTypes::ToDXGIFormat(desc.format));
 }
 
-D3D12Buffer::D3D12Buffer(ID3D12Device* device, const BufferDescriptor& desc) :
-    Buffer  { desc.bindFlags             },
-    format_ { GetDXFormatForBuffer(desc) }
+D3D12Buffer::D3D12Buffer(
+    ID3D12Device*           device,
+    D3D12MemoryAllocator&   memoryAllocator,
+    const BufferDescriptor& desc,
+    D3D12_HEAP_TYPE         uploadHeapType)
+:
+    Buffer           { desc.bindFlags             },
+    memoryAllocator_ { memoryAllocator            },
+    format_          { GetDXFormatForBuffer(desc) }
 {
     /* Constant buffers must be aligned to 256 bytes */
     if ((desc.bindFlags & BindFlags::ConstantBuffer) != 0)
         alignment_ = g_cBufferAlignment;
 
+    /*
+    Upload heaps are read-only for the GPU and readback heaps can only be the destination of copy commands,
+    so host-visible placement is ignored for buffers that are used otherwise
+    */
+    if (IsReadbackBuffer(desc))
+    {
+        hostVisible_    = ((desc.bindFlags & ~BindFlags::CopyDst) == 0);
+        readback_       = hostVisible_;
+    }
+    else if (IsHostVisibleBuffer(desc))
+        hostVisible_    = ((desc.bindFlags & (BindFlags::Storage | BindFlags::StreamOutputBuffer)) == 0);
+
+    /*
+    GPU upload heaps reside in video memory that is visible to the CPU (Resizable BAR), so write-only buffers are mapped directly
+    without CPU access buffer, while the GPU can still use them like any other buffer in a default heap
+    */
+    if (uploadHeapType != D3D12_HEAP_TYPE_UPLOAD &&
+        desc.cpuAccessFlags == CPUAccessFlags::Write &&
+        (desc.miscFlags & (MiscFlags::Sparse | MiscFlags::External)) == 0)
+    {
+        hostVisible_    = true;
+        gpuUpload_      = true;
+    }
+
     /* Create native buffer resource */
     CreateGpuBuffer(device, desc);
 
-    /* Create CPU access buffer */
-    if (desc.cpuAccessFlags != 0)
+    /* Create CPU access buffer unless the native buffer is mapped directly */
+    if (desc.cpuAccessFlags != 0 && !hostVisible_)
         CreateCpuAccessBuffer(device, desc.cpuAccessFlags);
 
     /* Create sub-resource views */
@@ -56,6 +89,13 @@ D3D12Buffer::D3D12Buffer(ID3D12Device* device, const BufferDescriptor& desc) :
         CreateStreamOutputBufferView(desc);
 }
 
+D3D12Buffer::~D3D12Buffer()
+{
+    /* Release native resource before its memory region is returned to the allocator */
+    resource_.native.Reset();
+    memoryAllocator_.Free(allocation_);
+}
+
 void D3D12Buffer::SetName(const char* name)
 {
     D3D12SetObjectName(resource_.Get(), name);
@@ -78,6 +118,11 @@ BufferDescriptor D3D12Buffer::GetDesc() const
     return bufferDesc;
 }
 
+std::uint64_t D3D12Buffer::GetDeviceAddress() const
+{
+    return ((GetBindFlags() & BindFlags::DeviceAddress) != 0 ? GetNative()->GetGPUVirtualAddress() : 0);
+}
+
 void D3D12Buffer::CreateConstantBufferView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle)
 {
     CreateConstantBufferViewPrimary(
@@ -279,6 +324,15 @@ HRESULT D3D12Buffer::Map(
     void**                  mappedData,
     const CPUAccess         access)
 {
+    if (hostVisible_)
+    {
+        /* Map upload or readback heap buffer directly, since the GPU accesses the same memory */
+        mappedRange_        = range;
+        mappedCPUaccess_    = access;
+        const D3D12_RANGE nullRange{ 0, 0 };
+        return resource_.Get()->Map(0, (HasReadAccess(access) ? &range : &nullRange), mappedData);
+    }
+
     if (cpuAccessBuffer_.Get() != nullptr)
     {
         /* Store mapped state */
@@ -316,6 +370,14 @@ HRESULT D3D12Buffer::Map(
 
 void D3D12Buffer::Unmap(D3D12CommandContext& commandContext)
 {
+    if (hostVisible_)
+    {
+        /* Unmap upload or readback heap buffer without any copy */
+        const D3D12_RANGE nullRange{ 0, 0 };
+        resource_.Get()->Unmap(0, (HasWriteAccess(mappedCPUaccess_) ? &mappedRange_ : &nullRange));
+        return;
+    }
+
     if (cpuAccessBuffer_.Get() != nullptr)
     {
         if (HasWriteAccess(mappedCPUaccess_))
@@ -346,6 +408,84 @@ void D3D12Buffer::Unmap(D3D12CommandContext& commandContext)
     }
 }
 
+HRESULT D3D12Buffer::WriteHostVisible(UINT64 offset, const void* data, UINT64 dataSize)
+{
+    LLGL_ASSERT(hostVisible_);
+
+    const D3D12_RANGE nullRange{ 0, 0 };
+    void* mappedData = nullptr;
+    HRESULT hr = resource_.Get()->Map(0, &nullRange, &mappedData);
+    if (FAILED(hr))
+        return hr;
+
+    ::memcpy(static_cast<char*>(mappedData) + offset, data, static_cast<std::size_t>(dataSize));
+
+    const D3D12_RANGE writtenRange{ static_cast<SIZE_T>(offset), static_cast<SIZE_T>(offset + dataSize) };
+    resource_.Get()->Unmap(0, &writtenRange);
+
+    return S_OK;
+}
+
+HRESULT D3D12Buffer::ReadHostVisible(UINT64 offset, void* data, UINT64 dataSize)
+{
+    LLGL_ASSERT(hostVisible_);
+
+    const D3D12_RANGE readRange{ static_cast<SIZE_T>(offset), static_cast<SIZE_T>(offset + dataSize) };
+    void* mappedData = nullptr;
+    HRESULT hr = resource_.Get()->Map(0, &readRange, &mappedData);
+    if (FAILED(hr))
+        return hr;
+
+    ::memcpy(data, static_cast<const char*>(mappedData) + offset, static_cast<std::size_t>(dataSize));
+
+    const D3D12_RANGE nullRange{ 0, 0 };
+    resource_.Get()->Unmap(0, &nullRange);
+
+    return S_OK;
+}
+
+void D3D12Buffer::CreateTileMapper(D3D12TileHeapPool& tileHeapPool)
+{
+    LLGL_ASSERT(tileMapper_ == nullptr);
+    tileMapper_ = MakeUnique<D3D12TileMapper>(tileHeapPool, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS);
+}
+
+void D3D12Buffer::UpdateTileMappings(ID3D12CommandQueue* commandQueue, std::uint32_t numMappings, const BufferTileMapping* mappings)
+{
+    if (tileMapper_ == nullptr)
+        return;
+
+    const UINT64 tileSize = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    const UINT64 numTiles = (GetInternalBufferSize() + tileSize - 1) / tileSize;
+
+    for_range(i, numMappings)
+    {
+        /* Round range outwards for resident mappings and inwards otherwise, except at the end of the buffer */
+        const BufferTileMapping& mapping = mappings[i];
+        const UINT64 end = std::min(mapping.offset + mapping.size, GetBufferSize());
+
+        UINT64 beginTile = 0, endTile = 0;
+        if (mapping.resident)
+        {
+            beginTile   = mapping.offset / tileSize;
+            endTile     = (end + tileSize - 1) / tileSize;
+        }
+        else
+        {
+            beginTile   = (mapping.offset + tileSize - 1) / tileSize;
+            endTile     = (end == GetBufferSize() ? numTiles : end / tileSize);
+        }
+
+        for (UINT64 tile = beginTile; tile < std::min(endTile, numTiles); ++tile)
+        {
+            const D3D12_TILED_RESOURCE_COORDINATE coord{ static_cast<UINT>(tile), 0, 0, 0 };
+            tileMapper_->SetTileResident(coord, tile, mapping.resident);
+        }
+    }
+
+    tileMapper_->Flush(commandQueue, GetNative());
+}
+
 
 /*
  * ======= Protected: =======
@@ -399,16 +539,64 @@ void D3D12Buffer::CreateGpuBuffer(ID3D12Device* device, const BufferDescriptor&
     resource_.usageState        = GetD3DUsageState(desc.bindFlags);
     resource_.transitionState   = D3D12_RESOURCE_STATE_COPY_DEST;
 
-    /* Create generic buffer resource */
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize(), GetD3DResourceFlags(desc)),
-        resource_.transitionState,
-        nullptr,
-        IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
-    );
-    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 hardware buffer");
+    if ((desc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        /* Create reserved buffer resource without memory; tiles are mapped with UpdateTileMappings */
+        auto hr = device->CreateReservedResource(
+            &CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize(), GetD3DResourceFlags(desc)),
+            resource_.transitionState,
+            nullptr,
+            IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 reserved buffer");
+    }
+    #ifdef LLGL_D3D12_ENABLE_GPU_UPLOAD_HEAP
+    else if (gpuUpload_)
+    {
+        /* Create buffer resource in GPU upload heap, which supports the same resource states as a default heap */
+        resource_.transitionState = D3D12_RESOURCE_STATE_COMMON;
+        auto hr = memoryAllocator_.CreateResource(
+            D3D12_HEAP_TYPE_GPU_UPLOAD,
+            CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize(), GetD3DResourceFlags(desc)),
+            resource_.transitionState,
+            nullptr,
+            resource_.native.ReleaseAndGetAddressOf(),
+            allocation_
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 GPU upload buffer");
+    }
+    #endif
+    else if (hostVisible_)
+    {
+        /*
+        Create buffer resource in upload or readback heap, which must remain in the generic read or copy destination state respectively,
+        for its entire lifetime
+        */
+        resource_.SetInitialState(readback_ ? D3D12_RESOURCE_STATE_COPY_DEST : D3D12_RESOURCE_STATE_GENERIC_READ);
+        auto hr = memoryAllocator_.CreateResource(
+            (readback_ ? D3D12_HEAP_TYPE_READBACK : D3D12_HEAP_TYPE_UPLOAD),
+            CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize(), GetD3DResourceFlags(desc)),
+            resource_.transitionState,
+            nullptr,
+            resource_.native.ReleaseAndGetAddressOf(),
+            allocation_
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 host-visible buffer");
+    }
+    else
+    {
+        /* Create generic buffer resource as placed resource in a pooled heap, or as shared committed resource for external buffers */
+        auto hr = memoryAllocator_.CreateResource(
+            D3D12_HEAP_TYPE_DEFAULT,
+            CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize(), GetD3DResourceFlags(desc)),
+            resource_.transitionState,
+            nullptr,
+            resource_.native.ReleaseAndGetAddressOf(),
+            allocation_,
+            ((desc.miscFlags & MiscFlags::External) != 0)
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 hardware buffer");
+    }
 }
 
 void D3D12Buffer::CreateCpuAccessBuffer(ID3D12Device* device, long cpuAccessFlags)
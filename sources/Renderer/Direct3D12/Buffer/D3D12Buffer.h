@@ -12,8 +12,11 @@
 #include <LLGL/Buffer.h>
 #include <LLGL/RenderSystemFlags.h>
 #include "../D3D12Resource.h"
+#include "../D3D12TileMapper.h"
+#include "../D3D12MemoryAllocator.h"
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
+#include <memory>
 
 
 namespace LLGL
@@ -32,9 +35,17 @@ class D3D12Buffer : public Buffer
 
         BufferDescriptor GetDesc() const override;
 
+        std::uint64_t GetDeviceAddress() const override;
+
     public:
 
-        D3D12Buffer(ID3D12Device* device, const BufferDescriptor& desc);
+        D3D12Buffer(
+            ID3D12Device*           device,
+            D3D12MemoryAllocator&   memoryAllocator,
+            const BufferDescriptor& desc,
+            D3D12_HEAP_TYPE         uploadHeapType  = D3D12_HEAP_TYPE_UPLOAD
+        );
+        ~D3D12Buffer();
 
         // Creates a resource views within the native buffer object:
         void CreateConstantBufferView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle);
@@ -70,6 +81,18 @@ class D3D12Buffer : public Buffer
         // Unmaps the buffer content from CPU memory space.
         void Unmap(D3D12CommandContext& commandContext);
 
+        // Writes the specified data directly into the heap of this host-visible buffer.
+        HRESULT WriteHostVisible(UINT64 offset, const void* data, UINT64 dataSize);
+
+        // Reads the specified data directly from the heap of this host-visible buffer.
+        HRESULT ReadHostVisible(UINT64 offset, void* data, UINT64 dataSize);
+
+        // Creates the tile mapper for this reserved buffer. This must only be called once, if this buffer was created with MiscFlags::Sparse.
+        void CreateTileMapper(D3D12TileHeapPool& tileHeapPool);
+
+        // Updates the tile mappings of this reserved buffer on the specified command queue.
+        void UpdateTileMappings(ID3D12CommandQueue* commandQueue, std::uint32_t numMappings, const BufferTileMapping* mappings);
+
         // Returns the resource wrapper.
         inline D3D12Resource& GetResource()
         {
@@ -88,6 +111,12 @@ class D3D12Buffer : public Buffer
             return resource_.native.Get();
         }
 
+        // Returns the memory allocation of the native resource. Only placed resources have a valid heap index.
+        inline const D3D12MemoryAllocation& GetAllocation() const
+        {
+            return allocation_;
+        }
+
         // Returns the size (in bytes) of the hardware buffer.
         inline UINT64 GetBufferSize() const
         {
@@ -124,6 +153,12 @@ class D3D12Buffer : public Buffer
             return alignment_;
         }
 
+        // Returns true if this buffer was created in an upload, GPU upload, or readback heap and is mapped directly, i.e. without CPU access buffer.
+        inline bool IsHostVisible() const
+        {
+            return hostVisible_;
+        }
+
         // Returns the native format of the buffer or DXGI_FORMAT_UNKNOWN; only used for storage buffers.
         inline DXGI_FORMAT GetDXFormat() const
         {
@@ -187,7 +222,9 @@ class D3D12Buffer : public Buffer
 
     private:
 
+        D3D12MemoryAllocator&           memoryAllocator_;
         D3D12Resource                   resource_;
+        D3D12MemoryAllocation           allocation_;                // Memory of the primary resource if it's a placed resource
         D3D12Resource                   cpuAccessBuffer_; // D3D12_HEAP_TYPE_UPLOAD or D3D12_HEAP_TYPE_READBACK
 
         ComPtr<ID3D12DescriptorHeap>    uavIntermediateDescHeap_;
@@ -198,6 +235,9 @@ class D3D12Buffer : public Buffer
         UINT                            alignment_                  = 1;
         UINT                            stride_                     = 1;
         DXGI_FORMAT                     format_                     = DXGI_FORMAT_UNKNOWN;
+        bool                            hostVisible_                = false;
+        bool                            readback_                   = false;
+        bool                            gpuUpload_                  = false;    // Created in D3D12_HEAP_TYPE_GPU_UPLOAD, i.e. host-visible video memory
 
         D3D12_VERTEX_BUFFER_VIEW        vertexBufferView_           = {};
         D3D12_INDEX_BUFFER_VIEW         indexBufferView_            = {};
@@ -206,6 +246,8 @@ class D3D12Buffer : public Buffer
         D3D12_RANGE                     mappedRange_                = {};
         CPUAccess                       mappedCPUaccess_            = CPUAccess::ReadOnly;
 
+        std::unique_ptr<D3D12TileMapper> tileMapper_;
+
 };
 
 
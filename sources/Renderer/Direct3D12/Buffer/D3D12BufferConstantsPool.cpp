@@ -6,13 +6,13 @@
  */
 
 #include "D3D12BufferConstantsPool.h"
-#include "D3D12StagingBufferPool.h"
 #include "../Command/D3D12CommandContext.h"
 #include "../D3DX12/d3dx12.h"
 #include "../D3D12Resource.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/CoreUtils.h"
 #include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
@@ -28,14 +28,14 @@ D3D12BufferConstantsPool& D3D12BufferConstantsPool::Get()
 void D3D12BufferConstantsPool::InitializeDevice(
     ID3D12Device*           device,
     D3D12CommandContext&    commandContext,
-    D3D12StagingBufferPool& stagingBufferPool)
+    D3D12_HEAP_TYPE         uploadHeapType)
 {
     /* Register constants */
     std::vector<std::uint64_t> data;
     {
         RegisterConstants(D3D12BufferConstants::ZeroUInt64, 0, 1, data);
     }
-    CreateImmutableBuffer(device, commandContext, stagingBufferPool, data);
+    CreateImmutableBuffer(device, commandContext, data, uploadHeapType);
 }
 
 void D3D12BufferConstantsPool::Clear()
@@ -86,8 +86,8 @@ void D3D12BufferConstantsPool::RegisterConstants(
 void D3D12BufferConstantsPool::CreateImmutableBuffer(
     ID3D12Device*               device,
     D3D12CommandContext&        commandContext,
-    D3D12StagingBufferPool&     stagingBufferPool,
-    std::vector<std::uint64_t>& data)
+    std::vector<std::uint64_t>& data,
+    D3D12_HEAP_TYPE             uploadHeapType)
 {
     /* Create native buffer resource */
     resource_.usageState        = D3D12_RESOURCE_STATE_COPY_SOURCE;
@@ -96,6 +96,36 @@ void D3D12BufferConstantsPool::CreateImmutableBuffer(
     /* Create generic buffer resource */
     const UINT64 bufferSize = data.size() * sizeof(UINT64);
 
+    #ifdef LLGL_D3D12_ENABLE_GPU_UPLOAD_HEAP
+    if (uploadHeapType == D3D12_HEAP_TYPE_GPU_UPLOAD)
+    {
+        /* Write registered constants directly into host-visible video memory, so no copy command is needed */
+        resource_.transitionState = resource_.usageState;
+
+        auto hr = device->CreateCommittedResource(
+            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_GPU_UPLOAD),
+            D3D12_HEAP_FLAG_NONE,
+            &CD3DX12_RESOURCE_DESC::Buffer(bufferSize),
+            resource_.transitionState,
+            nullptr,
+            IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 buffer constants pool");
+
+        const D3D12_RANGE nullRange{ 0, 0 };
+        void* mappedData = nullptr;
+        hr = resource_.native->Map(0, &nullRange, &mappedData);
+        DXThrowIfFailed(hr, "failed to map D3D12 buffer constants pool");
+        {
+            ::memcpy(mappedData, data.data(), static_cast<std::size_t>(bufferSize));
+        }
+        resource_.native->Unmap(0, nullptr);
+        return;
+    }
+    #else
+    (void)uploadHeapType;
+    #endif
+
     auto hr = device->CreateCommittedResource(
         &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
         D3D12_HEAP_FLAG_NONE,
@@ -106,8 +136,8 @@ void D3D12BufferConstantsPool::CreateImmutableBuffer(
     );
     DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 buffer constants pool");
 
-    /* Initialize buffer with registered constants */
-    stagingBufferPool.WriteImmediate(commandContext, resource_, 0, data.data(), bufferSize);
+    /* Initialize buffer with registered constants via staging ring buffer of the command context */
+    commandContext.UpdateSubresource(resource_, 0, data.data(), bufferSize);
     commandContext.Finish(true);
 }
 
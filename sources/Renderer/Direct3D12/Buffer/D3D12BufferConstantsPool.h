@@ -31,7 +31,6 @@ struct D3D12BufferConstantsView
 };
 
 class D3D12CommandContext;
-class D3D12StagingBufferPool;
 
 // Pool manager for special buffer constants, e.g. zero initialized buffer ange.
 class D3D12BufferConstantsPool
@@ -45,11 +44,11 @@ class D3D12BufferConstantsPool
         // Returns the instance of this singleton.
         static D3D12BufferConstantsPool& Get();
 
-        // Initializes the device object and creates the internal immutable buffer.
+        // Initializes the device object and creates the internal immutable buffer in a default heap or a GPU upload heap (see D3D12Device::GetUploadHeapType).
         void InitializeDevice(
             ID3D12Device*           device,
             D3D12CommandContext&    commandContext,
-            D3D12StagingBufferPool& stagingBufferPool
+            D3D12_HEAP_TYPE         uploadHeapType  = D3D12_HEAP_TYPE_UPLOAD
         );
 
         // Clears all internal resources of this buffer pool.
@@ -80,8 +79,8 @@ class D3D12BufferConstantsPool
         void CreateImmutableBuffer(
             ID3D12Device*               device,
             D3D12CommandContext&        commandContext,
-            D3D12StagingBufferPool&     stagingBufferPool,
-            std::vector<std::uint64_t>& data
+            std::vector<std::uint64_t>& data,
+            D3D12_HEAP_TYPE             uploadHeapType
         );
 
     private:
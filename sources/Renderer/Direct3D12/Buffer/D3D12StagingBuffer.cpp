@@ -9,7 +9,6 @@
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/CoreUtils.h"
 #include "../D3DX12/d3dx12.h"
-#include <string.h>
 
 
 namespace LLGL
@@ -76,50 +75,6 @@ bool D3D12StagingBuffer::Capacity(UINT64 dataSize) const
     return (offset_ + dataSize <= size_);
 }
 
-HRESULT D3D12StagingBuffer::Write(
-    ID3D12GraphicsCommandList*  commandList,
-    ID3D12Resource*             dstBuffer,
-    UINT64                      dstOffset,
-    const void*                 data,
-    UINT64                      dataSize)
-{
-    /* Map GPU host memory to CPU memory space CPU-memory to upload buffer */
-    char* mappedData = nullptr;
-    const D3D12_RANGE readRange{ 0, 0 };
-
-    HRESULT hr = native_->Map(0, &readRange, reinterpret_cast<void**>(&mappedData));
-    if (FAILED(hr))
-        return hr;
-
-    /* Copy input data to staging buffer */
-    ::memcpy(mappedData + offset_, data, static_cast<std::size_t>(dataSize));
-
-    /* Unmap buffer with range of written data */
-    const D3D12_RANGE writtenRange
-    {
-        static_cast<SIZE_T>(offset_),
-        static_cast<SIZE_T>(offset_ + dataSize)
-    };
-    native_->Unmap(0, &writtenRange);
-
-    /* Encode copy buffer command */
-    commandList->CopyBufferRegion(dstBuffer, dstOffset, native_.Get(), offset_, dataSize);
-
-    return S_OK;
-}
-
-HRESULT D3D12StagingBuffer::WriteAndIncrementOffset(
-    ID3D12GraphicsCommandList*  commandList,
-    ID3D12Resource*             dstBuffer,
-    UINT64                      dstOffset,
-    const void*                 data,
-    UINT64                      dataSize)
-{
-    HRESULT hr = Write(commandList, dstBuffer, dstOffset, data, dataSize);
-    offset_ += dataSize;
-    return hr;
-}
-
 
 } // /namespace LLGL
 
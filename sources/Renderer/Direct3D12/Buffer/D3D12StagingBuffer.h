@@ -18,8 +18,8 @@ namespace LLGL
 
 
 /*
-Instances of this class represent a single chunk in the staging buffer pool
-to handle dynamic buffer updates during command buffer recording.
+Instances of this class represent a single upload or readback buffer of the staging buffer pool,
+i.e. the ring buffer for dynamic buffer updates or the global readback buffer.
 */
 class D3D12StagingBuffer
 {
@@ -51,24 +51,6 @@ class D3D12StagingBuffer
         // Returns true if the remaining buffer size can fit the specified data size.
         bool Capacity(UINT64 dataSize) const;
 
-        // Writes the specified data to the native D3D upload buffer.
-        HRESULT Write(
-            ID3D12GraphicsCommandList*  commandList,
-            ID3D12Resource*             dstBuffer,
-            UINT64                      dstOffset,
-            const void*                 data,
-            UINT64                      dataSize
-        );
-
-        // Writes the specified data to the native D3D upload buffer and increments the write offset.
-        HRESULT WriteAndIncrementOffset(
-            ID3D12GraphicsCommandList*  commandList,
-            ID3D12Resource*             dstBuffer,
-            UINT64                      dstOffset,
-            const void*                 data,
-            UINT64                      dataSize
-        );
-
         // Returns the native D3D resource.
         inline ID3D12Resource* GetNative() const
         {
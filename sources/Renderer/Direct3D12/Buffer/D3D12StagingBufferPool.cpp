@@ -8,59 +8,109 @@
 #include "D3D12StagingBufferPool.h"
 #include "../Command/D3D12CommandContext.h"
 #include "../D3D12Resource.h"
+#include "../../DXCommon/DXCore.h"
 #include "../../../Core/CoreUtils.h"
 #include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
-D3D12StagingBufferPool::D3D12StagingBufferPool(ID3D12Device* device, UINT64 chunkSize) :
-    device_    { device    },
-    chunkSize_ { chunkSize }
+// Sentinel fence value for retired ring buffers that are still referenced by the current frame
+static constexpr UINT64 g_pendingFenceValue = ~0ull;
+
+D3D12StagingBufferPool::D3D12StagingBufferPool(ID3D12Device* device, UINT64 ringBufferSize) :
+    device_         { device         },
+    ringBufferSize_ { ringBufferSize },
+    initialSize_    { ringBufferSize }
 {
 }
 
-void D3D12StagingBufferPool::InitializeDevice(ID3D12Device* device, UINT64 chunkSize)
+void D3D12StagingBufferPool::InitializeDevice(ID3D12Device* device, UINT64 ringBufferSize, D3D12_HEAP_TYPE heapType, UINT trimFrames)
 {
-    device_    = device;
-    chunkSize_ = chunkSize;
+    device_         = device;
+    ringBufferSize_ = ringBufferSize;
+    initialSize_    = ringBufferSize;
+    heapType_       = heapType;
+    trimFrames_     = trimFrames;
 }
 
-void D3D12StagingBufferPool::Reset()
+void D3D12StagingBufferPool::FinishFrame(UINT64 fenceValue)
 {
-    for (auto& chunk : chunks_)
-        chunk.Reset();
-    chunkIdx_ = 0;
+    /* Only track frames that have allocated memory from the ring buffer */
+    const UINT64 frameBegin = (frames_.empty() ? tail_ : frames_.back().endPosition);
+    if (head_ != frameBegin)
+        frames_.push_back({ fenceValue, head_ });
+
+    /* Retired ring buffers can be released once the current frame has completed */
+    for (RetiredBuffer& retiredBuffer : retiredBuffers_)
+    {
+        if (retiredBuffer.fenceValue == g_pendingFenceValue)
+            retiredBuffer.fenceValue = fenceValue;
+    }
+
+    /* Shrink ring buffer if it has grown for a short burst of uploads, e.g. during level streaming, but the steady state only needs a fraction of it */
+    peakUsage_ = std::max(peakUsage_, head_ - tail_);
+    if (trimFrames_ > 0 && ++numTrimFrames_ >= trimFrames_)
+    {
+        const UINT64 capacity = ringBuffer_.GetSize();
+        if (capacity > initialSize_ && peakUsage_ * 4 <= capacity)
+            ShrinkRingBuffer(fenceValue, std::max(initialSize_, peakUsage_ * 2));
+        peakUsage_      = 0;
+        numTrimFrames_  = 0;
+    }
 }
 
-HRESULT D3D12StagingBufferPool::WriteStaged(
-    D3D12CommandContext&    commandContext,
-    D3D12Resource&          dstBuffer,
-    UINT64                  dstOffset,
-    const void*             data,
-    UINT64                  dataSize)
+UINT64 D3D12StagingBufferPool::Trim(UINT64 fenceValue)
 {
-    /* Find a chunk that fits the requested data size or allocate a new chunk */
-    while (chunkIdx_ < chunks_.size() && !chunks_[chunkIdx_].Capacity(dataSize))
-        ++chunkIdx_;
+    UINT64 releasedSize = 0;
 
-    if (chunkIdx_ == chunks_.size())
-        AllocChunk(dataSize);
+    /* Readback buffer is only used synchronously, so it can be released immediately */
+    if (globalReadbackBuffer_.GetNative() != nullptr)
+    {
+        releasedSize += globalReadbackBuffer_.GetSize();
+        globalReadbackBuffer_ = D3D12StagingBuffer{};
+    }
 
-    /* Write data to current chunk */
-    HRESULT hr;
-    commandContext.TransitionResource(dstBuffer, D3D12_RESOURCE_STATE_COPY_DEST, true);
+    /* Ring buffer is retired even at its initial size, since it is only created again on the next allocation */
+    if (ringBuffer_.GetNative() != nullptr)
     {
-        auto& chunk = chunks_[chunkIdx_];
-        hr = chunk.WriteAndIncrementOffset(commandContext.GetCommandList(), dstBuffer.Get(), dstOffset, data, dataSize);
+        releasedSize += ringBuffer_.GetSize();
+        ShrinkRingBuffer(fenceValue, initialSize_);
     }
-    commandContext.TransitionResource(dstBuffer, dstBuffer.usageState, true);
-    return hr;
+
+    peakUsage_      = 0;
+    numTrimFrames_  = 0;
+
+    return releasedSize;
+}
+
+
+void D3D12StagingBufferPool::Reclaim(UINT64 completedFenceValue)
+{
+    /* Move tail of ring buffer to the end of the latest completed frame */
+    while (!frames_.empty() && frames_.front().fenceValue <= completedFenceValue)
+    {
+        tail_ = frames_.front().endPosition;
+        frames_.pop_front();
+    }
+
+    /* Release all retired ring buffers the GPU no longer references */
+    retiredBuffers_.erase(
+        std::remove_if(
+            retiredBuffers_.begin(), retiredBuffers_.end(),
+            [completedFenceValue](const RetiredBuffer& entry) -> bool
+            {
+                return (entry.fenceValue <= completedFenceValue);
+            }
+        ),
+        retiredBuffers_.end()
+    );
 }
 
-HRESULT D3D12StagingBufferPool::WriteImmediate(
+HRESULT D3D12StagingBufferPool::WriteStaged(
     D3D12CommandContext&    commandContext,
     D3D12Resource&          dstBuffer,
     UINT64                  dstOffset,
@@ -68,14 +118,18 @@ HRESULT D3D12StagingBufferPool::WriteImmediate(
     UINT64                  dataSize,
     UINT64                  alignment)
 {
-    /* Write data to global upload buffer and copy region to destination buffer */
-    HRESULT hr;
+    /* Sub-allocate region from ring buffer and write data into persistently mapped memory */
+    const UINT64 srcOffset = AllocRegion(dataSize, alignment);
+    ::memcpy(ringMappedData_ + srcOffset, data, static_cast<std::size_t>(dataSize));
+
+    /* Copy region to destination buffer */
     commandContext.TransitionResource(dstBuffer, D3D12_RESOURCE_STATE_COPY_DEST, true);
     {
-        hr = GetUploadBufferAndGrow(dataSize, alignment).Write(commandContext.GetCommandList(), dstBuffer.Get(), dstOffset, data, dataSize);
+        commandContext.GetCommandList()->CopyBufferRegion(dstBuffer.Get(), dstOffset, ringBuffer_.GetNative(), srcOffset, dataSize);
     }
-    commandContext.TransitionResource(dstBuffer, dstBuffer.usageState, true);
-    return hr;
+    commandContext.TransitionResource(dstBuffer, dstBuffer.usageState);
+
+    return S_OK;
 }
 
 HRESULT D3D12StagingBufferPool::ReadSubresourceRegion(
@@ -119,10 +173,94 @@ HRESULT D3D12StagingBufferPool::ReadSubresourceRegion(
  * ======= Private: =======
  */
 
-void D3D12StagingBufferPool::AllocChunk(UINT64 minChunkSize)
+UINT64 D3D12StagingBufferPool::AllocRegion(UINT64 size, UINT64 alignment)
 {
-    chunks_.emplace_back(device_, std::max(chunkSize_, minChunkSize));
-    chunkIdx_ = chunks_.size() - 1;
+    UINT64 offset = 0;
+    if (!TryAllocRegion(size, alignment, offset))
+    {
+        /* Ring buffer is full with frames that are still in flight, so replace it by a larger one */
+        GrowRingBuffer(size + alignment);
+        TryAllocRegion(size, alignment, offset);
+    }
+    return offset;
+}
+
+bool D3D12StagingBufferPool::TryAllocRegion(UINT64 size, UINT64 alignment, UINT64& outOffset)
+{
+    const UINT64 capacity = ringBuffer_.GetSize();
+    if (capacity == 0)
+        return false;
+
+    /* Align current offset within ring buffer, and wrap around if the region does not fit until the end */
+    const UINT64 wrapBase   = head_ - (head_ % capacity);
+    UINT64       offset     = GetAlignedSize(head_ % capacity, alignment);
+
+    if (offset + size > capacity)
+    {
+        if (size > capacity)
+            return false;
+        offset = 0;
+        if (wrapBase + capacity + size - tail_ > capacity)
+            return false;
+        head_ = wrapBase + capacity + size;
+    }
+    else
+    {
+        if (wrapBase + offset + size - tail_ > capacity)
+            return false;
+        head_ = wrapBase + offset + size;
+    }
+
+    outOffset = offset;
+    return true;
+}
+
+void D3D12StagingBufferPool::GrowRingBuffer(UINT64 minSize)
+{
+    /* Keep previous ring buffer alive until all in-flight frames and the current frame have completed */
+    if (ringBuffer_.GetNative() != nullptr)
+    {
+        ringBufferSize_ = ringBuffer_.GetSize() * 2;
+        retiredBuffers_.push_back({ std::move(ringBuffer_), g_pendingFenceValue });
+        frames_.clear();
+    }
+
+    /*
+    Create new ring buffer and map it persistently, since upload heaps can remain mapped while the GPU reads from them.
+    With GPU upload heaps, the copy commands read from video memory instead of system memory across the PCIe bus.
+    */
+    constexpr UINT64 minAlignment = 4096ull;
+    ringBufferSize_ = std::max(ringBufferSize_, GetAlignedSize(minSize, minAlignment));
+    ringBuffer_.Create(device_, ringBufferSize_, minAlignment, heapType_);
+
+    const D3D12_RANGE readRange{ 0, 0 };
+    HRESULT hr = ringBuffer_.GetNative()->Map(0, &readRange, reinterpret_cast<void**>(&ringMappedData_));
+    DXThrowIfFailed(hr, "failed to map D3D12 staging ring buffer");
+
+    /* Start with an empty ring */
+    head_ = 0;
+    tail_ = 0;
+}
+
+void D3D12StagingBufferPool::ShrinkRingBuffer(UINT64 fenceValue, UINT64 ringBufferSize)
+{
+    /*
+    Frames in flight may still read from the current ring buffer, so retire it until the latest submission has completed.
+    If the current frame has allocated from it as well, it is retired until the current frame has completed instead.
+    */
+    if (ringBuffer_.GetNative() != nullptr)
+    {
+        const UINT64 frameBegin = (frames_.empty() ? tail_ : frames_.back().endPosition);
+        retiredBuffers_.push_back({ std::move(ringBuffer_), (head_ != frameBegin ? g_pendingFenceValue : fenceValue) });
+        ringBuffer_     = D3D12StagingBuffer{};
+        ringMappedData_ = nullptr;
+        frames_.clear();
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    /* Ring buffer is recreated with the new size on the next allocation */
+    ringBufferSize_ = ringBufferSize;
 }
 
 void D3D12StagingBufferPool::ResizeBuffer(
@@ -141,12 +279,6 @@ void D3D12StagingBufferPool::ResizeBuffer(
     }
 }
 
-D3D12StagingBuffer& D3D12StagingBufferPool::GetUploadBufferAndGrow(UINT64 size, UINT64 alignment)
-{
-    ResizeBuffer(globalUploadBuffer_, D3D12_HEAP_TYPE_UPLOAD, size, alignment);
-    return globalUploadBuffer_;
-}
-
 D3D12StagingBuffer& D3D12StagingBufferPool::GetReadbackBufferAndGrow(UINT64 size, UINT64 alignment)
 {
     ResizeBuffer(globalReadbackBuffer_, D3D12_HEAP_TYPE_READBACK, size, alignment);
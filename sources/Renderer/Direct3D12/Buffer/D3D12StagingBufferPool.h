@@ -12,6 +12,7 @@
 #include "D3D12StagingBuffer.h"
 #include <d3d12.h>
 #include <vector>
+#include <deque>
 
 
 namespace LLGL
@@ -21,31 +22,54 @@ namespace LLGL
 struct D3D12Resource;
 class D3D12CommandContext;
 
+/*
+Ring allocator for upload memory to handle dynamic buffer updates during command buffer recording.
+All allocations are sub-allocated from a single persistently mapped upload buffer and tracked per frame with fence values.
+Memory of a frame is reclaimed once its fence value has been completed. The ring buffer grows if it is full,
+and is trimmed back towards its initial size once a number of consecutive frames used only a fraction of its capacity.
+The initial size is the floor for trimming, e.g. CommandBufferDescriptor::minStagingPoolSize.
+This class is not thread-safe and must only be used by a single command context.
+*/
 class D3D12StagingBufferPool
 {
 
     public:
 
         D3D12StagingBufferPool() = default;
-        D3D12StagingBufferPool(ID3D12Device* device, UINT64 chunkSize);
+        D3D12StagingBufferPool(ID3D12Device* device, UINT64 ringBufferSize);
+
+        D3D12StagingBufferPool(const D3D12StagingBufferPool&) = delete;
+        D3D12StagingBufferPool& operator = (const D3D12StagingBufferPool&) = delete;
+
+        /*
+        Initializes the device object, initial size, and heap type of the ring buffer. The ring buffer is created on first use.
+        The heap type must be either D3D12_HEAP_TYPE_UPLOAD or D3D12_HEAP_TYPE_GPU_UPLOAD (see D3D12Device::GetUploadHeapType).
+        If 'trimFrames' is zero, the ring buffer is only trimmed by explicit calls to Trim().
+        */
+        void InitializeDevice(
+            ID3D12Device*   device,
+            UINT64          ringBufferSize,
+            D3D12_HEAP_TYPE heapType        = D3D12_HEAP_TYPE_UPLOAD,
+            UINT            trimFrames      = 120
+        );
 
-        // Initializes the device object and chunk size.
-        void InitializeDevice(ID3D12Device* device, UINT64 chunkSize);
+        /*
+        Associates all allocations since the last call with the specified fence value the current frame will be signaled with.
+        This also trims the ring buffer if its peak usage has stayed below a quarter of its capacity for 'trimFrames' frames.
+        */
+        void FinishFrame(UINT64 fenceValue);
 
-        // Resets all chunks in the pool.
-        void Reset();
+        /*
+        Shrinks the ring buffer to its initial size and releases the readback buffer. Returns the number of bytes that are released.
+        The previous ring buffer is kept alive until the specified fence value of the latest submission has been completed.
+        */
+        UINT64 Trim(UINT64 fenceValue);
 
-        // Writes the specified data to the destination buffer using the staging pool.
-        HRESULT WriteStaged(
-            D3D12CommandContext&    commandContext,
-            D3D12Resource&          dstBuffer,
-            UINT64                  dstOffset,
-            const void*             data,
-            UINT64                  dataSize
-        );
+        // Reclaims the memory of all frames whose fence value is less than or equal to the specified completed fence value.
+        void Reclaim(UINT64 completedFenceValue);
 
-        // Writes the specified data to the destination buffer using the global upload buffer.
-        HRESULT WriteImmediate(
+        // Writes the specified data to the destination buffer using a region sub-allocated from the ring buffer.
+        HRESULT WriteStaged(
             D3D12CommandContext&    commandContext,
             D3D12Resource&          dstBuffer,
             UINT64                  dstOffset,
@@ -66,8 +90,33 @@ class D3D12StagingBufferPool
 
     private:
 
-        // Allocates a new chunk with the specified minimal size.
-        void AllocChunk(UINT64 minChunkSize);
+        // Marks the end of a frame within the ring buffer.
+        struct FrameMarker
+        {
+            UINT64 fenceValue;
+            UINT64 endPosition;
+        };
+
+        // Previous ring buffer that must be kept alive until the GPU has completed all frames that have written to it.
+        struct RetiredBuffer
+        {
+            D3D12StagingBuffer  buffer;
+            UINT64              fenceValue;
+        };
+
+    private:
+
+        // Allocates a region from the ring buffer and returns its offset. Grows the ring buffer if there is not enough free space.
+        UINT64 AllocRegion(UINT64 size, UINT64 alignment);
+
+        // Tries to allocate a region from the ring buffer without growing it.
+        bool TryAllocRegion(UINT64 size, UINT64 alignment, UINT64& outOffset);
+
+        // Replaces the ring buffer by a larger one with at least the specified size and retires the previous one.
+        void GrowRingBuffer(UINT64 minSize);
+
+        // Retires the ring buffer until the specified fence value has been completed and recreates it with the specified size on next use.
+        void ShrinkRingBuffer(UINT64 fenceValue, UINT64 ringBufferSize);
 
         // Resizes the specified staging buffer, but only grows its size.
         void ResizeBuffer(
@@ -77,18 +126,26 @@ class D3D12StagingBufferPool
             UINT64              alignment
         );
 
-        D3D12StagingBuffer& GetUploadBufferAndGrow(UINT64 size, UINT64 alignment);
         D3D12StagingBuffer& GetReadbackBufferAndGrow(UINT64 size, UINT64 alignment);
 
     private:
 
         ID3D12Device*                   device_             = nullptr;
+        D3D12_HEAP_TYPE                 heapType_           = D3D12_HEAP_TYPE_UPLOAD;
+
+        D3D12StagingBuffer              ringBuffer_;
+        char*                           ringMappedData_     = nullptr;
+        UINT64                          ringBufferSize_     = 0;
+        UINT64                          initialSize_        = 0;
+        UINT64                          head_               = 0;    // Monotonic position of the next allocation.
+        UINT64                          tail_               = 0;    // Monotonic position of the oldest allocation still in use by the GPU.
+        UINT64                          peakUsage_          = 0;    // Highest number of bytes in use since the last trim check.
+        UINT                            trimFrames_         = 120;  // Number of frames between two trim checks. Zero disables automatic trimming.
+        UINT                            numTrimFrames_      = 0;    // Number of frames since the last trim check.
 
-        std::vector<D3D12StagingBuffer> chunks_;
-        std::size_t                     chunkIdx_           = 0;
-        UINT64                          chunkSize_          = 0;
+        std::deque<FrameMarker>         frames_;
+        std::vector<RetiredBuffer>      retiredBuffers_;
 
-        D3D12StagingBuffer              globalUploadBuffer_;
         D3D12StagingBuffer              globalReadbackBuffer_;
 
 };
@@ -12,14 +12,17 @@
 #include "../D3D12RenderSystem.h"
 #include "../D3D12Types.h"
 #include "../../TextureUtils.h"
+#include "../../BufferUtils.h"
 #include "../../DXCommon/DXTypes.h"
 #include "../../CheckedCast.h"
+#include "../../FrameCounters.h"
 #include "../../../Core/CoreUtils.h"
 #include "../../../Core/CompilerExtensions.h"
 
 #include "../Buffer/D3D12Buffer.h"
 #include "../Buffer/D3D12BufferArray.h"
 #include "../Buffer/D3D12BufferConstantsPool.h"
+#include "../Buffer/D3D12AccelerationStructure.h"
 
 #include "../Texture/D3D12Texture.h"
 #include "../Texture/D3D12RenderTarget.h"
@@ -51,23 +54,38 @@ D3D12CommandBuffer::D3D12CommandBuffer(D3D12RenderSystem& renderSystem, const Co
     immediateSubmit_     { ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0) }
 {
     CreateCommandContext(renderSystem, desc);
+
+    /* Bundles can't write breadcrumbs, since their markers would be indistinguishable between multiple executions */
+    if (renderSystem.HasBreadcrumbs() && (desc.flags & CommandBufferFlags::Secondary) == 0)
+        CreateBreadcrumbBuffer(renderSystem.GetDXDevice());
 }
 
 void D3D12CommandBuffer::SetName(const char* name)
 {
     D3D12SetObjectName(commandList_, name);
+    breadcrumbs_.SetName(name);
 }
 
 /* ----- Encoding ----- */
 
 void D3D12CommandBuffer::Begin()
 {
+    LLGL_FRAME_COUNTER_BEGIN();
+
     /* Reset command list using the next command allocator */
     commandContext_.Reset();
+
+    if (commandList2_)
+        breadcrumbs_.Begin();
 }
 
 void D3D12CommandBuffer::End()
 {
+    /* Resolve all queries of this command buffer with a single ResolveQueryData call per query heap */
+    for (D3D12QueryHeap* queryHeap : dirtyQueryHeaps_)
+        queryHeap->FlushDirtyRange(commandList_, commandContext_.GetAllocatorFence(), commandContext_.GetNextFenceValue());
+    dirtyQueryHeaps_.clear();
+
     /* Close command context and reset intermediate states */
     commandContext_.Close();
 
@@ -82,7 +100,14 @@ void D3D12CommandBuffer::End()
 void D3D12CommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& cmdBufferD3D = LLGL_CAST(D3D12CommandBuffer&, deferredCommandBuffer);
+    commandContext_.FlushAllResourceBarriers();
     commandList_->ExecuteBundle(cmdBufferD3D.GetNative());
+    LLGL_FRAME_COUNTER_EXECUTE(cmdBufferD3D.GetFrameCounters());
+}
+
+void D3D12CommandBuffer::TrimMemory()
+{
+    commandContext_.TrimMemory();
 }
 
 /* ----- Blitting ----- */
@@ -93,6 +118,8 @@ void D3D12CommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferUpdates);
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     commandContext_.UpdateSubresource(dstBufferD3D.GetResource(), dstOffset, data, dataSize);
 }
@@ -104,6 +131,8 @@ void D3D12CommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
 
@@ -113,7 +142,7 @@ void D3D12CommandBuffer::CopyBuffer(
         commandList_->CopyBufferRegion(dstBufferD3D.GetNative(), dstOffset, srcBufferD3D.GetNative(), srcOffset, size);
     }
     commandContext_.TransitionResource(dstBufferD3D.GetResource(), dstBufferD3D.GetResource().usageState);
-    commandContext_.TransitionResource(srcBufferD3D.GetResource(), srcBufferD3D.GetResource().usageState, true);
+    commandContext_.TransitionResource(srcBufferD3D.GetResource(), srcBufferD3D.GetResource().usageState);
 }
 
 //TODO: incomplete for unaligned row strides
@@ -125,6 +154,8 @@ void D3D12CommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
 
@@ -181,7 +212,7 @@ void D3D12CommandBuffer::CopyBufferFromTexture(
         }
     }
     commandContext_.TransitionResource(dstBufferD3D.GetResource(), dstBufferD3D.GetResource().usageState);
-    commandContext_.TransitionResource(srcTextureD3D.GetResource(), srcTextureD3D.GetResource().usageState, true);
+    commandContext_.TransitionResource(srcTextureD3D.GetResource(), srcTextureD3D.GetResource().usageState);
 }
 
 void D3D12CommandBuffer::FillBuffer(
@@ -190,6 +221,8 @@ void D3D12CommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
 
     /* Copy value to 4D vector to be used with native D3D12 clear functions */
@@ -206,6 +239,38 @@ void D3D12CommandBuffer::FillBuffer(
     dstBufferD3D.ClearSubresourceUInt(commandContext_, DXGI_FORMAT_R32_UINT, sizeof(UINT), dstOffset, fillSize, valuesVec4);
 }
 
+void D3D12CommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    /* Forward patterns of a single 32-bit value to the default fill command */
+    std::uint32_t value = 0;
+    if (GetUniformFillPatternValue(pattern, patternSize, value))
+        return FillBuffer(dstBuffer, dstOffset, value, fillSize);
+
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
+    auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
+
+    /* Copy 64- or 128-bit pattern to 4D vector to be used with native D3D12 clear functions */
+    UINT valuesVec4[4] = {};
+    ::memcpy(valuesVec4, pattern, patternSize);
+
+    /* Clamp range to buffer size if whole buffer is meant to be filled */
+    if (fillSize == Constants::wholeSize)
+    {
+        dstOffset   = 0;
+        fillSize    = dstBufferD3D.GetBufferSize();
+    }
+
+    /* Clear buffer subresource with RG32UInt or RGBA32UInt format, so each element covers one instance of the pattern */
+    const DXGI_FORMAT format = (patternSize == 16 ? DXGI_FORMAT_R32G32B32A32_UINT : DXGI_FORMAT_R32G32_UINT);
+    dstBufferD3D.ClearSubresourceUInt(commandContext_, format, patternSize, dstOffset, fillSize, valuesVec4);
+}
+
 void D3D12CommandBuffer::CopyTexture(
     Texture&                dstTexture,
     const TextureLocation&  dstLocation,
@@ -213,6 +278,8 @@ void D3D12CommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
     auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
 
@@ -221,8 +288,8 @@ void D3D12CommandBuffer::CopyTexture(
 
     const D3D12_BOX srcBox = srcTextureD3D.CalcRegion(srcLocation.offset, extent);
 
-    commandContext_.TransitionResource(dstTextureD3D.GetResource(), D3D12_RESOURCE_STATE_COPY_DEST);
-    commandContext_.TransitionResource(srcTextureD3D.GetResource(), D3D12_RESOURCE_STATE_COPY_SOURCE, true);
+    commandContext_.TransitionSubresource(dstTextureD3D.GetResource(), dstLocationD3D.SubresourceIndex, D3D12_RESOURCE_STATE_COPY_DEST);
+    commandContext_.TransitionSubresource(srcTextureD3D.GetResource(), srcLocationD3D.SubresourceIndex, D3D12_RESOURCE_STATE_COPY_SOURCE, true);
     {
         commandList_->CopyTextureRegion(
             &dstLocationD3D,                            // pDst
@@ -233,8 +300,8 @@ void D3D12CommandBuffer::CopyTexture(
             &srcBox                                     // pSrcBox
         );
     }
-    commandContext_.TransitionResource(dstTextureD3D.GetResource(), dstTextureD3D.GetResource().usageState);
-    commandContext_.TransitionResource(srcTextureD3D.GetResource(), srcTextureD3D.GetResource().usageState, true);
+    commandContext_.TransitionSubresource(dstTextureD3D.GetResource(), dstLocationD3D.SubresourceIndex, dstTextureD3D.GetResource().usageState);
+    commandContext_.TransitionSubresource(srcTextureD3D.GetResource(), srcLocationD3D.SubresourceIndex, srcTextureD3D.GetResource().usageState);
 }
 
 //TODO: incomplete for unaligned row strides
@@ -246,6 +313,8 @@ void D3D12CommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
     auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
 
@@ -302,7 +371,7 @@ void D3D12CommandBuffer::CopyTextureFromBuffer(
         }
     }
     commandContext_.TransitionResource(dstTextureD3D.GetResource(), dstTextureD3D.GetResource().usageState);
-    commandContext_.TransitionResource(srcBufferD3D.GetResource(), srcBufferD3D.GetResource().usageState, true);
+    commandContext_.TransitionResource(srcBufferD3D.GetResource(), srcBufferD3D.GetResource().usageState);
 }
 
 void D3D12CommandBuffer::CopyTextureFromFramebuffer(
@@ -310,6 +379,8 @@ void D3D12CommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     if (dstRegion.extent.depth != 1 ||
         dstRegion.offset.x < 0      ||
         dstRegion.offset.y < 0      ||
@@ -346,16 +417,25 @@ void D3D12CommandBuffer::CopyTextureFromFramebuffer(
 
 void D3D12CommandBuffer::GenerateMips(Texture& texture)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
     D3D12MipGenerator::Get().GenerateMips(commandContext_, textureD3D, textureD3D.GetWholeSubresource());
 }
 
 void D3D12CommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
     D3D12MipGenerator::Get().GenerateMips(commandContext_, textureD3D, subresource);
 }
 
+void D3D12CommandBuffer::CompressTexture(Texture& /*dstTexture*/, Texture& /*srcTexture*/, const TextureSubresource& /*subresource*/)
+{
+    // dummy
+}
+
 /* ----- Viewport and Scissor ----- */
 
 // Check if D3D12_VIEWPORT and Viewport structures can be safely reinterpret-casted
@@ -455,6 +535,8 @@ static D3D12_CLEAR_FLAGS GetClearFlagsDSV(long flags)
 
 void D3D12CommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     if (rtvDescHandle_.ptr != 0)
     {
         /* Clear color buffers */
@@ -463,7 +545,7 @@ void D3D12CommandBuffer::Clear(long flags, const ClearValue& clearValue)
             auto rtvDescHandle = rtvDescHandle_;
             for_range(i, numColorBuffers_)
             {
-                commandList_->ClearRenderTargetView(rtvDescHandle, clearValue.color, 0, nullptr);
+                commandList_->ClearRenderTargetView(rtvDescHandle, clearValue.color, numRenderAreaRects_, &renderArea_);
                 rtvDescHandle.ptr += rtvDescSize_;
             }
         }
@@ -479,8 +561,8 @@ void D3D12CommandBuffer::Clear(long flags, const ClearValue& clearValue)
                 clearFlagsDSV,
                 clearValue.depth,
                 static_cast<UINT8>(clearValue.stencil & 0xFF),
-                0,
-                nullptr
+                numRenderAreaRects_,
+                &renderArea_
             );
         }
     }
@@ -488,6 +570,8 @@ void D3D12CommandBuffer::Clear(long flags, const ClearValue& clearValue)
 
 void D3D12CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     for_range(i, numAttachments)
     {
         const auto& clearOp = attachments[i];
@@ -499,7 +583,7 @@ void D3D12CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const At
             {
                 auto rtvDescHandle = rtvDescHandle_;
                 rtvDescHandle.ptr += (rtvDescSize_ * clearOp.colorAttachment);
-                commandList_->ClearRenderTargetView(rtvDescHandle, clearOp.clearValue.color, 0, nullptr);
+                commandList_->ClearRenderTargetView(rtvDescHandle, clearOp.clearValue.color, numRenderAreaRects_, &renderArea_);
             }
         }
 
@@ -513,8 +597,8 @@ void D3D12CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const At
                     clearFlagsDSV,
                     clearOp.clearValue.depth,
                     static_cast<UINT8>(clearOp.clearValue.stencil),
-                    0,
-                    nullptr
+                    numRenderAreaRects_,
+                    &renderArea_
                 );
             }
         }
@@ -525,12 +609,16 @@ void D3D12CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const At
 
 void D3D12CommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->IASetVertexBuffers(0, 1, &(bufferD3D.GetVertexBufferView()));
 }
 
 void D3D12CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferArrayD3D = LLGL_CAST(D3D12BufferArray&, bufferArray);
     commandList_->IASetVertexBuffers(
         0,
@@ -541,12 +629,16 @@ void D3D12CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->IASetIndexBuffer(&(bufferD3D.GetIndexBufferView()));
 }
 
 void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     auto indexBufferView = bufferD3D.GetIndexBufferView();
     if (indexBufferView.SizeInBytes > offset)
@@ -563,10 +655,13 @@ void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std
 
 void D3D12CommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
+    LLGL_FRAME_COUNTER_INC(resourceHeapBindings);
+
     if (boundPipelineLayout_ == nullptr || boundPipelineState_ == nullptr)
         return /*E_POINTER*/;
 
     auto& resourceHeapD3D = LLGL_CAST(D3D12ResourceHeap&, resourceHeap);
+    std::unique_lock<std::mutex> descriptorLock = resourceHeapD3D.LockDescriptors();
 
     /* Copy descriptors for specified set into shader-visible descriptor heap */
     for_range(i, 2)
@@ -596,7 +691,7 @@ void D3D12CommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32
 }
 
 /*
-Returns the virtual GPU address of the specified D3D12 resource. This function is only used for buffer resources.
+Returns the virtual GPU address of the specified D3D12 resource. This function is only used for buffer and acceleration structure resources.
 See https://learn.microsoft.com/en-us/windows/win32/api/d3d12/nf-d3d12-id3d12resource-getgpuvirtualaddress
 */
 static D3D12_GPU_VIRTUAL_ADDRESS GetD3DResourceGPUAddr(Resource& resource)
@@ -607,11 +702,18 @@ static D3D12_GPU_VIRTUAL_ADDRESS GetD3DResourceGPUAddr(Resource& resource)
         D3D12Buffer& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
         return bufferD3D.GetNative()->GetGPUVirtualAddress();
     }
+    if (resource.GetResourceType() == ResourceType::AccelerationStructure)
+    {
+        D3D12AccelerationStructure& accelStructD3D = LLGL_CAST(D3D12AccelerationStructure&, resource);
+        return accelStructD3D.GetGPUVirtualAddress();
+    }
     return 0;
 }
 
 void D3D12CommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
+    LLGL_FRAME_COUNTER_RESOURCE(resource);
+
     if (boundPipelineLayout_ == nullptr)
         return /*E_POINTER*/;
 
@@ -639,6 +741,45 @@ void D3D12CommandBuffer::SetResource(std::uint32_t descriptor, Resource& resourc
     }
 }
 
+void D3D12CommandBuffer::SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t size)
+{
+    LLGL_FRAME_COUNTER_RESOURCE(buffer);
+
+    if (boundPipelineLayout_ == nullptr)
+        return /*E_POINTER*/;
+
+    if (!(descriptor < boundPipelineLayout_->GetNumBindings()))
+        return /*E_INVALIDARG*/;
+
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+
+    const auto& rootParameterLocation = boundPipelineLayout_->GetRootParameterMap()[descriptor];
+    if (rootParameterLocation.type != D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE)
+    {
+        /* Root descriptors only take a GPU virtual address, so the range is determined by the shader */
+        const D3D12_GPU_VIRTUAL_ADDRESS gpuVirtualAddr = bufferD3D.GetNative()->GetGPUVirtualAddress() + offset;
+        if (boundPipelineState_ != nullptr && boundPipelineState_->IsGraphicsPSO())
+            commandContext_.SetGraphicsRootParameter(rootParameterLocation.index, rootParameterLocation.type, gpuVirtualAddr);
+        else
+            commandContext_.SetComputeRootParameter(rootParameterLocation.index, rootParameterLocation.type, gpuVirtualAddr);
+    }
+    else
+    {
+        /* Create descriptor for the buffer range in the staging descriptor heap */
+        const auto& descriptorLocation = boundPipelineLayout_->GetDescriptorMap()[descriptor];
+        BufferViewDescriptor bufferViewDesc;
+        {
+            bufferViewDesc.offset   = offset;
+            bufferViewDesc.size     = GetBufferRangeSize(bufferD3D.GetBufferSize(), offset, size);
+            if (descriptorLocation.type == D3D12_DESCRIPTOR_RANGE_TYPE_CBV)
+                bufferViewDesc.size = GetAlignedSize<std::uint64_t>(bufferViewDesc.size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+            else
+                bufferViewDesc.format = bufferD3D.GetDesc().format;
+        }
+        commandContext_.EmplaceBufferRangeDescriptorForStaging(bufferD3D, descriptorLocation.index, descriptorLocation.type, bufferViewDesc);
+    }
+}
+
 void D3D12CommandBuffer::ResetResourceSlots(
     const ResourceType  resourceType,
     std::uint32_t       firstSlot,
@@ -660,13 +801,20 @@ void D3D12CommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       swapBufferIndex)
 {
+    LLGL_FRAME_COUNTER_INC(renderPassSections);
+
+    auto renderPassD3D = LLGL_CAST(const D3D12RenderPass*, renderPass);
+
+    /* Attachments that are not loaded don't need to preserve their content */
+    const std::uint32_t discardMask = (renderPassD3D != nullptr ? renderPassD3D->GetDiscardMask() : 0);
+
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
     {
         /* Bind swap chain */
         boundSwapChain_     = LLGL_CAST(D3D12SwapChain*, &renderTarget);
         boundRenderTarget_  = nullptr;
 
-        BindSwapChain(*boundSwapChain_, swapBufferIndex);
+        BindSwapChain(*boundSwapChain_, swapBufferIndex, discardMask);
     }
     else
     {
@@ -674,38 +822,43 @@ void D3D12CommandBuffer::BeginRenderPass(
         boundSwapChain_     = nullptr;
         boundRenderTarget_  = LLGL_CAST(D3D12RenderTarget*, &renderTarget);
 
-        BindRenderTarget(*boundRenderTarget_);
+        BindRenderTarget(*boundRenderTarget_, discardMask);
     }
 
+    /* Limit clear and resolve operations to the active extent for dynamic resolution scaling */
+    const Extent2D activeExtent = renderTarget.GetActiveExtent();
+    renderArea_.right   = static_cast<LONG>(activeExtent.width);
+    renderArea_.bottom  = static_cast<LONG>(activeExtent.height);
+    numRenderAreaRects_ = (activeExtent != renderTarget.GetResolution() ? 1 : 0);
+
     /* Clear attachments */
-    if (renderPass)
-    {
-        auto renderPassD3D = LLGL_CAST(const D3D12RenderPass*, renderPass);
-        ClearAttachmentsWithRenderPass(*renderPassD3D, numClearValues, clearValues);
-    }
+    if (renderPassD3D != nullptr)
+        ClearAttachmentsWithRenderPass(*renderPassD3D, numClearValues, clearValues, numRenderAreaRects_, &renderArea_);
 }
 
 void D3D12CommandBuffer::EndRenderPass()
 {
     /* Resolve multi-sampled subresources of previously bound render target */
+    const D3D12_RECT* resolveRect = (numRenderAreaRects_ > 0 ? &renderArea_ : nullptr);
     if (boundSwapChain_ != nullptr)
-        boundSwapChain_->ResolveSubresources(commandContext_, currentColorBuffer_);
+        boundSwapChain_->ResolveSubresources(commandContext_, currentColorBuffer_, resolveRect);
     else if (boundRenderTarget_ != nullptr)
-        boundRenderTarget_->ResolveSubresources(commandContext_);
+        boundRenderTarget_->ResolveSubresources(commandContext_, resolveRect);
 }
 
 /* ----- Pipeline States ----- */
 
 void D3D12CommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    /* Bind pipeline state to command context */
-    auto& pipelineStateD3D = LLGL_CAST(D3D12PipelineState&, pipelineState);
+    /* Bind pipeline state to command context or its fallback while it is still being compiled in the background */
+    auto& pipelineStateD3D = LLGL_CAST(D3D12PipelineState&, pipelineState).GetReadyOrFallback();
     if (pipelineStateD3D.IsGraphicsPSO())
     {
         /* Bind graphics PSO */
-        auto& graphicsPSO = LLGL_CAST(D3D12GraphicsPSO&, pipelineState);
+        auto& graphicsPSO = LLGL_CAST(D3D12GraphicsPSO&, pipelineStateD3D);
         graphicsPSO.Bind(commandContext_);
         boundPipelineState_ = &graphicsPSO;
+        LLGL_FRAME_COUNTER_INC(graphicsPipelineBindings);
 
         /* Scissor rectangle must be updated (if scissor test is disabled) */
         scissorEnabled_ = graphicsPSO.IsScissorEnabled();
@@ -715,9 +868,10 @@ void D3D12CommandBuffer::SetPipelineState(PipelineState& pipelineState)
     else
     {
         /* Bind compute PSO */
-        auto& computePSO = LLGL_CAST(D3D12ComputePSO&, pipelineState);
+        auto& computePSO = LLGL_CAST(D3D12ComputePSO&, pipelineStateD3D);
         computePSO.Bind(commandContext_);
         boundPipelineState_ = &computePSO;
+        LLGL_FRAME_COUNTER_INC(computePipelineBindings);
     }
 
     /* Keep reference to pipeline layout */
@@ -781,6 +935,8 @@ void D3D12CommandBuffer::SetUniforms(std::uint32_t first, const void* data, std:
 
 void D3D12CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_FRAME_COUNTER_INC(querySections);
+
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
     queryHeapD3D.Begin(commandList_, query);
 }
@@ -789,6 +945,10 @@ void D3D12CommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
     queryHeapD3D.End(commandList_, query);
+
+    /* Remember query heap to resolve all of its queries in one batch at the end of this command buffer */
+    if (std::find(dirtyQueryHeaps_.begin(), dirtyQueryHeaps_.end(), &queryHeapD3D) == dirtyQueryHeaps_.end())
+        dirtyQueryHeaps_.push_back(&queryHeapD3D);
 }
 
 static D3D12_PREDICATION_OP GetDXPredicateOp(const RenderConditionMode mode)
@@ -801,11 +961,13 @@ static D3D12_PREDICATION_OP GetDXPredicateOp(const RenderConditionMode mode)
 
 void D3D12CommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_FRAME_COUNTER_INC(renderConditionSections);
+
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
 
     /* Flush query result data if it was marked as dirty */
     if (queryHeapD3D.InsideDirtyRange(query, 1))
-        queryHeapD3D.FlushDirtyRange(commandList_);
+        queryHeapD3D.FlushDirtyRange(commandList_, commandContext_.GetAllocatorFence(), commandContext_.GetNextFenceValue());
 
     /* Set specified query as predicate */
     commandList_->SetPredication(
@@ -824,6 +986,8 @@ void D3D12CommandBuffer::EndRenderCondition()
 
 void D3D12CommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
+    LLGL_FRAME_COUNTER_INC(streamOutputSections);
+
     D3D12_STREAM_OUTPUT_BUFFER_VIEW soBufferViews[LLGL_MAX_NUM_SO_BUFFERS];
     D3D12Buffer* buffersD3D[LLGL_MAX_NUM_SO_BUFFERS];
 
@@ -872,53 +1036,94 @@ void D3D12CommandBuffer::EndStreamOutput()
 
 void D3D12CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     commandContext_.DrawInstanced(numVertices, 1, firstVertex, 0);
+
+    MarkBreadcrumb("Draw");
 }
 
 void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     commandContext_.DrawIndexedInstanced(numIndices, 1, firstIndex, 0, 0);
+
+    MarkBreadcrumb("DrawIndexed");
 }
 
 void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     commandContext_.DrawIndexedInstanced(numIndices, 1, firstIndex, vertexOffset, 0);
+
+    MarkBreadcrumb("DrawIndexed");
 }
 
 void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     commandContext_.DrawInstanced(numVertices, numInstances, firstVertex, 0);
+
+    MarkBreadcrumb("DrawInstanced");
 }
 
 void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     commandContext_.DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
+
+    MarkBreadcrumb("DrawInstanced");
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     commandContext_.DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+
+    MarkBreadcrumb("DrawIndexedInstanced");
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     commandContext_.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
+
+    MarkBreadcrumb("DrawIndexedInstanced");
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     commandContext_.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+
+    MarkBreadcrumb("DrawIndexedInstanced");
 }
 
 void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    TransitionIndirectBuffer(bufferD3D);
     commandContext_.DrawIndirect(cmdSignatureFactory_->GetSignatureDrawIndirect(), 1, bufferD3D.GetNative(), offset);
+    RestoreIndirectBuffer(bufferD3D);
+
+    MarkBreadcrumb("DrawIndirect");
 }
 
 void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    TransitionIndirectBuffer(bufferD3D);
     if likely(stride == sizeof(D3D12_DRAW_ARGUMENTS))
     {
         /* Encode indirect draw with pre-defined command stride */
@@ -933,19 +1138,31 @@ void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std:
             offset += stride;
         }
     }
+    RestoreIndirectBuffer(bufferD3D);
+
+    MarkBreadcrumb("DrawIndirect");
 }
 
 void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    TransitionIndirectBuffer(bufferD3D);
     commandContext_.DrawIndirect(
         cmdSignatureFactory_->GetSignatureDrawIndexedIndirect(), 1, bufferD3D.GetNative(), offset
     );
+    RestoreIndirectBuffer(bufferD3D);
+
+    MarkBreadcrumb("DrawIndexedIndirect");
 }
 
 void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    TransitionIndirectBuffer(bufferD3D);
     if likely(stride == sizeof(D3D12_DRAW_INDEXED_ARGUMENTS))
     {
         /* Encode indirect draw with pre-defined command stride */
@@ -960,19 +1177,163 @@ void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offse
             offset += stride;
         }
     }
+    RestoreIndirectBuffer(bufferD3D);
+
+    MarkBreadcrumb("DrawIndexedIndirect");
+}
+
+void D3D12CommandBuffer::DrawIndirectCount(
+    Buffer&         argsBuffer,
+    std::uint64_t   argsOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    std::uint32_t   maxNumCommands,
+    std::uint32_t   stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    auto& argsBufferD3D     = LLGL_CAST(D3D12Buffer&, argsBuffer);
+    auto& countBufferD3D    = LLGL_CAST(D3D12Buffer&, countBuffer);
+    TransitionIndirectBuffer(argsBufferD3D);
+    TransitionIndirectBuffer(countBufferD3D);
+    commandContext_.DrawIndirect(
+        cmdSignatureFactory_->GetSignatureWithStride(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW, stride),
+        maxNumCommands,
+        argsBufferD3D.GetNative(),
+        argsOffset,
+        countBufferD3D.GetNative(),
+        countOffset
+    );
+    RestoreIndirectBuffer(argsBufferD3D);
+    RestoreIndirectBuffer(countBufferD3D);
+
+    MarkBreadcrumb("DrawIndirectCount");
+}
+
+void D3D12CommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         argsBuffer,
+    std::uint64_t   argsOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    std::uint32_t   maxNumCommands,
+    std::uint32_t   stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    auto& argsBufferD3D     = LLGL_CAST(D3D12Buffer&, argsBuffer);
+    auto& countBufferD3D    = LLGL_CAST(D3D12Buffer&, countBuffer);
+    TransitionIndirectBuffer(argsBufferD3D);
+    TransitionIndirectBuffer(countBufferD3D);
+    commandContext_.DrawIndirect(
+        cmdSignatureFactory_->GetSignatureWithStride(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, stride),
+        maxNumCommands,
+        argsBufferD3D.GetNative(),
+        argsOffset,
+        countBufferD3D.GetNative(),
+        countOffset
+    );
+    RestoreIndirectBuffer(argsBufferD3D);
+    RestoreIndirectBuffer(countBufferD3D);
+
+    MarkBreadcrumb("DrawIndexedIndirectCount");
+}
+
+void D3D12CommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    commandContext_.DispatchMesh(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+
+    MarkBreadcrumb("DrawMeshTasks");
+}
+
+void D3D12CommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    /* Mesh dispatch signatures are always created on demand, since they are not supported by all devices; the stride is irrelevant for a single command */
+    if (numCommands <= 1)
+        stride = sizeof(D3D12_DISPATCH_MESH_ARGUMENTS);
+
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    TransitionIndirectBuffer(bufferD3D);
+    commandContext_.DrawIndirect(
+        cmdSignatureFactory_->GetSignatureWithStride(D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH, stride),
+        numCommands,
+        bufferD3D.GetNative(),
+        offset
+    );
+    RestoreIndirectBuffer(bufferD3D);
+
+    MarkBreadcrumb("DrawMeshTasksIndirect");
+}
+
+void D3D12CommandBuffer::DrawStreamOutput()
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    /*
+    D3D12 only stores the filled size (in bytes) of each stream-output buffer, but has no equivalent to DrawAuto.
+    Converting it into a vertex count would require a built-in compute shader that writes D3D12_DRAW_ARGUMENTS for ExecuteIndirect.
+    */
+    // dummy
 }
 
 /* ----- Compute ----- */
 
 void D3D12CommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     commandContext_.Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+
+    MarkBreadcrumb("Dispatch");
 }
 
 void D3D12CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    TransitionIndirectBuffer(bufferD3D);
     commandContext_.DispatchIndirect(cmdSignatureFactory_->GetSignatureDispatchIndirect(), 1, bufferD3D.GetNative(), offset);
+    RestoreIndirectBuffer(bufferD3D);
+
+    MarkBreadcrumb("DispatchIndirect");
+}
+
+void D3D12CommandBuffer::CompactIndirectArguments(
+    Buffer&         /*dstBuffer*/,
+    std::uint64_t   /*dstOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    Buffer&         /*srcBuffer*/,
+    std::uint64_t   /*srcOffset*/,
+    Buffer&         /*visibilityBuffer*/,
+    std::uint64_t   /*visibilityOffset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    // dummy
+}
+
+/* ----- Ray Tracing ----- */
+
+void D3D12CommandBuffer::BuildAccelerationStructure(AccelerationStructure& accelerationStructure, const AccelerationStructureBuildDescriptor& buildDesc)
+{
+    auto& accelStructD3D = LLGL_CAST(D3D12AccelerationStructure&, accelerationStructure);
+    accelStructD3D.Build(commandContext_, buildDesc);
+
+    MarkBreadcrumb("BuildAccelerationStructure");
+}
+
+void D3D12CommandBuffer::CopyAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure, bool compact)
+{
+    auto& dstAccelStructD3D = LLGL_CAST(D3D12AccelerationStructure&, dstAccelerationStructure);
+    auto& srcAccelStructD3D = LLGL_CAST(D3D12AccelerationStructure&, srcAccelerationStructure);
+    dstAccelStructD3D.Copy(commandContext_, srcAccelStructD3D, compact);
+
+    MarkBreadcrumb("CopyAccelerationStructure");
 }
 
 /* ----- Debugging ----- */
@@ -980,10 +1341,14 @@ void D3D12CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 void D3D12CommandBuffer::PushDebugGroup(const char* name)
 {
     PIXBeginEvent(commandList_, 0, name);
+    if (commandList2_)
+        WriteBreadcrumb(breadcrumbs_.PushDebugGroup(name));
 }
 
 void D3D12CommandBuffer::PopDebugGroup()
 {
+    if (commandList2_)
+        WriteBreadcrumb(breadcrumbs_.PopDebugGroup());
     PIXEndEvent(commandList_);
 }
 
@@ -1025,8 +1390,12 @@ static D3D12_COMMAND_LIST_TYPE GetD3DCommandListType(const CommandBufferDescript
 {
     if ((desc.flags & CommandBufferFlags::Secondary) != 0)
         return D3D12_COMMAND_LIST_TYPE_BUNDLE;
-    else
-        return D3D12_COMMAND_LIST_TYPE_DIRECT;
+    switch (desc.queueType)
+    {
+        case CommandQueueType::Compute: return D3D12_COMMAND_LIST_TYPE_COMPUTE;
+        case CommandQueueType::Copy:    return D3D12_COMMAND_LIST_TYPE_COPY;
+        default:                        return D3D12_COMMAND_LIST_TYPE_DIRECT;
+    }
 }
 
 void D3D12CommandBuffer::CreateCommandContext(D3D12RenderSystem& renderSystem, const CommandBufferDescriptor& desc)
@@ -1034,8 +1403,8 @@ void D3D12CommandBuffer::CreateCommandContext(D3D12RenderSystem& renderSystem, c
     auto& device = renderSystem.GetDevice();
 
     /* Create command context and store reference to command list */
-    auto commandQueueD3D = LLGL_CAST(D3D12CommandQueue*, renderSystem.GetCommandQueue());
-    commandContext_.Create(device, *commandQueueD3D, GetD3DCommandListType(desc), desc.numNativeBuffers, desc.minStagingPoolSize, true);
+    auto commandQueueD3D = LLGL_CAST(D3D12CommandQueue*, renderSystem.GetCommandQueue(desc.queueType));
+    commandContext_.Create(device, *commandQueueD3D, GetD3DCommandListType(desc), desc.numNativeBuffers, desc.minStagingPoolSize, desc.stagingPoolTrimFrames, true);
     commandList_ = commandContext_.GetCommandList();
 
     /* Store increment size for descriptor heaps */
@@ -1067,10 +1436,10 @@ void D3D12CommandBuffer::SetScissorRectsToDefault(UINT numScissorRects)
     }
 }
 
-void D3D12CommandBuffer::BindRenderTarget(D3D12RenderTarget& renderTargetD3D)
+void D3D12CommandBuffer::BindRenderTarget(D3D12RenderTarget& renderTargetD3D, std::uint32_t discardMask)
 {
     /* Transition resources to state ready for output merger */
-    renderTargetD3D.TransitionToOutputMerger(commandContext_);
+    renderTargetD3D.TransitionToOutputMerger(commandContext_, discardMask);
 
     /* Set current back buffer as RTV and optional DSV */
     numColorBuffers_ = renderTargetD3D.GetNumColorAttachments();
@@ -1082,19 +1451,25 @@ void D3D12CommandBuffer::BindRenderTarget(D3D12RenderTarget& renderTargetD3D)
         commandList_->OMSetRenderTargets(numColorBuffers_, &rtvDescHandle_, TRUE, &dsvDescHandle_);
     else
         commandList_->OMSetRenderTargets(numColorBuffers_, &rtvDescHandle_, TRUE, nullptr);
+
+    /* Set optional shading-rate image of this render target */
+    commandContext_.SetShadingRateImage(renderTargetD3D.GetShadingRateImage());
 }
 
-void D3D12CommandBuffer::BindSwapChain(D3D12SwapChain& swapChainD3D, std::uint32_t swapBufferIndex)
+void D3D12CommandBuffer::BindSwapChain(D3D12SwapChain& swapChainD3D, std::uint32_t swapBufferIndex, std::uint32_t discardMask)
 {
     /* Translate swap-index into actual D3D color buffer index */
     currentColorBuffer_ = swapChainD3D.TranslateSwapIndex(swapBufferIndex);
 
     /* Indicate that the back buffer will be used as render target */
-    commandContext_.TransitionResource(
-        swapChainD3D.GetCurrentColorBuffer(currentColorBuffer_),
-        D3D12_RESOURCE_STATE_RENDER_TARGET,
-        true
-    );
+    D3D12Resource& colorBuffer = swapChainD3D.GetCurrentColorBuffer(currentColorBuffer_);
+    if ((discardMask & 0x1) != 0)
+    {
+        commandContext_.TransitionResourceDiscard(colorBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        commandContext_.FlushResourceBarrieres();
+    }
+    else
+        commandContext_.TransitionResource(colorBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET, true);
 
     /* Set current back buffer as RTV and optional DSV */
     numColorBuffers_ = 1;
@@ -1106,6 +1481,9 @@ void D3D12CommandBuffer::BindSwapChain(D3D12SwapChain& swapChainD3D, std::uint32
         commandList_->OMSetRenderTargets(1, &rtvDescHandle_, FALSE, &dsvDescHandle_);
     else
         commandList_->OMSetRenderTargets(1, &rtvDescHandle_, FALSE, nullptr);
+
+    /* Swap-chains have no shading-rate image */
+    commandContext_.SetShadingRateImage(nullptr);
 }
 
 std::uint32_t D3D12CommandBuffer::ClearAttachmentsWithRenderPass(
@@ -1212,6 +1590,70 @@ void D3D12CommandBuffer::ClearDepthStencilView(
     commandList_->ClearDepthStencilView(dsvDescHandle_, clearFlags, depth, stencil, numRects, rects);
 }
 
+void D3D12CommandBuffer::CreateBreadcrumbBuffer(ID3D12Device* device)
+{
+    /* WriteBufferImmediate requires ID3D12GraphicsCommandList2 */
+    if (FAILED(commandList_->QueryInterface(IID_PPV_ARGS(commandList2_.ReleaseAndGetAddressOf()))))
+        return;
+
+    /* Create buffer for last started and last completed marker in CPU readable memory, so it can be read after device removal */
+    auto hr = device->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(sizeof(std::uint32_t) * 2),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr,
+        IID_PPV_ARGS(breadcrumbBuffer_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for GPU breadcrumbs");
+
+    /* Keep buffer mapped for the lifetime of this command buffer */
+    void* mappedData = nullptr;
+    hr = breadcrumbBuffer_->Map(0, nullptr, &mappedData);
+    DXThrowIfFailed(hr, "failed to map D3D12 breadcrumb buffer");
+
+    breadcrumbAddress_ = breadcrumbBuffer_->GetGPUVirtualAddress();
+    breadcrumbs_.Register(static_cast<const volatile std::uint32_t*>(mappedData));
+}
+
+void D3D12CommandBuffer::WriteBreadcrumb(std::uint32_t marker)
+{
+    const D3D12_WRITEBUFFERIMMEDIATE_PARAMETER params[2] =
+    {
+        { breadcrumbAddress_,                         marker },
+        { breadcrumbAddress_ + sizeof(std::uint32_t), marker },
+    };
+    const D3D12_WRITEBUFFERIMMEDIATE_MODE modes[2] =
+    {
+        D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_IN,  // Written once all previous commands have started
+        D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_OUT, // Written once all previous commands have completed
+    };
+    commandList2_->WriteBufferImmediate(2, params, modes);
+}
+
+// Returns true if the specified buffer may be written by shaders and must therefore be transitioned for indirect commands.
+static bool IsIndirectBufferTransitionRequired(const D3D12Buffer& bufferD3D)
+{
+    return (bufferD3D.GetResource().usageState != D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+}
+
+void D3D12CommandBuffer::TransitionIndirectBuffer(D3D12Buffer& bufferD3D)
+{
+    /* Shader writes into argument buffers, e.g. via UAVs from a culling compute shader, are made visible by leaving the UAV state */
+    if (IsIndirectBufferTransitionRequired(bufferD3D))
+        commandContext_.TransitionResource(bufferD3D.GetResource(), D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+}
+
+void D3D12CommandBuffer::RestoreIndirectBuffer(D3D12Buffer& bufferD3D)
+{
+    /*
+    Transition back to the usage state without flushing, so the buffer can be bound as UAV again.
+    The pending barrier cancels out with the transition of the next indirect command that reads the same buffer.
+    */
+    if (IsIndirectBufferTransitionRequired(bufferD3D))
+        commandContext_.TransitionResource(bufferD3D.GetResource(), bufferD3D.GetResource().usageState);
+}
+
 void D3D12CommandBuffer::ResetBindingStates()
 {
     numBoundScissorRects_   = 0;
@@ -10,9 +10,12 @@
 
 
 #include <LLGL/CommandBuffer.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/Container/SmallVector.h>
 #include <cstddef>
 #include "D3D12CommandContext.h"
 #include "../Buffer/D3D12StagingBufferPool.h"
+#include "../../GPUBreadcrumbs.h"
 #include "../../DXCommon/ComPtr.h"
 #include "../../DXCommon/DXCore.h"
 
@@ -34,6 +37,7 @@ class D3D12Sampler;
 class D3D12PipelineLayout;
 class D3D12PipelineState;
 class D3D12SignatureFactory;
+class D3D12QueryHeap;
 struct D3D12Resource;
 
 class D3D12CommandBuffer final : public CommandBuffer
@@ -54,6 +58,12 @@ class D3D12CommandBuffer final : public CommandBuffer
         // Executes this command buffer.
         void Execute();
 
+        // Returns the command context of this command buffer.
+        inline D3D12CommandContext& GetCommandContext()
+        {
+            return commandContext_;
+        }
+
         // Returns the native ID3D12GraphicsCommandList object.
         inline ID3D12GraphicsCommandList* GetNative() const
         {
@@ -66,14 +76,20 @@ class D3D12CommandBuffer final : public CommandBuffer
             return immediateSubmit_;
         }
 
+        // Returns the frame counters of the current encoding. See LLGL_ENABLE_FRAME_COUNTERS.
+        inline const FrameProfile& GetFrameCounters() const
+        {
+            return frameCounters_;
+        }
+
     private:
 
         void CreateCommandContext(D3D12RenderSystem& renderSystem, const CommandBufferDescriptor& desc);
 
         void SetScissorRectsToDefault(UINT numScissorRects);
 
-        void BindRenderTarget(D3D12RenderTarget& renderTargetD3D);
-        void BindSwapChain(D3D12SwapChain& swapChainD3D, std::uint32_t swapBufferIndex = Constants::currentSwapIndex);
+        void BindRenderTarget(D3D12RenderTarget& renderTargetD3D, std::uint32_t discardMask = 0);
+        void BindSwapChain(D3D12SwapChain& swapChainD3D, std::uint32_t swapBufferIndex = Constants::currentSwapIndex, std::uint32_t discardMask = 0);
 
         std::uint32_t ClearAttachmentsWithRenderPass(
             const D3D12RenderPass&  renderPassD3D,
@@ -103,6 +119,25 @@ class D3D12CommandBuffer final : public CommandBuffer
 
         void ResetBindingStates();
 
+        // Transitions the specified buffer into the indirect argument state before it is read by ExecuteIndirect.
+        void TransitionIndirectBuffer(D3D12Buffer& bufferD3D);
+
+        // Transitions the specified buffer back into its usage state after it has been read by ExecuteIndirect.
+        void RestoreIndirectBuffer(D3D12Buffer& bufferD3D);
+
+        // Creates the host-visible buffer the breadcrumb markers are written into. See RenderSystemFlags::GPUBreadcrumbs.
+        void CreateBreadcrumbBuffer(ID3D12Device* device);
+
+        // Writes the specified marker as the last started and last completed command into the breadcrumb buffer.
+        void WriteBreadcrumb(std::uint32_t marker);
+
+        // Writes a breadcrumb marker for the specified command if breadcrumbs are enabled.
+        inline void MarkBreadcrumb(const char* command)
+        {
+            if (commandList2_)
+                WriteBreadcrumb(breadcrumbs_.MarkCommand(command));
+        }
+
     private:
 
         D3D12CommandContext             commandContext_;
@@ -121,11 +156,23 @@ class D3D12CommandBuffer final : public CommandBuffer
         UINT                            numColorBuffers_        = 0;
         UINT                            currentColorBuffer_     = 0;
 
+        D3D12_RECT                      renderArea_             = {};   // Active extent of the bound render target (see RenderTarget::SetActiveExtent)
+        UINT                            numRenderAreaRects_     = 0;    // 1 if the render area is smaller than the bound render target, 0 otherwise
+
         D3D12SwapChain*                 boundSwapChain_         = nullptr;
         D3D12RenderTarget*              boundRenderTarget_      = nullptr;
         const D3D12PipelineLayout*      boundPipelineLayout_    = nullptr;
         D3D12PipelineState*             boundPipelineState_     = nullptr;
 
+        SmallVector<D3D12QueryHeap*, 4> dirtyQueryHeaps_;                   // Query heaps with queries that are resolved in End()
+
+        FrameProfile                    frameCounters_;
+
+        ComPtr<ID3D12GraphicsCommandList2>  commandList2_;                      // Only queried if breadcrumbs are enabled
+        ComPtr<ID3D12Resource>              breadcrumbBuffer_;
+        D3D12_GPU_VIRTUAL_ADDRESS           breadcrumbAddress_      = 0;
+        GPUBreadcrumbTrail                  breadcrumbs_;
+
 };
 
 
@@ -12,6 +12,7 @@
 #include "../RenderState/D3D12Fence.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/Assertion.h"
+#include "../../../Core/CoreUtils.h"
 #include <LLGL/Utils/ForRange.h>
 #include <algorithm>
 #include <limits.h>
@@ -27,6 +28,131 @@ static constexpr D3D12_DESCRIPTOR_HEAP_TYPE g_descriptorHeapTypes[] =
     D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,
 };
 
+// Combination of all read-only resource states; D3D12_RESOURCE_STATE_GENERIC_READ does not include all of them.
+static const D3D12_RESOURCE_STATES g_readOnlyResourceStates =
+(
+    D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER |
+    D3D12_RESOURCE_STATE_INDEX_BUFFER               |
+    D3D12_RESOURCE_STATE_DEPTH_READ                 |
+    D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE  |
+    D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE      |
+    D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT          |
+    D3D12_RESOURCE_STATE_COPY_SOURCE                |
+    D3D12_RESOURCE_STATE_RESOLVE_SOURCE
+);
+
+// Returns true if a transition from the old into the new state is required.
+static bool IsD3D12TransitionRequired(D3D12_RESOURCE_STATES oldState, D3D12_RESOURCE_STATES newState)
+{
+    if (oldState == newState)
+        return false;
+
+    /* Combined read-only states can be used for all of their read accesses at once, so no transition is required */
+    const bool isOldStateReadOnly = (oldState != D3D12_RESOURCE_STATE_COMMON && (oldState & ~g_readOnlyResourceStates) == 0);
+    if (isOldStateReadOnly && newState != D3D12_RESOURCE_STATE_COMMON && (oldState & newState) == newState)
+        return false;
+
+    return true;
+}
+
+// Switches the resource back to a uniform state if all subresources are in the same state.
+static void CollapseD3D12SubresourceStates(D3D12Resource& resource)
+{
+    const D3D12_RESOURCE_STATES firstState = resource.subresourceStates.front();
+    for (D3D12_RESOURCE_STATES state : resource.subresourceStates)
+    {
+        if (state != firstState)
+            return;
+    }
+    resource.transitionState = firstState;
+    resource.subresourceStates.clear();
+}
+
+#ifdef LLGL_D3D12_ENHANCED_BARRIERS
+
+// Synchronization scope, access, and texture layout that are equivalent to a legacy resource state.
+struct D3D12EnhancedBarrierState
+{
+    D3D12_BARRIER_SYNC      sync;
+    D3D12_BARRIER_ACCESS    access;
+    D3D12_BARRIER_LAYOUT    layout;
+};
+
+static D3D12EnhancedBarrierState GetD3D12EnhancedBarrierState(D3D12_RESOURCE_STATES state)
+{
+    struct StateMapping
+    {
+        D3D12_RESOURCE_STATES       state;
+        D3D12EnhancedBarrierState   enhancedState;
+    };
+
+    /* Layouts of buffer-only states are ignored, since buffers have no layouts */
+    static const StateMapping g_stateMappings[] =
+    {
+        { D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER,          { D3D12_BARRIER_SYNC_ALL_SHADING,        D3D12_BARRIER_ACCESS_VERTEX_BUFFER | D3D12_BARRIER_ACCESS_CONSTANT_BUFFER,  D3D12_BARRIER_LAYOUT_GENERIC_READ         } },
+        { D3D12_RESOURCE_STATE_INDEX_BUFFER,                        { D3D12_BARRIER_SYNC_INDEX_INPUT,        D3D12_BARRIER_ACCESS_INDEX_BUFFER,                                          D3D12_BARRIER_LAYOUT_GENERIC_READ         } },
+        { D3D12_RESOURCE_STATE_RENDER_TARGET,                       { D3D12_BARRIER_SYNC_RENDER_TARGET,      D3D12_BARRIER_ACCESS_RENDER_TARGET,                                         D3D12_BARRIER_LAYOUT_RENDER_TARGET        } },
+        { D3D12_RESOURCE_STATE_UNORDERED_ACCESS,                    { D3D12_BARRIER_SYNC_ALL_SHADING,        D3D12_BARRIER_ACCESS_UNORDERED_ACCESS,                                      D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS     } },
+        { D3D12_RESOURCE_STATE_DEPTH_WRITE,                         { D3D12_BARRIER_SYNC_DEPTH_STENCIL,      D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE,                                   D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE  } },
+        { D3D12_RESOURCE_STATE_DEPTH_READ,                          { D3D12_BARRIER_SYNC_DEPTH_STENCIL,      D3D12_BARRIER_ACCESS_DEPTH_STENCIL_READ,                                    D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ   } },
+        { D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,           { D3D12_BARRIER_SYNC_NON_PIXEL_SHADING,  D3D12_BARRIER_ACCESS_SHADER_RESOURCE,                                       D3D12_BARRIER_LAYOUT_SHADER_RESOURCE      } },
+        { D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,               { D3D12_BARRIER_SYNC_PIXEL_SHADING,      D3D12_BARRIER_ACCESS_SHADER_RESOURCE,                                       D3D12_BARRIER_LAYOUT_SHADER_RESOURCE      } },
+        { D3D12_RESOURCE_STATE_STREAM_OUT,                          { D3D12_BARRIER_SYNC_VERTEX_SHADING,     D3D12_BARRIER_ACCESS_STREAM_OUTPUT,                                         D3D12_BARRIER_LAYOUT_COMMON               } },
+        { D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,                   { D3D12_BARRIER_SYNC_EXECUTE_INDIRECT,   D3D12_BARRIER_ACCESS_INDIRECT_ARGUMENT,                                     D3D12_BARRIER_LAYOUT_GENERIC_READ         } },
+        { D3D12_RESOURCE_STATE_COPY_DEST,                           { D3D12_BARRIER_SYNC_COPY,               D3D12_BARRIER_ACCESS_COPY_DEST,                                             D3D12_BARRIER_LAYOUT_COPY_DEST            } },
+        { D3D12_RESOURCE_STATE_COPY_SOURCE,                         { D3D12_BARRIER_SYNC_COPY,               D3D12_BARRIER_ACCESS_COPY_SOURCE,                                           D3D12_BARRIER_LAYOUT_COPY_SOURCE          } },
+        { D3D12_RESOURCE_STATE_RESOLVE_DEST,                        { D3D12_BARRIER_SYNC_RESOLVE,            D3D12_BARRIER_ACCESS_RESOLVE_DEST,                                          D3D12_BARRIER_LAYOUT_RESOLVE_DEST         } },
+        { D3D12_RESOURCE_STATE_RESOLVE_SOURCE,                      { D3D12_BARRIER_SYNC_RESOLVE,            D3D12_BARRIER_ACCESS_RESOLVE_SOURCE,                                        D3D12_BARRIER_LAYOUT_RESOLVE_SOURCE       } },
+        { D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE,                 { D3D12_BARRIER_SYNC_PIXEL_SHADING,      D3D12_BARRIER_ACCESS_SHADING_RATE_SOURCE,                                   D3D12_BARRIER_LAYOUT_SHADING_RATE_SOURCE  } },
+    };
+
+    /* Common state (which equals the present state) is compatible with any access */
+    if (state == D3D12_RESOURCE_STATE_COMMON)
+        return { D3D12_BARRIER_SYNC_ALL, D3D12_BARRIER_ACCESS_COMMON, D3D12_BARRIER_LAYOUT_COMMON };
+
+    if (state == D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE)
+    {
+        return
+        {
+            (D3D12_BARRIER_SYNC_ALL_SHADING | D3D12_BARRIER_SYNC_BUILD_RAYTRACING_ACCELERATION_STRUCTURE),
+            (D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_READ | D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_WRITE),
+            D3D12_BARRIER_LAYOUT_COMMON
+        };
+    }
+
+    /* Combine synchronization scopes and accesses of all states; combined read states share a single read layout */
+    D3D12EnhancedBarrierState result = { D3D12_BARRIER_SYNC_NONE, D3D12_BARRIER_ACCESS_COMMON, D3D12_BARRIER_LAYOUT_UNDEFINED };
+    bool isLayoutAmbiguous = false;
+
+    for (const StateMapping& mapping : g_stateMappings)
+    {
+        if ((state & mapping.state) != 0)
+        {
+            result.sync     |= mapping.enhancedState.sync;
+            result.access   |= mapping.enhancedState.access;
+            if (result.layout == D3D12_BARRIER_LAYOUT_UNDEFINED)
+                result.layout = mapping.enhancedState.layout;
+            else if (result.layout != mapping.enhancedState.layout)
+                isLayoutAmbiguous = true;
+        }
+    }
+
+    if (isLayoutAmbiguous)
+        result.layout = ((state & D3D12_RESOURCE_STATE_DEPTH_READ) != 0 ? D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ : D3D12_BARRIER_LAYOUT_GENERIC_READ);
+
+    return result;
+}
+
+// Returns the range of either all subresources or the single subresource with the specified index.
+static D3D12_BARRIER_SUBRESOURCE_RANGE GetD3D12BarrierSubresourceRange(UINT subresource)
+{
+    D3D12_BARRIER_SUBRESOURCE_RANGE range = {};
+    range.IndexOrFirstMipLevel = subresource;
+    return range;
+}
+
+#endif // /LLGL_D3D12_ENHANCED_BARRIERS
+
 D3D12CommandContext::D3D12CommandContext()
 {
     ClearCache();
@@ -43,32 +169,33 @@ void D3D12CommandContext::Create(
     D3D12Device&            device,
     D3D12CommandQueue&      commandQueue,
     D3D12_COMMAND_LIST_TYPE commandListType,
-    UINT                    numAllocators,
-    UINT64                  initialStagingChunkSize,
+    UINT                    numInitialAllocators,
+    UINT64                  initialStagingBufferSize,
+    UINT                    stagingBufferTrimFrames,
     bool                    initialClose)
 {
     /* Store reference to device and command queue */
-    device_         = device.GetNative();
-    commandQueue_   = &commandQueue;
+    device_             = device.GetNative();
+    commandQueue_       = &commandQueue;
+    commandListType_    = commandListType;
 
-    /* Create fence for command allocators */
+    for_range(i, D3D12CommandContext::maxNumDescriptorHeaps)
+        sharedDescriptorHeaps_[i] = &(device.GetSharedDescriptorHeap(g_descriptorHeapTypes[i]));
+
+    /* Create fence for command allocators; submissions are signaled with values starting at 1 so the initial fence value never appears as completed */
     allocatorFence_.Create(device.GetNative());
 
-    /* Determine number of command allocators */
-    numAllocators_ = std::max(1u, std::min(numAllocators, D3D12CommandContext::maxNumAllocators));
+    /* Determine number of command allocators that are kept alive when they are idle */
+    minNumAllocators_ = std::max(1u, std::min(numInitialAllocators, D3D12CommandContext::maxNumAllocators));
 
-    /* Create command allocators and descriptor heap pools */
-    constexpr UINT64 minStagingChunkSize = (0xFF + 1);
-    initialStagingChunkSize = std::max(minStagingChunkSize, initialStagingChunkSize);
+    /* Initialize staging ring buffer that is shared across all command allocators */
+    constexpr UINT64 minStagingBufferSize = (0xFF + 1);
+    stagingBufferPool_.InitializeDevice(device.GetNative(), std::max(minStagingBufferSize, initialStagingBufferSize), device.GetUploadHeapType(), stagingBufferTrimFrames);
 
-    for_range(i, numAllocators_)
-    {
-        commandAllocators_[i] = device.CreateDXCommandAllocator(commandListType);
-        for_range(j, D3D12CommandContext::maxNumDescriptorHeaps)
-            stagingDescriptorPools_[i][j].InitializeDevice(device.GetNative(), g_descriptorHeapTypes[j]);
-        descriptorCaches_[i].Create(device.GetNative());
-        stagingBufferPools_[i].InitializeDevice(device.GetNative(), initialStagingChunkSize);
-    }
+    /* Create initial command allocators and descriptor heap pools; more are created on demand */
+    currentAllocator_ = CreateCommandAllocatorSlot();
+    while (numAllocators_ < minNumAllocators_)
+        freeAllocators_.push_back(CreateCommandAllocatorSlot());
 
     /* Create graphics command list and close it (they are created in recording mode) */
     commandList_ = device.CreateDXCommandList(commandListType, GetCommandAllocator());
@@ -76,14 +203,35 @@ void D3D12CommandContext::Create(
     if (initialClose)
         commandList_->Close();
 
+    /* Query command list interface for variable rate shading; this is not an error if the runtime does not support it */
+    commandList_->QueryInterface(IID_PPV_ARGS(commandList5_.ReleaseAndGetAddressOf()));
+
+    /* Query command list interface for mesh shaders; this is not an error if the runtime does not support it */
+    commandList_->QueryInterface(IID_PPV_ARGS(commandList6_.ReleaseAndGetAddressOf()));
+
+    #ifdef LLGL_D3D12_ENHANCED_BARRIERS
+    /*
+    Query command list interface for enhanced barriers, which requires a runtime with Agility SDK 1.7 or later.
+    Copy command lists keep legacy barriers, since they only support the common layout while resource states are tracked across all queues.
+    */
+    commandList7_.Reset();
+    if (commandListType != D3D12_COMMAND_LIST_TYPE_COPY)
+    {
+        D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12 = {};
+        auto hr = device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &options12, sizeof(options12));
+        if (SUCCEEDED(hr) && options12.EnhancedBarriersSupported)
+            commandList_->QueryInterface(IID_PPV_ARGS(commandList7_.ReleaseAndGetAddressOf()));
+    }
+    #endif
+
     /* Clear cache alongside device object initialization */
     ClearCache();
 }
 
 void D3D12CommandContext::Close()
 {
-    /* Flush pending resource barriers */
-    FlushResourceBarrieres();
+    /* Flush pending resource barriers; split barriers must not span across command lists */
+    FlushAllResourceBarriers();
 
     /* Close native command list */
     auto hr = commandList_->Close();
@@ -94,7 +242,15 @@ void D3D12CommandContext::Execute()
 {
     /* Submit command list to queue and signal current allocator fence */
     commandQueue_->ExecuteCommandList(GetCommandList());
-    commandQueue_->SignalFence(allocatorFence_.Get(), allocatorFenceValues_[currentAllocatorIndex_]);
+    SignalAllocatorFence();
+}
+
+void D3D12CommandContext::SignalAllocatorFence()
+{
+    /* Each submission gets a new fence value, so the allocator is only reused after its last submission has been completed */
+    currentAllocator_->fenceValue   = nextFenceValue_++;
+    currentAllocator_->submitted    = true;
+    commandQueue_->SignalFence(allocatorFence_.Get(), currentAllocator_->fenceValue);
 }
 
 void D3D12CommandContext::Reset()
@@ -123,6 +279,21 @@ void D3D12CommandContext::Finish(bool waitIdle)
     Reset();
 }
 
+UINT64 D3D12CommandContext::TrimMemory()
+{
+    /* Release surplus of free command allocators, e.g. after a load spike, without waiting for their idle period */
+    ReclaimCompletedAllocators();
+    while (!freeAllocators_.empty() && numAllocators_ > minNumAllocators_)
+    {
+        freeAllocators_.erase(freeAllocators_.begin());
+        --numAllocators_;
+    }
+    numIdleFrames_ = 0;
+
+    /* Retire staging memory until the latest submission has completed */
+    return stagingBufferPool_.Trim(nextFenceValue_ - 1);
+}
+
 void D3D12CommandContext::TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES newState, D3D12_RESOURCE_STATES oldState, bool flushImmediate)
 {
     auto& barrier = NextResourceBarrier();
@@ -142,25 +313,151 @@ void D3D12CommandContext::TransitionResource(ID3D12Resource* resource, D3D12_RES
 
 void D3D12CommandContext::TransitionResource(D3D12Resource& resource, D3D12_RESOURCE_STATES newState, bool flushImmediate)
 {
-    if (resource.transitionState != newState)
+    EndSplitBarrier(resource);
+
+    if (resource.HasUniformState())
+    {
+        if (IsD3D12TransitionRequired(resource.transitionState, newState))
+        {
+            AppendTransitionBarrier(resource.Get(), D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, resource.transitionState, newState);
+            resource.transitionState = newState;
+        }
+    }
+    else
+    {
+        /* Transition each subresource individually, since they are tracked in different states */
+        for_range(i, static_cast<UINT>(resource.subresourceStates.size()))
+        {
+            D3D12_RESOURCE_STATES& state = resource.subresourceStates[i];
+            if (IsD3D12TransitionRequired(state, newState))
+            {
+                AppendTransitionBarrier(resource.Get(), i, state, newState);
+                state = newState;
+            }
+        }
+        CollapseD3D12SubresourceStates(resource);
+    }
+
+    /* Flush resource barrieres if required */
+    if (flushImmediate)
+        FlushResourceBarrieres();
+}
+
+void D3D12CommandContext::TransitionResourceDiscard(D3D12Resource& resource, D3D12_RESOURCE_STATES newState)
+{
+    #ifdef LLGL_D3D12_ENHANCED_BARRIERS
+    if (commandList7_)
+    {
+        EndSplitBarrier(resource);
+
+        /* Flush previous barriers first, since the discard barrier is recorded immediately */
+        FlushResourceBarrieres();
+
+        /* Wait for all previous accesses of any subresource, but don't preserve their content */
+        D3D12_BARRIER_SYNC syncBefore = D3D12_BARRIER_SYNC_NONE;
+        if (resource.HasUniformState())
+            syncBefore = GetD3D12EnhancedBarrierState(resource.transitionState).sync;
+        else
+        {
+            for (D3D12_RESOURCE_STATES state : resource.subresourceStates)
+                syncBefore |= GetD3D12EnhancedBarrierState(state).sync;
+        }
+
+        const D3D12EnhancedBarrierState after = GetD3D12EnhancedBarrierState(newState);
+
+        D3D12_TEXTURE_BARRIER barrier;
+        {
+            barrier.SyncBefore      = syncBefore;
+            barrier.SyncAfter       = after.sync;
+            barrier.AccessBefore    = D3D12_BARRIER_ACCESS_NO_ACCESS;
+            barrier.AccessAfter     = after.access;
+            barrier.LayoutBefore    = D3D12_BARRIER_LAYOUT_UNDEFINED;
+            barrier.LayoutAfter     = after.layout;
+            barrier.pResource       = resource.Get();
+            barrier.Subresources    = GetD3D12BarrierSubresourceRange(D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+            barrier.Flags           = D3D12_TEXTURE_BARRIER_FLAG_DISCARD;
+        }
+        D3D12_BARRIER_GROUP barrierGroup;
+        {
+            barrierGroup.Type               = D3D12_BARRIER_TYPE_TEXTURE;
+            barrierGroup.NumBarriers        = 1;
+            barrierGroup.pTextureBarriers   = &barrier;
+        }
+        commandList7_->Barrier(1, &barrierGroup);
+
+        /* Store new transition state for all subresources */
+        resource.transitionState = newState;
+        resource.subresourceStates.clear();
+        return;
+    }
+    #endif // /LLGL_D3D12_ENHANCED_BARRIERS
+
+    TransitionResource(resource, newState);
+}
+
+void D3D12CommandContext::TransitionSubresource(D3D12Resource& resource, UINT subresource, D3D12_RESOURCE_STATES newState, bool flushImmediate)
+{
+    /* Fall back to transitioning the entire resource for resources without independent subresources */
+    if (subresource >= resource.numSubresources || resource.numSubresources == 1)
+    {
+        TransitionResource(resource, newState, flushImmediate);
+        return;
+    }
+
+    EndSplitBarrier(resource);
+
+    const D3D12_RESOURCE_STATES oldState = resource.GetSubresourceState(subresource);
+    if (IsD3D12TransitionRequired(oldState, newState))
+    {
+        /* Start tracking subresources individually */
+        if (resource.HasUniformState())
+            resource.subresourceStates.assign(resource.numSubresources, resource.transitionState);
+
+        AppendTransitionBarrier(resource.Get(), subresource, oldState, newState);
+        resource.subresourceStates[subresource] = newState;
+        CollapseD3D12SubresourceStates(resource);
+    }
+
+    /* Flush resource barrieres if required */
+    if (flushImmediate)
+        FlushResourceBarrieres();
+}
+
+void D3D12CommandContext::BeginSplitTransition(D3D12Resource& resource, D3D12_RESOURCE_STATES newState)
+{
+    EndSplitBarrier(resource);
+
+    /* Use a regular transition if the split barrier cannot be tracked */
+    if (!resource.HasUniformState() || numSplitBarriers_ == D3D12CommandContext::maxNumSplitBarriers)
+    {
+        TransitionResource(resource, newState);
+        return;
+    }
+
+    if (IsD3D12TransitionRequired(resource.transitionState, newState))
     {
         auto& barrier = NextResourceBarrier();
 
-        /* Initialize resource barrier for resource transition */
+        /* Initialize resource barrier for the beginning of a split transition */
         barrier.Type                    = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier.Flags                   = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barrier.Flags                   = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
         barrier.Transition.pResource    = resource.Get();
         barrier.Transition.Subresource  = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
         barrier.Transition.StateBefore  = resource.transitionState;
         barrier.Transition.StateAfter   = newState;
 
+        /* Store matching barrier to end the split transition later */
+        SplitBarrier& splitBarrier = splitBarriers_[numSplitBarriers_++];
+        {
+            splitBarrier.resource           = &resource;
+            splitBarrier.endBarrier         = barrier;
+            splitBarrier.endBarrier.Flags   = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+        }
+
         /* Store new transition state */
-        resource.transitionState = newState;
+        resource.transitionState        = newState;
+        resource.splitBarrierPending    = true;
     }
-
-    /* Flush resource barrieres if required */
-    if (flushImmediate)
-        FlushResourceBarrieres();
 }
 
 void D3D12CommandContext::InsertUAVBarrier(D3D12Resource& resource, bool flushImmediate)
@@ -179,34 +476,65 @@ void D3D12CommandContext::FlushResourceBarrieres()
 {
     if (numResourceBarriers_ > 0)
     {
+        #ifdef LLGL_D3D12_ENHANCED_BARRIERS
+        if (commandList7_)
+            FlushEnhancedBarriers();
+        else
+        #endif
         commandList_->ResourceBarrier(numResourceBarriers_, resourceBarriers_);
         numResourceBarriers_ = 0;
     }
 }
 
+void D3D12CommandContext::FlushAllResourceBarriers()
+{
+    if (numSplitBarriers_ > 0)
+        EndAllSplitBarriers();
+    FlushResourceBarrieres();
+}
+
 void D3D12CommandContext::ResolveSubresource(
-    D3D12Resource&  dstResource,
-    UINT            dstSubresource,
-    D3D12Resource&  srcResource,
-    UINT            srcSubresource,
-    DXGI_FORMAT     format)
-{
-    /* Transition both resources */
-    TransitionResource(dstResource, D3D12_RESOURCE_STATE_RESOLVE_DEST);
-    TransitionResource(srcResource, D3D12_RESOURCE_STATE_RESOLVE_SOURCE, true);
-
-    /* Resolve multi-sampled render targets */
-    commandList_->ResolveSubresource(
-        dstResource.native.Get(),
-        dstSubresource,
-        srcResource.native.Get(),
-        srcSubresource,
-        format
-    );
+    D3D12Resource&      dstResource,
+    UINT                dstSubresource,
+    D3D12Resource&      srcResource,
+    UINT                srcSubresource,
+    DXGI_FORMAT         format,
+    const D3D12_RECT*   srcRect)
+{
+    /* Transition both subresources */
+    TransitionSubresource(dstResource, dstSubresource, D3D12_RESOURCE_STATE_RESOLVE_DEST);
+    TransitionSubresource(srcResource, srcSubresource, D3D12_RESOURCE_STATE_RESOLVE_SOURCE, true);
+
+    if (srcRect != nullptr && commandList5_)
+    {
+        /* Resolve only the specified region, e.g. the active extent of a render target with dynamic resolution */
+        commandList5_->ResolveSubresourceRegion(
+            dstResource.native.Get(),
+            dstSubresource,
+            static_cast<UINT>(srcRect->left),
+            static_cast<UINT>(srcRect->top),
+            srcResource.native.Get(),
+            srcSubresource,
+            const_cast<D3D12_RECT*>(srcRect),
+            format,
+            D3D12_RESOLVE_MODE_AVERAGE
+        );
+    }
+    else
+    {
+        /* Resolve multi-sampled render targets */
+        commandList_->ResolveSubresource(
+            dstResource.native.Get(),
+            dstSubresource,
+            srcResource.native.Get(),
+            srcSubresource,
+            format
+        );
+    }
 
-    /* Transition both resources */
-    TransitionResource(dstResource, dstResource.usageState);
-    TransitionResource(srcResource, srcResource.usageState, true);
+    /* Transition both subresources back, but keep barriers pending so they can be folded with subsequent transitions */
+    TransitionSubresource(dstResource, dstSubresource, dstResource.usageState);
+    TransitionSubresource(srcResource, srcSubresource, srcResource.usageState);
 }
 
 void D3D12CommandContext::CopyTextureRegion(
@@ -219,9 +547,9 @@ void D3D12CommandContext::CopyTextureRegion(
     UINT                srcSubresource,
     const D3D12_BOX*    srcBox)
 {
-    /* Transition both resources */
-    TransitionResource(dstResource, D3D12_RESOURCE_STATE_COPY_DEST);
-    TransitionResource(srcResource, D3D12_RESOURCE_STATE_COPY_SOURCE, true);
+    /* Transition both subresources */
+    TransitionSubresource(dstResource, dstSubresource, D3D12_RESOURCE_STATE_COPY_DEST);
+    TransitionSubresource(srcResource, srcSubresource, D3D12_RESOURCE_STATE_COPY_SOURCE, true);
 
     /* Copy texture region subresources */
     D3D12_TEXTURE_COPY_LOCATION dstLocation;
@@ -238,18 +566,19 @@ void D3D12CommandContext::CopyTextureRegion(
     }
     commandList_->CopyTextureRegion(&dstLocation, dstX, dstY, dstZ, &srcLocation, srcBox);
 
-    /* Transition both resources */
-    TransitionResource(dstResource, dstResource.usageState);
-    TransitionResource(srcResource, srcResource.usageState, true);
+    /* Transition both subresources back, but keep barriers pending so they can be folded with subsequent transitions */
+    TransitionSubresource(dstResource, dstSubresource, dstResource.usageState);
+    TransitionSubresource(srcResource, srcSubresource, srcResource.usageState);
 }
 
 void D3D12CommandContext::UpdateSubresource(
     D3D12Resource&  dstResource,
     UINT64          dstOffset,
     const void*     data,
-    UINT64          dataSize)
+    UINT64          dataSize,
+    UINT64          alignment)
 {
-    stagingBufferPools_[currentAllocatorIndex_].WriteStaged(*this, dstResource, dstOffset, data, dataSize);
+    stagingBufferPool_.WriteStaged(*this, dstResource, dstOffset, data, dataSize, alignment);
 }
 
 void D3D12CommandContext::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature)
@@ -285,6 +614,36 @@ void D3D12CommandContext::SetPipelineState(ID3D12PipelineState* pipelineState)
     }
 }
 
+void D3D12CommandContext::SetShadingRate(D3D12_SHADING_RATE shadingRate, const D3D12_SHADING_RATE_COMBINER (&combiners)[2])
+{
+    if (stateCache_.shadingRate             != shadingRate  ||
+        stateCache_.shadingRateCombiners[0] != combiners[0] ||
+        stateCache_.shadingRateCombiners[1] != combiners[1])
+    {
+        if (commandList5_)
+        {
+            /* Set shading rate and combiners and cache state */
+            commandList5_->RSSetShadingRate(shadingRate, combiners);
+            stateCache_.shadingRate             = shadingRate;
+            stateCache_.shadingRateCombiners[0] = combiners[0];
+            stateCache_.shadingRateCombiners[1] = combiners[1];
+        }
+    }
+}
+
+void D3D12CommandContext::SetShadingRateImage(ID3D12Resource* shadingRateImage)
+{
+    if (stateCache_.shadingRateImage != shadingRateImage)
+    {
+        if (commandList5_)
+        {
+            /* Set shading-rate image and cache state */
+            commandList5_->RSSetShadingRateImage(shadingRateImage);
+            stateCache_.shadingRateImage = shadingRateImage;
+        }
+    }
+}
+
 static bool CompareDescriptorHeapRefs(
     UINT                            lhsNumDescriptorHeaps,
     ID3D12DescriptorHeap* const*    lhsDescriptorHeaps,
@@ -318,6 +677,16 @@ void D3D12CommandContext::SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12Desc
     }
 }
 
+void D3D12CommandContext::SetStagingDescriptorHeaps()
+{
+    ID3D12DescriptorHeap* const stagingDescriptorHeaps[2] =
+    {
+        currentAllocator_->stagingDescriptorPools[0].GetDescriptorHeap(),
+        currentAllocator_->stagingDescriptorPools[1].GetDescriptorHeap()
+    };
+    SetDescriptorHeaps(2, stagingDescriptorHeaps);
+}
+
 void D3D12CommandContext::PrepareStagingDescriptorHeaps(
     const D3D12DescriptorHeapSetLayout& layout,
     const D3D12RootParameterIndices&    indices)
@@ -326,15 +695,10 @@ void D3D12CommandContext::PrepareStagingDescriptorHeaps(
     stagingDescriptorIndices_   = indices;
 
     /* Bind shader-visible descriptor heaps */
-    ID3D12DescriptorHeap* const stagingDescriptorHeaps[2] =
-    {
-        stagingDescriptorPools_[currentAllocatorIndex_][0].GetDescriptorHeap(),
-        stagingDescriptorPools_[currentAllocatorIndex_][1].GetDescriptorHeap()
-    };
-    SetDescriptorHeaps(2, stagingDescriptorHeaps);
+    SetStagingDescriptorHeaps();
 
     /* Reset descriptor cache for dynamic descriptors */
-    descriptorCaches_[currentAllocatorIndex_].Reset(
+    currentAllocator_->descriptorCache.Reset(
         stagingDescriptorSetLayout_.numResourceViews,
         stagingDescriptorSetLayout_.numSamplers
     );
@@ -388,10 +752,10 @@ void D3D12CommandContext::SetComputeRootParameter(UINT parameterIndex, D3D12_ROO
 
 D3D12_CPU_DESCRIPTOR_HANDLE D3D12CommandContext::GetCPUDescriptorHandle(D3D12_DESCRIPTOR_HEAP_TYPE type, UINT descriptor) const
 {
-    /* Get current descriptor heap pool via allocator- and type index */
+    /* Get descriptor heap pool of current allocator via type index */
     const UINT typeIndex = static_cast<UINT>(type);
     LLGL_ASSERT(typeIndex < D3D12CommandContext::maxNumDescriptorHeaps);
-    auto& descriptorHeapPool = stagingDescriptorPools_[currentAllocatorIndex_][typeIndex];
+    auto& descriptorHeapPool = currentAllocator_->stagingDescriptorPools[typeIndex];
 
     /* Return CPU descriptor handle for the specified descriptor in the pool */
     return descriptorHeapPool.GetCpuHandleWithOffset(descriptor);
@@ -403,10 +767,10 @@ D3D12_GPU_DESCRIPTOR_HANDLE D3D12CommandContext::CopyDescriptorsForStaging(
     UINT                        firstDescriptor,
     UINT                        numDescriptors)
 {
-    /* Get current descriptor heap pool via allocator- and type index */
+    /* Get descriptor heap pool of current allocator via type index */
     const UINT typeIndex = static_cast<UINT>(type);
     LLGL_ASSERT(typeIndex < D3D12CommandContext::maxNumDescriptorHeaps);
-    auto& descriptorHeapPool = stagingDescriptorPools_[currentAllocatorIndex_][typeIndex];
+    auto& descriptorHeapPool = currentAllocator_->stagingDescriptorPools[typeIndex];
 
     /* Copy descriptors into shader-visible descriptor heap */
     return descriptorHeapPool.CopyDescriptors(srcDescHandle, firstDescriptor, numDescriptors);
@@ -417,16 +781,25 @@ void D3D12CommandContext::EmplaceDescriptorForStaging(
     UINT                        location,
     D3D12_DESCRIPTOR_RANGE_TYPE descRangeType)
 {
-    descriptorCaches_[currentAllocatorIndex_].EmplaceDescriptor(resource, location, descRangeType);
+    currentAllocator_->descriptorCache.EmplaceDescriptor(resource, location, descRangeType);
+}
+
+void D3D12CommandContext::EmplaceBufferRangeDescriptorForStaging(
+    D3D12Buffer&                bufferD3D,
+    UINT                        location,
+    D3D12_DESCRIPTOR_RANGE_TYPE descRangeType,
+    const BufferViewDescriptor& bufferViewDesc)
+{
+    currentAllocator_->descriptorCache.EmplaceBufferRangeDescriptor(bufferD3D, location, descRangeType, bufferViewDesc);
 }
 
 // private
 void D3D12CommandContext::FlushGraphicsStagingDescriptorTables()
 {
-    auto& descriptorCache = descriptorCaches_[currentAllocatorIndex_];
+    auto& descriptorCache = currentAllocator_->descriptorCache;
     if (descriptorCache.IsInvalidated())
     {
-        auto& currentPoolSet = stagingDescriptorPools_[currentAllocatorIndex_];
+        auto& currentPoolSet = currentAllocator_->stagingDescriptorPools;
         if (stagingDescriptorSetLayout_.numResourceViews > 0)
         {
             D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle = descriptorCache.FlushCbvSrvUavDescriptors(currentPoolSet[0]);
@@ -445,10 +818,10 @@ void D3D12CommandContext::FlushGraphicsStagingDescriptorTables()
 // private
 void D3D12CommandContext::FlushComputeStagingDescriptorTables()
 {
-    auto& descriptorCache = descriptorCaches_[currentAllocatorIndex_];
+    auto& descriptorCache = currentAllocator_->descriptorCache;
     if (descriptorCache.IsInvalidated())
     {
-        auto& currentPoolSet = stagingDescriptorPools_[currentAllocatorIndex_];
+        auto& currentPoolSet = currentAllocator_->stagingDescriptorPools;
         if (stagingDescriptorSetLayout_.numResourceViews > 0)
         {
             D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle = descriptorCache.FlushCbvSrvUavDescriptors(currentPoolSet[0]);
@@ -470,6 +843,7 @@ void D3D12CommandContext::DrawInstanced(
     UINT startVertexLocation,
     UINT startInstanceLocation)
 {
+    FlushAllResourceBarriers();
     FlushGraphicsStagingDescriptorTables();
     commandList_->DrawInstanced(vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation);
 }
@@ -481,6 +855,7 @@ void D3D12CommandContext::DrawIndexedInstanced(
     INT     baseVertexLocation,
     UINT    startInstanceLocation)
 {
+    FlushAllResourceBarriers();
     FlushGraphicsStagingDescriptorTables();
     commandList_->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
 }
@@ -493,15 +868,30 @@ void D3D12CommandContext::DrawIndirect(
     ID3D12Resource*         countBuffer,
     UINT64                  countBufferOffset)
 {
+    FlushAllResourceBarriers();
     FlushGraphicsStagingDescriptorTables();
     commandList_->ExecuteIndirect(commandSignature, maxCommandCount, argumentBuffer, argumentBufferOffset, countBuffer, countBufferOffset);
 }
 
+void D3D12CommandContext::DispatchMesh(
+    UINT threadGroupCountX,
+    UINT threadGroupCountY,
+    UINT threadGroupCountZ)
+{
+    if (commandList6_)
+    {
+        FlushAllResourceBarriers();
+        FlushGraphicsStagingDescriptorTables();
+        commandList6_->DispatchMesh(threadGroupCountX, threadGroupCountY, threadGroupCountZ);
+    }
+}
+
 void D3D12CommandContext::Dispatch(
     UINT threadGroupCountX,
     UINT threadGroupCountY,
     UINT threadGroupCountZ)
 {
+    FlushAllResourceBarriers();
     FlushComputeStagingDescriptorTables();
     commandList_->Dispatch(threadGroupCountX, threadGroupCountY, threadGroupCountZ);
 }
@@ -514,10 +904,36 @@ void D3D12CommandContext::DispatchIndirect(
     ID3D12Resource*         countBuffer,
     UINT64                  countBufferOffset)
 {
+    FlushAllResourceBarriers();
     FlushComputeStagingDescriptorTables();
     commandList_->ExecuteIndirect(commandSignature, maxCommandCount, argumentBuffer, argumentBufferOffset, countBuffer, countBufferOffset);
 }
 
+void D3D12CommandContext::BuildRaytracingAccelerationStructure(
+    const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC&           desc,
+    UINT                                                                numPostbuildInfoDescs,
+    const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC*  postbuildInfoDescs)
+{
+    /* ID3D12GraphicsCommandList5 inherits from ID3D12GraphicsCommandList4, which provides the ray tracing commands */
+    if (commandList5_)
+    {
+        FlushAllResourceBarriers();
+        commandList5_->BuildRaytracingAccelerationStructure(&desc, numPostbuildInfoDescs, postbuildInfoDescs);
+    }
+}
+
+void D3D12CommandContext::CopyRaytracingAccelerationStructure(
+    D3D12_GPU_VIRTUAL_ADDRESS                           dstAccelerationStructureData,
+    D3D12_GPU_VIRTUAL_ADDRESS                           srcAccelerationStructureData,
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE   mode)
+{
+    if (commandList5_)
+    {
+        FlushAllResourceBarriers();
+        commandList5_->CopyRaytracingAccelerationStructure(dstAccelerationStructureData, srcAccelerationStructureData, mode);
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -530,32 +946,279 @@ D3D12_RESOURCE_BARRIER& D3D12CommandContext::NextResourceBarrier()
     return resourceBarriers_[numResourceBarriers_++];
 }
 
+void D3D12CommandContext::AppendTransitionBarrier(ID3D12Resource* resource, UINT subresource, D3D12_RESOURCE_STATES oldState, D3D12_RESOURCE_STATES newState)
+{
+    /* Find the latest pending barrier of the same resource; barriers of other resources are independent */
+    for (UINT i = numResourceBarriers_; i-- > 0;)
+    {
+        D3D12_RESOURCE_BARRIER& pending = resourceBarriers_[i];
+        if (pending.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && pending.Transition.pResource == resource)
+        {
+            if (pending.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+                pending.Transition.Subresource == subresource &&
+                pending.Transition.StateAfter == oldState)
+            {
+                /* No command has accessed the intermediate state, so fold both transitions or drop them if they cancel out */
+                if (pending.Transition.StateBefore == newState)
+                {
+                    std::move(resourceBarriers_ + i + 1, resourceBarriers_ + numResourceBarriers_, resourceBarriers_ + i);
+                    --numResourceBarriers_;
+                }
+                else
+                    pending.Transition.StateAfter = newState;
+                return;
+            }
+            break;
+        }
+        if (pending.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV && pending.UAV.pResource == resource)
+            break;
+    }
+
+    auto& barrier = NextResourceBarrier();
+
+    /* Initialize resource barrier for resource transition */
+    barrier.Type                    = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Flags                   = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    barrier.Transition.pResource    = resource;
+    barrier.Transition.Subresource  = subresource;
+    barrier.Transition.StateBefore  = oldState;
+    barrier.Transition.StateAfter   = newState;
+}
+
+void D3D12CommandContext::EndSplitBarrier(D3D12Resource& resource)
+{
+    if (!resource.splitBarrierPending)
+        return;
+
+    for_range(i, numSplitBarriers_)
+    {
+        if (splitBarriers_[i].resource == &resource)
+        {
+            /* Record END_ONLY barrier and remove entry by moving the last one into its place */
+            NextResourceBarrier() = splitBarriers_[i].endBarrier;
+            splitBarriers_[i] = splitBarriers_[--numSplitBarriers_];
+            break;
+        }
+    }
+
+    resource.splitBarrierPending = false;
+}
+
+void D3D12CommandContext::EndAllSplitBarriers()
+{
+    for_range(i, numSplitBarriers_)
+    {
+        NextResourceBarrier() = splitBarriers_[i].endBarrier;
+        splitBarriers_[i].resource->splitBarrierPending = false;
+    }
+    numSplitBarriers_ = 0;
+}
+
+#ifdef LLGL_D3D12_ENHANCED_BARRIERS
+
+void D3D12CommandContext::FlushEnhancedBarriers()
+{
+    D3D12_GLOBAL_BARRIER    globalBarriers[D3D12CommandContext::maxNumResourceBarrieres];
+    D3D12_BUFFER_BARRIER    bufferBarriers[D3D12CommandContext::maxNumResourceBarrieres];
+    D3D12_TEXTURE_BARRIER   textureBarriers[D3D12CommandContext::maxNumResourceBarrieres];
+    UINT                    numGlobalBarriers   = 0;
+    UINT                    numBufferBarriers   = 0;
+    UINT                    numTextureBarriers  = 0;
+
+    for_range(i, numResourceBarriers_)
+    {
+        const D3D12_RESOURCE_BARRIER& legacyBarrier = resourceBarriers_[i];
+        if (legacyBarrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV)
+        {
+            /* Translate UAV barrier into global barrier that only synchronizes unordered accesses, which doesn't require any cache flushes for other accesses */
+            D3D12_GLOBAL_BARRIER& barrier = globalBarriers[numGlobalBarriers++];
+            {
+                barrier.SyncBefore      = D3D12_BARRIER_SYNC_ALL_SHADING;
+                barrier.SyncAfter       = D3D12_BARRIER_SYNC_ALL_SHADING;
+                barrier.AccessBefore    = D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+                barrier.AccessAfter     = D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+            }
+        }
+        else if (legacyBarrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION)
+        {
+            const D3D12EnhancedBarrierState before  = GetD3D12EnhancedBarrierState(legacyBarrier.Transition.StateBefore);
+            const D3D12EnhancedBarrierState after   = GetD3D12EnhancedBarrierState(legacyBarrier.Transition.StateAfter);
+
+            /* Split barriers are expressed with a split synchronization scope between the begin and end barriers */
+            const D3D12_BARRIER_SYNC syncBefore = ((legacyBarrier.Flags & D3D12_RESOURCE_BARRIER_FLAG_END_ONLY)   != 0 ? D3D12_BARRIER_SYNC_SPLIT : before.sync);
+            const D3D12_BARRIER_SYNC syncAfter  = ((legacyBarrier.Flags & D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY) != 0 ? D3D12_BARRIER_SYNC_SPLIT : after.sync);
+
+            ID3D12Resource* resource = legacyBarrier.Transition.pResource;
+            if (resource->GetDesc().Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+            {
+                /* Buffers have no layouts, so only their accesses are synchronized */
+                D3D12_BUFFER_BARRIER& barrier = bufferBarriers[numBufferBarriers++];
+                {
+                    barrier.SyncBefore      = syncBefore;
+                    barrier.SyncAfter       = syncAfter;
+                    barrier.AccessBefore    = before.access;
+                    barrier.AccessAfter     = after.access;
+                    barrier.pResource       = resource;
+                    barrier.Offset          = 0;
+                    barrier.Size            = UINT64_MAX;
+                }
+            }
+            else
+            {
+                D3D12_TEXTURE_BARRIER& barrier = textureBarriers[numTextureBarriers++];
+                {
+                    barrier.SyncBefore      = syncBefore;
+                    barrier.SyncAfter       = syncAfter;
+                    barrier.AccessBefore    = before.access;
+                    barrier.AccessAfter     = after.access;
+                    barrier.LayoutBefore    = before.layout;
+                    barrier.LayoutAfter     = after.layout;
+                    barrier.pResource       = resource;
+                    barrier.Subresources    = GetD3D12BarrierSubresourceRange(legacyBarrier.Transition.Subresource);
+                    barrier.Flags           = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+                }
+            }
+        }
+    }
+
+    /* Record all barriers with a single call */
+    D3D12_BARRIER_GROUP barrierGroups[3];
+    UINT numBarrierGroups = 0;
+
+    if (numGlobalBarriers > 0)
+    {
+        D3D12_BARRIER_GROUP& group = barrierGroups[numBarrierGroups++];
+        group.Type              = D3D12_BARRIER_TYPE_GLOBAL;
+        group.NumBarriers       = numGlobalBarriers;
+        group.pGlobalBarriers   = globalBarriers;
+    }
+    if (numBufferBarriers > 0)
+    {
+        D3D12_BARRIER_GROUP& group = barrierGroups[numBarrierGroups++];
+        group.Type              = D3D12_BARRIER_TYPE_BUFFER;
+        group.NumBarriers       = numBufferBarriers;
+        group.pBufferBarriers   = bufferBarriers;
+    }
+    if (numTextureBarriers > 0)
+    {
+        D3D12_BARRIER_GROUP& group = barrierGroups[numBarrierGroups++];
+        group.Type              = D3D12_BARRIER_TYPE_TEXTURE;
+        group.NumBarriers       = numTextureBarriers;
+        group.pTextureBarriers  = textureBarriers;
+    }
+
+    commandList7_->Barrier(numBarrierGroups, barrierGroups);
+}
+
+#endif // /LLGL_D3D12_ENHANCED_BARRIERS
+
 void D3D12CommandContext::NextCommandAllocator()
 {
-    /* Clear descriptor cache and reset staging buffer pool */
-    descriptorCaches_[currentAllocatorIndex_].Clear();
-    stagingBufferPools_[currentAllocatorIndex_].Reset();
+    /* Clear descriptor cache and associate staging buffer allocations with the fence value of the submitted frame */
+    currentAllocator_->descriptorCache.Clear();
 
-    /* Get next command allocator */
-    const UINT64 currentFenceValue = allocatorFenceValues_[currentAllocatorIndex_];
-    currentAllocatorIndex_ = ((currentAllocatorIndex_ + 1) % numAllocators_);
+    if (currentAllocator_->submitted)
+    {
+        stagingBufferPool_.FinishFrame(currentAllocator_->fenceValue);
+        inFlightAllocators_.push_back(std::move(currentAllocator_));
+    }
+    else
+    {
+        /* Command list has never been submitted, so its allocator can be reused immediately; staging memory is released with the last submission */
+        stagingBufferPool_.FinishFrame(nextFenceValue_ - 1);
+        RecycleCommandAllocator(std::move(currentAllocator_));
+    }
 
-    /* Wait until fence value of next allocator has been signaled */
-    allocatorFence_.WaitForHigherSignal(allocatorFenceValues_[currentAllocatorIndex_]);
-    allocatorFenceValues_[currentAllocatorIndex_] = currentFenceValue + 1;
+    /* Take next free command allocator; only block if the maximum number of allocators is in flight */
+    ReclaimCompletedAllocators();
 
+    if (freeAllocators_.empty())
+    {
+        numIdleFrames_ = 0;
+        if (numAllocators_ < D3D12CommandContext::maxNumAllocators)
+            freeAllocators_.push_back(CreateCommandAllocatorSlot());
+        else
+        {
+            allocatorFence_.WaitForHigherSignal(inFlightAllocators_.front()->fenceValue);
+            ReclaimCompletedAllocators();
+        }
+    }
+    else
+        TrimIdleAllocators();
+
+    currentAllocator_ = std::move(freeAllocators_.back());
+    freeAllocators_.pop_back();
+
+    /* Reclaim staging buffer memory of all frames the GPU has completed */
+    stagingBufferPool_.Reclaim(allocatorFence_.GetCompletedValue());
+}
+
+D3D12CommandContext::CommandAllocatorSlotPtr D3D12CommandContext::CreateCommandAllocatorSlot()
+{
+    CommandAllocatorSlotPtr slot = MakeUnique<CommandAllocatorSlot>();
+
+    HRESULT hr = device_->CreateCommandAllocator(commandListType_, IID_PPV_ARGS(slot->commandAllocator.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12CommandAllocator");
+
+    for_range(i, D3D12CommandContext::maxNumDescriptorHeaps)
+        slot->stagingDescriptorPools[i].InitializeDevice(device_, *sharedDescriptorHeaps_[i]);
+    slot->descriptorCache.Create(device_);
+
+    ++numAllocators_;
+
+    return slot;
+}
+
+void D3D12CommandContext::RecycleCommandAllocator(CommandAllocatorSlotPtr&& slot)
+{
     /* Reclaim memory allocated by command allocator using <ID3D12CommandAllocator::Reset> */
-    auto hr = GetCommandAllocator()->Reset();
+    HRESULT hr = slot->commandAllocator->Reset();
     DXThrowIfFailed(hr, "failed to reset D3D12 command allocator");
 
-    /* Reset descriptor heap pools before they are re-used */
+    /* Return pages of descriptor heap pools to the shared heaps before they are re-used */
     for_range(i, D3D12CommandContext::maxNumDescriptorHeaps)
-        stagingDescriptorPools_[currentAllocatorIndex_][i].Reset();
+        slot->stagingDescriptorPools[i].Reset();
+
+    slot->submitted = false;
+    freeAllocators_.push_back(std::move(slot));
+}
+
+void D3D12CommandContext::ReclaimCompletedAllocators()
+{
+    /* Fence values are increasing, so stop at the first allocator that is still in flight */
+    const UINT64 completedValue = allocatorFence_.GetCompletedValue();
+    while (!inFlightAllocators_.empty() && inFlightAllocators_.front()->fenceValue <= completedValue)
+    {
+        RecycleCommandAllocator(std::move(inFlightAllocators_.front()));
+        inFlightAllocators_.pop_front();
+    }
+}
+
+void D3D12CommandContext::TrimIdleAllocators()
+{
+    /* Release the least recently used allocator after more allocators than needed have been free for a number of consecutive frames */
+    if (freeAllocators_.size() > 1 && numAllocators_ > minNumAllocators_)
+    {
+        if (++numIdleFrames_ >= D3D12CommandContext::numIdleFramesBeforeTrim)
+        {
+            freeAllocators_.erase(freeAllocators_.begin());
+            --numAllocators_;
+            numIdleFrames_ = 0;
+        }
+    }
+    else
+        numIdleFrames_ = 0;
 }
 
 void D3D12CommandContext::ClearCache()
 {
     stateCache_.dirtyBits.value = ~0u;
+
+    /* Reset shading rate states to their defaults, since resetting the command list restores them as well */
+    stateCache_.shadingRate             = D3D12_SHADING_RATE_1X1;
+    stateCache_.shadingRateCombiners[0] = D3D12_SHADING_RATE_COMBINER_PASSTHROUGH;
+    stateCache_.shadingRateCombiners[1] = D3D12_SHADING_RATE_COMBINER_PASSTHROUGH;
+    stateCache_.shadingRateImage        = nullptr;
 }
 
 
@@ -18,6 +18,14 @@
 #include <d3d12.h>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <vector>
+#include <deque>
+
+/* Enhanced barriers require a Windows SDK that declares ID3D12GraphicsCommandList7; the runtime support is determined when the command context is created */
+#ifdef __ID3D12GraphicsCommandList7_INTERFACE_DEFINED__
+#   define LLGL_D3D12_ENHANCED_BARRIERS
+#endif
 
 
 namespace LLGL
@@ -27,6 +35,7 @@ namespace LLGL
 struct D3D12Resource;
 class D3D12Device;
 class D3D12CommandQueue;
+class D3D12SharedDescriptorHeap;
 
 union D3D12Constant
 {
@@ -46,6 +55,11 @@ union D3D12Constant
 class D3D12CommandContext
 {
 
+    public:
+
+        // Default initial size (in bytes) of the staging ring buffer.
+        static constexpr UINT64 defaultStagingBufferSize = (0xFFFF + 1);
+
     public:
 
         D3D12CommandContext();
@@ -55,45 +69,80 @@ class D3D12CommandContext
             D3D12CommandQueue&  commandQueue
         );
 
-        // Creats the command list and internal command allocators.
+        /*
+        Creats the command list and internal command allocators.
+        'numInitialAllocators' only specifies how many command allocators are created up front,
+        since more are created on demand while the GPU has not completed the previous ones.
+        */
         void Create(
             D3D12Device&            device,
             D3D12CommandQueue&      commandQueue,
-            D3D12_COMMAND_LIST_TYPE commandListType         = D3D12_COMMAND_LIST_TYPE_DIRECT,
-            UINT                    numAllocators           = ~0u,
-            UINT64                  initialStagingChunkSize = (0xFFFF + 1),
-            bool                    initialClose            = false
+            D3D12_COMMAND_LIST_TYPE commandListType             = D3D12_COMMAND_LIST_TYPE_DIRECT,
+            UINT                    numInitialAllocators        = 2,
+            UINT64                  initialStagingBufferSize    = D3D12CommandContext::defaultStagingBufferSize,
+            UINT                    stagingBufferTrimFrames     = 120,
+            bool                    initialClose                = false
         );
 
         void Close();
         void Execute();
         void Reset();
 
+        // Signals the fence of the current command allocator. This must be called after the command list has been executed as part of a batch.
+        void SignalAllocatorFence();
+
         // Calls Close, Execute, and Reset with the internal command queue and allocator.
         void Finish(bool waitIdle = false);
 
+        // Shrinks the staging buffer pool to its initial size and releases all free command allocators above the initial number. Returns the number of released staging bytes.
+        UINT64 TrimMemory();
+
         // Returns the command list of this context.
         inline ID3D12GraphicsCommandList* GetCommandList() const
         {
             return commandList_.Get();
         }
 
-        // Transition all subresources to the specified new state.
+        /*
+        Transition all subresources to the specified new state.
+        Transitions into a read state that is already included in the current combined read state are omitted,
+        and transitions that are not flushed yet are folded with subsequent transitions of the same subresource.
+        */
         void TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES newState, D3D12_RESOURCE_STATES oldState, bool flushImmediate = false);
         void TransitionResource(D3D12Resource& resource, D3D12_RESOURCE_STATES newState, bool flushImmediate = false);
 
+        /*
+        Transitions all subresources of a texture to the specified new state and discards their previous content, e.g. for render targets that are not loaded.
+        The discard only takes effect with enhanced barriers; otherwise this is a regular transition.
+        */
+        void TransitionResourceDiscard(D3D12Resource& resource, D3D12_RESOURCE_STATES newState);
+
+        // Transitions a single subresource to the specified new state. Its state is tracked independently until all subresources are in the same state again.
+        void TransitionSubresource(D3D12Resource& resource, UINT subresource, D3D12_RESOURCE_STATES newState, bool flushImmediate = false);
+
+        /*
+        Begins a split barrier to transition all subresources into the specified new state while the resource is idle until its next use.
+        The split barrier is ended with the next transition of this resource or before the next draw or dispatch command, whichever comes first.
+        */
+        void BeginSplitTransition(D3D12Resource& resource, D3D12_RESOURCE_STATES newState);
+
         // Insert a resource barrier for an unordered access view (UAV).
         void InsertUAVBarrier(D3D12Resource& resource, bool flushImmediate = false);
 
         // Flush all accumulated resource barriers.
         void FlushResourceBarrieres();
 
+        // Ends all pending split barriers and flushes all accumulated resource barriers, e.g. before commands that access resources implicitly.
+        void FlushAllResourceBarriers();
+
+        // Resolves the multi-sampled source into the destination subresource. The optional source rectangle is ignored if ID3D12GraphicsCommandList1 is not supported.
         void ResolveSubresource(
-            D3D12Resource&  dstResource,
-            UINT            dstSubresource,
-            D3D12Resource&  srcResource,
-            UINT            srcSubresource,
-            DXGI_FORMAT     format
+            D3D12Resource&      dstResource,
+            UINT                dstSubresource,
+            D3D12Resource&      srcResource,
+            UINT                srcSubresource,
+            DXGI_FORMAT         format,
+            const D3D12_RECT*   srcRect         = nullptr
         );
 
         void CopyTextureRegion(
@@ -107,11 +156,13 @@ class D3D12CommandContext
             const D3D12_BOX*    srcBox
         );
 
+        // Writes the specified data to the destination buffer via the staging ring buffer of this command context.
         void UpdateSubresource(
             D3D12Resource&  dstResource,
             UINT64          dstOffset,
             const void*     data,
-            UINT64          dataSize
+            UINT64          dataSize,
+            UINT64          alignment   = 256u
         );
 
         void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature);
@@ -119,6 +170,18 @@ class D3D12CommandContext
         void SetPipelineState(ID3D12PipelineState* pipelineState);
         void SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps);
 
+        /*
+        Sets the shading rate and combiners for variable rate shading. This is a no-op if the state is unchanged,
+        so the command list is not touched on devices without VRS support as long as the default state is used.
+        */
+        void SetShadingRate(D3D12_SHADING_RATE shadingRate, const D3D12_SHADING_RATE_COMBINER (&combiners)[2]);
+
+        // Sets the shading-rate image for variable rate shading or null to disable it.
+        void SetShadingRateImage(ID3D12Resource* shadingRateImage);
+
+        // Binds the shader-visible descriptor heaps the staging descriptors are copied into.
+        void SetStagingDescriptorHeaps();
+
         void PrepareStagingDescriptorHeaps(
             const D3D12DescriptorHeapSetLayout& layout,
             const D3D12RootParameterIndices&    indices
@@ -145,6 +208,13 @@ class D3D12CommandContext
             D3D12_DESCRIPTOR_RANGE_TYPE descRangeType
         );
 
+        void EmplaceBufferRangeDescriptorForStaging(
+            D3D12Buffer&                bufferD3D,
+            UINT                        location,
+            D3D12_DESCRIPTOR_RANGE_TYPE descRangeType,
+            const BufferViewDescriptor& bufferViewDesc
+        );
+
         void DrawInstanced(
             UINT vertexCountPerInstance,
             UINT instanceCount,
@@ -169,6 +239,13 @@ class D3D12CommandContext
             UINT64                  countBufferOffset       = 0
         );
 
+        // Dispatches a mesh pipeline. This is a no-op if the runtime does not support mesh shaders.
+        void DispatchMesh(
+            UINT threadGroupCountX,
+            UINT threadGroupCountY,
+            UINT threadGroupCountZ
+        );
+
         void Dispatch(
             UINT threadGroupCountX,
             UINT threadGroupCountY,
@@ -184,6 +261,20 @@ class D3D12CommandContext
             UINT64                  countBufferOffset       = 0
         );
 
+        // Builds or updates a ray tracing acceleration structure. This is a no-op if the runtime does not support ID3D12GraphicsCommandList4.
+        void BuildRaytracingAccelerationStructure(
+            const D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC&               desc,
+            UINT                                                                    numPostbuildInfoDescs   = 0,
+            const D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC*      postbuildInfoDescs      = nullptr
+        );
+
+        // Copies or compacts a ray tracing acceleration structure. This is a no-op if the runtime does not support ID3D12GraphicsCommandList4.
+        void CopyRaytracingAccelerationStructure(
+            D3D12_GPU_VIRTUAL_ADDRESS                               dstAccelerationStructureData,
+            D3D12_GPU_VIRTUAL_ADDRESS                               srcAccelerationStructureData,
+            D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE       mode
+        );
+
     public:
 
         // Returns the native D3D12 device this command context was created with.
@@ -192,10 +283,30 @@ class D3D12CommandContext
             return device_;
         }
 
+        // Returns the command queue this command context was created with.
+        inline D3D12CommandQueue* GetCommandQueue() const
+        {
+            return commandQueue_;
+        }
+
+        // Returns the fence that is signaled by each submission of this command context.
+        inline ID3D12Fence* GetAllocatorFence() const
+        {
+            return allocatorFence_.Get();
+        }
+
+        // Returns the value the allocator fence will be signaled with by the next submission of this command context.
+        inline UINT64 GetNextFenceValue() const
+        {
+            return nextFenceValue_;
+        }
+
     private:
 
-        static constexpr UINT maxNumAllocators          = 3;
+        static constexpr UINT maxNumAllocators          = 16;
+        static constexpr UINT numIdleFramesBeforeTrim   = 120;
         static constexpr UINT maxNumResourceBarrieres   = 16;
+        static constexpr UINT maxNumSplitBarriers       = 16;
         static constexpr UINT maxNumDescriptorHeaps     = 2;
 
     private:
@@ -220,6 +331,30 @@ class D3D12CommandContext
             ID3D12PipelineState*    pipelineState                           = nullptr;
             UINT                    numDescriptorHeaps                      = 0;
             ID3D12DescriptorHeap*   descriptorHeaps[maxNumDescriptorHeaps]  = {};
+
+            // Shading rate states are reset together with the command list, so they are not part of the dirty bits
+            D3D12_SHADING_RATE          shadingRate                         = D3D12_SHADING_RATE_1X1;
+            D3D12_SHADING_RATE_COMBINER shadingRateCombiners[2]             = { D3D12_SHADING_RATE_COMBINER_PASSTHROUGH, D3D12_SHADING_RATE_COMBINER_PASSTHROUGH };
+            ID3D12Resource*             shadingRateImage                    = nullptr;
+        };
+
+        // Command allocator with its staging descriptors and the fence value that is signaled once the GPU has completed its command list.
+        struct CommandAllocatorSlot
+        {
+            ComPtr<ID3D12CommandAllocator>  commandAllocator;
+            UINT64                          fenceValue                                  = 0;
+            bool                            submitted                                   = false;
+            D3D12StagingDescriptorHeapPool  stagingDescriptorPools[maxNumDescriptorHeaps];
+            D3D12DescriptorCache            descriptorCache;
+        };
+
+        using CommandAllocatorSlotPtr = std::unique_ptr<CommandAllocatorSlot>;
+
+        // Resource and its END_ONLY barrier of a split barrier that has begun.
+        struct SplitBarrier
+        {
+            D3D12Resource*          resource;
+            D3D12_RESOURCE_BARRIER  endBarrier;
         };
 
     private:
@@ -230,16 +365,42 @@ class D3D12CommandContext
         // Returns the next resource barrier and flushes previous barriers if the cache is full.
         D3D12_RESOURCE_BARRIER& NextResourceBarrier();
 
-        // Switches to the next command allocator and resets it.
+        // Appends a transition barrier or folds it into a pending transition of the same subresource that has not been flushed yet.
+        void AppendTransitionBarrier(ID3D12Resource* resource, UINT subresource, D3D12_RESOURCE_STATES oldState, D3D12_RESOURCE_STATES newState);
+
+        // Ends the pending split barrier of the specified resource, if there is one.
+        void EndSplitBarrier(D3D12Resource& resource);
+
+        // Ends all pending split barriers.
+        void EndAllSplitBarriers();
+
+        #ifdef LLGL_D3D12_ENHANCED_BARRIERS
+        // Translates all accumulated resource barriers into enhanced barriers and records them with ID3D12GraphicsCommandList7::Barrier.
+        void FlushEnhancedBarriers();
+        #endif
+
+        // Switches to the next command allocator and resets it. A new command allocator is created if all others are still in flight.
         void NextCommandAllocator();
 
+        // Creates a new command allocator with its staging descriptor pools.
+        CommandAllocatorSlotPtr CreateCommandAllocatorSlot();
+
+        // Resets the command allocator and its staging descriptors and moves it into the list of free allocators.
+        void RecycleCommandAllocator(CommandAllocatorSlotPtr&& slot);
+
+        // Moves all command allocators the GPU has completed from the in-flight queue into the list of free allocators.
+        void ReclaimCompletedAllocators();
+
+        // Releases one free command allocator if there have been more than needed for a while, e.g. after a load spike.
+        void TrimIdleAllocators();
+
         void FlushGraphicsStagingDescriptorTables();
         void FlushComputeStagingDescriptorTables();
 
         // Returns the current command allocator.
         inline ID3D12CommandAllocator* GetCommandAllocator() const
         {
-            return commandAllocators_[currentAllocatorIndex_].Get();
+            return currentAllocator_->commandAllocator.Get();
         }
 
     private:
@@ -247,24 +408,36 @@ class D3D12CommandContext
         ID3D12Device*                       device_                                     = nullptr;
         D3D12CommandQueue*                  commandQueue_                               = nullptr;
 
-        ComPtr<ID3D12CommandAllocator>      commandAllocators_[maxNumAllocators];
-        UINT                                currentAllocatorIndex_                      = 0;
-        UINT                                numAllocators_                              = maxNumAllocators;
+        D3D12_COMMAND_LIST_TYPE             commandListType_                            = D3D12_COMMAND_LIST_TYPE_DIRECT;
+        D3D12SharedDescriptorHeap*          sharedDescriptorHeaps_[maxNumDescriptorHeaps] = {};
+
+        CommandAllocatorSlotPtr             currentAllocator_;
+        std::deque<CommandAllocatorSlotPtr> inFlightAllocators_;                        // Submitted allocators in order of their fence values
+        std::vector<CommandAllocatorSlotPtr> freeAllocators_;
+        UINT                                numAllocators_                              = 0;
+        UINT                                minNumAllocators_                           = 1;
+        UINT                                numIdleFrames_                              = 0;
 
-        UINT64                              allocatorFenceValues_[maxNumAllocators]     = {};
+        UINT64                              nextFenceValue_                             = 1;
         D3D12NativeFence                    allocatorFence_;
 
         ComPtr<ID3D12GraphicsCommandList>   commandList_;
+        ComPtr<ID3D12GraphicsCommandList5>  commandList5_;                              // Only available if variable rate shading or ray tracing is supported by the runtime
+        ComPtr<ID3D12GraphicsCommandList6>  commandList6_;                              // Only available if mesh shaders are supported by the runtime
+        #ifdef LLGL_D3D12_ENHANCED_BARRIERS
+        ComPtr<ID3D12GraphicsCommandList7>  commandList7_;                              // Only available if enhanced barriers are supported by the runtime and not used for copy command lists
+        #endif
 
         D3D12_RESOURCE_BARRIER              resourceBarriers_[maxNumResourceBarrieres];
         UINT                                numResourceBarriers_                        = 0;
 
-        D3D12StagingDescriptorHeapPool      stagingDescriptorPools_[maxNumAllocators][maxNumDescriptorHeaps];
+        SplitBarrier                        splitBarriers_[maxNumSplitBarriers];
+        UINT                                numSplitBarriers_                           = 0;
+
         D3D12DescriptorHeapSetLayout        stagingDescriptorSetLayout_;
         D3D12RootParameterIndices           stagingDescriptorIndices_;
-        D3D12DescriptorCache                descriptorCaches_[maxNumAllocators];
 
-        D3D12StagingBufferPool              stagingBufferPools_[maxNumAllocators];
+        D3D12StagingBufferPool              stagingBufferPool_;
 
         StateCache                          stateCache_;
 
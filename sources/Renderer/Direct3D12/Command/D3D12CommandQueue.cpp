@@ -9,10 +9,16 @@
 #include "D3D12CommandBuffer.h"
 #include "../D3D12ObjectUtils.h"
 #include "../D3D12RenderSystem.h"
+#include "../D3D12SwapChain.h"
 #include "../RenderState/D3D12Fence.h"
 #include "../RenderState/D3D12QueryHeap.h"
+#include "../Buffer/D3D12Buffer.h"
+#include "../Texture/D3D12Texture.h"
 #include "../../CheckedCast.h"
 #include "../../DXCommon/DXCore.h"
+#include "../../HostTrace.h"
+#include <LLGL/Container/SmallVector.h>
+#include <LLGL/Utils/ForRange.h>
 
 
 namespace LLGL
@@ -26,8 +32,13 @@ D3D12CommandQueue::D3D12CommandQueue(
     native_     { device.CreateDXCommandQueue(type) },
     queueFence_ { device.GetNative()                }
 {
-    commandContext_.Create(device, *this);
-    DetermineTimestampFrequency();
+    /* Select initial size of the staging ring buffer by the tuning profile of the device */
+    const UINT64 stagingBufferSize = GetTuningSize(device.GetTuningProfile().stagingChunkSize, D3D12CommandContext::defaultStagingBufferSize);
+    commandContext_.Create(device, *this, type, 2, stagingBufferSize);
+
+    /* Timestamp queries are optional on copy queues */
+    if (type != D3D12_COMMAND_LIST_TYPE_COPY)
+        DetermineTimestampFrequency();
 }
 
 void D3D12CommandQueue::SetName(const char* name)
@@ -39,10 +50,79 @@ void D3D12CommandQueue::SetName(const char* name)
 
 void D3D12CommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_HOST_TRACE_SCOPE("Submit");
+
     /* Execute command list */
     auto& commandBufferD3D = LLGL_CAST(D3D12CommandBuffer&, commandBuffer);
     if (!commandBufferD3D.IsImmediateCmdBuffer())
         commandBufferD3D.Execute();
+    frameCounters_.SubmitCommandBuffer(commandBufferD3D.GetFrameCounters());
+}
+
+void D3D12CommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    /* Gather command lists of all deferred command buffers that were created for this queue */
+    SmallVector<ID3D12CommandList*, 8> commandLists;
+    SmallVector<D3D12CommandContext*, 8> commandContexts;
+
+    for_range(i, numCommandBuffers)
+    {
+        auto& commandBufferD3D = LLGL_CAST(D3D12CommandBuffer&, *commandBuffers[i]);
+        frameCounters_.SubmitCommandBuffer(commandBufferD3D.GetFrameCounters());
+        if (commandBufferD3D.IsImmediateCmdBuffer())
+            continue;
+
+        D3D12CommandContext& context = commandBufferD3D.GetCommandContext();
+        if (context.GetCommandQueue() == this)
+        {
+            commandLists.push_back(context.GetCommandList());
+            commandContexts.push_back(&context);
+        }
+        else
+            commandBufferD3D.Execute();
+    }
+
+    if (!commandLists.empty())
+    {
+        /* Execute all command lists with a single call, then signal the allocator fence of each context */
+        ExecuteCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
+        for (D3D12CommandContext* context : commandContexts)
+            context->SignalAllocatorFence();
+    }
+}
+
+/* ----- Presentation ----- */
+
+void D3D12CommandQueue::Present(std::uint32_t numSwapChains, SwapChain* const * swapChains)
+{
+    LLGL_HOST_TRACE_SCOPE("Present");
+
+    /* Present all DXGI swap-chains back-to-back, so that no swap-chain waits for its next frame before the others have been presented */
+    for_range(i, numSwapChains)
+    {
+        if (swapChains[i] != nullptr)
+            LLGL_CAST(D3D12SwapChain*, swapChains[i])->PresentDXGI();
+    }
+
+    for_range(i, numSwapChains)
+    {
+        if (swapChains[i] != nullptr)
+            LLGL_CAST(D3D12SwapChain*, swapChains[i])->MoveToNextFrameAndWait();
+    }
+}
+
+/* ----- Sparse Resources ----- */
+
+void D3D12CommandQueue::UpdateTileMappings(Texture& texture, std::uint32_t numMappings, const TextureTileMapping* mappings)
+{
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+    textureD3D.UpdateTileMappings(GetNative(), numMappings, mappings);
+}
+
+void D3D12CommandQueue::UpdateTileMappings(Buffer& buffer, std::uint32_t numMappings, const BufferTileMapping* mappings)
+{
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    bufferD3D.UpdateTileMappings(GetNative(), numMappings, mappings);
 }
 
 /* ----- Queries ----- */
@@ -56,12 +136,12 @@ bool D3D12CommandQueue::QueryResult(
 {
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
 
-    /* Ensure query results have been resolved */
-    if (queryHeapD3D.InsideDirtyRange(firstQuery, numQueries))
-    {
-        queryHeapD3D.FlushDirtyRange(commandContext_.GetCommandList());
-        commandContext_.Finish(true);
-    }
+    /*
+    Query results are resolved at the end of each command buffer, so they are only available once the GPU has completed it.
+    Don't block here; this matches the other backends that return false while results are still pending.
+    */
+    if (!queryHeapD3D.IsResultAvailable(firstQuery, numQueries))
+        return false;
 
     /* Map query result buffer to CPU local memory */
     auto mappedData = queryHeapD3D.Map(firstQuery, numQueries);
@@ -71,7 +151,16 @@ bool D3D12CommandQueue::QueryResult(
     const auto queryType = queryHeapD3D.GetNativeType();
     bool result = false;
 
-    if (dataSize == numQueries * sizeof(std::uint32_t))
+    if (queryHeapD3D.GetType() == QueryType::Timestamp)
+    {
+        /* Query timestamps only as 64-bit values, since their 32-bit values would overflow */
+        if (dataSize == numQueries * sizeof(std::uint64_t))
+        {
+            QueryResultTimestamps(mappedData, firstQuery, numQueries, reinterpret_cast<std::uint64_t*>(data));
+            result = true;
+        }
+    }
+    else if (dataSize == numQueries * sizeof(std::uint32_t))
     {
         /* Query 64-bit values and convert them to 32-bit values */
         QueryResultUInt32(queryType, mappedData, firstQuery, numQueries, reinterpret_cast<std::uint32_t*>(data));
@@ -94,6 +183,24 @@ bool D3D12CommandQueue::QueryResult(
     return result;
 }
 
+bool D3D12CommandQueue::QueryFrameCounters(FrameProfile& outProfile)
+{
+    return frameCounters_.Query(outProfile);
+}
+
+bool D3D12CommandQueue::GetCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    /* Sample GPU timestamp and QueryPerformanceCounter, which is the same clock as Timer::Tick on Win32, at the same time */
+    UINT64 gpuTimestamp = 0, cpuTimestamp = 0;
+    if (FAILED(native_->GetClockCalibration(&gpuTimestamp, &cpuTimestamp)))
+        return false;
+
+    outTimestamps.cpuTicks      = cpuTimestamp;
+    outTimestamps.gpuTimestamp  = (isTimestampNanosecs_ ? gpuTimestamp : static_cast<std::uint64_t>(static_cast<double>(gpuTimestamp) * timestampScale_ + 0.5));
+    outTimestamps.maxDeviation  = 0;
+    return true;
+}
+
 /* ----- Fences ----- */
 
 void D3D12CommandQueue::Submit(Fence& fence)
@@ -101,6 +208,22 @@ void D3D12CommandQueue::Submit(Fence& fence)
     /* Schedule signal command into the queue */
     auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
     SignalFence(fenceD3D.GetNative(), fenceD3D.Signal());
+    frameCounters_.SubmitFence();
+}
+
+void D3D12CommandQueue::Submit(Fence& fence, std::uint64_t value)
+{
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+    SignalFence(fenceD3D.GetNative(), fenceD3D.Signal(value));
+    frameCounters_.SubmitFence();
+}
+
+void D3D12CommandQueue::SubmitWait(Fence& fence, std::uint64_t value)
+{
+    /* Schedule GPU-side wait command into the queue */
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+    auto hr = native_->Wait(fenceD3D.GetNative(), value);
+    DXThrowIfFailed(hr, "failed to wait for D3D12 fence with command queue");
 }
 
 bool D3D12CommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
@@ -109,9 +232,16 @@ bool D3D12CommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
     return fenceD3D.Wait(timeout);
 }
 
+bool D3D12CommandQueue::WaitFence(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+    return fenceD3D.Wait(value, timeout);
+}
+
 void D3D12CommandQueue::WaitIdle()
 {
     /* Submit intermediate fence and wait for it to be signaled */
+    std::lock_guard<std::mutex> guard{ queueFenceMutex_ };
     if (busy_)
     {
         ++queueFenceValue_;
@@ -192,6 +322,24 @@ void D3D12CommandQueue::QueryResultSingleUInt64(
     }
 }
 
+void D3D12CommandQueue::QueryResultTimestamps(
+    const void*         mappedData,
+    std::uint32_t       firstQuery,
+    std::uint32_t       numQueries,
+    std::uint64_t*      data)
+{
+    /* Convert timestamps from ticks to nanoseconds */
+    auto mappedDataUInt64 = reinterpret_cast<const std::uint64_t*>(mappedData);
+    for (std::uint32_t i = 0; i < numQueries; ++i)
+    {
+        const auto timestamp = mappedDataUInt64[firstQuery + i];
+        if (!isTimestampNanosecs_)
+            data[i] = static_cast<std::uint64_t>(static_cast<double>(timestamp) * timestampScale_ + 0.5);
+        else
+            data[i] = timestamp;
+    }
+}
+
 void D3D12CommandQueue::QueryResultUInt32(
     D3D12_QUERY_TYPE    queryType,
     const void*         mappedData,
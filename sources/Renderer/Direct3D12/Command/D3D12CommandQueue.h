@@ -14,8 +14,11 @@
 #include <LLGL/StaticLimits.h>
 #include "../RenderState/D3D12Fence.h"
 #include "../../DXCommon/ComPtr.h"
+#include "../../FrameCounters.h"
 #include <d3d12.h>
 #include <cstddef>
+#include <atomic>
+#include <mutex>
 
 
 namespace LLGL
@@ -31,6 +34,10 @@ class D3D12CommandQueue final : public CommandQueue
 
         #include <LLGL/Backend/CommandQueue.inl>
 
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers) override;
+
+        void Present(std::uint32_t numSwapChains, SwapChain* const * swapChains) override;
+
     public:
 
         D3D12CommandQueue(
@@ -55,12 +62,18 @@ class D3D12CommandQueue final : public CommandQueue
             return native_.Get();
         }
 
-        // Returns the command context for this queue.
+        // Returns the command context for this queue. Access to this context must be guarded with the mutex returned by GetContextMutex().
         inline D3D12CommandContext& GetContext()
         {
             return commandContext_;
         }
 
+        // Returns the mutex that guards the command context of this queue.
+        inline std::mutex& GetContextMutex()
+        {
+            return contextMutex_;
+        }
+
     private:
 
         void DetermineTimestampFrequency();
@@ -72,6 +85,13 @@ class D3D12CommandQueue final : public CommandQueue
             std::uint64_t&      data
         );
 
+        void QueryResultTimestamps(
+            const void*         mappedData,
+            std::uint32_t       firstQuery,
+            std::uint32_t       numQueries,
+            std::uint64_t*      data
+        );
+
         void QueryResultUInt32(
             D3D12_QUERY_TYPE    queryType,
             const void*         mappedData,
@@ -100,11 +120,14 @@ class D3D12CommandQueue final : public CommandQueue
 
         ComPtr<ID3D12CommandQueue>  native_;
         D3D12CommandContext         commandContext_;
+        std::mutex                  contextMutex_;
         D3D12NativeFence            queueFence_;
         UINT64                      queueFenceValue_        = 0;
+        std::mutex                  queueFenceMutex_;               // Guards 'queueFence_' and 'queueFenceValue_'
         double                      timestampScale_         = 1.0;  // Frequency to nanoseconds scale
         bool                        isTimestampNanosecs_    = true; // True, if timestamps are in nanoseconds unit
-        bool                        busy_                   = false;
+        std::atomic<bool>           busy_                   { false };
+        FrameCounterAccumulator     frameCounters_;
 
 };
 
@@ -33,11 +33,53 @@ static void DXCreateCommandSignature(ID3D12Device* device, ComPtr<ID3D12CommandS
 
 void D3D12SignatureFactory::CreateDefaultSignatures(ID3D12Device* device)
 {
+    device_ = device;
     DXCreateCommandSignature(device, signatureDrawIndirect_,        D3D12_INDIRECT_ARGUMENT_TYPE_DRAW,         sizeof(D3D12_DRAW_ARGUMENTS        ));
     DXCreateCommandSignature(device, signatureDrawIndexedIndirect_, D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, sizeof(D3D12_DRAW_INDEXED_ARGUMENTS));
     DXCreateCommandSignature(device, signatureDispatchIndirect_,    D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH,     sizeof(D3D12_DISPATCH_ARGUMENTS    ));
 }
 
+ID3D12CommandSignature* D3D12SignatureFactory::GetSignatureWithStride(D3D12_INDIRECT_ARGUMENT_TYPE argumentType, UINT stride) const
+{
+    /* Return default signatures if stride matches the size of their arguments */
+    switch (argumentType)
+    {
+        case D3D12_INDIRECT_ARGUMENT_TYPE_DRAW:
+            if (stride == sizeof(D3D12_DRAW_ARGUMENTS))
+                return signatureDrawIndirect_.Get();
+            break;
+        case D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED:
+            if (stride == sizeof(D3D12_DRAW_INDEXED_ARGUMENTS))
+                return signatureDrawIndexedIndirect_.Get();
+            break;
+        case D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH:
+            if (stride == sizeof(D3D12_DISPATCH_ARGUMENTS))
+                return signatureDispatchIndirect_.Get();
+            break;
+        default:
+            break;
+    }
+
+    /* Find or create signature with custom stride; command buffers may be encoded on multiple threads */
+    std::lock_guard<std::mutex> guard{ customSignaturesMutex_ };
+
+    for (const CustomSignature& entry : customSignatures_)
+    {
+        if (entry.argumentType == argumentType && entry.stride == stride)
+            return entry.signature.Get();
+    }
+
+    CustomSignature entry;
+    {
+        entry.argumentType  = argumentType;
+        entry.stride        = stride;
+    }
+    DXCreateCommandSignature(device_, entry.signature, argumentType, stride);
+    customSignatures_.push_back(entry);
+
+    return entry.signature.Get();
+}
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,8 @@
 
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
+#include <vector>
+#include <mutex>
 
 
 namespace LLGL
@@ -39,11 +41,31 @@ class D3D12SignatureFactory
             return signatureDispatchIndirect_.Get();
         }
 
+        /*
+        Returns the command signature for the specified argument type and byte stride.
+        Signatures with a non-default stride are created on demand; this function is thread-safe.
+        */
+        ID3D12CommandSignature* GetSignatureWithStride(D3D12_INDIRECT_ARGUMENT_TYPE argumentType, UINT stride) const;
+
     private:
 
-        ComPtr<ID3D12CommandSignature> signatureDrawIndirect_;
-        ComPtr<ID3D12CommandSignature> signatureDrawIndexedIndirect_;
-        ComPtr<ID3D12CommandSignature> signatureDispatchIndirect_;
+        struct CustomSignature
+        {
+            D3D12_INDIRECT_ARGUMENT_TYPE    argumentType;
+            UINT                            stride;
+            ComPtr<ID3D12CommandSignature>  signature;
+        };
+
+    private:
+
+        ID3D12Device*                           device_                         = nullptr;
+
+        ComPtr<ID3D12CommandSignature>          signatureDrawIndirect_;
+        ComPtr<ID3D12CommandSignature>          signatureDrawIndexedIndirect_;
+        ComPtr<ID3D12CommandSignature>          signatureDispatchIndirect_;
+
+        mutable std::mutex                      customSignaturesMutex_;
+        mutable std::vector<CustomSignature>    customSignatures_;
 
 };
 
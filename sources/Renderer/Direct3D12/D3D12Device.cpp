@@ -26,6 +26,15 @@ bool D3D12Device::CreateDXDevice(HRESULT& hr, IDXGIAdapter* adapter, const std::
         {
             /* Store selected feature level */
             featureLevel_ = level;
+            tileHeapPool_.InitializeDevice(device_.Get());
+            memoryAllocator_.InitializeDevice(device_.Get());
+
+            #ifdef LLGL_D3D12_ENABLE_GPU_UPLOAD_HEAP
+            /* Place CPU-writable resources in video memory if the whole VRAM is visible to the CPU (Resizable BAR) */
+            D3D12_FEATURE_DATA_D3D12_OPTIONS16 options16 = {};
+            if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS16, &options16, sizeof(options16))) && options16.GPUUploadHeapSupported)
+                uploadHeapType_ = D3D12_HEAP_TYPE_GPU_UPLOAD;
+            #endif
 
             #ifdef LLGL_DEBUG
             if (SUCCEEDED(device_.As(&infoQueue_)))
@@ -93,6 +102,20 @@ ComPtr<ID3D12PipelineState> D3D12Device::CreateDXComputePipelineState(const D3D1
     return pipelineState;
 }
 
+ComPtr<ID3D12PipelineState> D3D12Device::CreateDXPipelineStateFromStream(const D3D12_PIPELINE_STATE_STREAM_DESC& desc)
+{
+    /* Pipeline state streams require ID3D12Device2, which is available on all runtimes that support mesh shaders */
+    ComPtr<ID3D12Device2> device2;
+    HRESULT hr = device_.As(&device2);
+    DXThrowIfFailed(hr, "failed to query ID3D12Device2 interface for pipeline state stream");
+
+    ComPtr<ID3D12PipelineState> pipelineState;
+    hr = device2->CreatePipelineState(&desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12PipelineState");
+
+    return pipelineState;
+}
+
 ComPtr<ID3D12QueryHeap> D3D12Device::CreateDXQueryHeap(const D3D12_QUERY_HEAP_DESC& desc)
 {
     ComPtr<ID3D12QueryHeap> queryHeap;
@@ -103,6 +126,35 @@ ComPtr<ID3D12QueryHeap> D3D12Device::CreateDXQueryHeap(const D3D12_QUERY_HEAP_DE
     return queryHeap;
 }
 
+/* ----- Shared descriptor heaps ----- */
+
+/*
+Shader-visible CBV/SRV/UAV heaps are limited to 1,000,000 descriptors with resource binding tier 1 and sampler heaps to 2048 descriptors.
+Pages are small enough so each command allocator of all recording threads can hold its own pages.
+*/
+static const UINT g_sharedCbvSrvUavNumPages     = 256;
+static const UINT g_sharedCbvSrvUavPageSize     = 1024;
+static const UINT g_sharedSamplerNumPages       = 64;
+static const UINT g_sharedSamplerPageSize       = 32;
+
+void D3D12Device::CreateSharedDescriptorHeaps()
+{
+    sharedDescriptorHeaps_[0].Create(device_.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, g_sharedCbvSrvUavNumPages, g_sharedCbvSrvUavPageSize);
+    sharedDescriptorHeaps_[1].Create(device_.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     g_sharedSamplerNumPages,   g_sharedSamplerPageSize  );
+}
+
+D3D12SharedDescriptorHeap& D3D12Device::GetSharedDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type)
+{
+    return sharedDescriptorHeaps_[type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? 1 : 0];
+}
+
+/* ----- Tuning ----- */
+
+void D3D12Device::SetTuningProfile(const VendorTuningProfile& tuningProfile)
+{
+    tuningProfile_ = tuningProfile;
+}
+
 /* ----- Data queries ----- */
 
 DXGI_SAMPLE_DESC D3D12Device::FindSuitableSampleDesc(DXGI_FORMAT format, UINT maxSampleCount) const
@@ -9,7 +9,11 @@
 #define LLGL_D3D12_DEVICE_H
 
 
+#include "RenderState/D3D12SharedDescriptorHeap.h"
+#include "D3D12TileHeapPool.h"
+#include "D3D12MemoryAllocator.h"
 #include "../DXCommon/ComPtr.h"
+#include "../../Core/VendorTuning.h"
 #include <d3d12.h>
 #include <dxgi1_4.h>
 #include <vector>
@@ -34,8 +38,50 @@ class D3D12Device
         ComPtr<ID3D12GraphicsCommandList>   CreateDXCommandList             (D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* commandAllocator);
         ComPtr<ID3D12PipelineState>         CreateDXGraphicsPipelineState   (const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
         ComPtr<ID3D12PipelineState>         CreateDXComputePipelineState    (const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc);
+        ComPtr<ID3D12PipelineState>         CreateDXPipelineStateFromStream (const D3D12_PIPELINE_STATE_STREAM_DESC& desc);
         ComPtr<ID3D12QueryHeap>             CreateDXQueryHeap               (const D3D12_QUERY_HEAP_DESC& desc);
 
+        /* ----- Shared descriptor heaps ----- */
+
+        // Creates the shader-visible descriptor heaps that are shared across all command contexts of this device.
+        void CreateSharedDescriptorHeaps();
+
+        // Returns the shared shader-visible descriptor heap for either D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV or D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER.
+        D3D12SharedDescriptorHeap& GetSharedDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type);
+
+        /* ----- Tiled resources ----- */
+
+        // Returns the pool of tile heaps that provide the memory for all reserved resources of this device.
+        inline D3D12TileHeapPool& GetTileHeapPool()
+        {
+            return tileHeapPool_;
+        }
+
+        /* ----- Placed resources ----- */
+
+        // Returns the allocator that provides the memory for all placed buffers and textures of this device.
+        inline D3D12MemoryAllocator& GetMemoryAllocator()
+        {
+            return memoryAllocator_;
+        }
+
+        // Returns the heap type for resources the CPU writes to and the GPU reads from. This is D3D12_HEAP_TYPE_GPU_UPLOAD on systems with Resizable BAR.
+        inline D3D12_HEAP_TYPE GetUploadHeapType() const
+        {
+            return uploadHeapType_;
+        }
+
+        /* ----- Tuning ----- */
+
+        // Sets the tuning profile with all overrides from the renderer configuration applied. This must be called before any command queue is created.
+        void SetTuningProfile(const VendorTuningProfile& tuningProfile);
+
+        // Returns the tuning profile for the vendor of the adapter this device was created with.
+        inline const VendorTuningProfile& GetTuningProfile() const
+        {
+            return tuningProfile_;
+        }
+
         /* ----- Data queries ----- */
 
         // Returns a suitable sample descriptor for the specified format.
@@ -74,11 +120,16 @@ class D3D12Device
 
     private:
 
-        ComPtr<ID3D12Device>    device_;
-        D3D_FEATURE_LEVEL       featureLevel_   = D3D_FEATURE_LEVEL_9_1;
+        ComPtr<ID3D12Device>        device_;
+        D3D_FEATURE_LEVEL           featureLevel_   = D3D_FEATURE_LEVEL_9_1;
+        D3D12SharedDescriptorHeap   sharedDescriptorHeaps_[2];  // CBV_SRV_UAV and SAMPLER heaps
+        D3D12TileHeapPool           tileHeapPool_;
+        D3D12MemoryAllocator        memoryAllocator_;
+        D3D12_HEAP_TYPE             uploadHeapType_ = D3D12_HEAP_TYPE_UPLOAD;
+        VendorTuningProfile         tuningProfile_;
 
         #ifdef LLGL_DEBUG
-        ComPtr<ID3D12InfoQueue> infoQueue_;
+        ComPtr<ID3D12InfoQueue>     infoQueue_;
         #endif
 
 };
@@ -0,0 +1,365 @@
+/*
+ * D3D12MemoryAllocator.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "D3D12MemoryAllocator.h"
+#include "D3DX12/d3dx12.h"
+#include "../DXCommon/DXCore.h"
+#include "../../Core/Assertion.h"
+#include <LLGL/Utils/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+constexpr UINT      D3D12MemoryAllocation::invalidHeapIndex;
+constexpr UINT64    D3D12MemoryAllocator::heapSize;
+constexpr UINT64    D3D12MemoryAllocator::maxPlacedResourceSize;
+
+// Returns true if the specified heap type resides in video memory.
+static bool IsDeviceLocalHeapType(D3D12_HEAP_TYPE type)
+{
+    #ifdef LLGL_D3D12_ENABLE_GPU_UPLOAD_HEAP
+    if (type == D3D12_HEAP_TYPE_GPU_UPLOAD)
+        return true;
+    #endif
+    return (type == D3D12_HEAP_TYPE_DEFAULT);
+}
+
+void D3D12MemoryAllocator::InitializeDevice(ID3D12Device* device)
+{
+    device_ = device;
+    if (FAILED(device->QueryInterface(IID_PPV_ARGS(device1_.ReleaseAndGetAddressOf()))))
+        device1_.Reset();
+}
+
+HRESULT D3D12MemoryAllocator::CreateResource(
+    D3D12_HEAP_TYPE             heapType,
+    const D3D12_RESOURCE_DESC&  desc,
+    D3D12_RESOURCE_STATES       initialState,
+    const D3D12_CLEAR_VALUE*    optimizedClearValue,
+    ID3D12Resource**            outResource,
+    D3D12MemoryAllocation&      outAllocation,
+    bool                        shared)
+{
+    LLGL_ASSERT_PTR(device_);
+
+    outAllocation = D3D12MemoryAllocation{};
+
+    const D3D12_HEAP_FLAGS category = (shared ? D3D12_HEAP_FLAG_NONE : SelectHeapCategory(desc));
+    if (category != D3D12_HEAP_FLAG_NONE)
+    {
+        /* Query size and alignment of the placed resource; the descriptor is modified if the small placement alignment is accepted */
+        D3D12_RESOURCE_DESC placedDesc = desc;
+        const D3D12_RESOURCE_ALLOCATION_INFO allocInfo = GetAllocationInfo(placedDesc);
+
+        if (allocInfo.SizeInBytes <= D3D12MemoryAllocator::maxPlacedResourceSize)
+        {
+            std::lock_guard<std::mutex> guard{ heapsMutex_ };
+            if (AllocFromPool(heapType, category, allocInfo, outAllocation))
+            {
+                HRESULT hr = device_->CreatePlacedResource(
+                    heaps_[outAllocation.heapIndex].native.Get(),
+                    outAllocation.offset,
+                    &placedDesc,
+                    initialState,
+                    optimizedClearValue,
+                    IID_PPV_ARGS(outResource)
+                );
+                if (SUCCEEDED(hr))
+                    return hr;
+
+                /* Return memory region and fall back to a committed resource */
+                FreeInHeap(heaps_[outAllocation.heapIndex], outAllocation.offset, outAllocation.size);
+                outAllocation = D3D12MemoryAllocation{};
+            }
+        }
+    }
+
+    /* Create committed resource with its own implicit heap */
+    return device_->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(heapType),
+        (shared ? D3D12_HEAP_FLAG_SHARED : D3D12_HEAP_FLAG_NONE),
+        &desc,
+        initialState,
+        optimizedClearValue,
+        IID_PPV_ARGS(outResource)
+    );
+}
+
+void D3D12MemoryAllocator::Free(D3D12MemoryAllocation& allocation)
+{
+    if (!allocation.IsPlaced())
+        return;
+
+    std::lock_guard<std::mutex> guard{ heapsMutex_ };
+    LLGL_ASSERT(allocation.heapIndex < heaps_.size());
+
+    MemoryHeap& heap = heaps_[allocation.heapIndex];
+    FreeInHeap(heap, allocation.offset, allocation.size);
+
+    /* Reset priority of empty heap, so it doesn't outlive the resources it has been raised for */
+    if (heap.usedSize == 0 && heap.priority != D3D12_RESIDENCY_PRIORITY_NORMAL)
+        SetHeapPriority(heap, D3D12_RESIDENCY_PRIORITY_NORMAL);
+
+    /* Release heap if it's empty, but retain one empty heap per type and category for frequently re-created resources */
+    if (heap.usedSize == 0)
+    {
+        for_range(i, heaps_.size())
+        {
+            if (i != allocation.heapIndex && IsEmptyHeap(heaps_[i]) && heaps_[i].type == heap.type && heaps_[i].category == heap.category)
+            {
+                ReleaseMemoryHeap(allocation.heapIndex);
+                break;
+            }
+        }
+    }
+
+    allocation = D3D12MemoryAllocation{};
+}
+
+bool D3D12MemoryAllocator::SetResidencyPriority(ID3D12Resource* resource, const D3D12MemoryAllocation& allocation, UINT priority)
+{
+    if (!device1_)
+        return false;
+
+    if (allocation.IsPlaced())
+    {
+        /* Placed resources are not pageable on their own, so raise the priority of their heap */
+        std::lock_guard<std::mutex> guard{ heapsMutex_ };
+        LLGL_ASSERT(allocation.heapIndex < heaps_.size());
+        MemoryHeap& heap = heaps_[allocation.heapIndex];
+        if (priority > heap.priority)
+            SetHeapPriority(heap, priority);
+        return true;
+    }
+
+    ID3D12Pageable* pageable = resource;
+    const D3D12_RESIDENCY_PRIORITY residencyPriority = static_cast<D3D12_RESIDENCY_PRIORITY>(priority);
+    return SUCCEEDED(device1_->SetResidencyPriority(1, &pageable, &residencyPriority));
+}
+
+UINT64 D3D12MemoryAllocator::ReleaseRetainedHeaps(UINT64 budget)
+{
+    std::lock_guard<std::mutex> guard{ heapsMutex_ };
+
+    UINT64 releasedSize = 0;
+
+    for_range(i, heaps_.size())
+    {
+        if (IsEmptyHeap(heaps_[i]) && releasedSize + D3D12MemoryAllocator::heapSize <= budget)
+        {
+            releasedSize += D3D12MemoryAllocator::heapSize;
+            ReleaseMemoryHeap(static_cast<UINT>(i));
+        }
+    }
+
+    return releasedSize;
+}
+
+D3D12MemoryDetails D3D12MemoryAllocator::QueryDetails(bool deviceLocal) const
+{
+    std::lock_guard<std::mutex> guard{ heapsMutex_ };
+
+    D3D12MemoryDetails details;
+
+    for (const MemoryHeap& heap : heaps_)
+    {
+        if (heap.native && IsDeviceLocalHeapType(heap.type) == deviceLocal)
+        {
+            details.allocatedSize   += D3D12MemoryAllocator::heapSize;
+            details.usedSize        += heap.usedSize;
+            details.numHeaps        += 1;
+        }
+    }
+
+    return details;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+D3D12_HEAP_FLAGS D3D12MemoryAllocator::SelectHeapCategory(const D3D12_RESOURCE_DESC& desc) const
+{
+    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        return D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+
+    /* Keep RT/DS textures and multi-sampled textures committed; they benefit most from dedicated allocations */
+    const D3D12_RESOURCE_FLAGS attachmentFlags = (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL);
+    if ((desc.Flags & attachmentFlags) != 0 || desc.SampleDesc.Count > 1)
+        return D3D12_HEAP_FLAG_NONE;
+
+    return D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+}
+
+D3D12_RESOURCE_ALLOCATION_INFO D3D12MemoryAllocator::GetAllocationInfo(D3D12_RESOURCE_DESC& desc) const
+{
+    if (desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        /* Small textures can be placed at 4 KB alignment; the device rejects this by returning a different alignment */
+        desc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+        D3D12_RESOURCE_ALLOCATION_INFO allocInfo = device_->GetResourceAllocationInfo(0, 1, &desc);
+        if (allocInfo.Alignment == D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+            return allocInfo;
+    }
+    desc.Alignment = 0;
+    return device_->GetResourceAllocationInfo(0, 1, &desc);
+}
+
+bool D3D12MemoryAllocator::AllocFromPool(D3D12_HEAP_TYPE type, D3D12_HEAP_FLAGS category, const D3D12_RESOURCE_ALLOCATION_INFO& allocInfo, D3D12MemoryAllocation& outAllocation)
+{
+    /* Find heap of the same type and category with enough free space */
+    for_range(i, heaps_.size())
+    {
+        MemoryHeap& heap = heaps_[i];
+        if (heap.native && heap.type == type && heap.category == category && AllocFromHeap(heap, allocInfo, outAllocation.offset))
+        {
+            outAllocation.heapIndex = static_cast<UINT>(i);
+            outAllocation.size      = allocInfo.SizeInBytes;
+            return true;
+        }
+    }
+
+    /* Create new heap; this can only fail if the device is out of memory */
+    const UINT heapIndex = CreateMemoryHeap(type, category);
+    if (heapIndex == D3D12MemoryAllocation::invalidHeapIndex || !AllocFromHeap(heaps_[heapIndex], allocInfo, outAllocation.offset))
+        return false;
+
+    outAllocation.heapIndex = heapIndex;
+    outAllocation.size      = allocInfo.SizeInBytes;
+    return true;
+}
+
+bool D3D12MemoryAllocator::AllocFromHeap(MemoryHeap& heap, const D3D12_RESOURCE_ALLOCATION_INFO& allocInfo, UINT64& outOffset)
+{
+    const UINT64 alignment = (allocInfo.Alignment > 0 ? allocInfo.Alignment : D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+    /* Find first free range that fits the aligned allocation */
+    for (auto it = heap.freeRanges.begin(); it != heap.freeRanges.end(); ++it)
+    {
+        const UINT64 alignedOffset  = (it->offset + alignment - 1) / alignment * alignment;
+        const UINT64 rangeEnd       = it->offset + it->size;
+        if (alignedOffset + allocInfo.SizeInBytes > rangeEnd)
+            continue;
+
+        const UINT64 allocEnd = alignedOffset + allocInfo.SizeInBytes;
+
+        /* Split free range into the alignment padding in front and the remainder behind the allocation */
+        if (alignedOffset > it->offset)
+        {
+            const FreeRange tail{ allocEnd, rangeEnd - allocEnd };
+            it->size = alignedOffset - it->offset;
+            if (tail.size > 0)
+                heap.freeRanges.insert(it + 1, tail);
+        }
+        else if (allocEnd < rangeEnd)
+        {
+            it->offset  = allocEnd;
+            it->size    = rangeEnd - allocEnd;
+        }
+        else
+            heap.freeRanges.erase(it);
+
+        heap.usedSize += allocInfo.SizeInBytes;
+        outOffset = alignedOffset;
+        return true;
+    }
+
+    return false;
+}
+
+void D3D12MemoryAllocator::FreeInHeap(MemoryHeap& heap, UINT64 offset, UINT64 size)
+{
+    LLGL_ASSERT(heap.usedSize >= size);
+    heap.usedSize -= size;
+
+    /* Insert range in sorted order and merge it with its adjacent neighbors */
+    auto it = heap.freeRanges.begin();
+    while (it != heap.freeRanges.end() && it->offset < offset)
+        ++it;
+
+    it = heap.freeRanges.insert(it, FreeRange{ offset, size });
+
+    if (it + 1 != heap.freeRanges.end() && it->offset + it->size == (it + 1)->offset)
+    {
+        it->size += (it + 1)->size;
+        heap.freeRanges.erase(it + 1);
+    }
+
+    if (it != heap.freeRanges.begin() && (it - 1)->offset + (it - 1)->size == it->offset)
+    {
+        (it - 1)->size += it->size;
+        heap.freeRanges.erase(it);
+    }
+}
+
+UINT D3D12MemoryAllocator::CreateMemoryHeap(D3D12_HEAP_TYPE type, D3D12_HEAP_FLAGS category)
+{
+    const CD3DX12_HEAP_DESC heapDesc
+    {
+        D3D12MemoryAllocator::heapSize,
+        type,
+        D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT,
+        category
+    };
+
+    ComPtr<ID3D12Heap> native;
+    if (FAILED(device_->CreateHeap(&heapDesc, IID_PPV_ARGS(native.ReleaseAndGetAddressOf()))))
+        return D3D12MemoryAllocation::invalidHeapIndex;
+
+    /* Re-use slot of a previously released heap to keep all other heap indices valid */
+    UINT heapIndex = 0;
+    while (heapIndex < heaps_.size() && heaps_[heapIndex].native)
+        ++heapIndex;
+
+    if (heapIndex == heaps_.size())
+        heaps_.emplace_back();
+
+    MemoryHeap& heap = heaps_[heapIndex];
+    {
+        heap.native     = std::move(native);
+        heap.type       = type;
+        heap.category   = category;
+        heap.usedSize   = 0;
+        heap.priority   = D3D12_RESIDENCY_PRIORITY_NORMAL;
+        heap.freeRanges = { FreeRange{ 0, D3D12MemoryAllocator::heapSize } };
+    }
+
+    return heapIndex;
+}
+
+void D3D12MemoryAllocator::ReleaseMemoryHeap(UINT heapIndex)
+{
+    MemoryHeap& heap = heaps_[heapIndex];
+    heap.native.Reset();
+    heap.freeRanges.clear();
+}
+
+void D3D12MemoryAllocator::SetHeapPriority(MemoryHeap& heap, UINT priority)
+{
+    if (device1_)
+    {
+        ID3D12Pageable* pageable = heap.native.Get();
+        const D3D12_RESIDENCY_PRIORITY residencyPriority = static_cast<D3D12_RESIDENCY_PRIORITY>(priority);
+        if (SUCCEEDED(device1_->SetResidencyPriority(1, &pageable, &residencyPriority)))
+            heap.priority = priority;
+    }
+}
+
+bool D3D12MemoryAllocator::IsEmptyHeap(const MemoryHeap& heap) const
+{
+    return (heap.native && heap.usedSize == 0);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
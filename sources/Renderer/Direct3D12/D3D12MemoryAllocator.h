@@ -0,0 +1,159 @@
+/*
+ * D3D12MemoryAllocator.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_D3D12_MEMORY_ALLOCATOR_H
+#define LLGL_D3D12_MEMORY_ALLOCATOR_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+// Location of a placed resource within the heaps of the memory allocator. Committed resources have an invalid heap index.
+struct D3D12MemoryAllocation
+{
+    static constexpr UINT invalidHeapIndex = ~0u;
+
+    inline bool IsPlaced() const
+    {
+        return (heapIndex != invalidHeapIndex);
+    }
+
+    UINT    heapIndex   = invalidHeapIndex;
+    UINT64  offset      = 0;
+    UINT64  size        = 0;
+};
+
+// Accumulated memory details of all heaps in either video memory or system memory.
+struct D3D12MemoryDetails
+{
+    UINT64  allocatedSize   = 0;
+    UINT64  usedSize        = 0;
+    UINT    numHeaps        = 0;
+};
+
+/*
+Device-wide allocator that creates buffers and textures as placed resources within pooled ID3D12Heap objects,
+to avoid the overhead of one implicit heap per committed resource.
+Each heap only serves one heap type and one heap category (D3D12_HEAP_FLAG_ALLOW_ONLY_*) to be compatible with resource heap tier 1.
+Large resources, multi-sampled textures, and RT/DS textures are still created as committed resources,
+since the driver can apply dedicated optimizations to them.
+Heap indices remain valid until the device is destroyed; released heaps only leave an empty slot behind.
+*/
+class D3D12MemoryAllocator
+{
+
+    public:
+
+        // Size of each native heap, i.e. 64 MB.
+        static constexpr UINT64 heapSize = 64ull * 1024ull * 1024ull;
+
+        // Resources larger than this are always created as committed resources, i.e. 16 MB.
+        static constexpr UINT64 maxPlacedResourceSize = heapSize / 4;
+
+    public:
+
+        D3D12MemoryAllocator() = default;
+
+        D3D12MemoryAllocator(const D3D12MemoryAllocator&) = delete;
+        D3D12MemoryAllocator& operator = (const D3D12MemoryAllocator&) = delete;
+
+        // Stores the device to create the heaps and resources with.
+        void InitializeDevice(ID3D12Device* device);
+
+        /*
+        Creates either a placed resource within a pooled heap of the specified type or a committed resource.
+        The output allocation must be passed to Free() after the resource has been released.
+        Shared resources are always committed with D3D12_HEAP_FLAG_SHARED, so they can be exported with ID3D12Device::CreateSharedHandle.
+        */
+        HRESULT CreateResource(
+            D3D12_HEAP_TYPE             heapType,
+            const D3D12_RESOURCE_DESC&  desc,
+            D3D12_RESOURCE_STATES       initialState,
+            const D3D12_CLEAR_VALUE*    optimizedClearValue,
+            ID3D12Resource**            outResource,
+            D3D12MemoryAllocation&      outAllocation,
+            bool                        shared              = false
+        );
+
+        // Returns the memory region of a placed resource to its heap and resets the allocation. Committed resources are ignored.
+        void Free(D3D12MemoryAllocation& allocation);
+
+        /*
+        Sets the residency priority of a committed resource or of the heap of a placed resource. Returns false if ID3D12Device1 is not supported.
+        Since heaps are shared between resources, the priority of a heap is only raised and it is reset once the heap is empty.
+        */
+        bool SetResidencyPriority(ID3D12Resource* resource, const D3D12MemoryAllocation& allocation, UINT priority);
+
+        // Releases retained empty heaps up to the specified budget and returns the number of bytes that have been released.
+        UINT64 ReleaseRetainedHeaps(UINT64 budget);
+
+        // Returns the accumulated details of all heaps in either video memory (D3D12_HEAP_TYPE_DEFAULT and D3D12_HEAP_TYPE_GPU_UPLOAD) or system memory.
+        D3D12MemoryDetails QueryDetails(bool deviceLocal) const;
+
+    private:
+
+        struct FreeRange
+        {
+            UINT64 offset;
+            UINT64 size;
+        };
+
+        struct MemoryHeap
+        {
+            ComPtr<ID3D12Heap>      native;
+            D3D12_HEAP_TYPE         type        = D3D12_HEAP_TYPE_DEFAULT;
+            D3D12_HEAP_FLAGS        category    = D3D12_HEAP_FLAG_NONE;
+            UINT64                  usedSize    = 0;
+            UINT                    priority    = D3D12_RESIDENCY_PRIORITY_NORMAL;
+            std::vector<FreeRange>  freeRanges;                             // Sorted by offset; adjacent ranges are always merged
+        };
+
+    private:
+
+        // Returns the heap category for the specified resource or D3D12_HEAP_FLAG_NONE if it must be a committed resource.
+        D3D12_HEAP_FLAGS SelectHeapCategory(const D3D12_RESOURCE_DESC& desc) const;
+
+        // Returns the allocation info for the resource and tries the small placement alignment for textures first.
+        D3D12_RESOURCE_ALLOCATION_INFO GetAllocationInfo(D3D12_RESOURCE_DESC& desc) const;
+
+        bool AllocFromPool(D3D12_HEAP_TYPE type, D3D12_HEAP_FLAGS category, const D3D12_RESOURCE_ALLOCATION_INFO& allocInfo, D3D12MemoryAllocation& outAllocation);
+        bool AllocFromHeap(MemoryHeap& heap, const D3D12_RESOURCE_ALLOCATION_INFO& allocInfo, UINT64& outOffset);
+        void FreeInHeap(MemoryHeap& heap, UINT64 offset, UINT64 size);
+
+        UINT CreateMemoryHeap(D3D12_HEAP_TYPE type, D3D12_HEAP_FLAGS category);
+        void ReleaseMemoryHeap(UINT heapIndex);
+
+        // Sets the residency priority of the specified heap and stores it on success. Caller must hold the heaps mutex.
+        void SetHeapPriority(MemoryHeap& heap, UINT priority);
+
+        bool IsEmptyHeap(const MemoryHeap& heap) const;
+
+    private:
+
+        ID3D12Device*               device_         = nullptr;
+        ComPtr<ID3D12Device1>       device1_;                           // Only for residency priorities; null if not supported
+        std::vector<MemoryHeap>     heaps_;
+        mutable std::mutex          heapsMutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
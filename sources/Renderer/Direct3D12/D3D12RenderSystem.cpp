@@ -12,22 +12,28 @@
 #include "../DXCommon/DXCore.h"
 #include "../TextureUtils.h"
 #include "../CheckedCast.h"
+#include "../RenderSystemUtils.h"
+#include "../FileLoadUtils.h"
 #include "../../Core/Vendor.h"
 #include "../../Core/CoreUtils.h"
 #include "../../Core/Assertion.h"
 #include "D3DX12/d3dx12.h"
 #include <LLGL/Utils/ForRange.h>
+#include <LLGL/Container/SmallVector.h>
 #include <limits.h>
 #include <codecvt>
+#include <dxgi1_5.h>
 
 #include "Buffer/D3D12Buffer.h"
 #include "Buffer/D3D12BufferArray.h"
 #include "Buffer/D3D12BufferConstantsPool.h"
 
 #include "Texture/D3D12MipGenerator.h"
+#include "Shader/D3D12DXCompiler.h"
 
 #include "RenderState/D3D12GraphicsPSO.h"
 #include "RenderState/D3D12ComputePSO.h"
+#include "../HostTrace.h"
 
 #include <LLGL/Backend/Direct3D12/NativeHandle.h>
 
@@ -36,7 +42,8 @@ namespace LLGL
 {
 
 
-D3D12RenderSystem::D3D12RenderSystem(const RenderSystemDescriptor& renderSystemDesc)
+D3D12RenderSystem::D3D12RenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
+    breadcrumbsEnabled_ { ((renderSystemDesc.flags & RenderSystemFlags::GPUBreadcrumbs) != 0) }
 {
     const bool debugDevice = ((renderSystemDesc.flags & RenderSystemFlags::DebugDevice) != 0);
     if (debugDevice)
@@ -45,7 +52,11 @@ D3D12RenderSystem::D3D12RenderSystem(const RenderSystemDescriptor& renderSystemD
     /* Create DXGU factory 1.4, query video adapters, and create D3D12 device */
     CreateFactory(debugDevice);
     QueryVideoAdapters();
-    CreateDevice();
+    CreateDevice(FindSelectedVideoAdapter(renderSystemDesc, videoAdatperDescs_));
+
+    /* Select tuning profile before the command queue allocates its staging buffers */
+    auto rendererConfigD3D = GetRendererConfiguration<RendererConfigurationDirect3D12>(renderSystemDesc);
+    SelectTuningProfile(rendererConfigD3D);
 
     /* Create command queue interface */
     commandQueue_   = MakeUnique<D3D12CommandQueue>(device_);
@@ -55,9 +66,23 @@ D3D12RenderSystem::D3D12RenderSystem(const RenderSystemDescriptor& renderSystemD
     defaultPipelineLayout_.CreateRootSignature(device_.GetNative(), {});
     cmdSignatureFactory_.CreateDefaultSignatures(device_.GetNative());
 
-    stagingBufferPool_.InitializeDevice(device_.GetNative(), 0);
+    /* Open pipeline library to cache PSOs across multiple runs */
+    if (rendererConfigD3D != nullptr && rendererConfigD3D->pipelineLibraryEnabled)
+    {
+        pipelineLibrary_.Create(
+            device_.GetNative(),
+            rendererConfigD3D->pipelineLibraryData.data(),
+            rendererConfigD3D->pipelineLibraryData.size()
+        );
+    }
+
+    /* Enable shader cache to skip HLSL compilation on subsequent runs */
+    if (rendererConfigD3D != nullptr)
+        shaderCache_.SetDirectory(rendererConfigD3D->shaderCachePath);
+
+    stagingBufferPool_.InitializeDevice(device_.GetNative(), device_.GetTuningProfile().stagingChunkSize, device_.GetUploadHeapType());
     D3D12MipGenerator::Get().InitializeDevice(device_.GetNative());
-    D3D12BufferConstantsPool::Get().InitializeDevice(device_.GetNative(), *commandContext_, stagingBufferPool_);
+    D3D12BufferConstantsPool::Get().InitializeDevice(device_.GetNative(), *commandContext_, device_.GetUploadHeapType());
 
     /* Initialize renderer information */
     QueryRendererInfo();
@@ -80,6 +105,7 @@ D3D12RenderSystem::~D3D12RenderSystem()
     /* Clear resources of singletons */
     D3D12MipGenerator::Get().Clear();
     D3D12BufferConstantsPool::Get().Clear();
+    D3D12DXCompiler::Get().Clear();
 }
 
 /* ----- Swap-chain ----- */
@@ -96,9 +122,25 @@ void D3D12RenderSystem::Release(SwapChain& swapChain)
 
 /* ----- Command queues ----- */
 
-CommandQueue* D3D12RenderSystem::GetCommandQueue()
+CommandQueue* D3D12RenderSystem::GetCommandQueue(const CommandQueueType type)
 {
-    return commandQueue_.get();
+    switch (type)
+    {
+        case CommandQueueType::Compute:
+            /* Create asynchronous compute queue on first request */
+            if (!computeQueue_)
+                computeQueue_ = MakeUnique<D3D12CommandQueue>(device_, D3D12_COMMAND_LIST_TYPE_COMPUTE);
+            return computeQueue_.get();
+
+        case CommandQueueType::Copy:
+            /* Create copy queue on first request */
+            if (!copyQueue_)
+                copyQueue_ = MakeUnique<D3D12CommandQueue>(device_, D3D12_COMMAND_LIST_TYPE_COPY);
+            return copyQueue_.get();
+
+        default:
+            return commandQueue_.get();
+    }
 }
 
 /* ----- Command buffers ----- */
@@ -119,12 +161,61 @@ void D3D12RenderSystem::Release(CommandBuffer& commandBuffer)
 Buffer* D3D12RenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
 {
     RenderSystem::AssertCreateBuffer(bufferDesc, ULLONG_MAX);
-    D3D12Buffer* bufferD3D = buffers_.emplace<D3D12Buffer>(device_.GetNative(), bufferDesc);
-    if (initialData != nullptr)
+    D3D12Buffer* bufferD3D = buffers_.emplace<D3D12Buffer>(device_.GetNative(), device_.GetMemoryAllocator(), bufferDesc, device_.GetUploadHeapType());
+    if ((bufferDesc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        /* Reserved buffers have no memory until tiles are mapped, so initial data is ignored */
+        bufferD3D->CreateTileMapper(device_.GetTileHeapPool());
+    }
+    else if (initialData != nullptr)
         UpdateBufferAndSync(*bufferD3D, 0, initialData, bufferDesc.size, bufferD3D->GetAlignment());
     return bufferD3D;
 }
 
+void D3D12RenderSystem::CreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, const void* const * initialData, Buffer** outBuffers)
+{
+    RenderSystem::AssertCreateBuffers(numBuffers, bufferDescs, outBuffers);
+
+    /* Create all buffers first, so resource creation is not serialized with the command context */
+    bool hasInitialData = false;
+
+    for_range(i, numBuffers)
+    {
+        const BufferDescriptor& bufferDesc = bufferDescs[i];
+        RenderSystem::AssertCreateBuffer(bufferDesc, ULLONG_MAX);
+        D3D12Buffer* bufferD3D = buffers_.emplace<D3D12Buffer>(device_.GetNative(), device_.GetMemoryAllocator(), bufferDesc, device_.GetUploadHeapType());
+        if ((bufferDesc.miscFlags & MiscFlags::Sparse) != 0)
+        {
+            /* Reserved buffers have no memory until tiles are mapped, so initial data is ignored */
+            bufferD3D->CreateTileMapper(device_.GetTileHeapPool());
+        }
+        else if (initialData != nullptr && initialData[i] != nullptr)
+            hasInitialData = true;
+        outBuffers[i] = bufferD3D;
+    }
+
+    if (hasInitialData)
+    {
+        /* Write initial data of all buffers into the shared staging ring, then execute all copy commands with a single submission */
+        std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
+        for_range(i, numBuffers)
+        {
+            if ((bufferDescs[i].miscFlags & MiscFlags::Sparse) == 0 && initialData[i] != nullptr)
+            {
+                auto* bufferD3D = LLGL_CAST(D3D12Buffer*, outBuffers[i]);
+                if (bufferD3D->IsHostVisible())
+                {
+                    HRESULT hr = bufferD3D->WriteHostVisible(0, initialData[i], bufferDescs[i].size);
+                    DXThrowIfFailed(hr, "failed to map D3D12 host-visible buffer");
+                }
+                else
+                    commandContext_->UpdateSubresource(bufferD3D->GetResource(), 0, initialData[i], bufferDescs[i].size, bufferD3D->GetAlignment());
+            }
+        }
+        commandContext_->Finish(true);
+    }
+}
+
 BufferArray* D3D12RenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
     RenderSystem::AssertCreateBufferArray(numBuffers, bufferArray);
@@ -152,6 +243,16 @@ void D3D12RenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const
 void D3D12RenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+
+    if (bufferD3D.IsHostVisible())
+    {
+        /* Read from upload or readback heap buffer directly */
+        HRESULT hr = bufferD3D.ReadHostVisible(offset, data, dataSize);
+        DXThrowIfFailed(hr, "failed to map D3D12 host-visible buffer");
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
     stagingBufferPool_.ReadSubresourceRegion(*commandContext_, bufferD3D.GetResource(), offset, data, dataSize);
     /* No ExecuteCommandListAndSync() here as it has already been flushed by the staging buffer pool */
 }
@@ -171,6 +272,7 @@ void* D3D12RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::
 void D3D12RenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
     bufferD3D.Unmap(*commandContext_);
 }
 
@@ -178,9 +280,14 @@ void D3D12RenderSystem::UnmapBuffer(Buffer& buffer)
 
 Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
-    auto* textureD3D = textures_.emplace<D3D12Texture>(device_.GetNative(), textureDesc);
+    auto* textureD3D = textures_.emplace<D3D12Texture>(device_.GetNative(), device_.GetMemoryAllocator(), textureDesc);
 
-    if (imageDesc != nullptr)
+    if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        /* Reserved textures have no memory until tiles are mapped, so initial data is ignored */
+        textureD3D->CreateTileMapper(device_.GetTileHeapPool(), commandQueue_->GetNative());
+    }
+    else if (imageDesc != nullptr)
     {
         /* Update base MIP-map */
         TextureRegion region;
@@ -188,6 +295,7 @@ Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
             region.subresource.numArrayLayers   = textureDesc.arrayLayers;
             region.extent                       = textureDesc.extent;
         }
+        std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
         D3D12SubresourceContext subresourceContext{ *commandContext_ };
         UpdateTextureSubresourceFromImage(*textureD3D, region, *imageDesc, subresourceContext);
 
@@ -199,6 +307,60 @@ Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
     return textureD3D;
 }
 
+void D3D12RenderSystem::CreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, const SrcImageDescriptor* const * imageDescs, Texture** outTextures)
+{
+    RenderSystem::AssertCreateTextures(numTextures, textureDescs, outTextures);
+
+    /* Create all textures first, so resource creation is not serialized with the command context */
+    bool hasInitialData = false;
+
+    for_range(i, numTextures)
+    {
+        const TextureDescriptor& textureDesc = textureDescs[i];
+        auto* textureD3D = textures_.emplace<D3D12Texture>(device_.GetNative(), device_.GetMemoryAllocator(), textureDesc);
+        if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0)
+        {
+            /* Reserved textures have no memory until tiles are mapped, so initial data is ignored */
+            textureD3D->CreateTileMapper(device_.GetTileHeapPool(), commandQueue_->GetNative());
+        }
+        else if (imageDescs != nullptr && imageDescs[i] != nullptr)
+            hasInitialData = true;
+        outTextures[i] = textureD3D;
+    }
+
+    if (hasInitialData)
+    {
+        /* Record all uploads and MIP-map generations; they are executed with a single submission when the subresource context goes out of scope */
+        std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
+        D3D12SubresourceContext subresourceContext{ *commandContext_ };
+        SmallVector<D3D12Texture*, 16> mipTextures;
+
+        for_range(i, numTextures)
+        {
+            const TextureDescriptor& textureDesc = textureDescs[i];
+            if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0 || imageDescs[i] == nullptr)
+                continue;
+
+            auto* textureD3D = LLGL_CAST(D3D12Texture*, outTextures[i]);
+
+            /* Update base MIP-map */
+            TextureRegion region;
+            {
+                region.subresource.numArrayLayers   = textureDesc.arrayLayers;
+                region.extent                       = textureDesc.extent;
+            }
+            UpdateTextureSubresourceFromImage(*textureD3D, region, *imageDescs[i], subresourceContext);
+
+            if (MustGenerateMipsOnCreate(textureDesc))
+                mipTextures.push_back(textureD3D);
+        }
+
+        /* Generate MIP-maps of all textures at once, so their dispatches share barriers */
+        if (!mipTextures.empty())
+            D3D12MipGenerator::Get().GenerateMips(*commandContext_, static_cast<std::uint32_t>(mipTextures.size()), mipTextures.data());
+    }
+}
+
 void D3D12RenderSystem::Release(Texture& texture)
 {
     SyncGPU();
@@ -207,9 +369,12 @@ void D3D12RenderSystem::Release(Texture& texture)
 
 void D3D12RenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("WriteTexture");
+
     auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
 
     /* Execute upload commands and wait for GPU to finish execution */
+    std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
     D3D12SubresourceContext subresourceContext{ *commandContext_ };
     UpdateTextureSubresourceFromImage(textureD3D, textureRegion, imageDesc, subresourceContext);
 }
@@ -227,6 +392,7 @@ void D3D12RenderSystem::ReadTexture(Texture& texture, const TextureRegion& textu
     ComPtr<ID3D12Resource> readbackBuffer;
     UINT rowStride = 0, layerSize = 0, layerStride = 0;
     {
+        std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
         D3D12SubresourceContext subresourceContext{ *commandContext_ };
         textureD3D.CreateSubresourceCopyAsReadbackBuffer(subresourceContext, textureRegion, texturePlane, rowStride, layerSize, layerStride);
         readbackBuffer = subresourceContext.TakeResource();
@@ -276,7 +442,7 @@ void D3D12RenderSystem::ReadTexture(Texture& texture, const TextureRegion& textu
 
 Sampler* D3D12RenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    return samplers_.emplace<D3D12Sampler>(samplerDesc);
+    return samplers_.emplace<D3D12Sampler>(samplerCache_, samplerDesc);
 }
 
 void D3D12RenderSystem::Release(Sampler& sampler)
@@ -334,8 +500,10 @@ void D3D12RenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* D3D12RenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateShader");
+
     RenderSystem::AssertCreateShader(shaderDesc);
-    return shaders_.emplace<D3D12Shader>(shaderDesc);
+    return shaders_.emplace<D3D12Shader>(shaderDesc, shaderCache_);
 }
 
 void D3D12RenderSystem::Release(Shader& shader)
@@ -360,6 +528,8 @@ void D3D12RenderSystem::Release(PipelineLayout& pipelineLayout)
 
 PipelineState* D3D12RenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
+    LLGL_HOST_TRACE_SCOPE("CreatePipelineState");
+
     Serialization::Deserializer reader{ serializedCache };
 
     /* Read type of PSO */
@@ -382,6 +552,8 @@ PipelineState* D3D12RenderSystem::CreatePipelineState(const Blob& serializedCach
 
 PipelineState* D3D12RenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* serializedCache)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineState");
+
     Serialization::Serializer writer;
 
     D3D12GraphicsPSO* pipelineState = pipelineStates_.emplace<D3D12GraphicsPSO>(
@@ -389,7 +561,8 @@ PipelineState* D3D12RenderSystem::CreatePipelineState(const GraphicsPipelineDesc
         defaultPipelineLayout_,
         pipelineStateDesc,
         GetDefaultRenderPass(),
-        (serializedCache != nullptr ? &writer : nullptr)
+        (serializedCache != nullptr ? &writer : nullptr),
+        GetPipelineLibrary()
     );
 
     if (serializedCache != nullptr)
@@ -400,7 +573,39 @@ PipelineState* D3D12RenderSystem::CreatePipelineState(const GraphicsPipelineDesc
 
 PipelineState* D3D12RenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
 {
-    return pipelineStates_.emplace<D3D12ComputePSO>(device_, defaultPipelineLayout_, pipelineStateDesc);
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineState");
+
+    return pipelineStates_.emplace<D3D12ComputePSO>(device_, defaultPipelineLayout_, pipelineStateDesc, GetPipelineLibrary());
+}
+
+PipelineState* D3D12RenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState)
+{
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineStateAsync");
+
+    return pipelineStates_.emplace<D3D12GraphicsPSO>(
+        device_,
+        defaultPipelineLayout_,
+        pipelineStateDesc,
+        GetDefaultRenderPass(),
+        /*writer:*/ nullptr,
+        GetPipelineLibrary(),
+        /*isAsync:*/ true,
+        fallbackPipelineState
+    );
+}
+
+PipelineState* D3D12RenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState)
+{
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineStateAsync");
+
+    return pipelineStates_.emplace<D3D12ComputePSO>(
+        device_,
+        defaultPipelineLayout_,
+        pipelineStateDesc,
+        GetPipelineLibrary(),
+        /*isAsync:*/ true,
+        fallbackPipelineState
+    );
 }
 
 void D3D12RenderSystem::Release(PipelineState& pipelineState)
@@ -422,6 +627,23 @@ void D3D12RenderSystem::Release(QueryHeap& queryHeap)
     queryHeaps_.erase(&queryHeap);
 }
 
+/* ----- Acceleration structures ----- */
+
+AccelerationStructure* D3D12RenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& accelerationStructureDesc)
+{
+    /* Prebuild info for acceleration structures requires ID3D12Device5 */
+    ComPtr<ID3D12Device5> device5;
+    if (!GetRenderingCaps().features.hasRayTracing || FAILED(device_.GetNative()->QueryInterface(IID_PPV_ARGS(device5.GetAddressOf()))))
+        LLGL_TRAP_FEATURE_NOT_SUPPORTED("acceleration structures");
+    return accelStructs_.emplace<D3D12AccelerationStructure>(device5.Get(), accelerationStructureDesc);
+}
+
+void D3D12RenderSystem::Release(AccelerationStructure& accelerationStructure)
+{
+    SyncGPU();
+    accelStructs_.erase(&accelerationStructure);
+}
+
 /* ----- Fences ----- */
 
 Fence* D3D12RenderSystem::CreateFence()
@@ -449,6 +671,114 @@ bool D3D12RenderSystem::GetNativeHandle(void* nativeHandle, std::size_t nativeHa
     return false;
 }
 
+std::uint64_t D3D12RenderSystem::ReleaseRetainedMemory(std::uint64_t budget)
+{
+    std::uint64_t releasedSize = device_.GetMemoryAllocator().ReleaseRetainedHeaps(budget);
+
+    /* Release staging memory of the internal command context, e.g. after large resource uploads during a loading screen */
+    if (releasedSize < budget)
+    {
+        releasedSize += commandContext_->TrimMemory();
+        releasedSize += stagingBufferPool_.Trim(commandContext_->GetNextFenceValue() - 1);
+    }
+
+    return releasedSize;
+}
+
+bool D3D12RenderSystem::QueryMemoryStatistics(MemoryStatistics& outStatistics)
+{
+    /* Find adapter the device was created with, since D3D12 devices don't implement IDXGIDevice */
+    ComPtr<IDXGIAdapter> adapter;
+    if (FAILED(factory_->EnumAdapterByLuid(GetDXDevice()->GetAdapterLuid(), IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()))) ||
+        !DXQueryVideoMemoryInfo(adapter.Get(), outStatistics))
+    {
+        outStatistics.heaps.clear();
+        return false;
+    }
+
+    /* Add details of the pooled heaps for placed resources */
+    for (MemoryHeapStatistics& heap : outStatistics.heaps)
+    {
+        const D3D12MemoryDetails details = device_.GetMemoryAllocator().QueryDetails(heap.deviceLocal);
+        heap.allocatedSize  = details.allocatedSize;
+        heap.usedSize       = details.usedSize;
+        heap.numChunks      = details.numHeaps;
+    }
+
+    return true;
+}
+
+bool D3D12RenderSystem::SetMemoryPriority(Resource& resource, float priority)
+{
+    D3D12MemoryAllocator& memoryAllocator = device_.GetMemoryAllocator();
+    const UINT residencyPriority = DXGetResidencyPriority(priority);
+
+    if (resource.GetResourceType() == ResourceType::Buffer)
+    {
+        auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
+        return memoryAllocator.SetResidencyPriority(bufferD3D.GetNative(), bufferD3D.GetAllocation(), residencyPriority);
+    }
+    else if (resource.GetResourceType() == ResourceType::Texture)
+    {
+        auto& textureD3D = LLGL_CAST(D3D12Texture&, resource);
+        return memoryAllocator.SetResidencyPriority(textureD3D.GetNative(), textureD3D.GetAllocation(), residencyPriority);
+    }
+
+    return false;
+}
+
+Blob D3D12RenderSystem::GetPipelineCache()
+{
+    return pipelineLibrary_.Serialize();
+}
+
+// Creates a new shared NT handle for the specified D3D12 object and writes it into the output handle.
+static bool ExportD3D12SharedHandle(ID3D12Device* device, ID3D12DeviceChild* object, ExternalHandleType type, UINT64 size, ExternalHandle& outHandle)
+{
+    HANDLE sharedHandle = nullptr;
+    if (FAILED(device->CreateSharedHandle(object, nullptr, GENERIC_ALL, nullptr, &sharedHandle)))
+        return false;
+
+    outHandle.type      = type;
+    outHandle.handle    = reinterpret_cast<std::intptr_t>(sharedHandle);
+    outHandle.size      = size;
+    return true;
+}
+
+bool D3D12RenderSystem::ExportMemoryHandle(Resource& resource, ExternalHandle& outHandle)
+{
+    ID3D12Resource* nativeResource = nullptr;
+
+    if (resource.GetResourceType() == ResourceType::Buffer)
+        nativeResource = LLGL_CAST(D3D12Buffer&, resource).GetNative();
+    else if (resource.GetResourceType() == ResourceType::Texture)
+        nativeResource = LLGL_CAST(D3D12Texture&, resource).GetNative();
+    else
+        return false;
+
+    /* Only committed resources in a shared heap can be exported, i.e. resources that were created with MiscFlags::External */
+    D3D12_HEAP_PROPERTIES heapProperties;
+    D3D12_HEAP_FLAGS heapFlags = D3D12_HEAP_FLAG_NONE;
+    if (FAILED(nativeResource->GetHeapProperties(&heapProperties, &heapFlags)) || (heapFlags & D3D12_HEAP_FLAG_SHARED) == 0)
+        return false;
+
+    const D3D12_RESOURCE_DESC resourceDesc = nativeResource->GetDesc();
+    const D3D12_RESOURCE_ALLOCATION_INFO allocInfo = device_.GetNative()->GetResourceAllocationInfo(0, 1, &resourceDesc);
+
+    return ExportD3D12SharedHandle(device_.GetNative(), nativeResource, ExternalHandleType::D3D12Resource, allocInfo.SizeInBytes, outHandle);
+}
+
+bool D3D12RenderSystem::ExportFenceHandle(Fence& fence, ExternalHandle& outHandle)
+{
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+    return ExportD3D12SharedHandle(device_.GetNative(), fenceD3D.GetNative(), ExternalHandleType::D3D12Fence, 0, outHandle);
+}
+
+bool D3D12RenderSystem::SubmitFileLoads(const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    return SubmitFileLoadsEmulated(*this, loads, fence);
+}
+
 
 /*
  * ======= Internal: =======
@@ -466,6 +796,10 @@ ComPtr<IDXGISwapChain1> D3D12RenderSystem::CreateDXSwapChain(const DXGI_SWAP_CHA
 
 void D3D12RenderSystem::SyncGPU()
 {
+    if (computeQueue_)
+        computeQueue_->WaitIdle();
+    if (copyQueue_)
+        copyQueue_->WaitIdle();
     commandQueue_->WaitIdle();
 }
 
@@ -496,6 +830,15 @@ void D3D12RenderSystem::CreateFactory(bool debugDevice)
     else
         hr = CreateDXGIFactory1(IID_PPV_ARGS(factory_.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create DXGI factor 1.4");
+
+    /* Query support for tearing, which requires DXGI factory 1.5 */
+    ComPtr<IDXGIFactory5> factory5;
+    if (SUCCEEDED(factory_.As(&factory5)))
+    {
+        BOOL allowTearing = FALSE;
+        if (SUCCEEDED(factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing))))
+            tearingSupported_ = (allowTearing != FALSE);
+    }
 }
 
 void D3D12RenderSystem::QueryVideoAdapters()
@@ -510,34 +853,63 @@ void D3D12RenderSystem::QueryVideoAdapters()
     }
 }
 
-void D3D12RenderSystem::CreateDevice()
+void D3D12RenderSystem::CreateDevice(std::uint32_t adapterIndex)
 {
-    /* Use default adapter (null) and try all feature levels */
+    /* Try all feature levels */
     auto featureLevels = DXGetFeatureLevels(D3D_FEATURE_LEVEL_12_1);
 
-    /* Try to create a feature level with an hardware adapter */
     HRESULT hr = 0;
-    if (!device_.CreateDXDevice(hr, nullptr, featureLevels))
+    if (adapterIndex != Constants::defaultAdapter)
+    {
+        /* Create device with explicitly selected adapter; don't fall back to another one */
+        ComPtr<IDXGIAdapter> adapter;
+        hr = factory_->EnumAdapters(adapterIndex, adapter.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to enumerate selected DXGI adapter");
+        if (!device_.CreateDXDevice(hr, adapter.Get(), featureLevels))
+            DXThrowIfFailed(hr, "failed to create D3D12 device with selected adapter");
+    }
+    else if (!device_.CreateDXDevice(hr, nullptr, featureLevels))
     {
-        /* Use software adapter as fallback */
+        /* Use software adapter as fallback if the default hardware adapter (null) failed */
         ComPtr<IDXGIAdapter> adapter;
         factory_->EnumWarpAdapter(IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()));
         if (!device_.CreateDXDevice(hr, adapter.Get(), featureLevels))
             DXThrowIfFailed(hr, "failed to create D3D12 device");
     }
+
+    /* Create shader-visible descriptor heaps that are shared across all command contexts */
+    device_.CreateSharedDescriptorHeaps();
+}
+
+void D3D12RenderSystem::SelectTuningProfile(const RendererConfigurationDirect3D12* config)
+{
+    /* Find adapter the device was created with, since D3D12 devices don't implement IDXGIDevice */
+    DeviceVendor vendor = DeviceVendor::Undefined;
+
+    ComPtr<IDXGIAdapter> adapter;
+    DXGI_ADAPTER_DESC adapterDesc;
+    if (SUCCEEDED(factory_->EnumAdapterByLuid(GetDXDevice()->GetAdapterLuid(), IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()))) && SUCCEEDED(adapter->GetDesc(&adapterDesc)))
+        vendor = GetVendorByID(static_cast<std::uint16_t>(adapterDesc.VendorId));
+
+    VendorTuningProfile profile = GetVendorTuningProfile(vendor);
+    if (config != nullptr)
+        profile.stagingChunkSize = GetTuningSize(config->stagingChunkSize, profile.stagingChunkSize);
+
+    device_.SetTuningProfile(profile);
 }
 
 static bool FindHighestShaderModel(ID3D12Device* device, D3D_SHADER_MODEL& shaderModel)
 {
     D3D12_FEATURE_DATA_SHADER_MODEL feature;
 
-    for (auto model : { D3D_SHADER_MODEL_6_0, D3D_SHADER_MODEL_5_1 })
+    /* The runtime fails for models it does not know and otherwise lowers the requested model to the one the driver supports */
+    for (auto model : { D3D_SHADER_MODEL_6_4, D3D_SHADER_MODEL_6_0, D3D_SHADER_MODEL_5_1 })
     {
         feature.HighestShaderModel = model;
         auto hr = device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &feature, sizeof(feature));
         if (SUCCEEDED(hr))
         {
-            shaderModel = model;
+            shaderModel = feature.HighestShaderModel;
             return true;
         }
     }
@@ -551,6 +923,10 @@ static const char* DXShaderModelToString(D3D_SHADER_MODEL shaderModel)
     {
         case D3D_SHADER_MODEL_5_1: return "5.1";
         case D3D_SHADER_MODEL_6_0: return "6.0";
+        case D3D_SHADER_MODEL_6_1: return "6.1";
+        case D3D_SHADER_MODEL_6_2: return "6.2";
+        case D3D_SHADER_MODEL_6_3: return "6.3";
+        case D3D_SHADER_MODEL_6_4: return "6.4";
     }
     return "";
 }
@@ -571,19 +947,86 @@ void D3D12RenderSystem::QueryRendererInfo()
     else
         info.shadingLanguageName += DXFeatureLevelToShaderModel(GetFeatureLevel());
 
+    /* Find adapter the device was created with, since D3D12 devices don't implement IDXGIDevice */
+    ComPtr<IDXGIAdapter> adapter;
+    if (SUCCEEDED(factory_->EnumAdapterByLuid(GetDXDevice()->GetAdapterLuid(), IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()))))
+    {
+        info.adapterIndex = DXFindOrAppendVideoAdapter(videoAdatperDescs_, adapter.Get());
+        videoAdatperDescs_[info.adapterIndex].numNodes = GetDXDevice()->GetNodeCount();
+    }
+
     /* Get device and vendor name from adapter */
-    if (!videoAdatperDescs_.empty())
+    if (info.adapterIndex < videoAdatperDescs_.size())
     {
-        const auto& videoAdapterDesc = videoAdatperDescs_.front();
+        const auto& videoAdapterDesc = videoAdatperDescs_[info.adapterIndex];
         info.deviceName = ToUTF8String(videoAdapterDesc.name);
         info.vendorName = videoAdapterDesc.vendor;
     }
     else
         info.deviceName = info.vendorName = "<no adapter found>";
 
+    info.videoAdapters = videoAdatperDescs_;
+
     SetRendererInfo(info);
 }
 
+// Returns true if descriptor tables can be unbounded and partially bound for all resource types, which is required for bindless resource heaps.
+static bool IsBindlessHeapSupported(ID3D12Device* device)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options));
+    return (SUCCEEDED(hr) && options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_3);
+}
+
+// Returns true if reserved resources are supported, which is required for sparse buffers and textures.
+static bool IsTiledResourcesSupported(ID3D12Device* device)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options));
+    return (SUCCEEDED(hr) && options.TiledResourcesTier >= D3D12_TILED_RESOURCES_TIER_1);
+}
+
+// Returns the variable rate shading tier and the tile size of shading-rate images.
+static D3D12_VARIABLE_SHADING_RATE_TIER GetVariableShadingRateTier(ID3D12Device* device, UINT& outTileSize)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS6 options = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options, sizeof(options));
+    if (FAILED(hr))
+    {
+        outTileSize = 0;
+        return D3D12_VARIABLE_SHADING_RATE_TIER_NOT_SUPPORTED;
+    }
+    outTileSize = options.ShadingRateImageTileSize;
+    return options.VariableShadingRateTier;
+}
+
+static bool IsMeshShaderSupported(ID3D12Device* device)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS7 options = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &options, sizeof(options));
+    return (SUCCEEDED(hr) && options.MeshShaderTier >= D3D12_MESH_SHADER_TIER_1);
+}
+
+// Returns true if inline ray tracing (RayQuery objects in HLSL) is supported, which requires ray tracing tier 1.1.
+static bool IsRayTracingSupported(ID3D12Device* device)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS5 options = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS5, &options, sizeof(options));
+    return (SUCCEEDED(hr) && options.RaytracingTier >= D3D12_RAYTRACING_TIER_1_1);
+}
+
+// Returns true if HLSL wave intrinsics are supported and returns the range of lanes per wave.
+static bool GetWaveLaneCountRange(ID3D12Device* device, UINT& outMinLaneCount, UINT& outMaxLaneCount)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS1 options = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options, sizeof(options));
+    if (FAILED(hr) || !options.WaveOps)
+        return false;
+    outMinLaneCount = options.WaveLaneCountMin;
+    outMaxLaneCount = options.WaveLaneCountMax;
+    return true;
+}
+
 void D3D12RenderSystem::QueryRenderingCaps()
 {
     RenderingCapabilities caps;
@@ -594,6 +1037,44 @@ void D3D12RenderSystem::QueryRenderingCaps()
         /* Set extended attributes */
         caps.features.hasConservativeRasterization  = (GetFeatureLevel() >= D3D_FEATURE_LEVEL_12_0);
         caps.features.hasTextureViewSwizzle         = true;
+        caps.features.hasIndirectCountDrawing       = true;
+        caps.features.hasBindlessResources          = IsBindlessHeapSupported(device_.GetNative());
+        caps.features.hasSparseResources            = IsTiledResourcesSupported(device_.GetNative());
+        caps.features.hasThreadSafeResourceCreation = true;
+
+        UINT shadingRateImageTileSize = 0;
+        const D3D12_VARIABLE_SHADING_RATE_TIER shadingRateTier = GetVariableShadingRateTier(device_.GetNative(), shadingRateImageTileSize);
+        caps.features.hasVariableRateShading        = (shadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_1);
+        caps.features.hasShadingRateImage           = (shadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_2);
+        caps.features.hasMeshShaders                = IsMeshShaderSupported(device_.GetNative());
+        caps.features.hasRayTracing                 = IsRayTracingSupported(device_.GetNative());
+
+        /* Shader model 6.0 and later requires DXC at runtime */
+        D3D_SHADER_MODEL shaderModel = D3D_SHADER_MODEL_5_1;
+        if (FindHighestShaderModel(device_.GetNative(), shaderModel) && shaderModel >= D3D_SHADER_MODEL_6_0 && D3D12DXCompiler::Get().IsAvailable())
+        {
+            const int maxMinorVersion = static_cast<int>(shaderModel) - static_cast<int>(D3D_SHADER_MODEL_6_0);
+            for (int minorVersion = 0; minorVersion <= maxMinorVersion; ++minorVersion)
+                caps.shadingLanguages.push_back(static_cast<ShadingLanguage>(static_cast<int>(ShadingLanguage::HLSL_6_0) + minorVersion));
+
+            /* Wave intrinsics require shader model 6.0; relative shuffles and clustered reductions have no HLSL equivalent */
+            UINT minWaveLaneCount = 0, maxWaveLaneCount = 0;
+            if (GetWaveLaneCountRange(device_.GetNative(), minWaveLaneCount, maxWaveLaneCount))
+            {
+                caps.limits.minSubgroupSize     = minWaveLaneCount;
+                caps.limits.maxSubgroupSize     = maxWaveLaneCount;
+                caps.limits.subgroupOperations  =
+                (
+                    SubgroupOperationFlags::Basic       |
+                    SubgroupOperationFlags::Vote        |
+                    SubgroupOperationFlags::Arithmetic  |
+                    SubgroupOperationFlags::Ballot      |
+                    SubgroupOperationFlags::Shuffle     |
+                    SubgroupOperationFlags::Quad
+                );
+                caps.limits.subgroupStages      = (StageFlags::AllStages | (caps.features.hasMeshShaders ? StageFlags::AllMeshStages : 0));
+            }
+        }
 
         caps.limits.maxViewports                    = D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
         caps.limits.maxViewportSize[0]              = D3D12_VIEWPORT_BOUNDS_MAX;
@@ -606,17 +1087,21 @@ void D3D12RenderSystem::QueryRenderingCaps()
         caps.limits.maxDepthBufferSamples           = device_.FindSuitableSampleDesc(DXGI_FORMAT_D32_FLOAT).Count;
         caps.limits.maxStencilBufferSamples         = device_.FindSuitableSampleDesc(DXGI_FORMAT_D32_FLOAT_S8X24_UINT).Count;
         caps.limits.maxNoAttachmentSamples          = D3D12_MAX_MULTISAMPLE_SAMPLE_COUNT;
+        caps.limits.shadingRateImageTileSize        = (caps.features.hasShadingRateImage ? shadingRateImageTileSize : 0u);
+        caps.limits.maxAccelerationStructureInstances = (caps.features.hasRayTracing ? D3D12_RAYTRACING_MAX_INSTANCES_PER_TOP_LEVEL_ACCELERATION_STRUCTURE : 0u);
     }
     SetRenderingCaps(caps);
 }
 
 void D3D12RenderSystem::ExecuteCommandList()
 {
+    std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
     commandContext_->Finish();
 }
 
 void D3D12RenderSystem::ExecuteCommandListAndSync()
 {
+    std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
     commandContext_->Finish(true);
 }
 
@@ -627,8 +1112,17 @@ void D3D12RenderSystem::UpdateBufferAndSync(
     std::uint64_t   dataSize,
     std::uint64_t   alignment)
 {
-    stagingBufferPool_.WriteImmediate(*commandContext_, bufferD3D.GetResource(), offset, data, dataSize, alignment);
-    ExecuteCommandListAndSync();
+    /* Upload and readback heap buffers are mapped directly instead of using a copy command */
+    if (bufferD3D.IsHostVisible())
+    {
+        HRESULT hr = bufferD3D.WriteHostVisible(offset, data, dataSize);
+        DXThrowIfFailed(hr, "failed to map D3D12 host-visible buffer");
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
+    commandContext_->UpdateSubresource(bufferD3D.GetResource(), offset, data, dataSize, alignment);
+    commandContext_->Finish(true);
 }
 
 void* D3D12RenderSystem::MapBufferRange(D3D12Buffer& bufferD3D, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
@@ -636,6 +1130,7 @@ void* D3D12RenderSystem::MapBufferRange(D3D12Buffer& bufferD3D, const CPUAccess
     void* mappedData = nullptr;
     const D3D12_RANGE range{ static_cast<SIZE_T>(offset), static_cast<SIZE_T>(offset + length) };
 
+    std::lock_guard<std::mutex> guard{ commandQueue_->GetContextMutex() };
     if (SUCCEEDED(bufferD3D.Map(*commandContext_, range, &mappedData, access)))
         return mappedData;
 
@@ -710,6 +1205,11 @@ const D3D12RenderPass* D3D12RenderSystem::GetDefaultRenderPass() const
     return nullptr;
 }
 
+D3D12PipelineLibrary* D3D12RenderSystem::GetPipelineLibrary()
+{
+    return (pipelineLibrary_.IsValid() ? &pipelineLibrary_ : nullptr);
+}
+
 
 } // /namespace LLGL
 
@@ -21,6 +21,7 @@
 
 #include "Buffer/D3D12Buffer.h"
 #include "Buffer/D3D12BufferArray.h"
+#include "Buffer/D3D12AccelerationStructure.h"
 #include "Buffer/D3D12StagingBufferPool.h"
 
 #include "Texture/D3D12Texture.h"
@@ -30,6 +31,7 @@
 #include "RenderState/D3D12Fence.h"
 #include "RenderState/D3D12PipelineState.h"
 #include "RenderState/D3D12PipelineLayout.h"
+#include "RenderState/D3D12PipelineLibrary.h"
 #include "RenderState/D3D12ResourceHeap.h"
 #include "RenderState/D3D12RenderPass.h"
 #include "RenderState/D3D12QueryHeap.h"
@@ -38,6 +40,7 @@
 
 #include "../ContainerTypes.h"
 #include "../DXCommon/ComPtr.h"
+#include "../DXCommon/DXShaderCache.h"
 #include <d3d12.h>
 #include <dxgi1_4.h>
 
@@ -64,6 +67,12 @@ class D3D12RenderSystem final : public RenderSystem
 
         ComPtr<IDXGISwapChain1> CreateDXSwapChain(const DXGI_SWAP_CHAIN_DESC1& swapChainDescDXGI, HWND wnd);
 
+        // Returns true if the DXGI factory supports DXGI_FEATURE_PRESENT_ALLOW_TEARING for variable refresh rate displays.
+        inline bool IsTearingSupported() const
+        {
+            return tearingSupported_;
+        }
+
         // Internal fence
         void SignalFenceValue(UINT64& fenceValue);
         void WaitForFenceValue(UINT64 fenceValue);
@@ -102,13 +111,23 @@ class D3D12RenderSystem final : public RenderSystem
             return cmdSignatureFactory_;
         }
 
+        // Returns true if command buffers write breadcrumb markers. See RenderSystemFlags::GPUBreadcrumbs.
+        inline bool HasBreadcrumbs() const
+        {
+            return breadcrumbsEnabled_;
+        }
+
     private:
 
         void EnableDebugLayer();
 
         void CreateFactory(bool debugDevice = false);
         void QueryVideoAdapters();
-        void CreateDevice();
+        // Creates the device with the specified adapter or the default adapter if the index is Constants::defaultAdapter.
+        void CreateDevice(std::uint32_t adapterIndex);
+
+        // Selects the tuning profile by the vendor of the adapter the device was created with.
+        void SelectTuningProfile(const RendererConfigurationDirect3D12* config);
 
         void QueryRendererInfo();
         void QueryRenderingCaps();
@@ -138,21 +157,31 @@ class D3D12RenderSystem final : public RenderSystem
 
         const D3D12RenderPass* GetDefaultRenderPass() const;
 
+        // Returns the pipeline library or null if it's disabled or not supported.
+        D3D12PipelineLibrary* GetPipelineLibrary();
+
     private:
 
         /* ----- Common objects ----- */
 
         ComPtr<IDXGIFactory4>                   factory_;
+        bool                                    tearingSupported_       = false;
         D3D12Device                             device_;
         D3D12CommandContext*                    commandContext_         = nullptr;
         D3D12PipelineLayout                     defaultPipelineLayout_;
         D3D12SignatureFactory                   cmdSignatureFactory_;
         D3D12StagingBufferPool                  stagingBufferPool_;
+        D3D12PipelineLibrary                    pipelineLibrary_;
+        DXShaderCache                           shaderCache_;
+
+        SamplerCache<D3D12_SAMPLER_DESC>        samplerCache_;          // Must outlive 'samplers_'
 
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<D3D12SwapChain>       swapChains_;
         HWObjectInstance<D3D12CommandQueue>     commandQueue_;
+        HWObjectInstance<D3D12CommandQueue>     computeQueue_;
+        HWObjectInstance<D3D12CommandQueue>     copyQueue_;
         HWObjectContainer<D3D12CommandBuffer>   commandBuffers_;
         HWObjectContainer<D3D12Buffer>          buffers_;
         HWObjectContainer<D3D12BufferArray>     bufferArrays_;
@@ -165,11 +194,13 @@ class D3D12RenderSystem final : public RenderSystem
         HWObjectContainer<D3D12PipelineState>   pipelineStates_;
         HWObjectContainer<D3D12ResourceHeap>    resourceHeaps_;
         HWObjectContainer<D3D12QueryHeap>       queryHeaps_;
+        HWObjectContainer<D3D12AccelerationStructure> accelStructs_;
         HWObjectContainer<D3D12Fence>           fences_;
 
         /* ----- Other members ----- */
 
         std::vector<VideoAdapterDescriptor>     videoAdatperDescs_;
+        bool                                    breadcrumbsEnabled_     = false;
 
 };
 
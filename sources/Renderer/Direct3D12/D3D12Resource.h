@@ -12,6 +12,7 @@
 #include "../DXCommon/ComPtr.h"
 #include <d3d12.h>
 #include <utility>
+#include <vector>
 
 
 namespace LLGL
@@ -19,7 +20,11 @@ namespace LLGL
 
 
 //TODO: Rename to "D3D12GpuResource" to avoid overlapping terminology with <Resource> interface.
-// Helper struct to store a D3D12 resource with its usage state and transition state.
+/*
+Helper struct to store a D3D12 resource with its usage state and transition state.
+The transition state is tracked per subresource once a single subresource has been transitioned independently;
+see D3D12CommandContext::TransitionSubresource.
+*/
 struct D3D12Resource
 {
     D3D12Resource() = default;
@@ -36,6 +41,7 @@ struct D3D12Resource
     {
         usageState      = initialState;
         transitionState = initialState;
+        subresourceStates.clear();
     }
 
     // Returns the natvie resource object.
@@ -44,9 +50,24 @@ struct D3D12Resource
         return native.Get();
     }
 
-    ComPtr<ID3D12Resource>  native;
-    D3D12_RESOURCE_STATES   usageState      = D3D12_RESOURCE_STATE_COMMON;
-    D3D12_RESOURCE_STATES   transitionState = D3D12_RESOURCE_STATE_COMMON;
+    // Returns true if all subresources are in the same transition state, i.e. 'transitionState'.
+    inline bool HasUniformState() const
+    {
+        return subresourceStates.empty();
+    }
+
+    // Returns the current transition state of the specified subresource.
+    inline D3D12_RESOURCE_STATES GetSubresourceState(UINT subresource) const
+    {
+        return (subresource < subresourceStates.size() ? subresourceStates[subresource] : transitionState);
+    }
+
+    ComPtr<ID3D12Resource>              native;
+    D3D12_RESOURCE_STATES               usageState          = D3D12_RESOURCE_STATE_COMMON;
+    D3D12_RESOURCE_STATES               transitionState     = D3D12_RESOURCE_STATE_COMMON; // Transition state of all subresources if the state is uniform.
+    UINT                                numSubresources     = 1;
+    std::vector<D3D12_RESOURCE_STATES>  subresourceStates;                                  // Per-subresource transition states or empty if the state is uniform.
+    bool                                splitBarrierPending = false;                        // True while a split barrier has begun but not ended yet.
 };
 
 
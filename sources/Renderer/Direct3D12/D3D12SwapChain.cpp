@@ -21,6 +21,7 @@
 #include <LLGL/Log.h>
 #include <LLGL/Utils/ForRange.h>
 #include "D3DX12/d3dx12.h"
+#include "../HostTrace.h"
 #include <algorithm>
 
 
@@ -45,18 +46,30 @@ D3D12SwapChain::D3D12SwapChain(
     /* Setup surface for the swap-chain */
     SetOrCreateSurface(surface, desc.resolution, desc.fullscreen, nullptr);
 
+    /* Only keep explicit presentation mode if it's supported; tearing must be allowed when the DXGI swap-chain is created */
+    if (IsPresentModeSupported(desc.presentMode))
+        presentMode_ = desc.presentMode;
+    if (presentMode_ == PresentMode::Immediate)
+        swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+
     /* Create device resources and window dependent resource */
     CreateDescriptorHeaps(renderSystem.GetDevice(), desc.samples);
     CreateResolutionDependentResources(desc.resolution);
 
     /* Create default render pass */
     defaultRenderPass_.BuildAttachments(1, &colorFormat_, depthStencilFormat_, sampleDesc_);
+
+    /* The frame latency waitable object must also be waited on before the first frame */
+    WaitForFrameLatency();
 }
 
 D3D12SwapChain::~D3D12SwapChain()
 {
     /* Ensure the GPU is no longer referencing resources that are about to be released */
     MoveToNextFrame();
+
+    if (frameLatencyWaitable_ != nullptr)
+        CloseHandle(frameLatencyWaitable_);
 }
 
 void D3D12SwapChain::SetName(const char* name)
@@ -79,12 +92,38 @@ void D3D12SwapChain::SetName(const char* name)
 
 void D3D12SwapChain::Present()
 {
-    /* Present swap-chain with vsync interval */
-    HRESULT hr = swapChainDXGI_->Present(syncInterval_, 0);
+    LLGL_HOST_TRACE_SCOPE("Present");
+    PresentDXGI();
+    MoveToNextFrameAndWait();
+}
+
+void D3D12SwapChain::PresentDXGI()
+{
+    /* Present swap-chain with vsync interval; explicit non-blocking modes always present with a sync interval of zero */
+    HRESULT hr = S_OK;
+    switch (presentMode_)
+    {
+        case PresentMode::Mailbox:
+            hr = swapChainDXGI_->Present(0, 0);
+            break;
+        case PresentMode::Immediate:
+            hr = swapChainDXGI_->Present(0, DXGI_PRESENT_ALLOW_TEARING);
+            break;
+        case PresentMode::Fifo:
+            hr = swapChainDXGI_->Present(std::max(1u, syncInterval_), 0);
+            break;
+        default:
+            hr = swapChainDXGI_->Present(syncInterval_, 0);
+            break;
+    }
     DXThrowIfFailed(hr, "failed to present DXGI swap chain");
+}
 
-    /* Advance frame counter */
+void D3D12SwapChain::MoveToNextFrameAndWait()
+{
+    /* Advance frame counter and block until the next frame can be queued */
     MoveToNextFrame();
+    WaitForFrameLatency();
 }
 
 std::uint32_t D3D12SwapChain::GetCurrentSwapIndex() const
@@ -122,6 +161,36 @@ bool D3D12SwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
     return SetPresentSyncInterval(vsyncInterval);
 }
 
+bool D3D12SwapChain::SetMaxFrameLatency(std::uint32_t maxFrameLatency)
+{
+    /* IDXGISwapChain2::SetMaximumFrameLatency expects a frame latency in the range [1, 16] */
+    if (maxFrameLatency == 0 || maxFrameLatency > 16)
+        return false;
+
+    HRESULT hr = swapChainDXGI_->SetMaximumFrameLatency(maxFrameLatency);
+    if (FAILED(hr))
+        return false;
+
+    maxFrameLatency_ = maxFrameLatency;
+    return true;
+}
+
+bool D3D12SwapChain::IsPresentModeSupported(PresentMode presentMode) const
+{
+    switch (presentMode)
+    {
+        case PresentMode::Default:
+        case PresentMode::Fifo:
+        case PresentMode::Mailbox:
+            /* Flip-model swap-chains never tear with a sync interval of zero, but replace the queued frame */
+            return true;
+        case PresentMode::Immediate:
+            return renderSystem_.IsTearingSupported();
+        default:
+            return false;
+    }
+}
+
 /* --- Extended functions --- */
 
 UINT D3D12SwapChain::TranslateSwapIndex(std::uint32_t swapBufferIndex) const
@@ -140,7 +209,7 @@ D3D12Resource& D3D12SwapChain::GetCurrentColorBuffer(UINT colorBuffer)
         return colorBuffers_[colorBuffer];
 }
 
-void D3D12SwapChain::ResolveSubresources(D3D12CommandContext& commandContext, UINT colorBuffer)
+void D3D12SwapChain::ResolveSubresources(D3D12CommandContext& commandContext, UINT colorBuffer, const D3D12_RECT* srcRect)
 {
     if (HasMultiSampling())
     {
@@ -150,7 +219,8 @@ void D3D12SwapChain::ResolveSubresources(D3D12CommandContext& commandContext, UI
             0,
             colorBuffersMS_[colorBuffer],
             0,
-            colorFormat_
+            colorFormat_,
+            srcRect
         );
     }
     else
@@ -361,15 +431,20 @@ HRESULT D3D12SwapChain::CreateResolutionDependentResources(const Extent2D& resol
 {
     ID3D12Device* device = renderSystem_.GetDXDevice();
 
-    /* Wait until all previous GPU work is complete */
-    renderSystem_.SyncGPU();
+    /*
+    Wait until the frames that referenced the back buffers are complete, since DXGI requires all references to be released before the buffers can be resized.
+    These frames are only submitted to the graphics queue, so the compute and copy queues don't have to be drained.
+    */
+    const UINT64 currentFenceValue = frameFenceValues_[currentColorBuffer_];
+    commandQueue_->SignalFence(frameFence_.Get(), currentFenceValue);
+    frameFence_.WaitForHigherSignal(currentFenceValue);
 
-    /* Release previous window size dependent resources, and reset fence values to current value */
+    /* Release previous window size dependent resources, and reset fence values to the next value */
     for_range(i, numColorBuffers_)
     {
         colorBuffers_[i].native.Reset();
         colorBuffersMS_[i].native.Reset();
-        frameFenceValues_[i] = frameFenceValues_[currentColorBuffer_];
+        frameFenceValues_[i] = currentFenceValue + 1;
     }
 
     depthStencil_.native.Reset();
@@ -383,7 +458,7 @@ HRESULT D3D12SwapChain::CreateResolutionDependentResources(const Extent2D& resol
             resolution.width,
             resolution.height,
             colorFormat_,
-            0
+            swapChainFlags_
         );
 
         if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
@@ -413,11 +488,15 @@ HRESULT D3D12SwapChain::CreateResolutionDependentResources(const Extent2D& resol
             swapChainDesc.Scaling               = DXGI_SCALING_NONE;
             swapChainDesc.SwapEffect            = DXGI_SWAP_EFFECT_FLIP_DISCARD;
             swapChainDesc.AlphaMode             = DXGI_ALPHA_MODE_IGNORE;
-            swapChainDesc.Flags                 = 0;
+            swapChainDesc.Flags                 = swapChainFlags_;
         }
         auto swapChain = renderSystem_.CreateDXSwapChain(swapChainDesc, wndHandle.window);
 
         swapChain.As(&swapChainDXGI_);
+
+        /* Frames are throttled with the waitable object instead of blocking in IDXGISwapChain::Present */
+        swapChainDXGI_->SetMaximumFrameLatency(maxFrameLatency_);
+        frameLatencyWaitable_ = swapChainDXGI_->GetFrameLatencyWaitableObject();
     }
 
     /* Create color buffer render target views (RTV) */
@@ -529,6 +608,13 @@ void D3D12SwapChain::MoveToNextFrame()
     frameFenceValues_[currentColorBuffer_] = currentFenceValue + 1;
 }
 
+void D3D12SwapChain::WaitForFrameLatency()
+{
+    /* Use a timeout, so a lost device or a minimized window cannot block the application indefinitely */
+    if (frameLatencyWaitable_ != nullptr)
+        WaitForSingleObjectEx(frameLatencyWaitable_, 1000, TRUE);
+}
+
 
 } // /namespace LLGL
 
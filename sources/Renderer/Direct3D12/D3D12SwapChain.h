@@ -50,6 +50,8 @@ class D3D12SwapChain final : public SwapChain
         const RenderPass* GetRenderPass() const override;
 
         bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+        bool SetMaxFrameLatency(std::uint32_t maxFrameLatency) override;
+        bool IsPresentModeSupported(PresentMode presentMode) const override;
 
     public:
 
@@ -63,10 +65,16 @@ class D3D12SwapChain final : public SwapChain
 
         UINT TranslateSwapIndex(std::uint32_t swapBufferIndex) const;
 
+        // Presents the DXGI swap-chain without advancing to the next frame. Present() is equivalent to PresentDXGI() followed by MoveToNextFrameAndWait().
+        void PresentDXGI();
+
+        // Advances to the next frame and blocks until it can be queued.
+        void MoveToNextFrameAndWait();
+
         // Returns the native color buffer resource from the swap-chain that is currently being used.
         D3D12Resource& GetCurrentColorBuffer(UINT colorBuffer);
 
-        void ResolveSubresources(D3D12CommandContext& commandContext, UINT colorBuffer);
+        void ResolveSubresources(D3D12CommandContext& commandContext, UINT colorBuffer, const D3D12_RECT* srcRect = nullptr);
 
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForRTV(UINT colorBuffer) const;
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForDSV() const;
@@ -101,9 +109,12 @@ class D3D12SwapChain final : public SwapChain
 
         void MoveToNextFrame();
 
+        // Waits on the frame latency waitable object until the number of queued frames is below the maximum frame latency.
+        void WaitForFrameLatency();
+
     private:
 
-        static constexpr UINT maxNumColorBuffers = 3;
+        static constexpr UINT maxNumColorBuffers    = 3;
 
         D3D12RenderSystem&              renderSystem_;  // reference to its render system
         D3D12CommandQueue*              commandQueue_                           = nullptr;
@@ -112,6 +123,10 @@ class D3D12SwapChain final : public SwapChain
         ComPtr<IDXGISwapChain3>         swapChainDXGI_;
         DXGI_SAMPLE_DESC                sampleDesc_                             = { 1, 0 };
         UINT                            syncInterval_                           = 0;
+        PresentMode                     presentMode_                            = PresentMode::Default;
+        UINT                            swapChainFlags_                         = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT; // Must be the same for creation and ResizeBuffers
+        HANDLE                          frameLatencyWaitable_                   = nullptr;
+        UINT                            maxFrameLatency_                        = 3; // Same as the default of DXGI
 
         ComPtr<ID3D12DescriptorHeap>    rtvDescHeap_;
         UINT                            rtvDescSize_                            = 0;
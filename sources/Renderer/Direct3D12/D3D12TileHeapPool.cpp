@@ -0,0 +1,98 @@
+/*
+ * D3D12TileHeapPool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "D3D12TileHeapPool.h"
+#include "D3DX12/d3dx12.h"
+#include "../DXCommon/DXCore.h"
+#include "../../Core/Assertion.h"
+#include <LLGL/Utils/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+constexpr UINT D3D12TileHeapPool::numTilesPerHeap;
+
+void D3D12TileHeapPool::InitializeDevice(ID3D12Device* device)
+{
+    device_ = device;
+}
+
+D3D12TileAllocation D3D12TileHeapPool::AllocTile(D3D12_HEAP_FLAGS category)
+{
+    std::lock_guard<std::mutex> guard{ heapsMutex_ };
+
+    /* Find heap of the same category with a free tile; create a new heap if there is none */
+    UINT heapIndex = 0;
+    while (heapIndex < heaps_.size() && (heaps_[heapIndex].category != category || heaps_[heapIndex].freeTiles.empty()))
+        ++heapIndex;
+
+    if (heapIndex == heaps_.size())
+        CreateTileHeap(category);
+
+    /* Take tile with lowest index first, since free list is sorted in reverse order */
+    TileHeap& heap = heaps_[heapIndex];
+
+    D3D12TileAllocation tile;
+    {
+        tile.heapIndex = heapIndex;
+        tile.tileIndex = heap.freeTiles.back();
+    }
+    heap.freeTiles.pop_back();
+
+    return tile;
+}
+
+void D3D12TileHeapPool::FreeTile(const D3D12TileAllocation& tile)
+{
+    std::lock_guard<std::mutex> guard{ heapsMutex_ };
+    LLGL_ASSERT(tile.heapIndex < heaps_.size());
+    heaps_[tile.heapIndex].freeTiles.push_back(tile.tileIndex);
+}
+
+ID3D12Heap* D3D12TileHeapPool::GetNativeHeap(UINT heapIndex) const
+{
+    std::lock_guard<std::mutex> guard{ heapsMutex_ };
+    return (heapIndex < heaps_.size() ? heaps_[heapIndex].native.Get() : nullptr);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12TileHeapPool::CreateTileHeap(D3D12_HEAP_FLAGS category)
+{
+    LLGL_ASSERT_PTR(device_);
+
+    TileHeap heap;
+    heap.category = category;
+
+    const CD3DX12_HEAP_DESC heapDesc
+    {
+        static_cast<UINT64>(D3D12TileHeapPool::numTilesPerHeap) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES,
+        D3D12_HEAP_TYPE_DEFAULT,
+        D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT,
+        category
+    };
+    HRESULT hr = device_->CreateHeap(&heapDesc, IID_PPV_ARGS(heap.native.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12Heap", "for tiled resources");
+
+    heap.freeTiles.reserve(D3D12TileHeapPool::numTilesPerHeap);
+    for_range(i, D3D12TileHeapPool::numTilesPerHeap)
+        heap.freeTiles.push_back(D3D12TileHeapPool::numTilesPerHeap - i - 1);
+
+    heaps_.push_back(std::move(heap));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,91 @@
+/*
+ * D3D12TileHeapPool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_D3D12_TILE_HEAP_POOL_H
+#define LLGL_D3D12_TILE_HEAP_POOL_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+// Location of a single 64 KB tile within the tile heap pool.
+struct D3D12TileAllocation
+{
+    UINT heapIndex = 0;
+    UINT tileIndex = 0;
+};
+
+/*
+Device-wide pool of ID3D12Heap objects that provide the physical memory for reserved resources.
+Each heap is divided into tiles of D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES and only serves one heap category,
+i.e. either buffers, non-RT/DS textures, or RT/DS textures, to be compatible with resource heap tier 1.
+Heaps are never moved or released before the device is destroyed, so heap indices remain valid.
+*/
+class D3D12TileHeapPool
+{
+
+    public:
+
+        // Number of tiles per native heap, i.e. 16 MB per heap.
+        static constexpr UINT numTilesPerHeap = 256;
+
+    public:
+
+        D3D12TileHeapPool() = default;
+
+        D3D12TileHeapPool(const D3D12TileHeapPool&) = delete;
+        D3D12TileHeapPool& operator = (const D3D12TileHeapPool&) = delete;
+
+        // Stores the device to create the tile heaps with.
+        void InitializeDevice(ID3D12Device* device);
+
+        // Allocates a single tile from a heap with the specified category (D3D12_HEAP_FLAG_ALLOW_ONLY_*) and creates a new heap if all are full.
+        D3D12TileAllocation AllocTile(D3D12_HEAP_FLAGS category);
+
+        // Returns the specified tile to the pool.
+        void FreeTile(const D3D12TileAllocation& tile);
+
+        // Returns the native heap at the specified index.
+        ID3D12Heap* GetNativeHeap(UINT heapIndex) const;
+
+    private:
+
+        struct TileHeap
+        {
+            ComPtr<ID3D12Heap>  native;
+            D3D12_HEAP_FLAGS    category    = D3D12_HEAP_FLAG_NONE;
+            std::vector<UINT>   freeTiles;
+        };
+
+    private:
+
+        void CreateTileHeap(D3D12_HEAP_FLAGS category);
+
+    private:
+
+        ID3D12Device*           device_     = nullptr;
+        std::vector<TileHeap>   heaps_;
+        mutable std::mutex      heapsMutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,135 @@
+/*
+ * D3D12TileMapper.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "D3D12TileMapper.h"
+#include <LLGL/Utils/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+constexpr UINT D3D12TileMapper::nullHeapIndex;
+
+D3D12TileMapper::D3D12TileMapper(D3D12TileHeapPool& tileHeapPool, D3D12_HEAP_FLAGS heapCategory) :
+    tileHeapPool_ { tileHeapPool },
+    heapCategory_ { heapCategory }
+{
+}
+
+D3D12TileMapper::~D3D12TileMapper()
+{
+    for (const auto& it : residentTiles_)
+        tileHeapPool_.FreeTile(it.second);
+}
+
+void D3D12TileMapper::SetTileResident(const D3D12_TILED_RESOURCE_COORDINATE& coord, UINT64 key, bool resident)
+{
+    auto it = residentTiles_.find(key);
+    if (resident)
+    {
+        if (it == residentTiles_.end())
+        {
+            const D3D12TileAllocation tile = tileHeapPool_.AllocTile(heapCategory_);
+            residentTiles_[key] = tile;
+            pendingTiles_.push_back(PendingTile{ coord, tile });
+        }
+    }
+    else
+    {
+        if (it != residentTiles_.end())
+        {
+            /*
+            Tile can be returned to the pool immediately,
+            because any subsequent mapping of the same tile is queued after this unmapping
+            */
+            tileHeapPool_.FreeTile(it->second);
+            residentTiles_.erase(it);
+
+            D3D12TileAllocation nullTile;
+            nullTile.heapIndex = D3D12TileMapper::nullHeapIndex;
+            pendingTiles_.push_back(PendingTile{ coord, nullTile });
+        }
+    }
+}
+
+void D3D12TileMapper::Flush(ID3D12CommandQueue* commandQueue, ID3D12Resource* resource)
+{
+    /* Submit one UpdateTileMappings call per consecutive run of tiles in the same heap to preserve the order of mappings */
+    const UINT numPendingTiles = static_cast<UINT>(pendingTiles_.size());
+    for (UINT first = 0; first < numPendingTiles;)
+    {
+        const UINT heapIndex = pendingTiles_[first].tile.heapIndex;
+
+        UINT last = first + 1;
+        while (last < numPendingTiles && pendingTiles_[last].tile.heapIndex == heapIndex)
+            ++last;
+
+        FlushTileRange(commandQueue, resource, &(pendingTiles_[first]), last - first);
+        first = last;
+    }
+    pendingTiles_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12TileMapper::FlushTileRange(ID3D12CommandQueue* commandQueue, ID3D12Resource* resource, const PendingTile* tiles, UINT numTiles)
+{
+    std::vector<D3D12_TILED_RESOURCE_COORDINATE> coords;
+    coords.reserve(numTiles);
+    for_range(i, numTiles)
+        coords.push_back(tiles[i].coord);
+
+    if (tiles[0].tile.heapIndex == D3D12TileMapper::nullHeapIndex)
+    {
+        /* Unmap all tiles with a single NULL range; each resource region has a size of 1 tile by default */
+        const D3D12_TILE_RANGE_FLAGS rangeFlags = D3D12_TILE_RANGE_FLAG_NULL;
+        commandQueue->UpdateTileMappings(
+            resource,
+            numTiles,
+            coords.data(),
+            nullptr,
+            nullptr,
+            1,
+            &rangeFlags,
+            nullptr,
+            &numTiles,
+            D3D12_TILE_MAPPING_FLAG_NONE
+        );
+    }
+    else
+    {
+        /* Map each tile to its own heap range of 1 tile */
+        std::vector<UINT> heapRangeStartOffsets;
+        heapRangeStartOffsets.reserve(numTiles);
+        for_range(i, numTiles)
+            heapRangeStartOffsets.push_back(tiles[i].tile.tileIndex);
+
+        commandQueue->UpdateTileMappings(
+            resource,
+            numTiles,
+            coords.data(),
+            nullptr,
+            tileHeapPool_.GetNativeHeap(tiles[0].tile.heapIndex),
+            numTiles,
+            nullptr,
+            heapRangeStartOffsets.data(),
+            nullptr,
+            D3D12_TILE_MAPPING_FLAG_NONE
+        );
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,78 @@
+/*
+ * D3D12TileMapper.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_D3D12_TILE_MAPPER_H
+#define LLGL_D3D12_TILE_MAPPER_H
+
+
+#include "D3D12TileHeapPool.h"
+#include <unordered_map>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Keeps track of the resident tiles of a single reserved resource.
+Tile mappings are accumulated with SetTileResident() and submitted to the command queue with Flush().
+All tiles are returned to the tile heap pool when the tile mapper is destroyed;
+the owner must ensure that the GPU no longer accesses the resource at that point.
+*/
+class D3D12TileMapper
+{
+
+    public:
+
+        D3D12TileMapper(D3D12TileHeapPool& tileHeapPool, D3D12_HEAP_FLAGS heapCategory);
+        ~D3D12TileMapper();
+
+        D3D12TileMapper(const D3D12TileMapper&) = delete;
+        D3D12TileMapper& operator = (const D3D12TileMapper&) = delete;
+
+        /*
+        Maps or unmaps the tile at the specified coordinate. The key must uniquely identify the tile within its resource.
+        This has no effect if the tile is already in the requested state.
+        */
+        void SetTileResident(const D3D12_TILED_RESOURCE_COORDINATE& coord, UINT64 key, bool resident);
+
+        // Submits all pending tile mappings for the specified resource to the command queue.
+        void Flush(ID3D12CommandQueue* commandQueue, ID3D12Resource* resource);
+
+    private:
+
+        static constexpr UINT nullHeapIndex = ~0u;
+
+        struct PendingTile
+        {
+            D3D12_TILED_RESOURCE_COORDINATE coord;
+            D3D12TileAllocation             tile;   // Heap index is 'nullHeapIndex' to unmap the tile.
+        };
+
+    private:
+
+        void FlushTileRange(ID3D12CommandQueue* commandQueue, ID3D12Resource* resource, const PendingTile* tiles, UINT numTiles);
+
+    private:
+
+        D3D12TileHeapPool&                                  tileHeapPool_;
+        D3D12_HEAP_FLAGS                                    heapCategory_   = D3D12_HEAP_FLAG_NONE;
+        std::unordered_map<UINT64, D3D12TileAllocation>     residentTiles_;
+        std::vector<PendingTile>                            pendingTiles_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -37,6 +37,8 @@ D3D12_TEXTURE_ADDRESS_MODE      Map( const SamplerAddressMode   addressMode
 D3D12_LOGIC_OP                  Map( const LogicOp              logicOp         );
 D3D12_SHADER_COMPONENT_MAPPING  Map( const TextureSwizzle       textureSwizzle  );
 UINT                            Map( const TextureSwizzleRGBA&  textureSwizzle  );
+D3D12_SHADING_RATE              Map( const ShadingRate          shadingRate     );
+D3D12_SHADING_RATE_COMBINER     Map( const ShadingRateCombiner  combiner        );
 
 D3D12_SRV_DIMENSION             MapSrvDimension     ( const TextureType textureType );
 D3D12_UAV_DIMENSION             MapUavDimension     ( const TextureType textureType );
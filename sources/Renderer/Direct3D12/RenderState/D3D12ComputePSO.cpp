@@ -7,6 +7,7 @@
 
 #include "D3D12ComputePSO.h"
 #include "D3D12PipelineLayout.h"
+#include "D3D12PipelineLibrary.h"
 #include "../D3D12Device.h"
 #include "../Shader/D3D12Shader.h"
 #include "../Command/D3D12CommandContext.h"
@@ -23,24 +24,38 @@ namespace LLGL
 D3D12ComputePSO::D3D12ComputePSO(
     D3D12Device&                        device,
     D3D12PipelineLayout&                defaultPipelineLayout,
-    const ComputePipelineDescriptor&    desc)
+    const ComputePipelineDescriptor&    desc,
+    D3D12PipelineLibrary*               pipelineLibrary,
+    bool                                isAsync,
+    PipelineState*                      fallbackPipelineState)
 :
     D3D12PipelineState { /*isGraphicsPSO:*/ false, desc.pipelineLayout, GetShadersAsArray(desc), defaultPipelineLayout }
 {
+    const D3D12PipelineLayout* pipelineLayoutD3D = (GetPipelineLayout() != nullptr ? GetPipelineLayout() : &defaultPipelineLayout);
     if (auto computeShaderD3D = LLGL_CAST(const D3D12Shader*, desc.computeShader))
-        CreateNativePSO(device, computeShaderD3D->GetByteCode());
+        CreateNativePSO(device, computeShaderD3D->GetByteCode(), *pipelineLayoutD3D, pipelineLibrary, isAsync, fallbackPipelineState);
     else
         throw std::runtime_error("cannot create D3D compute pipeline without compute shader");
 }
 
 void D3D12ComputePSO::Bind(D3D12CommandContext& commandContext)
 {
+    /* Skip binding if the PSO failed to compile in the background */
+    if (GetNative() == nullptr)
+        return;
+
     /* Set root signature and pipeline state */
     commandContext.SetComputeRootSignature(GetRootSignature());
     commandContext.SetPipelineState(GetNative());
 }
 
-void D3D12ComputePSO::CreateNativePSO(D3D12Device& device, const D3D12_SHADER_BYTECODE& csBytecode)
+void D3D12ComputePSO::CreateNativePSO(
+    D3D12Device&                    device,
+    const D3D12_SHADER_BYTECODE&    csBytecode,
+    const D3D12PipelineLayout&      pipelineLayout,
+    D3D12PipelineLibrary*           pipelineLibrary,
+    bool                            isAsync,
+    PipelineState*                  fallbackPipelineState)
 {
     /* Create graphics pipeline state and graphics command list */
     D3D12_COMPUTE_PIPELINE_STATE_DESC stateDesc = {};
@@ -48,7 +63,24 @@ void D3D12ComputePSO::CreateNativePSO(D3D12Device& device, const D3D12_SHADER_BY
         stateDesc.pRootSignature    = GetRootSignature();
         stateDesc.CS                = csBytecode;
     }
-    SetNative(device.CreateDXComputePipelineState(stateDesc));
+    if (isAsync)
+    {
+        ID3DBlob* rootSignatureBlob = pipelineLayout.GetSerializedBlob();
+        CreateNativeAsync(
+            [&device, stateDesc, rootSignatureBlob, pipelineLibrary]() -> ComPtr<ID3D12PipelineState>
+            {
+                if (pipelineLibrary != nullptr)
+                    return pipelineLibrary->CreateComputePipelineState(device, stateDesc, rootSignatureBlob);
+                else
+                    return device.CreateDXComputePipelineState(stateDesc);
+            },
+            fallbackPipelineState
+        );
+    }
+    else if (pipelineLibrary != nullptr)
+        SetNative(pipelineLibrary->CreateComputePipelineState(device, stateDesc, pipelineLayout.GetSerializedBlob()));
+    else
+        SetNative(device.CreateDXComputePipelineState(stateDesc));
 }
 
 
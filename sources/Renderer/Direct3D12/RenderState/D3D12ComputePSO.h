@@ -19,6 +19,7 @@ namespace LLGL
 class D3D12Device;
 class D3D12ShaderProgram;
 class D3D12PipelineLayout;
+class D3D12PipelineLibrary;
 
 class D3D12ComputePSO final : public D3D12PipelineState
 {
@@ -28,14 +29,24 @@ class D3D12ComputePSO final : public D3D12PipelineState
         D3D12ComputePSO(
             D3D12Device&                        device,
             D3D12PipelineLayout&                defaultPipelineLayout,
-            const ComputePipelineDescriptor&    desc
+            const ComputePipelineDescriptor&    desc,
+            D3D12PipelineLibrary*               pipelineLibrary         = nullptr,
+            bool                                isAsync                 = false,
+            PipelineState*                      fallbackPipelineState   = nullptr
         );
 
         void Bind(D3D12CommandContext& commandContext) override;
 
     private:
 
-        void CreateNativePSO(D3D12Device& device, const D3D12_SHADER_BYTECODE& csBytecode);
+        void CreateNativePSO(
+            D3D12Device&                    device,
+            const D3D12_SHADER_BYTECODE&    csBytecode,
+            const D3D12PipelineLayout&      pipelineLayout,
+            D3D12PipelineLibrary*           pipelineLibrary,
+            bool                            isAsync,
+            PipelineState*                  fallbackPipelineState
+        );
 
 };
 
@@ -10,11 +10,16 @@
 #include "../Buffer/D3D12Buffer.h"
 #include "../Texture/D3D12Texture.h"
 #include "../Texture/D3D12Sampler.h"
+#include "../Buffer/D3D12AccelerationStructure.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Assertion.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <LLGL/Constants.h>
 #include <thread>
 #include <chrono>
 #include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
@@ -38,29 +43,44 @@ void D3D12DescriptorCache::Create(
     device_ = device;
     descriptorHeaps_[g_dhIndexCbvSrvUav].Create(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, std::max(g_dhMinCacheSizes[g_dhIndexCbvSrvUav], initialNumResources));
     descriptorHeaps_[g_dhIndexSampler  ].Create(device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     std::max(g_dhMinCacheSizes[g_dhIndexSampler  ], initialNumSamplers ));
+    for_range(heapIndex, 2u)
+        descriptorKeys_[heapIndex].assign(descriptorHeaps_[heapIndex].GetSize(), DescriptorKey{});
 }
 
 void D3D12DescriptorCache::Reset(UINT numResources, UINT numSamplers)
 {
-    /* Store new strides and resize descriptor heaps if necessary */
+    /*
+    Store new strides and resize descriptor heaps if necessary.
+    The tables are always invalidated, since a new root signature discards the previous descriptor table bindings,
+    but flushing them again only copies descriptors if they have not been copied into the staging pool before.
+    */
     currentStrides_[g_dhIndexCbvSrvUav] = numResources;
     if (descriptorHeaps_[g_dhIndexCbvSrvUav].GetSize() < numResources)
     {
         descriptorHeaps_[g_dhIndexCbvSrvUav].Reset(numResources);
-        dirtyBits_.descHeapCbvSrvUav = 1;
+        descriptorKeys_[g_dhIndexCbvSrvUav].assign(numResources, DescriptorKey{});
     }
+    dirtyBits_.descHeapCbvSrvUav = 1;
 
     currentStrides_[g_dhIndexSampler] = numSamplers;
     if (descriptorHeaps_[g_dhIndexSampler].GetSize() < numSamplers)
     {
         descriptorHeaps_[g_dhIndexSampler].Reset(numSamplers);
-        dirtyBits_.descHeapSampler = 1;
+        descriptorKeys_[g_dhIndexSampler].assign(numSamplers, DescriptorKey{});
     }
+    dirtyBits_.descHeapSampler = 1;
 }
 
 void D3D12DescriptorCache::Clear()
 {
     dirtyBits_.bits = ~0u;
+
+    /* Forget all tables that were copied into the staging pools, since their descriptors are returned to the shared heap */
+    for_range(heapIndex, 2u)
+    {
+        cachedTables_[heapIndex].clear();
+        cachedTableKeys_[heapIndex].clear();
+    }
 }
 
 void D3D12DescriptorCache::EmplaceDescriptor(Resource& resource, UINT location, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType)
@@ -70,19 +90,38 @@ void D3D12DescriptorCache::EmplaceDescriptor(Resource& resource, UINT location,
         case ResourceType::Buffer:
             LLGL_ASSERT(location < currentStrides_[g_dhIndexCbvSrvUav]);
             if (EmplaceBufferDescriptor(LLGL_CAST(D3D12Buffer&, resource), descriptorHeaps_[g_dhIndexCbvSrvUav].GetCpuHandleWithOffset(location), descRangeType))
+            {
+                SetDescriptorKey(g_dhIndexCbvSrvUav, location, &resource, descRangeType);
                 dirtyBits_.descHeapCbvSrvUav = 1;
+            }
             break;
 
         case ResourceType::Texture:
             LLGL_ASSERT(location < currentStrides_[g_dhIndexCbvSrvUav]);
             if (EmplaceTextureDescriptor(LLGL_CAST(D3D12Texture&, resource), descriptorHeaps_[g_dhIndexCbvSrvUav].GetCpuHandleWithOffset(location), descRangeType))
+            {
+                SetDescriptorKey(g_dhIndexCbvSrvUav, location, &resource, descRangeType);
                 dirtyBits_.descHeapCbvSrvUav = 1;
+            }
             break;
 
         case ResourceType::Sampler:
             LLGL_ASSERT(location < currentStrides_[g_dhIndexSampler]);
             if (EmplaceSamplerDescriptor(LLGL_CAST(D3D12Sampler&, resource), descriptorHeaps_[g_dhIndexSampler].GetCpuHandleWithOffset(location), descRangeType))
+            {
+                /* Identify samplers by their shared native descriptor, so tables with identical samplers are deduplicated */
+                SetDescriptorKey(g_dhIndexSampler, location, LLGL_CAST(D3D12Sampler&, resource).GetNativeDesc(), descRangeType);
                 dirtyBits_.descHeapSampler = 1;
+            }
+            break;
+
+        case ResourceType::AccelerationStructure:
+            LLGL_ASSERT(location < currentStrides_[g_dhIndexCbvSrvUav]);
+            if (EmplaceAccelerationStructureDescriptor(LLGL_CAST(D3D12AccelerationStructure&, resource), descriptorHeaps_[g_dhIndexCbvSrvUav].GetCpuHandleWithOffset(location), descRangeType))
+            {
+                SetDescriptorKey(g_dhIndexCbvSrvUav, location, &resource, descRangeType);
+                dirtyBits_.descHeapCbvSrvUav = 1;
+            }
             break;
 
         default:
@@ -90,12 +129,41 @@ void D3D12DescriptorCache::EmplaceDescriptor(Resource& resource, UINT location,
     }
 }
 
+void D3D12DescriptorCache::EmplaceBufferRangeDescriptor(
+    D3D12Buffer&                bufferD3D,
+    UINT                        location,
+    D3D12_DESCRIPTOR_RANGE_TYPE descRangeType,
+    const BufferViewDescriptor& bufferViewDesc)
+{
+    LLGL_ASSERT(location < currentStrides_[g_dhIndexCbvSrvUav]);
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle = descriptorHeaps_[g_dhIndexCbvSrvUav].GetCpuHandleWithOffset(location);
+    switch (descRangeType)
+    {
+        case D3D12_DESCRIPTOR_RANGE_TYPE_SRV:
+            bufferD3D.CreateShaderResourceView(device_, cpuDescHandle, bufferViewDesc);
+            break;
+
+        case D3D12_DESCRIPTOR_RANGE_TYPE_UAV:
+            bufferD3D.CreateUnorderedAccessView(device_, cpuDescHandle, bufferViewDesc);
+            break;
+
+        case D3D12_DESCRIPTOR_RANGE_TYPE_CBV:
+            bufferD3D.CreateConstantBufferView(device_, cpuDescHandle, bufferViewDesc);
+            break;
+
+        default:
+            return;
+    }
+    SetDescriptorKey(g_dhIndexCbvSrvUav, location, &bufferD3D, descRangeType, &bufferViewDesc);
+    dirtyBits_.descHeapCbvSrvUav = 1;
+}
+
 D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorCache::FlushCbvSrvUavDescriptors(D3D12StagingDescriptorHeapPool& descHeapPool)
 {
     if (dirtyBits_.descHeapCbvSrvUav)
     {
         dirtyBits_.descHeapCbvSrvUav = 0;
-        return descHeapPool.CopyDescriptors(descriptorHeaps_[g_dhIndexCbvSrvUav].GetCpuHandleStart(), 0, currentStrides_[g_dhIndexCbvSrvUav]);
+        return FlushDescriptors(g_dhIndexCbvSrvUav, descHeapPool);
     }
     return {};
 }
@@ -105,7 +173,7 @@ D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorCache::FlushSamplerDescriptors(D3D12S
     if (dirtyBits_.descHeapSampler)
     {
         dirtyBits_.descHeapSampler = 0;
-        return descHeapPool.CopyDescriptors(descriptorHeaps_[g_dhIndexSampler].GetCpuHandleStart(), 0, currentStrides_[g_dhIndexSampler]);
+        return FlushDescriptors(g_dhIndexSampler, descHeapPool);
     }
     return {};
 }
@@ -115,6 +183,53 @@ D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorCache::FlushSamplerDescriptors(D3D12S
  * ======= Private: =======
  */
 
+void D3D12DescriptorCache::SetDescriptorKey(
+    UINT                        heapIndex,
+    UINT                        location,
+    const void*                 object,
+    D3D12_DESCRIPTOR_RANGE_TYPE descRangeType,
+    const BufferViewDescriptor* bufferViewDesc)
+{
+    DescriptorKey& key = descriptorKeys_[heapIndex][location];
+    {
+        key.object  = static_cast<UINT64>(reinterpret_cast<std::uintptr_t>(object));
+        key.offset  = (bufferViewDesc != nullptr ? bufferViewDesc->offset : 0);
+        key.size    = (bufferViewDesc != nullptr ? bufferViewDesc->size : Constants::wholeSize);
+        key.type    = static_cast<UINT>(descRangeType);
+        key.format  = (bufferViewDesc != nullptr ? static_cast<UINT>(bufferViewDesc->format) : 0);
+    }
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorCache::FlushDescriptors(UINT heapIndex, D3D12StagingDescriptorHeapPool& descHeapPool)
+{
+    const UINT              numKeys = currentStrides_[heapIndex];
+    const DescriptorKey*    keys    = descriptorKeys_[heapIndex].data();
+    const UINT64            hash    = HashFNV1a(keys, sizeof(DescriptorKey) * numKeys);
+
+    /* Return previous copy of this descriptor table if its views are identical */
+    std::vector<DescriptorKey>& tableKeys = cachedTableKeys_[heapIndex];
+    auto it = cachedTables_[heapIndex].find(hash);
+    if (it != cachedTables_[heapIndex].end())
+    {
+        const CachedTable& table = it->second;
+        if (table.numKeys == numKeys && ::memcmp(tableKeys.data() + table.firstKey, keys, sizeof(DescriptorKey) * numKeys) == 0)
+            return table.gpuDescHandle;
+    }
+
+    /* Copy entire descriptor table with a single copy operation and remember its views */
+    const D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle = descHeapPool.CopyDescriptors(descriptorHeaps_[heapIndex].GetCpuHandleStart(), 0, numKeys);
+
+    CachedTable& table = cachedTables_[heapIndex][hash];
+    {
+        table.gpuDescHandle = gpuDescHandle;
+        table.firstKey      = tableKeys.size();
+        table.numKeys       = numKeys;
+    }
+    tableKeys.insert(tableKeys.end(), keys, keys + numKeys);
+
+    return gpuDescHandle;
+}
+
 bool D3D12DescriptorCache::EmplaceBufferDescriptor(D3D12Buffer& bufferD3D, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType)
 {
     switch (descRangeType)
@@ -166,6 +281,19 @@ bool D3D12DescriptorCache::EmplaceSamplerDescriptor(D3D12Sampler& samplerD3D, D3
     }
 }
 
+bool D3D12DescriptorCache::EmplaceAccelerationStructureDescriptor(D3D12AccelerationStructure& accelStructD3D, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType)
+{
+    switch (descRangeType)
+    {
+        case D3D12_DESCRIPTOR_RANGE_TYPE_SRV:
+            accelStructD3D.CreateShaderResourceView(device_, cpuDescHandle);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 
 } // /namespace LLGL
 
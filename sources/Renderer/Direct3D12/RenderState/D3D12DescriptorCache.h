@@ -10,6 +10,9 @@
 
 
 #include "D3D12DescriptorHeap.h"
+#include <LLGL/BufferFlags.h>
+#include <vector>
+#include <unordered_map>
 
 
 namespace LLGL
@@ -20,9 +23,14 @@ class Resource;
 class D3D12Buffer;
 class D3D12Texture;
 class D3D12Sampler;
+class D3D12AccelerationStructure;
 class D3D12StagingDescriptorHeapPool;
 
-// D3D12 descriptor heap wrapper to manage shader-visible descriptor heaps.
+/*
+D3D12 descriptor heap wrapper to manage shader-visible descriptor heaps.
+Each descriptor table that is flushed into a staging descriptor heap pool is identified by the views that were emplaced into it.
+Flushing a table that has already been copied into the same pool returns the previous GPU descriptor handle without another copy.
+*/
 class D3D12DescriptorCache
 {
 
@@ -41,12 +49,15 @@ class D3D12DescriptorCache
         // Resets the descriptor heap if the size must be increased and invalidates the cache.
         void Reset(UINT numResources, UINT numSamplers);
 
-        // Clears the cache.
+        // Clears the cache. This must be called before the staging descriptor heap pools are reset.
         void Clear();
 
         // Emplaces a descriptor into the cache for the specified resource.
         void EmplaceDescriptor(Resource& resource, UINT location, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType);
 
+        // Emplaces a descriptor into the cache for the specified buffer range.
+        void EmplaceBufferRangeDescriptor(D3D12Buffer& bufferD3D, UINT location, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType, const BufferViewDescriptor& bufferViewDesc);
+
         // Flushes any invalidated CBV/SRV/UAV descriptors into the specified descriptor heap pools.
         D3D12_GPU_DESCRIPTOR_HANDLE FlushCbvSrvUavDescriptors(D3D12StagingDescriptorHeapPool& descHeapPool);
 
@@ -61,15 +72,50 @@ class D3D12DescriptorCache
 
     private:
 
+        // Identifies the view that was emplaced at a descriptor location. The object pointer is stored as integer to avoid padding for hashing.
+        struct DescriptorKey
+        {
+            UINT64  object;
+            UINT64  offset;
+            UINT64  size;
+            UINT    type;
+            UINT    format;
+        };
+
+        // Descriptor table that has already been copied into the staging descriptor heap pool.
+        struct CachedTable
+        {
+            D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle;
+            std::size_t                 firstKey;
+            UINT                        numKeys;
+        };
+
+    private:
+
+        void SetDescriptorKey(
+            UINT                        heapIndex,
+            UINT                        location,
+            const void*                 object,
+            D3D12_DESCRIPTOR_RANGE_TYPE descRangeType,
+            const BufferViewDescriptor* bufferViewDesc = nullptr
+        );
+
+        D3D12_GPU_DESCRIPTOR_HANDLE FlushDescriptors(UINT heapIndex, D3D12StagingDescriptorHeapPool& descHeapPool);
+
         bool EmplaceBufferDescriptor(D3D12Buffer& bufferD3D, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType);
         bool EmplaceTextureDescriptor(D3D12Texture& textureD3D, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType);
         bool EmplaceSamplerDescriptor(D3D12Sampler& samplerD3D, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType);
+        bool EmplaceAccelerationStructureDescriptor(D3D12AccelerationStructure& accelStructD3D, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, D3D12_DESCRIPTOR_RANGE_TYPE descRangeType);
 
     private:
 
-        ID3D12Device*       device_             = nullptr;
-        D3D12DescriptorHeap descriptorHeaps_[2];
-        UINT                currentStrides_[2]  = {};
+        ID3D12Device*                               device_                 = nullptr;
+        D3D12DescriptorHeap                         descriptorHeaps_[2];
+        UINT                                        currentStrides_[2]      = {};
+
+        std::vector<DescriptorKey>                  descriptorKeys_[2];
+        std::unordered_map<UINT64, CachedTable>     cachedTables_[2];
+        std::vector<DescriptorKey>                  cachedTableKeys_[2];
 
         union
         {
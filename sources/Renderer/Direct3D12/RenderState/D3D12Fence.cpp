@@ -20,9 +20,9 @@ namespace LLGL
  * D3D12NativeFence
  */
 
-D3D12NativeFence::D3D12NativeFence(ID3D12Device* device, UINT64 initialValue)
+D3D12NativeFence::D3D12NativeFence(ID3D12Device* device, UINT64 initialValue, D3D12_FENCE_FLAGS flags)
 {
-    Create(device, initialValue);
+    Create(device, initialValue, flags);
 }
 
 D3D12NativeFence::~D3D12NativeFence()
@@ -30,12 +30,12 @@ D3D12NativeFence::~D3D12NativeFence()
     CloseHandle(event_);
 }
 
-void D3D12NativeFence::Create(ID3D12Device* device, UINT64 initialValue)
+void D3D12NativeFence::Create(ID3D12Device* device, UINT64 initialValue, D3D12_FENCE_FLAGS flags)
 {
     LLGL_ASSERT(native_.Get() == nullptr);
 
     /* Create D3D12 fence */
-    auto hr = device->CreateFence(initialValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(native_.ReleaseAndGetAddressOf()));
+    auto hr = device->CreateFence(initialValue, flags, IID_PPV_ARGS(native_.ReleaseAndGetAddressOf()));
     DXThrowIfCreateFailed(hr, "ID3D12Fence");
 
     /* Create Win32 event handle */
@@ -66,8 +66,8 @@ bool D3D12NativeFence::WaitForHigherSignal(UINT64 signal, DWORD timeoutMillisecs
  */
 
 D3D12Fence::D3D12Fence(ID3D12Device* device, UINT64 initialValue) :
-    native_ { device, initialValue },
-    value_  { initialValue + 1     }
+    native_ { device, initialValue, D3D12_FENCE_FLAG_SHARED },
+    value_  { initialValue                                  }
 {
 }
 
@@ -90,14 +90,20 @@ UINT64 D3D12Fence::Signal()
     return ++value_;
 }
 
+UINT64 D3D12Fence::Signal(UINT64 value)
+{
+    value_ = value;
+    return value_;
+}
+
 bool D3D12Fence::Wait(UINT64 timeout)
 {
-    if (value_ > native_.GetCompletedValue())
-    {
-        native_.WaitForSignal(value_, NanosecsToMillisecs(timeout));
-        value_ = native_.GetCompletedValue();
-    }
-    return true;
+    return Wait(value_, timeout);
+}
+
+bool D3D12Fence::Wait(UINT64 value, UINT64 timeout)
+{
+    return native_.WaitForHigherSignal(value, NanosecsToMillisecs(timeout));
 }
 
 
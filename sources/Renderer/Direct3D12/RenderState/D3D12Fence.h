@@ -30,13 +30,13 @@ class D3D12NativeFence
         D3D12NativeFence& operator = (const D3D12NativeFence&) = delete;
 
         // Constructs the native D3D12 fence and event handle. Also initializes it with an optional value.
-        D3D12NativeFence(ID3D12Device* device, UINT64 initialValue = 0);
+        D3D12NativeFence(ID3D12Device* device, UINT64 initialValue = 0, D3D12_FENCE_FLAGS flags = D3D12_FENCE_FLAG_NONE);
 
         // Destroys the native D3D12 fence and event handle.
         ~D3D12NativeFence();
 
         // Creates the native D3D12 fence and event handle.
-        void Create(ID3D12Device* device, UINT64 initialValue = 0);
+        void Create(ID3D12Device* device, UINT64 initialValue = 0, D3D12_FENCE_FLAGS flags = D3D12_FENCE_FLAG_NONE);
 
         // Waits until this fence has been signaled with the specified value.
         bool WaitForSignal(UINT64 signal, DWORD timeoutMillisecs = INFINITE);
@@ -63,7 +63,7 @@ class D3D12NativeFence
 
 };
 
-// D3D12 implementation of the <Fence> interface.
+// D3D12 implementation of the <Fence> interface. The native fence is shared, so it can be exported with RenderSystem::ExportFenceHandle.
 class D3D12Fence final : public Fence
 {
 
@@ -78,9 +78,15 @@ class D3D12Fence final : public Fence
         // Sets the next signal value.
         UINT64 Signal();
 
+        // Sets the specified signal value. This must be greater than the current signaled value.
+        UINT64 Signal(UINT64 value);
+
         // Waits until the current signaled value is completed.
         bool Wait(UINT64 timeout);
 
+        // Waits until the specified value is completed.
+        bool Wait(UINT64 value, UINT64 timeout);
+
         // Returns the native ID3D12Fence object.
         inline ID3D12Fence* GetNative() const
         {
@@ -12,6 +12,7 @@
 #include "../Shader/D3D12Shader.h"
 #include "D3D12RenderPass.h"
 #include "D3D12PipelineLayout.h"
+#include "D3D12PipelineLibrary.h"
 #include "../Command/D3D12CommandContext.h"
 #include "../D3D12Serialization.h"
 #include "../../DXCommon/DXCore.h"
@@ -37,13 +38,16 @@ D3D12GraphicsPSO::D3D12GraphicsPSO(
     D3D12PipelineLayout&                defaultPipelineLayout,
     const GraphicsPipelineDescriptor&   desc,
     const D3D12RenderPass*              defaultRenderPass,
-    Serialization::Serializer*          writer)
+    Serialization::Serializer*          writer,
+    D3D12PipelineLibrary*               pipelineLibrary,
+    bool                                isAsync,
+    PipelineState*                      fallbackPipelineState)
 :
     D3D12PipelineState { /*isGraphicsPSO:*/ true, desc.pipelineLayout, GetShadersAsArray(desc), defaultPipelineLayout }
 {
     /* Validate pointers and get D3D shader program */
-    if (desc.vertexShader == nullptr)
-        throw std::invalid_argument("cannot create D3D graphics pipeline without vertex shader");
+    if (desc.vertexShader == nullptr && desc.meshShader == nullptr)
+        throw std::invalid_argument("cannot create D3D graphics pipeline without vertex or mesh shader");
 
     /* Use either default render pass or from descriptor */
     const D3D12RenderPass* renderPassD3D = nullptr;
@@ -65,6 +69,11 @@ D3D12GraphicsPSO::D3D12GraphicsPSO(
     blendFactor_[2]     = desc.blend.blendFactor[2];
     blendFactor_[3]     = desc.blend.blendFactor[3];
 
+    /* Store shading rate; the first combiner applies to the per-primitive rate, which is not exposed, so it always passes the pipeline rate through */
+    shadingRate_                = D3D12Types::Map(desc.shadingRate.rate);
+    shadingRateCombiners_[0]    = D3D12_SHADING_RATE_COMBINER_PASSTHROUGH;
+    shadingRateCombiners_[1]    = D3D12Types::Map(desc.shadingRate.imageCombiner);
+
     /* Build static state buffer for viewports and scissors */
     if (!desc.viewports.empty() || !desc.scissors.empty())
         BuildStaticStateBuffer(desc);
@@ -77,7 +86,7 @@ D3D12GraphicsPSO::D3D12GraphicsPSO(
         pipelineLayoutD3D = &defaultPipelineLayout;
 
     /* Create native graphics PSO */
-    CreateNativePSOFromDesc(device, *pipelineLayoutD3D, renderPassD3D, desc, writer);
+    CreateNativePSOFromDesc(device, *pipelineLayoutD3D, renderPassD3D, desc, writer, pipelineLibrary, isAsync, fallbackPipelineState);
 }
 
 D3D12GraphicsPSO::D3D12GraphicsPSO(D3D12Device& device, Serialization::Deserializer& reader) :
@@ -88,6 +97,10 @@ D3D12GraphicsPSO::D3D12GraphicsPSO(D3D12Device& device, Serialization::Deseriali
 
 void D3D12GraphicsPSO::Bind(D3D12CommandContext& commandContext)
 {
+    /* Skip binding if the PSO failed to compile in the background */
+    if (GetNative() == nullptr)
+        return;
+
     /* Set root signature and pipeline state */
     commandContext.SetGraphicsRootSignature(GetRootSignature());
     commandContext.SetPipelineState(GetNative());
@@ -102,6 +115,8 @@ void D3D12GraphicsPSO::Bind(D3D12CommandContext& commandContext)
     if (blendFactorEnabled_)
         commandList->OMSetBlendFactor(blendFactor_);
 
+    commandContext.SetShadingRate(shadingRate_, shadingRateCombiners_);
+
     /* Set static viewports and scissors */
     SetStaticViewportsAndScissors(commandList);
 }
@@ -348,7 +363,8 @@ static D3D12_PRIMITIVE_TOPOLOGY_TYPE GetPrimitiveToplogyType(const PrimitiveTopo
 static D3D12_INPUT_LAYOUT_DESC GetD3DInputLayoutDesc(const Shader* vs)
 {
     D3D12_INPUT_LAYOUT_DESC desc = {};
-    LLGL_CAST(const D3D12Shader*, vs)->GetInputLayoutDesc(desc);
+    if (vs != nullptr)
+        LLGL_CAST(const D3D12Shader*, vs)->GetInputLayoutDesc(desc);
     return desc;
 }
 
@@ -362,12 +378,74 @@ static D3D12_STREAM_OUTPUT_DESC GetD3DStreamOutputDesc(const Shader* vs, const S
     return desc;
 }
 
+// Pipeline state stream subobject with pointer alignment (equivalent to CD3DX12_PIPELINE_STATE_STREAM_SUBOBJECT).
+template <D3D12_PIPELINE_STATE_SUBOBJECT_TYPE TSubobjectType, typename T>
+struct alignas(void*) D3D12PipelineStateSubobject
+{
+    D3D12_PIPELINE_STATE_SUBOBJECT_TYPE type    = TSubobjectType;
+    T                                   value   = {};
+};
+
+// Pipeline state stream for mesh pipelines, since D3D12_GRAPHICS_PIPELINE_STATE_DESC has no task and mesh shader stages.
+struct D3D12MeshPipelineStateStream
+{
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE,        ID3D12RootSignature*          > rootSignature;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS,                    D3D12_SHADER_BYTECODE         > AS;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS,                    D3D12_SHADER_BYTECODE         > MS;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS,                    D3D12_SHADER_BYTECODE         > PS;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND,                 D3D12_BLEND_DESC              > blendState;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK,           UINT                          > sampleMask;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER,            D3D12_RASTERIZER_DESC         > rasterizerState;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL,         D3D12_DEPTH_STENCIL_DESC      > depthStencilState;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY,    D3D12_PRIMITIVE_TOPOLOGY_TYPE > primitiveTopologyType;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS, D3D12_RT_FORMAT_ARRAY         > RTVFormats;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT,  DXGI_FORMAT                   > DSVFormat;
+    D3D12PipelineStateSubobject< D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC,           DXGI_SAMPLE_DESC              > sampleDesc;
+};
+
+// Converts the graphics PSO descriptor into a mesh pipeline state stream. The vertex input and pre-rasterization stages of the graphics PSO descriptor are ignored.
+static void ConvertMeshPipelineStateStream(
+    D3D12MeshPipelineStateStream&               dst,
+    const D3D12_GRAPHICS_PIPELINE_STATE_DESC&   src,
+    const D3D12_SHADER_BYTECODE&                taskShaderByteCode,
+    const D3D12_SHADER_BYTECODE&                meshShaderByteCode)
+{
+    dst.rootSignature.value         = src.pRootSignature;
+    dst.AS.value                    = taskShaderByteCode;
+    dst.MS.value                    = meshShaderByteCode;
+    dst.PS.value                    = src.PS;
+    dst.blendState.value            = src.BlendState;
+    dst.sampleMask.value            = src.SampleMask;
+    dst.rasterizerState.value       = src.RasterizerState;
+    dst.depthStencilState.value     = src.DepthStencilState;
+    dst.primitiveTopologyType.value = src.PrimitiveTopologyType;
+    dst.DSVFormat.value             = src.DSVFormat;
+    dst.sampleDesc.value            = src.SampleDesc;
+
+    dst.RTVFormats.value.NumRenderTargets = src.NumRenderTargets;
+    for_range(i, LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+        dst.RTVFormats.value.RTFormats[i] = src.RTVFormats[i];
+}
+
+static ComPtr<ID3D12PipelineState> CreateMeshPSOFromStream(D3D12Device& device, const D3D12MeshPipelineStateStream& stream)
+{
+    D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+    {
+        streamDesc.SizeInBytes                    = sizeof(stream);
+        streamDesc.pPipelineStateSubobjectStream  = const_cast<D3D12MeshPipelineStateStream*>(&stream);
+    }
+    return device.CreateDXPipelineStateFromStream(streamDesc);
+}
+
 void D3D12GraphicsPSO::CreateNativePSOFromDesc(
     D3D12Device&                        device,
     const D3D12PipelineLayout&          pipelineLayout,
     const D3D12RenderPass*              renderPass,
     const GraphicsPipelineDescriptor&   desc,
-    Serialization::Serializer*          writer)
+    Serialization::Serializer*          writer,
+    D3D12PipelineLibrary*               pipelineLibrary,
+    bool                                isAsync,
+    PipelineState*                      fallbackPipelineState)
 {
     /* Get number of render-target attachments */
     const UINT numAttachments = (renderPass != nullptr ? renderPass->GetNumColorAttachments() : 1);
@@ -411,8 +489,48 @@ void D3D12GraphicsPSO::CreateNativePSOFromDesc(
     stateDesc.SampleDesc.Count      = (renderPass != nullptr ? renderPass->GetSampleDesc().Count : 1);
     stateDesc.SampleDesc.Quality    = 0;
 
-    /* Create native PSO */
-    SetNative(device.CreateDXGraphicsPipelineState(stateDesc));
+    /* Mesh pipelines are neither stored in pipeline libraries nor serialized, since both only accept D3D12_GRAPHICS_PIPELINE_STATE_DESC */
+    if (desc.meshShader != nullptr)
+    {
+        D3D12MeshPipelineStateStream stream;
+        ConvertMeshPipelineStateStream(stream, stateDesc, GetD3DShaderByteCode(desc.taskShader), GetD3DShaderByteCode(desc.meshShader));
+        if (isAsync)
+        {
+            CreateNativeAsync(
+                [&device, stream]() -> ComPtr<ID3D12PipelineState>
+                {
+                    return CreateMeshPSOFromStream(device, stream);
+                },
+                fallbackPipelineState
+            );
+        }
+        else
+            SetNative(CreateMeshPSOFromStream(device, stream));
+        return;
+    }
+
+    /* Create native PSO on a worker thread; all pointers in the state descriptor refer to shaders and layouts that must outlive the creation */
+    if (isAsync)
+    {
+        ID3DBlob* rootSignatureBlob = pipelineLayout.GetSerializedBlob();
+        CreateNativeAsync(
+            [&device, stateDesc, rootSignatureBlob, pipelineLibrary]() -> ComPtr<ID3D12PipelineState>
+            {
+                if (pipelineLibrary != nullptr)
+                    return pipelineLibrary->CreateGraphicsPipelineState(device, stateDesc, rootSignatureBlob);
+                else
+                    return device.CreateDXGraphicsPipelineState(stateDesc);
+            },
+            fallbackPipelineState
+        );
+        return;
+    }
+
+    /* Create native PSO or load it from the pipeline library */
+    if (pipelineLibrary != nullptr)
+        SetNative(pipelineLibrary->CreateGraphicsPipelineState(device, stateDesc, pipelineLayout.GetSerializedBlob()));
+    else
+        SetNative(device.CreateDXGraphicsPipelineState(stateDesc));
 
     /* Serialize graphics PSO */
     if (writer != nullptr)
@@ -541,6 +659,8 @@ void D3D12GraphicsPSO::SerializePSO(
         writer.WriteTyped(blendFactor_);
         writer.WriteTyped(stencilRefEnabled_);
         writer.WriteTyped(stencilRef_);
+        writer.WriteTyped(shadingRate_);
+        writer.WriteTyped(shadingRateCombiners_);
         writer.WriteTyped(scissorEnabled_);
         writer.WriteTyped(numStaticViewports_);
         writer.WriteTyped(numStaticScissors_);
@@ -642,6 +762,8 @@ void D3D12GraphicsPSO::DeserializePSO(
         reader.ReadTyped(blendFactor_);
         reader.ReadTyped(stencilRefEnabled_);
         reader.ReadTyped(stencilRef_);
+        reader.ReadTyped(shadingRate_);
+        reader.ReadTyped(shadingRateCombiners_);
         reader.ReadTyped(scissorEnabled_);
         reader.ReadTyped(numStaticViewports_);
         reader.ReadTyped(numStaticScissors_);
@@ -21,6 +21,7 @@ class D3D12Device;
 class D3D12RenderPass;
 class D3D12PipelineLayout;
 class D3D12CommandContext;
+class D3D12PipelineLibrary;
 class ByteBufferIterator;
 
 class D3D12GraphicsPSO final : public D3D12PipelineState
@@ -34,7 +35,10 @@ class D3D12GraphicsPSO final : public D3D12PipelineState
             D3D12PipelineLayout&                defaultPipelineLayout,
             const GraphicsPipelineDescriptor&   desc,
             const D3D12RenderPass*              defaultRenderPass,
-            Serialization::Serializer*          writer                  = nullptr
+            Serialization::Serializer*          writer                  = nullptr,
+            D3D12PipelineLibrary*               pipelineLibrary         = nullptr,
+            bool                                isAsync                 = false,
+            PipelineState*                      fallbackPipelineState   = nullptr
         );
 
         // Constructs the graphics PSO with a deserializer of a cached PSO.
@@ -59,7 +63,10 @@ class D3D12GraphicsPSO final : public D3D12PipelineState
             const D3D12PipelineLayout&          pipelineLayout,
             const D3D12RenderPass*              renderPass,
             const GraphicsPipelineDescriptor&   desc,
-            Serialization::Serializer*          writer
+            Serialization::Serializer*          writer,
+            D3D12PipelineLibrary*               pipelineLibrary,
+            bool                                isAsync,
+            PipelineState*                      fallbackPipelineState
         );
 
         void CreateNativePSOFromCache(
@@ -99,6 +106,9 @@ class D3D12GraphicsPSO final : public D3D12PipelineState
         bool                        blendFactorEnabled_ = false;
         FLOAT                       blendFactor_[4]     = { 0.0f, 0.0f, 0.0f, 0.0f };
 
+        D3D12_SHADING_RATE          shadingRate_        = D3D12_SHADING_RATE_1X1;
+        D3D12_SHADING_RATE_COMBINER shadingRateCombiners_[2] = { D3D12_SHADING_RATE_COMBINER_PASSTHROUGH, D3D12_SHADING_RATE_COMBINER_PASSTHROUGH };
+
         std::unique_ptr<char[]>     staticStateBuffer_;
         UINT                        numStaticViewports_ = 0;
         UINT                        numStaticScissors_  = 0;
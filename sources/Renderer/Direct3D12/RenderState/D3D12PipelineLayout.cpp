@@ -11,6 +11,7 @@
 #include "../Texture/D3D12Sampler.h"
 #include "../D3DX12/d3dx12.h"
 #include "../D3D12ObjectUtils.h"
+#include "../../PipelineStateUtils.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/Assertion.h"
 #include "../../../Core/CoreUtils.h"
@@ -227,32 +228,52 @@ D3D12DescriptorHeapSetLayout D3D12PipelineLayout::GetDescriptorHeapSetLayout() c
  * ======= Private: =======
  */
 
+// Returns the number of descriptors the specified heap binding occupies per descriptor set.
+static UINT GetNumDescriptorsForHeapBinding(const PipelineLayoutDescriptor& layoutDesc, const BindingDescriptor& bindingDesc)
+{
+    return (layoutDesc.bindlessHeap ? std::max(1u, bindingDesc.arraySize) : 1u);
+}
+
+// Returns the number of descriptors all heap bindings occupy per descriptor set.
+static UINT GetNumHeapDescriptors(const PipelineLayoutDescriptor& layoutDesc)
+{
+    UINT numDescriptors = 0;
+    for (const auto& binding : layoutDesc.heapBindings)
+        numDescriptors += GetNumDescriptorsForHeapBinding(layoutDesc, binding);
+    return numDescriptors;
+}
+
 void D3D12PipelineLayout::BuildRootSignature(
     D3D12RootSignature&             rootSignature,
     const PipelineLayoutDescriptor& desc)
 {
-    /* Build root parameter table for each descriptor range type */
-    descriptorHeapMap_.resize(desc.heapBindings.size());
+    /* Build root parameter table for each descriptor range type; bindless heaps have one descriptor per array element */
+    descriptorHeapMap_.resize(GetNumHeapDescriptors(desc));
     BuildHeapRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_CBV,     desc, ResourceType::Buffer,  BindFlags::ConstantBuffer, descriptorHeapLayout_.numBufferCBV );
     BuildHeapRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::Buffer,  BindFlags::Sampled,        descriptorHeapLayout_.numBufferSRV );
+    BuildHeapRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::AccelerationStructure, 0,           descriptorHeapLayout_.numBufferSRV );
     BuildHeapRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::Texture, BindFlags::Sampled,        descriptorHeapLayout_.numTextureSRV);
     BuildHeapRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_UAV,     desc, ResourceType::Buffer,  BindFlags::Storage,        descriptorHeapLayout_.numBufferUAV );
     BuildHeapRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_UAV,     desc, ResourceType::Texture, BindFlags::Storage,        descriptorHeapLayout_.numTextureUAV);
     BuildHeapRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER, desc, ResourceType::Sampler, 0,                         descriptorHeapLayout_.numSamplers  );
 
+    /* Select which buffer bindings get their own root descriptor within the remaining root signature budget */
+    SelectRootDescriptors(desc, rootSignature.GetRootCost() + GetUniformsRootCost(desc.uniforms));
+
     /* Build root parameter for each descriptor range type */
     descriptorMap_.resize(desc.bindings.size());
     BuildRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_CBV,     desc, ResourceType::Buffer,  BindFlags::ConstantBuffer, descriptorLayout_.numBufferCBV);
     BuildRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::Buffer,  BindFlags::Sampled,        descriptorLayout_.numBufferSRV);
+    BuildRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::AccelerationStructure, 0,           descriptorLayout_.numBufferSRV);
     BuildRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::Texture, BindFlags::Sampled,        descriptorLayout_.numTextureSRV);
     BuildRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_UAV,     desc, ResourceType::Buffer,  BindFlags::Storage,        descriptorLayout_.numBufferUAV);
     BuildRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_UAV,     desc, ResourceType::Texture, BindFlags::Storage,        descriptorLayout_.numTextureUAV);
     BuildRootParameterTables(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER, desc, ResourceType::Sampler, 0,                         descriptorLayout_.numSamplers);
 
     /* Build root parameter for each standalone descriptor */
-    rootParameterMap_.resize(desc.bindings.size());
     BuildRootParameters(rootSignature, D3D12_ROOT_PARAMETER_TYPE_CBV, desc, ResourceType::Buffer, BindFlags::ConstantBuffer);
     BuildRootParameters(rootSignature, D3D12_ROOT_PARAMETER_TYPE_SRV, desc, ResourceType::Buffer, BindFlags::Sampled);
+    BuildRootParameters(rootSignature, D3D12_ROOT_PARAMETER_TYPE_SRV, desc, ResourceType::AccelerationStructure, 0);
     BuildRootParameters(rootSignature, D3D12_ROOT_PARAMETER_TYPE_UAV, desc, ResourceType::Buffer, BindFlags::Storage);
 
     /* Build static samplers */
@@ -267,6 +288,88 @@ static bool IsFilteredBinding(const BindingDescriptor& bindingDesc, const Resour
     return (bindingDesc.type == resourceType && (bindFlags == 0 || (bindingDesc.bindFlags & bindFlags) != 0));
 }
 
+// Returns the upper bound of root signature cost (in DWORDs) for the root constants of the specified uniforms, since each cbuffer field starts at most at the next 16-byte register.
+static UINT GetUniformsRootCost(const std::vector<UniformDescriptor>& uniforms)
+{
+    UINT cost = 0;
+    for (const UniformDescriptor& uniform : uniforms)
+        cost += GetAlignedSize(GetUniformTypeSize(uniform.type, uniform.arraySize), 16u) / 4u;
+    return cost;
+}
+
+// Returns the root parameter type for the specified binding if it can be bound as root descriptor, or D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE otherwise.
+static D3D12_ROOT_PARAMETER_TYPE GetRootDescriptorType(const BindingDescriptor& bindingDesc)
+{
+    if (bindingDesc.type == ResourceType::Buffer)
+    {
+        if ((bindingDesc.bindFlags & BindFlags::ConstantBuffer) != 0)
+            return D3D12_ROOT_PARAMETER_TYPE_CBV;
+        if ((bindingDesc.bindFlags & BindFlags::Sampled) != 0)
+            return D3D12_ROOT_PARAMETER_TYPE_SRV;
+        if ((bindingDesc.bindFlags & BindFlags::Storage) != 0)
+            return D3D12_ROOT_PARAMETER_TYPE_UAV;
+    }
+    else if (bindingDesc.type == ResourceType::AccelerationStructure)
+    {
+        /* Top-level acceleration structures can be bound as root SRV by their GPU virtual address */
+        return D3D12_ROOT_PARAMETER_TYPE_SRV;
+    }
+    return D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+}
+
+// Root signature cost (in DWORDs) of a root descriptor.
+static constexpr UINT g_rootDescriptorCost = 2;
+
+void D3D12PipelineLayout::SelectRootDescriptors(
+    const PipelineLayoutDescriptor& layoutDesc,
+    UINT                            rootCost)
+{
+    /* Initialize all bindings with descriptor table locations */
+    rootParameterMap_.clear();
+    rootParameterMap_.resize(layoutDesc.bindings.size(), D3D12DescriptorLocation{ D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE, 0 });
+
+    /* Add cost of descriptor tables for bindings that can never be root descriptors */
+    bool hasResourceViewTable   = false;
+    bool hasSamplerTable        = false;
+    UINT numRootDescriptors     = 0;
+
+    for (const BindingDescriptor& binding : layoutDesc.bindings)
+    {
+        if (GetRootDescriptorType(binding) != D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE)
+            ++numRootDescriptors;
+        else if (binding.type == ResourceType::Sampler)
+            hasSamplerTable = true;
+        else
+            hasResourceViewTable = true;
+    }
+
+    rootCost += (hasResourceViewTable ? 1 : 0) + (hasSamplerTable ? 1 : 0);
+
+    /* If not all buffers fit into the budget, the remaining ones need a descriptor table for resource views */
+    if (!hasResourceViewTable && rootCost + numRootDescriptors * g_rootDescriptorCost > D3D12_MAX_ROOT_COST)
+        rootCost += 1;
+
+    /* Promote constant buffers first, since they are typically rebound per draw call, then structured and raw buffers */
+    const D3D12_ROOT_PARAMETER_TYPE rootParamTypes[] =
+    {
+        D3D12_ROOT_PARAMETER_TYPE_CBV,
+        D3D12_ROOT_PARAMETER_TYPE_SRV,
+        D3D12_ROOT_PARAMETER_TYPE_UAV,
+    };
+
+    for (D3D12_ROOT_PARAMETER_TYPE rootParamType : rootParamTypes)
+    {
+        for_range(i, layoutDesc.bindings.size())
+        {
+            if (GetRootDescriptorType(layoutDesc.bindings[i]) == rootParamType && rootCost + g_rootDescriptorCost <= D3D12_MAX_ROOT_COST)
+            {
+                rootParameterMap_[i].type = rootParamType;
+                rootCost += g_rootDescriptorCost;
+            }
+        }
+    }
+}
+
 void D3D12PipelineLayout::BuildHeapRootParameterTables(
     D3D12RootSignature&             rootSignature,
     D3D12_DESCRIPTOR_RANGE_TYPE     descRangeType,
@@ -275,9 +378,13 @@ void D3D12PipelineLayout::BuildHeapRootParameterTables(
     long                            bindFlags,
     UINT&                           outCounter)
 {
+    UINT firstDescriptor = 0;
+
     for_range(i, layoutDesc.heapBindings.size())
     {
-        const auto& binding = layoutDesc.heapBindings[i];
+        const auto& binding         = layoutDesc.heapBindings[i];
+        const UINT  numDescriptors  = GetNumDescriptorsForHeapBinding(layoutDesc, binding);
+
         if (IsFilteredBinding(binding, resourceType, bindFlags))
         {
             /* Build root parameter table entry for currently seelcted resource binding */
@@ -286,12 +393,21 @@ void D3D12PipelineLayout::BuildHeapRootParameterTables(
                 /*descRangeType:*/          descRangeType,
                 /*bindingDesc:*/            binding,
                 /*maxNumDescriptorRanges:*/ static_cast<UINT>(layoutDesc.heapBindings.size()),
-                /*outLocation:*/            descriptorHeapMap_[i]
+                /*outLocation:*/            descriptorHeapMap_[firstDescriptor]
             );
 
+            /* Map each array element of a bindless heap binding to the next descriptor within the same descriptor range */
+            for_subrange(arrayElement, 1u, numDescriptors)
+            {
+                descriptorHeapMap_[firstDescriptor + arrayElement] = descriptorHeapMap_[firstDescriptor];
+                descriptorHeapMap_[firstDescriptor + arrayElement].index += arrayElement;
+            }
+
             /* Increment number of resource views for output parameter to build root parameter layout */
-            ++outCounter;
+            outCounter += numDescriptors;
         }
+
+        firstDescriptor += numDescriptors;
     }
 }
 
@@ -330,11 +446,6 @@ void D3D12PipelineLayout::BuildHeapRootParameterTableEntry(
     descriptorHeapLayout_.GetDescriptorLocation(descRangeType, outLocation);
 }
 
-static bool CanResourceHaveRootParameter(const ResourceType resourceType, long bindFlags)
-{
-    return (resourceType == ResourceType::Buffer);
-}
-
 void D3D12PipelineLayout::BuildRootParameterTables(
     D3D12RootSignature&             rootSignature,
     D3D12_DESCRIPTOR_RANGE_TYPE     descRangeType,
@@ -348,8 +459,8 @@ void D3D12PipelineLayout::BuildRootParameterTables(
         const auto& binding = layoutDesc.bindings[i];
         if (IsFilteredBinding(binding, resourceType, bindFlags))
         {
-            /* If resource binding cannot have its own root parameter, it must be put into a descriptor table */
-            if (!CanResourceHaveRootParameter(resourceType, bindFlags))
+            /* If resource binding does not have its own root parameter, it must be put into a descriptor table */
+            if (rootParameterMap_[i].type == D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE)
             {
                 BuildRootParameterTableEntry(
                     /*rootSignature:*/  rootSignature,
@@ -419,8 +530,8 @@ void D3D12PipelineLayout::BuildRootParameters(
         const auto& binding = layoutDesc.bindings[i];
         if (IsFilteredBinding(binding, resourceType, bindFlags))
         {
-            /* If resource binding cannot have its own root parameter, it must be put into a descriptor table */
-            if (CanResourceHaveRootParameter(resourceType, bindFlags))
+            /* Only bindings that were selected for a root descriptor of this type get their own root parameter */
+            if (rootParameterMap_[i].type == rootParamType)
             {
                 BuildRootParameter(
                     /*rootSignature:*/  rootSignature,
@@ -220,6 +220,11 @@ class D3D12PipelineLayout final : public PipelineLayout
             D3D12DescriptorHeapLocation&    outLocation
         );
 
+        void SelectRootDescriptors(
+            const PipelineLayoutDescriptor& layoutDesc,
+            UINT                            rootCost
+        );
+
         void BuildRootParameterTables(
             D3D12RootSignature&             rootSignature,
             D3D12_DESCRIPTOR_RANGE_TYPE     descRangeType,
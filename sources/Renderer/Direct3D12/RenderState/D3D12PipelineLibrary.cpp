@@ -0,0 +1,220 @@
+/*
+ * D3D12PipelineLibrary.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "D3D12PipelineLibrary.h"
+#include "../D3D12Device.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <string.h>
+#include <wchar.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal functions
+ */
+
+// 64-bit FNV-1a hash with helpers for shader byte code and blobs, to derive stable pipeline names across multiple runs
+struct D3D12PipelineHasher : public FNV1aHasher
+{
+    void AppendByteCode(const D3D12_SHADER_BYTECODE& byteCode)
+    {
+        AppendValue(byteCode.BytecodeLength);
+        if (byteCode.pShaderBytecode != nullptr)
+            Append(byteCode.pShaderBytecode, byteCode.BytecodeLength);
+    }
+
+    void AppendBlob(ID3DBlob* blob)
+    {
+        if (blob != nullptr)
+            Append(blob->GetBufferPointer(), blob->GetBufferSize());
+    }
+};
+
+static void HashGraphicsPipelineDesc(D3D12PipelineHasher& hasher, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    hasher.AppendByteCode(desc.VS);
+    hasher.AppendByteCode(desc.PS);
+    hasher.AppendByteCode(desc.DS);
+    hasher.AppendByteCode(desc.HS);
+    hasher.AppendByteCode(desc.GS);
+
+    for_range(i, desc.StreamOutput.NumEntries)
+    {
+        const D3D12_SO_DECLARATION_ENTRY& entry = desc.StreamOutput.pSODeclaration[i];
+        hasher.AppendValue(entry.Stream);
+        hasher.AppendString(entry.SemanticName);
+        hasher.AppendValue(entry.SemanticIndex);
+        hasher.AppendValue(entry.StartComponent);
+        hasher.AppendValue(entry.ComponentCount);
+        hasher.AppendValue(entry.OutputSlot);
+    }
+    for_range(i, desc.StreamOutput.NumStrides)
+        hasher.AppendValue(desc.StreamOutput.pBufferStrides[i]);
+    hasher.AppendValue(desc.StreamOutput.RasterizedStream);
+
+    /* State descriptors are zero-initialized by the caller, so their padding bytes are deterministic */
+    hasher.AppendValue(desc.BlendState);
+    hasher.AppendValue(desc.SampleMask);
+    hasher.AppendValue(desc.RasterizerState);
+    hasher.AppendValue(desc.DepthStencilState);
+
+    for_range(i, desc.InputLayout.NumElements)
+    {
+        const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+        hasher.AppendString(element.SemanticName);
+        hasher.AppendValue(element.SemanticIndex);
+        hasher.AppendValue(element.Format);
+        hasher.AppendValue(element.InputSlot);
+        hasher.AppendValue(element.AlignedByteOffset);
+        hasher.AppendValue(element.InputSlotClass);
+        hasher.AppendValue(element.InstanceDataStepRate);
+    }
+
+    hasher.AppendValue(desc.IBStripCutValue);
+    hasher.AppendValue(desc.PrimitiveTopologyType);
+    hasher.AppendValue(desc.NumRenderTargets);
+    hasher.AppendValue(desc.RTVFormats);
+    hasher.AppendValue(desc.DSVFormat);
+    hasher.AppendValue(desc.SampleDesc);
+    hasher.AppendValue(desc.NodeMask);
+    hasher.AppendValue(desc.Flags);
+}
+
+// Writes the pipeline name for the specified hash, e.g. L"LLGL.GraphicsPSO.0123456789ABCDEF".
+static void GetPipelineName(wchar_t (&outName)[64], const wchar_t* prefix, UINT64 hash)
+{
+    ::swprintf(outName, 64, L"LLGL.%ls.%016llX", prefix, static_cast<unsigned long long>(hash));
+}
+
+
+/*
+ * D3D12PipelineLibrary class
+ */
+
+void D3D12PipelineLibrary::Create(ID3D12Device* device, const void* initialData, std::size_t initialDataSize)
+{
+    /* Pipeline libraries require ID3D12Device1; fall back to regular PSO creation otherwise */
+    ComPtr<ID3D12Device1> device1;
+    if (FAILED(device->QueryInterface(IID_PPV_ARGS(device1.ReleaseAndGetAddressOf()))))
+        return;
+
+    /* Keep a copy of the initial data, since the native library references it until it is released */
+    if (initialData != nullptr && initialDataSize > 0)
+    {
+        initialData_.resize(initialDataSize);
+        ::memcpy(initialData_.data(), initialData, initialDataSize);
+
+        HRESULT hr = device1->CreatePipelineLibrary(initialData_.data(), initialData_.size(), IID_PPV_ARGS(library_.ReleaseAndGetAddressOf()));
+        if (SUCCEEDED(hr))
+            return;
+
+        /* Initial data is incompatible with this adapter or driver version, or it is corrupted; start with an empty library */
+        initialData_.clear();
+    }
+
+    HRESULT hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(library_.ReleaseAndGetAddressOf()));
+    if (FAILED(hr))
+        library_.Reset();
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineLibrary::CreateGraphicsPipelineState(
+    D3D12Device&                                device,
+    const D3D12_GRAPHICS_PIPELINE_STATE_DESC&   desc,
+    ID3DBlob*                                   rootSignatureBlob)
+{
+    if (!IsValid())
+        return device.CreateDXGraphicsPipelineState(desc);
+
+    D3D12PipelineHasher hasher;
+    hasher.AppendBlob(rootSignatureBlob);
+    HashGraphicsPipelineDesc(hasher, desc);
+
+    wchar_t name[64];
+    GetPipelineName(name, L"GraphicsPSO", hasher.value);
+
+    /* Load PSO from library; this fails with E_INVALIDARG if the name is unknown or the descriptor does not match */
+    ComPtr<ID3D12PipelineState> pipelineState;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        if (SUCCEEDED(library_->LoadGraphicsPipeline(name, &desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()))))
+            return pipelineState;
+    }
+
+    /* Create new PSO and store it in the library; a name collision only means this PSO is not cached */
+    pipelineState = device.CreateDXGraphicsPipelineState(desc);
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        library_->StorePipeline(name, pipelineState.Get());
+    }
+
+    return pipelineState;
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineLibrary::CreateComputePipelineState(
+    D3D12Device&                                device,
+    const D3D12_COMPUTE_PIPELINE_STATE_DESC&    desc,
+    ID3DBlob*                                   rootSignatureBlob)
+{
+    if (!IsValid())
+        return device.CreateDXComputePipelineState(desc);
+
+    D3D12PipelineHasher hasher;
+    hasher.AppendBlob(rootSignatureBlob);
+    hasher.AppendByteCode(desc.CS);
+    hasher.AppendValue(desc.NodeMask);
+    hasher.AppendValue(desc.Flags);
+
+    wchar_t name[64];
+    GetPipelineName(name, L"ComputePSO", hasher.value);
+
+    /* Load PSO from library; this fails with E_INVALIDARG if the name is unknown or the descriptor does not match */
+    ComPtr<ID3D12PipelineState> pipelineState;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        if (SUCCEEDED(library_->LoadComputePipeline(name, &desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()))))
+            return pipelineState;
+    }
+
+    /* Create new PSO and store it in the library; a name collision only means this PSO is not cached */
+    pipelineState = device.CreateDXComputePipelineState(desc);
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        library_->StorePipeline(name, pipelineState.Get());
+    }
+
+    return pipelineState;
+}
+
+Blob D3D12PipelineLibrary::Serialize() const
+{
+    if (!IsValid())
+        return Blob{};
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    std::vector<char> data(library_->GetSerializedSize());
+    if (data.empty())
+        return Blob{};
+
+    HRESULT hr = library_->Serialize(data.data(), data.size());
+    if (FAILED(hr))
+        return Blob{};
+
+    return Blob::CreateStrongRef(std::move(data));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,87 @@
+/*
+ * D3D12PipelineLibrary.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_D3D12_PIPELINE_LIBRARY_H
+#define LLGL_D3D12_PIPELINE_LIBRARY_H
+
+
+#include <LLGL/Blob.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+class D3D12Device;
+
+/*
+Wrapper for an ID3D12PipelineLibrary that is shared by all pipeline state objects of a device.
+Each PSO is stored under a name that is derived from a hash of its native state descriptor and root signature,
+so pipelines are found again in the serialized library across multiple runs of the application.
+If the library cannot be created, e.g. because the device does not support ID3D12Device1, all PSOs are created without it.
+Loading and storing PSOs is synchronized, since PSOs can be created concurrently on worker threads with CreatePipelineStateAsync.
+*/
+class D3D12PipelineLibrary
+{
+
+    public:
+
+        D3D12PipelineLibrary() = default;
+
+        D3D12PipelineLibrary(const D3D12PipelineLibrary&) = delete;
+        D3D12PipelineLibrary& operator = (const D3D12PipelineLibrary&) = delete;
+
+        /*
+        Creates the native pipeline library with optional initial data from a previous run.
+        The data is ignored if it was created with a different adapter or driver version or is corrupted.
+        */
+        void Create(ID3D12Device* device, const void* initialData, std::size_t initialDataSize);
+
+        // Loads the graphics PSO from the library or creates it with the device and stores it in the library.
+        ComPtr<ID3D12PipelineState> CreateGraphicsPipelineState(
+            D3D12Device&                                device,
+            const D3D12_GRAPHICS_PIPELINE_STATE_DESC&   desc,
+            ID3DBlob*                                   rootSignatureBlob
+        );
+
+        // Loads the compute PSO from the library or creates it with the device and stores it in the library.
+        ComPtr<ID3D12PipelineState> CreateComputePipelineState(
+            D3D12Device&                                device,
+            const D3D12_COMPUTE_PIPELINE_STATE_DESC&    desc,
+            ID3DBlob*                                   rootSignatureBlob
+        );
+
+        // Returns the serialized pipeline library or an empty blob if there is no native library.
+        Blob Serialize() const;
+
+        // Returns true if the native pipeline library has been created successfully.
+        inline bool IsValid() const
+        {
+            return (library_.Get() != nullptr);
+        }
+
+    private:
+
+        ComPtr<ID3D12PipelineLibrary>   library_;
+        std::vector<char>               initialData_;   // ID3D12PipelineLibrary references the initial data for its entire lifetime.
+        mutable std::mutex              mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
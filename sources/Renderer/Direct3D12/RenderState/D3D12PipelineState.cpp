@@ -59,16 +59,48 @@ D3D12PipelineState::D3D12PipelineState(
     DXThrowIfFailed(hr, "failed to create D3D12 root signature");
 }
 
+D3D12PipelineState::~D3D12PipelineState()
+{
+    /* Drop pending creation or wait until the worker has finished with this PSO */
+    if (creationTask_)
+        creationTask_->Cancel();
+}
+
 void D3D12PipelineState::SetName(const char* name)
 {
+    Wait();
     D3D12SetObjectName(native_.Get(), name);
 }
 
 const Report* D3D12PipelineState::GetReport() const
 {
+    if (creationTask_)
+        creationTask_->Wait();
     return (*report_.GetText() != '\0' || report_.HasErrors() ? &report_ : nullptr);
 }
 
+bool D3D12PipelineState::IsReady() const
+{
+    return (!creationTask_ || creationTask_->IsDone());
+}
+
+void D3D12PipelineState::Wait()
+{
+    if (creationTask_)
+        creationTask_->Wait();
+}
+
+D3D12PipelineState& D3D12PipelineState::GetReadyOrFallback()
+{
+    if (creationTask_ && !creationTask_->IsDone())
+    {
+        if (fallback_ != nullptr)
+            return fallback_->GetReadyOrFallback();
+        creationTask_->Wait();
+    }
+    return *this;
+}
+
 void D3D12PipelineState::SetNative(ComPtr<ID3D12PipelineState>&& native)
 {
     native_ = std::move(native);
@@ -79,6 +111,26 @@ void D3D12PipelineState::ResetReport(std::string&& text, bool hasErrors)
     ResetReportWithNewline(report_, std::forward<std::string&&>(text), hasErrors);
 }
 
+void D3D12PipelineState::CreateNativeAsync(const std::function<ComPtr<ID3D12PipelineState>()>& createFunc, PipelineState* fallbackPipelineState)
+{
+    if (fallbackPipelineState != nullptr)
+        fallback_ = LLGL_CAST(D3D12PipelineState*, fallbackPipelineState);
+
+    creationTask_ = DoAsync(
+        [this, createFunc]()
+        {
+            try
+            {
+                SetNative(createFunc());
+            }
+            catch (const std::exception& e)
+            {
+                ResetReport(e.what(), true);
+            }
+        }
+    );
+}
+
 
 } // /namespace LLGL
 
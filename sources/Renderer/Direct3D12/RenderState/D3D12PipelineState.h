@@ -16,8 +16,10 @@
 #include "D3D12PipelineLayout.h"
 #include "../../DXCommon/ComPtr.h"
 #include "../../Serialization.h"
+#include "../../../Core/Threading.h"
 #include <d3d12.h>
 #include <memory>
+#include <functional>
 
 
 namespace LLGL
@@ -33,9 +35,19 @@ class D3D12PipelineState : public PipelineState
 
         void SetName(const char* name) override final;
         const Report* GetReport() const override final;
+        bool IsReady() const override final;
+        void Wait() override final;
 
     public:
 
+        ~D3D12PipelineState();
+
+        /*
+        Returns this PSO if it has been created or if it has no fallback, in which case this blocks until it has been created.
+        Otherwise, returns the fallback PSO that is bound in place of this PSO while it is still being created in the background.
+        */
+        D3D12PipelineState& GetReadyOrFallback();
+
         // Binds the natvie PSO to the specified command context.
         virtual void Bind(D3D12CommandContext& commandContext) = 0;
 
@@ -78,6 +90,12 @@ class D3D12PipelineState : public PipelineState
         // Writes the report with the specified message and error bit.
         void ResetReport(std::string&& text, bool hasErrors = false);
 
+        /*
+        Runs the specified function to create the native PSO on the worker thread pool and stores its result. Creation errors are written to the report.
+        The function must only access the state of this base class, since the task is cancelled or waited on in its destructor.
+        */
+        void CreateNativeAsync(const std::function<ComPtr<ID3D12PipelineState>()>& createFunc, PipelineState* fallbackPipelineState);
+
         // Returns the native PSO object.
         inline ID3D12PipelineState* GetNative() const
         {
@@ -99,6 +117,9 @@ class D3D12PipelineState : public PipelineState
         std::vector<D3D12RootConstantLocation>  rootConstantMap_;
         Report                                  report_;
 
+        AsyncTaskSPtr                           creationTask_;
+        D3D12PipelineState*                     fallback_       = nullptr;
+
 };
 
 
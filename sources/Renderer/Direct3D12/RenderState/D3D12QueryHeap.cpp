@@ -95,31 +95,35 @@ void D3D12QueryHeap::SetName(const char* name)
 
 void D3D12QueryHeap::Begin(ID3D12GraphicsCommandList* commandList, UINT query)
 {
-    /* Begin query section or call "EndQuery" for a single timestamp */
+    /* Begin query section or call "EndQuery" for the start timestamp; single timestamps are only written in End() */
     if (nativeType_ == D3D12_QUERY_TYPE_TIMESTAMP)
-        commandList->EndQuery(GetNative(), GetNativeType(), query * queryPerType_);
+    {
+        if (queryPerType_ == 2)
+            commandList->EndQuery(GetNative(), GetNativeType(), query * queryPerType_);
+    }
     else
         commandList->BeginQuery(GetNative(), GetNativeType(), query * queryPerType_);
-
-    /* Mark specified query data as 'dirty' */
-    MarkDirtyRange(query, 1);
 }
 
 void D3D12QueryHeap::End(ID3D12GraphicsCommandList* commandList, UINT query)
 {
-    /* End query section or call "EndQuery" on another timestamp to get elapsed time range */
+    /* End query section or call "EndQuery" on the last timestamp of this query to get elapsed time range */
     if (nativeType_ == D3D12_QUERY_TYPE_TIMESTAMP)
-        commandList->EndQuery(GetNative(), GetNativeType(), query * queryPerType_ + 1);
+        commandList->EndQuery(GetNative(), GetNativeType(), query * queryPerType_ + (queryPerType_ - 1));
     else
         commandList->EndQuery(GetNative(), GetNativeType(), query * queryPerType_);
+
+    /* Mark specified query data as 'dirty' */
+    MarkDirtyRange(query, 1);
 }
 
-void D3D12QueryHeap::FlushDirtyRange(ID3D12GraphicsCommandList* commandList)
+void D3D12QueryHeap::FlushDirtyRange(ID3D12GraphicsCommandList* commandList, ID3D12Fence* fence, UINT64 fenceValue)
 {
     if (HasDirtyRange())
     {
-        /* Resolve query data within the dirty range, then invalidate range */
+        /* Resolve query data within the dirty range, then track the range until the GPU has completed the command list */
         ResolveData(commandList, dirtyRange_[0], (dirtyRange_[1] - dirtyRange_[0]));
+        pendingResolves_.push_back(PendingResolve{ fence, fenceValue, dirtyRange_[0], dirtyRange_[1] });
         InvalidateDirtyRange();
     }
 }
@@ -135,6 +139,34 @@ bool D3D12QueryHeap::InsideDirtyRange(UINT firstQuery, UINT numQueries) const
     return (firstQuery + numQueries > dirtyRange_[0] && firstQuery < dirtyRange_[1]);
 }
 
+bool D3D12QueryHeap::IsResultAvailable(UINT firstQuery, UINT numQueries)
+{
+    /* Queries that have not been resolved yet are still part of a command buffer that is being encoded */
+    if (InsideDirtyRange(firstQuery, numQueries))
+        return false;
+
+    /* Drop all resolves the GPU has completed, then check if any remaining resolve overlaps with [first, count) */
+    pendingResolves_.erase(
+        std::remove_if(
+            pendingResolves_.begin(),
+            pendingResolves_.end(),
+            [](const PendingResolve& entry)
+            {
+                return (entry.fence->GetCompletedValue() >= entry.fenceValue);
+            }
+        ),
+        pendingResolves_.end()
+    );
+
+    for (const PendingResolve& entry : pendingResolves_)
+    {
+        if (firstQuery + numQueries > entry.firstQuery && firstQuery < entry.endQuery)
+            return false;
+    }
+
+    return true;
+}
+
 void* D3D12QueryHeap::Map(UINT firstQuery, UINT numQueries)
 {
     void* mappedData = nullptr;
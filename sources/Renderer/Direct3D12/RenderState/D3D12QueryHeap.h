@@ -12,6 +12,7 @@
 #include <LLGL/QueryHeap.h>
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
+#include <vector>
 
 
 namespace LLGL
@@ -34,8 +35,12 @@ class D3D12QueryHeap final : public QueryHeap
         void Begin(ID3D12GraphicsCommandList* commandList, UINT query);
         void End(ID3D12GraphicsCommandList* commandList, UINT query);
 
-        // Resolves all queries if not already done.
-        void FlushDirtyRange(ID3D12GraphicsCommandList* commandList);
+        /*
+        Resolves all queries if not already done.
+        The resolved results are available once the specified fence has been signaled with the specified value,
+        i.e. once the GPU has completed the command list.
+        */
+        void FlushDirtyRange(ID3D12GraphicsCommandList* commandList, ID3D12Fence* fence, UINT64 fenceValue);
 
         // Returns true if this query heap has a dirty range that must be resolved before the query data can be retrieved.
         bool HasDirtyRange() const;
@@ -43,6 +48,9 @@ class D3D12QueryHeap final : public QueryHeap
         // Returns true if the specified range of queries overlaps with the dirty range.
         bool InsideDirtyRange(UINT firstQuery, UINT numQueries) const;
 
+        // Returns true if the results of the specified range of queries have been resolved and the GPU has completed the respective command lists.
+        bool IsResultAvailable(UINT firstQuery, UINT numQueries);
+
         // Maps the query result buffer to CPU local memory.
         void* Map(UINT firstQuery, UINT numQueries);
         void Unmap();
@@ -74,6 +82,17 @@ class D3D12QueryHeap final : public QueryHeap
             return isPredicate_;
         }
 
+    private:
+
+        // Range of queries that has been resolved in a command list the GPU may not have completed yet.
+        struct PendingResolve
+        {
+            ComPtr<ID3D12Fence> fence;
+            UINT64              fenceValue;
+            UINT                firstQuery;
+            UINT                endQuery;
+        };
+
     private:
 
         void InvalidateDirtyRange();
@@ -102,6 +121,7 @@ class D3D12QueryHeap final : public QueryHeap
         UINT                    queryPerType_   = 1;
         bool                    isPredicate_    = false;
         UINT                    dirtyRange_[2]  = {};       // Begin/end range of queries that need to be resolved
+        std::vector<PendingResolve> pendingResolves_;
 
 };
 
@@ -23,6 +23,14 @@ namespace LLGL
 {
 
 
+constexpr std::uint32_t D3D12RenderPass::discardDepthStencilBit;
+
+// Returns true if the previous content of the specified attachment is not needed, or if the attachment is unused.
+static bool IsAttachmentDiscardable(const AttachmentFormatDescriptor& attachmentDesc)
+{
+    return (attachmentDesc.format == Format::Undefined || attachmentDesc.loadOp == AttachmentLoadOp::Undefined);
+}
+
 D3D12RenderPass::D3D12RenderPass(
     const D3D12Device& device,
     const RenderPassDescriptor& desc)
@@ -48,6 +56,20 @@ void D3D12RenderPass::BuildAttachments(
     if (desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
         clearFlagsDSV_ |= D3D12_CLEAR_FLAG_STENCIL;
 
+    /* Check which attachments can be discarded; depth and stencil share the same resource, so both must be discardable */
+    discardMask_ = 0;
+    for_range(i, numColorAttachments_)
+    {
+        if (desc.colorAttachments[i].loadOp == AttachmentLoadOp::Undefined)
+            discardMask_ |= (1u << i);
+    }
+    if ((desc.depthAttachment.format != Format::Undefined || desc.stencilAttachment.format != Format::Undefined) &&
+        IsAttachmentDiscardable(desc.depthAttachment) &&
+        IsAttachmentDiscardable(desc.stencilAttachment))
+    {
+        discardMask_ |= D3D12RenderPass::discardDepthStencilBit;
+    }
+
     /* Store native color formats */
     for_range(i, numColorAttachments_)
         SetRTVFormat(DXTypes::ToDXGIFormat(desc.colorAttachments[i].format), i);
@@ -79,8 +101,9 @@ void D3D12RenderPass::BuildAttachments(
     const DXGI_FORMAT       depthStencilFormat,
     const DXGI_SAMPLE_DESC& sampleDesc)
 {
-    /* Reset clear flags */
-    clearFlagsDSV_ = 0;
+    /* Reset clear flags; default render passes load all attachments */
+    clearFlagsDSV_  = 0;
+    discardMask_    = 0;
     ResetClearColorAttachmentIndices(LLGL_MAX_NUM_COLOR_ATTACHMENTS, clearColorAttachments_);
 
     /* Store color attachment formats */
@@ -26,6 +26,11 @@ class D3D12Device;
 class D3D12RenderPass final : public RenderPass
 {
 
+    public:
+
+        // Bit of the discard mask for the depth-stencil attachment; bits 0 to 7 denote the color attachments.
+        static constexpr std::uint32_t discardDepthStencilBit = (1u << LLGL_MAX_NUM_COLOR_ATTACHMENTS);
+
     public:
 
         D3D12RenderPass() = default;
@@ -68,6 +73,12 @@ class D3D12RenderPass final : public RenderPass
             return clearColorAttachments_;
         }
 
+        // Returns the bitmask of attachments whose previous content can be discarded when the render pass begins, i.e. attachments with AttachmentLoadOp::Undefined.
+        inline std::uint32_t GetDiscardMask() const
+        {
+            return discardMask_;
+        }
+
         // Returns the array of native color formats.
         inline const DXGI_FORMAT* GetRTVFormats() const
         {
@@ -97,6 +108,7 @@ class D3D12RenderPass final : public RenderPass
 
         UINT                clearFlagsDSV_                                          = 0;
         std::uint8_t        clearColorAttachments_[LLGL_MAX_NUM_COLOR_ATTACHMENTS]  = {};
+        std::uint32_t       discardMask_                                            = 0;
 
         DXGI_FORMAT         rtvFormats_[LLGL_MAX_NUM_COLOR_ATTACHMENTS]             = {};
         DXGI_FORMAT         dsvFormat_                                              = DXGI_FORMAT_UNKNOWN;
@@ -10,6 +10,7 @@
 #include "D3D12DescriptorHeap.h"
 #include "../D3D12ObjectUtils.h"
 #include "../Buffer/D3D12Buffer.h"
+#include "../Buffer/D3D12AccelerationStructure.h"
 #include "../Texture/D3D12Sampler.h"
 #include "../Texture/D3D12Texture.h"
 #include "../../DXCommon/DXCore.h"
@@ -45,6 +46,12 @@ D3D12ResourceHeap::D3D12ResourceHeap(
 
     numDescriptorSets_ = numResourceViews / numBindings;
 
+    /*
+    Descriptors are copied into a shader-visible heap whenever this heap is bound, so pending command lists never refer to these descriptors
+    and multiple versions are not required. Only concurrent writes and bindings must be synchronized.
+    */
+    isSynchronized_ = (desc.numVersions > 1);
+
     /* Store meta data which pipelines will be used by this resource heap */
     auto convolutedStageFlags = pipelineLayoutD3D->GetConvolutedStageFlags();
 
@@ -98,6 +105,8 @@ std::uint32_t D3D12ResourceHeap::CreateResourceViewHandles(
     if (firstDescriptor + resourceViews.size() > numDescriptors)
         return 0;
 
+    std::unique_lock<std::mutex> descriptorLock = LockDescriptors();
+
     /* Get CPU descriptor heap starts */
     D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle = {};
     D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandles[2] = {};
@@ -206,6 +215,14 @@ ID3D12DescriptorHeap* D3D12ResourceHeap::GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP
     return descriptorHeaps_[static_cast<UINT>(heapType)].Get();
 }
 
+std::unique_lock<std::mutex> D3D12ResourceHeap::LockDescriptors()
+{
+    if (isSynchronized_)
+        return std::unique_lock<std::mutex>{ mutex_ };
+    else
+        return std::unique_lock<std::mutex>{};
+}
+
 void D3D12ResourceHeap::SetName(const char* name)
 {
     D3D12SetObjectNameSubscript(descriptorHeaps_[0].Get(), name, ".ResourceViews");
@@ -284,6 +301,13 @@ bool D3D12ResourceHeap::CreateShaderResourceView(ID3D12Device* device, D3D12_CPU
             return true;
         }
     }
+    else if (resource.GetResourceType() == ResourceType::AccelerationStructure)
+    {
+        /* Create shader resource view (SRV) for D3D acceleration structure */
+        auto& accelStructD3D = LLGL_CAST(D3D12AccelerationStructure&, resource);
+        accelStructD3D.CreateShaderResourceView(device, cpuDescHandle);
+        return true;
+    }
     return false;
 }
 
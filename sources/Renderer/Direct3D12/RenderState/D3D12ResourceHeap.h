@@ -16,6 +16,7 @@
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
 #include <vector>
+#include <mutex>
 #include <cstddef>
 
 
@@ -61,6 +62,12 @@ class D3D12ResourceHeap final : public ResourceHeap
         // Returns the native D3D descriptor heap for the specified heap type.
         ID3D12DescriptorHeap* GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE heapType) const;
 
+        /*
+        Returns a lock that must be held while the descriptors of this heap are copied for binding.
+        The lock is only acquired if this heap can be written from multiple threads (see ResourceHeapDescriptor::numVersions).
+        */
+        std::unique_lock<std::mutex> LockDescriptors();
+
     private:
 
         struct BindingHandleLocation
@@ -120,6 +127,9 @@ class D3D12ResourceHeap final : public ResourceHeap
         std::vector<char>                           barriers_;                          // Packed buffer for dyanmic struct { UINT N; D3D12_RESOURCE_BARRIER[N]; }
         UINT                                        barrierStride_              = 0;
 
+        std::mutex                                  mutex_;                             // Guards descriptors and barriers if 'isSynchronized_' is true
+        bool                                        isSynchronized_             = false;
+
 };
 
 
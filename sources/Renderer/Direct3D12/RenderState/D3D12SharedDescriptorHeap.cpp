@@ -0,0 +1,112 @@
+/*
+ * D3D12SharedDescriptorHeap.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "D3D12SharedDescriptorHeap.h"
+#include "../../../Core/Assertion.h"
+#include <LLGL/Utils/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+constexpr UINT D3D12SharedDescriptorHeap::maxNumContiguousPages;
+
+// Returns a bit mask with the lower N bits set.
+static std::uint64_t GetPageRunMask(UINT numPages)
+{
+    return (numPages >= 64 ? ~0ull : ((1ull << numPages) - 1ull));
+}
+
+// Returns the lowest bit index of a range of free pages in the specified mask, or 64 if there is no such range.
+static UINT FindFreePageRun(std::uint64_t mask, UINT numPages, std::uint64_t runMask)
+{
+    if (numPages == 1)
+    {
+        /* Fast path for single pages: Find lowest zero bit */
+        const std::uint64_t freeBits = ~mask;
+        if (freeBits == 0)
+            return 64;
+        UINT bit = 0;
+        while ((freeBits & (1ull << bit)) == 0)
+            ++bit;
+        return bit;
+    }
+
+    for (UINT bit = 0; bit + numPages <= 64; ++bit)
+    {
+        if ((mask & (runMask << bit)) == 0)
+            return bit;
+    }
+
+    return 64;
+}
+
+void D3D12SharedDescriptorHeap::Create(
+    ID3D12Device*               device,
+    D3D12_DESCRIPTOR_HEAP_TYPE  type,
+    UINT                        numPages,
+    UINT                        pageSize)
+{
+    LLGL_ASSERT(numPages > 0);
+    LLGL_ASSERT(pageSize > 0);
+
+    D3D12DescriptorHeap::Create(device, type, numPages * pageSize, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE);
+
+    /* Mark all pages as free and the trailing bits of the last mask as allocated */
+    numPageMasks_   = (numPages + 63) / 64;
+    pageSize_       = pageSize;
+    pageMasks_      = std::unique_ptr<std::atomic<std::uint64_t>[]>{ new std::atomic<std::uint64_t>[numPageMasks_] };
+
+    for_range(i, numPageMasks_)
+        pageMasks_[i].store(0, std::memory_order_relaxed);
+
+    if (const UINT numTrailingPages = numPages % 64)
+        pageMasks_[numPageMasks_ - 1].store(~GetPageRunMask(numTrailingPages), std::memory_order_relaxed);
+}
+
+bool D3D12SharedDescriptorHeap::AllocPages(UINT numPages, UINT& outFirstPage)
+{
+    LLGL_ASSERT(numPages > 0 && numPages <= D3D12SharedDescriptorHeap::maxNumContiguousPages);
+
+    const std::uint64_t runMask = GetPageRunMask(numPages);
+
+    for_range(i, numPageMasks_)
+    {
+        std::uint64_t mask = pageMasks_[i].load(std::memory_order_relaxed);
+        while (mask != ~0ull)
+        {
+            const UINT bit = FindFreePageRun(mask, numPages, runMask);
+            if (bit == 64)
+                break;
+
+            /* Try to claim the pages; on failure, 'mask' is updated with the current value and the search is repeated */
+            if (pageMasks_[i].compare_exchange_weak(mask, mask | (runMask << bit), std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                outFirstPage = i * 64 + bit;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void D3D12SharedDescriptorHeap::FreePages(UINT firstPage, UINT numPages)
+{
+    const UINT maskIndex = firstPage / 64;
+    const UINT bit = firstPage % 64;
+    LLGL_ASSERT(maskIndex < numPageMasks_ && bit + numPages <= 64);
+    pageMasks_[maskIndex].fetch_and(~(GetPageRunMask(numPages) << bit), std::memory_order_release);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
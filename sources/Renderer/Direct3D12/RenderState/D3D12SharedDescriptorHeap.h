@@ -0,0 +1,104 @@
+/*
+ * D3D12SharedDescriptorHeap.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_D3D12_SHARED_DESCRIPTOR_HEAP_H
+#define LLGL_D3D12_SHARED_DESCRIPTOR_HEAP_H
+
+
+#include "D3D12DescriptorHeap.h"
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Shader-visible descriptor heap that is shared across all command contexts of a device.
+The heap is divided into pages of equal size that are allocated and freed without locking,
+so command buffers can be recorded on multiple threads without creating descriptor heaps on the hot path.
+Pages must only be freed once the GPU has completed all command lists that reference them.
+*/
+class D3D12SharedDescriptorHeap final : private D3D12DescriptorHeap
+{
+
+    public:
+
+        // Maximum number of pages that can be allocated as a single contiguous range.
+        static constexpr UINT maxNumContiguousPages = 64;
+
+    public:
+
+        D3D12SharedDescriptorHeap() = default;
+
+        // Creates the native shader-visible descriptor heap with the specified number of pages and marks all pages as free.
+        void Create(
+            ID3D12Device*               device,
+            D3D12_DESCRIPTOR_HEAP_TYPE  type,
+            UINT                        numPages,
+            UINT                        pageSize
+        );
+
+        /*
+        Allocates the specified number of contiguous pages and returns the index of the first page in 'outFirstPage'.
+        Returns false if the heap has no contiguous range of free pages with the specified size left.
+        */
+        bool AllocPages(UINT numPages, UINT& outFirstPage);
+
+        // Returns the specified range of pages to the heap.
+        void FreePages(UINT firstPage, UINT numPages);
+
+        // Returns the CPU descriptor handle at the specified position within this heap.
+        inline D3D12_CPU_DESCRIPTOR_HANDLE GetCpuHandleWithOffset(UINT offset) const
+        {
+            return D3D12DescriptorHeap::GetCpuHandleWithOffset(offset);
+        }
+
+        // Returns the GPU descriptor handle at the specified position within this heap.
+        inline D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandleWithOffset(UINT offset) const
+        {
+            return D3D12DescriptorHeap::GetGpuHandleWithOffset(offset);
+        }
+
+        // Returns the native D3D descriptor heap.
+        inline ID3D12DescriptorHeap* GetNative() const
+        {
+            return D3D12DescriptorHeap::GetNative();
+        }
+
+        // Returns the native D3D12 descriptor heap type.
+        inline D3D12_DESCRIPTOR_HEAP_TYPE GetType() const
+        {
+            return D3D12DescriptorHeap::GetType();
+        }
+
+        // Returns the size (in number of descriptors) of each page.
+        inline UINT GetPageSize() const
+        {
+            return pageSize_;
+        }
+
+    private:
+
+        // Each bit denotes whether the respective page is allocated.
+        std::unique_ptr<std::atomic<std::uint64_t>[]>   pageMasks_;
+        UINT                                            numPageMasks_   = 0;
+        UINT                                            pageSize_       = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,9 +6,9 @@
  */
 
 #include "D3D12StagingDescriptorHeapPool.h"
-#include "../D3D12Device.h"
+#include "D3D12SharedDescriptorHeap.h"
 #include "../../../Core/Assertion.h"
-#include "../../../Core/CoreUtils.h"
+#include "../../../Core/Exception.h"
 #include <algorithm>
 
 
@@ -16,62 +16,36 @@ namespace LLGL
 {
 
 
-// Returns the maximum number of descriptor for the specified type
-static UINT GetMaxDescriptorHeapSize(D3D12_DESCRIPTOR_HEAP_TYPE type)
+D3D12StagingDescriptorHeapPool::D3D12StagingDescriptorHeapPool(ID3D12Device* device, D3D12SharedDescriptorHeap& sharedHeap)
 {
-    switch (type)
-    {
-        case D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER:    return 2048;
-        default:                                    return UINT_MAX;
-    }
+    InitializeDevice(device, sharedHeap);
 }
 
-// Returns the initial descriptor heap size for the specified type
-static UINT GetInitialDescriptorHeapSize(D3D12_DESCRIPTOR_HEAP_TYPE type)
+D3D12StagingDescriptorHeapPool::~D3D12StagingDescriptorHeapPool()
 {
-    switch (type)
-    {
-        case D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER:    return 128;
-        default:                                    return 4096;
-    }
+    Reset();
 }
 
-D3D12StagingDescriptorHeapPool::D3D12StagingDescriptorHeapPool(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type)
+void D3D12StagingDescriptorHeapPool::InitializeDevice(ID3D12Device* device, D3D12SharedDescriptorHeap& sharedHeap)
 {
-    InitializeDevice(device, type);
-}
-
-void D3D12StagingDescriptorHeapPool::InitializeDevice(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type)
-{
-    chunks_.clear();
+    Reset();
     device_     = device;
-    type_       = type;
-    chunkSize_  = GetInitialDescriptorHeapSize(type);
-    AllocChunk(chunkSize_);
+    sharedHeap_ = &sharedHeap;
 }
 
 void D3D12StagingDescriptorHeapPool::Reset()
 {
-    pendingOffset_ = 0;
-
-    if (chunks_.size() > 1)
+    /* Return all pages to the shared heap; they are allocated again on demand */
+    if (sharedHeap_ != nullptr)
     {
-        /* Try to consolidate chunks into a single one */
-        UINT accumulatedSize = 0;
-        for (const auto& chunk : chunks_)
-            accumulatedSize += chunk.GetSize();
-
-        if (accumulatedSize <= GetMaxDescriptorHeapSize(type_))
-        {
-            /* Create single chunk with accumulated size */
-            chunks_.clear();
-            AllocChunk(accumulatedSize);
-        }
-        else
-            ResetChunks();
+        for (const PageRange& range : pageRanges_)
+            sharedHeap_->FreePages(range.firstPage, range.numPages);
     }
-    else
-        ResetChunks();
+    pageRanges_.clear();
+    rangeStart_     = 0;
+    rangeSize_      = 0;
+    offset_         = 0;
+    pendingOffset_  = 0;
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE D3D12StagingDescriptorHeapPool::CopyDescriptors(
@@ -80,43 +54,44 @@ D3D12_GPU_DESCRIPTOR_HANDLE D3D12StagingDescriptorHeapPool::CopyDescriptors(
     UINT                        numDescriptors)
 {
     LLGL_ASSERT_PTR(device_);
+    LLGL_ASSERT_PTR(sharedHeap_);
 
     /* Apply pending offset */
-    IncrementOffset(pendingOffset_);
-
-    /* Find a chunk that fits the requested data size or allocate a new chunk */
-    while (chunkIdx_ < chunks_.size() && !chunks_[chunkIdx_].Capacity(firstDescriptor + numDescriptors))
-        ++chunkIdx_;
+    offset_ += pendingOffset_;
+    pendingOffset_ = 0;
 
-    if (chunkIdx_ == chunks_.size())
-        AllocChunk(numDescriptors);
+    /* Allocate new pages if the current page range cannot fit the requested descriptors */
+    const UINT numRequiredDescriptors = firstDescriptor + numDescriptors;
+    if (pageRanges_.empty() || offset_ + numRequiredDescriptors > rangeSize_)
+        AllocPages(numRequiredDescriptors);
 
-    /* Copy descriptors into current chunk */
-    chunks_[chunkIdx_].CopyDescriptors(device_, srcDescHandle, firstDescriptor, numDescriptors);
+    /* Copy descriptors from source to shared descriptor heap */
+    D3D12_CPU_DESCRIPTOR_HANDLE dstDescHandle = sharedHeap_->GetCpuHandleWithOffset(rangeStart_ + offset_ + firstDescriptor);
+    device_->CopyDescriptorsSimple(numDescriptors, dstDescHandle, srcDescHandle, sharedHeap_->GetType());
 
     /* Store pending offset to be applied with the next copy operation */
-    pendingOffset_ = numDescriptors;
+    pendingOffset_ = numRequiredDescriptors;
 
     return GetGpuHandleWithOffset();
 }
 
 ID3D12DescriptorHeap* D3D12StagingDescriptorHeapPool::GetDescriptorHeap() const
 {
-    return (chunkIdx_ < chunks_.size() ? chunks_.back().GetNative() : nullptr);
+    return (sharedHeap_ != nullptr ? sharedHeap_->GetNative() : nullptr);
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE D3D12StagingDescriptorHeapPool::GetGpuHandleWithOffset() const
 {
-    if (chunkIdx_ < chunks_.size())
-        return chunks_[chunkIdx_].GetGpuHandleWithOffset();
+    if (!pageRanges_.empty())
+        return sharedHeap_->GetGpuHandleWithOffset(rangeStart_ + offset_);
     else
         return {};
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE D3D12StagingDescriptorHeapPool::GetCpuHandleWithOffset(UINT descriptor) const
 {
-    if (chunkIdx_ < chunks_.size())
-        return chunks_[chunkIdx_].GetCpuHandleWithOffset(descriptor);
+    if (!pageRanges_.empty())
+        return sharedHeap_->GetCpuHandleWithOffset(rangeStart_ + offset_ + descriptor);
     else
         return {};
 }
@@ -126,25 +101,22 @@ D3D12_CPU_DESCRIPTOR_HANDLE D3D12StagingDescriptorHeapPool::GetCpuHandleWithOffs
  * ======= Private: =======
  */
 
-void D3D12StagingDescriptorHeapPool::AllocChunk(UINT minNumDescriptors)
+void D3D12StagingDescriptorHeapPool::AllocPages(UINT minNumDescriptors)
 {
-    chunkSize_ = std::max(chunkSize_, minNumDescriptors);
-    chunks_.emplace_back(device_, type_, chunkSize_);
-    chunkIdx_ = chunks_.size() - 1;
-}
+    const UINT pageSize = sharedHeap_->GetPageSize();
+    const UINT numPages = std::max(1u, (minNumDescriptors + pageSize - 1) / pageSize);
 
-void D3D12StagingDescriptorHeapPool::ResetChunks()
-{
-    /* Reset offsets of existing chunks */
-    for (auto& chunk : chunks_)
-        chunk.ResetOffset();
-    chunkIdx_ = 0;
-}
+    if (numPages > D3D12SharedDescriptorHeap::maxNumContiguousPages)
+        LLGL_TRAP("cannot allocate %u descriptors from shared D3D12 descriptor heap; limit is %u", minNumDescriptors, D3D12SharedDescriptorHeap::maxNumContiguousPages * pageSize);
 
-void D3D12StagingDescriptorHeapPool::IncrementOffset(UINT stride)
-{
-    if (chunkIdx_ < chunks_.size())
-        chunks_[chunkIdx_].IncrementOffset(stride);
+    UINT firstPage = 0;
+    if (!sharedHeap_->AllocPages(numPages, firstPage))
+        LLGL_TRAP("shared D3D12 descriptor heap exhausted; too many command buffers are in flight");
+
+    pageRanges_.push_back(PageRange{ firstPage, numPages });
+    rangeStart_ = firstPage * pageSize;
+    rangeSize_  = numPages * pageSize;
+    offset_     = 0;
 }
 
 
@@ -9,7 +9,6 @@
 #define LLGL_D3D12_STAGING_DESCRIPTOR_HEAP_POOL_H
 
 
-#include "D3D12StagingDescriptorHeap.h"
 #include <d3d12.h>
 #include <vector>
 
@@ -18,9 +17,12 @@ namespace LLGL
 {
 
 
+class D3D12SharedDescriptorHeap;
+
 /*
-Pool of D3D12 staging descriptor heaps.
-The number of chunks in this pools is preferrably always 1, so the initial chunk should be allocated with a decent size.
+Pool of shader-visible descriptors for a single command allocator.
+Descriptors are allocated in pages from the shared descriptor heap of the device, so all pools bind the same native heap.
+All pages are returned to the shared heap on Reset, which must only be called once the GPU has completed the respective command allocator.
 */
 class D3D12StagingDescriptorHeapPool
 {
@@ -28,12 +30,18 @@ class D3D12StagingDescriptorHeapPool
     public:
 
         D3D12StagingDescriptorHeapPool() = default;
-        D3D12StagingDescriptorHeapPool(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type);
+        D3D12StagingDescriptorHeapPool(ID3D12Device* device, D3D12SharedDescriptorHeap& sharedHeap);
+
+        D3D12StagingDescriptorHeapPool(const D3D12StagingDescriptorHeapPool&) = delete;
+        D3D12StagingDescriptorHeapPool& operator = (const D3D12StagingDescriptorHeapPool&) = delete;
 
-        // Initializes the device object and chunk size.
-        void InitializeDevice(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type);
+        // Returns all pages to the shared descriptor heap.
+        ~D3D12StagingDescriptorHeapPool();
 
-        // Resets all chunks in the pool.
+        // Initializes the device object and the shared descriptor heap pages are allocated from.
+        void InitializeDevice(ID3D12Device* device, D3D12SharedDescriptorHeap& sharedHeap);
+
+        // Returns all pages to the shared descriptor heap.
         void Reset();
 
         // Copies the specified source descriptors into the native D3D descriptor heap.
@@ -43,7 +51,7 @@ class D3D12StagingDescriptorHeapPool
             UINT                        numDescriptors
         );
 
-        // Returns the current descriptor heap that was used for the last CopyDescriptors operation.
+        // Returns the shared descriptor heap. This is the same heap for all pools of the same type.
         ID3D12DescriptorHeap* GetDescriptorHeap() const;
 
         // Returns the GPU descriptor handle at the current offset.
@@ -54,25 +62,28 @@ class D3D12StagingDescriptorHeapPool
 
     private:
 
-        // Allocates a new chunk with the specified minimal size.
-        void AllocChunk(UINT minNumDescriptors);
+        struct PageRange
+        {
+            UINT firstPage;
+            UINT numPages;
+        };
 
-        // Restes all previously allocated chunks.
-        void ResetChunks();
+    private:
 
-        // Increments the offset for the next range of descriptor handles.
-        void IncrementOffset(UINT stride);
+        // Allocates a new range of pages from the shared heap that fits the specified number of descriptors.
+        void AllocPages(UINT minNumDescriptors);
 
     private:
 
-        ID3D12Device*                           device_         = nullptr;
-        D3D12_DESCRIPTOR_HEAP_TYPE              type_           = D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES;
+        ID3D12Device*               device_         = nullptr;
+        D3D12SharedDescriptorHeap*  sharedHeap_     = nullptr;
 
-        std::vector<D3D12StagingDescriptorHeap> chunks_;
-        std::size_t                             chunkIdx_       = 0;
-        UINT                                    chunkSize_      = 0;
+        std::vector<PageRange>      pageRanges_;                // All page ranges that are in use by this pool
+        UINT                        rangeStart_     = 0;        // Index of the first descriptor of the current page range
+        UINT                        rangeSize_      = 0;        // Number of descriptors of the current page range
+        UINT                        offset_         = 0;        // Offset within the current page range
 
-        UINT                                    pendingOffset_  = 0;
+        UINT                        pendingOffset_  = 0;
 
 };
 
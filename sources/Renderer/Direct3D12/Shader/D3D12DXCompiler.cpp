@@ -0,0 +1,244 @@
+/*
+ * D3D12DXCompiler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "D3D12DXCompiler.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../../Core/StringUtils.h"
+#include <LLGL/ShaderFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include <string>
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+D3D12DXCompiler& D3D12DXCompiler::Get()
+{
+    static D3D12DXCompiler instance;
+    return instance;
+}
+
+bool D3D12DXCompiler::IsDXILProfile(const char* target)
+{
+    /* Target profiles have the form "<stage>_<major>_<minor>", e.g. "vs_6_0" or "lib_6_3" */
+    if (target == nullptr)
+        return false;
+    const char* major = ::strchr(target, '_');
+    return (major != nullptr && major[1] >= '6' && major[1] <= '9');
+}
+
+bool D3D12DXCompiler::IsDXILByteCode(const void* data, std::size_t size)
+{
+    /* Container header: FourCC, 16 byte digest, version, container size, part count, followed by the part offsets */
+    constexpr std::size_t headerSize = 32;
+    if (data == nullptr || size < headerSize)
+        return false;
+
+    const char* bytes = static_cast<const char*>(data);
+    if (::memcmp(bytes, "DXBC", 4) != 0)
+        return false;
+
+    UINT32 numParts = 0;
+    ::memcpy(&numParts, bytes + 28, sizeof(numParts));
+    if (numParts > (size - headerSize) / sizeof(UINT32))
+        return false;
+
+    for_range(i, numParts)
+    {
+        UINT32 partOffset = 0;
+        ::memcpy(&partOffset, bytes + headerSize + i * sizeof(UINT32), sizeof(partOffset));
+        if (partOffset <= size - 4 && ::memcmp(bytes + partOffset, "DXIL", 4) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+bool D3D12DXCompiler::IsAvailable()
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    return LoadCompiler();
+}
+
+void D3D12DXCompiler::Clear()
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    compiler_.Reset();
+    utils_.Reset();
+    if (module_ != nullptr)
+    {
+        ::FreeLibrary(module_);
+        module_ = nullptr;
+    }
+    loaded_ = false;
+}
+
+// Appends the DXC arguments for the specified ShaderCompileFlags entries.
+static void AppendCompilerFlagArgs(std::vector<std::wstring>& args, int flags)
+{
+    if ((flags & ShaderCompileFlags::Debug) != 0)
+    {
+        args.push_back(L"-Zi");
+        args.push_back(L"-Qembed_debug");
+    }
+
+    if ((flags & ShaderCompileFlags::NoOptimization) != 0)
+        args.push_back(L"-Od");
+    else if ((flags & ShaderCompileFlags::OptimizationLevel1) != 0)
+        args.push_back(L"-O1");
+    else if ((flags & ShaderCompileFlags::OptimizationLevel2) != 0)
+        args.push_back(L"-O2");
+    else if ((flags & ShaderCompileFlags::OptimizationLevel3) != 0)
+        args.push_back(L"-O3");
+
+    if ((flags & ShaderCompileFlags::WarningsAreErrors) != 0)
+        args.push_back(L"-WX");
+}
+
+HRESULT D3D12DXCompiler::Compile(
+    const char*             source,
+    std::size_t             sourceLength,
+    const D3D_SHADER_MACRO* defines,
+    const char*             entryPoint,
+    const char*             target,
+    int                     flags,
+    ID3DBlob**              outByteCode,
+    ID3DBlob**              outErrors)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (!LoadCompiler())
+    {
+        const char* info = "DXC is not available: failed to load dxcompiler.dll for shader model 6.0 or later";
+        if (outErrors != nullptr)
+            *outErrors = DXCreateBlob(info, ::strlen(info)).Detach();
+        return E_NOINTERFACE;
+    }
+
+    /* Convert compiler arguments; DXC only accepts wide strings */
+    std::vector<std::wstring> args;
+    {
+        args.push_back(L"-E");
+        args.push_back(ToUTF16String(entryPoint != nullptr ? entryPoint : "main"));
+        args.push_back(L"-T");
+        args.push_back(ToUTF16String(target));
+
+        if (defines != nullptr)
+        {
+            for (const D3D_SHADER_MACRO* macro = defines; macro->Name != nullptr; ++macro)
+            {
+                args.push_back(L"-D");
+                if (macro->Definition != nullptr)
+                    args.push_back(ToUTF16String(std::string(macro->Name) + "=" + macro->Definition));
+                else
+                    args.push_back(ToUTF16String(macro->Name));
+            }
+        }
+
+        AppendCompilerFlagArgs(args, flags);
+    }
+
+    std::vector<LPCWSTR> argPtrs;
+    argPtrs.reserve(args.size());
+    for (const std::wstring& arg : args)
+        argPtrs.push_back(arg.c_str());
+
+    DxcBuffer sourceBuffer;
+    {
+        sourceBuffer.Ptr        = source;
+        sourceBuffer.Size       = sourceLength;
+        sourceBuffer.Encoding   = DXC_CP_UTF8;
+    }
+
+    ComPtr<IDxcResult> result;
+    HRESULT hr = compiler_->Compile(
+        &sourceBuffer,
+        argPtrs.data(),
+        static_cast<UINT32>(argPtrs.size()),
+        nullptr,
+        IID_PPV_ARGS(result.GetAddressOf())
+    );
+    if (FAILED(hr))
+        return hr;
+
+    /* Copy messages and object into D3D blobs, so they can be used the same way as the output of D3DCompile */
+    ComPtr<IDxcBlobUtf8> errors;
+    if (outErrors != nullptr && SUCCEEDED(result->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(errors.GetAddressOf()), nullptr)) && errors != nullptr)
+        *outErrors = DXCreateBlob(errors->GetStringPointer(), errors->GetStringLength()).Detach();
+
+    HRESULT status = S_OK;
+    result->GetStatus(&status);
+    if (FAILED(status))
+        return status;
+
+    ComPtr<IDxcBlob> object;
+    hr = result->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(object.GetAddressOf()), nullptr);
+    if (FAILED(hr) || object == nullptr || object->GetBufferSize() == 0)
+        return E_FAIL;
+
+    *outByteCode = DXCreateBlob(object->GetBufferPointer(), object->GetBufferSize()).Detach();
+
+    return S_OK;
+}
+
+HRESULT D3D12DXCompiler::Reflect(const void* data, std::size_t size, ID3D12ShaderReflection** outReflection)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (!LoadCompiler())
+        return E_NOINTERFACE;
+
+    DxcBuffer byteCodeBuffer;
+    {
+        byteCodeBuffer.Ptr      = data;
+        byteCodeBuffer.Size     = size;
+        byteCodeBuffer.Encoding = 0;
+    }
+    return utils_->CreateReflection(&byteCodeBuffer, IID_PPV_ARGS(outReflection));
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool D3D12DXCompiler::LoadCompiler()
+{
+    if (loaded_)
+        return (compiler_ != nullptr);
+
+    /* Only attempt to load the library once */
+    loaded_ = true;
+
+    module_ = ::LoadLibraryA("dxcompiler.dll");
+    if (module_ == nullptr)
+        return false;
+
+    auto createInstance = reinterpret_cast<DxcCreateInstanceProc>(::GetProcAddress(module_, "DxcCreateInstance"));
+    if (createInstance == nullptr ||
+        FAILED(createInstance(CLSID_DxcCompiler, IID_PPV_ARGS(compiler_.ReleaseAndGetAddressOf()))) ||
+        FAILED(createInstance(CLSID_DxcUtils, IID_PPV_ARGS(utils_.ReleaseAndGetAddressOf()))))
+    {
+        compiler_.Reset();
+        utils_.Reset();
+        ::FreeLibrary(module_);
+        module_ = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,95 @@
+/*
+ * D3D12DXCompiler.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_D3D12_DX_COMPILER_H
+#define LLGL_D3D12_DX_COMPILER_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <d3d12shader.h>
+#include <dxcapi.h>
+#include <mutex>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+DirectX shader compiler (DXC) singleton to compile HLSL for shader model 6.0 and later into DXIL.
+The compiler is loaded from "dxcompiler.dll" on first use, so the D3D12 backend has no hard dependency on it.
+*/
+class D3D12DXCompiler
+{
+
+    public:
+
+        // Returns the singleton instance.
+        static D3D12DXCompiler& Get();
+
+        // Returns true if the specified target profile denotes shader model 6.0 or later, e.g. "cs_6_0", which can only be compiled with DXC.
+        static bool IsDXILProfile(const char* target);
+
+        // Returns true if the specified shader bytecode is a container with a DXIL part, i.e. it was compiled with DXC.
+        static bool IsDXILByteCode(const void* data, std::size_t size);
+
+    public:
+
+        D3D12DXCompiler(const D3D12DXCompiler&) = delete;
+        D3D12DXCompiler& operator = (const D3D12DXCompiler&) = delete;
+
+        D3D12DXCompiler(D3D12DXCompiler&&) = delete;
+        D3D12DXCompiler& operator = (D3D12DXCompiler&&) = delete;
+
+        // Loads the compiler library if this has not been attempted yet and returns true if it is available.
+        bool IsAvailable();
+
+        // Releases the compiler and unloads its library (used by D3D12RenderSystem).
+        void Clear();
+
+        // Compiles the specified HLSL source code with DXC. The flags are a bitwise OR combination of ShaderCompileFlags entries.
+        HRESULT Compile(
+            const char*             source,
+            std::size_t             sourceLength,
+            const D3D_SHADER_MACRO* defines,
+            const char*             entryPoint,
+            const char*             target,
+            int                     flags,
+            ID3DBlob**              outByteCode,
+            ID3DBlob**              outErrors
+        );
+
+        // Creates the shader reflection for the specified DXIL bytecode, since D3DReflect only supports DXBC.
+        HRESULT Reflect(const void* data, std::size_t size, ID3D12ShaderReflection** outReflection);
+
+    private:
+
+        D3D12DXCompiler() = default;
+
+        bool LoadCompiler();
+
+    private:
+
+        std::mutex              mutex_;         // DXC interfaces must not be used by multiple threads at the same time
+        bool                    loaded_         = false;
+        HMODULE                 module_         = nullptr;
+        ComPtr<IDxcCompiler3>   compiler_;
+        ComPtr<IDxcUtils>       utils_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -149,6 +149,8 @@ D3D12_SHADER_VISIBILITY D3D12RootParameter::FindSuitableVisibility(long stageFla
         case StageFlags::TessEvaluationStage:   return D3D12_SHADER_VISIBILITY_DOMAIN;
         case StageFlags::GeometryStage:         return D3D12_SHADER_VISIBILITY_GEOMETRY;
         case StageFlags::FragmentStage:         return D3D12_SHADER_VISIBILITY_PIXEL;
+        case StageFlags::TaskStage:             return D3D12_SHADER_VISIBILITY_AMPLIFICATION;
+        case StageFlags::MeshStage:             return D3D12_SHADER_VISIBILITY_MESH;
         default:                                return D3D12_SHADER_VISIBILITY_ALL; // Visibility to all stages by default
     }
 }
@@ -86,6 +86,28 @@ D3D12RootParameter* D3D12RootSignature::FindCompatibleRootParameter(
     return nullptr;
 }
 
+UINT D3D12RootSignature::GetRootCost() const
+{
+    /* Descriptor tables cost 1 DWORD, root descriptors 2 DWORDs, and root constants 1 DWORD per 32-bit value */
+    UINT cost = 0;
+    for (const D3D12_ROOT_PARAMETER& rootParam : nativeRootParams_)
+    {
+        switch (rootParam.ParameterType)
+        {
+            case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+                cost += 1;
+                break;
+            case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+                cost += rootParam.Constants.Num32BitValues;
+                break;
+            default:
+                cost += 2;
+                break;
+        }
+    }
+    return cost;
+}
+
 D3D12_STATIC_SAMPLER_DESC* D3D12RootSignature::AppendStaticSampler()
 {
     D3D12_STATIC_SAMPLER_DESC samplerDesc;
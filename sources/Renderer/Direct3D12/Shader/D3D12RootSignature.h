@@ -74,6 +74,9 @@ class D3D12RootSignature
             return rootParams_.size();
         }
 
+        // Returns the size (in DWORDs) of all root parameters. This must not exceed D3D12_MAX_ROOT_COST.
+        UINT GetRootCost() const;
+
     private:
 
         SmallVector<D3D12_ROOT_PARAMETER, 4u>       nativeRootParams_;
@@ -9,6 +9,8 @@
 #include "../D3D12Types.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../DXCommon/DXTypes.h"
+#include "../../DXCommon/DXShaderCache.h"
+#include "D3D12DXCompiler.h"
 #include "../../../Core/CoreUtils.h"
 #include "../../../Core/ReportUtils.h"
 #include <LLGL/Utils/ForRange.h>
@@ -21,10 +23,10 @@ namespace LLGL
 {
 
 
-D3D12Shader::D3D12Shader(const ShaderDescriptor& desc) :
+D3D12Shader::D3D12Shader(const ShaderDescriptor& desc, const DXShaderCache& shaderCache) :
     Shader { desc.type }
 {
-    if (BuildShader(desc))
+    if (BuildShader(desc, shaderCache))
     {
         if (GetType() == ShaderType::Vertex || GetType() == ShaderType::Geometry)
         {
@@ -111,10 +113,10 @@ HRESULT D3D12Shader::ReflectAndCacheConstantBuffers(const std::vector<D3D12Const
  * ======= Private: =======
  */
 
-bool D3D12Shader::BuildShader(const ShaderDescriptor& shaderDesc)
+bool D3D12Shader::BuildShader(const ShaderDescriptor& shaderDesc, const DXShaderCache& shaderCache)
 {
     if (IsShaderSourceCode(shaderDesc.sourceType))
-        return CompileSource(shaderDesc);
+        return CompileSource(shaderDesc, shaderCache);
     else
         return LoadBinary(shaderDesc);
 }
@@ -233,7 +235,7 @@ void D3D12Shader::BuildStreamOutput(UINT numVertexAttribs, const VertexAttribute
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/dd607324(v=vs.85).aspx
-bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc)
+bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc, const DXShaderCache& shaderCache)
 {
     /* Get source code */
     std::string fileContent;
@@ -258,21 +260,38 @@ bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc)
     auto        defines = reinterpret_cast<const D3D_SHADER_MACRO*>(shaderDesc.defines);
     auto        flags   = shaderDesc.flags;
 
-    /* Compile shader code */
     ComPtr<ID3DBlob> errors;
-    auto hr = D3DCompile(
-        sourceCode,
-        sourceLength,
-        nullptr,                            // LPCSTR               pSourceName
-        defines,                            // D3D_SHADER_MACRO*    pDefines
-        nullptr,                            // ID3DInclude*         pInclude
-        entry,                              // LPCSTR               pEntrypoint
-        target,                             // LPCSTR               pTarget
-        DXGetCompilerFlags(flags),          // UINT                 Flags1
-        0,                                  // UINT                 Flags2 (recommended to always be 0)
-        byteCode_.ReleaseAndGetAddressOf(), // ID3DBlob**           ppCode
-        errors.ReleaseAndGetAddressOf()     // ID3DBlob**           ppErrorMsgs
-    );
+    HRESULT hr = S_OK;
+
+    isDXIL_ = D3D12DXCompiler::IsDXILProfile(target);
+    if (isDXIL_)
+    {
+        /* Compile shader model 6.0 and later with DXC into DXIL */
+        hr = D3D12DXCompiler::Get().Compile(
+            sourceCode,
+            sourceLength,
+            defines,
+            entry,
+            target,
+            flags,
+            byteCode_.ReleaseAndGetAddressOf(),
+            errors.ReleaseAndGetAddressOf()
+        );
+    }
+    else
+    {
+        /* Compile shader code with FXC or load it from the shader cache */
+        hr = shaderCache.Compile(
+            sourceCode,
+            sourceLength,
+            defines,
+            entry,
+            target,
+            DXGetCompilerFlags(flags),
+            byteCode_.ReleaseAndGetAddressOf(),
+            errors.ReleaseAndGetAddressOf()
+        );
+    }
 
     /* Return true if compilation was successful */
     const bool hasErrors = FAILED(hr);
@@ -292,7 +311,12 @@ bool D3D12Shader::LoadBinary(const ShaderDescriptor& shaderDesc)
         /* Copy binary code into container and create native shader */
         byteCode_ = DXCreateBlob(shaderDesc.source, shaderDesc.sourceSize);
     }
-    return (byteCode_.Get() != nullptr && byteCode_->GetBufferSize() > 0);
+
+    if (byteCode_.Get() == nullptr || byteCode_->GetBufferSize() == 0)
+        return false;
+
+    isDXIL_ = D3D12DXCompiler::IsDXILByteCode(byteCode_->GetBufferPointer(), byteCode_->GetBufferSize());
+    return true;
 }
 
 /*
@@ -549,13 +573,21 @@ static HRESULT ReflectShaderInputBindings(
     return S_OK;
 }
 
+HRESULT D3D12Shader::CreateReflectionObject(ComPtr<ID3D12ShaderReflection>& outReflectionObject) const
+{
+    if (isDXIL_)
+        return D3D12DXCompiler::Get().Reflect(byteCode_->GetBufferPointer(), byteCode_->GetBufferSize(), outReflectionObject.ReleaseAndGetAddressOf());
+    else
+        return D3DReflect(byteCode_->GetBufferPointer(), byteCode_->GetBufferSize(), IID_PPV_ARGS(outReflectionObject.ReleaseAndGetAddressOf()));
+}
+
 HRESULT D3D12Shader::ReflectShaderByteCode(ShaderReflection& reflection) const
 {
     HRESULT hr = S_OK;
 
     /* Get shader reflection */
     ComPtr<ID3D12ShaderReflection> reflectionObject;
-    hr = D3DReflect(byteCode_->GetBufferPointer(), byteCode_->GetBufferSize(), IID_PPV_ARGS(reflectionObject.ReleaseAndGetAddressOf()));
+    hr = CreateReflectionObject(reflectionObject);
     if (FAILED(hr))
         return hr;
 
@@ -603,7 +635,7 @@ HRESULT D3D12Shader::ReflectConstantBuffers(std::vector<D3D12ConstantBufferRefle
 
     /* Get shader reflection */
     ComPtr<ID3D12ShaderReflection> reflectionObject;
-    hr = D3DReflect(byteCode_->GetBufferPointer(), byteCode_->GetBufferSize(), IID_PPV_ARGS(reflectionObject.ReleaseAndGetAddressOf()));
+    hr = CreateReflectionObject(reflectionObject);
     if (FAILED(hr))
         return hr;
 
@@ -24,6 +24,8 @@ namespace LLGL
 {
 
 
+class DXShaderCache;
+
 struct D3D12ConstantReflection
 {
     std::string name;   // Name of the constant buffer field.
@@ -46,7 +48,7 @@ class D3D12Shader final : public Shader
 
     public:
 
-        D3D12Shader(const ShaderDescriptor& desc);
+        D3D12Shader(const ShaderDescriptor& desc, const DXShaderCache& shaderCache);
 
     public:
 
@@ -60,14 +62,17 @@ class D3D12Shader final : public Shader
 
     private:
 
-        bool BuildShader(const ShaderDescriptor& shaderDesc);
+        bool BuildShader(const ShaderDescriptor& shaderDesc, const DXShaderCache& shaderCache);
         void ReserveVertexAttribs(const ShaderDescriptor& shaderDesc);
         void BuildInputLayout(UINT numVertexAttribs, const VertexAttribute* vertexAttribs);
         void BuildStreamOutput(UINT numVertexAttribs, const VertexAttribute* vertexAttribs);
 
-        bool CompileSource(const ShaderDescriptor& shaderDesc);
+        bool CompileSource(const ShaderDescriptor& shaderDesc, const DXShaderCache& shaderCache);
         bool LoadBinary(const ShaderDescriptor& shaderDesc);
 
+        // Creates the reflection object with D3DReflect for DXBC and with DXC for DXIL bytecode.
+        HRESULT CreateReflectionObject(ComPtr<ID3D12ShaderReflection>& outReflectionObject) const;
+
         HRESULT ReflectShaderByteCode(ShaderReflection& reflection) const;
 
         HRESULT ReflectConstantBuffers(std::vector<D3D12ConstantBufferReflection>& outConstantBuffers) const;
@@ -75,6 +80,7 @@ class D3D12Shader final : public Shader
     private:
 
         ComPtr<ID3DBlob>                            byteCode_;
+        bool                                        isDXIL_                     = false;
         Report                                      report_;
 
         std::vector<D3D12_INPUT_ELEMENT_DESC>       inputElements_;
@@ -11,6 +11,9 @@
 #include "../Command/D3D12CommandContext.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../DXCommon/DXTypes.h"
+#include <LLGL/Utils/ForRange.h>
+#include <LLGL/Container/SmallVector.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -57,58 +60,38 @@ HRESULT D3D12MipGenerator::GenerateMips(
     D3D12Texture&               texture,
     const TextureSubresource&   subresource)
 {
-    if (!texture.SupportsGenerateMips())
-    {
-        /* Texture does not support generation of MIP-maps */
-        return E_INVALIDARG;
-    }
+    MipChainTarget target;
+    HRESULT hr = InitMipChainTarget(texture, subresource, target);
+    if (hr == S_OK)
+        GenerateMipChains(commandContext, &target, 1);
+    return (hr == S_FALSE ? S_OK : hr);
+}
 
-    if (subresource.numMipLevels == 0 || subresource.numArrayLayers == 0)
-    {
-        /* Ignore this call, no MIP-map range specified */
-        return S_OK;
-    }
+HRESULT D3D12MipGenerator::GenerateMips(
+    D3D12CommandContext&    commandContext,
+    std::uint32_t           numTextures,
+    D3D12Texture* const*    textures)
+{
+    SmallVector<MipChainTarget, 16> targets;
+    targets.reserve(numTextures);
 
-    if (subresource.baseMipLevel + subresource.numMipLevels > texture.GetNumMipLevels() ||
-        subresource.baseArrayLayer + subresource.numArrayLayers > texture.GetNumArrayLayers())
-    {
-        /* Invalid subresource MIP-map level or array layer range */
-        return E_INVALIDARG;
-    }
+    /* Skip textures that do not support MIP-map generation, but report the first error */
+    HRESULT result = S_OK;
 
-    auto mipDescHeap = texture.GetMipDescHeap();
-    if (mipDescHeap == nullptr)
+    for_range(i, numTextures)
     {
-        /* At this point, the texture should have a valid descriptor heap */
-        return E_FAIL;
+        MipChainTarget target;
+        HRESULT hr = InitMipChainTarget(*textures[i], textures[i]->GetWholeSubresource(), target);
+        if (hr == S_OK)
+            targets.push_back(target);
+        else if (FAILED(hr) && result == S_OK)
+            result = hr;
     }
 
-    switch (texture.GetType())
-    {
-        case TextureType::Texture1D:
-        case TextureType::Texture1DArray:
-            GenerateMips1D(commandContext, texture.GetResource(), mipDescHeap, texture.GetDXFormat(), subresource);
-            return S_OK;
-
-        case TextureType::Texture2D:
-        case TextureType::TextureCube:
-        case TextureType::Texture2DArray:
-        case TextureType::TextureCubeArray:
-            GenerateMips2D(commandContext, texture.GetResource(), mipDescHeap, texture.GetDXFormat(), subresource);
-            return S_OK;
+    if (!targets.empty())
+        GenerateMipChains(commandContext, targets.data(), targets.size());
 
-        case TextureType::Texture3D:
-            GenerateMips3D(commandContext, texture.GetResource(), mipDescHeap, texture.GetDXFormat(), subresource);
-            return S_OK;
-
-        case TextureType::Texture2DMS:
-        case TextureType::Texture2DMSArray:
-            // no MIP-maps for multi-sampled textures
-            break;
-    }
-
-    /* Unknown argument or corrupted data */
-    return E_FAIL;
+    return result;
 }
 
 
@@ -221,222 +204,276 @@ void D3D12MipGenerator::CreateResourcesFor3DMips(ID3D12Device* device)
     pipelines3D_[0xF] = CreateComputePSO( device, rootSignature3D_.Get(), LLGL_IDR_GENERATEMIPS3D_CS_SRGB_ODDXYZ );
 }
 
-void D3D12MipGenerator::GenerateMips1D(
-    D3D12CommandContext&        commandContext,
-    D3D12Resource&              resource,
-    ID3D12DescriptorHeap*       mipDescHeap,
-    DXGI_FORMAT                 format,
-    const TextureSubresource&   subresource)
+HRESULT D3D12MipGenerator::InitMipChainTarget(D3D12Texture& texture, const TextureSubresource& subresource, MipChainTarget& outTarget)
 {
-    const bool isFormatSRGB = DXTypes::IsDXGIFormatSRGB(format);
-
-    ID3D12GraphicsCommandList* commandList = commandContext.GetCommandList();
-
-    commandContext.TransitionResource(resource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, true);
+    if (!texture.SupportsGenerateMips())
+    {
+        /* Texture does not support generation of MIP-maps */
+        return E_INVALIDARG;
+    }
 
-    /* Set root signature and descriptor heap */
-    commandContext.SetComputeRootSignature(rootSignature1D_.Get());
+    if (subresource.numMipLevels == 0 || subresource.numArrayLayers == 0)
+    {
+        /* Ignore this texture, no MIP-map range specified */
+        return S_FALSE;
+    }
 
-    ID3D12DescriptorHeap* descHeaps[] = { mipDescHeap };
-    commandContext.SetDescriptorHeaps(1, descHeaps);
+    if (subresource.baseMipLevel + subresource.numMipLevels > texture.GetNumMipLevels() ||
+        subresource.baseArrayLayer + subresource.numArrayLayers > texture.GetNumArrayLayers())
+    {
+        /* Invalid subresource MIP-map level or array layer range */
+        return E_INVALIDARG;
+    }
 
-    auto gpuDescHandle = mipDescHeap->GetGPUDescriptorHandleForHeapStart();
+    outTarget.mipDescHeap = texture.GetMipDescHeap();
+    if (outTarget.mipDescHeap == nullptr)
+    {
+        /* At this point, the texture should have a valid descriptor heap */
+        return E_FAIL;
+    }
 
-    /* Set SRV to read from entire MIP-map chain */
-    commandList->SetComputeRootDescriptorTable(1, gpuDescHandle);
-    gpuDescHandle.ptr += descHandleSize_;
+    switch (texture.GetType())
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            outTarget.dimension = 1;
+            break;
 
-    D3D12_RESOURCE_DESC resourceDesc = resource.native->GetDesc();
+        case TextureType::Texture2D:
+        case TextureType::TextureCube:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCubeArray:
+            outTarget.dimension = 2;
+            break;
 
-    const auto mipLevelEnd = subresource.baseMipLevel + subresource.numMipLevels;
+        case TextureType::Texture3D:
+            outTarget.dimension = 3;
+            break;
 
-    for (std::uint32_t mipLevel = subresource.baseMipLevel; mipLevel + 1 < mipLevelEnd;)
-    {
-        /* Determine source and destination extents */
-        UINT srcWidth = static_cast<UINT>(resourceDesc.Width) >> mipLevel;
-
-        UINT dstWidth = std::max(1u, srcWidth >> 1);
-
-        /* Bind pipeline state depending on power-of-two class */
-        UINT nonPowerOfTwo = (srcWidth & 1);
-        if (isFormatSRGB)
-            commandContext.SetPipelineState(pipelines1D_[nonPowerOfTwo + 2].Get());
-        else
-            commandContext.SetPipelineState(pipelines1D_[nonPowerOfTwo].Get());
-
-        /* Determine how many MIP-maps can be downsampled at once; must be in [1, 8] */
-        UINT numMips = (mipLevel + 8 >= mipLevelEnd ? mipLevelEnd - mipLevel : 8);
-
-        /* Run compute shader to generate next four MIP-maps */
-        commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstWidth), 0);
-        commandContext.SetComputeConstant(0, mipLevel, 1);
-        commandContext.SetComputeConstant(0, numMips, 2);
-        commandContext.SetComputeConstant(0, subresource.baseArrayLayer, 3);
-
-        commandList->SetComputeRootDescriptorTable(2, gpuDescHandle);
-        gpuDescHandle.ptr += descHandleSize_ * numMips;
-
-        commandList->Dispatch(
-            std::max(1u, dstWidth  / 64u),
-            subresource.numArrayLayers,
-            1u
-        );
+        default:
+            /* No MIP-maps for multi-sampled textures */
+            return E_FAIL;
+    }
 
-        /* Insert UAV barrier and move to next four MIP-maps */
-        commandContext.InsertUAVBarrier(resource, true);
+    const D3D12_RESOURCE_DESC resourceDesc = texture.GetResource().native->GetDesc();
 
-        mipLevel += numMips;
-    }
+    outTarget.resource          = &(texture.GetResource());
+    outTarget.numDescriptors    = texture.GetNumMipLevels();
+    outTarget.isFormatSRGB      = DXTypes::IsDXGIFormatSRGB(texture.GetDXFormat());
+    outTarget.extent[0]         = static_cast<UINT>(resourceDesc.Width);
+    outTarget.extent[1]         = static_cast<UINT>(resourceDesc.Height);
+    outTarget.extent[2]         = static_cast<UINT>(resourceDesc.DepthOrArraySize);
+    outTarget.baseArrayLayer    = subresource.baseArrayLayer;
+    outTarget.numArrayLayers    = subresource.numArrayLayers;
+    outTarget.mipLevel          = subresource.baseMipLevel;
+    outTarget.mipLevelEnd       = subresource.baseMipLevel + subresource.numMipLevels;
 
-    commandContext.TransitionResource(resource, resource.usageState, true);
+    return S_OK;
 }
 
-void D3D12MipGenerator::GenerateMips2D(
-    D3D12CommandContext&        commandContext,
-    D3D12Resource&              resource,
-    ID3D12DescriptorHeap*       mipDescHeap,
-    DXGI_FORMAT                 format,
-    const TextureSubresource&   subresource)
+void D3D12MipGenerator::GenerateMipChains(D3D12CommandContext& commandContext, MipChainTarget* targets, std::size_t numTargets)
 {
-    const bool isFormatSRGB = DXTypes::IsDXGIFormatSRGB(format);
-
-    ID3D12GraphicsCommandList* commandList = commandContext.GetCommandList();
-
-    commandContext.TransitionResource(resource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, true);
+    /* Group targets by dimension, so each root signature is bound only once */
+    std::stable_sort(
+        targets,
+        targets + numTargets,
+        [](const MipChainTarget& lhs, const MipChainTarget& rhs)
+        {
+            return (lhs.dimension < rhs.dimension);
+        }
+    );
 
-    /* Set root signature and descriptor heap */
-    commandContext.SetComputeRootSignature(rootSignature2D_.Get());
+    /*
+    Copy the MIP-map descriptors of all textures into the staging descriptor heap,
+    so all dispatches share the same shader-visible heap and the heap binding is not changed between textures
+    */
+    commandContext.SetStagingDescriptorHeaps();
 
-    ID3D12DescriptorHeap* descHeaps[] = { mipDescHeap };
-    commandContext.SetDescriptorHeaps(1, descHeaps);
+    for_range(i, numTargets)
+    {
+        MipChainTarget& target = targets[i];
+        target.srvDescHandle = commandContext.CopyDescriptorsForStaging(
+            D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+            target.mipDescHeap->GetCPUDescriptorHandleForHeapStart(),
+            0,
+            target.numDescriptors
+        );
+        commandContext.TransitionResource(*target.resource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    }
 
-    auto gpuDescHandle = mipDescHeap->GetGPUDescriptorHandleForHeapStart();
+    commandContext.FlushResourceBarrieres();
 
-    /* Set SRV to read from entire MIP-map chain */
-    commandList->SetComputeRootDescriptorTable(1, gpuDescHandle);
-    gpuDescHandle.ptr += descHandleSize_;
+    for (std::size_t groupBegin = 0, groupEnd = 0; groupBegin < numTargets; groupBegin = groupEnd)
+    {
+        /* Find end of group with same dimension */
+        const int dimension = targets[groupBegin].dimension;
+        for (groupEnd = groupBegin + 1; groupEnd < numTargets && targets[groupEnd].dimension == dimension; ++groupEnd);
 
-    D3D12_RESOURCE_DESC resourceDesc = resource.native->GetDesc();
+        switch (dimension)
+        {
+            case 1: commandContext.SetComputeRootSignature(rootSignature1D_.Get()); break;
+            case 2: commandContext.SetComputeRootSignature(rootSignature2D_.Get()); break;
+            case 3: commandContext.SetComputeRootSignature(rootSignature3D_.Get()); break;
+        }
 
-    const auto mipLevelEnd = subresource.baseMipLevel + subresource.numMipLevels;
+        /*
+        Interleave the dispatches of all independent textures of this group for the next range of MIP-maps,
+        so all their UAV barriers are flushed at once before the next range reads from the MIP-maps that have just been written
+        */
+        for (bool hasPendingMips = true; hasPendingMips;)
+        {
+            hasPendingMips = false;
+
+            for_subrange(i, groupBegin, groupEnd)
+            {
+                MipChainTarget& target = targets[i];
+                if (target.mipLevel + 1 < target.mipLevelEnd)
+                {
+                    switch (dimension)
+                    {
+                        case 1: DispatchMips1D(commandContext, target); break;
+                        case 2: DispatchMips2D(commandContext, target); break;
+                        case 3: DispatchMips3D(commandContext, target); break;
+                    }
+                    commandContext.InsertUAVBarrier(*target.resource);
+                    hasPendingMips = true;
+                }
+            }
+
+            commandContext.FlushResourceBarrieres();
+        }
+    }
 
-    for (std::uint32_t mipLevel = subresource.baseMipLevel; mipLevel + 1 < mipLevelEnd;)
-    {
-        /* Determine source and destination extents */
-        UINT srcWidth   = static_cast<UINT>(resourceDesc.Width)  >> mipLevel;
-        UINT srcHeight  = static_cast<UINT>(resourceDesc.Height) >> mipLevel;
-
-        UINT dstWidth   = std::max(1u, srcWidth  >> 1);
-        UINT dstHeight  = std::max(1u, srcHeight >> 1);
-
-        /* Bind pipeline state depending on power-of-two class */
-        UINT nonPowerOfTwo = ((srcWidth & 1) | ((srcHeight & 1) << 1));
-        if (isFormatSRGB)
-            commandContext.SetPipelineState(pipelines2D_[nonPowerOfTwo + 4].Get());
-        else
-            commandContext.SetPipelineState(pipelines2D_[nonPowerOfTwo].Get());
-
-        /* Determine how many MIP-maps can be downsampled at once; must be in [1, 4] */
-        UINT numMips = (mipLevel + 4 >= mipLevelEnd ? mipLevelEnd - mipLevel : 4);
-
-        /* Run compute shader to generate next four MIP-maps */
-        commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstWidth), 0);
-        commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstHeight), 1);
-        commandContext.SetComputeConstant(0, mipLevel, 2);
-        commandContext.SetComputeConstant(0, numMips, 3);
-        commandContext.SetComputeConstant(0, subresource.baseArrayLayer, 4);
-
-        commandList->SetComputeRootDescriptorTable(2, gpuDescHandle);
-        gpuDescHandle.ptr += descHandleSize_ * numMips;
-
-        commandList->Dispatch(
-            std::max(1u, dstWidth  / 8u),
-            std::max(1u, dstHeight / 8u),
-            subresource.numArrayLayers
-        );
+    for_range(i, numTargets)
+        commandContext.TransitionResource(*targets[i].resource, targets[i].resource->usageState);
 
-        /* Insert UAV barrier and move to next four MIP-maps */
-        commandContext.InsertUAVBarrier(resource, true);
+    commandContext.FlushResourceBarrieres();
+}
 
-        mipLevel += numMips;
-    }
+void D3D12MipGenerator::SetMipDescriptorTables(ID3D12GraphicsCommandList* commandList, const MipChainTarget& target)
+{
+    /* Set SRV to read from entire MIP-map chain; the UAV of MIP-map N is located at descriptor N */
+    D3D12_GPU_DESCRIPTOR_HANDLE uavDescHandle = target.srvDescHandle;
+    uavDescHandle.ptr += descHandleSize_ * (target.mipLevel + 1);
 
-    commandContext.TransitionResource(resource, resource.usageState, true);
+    commandList->SetComputeRootDescriptorTable(1, target.srvDescHandle);
+    commandList->SetComputeRootDescriptorTable(2, uavDescHandle);
 }
 
-void D3D12MipGenerator::GenerateMips3D(
-    D3D12CommandContext&        commandContext,
-    D3D12Resource&              resource,
-    ID3D12DescriptorHeap*       mipDescHeap,
-    DXGI_FORMAT                 format,
-    const TextureSubresource&   subresource)
+void D3D12MipGenerator::DispatchMips1D(D3D12CommandContext& commandContext, MipChainTarget& target)
 {
-    const bool isFormatSRGB = DXTypes::IsDXGIFormatSRGB(format);
+    /* Determine source and destination extents */
+    UINT srcWidth = target.extent[0] >> target.mipLevel;
 
-    ID3D12GraphicsCommandList* commandList = commandContext.GetCommandList();
+    UINT dstWidth = std::max(1u, srcWidth >> 1);
 
-    commandContext.TransitionResource(resource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, true);
+    /* Bind pipeline state depending on power-of-two class */
+    UINT nonPowerOfTwo = (srcWidth & 1);
+    if (target.isFormatSRGB)
+        commandContext.SetPipelineState(pipelines1D_[nonPowerOfTwo + 2].Get());
+    else
+        commandContext.SetPipelineState(pipelines1D_[nonPowerOfTwo].Get());
 
-    /* Set root signature and descriptor heap */
-    commandContext.SetComputeRootSignature(rootSignature3D_.Get());
+    /* Determine how many MIP-maps can be downsampled at once; must be in [1, 8] */
+    UINT numMips = (target.mipLevel + 8 >= target.mipLevelEnd ? target.mipLevelEnd - target.mipLevel : 8);
 
-    ID3D12DescriptorHeap* descHeaps[] = { mipDescHeap };
-    commandContext.SetDescriptorHeaps(1, descHeaps);
+    /* Run compute shader to generate next eight MIP-maps */
+    commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstWidth), 0);
+    commandContext.SetComputeConstant(0, target.mipLevel, 1);
+    commandContext.SetComputeConstant(0, numMips, 2);
+    commandContext.SetComputeConstant(0, target.baseArrayLayer, 3);
 
-    auto gpuDescHandle = mipDescHeap->GetGPUDescriptorHandleForHeapStart();
+    ID3D12GraphicsCommandList* commandList = commandContext.GetCommandList();
+    SetMipDescriptorTables(commandList, target);
 
-    /* Set SRV to read from entire MIP-map chain */
-    commandList->SetComputeRootDescriptorTable(1, gpuDescHandle);
-    gpuDescHandle.ptr += descHandleSize_;
+    commandList->Dispatch(
+        std::max(1u, dstWidth / 64u),
+        target.numArrayLayers,
+        1u
+    );
 
-    D3D12_RESOURCE_DESC resourceDesc = resource.native->GetDesc();
+    /* Move to next eight MIP-maps */
+    target.mipLevel += numMips;
+}
 
-    const auto mipLevelEnd = subresource.baseMipLevel + subresource.numMipLevels;
+void D3D12MipGenerator::DispatchMips2D(D3D12CommandContext& commandContext, MipChainTarget& target)
+{
+    /* Determine source and destination extents */
+    UINT srcWidth   = target.extent[0] >> target.mipLevel;
+    UINT srcHeight  = target.extent[1] >> target.mipLevel;
+
+    UINT dstWidth   = std::max(1u, srcWidth  >> 1);
+    UINT dstHeight  = std::max(1u, srcHeight >> 1);
+
+    /* Bind pipeline state depending on power-of-two class */
+    UINT nonPowerOfTwo = ((srcWidth & 1) | ((srcHeight & 1) << 1));
+    if (target.isFormatSRGB)
+        commandContext.SetPipelineState(pipelines2D_[nonPowerOfTwo + 4].Get());
+    else
+        commandContext.SetPipelineState(pipelines2D_[nonPowerOfTwo].Get());
+
+    /* Determine how many MIP-maps can be downsampled at once; must be in [1, 4] */
+    UINT numMips = (target.mipLevel + 4 >= target.mipLevelEnd ? target.mipLevelEnd - target.mipLevel : 4);
+
+    /* Run compute shader to generate next four MIP-maps */
+    commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstWidth), 0);
+    commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstHeight), 1);
+    commandContext.SetComputeConstant(0, target.mipLevel, 2);
+    commandContext.SetComputeConstant(0, numMips, 3);
+    commandContext.SetComputeConstant(0, target.baseArrayLayer, 4);
 
-    for (std::uint32_t mipLevel = subresource.baseMipLevel; mipLevel + 1 < mipLevelEnd;)
-    {
-        /* Determine source and destination extents */
-        UINT srcWidth   = static_cast<UINT>(resourceDesc.Width)            >> mipLevel;
-        UINT srcHeight  = static_cast<UINT>(resourceDesc.Height)           >> mipLevel;
-        UINT srcDepth   = static_cast<UINT>(resourceDesc.DepthOrArraySize) >> mipLevel;
-
-        UINT dstWidth   = std::max(1u, srcWidth  >> 1);
-        UINT dstHeight  = std::max(1u, srcHeight >> 1);
-        UINT dstDepth   = std::max(1u, srcDepth  >> 1);
-
-        /* Bind pipeline state depending on power-of-two class */
-        UINT nonPowerOfTwo = ((srcWidth & 1) | ((srcHeight & 1) << 1) | ((srcDepth & 1) << 2));
-        if (isFormatSRGB)
-            commandContext.SetPipelineState(pipelines3D_[nonPowerOfTwo + 8].Get());
-        else
-            commandContext.SetPipelineState(pipelines3D_[nonPowerOfTwo].Get());
-
-        /* Determine how many MIP-maps can be downsampled at once; must be in [1, 3] */
-        UINT numMips = (mipLevel + 3 >= mipLevelEnd ? mipLevelEnd - mipLevel : 3);
-
-        /* Run compute shader to generate next four MIP-maps */
-        commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstWidth), 0);
-        commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstHeight), 1);
-        commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstDepth), 2);
-        commandContext.SetComputeConstant(0, mipLevel, 3);
-        commandContext.SetComputeConstant(0, numMips, 4);
-
-        commandList->SetComputeRootDescriptorTable(2, gpuDescHandle);
-        gpuDescHandle.ptr += descHandleSize_ * numMips;
-
-        commandList->Dispatch(
-            std::max(1u, dstWidth  / 4u),
-            std::max(1u, dstHeight / 4u),
-            std::max(1u, dstDepth  / 4u)
-        );
+    ID3D12GraphicsCommandList* commandList = commandContext.GetCommandList();
+    SetMipDescriptorTables(commandList, target);
 
-        /* Insert UAV barrier and move to next four MIP-maps */
-        commandContext.InsertUAVBarrier(resource, true);
+    commandList->Dispatch(
+        std::max(1u, dstWidth  / 8u),
+        std::max(1u, dstHeight / 8u),
+        target.numArrayLayers
+    );
 
-        mipLevel += numMips;
-    }
+    /* Move to next four MIP-maps */
+    target.mipLevel += numMips;
+}
+
+void D3D12MipGenerator::DispatchMips3D(D3D12CommandContext& commandContext, MipChainTarget& target)
+{
+    /* Determine source and destination extents */
+    UINT srcWidth   = target.extent[0] >> target.mipLevel;
+    UINT srcHeight  = target.extent[1] >> target.mipLevel;
+    UINT srcDepth   = target.extent[2] >> target.mipLevel;
+
+    UINT dstWidth   = std::max(1u, srcWidth  >> 1);
+    UINT dstHeight  = std::max(1u, srcHeight >> 1);
+    UINT dstDepth   = std::max(1u, srcDepth  >> 1);
+
+    /* Bind pipeline state depending on power-of-two class */
+    UINT nonPowerOfTwo = ((srcWidth & 1) | ((srcHeight & 1) << 1) | ((srcDepth & 1) << 2));
+    if (target.isFormatSRGB)
+        commandContext.SetPipelineState(pipelines3D_[nonPowerOfTwo + 8].Get());
+    else
+        commandContext.SetPipelineState(pipelines3D_[nonPowerOfTwo].Get());
+
+    /* Determine how many MIP-maps can be downsampled at once; must be in [1, 3] */
+    UINT numMips = (target.mipLevel + 3 >= target.mipLevelEnd ? target.mipLevelEnd - target.mipLevel : 3);
+
+    /* Run compute shader to generate next three MIP-maps */
+    commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstWidth), 0);
+    commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstHeight), 1);
+    commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(dstDepth), 2);
+    commandContext.SetComputeConstant(0, target.mipLevel, 3);
+    commandContext.SetComputeConstant(0, numMips, 4);
+
+    ID3D12GraphicsCommandList* commandList = commandContext.GetCommandList();
+    SetMipDescriptorTables(commandList, target);
+
+    commandList->Dispatch(
+        std::max(1u, dstWidth  / 4u),
+        std::max(1u, dstHeight / 4u),
+        std::max(1u, dstDepth  / 4u)
+    );
 
-    commandContext.TransitionResource(resource, resource.usageState, true);
+    /* Move to next three MIP-maps */
+    target.mipLevel += numMips;
 }
 
 
@@ -51,6 +51,35 @@ class D3D12MipGenerator
             const TextureSubresource&   subresource
         );
 
+        /*
+        Generates the entire MIP chain of multiple textures at once. The textures must be distinct.
+        Textures are grouped by dimension, so each root signature is bound only once, and the dispatches of all textures are interleaved,
+        so UAV barriers are flushed once per range of MIP-maps rather than once per dispatch.
+        */
+        HRESULT GenerateMips(
+            D3D12CommandContext&    commandContext,
+            std::uint32_t           numTextures,
+            D3D12Texture* const*    textures
+        );
+
+    private:
+
+        // State of a texture whose MIP chain is generated by a single call to GenerateMipChains.
+        struct MipChainTarget
+        {
+            D3D12Resource*              resource        = nullptr;
+            ID3D12DescriptorHeap*       mipDescHeap     = nullptr;
+            UINT                        numDescriptors  = 0;
+            D3D12_GPU_DESCRIPTOR_HANDLE srvDescHandle   = {};       // SRV of the entire MIP chain within the staging descriptor heap, followed by the UAVs.
+            int                         dimension       = 0;        // 1, 2, or 3 for 1D, 2D, and 3D MIP-map generation.
+            bool                        isFormatSRGB    = false;
+            UINT                        extent[3]       = {};
+            std::uint32_t               baseArrayLayer  = 0;
+            std::uint32_t               numArrayLayers  = 0;
+            std::uint32_t               mipLevel        = 0;        // Next MIP-map level to downsample from.
+            std::uint32_t               mipLevelEnd     = 0;
+        };
+
     private:
 
         D3D12MipGenerator() = default;
@@ -65,29 +94,17 @@ class D3D12MipGenerator
         void CreateResourcesFor2DMips(ID3D12Device* device);
         void CreateResourcesFor3DMips(ID3D12Device* device);
 
-        void GenerateMips1D(
-            D3D12CommandContext&        commandContext,
-            D3D12Resource&              resource,
-            ID3D12DescriptorHeap*       mipDescHeap,
-            DXGI_FORMAT                 format,
-            const TextureSubresource&   subresource
-        );
+        // Returns S_OK if the target has been initialized, S_FALSE if the subresource range is empty, or an error code otherwise.
+        HRESULT InitMipChainTarget(D3D12Texture& texture, const TextureSubresource& subresource, MipChainTarget& outTarget);
 
-        void GenerateMips2D(
-            D3D12CommandContext&        commandContext,
-            D3D12Resource&              resource,
-            ID3D12DescriptorHeap*       mipDescHeap,
-            DXGI_FORMAT                 format,
-            const TextureSubresource&   subresource
-        );
+        void GenerateMipChains(D3D12CommandContext& commandContext, MipChainTarget* targets, std::size_t numTargets);
 
-        void GenerateMips3D(
-            D3D12CommandContext&        commandContext,
-            D3D12Resource&              resource,
-            ID3D12DescriptorHeap*       mipDescHeap,
-            DXGI_FORMAT                 format,
-            const TextureSubresource&   subresource
-        );
+        void SetMipDescriptorTables(ID3D12GraphicsCommandList* commandList, const MipChainTarget& target);
+
+        // Records a single dispatch for the next range of MIP-maps of the specified target.
+        void DispatchMips1D(D3D12CommandContext& commandContext, MipChainTarget& target);
+        void DispatchMips2D(D3D12CommandContext& commandContext, MipChainTarget& target);
+        void DispatchMips3D(D3D12CommandContext& commandContext, MipChainTarget& target);
 
     private:
 
@@ -104,7 +121,6 @@ class D3D12MipGenerator
 
         UINT                        descHandleSize_     = 0;
 
-
 };
 
 
@@ -34,6 +34,13 @@ D3D12RenderTarget::D3D12RenderTarget(D3D12Device& device, const RenderTargetDesc
     CreateDescriptorHeaps(device.GetNative(), numColorFormats);
     CreateAttachments(device.GetNative(), desc, colorFormats);
     defaultRenderPass_.BuildAttachments(numColorFormats, colorFormats.data(), depthStencilFormat_, sampleDesc_);
+
+    /* Store optional shading-rate image for variable rate shading */
+    if (desc.shadingRateImage != nullptr)
+    {
+        auto* textureD3D = LLGL_CAST(D3D12Texture*, desc.shadingRateImage);
+        shadingRateImage_ = &(textureD3D->GetResource());
+    }
 }
 
 void D3D12RenderTarget::SetName(const char* name)
@@ -72,18 +79,31 @@ const RenderPass* D3D12RenderTarget::GetRenderPass() const
     return (&defaultRenderPass_);
 }
 
-void D3D12RenderTarget::TransitionToOutputMerger(D3D12CommandContext& commandContext)
+void D3D12RenderTarget::TransitionToOutputMerger(D3D12CommandContext& commandContext, std::uint32_t discardMask)
 {
-    for (auto& resource : colorBuffers_)
-        commandContext.TransitionResource(*resource, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    for_range(i, static_cast<std::uint32_t>(colorBuffers_.size()))
+    {
+        if ((discardMask & (1u << i)) != 0)
+            commandContext.TransitionResourceDiscard(*colorBuffers_[i], D3D12_RESOURCE_STATE_RENDER_TARGET);
+        else
+            commandContext.TransitionResource(*colorBuffers_[i], D3D12_RESOURCE_STATE_RENDER_TARGET);
+    }
 
     if (depthStencil_ != nullptr)
-        commandContext.TransitionResource(*depthStencil_, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+    {
+        if ((discardMask & D3D12RenderPass::discardDepthStencilBit) != 0)
+            commandContext.TransitionResourceDiscard(*depthStencil_, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+        else
+            commandContext.TransitionResource(*depthStencil_, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+    }
+
+    if (shadingRateImage_ != nullptr)
+        commandContext.TransitionResource(*shadingRateImage_, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
 
     commandContext.FlushResourceBarrieres();
 }
 
-void D3D12RenderTarget::ResolveSubresources(D3D12CommandContext& commandContext)
+void D3D12RenderTarget::ResolveSubresources(D3D12CommandContext& commandContext, const D3D12_RECT* srcRect)
 {
     if (HasMultiSampling())
     {
@@ -94,18 +114,23 @@ void D3D12RenderTarget::ResolveSubresources(D3D12CommandContext& commandContext)
                 target.resolveDstSubresource,
                 *target.multiSampledSrcTexture,
                 0,
-                target.format
+                target.format,
+                srcRect
             );
         }
     }
     else
     {
+        /* Attachments are idle until their next use, so the transitions can overlap with subsequent commands */
         for (auto& resource : colorBuffers_)
-            commandContext.TransitionResource(*resource, resource->usageState);
+            commandContext.BeginSplitTransition(*resource, resource->usageState);
     }
 
     if (depthStencil_ != nullptr)
-        commandContext.TransitionResource(*depthStencil_, depthStencil_->usageState);
+        commandContext.BeginSplitTransition(*depthStencil_, depthStencil_->usageState);
+
+    if (shadingRateImage_ != nullptr)
+        commandContext.BeginSplitTransition(*shadingRateImage_, shadingRateImage_->usageState);
 
     commandContext.FlushResourceBarrieres();
 }
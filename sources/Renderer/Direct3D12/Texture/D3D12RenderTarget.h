@@ -40,8 +40,10 @@ class D3D12RenderTarget final : public RenderTarget
 
         D3D12RenderTarget(D3D12Device& device, const RenderTargetDescriptor& desc);
 
-        void TransitionToOutputMerger(D3D12CommandContext& commandContext);
-        void ResolveSubresources(D3D12CommandContext& commandContext);
+        // Transitions all attachments for the output merger. Attachments in the discard mask (see D3D12RenderPass::GetDiscardMask) don't preserve their content.
+        void TransitionToOutputMerger(D3D12CommandContext& commandContext, std::uint32_t discardMask = 0);
+        // Resolves all multi-sampled attachments. The optional source rectangle limits the resolve to the active extent (see RenderTarget::SetActiveExtent).
+        void ResolveSubresources(D3D12CommandContext& commandContext, const D3D12_RECT* srcRect = nullptr);
 
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForRTV() const;
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForDSV() const;
@@ -52,6 +54,12 @@ class D3D12RenderTarget final : public RenderTarget
             return (sampleDesc_.Count > 1);
         }
 
+        // Returns the native resource of the shading-rate image or null if there is none.
+        inline ID3D12Resource* GetShadingRateImage() const
+        {
+            return (shadingRateImage_ != nullptr ? shadingRateImage_->Get() : nullptr);
+        }
+
     private:
 
         using ColorFormatVector = SmallVector<DXGI_FORMAT, LLGL_MAX_NUM_COLOR_ATTACHMENTS>;
@@ -140,6 +148,7 @@ class D3D12RenderTarget final : public RenderTarget
         std::vector<D3D12Resource*>     colorBuffers_;
         std::vector<ResolveTarget>      resolveTargets_;
         D3D12Resource*                  depthStencil_       = nullptr;
+        D3D12Resource*                  shadingRateImage_   = nullptr;
 
 };
 
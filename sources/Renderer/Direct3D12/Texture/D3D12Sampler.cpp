@@ -15,14 +15,30 @@ namespace LLGL
 {
 
 
-D3D12Sampler::D3D12Sampler(const SamplerDescriptor& desc)
+D3D12Sampler::D3D12Sampler(SamplerCache<D3D12_SAMPLER_DESC>& samplerCache, const SamplerDescriptor& desc) :
+    samplerCache_ { samplerCache },
+    desc_         { desc         }
 {
-    D3D12Sampler::ConvertDesc(nativeDesc_, desc);
+    const D3D12_SAMPLER_DESC& nativeDesc = samplerCache_.Acquire(
+        desc,
+        [](const SamplerDescriptor& samplerDesc) -> D3D12_SAMPLER_DESC
+        {
+            D3D12_SAMPLER_DESC convertedDesc;
+            D3D12Sampler::ConvertDesc(convertedDesc, samplerDesc);
+            return convertedDesc;
+        }
+    );
+    nativeDesc_ = &nativeDesc;
+}
+
+D3D12Sampler::~D3D12Sampler()
+{
+    samplerCache_.Release(desc_, [](const D3D12_SAMPLER_DESC&) {});
 }
 
 void D3D12Sampler::CreateResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle)
 {
-    device->CreateSampler(&nativeDesc_, cpuDescriptorHandle);
+    device->CreateSampler(nativeDesc_, cpuDescriptorHandle);
 }
 
 template <typename TNativeSamplerDesc>
@@ -11,6 +11,7 @@
 
 #include <LLGL/Sampler.h>
 #include <LLGL/PipelineLayoutFlags.h>
+#include "../../SamplerCache.h"
 #include <d3d12.h>
 
 
@@ -23,10 +24,18 @@ class D3D12Sampler final : public Sampler
 
     public:
 
-        D3D12Sampler(const SamplerDescriptor& desc);
+        // Acquires the native sampler descriptor from the specified cache; identical descriptors share one D3D12_SAMPLER_DESC.
+        D3D12Sampler(SamplerCache<D3D12_SAMPLER_DESC>& samplerCache, const SamplerDescriptor& desc);
+        ~D3D12Sampler();
 
         void CreateResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle);
 
+        // Returns the shared native sampler descriptor. Samplers with identical descriptors return the same pointer, which identifies them in descriptor tables.
+        inline const D3D12_SAMPLER_DESC* GetNativeDesc() const
+        {
+            return nativeDesc_;
+        }
+
     public:
 
         // Converts the input sampler into a native D3D12 sampler descriptor.
@@ -37,7 +46,9 @@ class D3D12Sampler final : public Sampler
 
     private:
 
-        D3D12_SAMPLER_DESC nativeDesc_;
+        SamplerCache<D3D12_SAMPLER_DESC>&   samplerCache_;
+        const D3D12_SAMPLER_DESC*           nativeDesc_     = nullptr;
+        SamplerDescriptor                   desc_;
 
 };
 
@@ -24,19 +24,27 @@ namespace LLGL
 {
 
 
-D3D12Texture::D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc) :
-    Texture         { desc.type, desc.bindFlags          },
-    baseFormat_     { desc.format                        },
-    format_         { DXTypes::ToDXGIFormat(desc.format) },
-    numMipLevels_   { NumMipLevels(desc)                 },
-    numArrayLayers_ { std::max(1u, desc.arrayLayers)     },
-    extent_         { desc.extent                        }
+D3D12Texture::D3D12Texture(ID3D12Device* device, D3D12MemoryAllocator& memoryAllocator, const TextureDescriptor& desc) :
+    Texture          { desc.type, desc.bindFlags          },
+    memoryAllocator_ { memoryAllocator                    },
+    baseFormat_      { desc.format                        },
+    format_          { DXTypes::ToDXGIFormat(desc.format) },
+    numMipLevels_    { NumMipLevels(desc)                 },
+    numArrayLayers_  { std::max(1u, desc.arrayLayers)     },
+    extent_          { desc.extent                        }
 {
     CreateNativeTexture(device, desc);
     if (SupportsGenerateMips())
         CreateMipDescHeap(device);
 }
 
+D3D12Texture::~D3D12Texture()
+{
+    /* Release native resource before its memory region is returned to the allocator */
+    resource_.native.Reset();
+    memoryAllocator_.Free(allocation_);
+}
+
 void D3D12Texture::SetName(const char* name)
 {
     D3D12SetObjectName(resource_.Get(), name);
@@ -99,7 +107,7 @@ TextureDescriptor D3D12Texture::GetDesc() const
 
     texDesc.type        = GetType();
     texDesc.bindFlags   = GetBindFlags();
-    texDesc.miscFlags   = 0;
+    texDesc.miscFlags   = (tileShape_.WidthInTexels > 0 ? MiscFlags::Sparse : 0);
     texDesc.format      = GetBaseFormat();
     texDesc.mipLevels   = desc.MipLevels;
 
@@ -144,6 +152,12 @@ Format D3D12Texture::GetFormat() const
     return GetBaseFormat();
 }
 
+Extent3D D3D12Texture::GetSparseTileExtent() const
+{
+    /* Tile shape is only queried for reserved resources */
+    return Extent3D{ tileShape_.WidthInTexels, tileShape_.HeightInTexels, tileShape_.DepthInTexels };
+}
+
 SubresourceFootprint D3D12Texture::GetSubresourceFootprint(std::uint32_t mipLevel) const
 {
     SubresourceFootprint footprint;
@@ -775,20 +789,157 @@ void D3D12Texture::CreateNativeTexture(ID3D12Device* device, const TextureDescri
         optClearValue.DepthStencil.Stencil  = static_cast<UINT8>(desc.clearValue.stencil);
     }
 
-    /* Create hardware resource for the texture */
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-        D3D12_HEAP_FLAG_NONE,
-        &descD3D,
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        (useClearValue ? &optClearValue : nullptr),
-        IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
-    );
-    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 hardware texture");
+    if ((desc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        /* Create reserved resource without memory; tiles are mapped with UpdateTileMappings */
+        descD3D.Layout = D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE;
+        auto hr = device->CreateReservedResource(
+            &descD3D,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            (useClearValue ? &optClearValue : nullptr),
+            IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 reserved texture");
+    }
+    else
+    {
+        /* Create hardware resource for the texture; RT/DS, multi-sampled, and external textures remain committed resources */
+        auto hr = memoryAllocator_.CreateResource(
+            D3D12_HEAP_TYPE_DEFAULT,
+            descD3D,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            (useClearValue ? &optClearValue : nullptr),
+            resource_.native.ReleaseAndGetAddressOf(),
+            allocation_,
+            ((desc.miscFlags & MiscFlags::External) != 0)
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 hardware texture");
+    }
 
     /* Determine resource usage */
     resource_.transitionState   = D3D12_RESOURCE_STATE_COPY_DEST;
     resource_.usageState        = GetInitialD3D12ResourceState(desc);
+    resource_.numSubresources   = std::max(1u, CD3DX12_RESOURCE_DESC{ descD3D }.Subresources(device));
+
+    if ((desc.miscFlags & MiscFlags::Sparse) != 0)
+        QueryResourceTiling(device);
+}
+
+void D3D12Texture::QueryResourceTiling(ID3D12Device* device)
+{
+    UINT numTiles               = 0;
+    UINT numSubresourceTilings  = resource_.numSubresources;
+
+    subresourceTilings_.resize(numSubresourceTilings);
+    device->GetResourceTiling(
+        resource_.Get(),
+        &numTiles,
+        &packedMipInfo_,
+        &tileShape_,
+        &numSubresourceTilings,
+        0,
+        subresourceTilings_.data()
+    );
+}
+
+// Returns the tile category for a reserved texture with the specified bind flags to be compatible with resource heap tier 1.
+static D3D12_HEAP_FLAGS GetTextureTileHeapCategory(long bindFlags)
+{
+    if ((bindFlags & (BindFlags::ColorAttachment | BindFlags::DepthStencilAttachment)) != 0)
+        return D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+    else
+        return D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+}
+
+void D3D12Texture::CreateTileMapper(D3D12TileHeapPool& tileHeapPool, ID3D12CommandQueue* commandQueue)
+{
+    LLGL_ASSERT(tileMapper_ == nullptr);
+    tileMapper_ = MakeUnique<D3D12TileMapper>(tileHeapPool, GetTextureTileHeapCategory(GetBindFlags()));
+
+    /* Packed MIP-maps cannot be mapped individually, so they are always resident; tiles are addressed with the X coordinate only */
+    if (packedMipInfo_.NumPackedMips > 0)
+    {
+        for_range(arrayLayer, numArrayLayers_)
+        {
+            const UINT subresource = CalcSubresource(packedMipInfo_.NumStandardMips, arrayLayer);
+            for_range(tile, packedMipInfo_.NumTilesForPackedMips)
+            {
+                const D3D12_TILED_RESOURCE_COORDINATE coord{ tile, 0, 0, subresource };
+                tileMapper_->SetTileResident(coord, (static_cast<UINT64>(subresource) << 32) | tile, true);
+            }
+        }
+        tileMapper_->Flush(commandQueue, GetNative());
+    }
+}
+
+/*
+Determines the range of tiles [outBegin, outEnd) that covers the specified texel range.
+Tiles are rounded outwards for resident mappings and inwards otherwise, except at the edge of the MIP-map.
+*/
+static void GetTileRange(
+    std::uint32_t   offset,
+    std::uint32_t   extent,
+    std::uint32_t   mipSize,
+    UINT            tileSize,
+    UINT            numTiles,
+    bool            resident,
+    UINT&           outBegin,
+    UINT&           outEnd)
+{
+    const std::uint32_t end = std::min(offset + extent, mipSize);
+    if (resident)
+    {
+        outBegin    = offset / tileSize;
+        outEnd      = (end + tileSize - 1) / tileSize;
+    }
+    else
+    {
+        outBegin    = (offset + tileSize - 1) / tileSize;
+        outEnd      = (end == mipSize ? numTiles : end / tileSize);
+    }
+    outEnd = std::min(outEnd, numTiles);
+}
+
+void D3D12Texture::UpdateTileMappings(ID3D12CommandQueue* commandQueue, std::uint32_t numMappings, const TextureTileMapping* mappings)
+{
+    if (tileMapper_ == nullptr)
+        return;
+
+    for_range(i, numMappings)
+    {
+        const TextureTileMapping&   mapping     = mappings[i];
+        const TextureSubresource&   subresource = mapping.region.subresource;
+
+        /* Ignore MIP-maps that are part of the packed MIP tail */
+        const UINT mipLevel = subresource.baseMipLevel;
+        if (mipLevel >= packedMipInfo_.NumStandardMips)
+            continue;
+
+        /* Determine range of tiles within the MIP-map; the tiling is equal for all array layers */
+        const D3D12_SUBRESOURCE_TILING& tiling = subresourceTilings_[CalcSubresource(mipLevel, 0)];
+        const Extent3D mipExtent = GetMipExtent(mipLevel);
+
+        UINT beginX = 0, endX = 0, beginY = 0, endY = 0;
+        GetTileRange(static_cast<std::uint32_t>(mapping.region.offset.x), mapping.region.extent.width,  mipExtent.width,  tileShape_.WidthInTexels,  tiling.WidthInTiles,  mapping.resident, beginX, endX);
+        GetTileRange(static_cast<std::uint32_t>(mapping.region.offset.y), mapping.region.extent.height, mipExtent.height, tileShape_.HeightInTexels, tiling.HeightInTiles, mapping.resident, beginY, endY);
+
+        const UINT endArrayLayer = std::min(subresource.baseArrayLayer + subresource.numArrayLayers, numArrayLayers_);
+        for (UINT arrayLayer = subresource.baseArrayLayer; arrayLayer < endArrayLayer; ++arrayLayer)
+        {
+            const UINT subresourceIndex = CalcSubresource(mipLevel, arrayLayer);
+            for (UINT y = beginY; y < endY; ++y)
+            {
+                for (UINT x = beginX; x < endX; ++x)
+                {
+                    const D3D12_TILED_RESOURCE_COORDINATE coord{ x, y, 0, subresourceIndex };
+                    const UINT64 key = (static_cast<UINT64>(subresourceIndex) << 32) | (static_cast<UINT64>(y) << 16) | x;
+                    tileMapper_->SetTileResident(coord, key, mapping.resident);
+                }
+            }
+        }
+    }
+
+    tileMapper_->Flush(commandQueue, GetNative());
 }
 
 // Determine SRV dimension for descriptor heaps used in D3D12MipGenerator: either 1D array, 2D array, or 3D
@@ -837,12 +988,12 @@ static D3D12_UAV_DIMENSION GetMipChainUAVDimension(const TextureType type)
 
 void D3D12Texture::CreateMipDescHeap(ID3D12Device* device)
 {
-    /* Create descriptor heap for all MIP-map levels */
+    /* Create CPU-only descriptor heap for all MIP-map levels; they are copied into the staging descriptor heap by the MIP-map generator */
     D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
     {
         heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
         heapDesc.NumDescriptors = GetNumMipLevels();
-        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
         heapDesc.NodeMask       = 0;
     }
     auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(mipDescHeap_.ReleaseAndGetAddressOf()));
@@ -11,7 +11,10 @@
 
 #include <LLGL/Texture.h>
 #include "../D3D12Resource.h"
+#include "../D3D12TileMapper.h"
+#include "../D3D12MemoryAllocator.h"
 #include <vector>
+#include <memory>
 
 
 namespace LLGL
@@ -35,7 +38,8 @@ class D3D12Texture final : public Texture
 
     public:
 
-        D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc);
+        D3D12Texture(ID3D12Device* device, D3D12MemoryAllocator& memoryAllocator, const TextureDescriptor& desc);
+        ~D3D12Texture();
 
         // Updates the specified subresource, i.e. a single MIP-map level but one or more array layers.
         void UpdateSubresource(
@@ -61,6 +65,15 @@ class D3D12Texture final : public Texture
             UINT&                       outLayerStride
         );
 
+        /*
+        Creates the tile mapper for this reserved texture and maps the packed MIP-maps of all array layers.
+        This must only be called once, if this texture was created with MiscFlags::Sparse.
+        */
+        void CreateTileMapper(D3D12TileHeapPool& tileHeapPool, ID3D12CommandQueue* commandQueue);
+
+        // Updates the tile mappings of this reserved texture on the specified command queue.
+        void UpdateTileMappings(ID3D12CommandQueue* commandQueue, std::uint32_t numMappings, const TextureTileMapping* mappings);
+
         // Creates either the default SRV for the entire resource or a subresource.
         void CreateShaderResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle);
         void CreateShaderResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const TextureViewDescriptor& desc);
@@ -108,6 +121,12 @@ class D3D12Texture final : public Texture
             return resource_.native.Get();
         }
 
+        // Returns the memory allocation of the native resource. Only placed resources have a valid heap index.
+        inline const D3D12MemoryAllocation& GetAllocation() const
+        {
+            return allocation_;
+        }
+
         // Returns the base texture format. Equivalent of GetFormat().
         inline Format GetBaseFormat() const
         {
@@ -153,6 +172,7 @@ class D3D12Texture final : public Texture
     private:
 
         void CreateNativeTexture(ID3D12Device* device, const TextureDescriptor& desc);
+        void QueryResourceTiling(ID3D12Device* device);
 
         void CreateShaderResourceViewPrimary(
             ID3D12Device*               device,
@@ -175,7 +195,9 @@ class D3D12Texture final : public Texture
 
     private:
 
+        D3D12MemoryAllocator&           memoryAllocator_;
         D3D12Resource                   resource_;
+        D3D12MemoryAllocation           allocation_;        // Memory of the native resource if it's a placed resource
 
         Format                          baseFormat_     = Format::Undefined;
         DXGI_FORMAT                     format_         = DXGI_FORMAT_UNKNOWN;
@@ -185,6 +207,11 @@ class D3D12Texture final : public Texture
 
         ComPtr<ID3D12DescriptorHeap>    mipDescHeap_;
 
+        std::unique_ptr<D3D12TileMapper>        tileMapper_;
+        D3D12_TILE_SHAPE                        tileShape_          = {};
+        D3D12_PACKED_MIP_INFO                   packedMipInfo_      = {};
+        std::vector<D3D12_SUBRESOURCE_TILING>   subresourceTilings_;
+
 };
 
 
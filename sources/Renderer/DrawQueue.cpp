@@ -0,0 +1,318 @@
+/*
+ * DrawQueue.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/DrawQueue.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/Utils/ForRange.h>
+#include "../Core/Assertion.h"
+#include "../Core/Threading.h"
+#include <algorithm>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Compact sort entry, so the radix sort only moves 16 bytes per packet instead of the entire packet.
+struct DrawQueueSortEntry
+{
+    std::uint64_t key;
+    std::uint32_t index;
+};
+
+// Cache of the states that have been bound to a command buffer, so redundant state changes can be skipped.
+struct DrawQueueStateCache
+{
+    const PipelineState*    pipelineState       = nullptr;
+    const ResourceHeap*     resourceHeap        = nullptr;
+    std::uint32_t           descriptorSet       = 0;
+    const Buffer*           vertexBuffer        = nullptr;
+    const BufferArray*      vertexBufferArray   = nullptr;
+    const Buffer*           indexBuffer         = nullptr;
+    Format                  indexFormat         = Format::Undefined;
+};
+
+struct DrawQueue::Pimpl
+{
+    std::vector<DrawPacket>         packets;
+    std::vector<DrawPacket>         draws;          // Sorted and merged packets
+    std::vector<DrawQueueSortEntry> sortEntries;
+    std::vector<DrawQueueSortEntry> sortEntriesTemp;
+    DrawQueueStatistics             stats;
+};
+
+
+/*
+ * Internal functions
+ */
+
+// Stable LSD radix sort over 8-bit digits. Passes where all keys have the same digit are skipped.
+static void RadixSortDrawQueueEntries(std::vector<DrawQueueSortEntry>& entries, std::vector<DrawQueueSortEntry>& temp)
+{
+    const std::size_t numEntries = entries.size();
+    if (numEntries < 2)
+        return;
+
+    temp.resize(numEntries);
+
+    DrawQueueSortEntry* src = entries.data();
+    DrawQueueSortEntry* dst = temp.data();
+
+    for (std::uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        /* Build histogram of current digit */
+        std::size_t histogram[256] = {};
+        for_range(i, numEntries)
+            ++histogram[(src[i].key >> shift) & 0xFF];
+
+        /* Skip this pass if all keys share the same digit */
+        if (histogram[(src[0].key >> shift) & 0xFF] == numEntries)
+            continue;
+
+        /* Convert histogram into offsets and scatter entries */
+        std::size_t offset = 0;
+        for (std::size_t& bucket : histogram)
+        {
+            const std::size_t count = bucket;
+            bucket = offset;
+            offset += count;
+        }
+
+        for_range(i, numEntries)
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+        std::swap(src, dst);
+    }
+
+    /* Move result back into primary container if the last pass wrote into the temporary one */
+    if (src != entries.data())
+        entries.swap(temp);
+}
+
+// Returns true if the specified packets can be merged into a single instanced draw.
+static bool CanMergeDrawPackets(const DrawPacket& lhs, const DrawPacket& rhs)
+{
+    return
+    (
+        lhs.pipelineState       == rhs.pipelineState                        &&
+        lhs.resourceHeap        == rhs.resourceHeap                         &&
+        lhs.descriptorSet       == rhs.descriptorSet                        &&
+        lhs.vertexBuffer        == rhs.vertexBuffer                         &&
+        lhs.vertexBufferArray   == rhs.vertexBufferArray                    &&
+        lhs.indexBuffer         == rhs.indexBuffer                          &&
+        lhs.indexFormat         == rhs.indexFormat                          &&
+        lhs.numVertices         == rhs.numVertices                          &&
+        lhs.firstVertex         == rhs.firstVertex                          &&
+        lhs.vertexOffset        == rhs.vertexOffset                         &&
+        lhs.firstInstance + lhs.numInstances == rhs.firstInstance
+    );
+}
+
+static void EncodeDrawQueueRange(CommandBuffer& commandBuffer, const DrawPacket* draws, std::size_t numDraws, DrawQueueStateCache& cache)
+{
+    for_range(i, numDraws)
+    {
+        const DrawPacket& draw = draws[i];
+
+        if (cache.pipelineState != draw.pipelineState)
+        {
+            commandBuffer.SetPipelineState(*draw.pipelineState);
+            cache.pipelineState = draw.pipelineState;
+        }
+
+        if (draw.resourceHeap != nullptr && (cache.resourceHeap != draw.resourceHeap || cache.descriptorSet != draw.descriptorSet))
+        {
+            commandBuffer.SetResourceHeap(*draw.resourceHeap, draw.descriptorSet);
+            cache.resourceHeap  = draw.resourceHeap;
+            cache.descriptorSet = draw.descriptorSet;
+        }
+
+        if (draw.vertexBufferArray != nullptr)
+        {
+            if (cache.vertexBufferArray != draw.vertexBufferArray)
+            {
+                commandBuffer.SetVertexBufferArray(*draw.vertexBufferArray);
+                cache.vertexBufferArray = draw.vertexBufferArray;
+                cache.vertexBuffer      = nullptr;
+            }
+        }
+        else if (draw.vertexBuffer != nullptr)
+        {
+            if (cache.vertexBuffer != draw.vertexBuffer)
+            {
+                commandBuffer.SetVertexBuffer(*draw.vertexBuffer);
+                cache.vertexBuffer      = draw.vertexBuffer;
+                cache.vertexBufferArray = nullptr;
+            }
+        }
+
+        if (draw.indexBuffer != nullptr)
+        {
+            if (cache.indexBuffer != draw.indexBuffer || cache.indexFormat != draw.indexFormat)
+            {
+                commandBuffer.SetIndexBuffer(*draw.indexBuffer, draw.indexFormat);
+                cache.indexBuffer = draw.indexBuffer;
+                cache.indexFormat = draw.indexFormat;
+            }
+
+            /* Only use the offset-instancing overloads when necessary, since they are not supported by all backends (see RenderingFeatures::hasOffsetInstancing) */
+            if (draw.firstInstance != 0)
+                commandBuffer.DrawIndexedInstanced(draw.numVertices, draw.numInstances, draw.firstVertex, draw.vertexOffset, draw.firstInstance);
+            else
+                commandBuffer.DrawIndexedInstanced(draw.numVertices, draw.numInstances, draw.firstVertex, draw.vertexOffset);
+        }
+        else
+        {
+            if (draw.firstInstance != 0)
+                commandBuffer.DrawInstanced(draw.numVertices, draw.firstVertex, draw.numInstances, draw.firstInstance);
+            else
+                commandBuffer.DrawInstanced(draw.numVertices, draw.firstVertex, draw.numInstances);
+        }
+    }
+}
+
+
+/*
+ * DrawQueue class
+ */
+
+DrawQueue::DrawQueue() :
+    pimpl_ { new Pimpl{} }
+{
+}
+
+DrawQueue::~DrawQueue()
+{
+    delete pimpl_;
+}
+
+void DrawQueue::Clear()
+{
+    pimpl_->packets.clear();
+    pimpl_->draws.clear();
+    pimpl_->stats = DrawQueueStatistics{};
+}
+
+void DrawQueue::Reserve(std::size_t numPackets)
+{
+    pimpl_->packets.reserve(numPackets);
+    pimpl_->draws.reserve(numPackets);
+    pimpl_->sortEntries.reserve(numPackets);
+    pimpl_->sortEntriesTemp.reserve(numPackets);
+}
+
+void DrawQueue::Push(const DrawPacket& packet)
+{
+    LLGL_ASSERT_PTR(packet.pipelineState);
+    LLGL_ASSERT(packet.vertexBuffer == nullptr || packet.vertexBufferArray == nullptr, "draw packet must not have both a vertex buffer and a vertex buffer array");
+    pimpl_->packets.push_back(packet);
+}
+
+void DrawQueue::Sort()
+{
+    const std::vector<DrawPacket>& packets = pimpl_->packets;
+
+    /* Sort compact entries by their keys */
+    std::vector<DrawQueueSortEntry>& entries = pimpl_->sortEntries;
+    entries.resize(packets.size());
+    for_range(i, packets.size())
+    {
+        entries[i].key      = packets[i].sortKey;
+        entries[i].index    = static_cast<std::uint32_t>(i);
+    }
+    RadixSortDrawQueueEntries(entries, pimpl_->sortEntriesTemp);
+
+    /* Gather packets in sorted order and merge adjacent packets into instanced draws */
+    std::vector<DrawPacket>& draws = pimpl_->draws;
+    draws.clear();
+    for (const DrawQueueSortEntry& entry : entries)
+    {
+        const DrawPacket& packet = packets[entry.index];
+        if (!draws.empty() && CanMergeDrawPackets(draws.back(), packet))
+            draws.back().numInstances += packet.numInstances;
+        else
+            draws.push_back(packet);
+    }
+
+    /* Determine statistics for encoding all draws into a single command buffer */
+    DrawQueueStatistics& stats = pimpl_->stats;
+    {
+        stats.numPackets                = static_cast<std::uint32_t>(packets.size());
+        stats.numDraws                  = static_cast<std::uint32_t>(draws.size());
+        stats.numPipelineChanges        = 0;
+        stats.numResourceHeapChanges    = 0;
+    }
+    for_range(i, draws.size())
+    {
+        if (i == 0 || draws[i].pipelineState != draws[i - 1].pipelineState)
+            ++stats.numPipelineChanges;
+        if (draws[i].resourceHeap != nullptr && (i == 0 || draws[i].resourceHeap != draws[i - 1].resourceHeap || draws[i].descriptorSet != draws[i - 1].descriptorSet))
+            ++stats.numResourceHeapChanges;
+    }
+}
+
+void DrawQueue::Encode(CommandBuffer& commandBuffer) const
+{
+    DrawQueueStateCache cache;
+    EncodeDrawQueueRange(commandBuffer, pimpl_->draws.data(), pimpl_->draws.size(), cache);
+}
+
+void DrawQueue::EncodeParallel(
+    std::uint32_t                               numCommandBuffers,
+    CommandBuffer* const *                      commandBuffers,
+    const std::function<void(CommandBuffer&)>&  beginEncoding) const
+{
+    if (numCommandBuffers == 0)
+        return;
+
+    LLGL_ASSERT_PTR(commandBuffers);
+
+    const std::vector<DrawPacket>& draws = pimpl_->draws;
+    const std::size_t numDraws = draws.size();
+
+    DoConcurrent(
+        [&](std::size_t chunk)
+        {
+            CommandBuffer& commandBuffer = *commandBuffers[chunk];
+
+            /* Distribute draws evenly across all command buffers */
+            const std::size_t begin = numDraws * chunk / numCommandBuffers;
+            const std::size_t end   = numDraws * (chunk + 1) / numCommandBuffers;
+
+            commandBuffer.Begin();
+            {
+                if (beginEncoding)
+                    beginEncoding(commandBuffer);
+
+                /* Each command buffer starts with an empty state cache, since states are not inherited between command buffers */
+                DrawQueueStateCache cache;
+                EncodeDrawQueueRange(commandBuffer, draws.data() + begin, end - begin, cache);
+            }
+            commandBuffer.End();
+        },
+        numCommandBuffers,
+        Constants::maxThreadCount,
+        /*threadMinWorkSize:*/ 1
+    );
+}
+
+const DrawQueueStatistics& DrawQueue::GetStatistics() const
+{
+    return pimpl_->stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
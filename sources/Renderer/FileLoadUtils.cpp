@@ -0,0 +1,167 @@
+/*
+ * FileLoadUtils.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "FileLoadUtils.h"
+#include "TextureUtils.h"
+#include "../Core/Threading.h"
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandQueue.h>
+#include <LLGL/Buffer.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Fence.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include <fstream>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Maximum size (in bytes) of file data that is held in CPU memory at once by the emulated file loads.
+static constexpr std::uint64_t g_fileLoadBatchSize = 64ull * 1024ull * 1024ull;
+
+LLGL_EXPORT std::uint64_t GetFileLoadTextureDataSize(const Texture& texture, const TextureRegion& textureRegion)
+{
+    /* Region extent already denotes the extent of the MIP-map level, so only the array layers are accumulated */
+    const TextureSubresource    baseSubresource { 0, textureRegion.subresource.numArrayLayers, 0, 1 };
+    const std::uint32_t         numTexels       = NumMipTexels(texture.GetType(), textureRegion.extent, baseSubresource);
+    return GetMemoryFootprint(texture.GetFormat(), numTexels);
+}
+
+LLGL_EXPORT bool IsFileLoadValid(const FileLoadDescriptor& load)
+{
+    if (load.filename == nullptr || load.size == 0 || load.resource == nullptr)
+        return false;
+
+    switch (load.resource->GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            const auto& buffer = static_cast<const Buffer&>(*load.resource);
+            const std::uint64_t bufferSize = buffer.GetDesc().size;
+            return (load.bufferOffset <= bufferSize && load.size <= bufferSize - load.bufferOffset);
+        }
+
+        case ResourceType::Texture:
+        {
+            const auto& texture = static_cast<const Texture&>(*load.resource);
+            return (load.size == GetFileLoadTextureDataSize(texture, load.textureRegion));
+        }
+
+        default:
+            return false;
+    }
+}
+
+static bool CanOpenFile(const char* filename)
+{
+    std::ifstream file{ filename, std::ios::binary };
+    return file.good();
+}
+
+static bool ReadFileRange(const FileLoadDescriptor& load, char* data)
+{
+    std::ifstream file{ load.filename, std::ios::binary };
+    if (!file.good())
+        return false;
+
+    file.seekg(static_cast<std::streamoff>(load.fileOffset));
+    file.read(data, static_cast<std::streamsize>(load.size));
+
+    return (file.gcount() == static_cast<std::streamsize>(load.size));
+}
+
+static void UploadFileRange(RenderSystem& renderSystem, const FileLoadDescriptor& load, const char* data)
+{
+    if (load.resource->GetResourceType() == ResourceType::Buffer)
+    {
+        auto& buffer = static_cast<Buffer&>(*load.resource);
+        renderSystem.WriteBuffer(buffer, load.bufferOffset, data, load.size);
+    }
+    else
+    {
+        /* File data is in the format of the texture, so pass it through without conversion */
+        auto& texture = static_cast<Texture&>(*load.resource);
+        SrcImageDescriptor imageDesc;
+        {
+            GetPassthroughImageFormat(texture.GetFormat(), imageDesc.format, imageDesc.dataType);
+            imageDesc.data      = data;
+            imageDesc.dataSize  = static_cast<std::size_t>(load.size);
+        }
+        renderSystem.WriteTexture(texture, load.textureRegion, imageDesc);
+    }
+}
+
+LLGL_EXPORT bool SubmitFileLoadsEmulated(RenderSystem& renderSystem, const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    /* Validate all loads before any of them is submitted */
+    for (const FileLoadDescriptor& load : loads)
+    {
+        if (!IsFileLoadValid(load) || !CanOpenFile(load.filename))
+            return false;
+    }
+
+    std::vector<char>           batchData;
+    std::vector<std::uint64_t>  batchOffsets;
+    std::vector<std::uint8_t>   batchRangesRead;
+    bool                        allRangesRead   = true;
+
+    for (std::size_t first = 0; first < loads.size();)
+    {
+        /* Gather as many loads as fit into one batch, but at least one */
+        std::size_t     last        = first;
+        std::uint64_t   batchSize   = 0;
+
+        batchOffsets.clear();
+        while (last < loads.size() && (last == first || batchSize + loads[last].size <= g_fileLoadBatchSize))
+        {
+            batchOffsets.push_back(batchSize);
+            batchSize += loads[last].size;
+            ++last;
+        }
+
+        batchData.resize(static_cast<std::size_t>(batchSize));
+
+        /* Read all file ranges of this batch concurrently */
+        batchRangesRead.assign(last - first, 0);
+        DoConcurrent(
+            [&loads, &batchData, &batchOffsets, &batchRangesRead, first](std::size_t index)
+            {
+                if (ReadFileRange(loads[first + index], batchData.data() + batchOffsets[index]))
+                    batchRangesRead[index] = 1;
+            },
+            last - first,
+            Constants::maxThreadCount,
+            1
+        );
+
+        /* Upload this batch on the calling thread, since the render system is not synchronized; skip ranges that exceed their file */
+        for_range(i, last - first)
+        {
+            if (batchRangesRead[i] != 0)
+                UploadFileRange(renderSystem, loads[first + i], batchData.data() + batchOffsets[i]);
+            else
+                allRangesRead = false;
+        }
+
+        first = last;
+    }
+
+    if (fence != nullptr)
+        renderSystem.GetCommandQueue()->Submit(*fence);
+
+    return allRangesRead;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
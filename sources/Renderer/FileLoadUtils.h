@@ -0,0 +1,47 @@
+/*
+ * FileLoadUtils.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_FILE_LOAD_UTILS_H
+#define LLGL_FILE_LOAD_UTILS_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/RenderSystemFlags.h>
+#include <LLGL/Container/ArrayView.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class Texture;
+class Fence;
+
+// Returns the size (in bytes) of the tightly packed texel data of the specified texture region, as it is expected by a file load.
+LLGL_EXPORT std::uint64_t GetFileLoadTextureDataSize(const Texture& texture, const TextureRegion& textureRegion);
+
+// Returns true if the specified file load has a valid filename, size, and destination range.
+LLGL_EXPORT bool IsFileLoadValid(const FileLoadDescriptor& load);
+
+/*
+Emulates RenderSystem::SubmitFileLoads for backends without a native IO queue.
+Files are read by the worker threads in batches of limited size and each batch is uploaded with RenderSystem::WriteBuffer and RenderSystem::WriteTexture.
+The fence is then submitted to the graphics command queue of the render system.
+*/
+LLGL_EXPORT bool SubmitFileLoadsEmulated(RenderSystem& renderSystem, const ArrayView<FileLoadDescriptor>& loads, Fence* fence);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,146 @@
+/*
+ * FrameCounters.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_FRAME_COUNTERS_H
+#define LLGL_FRAME_COUNTERS_H
+
+
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/Buffer.h>
+#include <LLGL/Texture.h>
+#include <mutex>
+
+
+/*
+Macros to bump the FrameProfile counters of a backend command buffer, which must have a 'frameCounters_' member of type FrameProfile.
+These macros are no-ops unless LLGL is built with LLGL_ENABLE_FRAME_COUNTERS.
+Command buffers must only be encoded by a single thread at a time, so these counters are effectively thread-local and don't need synchronization.
+*/
+#ifdef LLGL_ENABLE_FRAME_COUNTERS
+
+#define LLGL_FRAME_COUNTER_INC(NAME) \
+    (++frameCounters_.NAME)
+
+#define LLGL_FRAME_COUNTER_BEGIN() \
+    (frameCounters_.Clear(), ++frameCounters_.commandBufferEncodings)
+
+#define LLGL_FRAME_COUNTER_RESOURCE(RESOURCE) \
+    CountResourceBinding(frameCounters_, (RESOURCE))
+
+#define LLGL_FRAME_COUNTER_EXECUTE(COUNTERS) \
+    frameCounters_.Accumulate(COUNTERS)
+
+#else
+
+#define LLGL_FRAME_COUNTER_INC(NAME)                ((void)0)
+#define LLGL_FRAME_COUNTER_BEGIN()                  ((void)0)
+#define LLGL_FRAME_COUNTER_RESOURCE(RESOURCE)       ((void)0)
+#define LLGL_FRAME_COUNTER_EXECUTE(COUNTERS)        ((void)0)
+
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+Increments the resource binding counter of the specified profile that corresponds to the resource type and its binding flags.
+Storage bindings take precedence over constant buffer and sampled bindings, since the backends don't know which binding slot a multi-purpose resource is bound to.
+*/
+inline void CountResourceBinding(FrameProfile& profile, const Resource& resource)
+{
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            const long bindFlags = static_cast<const Buffer&>(resource).GetBindFlags();
+            if ((bindFlags & BindFlags::Storage) != 0)
+                profile.storageBufferBindings++;
+            else if ((bindFlags & BindFlags::ConstantBuffer) != 0)
+                profile.constantBufferBindings++;
+            else
+                profile.sampledBufferBindings++;
+        }
+        break;
+
+        case ResourceType::Texture:
+        {
+            const long bindFlags = static_cast<const Texture&>(resource).GetBindFlags();
+            if ((bindFlags & BindFlags::Storage) != 0)
+                profile.storageTextureBindings++;
+            else
+                profile.sampledTextureBindings++;
+        }
+        break;
+
+        case ResourceType::Sampler:
+            profile.samplerBindings++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Thread-safe accumulator for the frame counters of all command buffers that are submitted to a command queue.
+class FrameCounterAccumulator
+{
+
+    public:
+
+        // Accumulates the counters of the specified command buffer that is submitted to the queue.
+        inline void SubmitCommandBuffer(const FrameProfile& counters)
+        {
+            #ifdef LLGL_ENABLE_FRAME_COUNTERS
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            profile_.Accumulate(counters);
+            profile_.commandBufferSubmittions++;
+            #endif
+        }
+
+        // Increments the fence submission counter.
+        inline void SubmitFence()
+        {
+            #ifdef LLGL_ENABLE_FRAME_COUNTERS
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            profile_.fenceSubmissions++;
+            #endif
+        }
+
+        // Moves all accumulated counters into the output profile. Returns false if LLGL was built without frame counters.
+        inline bool Query(FrameProfile& outProfile)
+        {
+            #ifdef LLGL_ENABLE_FRAME_COUNTERS
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            outProfile = profile_;
+            profile_.Clear();
+            return true;
+            #else
+            outProfile.Clear();
+            return false;
+            #endif
+        }
+
+    private:
+
+        #ifdef LLGL_ENABLE_FRAME_COUNTERS
+        std::mutex      mutex_;
+        FrameProfile    profile_;
+        #endif
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
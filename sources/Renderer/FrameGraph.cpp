@@ -0,0 +1,619 @@
+/*
+ * FrameGraph.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/FrameGraph.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/RenderTarget.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Buffer.h>
+#include <LLGL/Format.h>
+#include "../Core/Assertion.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+static constexpr std::size_t invalidPhysicalIndex = ~static_cast<std::size_t>(0);
+
+// Physical resource that is owned by the frame graph and can be shared between transient resources.
+struct FrameGraphPhysicalResource
+{
+    Resource*           resource    = nullptr;
+    TextureDescriptor   textureDesc;
+    BufferDescriptor    bufferDesc;
+    std::uint64_t       size        = 0;
+    bool                inUse       = false;    // Assigned to a transient resource whose lifetime has not ended yet
+    bool                used        = false;    // Used by the most recent call to Compile()
+};
+
+// Virtual resource as it is declared by the client for a single frame.
+struct FrameGraphVirtualResource
+{
+    ResourceType        type        = ResourceType::Undefined;
+    bool                imported    = false;
+    bool                needed      = false;    // Consumed by a pass that has not been culled
+    TextureDescriptor   textureDesc;
+    BufferDescriptor    bufferDesc;
+    Resource*           resource    = nullptr;  // Physical resource assigned by Compile() or the imported resource
+    std::uint32_t       firstPass   = ~0u;
+    std::uint32_t       lastPass    = 0;
+    std::size_t         physical    = invalidPhysicalIndex; // Index into the physical resource pool
+};
+
+struct FrameGraphPass
+{
+    FrameGraphPassDescriptor    desc;
+    RenderTarget*               renderTarget    = nullptr;
+    bool                        culled          = false;
+};
+
+// Render target that has been created for the attachments of a pass.
+struct FrameGraphRenderTarget
+{
+    RenderTarget*       renderTarget                                    = nullptr;
+    const RenderPass*   renderPass                                      = nullptr;
+    Texture*            colorAttachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS]  = {};
+    std::uint32_t       numColorAttachments                             = 0;
+    Texture*            depthStencilAttachment                          = nullptr;
+    bool                hasImportedAttachments                          = false;
+    bool                used                                            = false;
+};
+
+struct FrameGraph::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem) :
+        renderSystem { renderSystem }
+    {
+    }
+
+    RenderSystem&                           renderSystem;
+    std::vector<FrameGraphVirtualResource>  resources;
+    std::vector<FrameGraphPass>             passes;
+    std::vector<FrameGraphPhysicalResource> physicalResources;
+    std::vector<FrameGraphRenderTarget>     renderTargets;
+    FrameGraphStatistics                    stats;
+    bool                                    compiled        = false;
+};
+
+
+/*
+ * Internal functions
+ */
+
+static std::uint64_t GetTextureMemorySize(const TextureDescriptor& textureDesc)
+{
+    const TextureSubresource subresource{ 0, textureDesc.arrayLayers, 0, NumMipLevels(textureDesc) };
+    const std::uint64_t size = GetMemoryFootprint(textureDesc.type, textureDesc.format, textureDesc.extent, subresource);
+    return size * std::max<std::uint32_t>(1u, textureDesc.samples);
+}
+
+// Returns true if the physical texture can be used in place of a texture with the specified descriptor.
+static bool IsTextureCompatible(const TextureDescriptor& physicalDesc, const TextureDescriptor& desc)
+{
+    return
+    (
+        physicalDesc.type           == desc.type            &&
+        physicalDesc.format         == desc.format          &&
+        physicalDesc.extent         == desc.extent          &&
+        physicalDesc.arrayLayers    == desc.arrayLayers     &&
+        physicalDesc.samples        == desc.samples         &&
+        physicalDesc.miscFlags      == desc.miscFlags       &&
+        NumMipLevels(physicalDesc)  == NumMipLevels(desc)   &&
+        (physicalDesc.bindFlags & desc.bindFlags) == desc.bindFlags
+    );
+}
+
+// Returns true if the physical buffer can be used in place of a buffer with the specified descriptor.
+static bool IsBufferCompatible(const BufferDescriptor& physicalDesc, const BufferDescriptor& desc)
+{
+    return
+    (
+        physicalDesc.size       == desc.size        &&
+        physicalDesc.stride     == desc.stride      &&
+        physicalDesc.format     == desc.format      &&
+        physicalDesc.miscFlags  == desc.miscFlags   &&
+        (physicalDesc.bindFlags & desc.bindFlags) == desc.bindFlags
+    );
+}
+
+static void ReleaseFrameGraphRenderTarget(RenderSystem& renderSystem, FrameGraphRenderTarget& entry)
+{
+    if (entry.renderTarget != nullptr)
+    {
+        renderSystem.Release(*entry.renderTarget);
+        entry.renderTarget = nullptr;
+    }
+}
+
+static void ReleaseFrameGraphPhysicalResource(RenderSystem& renderSystem, FrameGraphPhysicalResource& entry)
+{
+    if (entry.resource != nullptr)
+    {
+        if (entry.resource->GetResourceType() == ResourceType::Texture)
+            renderSystem.Release(static_cast<Texture&>(*entry.resource));
+        else
+            renderSystem.Release(static_cast<Buffer&>(*entry.resource));
+        entry.resource = nullptr;
+    }
+}
+
+static FrameGraphVirtualResource& GetVirtualResource(std::vector<FrameGraphVirtualResource>& resources, FrameGraphResource handle)
+{
+    LLGL_ASSERT(handle > 0 && handle <= resources.size(), "invalid frame graph resource handle");
+    return resources[handle - 1];
+}
+
+static const FrameGraphVirtualResource* FindVirtualResource(const std::vector<FrameGraphVirtualResource>& resources, FrameGraphResource handle)
+{
+    return (handle > 0 && handle <= resources.size() ? &(resources[handle - 1]) : nullptr);
+}
+
+template <typename TFunc>
+static void ForEachPassResource(const FrameGraphPassDescriptor& passDesc, const TFunc& func)
+{
+    for (FrameGraphResource handle : passDesc.reads)
+        func(handle);
+    for (FrameGraphResource handle : passDesc.writes)
+        func(handle);
+    for (FrameGraphResource handle : passDesc.colorAttachments)
+        func(handle);
+    if (passDesc.depthStencilAttachment != 0)
+        func(passDesc.depthStencilAttachment);
+}
+
+template <typename TFunc>
+static void ForEachPassOutput(const FrameGraphPassDescriptor& passDesc, const TFunc& func)
+{
+    for (FrameGraphResource handle : passDesc.writes)
+        func(handle);
+    for (FrameGraphResource handle : passDesc.colorAttachments)
+        func(handle);
+    if (passDesc.depthStencilAttachment != 0)
+        func(passDesc.depthStencilAttachment);
+}
+
+static std::size_t AcquirePhysicalResource(RenderSystem& renderSystem, std::vector<FrameGraphPhysicalResource>& pool, const FrameGraphVirtualResource& virtualResource)
+{
+    const bool isTexture = (virtualResource.type == ResourceType::Texture);
+
+    /* Find compatible physical resource that is currently not in use; prefer resources that already exist from previous frames */
+    for (std::size_t i = 0; i < pool.size(); ++i)
+    {
+        FrameGraphPhysicalResource& entry = pool[i];
+        if (entry.inUse || entry.resource == nullptr || (entry.resource->GetResourceType() == ResourceType::Texture) != isTexture)
+            continue;
+
+        const bool isCompatible =
+        (
+            isTexture
+                ? IsTextureCompatible(entry.textureDesc, virtualResource.textureDesc)
+                : IsBufferCompatible(entry.bufferDesc, virtualResource.bufferDesc)
+        );
+
+        if (isCompatible)
+        {
+            entry.inUse = true;
+            entry.used  = true;
+            return i;
+        }
+    }
+
+    /* Create new physical resource */
+    FrameGraphPhysicalResource entry;
+    if (isTexture)
+    {
+        entry.textureDesc   = virtualResource.textureDesc;
+        entry.resource      = renderSystem.CreateTexture(entry.textureDesc);
+        entry.size          = GetTextureMemorySize(entry.textureDesc);
+    }
+    else
+    {
+        entry.bufferDesc    = virtualResource.bufferDesc;
+        entry.resource      = renderSystem.CreateBuffer(entry.bufferDesc);
+        entry.size          = entry.bufferDesc.size;
+    }
+    entry.inUse = true;
+    entry.used  = true;
+
+    /* Re-use empty slot in pool */
+    for (std::size_t i = 0; i < pool.size(); ++i)
+    {
+        if (pool[i].resource == nullptr)
+        {
+            pool[i] = entry;
+            return i;
+        }
+    }
+
+    pool.push_back(entry);
+    return pool.size() - 1;
+}
+
+static RenderTarget* AcquireRenderTarget(
+    RenderSystem&                           renderSystem,
+    std::vector<FrameGraphRenderTarget>&    renderTargets,
+    std::vector<FrameGraphVirtualResource>& resources,
+    const FrameGraphPassDescriptor&         passDesc)
+{
+    /* Gather physical attachments */
+    FrameGraphRenderTarget key;
+    key.renderPass          = passDesc.renderPass;
+    key.numColorAttachments = static_cast<std::uint32_t>(passDesc.colorAttachments.size());
+
+    for (std::uint32_t i = 0; i < key.numColorAttachments; ++i)
+    {
+        const FrameGraphVirtualResource& attachment = GetVirtualResource(resources, passDesc.colorAttachments[i]);
+        LLGL_ASSERT(attachment.type == ResourceType::Texture, "frame graph color attachment must be a texture");
+        key.colorAttachments[i] = static_cast<Texture*>(attachment.resource);
+        key.hasImportedAttachments |= attachment.imported;
+    }
+
+    if (passDesc.depthStencilAttachment != 0)
+    {
+        const FrameGraphVirtualResource& attachment = GetVirtualResource(resources, passDesc.depthStencilAttachment);
+        LLGL_ASSERT(attachment.type == ResourceType::Texture, "frame graph depth-stencil attachment must be a texture");
+        key.depthStencilAttachment = static_cast<Texture*>(attachment.resource);
+        key.hasImportedAttachments |= attachment.imported;
+    }
+
+    /* Find render target with the same attachments */
+    for (FrameGraphRenderTarget& entry : renderTargets)
+    {
+        if (entry.renderTarget != nullptr &&
+            entry.renderPass             == key.renderPass             &&
+            entry.numColorAttachments    == key.numColorAttachments    &&
+            entry.depthStencilAttachment == key.depthStencilAttachment &&
+            std::equal(key.colorAttachments, key.colorAttachments + key.numColorAttachments, entry.colorAttachments))
+        {
+            entry.used = true;
+            return entry.renderTarget;
+        }
+    }
+
+    /* Create new render target */
+    RenderTargetDescriptor renderTargetDesc;
+    {
+        renderTargetDesc.renderPass = key.renderPass;
+        for (std::uint32_t i = 0; i < key.numColorAttachments; ++i)
+            renderTargetDesc.colorAttachments[i] = key.colorAttachments[i];
+        if (key.depthStencilAttachment != nullptr)
+            renderTargetDesc.depthStencilAttachment = key.depthStencilAttachment;
+
+        const Texture* firstAttachment = (key.numColorAttachments > 0 ? key.colorAttachments[0] : key.depthStencilAttachment);
+        const Extent3D extent = firstAttachment->GetMipExtent(0);
+        renderTargetDesc.resolution = Extent2D{ extent.width, extent.height };
+        renderTargetDesc.samples    = firstAttachment->GetDesc().samples;
+    }
+    key.renderTarget    = renderSystem.CreateRenderTarget(renderTargetDesc);
+    key.used            = true;
+
+    renderTargets.push_back(key);
+    return key.renderTarget;
+}
+
+
+/*
+ * FrameGraph class
+ */
+
+FrameGraph::FrameGraph(RenderSystem& renderSystem) :
+    pimpl_ { new Pimpl{ renderSystem } }
+{
+}
+
+FrameGraph::~FrameGraph()
+{
+    for (FrameGraphRenderTarget& entry : pimpl_->renderTargets)
+        ReleaseFrameGraphRenderTarget(pimpl_->renderSystem, entry);
+    for (FrameGraphPhysicalResource& entry : pimpl_->physicalResources)
+        ReleaseFrameGraphPhysicalResource(pimpl_->renderSystem, entry);
+    delete pimpl_;
+}
+
+FrameGraphResource FrameGraph::CreateTexture(const TextureDescriptor& textureDesc)
+{
+    FrameGraphVirtualResource resource;
+    {
+        resource.type           = ResourceType::Texture;
+        resource.textureDesc    = textureDesc;
+    }
+    pimpl_->resources.push_back(resource);
+    return static_cast<FrameGraphResource>(pimpl_->resources.size());
+}
+
+FrameGraphResource FrameGraph::CreateBuffer(const BufferDescriptor& bufferDesc)
+{
+    LLGL_ASSERT(bufferDesc.cpuAccessFlags == 0, "transient frame graph buffers must not have CPU access flags");
+    FrameGraphVirtualResource resource;
+    {
+        resource.type                       = ResourceType::Buffer;
+        resource.bufferDesc                 = bufferDesc;
+        resource.bufferDesc.vertexAttribs   = {};
+    }
+    pimpl_->resources.push_back(resource);
+    return static_cast<FrameGraphResource>(pimpl_->resources.size());
+}
+
+FrameGraphResource FrameGraph::ImportTexture(Texture& texture)
+{
+    FrameGraphVirtualResource resource;
+    {
+        resource.type       = ResourceType::Texture;
+        resource.imported   = true;
+        resource.resource   = &texture;
+    }
+    pimpl_->resources.push_back(resource);
+    return static_cast<FrameGraphResource>(pimpl_->resources.size());
+}
+
+FrameGraphResource FrameGraph::ImportBuffer(Buffer& buffer)
+{
+    FrameGraphVirtualResource resource;
+    {
+        resource.type       = ResourceType::Buffer;
+        resource.imported   = true;
+        resource.resource   = &buffer;
+    }
+    pimpl_->resources.push_back(resource);
+    return static_cast<FrameGraphResource>(pimpl_->resources.size());
+}
+
+std::uint32_t FrameGraph::AddPass(const FrameGraphPassDescriptor& passDesc)
+{
+    LLGL_ASSERT(passDesc.execute, "frame graph pass must have a callback function");
+    LLGL_ASSERT_RANGE(passDesc.colorAttachments.size(), LLGL_MAX_NUM_COLOR_ATTACHMENTS);
+    LLGL_ASSERT(
+        passDesc.renderTarget == nullptr || (passDesc.colorAttachments.empty() && passDesc.depthStencilAttachment == 0),
+        "frame graph pass must not have attachments and an external render target at the same time"
+    );
+
+    FrameGraphPass pass;
+    pass.desc = passDesc;
+    pimpl_->passes.push_back(pass);
+    return static_cast<std::uint32_t>(pimpl_->passes.size() - 1);
+}
+
+void FrameGraph::Compile()
+{
+    std::vector<FrameGraphVirtualResource>& resources = pimpl_->resources;
+    std::vector<FrameGraphPass>& passes = pimpl_->passes;
+    const std::uint32_t numPasses = static_cast<std::uint32_t>(passes.size());
+
+    /* Reset previous compilation of the current frame */
+    for (FrameGraphVirtualResource& resource : resources)
+    {
+        resource.needed     = false;
+        resource.firstPass  = ~0u;
+        resource.lastPass   = 0;
+        if (!resource.imported)
+        {
+            resource.resource = nullptr;
+            resource.physical = invalidPhysicalIndex;
+        }
+    }
+    for (FrameGraphPass& pass : passes)
+        pass.renderTarget = nullptr;
+
+    /* Cull passes in reverse order, so each pass is only kept if a subsequent pass that is kept consumes one of its outputs */
+    for (std::uint32_t i = numPasses; i-- > 0;)
+    {
+        FrameGraphPass& pass = passes[i];
+
+        bool hasConsumedOutputs = (pass.desc.renderTarget != nullptr);
+        ForEachPassOutput(
+            pass.desc,
+            [&resources, &hasConsumedOutputs](FrameGraphResource handle)
+            {
+                const FrameGraphVirtualResource& resource = GetVirtualResource(resources, handle);
+                if (resource.imported || resource.needed)
+                    hasConsumedOutputs = true;
+            }
+        );
+
+        pass.culled = !hasConsumedOutputs;
+        if (pass.culled)
+            continue;
+
+        /*
+        Mark all resources of this pass as needed. This includes the outputs,
+        since a pass may load the previous content of its attachments or read-modify-write its storage resources.
+        */
+        ForEachPassResource(
+            pass.desc,
+            [&resources, i](FrameGraphResource handle)
+            {
+                FrameGraphVirtualResource& resource = GetVirtualResource(resources, handle);
+                resource.needed     = true;
+                resource.firstPass  = std::min(resource.firstPass, i);
+                resource.lastPass   = std::max(resource.lastPass, i);
+            }
+        );
+    }
+
+    /* Reset usage of physical resources */
+    for (FrameGraphPhysicalResource& entry : pimpl_->physicalResources)
+    {
+        entry.inUse = false;
+        entry.used  = false;
+    }
+    for (FrameGraphRenderTarget& entry : pimpl_->renderTargets)
+        entry.used = false;
+
+    /* Assign physical resources in execution order; a physical resource becomes available again after the last pass that uses it */
+    FrameGraphStatistics& stats = pimpl_->stats;
+    stats = FrameGraphStatistics{};
+    stats.numPasses = numPasses;
+
+    for (std::uint32_t i = 0; i < numPasses; ++i)
+    {
+        FrameGraphPass& pass = passes[i];
+        if (pass.culled)
+        {
+            stats.numCulledPasses++;
+            continue;
+        }
+
+        ForEachPassResource(
+            pass.desc,
+            [this, &resources, &stats, i](FrameGraphResource handle)
+            {
+                FrameGraphVirtualResource& resource = GetVirtualResource(resources, handle);
+                if (!resource.imported && resource.firstPass == i && resource.resource == nullptr)
+                {
+                    resource.physical = AcquirePhysicalResource(pimpl_->renderSystem, pimpl_->physicalResources, resource);
+                    resource.resource = pimpl_->physicalResources[resource.physical].resource;
+                    stats.numTransientResources++;
+                    stats.transientMemorySize += pimpl_->physicalResources[resource.physical].size;
+                }
+            }
+        );
+
+        if (pass.desc.renderTarget != nullptr)
+            pass.renderTarget = pass.desc.renderTarget;
+        else if (!pass.desc.colorAttachments.empty() || pass.desc.depthStencilAttachment != 0)
+            pass.renderTarget = AcquireRenderTarget(pimpl_->renderSystem, pimpl_->renderTargets, resources, pass.desc);
+
+        ForEachPassResource(
+            pass.desc,
+            [this, &resources, i](FrameGraphResource handle)
+            {
+                FrameGraphVirtualResource& resource = GetVirtualResource(resources, handle);
+                if (!resource.imported && resource.lastPass == i && resource.physical != invalidPhysicalIndex)
+                    pimpl_->physicalResources[resource.physical].inUse = false;
+            }
+        );
+    }
+
+    for (const FrameGraphPhysicalResource& entry : pimpl_->physicalResources)
+    {
+        if (entry.used)
+        {
+            stats.numPhysicalResources++;
+            stats.physicalMemorySize += entry.size;
+        }
+    }
+
+    pimpl_->compiled = true;
+}
+
+void FrameGraph::Execute(CommandBuffer& commandBuffer)
+{
+    LLGL_ASSERT(pimpl_->compiled, "frame graph must be compiled before it can be executed");
+
+    for (std::uint32_t i = 0, n = static_cast<std::uint32_t>(pimpl_->passes.size()); i < n; ++i)
+    {
+        const FrameGraphPass& pass = pimpl_->passes[i];
+        if (pass.culled)
+            continue;
+
+        if (pass.desc.debugName != nullptr)
+            commandBuffer.PushDebugGroup(pass.desc.debugName);
+
+        if (pass.renderTarget != nullptr)
+            commandBuffer.BeginRenderPass(*pass.renderTarget);
+
+        const FrameGraphPassContext context{ *this, pass.renderTarget, i };
+        pass.desc.execute(commandBuffer, context);
+
+        if (pass.renderTarget != nullptr)
+            commandBuffer.EndRenderPass();
+
+        if (pass.desc.debugName != nullptr)
+            commandBuffer.PopDebugGroup();
+    }
+}
+
+void FrameGraph::Reset()
+{
+    /* Imported textures may be released by the client, so render targets that refer to them must not outlive the frame */
+    for (FrameGraphRenderTarget& entry : pimpl_->renderTargets)
+    {
+        if (entry.hasImportedAttachments)
+            ReleaseFrameGraphRenderTarget(pimpl_->renderSystem, entry);
+    }
+
+    pimpl_->renderTargets.erase(
+        std::remove_if(
+            pimpl_->renderTargets.begin(),
+            pimpl_->renderTargets.end(),
+            [](const FrameGraphRenderTarget& entry) -> bool
+            {
+                return (entry.renderTarget == nullptr);
+            }
+        ),
+        pimpl_->renderTargets.end()
+    );
+
+    pimpl_->resources.clear();
+    pimpl_->passes.clear();
+    pimpl_->compiled = false;
+}
+
+void FrameGraph::ReleaseUnusedResources()
+{
+    /* Release render targets first, since they refer to the physical textures */
+    for (FrameGraphRenderTarget& entry : pimpl_->renderTargets)
+    {
+        if (!entry.used)
+            ReleaseFrameGraphRenderTarget(pimpl_->renderSystem, entry);
+    }
+
+    pimpl_->renderTargets.erase(
+        std::remove_if(
+            pimpl_->renderTargets.begin(),
+            pimpl_->renderTargets.end(),
+            [](const FrameGraphRenderTarget& entry) -> bool
+            {
+                return (entry.renderTarget == nullptr);
+            }
+        ),
+        pimpl_->renderTargets.end()
+    );
+
+    /* Keep the slots of released physical resources, since the current virtual resources refer to them by index */
+    for (FrameGraphPhysicalResource& entry : pimpl_->physicalResources)
+    {
+        if (!entry.used)
+            ReleaseFrameGraphPhysicalResource(pimpl_->renderSystem, entry);
+    }
+}
+
+Texture* FrameGraph::GetTexture(FrameGraphResource resource) const
+{
+    const FrameGraphVirtualResource* entry = FindVirtualResource(pimpl_->resources, resource);
+    return (entry != nullptr && entry->type == ResourceType::Texture ? static_cast<Texture*>(entry->resource) : nullptr);
+}
+
+Buffer* FrameGraph::GetBuffer(FrameGraphResource resource) const
+{
+    const FrameGraphVirtualResource* entry = FindVirtualResource(pimpl_->resources, resource);
+    return (entry != nullptr && entry->type == ResourceType::Buffer ? static_cast<Buffer*>(entry->resource) : nullptr);
+}
+
+bool FrameGraph::IsPassCulled(std::uint32_t passIndex) const
+{
+    return (passIndex < pimpl_->passes.size() && pimpl_->passes[passIndex].culled);
+}
+
+const FrameGraphStatistics& FrameGraph::GetStatistics() const
+{
+    return pimpl_->stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
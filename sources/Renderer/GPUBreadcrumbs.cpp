@@ -0,0 +1,159 @@
+/*
+ * GPUBreadcrumbs.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GPUBreadcrumbs.h"
+#include <LLGL/Log.h>
+#include <algorithm>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+// Number of bits of a marker value for the command index; the remaining upper bits store the encoding.
+static constexpr std::uint32_t g_markerIndexBits    = 24;
+static constexpr std::uint32_t g_markerIndexMask    = ((1u << g_markerIndexBits) - 1u);
+
+struct GPUBreadcrumbRegistry
+{
+    std::mutex                          mutex;
+    std::vector<GPUBreadcrumbTrail*>    trails;
+};
+
+static GPUBreadcrumbRegistry& GetGPUBreadcrumbRegistry()
+{
+    static GPUBreadcrumbRegistry registry;
+    return registry;
+}
+
+GPUBreadcrumbTrail::~GPUBreadcrumbTrail()
+{
+    if (IsRegistered())
+    {
+        GPUBreadcrumbRegistry& registry = GetGPUBreadcrumbRegistry();
+        std::lock_guard<std::mutex> guard{ registry.mutex };
+        registry.trails.erase(std::remove(registry.trails.begin(), registry.trails.end(), this), registry.trails.end());
+    }
+}
+
+void GPUBreadcrumbTrail::Register(const volatile std::uint32_t* markerMemory)
+{
+    if (markerMemory == nullptr || IsRegistered())
+        return;
+
+    markerMemory_ = markerMemory;
+
+    GPUBreadcrumbRegistry& registry = GetGPUBreadcrumbRegistry();
+    std::lock_guard<std::mutex> guard{ registry.mutex };
+    registry.trails.push_back(this);
+}
+
+void GPUBreadcrumbTrail::SetName(const char* name)
+{
+    name_ = (name != nullptr ? name : "");
+}
+
+void GPUBreadcrumbTrail::Begin()
+{
+    ++encoding_;
+    markers_.clear();
+    groupPaths_.clear();
+    groupStack_.clear();
+
+    /* Path 0 is the root without any debug group */
+    groupPaths_.push_back(std::string{});
+}
+
+std::uint32_t GPUBreadcrumbTrail::PushDebugGroup(const char* name)
+{
+    /* Append new group path from the current path */
+    std::string path = groupPaths_[groupStack_.empty() ? 0 : groupStack_.back()];
+    if (!path.empty())
+        path += " > ";
+    path += (name != nullptr ? name : "<null pointer>");
+
+    groupStack_.push_back(static_cast<std::uint32_t>(groupPaths_.size()));
+    groupPaths_.push_back(std::move(path));
+
+    return MarkCommand("PushDebugGroup");
+}
+
+std::uint32_t GPUBreadcrumbTrail::PopDebugGroup()
+{
+    /* Mark the end of the group with the group's path before it's popped */
+    const std::uint32_t marker = MarkCommand("PopDebugGroup");
+    if (!groupStack_.empty())
+        groupStack_.pop_back();
+    return marker;
+}
+
+std::uint32_t GPUBreadcrumbTrail::MarkCommand(const char* command)
+{
+    /* Don't record markers beyond the index range, marker 0 is never reported */
+    const std::uint32_t index = static_cast<std::uint32_t>(markers_.size()) + 1u;
+    if (index > g_markerIndexMask)
+        return 0;
+
+    markers_.push_back(Marker{ command, (groupStack_.empty() ? 0 : groupStack_.back()) });
+
+    return ((encoding_ << g_markerIndexBits) | index);
+}
+
+void GPUBreadcrumbTrail::Report() const
+{
+    if (!IsRegistered())
+        return;
+
+    const std::uint32_t lastStarted     = markerMemory_[0];
+    const std::uint32_t lastCompleted   = markerMemory_[1];
+    if (lastStarted == 0 && lastCompleted == 0)
+        return;
+
+    const char* name = (name_.empty() ? "<unnamed>" : name_.c_str());
+    Log::Errorf(
+        "GPU breadcrumbs for command buffer %s:\n  last started command: %s\n  last completed command: %s\n",
+        name, DescribeMarker(lastStarted).c_str(), DescribeMarker(lastCompleted).c_str()
+    );
+}
+
+std::string GPUBreadcrumbTrail::DescribeMarker(std::uint32_t marker) const
+{
+    if (marker == 0)
+        return "none";
+
+    /* Markers of a previous encoding can't be resolved, since the trail is cleared on each encoding */
+    const std::uint32_t encoding    = (marker >> g_markerIndexBits);
+    const std::uint32_t index       = (marker & g_markerIndexMask);
+    if (encoding != (encoding_ & (0xFFFFFFFFu >> g_markerIndexBits)) || index == 0 || index > markers_.size())
+        return "#" + std::to_string(index) + " from a previous encoding";
+
+    const Marker& entry = markers_[index - 1];
+    std::string s = "#" + std::to_string(index) + " " + entry.command;
+    if (entry.groupPath != 0)
+    {
+        s += " in debug group \"";
+        s += groupPaths_[entry.groupPath];
+        s += '\"';
+    }
+    return s;
+}
+
+LLGL_EXPORT void ReportGPUBreadcrumbs()
+{
+    GPUBreadcrumbRegistry& registry = GetGPUBreadcrumbRegistry();
+    std::lock_guard<std::mutex> guard{ registry.mutex };
+    for (const GPUBreadcrumbTrail* trail : registry.trails)
+        trail->Report();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,101 @@
+/*
+ * GPUBreadcrumbs.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GPU_BREADCRUMBS_H
+#define LLGL_GPU_BREADCRUMBS_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/NonCopyable.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+CPU-side trail of the breadcrumb markers that a backend command buffer writes into host-visible memory (see RenderSystemFlags::GPUBreadcrumbs).
+The backend writes two 32-bit values after each marked command: the marker of the last command that has started and of the last command that has completed.
+Each marker value contains the encoding it belongs to in its upper 8 bits and the one-based index of the marked command within that encoding in its lower 24 bits.
+After device loss, ReportGPUBreadcrumbs() looks up these markers in all registered trails and reports the command and its debug group path.
+*/
+class LLGL_EXPORT GPUBreadcrumbTrail : public NonCopyable
+{
+
+    public:
+
+        GPUBreadcrumbTrail() = default;
+        ~GPUBreadcrumbTrail();
+
+        // Registers this trail for ReportGPUBreadcrumbs() with the host-visible memory of two 32-bit values the GPU writes the markers into.
+        void Register(const volatile std::uint32_t* markerMemory);
+
+        // Sets the name of this trail that is printed with the report, i.e. the name of the command buffer.
+        void SetName(const char* name);
+
+        // Starts a new encoding and clears all markers of the previous encoding.
+        void Begin();
+
+        // Pushes a new debug group and returns the marker for the beginning of that group.
+        std::uint32_t PushDebugGroup(const char* name);
+
+        // Pops the current debug group and returns the marker for the end of that group.
+        std::uint32_t PopDebugGroup();
+
+        // Returns the marker for the specified command. The command name must be a string literal.
+        std::uint32_t MarkCommand(const char* command);
+
+        // Returns true if this trail has been registered with marker memory.
+        inline bool IsRegistered() const
+        {
+            return (markerMemory_ != nullptr);
+        }
+
+    public:
+
+        // Prints the commands that correspond to the markers in the host-visible memory of this trail.
+        void Report() const;
+
+    private:
+
+        struct Marker
+        {
+            const char*     command;
+            std::uint32_t   groupPath;  // Index into 'groupPaths_'
+        };
+
+    private:
+
+        // Returns a description of the specified marker value, including its debug group path.
+        std::string DescribeMarker(std::uint32_t marker) const;
+
+    private:
+
+        const volatile std::uint32_t*   markerMemory_   = nullptr;
+        std::string                     name_;
+        std::uint32_t                   encoding_       = 0;
+        std::vector<Marker>             markers_;
+        std::vector<std::string>        groupPaths_;
+        std::vector<std::uint32_t>      groupStack_;
+
+};
+
+// Reports the last started and completed command of all registered breadcrumb trails. This should be called after the device has been lost.
+LLGL_EXPORT void ReportGPUBreadcrumbs();
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
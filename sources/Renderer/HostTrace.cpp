@@ -0,0 +1,108 @@
+/*
+ * HostTrace.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "HostTrace.h"
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/Timer.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+LLGL_EXPORT std::uint64_t GetHostTimeInNanosecs()
+{
+    static const std::uint64_t frequency = Timer::Frequency();
+    const std::uint64_t tick = Timer::Tick();
+    return (tick / frequency) * 1000000000ull + ((tick % frequency) * 1000000000ull) / frequency;
+}
+
+#ifdef LLGL_ENABLE_HOST_TRACE
+
+// Maximum number of pending host records. Spans beyond this limit are discarded until the records are collected.
+static constexpr std::size_t g_maxPendingHostRecords = 65536;
+
+struct HostTraceThreadState
+{
+    std::uint32_t threadID  = ~0u;
+    std::uint32_t depth     = 0;
+};
+
+struct HostTraceCollector
+{
+    std::mutex                      mutex;
+    std::vector<ProfileHostRecord>  records;
+};
+
+static std::atomic<std::uint32_t>          g_hostTraceThreadCounter{ 0 };
+static thread_local HostTraceThreadState    g_hostTraceThreadState;
+
+static HostTraceCollector& GetHostTraceCollector()
+{
+    static HostTraceCollector collector;
+    return collector;
+}
+
+HostTraceScope::HostTraceScope(const char* name) :
+    name_ { name }
+{
+    HostTraceThreadState& state = g_hostTraceThreadState;
+    if (state.threadID == ~0u)
+        state.threadID = g_hostTraceThreadCounter++;
+    ++state.depth;
+    beginTime_ = GetHostTimeInNanosecs();
+}
+
+HostTraceScope::~HostTraceScope()
+{
+    const std::uint64_t endTime = GetHostTimeInNanosecs();
+
+    HostTraceThreadState& state = g_hostTraceThreadState;
+    --state.depth;
+
+    ProfileHostRecord record;
+    {
+        record.name         = name_;
+        record.threadID     = state.threadID;
+        record.depth        = state.depth;
+        record.beginTime    = beginTime_;
+        record.endTime      = endTime;
+    }
+
+    HostTraceCollector& collector = GetHostTraceCollector();
+    std::lock_guard<std::mutex> guard{ collector.mutex };
+    if (collector.records.size() < g_maxPendingHostRecords)
+        collector.records.push_back(record);
+}
+
+LLGL_EXPORT bool CollectHostRecords(FrameProfile& outProfile)
+{
+    HostTraceCollector& collector = GetHostTraceCollector();
+    std::lock_guard<std::mutex> guard{ collector.mutex };
+    outProfile.hostRecords.insert(outProfile.hostRecords.end(), collector.records.begin(), collector.records.end());
+    collector.records.clear();
+    return true;
+}
+
+#else // LLGL_ENABLE_HOST_TRACE
+
+LLGL_EXPORT bool CollectHostRecords(FrameProfile& /*outProfile*/)
+{
+    return false;
+}
+
+#endif // /LLGL_ENABLE_HOST_TRACE
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,74 @@
+/*
+ * HostTrace.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_HOST_TRACE_H
+#define LLGL_HOST_TRACE_H
+
+
+#include <LLGL/Export.h>
+#include <cstdint>
+
+
+/*
+Macro to record a host-side span for the enclosing scope of a backend entry point, e.g. LLGL_HOST_TRACE_SCOPE("CreateShader").
+The name must be a string literal, since only its pointer is stored until the records are collected with CollectHostRecords().
+This macro is a no-op unless LLGL is built with LLGL_ENABLE_HOST_TRACE.
+*/
+#ifdef LLGL_ENABLE_HOST_TRACE
+
+#define LLGL_HOST_TRACE_SCOPE(NAME) \
+    LLGL::HostTraceScope hostTraceScope_ { NAME }
+
+#else
+
+#define LLGL_HOST_TRACE_SCOPE(NAME) ((void)0)
+
+#endif
+
+
+namespace LLGL
+{
+
+
+// Returns the current CPU time in nanoseconds, which is the time domain of all CPU times in FrameProfile.
+LLGL_EXPORT std::uint64_t GetHostTimeInNanosecs();
+
+#ifdef LLGL_ENABLE_HOST_TRACE
+
+/*
+Scope guard that records a ProfileHostRecord from its construction to its destruction.
+Each thread maintains its own nesting depth, so spans of concurrent threads don't interfere with each other.
+*/
+class LLGL_EXPORT HostTraceScope
+{
+
+    public:
+
+        HostTraceScope(const char* name);
+        ~HostTraceScope();
+
+        HostTraceScope(const HostTraceScope&) = delete;
+        HostTraceScope& operator = (const HostTraceScope&) = delete;
+
+    private:
+
+        const char*     name_       = "";
+        std::uint64_t   beginTime_  = 0;
+
+};
+
+#endif
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
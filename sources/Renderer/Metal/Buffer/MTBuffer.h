@@ -19,6 +19,8 @@ namespace LLGL
 {
 
 
+class MTHeapAllocator;
+
 class MTBuffer final : public Buffer
 {
 
@@ -26,9 +28,11 @@ class MTBuffer final : public Buffer
 
         BufferDescriptor GetDesc() const override;
 
+        std::uint64_t GetDeviceAddress() const override;
+
     public:
 
-        MTBuffer(id<MTLDevice> device, const BufferDescriptor& desc, const void* initialData);
+        MTBuffer(id<MTLDevice> device, const BufferDescriptor& desc, const void* initialData, MTHeapAllocator* heapAllocator = nullptr);
         ~MTBuffer();
 
         void Write(NSUInteger offset, const void* data, NSUInteger dataSize);
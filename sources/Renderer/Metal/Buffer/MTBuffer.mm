@@ -6,6 +6,7 @@
  */
 
 #include "MTBuffer.h"
+#include "../MTHeapAllocator.h"
 #include "../../ResourceUtils.h"
 #include <string.h>
 
@@ -28,7 +29,7 @@ static MTLResourceOptions GetMTLResourceOptions(const BufferDescriptor& desc)
     #endif
 }
 
-MTBuffer::MTBuffer(id<MTLDevice> device, const BufferDescriptor& desc, const void* initialData) :
+MTBuffer::MTBuffer(id<MTLDevice> device, const BufferDescriptor& desc, const void* initialData, MTHeapAllocator* heapAllocator) :
     Buffer           { desc.bindFlags                   },
     indexType16Bits_ { (desc.format == Format::R16UInt) }
 {
@@ -38,15 +39,29 @@ MTBuffer::MTBuffer(id<MTLDevice> device, const BufferDescriptor& desc, const voi
     isManaged_ = ((opt & MTLResourceStorageModeManaged) != 0);
     #endif
 
-    if (initialData)
-        native_ = [device newBufferWithBytes:initialData length:(NSUInteger)desc.size options:opt];
-    else
-        native_ = [device newBufferWithLength:(NSUInteger)desc.size options:opt];
+    /* Sub-allocate buffer from a heap if initial data can be copied directly into shared memory */
+    if (heapAllocator != nullptr && (initialData == nullptr || (opt & MTLResourceStorageModeMask) == MTLResourceStorageModeShared))
+    {
+        native_ = heapAllocator->NewBuffer((NSUInteger)desc.size, opt);
+        if (native_ != nil && initialData != nullptr)
+            ::memcpy([native_ contents], initialData, (NSUInteger)desc.size);
+    }
+
+    if (native_ == nil)
+    {
+        if (initialData)
+            native_ = [device newBufferWithBytes:initialData length:(NSUInteger)desc.size options:opt];
+        else
+            native_ = [device newBufferWithLength:(NSUInteger)desc.size options:opt];
+    }
 }
 
 MTBuffer::~MTBuffer()
 {
-    [native_ release];
+    if (MTHeapAllocator::IsHeapResource(native_))
+        MTHeapAllocator::ReleaseHeapResource(native_);
+    else
+        [native_ release];
 }
 
 BufferDescriptor MTBuffer::GetDesc() const
@@ -63,6 +78,16 @@ BufferDescriptor MTBuffer::GetDesc() const
     return bufferDesc;
 }
 
+std::uint64_t MTBuffer::GetDeviceAddress() const
+{
+    if ((GetBindFlags() & BindFlags::DeviceAddress) != 0)
+    {
+        if (@available(iOS 16.0, macOS 13.0, *))
+            return static_cast<std::uint64_t>([native_ gpuAddress]);
+    }
+    return 0;
+}
+
 void MTBuffer::Write(NSUInteger offset, const void* data, NSUInteger dataSize)
 {
     if (char* sharedGpuMemory = reinterpret_cast<char*>([native_ contents]))
@@ -35,11 +35,11 @@ class MTStagingBuffer
         // Resets the writing offset.
         void Reset();
 
-        // Returns true if the remaining buffer size can fit the specified data size.
-        bool Capacity(NSUInteger dataSize) const;
+        // Returns true if the remaining buffer size can fit the specified data size at the next offset with the specified alignment.
+        bool Capacity(NSUInteger dataSize, NSUInteger alignment = 1) const;
 
-        // Writes the specified data to the native Metal buffer.
-        void Write(const void* data, NSUInteger dataSize);
+        // Writes the specified data to the native Metal buffer and returns the offset where the data has been written to.
+        NSUInteger Write(const void* data, NSUInteger dataSize, NSUInteger alignment = 1);
 
         // Returns the native MTLBuffer object.
         inline id<MTLBuffer> GetNative() const
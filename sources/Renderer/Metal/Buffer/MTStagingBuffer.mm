@@ -6,6 +6,7 @@
  */
 
 #include "MTStagingBuffer.h"
+#include "../../../Core/CoreUtils.h"
 #include <string.h>
 
 
@@ -57,17 +58,19 @@ void MTStagingBuffer::Reset()
     offset_ = 0;
 }
 
-bool MTStagingBuffer::Capacity(NSUInteger dataSize) const
+bool MTStagingBuffer::Capacity(NSUInteger dataSize, NSUInteger alignment) const
 {
-    return (offset_ + dataSize <= size_);
+    return (GetAlignedSize(offset_, alignment) + dataSize <= size_);
 }
 
-void MTStagingBuffer::Write(const void* data, NSUInteger dataSize)
+NSUInteger MTStagingBuffer::Write(const void* data, NSUInteger dataSize, NSUInteger alignment)
 {
     /* Copy data to CPU buffer region and increase offset for next data */
+    const NSUInteger dataOffset = GetAlignedSize(offset_, alignment);
     auto byteAlignedBuffer = reinterpret_cast<std::int8_t*>([native_ contents]);
-    ::memcpy(byteAlignedBuffer + offset_, data, dataSize);
-    offset_ += dataSize;
+    ::memcpy(byteAlignedBuffer + dataOffset, data, dataSize);
+    offset_ = dataOffset + dataSize;
+    return dataOffset;
 }
 
 
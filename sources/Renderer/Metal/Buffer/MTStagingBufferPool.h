@@ -13,38 +13,77 @@
 
 #include "MTStagingBuffer.h"
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+/*
+Pool of staging buffer chunks that are recycled once the GPU has completed all command buffers that read from them.
+Each recording (from one Reset to the next) tracks its chunks with a shared counter of pending submissions,
+which is decremented lock-free from the completed handlers of the native command buffers.
+Chunks that have not been written to for a number of recordings are released, but never below the minimum size of the pool.
+*/
 class MTStagingBufferPool
 {
 
     public:
 
-        MTStagingBufferPool(id<MTLDevice> device, NSUInteger chunkSize);
-    
+        // Constructs the pool with the specified chunk size and trim policy. If 'trimFrames' is zero, chunks are only released by explicit calls to Trim().
+        MTStagingBufferPool(id<MTLDevice> device, NSUInteger chunkSize, std::uint64_t minSize = 0, std::uint32_t trimFrames = 120);
+
+        // Starts a new recording. Chunks of previous recordings are only reused once all their submissions have completed.
         void Reset();
+
+        /*
+        Releases all chunks that are no longer in flight and have not been written to for the specified number of recordings,
+        but keeps enough chunks for the minimum size of the pool. Chunks of the current recording are never released.
+        */
+        void Trim(std::uint64_t numIdleRecordings = 0);
+
+        // Keeps all chunks of the current recording in flight until the specified native command buffer has completed. This must be called before the command buffer is committed.
+        void TrackCommandBuffer(id<MTLCommandBuffer> cmdBuffer) const;
     
         void Write(
             const void*     data,
             NSUInteger      dataSize,
             id<MTLBuffer>&  srcBuffer,
-            NSUInteger&     srcOffset
+            NSUInteger&     srcOffset,
+            NSUInteger      alignment   = 1
         );
 
     private:
-    
+
+        using PendingSubmitCounter = std::atomic<std::uint32_t>;
+
+        struct Chunk
+        {
+            MTStagingBuffer                         buffer;
+            std::shared_ptr<PendingSubmitCounter>   pendingSubmits; // Counter of the last recording that has written to this chunk.
+            std::uint64_t                           lastRecording;  // Index of the last recording that has written to this chunk.
+        };
+
+    private:
+
+        // Returns true if the specified chunk can be written to in the current recording. Chunks of completed recordings are reset.
+        bool AcquireChunk(Chunk& chunk);
+
         void AllocChunk(NSUInteger minChunkSize);
-    
+
     private:
 
-        id<MTLDevice>                   device_     = nil;
-        std::vector<MTStagingBuffer>    chunks_;
-        std::size_t                     chunkIdx_   = 0;
-        NSUInteger                      chunkSize_  = 0;
+        id<MTLDevice>                           device_         = nil;
+        std::vector<Chunk>                      chunks_;
+        std::size_t                             chunkIdx_       = 0;
+        NSUInteger                              chunkSize_      = 0;
+        std::shared_ptr<PendingSubmitCounter>   pendingSubmits_;
+        std::uint64_t                           numRecordings_  = 0;
+        std::uint64_t                           minSize_        = 0;
+        std::uint32_t                           trimFrames_     = 120;
 
 };
 
@@ -13,40 +13,97 @@ namespace LLGL
 {
 
 
-MTStagingBufferPool::MTStagingBufferPool(id<MTLDevice> device, NSUInteger chunkSize) :
-    device_    { device    },
-    chunkSize_ { chunkSize }
+MTStagingBufferPool::MTStagingBufferPool(id<MTLDevice> device, NSUInteger chunkSize, std::uint64_t minSize, std::uint32_t trimFrames) :
+    device_     { device     },
+    chunkSize_  { chunkSize  },
+    minSize_    { minSize    },
+    trimFrames_ { trimFrames }
 {
+    Reset();
 }
 
 void MTStagingBufferPool::Reset()
 {
-    for (auto& chunk : chunks_)
-        chunk.Reset();
+    /* Allocate a new submission counter unless the previous one is not referenced by any chunk or command buffer */
+    if (!pendingSubmits_ || pendingSubmits_.use_count() > 1)
+        pendingSubmits_ = std::make_shared<PendingSubmitCounter>(0u);
+    chunkIdx_ = 0;
+
+    /* Release chunks that were only needed for a burst of uploads */
+    ++numRecordings_;
+    if (trimFrames_ > 0 && numRecordings_ % trimFrames_ == 0)
+        Trim(trimFrames_);
+}
+
+void MTStagingBufferPool::Trim(std::uint64_t numIdleRecordings)
+{
+    /* Keep leading chunks for the minimum size of the pool, but always keep the first chunk */
+    std::size_t     numKeptChunks   = 0;
+    std::uint64_t   keptSize        = 0;
+
+    while (numKeptChunks < chunks_.size() && (numKeptChunks == 0 || keptSize < minSize_))
+        keptSize += chunks_[numKeptChunks++].buffer.GetSize();
+
+    if (numKeptChunks >= chunks_.size())
+        return;
+
+    chunks_.erase(
+        std::remove_if(
+            chunks_.begin() + numKeptChunks, chunks_.end(),
+            [this, numIdleRecordings](const Chunk& chunk) -> bool
+            {
+                return
+                (
+                    chunk.pendingSubmits != pendingSubmits_ &&
+                    chunk.pendingSubmits->load() == 0 &&
+                    numRecordings_ - chunk.lastRecording >= numIdleRecordings
+                );
+            }
+        ),
+        chunks_.end()
+    );
+
+    /* Chunks of the current recording may have moved, so search for a writable chunk from the beginning again */
     chunkIdx_ = 0;
 }
 
+void MTStagingBufferPool::TrackCommandBuffer(id<MTLCommandBuffer> cmdBuffer) const
+{
+    /* Release chunks of this recording when the GPU has completed the command buffer; the block keeps its own reference to the counter */
+    std::shared_ptr<PendingSubmitCounter> pendingSubmits = pendingSubmits_;
+    pendingSubmits->fetch_add(1u);
+    [cmdBuffer
+        addCompletedHandler:^(id<MTLCommandBuffer> /*cmdBuffer*/)
+        {
+            pendingSubmits->fetch_sub(1u);
+        }
+    ];
+}
+
 void MTStagingBufferPool::Write(
     const void*     data,
     NSUInteger      dataSize,
     id<MTLBuffer>&  srcBuffer,
-    NSUInteger&     srcOffset)
+    NSUInteger&     srcOffset,
+    NSUInteger      alignment)
 {
-    /* Check if a new chunk must be allocated */
-    if (chunkIdx_ == chunks_.size())
-        AllocChunk(dataSize);
-    else if (!chunks_[chunkIdx_].Capacity(dataSize))
+    /* Find next chunk that is no longer in flight and has enough capacity, or allocate a new chunk */
+    while (chunkIdx_ < chunks_.size())
     {
+        Chunk& chunk = chunks_[chunkIdx_];
+        if (AcquireChunk(chunk) && chunk.buffer.Capacity(dataSize, alignment))
+            break;
         ++chunkIdx_;
-        if (chunkIdx_ == chunks_.size())
-            AllocChunk(dataSize);
     }
 
+    if (chunkIdx_ == chunks_.size())
+        AllocChunk(dataSize);
+
     /* Write data to current chunk */
-    auto& chunk = chunks_[chunkIdx_];
-    srcOffset = chunk.GetOffset();
-    srcBuffer = chunk.GetNative();
-    chunk.Write(data, dataSize);
+    Chunk& chunk = chunks_[chunkIdx_];
+    chunk.lastRecording = numRecordings_;
+    srcBuffer = chunk.buffer.GetNative();
+    srcOffset = chunk.buffer.Write(data, dataSize, alignment);
 }
 
 
@@ -54,9 +111,23 @@ void MTStagingBufferPool::Write(
  * ======= Private: =======
  */
 
+bool MTStagingBufferPool::AcquireChunk(Chunk& chunk)
+{
+    if (chunk.pendingSubmits == pendingSubmits_)
+        return true;
+
+    /* Chunks of a previous recording can only be reused once all of its command buffers have completed */
+    if (chunk.pendingSubmits->load() > 0)
+        return false;
+
+    chunk.buffer.Reset();
+    chunk.pendingSubmits = pendingSubmits_;
+    return true;
+}
+
 void MTStagingBufferPool::AllocChunk(NSUInteger minChunkSize)
 {
-    chunks_.emplace_back(device_, std::max(chunkSize_, minChunkSize));
+    chunks_.push_back(Chunk{ MTStagingBuffer{ device_, std::max(chunkSize_, minChunkSize) }, pendingSubmits_, numRecordings_ });
     chunkIdx_ = chunks_.size() - 1;
 }
 
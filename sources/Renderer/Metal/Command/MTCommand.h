@@ -23,6 +23,7 @@ class MTMultiSubmitCommandBuffer;
 class MTGraphicsPSO;
 class MTComputePSO;
 class MTRenderPass;
+class MTQueryHeap;
 class RenderTarget;
 
 struct MTCmdExecute
@@ -91,6 +92,22 @@ struct MTCmdCopyTextureFromFramebuffer
     MTLOrigin       destinationOrigin;
 };
 
+struct MTCmdFillBuffer
+{
+    id<MTLBuffer>   buffer;
+    NSRange         range;
+    std::uint8_t    value;
+};
+
+struct MTCmdFillBufferWide
+{
+    id<MTLBuffer>   buffer;
+    NSUInteger      offset;
+    NSUInteger      numThreads;
+    NSUInteger      maxLocalThreads;
+    std::uint32_t   params[8]; // Fill pattern and number of values (see FillParams in FillBufferWide.metal).
+};
+
 //struct MTCmdPauseRenderEncoder;
 //struct MTCmdResumeRenderEncoder;
 
@@ -144,6 +161,12 @@ struct MTCmdSetStencilRef
     StencilFace     face;
 };
 
+struct MTCmdQuery
+{
+    MTQueryHeap*    queryHeap;
+    std::uint32_t   query;
+};
+
 struct MTCmdSetVertexBuffers
 {
     NSUInteger      count;
@@ -217,6 +240,29 @@ struct MTCmdDrawIndexedPrimitives
     NSUInteger          baseInstance;
 };
 
+struct MTCmdDrawMeshThreadgroups
+{
+    MTLSize threadgroups;
+    MTLSize threadsPerObjectThreadgroup;
+    MTLSize threadsPerMeshThreadgroup;
+};
+
+struct MTCmdDrawMeshThreadgroupsIndirect
+{
+    id<MTLBuffer>   indirectBuffer;
+    NSUInteger      indirectBufferOffset;
+    MTLSize         threadsPerObjectThreadgroup;
+    MTLSize         threadsPerMeshThreadgroup;
+};
+
+struct MTCmdExecuteIndirectCommands
+{
+    id<MTLIndirectCommandBuffer>    indirectCommandBuffer;
+    NSUInteger                      numCommands;
+    NSUInteger                      numResources;
+//  id<MTLResource>                 resources[numResources];
+};
+
 struct MTCmdDispatchThreads
 {
     MTLSize threads;
@@ -247,7 +293,7 @@ struct MTCmdPushDebugGroup
 struct MTCmdPresentDrawables
 {
     NSUInteger  count;
-//  MTKView*    views[count];
+//  MTSwapChain* swapChains[count];
 };
 
 //struct MTCmdFlush;
@@ -12,6 +12,7 @@
 #import <MetalKit/MetalKit.h>
 
 #include <LLGL/CommandBuffer.h>
+#include <LLGL/RenderingProfiler.h>
 #include <LLGL/StaticLimits.h>
 #include "MTCommandContext.h"
 #include "../Buffer/MTIntermediateBuffer.h"
@@ -47,6 +48,7 @@ class MTCommandBuffer : public CommandBuffer
         /* ----- Resources ----- */
 
         void SetResource(std::uint32_t descriptor, Resource& resource) override final;
+        void SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t size = Constants::wholeSize) override final;
 
         /* ----- Pipeline States ----- */
 
@@ -74,6 +76,18 @@ class MTCommandBuffer : public CommandBuffer
             return ((GetFlags() & CommandBufferFlags::Secondary) == 0);
         }
 
+        // Keeps the staging data of the current recording of this command buffer alive until the specified native command buffer has completed.
+        inline void TrackStagingPool(id<MTLCommandBuffer> cmdBuffer) const
+        {
+            stagingBufferPool_.TrackCommandBuffer(cmdBuffer);
+        }
+
+        // Returns the frame counters of the current encoding. See LLGL_ENABLE_FRAME_COUNTERS.
+        inline const FrameProfile& GetFrameCounters() const
+        {
+            return frameCounters_;
+        }
+
     protected:
 
         // Active command encoder state enumeration.
@@ -87,7 +101,7 @@ class MTCommandBuffer : public CommandBuffer
 
     protected:
 
-        MTCommandBuffer(id<MTLDevice> device, long flags);
+        MTCommandBuffer(id<MTLDevice> device, const CommandBufferDescriptor& desc);
 
         NSUInteger GetMaxLocalThreads(id<MTLComputePipelineState> computePSO) const;
 
@@ -97,8 +111,13 @@ class MTCommandBuffer : public CommandBuffer
         void SetComputePSORenderState(MTComputePSO& computePSO);
 
         void ResetRenderStates();
+
+        // Starts a new recording in the staging buffer pool. Chunks that are still in use by the GPU are not overwritten.
         void ResetStagingPool();
 
+        // Releases staging buffer chunks that are no longer in use by the GPU down to the minimum size of the pool.
+        void TrimStagingPool();
+
         void WriteStagingBuffer(
             const void*     data,
             NSUInteger      dataSize,
@@ -114,6 +133,17 @@ class MTCommandBuffer : public CommandBuffer
 
     protected:
 
+        inline id<MTLDevice> GetDevice() const
+        {
+            return device_;
+        }
+
+        // Returns the current staging buffer pool. This is also used to allocate shader constants, see MTConstantsCache.
+        inline MTStagingBufferPool& GetStagingBufferPool()
+        {
+            return stagingBufferPool_;
+        }
+
         inline MTLPrimitiveType GetPrimitiveType() const
         {
             return primitiveType_;
@@ -144,6 +174,16 @@ class MTCommandBuffer : public CommandBuffer
             return threadsPerThreadgroup_;
         }
 
+        inline const MTLSize& GetThreadsPerObjectThreadgroup() const
+        {
+            return threadsPerObjectThreadgroup_;
+        }
+
+        inline const MTLSize& GetThreadsPerMeshThreadgroup() const
+        {
+            return threadsPerMeshThreadgroup_;
+        }
+
         inline MTPipelineState* GetBoundPipelineState() const
         {
             return boundPipelineState_;
@@ -154,6 +194,10 @@ class MTCommandBuffer : public CommandBuffer
             return tessPipelineState_;
         }
 
+    protected:
+
+        FrameProfile                    frameCounters_;
+
     private:
 
         void SetIndexStream(id<MTLBuffer> indexBuffer, NSUInteger offset, bool indexType16Bits);
@@ -166,6 +210,7 @@ class MTCommandBuffer : public CommandBuffer
         long                            flags_                  = 0;
 
         MTStagingBufferPool             stagingBufferPool_;
+
         SmallVector<id<MTLDrawable>, 2> queuedDrawables_;
 
         MTLPrimitiveType                primitiveType_          = MTLPrimitiveTypeTriangle;
@@ -176,6 +221,8 @@ class MTCommandBuffer : public CommandBuffer
         NSUInteger                      numPatchControlPoints_  = 0;
 
         MTLSize                         threadsPerThreadgroup_  = MTLSizeMake(1, 1, 1);
+        MTLSize                         threadsPerObjectThreadgroup_    = MTLSizeMake(1, 1, 1);
+        MTLSize                         threadsPerMeshThreadgroup_      = MTLSizeMake(1, 1, 1);
         MTSwapChain*                    boundSwapChain_         = nullptr;
         MTPipelineState*                boundPipelineState_     = nullptr;
         MTDescriptorCache*              descriptorCache_        = nullptr;
@@ -14,6 +14,7 @@
 #include "../Buffer/MTBuffer.h"
 #include "../Shader/MTShader.h"
 #include "../../CheckedCast.h"
+#include "../../FrameCounters.h"
 #include <algorithm>
 
 #include <LLGL/Backend/Metal/NativeCommand.h>
@@ -25,10 +26,13 @@ namespace LLGL
 
 static constexpr NSUInteger g_tessFactorBufferAlignment = (sizeof(MTLQuadTessellationFactorsHalf) * 256);
 
-MTCommandBuffer::MTCommandBuffer(id<MTLDevice> device, long flags) :
+MTCommandBuffer::MTCommandBuffer(id<MTLDevice> device, const CommandBufferDescriptor& desc) :
     device_            { device                         },
-    flags_             { flags                          },
-    stagingBufferPool_ { device, USHRT_MAX              },
+    flags_             { desc.flags                     },
+    stagingBufferPool_ { device,
+                         USHRT_MAX,
+                         desc.minStagingPoolSize,
+                         desc.stagingPoolTrimFrames     },
     tessFactorBuffer_  { device,
                          MTLResourceStorageModePrivate,
                          g_tessFactorBufferAlignment    }
@@ -38,22 +42,37 @@ MTCommandBuffer::MTCommandBuffer(id<MTLDevice> device, long flags) :
 
 void MTCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     SetIndexStream(bufferMT.GetNative(), 0, bufferMT.IsIndexType16Bits());
 }
 
 void MTCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     SetIndexStream(bufferMT.GetNative(), static_cast<NSUInteger>(offset), (format == Format::R16UInt));
 }
 
 void MTCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
+    LLGL_FRAME_COUNTER_RESOURCE(resource);
+
     if (descriptorCache_ != nullptr)
         descriptorCache_->SetResource(descriptor, resource);
 }
 
+void MTCommandBuffer::SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t /*size*/)
+{
+    LLGL_FRAME_COUNTER_RESOURCE(buffer);
+
+    /* Metal binds buffers by offset only; the range is determined by the shader */
+    if (descriptorCache_ != nullptr)
+        descriptorCache_->SetBufferRange(descriptor, buffer, static_cast<NSUInteger>(offset));
+}
+
 void MTCommandBuffer::SetUniforms(std::uint32_t first, const void* data, std::uint16_t dataSize)
 {
     if (constantsCache_ != nullptr)
@@ -101,16 +120,23 @@ void MTCommandBuffer::SetGraphicsPSORenderState(MTGraphicsPSO& graphicsPSO)
 {
     /* Store current primitive type and tessellation data */
     SetPipelineRenderState(graphicsPSO);
+    LLGL_FRAME_COUNTER_INC(graphicsPipelineBindings);
     primitiveType_          = graphicsPSO.GetMTLPrimitiveType();
     numPatchControlPoints_  = graphicsPSO.GetNumPatchControlPoints();
     tessPipelineState_      = graphicsPSO.GetTessPipelineState();
     tessFactorSize_         = GetTessFactorSize(graphicsPSO.GetPatchType());
+    if (graphicsPSO.IsMeshPipeline())
+    {
+        threadsPerObjectThreadgroup_    = graphicsPSO.GetNumThreadsPerObjectGroup();
+        threadsPerMeshThreadgroup_      = graphicsPSO.GetNumThreadsPerMeshGroup();
+    }
 }
 
 void MTCommandBuffer::SetComputePSORenderState(MTComputePSO& computePSO)
 {
     /* Store work group size of shader program */
     SetPipelineRenderState(computePSO);
+    LLGL_FRAME_COUNTER_INC(computePipelineBindings);
     if (const MTShader* computeShader = computePSO.GetComputeShader())
         threadsPerThreadgroup_ = computeShader->GetNumThreadsPerGroup();
 }
@@ -130,13 +156,18 @@ void MTCommandBuffer::ResetStagingPool()
     stagingBufferPool_.Reset();
 }
 
+void MTCommandBuffer::TrimStagingPool()
+{
+    stagingBufferPool_.Trim();
+}
+
 void MTCommandBuffer::WriteStagingBuffer(
     const void*     data,
     NSUInteger      dataSize,
     id<MTLBuffer>&  outSrcBuffer,
     NSUInteger&     outSrcOffset)
 {
-    stagingBufferPool_.Write(data, dataSize, outSrcBuffer, outSrcOffset);
+    GetStagingBufferPool().Write(data, dataSize, outSrcBuffer, outSrcOffset);
 }
 
 MTKView* MTCommandBuffer::GetCurrentDrawableView() const
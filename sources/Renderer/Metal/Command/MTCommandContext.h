@@ -27,6 +27,7 @@ class MTGraphicsPSO;
 class MTComputePSO;
 class MTDescriptorCache;
 class MTConstantsCache;
+class MTStagingBufferPool;
 
 struct MTInternalBindingTable
 {
@@ -42,18 +43,40 @@ class MTCommandContext
         // Resets all internal states.
         void Reset();
 
-        // Resets the encoder scheduler with the new command buffer.
-        void Reset(id<MTLCommandBuffer> cmdBuffer);
+        /*
+        Resets the encoder scheduler with the new command buffer.
+        If a hazard tracking fence is specified, each command encoder waits for this fence before it starts and updates it when it ends.
+        If a constants pool is specified, shader constants are written to that pool instead of being copied with 'setBytes'.
+        The constants pool must not be reset until the command buffer has been completed.
+        */
+        void Reset(id<MTLCommandBuffer> cmdBuffer, id<MTLFence> hazardFence = nil, MTStagingBufferPool* constantsPool = nullptr);
 
         // Ends the currently bound command encoder.
         void Flush();
 
+        // Ends the current render pass. This also discards a paused render command encoder that has not been resumed yet.
+        void EndRenderPass();
+
         // Binds the respective command encoder with the specified descriptor.
         id<MTLRenderCommandEncoder> BindRenderEncoder(MTLRenderPassDescriptor* renderPassDesc, bool isPrimaryRenderPass = false);
         id<MTLComputeCommandEncoder> BindComputeEncoder();
         id<MTLBlitCommandEncoder> BindBlitEncoder();
 
-        // Interrupts the render command encoder (if active).
+        /*
+        Binds a parallel render command encoder for the specified render pass and a first sub-encoder for the commands of this context.
+        The parallel encoder and all its sub-encoders are ended with the next call to Flush().
+        */
+        id<MTLParallelRenderCommandEncoder> BindParallelRenderEncoder(MTLRenderPassDescriptor* renderPassDesc);
+
+        // Binds a new sub-encoder of the specified parallel render command encoder as render command encoder of this context.
+        id<MTLRenderCommandEncoder> BindSubRenderEncoder(id<MTLParallelRenderCommandEncoder> parallelEncoder);
+
+        /*
+        Interrupts the render command encoder (if active).
+        Resuming the render command encoder is deferred until the next render command, i.e. when FlushAndGetRenderEncoder() is called.
+        This allows consecutive blit and compute commands inside a render pass to share their command encoder,
+        instead of ending and re-creating a render command encoder between each of them.
+        */
         void PauseRenderEncoder();
         void ResumeRenderEncoder();
 
@@ -72,6 +95,13 @@ class MTCommandContext
         void SetBlendColor(const float blendColor[4]);
         void SetStencilRef(std::uint32_t ref, const StencilFace face);
 
+        /*
+        Sets the visibility result mode and offset for subsequent draw commands.
+        Since the visibility result buffer can only be specified when a render command encoder is created,
+        an active render command encoder is interrupted if it was created with a different buffer and resumed with the next render command.
+        */
+        void SetVisibilityResult(id<MTLBuffer> buffer, MTLVisibilityResultMode mode, NSUInteger offset);
+
         // Converts, binds, and stores the respective state in the internal compute encoder state.
         void SetComputePSO(MTComputePSO* pipelineState);
         void SetComputeResourceHeap(MTResourceHeap* resourceHeap, std::uint32_t descriptorSet);
@@ -79,6 +109,19 @@ class MTCommandContext
         // Rebinds the currently bounds resource heap to the specified compute encoder (used for tessellation encoding).
         void RebindResourceHeap(id<MTLComputeCommandEncoder> computeEncoder);
 
+        // Invalidates all compute encoder states, so they are bound again with the next dispatch. This must be called after builtin kernels have been encoded.
+        void InvalidateComputeEncoderState();
+
+        // Samples the counters into the specified sample buffer (id<MTLCounterSampleBuffer>) at the current draw or dispatch boundary.
+        void SampleCounters(id sampleBuffer, NSUInteger sampleIndex);
+
+        /*
+        Samples the counters into the specified sample buffer (id<MTLCounterSampleBuffer>) with an empty blit command encoder.
+        This is used for devices that can only sample counters at the boundaries of command encoders and interrupts an active render command encoder.
+        Sampling is skipped inside a parallel render pass, since its sub-encoders cannot be interrupted.
+        */
+        void SampleCountersAtEncoderBoundary(id sampleBuffer, NSUInteger sampleIndex);
+
     public:
 
         // Returns the native command buffer currently used by this context.
@@ -99,6 +142,12 @@ class MTCommandContext
             return renderEncoder_;
         }
 
+        // Returns true if there is a render command encoder, either active or paused and pending to be resumed.
+        inline bool HasRenderEncoder() const
+        {
+            return (renderEncoder_ != nil || isRenderEncoderPaused_);
+        }
+
         // Returns the current compute command encoder.
         inline id<MTLComputeCommandEncoder> GetComputeEncoder() const
         {
@@ -124,6 +173,15 @@ class MTCommandContext
         void SubmitComputeEncoderState();
         void ResetComputeEncoderState();
 
+        void WaitForHazardFence();
+        void UpdateHazardFence();
+
+        void InvalidateRenderEncoderState();
+        void FlushParallelRenderEncoder();
+
+        // Binds a new render command encoder for the paused render pass with load actions to preserve its attachments.
+        void BindPausedRenderEncoder();
+
     private:
 
         static constexpr NSUInteger maxNumVertexBuffers         = 32;
@@ -149,6 +207,9 @@ class MTCommandContext
             std::uint32_t   stencilFrontRef                             = 0;
             std::uint32_t   stencilBackRef                              = 0;
             bool            stencilRefDynamic                           = false;
+
+            MTLVisibilityResultMode visibilityResultMode                = MTLVisibilityResultModeDisabled;
+            NSUInteger              visibilityResultOffset              = 0;
         };
 
         struct MTComputeEncoderState
@@ -161,12 +222,19 @@ class MTCommandContext
     private:
 
         id<MTLCommandBuffer>            cmdBuffer_              = nil;
+        id<MTLFence>                    hazardFence_            = nil;
+        MTStagingBufferPool*            constantsPool_          = nullptr;
 
         id<MTLRenderCommandEncoder>     renderEncoder_  	    = nil;
         id<MTLComputeCommandEncoder>    computeEncoder_         = nil;
         id<MTLBlitCommandEncoder>       blitEncoder_            = nil;
 
+        id<MTLParallelRenderCommandEncoder> parallelEncoder_    = nil;
+        bool                                isSubRenderEncoder_ = false;
+
         MTLRenderPassDescriptor*        renderPassDesc_         = nullptr;
+        id<MTLBuffer>                   visibilityResultBuffer_         = nil;  // Visibility result buffer for subsequent render command encoders
+        id<MTLBuffer>                   renderEncoderVisibilityBuffer_  = nil;  // Visibility result buffer the current render command encoder was created with
         MTRenderEncoderState            renderEncoderState_;
         MTComputeEncoderState           computeEncoderState_;
 
@@ -186,6 +254,7 @@ class MTCommandContext
                 std::uint8_t graphicsResourceHeap   : 1;
                 std::uint8_t blendColor             : 1;
                 std::uint8_t stencilRef             : 1;
+                std::uint8_t visibilityResult       : 1;
             };
         }
         renderDirtyBits_;
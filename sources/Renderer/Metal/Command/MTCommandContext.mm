@@ -32,14 +32,25 @@ void MTCommandContext::Reset()
     ResetComputeEncoderState();
 }
 
-void MTCommandContext::Reset(id<MTLCommandBuffer> cmdBuffer)
+void MTCommandContext::Reset(id<MTLCommandBuffer> cmdBuffer, id<MTLFence> hazardFence, MTStagingBufferPool* constantsPool)
 {
     Reset();
-    cmdBuffer_ = cmdBuffer;
+    cmdBuffer_                  = cmdBuffer;
+    hazardFence_                = hazardFence;
+    constantsPool_              = constantsPool;
+    visibilityResultBuffer_     = nil;
 }
 
 void MTCommandContext::Flush()
 {
+    if (parallelEncoder_ != nil)
+    {
+        FlushParallelRenderEncoder();
+        return;
+    }
+
+    isSubRenderEncoder_ = false;
+    UpdateHazardFence();
     if (renderEncoder_ != nil)
     {
         [renderEncoder_ endEncoding];
@@ -57,25 +68,71 @@ void MTCommandContext::Flush()
     }
 }
 
+void MTCommandContext::EndRenderPass()
+{
+    isRenderEncoderPaused_ = false;
+    Flush();
+}
+
 id<MTLRenderCommandEncoder> MTCommandContext::BindRenderEncoder(MTLRenderPassDescriptor* renderPassDesc, bool isPrimaryRenderPass)
 {
     LLGL_ASSERT_PTR(renderPassDesc);
 
     Flush();
-    renderEncoder_ = [cmdBuffer_ renderCommandEncoderWithDescriptor:renderPassDesc];
+    if (visibilityResultBuffer_ != nil && renderPassDesc.visibilityResultBuffer == nil)
+    {
+        /* Attach visibility result buffer of occlusion queries to a copy of the descriptor, so the original descriptor is not modified */
+        MTLRenderPassDescriptor* visibilityPassDesc = (MTLRenderPassDescriptor*)[renderPassDesc copy];
+        visibilityPassDesc.visibilityResultBuffer = visibilityResultBuffer_;
+        renderEncoder_ = [cmdBuffer_ renderCommandEncoderWithDescriptor:visibilityPassDesc];
+        [visibilityPassDesc release];
+        renderEncoderVisibilityBuffer_ = visibilityResultBuffer_;
+    }
+    else
+    {
+        renderEncoder_ = [cmdBuffer_ renderCommandEncoderWithDescriptor:renderPassDesc];
+        renderEncoderVisibilityBuffer_ = renderPassDesc.visibilityResultBuffer;
+    }
+    isRenderEncoderPaused_ = false;
+    WaitForHazardFence();
 
     /* Store descriptor for primary render pass */
     if (isPrimaryRenderPass)
         renderPassDesc_ = renderPassDesc;
 
-    /* A new render command encoder forces all pipeline states to be reset */
-    renderDirtyBits_.bits = ~0;
+    InvalidateRenderEncoderState();
 
-    /* Invalidate descriptor and constant caches */
-    if (descriptorCache_ != nullptr)
-        descriptorCache_->Reset();
-    if (constantsCache_ != nullptr)
-        constantsCache_->Reset();
+    return renderEncoder_;
+}
+
+id<MTLParallelRenderCommandEncoder> MTCommandContext::BindParallelRenderEncoder(MTLRenderPassDescriptor* renderPassDesc)
+{
+    LLGL_ASSERT_PTR(renderPassDesc);
+
+    Flush();
+    parallelEncoder_ = [cmdBuffer_ parallelRenderCommandEncoderWithDescriptor:renderPassDesc];
+    renderPassDesc_ = renderPassDesc;
+    renderEncoderVisibilityBuffer_ = renderPassDesc.visibilityResultBuffer;
+    isRenderEncoderPaused_ = false;
+
+    /* Sub-encoders are executed in the order they are created, so the commands of this context are executed first */
+    renderEncoder_ = [parallelEncoder_ renderCommandEncoder];
+    WaitForHazardFence();
+
+    InvalidateRenderEncoderState();
+
+    return parallelEncoder_;
+}
+
+id<MTLRenderCommandEncoder> MTCommandContext::BindSubRenderEncoder(id<MTLParallelRenderCommandEncoder> parallelEncoder)
+{
+    LLGL_ASSERT_PTR(parallelEncoder);
+
+    Flush();
+    renderEncoder_ = [parallelEncoder renderCommandEncoder];
+    isSubRenderEncoder_ = true;
+
+    InvalidateRenderEncoderState();
 
     return renderEncoder_;
 }
@@ -86,15 +143,10 @@ id<MTLComputeCommandEncoder> MTCommandContext::BindComputeEncoder()
     {
         Flush();
         computeEncoder_ = [cmdBuffer_ computeCommandEncoder];
+        WaitForHazardFence();
 
         /* A new compute command encoder forces all pipeline states to be reset */
-        computeDirtyBits_.bits = ~0;
-
-        /* Invalidate descriptor and constant caches */
-        if (descriptorCache_ != nullptr)
-            descriptorCache_->Reset();
-        if (constantsCache_ != nullptr)
-            constantsCache_->Reset();
+        InvalidateComputeEncoderState();
     }
     return computeEncoder_;
 }
@@ -105,6 +157,7 @@ id<MTLBlitCommandEncoder> MTCommandContext::BindBlitEncoder()
     {
         Flush();
         blitEncoder_ = [cmdBuffer_ blitCommandEncoder];
+        WaitForHazardFence();
     }
     return blitEncoder_;
 }
@@ -112,25 +165,20 @@ id<MTLBlitCommandEncoder> MTCommandContext::BindBlitEncoder()
 void MTCommandContext::PauseRenderEncoder()
 {
     if (renderEncoder_ != nil && !isRenderEncoderPaused_)
+    {
+        LLGL_ASSERT(parallelEncoder_ == nil && !isSubRenderEncoder_, "cannot interrupt a parallel render pass");
         isRenderEncoderPaused_ = true;
+    }
 }
 
 void MTCommandContext::ResumeRenderEncoder()
 {
-    if (isRenderEncoderPaused_)
-    {
-        /* Bind new render command encoder with previous render pass */
-        auto renderPassDesc = CopyRenderPassDesc();
-        {
-            for_range(i, 8u)
-                renderPassDesc.colorAttachments[i].loadAction = MTLLoadActionLoad;
-            renderPassDesc.depthAttachment.loadAction = MTLLoadActionLoad;
-            renderPassDesc.stencilAttachment.loadAction = MTLLoadActionLoad;
-        }
-        BindRenderEncoder(renderPassDesc);
-        [renderPassDesc release];
+    /*
+    If the render command encoder has not been interrupted by another encoder, it can simply continue.
+    Otherwise, keep it paused until the next render command, so that subsequent blit and compute commands can share their encoder.
+    */
+    if (isRenderEncoderPaused_ && renderEncoder_ != nil)
         isRenderEncoderPaused_ = false;
-    }
 }
 
 MTLRenderPassDescriptor* MTCommandContext::CopyRenderPassDesc()
@@ -240,6 +288,24 @@ void MTCommandContext::SetStencilRef(std::uint32_t ref, const StencilFace face)
     renderDirtyBits_.stencilRef = 1;
 }
 
+void MTCommandContext::SetVisibilityResult(id<MTLBuffer> buffer, MTLVisibilityResultMode mode, NSUInteger offset)
+{
+    if (buffer != visibilityResultBuffer_)
+    {
+        visibilityResultBuffer_ = buffer;
+
+        /* Interrupt current render command encoder, so it is resumed with the new visibility result buffer */
+        if (renderEncoder_ != nil && renderEncoderVisibilityBuffer_ != buffer && parallelEncoder_ == nil && !isSubRenderEncoder_)
+        {
+            PauseRenderEncoder();
+            Flush();
+        }
+    }
+    renderEncoderState_.visibilityResultMode    = mode;
+    renderEncoderState_.visibilityResultOffset  = offset;
+    renderDirtyBits_.visibilityResult           = 1;
+}
+
 void MTCommandContext::SetComputePSO(MTComputePSO* pipelineState)
 {
     if (pipelineState != nullptr && computeEncoderState_.computePSO != pipelineState)
@@ -270,17 +336,73 @@ void MTCommandContext::RebindResourceHeap(id<MTLComputeCommandEncoder> computeEn
     if (descriptorCache_ != nullptr)
         descriptorCache_->FlushComputeResourcesForced(computeEncoder);
     if (constantsCache_ != nullptr)
-        constantsCache_->FlushComputeResourcesForced(computeEncoder);
+        constantsCache_->FlushComputeResourcesForced(computeEncoder, constantsPool_);
+}
+
+void MTCommandContext::InvalidateComputeEncoderState()
+{
+    computeDirtyBits_.bits = ~0;
+
+    /* Invalidate descriptor and constant caches */
+    if (descriptorCache_ != nullptr)
+        descriptorCache_->Reset();
+    if (constantsCache_ != nullptr)
+        constantsCache_->Reset();
+}
+
+void MTCommandContext::SampleCounters(id sampleBuffer, NSUInteger sampleIndex)
+{
+    if (@available(macOS 10.15, iOS 14.0, *))
+    {
+        id<MTLCounterSampleBuffer> counterSampleBuffer = (id<MTLCounterSampleBuffer>)sampleBuffer;
+
+        /* Sample counters within the current command encoder to avoid interrupting it */
+        if (computeEncoder_ != nil)
+            [computeEncoder_ sampleCountersInBuffer:counterSampleBuffer atSampleIndex:sampleIndex withBarrier:YES];
+        else if (blitEncoder_ != nil)
+            [blitEncoder_ sampleCountersInBuffer:counterSampleBuffer atSampleIndex:sampleIndex withBarrier:YES];
+        else if (HasRenderEncoder())
+            [FlushAndGetRenderEncoder() sampleCountersInBuffer:counterSampleBuffer atSampleIndex:sampleIndex withBarrier:YES];
+        else
+            [BindBlitEncoder() sampleCountersInBuffer:counterSampleBuffer atSampleIndex:sampleIndex withBarrier:YES];
+    }
+}
+
+void MTCommandContext::SampleCountersAtEncoderBoundary(id sampleBuffer, NSUInteger sampleIndex)
+{
+    if (parallelEncoder_ != nil || isSubRenderEncoder_)
+        return;
+
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        /* End current command encoder; a render command encoder is resumed with the next render command */
+        if (renderEncoder_ != nil)
+            PauseRenderEncoder();
+        Flush();
+
+        /* Encode empty blit pass that only samples the counters at its start */
+        MTLBlitPassDescriptor* blitPassDesc = [[MTLBlitPassDescriptor alloc] init];
+        {
+            blitPassDesc.sampleBufferAttachments[0].sampleBuffer                = (id<MTLCounterSampleBuffer>)sampleBuffer;
+            blitPassDesc.sampleBufferAttachments[0].startOfEncoderSampleIndex   = sampleIndex;
+            blitPassDesc.sampleBufferAttachments[0].endOfEncoderSampleIndex     = MTLCounterDontSample;
+        }
+        id<MTLBlitCommandEncoder> blitEncoder = [cmdBuffer_ blitCommandEncoderWithDescriptor:blitPassDesc];
+        [blitEncoder endEncoding];
+        [blitPassDesc release];
+    }
 }
 
 id<MTLRenderCommandEncoder> MTCommandContext::FlushAndGetRenderEncoder()
 {
+    if (isRenderEncoderPaused_ && renderEncoder_ == nil)
+        BindPausedRenderEncoder();
     if (renderDirtyBits_.bits != 0)
         SubmitRenderEncoderState();
     if (descriptorCache_ != nullptr)
         descriptorCache_->FlushGraphicsResources(GetRenderEncoder());
     if (constantsCache_ != nullptr)
-        constantsCache_->FlushGraphicsResources(GetRenderEncoder());
+        constantsCache_->FlushGraphicsResources(GetRenderEncoder(), constantsPool_);
     return GetRenderEncoder();
 }
 
@@ -293,7 +415,7 @@ id<MTLComputeCommandEncoder> MTCommandContext::FlushAndGetComputeEncoder()
     if (descriptorCache_ != nullptr)
         descriptorCache_->FlushComputeResources(GetComputeEncoder());
     if (constantsCache_ != nullptr)
-        constantsCache_->FlushComputeResources(GetComputeEncoder());
+        constantsCache_->FlushComputeResources(GetComputeEncoder(), constantsPool_);
     return GetComputeEncoder();
 }
 
@@ -378,6 +500,14 @@ void MTCommandContext::SubmitRenderEncoderState()
         else
             [renderEncoder_ setStencilReferenceValue:renderEncoderState_.stencilFrontRef];
     }
+    if (renderEncoderVisibilityBuffer_ != nil && renderDirtyBits_.visibilityResult != 0)
+    {
+        /* Set visibility result mode for occlusion queries */
+        [renderEncoder_
+            setVisibilityResultMode:    renderEncoderState_.visibilityResultMode
+            offset:                     renderEncoderState_.visibilityResultOffset
+        ];
+    }
 
     /* Reset all dirty bits */
     renderDirtyBits_.bits = 0;
@@ -390,6 +520,7 @@ void MTCommandContext::ResetRenderEncoderState()
     renderEncoderState_.vertexBufferRange.length  = 0;
     renderEncoderState_.graphicsPSO               = nullptr;
     renderEncoderState_.graphicsResourceHeap      = nullptr;
+    renderEncoderState_.visibilityResultMode      = MTLVisibilityResultModeDisabled;
 }
 
 void MTCommandContext::SubmitComputeEncoderState()
@@ -420,6 +551,88 @@ void MTCommandContext::ResetComputeEncoderState()
     computeEncoderState_.computeResourceHeap = nullptr;
 }
 
+void MTCommandContext::WaitForHazardFence()
+{
+    if (hazardFence_ == nil)
+        return;
+
+    if (@available(macOS 10.13, iOS 10.0, *))
+    {
+        if (renderEncoder_ != nil)
+            [renderEncoder_ waitForFence:hazardFence_ beforeStages:MTLRenderStageVertex];
+        else if (computeEncoder_ != nil)
+            [computeEncoder_ waitForFence:hazardFence_];
+        else if (blitEncoder_ != nil)
+            [blitEncoder_ waitForFence:hazardFence_];
+    }
+}
+
+void MTCommandContext::InvalidateRenderEncoderState()
+{
+    /* A new render command encoder forces all pipeline states to be reset */
+    renderDirtyBits_.bits = ~0;
+
+    /* Invalidate descriptor and constant caches */
+    if (descriptorCache_ != nullptr)
+        descriptorCache_->Reset();
+    if (constantsCache_ != nullptr)
+        constantsCache_->Reset();
+}
+
+void MTCommandContext::FlushParallelRenderEncoder()
+{
+    /* End the sub-encoder of this context; all other sub-encoders must have been ended by their own contexts */
+    if (renderEncoder_ != nil)
+    {
+        [renderEncoder_ endEncoding];
+        renderEncoder_ = nil;
+    }
+
+    /* Update hazard fence within a last sub-encoder, which is executed after all other sub-encoders */
+    if (hazardFence_ != nil)
+    {
+        if (@available(macOS 10.13, iOS 10.0, *))
+        {
+            id<MTLRenderCommandEncoder> lastRenderEncoder = [parallelEncoder_ renderCommandEncoder];
+            [lastRenderEncoder updateFence:hazardFence_ afterStages:MTLRenderStageFragment];
+            [lastRenderEncoder endEncoding];
+        }
+    }
+
+    [parallelEncoder_ endEncoding];
+    parallelEncoder_ = nil;
+}
+
+void MTCommandContext::BindPausedRenderEncoder()
+{
+    /* Bind new render command encoder with previous render pass */
+    auto renderPassDesc = CopyRenderPassDesc();
+    {
+        for_range(i, 8u)
+            renderPassDesc.colorAttachments[i].loadAction = MTLLoadActionLoad;
+        renderPassDesc.depthAttachment.loadAction = MTLLoadActionLoad;
+        renderPassDesc.stencilAttachment.loadAction = MTLLoadActionLoad;
+    }
+    BindRenderEncoder(renderPassDesc);
+    [renderPassDesc release];
+}
+
+void MTCommandContext::UpdateHazardFence()
+{
+    if (hazardFence_ == nil)
+        return;
+
+    if (@available(macOS 10.13, iOS 10.0, *))
+    {
+        if (renderEncoder_ != nil)
+            [renderEncoder_ updateFence:hazardFence_ afterStages:MTLRenderStageFragment];
+        else if (computeEncoder_ != nil)
+            [computeEncoder_ updateFence:hazardFence_];
+        else if (blitEncoder_ != nil)
+            [blitEncoder_ updateFence:hazardFence_];
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -16,12 +16,15 @@
 #include "../Texture/MTRenderTarget.h"
 #include "../RenderState/MTGraphicsPSO.h"
 #include "../RenderState/MTComputePSO.h"
+#include "../RenderState/MTQueryHeap.h"
+#include "../RenderState/MTBuiltinPSOFactory.h"
 #include "../MTTypes.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Assertion.h"
 
 #include <LLGL/Utils/ForRange.h>
 #include <LLGL/Backend/Metal/NativeCommand.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -140,6 +143,56 @@ static std::size_t ExecuteMTCommand(const MTOpcode opcode, const void* pc, MTCom
                 [sourceTexture release];
             return sizeof(*cmd);
         }
+        case MTOpcodeFillBuffer:
+        {
+            auto cmd = reinterpret_cast<const MTCmdFillBuffer*>(pc);
+            auto blitEncoder = context.BindBlitEncoder();
+            [blitEncoder fillBuffer:cmd->buffer range:cmd->range value:cmd->value];
+            return sizeof(*cmd);
+        }
+        case MTOpcodeFillBufferWide:
+        {
+            auto cmd = reinterpret_cast<const MTCmdFillBufferWide*>(pc);
+            auto computeEncoder = context.BindComputeEncoder();
+
+            /* Bind compute PSO with kernel to fill buffer */
+            id<MTLComputePipelineState> pso = MTBuiltinPSOFactory::Get().GetComputePSO(MTBuiltinComputePSO::FillBufferWide);
+            [computeEncoder setComputePipelineState:pso];
+            [computeEncoder setBuffer:cmd->buffer offset:cmd->offset atIndex:0];
+            [computeEncoder setBytes:cmd->params length:sizeof(cmd->params) atIndex:1];
+
+            /* Dispatch compute kernels; each thread fills four values */
+            if (@available(iOS 11.0, macOS 10.13, *))
+            {
+                [computeEncoder
+                    dispatchThreads:        MTLSizeMake(cmd->numThreads, 1, 1)
+                    threadsPerThreadgroup:  MTLSizeMake(std::min(cmd->numThreads, cmd->maxLocalThreads), 1, 1)
+                ];
+            }
+            else
+            {
+                const NSUInteger numThreadGroups = cmd->numThreads / cmd->maxLocalThreads;
+                if (numThreadGroups > 0)
+                {
+                    [computeEncoder
+                        dispatchThreadgroups:   MTLSizeMake(numThreadGroups, 1, 1)
+                        threadsPerThreadgroup:  MTLSizeMake(cmd->maxLocalThreads, 1, 1)
+                    ];
+                }
+                const NSUInteger remainingThreads = cmd->numThreads % cmd->maxLocalThreads;
+                if (remainingThreads > 0)
+                {
+                    [computeEncoder
+                        dispatchThreadgroups:   MTLSizeMake(1, 1, 1)
+                        threadsPerThreadgroup:  MTLSizeMake(remainingThreads, 1, 1)
+                    ];
+                }
+            }
+
+            /* Builtin kernel has overridden the compute PSO and buffer slots of the current encoder */
+            context.InvalidateComputeEncoderState();
+            return sizeof(*cmd);
+        }
         case MTOpcodePauseRenderEncoder:
         {
             context.PauseRenderEncoder();
@@ -213,6 +266,18 @@ static std::size_t ExecuteMTCommand(const MTOpcode opcode, const void* pc, MTCom
             context.SetStencilRef(cmd->ref, cmd->face);
             return sizeof(*cmd);
         }
+        case MTOpcodeBeginQuery:
+        {
+            auto cmd = reinterpret_cast<const MTCmdQuery*>(pc);
+            cmd->queryHeap->Begin(context, cmd->query);
+            return sizeof(*cmd);
+        }
+        case MTOpcodeEndQuery:
+        {
+            auto cmd = reinterpret_cast<const MTCmdQuery*>(pc);
+            cmd->queryHeap->End(context, cmd->query);
+            return sizeof(*cmd);
+        }
         case MTOpcodeSetVertexBuffers:
         {
             auto cmd = reinterpret_cast<const MTCmdSetVertexBuffers*>(pc);
@@ -359,6 +424,54 @@ static std::size_t ExecuteMTCommand(const MTOpcode opcode, const void* pc, MTCom
             ];
             return sizeof(*cmd);
         }
+        case MTOpcodeDrawMeshThreadgroups:
+        {
+            auto cmd = reinterpret_cast<const MTCmdDrawMeshThreadgroups*>(pc);
+            if (@available(macOS 13.0, iOS 16.0, *))
+            {
+                auto renderEncoder = context.FlushAndGetRenderEncoder();
+                [renderEncoder
+                    drawMeshThreadgroups:           cmd->threadgroups
+                    threadsPerObjectThreadgroup:    cmd->threadsPerObjectThreadgroup
+                    threadsPerMeshThreadgroup:      cmd->threadsPerMeshThreadgroup
+                ];
+            }
+            return sizeof(*cmd);
+        }
+        case MTOpcodeDrawMeshThreadgroupsIndirect:
+        {
+            auto cmd = reinterpret_cast<const MTCmdDrawMeshThreadgroupsIndirect*>(pc);
+            if (@available(macOS 13.0, iOS 16.0, *))
+            {
+                auto renderEncoder = context.FlushAndGetRenderEncoder();
+                [renderEncoder
+                    drawMeshThreadgroupsWithIndirectBuffer: cmd->indirectBuffer
+                    indirectBufferOffset:                   cmd->indirectBufferOffset
+                    threadsPerObjectThreadgroup:            cmd->threadsPerObjectThreadgroup
+                    threadsPerMeshThreadgroup:              cmd->threadsPerMeshThreadgroup
+                ];
+            }
+            return sizeof(*cmd);
+        }
+        case MTOpcodeExecuteIndirectCommands:
+        {
+            auto cmd = reinterpret_cast<const MTCmdExecuteIndirectCommands*>(pc);
+            auto resources = reinterpret_cast<const id<MTLResource>*>(cmd + 1);
+            if (@available(macOS 10.14, iOS 12.0, *))
+            {
+                auto renderEncoder = context.FlushAndGetRenderEncoder();
+
+                /* Resources that are only referenced by the indirect commands (i.e. index buffers) must be made resident explicitly */
+                if (cmd->numResources > 0)
+                    [renderEncoder useResources:resources count:cmd->numResources usage:MTLResourceUsageRead];
+
+                [renderEncoder
+                    executeCommandsInBuffer:    cmd->indirectCommandBuffer
+                    withRange:                  NSMakeRange(0, cmd->numCommands)
+                ];
+            }
+            return (sizeof(*cmd) + sizeof(id)*cmd->numResources);
+        }
         case MTOpcodeDispatchThreads:
         {
             auto cmd = reinterpret_cast<const MTCmdDispatchThreads*>(pc);
@@ -408,10 +521,10 @@ static std::size_t ExecuteMTCommand(const MTOpcode opcode, const void* pc, MTCom
         case MTOpcodePresentDrawables:
         {
             auto cmd = reinterpret_cast<const MTCmdPresentDrawables*>(pc);
-            auto views = reinterpret_cast<MTKView* const*>(cmd + 1);
+            auto swapChains = reinterpret_cast<MTSwapChain* const*>(cmd + 1);
             for_range(i, cmd->count)
-                [context.GetCommandBuffer() presentDrawable:views[i].currentDrawable];
-            return (sizeof(*cmd) + sizeof(id)*cmd->count);
+                swapChains[i]->PresentDrawable(context.GetCommandBuffer(), swapChains[i]->GetMTKView().currentDrawable);
+            return (sizeof(*cmd) + sizeof(MTSwapChain*)*cmd->count);
         }
         case MTOpcodeFlush:
         {
@@ -435,16 +548,20 @@ static void ExecuteMTCommandsEmulated(const MTVirtualCommandBuffer& virtualCmdBu
         {
             /* Read opcode */
             const MTOpcode opcode = *reinterpret_cast<const MTOpcode*>(pc);
-            pc += sizeof(MTOpcode);
+            pc += MTVirtualCommandBuffer::OpcodeSize();
 
             /* Execute command and increment program counter */
-            pc += ExecuteMTCommand(opcode, pc, context);
+            pc += MTVirtualCommandBuffer::AlignSize(ExecuteMTCommand(opcode, pc, context));
         }
     }
 }
 
 void ExecuteMTMultiSubmitCommandBuffer(const MTMultiSubmitCommandBuffer& cmdBuffer, MTCommandContext& context)
 {
+    /* Keep staging data of the recorded commands alive until the GPU has completed the native command buffer */
+    if (id<MTLCommandBuffer> nativeCmdBuffer = context.GetCommandBuffer())
+        cmdBuffer.TrackStagingPool(nativeCmdBuffer);
+
     /* Emulate execution of Metal commands */
     ExecuteMTCommandsEmulated(cmdBuffer.GetVirtualCommandBuffer(), context);
 }
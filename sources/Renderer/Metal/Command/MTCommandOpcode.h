@@ -25,6 +25,8 @@ enum MTOpcode : std::uint8_t
     MTOpcodeCopyTexture,
     MTOpcodeCopyTextureFromBuffer,
     MTOpcodeCopyTextureFromFramebuffer,
+    MTOpcodeFillBuffer,
+    MTOpcodeFillBufferWide,
     MTOpcodePauseRenderEncoder,
     MTOpcodeResumeRenderEncoder,
     MTOpcodeGenerateMipmaps,
@@ -36,6 +38,8 @@ enum MTOpcode : std::uint8_t
     MTOpcodeSetScissorRects,
     MTOpcodeSetBlendColor,
     MTOpcodeSetStencilRef,
+    MTOpcodeBeginQuery,
+    MTOpcodeEndQuery,
     MTOpcodeSetVertexBuffers,
     MTOpcodeSetGraphicsResourceHeap,
     MTOpcodeSetComputeResourceHeap,
@@ -46,6 +50,9 @@ enum MTOpcode : std::uint8_t
     MTOpcodeDrawPrimitives,
     MTOpcodeDrawIndexedPatches,
     MTOpcodeDrawIndexedPrimitives,
+    MTOpcodeDrawMeshThreadgroups,
+    MTOpcodeDrawMeshThreadgroupsIndirect,
+    MTOpcodeExecuteIndirectCommands,
     MTOpcodeDispatchThreads,
     MTOpcodeDispatchThreadgroups,
     MTOpcodeDispatchThreadgroupsIndirect,
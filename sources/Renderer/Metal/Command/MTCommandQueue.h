@@ -12,6 +12,7 @@
 #import <MetalKit/MetalKit.h>
 
 #include <LLGL/CommandQueue.h>
+#include "../../FrameCounters.h"
 
 
 namespace LLGL
@@ -27,7 +28,7 @@ class MTCommandQueue final : public CommandQueue
 
     public:
 
-        MTCommandQueue(id<MTLDevice> device);
+        MTCommandQueue(id<MTLDevice> device, bool hazardTracking = false);
         ~MTCommandQueue();
 
     public:
@@ -41,10 +42,18 @@ class MTCommandQueue final : public CommandQueue
         // Submits the specified Metal command buffer.
         void SubmitCommandBuffer(id<MTLCommandBuffer> cmdBuffer);
 
+        // Returns the fence that synchronizes all command encoders of this queue or nil if resources are hazard tracked by Metal. See MTHeapAllocator.
+        inline id<MTLFence> GetHazardFence() const
+        {
+            return hazardFence_;
+        }
+
     private:
 
         id<MTLCommandQueue>     native_                 = nil;
         id<MTLCommandBuffer>    lastSubmittedCmdBuffer_ = nil;
+        id<MTLFence>            hazardFence_            = nil;
+        FrameCounterAccumulator frameCounters_;
 
 };
 
@@ -9,22 +9,35 @@
 #include "MTDirectCommandBuffer.h"
 #include "MTMultiSubmitCommandBuffer.h"
 #include "MTCommandExecutor.h"
+#include "../RenderState/MTFence.h"
+#include "../RenderState/MTQueryHeap.h"
 #include "../../CheckedCast.h"
+#include "../../HostTrace.h"
+#include "../../TimestampUtils.h"
 
 
 namespace LLGL
 {
 
 
-MTCommandQueue::MTCommandQueue(id<MTLDevice> device)
+MTCommandQueue::MTCommandQueue(id<MTLDevice> device, bool hazardTracking)
 {
     native_ = [device newCommandQueue];
+
+    /* Create fence to synchronize command encoders that access resources which are not hazard tracked by Metal */
+    if (hazardTracking)
+    {
+        if (@available(macOS 10.13, iOS 10.0, *))
+            hazardFence_ = [device newFence];
+    }
 }
 
 MTCommandQueue::~MTCommandQueue()
 {
     if (lastSubmittedCmdBuffer_ != nil)
         [lastSubmittedCmdBuffer_ release];
+    if (hazardFence_ != nil)
+        [hazardFence_ release];
     [native_ release];
 }
 
@@ -32,12 +45,14 @@ MTCommandQueue::~MTCommandQueue()
 
 void MTCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_HOST_TRACE_SCOPE("Submit");
+
     auto& commandBufferMT = LLGL_CAST(MTCommandBuffer&, commandBuffer);
     if (commandBufferMT.IsMultiSubmitCmdBuffer())
     {
         auto& multiSubmitCommandBufferMT = LLGL_CAST(MTMultiSubmitCommandBuffer&, commandBufferMT);
         MTCommandContext context;
-        context.Reset([native_ commandBuffer]);
+        context.Reset([native_ commandBuffer], hazardFence_);
         ExecuteMTMultiSubmitCommandBuffer(multiSubmitCommandBufferMT, context);
         SubmitCommandBuffer(context.GetCommandBuffer());
     }
@@ -47,6 +62,19 @@ void MTCommandQueue::Submit(CommandBuffer& commandBuffer)
         if (!directCommandBufferMT.IsImmediateCmdBuffer())
             SubmitCommandBuffer(directCommandBufferMT.GetNative());
     }
+    frameCounters_.SubmitCommandBuffer(commandBufferMT.GetFrameCounters());
+}
+
+/* ----- Sparse Resources ----- */
+
+void MTCommandQueue::UpdateTileMappings(Texture& /*texture*/, std::uint32_t /*numMappings*/, const TextureTileMapping* /*mappings*/)
+{
+    // dummy
+}
+
+void MTCommandQueue::UpdateTileMappings(Buffer& /*buffer*/, std::uint32_t /*numMappings*/, const BufferTileMapping* /*mappings*/)
+{
+    // dummy
 }
 
 /* ----- Queries ----- */
@@ -58,19 +86,75 @@ bool MTCommandQueue::QueryResult(
     void*           data,
     std::size_t     dataSize)
 {
-    return false; //todo
+    auto& queryHeapMT = LLGL_CAST(MTQueryHeap&, queryHeap);
+    return queryHeapMT.QueryResults(firstQuery, numQueries, data, dataSize);
+}
+
+bool MTCommandQueue::QueryFrameCounters(FrameProfile& outProfile)
+{
+    return frameCounters_.Query(outProfile);
+}
+
+bool MTCommandQueue::GetCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    if (@available(macOS 10.15, iOS 14.0, *))
+    {
+        /*
+        MTQueryHeap already converts timestamp queries into the CPU time domain of MTLDevice,
+        so the CPU timestamp of this device is reported as GPU timestamp and bracketed by Timer::Tick.
+        */
+        id<MTLDevice> device = [native_ device];
+        return SampleCalibratedTimestamps(
+            outTimestamps,
+            [device](std::uint64_t& outGPUTimestamp) -> bool
+            {
+                MTLTimestamp cpuTime = 0, gpuTime = 0;
+                [device sampleTimestamps:&cpuTime gpuTimestamp:&gpuTime];
+                outGPUTimestamp = cpuTime;
+                return true;
+            }
+        );
+    }
+    return false;
 }
 
 /* ----- Fences ----- */
 
 void MTCommandQueue::Submit(Fence& fence)
 {
-    //todo
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    Submit(fence, fenceMT.GetSignaledValue() + 1);
+}
+
+void MTCommandQueue::Submit(Fence& fence, std::uint64_t value)
+{
+    /* Encode signal into an empty command buffer; the GPU signals it once all previous command buffers of this queue have been completed */
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    id<MTLCommandBuffer> cmdBuffer = [native_ commandBuffer];
+    fenceMT.Signal(cmdBuffer, value);
+    SubmitCommandBuffer(cmdBuffer);
+    frameCounters_.SubmitFence();
+}
+
+void MTCommandQueue::SubmitWait(Fence& fence, std::uint64_t value)
+{
+    /* Encode wait into an empty command buffer to block all subsequent command buffers of this queue */
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    id<MTLCommandBuffer> cmdBuffer = [native_ commandBuffer];
+    fenceMT.EncodeWait(cmdBuffer, value);
+    SubmitCommandBuffer(cmdBuffer);
 }
 
 bool MTCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
-    return false;//todo
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    return fenceMT.Wait(fenceMT.GetSignaledValue(), timeout);
+}
+
+bool MTCommandQueue::WaitFence(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceMT = LLGL_CAST(MTFence&, fence);
+    return fenceMT.Wait(value, timeout);
 }
 
 void MTCommandQueue::WaitIdle()
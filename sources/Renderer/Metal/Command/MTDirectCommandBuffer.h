@@ -10,6 +10,7 @@
 
 
 #include "MTCommandBuffer.h"
+#include "../RenderState/MTRenderPass.h"
 #include <LLGL/Container/SmallVector.h>
 
 
@@ -46,9 +47,18 @@ class MTDirectCommandBuffer final : public MTCommandBuffer
             return ((GetFlags() & CommandBufferFlags::ImmediateSubmit) != 0);
         }
 
+        // Returns the render pass this secondary command buffer encodes into in parallel or null if this is not a parallel command buffer.
+        inline const MTRenderPass* GetParallelRenderPass() const
+        {
+            return parallelRenderPass_;
+        }
+
     private:
 
-        void QueueDrawable(id<MTLDrawable> drawable);
+        // Binds the render encoder for the specified render pass descriptor, or a parallel render encoder if the render pass has parallel command buffers.
+        void BindRenderEncoderForRenderPass(MTLRenderPassDescriptor* renderPassDesc, const RenderPass* renderPass);
+
+        void QueueDrawable(const MTSwapChain& swapChainMT);
         void PresentDrawables();
 
         // Returns the texture of the current drawable from the active framebuffer.
@@ -57,7 +67,18 @@ class MTDirectCommandBuffer final : public MTCommandBuffer
         void FillBufferByte1(MTBuffer& bufferMT, const NSRange& range, std::uint8_t value);
         void FillBufferByte4(MTBuffer& bufferMT, const NSRange& range, std::uint32_t value);
         void FillBufferByte4Emulated(MTBuffer& bufferMT, const NSRange& range, std::uint32_t value);
-        void FillBufferByte4Accelerated(MTBuffer& bufferMT, const NSRange& range, std::uint32_t value);
+
+        // Fills the specified buffer range with a pattern of one, two, or four 32-bit values using a builtin kernel.
+        void FillBufferWideAccelerated(MTBuffer& bufferMT, const NSRange& range, const void* pattern, std::uint32_t patternSize);
+
+        // Copies the specified buffer range with a builtin kernel. Offsets and size must be a multiple of 4.
+        void CopyBufferAccelerated(MTBuffer& dstBufferMT, NSUInteger dstOffset, MTBuffer& srcBufferMT, NSUInteger srcOffset, NSUInteger size);
+
+        /*
+        Returns true if the specified buffer ranges can be processed with builtin kernels inside the current compute encoder.
+        This avoids ending the compute encoder only to encode a small blit command.
+        */
+        bool IsKernelPreferredOverBlit(NSUInteger offset, NSUInteger size) const;
 
         id<MTLRenderCommandEncoder> DispatchTessellationAndGetRenderEncoder(NSUInteger numPatches, NSUInteger numInstances = 1);
 
@@ -68,15 +89,25 @@ class MTDirectCommandBuffer final : public MTCommandBuffer
             NSUInteger                      numThreads
         );
 
+    private:
+
+        struct QueuedDrawable
+        {
+            id<MTLDrawable>     drawable;
+            const MTSwapChain*  swapChain;
+        };
+
     private:
 
         id<MTLCommandBuffer>            cmdBuffer_              = nil;
-        dispatch_semaphore_t            cmdBufferSemaphore_     = nil;
 
         MTCommandQueue&                 cmdQueue_;
         MTCommandContext                context_;
 
-        SmallVector<id<MTLDrawable>, 2> drawables_;
+        SmallVector<QueuedDrawable, 2>  drawables_;
+
+        const MTRenderPass*             parallelRenderPass_         = nullptr;  // Render pass of a parallel secondary command buffer.
+        const MTRenderPass*             activeParallelRenderPass_   = nullptr;  // Render pass a primary command buffer is currently encoding in parallel.
 
 };
 
@@ -16,6 +16,7 @@
 #include "../RenderState/MTGraphicsPSO.h"
 #include "../RenderState/MTComputePSO.h"
 #include "../RenderState/MTResourceHeap.h"
+#include "../RenderState/MTQueryHeap.h"
 #include "../RenderState/MTBuiltinPSOFactory.h"
 #include "../RenderState/MTDescriptorCache.h"
 #include "../RenderState/MTConstantsCache.h"
@@ -23,8 +24,11 @@
 #include "../Texture/MTTexture.h"
 #include "../Texture/MTSampler.h"
 #include "../Texture/MTRenderTarget.h"
+#include "../../BufferUtils.h"
 #include "../../CheckedCast.h"
+#include "../../FrameCounters.h"
 #include "../../../Core/Exception.h"
+#include "../../../Core/Assertion.h"
 #include <LLGL/TypeInfo.h>
 #include <LLGL/Utils/ForRange.h>
 #include <algorithm>
@@ -45,15 +49,21 @@ for smaller buffers an emulated CPU copy operation will be used.
 static const NSUInteger g_minFillBufferForKernel = 64;
 
 MTDirectCommandBuffer::MTDirectCommandBuffer(id<MTLDevice> device, MTCommandQueue& cmdQueue, const CommandBufferDescriptor& desc) :
-    MTCommandBuffer    { device, desc.flags },
+    MTCommandBuffer    { device, desc       },
     cmdQueue_          { cmdQueue           }
 {
-    const NSUInteger maxCmdBuffers = 3;
-    cmdBufferSemaphore_ = dispatch_semaphore_create(maxCmdBuffers);
+    /* Register secondary command buffer for parallel encoding into the specified render pass */
+    if ((desc.flags & CommandBufferFlags::Secondary) != 0 && desc.renderPass != nullptr)
+    {
+        parallelRenderPass_ = LLGL_CAST(const MTRenderPass*, desc.renderPass);
+        parallelRenderPass_->AttachParallelCommandBuffer();
+    }
 }
 
 MTDirectCommandBuffer::~MTDirectCommandBuffer()
 {
+    if (parallelRenderPass_ != nullptr)
+        parallelRenderPass_->DetachParallelCommandBuffer();
     [cmdBuffer_ release];
 }
 
@@ -61,31 +71,46 @@ MTDirectCommandBuffer::~MTDirectCommandBuffer()
 
 void MTDirectCommandBuffer::Begin()
 {
-    /* Wait until next command buffer becomes available */
-    dispatch_semaphore_wait(cmdBufferSemaphore_, DISPATCH_TIME_FOREVER);
+    LLGL_FRAME_COUNTER_BEGIN();
+
+    if (parallelRenderPass_ != nullptr)
+    {
+        /* Encode into a new sub-encoder of the primary command buffer that is currently inside the render pass */
+        id<MTLParallelRenderCommandEncoder> parallelEncoder = parallelRenderPass_->GetParallelEncoder();
+        LLGL_ASSERT(parallelEncoder != nil, "parallel secondary command buffer must begin while a primary command buffer is inside its render pass");
+        ResetStagingPool();
+        context_.Reset(nil, nil, &GetStagingBufferPool());
+        context_.BindSubRenderEncoder(parallelEncoder);
+        return;
+    }
 
     /* Allocate new command buffer from command queue */
     cmdBuffer_ = [cmdQueue_.GetNative() commandBuffer];
 
-    /* Append complete handler to signal semaphore */
-    __block dispatch_semaphore_t blockSemaphore = cmdBufferSemaphore_;
-    [cmdBuffer_
-        addCompletedHandler:^(id<MTLCommandBuffer> cmdBuffer)
-        {
-            dispatch_semaphore_signal(blockSemaphore);
-        }
-    ];
-
-    /* Reset schedulers and pools */
-    context_.Reset(cmdBuffer_);
+    /*
+    Reset schedulers and pools. Staging chunks that are still read by previous command buffers
+    stay in flight until their completed handlers have been called, so this never waits for the GPU.
+    */
     ResetStagingPool();
+    context_.Reset(cmdBuffer_, cmdQueue_.GetHazardFence(), &GetStagingBufferPool());
 }
 
 void MTDirectCommandBuffer::End()
 {
     context_.Flush();
+
+    /* Parallel secondary command buffers only end their sub-encoder */
+    if (parallelRenderPass_ != nullptr)
+    {
+        ResetRenderStates();
+        return;
+    }
+
     PresentDrawables();
 
+    /* Keep staging data alive until the GPU has completed this command buffer */
+    TrackStagingPool(cmdBuffer_);
+
     /* Commit native buffer right after encoding for immediate command buffers */
     if (IsImmediateCmdBuffer())
         cmdQueue_.SubmitCommandBuffer(GetNative());
@@ -103,9 +128,25 @@ void MTDirectCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
             auto& multiSubmitCommandBufferMT = LLGL_CAST(MTMultiSubmitCommandBuffer&, commandBufferMT);
             ExecuteMTMultiSubmitCommandBuffer(multiSubmitCommandBufferMT, context_);
         }
+        else if (!commandBufferMT.IsMultiSubmitCmdBuffer())
+        {
+            /* Parallel secondary command buffers have already been encoded into sub-encoders of the active render pass */
+            auto& directCommandBufferMT = LLGL_CAST(MTDirectCommandBuffer&, commandBufferMT);
+            LLGL_ASSERT(
+                directCommandBufferMT.GetParallelRenderPass() != nullptr && directCommandBufferMT.GetParallelRenderPass() == activeParallelRenderPass_,
+                "secondary command buffer must be executed inside the render pass it has been encoded into"
+            );
+            directCommandBufferMT.TrackStagingPool(cmdBuffer_);
+        }
+        LLGL_FRAME_COUNTER_EXECUTE(commandBufferMT.GetFrameCounters());
     }
 }
 
+void MTDirectCommandBuffer::TrimMemory()
+{
+    TrimStagingPool();
+}
+
 /* ----- Blitting ----- */
 
 void MTDirectCommandBuffer::UpdateBuffer(
@@ -114,6 +155,8 @@ void MTDirectCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferUpdates);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
 
     /* Copy data to staging buffer */
@@ -144,9 +187,24 @@ void MTDirectCommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
 
+    /* Copy buffer inside the current compute encoder if possible */
+    if (IsKernelPreferredOverBlit(static_cast<NSUInteger>(dstOffset | srcOffset), static_cast<NSUInteger>(size)))
+    {
+        CopyBufferAccelerated(
+            dstBufferMT,
+            static_cast<NSUInteger>(dstOffset),
+            srcBufferMT,
+            static_cast<NSUInteger>(srcOffset),
+            static_cast<NSUInteger>(size)
+        );
+        return;
+    }
+
     context_.PauseRenderEncoder();
     {
         auto blitEncoder = context_.BindBlitEncoder();
@@ -169,6 +227,8 @@ void MTDirectCommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
 
@@ -214,6 +274,8 @@ void MTDirectCommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
     if (fillSize == 0)
         return;
 
@@ -242,13 +304,51 @@ void MTDirectCommandBuffer::FillBuffer(
         );
     }
 
-    /* Fill with native command if all four bytes are equal, otherwise use blit and comput commands */
-    if (valueBytesAreEqual)
+    /* Fill with native command if all four bytes are equal, otherwise use blit and compute commands */
+    if (valueBytesAreEqual && !IsKernelPreferredOverBlit(range.location, range.length))
         FillBufferByte1(dstBufferMT, range, static_cast<std::uint8_t>(value & 0x000000FF));
     else
         FillBufferByte4(dstBufferMT, range, value);
 }
 
+void MTDirectCommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    /* Forward patterns of a single 32-bit value to the default fill command */
+    std::uint32_t value = 0;
+    if (GetUniformFillPatternValue(pattern, patternSize, value))
+        return FillBuffer(dstBuffer, dstOffset, value, fillSize);
+
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
+    if (fillSize == 0)
+        return;
+
+    auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
+
+    /* Determine buffer range for fill command */
+    NSRange range;
+    if (fillSize == Constants::wholeSize)
+    {
+        NSUInteger bufferSize = [dstBufferMT.GetNative() length];
+        range = NSMakeRange(0, bufferSize);
+    }
+    else
+    {
+        range = NSMakeRange(
+            static_cast<NSUInteger>(dstOffset),
+            static_cast<NSUInteger>(fillSize)
+        );
+    }
+
+    /* Always fill wide patterns with the builtin kernel, since the blit encoder can only fill single bytes */
+    FillBufferWideAccelerated(dstBufferMT, range, pattern, patternSize);
+}
+
 void MTDirectCommandBuffer::CopyTexture(
     Texture&                dstTexture,
     const TextureLocation&  dstLocation,
@@ -256,6 +356,8 @@ void MTDirectCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
     auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
 
@@ -292,6 +394,8 @@ void MTDirectCommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
     auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
 
@@ -336,6 +440,8 @@ void MTDirectCommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     id<MTLTexture> drawableTexture = GetCurrentDrawableTexture();
     if (drawableTexture == nil)
         return /*No drawable source texture*/;
@@ -395,6 +501,8 @@ void MTDirectCommandBuffer::CopyTextureFromFramebuffer(
 
 void MTDirectCommandBuffer::GenerateMips(Texture& texture)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     if ([textureMT.GetNative() mipmapLevelCount] > 1)
     {
@@ -409,6 +517,8 @@ void MTDirectCommandBuffer::GenerateMips(Texture& texture)
 
 void MTDirectCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     if (subresource.numMipLevels > 1)
     {
         auto& textureMT = LLGL_CAST(MTTexture&, texture);
@@ -427,6 +537,11 @@ void MTDirectCommandBuffer::GenerateMips(Texture& texture, const TextureSubresou
     }
 }
 
+void MTDirectCommandBuffer::CompressTexture(Texture& /*dstTexture*/, Texture& /*srcTexture*/, const TextureSubresource& /*subresource*/)
+{
+    // dummy
+}
+
 /* ----- Viewport and Scissor ----- */
 
 void MTDirectCommandBuffer::SetViewport(const Viewport& viewport)
@@ -453,12 +568,16 @@ void MTDirectCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor
 
 void MTDirectCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     context_.SetVertexBuffer(bufferMT.GetNative(), 0);
 }
 
 void MTDirectCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferArrayMT = LLGL_CAST(MTBufferArray&, bufferArray);
     context_.SetVertexBuffers(
         bufferArrayMT.GetIDArray().data(),
@@ -471,6 +590,8 @@ void MTDirectCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void MTDirectCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
+    LLGL_FRAME_COUNTER_INC(resourceHeapBindings);
+
     MTPipelineState* boundPipelineState = GetBoundPipelineState();
     if (boundPipelineState == nullptr)
         return /*Invalid state*/;
@@ -507,21 +628,23 @@ void MTDirectCommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       /*swapBufferIndex*/)
 {
+    LLGL_FRAME_COUNTER_INC(renderPassSections);
+
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
     {
         /* Put current drawable into queue */
         auto& swapChainMT = LLGL_CAST(MTSwapChain&, renderTarget);
         SetSwapChain(&swapChainMT);
-        QueueDrawable(swapChainMT.GetMTKView().currentDrawable);
+        QueueDrawable(swapChainMT);
 
         /* Get next render pass descriptor from MetalKit view */
         if (renderPass != nullptr)
         {
             auto* renderPassMT = LLGL_CAST(const MTRenderPass*, renderPass);
-            context_.BindRenderEncoder(swapChainMT.GetAndUpdateNativeRenderPass(*renderPassMT, numClearValues, clearValues), true);
+            BindRenderEncoderForRenderPass(swapChainMT.GetAndUpdateNativeRenderPass(*renderPassMT, numClearValues, clearValues), renderPass);
         }
         else
-            context_.BindRenderEncoder(swapChainMT.GetNativeRenderPass(), true);
+            BindRenderEncoderForRenderPass(swapChainMT.GetNativeRenderPass(), nullptr);
     }
     else
     {
@@ -531,21 +654,30 @@ void MTDirectCommandBuffer::BeginRenderPass(
         if (renderPass != nullptr)
         {
             auto* renderPassMT = LLGL_CAST(const MTRenderPass*, renderPass);
-            context_.BindRenderEncoder(renderTargetMT.GetAndUpdateNativeRenderPass(*renderPassMT, numClearValues, clearValues), true);
+            BindRenderEncoderForRenderPass(renderTargetMT.GetAndUpdateNativeRenderPass(*renderPassMT, numClearValues, clearValues), renderPass);
         }
         else
-            context_.BindRenderEncoder(renderTargetMT.GetNativeRenderPass(), true);
+            BindRenderEncoderForRenderPass(renderTargetMT.GetNativeRenderPass(), nullptr);
     }
 }
 
 void MTDirectCommandBuffer::EndRenderPass()
 {
-    context_.Flush();
+    context_.EndRenderPass();
+
+    /* Secondary command buffers can no longer encode into this render pass */
+    if (activeParallelRenderPass_ != nullptr)
+    {
+        activeParallelRenderPass_->SetParallelEncoder(nil);
+        activeParallelRenderPass_ = nullptr;
+    }
 }
 
 void MTDirectCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
-    if (context_.GetRenderEncoder() != nil && flags != 0)
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
+    if (context_.HasRenderEncoder() && flags != 0)
     {
         /* Make new render pass descriptor with current clear values */
         auto renderPassDesc = context_.CopyRenderPassDesc();
@@ -602,7 +734,9 @@ static void FillMTRenderPassDesc(MTLRenderPassDescriptor* renderPassDesc, const
 
 void MTDirectCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
-    if (context_.GetRenderEncoder() != nil && numAttachments > 0)
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
+    if (context_.HasRenderEncoder() && numAttachments > 0)
     {
         /* Make new render pass descriptor with current clear values */
         auto renderPassDesc = context_.CopyRenderPassDesc();
@@ -620,7 +754,9 @@ void MTDirectCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const
 
 void MTDirectCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    auto& pipelineStateMT = LLGL_CAST(MTPipelineState&, pipelineState);
+    /* Native PSOs are created in the background, so wait until the PSO is ready to be encoded or use its fallback */
+    auto& pipelineStateMT = LLGL_CAST(MTPipelineState&, pipelineState).GetReadyOrFallback();
+
     if (pipelineStateMT.IsGraphicsPSO())
     {
         /* Set graphics pipeline with encoder scheduler */
@@ -651,16 +787,22 @@ void MTDirectCommandBuffer::SetStencilReference(std::uint32_t reference, const S
 
 void MTDirectCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //todo
+    LLGL_FRAME_COUNTER_INC(querySections);
+
+    auto& queryHeapMT = LLGL_CAST(MTQueryHeap&, queryHeap);
+    queryHeapMT.Begin(context_, query);
 }
 
 void MTDirectCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //todo
+    auto& queryHeapMT = LLGL_CAST(MTQueryHeap&, queryHeap);
+    queryHeapMT.End(context_, query);
 }
 
 void MTDirectCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_FRAME_COUNTER_INC(renderConditionSections);
+
     //todo
 }
 
@@ -673,6 +815,8 @@ void MTDirectCommandBuffer::EndRenderCondition()
 
 void MTDirectCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
+    LLGL_FRAME_COUNTER_INC(streamOutputSections);
+
     //todo
 }
 
@@ -685,6 +829,8 @@ void MTDirectCommandBuffer::EndStreamOutput()
 
 void MTDirectCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
     {
@@ -715,6 +861,8 @@ void MTDirectCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstV
 
 void MTDirectCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
     {
@@ -749,16 +897,22 @@ void MTDirectCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t
 
 void MTDirectCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     MTDirectCommandBuffer::DrawIndexedInstanced(numIndices, /*numInstances:*/ 1, firstIndex, vertexOffset, /*firstInstance:*/ 0);
 }
 
 void MTDirectCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     MTDirectCommandBuffer::DrawInstanced(numVertices, firstVertex, numInstances, /*firstInstance:*/ 0);
 }
 
 void MTDirectCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
     {
@@ -791,16 +945,22 @@ void MTDirectCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32
 
 void MTDirectCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     MTDirectCommandBuffer::DrawIndexedInstanced(numIndices, numInstances, firstIndex, /*vertexOffset:*/ 0, /*firstInstance:*/ 0);
 }
 
 void MTDirectCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     MTDirectCommandBuffer::DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, /*firstInstance:*/ 0);
 }
 
 void MTDirectCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
     {
@@ -845,6 +1005,8 @@ static void TrapIndirectPatchesNotSupported()
 //TODO: support patches with indirect arguments
 void MTDirectCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
@@ -875,6 +1037,8 @@ void MTDirectCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 //TODO: support patches with indirect arguments
 void MTDirectCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
@@ -913,6 +1077,8 @@ void MTDirectCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, s
 //TODO: support patches with indirect arguments
 void MTDirectCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
@@ -948,6 +1114,8 @@ void MTDirectCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t of
 //TODO: support patches with indirect arguments
 void MTDirectCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
@@ -988,10 +1156,81 @@ void MTDirectCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t of
     }
 }
 
+void MTDirectCommandBuffer::DrawIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void MTDirectCommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void MTDirectCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        auto renderEncoder = context_.FlushAndGetRenderEncoder();
+        [renderEncoder
+            drawMeshThreadgroups:           MTLSizeMake(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ)
+            threadsPerObjectThreadgroup:    GetThreadsPerObjectThreadgroup()
+            threadsPerMeshThreadgroup:      GetThreadsPerMeshThreadgroup()
+        ];
+    }
+}
+
+void MTDirectCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+        auto renderEncoder = context_.FlushAndGetRenderEncoder();
+        while (numCommands-- > 0)
+        {
+            [renderEncoder
+                drawMeshThreadgroupsWithIndirectBuffer: bufferMT.GetNative()
+                indirectBufferOffset:                   static_cast<NSUInteger>(offset)
+                threadsPerObjectThreadgroup:            GetThreadsPerObjectThreadgroup()
+                threadsPerMeshThreadgroup:              GetThreadsPerMeshThreadgroup()
+            ];
+            offset += stride;
+        }
+    }
+}
+
+void MTDirectCommandBuffer::DrawStreamOutput()
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
 /* ----- Compute ----- */
 
 void MTDirectCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     auto computeEncoder = context_.FlushAndGetComputeEncoder();
     [computeEncoder
         dispatchThreadgroups:   MTLSizeMake(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ)
@@ -1001,6 +1240,8 @@ void MTDirectCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t
 
 void MTDirectCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     auto computeEncoder = context_.FlushAndGetComputeEncoder();
     [computeEncoder
@@ -1010,6 +1251,33 @@ void MTDirectCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offse
     ];
 }
 
+void MTDirectCommandBuffer::CompactIndirectArguments(
+    Buffer&         /*dstBuffer*/,
+    std::uint64_t   /*dstOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    Buffer&         /*srcBuffer*/,
+    std::uint64_t   /*srcOffset*/,
+    Buffer&         /*visibilityBuffer*/,
+    std::uint64_t   /*visibilityOffset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    // dummy
+}
+
+/* ----- Ray Tracing ----- */
+
+void MTDirectCommandBuffer::BuildAccelerationStructure(AccelerationStructure& /*accelerationStructure*/, const AccelerationStructureBuildDescriptor& /*buildDesc*/)
+{
+    // dummy
+}
+
+void MTDirectCommandBuffer::CopyAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/, bool /*compact*/)
+{
+    // dummy
+}
+
 /* ----- Debugging ----- */
 
 void MTDirectCommandBuffer::PushDebugGroup(const char* name)
@@ -1064,20 +1332,34 @@ bool MTDirectCommandBuffer::IsMultiSubmitCmdBuffer() const
  * ======= Private: =======
  */
 
-void MTDirectCommandBuffer::QueueDrawable(id<MTLDrawable> drawable)
+void MTDirectCommandBuffer::BindRenderEncoderForRenderPass(MTLRenderPassDescriptor* renderPassDesc, const RenderPass* renderPass)
 {
-    for (id<MTLDrawable> d : drawables_)
+    auto* renderPassMT = LLGL_CAST(const MTRenderPass*, renderPass);
+    if (renderPassMT != nullptr && renderPassMT->HasParallelCommandBuffers() && parallelRenderPass_ == nullptr)
     {
-        if (d == drawable)
+        /* Begin parallel render pass for all secondary command buffers that have been created with this render pass */
+        renderPassMT->SetParallelEncoder(context_.BindParallelRenderEncoder(renderPassDesc));
+        activeParallelRenderPass_ = renderPassMT;
+    }
+    else
+        context_.BindRenderEncoder(renderPassDesc, true);
+}
+
+void MTDirectCommandBuffer::QueueDrawable(const MTSwapChain& swapChainMT)
+{
+    id<MTLDrawable> drawable = swapChainMT.GetMTKView().currentDrawable;
+    for (const QueuedDrawable& d : drawables_)
+    {
+        if (d.drawable == drawable)
             return;
     }
-    drawables_.push_back(drawable);
+    drawables_.push_back(QueuedDrawable{ drawable, &swapChainMT });
 }
 
 void MTDirectCommandBuffer::PresentDrawables()
 {
-    for (id<MTLDrawable> d : drawables_)
-        [cmdBuffer_ presentDrawable:d];
+    for (const QueuedDrawable& d : drawables_)
+        d.swapChain->PresentDrawable(cmdBuffer_, d.drawable);
     drawables_.clear();
 }
 
@@ -1105,8 +1387,8 @@ void MTDirectCommandBuffer::FillBufferByte1(MTBuffer& bufferMT, const NSRange& r
 void MTDirectCommandBuffer::FillBufferByte4(MTBuffer& bufferMT, const NSRange& range, std::uint32_t value)
 {
     /* Use emulated fill command if buffer range is small enough to avoid having both a blit and compute encoder */
-    if (range.length > g_minFillBufferForKernel)
-        FillBufferByte4Accelerated(bufferMT, range, value);
+    if (range.length > g_minFillBufferForKernel || IsKernelPreferredOverBlit(range.location, range.length))
+        FillBufferWideAccelerated(bufferMT, range, &value, sizeof(value));
     else
         FillBufferByte4Emulated(bufferMT, range, value);
 }
@@ -1121,28 +1403,64 @@ void MTDirectCommandBuffer::FillBufferByte4Emulated(MTBuffer& bufferMT, const NS
     UpdateBuffer(bufferMT, range.location, localBuffer, range.length);
 }
 
-//TODO: manage binding of compute PSO in MTCommandContext
-void MTDirectCommandBuffer::FillBufferByte4Accelerated(MTBuffer& bufferMT, const NSRange& range, std::uint32_t value)
+void MTDirectCommandBuffer::FillBufferWideAccelerated(MTBuffer& bufferMT, const NSRange& range, const void* pattern, std::uint32_t patternSize)
 {
     context_.PauseRenderEncoder();
     {
         auto computeEncoder = context_.BindComputeEncoder();
 
         /* Bind compute PSO with kernel to fill buffer */
-        id<MTLComputePipelineState> pso = MTBuiltinPSOFactory::Get().GetComputePSO(MTBuiltinComputePSO::FillBufferByte4);
+        id<MTLComputePipelineState> pso = MTBuiltinPSOFactory::Get().GetComputePSO(MTBuiltinComputePSO::FillBufferWide);
         [computeEncoder setComputePipelineState:pso];
 
-        /* Bind destination buffer range and store clear value as input constant buffer */
+        /* Bind destination buffer range and store fill pattern as input constant buffer (see FillParams in FillBufferWide.metal) */
+        std::uint32_t params[8] = {};
+        ::memcpy(params, pattern, patternSize);
+        params[4] = patternSize / sizeof(std::uint32_t);
+        params[5] = static_cast<std::uint32_t>(range.length / sizeof(std::uint32_t));
         [computeEncoder setBuffer:bufferMT.GetNative() offset:range.location atIndex:0];
-        [computeEncoder setBytes:&value length:sizeof(value) atIndex:1];
+        [computeEncoder setBytes:params length:sizeof(params) atIndex:1];
+
+        /* Dispatch compute kernels; each thread fills four values */
+        DispatchThreads1D(computeEncoder, pso, (params[5] + 3) / 4);
+
+        /* Builtin kernel has overridden the compute PSO and buffer slots of the current encoder */
+        context_.InvalidateComputeEncoderState();
+    }
+    context_.ResumeRenderEncoder();
+}
+
+void MTDirectCommandBuffer::CopyBufferAccelerated(MTBuffer& dstBufferMT, NSUInteger dstOffset, MTBuffer& srcBufferMT, NSUInteger srcOffset, NSUInteger size)
+{
+    context_.PauseRenderEncoder();
+    {
+        auto computeEncoder = context_.BindComputeEncoder();
+
+        /* Bind compute PSO with kernel to copy buffer */
+        id<MTLComputePipelineState> pso = MTBuiltinPSOFactory::Get().GetComputePSO(MTBuiltinComputePSO::CopyBufferStrided);
+        [computeEncoder setComputePipelineState:pso];
+
+        /* Copy the whole range as one row */
+        const std::uint32_t numValues = static_cast<std::uint32_t>(size / sizeof(std::uint32_t));
+        const std::uint32_t params[4] = { numValues, 1u, numValues, numValues };
+        [computeEncoder setBuffer:dstBufferMT.GetNative() offset:dstOffset atIndex:0];
+        [computeEncoder setBuffer:srcBufferMT.GetNative() offset:srcOffset atIndex:1];
+        [computeEncoder setBytes:params length:sizeof(params) atIndex:2];
 
-        /* Dispatch compute kernels */
-        const NSUInteger numValues = range.length / sizeof(std::uint32_t);
         DispatchThreads1D(computeEncoder, pso, numValues);
+
+        /* Builtin kernel has overridden the compute PSO and buffer slots of the current encoder */
+        context_.InvalidateComputeEncoderState();
     }
     context_.ResumeRenderEncoder();
 }
 
+bool MTDirectCommandBuffer::IsKernelPreferredOverBlit(NSUInteger offset, NSUInteger size) const
+{
+    /* Builtin kernels operate on 32-bit values only */
+    return (context_.GetComputeEncoder() != nil && size > 0 && (offset % sizeof(std::uint32_t)) == 0 && (size % sizeof(std::uint32_t)) == 0);
+}
+
 id<MTLRenderCommandEncoder> MTDirectCommandBuffer::DispatchTessellationAndGetRenderEncoder(NSUInteger numPatches, NSUInteger numInstances)
 {
     /* Ensure internal tessellation factor buffer is large enough */
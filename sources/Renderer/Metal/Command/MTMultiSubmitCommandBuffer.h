@@ -12,13 +12,15 @@
 #include "MTCommandBuffer.h"
 #include "MTCommandOpcode.h"
 #include "../../VirtualCommandBuffer.h"
+#include <vector>
 
 
 namespace LLGL
 {
 
 
-using MTVirtualCommandBuffer = VirtualCommandBuffer<MTOpcode>;
+// Metal commands consist mostly of object references and NSUInteger fields, so align all commands to pointer size.
+using MTVirtualCommandBuffer = VirtualCommandBuffer<MTOpcode, sizeof(void*)>;
 
 class MTMultiSubmitCommandBuffer final : public MTCommandBuffer
 {
@@ -43,6 +45,21 @@ class MTMultiSubmitCommandBuffer final : public MTCommandBuffer
             return buffer_;
         }
 
+    private:
+
+        // Draw command that is deferred until it can be encoded into an indirect command buffer.
+        struct MTDeferredDraw
+        {
+            MTLPrimitiveType    primitiveType;
+            NSUInteger          start;          // Vertex start or index buffer offset.
+            NSUInteger          count;          // Number of vertices or indices.
+            MTLIndexType        indexType;
+            id<MTLBuffer>       indexBuffer;    // Null for non-indexed draw commands.
+            NSUInteger          instanceCount;
+            NSInteger           baseVertex;
+            NSUInteger          baseInstance;
+        };
+
     private:
 
         void BindRenderEncoderForTessellation(NSUInteger numPatches, NSUInteger numInstances = 1);
@@ -50,15 +67,32 @@ class MTMultiSubmitCommandBuffer final : public MTCommandBuffer
         void BindComputeEncoder();
         void BindBlitEncoder();
 
-        void QueueDrawable(MTKView* view);
+        void QueueDrawable(MTSwapChain* swapChainMT);
         void PresentDrawables();
 
         void DispatchThreads1D(id<MTLComputePipelineState> computePSO, NSUInteger numThreads);
 
+        // Encodes the builtin kernel to fill the specified buffer range with a pattern of 4, 8, or 16 bytes.
+        void FillBufferWide(MTBuffer& bufferMT, const NSRange& range, const void* pattern, std::uint32_t patternSize);
+
         void GenerateMipmapsForTexture(id<MTLTexture> texture);
 
         void SetNativeVertexBuffers(NSUInteger count, const id<MTLBuffer>* buffers, const NSUInteger* offsets);
 
+        void DrawNativePrimitives(NSUInteger vertexStart, NSUInteger vertexCount, NSUInteger instanceCount, NSUInteger baseInstance);
+        void DrawNativeIndexedPrimitives(NSUInteger indexCount, NSUInteger indexBufferOffset, NSUInteger instanceCount, NSInteger baseVertex, NSUInteger baseInstance);
+
+        // Returns true if draw commands can be deferred to be encoded into an indirect command buffer with the currently bound PSO.
+        bool CanDeferDrawCommands() const;
+
+        /*
+        Encodes all deferred draw commands. Runs of at least 'g_minIndirectDrawCommands' draw commands
+        are encoded once into an indirect command buffer, all others are allocated as individual commands.
+        */
+        void FlushDeferredDraws();
+        bool EncodeIndirectCommandBuffer(const std::vector<MTDeferredDraw>& draws);
+        void EncodeDirectDraws(const std::vector<MTDeferredDraw>& draws);
+
         void FlushContext();
 
         void ReleaseIntermediateResources();
@@ -76,9 +110,12 @@ class MTMultiSubmitCommandBuffer final : public MTCommandBuffer
         MTOpcode                        lastOpcode_             = MTOpcodeNop;
 
         MTEncoderState                  encoderState_           = MTEncoderState::None;
-        SmallVector<MTKView*, 2>        views_;
+        SmallVector<MTSwapChain*, 2>    swapChains_;
         SmallVector<id<MTLTexture>, 2>  intermediateTextures_;
 
+        std::vector<MTDeferredDraw>                     deferredDraws_;
+        std::vector<id<MTLIndirectCommandBuffer>>       indirectCommandBuffers_;
+
         bool                            isInsideRenderPass_     = false;
 
 };
@@ -15,6 +15,7 @@
 #include "../RenderState/MTGraphicsPSO.h"
 #include "../RenderState/MTComputePSO.h"
 #include "../RenderState/MTResourceHeap.h"
+#include "../RenderState/MTQueryHeap.h"
 #include "../RenderState/MTBuiltinPSOFactory.h"
 #include "../RenderState/MTDescriptorCache.h"
 #include "../RenderState/MTConstantsCache.h"
@@ -23,6 +24,8 @@
 #include "../Texture/MTSampler.h"
 #include "../Texture/MTRenderTarget.h"
 #include "../../CheckedCast.h"
+#include "../../BufferUtils.h"
+#include "../../FrameCounters.h"
 #include "../../../Core/Exception.h"
 #include <LLGL/TypeInfo.h>
 #include <LLGL/Utils/ForRange.h>
@@ -34,8 +37,11 @@ namespace LLGL
 {
 
 
+// Minimum number of consecutive draw commands that are encoded into an indirect command buffer.
+static constexpr std::size_t g_minIndirectDrawCommands = 8;
+
 MTMultiSubmitCommandBuffer::MTMultiSubmitCommandBuffer(id<MTLDevice> device, const CommandBufferDescriptor& desc) :
-    MTCommandBuffer { device, desc.flags }
+    MTCommandBuffer { device, desc }
 {
 }
 
@@ -48,10 +54,14 @@ MTMultiSubmitCommandBuffer::~MTMultiSubmitCommandBuffer()
 
 void MTMultiSubmitCommandBuffer::Begin()
 {
+    LLGL_FRAME_COUNTER_BEGIN();
+
     buffer_.Clear();
+    deferredDraws_.clear();
     lastOpcode_ = MTOpcodeNop;
     encoderState_ = MTEncoderState::None;
     ResetRenderStates();
+    ResetStagingPool();
     ReleaseIntermediateResources();
 }
 
@@ -73,10 +83,16 @@ void MTMultiSubmitCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
             {
                 cmd->commandBuffer = LLGL_CAST(MTMultiSubmitCommandBuffer*, &commandBufferMT);
             }
+            LLGL_FRAME_COUNTER_EXECUTE(commandBufferMT.GetFrameCounters());
         }
     }
 }
 
+void MTMultiSubmitCommandBuffer::TrimMemory()
+{
+    TrimStagingPool();
+}
+
 /* ----- Blitting ----- */
 
 void MTMultiSubmitCommandBuffer::UpdateBuffer(
@@ -85,6 +101,8 @@ void MTMultiSubmitCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferUpdates);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
 
     /* Copy data to staging buffer */
@@ -112,6 +130,8 @@ void MTMultiSubmitCommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
 
@@ -134,6 +154,8 @@ void MTMultiSubmitCommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
 
@@ -167,13 +189,23 @@ void MTMultiSubmitCommandBuffer::CopyBufferFromTexture(
     }
 }
 
+// Returns the buffer range for a fill command.
+static NSRange GetBufferFillRange(MTBuffer& bufferMT, std::uint64_t offset, std::uint64_t fillSize)
+{
+    if (fillSize == Constants::wholeSize)
+        return NSMakeRange(0, [bufferMT.GetNative() length]);
+    else
+        return NSMakeRange(static_cast<NSUInteger>(offset), static_cast<NSUInteger>(fillSize));
+}
+
 void MTMultiSubmitCommandBuffer::FillBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
-#if 0 //TODO
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
     if (fillSize == 0)
         return;
 
@@ -187,27 +219,43 @@ void MTMultiSubmitCommandBuffer::FillBuffer(
         ((value >>  8) & 0x000000FF) == (value & 0x000000FF)
     );
 
-    /* Determine buffer range for fill command */
-    NSRange range;
-    if (fillSize == Constants::wholeSize)
+    const NSRange range = GetBufferFillRange(dstBufferMT, dstOffset, fillSize);
+
+    /* Fill with native blit command if all four bytes are equal, otherwise use builtin compute kernel */
+    if (valueBytesAreEqual)
     {
-        NSUInteger bufferSize = [dstBufferMT.GetNative() length];
-        range = NSMakeRange(0, bufferSize);
+        BindBlitEncoder();
+        auto cmd = AllocCommand<MTCmdFillBuffer>(MTOpcodeFillBuffer);
+        {
+            cmd->buffer = dstBufferMT.GetNative();
+            cmd->range  = range;
+            cmd->value  = static_cast<std::uint8_t>(value & 0x000000FF);
+        }
     }
     else
-    {
-        range = NSMakeRange(
-            static_cast<NSUInteger>(dstOffset),
-            static_cast<NSUInteger>(fillSize)
-        );
-    }
+        FillBufferWide(dstBufferMT, range, &value, sizeof(value));
+}
 
-    /* Fill with native command if all four bytes are equal, otherwise use blit and comput commands */
-    if (valueBytesAreEqual)
-        FillBufferByte1(dstBufferMT, range, static_cast<std::uint8_t>(value & 0x000000FF));
-    else
-        FillBufferByte4(dstBufferMT, range, value);
-#endif
+void MTMultiSubmitCommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    /* Forward patterns of a single 32-bit value to the default fill command */
+    std::uint32_t value = 0;
+    if (GetUniformFillPatternValue(pattern, patternSize, value))
+        return FillBuffer(dstBuffer, dstOffset, value, fillSize);
+
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
+    if (fillSize == 0)
+        return;
+
+    /* Always fill wide patterns with the builtin kernel, since the blit encoder can only fill single bytes */
+    auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
+    FillBufferWide(dstBufferMT, GetBufferFillRange(dstBufferMT, dstOffset, fillSize), pattern, patternSize);
 }
 
 void MTMultiSubmitCommandBuffer::CopyTexture(
@@ -217,6 +265,8 @@ void MTMultiSubmitCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
     auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
 
@@ -250,6 +300,8 @@ void MTMultiSubmitCommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
     auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
 
@@ -288,6 +340,8 @@ void MTMultiSubmitCommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     MTKView* drawableView = GetCurrentDrawableView();
     if (drawableView == nil)
         return /*No drawable view*/;
@@ -331,12 +385,16 @@ void MTMultiSubmitCommandBuffer::CopyTextureFromFramebuffer(
 
 void MTMultiSubmitCommandBuffer::GenerateMips(Texture& texture)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     GenerateMipmapsForTexture(textureMT.GetNative());
 }
 
 void MTMultiSubmitCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     if (subresource.numMipLevels > 1)
     {
@@ -347,6 +405,11 @@ void MTMultiSubmitCommandBuffer::GenerateMips(Texture& texture, const TextureSub
     }
 }
 
+void MTMultiSubmitCommandBuffer::CompressTexture(Texture& /*dstTexture*/, Texture& /*srcTexture*/, const TextureSubresource& /*subresource*/)
+{
+    // dummy
+}
+
 /* ----- Viewport and Scissor ----- */
 
 void MTMultiSubmitCommandBuffer::SetViewport(const Viewport& viewport)
@@ -392,6 +455,8 @@ void MTMultiSubmitCommandBuffer::SetNativeVertexBuffers(NSUInteger count, const
 
 void MTMultiSubmitCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     id<MTLBuffer> bufferId = bufferMT.GetNative();
     const NSUInteger bufferOffset = 0;
@@ -400,6 +465,8 @@ void MTMultiSubmitCommandBuffer::SetVertexBuffer(Buffer& buffer)
 
 void MTMultiSubmitCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferArrayMT = LLGL_CAST(MTBufferArray&, bufferArray);
     SetNativeVertexBuffers(
         static_cast<NSUInteger>(bufferArrayMT.GetIDArray().size()),
@@ -412,6 +479,8 @@ void MTMultiSubmitCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void MTMultiSubmitCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
+    LLGL_FRAME_COUNTER_INC(resourceHeapBindings);
+
     MTPipelineState* boundPipelineState = GetBoundPipelineState();
     if (boundPipelineState == nullptr)
         return /*Invalid state*/;
@@ -460,6 +529,8 @@ void MTMultiSubmitCommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       /*swapBufferIndex*/)
 {
+    LLGL_FRAME_COUNTER_INC(renderPassSections);
+
     auto AllocCommandBindRenderTarget = [this, numClearValues, clearValues, &renderTarget, renderPass](MTOpcode opcode) -> void
     {
         /* Only allocate payload for clear values if a render pass was specified */
@@ -488,7 +559,7 @@ void MTMultiSubmitCommandBuffer::BeginRenderPass(
         /* Put current drawable into queue */
         auto& swapChainMT = LLGL_CAST(MTSwapChain&, renderTarget);
         SetSwapChain(&swapChainMT);
-        QueueDrawable(swapChainMT.GetMTKView());
+        QueueDrawable(&swapChainMT);
         AllocCommandBindRenderTarget(MTOpcodeBindSwapChain);
     }
     else
@@ -508,6 +579,8 @@ void MTMultiSubmitCommandBuffer::EndRenderPass()
 //TODO: support clearing all active attachments at once
 void MTMultiSubmitCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     AttachmentClear attachmentClear;
     {
         attachmentClear.flags           = flags;
@@ -549,6 +622,8 @@ static void FillCmdClearRenderPass(MTCmdClearRenderPass* cmd, const AttachmentCl
 
 void MTMultiSubmitCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     if (!isInsideRenderPass_ || numAttachments == 0)
         return;
 
@@ -568,7 +643,9 @@ void MTMultiSubmitCommandBuffer::ClearAttachments(std::uint32_t numAttachments,
 
 void MTMultiSubmitCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    auto& pipelineStateMT = LLGL_CAST(MTPipelineState&, pipelineState);
+    /* Native PSOs are created in the background, so wait until the PSO is ready to be encoded or use its fallback */
+    auto& pipelineStateMT = LLGL_CAST(MTPipelineState&, pipelineState).GetReadyOrFallback();
+
     if (pipelineStateMT.IsGraphicsPSO())
     {
         /* Set graphics pipeline with encoder scheduler */
@@ -609,16 +686,28 @@ void MTMultiSubmitCommandBuffer::SetStencilReference(std::uint32_t reference, co
 
 void MTMultiSubmitCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //todo
+    LLGL_FRAME_COUNTER_INC(querySections);
+
+    auto cmd = AllocCommand<MTCmdQuery>(MTOpcodeBeginQuery);
+    {
+        cmd->queryHeap  = LLGL_CAST(MTQueryHeap*, &queryHeap);
+        cmd->query      = query;
+    }
 }
 
 void MTMultiSubmitCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //todo
+    auto cmd = AllocCommand<MTCmdQuery>(MTOpcodeEndQuery);
+    {
+        cmd->queryHeap  = LLGL_CAST(MTQueryHeap*, &queryHeap);
+        cmd->query      = query;
+    }
 }
 
 void MTMultiSubmitCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_FRAME_COUNTER_INC(renderConditionSections);
+
     //todo
 }
 
@@ -631,6 +720,8 @@ void MTMultiSubmitCommandBuffer::EndRenderCondition()
 
 void MTMultiSubmitCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
+    LLGL_FRAME_COUNTER_INC(streamOutputSections);
+
     //todo
 }
 
@@ -643,6 +734,8 @@ void MTMultiSubmitCommandBuffer::EndStreamOutput()
 
 void MTMultiSubmitCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
     {
@@ -662,19 +755,14 @@ void MTMultiSubmitCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t f
     else
     {
         BindRenderEncoder();
-        auto cmd = AllocCommand<MTCmdDrawPrimitives>(MTOpcodeDrawPrimitives);
-        {
-            cmd->primitiveType  = GetPrimitiveType();
-            cmd->vertexStart    = static_cast<NSUInteger>(firstVertex);
-            cmd->vertexCount    = static_cast<NSUInteger>(numVertices);
-            cmd->instanceCount  = 1;
-            cmd->baseInstance   = 0;
-        }
+        DrawNativePrimitives(static_cast<NSUInteger>(firstVertex), static_cast<NSUInteger>(numVertices), 1, 0);
     }
 }
 
 void MTMultiSubmitCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
     {
@@ -696,32 +784,28 @@ void MTMultiSubmitCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint
     else
     {
         BindRenderEncoder();
-        auto cmd = AllocCommand<MTCmdDrawIndexedPrimitives>(MTOpcodeDrawIndexedPrimitives);
-        {
-            cmd->primitiveType      = GetPrimitiveType();
-            cmd->indexCount         = static_cast<NSUInteger>(numIndices);
-            cmd->indexType          = GetIndexType();
-            cmd->indexBuffer        = GetIndexBuffer();
-            cmd->indexBufferOffset  = GetIndexBufferOffset(static_cast<NSUInteger>(firstIndex));
-            cmd->instanceCount      = 1;
-            cmd->baseVertex         = 0;
-            cmd->baseInstance       = 0;
-        }
+        DrawNativeIndexedPrimitives(static_cast<NSUInteger>(numIndices), GetIndexBufferOffset(static_cast<NSUInteger>(firstIndex)), 1, 0, 0);
     }
 }
 
 void MTMultiSubmitCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     MTMultiSubmitCommandBuffer::DrawIndexedInstanced(numIndices, /*numInstances:*/ 1, firstIndex, vertexOffset, /*firstInstance:*/ 0);
 }
 
 void MTMultiSubmitCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     MTMultiSubmitCommandBuffer::DrawInstanced(numVertices, firstVertex, numInstances, /*firstInstance:*/ 0);
 }
 
 void MTMultiSubmitCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
     {
@@ -741,29 +825,33 @@ void MTMultiSubmitCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::u
     else
     {
         BindRenderEncoder();
-        auto cmd = AllocCommand<MTCmdDrawPrimitives>(MTOpcodeDrawPrimitives);
-        {
-            cmd->primitiveType  = GetPrimitiveType();
-            cmd->vertexStart    = static_cast<NSUInteger>(firstVertex);
-            cmd->vertexCount    = static_cast<NSUInteger>(numVertices);
-            cmd->instanceCount  = static_cast<NSUInteger>(numInstances);
-            cmd->baseInstance   = static_cast<NSUInteger>(firstInstance);
-        }
+        DrawNativePrimitives(
+            static_cast<NSUInteger>(firstVertex),
+            static_cast<NSUInteger>(numVertices),
+            static_cast<NSUInteger>(numInstances),
+            static_cast<NSUInteger>(firstInstance)
+        );
     }
 }
 
 void MTMultiSubmitCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     MTMultiSubmitCommandBuffer::DrawIndexedInstanced(numIndices, numInstances, firstIndex, /*vertexOffset:*/ 0, /*firstInstance:*/ 0);
 }
 
 void MTMultiSubmitCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     MTMultiSubmitCommandBuffer::DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, /*firstInstance:*/ 0);
 }
 
 void MTMultiSubmitCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
     if (numPatchControlPoints > 0)
     {
@@ -785,17 +873,13 @@ void MTMultiSubmitCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices,
     else
     {
         BindRenderEncoder();
-        auto cmd = AllocCommand<MTCmdDrawIndexedPrimitives>(MTOpcodeDrawIndexedPrimitives);
-        {
-            cmd->primitiveType      = GetPrimitiveType();
-            cmd->indexCount         = static_cast<NSUInteger>(numIndices);
-            cmd->indexType          = GetIndexType();
-            cmd->indexBuffer        = GetIndexBuffer();
-            cmd->indexBufferOffset  = GetIndexBufferOffset(static_cast<NSUInteger>(firstIndex));
-            cmd->instanceCount      = static_cast<NSUInteger>(numInstances);
-            cmd->baseVertex         = static_cast<NSUInteger>(vertexOffset);
-            cmd->baseInstance       = static_cast<NSUInteger>(firstInstance);
-        }
+        DrawNativeIndexedPrimitives(
+            static_cast<NSUInteger>(numIndices),
+            GetIndexBufferOffset(static_cast<NSUInteger>(firstIndex)),
+            static_cast<NSUInteger>(numInstances),
+            static_cast<NSInteger>(vertexOffset),
+            static_cast<NSUInteger>(firstInstance)
+        );
     }
 }
 
@@ -810,6 +894,8 @@ static void TrapIndirectPatchesNotSupported()
 //TODO: support patches with indirect arguments
 void MTMultiSubmitCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
 #if 0 //TODO
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
@@ -842,6 +928,8 @@ void MTMultiSubmitCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offs
 //TODO: support patches with indirect arguments
 void MTMultiSubmitCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
 #if 0 //TODO
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
@@ -882,6 +970,8 @@ void MTMultiSubmitCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offs
 //TODO: support patches with indirect arguments
 void MTMultiSubmitCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
 #if 0 //TODO
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
@@ -919,6 +1009,8 @@ void MTMultiSubmitCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64
 //TODO: support patches with indirect arguments
 void MTMultiSubmitCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
 #if 0 //TODO
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     const NSUInteger numPatchControlPoints = GetNumPatchControlPoints();
@@ -961,10 +1053,77 @@ void MTMultiSubmitCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64
 #endif
 }
 
+void MTMultiSubmitCommandBuffer::DrawIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void MTMultiSubmitCommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void MTMultiSubmitCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    BindRenderEncoder();
+    auto cmd = AllocCommand<MTCmdDrawMeshThreadgroups>(MTOpcodeDrawMeshThreadgroups);
+    {
+        cmd->threadgroups                   = MTLSizeMake(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+        cmd->threadsPerObjectThreadgroup    = GetThreadsPerObjectThreadgroup();
+        cmd->threadsPerMeshThreadgroup      = GetThreadsPerMeshThreadgroup();
+    }
+}
+
+void MTMultiSubmitCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    BindRenderEncoder();
+    while (numCommands-- > 0)
+    {
+        auto cmd = AllocCommand<MTCmdDrawMeshThreadgroupsIndirect>(MTOpcodeDrawMeshThreadgroupsIndirect);
+        {
+            cmd->indirectBuffer                 = bufferMT.GetNative();
+            cmd->indirectBufferOffset           = static_cast<NSUInteger>(offset);
+            cmd->threadsPerObjectThreadgroup    = GetThreadsPerObjectThreadgroup();
+            cmd->threadsPerMeshThreadgroup      = GetThreadsPerMeshThreadgroup();
+        }
+        offset += stride;
+    }
+}
+
+void MTMultiSubmitCommandBuffer::DrawStreamOutput()
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
 /* ----- Compute ----- */
 
 void MTMultiSubmitCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     BindComputeEncoder();
     auto cmd = AllocCommand<MTCmdDispatchThreadgroups>(MTOpcodeDispatchThreadgroups);
     {
@@ -975,6 +1134,8 @@ void MTMultiSubmitCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uin
 
 void MTMultiSubmitCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     BindComputeEncoder();
     auto cmd = AllocCommand<MTCmdDispatchThreadgroupsIndirect>(MTOpcodeDispatchThreadgroupsIndirect);
@@ -985,6 +1146,33 @@ void MTMultiSubmitCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t
     }
 }
 
+void MTMultiSubmitCommandBuffer::CompactIndirectArguments(
+    Buffer&         /*dstBuffer*/,
+    std::uint64_t   /*dstOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    Buffer&         /*srcBuffer*/,
+    std::uint64_t   /*srcOffset*/,
+    Buffer&         /*visibilityBuffer*/,
+    std::uint64_t   /*visibilityOffset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    // dummy
+}
+
+/* ----- Ray Tracing ----- */
+
+void MTMultiSubmitCommandBuffer::BuildAccelerationStructure(AccelerationStructure& /*accelerationStructure*/, const AccelerationStructureBuildDescriptor& /*buildDesc*/)
+{
+    // dummy
+}
+
+void MTMultiSubmitCommandBuffer::CopyAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/, bool /*compact*/)
+{
+    // dummy
+}
+
 /* ----- Debugging ----- */
 
 void MTMultiSubmitCommandBuffer::PushDebugGroup(const char* name)
@@ -1033,81 +1221,46 @@ bool MTMultiSubmitCommandBuffer::IsMultiSubmitCmdBuffer() const
  * ======= Private: =======
  */
 
-void MTMultiSubmitCommandBuffer::QueueDrawable(MTKView* view)
+void MTMultiSubmitCommandBuffer::QueueDrawable(MTSwapChain* swapChainMT)
 {
-    for (MTKView* v : views_)
+    for (MTSwapChain* s : swapChains_)
     {
-        if (v == view)
+        if (s == swapChainMT)
             return;
     }
-    views_.push_back(view);
+    swapChains_.push_back(swapChainMT);
 }
 
 void MTMultiSubmitCommandBuffer::PresentDrawables()
 {
-    if (!views_.empty())
+    if (!swapChains_.empty())
     {
-        auto cmd = AllocCommand<MTCmdPresentDrawables>(MTOpcodePresentDrawables, sizeof(id)*views_.size());
+        auto cmd = AllocCommand<MTCmdPresentDrawables>(MTOpcodePresentDrawables, sizeof(MTSwapChain*)*swapChains_.size());
         {
-            cmd->count = static_cast<NSUInteger>(views_.size());
-            ::memcpy(cmd + 1, views_.data(), sizeof(id)*views_.size());
+            cmd->count = static_cast<NSUInteger>(swapChains_.size());
+            ::memcpy(cmd + 1, swapChains_.data(), sizeof(MTSwapChain*)*swapChains_.size());
         }
     }
-    views_.clear();
+    swapChains_.clear();
 }
 
-#if 0 //TODO
-void MTMultiSubmitCommandBuffer::FillBufferByte1(MTBuffer& bufferMT, const NSRange& range, std::uint8_t value)
+void MTMultiSubmitCommandBuffer::FillBufferWide(MTBuffer& bufferMT, const NSRange& range, const void* pattern, std::uint32_t patternSize)
 {
-    context_.PauseRenderEncoder();
-    {
-        auto blitEncoder = context_.BindBlitEncoder();
-        [blitEncoder fillBuffer:bufferMT.GetNative() range:range value:value];
-    }
-    context_.ResumeRenderEncoder();
-}
+    id<MTLComputePipelineState> pso = MTBuiltinPSOFactory::Get().GetComputePSO(MTBuiltinComputePSO::FillBufferWide);
 
-void MTMultiSubmitCommandBuffer::FillBufferByte4(MTBuffer& bufferMT, const NSRange& range, std::uint32_t value)
-{
-    /* Use emulated fill command if buffer range is small enough to avoid having both a blit and compute encoder */
-    if (range.length > g_minFillBufferForKernel)
-        FillBufferByte4Accelerated(bufferMT, range, value);
-    else
-        FillBufferByte4Emulated(bufferMT, range, value);
-}
-
-void MTMultiSubmitCommandBuffer::FillBufferByte4Emulated(MTBuffer& bufferMT, const NSRange& range, std::uint32_t value)
-{
-    /* Copy value into stack local buffer */
-    std::uint32_t localBuffer[g_minFillBufferForKernel / sizeof(std::uint32_t)];
-    std::fill(std::begin(localBuffer), std::end(localBuffer), value);
-
-    /* Write clear value into first range of destination buffer */
-    UpdateBuffer(bufferMT, range.location, localBuffer, range.length);
-}
-
-//TODO: manage binding of compute PSO in MTCommandContext
-void MTMultiSubmitCommandBuffer::FillBufferByte4Accelerated(MTBuffer& bufferMT, const NSRange& range, std::uint32_t value)
-{
-    context_.PauseRenderEncoder();
+    BindComputeEncoder();
+    auto cmd = AllocCommand<MTCmdFillBufferWide>(MTOpcodeFillBufferWide);
     {
-        auto computeEncoder = context_.BindComputeEncoder();
-
-        /* Bind compute PSO with kernel to fill buffer */
-        id<MTLComputePipelineState> pso = MTBuiltinPSOFactory::Get().GetComputePSO(MTBuiltinComputePSO::FillBufferByte4);
-        [computeEncoder setComputePipelineState:pso];
-
-        /* Bind destination buffer range and store clear value as input constant buffer */
-        [computeEncoder setBuffer:bufferMT.GetNative() offset:range.location atIndex:0];
-        [computeEncoder setBytes:&value length:sizeof(value) atIndex:1];
-
-        /* Dispatch compute kernels */
-        const NSUInteger numValues = range.length / sizeof(std::uint32_t);
-        DispatchThreads1D(computeEncoder, pso, numValues);
+        cmd->buffer             = bufferMT.GetNative();
+        cmd->offset             = range.location;
+        ::memset(cmd->params, 0, sizeof(cmd->params));
+        ::memcpy(cmd->params, pattern, patternSize);
+        cmd->params[4]          = patternSize / sizeof(std::uint32_t);
+        cmd->params[5]          = static_cast<std::uint32_t>(range.length / sizeof(std::uint32_t));
+        cmd->numThreads         = (cmd->params[5] + 3) / 4;
+        cmd->maxLocalThreads    = GetMaxLocalThreads(pso);
     }
-    context_.ResumeRenderEncoder();
 }
-#endif //TODO
 
 void MTMultiSubmitCommandBuffer::BindRenderEncoderForTessellation(NSUInteger numPatches, NSUInteger numInstances)
 {
@@ -1217,6 +1370,200 @@ void MTMultiSubmitCommandBuffer::GenerateMipmapsForTexture(id<MTLTexture> textur
     }
 }
 
+void MTMultiSubmitCommandBuffer::DrawNativePrimitives(NSUInteger vertexStart, NSUInteger vertexCount, NSUInteger instanceCount, NSUInteger baseInstance)
+{
+    if (CanDeferDrawCommands())
+    {
+        MTDeferredDraw draw;
+        {
+            draw.primitiveType  = GetPrimitiveType();
+            draw.start          = vertexStart;
+            draw.count          = vertexCount;
+            draw.indexType      = MTLIndexTypeUInt32;
+            draw.indexBuffer    = nil;
+            draw.instanceCount  = instanceCount;
+            draw.baseVertex     = 0;
+            draw.baseInstance   = baseInstance;
+        }
+        deferredDraws_.push_back(draw);
+    }
+    else
+    {
+        auto cmd = AllocCommand<MTCmdDrawPrimitives>(MTOpcodeDrawPrimitives);
+        {
+            cmd->primitiveType  = GetPrimitiveType();
+            cmd->vertexStart    = vertexStart;
+            cmd->vertexCount    = vertexCount;
+            cmd->instanceCount  = instanceCount;
+            cmd->baseInstance   = baseInstance;
+        }
+    }
+}
+
+void MTMultiSubmitCommandBuffer::DrawNativeIndexedPrimitives(NSUInteger indexCount, NSUInteger indexBufferOffset, NSUInteger instanceCount, NSInteger baseVertex, NSUInteger baseInstance)
+{
+    if (CanDeferDrawCommands())
+    {
+        MTDeferredDraw draw;
+        {
+            draw.primitiveType  = GetPrimitiveType();
+            draw.start          = indexBufferOffset;
+            draw.count          = indexCount;
+            draw.indexType      = GetIndexType();
+            draw.indexBuffer    = GetIndexBuffer();
+            draw.instanceCount  = instanceCount;
+            draw.baseVertex     = baseVertex;
+            draw.baseInstance   = baseInstance;
+        }
+        deferredDraws_.push_back(draw);
+    }
+    else
+    {
+        auto cmd = AllocCommand<MTCmdDrawIndexedPrimitives>(MTOpcodeDrawIndexedPrimitives);
+        {
+            cmd->primitiveType      = GetPrimitiveType();
+            cmd->indexCount         = indexCount;
+            cmd->indexType          = GetIndexType();
+            cmd->indexBuffer        = GetIndexBuffer();
+            cmd->indexBufferOffset  = indexBufferOffset;
+            cmd->instanceCount      = instanceCount;
+            cmd->baseVertex         = static_cast<NSUInteger>(baseVertex);
+            cmd->baseInstance       = baseInstance;
+        }
+    }
+}
+
+bool MTMultiSubmitCommandBuffer::CanDeferDrawCommands() const
+{
+    if (!isInsideRenderPass_)
+        return false;
+    if (MTPipelineState* pipelineState = GetBoundPipelineState())
+    {
+        if (pipelineState->IsGraphicsPSO())
+            return static_cast<const MTGraphicsPSO*>(pipelineState)->SupportsIndirectCommandBuffers();
+    }
+    return false;
+}
+
+void MTMultiSubmitCommandBuffer::FlushDeferredDraws()
+{
+    /* Take deferred draws out of the list, since encoding them allocates new commands */
+    std::vector<MTDeferredDraw> draws;
+    draws.swap(deferredDraws_);
+
+    if (!(draws.size() >= g_minIndirectDrawCommands && EncodeIndirectCommandBuffer(draws)))
+        EncodeDirectDraws(draws);
+
+    /* Keep the container capacity for the next run of draw commands */
+    draws.clear();
+    deferredDraws_.swap(draws);
+}
+
+bool MTMultiSubmitCommandBuffer::EncodeIndirectCommandBuffer(const std::vector<MTDeferredDraw>& draws)
+{
+    if (@available(macOS 10.14, iOS 12.0, *))
+    {
+        /* Create indirect command buffer that inherits the PSO and all buffers from the render encoder */
+        MTLIndirectCommandBufferDescriptor* icbDesc = [[MTLIndirectCommandBufferDescriptor alloc] init];
+        {
+            icbDesc.commandTypes                = (MTLIndirectCommandTypeDraw | MTLIndirectCommandTypeDrawIndexed);
+            icbDesc.inheritPipelineState        = YES;
+            icbDesc.inheritBuffers              = YES;
+            icbDesc.maxVertexBufferBindCount    = 0;
+            icbDesc.maxFragmentBufferBindCount  = 0;
+        }
+        id<MTLIndirectCommandBuffer> icb = [GetDevice()
+            newIndirectCommandBufferWithDescriptor: icbDesc
+            maxCommandCount:                        static_cast<NSUInteger>(draws.size())
+            options:                                0
+        ];
+        [icbDesc release];
+
+        if (icb == nil)
+            return false;
+
+        indirectCommandBuffers_.push_back(icb);
+
+        /* Encode draw commands once and gather all index buffers that are referenced by these commands */
+        SmallVector<id<MTLResource>, 4> indexBuffers;
+
+        for_range(i, draws.size())
+        {
+            const MTDeferredDraw& draw = draws[i];
+            id<MTLIndirectRenderCommand> icbCmd = [icb indirectRenderCommandAtIndex:i];
+            if (draw.indexBuffer != nil)
+            {
+                [icbCmd
+                    drawIndexedPrimitives:  draw.primitiveType
+                    indexCount:             draw.count
+                    indexType:              draw.indexType
+                    indexBuffer:            draw.indexBuffer
+                    indexBufferOffset:      draw.start
+                    instanceCount:          draw.instanceCount
+                    baseVertex:             draw.baseVertex
+                    baseInstance:           draw.baseInstance
+                ];
+                if (std::find(indexBuffers.begin(), indexBuffers.end(), draw.indexBuffer) == indexBuffers.end())
+                    indexBuffers.push_back(draw.indexBuffer);
+            }
+            else
+            {
+                [icbCmd
+                    drawPrimitives: draw.primitiveType
+                    vertexStart:    draw.start
+                    vertexCount:    draw.count
+                    instanceCount:  draw.instanceCount
+                    baseInstance:   draw.baseInstance
+                ];
+            }
+        }
+
+        /* Allocate command to execute the entire indirect command buffer */
+        auto cmd = AllocCommand<MTCmdExecuteIndirectCommands>(MTOpcodeExecuteIndirectCommands, sizeof(id)*indexBuffers.size());
+        {
+            cmd->indirectCommandBuffer  = icb;
+            cmd->numCommands            = static_cast<NSUInteger>(draws.size());
+            cmd->numResources           = static_cast<NSUInteger>(indexBuffers.size());
+            ::memcpy(cmd + 1, indexBuffers.data(), sizeof(id)*indexBuffers.size());
+        }
+
+        return true;
+    }
+    return false;
+}
+
+void MTMultiSubmitCommandBuffer::EncodeDirectDraws(const std::vector<MTDeferredDraw>& draws)
+{
+    for (const MTDeferredDraw& draw : draws)
+    {
+        if (draw.indexBuffer != nil)
+        {
+            auto cmd = AllocCommand<MTCmdDrawIndexedPrimitives>(MTOpcodeDrawIndexedPrimitives);
+            {
+                cmd->primitiveType      = draw.primitiveType;
+                cmd->indexCount         = draw.count;
+                cmd->indexType          = draw.indexType;
+                cmd->indexBuffer        = draw.indexBuffer;
+                cmd->indexBufferOffset  = draw.start;
+                cmd->instanceCount      = draw.instanceCount;
+                cmd->baseVertex         = static_cast<NSUInteger>(draw.baseVertex);
+                cmd->baseInstance       = draw.baseInstance;
+            }
+        }
+        else
+        {
+            auto cmd = AllocCommand<MTCmdDrawPrimitives>(MTOpcodeDrawPrimitives);
+            {
+                cmd->primitiveType  = draw.primitiveType;
+                cmd->vertexStart    = draw.start;
+                cmd->vertexCount    = draw.count;
+                cmd->instanceCount  = draw.instanceCount;
+                cmd->baseInstance   = draw.baseInstance;
+            }
+        }
+    }
+}
+
 void MTMultiSubmitCommandBuffer::FlushContext()
 {
     AllocOpcode(MTOpcodeFlush);
@@ -1227,10 +1574,18 @@ void MTMultiSubmitCommandBuffer::ReleaseIntermediateResources()
     for (id<MTLTexture> tex : intermediateTextures_)
         [tex release];
     intermediateTextures_.clear();
+
+    for (id<MTLIndirectCommandBuffer> icb : indirectCommandBuffers_)
+        [icb release];
+    indirectCommandBuffers_.clear();
 }
 
 void MTMultiSubmitCommandBuffer::AllocOpcode(const MTOpcode opcode)
 {
+    /* Any other command ends the current run of deferred draw commands */
+    if (!deferredDraws_.empty())
+        FlushDeferredDraws();
+
     /* Redundant single-opcode instructions can be ignored (such as MTOpcodeFlush) */
     if (lastOpcode_ != opcode)
     {
@@ -1242,6 +1597,8 @@ void MTMultiSubmitCommandBuffer::AllocOpcode(const MTOpcode opcode)
 template <typename TCommand>
 TCommand* MTMultiSubmitCommandBuffer::AllocCommand(const MTOpcode opcode, std::size_t payloadSize)
 {
+    if (!deferredDraws_.empty())
+        FlushDeferredDraws();
     lastOpcode_ = opcode;
     return buffer_.AllocCommand<TCommand>(opcode, payloadSize);
 }
@@ -11,6 +11,8 @@
 
 #import <Metal/Metal.h>
 
+#include <string>
+
 
 namespace LLGL
 {
@@ -22,6 +24,9 @@ void MTThrowIfFailed(NSError* error, const char* info);
 // Throws an std::runtime_error exception if 'error' is not null.
 void MTThrowIfCreateFailed(NSError* error, const char* interfaceName, const char* contextInfo = nullptr);
 
+// Returns the error message that MTThrowIfCreateFailed would throw. This is used when native objects are created asynchronously.
+std::string MTGetCreateFailedMessage(NSError* error, const char* interfaceName, const char* contextInfo = nullptr);
+
 // Converts the specified C++ boolean (bool) to an Objective-C boolean (BOOL).
 BOOL MTBoolean(bool value);
 
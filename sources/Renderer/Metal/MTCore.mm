@@ -28,23 +28,37 @@ void MTThrowIfFailed(NSError* error, const char* info)
     }
 }
 
-void MTThrowIfCreateFailed(NSError* error, const char* interfaceName, const char* contextInfo)
+static std::string GetCreateFailedInfo(const char* interfaceName, const char* contextInfo)
 {
-    if (error != nullptr)
+    std::string s;
     {
-        std::string s;
+        s = "failed to create instance of <";
+        s += interfaceName;
+        s += '>';
+        if (contextInfo != nullptr)
         {
-            s = "failed to create instance of <";
-            s += interfaceName;
-            s += '>';
-            if (contextInfo != nullptr)
-            {
-                s += ' ';
-                s += contextInfo;
-            }
+            s += ' ';
+            s += contextInfo;
         }
-        MTThrowIfFailed(error, s.c_str());
     }
+    return s;
+}
+
+void MTThrowIfCreateFailed(NSError* error, const char* interfaceName, const char* contextInfo)
+{
+    if (error != nullptr)
+        MTThrowIfFailed(error, GetCreateFailedInfo(interfaceName, contextInfo).c_str());
+}
+
+std::string MTGetCreateFailedMessage(NSError* error, const char* interfaceName, const char* contextInfo)
+{
+    std::string s = GetCreateFailedInfo(interfaceName, contextInfo);
+    if (error != nullptr)
+    {
+        s += ": ";
+        s += [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding];
+    }
+    return s;
 }
 
 BOOL MTBoolean(bool value)
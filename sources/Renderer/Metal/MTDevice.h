@@ -25,6 +25,9 @@ class MTDevice
         // Returns the most suitable sample count for the Metal device
         static NSUInteger FindSuitableSampleCount(id<MTLDevice> device, NSUInteger samples);
 
+        // Returns true if the Metal device supports textures with MTLStorageModeMemoryless, i.e. only Apple GPUs.
+        static bool SupportsMemorylessStorage(id<MTLDevice> device);
+
 };
 
 
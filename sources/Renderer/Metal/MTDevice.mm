@@ -6,6 +6,7 @@
  */
 
 #include "MTDevice.h"
+#include <LLGL/Platform/Platform.h>
 
 
 namespace LLGL
@@ -23,6 +24,17 @@ NSUInteger MTDevice::FindSuitableSampleCount(id<MTLDevice> device, NSUInteger sa
     return 4u; // Supported by all macOS and iOS devices; 1 is not supported according to Metal validation layer
 }
 
+bool MTDevice::SupportsMemorylessStorage(id<MTLDevice> device)
+{
+    if (@available(macOS 11.0, iOS 13.0, *))
+        return [device supportsFamily:MTLGPUFamilyApple1];
+    #ifdef LLGL_OS_IOS
+    return true;
+    #else
+    return false;
+    #endif
+}
+
 
 
 } // /namespace LLGL
@@ -20,6 +20,21 @@ namespace LLGL
 
 void LoadFeatureSetCaps(id<MTLDevice> device, MTLFeatureSet fset, RenderingCapabilities& caps);
 
+// Returns true if the specified device supports argument buffers of tier 2, which are used for bindless resource heaps.
+bool IsArgumentBuffersTier2Supported(id<MTLDevice> device);
+
+// Returns true if the specified device supports indirect command buffers that are encoded on the CPU.
+bool IsIndirectCommandBufferSupported(id<MTLDevice> device);
+
+// Returns true if the specified device supports render pipelines with object and mesh functions.
+bool IsMeshShaderSupported(id<MTLDevice> device);
+
+// Returns true if the specified device supports the GPU addresses of buffers, which are only available with the Metal 3 family.
+bool IsBufferDeviceAddressSupported(id<MTLDevice> device);
+
+// Returns true if the specified device can create IO command queues to load files directly into resources.
+bool IsIOCommandQueueSupported(id<MTLDevice> device);
+
 
 } // /namespace LLGL
 
@@ -74,6 +74,105 @@ static NSUInteger GetMaxMTBufferSize(id<MTLDevice> device)
         return minBufferSize256MB;
 }
 
+bool IsArgumentBuffersTier2Supported(id<MTLDevice> device)
+{
+    if (@available(iOS 11.0, macOS 10.13, *))
+        return ([device argumentBuffersSupport] >= MTLArgumentBuffersTier2);
+    else
+        return false;
+}
+
+bool IsIndirectCommandBufferSupported(id<MTLDevice> device)
+{
+    if (@available(iOS 12.0, macOS 10.14, *))
+    {
+        #ifdef LLGL_OS_IOS
+        return [device supportsFeatureSet:MTLFeatureSet_iOS_GPUFamily3_v4];
+        #else
+        return [device supportsFeatureSet:MTLFeatureSet_macOS_GPUFamily2_v1];
+        #endif
+    }
+    else
+        return false;
+}
+
+bool IsMeshShaderSupported(id<MTLDevice> device)
+{
+    if (@available(iOS 16.0, macOS 13.0, *))
+        return [device supportsFamily:MTLGPUFamilyMetal3];
+    else
+        return false;
+}
+
+bool IsBufferDeviceAddressSupported(id<MTLDevice> device)
+{
+    if (@available(iOS 16.0, macOS 13.0, *))
+        return [device supportsFamily:MTLGPUFamilyMetal3];
+    else
+        return false;
+}
+
+bool IsIOCommandQueueSupported(id<MTLDevice> device)
+{
+    if (@available(iOS 16.0, macOS 13.0, *))
+        return [device respondsToSelector:@selector(newIOCommandQueueWithDescriptor:error:)];
+    else
+        return false;
+}
+
+// Returns the maximum vertex amplification count that is used for multiview rendering, or 0 if vertex amplification is not supported.
+static std::uint32_t GetMaxVertexAmplificationCount(id<MTLDevice> device)
+{
+    if (@available(iOS 13.0, macOS 10.15.4, *))
+    {
+        for (std::uint32_t count : { 4u, 2u })
+        {
+            if ([device supportsVertexAmplificationCount:count])
+                return count;
+        }
+    }
+    return 0;
+}
+
+/*
+Determines the SIMD-group limits from the GPU family.
+The actual SIMD-group size is only known per compute pipeline via 'threadExecutionWidth',
+so this reports the width of Apple GPUs or the range of widths of discrete GPUs in Macs.
+*/
+static void LoadSIMDGroupLimits(id<MTLDevice> device, RenderingLimits& limits)
+{
+    constexpr long simdGroupOperations =
+    (
+        SubgroupOperationFlags::Basic           |
+        SubgroupOperationFlags::Vote            |
+        SubgroupOperationFlags::Arithmetic      |
+        SubgroupOperationFlags::Ballot          |
+        SubgroupOperationFlags::Shuffle         |
+        SubgroupOperationFlags::ShuffleRelative |
+        SubgroupOperationFlags::Quad
+    );
+
+    if (@available(iOS 14.0, macOS 11.0, *))
+    {
+        if ([device supportsFamily:MTLGPUFamilyApple7])
+        {
+            limits.minSubgroupSize      = 32u;
+            limits.maxSubgroupSize      = 32u;
+            limits.subgroupOperations   = simdGroupOperations;
+            limits.subgroupStages       = (StageFlags::ComputeStage | StageFlags::FragmentStage);
+        }
+        #ifndef LLGL_OS_IOS
+        else if ([device supportsFamily:MTLGPUFamilyMac2])
+        {
+            limits.minSubgroupSize      = 8u;
+            limits.maxSubgroupSize      = 64u;
+            limits.subgroupOperations   = simdGroupOperations;
+            limits.subgroupStages       = (StageFlags::ComputeStage | StageFlags::FragmentStage);
+        }
+        #endif
+    }
+}
+
 // see https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
 void LoadFeatureSetCaps(id<MTLDevice> device, MTLFeatureSet fset, RenderingCapabilities& caps)
 {
@@ -123,10 +222,18 @@ void LoadFeatureSetCaps(id<MTLDevice> device, MTLFeatureSet fset, RenderingCapab
     features.hasInstancing                  = true;
     features.hasOffsetInstancing            = true;
     features.hasIndirectDrawing             = true;
+    features.hasIndirectCountDrawing        = false;
     features.hasViewportArrays              = (version >= 103);
     features.hasConservativeRasterization   = false;
     features.hasStreamOutputs               = false;
     features.hasLogicOp                     = false;
+    features.hasBindlessResources           = IsArgumentBuffersTier2Supported(device);
+    features.hasMeshShaders                 = IsMeshShaderSupported(device);
+    features.hasTextureCompression          = false;
+    features.hasSubgroupSizeControl         = false;
+    features.hasNativeIOQueue               = IsIOCommandQueueSupported(device);
+    features.hasMultiview                   = (GetMaxVertexAmplificationCount(device) > 0);
+    features.hasBufferDeviceAddress         = IsBufferDeviceAddressSupported(device);
 
     /* Specify limits */
     auto& limits = caps.limits;
@@ -171,6 +278,10 @@ void LoadFeatureSetCaps(id<MTLDevice> device, MTLFeatureSet fset, RenderingCapab
     caps.limits.maxDepthBufferSamples       = maxSamples;
     caps.limits.maxStencilBufferSamples     = maxSamples;
     caps.limits.maxNoAttachmentSamples      = maxSamples;
+
+    caps.limits.maxMultiviewViewCount       = GetMaxVertexAmplificationCount(device);
+
+    LoadSIMDGroupLimits(device, caps.limits);
 }
 
 
@@ -0,0 +1,87 @@
+/*
+ * MTHeapAllocator.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_MT_HEAP_ALLOCATOR_H
+#define LLGL_MT_HEAP_ALLOCATOR_H
+
+
+#import <Metal/Metal.h>
+
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Allocator for buffers and textures that are placed into MTLHeap objects instead of being allocated from the device one by one.
+Heaps are pooled per storage mode and CPU cache mode and they are not hazard tracked by Metal, see RendererConfigurationMetal::heapBlockSize.
+*/
+class MTHeapAllocator
+{
+
+    public:
+
+        MTHeapAllocator(const MTHeapAllocator&) = delete;
+        MTHeapAllocator& operator = (const MTHeapAllocator&) = delete;
+
+        MTHeapAllocator(id<MTLDevice> device, NSUInteger heapBlockSize);
+        ~MTHeapAllocator();
+
+        // Returns a new buffer from one of the heaps or nil if the buffer must be allocated from the device instead.
+        id<MTLBuffer> NewBuffer(NSUInteger length, MTLResourceOptions options);
+
+        // Returns a new texture from one of the heaps or nil if the texture must be allocated from the device instead.
+        id<MTLTexture> NewTexture(MTLTextureDescriptor* texDesc);
+
+        // Releases all heaps that no longer contain any resources, but keeps the first heap of each pool.
+        void ReleaseUnusedHeaps();
+
+    public:
+
+        // Returns true if the specified resource was allocated from a heap and is not hazard tracked by Metal.
+        static bool IsHeapResource(id<MTLResource> resource);
+
+        // Makes the memory of the specified heap resource available for new allocations, if it is a private resource, and releases it.
+        static void ReleaseHeapResource(id<MTLResource> resource);
+
+    private:
+
+        struct MTHeapPool
+        {
+            MTLStorageMode              storageMode;
+            MTLCPUCacheMode             cpuCacheMode;
+            std::vector<id<MTLHeap>>    heaps;
+        };
+
+    private:
+
+        bool IsStorageModeSupported(MTLStorageMode storageMode, bool isTexture) const;
+
+        // Returns a heap with enough free space for the specified size and alignment or nil if the allocation exceeds the heap block size.
+        id<MTLHeap> FindOrCreateHeap(MTLStorageMode storageMode, MTLCPUCacheMode cpuCacheMode, const MTLSizeAndAlign& sizeAndAlign);
+
+        MTHeapPool& GetOrCreatePool(MTLStorageMode storageMode, MTLCPUCacheMode cpuCacheMode);
+
+    private:
+
+        id<MTLDevice>               device_         = nil;
+        NSUInteger                  heapBlockSize_  = 0;
+        std::vector<MTHeapPool>     pools_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
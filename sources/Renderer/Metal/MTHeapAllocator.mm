@@ -0,0 +1,190 @@
+/*
+ * MTHeapAllocator.mm
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "MTHeapAllocator.h"
+#include <LLGL/Platform/Platform.h>
+
+
+namespace LLGL
+{
+
+
+MTHeapAllocator::MTHeapAllocator(id<MTLDevice> device, NSUInteger heapBlockSize) :
+    device_        { device        },
+    heapBlockSize_ { heapBlockSize }
+{
+}
+
+MTHeapAllocator::~MTHeapAllocator()
+{
+    for (MTHeapPool& pool : pools_)
+    {
+        for (id<MTLHeap> heap : pool.heaps)
+            [heap release];
+    }
+}
+
+static MTLStorageMode GetStorageMode(MTLResourceOptions options)
+{
+    return static_cast<MTLStorageMode>((options & MTLResourceStorageModeMask) >> MTLResourceStorageModeShift);
+}
+
+static MTLCPUCacheMode GetCPUCacheMode(MTLResourceOptions options)
+{
+    return static_cast<MTLCPUCacheMode>((options & MTLResourceCPUCacheModeMask) >> MTLResourceCPUCacheModeShift);
+}
+
+id<MTLBuffer> MTHeapAllocator::NewBuffer(NSUInteger length, MTLResourceOptions options)
+{
+    if (@available(macOS 10.13, iOS 10.0, *))
+    {
+        const MTLStorageMode storageMode = GetStorageMode(options);
+        if (!IsStorageModeSupported(storageMode, false))
+            return nil;
+
+        const MTLSizeAndAlign sizeAndAlign = [device_ heapBufferSizeAndAlignWithLength:length options:options];
+        if (id<MTLHeap> heap = FindOrCreateHeap(storageMode, GetCPUCacheMode(options), sizeAndAlign))
+            return [heap newBufferWithLength:length options:options];
+    }
+    return nil;
+}
+
+id<MTLTexture> MTHeapAllocator::NewTexture(MTLTextureDescriptor* texDesc)
+{
+    if (@available(macOS 10.13, iOS 10.0, *))
+    {
+        if (!IsStorageModeSupported(texDesc.storageMode, true))
+            return nil;
+
+        const MTLSizeAndAlign sizeAndAlign = [device_ heapTextureSizeAndAlignWithDescriptor:texDesc];
+        if (id<MTLHeap> heap = FindOrCreateHeap(texDesc.storageMode, texDesc.cpuCacheMode, sizeAndAlign))
+            return [heap newTextureWithDescriptor:texDesc];
+    }
+    return nil;
+}
+
+void MTHeapAllocator::ReleaseUnusedHeaps()
+{
+    if (@available(macOS 10.13, iOS 10.0, *))
+    {
+        for (MTHeapPool& pool : pools_)
+        {
+            if (pool.heaps.size() < 2)
+                continue;
+
+            /* Resources that are still referenced by command buffers in flight keep their heap memory occupied until they are deallocated */
+            for (auto it = pool.heaps.begin() + 1; it < pool.heaps.end();)
+            {
+                if ([*it usedSize] == 0)
+                {
+                    [*it release];
+                    it = pool.heaps.erase(it);
+                }
+                else
+                    ++it;
+            }
+        }
+    }
+}
+
+bool MTHeapAllocator::IsHeapResource(id<MTLResource> resource)
+{
+    if (@available(macOS 10.13, iOS 10.0, *))
+        return ([resource heap] != nil);
+    else
+        return false;
+}
+
+void MTHeapAllocator::ReleaseHeapResource(id<MTLResource> resource)
+{
+    /*
+    Only private resources can alias the memory of other resources, because the CPU never writes to them while they might still be in use by the GPU.
+    All command encoders are synchronized with the hazard tracking fence, so a resource that aliases this memory is not accessed before previous encoders have finished.
+    */
+    if (@available(macOS 10.13, iOS 10.0, *))
+    {
+        if ([resource storageMode] == MTLStorageModePrivate)
+            [resource makeAliasable];
+    }
+    [resource release];
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool MTHeapAllocator::IsStorageModeSupported(MTLStorageMode storageMode, bool isTexture) const
+{
+    if (storageMode == MTLStorageModePrivate)
+        return true;
+    #ifdef LLGL_OS_IOS
+    return (storageMode == MTLStorageModeShared);
+    #else
+    /* Heaps on macOS only support shared storage for buffers since macOS 10.15 and never support managed storage */
+    if (@available(macOS 10.15, *))
+        return (storageMode == MTLStorageModeShared && !isTexture);
+    else
+        return false;
+    #endif
+}
+
+id<MTLHeap> MTHeapAllocator::FindOrCreateHeap(MTLStorageMode storageMode, MTLCPUCacheMode cpuCacheMode, const MTLSizeAndAlign& sizeAndAlign)
+{
+    /* Allocate large resources from the device to keep fragmentation of the heaps low */
+    if (sizeAndAlign.size > heapBlockSize_ / 2)
+        return nil;
+
+    if (@available(macOS 10.13, iOS 10.0, *))
+    {
+        MTHeapPool& pool = GetOrCreatePool(storageMode, cpuCacheMode);
+
+        /* Find heap with enough free space; the heap manages the placement of its resources itself */
+        for (id<MTLHeap> heap : pool.heaps)
+        {
+            if ([heap maxAvailableSizeWithAlignment:sizeAndAlign.align] >= sizeAndAlign.size)
+                return heap;
+        }
+
+        /* Allocate new heap for this pool */
+        MTLHeapDescriptor* heapDesc = [[MTLHeapDescriptor alloc] init];
+        {
+            heapDesc.size           = heapBlockSize_;
+            heapDesc.storageMode    = storageMode;
+            heapDesc.cpuCacheMode   = cpuCacheMode;
+            if (@available(macOS 10.15, iOS 13.0, *))
+                heapDesc.hazardTrackingMode = MTLHazardTrackingModeUntracked;
+        }
+        id<MTLHeap> heap = [device_ newHeapWithDescriptor:heapDesc];
+        [heapDesc release];
+
+        if (heap != nil)
+            pool.heaps.push_back(heap);
+
+        return heap;
+    }
+
+    return nil;
+}
+
+MTHeapAllocator::MTHeapPool& MTHeapAllocator::GetOrCreatePool(MTLStorageMode storageMode, MTLCPUCacheMode cpuCacheMode)
+{
+    for (MTHeapPool& pool : pools_)
+    {
+        if (pool.storageMode == storageMode && pool.cpuCacheMode == cpuCacheMode)
+            return pool;
+    }
+    pools_.push_back(MTHeapPool{ storageMode, cpuCacheMode, {} });
+    return pools_.back();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
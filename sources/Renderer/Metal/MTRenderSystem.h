@@ -17,6 +17,7 @@
 #include "Command/MTCommandQueue.h"
 #include "Command/MTCommandBuffer.h"
 #include "MTSwapChain.h"
+#include "MTHeapAllocator.h"
 
 #include "Buffer/MTBuffer.h"
 #include "Buffer/MTBufferArray.h"
@@ -27,6 +28,7 @@
 #include "RenderState/MTResourceHeap.h"
 #include "RenderState/MTRenderPass.h"
 #include "RenderState/MTFence.h"
+#include "RenderState/MTQueryHeap.h"
 
 #include "Shader/MTShader.h"
 
@@ -50,31 +52,45 @@ class MTRenderSystem final : public RenderSystem
 
     public:
 
-        MTRenderSystem();
+        MTRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~MTRenderSystem();
 
     private:
 
-        void CreateDeviceResources();
+        void CreateDeviceResources(const RenderSystemDescriptor& renderSystemDesc, const RendererConfigurationMetal* rendererConfigMT);
         void QueryRenderingCaps();
 
+        // Blocks until the graphics queue and the asynchronous queue are idle.
+        void WaitIdleAllQueues();
+
         const char* QueryMetalVersion() const;
 
         MTLFeatureSet QueryHighestFeatureSet() const;
 
         const MTRenderPass* GetDefaultRenderPass() const;
 
+        // Returns the IO command queue (id<MTLIOCommandQueue>) and creates it with the first call. Returns nil if the device does not support IO command queues.
+        id GetOrCreateIOQueue();
+
+        // Loads the specified files directly into their destination resources with the IO command queue.
+        bool SubmitFileLoadsWithIOQueue(const ArrayView<FileLoadDescriptor>& loads, Fence* fence);
+
     private:
 
         /* ----- Common objects ----- */
 
         id<MTLDevice>                           device_             = nil;
         std::unique_ptr<MTIntermediateBuffer>   intermediateBuffer_;
+        std::unique_ptr<MTHeapAllocator>        heapAllocator_;     // Only used when RendererConfigurationMetal::heapBlockSize is non-zero
+        SamplerCache<id<MTLSamplerState>>       samplerCache_;      // Must outlive 'samplers_'
+        MTShaderLibraryCache                    shaderLibraries_;   // Shader libraries shared between all shaders from the same source
+        id                                      ioQueue_            = nil;  // id<MTLIOCommandQueue> (macOS 13.0, iOS 16.0)
 
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<MTSwapChain>          swapChains_;
         HWObjectInstance<MTCommandQueue>        commandQueue_;
+        HWObjectInstance<MTCommandQueue>        asyncQueue_;        // Shared by the compute and copy queue types
         HWObjectContainer<MTCommandBuffer>      commandBuffers_;
         HWObjectContainer<MTBuffer>             buffers_;
         HWObjectContainer<MTBufferArray>        bufferArrays_;
@@ -86,7 +102,7 @@ class MTRenderSystem final : public RenderSystem
         HWObjectContainer<MTPipelineLayout>     pipelineLayouts_;
         HWObjectContainer<MTPipelineState>  	pipelineStates_;
         HWObjectContainer<MTResourceHeap>       resourceHeaps_;
-        //HWObjectContainer<MTQueryHeap>          queryHeaps_;
+        HWObjectContainer<MTQueryHeap>          queryHeaps_;
         HWObjectContainer<MTFence>              fences_;
 
 };
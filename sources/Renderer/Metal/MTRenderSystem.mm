@@ -6,21 +6,31 @@
  */
 
 #include "MTRenderSystem.h"
+#include "../RenderSystemUtils.h"
+#include "../FileLoadUtils.h"
 #include "../CheckedCast.h"
 #include "../TextureUtils.h"
 #include "../../Core/CoreUtils.h"
 #include "../../Core/Exception.h"
 #include "../../Core/Vendor.h"
+#include "../../Core/StringUtils.h"
 #include "Command/MTDirectCommandBuffer.h"
 #include "Command/MTMultiSubmitCommandBuffer.h"
+#include "Command/MTCommandContext.h"
 #include "MTFeatureSet.h"
 #include "MTTypes.h"
 #include "RenderState/MTGraphicsPSO.h"
 #include "RenderState/MTComputePSO.h"
 #include "RenderState/MTBuiltinPSOFactory.h"
+#include "../HostTrace.h"
 #include <LLGL/ImageFlags.h>
 #include <LLGL/Platform/Platform.h>
+#include <LLGL/RendererConfiguration.h>
+#include <LLGL/Utils/ForRange.h>
 #include <AvailabilityMacros.h>
+#include <algorithm>
+#include <string.h>
+#include <vector>
 
 #include <LLGL/Backend/Metal/NativeHandle.h>
 
@@ -31,14 +41,16 @@ namespace LLGL
 
 /* ----- Common ----- */
 
-MTRenderSystem::MTRenderSystem()
+MTRenderSystem::MTRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
 {
-    CreateDeviceResources();
+    CreateDeviceResources(renderSystemDesc, GetRendererConfiguration<RendererConfigurationMetal>(renderSystemDesc));
     QueryRenderingCaps();
 }
 
 MTRenderSystem::~MTRenderSystem()
 {
+    if (ioQueue_ != nil)
+        [ioQueue_ release];
     [device_ release];
 }
 
@@ -56,19 +68,33 @@ void MTRenderSystem::Release(SwapChain& swapChain)
 
 /* ----- Command queues ----- */
 
-CommandQueue* MTRenderSystem::GetCommandQueue()
+CommandQueue* MTRenderSystem::GetCommandQueue(const CommandQueueType type)
 {
-    return commandQueue_.get();
+    if (type == CommandQueueType::Graphics)
+        return commandQueue_.get();
+    else
+        return asyncQueue_.get();
 }
 
 /* ----- Command buffers ----- */
 
 CommandBuffer* MTRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
-    if ((commandBufferDesc.flags & (CommandBufferFlags::MultiSubmit | CommandBufferFlags::Secondary)) != 0)
+    /* Secondary command buffers with a render pass encode in parallel into sub-encoders of a primary command buffer */
+    const bool isParallelCmdBuffer =
+    (
+        (commandBufferDesc.flags & CommandBufferFlags::Secondary) != 0 &&
+        (commandBufferDesc.flags & CommandBufferFlags::MultiSubmit) == 0 &&
+        commandBufferDesc.renderPass != nullptr
+    );
+
+    if (!isParallelCmdBuffer && (commandBufferDesc.flags & (CommandBufferFlags::MultiSubmit | CommandBufferFlags::Secondary)) != 0)
         return commandBuffers_.emplace<MTMultiSubmitCommandBuffer>(device_, commandBufferDesc);
     else
-        return commandBuffers_.emplace<MTDirectCommandBuffer>(device_, *commandQueue_, commandBufferDesc);
+    {
+        auto* commandQueueMT = LLGL_CAST(MTCommandQueue*, GetCommandQueue(commandBufferDesc.queueType));
+        return commandBuffers_.emplace<MTDirectCommandBuffer>(device_, *commandQueueMT, commandBufferDesc);
+    }
 }
 
 void MTRenderSystem::Release(CommandBuffer& commandBuffer)
@@ -81,7 +107,14 @@ void MTRenderSystem::Release(CommandBuffer& commandBuffer)
 Buffer* MTRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
 {
     RenderSystem::AssertCreateBuffer(bufferDesc, device_.maxBufferLength);
-    return buffers_.emplace<MTBuffer>(device_, bufferDesc, initialData);
+    return buffers_.emplace<MTBuffer>(device_, bufferDesc, initialData, heapAllocator_.get());
+}
+
+void MTRenderSystem::CreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, const void* const * initialData, Buffer** outBuffers)
+{
+    RenderSystem::AssertCreateBuffers(numBuffers, bufferDescs, outBuffers);
+    for (std::uint32_t i = 0; i < numBuffers; ++i)
+        outBuffers[i] = CreateBuffer(bufferDescs[i], (initialData != nullptr ? initialData[i] : nullptr));
 }
 
 BufferArray* MTRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
@@ -93,6 +126,8 @@ BufferArray* MTRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 void MTRenderSystem::Release(Buffer& buffer)
 {
     buffers_.erase(&buffer);
+    if (heapAllocator_)
+        heapAllocator_->ReleaseUnusedHeaps();
 }
 
 void MTRenderSystem::Release(BufferArray& bufferArray)
@@ -102,28 +137,28 @@ void MTRenderSystem::Release(BufferArray& bufferArray)
 
 void MTRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize)
 {
-    commandQueue_->WaitIdle();
+    WaitIdleAllQueues();
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     bufferMT.Write(static_cast<NSUInteger>(offset), data, static_cast<NSUInteger>(dataSize));
 }
 
 void MTRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
-    commandQueue_->WaitIdle();
+    WaitIdleAllQueues();
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     bufferMT.Read(static_cast<NSUInteger>(offset), data, static_cast<NSUInteger>(dataSize));
 }
 
 void* MTRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
-    commandQueue_->WaitIdle();
+    WaitIdleAllQueues();
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     return bufferMT.Map(access);
 }
 
 void* MTRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
-    commandQueue_->WaitIdle();
+    WaitIdleAllQueues();
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     return bufferMT.Map(access, static_cast<NSUInteger>(offset), static_cast<NSUInteger>(length));
 }
@@ -138,9 +173,10 @@ void MTRenderSystem::UnmapBuffer(Buffer& buffer)
 
 Texture* MTRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
-    auto* textureMT = textures_.emplace<MTTexture>(device_, textureDesc);
+    auto* textureMT = textures_.emplace<MTTexture>(device_, textureDesc, heapAllocator_.get());
 
-    if (imageDesc)
+    /* Initial data of transient textures is ignored, since memoryless textures cannot be written */
+    if (imageDesc != nullptr && (textureDesc.miscFlags & MiscFlags::Transient) == 0)
     {
         textureMT->WriteRegion(
             //TextureRegion{ Offset3D{ 0, 0, 0 }, textureMT->GetMipExtent(0) },
@@ -156,34 +192,46 @@ Texture* MTRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
         /* Generate MIP-maps if enabled */
         if (MustGenerateMipsOnCreate(textureDesc))
         {
-            id<MTLCommandBuffer> cmdBuffer = [commandQueue_->GetNative() commandBuffer];
+            MTCommandContext context;
+            context.Reset([commandQueue_->GetNative() commandBuffer], commandQueue_->GetHazardFence());
             {
-                id<MTLBlitCommandEncoder> blitCmdEncoder = [cmdBuffer blitCommandEncoder];
+                id<MTLBlitCommandEncoder> blitCmdEncoder = context.BindBlitEncoder();
                 [blitCmdEncoder generateMipmapsForTexture:textureMT->GetNative()];
-                [blitCmdEncoder endEncoding];
+                context.Flush();
             }
-            [cmdBuffer commit];
+            [context.GetCommandBuffer() commit];
         }
     }
 
     return textureMT;
 }
 
+void MTRenderSystem::CreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, const SrcImageDescriptor* const * imageDescs, Texture** outTextures)
+{
+    RenderSystem::AssertCreateTextures(numTextures, textureDescs, outTextures);
+    for (std::uint32_t i = 0; i < numTextures; ++i)
+        outTextures[i] = CreateTexture(textureDescs[i], (imageDescs != nullptr ? imageDescs[i] : nullptr));
+}
+
 void MTRenderSystem::Release(Texture& texture)
 {
     textures_.erase(&texture);
+    if (heapAllocator_)
+        heapAllocator_->ReleaseUnusedHeaps();
 }
 
 void MTRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
-    commandQueue_->WaitIdle();
+    LLGL_HOST_TRACE_SCOPE("WriteTexture");
+
+    WaitIdleAllQueues();
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     textureMT.WriteRegion(textureRegion, imageDesc);
 }
 
 void MTRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
-    commandQueue_->WaitIdle();
+    WaitIdleAllQueues();
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     textureMT.ReadRegion(textureRegion, imageDesc, commandQueue_->GetNative(), intermediateBuffer_.get());
 }
@@ -192,7 +240,7 @@ void MTRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
 
 Sampler* MTRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    return samplers_.emplace<MTSampler>(device_, samplerDesc);
+    return samplers_.emplace<MTSampler>(device_, samplerCache_, samplerDesc);
 }
 
 void MTRenderSystem::Release(Sampler& sampler)
@@ -246,8 +294,10 @@ void MTRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* MTRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateShader");
+
     RenderSystem::AssertCreateShader(shaderDesc);
-    return shaders_.emplace<MTShader>(device_, shaderDesc);
+    return shaders_.emplace<MTShader>(device_, shaderDesc, &shaderLibraries_);
 }
 
 void MTRenderSystem::Release(Shader& shader)
@@ -274,14 +324,38 @@ PipelineState* MTRenderSystem::CreatePipelineState(const Blob& /*serializedCache
     return nullptr;//TODO
 }
 
-PipelineState* MTRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
+PipelineState* MTRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* serializedCache)
 {
-    return pipelineStates_.emplace<MTGraphicsPSO>(device_, pipelineStateDesc, GetDefaultRenderPass());
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineState");
+
+    return pipelineStates_.emplace<MTGraphicsPSO>(device_, pipelineStateDesc, GetDefaultRenderPass(), serializedCache);
+}
+
+PipelineState* MTRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* serializedCache)
+{
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineState");
+
+    return pipelineStates_.emplace<MTComputePSO>(device_, pipelineStateDesc, serializedCache);
+}
+
+/* Native PSOs are always created in the background with the completion handlers of MTLDevice, so only the fallback has to be assigned */
+
+PipelineState* MTRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState)
+{
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineStateAsync");
+
+    MTGraphicsPSO* pipelineState = pipelineStates_.emplace<MTGraphicsPSO>(device_, pipelineStateDesc, GetDefaultRenderPass(), nullptr);
+    pipelineState->SetFallback(fallbackPipelineState);
+    return pipelineState;
 }
 
-PipelineState* MTRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
+PipelineState* MTRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState)
 {
-    return pipelineStates_.emplace<MTComputePSO>(device_, pipelineStateDesc);
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineStateAsync");
+
+    MTComputePSO* pipelineState = pipelineStates_.emplace<MTComputePSO>(device_, pipelineStateDesc, nullptr);
+    pipelineState->SetFallback(fallbackPipelineState);
+    return pipelineState;
 }
 
 void MTRenderSystem::Release(PipelineState& pipelineState)
@@ -293,13 +367,24 @@ void MTRenderSystem::Release(PipelineState& pipelineState)
 
 QueryHeap* MTRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& queryHeapDesc)
 {
-    return nullptr;//todo
+    return queryHeaps_.emplace<MTQueryHeap>(device_, queryHeapDesc);
 }
 
 void MTRenderSystem::Release(QueryHeap& queryHeap)
 {
-    //todo
-    //queryHeaps_.erase(&queryHeap);
+    queryHeaps_.erase(&queryHeap);
+}
+
+/* ----- Acceleration structures ----- */
+
+AccelerationStructure* MTRenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& /*accelerationStructureDesc*/)
+{
+    LLGL_TRAP_FEATURE_NOT_SUPPORTED("acceleration structures");
+}
+
+void MTRenderSystem::Release(AccelerationStructure& /*accelerationStructure*/)
+{
+    // dummy
 }
 
 /* ----- Fences ----- */
@@ -328,18 +413,117 @@ bool MTRenderSystem::GetNativeHandle(void* nativeHandle, std::size_t nativeHandl
     return false;
 }
 
+std::uint64_t MTRenderSystem::ReleaseRetainedMemory(std::uint64_t /*budget*/)
+{
+    return 0; // dummy
+}
+
+bool MTRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStatistics)
+{
+    outStatistics.heaps.clear();
+
+    /* Metal reports a single working set for all allocations of this device */
+    MemoryHeapStatistics heap;
+
+    if (@available(macOS 10.15, iOS 13.0, *))
+        heap.deviceLocal = ![device_ hasUnifiedMemory];
+    if (@available(macOS 10.12, iOS 16.0, *))
+        heap.budget = static_cast<std::uint64_t>([device_ recommendedMaxWorkingSetSize]);
+    if (@available(macOS 10.13, iOS 11.0, *))
+        heap.usage = static_cast<std::uint64_t>([device_ currentAllocatedSize]);
+    else
+        return false;
+
+    outStatistics.heaps.push_back(heap);
+    return true;
+}
+
+bool MTRenderSystem::SetMemoryPriority(Resource& /*resource*/, float /*priority*/)
+{
+    return false; // dummy
+}
+
+Blob MTRenderSystem::GetPipelineCache()
+{
+    return Blob{}; // dummy
+}
+
+bool MTRenderSystem::ExportMemoryHandle(Resource& /*resource*/, ExternalHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool MTRenderSystem::ExportFenceHandle(Fence& /*fence*/, ExternalHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool MTRenderSystem::SubmitFileLoads(const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    if (GetOrCreateIOQueue() != nil)
+        return SubmitFileLoadsWithIOQueue(loads, fence);
+    else
+        return SubmitFileLoadsEmulated(*this, loads, fence);
+}
+
 
 /*
  * ======= Private: =======
  */
 
-void MTRenderSystem::CreateDeviceResources()
+static VideoAdapterDescriptor MTGetVideoAdapterDesc(id<MTLDevice> device)
+{
+    VideoAdapterDescriptor videoAdapterDesc;
+    {
+        videoAdapterDesc.name   = ToUTF16String([[device name] cStringUsingEncoding:NSUTF8StringEncoding]);
+        videoAdapterDesc.vendor = "Apple";
+        if (@available(iOS 11.0, macOS 10.12, *))
+            videoAdapterDesc.videoMemory = static_cast<std::uint64_t>([device recommendedMaxWorkingSetSize]);
+        if (@available(iOS 11.0, macOS 10.13, *))
+            videoAdapterDesc.luid = static_cast<std::uint64_t>([device registryID]);
+    }
+    return videoAdapterDesc;
+}
+
+void MTRenderSystem::CreateDeviceResources(const RenderSystemDescriptor& renderSystemDesc, const RendererConfigurationMetal* rendererConfigMT)
 {
-    /* Create Metal device */
-    device_ = MTLCreateSystemDefaultDevice();
+    /* Enumerate all Metal devices; iOS only provides the system default device */
+    #ifdef LLGL_OS_IOS
+    NSArray<id<MTLDevice>>* devices = [[NSArray alloc] init];
+    #else
+    NSArray<id<MTLDevice>>* devices = MTLCopyAllDevices();
+    #endif
+
+    std::vector<VideoAdapterDescriptor> videoAdapters;
+    for (id<MTLDevice> device in devices)
+        videoAdapters.push_back(MTGetVideoAdapterDesc(device));
+
+    /* Create Metal device from the selected adapter or the system default device */
+    const std::uint32_t selectedAdapter = FindSelectedVideoAdapter(renderSystemDesc, videoAdapters);
+    if (selectedAdapter != Constants::defaultAdapter)
+        device_ = [[devices objectAtIndex:selectedAdapter] retain];
+    else
+        device_ = MTLCreateSystemDefaultDevice();
+
+    [devices release];
+
     if (device_ == nil)
         LLGL_TRAP("failed to create Metal device");
 
+    /* Find index of the default device or add it, if it has not been enumerated */
+    std::uint32_t adapterIndex = selectedAdapter;
+    if (adapterIndex == Constants::defaultAdapter)
+    {
+        const VideoAdapterDescriptor defaultAdapterDesc = MTGetVideoAdapterDesc(device_);
+        for (adapterIndex = 0; adapterIndex < videoAdapters.size(); ++adapterIndex)
+        {
+            if (videoAdapters[adapterIndex].luid == defaultAdapterDesc.luid && videoAdapters[adapterIndex].name == defaultAdapterDesc.name)
+                break;
+        }
+        if (adapterIndex == videoAdapters.size())
+            videoAdapters.push_back(defaultAdapterDesc);
+    }
+
     /* Initialize renderer information */
     RendererInfo info;
     {
@@ -347,11 +531,20 @@ void MTRenderSystem::CreateDeviceResources()
         info.deviceName             = [[device_ name] cStringUsingEncoding:NSUTF8StringEncoding];
         info.vendorName             = "Apple";
         info.shadingLanguageName    = "Metal Shading Language";
+        info.videoAdapters          = std::move(videoAdapters);
+        info.adapterIndex           = adapterIndex;
     }
     SetRendererInfo(info);
 
-    /* Create command queue */
-    commandQueue_ = MakeUnique<MTCommandQueue>(device_);
+    /* Create heap allocator; resources in these heaps are hazard tracked by a fence in each command queue */
+    if (rendererConfigMT != nullptr && rendererConfigMT->heapBlockSize > 0)
+        heapAllocator_ = MakeUnique<MTHeapAllocator>(device_, static_cast<NSUInteger>(rendererConfigMT->heapBlockSize));
+
+    const bool hazardTracking = (heapAllocator_ != nullptr);
+
+    /* Create command queues; Metal does not distinguish between queue types, so one additional queue serves compute and copy work */
+    commandQueue_   = MakeUnique<MTCommandQueue>(device_, hazardTracking);
+    asyncQueue_     = MakeUnique<MTCommandQueue>(device_, hazardTracking);
 
     /* Initialize builtin PSOs */
     MTBuiltinPSOFactory::Get().CreateBuiltinPSOs(device_);
@@ -368,6 +561,12 @@ void MTRenderSystem::QueryRenderingCaps()
     SetRenderingCaps(caps);
 }
 
+void MTRenderSystem::WaitIdleAllQueues()
+{
+    asyncQueue_->WaitIdle();
+    commandQueue_->WaitIdle();
+}
+
 const char* MTRenderSystem::QueryMetalVersion() const
 {
     const auto featureSet = QueryHighestFeatureSet();
@@ -518,6 +717,150 @@ const MTRenderPass* MTRenderSystem::GetDefaultRenderPass() const
     return nullptr;
 }
 
+id MTRenderSystem::GetOrCreateIOQueue()
+{
+    if (ioQueue_ == nil && GetRenderingCaps().features.hasNativeIOQueue)
+    {
+        if (@available(macOS 13.0, iOS 16.0, *))
+        {
+            MTLIOCommandQueueDescriptor* ioQueueDesc = [[MTLIOCommandQueueDescriptor alloc] init];
+            {
+                ioQueueDesc.type        = MTLIOCommandQueueTypeConcurrent;
+                ioQueueDesc.priority    = MTLIOPriorityNormal;
+            }
+            ioQueue_ = [device_ newIOCommandQueueWithDescriptor:ioQueueDesc error:nil];
+            [ioQueueDesc release];
+        }
+    }
+    return ioQueue_;
+}
+
+// Returns the file handle for the specified filename and opens it if it is not in the list of handles yet.
+static id FindOrOpenIOFileHandle(id<MTLDevice> device, const char* filename, std::vector<const char*>& filenames, NSMutableArray* handles)
+{
+    for_range(i, filenames.size())
+    {
+        if (::strcmp(filenames[i], filename) == 0)
+            return [handles objectAtIndex:i];
+    }
+
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        NSURL* url = [NSURL fileURLWithPath:[NSString stringWithUTF8String:filename]];
+        id<MTLIOFileHandle> handle = [device newIOHandleWithURL:url error:nil];
+        if (handle != nil)
+        {
+            filenames.push_back(filename);
+            [handles addObject:handle];
+            [handle release];
+        }
+        return handle;
+    }
+    return nil;
+}
+
+static void EncodeIOTextureLoad(id ioCmdBuffer, MTTexture& textureMT, const FileLoadDescriptor& load, id handle)
+{
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        const TextureRegion&    region          = load.textureRegion;
+        const FormatAttributes& formatAttribs   = GetFormatAttribs(textureMT.GetFormat());
+        const bool              is3D            = (textureMT.GetType() == TextureType::Texture3D);
+
+        /* Texel data is tightly packed in whole blocks, so derive the row and image strides from the block dimensions */
+        const NSUInteger numBlocksX     = (region.extent.width  + formatAttribs.blockWidth  - 1) / formatAttribs.blockWidth;
+        const NSUInteger numBlocksY     = (region.extent.height + formatAttribs.blockHeight - 1) / formatAttribs.blockHeight;
+        const NSUInteger bytesPerRow    = numBlocksX * formatAttribs.bitSize / 8;
+        const NSUInteger bytesPerImage  = numBlocksY * bytesPerRow;
+
+        const MTLSize   size    = MTLSizeMake(region.extent.width, region.extent.height, (is3D ? region.extent.depth : 1));
+        const MTLOrigin origin  = MTLOriginMake(region.offset.x, region.offset.y, (is3D ? region.offset.z : 0));
+
+        /* Array layers and cube faces are separate slices, so each of them is loaded with its own command */
+        const std::uint32_t numSlices       = (is3D ? 1u : std::max(1u, region.subresource.numArrayLayers));
+        const std::uint64_t bytesPerSlice   = bytesPerImage * size.depth;
+
+        for_range(slice, numSlices)
+        {
+            [(id<MTLIOCommandBuffer>)ioCmdBuffer
+                loadTexture:            textureMT.GetNative()
+                slice:                  (is3D ? 0 : region.subresource.baseArrayLayer + slice)
+                level:                  region.subresource.baseMipLevel
+                size:                   size
+                sourceBytesPerRow:      bytesPerRow
+                sourceBytesPerImage:    bytesPerImage
+                destinationOrigin:      origin
+                sourceHandle:           (id<MTLIOFileHandle>)handle
+                sourceHandleOffset:     load.fileOffset + bytesPerSlice * slice
+            ];
+        }
+    }
+}
+
+bool MTRenderSystem::SubmitFileLoadsWithIOQueue(const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        /* Open all files before any load is encoded, so no IO command buffer is committed if one of them is missing */
+        std::vector<const char*> filenames;
+        NSMutableArray* handles = [[NSMutableArray alloc] init];
+        std::vector<id> loadHandles;
+        loadHandles.reserve(loads.size());
+
+        for (const FileLoadDescriptor& load : loads)
+        {
+            id handle = (IsFileLoadValid(load) ? FindOrOpenIOFileHandle(device_, load.filename, filenames, handles) : nil);
+            if (handle == nil)
+            {
+                [handles release];
+                return false;
+            }
+            loadHandles.push_back(handle);
+        }
+
+        /* Encode all loads into a single IO command buffer */
+        id<MTLIOCommandBuffer> ioCmdBuffer = [(id<MTLIOCommandQueue>)ioQueue_ commandBuffer];
+
+        for_range(i, loads.size())
+        {
+            const FileLoadDescriptor& load = loads[i];
+            if (load.resource->GetResourceType() == ResourceType::Buffer)
+            {
+                auto& bufferMT = LLGL_CAST(MTBuffer&, *load.resource);
+                [ioCmdBuffer
+                    loadBuffer:         bufferMT.GetNative()
+                    offset:             load.bufferOffset
+                    size:               load.size
+                    sourceHandle:       (id<MTLIOFileHandle>)loadHandles[i]
+                    sourceHandleOffset: load.fileOffset
+                ];
+            }
+            else
+            {
+                auto& textureMT = LLGL_CAST(MTTexture&, *load.resource);
+                EncodeIOTextureLoad(ioCmdBuffer, textureMT, load, loadHandles[i]);
+            }
+        }
+
+        if (fence != nullptr)
+        {
+            auto* fenceMT = LLGL_CAST(MTFence*, fence);
+            fenceMT->SignalIO(ioCmdBuffer, fenceMT->GetSignaledValue() + 1);
+        }
+
+        /* Keep file handles alive until the IO command buffer has been completed */
+        [ioCmdBuffer addCompletedHandler:^(id<MTLIOCommandBuffer> /*cmdBuffer*/)
+            {
+                [handles release];
+            }
+        ];
+        [ioCmdBuffer commit];
+
+        return true;
+    }
+    return false;
+}
+
 
 } // /namespace LLGL
 
@@ -46,6 +46,8 @@ class MTSwapChain final : public SwapChain
         const RenderPass* GetRenderPass() const override;
 
         bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+        bool SetMaxFrameLatency(std::uint32_t maxFrameLatency) override;
+        bool IsPresentModeSupported(PresentMode presentMode) const override;
 
     public:
 
@@ -62,6 +64,9 @@ class MTSwapChain final : public SwapChain
             return view_;
         }
 
+        // Schedules the presentation of the specified drawable of this swap-chain. Drawables are presented for a minimum duration according to the V-sync interval.
+        void PresentDrawable(id<MTLCommandBuffer> cmdBuffer, id<MTLDrawable> drawable) const;
+
         // Returns the native render pass descriptor <MTLRenderPassDescriptor>.
         inline MTLRenderPassDescriptor* GetNativeRenderPass() const
         {
@@ -82,6 +87,9 @@ class MTSwapChain final : public SwapChain
         MTLRenderPassDescriptor*    nativeMutableRenderPass_    = nullptr; // Cannot be id<>
         MTRenderPass                renderPass_;
 
+        CFTimeInterval              minPresentDuration_         = 0.0; // Minimum duration each drawable is presented for; zero without V-sync
+        PresentMode                 presentMode_                = PresentMode::Default;
+
 };
 
 
@@ -9,6 +9,7 @@
 #include "MTTypes.h"
 #include "RenderState/MTRenderPass.h"
 #include "../TextureUtils.h"
+#include "../HostTrace.h"
 #include <LLGL/Platform/NativeHandle.h>
 
 #import <QuartzCore/CAMetalLayer.h>
@@ -68,10 +69,29 @@ MTSwapChain::MTSwapChain(
     view_.colorPixelFormat          = renderPass_.GetColorAttachments()[0].pixelFormat;
     view_.depthStencilPixelFormat   = renderPass_.GetDepthStencilFormat();
     view_.sampleCount               = renderPass_.GetSampleCount();
+
+    /* Disable display synchronization of the Metal layer for immediate presentation mode */
+    if (IsPresentModeSupported(desc.presentMode))
+    {
+        presentMode_ = desc.presentMode;
+        #ifndef LLGL_OS_IOS
+        if (presentMode_ == PresentMode::Immediate)
+        {
+            if (@available(macOS 10.13, *))
+            {
+                CALayer* layer = view_.layer;
+                if (layer != nil && [layer isKindOfClass:[CAMetalLayer class]])
+                    reinterpret_cast<CAMetalLayer*>(layer).displaySyncEnabled = NO;
+            }
+        }
+        #endif // /LLGL_OS_IOS
+    }
 }
 
 void MTSwapChain::Present()
 {
+    LLGL_HOST_TRACE_SCOPE("Present");
+
     [view_ draw];
 }
 
@@ -108,22 +128,77 @@ const RenderPass* MTSwapChain::GetRenderPass() const
 bool MTSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
 {
     static const NSInteger defaultRefreshRate = 60;
-    if (vsyncInterval > 0)
+    if (vsyncInterval > 0 && presentMode_ != PresentMode::Immediate)
     {
         /* Apply v-sync interval to display refresh rate */
         if (auto display = Display::GetPrimary())
             view_.preferredFramesPerSecond = static_cast<NSInteger>(display->GetDisplayMode().refreshRate / vsyncInterval);
         else
             view_.preferredFramesPerSecond = defaultRefreshRate / static_cast<NSInteger>(vsyncInterval);
+
+        /* Present each drawable for the duration of the v-sync interval to get evenly paced frames */
+        if (view_.preferredFramesPerSecond > 0)
+            minPresentDuration_ = 1.0 / static_cast<CFTimeInterval>(view_.preferredFramesPerSecond);
     }
     else
     {
         /* Set preferred frame rate to default value */
         view_.preferredFramesPerSecond = defaultRefreshRate;
+        minPresentDuration_ = 0.0;
     }
     return true;
 }
 
+bool MTSwapChain::SetMaxFrameLatency(std::uint32_t maxFrameLatency)
+{
+    if (maxFrameLatency == 0)
+        return false;
+
+    /* CAMetalLayer only supports two or three drawables, i.e. one or two frames can be queued while another one is displayed */
+    if (@available(macOS 10.13.2, iOS 11.2, *))
+    {
+        CALayer* layer = view_.layer;
+        if (layer != nil && [layer isKindOfClass:[CAMetalLayer class]])
+        {
+            reinterpret_cast<CAMetalLayer*>(layer).maximumDrawableCount = (maxFrameLatency > 1 ? 3 : 2);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool MTSwapChain::IsPresentModeSupported(PresentMode presentMode) const
+{
+    switch (presentMode)
+    {
+        case PresentMode::Default:
+        case PresentMode::Fifo:
+            return true;
+        #ifndef LLGL_OS_IOS
+        case PresentMode::Immediate:
+            if (@available(macOS 10.13, *))
+                return true;
+            return false;
+        #endif // /LLGL_OS_IOS
+        default:
+            return false;
+    }
+}
+
+void MTSwapChain::PresentDrawable(id<MTLCommandBuffer> cmdBuffer, id<MTLDrawable> drawable) const
+{
+    if (minPresentDuration_ > 0.0)
+    {
+        if (@available(macOS 10.15.4, iOS 10.3, *))
+        {
+            [cmdBuffer presentDrawable:drawable afterMinimumDuration:minPresentDuration_];
+            return;
+        }
+    }
+    [cmdBuffer presentDrawable:drawable];
+}
+
 MTLRenderPassDescriptor* MTSwapChain::GetAndUpdateNativeRenderPass(
     const MTRenderPass& renderPass,
     std::uint32_t       numClearValues,
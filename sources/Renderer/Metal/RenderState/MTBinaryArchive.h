@@ -0,0 +1,69 @@
+/*
+ * MTBinaryArchive.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_MT_BINARY_ARCHIVE_H
+#define LLGL_MT_BINARY_ARCHIVE_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/Blob.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Wrapper for MTLBinaryArchive to store compiled pipeline functions in the serialized cache of a PSO.
+Binary archives are only supported on macOS 11.0 and iOS 14.0 or later. On older systems, this archive is empty and has no effect.
+*/
+class MTBinaryArchive
+{
+
+    public:
+
+        MTBinaryArchive(const MTBinaryArchive&) = delete;
+        MTBinaryArchive& operator = (const MTBinaryArchive&) = delete;
+
+        // Creates a binary archive and loads it from the specified serialized cache if it is not empty. Incompatible caches are ignored.
+        MTBinaryArchive(id<MTLDevice> device, const Blob* serializedCache = nullptr);
+        ~MTBinaryArchive();
+
+        // Adds the archive to the specified pipeline descriptor, so its functions are looked up in the archive before they are compiled.
+        void AttachTo(MTLRenderPipelineDescriptor* psoDesc);
+        void AttachTo(MTLComputePipelineDescriptor* psoDesc);
+
+        // Compiles the functions of the specified pipeline descriptor into this archive.
+        void AddPipelineFunctions(MTLRenderPipelineDescriptor* psoDesc);
+        void AddPipelineFunctions(MTLComputePipelineDescriptor* psoDesc);
+
+        // Serializes this archive into a Blob. Returns an empty Blob if binary archives are not supported.
+        Blob Serialize();
+
+        // Returns the native MTLBinaryArchive object or nil if binary archives are not supported.
+        inline id<MTLBinaryArchive> GetNative() const
+        {
+            return native_;
+        }
+
+    private:
+
+        id<MTLBinaryArchive>    native_     = nil;
+        NSURL*                  loadURL_    = nil; // Temporary file the archive has been loaded from.
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,132 @@
+/*
+ * MTBinaryArchive.mm
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "MTBinaryArchive.h"
+
+
+namespace LLGL
+{
+
+
+// Returns a new URL for a temporary file. Binary archives can only be loaded from and serialized to files.
+static NSURL* MakeTemporaryArchiveURL()
+{
+    NSString* filename = [NSString stringWithFormat:@"LLGL-%@.metallib", [[NSUUID UUID] UUIDString]];
+    return [[NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:filename]] retain];
+}
+
+static void RemoveTemporaryFile(NSURL* url)
+{
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+}
+
+MTBinaryArchive::MTBinaryArchive(id<MTLDevice> device, const Blob* serializedCache)
+{
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        MTLBinaryArchiveDescriptor* archiveDesc = [[MTLBinaryArchiveDescriptor alloc] init];
+
+        /* Write serialized cache into temporary file to load the archive from */
+        if (serializedCache != nullptr && *serializedCache)
+        {
+            loadURL_ = MakeTemporaryArchiveURL();
+            NSData* data = [NSData
+                dataWithBytesNoCopy:    const_cast<void*>(serializedCache->GetData())
+                length:                 serializedCache->GetSize()
+                freeWhenDone:           NO
+            ];
+            if ([data writeToURL:loadURL_ atomically:NO])
+            {
+                archiveDesc.url = loadURL_;
+                native_ = [device newBinaryArchiveWithDescriptor:archiveDesc error:nil];
+            }
+        }
+
+        /* Create empty archive if there was no cache or it was created on a different device or OS version */
+        if (native_ == nil)
+        {
+            archiveDesc.url = nil;
+            native_ = [device newBinaryArchiveWithDescriptor:archiveDesc error:nil];
+        }
+
+        [archiveDesc release];
+    }
+}
+
+MTBinaryArchive::~MTBinaryArchive()
+{
+    [native_ release];
+    if (loadURL_ != nil)
+    {
+        RemoveTemporaryFile(loadURL_);
+        [loadURL_ release];
+    }
+}
+
+void MTBinaryArchive::AttachTo(MTLRenderPipelineDescriptor* psoDesc)
+{
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        if (native_ != nil)
+            psoDesc.binaryArchives = @[native_];
+    }
+}
+
+void MTBinaryArchive::AttachTo(MTLComputePipelineDescriptor* psoDesc)
+{
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        if (native_ != nil)
+            psoDesc.binaryArchives = @[native_];
+    }
+}
+
+void MTBinaryArchive::AddPipelineFunctions(MTLRenderPipelineDescriptor* psoDesc)
+{
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        /* Functions that cannot be archived are compiled when the PSO is created, so errors are ignored here */
+        if (native_ != nil)
+            [native_ addRenderPipelineFunctionsWithDescriptor:psoDesc error:nil];
+    }
+}
+
+void MTBinaryArchive::AddPipelineFunctions(MTLComputePipelineDescriptor* psoDesc)
+{
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        if (native_ != nil)
+            [native_ addComputePipelineFunctionsWithDescriptor:psoDesc error:nil];
+    }
+}
+
+Blob MTBinaryArchive::Serialize()
+{
+    Blob blob;
+
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        if (native_ != nil)
+        {
+            /* Serialize archive into temporary file and read it back into a Blob */
+            NSURL* url = MakeTemporaryArchiveURL();
+            if ([native_ serializeToURL:url error:nil])
+                blob = Blob::CreateFromFile([[url path] UTF8String]);
+            RemoveTemporaryFile(url);
+            [url release];
+        }
+    }
+
+    return blob;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -11,6 +11,8 @@
 
 #import <Metal/Metal.h>
 
+#include <LLGL/ShaderFlags.h>
+
 
 namespace LLGL
 {
@@ -20,6 +22,8 @@ namespace LLGL
 enum class MTBuiltinComputePSO
 {
     FillBufferByte4 = 0,
+    FillBufferWide,     // Fills four 32-bit values per thread.
+    CopyBufferStrided,  // Copies rows of 32-bit values between buffers with different row strides.
     Num
 };
 
@@ -49,7 +53,8 @@ class MTBuiltinPSOFactory
             id<MTLDevice>               device,
             const MTBuiltinComputePSO   builtin,
             const char*                 kernelFunc,
-            std::size_t                 kernelFuncSize
+            std::size_t                 kernelFuncSize,
+            const ShaderSourceType      kernelFuncType  = ShaderSourceType::BinaryBuffer
         );
 
     private:
@@ -24,6 +24,8 @@ MTBuiltinPSOFactory& MTBuiltinPSOFactory::Get()
 void MTBuiltinPSOFactory::CreateBuiltinPSOs(id<MTLDevice> device)
 {
     LoadBuiltinComputePSO(device, MTBuiltinComputePSO::FillBufferByte4, g_metalLibFillBufferByte4, g_metalLibFillBufferByte4Len);
+    LoadBuiltinComputePSO(device, MTBuiltinComputePSO::FillBufferWide, g_metalSrcFillBufferWide, g_metalSrcFillBufferWideLen, ShaderSourceType::CodeString);
+    LoadBuiltinComputePSO(device, MTBuiltinComputePSO::CopyBufferStrided, g_metalSrcCopyBufferStrided, g_metalSrcCopyBufferStridedLen, ShaderSourceType::CodeString);
 }
 
 id<MTLComputePipelineState> MTBuiltinPSOFactory::GetComputePSO(const MTBuiltinComputePSO builtin) const
@@ -44,7 +46,8 @@ void MTBuiltinPSOFactory::LoadBuiltinComputePSO(
     id<MTLDevice>               device,
     const MTBuiltinComputePSO   builtin,
     const char*                 kernelFunc,
-    std::size_t                 kernelFuncSize)
+    std::size_t                 kernelFuncSize,
+    const ShaderSourceType      kernelFuncType)
 {
     /* Load compute shader function */
     ShaderDescriptor shaderDesc;
@@ -52,7 +55,7 @@ void MTBuiltinPSOFactory::LoadBuiltinComputePSO(
         shaderDesc.type         = ShaderType::Compute;
         shaderDesc.source       = kernelFunc;
         shaderDesc.sourceSize   = kernelFuncSize;
-        shaderDesc.sourceType   = ShaderSourceType::BinaryBuffer;
+        shaderDesc.sourceType   = kernelFuncType;
         shaderDesc.entryPoint   = "CS";
         shaderDesc.profile      = "1.1";
     }
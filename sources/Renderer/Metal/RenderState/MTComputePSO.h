@@ -24,7 +24,8 @@ class MTComputePSO final : public MTPipelineState
 
     public:
 
-        MTComputePSO(id<MTLDevice> device, const ComputePipelineDescriptor& desc);
+        MTComputePSO(id<MTLDevice> device, const ComputePipelineDescriptor& desc, Blob* serializedCache = nullptr);
+        ~MTComputePSO();
 
         // Binds the compute pipeline state with the specified command encoder.
         void Bind(id<MTLComputeCommandEncoder> computeEncoder);
@@ -37,11 +38,8 @@ class MTComputePSO final : public MTPipelineState
 
     private:
 
-        id<MTLComputePipelineState> CreateNativeComputePipelineState(
-            id<MTLDevice>   device,
-            id<MTLFunction> function,
-            NSError*&       error
-        );
+        // Creates the native compute pipeline state asynchronously. Errors are written to the PSO report.
+        void CreateNativeComputePipelineState(id<MTLDevice> device, MTLComputePipelineDescriptor* desc);
 
     private:
 
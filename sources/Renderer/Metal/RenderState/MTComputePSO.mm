@@ -19,7 +19,7 @@ namespace LLGL
 {
 
 
-MTComputePSO::MTComputePSO(id<MTLDevice> device, const ComputePipelineDescriptor& desc) :
+MTComputePSO::MTComputePSO(id<MTLDevice> device, const ComputePipelineDescriptor& desc, Blob* serializedCache) :
     MTPipelineState { /*isGraphicsPSO:*/ false, desc.pipelineLayout }
 {
     /* Get native shader functions */
@@ -31,16 +31,31 @@ MTComputePSO::MTComputePSO(id<MTLDevice> device, const ComputePipelineDescriptor
     if (!kernelFunc)
         throw std::invalid_argument("cannot create Metal compute pipeline without valid compute kernel function");
 
-    /* Create native compute pipeline state */
-    NSError* error = nullptr;
-    computePipelineState_ = CreateNativeComputePipelineState(device, kernelFunc, error);
-    if (!computePipelineState_)
-        MTThrowIfCreateFailed(error, "MTLComputePipelineState");
+    MTLComputePipelineDescriptor* psoDesc = [[MTLComputePipelineDescriptor alloc] init];
+    {
+        psoDesc.computeFunction = kernelFunc;
+    }
+
+    /* Store compiled kernel function in a binary archive that is returned in the serialized cache */
+    if (serializedCache != nullptr)
+        CreateBinaryArchive(device, psoDesc, *serializedCache);
+
+    /* Create native compute pipeline state in the background */
+    CreateNativeComputePipelineState(device, psoDesc);
+    [psoDesc release];
+}
+
+MTComputePSO::~MTComputePSO()
+{
+    /* Completion handler writes to this PSO, so it must have finished before this PSO is destroyed */
+    WaitUntilCreated();
 }
 
 void MTComputePSO::Bind(id<MTLComputeCommandEncoder> computeEncoder)
 {
-    [computeEncoder setComputePipelineState:computePipelineState_];
+    /* Native PSO is null if its creation failed, see PSO report */
+    if (computePipelineState_ != nil)
+        [computeEncoder setComputePipelineState:computePipelineState_];
 
     if (auto* pipelineLayout = GetPipelineLayout())
         pipelineLayout->SetStaticKernelSamplers(computeEncoder);
@@ -51,26 +66,27 @@ void MTComputePSO::Bind(id<MTLComputeCommandEncoder> computeEncoder)
  * ======= Private: =======
  */
 
-id<MTLComputePipelineState> MTComputePSO::CreateNativeComputePipelineState(
-    id<MTLDevice>   device,
-    id<MTLFunction> function,
-    NSError*&       error)
+void MTComputePSO::CreateNativeComputePipelineState(id<MTLDevice> device, MTLComputePipelineDescriptor* desc)
 {
-    if (NeedsConstantsCache())
-    {
-        /* Create PSO with reflection to generate constants cache */
-        MTLAutoreleasedComputePipelineReflection reflection = nil;
-        id<MTLComputePipelineState> pso = [device
-            newComputePipelineStateWithFunction:    function
-            options:                                (MTLPipelineOptionArgumentInfo | MTLPipelineOptionBufferTypeInfo)
-            reflection:                             &reflection
-            error:                                  &error
-        ];
-        CreateConstantsCacheForComputePipeline(reflection);
-        return pso;
-    }
-    else
-        return [device newComputePipelineStateWithFunction:function error:&error];
+    /* Create PSO with reflection to generate constants cache if necessary */
+    const bool needsConstantsCache = NeedsConstantsCache();
+    BeginAsyncCreation();
+    [device
+        newComputePipelineStateWithDescriptor:  desc
+        options:                                GetNativePipelineOptions()
+        completionHandler:                      ^(id<MTLComputePipelineState> pso, MTLComputePipelineReflection* reflection, NSError* error)
+        {
+            if (pso != nil)
+            {
+                computePipelineState_ = [pso retain];
+                if (needsConstantsCache)
+                    CreateConstantsCacheForComputePipeline(reflection);
+            }
+            else
+                ResetReport(MTGetCreateFailedMessage(error, "MTLComputePipelineState") + "\n", true);
+            EndAsyncCreation();
+        }
+    ];
 }
 
 
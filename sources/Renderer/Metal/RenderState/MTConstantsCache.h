@@ -25,6 +25,7 @@ namespace LLGL
 
 
 class MTShader;
+class MTStagingBufferPool;
 
 struct MTShaderReflectionArguments
 {
@@ -32,7 +33,11 @@ struct MTShaderReflectionArguments
     const NSArray<MTLArgument*>*    args;
 };
 
-// Manages the shader constants data for uniforms. Maximum size of such a cache is 4KB (as per Metal spec.).
+/*
+Manages the shader constants data for uniforms.
+Constants are written to a per-frame staging buffer pool and bound by their offset within that pool.
+Without such a pool, constants are copied with 'set*Bytes' and the maximum size of such a cache is 4KB (as per Metal spec.).
+*/
 class MTConstantsCache
 {
 
@@ -47,16 +52,21 @@ class MTConstantsCache
         );
 
         // Resets the dirty bits which will bind all resources on the next flush, i.e. IsInvalidated() returns true.
+        // This must be called whenever this cache is used with a different command encoder.
         void Reset();
 
         // Sets the specified resource in this cache.
         void SetUniforms(std::uint32_t first, const void* data, std::uint16_t dataSize);
 
-        // Flushes the pending descriptors to the specified command encoder.
-        void FlushGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder);
-        void FlushGraphicsResourcesForced(id<MTLRenderCommandEncoder> renderEncoder);
-        void FlushComputeResources(id<MTLComputeCommandEncoder> computeEncoder);
-        void FlushComputeResourcesForced(id<MTLComputeCommandEncoder> computeEncoder);
+        /*
+        Flushes the pending descriptors to the specified command encoder.
+        If a constants pool is specified, the constants are written to that pool and only the buffer offset is updated
+        if the same pool chunk is still bound to the command encoder.
+        */
+        void FlushGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder, MTStagingBufferPool* constantsPool = nullptr);
+        void FlushGraphicsResourcesForced(id<MTLRenderCommandEncoder> renderEncoder, MTStagingBufferPool* constantsPool = nullptr);
+        void FlushComputeResources(id<MTLComputeCommandEncoder> computeEncoder, MTStagingBufferPool* constantsPool = nullptr);
+        void FlushComputeResourcesForced(id<MTLComputeCommandEncoder> computeEncoder, MTStagingBufferPool* constantsPool = nullptr);
 
         // Returns true if this cache has been invalidated.
         inline bool IsInvalidated() const
@@ -82,6 +92,12 @@ class MTConstantsCache
             std::uint16_t   size;
         };
 
+        // Native pool buffers that are currently bound to the command encoder for a constant buffer. Index 0 for vertex or kernel stage, 1 for fragment stage.
+        struct BoundConstantBuffer
+        {
+            id<MTLBuffer> perStage[MTShaderStage_CountPerPSO] = { nil, nil };
+        };
+
         struct MTShaderBufferField
         {
             NSUInteger uniformIndex;    // Index to the uniform descriptor
@@ -135,6 +151,7 @@ class MTConstantsCache
         std::vector<ConstantLocation>       constantsMap_;
         std::vector<ConstantBuffer>         constantBuffers_;
         std::unique_ptr<char[]>             constants_;
+        std::vector<BoundConstantBuffer>    boundConstantBuffers_;
 
         union
         {
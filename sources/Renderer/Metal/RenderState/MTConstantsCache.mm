@@ -7,10 +7,12 @@
 
 #include "MTConstantsCache.h"
 #include "../Shader/MTShader.h"
+#include "../Buffer/MTStagingBufferPool.h"
 #include "../../PipelineStateUtils.h"
 #include "../../../Core/CoreUtils.h"
 #include "../../../Core/MacroUtils.h"
 #include <LLGL/Utils/ForRange.h>
+#include <LLGL/Platform/Platform.h>
 #include <vector>
 #include <string.h>
 
@@ -19,6 +21,13 @@ namespace LLGL
 {
 
 
+// Minimum offset alignment for buffers in the 'constant' address space (see Metal feature set tables).
+#ifdef LLGL_OS_IOS
+static constexpr NSUInteger g_constantBufferOffsetAlignment = 16;
+#else
+static constexpr NSUInteger g_constantBufferOffsetAlignment = 256;
+#endif
+
 MTConstantsCache::MTConstantsCache(
     const ArrayView<MTShaderReflectionArguments>&   reflectionArgs,
     const ArrayView<UniformDescriptor>&             uniformDescs)
@@ -84,12 +93,21 @@ MTConstantsCache::MTConstantsCache(
         }
     }
 
+    boundConstantBuffers_.resize(constantBuffers_.size());
+
     Reset();
 }
 
 void MTConstantsCache::Reset()
 {
     dirtyBits_.bits = 0xFF;
+
+    /* Pool buffers must be bound again, since the command encoder may have changed */
+    for (BoundConstantBuffer& boundBuffer : boundConstantBuffers_)
+    {
+        for (id<MTLBuffer>& buffer : boundBuffer.perStage)
+            buffer = nil;
+    }
 }
 
 void MTConstantsCache::SetUniforms(std::uint32_t first, const void* data, std::uint16_t dataSize)
@@ -112,50 +130,110 @@ void MTConstantsCache::SetUniforms(std::uint32_t first, const void* data, std::u
         dataSize -= constant.size;
         bytes += constant.size;
     }
-    Reset();
+
+    /* Only invalidate constant data; pool buffers that are already bound to the encoder only need a new offset */
+    dirtyBits_.bits = 0xFF;
 }
 
-void MTConstantsCache::FlushGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder)
+void MTConstantsCache::FlushGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder, MTStagingBufferPool* constantsPool)
 {
     if (dirtyBits_.graphics != 0)
-        FlushGraphicsResourcesForced(renderEncoder);
+        FlushGraphicsResourcesForced(renderEncoder, constantsPool);
 }
 
-void MTConstantsCache::FlushGraphicsResourcesForced(id<MTLRenderCommandEncoder> renderEncoder)
+void MTConstantsCache::FlushGraphicsResourcesForced(id<MTLRenderCommandEncoder> renderEncoder, MTStagingBufferPool* constantsPool)
 {
-    for (const auto& constantBuffer : constantBuffers_)
+    if (constantsPool != nullptr)
     {
-        if ((constantBuffer.stages & StageFlags::VertexStage) != 0)
+        for_range(i, constantBuffers_.size())
         {
-            [renderEncoder
-                setVertexBytes: constants_.get() + constantBuffer.offset
-                length:         constantBuffer.size
-                atIndex:        constantBuffer.index
-            ];
+            const auto& constantBuffer = constantBuffers_[i];
+            if ((constantBuffer.stages & (StageFlags::VertexStage | StageFlags::FragmentStage)) == 0)
+                continue;
+
+            /* Write constants once into the pool, they are shared between vertex and fragment stage */
+            id<MTLBuffer> buffer = nil;
+            NSUInteger offset = 0;
+            constantsPool->Write(constants_.get() + constantBuffer.offset, constantBuffer.size, buffer, offset, g_constantBufferOffsetAlignment);
+
+            auto& boundBuffer = boundConstantBuffers_[i];
+            if ((constantBuffer.stages & StageFlags::VertexStage) != 0)
+            {
+                if (boundBuffer.perStage[0] == buffer)
+                    [renderEncoder setVertexBufferOffset:offset atIndex:constantBuffer.index];
+                else
+                {
+                    [renderEncoder setVertexBuffer:buffer offset:offset atIndex:constantBuffer.index];
+                    boundBuffer.perStage[0] = buffer;
+                }
+            }
+            if ((constantBuffer.stages & StageFlags::FragmentStage) != 0)
+            {
+                if (boundBuffer.perStage[1] == buffer)
+                    [renderEncoder setFragmentBufferOffset:offset atIndex:constantBuffer.index];
+                else
+                {
+                    [renderEncoder setFragmentBuffer:buffer offset:offset atIndex:constantBuffer.index];
+                    boundBuffer.perStage[1] = buffer;
+                }
+            }
         }
-        if ((constantBuffer.stages & StageFlags::FragmentStage) != 0)
+    }
+    else
+    {
+        for (const auto& constantBuffer : constantBuffers_)
         {
-            [renderEncoder
-                setFragmentBytes:   constants_.get() + constantBuffer.offset
-                length:             constantBuffer.size
-                atIndex:            constantBuffer.index
-            ];
+            if ((constantBuffer.stages & StageFlags::VertexStage) != 0)
+            {
+                [renderEncoder
+                    setVertexBytes: constants_.get() + constantBuffer.offset
+                    length:         constantBuffer.size
+                    atIndex:        constantBuffer.index
+                ];
+            }
+            if ((constantBuffer.stages & StageFlags::FragmentStage) != 0)
+            {
+                [renderEncoder
+                    setFragmentBytes:   constants_.get() + constantBuffer.offset
+                    length:             constantBuffer.size
+                    atIndex:            constantBuffer.index
+                ];
+            }
         }
     }
     dirtyBits_.graphics = 0;
 }
 
-void MTConstantsCache::FlushComputeResources(id<MTLComputeCommandEncoder> computeEncoder)
+void MTConstantsCache::FlushComputeResources(id<MTLComputeCommandEncoder> computeEncoder, MTStagingBufferPool* constantsPool)
 {
     if (dirtyBits_.compute != 0)
-        FlushComputeResourcesForced(computeEncoder);
+        FlushComputeResourcesForced(computeEncoder, constantsPool);
 }
 
-void MTConstantsCache::FlushComputeResourcesForced(id<MTLComputeCommandEncoder> computeEncoder)
+void MTConstantsCache::FlushComputeResourcesForced(id<MTLComputeCommandEncoder> computeEncoder, MTStagingBufferPool* constantsPool)
 {
-    for (const auto& constantBuffer : constantBuffers_)
+    for_range(i, constantBuffers_.size())
     {
-        if ((constantBuffer.stages & StageFlags::ComputeStage) != 0)
+        const auto& constantBuffer = constantBuffers_[i];
+        if ((constantBuffer.stages & StageFlags::ComputeStage) == 0)
+            continue;
+
+        if (constantsPool != nullptr)
+        {
+            id<MTLBuffer> buffer = nil;
+            NSUInteger offset = 0;
+            constantsPool->Write(constants_.get() + constantBuffer.offset, constantBuffer.size, buffer, offset, g_constantBufferOffsetAlignment);
+
+            auto& boundBuffer = boundConstantBuffers_[i];
+            if (boundBuffer.perStage[0] == buffer)
+                [computeEncoder setBufferOffset:offset atIndex:constantBuffer.index];
+            else
+            {
+                [computeEncoder setBuffer:buffer offset:offset atIndex:constantBuffer.index];
+                boundBuffer.perStage[0] = buffer;
+            }
+        }
+        else
         {
             [computeEncoder
                 setBytes:   constants_.get() + constantBuffer.offset
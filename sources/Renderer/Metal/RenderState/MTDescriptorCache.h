@@ -47,6 +47,12 @@ class MTDescriptorCache
         // Sets the specified resource in this cache.
         void SetResource(std::uint32_t descriptor, Resource& resource);
 
+        /*
+        Sets the specified buffer with an offset in this cache.
+        If the same buffer is already bound to this descriptor, only its offset is updated with the next flush, e.g. via 'setVertexBufferOffset:atIndex:'.
+        */
+        void SetBufferRange(std::uint32_t descriptor, Buffer& buffer, NSUInteger offset);
+
         // Flushes the pending descriptors to the specified command encoder.
         void FlushGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder);
         void FlushGraphicsResourcesForced(id<MTLRenderCommandEncoder> renderEncoder);
@@ -64,6 +70,8 @@ class MTDescriptorCache
         struct MTDynamicResourceBinding
         {
             id                      resource    = nil;
+            NSUInteger              offset      = 0;
+            bool                    offsetOnly  = false;    // Only the offset of the bound buffer has changed since the last flush.
             MTDynamicResourceLayout layout;
         };
 
@@ -36,6 +36,10 @@ void MTDescriptorCache::Reset()
     dirtyBindings_[3]   = ~0ull;
     dirtyRange_[0]      = 0;
     dirtyRange_[1]      = static_cast<std::uint8_t>(bindings_.size());
+
+    /* New command encoders have no buffers bound, so offsets cannot be updated in place */
+    for (auto& binding : bindings_)
+        binding.offsetOnly = false;
 }
 
 void MTDescriptorCache::Clear()
@@ -61,12 +65,15 @@ void MTDescriptorCache::SetResource(std::uint32_t descriptor, Resource& resource
     switch (binding.layout.type)
     {
         case ResourceType::Undefined:
+        case ResourceType::AccelerationStructure:
         break;
 
         case ResourceType::Buffer:
         {
             auto& bufferMT = LLGL_CAST(MTBuffer&, resource);
-            binding.resource = bufferMT.GetNative();
+            binding.resource    = bufferMT.GetNative();
+            binding.offset      = 0;
+            binding.offsetOnly  = false;
         }
         break;
 
@@ -88,6 +95,27 @@ void MTDescriptorCache::SetResource(std::uint32_t descriptor, Resource& resource
     InvalidateBinding(static_cast<std::uint8_t>(descriptor));
 }
 
+void MTDescriptorCache::SetBufferRange(std::uint32_t descriptor, Buffer& buffer, NSUInteger offset)
+{
+    if (descriptor >= bindings_.size())
+        return /*Out of range*/;
+
+    auto& binding = bindings_[descriptor];
+    if (binding.layout.type != ResourceType::Buffer)
+        return /*Type mismatch*/;
+
+    auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+    id<MTLBuffer> bufferNative = bufferMT.GetNative();
+
+    /* Only update the offset if the same buffer has already been submitted to the encoder */
+    const std::uint8_t index = static_cast<std::uint8_t>(descriptor);
+    binding.offsetOnly  = (binding.resource == bufferNative && (!IsBindingInvalidated(index) || binding.offsetOnly));
+    binding.resource    = bufferNative;
+    binding.offset      = offset;
+
+    InvalidateBinding(index);
+}
+
 void MTDescriptorCache::FlushGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder)
 {
     if (dirtyRange_[0] < dirtyRange_[1])
@@ -95,7 +123,10 @@ void MTDescriptorCache::FlushGraphicsResources(id<MTLRenderCommandEncoder> rende
         for_subrange(i, dirtyRange_[0], dirtyRange_[1])
         {
             if (IsBindingInvalidated(i))
+            {
                 BindGraphicsResource(renderEncoder, bindings_[i]);
+                bindings_[i].offsetOnly = false;
+            }
         }
         Clear();
     }
@@ -103,8 +134,11 @@ void MTDescriptorCache::FlushGraphicsResources(id<MTLRenderCommandEncoder> rende
 
 void MTDescriptorCache::FlushGraphicsResourcesForced(id<MTLRenderCommandEncoder> renderEncoder)
 {
-    for (const auto& binding : bindings_)
+    for (auto& binding : bindings_)
+    {
+        binding.offsetOnly = false;
         BindGraphicsResource(renderEncoder, binding);
+    }
     Clear();
 }
 
@@ -115,7 +149,10 @@ void MTDescriptorCache::FlushComputeResources(id<MTLComputeCommandEncoder> compu
         for_subrange(i, dirtyRange_[0], dirtyRange_[1])
         {
             if (IsBindingInvalidated(i))
+            {
                 BindComputeResource(computeEncoder, bindings_[i]);
+                bindings_[i].offsetOnly = false;
+            }
         }
         Clear();
     }
@@ -123,8 +160,11 @@ void MTDescriptorCache::FlushComputeResources(id<MTLComputeCommandEncoder> compu
 
 void MTDescriptorCache::FlushComputeResourcesForced(id<MTLComputeCommandEncoder> computeEncoder)
 {
-    for (const auto& binding : bindings_)
+    for (auto& binding : bindings_)
+    {
+        binding.offsetOnly = false;
         BindComputeResource(computeEncoder, binding);
+    }
     Clear();
 }
 
@@ -140,20 +180,86 @@ void MTDescriptorCache::BuildResourceBindings(const ArrayView<MTDynamicResourceL
         bindings_[i].layout = bindings[i];
 }
 
+// Binds the resource to the object and mesh functions; these stages are only supported for individual bindings.
+static void BindMeshStageResource(id<MTLRenderCommandEncoder> renderEncoder, const MTDynamicResourceBinding& binding)
+{
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        const bool isObjectStage    = ((binding.layout.stages & StageFlags::TaskStage) != 0);
+        const bool isMeshStage      = ((binding.layout.stages & StageFlags::MeshStage) != 0);
+        switch (binding.layout.type)
+        {
+            case ResourceType::Undefined:
+            case ResourceType::AccelerationStructure:
+            break;
+
+            case ResourceType::Buffer:
+            {
+                auto buffer = static_cast<id<MTLBuffer>>(binding.resource);
+                if (binding.offsetOnly)
+                {
+                    if (isObjectStage)
+                        [renderEncoder setObjectBufferOffset:binding.offset atIndex:binding.layout.slot];
+                    if (isMeshStage)
+                        [renderEncoder setMeshBufferOffset:binding.offset atIndex:binding.layout.slot];
+                    break;
+                }
+                if (isObjectStage)
+                    [renderEncoder setObjectBuffer:buffer offset:binding.offset atIndex:binding.layout.slot];
+                if (isMeshStage)
+                    [renderEncoder setMeshBuffer:buffer offset:binding.offset atIndex:binding.layout.slot];
+            }
+            break;
+
+            case ResourceType::Texture:
+            {
+                auto texture = static_cast<id<MTLTexture>>(binding.resource);
+                if (isObjectStage)
+                    [renderEncoder setObjectTexture:texture atIndex:binding.layout.slot];
+                if (isMeshStage)
+                    [renderEncoder setMeshTexture:texture atIndex:binding.layout.slot];
+            }
+            break;
+
+            case ResourceType::Sampler:
+            {
+                auto samplerState = static_cast<id<MTLSamplerState>>(binding.resource);
+                if (isObjectStage)
+                    [renderEncoder setObjectSamplerState:samplerState atIndex:binding.layout.slot];
+                if (isMeshStage)
+                    [renderEncoder setMeshSamplerState:samplerState atIndex:binding.layout.slot];
+            }
+            break;
+        }
+    }
+}
+
 void MTDescriptorCache::BindGraphicsResource(id<MTLRenderCommandEncoder> renderEncoder, const MTDynamicResourceBinding& binding)
 {
+    if ((binding.layout.stages & (StageFlags::TaskStage | StageFlags::MeshStage)) != 0)
+        BindMeshStageResource(renderEncoder, binding);
+
     switch (binding.layout.type)
     {
         case ResourceType::Undefined:
+        case ResourceType::AccelerationStructure:
         break;
 
         case ResourceType::Buffer:
         {
+            if (binding.offsetOnly)
+            {
+                if ((binding.layout.stages & StageFlags::VertexStage) != 0)
+                    [renderEncoder setVertexBufferOffset:binding.offset atIndex:binding.layout.slot];
+                if ((binding.layout.stages & StageFlags::FragmentStage) != 0)
+                    [renderEncoder setFragmentBufferOffset:binding.offset atIndex:binding.layout.slot];
+                break;
+            }
             if ((binding.layout.stages & StageFlags::VertexStage) != 0)
             {
                 [renderEncoder
                     setVertexBuffer:    static_cast<id<MTLBuffer>>(binding.resource)
-                    offset:             0
+                    offset:             binding.offset
                     atIndex:            binding.layout.slot
                 ];
             }
@@ -161,7 +267,7 @@ void MTDescriptorCache::BindGraphicsResource(id<MTLRenderCommandEncoder> renderE
             {
                 [renderEncoder
                     setFragmentBuffer:  static_cast<id<MTLBuffer>>(binding.resource)
-                    offset:             0
+                    offset:             binding.offset
                     atIndex:            binding.layout.slot
                 ];
             }
@@ -213,17 +319,23 @@ void MTDescriptorCache::BindComputeResource(id<MTLComputeCommandEncoder> compute
     switch (binding.layout.type)
     {
         case ResourceType::Undefined:
+        case ResourceType::AccelerationStructure:
         break;
 
         case ResourceType::Buffer:
         {
             if ((binding.layout.stages & StageFlags::ComputeStage) != 0)
             {
-                [computeEncoder
-                    setBuffer:  static_cast<id<MTLBuffer>>(binding.resource)
-                    offset:     0
-                    atIndex:    binding.layout.slot
-                ];
+                if (binding.offsetOnly)
+                    [computeEncoder setBufferOffset:binding.offset atIndex:binding.layout.slot];
+                else
+                {
+                    [computeEncoder
+                        setBuffer:  static_cast<id<MTLBuffer>>(binding.resource)
+                        offset:     binding.offset
+                        atIndex:    binding.layout.slot
+                    ];
+                }
             }
         }
         break;
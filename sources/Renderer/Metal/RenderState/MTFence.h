@@ -12,13 +12,14 @@
 #import <Metal/Metal.h>
 
 #include <LLGL/Fence.h>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
-//TODO: currently unused
+// Metal fence that is backed by a shared event to synchronize the CPU with the GPU and command queues with each other.
 class MTFence final : public Fence
 {
 
@@ -27,14 +28,30 @@ class MTFence final : public Fence
         MTFence(id<MTLDevice> device);
         ~MTFence();
 
-        inline id<MTLFence> GetNative() const
+        // Encodes a signal of the specified value into the command buffer.
+        void Signal(id<MTLCommandBuffer> cmdBuffer, std::uint64_t value);
+
+        // Encodes a signal of the specified value into the IO command buffer (id<MTLIOCommandBuffer>). Requires shared events.
+        void SignalIO(id ioCmdBuffer, std::uint64_t value);
+
+        // Encodes a wait for the specified value into the command buffer. Has no effect if shared events are not supported.
+        void EncodeWait(id<MTLCommandBuffer> cmdBuffer, std::uint64_t value);
+
+        // Waits on the CPU until the specified value has been signaled or the timeout (in nanoseconds) has expired.
+        bool Wait(std::uint64_t value, std::uint64_t timeout);
+
+        // Returns the value of the last signal that has been encoded.
+        inline std::uint64_t GetSignaledValue() const
         {
-            return native_;
+            return value_;
         }
 
     private:
 
-        id<MTLFence> native_ = nil;
+        id<MTLSharedEvent>      native_         = nil;
+        MTLSharedEventListener* listener_       = nil; // Created with the first CPU wait that is not signaled yet
+        id<MTLCommandBuffer>    lastCmdBuffer_  = nil; // Only used if shared events are not supported
+        std::uint64_t           value_          = 0;
 
 };
 
@@ -6,20 +6,116 @@
  */
 
 #include "MTFence.h"
+#include <dispatch/dispatch.h>
+#include <stdint.h>
 
 
 namespace LLGL
 {
 
 
-MTFence::MTFence(id<MTLDevice> device) :
-    native_ { [device newFence] }
+MTFence::MTFence(id<MTLDevice> device)
 {
+    if (@available(macOS 10.14, iOS 12.0, *))
+        native_ = [device newSharedEvent];
 }
 
 MTFence::~MTFence()
 {
-    [native_ release];
+    if (listener_ != nil)
+        [listener_ release];
+    if (native_ != nil)
+        [native_ release];
+    if (lastCmdBuffer_ != nil)
+        [lastCmdBuffer_ release];
+}
+
+void MTFence::Signal(id<MTLCommandBuffer> cmdBuffer, std::uint64_t value)
+{
+    if (native_ != nil)
+    {
+        if (@available(macOS 10.14, iOS 12.0, *))
+            [cmdBuffer encodeSignalEvent:native_ value:value];
+    }
+    else
+    {
+        /* Keep reference to command buffer to emulate the signal by waiting for its completion */
+        if (lastCmdBuffer_ != nil)
+            [lastCmdBuffer_ release];
+        lastCmdBuffer_ = [cmdBuffer retain];
+    }
+    value_ = value;
+}
+
+void MTFence::SignalIO(id ioCmdBuffer, std::uint64_t value)
+{
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        if (native_ != nil)
+            [(id<MTLIOCommandBuffer>)ioCmdBuffer signalEvent:native_ value:value];
+    }
+    value_ = value;
+}
+
+void MTFence::EncodeWait(id<MTLCommandBuffer> cmdBuffer, std::uint64_t value)
+{
+    if (native_ != nil)
+    {
+        if (@available(macOS 10.14, iOS 12.0, *))
+            [cmdBuffer encodeWaitForEvent:native_ value:value];
+    }
+}
+
+bool MTFence::Wait(std::uint64_t value, std::uint64_t timeout)
+{
+    if (value > value_)
+        return false;
+
+    if (native_ != nil)
+    {
+        if (@available(macOS 10.14, iOS 12.0, *))
+        {
+            if ([native_ signaledValue] >= value)
+                return true;
+            if (timeout == 0)
+                return false;
+
+            /* Block until the shared event listener is notified about the signaled value, instead of polling the event */
+            if (listener_ == nil)
+                listener_ = [[MTLSharedEventListener alloc] init];
+
+            dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+            [native_
+                notifyListener: listener_
+                atValue:        value
+                block:          ^(id<MTLSharedEvent> /*event*/, std::uint64_t /*signaledValue*/)
+                {
+                    dispatch_semaphore_signal(semaphore);
+                }
+            ];
+
+            const dispatch_time_t deadline =
+            (
+                timeout >= static_cast<std::uint64_t>(INT64_MAX)
+                    ? DISPATCH_TIME_FOREVER
+                    : dispatch_time(DISPATCH_TIME_NOW, static_cast<std::int64_t>(timeout))
+            );
+            const bool signaled = (dispatch_semaphore_wait(semaphore, deadline) == 0);
+
+            /* The notification block keeps its own reference to the semaphore in case the wait has timed out */
+            dispatch_release(semaphore);
+
+            return signaled;
+        }
+    }
+    else if (lastCmdBuffer_ != nil)
+    {
+        if (timeout == 0)
+            return ([lastCmdBuffer_ status] == MTLCommandBufferStatusCompleted);
+        [lastCmdBuffer_ waitUntilCompleted];
+    }
+
+    return true;
 }
 
 
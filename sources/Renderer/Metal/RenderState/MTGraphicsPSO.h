@@ -28,8 +28,10 @@ class MTGraphicsPSO final : public MTPipelineState
         MTGraphicsPSO(
             id<MTLDevice>                       device,
             const GraphicsPipelineDescriptor&   desc,
-            const MTRenderPass*                 defaultRenderPass
+            const MTRenderPass*                 defaultRenderPass,
+            Blob*                               serializedCache     = nullptr
         );
+        ~MTGraphicsPSO();
 
         // Binds the render pipeline state, depth-stencil states, and sets the remaining parameters with the specified command encoder.
         void Bind(id<MTLRenderCommandEncoder> renderEncoder);
@@ -73,20 +75,52 @@ class MTGraphicsPSO final : public MTPipelineState
             return stencilRefDynamic_;
         }
 
+        // Returns true if this PSO was created with object and mesh functions instead of a vertex function.
+        inline bool IsMeshPipeline() const
+        {
+            return isMeshPipeline_;
+        }
+
+        // Returns the number of threads per object thread-group for mesh pipelines.
+        inline const MTLSize& GetNumThreadsPerObjectGroup() const
+        {
+            return numThreadsPerObjectGroup_;
+        }
+
+        // Returns the number of threads per mesh thread-group for mesh pipelines.
+        inline const MTLSize& GetNumThreadsPerMeshGroup() const
+        {
+            return numThreadsPerMeshGroup_;
+        }
+
+        // Returns true if draw commands with this PSO can be encoded into an indirect command buffer.
+        inline bool SupportsIndirectCommandBuffers() const
+        {
+            return supportsIndirectCommandBuffers_;
+        }
+
     private:
 
         void CreateRenderPipelineState(
             id<MTLDevice>                       device,
             const GraphicsPipelineDescriptor&   desc,
-            const MTRenderPass*                 defaultRenderPass
+            const MTRenderPass*                 defaultRenderPass,
+            Blob*                               serializedCache
         );
 
-        id<MTLRenderPipelineState> CreateNativeRenderPipelineState(
-            id<MTLDevice>                   device,
-            MTLRenderPipelineDescriptor*    desc,
-            NSError*&                       error
+        // Creates the native render pipeline state asynchronously. Errors are written to the PSO report.
+        void CreateNativeRenderPipelineState(id<MTLDevice> device, MTLRenderPipelineDescriptor* desc);
+
+        // Creates the render pipeline state with object and mesh functions.
+        void CreateMeshRenderPipelineState(
+            id<MTLDevice>                       device,
+            const GraphicsPipelineDescriptor&   desc,
+            const MTRenderPass&                 renderPass
         );
 
+        // Completion handler for both render pipeline state descriptors. Errors are written to the PSO report.
+        void CompleteNativeRenderPipelineState(id<MTLRenderPipelineState> pso, MTLRenderPipelineReflection* reflection, NSError* error, bool needsConstantsCache);
+
         void CreateDepthStencilState(
             id<MTLDevice>                       device,
             const GraphicsPipelineDescriptor&   desc
@@ -105,6 +139,7 @@ class MTGraphicsPSO final : public MTPipelineState
         MTLDepthClipMode            clipMode_               = MTLDepthClipModeClip;
         NSUInteger                  numPatchControlPoints_  = 0;
         MTLPatchType                patchType_              = MTLPatchTypeNone;
+        std::uint32_t               viewMask_               = 0;                    // Multiview mask; each view is amplified into the array layer of its view index.
 
         float                       depthBias_              = 0.0f;
         float                       depthSlope_             = 0.0f;
@@ -118,6 +153,12 @@ class MTGraphicsPSO final : public MTPipelineState
         std::uint32_t               stencilFrontRef_        = 0;
         std::uint32_t               stencilBackRef_         = 0;
 
+        bool                        supportsIndirectCommandBuffers_ = false;
+
+        bool                        isMeshPipeline_                 = false;
+        MTLSize                     numThreadsPerObjectGroup_       = {};
+        MTLSize                     numThreadsPerMeshGroup_         = {};
+
 };
 
 
@@ -12,8 +12,10 @@
 //#include "../Command/MTCommandContext.h"
 #include "../MTTypes.h"
 #include "../MTCore.h"
+#include "../MTFeatureSet.h"
 #include "../../CheckedCast.h"
 #include "../../PipelineStateUtils.h"
+#include "../../RenderPassUtils.h"
 #include <LLGL/PipelineStateFlags.h>
 #include <LLGL/Platform/Platform.h>
 #include <LLGL/Utils/ForRange.h>
@@ -46,7 +48,8 @@ static void FillDefaultMTStencilDesc(MTLStencilDescriptor* dst)
 MTGraphicsPSO::MTGraphicsPSO(
     id<MTLDevice>                       device,
     const GraphicsPipelineDescriptor&   desc,
-    const MTRenderPass*                 defaultRenderPass)
+    const MTRenderPass*                 defaultRenderPass,
+    Blob*                               serializedCache)
 :
     MTPipelineState { /*isGraphicsPSO:*/ true, desc.pipelineLayout }
 {
@@ -68,14 +71,24 @@ MTGraphicsPSO::MTGraphicsPSO(
     blendColor_[2]      = desc.blend.blendFactor[2];
     blendColor_[3]      = desc.blend.blendFactor[3];
 
+    viewMask_           = desc.viewMask;
+
     /* Create render pipeline and depth-stencil states */
-    CreateRenderPipelineState(device, desc, defaultRenderPass);
+    CreateRenderPipelineState(device, desc, defaultRenderPass, serializedCache);
     CreateDepthStencilState(device, desc);
 }
 
+MTGraphicsPSO::~MTGraphicsPSO()
+{
+    /* Completion handler writes to this PSO, so it must have finished before this PSO is destroyed */
+    WaitUntilCreated();
+}
+
 void MTGraphicsPSO::Bind(id<MTLRenderCommandEncoder> renderEncoder)
 {
-    [renderEncoder setRenderPipelineState:renderPipelineState_];
+    /* Native PSO is null if its creation failed, see PSO report */
+    if (renderPipelineState_ != nil)
+        [renderEncoder setRenderPipelineState:renderPipelineState_];
     [renderEncoder setDepthStencilState:depthStencilState_];
     [renderEncoder setCullMode:cullMode_];
     [renderEncoder setFrontFacingWinding:winding_];
@@ -106,6 +119,26 @@ void MTGraphicsPSO::Bind(id<MTLRenderCommandEncoder> renderEncoder)
         ];
     }
 
+    if (viewMask_ != 0)
+    {
+        /* Map each amplified vertex onto the array layer of its view index (see RenderPassDescriptor::viewMask) */
+        if (@available(macOS 10.15.4, iOS 13.0, *))
+        {
+            MTLVertexAmplificationViewMapping viewMappings[32];
+            NSUInteger numViews = 0;
+            for_range(i, 32u)
+            {
+                if ((viewMask_ & (1u << i)) != 0)
+                {
+                    viewMappings[numViews].viewportArrayIndexOffset     = 0;
+                    viewMappings[numViews].renderTargetArrayIndexOffset = i;
+                    ++numViews;
+                }
+            }
+            [renderEncoder setVertexAmplificationCount:numViews viewMappings:viewMappings];
+        }
+    }
+
     if (auto* pipelineLayout = GetPipelineLayout())
     {
         pipelineLayout->SetStaticVertexSamplers(renderEncoder);
@@ -177,11 +210,32 @@ static const MTShader* GetVertexOrPostTessVertexShader(const GraphicsPipelineDes
     return vertexShaderMT;
 }
 
+static const MTRenderPass* GetRenderPassOrDefault(const GraphicsPipelineDescriptor& desc, const MTRenderPass* defaultRenderPass)
+{
+    if (auto renderPass = desc.renderPass)
+        return LLGL_CAST(const MTRenderPass*, renderPass);
+    else if (defaultRenderPass != nullptr)
+        return defaultRenderPass;
+    else
+        throw std::invalid_argument("cannot create graphics pipeline without render pass");
+}
+
 void MTGraphicsPSO::CreateRenderPipelineState(
     id<MTLDevice>                       device,
     const GraphicsPipelineDescriptor&   desc,
-    const MTRenderPass*                 defaultRenderPass)
+    const MTRenderPass*                 defaultRenderPass,
+    Blob*                               serializedCache)
 {
+    /* Get render pass object */
+    const MTRenderPass* renderPassMT = GetRenderPassOrDefault(desc, defaultRenderPass);
+
+    /* Mesh pipelines have their own descriptor and are not stored in binary archives */
+    if (desc.meshShader != nullptr)
+    {
+        CreateMeshRenderPipelineState(device, desc, *renderPassMT);
+        return;
+    }
+
     /* Get native shader functions */
     auto vertexShaderMT = GetVertexOrPostTessVertexShader(desc);
 
@@ -191,15 +245,6 @@ void MTGraphicsPSO::CreateRenderPipelineState(
     if (id<MTLFunction> vertexFunc = vertexShaderMT->GetNative())
         patchType_ = [vertexFunc patchType];
 
-    /* Get render pass object */
-    const MTRenderPass* renderPassMT = nullptr;
-    if (auto renderPass = desc.renderPass)
-        renderPassMT = LLGL_CAST(const MTRenderPass*, renderPass);
-    else if (defaultRenderPass != nullptr)
-        renderPassMT = defaultRenderPass;
-    else
-        throw std::invalid_argument("cannot create graphics pipeline without render pass");
-
     /* Create render pipeline state */
     MTLRenderPipelineDescriptor* psoDesc = [[MTLRenderPipelineDescriptor alloc] init];
     {
@@ -229,6 +274,12 @@ void MTGraphicsPSO::CreateRenderPipelineState(
         psoDesc.rasterizationEnabled            = (desc.rasterizer.discardEnabled ? NO : YES);
         psoDesc.rasterSampleCount               = (desc.rasterizer.multiSampleEnabled ? renderPassMT->GetSampleCount() : 1u);
 
+        if (desc.viewMask != 0)
+        {
+            if (@available(macOS 10.15.4, iOS 13.0, *))
+                psoDesc.maxVertexAmplificationCount = NumMultiviewViews(desc.viewMask);
+        }
+
         /* Specify tessellation state */
         if (numPatchControlPoints_ > 0)
         {
@@ -244,11 +295,26 @@ void MTGraphicsPSO::CreateRenderPipelineState(
             psoDesc.tessellationOutputWindingOrder      = (desc.tessellation.outputWindingCCW ? MTLWindingCounterClockwise : MTLWindingClockwise);
             psoDesc.tessellationPartitionMode           = MTTypes::ToMTLPartitionMode(desc.tessellation.partition);
         }
+        else if (IsIndirectCommandBufferSupported(device))
+        {
+            /* Allow draw commands with this PSO to be encoded into indirect command buffers by multi-submit command buffers */
+            if (GetPipelineLayout() == nullptr || GetPipelineLayout()->IsIndirectCommandBufferCompatible())
+            {
+                if (@available(iOS 12.0, macOS 10.14, *))
+                {
+                    psoDesc.supportIndirectCommandBuffers   = YES;
+                    supportsIndirectCommandBuffers_         = true;
+                }
+            }
+        }
     }
-    NSError* error = nullptr;
-    renderPipelineState_ = CreateNativeRenderPipelineState(device, psoDesc, error);
-    if (!renderPipelineState_)
-        MTThrowIfCreateFailed(error, "MTLRenderPipelineState");
+
+    /* Store compiled pipeline functions in a binary archive that is returned in the serialized cache */
+    if (serializedCache != nullptr)
+        CreateBinaryArchive(device, psoDesc, *serializedCache);
+
+    /* Create render pipeline state in the background */
+    CreateNativeRenderPipelineState(device, psoDesc);
     [psoDesc release];
 
     /* Create compute PSO for tessellation stage */
@@ -256,6 +322,7 @@ void MTGraphicsPSO::CreateRenderPipelineState(
     {
         if (auto tessComputeShaderMT = LLGL_CAST(const MTShader*, desc.tessControlShader))
         {
+            NSError* error = nullptr;
             tessPipelineState_ = [device newComputePipelineStateWithFunction:tessComputeShaderMT->GetNative() error:&error];
             if (!tessPipelineState_)
                 MTThrowIfCreateFailed(error, "MTLComputePipelineState");
@@ -265,26 +332,95 @@ void MTGraphicsPSO::CreateRenderPipelineState(
     }
 }
 
-id<MTLRenderPipelineState> MTGraphicsPSO::CreateNativeRenderPipelineState(
-    id<MTLDevice>                   device,
-    MTLRenderPipelineDescriptor*    desc,
-    NSError*&                       error)
+void MTGraphicsPSO::CreateNativeRenderPipelineState(id<MTLDevice> device, MTLRenderPipelineDescriptor* desc)
 {
-    if (NeedsConstantsCache())
+    /* Create PSO with reflection to generate constants cache if necessary */
+    const bool needsConstantsCache = NeedsConstantsCache();
+    BeginAsyncCreation();
+    [device
+        newRenderPipelineStateWithDescriptor:   desc
+        options:                                GetNativePipelineOptions()
+        completionHandler:                      ^(id<MTLRenderPipelineState> pso, MTLRenderPipelineReflection* reflection, NSError* error)
+        {
+            CompleteNativeRenderPipelineState(pso, reflection, error, needsConstantsCache);
+        }
+    ];
+}
+
+void MTGraphicsPSO::CreateMeshRenderPipelineState(
+    id<MTLDevice>                       device,
+    const GraphicsPipelineDescriptor&   desc,
+    const MTRenderPass&                 renderPass)
+{
+    if (@available(macOS 13.0, iOS 16.0, *))
     {
-        /* Create PSO with reflection to generate constants cache */
-        MTLAutoreleasedRenderPipelineReflection reflection = nil;
-        id<MTLRenderPipelineState> pso = [device
-            newRenderPipelineStateWithDescriptor:   desc
-            options:                                (MTLPipelineOptionArgumentInfo | MTLPipelineOptionBufferTypeInfo)
-            reflection:                             &reflection
-            error:                                  &error
+        /* Store thread-group sizes for DrawMeshTasks, since Metal requires them at encoding time */
+        isMeshPipeline_ = true;
+        if (auto taskShaderMT = LLGL_CAST(const MTShader*, desc.taskShader))
+            numThreadsPerObjectGroup_ = taskShaderMT->GetNumThreadsPerGroup();
+        numThreadsPerMeshGroup_ = LLGL_CAST(const MTShader*, desc.meshShader)->GetNumThreadsPerGroup();
+
+        MTLMeshRenderPipelineDescriptor* psoDesc = [[MTLMeshRenderPipelineDescriptor alloc] init];
+        {
+            psoDesc.objectFunction          = GetNativeMTShader(desc.taskShader);
+            psoDesc.meshFunction            = GetNativeMTShader(desc.meshShader);
+            psoDesc.fragmentFunction        = GetNativeMTShader(desc.fragmentShader);
+            psoDesc.alphaToCoverageEnabled  = MTBoolean(desc.blend.alphaToCoverageEnabled);
+            psoDesc.alphaToOneEnabled       = NO;
+
+            /* Initialize pixel formats from render pass */
+            const auto& colorAttachments = renderPass.GetColorAttachments();
+            for_range(i, std::min(colorAttachments.size(), std::size_t(LLGL_MAX_NUM_COLOR_ATTACHMENTS)))
+            {
+                FillColorAttachmentDesc(
+                    psoDesc.colorAttachments[i],
+                    colorAttachments[i].pixelFormat,
+                    desc.blend,
+                    desc.blend.targets[desc.blend.independentBlendEnabled ? i : 0]
+                );
+            };
+
+            psoDesc.depthAttachmentPixelFormat      = renderPass.GetDepthAttachment().pixelFormat;
+            psoDesc.stencilAttachmentPixelFormat    = renderPass.GetStencilAttachment().pixelFormat;
+            psoDesc.rasterizationEnabled            = (desc.rasterizer.discardEnabled ? NO : YES);
+            psoDesc.rasterSampleCount               = (desc.rasterizer.multiSampleEnabled ? renderPass.GetSampleCount() : 1u);
+
+            if (desc.viewMask != 0)
+                psoDesc.maxVertexAmplificationCount = NumMultiviewViews(desc.viewMask);
+        }
+
+        /* Create render pipeline state in the background */
+        const bool needsConstantsCache = NeedsConstantsCache();
+        BeginAsyncCreation();
+        [device
+            newRenderPipelineStateWithMeshDescriptor:   psoDesc
+            options:                                    GetNativePipelineOptions()
+            completionHandler:                          ^(id<MTLRenderPipelineState> pso, MTLRenderPipelineReflection* reflection, NSError* error)
+            {
+                CompleteNativeRenderPipelineState(pso, reflection, error, needsConstantsCache);
+            }
         ];
-        CreateConstantsCacheForRenderPipeline(reflection);
-        return pso;
+        [psoDesc release];
+    }
+    else
+        throw std::runtime_error("cannot create Metal mesh pipeline without macOS 13.0 or iOS 16.0");
+}
+
+void MTGraphicsPSO::CompleteNativeRenderPipelineState(
+    id<MTLRenderPipelineState>      pso,
+    MTLRenderPipelineReflection*    reflection,
+    NSError*                        error,
+    bool                            needsConstantsCache)
+{
+    if (pso != nil)
+    {
+        renderPipelineState_ = [pso retain];
+        if (needsConstantsCache)
+            CreateConstantsCacheForRenderPipeline(reflection);
     }
     else
-        return [device newRenderPipelineStateWithDescriptor:desc error:&error];
+        ResetReport(MTGetCreateFailedMessage(error, "MTLRenderPipelineState") + "\n", true);
+    EndAsyncCreation();
 }
 
 void MTGraphicsPSO::CreateDepthStencilState(
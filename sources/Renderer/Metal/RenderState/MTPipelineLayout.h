@@ -30,6 +30,11 @@ class MTPipelineLayout final : public PipelineLayout
 
         #include <LLGL/Backend/PipelineLayout.inl>
 
+    public:
+
+        // Buffer slot at which the argument buffer of a bindless resource heap is bound to each shader stage.
+        static constexpr NSUInteger argumentBufferSlot = 29;
+
     public:
 
         MTPipelineLayout(id<MTLDevice> device, const PipelineLayoutDescriptor& desc);
@@ -39,6 +44,13 @@ class MTPipelineLayout final : public PipelineLayout
         void SetStaticFragmentSamplers(id<MTLRenderCommandEncoder> renderEncoder) const;
         void SetStaticKernelSamplers(id<MTLComputeCommandEncoder> computeEncoder) const;
 
+        /*
+        Returns true if draw commands with this layout can be encoded into an indirect command buffer.
+        This is only the case if no textures or samplers are bound to the encoder directly,
+        because commands in an indirect command buffer only inherit buffers from their encoder.
+        */
+        bool IsIndirectCommandBufferCompatible() const;
+
         inline const std::vector<BindingDescriptor>& GetHeapBindings() const
         {
             return heapBindings_;
@@ -54,9 +66,16 @@ class MTPipelineLayout final : public PipelineLayout
             return uniforms_;
         }
 
+        // Returns the argument encoder for the heap bindings or nil if the heap bindings are not encoded into an argument buffer.
+        inline id<MTLArgumentEncoder> GetArgumentEncoder() const
+        {
+            return argumentEncoder_;
+        }
+
     private:
 
         void BuildDynamicBindings(const ArrayView<BindingDescriptor>& bindings);
+        void BuildArgumentEncoder(id<MTLDevice> device, const ArrayView<BindingDescriptor>& bindings);
 
         void BuildStaticSamplers(
             id<MTLDevice>                               device,
@@ -80,6 +99,8 @@ class MTPipelineLayout final : public PipelineLayout
         std::uint32_t                           numStaticSamplerPerStage_[MTShaderStage_Count];
         std::uint32_t                           numStaticSamplers_                              = 0;
 
+        id<MTLArgumentEncoder>                  argumentEncoder_                                = nil;
+
 };
 
 
@@ -7,6 +7,7 @@
 
 #include "MTPipelineLayout.h"
 #include "../Texture/MTSampler.h"
+#include "../MTFeatureSet.h"
 #include <LLGL/Utils/ForRange.h>
 
 
@@ -20,10 +21,15 @@ MTPipelineLayout::MTPipelineLayout(id<MTLDevice> device, const PipelineLayoutDes
 {
     BuildDynamicBindings(desc.bindings);
     BuildStaticSamplers(device, desc.staticSamplers);
+    if (desc.bindlessHeap && !desc.heapBindings.empty() && IsArgumentBuffersTier2Supported(device))
+        BuildArgumentEncoder(device, desc.heapBindings);
 }
 
 MTPipelineLayout::~MTPipelineLayout()
 {
+    if (argumentEncoder_ != nil)
+        [argumentEncoder_ release];
+
     /* Release all static sampler states explicitly */
     for (id<MTLSamplerState> samplerState : staticSamplerStates_)
         [samplerState release];
@@ -84,6 +90,35 @@ void MTPipelineLayout::SetStaticKernelSamplers(id<MTLComputeCommandEncoder> comp
     }
 }
 
+static bool IsResourceTypeBoundToEncoder(ResourceType type)
+{
+    return (type == ResourceType::Texture || type == ResourceType::Sampler);
+}
+
+bool MTPipelineLayout::IsIndirectCommandBufferCompatible() const
+{
+    if (numStaticSamplers_ > 0)
+        return false;
+
+    for (const MTDynamicResourceLayout& binding : dynamicBindings_)
+    {
+        if (IsResourceTypeBoundToEncoder(binding.type))
+            return false;
+    }
+
+    /* Heap bindings are only passed through buffers if they are encoded into an argument buffer */
+    if (argumentEncoder_ == nil)
+    {
+        for (const BindingDescriptor& binding : heapBindings_)
+        {
+            if (IsResourceTypeBoundToEncoder(binding.type))
+                return false;
+        }
+    }
+
+    return true;
+}
+
 
 /*
  * ======= Private: =======
@@ -103,6 +138,49 @@ void MTPipelineLayout::BuildDynamicBindings(const ArrayView<BindingDescriptor>&
         Convert(dynamicBindings_[i], bindings[i]);
 }
 
+static MTLDataType ToMTLArgumentDataType(ResourceType type)
+{
+    switch (type)
+    {
+        case ResourceType::Buffer:  return MTLDataTypePointer;
+        case ResourceType::Texture: return MTLDataTypeTexture;
+        case ResourceType::Sampler: return MTLDataTypeSampler;
+        default:                    return MTLDataTypeNone;
+    }
+}
+
+static MTLArgumentAccess ToMTLArgumentAccess(const BindingDescriptor& binding)
+{
+    if ((binding.bindFlags & BindFlags::Storage) != 0)
+        return MTLArgumentAccessReadWrite;
+    else
+        return MTLArgumentAccessReadOnly;
+}
+
+void MTPipelineLayout::BuildArgumentEncoder(id<MTLDevice> device, const ArrayView<BindingDescriptor>& bindings)
+{
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        /* Declare one argument per heap binding; array elements occupy consecutive argument indices in the argument buffer */
+        NSMutableArray<MTLArgumentDescriptor*>* arguments = [[NSMutableArray alloc] initWithCapacity:bindings.size()];
+
+        for (const BindingDescriptor& binding : bindings)
+        {
+            MTLArgumentDescriptor* argument = [MTLArgumentDescriptor argumentDescriptor];
+            {
+                argument.dataType       = ToMTLArgumentDataType(binding.type);
+                argument.index          = binding.slot.index;
+                argument.arrayLength    = (binding.arraySize > 1 ? binding.arraySize : 0);
+                argument.access         = ToMTLArgumentAccess(binding);
+            }
+            [arguments addObject:argument];
+        }
+
+        argumentEncoder_ = [device newArgumentEncoderWithArguments:arguments];
+        [arguments release];
+    }
+}
+
 void MTPipelineLayout::BuildStaticSamplers(
     id<MTLDevice>                               device,
     const ArrayView<StaticSamplerDescriptor>&   staticSamplerDescs)
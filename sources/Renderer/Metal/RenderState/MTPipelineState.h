@@ -14,6 +14,7 @@
 #include <LLGL/PipelineState.h>
 #include "MTDescriptorCache.h"
 #include "MTConstantsCache.h"
+#include "MTBinaryArchive.h"
 #include <LLGL/Report.h>
 #include <LLGL/Container/ArrayView.h>
 #include <memory>
@@ -33,8 +34,23 @@ class MTPipelineState : public PipelineState
     public:
 
         MTPipelineState(bool isGraphicsPSO, const PipelineLayout* pipelineLayout);
+        ~MTPipelineState();
 
         const Report* GetReport() const override final;
+        bool IsReady() const override final;
+        void Wait() override final;
+
+        // Blocks the calling thread until the native PSO has been created in the background. This must be called before the native PSO or its caches are accessed.
+        void WaitUntilCreated() const;
+
+        // Sets the PSO that is bound in place of this PSO while it is still being created in the background.
+        void SetFallback(PipelineState* fallbackPipelineState);
+
+        /*
+        Returns this PSO if it has been created or if it has no fallback, in which case this blocks until it has been created.
+        Otherwise, returns the fallback PSO.
+        */
+        MTPipelineState& GetReadyOrFallback();
 
         // Returns true if this is a graphics PSO.
         inline bool IsGraphicsPSO() const
@@ -68,6 +84,20 @@ class MTPipelineState : public PipelineState
         // Returns true if this PSO needs a constants cache.
         bool NeedsConstantsCache() const;
 
+        // Returns the native pipeline options to create the PSO with, i.e. with reflection if a constants cache is needed.
+        MTLPipelineOption GetNativePipelineOptions() const;
+
+        /*
+        Creates a binary archive for the specified serialized cache and writes the compiled functions of the PSO descriptor back into it.
+        The archive is attached to the descriptor and kept alive until the native PSO has been created.
+        */
+        void CreateBinaryArchive(id<MTLDevice> device, MTLRenderPipelineDescriptor* psoDesc, Blob& serializedCache);
+        void CreateBinaryArchive(id<MTLDevice> device, MTLComputePipelineDescriptor* psoDesc, Blob& serializedCache);
+
+        // Marks the beginning and end of an asynchronous creation of the native PSO. EndAsyncCreation is called from the completion handler.
+        void BeginAsyncCreation();
+        void EndAsyncCreation();
+
         // Creates the constants cache for the specified PSO reflection.
         void CreateConstantsCacheForRenderPipeline(MTLRenderPipelineReflection* reflection);
         void CreateConstantsCacheForComputePipeline(MTLComputePipelineReflection* reflection);
@@ -86,6 +116,10 @@ class MTPipelineState : public PipelineState
         std::unique_ptr<MTConstantsCache>   constantsCache_;
         Report                              report_;
 
+        dispatch_group_t                    creationGroup_      = nullptr;
+        MTPipelineState*                    fallback_           = nullptr;
+        std::unique_ptr<MTBinaryArchive>    binaryArchive_;
+
 };
 
 
@@ -25,13 +25,50 @@ MTPipelineState::MTPipelineState(bool isGraphicsPSO, const PipelineLayout* pipel
         if (!pipelineLayout_->GetDynamicBindings().empty())
             descriptorCache_ = MakeUnique<MTDescriptorCache>(pipelineLayout_->GetDynamicBindings());
     }
+    creationGroup_ = dispatch_group_create();
+}
+
+MTPipelineState::~MTPipelineState()
+{
+    WaitUntilCreated();
+    dispatch_release(creationGroup_);
 }
 
 const Report* MTPipelineState::GetReport() const
 {
+    /* Errors of the native PSO are reported by its completion handler */
+    WaitUntilCreated();
     return (report_ ? &report_ : nullptr);
 }
 
+bool MTPipelineState::IsReady() const
+{
+    return (dispatch_group_wait(creationGroup_, DISPATCH_TIME_NOW) == 0);
+}
+
+void MTPipelineState::Wait()
+{
+    WaitUntilCreated();
+}
+
+void MTPipelineState::WaitUntilCreated() const
+{
+    dispatch_group_wait(creationGroup_, DISPATCH_TIME_FOREVER);
+}
+
+void MTPipelineState::SetFallback(PipelineState* fallbackPipelineState)
+{
+    fallback_ = (fallbackPipelineState != nullptr ? LLGL_CAST(MTPipelineState*, fallbackPipelineState) : nullptr);
+}
+
+MTPipelineState& MTPipelineState::GetReadyOrFallback()
+{
+    if (fallback_ != nullptr && !IsReady())
+        return fallback_->GetReadyOrFallback();
+    WaitUntilCreated();
+    return *this;
+}
+
 MTDescriptorCache* MTPipelineState::ResetAndGetDescriptorCache() const
 {
     if (descriptorCache_)
@@ -67,6 +104,42 @@ bool MTPipelineState::NeedsConstantsCache() const
     return (pipelineLayout_ != nullptr && !pipelineLayout_->GetUniforms().empty());
 }
 
+MTLPipelineOption MTPipelineState::GetNativePipelineOptions() const
+{
+    if (NeedsConstantsCache())
+        return (MTLPipelineOptionArgumentInfo | MTLPipelineOptionBufferTypeInfo);
+    else
+        return MTLPipelineOptionNone;
+}
+
+void MTPipelineState::CreateBinaryArchive(id<MTLDevice> device, MTLRenderPipelineDescriptor* psoDesc, Blob& serializedCache)
+{
+    binaryArchive_ = MakeUnique<MTBinaryArchive>(device, &serializedCache);
+    binaryArchive_->AttachTo(psoDesc);
+    binaryArchive_->AddPipelineFunctions(psoDesc);
+    serializedCache = binaryArchive_->Serialize();
+}
+
+void MTPipelineState::CreateBinaryArchive(id<MTLDevice> device, MTLComputePipelineDescriptor* psoDesc, Blob& serializedCache)
+{
+    binaryArchive_ = MakeUnique<MTBinaryArchive>(device, &serializedCache);
+    binaryArchive_->AttachTo(psoDesc);
+    binaryArchive_->AddPipelineFunctions(psoDesc);
+    serializedCache = binaryArchive_->Serialize();
+}
+
+void MTPipelineState::BeginAsyncCreation()
+{
+    dispatch_group_enter(creationGroup_);
+}
+
+void MTPipelineState::EndAsyncCreation()
+{
+    /* Release binary archive and its temporary file once the native PSO no longer needs it */
+    binaryArchive_.reset();
+    dispatch_group_leave(creationGroup_);
+}
+
 void MTPipelineState::CreateConstantsCacheForRenderPipeline(MTLRenderPipelineReflection* reflection)
 {
     MTShaderReflectionArguments args[2] =
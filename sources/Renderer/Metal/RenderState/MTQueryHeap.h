@@ -0,0 +1,95 @@
+/*
+ * MTQueryHeap.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_MT_QUERY_HEAP_H
+#define LLGL_MT_QUERY_HEAP_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/QueryHeap.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class MTCommandContext;
+
+/*
+Metal query heap for occlusion and timer queries.
+Occlusion queries write into a visibility result buffer with one 64-bit value per query.
+Timer queries sample GPU timestamps into a counter sample buffer: two samples per query for QueryType::TimeElapsed and one for QueryType::Timestamp.
+Timestamps are sampled at draw or dispatch boundaries if the device supports it and at encoder boundaries otherwise, which is the case for Apple GPUs.
+*/
+class MTQueryHeap final : public QueryHeap
+{
+
+    public:
+
+        MTQueryHeap(id<MTLDevice> device, const QueryHeapDescriptor& desc);
+        ~MTQueryHeap();
+
+        // Encodes the begin of the specified query into the command context.
+        void Begin(MTCommandContext& context, std::uint32_t query);
+
+        // Encodes the end of the specified query into the command context.
+        void End(MTCommandContext& context, std::uint32_t query);
+
+        /*
+        Writes the results of the specified range of queries into the output buffer if they are available.
+        Returns false if the last command buffer that encoded any of these queries has not been completed yet. This function never blocks the CPU.
+        The output buffer must be an array of either 32-bit or 64-bit unsigned integers.
+        */
+        bool QueryResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize);
+
+        // Returns true if this heap holds occlusion queries, i.e. it is backed by a visibility result buffer.
+        inline bool IsOcclusionQuery() const
+        {
+            return (visibilityBuffer_ != nil);
+        }
+
+    private:
+
+        void CreateVisibilityBuffer(id<MTLDevice> device, std::uint32_t numQueries);
+        void CreateCounterSampleBuffer(id<MTLDevice> device, NSUInteger sampleCount);
+
+        void SampleTimestamp(MTCommandContext& context, NSUInteger sampleIndex);
+
+        bool ResolveTimestamps(std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* outResults);
+
+        // Keeps a reference to the specified command buffer, since it determines when the results of this heap are available.
+        void TrackCommandBuffer(id<MTLCommandBuffer> cmdBuffer);
+
+    private:
+
+        id<MTLDevice>           device_                 = nil;
+        id<MTLBuffer>           visibilityBuffer_       = nil;
+        MTLVisibilityResultMode visibilityMode_         = MTLVisibilityResultModeDisabled;
+        id                      sampleBuffer_           = nil;      // id<MTLCounterSampleBuffer> (macOS 10.15, iOS 14.0)
+        NSUInteger              samplesPerQuery_        = 0;
+        bool                    sampleAtDrawBoundary_   = false;    // Counters can be sampled within command encoders
+        id<MTLCommandBuffer>    lastCmdBuffer_          = nil;
+
+        /* Pair of CPU and GPU timestamps to convert GPU timestamps into nanoseconds */
+        std::uint64_t           calibrationCPUTime_     = 0;
+        std::uint64_t           calibrationGPUTime_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,264 @@
+/*
+ * MTQueryHeap.mm
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "MTQueryHeap.h"
+#include "../Command/MTCommandContext.h"
+#include "../../../Core/Exception.h"
+#include "../../../Core/Assertion.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+static constexpr NSUInteger g_visibilityResultStride = sizeof(std::uint64_t);
+
+MTQueryHeap::MTQueryHeap(id<MTLDevice> device, const QueryHeapDescriptor& desc) :
+    QueryHeap { desc.type },
+    device_   { device    }
+{
+    if (desc.renderCondition)
+        LLGL_TRAP_FEATURE_NOT_SUPPORTED("render conditions");
+
+    switch (desc.type)
+    {
+        case QueryType::SamplesPassed:
+            visibilityMode_ = MTLVisibilityResultModeCounting;
+            CreateVisibilityBuffer(device, desc.numQueries);
+            break;
+
+        case QueryType::AnySamplesPassed:
+        case QueryType::AnySamplesPassedConservative:
+            visibilityMode_ = MTLVisibilityResultModeBoolean;
+            CreateVisibilityBuffer(device, desc.numQueries);
+            break;
+
+        case QueryType::TimeElapsed:
+            samplesPerQuery_ = 2;
+            CreateCounterSampleBuffer(device, desc.numQueries * samplesPerQuery_);
+            break;
+
+        case QueryType::Timestamp:
+            samplesPerQuery_ = 1;
+            CreateCounterSampleBuffer(device, desc.numQueries * samplesPerQuery_);
+            break;
+
+        default:
+            throw std::invalid_argument("query type not supported by Metal backend; only occlusion and timer queries are supported");
+    }
+}
+
+MTQueryHeap::~MTQueryHeap()
+{
+    if (visibilityBuffer_ != nil)
+        [visibilityBuffer_ release];
+    if (sampleBuffer_ != nil)
+        [sampleBuffer_ release];
+    if (lastCmdBuffer_ != nil)
+        [lastCmdBuffer_ release];
+}
+
+void MTQueryHeap::Begin(MTCommandContext& context, std::uint32_t query)
+{
+    if (visibilityBuffer_ != nil)
+        context.SetVisibilityResult(visibilityBuffer_, visibilityMode_, query * g_visibilityResultStride);
+    else if (GetType() == QueryType::TimeElapsed)
+        SampleTimestamp(context, query * samplesPerQuery_);
+    TrackCommandBuffer(context.GetCommandBuffer());
+}
+
+void MTQueryHeap::End(MTCommandContext& context, std::uint32_t query)
+{
+    if (visibilityBuffer_ != nil)
+        context.SetVisibilityResult(visibilityBuffer_, MTLVisibilityResultModeDisabled, query * g_visibilityResultStride);
+    else if (samplesPerQuery_ > 0)
+        SampleTimestamp(context, query * samplesPerQuery_ + (samplesPerQuery_ - 1));
+    TrackCommandBuffer(context.GetCommandBuffer());
+}
+
+template <typename T>
+static void WriteQueryResults(void* dst, const std::uint64_t* src, std::uint32_t numQueries)
+{
+    T* dstResults = reinterpret_cast<T*>(dst);
+    for_range(i, numQueries)
+        dstResults[i] = static_cast<T>(src[i]);
+}
+
+bool MTQueryHeap::QueryResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
+{
+    /* Results are only available once all command buffers that have encoded these queries have been completed */
+    if (lastCmdBuffer_ != nil && [lastCmdBuffer_ status] != MTLCommandBufferStatusCompleted)
+        return false;
+
+    const bool is64Bit = (dataSize == numQueries * sizeof(std::uint64_t));
+    const bool is32Bit = (dataSize == numQueries * sizeof(std::uint32_t));
+    if (!is64Bit && !is32Bit)
+        return false;
+
+    if (visibilityBuffer_ != nil)
+    {
+        /* Read results directly from shared visibility result buffer */
+        const std::uint64_t* results = reinterpret_cast<const std::uint64_t*>([visibilityBuffer_ contents]) + firstQuery;
+        if (is64Bit)
+            WriteQueryResults<std::uint64_t>(data, results, numQueries);
+        else
+            WriteQueryResults<std::uint32_t>(data, results, numQueries);
+        return true;
+    }
+
+    if (sampleBuffer_ != nil)
+    {
+        /* Resolve timestamps into nanoseconds */
+        std::vector<std::uint64_t> results(numQueries, 0);
+        if (!ResolveTimestamps(firstQuery, numQueries, results.data()))
+            return false;
+        if (is64Bit)
+            WriteQueryResults<std::uint64_t>(data, results.data(), numQueries);
+        else
+            WriteQueryResults<std::uint32_t>(data, results.data(), numQueries);
+        return true;
+    }
+
+    return false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void MTQueryHeap::CreateVisibilityBuffer(id<MTLDevice> device, std::uint32_t numQueries)
+{
+    /* Allocate visibility result buffer in shared memory, so results can be read without a blit command */
+    visibilityBuffer_ = [device
+        newBufferWithLength:    std::max<NSUInteger>(1u, numQueries) * g_visibilityResultStride
+        options:                MTLResourceStorageModeShared
+    ];
+    ::memset([visibilityBuffer_ contents], 0, [visibilityBuffer_ length]);
+}
+
+void MTQueryHeap::CreateCounterSampleBuffer(id<MTLDevice> device, NSUInteger sampleCount)
+{
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        /* Find common counter set for GPU timestamps */
+        id<MTLCounterSet> timestampCounterSet = nil;
+        for (id<MTLCounterSet> counterSet in [device counterSets])
+        {
+            if ([[counterSet name] isEqualToString:MTLCommonCounterSetTimestamp])
+            {
+                timestampCounterSet = counterSet;
+                break;
+            }
+        }
+
+        if (timestampCounterSet == nil)
+            LLGL_TRAP_FEATURE_NOT_SUPPORTED("timestamp counter set");
+
+        MTLCounterSampleBufferDescriptor* sampleBufferDesc = [[MTLCounterSampleBufferDescriptor alloc] init];
+        {
+            sampleBufferDesc.counterSet     = timestampCounterSet;
+            sampleBufferDesc.storageMode    = MTLStorageModeShared;
+            sampleBufferDesc.sampleCount    = sampleCount;
+        }
+        NSError* error = nil;
+        sampleBuffer_ = [device newCounterSampleBufferWithDescriptor:sampleBufferDesc error:&error];
+        [sampleBufferDesc release];
+
+        if (sampleBuffer_ == nil)
+            LLGL_TRAP("failed to create Metal counter sample buffer: %s", (error != nil ? [[error localizedDescription] UTF8String] : "unknown error"));
+
+        /* Apple GPUs can only sample counters at the boundaries of command encoders */
+        sampleAtDrawBoundary_ = [device supportsCounterSampling:MTLCounterSamplingPointAtDrawBoundary];
+
+        /* Take initial pair of CPU and GPU timestamps to convert GPU timestamps into nanoseconds */
+        MTLTimestamp cpuTime = 0, gpuTime = 0;
+        [device sampleTimestamps:&cpuTime gpuTimestamp:&gpuTime];
+        calibrationCPUTime_ = cpuTime;
+        calibrationGPUTime_ = gpuTime;
+    }
+    else
+        LLGL_TRAP_FEATURE_NOT_SUPPORTED("timer queries");
+}
+
+void MTQueryHeap::SampleTimestamp(MTCommandContext& context, NSUInteger sampleIndex)
+{
+    if (sampleAtDrawBoundary_)
+        context.SampleCounters(sampleBuffer_, sampleIndex);
+    else
+        context.SampleCountersAtEncoderBoundary(sampleBuffer_, sampleIndex);
+}
+
+bool MTQueryHeap::ResolveTimestamps(std::uint32_t firstQuery, std::uint32_t numQueries, std::uint64_t* outResults)
+{
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        const NSRange sampleRange = NSMakeRange(firstQuery * samplesPerQuery_, numQueries * samplesPerQuery_);
+        NSData* resolvedData = [(id<MTLCounterSampleBuffer>)sampleBuffer_ resolveCounterRange:sampleRange];
+        if (resolvedData == nil || [resolvedData length] < sampleRange.length * sizeof(MTLCounterResultTimestamp))
+            return false;
+
+        const MTLCounterResultTimestamp* samples = reinterpret_cast<const MTLCounterResultTimestamp*>([resolvedData bytes]);
+
+        /* Re-calibrate GPU timestamps with current CPU time to get the ratio between GPU ticks and nanoseconds */
+        MTLTimestamp cpuTime = 0, gpuTime = 0;
+        [device_ sampleTimestamps:&cpuTime gpuTimestamp:&gpuTime];
+
+        double ticksToNanoseconds = 1.0;
+        if (gpuTime > calibrationGPUTime_ && cpuTime > calibrationCPUTime_)
+            ticksToNanoseconds = static_cast<double>(cpuTime - calibrationCPUTime_) / static_cast<double>(gpuTime - calibrationGPUTime_);
+
+        if (GetType() == QueryType::TimeElapsed)
+        {
+            for_range(i, numQueries)
+            {
+                const MTLTimestamp beginTime  = samples[i*2    ].timestamp;
+                const MTLTimestamp endTime    = samples[i*2 + 1].timestamp;
+                if (beginTime == MTLCounterErrorValue || endTime == MTLCounterErrorValue || endTime < beginTime)
+                    outResults[i] = 0;
+                else
+                    outResults[i] = static_cast<std::uint64_t>(static_cast<double>(endTime - beginTime) * ticksToNanoseconds);
+            }
+        }
+        else
+        {
+            for_range(i, numQueries)
+            {
+                const MTLTimestamp time = samples[i].timestamp;
+                if (time == MTLCounterErrorValue || time < calibrationGPUTime_)
+                    outResults[i] = 0;
+                else
+                    outResults[i] = calibrationCPUTime_ + static_cast<std::uint64_t>(static_cast<double>(time - calibrationGPUTime_) * ticksToNanoseconds);
+            }
+        }
+
+        return true;
+    }
+    return false;
+}
+
+void MTQueryHeap::TrackCommandBuffer(id<MTLCommandBuffer> cmdBuffer)
+{
+    if (cmdBuffer != nil && cmdBuffer != lastCmdBuffer_)
+    {
+        if (lastCmdBuffer_ != nil)
+            [lastCmdBuffer_ release];
+        lastCmdBuffer_ = [cmdBuffer retain];
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -15,6 +15,7 @@
 #include <LLGL/ForwardDecls.h>
 #include <LLGL/StaticLimits.h>
 #include <LLGL/Container/SmallVector.h>
+#include <atomic>
 
 
 namespace LLGL
@@ -78,12 +79,43 @@ class MTRenderPass final : public RenderPass
             return sampleCount_;
         }
 
+        // Returns the multiview mask of this render pass or 0 if multiview rendering is disabled (see RenderPassDescriptor::viewMask).
+        inline std::uint32_t GetViewMask() const
+        {
+            return viewMask_;
+        }
+
+    public:
+
+        /*
+        Registers or unregisters a secondary command buffer that encodes into this render pass in parallel (see CommandBufferDescriptor::renderPass).
+        These functions are const, since the parallel encoding state is not part of the render pass configuration.
+        */
+        void AttachParallelCommandBuffer() const;
+        void DetachParallelCommandBuffer() const;
+
+        // Returns true if any secondary command buffer encodes into this render pass in parallel.
+        bool HasParallelCommandBuffers() const;
+
+        // Sets the parallel render command encoder of the primary command buffer that is currently inside this render pass.
+        void SetParallelEncoder(id<MTLParallelRenderCommandEncoder> parallelEncoder) const;
+
+        // Returns the parallel render command encoder of this render pass or nil if no primary command buffer is currently inside this render pass.
+        inline id<MTLParallelRenderCommandEncoder> GetParallelEncoder() const
+        {
+            return parallelEncoder_;
+        }
+
     private:
 
         MTColorAttachmentFormatVector   colorAttachments_;
         MTAttachmentFormat              depthAttachment_;
         MTAttachmentFormat              stencilAttachment_;
         NSUInteger                      sampleCount_        = 1;
+        std::uint32_t                   viewMask_           = 0;
+
+        mutable std::atomic<std::uint32_t>          numParallelCmdBuffers_  { 0 };
+        mutable id<MTLParallelRenderCommandEncoder> parallelEncoder_        = nil;
 
 };
 
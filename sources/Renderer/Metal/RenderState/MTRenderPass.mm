@@ -47,7 +47,8 @@ static MTAttachmentFormat MakeMTAttachmentFormat(const Format format)
 
 // Initializer when a custom render pass is created
 MTRenderPass::MTRenderPass(const RenderPassDescriptor& desc) :
-    sampleCount_ { GetClampedSamples(desc.samples) }
+    sampleCount_ { GetClampedSamples(desc.samples) },
+    viewMask_    { desc.viewMask                   }
 {
     const auto numColorAttachments = NumEnabledColorAttachments(desc);
     LLGL_ASSERT(numColorAttachments <= LLGL_MAX_NUM_COLOR_ATTACHMENTS);
@@ -69,6 +70,7 @@ MTRenderPass::MTRenderPass(const RenderTargetDescriptor& desc) :
         colorAttachments_   = renderPassMT->GetColorAttachments();
         depthAttachment_    = renderPassMT->GetDepthAttachment();
         stencilAttachment_  = renderPassMT->GetStencilAttachment();
+        viewMask_           = renderPassMT->GetViewMask();
     }
     else
     {
@@ -278,6 +280,26 @@ std::uint32_t MTRenderPass::UpdateNativeRenderPass(
     return (clearValueIndex + numDepthStencilAttachments);
 }
 
+void MTRenderPass::AttachParallelCommandBuffer() const
+{
+    ++numParallelCmdBuffers_;
+}
+
+void MTRenderPass::DetachParallelCommandBuffer() const
+{
+    --numParallelCmdBuffers_;
+}
+
+bool MTRenderPass::HasParallelCommandBuffers() const
+{
+    return (numParallelCmdBuffers_ > 0);
+}
+
+void MTRenderPass::SetParallelEncoder(id<MTLParallelRenderCommandEncoder> parallelEncoder) const
+{
+    parallelEncoder_ = parallelEncoder;
+}
+
 
 } // /namespace LLGL
 
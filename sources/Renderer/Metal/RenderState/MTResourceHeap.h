@@ -30,12 +30,15 @@ enum MTResourceType : std::uint32_t;
 class MTTexture;
 class BindingDescriptorIterator;
 struct MTResourceBinding;
+struct BindingDescriptor;
 struct ResourceHeapDescriptor;
 struct TextureViewDescriptor;
 
 /*
 This class emulates the behavior of a descriptor set like in Vulkan,
 by binding all shader resources within one bind call in the command buffer.
+For bindless heaps (see PipelineLayoutDescriptor::bindlessHeap), all resources are encoded into an argument buffer (tier 2) instead,
+which is bound with a single buffer binding per shader stage and made resident with 'useResources'.
 */
 class MTResourceHeap final : public ResourceHeap
 {
@@ -117,6 +120,22 @@ class MTResourceHeap final : public ResourceHeap
             std::size_t index;  // Index to the input bindings list
         };
 
+        // Argument buffer entry for each descriptor of a bindless heap, i.e. one entry per array element of each heap binding.
+        struct MTArgumentBinding
+        {
+            NSUInteger          index;  // Argument index within the argument buffer.
+            MTResourceType      type;
+            MTLResourceUsage    usage;
+        };
+
+        // Resources of a descriptor set that must be made resident when its argument buffer is bound.
+        struct MTArgumentBufferSet
+        {
+            std::vector<id<MTLResource>>    readResources;
+            std::vector<id<MTLResource>>    readWriteResources;
+            bool                            dirty               = false;
+        };
+
     private:
 
         SegmentationSizeType AllocBufferSegments(BindingDescriptorIterator& bindingIter, long stage);
@@ -143,6 +162,18 @@ class MTResourceHeap final : public ResourceHeap
         void WriteBindingMappings(MTShaderStage stage, MTResourceType type, const MTResourceBinding* first, NSUInteger count);
         void CacheResourceUsage();
 
+        void BuildArgumentBuffer(
+            id<MTLArgumentEncoder>                      argumentEncoder,
+            const ArrayView<BindingDescriptor>&         bindings,
+            const ResourceHeapDescriptor&               desc,
+            const ArrayView<ResourceViewDescriptor>&    initialResourceViews
+        );
+
+        std::uint32_t WriteArgumentBufferResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
+        void BindArgumentBufferGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder, std::uint32_t descriptorSet);
+        void BindArgumentBufferComputeResources(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t descriptorSet);
+        void UpdateArgumentBufferResources(std::uint32_t descriptorSet);
+
         const char* BindVertexResources(id<MTLRenderCommandEncoder> cmdEncoder, const char* heapPtr);
         const char* BindFragmentResources(id<MTLRenderCommandEncoder> cmdEncoder, const char* heapPtr);
         const char* BindKernelResources(id<MTLComputeCommandEncoder> cmdEncoder, const char* heapPtr);
@@ -151,15 +182,10 @@ class MTResourceHeap final : public ResourceHeap
         void WriteResourceViewTexture(const ResourceViewDescriptor& desc, char* heapPtr, const BindingSegmentLocation::Stage& binding, std::uint32_t descriptorSet);
         void WriteResourceViewSamplerState(const ResourceViewDescriptor& desc, char* heapPtr, const BindingSegmentLocation::Stage& binding);
 
-        void ExchangeTextureView(
-            std::uint32_t                           descriptorSet,
-            const BindingSegmentLocation::Stage&    binding,
-            id<MTLTexture>                          textureView
-        );
+        void ExchangeTextureView(id<MTLTexture>& texViewEntry, id<MTLTexture> textureView);
 
         id<MTLTexture> GetOrCreateTexture(
-            std::uint32_t                           descriptorSet,
-            const BindingSegmentLocation::Stage&    binding,
+            id<MTLTexture>&                         texViewEntry,
             MTTexture&                              textureMT,
             const TextureViewDescriptor&            textureViewDesc
         );
@@ -188,6 +214,15 @@ class MTResourceHeap final : public ResourceHeap
         std::vector<id<MTLTexture>>         textureViews_;
         std::uint32_t                       numTextureViewsPerSet_  = 0;
 
+        id<MTLArgumentEncoder>              argumentEncoder_        = nil;  // Argument encoder for bindless heaps; nil for all other heaps.
+        id<MTLBuffer>                       argumentBuffer_         = nil;
+        NSUInteger                          argumentBufferStride_   = 0;    // Aligned size (in bytes) of each descriptor set within the argument buffer.
+        std::uint32_t                       numArgumentBufferSets_  = 0;
+        NSUInteger                          argumentRenderStages_   = 0;    // Render stages (MTLRenderStages) that read from the argument buffer.
+        std::vector<MTArgumentBinding>      argumentBindings_;
+        std::vector<MTArgumentBufferSet>    argumentBufferSets_;
+        std::vector<id<MTLResource>>        argumentResources_;             // Resource of each descriptor in all descriptor sets.
+
 };
 
 
@@ -19,6 +19,7 @@
 #include "../../../Core/Assertion.h"
 #include <LLGL/ResourceHeapFlags.h>
 #include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -93,8 +94,16 @@ MTResourceHeap::MTResourceHeap(
     if (!pipelineLayoutMT)
         throw std::invalid_argument("failed to create resource heap due to missing pipeline layout");
 
-    /* Validate binding descriptors */
+    /* Encode all resources into an argument buffer for bindless heaps */
     const auto& bindings            = pipelineLayoutMT->GetHeapBindings();
+
+    if (id<MTLArgumentEncoder> argumentEncoder = pipelineLayoutMT->GetArgumentEncoder())
+    {
+        BuildArgumentBuffer(argumentEncoder, bindings, desc, initialResourceViews);
+        return;
+    }
+
+    /* Validate binding descriptors */
     const auto  numBindings         = static_cast<std::uint32_t>(bindings.size());
     const auto  numResourceViews    = GetNumResourceViewsOrThrow(numBindings, desc, initialResourceViews);
 
@@ -148,10 +157,16 @@ MTResourceHeap::~MTResourceHeap()
         if (tex != nil)
             [tex release];
     }
+    if (argumentBuffer_ != nil)
+        [argumentBuffer_ release];
+    if (argumentEncoder_ != nil)
+        [argumentEncoder_ release];
 }
 
 std::uint32_t MTResourceHeap::GetNumDescriptorSets() const
 {
+    if (argumentEncoder_ != nil)
+        return numArgumentBufferSets_;
     return static_cast<std::uint32_t>(heap_.NumSets());
 }
 
@@ -161,6 +176,9 @@ std::uint32_t MTResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
     if (resourceViews.empty())
         return 0;
 
+    if (argumentEncoder_ != nil)
+        return WriteArgumentBufferResourceViews(firstDescriptor, resourceViews);
+
     const auto numSets          = GetNumDescriptorSets();
     const auto numBindings      = static_cast<std::uint32_t>(bindingMap_.size());
     const auto numDescriptors   = numSets * numBindings;
@@ -219,6 +237,12 @@ std::uint32_t MTResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
 
 void MTResourceHeap::BindGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder, std::uint32_t descriptorSet)
 {
+    if (argumentEncoder_ != nil)
+    {
+        BindArgumentBufferGraphicsResources(renderEncoder, descriptorSet);
+        return;
+    }
+
     if (descriptorSet >= heap_.NumSets())
         return;
 
@@ -231,6 +255,12 @@ void MTResourceHeap::BindGraphicsResources(id<MTLRenderCommandEncoder> renderEnc
 
 void MTResourceHeap::BindComputeResources(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t descriptorSet)
 {
+    if (argumentEncoder_ != nil)
+    {
+        BindArgumentBufferComputeResources(computeEncoder, descriptorSet);
+        return;
+    }
+
     if (descriptorSet >= heap_.NumSets())
         return;
 
@@ -571,7 +601,9 @@ void MTResourceHeap::WriteResourceViewTexture(const ResourceViewDescriptor& desc
 {
     /* Get texture resource and Write MTLTexture ID */
     auto textureMT = LLGL_CAST(MTTexture*, GetAsExpectedTexture(desc.resource));
-    MTRESOURCEHEAP_DATA0_MTLTEXTURE(heapPtr)[binding.descriptorIndex] = GetOrCreateTexture(descriptorSet, binding, *textureMT, desc.textureView);
+    LLGL_ASSERT(binding.textureViewIndex < numTextureViewsPerSet_);
+    auto& texViewEntry = textureViews_[descriptorSet * numTextureViewsPerSet_ + binding.textureViewIndex];
+    MTRESOURCEHEAP_DATA0_MTLTEXTURE(heapPtr)[binding.descriptorIndex] = GetOrCreateTexture(texViewEntry, *textureMT, desc.textureView);
 }
 
 void MTResourceHeap::WriteResourceViewSamplerState(const ResourceViewDescriptor& desc, char* heapPtr, const BindingSegmentLocation::Stage& binding)
@@ -598,13 +630,8 @@ static void ValidateTexViewNoTypeAndRange(MTTexture& textureMT, const TextureVie
         throw std::runtime_error("cannot create texture-view of different array-layer range for this version of the Metal API");
 }
 
-void MTResourceHeap::ExchangeTextureView(
-    std::uint32_t                           descriptorSet,
-    const BindingSegmentLocation::Stage&    binding,
-    id<MTLTexture>                          textureView)
+void MTResourceHeap::ExchangeTextureView(id<MTLTexture>& texViewEntry, id<MTLTexture> textureView)
 {
-    LLGL_ASSERT(binding.textureViewIndex < numTextureViewsPerSet_);
-    auto& texViewEntry = textureViews_[descriptorSet * numTextureViewsPerSet_ + binding.textureViewIndex];
     if (texViewEntry != textureView)
     {
         if (texViewEntry != nil)
@@ -614,8 +641,7 @@ void MTResourceHeap::ExchangeTextureView(
 }
 
 id<MTLTexture> MTResourceHeap::GetOrCreateTexture(
-    std::uint32_t                           descriptorSet,
-    const BindingSegmentLocation::Stage&    binding,
+    id<MTLTexture>&                         texViewEntry,
     MTTexture&                              textureMT,
     const TextureViewDescriptor&            textureViewDesc)
 {
@@ -657,13 +683,13 @@ id<MTLTexture> MTResourceHeap::GetOrCreateTexture(
         }
 
         /* Store texture view reference */
-        ExchangeTextureView(descriptorSet, binding, textureView);
+        ExchangeTextureView(texViewEntry, textureView);
         return textureView;
     }
     else
     {
         /* Release previously stored texture view reference */
-        ExchangeTextureView(descriptorSet, binding, nil);
+        ExchangeTextureView(texViewEntry, nil);
         return textureMT.GetNative();
     }
 }
@@ -683,6 +709,250 @@ MTResourceHeap::SegmentationSizeType MTResourceHeap::ConsolidateSegments(
     );
 }
 
+static MTResourceType ToMTArgumentResourceType(ResourceType type)
+{
+    switch (type)
+    {
+        case ResourceType::Buffer:  return MTResourceType_Buffer;
+        case ResourceType::Texture: return MTResourceType_Texture;
+        case ResourceType::Sampler: return MTResourceType_SamplerState;
+        default:                    throw std::invalid_argument("failed to create resource heap due to invalid resource type for argument buffer");
+    }
+}
+
+void MTResourceHeap::BuildArgumentBuffer(
+    id<MTLArgumentEncoder>                      argumentEncoder,
+    const ArrayView<BindingDescriptor>&         bindings,
+    const ResourceHeapDescriptor&               desc,
+    const ArrayView<ResourceViewDescriptor>&    initialResourceViews)
+{
+    /* Flatten heap bindings into one argument per array element; array elements occupy consecutive argument indices */
+    long stageFlags = 0;
+
+    for (const BindingDescriptor& binding : bindings)
+    {
+        const std::uint32_t numElements = std::max(1u, binding.arraySize);
+        for_range(i, numElements)
+        {
+            MTArgumentBinding argumentBinding;
+            {
+                argumentBinding.index   = binding.slot.index + i;
+                argumentBinding.type    = ToMTArgumentResourceType(binding.type);
+                argumentBinding.usage   = ((binding.bindFlags & BindFlags::Storage) != 0 ? (MTLResourceUsageRead | MTLResourceUsageWrite) : MTLResourceUsageRead);
+            }
+            argumentBindings_.push_back(argumentBinding);
+        }
+        stageFlags |= binding.stageFlags;
+    }
+
+    /* Store which shader stages the argument buffer must be bound to */
+    MemsetZero(segmentation_);
+
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        if ((stageFlags & (StageFlags::VertexStage | StageFlags::TessEvaluationStage)) != 0)
+        {
+            segmentation_.hasVertexResources = 1;
+            argumentRenderStages_ |= MTLRenderStageVertex;
+        }
+        if ((stageFlags & StageFlags::FragmentStage) != 0)
+        {
+            segmentation_.hasFragmentResources = 1;
+            argumentRenderStages_ |= MTLRenderStageFragment;
+        }
+        if ((stageFlags & (StageFlags::ComputeStage | StageFlags::TessControlStage)) != 0)
+            segmentation_.hasKernelResources = 1;
+
+        /* Allocate argument buffer with one aligned range per descriptor set */
+        const auto numDescriptorsPerSet = static_cast<std::uint32_t>(argumentBindings_.size());
+        const auto numResourceViews     = GetNumResourceViewsOrThrow(numDescriptorsPerSet, desc, initialResourceViews);
+
+        numArgumentBufferSets_  = numResourceViews / numDescriptorsPerSet;
+        argumentEncoder_        = [argumentEncoder retain];
+        argumentBufferStride_   = GetAlignedSize<NSUInteger>([argumentEncoder encodedLength], std::max<NSUInteger>(1, [argumentEncoder alignment]));
+        argumentBuffer_         = [[argumentEncoder device]
+            newBufferWithLength:    argumentBufferStride_ * numArgumentBufferSets_
+            options:                MTLResourceStorageModeShared
+        ];
+
+        /* One texture view entry per descriptor, since any descriptor can be written with a texture view */
+        numTextureViewsPerSet_ = numDescriptorsPerSet;
+        textureViews_.resize(numResourceViews, nil);
+        argumentResources_.resize(numResourceViews, nil);
+        argumentBufferSets_.resize(numArgumentBufferSets_);
+
+        /* Write initial resource views */
+        if (!initialResourceViews.empty())
+            WriteArgumentBufferResourceViews(0, initialResourceViews);
+    }
+}
+
+std::uint32_t MTResourceHeap::WriteArgumentBufferResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    const auto numDescriptorsPerSet = static_cast<std::uint32_t>(argumentBindings_.size());
+    const auto numDescriptors       = numArgumentBufferSets_ * numDescriptorsPerSet;
+
+    /* Silently quit on out of bounds; debug layer must report these errors */
+    if (firstDescriptor >= numDescriptors)
+        return 0;
+    if (firstDescriptor + resourceViews.size() > numDescriptors)
+        return 0;
+
+    std::uint32_t numWritten = 0;
+
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        std::uint32_t currentSet = ~0u;
+
+        for (const auto& desc : resourceViews)
+        {
+            const std::uint32_t descriptor = firstDescriptor++;
+
+            /* Skip over empty resource descriptors */
+            if (desc.resource == nullptr)
+                continue;
+
+            /* Point argument encoder to the range of the descriptor set within the argument buffer */
+            const std::uint32_t descriptorSet = descriptor / numDescriptorsPerSet;
+            if (descriptorSet != currentSet)
+            {
+                [argumentEncoder_ setArgumentBuffer:argumentBuffer_ offset:descriptorSet * argumentBufferStride_];
+                currentSet = descriptorSet;
+            }
+
+            /* Encode resource into argument buffer and keep track of resources that must be made resident */
+            const MTArgumentBinding& argument = argumentBindings_[descriptor % numDescriptorsPerSet];
+            id<MTLResource>& resourceEntry = argumentResources_[descriptor];
+
+            switch (argument.type)
+            {
+                case MTResourceType_Buffer:
+                {
+                    auto bufferMT = LLGL_CAST(MTBuffer*, GetAsExpectedBuffer(desc.resource));
+                    [argumentEncoder_
+                        setBuffer:  bufferMT->GetNative()
+                        offset:     static_cast<NSUInteger>(desc.bufferView.offset)
+                        atIndex:    argument.index
+                    ];
+                    resourceEntry = bufferMT->GetNative();
+                }
+                break;
+
+                case MTResourceType_Texture:
+                {
+                    auto textureMT = LLGL_CAST(MTTexture*, GetAsExpectedTexture(desc.resource));
+                    id<MTLTexture> texture = GetOrCreateTexture(textureViews_[descriptor], *textureMT, desc.textureView);
+                    [argumentEncoder_ setTexture:texture atIndex:argument.index];
+                    resourceEntry = texture;
+                }
+                break;
+
+                case MTResourceType_SamplerState:
+                {
+                    auto samplerMT = LLGL_CAST(MTSampler*, GetAsExpectedSampler(desc.resource));
+                    [argumentEncoder_ setSamplerState:samplerMT->GetNative() atIndex:argument.index];
+                }
+                break;
+            }
+
+            argumentBufferSets_[descriptorSet].dirty = true;
+            ++numWritten;
+        }
+    }
+
+    return numWritten;
+}
+
+void MTResourceHeap::BindArgumentBufferGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder, std::uint32_t descriptorSet)
+{
+    if (descriptorSet >= numArgumentBufferSets_)
+        return;
+
+    UpdateArgumentBufferResources(descriptorSet);
+
+    /* Bind argument buffer to each shader stage with a single buffer binding */
+    const NSUInteger offset = descriptorSet * argumentBufferStride_;
+
+    if (segmentation_.hasVertexResources)
+        [renderEncoder setVertexBuffer:argumentBuffer_ offset:offset atIndex:MTPipelineLayout::argumentBufferSlot];
+    if (segmentation_.hasFragmentResources)
+        [renderEncoder setFragmentBuffer:argumentBuffer_ offset:offset atIndex:MTPipelineLayout::argumentBufferSlot];
+
+    /* Make all resources resident that are only referenced by the argument buffer */
+    const MTArgumentBufferSet& argumentBufferSet = argumentBufferSets_[descriptorSet];
+
+    auto UseResources = [renderEncoder, this](const std::vector<id<MTLResource>>& resources, MTLResourceUsage usage)
+    {
+        if (resources.empty())
+            return;
+        if (@available(macOS 10.15, iOS 13.0, *))
+        {
+            [renderEncoder
+                useResources:   resources.data()
+                count:          resources.size()
+                usage:          usage
+                stages:         static_cast<MTLRenderStages>(argumentRenderStages_)
+            ];
+        }
+        else if (@available(macOS 10.13, iOS 11.0, *))
+            [renderEncoder useResources:resources.data() count:resources.size() usage:usage];
+    };
+
+    UseResources(argumentBufferSet.readResources, MTLResourceUsageRead);
+    UseResources(argumentBufferSet.readWriteResources, MTLResourceUsageRead | MTLResourceUsageWrite);
+}
+
+void MTResourceHeap::BindArgumentBufferComputeResources(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t descriptorSet)
+{
+    if (descriptorSet >= numArgumentBufferSets_ || !segmentation_.hasKernelResources)
+        return;
+
+    UpdateArgumentBufferResources(descriptorSet);
+
+    /* Bind argument buffer with a single buffer binding */
+    [computeEncoder setBuffer:argumentBuffer_ offset:descriptorSet * argumentBufferStride_ atIndex:MTPipelineLayout::argumentBufferSlot];
+
+    /* Make all resources resident that are only referenced by the argument buffer */
+    const MTArgumentBufferSet& argumentBufferSet = argumentBufferSets_[descriptorSet];
+
+    auto UseResources = [computeEncoder](const std::vector<id<MTLResource>>& resources, MTLResourceUsage usage)
+    {
+        if (resources.empty())
+            return;
+        if (@available(macOS 10.13, iOS 11.0, *))
+            [computeEncoder useResources:resources.data() count:resources.size() usage:usage];
+    };
+
+    UseResources(argumentBufferSet.readResources, MTLResourceUsageRead);
+    UseResources(argumentBufferSet.readWriteResources, MTLResourceUsageRead | MTLResourceUsageWrite);
+}
+
+void MTResourceHeap::UpdateArgumentBufferResources(std::uint32_t descriptorSet)
+{
+    MTArgumentBufferSet& argumentBufferSet = argumentBufferSets_[descriptorSet];
+    if (!argumentBufferSet.dirty)
+        return;
+
+    /* Rebuild lists of resources since descriptors of this set have been written */
+    argumentBufferSet.readResources.clear();
+    argumentBufferSet.readWriteResources.clear();
+
+    const auto numDescriptorsPerSet = static_cast<std::uint32_t>(argumentBindings_.size());
+    const id<MTLResource>* resources = &argumentResources_[descriptorSet * numDescriptorsPerSet];
+
+    for_range(i, numDescriptorsPerSet)
+    {
+        if (resources[i] == nil)
+            continue;
+        if ((argumentBindings_[i].usage & MTLResourceUsageWrite) != 0)
+            argumentBufferSet.readWriteResources.push_back(resources[i]);
+        else
+            argumentBufferSet.readResources.push_back(resources[i]);
+    }
+
+    argumentBufferSet.dirty = false;
+}
+
 #undef MTRESOURCEHEAP_SEGMENT
 #undef MTRESOURCEHEAP_CONST_SEGMENT
 #undef MTRESOURCEHEAP_DATA0
@@ -0,0 +1,36 @@
+/*
+ * CopyBufferStrided.metal
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <metal_stdlib>
+
+using namespace metal;
+
+// Row sizes and strides are specified in number of 32-bit values
+struct CopyParams
+{
+    uint numValuesPerRow;
+    uint numRows;
+    uint srcRowStride;
+    uint dstRowStride;
+};
+
+// Copy one 32-bit value from each row of the input buffer into the respective row of the output buffer
+kernel void CS(
+    device uint*            outBuffer   [[buffer(0)]],
+    const device uint*      inBuffer    [[buffer(1)]],
+    constant CopyParams&    params      [[buffer(2)]],
+    uint                    threadID    [[thread_position_in_grid]])
+{
+    const uint row = threadID / params.numValuesPerRow;
+    const uint col = threadID % params.numValuesPerRow;
+    if (row < params.numRows)
+        outBuffer[row * params.dstRowStride + col] = inBuffer[row * params.srcRowStride + col];
+}
+
+
+
+// ================================================================================
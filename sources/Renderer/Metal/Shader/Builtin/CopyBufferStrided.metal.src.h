@@ -0,0 +1,68 @@
+"\x2F\x2A\x0A\x20\x2A\x20\x43\x6F\x70\x79\x42\x75\x66\x66\x65\x72" // 0x00000000 - 0x0000000F
+"\x53\x74\x72\x69\x64\x65\x64\x2E\x6D\x65\x74\x61\x6C\x0A\x20\x2A" // 0x00000010 - 0x0000001F
+"\x20\x0A\x20\x2A\x20\x54\x68\x69\x73\x20\x66\x69\x6C\x65\x20\x69" // 0x00000020 - 0x0000002F
+"\x73\x20\x70\x61\x72\x74\x20\x6F\x66\x20\x74\x68\x65\x20\x22\x4C" // 0x00000030 - 0x0000003F
+"\x4C\x47\x4C\x22\x20\x70\x72\x6F\x6A\x65\x63\x74\x20\x28\x43\x6F" // 0x00000040 - 0x0000004F
+"\x70\x79\x72\x69\x67\x68\x74\x20\x28\x63\x29\x20\x32\x30\x31\x35" // 0x00000050 - 0x0000005F
+"\x2D\x32\x30\x31\x39\x20\x62\x79\x20\x4C\x75\x6B\x61\x73\x20\x48" // 0x00000060 - 0x0000006F
+"\x65\x72\x6D\x61\x6E\x6E\x73\x29\x0A\x20\x2A\x20\x53\x65\x65\x20" // 0x00000070 - 0x0000007F
+"\x22\x4C\x49\x43\x45\x4E\x53\x45\x2E\x74\x78\x74\x22\x20\x66\x6F" // 0x00000080 - 0x0000008F
+"\x72\x20\x6C\x69\x63\x65\x6E\x73\x65\x20\x69\x6E\x66\x6F\x72\x6D" // 0x00000090 - 0x0000009F
+"\x61\x74\x69\x6F\x6E\x2E\x0A\x20\x2A\x2F\x0A\x0A\x23\x69\x6E\x63" // 0x000000A0 - 0x000000AF
+"\x6C\x75\x64\x65\x20\x3C\x6D\x65\x74\x61\x6C\x5F\x73\x74\x64\x6C" // 0x000000B0 - 0x000000BF
+"\x69\x62\x3E\x0A\x0A\x75\x73\x69\x6E\x67\x20\x6E\x61\x6D\x65\x73" // 0x000000C0 - 0x000000CF
+"\x70\x61\x63\x65\x20\x6D\x65\x74\x61\x6C\x3B\x0A\x0A\x2F\x2F\x20" // 0x000000D0 - 0x000000DF
+"\x52\x6F\x77\x20\x73\x69\x7A\x65\x73\x20\x61\x6E\x64\x20\x73\x74" // 0x000000E0 - 0x000000EF
+"\x72\x69\x64\x65\x73\x20\x61\x72\x65\x20\x73\x70\x65\x63\x69\x66" // 0x000000F0 - 0x000000FF
+"\x69\x65\x64\x20\x69\x6E\x20\x6E\x75\x6D\x62\x65\x72\x20\x6F\x66" // 0x00000100 - 0x0000010F
+"\x20\x33\x32\x2D\x62\x69\x74\x20\x76\x61\x6C\x75\x65\x73\x0A\x73" // 0x00000110 - 0x0000011F
+"\x74\x72\x75\x63\x74\x20\x43\x6F\x70\x79\x50\x61\x72\x61\x6D\x73" // 0x00000120 - 0x0000012F
+"\x0A\x7B\x0A\x20\x20\x20\x20\x75\x69\x6E\x74\x20\x6E\x75\x6D\x56" // 0x00000130 - 0x0000013F
+"\x61\x6C\x75\x65\x73\x50\x65\x72\x52\x6F\x77\x3B\x0A\x20\x20\x20" // 0x00000140 - 0x0000014F
+"\x20\x75\x69\x6E\x74\x20\x6E\x75\x6D\x52\x6F\x77\x73\x3B\x0A\x20" // 0x00000150 - 0x0000015F
+"\x20\x20\x20\x75\x69\x6E\x74\x20\x73\x72\x63\x52\x6F\x77\x53\x74" // 0x00000160 - 0x0000016F
+"\x72\x69\x64\x65\x3B\x0A\x20\x20\x20\x20\x75\x69\x6E\x74\x20\x64" // 0x00000170 - 0x0000017F
+"\x73\x74\x52\x6F\x77\x53\x74\x72\x69\x64\x65\x3B\x0A\x7D\x3B\x0A" // 0x00000180 - 0x0000018F
+"\x0A\x2F\x2F\x20\x43\x6F\x70\x79\x20\x6F\x6E\x65\x20\x33\x32\x2D" // 0x00000190 - 0x0000019F
+"\x62\x69\x74\x20\x76\x61\x6C\x75\x65\x20\x66\x72\x6F\x6D\x20\x65" // 0x000001A0 - 0x000001AF
+"\x61\x63\x68\x20\x72\x6F\x77\x20\x6F\x66\x20\x74\x68\x65\x20\x69" // 0x000001B0 - 0x000001BF
+"\x6E\x70\x75\x74\x20\x62\x75\x66\x66\x65\x72\x20\x69\x6E\x74\x6F" // 0x000001C0 - 0x000001CF
+"\x20\x74\x68\x65\x20\x72\x65\x73\x70\x65\x63\x74\x69\x76\x65\x20" // 0x000001D0 - 0x000001DF
+"\x72\x6F\x77\x20\x6F\x66\x20\x74\x68\x65\x20\x6F\x75\x74\x70\x75" // 0x000001E0 - 0x000001EF
+"\x74\x20\x62\x75\x66\x66\x65\x72\x0A\x6B\x65\x72\x6E\x65\x6C\x20" // 0x000001F0 - 0x000001FF
+"\x76\x6F\x69\x64\x20\x43\x53\x28\x0A\x20\x20\x20\x20\x64\x65\x76" // 0x00000200 - 0x0000020F
+"\x69\x63\x65\x20\x75\x69\x6E\x74\x2A\x20\x20\x20\x20\x20\x20\x20" // 0x00000210 - 0x0000021F
+"\x20\x20\x20\x20\x20\x6F\x75\x74\x42\x75\x66\x66\x65\x72\x20\x20" // 0x00000220 - 0x0000022F
+"\x20\x5B\x5B\x62\x75\x66\x66\x65\x72\x28\x30\x29\x5D\x5D\x2C\x0A" // 0x00000230 - 0x0000023F
+"\x20\x20\x20\x20\x63\x6F\x6E\x73\x74\x20\x64\x65\x76\x69\x63\x65" // 0x00000240 - 0x0000024F
+"\x20\x75\x69\x6E\x74\x2A\x20\x20\x20\x20\x20\x20\x69\x6E\x42\x75" // 0x00000250 - 0x0000025F
+"\x66\x66\x65\x72\x20\x20\x20\x20\x5B\x5B\x62\x75\x66\x66\x65\x72" // 0x00000260 - 0x0000026F
+"\x28\x31\x29\x5D\x5D\x2C\x0A\x20\x20\x20\x20\x63\x6F\x6E\x73\x74" // 0x00000270 - 0x0000027F
+"\x61\x6E\x74\x20\x43\x6F\x70\x79\x50\x61\x72\x61\x6D\x73\x26\x20" // 0x00000280 - 0x0000028F
+"\x20\x20\x20\x70\x61\x72\x61\x6D\x73\x20\x20\x20\x20\x20\x20\x5B" // 0x00000290 - 0x0000029F
+"\x5B\x62\x75\x66\x66\x65\x72\x28\x32\x29\x5D\x5D\x2C\x0A\x20\x20" // 0x000002A0 - 0x000002AF
+"\x20\x20\x75\x69\x6E\x74\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20" // 0x000002B0 - 0x000002BF
+"\x20\x20\x20\x20\x20\x20\x20\x20\x20\x20\x74\x68\x72\x65\x61\x64" // 0x000002C0 - 0x000002CF
+"\x49\x44\x20\x20\x20\x20\x5B\x5B\x74\x68\x72\x65\x61\x64\x5F\x70" // 0x000002D0 - 0x000002DF
+"\x6F\x73\x69\x74\x69\x6F\x6E\x5F\x69\x6E\x5F\x67\x72\x69\x64\x5D" // 0x000002E0 - 0x000002EF
+"\x5D\x29\x0A\x7B\x0A\x20\x20\x20\x20\x63\x6F\x6E\x73\x74\x20\x75" // 0x000002F0 - 0x000002FF
+"\x69\x6E\x74\x20\x72\x6F\x77\x20\x3D\x20\x74\x68\x72\x65\x61\x64" // 0x00000300 - 0x0000030F
+"\x49\x44\x20\x2F\x20\x70\x61\x72\x61\x6D\x73\x2E\x6E\x75\x6D\x56" // 0x00000310 - 0x0000031F
+"\x61\x6C\x75\x65\x73\x50\x65\x72\x52\x6F\x77\x3B\x0A\x20\x20\x20" // 0x00000320 - 0x0000032F
+"\x20\x63\x6F\x6E\x73\x74\x20\x75\x69\x6E\x74\x20\x63\x6F\x6C\x20" // 0x00000330 - 0x0000033F
+"\x3D\x20\x74\x68\x72\x65\x61\x64\x49\x44\x20\x25\x20\x70\x61\x72" // 0x00000340 - 0x0000034F
+"\x61\x6D\x73\x2E\x6E\x75\x6D\x56\x61\x6C\x75\x65\x73\x50\x65\x72" // 0x00000350 - 0x0000035F
+"\x52\x6F\x77\x3B\x0A\x20\x20\x20\x20\x69\x66\x20\x28\x72\x6F\x77" // 0x00000360 - 0x0000036F
+"\x20\x3C\x20\x70\x61\x72\x61\x6D\x73\x2E\x6E\x75\x6D\x52\x6F\x77" // 0x00000370 - 0x0000037F
+"\x73\x29\x0A\x20\x20\x20\x20\x20\x20\x20\x20\x6F\x75\x74\x42\x75" // 0x00000380 - 0x0000038F
+"\x66\x66\x65\x72\x5B\x72\x6F\x77\x20\x2A\x20\x70\x61\x72\x61\x6D" // 0x00000390 - 0x0000039F
+"\x73\x2E\x64\x73\x74\x52\x6F\x77\x53\x74\x72\x69\x64\x65\x20\x2B" // 0x000003A0 - 0x000003AF
+"\x20\x63\x6F\x6C\x5D\x20\x3D\x20\x69\x6E\x42\x75\x66\x66\x65\x72" // 0x000003B0 - 0x000003BF
+"\x5B\x72\x6F\x77\x20\x2A\x20\x70\x61\x72\x61\x6D\x73\x2E\x73\x72" // 0x000003C0 - 0x000003CF
+"\x63\x52\x6F\x77\x53\x74\x72\x69\x64\x65\x20\x2B\x20\x63\x6F\x6C" // 0x000003D0 - 0x000003DF
+"\x5D\x3B\x0A\x7D\x0A\x0A\x0A\x0A\x2F\x2F\x20\x3D\x3D\x3D\x3D\x3D" // 0x000003E0 - 0x000003EF
+"\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D" // 0x000003F0 - 0x000003FF
+"\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D" // 0x00000400 - 0x0000040F
+"\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D" // 0x00000410 - 0x0000041F
+"\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D" // 0x00000420 - 0x0000042F
+"\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x3D\x0A" // 0x00000430 - 0x0000043C
@@ -0,0 +1,33 @@
+/*
+ * FillBufferWide.metal
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct FillParams
+{
+    uint4   pattern;        // Fill pattern of one, two, or four 32-bit values
+    uint    patternLength;  // Number of 32-bit values in "pattern": 1, 2, or 4
+    uint    numValues;
+};
+
+// Fill "pattern" into four 32-bit values of the output buffer per thread
+kernel void CS(
+    device uint*            outBuffer   [[buffer(0)]],
+    constant FillParams&    params      [[buffer(1)]],
+    uint                    threadID    [[thread_position_in_grid]])
+{
+    const uint first = threadID * 4;
+    const uint last  = min(first + 4, params.numValues);
+    for (uint i = first; i < last; ++i)
+        outBuffer[i] = params.pattern[i % params.patternLength];
+}
+
+
+
+// ================================================================================
@@ -0,0 +1 @@
+( 983 )
@@ -15,6 +15,13 @@
 extern const char*          g_metalLibFillBufferByte4;
 extern const std::size_t    g_metalLibFillBufferByte4Len;
 
+// Builtin kernels that are compiled from source when the builtin PSOs are created
+extern const char*          g_metalSrcFillBufferWide;
+extern const std::size_t    g_metalSrcFillBufferWideLen;
+
+extern const char*          g_metalSrcCopyBufferStrided;
+extern const std::size_t    g_metalSrcCopyBufferStridedLen;
+
 
 #endif
 
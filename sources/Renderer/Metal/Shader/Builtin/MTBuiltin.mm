@@ -18,6 +18,26 @@ const std::size_t g_metalLibFillBufferByte4Len =
     #include "FillBufferByte4.metallib.len.h"
 );
 
+const char* g_metalSrcFillBufferWide =
+(
+    #include "FillBufferWide.metal.src.h"
+);
+
+const std::size_t g_metalSrcFillBufferWideLen =
+(
+    #include "FillBufferWide.metal.len.h"
+);
+
+const char* g_metalSrcCopyBufferStrided =
+(
+    #include "CopyBufferStrided.metal.src.h"
+);
+
+const std::size_t g_metalSrcCopyBufferStridedLen =
+(
+    #include "CopyBufferStrided.metal.len.h"
+);
+
 
 
 // ================================================================================
@@ -13,6 +13,8 @@
 
 #include <LLGL/Shader.h>
 #include <LLGL/Report.h>
+#include "MTShaderLibrary.h"
+#include <string>
 
 
 namespace LLGL
@@ -28,7 +30,8 @@ class MTShader final : public Shader
 
     public:
 
-        MTShader(id<MTLDevice> device, const ShaderDescriptor& desc);
+        // Creates the shader with an optional cache to share the shader library with all shaders that are created from the same source.
+        MTShader(id<MTLDevice> device, const ShaderDescriptor& desc, MTShaderLibraryCache* libraryCache = nullptr);
         ~MTShader();
 
     public:
@@ -42,11 +45,11 @@ class MTShader final : public Shader
         // Returns the number of patch control points for a post-tessellation vertex shader or 0 if this is not a vertex shader.
         NSUInteger GetNumPatchControlPoints() const;
 
-        // Returns the native MTLFunction object.
-        inline id<MTLFunction> GetNative() const
-        {
-            return native_;
-        }
+        /*
+        Returns the native MTLFunction object.
+        If this shader is specialized with function constants, this blocks until the asynchronous compilation of the specialized function has been completed.
+        */
+        id<MTLFunction> GetNative() const;
 
         // Returns the MTLVertexDescriptor object for this shader program.
         inline MTLVertexDescriptor* GetMTLVertexDesc() const
@@ -54,7 +57,7 @@ class MTShader final : public Shader
             return vertexDesc_;
         }
 
-        // Returns the number of threads per thread-group for compute kernels.
+        // Returns the number of threads per thread-group for compute kernels, object functions, and mesh functions.
         inline const MTLSize& GetNumThreadsPerGroup() const
         {
             return numThreadsPerGroup_;
@@ -62,26 +65,33 @@ class MTShader final : public Shader
 
     private:
 
-        bool Compile(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
-        bool CompileSource(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
-        bool CompileBinary(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
+        bool Compile(id<MTLDevice> device, const ShaderDescriptor& shaderDesc, MTShaderLibraryCache* libraryCache);
+        bool CompileSource(id<MTLDevice> device, const ShaderDescriptor& shaderDesc, MTShaderLibraryCache* libraryCache);
+        bool CompileBinary(id<MTLDevice> device, const ShaderDescriptor& shaderDesc, MTShaderLibraryCache* libraryCache);
+
+        // Takes the shared library for the specified key from the cache. Returns false if no such library has been created yet.
+        bool FindCachedLibrary(MTShaderLibraryCache* libraryCache, const std::string& cacheKey);
+
+        // Takes ownership of the new native library and shares it via the cache if there is one.
+        void StoreLibrary(MTShaderLibraryCache* libraryCache, const std::string& cacheKey, id<MTLLibrary> library);
 
         void BuildInputLayout(std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs);
 
-        bool LoadFunction(const char* entryPoint);
+        bool LoadFunction(const char* entryPoint, const ArrayView<ShaderSpecializationConstant>& specializationConstants);
 
         bool ReflectComputePipeline(ShaderReflection& reflection) const;
 
     private:
 
-        id<MTLDevice>           device_             = nil;
-        id<MTLLibrary>          library_            = nil;
-        id<MTLFunction>         native_             = nil;
+        id<MTLDevice>               device_                 = nil;
+        MTShaderLibrarySPtr         library_;
+        id<MTLFunction>             native_                 = nil;  // Unspecialized function; also used to reflect the function and its constants
+        MTSpecializedFunctionSPtr   specializedFunction_;           // Specialized function that is compiled asynchronously
 
-        Report                  report_;
-        MTLSize                 numThreadsPerGroup_ = {};
+        Report                      report_;
+        MTLSize                     numThreadsPerGroup_     = {};
 
-        MTLVertexDescriptor*    vertexDesc_         = nullptr;
+        MTLVertexDescriptor*        vertexDesc_             = nullptr;
 
 };
 
@@ -18,17 +18,17 @@ namespace LLGL
 {
 
 
-MTShader::MTShader(id<MTLDevice> device, const ShaderDescriptor& desc) :
+MTShader::MTShader(id<MTLDevice> device, const ShaderDescriptor& desc, MTShaderLibraryCache* libraryCache) :
     Shader  { desc.type },
     device_ { device    }
 {
-    if (Compile(device, desc))
+    if (Compile(device, desc, libraryCache))
     {
         /* Build vertex input layout */
         BuildInputLayout(desc.vertex.inputAttribs.size(), desc.vertex.inputAttribs.data());
 
-        /* Store work group size for compute shaders */
-        if (desc.type == ShaderType::Compute)
+        /* Store work group size for compute, object, and mesh shaders */
+        if (desc.type == ShaderType::Compute || desc.type == ShaderType::Task || desc.type == ShaderType::Mesh)
         {
             const auto& workGroupSize = desc.compute.workGroupSize;
             numThreadsPerGroup_ = MTLSizeMake(workGroupSize.width, workGroupSize.height, workGroupSize.depth);
@@ -42,14 +42,17 @@ MTShader::~MTShader()
         [vertexDesc_ release];
     if (native_)
         [native_ release];
-    if (library_)
-        [library_ release];
 }
 
 static MTLLanguageVersion GetMTLLanguageVersion(const ShaderDescriptor& desc)
 {
     if (desc.profile != nullptr)
     {
+        if (std::strcmp(desc.profile, "3.0") == 0)
+        {
+            if (@available(macOS 13.0, iOS 16.0, *))
+                return MTLLanguageVersion3_0;
+        }
         if (std::strcmp(desc.profile, "2.1") == 0)
             return MTLLanguageVersion2_1;
         if (std::strcmp(desc.profile, "2.0") == 0)
@@ -68,6 +71,9 @@ static MTLLanguageVersion GetMTLLanguageVersion(const ShaderDescriptor& desc)
 
 const Report* MTShader::GetReport() const
 {
+    /* Report errors of the specialized function once its compilation has been completed */
+    if (specializedFunction_ && specializedFunction_->Wait() == nil)
+        return &(specializedFunction_->GetReport());
     return (report_ ? &report_ : nullptr);
 }
 
@@ -92,17 +98,25 @@ NSUInteger MTShader::GetNumPatchControlPoints() const
         return 0;
 }
 
+id<MTLFunction> MTShader::GetNative() const
+{
+    if (specializedFunction_)
+        return specializedFunction_->Wait();
+    else
+        return native_;
+}
+
 
 /*
  * ======= Private: =======
  */
 
-bool MTShader::Compile(id<MTLDevice> device, const ShaderDescriptor& shaderDesc)
+bool MTShader::Compile(id<MTLDevice> device, const ShaderDescriptor& shaderDesc, MTShaderLibraryCache* libraryCache)
 {
     if (IsShaderSourceCode(shaderDesc.sourceType))
-        return CompileSource(device, shaderDesc);
+        return CompileSource(device, shaderDesc, libraryCache);
     else
-        return CompileBinary(device, shaderDesc);
+        return CompileBinary(device, shaderDesc, libraryCache);
 }
 
 static NSString* ToNSString(const char* s)
@@ -121,7 +135,27 @@ static MTLCompileOptions* ToMTLCompileOptions(const ShaderDescriptor& shaderDesc
     return opt;
 }
 
-bool MTShader::CompileSource(id<MTLDevice> device, const ShaderDescriptor& shaderDesc)
+// Returns the key to share shader libraries that are compiled from the same source with the same options.
+static std::string GetSourceLibraryCacheKey(NSString* source, MTLCompileOptions* opt)
+{
+    std::string key = "source:";
+    key += std::to_string(static_cast<unsigned long>([opt languageVersion]));
+    key += ([opt fastMathEnabled] ? ":fastmath" : "");
+    key.push_back('\0');
+    key += [source UTF8String];
+    return key;
+}
+
+// Returns the key to share shader libraries that are loaded from the same binary.
+static std::string GetBinaryLibraryCacheKey(const void* data, std::size_t size)
+{
+    std::string key = "binary:";
+    key.push_back('\0');
+    key.append(static_cast<const char*>(data), size);
+    return key;
+}
+
+bool MTShader::CompileSource(id<MTLDevice> device, const ShaderDescriptor& shaderDesc, MTShaderLibraryCache* libraryCache)
 {
     /* Get source */
     NSString* sourceString = nil;
@@ -147,10 +181,19 @@ bool MTShader::CompileSource(id<MTLDevice> device, const ShaderDescriptor& shade
     /* Convert entry point to NSString, and initialize shader compile options */
     MTLCompileOptions* opt = ToMTLCompileOptions(shaderDesc);
 
+    /* Share shader library with all shaders that are compiled from the same source */
+    const std::string cacheKey = (libraryCache != nullptr ? GetSourceLibraryCacheKey(sourceString, opt) : std::string{});
+    if (FindCachedLibrary(libraryCache, cacheKey))
+    {
+        [sourceString release];
+        [opt release];
+        return LoadFunction(shaderDesc.entryPoint, shaderDesc.specializationConstants);
+    }
+
     /* Load shader library */
     NSError* error = [NSError alloc];
 
-    library_ = [device
+    id<MTLLibrary> library = [device
         newLibraryWithSource:   sourceString
         options:                opt
         error:                  &error
@@ -159,18 +202,21 @@ bool MTShader::CompileSource(id<MTLDevice> device, const ShaderDescriptor& shade
     [sourceString release];
     [opt release];
 
-    /* Load shader function with entry point */
-    const bool success = LoadFunction(shaderDesc.entryPoint);
-
     const StringView errorText = [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding];
-    report_.Reset(errorText, !success);
+    report_.Reset(errorText, (library == nil));
     [error release];
 
-    return success;
+    if (library == nil)
+        return false;
+
+    StoreLibrary(libraryCache, cacheKey, library);
+
+    /* Load shader function with entry point */
+    return LoadFunction(shaderDesc.entryPoint, shaderDesc.specializationConstants);
 }
 
 //TODO: this is untested!!!
-bool MTShader::CompileBinary(id<MTLDevice> device, const ShaderDescriptor& shaderDesc)
+bool MTShader::CompileBinary(id<MTLDevice> device, const ShaderDescriptor& shaderDesc, MTShaderLibraryCache* libraryCache)
 {
     /* Get source */
     dispatch_data_t dispatchData = nil;
@@ -198,10 +244,28 @@ bool MTShader::CompileBinary(id<MTLDevice> device, const ShaderDescriptor& shade
         return false;
     }
 
+    /* Share shader library with all shaders that are loaded from the same binary */
+    std::string cacheKey;
+    if (libraryCache != nullptr)
+    {
+        if (source != nullptr)
+            cacheKey = GetBinaryLibraryCacheKey([source bytes], [source length]);
+        else
+            cacheKey = GetBinaryLibraryCacheKey(shaderDesc.source, shaderDesc.sourceSize);
+    }
+
+    if (FindCachedLibrary(libraryCache, cacheKey))
+    {
+        if (source != nullptr)
+            [source release];
+        [dispatchData release];
+        return LoadFunction(shaderDesc.entryPoint, shaderDesc.specializationConstants);
+    }
+
     /* Load shader library */
     NSError* error = [NSError alloc];
 
-    library_ = [device
+    id<MTLLibrary> library = [device
         newLibraryWithData: reinterpret_cast<dispatch_data_t>(dispatchData)
         error:              &error
     ];
@@ -211,14 +275,32 @@ bool MTShader::CompileBinary(id<MTLDevice> device, const ShaderDescriptor& shade
 
     [dispatchData release];
 
-    /* Load shader function with entry point */
-    const bool success = LoadFunction(shaderDesc.entryPoint);
-
     const StringView errorText = [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding];
-    report_.Reset(errorText, !success);
+    report_.Reset(errorText, (library == nil));
     [error release];
 
-    return success;
+    if (library == nil)
+        return false;
+
+    StoreLibrary(libraryCache, cacheKey, library);
+
+    /* Load shader function with entry point */
+    return LoadFunction(shaderDesc.entryPoint, shaderDesc.specializationConstants);
+}
+
+bool MTShader::FindCachedLibrary(MTShaderLibraryCache* libraryCache, const std::string& cacheKey)
+{
+    if (libraryCache != nullptr)
+        library_ = libraryCache->Find(cacheKey);
+    return (library_ != nullptr);
+}
+
+void MTShader::StoreLibrary(MTShaderLibraryCache* libraryCache, const std::string& cacheKey, id<MTLLibrary> library)
+{
+    if (libraryCache != nullptr)
+        library_ = libraryCache->Insert(cacheKey, library);
+    else
+        library_ = std::make_shared<MTShaderLibrary>(library);
 }
 
 // Converts the vertex attribute to a Metal vertex buffer layout
@@ -273,23 +355,27 @@ void MTShader::BuildInputLayout(std::size_t numVertexAttribs, const VertexAttrib
     }
 }
 
-bool MTShader::LoadFunction(const char* entryPoint)
+bool MTShader::LoadFunction(const char* entryPoint, const ArrayView<ShaderSpecializationConstant>& specializationConstants)
 {
-    bool result = false;
-
-    if (library_)
-    {
-        NSString* entryPointStr = ToNSString(entryPoint);
+    if (!library_)
+        return false;
 
-        /* Load shader function with entry point name */
-        native_ = [library_ newFunctionWithName:entryPointStr];
-        if (native_)
-            result = true;
+    /* Load unspecialized shader function with entry point name */
+    NSString* entryPointStr = ToNSString(entryPoint);
+    native_ = [library_->GetNative() newFunctionWithName:entryPointStr];
+    [entryPointStr release];
 
-        [entryPointStr release];
+    if (native_ == nil)
+    {
+        report_.Errorf("failed to load Metal shader function: %s\n", (entryPoint != nullptr ? entryPoint : ""));
+        return false;
     }
 
-    return result;
+    /* Start compiling the specialized function asynchronously, so multiple shaders can be compiled in parallel */
+    if (!specializationConstants.empty())
+        specializedFunction_ = library_->GetOrCreateSpecializedFunction(native_, specializationConstants);
+
+    return true;
 }
 
 static ResourceType ToResourceType(MTLArgumentType type)
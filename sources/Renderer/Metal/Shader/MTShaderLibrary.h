@@ -0,0 +1,144 @@
+/*
+ * MTShaderLibrary.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_MT_SHADER_LIBRARY_H
+#define LLGL_MT_SHADER_LIBRARY_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/ShaderFlags.h>
+#include <LLGL/Report.h>
+#include <LLGL/Container/ArrayView.h>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/*
+Specialized MTLFunction whose compilation is started asynchronously.
+The completion handler may run on any thread, so the function must only be accessed via Wait().
+*/
+class MTSpecializedFunction
+{
+
+    public:
+
+        MTSpecializedFunction() = default;
+        ~MTSpecializedFunction();
+
+        MTSpecializedFunction(const MTSpecializedFunction&) = delete;
+        MTSpecializedFunction& operator = (const MTSpecializedFunction&) = delete;
+
+        // Blocks until the compilation has been completed and returns the specialized function or nil on failure.
+        id<MTLFunction> Wait();
+
+        // Returns the report of the compilation. Must only be called after Wait() has returned.
+        inline const Report& GetReport() const
+        {
+            return report_;
+        }
+
+        // Stores the result of the compilation and wakes up all waiting threads. The function is retained.
+        void Resolve(id<MTLFunction> function, NSError* error);
+
+        // Stores a compilation failure that has been detected before the compilation was started.
+        void Fail(std::string&& errorText);
+
+    private:
+
+        std::mutex              mutex_;
+        std::condition_variable readySignal_;
+        bool                    ready_      = false;
+        id<MTLFunction>         function_   = nil;
+        Report                  report_;
+
+};
+
+using MTSpecializedFunctionSPtr = std::shared_ptr<MTSpecializedFunction>;
+
+/*
+Wrapper for an MTLLibrary that can be shared between multiple shaders.
+Specialized functions are cached for each unique combination of entry point and function constant values,
+so shader permutations only compile their specialized functions once.
+*/
+class MTShaderLibrary
+{
+
+    public:
+
+        // Takes ownership of the specified library.
+        MTShaderLibrary(id<MTLLibrary> library);
+        ~MTShaderLibrary();
+
+        MTShaderLibrary(const MTShaderLibrary&) = delete;
+        MTShaderLibrary& operator = (const MTShaderLibrary&) = delete;
+
+        /*
+        Returns the specialization of the specified function with the function constant values.
+        The function must be the unspecialized function from this library, which provides the types of the function constants.
+        If this specialization is not cached yet, its compilation is started asynchronously.
+        */
+        MTSpecializedFunctionSPtr GetOrCreateSpecializedFunction(
+            id<MTLFunction>                                     function,
+            const ArrayView<ShaderSpecializationConstant>&      constants
+        );
+
+        // Returns the native MTLLibrary object.
+        inline id<MTLLibrary> GetNative() const
+        {
+            return native_;
+        }
+
+    private:
+
+        id<MTLLibrary>                                      native_             = nil;
+
+        std::mutex                                          mutex_;
+        std::map<std::string, MTSpecializedFunctionSPtr>    specializations_;   // Key: Entry point followed by sorted constant IDs and values
+
+};
+
+using MTShaderLibrarySPtr = std::shared_ptr<MTShaderLibrary>;
+
+/*
+Cache of shader libraries that are shared between all shaders created from the same source.
+Libraries are only referenced weakly, so they are released together with the last shader that uses them.
+*/
+class MTShaderLibraryCache
+{
+
+    public:
+
+        // Returns the library for the specified key or null if there is no such library.
+        MTShaderLibrarySPtr Find(const std::string& key);
+
+        // Creates a new shared library for the specified key. Takes ownership of the native library.
+        MTShaderLibrarySPtr Insert(const std::string& key, id<MTLLibrary> library);
+
+    private:
+
+        std::mutex                                              mutex_;
+        std::map<std::string, std::weak_ptr<MTShaderLibrary>>   libraries_;   // Key: Source type, compile options, and source code or binary
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,270 @@
+/*
+ * MTShaderLibrary.mm
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "MTShaderLibrary.h"
+#include "../../../Core/Float16Compressor.h"
+#include <algorithm>
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * MTSpecializedFunction class
+ */
+
+MTSpecializedFunction::~MTSpecializedFunction()
+{
+    if (function_ != nil)
+        [function_ release];
+}
+
+id<MTLFunction> MTSpecializedFunction::Wait()
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    readySignal_.wait(
+        lock,
+        [this]() -> bool
+        {
+            return ready_;
+        }
+    );
+    return function_;
+}
+
+void MTSpecializedFunction::Resolve(id<MTLFunction> function, NSError* error)
+{
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        function_ = [function retain];
+        if (error != nil)
+            report_.Reset([[error localizedDescription] UTF8String], (function == nil));
+        else if (function == nil)
+            report_.Errorf("failed to specialize Metal shader function\n");
+        ready_ = true;
+    }
+    readySignal_.notify_all();
+}
+
+void MTSpecializedFunction::Fail(std::string&& errorText)
+{
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        report_.Reset(std::move(errorText), true);
+        ready_ = true;
+    }
+    readySignal_.notify_all();
+}
+
+
+/*
+ * MTShaderLibrary class
+ */
+
+MTShaderLibrary::MTShaderLibrary(id<MTLLibrary> library) :
+    native_ { library }
+{
+}
+
+MTShaderLibrary::~MTShaderLibrary()
+{
+    [native_ release];
+}
+
+// Returns the function constant with the specified index or nil if the function does not declare such a constant.
+static MTLFunctionConstant* FindFunctionConstant(NSDictionary<NSString*, MTLFunctionConstant*>* functionConstants, std::uint32_t index)
+{
+    for (MTLFunctionConstant* constant in [functionConstants objectEnumerator])
+    {
+        if ([constant index] == index)
+            return constant;
+    }
+    return nil;
+}
+
+// Converts the 32-bit value of the specialization constant into the type of the function constant.
+static bool SetFunctionConstantValue(MTLFunctionConstantValues* values, MTLFunctionConstant* constant, std::uint32_t value)
+{
+    const MTLDataType type = [constant type];
+    const NSUInteger index = [constant index];
+
+    switch (type)
+    {
+        case MTLDataTypeBool:
+        {
+            const bool boolValue = (value != 0);
+            [values setConstantValue:&boolValue type:type atIndex:index];
+        }
+        return true;
+
+        case MTLDataTypeChar:
+        case MTLDataTypeUChar:
+        {
+            const std::uint8_t byteValue = static_cast<std::uint8_t>(value);
+            [values setConstantValue:&byteValue type:type atIndex:index];
+        }
+        return true;
+
+        case MTLDataTypeShort:
+        case MTLDataTypeUShort:
+        {
+            const std::uint16_t shortValue = static_cast<std::uint16_t>(value);
+            [values setConstantValue:&shortValue type:type atIndex:index];
+        }
+        return true;
+
+        case MTLDataTypeInt:
+        case MTLDataTypeUInt:
+        case MTLDataTypeFloat:
+        {
+            [values setConstantValue:&value type:type atIndex:index];
+        }
+        return true;
+
+        case MTLDataTypeHalf:
+        {
+            float floatValue = 0.0f;
+            ::memcpy(&floatValue, &value, sizeof(floatValue));
+            const std::uint16_t halfValue = CompressFloat16(floatValue);
+            [values setConstantValue:&halfValue type:type atIndex:index];
+        }
+        return true;
+
+        default:
+        return false;
+    }
+}
+
+// Appends the 32-bit value to the specified key string.
+static void AppendKeyValue(std::string& key, std::uint32_t value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+MTSpecializedFunctionSPtr MTShaderLibrary::GetOrCreateSpecializedFunction(
+    id<MTLFunction>                                 function,
+    const ArrayView<ShaderSpecializationConstant>&  constants)
+{
+    /* Sort constants by their ID, so the same permutation always maps to the same cache entry */
+    std::vector<ShaderSpecializationConstant> sortedConstants{ constants.begin(), constants.end() };
+    std::stable_sort(
+        sortedConstants.begin(),
+        sortedConstants.end(),
+        [](const ShaderSpecializationConstant& lhs, const ShaderSpecializationConstant& rhs) -> bool
+        {
+            return (lhs.id < rhs.id);
+        }
+    );
+
+    std::string key = [[function name] UTF8String];
+    key.push_back('\0');
+    for (const ShaderSpecializationConstant& constant : sortedConstants)
+    {
+        AppendKeyValue(key, constant.id);
+        AppendKeyValue(key, constant.value);
+    }
+
+    /* Return cached specialization or insert a new entry for it */
+    MTSpecializedFunctionSPtr specialization;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        MTSpecializedFunctionSPtr& entry = specializations_[key];
+        if (entry)
+            return entry;
+        entry = std::make_shared<MTSpecializedFunction>();
+        specialization = entry;
+    }
+
+    /* Convert specialization constants into function constant values with the types declared in the shader */
+    NSDictionary<NSString*, MTLFunctionConstant*>* functionConstants = [function functionConstantsDictionary];
+    MTLFunctionConstantValues* constantValues = [[MTLFunctionConstantValues alloc] init];
+
+    for (const ShaderSpecializationConstant& constant : sortedConstants)
+    {
+        MTLFunctionConstant* functionConstant = FindFunctionConstant(functionConstants, constant.id);
+        if (functionConstant == nil)
+        {
+            [constantValues release];
+            specialization->Fail(
+                "Metal shader function '" + std::string([[function name] UTF8String]) +
+                "' does not declare a function constant with index " + std::to_string(constant.id) + "\n"
+            );
+            return specialization;
+        }
+        if (!SetFunctionConstantValue(constantValues, functionConstant, constant.value))
+        {
+            [constantValues release];
+            specialization->Fail("unsupported type for Metal function constant '" + std::string([[functionConstant name] UTF8String]) + "'\n");
+            return specialization;
+        }
+    }
+
+    /* Start compiling the specialized function; the cache entry is kept alive by the completion handler */
+    void (^completionHandler)(id<MTLFunction>, NSError*) = ^(id<MTLFunction> specializedFunction, NSError* error)
+    {
+        specialization->Resolve(specializedFunction, error);
+    };
+
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        MTLFunctionDescriptor* functionDesc = [[MTLFunctionDescriptor alloc] init];
+        {
+            functionDesc.name           = [function name];
+            functionDesc.constantValues = constantValues;
+        }
+        [native_ newFunctionWithDescriptor:functionDesc completionHandler:completionHandler];
+        [functionDesc release];
+    }
+    else
+        [native_ newFunctionWithName:[function name] constantValues:constantValues completionHandler:completionHandler];
+
+    [constantValues release];
+
+    return specialization;
+}
+
+
+/*
+ * MTShaderLibraryCache class
+ */
+
+MTShaderLibrarySPtr MTShaderLibraryCache::Find(const std::string& key)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    auto it = libraries_.find(key);
+    return (it != libraries_.end() ? it->second.lock() : nullptr);
+}
+
+MTShaderLibrarySPtr MTShaderLibraryCache::Insert(const std::string& key, id<MTLLibrary> library)
+{
+    MTShaderLibrarySPtr sharedLibrary = std::make_shared<MTShaderLibrary>(library);
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Remove entries of libraries that have already been released */
+    for (auto it = libraries_.begin(); it != libraries_.end();)
+    {
+        if (it->second.expired())
+            it = libraries_.erase(it);
+        else
+            ++it;
+    }
+
+    libraries_[key] = sharedLibrary;
+
+    return sharedLibrary;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
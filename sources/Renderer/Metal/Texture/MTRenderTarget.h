@@ -29,6 +29,10 @@ class MTRenderTarget final : public RenderTarget
 
         #include <LLGL/Backend/RenderTarget.inl>
 
+    public:
+
+        void SetActiveExtent(const Extent2D& extent) override;
+
     public:
 
         MTRenderTarget(id<MTLDevice> device, const RenderTargetDescriptor& desc);
@@ -66,7 +70,8 @@ class MTRenderTarget final : public RenderTarget
             NSUInteger      sampleCount = 1u
         );
 
-        id<MTLTexture> CreateAttachmentTexture(id<MTLDevice> device, MTLPixelFormat pixelFormat);
+        // Creates an internal attachment texture. Transient attachments use MTLStorageModeMemoryless if the device supports it.
+        id<MTLTexture> CreateAttachmentTexture(id<MTLDevice> device, MTLPixelFormat pixelFormat, bool isTransient);
 
     private:
 
@@ -10,6 +10,7 @@
 #include "../MTTypes.h"
 #include "../../CheckedCast.h"
 #include "../../RenderTargetUtils.h"
+#include "../../RenderPassUtils.h"
 #include "../../../Core/Exception.h"
 #include <LLGL/Utils/TypeNames.h>
 #include <LLGL/Utils/ForRange.h>
@@ -103,6 +104,13 @@ MTRenderTarget::MTRenderTarget(id<MTLDevice> device, const RenderTargetDescripto
         else
             LLGL_TRAP("invalid format for render-target depth-stencil attachment: %s", ToString(format));
     }
+
+    /* Enable layered rendering for multiview; amplified vertices select their array layer via the view mappings of the PSO */
+    if (const std::uint32_t viewMask = renderPass_.GetViewMask())
+    {
+        if (@available(macOS 10.11, iOS 12.0, *))
+            nativeRenderPass_.renderTargetArrayLength = NumMultiviewArrayLayers(viewMask);
+    }
 }
 
 MTRenderTarget::~MTRenderTarget()
@@ -150,6 +158,24 @@ const RenderPass* MTRenderTarget::GetRenderPass() const
     return (&renderPass_);
 }
 
+void MTRenderTarget::SetActiveExtent(const Extent2D& extent)
+{
+    RenderTarget::SetActiveExtent(extent);
+
+    /* Constrain render area of native render pass descriptors, which also limits the implicit resolve at the end of a render pass */
+    if (@available(iOS 11.0, macOS 10.13, *))
+    {
+        const Extent2D activeExtent = GetActiveExtent();
+        nativeRenderPass_.renderTargetWidth     = activeExtent.width;
+        nativeRenderPass_.renderTargetHeight    = activeExtent.height;
+        if (nativeMutableRenderPass_ != nil)
+        {
+            nativeMutableRenderPass_.renderTargetWidth  = activeExtent.width;
+            nativeMutableRenderPass_.renderTargetHeight = activeExtent.height;
+        }
+    }
+}
+
 MTLRenderPassDescriptor* MTRenderTarget::GetAndUpdateNativeRenderPass(
     const MTRenderPass& renderPass,
     std::uint32_t       numClearValues,
@@ -199,9 +225,10 @@ void MTRenderTarget::CreateAttachment(
     }
     else
     {
-        /* Create internal texture for attachment */
+        /* Create internal texture for attachment; it can be memoryless if its content never leaves the render pass */
         const MTLPixelFormat pixelFormat = MTTypes::ToMTLPixelFormat(inAttachment.format);
-        outAttachment.texture = CreateAttachmentTexture(device, pixelFormat);
+        const bool isTransient = (fmt.loadAction != MTLLoadActionLoad && fmt.storeAction != MTLStoreActionStore);
+        outAttachment.texture = CreateAttachmentTexture(device, pixelFormat, isTransient);
     }
 
     /* Add optional resolve attachment if a texture is specified */
@@ -255,10 +282,16 @@ MTLTextureDescriptor* MTRenderTarget::CreateTextureDesc(
     return texDesc;
 }
 
-id<MTLTexture> MTRenderTarget::CreateAttachmentTexture(id<MTLDevice> device, MTLPixelFormat pixelFormat)
+id<MTLTexture> MTRenderTarget::CreateAttachmentTexture(id<MTLDevice> device, MTLPixelFormat pixelFormat, bool isTransient)
 {
     auto texDesc = CreateTextureDesc(device, pixelFormat, renderPass_.GetSampleCount());
 
+    if (isTransient && MTDevice::SupportsMemorylessStorage(device))
+    {
+        if (@available(macOS 11.0, iOS 10.0, *))
+            texDesc.storageMode = MTLStorageModeMemoryless;
+    }
+
     id<MTLTexture> texture = [device newTextureWithDescriptor:texDesc];
     [texDesc release];
 
@@ -12,6 +12,7 @@
 #import <Metal/Metal.h>
 
 #include <LLGL/Sampler.h>
+#include "../../SamplerCache.h"
 
 
 namespace LLGL
@@ -23,7 +24,8 @@ class MTSampler final : public Sampler
 
     public:
 
-        MTSampler(id<MTLDevice> device, const SamplerDescriptor& desc);
+        // Acquires a Metal sampler state from the specified cache; identical descriptors share one MTLSamplerState.
+        MTSampler(id<MTLDevice> device, SamplerCache<id<MTLSamplerState>>& samplerCache, const SamplerDescriptor& desc);
         ~MTSampler();
     
         // Returns the native MTLSamplerState object.
@@ -42,7 +44,9 @@ class MTSampler final : public Sampler
 
     private:
 
-        id<MTLSamplerState> native_;
+        SamplerCache<id<MTLSamplerState>>&  samplerCache_;
+        id<MTLSamplerState>                 native_         = nil;
+        SamplerDescriptor                   desc_;
 
 };
 
@@ -16,14 +16,28 @@ namespace LLGL
 {
 
 
-MTSampler::MTSampler(id<MTLDevice> device, const SamplerDescriptor& desc) :
-    native_ { MTSampler::CreateNative(device, desc) }
+MTSampler::MTSampler(id<MTLDevice> device, SamplerCache<id<MTLSamplerState>>& samplerCache, const SamplerDescriptor& desc) :
+    samplerCache_ { samplerCache },
+    desc_         { desc         }
 {
+    native_ = samplerCache_.Acquire(
+        desc,
+        [device](const SamplerDescriptor& samplerDesc) -> id<MTLSamplerState>
+        {
+            return MTSampler::CreateNative(device, samplerDesc);
+        }
+    );
 }
 
 MTSampler::~MTSampler()
 {
-    [native_ release];
+    samplerCache_.Release(
+        desc_,
+        [](id<MTLSamplerState> samplerState)
+        {
+            [samplerState release];
+        }
+    );
 }
 
 #ifndef LLGL_OS_IOS
@@ -23,6 +23,7 @@ struct DstImageDescriptor;
 struct SubresourceLayout;
 struct FormatAttributes;
 class MTIntermediateBuffer;
+class MTHeapAllocator;
 
 class MTTexture final : public Texture
 {
@@ -33,7 +34,7 @@ class MTTexture final : public Texture
 
     public:
 
-        MTTexture(id<MTLDevice> device, const TextureDescriptor& desc);
+        MTTexture(id<MTLDevice> device, const TextureDescriptor& desc, MTHeapAllocator* heapAllocator = nullptr);
         ~MTTexture();
 
         // Returns the region for the specified subresource.
@@ -8,6 +8,7 @@
 #include "MTTexture.h"
 #include "../MTTypes.h"
 #include "../MTDevice.h"
+#include "../MTHeapAllocator.h"
 #include "../Buffer/MTIntermediateBuffer.h"
 #include "../../TextureUtils.h"
 #include <LLGL/TextureFlags.h>
@@ -86,20 +87,36 @@ static void ConvertTextureDesc(id<MTLDevice> device, MTLTextureDescriptor* dst,
     dst.resourceOptions     = GetResourceOptions(src);
     if (IsMultiSampleTexture(src.type) || IsDepthOrStencilFormat(src.format))
         dst.storageMode = MTLStorageModePrivate;
+
+    /* Transient attachments are never loaded or stored, so they don't need any system memory on Apple GPUs */
+    if ((src.miscFlags & MiscFlags::Transient) != 0 && MTDevice::SupportsMemorylessStorage(device))
+    {
+        if (@available(macOS 11.0, iOS 10.0, *))
+        {
+            dst.usage       = MTLTextureUsageRenderTarget;
+            dst.storageMode = MTLStorageModeMemoryless;
+        }
+    }
 }
 
-MTTexture::MTTexture(id<MTLDevice> device, const TextureDescriptor& desc) :
+MTTexture::MTTexture(id<MTLDevice> device, const TextureDescriptor& desc, MTHeapAllocator* heapAllocator) :
     Texture { desc.type, desc.bindFlags }
 {
     MTLTextureDescriptor* texDesc = [[MTLTextureDescriptor alloc] init];
     ConvertTextureDesc(device, texDesc, desc);
-    native_ = [device newTextureWithDescriptor:texDesc];
+    if (heapAllocator != nullptr)
+        native_ = heapAllocator->NewTexture(texDesc);
+    if (native_ == nil)
+        native_ = [device newTextureWithDescriptor:texDesc];
     [texDesc release];
 }
 
 MTTexture::~MTTexture()
 {
-    [native_ release];
+    if (MTHeapAllocator::IsHeapResource(native_))
+        MTHeapAllocator::ReleaseHeapResource(native_);
+    else
+        [native_ release];
 }
 
 Extent3D MTTexture::GetMipExtent(std::uint32_t mipLevel) const
@@ -177,6 +194,12 @@ SubresourceFootprint MTTexture::GetSubresourceFootprint(std::uint32_t mipLevel)
     return CalcPackedSubresourceFootprint(GetType(), GetFormat(), GetMipExtent(0), mipLevel, numArrayLayers);
 }
 
+Extent3D MTTexture::GetSparseTileExtent() const
+{
+    /* Sparse textures are not supported by this backend */
+    return {};
+}
+
 void MTTexture::WriteRegion(const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
     /* Convert region to MTLRegion */
@@ -10,6 +10,8 @@
 
 
 #include <LLGL/IndirectArguments.h>
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/Format.h>
 #include <cstddef>
 #include <cstdint>
 
@@ -20,6 +22,8 @@ namespace LLGL
 
 class NullBuffer;
 class NullTexture;
+class NullPipelineState;
+class NullResourceHeap;
 
 
 struct NullCmdBufferWrite
@@ -58,23 +62,81 @@ struct NullCmdGenerateMips
     std::uint32_t   numMipLevels;
 };
 
-//TODO...
+struct NullCmdSetViewports
+{
+    std::size_t numViewports;
+//  Viewport    viewports[numViewports];
+};
+
+struct NullCmdSetScissors
+{
+    std::size_t numScissors;
+//  Scissor     scissors[numScissors];
+};
+
+struct NullCmdSetVertexBuffers
+{
+    std::size_t         numVertexBuffers;
+//  const NullBuffer*   vertexBuffers[numVertexBuffers];
+};
+
+struct NullCmdSetIndexBuffer
+{
+    const NullBuffer*   buffer;
+    Format              format;
+    std::uint64_t       offset;
+};
+
+struct NullCmdSetPipelineState
+{
+    const NullPipelineState* pipelineState;
+};
+
+struct NullCmdSetResourceHeap
+{
+    const NullResourceHeap* resourceHeap;
+    std::uint32_t           descriptorSet;
+};
+
+struct NullCmdSetResource
+{
+    std::uint32_t   descriptor;
+    const Resource* resource;
+};
+
+struct NullCmdSetUniforms
+{
+    std::uint32_t   first;
+    std::uint16_t   dataSize;
+//  std::int8_t     data[dataSize];
+};
+
+struct NullCmdBeginRenderPass
+{
+    const RenderTarget* renderTarget;
+    std::uint32_t       numClearValues;
+};
+
+//struct NullCmdEndRenderPass {};
+
+struct NullCmdClearAttachments
+{
+    std::uint32_t numAttachments;
+};
 
 struct NullCmdDraw
 {
-    DrawIndirectArguments   args;
-    std::size_t             numVertexBuffers;
-//  const NullBuffer*       vertexBuffers[numVertexBuffers];
+    DrawIndirectArguments args;
 };
 
 struct NullCmdDrawIndexed
 {
-    DrawIndexedIndirectArguments    args;
-    const NullBuffer*               indexBuffer;
-    Format                          indexBufferFormat;
-    std::uint64_t                   indexBufferOffset;
-    std::size_t                     numVertexBuffers;
-//  const NullBuffer*               vertexBuffers[numVertexBuffers];
+    DrawIndexedIndirectArguments args;
+};
+
+struct NullCmdDispatch
+{
+    std::uint32_t numWorkGroups[3];
 };
 
 struct NullCmdPushDebugGroup
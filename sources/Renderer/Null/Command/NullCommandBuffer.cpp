@@ -9,6 +9,7 @@
 #include "NullCommandExecutor.h"
 #include "NullCommand.h"
 #include "../../CheckedCast.h"
+#include "../../FrameCounters.h"
 #include "../../../Core/CoreUtils.h"
 #include <LLGL/TypeInfo.h>
 
@@ -23,14 +24,16 @@
 
 #include <LLGL/RenderingDebugger.h>
 #include <LLGL/IndirectArguments.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
-    desc { desc }
+NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc, const RendererConfigurationNull& config) :
+    desc    { desc   },
+    config_ { config }
 {
 }
 
@@ -38,6 +41,8 @@ NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
 
 void NullCommandBuffer::Begin()
 {
+    LLGL_FRAME_COUNTER_BEGIN();
+
     buffer_.Clear();
 }
 
@@ -52,6 +57,12 @@ void NullCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
     auto& deferredCommandBufferNull = LLGL_CAST(NullCommandBuffer&, deferredCommandBuffer);
     if ((deferredCommandBufferNull.desc.flags & CommandBufferFlags::Secondary) != 0)
         deferredCommandBufferNull.ExecuteVirtualCommands();
+    LLGL_FRAME_COUNTER_EXECUTE(deferredCommandBufferNull.GetFrameCounters());
+}
+
+void NullCommandBuffer::TrimMemory()
+{
+    // dummy
 }
 
 /* ----- Blitting ----- */
@@ -62,6 +73,8 @@ void NullCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferUpdates);
+
     auto dstBufferNull = LLGL_CAST(NullBuffer*, &dstBuffer);
     auto cmd = AllocCommand<NullCmdBufferWrite>(NullOpcodeBufferWrite, dataSize);
     {
@@ -79,6 +92,8 @@ void NullCommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto cmd = AllocCommand<NullCmdCopySubresource>(NullOpcodeCopySubresource);
     {
         cmd->srcResource    = &srcBuffer;
@@ -122,6 +137,8 @@ void NullCommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& srcTextureNull = LLGL_CAST(NullTexture&, srcTexture);
     const auto extent = GetSubresourceExtent(srcTextureNull.GetType(), srcRegion.extent, srcRegion.subresource.numArrayLayers);
     auto cmd = AllocCommand<NullCmdCopySubresource>(NullOpcodeCopySubresource);
@@ -150,6 +167,21 @@ void NullCommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
+    //auto& dstBufferNull = LLGL_CAST(NullBuffer&, dstBuffer);
+    //todo
+}
+
+void NullCommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
     //auto& dstBufferNull = LLGL_CAST(NullBuffer&, dstBuffer);
     //todo
 }
@@ -161,6 +193,8 @@ void NullCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureNull = LLGL_CAST(NullTexture&, dstTexture);
     auto& srcTextureNull = LLGL_CAST(NullTexture&, srcTexture);
     auto cmd = AllocCommand<NullCmdCopySubresource>(NullOpcodeCopySubresource);
@@ -191,6 +225,8 @@ void NullCommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureNull = LLGL_CAST(NullTexture&, dstTexture);
     const auto extent = GetSubresourceExtent(dstTextureNull.GetType(), dstRegion.extent, dstRegion.subresource.numArrayLayers);
     auto cmd = AllocCommand<NullCmdCopySubresource>(NullOpcodeCopySubresource);
@@ -218,11 +254,15 @@ void NullCommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     //todo
 }
 
 void NullCommandBuffer::GenerateMips(Texture& texture)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     auto cmd = AllocCommand<NullCmdGenerateMips>(NullOpcodeGenerateMips);
     {
@@ -236,6 +276,8 @@ void NullCommandBuffer::GenerateMips(Texture& texture)
 
 void NullCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     auto cmd = AllocCommand<NullCmdGenerateMips>(NullOpcodeGenerateMips);
     {
@@ -247,69 +289,101 @@ void NullCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource&
     }
 }
 
+void NullCommandBuffer::CompressTexture(Texture& /*dstTexture*/, Texture& /*srcTexture*/, const TextureSubresource& /*subresource*/)
+{
+    // dummy
+}
+
 /* ----- Viewport and Scissor ----- */
 
 void NullCommandBuffer::SetViewport(const Viewport& viewport)
 {
-    renderState_.viewports = { viewport };
+    SetViewports(1, &viewport);
 }
 
 void NullCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
 {
-    renderState_.viewports = SmallVector<Viewport>(viewports, viewports + numViewports);
+    auto cmd = AllocCommand<NullCmdSetViewports>(NullOpcodeSetViewports, sizeof(Viewport) * numViewports);
+    {
+        cmd->numViewports = numViewports;
+        ::memcpy(cmd + 1, viewports, sizeof(Viewport) * numViewports);
+    }
 }
 
 void NullCommandBuffer::SetScissor(const Scissor& scissor)
 {
-    renderState_.scissors = { scissor };
+    SetScissors(1, &scissor);
 }
 
 void NullCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
 {
-    renderState_.scissors = SmallVector<Scissor>(scissors, scissors + numScissors);
+    auto cmd = AllocCommand<NullCmdSetScissors>(NullOpcodeSetScissors, sizeof(Scissor) * numScissors);
+    {
+        cmd->numScissors = numScissors;
+        ::memcpy(cmd + 1, scissors, sizeof(Scissor) * numScissors);
+    }
 }
 
 /* ----- Buffers ------ */
 
 void NullCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
-    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    renderState_.vertexBuffers = { &bufferNull };
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
+    auto* bufferNull = LLGL_CAST(NullBuffer*, &buffer);
+    AllocSetVertexBuffersCommand(1, &bufferNull);
 }
 
 void NullCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferArrayNull = LLGL_CAST(NullBufferArray&, bufferArray);
-    renderState_.vertexBuffers = SmallVector<const NullBuffer*>(bufferArrayNull.buffers.begin(), bufferArrayNull.buffers.end());
+    AllocSetVertexBuffersCommand(bufferArrayNull.buffers.size(), bufferArrayNull.buffers.data());
 }
 
 void NullCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    renderState_.indexBuffer        = &bufferNull;
-    renderState_.indexBufferFormat  = bufferNull.desc.format;
-    renderState_.indexBufferOffset  = 0;
+    AllocSetIndexBufferCommand(bufferNull, bufferNull.desc.format, 0);
 }
 
 void NullCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    renderState_.indexBuffer        = &bufferNull;
-    renderState_.indexBufferFormat  = format;
-    renderState_.indexBufferOffset  = offset;
+    AllocSetIndexBufferCommand(bufferNull, format, offset);
 }
 
 /* ----- Resources ----- */
 
 void NullCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
-    //auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
-    //todo
+    LLGL_FRAME_COUNTER_INC(resourceHeapBindings);
+
+    auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
+    auto cmd = AllocCommand<NullCmdSetResourceHeap>(NullOpcodeSetResourceHeap);
+    {
+        cmd->resourceHeap   = &resourceHeapNull;
+        cmd->descriptorSet  = descriptorSet;
+    }
 }
 
 void NullCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
-    //todo
+    LLGL_FRAME_COUNTER_RESOURCE(resource);
+
+    AllocSetResourceCommand(descriptor, resource);
+}
+
+void NullCommandBuffer::SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t /*offset*/, std::uint64_t /*size*/)
+{
+    LLGL_FRAME_COUNTER_RESOURCE(buffer);
+
+    AllocSetResourceCommand(descriptor, buffer);
 }
 
 void NullCommandBuffer::ResetResourceSlots(
@@ -331,39 +405,48 @@ void NullCommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       /*swapBufferIndex*/)
 {
-    if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
-    {
-        //auto& swapChainNull = LLGL_CAST(NullSwapChain&, renderTarget);
-        //todo
-    }
-    else
+    LLGL_FRAME_COUNTER_INC(renderPassSections);
+
+    auto cmd = AllocCommand<NullCmdBeginRenderPass>(NullOpcodeBeginRenderPass);
     {
-        //auto& renderTargetNull = LLGL_CAST(NullRenderTarget&, renderTarget);
-        //todo
+        cmd->renderTarget   = &renderTarget;
+        cmd->numClearValues = (renderPass != nullptr ? numClearValues : 0);
     }
 }
 
 void NullCommandBuffer::EndRenderPass()
 {
-    //todo
+    AllocOpcode(NullOpcodeEndRenderPass);
 }
 
-void NullCommandBuffer::Clear(long flags, const ClearValue& clearValue)
+void NullCommandBuffer::Clear(long /*flags*/, const ClearValue& /*clearValue*/)
 {
-    //todo
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
+    AllocClearAttachmentsCommand(1);
 }
 
-void NullCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+void NullCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* /*attachments*/)
 {
-    //todo
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
+    AllocClearAttachmentsCommand(numAttachments);
 }
 
 /* ----- Pipeline States ----- */
 
 void NullCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    //auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
-    //todo
+    auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
+    if (pipelineStateNull.isGraphicsPSO)
+        LLGL_FRAME_COUNTER_INC(graphicsPipelineBindings);
+    else
+        LLGL_FRAME_COUNTER_INC(computePipelineBindings);
+
+    auto cmd = AllocCommand<NullCmdSetPipelineState>(NullOpcodeSetPipelineState);
+    {
+        cmd->pipelineState = &pipelineStateNull;
+    }
 }
 
 void NullCommandBuffer::SetBlendFactor(const float color[4])
@@ -378,13 +461,20 @@ void NullCommandBuffer::SetStencilReference(std::uint32_t reference, const Stenc
 
 void NullCommandBuffer::SetUniforms(std::uint32_t first, const void* data, std::uint16_t dataSize)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdSetUniforms>(NullOpcodeSetUniforms, dataSize);
+    {
+        cmd->first      = first;
+        cmd->dataSize   = dataSize;
+        ::memcpy(cmd + 1, data, dataSize);
+    }
 }
 
 /* ----- Queries ----- */
 
 void NullCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_FRAME_COUNTER_INC(querySections);
+
     //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
     //todo
 }
@@ -397,6 +487,8 @@ void NullCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 
 void NullCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_FRAME_COUNTER_INC(renderConditionSections);
+
     //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
     //todo
 }
@@ -410,6 +502,8 @@ void NullCommandBuffer::EndRenderCondition()
 
 void NullCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
+    LLGL_FRAME_COUNTER_INC(streamOutputSections);
+
     // dummy
 }
 
@@ -422,6 +516,8 @@ void NullCommandBuffer::EndStreamOutput()
 
 void NullCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     DrawIndirectArguments drawArgs;
     {
         drawArgs.numVertices    = numVertices;
@@ -434,6 +530,8 @@ void NullCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVerte
 
 void NullCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     DrawIndexedIndirectArguments drawArgs;
     {
         drawArgs.numIndices     = numIndices;
@@ -447,6 +545,8 @@ void NullCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firs
 
 void NullCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     DrawIndexedIndirectArguments drawArgs;
     {
         drawArgs.numIndices     = numIndices;
@@ -460,6 +560,8 @@ void NullCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firs
 
 void NullCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     DrawIndirectArguments drawArgs;
     {
         drawArgs.numVertices    = numVertices;
@@ -472,6 +574,8 @@ void NullCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t f
 
 void NullCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     DrawIndirectArguments drawArgs;
     {
         drawArgs.numVertices    = numVertices;
@@ -484,6 +588,8 @@ void NullCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t f
 
 void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     DrawIndexedIndirectArguments drawArgs;
     {
         drawArgs.numIndices     = numIndices;
@@ -497,6 +603,8 @@ void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint
 
 void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     DrawIndexedIndirectArguments drawArgs;
     {
         drawArgs.numIndices     = numIndices;
@@ -510,6 +618,8 @@ void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint
 
 void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     DrawIndexedIndirectArguments drawArgs;
     {
         drawArgs.numIndices     = numIndices;
@@ -523,6 +633,8 @@ void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint
 
 void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     DrawIndirectArguments drawArgs;
     bufferNull.Read(offset, &drawArgs, sizeof(drawArgs));
@@ -531,6 +643,8 @@ void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 
 void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     DrawIndirectArguments drawArgs;
     while (numCommands-- > 0)
@@ -543,6 +657,8 @@ void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::
 
 void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     DrawIndexedIndirectArguments drawArgs;
     bufferNull.Read(offset, &drawArgs, sizeof(drawArgs));
@@ -551,6 +667,8 @@ void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset
 
 void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     DrawIndexedIndirectArguments drawArgs;
     while (numCommands-- > 0)
@@ -561,14 +679,97 @@ void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset
     }
 }
 
+void NullCommandBuffer::DrawIndirectCount(
+    Buffer&         argsBuffer,
+    std::uint64_t   argsOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    std::uint32_t   maxNumCommands,
+    std::uint32_t   stride)
+{
+    auto& countBufferNull = LLGL_CAST(NullBuffer&, countBuffer);
+    std::uint32_t numCommands = 0;
+    countBufferNull.Read(countOffset, &numCommands, sizeof(numCommands));
+    DrawIndirect(argsBuffer, argsOffset, std::min(numCommands, maxNumCommands), stride);
+}
+
+void NullCommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         argsBuffer,
+    std::uint64_t   argsOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    std::uint32_t   maxNumCommands,
+    std::uint32_t   stride)
+{
+    auto& countBufferNull = LLGL_CAST(NullBuffer&, countBuffer);
+    std::uint32_t numCommands = 0;
+    countBufferNull.Read(countOffset, &numCommands, sizeof(numCommands));
+    DrawIndexedIndirect(argsBuffer, argsOffset, std::min(numCommands, maxNumCommands), stride);
+}
+
+void NullCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void NullCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void NullCommandBuffer::DrawStreamOutput()
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
 /* ----- Compute ----- */
 
 void NullCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
-    // dummy
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
+    AllocDispatchCommand(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void NullCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    DispatchIndirectArguments dispatchArgs;
+    bufferNull.Read(offset, &dispatchArgs, sizeof(dispatchArgs));
+    AllocDispatchCommand(dispatchArgs.numThreadGroups[0], dispatchArgs.numThreadGroups[1], dispatchArgs.numThreadGroups[2]);
+}
+
+void NullCommandBuffer::CompactIndirectArguments(
+    Buffer&         /*dstBuffer*/,
+    std::uint64_t   /*dstOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    Buffer&         /*srcBuffer*/,
+    std::uint64_t   /*srcOffset*/,
+    Buffer&         /*visibilityBuffer*/,
+    std::uint64_t   /*visibilityOffset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    // dummy
+}
+
+/* ----- Ray Tracing ----- */
+
+void NullCommandBuffer::BuildAccelerationStructure(AccelerationStructure& /*accelerationStructure*/, const AccelerationStructureBuildDescriptor& /*buildDesc*/)
+{
+    // dummy
+}
+
+void NullCommandBuffer::CopyAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/, bool /*compact*/)
 {
     // dummy
 }
@@ -608,7 +809,7 @@ bool NullCommandBuffer::GetNativeHandle(void* nativeHandle, std::size_t nativeHa
 
 void NullCommandBuffer::ExecuteVirtualCommands()
 {
-    ExecuteNullVirtualCommandBuffer(buffer_);
+    ExecuteNullVirtualCommandBuffer(buffer_, config_, ((desc.flags & CommandBufferFlags::Secondary) != 0));
     if ((desc.flags & CommandBufferFlags::MultiSubmit) == 0)
         buffer_.Clear();
 }
@@ -629,26 +830,65 @@ TCommand* NullCommandBuffer::AllocCommand(const NullOpcode opcode, std::size_t p
     return buffer_.AllocCommand<TCommand>(opcode, payloadSize);
 }
 
+void NullCommandBuffer::AllocSetVertexBuffersCommand(std::size_t numVertexBuffers, NullBuffer* const * vertexBuffers)
+{
+    auto cmd = AllocCommand<NullCmdSetVertexBuffers>(NullOpcodeSetVertexBuffers, sizeof(const NullBuffer*) * numVertexBuffers);
+    {
+        cmd->numVertexBuffers = numVertexBuffers;
+        ::memcpy(cmd + 1, vertexBuffers, sizeof(const NullBuffer*) * numVertexBuffers);
+    }
+}
+
+void NullCommandBuffer::AllocSetIndexBufferCommand(const NullBuffer& buffer, const Format format, std::uint64_t offset)
+{
+    auto cmd = AllocCommand<NullCmdSetIndexBuffer>(NullOpcodeSetIndexBuffer);
+    {
+        cmd->buffer = &buffer;
+        cmd->format = format;
+        cmd->offset = offset;
+    }
+}
+
+void NullCommandBuffer::AllocSetResourceCommand(std::uint32_t descriptor, const Resource& resource)
+{
+    auto cmd = AllocCommand<NullCmdSetResource>(NullOpcodeSetResource);
+    {
+        cmd->descriptor = descriptor;
+        cmd->resource   = &resource;
+    }
+}
+
+void NullCommandBuffer::AllocClearAttachmentsCommand(std::uint32_t numAttachments)
+{
+    auto cmd = AllocCommand<NullCmdClearAttachments>(NullOpcodeClearAttachments);
+    {
+        cmd->numAttachments = numAttachments;
+    }
+}
+
 void NullCommandBuffer::AllocDrawCommand(const DrawIndirectArguments& args)
 {
-    auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw, sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+    auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw);
     {
-        cmd->args               = args;
-        cmd->numVertexBuffers   = renderState_.vertexBuffers.size();
-        ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+        cmd->args = args;
     }
 }
 
 void NullCommandBuffer::AllocDrawIndexedCommand(const DrawIndexedIndirectArguments& args)
 {
-    auto cmd = AllocCommand<NullCmdDrawIndexed>(NullOpcodeDrawIndexed, sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+    auto cmd = AllocCommand<NullCmdDrawIndexed>(NullOpcodeDrawIndexed);
+    {
+        cmd->args = args;
+    }
+}
+
+void NullCommandBuffer::AllocDispatchCommand(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    auto cmd = AllocCommand<NullCmdDispatch>(NullOpcodeDispatch);
     {
-        cmd->args               = args;
-        cmd->indexBuffer        = renderState_.indexBuffer;
-        cmd->indexBufferFormat  = renderState_.indexBufferFormat;
-        cmd->indexBufferOffset  = renderState_.indexBufferOffset;
-        cmd->numVertexBuffers   = renderState_.vertexBuffers.size();
-        ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+        cmd->numWorkGroups[0] = numWorkGroupsX;
+        cmd->numWorkGroups[1] = numWorkGroupsY;
+        cmd->numWorkGroups[2] = numWorkGroupsZ;
     }
 }
 
@@ -10,7 +10,8 @@
 
 
 #include <LLGL/CommandBuffer.h>
-#include <LLGL/Container/SmallVector.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/RendererConfiguration.h>
 #include "NullCommandOpcode.h"
 #include "../../VirtualCommandBuffer.h"
 
@@ -21,7 +22,7 @@ namespace LLGL
 
 class NullBuffer;
 
-using NullVirtualCommandBuffer = VirtualCommandBuffer<NullOpcode>;
+using NullVirtualCommandBuffer = VirtualCommandBuffer<NullOpcode, sizeof(void*)>;
 
 class NullCommandBuffer final : public CommandBuffer
 {
@@ -32,29 +33,23 @@ class NullCommandBuffer final : public CommandBuffer
 
     public:
 
-        NullCommandBuffer(const CommandBufferDescriptor& desc);
+        NullCommandBuffer(const CommandBufferDescriptor& desc, const RendererConfigurationNull& config);
 
     public:
 
         // Executes the internal virtual command buffer.
         void ExecuteVirtualCommands();
 
+        // Returns the frame counters of the current encoding. See LLGL_ENABLE_FRAME_COUNTERS.
+        inline const FrameProfile& GetFrameCounters() const
+        {
+            return frameCounters_;
+        }
+
     public:
 
         const CommandBufferDescriptor desc;
 
-    private:
-
-        struct RenderState
-        {
-            SmallVector<Viewport>           viewports;
-            SmallVector<Scissor>            scissors;
-            SmallVector<const NullBuffer*>  vertexBuffers;
-            const NullBuffer*               indexBuffer         = nullptr;
-            Format                          indexBufferFormat   = Format::Undefined;
-            std::uint64_t                   indexBufferOffset   = 0;
-        };
-
     private:
 
         // Allocates only an opcode for empty commands.
@@ -64,13 +59,20 @@ class NullCommandBuffer final : public CommandBuffer
         template <typename TCommand>
         TCommand* AllocCommand(const NullOpcode opcode, std::size_t payloadSize = 0);
 
+        void AllocSetVertexBuffersCommand(std::size_t numVertexBuffers, NullBuffer* const * vertexBuffers);
+        void AllocSetIndexBufferCommand(const NullBuffer& buffer, const Format format, std::uint64_t offset);
+        void AllocSetResourceCommand(std::uint32_t descriptor, const Resource& resource);
+        void AllocClearAttachmentsCommand(std::uint32_t numAttachments);
+
         void AllocDrawCommand(const DrawIndirectArguments& args);
         void AllocDrawIndexedCommand(const DrawIndexedIndirectArguments& args);
+        void AllocDispatchCommand(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ);
 
     private:
 
-        NullVirtualCommandBuffer    buffer_;
-        RenderState                 renderState_;
+        const RendererConfigurationNull&    config_;
+        NullVirtualCommandBuffer            buffer_;
+        FrameProfile                        frameCounters_;
 
 };
 
@@ -15,25 +15,155 @@
 #include "../Buffer/NullBuffer.h"
 
 #include "../RenderState/NullPipelineState.h"
+#include "../RenderState/NullPipelineLayout.h"
 #include "../RenderState/NullResourceHeap.h"
 #include "../RenderState/NullRenderPass.h"
 #include "../RenderState/NullQueryHeap.h"
 
 #include "../../CheckedCast.h"
+#include <LLGL/Container/SmallVector.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/Timer.h>
+#include <LLGL/Log.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
+// State of a single command buffer execution to validate the command stream and to accumulate its synthetic costs.
+struct NullExecutionState
 {
+    NullExecutionState(const RendererConfigurationNull& config, bool isSecondary) :
+        config           { config      },
+        insideRenderPass { isSecondary }
+    {
+    }
+
+    const RendererConfigurationNull&    config;
+    std::size_t                         commandIndex        = 0;
+    std::uint64_t                       cost                = 0; // Accumulated synthetic cost in nanoseconds
+
+    const NullPipelineState*            pipelineState       = nullptr;
+    const NullResourceHeap*             resourceHeap        = nullptr;
+    std::uint32_t                       descriptorSet       = 0;
+    SmallVector<const Resource*>        resources;
+    SmallVector<const NullBuffer*>      vertexBuffers;
+    const NullBuffer*                   indexBuffer         = nullptr;
+    Format                              indexFormat         = Format::Undefined;
+    std::uint64_t                       indexOffset         = 0;
+    std::size_t                         numViewports        = 0;
+    bool                                insideRenderPass    = false;
+    std::uint32_t                       debugGroupDepth     = 0;
+};
+
+static const char* NullOpcodeToString(const NullOpcode opcode)
+{
+    switch (opcode)
+    {
+        case NullOpcodeBufferWrite:         return "UpdateBuffer";
+        case NullOpcodeCopySubresource:     return "Copy";
+        case NullOpcodeGenerateMips:        return "GenerateMips";
+        case NullOpcodeSetViewports:        return "SetViewports";
+        case NullOpcodeSetScissors:         return "SetScissors";
+        case NullOpcodeSetVertexBuffers:    return "SetVertexBuffer";
+        case NullOpcodeSetIndexBuffer:      return "SetIndexBuffer";
+        case NullOpcodeSetPipelineState:    return "SetPipelineState";
+        case NullOpcodeSetResourceHeap:     return "SetResourceHeap";
+        case NullOpcodeSetResource:         return "SetResource";
+        case NullOpcodeSetUniforms:         return "SetUniforms";
+        case NullOpcodeBeginRenderPass:     return "BeginRenderPass";
+        case NullOpcodeEndRenderPass:       return "EndRenderPass";
+        case NullOpcodeClearAttachments:    return "Clear";
+        case NullOpcodeDraw:                return "Draw";
+        case NullOpcodeDrawIndexed:         return "DrawIndexed";
+        case NullOpcodeDispatch:            return "Dispatch";
+        case NullOpcodePushDebugGroup:      return "PushDebugGroup";
+        case NullOpcodePopDebugGroup:       return "PopDebugGroup";
+        default:                            return "<unknown>";
+    }
+}
+
+// Reports a validation error if the specified condition is false. Returns the condition.
+static bool ValidateNullCommand(NullExecutionState& state, const NullOpcode opcode, bool condition, const char* message)
+{
+    if (!condition)
+        Log::Errorf("Null validation error in command #%zu (%s): %s\n", state.commandIndex, NullOpcodeToString(opcode), message);
+    return condition;
+}
+
+static void AddStateChangeCost(NullExecutionState& state, bool changed)
+{
+    if (changed)
+        state.cost += state.config.stateChangeCost;
+}
+
+static void AddTransferCost(NullExecutionState& state, std::uint64_t size)
+{
+    state.cost += (size * state.config.transferCostPerKB) / 1024;
+}
+
+static std::uint64_t GetCopySubresourceSize(const NullCmdCopySubresource& cmd)
+{
+    /* Determine size from the texture format, since buffer-to-buffer copies only specify the width in bytes */
+    const Resource* texture = (cmd.dstResource->GetResourceType() == ResourceType::Texture ? cmd.dstResource : cmd.srcResource);
+    if (texture->GetResourceType() == ResourceType::Texture)
+    {
+        auto* textureNull = LLGL_CAST(const NullTexture*, texture);
+        return GetMemoryFootprint(textureNull->desc.format, static_cast<std::size_t>(cmd.width * cmd.height * cmd.depth));
+    }
+    return cmd.width;
+}
+
+static void ValidateDrawCommand(NullExecutionState& state, const NullOpcode opcode)
+{
+    ValidateNullCommand(state, opcode, state.insideRenderPass, "draw command outside of render pass");
+    if (ValidateNullCommand(state, opcode, state.pipelineState != nullptr, "no pipeline state bound"))
+        ValidateNullCommand(state, opcode, state.pipelineState->isGraphicsPSO, "compute PSO bound for draw command");
+    ValidateNullCommand(state, opcode, state.numViewports > 0, "no viewport set");
+}
+
+static void ValidateDrawIndexedCommand(NullExecutionState& state, const NullOpcode opcode, const NullCmdDrawIndexed& cmd)
+{
+    ValidateDrawCommand(state, opcode);
+    if (ValidateNullCommand(state, opcode, state.indexBuffer != nullptr, "no index buffer bound"))
+    {
+        if (ValidateNullCommand(state, opcode, (state.indexFormat == Format::R16UInt || state.indexFormat == Format::R32UInt), "invalid index buffer format"))
+        {
+            const std::uint64_t indexSize   = (state.indexFormat == Format::R16UInt ? 2 : 4);
+            const std::uint64_t indicesEnd  = state.indexOffset + (static_cast<std::uint64_t>(cmd.args.firstIndex) + cmd.args.numIndices) * indexSize;
+            ValidateNullCommand(state, opcode, indicesEnd <= state.indexBuffer->desc.size, "index range exceeds index buffer size");
+        }
+    }
+}
+
+static void ValidateUniformsCommand(NullExecutionState& state, const NullOpcode opcode, const NullCmdSetUniforms& cmd)
+{
+    if (!ValidateNullCommand(state, opcode, state.pipelineState != nullptr, "no pipeline state bound"))
+        return;
+
+    const PipelineLayout* pipelineLayout = (state.pipelineState->isGraphicsPSO ? state.pipelineState->graphicsDesc.pipelineLayout : state.pipelineState->computeDesc.pipelineLayout);
+    if (!ValidateNullCommand(state, opcode, pipelineLayout != nullptr, "no pipeline layout in bound pipeline state"))
+        return;
+
+    auto* pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, pipelineLayout);
+    ValidateNullCommand(state, opcode, cmd.first < pipelineLayoutNull->desc.uniforms.size(), "uniform index out of bounds");
+}
+
+static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc, NullExecutionState& state)
+{
+    const bool validate = state.config.validateCommands;
+
     switch (opcode)
     {
         case NullOpcodeBufferWrite:
         {
             auto cmd = reinterpret_cast<const NullCmdBufferWrite*>(pc);
-            cmd->buffer->Write(cmd->offset, cmd + 1, cmd->size);
+            const bool succeeded = cmd->buffer->Write(cmd->offset, cmd + 1, cmd->size);
+            if (validate)
+                ValidateNullCommand(state, opcode, succeeded, "buffer update exceeds buffer size");
+            AddTransferCost(state, cmd->size);
             return (sizeof(*cmd) + cmd->size);
         }
         case NullOpcodeCopySubresource:
@@ -47,7 +177,9 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
                 if (src->GetResourceType() == ResourceType::Buffer)
                 {
                     auto* srcBuffer = LLGL_CAST(const NullBuffer*, src);
-                    dstBuffer->CopyFromBuffer(cmd->dstX, *srcBuffer, cmd->srcX, cmd->width);
+                    const bool succeeded = dstBuffer->CopyFromBuffer(cmd->dstX, *srcBuffer, cmd->srcX, cmd->width);
+                    if (validate)
+                        ValidateNullCommand(state, opcode, succeeded, "buffer copy exceeds buffer size");
                 }
                 else if (src->GetResourceType() == ResourceType::Texture)
                 {
@@ -58,6 +190,9 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
             {
                 //TODO
             }
+            if (validate)
+                ValidateNullCommand(state, opcode, !state.insideRenderPass, "copy command inside of render pass");
+            AddTransferCost(state, GetCopySubresourceSize(*cmd));
             return sizeof(*cmd);
         }
         case NullOpcodeGenerateMips:
@@ -65,30 +200,139 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
             auto cmd = reinterpret_cast<const NullCmdGenerateMips*>(pc);
             const TextureSubresource subresource{ cmd->baseArrayLayer, cmd->numArrayLayers, cmd->baseMipLevel, cmd->numMipLevels };
             cmd->texture->GenerateMips(&subresource);
+            if (validate)
+                ValidateNullCommand(state, opcode, !state.insideRenderPass, "MIP-map generation inside of render pass");
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetViewports:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetViewports*>(pc);
+            state.numViewports = cmd->numViewports;
+            AddStateChangeCost(state, true);
+            return (sizeof(*cmd) + cmd->numViewports * sizeof(Viewport));
+        }
+        case NullOpcodeSetScissors:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetScissors*>(pc);
+            AddStateChangeCost(state, true);
+            return (sizeof(*cmd) + cmd->numScissors * sizeof(Scissor));
+        }
+        case NullOpcodeSetVertexBuffers:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetVertexBuffers*>(pc);
+            auto vertexBuffers = reinterpret_cast<const NullBuffer* const*>(cmd + 1);
+            const bool changed = !(state.vertexBuffers.size() == cmd->numVertexBuffers && std::equal(vertexBuffers, vertexBuffers + cmd->numVertexBuffers, state.vertexBuffers.begin()));
+            if (changed)
+                state.vertexBuffers = SmallVector<const NullBuffer*>(vertexBuffers, vertexBuffers + cmd->numVertexBuffers);
+            AddStateChangeCost(state, changed);
+            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+        }
+        case NullOpcodeSetIndexBuffer:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetIndexBuffer*>(pc);
+            AddStateChangeCost(state, (state.indexBuffer != cmd->buffer || state.indexFormat != cmd->format || state.indexOffset != cmd->offset));
+            state.indexBuffer   = cmd->buffer;
+            state.indexFormat   = cmd->format;
+            state.indexOffset   = cmd->offset;
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetPipelineState:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetPipelineState*>(pc);
+            AddStateChangeCost(state, (state.pipelineState != cmd->pipelineState));
+            state.pipelineState = cmd->pipelineState;
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetResourceHeap:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetResourceHeap*>(pc);
+            if (validate)
+                ValidateNullCommand(state, opcode, cmd->descriptorSet < cmd->resourceHeap->GetNumDescriptorSets(), "descriptor set out of bounds");
+            AddStateChangeCost(state, (state.resourceHeap != cmd->resourceHeap || state.descriptorSet != cmd->descriptorSet));
+            state.resourceHeap  = cmd->resourceHeap;
+            state.descriptorSet = cmd->descriptorSet;
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetResource:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetResource*>(pc);
+            if (cmd->descriptor >= state.resources.size())
+                state.resources.resize(cmd->descriptor + 1, nullptr);
+            AddStateChangeCost(state, (state.resources[cmd->descriptor] != cmd->resource));
+            state.resources[cmd->descriptor] = cmd->resource;
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetUniforms*>(pc);
+            if (validate)
+                ValidateUniformsCommand(state, opcode, *cmd);
+            AddStateChangeCost(state, true);
+            return (sizeof(*cmd) + cmd->dataSize);
+        }
+        case NullOpcodeBeginRenderPass:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginRenderPass*>(pc);
+            if (validate)
+                ValidateNullCommand(state, opcode, !state.insideRenderPass, "render pass already active");
+            state.insideRenderPass = true;
+            state.cost += state.config.renderPassCost;
+            return sizeof(*cmd);
+        }
+        case NullOpcodeEndRenderPass:
+        {
+            if (validate)
+                ValidateNullCommand(state, opcode, state.insideRenderPass, "no render pass active");
+            state.insideRenderPass = false;
+            return 0;
+        }
+        case NullOpcodeClearAttachments:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClearAttachments*>(pc);
+            if (validate)
+                ValidateNullCommand(state, opcode, state.insideRenderPass, "clear command outside of render pass");
             return sizeof(*cmd);
         }
-        //TODO...
         case NullOpcodeDraw:
         {
             auto cmd = reinterpret_cast<const NullCmdDraw*>(pc);
-            //TODO
-            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+            if (validate)
+                ValidateDrawCommand(state, opcode);
+            state.cost += state.config.drawCost;
+            return sizeof(*cmd);
         }
         case NullOpcodeDrawIndexed:
         {
             auto cmd = reinterpret_cast<const NullCmdDrawIndexed*>(pc);
-            //TODO
-            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+            if (validate)
+                ValidateDrawIndexedCommand(state, opcode, *cmd);
+            state.cost += state.config.drawCost;
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDispatch:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDispatch*>(pc);
+            if (validate)
+            {
+                ValidateNullCommand(state, opcode, !state.insideRenderPass, "dispatch command inside of render pass");
+                if (ValidateNullCommand(state, opcode, state.pipelineState != nullptr, "no pipeline state bound"))
+                    ValidateNullCommand(state, opcode, !state.pipelineState->isGraphicsPSO, "graphics PSO bound for dispatch command");
+            }
+            state.cost += state.config.dispatchCost;
+            return sizeof(*cmd);
         }
         case NullOpcodePushDebugGroup:
         {
             auto cmd = reinterpret_cast<const NullCmdPushDebugGroup*>(pc);
-            //TODO
+            ++state.debugGroupDepth;
             return (sizeof(*cmd) + cmd->length + 1);
         }
         case NullOpcodePopDebugGroup:
         {
-            //TODO
+            if (validate)
+                ValidateNullCommand(state, opcode, state.debugGroupDepth > 0, "no debug group pushed");
+            if (state.debugGroupDepth > 0)
+                --state.debugGroupDepth;
             return 0;
         }
         default:
@@ -96,9 +340,23 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
     }
 }
 
-void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer)
+// Busy-waits for the specified amount of nanoseconds. Sleeping is not an option, since the scheduler granularity is far too coarse for this.
+static void SpendSyntheticCost(std::uint64_t nanoseconds)
+{
+    const std::uint64_t startTick   = Timer::Tick();
+    const std::uint64_t numTicks    = (nanoseconds * Timer::Frequency()) / 1000000000ull;
+    while (Timer::Tick() - startTick < numTicks)
+    {
+        /* Spin */
+    }
+}
+
+void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, const RendererConfigurationNull& config, bool isSecondary)
 {
-    /* Initialize program counter to execute virtual GL commands */
+    NullExecutionState state{ config, isSecondary };
+    state.cost = config.submitCost;
+
+    /* Initialize program counter to execute virtual Null commands */
     for (const auto& chunk : virtualCmdBuffer)
     {
         auto pc     = chunk.data;
@@ -108,12 +366,26 @@ void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdB
         {
             /* Read opcode */
             const NullOpcode opcode = *reinterpret_cast<const NullOpcode*>(pc);
-            pc += sizeof(NullOpcode);
+            pc += NullVirtualCommandBuffer::OpcodeSize();
 
             /* Execute command and increment program counter */
-            pc += ExecuteNullCommand(opcode, pc);
+            pc += NullVirtualCommandBuffer::AlignSize(ExecuteNullCommand(opcode, pc, state));
+            ++state.commandIndex;
         }
     }
+
+    /* Primary command buffers must not leave a render pass or debug group open */
+    if (config.validateCommands && !isSecondary)
+    {
+        if (state.insideRenderPass)
+            Log::Errorf("Null validation error: command buffer ended with an active render pass\n");
+        if (state.debugGroupDepth > 0)
+            Log::Errorf("Null validation error: command buffer ended with %u unbalanced debug group(s)\n", state.debugGroupDepth);
+    }
+
+    /* Spend the accumulated synthetic cost of this command buffer at once, since measuring the time for each command would dominate the costs */
+    if (state.cost > 0)
+        SpendSyntheticCost(state.cost);
 }
 
 
@@ -16,8 +16,9 @@ namespace LLGL
 {
 
 
-// Executes all virtual commands from the specified command buffer.
-void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer);
+// Executes all virtual commands from the specified command buffer, validates them if enabled, and spends their synthetic costs on the calling thread.
+// Secondary command buffers are assumed to be executed inside a render pass.
+void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, const RendererConfigurationNull& config, bool isSecondary);
 
 
 } // /namespace LLGL
@@ -21,9 +21,20 @@ enum NullOpcode : std::uint8_t
     NullOpcodeBufferWrite = 1,
     NullOpcodeCopySubresource,
     NullOpcodeGenerateMips,
-    //TODO
+    NullOpcodeSetViewports,
+    NullOpcodeSetScissors,
+    NullOpcodeSetVertexBuffers,
+    NullOpcodeSetIndexBuffer,
+    NullOpcodeSetPipelineState,
+    NullOpcodeSetResourceHeap,
+    NullOpcodeSetResource,
+    NullOpcodeSetUniforms,
+    NullOpcodeBeginRenderPass,
+    NullOpcodeEndRenderPass,
+    NullOpcodeClearAttachments,
     NullOpcodeDraw,
     NullOpcodeDrawIndexed,
+    NullOpcodeDispatch,
     NullOpcodePushDebugGroup,
     NullOpcodePopDebugGroup,
 };
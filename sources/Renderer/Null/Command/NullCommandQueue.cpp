@@ -9,7 +9,9 @@
 #include "NullCommandBuffer.h"
 #include "NullCommandExecutor.h"
 #include "../RenderState/NullQueryHeap.h"
+#include "../RenderState/NullFence.h"
 #include "../../CheckedCast.h"
+#include "../../HostTrace.h"
 
 
 namespace LLGL
@@ -20,9 +22,24 @@ namespace LLGL
 
 void NullCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_HOST_TRACE_SCOPE("Submit");
+
     auto& commandBufferNull = LLGL_CAST(NullCommandBuffer&, commandBuffer);
     if ((commandBufferNull.desc.flags & (CommandBufferFlags::ImmediateSubmit | CommandBufferFlags::Secondary)) == 0)
         commandBufferNull.ExecuteVirtualCommands();
+    frameCounters_.SubmitCommandBuffer(commandBufferNull.GetFrameCounters());
+}
+
+/* ----- Sparse Resources ----- */
+
+void NullCommandQueue::UpdateTileMappings(Texture& /*texture*/, std::uint32_t /*numMappings*/, const TextureTileMapping* /*mappings*/)
+{
+    // dummy
+}
+
+void NullCommandQueue::UpdateTileMappings(Buffer& /*buffer*/, std::uint32_t /*numMappings*/, const BufferTileMapping* /*mappings*/)
+{
+    // dummy
 }
 
 /* ----- Queries ----- */
@@ -34,16 +51,47 @@ bool NullCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuer
     return false;
 }
 
+bool NullCommandQueue::QueryFrameCounters(FrameProfile& outProfile)
+{
+    return frameCounters_.Query(outProfile);
+}
+
+bool NullCommandQueue::GetCalibratedTimestamps(CalibratedTimestamps& /*outTimestamps*/)
+{
+    return false; // no GPU timeline
+}
+
 /* ----- Fences ----- */
 
 void NullCommandQueue::Submit(Fence& fence)
 {
-    //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    fenceNull.Signal(fenceNull.GetSignal() + 1);
+    frameCounters_.SubmitFence();
+}
+
+void NullCommandQueue::Submit(Fence& fence, std::uint64_t value)
+{
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    fenceNull.Signal(value);
+    frameCounters_.SubmitFence();
+}
+
+void NullCommandQueue::SubmitWait(Fence& /*fence*/, std::uint64_t /*value*/)
+{
+    // dummy
+}
+
+bool NullCommandQueue::WaitFence(Fence& /*fence*/, std::uint64_t /*timeout*/)
+{
+    /* Null commands are executed immediately, so the last signal is always completed */
+    return true;
 }
 
-bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
+bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t value, std::uint64_t /*timeout*/)
 {
-    return false; //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    return (fenceNull.GetSignal() >= value);
 }
 
 void NullCommandQueue::WaitIdle()
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/CommandQueue.h>
+#include "../../FrameCounters.h"
 
 
 namespace LLGL
@@ -23,6 +24,10 @@ class NullCommandQueue final : public CommandQueue
 
         #include <LLGL/Backend/CommandQueue.inl>
 
+    private:
+
+        FrameCounterAccumulator frameCounters_;
+
 };
 
 
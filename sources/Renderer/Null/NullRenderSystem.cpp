@@ -7,6 +7,10 @@
 
 #include "NullRenderSystem.h"
 #include "../../Core/CoreUtils.h"
+#include "../../Core/Exception.h"
+#include "../HostTrace.h"
+#include "../FileLoadUtils.h"
+#include "../RenderSystemUtils.h"
 #include <LLGL/Utils/ForRange.h>
 #include <limits.h>
 
@@ -59,12 +63,23 @@ static void InitNullRendererFeatures(RenderingFeatures& features)
     features.hasInstancing                  = true;
     features.hasOffsetInstancing            = true;
     features.hasIndirectDrawing             = true;
+    features.hasIndirectCountDrawing        = true;
     features.hasViewportArrays              = true;
     features.hasConservativeRasterization   = false;
     features.hasStreamOutputs               = false;
     features.hasLogicOp                     = true;
     features.hasPipelineStatistics          = true;
     features.hasRenderCondition             = true;
+    features.hasBindlessResources           = false;
+    features.hasSparseResources             = false;
+    features.hasThreadSafeResourceCreation  = true;
+    features.hasVariableRateShading         = false;
+    features.hasShadingRateImage            = false;
+    features.hasMeshShaders                 = false;
+    features.hasTextureCompression          = false;
+    features.hasSubgroupSizeControl         = false;
+    features.hasNativeIOQueue               = false;
+    features.hasMultiview                   = false;
 }
 
 static void InitNullRendererLimits(RenderingLimits& limits)
@@ -119,9 +134,18 @@ static RendererInfo GetNullRenderInfo()
     return info;
 }
 
+static RendererConfigurationNull GetNullConfigFromDesc(const RenderSystemDescriptor& renderSystemDesc)
+{
+    RendererConfigurationNull config;
+    if (auto rendererConfigNull = GetRendererConfiguration<RendererConfigurationNull>(renderSystemDesc))
+        config = *rendererConfigNull;
+    return config;
+}
+
 NullRenderSystem::NullRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
-    desc_         { renderSystemDesc               },
-    commandQueue_ { MakeUnique<NullCommandQueue>() }
+    desc_         { renderSystemDesc                        },
+    config_       { GetNullConfigFromDesc(renderSystemDesc) },
+    commandQueue_ { MakeUnique<NullCommandQueue>()          }
 {
     SetRendererInfo(GetNullRenderInfo());
     SetRenderingCaps(GetNullRenderingCaps());
@@ -141,7 +165,7 @@ void NullRenderSystem::Release(SwapChain& swapChain)
 
 /* ----- Command queues ----- */
 
-CommandQueue* NullRenderSystem::GetCommandQueue()
+CommandQueue* NullRenderSystem::GetCommandQueue(const CommandQueueType /*type*/)
 {
     return commandQueue_.get();
 }
@@ -150,7 +174,7 @@ CommandQueue* NullRenderSystem::GetCommandQueue()
 
 CommandBuffer* NullRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
-    return commandBuffers_.emplace<NullCommandBuffer>(commandBufferDesc);
+    return commandBuffers_.emplace<NullCommandBuffer>(commandBufferDesc, config_);
 }
 
 void NullRenderSystem::Release(CommandBuffer& commandBuffer)
@@ -166,6 +190,13 @@ Buffer* NullRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const
     return buffers_.emplace<NullBuffer>(bufferDesc, initialData);
 }
 
+void NullRenderSystem::CreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, const void* const * initialData, Buffer** outBuffers)
+{
+    RenderSystem::AssertCreateBuffers(numBuffers, bufferDescs, outBuffers);
+    for_range(i, numBuffers)
+        outBuffers[i] = CreateBuffer(bufferDescs[i], (initialData != nullptr ? initialData[i] : nullptr));
+}
+
 BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
     RenderSystem::AssertCreateBufferArray(numBuffers, bufferArray);
@@ -219,6 +250,13 @@ Texture* NullRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, c
     return textures_.emplace<NullTexture>(textureDesc, imageDesc);
 }
 
+void NullRenderSystem::CreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, const SrcImageDescriptor* const * imageDescs, Texture** outTextures)
+{
+    RenderSystem::AssertCreateTextures(numTextures, textureDescs, outTextures);
+    for_range(i, numTextures)
+        outTextures[i] = CreateTexture(textureDescs[i], (imageDescs != nullptr ? imageDescs[i] : nullptr));
+}
+
 void NullRenderSystem::Release(Texture& texture)
 {
     textures_.erase(&texture);
@@ -226,6 +264,8 @@ void NullRenderSystem::Release(Texture& texture)
 
 void NullRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("WriteTexture");
+
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     textureNull.Write(textureRegion, imageDesc);
 }
@@ -294,6 +334,8 @@ void NullRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* NullRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateShader");
+
     return shaders_.emplace<NullShader>(shaderDesc);
 }
 
@@ -323,14 +365,30 @@ PipelineState* NullRenderSystem::CreatePipelineState(const Blob& serializedCache
 
 PipelineState* NullRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineState");
+
     return pipelineStates_.emplace<NullPipelineState>(pipelineStateDesc);
 }
 
 PipelineState* NullRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineState");
+
     return pipelineStates_.emplace<NullPipelineState>(pipelineStateDesc);
 }
 
+PipelineState* NullRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, PipelineState* /*fallbackPipelineState*/)
+{
+    /* Null PSOs have nothing to compile, so they are always ready */
+    return CreatePipelineState(pipelineStateDesc);
+}
+
+PipelineState* NullRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, PipelineState* /*fallbackPipelineState*/)
+{
+    /* Null PSOs have nothing to compile, so they are always ready */
+    return CreatePipelineState(pipelineStateDesc);
+}
+
 void NullRenderSystem::Release(PipelineState& pipelineState)
 {
     pipelineStates_.erase(&pipelineState);
@@ -348,6 +406,18 @@ void NullRenderSystem::Release(QueryHeap& queryHeap)
     queryHeaps_.erase(&queryHeap);
 }
 
+/* ----- Acceleration structures ----- */
+
+AccelerationStructure* NullRenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& /*accelerationStructureDesc*/)
+{
+    LLGL_TRAP_FEATURE_NOT_SUPPORTED("acceleration structures");
+}
+
+void NullRenderSystem::Release(AccelerationStructure& /*accelerationStructure*/)
+{
+    // dummy
+}
+
 /* ----- Fences ----- */
 
 Fence* NullRenderSystem::CreateFence()
@@ -367,6 +437,42 @@ bool NullRenderSystem::GetNativeHandle(void* nativeHandle, std::size_t nativeHan
     return (nativeHandle == nullptr || nativeHandleSize == 0); // dummy
 }
 
+std::uint64_t NullRenderSystem::ReleaseRetainedMemory(std::uint64_t /*budget*/)
+{
+    return 0; // dummy
+}
+
+bool NullRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStatistics)
+{
+    outStatistics.heaps.clear();
+    return false; // dummy
+}
+
+bool NullRenderSystem::SetMemoryPriority(Resource& /*resource*/, float /*priority*/)
+{
+    return false; // dummy
+}
+
+Blob NullRenderSystem::GetPipelineCache()
+{
+    return Blob{}; // dummy
+}
+
+bool NullRenderSystem::ExportMemoryHandle(Resource& /*resource*/, ExternalHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool NullRenderSystem::ExportFenceHandle(Fence& /*fence*/, ExternalHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool NullRenderSystem::SubmitFileLoads(const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    return SubmitFileLoadsEmulated(*this, loads, fence);
+}
+
 
 } // /namespace LLGL
 
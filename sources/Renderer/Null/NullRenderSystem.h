@@ -49,6 +49,7 @@ class NullRenderSystem final : public RenderSystem
         /* ----- Common objects ----- */
 
         const RenderSystemDescriptor            desc_;
+        const RendererConfigurationNull         config_;
 
         /* ----- Hardware object containers ----- */
 
@@ -6,6 +6,7 @@
  */
 
 #include "NullSwapChain.h"
+#include "../HostTrace.h"
 
 
 namespace LLGL
@@ -54,6 +55,8 @@ void NullSwapChain::SetName(const char* name)
 
 void NullSwapChain::Present()
 {
+    LLGL_HOST_TRACE_SCOPE("Present");
+
     // dummy
 }
 
@@ -88,6 +91,19 @@ bool NullSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
     return true;
 }
 
+bool NullSwapChain::SetMaxFrameLatency(std::uint32_t maxFrameLatency)
+{
+    if (maxFrameLatency == 0)
+        return false;
+    maxFrameLatency_ = maxFrameLatency;
+    return true;
+}
+
+bool NullSwapChain::IsPresentModeSupported(PresentMode /*presentMode*/) const
+{
+    return true;
+}
+
 const RenderPass* NullSwapChain::GetRenderPass() const
 {
     return renderPass_;
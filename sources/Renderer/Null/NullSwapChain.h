@@ -38,6 +38,8 @@ class NullSwapChain final : public SwapChain
         Format GetDepthStencilFormat() const override;
 
         bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+        bool SetMaxFrameLatency(std::uint32_t maxFrameLatency) override;
+        bool IsPresentModeSupported(PresentMode presentMode) const override;
 
         const RenderPass* GetRenderPass() const override;
 
@@ -52,6 +54,7 @@ class NullSwapChain final : public SwapChain
         Format              colorFormat_        = Format::Undefined;
         Format              depthStencilFormat_ = Format::Undefined;
         std::uint32_t       vsyncInterval_      = 0;
+        std::uint32_t       maxFrameLatency_    = 0;
         const RenderPass*   renderPass_         = nullptr;
 
 };
@@ -33,6 +33,12 @@ class NullFence final : public Fence
 
         void WaitForSignal(std::uint64_t signal);
 
+        // Returns the last signaled value.
+        inline std::uint64_t GetSignal() const
+        {
+            return signal_;
+        }
+
     private:
 
         std::string             label_;
@@ -20,7 +20,7 @@ namespace LLGL
 static std::uint32_t GetNumPipelineLayoutBindings(const PipelineLayout* pipelineLayout)
 {
     auto pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, pipelineLayout);
-    return std::max(1u, static_cast<std::uint32_t>(pipelineLayoutNull->desc.bindings.size()));
+    return std::max(1u, static_cast<std::uint32_t>(pipelineLayoutNull->desc.heapBindings.size()));
 }
 
 NullResourceHeap::NullResourceHeap(const ResourceHeapDescriptor& desc, const ArrayView<ResourceViewDescriptor>& initialResourceViews) :
@@ -38,7 +38,7 @@ std::uint32_t NullResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor
 {
     /* Copy input resource views into resource heap via STL copy algorithm, since the descriptors are non-POD structs */
     std::uint32_t numWritten = 0;
-    if (resourceViews.size() + firstDescriptor < resourceViews_.size())
+    if (resourceViews.size() + firstDescriptor <= resourceViews_.size())
     {
         for_range(i, resourceViews.size())
         {
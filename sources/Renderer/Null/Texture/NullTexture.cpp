@@ -65,6 +65,12 @@ SubresourceFootprint NullTexture::GetSubresourceFootprint(std::uint32_t mipLevel
     return CalcPackedSubresourceFootprint(GetType(), GetFormat(), desc.extent, mipLevel, desc.arrayLayers);
 }
 
+Extent3D NullTexture::GetSparseTileExtent() const
+{
+    /* Sparse textures are not supported by this backend */
+    return {};
+}
+
 std::uint32_t NullTexture::ClampMipLevel(std::uint32_t mipLevel) const
 {
     return std::min(mipLevel, desc.mipLevels - 1);
@@ -0,0 +1,319 @@
+/*
+ * OcclusionCuller.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/OcclusionCuller.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/QueryHeap.h>
+#include <LLGL/Buffer.h>
+#include <LLGL/Utils/ForRange.h>
+#include "../Core/Assertion.h"
+#include <algorithm>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Number of corners and indices of a bounding box that is drawn as triangle list.
+static constexpr std::uint32_t g_numBoxVertices = 8;
+static constexpr std::uint32_t g_numBoxIndices  = 36;
+
+// Corner indices of all six faces of a box; each corner index encodes the X, Y, and Z coordinate in bits 0, 1, and 2, where a set bit selects the maximum corner.
+static const std::uint16_t g_boxIndices[g_numBoxIndices] =
+{
+    0, 2, 6,  0, 6, 4, // -X
+    1, 5, 7,  1, 7, 3, // +X
+    0, 4, 5,  0, 5, 1, // -Y
+    2, 3, 7,  2, 7, 6, // +Y
+    0, 1, 3,  0, 3, 2, // -Z
+    4, 6, 7,  4, 7, 5, // +Z
+};
+
+struct OcclusionCullerObject
+{
+    float   minCorner[3]    = { 0.0f, 0.0f, 0.0f };
+    float   maxCorner[3]    = { 0.0f, 0.0f, 0.0f };
+    bool    active          = false;
+    bool    dirty           = false;    // Bounding box has changed since the last query
+    bool    queryValid      = false;    // Query of this object holds a result that can be used as render condition
+};
+
+struct OcclusionCuller::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem, const OcclusionCullerDescriptor& cullerDesc) :
+        renderSystem { renderSystem },
+        cullerDesc   { cullerDesc   }
+    {
+    }
+
+    bool IsInsideBoundingBox(const OcclusionCullerObject& entry, const float* position) const;
+    void AppendBoxVertices(const OcclusionCullerObject& entry);
+
+    RenderSystem&                       renderSystem;
+    OcclusionCullerDescriptor           cullerDesc;
+    bool                                renderConditionSupported    = false;
+    bool                                renderConditionActive       = false;
+
+    QueryHeap*                          queryHeap                   = nullptr;
+    Buffer*                             indexBuffer                 = nullptr;
+    std::vector<Buffer*>                vertexBuffers;                          // One vertex buffer per frame in flight
+    std::vector<OcclusionCullerObject>  objects;
+    std::vector<std::uint32_t>          queriedObjects;                         // Objects that are queried in the current frame
+    std::vector<float>                  vertices;                               // Box vertices of the current frame
+    std::uint64_t                       frame                       = 0;
+
+    OcclusionCullerStatistics           stats;
+};
+
+
+/*
+ * OcclusionCuller::Pimpl structure
+ */
+
+bool OcclusionCuller::Pimpl::IsInsideBoundingBox(const OcclusionCullerObject& entry, const float* position) const
+{
+    for_range(i, 3)
+    {
+        if (position[i] < entry.minCorner[i] - cullerDesc.boxExpansion ||
+            position[i] > entry.maxCorner[i] + cullerDesc.boxExpansion)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void OcclusionCuller::Pimpl::AppendBoxVertices(const OcclusionCullerObject& entry)
+{
+    for_range(corner, g_numBoxVertices)
+    {
+        for_range(i, 3)
+        {
+            if ((corner & (1u << i)) != 0)
+                vertices.push_back(entry.maxCorner[i] + cullerDesc.boxExpansion);
+            else
+                vertices.push_back(entry.minCorner[i] - cullerDesc.boxExpansion);
+        }
+    }
+}
+
+
+/*
+ * OcclusionCuller class
+ */
+
+OcclusionCuller::OcclusionCuller(RenderSystem& renderSystem, const OcclusionCullerDescriptor& cullerDesc) :
+    pimpl_ { new Pimpl{ renderSystem, cullerDesc } }
+{
+    LLGL_ASSERT(cullerDesc.maxObjects > 0, "occlusion culler requires at least one object");
+    LLGL_ASSERT(
+        cullerDesc.queryType == QueryType::SamplesPassed ||
+        cullerDesc.queryType == QueryType::AnySamplesPassed ||
+        cullerDesc.queryType == QueryType::AnySamplesPassedConservative,
+        "occlusion culler requires an occlusion query type"
+    );
+
+    pimpl_->cullerDesc.queryInterval        = std::max<std::uint32_t>(1u, cullerDesc.queryInterval);
+    pimpl_->cullerDesc.numFramesInFlight    = std::max<std::uint32_t>(1u, cullerDesc.numFramesInFlight);
+    pimpl_->renderConditionSupported        = renderSystem.GetRenderingCaps().features.hasRenderCondition;
+    pimpl_->objects.resize(cullerDesc.maxObjects);
+
+    /* Create query heap with one query per object */
+    QueryHeapDescriptor queryHeapDesc;
+    {
+        queryHeapDesc.type              = cullerDesc.queryType;
+        queryHeapDesc.numQueries        = cullerDesc.maxObjects;
+        queryHeapDesc.renderCondition   = pimpl_->renderConditionSupported;
+    }
+    pimpl_->queryHeap = renderSystem.CreateQueryHeap(queryHeapDesc);
+
+    /* Create index buffer that is shared by all boxes */
+    BufferDescriptor indexBufferDesc;
+    {
+        indexBufferDesc.size        = sizeof(g_boxIndices);
+        indexBufferDesc.bindFlags   = BindFlags::IndexBuffer;
+        indexBufferDesc.format      = Format::R16UInt;
+    }
+    pimpl_->indexBuffer = renderSystem.CreateBuffer(indexBufferDesc, g_boxIndices);
+
+    /* Create vertex buffers for the boxes of each frame in flight */
+    const VertexFormat vertexFormat = GetBoundingBoxVertexFormat();
+
+    BufferDescriptor vertexBufferDesc;
+    {
+        vertexBufferDesc.size           = static_cast<std::uint64_t>(cullerDesc.maxObjects) * g_numBoxVertices * vertexFormat.GetStride();
+        vertexBufferDesc.bindFlags      = BindFlags::VertexBuffer;
+        vertexBufferDesc.miscFlags      = MiscFlags::DynamicUsage;
+        vertexBufferDesc.vertexAttribs  = vertexFormat.attributes;
+    }
+    pimpl_->vertexBuffers.resize(pimpl_->cullerDesc.numFramesInFlight);
+    for (Buffer*& vertexBuffer : pimpl_->vertexBuffers)
+        vertexBuffer = renderSystem.CreateBuffer(vertexBufferDesc);
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    for (Buffer* vertexBuffer : pimpl_->vertexBuffers)
+        pimpl_->renderSystem.Release(*vertexBuffer);
+    pimpl_->renderSystem.Release(*pimpl_->indexBuffer);
+    pimpl_->renderSystem.Release(*pimpl_->queryHeap);
+    delete pimpl_;
+}
+
+void OcclusionCuller::SetBoundingBox(std::uint32_t object, const float minCorner[3], const float maxCorner[3])
+{
+    LLGL_ASSERT(object < pimpl_->objects.size(), "occlusion culler object index out of range");
+
+    OcclusionCullerObject& entry = pimpl_->objects[object];
+    if (!entry.active || !std::equal(minCorner, minCorner + 3, entry.minCorner) || !std::equal(maxCorner, maxCorner + 3, entry.maxCorner))
+    {
+        std::copy(minCorner, minCorner + 3, entry.minCorner);
+        std::copy(maxCorner, maxCorner + 3, entry.maxCorner);
+        entry.active        = true;
+        entry.dirty         = true;
+        entry.queryValid    = false;
+    }
+}
+
+void OcclusionCuller::RemoveBoundingBox(std::uint32_t object)
+{
+    LLGL_ASSERT(object < pimpl_->objects.size(), "occlusion culler object index out of range");
+    pimpl_->objects[object] = OcclusionCullerObject{};
+}
+
+void OcclusionCuller::EncodeQueries(CommandBuffer& commandBuffer, const float* viewPosition)
+{
+    LLGL_ASSERT(!pimpl_->renderConditionActive, "cannot encode occlusion queries inside a render condition");
+
+    const std::uint64_t frame = pimpl_->frame++;
+
+    /* Select objects that are queried in this frame; all others reuse their previous query */
+    pimpl_->queriedObjects.clear();
+    pimpl_->vertices.clear();
+    pimpl_->stats = OcclusionCullerStatistics{};
+
+    for_range(object, static_cast<std::uint32_t>(pimpl_->objects.size()))
+    {
+        OcclusionCullerObject& entry = pimpl_->objects[object];
+        if (!entry.active)
+            continue;
+
+        pimpl_->stats.numObjects++;
+
+        /* Never cull objects the viewer is inside of, since their box faces are clipped by the near plane */
+        if (viewPosition != nullptr && pimpl_->IsInsideBoundingBox(entry, viewPosition))
+        {
+            entry.queryValid = false;
+            pimpl_->stats.numUnconditional++;
+            continue;
+        }
+
+        /* Stagger queries of unchanged objects across the query interval */
+        if (entry.dirty || !entry.queryValid || (frame + object) % pimpl_->cullerDesc.queryInterval == 0)
+        {
+            pimpl_->queriedObjects.push_back(object);
+            pimpl_->AppendBoxVertices(entry);
+        }
+        else
+            pimpl_->stats.numReusedQueries++;
+    }
+
+    if (pimpl_->queriedObjects.empty())
+        return;
+
+    /* Upload box vertices into the vertex buffer of this frame */
+    Buffer& vertexBuffer = *pimpl_->vertexBuffers[frame % pimpl_->vertexBuffers.size()];
+    pimpl_->renderSystem.WriteBuffer(vertexBuffer, 0, pimpl_->vertices.data(), pimpl_->vertices.size() * sizeof(float));
+
+    /* Draw all boxes with one query each */
+    commandBuffer.SetVertexBuffer(vertexBuffer);
+    commandBuffer.SetIndexBuffer(*pimpl_->indexBuffer);
+
+    for_range(i, static_cast<std::uint32_t>(pimpl_->queriedObjects.size()))
+    {
+        const std::uint32_t object = pimpl_->queriedObjects[i];
+        commandBuffer.BeginQuery(*pimpl_->queryHeap, object);
+        {
+            commandBuffer.DrawIndexed(g_numBoxIndices, 0, static_cast<std::int32_t>(i * g_numBoxVertices));
+        }
+        commandBuffer.EndQuery(*pimpl_->queryHeap, object);
+
+        OcclusionCullerObject& entry = pimpl_->objects[object];
+        entry.dirty         = false;
+        entry.queryValid    = true;
+    }
+
+    pimpl_->stats.numQueries = static_cast<std::uint32_t>(pimpl_->queriedObjects.size());
+}
+
+void OcclusionCuller::BeginRenderCondition(CommandBuffer& commandBuffer, std::uint32_t object, const RenderConditionMode mode)
+{
+    LLGL_ASSERT(object < pimpl_->objects.size(), "occlusion culler object index out of range");
+    LLGL_ASSERT(!pimpl_->renderConditionActive, "occlusion culler render conditions cannot be nested");
+    LLGL_ASSERT(mode < RenderConditionMode::WaitInverted, "occlusion culler does not support inverted render conditions");
+
+    if (pimpl_->renderConditionSupported && pimpl_->objects[object].queryValid)
+    {
+        commandBuffer.BeginRenderCondition(*pimpl_->queryHeap, object, mode);
+        pimpl_->renderConditionActive = true;
+    }
+}
+
+void OcclusionCuller::EndRenderCondition(CommandBuffer& commandBuffer)
+{
+    if (pimpl_->renderConditionActive)
+    {
+        commandBuffer.EndRenderCondition();
+        pimpl_->renderConditionActive = false;
+    }
+}
+
+std::int32_t OcclusionCuller::GetQuery(std::uint32_t object) const
+{
+    LLGL_ASSERT(object < pimpl_->objects.size(), "occlusion culler object index out of range");
+    return (pimpl_->objects[object].queryValid ? static_cast<std::int32_t>(object) : -1);
+}
+
+QueryHeap& OcclusionCuller::GetQueryHeap() const
+{
+    return *pimpl_->queryHeap;
+}
+
+OcclusionCullerStatistics OcclusionCuller::GetStatistics() const
+{
+    return pimpl_->stats;
+}
+
+VertexFormat OcclusionCuller::GetBoundingBoxVertexFormat()
+{
+    VertexFormat vertexFormat;
+    vertexFormat.AppendAttribute({ "position", Format::RGB32Float });
+    return vertexFormat;
+}
+
+void OcclusionCuller::InitBoundingBoxPipeline(GraphicsPipelineDescriptor& pipelineDesc)
+{
+    pipelineDesc.primitiveTopology         = PrimitiveTopology::TriangleList;
+    pipelineDesc.depth.testEnabled         = true;
+    pipelineDesc.depth.writeEnabled        = false;
+    pipelineDesc.rasterizer.cullMode       = CullMode::Disabled;
+    for (BlendTargetDescriptor& target : pipelineDesc.blend.targets)
+        target.colorMask = 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
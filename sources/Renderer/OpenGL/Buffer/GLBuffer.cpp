@@ -6,6 +6,7 @@
  */
 
 #include "GLBuffer.h"
+#include "GLStreamingBuffer.h"
 #include "../GLProfile.h"
 #include "../GLObjectUtils.h"
 #include "../Ext/GLExtensions.h"
@@ -13,6 +14,7 @@
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../../Core/CoreUtils.h"
 #include <memory>
+#include <cstring>
 
 
 namespace LLGL
@@ -53,10 +55,22 @@ GLBuffer::GLBuffer(long bindFlags) :
         /* Creates a new GL buffer object (must be bound to a target before it can be used) */
         glGenBuffers(1, &id_);
     }
+
+    #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+    if ((bindFlags & BindFlags::StreamOutputBuffer) != 0 && HasExtension(GLExt::ARB_transform_feedback2))
+    {
+        /* Creates a transform feedback object, so the number of captured vertices can be drawn with glDrawTransformFeedback */
+        glGenTransformFeedbacks(1, &transformFeedbackID_);
+    }
+    #endif // /LLGL_GLEXT_TRANSFORM_FEEDBACK2
 }
 
 GLBuffer::~GLBuffer()
 {
+    #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+    if (transformFeedbackID_ != 0)
+        glDeleteTransformFeedbacks(1, &transformFeedbackID_);
+    #endif // /LLGL_GLEXT_TRANSFORM_FEEDBACK2
     glDeleteBuffers(1, &id_);
     GLStateManager::Get().NotifyBufferRelease(*this);
 }
@@ -66,6 +80,22 @@ void GLBuffer::SetName(const char* name)
     GLSetObjectLabel(GL_BUFFER, GetID(), name);
 }
 
+std::uint64_t GLBuffer::GetDeviceAddress() const
+{
+    #ifdef LLGL_GLEXT_SHADER_BUFFER_LOAD_NV
+    if ((GetBindFlags() & BindFlags::DeviceAddress) != 0 && HasExtension(GLExt::NV_shader_buffer_load))
+    {
+        /* Buffer must be resident to be accessed by its address; re-allocating the buffer store makes it non-resident again */
+        if (!glIsNamedBufferResidentNV(id_))
+            glMakeNamedBufferResidentNV(id_, GL_READ_ONLY);
+        GLuint64EXT address = 0;
+        glGetNamedBufferParameterui64vNV(id_, GL_BUFFER_GPU_ADDRESS_NV, &address);
+        return static_cast<std::uint64_t>(address);
+    }
+    #endif // /LLGL_GLEXT_SHADER_BUFFER_LOAD_NV
+    return 0;
+}
+
 BufferDescriptor GLBuffer::GetDesc() const
 {
     /* Get buffer parameters */
@@ -99,8 +129,18 @@ BufferDescriptor GLBuffer::GetDesc() const
     return bufferDesc;
 }
 
+// Returns true if updates for a buffer with the specified binding flags and usage should be streamed.
+static bool IsStreamingBufferUsage(long bindFlags, GLenum usage)
+{
+    const long streamingBindFlags = (BindFlags::VertexBuffer | BindFlags::IndexBuffer | BindFlags::ConstantBuffer);
+    return (usage == GL_DYNAMIC_DRAW && (bindFlags & streamingBindFlags) != 0);
+}
+
 void GLBuffer::BufferStorage(GLsizeiptr size, const void* data, GLbitfield flags, GLenum usage)
 {
+    size_       = size;
+    isStreamed_ = (IsStreamingBufferUsage(GetBindFlags(), usage) && GLStreamingBuffer::IsSupported() && GLStreamingBuffer::Get().IsEnabled());
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -127,6 +167,13 @@ void GLBuffer::BufferStorage(GLsizeiptr size, const void* data, GLbitfield flags
 
 void GLBuffer::BufferSubData(GLintptr offset, GLsizeiptr size, const void* data)
 {
+    /* Stream data via persistent mapped ring buffer to avoid implicit synchronization for buffers that are still in use */
+    if (isStreamed_ && GLStreamingBuffer::Get().IsAvailable(size))
+    {
+        if (GLStreamingBuffer::Get().Write(GetID(), offset, data, size))
+            return;
+    }
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -174,19 +221,7 @@ void GLBuffer::ClearBufferData(std::uint32_t data)
     #endif // /GL_ARB_clear_buffer_object
     {
         /* Emulate buffer fill operation */
-        GLStateManager::Get().BindGLBuffer(*this);
-
-        /* Query buffer size */
-        GLenum  bufferTarget    = GetGLTarget();
-        GLint   bufferSize      = 0;
-
-        glGetBufferParameteriv(bufferTarget, GL_BUFFER_SIZE, &bufferSize);
-
-        /* Allocate intermediate buffer to fill the GPU buffer with */
-        std::vector<std::uint32_t> intermediateBuffer(static_cast<std::size_t>(bufferSize + 3) / 4, data);
-
-        /* Submit intermeidate buffer to GPU buffer */
-        glBufferSubData(bufferTarget, 0, static_cast<GLintptr>(bufferSize), intermediateBuffer.data());
+        FillBufferSubDataWithPattern(0, GetSize(), &data, sizeof(data));
     }
 }
 
@@ -211,13 +246,40 @@ void GLBuffer::ClearBufferSubData(GLintptr offset, GLsizeiptr size, std::uint32_
     #endif // /GL_ARB_clear_buffer_object
     {
         /* Emulate buffer fill operation */
-        GLStateManager::Get().BindGLBuffer(*this);
-
-        /* Allocate intermediate buffer to fill the GPU buffer with */
-        std::vector<std::uint32_t> intermediateBuffer(static_cast<std::size_t>(size + 3) / 4, data);
+        FillBufferSubDataWithPattern(offset, size, &data, sizeof(data));
+    }
+}
 
-        /* Submit intermeidate buffer to GPU buffer */
-        glBufferSubData(GetGLTarget(), offset, size, intermediateBuffer.data());
+void GLBuffer::ClearBufferPattern(GLintptr offset, GLsizeiptr size, const void* pattern, GLsizei patternSize)
+{
+    #ifdef GL_ARB_clear_buffer_object
+    if (HasExtension(GLExt::ARB_clear_buffer_object))
+    {
+        /* Select unsigned integer format with one, two, or four components that matches the pattern size */
+        GLenum internalFormat, format;
+        switch (patternSize)
+        {
+            case 8:
+                internalFormat  = GL_RG32UI;
+                format          = GL_RG_INTEGER;
+                break;
+            case 16:
+                internalFormat  = GL_RGBA32UI;
+                format          = GL_RGBA_INTEGER;
+                break;
+            default:
+                internalFormat  = GL_R32UI;
+                format          = GL_RED_INTEGER;
+                break;
+        }
+        GLStateManager::Get().BindGLBuffer(*this);
+        glClearBufferSubData(GetGLTarget(), internalFormat, offset, size, format, GL_UNSIGNED_INT, pattern);
+    }
+    else
+    #endif // /GL_ARB_clear_buffer_object
+    {
+        /* Emulate buffer fill operation */
+        FillBufferSubDataWithPattern(offset, size, pattern, patternSize);
     }
 }
 
@@ -272,6 +334,18 @@ void* GLBuffer::MapBuffer(GLenum access)
 
 void* GLBuffer::MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access)
 {
+    /* Map region of persistent mapped ring buffer if previous contents can be discarded; copy is issued in UnmapBuffer() */
+    const GLbitfield discardAccess = (GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (isStreamed_ && (access & GL_MAP_READ_BIT) == 0 && (access & discardAccess) != 0 && GLStreamingBuffer::Get().IsAvailable(length))
+    {
+        if (void* data = GLStreamingBuffer::Get().Alloc(length, streamingMapping_.srcOffset))
+        {
+            streamingMapping_.dstOffset = offset;
+            streamingMapping_.size      = length;
+            return data;
+        }
+    }
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -295,6 +369,14 @@ void* GLBuffer::MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield ac
 
 void GLBuffer::UnmapBuffer()
 {
+    if (streamingMapping_.size > 0)
+    {
+        /* Copy mapped region from ring buffer into this buffer */
+        GLStreamingBuffer::Get().CopyToBuffer(GetID(), streamingMapping_.dstOffset, streamingMapping_.srcOffset, streamingMapping_.size);
+        streamingMapping_ = StreamingMapping{};
+        return;
+    }
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -365,6 +447,40 @@ void GLBuffer::SetIndexType(const Format format)
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void GLBuffer::FillBufferSubDataWithPattern(GLintptr offset, GLsizeiptr size, const void* pattern, GLsizei patternSize)
+{
+    if (size <= 0)
+        return;
+
+    #ifdef GL_ARB_copy_buffer
+    if (HasExtension(GLExt::ARB_copy_buffer))
+    {
+        /* Write a single pattern and double the filled range with non-overlapping copies within this buffer (GL 3.1+) */
+        GLStateManager::Get().BindBuffer(GLBufferTarget::CopyReadBuffer, GetID());
+        GLStateManager::Get().BindBuffer(GLBufferTarget::CopyWriteBuffer, GetID());
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, std::min<GLsizeiptr>(patternSize, size), pattern);
+        for (GLsizeiptr filledSize = patternSize; filledSize < size; filledSize *= 2)
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, offset + filledSize, std::min(filledSize, size - filledSize));
+    }
+    else
+    #endif // /GL_ARB_copy_buffer
+    {
+        /* Allocate intermediate buffer to fill the GPU buffer with */
+        auto intermediateBuffer = MakeUniqueArray<char>(static_cast<std::size_t>(size));
+        for (GLsizeiptr intermediateOffset = 0; intermediateOffset < size; intermediateOffset += patternSize)
+            ::memcpy(intermediateBuffer.get() + intermediateOffset, pattern, static_cast<std::size_t>(std::min<GLsizeiptr>(patternSize, size - intermediateOffset)));
+
+        /* Submit intermediate buffer to GPU buffer */
+        GLStateManager::Get().BindGLBuffer(*this);
+        glBufferSubData(GetGLTarget(), offset, size, intermediateBuffer.get());
+    }
+}
+
+
 } // /namespace LLGL
 
 
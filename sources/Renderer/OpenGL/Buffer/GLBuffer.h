@@ -29,6 +29,8 @@ class GLBuffer : public Buffer
 
         BufferDescriptor GetDesc() const override;
 
+        std::uint64_t GetDeviceAddress() const override;
+
     public:
 
         GLBuffer(long bindFlags);
@@ -42,12 +44,27 @@ class GLBuffer : public Buffer
         void ClearBufferData(std::uint32_t data);
         void ClearBufferSubData(GLintptr offset, GLsizeiptr size, std::uint32_t data);
 
+        // Fills the buffer range with the specified 32-, 64-, or 128-bit pattern. See CommandBuffer::FillBufferPattern.
+        void ClearBufferPattern(GLintptr offset, GLsizeiptr size, const void* pattern, GLsizei patternSize);
+
         void CopyBufferSubData(const GLBuffer& readBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
 
         void* MapBuffer(GLenum access);
         void* MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access);
         void UnmapBuffer();
 
+        // Returns true if buffer updates are streamed through the persistent mapped GLStreamingBuffer.
+        inline bool IsStreamed() const
+        {
+            return isStreamed_;
+        }
+
+        // Returns the size (in bytes) that was specified when the buffer storage was allocated.
+        inline GLsizeiptr GetSize() const
+        {
+            return size_;
+        }
+
         // Returns the specified buffer parameters; null pointers are ignored.
         void GetBufferParams(GLint* size, GLint* usage, GLint* storageFlags) const;
 
@@ -57,6 +74,12 @@ class GLBuffer : public Buffer
             return id_;
         }
 
+        // Returns the ID of the transform feedback object that records the number of captured vertices, or 0 if there is none.
+        inline GLuint GetTransformFeedbackID() const
+        {
+            return transformFeedbackID_;
+        }
+
         // Returns the primary buffer target. In case the buffer was created with multiple binding flags, other targets can be used, too.
         inline GLBufferTarget GetTarget() const
         {
@@ -80,9 +103,28 @@ class GLBuffer : public Buffer
 
     private:
 
-        GLuint          id_                 = 0;
-        GLBufferTarget  target_             = GLBufferTarget::ArrayBuffer;
-        bool            indexType16Bits_    = false;
+        // Emulates a buffer fill operation, either with copies within this buffer on the GPU (GL_ARB_copy_buffer) or with an intermediate CPU buffer.
+        void FillBufferSubDataWithPattern(GLintptr offset, GLsizeiptr size, const void* pattern, GLsizei patternSize);
+
+    private:
+
+        // Region of the GLStreamingBuffer while this buffer is mapped with discarded contents.
+        struct StreamingMapping
+        {
+            GLintptr    srcOffset   = 0;
+            GLintptr    dstOffset   = 0;
+            GLsizeiptr  size        = 0;
+        };
+
+    private:
+
+        GLuint              id_                     = 0;
+        GLuint              transformFeedbackID_    = 0;    // Only created for stream-output buffers with GL_ARB_transform_feedback2
+        GLBufferTarget      target_                 = GLBufferTarget::ArrayBuffer;
+        GLsizeiptr          size_                   = 0;
+        bool                indexType16Bits_        = false;
+        bool                isStreamed_             = false;
+        StreamingMapping    streamingMapping_;
 
 };
 
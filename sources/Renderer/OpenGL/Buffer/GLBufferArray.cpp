@@ -33,7 +33,11 @@ void GLBufferArray::BuildArray(std::uint32_t numBuffers, Buffer* const * bufferA
     idArray_.clear();
     idArray_.reserve(numBuffers);
     while (auto next = NextArrayResource<GLBuffer>(numBuffers, bufferArray))
+    {
+        if (idArray_.empty())
+            transformFeedbackID_ = next->GetTransformFeedbackID();
         idArray_.push_back(next->GetID());
+    }
 }
 
 
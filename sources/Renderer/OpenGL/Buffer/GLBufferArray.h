@@ -34,6 +34,12 @@ class GLBufferArray : public BufferArray
             return idArray_;
         }
 
+        // Returns the transform feedback object ID of the first buffer in this array. See GLBuffer::GetTransformFeedbackID.
+        inline GLuint GetTransformFeedbackID() const
+        {
+            return transformFeedbackID_;
+        }
+
     protected:
 
         void BuildArray(std::uint32_t numBuffers, Buffer* const * bufferArray);
@@ -41,6 +47,7 @@ class GLBufferArray : public BufferArray
     private:
 
         std::vector<GLuint> idArray_;
+        GLuint              transformFeedbackID_    = 0;
 
 };
 
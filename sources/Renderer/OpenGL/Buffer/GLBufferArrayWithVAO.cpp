@@ -35,6 +35,11 @@ GLBufferArrayWithVAO::GLBufferArrayWithVAO(std::uint32_t numBuffers, Buffer* con
     }
 }
 
+GLBufferArrayWithVAO::~GLBufferArrayWithVAO()
+{
+    GLVertexArrayCache::Get().ReleaseVertexArray(vaoID_);
+}
+
 void GLBufferArrayWithVAO::SetName(const char* name)
 {
     #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -42,7 +47,7 @@ void GLBufferArrayWithVAO::SetName(const char* name)
     #endif
     {
         /* Set label for VAO */
-        GLSetObjectLabel(GL_VERTEX_ARRAY, vao_.GetID(), name);
+        GLSetObjectLabel(GL_VERTEX_ARRAY, vaoID_, name);
     }
 }
 
@@ -61,27 +66,25 @@ static void ThrowNoVertexBufferErr()
 
 void GLBufferArrayWithVAO::BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
-    /* Bind VAO */
-    GLStateManager::Get().BindVertexArray(GetVaoID());
+    /* Gather vertex attributes of all buffers; each buffer is sourced from its own binding point if vertex formats are separate */
+    std::vector<GLVertexArrayAttrib> attribs;
+    const bool isSeparateFormat = HasVertexAttribBinding();
+
+    while (auto bufferGL = NextArrayResource<GLBuffer>(numBuffers, bufferArray))
     {
-        while (auto bufferGL = NextArrayResource<GLBuffer>(numBuffers, bufferArray))
+        if ((bufferGL->GetBindFlags() & BindFlags::VertexBuffer) != 0)
         {
-            if ((bufferGL->GetBindFlags() & BindFlags::VertexBuffer) != 0)
-            {
-                /* Bind VBO */
-                auto vertexBufferGL = LLGL_CAST(GLBufferWithVAO*, bufferGL);
-                GLStateManager::Get().BindBuffer(GLBufferTarget::ArrayBuffer, vertexBufferGL->GetID());
-
-                /* Build each vertex attribute */
-                const auto& vertexAttribs = vertexBufferGL->GetVertexAttribs();
-                for (const auto& attrib : vertexAttribs)
-                    vao_.BuildVertexAttribute(attrib);
-            }
-            else
-                ThrowNoVertexBufferErr();
+            auto vertexBufferGL = LLGL_CAST(GLBufferWithVAO*, bufferGL);
+            vertexBufferGL->AppendVertexArrayAttribs(attribs, static_cast<GLuint>(vertexBufferBindings_.buffers.size()));
+            if (isSeparateFormat)
+                vertexBufferGL->AppendVertexBufferBinding(vertexBufferBindings_);
         }
+        else
+            ThrowNoVertexBufferErr();
     }
-    GLStateManager::Get().BindVertexArray(0);
+
+    /* Acquire VAO for the combined vertex attributes from the cache */
+    vaoID_ = GLVertexArrayCache::Get().AcquireVertexArray(attribs);
 }
 
 #ifdef LLGL_GL_ENABLE_OPENGL2X
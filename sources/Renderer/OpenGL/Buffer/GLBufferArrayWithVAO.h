@@ -10,7 +10,7 @@
 
 
 #include "GLBufferArray.h"
-#include "GLVertexArrayObject.h"
+#include "GLVertexArrayCache.h"
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 #   include "GL2XVertexArray.h"
 #endif
@@ -30,11 +30,18 @@ class GLBufferArrayWithVAO final : public GLBufferArray
     public:
 
         GLBufferArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        ~GLBufferArrayWithVAO();
 
         // Returns the ID of the vertex-array-object (VAO)
         inline GLuint GetVaoID() const
         {
-            return vao_.GetID();
+            return vaoID_;
+        }
+
+        // Returns the vertex buffer bindings that must be bound after the VAO. This is empty if GL_ARB_vertex_attrib_binding is not supported.
+        inline const GLVertexBufferBindings& GetVertexBufferBindings() const
+        {
+            return vertexBufferBindings_;
         }
 
         #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -54,10 +61,11 @@ class GLBufferArrayWithVAO final : public GLBufferArray
 
     private:
 
-        GLVertexArrayObject vao_;
+        GLuint                  vaoID_                  = 0;
+        GLVertexBufferBindings  vertexBufferBindings_;
 
         #ifdef LLGL_GL_ENABLE_OPENGL2X
-        GL2XVertexArray     vertexArrayGL2X_;
+        GL2XVertexArray         vertexArrayGL2X_;
         #endif
 
 };
@@ -19,6 +19,12 @@ GLBufferWithVAO::GLBufferWithVAO(long bindFlags) :
 {
 }
 
+GLBufferWithVAO::~GLBufferWithVAO()
+{
+    GLVertexArrayCache::Get().ReleaseVertexArray(vaoID_);
+    GLVertexArrayCache::Get().NotifyBufferRelease(GetID());
+}
+
 void GLBufferWithVAO::BuildVertexArray(std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs)
 {
     /* Store vertex format (required if this buffer is used in a buffer array) */
@@ -41,6 +47,34 @@ void GLBufferWithVAO::BuildVertexArray(std::size_t numVertexAttribs, const Verte
     }
 }
 
+void GLBufferWithVAO::AppendVertexArrayAttribs(std::vector<GLVertexArrayAttrib>& outAttribs, GLuint binding) const
+{
+    /* With separate vertex formats, the VAO does not refer to this buffer, so it can be shared with all buffers of the same format */
+    const bool isSeparateFormat = HasVertexAttribBinding();
+
+    for (const VertexAttribute& attrib : vertexAttribs_)
+    {
+        GLVertexArrayAttrib vertexArrayAttrib;
+        {
+            vertexArrayAttrib.buffer            = (isSeparateFormat ? 0 : GetID());
+            vertexArrayAttrib.binding           = (isSeparateFormat ? binding : 0);
+            vertexArrayAttrib.location          = attrib.location;
+            vertexArrayAttrib.format            = attrib.format;
+            vertexArrayAttrib.offset            = attrib.offset;
+            vertexArrayAttrib.stride            = (isSeparateFormat ? 0 : attrib.stride);
+            vertexArrayAttrib.instanceDivisor   = attrib.instanceDivisor;
+        }
+        outAttribs.push_back(vertexArrayAttrib);
+    }
+}
+
+void GLBufferWithVAO::AppendVertexBufferBinding(GLVertexBufferBindings& outBindings) const
+{
+    /* All vertex attributes of a buffer have the same stride */
+    const GLsizei stride = (vertexAttribs_.empty() ? 0 : static_cast<GLsizei>(vertexAttribs_.front().stride));
+    outBindings.Append(GetID(), stride);
+}
+
 
 /*
  * ======= Private: =======
@@ -48,17 +82,18 @@ void GLBufferWithVAO::BuildVertexArray(std::size_t numVertexAttribs, const Verte
 
 void GLBufferWithVAO::BuildVertexArrayWithVAO()
 {
-    /* Bind VAO */
-    GLStateManager::Get().BindVertexArray(GetVaoID());
-    {
-        /* Bind VBO */
-        GLStateManager::Get().BindBuffer(GLBufferTarget::ArrayBuffer, GetID());
-
-        /* Build each vertex attribute */
-        for (const auto& attrib : vertexAttribs_)
-            vao_.BuildVertexAttribute(attrib);
-    }
-    GLStateManager::Get().BindVertexArray(0);
+    /* Acquire VAO for the vertex attributes of this buffer from the cache */
+    std::vector<GLVertexArrayAttrib> attribs;
+    AppendVertexArrayAttribs(attribs);
+
+    const GLuint prevVaoID = vaoID_;
+    vaoID_ = GLVertexArrayCache::Get().AcquireVertexArray(attribs);
+    GLVertexArrayCache::Get().ReleaseVertexArray(prevVaoID);
+
+    /* Store vertex buffer binding that is bound with the VAO */
+    vertexBufferBindings_ = GLVertexBufferBindings{};
+    if (HasVertexAttribBinding())
+        AppendVertexBufferBinding(vertexBufferBindings_);
 }
 
 #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -10,7 +10,7 @@
 
 
 #include "GLBuffer.h"
-#include "GLVertexArrayObject.h"
+#include "GLVertexArrayCache.h"
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 #   include "GL2XVertexArray.h"
 #endif
@@ -26,13 +26,26 @@ class GLBufferWithVAO final : public GLBuffer
     public:
 
         GLBufferWithVAO(long bindFlags);
+        ~GLBufferWithVAO();
 
         void BuildVertexArray(std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs);
 
+        // Appends the vertex attributes of this buffer to the specified list to build a VAO with the <GLVertexArrayCache>.
+        void AppendVertexArrayAttribs(std::vector<GLVertexArrayAttrib>& outAttribs, GLuint binding = 0) const;
+
+        // Appends the vertex buffer binding of this buffer to the specified bindings. Only used if GL_ARB_vertex_attrib_binding is supported.
+        void AppendVertexBufferBinding(GLVertexBufferBindings& outBindings) const;
+
         // Returns the ID of the vertex-array-object (VAO)
         inline GLuint GetVaoID() const
         {
-            return vao_.GetID();
+            return vaoID_;
+        }
+
+        // Returns the vertex buffer bindings that must be bound after the VAO. This is empty if GL_ARB_vertex_attrib_binding is not supported.
+        inline const GLVertexBufferBindings& GetVertexBufferBindings() const
+        {
+            return vertexBufferBindings_;
         }
 
         // Returns the list of vertex attributes.
@@ -58,8 +71,9 @@ class GLBufferWithVAO final : public GLBuffer
 
     private:
 
-        GLVertexArrayObject             vao_;
+        GLuint                          vaoID_                  = 0;
         std::vector<VertexAttribute>    vertexAttribs_;
+        GLVertexBufferBindings          vertexBufferBindings_;
 
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         GL2XVertexArray                 vertexArrayGL2X_;
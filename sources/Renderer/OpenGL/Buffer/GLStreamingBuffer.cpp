@@ -0,0 +1,264 @@
+/*
+ * GLStreamingBuffer.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GLStreamingBuffer.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/Assertion.h"
+#include "../../../Core/CoreUtils.h"
+#include <algorithm>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+constexpr std::uint32_t GLStreamingBuffer::numSegments;
+
+// Alignment of each allocation within the ring buffer to keep memcpy efficient. This also satisfies any GL_UNPACK_ALIGNMENT.
+static constexpr GLintptr g_streamingBufferAlignment = 16;
+
+// Segment size for buffer updates.
+static constexpr GLsizeiptr g_bufferSegmentSize = 1024 * 1024;
+
+// Segment size for texture uploads; large enough for a 1920x1080 RGBA8 video frame.
+static constexpr GLsizeiptr g_pixelUnpackSegmentSize = 8 * 1024 * 1024;
+
+GLStreamingBuffer::GLStreamingBuffer(GLsizeiptr segmentSize) :
+    segmentSize_ { segmentSize }
+{
+}
+
+GLStreamingBuffer& GLStreamingBuffer::Get()
+{
+    static GLStreamingBuffer instance{ g_bufferSegmentSize };
+    return instance;
+}
+
+GLStreamingBuffer& GLStreamingBuffer::GetPixelUnpack()
+{
+    static GLStreamingBuffer instance{ g_pixelUnpackSegmentSize };
+    return instance;
+}
+
+GLStreamingBuffer& GLStreamingBuffer::GetUniform()
+{
+    static GLStreamingBuffer instance{ g_bufferSegmentSize };
+    return instance;
+}
+
+void GLStreamingBuffer::Configure(GLsizeiptr segmentSize, bool enabled)
+{
+    /* Storage is created with the first allocation, so it only has to be released if the segment size changes afterwards */
+    segmentSize = GetAlignedSize<GLsizeiptr>(segmentSize, g_streamingBufferAlignment);
+    if (segmentSize > 0 && segmentSize != segmentSize_)
+    {
+        Clear();
+        segmentSize_ = segmentSize;
+    }
+    enabled_ = enabled;
+}
+
+void GLStreamingBuffer::Clear()
+{
+    if (id_ != 0)
+    {
+        if (mappedData_ != nullptr)
+        {
+            GLStateManager::Get().BindBuffer(GLBufferTarget::CopyReadBuffer, id_);
+            glUnmapBuffer(GL_COPY_READ_BUFFER);
+        }
+        glDeleteBuffers(1, &id_);
+        GLStateManager::Get().NotifyBufferRelease(id_, GLBufferTarget::CopyReadBuffer);
+        GLStateManager::Get().NotifyBufferRelease(id_, GLBufferTarget::PixelUnpackBuffer);
+        GLStateManager::Get().NotifyBufferRelease(id_, GLBufferTarget::UniformBuffer);
+        id_ = 0;
+    }
+
+    for (Segment& segment : segments_)
+    {
+        glDeleteSync(segment.fence);
+        segment = Segment{};
+    }
+
+    mappedData_     = nullptr;
+    offset_         = 0;
+    currentSegment_ = 0;
+}
+
+bool GLStreamingBuffer::IsSupported()
+{
+    #ifdef GL_ARB_buffer_storage
+    return
+    (
+        HasExtension(GLExt::ARB_buffer_storage) &&
+        HasExtension(GLExt::ARB_copy_buffer)    &&
+        HasExtension(GLExt::ARB_sync)
+    );
+    #else
+    return false;
+    #endif
+}
+
+bool GLStreamingBuffer::IsAvailable(GLsizeiptr size) const
+{
+    return (enabled_ && size <= segmentSize_ && GLStreamingBuffer::IsSupported());
+}
+
+void* GLStreamingBuffer::Alloc(GLsizeiptr size, GLintptr& outOffset, GLintptr alignment, bool wait)
+{
+    LLGL_ASSERT(size <= segmentSize_);
+
+    if (id_ == 0)
+        CreateStorage();
+    if (mappedData_ == nullptr)
+        return nullptr;
+
+    /* Move on to the next segment if the allocation does not fit into the remainder of the current segment */
+    alignment = std::max(alignment, g_streamingBufferAlignment);
+    GLintptr offset = (offset_ + alignment - 1) / alignment * alignment;
+
+    if (offset + size > static_cast<GLintptr>(currentSegment_ + 1) * segmentSize_)
+    {
+        const std::uint32_t nextSegment = (currentSegment_ + 1) % GLStreamingBuffer::numSegments;
+
+        /* Don't write into the retired segment anymore, even if the next segment is not available yet */
+        RetireSegment(currentSegment_);
+        offset_ = static_cast<GLintptr>(currentSegment_ + 1) * segmentSize_;
+
+        if (!EnterSegment(nextSegment, wait))
+            return nullptr;
+
+        currentSegment_ = nextSegment;
+        offset          = static_cast<GLintptr>(nextSegment) * segmentSize_;
+    }
+
+    segments_[currentSegment_].pendingCopies++;
+    offset_     = offset + size;
+    outOffset   = offset;
+
+    return (mappedData_ + offset);
+}
+
+void GLStreamingBuffer::CopyToBuffer(GLuint dstBuffer, GLintptr dstOffset, GLintptr srcOffset, GLsizeiptr size)
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glCopyNamedBufferSubData(id_, dstBuffer, srcOffset, dstOffset, size);
+    }
+    else
+    #endif // /GL_ARB_direct_state_access
+    {
+        GLStateManager::Get().BindBuffer(GLBufferTarget::CopyReadBuffer, id_);
+        GLStateManager::Get().BindBuffer(GLBufferTarget::CopyWriteBuffer, dstBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, size);
+    }
+    Complete(srcOffset);
+}
+
+void GLStreamingBuffer::Complete(GLintptr srcOffset)
+{
+    /* Fence retired segment once its last pending copy has been issued */
+    Segment& segment = segments_[srcOffset / segmentSize_];
+    LLGL_ASSERT(segment.pendingCopies > 0);
+    if (--segment.pendingCopies == 0 && segment.retired)
+        InsertFence(segment);
+}
+
+bool GLStreamingBuffer::Write(GLuint dstBuffer, GLintptr dstOffset, const void* data, GLsizeiptr size)
+{
+    GLintptr srcOffset = 0;
+    if (void* dst = Alloc(size, srcOffset))
+    {
+        ::memcpy(dst, data, static_cast<std::size_t>(size));
+        CopyToBuffer(dstBuffer, dstOffset, srcOffset, size);
+        return true;
+    }
+    return false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLStreamingBuffer::CreateStorage()
+{
+    #ifdef GL_ARB_buffer_storage
+
+    const GLsizeiptr    capacity    = segmentSize_ * GLStreamingBuffer::numSegments;
+    const GLbitfield    flags       = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+    /* Allocate immutable storage and keep it mapped for the lifetime of this buffer */
+    glGenBuffers(1, &id_);
+    GLStateManager::Get().BindBuffer(GLBufferTarget::CopyReadBuffer, id_);
+    glBufferStorage(GL_COPY_READ_BUFFER, capacity, nullptr, flags);
+    mappedData_ = reinterpret_cast<char*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, capacity, flags));
+
+    #endif // /GL_ARB_buffer_storage
+}
+
+void GLStreamingBuffer::RetireSegment(std::uint32_t segment)
+{
+    Segment& seg = segments_[segment];
+    if (!seg.retired)
+    {
+        seg.retired = true;
+        if (seg.pendingCopies == 0)
+            InsertFence(seg);
+    }
+}
+
+bool GLStreamingBuffer::EnterSegment(std::uint32_t segment, bool wait)
+{
+    Segment& seg = segments_[segment];
+
+    /* Segment cannot be reused while a mapped region has not been copied yet */
+    if (seg.pendingCopies > 0)
+        return false;
+
+    if (seg.fence != nullptr)
+    {
+        /* Poll the fence, which also flushes it to the GPU, so the caller can fall back to its direct upload path instead of stalling */
+        GLenum result = glClientWaitSync(seg.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            if (!wait)
+                return false;
+
+            /* Wait until the GPU has finished all copies from this segment */
+            constexpr GLuint64 timeout = 1000000000ull;
+            do
+            {
+                result = glClientWaitSync(seg.fence, 0, timeout);
+            }
+            while (result == GL_TIMEOUT_EXPIRED);
+        }
+
+        glDeleteSync(seg.fence);
+        seg.fence = nullptr;
+    }
+
+    seg.retired = false;
+    return true;
+}
+
+void GLStreamingBuffer::InsertFence(Segment& segment)
+{
+    glDeleteSync(segment.fence);
+    segment.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
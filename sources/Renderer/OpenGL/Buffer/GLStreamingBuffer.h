@@ -0,0 +1,137 @@
+/*
+ * GLStreamingBuffer.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GL_STREAMING_BUFFER_H
+#define LLGL_GL_STREAMING_BUFFER_H
+
+
+#include "../OpenGL.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Ring buffer with persistent and coherent mapped storage to stream data into dynamic buffers and textures.
+Data is written into the ring buffer with a memcpy and then transferred with a GPU-side buffer copy or pixel unpack operation,
+so updating a resource that is still in use by the GPU does not cause an implicit synchronization.
+The ring buffer is divided into segments that are fenced with 'glFenceSync' after the last copy from each segment has been issued.
+There is one instance for buffer updates, one for texture uploads (via GL_PIXEL_UNPACK_BUFFER) with larger segments,
+and one for emulated uniform blocks whose regions are bound directly with glBindBufferRange.
+*/
+class GLStreamingBuffer
+{
+
+    public:
+
+        // Returns the instance for buffer updates.
+        static GLStreamingBuffer& Get();
+
+        // Returns the instance for texture uploads, which is bound to GL_PIXEL_UNPACK_BUFFER.
+        static GLStreamingBuffer& GetPixelUnpack();
+
+        // Returns the instance for emulated uniform blocks, which is bound to GL_UNIFORM_BUFFER.
+        static GLStreamingBuffer& GetUniform();
+
+    public:
+
+        GLStreamingBuffer(const GLStreamingBuffer&) = delete;
+        GLStreamingBuffer& operator = (const GLStreamingBuffer&) = delete;
+
+        // Sets the segment size and whether this instance is used at all. A segment size of zero keeps the current one.
+        void Configure(GLsizeiptr segmentSize, bool enabled);
+
+        // Releases the resource for this singleton class.
+        void Clear();
+
+        // Returns true if the required extensions for persistent mapped buffers are supported.
+        static bool IsSupported();
+
+        // Returns true if streaming is supported and enabled, and data of the specified size fits into a single segment.
+        bool IsAvailable(GLsizeiptr size) const;
+
+        // Returns true if this instance has not been disabled with Configure().
+        inline bool IsEnabled() const
+        {
+            return enabled_;
+        }
+
+        /*
+        Allocates a region of the specified size and returns a CPU pointer to it, or null if no region can be allocated without a stall.
+        If 'wait' is true, this function waits for the GPU to release the next segment instead, and only returns null if a mapped region of that segment has not been completed yet.
+        Each allocation must be completed with either CopyToBuffer() or Complete().
+        The offset is aligned to at least 16 bytes or the specified alignment, which must divide the segment size, e.g. GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+        */
+        void* Alloc(GLsizeiptr size, GLintptr& outOffset, GLintptr alignment = 1, bool wait = false);
+
+        // Copies a region that was allocated with Alloc() into the destination buffer and completes the allocation.
+        void CopyToBuffer(GLuint dstBuffer, GLintptr dstOffset, GLintptr srcOffset, GLsizeiptr size);
+
+        // Completes an allocation after the GPU command that reads the region has been issued, e.g. glTexSubImage2D with GL_PIXEL_UNPACK_BUFFER.
+        void Complete(GLintptr srcOffset);
+
+        // Writes the specified data into the destination buffer via the ring buffer. Returns false if no region could be allocated.
+        bool Write(GLuint dstBuffer, GLintptr dstOffset, const void* data, GLsizeiptr size);
+
+        // Returns the GL buffer object. This is zero until the first allocation.
+        inline GLuint GetID() const
+        {
+            return id_;
+        }
+
+    private:
+
+        static constexpr std::uint32_t  numSegments     = 4;
+
+        struct Segment
+        {
+            GLsync          fence           = nullptr;
+            std::uint32_t   pendingCopies   = 0;
+            bool            retired         = false;
+        };
+
+    private:
+
+        GLStreamingBuffer(GLsizeiptr segmentSize);
+
+        void CreateStorage();
+
+        // Marks the specified segment as no longer being written to and fences it once all of its copies have been issued.
+        void RetireSegment(std::uint32_t segment);
+
+        /*
+        Makes the specified segment available for new allocations once the GPU has finished reading from it.
+        Returns false if it still has pending copies, or if the GPU is still reading from it and 'wait' is false.
+        */
+        bool EnterSegment(std::uint32_t segment, bool wait);
+
+        void InsertFence(Segment& segment);
+
+    private:
+
+        GLsizeiptr      segmentSize_            = 0;
+        bool            enabled_                = true;
+
+        GLuint          id_                     = 0;
+        char*           mappedData_             = nullptr;
+        GLintptr        offset_                 = 0;
+        std::uint32_t   currentSegment_         = 0;
+        Segment         segments_[numSegments];
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
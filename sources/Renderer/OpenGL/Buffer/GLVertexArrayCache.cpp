@@ -0,0 +1,259 @@
+/*
+ * GLVertexArrayCache.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GLVertexArrayCache.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/CoreUtils.h"
+#include "../../../Core/Assertion.h"
+#include <LLGL/VertexAttribute.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Maximum number of unreferenced VAOs that are kept alive for reuse.
+static constexpr std::size_t g_maxNumUnusedVertexArrays = 64;
+
+// Returns a 64-bit FNV-1a hash of the specified vertex attributes.
+static std::size_t HashVertexArrayAttribs(const ArrayView<GLVertexArrayAttrib>& attribs)
+{
+    FNV1aHasher hasher;
+
+    for (const GLVertexArrayAttrib& attrib : attribs)
+    {
+        hasher.AppendValue(attrib.buffer);
+        hasher.AppendValue(attrib.binding);
+        hasher.AppendValue(attrib.location);
+        hasher.AppendValue(static_cast<std::uint32_t>(attrib.format));
+        hasher.AppendValue(attrib.offset);
+        hasher.AppendValue(attrib.stride);
+        hasher.AppendValue(attrib.instanceDivisor);
+    }
+
+    return static_cast<std::size_t>(hasher.value);
+}
+
+static bool operator == (const GLVertexArrayAttrib& lhs, const GLVertexArrayAttrib& rhs)
+{
+    return
+    (
+        lhs.buffer          == rhs.buffer           &&
+        lhs.binding         == rhs.binding          &&
+        lhs.location        == rhs.location         &&
+        lhs.format          == rhs.format           &&
+        lhs.offset          == rhs.offset           &&
+        lhs.stride          == rhs.stride           &&
+        lhs.instanceDivisor == rhs.instanceDivisor
+    );
+}
+
+static bool AreVertexArrayAttribsEqual(const std::vector<GLVertexArrayAttrib>& lhs, const ArrayView<GLVertexArrayAttrib>& rhs)
+{
+    return (lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+
+/*
+ * GLVertexBufferBindings structure
+ */
+
+void GLVertexBufferBindings::Append(GLuint buffer, GLsizei stride)
+{
+    buffers.push_back(buffer);
+    offsets.push_back(0);
+    strides.push_back(stride);
+}
+
+
+/*
+ * GLVertexArrayCache class
+ */
+
+GLVertexArrayCache& GLVertexArrayCache::Get()
+{
+    static GLVertexArrayCache instance;
+    return instance;
+}
+
+void GLVertexArrayCache::Clear()
+{
+    unusedVertexArrays_.clear();
+    cache_.clear();
+    vertexArrays_.clear();
+}
+
+GLuint GLVertexArrayCache::AcquireVertexArray(const ArrayView<GLVertexArrayAttrib>& attribs)
+{
+    const std::size_t hash = HashVertexArrayAttribs(attribs);
+
+    if (GLVertexArrayEntry* entry = FindCachedEntry(hash, attribs))
+    {
+        /* Take cached VAO out of the LRU list if it was not referenced anymore */
+        if (entry->refCount == 0)
+            unusedVertexArrays_.erase(entry->unusedPos);
+        entry->refCount++;
+        return entry->vao.GetID();
+    }
+
+    GLVertexArrayEntry* entry = MakeEntry(hash, attribs);
+    entry->refCount = 1;
+    return entry->vao.GetID();
+}
+
+void GLVertexArrayCache::ReleaseVertexArray(GLuint vao)
+{
+    auto it = vertexArrays_.find(vao);
+    if (it == vertexArrays_.end())
+        return;
+
+    GLVertexArrayEntry& entry = *(it->second);
+    LLGL_ASSERT(entry.refCount > 0);
+
+    if (--entry.refCount == 0)
+    {
+        if (entry.isCached)
+        {
+            /* Keep VAO for reuse and evict the least recently used VAO if there are too many */
+            unusedVertexArrays_.push_front(&entry);
+            entry.unusedPos = unusedVertexArrays_.begin();
+
+            if (unusedVertexArrays_.size() > g_maxNumUnusedVertexArrays)
+            {
+                GLVertexArrayEntry* leastRecentlyUsed = unusedVertexArrays_.back();
+                unusedVertexArrays_.pop_back();
+                UncacheEntry(*leastRecentlyUsed);
+                DeleteEntry(*leastRecentlyUsed);
+            }
+        }
+        else
+            DeleteEntry(entry);
+    }
+}
+
+void GLVertexArrayCache::NotifyBufferRelease(GLuint buffer)
+{
+    /* Collect all VAOs that source vertex attributes from the specified buffer */
+    std::vector<GLVertexArrayEntry*> releasedEntries;
+
+    for (const auto& it : vertexArrays_)
+    {
+        GLVertexArrayEntry& entry = *(it.second);
+        if (!entry.isCached)
+            continue;
+
+        for (const GLVertexArrayAttrib& attrib : entry.attribs)
+        {
+            if (attrib.buffer == buffer)
+            {
+                releasedEntries.push_back(&entry);
+                break;
+            }
+        }
+    }
+
+    /* Remove these VAOs from the cache; VAOs that are still referenced are deleted with their last release */
+    for (GLVertexArrayEntry* entry : releasedEntries)
+    {
+        UncacheEntry(*entry);
+        if (entry->refCount == 0)
+        {
+            unusedVertexArrays_.erase(entry->unusedPos);
+            DeleteEntry(*entry);
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+GLVertexArrayCache::GLVertexArrayEntry* GLVertexArrayCache::FindCachedEntry(std::size_t hash, const ArrayView<GLVertexArrayAttrib>& attribs)
+{
+    auto range = cache_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (AreVertexArrayAttribsEqual(it->second->attribs, attribs))
+            return it->second;
+    }
+    return nullptr;
+}
+
+GLVertexArrayCache::GLVertexArrayEntry* GLVertexArrayCache::MakeEntry(std::size_t hash, const ArrayView<GLVertexArrayAttrib>& attribs)
+{
+    auto entry = MakeUnique<GLVertexArrayEntry>();
+    {
+        entry->attribs  = std::vector<GLVertexArrayAttrib>(attribs.begin(), attribs.end());
+        entry->hash     = hash;
+    }
+
+    /* Build VAO with all vertex attributes */
+    GLStateManager::Get().BindVertexArray(entry->vao.GetID());
+    {
+        for (const GLVertexArrayAttrib& attrib : attribs)
+        {
+            VertexAttribute vertexAttrib;
+            {
+                vertexAttrib.format          = attrib.format;
+                vertexAttrib.location        = attrib.location;
+                vertexAttrib.offset          = attrib.offset;
+                vertexAttrib.stride          = attrib.stride;
+                vertexAttrib.instanceDivisor = attrib.instanceDivisor;
+            }
+            if (attrib.buffer == 0 && HasVertexAttribBinding())
+            {
+                /* Only specify vertex format; vertex buffers are bound separately with each use of this VAO */
+                entry->vao.BuildVertexAttributeFormat(vertexAttrib, attrib.binding);
+            }
+            else
+            {
+                GLStateManager::Get().BindBuffer(GLBufferTarget::ArrayBuffer, attrib.buffer);
+                entry->vao.BuildVertexAttribute(vertexAttrib);
+            }
+        }
+    }
+    GLStateManager::Get().BindVertexArray(0);
+
+    GLVertexArrayEntry* entryRef = entry.get();
+    cache_.emplace(hash, entryRef);
+    vertexArrays_[entryRef->vao.GetID()] = std::move(entry);
+
+    return entryRef;
+}
+
+void GLVertexArrayCache::UncacheEntry(GLVertexArrayEntry& entry)
+{
+    if (entry.isCached)
+    {
+        auto range = cache_.equal_range(entry.hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == &entry)
+            {
+                cache_.erase(it);
+                break;
+            }
+        }
+        entry.isCached = false;
+    }
+}
+
+void GLVertexArrayCache::DeleteEntry(GLVertexArrayEntry& entry)
+{
+    const GLuint vao = entry.vao.GetID();
+    vertexArrays_.erase(vao);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,151 @@
+/*
+ * GLVertexArrayCache.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GL_VERTEX_ARRAY_CACHE_H
+#define LLGL_GL_VERTEX_ARRAY_CACHE_H
+
+
+#include "GLVertexArrayObject.h"
+#include "../OpenGL.h"
+#include <LLGL/Format.h>
+#include <LLGL/Container/ArrayView.h>
+#include <unordered_map>
+#include <vector>
+#include <list>
+#include <memory>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Vertex attribute that is sourced from a specific GL buffer. This is the key to identify a VAO in the <GLVertexArrayCache>.
+If GL_ARB_vertex_attrib_binding is supported, 'buffer' and 'stride' are zero and the attribute is sourced from the vertex buffer binding point 'binding' instead.
+The VAO then only stores the vertex format and can be shared by all owners with the same format regardless of their buffers.
+*/
+struct GLVertexArrayAttrib
+{
+    GLuint  buffer;
+    GLuint  binding;
+    GLuint  location;
+    Format  format;
+    GLuint  offset;
+    GLuint  stride;
+    GLuint  instanceDivisor;
+};
+
+// Contiguous range of vertex buffer bindings that is bound with <GLStateManager::BindVertexBuffers> after its VAO has been bound.
+struct GLVertexBufferBindings
+{
+    std::vector<GLuint>     buffers;
+    std::vector<GLintptr>   offsets;
+    std::vector<GLsizei>    strides;
+
+    // Appends a binding for the specified buffer.
+    void Append(GLuint buffer, GLsizei stride);
+
+    // Returns true if there are no bindings.
+    inline bool Empty() const
+    {
+        return buffers.empty();
+    }
+
+    // Returns the number of bindings.
+    inline GLsizei Count() const
+    {
+        return static_cast<GLsizei>(buffers.size());
+    }
+};
+
+/*
+Class to manage create/reuse/delete of GL vertex-array-objects (VAO); used by <GLBufferWithVAO> and <GLBufferArrayWithVAO>.
+VAOs are shared by all owners with the same vertex attribute layout and buffer IDs, and looked up by a hash of these attributes.
+VAOs that are no longer referenced are kept alive for reuse and evicted in least-recently-used (LRU) order.
+*/
+class GLVertexArrayCache
+{
+
+    public:
+
+        // Returns the instance of this singleton.
+        static GLVertexArrayCache& Get();
+
+    public:
+
+        GLVertexArrayCache(const GLVertexArrayCache&) = delete;
+        GLVertexArrayCache& operator = (const GLVertexArrayCache&) = delete;
+
+        GLVertexArrayCache(GLVertexArrayCache&&) = delete;
+        GLVertexArrayCache& operator = (GLVertexArrayCache&&) = delete;
+
+        // Releases all resources for this singleton class.
+        void Clear();
+
+        // Returns the ID of a VAO for the specified vertex attributes and increments its reference counter. The VAO is built if it is not cached yet.
+        GLuint AcquireVertexArray(const ArrayView<GLVertexArrayAttrib>& attribs);
+
+        // Releases the VAO that was returned by AcquireVertexArray.
+        void ReleaseVertexArray(GLuint vao);
+
+        /*
+        Notifies the VAO cache that the specified GL buffer was released.
+        This removes all VAOs with this buffer from the cache, since the buffer ID can be reused by the GL for a new buffer.
+        */
+        void NotifyBufferRelease(GLuint buffer);
+
+    private:
+
+        struct GLVertexArrayEntry
+        {
+            GLVertexArrayObject                         vao;
+            std::vector<GLVertexArrayAttrib>            attribs;
+            std::size_t                                 hash        = 0;
+            std::uint32_t                               refCount    = 0;
+            bool                                        isCached    = true;
+            std::list<GLVertexArrayEntry*>::iterator    unusedPos;
+        };
+
+    private:
+
+        GLVertexArrayCache() = default;
+
+        // Returns the cached entry with the specified vertex attributes or null if there is no such entry.
+        GLVertexArrayEntry* FindCachedEntry(std::size_t hash, const ArrayView<GLVertexArrayAttrib>& attribs);
+
+        // Creates a new entry and builds its VAO with the specified vertex attributes.
+        GLVertexArrayEntry* MakeEntry(std::size_t hash, const ArrayView<GLVertexArrayAttrib>& attribs);
+
+        // Removes the specified entry from the cache so it cannot be acquired anymore.
+        void UncacheEntry(GLVertexArrayEntry& entry);
+
+        // Deletes the specified entry and its VAO.
+        void DeleteEntry(GLVertexArrayEntry& entry);
+
+    private:
+
+        // All VAOs managed by this cache, accessed by their IDs.
+        std::unordered_map<GLuint, std::unique_ptr<GLVertexArrayEntry>> vertexArrays_;
+
+        // Cached VAOs that can be acquired, accessed by the hash of their vertex attributes.
+        std::unordered_multimap<std::size_t, GLVertexArrayEntry*>       cache_;
+
+        // Cached VAOs that are not referenced anymore; the most recently released VAO is at the front.
+        std::list<GLVertexArrayEntry*>                                  unusedVertexArrays_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
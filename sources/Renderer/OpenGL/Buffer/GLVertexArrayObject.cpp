@@ -34,11 +34,9 @@ GLVertexArrayObject::~GLVertexArrayObject()
     }
 }
 
-void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
+// Returns the format attributes of the specified vertex attribute and traps if its format cannot be used for vertex attributes.
+static const FormatAttributes& GetVertexFormatAttribs(const VertexAttribute& attribute)
 {
-    LLGL_ASSERT_GL_EXT(ARB_vertex_array_object);
-
-    /* Get data type and components of vector type */
     const auto& formatAttribs = GetFormatAttribs(attribute.format);
     if ((formatAttribs.flags & FormatFlags::SupportsVertex) == 0)
     {
@@ -47,6 +45,15 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
         else
             LLGL_TRAP("unknown format cannot be used for vertex attributes");
     }
+    return formatAttribs;
+}
+
+void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
+{
+    LLGL_ASSERT_GL_EXT(ARB_vertex_array_object);
+
+    /* Get data type and components of vector type */
+    const auto& formatAttribs = GetVertexFormatAttribs(attribute);
 
     /* Convert offset to pointer sized type (for 32- and 64 bit builds) */
     auto dataType       = GLTypes::Map(formatAttribs.dataType);
@@ -87,6 +94,36 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
     }
 }
 
+void GLVertexArrayObject::BuildVertexAttributeFormat(const VertexAttribute& attribute, GLuint bindingIndex)
+{
+    LLGL_ASSERT_GL_EXT(ARB_vertex_attrib_binding);
+
+    #ifdef GL_ARB_vertex_attrib_binding
+
+    /* Get data type and components of vector type */
+    const auto& formatAttribs = GetVertexFormatAttribs(attribute);
+
+    auto dataType       = GLTypes::Map(formatAttribs.dataType);
+    auto components     = static_cast<GLint>(formatAttribs.components);
+    auto attribIndex    = static_cast<GLuint>(attribute.location);
+    auto relativeOffset = static_cast<GLuint>(attribute.offset);
+
+    /* Enable array index in currently bound VAO */
+    glEnableVertexAttribArray(attribIndex);
+
+    /* Specify vertex format relative to the buffer that is bound to the binding point */
+    if ((formatAttribs.flags & FormatFlags::IsNormalized) == 0 && !IsFloatFormat(attribute.format))
+        glVertexAttribIFormat(attribIndex, components, dataType, relativeOffset);
+    else
+        glVertexAttribFormat(attribIndex, components, dataType, GLBoolean((formatAttribs.flags & FormatFlags::IsNormalized) != 0), relativeOffset);
+
+    /* Source attribute from binding point; the instance divisor is a state of the binding point, not of the attribute */
+    glVertexAttribBinding(attribIndex, bindingIndex);
+    glVertexBindingDivisor(bindingIndex, attribute.instanceDivisor);
+
+    #endif // /GL_ARB_vertex_attrib_binding
+}
+
 
 } // /namespace LLGL
 
@@ -30,6 +30,9 @@ class GLVertexArrayObject
         // Builds the specified attribute using a 'glVertexAttrib*Pointer' function.
         void BuildVertexAttribute(const VertexAttribute& attribute);
 
+        // Builds the format of the specified attribute using a 'glVertexAttrib*Format' function and sources it from the specified vertex buffer binding point.
+        void BuildVertexAttributeFormat(const VertexAttribute& attribute, GLuint bindingIndex);
+
         // Returns the ID of the hardware vertex-array-object (VAO)
         inline GLuint GetID() const
         {
@@ -32,6 +32,7 @@ class GLSwapChain;
 class GLRenderTarget;
 class GLRenderPass;
 class GLDeferredCommandBuffer;
+struct GLVertexBufferBindings;
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 class GL2XVertexArray;
 class GL2XSampler;
@@ -69,6 +70,15 @@ struct GLCmdClearBufferSubData
     std::uint32_t   data;
 };
 
+struct GLCmdClearBufferPattern
+{
+    GLBuffer*       buffer;
+    GLintptr        offset;
+    GLsizeiptr      size;
+    GLsizei         patternSize;
+    std::uint8_t    pattern[16];
+};
+
 struct GLCmdCopyImageSubData
 {
     GLTexture*  dstTexture;
@@ -173,6 +183,11 @@ struct GLCmdClearAttachmentsWithRenderPass
 //  const ClearValue*   clearValues[numClearValues];
 };
 
+struct GLCmdEndRenderPass
+{
+    const GLRenderPass* renderPass;
+};
+
 struct GLCmdClearBuffers
 {
     std::uint32_t   numAttachments;
@@ -181,7 +196,8 @@ struct GLCmdClearBuffers
 
 struct GLCmdBindVertexArray
 {
-    GLuint vao;
+    GLuint                          vao;
+    const GLVertexBufferBindings*   bindings; // Vertex buffer bindings of the owner of this VAO; null if GL_ARB_vertex_attrib_binding is not used
 };
 
 #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -204,6 +220,15 @@ struct GLCmdBindBufferBase
     GLuint          id;
 };
 
+struct GLCmdBindBufferRange
+{
+    GLBufferTarget  target;
+    GLuint          index;
+    GLuint          id;
+    GLintptr        offset;
+    GLsizeiptr      size;
+};
+
 struct GLCmdBindBuffersBase
 {
     GLBufferTarget  target;
@@ -226,6 +251,11 @@ struct GLCmdBeginTransformFeedbackNV
 
 //struct GLCmdEndTransformFeedbackNV {};
 
+struct GLCmdBindTransformFeedback
+{
+    GLuint id;
+};
+
 struct GLCmdBindResourceHeap
 {
     GLResourceHeap* resourceHeap;
@@ -263,6 +293,14 @@ struct GLCmdSetUniforms
 //  GLuint      buffer[size];
 };
 
+struct GLCmdSetUniformBlock
+{
+    const GLPipelineState*  pipelineState;
+    std::uint32_t           first;
+    std::uint32_t           size;
+//  std::uint32_t           buffer[size/4];
+};
+
 struct GLCmdBeginQuery
 {
     GLQueryHeap*    queryHeap;
@@ -271,7 +309,8 @@ struct GLCmdBeginQuery
 
 struct GLCmdEndQuery
 {
-    GLQueryHeap* queryHeap;
+    GLQueryHeap*    queryHeap;
+    std::uint32_t   query;
 };
 
 struct GLCmdBeginConditionalRender
@@ -315,51 +354,60 @@ struct GLCmdDrawArraysIndirect
     std::uint32_t   stride;
 };
 
+struct GLCmdDrawTransformFeedback
+{
+    GLenum  mode;
+    GLuint  id;
+};
+
+// Indexed draw commands store 'mode' and 'type' as 16-bit values and 'indices' first to avoid padding,
+// so the most frequent commands occupy fewer cache lines during replay. All GL primitive and index types fit into 16 bits.
+
 struct GLCmdDrawElements
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
+    GLushort        mode;
+    GLushort        type;
 };
 
 struct GLCmdDrawElementsBaseVertex
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
     GLint           basevertex;
+    GLushort        mode;
+    GLushort        type;
 };
 
 struct GLCmdDrawElementsInstanced
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
     GLsizei         instancecount;
+    GLushort        mode;
+    GLushort        type;
 };
 
 struct GLCmdDrawElementsInstancedBaseVertex
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
     GLsizei         instancecount;
     GLint           basevertex;
+    GLushort        mode;
+    GLushort        type;
 };
 
 struct GLCmdDrawElementsInstancedBaseVertexBaseInstance
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
     GLsizei         instancecount;
     GLint           basevertex;
     GLuint          baseinstance;
+    GLushort        mode;
+    GLushort        type;
 };
 
 struct GLCmdDrawElementsIndirect
@@ -391,6 +439,24 @@ struct GLCmdMultiDrawElementsIndirect
     GLsizei         stride;
 };
 
+// Indirect draw command layouts as specified for glMultiDrawArraysIndirect and glMultiDrawElementsIndirect.
+struct GLDrawArraysIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint first;
+    GLuint baseInstance;
+};
+
+struct GLDrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint  baseVertex;
+    GLuint baseInstance;
+};
+
 struct GLCmdDispatchCompute
 {
     GLuint numgroups[3];
@@ -42,16 +42,139 @@
 
 #include <LLGL/StaticLimits.h>
 #include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
-static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITCompiler& compiler)
+// Index of variadic argument of entry point for the state manager.
+static const JITVarArg g_stateMngrArg{ 0 };
+
+// Command size that is returned by AssembleGLCommand() for opcodes that cannot be assembled.
+static constexpr std::size_t g_invalidGLCommandSize = ~static_cast<std::size_t>(0);
+
+// Object name for bindings that are not statically known while a command buffer is assembled.
+static constexpr GLuint g_unknownGLName = ~0u;
+
+// Number of texture and sampler slots whose bindings are tracked while a command buffer is assembled.
+static constexpr GLuint g_numTrackedGLSlots = 32;
+
+/*
+States that are statically known while a command buffer is assembled.
+The JIT program starts with unknown states, but once a command has set a state, the same command is redundant until the state is invalidated.
+This resolves the redundant state checks of GLStateManager once at assembly time instead of every time the command buffer is executed.
+*/
+struct GLAssemblerState
+{
+    GLAssemblerState()
+    {
+        Invalidate();
+    }
+
+    // Resets all states to unknown.
+    void Invalidate()
+    {
+        pendingStatesFlushed    = false;
+        viewport                = nullptr;
+        scissor                 = nullptr;
+        vertexArray             = g_unknownGLName;
+        vertexBufferBindings    = nullptr;
+        drawIndirectBuffer      = g_unknownGLName;
+        dispatchIndirectBuffer  = g_unknownGLName;
+        activeTexture           = g_unknownGLName;
+        for (GLuint i = 0; i < g_numTrackedGLSlots; ++i)
+        {
+            textures[i] = nullptr;
+            samplers[i] = g_unknownGLName;
+        }
+    }
+
+    bool                            pendingStatesFlushed;
+    const GLCmdViewport*            viewport;
+    const GLCmdScissor*             scissor;
+    GLuint                          vertexArray;
+    const GLVertexBufferBindings*   vertexBufferBindings;
+    GLuint                          drawIndirectBuffer;
+    GLuint                          dispatchIndirectBuffer;
+    GLuint                          activeTexture;
+    const GLTexture*                textures[g_numTrackedGLSlots];
+    GLuint                          samplers[g_numTrackedGLSlots];
+};
+
+// Returns true if the specified opcode only modifies states that are either tracked by GLAssemblerState or independent of them.
+static bool IsGLOpcodeTrackedByAssembler(const GLOpcode opcode)
 {
-    /* Declare index of variadic argument of entry point */
-    static const JITVarArg g_stateMngrArg{ 0 };
+    switch (opcode)
+    {
+        case GLOpcodeViewport:
+        case GLOpcodeViewportArray:
+        case GLOpcodeScissor:
+        case GLOpcodeScissorArray:
+        case GLOpcodeBindVertexArray:
+        case GLOpcodeBindElementArrayBufferToVAO:
+        case GLOpcodeBindBufferBase:
+        case GLOpcodeBindBufferRange:
+        case GLOpcodeBindBuffersBase:
+        case GLOpcodeBeginTransformFeedback:
+        case GLOpcodeBeginTransformFeedbackNV:
+        case GLOpcodeEndTransformFeedback:
+        case GLOpcodeEndTransformFeedbackNV:
+        case GLOpcodeBindTransformFeedback:
+        case GLOpcodeSetUniforms:
+        case GLOpcodeBeginQuery:
+        case GLOpcodeEndQuery:
+        case GLOpcodeBeginConditionalRender:
+        case GLOpcodeEndConditionalRender:
+        case GLOpcodeDispatchCompute:
+        case GLOpcodeDispatchComputeIndirect:
+        case GLOpcodeBindTexture:
+        case GLOpcodeBindImageTexture:
+        case GLOpcodeBindSampler:
+        case GLOpcodePushDebugGroup:
+        case GLOpcodePopDebugGroup:
+            return true;
+        default:
+            return IsGLOpcodeDrawCommand(opcode);
+    }
+}
+
+// Generates a call to bind the specified indirect argument buffer unless it is statically known to be bound already.
+static void AssembleBindIndirectBuffer(GLBufferTarget target, GLuint buffer, GLuint& boundBuffer, JITCompiler& compiler)
+{
+    if (boundBuffer != buffer)
+    {
+        compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, target, buffer);
+        boundBuffer = buffer;
+    }
+}
+
+// Trampoline to the GL command interpreter, since ExecuteGLCommand() takes the state manager by reference.
+static void ExecuteGLCommandInterpreted(const GLOpcode opcode, const void* pc, GLStateManager* stateMngr)
+{
+    ExecuteGLCommand(opcode, pc, stateMngr);
+}
+
+// Generates a call to the GL command interpreter for commands that cannot be translated into native calls.
+static std::size_t AssembleGLCommandInterpreted(const GLOpcode opcode, const void* pc, std::size_t cmdSize, JITCompiler& compiler)
+{
+    compiler.Call(ExecuteGLCommandInterpreted, opcode, pc, g_stateMngrArg);
+    return cmdSize;
+}
+
+static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITCompiler& compiler, GLAssemblerState& state)
+{
+    /* Forget all statically known states if this command can modify states that are not tracked */
+    if (!IsGLOpcodeTrackedByAssembler(opcode))
+        state.Invalidate();
+
+    /* Bind deferred state objects right before each draw command, unless no state has changed since the previous draw command */
+    if (IsGLOpcodeDrawCommand(opcode) && !state.pendingStatesFlushed)
+    {
+        compiler.CallMember(&GLStateManager::FlushPendingStates, g_stateMngrArg);
+        state.pendingStatesFlushed = true;
+    }
 
     /* Generate native CPU opcodes for emulated GLOpcode */
     switch (opcode)
@@ -80,6 +203,12 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.CallMember(&GLBuffer::ClearBufferSubData, cmd->buffer, cmd->offset, cmd->size, cmd->data);
             return sizeof(*cmd);
         }
+        case GLOpcodeClearBufferPattern:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClearBufferPattern*>(pc);
+            compiler.CallMember(&GLBuffer::ClearBufferPattern, cmd->buffer, cmd->offset, cmd->size, static_cast<const void*>(cmd->pattern), cmd->patternSize);
+            return sizeof(*cmd);
+        }
         case GLOpcodeCopyImageSubData:
         {
             auto cmd = reinterpret_cast<const GLCmdCopyImageSubData*>(pc);
@@ -125,9 +254,11 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeViewport:
         {
             auto cmd = reinterpret_cast<const GLCmdViewport*>(pc);
+            if (state.viewport == nullptr || ::memcmp(state.viewport, cmd, sizeof(*cmd)) != 0)
             {
                 compiler.CallMember(&GLStateManager::SetViewport, g_stateMngrArg, &(cmd->viewport));
                 compiler.CallMember(&GLStateManager::SetDepthRange, g_stateMngrArg, &(cmd->depthRange));
+                state.viewport = cmd;
             }
             return sizeof(*cmd);
         }
@@ -138,14 +269,17 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             {
                 compiler.CallMember(&GLStateManager::SetViewportArray, g_stateMngrArg, cmd->first, cmd->count, cmdData);
                 compiler.CallMember(&GLStateManager::SetDepthRangeArray, g_stateMngrArg, cmd->first, cmd->count, (cmdData + sizeof(GLViewport)*cmd->count));
+                state.viewport = nullptr;
             }
             return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
         }
         case GLOpcodeScissor:
         {
             auto cmd = reinterpret_cast<const GLCmdScissor*>(pc);
+            if (state.scissor == nullptr || ::memcmp(state.scissor, cmd, sizeof(*cmd)) != 0)
             {
                 compiler.CallMember(&GLStateManager::SetScissor, g_stateMngrArg, &(cmd->scissor));
+                state.scissor = cmd;
             }
             return sizeof(*cmd);
         }
@@ -155,6 +289,7 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
             {
                 compiler.CallMember(&GLStateManager::SetScissorArray, g_stateMngrArg, cmd->first, cmd->count, cmdData);
+                state.scissor = nullptr;
             }
             return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
         }
@@ -185,19 +320,33 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeClearAttachmentsWithRenderPass:
         {
             auto cmd = reinterpret_cast<const GLCmdClearAttachmentsWithRenderPass*>(pc);
-            compiler.CallMember(&GLStateManager::ClearAttachmentsWithRenderPass, g_stateMngrArg, cmd->renderPass, cmd->numClearValues, (cmd + 1));
+            if (cmd->renderPass != nullptr)
+                compiler.CallMember(&GLStateManager::ClearAttachmentsWithRenderPass, g_stateMngrArg, cmd->renderPass, cmd->numClearValues, (cmd + 1));
             return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
         }
+        case GLOpcodeEndRenderPass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdEndRenderPass*>(pc);
+            compiler.CallMember(&GLStateManager::EndRenderPass, g_stateMngrArg, cmd->renderPass);
+            return sizeof(*cmd);
+        }
         case GLOpcodeClearBuffers:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
             compiler.CallMember(&GLStateManager::ClearBuffers, g_stateMngrArg, cmd->numAttachments, (cmd + 1));
-            return sizeof(*cmd);
+            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
         }
         case GLOpcodeBindVertexArray:
         {
             auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
-            compiler.CallMember(&GLStateManager::BindVertexArray, g_stateMngrArg, cmd->vao);
+            if (state.vertexArray != cmd->vao || state.vertexBufferBindings != cmd->bindings)
+            {
+                compiler.CallMember(&GLStateManager::BindVertexArray, g_stateMngrArg, cmd->vao);
+                if (const GLVertexBufferBindings* bindings = cmd->bindings)
+                    compiler.CallMember(&GLStateManager::BindVertexBuffers, g_stateMngrArg, GLuint(0), bindings->Count(), bindings->buffers.data(), bindings->offsets.data(), bindings->strides.data());
+                state.vertexArray           = cmd->vao;
+                state.vertexBufferBindings  = cmd->bindings;
+            }
             return sizeof(*cmd);
         }
         #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -220,6 +369,12 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.CallMember(&GLStateManager::BindBufferBase, g_stateMngrArg, cmd->target, cmd->index, cmd->id);
             return sizeof(*cmd);
         }
+        case GLOpcodeBindBufferRange:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBufferRange*>(pc);
+            compiler.CallMember(&GLStateManager::BindBufferRange, g_stateMngrArg, cmd->target, cmd->index, cmd->id, cmd->offset, cmd->size);
+            return sizeof(*cmd);
+        }
         case GLOpcodeBindBuffersBase:
         {
             auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
@@ -232,26 +387,34 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.Call(glBeginTransformFeedback, cmd->primitiveMove);
             return sizeof(*cmd);
         }
-        #ifdef GL_NV_transform_feedback
         case GLOpcodeBeginTransformFeedbackNV:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
+            #ifdef GL_NV_transform_feedback
             compiler.Call(glBeginTransformFeedbackNV, cmd->primitiveMove);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_NV_transform_feedback
         case GLOpcodeEndTransformFeedback:
         {
             compiler.Call(glEndTransformFeedback);
             return 0;
         }
-        #ifdef GL_NV_transform_feedback
         case GLOpcodeEndTransformFeedbackNV:
         {
+            #ifdef GL_NV_transform_feedback
             compiler.Call(glEndTransformFeedbackNV);
+            #endif
             return 0;
         }
-        #endif // /GL_NV_transform_feedback
+        case GLOpcodeBindTransformFeedback:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindTransformFeedback*>(pc);
+            #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+            compiler.Call(glBindTransformFeedback, GL_TRANSFORM_FEEDBACK, cmd->id);
+            #endif
+            return sizeof(*cmd);
+        }
         case GLOpcodeBindResourceHeap:
         {
             auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
@@ -267,12 +430,9 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         }
         case GLOpcodeBindPipelineState:
         {
+            /* GLPipelineState::Bind() is virtual, so it cannot be called via a raw member function pointer */
             auto cmd = reinterpret_cast<const GLCmdBindPipelineState*>(pc);
-            if (cmd->pipelineState->IsGraphicsPSO())
-                compiler.CallMember(&GLGraphicsPSO::Bind, cmd->pipelineState, g_stateMngrArg);
-            else
-                compiler.CallMember(&GLPipelineState::Bind, cmd->pipelineState, g_stateMngrArg);
-            return sizeof(*cmd);
+            return AssembleGLCommandInterpreted(opcode, pc, sizeof(*cmd), compiler);
         }
         case GLOpcodeSetBlendColor:
         {
@@ -292,6 +452,12 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.Call(GLSetUniformsByType, cmd->type, cmd->location, cmd->count, (cmd + 1));
             return (sizeof(*cmd) + cmd->size);
         }
+        case GLOpcodeSetUniformBlock:
+        {
+            /* GLPipelineState::SetUniformBlockData() takes the state manager by reference, so it cannot be called via the JIT argument list */
+            auto cmd = reinterpret_cast<const GLCmdSetUniformBlock*>(pc);
+            return AssembleGLCommandInterpreted(opcode, pc, sizeof(*cmd) + cmd->size, compiler);
+        }
         case GLOpcodeBeginQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
@@ -301,18 +467,22 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeEndQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdEndQuery*>(pc);
-            compiler.CallMember(&GLQueryHeap::End, cmd->queryHeap);
+            compiler.CallMember(&GLQueryHeap::End, cmd->queryHeap, cmd->query);
             return sizeof(*cmd);
         }
         case GLOpcodeBeginConditionalRender:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginConditionalRender*>(pc);
+            #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
             compiler.Call(glBeginConditionalRender, cmd->id, cmd->mode);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeEndConditionalRender:
         {
+            #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
             compiler.Call(glEndConditionalRender);
+            #endif
             return 0;
         }
         case GLOpcodeDrawArrays:
@@ -327,65 +497,80 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.Call(glDrawArraysInstanced, cmd->mode, cmd->first, cmd->count, cmd->instancecount);
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_base_instance
         case GLOpcodeDrawArraysInstancedBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
+            #ifdef LLGL_GLEXT_BASE_INSTANCE
             compiler.Call(glDrawArraysInstancedBaseInstance, cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_base_instance
         case GLOpcodeDrawArraysIndirect:
         {
             //TODO: generate loop in ASM
             auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
-            compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DrawIndirectBuffer, cmd->id);
+            #ifdef LLGL_GLEXT_DRAW_INDIRECT
+            AssembleBindIndirectBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id, state.drawIndirectBuffer, compiler);
             GLintptr offset = cmd->indirect;
             for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
             {
                 compiler.Call(glDrawArraysIndirect, cmd->mode, reinterpret_cast<const GLvoid*>(offset));
                 offset += cmd->stride;
             }
+            #endif
+            return sizeof(*cmd);
+        }
+        case GLOpcodeDrawTransformFeedback:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawTransformFeedback*>(pc);
+            #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+            compiler.Call(glDrawTransformFeedback, cmd->mode, cmd->id);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElements:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
-            compiler.Call(glDrawElements, cmd->mode, cmd->count, cmd->type, cmd->indices);
+            compiler.Call(glDrawElements, static_cast<GLenum>(cmd->mode), cmd->count, static_cast<GLenum>(cmd->type), cmd->indices);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
-            compiler.Call(glDrawElementsBaseVertex, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
+            #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+            compiler.Call(glDrawElementsBaseVertex, static_cast<GLenum>(cmd->mode), cmd->count, static_cast<GLenum>(cmd->type), cmd->indices, cmd->basevertex);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
-            compiler.Call(glDrawElementsInstanced, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
+            compiler.Call(glDrawElementsInstanced, static_cast<GLenum>(cmd->mode), cmd->count, static_cast<GLenum>(cmd->type), cmd->indices, cmd->instancecount);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstancedBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
-            compiler.Call(glDrawElementsInstancedBaseVertex, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
+            #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+            compiler.Call(glDrawElementsInstancedBaseVertex, static_cast<GLenum>(cmd->mode), cmd->count, static_cast<GLenum>(cmd->type), cmd->indices, cmd->instancecount, cmd->basevertex);
+            #endif
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_base_instance
         case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
-            compiler.Call(glDrawElementsInstancedBaseVertexBaseInstance, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+            #ifdef LLGL_GLEXT_BASE_INSTANCE
+            compiler.Call(glDrawElementsInstancedBaseVertexBaseInstance, static_cast<GLenum>(cmd->mode), cmd->count, static_cast<GLenum>(cmd->type), cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_base_instance
         case GLOpcodeDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
+            #ifdef LLGL_GLEXT_DRAW_INDIRECT
             {
                 //TODO: generate loop in ASM
-                compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DrawIndirectBuffer, cmd->id);
+                AssembleBindIndirectBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id, state.drawIndirectBuffer, compiler);
                 GLintptr offset = cmd->indirect;
                 for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
                 {
@@ -393,44 +578,67 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
                     offset += cmd->stride;
                 }
             }
+            #endif
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_multi_draw_indirect
         case GLOpcodeMultiDrawArraysIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
-            compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DrawIndirectBuffer, cmd->id);
+            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+            AssembleBindIndirectBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id, state.drawIndirectBuffer, compiler);
             compiler.Call(glMultiDrawArraysIndirect, cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeMultiDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
-            compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DrawIndirectBuffer, cmd->id);
+            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+            AssembleBindIndirectBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id, state.drawIndirectBuffer, compiler);
             compiler.Call(glMultiDrawElementsIndirect, cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_multi_draw_indirect
-        #ifdef GL_ARB_compute_shader
         case GLOpcodeDispatchCompute:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
+            #ifdef LLGL_GLEXT_COMPUTE_SHADER
             compiler.Call(glDispatchCompute, cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
+            compiler.CallMember(&GLStateManager::NotifyComputeDispatch, g_stateMngrArg);
+            #endif
+
+            /* Indirect buffers must be rebound to insert the command barrier for the shader writes of this dispatch */
+            state.drawIndirectBuffer        = g_unknownGLName;
+            state.dispatchIndirectBuffer    = g_unknownGLName;
             return sizeof(*cmd);
         }
         case GLOpcodeDispatchComputeIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
-            compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DispatchIndirectBuffer, cmd->id);
+            #ifdef LLGL_GLEXT_COMPUTE_SHADER
+            AssembleBindIndirectBuffer(GLBufferTarget::DispatchIndirectBuffer, cmd->id, state.dispatchIndirectBuffer, compiler);
             compiler.Call(glDispatchComputeIndirect, cmd->indirect);
+            compiler.CallMember(&GLStateManager::NotifyComputeDispatch, g_stateMngrArg);
+            #endif
+
+            /* Indirect buffers must be rebound to insert the command barrier for the shader writes of this dispatch */
+            state.drawIndirectBuffer        = g_unknownGLName;
+            state.dispatchIndirectBuffer    = g_unknownGLName;
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_compute_shader
         case GLOpcodeBindTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
-            compiler.CallMember(&GLStateManager::ActiveTexture, g_stateMngrArg, cmd->slot);
+            if (cmd->slot < g_numTrackedGLSlots && state.textures[cmd->slot] == cmd->texture)
+                return sizeof(*cmd);
+            if (state.activeTexture != cmd->slot)
+            {
+                compiler.CallMember(&GLStateManager::ActiveTexture, g_stateMngrArg, cmd->slot);
+                state.activeTexture = cmd->slot;
+            }
             compiler.CallMember(&GLStateManager::BindGLTexture, g_stateMngrArg, cmd->texture);
+            if (cmd->slot < g_numTrackedGLSlots)
+                state.textures[cmd->slot] = cmd->texture;
             return sizeof(*cmd);
         }
         case GLOpcodeBindImageTexture:
@@ -442,6 +650,12 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeBindSampler:
         {
             auto cmd = reinterpret_cast<const GLCmdBindSampler*>(pc);
+            if (cmd->layer < g_numTrackedGLSlots)
+            {
+                if (state.samplers[cmd->layer] == cmd->sampler)
+                    return sizeof(*cmd);
+                state.samplers[cmd->layer] = cmd->sampler;
+            }
             compiler.CallMember(&GLStateManager::BindSampler, g_stateMngrArg, cmd->layer, cmd->sampler);
             return sizeof(*cmd);
         }
@@ -470,21 +684,23 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
                 compiler.CallMember(&GLStateManager::UnbindSamplers, g_stateMngrArg, cmd->first, cmd->count);
             return sizeof(*cmd);
         }
-        #ifdef GL_KHR_debug
         case GLOpcodePushDebugGroup:
         {
             auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+            #ifdef LLGL_GLEXT_DEBUG
             compiler.Call(glPushDebugGroup, cmd->source, cmd->id, cmd->length, reinterpret_cast<const GLchar*>(cmd + 1));
+            #endif
             return (sizeof(*cmd) + cmd->length + 1);
         }
         case GLOpcodePopDebugGroup:
         {
+            #ifdef LLGL_GLEXT_DEBUG
             compiler.Call(glPopDebugGroup);
+            #endif
             return 0;
         }
-        #endif // /GL_KHR_debug
         default:
-            return 0;
+            return g_invalidGLCommandSize;
     }
 }
 
@@ -519,6 +735,9 @@ std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredComm
         /* Initialize program counter to execute virtual GL commands */
         const auto& virtualCmdBuffer = cmdBuffer.GetVirtualCommandBuffer();
 
+        /* Track statically known states across all commands to omit redundant state changes */
+        GLAssemblerState state;
+
         for (const auto& chunk : virtualCmdBuffer)
         {
             auto pc     = chunk.data;
@@ -528,10 +747,13 @@ std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredComm
             {
                 /* Read opcode */
                 const GLOpcode opcode = *reinterpret_cast<const GLOpcode*>(pc);
-                pc += sizeof(GLOpcode);
+                pc += GLVirtualCommandBuffer::OpcodeSize();
 
-                /* Execute command and increment program counter */
-                pc += AssembleGLCommand(opcode, pc, *compiler);
+                /* Assemble command and increment program counter; fall back to the interpreter for the entire command buffer on unknown opcodes */
+                const std::size_t cmdSize = AssembleGLCommand(opcode, pc, *compiler, state);
+                if (cmdSize == g_invalidGLCommandSize)
+                    return nullptr;
+                pc += GLVirtualCommandBuffer::AlignSize(cmdSize);
             }
         }
 
@@ -11,6 +11,7 @@
 #include "../RenderState/GLPipelineState.h"
 #include "../RenderState/GLGraphicsPSO.h"
 #include "../../CheckedCast.h"
+#include "../../FrameCounters.h"
 
 
 namespace LLGL
@@ -21,6 +22,7 @@ void GLCommandBuffer::ResetRenderState()
 {
     renderState_.boundPipelineLayout    = nullptr;
     renderState_.boundPipelineState     = nullptr;
+    renderState_.boundRenderPass        = nullptr;
 }
 
 void GLCommandBuffer::SetIndexFormat(bool indexType16Bits, std::uint64_t offset)
@@ -51,7 +53,10 @@ void GLCommandBuffer::SetPipelineRenderState(const GLPipelineState& pipelineStat
         auto& graphicsPSO = LLGL_CAST(const GLGraphicsPSO&, pipelineStateGL);
         renderState_.drawMode       = graphicsPSO.GetDrawMode();
         renderState_.primitiveMode  = graphicsPSO.GetPrimitiveMode();
+        LLGL_FRAME_COUNTER_INC(graphicsPipelineBindings);
     }
+    else
+        LLGL_FRAME_COUNTER_INC(computePipelineBindings);
 }
 
 /* ----- Extensions ----- */
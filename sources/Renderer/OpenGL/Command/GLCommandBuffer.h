@@ -10,6 +10,7 @@
 
 
 #include <LLGL/CommandBuffer.h>
+#include <LLGL/RenderingProfiler.h>
 #include "../OpenGL.h"
 #include "../RenderState/GLPipelineState.h"
 #include "../RenderState/GLState.h"
@@ -33,6 +34,12 @@ class GLCommandBuffer : public CommandBuffer
         // Returns true if this is an immediate command buffer, otherwise it is a deferred command buffer.
         virtual bool IsImmediateCmdBuffer() const = 0;
 
+        // Returns the frame counters of the current encoding. See LLGL_ENABLE_FRAME_COUNTERS.
+        inline const FrameProfile& GetFrameCounters() const
+        {
+            return frameCounters_;
+        }
+
     protected:
 
         // Resets the internal render state of this command buffer.
@@ -44,6 +51,18 @@ class GLCommandBuffer : public CommandBuffer
         // Stores the render states for the specified PSO: Draw mode, primitive mode, binding layout.
         void SetPipelineRenderState(const GLPipelineState& pipelineStateGL);
 
+        // Stores the transform feedback object of the vertex buffer in slot 0 for DrawStreamOutput. This may be 0.
+        inline void SetVertexTransformFeedbackRenderState(GLuint transformFeedbackID)
+        {
+            renderState_.vertexTransformFeedback = transformFeedbackID;
+        }
+
+        // Stores the render pass of the current BeginRenderPass/EndRenderPass section. This may be null.
+        inline void SetRenderPassRenderState(const GLRenderPass* renderPassGL)
+        {
+            renderState_.boundRenderPass = renderPassGL;
+        }
+
     protected:
 
         // Returns the current render state.
@@ -77,12 +96,24 @@ class GLCommandBuffer : public CommandBuffer
             return reinterpret_cast<const GLvoid*>(indices);
         }
 
+        // Returns the transform feedback object for the glDrawTransformFeedback command.
+        inline GLuint GetVertexTransformFeedback() const
+        {
+            return renderState_.vertexTransformFeedback;
+        }
+
         // Returns the currently bound pipeline layout.
         inline const GLPipelineLayout* GetBoundPipelineLayout() const
         {
             return renderState_.boundPipelineLayout;
         }
 
+        // Returns the render pass of the current BeginRenderPass/EndRenderPass section or null if there is none.
+        inline const GLRenderPass* GetBoundRenderPass() const
+        {
+            return renderState_.boundRenderPass;
+        }
+
         // Returns the currently bound pipeline state.
         inline const GLPipelineState* GetBoundPipelineState() const
         {
@@ -96,9 +127,13 @@ class GLCommandBuffer : public CommandBuffer
             return (pipelineState != nullptr ? pipelineState->GetShaderPipeline() : nullptr);
         }
 
+    protected:
+
+        FrameProfile    frameCounters_;
+
     private:
 
-        GLRenderState renderState_;
+        GLRenderState   renderState_;
 
 };
 
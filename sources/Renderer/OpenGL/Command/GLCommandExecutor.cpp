@@ -50,8 +50,12 @@ namespace LLGL
 {
 
 
-static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager*& stateMngr)
+std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager*& stateMngr)
 {
+    /* Bind deferred state objects right before each draw command */
+    if (IsGLOpcodeDrawCommand(opcode))
+        stateMngr->FlushPendingStates();
+
     switch (opcode)
     {
         case GLOpcodeBufferSubData:
@@ -78,6 +82,12 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             cmd->buffer->ClearBufferSubData(cmd->offset, cmd->size, cmd->data);
             return sizeof(*cmd);
         }
+        case GLOpcodeClearBufferPattern:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClearBufferPattern*>(pc);
+            cmd->buffer->ClearBufferPattern(cmd->offset, cmd->size, cmd->pattern, cmd->patternSize);
+            return sizeof(*cmd);
+        }
         case GLOpcodeCopyImageSubData:
         {
             auto cmd = reinterpret_cast<const GLCmdCopyImageSubData*>(pc);
@@ -187,6 +197,12 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 stateMngr->ClearAttachmentsWithRenderPass(*(cmd->renderPass), cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1));
             return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
         }
+        case GLOpcodeEndRenderPass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdEndRenderPass*>(pc);
+            stateMngr->EndRenderPass(cmd->renderPass);
+            return sizeof(*cmd);
+        }
         case GLOpcodeClearBuffers:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
@@ -197,6 +213,8 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
         {
             auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
             stateMngr->BindVertexArray(cmd->vao);
+            if (const GLVertexBufferBindings* bindings = cmd->bindings)
+                stateMngr->BindVertexBuffers(0, bindings->Count(), bindings->buffers.data(), bindings->offsets.data(), bindings->strides.data());
             return sizeof(*cmd);
         }
         #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -219,6 +237,12 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             stateMngr->BindBufferBase(cmd->target, cmd->index, cmd->id);
             return sizeof(*cmd);
         }
+        case GLOpcodeBindBufferRange:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBufferRange*>(pc);
+            stateMngr->BindBufferRange(cmd->target, cmd->index, cmd->id, cmd->offset, cmd->size);
+            return sizeof(*cmd);
+        }
         case GLOpcodeBindBuffersBase:
         {
             auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
@@ -251,6 +275,14 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #endif
             return 0;
         }
+        case GLOpcodeBindTransformFeedback:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindTransformFeedback*>(pc);
+            #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+            glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, cmd->id);
+            #endif
+            return sizeof(*cmd);
+        }
         case GLOpcodeBindResourceHeap:
         {
             auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
@@ -289,6 +321,12 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             GLSetUniformsByType(cmd->type, cmd->location, cmd->count, (cmd + 1));
             return (sizeof(*cmd) + cmd->size);
         }
+        case GLOpcodeSetUniformBlock:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetUniformBlock*>(pc);
+            cmd->pipelineState->SetUniformBlockData(*stateMngr, cmd->first, (cmd + 1), cmd->size);
+            return (sizeof(*cmd) + cmd->size);
+        }
         case GLOpcodeBeginQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
@@ -298,7 +336,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
         case GLOpcodeEndQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdEndQuery*>(pc);
-            cmd->queryHeap->End();
+            cmd->queryHeap->End(cmd->query);
             return sizeof(*cmd);
         }
         case GLOpcodeBeginConditionalRender:
@@ -350,6 +388,14 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #endif
             return sizeof(*cmd);
         }
+        case GLOpcodeDrawTransformFeedback:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawTransformFeedback*>(pc);
+            #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+            glDrawTransformFeedback(cmd->mode, cmd->id);
+            #endif
+            return sizeof(*cmd);
+        }
         case GLOpcodeDrawElements:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
@@ -423,6 +469,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
             #ifdef LLGL_GLEXT_COMPUTE_SHADER
             glDispatchCompute(cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
+            stateMngr->NotifyComputeDispatch();
             #endif
             return sizeof(*cmd);
         }
@@ -432,6 +479,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef LLGL_GLEXT_COMPUTE_SHADER
             stateMngr->BindBuffer(GLBufferTarget::DispatchIndirectBuffer, cmd->id);
             glDispatchComputeIndirect(cmd->indirect);
+            stateMngr->NotifyComputeDispatch();
             #endif
             return sizeof(*cmd);
         }
@@ -511,10 +559,10 @@ static void ExecuteGLCommandsEmulated(const GLVirtualCommandBuffer& virtualCmdBu
         {
             /* Read opcode */
             const GLOpcode opcode = *reinterpret_cast<const GLOpcode*>(pc);
-            pc += sizeof(GLOpcode);
+            pc += GLVirtualCommandBuffer::OpcodeSize();
 
             /* Execute command and increment program counter */
-            pc += ExecuteGLCommand(opcode, pc, stateMngr);
+            pc += GLVirtualCommandBuffer::AlignSize(ExecuteGLCommand(opcode, pc, stateMngr));
         }
     }
 }
@@ -531,6 +579,14 @@ static void ExecuteGLCommandsNatively(const JITProgram& exec, GLStateManager& st
 
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
 {
+    #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+    if (auto cmdList = cmdBuffer.GetCommandListNV().get())
+    {
+        /* Submit tokens of NV command list */
+        cmdList->Execute(stateMngr);
+    }
+    else
+    #endif // /LLGL_GLEXT_COMMAND_LIST_NV
     #ifdef LLGL_ENABLE_JIT_COMPILER
     if (auto exec = cmdBuffer.GetExecutable().get())
     {
@@ -0,0 +1,840 @@
+/*
+ * GLCommandListNV.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GLCommandListNV.h"
+
+#ifdef LLGL_GLEXT_COMMAND_LIST_NV
+
+#include "GLDeferredCommandBuffer.h"
+#include "GLCommand.h"
+#include "GLCommandExecutor.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Buffer/GLVertexArrayCache.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Token layouts as specified by GL_NV_command_list.
+struct GLElementAddressCommandNV
+{
+    GLuint      header;
+    GLuint      addressLo;
+    GLuint      addressHi;
+    GLuint      typeSizeInByte;
+};
+
+struct GLAttributeAddressCommandNV
+{
+    GLuint      header;
+    GLuint      index;
+    GLuint      addressLo;
+    GLuint      addressHi;
+};
+
+struct GLUniformAddressCommandNV
+{
+    GLuint      header;
+    GLushort    index;
+    GLushort    stage;
+    GLuint      addressLo;
+    GLuint      addressHi;
+};
+
+struct GLDrawElementsInstancedCommandNV
+{
+    GLuint      header;
+    GLuint      mode;
+    GLuint      count;
+    GLuint      instanceCount;
+    GLuint      firstIndex;
+    GLint       baseVertex;
+    GLuint      baseInstance;
+};
+
+struct GLDrawArraysInstancedCommandNV
+{
+    GLuint      header;
+    GLuint      mode;
+    GLuint      count;
+    GLuint      instanceCount;
+    GLuint      first;
+    GLuint      baseInstance;
+};
+
+// Command size that denotes a command that cannot be compiled into a command list.
+static constexpr std::size_t g_incompatibleGLCommandSize = ~static_cast<std::size_t>(0);
+
+// Graphics shader stages that can read uniform buffers; compute shaders are never invoked by command lists.
+static const GLenum g_uniformBufferStagesNV[] =
+{
+    GL_VERTEX_SHADER,
+    GL_TESS_CONTROL_SHADER,
+    GL_TESS_EVALUATION_SHADER,
+    GL_GEOMETRY_SHADER,
+    GL_FRAGMENT_SHADER,
+};
+
+// Makes the specified buffer resident for read access and returns its GPU address.
+static GLuint64EXT GetResidentBufferAddressNV(GLuint buffer)
+{
+    if (buffer == 0)
+        return 0;
+    if (!glIsNamedBufferResidentNV(buffer))
+        glMakeNamedBufferResidentNV(buffer, GL_READ_ONLY);
+    GLuint64EXT address = 0;
+    glGetNamedBufferParameterui64vNV(buffer, GL_BUFFER_GPU_ADDRESS_NV, &address);
+    return address;
+}
+
+// Returns the size (in bytes) of the specified GL index type.
+static GLuint GetGLIndexTypeSize(GLenum type)
+{
+    switch (type)
+    {
+        case GL_UNSIGNED_BYTE:  return 1;
+        case GL_UNSIGNED_SHORT: return 2;
+        default:                return 4;
+    }
+}
+
+// Translates the commands of a deferred command buffer into tokens and regular commands of a GLCommandListNV.
+class GLCommandListCompilerNV
+{
+
+    public:
+
+        GLCommandListCompilerNV(GLCommandListNV& cmdList, const GLDeferredCommandBuffer& cmdBuffer);
+
+        // Compiles the specified command and returns its size, or g_incompatibleGLCommandSize if the command cannot be part of a command list.
+        std::size_t CompileCommand(const GLOpcode opcode, const void* pc);
+
+        // Closes the last segment and uploads all tokens into the token buffer. Returns false if the command list contains no draw commands.
+        bool Finish();
+
+    private:
+
+        void CloseSegment();
+        void AddRegularCommand(const GLOpcode opcode, const void* pc);
+        bool AddUniformBufferCommand(const GLOpcode opcode, const void* pc);
+
+        bool BindVertexArray(const GLCmdBindVertexArray& cmd);
+        void BindElementArrayBuffer(const GLOpcode opcode, const GLCmdBindElementArrayBufferToVAO& cmd);
+        void BindUniformBuffer(GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+        bool BeginDraw(GLenum type);
+        bool DrawArrays(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount, GLuint baseInstance);
+        bool DrawElements(GLenum mode, GLenum type, const GLvoid* indices, GLsizei count, GLsizei instanceCount, GLint baseVertex, GLuint baseInstance);
+        bool MultiDrawIndirect(bool indexed, GLuint id, GLenum mode, GLenum type, const GLvoid* indirect, GLsizei drawCount, GLsizei stride);
+
+        void WriteVertexAttribTokens();
+        void WriteUniformAddressTokens(GLuint index, GLuint buffer, GLintptr offset);
+
+        template <typename TToken>
+        void WriteToken(const TToken& token);
+
+    private:
+
+        GLCommandListNV&                cmdList_;
+        const GLDeferredCommandBuffer&  cmdBuffer_;
+
+        std::vector<char>               tokens_;
+        GLCommandListNV::Segment        segment_;
+        bool                            segmentHasDraws_        = false;
+        bool                            hasDraws_               = false;
+
+        GLuint                          vertexArray_            = 0;
+        const GLVertexBufferBindings*   bindings_               = nullptr;
+        bool                            hasIndexType_           = false;
+        GLuint                          elementTypeSize_        = 0;    // Type size of the element address token in the current segment, or 0 if not written yet
+
+        GLushort                        stages_[sizeof(g_uniformBufferStagesNV)/sizeof(GLenum)];
+        GLuint                          elementAddressHeader_   = 0;
+        GLuint                          attribAddressHeader_    = 0;
+        GLuint                          uniformAddressHeader_   = 0;
+        GLuint                          drawElementsHeader_     = 0;
+        GLuint                          drawArraysHeader_       = 0;
+
+};
+
+GLCommandListCompilerNV::GLCommandListCompilerNV(GLCommandListNV& cmdList, const GLDeferredCommandBuffer& cmdBuffer) :
+    cmdList_   { cmdList   },
+    cmdBuffer_ { cmdBuffer }
+{
+    /* Query token headers and stage indices once as they are constant for the current context */
+    elementAddressHeader_   = glGetCommandHeaderNV(GL_ELEMENT_ADDRESS_COMMAND_NV, sizeof(GLElementAddressCommandNV));
+    attribAddressHeader_    = glGetCommandHeaderNV(GL_ATTRIBUTE_ADDRESS_COMMAND_NV, sizeof(GLAttributeAddressCommandNV));
+    uniformAddressHeader_   = glGetCommandHeaderNV(GL_UNIFORM_ADDRESS_COMMAND_NV, sizeof(GLUniformAddressCommandNV));
+    drawElementsHeader_     = glGetCommandHeaderNV(GL_DRAW_ELEMENTS_INSTANCED_COMMAND_NV, sizeof(GLDrawElementsInstancedCommandNV));
+    drawArraysHeader_       = glGetCommandHeaderNV(GL_DRAW_ARRAYS_INSTANCED_COMMAND_NV, sizeof(GLDrawArraysInstancedCommandNV));
+
+    for_range(i, sizeof(g_uniformBufferStagesNV)/sizeof(GLenum))
+        stages_[i] = glGetStageIndexNV(g_uniformBufferStagesNV[i]);
+
+    /* Uniform buffers bound outside of this command list must be visible to the first draw */
+    segment_.seedUniformBuffers = true;
+}
+
+std::size_t GLCommandListCompilerNV::CompileCommand(const GLOpcode opcode, const void* pc)
+{
+    switch (opcode)
+    {
+        case GLOpcodeViewport:
+        {
+            AddRegularCommand(opcode, pc);
+            return sizeof(GLCmdViewport);
+        }
+        case GLOpcodeViewportArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
+            AddRegularCommand(opcode, pc);
+            return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
+        }
+        case GLOpcodeScissor:
+        {
+            AddRegularCommand(opcode, pc);
+            return sizeof(GLCmdScissor);
+        }
+        case GLOpcodeScissorArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
+            AddRegularCommand(opcode, pc);
+            return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
+        }
+        case GLOpcodeBindVertexArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
+            if (!BindVertexArray(*cmd))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeBindElementArrayBufferToVAO:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
+            BindElementArrayBuffer(opcode, *cmd);
+            return sizeof(*cmd);
+        }
+        case GLOpcodeBindBufferBase:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(pc);
+            if (cmd->target == GLBufferTarget::UniformBuffer)
+                BindUniformBuffer(cmd->index, cmd->id, 0, 0);
+            else
+                AddRegularCommand(opcode, pc);
+            return sizeof(*cmd);
+        }
+        case GLOpcodeBindBufferRange:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBufferRange*>(pc);
+            if (cmd->target == GLBufferTarget::UniformBuffer)
+                BindUniformBuffer(cmd->index, cmd->id, cmd->offset, cmd->size);
+            else
+                AddRegularCommand(opcode, pc);
+            return sizeof(*cmd);
+        }
+        case GLOpcodeBindBuffersBase:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
+            if (cmd->target == GLBufferTarget::UniformBuffer)
+            {
+                auto buffers = reinterpret_cast<const GLuint*>(cmd + 1);
+                for_range(i, cmd->count)
+                    BindUniformBuffer(cmd->first + i, buffers[i], 0, 0);
+            }
+            else
+                AddRegularCommand(opcode, pc);
+            return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
+        }
+        case GLOpcodeBindResourceHeap:
+        {
+            if (!AddUniformBufferCommand(opcode, pc))
+                return g_incompatibleGLCommandSize;
+            return sizeof(GLCmdBindResourceHeap);
+        }
+        case GLOpcodeBindPipelineState:
+        {
+            AddRegularCommand(opcode, pc);
+            return sizeof(GLCmdBindPipelineState);
+        }
+        case GLOpcodeSetBlendColor:
+        {
+            AddRegularCommand(opcode, pc);
+            return sizeof(GLCmdSetBlendColor);
+        }
+        case GLOpcodeSetStencilRef:
+        {
+            AddRegularCommand(opcode, pc);
+            return sizeof(GLCmdSetStencilRef);
+        }
+        case GLOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(pc);
+            AddRegularCommand(opcode, pc);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case GLOpcodeSetUniformBlock:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetUniformBlock*>(pc);
+            if (!AddUniformBufferCommand(opcode, pc))
+                return g_incompatibleGLCommandSize;
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case GLOpcodeDrawArrays:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
+            if (!DrawArrays(cmd->mode, cmd->first, cmd->count, 1, 0))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeDrawArraysInstanced:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
+            if (!DrawArrays(cmd->mode, cmd->first, cmd->count, cmd->instancecount, 0))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeDrawArraysInstancedBaseInstance:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
+            if (!DrawArrays(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeDrawElements:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
+            if (!DrawElements(cmd->mode, cmd->type, cmd->indices, cmd->count, 1, 0, 0))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
+            if (!DrawElements(cmd->mode, cmd->type, cmd->indices, cmd->count, 1, cmd->basevertex, 0))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeDrawElementsInstanced:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
+            if (!DrawElements(cmd->mode, cmd->type, cmd->indices, cmd->count, cmd->instancecount, 0, 0))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
+            if (!DrawElements(cmd->mode, cmd->type, cmd->indices, cmd->count, cmd->instancecount, cmd->basevertex, 0))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
+            if (!DrawElements(cmd->mode, cmd->type, cmd->indices, cmd->count, cmd->instancecount, cmd->basevertex, cmd->baseinstance))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeMultiDrawArraysIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
+            if (!MultiDrawIndirect(false, cmd->id, cmd->mode, 0, cmd->indirect, cmd->drawcount, cmd->stride))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeMultiDrawElementsIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
+            if (!MultiDrawIndirect(true, cmd->id, cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride))
+                return g_incompatibleGLCommandSize;
+            return sizeof(*cmd);
+        }
+        case GLOpcodeBindTexture:
+        {
+            AddRegularCommand(opcode, pc);
+            return sizeof(GLCmdBindTexture);
+        }
+        case GLOpcodeBindImageTexture:
+        {
+            AddRegularCommand(opcode, pc);
+            return sizeof(GLCmdBindImageTexture);
+        }
+        case GLOpcodeBindSampler:
+        {
+            AddRegularCommand(opcode, pc);
+            return sizeof(GLCmdBindSampler);
+        }
+        case GLOpcodeUnbindResources:
+        {
+            auto cmd = reinterpret_cast<const GLCmdUnbindResources*>(pc);
+            if (cmd->resetUBO)
+            {
+                if (!AddUniformBufferCommand(opcode, pc))
+                    return g_incompatibleGLCommandSize;
+            }
+            else
+                AddRegularCommand(opcode, pc);
+            return sizeof(*cmd);
+        }
+        case GLOpcodePushDebugGroup:
+        {
+            auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+            AddRegularCommand(opcode, pc);
+            return (sizeof(*cmd) + cmd->length + 1);
+        }
+        case GLOpcodePopDebugGroup:
+        {
+            AddRegularCommand(opcode, pc);
+            return 0;
+        }
+        default:
+        {
+            /* Render target switches, queries, compute dispatches, and draws with arbitrary indirect buffers are not supported by command lists */
+            return g_incompatibleGLCommandSize;
+        }
+    }
+}
+
+bool GLCommandListCompilerNV::Finish()
+{
+    CloseSegment();
+
+    if (!hasDraws_)
+        return false;
+
+    /* Upload tokens into token buffer */
+    GLStateManager& stateMngr = GLStateManager::Get();
+    glGenBuffers(1, &cmdList_.tokenBuffer_);
+    stateMngr.BindBuffer(GLBufferTarget::CopyWriteBuffer, cmdList_.tokenBuffer_);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(tokens_.size()), tokens_.data(), GL_STATIC_DRAW);
+
+    /* Uniform buffers bound with glBindBufferBase are passed to unified memory with the maximum range a uniform block can read */
+    GLint maxUniformBlockSize = 0;
+    glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &maxUniformBlockSize);
+    cmdList_.maxUniformBlockSize_ = static_cast<GLsizeiptr>(maxUniformBlockSize);
+
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLCommandListCompilerNV::CloseSegment()
+{
+    segment_.vertexArray    = vertexArray_;
+    segment_.bindings       = bindings_;
+    segment_.tokenSize      = static_cast<GLsizei>(static_cast<GLintptr>(tokens_.size()) - segment_.tokenOffset);
+
+    if (segment_.numCommands > 0 || segment_.tokenSize > 0)
+        cmdList_.segments_.push_back(segment_);
+
+    /* Start next segment */
+    segment_ = GLCommandListNV::Segment{};
+    {
+        segment_.firstCommand   = cmdList_.commands_.size();
+        segment_.tokenOffset    = static_cast<GLintptr>(tokens_.size());
+    }
+    segmentHasDraws_    = false;
+    elementTypeSize_    = 0;
+}
+
+void GLCommandListCompilerNV::AddRegularCommand(const GLOpcode opcode, const void* pc)
+{
+    /* Regular commands must be executed before the tokens of a segment, so draws that have already been written end the current segment */
+    if (segmentHasDraws_)
+        CloseSegment();
+    cmdList_.commands_.push_back(GLCommandListNV::Command{ opcode, pc });
+    segment_.numCommands++;
+}
+
+bool GLCommandListCompilerNV::AddUniformBufferCommand(const GLOpcode opcode, const void* pc)
+{
+    /*
+    Regular uniform buffer bindings are only tracked by the state manager and not by the tokens of this command list,
+    so they cannot be reconciled with uniform buffers that have already been bound by tokens.
+    */
+    if (!cmdList_.finalUniformBuffers_.empty())
+        return false;
+    AddRegularCommand(opcode, pc);
+    segment_.seedUniformBuffers = true;
+    return true;
+}
+
+bool GLCommandListCompilerNV::BindVertexArray(const GLCmdBindVertexArray& cmd)
+{
+    /* Vertex buffers can only be bound by their GPU address if the VAO uses separate vertex buffer bindings */
+    if (cmd.bindings == nullptr)
+        return false;
+
+    /* Attribute address tokens persist for all draws in a segment, so each vertex array starts a new segment */
+    if (segmentHasDraws_)
+        CloseSegment();
+
+    vertexArray_    = cmd.vao;
+    bindings_       = cmd.bindings;
+    return true;
+}
+
+void GLCommandListCompilerNV::BindElementArrayBuffer(const GLOpcode opcode, const GLCmdBindElementArrayBufferToVAO& cmd)
+{
+    #ifdef LLGL_PRIMITIVE_RESTART
+    /* Primitive restart index depends on the index type and is not part of the element address token */
+    if (!hasIndexType_ || cmdList_.finalIndexType16Bits_ != cmd.indexType16Bits)
+        AddRegularCommand(opcode, &cmd);
+    #endif
+
+    cmdList_.finalElementBuffer_    = cmd.id;
+    cmdList_.finalIndexType16Bits_  = cmd.indexType16Bits;
+    hasIndexType_                   = true;
+
+    /* Write element address token with the next indexed draw */
+    elementTypeSize_ = 0;
+}
+
+void GLCommandListCompilerNV::BindUniformBuffer(GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    /* Store binding to restore it after the command list and to write it at the beginning of each segment */
+    auto& bindings = cmdList_.finalUniformBuffers_;
+    auto it = std::find_if(
+        bindings.begin(), bindings.end(),
+        [index](const GLCommandListNV::UniformBufferBinding& entry)
+        {
+            return (entry.index == index);
+        }
+    );
+    if (it != bindings.end())
+    {
+        it->buffer  = buffer;
+        it->offset  = offset;
+        it->size    = size;
+    }
+    else
+        bindings.push_back(GLCommandListNV::UniformBufferBinding{ index, buffer, offset, size });
+
+    /* Bindings before the first draw of a segment are written when the segment begins */
+    if (segmentHasDraws_)
+        WriteUniformAddressTokens(index, buffer, offset);
+}
+
+bool GLCommandListCompilerNV::BeginDraw(GLenum type)
+{
+    if (bindings_ == nullptr)
+        return false;
+
+    if (!segmentHasDraws_)
+    {
+        /* Write all addresses that are bound by this command list at the beginning of each segment */
+        WriteVertexAttribTokens();
+        for (const auto& binding : cmdList_.finalUniformBuffers_)
+            WriteUniformAddressTokens(binding.index, binding.buffer, binding.offset);
+        segmentHasDraws_    = true;
+        hasDraws_           = true;
+    }
+
+    if (type != 0)
+    {
+        /* Indexed draws require an index buffer that is bound within this command list */
+        if (cmdList_.finalElementBuffer_ == 0)
+            return false;
+
+        const GLuint typeSize = GetGLIndexTypeSize(type);
+        if (elementTypeSize_ != typeSize)
+        {
+            const GLuint64EXT address = GetResidentBufferAddressNV(cmdList_.finalElementBuffer_);
+            GLElementAddressCommandNV token;
+            {
+                token.header            = elementAddressHeader_;
+                token.addressLo         = static_cast<GLuint>(address & 0xFFFFFFFFull);
+                token.addressHi         = static_cast<GLuint>(address >> 32);
+                token.typeSizeInByte    = typeSize;
+            }
+            WriteToken(token);
+            elementTypeSize_ = typeSize;
+        }
+    }
+
+    return true;
+}
+
+bool GLCommandListCompilerNV::DrawArrays(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount, GLuint baseInstance)
+{
+    if (!BeginDraw(0))
+        return false;
+
+    GLDrawArraysInstancedCommandNV token;
+    {
+        token.header        = drawArraysHeader_;
+        token.mode          = mode;
+        token.count         = static_cast<GLuint>(count);
+        token.instanceCount = static_cast<GLuint>(instanceCount);
+        token.first         = static_cast<GLuint>(first);
+        token.baseInstance  = baseInstance;
+    }
+    WriteToken(token);
+
+    return true;
+}
+
+bool GLCommandListCompilerNV::DrawElements(GLenum mode, GLenum type, const GLvoid* indices, GLsizei count, GLsizei instanceCount, GLint baseVertex, GLuint baseInstance)
+{
+    /* Element address token specifies the base address, so the byte offset of the indices must be converted into an index */
+    const GLuint    typeSize    = GetGLIndexTypeSize(type);
+    const GLintptr  offset      = reinterpret_cast<GLintptr>(indices);
+    if (offset % typeSize != 0)
+        return false;
+
+    if (!BeginDraw(type))
+        return false;
+
+    GLDrawElementsInstancedCommandNV token;
+    {
+        token.header        = drawElementsHeader_;
+        token.mode          = mode;
+        token.count         = static_cast<GLuint>(count);
+        token.instanceCount = static_cast<GLuint>(instanceCount);
+        token.firstIndex    = static_cast<GLuint>(offset / typeSize);
+        token.baseVertex    = baseVertex;
+        token.baseInstance  = baseInstance;
+    }
+    WriteToken(token);
+
+    return true;
+}
+
+bool GLCommandListCompilerNV::MultiDrawIndirect(bool indexed, GLuint id, GLenum mode, GLenum type, const GLvoid* indirect, GLsizei drawCount, GLsizei stride)
+{
+    /* Only draw batches of the command buffer itself can be expanded, since their arguments are known on the CPU */
+    if (id == 0 || id != cmdBuffer_.GetIndirectBufferID())
+        return false;
+
+    const std::vector<char>&    indirectData    = cmdBuffer_.GetIndirectData();
+    const std::size_t           offset          = static_cast<std::size_t>(reinterpret_cast<GLintptr>(indirect));
+    const std::size_t           argsSize        = (indexed ? sizeof(GLDrawElementsIndirectCommand) : sizeof(GLDrawArraysIndirectCommand));
+
+    if (drawCount <= 0 || static_cast<std::size_t>(stride) < argsSize)
+        return false;
+    if (offset + static_cast<std::size_t>(stride)*static_cast<std::size_t>(drawCount - 1) + argsSize > indirectData.size())
+        return false;
+
+    for_range(i, drawCount)
+    {
+        const char* args = indirectData.data() + offset + static_cast<std::size_t>(stride)*i;
+        if (indexed)
+        {
+            GLDrawElementsIndirectCommand cmd;
+            ::memcpy(&cmd, args, sizeof(cmd));
+            if (!BeginDraw(type))
+                return false;
+
+            GLDrawElementsInstancedCommandNV token;
+            {
+                token.header        = drawElementsHeader_;
+                token.mode          = mode;
+                token.count         = cmd.count;
+                token.instanceCount = cmd.instanceCount;
+                token.firstIndex    = cmd.firstIndex;
+                token.baseVertex    = cmd.baseVertex;
+                token.baseInstance  = cmd.baseInstance;
+            }
+            WriteToken(token);
+        }
+        else
+        {
+            GLDrawArraysIndirectCommand cmd;
+            ::memcpy(&cmd, args, sizeof(cmd));
+            if (!DrawArrays(mode, static_cast<GLint>(cmd.first), static_cast<GLsizei>(cmd.count), static_cast<GLsizei>(cmd.instanceCount), cmd.baseInstance))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void GLCommandListCompilerNV::WriteVertexAttribTokens()
+{
+    for_range(i, bindings_->Count())
+    {
+        const GLuint64EXT address = GetResidentBufferAddressNV(bindings_->buffers[i]) + static_cast<GLuint64EXT>(bindings_->offsets[i]);
+        GLAttributeAddressCommandNV token;
+        {
+            token.header    = attribAddressHeader_;
+            token.index     = static_cast<GLuint>(i);
+            token.addressLo = static_cast<GLuint>(address & 0xFFFFFFFFull);
+            token.addressHi = static_cast<GLuint>(address >> 32);
+        }
+        WriteToken(token);
+    }
+}
+
+void GLCommandListCompilerNV::WriteUniformAddressTokens(GLuint index, GLuint buffer, GLintptr offset)
+{
+    const GLuint64EXT address = (buffer != 0 ? GetResidentBufferAddressNV(buffer) + static_cast<GLuint64EXT>(offset) : 0);
+    for (GLushort stage : stages_)
+    {
+        GLUniformAddressCommandNV token;
+        {
+            token.header    = uniformAddressHeader_;
+            token.index     = static_cast<GLushort>(index);
+            token.stage     = stage;
+            token.addressLo = static_cast<GLuint>(address & 0xFFFFFFFFull);
+            token.addressHi = static_cast<GLuint>(address >> 32);
+        }
+        WriteToken(token);
+    }
+}
+
+template <typename TToken>
+void GLCommandListCompilerNV::WriteToken(const TToken& token)
+{
+    const std::size_t offset = tokens_.size();
+    tokens_.resize(offset + sizeof(TToken));
+    ::memcpy(tokens_.data() + offset, &token, sizeof(TToken));
+}
+
+
+/*
+ * GLCommandListNV class
+ */
+
+GLCommandListNV::~GLCommandListNV()
+{
+    if (tokenBuffer_ != 0)
+    {
+        glDeleteBuffers(1, &tokenBuffer_);
+        GLStateManager::Get().NotifyBufferRelease(tokenBuffer_, GLBufferTarget::CopyWriteBuffer);
+    }
+}
+
+std::unique_ptr<GLCommandListNV> GLCommandListNV::Compile(const GLDeferredCommandBuffer& cmdBuffer)
+{
+    if (!HasExtension(GLExt::NV_command_list)                   ||
+        !HasExtension(GLExt::NV_shader_buffer_load)             ||
+        !HasExtension(GLExt::NV_vertex_buffer_unified_memory)   ||
+        !HasExtension(GLExt::NV_uniform_buffer_unified_memory))
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<GLCommandListNV> cmdList{ new GLCommandListNV{} };
+    GLCommandListCompilerNV compiler{ *cmdList, cmdBuffer };
+
+    for (const auto& chunk : cmdBuffer.GetVirtualCommandBuffer())
+    {
+        auto pc     = chunk.data;
+        auto pcEnd  = chunk.data + chunk.size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            const GLOpcode opcode = *reinterpret_cast<const GLOpcode*>(pc);
+            pc += GLVirtualCommandBuffer::OpcodeSize();
+
+            /* Compile command and increment program counter; fall back to the command executor for the entire command buffer on incompatible commands */
+            const std::size_t cmdSize = compiler.CompileCommand(opcode, pc);
+            if (cmdSize == g_incompatibleGLCommandSize)
+                return nullptr;
+            pc += GLVirtualCommandBuffer::AlignSize(cmdSize);
+        }
+    }
+
+    if (!compiler.Finish())
+        return nullptr;
+
+    return cmdList;
+}
+
+void GLCommandListNV::Execute(GLStateManager& stateMngr) const
+{
+    GLStateManager* stateMngrRef = &stateMngr;
+
+    glEnableClientState(GL_VERTEX_ATTRIB_ARRAY_UNIFIED_NV);
+    glEnableClientState(GL_ELEMENT_ARRAY_UNIFIED_NV);
+    glEnableClientState(GL_UNIFORM_BUFFER_UNIFIED_NV);
+
+    for (const Segment& segment : segments_)
+    {
+        /* Execute regular commands of this segment */
+        for_range(i, segment.numCommands)
+        {
+            const Command& cmd = commands_[segment.firstCommand + i];
+            ExecuteGLCommand(cmd.opcode, cmd.pc, stateMngrRef);
+        }
+
+        if (segment.seedUniformBuffers)
+            SeedUniformBufferAddresses(stateMngr);
+
+        if (segment.tokenSize > 0)
+        {
+            /* Vertex array still provides the vertex format and strides for the attribute address tokens */
+            stateMngr.BindVertexArray(segment.vertexArray);
+            stateMngr.BindVertexBuffers(0, segment.bindings->Count(), segment.bindings->buffers.data(), segment.bindings->offsets.data(), segment.bindings->strides.data());
+            stateMngr.FlushPendingStates();
+
+            /* Primitive mode is ignored since all draw tokens specify their mode */
+            glDrawCommandsNV(GL_TRIANGLES, tokenBuffer_, &segment.tokenOffset, &segment.tokenSize, 1);
+        }
+    }
+
+    glDisableClientState(GL_UNIFORM_BUFFER_UNIFIED_NV);
+    glDisableClientState(GL_ELEMENT_ARRAY_UNIFIED_NV);
+    glDisableClientState(GL_VERTEX_ATTRIB_ARRAY_UNIFIED_NV);
+
+    /* Restore regular bindings that have only been set by tokens, so subsequent commands observe the same state as with the command executor */
+    for (const UniformBufferBinding& binding : finalUniformBuffers_)
+    {
+        if (binding.size > 0)
+            stateMngr.BindBufferRange(GLBufferTarget::UniformBuffer, binding.index, binding.buffer, binding.offset, binding.size);
+        else
+            stateMngr.BindBufferBase(GLBufferTarget::UniformBuffer, binding.index, binding.buffer);
+    }
+
+    if (finalElementBuffer_ != 0)
+        stateMngr.BindElementArrayBufferToVAO(finalElementBuffer_, finalIndexType16Bits_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLCommandListNV::SeedUniformBufferAddresses(GLStateManager& stateMngr) const
+{
+    /* Unified uniform buffer addresses replace all regular bindings while GL_UNIFORM_BUFFER_UNIFIED_NV is enabled */
+    const auto& ranges = stateMngr.GetUniformBufferRanges();
+    for_range(i, ranges.size())
+    {
+        const GLStateManager::GLUniformBufferRange& range = ranges[i];
+        if (range.buffer != 0)
+        {
+            const GLuint64EXT address = GetResidentBufferAddressNV(range.buffer) + static_cast<GLuint64EXT>(range.offset);
+            glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, static_cast<GLuint>(i), address, (range.size > 0 ? range.size : maxUniformBlockSize_));
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_GLEXT_COMMAND_LIST_NV
+
+
+
+// ================================================================================
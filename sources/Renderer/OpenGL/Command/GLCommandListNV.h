@@ -0,0 +1,112 @@
+/*
+ * GLCommandListNV.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GL_COMMAND_LIST_NV_H
+#define LLGL_GL_COMMAND_LIST_NV_H
+
+
+#include "../OpenGL.h"
+
+#ifdef LLGL_GLEXT_COMMAND_LIST_NV
+
+#include "GLCommandOpcode.h"
+#include <LLGL/NonCopyable.h>
+#include <memory>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class GLDeferredCommandBuffer;
+class GLStateManager;
+struct GLVertexBufferBindings;
+
+/*
+Multi-submit command buffer that has been compiled into a token buffer of GL_NV_command_list.
+Vertex, index, and uniform buffers are bound by their GPU addresses (GL_NV_vertex_buffer_unified_memory and GL_NV_uniform_buffer_unified_memory),
+so all draws between two vertex array bindings are submitted by the driver with a single call to glDrawCommandsNV.
+All other compatible commands are executed between these calls by the regular command executor.
+*/
+class GLCommandListNV final : public NonCopyable
+{
+
+    public:
+
+        ~GLCommandListNV();
+
+        // Compiles the specified command buffer into a command list. Returns null if the command buffer contains commands that cannot be expressed with tokens.
+        static std::unique_ptr<GLCommandListNV> Compile(const GLDeferredCommandBuffer& cmdBuffer);
+
+        // Executes this command list. Uniform buffers bound by the state manager remain visible to all draws that don't rebind them.
+        void Execute(GLStateManager& stateMngr) const;
+
+    private:
+
+        // Regular command that is executed by the command executor.
+        struct Command
+        {
+            GLOpcode    opcode;
+            const void* pc;
+        };
+
+        // Sequence of regular commands followed by tokens that are submitted with a single call to glDrawCommandsNV.
+        struct Segment
+        {
+            std::size_t                     firstCommand        = 0;
+            std::size_t                     numCommands         = 0;
+            bool                            seedUniformBuffers  = false;    // Uniform buffer addresses must be seeded from the state manager after the regular commands
+            GLuint                          vertexArray         = 0;
+            const GLVertexBufferBindings*   bindings            = nullptr;
+            GLintptr                        tokenOffset         = 0;
+            GLsizei                         tokenSize           = 0;
+        };
+
+        // Uniform buffer binding that is set by tokens and has to be restored with a regular binding after the command list.
+        struct UniformBufferBinding
+        {
+            GLuint      index;
+            GLuint      buffer;
+            GLintptr    offset;
+            GLsizeiptr  size;
+        };
+
+        friend class GLCommandListCompilerNV;
+
+    private:
+
+        GLCommandListNV() = default;
+
+        // Passes the GPU addresses of the uniform buffers bound by the state manager to the unified memory of the driver.
+        void SeedUniformBufferAddresses(GLStateManager& stateMngr) const;
+
+    private:
+
+        GLuint                              tokenBuffer_            = 0;
+        GLsizeiptr                          maxUniformBlockSize_    = 0;
+        std::vector<Command>                commands_;
+        std::vector<Segment>                segments_;
+
+        std::vector<UniformBufferBinding>   finalUniformBuffers_;
+        GLuint                              finalElementBuffer_     = 0;
+        bool                                finalIndexType16Bits_   = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_GLEXT_COMMAND_LIST_NV
+
+
+#endif
+
+
+
+// ================================================================================
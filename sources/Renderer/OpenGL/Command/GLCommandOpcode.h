@@ -22,6 +22,7 @@ enum GLOpcode : std::uint8_t
     GLOpcodeCopyBufferSubData,
     GLOpcodeClearBufferData,
     GLOpcodeClearBufferSubData,
+    GLOpcodeClearBufferPattern,
     GLOpcodeCopyImageSubData,
     GLOpcodeCopyImageToBuffer,
     GLOpcodeCopyImageFromBuffer,
@@ -38,22 +39,26 @@ enum GLOpcode : std::uint8_t
     GLOpcodeClearStencil,
     GLOpcodeClear,
     GLOpcodeClearAttachmentsWithRenderPass,
+    GLOpcodeEndRenderPass,
     GLOpcodeClearBuffers,
     GLOpcodeBindVertexArray,
     GLOpcodeBindGL2XVertexArray,
     GLOpcodeBindElementArrayBufferToVAO,
     GLOpcodeBindBufferBase,
+    GLOpcodeBindBufferRange,
     GLOpcodeBindBuffersBase,
     GLOpcodeBeginTransformFeedback,
     GLOpcodeBeginTransformFeedbackNV,
     GLOpcodeEndTransformFeedback,
     GLOpcodeEndTransformFeedbackNV,
+    GLOpcodeBindTransformFeedback,
     GLOpcodeBindResourceHeap,
     GLOpcodeBindRenderTarget,
     GLOpcodeBindPipelineState,
     GLOpcodeSetBlendColor,
     GLOpcodeSetStencilRef,
     GLOpcodeSetUniforms,
+    GLOpcodeSetUniformBlock,
     GLOpcodeBeginQuery,
     GLOpcodeEndQuery,
     GLOpcodeBeginConditionalRender,
@@ -62,6 +67,7 @@ enum GLOpcode : std::uint8_t
     GLOpcodeDrawArraysInstanced,
     GLOpcodeDrawArraysInstancedBaseInstance,
     GLOpcodeDrawArraysIndirect,
+    GLOpcodeDrawTransformFeedback,
     GLOpcodeDrawElements,
     GLOpcodeDrawElementsBaseVertex,
     GLOpcodeDrawElementsInstanced,
@@ -81,6 +87,12 @@ enum GLOpcode : std::uint8_t
     GLOpcodePopDebugGroup,
 };
 
+// Returns true if the specified opcode denotes a draw command, i.e. any opcode in the range [GLOpcodeDrawArrays, GLOpcodeMultiDrawElementsIndirect].
+inline bool IsGLOpcodeDrawCommand(GLOpcode opcode)
+{
+    return (opcode >= GLOpcodeDrawArrays && opcode <= GLOpcodeMultiDrawElementsIndirect);
+}
+
 
 } // /namespace LLGL
 
@@ -14,6 +14,8 @@
 #include "../RenderState/GLStateManager.h"
 #include "../../CheckedCast.h"
 #include "../Ext/GLExtensionRegistry.h"
+#include "../../HostTrace.h"
+#include "../../TimestampUtils.h"
 #include <algorithm>
 
 
@@ -30,6 +32,8 @@ GLCommandQueue::GLCommandQueue(GLStateManager& stateManager) :
 
 void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_HOST_TRACE_SCOPE("Submit");
+
     /*
     Only deferred command buffers can be submitted multiple times (via GLDeferredCommandBuffer),
     otherwise the commands must be submitted immediately (via GLImmediateCommandBuffer).
@@ -40,6 +44,19 @@ void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
         auto& deferredCmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, cmdBufferGL);
         ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, stateMngr_);
     }
+    frameCounters_.SubmitCommandBuffer(cmdBufferGL.GetFrameCounters());
+}
+
+/* ----- Sparse Resources ----- */
+
+void GLCommandQueue::UpdateTileMappings(Texture& /*texture*/, std::uint32_t /*numMappings*/, const TextureTileMapping* /*mappings*/)
+{
+    // dummy
+}
+
+void GLCommandQueue::UpdateTileMappings(Buffer& /*buffer*/, std::uint32_t /*numMappings*/, const BufferTileMapping* /*mappings*/)
+{
+    // dummy
 }
 
 /* ----- Queries ----- */
@@ -151,6 +168,42 @@ static void QueryResultPipelineStatistics(GLQueryHeap& queryHeapGL, std::uint32_
     #endif // /GL_ARB_pipeline_statistics_query
 }
 
+#ifdef GL_ARB_query_buffer_object
+
+// Returns true if query results can be resolved into a query buffer and polled with a fence.
+static bool IsQueryBufferResolveSupported()
+{
+    return
+    (
+        HasExtension(GLExt::ARB_query_buffer_object) &&
+        HasExtension(GLExt::ARB_sync)                &&
+        HasExtension(GLExt::ARB_timer_query)
+    );
+}
+
+static bool QueryResultFromQueryBuffer(GLQueryHeap& queryHeapGL, std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
+{
+    if (dataSize == numQueries * sizeof(std::uint64_t))
+    {
+        /* Resolve 64-bit results directly into output (this also covers pipeline statistics) */
+        return queryHeapGL.ResolveResults(firstQuery, numQueries, reinterpret_cast<std::uint64_t*>(data));
+    }
+    else if (dataSize == numQueries * sizeof(std::uint32_t))
+    {
+        /* Resolve 64-bit results and truncate them to 32-bit output */
+        std::vector<std::uint64_t> results(numQueries);
+        if (!queryHeapGL.ResolveResults(firstQuery, numQueries, results.data()))
+            return false;
+        auto* data32 = reinterpret_cast<std::uint32_t*>(data);
+        for (std::uint32_t i = 0; i < numQueries; ++i)
+            data32[i] = static_cast<std::uint32_t>(results[i]);
+        return true;
+    }
+    return false;
+}
+
+#endif // /GL_ARB_query_buffer_object
+
 bool GLCommandQueue::QueryResult(
     QueryHeap&      queryHeap,
     std::uint32_t   firstQuery,
@@ -164,6 +217,11 @@ bool GLCommandQueue::QueryResult(
     firstQuery *= queryHeapGL.GetGroupSize();
     numQueries *= queryHeapGL.GetGroupSize();
 
+    #ifdef GL_ARB_query_buffer_object
+    if (IsQueryBufferResolveSupported())
+        return QueryResultFromQueryBuffer(queryHeapGL, firstQuery, numQueries, data, dataSize);
+    #endif // /GL_ARB_query_buffer_object
+
     if (AreQueryResultsAvailable(queryHeapGL, firstQuery, numQueries))
     {
         if (dataSize == numQueries * sizeof(std::uint32_t))
@@ -180,12 +238,51 @@ bool GLCommandQueue::QueryResult(
     return false;
 }
 
+bool GLCommandQueue::QueryFrameCounters(FrameProfile& outProfile)
+{
+    return frameCounters_.Query(outProfile);
+}
+
+bool GLCommandQueue::GetCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    #ifdef GL_ARB_timer_query
+    if (HasExtension(GLExt::ARB_timer_query) && HasExtension(GLExt::ARB_sync))
+    {
+        /* GL_TIMESTAMP is the GL time once all previous commands have reached the GL server, so it is bracketed by CPU timestamps */
+        return SampleCalibratedTimestamps(
+            outTimestamps,
+            [](std::uint64_t& outGPUTimestamp) -> bool
+            {
+                GLint64 timestamp = 0;
+                glGetInteger64v(GL_TIMESTAMP, &timestamp);
+                outGPUTimestamp = static_cast<std::uint64_t>(timestamp);
+                return true;
+            }
+        );
+    }
+    #endif // /GL_ARB_timer_query
+    return false;
+}
+
 /* ----- Fences ----- */
 
 void GLCommandQueue::Submit(Fence& fence)
 {
     auto& fenceGL = LLGL_CAST(GLFence&, fence);
     fenceGL.Submit();
+    frameCounters_.SubmitFence();
+}
+
+void GLCommandQueue::Submit(Fence& fence, std::uint64_t value)
+{
+    auto& fenceGL = LLGL_CAST(GLFence&, fence);
+    fenceGL.Submit(value);
+    frameCounters_.SubmitFence();
+}
+
+void GLCommandQueue::SubmitWait(Fence& /*fence*/, std::uint64_t /*value*/)
+{
+    // dummy; GL only has a single command queue that executes all commands in submission order
 }
 
 bool GLCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
@@ -194,6 +291,12 @@ bool GLCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
     return fenceGL.Wait(timeout);
 }
 
+bool GLCommandQueue::WaitFence(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceGL = LLGL_CAST(GLFence&, fence);
+    return fenceGL.Wait(value, timeout);
+}
+
 void GLCommandQueue::WaitIdle()
 {
     glFinish();
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/CommandQueue.h>
+#include "../../FrameCounters.h"
 #include <memory>
 
 
@@ -32,7 +33,8 @@ class GLCommandQueue final : public CommandQueue
 
     private:
 
-        GLStateManager& stateMngr_;
+        GLStateManager&         stateMngr_;
+        FrameCounterAccumulator frameCounters_;
 
 };
 
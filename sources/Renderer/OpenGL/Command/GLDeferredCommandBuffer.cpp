@@ -10,12 +10,14 @@
 #include <LLGL/StaticLimits.h>
 
 #include "../../TextureUtils.h"
+#include "../../BufferUtils.h"
 #include "../GLSwapChain.h"
 #include "../GLTypes.h"
 #include "../GLCore.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
+#include "../../FrameCounters.h"
 #include "../../../Core/Assertion.h"
 
 #include "../Shader/GLShaderPipeline.h"
@@ -53,16 +55,42 @@ GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t initial
     flags_  { flags             },
     buffer_ { initialBufferSize }
 {
+    /* Eliminate shadowed state commands only for command buffers that are submitted multiple times */
+    stateEliminationEnabled_ = ((flags & CommandBufferFlags::MultiSubmit) != 0);
+
+    #if defined LLGL_GLEXT_MULTI_DRAW_INDIRECT && defined LLGL_GLEXT_BASE_INSTANCE
+    drawBatchingEnabled_ = (HasExtension(GLExt::ARB_multi_draw_indirect) && HasExtension(GLExt::ARB_base_instance));
+    #endif
+}
+
+GLDeferredCommandBuffer::~GLDeferredCommandBuffer()
+{
+    if (indirectBufferID_ != 0)
+    {
+        glDeleteBuffers(1, &indirectBufferID_);
+        GLStateManager::Get().NotifyBufferRelease(indirectBufferID_, GLBufferTarget::DrawIndirectBuffer);
+    }
 }
 
 /* ----- Encoding ----- */
 
 void GLDeferredCommandBuffer::Begin()
 {
+    LLGL_FRAME_COUNTER_BEGIN();
+
     /* Reset internal command buffer */
     buffer_.Clear();
     ResetRenderState();
 
+    /* Reset draw batches and shadowable state commands */
+    drawBatch_ = DrawBatch{};
+    indirectData_.clear();
+    stateCommands_.clear();
+
+    #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+    commandListNV_.reset();
+    #endif // /LLGL_GLEXT_COMMAND_LIST_NV
+
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
     /* Reset states relevant to the GL command assembler */
@@ -75,12 +103,37 @@ void GLDeferredCommandBuffer::Begin()
 
 void GLDeferredCommandBuffer::End()
 {
+    /* Encode remaining draw batch and upload indirect draw commands of all batches */
+    FlushDrawBatch();
+    UploadIndirectData();
+
+    #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+
+    /*
+    Compile command buffer into an NV command list if it will be submitted multiple times.
+    The command list references the unpacked virtual command buffer, so neither packing nor the JIT compiler is required.
+    */
+    if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
+    {
+        commandListNV_ = GLCommandListNV::Compile(*this);
+        if (commandListNV_)
+            return;
+    }
+
+    #endif // /LLGL_GLEXT_COMMAND_LIST_NV
+
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
     /* Generate native assembly only if command buffer will be submitted multiple times */
     if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
+    {
         executable_ = AssembleGLDeferredCommandBuffer(*this);
 
+        /* Pack virtual command buffer if it has to be interpreted, e.g. when the JIT compiler is not supported for this architecture */
+        if (!executable_)
+            buffer_.Pack();
+    }
+
     #else
 
     /* Pack virtual command buffer if it has to be traversed multiple times */
@@ -104,11 +157,17 @@ void GLDeferredCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
                 /* Encode GL command */
                 auto cmd = AllocCommand<GLCmdExecute>(GLOpcodeExecute);
                 cmd->commandBuffer = &deferredCmdBufferGL;
+                LLGL_FRAME_COUNTER_EXECUTE(deferredCmdBufferGL.GetFrameCounters());
             }
         }
     }
 }
 
+void GLDeferredCommandBuffer::TrimMemory()
+{
+    // dummy
+}
+
 /* ----- Blitting ----- */
 
 void GLDeferredCommandBuffer::UpdateBuffer(
@@ -117,6 +176,8 @@ void GLDeferredCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferUpdates);
+
     auto cmd = AllocCommand<GLCmdBufferSubData>(GLOpcodeBufferSubData, dataSize);
     {
         cmd->buffer = LLGL_CAST(GLBuffer*, &dstBuffer);
@@ -133,6 +194,8 @@ void GLDeferredCommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto cmd = AllocCommand<GLCmdCopyBufferSubData>(GLOpcodeCopyBufferSubData);
     {
         cmd->writeBuffer    = LLGL_CAST(GLBuffer*, &dstBuffer);
@@ -151,6 +214,8 @@ void GLDeferredCommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto cmd = AllocCommand<GLCmdCopyImageBuffer>(GLOpcodeCopyImageToBuffer);
     {
         cmd->texture        = LLGL_CAST(GLTexture*, &srcTexture);
@@ -169,6 +234,8 @@ void GLDeferredCommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
     if (fillSize == Constants::wholeSize)
     {
         auto cmd = AllocCommand<GLCmdClearBufferData>(GLOpcodeClearBufferData);
@@ -189,6 +256,37 @@ void GLDeferredCommandBuffer::FillBuffer(
     }
 }
 
+void GLDeferredCommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    /* Forward patterns of a single 32-bit value to the default fill command */
+    std::uint32_t value = 0;
+    if (GetUniformFillPatternValue(pattern, patternSize, value))
+        return FillBuffer(dstBuffer, dstOffset, value, fillSize);
+
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
+    auto* dstBufferGL = LLGL_CAST(GLBuffer*, &dstBuffer);
+    if (fillSize == Constants::wholeSize)
+    {
+        dstOffset   = 0;
+        fillSize    = static_cast<std::uint64_t>(dstBufferGL->GetSize());
+    }
+
+    auto cmd = AllocCommand<GLCmdClearBufferPattern>(GLOpcodeClearBufferPattern);
+    {
+        cmd->buffer         = dstBufferGL;
+        cmd->offset         = static_cast<GLintptr>(dstOffset);
+        cmd->size           = static_cast<GLsizeiptr>(fillSize);
+        cmd->patternSize    = static_cast<GLsizei>(std::min<std::uint32_t>(patternSize, sizeof(cmd->pattern)));
+        ::memcpy(cmd->pattern, pattern, static_cast<std::size_t>(cmd->patternSize));
+    }
+}
+
 void GLDeferredCommandBuffer::CopyTexture(
     Texture&                dstTexture,
     const TextureLocation&  dstLocation,
@@ -196,6 +294,8 @@ void GLDeferredCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto cmd = AllocCommand<GLCmdCopyImageSubData>(GLOpcodeCopyImageSubData);
     {
         cmd->dstTexture = LLGL_CAST(GLTexture*, &dstTexture);
@@ -216,6 +316,8 @@ void GLDeferredCommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto cmd = AllocCommand<GLCmdCopyImageBuffer>(GLOpcodeCopyImageFromBuffer);
     {
         cmd->texture        = LLGL_CAST(GLTexture*, &dstTexture);
@@ -233,6 +335,8 @@ void GLDeferredCommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     if (dstRegion.extent.depth != 1)
         return /*GL_INVALID_VALUE*/;
 
@@ -249,6 +353,8 @@ void GLDeferredCommandBuffer::CopyTextureFromFramebuffer(
 
 void GLDeferredCommandBuffer::GenerateMips(Texture& texture)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto cmd = AllocCommand<GLCmdGenerateMipmap>(GLOpcodeGenerateMipmap);
     {
         cmd->texture = LLGL_CAST(GLTexture*, &texture);
@@ -257,6 +363,8 @@ void GLDeferredCommandBuffer::GenerateMips(Texture& texture)
 
 void GLDeferredCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto cmd = AllocCommand<GLCmdGenerateMipmapSubresource>(GLOpcodeGenerateMipmapSubresource);
     {
         cmd->texture        = LLGL_CAST(GLTexture*, &texture);
@@ -267,6 +375,11 @@ void GLDeferredCommandBuffer::GenerateMips(Texture& texture, const TextureSubres
     }
 }
 
+void GLDeferredCommandBuffer::CompressTexture(Texture& /*dstTexture*/, Texture& /*srcTexture*/, const TextureSubresource& /*subresource*/)
+{
+    // dummy
+}
+
 /* ----- Viewport and Scissor ----- */
 
 void GLDeferredCommandBuffer::SetViewport(const Viewport& viewport)
@@ -275,7 +388,7 @@ void GLDeferredCommandBuffer::SetViewport(const Viewport& viewport)
     maxNumViewports_ = std::max(maxNumViewports_, 1u);
     #endif // /LLGL_ENABLE_JIT_COMPILER
 
-    auto cmd = AllocCommand<GLCmdViewport>(GLOpcodeViewport);
+    auto cmd = AllocStateCommand<GLCmdViewport>(GLOpcodeViewport);
     {
         cmd->viewport   = GLViewport{ viewport.x, viewport.y, viewport.width, viewport.height };
         cmd->depthRange = GLDepthRange{ viewport.minDepth, viewport.maxDepth };
@@ -321,7 +434,7 @@ void GLDeferredCommandBuffer::SetScissor(const Scissor& scissor)
     maxNumScissors_ = std::max(maxNumScissors_, 1u);
     #endif // /LLGL_ENABLE_JIT_COMPILER
 
-    auto cmd = AllocCommand<GLCmdScissor>(GLOpcodeScissor);
+    auto cmd = AllocStateCommand<GLCmdScissor>(GLOpcodeScissor);
     cmd->scissor = GLScissor{ scissor.x, scissor.y, scissor.width, scissor.height };
 }
 
@@ -353,8 +466,16 @@ void GLDeferredCommandBuffer::SetScissors(std::uint32_t numScissors, const Sciss
 
 /* ----- Input Assembly ------ */
 
+// Returns the specified vertex buffer bindings or null if there are none, i.e. if the VAO refers to its vertex buffers directly.
+static const GLVertexBufferBindings* GetVertexBufferBindingsOrNull(const GLVertexBufferBindings& bindings)
+{
+    return (bindings.Empty() ? nullptr : &bindings);
+}
+
 void GLDeferredCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     if ((buffer.GetBindFlags() & BindFlags::VertexBuffer) != 0)
     {
         auto& bufferWithVAO = LLGL_CAST(const GLBufferWithVAO&, buffer);
@@ -368,13 +489,18 @@ void GLDeferredCommandBuffer::SetVertexBuffer(Buffer& buffer)
         #endif // /LLGL_GL_ENABLE_OPENGL2X
         {
             auto cmd = AllocCommand<GLCmdBindVertexArray>(GLOpcodeBindVertexArray);
-            cmd->vao = bufferWithVAO.GetVaoID();
+            cmd->vao        = bufferWithVAO.GetVaoID();
+            cmd->bindings   = GetVertexBufferBindingsOrNull(bufferWithVAO.GetVertexBufferBindings());
         }
+
+        SetVertexTransformFeedbackRenderState(bufferWithVAO.GetTransformFeedbackID());
     }
 }
 
 void GLDeferredCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     if ((bufferArray.GetBindFlags() & BindFlags::VertexBuffer) != 0)
     {
         auto& bufferArrayWithVAO = LLGL_CAST(const GLBufferArrayWithVAO&, bufferArray);
@@ -388,13 +514,18 @@ void GLDeferredCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         #endif
         {
             auto cmd = AllocCommand<GLCmdBindVertexArray>(GLOpcodeBindVertexArray);
-            cmd->vao = bufferArrayWithVAO.GetVaoID();
+            cmd->vao        = bufferArrayWithVAO.GetVaoID();
+            cmd->bindings   = GetVertexBufferBindingsOrNull(bufferArrayWithVAO.GetVertexBufferBindings());
         }
+
+        SetVertexTransformFeedbackRenderState(bufferArrayWithVAO.GetTransformFeedbackID());
     }
 }
 
 void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     auto cmd = AllocCommand<GLCmdBindElementArrayBufferToVAO>(GLOpcodeBindElementArrayBufferToVAO);
     cmd->id = bufferGL.GetID();
@@ -404,6 +535,8 @@ void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer)
 
 void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     const bool indexType16Bits = (format == Format::R16UInt);
     auto cmd = AllocCommand<GLCmdBindElementArrayBufferToVAO>(GLOpcodeBindElementArrayBufferToVAO);
@@ -416,6 +549,8 @@ void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format
 
 void GLDeferredCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
+    LLGL_FRAME_COUNTER_INC(resourceHeapBindings);
+
     auto cmd = AllocCommand<GLCmdBindResourceHeap>(GLOpcodeBindResourceHeap);
     cmd->resourceHeap   = LLGL_CAST(GLResourceHeap*, &resourceHeap);
     cmd->descriptorSet  = descriptorSet;
@@ -423,6 +558,8 @@ void GLDeferredCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::u
 
 void GLDeferredCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
+    LLGL_FRAME_COUNTER_RESOURCE(resource);
+
     auto* pipelineLayoutGL = GetBoundPipelineLayout();
     if (pipelineLayoutGL == nullptr)
         return /*GL_INVALID_VALUE*/;
@@ -483,6 +620,37 @@ void GLDeferredCommandBuffer::SetResource(std::uint32_t descriptor, Resource& re
     }
 }
 
+void GLDeferredCommandBuffer::SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t size)
+{
+    LLGL_FRAME_COUNTER_RESOURCE(buffer);
+
+    auto* pipelineLayoutGL = GetBoundPipelineLayout();
+    if (pipelineLayoutGL == nullptr)
+        return /*GL_INVALID_VALUE*/;
+
+    const auto& bindingList = pipelineLayoutGL->GetBindings();
+    if (!(descriptor < bindingList.size()))
+        return /*GL_INVALID_INDEX*/;
+
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    const auto& binding = bindingList[descriptor];
+    switch (binding.type)
+    {
+        case GLResourceType_UBO:
+            BindBufferRange(GLBufferTarget::UniformBuffer, bufferGL, binding.slot, offset, size);
+            break;
+
+        case GLResourceType_SSBO:
+            BindBufferRange(GLBufferTarget::ShaderStorageBuffer, bufferGL, binding.slot, offset, size);
+            break;
+
+        default:
+            /* Other bindings cannot be bound with a range, so bind the entire buffer */
+            SetResource(descriptor, static_cast<Resource&>(buffer));
+            break;
+    }
+}
+
 void GLDeferredCommandBuffer::ResetResourceSlots(
     const ResourceType  resourceType,
     std::uint32_t       firstSlot,
@@ -501,6 +669,7 @@ void GLDeferredCommandBuffer::ResetResourceSlots(
         switch (resourceType)
         {
             case ResourceType::Undefined:
+            case ResourceType::AccelerationStructure:
             break;
 
             case ResourceType::Buffer:
@@ -544,6 +713,8 @@ void GLDeferredCommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       /*swapBufferIndex*/)
 {
+    LLGL_FRAME_COUNTER_INC(renderPassSections);
+
     auto cmd = AllocCommand<GLCmdBindRenderTarget>(GLOpcodeBindRenderTarget);
     {
         cmd->renderTarget = &renderTarget;
@@ -557,15 +728,22 @@ void GLDeferredCommandBuffer::BeginRenderPass(
             ::memcpy(cmd + 1, clearValues, sizeof(ClearValue)*numClearValues);
         }
     }
+    SetRenderPassRenderState(LLGL_CAST(const GLRenderPass*, renderPass));
 }
 
 void GLDeferredCommandBuffer::EndRenderPass()
 {
-    // dummy
+    auto cmd = AllocCommand<GLCmdEndRenderPass>(GLOpcodeEndRenderPass);
+    {
+        cmd->renderPass = GetBoundRenderPass();
+    }
+    SetRenderPassRenderState(nullptr);
 }
 
 void GLDeferredCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     if (flags != 0)
     {
         if ((flags & ClearFlags::Color) != 0)
@@ -593,6 +771,8 @@ void GLDeferredCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 
 void GLDeferredCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     if (numAttachments > 0)
     {
         auto cmd = AllocCommand<GLCmdClearBuffers>(GLOpcodeClearBuffers, sizeof(AttachmentClear)*numAttachments);
@@ -614,7 +794,7 @@ void GLDeferredCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 
 void GLDeferredCommandBuffer::SetBlendFactor(const float color[4])
 {
-    auto cmd = AllocCommand<GLCmdSetBlendColor>(GLOpcodeSetBlendColor);
+    auto cmd = AllocStateCommand<GLCmdSetBlendColor>(GLOpcodeSetBlendColor);
     {
         cmd->color[0] = color[0];
         cmd->color[1] = color[1];
@@ -649,6 +829,19 @@ void GLDeferredCommandBuffer::SetUniforms(std::uint32_t first, const void* data,
     const std::uint32_t dataSizeInWords = dataSize / 4;
     const auto& uniformMap = boundPipelineState->GetUniformMap();
 
+    /* Record uniform data as a whole, because the emulated uniform block is uploaded into the ring buffer when the command is executed */
+    if (boundPipelineState->HasUniformBlock())
+    {
+        auto cmd = AllocCommand<GLCmdSetUniformBlock>(GLOpcodeSetUniformBlock, dataSize);
+        {
+            cmd->pipelineState  = boundPipelineState;
+            cmd->first          = first;
+            cmd->size           = dataSize;
+            ::memcpy(cmd + 1, data, dataSize);
+        }
+        return;
+    }
+
     for (auto words = reinterpret_cast<const std::uint32_t*>(data), wordsEnd = words + dataSizeInWords; words != wordsEnd; ++first)
     {
         if (first >= uniformMap.size())
@@ -657,7 +850,7 @@ void GLDeferredCommandBuffer::SetUniforms(std::uint32_t first, const void* data,
         /* Allocate GL command and copy data buffer */
         const auto& uniform = uniformMap[first];
         const std::uint32_t uniformSize = uniform.wordSize * 4;
-        auto cmd = AllocCommand<GLCmdSetUniforms>(GLOpcodeSetUniforms, dataSize);
+        auto cmd = AllocStateCommand<GLCmdSetUniforms>(GLOpcodeSetUniforms, boundShaderPipeline->GetID(), static_cast<std::uint32_t>(uniform.location), dataSize);
         {
             cmd->program    = boundShaderPipeline->GetID(); //TODO: must distinguish between GLShaderProgram and GLProgramPipeline
             cmd->type       = uniform.type;
@@ -674,6 +867,8 @@ void GLDeferredCommandBuffer::SetUniforms(std::uint32_t first, const void* data,
 
 void GLDeferredCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_FRAME_COUNTER_INC(querySections);
+
     auto cmd = AllocCommand<GLCmdBeginQuery>(GLOpcodeBeginQuery);
     {
         cmd->queryHeap  = LLGL_CAST(GLQueryHeap*, &queryHeap);
@@ -681,16 +876,19 @@ void GLDeferredCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t que
     }
 }
 
-void GLDeferredCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t /*query*/)
+void GLDeferredCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
     auto cmd = AllocCommand<GLCmdEndQuery>(GLOpcodeEndQuery);
     {
-        cmd->queryHeap = LLGL_CAST(GLQueryHeap*, &queryHeap);
+        cmd->queryHeap  = LLGL_CAST(GLQueryHeap*, &queryHeap);
+        cmd->query      = query;
     }
 }
 
 void GLDeferredCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_FRAME_COUNTER_INC(renderConditionSections);
+
     auto cmd = AllocCommand<GLCmdBeginConditionalRender>(GLOpcodeBeginConditionalRender);
     {
         cmd->id     = LLGL_CAST(const GLQueryHeap&, queryHeap).GetID(query);
@@ -714,8 +912,20 @@ void GLDeferredCommandBuffer::EndRenderCondition()
 
 void GLDeferredCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
-    /* Bind transform feedback buffers */
+    LLGL_FRAME_COUNTER_INC(streamOutputSections);
+
+    /* Bind transform feedback object of the first buffer before its indexed bindings, so it records the number of captured vertices */
     numBuffers = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
+    if (numBuffers > 0)
+    {
+        if (GLuint transformFeedbackID = LLGL_CAST(GLBuffer*, buffers[0])->GetTransformFeedbackID())
+        {
+            auto cmd = AllocCommand<GLCmdBindTransformFeedback>(GLOpcodeBindTransformFeedback);
+            cmd->id = transformFeedbackID;
+        }
+    }
+
+    /* Bind transform feedback buffers */
     BindBuffersBase(GLBufferTarget::TransformFeedbackBuffer, 0, numBuffers, buffers);
 
     /* Begin transform feedback section */
@@ -750,6 +960,13 @@ void GLDeferredCommandBuffer::EndStreamOutput()
     else
         LLGL_TRAP_TRANSFORM_FEEDBACK_NOT_SUPPORTED();
     #endif
+
+    /* Restore default transform feedback object */
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+    {
+        auto cmd = AllocCommand<GLCmdBindTransformFeedback>(GLOpcodeBindTransformFeedback);
+        cmd->id = 0;
+    }
 }
 
 /* ----- Drawing ----- */
@@ -762,6 +979,11 @@ The indices actually store the index start offset, but must be passed to GL as a
 
 void GLDeferredCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (BatchDraw(false, numVertices, 1, firstVertex, 0, 0))
+        return;
+
     auto cmd = AllocCommand<GLCmdDrawArrays>(GLOpcodeDrawArrays);
     {
         cmd->mode   = GetDrawMode();
@@ -772,22 +994,32 @@ void GLDeferredCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firs
 
 void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (BatchDraw(true, numIndices, 1, firstIndex, 0, 0))
+        return;
+
     auto cmd = AllocCommand<GLCmdDrawElements>(GLOpcodeDrawElements);
     {
-        cmd->mode       = GetDrawMode();
+        cmd->mode       = static_cast<GLushort>(GetDrawMode());
         cmd->count      = static_cast<GLsizei>(numIndices);
-        cmd->type       = GetIndexType();
+        cmd->type       = static_cast<GLushort>(GetIndexType());
         cmd->indices    = GetIndicesOffset(firstIndex);
     }
 }
 
 void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (BatchDraw(true, numIndices, 1, firstIndex, vertexOffset, 0))
+        return;
+
     auto cmd = AllocCommand<GLCmdDrawElementsBaseVertex>(GLOpcodeDrawElementsBaseVertex);
     {
-        cmd->mode       = GetDrawMode();
+        cmd->mode       = static_cast<GLushort>(GetDrawMode());
         cmd->count      = static_cast<GLsizei>(numIndices);
-        cmd->type       = GetIndexType();
+        cmd->type       = static_cast<GLushort>(GetIndexType());
         cmd->indices    = GetIndicesOffset(firstIndex);
         cmd->basevertex = vertexOffset;
     }
@@ -795,6 +1027,11 @@ void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_
 
 void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (BatchDraw(false, numVertices, numInstances, firstVertex, 0, 0))
+        return;
+
     auto cmd = AllocCommand<GLCmdDrawArraysInstanced>(GLOpcodeDrawArraysInstanced);
     {
         cmd->mode           = GetDrawMode();
@@ -806,6 +1043,11 @@ void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint
 
 void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (BatchDraw(false, numVertices, numInstances, firstVertex, 0, firstInstance))
+        return;
+
     #ifndef __APPLE__
     auto cmd = AllocCommand<GLCmdDrawArraysInstancedBaseInstance>(GLOpcodeDrawArraysInstancedBaseInstance);
     {
@@ -822,11 +1064,16 @@ void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (BatchDraw(true, numIndices, numInstances, firstIndex, 0, 0))
+        return;
+
     auto cmd = AllocCommand<GLCmdDrawElementsInstanced>(GLOpcodeDrawElementsInstanced);
     {
-        cmd->mode           = GetDrawMode();
+        cmd->mode           = static_cast<GLushort>(GetDrawMode());
         cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = GetIndexType();
+        cmd->type           = static_cast<GLushort>(GetIndexType());
         cmd->indices        = GetIndicesOffset(firstIndex);
         cmd->instancecount  = static_cast<GLsizei>(numInstances);
     }
@@ -834,11 +1081,16 @@ void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (BatchDraw(true, numIndices, numInstances, firstIndex, vertexOffset, 0))
+        return;
+
     auto cmd = AllocCommand<GLCmdDrawElementsInstancedBaseVertex>(GLOpcodeDrawElementsInstancedBaseVertex);
     {
-        cmd->mode           = GetDrawMode();
+        cmd->mode           = static_cast<GLushort>(GetDrawMode());
         cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = GetIndexType();
+        cmd->type           = static_cast<GLushort>(GetIndexType());
         cmd->indices        = GetIndicesOffset(firstIndex);
         cmd->instancecount  = static_cast<GLsizei>(numInstances);
         cmd->basevertex     = vertexOffset;
@@ -847,12 +1099,17 @@ void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    if (BatchDraw(true, numIndices, numInstances, firstIndex, vertexOffset, firstInstance))
+        return;
+
     #ifndef __APPLE__
     auto cmd = AllocCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
     {
-        cmd->mode           = GetDrawMode();
+        cmd->mode           = static_cast<GLushort>(GetDrawMode());
         cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = GetIndexType();
+        cmd->type           = static_cast<GLushort>(GetIndexType());
         cmd->indices        = GetIndicesOffset(firstIndex);
         cmd->instancecount  = static_cast<GLsizei>(numInstances);
         cmd->basevertex     = vertexOffset;
@@ -865,6 +1122,8 @@ void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std
 
 void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto cmd = AllocCommand<GLCmdDrawArraysIndirect>(GLOpcodeDrawArraysIndirect);
     {
         cmd->id             = LLGL_CAST(GLBuffer&, buffer).GetID();
@@ -877,6 +1136,8 @@ void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 
 void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     #ifndef __APPLE__
     if (HasExtension(GLExt::ARB_multi_draw_indirect))
     {
@@ -906,6 +1167,8 @@ void GLDeferredCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset,
 
 void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     auto cmd = AllocCommand<GLCmdDrawElementsIndirect>(GLOpcodeDrawElementsIndirect);
     {
         cmd->id             = LLGL_CAST(GLBuffer&, buffer).GetID();
@@ -919,6 +1182,8 @@ void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
 
 void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     #ifndef __APPLE__
     if (HasExtension(GLExt::ARB_multi_draw_indirect))
     {
@@ -948,10 +1213,67 @@ void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
     }
 }
 
+void GLDeferredCommandBuffer::DrawIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void GLDeferredCommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void GLDeferredCommandBuffer::DrawMeshTasks(std::uint32_t /*numWorkGroupsX*/, std::uint32_t /*numWorkGroupsY*/, std::uint32_t /*numWorkGroupsZ*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void GLDeferredCommandBuffer::DrawMeshTasksIndirect(Buffer& /*buffer*/, std::uint64_t /*offset*/, std::uint32_t /*numCommands*/, std::uint32_t /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void GLDeferredCommandBuffer::DrawStreamOutput()
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    /* Vertex count is taken from the transform feedback object of the vertex buffer; it is 0 if GL_ARB_transform_feedback2 is not supported */
+    if (GLuint transformFeedbackID = GetVertexTransformFeedback())
+    {
+        auto cmd = AllocCommand<GLCmdDrawTransformFeedback>(GLOpcodeDrawTransformFeedback);
+        {
+            cmd->mode   = GetDrawMode();
+            cmd->id     = transformFeedbackID;
+        }
+    }
+}
+
 /* ----- Compute ----- */
 
 void GLDeferredCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     #ifndef __APPLE__
     auto cmd = AllocCommand<GLCmdDispatchCompute>(GLOpcodeDispatchCompute);
     {
@@ -966,6 +1288,8 @@ void GLDeferredCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32
 
 void GLDeferredCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     #ifndef __APPLE__
     auto cmd = AllocCommand<GLCmdDispatchComputeIndirect>(GLOpcodeDispatchComputeIndirect);
     {
@@ -977,6 +1301,33 @@ void GLDeferredCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t off
     #endif
 }
 
+void GLDeferredCommandBuffer::CompactIndirectArguments(
+    Buffer&         /*dstBuffer*/,
+    std::uint64_t   /*dstOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    Buffer&         /*srcBuffer*/,
+    std::uint64_t   /*srcOffset*/,
+    Buffer&         /*visibilityBuffer*/,
+    std::uint64_t   /*visibilityOffset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    // dummy
+}
+
+/* ----- Ray Tracing ----- */
+
+void GLDeferredCommandBuffer::BuildAccelerationStructure(AccelerationStructure& /*accelerationStructure*/, const AccelerationStructureBuildDescriptor& /*buildDesc*/)
+{
+    // dummy
+}
+
+void GLDeferredCommandBuffer::CopyAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/, bool /*compact*/)
+{
+    // dummy
+}
+
 /* ----- Debugging ----- */
 
 void GLDeferredCommandBuffer::PushDebugGroup(const char* name)
@@ -1038,11 +1389,27 @@ bool GLDeferredCommandBuffer::IsPrimary() const
 
 void GLDeferredCommandBuffer::BindBufferBase(const GLBufferTarget bufferTarget, const GLBuffer& bufferGL, std::uint32_t slot)
 {
-    auto cmd = AllocCommand<GLCmdBindBufferBase>(GLOpcodeBindBufferBase);
+    auto cmd = AllocStateCommand<GLCmdBindBufferBase>(GLOpcodeBindBufferBase, static_cast<std::uint32_t>(bufferTarget), slot);
+    {
+        cmd->target = bufferTarget;
+        cmd->index  = slot;
+        cmd->id     = bufferGL.GetID();
+    }
+}
+
+void GLDeferredCommandBuffer::BindBufferRange(const GLBufferTarget bufferTarget, const GLBuffer& bufferGL, std::uint32_t slot, std::uint64_t offset, std::uint64_t size)
+{
+    /*
+    Buffer ranges are encoded as regular commands, since they must not be shadowed by or shadow a <BindBufferBase> command for the same slot.
+    Per-draw ranges end the current draw batch anyway.
+    */
+    auto cmd = AllocCommand<GLCmdBindBufferRange>(GLOpcodeBindBufferRange);
     {
         cmd->target = bufferTarget;
         cmd->index  = slot;
         cmd->id     = bufferGL.GetID();
+        cmd->offset = static_cast<GLintptr>(offset);
+        cmd->size   = static_cast<GLsizeiptr>(GetBufferRangeSize(static_cast<std::uint64_t>(bufferGL.GetSize()), offset, size));
     }
 }
 
@@ -1074,7 +1441,8 @@ void GLDeferredCommandBuffer::BindBuffersBase(const GLBufferTarget bufferTarget,
 
 void GLDeferredCommandBuffer::BindTexture(GLTexture& textureGL, std::uint32_t slot)
 {
-    auto cmd = AllocCommand<GLCmdBindTexture>(GLOpcodeBindTexture);
+    /* Texture bindings are tracked per texture target, so only a binding to the same target shadows the previous one */
+    auto cmd = AllocStateCommand<GLCmdBindTexture>(GLOpcodeBindTexture, slot, textureGL.GetGLTexTarget());
     {
         cmd->slot       = slot;
         cmd->texture    = &textureGL;
@@ -1083,7 +1451,7 @@ void GLDeferredCommandBuffer::BindTexture(GLTexture& textureGL, std::uint32_t sl
 
 void GLDeferredCommandBuffer::BindImageTexture(const GLTexture& textureGL, std::uint32_t slot)
 {
-    auto cmd = AllocCommand<GLCmdBindImageTexture>(GLOpcodeBindImageTexture);
+    auto cmd = AllocStateCommand<GLCmdBindImageTexture>(GLOpcodeBindImageTexture, slot);
     {
         cmd->unit       = slot;
         cmd->level      = 0;
@@ -1094,7 +1462,7 @@ void GLDeferredCommandBuffer::BindImageTexture(const GLTexture& textureGL, std::
 
 void GLDeferredCommandBuffer::BindSampler(const GLSampler& samplerGL, std::uint32_t slot)
 {
-    auto cmd = AllocCommand<GLCmdBindSampler>(GLOpcodeBindSampler);
+    auto cmd = AllocStateCommand<GLCmdBindSampler>(GLOpcodeBindSampler, slot);
     {
         cmd->layer      = slot;
         cmd->sampler    = samplerGL.GetID();
@@ -1112,17 +1480,193 @@ void GLDeferredCommandBuffer::BindGL2XSampler(const GL2XSampler& samplerGL2X, st
 }
 #endif
 
+bool GLDeferredCommandBuffer::BatchDraw(bool indexed, GLuint count, GLuint instanceCount, GLuint first, GLint baseVertex, GLuint baseInstance)
+{
+    if (!drawBatchingEnabled_)
+        return false;
+
+    const GLenum mode = GetDrawMode();
+    const GLenum type = (indexed ? GetIndexType() : 0);
+
+    if (indexed)
+    {
+        /* Indirect draw commands specify the first index instead of a byte offset, so the index buffer offset must be aligned to the index stride */
+        const GLsizeiptr indexOffset = GetRenderState().indexBufferOffset;
+        const GLsizeiptr indexStride = GetRenderState().indexBufferStride;
+        if (indexOffset % indexStride != 0)
+            return false;
+        first += static_cast<GLuint>(indexOffset / indexStride);
+    }
+
+    /* Start a new batch if the draw command is incompatible with the current batch */
+    if (drawBatch_.drawCount > 0 && (drawBatch_.indexed != indexed || drawBatch_.mode != mode || drawBatch_.type != type))
+        FlushDrawBatch();
+
+    if (drawBatch_.drawCount == 0)
+    {
+        drawBatch_.indexed      = indexed;
+        drawBatch_.mode         = mode;
+        drawBatch_.type         = type;
+        drawBatch_.indexStride  = GetRenderState().indexBufferStride;
+        drawBatch_.offset       = static_cast<GLintptr>(indirectData_.size());
+    }
+
+    /* Append indirect draw command */
+    if (indexed)
+    {
+        GLDrawElementsIndirectCommand cmd;
+        {
+            cmd.count           = count;
+            cmd.instanceCount   = instanceCount;
+            cmd.firstIndex      = first;
+            cmd.baseVertex      = baseVertex;
+            cmd.baseInstance    = baseInstance;
+        }
+        const char* data = reinterpret_cast<const char*>(&cmd);
+        indirectData_.insert(indirectData_.end(), data, data + sizeof(cmd));
+    }
+    else
+    {
+        GLDrawArraysIndirectCommand cmd;
+        {
+            cmd.count           = count;
+            cmd.instanceCount   = instanceCount;
+            cmd.first           = first;
+            cmd.baseInstance    = baseInstance;
+        }
+        const char* data = reinterpret_cast<const char*>(&cmd);
+        indirectData_.insert(indirectData_.end(), data, data + sizeof(cmd));
+    }
+
+    ++drawBatch_.drawCount;
+
+    return true;
+}
+
+void GLDeferredCommandBuffer::FlushDrawBatch()
+{
+    if (drawBatch_.drawCount == 0)
+        return;
+
+    if (drawBatch_.drawCount == 1)
+    {
+        /* Encode single draw command directly and drop its indirect command */
+        if (drawBatch_.indexed)
+        {
+            GLDrawElementsIndirectCommand indirectCmd;
+            ::memcpy(&indirectCmd, &indirectData_[static_cast<std::size_t>(drawBatch_.offset)], sizeof(indirectCmd));
+            const GLintptr indices = static_cast<GLintptr>(indirectCmd.firstIndex) * drawBatch_.indexStride;
+            auto cmd = buffer_.AllocCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
+            {
+                cmd->mode           = static_cast<GLushort>(drawBatch_.mode);
+                cmd->count          = static_cast<GLsizei>(indirectCmd.count);
+                cmd->type           = static_cast<GLushort>(drawBatch_.type);
+                cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
+                cmd->instancecount  = static_cast<GLsizei>(indirectCmd.instanceCount);
+                cmd->basevertex     = indirectCmd.baseVertex;
+                cmd->baseinstance   = indirectCmd.baseInstance;
+            }
+        }
+        else
+        {
+            GLDrawArraysIndirectCommand indirectCmd;
+            ::memcpy(&indirectCmd, &indirectData_[static_cast<std::size_t>(drawBatch_.offset)], sizeof(indirectCmd));
+            auto cmd = buffer_.AllocCommand<GLCmdDrawArraysInstancedBaseInstance>(GLOpcodeDrawArraysInstancedBaseInstance);
+            {
+                cmd->mode           = drawBatch_.mode;
+                cmd->first          = static_cast<GLint>(indirectCmd.first);
+                cmd->count          = static_cast<GLsizei>(indirectCmd.count);
+                cmd->instancecount  = static_cast<GLsizei>(indirectCmd.instanceCount);
+                cmd->baseinstance   = indirectCmd.baseInstance;
+            }
+        }
+        indirectData_.resize(static_cast<std::size_t>(drawBatch_.offset));
+    }
+    else
+    {
+        /* Indirect buffer is shared by all batches of this command buffer and uploaded in End() */
+        if (indirectBufferID_ == 0)
+            glGenBuffers(1, &indirectBufferID_);
+
+        if (drawBatch_.indexed)
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdMultiDrawElementsIndirect>(GLOpcodeMultiDrawElementsIndirect);
+            {
+                cmd->id         = indirectBufferID_;
+                cmd->mode       = drawBatch_.mode;
+                cmd->type       = drawBatch_.type;
+                cmd->indirect   = reinterpret_cast<const GLvoid*>(drawBatch_.offset);
+                cmd->drawcount  = drawBatch_.drawCount;
+                cmd->stride     = static_cast<GLsizei>(sizeof(GLDrawElementsIndirectCommand));
+            }
+        }
+        else
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdMultiDrawArraysIndirect>(GLOpcodeMultiDrawArraysIndirect);
+            {
+                cmd->id         = indirectBufferID_;
+                cmd->mode       = drawBatch_.mode;
+                cmd->indirect   = reinterpret_cast<const GLvoid*>(drawBatch_.offset);
+                cmd->drawcount  = drawBatch_.drawCount;
+                cmd->stride     = static_cast<GLsizei>(sizeof(GLDrawArraysIndirectCommand));
+            }
+        }
+    }
+
+    drawBatch_ = DrawBatch{};
+}
+
+void GLDeferredCommandBuffer::UploadIndirectData()
+{
+    if (indirectBufferID_ != 0 && !indirectData_.empty())
+    {
+        GLStateManager::Get().BindBuffer(GLBufferTarget::DrawIndirectBuffer, indirectBufferID_);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(indirectData_.size()), indirectData_.data(), GL_STATIC_DRAW);
+    }
+}
+
 void GLDeferredCommandBuffer::AllocOpcode(const GLOpcode opcode)
 {
+    /* Any other command ends the current draw batch and the current run of shadowable state commands */
+    FlushDrawBatch();
+    stateCommands_.clear();
     buffer_.AllocOpcode(opcode);
 }
 
 template <typename TCommand>
 TCommand* GLDeferredCommandBuffer::AllocCommand(const GLOpcode opcode, std::size_t payloadSize)
 {
+    /* Any other command ends the current draw batch and the current run of shadowable state commands */
+    FlushDrawBatch();
+    stateCommands_.clear();
     return buffer_.AllocCommand<TCommand>(opcode, payloadSize);
 }
 
+template <typename TCommand>
+TCommand* GLDeferredCommandBuffer::AllocStateCommand(const GLOpcode opcode, std::uint32_t key0, std::uint32_t key1, std::size_t payloadSize)
+{
+    if (!stateEliminationEnabled_)
+        return AllocCommand<TCommand>(opcode, payloadSize);
+
+    /* Pending draw commands consume all previous state commands */
+    if (drawBatch_.drawCount > 0)
+    {
+        FlushDrawBatch();
+        stateCommands_.clear();
+    }
+
+    /* Reuse memory of shadowed state command */
+    for (const StateCommand& stateCmd : stateCommands_)
+    {
+        if (stateCmd.opcode == opcode && stateCmd.key0 == key0 && stateCmd.key1 == key1 && stateCmd.payloadSize == payloadSize)
+            return reinterpret_cast<TCommand*>(stateCmd.command);
+    }
+
+    TCommand* cmd = buffer_.AllocCommand<TCommand>(opcode, payloadSize);
+    stateCommands_.push_back(StateCommand{ opcode, key0, key1, payloadSize, cmd });
+    return cmd;
+}
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,7 @@
 
 #include "GLCommandBuffer.h"
 #include "GLCommandOpcode.h"
+#include "GLCommandListNV.h"
 #include "../../VirtualCommandBuffer.h"
 #include <memory>
 #include <vector>
@@ -37,7 +38,8 @@ class GLShaderPipeline;
 class GL2XSampler;
 #endif
 
-using GLVirtualCommandBuffer = VirtualCommandBuffer<GLOpcode>;
+// GL commands consist mostly of 32-bit fields (GLenum, GLint, GLuint), so align all commands to 4 bytes.
+using GLVirtualCommandBuffer = VirtualCommandBuffer<GLOpcode, sizeof(std::uint32_t)>;
 
 class GLDeferredCommandBuffer final : public GLCommandBuffer
 {
@@ -49,6 +51,7 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
     public:
 
         GLDeferredCommandBuffer(long flags, std::size_t initialBufferSize = 1024);
+        ~GLDeferredCommandBuffer();
 
     public:
 
@@ -70,6 +73,28 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
             return flags_;
         }
 
+        // Returns the CPU copy of the indirect draw commands of all draw batches.
+        inline const std::vector<char>& GetIndirectData() const
+        {
+            return indirectData_;
+        }
+
+        // Returns the ID of the indirect buffer that is referenced by the multi-draw-indirect commands of all draw batches.
+        inline GLuint GetIndirectBufferID() const
+        {
+            return indirectBufferID_;
+        }
+
+        #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+
+        // Returns the NV command list this command buffer has been compiled into, or null if not available.
+        inline const std::unique_ptr<GLCommandListNV>& GetCommandListNV() const
+        {
+            return commandListNV_;
+        }
+
+        #endif // /LLGL_GLEXT_COMMAND_LIST_NV
+
         #ifdef LLGL_ENABLE_JIT_COMPILER
 
         // Returns the just-in-time compiled command buffer that can be executed natively, or null if not available.
@@ -95,6 +120,7 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
     private:
 
         void BindBufferBase(const GLBufferTarget bufferTarget, const GLBuffer& bufferGL, std::uint32_t slot);
+        void BindBufferRange(const GLBufferTarget bufferTarget, const GLBuffer& bufferGL, std::uint32_t slot, std::uint64_t offset, std::uint64_t size);
         void BindBuffersBase(const GLBufferTarget bufferTarget, std::uint32_t first, std::uint32_t count, const Buffer *const *const buffers);
         void BindTexture(GLTexture& textureGL, std::uint32_t slot);
         void BindImageTexture(const GLTexture& textureGL, std::uint32_t slot);
@@ -103,6 +129,18 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         void BindGL2XSampler(const GL2XSampler& samplerGL2X, std::uint32_t slot);
         #endif
 
+        /*
+        Appends a direct draw command to the current draw batch, so consecutive draws can be merged into a single multi-draw-indirect command.
+        Returns false if draw batching is not supported or the draw command cannot be represented as indirect draw command.
+        */
+        bool BatchDraw(bool indexed, GLuint count, GLuint instanceCount, GLuint first, GLint baseVertex, GLuint baseInstance);
+
+        // Encodes all draw commands of the current draw batch.
+        void FlushDrawBatch();
+
+        // Uploads the indirect draw commands of all draw batches into the indirect buffer.
+        void UploadIndirectData();
+
         /* Allocates only an opcode for empty commands */
         void AllocOpcode(const GLOpcode opcode);
 
@@ -110,11 +148,53 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         template <typename TCommand>
         TCommand* AllocCommand(const GLOpcode opcode, std::size_t payloadSize = 0);
 
+        /*
+        Allocates a new state command that is identified by its opcode and the specified key.
+        If a state command with the same opcode, key, and payload size has already been encoded since the last non-state command,
+        that command is shadowed and its memory is returned instead, i.e. the new command takes the place of the previous one.
+        This is only valid for state commands whose key determines all states they modify.
+        */
+        template <typename TCommand>
+        TCommand* AllocStateCommand(const GLOpcode opcode, std::uint32_t key0 = 0, std::uint32_t key1 = 0, std::size_t payloadSize = 0);
+
     private:
 
         long                        flags_                  = 0;
         GLVirtualCommandBuffer      buffer_;
 
+        // Consecutive direct draw commands that share the same primitive topology and index type.
+        struct DrawBatch
+        {
+            bool        indexed     = false;
+            GLenum      mode        = 0;
+            GLenum      type        = 0;
+            GLsizeiptr  indexStride = 0;
+            GLintptr    offset      = 0;    // Byte offset into the indirect data of the first draw command.
+            GLsizei     drawCount   = 0;
+        };
+
+        // State command that can still be shadowed by a subsequent state command.
+        struct StateCommand
+        {
+            GLOpcode        opcode;
+            std::uint32_t   key0;
+            std::uint32_t   key1;
+            std::size_t     payloadSize;
+            void*           command;
+        };
+
+        bool                        stateEliminationEnabled_    = false;
+        std::vector<StateCommand>   stateCommands_;
+
+        bool                        drawBatchingEnabled_        = false;
+        DrawBatch                   drawBatch_;
+        std::vector<char>           indirectData_;
+        GLuint                      indirectBufferID_           = 0;
+
+        #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+        std::unique_ptr<GLCommandListNV> commandListNV_;
+        #endif // /LLGL_GLEXT_COMMAND_LIST_NV
+
         #ifdef LLGL_ENABLE_JIT_COMPILER
         std::unique_ptr<JITProgram> executable_;
         std::uint32_t               maxNumViewports_        = 0;
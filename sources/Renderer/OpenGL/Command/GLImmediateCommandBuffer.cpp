@@ -13,6 +13,7 @@
 #include <LLGL/Utils/ForRange.h>
 
 #include "../../TextureUtils.h"
+#include "../../BufferUtils.h"
 #include "../GLSwapChain.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
@@ -20,6 +21,7 @@
 #include "../GLTypes.h"
 #include "../GLCore.h"
 #include "../../CheckedCast.h"
+#include "../../FrameCounters.h"
 #include "../../../Core/Assertion.h"
 
 #include "../Shader/GLShaderProgram.h"
@@ -60,6 +62,8 @@ GLImmediateCommandBuffer::GLImmediateCommandBuffer(GLStateManager& stateManager)
 
 void GLImmediateCommandBuffer::Begin()
 {
+    LLGL_FRAME_COUNTER_BEGIN();
+
     ResetRenderState();
 }
 
@@ -72,6 +76,12 @@ void GLImmediateCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& cmdBufferGL = LLGL_CAST(const GLCommandBuffer&, deferredCommandBuffer);
     ExecuteGLCommandBuffer(cmdBufferGL, *stateMngr_);
+    LLGL_FRAME_COUNTER_EXECUTE(cmdBufferGL.GetFrameCounters());
+}
+
+void GLImmediateCommandBuffer::TrimMemory()
+{
+    // dummy
 }
 
 /* ----- Blitting ----- */
@@ -82,6 +92,8 @@ void GLImmediateCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferUpdates);
+
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     dstBufferGL.BufferSubData(static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(dataSize), data);
 }
@@ -93,6 +105,8 @@ void GLImmediateCommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     auto& srcBufferGL = LLGL_CAST(GLBuffer&, srcBuffer);
     dstBufferGL.CopyBufferSubData(
@@ -111,6 +125,8 @@ void GLImmediateCommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     auto& srcTextureGL = LLGL_CAST(GLTexture&, srcTexture);
     srcTextureGL.CopyImageToBuffer(
@@ -129,6 +145,8 @@ void GLImmediateCommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     if (fillSize == Constants::wholeSize)
         dstBufferGL.ClearBufferData(value);
@@ -136,6 +154,27 @@ void GLImmediateCommandBuffer::FillBuffer(
         dstBufferGL.ClearBufferSubData(static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(fillSize), value);
 }
 
+void GLImmediateCommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    /* Forward patterns of a single 32-bit value to the default fill command */
+    std::uint32_t value = 0;
+    if (GetUniformFillPatternValue(pattern, patternSize, value))
+        return FillBuffer(dstBuffer, dstOffset, value, fillSize);
+
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
+    auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+    if (fillSize == Constants::wholeSize)
+        dstBufferGL.ClearBufferPattern(0, dstBufferGL.GetSize(), pattern, static_cast<GLsizei>(patternSize));
+    else
+        dstBufferGL.ClearBufferPattern(static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(fillSize), pattern, static_cast<GLsizei>(patternSize));
+}
+
 void GLImmediateCommandBuffer::CopyTexture(
     Texture&                dstTexture,
     const TextureLocation&  dstLocation,
@@ -143,6 +182,8 @@ void GLImmediateCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureGL = LLGL_CAST(GLTexture&, dstTexture);
     auto& srcTextureGL = LLGL_CAST(GLTexture&, srcTexture);
     dstTextureGL.CopyImageSubData(
@@ -163,6 +204,8 @@ void GLImmediateCommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureGL = LLGL_CAST(GLTexture&, dstTexture);
     auto& srcBufferGL = LLGL_CAST(GLBuffer&, srcBuffer);
     dstTextureGL.CopyImageFromBuffer(
@@ -180,6 +223,8 @@ void GLImmediateCommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     if (dstRegion.extent.depth != 1)
         return /*GL_INVALID_VALUE*/;
 
@@ -196,12 +241,16 @@ void GLImmediateCommandBuffer::CopyTextureFromFramebuffer(
 
 void GLImmediateCommandBuffer::GenerateMips(Texture& texture)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     GLMipGenerator::Get().GenerateMipsForTexture(*stateMngr_, textureGL);
 }
 
 void GLImmediateCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     GLMipGenerator::Get().GenerateMipsRangeForTexture(
         *stateMngr_,
@@ -213,6 +262,11 @@ void GLImmediateCommandBuffer::GenerateMips(Texture& texture, const TextureSubre
     );
 }
 
+void GLImmediateCommandBuffer::CompressTexture(Texture& /*dstTexture*/, Texture& /*srcTexture*/, const TextureSubresource& /*subresource*/)
+{
+    // dummy
+}
+
 /* ----- Viewport and Scissor ----- */
 
 void GLImmediateCommandBuffer::SetViewport(const Viewport& viewport)
@@ -281,8 +335,17 @@ void GLImmediateCommandBuffer::SetScissors(std::uint32_t numScissors, const Scis
 
 /* ----- Input Assembly ------ */
 
+// Binds the vertex buffers that are sourced by the currently bound VAO, if its vertex formats are separate from its buffers.
+static void BindVertexBufferBindings(GLStateManager& stateMngr, const GLVertexBufferBindings& bindings)
+{
+    if (!bindings.Empty())
+        stateMngr.BindVertexBuffers(0, bindings.Count(), bindings.buffers.data(), bindings.offsets.data(), bindings.strides.data());
+}
+
 void GLImmediateCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     if ((buffer.GetBindFlags() & BindFlags::VertexBuffer) != 0)
     {
         /* Bind vertex buffer */
@@ -299,12 +362,17 @@ void GLImmediateCommandBuffer::SetVertexBuffer(Buffer& buffer)
         {
             /* Bind vertex array with native VAO */
             stateMngr_->BindVertexArray(vertexBufferGL.GetVaoID());
+            BindVertexBufferBindings(*stateMngr_, vertexBufferGL.GetVertexBufferBindings());
         }
+
+        SetVertexTransformFeedbackRenderState(vertexBufferGL.GetTransformFeedbackID());
     }
 }
 
 void GLImmediateCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     if ((bufferArray.GetBindFlags() & BindFlags::VertexBuffer) != 0)
     {
         /* Bind vertex buffer */
@@ -321,12 +389,17 @@ void GLImmediateCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         {
             /* Bind vertex array with native VAO */
             stateMngr_->BindVertexArray(vertexBufferArrayGL.GetVaoID());
+            BindVertexBufferBindings(*stateMngr_, vertexBufferArrayGL.GetVertexBufferBindings());
         }
+
+        SetVertexTransformFeedbackRenderState(vertexBufferArrayGL.GetTransformFeedbackID());
     }
 }
 
 void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     /* Bind index buffer deferred (can only be bound to the active VAO) */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindElementArrayBufferToVAO(bufferGL.GetID(), bufferGL.IsIndexType16Bits());
@@ -335,6 +408,8 @@ void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer)
 
 void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     /* Bind index buffer deferred (can only be bound to the active VAO) */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     const bool indexType16Bits = (format == Format::R16UInt);
@@ -346,12 +421,16 @@ void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format forma
 
 void GLImmediateCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
+    LLGL_FRAME_COUNTER_INC(resourceHeapBindings);
+
     auto& resourceHeapGL = LLGL_CAST(GLResourceHeap&, resourceHeap);
     resourceHeapGL.Bind(*stateMngr_, descriptorSet);
 }
 
 void GLImmediateCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
+    LLGL_FRAME_COUNTER_RESOURCE(resource);
+
     auto* pipelineLayoutGL = GetBoundPipelineLayout();
     if (pipelineLayoutGL == nullptr)
         return /*GL_INVALID_VALUE*/;
@@ -413,6 +492,40 @@ void GLImmediateCommandBuffer::SetResource(std::uint32_t descriptor, Resource& r
     }
 }
 
+void GLImmediateCommandBuffer::SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t size)
+{
+    LLGL_FRAME_COUNTER_RESOURCE(buffer);
+
+    auto* pipelineLayoutGL = GetBoundPipelineLayout();
+    if (pipelineLayoutGL == nullptr)
+        return /*GL_INVALID_VALUE*/;
+
+    const auto& bindingList = pipelineLayoutGL->GetBindings();
+    if (!(descriptor < bindingList.size()))
+        return /*GL_INVALID_INDEX*/;
+
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    const GLintptr      rangeOffset = static_cast<GLintptr>(offset);
+    const GLsizeiptr    rangeSize   = static_cast<GLsizeiptr>(GetBufferRangeSize(static_cast<std::uint64_t>(bufferGL.GetSize()), offset, size));
+
+    const auto& binding = bindingList[descriptor];
+    switch (binding.type)
+    {
+        case GLResourceType_UBO:
+            stateMngr_->BindBufferRange(GLBufferTarget::UniformBuffer, binding.slot, bufferGL.GetID(), rangeOffset, rangeSize);
+            break;
+
+        case GLResourceType_SSBO:
+            stateMngr_->BindBufferRange(GLBufferTarget::ShaderStorageBuffer, binding.slot, bufferGL.GetID(), rangeOffset, rangeSize);
+            break;
+
+        default:
+            /* Other bindings cannot be bound with a range, so bind the entire buffer */
+            SetResource(descriptor, static_cast<Resource&>(buffer));
+            break;
+    }
+}
+
 void GLImmediateCommandBuffer::ResetResourceSlots(
     const ResourceType  resourceType,
     std::uint32_t       firstSlot,
@@ -428,6 +541,7 @@ void GLImmediateCommandBuffer::ResetResourceSlots(
         switch (resourceType)
         {
             case ResourceType::Undefined:
+            case ResourceType::AccelerationStructure:
             break;
 
             case ResourceType::Buffer:
@@ -468,26 +582,32 @@ void GLImmediateCommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       /*swapBufferIndex*/)
 {
+    LLGL_FRAME_COUNTER_INC(renderPassSections);
+
     /* Bind render target and update state manager if GL context has switched */
     auto nextStateMngr = stateMngr_;
     stateMngr_->BindRenderTarget(renderTarget, &nextStateMngr);
     stateMngr_ = nextStateMngr;
 
     /* Clear render target attachments with render pass */
-    if (renderPass != nullptr)
-    {
-        auto renderPassGL = LLGL_CAST(const GLRenderPass*, renderPass);
+    auto renderPassGL = LLGL_CAST(const GLRenderPass*, renderPass);
+    if (renderPassGL != nullptr)
         stateMngr_->ClearAttachmentsWithRenderPass(*renderPassGL, numClearValues, clearValues);
-    }
+
+    SetRenderPassRenderState(renderPassGL);
 }
 
 void GLImmediateCommandBuffer::EndRenderPass()
 {
-    // dummy
+    /* Resolve render target and invalidate attachments with render pass */
+    stateMngr_->EndRenderPass(GetBoundRenderPass());
+    SetRenderPassRenderState(nullptr);
 }
 
 void GLImmediateCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     if ((flags & ClearFlags::Color) != 0)
     {
         glClearColor(
@@ -509,6 +629,8 @@ void GLImmediateCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 
 void GLImmediateCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     stateMngr_->ClearBuffers(numAttachments, attachments);
 }
 
@@ -545,6 +667,13 @@ void GLImmediateCommandBuffer::SetUniforms(std::uint32_t first, const void* data
     const std::uint32_t dataSizeInWords = dataSize / 4;
     const auto& uniformMap = boundPipelineState->GetUniformMap();
 
+    /* Pack uniforms into the emulated uniform block if any of them are declared inside a uniform block */
+    if (boundPipelineState->HasUniformBlock())
+    {
+        boundPipelineState->SetUniformBlockData(*stateMngr_, first, data, dataSize);
+        return;
+    }
+
     for (auto words = reinterpret_cast<const std::uint32_t*>(data), wordsEnd = words + dataSizeInWords; words != wordsEnd; ++first)
     {
         if (first >= uniformMap.size())
@@ -561,20 +690,24 @@ void GLImmediateCommandBuffer::SetUniforms(std::uint32_t first, const void* data
 
 void GLImmediateCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_FRAME_COUNTER_INC(querySections);
+
     /* Begin query with internal target */
     auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
     queryHeapGL.Begin(query);
 }
 
-void GLImmediateCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t /*query*/)
+void GLImmediateCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    /* Begin query with internal target */
+    /* End query with internal target */
     auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
-    queryHeapGL.End();
+    queryHeapGL.End(query);
 }
 
 void GLImmediateCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_FRAME_COUNTER_INC(renderConditionSections);
+
     #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
     auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
     glBeginConditionalRender(queryHeapGL.GetID(query), GLTypes::Map(mode));
@@ -592,6 +725,8 @@ void GLImmediateCommandBuffer::EndRenderCondition()
 
 void GLImmediateCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
+    LLGL_FRAME_COUNTER_INC(streamOutputSections);
+
     /* Bind transform feedback buffers */
     GLuint soTargets[LLGL_MAX_NUM_SO_BUFFERS];
     numBuffers = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
@@ -602,6 +737,15 @@ void GLImmediateCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffe
         soTargets[i] = bufferGL->GetID();
     }
 
+    #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+    /* Bind transform feedback object of the first buffer before its indexed bindings, so it records the number of captured vertices */
+    if (numBuffers > 0)
+    {
+        if (GLuint transformFeedbackID = LLGL_CAST(GLBuffer*, buffers[0])->GetTransformFeedbackID())
+            glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, transformFeedbackID);
+    }
+    #endif // /LLGL_GLEXT_TRANSFORM_FEEDBACK2
+
     stateMngr_->BindBuffersBase(GLBufferTarget::TransformFeedbackBuffer, 0, static_cast<GLsizei>(numBuffers), soTargets);
 
     /* Begin transform feedback section */
@@ -626,6 +770,12 @@ void GLImmediateCommandBuffer::EndStreamOutput()
     else if (HasExtension(GLExt::NV_transform_feedback))
         glEndTransformFeedbackNV();
     #endif
+
+    #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+    /* Restore default transform feedback object */
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+    #endif // /LLGL_GLEXT_TRANSFORM_FEEDBACK2
 }
 
 /* ----- Drawing ----- */
@@ -638,6 +788,9 @@ The indices actually store the index start offset, but must be passed to GL as a
 
 void GLImmediateCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     glDrawArrays(
         GetDrawMode(),
         static_cast<GLint>(firstVertex),
@@ -647,6 +800,9 @@ void GLImmediateCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t fir
 
 void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     glDrawElements(
         GetDrawMode(),
         static_cast<GLsizei>(numIndices),
@@ -657,6 +813,9 @@ void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32
 
 void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
     glDrawElementsBaseVertex(
         GetDrawMode(),
@@ -670,6 +829,9 @@ void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32
 
 void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     glDrawArraysInstanced(
         GetDrawMode(),
         static_cast<GLint>(firstVertex),
@@ -680,6 +842,9 @@ void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uin
 
 void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     #ifdef LLGL_GLEXT_BASE_INSTANCE
     glDrawArraysInstancedBaseInstance(
         GetDrawMode(),
@@ -693,6 +858,9 @@ void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uin
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     glDrawElementsInstanced(
         GetDrawMode(),
         static_cast<GLsizei>(numIndices),
@@ -704,6 +872,9 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
     glDrawElementsInstancedBaseVertex(
         GetDrawMode(),
@@ -718,6 +889,9 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     #ifdef LLGL_GLEXT_BASE_INSTANCE
     glDrawElementsInstancedBaseVertexBaseInstance(
         GetDrawMode(),
@@ -733,6 +907,9 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     #ifdef LLGL_GLEXT_DRAW_INDIRECT
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DrawIndirectBuffer, bufferGL.GetID());
@@ -747,6 +924,9 @@ void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset
 
 void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     #ifdef LLGL_GLEXT_DRAW_INDIRECT
     /* Bind indirect argument buffer */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
@@ -782,6 +962,9 @@ void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset
 
 void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     #ifdef LLGL_GLEXT_DRAW_INDIRECT
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DrawIndirectBuffer, bufferGL.GetID());
@@ -797,6 +980,9 @@ void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
 
 void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+    stateMngr_->FlushPendingStates();
+
     #ifdef LLGL_GLEXT_DRAW_INDIRECT
     /* Bind indirect argument buffer */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
@@ -832,24 +1018,111 @@ void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
     #endif
 }
 
+void GLImmediateCommandBuffer::DrawIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void GLImmediateCommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         /*argsBuffer*/,
+    std::uint64_t   /*argsOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    std::uint32_t   /*maxNumCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void GLImmediateCommandBuffer::DrawMeshTasks(std::uint32_t /*numWorkGroupsX*/, std::uint32_t /*numWorkGroupsY*/, std::uint32_t /*numWorkGroupsZ*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void GLImmediateCommandBuffer::DrawMeshTasksIndirect(Buffer& /*buffer*/, std::uint64_t /*offset*/, std::uint32_t /*numCommands*/, std::uint32_t /*stride*/)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    // dummy
+}
+
+void GLImmediateCommandBuffer::DrawStreamOutput()
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    #ifdef LLGL_GLEXT_TRANSFORM_FEEDBACK2
+    /* Vertex count is taken from the transform feedback object of the vertex buffer; it is 0 if GL_ARB_transform_feedback2 is not supported */
+    if (GLuint transformFeedbackID = GetVertexTransformFeedback())
+    {
+        stateMngr_->FlushPendingStates();
+        glDrawTransformFeedback(GetDrawMode(), transformFeedbackID);
+    }
+    #endif // /LLGL_GLEXT_TRANSFORM_FEEDBACK2
+}
+
 /* ----- Compute ----- */
 
 void GLImmediateCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     #ifdef LLGL_GLEXT_COMPUTE_SHADER
     glDispatchCompute(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    stateMngr_->NotifyComputeDispatch();
     #endif
 }
 
 void GLImmediateCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     #ifdef LLGL_GLEXT_COMPUTE_SHADER
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DispatchIndirectBuffer, bufferGL.GetID());
     glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+    stateMngr_->NotifyComputeDispatch();
     #endif
 }
 
+void GLImmediateCommandBuffer::CompactIndirectArguments(
+    Buffer&         /*dstBuffer*/,
+    std::uint64_t   /*dstOffset*/,
+    Buffer&         /*countBuffer*/,
+    std::uint64_t   /*countOffset*/,
+    Buffer&         /*srcBuffer*/,
+    std::uint64_t   /*srcOffset*/,
+    Buffer&         /*visibilityBuffer*/,
+    std::uint64_t   /*visibilityOffset*/,
+    std::uint32_t   /*numCommands*/,
+    std::uint32_t   /*stride*/)
+{
+    // dummy
+}
+
+/* ----- Ray Tracing ----- */
+
+void GLImmediateCommandBuffer::BuildAccelerationStructure(AccelerationStructure& /*accelerationStructure*/, const AccelerationStructureBuildDescriptor& /*buildDesc*/)
+{
+    // dummy
+}
+
+void GLImmediateCommandBuffer::CopyAccelerationStructure(AccelerationStructure& /*dstAccelerationStructure*/, AccelerationStructure& /*srcAccelerationStructure*/, bool /*compact*/)
+{
+    // dummy
+}
+
 /* ----- Debugging ----- */
 
 void GLImmediateCommandBuffer::PushDebugGroup(const char* name)
@@ -7,22 +7,68 @@
 
 #include "GLExtensionRegistry.h"
 #include <array>
+#include <atomic>
+#include <mutex>
 
 
 namespace LLGL
 {
 
 
-static std::array<bool, static_cast<std::size_t>(GLExt::Count)> g_registeredExtensions { { false } };
+static std::array<std::atomic<bool>, static_cast<std::size_t>(GLExt::Count)>                       g_registeredExtensions {};
+static std::array<std::atomic<GLDeferredExtensionLoader>, static_cast<std::size_t>(GLExt::Count)>  g_deferredExtensionLoaders {};
+static std::mutex                                                                                   g_deferredExtensionMutex;
 
 void RegisterExtension(GLExt extension)
 {
-    g_registeredExtensions[static_cast<std::size_t>(extension)] = true;
+    g_registeredExtensions[static_cast<std::size_t>(extension)].store(true, std::memory_order_release);
+}
+
+void RegisterDeferredExtension(GLExt extension, GLDeferredExtensionLoader loader)
+{
+    g_deferredExtensionLoaders[static_cast<std::size_t>(extension)].store(loader, std::memory_order_release);
+}
+
+// Loads the procedures of a deferred extension once; other threads wait until the loader has finished.
+static bool LoadDeferredExtensionOnce(const GLExt extension)
+{
+    const std::size_t idx = static_cast<std::size_t>(extension);
+    std::lock_guard<std::mutex> guard{ g_deferredExtensionMutex };
+
+    if (g_registeredExtensions[idx].load(std::memory_order_acquire))
+        return true;
+
+    if (GLDeferredExtensionLoader loader = g_deferredExtensionLoaders[idx].load(std::memory_order_acquire))
+    {
+        /* Clear loader only after the result has been stored, so no thread observes neither of them */
+        if (loader(extension))
+            g_registeredExtensions[idx].store(true, std::memory_order_release);
+        g_deferredExtensionLoaders[idx].store(nullptr, std::memory_order_release);
+    }
+
+    return g_registeredExtensions[idx].load(std::memory_order_acquire);
 }
 
 bool HasExtension(const GLExt extension)
 {
-    return g_registeredExtensions[static_cast<std::size_t>(extension)];
+    const std::size_t idx = static_cast<std::size_t>(extension);
+    if (g_registeredExtensions[idx].load(std::memory_order_acquire))
+        return true;
+    if (g_deferredExtensionLoaders[idx].load(std::memory_order_acquire) != nullptr)
+        return LoadDeferredExtensionOnce(extension);
+
+    /* Check registry again in case another thread has finished loading this extension in the meantime */
+    return g_registeredExtensions[idx].load(std::memory_order_acquire);
+}
+
+bool IsExtensionSupported(const GLExt extension)
+{
+    const std::size_t idx = static_cast<std::size_t>(extension);
+    return
+    (
+        g_registeredExtensions[idx].load(std::memory_order_acquire) ||
+        g_deferredExtensionLoaders[idx].load(std::memory_order_acquire) != nullptr
+    );
 }
 
 bool HasNativeSamplers()
@@ -35,6 +81,11 @@ bool HasNativeVAO()
     return HasExtension(GLExt::ARB_vertex_array_object);
 }
 
+bool HasVertexAttribBinding()
+{
+    return HasExtension(GLExt::ARB_vertex_attrib_binding);
+}
+
 
 } // /namespace LLGL
 
@@ -25,6 +25,7 @@ enum class GLExt
 {
     /* OpenGL core extensions (ARB) */
     ARB_base_instance = 0,              // GL 4.1
+    ARB_bindless_texture,
     ARB_clear_buffer_object,
     ARB_clear_texture,
     ARB_clip_control,
@@ -47,11 +48,14 @@ enum class GLExt
     ARB_instanced_arrays,               // GL 2.1
     ARB_internalformat_query,
     ARB_internalformat_query2,
+    ARB_invalidate_subdata,             // GL 4.3
     ARB_multitexture,
     ARB_multi_bind,                     // GL 4.3
     ARB_multi_draw_indirect,
+    ARB_parallel_shader_compile,
     ARB_occlusion_query,
     ARB_pipeline_statistics_query,
+    ARB_query_buffer_object,            // GL 4.4
     ARB_polygon_offset_clamp,
     ARB_program_interface_query,        // GL 4.2
     ARB_sampler_objects,                // GL 3.2
@@ -72,9 +76,11 @@ enum class GLExt
     ARB_texture_storage_multisample,
     ARB_texture_view,                   // GL 4.3
     ARB_timer_query,
+    ARB_transform_feedback2,            // GL 4.0
     ARB_transform_feedback3,
     ARB_uniform_buffer_object,
     ARB_vertex_array_object,
+    ARB_vertex_attrib_binding,          // GL 4.3
     ARB_vertex_buffer_object,
     ARB_vertex_shader,
     ARB_viewport_array,
@@ -86,6 +92,8 @@ enum class GLExt
 
     /* Khronos group extensions (KHR) */
     KHR_debug,
+    KHR_parallel_shader_compile,
+    KHR_shader_subgroup,                // no procedures
 
     /* Multi-vendor extensions (EXT) */
     EXT_blend_color,
@@ -102,32 +110,55 @@ enum class GLExt
 
     /* OpenGLES specific extensions (GLES) */
     OES_tessellation_shader,            // GLES 3.2
+    EXT_multisampled_render_to_texture, // GLES only
 
     /* NVIDIA specific extensions (NV) */
+    NV_command_list,
     NV_conditional_render,              //TODO: part of GL 3.0 core profile
     NV_conservative_raster,             // no procedures
+    NV_shader_buffer_load,
     NV_transform_feedback,
+    NV_uniform_buffer_unified_memory,   // no procedures
+    NV_vertex_buffer_unified_memory,
 
     /* Intel sepcific extensions (INTEL) */
     INTEL_conservative_rasterization,   // no procedures
 
+    /* Oculus VR specific extensions (OVR) */
+    OVR_multiview2,
+
     /* Enumeration entry counter */
     Count,
 };
 
 
+// Loads the procedures of a deferred OpenGL extension and returns true on success.
+using GLDeferredExtensionLoader = bool (*)(GLExt extension);
+
 // Registers the specified OpenGL extension support.
 void RegisterExtension(GLExt extension);
 
-// Returns true if the specified OpenGL extension is supported.
+/*
+Registers the specified OpenGL extension as supported, but defers loading its procedures until the first call to HasExtension.
+The loader is invoked with a current GL context, since every call site queries the extension before using its procedures.
+*/
+void RegisterDeferredExtension(GLExt extension, GLDeferredExtensionLoader loader);
+
+// Returns true if the specified OpenGL extension is supported. Loads the procedures of a deferred extension on first use.
 bool HasExtension(const GLExt extension);
 
+// Returns true if the specified OpenGL extension is supported or pending to be loaded, without loading any procedures.
+bool IsExtensionSupported(const GLExt extension);
+
 // Returns ture if GL_ARB_sampler_objects is supported. Shortcut for 'HasExtension(GLExt::ARB_sampler_objects)'.
 bool HasNativeSamplers();
 
 // Returns true if GL_ARB_vertex_array_object is supported. Shortcut for 'HasExtension(GLExt::ARB_vertex_array_object)'.
 bool HasNativeVAO();
 
+// Returns true if GL_ARB_vertex_attrib_binding is supported, i.e. vertex formats can be specified separately from their vertex buffer bindings.
+bool HasVertexAttribBinding();
+
 
 } // /namespace LLGL
 
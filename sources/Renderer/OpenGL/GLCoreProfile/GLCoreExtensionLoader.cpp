@@ -15,6 +15,10 @@
 #include <string>
 #include <map>
 
+#if defined(__linux__) && defined(LLGL_GL_ENABLE_EGL_HEADLESS)
+#   include <EGL/egl.h>
+#endif
+
 
 namespace LLGL
 {
@@ -35,6 +39,11 @@ bool LoadGLProc(T& procAddr, const char* procName)
     #if defined(_WIN32)
     procAddr = reinterpret_cast<T>(wglGetProcAddress(procName));
     #elif defined(__linux__)
+    #ifdef LLGL_GL_ENABLE_EGL_HEADLESS
+    if (eglGetCurrentContext() != EGL_NO_CONTEXT)
+        procAddr = reinterpret_cast<T>(eglGetProcAddress(procName));
+    else
+    #endif
     procAddr = reinterpret_cast<T>(glXGetProcAddress(reinterpret_cast<const GLubyte*>(procName)));
     #else
     LLGL_TRAP("platform not supported for loading OpenGL extensions");
@@ -105,6 +114,9 @@ bool LoadPixelFormatProcs()
 bool LoadCreateContextProcs()
 {
     #if defined(_WIN32)
+    /* Extension string is optional and only used to query context creation attributes */
+    if (wglGetExtensionsStringARB == nullptr)
+        LOAD_GLPROC_SIMPLE(wglGetExtensionsStringARB);
     return LOAD_GLPROC_SIMPLE(wglCreateContextAttribsARB);
     #else
     return false;
@@ -157,6 +169,16 @@ static bool DECL_LOADGLEXT_PROC(ARB_vertex_array_object)
     return true;
 }
 
+static bool DECL_LOADGLEXT_PROC(ARB_vertex_attrib_binding)
+{
+    LOAD_GLPROC( glBindVertexBuffer     );
+    LOAD_GLPROC( glVertexAttribFormat   );
+    LOAD_GLPROC( glVertexAttribIFormat  );
+    LOAD_GLPROC( glVertexAttribBinding  );
+    LOAD_GLPROC( glVertexBindingDivisor );
+    return true;
+}
+
 static bool DECL_LOADGLEXT_PROC(ARB_vertex_shader)
 {
     LOAD_GLPROC( glEnableVertexAttribArray  );
@@ -203,6 +225,8 @@ static bool DECL_LOADGLEXT_PROC(ARB_uniform_buffer_object)
     LOAD_GLPROC( glGetActiveUniformBlockName );
     LOAD_GLPROC( glUniformBlockBinding       );
     LOAD_GLPROC( glBindBufferBase            );
+    LOAD_GLPROC( glGetUniformIndices         );
+    LOAD_GLPROC( glGetActiveUniformsiv       );
     return true;
 }
 
@@ -491,6 +515,23 @@ static bool DECL_LOADGLEXT_PROC(ARB_texture_view)
     return true;
 }
 
+static bool DECL_LOADGLEXT_PROC(ARB_bindless_texture)
+{
+    LOAD_GLPROC( glGetTextureHandleARB             );
+    LOAD_GLPROC( glGetTextureSamplerHandleARB      );
+    LOAD_GLPROC( glMakeTextureHandleResidentARB    );
+    LOAD_GLPROC( glMakeTextureHandleNonResidentARB );
+    return true;
+}
+
+#ifdef GL_OVR_multiview
+static bool DECL_LOADGLEXT_PROC(OVR_multiview2)
+{
+    LOAD_GLPROC( glFramebufferTextureMultiviewOVR );
+    return true;
+}
+#endif
+
 static bool DECL_LOADGLEXT_PROC(ARB_sampler_objects)
 {
     LOAD_GLPROC( glGenSamplers        );
@@ -608,6 +649,18 @@ static bool DECL_LOADGLEXT_PROC(KHR_debug)
     return true;
 }
 
+static bool DECL_LOADGLEXT_PROC(KHR_parallel_shader_compile)
+{
+    LOAD_GLPROC( glMaxShaderCompilerThreadsKHR );
+    return true;
+}
+
+static bool DECL_LOADGLEXT_PROC(ARB_parallel_shader_compile)
+{
+    LOAD_GLPROC( glMaxShaderCompilerThreadsARB );
+    return true;
+}
+
 static bool DECL_LOADGLEXT_PROC(ARB_clip_control)
 {
     LOAD_GLPROC( glClipControl );
@@ -641,6 +694,18 @@ static bool DECL_LOADGLEXT_PROC(EXT_transform_feedback)
     return true;
 }
 
+static bool DECL_LOADGLEXT_PROC(ARB_transform_feedback2)
+{
+    LOAD_GLPROC( glBindTransformFeedback    );
+    LOAD_GLPROC( glDeleteTransformFeedbacks );
+    LOAD_GLPROC( glGenTransformFeedbacks    );
+    LOAD_GLPROC( glIsTransformFeedback      );
+    LOAD_GLPROC( glPauseTransformFeedback   );
+    LOAD_GLPROC( glResumeTransformFeedback  );
+    LOAD_GLPROC( glDrawTransformFeedback    );
+    return true;
+}
+
 static bool DECL_LOADGLEXT_PROC(NV_transform_feedback)
 {
     LOAD_GLPROC( glBindBufferRangeNV           );
@@ -652,6 +717,32 @@ static bool DECL_LOADGLEXT_PROC(NV_transform_feedback)
     return true;
 }
 
+#ifdef LLGL_GL_ENABLE_VENDOR_EXT
+
+static bool DECL_LOADGLEXT_PROC(NV_command_list)
+{
+    LOAD_GLPROC( glGetCommandHeaderNV );
+    LOAD_GLPROC( glGetStageIndexNV    );
+    LOAD_GLPROC( glDrawCommandsNV     );
+    return true;
+}
+
+static bool DECL_LOADGLEXT_PROC(NV_shader_buffer_load)
+{
+    LOAD_GLPROC( glMakeNamedBufferResidentNV      );
+    LOAD_GLPROC( glIsNamedBufferResidentNV        );
+    LOAD_GLPROC( glGetNamedBufferParameterui64vNV );
+    return true;
+}
+
+static bool DECL_LOADGLEXT_PROC(NV_vertex_buffer_unified_memory)
+{
+    LOAD_GLPROC( glBufferAddressRangeNV );
+    return true;
+}
+
+#endif // /LLGL_GL_ENABLE_VENDOR_EXT
+
 static bool DECL_LOADGLEXT_PROC(ARB_sync)
 {
     LOAD_GLPROC( glFenceSync      );
@@ -766,6 +857,12 @@ static bool DECL_LOADGLEXT_PROC(ARB_multi_draw_indirect)
     return true;
 }
 
+static bool DECL_LOADGLEXT_PROC(ARB_invalidate_subdata)
+{
+    LOAD_GLPROC( glInvalidateFramebuffer );
+    return true;
+}
+
 static bool DECL_LOADGLEXT_PROC(ARB_get_texture_sub_image)
 {
     LOAD_GLPROC( glGetTextureSubImage           );
@@ -882,6 +979,73 @@ static bool DECL_LOADGLEXT_PROC(ARB_direct_state_access)
 #endif // /ifndef(__APPLE__)
 
 
+/* --- Deferred extension loading functions --- */
+
+#ifndef __APPLE__
+
+using LoadGLExtensionFunc = bool (*)(const char* extName, bool abortOnFailure, bool usePlaceholder);
+
+struct GLDeferredExtension
+{
+    GLExt               extensionID;
+    const char*         extName;
+    LoadGLExtensionFunc extLoadingProc;
+};
+
+#define DEFERRED_GLEXT(NAME) \
+    GLDeferredExtension{ GLExt::NAME, "GL_" #NAME, Load_GL_##NAME }
+
+/*
+Optional extensions whose procedures are only loaded on first use, i.e. when HasExtension() is queried for them the first time.
+Every call site of their procedures must be guarded by HasExtension() with the same extension ID.
+*/
+static const GLDeferredExtension g_deferredExtensions[] =
+{
+    DEFERRED_GLEXT( KHR_debug                       ),
+    DEFERRED_GLEXT( ARB_bindless_texture            ),
+    DEFERRED_GLEXT( ARB_gl_spirv                    ),
+    DEFERRED_GLEXT( ARB_copy_image                  ),
+    DEFERRED_GLEXT( ARB_polygon_offset_clamp        ),
+    DEFERRED_GLEXT( ARB_clear_buffer_object         ),
+    DEFERRED_GLEXT( ARB_get_texture_sub_image       ),
+    DEFERRED_GLEXT( ARB_invalidate_subdata          ),
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+    DEFERRED_GLEXT( NV_command_list                 ),
+    DEFERRED_GLEXT( NV_shader_buffer_load           ),
+    DEFERRED_GLEXT( NV_vertex_buffer_unified_memory ),
+    #endif
+};
+
+#undef DEFERRED_GLEXT
+
+static bool g_abortOnDeferredExtensionFailure = true;
+
+static const GLDeferredExtension* FindDeferredExtension(GLExt extensionID)
+{
+    for (const GLDeferredExtension& ext : g_deferredExtensions)
+    {
+        if (ext.extensionID == extensionID)
+            return &ext;
+    }
+    return nullptr;
+}
+
+static bool LoadDeferredExtension(GLExt extensionID)
+{
+    if (const GLDeferredExtension* ext = FindDeferredExtension(extensionID))
+    {
+        if (ext->extLoadingProc(ext->extName, g_abortOnDeferredExtensionFailure, /*usePlaceholder:*/ false))
+            return true;
+
+        /* If failed, use dummy procedures to detect illegal use of OpenGL extension */
+        ext->extLoadingProc(ext->extName, g_abortOnDeferredExtensionFailure, /*usePlaceholder:*/ true);
+    }
+    return false;
+}
+
+#endif // /ifndef(__APPLE__)
+
+
 /* --- Common extension loading functions --- */
 
 static GLExtensionMap QuerySupportedOpenGLExtensions(bool isCoreProfile)
@@ -1037,6 +1201,7 @@ bool LoadSupportedOpenGLExtensions(bool isCoreProfile, bool abortOnFailure)
     ENABLE_GLEXT( ARB_draw_buffers                 );
     ENABLE_GLEXT( EXT_draw_buffers2                );
     ENABLE_GLEXT( EXT_transform_feedback           );
+    ENABLE_GLEXT( ARB_transform_feedback2          );
     ENABLE_GLEXT( ARB_sync                         );
     ENABLE_GLEXT( ARB_polygon_offset_clamp         );
     ENABLE_GLEXT( ARB_copy_buffer                  );
@@ -1085,9 +1250,22 @@ bool LoadSupportedOpenGLExtensions(bool isCoreProfile, bool abortOnFailure)
             RegisterExtension(extensionID);
     };
 
+    auto DeferExtension = [&extensions](GLExt extensionID) -> void
+    {
+        /* Only register deferred loader if OpenGL extension is supported; otherwise use dummy procedures right away */
+        const GLDeferredExtension* ext = FindDeferredExtension(extensionID);
+        if (extensions.find(ext->extName) != extensions.end())
+            RegisterDeferredExtension(extensionID, LoadDeferredExtension);
+        else
+            ext->extLoadingProc(ext->extName, /*abortOnFailure:*/ false, /*usePlaceholder:*/ true);
+    };
+
     #define LOAD_GLEXT(NAME) \
         LoadExtension("GL_" #NAME, Load_GL_##NAME, GLExt::NAME)
 
+    #define DEFER_GLEXT(NAME) \
+        DeferExtension(GLExt::NAME)
+
     #define ENABLE_GLEXT(NAME) \
         EnableExtension("GL_" #NAME, GLExt::NAME)
 
@@ -1097,6 +1275,9 @@ bool LoadSupportedOpenGLExtensions(bool isCoreProfile, bool abortOnFailure)
 
     IncludeImpliedExtensions(extensions);
 
+    /* Optional extensions are loaded on first use to reduce startup time */
+    g_abortOnDeferredExtensionFailure = abortOnFailure;
+
     #if defined(GL_VERSION_3_1) && !defined(GL_GLEXT_PROTOTYPES)
     LOAD_GLEXT( ARB_compatibility );
     #endif
@@ -1104,6 +1285,7 @@ bool LoadSupportedOpenGLExtensions(bool isCoreProfile, bool abortOnFailure)
     /* Load hardware buffer extensions */
     LOAD_GLEXT( ARB_vertex_buffer_object         );
     LOAD_GLEXT( ARB_vertex_array_object          );
+    LOAD_GLEXT( ARB_vertex_attrib_binding        );
     LOAD_GLEXT( ARB_vertex_shader                );
     LOAD_GLEXT( ARB_framebuffer_object           );
     LOAD_GLEXT( ARB_uniform_buffer_object        );
@@ -1136,6 +1318,7 @@ bool LoadSupportedOpenGLExtensions(bool isCoreProfile, bool abortOnFailure)
     LOAD_GLEXT( ARB_texture_compression          );
     LOAD_GLEXT( ARB_texture_multisample          );
     LOAD_GLEXT( ARB_texture_view                 );
+    DEFER_GLEXT( ARB_bindless_texture            );
     LOAD_GLEXT( ARB_sampler_objects              );
 
     /* Load blending extensions */
@@ -1152,29 +1335,41 @@ bool LoadSupportedOpenGLExtensions(bool isCoreProfile, bool abortOnFailure)
     LOAD_GLEXT( ARB_timer_query                  );
     LOAD_GLEXT( ARB_multi_bind                   );
     LOAD_GLEXT( EXT_stencil_two_side             );
-    LOAD_GLEXT( KHR_debug                        );
+    DEFER_GLEXT( KHR_debug                       );
+    LOAD_GLEXT( KHR_parallel_shader_compile      );
+    LOAD_GLEXT( ARB_parallel_shader_compile      );
     LOAD_GLEXT( ARB_clip_control                 );
     LOAD_GLEXT( ARB_draw_buffers                 );
     LOAD_GLEXT( EXT_draw_buffers2                );
     LOAD_GLEXT( EXT_transform_feedback           );
     LOAD_GLEXT( NV_transform_feedback            );
+    LOAD_GLEXT( ARB_transform_feedback2          );
     LOAD_GLEXT( ARB_sync                         );
     LOAD_GLEXT( ARB_internalformat_query         );
     LOAD_GLEXT( ARB_internalformat_query2        );
     LOAD_GLEXT( ARB_ES2_compatibility            );
-    LOAD_GLEXT( ARB_gl_spirv                     );
+    DEFER_GLEXT( ARB_gl_spirv                    );
     LOAD_GLEXT( ARB_texture_storage              );
     LOAD_GLEXT( ARB_texture_storage_multisample  );
     LOAD_GLEXT( ARB_buffer_storage               );
     LOAD_GLEXT( ARB_copy_buffer                  );
-    LOAD_GLEXT( ARB_copy_image                   );
-    LOAD_GLEXT( ARB_polygon_offset_clamp         );
+    DEFER_GLEXT( ARB_copy_image                  );
+    DEFER_GLEXT( ARB_polygon_offset_clamp        );
     LOAD_GLEXT( ARB_shader_image_load_store      );
     LOAD_GLEXT( ARB_framebuffer_no_attachments   );
-    LOAD_GLEXT( ARB_clear_buffer_object          );
+    DEFER_GLEXT( ARB_clear_buffer_object         );
     LOAD_GLEXT( ARB_draw_indirect                );
     LOAD_GLEXT( ARB_multi_draw_indirect          );
-    LOAD_GLEXT( ARB_get_texture_sub_image        );
+    DEFER_GLEXT( ARB_get_texture_sub_image       );
+    DEFER_GLEXT( ARB_invalidate_subdata          );
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+    DEFER_GLEXT( NV_command_list                 );
+    DEFER_GLEXT( NV_shader_buffer_load           );
+    DEFER_GLEXT( NV_vertex_buffer_unified_memory );
+    #endif
+    #ifdef GL_OVR_multiview
+    LOAD_GLEXT( OVR_multiview2                   );
+    #endif
     #ifdef LLGL_GL_ENABLE_DSA_EXT
     LOAD_GLEXT( ARB_direct_state_access          );
     #endif
@@ -1187,13 +1382,19 @@ bool LoadSupportedOpenGLExtensions(bool isCoreProfile, bool abortOnFailure)
     ENABLE_GLEXT( ARB_texture_cube_map             );
     ENABLE_GLEXT( ARB_texture_cube_map_array       );
     ENABLE_GLEXT( ARB_pipeline_statistics_query    );
+    ENABLE_GLEXT( ARB_query_buffer_object          );
     ENABLE_GLEXT( ARB_seamless_cubemap_per_texture );
     ENABLE_GLEXT( ARB_ES3_compatibility            );
+    ENABLE_GLEXT( KHR_shader_subgroup              );
     ENABLE_GLEXT( EXT_texture_array                );
     ENABLE_GLEXT( INTEL_conservative_rasterization );
     ENABLE_GLEXT( NV_conservative_raster           );
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+    ENABLE_GLEXT( NV_uniform_buffer_unified_memory );
+    #endif
 
     #undef LOAD_GLEXT
+    #undef DEFER_GLEXT
     #undef ENABLE_GLEXT
 
     #endif // /__APPLE__
@@ -122,6 +122,13 @@ DECL_GLPROC(PFNGLSAMPLEMASKIPROC,                                   glSampleMask
 
 DECL_GLPROC(PFNGLTEXTUREVIEWPROC,                                   glTextureView,                                  void,           (GLuint, GLenum, GLuint, GLenum, GLuint, GLuint, GLuint, GLuint));
 
+/* GL_ARB_bindless_texture */
+
+DECL_GLPROC(PFNGLGETTEXTUREHANDLEARBPROC,                           glGetTextureHandleARB,                          GLuint64,       (GLuint));
+DECL_GLPROC(PFNGLGETTEXTURESAMPLERHANDLEARBPROC,                    glGetTextureSamplerHandleARB,                   GLuint64,       (GLuint, GLuint));
+DECL_GLPROC(PFNGLMAKETEXTUREHANDLERESIDENTARBPROC,                  glMakeTextureHandleResidentARB,                 void,           (GLuint64));
+DECL_GLPROC(PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC,               glMakeTextureHandleNonResidentARB,              void,           (GLuint64));
+
 /* GL_ARB_sampler_objects */
 
 DECL_GLPROC(PFNGLGENSAMPLERSPROC,                                   glGenSamplers,                                  void,           (GLsizei, GLuint*));
@@ -184,6 +191,14 @@ DECL_GLPROC(PFNGLDELETEVERTEXARRAYSPROC,                            glDeleteVert
 DECL_GLPROC(PFNGLBINDVERTEXARRAYPROC,                               glBindVertexArray,                              void,           (GLuint));
 DECL_GLPROC(PFNGLISVERTEXARRAYPROC,                                 glIsVertexArray,                                GLboolean,      (GLuint));
 
+/* GL_ARB_vertex_attrib_binding */
+
+DECL_GLPROC(PFNGLBINDVERTEXBUFFERPROC,                              glBindVertexBuffer,                             void,           (GLuint, GLuint, GLintptr, GLsizei));
+DECL_GLPROC(PFNGLVERTEXATTRIBFORMATPROC,                            glVertexAttribFormat,                           void,           (GLuint, GLint, GLenum, GLboolean, GLuint));
+DECL_GLPROC(PFNGLVERTEXATTRIBIFORMATPROC,                           glVertexAttribIFormat,                          void,           (GLuint, GLint, GLenum, GLuint));
+DECL_GLPROC(PFNGLVERTEXATTRIBBINDINGPROC,                           glVertexAttribBinding,                          void,           (GLuint, GLuint));
+DECL_GLPROC(PFNGLVERTEXBINDINGDIVISORPROC,                          glVertexBindingDivisor,                         void,           (GLuint, GLuint));
+
 /* GL_ARB_framebuffer_object */
 
 DECL_GLPROC(PFNGLGENRENDERBUFFERSPROC,                              glGenRenderbuffers,                             void,           (GLsizei n, GLuint *));
@@ -402,6 +417,8 @@ DECL_GLPROC(PFNGLGETACTIVEUNIFORMBLOCKIVPROC,                       glGetActiveU
 DECL_GLPROC(PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC,                     glGetActiveUniformBlockName,                    void,           (GLuint, GLuint, GLsizei, GLsizei*, GLchar*));
 DECL_GLPROC(PFNGLUNIFORMBLOCKBINDINGPROC,                           glUniformBlockBinding,                          void,           (GLuint, GLuint, GLuint));
 DECL_GLPROC(PFNGLBINDBUFFERBASEPROC,                                glBindBufferBase,                               void,           (GLenum, GLuint, GLuint));
+DECL_GLPROC(PFNGLGETUNIFORMINDICESPROC,                             glGetUniformIndices,                            void,           (GLuint, GLsizei, const GLchar* const*, GLuint*));
+DECL_GLPROC(PFNGLGETACTIVEUNIFORMSIVPROC,                           glGetActiveUniformsiv,                          void,           (GLuint, GLsizei, const GLuint*, GLenum, GLint*));
 
 /* GL_ARB_shader_storage_buffer_object */
 
@@ -454,6 +471,14 @@ DECL_GLPROC(PFNGLGETOBJECTLABELPROC,                                glGetObjectL
 DECL_GLPROC(PFNGLOBJECTPTRLABELPROC,                                glObjectPtrLabel,                               void,           (const void*, GLsizei, const GLchar*));
 DECL_GLPROC(PFNGLGETOBJECTPTRLABELPROC,                             glGetObjectPtrLabel,                            void,           (const void*, GLsizei, GLsizei*, GLchar*));
 
+/* GL_KHR_parallel_shader_compile */
+
+DECL_GLPROC(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC,                   glMaxShaderCompilerThreadsKHR,                  void,           (GLuint));
+
+/* GL_ARB_parallel_shader_compile */
+
+DECL_GLPROC(PFNGLMAXSHADERCOMPILERTHREADSARBPROC,                   glMaxShaderCompilerThreadsARB,                  void,           (GLuint));
+
 /* GL_ARB_clip_control */
 
 DECL_GLPROC(PFNGLCLIPCONTROLPROC,                                   glClipControl,                                  void,           (GLenum, GLenum));
@@ -466,6 +491,16 @@ DECL_GLPROC(PFNGLENDTRANSFORMFEEDBACKPROC,                          glEndTransfo
 DECL_GLPROC(PFNGLTRANSFORMFEEDBACKVARYINGSPROC,                     glTransformFeedbackVaryings,                    void,           (GLuint, GLsizei, const GLchar *const*, GLenum));
 DECL_GLPROC(PFNGLGETTRANSFORMFEEDBACKVARYINGPROC,                   glGetTransformFeedbackVarying,                  void,           (GLuint, GLuint, GLsizei, GLsizei*, GLsizei*, GLenum*, GLchar*));
 
+/* GL_ARB_transform_feedback2 */
+
+DECL_GLPROC(PFNGLBINDTRANSFORMFEEDBACKPROC,                         glBindTransformFeedback,                        void,           (GLenum, GLuint));
+DECL_GLPROC(PFNGLDELETETRANSFORMFEEDBACKSPROC,                      glDeleteTransformFeedbacks,                     void,           (GLsizei, const GLuint*));
+DECL_GLPROC(PFNGLGENTRANSFORMFEEDBACKSPROC,                         glGenTransformFeedbacks,                        void,           (GLsizei, GLuint*));
+DECL_GLPROC(PFNGLISTRANSFORMFEEDBACKPROC,                           glIsTransformFeedback,                          GLboolean,      (GLuint));
+DECL_GLPROC(PFNGLPAUSETRANSFORMFEEDBACKPROC,                        glPauseTransformFeedback,                       void,           (void));
+DECL_GLPROC(PFNGLRESUMETRANSFORMFEEDBACKPROC,                       glResumeTransformFeedback,                      void,           (void));
+DECL_GLPROC(PFNGLDRAWTRANSFORMFEEDBACKPROC,                         glDrawTransformFeedback,                        void,           (GLenum, GLuint));
+
 /* GL_NV_transform_feedback */
 
 DECL_GLPROC(PFNGLBINDBUFFERRANGENVPROC,                             glBindBufferRangeNV,                            void,           (GLenum, GLuint, GLuint, GLintptr, GLsizeiptr));
@@ -475,6 +510,26 @@ DECL_GLPROC(PFNGLTRANSFORMFEEDBACKVARYINGSNVPROC,                   glTransformF
 DECL_GLPROC(PFNGLGETVARYINGLOCATIONNVPROC,                          glGetVaryingLocationNV,                         GLint,          (GLuint, const GLchar*));
 DECL_GLPROC(PFNGLGETACTIVEVARYINGNVPROC,                            glGetActiveVaryingNV,                           void,           (GLuint, GLuint, GLsizei, GLsizei*, GLsizei*, GLenum*, GLchar*));
 
+#ifdef LLGL_GL_ENABLE_VENDOR_EXT
+
+/* GL_NV_command_list */
+
+DECL_GLPROC(PFNGLGETCOMMANDHEADERNVPROC,                            glGetCommandHeaderNV,                           GLuint,         (GLenum, GLuint));
+DECL_GLPROC(PFNGLGETSTAGEINDEXNVPROC,                               glGetStageIndexNV,                              GLushort,       (GLenum));
+DECL_GLPROC(PFNGLDRAWCOMMANDSNVPROC,                                glDrawCommandsNV,                               void,           (GLenum, GLuint, const GLintptr*, const GLsizei*, GLuint));
+
+/* GL_NV_shader_buffer_load */
+
+DECL_GLPROC(PFNGLMAKENAMEDBUFFERRESIDENTNVPROC,                     glMakeNamedBufferResidentNV,                    void,           (GLuint, GLenum));
+DECL_GLPROC(PFNGLISNAMEDBUFFERRESIDENTNVPROC,                       glIsNamedBufferResidentNV,                      GLboolean,      (GLuint));
+DECL_GLPROC(PFNGLGETNAMEDBUFFERPARAMETERUI64VNVPROC,                glGetNamedBufferParameterui64vNV,               void,           (GLuint, GLenum, GLuint64EXT*));
+
+/* GL_NV_vertex_buffer_unified_memory */
+
+DECL_GLPROC(PFNGLBUFFERADDRESSRANGENVPROC,                          glBufferAddressRangeNV,                         void,           (GLenum, GLuint, GLuint64EXT, GLsizeiptr));
+
+#endif // /LLGL_GL_ENABLE_VENDOR_EXT
+
 /* GL_ARB_sync */
 
 DECL_GLPROC(PFNGLFENCESYNCPROC,                                     glFenceSync,                                    GLsync,         (GLenum, GLbitfield));
@@ -557,6 +612,16 @@ DECL_GLPROC(PFNGLDRAWELEMENTSINDIRECTPROC,                          glDrawElemen
 DECL_GLPROC(PFNGLMULTIDRAWARRAYSINDIRECTPROC,                       glMultiDrawArraysIndirect,                      void,           (GLenum, const void*, GLsizei, GLsizei));
 DECL_GLPROC(PFNGLMULTIDRAWELEMENTSINDIRECTPROC,                     glMultiDrawElementsIndirect,                    void,           (GLenum, GLenum, const void*, GLsizei, GLsizei));
 
+/* GL_ARB_invalidate_subdata */
+
+DECL_GLPROC(PFNGLINVALIDATEFRAMEBUFFERPROC,                         glInvalidateFramebuffer,                        void,           (GLenum, GLsizei, const GLenum*));
+
+/* GL_OVR_multiview */
+
+#ifdef GL_OVR_multiview
+DECL_GLPROC(PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC,                glFramebufferTextureMultiviewOVR,               void,           (GLenum, GLenum, GLuint, GLint, GLint, GLsizei));
+#endif
+
 /* GL_ARB_get_texture_sub_image */
 
 DECL_GLPROC(PFNGLGETTEXTURESUBIMAGEPROC,                            glGetTextureSubImage,                           void,           (GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, GLsizei, void*));
@@ -7,6 +7,7 @@
 
 #include "../GLProfile.h"
 #include "GLCoreExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
 #include <LLGL/RenderSystemFlags.h>
 
 
@@ -123,6 +124,14 @@ void FramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, G
     glFramebufferTextureLayer(target, attachment, texture, level, layer);
 }
 
+void InvalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments)
+{
+    #ifdef GL_ARB_invalidate_subdata
+    if (HasExtension(GLExt::ARB_invalidate_subdata))
+        glInvalidateFramebuffer(target, numAttachments, attachments);
+    #endif
+}
+
 
 } // /namespace GLProfile
 
@@ -80,7 +80,7 @@ static std::vector<ShadingLanguage> GLQueryShadingLanguages()
 
     #if defined GL_ARB_gl_spirv && defined GL_ARB_ES2_compatibility
 
-    if (HasExtension(GLExt::ARB_gl_spirv) && HasExtension(GLExt::ARB_ES2_compatibility))
+    if (IsExtensionSupported(GLExt::ARB_gl_spirv) && HasExtension(GLExt::ARB_ES2_compatibility))
     {
         /* Query supported shader binary formats */
         GLint numBinaryFormats = 0;
@@ -200,14 +200,51 @@ static void GLGetSupportedFeatures(RenderingFeatures& features)
     features.hasInstancing                  = HasExtension(GLExt::ARB_draw_instanced);
     features.hasOffsetInstancing            = HasExtension(GLExt::ARB_base_instance);
     features.hasIndirectDrawing             = HasExtension(GLExt::ARB_draw_indirect);
+    features.hasIndirectCountDrawing        = false;
     features.hasViewportArrays              = HasExtension(GLExt::ARB_viewport_array);
     features.hasConservativeRasterization   = (HasExtension(GLExt::NV_conservative_raster) || HasExtension(GLExt::INTEL_conservative_rasterization));
     features.hasStreamOutputs               = (HasExtension(GLExt::EXT_transform_feedback) || HasExtension(GLExt::NV_transform_feedback));
     features.hasLogicOp                     = true;
     features.hasPipelineStatistics          = HasExtension(GLExt::ARB_pipeline_statistics_query);
     features.hasRenderCondition             = true;
+    features.hasBindlessResources           = IsExtensionSupported(GLExt::ARB_bindless_texture);
+    features.hasSparseResources             = false;
+    features.hasThreadSafeResourceCreation  = false;
+    features.hasVariableRateShading         = false;
+    features.hasShadingRateImage            = false;
+    features.hasMeshShaders                 = false;
+    features.hasTextureCompression          = false;
+    features.hasSubgroupSizeControl         = false;
+    features.hasNativeIOQueue               = false;
+    features.hasMultiview                   = HasExtension(GLExt::OVR_multiview2);
+    #ifdef LLGL_GLEXT_SHADER_BUFFER_LOAD_NV
+    features.hasBufferDeviceAddress         = IsExtensionSupported(GLExt::NV_shader_buffer_load);
+    #endif
+}
+
+#ifdef GL_KHR_shader_subgroup
+
+// Converts the specified GL shader stage bits into StageFlags entries.
+static long GLShaderStageBitsToStageFlags(GLbitfield stages)
+{
+    long flags = 0;
+    if ((stages & GL_VERTEX_SHADER_BIT) != 0)
+        flags |= StageFlags::VertexStage;
+    if ((stages & GL_TESS_CONTROL_SHADER_BIT) != 0)
+        flags |= StageFlags::TessControlStage;
+    if ((stages & GL_TESS_EVALUATION_SHADER_BIT) != 0)
+        flags |= StageFlags::TessEvaluationStage;
+    if ((stages & GL_GEOMETRY_SHADER_BIT) != 0)
+        flags |= StageFlags::GeometryStage;
+    if ((stages & GL_FRAGMENT_SHADER_BIT) != 0)
+        flags |= StageFlags::FragmentStage;
+    if ((stages & GL_COMPUTE_SHADER_BIT) != 0)
+        flags |= StageFlags::ComputeStage;
+    return flags;
 }
 
+#endif // /GL_KHR_shader_subgroup
+
 static void GLGetFeatureLimits(const RenderingFeatures& features, RenderingLimits& limits)
 {
     /* Determine minimal line width range for both aliased and smooth lines */
@@ -308,6 +345,22 @@ static void GLGetFeatureLimits(const RenderingFeatures& features, RenderingLimit
         /* Use maximum number of samples for color buffers as fallbacks for empty render-targets */
         limits.maxNoAttachmentSamples = limits.maxColorAttachments;
     }
+
+    #ifdef GL_OVR_multiview
+    if (HasExtension(GLExt::OVR_multiview2))
+        limits.maxMultiviewViewCount = GLGetUInt(GL_MAX_VIEWS_OVR);
+    #endif // /GL_OVR_multiview
+
+    #ifdef GL_KHR_shader_subgroup
+    if (HasExtension(GLExt::KHR_shader_subgroup))
+    {
+        /* Bits of GL_SUBGROUP_SUPPORTED_FEATURES_KHR match SubgroupOperationFlags */
+        limits.minSubgroupSize      = GLGetUInt(GL_SUBGROUP_SIZE_KHR);
+        limits.maxSubgroupSize      = limits.minSubgroupSize;
+        limits.subgroupOperations   = static_cast<long>(GLGetUInt(GL_SUBGROUP_SUPPORTED_FEATURES_KHR) & 0xFF);
+        limits.subgroupStages       = GLShaderStageBitsToStageFlags(GLGetUInt(GL_SUBGROUP_SUPPORTED_STAGES_KHR));
+    }
+    #endif // /GL_KHR_shader_subgroup
 }
 
 static void GLGetTextureLimits(const RenderingFeatures& features, RenderingLimits& limits)
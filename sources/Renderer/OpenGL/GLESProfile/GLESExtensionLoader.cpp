@@ -55,6 +55,23 @@ using LoadGLExtensionProc = std::function<bool(const char* extName, bool abortOn
 
 /* --- Common GLES extensions --- */
 
+#ifdef GL_EXT_multisampled_render_to_texture
+static bool DECL_LOADGLEXT_PROC(EXT_multisampled_render_to_texture)
+{
+    LOAD_GLPROC( glRenderbufferStorageMultisampleEXT  );
+    LOAD_GLPROC( glFramebufferTexture2DMultisampleEXT );
+    return true;
+}
+#endif
+
+#ifdef GL_OVR_multiview
+static bool DECL_LOADGLEXT_PROC(OVR_multiview2)
+{
+    LOAD_GLPROC( glFramebufferTextureMultiviewOVR );
+    return true;
+}
+#endif
+
 /*static bool DECL_LOADGLEXT_PROC(GL_OES_tessellation_shader)
 {
     LOAD_GLPROC( glPatchParameteriOES );
@@ -136,6 +153,14 @@ bool LoadSupportedOpenGLExtensions(bool isCoreProfile, bool abortOnFailure)
     //LOAD_GLEXT( OES_tessellation_shader );
     //LOAD_GLEXT( ARB_compute_shader      );
 
+    /* Load framebuffer extensions */
+    #ifdef GL_EXT_multisampled_render_to_texture
+    LOAD_GLEXT( EXT_multisampled_render_to_texture );
+    #endif
+    #ifdef GL_OVR_multiview
+    LOAD_GLEXT( OVR_multiview2 );
+    #endif
+
     #undef LOAD_GLEXT
 
     g_OpenGLExtensionsLoaded = true;
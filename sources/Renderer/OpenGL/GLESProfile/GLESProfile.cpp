@@ -130,6 +130,11 @@ void FramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, G
     glFramebufferTextureLayer(target, attachment, texture, level, layer);
 }
 
+void InvalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments)
+{
+    glInvalidateFramebuffer(target, numAttachments, attachments);
+}
+
 
 } // /namespace GLProfile
 
@@ -154,12 +154,23 @@ static void GLGetSupportedFeatures(RenderingFeatures& features, GLint version)
     features.hasInstancing                  = (version >= 300); // GLES 3.0
     features.hasOffsetInstancing            = false;
     features.hasIndirectDrawing             = (version >= 310); // GLES 3.1
+    features.hasIndirectCountDrawing        = false;
     features.hasViewportArrays              = false;
     features.hasConservativeRasterization   = false;
     features.hasStreamOutputs               = (version >= 300); // GLES 3.0
     features.hasLogicOp                     = false;
     features.hasPipelineStatistics          = false;
     features.hasRenderCondition             = false;
+    features.hasBindlessResources           = false;
+    features.hasSparseResources             = false;
+    features.hasThreadSafeResourceCreation  = false;
+    features.hasVariableRateShading         = false;
+    features.hasShadingRateImage            = false;
+    features.hasMeshShaders                 = false;
+    features.hasTextureCompression          = false;
+    features.hasSubgroupSizeControl         = false;
+    features.hasNativeIOQueue               = false;
+    features.hasMultiview                   = HasExtension(GLExt::OVR_multiview2);
 }
 
 static void GLGetFeatureLimits(RenderingLimits& limits, GLint version)
@@ -212,6 +223,11 @@ static void GLGetFeatureLimits(RenderingLimits& limits, GLint version)
     /* Determine tessellation limits */
     limits.maxTessFactor                    = GLGetUInt(GL_MAX_TESS_GEN_LEVEL);
     #endif
+
+    #ifdef GL_OVR_multiview
+    if (HasExtension(GLExt::OVR_multiview2))
+        limits.maxMultiviewViewCount        = GLGetUInt(GL_MAX_VIEWS_OVR);
+    #endif // /GL_OVR_multiview
 }
 
 static void GLGetTextureLimits(const RenderingFeatures& features, RenderingLimits& limits, GLint version)
@@ -72,6 +72,9 @@ void FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GL
 void FramebufferTexture3D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint layer);
 void FramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer);
 
+// Wrapper for glInvalidateFramebuffer; does nothing if GL_ARB_invalidate_subdata is not supported for GL.
+void InvalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments);
+
 
 } // /namespace GLProfile
 
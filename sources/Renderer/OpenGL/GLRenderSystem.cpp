@@ -9,27 +9,33 @@
 #include "GLProfile.h"
 #include "Texture/GLMipGenerator.h"
 #include "Texture/GLTextureViewPool.h"
+#include "Texture/GLTextureHandlePool.h"
 #include "Texture/GLFramebufferCapture.h"
 #include "Ext/GLExtensions.h"
 #include "Ext/GLExtensionRegistry.h"
 #include "RenderState/GLStatePool.h"
 #include "../RenderSystemUtils.h"
+#include "../FileLoadUtils.h"
 #include "GLTypes.h"
 #include "GLCore.h"
 #include "Shader/GLLegacyShader.h"
 #include "Buffer/GLBufferWithVAO.h"
 #include "Buffer/GLBufferArrayWithVAO.h"
+#include "Buffer/GLStreamingBuffer.h"
+#include "Buffer/GLVertexArrayCache.h"
 #include "../CheckedCast.h"
 #include "../BufferUtils.h"
 #include "../TextureUtils.h"
 #include "../../Core/CoreUtils.h"
 #include "../../Core/Assertion.h"
+#include "../../Core/VendorTuning.h"
 #include "../../Platform/Debug.h"
 #include "GLRenderingCaps.h"
 #include "Command/GLImmediateCommandBuffer.h"
 #include "Command/GLDeferredCommandBuffer.h"
 #include "RenderState/GLGraphicsPSO.h"
 #include "RenderState/GLComputePSO.h"
+#include "../HostTrace.h"
 #include <LLGL/Utils/ForRange.h>
 
 #ifdef LLGL_OPENGL
@@ -45,31 +51,63 @@ namespace LLGL
 
 static RendererConfigurationOpenGL GetGLProfileFromDesc(const RenderSystemDescriptor& renderSystemDesc)
 {
+    RendererConfigurationOpenGL profile;
     if (auto rendererConfigGL = GetRendererConfiguration<RendererConfigurationOpenGL>(renderSystemDesc))
-        return *rendererConfigGL;
-    else
-        return RendererConfigurationOpenGL{};
+        profile = *rendererConfigGL;
+
+    /* Contexts without error checking can't be combined with debug contexts or report errors to the debug layer */
+    #ifndef LLGL_DEBUG
+    const bool hasDebugLayer = ((renderSystemDesc.flags & RenderSystemFlags::DebugDevice) != 0 || renderSystemDesc.debugger != nullptr);
+    if (hasDebugLayer)
+    #endif
+    {
+        profile.noErrorContext = false;
+    }
+
+    return profile;
 }
 
 GLRenderSystem::GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
-    contextMngr_  { GetGLProfileFromDesc(renderSystemDesc)                           },
+    contextMngr_
+    {
+        GetGLProfileFromDesc(renderSystemDesc),
+        ((renderSystemDesc.flags & RenderSystemFlags::Headless) != 0)
+    },
     debugContext_ { ((renderSystemDesc.flags & RenderSystemFlags::DebugDevice) != 0) }
 {
+    /* Without a swap-chain, the primary GL context must be created immediately */
+    if (contextMngr_.IsHeadless())
+    {
+        auto primaryContext = contextMngr_.AllocContext();
+        GLContext::SetCurrent(primaryContext.get());
+        CreateGLContextDependentDevices(primaryContext->GetStateManager());
+    }
 }
 
 GLRenderSystem::~GLRenderSystem()
 {
+    /* Stop worker threads before any GL object is released */
+    workerContextPool_.reset();
+
     /* Clear all render state containers first, the rest will be deleted automatically */
     GLFramebufferCapture::Get().Clear();
+    GLTextureHandlePool::Get().Clear();
     GLTextureViewPool::Get().Clear();
+    GLVertexArrayCache::Get().Clear();
     GLMipGenerator::Get().Clear();
     GLStatePool::Get().Clear();
+    GLStreamingBuffer::Get().Clear();
+    GLStreamingBuffer::GetPixelUnpack().Clear();
+    GLStreamingBuffer::GetUniform().Clear();
 }
 
 /* ----- Swap-chain ----- */
 
 SwapChain* GLRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
 {
+    if (contextMngr_.IsHeadless())
+        LLGL_TRAP("cannot create swap-chain for headless OpenGL render system");
+
     const bool isFirstSwapChain = swapChains_.empty();
     auto* swapChainGL = swapChains_.emplace<GLSwapChain>(swapChainDesc, surface, contextMngr_);
 
@@ -87,7 +125,7 @@ void GLRenderSystem::Release(SwapChain& swapChain)
 
 /* ----- Command queues ----- */
 
-CommandQueue* GLRenderSystem::GetCommandQueue()
+CommandQueue* GLRenderSystem::GetCommandQueue(const CommandQueueType /*type*/)
 {
     return commandQueue_.get();
 }
@@ -158,7 +196,12 @@ Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const v
 {
     RenderSystem::AssertCreateBuffer(bufferDesc, static_cast<std::uint64_t>(std::numeric_limits<GLsizeiptr>::max()));
 
-    auto bufferGL = CreateGLBuffer(bufferDesc, initialData);
+    /* VAOs are not shared between GL contexts, so vertex buffers cannot be created on a worker context */
+    if ((bufferDesc.bindFlags & BindFlags::VertexBuffer) != 0 && IsWorkerContextRequired())
+        LLGL_TRAP("cannot create OpenGL vertex buffer on a thread without current GL context");
+
+    GLBuffer* bufferGL = nullptr;
+    ExecuteWithGLContext([&]() { bufferGL = CreateGLBuffer(bufferDesc, initialData); });
 
     /* Store meta data for certain types of buffers */
     if ((bufferDesc.bindFlags & BindFlags::IndexBuffer) != 0 && bufferDesc.format != Format::Undefined)
@@ -174,7 +217,7 @@ GLBuffer* GLRenderSystem::CreateGLBuffer(const BufferDescriptor& bufferDesc, con
     if ((bufferDesc.bindFlags & BindFlags::VertexBuffer) != 0)
     {
         /* Create buffer with VAO and build vertex array */
-        auto* bufferGL = buffers_.emplace<GLBufferWithVAO>(bufferDesc.bindFlags);
+        GLBufferWithVAO* bufferGL = buffers_.emplace<GLBufferWithVAO>(bufferDesc.bindFlags);
         {
             GLBufferStorage(*bufferGL, bufferDesc, initialData);
             bufferGL->BuildVertexArray(bufferDesc.vertexAttribs.size(), bufferDesc.vertexAttribs.data());
@@ -184,7 +227,7 @@ GLBuffer* GLRenderSystem::CreateGLBuffer(const BufferDescriptor& bufferDesc, con
     else
     {
         /* Create generic buffer */
-        auto* bufferGL = buffers_.emplace<GLBuffer>(bufferDesc.bindFlags);
+        GLBuffer* bufferGL = buffers_.emplace<GLBuffer>(bufferDesc.bindFlags);
         {
             GLBufferStorage(*bufferGL, bufferDesc, initialData);
         }
@@ -203,6 +246,13 @@ static bool IsBufferArrayWithVertexBufferBinding(std::uint32_t numBuffers, Buffe
     return false;
 }
 
+void GLRenderSystem::CreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, const void* const * initialData, Buffer** outBuffers)
+{
+    RenderSystem::AssertCreateBuffers(numBuffers, bufferDescs, outBuffers);
+    for_range(i, numBuffers)
+        outBuffers[i] = CreateBuffer(bufferDescs[i], (initialData != nullptr ? initialData[i] : nullptr));
+}
+
 BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
     RenderSystem::AssertCreateBufferArray(numBuffers, bufferArray);
@@ -239,6 +289,11 @@ void GLRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+
+    /* Map entire range of streamed buffers with discarded contents, so they can be written without synchronization */
+    if (access == CPUAccess::WriteDiscard && bufferGL.IsStreamed())
+        return bufferGL.MapBufferRange(0, bufferGL.GetSize(), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
     return bufferGL.MapBuffer(GLTypes::Map(access));
 }
 
@@ -310,15 +365,27 @@ Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
 {
     ValidateGLTextureType(textureDesc.type);
 
-    /* Create <GLTexture> object; will result in a GL renderbuffer or texture instance */
-    auto* textureGL = textures_.emplace<GLTexture>(textureDesc);
-
-    /* Initialize either renderbuffer or texture image storage */
-    textureGL->BindAndAllocStorage(textureDesc, imageDesc);
+    GLTexture* textureGL = nullptr;
+    ExecuteWithGLContext(
+        [&]()
+        {
+            /* Create <GLTexture> object; will result in a GL renderbuffer or texture instance */
+            textureGL = textures_.emplace<GLTexture>(textureDesc);
 
+            /* Initialize either renderbuffer or texture image storage */
+            textureGL->BindAndAllocStorage(textureDesc, imageDesc);
+        }
+    );
     return textureGL;
 }
 
+void GLRenderSystem::CreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, const SrcImageDescriptor* const * imageDescs, Texture** outTextures)
+{
+    RenderSystem::AssertCreateTextures(numTextures, textureDescs, outTextures);
+    for_range(i, numTextures)
+        outTextures[i] = CreateTexture(textureDescs[i], (imageDescs != nullptr ? imageDescs[i] : nullptr));
+}
+
 void GLRenderSystem::Release(Texture& texture)
 {
     textures_.erase(&texture);
@@ -326,9 +393,11 @@ void GLRenderSystem::Release(Texture& texture)
 
 void GLRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
-    /* Bind texture and write texture sub data */
+    LLGL_HOST_TRACE_SCOPE("WriteTexture");
+
+    /* Bind texture and write texture sub data through the pixel unpack streaming buffer */
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
-    textureGL.TextureSubImage(textureRegion, imageDesc, false);
+    ExecuteWithGLContext([&]() { textureGL.TextureSubImageStreamed(textureRegion, imageDesc); });
 }
 
 void GLRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
@@ -356,9 +425,7 @@ Sampler* GLRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
     {
         /* Create native GL sampler state */
         LLGL_ASSERT_RENDERING_FEATURE_SUPPORT(hasSamplers);
-        auto* samplerGL = samplers_.emplace<GLSampler>();
-        samplerGL->SamplerParameters(samplerDesc);
-        return samplerGL;
+        return samplers_.emplace<GLSampler>(samplerDesc);
     }
 }
 
@@ -422,6 +489,8 @@ void GLRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateShader");
+
     RenderSystem::AssertCreateShader(shaderDesc);
 
     /* Validate rendering capabilities for required shader type */
@@ -437,11 +506,23 @@ Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
         case ShaderType::Compute:
             LLGL_ASSERT_RENDERING_FEATURE_SUPPORT(hasComputeShaders);
             break;
+        case ShaderType::Task:
+        case ShaderType::Mesh:
+            LLGL_ASSERT_RENDERING_FEATURE_SUPPORT(hasMeshShaders);
+            break;
         default:
             break;
     }
 
     /* Make and return shader object */
+    GLShader* shaderGL = nullptr;
+    ExecuteWithGLContext([&]() { shaderGL = CreateGLShader(shaderDesc); });
+    return shaderGL;
+}
+
+// private
+GLShader* GLRenderSystem::CreateGLShader(const ShaderDescriptor& shaderDesc)
+{
     #ifdef LLGL_OPENGL
     if (HasExtension(GLExt::ARB_separate_shader_objects) && (shaderDesc.flags & ShaderCompileFlags::SeparateShader) != 0)
     {
@@ -480,14 +561,30 @@ PipelineState* GLRenderSystem::CreatePipelineState(const Blob& /*serializedCache
     return nullptr;//TODO
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* serializedCache)
+{
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineState");
+
+    return pipelineStates_.emplace<GLGraphicsPSO>(pipelineStateDesc, GetRenderingCaps().limits, serializedCache);
+}
+
+PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* serializedCache)
 {
-    return pipelineStates_.emplace<GLGraphicsPSO>(pipelineStateDesc, GetRenderingCaps().limits);
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineState");
+
+    return pipelineStates_.emplace<GLComputePSO>(pipelineStateDesc, serializedCache);
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, PipelineState* /*fallbackPipelineState*/)
 {
-    return pipelineStates_.emplace<GLComputePSO>(pipelineStateDesc);
+    /* GL shaders are compiled by the driver in parallel if supported (see GLPipelineState::IsReady), so no background task is needed */
+    return CreatePipelineState(pipelineStateDesc);
+}
+
+PipelineState* GLRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, PipelineState* /*fallbackPipelineState*/)
+{
+    /* GL shaders are compiled by the driver in parallel if supported (see GLPipelineState::IsReady), so no background task is needed */
+    return CreatePipelineState(pipelineStateDesc);
 }
 
 void GLRenderSystem::Release(PipelineState& pipelineState)
@@ -507,6 +604,18 @@ void GLRenderSystem::Release(QueryHeap& queryHeap)
     queryHeaps_.erase(&queryHeap);
 }
 
+/* ----- Acceleration structures ----- */
+
+AccelerationStructure* GLRenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& /*accelerationStructureDesc*/)
+{
+    LLGL_TRAP_FEATURE_NOT_SUPPORTED("acceleration structures");
+}
+
+void GLRenderSystem::Release(AccelerationStructure& /*accelerationStructure*/)
+{
+    // dummy
+}
+
 /* ----- Fences ----- */
 
 Fence* GLRenderSystem::CreateFence()
@@ -526,6 +635,42 @@ bool GLRenderSystem::GetNativeHandle(void* nativeHandle, std::size_t nativeHandl
     return (nativeHandle == nullptr || nativeHandleSize == 0); // dummy
 }
 
+std::uint64_t GLRenderSystem::ReleaseRetainedMemory(std::uint64_t /*budget*/)
+{
+    return 0; // dummy
+}
+
+bool GLRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStatistics)
+{
+    outStatistics.heaps.clear();
+    return false; // dummy
+}
+
+bool GLRenderSystem::SetMemoryPriority(Resource& /*resource*/, float /*priority*/)
+{
+    return false; // dummy
+}
+
+Blob GLRenderSystem::GetPipelineCache()
+{
+    return Blob{}; // dummy
+}
+
+bool GLRenderSystem::ExportMemoryHandle(Resource& /*resource*/, ExternalHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool GLRenderSystem::ExportFenceHandle(Fence& /*fence*/, ExternalHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool GLRenderSystem::SubmitFileLoads(const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    return SubmitFileLoadsEmulated(*this, loads, fence);
+}
+
 
 /*
  * ======= Private: =======
@@ -543,6 +688,35 @@ void GLRenderSystem::CreateGLContextDependentDevices(GLStateManager& stateManage
     /* Query renderer information and limits */
     QueryRendererInfo();
     QueryRenderingCaps();
+
+    /* Select tuning profile before any buffer is created */
+    SelectTuningProfile();
+
+    /* Let the driver choose the number of background threads for parallel shader compilation */
+    #ifdef LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    if (HasExtension(GLExt::KHR_parallel_shader_compile))
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    else if (HasExtension(GLExt::ARB_parallel_shader_compile))
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+    #endif // /LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+
+    /* Create worker threads with shared GL contexts for background resource creation */
+    const std::uint32_t numWorkerContexts = contextMngr_.GetProfile().numWorkerContexts;
+    if (numWorkerContexts > 0 && !contextMngr_.IsHeadless())
+        workerContextPool_ = MakeUnique<GLWorkerContextPool>(contextMngr_, numWorkerContexts);
+}
+
+bool GLRenderSystem::IsWorkerContextRequired() const
+{
+    return (workerContextPool_ && GLContext::GetCurrent() == nullptr);
+}
+
+void GLRenderSystem::ExecuteWithGLContext(const std::function<void()>& task)
+{
+    if (IsWorkerContextRequired())
+        workerContextPool_->Execute(task);
+    else
+        task();
 }
 
 #ifdef GL_KHR_debug
@@ -623,6 +797,18 @@ void GLRenderSystem::QueryRenderingCaps()
     SetRenderingCaps(caps);
 }
 
+void GLRenderSystem::SelectTuningProfile()
+{
+    /* GL does not report a PCI vendor ID, so the vendor is derived from the GL_VENDOR string */
+    const VendorTuningProfile profile = GetVendorTuningProfile(GetVendorByName(GetRendererInfo().vendorName.c_str()));
+
+    const RendererConfigurationOpenGL& config = contextMngr_.GetProfile();
+    GLStreamingBuffer::Get().Configure(
+        GetTuningSize(config.stagingChunkSize, static_cast<GLsizeiptr>(profile.stagingChunkSize)),
+        GetTuningOverride(config.mappedBufferUpdates, profile.mappedBufferUpdates)
+    );
+}
+
 
 } // /namespace LLGL
 
@@ -17,6 +17,7 @@
 #include "Command/GLCommandBuffer.h"
 #include "GLSwapChain.h"
 #include "Platform/GLContextManager.h"
+#include "Platform/GLWorkerContextPool.h"
 
 #include "Buffer/GLBuffer.h"
 #include "Buffer/GLBufferArray.h"
@@ -42,6 +43,7 @@
 #include <memory>
 #include <vector>
 #include <set>
+#include <functional>
 
 
 namespace LLGL
@@ -69,10 +71,20 @@ class GLRenderSystem final : public RenderSystem
         void QueryRendererInfo();
         void QueryRenderingCaps();
 
+        // Selects the tuning profile by the vendor of the GL context and configures the streaming buffer for buffer updates.
+        void SelectTuningProfile();
+
         GLBuffer* CreateGLBuffer(const BufferDescriptor& desc, const void* initialData);
+        GLShader* CreateGLShader(const ShaderDescriptor& desc);
 
         void ValidateGLTextureType(const TextureType type);
 
+        // Returns true if the calling thread has no current GL context and GL commands must be executed on a worker context.
+        bool IsWorkerContextRequired() const;
+
+        // Executes the specified task on a worker context if the calling thread has no current GL context, or directly otherwise.
+        void ExecuteWithGLContext(const std::function<void()>& task);
+
     private:
 
         /* ----- Hardware object containers ----- */
@@ -99,6 +111,10 @@ class GLRenderSystem final : public RenderSystem
         HWObjectContainer<GLQueryHeap>      queryHeaps_;
         HWObjectContainer<GLFence>          fences_;
 
+        /* ----- Worker contexts ----- */
+
+        std::unique_ptr<GLWorkerContextPool>    workerContextPool_;
+
 };
 
 
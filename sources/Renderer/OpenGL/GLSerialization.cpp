@@ -0,0 +1,70 @@
+/*
+ * GLSerialization.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GLSerialization.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+// Header of a GLIdent_ProgramBinary segment; the binary data follows immediately after this header.
+struct GLProgramBinaryHeader
+{
+    std::uint32_t permutation;
+    std::uint32_t format;
+    std::uint64_t hash;
+};
+
+void GLWriteSegmentProgramBinary(Serializer& writer, GLShader::Permutation permutation, const GLProgramBinary& binary)
+{
+    GLProgramBinaryHeader header;
+    {
+        header.permutation  = static_cast<std::uint32_t>(permutation);
+        header.format       = static_cast<std::uint32_t>(binary.format);
+        header.hash         = binary.hash;
+    }
+    writer.Begin(GLIdent_ProgramBinary, sizeof(header) + binary.data.size());
+    {
+        writer.WriteTyped(header);
+        writer.Write(binary.data.data(), binary.data.size());
+    }
+    writer.End();
+}
+
+bool GLReadSegmentProgramBinary(Deserializer& reader, GLShader::Permutation& outPermutation, GLProgramBinary& outBinary)
+{
+    auto seg = reader.ReadSegmentOnMatch(GLIdent_ProgramBinary);
+    if (seg.ident != GLIdent_ProgramBinary || seg.data == nullptr || seg.size <= sizeof(GLProgramBinaryHeader))
+        return false;
+
+    GLProgramBinaryHeader header;
+    ::memcpy(&header, seg.data, sizeof(header));
+
+    if (header.permutation >= GLShader::PermutationCount)
+        return false;
+
+    outPermutation      = static_cast<GLShader::Permutation>(header.permutation);
+    outBinary.format    = static_cast<GLenum>(header.format);
+    outBinary.hash      = header.hash;
+    outBinary.data.assign(seg.data + sizeof(header), seg.data + seg.size);
+
+    return true;
+}
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,56 @@
+/*
+ * GLSerialization.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GL_SERIALIZATION_H
+#define LLGL_GL_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include "Shader/GLShader.h"
+#include "Shader/GLProgramBinary.h"
+#include <LLGL/RenderSystemFlags.h>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for GL serialization.
+enum GLIdent : IdentType
+{
+    GLIdent_ReservedGL = (RendererID::OpenGL << 8),
+    GLIdent_ProgramBinary,  // GLShader::Permutation; GLProgramBinary
+};
+
+
+/* ----- Functions ----- */
+
+// Writes the specified program binary for the respective shader permutation as a serialized segment.
+void GLWriteSegmentProgramBinary(Serializer& writer, GLShader::Permutation permutation, const GLProgramBinary& binary);
+
+/*
+Reads a program binary from the next deserialized segment.
+Returns false if the next segment is not a valid program binary, in which case the reading position is not modified.
+*/
+bool GLReadSegmentProgramBinary(Deserializer& reader, GLShader::Permutation& outPermutation, GLProgramBinary& outBinary);
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -27,6 +27,7 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBufferSubData );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdCopyBufferSubData );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClearBufferData );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClearBufferSubData );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClearBufferPattern );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdCopyImageSubData ); //NOTE: non-POD struct
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdCopyImageBuffer ); //NOTE: non-POD struct
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdCopyFramebufferSubData ); //NOTE: non-POD struct
@@ -60,6 +61,7 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindPipelineState );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdSetBlendColor );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdSetStencilRef );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdSetUniforms );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdSetUniformBlock );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBeginQuery );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdEndQuery );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBeginConditionalRender );
@@ -8,6 +8,10 @@
 #include "GLSwapChain.h"
 #include "../TextureUtils.h"
 #include "Platform/GLContextManager.h"
+#include "Ext/GLExtensions.h"
+#include "Ext/GLExtensionRegistry.h"
+#include "../HostTrace.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -50,11 +54,30 @@ GLSwapChain::GLSwapChain(
 
     /* Get state manager and reset current framebuffer height */
     GetStateManager().ResetFramebufferHeight(framebufferHeight_);
+
+    /* Apply explicit presentation mode; adaptive V-sync can only be detected by the platform accepting a negative swap interval */
+    if (IsPresentModeSupported(desc.presentMode) || desc.presentMode == PresentMode::FifoRelaxed)
+    {
+        presentMode_ = desc.presentMode;
+        if (!SetSwapInterval(GetSwapIntervalForPresentMode(1)))
+            presentMode_ = PresentMode::Default;
+    }
+}
+
+GLSwapChain::~GLSwapChain()
+{
+    for (GLsync fence : presentFences_)
+        glDeleteSync(fence);
 }
 
 void GLSwapChain::Present()
 {
+    LLGL_HOST_TRACE_SCOPE("Present");
+
     swapChainContext_->SwapBuffers();
+
+    if (maxFrameLatency_ > 0)
+        WaitForFrameLatency();
 }
 
 std::uint32_t GLSwapChain::GetCurrentSwapIndex() const
@@ -89,7 +112,34 @@ const RenderPass* GLSwapChain::GetRenderPass() const
 
 bool GLSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
 {
-    return SetSwapInterval(static_cast<int>(vsyncInterval));
+    if (presentMode_ == PresentMode::Immediate)
+        return true;
+    return SetSwapInterval(GetSwapIntervalForPresentMode(vsyncInterval));
+}
+
+bool GLSwapChain::SetMaxFrameLatency(std::uint32_t maxFrameLatency)
+{
+    /* Frame latency is limited with sync objects, so this requires GL_ARB_sync */
+    if (maxFrameLatency == 0 || !HasExtension(GLExt::ARB_sync))
+        return false;
+    maxFrameLatency_ = maxFrameLatency;
+    return true;
+}
+
+bool GLSwapChain::IsPresentModeSupported(PresentMode presentMode) const
+{
+    switch (presentMode)
+    {
+        case PresentMode::Default:
+        case PresentMode::Fifo:
+        case PresentMode::Immediate:
+            return true;
+        case PresentMode::FifoRelaxed:
+            /* There is no portable query for adaptive V-sync, so it's only reported once the platform has accepted it */
+            return (presentMode_ == PresentMode::FifoRelaxed);
+        default:
+            return false;
+    }
 }
 
 bool GLSwapChain::MakeCurrent(GLSwapChain* swapChain)
@@ -129,6 +179,36 @@ bool GLSwapChain::SetSwapInterval(int swapInterval)
     return GLContext::SetCurrentSwapInterval(swapInterval);
 }
 
+int GLSwapChain::GetSwapIntervalForPresentMode(std::uint32_t vsyncInterval) const
+{
+    const int swapInterval = static_cast<int>(vsyncInterval);
+    switch (presentMode_)
+    {
+        case PresentMode::Fifo:         return std::max(1, swapInterval);
+        case PresentMode::FifoRelaxed:  return -std::max(1, swapInterval);
+        case PresentMode::Immediate:    return 0;
+        default:                        return swapInterval;
+    }
+}
+
+void GLSwapChain::WaitForFrameLatency()
+{
+    presentFences_.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    /* Wait for the oldest presentations until the number of pending frames is below the maximum frame latency */
+    constexpr GLuint64 timeout = 1000000000ull;
+    while (presentFences_.size() >= maxFrameLatency_)
+    {
+        GLsync fence = presentFences_.front();
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        while (result == GL_TIMEOUT_EXPIRED)
+            result = glClientWaitSync(fence, 0, timeout);
+
+        glDeleteSync(fence);
+        presentFences_.pop_front();
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -17,6 +17,7 @@
 #include "Platform/GLContext.h"
 #include "Platform/GLSwapChainContext.h"
 #include <memory>
+#include <deque>
 
 #ifdef __linux__
 #include <LLGL/Platform/NativeHandle.h>
@@ -43,6 +44,8 @@ class GLSwapChain final : public SwapChain
             GLContextManager&               contextMngr
         );
 
+        ~GLSwapChain();
+
         void Present() override;
 
         std::uint32_t GetCurrentSwapIndex() const override;
@@ -55,6 +58,8 @@ class GLSwapChain final : public SwapChain
         const RenderPass* GetRenderPass() const override;
 
         bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+        bool SetMaxFrameLatency(std::uint32_t maxFrameLatency) override;
+        bool IsPresentModeSupported(PresentMode presentMode) const override;
 
     public:
 
@@ -75,6 +80,12 @@ class GLSwapChain final : public SwapChain
 
         bool SetSwapInterval(int swapInterval);
 
+        // Returns the swap interval for the specified V-sync interval with respect to the current presentation mode.
+        int GetSwapIntervalForPresentMode(std::uint32_t vsyncInterval) const;
+
+        // Inserts a fence for the current presentation and waits until at most 'maxFrameLatency_ - 1' presentations are still pending.
+        void WaitForFrameLatency();
+
         #ifdef __linux__
         void ChooseGLXVisualAndGetX11WindowContext(GLPixelFormat& pixelFormat, NativeContextHandle& windowContext);
         #endif
@@ -84,6 +95,10 @@ class GLSwapChain final : public SwapChain
         std::shared_ptr<GLContext>          context_;
         std::unique_ptr<GLSwapChainContext> swapChainContext_;
         GLint                               framebufferHeight_ = 0;
+        PresentMode                         presentMode_       = PresentMode::Default;
+
+        std::uint32_t                       maxFrameLatency_   = 0; // Zero if the frame latency is not limited
+        std::deque<GLsync>                  presentFences_;
 
 };
 
@@ -49,6 +49,10 @@
 #   define LLGL_GLEXT_TRANSFORM_FEEDBACK
 #endif
 
+#if defined LLGL_OPENGL && defined GL_ARB_transform_feedback2
+#   define LLGL_GLEXT_TRANSFORM_FEEDBACK2
+#endif
+
 #if defined GL_EXT_draw_buffers2 || defined GL_ES_VERSION_3_2
 #   define LLGL_GLEXT_DRAW_BUFFERS2
 #endif
@@ -73,6 +77,26 @@
 #   define LLGL_GLEXT_CLIP_CONTROL
 #endif
 
+#if defined LLGL_OPENGL && defined GL_ARB_bindless_texture
+#   define LLGL_GLEXT_BINDLESS_TEXTURE
+#endif
+
+#if defined LLGL_OPENGL && defined LLGL_GL_ENABLE_VENDOR_EXT && !defined __APPLE__ && defined GL_NV_command_list && defined GL_NV_shader_buffer_load && defined GL_NV_uniform_buffer_unified_memory && defined GL_NV_vertex_buffer_unified_memory
+#   define LLGL_GLEXT_COMMAND_LIST_NV
+#endif
+
+#if defined LLGL_OPENGL && defined LLGL_GL_ENABLE_VENDOR_EXT && !defined __APPLE__ && defined GL_NV_shader_buffer_load
+#   define LLGL_GLEXT_SHADER_BUFFER_LOAD_NV
+#endif
+
+#if defined LLGL_OPENGL && (defined GL_KHR_parallel_shader_compile || defined GL_ARB_parallel_shader_compile)
+#   define LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+#endif
+
+#if defined GL_ARB_get_program_binary || defined GL_ES_VERSION_3_0
+#   define LLGL_GLEXT_GET_PROGRAM_BINARY
+#endif
+
 #ifdef GL_TEXTURE_BORDER_COLOR
 #   define LLGL_SAMPLER_BORDER_COLOR
 #endif
@@ -9,12 +9,18 @@
 #include "../../../CheckedCast.h"
 #include "../../../../Core/CoreUtils.h"
 #include <LLGL/RendererConfiguration.h>
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
+#ifndef EGL_CONTEXT_OPENGL_NO_ERROR_KHR
+#define EGL_CONTEXT_OPENGL_NO_ERROR_KHR 0x31B3
+#endif
+
+
 /*
  * GLContext class
  */
@@ -70,8 +76,10 @@ bool AndroidGLContext::SetSwapInterval(int interval)
     return (eglSwapInterval(display_, interval) == EGL_TRUE);
 }
 
-bool AndroidGLContext::SelectConfig(const GLPixelFormat& pixelFormat)
+bool AndroidGLContext::SelectConfig(const GLPixelFormat& pixelFormat, bool requirePbuffer)
 {
+    const EGLint surfaceType = (requirePbuffer ? EGL_WINDOW_BIT | EGL_PBUFFER_BIT : EGL_WINDOW_BIT);
+
     /* Look for a framebuffer configuration; reduce samples if necessary */
     for (samples_ = pixelFormat.samples; samples_ > 1; --samples_)
     {
@@ -86,6 +94,7 @@ bool AndroidGLContext::SelectConfig(const GLPixelFormat& pixelFormat)
             EGL_STENCIL_SIZE,   pixelFormat.stencilBits,
             EGL_SAMPLE_BUFFERS, (samples_ > 1 ? 1 : 0),
             EGL_SAMPLES,        (samples_ > 1 ? samples_ : 1),
+            EGL_SURFACE_TYPE,   surfaceType,
             EGL_NONE
         };
 
@@ -115,8 +124,12 @@ void AndroidGLContext::CreateContext(
     if (!eglInitialize(display_, nullptr, nullptr))
         throw std::runtime_error("eglInitialize failed");
 
+    /* Without surfaceless contexts, the configuration must also support a pbuffer to keep the context current without a native window */
+    const char* extensions = eglQueryString(display_, EGL_EXTENSIONS);
+    const bool surfacelessContext = (extensions != nullptr && ::strstr(extensions, "EGL_KHR_surfaceless_context") != nullptr);
+
     /* Select EGL context configuration for pixel format */
-    if (!SelectConfig(pixelFormat))
+    if (!SelectConfig(pixelFormat, !surfacelessContext))
         throw std::runtime_error("eglChooseConfig failed");
 
     /* Set up EGL profile attributes */
@@ -128,6 +141,9 @@ void AndroidGLContext::CreateContext(
         minor = profile.minorVersion;
     }
 
+    /* Disable error checking only if supported, since unknown attributes let context creation fail */
+    const bool noErrorContext = (profile.noErrorContext && extensions != nullptr && ::strstr(extensions, "EGL_KHR_create_context_no_error") != nullptr);
+
     const EGLint contextAttribs[] =
     {
         EGL_CONTEXT_MAJOR_VERSION,          major,
@@ -136,6 +152,7 @@ void AndroidGLContext::CreateContext(
         EGL_CONTEXT_OPENGL_DEBUG,           EGL_TRUE,
         EGL_CONTEXT_OPENGL_ROBUST_ACCESS,   EGL_TRUE,
         #endif
+        (noErrorContext ? EGL_CONTEXT_OPENGL_NO_ERROR_KHR : EGL_NONE), EGL_TRUE,
         EGL_NONE
     };
 
@@ -144,10 +161,26 @@ void AndroidGLContext::CreateContext(
     context_ = eglCreateContext(display_, config_, sharedEGLContext, contextAttribs);
     if (!context_)
         throw std::runtime_error("eglCreateContext failed");
+
+    /* Create fallback surface to keep the context and its resources alive while the app has no native window */
+    if (!surfacelessContext)
+    {
+        const EGLint pbufferAttribs[] =
+        {
+            EGL_WIDTH,  1,
+            EGL_HEIGHT, 1,
+            EGL_NONE
+        };
+        fallbackSurface_ = eglCreatePbufferSurface(display_, config_, pbufferAttribs);
+        if (fallbackSurface_ == EGL_NO_SURFACE)
+            throw std::runtime_error("eglCreatePbufferSurface failed");
+    }
 }
 
 void AndroidGLContext::DeleteContext()
 {
+    if (fallbackSurface_ != EGL_NO_SURFACE)
+        eglDestroySurface(display_, fallbackSurface_);
     eglDestroyContext(display_, context_);
 }
 
@@ -55,11 +55,20 @@ class AndroidGLContext : public GLContext
             return config_;
         }
 
+        /*
+        Returns the EGL surface that is bound while a swap-chain has no native window, e.g. when the app is in the background.
+        This is EGL_NO_SURFACE if EGL_KHR_surfaceless_context is supported and a 1x1 pbuffer surface otherwise.
+        */
+        inline ::EGLSurface GetEGLFallbackSurface() const
+        {
+            return fallbackSurface_;
+        }
+
     private:
 
         bool SetSwapInterval(int interval) override;
 
-        bool SelectConfig(const GLPixelFormat& pixelFormat);
+        bool SelectConfig(const GLPixelFormat& pixelFormat, bool requirePbuffer);
 
         void CreateContext(
             const GLPixelFormat&                pixelFormat,
@@ -70,10 +79,11 @@ class AndroidGLContext : public GLContext
 
     private:
 
-        ::EGLDisplay    display_    = nullptr;
-        ::EGLContext    context_    = nullptr;
-        ::EGLConfig     config_     = nullptr;
-        int             samples_    = 1;
+        ::EGLDisplay    display_            = nullptr;
+        ::EGLContext    context_            = nullptr;
+        ::EGLConfig     config_             = nullptr;
+        ::EGLSurface    fallbackSurface_    = EGL_NO_SURFACE;
+        int             samples_            = 1;
 
 };
 
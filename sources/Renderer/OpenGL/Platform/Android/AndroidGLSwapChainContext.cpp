@@ -34,41 +34,104 @@ bool GLSwapChainContext::MakeCurrentUnchecked(GLSwapChainContext* context)
  * AndroidGLSwapChainContext class
  */
 
+static ANativeWindow* GetSurfaceNativeWindow(Surface& surface)
+{
+    NativeHandle nativeHandle = {};
+    if (surface.GetNativeHandle(&nativeHandle, sizeof(nativeHandle)))
+        return nativeHandle.window;
+    return nullptr;
+}
+
 AndroidGLSwapChainContext::AndroidGLSwapChainContext(AndroidGLContext& context, Surface& surface) :
-    GLSwapChainContext { context                 },
-    display_           { context.GetEGLDisplay() },
-    context_           { context.GetEGLContext() }
+    GLSwapChainContext { context                         },
+    nativeSurface_     { surface                         },
+    display_           { context.GetEGLDisplay()         },
+    context_           { context.GetEGLContext()         },
+    config_            { context.GetEGLConfig()          },
+    fallbackSurface_   { context.GetEGLFallbackSurface() }
 {
-    /* Get native surface handle */
-    NativeHandle nativeHandle;
-    surface.GetNativeHandle(&nativeHandle, sizeof(nativeHandle));
-
-    /* Create drawable surface */
-    surface_ = eglCreateWindowSurface(display_, context.GetEGLConfig(), nativeHandle.window, nullptr);
-    if (!surface_)
-        throw std::runtime_error("eglCreateWindowSurface failed");
+    /* Create drawable surface; the app might be in the background without a native window */
+    CreateWindowSurface(GetSurfaceNativeWindow(surface));
 }
 
 AndroidGLSwapChainContext::~AndroidGLSwapChainContext()
 {
-    eglDestroySurface(display_, surface_);
+    if (surface_ != EGL_NO_SURFACE)
+        eglDestroySurface(display_, surface_);
 }
 
 bool AndroidGLSwapChainContext::SwapBuffers()
 {
-    eglSwapBuffers(display_, surface_);
+    UpdateWindowSurface();
+
+    /* Nothing to present while the app has no native window */
+    if (surface_ != EGL_NO_SURFACE)
+        eglSwapBuffers(display_, surface_);
+
     return true;
 }
 
 bool AndroidGLSwapChainContext::MakeCurrentEGLContext(AndroidGLSwapChainContext* context)
 {
     if (context)
-        return eglMakeCurrent(context->display_, context->surface_, context->surface_, context->context_);
+    {
+        context->UpdateWindowSurface();
+        const EGLSurface drawable = context->GetDrawableSurface();
+        return eglMakeCurrent(context->display_, drawable, drawable, context->context_);
+    }
     else
         return eglMakeCurrent(eglGetDisplay(EGL_DEFAULT_DISPLAY), EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void AndroidGLSwapChainContext::CreateWindowSurface(ANativeWindow* window)
+{
+    window_ = window;
+    if (window != nullptr)
+    {
+        surface_ = eglCreateWindowSurface(display_, config_, window, nullptr);
+        if (surface_ == EGL_NO_SURFACE)
+            throw std::runtime_error("eglCreateWindowSurface failed");
+    }
+}
+
+void AndroidGLSwapChainContext::DestroyWindowSurface()
+{
+    if (surface_ != EGL_NO_SURFACE)
+    {
+        /* Keep the context current on the fallback surface, so all GL objects survive until the window is re-attached */
+        if (eglGetCurrentContext() == context_ && eglGetCurrentSurface(EGL_DRAW) == surface_)
+            eglMakeCurrent(display_, fallbackSurface_, fallbackSurface_, context_);
+        eglDestroySurface(display_, surface_);
+        surface_ = EGL_NO_SURFACE;
+    }
+    window_ = nullptr;
+}
+
+void AndroidGLSwapChainContext::UpdateWindowSurface()
+{
+    ANativeWindow* window = GetSurfaceNativeWindow(nativeSurface_);
+    if (window != window_)
+    {
+        DestroyWindowSurface();
+        CreateWindowSurface(window);
+
+        /* Re-bind the new window surface if this context is still current on the fallback surface */
+        if (surface_ != EGL_NO_SURFACE && eglGetCurrentContext() == context_)
+            eglMakeCurrent(display_, surface_, surface_, context_);
+    }
+}
+
+::EGLSurface AndroidGLSwapChainContext::GetDrawableSurface() const
+{
+    return (surface_ != EGL_NO_SURFACE ? surface_ : fallbackSurface_);
+}
+
+
 } // /namespace LLGL
 
 
@@ -12,6 +12,7 @@
 #include "../GLSwapChainContext.h"
 #include "../../OpenGL.h"
 #include <EGL/egl.h>
+#include <android/native_window.h>
 
 
 namespace LLGL
@@ -37,9 +38,27 @@ class AndroidGLSwapChainContext final : public GLSwapChainContext
 
     private:
 
-        ::EGLDisplay display_ = nullptr;
-        ::EGLContext context_ = nullptr;
-        ::EGLSurface surface_ = nullptr;
+        // Creates the EGL window surface for the specified native window or leaves it at EGL_NO_SURFACE if the window is null.
+        void CreateWindowSurface(ANativeWindow* window);
+
+        // Destroys the EGL window surface and binds the fallback surface if this context is current.
+        void DestroyWindowSurface();
+
+        // Detaches from or re-attaches to the native window if the surface has lost or received its window since the last call.
+        void UpdateWindowSurface();
+
+        // Returns the EGL surface that must be bound with this context, i.e. the window surface or the fallback surface.
+        ::EGLSurface GetDrawableSurface() const;
+
+    private:
+
+        Surface&        nativeSurface_;
+        ::EGLDisplay    display_            = nullptr;
+        ::EGLContext    context_            = nullptr;
+        ::EGLConfig     config_             = nullptr;
+        ::EGLSurface    fallbackSurface_    = EGL_NO_SURFACE;
+        ::EGLSurface    surface_            = EGL_NO_SURFACE;
+        ANativeWindow*  window_             = nullptr;
 
 };
 
@@ -33,9 +33,9 @@ bool operator != (const GLPixelFormat& lhs, const GLPixelFormat& rhs)
  * GLContext class
  */
 
-static GLContext*   g_currentContext;
-static unsigned     g_currentGlobalIndex;
-static unsigned     g_globalIndexCounter;
+static thread_local GLContext*  g_currentContext;
+static thread_local unsigned    g_currentGlobalIndex;
+static unsigned                 g_globalIndexCounter;
 
 bool GLContext::SetCurrentSwapInterval(int interval)
 {
@@ -73,6 +73,18 @@ unsigned GLContext::GetCurrentGlobalIndex()
     return g_currentGlobalIndex;
 }
 
+#ifndef LLGL_GL_ENABLE_EGL_HEADLESS
+
+std::unique_ptr<GLContext> GLContext::CreateHeadless(
+    const GLPixelFormat&                /*pixelFormat*/,
+    const RendererConfigurationOpenGL&  /*profile*/,
+    GLContext*                          /*sharedContext*/)
+{
+    return nullptr; // dummy
+}
+
+#endif // /LLGL_GL_ENABLE_EGL_HEADLESS
+
 
 /*
  * ======= Protected: =======
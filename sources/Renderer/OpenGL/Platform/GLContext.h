@@ -82,10 +82,17 @@ class GLContext
             GLContext*                          sharedContext
         );
 
-        // Sets the current GL context. This only stores a reference to this context (GetCurrent) and its global index (GetGlobalIndex).
+        // Creates a platform specific GLContext instance without any surface (see RenderSystemFlags::Headless). Returns null if this is not supported on the current platform.
+        static std::unique_ptr<GLContext> CreateHeadless(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            GLContext*                          sharedContext
+        );
+
+        // Sets the current GL context for the calling thread. This only stores a reference to this context (GetCurrent) and its global index (GetGlobalIndex).
         static void SetCurrent(GLContext* context);
 
-        // Returns a pointer to the current GL context.
+        // Returns a pointer to the current GL context of the calling thread or null if no context is current on this thread.
         static GLContext* GetCurrent();
 
         // Returns the global index of the current GL context ().
@@ -11,17 +11,21 @@
 #include "../Ext/GLExtensionRegistry.h"
 #include <LLGL/Window.h>
 #include <LLGL/Canvas.h>
+#include "../../../Core/Exception.h"
 
 
 namespace LLGL
 {
 
 
-GLContextManager::GLContextManager(const RendererConfigurationOpenGL& profile)
+GLContextManager::GLContextManager(const RendererConfigurationOpenGL& profile, bool headless) :
+    headless_ { headless }
 {
-    profile_.contextProfile = profile.contextProfile;
-    profile_.majorVersion   = profile.majorVersion;
-    profile_.minorVersion   = profile.minorVersion;
+    profile_.contextProfile     = profile.contextProfile;
+    profile_.majorVersion       = profile.majorVersion;
+    profile_.minorVersion       = profile.minorVersion;
+    profile_.noErrorContext     = profile.noErrorContext;
+    profile_.numWorkerContexts  = profile.numWorkerContexts;
 }
 
 std::shared_ptr<GLContext> GLContextManager::AllocContext(const GLPixelFormat* pixelFormat, Surface* surface)
@@ -32,10 +36,21 @@ std::shared_ptr<GLContext> GLContextManager::AllocContext(const GLPixelFormat* p
         return FindOrMakeAnyContext();
 }
 
+std::unique_ptr<GLContext> GLContextManager::MakeSharedContext(Surface& surface)
+{
+    /* Share objects with the primary GL context and use the same pixel format */
+    FindOrMakeAnyContext();
+    const GLPixelFormatWithContext& primaryFormat = pixelFormats_.front();
 
-/*
- * ======= Private: =======
- */
+    auto context = GLContext::Create(primaryFormat.pixelFormat, profile_, surface, primaryFormat.context.get());
+
+    /* Initialize state manager for new GL context; extensions have already been loaded with the primary context */
+    auto& stateMngr = context->GetStateManager();
+    stateMngr.DetermineExtensionsAndLimits();
+    InitRenderStates(stateMngr);
+
+    return context;
+}
 
 std::unique_ptr<Surface> GLContextManager::CreatePlaceholderSurface()
 {
@@ -56,26 +71,42 @@ std::unique_ptr<Surface> GLContextManager::CreatePlaceholderSurface()
     #endif
 }
 
+
+/*
+ * ======= Private: =======
+ */
+
 std::shared_ptr<GLContext> GLContextManager::MakeContextWithPixelFormat(const GLPixelFormat& pixelFormat, Surface* surface)
 {
-    /* Create placeholder surface is none was specified */
-    std::unique_ptr<Surface> placeholderSurface;
-    if (surface == nullptr)
-    {
-        placeholderSurface = CreatePlaceholderSurface();
-        surface = placeholderSurface.get();
-    }
-
     /* Use shared GL context if there already is one */
     GLContext* sharedContext = (pixelFormats_.empty() ? nullptr : pixelFormats_.front().context.get());
 
-    /* Create new GL context and append to pixel format list */
     GLPixelFormatWithContext formatWithContext;
+    formatWithContext.pixelFormat = pixelFormat;
+
+    if (headless_)
+    {
+        /* Create new GL context without any surface */
+        formatWithContext.context = GLContext::CreateHeadless(pixelFormat, profile_, sharedContext);
+        if (!formatWithContext.context)
+            LLGL_TRAP("headless OpenGL contexts are not supported on this platform; on GNU/Linux, LLGL must be built with LLGL_GL_ENABLE_EGL_HEADLESS");
+    }
+    else
     {
-        formatWithContext.pixelFormat   = pixelFormat;
-        formatWithContext.surface       = std::move(placeholderSurface);
-        formatWithContext.context       = GLContext::Create(pixelFormat, profile_, *surface, sharedContext);
+        /* Create placeholder surface is none was specified */
+        std::unique_ptr<Surface> placeholderSurface;
+        if (surface == nullptr)
+        {
+            placeholderSurface = CreatePlaceholderSurface();
+            surface = placeholderSurface.get();
+        }
+
+        /* Create new GL context for the surface */
+        formatWithContext.surface   = std::move(placeholderSurface);
+        formatWithContext.context   = GLContext::Create(pixelFormat, profile_, *surface, sharedContext);
     }
+
+    /* Append new GL context to pixel format list */
     pixelFormats_.emplace_back(std::move(formatWithContext));
 
     auto context = pixelFormats_.back().context;
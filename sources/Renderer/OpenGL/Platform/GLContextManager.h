@@ -29,14 +29,23 @@ class GLContextManager
         GLContextManager(const GLContextManager&) = delete;
         GLContextManager& operator = (const GLContextManager&) = delete;
 
-        // Initializes the context manager and creates the primary GL context.
-        GLContextManager(const RendererConfigurationOpenGL& profile);
+        // Initializes the context manager. If 'headless' is true, all GL contexts are created without any surface (see RenderSystemFlags::Headless).
+        GLContextManager(const RendererConfigurationOpenGL& profile, bool headless = false);
 
     public:
 
         // Returns a GL context with the specified pixel format or any context if 'pixelFormat' is null.
         std::shared_ptr<GLContext> AllocContext(const GLPixelFormat* pixelFormat = nullptr, Surface* surface = nullptr);
 
+        /*
+        Makes a new GL context for the specified surface that shares its objects with the primary GL context.
+        The new context is not managed by this class, i.e. it is never returned by AllocContext().
+        */
+        std::unique_ptr<GLContext> MakeSharedContext(Surface& surface);
+
+        // Creates an invisible surface as placeholder for a GL context.
+        static std::unique_ptr<Surface> CreatePlaceholderSurface();
+
     public:
 
         // Returns the OpenGL profile configuration.
@@ -45,6 +54,12 @@ class GLContextManager
             return profile_;
         }
 
+        // Returns true if all GL contexts are created without any surface.
+        inline bool IsHeadless() const
+        {
+            return headless_;
+        }
+
     private:
 
         struct GLPixelFormatWithContext
@@ -56,9 +71,6 @@ class GLContextManager
 
     private:
 
-        // Creates an invisible surface as placeholder for a GL context.
-        std::unique_ptr<Surface> CreatePlaceholderSurface();
-
         // Makes a new GL context with the specified pixel format and creates a placeholder surface is none was specified.
         std::shared_ptr<GLContext> MakeContextWithPixelFormat(const GLPixelFormat& pixelFormat, Surface* surface = nullptr);
 
@@ -74,6 +86,7 @@ class GLContextManager
     private:
 
         RendererConfigurationOpenGL             profile_;
+        bool                                    headless_       = false;
         std::vector<GLPixelFormatWithContext>   pixelFormats_;
 
 };
@@ -13,7 +13,7 @@ namespace LLGL
 {
 
 
-static GLSwapChainContext* g_currentSwapChainContext;
+static thread_local GLSwapChainContext* g_currentSwapChainContext;
 
 GLSwapChainContext::GLSwapChainContext(GLContext& context) :
     context_ { context }
@@ -32,6 +32,11 @@ bool GLSwapChainContext::MakeCurrent(GLSwapChainContext* context)
     return result;
 }
 
+bool GLSwapChainContext::RestoreCurrent()
+{
+    return GLSwapChainContext::MakeCurrentUnchecked(g_currentSwapChainContext);
+}
+
 
 } // /namespace LLGL
 
@@ -49,6 +49,9 @@ class GLSwapChainContext
         // Makes the specified swap-chain context link current. If null, no context is current.
         static bool MakeCurrent(GLSwapChainContext* context);
 
+        // Binds the current swap-chain context link of the calling thread again, e.g. after a new GL context has implicitly been made current during its creation.
+        static bool RestoreCurrent();
+
     protected:
 
         // Initializes the swap-chain context with the specified GL context.
@@ -0,0 +1,142 @@
+/*
+ * GLWorkerContextPool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GLWorkerContextPool.h"
+#include "GLContextManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+GLWorkerContextPool::GLWorkerContextPool(GLContextManager& contextMngr, std::uint32_t numWorkers)
+{
+    workers_.reserve(numWorkers);
+
+    for_range(i, numWorkers)
+    {
+        /* Create worker GL context on this thread, since the placeholder surface must be created on the same thread as the primary surface */
+        auto worker = MakeUnique<Worker>();
+        {
+            worker->surface             = GLContextManager::CreatePlaceholderSurface();
+            worker->context             = contextMngr.MakeSharedContext(*worker->surface);
+            worker->swapChainContext    = GLSwapChainContext::Create(*worker->context, *worker->surface);
+        }
+
+        /* Creating a GL context implicitly makes it current, so bind the previous context again before the worker can take over the new one */
+        GLSwapChainContext::RestoreCurrent();
+
+        worker->thread = std::thread{ &GLWorkerContextPool::WorkerMain, this, std::ref(*worker) };
+        workers_.push_back(std::move(worker));
+    }
+}
+
+GLWorkerContextPool::~GLWorkerContextPool()
+{
+    /* Finish all pending tasks and stop worker threads */
+    {
+        std::lock_guard<std::mutex> guard{ queueMutex_ };
+        quit_ = true;
+    }
+    queueSignal_.notify_all();
+
+    for (auto& worker : workers_)
+        worker->thread.join();
+}
+
+void GLWorkerContextPool::Execute(const std::function<void()>& task)
+{
+    Task pendingTask;
+    pendingTask.func = &task;
+
+    /* Schedule task for the next idle worker */
+    std::unique_lock<std::mutex> lock{ queueMutex_ };
+    queue_.push_back(&pendingTask);
+    queueSignal_.notify_one();
+
+    /* Wait until the worker has finished the task and its GL commands */
+    completionSignal_.wait(lock, [&pendingTask]() { return pendingTask.done; });
+
+    if (pendingTask.exception)
+        std::rethrow_exception(pendingTask.exception);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLWorkerContextPool::WorkerMain(Worker& worker)
+{
+    GLSwapChainContext::MakeCurrent(worker.swapChainContext.get());
+
+    for (;;)
+    {
+        /* Wait for next task */
+        Task* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock{ queueMutex_ };
+            queueSignal_.wait(lock, [this]() { return (quit_ || !queue_.empty()); });
+            if (queue_.empty())
+                break;
+            task = queue_.front();
+            queue_.pop_front();
+        }
+
+        RunTask(*task);
+
+        /* Notify all waiting threads; each one only continues if its own task is done */
+        {
+            std::lock_guard<std::mutex> guard{ queueMutex_ };
+            task->done = true;
+        }
+        completionSignal_.notify_all();
+    }
+
+    /* Release GL context on this thread, since deleting a GL context also unbinds the context of the calling thread */
+    GLSwapChainContext::MakeCurrent(nullptr);
+    worker.swapChainContext.reset();
+    worker.context.reset();
+}
+
+void GLWorkerContextPool::RunTask(Task& task)
+{
+    try
+    {
+        (*task.func)();
+    }
+    catch (...)
+    {
+        task.exception = std::current_exception();
+    }
+
+    /*
+    Wait until the GPU has finished all commands of this task.
+    Objects that have been modified in this context are then ready to be bound by any other shared context.
+    */
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (fence != nullptr)
+    {
+        constexpr GLuint64 timeout = 1000000000ull;
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        while (result == GL_TIMEOUT_EXPIRED)
+            result = glClientWaitSync(fence, 0, timeout);
+        glDeleteSync(fence);
+    }
+    else
+        glFinish();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
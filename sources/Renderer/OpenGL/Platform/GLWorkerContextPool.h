@@ -0,0 +1,102 @@
+/*
+ * GLWorkerContextPool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GL_WORKER_CONTEXT_POOL_H
+#define LLGL_GL_WORKER_CONTEXT_POOL_H
+
+
+#include "GLContext.h"
+#include "GLSwapChainContext.h"
+#include <LLGL/Surface.h>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class GLContextManager;
+
+/*
+Pool of worker threads that each have their own GL context, which shares its objects with the primary GL context.
+This allows threads without a current GL context to create and upload GL objects, such as textures and shaders, off the render thread.
+Each task is completed with a 'glFenceSync' object before it is reported as done, so the objects are ready to be used by other contexts.
+*/
+class GLWorkerContextPool
+{
+
+    public:
+
+        GLWorkerContextPool(const GLWorkerContextPool&) = delete;
+        GLWorkerContextPool& operator = (const GLWorkerContextPool&) = delete;
+
+        // Creates the specified number of worker threads and their shared GL contexts. This must be called on the thread that owns the primary GL context.
+        GLWorkerContextPool(GLContextManager& contextMngr, std::uint32_t numWorkers);
+
+        // Stops all worker threads and releases their GL contexts.
+        ~GLWorkerContextPool();
+
+        /*
+        Executes the specified task on the next idle worker thread and blocks the calling thread until all GL commands of that task have completed.
+        Exceptions thrown by the task are rethrown on the calling thread.
+        */
+        void Execute(const std::function<void()>& task);
+
+    private:
+
+        struct Worker
+        {
+            std::unique_ptr<Surface>            surface;
+            std::unique_ptr<GLContext>          context;
+            std::unique_ptr<GLSwapChainContext> swapChainContext;
+            std::thread                         thread;
+        };
+
+        struct Task
+        {
+            const std::function<void()>*    func        = nullptr;
+            std::exception_ptr              exception;
+            bool                            done        = false;
+        };
+
+    private:
+
+        // Main function of each worker thread. The GL context of a worker is made current and released on its own thread.
+        void WorkerMain(Worker& worker);
+
+        // Runs the specified task and waits for its GL commands to complete.
+        void RunTask(Task& task);
+
+    private:
+
+        std::vector<std::unique_ptr<Worker>>    workers_;
+
+        std::mutex                              queueMutex_;
+        std::condition_variable                 queueSignal_;
+        std::condition_variable                 completionSignal_;
+        std::deque<Task*>                       queue_;
+        bool                                    quit_               = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,212 @@
+/*
+ * LinuxEGLContext.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifdef LLGL_GL_ENABLE_EGL_HEADLESS
+
+#include "LinuxEGLContext.h"
+#include "../../../CheckedCast.h"
+#include "../../../../Core/CoreUtils.h"
+#include "../../../../Core/Exception.h"
+#include <EGL/eglext.h>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+#ifndef EGL_CONTEXT_OPENGL_NO_ERROR_KHR
+#define EGL_CONTEXT_OPENGL_NO_ERROR_KHR 0x31B3
+#endif
+
+
+/*
+ * GLContext class
+ */
+
+std::unique_ptr<GLContext> GLContext::CreateHeadless(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    GLContext*                          sharedContext)
+{
+    LinuxEGLContext* sharedContextEGL = (sharedContext != nullptr ? LLGL_CAST(LinuxEGLContext*, sharedContext) : nullptr);
+    return MakeUnique<LinuxEGLContext>(pixelFormat, profile, sharedContextEGL);
+}
+
+
+/*
+ * LinuxEGLContext class
+ */
+
+LinuxEGLContext::LinuxEGLContext(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    LinuxEGLContext*                    sharedContext)
+:
+    display_ { GetSurfacelessDisplay() }
+{
+    CreateContext(pixelFormat, profile, sharedContext);
+}
+
+LinuxEGLContext::~LinuxEGLContext()
+{
+    DeleteContext();
+}
+
+void LinuxEGLContext::Resize(const Extent2D& /*resolution*/)
+{
+    // dummy
+}
+
+int LinuxEGLContext::GetSamples() const
+{
+    return samples_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool LinuxEGLContext::SetSwapInterval(int /*interval*/)
+{
+    /* Headless contexts have no surface to present */
+    return false;
+}
+
+::EGLDisplay LinuxEGLContext::GetSurfacelessDisplay()
+{
+    /* Prefer the surfaceless platform, which does not depend on any window system */
+    auto eglGetPlatformDisplayEXT = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (eglGetPlatformDisplayEXT != nullptr)
+    {
+        ::EGLDisplay display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY)
+            return display;
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+bool LinuxEGLContext::SelectConfig(const GLPixelFormat& pixelFormat)
+{
+    /* Look for a configuration for offscreen buffers; reduce samples if necessary */
+    for (samples_ = (pixelFormat.samples > 1 ? pixelFormat.samples : 1); samples_ >= 1; --samples_)
+    {
+        const EGLint attribs[] =
+        {
+            EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+            EGL_RED_SIZE,           8,
+            EGL_GREEN_SIZE,         8,
+            EGL_BLUE_SIZE,          8,
+            EGL_ALPHA_SIZE,         8,
+            EGL_DEPTH_SIZE,         pixelFormat.depthBits,
+            EGL_STENCIL_SIZE,       pixelFormat.stencilBits,
+            EGL_SAMPLE_BUFFERS,     (samples_ > 1 ? 1 : 0),
+            EGL_SAMPLES,            (samples_ > 1 ? samples_ : 0),
+            EGL_NONE
+        };
+
+        EGLint numConfigs = 0;
+        if (eglChooseConfig(display_, attribs, &config_, 1, &numConfigs) == EGL_TRUE && numConfigs >= 1)
+        {
+            SetDefaultColorFormat();
+            DeduceDepthStencilFormat(pixelFormat.depthBits, pixelFormat.stencilBits);
+            return true;
+        }
+    }
+
+    /* No suitable configuration found */
+    samples_ = 1;
+    return false;
+}
+
+void LinuxEGLContext::CreateContext(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    LinuxEGLContext*                    sharedContext)
+{
+    /* Initialize EGL display connection and bind desktop OpenGL API */
+    if (display_ == EGL_NO_DISPLAY || eglInitialize(display_, nullptr, nullptr) != EGL_TRUE)
+        LLGL_TRAP("failed to initialize EGL display for headless OpenGL context");
+
+    if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+        LLGL_TRAP("failed to bind OpenGL API for EGL display");
+
+    /* Select EGL context configuration for pixel format */
+    if (!SelectConfig(pixelFormat))
+        LLGL_TRAP("failed to choose EGL configuration for headless OpenGL context");
+
+    ::EGLContext sharedEGLContext = (sharedContext != nullptr ? sharedContext->context_ : EGL_NO_CONTEXT);
+
+    /* Disable error checking only if supported, since unknown attributes let context creation fail */
+    const char* extensions = eglQueryString(display_, EGL_EXTENSIONS);
+    const bool noErrorContext = (profile.noErrorContext && extensions != nullptr && ::strstr(extensions, "EGL_KHR_create_context_no_error") != nullptr);
+
+    if (profile.contextProfile == OpenGLContextProfile::CoreProfile)
+    {
+        if (profile.majorVersion == 0 && profile.minorVersion == 0)
+        {
+            /* Try highest possible GL version first, since EGL can't be queried for it without an intermediate context */
+            static const int coreVersions[][2] = { { 4, 6 }, { 4, 5 }, { 4, 4 }, { 4, 3 }, { 4, 2 }, { 4, 1 }, { 4, 0 }, { 3, 3 }, { 3, 2 } };
+            for (const auto& version : coreVersions)
+            {
+                context_ = CreateContextWithVersion(sharedEGLContext, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR, version[0], version[1], noErrorContext);
+                if (context_ != EGL_NO_CONTEXT)
+                    break;
+            }
+        }
+        else
+            context_ = CreateContextWithVersion(sharedEGLContext, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR, profile.majorVersion, profile.minorVersion, noErrorContext);
+    }
+    else
+        context_ = CreateContextWithVersion(sharedEGLContext, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR, profile.majorVersion, profile.minorVersion, noErrorContext);
+
+    if (context_ == EGL_NO_CONTEXT)
+        LLGL_TRAP("failed to create headless OpenGL context with EGL (error code = 0x%04X)", static_cast<unsigned>(eglGetError()));
+
+    /* Make context current without any surface (requires EGL_KHR_surfaceless_context) */
+    if (eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_) != EGL_TRUE)
+        LLGL_TRAP("failed to make headless OpenGL context current; EGL_KHR_surfaceless_context might not be supported");
+}
+
+void LinuxEGLContext::DeleteContext()
+{
+    if (eglGetCurrentContext() == context_)
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display_, context_);
+}
+
+::EGLContext LinuxEGLContext::CreateContextWithVersion(::EGLContext sharedEGLContext, EGLint profileMask, int major, int minor, bool noErrorContext)
+{
+    /* Omit version for compatibility profiles with default version */
+    const bool hasVersion = !(major == 0 && minor == 0);
+
+    const EGLint contextAttribs[] =
+    {
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,    profileMask,
+        EGL_CONTEXT_MAJOR_VERSION_KHR,          (hasVersion ? major : 1),
+        EGL_CONTEXT_MINOR_VERSION_KHR,          (hasVersion ? minor : 0),
+        (noErrorContext ? EGL_CONTEXT_OPENGL_NO_ERROR_KHR : EGL_NONE), EGL_TRUE,
+        EGL_NONE
+    };
+
+    return eglCreateContext(display_, config_, sharedEGLContext, contextAttribs);
+}
+
+
+} // /namespace LLGL
+
+#endif // /LLGL_GL_ENABLE_EGL_HEADLESS
+
+
+
+// ================================================================================
@@ -0,0 +1,85 @@
+/*
+ * LinuxEGLContext.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_LINUX_EGL_CONTEXT_H
+#define LLGL_LINUX_EGL_CONTEXT_H
+
+
+#ifdef LLGL_GL_ENABLE_EGL_HEADLESS
+
+#include "../GLContext.h"
+#include "../../OpenGL.h"
+#include <LLGL/RendererConfiguration.h>
+#include <EGL/egl.h>
+
+
+namespace LLGL
+{
+
+
+// Implementation of the <GLContext> interface for headless GNU/Linux and wrapper for a native EGL context without any window system (see RenderSystemFlags::Headless).
+class LinuxEGLContext : public GLContext
+{
+
+    public:
+
+        LinuxEGLContext(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            LinuxEGLContext*                    sharedContext
+        );
+        ~LinuxEGLContext();
+
+        void Resize(const Extent2D& resolution) override;
+        int GetSamples() const override;
+
+    public:
+
+        // Returns the native EGL context.
+        inline ::EGLContext GetEGLContext() const
+        {
+            return context_;
+        }
+
+    private:
+
+        bool SetSwapInterval(int interval) override;
+
+        // Returns the surfaceless EGL display or the default EGL display if EGL_MESA_platform_surfaceless is not supported.
+        static ::EGLDisplay GetSurfacelessDisplay();
+
+        bool SelectConfig(const GLPixelFormat& pixelFormat);
+
+        void CreateContext(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            LinuxEGLContext*                    sharedContext
+        );
+        void DeleteContext();
+
+        ::EGLContext CreateContextWithVersion(::EGLContext sharedEGLContext, EGLint profileMask, int major, int minor, bool noErrorContext);
+
+    private:
+
+        ::EGLDisplay    display_    = EGL_NO_DISPLAY;
+        ::EGLContext    context_    = EGL_NO_CONTEXT;
+        ::EGLConfig     config_     = nullptr;
+        int             samples_    = 1;
+
+};
+
+
+} // /namespace LLGL
+
+#endif // /LLGL_GL_ENABLE_EGL_HEADLESS
+
+
+#endif
+
+
+
+// ================================================================================
@@ -13,6 +13,7 @@
 #include "../../../../Core/CoreUtils.h"
 #include <LLGL/Log.h>
 #include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
@@ -27,6 +28,10 @@ namespace LLGL
 #define GLX_CONTEXT_MINOR_VERSION_ARB 0x2092
 #endif
 
+#ifndef GLX_CONTEXT_OPENGL_NO_ERROR_ARB
+#define GLX_CONTEXT_OPENGL_NO_ERROR_ARB 0x31B3
+#endif
+
 typedef GLXContext (*GXLCREATECONTEXTATTRIBARBPROC)(::Display*, GLXFBConfig, GLXContext, Bool, const int*);
 
 
@@ -114,7 +119,7 @@ void LinuxGLContext::CreateContext(
     if (profile.contextProfile == OpenGLContextProfile::CoreProfile)
     {
         /* Create core profile */
-        glc_ = CreateContextCoreProfile(glcShared, profile.majorVersion, profile.minorVersion, pixelFormat.depthBits, pixelFormat.stencilBits);
+        glc_ = CreateContextCoreProfile(glcShared, profile.majorVersion, profile.minorVersion, pixelFormat.depthBits, pixelFormat.stencilBits, profile.noErrorContext);
     }
 
     if (glc_)
@@ -147,7 +152,14 @@ void LinuxGLContext::DeleteContext()
     glXDestroyContext(display_, glc_);
 }
 
-GLXContext LinuxGLContext::CreateContextCoreProfile(GLXContext glcShared, int major, int minor, int depthBits, int stencilBits)
+// Returns true if the specified GLX extension is supported for the default screen of the X11 display.
+static bool HasGLXExtension(::Display* display, const char* name)
+{
+    const char* extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+    return (extensions != nullptr && ::strstr(extensions, name) != nullptr);
+}
+
+GLXContext LinuxGLContext::CreateContextCoreProfile(GLXContext glcShared, int major, int minor, int depthBits, int stencilBits, bool noErrorContext)
 {
     /* Query supported GL versions */
     if (major == 0 && minor == 0)
@@ -196,16 +208,20 @@ GLXContext LinuxGLContext::CreateContextCoreProfile(GLXContext glcShared, int ma
 
         if (fbcList != nullptr && fbCount > 0)
         {
+            /* Disable error checking only if supported, since unknown attributes generate an X11 error */
+            const bool hasNoErrorAttrib = (noErrorContext && HasGLXExtension(display_, "GLX_ARB_create_context_no_error"));
+
             int contextAttribs[] =
             {
                 GLX_CONTEXT_MAJOR_VERSION_ARB, major,
                 GLX_CONTEXT_MINOR_VERSION_ARB, minor,
                 GLX_CONTEXT_PROFILE_MASK_ARB,  GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
                 //GLX_CONTEXT_FLAGS_ARB      , GLX_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB,
+                (hasNoErrorAttrib ? GLX_CONTEXT_OPENGL_NO_ERROR_ARB : 0), True,
                 None
             };
 
-            GLXContext glc = glXCreateContextAttribsARB(display_, fbcList[0], nullptr, True, contextAttribs);
+            GLXContext glc = glXCreateContextAttribsARB(display_, fbcList[0], glcShared, True, contextAttribs);
 
             XFree(fbcList);
 
@@ -59,7 +59,7 @@ class LinuxGLContext : public GLContext
         );
         void DeleteContext();
 
-        GLXContext CreateContextCoreProfile(GLXContext glcShared, int major, int minor, int depthBits, int stencilBits);
+        GLXContext CreateContextCoreProfile(GLXContext glcShared, int major, int minor, int depthBits, int stencilBits, bool noErrorContext);
         GLXContext CreateContextCompatibilityProfile(XVisualInfo* visual, GLXContext glcShared);
 
     private:
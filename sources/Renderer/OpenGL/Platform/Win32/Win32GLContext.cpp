@@ -15,12 +15,17 @@
 #include <LLGL/Platform/NativeHandle.h>
 #include <LLGL/Log.h>
 #include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
+#ifndef WGL_CONTEXT_OPENGL_NO_ERROR_ARB
+#define WGL_CONTEXT_OPENGL_NO_ERROR_ARB 0x31B3
+#endif
+
 static void DeleteGLContext(HGLRC& hGLRC)
 {
     if (wglDeleteContext(hGLRC) == FALSE)
@@ -244,6 +249,15 @@ static int GLContextProfileToBitmask(const OpenGLContextProfile profile)
     }
 }
 
+// Returns true if the specified WGL extension is supported for the device context.
+static bool HasWGLExtension(HDC hDC, const char* name)
+{
+    if (wglGetExtensionsStringARB == nullptr)
+        return false;
+    const char* extensions = wglGetExtensionsStringARB(hDC);
+    return (extensions != nullptr && ::strstr(extensions, name) != nullptr);
+}
+
 HGLRC Win32GLContext::CreateExplicitWGLContext(HDC hDC, Win32GLContext* sharedContext)
 {
     /* Check if highest version possible shall be used */
@@ -263,6 +277,9 @@ HGLRC Win32GLContext::CreateExplicitWGLContext(HDC hDC, Win32GLContext* sharedCo
     contextFlags |= WGL_CONTEXT_DEBUG_BIT_ARB;
     #endif
 
+    /* Disable error checking only if supported, since unknown attributes let context creation fail */
+    const bool noErrorContext = (profile_.noErrorContext && HasWGLExtension(hDC, "WGL_ARB_create_context_no_error"));
+
     /* Set up extended attributes to select the OpenGL profile */
     const int attribList[] =
     {
@@ -270,6 +287,7 @@ HGLRC Win32GLContext::CreateExplicitWGLContext(HDC hDC, Win32GLContext* sharedCo
         WGL_CONTEXT_MINOR_VERSION_ARB,  minor,
         WGL_CONTEXT_FLAGS_ARB,          contextFlags,
         WGL_CONTEXT_PROFILE_MASK_ARB,   GLContextProfileToBitmask(profile_.contextProfile),
+        (noErrorContext ? WGL_CONTEXT_OPENGL_NO_ERROR_ARB : 0), TRUE,
         0, 0
     };
 
@@ -31,6 +31,12 @@ void GLFence::SetName(const char* name)
 
 void GLFence::Submit()
 {
+    Submit(value_ + 1);
+}
+
+void GLFence::Submit(GLuint64 value)
+{
+    value_ = value;
     if (HasExtension(GLExt::ARB_sync))
     {
         #ifdef LLGL_DEBUG
@@ -65,6 +71,13 @@ bool GLFence::Wait(GLuint64 timeout)
     }
 }
 
+bool GLFence::Wait(GLuint64 value, GLuint64 timeout)
+{
+    if (value > value_)
+        return false;
+    return Wait(timeout);
+}
+
 
 } // /namespace LLGL
 
@@ -32,9 +32,16 @@ class GLFence final : public Fence
         void Submit();
         bool Wait(GLuint64 timeout);
 
+        // Submits a new sync object and stores the specified value as the last signaled value.
+        void Submit(GLuint64 value);
+
+        // Waits until the specified value has been signaled. Only the last submitted value can be tracked by the sync object.
+        bool Wait(GLuint64 value, GLuint64 timeout);
+
     private:
 
-        GLsync      sync_ = 0;
+        GLsync      sync_   = 0;
+        GLuint64    value_  = 0;
 
         #ifdef LLGL_DEBUG
         // Only provide name in debug mode, to keep fence objects as lightweight as possible
@@ -30,7 +30,7 @@ class GLGraphicsPSO final : public GLPipelineState
 
     public:
 
-        GLGraphicsPSO(const GraphicsPipelineDescriptor& desc, const RenderingLimits& limits);
+        GLGraphicsPSO(const GraphicsPipelineDescriptor& desc, const RenderingLimits& limits, Blob* serializedCache = nullptr);
         ~GLGraphicsPSO();
 
         // Binds this graphics pipeline state with the specified GL state manager.
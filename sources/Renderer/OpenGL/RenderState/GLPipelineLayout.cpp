@@ -42,8 +42,24 @@ static bool HasAnyNamedResourceBindings(const PipelineLayoutDescriptor& desc)
 GLPipelineLayout::GLPipelineLayout(const PipelineLayoutDescriptor& desc) :
     heapBindings_     { desc.heapBindings                 },
     uniforms_         { desc.uniforms                     },
-    hasNamedBindings_ { HasAnyNamedResourceBindings(desc) }
+    hasNamedBindings_ { HasAnyNamedResourceBindings(desc) },
+    isBindlessHeap_   { desc.bindlessHeap                 }
 {
+    /* Sampled textures in bindless heaps are only accessed via texture handles if GL_ARB_bindless_texture is supported */
+    hasBindlessTextures_ = (isBindlessHeap_ && HasExtension(GLExt::ARB_bindless_texture));
+
+    /* Reserve linear storage for all resource names, so they are copied with a single allocation */
+    for (const BindingDescriptor& bindingDesc : desc.bindings)
+    {
+        if (!bindingDesc.name.empty())
+            resourceNameBuffer_.Reserve(bindingDesc.name.size());
+    }
+    for (const StaticSamplerDescriptor& staticSamplerDesc : desc.staticSamplers)
+    {
+        if (!staticSamplerDesc.name.empty())
+            resourceNameBuffer_.Reserve(staticSamplerDesc.name.size());
+    }
+
     resourceNames_.reserve(desc.bindings.size() + desc.staticSamplers.size());
     BuildDynamicResourceBindings(desc.bindings);
     BuildStaticSamplers(desc.staticSamplers);
@@ -73,6 +89,11 @@ std::uint32_t GLPipelineLayout::GetNumUniforms() const
     return static_cast<std::uint32_t>(uniforms_.size());
 }
 
+bool GLPipelineLayout::IsBindlessTextureHeapBinding(const BindingDescriptor& binding) const
+{
+    return (hasBindlessTextures_ && binding.type == ResourceType::Texture && (binding.bindFlags & BindFlags::Sampled) != 0);
+}
+
 void GLPipelineLayout::BindStaticSamplers(GLStateManager& stateMngr) const
 {
     if (!staticSamplerSlots_.empty())
@@ -134,7 +155,7 @@ void GLPipelineLayout::BuildDynamicResourceBindings(const std::vector<BindingDes
     for (const auto& desc : bindingDescs)
     {
         bindings_.push_back(GLPipelineResourceBinding{ ToGLResourceType(desc), static_cast<GLuint>(desc.slot.index) });
-        resourceNames_.push_back(desc.name);
+        resourceNames_.push_back(CopyResourceName(desc.name));
     }
 }
 
@@ -152,7 +173,7 @@ void GLPipelineLayout::BuildStaticSamplers(const std::vector<StaticSamplerDescri
             sampler->SamplerParameters(desc.sampler);
             staticSamplersGL2X_.push_back(std::move(sampler));
             staticSamplerSlots_.push_back(desc.slot.index);
-            resourceNames_.push_back(desc.name);
+            resourceNames_.push_back(CopyResourceName(desc.name));
         }
     }
     else
@@ -162,15 +183,20 @@ void GLPipelineLayout::BuildStaticSamplers(const std::vector<StaticSamplerDescri
         for (const auto& desc : staticSamplerDescs)
         {
             /* Create GL3+ sampler and store slot and name separately */
-            auto sampler = MakeUnique<GLSampler>();
-            sampler->SamplerParameters(desc.sampler);
-            staticSamplers_.push_back(std::move(sampler));
+            staticSamplers_.push_back(MakeUnique<GLSampler>(desc.sampler));
             staticSamplerSlots_.push_back(desc.slot.index);
-            resourceNames_.push_back(desc.name);
+            resourceNames_.push_back(CopyResourceName(desc.name));
         }
     }
 }
 
+StringView GLPipelineLayout::CopyResourceName(const std::string& name)
+{
+    if (name.empty())
+        return {};
+    return StringView{ resourceNameBuffer_.CopyString(name), name.size() };
+}
+
 
 } // /namespace LLGL
 
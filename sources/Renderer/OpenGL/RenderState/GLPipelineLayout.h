@@ -12,9 +12,12 @@
 #include <LLGL/PipelineLayout.h>
 #include <LLGL/PipelineLayoutFlags.h>
 #include <LLGL/Container/ArrayView.h>
+#include <LLGL/Container/SmallVector.h>
+#include <LLGL/Container/StringView.h>
 #include "GLResourceType.h"
 #include "../Texture/GLSampler.h"
 #include "../Texture/GL2XSampler.h"
+#include "../../../Core/LinearStringContainer.h"
 #include <vector>
 
 
@@ -52,27 +55,27 @@ class GLPipelineLayout final : public PipelineLayout
         }
 
         // Returns the list of dynamic GL resource bindings.
-        inline const std::vector<GLPipelineResourceBinding>& GetBindings() const
+        inline const SmallVector<GLPipelineResourceBinding>& GetBindings() const
         {
             return bindings_;
         }
 
         // Returns the list of static sampler binding slots.
-        inline const std::vector<GLuint>& GetStaticSamplerSlots() const
+        inline const SmallVector<GLuint>& GetStaticSamplerSlots() const
         {
             return staticSamplerSlots_;
         }
 
         // Returns the list of dynamic resource names. Same list size as GetBindings().
-        inline ArrayView<std::string> GetBindingNames() const
+        inline ArrayView<StringView> GetBindingNames() const
         {
-            return ArrayView<std::string>{ resourceNames_.data(), bindings_.size() };
+            return ArrayView<StringView>{ resourceNames_.data(), bindings_.size() };
         }
 
         // Returns the list of static sampler names.
-        inline ArrayView<std::string> GetStaticSamplerNames() const
+        inline ArrayView<StringView> GetStaticSamplerNames() const
         {
-            return ArrayView<std::string>{ resourceNames_.data() + bindings_.size(), resourceNames_.size() - bindings_.size() };
+            return ArrayView<StringView>{ resourceNames_.data() + bindings_.size(), resourceNames_.size() - bindings_.size() };
         }
 
         // Returns the copied list of uniform descriptors.
@@ -87,23 +90,41 @@ class GLPipelineLayout final : public PipelineLayout
             return hasNamedBindings_;
         }
 
+        // Returns true if the heap bindings form a bindless heap. See PipelineLayoutDescriptor::bindlessHeap.
+        inline bool IsBindlessHeap() const
+        {
+            return isBindlessHeap_;
+        }
+
+        /*
+        Returns true if the specified heap binding is an array of sampled textures that is accessed via bindless texture handles.
+        Such a binding is exposed to the shaders as uniform block at the binding slot instead of a range of texture units.
+        */
+        bool IsBindlessTextureHeapBinding(const BindingDescriptor& binding) const;
+
     private:
 
         void BuildDynamicResourceBindings(const std::vector<BindingDescriptor>& bindingDescs);
         void BuildStaticSamplers(const std::vector<StaticSamplerDescriptor>& staticSamplerDescs);
 
+        // Copies the specified name into the linear name buffer. Empty names don't occupy any memory.
+        StringView CopyResourceName(const std::string& name);
+
     private:
 
-        std::vector<std::string>                resourceNames_; // Dynamic resource and static sampler names; Used by GLShaderBindingLayout
+        LinearStringContainer                   resourceNameBuffer_;    // Linear storage for all names in 'resourceNames_'
+        SmallVector<StringView>                 resourceNames_;         // Dynamic resource and static sampler names; Used by GLShaderBindingLayout
         std::vector<BindingDescriptor>          heapBindings_;
-        std::vector<GLPipelineResourceBinding>  bindings_;
-        std::vector<GLuint>                     staticSamplerSlots_;
+        SmallVector<GLPipelineResourceBinding>  bindings_;
+        SmallVector<GLuint>                     staticSamplerSlots_;
         std::vector<GLSamplerPtr>               staticSamplers_;
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         std::vector<GL2XSamplerPtr>             staticSamplersGL2X_;
         #endif
         std::vector<UniformDescriptor>          uniforms_;
-        const bool                              hasNamedBindings_   = false;
+        const bool                              hasNamedBindings_       = false;
+        const bool                              isBindlessHeap_         = false;
+        bool                                    hasBindlessTextures_    = false;
 
 };
 
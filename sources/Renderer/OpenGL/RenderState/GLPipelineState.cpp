@@ -10,32 +10,70 @@
 #include "GLStateManager.h"
 #include "../GLTypes.h"
 #include "../Shader/GLShaderProgram.h"
+#include "../Shader/GLShaderUniform.h"
+#include "../Buffer/GLStreamingBuffer.h"
+#include "../Shader/GLProgramBinary.h"
+#include "../GLSerialization.h"
 #include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
 #include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
+// Reads the program binaries for each shader permutation from the specified serialized cache. Unknown segments are ignored.
+static void ReadCachedProgramBinaries(const Blob& serializedCache, GLProgramBinary (&outBinaries)[GLShader::PermutationCount])
+{
+    Serialization::Deserializer reader{ serializedCache };
+
+    GLShader::Permutation   permutation = GLShader::PermutationDefault;
+    GLProgramBinary         binary;
+
+    while (Serialization::GLReadSegmentProgramBinary(reader, permutation, binary))
+        outBinaries[permutation] = std::move(binary);
+}
+
 GLPipelineState::GLPipelineState(
     bool                        isGraphicsPSO,
     const PipelineLayout*       pipelineLayout,
-    const ArrayView<Shader*>&   shaders)
+    const ArrayView<Shader*>&   shaders,
+    Blob*                       serializedCache)
 :
     isGraphicsPSO_ { isGraphicsPSO }
 {
+    /* Defer querying the link status until the PSO is used, so the driver can link all shader pipelines in the background */
+    hasPendingLinkStatus_ = GLShader::IsParallelCompileSupported();
+
+    /* Read program binaries from serialized cache of a previous run */
+    GLProgramBinary cachedBinaries[GLShader::PermutationCount];
+    if (serializedCache != nullptr && *serializedCache)
+        ReadCachedProgramBinaries(*serializedCache, cachedBinaries);
+
     for_range(permutationIndex, GLShader::PermutationCount)
     {
         const GLShader::Permutation permutation = static_cast<GLShader::Permutation>(permutationIndex);
         if (GLShader::HasAnyShaderPermutation(permutation, shaders))
         {
-            /* Create shader pipeline for current permutation */
-            shaderPipelines_[permutation] = GLStatePool::Get().CreateShaderPipeline(shaders.size(), shaders.data(), permutation);
+            /*
+            Create shader pipeline for current permutation. Alternate permutations are only linked on first use,
+            since many PSOs are never bound with a render target. A serialized cache requires all programs to be linked.
+            */
+            const bool deferLinking = (permutation != GLShader::PermutationDefault && serializedCache == nullptr);
+            shaderPipelines_[permutation] = GLStatePool::Get().CreateShaderPipeline(
+                shaders.size(),
+                shaders.data(),
+                permutation,
+                (serializedCache != nullptr ? &cachedBinaries[permutation] : nullptr),
+                deferLinking
+            );
 
             /* Query information log and stop linking shader pipelines if the default permutation has errors */
-            if (permutation == GLShader::PermutationDefault)
+            if (permutation == GLShader::PermutationDefault && !hasPendingLinkStatus_)
             {
                 shaderPipelines_[GLShader::PermutationDefault]->QueryInfoLogs(report_);
                 if (report_.HasErrors())
@@ -57,12 +95,13 @@ GLPipelineState::GLPipelineState(
         }
 
         /* Build uniform table */
-        for_range(permutationIndex, GLShader::PermutationCount)
-        {
-            const GLShader::Permutation permutation = static_cast<GLShader::Permutation>(permutationIndex);
-            BuildUniformMap(permutation, pipelineLayout_->GetUniforms());
-        }
+        if (!hasPendingLinkStatus_)
+            BuildUniformMap(GLShader::PermutationDefault, pipelineLayout_->GetUniforms());
     }
+
+    /* Return program binaries as serialized cache */
+    if (serializedCache != nullptr)
+        *serializedCache = SerializeProgramBinaries();
 }
 
 GLPipelineState::~GLPipelineState()
@@ -74,11 +113,36 @@ GLPipelineState::~GLPipelineState()
 
 const Report* GLPipelineState::GetReport() const
 {
+    if (hasPendingLinkStatus_)
+        FlushPendingLinkStatus();
     return (report_ ? &report_ : nullptr);
 }
 
+bool GLPipelineState::IsReady() const
+{
+    if (hasPendingLinkStatus_)
+    {
+        for (const auto& shaderPipeline : shaderPipelines_)
+        {
+            if (shaderPipeline && !shaderPipeline->IsReady())
+                return false;
+        }
+    }
+    return true;
+}
+
+void GLPipelineState::Wait()
+{
+    /* Querying the link status blocks until the driver has finished compiling and linking */
+    if (hasPendingLinkStatus_)
+        FlushPendingLinkStatus();
+}
+
 void GLPipelineState::Bind(GLStateManager& stateMngr)
 {
+    if (hasPendingLinkStatus_)
+        FlushPendingLinkStatus();
+
     /* Select shader pipeline permutation depending on what is needed for the current framebuffer */
     const GLShader::Permutation shaderPipelinePermutation =
     (
@@ -95,6 +159,13 @@ void GLPipelineState::Bind(GLStateManager& stateMngr)
     if (shaderBindingLayout_)
         shaderPipeline->BindResourceSlots(*shaderBindingLayout_);
 
+    /*
+    Re-upload emulated uniform block into a new ring buffer region, so draw commands never read from a region that was allocated
+    before the most recent allocation. This allows a ring buffer segment to be fenced as soon as it is retired.
+    */
+    if (HasUniformBlock())
+        UploadUniformBlock(stateMngr);
+
     /* Bind static samplers */
     if (pipelineLayout_ != nullptr)
         pipelineLayout_->BindStaticSamplers(stateMngr);
@@ -105,8 +176,52 @@ void GLPipelineState::Bind(GLStateManager& stateMngr)
  * ======= Private: =======
  */
 
+void GLPipelineState::FlushPendingLinkStatus() const
+{
+    hasPendingLinkStatus_ = false;
+
+    /* Query information log of default permutation and keep errors that were reported during construction */
+    Report linkReport;
+    if (GLShaderPipeline* shaderPipeline = shaderPipelines_[GLShader::PermutationDefault].get())
+        shaderPipeline->QueryInfoLogs(linkReport);
+
+    if (report_)
+    {
+        std::string text = linkReport.GetText();
+        text += report_.GetText();
+        report_.Reset(std::move(text), linkReport.HasErrors() || report_.HasErrors());
+    }
+    else
+        report_ = std::move(linkReport);
+
+    /* Build uniform table */
+    if (pipelineLayout_ != nullptr)
+        BuildUniformMap(GLShader::PermutationDefault, pipelineLayout_->GetUniforms());
+}
+
+Blob GLPipelineState::SerializeProgramBinaries() const
+{
+    Serialization::Serializer writer;
+
+    for_range(permutationIndex, GLShader::PermutationCount)
+    {
+        if (const GLShaderPipeline* shaderPipeline = shaderPipelines_[permutationIndex].get())
+        {
+            GLProgramBinary binary;
+            if (shaderPipeline->GetProgramBinary(binary))
+                Serialization::GLWriteSegmentProgramBinary(writer, static_cast<GLShader::Permutation>(permutationIndex), binary);
+        }
+    }
+
+    return writer.Finalize();
+}
+
+/*
+The uniform map is only built for the default permutation, because alternate permutations may not be linked yet.
+They only differ in the final gl_Position statement and declare the same uniforms.
+*/
 //TODO: support separate shaders; each separable shader needs its own set of uniform locations
-void GLPipelineState::BuildUniformMap(GLShader::Permutation permutation, const std::vector<UniformDescriptor>& uniforms)
+void GLPipelineState::BuildUniformMap(GLShader::Permutation permutation, const std::vector<UniformDescriptor>& uniforms) const
 {
     if (shaderPipelines_[permutation].get() != nullptr && !uniforms.empty())
     {
@@ -116,6 +231,31 @@ void GLPipelineState::BuildUniformMap(GLShader::Permutation permutation, const s
         uniformMap_.resize(uniforms.size());
         for_range(i, uniforms.size())
             BuildUniformLocation(program, uniformMap_[i], uniforms[i]);
+
+        #ifdef GL_ARB_uniform_buffer_object
+
+        /* Emulate uniforms that are declared inside a uniform block with a ring buffer; only a single block can be emulated */
+        if (HasExtension(GLExt::ARB_uniform_buffer_object) && GLStreamingBuffer::IsSupported())
+        {
+            GLuint blockIndex = GL_INVALID_INDEX;
+
+            for_range(i, uniforms.size())
+            {
+                if (uniformMap_[i].location != -1)
+                    continue;
+
+                const GLuint uniformBlockIndex = BuildUniformBlockLocation(program, uniformMap_[i], uniforms[i]);
+                if (blockIndex == GL_INVALID_INDEX)
+                    blockIndex = uniformBlockIndex;
+                else if (uniformBlockIndex != blockIndex)
+                    uniformMap_[i].blockOffset = -1;
+            }
+
+            if (blockIndex != GL_INVALID_INDEX)
+                BuildUniformBlockShadow(program, blockIndex);
+        }
+
+        #endif // /GL_ARB_uniform_buffer_object
     }
 }
 
@@ -170,17 +310,54 @@ static GLuint GetUniformWordSize(GLenum type)
     }
 }
 
-void GLPipelineState::BuildUniformLocation(GLuint program, GLUniformLocation& outUniform, const UniformDescriptor& inUniform)
+// Returns the number of matrix columns for the specified GL uniform type, or 1 for scalars and vectors
+static GLuint GetUniformColumns(GLenum type)
+{
+    switch (type)
+    {
+        case GL_FLOAT_MAT2:
+        case GL_FLOAT_MAT2x3:
+        case GL_FLOAT_MAT2x4:
+        case GL_DOUBLE_MAT2:
+        case GL_DOUBLE_MAT2x3:
+        case GL_DOUBLE_MAT2x4:
+            return 2;
+
+        case GL_FLOAT_MAT3x2:
+        case GL_FLOAT_MAT3:
+        case GL_FLOAT_MAT3x4:
+        case GL_DOUBLE_MAT3x2:
+        case GL_DOUBLE_MAT3:
+        case GL_DOUBLE_MAT3x4:
+            return 3;
+
+        case GL_FLOAT_MAT4x2:
+        case GL_FLOAT_MAT4x3:
+        case GL_FLOAT_MAT4:
+        case GL_DOUBLE_MAT4x2:
+        case GL_DOUBLE_MAT4x3:
+        case GL_DOUBLE_MAT4:
+            return 4;
+
+        default:
+            return 1;
+    }
+}
+
+void GLPipelineState::BuildUniformLocation(GLuint program, GLUniformLocation& outUniform, const UniformDescriptor& inUniform) const
 {
     /* Find uniform location by name in shader pipeline */
     GLint location = glGetUniformLocation(program, inUniform.name.c_str());
     if (location == -1)
     {
         /* Write invalid uniform location */
-        outUniform.type     = UniformType::Undefined;
-        outUniform.location = -1;
-        outUniform.count    = 0;
-        outUniform.wordSize = 0;
+        outUniform.type         = UniformType::Undefined;
+        outUniform.location     = -1;
+        outUniform.count        = 0;
+        outUniform.wordSize     = 0;
+        outUniform.blockOffset  = -1;
+        outUniform.matrixStride = 0;
+        outUniform.columns      = 1;
     }
     else
     {
@@ -190,10 +367,150 @@ void GLPipelineState::BuildUniformLocation(GLuint program, GLUniformLocation& ou
         glGetActiveUniform(program, static_cast<GLuint>(location), 0, nullptr, &size, &type, nullptr);
 
         /* Write output uniform */
-        outUniform.type     = GLTypes::UnmapUniformType(type);
-        outUniform.location = location;
-        outUniform.count    = size;
-        outUniform.wordSize = GetUniformWordSize(type);
+        outUniform.type         = GLTypes::UnmapUniformType(type);
+        outUniform.location     = location;
+        outUniform.count        = size;
+        outUniform.wordSize     = GetUniformWordSize(type);
+        outUniform.blockOffset  = -1;
+        outUniform.matrixStride = 0;
+        outUniform.columns      = GetUniformColumns(type);
+    }
+}
+
+GLuint GLPipelineState::BuildUniformBlockLocation(GLuint program, GLUniformLocation& outUniform, const UniformDescriptor& inUniform) const
+{
+    #ifdef GL_ARB_uniform_buffer_object
+
+    /* Find uniform index by name, since uniforms inside a uniform block have no location */
+    const GLchar* name = inUniform.name.c_str();
+    GLuint index = GL_INVALID_INDEX;
+    glGetUniformIndices(program, 1, &name, &index);
+    if (index == GL_INVALID_INDEX)
+        return GL_INVALID_INDEX;
+
+    GLint blockIndex    = -1;
+    GLint offset        = -1;
+    GLint matrixStride  = 0;
+    GLint isRowMajor    = GL_FALSE;
+    glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+    glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &offset);
+    glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_MATRIX_STRIDE, &matrixStride);
+    glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_IS_ROW_MAJOR, &isRowMajor);
+
+    /* Row-major matrices are not supported, since SetUniforms expects the column-major layout of glUniformMatrix* */
+    if (blockIndex < 0 || offset < 0 || isRowMajor != GL_FALSE)
+        return GL_INVALID_INDEX;
+
+    /* Determine type of uniform */
+    GLenum type = 0;
+    GLint size = 0;
+    glGetActiveUniform(program, index, 0, nullptr, &size, &type, nullptr);
+
+    /* Write output uniform; each SetUniforms call writes the first array element just like for the default uniform block */
+    outUniform.type         = GLTypes::UnmapUniformType(type);
+    outUniform.location     = -1;
+    outUniform.count        = size;
+    outUniform.wordSize     = GetUniformWordSize(type);
+    outUniform.blockOffset  = offset;
+    outUniform.matrixStride = matrixStride;
+    outUniform.columns      = GetUniformColumns(type);
+
+    return static_cast<GLuint>(blockIndex);
+
+    #else
+
+    return ~0u;
+
+    #endif // /GL_ARB_uniform_buffer_object
+}
+
+void GLPipelineState::BuildUniformBlockShadow(GLuint program, GLuint blockIndex) const
+{
+    #ifdef GL_ARB_uniform_buffer_object
+
+    GLint blockSize         = 0;
+    GLint blockBinding      = 0;
+    GLint offsetAlignment   = 1;
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize);
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_BINDING, &blockBinding);
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    offsetAlignment = std::max(1, offsetAlignment);
+
+    if (blockSize > 0 && GLStreamingBuffer::GetUniform().IsAvailable(static_cast<GLsizeiptr>(blockSize) + offsetAlignment))
+    {
+        uniformBlock_.binding   = static_cast<GLuint>(blockBinding);
+        uniformBlock_.alignment = static_cast<GLintptr>(offsetAlignment);
+        uniformBlock_.data.resize(static_cast<std::size_t>(blockSize), 0);
+    }
+    else
+    {
+        /* Invalidate uniforms of this block but keep their word size, so SetUniforms still skips their data */
+        for (GLUniformLocation& uniform : uniformMap_)
+        {
+            if (uniform.blockOffset >= 0)
+            {
+                uniform.type        = UniformType::Undefined;
+                uniform.blockOffset = -1;
+            }
+        }
+    }
+
+    #endif // /GL_ARB_uniform_buffer_object
+}
+
+void GLPipelineState::SetUniformBlockData(GLStateManager& stateMngr, std::uint32_t first, const void* data, std::uint32_t dataSize) const
+{
+    const std::uint32_t dataSizeInWords = dataSize / 4;
+    bool isBlockModified = false;
+
+    for (auto words = reinterpret_cast<const std::uint32_t*>(data), wordsEnd = words + dataSizeInWords; words < wordsEnd; ++first)
+    {
+        if (first >= uniformMap_.size())
+            break /*GL_INVALID_INDEX*/;
+
+        const GLUniformLocation& uniform = uniformMap_[first];
+        if (uniform.wordSize == 0 || uniform.wordSize > static_cast<std::uint32_t>(wordsEnd - words))
+            break /*GL_INVALID_VALUE*/;
+
+        if (uniform.blockOffset >= 0)
+        {
+            /* Copy matrix columns separately, because their stride within a uniform block can be larger than the column size */
+            const std::size_t   columnSize  = uniform.wordSize / uniform.columns * 4;
+            const char*         src         = reinterpret_cast<const char*>(words);
+            char*               dst         = uniformBlock_.data.data() + uniform.blockOffset;
+
+            for_range(column, uniform.columns)
+                ::memcpy(dst + column * uniform.matrixStride, src + column * columnSize, columnSize);
+
+            isBlockModified = true;
+        }
+        else
+            GLSetUniformsByType(uniform.type, uniform.location, uniform.count, words);
+
+        words += uniform.wordSize;
+    }
+
+    if (isBlockModified)
+        UploadUniformBlock(stateMngr);
+}
+
+void GLPipelineState::UploadUniformBlock(GLStateManager& stateMngr) const
+{
+    GLStreamingBuffer&  ringBuffer  = GLStreamingBuffer::GetUniform();
+    const GLsizeiptr    size        = static_cast<GLsizeiptr>(uniformBlock_.data.size());
+    GLintptr            offset      = 0;
+
+    /* Wait for the next segment if necessary, since there is no other path to upload the uniform block */
+    if (void* dst = ringBuffer.Alloc(size, offset, uniformBlock_.alignment, true))
+    {
+        ::memcpy(dst, uniformBlock_.data.data(), uniformBlock_.data.size());
+        stateMngr.BindBufferRange(GLBufferTarget::UniformBuffer, uniformBlock_.binding, ringBuffer.GetID(), offset, size);
+
+        /*
+        The region can be completed right away: its segment is only fenced when a later allocation retires it,
+        and all draw commands that read this region are issued before the next allocation (see Bind()).
+        */
+        ringBuffer.Complete(offset);
     }
 }
 
@@ -17,7 +17,9 @@
 #include <LLGL/PipelineState.h>
 #include <LLGL/RenderSystemFlags.h>
 #include <LLGL/Container/ArrayView.h>
+#include <LLGL/Blob.h>
 #include <memory>
+#include <vector>
 
 
 namespace LLGL
@@ -34,7 +36,21 @@ struct GLUniformLocation
     UniformType type;
     GLint       location;
     GLsizei     count;
-    GLuint      wordSize; // Size in words (32-bit values)
+    GLuint      wordSize;       // Size in words (32-bit values)
+    GLint       blockOffset;    // Byte offset within the emulated uniform block, or -1 if the uniform is not declared in that block.
+    GLint       matrixStride;   // Byte stride between matrix columns within the uniform block.
+    GLuint      columns;        // Number of matrix columns, or 1 for scalars and vectors.
+};
+
+/*
+CPU copy of the uniform block that SetUniforms writes into when the uniforms of a pipeline layout are declared inside a uniform block.
+The entire block is re-uploaded into a region of the uniform ring buffer on each update and bound with glBindBufferRange.
+*/
+struct GLUniformBlockShadow
+{
+    GLuint              binding     = 0;
+    GLintptr            alignment   = 1;
+    std::vector<char>   data;
 };
 
 // Base class for OpenGL PSOs.
@@ -43,14 +59,23 @@ class GLPipelineState : public PipelineState
 
     public:
 
+        /*
+        Creates the shader pipelines for all required permutations.
+        If 'serializedCache' is not null, the shader programs are restored from the program binaries it contains (if any),
+        and the cache is replaced with the program binaries of this PSO afterwards.
+        If parallel shader compilation is supported, the link status is not queried until the PSO is bound or its report is requested.
+        */
         GLPipelineState(
             bool                        isGraphicsPSO,
             const PipelineLayout*       pipelineLayout,
-            const ArrayView<Shader*>&   shaders
+            const ArrayView<Shader*>&   shaders,
+            Blob*                       serializedCache = nullptr
         );
         ~GLPipelineState();
 
         const Report* GetReport() const override;
+        bool IsReady() const override;
+        void Wait() override;
 
         // Binds this pipeline state with the specified GL state manager.
         virtual void Bind(GLStateManager& stateMngr);
@@ -76,9 +101,23 @@ class GLPipelineState : public PipelineState
         // Returns the list of uniforms that maps from index of 'PipelineLayoutDescriptor::uniforms[]' to GL uniform location.
         inline const std::vector<GLUniformLocation>& GetUniformMap() const
         {
+            if (hasPendingLinkStatus_)
+                FlushPendingLinkStatus();
             return uniformMap_;
         }
 
+        // Returns true if any uniform of the uniform map is declared inside the emulated uniform block. Only valid after GetUniformMap() was called.
+        inline bool HasUniformBlock() const
+        {
+            return !uniformBlock_.data.empty();
+        }
+
+        /*
+        Writes the uniforms that are declared inside the emulated uniform block into its CPU copy and uploads the block into the uniform ring buffer.
+        Uniforms in the default uniform block are written with glUniform*. This has the same semantics as CommandBuffer::SetUniforms.
+        */
+        void SetUniformBlockData(GLStateManager& stateMngr, std::uint32_t first, const void* data, std::uint32_t dataSize) const;
+
     protected:
 
         // Returns a mutable reference to the PSO report.
@@ -89,20 +128,37 @@ class GLPipelineState : public PipelineState
 
     private:
 
+        // Queries the link status of the default permutation and builds the uniform map if this was deferred during construction.
+        void FlushPendingLinkStatus() const;
+
+        // Returns the program binaries of all shader pipelines as serialized cache.
+        Blob SerializeProgramBinaries() const;
+
         // Builds the index-to-uniform map.
-        void BuildUniformMap(GLShader::Permutation permutation, const std::vector<UniformDescriptor>& uniforms);
+        void BuildUniformMap(GLShader::Permutation permutation, const std::vector<UniformDescriptor>& uniforms) const;
 
         // Builds the specified uniform location.
-        void BuildUniformLocation(GLuint program, GLUniformLocation& outUniform, const UniformDescriptor& inUniform);
+        void BuildUniformLocation(GLuint program, GLUniformLocation& outUniform, const UniformDescriptor& inUniform) const;
+
+        // Builds the location of the specified uniform inside a uniform block. Returns the block index or GL_INVALID_INDEX.
+        GLuint BuildUniformBlockLocation(GLuint program, GLUniformLocation& outUniform, const UniformDescriptor& inUniform) const;
+
+        // Allocates the CPU copy of the uniform block with the specified index.
+        void BuildUniformBlockShadow(GLuint program, GLuint blockIndex) const;
+
+        // Uploads the CPU copy of the uniform block into a new region of the uniform ring buffer and binds that region.
+        void UploadUniformBlock(GLStateManager& stateMngr) const;
 
     private:
 
-        const bool                      isGraphicsPSO_                                  = false;
-        const GLPipelineLayout*         pipelineLayout_                                 = nullptr;
-        GLShaderPipelineSPtr            shaderPipelines_[GLShader::PermutationCount];
-        GLShaderBindingLayoutSPtr       shaderBindingLayout_;
-        std::vector<GLUniformLocation>  uniformMap_;
-        Report                          report_;
+        const bool                              isGraphicsPSO_                                  = false;
+        const GLPipelineLayout*                 pipelineLayout_                                 = nullptr;
+        GLShaderPipelineSPtr                    shaderPipelines_[GLShader::PermutationCount];
+        GLShaderBindingLayoutSPtr               shaderBindingLayout_;
+        mutable std::vector<GLUniformLocation>  uniformMap_;
+        mutable GLUniformBlockShadow            uniformBlock_;
+        mutable Report                          report_;
+        mutable bool                            hasPendingLinkStatus_                           = false;
 
 };
 
@@ -6,12 +6,14 @@
  */
 
 #include "GLQueryHeap.h"
+#include "GLStateManager.h"
 #include "../GLObjectUtils.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../GLTypes.h"
 #include "../../../Core/Assertion.h"
 #include <LLGL/Utils/ForRange.h>
+#include <cstddef>
 
 
 namespace LLGL
@@ -48,6 +50,7 @@ static GLenum MapQueryType(const QueryType queryType, std::size_t idx)
         case QueryType::AnySamplesPassedConservative:       return GL_ANY_SAMPLES_PASSED_CONSERVATIVE;
         #ifdef LLGL_OPENGL
         case QueryType::TimeElapsed:                        return GL_TIME_ELAPSED;
+        case QueryType::Timestamp:                          return GL_TIMESTAMP;
         #endif
         case QueryType::StreamOutPrimitivesWritten:         return GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN;
         #ifdef GL_ARB_transform_feedback_overflow_query
@@ -85,6 +88,14 @@ GLQueryHeap::GLQueryHeap(const QueryHeapDescriptor& desc) :
 
 GLQueryHeap::~GLQueryHeap()
 {
+    #ifdef GL_ARB_query_buffer_object
+    DeleteResolveFence();
+    if (resultBuffer_ != 0)
+    {
+        glDeleteBuffers(1, &resultBuffer_);
+        GLStateManager::Get().NotifyBufferRelease(resultBuffer_, GLBufferTarget::QueryBuffer);
+    }
+    #endif // /GL_ARB_query_buffer_object
     glDeleteQueries(static_cast<GLsizei>(ids_.size()), ids_.data());
 }
 
@@ -105,18 +116,146 @@ void GLQueryHeap::SetName(const char* name)
 
 void GLQueryHeap::Begin(std::uint32_t query)
 {
+    /* Single timestamps are only written in End() */
+    if (GetType() == QueryType::Timestamp)
+        return;
+
     /* Begin all queries in forward order: [0, n) */
     for_range(i, groupSize_)
         glBeginQuery(MapQueryType(GetType(), i), ids_[i + groupSize_ * query]);
 }
 
-void GLQueryHeap::End()
+void GLQueryHeap::End(std::uint32_t query)
 {
+    if (GetType() == QueryType::Timestamp)
+    {
+        /* Record timestamp once all previous commands have been completed */
+        #ifdef GL_ARB_timer_query
+        if (HasExtension(GLExt::ARB_timer_query))
+            glQueryCounter(ids_[query], GL_TIMESTAMP);
+        #endif
+        return;
+    }
+
     /* End all queries in reverse order: (n, 0] */
     for_range_reverse(i, groupSize_)
         glEndQuery(MapQueryType(GetType(), i));
 }
 
+#ifdef GL_ARB_query_buffer_object
+
+/*
+Entry of a resolved query within the result buffer.
+The availability flag is stored next to the result so a single buffer read-back covers both.
+*/
+struct GLResolvedQuery
+{
+    GLuint64    result;
+    GLuint      available;
+    GLuint      padding;
+};
+
+static_assert(sizeof(GLResolvedQuery) == 16, "GLResolvedQuery must be 16 bytes");
+
+bool GLQueryHeap::ResolveResults(std::uint32_t firstID, std::uint32_t numIDs, std::uint64_t* outResults)
+{
+    if (resolveFence_ != 0)
+    {
+        if (resolveFirst_ == firstID && resolveCount_ == numIDs)
+        {
+            /* Poll previous resolve without waiting */
+            const GLenum status = glClientWaitSync(resolveFence_, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            if (status == GL_TIMEOUT_EXPIRED)
+                return false;
+
+            DeleteResolveFence();
+
+            /* Read back all results at once; if any query was still pending at resolve time, issue another resolve below */
+            if (status != GL_WAIT_FAILED && ReadResolvedResults(firstID, numIDs, outResults))
+                return true;
+        }
+        else
+        {
+            /* Discard resolve of a different query range */
+            DeleteResolveFence();
+        }
+    }
+
+    IssueResolve(firstID, numIDs);
+    return false;
+}
+
+void GLQueryHeap::CreateResultBuffer()
+{
+    glGenBuffers(1, &resultBuffer_);
+    GLStateManager::Get().BindBuffer(GLBufferTarget::QueryBuffer, resultBuffer_);
+    glBufferData(GL_QUERY_BUFFER, static_cast<GLsizeiptr>(ids_.size() * sizeof(GLResolvedQuery)), nullptr, GL_DYNAMIC_READ);
+}
+
+void GLQueryHeap::IssueResolve(std::uint32_t firstID, std::uint32_t numIDs)
+{
+    if (resultBuffer_ == 0)
+        CreateResultBuffer();
+    else
+        GLStateManager::Get().BindBuffer(GLBufferTarget::QueryBuffer, resultBuffer_);
+
+    /*
+    While a buffer is bound to GL_QUERY_BUFFER, the pointer argument of glGetQueryObject* is an offset into that buffer,
+    so the driver writes all results on the GPU timeline. The availability flag is written before the result,
+    so a flag that reads as GL_TRUE always belongs to a result that was final at resolve time.
+    */
+    for_range(i, numIDs)
+    {
+        const GLuint    id      = ids_[firstID + i];
+        const GLintptr  offset  = static_cast<GLintptr>((firstID + i) * sizeof(GLResolvedQuery));
+        glGetQueryObjectuiv(id, GL_QUERY_RESULT_AVAILABLE, reinterpret_cast<GLuint*>(offset + offsetof(GLResolvedQuery, available)));
+        glGetQueryObjectui64v(id, GL_QUERY_RESULT_NO_WAIT, reinterpret_cast<GLuint64*>(offset + offsetof(GLResolvedQuery, result)));
+    }
+
+    GLStateManager::Get().BindBuffer(GLBufferTarget::QueryBuffer, 0);
+
+    /* Fence the resolve so its completion can be polled without stalling */
+    resolveFence_   = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    resolveFirst_   = firstID;
+    resolveCount_   = numIDs;
+}
+
+bool GLQueryHeap::ReadResolvedResults(std::uint32_t firstID, std::uint32_t numIDs, std::uint64_t* outResults)
+{
+    std::vector<GLResolvedQuery> resolvedQueries(numIDs);
+
+    GLStateManager::Get().BindBuffer(GLBufferTarget::QueryBuffer, resultBuffer_);
+    glGetBufferSubData(
+        GL_QUERY_BUFFER,
+        static_cast<GLintptr>(firstID * sizeof(GLResolvedQuery)),
+        static_cast<GLsizeiptr>(numIDs * sizeof(GLResolvedQuery)),
+        resolvedQueries.data()
+    );
+    GLStateManager::Get().BindBuffer(GLBufferTarget::QueryBuffer, 0);
+
+    for_range(i, numIDs)
+    {
+        if (resolvedQueries[i].available == GL_FALSE)
+            return false;
+    }
+
+    for_range(i, numIDs)
+        outResults[i] = resolvedQueries[i].result;
+
+    return true;
+}
+
+void GLQueryHeap::DeleteResolveFence()
+{
+    if (resolveFence_ != 0)
+    {
+        glDeleteSync(resolveFence_);
+        resolveFence_ = 0;
+    }
+}
+
+#endif // /GL_ARB_query_buffer_object
+
 
 } // /namespace LLGL
 
@@ -31,7 +31,18 @@ class GLQueryHeap final : public QueryHeap
         ~GLQueryHeap();
 
         void Begin(std::uint32_t query);
-        void End();
+        void End(std::uint32_t query);
+
+        #ifdef GL_ARB_query_buffer_object
+
+        /*
+        Resolves the results of the specified range of query IDs into the query buffer without a CPU round-trip per query.
+        Returns true and writes the results into 'outResults' once the previous resolve of the same range has completed on the GPU.
+        Returns false if the results are not available yet. This function never blocks the CPU.
+        */
+        bool ResolveResults(std::uint32_t firstID, std::uint32_t numIDs, std::uint64_t* outResults);
+
+        #endif // /GL_ARB_query_buffer_object
 
         // Returns the the specified query ID.
         inline GLuint GetID(std::uint32_t query) const
@@ -51,10 +62,26 @@ class GLQueryHeap final : public QueryHeap
             return groupSize_;
         }
 
+    private:
+
+        #ifdef GL_ARB_query_buffer_object
+
+        void CreateResultBuffer();
+        void IssueResolve(std::uint32_t firstID, std::uint32_t numIDs);
+        bool ReadResolvedResults(std::uint32_t firstID, std::uint32_t numIDs, std::uint64_t* outResults);
+        void DeleteResolveFence();
+
+        #endif // /GL_ARB_query_buffer_object
+
     private:
 
         std::vector<GLuint> ids_;
-        std::uint32_t       groupSize_  = 1;
+        std::uint32_t       groupSize_      = 1;
+
+        GLuint              resultBuffer_   = 0;
+        GLsync              resolveFence_   = 0;
+        std::uint32_t       resolveFirst_   = 0;
+        std::uint32_t       resolveCount_   = 0;
 
 };
 
@@ -7,13 +7,33 @@
 
 #include "GLRenderPass.h"
 #include "../../RenderPassUtils.h"
+#include "../../../Core/Exception.h"
 #include <LLGL/CommandBufferFlags.h>
+#include <LLGL/Utils/ForRange.h>
 
 
 namespace LLGL
 {
 
 
+constexpr std::uint32_t GLRenderPass::invalidateDepthBit;
+constexpr std::uint32_t GLRenderPass::invalidateStencilBit;
+
+static void AppendInvalidateBit(
+    const AttachmentFormatDescriptor&   attachmentDesc,
+    std::uint32_t                       bit,
+    std::uint32_t&                      outInvalidateOnBeginMask,
+    std::uint32_t&                      outInvalidateOnEndMask)
+{
+    if (attachmentDesc.format != Format::Undefined)
+    {
+        if (attachmentDesc.loadOp == AttachmentLoadOp::Undefined)
+            outInvalidateOnBeginMask |= bit;
+        if (attachmentDesc.storeOp == AttachmentStoreOp::Undefined)
+            outInvalidateOnEndMask |= bit;
+    }
+}
+
 GLRenderPass::GLRenderPass(const RenderPassDescriptor& desc)
 {
     /* Check which color attachment must be cleared */
@@ -28,6 +48,24 @@ GLRenderPass::GLRenderPass(const RenderPassDescriptor& desc)
     /* Check if stencil attachment must be cleared */
     if (desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
         clearMask_ |= GL_STENCIL_BUFFER_BIT;
+
+    /* Check which attachments can be invalidated, so tile-based GPUs don't have to load or store their content */
+    for_range(i, LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+    {
+        if (desc.colorAttachments[i].format == Format::Undefined)
+            break;
+        AppendInvalidateBit(desc.colorAttachments[i], (1u << i), invalidateOnBeginMask_, invalidateOnEndMask_);
+    }
+    AppendInvalidateBit(desc.depthAttachment, invalidateDepthBit, invalidateOnBeginMask_, invalidateOnEndMask_);
+    AppendInvalidateBit(desc.stencilAttachment, invalidateStencilBit, invalidateOnBeginMask_, invalidateOnEndMask_);
+
+    /* GL_OVR_multiview2 only renders a consecutive range of array layers, starting with the attachment's base layer */
+    if (desc.viewMask != 0)
+    {
+        if ((desc.viewMask & (desc.viewMask + 1)) != 0)
+            LLGL_TRAP("multiview mask 0x%08X is not supported with OpenGL; views must be consecutive starting with the first view", desc.viewMask);
+        numViews_ = NumMultiviewViews(desc.viewMask);
+    }
 }
 
 
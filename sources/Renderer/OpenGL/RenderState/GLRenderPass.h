@@ -23,6 +23,12 @@ namespace LLGL
 class GLRenderPass final : public RenderPass
 {
 
+    public:
+
+        // Bits for the invalidation masks of the depth and stencil attachments. The lower bits denote the color attachments.
+        static constexpr std::uint32_t invalidateDepthBit   = (1u << LLGL_MAX_NUM_COLOR_ATTACHMENTS);
+        static constexpr std::uint32_t invalidateStencilBit = (1u << (LLGL_MAX_NUM_COLOR_ATTACHMENTS + 1));
+
     public:
 
         GLRenderPass(const RenderPassDescriptor& desc);
@@ -45,11 +51,32 @@ class GLRenderPass final : public RenderPass
             return clearColorAttachments_;
         }
 
+        // Returns the bitmask of attachments whose content is invalidated when a render pass begins, i.e. attachments with AttachmentLoadOp::Undefined.
+        inline std::uint32_t GetInvalidateOnBeginMask() const
+        {
+            return invalidateOnBeginMask_;
+        }
+
+        // Returns the bitmask of attachments whose content is invalidated when a render pass ends, i.e. attachments with AttachmentStoreOp::Undefined.
+        inline std::uint32_t GetInvalidateOnEndMask() const
+        {
+            return invalidateOnEndMask_;
+        }
+
+        // Returns the number of views for multiview rendering (GL_OVR_multiview2) or 0 if multiview is disabled.
+        inline std::uint32_t GetNumViews() const
+        {
+            return numViews_;
+        }
+
     private:
 
         GLbitfield      clearMask_                                              = 0;
         std::uint8_t    clearColorAttachments_[LLGL_MAX_NUM_COLOR_ATTACHMENTS]  = {};
         std::uint8_t    numColorAttachments_                                    = 0;
+        std::uint32_t   invalidateOnBeginMask_                                  = 0;
+        std::uint32_t   invalidateOnEndMask_                                    = 0;
+        std::uint32_t   numViews_                                               = 0;
 
 };
 
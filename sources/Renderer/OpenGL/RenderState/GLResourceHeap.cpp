@@ -17,6 +17,7 @@
 #endif
 #include "../Texture/GLTexture.h"
 #include "../Texture/GLTextureViewPool.h"
+#include "../Texture/GLTextureHandlePool.h"
 #include "../../CheckedCast.h"
 #include "../../BindingDescriptorIterator.h"
 #include "../GLTypes.h"
@@ -31,6 +32,7 @@
 #include <LLGL/Utils/ForRange.h>
 #include <string.h>
 #include <limits.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -97,6 +99,9 @@ LLGL_ASSERT_POD_TYPE(GLResourceHeapSegment);
 #define GLRESOURCEHEAP_DATA1(PTR, TYPE)     reinterpret_cast<TYPE*>((PTR) + GLRESOURCEHEAP_CONST_SEGMENT(PTR)->data1Offset)
 #define GLRESOURCEHEAP_DATA2(PTR, TYPE)     reinterpret_cast<TYPE*>((PTR) + GLRESOURCEHEAP_CONST_SEGMENT(PTR)->data2Offset)
 
+// Array stride (in bytes) of texture handles in a uniform block with std140 layout, e.g. "layout(std140) uniform Textures { sampler2D tex[N]; }".
+static constexpr GLintptr g_bindlessHandleStride = 16;
+
 // Returns true if the specified buffer view is enabled for OpenGL bindings
 static bool IsGLBufferViewEnabled(const BufferViewDescriptor& bufferViewDesc)
 {
@@ -137,8 +142,13 @@ GLResourceHeap::GLResourceHeap(
     if (!pipelineLayoutGL)
         throw std::invalid_argument("failed to create resource heap due to missing pipeline layout");
 
+    /* Flatten heap bindings into one binding per array element for bindless heaps */
+    std::vector<BindingDescriptor> bindlessBindings;
+    if (pipelineLayoutGL->IsBindlessHeap())
+        BuildBindlessHeapBindings(*pipelineLayoutGL, bindlessBindings);
+
     /* Get and validate number of bindings and resource views */
-    const auto& bindings            = pipelineLayoutGL->GetHeapBindings();
+    const auto& bindings            = (pipelineLayoutGL->IsBindlessHeap() ? bindlessBindings : pipelineLayoutGL->GetHeapBindings());
     const auto  numBindings         = static_cast<std::uint32_t>(bindings.size());
     const auto  numResourceViews    = GetNumResourceViewsOrThrow(numBindings, desc, initialResourceViews);
 
@@ -161,6 +171,10 @@ GLResourceHeap::GLResourceHeap(
     const auto numSegmentSets = (numResourceViews / numBindings);
     heap_.FinalizeSegments(numSegmentSets);
 
+    /* Allocate texture handle tables for bindless textures */
+    if (numBindlessTexturesPerSet_ > 0)
+        CreateBindlessHandleBuffer(numSegmentSets);
+
     /* Write initial resource views */
     if (!initialResourceViews.empty())
         WriteResourceViews(0, initialResourceViews);
@@ -170,6 +184,7 @@ GLResourceHeap::~GLResourceHeap()
 {
     /* Release all texture views for this resource heap */
     FreeAllSegmentsTextureViews();
+    DeleteBindlessHandleBuffer();
 }
 
 std::uint32_t GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
@@ -197,6 +212,15 @@ std::uint32_t GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
         if (desc.resource == nullptr)
             continue;
 
+        /* Write bindless textures into handle table instead of a heap segment */
+        if (const GLBindlessTextureRange* range = FindBindlessTextureRange(firstDescriptor % numBindings))
+        {
+            WriteBindlessTexture(desc, *range, firstDescriptor / numBindings, firstDescriptor % numBindings - range->firstDescriptor);
+            ++numWritten;
+            ++firstDescriptor;
+            continue;
+        }
+
         /* Get binding information and heap start for descriptor set */
         const auto& binding = bindingMap_[firstDescriptor % numBindings];
 
@@ -225,6 +249,8 @@ std::uint32_t GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
                 break;
             case GLResourceType_Sampler:
                 WriteResourceViewSampler(desc, heapPtr, binding.descriptorIndex);
+                if (!bindlessTextureRanges_.empty())
+                    WriteBindlessTextureSampler(desc, descriptorSet, firstDescriptor % numBindings);
                 break;
             case GLResourceType_GL2XSampler:
                 #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -379,6 +405,10 @@ void GLResourceHeap::Bind(GLStateManager& stateMngr, std::uint32_t descriptorSet
         for_range(i, segmentation_.numSamplerSegments)
             heapPtr += BindSamplersSegment(stateMngr, heapPtr);
     }
+
+    /* Bind texture handle tables of bindless textures */
+    if (bindlessHandleBuffer_ != 0)
+        BindBindlessTextureTables(stateMngr, descriptorSet);
 }
 
 
@@ -660,6 +690,201 @@ void GLResourceHeap::Alloc3PartSegment(
     }
 }
 
+void GLResourceHeap::BuildBindlessHeapBindings(const GLPipelineLayout& pipelineLayout, std::vector<BindingDescriptor>& outBindings)
+{
+    GLint offsetAlignment = 1;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    offsetAlignment = std::max(1, offsetAlignment);
+
+    for (const BindingDescriptor& binding : pipelineLayout.GetHeapBindings())
+    {
+        const std::uint32_t numElements = std::max(1u, binding.arraySize);
+        const std::uint32_t firstDescriptor = static_cast<std::uint32_t>(outBindings.size());
+
+        if (pipelineLayout.IsBindlessTextureHeapBinding(binding))
+        {
+            /* Allocate handle table for the entire texture array; descriptors are left as undefined bindings */
+            GLBindlessTextureRange range;
+            {
+                range.firstDescriptor           = firstDescriptor;
+                range.numElements               = numElements;
+                range.firstEntry                = numBindlessTexturesPerSet_;
+                range.slot                      = binding.slot.index;
+                range.bufferOffset              = bindlessHandleBufferStride_;
+                range.firstSamplerDescriptor    = ~0u;
+                range.numSamplerElements        = 0;
+            }
+            bindlessTextureRanges_.push_back(range);
+
+            const GLsizeiptr tableSize = static_cast<GLsizeiptr>(numElements) * g_bindlessHandleStride;
+            bindlessHandleBufferStride_ += GetAlignedSize<GLsizeiptr>(tableSize, static_cast<GLsizeiptr>(offsetAlignment));
+            numBindlessTexturesPerSet_  += numElements;
+
+            outBindings.resize(outBindings.size() + numElements);
+        }
+        else
+        {
+            /* Distribute array elements onto consecutive binding slots */
+            for_range(i, numElements)
+            {
+                outBindings.push_back(binding);
+                outBindings.back().slot.index += i;
+                outBindings.back().arraySize   = 0;
+            }
+        }
+    }
+
+    /* Combine each bindless texture array with the sampler binding at the same slot (if any) */
+    for (GLBindlessTextureRange& range : bindlessTextureRanges_)
+    {
+        std::uint32_t firstDescriptor = 0;
+        for (const BindingDescriptor& binding : pipelineLayout.GetHeapBindings())
+        {
+            const std::uint32_t numElements = std::max(1u, binding.arraySize);
+            if (binding.type == ResourceType::Sampler && binding.slot.index == range.slot)
+            {
+                range.firstSamplerDescriptor    = firstDescriptor;
+                range.numSamplerElements        = numElements;
+                break;
+            }
+            firstDescriptor += numElements;
+        }
+    }
+}
+
+void GLResourceHeap::CreateBindlessHandleBuffer(std::uint32_t numSegmentSets)
+{
+    /* Create uniform buffer with zero-initialized handle tables for all descriptor sets */
+    const GLsizeiptr bufferSize = bindlessHandleBufferStride_ * static_cast<GLsizeiptr>(numSegmentSets);
+    const std::vector<char> initialData(static_cast<std::size_t>(bufferSize), 0);
+
+    glGenBuffers(1, &bindlessHandleBuffer_);
+    GLStateManager::Get().BindBuffer(GLBufferTarget::UniformBuffer, bindlessHandleBuffer_);
+    glBufferData(GL_UNIFORM_BUFFER, bufferSize, initialData.data(), GL_DYNAMIC_DRAW);
+
+    bindlessTextureEntries_.resize(static_cast<std::size_t>(numBindlessTexturesPerSet_) * numSegmentSets);
+}
+
+void GLResourceHeap::DeleteBindlessHandleBuffer()
+{
+    /* Release all texture handles and texture views */
+    for (GLBindlessTextureEntry& entry : bindlessTextureEntries_)
+        ReleaseBindlessTexture(entry);
+
+    if (bindlessHandleBuffer_ != 0)
+    {
+        glDeleteBuffers(1, &bindlessHandleBuffer_);
+        GLStateManager::Get().NotifyBufferRelease(bindlessHandleBuffer_, GLBufferTarget::UniformBuffer);
+        bindlessHandleBuffer_ = 0;
+    }
+}
+
+void GLResourceHeap::BindBindlessTextureTables(GLStateManager& stateMngr, std::uint32_t descriptorSet)
+{
+    for (const GLBindlessTextureRange& range : bindlessTextureRanges_)
+    {
+        const GLintptr      offset  = bindlessHandleBufferStride_ * static_cast<GLintptr>(descriptorSet) + range.bufferOffset;
+        const GLsizeiptr    size    = static_cast<GLsizeiptr>(range.numElements) * g_bindlessHandleStride;
+        stateMngr.BindBuffersRange(GLBufferTarget::UniformBuffer, range.slot, 1, &bindlessHandleBuffer_, &offset, &size);
+    }
+}
+
+const GLResourceHeap::GLBindlessTextureRange* GLResourceHeap::FindBindlessTextureRange(std::uint32_t descriptor) const
+{
+    for (const GLBindlessTextureRange& range : bindlessTextureRanges_)
+    {
+        if (descriptor >= range.firstDescriptor && descriptor < range.firstDescriptor + range.numElements)
+            return &range;
+    }
+    return nullptr;
+}
+
+// Returns the GL texture the bindless handle of the specified entry refers to.
+static GLuint GetBindlessTextureID(GLuint texID, GLuint texViewID)
+{
+    return (texViewID != 0 ? texViewID : texID);
+}
+
+void GLResourceHeap::WriteBindlessTexture(
+    const ResourceViewDescriptor&   desc,
+    const GLBindlessTextureRange&   range,
+    std::uint32_t                   descriptorSet,
+    std::uint32_t                   element)
+{
+    GLBindlessTextureEntry& entry = bindlessTextureEntries_[descriptorSet * numBindlessTexturesPerSet_ + range.firstEntry + element];
+
+    /* Get texture resource and create texture view if necessary */
+    auto textureGL = LLGL_CAST(GLTexture*, GetAsExpectedTexture(desc.resource, BindFlags::Sampled));
+
+    GLuint texViewID = 0;
+    if (IsTextureViewEnabled(desc.textureView))
+        texViewID = GLTextureViewPool::Get().CreateTextureView(textureGL->GetID(), desc.textureView);
+
+    /* Acquire new handle before the previous one is released, so it remains resident if the texture/sampler pair did not change */
+    std::uint64_t generation = 0;
+    const GLuint64 handle = GLTextureHandlePool::Get().AcquireTextureHandle(GetBindlessTextureID(textureGL->GetID(), texViewID), entry.samplerID, generation);
+    ReleaseBindlessTexture(entry);
+
+    entry.texID         = textureGL->GetID();
+    entry.texViewID     = texViewID;
+    entry.generation    = generation;
+
+    WriteBindlessTextureHandle(range, descriptorSet, element, handle);
+}
+
+void GLResourceHeap::WriteBindlessTextureSampler(const ResourceViewDescriptor& desc, std::uint32_t descriptorSet, std::uint32_t descriptor)
+{
+    auto samplerGL = LLGL_CAST(GLSampler*, GetAsExpectedSampler(desc.resource));
+    const GLuint samplerID = samplerGL->GetID();
+
+    for (const GLBindlessTextureRange& range : bindlessTextureRanges_)
+    {
+        if (descriptor < range.firstSamplerDescriptor || descriptor >= range.firstSamplerDescriptor + range.numSamplerElements)
+            continue;
+
+        /* A single sampler applies to all texture elements, otherwise array elements are combined pairwise */
+        const std::uint32_t samplerElement  = descriptor - range.firstSamplerDescriptor;
+        const std::uint32_t firstElement    = (range.numSamplerElements > 1 ? samplerElement : 0);
+        const std::uint32_t lastElement     = (range.numSamplerElements > 1 ? std::min(samplerElement + 1, range.numElements) : range.numElements);
+
+        for (std::uint32_t element = firstElement; element < lastElement; ++element)
+        {
+            GLBindlessTextureEntry& entry = bindlessTextureEntries_[descriptorSet * numBindlessTexturesPerSet_ + range.firstEntry + element];
+            if (entry.samplerID == samplerID)
+                continue;
+
+            /* Replace handle of texture/sampler pair if a texture has already been written */
+            const GLuint texID = GetBindlessTextureID(entry.texID, entry.texViewID);
+            if (texID != 0)
+            {
+                std::uint64_t generation = 0;
+                const GLuint64 handle = GLTextureHandlePool::Get().AcquireTextureHandle(texID, samplerID, generation);
+                GLTextureHandlePool::Get().ReleaseTextureHandle(texID, entry.samplerID, entry.generation);
+                WriteBindlessTextureHandle(range, descriptorSet, element, handle);
+                entry.generation = generation;
+            }
+            entry.samplerID = samplerID;
+        }
+    }
+}
+
+void GLResourceHeap::WriteBindlessTextureHandle(const GLBindlessTextureRange& range, std::uint32_t descriptorSet, std::uint32_t element, GLuint64 handle)
+{
+    const GLintptr offset = bindlessHandleBufferStride_ * static_cast<GLintptr>(descriptorSet) + range.bufferOffset + static_cast<GLintptr>(element) * g_bindlessHandleStride;
+    GLStateManager::Get().BindBuffer(GLBufferTarget::CopyWriteBuffer, bindlessHandleBuffer_);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, sizeof(handle), &handle);
+}
+
+void GLResourceHeap::ReleaseBindlessTexture(GLBindlessTextureEntry& entry)
+{
+    const GLuint texID = GetBindlessTextureID(entry.texID, entry.texViewID);
+    if (texID != 0)
+        GLTextureHandlePool::Get().ReleaseTextureHandle(texID, entry.samplerID, entry.generation);
+    FreeTextureView(entry.texViewID);
+    entry.texID         = 0;
+    entry.generation    = 0;
+}
+
 void GLResourceHeap::WriteBindingMappings(const GLResourceBinding* first, SegmentationSizeType count)
 {
     for_range(i, count)
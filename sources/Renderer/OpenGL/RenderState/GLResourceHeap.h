@@ -25,12 +25,17 @@ namespace LLGL
 
 enum GLResourceType : std::uint32_t;
 class GLStateManager;
+class GLPipelineLayout;
 class BindingDescriptorIterator;
 struct ResourceHeapDescriptor;
+struct BindingDescriptor;
 
 /*
 This class emulates the behavior of a descriptor set like in Vulkan,
 by binding all shader resources within one bind call in the command buffer.
+For bindless heaps (see PipelineLayoutDescriptor::bindlessHeap), each array element occupies its own binding slot,
+except for sampled textures with GL_ARB_bindless_texture: their resident texture handles are stored in a uniform buffer
+that is bound to the slot of the heap binding, i.e. each descriptor set binds one buffer range per texture array.
 */
 class GLResourceHeap final : public ResourceHeap
 {
@@ -84,6 +89,27 @@ class GLResourceHeap final : public ResourceHeap
             std::size_t index;  // Index to the input bindings list
         };
 
+        // Array of sampled textures in a bindless heap whose handles are stored in the handle buffer.
+        struct GLBindlessTextureRange
+        {
+            std::uint32_t   firstDescriptor;        // First descriptor (per set) of the texture array.
+            std::uint32_t   numElements;            // Number of array elements.
+            std::uint32_t   firstEntry;             // First entry (per set) in 'bindlessTextureEntries_'.
+            GLuint          slot;                   // Uniform buffer binding slot of the handle table.
+            GLintptr        bufferOffset;           // Byte offset of the handle table within a descriptor set.
+            std::uint32_t   firstSamplerDescriptor; // First descriptor (per set) of the sampler binding at the same slot, or ~0u.
+            std::uint32_t   numSamplerElements;     // Number of array elements of the sampler binding.
+        };
+
+        // Bindless texture descriptor; the handle of the texture/sampler pair is resident while it is referenced here.
+        struct GLBindlessTextureEntry
+        {
+            GLuint          texID       = 0;
+            GLuint          texViewID   = 0;
+            GLuint          samplerID   = 0;
+            std::uint64_t   generation  = 0; // Generation of the entry in GLTextureHandlePool.
+        };
+
     private:
 
         void AllocTextureView(GLuint& texViewID, GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc);
@@ -124,6 +150,17 @@ class GLResourceHeap final : public ResourceHeap
             std::size_t                 payload2Stride
         );
 
+        void BuildBindlessHeapBindings(const GLPipelineLayout& pipelineLayout, std::vector<BindingDescriptor>& outBindings);
+        void CreateBindlessHandleBuffer(std::uint32_t numSegmentSets);
+        void DeleteBindlessHandleBuffer();
+        void BindBindlessTextureTables(GLStateManager& stateMngr, std::uint32_t descriptorSet);
+
+        const GLBindlessTextureRange* FindBindlessTextureRange(std::uint32_t descriptor) const;
+        void WriteBindlessTexture(const ResourceViewDescriptor& desc, const GLBindlessTextureRange& range, std::uint32_t descriptorSet, std::uint32_t element);
+        void WriteBindlessTextureSampler(const ResourceViewDescriptor& desc, std::uint32_t descriptorSet, std::uint32_t descriptor);
+        void WriteBindlessTextureHandle(const GLBindlessTextureRange& range, std::uint32_t descriptorSet, std::uint32_t element, GLuint64 handle);
+        void ReleaseBindlessTexture(GLBindlessTextureEntry& entry);
+
         void WriteBindingMappings(const GLResourceBinding* first, SegmentationSizeType count);
         void CopyBindingMapping(const GLResourceBinding& dst, const GLResourceBinding& src);
 
@@ -157,6 +194,12 @@ class GLResourceHeap final : public ResourceHeap
         SegmentedBuffer                     heap_;                  // Buffer with resource binding information and stride (in bytes) per descriptor set
         GLbitfield                          barriers_       = 0;    // Bitmask for glMemoryBarrier
 
+        std::vector<GLBindlessTextureRange> bindlessTextureRanges_;
+        std::vector<GLBindlessTextureEntry> bindlessTextureEntries_;        // Bindless texture entries of all descriptor sets.
+        std::uint32_t                       numBindlessTexturesPerSet_  = 0;
+        GLuint                              bindlessHandleBuffer_       = 0;    // Uniform buffer with the texture handle tables of all descriptor sets.
+        GLsizeiptr                          bindlessHandleBufferStride_ = 0;    // Size (in bytes) of the handle tables per descriptor set.
+
 };
 
 
@@ -18,6 +18,7 @@ namespace LLGL
 
 class GLPipelineLayout;
 class GLPipelineState;
+class GLRenderPass;
 
 /* ----- Enumerations ----- */
 
@@ -147,13 +148,15 @@ struct GLScissor
 
 struct GLRenderState
 {
-    GLenum                  drawMode            = GL_TRIANGLES;
-    GLenum                  primitiveMode       = GL_TRIANGLES;
-    GLenum                  indexBufferDataType = GL_UNSIGNED_INT;
-    GLsizeiptr              indexBufferStride   = 4;
-    GLsizeiptr              indexBufferOffset   = 0;
-    const GLPipelineLayout* boundPipelineLayout = nullptr;
-    const GLPipelineState*  boundPipelineState  = nullptr;
+    GLenum                  drawMode                = GL_TRIANGLES;
+    GLenum                  primitiveMode           = GL_TRIANGLES;
+    GLenum                  indexBufferDataType     = GL_UNSIGNED_INT;
+    GLsizeiptr              indexBufferStride       = 4;
+    GLsizeiptr              indexBufferOffset       = 0;
+    GLuint                  vertexTransformFeedback = 0;        // Transform feedback object of the vertex buffer in slot 0 (see DrawStreamOutput)
+    const GLPipelineLayout* boundPipelineLayout     = nullptr;
+    const GLPipelineState*  boundPipelineState      = nullptr;
+    const GLRenderPass*     boundRenderPass         = nullptr;
 };
 
 struct GLPixelStore
@@ -150,8 +150,8 @@ static void InvalidateBoundGLObject(GLuint& boundId, const GLuint releasedObject
  * GLStateManager static members
  */
 
-GLStateManager*             GLStateManager::current_;
-GLStateManager::GLLimits    GLStateManager::commonLimits_;
+thread_local GLStateManager*    GLStateManager::current_;
+GLStateManager::GLLimits        GLStateManager::commonLimits_;
 
 struct GLStateManager::GLIntermediateBufferWriteMasks
 {
@@ -168,6 +168,8 @@ struct GLStateManager::GLIntermediateBufferWriteMasks
 
 GLStateManager::GLStateManager()
 {
+    dirtyBits_.bits = 0;
+
     /* Make this the active state manager if there is no previous one */
     if (GLStateManager::current_ == nullptr)
         GLStateManager::current_ = this;
@@ -641,14 +643,20 @@ void GLStateManager::NotifyDepthStencilStateRelease(GLDepthStencilState* depthSt
 {
     if (boundDepthStencilState_ == depthStencilState)
         boundDepthStencilState_ = nullptr;
+    if (pendingDepthStencilState_ == depthStencilState)
+    {
+        pendingDepthStencilState_ = nullptr;
+        dirtyBits_.depthStencilState = 0;
+    }
 }
 
 void GLStateManager::BindDepthStencilState(GLDepthStencilState* depthStencilState)
 {
-    if (depthStencilState != nullptr && depthStencilState != boundDepthStencilState_)
+    /* Only record depth-stencil state here; it is bound with the next draw or clear command */
+    if (depthStencilState != nullptr)
     {
-        depthStencilState->Bind(*this);
-        boundDepthStencilState_ = depthStencilState;
+        pendingDepthStencilState_ = depthStencilState;
+        dirtyBits_.depthStencilState = (depthStencilState != boundDepthStencilState_ ? 1 : 0);
     }
 }
 
@@ -672,6 +680,9 @@ void GLStateManager::SetDepthMask(GLboolean flag)
 
 void GLStateManager::SetStencilRef(GLint ref, GLenum face)
 {
+    /* Stencil reference is applied on top of the stencil functions of the depth-stencil state, so flush that state first */
+    if (dirtyBits_.depthStencilState != 0)
+        FlushDepthStencilState();
     if (boundDepthStencilState_ != nullptr)
         boundDepthStencilState_->BindStencilRefOnly(ref, face);
 }
@@ -683,25 +694,22 @@ void GLStateManager::NotifyRasterizerStateRelease(GLRasterizerState* rasterizerS
     if (boundRasterizerState_ == rasterizerState)
     {
         boundRasterizerState_ = nullptr;
-        frontFacingDirtyBit_ = false;
+        dirtyBits_.frontFacing = 0;
+    }
+    if (pendingRasterizerState_ == rasterizerState)
+    {
+        pendingRasterizerState_ = nullptr;
+        dirtyBits_.rasterizerState = 0;
     }
 }
 
 void GLStateManager::BindRasterizerState(GLRasterizerState* rasterizerState)
 {
+    /* Only record rasterizer state here; it is bound with the next draw or clear command */
     if (rasterizerState != nullptr)
     {
-        if (rasterizerState != boundRasterizerState_)
-        {
-            rasterizerState->Bind(*this);
-            boundRasterizerState_ = rasterizerState;
-            frontFacingDirtyBit_ = false;
-        }
-        else if (frontFacingDirtyBit_)
-        {
-            rasterizerState->BindFrontFaceOnly(*this);
-            frontFacingDirtyBit_ = false;
-        }
+        pendingRasterizerState_ = rasterizerState;
+        dirtyBits_.rasterizerState = (rasterizerState != boundRasterizerState_ ? 1 : 0);
     }
 }
 
@@ -711,19 +719,29 @@ void GLStateManager::NotifyBlendStateRelease(GLBlendState* blendState)
 {
     if (boundBlendState_ == blendState)
         boundBlendState_ = nullptr;
+    if (pendingBlendState_ == blendState)
+    {
+        pendingBlendState_ = nullptr;
+        dirtyBits_.blendState = 0;
+    }
 }
 
 void GLStateManager::BindBlendState(GLBlendState* blendState)
 {
-    if (blendState != nullptr && blendState != boundBlendState_)
+    /* Only record blend state here; it is bound with the next draw or clear command */
+    if (blendState != nullptr)
     {
-        blendState->Bind(*this);
-        boundBlendState_ = blendState;
+        pendingBlendState_ = blendState;
+        dirtyBits_.blendState = (blendState != boundBlendState_ ? 1 : 0);
     }
 }
 
 void GLStateManager::SetBlendColor(const GLfloat color[4])
 {
+    /* Dynamic blend color overrides the static one of the blend state, so flush that state first */
+    if (dirtyBits_.blendState != 0)
+        FlushBlendState();
+
     if ( color[0] != contextState_.blendColor[0] ||
          color[1] != contextState_.blendColor[1] ||
          color[2] != contextState_.blendColor[2] ||
@@ -758,6 +776,17 @@ GLenum GLStateManager::ToGLBufferTarget(GLBufferTarget target)
 
 void GLStateManager::BindBuffer(GLBufferTarget target, GLuint buffer)
 {
+    #ifdef GL_ARB_shader_image_load_store
+
+    /* Make shader writes of previous dispatch commands visible to the indirect command that reads its arguments from this buffer */
+    if (commandBarrierPending_ && (target == GLBufferTarget::DrawIndirectBuffer || target == GLBufferTarget::DispatchIndirectBuffer))
+    {
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+        commandBarrierPending_ = false;
+    }
+
+    #endif // /GL_ARB_shader_image_load_store
+
     /* Only bind buffer if the buffer has changed */
     auto targetIdx = static_cast<std::size_t>(target);
     if (contextState_.boundBuffers[targetIdx] != buffer)
@@ -773,6 +802,9 @@ void GLStateManager::BindBufferBase(GLBufferTarget target, GLuint index, GLuint
     auto targetIdx = static_cast<std::size_t>(target);
     glBindBufferBase(g_bufferTargetsEnum[targetIdx], index, buffer);
     contextState_.boundBuffers[targetIdx] = buffer;
+    #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+    StoreUniformBufferRanges(target, index, 1, &buffer);
+    #endif
 }
 
 void GLStateManager::BindBuffersBase(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers)
@@ -781,6 +813,10 @@ void GLStateManager::BindBuffersBase(GLBufferTarget target, GLuint first, GLsize
     auto targetIdx = static_cast<std::size_t>(target);
     auto targetGL = g_bufferTargetsEnum[targetIdx];
 
+    #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+    StoreUniformBufferRanges(target, first, count, buffers);
+    #endif
+
     #ifdef GL_ARB_multi_bind
     if (HasExtension(GLExt::ARB_multi_bind))
     {
@@ -808,6 +844,9 @@ void GLStateManager::BindBufferRange(GLBufferTarget target, GLuint index, GLuint
     auto targetIdx = static_cast<std::size_t>(target);
     glBindBufferRange(g_bufferTargetsEnum[targetIdx], index, buffer, offset, size);
     contextState_.boundBuffers[targetIdx] = buffer;
+    #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+    StoreUniformBufferRanges(target, index, 1, &buffer, &offset, &size);
+    #endif
 }
 
 void GLStateManager::BindBuffersRange(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizeiptr* sizes)
@@ -816,6 +855,10 @@ void GLStateManager::BindBuffersRange(GLBufferTarget target, GLuint first, GLsiz
     auto targetIdx = static_cast<std::size_t>(target);
     auto targetGL = g_bufferTargetsEnum[targetIdx];
 
+    #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+    StoreUniformBufferRanges(target, first, count, buffers, offsets, sizes);
+    #endif
+
     #ifdef GL_ARB_multi_bind
     if (HasExtension(GLExt::ARB_multi_bind))
     {
@@ -909,6 +952,25 @@ void GLStateManager::BindVertexArray(GLuint vertexArray)
     }
 }
 
+void GLStateManager::BindVertexBuffers(GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizei* strides)
+{
+    #ifdef GL_ARB_multi_bind
+    if (HasExtension(GLExt::ARB_multi_bind))
+    {
+        /* Bind all vertex buffers with a single GL call */
+        glBindVertexBuffers(first, count, buffers, offsets, strides);
+    }
+    else
+    #endif // /GL_ARB_multi_bind
+    {
+        #ifdef GL_ARB_vertex_attrib_binding
+        /* Bind each individual vertex buffer */
+        for_range(i, count)
+            glBindVertexBuffer(first + i, buffers[i], offsets[i], strides[i]);
+        #endif // /GL_ARB_vertex_attrib_binding
+    }
+}
+
 void GLStateManager::BindGLBuffer(const GLBuffer& buffer)
 {
     BindBuffer(buffer.GetTarget(), buffer.GetID());
@@ -985,6 +1047,14 @@ void GLStateManager::NotifyBufferRelease(GLuint buffer, GLBufferTarget target)
 {
     auto targetIdx = static_cast<std::size_t>(target);
     InvalidateBoundGLObject(contextState_.boundBuffers[targetIdx], buffer);
+
+    #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+    if (target == GLBufferTarget::UniformBuffer)
+    {
+        for (GLUniformBufferRange& range : uniformBufferRanges_)
+            InvalidateBoundGLObject(range.buffer, buffer);
+    }
+    #endif
 }
 
 void GLStateManager::NotifyBufferRelease(const GLBuffer& buffer)
@@ -1023,11 +1093,19 @@ void GLStateManager::DisableVertexAttribArrays(GLuint firstIndex)
     lastVertexAttribArray_ = firstIndex;
 }
 
+/* ----- Compute ----- */
+
+void GLStateManager::NotifyComputeDispatch()
+{
+    commandBarrierPending_ = true;
+}
+
 /* ----- Framebuffer ----- */
 
 void GLStateManager::BindGLRenderTarget(GLRenderTarget* renderTarget)
 {
-    boundRenderTarget_ = renderTarget;
+    boundRenderTarget_          = renderTarget;
+    boundRenderTargetResolved_  = false;
     if (renderTarget)
     {
         BindFramebuffer(GLFramebufferTarget::DrawFramebuffer, renderTarget->GetFramebuffer().GetID());
@@ -1517,6 +1595,9 @@ void GLStateManager::BindRenderTarget(RenderTarget& renderTarget, GLStateManager
 
 void GLStateManager::Clear(long flags)
 {
+    /* Write masks and scissor test of the pending state objects apply to clear commands */
+    FlushPendingStates();
+
     /* Setup GL clear mask and clear respective buffer */
     GLbitfield mask = 0;
     GLIntermediateBufferWriteMasks intermediateMasks;
@@ -1548,6 +1629,8 @@ void GLStateManager::Clear(long flags)
 
 void GLStateManager::ClearBuffers(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    FlushPendingStates();
+
     GLIntermediateBufferWriteMasks intermediateMasks;
 
     for (; numAttachments-- > 0; ++attachments)
@@ -1638,10 +1721,51 @@ void GLStateManager::SetFrontFaceInternal(GLenum mode)
 
 void GLStateManager::FlipFrontFacing(bool isFlipped)
 {
-    /* Update front face and mark it as outdated for next rastierizer state binding */
+    /* Update front face and mark it as outdated for next flush of the rasterizer state */
     flipFrontFacing_ = isFlipped;
     SetFrontFace(frontFaceInternal_);
-    frontFacingDirtyBit_ = true;
+    dirtyBits_.frontFacing = 1;
+}
+
+void GLStateManager::FlushDirtyStates()
+{
+    /* Flush state groups in fixed order */
+    if (dirtyBits_.depthStencilState != 0)
+        FlushDepthStencilState();
+    if (dirtyBits_.rasterizerState != 0)
+        FlushRasterizerState();
+    if (dirtyBits_.frontFacing != 0)
+    {
+        if (boundRasterizerState_ != nullptr)
+            boundRasterizerState_->BindFrontFaceOnly(*this);
+        dirtyBits_.frontFacing = 0;
+    }
+    if (dirtyBits_.blendState != 0)
+        FlushBlendState();
+}
+
+void GLStateManager::FlushDepthStencilState()
+{
+    dirtyBits_.depthStencilState = 0;
+    boundDepthStencilState_ = pendingDepthStencilState_;
+    boundDepthStencilState_->Bind(*this);
+}
+
+void GLStateManager::FlushRasterizerState()
+{
+    /* Binding the entire rasterizer state also updates the front face */
+    dirtyBits_.rasterizerState  = 0;
+    dirtyBits_.frontFacing      = 0;
+    boundRasterizerState_ = pendingRasterizerState_;
+    boundRasterizerState_->Bind(*this);
+}
+
+void GLStateManager::FlushBlendState()
+{
+    /* Reset dirty bit first, since GLBlendState::Bind() calls SetBlendColor() */
+    dirtyBits_.blendState = 0;
+    boundBlendState_ = pendingBlendState_;
+    boundBlendState_->Bind(*this);
 }
 
 static void AccumCommonGLLimits(GLStateManager::GLLimits& dst, const GLStateManager::GLLimits& src)
@@ -1744,6 +1868,28 @@ void GLStateManager::DetermineVendorSpecificExtensions()
 
 #endif
 
+#ifdef LLGL_GLEXT_COMMAND_LIST_NV
+
+void GLStateManager::StoreUniformBufferRanges(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizeiptr* sizes)
+{
+    if (target != GLBufferTarget::UniformBuffer || count <= 0)
+        return;
+
+    const std::size_t end = static_cast<std::size_t>(first) + static_cast<std::size_t>(count);
+    if (uniformBufferRanges_.size() < end)
+        uniformBufferRanges_.resize(end, GLUniformBufferRange{ 0, 0, 0 });
+
+    for_range(i, count)
+    {
+        GLUniformBufferRange& range = uniformBufferRanges_[first + i];
+        range.buffer    = buffers[i];
+        range.offset    = (offsets != nullptr ? offsets[i] : 0);
+        range.size      = (sizes   != nullptr ? sizes[i]   : 0);
+    }
+}
+
+#endif // /LLGL_GLEXT_COMMAND_LIST_NV
+
 /* ----- Stacks ----- */
 
 void GLStateManager::PrepareColorMaskForClear(GLIntermediateBufferWriteMasks& intermediateMasks)
@@ -1793,8 +1939,12 @@ void GLStateManager::RestoreWriteMasks(GLIntermediateBufferWriteMasks& intermedi
 
 void GLStateManager::ResolveMultisampledRenderTarget()
 {
-    if (auto* renderTarget = GetBoundRenderTarget())
-        renderTarget->ResolveMultisampled(*this);
+    if (!boundRenderTargetResolved_)
+    {
+        if (auto* renderTarget = GetBoundRenderTarget())
+            renderTarget->ResolveMultisampled(*this);
+        boundRenderTargetResolved_ = true;
+    }
 }
 
 void GLStateManager::ClearAttachmentsWithRenderPass(
@@ -1802,6 +1952,11 @@ void GLStateManager::ClearAttachmentsWithRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    FlushPendingStates();
+
+    /* Invalidate attachments whose previous content is undefined, so tile-based GPUs don't have to load them */
+    InvalidateAttachments(renderPassGL.GetInvalidateOnBeginMask());
+
     const ClearValue defaultClearValue;
     auto mask = renderPassGL.GetClearMask();
 
@@ -1866,6 +2021,63 @@ void GLStateManager::ClearAttachmentsWithRenderPass(
     RestoreWriteMasks(intermediateMasks);
 }
 
+void GLStateManager::EndRenderPass(const GLRenderPass* renderPassGL)
+{
+    /* Multi-sampled attachments must be resolved before their content can be invalidated */
+    ResolveMultisampledRenderTarget();
+
+    if (renderPassGL != nullptr)
+    {
+        std::uint32_t invalidateMask = renderPassGL->GetInvalidateOnEndMask();
+
+        /* Don't invalidate resolve textures that are attached directly with GL_EXT_multisampled_render_to_texture */
+        if (auto* renderTarget = GetBoundRenderTarget())
+            invalidateMask &= ~(renderTarget->GetImplicitResolveMask());
+
+        InvalidateAttachments(invalidateMask);
+    }
+}
+
+void GLStateManager::InvalidateAttachments(std::uint32_t invalidateMask)
+{
+    if (invalidateMask == 0)
+        return;
+
+    GLenum attachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS + 2];
+    GLsizei numAttachments = 0;
+
+    if (auto* renderTarget = GetBoundRenderTarget())
+    {
+        /* Invalidate attachments of primary FBO; this might have been unbound by resolving the multi-sampled attachments */
+        BindFramebuffer(GLFramebufferTarget::DrawFramebuffer, renderTarget->GetFramebuffer().GetID());
+
+        for_range(i, LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+        {
+            if ((invalidateMask & (1u << i)) != 0)
+                attachments[numAttachments++] = GLTypes::ToColorAttachment(i);
+        }
+        if ((invalidateMask & GLRenderPass::invalidateDepthBit) != 0)
+            attachments[numAttachments++] = GL_DEPTH_ATTACHMENT;
+        if ((invalidateMask & GLRenderPass::invalidateStencilBit) != 0)
+            attachments[numAttachments++] = GL_STENCIL_ATTACHMENT;
+    }
+    else
+    {
+        /* Invalidate buffers of default framebuffer, which only has a single color buffer */
+        BindFramebuffer(GLFramebufferTarget::DrawFramebuffer, 0);
+
+        if ((invalidateMask & 0x1u) != 0)
+            attachments[numAttachments++] = GL_COLOR;
+        if ((invalidateMask & GLRenderPass::invalidateDepthBit) != 0)
+            attachments[numAttachments++] = GL_DEPTH;
+        if ((invalidateMask & GLRenderPass::invalidateStencilBit) != 0)
+            attachments[numAttachments++] = GL_STENCIL;
+    }
+
+    if (numAttachments > 0)
+        GLProfile::InvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, numAttachments, attachments);
+}
+
 std::uint32_t GLStateManager::ClearColorBuffers(
     const std::uint8_t*             colorBuffers,
     std::uint32_t                   numClearValues,
@@ -16,6 +16,7 @@
 #include "../OpenGL.h"
 #include <array>
 #include <stack>
+#include <vector>
 #include <cstdint>
 
 
@@ -69,7 +70,7 @@ class GLStateManager
 
         GLStateManager();
 
-        // Returns the active GL state manager.
+        // Returns the active GL state manager of the calling thread.
         static inline GLStateManager& Get()
         {
             return *current_;
@@ -161,6 +162,15 @@ class GLStateManager
         void SetBlendColor(const GLfloat color[4]);
         void SetLogicOp(GLenum opcode);
 
+        /* ----- Deferred states ----- */
+
+        // Binds all state objects that have changed since the last flush. Must be called right before draw and clear commands.
+        inline void FlushPendingStates()
+        {
+            if (dirtyBits_.bits != 0)
+                FlushDirtyStates();
+        }
+
         /* ----- Buffer ----- */
 
         static GLenum ToGLBufferTarget(GLBufferTarget target);
@@ -172,8 +182,33 @@ class GLStateManager
         void BindBuffersRange(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizeiptr* sizes);
         void UnbindBuffersBase(GLBufferTarget target, GLuint first, GLsizei count);
 
+        #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+
+        // Buffer range that is bound to an indexed uniform buffer binding point. A size of zero denotes the entire buffer.
+        struct GLUniformBufferRange
+        {
+            GLuint      buffer;
+            GLintptr    offset;
+            GLsizeiptr  size;
+        };
+
+        // Returns the buffer ranges of the indexed uniform buffer binding points. Unused binding points have a buffer ID of zero.
+        inline const std::vector<GLUniformBufferRange>& GetUniformBufferRanges() const
+        {
+            return uniformBufferRanges_;
+        }
+
+        #endif // /LLGL_GLEXT_COMMAND_LIST_NV
+
         void BindVertexArray(GLuint vertexArray);
 
+        /**
+        \brief Binds the specified vertex buffers to the vertex buffer binding points of the currently bound VAO (requires GL_ARB_vertex_attrib_binding).
+        \remarks These bindings are part of the VAO state and must be specified again after a VAO has been bound that is shared with other vertex buffers.
+        \see BindVertexArray
+        */
+        void BindVertexBuffers(GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizei* strides);
+
         void BindGLBuffer(const GLBuffer& buffer);
 
         void NotifyVertexArrayRelease(GLuint vertexArray);
@@ -193,6 +228,14 @@ class GLStateManager
         // Disables all previous enabled vertex attrib arrays, and sets the specified index as the new highest enabled index.
         void DisableVertexAttribArrays(GLuint firstIndex);
 
+        /* ----- Compute ----- */
+
+        /*
+        Notifies the state manager that a compute shader has been dispatched, which may have written indirect arguments.
+        The next binding of an indirect buffer is then preceded by glMemoryBarrier(GL_COMMAND_BARRIER_BIT).
+        */
+        void NotifyComputeDispatch();
+
         /* ----- Framebuffer ----- */
 
         void BindGLRenderTarget(GLRenderTarget* renderTarget);
@@ -279,6 +322,12 @@ class GLStateManager
             const ClearValue*   clearValues
         );
 
+        // Resolves the bound render target and invalidates all attachments whose content is not stored by the specified render pass (if non-null).
+        void EndRenderPass(const GLRenderPass* renderPassGL);
+
+        // Invalidates the attachments of the bound render target or default framebuffer. See GLRenderPass::GetInvalidateOnBeginMask.
+        void InvalidateAttachments(std::uint32_t invalidateMask);
+
         void Clear(long flags);
         void ClearBuffers(std::uint32_t numAttachments, const AttachmentClear* attachments);
 
@@ -323,12 +372,22 @@ class GLStateManager
         void SetFrontFaceInternal(GLenum mode);
         void FlipFrontFacing(bool isFlipped);
 
+        void FlushDirtyStates();
+        void FlushDepthStencilState();
+        void FlushRasterizerState();
+        void FlushBlendState();
+
         void DetermineLimits();
 
         #ifdef LLGL_GL_ENABLE_VENDOR_EXT
         void DetermineVendorSpecificExtensions();
         #endif
 
+        #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+        // Stores the buffer ranges of indexed uniform buffer bindings, since NV command lists replace them with unified memory addresses.
+        void StoreUniformBufferRanges(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets = nullptr, const GLsizeiptr* sizes = nullptr);
+        #endif
+
         /* ----- Stacks ----- */
 
         void PrepareColorMaskForClear(GLIntermediateBufferWriteMasks& intermediateMasks);
@@ -388,8 +447,8 @@ class GLStateManager
 
     private:
 
-        static GLStateManager*  current_;
-        static GLLimits         commonLimits_;          // Common denominator of limitations for all GL contexts
+        static thread_local GLStateManager* current_;
+        static GLLimits                     commonLimits_;  // Common denominator of limitations for all GL contexts
 
     private:
 
@@ -403,6 +462,7 @@ class GLStateManager
         #endif
 
         GLRenderTarget*                     boundRenderTarget_          = nullptr;
+        bool                                boundRenderTargetResolved_  = false;
 
         bool                                indexType16Bits_            = false;
         GLuint                              lastVertexAttribArray_      = 0;
@@ -415,11 +475,32 @@ class GLStateManager
         bool                                emulateDepthModeZeroToOne_  = false;
         GLint                               framebufferHeight_          = 0;
 
+        bool                                commandBarrierPending_      = false; // Compute shaders may have written indirect arguments since the last command barrier
+
+        #ifdef LLGL_GLEXT_COMMAND_LIST_NV
+        std::vector<GLUniformBufferRange>   uniformBufferRanges_;
+        #endif
+
         GLDepthStencilState*                boundDepthStencilState_     = nullptr;
         GLRasterizerState*                  boundRasterizerState_       = nullptr;
         GLBlendState*                       boundBlendState_            = nullptr;
 
-        bool                                frontFacingDirtyBit_        = false;
+        GLDepthStencilState*                pendingDepthStencilState_   = nullptr;
+        GLRasterizerState*                  pendingRasterizerState_     = nullptr;
+        GLBlendState*                       pendingBlendState_          = nullptr;
+
+        union
+        {
+            std::uint8_t bits;
+            struct
+            {
+                std::uint8_t depthStencilState  : 1;
+                std::uint8_t rasterizerState    : 1;
+                std::uint8_t blendState         : 1;
+                std::uint8_t frontFacing        : 1;
+            };
+        }
+        dirtyBits_;
 
         std::stack<CapabilityStackEntry>    capabilitiesStack_;
         std::stack<BufferStackEntry>        bufferStack_;
@@ -7,7 +7,10 @@
 
 #include "GLStatePool.h"
 #include "GLStateManager.h"
+#include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
+#include "../Texture/GLSampler.h"
+#include "../Texture/GLTextureHandlePool.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/CoreUtils.h"
 #include <functional>
@@ -82,6 +85,21 @@ std::shared_ptr<T> CreateRenderStateObject(std::vector<std::shared_ptr<T>>& cont
     return newState;
 }
 
+// Searches a shader pipeline with the specified signature with average complexity O(1)
+static GLShaderPipelineSPtr FindShaderPipeline(
+    const std::unordered_multimap<std::size_t, GLShaderPipelineSPtr>&   container,
+    const GLPipelineSignature&                                          signature,
+    std::size_t                                                         signatureHash)
+{
+    const auto range = container.equal_range(signatureHash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (GLShaderPipeline::CompareSWO(*(it->second), signature) == 0)
+            return it->second;
+    }
+    return nullptr;
+}
+
 template <typename T>
 void ReleaseRenderStateObject(
     std::vector<std::shared_ptr<T>>&    container,
@@ -119,6 +137,7 @@ GLStatePool& GLStatePool::Get()
 
 void GLStatePool::Clear()
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     depthStencilStates_.clear();
     rasterizerStates_.clear();
     blendStates_.clear();
@@ -129,11 +148,13 @@ void GLStatePool::Clear()
 
 GLDepthStencilStateSPtr GLStatePool::CreateDepthStencilState(const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     return CreateRenderStateObject(depthStencilStates_, depthDesc, stencilDesc);
 }
 
 void GLStatePool::ReleaseDepthStencilState(GLDepthStencilStateSPtr&& depthStencilState)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     ReleaseRenderStateObject<GLDepthStencilState>(
         depthStencilStates_,
         std::bind(&GLStateManager::NotifyDepthStencilStateRelease, &(GLStateManager::Get()), std::placeholders::_1),
@@ -145,11 +166,13 @@ void GLStatePool::ReleaseDepthStencilState(GLDepthStencilStateSPtr&& depthStenci
 
 GLRasterizerStateSPtr GLStatePool::CreateRasterizerState(const RasterizerDescriptor& rasterizerDesc)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     return CreateRenderStateObject(rasterizerStates_, rasterizerDesc);
 }
 
 void GLStatePool::ReleaseRasterizerState(GLRasterizerStateSPtr&& rasterizerState)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     ReleaseRenderStateObject<GLRasterizerState>(
         rasterizerStates_,
         std::bind(&GLStateManager::NotifyRasterizerStateRelease, &(GLStateManager::Get()), std::placeholders::_1),
@@ -161,11 +184,13 @@ void GLStatePool::ReleaseRasterizerState(GLRasterizerStateSPtr&& rasterizerState
 
 GLBlendStateSPtr GLStatePool::CreateBlendState(const BlendDescriptor& blendDesc, std::uint32_t numColorAttachments)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     return CreateRenderStateObject(blendStates_, blendDesc, numColorAttachments);
 }
 
 void GLStatePool::ReleaseBlendState(GLBlendStateSPtr&& blendState)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     ReleaseRenderStateObject<GLBlendState>(
         blendStates_,
         std::bind(&GLStateManager::NotifyBlendStateRelease, &(GLStateManager::Get()), std::placeholders::_1),
@@ -177,11 +202,13 @@ void GLStatePool::ReleaseBlendState(GLBlendStateSPtr&& blendState)
 
 GLShaderBindingLayoutSPtr GLStatePool::CreateShaderBindingLayout(const GLPipelineLayout& pipelineLayout)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     return CreateRenderStateObject(shaderBindingLayouts_, pipelineLayout);
 }
 
 void GLStatePool::ReleaseShaderBindingLayout(GLShaderBindingLayoutSPtr&& shaderBindingLayout)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     ReleaseRenderStateObject<GLShaderBindingLayout>(
         shaderBindingLayouts_,
         nullptr,
@@ -208,30 +235,86 @@ static bool HasGLSeparableShaders(std::size_t numShaders, Shader* const* shaders
     return (numShaders > 0 && IsGLSeparableShader(shaders[0]));
 }
 
-GLShaderPipelineSPtr GLStatePool::CreateShaderPipeline(std::size_t numShaders, Shader* const* shaders, GLShader::Permutation permutation)
+GLShaderPipelineSPtr GLStatePool::CreateShaderPipeline(
+    std::size_t             numShaders,
+    Shader* const*          shaders,
+    GLShader::Permutation   permutation,
+    const GLProgramBinary*  cachedBinary,
+    bool                    deferLinking)
 {
-    #ifdef LLGL_OPENGL
-    if (HasExtension(GLExt::ARB_separate_shader_objects) && HasGLSeparableShaders(numShaders, shaders))
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Try to find shader pipeline with same signature; the cached binary is only used to create a new program */
+    const GLPipelineSignature   signature{ numShaders, shaders, permutation };
+    const std::size_t           signatureHash = signature.GetHash();
+
+    if (GLShaderPipelineSPtr sharedPipeline = FindShaderPipeline(shaderPipelines_, signature, signatureHash))
     {
-        return std::static_pointer_cast<GLShaderPipeline>(
-            CreateRenderStateObjectExt<GLProgramPipeline, GLPipelineSignature>(shaderPipelines_, numShaders, shaders, permutation)
-        );
+        if (!deferLinking)
+            sharedPipeline->FlushPendingLink();
+        return sharedPipeline;
     }
+
+    /* Allocate new shader pipeline */
+    GLShaderPipelineSPtr newPipeline;
+
+    #ifdef LLGL_OPENGL
+    if (HasExtension(GLExt::ARB_separate_shader_objects) && HasGLSeparableShaders(numShaders, shaders))
+        newPipeline = std::make_shared<GLProgramPipeline>(numShaders, shaders, permutation);
     else
     #endif
+        newPipeline = std::make_shared<GLShaderProgram>(numShaders, shaders, permutation, cachedBinary, deferLinking);
+
+    shaderPipelines_.emplace(signatureHash, newPipeline);
+
+    return newPipeline;
+}
+
+void GLStatePool::ReleaseShaderPipeline(GLShaderPipelineSPtr&& shaderPipeline)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    if (shaderPipeline && shaderPipeline.use_count() == 2)
     {
-        return std::static_pointer_cast<GLShaderPipeline>(
-            CreateRenderStateObjectExt<GLShaderProgram, GLPipelineSignature>(shaderPipelines_, numShaders, shaders, permutation)
-        );
+        /* Erase entry from hash map if this was the last reference outside of this pool */
+        const auto range = shaderPipelines_.equal_range(shaderPipeline->GetSignature().GetHash());
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == shaderPipeline)
+            {
+                shaderPipelines_.erase(it);
+                break;
+            }
+        }
+        shaderPipeline.reset();
     }
 }
 
-void GLStatePool::ReleaseShaderPipeline(GLShaderPipelineSPtr&& shaderPipeline)
+/* ----- Samplers ----- */
+
+GLuint GLStatePool::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    ReleaseRenderStateObject<GLShaderPipeline>(
-        shaderPipelines_,
-        nullptr,
-        std::forward<GLShaderPipelineSPtr>(shaderPipeline)
+    return samplers_.Acquire(
+        samplerDesc,
+        [](const SamplerDescriptor& desc) -> GLuint
+        {
+            GLuint id = 0;
+            glGenSamplers(1, &id);
+            GLSampler::SamplerParameters(id, desc);
+            return id;
+        }
+    );
+}
+
+void GLStatePool::ReleaseSampler(const SamplerDescriptor& samplerDesc)
+{
+    samplers_.Release(
+        samplerDesc,
+        [](GLuint id)
+        {
+            GLTextureHandlePool::Get().NotifySamplerRelease(id);
+            glDeleteSamplers(1, &id);
+            GLStateManager::Get().NotifySamplerRelease(id);
+        }
     );
 }
 
@@ -17,7 +17,10 @@
 #include "../Shader/GLShaderBindingLayout.h"
 #include "../Shader/GLShaderPipeline.h"
 #include "../Shader/GLShader.h"
+#include "../../SamplerCache.h"
 #include <vector>
+#include <unordered_map>
+#include <mutex>
 
 
 namespace LLGL
@@ -30,6 +33,7 @@ class GLSeparableShader;
 /*
 Singleton pool for OpenGL depth-stencil-, rasterizer-, and blend states.
 These states are separated from the GLStateManager, because they don't need to exist for every GL context.
+All functions are synchronized, since GL objects can also be created and released on worker contexts.
 */
 class GLStatePool
 {
@@ -67,9 +71,28 @@ class GLStatePool
 
         /* ----- Shader pipelines ----- */
 
-        GLShaderPipelineSPtr CreateShaderPipeline(std::size_t numShaders, Shader* const* shaders, GLShader::Permutation permutation = GLShader::PermutationDefault);
+        /*
+        Returns a shader pipeline with the signature of the specified shaders; lookups are O(1) on average.
+        If 'deferLinking' is true, a new shader program is only linked when it is bound for the first time.
+        Existing pipelines are linked right away if 'deferLinking' is false.
+        */
+        GLShaderPipelineSPtr CreateShaderPipeline(
+            std::size_t             numShaders,
+            Shader* const*          shaders,
+            GLShader::Permutation   permutation     = GLShader::PermutationDefault,
+            const GLProgramBinary*  cachedBinary    = nullptr,
+            bool                    deferLinking    = false
+        );
         void ReleaseShaderPipeline(GLShaderPipelineSPtr&& shaderPipeline);
 
+        /* ----- Samplers ----- */
+
+        // Returns a GL sampler object with the specified parameters and increments its reference count; identical descriptors share one GL sampler.
+        GLuint CreateSampler(const SamplerDescriptor& samplerDesc);
+
+        // Decrements the reference count of the GL sampler for the specified descriptor and deletes it with the last reference.
+        void ReleaseSampler(const SamplerDescriptor& samplerDesc);
+
     private:
 
         GLStatePool() = default;
@@ -80,7 +103,14 @@ class GLStatePool
         std::vector<GLRasterizerStateSPtr>      rasterizerStates_;
         std::vector<GLBlendStateSPtr>           blendStates_;
         std::vector<GLShaderBindingLayoutSPtr>  shaderBindingLayouts_;
-        std::vector<GLShaderPipelineSPtr>       shaderPipelines_;
+
+        // Shader pipelines by hash of their signature; see GLPipelineSignature::GetHash.
+        std::unordered_multimap<std::size_t, GLShaderPipelineSPtr>  shaderPipelines_;
+
+        std::mutex                              mutex_;
+
+        // GL sampler objects by their descriptor; synchronized separately from 'mutex_'.
+        SamplerCache<GLuint>                    samplers_;
 
 };
 
@@ -7,6 +7,7 @@
 
 #include "GLLegacyShader.h"
 #include "GLShaderProgram.h"
+#include "GLProgramBinary.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../GLTypes.h"
@@ -42,6 +43,17 @@ bool GLLegacyShader::Reflect(ShaderReflection& reflection) const
     return true;
 }
 
+const Report* GLLegacyShader::GetReport() const
+{
+    if (isReportPending_)
+    {
+        /* Query compile status and log of default permutation once the report is requested */
+        ReportStatusAndLog(GLLegacyShader::GetCompileStatus(GetID()), GLLegacyShader::GetGLShaderLog(GetID()));
+        isReportPending_ = false;
+    }
+    return GLShader::GetReport();
+}
+
 void GLLegacyShader::CompileShaderSource(GLuint shader, const char* source)
 {
     const GLchar* strings[1] = { source };
@@ -93,6 +105,13 @@ GLuint GLLegacyShader::CreateShaderPermutation(Permutation permutation)
 
 bool GLLegacyShader::FinalizeShaderPermutation(Permutation permutation)
 {
+    /* Don't wait for the driver to finish compiling; compile status is queried in GetReport() */
+    if (GLShader::IsParallelCompileSupported())
+    {
+        isReportPending_ = true;
+        return true;
+    }
+
     /* Query compile status and log */
     const bool status = GLLegacyShader::GetCompileStatus(GetID());
     ReportStatusAndLog(status, GLLegacyShader::GetGLShaderLog(GetID()));
@@ -112,7 +131,15 @@ void GLLegacyShader::CompileSource(const ShaderDescriptor& shaderDesc)
     auto CompileShaderPermutation = [this, &shaderDesc](Permutation permutation, long enabledFlags) -> bool
     {
         const GLuint shader = CreateShaderPermutation(permutation);
-        auto sourceCallback = std::bind(GLLegacyShader::CompileShaderSource, shader, std::placeholders::_1);
+        auto sourceCallback = [this, shader, permutation](const char* source)
+        {
+            /* Store hash of patched source to identify cached program binaries */
+            FNV1aHasher hasher;
+            hasher.AppendString(source);
+            SetSourceHash(hasher.value, permutation);
+
+            GLLegacyShader::CompileShaderSource(shader, source);
+        };
 
         if (shaderDesc.sourceType == ShaderSourceType::CodeFile)
         {
@@ -160,6 +187,12 @@ void GLLegacyShader::LoadBinary(const ShaderDescriptor& shaderDesc)
             binaryLength = static_cast<GLsizei>(shaderDesc.sourceSize);
         }
 
+        /* Store hash of binary and entry point to identify cached program binaries */
+        FNV1aHasher hasher;
+        hasher.Append(binaryBuffer, static_cast<std::size_t>(binaryLength));
+        hasher.AppendString(shaderDesc.entryPoint);
+        SetSourceHash(hasher.value);
+
         /* Load shader binary */
         glShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V, binaryBuffer, binaryLength);
 
@@ -24,6 +24,7 @@ class GLLegacyShader final : public GLShader
 
         void SetName(const char* name) override;
         bool Reflect(ShaderReflection& reflection) const override;
+        const Report* GetReport() const override;
 
     public:
 
@@ -50,6 +51,10 @@ class GLLegacyShader final : public GLShader
         void CompileSource(const ShaderDescriptor& shaderDesc);
         void LoadBinary(const ShaderDescriptor& shaderDesc);
 
+    private:
+
+        mutable bool isReportPending_ = false; // Compile status is queried on demand; See GLShader::IsParallelCompileSupported().
+
 };
 
 
@@ -8,6 +8,7 @@
 #include "GLPipelineSignature.h"
 #include "GLShader.h"
 #include "../../CheckedCast.h"
+#include "../../../Core/CoreUtils.h"
 #include "../../../Core/MacroUtils.h"
 #include "../../../Core/Assertion.h"
 #include <LLGL/Utils/ForRange.h>
@@ -76,6 +77,15 @@ void GLPipelineSignature::Build(std::size_t numShaders, const Shader* const* sha
     numShaders_ = SortShaderArray(numShaders, shaders, permutation, shaders_);
 }
 
+std::size_t GLPipelineSignature::GetHash() const
+{
+    /* Combine the same members that are compared in CompareSWO() */
+    FNV1aHasher hasher;
+    hasher.AppendValue(typeBitAndNumShaders_);
+    hasher.Append(shaders_, sizeof(GLuint) * numShaders_);
+    return static_cast<std::size_t>(hasher.value);
+}
+
 int GLPipelineSignature::CompareSWO(const GLPipelineSignature& lhs, const GLPipelineSignature& rhs)
 {
     LLGL_COMPARE_MEMBER_SWO(typeBitAndNumShaders_);
@@ -40,6 +40,9 @@ class GLPipelineSignature
         */
         void Build(std::size_t numShaders, const Shader* const* shaders, GLShader::Permutation permutation);
 
+        // Returns a hash value of this signature for hashed lookups in GLStatePool. Equal signatures have equal hashes.
+        std::size_t GetHash() const;
+
     public:
 
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
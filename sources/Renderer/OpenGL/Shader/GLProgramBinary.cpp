@@ -0,0 +1,100 @@
+/*
+ * GLProgramBinary.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GLProgramBinary.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+bool IsGLProgramBinarySupported()
+{
+    #ifdef LLGL_GLEXT_GET_PROGRAM_BINARY
+    #ifdef LLGL_OPENGL
+    if (!HasExtension(GLExt::ARB_get_program_binary))
+        return false;
+    #endif
+    GLint numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    return (numFormats > 0);
+    #else
+    return false;
+    #endif
+}
+
+void HashGLDriverString(FNV1aHasher& hasher)
+{
+    hasher.AppendString(reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hasher.AppendString(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hasher.AppendString(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+}
+
+#ifdef LLGL_GLEXT_GET_PROGRAM_BINARY
+
+// Returns true if the specified format is in the list of GL_PROGRAM_BINARY_FORMATS. Avoids GL_INVALID_ENUM errors for binaries from another driver.
+static bool IsGLProgramBinaryFormatSupported(GLenum format)
+{
+    GLint numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    if (numFormats <= 0)
+        return false;
+
+    std::vector<GLint> formats(static_cast<std::size_t>(numFormats), 0);
+    glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+
+    return (std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) != formats.end());
+}
+
+#endif // /LLGL_GLEXT_GET_PROGRAM_BINARY
+
+bool LoadGLProgramBinary(GLuint program, const GLProgramBinary& binary)
+{
+    #ifdef LLGL_GLEXT_GET_PROGRAM_BINARY
+    if (binary.data.empty() || !IsGLProgramBinaryFormatSupported(binary.format))
+        return false;
+
+    glProgramBinary(program, binary.format, binary.data.data(), static_cast<GLsizei>(binary.data.size()));
+
+    /* Driver reports a failed link status if the binary is rejected, e.g. after a driver update */
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    return (status != GL_FALSE);
+    #else
+    return false;
+    #endif
+}
+
+bool StoreGLProgramBinary(GLuint program, GLProgramBinary& outBinary)
+{
+    #ifdef LLGL_GLEXT_GET_PROGRAM_BINARY
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+
+    outBinary.data.resize(static_cast<std::size_t>(length));
+
+    GLsizei bytesWritten = 0;
+    glGetProgramBinary(program, static_cast<GLsizei>(length), &bytesWritten, &(outBinary.format), outBinary.data.data());
+    outBinary.data.resize(static_cast<std::size_t>(bytesWritten));
+
+    return (bytesWritten > 0);
+    #else
+    return false;
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,51 @@
+/*
+ * GLProgramBinary.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GL_PROGRAM_BINARY_H
+#define LLGL_GL_PROGRAM_BINARY_H
+
+
+#include "../OpenGL.h"
+#include "../../../Core/CoreUtils.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Native GL program binary as returned by glGetProgramBinary.
+struct GLProgramBinary
+{
+    std::uint64_t       hash    = 0; // Hash of all inputs the program was linked from, i.e. patched sources, bindings, and driver.
+    GLenum              format  = 0;
+    std::vector<char>   data;
+};
+
+// Returns true if GL program binaries are supported, i.e. GL_ARB_get_program_binary or GLES 3.0 with at least one binary format.
+bool IsGLProgramBinarySupported();
+
+// Appends the vendor, renderer, and version strings of the current GL context to the specified hasher.
+void HashGLDriverString(FNV1aHasher& hasher);
+
+// Loads the specified binary into the GL program. Returns false if the binary format is not supported or the driver rejected the binary.
+bool LoadGLProgramBinary(GLuint program, const GLProgramBinary& binary);
+
+// Retrieves the binary of the specified linked GL program. Returns false if the driver does not provide a binary for this program.
+bool StoreGLProgramBinary(GLuint program, GLProgramBinary& outBinary);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -96,6 +96,18 @@ void GLProgramPipeline::QueryInfoLogs(Report& report)
     report.Reset(std::move(log), hasErrors);
 }
 
+bool GLProgramPipeline::GetProgramBinary(GLProgramBinary& /*outBinary*/) const
+{
+    /* Separable shader programs are linked at shader creation, so there is no single program binary for this pipeline */
+    return false;
+}
+
+bool GLProgramPipeline::IsReady() const
+{
+    /* Separable shaders are always linked synchronously */
+    return true;
+}
+
 
 /*
  * ======= Private: =======
@@ -33,6 +33,8 @@ class GLProgramPipeline final : public GLShaderPipeline
         void Bind(GLStateManager& stateMngr) override;
         void BindResourceSlots(const GLShaderBindingLayout& bindingLayout) override;
         void QueryInfoLogs(Report& report) override;
+        bool GetProgramBinary(GLProgramBinary& outBinary) const override;
+        bool IsReady() const override;
 
     private:
 
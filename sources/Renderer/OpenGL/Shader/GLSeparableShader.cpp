@@ -50,9 +50,14 @@ void GLSeparableShader::BindResourceSlots(const GLShaderBindingLayout& bindingLa
 {
     if (bindingLayout_ != &bindingLayout)
     {
-        bindingLayout.UniformAndBlockBinding(GetID());
-        if (GLuint id = GetID(PermutationFlippedYPosition))
-            bindingLayout.UniformAndBlockBinding(id);
+        /* SPIR-V modules have explicit binding points and don't need to resolve any names */
+        if (!IsSpirvModule())
+        {
+            bindingCaches_[PermutationDefault].BindResourceSlots(GetID(), bindingLayout);
+            const GLuint flippedYPositionID = GetID(PermutationFlippedYPosition);
+            if (flippedYPositionID != GetID())
+                bindingCaches_[PermutationFlippedYPosition].BindResourceSlots(flippedYPositionID, bindingLayout);
+        }
         bindingLayout_ = &bindingLayout;
     }
 }
@@ -10,6 +10,7 @@
 
 
 #include "GLShader.h"
+#include "GLShaderBindingLayout.h"
 #include <LLGL/Report.h>
 
 
@@ -18,7 +19,6 @@ namespace LLGL
 
 
 class GLLegacyShader;
-class GLShaderBindingLayout;
 
 // Shader implementation for separable GL shader programs; requires GL_ARB_separate_shader_objects extension.
 class GLSeparableShader final : public GLShader
@@ -46,7 +46,8 @@ class GLSeparableShader final : public GLShader
 
     private:
 
-        const GLShaderBindingLayout* bindingLayout_ = nullptr;
+        const GLShaderBindingLayout*    bindingLayout_                  = nullptr;
+        GLShaderBindingCache            bindingCaches_[PermutationCount];
 
 };
 
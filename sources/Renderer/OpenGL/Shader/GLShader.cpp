@@ -25,8 +25,9 @@ namespace LLGL
 
 
 GLShader::GLShader(const bool isSeparable, const ShaderDescriptor& desc) :
-    Shader       { desc.type   },
-    isSeparable_ { isSeparable }
+    Shader          { desc.type                            },
+    isSeparable_    { isSeparable                          },
+    isSpirvModule_  { !IsShaderSourceCode(desc.sourceType) }
 {
     ReserveAttribs(desc);
     BuildVertexInputLayout(desc.vertex.inputAttribs.size(), desc.vertex.inputAttribs.data());
@@ -70,6 +71,15 @@ GLenum GLShader::GetGLType() const
     return GLTypes::Map(GetType());
 }
 
+bool GLShader::IsParallelCompileSupported()
+{
+    #ifdef LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    return (HasExtension(GLExt::KHR_parallel_shader_compile) || HasExtension(GLExt::ARB_parallel_shader_compile));
+    #else
+    return false;
+    #endif
+}
+
 bool GLShader::NeedsPermutationFlippedYPosition(const ShaderType shaderType, long shaderFlags)
 {
     /* If GL_ARB_clip_control is supported, emulating this feature via shader permutation is not necessary */
@@ -157,7 +167,7 @@ void GLShader::PatchShaderSourceWithOptions(
     }
 }
 
-void GLShader::ReportStatusAndLog(bool status, const std::string& log)
+void GLShader::ReportStatusAndLog(bool status, const std::string& log) const
 {
     ResetReportWithNewline(report_, log.c_str(), !status);
 }
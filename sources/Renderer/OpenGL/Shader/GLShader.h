@@ -77,14 +77,32 @@ class GLShader : public Shader
             return (id_[permutation] != 0 ? id_[permutation] : id_[PermutationDefault]);
         }
 
+        // Returns the hash of the patched source or binary the specified permutation was compiled from, or the default permutation if the specified one is not available.
+        inline std::uint64_t GetSourceHash(Permutation permutation) const
+        {
+            return (id_[permutation] != 0 ? sourceHash_[permutation] : sourceHash_[PermutationDefault]);
+        }
+
         // Returns true if this is a separable shader, i.e. of type <GLSeparableShader>. Otherwise, it's of type <GLLegacyShader>.
         inline bool IsSeparable() const
         {
             return isSeparable_;
         }
 
+        // Returns true if this shader was loaded from a SPIR-V module (GL_ARB_gl_spirv), whose resource bindings are always explicit.
+        inline bool IsSpirvModule() const
+        {
+            return isSpirvModule_;
+        }
+
     public:
 
+        /*
+        Returns true if GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile is supported.
+        In that case, shaders and programs are compiled asynchronously and their status is only queried on demand.
+        */
+        static bool IsParallelCompileSupported();
+
         // Returns true if the specified shader descriptor requires the permutation with flipped Y-position; See PermutationFlippedYPosition.
         static bool NeedsPermutationFlippedYPosition(const ShaderType shaderType, long shaderFlags);
 
@@ -113,7 +131,7 @@ class GLShader : public Shader
         GLShader(const bool isSeparable, const ShaderDescriptor& desc);
 
         // Resets the report with the specified compile/link status and log.
-        void ReportStatusAndLog(bool status, const std::string& log);
+        void ReportStatusAndLog(bool status, const std::string& log) const;
 
         // Stores the native shader ID.
         inline void SetID(GLuint id, Permutation permutation = PermutationDefault)
@@ -121,6 +139,12 @@ class GLShader : public Shader
             id_[permutation] = id;
         }
 
+        // Stores the hash of the patched source or binary for the specified permutation.
+        inline void SetSourceHash(std::uint64_t hash, Permutation permutation = PermutationDefault)
+        {
+            sourceHash_[permutation] = hash;
+        }
+
     private:
 
         void ReserveAttribs(const ShaderDescriptor& desc);
@@ -131,12 +155,14 @@ class GLShader : public Shader
     private:
 
         const bool                      isSeparable_;
+        const bool                      isSpirvModule_;
         GLuint                          id_[PermutationCount]       = {}; // ID from either glCreateShader or glCreateShaderProgramv
+        std::uint64_t                   sourceHash_[PermutationCount] = {};
         LinearStringContainer           shaderAttribNames_;
         std::vector<GLShaderAttribute>  shaderAttribs_;
         std::size_t                     numVertexAttribs_           = 0;
         std::vector<const char*>        transformFeedbackVaryings_;
-        Report                          report_;
+        mutable Report                  report_;
 
 };
 
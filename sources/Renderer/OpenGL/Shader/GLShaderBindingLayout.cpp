@@ -6,26 +6,92 @@
  */
 
 #include "GLShaderBindingLayout.h"
+#include "GLProgramBinary.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../Ext/GLExtensions.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../../Core/MacroUtils.h"
+#include "../../../Core/Assertion.h"
 #include <LLGL/Utils/ForRange.h>
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
+// Returns the number of characters (including null terminators) of all non-empty resource names in the specified pipeline layout.
+static std::size_t GetTotalResourceNameLength(const GLPipelineLayout& pipelineLayout)
+{
+    std::size_t totalLength = 0;
+    for (const BindingDescriptor& binding : pipelineLayout.GetHeapBindings())
+    {
+        if (!binding.name.empty())
+            totalLength += binding.name.size() + 1;
+    }
+    for (const StringView& name : pipelineLayout.GetBindingNames())
+    {
+        if (!name.empty())
+            totalLength += name.size() + 1;
+    }
+    for (const StringView& name : pipelineLayout.GetStaticSamplerNames())
+    {
+        if (!name.empty())
+            totalLength += name.size() + 1;
+    }
+    return totalLength;
+}
+
 GLShaderBindingLayout::GLShaderBindingLayout(const GLPipelineLayout& pipelineLayout)
 {
+    /* Reserve an upper bound of the name buffer, so all names are copied with a single allocation */
+    names_.reserve(GetTotalResourceNameLength(pipelineLayout));
     BuildUniformBindings(pipelineLayout);
     BuildUniformBlockBindings(pipelineLayout);
     BuildShaderStorageBindings(pipelineLayout);
+    BuildHash();
 }
 
-void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManager* stateMngr) const
+void GLShaderBindingLayout::ResolveBindings(GLuint program, GLShaderBindingTable& outTable) const
 {
+    outTable.layout     = this;
+    outTable.layoutHash = hash_;
+    outTable.indices.resize(bindings_.size());
+
+    std::size_t resourceIndex = 0;
+
+    /* Resolve uniform locations */
+    for_range(i, numUniformBindings_)
+    {
+        outTable.indices[resourceIndex] = glGetUniformLocation(program, GetBindingName(bindings_[resourceIndex]));
+        ++resourceIndex;
+    }
+
+    /* Resolve uniform-block indices */
+    for_range(i, numUniformBlockBindings_)
+    {
+        const GLuint blockIndex = glGetUniformBlockIndex(program, GetBindingName(bindings_[resourceIndex]));
+        outTable.indices[resourceIndex] = (blockIndex != GL_INVALID_INDEX ? static_cast<GLint>(blockIndex) : -1);
+        ++resourceIndex;
+    }
+
+    /* Resolve shader-storage block indices */
+    for_range(i, numShaderStorageBindings_)
+    {
+        #ifdef LLGL_GLEXT_SHADER_STORAGE_BUFFER_OBJECT
+        const GLuint blockIndex = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, GetBindingName(bindings_[resourceIndex]));
+        outTable.indices[resourceIndex] = (blockIndex != GL_INVALID_INDEX ? static_cast<GLint>(blockIndex) : -1);
+        #else
+        outTable.indices[resourceIndex] = -1;
+        #endif
+        ++resourceIndex;
+    }
+}
+
+void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, const GLShaderBindingTable& table, GLStateManager* stateMngr) const
+{
+    LLGL_ASSERT(IsBindingTableCompatible(table));
+
     std::size_t resourceIndex = 0;
 
     /* Set uniform bindings */
@@ -34,10 +100,10 @@ void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManage
     {
         for_range(i, numUniformBindings_)
         {
-            const auto& resource = bindings_[resourceIndex++];
-            GLint location = glGetUniformLocation(program, resource.name.c_str());
-            if (location != GL_INVALID_INDEX)
-                glProgramUniform1i(program, location, static_cast<GLint>(resource.slot));
+            const GLint location = table.indices[resourceIndex];
+            if (location != -1)
+                glProgramUniform1i(program, location, static_cast<GLint>(bindings_[resourceIndex].slot));
+            ++resourceIndex;
         }
     }
     else
@@ -49,10 +115,10 @@ void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManage
         {
             for_range(i, numUniformBindings_)
             {
-                const auto& resource = bindings_[resourceIndex++];
-                GLint location = glGetUniformLocation(program, resource.name.c_str());
-                if (location != GL_INVALID_INDEX)
-                    glUniform1i(location, static_cast<GLint>(resource.slot));
+                const GLint location = table.indices[resourceIndex];
+                if (location != -1)
+                    glUniform1i(location, static_cast<GLint>(bindings_[resourceIndex].slot));
+                ++resourceIndex;
             }
         }
         stateMngr->PopBoundShaderProgram();
@@ -61,30 +127,30 @@ void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManage
     {
         for_range(i, numUniformBindings_)
         {
-            const auto& resource = bindings_[resourceIndex++];
-            GLint location = glGetUniformLocation(program, resource.name.c_str());
-            if (location != GL_INVALID_INDEX)
-                glUniform1i(location, static_cast<GLint>(resource.slot));
+            const GLint location = table.indices[resourceIndex];
+            if (location != -1)
+                glUniform1i(location, static_cast<GLint>(bindings_[resourceIndex].slot));
+            ++resourceIndex;
         }
     }
 
     /* Set uniform-block bindings */
     for_range(i, numUniformBlockBindings_)
     {
-        const auto& resource = bindings_[resourceIndex++];
-        GLuint blockIndex = glGetUniformBlockIndex(program, resource.name.c_str());
-        if (blockIndex != GL_INVALID_INDEX)
-            glUniformBlockBinding(program, blockIndex, resource.slot);
+        const GLint blockIndex = table.indices[resourceIndex];
+        if (blockIndex != -1)
+            glUniformBlockBinding(program, static_cast<GLuint>(blockIndex), bindings_[resourceIndex].slot);
+        ++resourceIndex;
     }
 
     /* Set shader-storage bindings */
     #ifdef LLGL_GLEXT_SHADER_STORAGE_BUFFER_OBJECT
     for_range(i, numShaderStorageBindings_)
     {
-        const auto& resource = bindings_[resourceIndex++];
-        GLuint blockIndex = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, resource.name.c_str());
-        if (blockIndex != GL_INVALID_INDEX)
-            glShaderStorageBlockBinding(program, blockIndex, resource.slot);
+        const GLint blockIndex = table.indices[resourceIndex];
+        if (blockIndex != -1)
+            glShaderStorageBlockBinding(program, static_cast<GLuint>(blockIndex), bindings_[resourceIndex].slot);
+        ++resourceIndex;
     }
     #endif
 }
@@ -94,6 +160,11 @@ bool GLShaderBindingLayout::HasBindings() const
     return ((numUniformBindings_ | numUniformBlockBindings_ | numShaderStorageBindings_) != 0);
 }
 
+bool GLShaderBindingLayout::IsBindingTableCompatible(const GLShaderBindingTable& table) const
+{
+    return (table.layout == this && table.layoutHash == hash_ && table.indices.size() == bindings_.size());
+}
+
 int GLShaderBindingLayout::CompareSWO(const GLShaderBindingLayout& lhs, const GLShaderBindingLayout& rhs)
 {
     /* Compare number of bindings first; if equal we can use one of the arrays only */
@@ -102,7 +173,9 @@ int GLShaderBindingLayout::CompareSWO(const GLShaderBindingLayout& lhs, const GL
     for_range(i, lhs.bindings_.size())
     {
         LLGL_COMPARE_MEMBER_SWO( bindings_[i].slot );
-        LLGL_COMPARE_MEMBER_SWO( bindings_[i].name );
+        const int nameOrder = ::strcmp(lhs.GetBindingName(lhs.bindings_[i]), rhs.GetBindingName(rhs.bindings_[i]));
+        if (nameOrder != 0)
+            return nameOrder;
     }
 
     return 0;
@@ -120,7 +193,7 @@ void GLShaderBindingLayout::BuildUniformBindings(const GLPipelineLayout& pipelin
     {
         if (!binding.name.empty())
         {
-            if (binding.type == ResourceType::Sampler || binding.type == ResourceType::Texture)
+            if ((binding.type == ResourceType::Sampler || binding.type == ResourceType::Texture) && !pipelineLayout.IsBindlessTextureHeapBinding(binding))
                 AppendUniformBinding(binding.name, binding.slot.index);
         }
     }
@@ -160,6 +233,8 @@ void GLShaderBindingLayout::BuildUniformBlockBindings(const GLPipelineLayout& pi
         {
             if (binding.type == ResourceType::Buffer && (binding.bindFlags & BindFlags::ConstantBuffer) != 0)
                 AppendUniformBlockBinding(binding.name, binding.slot.index);
+            else if (pipelineLayout.IsBindlessTextureHeapBinding(binding))
+                AppendUniformBlockBinding(binding.name, binding.slot.index);
         }
     }
 
@@ -201,24 +276,75 @@ void GLShaderBindingLayout::BuildShaderStorageBindings(const GLPipelineLayout& p
     }
 }
 
-void GLShaderBindingLayout::AppendUniformBinding(const std::string& name, std::uint32_t slot)
+void GLShaderBindingLayout::AppendUniformBinding(const StringView& name, std::uint32_t slot)
 {
-    bindings_.push_back({ name, slot });
+    AppendNamedResourceBinding(name, slot);
     ++numUniformBindings_;
 }
 
-void GLShaderBindingLayout::AppendUniformBlockBinding(const std::string& name, std::uint32_t slot)
+void GLShaderBindingLayout::AppendUniformBlockBinding(const StringView& name, std::uint32_t slot)
 {
-    bindings_.push_back({ name, slot });
+    AppendNamedResourceBinding(name, slot);
     ++numUniformBlockBindings_;
 }
 
-void GLShaderBindingLayout::AppendShaderStorageBinding(const std::string& name, std::uint32_t slot)
+void GLShaderBindingLayout::AppendShaderStorageBinding(const StringView& name, std::uint32_t slot)
 {
-    bindings_.push_back({ name, slot });
+    AppendNamedResourceBinding(name, slot);
     ++numShaderStorageBindings_;
 }
 
+void GLShaderBindingLayout::AppendNamedResourceBinding(const StringView& name, std::uint32_t slot)
+{
+    const std::uint32_t nameOffset = static_cast<std::uint32_t>(names_.size());
+    names_.insert(names_.end(), name.begin(), name.end());
+    names_.push_back('\0');
+    bindings_.push_back({ nameOffset, slot });
+}
+
+void GLShaderBindingLayout::BuildHash()
+{
+    FNV1aHasher hasher;
+    hasher.AppendValue(numUniformBindings_);
+    hasher.AppendValue(numUniformBlockBindings_);
+    hasher.AppendValue(numShaderStorageBindings_);
+    for (const NamedResourceBinding& binding : bindings_)
+    {
+        hasher.AppendString(GetBindingName(binding));
+        hasher.AppendValue(binding.slot);
+    }
+    hash_ = hasher.value;
+}
+
+
+/*
+ * GLShaderBindingCache class
+ */
+
+void GLShaderBindingCache::BindResourceSlots(GLuint program, const GLShaderBindingLayout& bindingLayout, GLStateManager* stateMngr)
+{
+    /* Find binding table that has been resolved for this layout before */
+    for (GLShaderBindingTable& table : tables_)
+    {
+        if (table.layout == &bindingLayout)
+        {
+            /*
+            Re-resolve the table if it belongs to a previous layout that was released and shared the same address.
+            Comparing the hash and binding count as well ensures a table is never applied to a layout it doesn't fit.
+            */
+            if (!bindingLayout.IsBindingTableCompatible(table))
+                bindingLayout.ResolveBindings(program, table);
+            bindingLayout.UniformAndBlockBinding(program, table, stateMngr);
+            return;
+        }
+    }
+
+    /* Resolve binding names only once per layout */
+    tables_.emplace_back();
+    bindingLayout.ResolveBindings(program, tables_.back());
+    bindingLayout.UniformAndBlockBinding(program, tables_.back(), stateMngr);
+}
+
 
 } // /namespace LLGL
 
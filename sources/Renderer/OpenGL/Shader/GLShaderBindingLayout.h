@@ -26,7 +26,18 @@ class GLStateManager;
 
 using GLShaderBindingLayoutSPtr = std::shared_ptr<GLShaderBindingLayout>;
 
-// Helper class to handle uniform block bindings and other resource bindings for GL shader programs with different pipeline layouts.
+// Resource bindings of a linked GL program that have been resolved from the binding names of a GLShaderBindingLayout.
+struct GLShaderBindingTable
+{
+    const GLShaderBindingLayout*    layout      = nullptr;  // Layout this table was resolved from; only used for identity, never dereferenced.
+    std::uint64_t                   layoutHash  = 0;
+    std::vector<GLint>              indices;                // Uniform locations and block indices in the same order as the layout bindings; -1 for inactive resources.
+};
+
+/*
+Helper class to handle uniform block bindings and other resource bindings for GL shader programs with different pipeline layouts.
+Only named bindings are resolved; resources with explicit binding points, i.e. layout(binding = N), can be declared without names.
+*/
 class GLShaderBindingLayout
 {
 
@@ -38,12 +49,27 @@ class GLShaderBindingLayout
 
         GLShaderBindingLayout(const GLPipelineLayout& pipelineLayout);
 
-        // Binds the resource slots to the specified GL shader program. Provides optional state manager if specified program is not currently bound, i.e. glUseProgram.
-        void UniformAndBlockBinding(GLuint program, GLStateManager* stateMngr = nullptr) const;
+        // Resolves the uniform locations and block indices of all named bindings for the specified linked GL shader program.
+        void ResolveBindings(GLuint program, GLShaderBindingTable& outTable) const;
+
+        /*
+        Binds the resource slots to the specified GL shader program with a binding table that was resolved by this layout.
+        Provides optional state manager if specified program is not currently bound, i.e. glUseProgram.
+        */
+        void UniformAndBlockBinding(GLuint program, const GLShaderBindingTable& table, GLStateManager* stateMngr = nullptr) const;
 
         // Returns true if this layout has at least one binding slot.
         bool HasBindings() const;
 
+        // Returns true if the specified binding table was resolved by this layout and can be passed to UniformAndBlockBinding().
+        bool IsBindingTableCompatible(const GLShaderBindingTable& table) const;
+
+        // Returns the hash of all binding names and slots of this layout. Identifies the binding tables of this layout.
+        inline std::uint64_t GetHash() const
+        {
+            return hash_;
+        }
+
     public:
 
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
@@ -51,9 +77,10 @@ class GLShaderBindingLayout
 
     private:
 
+        // Resource binding whose null-terminated name is stored at the specified offset within the name buffer.
         struct NamedResourceBinding
         {
-            std::string     name;
+            std::uint32_t   nameOffset;
             std::uint32_t   slot;
         };
 
@@ -63,16 +90,45 @@ class GLShaderBindingLayout
         void BuildUniformBlockBindings(const GLPipelineLayout& pipelineLayout);
         void BuildShaderStorageBindings(const GLPipelineLayout& pipelineLayout);
 
-        void AppendUniformBinding(const std::string& name, std::uint32_t slot);
-        void AppendUniformBlockBinding(const std::string& name, std::uint32_t slot);
-        void AppendShaderStorageBinding(const std::string& name, std::uint32_t slot);
+        void AppendUniformBinding(const StringView& name, std::uint32_t slot);
+        void AppendUniformBlockBinding(const StringView& name, std::uint32_t slot);
+        void AppendShaderStorageBinding(const StringView& name, std::uint32_t slot);
+        void AppendNamedResourceBinding(const StringView& name, std::uint32_t slot);
+
+        // Returns the null-terminated name of the specified binding.
+        inline const char* GetBindingName(const NamedResourceBinding& binding) const
+        {
+            return names_.data() + binding.nameOffset;
+        }
+
+        void BuildHash();
 
     private:
 
         std::uint8_t                        numUniformBindings_         = 0;
         std::uint8_t                        numUniformBlockBindings_    = 0;
         std::uint8_t                        numShaderStorageBindings_   = 0;
-        std::vector<NamedResourceBinding>   bindings_;
+        SmallVector<NamedResourceBinding>   bindings_;
+        std::vector<char>                   names_;                         // Linear storage for all binding names
+        std::uint64_t                       hash_                       = 0;
+
+};
+
+// Cache of binding tables for all binding layouts a single GL shader program has been used with.
+class GLShaderBindingCache
+{
+
+    public:
+
+        /*
+        Binds the resource slots of the specified layout to the GL shader program.
+        The binding names are only resolved the first time the layout is used with this program.
+        */
+        void BindResourceSlots(GLuint program, const GLShaderBindingLayout& bindingLayout, GLStateManager* stateMngr = nullptr);
+
+    private:
+
+        std::vector<GLShaderBindingTable> tables_;
 
 };
 
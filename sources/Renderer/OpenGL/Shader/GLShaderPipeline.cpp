@@ -20,6 +20,11 @@ GLShaderPipeline::GLShaderPipeline(GLuint id) :
 {
 }
 
+void GLShaderPipeline::FlushPendingLink()
+{
+    // dummy
+}
+
 void GLShaderPipeline::BuildSignature(std::size_t numShaders, const Shader* const* shaders, GLShader::Permutation permutation)
 {
     signature_.Build(numShaders, shaders, permutation);
@@ -22,6 +22,7 @@ class GLShaderPipeline;
 class GLShaderBindingLayout;
 class GLStateManager;
 class Report;
+struct GLProgramBinary;
 
 using GLShaderPipelineSPtr = std::shared_ptr<GLShaderPipeline>;
 
@@ -42,12 +43,27 @@ class GLShaderPipeline
         // Resets the output report with the shader info logs.
         virtual void QueryInfoLogs(Report& report) = 0;
 
+        // Retrieves the native program binary of this pipeline. Returns false if this pipeline cannot be restored from a binary.
+        virtual bool GetProgramBinary(GLProgramBinary& outBinary) const = 0;
+
+        // Returns true if the driver has finished compiling and linking this pipeline. This query does not block.
+        virtual bool IsReady() const = 0;
+
+        // Links this pipeline if linking was deferred until its first use. Does nothing by default.
+        virtual void FlushPendingLink();
+
         // Returns the native pipeline ID. Can be either from glCreateProgramPipelines or glCreateProgram.
         inline GLuint GetID() const
         {
             return id_;
         }
 
+        // Returns the pipeline signature.
+        inline const GLPipelineSignature& GetSignature() const
+        {
+            return signature_;
+        }
+
     public:
 
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
@@ -70,12 +86,6 @@ class GLShaderPipeline
             id_ = id;
         }
 
-        // Returns the pipeline signature.
-        inline const GLPipelineSignature& GetSignature() const
-        {
-            return signature_;
-        }
-
     private:
 
         GLuint              id_         = 0; // ID from either glCreateProgramPipelines or glCreateProgram.
@@ -8,6 +8,7 @@
 #include "GLShaderProgram.h"
 #include "GLLegacyShader.h"
 #include "GLShaderBindingLayout.h"
+#include "GLProgramBinary.h"
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
 #include "../RenderState/GLStateManager.h"
@@ -88,18 +89,55 @@ struct GLOrderedShaders
     const GLShader* fragmentShader              = nullptr;
     const GLShader* shaderWithFlippedYPosition  = nullptr; // Last shader that modifies gl_Position (vertex, tessellation-evaluation, or geometry)
 
-    GLuint GetGLShaderID(const GLShader* shader) const
+    GLShader::Permutation GetPermutation(const GLShader* shader) const
     {
-        const GLShader::Permutation permutation =
+        return
         (
             shader == shaderWithFlippedYPosition
                 ? GLShader::PermutationFlippedYPosition
                 : GLShader::PermutationDefault
         );
-        return shader->GetID(permutation);
+    }
+
+    GLuint GetGLShaderID(const GLShader* shader) const
+    {
+        return shader->GetID(GetPermutation(shader));
     }
 };
 
+static void HashGLShaderAttribs(FNV1aHasher& hasher, std::size_t numAttribs, const GLShaderAttribute* attribs)
+{
+    hasher.AppendValue(numAttribs);
+    for_range(i, numAttribs)
+    {
+        hasher.AppendValue(attribs[i].index);
+        hasher.AppendString(attribs[i].name);
+    }
+}
+
+// Returns the hash of all inputs a program is linked from: patched shader sources, attribute bindings, varyings, and the GL driver.
+static std::uint64_t HashGLProgramInputs(std::size_t numShaders, const Shader* const* shaders, const GLOrderedShaders& orderedShaders)
+{
+    FNV1aHasher hasher;
+    HashGLDriverString(hasher);
+
+    for_range(i, numShaders)
+    {
+        if (const Shader* shader = shaders[i])
+        {
+            auto shaderGL = LLGL_CAST(const GLShader*, shader);
+            hasher.AppendValue(shaderGL->GetType());
+            hasher.AppendValue(shaderGL->GetSourceHash(orderedShaders.GetPermutation(shaderGL)));
+            HashGLShaderAttribs(hasher, shaderGL->GetNumVertexAttribs(), shaderGL->GetVertexAttribs());
+            HashGLShaderAttribs(hasher, shaderGL->GetNumFragmentAttribs(), shaderGL->GetFragmentAttribs());
+            for (const char* varying : shaderGL->GetTransformFeedbackVaryings())
+                hasher.AppendString(varying);
+        }
+    }
+
+    return hasher.value;
+}
+
 static void AttachGLLegacyShaders(
     GLuint                  program,
     std::size_t             numShaders,
@@ -132,10 +170,26 @@ static void AttachGLLegacyShaders(
     }
 }
 
+// Returns true if all specified shaders were loaded from SPIR-V modules, i.e. all resource bindings are explicit.
+static bool AreAllGLShadersSpirvModules(std::size_t numShaders, const Shader* const* shaders)
+{
+    for_range(i, numShaders)
+    {
+        if (const Shader* shader = shaders[i])
+        {
+            if (!LLGL_CAST(const GLShader*, shader)->IsSpirvModule())
+                return false;
+        }
+    }
+    return true;
+}
+
 GLShaderProgram::GLShaderProgram(
     std::size_t             numShaders,
     const Shader* const*    shaders,
-    GLShader::Permutation   permutation)
+    GLShader::Permutation   permutation,
+    const GLProgramBinary*  cachedBinary,
+    bool                    deferLinking)
 :
     GLShaderPipeline { glCreateProgram() }
 {
@@ -173,28 +227,54 @@ GLShaderProgram::GLShaderProgram(
     if (const GLShader* fs = orderedShaders.fragmentShader)
         GLShaderProgram::BindFragDataLocations(GetID(), fs->GetNumFragmentAttribs(), fs->GetFragmentAttribs());
 
-    /* Build transform feedback varyings for vertex or geometry shader and link program */
-    const GLShader* shaderWithVaryings = nullptr;
+    /* Try to restore linked program from cached binary; falls back to linking from source if the driver rejects the binary */
+    bool isLinkedFromBinary = false;
 
-    if (const GLShader* gs = orderedShaders.geometryShader)
+    #ifdef LLGL_GLEXT_GET_PROGRAM_BINARY
+    if (IsGLProgramBinarySupported())
     {
-        if (!gs->GetTransformFeedbackVaryings().empty())
-            shaderWithVaryings = gs;
-    }
-    else if (const GLShader* vs = orderedShaders.vertexShader)
-    {
-        if (!vs->GetTransformFeedbackVaryings().empty())
-            shaderWithVaryings = vs;
+        binaryHash_ = HashGLProgramInputs(numShaders, shaders, orderedShaders);
+        glProgramParameteri(GetID(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        if (cachedBinary != nullptr && cachedBinary->hash == binaryHash_)
+            isLinkedFromBinary = LoadGLProgramBinary(GetID(), *cachedBinary);
     }
+    #else
+    (void)cachedBinary;
+    #endif // /LLGL_GLEXT_GET_PROGRAM_BINARY
 
-    /* Link shader program */
-    if (shaderWithVaryings != nullptr)
+    if (!isLinkedFromBinary)
     {
-        const auto& varyings = shaderWithVaryings->GetTransformFeedbackVaryings();
-        GLShaderProgram::LinkProgramWithTransformFeedbackVaryings(GetID(), varyings.size(), varyings.data());
+        /* Build transform feedback varyings for vertex or geometry shader and link program */
+        const GLShader* shaderWithVaryings = nullptr;
+
+        if (const GLShader* gs = orderedShaders.geometryShader)
+        {
+            if (!gs->GetTransformFeedbackVaryings().empty())
+                shaderWithVaryings = gs;
+        }
+        else if (const GLShader* vs = orderedShaders.vertexShader)
+        {
+            if (!vs->GetTransformFeedbackVaryings().empty())
+                shaderWithVaryings = vs;
+        }
+
+        /* Link shader program */
+        if (shaderWithVaryings != nullptr)
+        {
+            const auto& varyings = shaderWithVaryings->GetTransformFeedbackVaryings();
+            GLShaderProgram::LinkProgramWithTransformFeedbackVaryings(GetID(), varyings.size(), varyings.data());
+        }
+        else if (deferLinking)
+        {
+            /* Defer linking until first use; attached shaders are kept alive by GL until they are detached */
+            hasPendingLink_ = true;
+        }
+        else
+            GLShaderProgram::LinkProgram(GetID());
     }
-    else
-        GLShaderProgram::LinkProgram(GetID());
+
+    /* SPIR-V modules have explicit binding points, so their resource names don't need to be resolved */
+    hasExplicitBindings_ = AreAllGLShadersSpirvModules(numShaders, shaders);
 
     /* Build pipeline signature */
     BuildSignature(numShaders, shaders, permutation);
@@ -212,6 +292,8 @@ GLShaderProgram::~GLShaderProgram()
 
 void GLShaderProgram::Bind(GLStateManager& stateMngr)
 {
+    if (hasPendingLink_)
+        FlushPendingLink();
     stateMngr.BindShaderProgram(GetID());
 }
 
@@ -219,18 +301,55 @@ void GLShaderProgram::BindResourceSlots(const GLShaderBindingLayout& bindingLayo
 {
     if (bindingLayout_ != &bindingLayout)
     {
-        bindingLayout.UniformAndBlockBinding(GetID());
+        if (!hasExplicitBindings_)
+            bindingCache_.BindResourceSlots(GetID(), bindingLayout);
         bindingLayout_ = &bindingLayout;
     }
 }
 
 void GLShaderProgram::QueryInfoLogs(Report& report)
 {
+    if (hasPendingLink_)
+        FlushPendingLink();
     const bool hasErrors = !GLShaderProgram::GetLinkStatus(GetID());
     std::string log = GLShaderProgram::GetGLProgramLog(GetID());
     report.Reset(std::move(log), hasErrors);
 }
 
+bool GLShaderProgram::GetProgramBinary(GLProgramBinary& outBinary) const
+{
+    if (binaryHash_ == 0 || hasPendingLink_ || !GLShaderProgram::GetLinkStatus(GetID()))
+        return false;
+    outBinary.hash = binaryHash_;
+    return StoreGLProgramBinary(GetID(), outBinary);
+}
+
+bool GLShaderProgram::IsReady() const
+{
+    /* Programs whose linking is deferred have no work in flight */
+    if (hasPendingLink_)
+        return true;
+    #ifdef LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    if (GLShader::IsParallelCompileSupported())
+    {
+        /* GL_COMPLETION_STATUS_KHR and GL_COMPLETION_STATUS_ARB share the same value */
+        GLint status = GL_TRUE;
+        glGetProgramiv(GetID(), GL_COMPLETION_STATUS_KHR, &status);
+        return (status != GL_FALSE);
+    }
+    #endif // /LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    return true;
+}
+
+void GLShaderProgram::FlushPendingLink()
+{
+    if (hasPendingLink_)
+    {
+        GLShaderProgram::LinkProgram(GetID());
+        hasPendingLink_ = false;
+    }
+}
+
 bool GLShaderProgram::GetLinkStatus(GLuint program)
 {
     GLint status = 0;
@@ -12,6 +12,7 @@
 #include <LLGL/ShaderReflection.h>
 #include "GLShaderPipeline.h"
 #include "GLShaderUniform.h"
+#include "GLShaderBindingLayout.h"
 
 
 namespace LLGL
@@ -19,7 +20,6 @@ namespace LLGL
 
 
 struct GLShaderAttribute;
-class GLShaderBindingLayout;
 
 class GLShaderProgram final : public GLShaderPipeline
 {
@@ -29,13 +29,25 @@ class GLShaderProgram final : public GLShaderPipeline
         void Bind(GLStateManager& stateMngr) override;
         void BindResourceSlots(const GLShaderBindingLayout& bindingLayout) override;
         void QueryInfoLogs(Report& report) override;
+        bool GetProgramBinary(GLProgramBinary& outBinary) const override;
+        bool IsReady() const override;
+        void FlushPendingLink() override;
 
     public:
 
+        /*
+        Creates and links a shader program from the specified shaders.
+        If 'cachedBinary' is not null and matches the hash of all program inputs, the program is restored from that binary instead.
+        If 'deferLinking' is true, the program is only linked when it is bound for the first time.
+        The attached shaders remain valid until then, even if their shader objects are released in the meantime.
+        Programs with transform feedback varyings are always linked immediately.
+        */
         GLShaderProgram(
             std::size_t             numShaders,
             const Shader* const*    shaders,
-            GLShader::Permutation   permutation = GLShader::PermutationDefault
+            GLShader::Permutation   permutation     = GLShader::PermutationDefault,
+            const GLProgramBinary*  cachedBinary    = nullptr,
+            bool                    deferLinking    = false
         );
         ~GLShaderProgram();
 
@@ -65,6 +77,10 @@ class GLShaderProgram final : public GLShaderPipeline
     private:
 
         const GLShaderBindingLayout*    bindingLayout_          = nullptr;
+        GLShaderBindingCache            bindingCache_;
+        std::uint64_t                   binaryHash_             = 0; // Hash of all program inputs; Zero if program binaries are not supported.
+        bool                            hasPendingLink_         = false;
+        bool                            hasExplicitBindings_    = false; // All shaders are SPIR-V modules; see GLShader::IsSpirvModule
 
         #ifdef __APPLE__
         bool                            hasNullFragmentShader_  = false;
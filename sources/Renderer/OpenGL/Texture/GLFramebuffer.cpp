@@ -153,6 +153,24 @@ void GLFramebuffer::AttachTexture(
     }
 }
 
+#ifdef GL_OVR_multiview
+
+void GLFramebuffer::AttachTextureMultiview(
+    const GLTexture&    texture,
+    GLenum              attachment,
+    GLint               mipLevel,
+    GLint               baseViewIndex,
+    GLsizei             numViews,
+    GLenum              target)
+{
+    /* Multi-sampled array textures only have a single MIP-map level */
+    if (texture.GetType() == TextureType::Texture2DMSArray)
+        mipLevel = 0;
+    glFramebufferTextureMultiviewOVR(target, attachment, texture.GetID(), mipLevel, baseViewIndex, numViews);
+}
+
+#endif // /GL_OVR_multiview
+
 void GLFramebuffer::AttachRenderbuffer(GLenum attachment, GLuint renderbufferID)
 {
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, renderbufferID);
@@ -85,6 +85,18 @@ class GLFramebuffer
             GLenum              target = GL_FRAMEBUFFER
         );
 
+        #ifdef GL_OVR_multiview
+        // Attaches the specified range of array layers of the texture as views for multiview rendering (GL_OVR_multiview2).
+        static void AttachTextureMultiview(
+            const GLTexture&    texture,
+            GLenum              attachment,
+            GLint               mipLevel,
+            GLint               baseViewIndex,
+            GLsizei             numViews,
+            GLenum              target = GL_FRAMEBUFFER
+        );
+        #endif
+
         static void AttachRenderbuffer(GLenum attachment, GLuint renderbufferID);
 
         static void Blit(GLint width, GLint height, GLenum mask);
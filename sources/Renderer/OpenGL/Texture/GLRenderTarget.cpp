@@ -10,6 +10,7 @@
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
 #include "../RenderState/GLStateManager.h"
+#include "../RenderState/GLRenderPass.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
@@ -24,10 +25,19 @@ namespace LLGL
 {
 
 
+// Returns the number of views of the render pass the render target is created with, or 0 if multiview is disabled.
+static std::uint32_t GetRenderPassNumViews(const RenderPass* renderPass)
+{
+    if (renderPass != nullptr)
+        return LLGL_CAST(const GLRenderPass*, renderPass)->GetNumViews();
+    return 0;
+}
+
 GLRenderTarget::GLRenderTarget(const RenderingLimits& limits, const RenderTargetDescriptor& desc) :
     resolution_  { static_cast<GLint>(desc.resolution.width), static_cast<GLint>(desc.resolution.height) },
     drawBuffers_ { SmallVector<GLenum, 2>(std::size_t(NumActiveColorAttachments(desc)))                  },
     samples_     { static_cast<GLint>(GetLimitedRenderTargetSamples(limits, desc))                       },
+    numViews_    { GetRenderPassNumViews(desc.renderPass)                                                },
     renderPass_  { desc.renderPass                                                                       }
 {
     framebuffer_.GenFramebuffer();
@@ -88,11 +98,16 @@ void GLRenderTarget::ResolveMultisampled(GLStateManager& stateMngr)
         stateMngr.BindFramebuffer(GLFramebufferTarget::DrawFramebuffer, framebufferResolve_.GetID());
         stateMngr.BindFramebuffer(GLFramebufferTarget::ReadFramebuffer, framebuffer_.GetID());
 
+        /* Only resolve the active extent, which starts at the upper-left corner, i.e. at the top of the GL framebuffer */
+        const Extent2D activeExtent = GetActiveExtent();
+        const Offset2D resolvePos0{ 0, resolution_[1] - static_cast<GLint>(activeExtent.height) };
+        const Offset2D resolvePos1{ static_cast<GLint>(activeExtent.width), resolution_[1] };
+
         for (GLenum buf : drawBuffersResolve_)
         {
             glReadBuffer(buf);
             GLProfile::DrawBuffer(buf);
-            GLFramebuffer::Blit(resolution_[0], resolution_[1], GL_COLOR_BUFFER_BIT);
+            GLFramebuffer::Blit(resolvePos0, resolvePos1, resolvePos0, resolvePos1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
         }
 
         stateMngr.BindFramebuffer(GLFramebufferTarget::ReadFramebuffer, 0);
@@ -148,6 +163,12 @@ static void GLThrowIfFramebufferStatusFailed(const char* info)
 
 void GLRenderTarget::CreateFramebufferWithAttachments(const RenderTargetDescriptor& desc)
 {
+    #ifdef GL_EXT_multisampled_render_to_texture
+    /* Let tile-based GPUs resolve multi-sampled attachments implicitly, so the multi-sampled content never has to be stored in memory */
+    if (CreateFramebufferWithImplicitResolve(desc))
+        return;
+    #endif
+
     const std::uint32_t numColorAttachments = GetNumColorAttachments();
 
     /* Bind primary FBO */
@@ -209,6 +230,79 @@ void GLRenderTarget::CreateFramebufferWithNoAttachments()
     GLThrowIfFramebufferStatusFailed("initializing default parameters for framebuffer object (FBO) failed");
 }
 
+#ifdef GL_EXT_multisampled_render_to_texture
+
+// Returns true if the specified render target can be created with GL_EXT_multisampled_render_to_texture, i.e. only with internal multi-sampled attachments and 2D resolve textures.
+static bool IsImplicitResolveCompatible(const RenderTargetDescriptor& desc, std::uint32_t numColorAttachments)
+{
+    if (NumActiveResolveAttachments(desc) == 0)
+        return false;
+
+    for_range(colorTarget, numColorAttachments)
+    {
+        if (desc.colorAttachments[colorTarget].texture != nullptr)
+            return false;
+        if (auto* resolveTexture = desc.resolveAttachments[colorTarget].texture)
+        {
+            auto* resolveTextureGL = LLGL_CAST(const GLTexture*, resolveTexture);
+            if (resolveTextureGL->IsRenderbuffer() || resolveTexture->GetType() != TextureType::Texture2D || desc.resolveAttachments[colorTarget].mipLevel != 0)
+                return false;
+        }
+    }
+
+    return (desc.depthStencilAttachment.texture == nullptr);
+}
+
+bool GLRenderTarget::CreateFramebufferWithImplicitResolve(const RenderTargetDescriptor& desc)
+{
+    const std::uint32_t numColorAttachments = GetNumColorAttachments();
+
+    if (!(samples_ > 1 && numViews_ == 0 && HasExtension(GLExt::EXT_multisampled_render_to_texture) && IsImplicitResolveCompatible(desc, numColorAttachments)))
+        return false;
+
+    /* Bind primary FBO; no secondary FBO is needed since the resolve textures are attached directly */
+    GLStateManager::Get().BindFramebuffer(GLFramebufferTarget::DrawFramebuffer, framebuffer_.GetID());
+    {
+        for_range(colorTarget, numColorAttachments)
+        {
+            const GLenum binding = AllocColorAttachmentBinding(colorTarget);
+            if (auto* resolveTexture = desc.resolveAttachments[colorTarget].texture)
+            {
+                auto* resolveTextureGL = LLGL_CAST(GLTexture*, resolveTexture);
+                glFramebufferTexture2DMultisampleEXT(GL_FRAMEBUFFER, binding, GL_TEXTURE_2D, resolveTextureGL->GetID(), 0, samples_);
+                implicitResolveMask_ |= (1u << colorTarget);
+            }
+            else
+                CreateAndAttachRenderbufferImplicitResolve(binding, GLTypes::Map(desc.colorAttachments[colorTarget].format));
+        }
+
+        if (IsAttachmentEnabled(desc.depthStencilAttachment))
+        {
+            const Format format = desc.depthStencilAttachment.format;
+            CreateAndAttachRenderbufferImplicitResolve(AllocDepthStencilAttachmentBinding(format), GLTypes::Map(format));
+        }
+
+        /* Finalize primary FBO by setting draw buffers and validate its status */
+        SetGLDrawBuffers(drawBuffers_);
+        GLThrowIfFramebufferStatusFailed("implicit multi-sample resolve attachments to framebuffer object (FBO) failed");
+    }
+
+    return true;
+}
+
+void GLRenderTarget::CreateAndAttachRenderbufferImplicitResolve(GLenum binding, GLenum internalFormat)
+{
+    GLRenderbuffer renderbuffer;
+    {
+        renderbuffer.GenRenderbuffer();
+        renderbuffer.BindAndAllocStorageImplicitResolve(internalFormat, resolution_[0], resolution_[1], samples_);
+        GLFramebuffer::AttachRenderbuffer(binding, renderbuffer.GetID());
+    }
+    renderbuffers_.push_back(std::move(renderbuffer));
+}
+
+#endif // /GL_EXT_multisampled_render_to_texture
+
 void GLRenderTarget::BuildColorAttachment(const AttachmentDescriptor& attachmentDesc, std::uint32_t colorTarget)
 {
     const GLenum binding = AllocColorAttachmentBinding(colorTarget);
@@ -242,11 +336,24 @@ void GLRenderTarget::BuildAttachmentWithTexture(GLenum binding, const Attachment
     ValidateMipResolution(*textureGL, mipLevel);
 
     /* Attach texture to framebuffer */
-    GLFramebuffer::AttachTexture(*textureGL, binding, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer));
+    #ifdef GL_OVR_multiview
+    if (numViews_ > 0)
+    {
+        /* Attach consecutive array layers as views, each starting at the base layer of the attachment */
+        GLFramebuffer::AttachTextureMultiview(
+            *textureGL, binding, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer), static_cast<GLsizei>(numViews_)
+        );
+    }
+    else
+    #endif // /GL_OVR_multiview
+    {
+        GLFramebuffer::AttachTexture(*textureGL, binding, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer));
+    }
 }
 
 void GLRenderTarget::BuildAttachmentWithRenderbuffer(GLenum binding, Format format)
 {
+    LLGL_ASSERT(numViews_ == 0, "multiview render-target attachments must refer to an array texture");
     CreateAndAttachRenderbuffer(binding, GLTypes::Map(format));
 }
 
@@ -56,11 +56,22 @@ class GLRenderTarget final : public RenderTarget
             return framebuffer_;
         }
 
+        // Returns the bitmask of color attachments that are resolved implicitly with GL_EXT_multisampled_render_to_texture.
+        inline std::uint32_t GetImplicitResolveMask() const
+        {
+            return implicitResolveMask_;
+        }
+
     private:
 
         void CreateFramebufferWithAttachments(const RenderTargetDescriptor& desc);
         void CreateFramebufferWithNoAttachments();
 
+        #ifdef GL_EXT_multisampled_render_to_texture
+        bool CreateFramebufferWithImplicitResolve(const RenderTargetDescriptor& desc);
+        void CreateAndAttachRenderbufferImplicitResolve(GLenum binding, GLenum internalFormat);
+        #endif
+
         void BuildColorAttachment(const AttachmentDescriptor& attachmentDesc, std::uint32_t colorTarget);
         void BuildResolveAttachment(const AttachmentDescriptor& attachmentDesc, std::uint32_t colorTarget);
         void BuildDepthStencilAttachment(const AttachmentDescriptor& attachmentDesc);
@@ -93,6 +104,8 @@ class GLRenderTarget final : public RenderTarget
 
         GLint                       samples_                = 1;
         GLenum                      depthStencilBinding_    = 0;        // Equivalent of drawBuffers but for depth-stencil
+        std::uint32_t               implicitResolveMask_    = 0;        // Bitmask of color attachments that don't need the resolve FBO
+        std::uint32_t               numViews_               = 0;        // Number of views for multiview rendering (GL_OVR_multiview2)
 
         const RenderPass*           renderPass_             = nullptr;
 
@@ -76,6 +76,16 @@ void GLRenderbuffer::BindAndAllocStorage(GLenum internalFormat, GLsizei width, G
     GLRenderbufferStorage(id_, internalFormat, width, height, samples);
 }
 
+#ifdef GL_EXT_multisampled_render_to_texture
+
+void GLRenderbuffer::BindAndAllocStorageImplicitResolve(GLenum internalFormat, GLsizei width, GLsizei height, GLsizei samples)
+{
+    GLStateManager::Get().BindRenderbuffer(id_);
+    glRenderbufferStorageMultisampleEXT(GL_RENDERBUFFER, samples, internalFormat, width, height);
+}
+
+#endif // /GL_EXT_multisampled_render_to_texture
+
 void GLRenderbuffer::AllocStorage(GLuint id, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei samples)
 {
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
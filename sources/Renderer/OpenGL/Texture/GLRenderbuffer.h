@@ -37,6 +37,11 @@ class GLRenderbuffer
         // Binds the renderbuffer and initialized its storage.
         void BindAndAllocStorage(GLenum internalFormat, GLsizei width, GLsizei height, GLsizei samples);
 
+        #ifdef GL_EXT_multisampled_render_to_texture
+        // Binds the renderbuffer and initializes its multi-sampled storage that is resolved implicitly (GL_EXT_multisampled_render_to_texture).
+        void BindAndAllocStorageImplicitResolve(GLenum internalFormat, GLsizei width, GLsizei height, GLsizei samples);
+        #endif
+
         // Returns the hardware buffer ID.
         inline GLuint GetID() const
         {
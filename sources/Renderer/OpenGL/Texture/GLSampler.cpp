@@ -9,26 +9,27 @@
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
 #include "../Ext/GLExtensions.h"
-#include "../RenderState/GLStateManager.h"
+#include "../RenderState/GLStatePool.h"
 
 
 namespace LLGL
 {
 
 
-GLSampler::GLSampler()
+GLSampler::GLSampler(const SamplerDescriptor& desc) :
+    id_   { GLStatePool::Get().CreateSampler(desc) },
+    desc_ { desc                                   }
 {
-    glGenSamplers(1, &id_);
 }
 
 GLSampler::~GLSampler()
 {
-    glDeleteSamplers(1, &id_);
-    GLStateManager::Get().NotifySamplerRelease(id_);
+    GLStatePool::Get().ReleaseSampler(desc_);
 }
 
 void GLSampler::SetName(const char* name)
 {
+    /* Label is shared with all samplers of the same descriptor */
     GLSetObjectLabel(GL_SAMPLER, GetID(), name);
 }
 
@@ -40,39 +41,39 @@ static GLenum GetGLSamplerMinFilter(const SamplerDescriptor& desc)
         return GLTypes::Map(desc.minFilter);
 }
 
-void GLSampler::SamplerParameters(const SamplerDescriptor& desc)
+void GLSampler::SamplerParameters(GLuint id, const SamplerDescriptor& desc)
 {
     /* Set texture coordinate wrap modes */
-    glSamplerParameteri(id_, GL_TEXTURE_WRAP_S, GLTypes::Map(desc.addressModeU));
-    glSamplerParameteri(id_, GL_TEXTURE_WRAP_T, GLTypes::Map(desc.addressModeV));
-    glSamplerParameteri(id_, GL_TEXTURE_WRAP_R, GLTypes::Map(desc.addressModeW));
+    glSamplerParameteri(id, GL_TEXTURE_WRAP_S, GLTypes::Map(desc.addressModeU));
+    glSamplerParameteri(id, GL_TEXTURE_WRAP_T, GLTypes::Map(desc.addressModeV));
+    glSamplerParameteri(id, GL_TEXTURE_WRAP_R, GLTypes::Map(desc.addressModeW));
 
     /* Set filter states */
-    glSamplerParameteri(id_, GL_TEXTURE_MIN_FILTER, GetGLSamplerMinFilter(desc));
-    glSamplerParameteri(id_, GL_TEXTURE_MAG_FILTER, GLTypes::Map(desc.magFilter));
+    glSamplerParameteri(id, GL_TEXTURE_MIN_FILTER, GetGLSamplerMinFilter(desc));
+    glSamplerParameteri(id, GL_TEXTURE_MAG_FILTER, GLTypes::Map(desc.magFilter));
     #ifdef LLGL_OPENGL
-    glSamplerParameterf(id_, GL_TEXTURE_MAX_ANISOTROPY_EXT, static_cast<float>(desc.maxAnisotropy));
+    glSamplerParameterf(id, GL_TEXTURE_MAX_ANISOTROPY_EXT, static_cast<float>(desc.maxAnisotropy));
     #endif
 
     /* Set MIP-map level selection */
-    glSamplerParameterf(id_, GL_TEXTURE_MIN_LOD, desc.minLOD);
-    glSamplerParameterf(id_, GL_TEXTURE_MAX_LOD, desc.maxLOD);
+    glSamplerParameterf(id, GL_TEXTURE_MIN_LOD, desc.minLOD);
+    glSamplerParameterf(id, GL_TEXTURE_MAX_LOD, desc.maxLOD);
     #ifdef LLGL_OPENGL
-    glSamplerParameterf(id_, GL_TEXTURE_LOD_BIAS, desc.mipMapLODBias);
+    glSamplerParameterf(id, GL_TEXTURE_LOD_BIAS, desc.mipMapLODBias);
     #endif
 
     /* Set compare operation */
     if (desc.compareEnabled)
     {
-        glSamplerParameteri(id_, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-        glSamplerParameteri(id_, GL_TEXTURE_COMPARE_FUNC, GLTypes::Map(desc.compareOp));
+        glSamplerParameteri(id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        glSamplerParameteri(id, GL_TEXTURE_COMPARE_FUNC, GLTypes::Map(desc.compareOp));
     }
     else
-        glSamplerParameteri(id_, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+        glSamplerParameteri(id, GL_TEXTURE_COMPARE_MODE, GL_NONE);
 
     /* Set border color */
     #ifdef LLGL_SAMPLER_BORDER_COLOR
-    glSamplerParameterfv(id_, GL_TEXTURE_BORDER_COLOR, desc.borderColor);
+    glSamplerParameterfv(id, GL_TEXTURE_BORDER_COLOR, desc.borderColor);
     #endif
 }
 
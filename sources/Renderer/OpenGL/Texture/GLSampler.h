@@ -27,21 +27,25 @@ class GLSampler final : public Sampler
 
     public:
 
-        GLSampler();
+        // Acquires a GL sampler with the specified parameters from the GLStatePool; identical descriptors share one GL sampler.
+        GLSampler(const SamplerDescriptor& desc);
         ~GLSampler();
 
-        // Sets the GL sampler parameters with the specified descriptor, i.e. glSamplerParameter*.
-        void SamplerParameters(const SamplerDescriptor& desc);
-
         // Returns the hardware sampler ID.
         inline GLuint GetID() const
         {
             return id_;
         }
 
+    public:
+
+        // Sets the GL sampler parameters with the specified descriptor, i.e. glSamplerParameter*.
+        static void SamplerParameters(GLuint id, const SamplerDescriptor& desc);
+
     private:
 
-        GLuint id_ = 0;
+        GLuint              id_     = 0;
+        SamplerDescriptor   desc_;
 
 };
 
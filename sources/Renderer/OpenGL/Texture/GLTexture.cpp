@@ -7,6 +7,7 @@
 
 #include "GLTexture.h"
 #include "GLTextureViewPool.h"
+#include "GLTextureHandlePool.h"
 #include "GLRenderbuffer.h"
 #include "GLReadTextureFBO.h"
 #include "GLMipGenerator.h"
@@ -21,9 +22,11 @@
 #include "../Texture/GLTexImage.h"
 #include "../Texture/GLTexSubImage.h"
 #include "../Texture/GLTextureSubImage.h"
+#include "../Buffer/GLStreamingBuffer.h"
 #include "../../TextureUtils.h"
 #include "../../../Core/Exception.h"
 #include <LLGL/Utils/ForRange.h>
+#include <string.h>
 
 
 namespace LLGL
@@ -128,6 +131,9 @@ GLTexture::~GLTexture()
     }
     else
     {
+        /* Make bindless handles non-resident before the texture is deleted */
+        GLTextureHandlePool::Get().NotifyTextureRelease(id_);
+
         /* Delete texture and notify state manager as well as texture-view pool since this could be the source for a texture-view */
         GLStateManager::Get().DeleteTexture(id_, GLStateManager::GetTextureTarget(GetType()));
         GLTextureViewPool::Get().NotifyTextureRelease(id_);
@@ -286,6 +292,12 @@ SubresourceFootprint GLTexture::GetSubresourceFootprint(std::uint32_t mipLevel)
     return CalcPackedSubresourceFootprint(desc.type, desc.format, desc.extent, mipLevel, desc.arrayLayers);
 }
 
+Extent3D GLTexture::GetSparseTileExtent() const
+{
+    /* Sparse textures are not supported by this backend */
+    return {};
+}
+
 static GLint GetGlTextureMinFilter(const TextureDescriptor& textureDesc)
 {
     if (IsMipMappedTexture(textureDesc))
@@ -682,6 +694,37 @@ void GLTexture::TextureSubImage(const TextureRegion& region, const SrcImageDescr
     }
 }
 
+void GLTexture::TextureSubImageStreamed(const TextureRegion& region, const SrcImageDescriptor& imageDesc)
+{
+    const GLsizeiptr dataSize = static_cast<GLsizeiptr>(imageDesc.dataSize);
+    GLStreamingBuffer& unpackBuffer = GLStreamingBuffer::GetPixelUnpack();
+    if (!IsRenderbuffer() && imageDesc.data != nullptr && dataSize > 0 && unpackBuffer.IsAvailable(dataSize))
+    {
+        /* Don't wait for a segment that is still read by the GPU; the direct upload below doesn't stall on the streaming buffer */
+        GLintptr srcOffset = 0;
+        if (void* dst = unpackBuffer.Alloc(dataSize, srcOffset, 1, false))
+        {
+            ::memcpy(dst, imageDesc.data, imageDesc.dataSize);
+
+            /* Read image data from the streaming buffer with byte offset */
+            SrcImageDescriptor unpackImageDesc = imageDesc;
+            unpackImageDesc.data = reinterpret_cast<const void*>(srcOffset);
+
+            GLStateManager::Get().BindBuffer(GLBufferTarget::PixelUnpackBuffer, unpackBuffer.GetID());
+            {
+                TextureSubImage(region, unpackImageDesc, false);
+            }
+            GLStateManager::Get().BindBuffer(GLBufferTarget::PixelUnpackBuffer, 0);
+
+            unpackBuffer.Complete(srcOffset);
+            return;
+        }
+    }
+
+    /* Upload directly from client memory if streaming is unavailable or would stall */
+    TextureSubImage(region, imageDesc, false);
+}
+
 #ifdef GL_ARB_get_texture_sub_image
 
 static void GLGetTextureSubImage(
@@ -83,6 +83,14 @@ class GLTexture final : public Texture
         // Writes the specified image data to a subregion of this texture.
         void TextureSubImage(const TextureRegion& region, const SrcImageDescriptor& imageDesc, bool restoreBoundTexture = true);
 
+        /*
+        Writes the specified image data from client memory to a subregion of this texture via the pixel unpack streaming buffer.
+        This returns after the data has been copied into the streaming buffer, so the upload does not stall on textures that are in use by the GPU.
+        Falls back to TextureSubImage() if the image data does not fit into a segment of the streaming buffer,
+        or if the next segment is still read by the GPU, since waiting for it would stall just like the direct upload.
+        */
+        void TextureSubImageStreamed(const TextureRegion& region, const SrcImageDescriptor& imageDesc);
+
         // Reads the specified image data from a subregion of this texture.
         void GetTextureSubImage(const TextureRegion& region, const DstImageDescriptor& imageDesc, bool restoreBoundTexture = true);
 
@@ -0,0 +1,173 @@
+/*
+ * GLTextureHandlePool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GLTextureHandlePool.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/CoreUtils.h"
+#include "../../../Core/MacroUtils.h"
+
+
+namespace LLGL
+{
+
+
+GLTextureHandlePool::~GLTextureHandlePool()
+{
+    Clear();
+}
+
+GLTextureHandlePool& GLTextureHandlePool::Get()
+{
+    static GLTextureHandlePool instance;
+    return instance;
+}
+
+void GLTextureHandlePool::Clear()
+{
+    for (const GLTextureHandle& entry : handles_)
+        MakeHandleNonResident(entry);
+    handles_.clear();
+}
+
+GLuint64 GLTextureHandlePool::AcquireTextureHandle(GLuint texID, GLuint samplerID, std::uint64_t& outGeneration)
+{
+    outGeneration = 0;
+
+    #ifdef LLGL_GLEXT_BINDLESS_TEXTURE
+
+    if (!HasExtension(GLExt::ARB_bindless_texture))
+        return 0;
+
+    /* Try to find resident handle for this texture/sampler pair */
+    std::size_t insertionIndex = 0;
+    GLTextureHandle* sharedHandle = FindInSortedArray<GLTextureHandle>(
+        handles_.data(),
+        handles_.size(),
+        [texID, samplerID](const GLTextureHandle& rhs)
+        {
+            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(texID, rhs.texID);
+            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(samplerID, rhs.samplerID);
+            return 0;
+        },
+        &insertionIndex
+    );
+
+    if (sharedHandle != nullptr)
+    {
+        sharedHandle->refCount++;
+        outGeneration = sharedHandle->generation;
+        return sharedHandle->handle;
+    }
+
+    /* Create new handle and make it resident; this makes the texture and sampler state immutable */
+    GLTextureHandle entry;
+    {
+        entry.texID     = texID;
+        entry.samplerID = samplerID;
+        entry.handle    = (samplerID != 0 ? glGetTextureSamplerHandleARB(texID, samplerID) : glGetTextureHandleARB(texID));
+        entry.refCount  = 1;
+    }
+
+    if (entry.handle == 0)
+        return 0;
+
+    entry.generation = nextGeneration_++;
+    outGeneration = entry.generation;
+
+    glMakeTextureHandleResidentARB(entry.handle);
+    handles_.insert(handles_.begin() + insertionIndex, entry);
+
+    return entry.handle;
+
+    #else
+
+    (void)texID;
+    (void)samplerID;
+    return 0;
+
+    #endif // /LLGL_GLEXT_BINDLESS_TEXTURE
+}
+
+void GLTextureHandlePool::ReleaseTextureHandle(GLuint texID, GLuint samplerID, std::uint64_t generation)
+{
+    std::size_t index = 0;
+    GLTextureHandle* sharedHandle = FindInSortedArray<GLTextureHandle>(
+        handles_.data(),
+        handles_.size(),
+        [texID, samplerID](const GLTextureHandle& rhs)
+        {
+            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(texID, rhs.texID);
+            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(samplerID, rhs.samplerID);
+            return 0;
+        },
+        &index
+    );
+
+    /* Ignore references to an invalidated entry whose texture or sampler name has been reused */
+    if (sharedHandle != nullptr && sharedHandle->generation == generation && --sharedHandle->refCount == 0)
+    {
+        MakeHandleNonResident(*sharedHandle);
+        handles_.erase(handles_.begin() + index);
+    }
+}
+
+void GLTextureHandlePool::NotifyTextureRelease(GLuint texID)
+{
+    RemoveAllFromListIf(
+        handles_,
+        [texID](const GLTextureHandle& entry) -> bool
+        {
+            if (entry.texID == texID)
+            {
+                GLTextureHandlePool::MakeHandleNonResident(entry);
+                return true;
+            }
+            return false;
+        }
+    );
+}
+
+void GLTextureHandlePool::NotifySamplerRelease(GLuint samplerID)
+{
+    if (samplerID == 0)
+        return;
+
+    RemoveAllFromListIf(
+        handles_,
+        [samplerID](const GLTextureHandle& entry) -> bool
+        {
+            if (entry.samplerID == samplerID)
+            {
+                GLTextureHandlePool::MakeHandleNonResident(entry);
+                return true;
+            }
+            return false;
+        }
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLTextureHandlePool::MakeHandleNonResident(const GLTextureHandle& entry)
+{
+    #ifdef LLGL_GLEXT_BINDLESS_TEXTURE
+    glMakeTextureHandleNonResidentARB(entry.handle);
+    #else
+    (void)entry;
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,102 @@
+/*
+ * GLTextureHandlePool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GL_TEXTURE_HANDLE_POOL_H
+#define LLGL_GL_TEXTURE_HANDLE_POOL_H
+
+
+#include "../OpenGL.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Class to manage the residency of bindless texture handles (GL_ARB_bindless_texture); used by <GLResourceHeap>.
+Each texture/sampler pair has a single handle that is resident as long as it is referenced at least once.
+Handles are made non-resident before their texture or sampler is deleted.
+Each handle entry has a unique generation, so references to an entry that has been invalidated this way
+don't affect a new entry if GL reuses the texture or sampler name.
+*/
+class GLTextureHandlePool
+{
+
+    public:
+
+        // Returns the instance of this singleton.
+        static GLTextureHandlePool& Get();
+
+    public:
+
+        GLTextureHandlePool(const GLTextureHandlePool&) = delete;
+        GLTextureHandlePool& operator = (const GLTextureHandlePool&) = delete;
+
+        GLTextureHandlePool(GLTextureHandlePool&&) = delete;
+        GLTextureHandlePool& operator = (GLTextureHandlePool&&) = delete;
+
+        ~GLTextureHandlePool();
+
+        // Makes all handles non-resident and clears the container.
+        void Clear();
+
+        /*
+        Returns the resident handle for the specified texture and optional sampler and increments its reference counter,
+        or 0 if the extension "GL_ARB_bindless_texture" is not supported.
+        The generation of the handle entry is written to 'outGeneration' and must be passed to ReleaseTextureHandle(); 0 if no handle was returned.
+        */
+        GLuint64 AcquireTextureHandle(GLuint texID, GLuint samplerID, std::uint64_t& outGeneration);
+
+        /*
+        Decrements the reference counter of the handle for the specified texture/sampler pair and makes it non-resident once it reaches zero.
+        This has no effect if the entry of the specified generation has already been invalidated by NotifyTextureRelease() or NotifySamplerRelease().
+        */
+        void ReleaseTextureHandle(GLuint texID, GLuint samplerID, std::uint64_t generation);
+
+        // Notifies the handle pool that the specified texture is about to be deleted. This makes all its handles non-resident.
+        void NotifyTextureRelease(GLuint texID);
+
+        // Notifies the handle pool that the specified sampler is about to be deleted. This makes all its handles non-resident.
+        void NotifySamplerRelease(GLuint samplerID);
+
+    private:
+
+        GLTextureHandlePool() = default;
+
+    private:
+
+        // Resident handle for a texture/sampler pair; sorted by texture and sampler ID.
+        struct GLTextureHandle
+        {
+            GLuint          texID       = 0;
+            GLuint          samplerID   = 0;
+            GLuint64        handle      = 0;
+            GLuint          refCount    = 0;
+            std::uint64_t   generation  = 0;
+        };
+
+        // Makes the specified handle non-resident.
+        static void MakeHandleNonResident(const GLTextureHandle& entry);
+
+    private:
+
+        std::vector<GLTextureHandle>    handles_;
+        std::uint64_t                   nextGeneration_ = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,7 @@
 
 #include "GLTextureViewPool.h"
 #include "GLTexture.h"
+#include "GLTextureHandlePool.h"
 #include "../RenderState/GLStateManager.h"
 #include "../GLProfile.h"
 #include "../GLTypes.h"
@@ -14,7 +15,6 @@
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/CoreUtils.h"
-#include "../../../Core/MacroUtils.h"
 #include <algorithm>
 
 
@@ -22,7 +22,8 @@ namespace LLGL
 {
 
 
-static constexpr std::size_t g_maxNumReusableTextureViews = 16;
+// Maximum number of dead texture views that are kept for recycling per source texture.
+static constexpr std::size_t g_maxNumDeadTextureViewsPerSource = 4;
 
 GLTextureViewPool::~GLTextureViewPool()
 {
@@ -37,120 +38,15 @@ GLTextureViewPool& GLTextureViewPool::Get()
 
 void GLTextureViewPool::Clear()
 {
-    /* Delete all texture view GL objects and clear container */
-    for (const auto& texView : textureViews_)
-    {
-        if (texView.texID != 0)
-            glDeleteTextures(1, &(texView.texID));
-    }
-    textureViews_.clear();
-    numReusableEntries_ = 0;
-}
-
-GLuint GLTextureViewPool::CreateTextureView(GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc, bool restoreBoundTexture)
-{
-    #ifdef GL_ARB_texture_view
-
-    if (!HasExtension(GLExt::ARB_texture_view))
-        return 0;
-
-    /* Compress texture view descriptor for faster comparison and sorting */
-    GLTextureView texView;
-    {
-        texView.sourceTexID = sourceTexID;
-    }
-    CompressTextureViewDesc(texView.view, textureViewDesc);
-
-    /* Try to find texture view with same parameters */
-    std::size_t insertionIndex = 0;
-    auto* sharedTexView = FindInSortedArray<GLTextureView>(
-        textureViews_.data(),
-        textureViews_.size(),
-        [&texView](const GLTextureView& rhs)
-        {
-            return GLTextureViewPool::CompareTextureViewSWO(texView, rhs);
-        },
-        &insertionIndex
-    );
-
-    if (sharedTexView != nullptr)
-    {
-        /* Create a shared GL texture view from the descriptor */
-        return CreateGLTextureView(*sharedTexView, textureViewDesc, true, restoreBoundTexture);
-    }
-    else
-    {
-        /* Create new GL texture view and store it with insertion sort */
-        GLuint texID = CreateGLTextureView(texView, textureViewDesc, false, restoreBoundTexture);
-        textureViews_.insert(textureViews_.begin() + insertionIndex, texView);
-        return texID;
-    }
-
-    #else
-
-    return 0;
-
-    #endif
-}
+    std::lock_guard<std::mutex> guard{ mutex_ };
 
-void GLTextureViewPool::ReleaseTextureView(GLuint texID)
-{
-    /* Try to find texture by GL texture ID only */
-    std::size_t insertionIndex = 0;
-    GLTextureView* sharedTexView = FindInSortedArray<GLTextureView>(
-        textureViews_.data(),
-        textureViews_.size(),
-        [texID](const GLTextureView& rhs)
-        {
-            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(texID, rhs.texID);
-            return 0;
-        },
-        &insertionIndex
-    );
-
-    if (sharedTexView != nullptr)
-    {
-        /* Delete GL texture view if the reference counter reaches 0 */
-        ReleaseSharedGLTextureView(*sharedTexView);
-
-        /* Remove unused entries in the array after a given amount has been freed */
-        if (numReusableEntries_ > g_maxNumReusableTextureViews)
-            FlushReusableTextureViews();
-    }
-}
-
-void GLTextureViewPool::NotifyTextureRelease(GLuint sourceTexID)
-{
-    /* Move all objects that are about to be removed at the end of the list using 'std::remove' */
-    auto it = std::remove_if(
-        textureViews_.begin(),
-        textureViews_.end(),
-        [sourceTexID](const GLTextureView& entry)
-        {
-            return (entry.texID == 0 || entry.sourceTexID == sourceTexID);
-        }
-    );
-
-    /* Iterate over all elements to be deleted */
-    for (; it != textureViews_.end(); ++it)
-        DeleteGLTextureView(*it);
-
-    /* Finally remove the entries from the list */
-    textureViews_.erase(it, textureViews_.end());
+    /* Delete all texture view GL objects and clear containers */
+    for (const auto& entry : textureViewKeys_)
+        glDeleteTextures(1, &(entry.first));
 
-    /* Reset reusable entries, since we just deleted all unused entries */
-    numReusableEntries_ = 0;
-}
-
-
-/*
- * ======= Private: =======
- */
-
-int GLTextureViewPool::CompareTextureViewSWO(const GLTextureView& lhs, const GLTextureView& rhs)
-{
-    LLGL_COMPARE_MEMBER_SWO( sourceTexID );
-    return CompareCompressedTexViewSWO(lhs.view, rhs.view);
+    textureViews_.clear();
+    textureViewKeys_.clear();
+    sourceTextures_.clear();
 }
 
 #ifdef GL_ARB_texture_view
@@ -161,14 +57,10 @@ static void InitializeTextureViewSwizzle(GLuint texID, const GLTextureTarget tar
     GLTexture::TexParameterSwizzle(textureViewDesc.type, textureViewDesc.format, textureViewDesc.swizzle);
 }
 
-#endif // /GL_ARB_texture_view
-
 static GLuint GenGLTextureView(GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc, bool restoreBoundTexture)
 {
     GLuint texID = 0;
 
-    #ifdef GL_ARB_texture_view
-
     if (HasExtension(GLExt::ARB_texture_view))
     {
         /* Generate and initialize texture with texture-view description */
@@ -202,82 +94,146 @@ static GLuint GenGLTextureView(GLuint sourceTexID, const TextureViewDescriptor&
         }
     }
 
-    #endif // /GL_ARB_texture_view
-
     return texID;
 }
 
-GLuint GLTextureViewPool::CreateGLTextureView(GLTextureView& texView, const TextureViewDescriptor& textureViewDesc, bool isSharedTex, bool restoreBoundTexture)
+#endif // /GL_ARB_texture_view
+
+GLuint GLTextureViewPool::CreateTextureView(GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc, bool restoreBoundTexture)
 {
-    if (isSharedTex)
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    #ifdef GL_ARB_texture_view
+
+    if (!HasExtension(GLExt::ARB_texture_view))
+        return 0;
+
+    /* Compress texture view descriptor for faster hashing and comparison */
+    GLTextureViewKey key;
     {
-        if (texView.texID == 0)
-        {
-            /* Create new GL texture view if ID is invalid */
-            GLuint texID = GenGLTextureView(texView.sourceTexID, textureViewDesc, restoreBoundTexture);
-            RetainSharedGLTextureView(texView, texID);
-        }
+        key.sourceTexID = sourceTexID;
     }
-    else
+    CompressTextureViewDesc(key.view, textureViewDesc);
+
+    /* Try to find texture view with same parameters */
+    auto it = textureViews_.find(key);
+    if (it != textureViews_.end())
     {
-        /* Create a new GL texture view and initialize reference counter */
-        texView.texID = GenGLTextureView(texView.sourceTexID, textureViewDesc, restoreBoundTexture);
+        /* Recycle dead texture view or share an alive one */
+        GLTextureView& texView = it->second;
+        if (texView.refCount == 0)
+            --sourceTextures_[sourceTexID].numDeadViews;
+        ++texView.refCount;
+        return texView.texID;
     }
 
-    /* Increment reference counter for the shared texture view */
-    texView.refCount++;
+    /* Create new GL texture view */
+    GLTextureView texView;
+    {
+        texView.texID       = GenGLTextureView(sourceTexID, textureViewDesc, restoreBoundTexture);
+        texView.refCount    = 1;
+    }
+    textureViews_[key]              = texView;
+    textureViewKeys_[texView.texID] = key;
+    sourceTextures_[sourceTexID].views.push_back(texView.texID);
 
     return texView.texID;
-}
 
-// Uncompresses the specified 4-bit texture type to a 'GLTextureTarget' enum entry.
-static GLTextureTarget UncompressGLTextureTarget(std::uint32_t type)
-{
-    return GLStateManager::GetTextureTarget(static_cast<TextureType>(type));
+    #else
+
+    return 0;
+
+    #endif
 }
 
-void GLTextureViewPool::DeleteGLTextureView(GLTextureView& texView)
+void GLTextureViewPool::ReleaseTextureView(GLuint texID)
 {
-    GLStateManager::Get().DeleteTexture(texView.texID, UncompressGLTextureTarget(texView.view.type));
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Find texture view by its GL texture ID */
+    auto keyIt = textureViewKeys_.find(texID);
+    if (keyIt == textureViewKeys_.end())
+        return;
+
+    auto it = textureViews_.find(keyIt->second);
+    if (it != textureViews_.end() && it->second.refCount > 0)
+    {
+        if (--(it->second.refCount) == 0)
+        {
+            /* Keep dead texture view for recycling, but limit their number per source texture */
+            GLSourceTexture& sourceTexture = sourceTextures_[keyIt->second.sourceTexID];
+            if (++sourceTexture.numDeadViews > g_maxNumDeadTextureViewsPerSource)
+                DeleteDeadTextureViews(sourceTexture);
+        }
+    }
 }
 
-void GLTextureViewPool::RetainSharedGLTextureView(GLTextureView& texView, GLuint texID)
+void GLTextureViewPool::NotifyTextureRelease(GLuint sourceTexID)
 {
-    if (texView.texID == 0)
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Delete all texture views that were derived from the released texture */
+    auto it = sourceTextures_.find(sourceTexID);
+    if (it != sourceTextures_.end())
     {
-        /* If this is shared texture view, reclaim one of the reusable entries */
-        texView.texID = texID;
-        if (numReusableEntries_ > 0)
-            --numReusableEntries_;
+        for (GLuint texID : it->second.views)
+            DeleteTextureViewEntry(texID);
+        sourceTextures_.erase(it);
     }
 }
 
-void GLTextureViewPool::ReleaseSharedGLTextureView(GLTextureView& texView)
+
+/*
+ * ======= Private: =======
+ */
+
+std::size_t GLTextureViewPool::GLTextureViewKeyHash::operator () (const GLTextureViewKey& key) const
 {
-    if (texView.refCount > 0)
+    const std::uint32_t values[] = { key.sourceTexID, key.view.base, key.view.firstMip, key.view.numLayers, key.view.firstLayer };
+    return static_cast<std::size_t>(HashFNV1a(values, sizeof(values)));
+}
+
+bool GLTextureViewPool::GLTextureViewKeyEqual::operator () (const GLTextureViewKey& lhs, const GLTextureViewKey& rhs) const
+{
+    return (lhs.sourceTexID == rhs.sourceTexID && CompareCompressedTexViewSWO(lhs.view, rhs.view) == 0);
+}
+
+// Uncompresses the specified 4-bit texture type to a 'GLTextureTarget' enum entry.
+static GLTextureTarget UncompressGLTextureTarget(std::uint32_t type)
+{
+    return GLStateManager::GetTextureTarget(static_cast<TextureType>(type));
+}
+
+void GLTextureViewPool::DeleteTextureViewEntry(GLuint texID)
+{
+    auto keyIt = textureViewKeys_.find(texID);
+    if (keyIt != textureViewKeys_.end())
     {
-        texView.refCount--;
-        if (texView.refCount == 0)
-        {
-            DeleteGLTextureView(texView);
-            ++numReusableEntries_;
-        }
+        GLTextureHandlePool::Get().NotifyTextureRelease(texID);
+        GLStateManager::Get().DeleteTexture(texID, UncompressGLTextureTarget(keyIt->second.view.type));
+        textureViews_.erase(keyIt->second);
+        textureViewKeys_.erase(keyIt);
     }
 }
 
-void GLTextureViewPool::FlushReusableTextureViews()
+void GLTextureViewPool::DeleteDeadTextureViews(GLSourceTexture& sourceTexture)
 {
-    if (numReusableEntries_ > 0)
+    auto IsDeadTextureView = [this](GLuint texID) -> bool
     {
-        RemoveAllFromListIf(
-            textureViews_,
-            [](const GLTextureView& entry)
-            {
-                return (entry.texID == 0);
-            }
-        );
-        numReusableEntries_ = 0;
-    }
+        auto keyIt = textureViewKeys_.find(texID);
+        if (keyIt == textureViewKeys_.end())
+            return true;
+        auto it = textureViews_.find(keyIt->second);
+        return (it == textureViews_.end() || it->second.refCount == 0);
+    };
+
+    /* Move dead texture views to the end of the list, delete them, and remove them from the list */
+    auto first = std::partition(sourceTexture.views.begin(), sourceTexture.views.end(), [&IsDeadTextureView](GLuint texID) { return !IsDeadTextureView(texID); });
+    for (auto it = first; it != sourceTexture.views.end(); ++it)
+        DeleteTextureViewEntry(*it);
+
+    sourceTexture.views.erase(first, sourceTexture.views.end());
+    sourceTexture.numDeadViews = 0;
 }
 
 
@@ -12,6 +12,8 @@
 #include <LLGL/TextureFlags.h>
 #include <cstdint>
 #include <vector>
+#include <unordered_map>
+#include <mutex>
 #include "../OpenGL.h"
 #include "../../TextureUtils.h"
 
@@ -20,7 +22,7 @@ namespace LLGL
 {
 
 
-// Class to manage create/reuse/delete of GL texture views; used by <GLResourceHeap>
+// Class to manage create/reuse/delete of GL texture views; used by <GLResourceHeap>. All public functions are synchronized.
 class GLTextureViewPool
 {
 
@@ -53,7 +55,7 @@ class GLTextureViewPool
 
         /*
         Notifes the texture view pool that the specified source texture was released.
-        Tthis will also release all texture views derived from the specified texture.
+        This will also release all texture views derived from the specified texture with complexity O(views of that texture).
         */
         void NotifyTextureRelease(GLuint sourceTexID);
 
@@ -63,40 +65,55 @@ class GLTextureViewPool
 
     private:
 
-        // Structure that stores a GL texture that was generated with 'glTextureView'; managed by <GLTextureViewPool>
-        struct GLTextureView
+        // Key of a texture view: source texture and compressed view descriptor.
+        struct GLTextureViewKey
         {
-            GLuint              texID        = 0;
-            GLuint              sourceTexID  = 0;
-            GLuint              refCount     = 0;
+            GLuint              sourceTexID = 0;
             CompressedTexView   view;
         };
 
-        // Compares the two texture views in a strict-weak-order (SWO).
-        static int CompareTextureViewSWO(const GLTextureView& lhs, const GLTextureView& rhs);
+        struct GLTextureViewKeyHash
+        {
+            std::size_t operator () (const GLTextureViewKey& key) const;
+        };
 
-        // Creats a new GL texture view and stores it in the specified view entry.
-        GLuint CreateGLTextureView(GLTextureView& texView, const TextureViewDescriptor& textureViewDesc, bool isSharedTex, bool restoreBoundTexture);
+        struct GLTextureViewKeyEqual
+        {
+            bool operator () (const GLTextureViewKey& lhs, const GLTextureViewKey& rhs) const;
+        };
 
-        // Deletes the specified GL texture view.
-        void DeleteGLTextureView(GLTextureView& texView);
+        // Structure that stores a GL texture that was generated with 'glTextureView'; managed by <GLTextureViewPool>
+        struct GLTextureView
+        {
+            GLuint texID    = 0;
+            GLuint refCount = 0; // Views with a reference count of zero are dead and can be recycled.
+        };
 
-        // Assignes the specified texture view a new GL texture ID and reclaims it as a reusable entry.
-        void RetainSharedGLTextureView(GLTextureView& texView, GLuint texID);
+        // All texture views that were derived from the same source texture.
+        struct GLSourceTexture
+        {
+            std::vector<GLuint> views;
+            std::size_t         numDeadViews = 0;
+        };
 
-        // Release the specified GL texture object and marks the entry as reusable.
-        void ReleaseSharedGLTextureView(GLTextureView& texView);
+        // Deletes the specified GL texture view and removes it from the hash maps, but not from its source texture entry.
+        void DeleteTextureViewEntry(GLuint texID);
 
-        // Removes all empty entries from the texture view list.
-        void FlushReusableTextureViews();
+        // Deletes all dead texture views of the specified source texture.
+        void DeleteDeadTextureViews(GLSourceTexture& sourceTexture);
 
     private:
 
-        // Container of all managed texture views.
-        std::vector<GLTextureView>  textureViews_;
+        // Texture views by source texture and view descriptor.
+        std::unordered_map<GLTextureViewKey, GLTextureView, GLTextureViewKeyHash, GLTextureViewKeyEqual> textureViews_;
+
+        // Keys of all texture views by their GL texture ID.
+        std::unordered_map<GLuint, GLTextureViewKey>    textureViewKeys_;
+
+        // Texture views (alive and dead) by their source texture ID.
+        std::unordered_map<GLuint, GLSourceTexture>     sourceTextures_;
 
-        // Number of textures that are already freed, but not removed from the texture view array yet.
-        std::size_t                 numReusableEntries_ = 0;
+        std::mutex                                      mutex_;
 
 };
 
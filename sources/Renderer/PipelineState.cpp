@@ -0,0 +1,30 @@
+/*
+ * PipelineState.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/PipelineState.h>
+
+
+namespace LLGL
+{
+
+
+bool PipelineState::IsReady() const
+{
+    return true;
+}
+
+void PipelineState::Wait()
+{
+    // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -8,6 +8,7 @@
 #include "RenderPassUtils.h"
 #include <LLGL/Utils/ForRange.h>
 #include "../Core/Assertion.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -61,6 +62,22 @@ LLGL_EXPORT std::uint32_t FillClearColorAttachmentIndices(
     return numColorAttachmentsToClear;
 }
 
+LLGL_EXPORT std::uint32_t NumMultiviewViews(std::uint32_t viewMask)
+{
+    std::uint32_t n = 0;
+    for (; viewMask != 0; viewMask &= (viewMask - 1))
+        ++n;
+    return n;
+}
+
+LLGL_EXPORT std::uint32_t NumMultiviewArrayLayers(std::uint32_t viewMask)
+{
+    std::uint32_t n = 0;
+    for (; viewMask != 0; viewMask >>= 1)
+        ++n;
+    return std::max(1u, n);
+}
+
 
 } // /namespace LLGL
 
@@ -37,6 +37,12 @@ LLGL_EXPORT std::uint32_t FillClearColorAttachmentIndices(
     const RenderPassDescriptor& renderPassDesc
 );
 
+// Returns the number of views in the specified multiview mask, i.e. the number of bits that are set.
+LLGL_EXPORT std::uint32_t NumMultiviewViews(std::uint32_t viewMask);
+
+// Returns the number of array layers that are covered by the specified multiview mask, i.e. the index of the highest bit plus one. Returns 1 if the mask is 0.
+LLGL_EXPORT std::uint32_t NumMultiviewArrayLayers(std::uint32_t viewMask);
+
 
 } // /namespace LLGL
 
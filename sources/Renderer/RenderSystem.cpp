@@ -336,6 +336,18 @@ Report& RenderSystem::GetMutableReport()
 void RenderSystem::SetRendererInfo(const RendererInfo& info)
 {
     pimpl_->info = info;
+
+    /* Report at least the adapter the render system has been created with, if the backend can't enumerate them */
+    if (pimpl_->info.videoAdapters.empty())
+    {
+        VideoAdapterDescriptor videoAdapterDesc;
+        {
+            videoAdapterDesc.name   = ToUTF16String(info.deviceName);
+            videoAdapterDesc.vendor = info.vendorName;
+        }
+        pimpl_->info.videoAdapters.push_back(std::move(videoAdapterDesc));
+        pimpl_->info.adapterIndex = 0;
+    }
 }
 
 void RenderSystem::SetRenderingCaps(const RenderingCapabilities& caps)
@@ -389,6 +401,25 @@ void RenderSystem::AssertCreateBufferArray(std::uint32_t numBuffers, Buffer* con
     AssertCreateResourceArrayCommon(numBuffers, reinterpret_cast<void* const*>(bufferArray), "buffer");
 }
 
+static void AssertCreateResourceBatchCommon(std::uint32_t numResources, const void* descs, const void* outResources, const char* resourceName)
+{
+    if (numResources > 0)
+    {
+        LLGL_ASSERT(!(descs == nullptr), "cannot create %u %s(s) with null pointer for descriptor array", numResources, resourceName);
+        LLGL_ASSERT(!(outResources == nullptr), "cannot create %u %s(s) with null pointer for output array", numResources, resourceName);
+    }
+}
+
+void RenderSystem::AssertCreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, Buffer* const * outBuffers)
+{
+    AssertCreateResourceBatchCommon(numBuffers, bufferDescs, outBuffers, "buffer");
+}
+
+void RenderSystem::AssertCreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, Texture* const * outTextures)
+{
+    AssertCreateResourceBatchCommon(numTextures, textureDescs, outTextures, "texture");
+}
+
 void RenderSystem::AssertCreateShader(const ShaderDescriptor& shaderDesc)
 {
     LLGL_ASSERT(
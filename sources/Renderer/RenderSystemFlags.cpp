@@ -95,12 +95,26 @@ LLGL_EXPORT bool ValidateRenderingCaps(
     LLGL_VALIDATE_FEATURE( hasInstancing,                "hardware instancing"         );
     LLGL_VALIDATE_FEATURE( hasOffsetInstancing,          "offset instancing"           );
     LLGL_VALIDATE_FEATURE( hasIndirectDrawing,           "indirect drawing"            );
+    LLGL_VALIDATE_FEATURE( hasIndirectCountDrawing,      "indirect count drawing"      );
     LLGL_VALIDATE_FEATURE( hasViewportArrays,            "viewport arrays"             );
     LLGL_VALIDATE_FEATURE( hasConservativeRasterization, "conservative rasterization"  );
     LLGL_VALIDATE_FEATURE( hasStreamOutputs,             "stream outputs"              );
     LLGL_VALIDATE_FEATURE( hasLogicOp,                   "logic fragment operations"   );
     LLGL_VALIDATE_FEATURE( hasPipelineStatistics,        "query pipeline statistics"   );
     LLGL_VALIDATE_FEATURE( hasRenderCondition,           "conditional rendering"       );
+    LLGL_VALIDATE_FEATURE( hasBindlessResources,         "bindless resources"          );
+    LLGL_VALIDATE_FEATURE( hasSparseResources,           "sparse resources"            );
+    LLGL_VALIDATE_FEATURE( hasThreadSafeResourceCreation, "thread-safe resource creation" );
+    LLGL_VALIDATE_FEATURE( hasVariableRateShading,       "variable rate shading"       );
+    LLGL_VALIDATE_FEATURE( hasShadingRateImage,          "shading-rate images"         );
+    LLGL_VALIDATE_FEATURE( hasMeshShaders,               "mesh shaders"                );
+    LLGL_VALIDATE_FEATURE( hasTextureCompression,        "GPU texture compression"     );
+    LLGL_VALIDATE_FEATURE( hasSubgroupSizeControl,       "subgroup size control"       );
+    LLGL_VALIDATE_FEATURE( hasNativeIOQueue,             "native IO queue"             );
+    LLGL_VALIDATE_FEATURE( hasMultiview,                 "multiview rendering"         );
+    LLGL_VALIDATE_FEATURE( hasRayTracing,                "ray tracing"                 );
+    LLGL_VALIDATE_FEATURE( hasIndirectArgumentCompaction, "indirect argument compaction" );
+    LLGL_VALIDATE_FEATURE( hasBufferDeviceAddress,       "buffer device addresses"     );
 
     #undef LLGL_VALIDATE_FEATURE
 
@@ -167,6 +181,7 @@ LLGL_EXPORT bool ValidateRenderingCaps(
     LLGL_VALIDATE_LIMIT( maxConstantBufferSize,             "constant buffer size"                      );
     LLGL_VALIDATE_LIMIT( maxStreamOutputs,                  "stream outputs"                            );
     LLGL_VALIDATE_LIMIT( maxTessFactor,                     "tessellation factor"                       );
+    LLGL_VALIDATE_LIMIT( maxAccelerationStructureInstances, "acceleration structure instances"          );
 
     #undef LLGL_VALIDATE_LIMIT
     #undef LLGL_CONTINUE_VALIDATION_IF
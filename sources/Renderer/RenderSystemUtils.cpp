@@ -0,0 +1,55 @@
+/*
+ * RenderSystemUtils.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "RenderSystemUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <LLGL/Constants.h>
+
+
+namespace LLGL
+{
+
+
+std::uint32_t FindSelectedVideoAdapter(const RenderSystemDescriptor& renderSystemDesc, const std::vector<VideoAdapterDescriptor>& videoAdapters)
+{
+    /* Select adapter by LUID first since it's the more precise selection */
+    if (renderSystemDesc.adapterLUID != 0)
+    {
+        for_range(i, videoAdapters.size())
+        {
+            if (videoAdapters[i].luid == renderSystemDesc.adapterLUID)
+                return static_cast<std::uint32_t>(i);
+        }
+        LLGL_TRAP(
+            "no video adapter found with LUID 0x%08X%08X",
+            static_cast<unsigned>(renderSystemDesc.adapterLUID >> 32),
+            static_cast<unsigned>(renderSystemDesc.adapterLUID & 0xFFFFFFFFu)
+        );
+    }
+
+    /* Select adapter by index */
+    if (renderSystemDesc.adapterIndex != Constants::defaultAdapter)
+    {
+        if (!(renderSystemDesc.adapterIndex < videoAdapters.size()))
+        {
+            LLGL_TRAP(
+                "video adapter index out of range: %u specified, but only %u adapter(s) available",
+                renderSystemDesc.adapterIndex, static_cast<unsigned>(videoAdapters.size())
+            );
+        }
+        return renderSystemDesc.adapterIndex;
+    }
+
+    return Constants::defaultAdapter;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
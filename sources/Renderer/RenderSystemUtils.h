@@ -31,6 +31,12 @@ const T* GetRendererConfiguration(const RenderSystemDescriptor& renderSystemDesc
     return nullptr;
 }
 
+/*
+Returns the index of the video adapter that is selected by the LUID or index in the render system descriptor.
+Returns Constants::defaultAdapter if no adapter is selected and traps if the selected adapter does not exist.
+*/
+LLGL_EXPORT std::uint32_t FindSelectedVideoAdapter(const RenderSystemDescriptor& renderSystemDesc, const std::vector<VideoAdapterDescriptor>& videoAdapters);
+
 
 } // /namespace LLGL
 
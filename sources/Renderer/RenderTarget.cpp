@@ -8,12 +8,30 @@
 #include <LLGL/RenderTarget.h>
 #include <LLGL/Texture.h>
 #include "../Core/Exception.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+void RenderTarget::SetActiveExtent(const Extent2D& extent)
+{
+    activeExtent_ = extent;
+}
+
+Extent2D RenderTarget::GetActiveExtent() const
+{
+    const Extent2D resolution = GetResolution();
+
+    /* Null extent denotes the entire render target; clamp to resolution in case a swap-chain has been resized */
+    if (activeExtent_.width == 0 || activeExtent_.height == 0)
+        return resolution;
+    else
+        return Extent2D{ std::min(activeExtent_.width, resolution.width), std::min(activeExtent_.height, resolution.height) };
+}
+
+
 /*
  * ======= Protected: =======
  */
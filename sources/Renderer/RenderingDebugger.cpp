@@ -10,6 +10,7 @@
 #include <LLGL/Utils/TypeNames.h>
 #include <LLGL/Container/Strings.h>
 #include <map>
+#include <mutex>
 
 
 namespace LLGL
@@ -41,6 +42,21 @@ struct RenderingDebugger::Pimpl
     UTF8StringMap<Message>  warnings;
     const char*             source      = "";
     const char*             groupName   = "";
+    DebugValidationLevel    level       = DebugValidationLevel::Full;
+    std::uint32_t           interval    = 16;
+    std::recursive_mutex    mutex;                  // Guards the message maps and capture requests; recursive, so callbacks can post further messages
+
+    UTF8String              captureFilename;
+    std::uint32_t           captureFrames       = 0;
+    bool                    captureScheduled    = false;    // BeginCapture has been called, but the debug layer has not started recording yet
+    bool                    captureRecording    = false;
+    bool                    captureEndRequested = false;
+
+    bool                    lintEnabled         = false;
+    std::uint32_t           updateThreshold     = 4096;
+    bool                    frameEncoding       = false;
+    PerformanceLintReport   lintCounters;                   // Lints of the current frame
+    PerformanceLintReport   lintReport;                     // Lints of the last finished frame
 };
 
 
@@ -66,6 +82,190 @@ void RenderingDebugger::SetDebugGroup(const char* name)
 
 void RenderingDebugger::PostError(const ErrorType type, const StringView& message)
 {
+    PostErrorInContext(type, message, pimpl_->source, pimpl_->groupName);
+}
+
+void RenderingDebugger::PostWarning(const WarningType type, const StringView& message)
+{
+    PostWarningInContext(type, message, pimpl_->source, pimpl_->groupName);
+}
+
+void RenderingDebugger::SetValidationLevel(const DebugValidationLevel level)
+{
+    pimpl_->level = level;
+}
+
+DebugValidationLevel RenderingDebugger::GetValidationLevel() const
+{
+    return pimpl_->level;
+}
+
+void RenderingDebugger::SetSamplingInterval(std::uint32_t interval)
+{
+    pimpl_->interval = (interval > 0 ? interval : 1);
+}
+
+std::uint32_t RenderingDebugger::GetSamplingInterval() const
+{
+    return pimpl_->interval;
+}
+
+void RenderingDebugger::BeginCapture(const char* filename, std::uint32_t numFrames)
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    pimpl_->captureFilename     = (filename != nullptr ? filename : "");
+    pimpl_->captureFrames       = numFrames;
+    pimpl_->captureScheduled    = true;
+}
+
+void RenderingDebugger::EndCapture()
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    if (pimpl_->captureScheduled)
+        pimpl_->captureScheduled = false;
+    else if (pimpl_->captureRecording)
+        pimpl_->captureEndRequested = true;
+}
+
+bool RenderingDebugger::IsCapturing() const
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    return (pimpl_->captureScheduled || pimpl_->captureRecording);
+}
+
+void RenderingDebugger::SetPerformanceLintEnabled(bool enable)
+{
+    pimpl_->lintEnabled = enable;
+}
+
+bool RenderingDebugger::IsPerformanceLintEnabled() const
+{
+    return pimpl_->lintEnabled;
+}
+
+void RenderingDebugger::SetBufferUpdateThreshold(std::uint32_t size)
+{
+    pimpl_->updateThreshold = size;
+}
+
+std::uint32_t RenderingDebugger::GetBufferUpdateThreshold() const
+{
+    return pimpl_->updateThreshold;
+}
+
+static std::uint32_t& GetPerformanceLintCounter(PerformanceLintReport& report, const PerformanceLint lint)
+{
+    switch (lint)
+    {
+        case PerformanceLint::RedundantPipelineState:   return report.redundantPipelineStates;
+        case PerformanceLint::RedundantResource:        return report.redundantResources;
+        case PerformanceLint::MapBufferInFlight:        return report.mapBuffersInFlight;
+        case PerformanceLint::ReadTextureInFrame:       return report.readTexturesInFrame;
+        case PerformanceLint::RedundantClear:           return report.redundantClears;
+        case PerformanceLint::LargeBufferUpdate:        return report.largeBufferUpdates;
+        case PerformanceLint::PipelineCreationInFrame:  break;
+    }
+    return report.pipelineCreationsInFrame;
+}
+
+void RenderingDebugger::PostPerformanceLint(const PerformanceLint lint, const StringView& message)
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    if (pimpl_->lintEnabled)
+    {
+        GetPerformanceLintCounter(pimpl_->lintCounters, lint)++;
+        PostWarning(WarningType::PerformanceIssue, message);
+    }
+}
+
+PerformanceLintReport RenderingDebugger::GetPerformanceLintReport() const
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    return pimpl_->lintReport;
+}
+
+
+/*
+ * ====== Protected: =======
+ */
+
+void RenderingDebugger::OnError(ErrorType type, Message& message)
+{
+    UTF8String str = message.ToReportString();
+    Log::Errorf("error (%s): %s\n", ToString(type), str.c_str());
+    message.Block();
+}
+
+void RenderingDebugger::OnWarning(WarningType type, Message& message)
+{
+    UTF8String str = message.ToReportString();
+    Log::Printf("warning (%s): %s\n", ToString(type), str.c_str());
+    message.Block();
+}
+
+
+/*
+ * ====== Private: =======
+ */
+
+bool RenderingDebugger::FetchScheduledCapture(UTF8String& outFilename, std::uint32_t& outNumFrames)
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    if (!pimpl_->captureScheduled)
+        return false;
+
+    outFilename     = pimpl_->captureFilename;
+    outNumFrames    = pimpl_->captureFrames;
+
+    pimpl_->captureScheduled    = false;
+    pimpl_->captureRecording    = true;
+    pimpl_->captureEndRequested = false;
+
+    return true;
+}
+
+bool RenderingDebugger::FetchCaptureEndRequest()
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    const bool endRequested = pimpl_->captureEndRequested;
+    pimpl_->captureEndRequested = false;
+    return endRequested;
+}
+
+void RenderingDebugger::NotifyCaptureFinished()
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    pimpl_->captureRecording = false;
+}
+
+void RenderingDebugger::NotifyFrameEncoding()
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    pimpl_->frameEncoding = true;
+}
+
+void RenderingDebugger::NotifyFramePresented()
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    pimpl_->frameEncoding   = false;
+    pimpl_->lintReport      = pimpl_->lintCounters;
+    pimpl_->lintCounters    = PerformanceLintReport{};
+}
+
+bool RenderingDebugger::IsFrameEncoding() const
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
+    return pimpl_->frameEncoding;
+}
+
+const char* RenderingDebugger::GetSource() const
+{
+    return pimpl_->source;
+}
+
+void RenderingDebugger::PostErrorInContext(const ErrorType type, const StringView& message, const StringView& source, const StringView& groupName)
+{
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
     auto it = pimpl_->errors.find(message);
     if (it != pimpl_->errors.end())
     {
@@ -78,13 +278,14 @@ void RenderingDebugger::PostError(const ErrorType type, const StringView& messag
     else
     {
         auto& msg = pimpl_->errors[message];
-        msg = Message{ message, pimpl_->source, pimpl_->groupName };
+        msg = Message{ message, source, groupName };
         OnError(type, msg);
     }
 }
 
-void RenderingDebugger::PostWarning(const WarningType type, const StringView& message)
+void RenderingDebugger::PostWarningInContext(const WarningType type, const StringView& message, const StringView& source, const StringView& groupName)
 {
+    std::lock_guard<std::recursive_mutex> guard{ pimpl_->mutex };
     auto it = pimpl_->warnings.find(message);
     if (it != pimpl_->warnings.end())
     {
@@ -97,31 +298,12 @@ void RenderingDebugger::PostWarning(const WarningType type, const StringView& me
     else
     {
         auto& msg = pimpl_->warnings[message];
-        msg = Message{ message, pimpl_->source, pimpl_->groupName };
+        msg = Message{ message, source, groupName };
         OnWarning(type, msg);
     }
 }
 
 
-/*
- * ====== Protected: =======
- */
-
-void RenderingDebugger::OnError(ErrorType type, Message& message)
-{
-    UTF8String str = message.ToReportString();
-    Log::Errorf("error (%s): %s\n", ToString(type), str.c_str());
-    message.Block();
-}
-
-void RenderingDebugger::OnWarning(WarningType type, Message& message)
-{
-    UTF8String str = message.ToReportString();
-    Log::Printf("warning (%s): %s\n", ToString(type), str.c_str());
-    message.Block();
-}
-
-
 /*
  * Message class
  */
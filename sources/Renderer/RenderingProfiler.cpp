@@ -0,0 +1,147 @@
+/*
+ * RenderingProfiler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/RenderingProfiler.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Trace thread ID of the first host thread; IDs 1 and 2 are reserved for the CPU and GPU timelines of the scope records.
+static constexpr std::uint32_t g_hostThreadBaseID = 3;
+
+static void AppendJSONString(std::string& s, const std::string& str)
+{
+    static const char* hexDigits = "0123456789abcdef";
+
+    s += '\"';
+    for (char c : str)
+    {
+        switch (c)
+        {
+            case '\"':  s += "\\\"";    break;
+            case '\\':  s += "\\\\";    break;
+            case '\n':  s += "\\n";     break;
+            case '\r':  s += "\\r";     break;
+            case '\t':  s += "\\t";     break;
+            default:
+            {
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    /* Escape remaining control characters as unicode code points */
+                    s += "\\u00";
+                    s += hexDigits[(c >> 4) & 0xF];
+                    s += hexDigits[c & 0xF];
+                }
+                else
+                    s += c;
+            }
+            break;
+        }
+    }
+    s += '\"';
+}
+
+// Appends the specified time in nanoseconds as microseconds with three fractional digits, which is the time unit of the trace event format.
+static void AppendMicroseconds(std::string& s, std::uint64_t nanosecs)
+{
+    const std::uint64_t fraction = nanosecs % 1000;
+    s += std::to_string(nanosecs / 1000);
+    s += '.';
+    s += static_cast<char>('0' + fraction / 100);
+    s += static_cast<char>('0' + (fraction / 10) % 10);
+    s += static_cast<char>('0' + fraction % 10);
+}
+
+static void AppendTraceEvent(
+    std::string&        s,
+    const std::string&  name,
+    const char*         category,
+    int                 threadID,
+    std::uint64_t       beginTime,
+    std::uint64_t       endTime,
+    std::uint64_t       baseTime)
+{
+    if (s.back() == '}')
+        s += ',';
+    s += "\n{\"name\":";
+    AppendJSONString(s, name);
+    s += ",\"cat\":\"";
+    s += category;
+    s += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+    s += std::to_string(threadID);
+    s += ",\"ts\":";
+    AppendMicroseconds(s, beginTime - baseTime);
+    s += ",\"dur\":";
+    AppendMicroseconds(s, (endTime > beginTime ? endTime - beginTime : 0));
+    s += '}';
+}
+
+LLGL_EXPORT std::string WriteChromeTrace(const FrameProfile& profile)
+{
+    /* Determine base times, so CPU and GPU scopes both start at zero; host records share the time domain of CPU scopes */
+    std::uint64_t cpuBaseTime = ~0ull, gpuBaseTime = ~0ull;
+    for (const ProfileScopeRecord& record : profile.scopeRecords)
+    {
+        cpuBaseTime = std::min(cpuBaseTime, record.cpuBeginTime);
+        if (record.gpuEndTime != 0)
+            gpuBaseTime = std::min(gpuBaseTime, record.gpuBeginTime);
+    }
+
+    std::vector<std::uint32_t> hostThreadIDs;
+    for (const ProfileHostRecord& record : profile.hostRecords)
+    {
+        cpuBaseTime = std::min(cpuBaseTime, record.beginTime);
+        auto it = std::lower_bound(hostThreadIDs.begin(), hostThreadIDs.end(), record.threadID);
+        if (it == hostThreadIDs.end() || *it != record.threadID)
+            hostThreadIDs.insert(it, record.threadID);
+    }
+
+    std::string s = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    {
+        /* Write thread names for CPU and GPU timelines */
+        s += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},";
+        s += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+        /* Write thread names for host timelines, which start after the CPU and GPU timelines */
+        for (std::uint32_t threadID : hostThreadIDs)
+        {
+            s += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+            s += std::to_string(g_hostThreadBaseID + threadID);
+            s += ",\"args\":{\"name\":\"LLGL Host Thread ";
+            s += std::to_string(threadID);
+            s += "\"}}";
+        }
+
+        /* Write complete events for all scope records */
+        for (const ProfileScopeRecord& record : profile.scopeRecords)
+        {
+            AppendTraceEvent(s, record.name, "CPU", 1, record.cpuBeginTime, record.cpuEndTime, cpuBaseTime);
+            if (record.gpuEndTime != 0)
+                AppendTraceEvent(s, record.name, "GPU", 2, record.gpuBeginTime, record.gpuEndTime, gpuBaseTime);
+        }
+
+        /* Write complete events for all host records */
+        for (const ProfileHostRecord& record : profile.hostRecords)
+        {
+            const int threadID = static_cast<int>(g_hostThreadBaseID + record.threadID);
+            AppendTraceEvent(s, record.name, "Host", threadID, record.beginTime, record.endTime, cpuBaseTime);
+        }
+    }
+    s += "\n]}\n";
+
+    return s;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,267 @@
+/*
+ * SpirvStrip.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "SpirvStrip.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Word range of a function definition within a SPIR-V module, i.e. from OpFunction to OpFunctionEnd.
+struct SpirvFunctionRange
+{
+    spv::Id                 id          = 0;
+    std::uint32_t           beginOffset = 0;
+    std::uint32_t           endOffset   = 0;
+    std::vector<spv::Id>    callees;
+};
+
+static bool IsSpirvDebugInstruction(spv::Op opcode)
+{
+    switch (opcode)
+    {
+        case spv::OpSourceContinued:
+        case spv::OpSource:
+        case spv::OpSourceExtension:
+        case spv::OpName:
+        case spv::OpMemberName:
+        case spv::OpString:
+        case spv::OpLine:
+        case spv::OpNoLine:
+        case spv::OpModuleProcessed:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool IsSpirvDecorationInstruction(spv::Op opcode)
+{
+    switch (opcode)
+    {
+        case spv::OpDecorate:
+        case spv::OpMemberDecorate:
+        case spv::OpDecorateId:
+            return true;
+        default:
+            return false;
+    }
+}
+
+SpirvResult SpirvStripModule(SpirvModule& module)
+{
+    /* Parse SPIR-V header */
+    SpirvHeader header;
+    SpirvResult result = module.ReadHeader(header);
+    if (result != SpirvResult::NoError)
+        return result;
+
+    const std::uint32_t* words      = module.Words().data();
+    const std::uint32_t  numWords   = static_cast<std::uint32_t>(module.Words().size());
+    const std::uint32_t  idBound    = header.idBound;
+
+    /* Gather entry points and function ranges with their direct callees */
+    std::vector<spv::Id>            entryPoints;
+    std::vector<SpirvFunctionRange> functions;
+    bool                            isInsideFunction = false;
+
+    for (auto it = module.cbegin(), itEnd = module.cend(); it != itEnd; ++it)
+    {
+        const std::uint32_t offset      = module.WordOffset(it);
+        const std::uint32_t wordCount   = it.WordCount();
+
+        if (wordCount == 0 || offset + wordCount > numWords)
+            return SpirvResult::InvalidModule;
+
+        const std::uint32_t* instrWords = it.Ptr();
+
+        switch (it.Opcode())
+        {
+            case spv::OpCapability:
+            {
+                /* OpCapability Capability[1] */
+                if (wordCount < 2)
+                    return SpirvResult::OperandOutOfBounds;
+                if (instrWords[1] == spv::CapabilityLinkage || instrWords[1] == spv::CapabilityKernel)
+                    return SpirvResult::NoError;
+            }
+            break;
+
+            case spv::OpExtInstImport:
+            {
+                /* OpExtInstImport Result[1] Name[2] */
+                if (wordCount < 3)
+                    return SpirvResult::OperandOutOfBounds;
+                const char* name = reinterpret_cast<const char*>(&instrWords[2]);
+                if (::strncmp(name, "NonSemantic.", 12) == 0)
+                    return SpirvResult::NoError;
+            }
+            break;
+
+            case spv::OpDecorationGroup:
+            {
+                /* Group decorations can reference any ID, so leave module unchanged */
+                return SpirvResult::NoError;
+            }
+            break;
+
+            case spv::OpEntryPoint:
+            {
+                /* OpEntryPoint ExecutionModel[1] EntryPoint[2] Name[3] ... */
+                if (wordCount < 3)
+                    return SpirvResult::OperandOutOfBounds;
+                entryPoints.push_back(instrWords[2]);
+            }
+            break;
+
+            case spv::OpFunction:
+            {
+                /* OpFunction ResultType[1] Result[2] FunctionControl[3] FunctionType[4] */
+                if (wordCount < 3)
+                    return SpirvResult::OperandOutOfBounds;
+                if (instrWords[2] >= idBound)
+                    return SpirvResult::IdOutOfBounds;
+                SpirvFunctionRange range;
+                {
+                    range.id            = instrWords[2];
+                    range.beginOffset   = offset;
+                }
+                functions.push_back(std::move(range));
+                isInsideFunction = true;
+            }
+            break;
+
+            case spv::OpFunctionEnd:
+            {
+                if (!isInsideFunction)
+                    return SpirvResult::InvalidModule;
+                functions.back().endOffset = offset + wordCount;
+                isInsideFunction = false;
+            }
+            break;
+
+            case spv::OpFunctionCall:
+            {
+                /* OpFunctionCall ResultType[1] Result[2] Function[3] ... */
+                if (wordCount < 4)
+                    return SpirvResult::OperandOutOfBounds;
+                if (!isInsideFunction)
+                    return SpirvResult::InvalidModule;
+                functions.back().callees.push_back(instrWords[3]);
+            }
+            break;
+
+            default:
+            break;
+        }
+    }
+
+    if (isInsideFunction)
+        return SpirvResult::InvalidModule;
+
+    /* Map function IDs to their ranges and mark all functions that are reachable from any entry point */
+    constexpr std::uint32_t invalidIndex = ~0u;
+    std::vector<std::uint32_t> functionIndices(idBound, invalidIndex);
+    for (std::uint32_t i = 0; i < functions.size(); ++i)
+        functionIndices[functions[i].id] = i;
+
+    std::vector<bool> reachableFunctions(functions.size(), false);
+    std::vector<spv::Id> pendingFunctions = std::move(entryPoints);
+
+    while (!pendingFunctions.empty())
+    {
+        const spv::Id id = pendingFunctions.back();
+        pendingFunctions.pop_back();
+
+        if (id >= idBound)
+            return SpirvResult::IdOutOfBounds;
+
+        const std::uint32_t index = functionIndices[id];
+        if (index == invalidIndex)
+            return SpirvResult::IdTypeMismatch;
+
+        if (!reachableFunctions[index])
+        {
+            reachableFunctions[index] = true;
+            pendingFunctions.insert(pendingFunctions.end(), functions[index].callees.begin(), functions[index].callees.end());
+        }
+    }
+
+    /* Mark all result IDs that are defined inside unreachable functions, so their decorations can be removed as well */
+    std::vector<bool> removedIds(idBound, false);
+    for (std::uint32_t i = 0; i < functions.size(); ++i)
+    {
+        if (reachableFunctions[i])
+            continue;
+
+        SpirvModule::const_iterator it{ words + functions[i].beginOffset };
+        SpirvModule::const_iterator itEnd{ words + functions[i].endOffset };
+
+        for (; it != itEnd; ++it)
+        {
+            const SpirvInstruction instr = it.Get();
+            if (instr.result != 0)
+            {
+                if (instr.result >= idBound)
+                    return SpirvResult::IdOutOfBounds;
+                removedIds[instr.result] = true;
+            }
+        }
+    }
+
+    /* Copy all remaining instructions into the new module */
+    std::vector<std::uint32_t> strippedWords;
+    strippedWords.reserve(numWords);
+    strippedWords.insert(strippedWords.end(), words, words + sizeof(SpirvHeader)/sizeof(std::uint32_t));
+
+    for (auto it = module.cbegin(), itEnd = module.cend(); it != itEnd;)
+    {
+        const spv::Op           opcode      = it.Opcode();
+        const std::uint32_t     wordCount   = it.WordCount();
+        const std::uint32_t*    instrWords  = it.Ptr();
+
+        if (opcode == spv::OpFunction)
+        {
+            /* Skip entire function definition if it's unreachable */
+            const std::uint32_t index = functionIndices[instrWords[2]];
+            if (!reachableFunctions[index])
+            {
+                it = SpirvModule::const_iterator{ words + functions[index].endOffset };
+                continue;
+            }
+        }
+
+        ++it;
+
+        if (IsSpirvDebugInstruction(opcode))
+            continue;
+
+        if (IsSpirvDecorationInstruction(opcode))
+        {
+            /* OpDecorate/OpMemberDecorate/OpDecorateId Target[1] ... */
+            if (wordCount < 2)
+                return SpirvResult::OperandOutOfBounds;
+            if (instrWords[1] < idBound && removedIds[instrWords[1]])
+                continue;
+        }
+
+        strippedWords.insert(strippedWords.end(), instrWords, instrWords + wordCount);
+    }
+
+    module.Words() = std::move(strippedWords);
+
+    return SpirvResult::NoError;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,36 @@
+/*
+ * SpirvStrip.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_SPIRV_STRIP_H
+#define LLGL_SPIRV_STRIP_H
+
+
+#include "SpirvModule.h"
+
+
+namespace LLGL
+{
+
+
+/*
+Strips the specified SPIR-V module from all instructions that don't contribute to the shader program,
+i.e. debug instructions (OpName, OpMemberName, OpString, OpSource*, OpLine, OpNoLine, OpModuleProcessed)
+and all functions that are not reachable from any entry point, including the decorations of their result IDs.
+IDs are not re-numbered, so the header's ID bound and all remaining instructions stay valid as they are.
+Modules with linkage or kernel capabilities, decoration groups, or non-semantic extended instruction sets are left unchanged.
+*/
+SpirvResult SpirvStripModule(SpirvModule& module);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
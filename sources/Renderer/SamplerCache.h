@@ -0,0 +1,165 @@
+/*
+ * SamplerCache.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_SAMPLER_CACHE_H
+#define LLGL_SAMPLER_CACHE_H
+
+
+#include <LLGL/SamplerFlags.h>
+#include "../Core/CoreUtils.h"
+#include "../Core/MacroUtils.h"
+#include <unordered_map>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Hash functor for SamplerDescriptor; combines the same members that are compared by SamplerDescEqual.
+struct SamplerDescHash
+{
+    std::size_t operator () (const SamplerDescriptor& desc) const
+    {
+        auto FloatBits = [](float value) -> std::uint32_t
+        {
+            /* Map -0.0 to +0.0, since they compare equal */
+            std::uint32_t bits = 0;
+            if (value != 0.0f)
+                std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        };
+
+        const std::uint32_t values[] =
+        {
+            (static_cast<std::uint32_t>(desc.addressModeU)   <<  0) |
+            (static_cast<std::uint32_t>(desc.addressModeV)   <<  4) |
+            (static_cast<std::uint32_t>(desc.addressModeW)   <<  8) |
+            (static_cast<std::uint32_t>(desc.minFilter)      << 12) |
+            (static_cast<std::uint32_t>(desc.magFilter)      << 14) |
+            (static_cast<std::uint32_t>(desc.mipMapFilter)   << 16) |
+            (static_cast<std::uint32_t>(desc.mipMapEnabled)  << 18) |
+            (static_cast<std::uint32_t>(desc.compareEnabled) << 19) |
+            (static_cast<std::uint32_t>(desc.compareOp)      << 20),
+            FloatBits(desc.mipMapLODBias),
+            FloatBits(desc.minLOD),
+            FloatBits(desc.maxLOD),
+            desc.maxAnisotropy,
+            FloatBits(desc.borderColor[0]),
+            FloatBits(desc.borderColor[1]),
+            FloatBits(desc.borderColor[2]),
+            FloatBits(desc.borderColor[3]),
+        };
+
+        return static_cast<std::size_t>(HashFNV1a(values, sizeof(values)));
+    }
+};
+
+// Equality functor for SamplerDescriptor.
+struct SamplerDescEqual
+{
+    bool operator () (const SamplerDescriptor& lhs, const SamplerDescriptor& rhs) const
+    {
+        return
+        (
+            LLGL_COMPARE_MEMBER_EQ( addressModeU   ) &&
+            LLGL_COMPARE_MEMBER_EQ( addressModeV   ) &&
+            LLGL_COMPARE_MEMBER_EQ( addressModeW   ) &&
+            LLGL_COMPARE_MEMBER_EQ( minFilter      ) &&
+            LLGL_COMPARE_MEMBER_EQ( magFilter      ) &&
+            LLGL_COMPARE_MEMBER_EQ( mipMapFilter   ) &&
+            LLGL_COMPARE_MEMBER_EQ( mipMapEnabled  ) &&
+            LLGL_COMPARE_MEMBER_EQ( mipMapLODBias  ) &&
+            LLGL_COMPARE_MEMBER_EQ( minLOD         ) &&
+            LLGL_COMPARE_MEMBER_EQ( maxLOD         ) &&
+            LLGL_COMPARE_MEMBER_EQ( maxAnisotropy  ) &&
+            LLGL_COMPARE_MEMBER_EQ( compareEnabled ) &&
+            LLGL_COMPARE_MEMBER_EQ( compareOp      ) &&
+            LLGL_COMPARE_MEMBER_EQ( borderColor[0] ) &&
+            LLGL_COMPARE_MEMBER_EQ( borderColor[1] ) &&
+            LLGL_COMPARE_MEMBER_EQ( borderColor[2] ) &&
+            LLGL_COMPARE_MEMBER_EQ( borderColor[3] )
+        );
+    }
+};
+
+/*
+Reference-counted cache of native sampler objects by their SamplerDescriptor.
+Identical descriptors share one native sampler, so backends with a limited number of samplers,
+e.g. Vulkan's maxSamplerAllocationCount or the D3D12 sampler heap, don't run out of them.
+References to cached native objects remain valid until their last reference is released. All functions are synchronized.
+*/
+template <typename TNative>
+class SamplerCache
+{
+
+    public:
+
+        SamplerCache() = default;
+
+        SamplerCache(const SamplerCache&) = delete;
+        SamplerCache& operator = (const SamplerCache&) = delete;
+
+        // Returns the native sampler for the specified descriptor and increments its reference count. 'createNative' is only invoked for new descriptors.
+        template <typename TCreateFunc>
+        const TNative& Acquire(const SamplerDescriptor& desc, const TCreateFunc& createNative)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            auto it = entries_.find(desc);
+            if (it == entries_.end())
+                it = entries_.emplace(desc, Entry{ createNative(desc), 0 }).first;
+            ++(it->second.refCount);
+            return it->second.native;
+        }
+
+        // Decrements the reference count of the native sampler for the specified descriptor. 'destroyNative' is only invoked for the last reference.
+        template <typename TDestroyFunc>
+        void Release(const SamplerDescriptor& desc, const TDestroyFunc& destroyNative)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            auto it = entries_.find(desc);
+            if (it != entries_.end() && --(it->second.refCount) == 0)
+            {
+                destroyNative(it->second.native);
+                entries_.erase(it);
+            }
+        }
+
+        // Returns the number of distinct native samplers in this cache.
+        std::size_t GetSize() const
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            return entries_.size();
+        }
+
+    private:
+
+        struct Entry
+        {
+            TNative         native;
+            std::uint32_t   refCount;
+        };
+
+    private:
+
+        std::unordered_map<SamplerDescriptor, Entry, SamplerDescHash, SamplerDescEqual> entries_;
+        mutable std::mutex                                                              mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
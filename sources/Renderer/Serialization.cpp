@@ -45,6 +45,9 @@ void Serializer::Begin(IdentType ident, std::size_t preallocatedSize)
 
 void Serializer::Write(const void* data, std::size_t size)
 {
+    if (size == 0)
+        return;
+
     /* Resize serialization buffer on demand */
     if (pos_ + size > data_.size())
         data_.resize(pos_ + size);
@@ -111,7 +114,7 @@ void Deserializer::Reset()
 
 Segment Deserializer::Begin()
 {
-    if (pos_ + g_segmentHeaderSize >= size_)
+    if (pos_ + g_segmentHeaderSize > size_)
         return {};
 
     /* Read segment header */
@@ -119,6 +122,10 @@ Segment Deserializer::Begin()
     seg.ident   = *reinterpret_cast<const IdentType*>(data_ + pos_);
     seg.size    = *reinterpret_cast<const SizeType*>(data_ + pos_ + sizeof(IdentType));
 
+    /* Reject segments that exceed the serialized data, e.g. from truncated files */
+    if (seg.size > size_ - pos_ - g_segmentHeaderSize)
+        return {};
+
     /* Set new reading position and end of segment */
     pos_ += g_segmentHeaderSize;
     segmentEnd_ = pos_ + seg.size;
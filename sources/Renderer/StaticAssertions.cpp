@@ -21,6 +21,7 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( DrawIndirectArguments );
 LLGL_ASSERT_STDLAYOUT_STRUCT( DrawIndexedIndirectArguments );
 LLGL_ASSERT_STDLAYOUT_STRUCT( DrawPatchIndirectArguments );
 LLGL_ASSERT_STDLAYOUT_STRUCT( DispatchIndirectArguments );
+LLGL_ASSERT_STDLAYOUT_STRUCT( DrawMeshTasksIndirectArguments );
 LLGL_ASSERT_STDLAYOUT_STRUCT( QueryPipelineStatistics );
 LLGL_ASSERT_STDLAYOUT_STRUCT( Serialization::Segment );
 
@@ -0,0 +1,679 @@
+/*
+ * TextureContainer.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/TextureContainer.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Format.h>
+#include <LLGL/Utils/ForRange.h>
+#include "TextureUtils.h"
+#include "../Platform/MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+ * DDS file format
+ */
+
+static constexpr char           g_ddsMagic[4]               = { 'D', 'D', 'S', ' ' };
+
+static constexpr std::uint32_t  g_ddsFlagMipMapCount        = 0x00020000;
+static constexpr std::uint32_t  g_ddsFlagDepth              = 0x00800000;
+static constexpr std::uint32_t  g_ddsPixelFlagAlpha         = 0x00000001;
+static constexpr std::uint32_t  g_ddsPixelFlagFourCC        = 0x00000004;
+static constexpr std::uint32_t  g_ddsPixelFlagRGB           = 0x00000040;
+static constexpr std::uint32_t  g_ddsPixelFlagLuminance     = 0x00020000;
+static constexpr std::uint32_t  g_ddsCaps2CubeMap           = 0x00000200;
+static constexpr std::uint32_t  g_ddsCaps2Volume            = 0x00200000;
+static constexpr std::uint32_t  g_ddsDX10MiscTextureCube    = 0x00000004;
+static constexpr std::uint32_t  g_ddsDX10Dimension1D        = 2;
+static constexpr std::uint32_t  g_ddsDX10Dimension2D        = 3;
+static constexpr std::uint32_t  g_ddsDX10Dimension3D        = 4;
+
+struct DDSPixelFormat
+{
+    std::uint32_t   size;
+    std::uint32_t   flags;
+    char            fourCC[4];
+    std::uint32_t   rgbBitCount;
+    std::uint32_t   rBitMask;
+    std::uint32_t   gBitMask;
+    std::uint32_t   bBitMask;
+    std::uint32_t   aBitMask;
+};
+
+struct DDSHeader
+{
+    std::uint32_t   size;
+    std::uint32_t   flags;
+    std::uint32_t   height;
+    std::uint32_t   width;
+    std::uint32_t   pitchOrLinearSize;
+    std::uint32_t   depth;
+    std::uint32_t   mipMapCount;
+    std::uint32_t   reserved1[11];
+    DDSPixelFormat  pixelFormat;
+    std::uint32_t   caps;
+    std::uint32_t   caps2;
+    std::uint32_t   caps3;
+    std::uint32_t   caps4;
+    std::uint32_t   reserved2;
+};
+
+struct DDSHeaderDX10
+{
+    std::uint32_t   dxgiFormat;
+    std::uint32_t   resourceDimension;
+    std::uint32_t   miscFlag;
+    std::uint32_t   arraySize;
+    std::uint32_t   miscFlags2;
+};
+
+static_assert(sizeof(DDSHeader) == 124, "DDSHeader must be 124 bytes");
+static_assert(sizeof(DDSHeaderDX10) == 20, "DDSHeaderDX10 must be 20 bytes");
+
+
+/*
+ * KTX2 file format
+ */
+
+static constexpr unsigned char  g_ktx2Identifier[12]        = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+struct KTX2Header
+{
+    unsigned char   identifier[12];
+    std::uint32_t   vkFormat;
+    std::uint32_t   typeSize;
+    std::uint32_t   pixelWidth;
+    std::uint32_t   pixelHeight;
+    std::uint32_t   pixelDepth;
+    std::uint32_t   layerCount;
+    std::uint32_t   faceCount;
+    std::uint32_t   levelCount;
+    std::uint32_t   supercompressionScheme;
+    std::uint32_t   dfdByteOffset;
+    std::uint32_t   dfdByteLength;
+    std::uint32_t   kvdByteOffset;
+    std::uint32_t   kvdByteLength;
+    std::uint64_t   sgdByteOffset;
+    std::uint64_t   sgdByteLength;
+};
+
+struct KTX2LevelIndex
+{
+    std::uint64_t   byteOffset;
+    std::uint64_t   byteLength;
+    std::uint64_t   uncompressedByteLength;
+};
+
+static_assert(sizeof(KTX2Header) == 80, "KTX2Header must be 80 bytes");
+static_assert(sizeof(KTX2LevelIndex) == 24, "KTX2LevelIndex must be 24 bytes");
+
+
+/*
+ * Internal functions
+ */
+
+static bool IsFourCC(const DDSPixelFormat& pixelFormat, const char* fourCC)
+{
+    return (::memcmp(pixelFormat.fourCC, fourCC, 4) == 0);
+}
+
+static Format MapDDSFourCCFormat(const DDSPixelFormat& pixelFormat)
+{
+    if (IsFourCC(pixelFormat, "DXT1"))
+        return Format::BC1UNorm;
+    if (IsFourCC(pixelFormat, "DXT2") || IsFourCC(pixelFormat, "DXT3"))
+        return Format::BC2UNorm;
+    if (IsFourCC(pixelFormat, "DXT4") || IsFourCC(pixelFormat, "DXT5"))
+        return Format::BC3UNorm;
+    if (IsFourCC(pixelFormat, "ATI1") || IsFourCC(pixelFormat, "BC4U"))
+        return Format::BC4UNorm;
+    if (IsFourCC(pixelFormat, "BC4S"))
+        return Format::BC4SNorm;
+    if (IsFourCC(pixelFormat, "ATI2") || IsFourCC(pixelFormat, "BC5U"))
+        return Format::BC5UNorm;
+    if (IsFourCC(pixelFormat, "BC5S"))
+        return Format::BC5SNorm;
+    return Format::Undefined;
+}
+
+static Format MapDDSMaskedFormat(const DDSPixelFormat& pixelFormat)
+{
+    if ((pixelFormat.flags & g_ddsPixelFlagRGB) != 0 && pixelFormat.rgbBitCount == 32)
+    {
+        const bool hasAlpha = ((pixelFormat.flags & g_ddsPixelFlagAlpha) != 0 && pixelFormat.aBitMask == 0xFF000000u);
+        if (pixelFormat.rBitMask == 0x000000FFu && pixelFormat.gBitMask == 0x0000FF00u && pixelFormat.bBitMask == 0x00FF0000u && hasAlpha)
+            return Format::RGBA8UNorm;
+        if (pixelFormat.rBitMask == 0x00FF0000u && pixelFormat.gBitMask == 0x0000FF00u && pixelFormat.bBitMask == 0x000000FFu && hasAlpha)
+            return Format::BGRA8UNorm;
+    }
+    else if ((pixelFormat.flags & (g_ddsPixelFlagRGB | g_ddsPixelFlagLuminance)) != 0 && pixelFormat.rgbBitCount == 8 && pixelFormat.rBitMask == 0xFFu)
+        return Format::R8UNorm;
+    return Format::Undefined;
+}
+
+static Format MapDXGIFormat(std::uint32_t dxgiFormat)
+{
+    switch (dxgiFormat)
+    {
+        case  2: return Format::RGBA32Float;
+        case 10: return Format::RGBA16Float;
+        case 11: return Format::RGBA16UNorm;
+        case 13: return Format::RGBA16SNorm;
+        case 16: return Format::RG32Float;
+        case 28: return Format::RGBA8UNorm;
+        case 29: return Format::RGBA8UNorm_sRGB;
+        case 31: return Format::RGBA8SNorm;
+        case 34: return Format::RG16Float;
+        case 35: return Format::RG16UNorm;
+        case 37: return Format::RG16SNorm;
+        case 41: return Format::R32Float;
+        case 49: return Format::RG8UNorm;
+        case 51: return Format::RG8SNorm;
+        case 54: return Format::R16Float;
+        case 56: return Format::R16UNorm;
+        case 58: return Format::R16SNorm;
+        case 61: return Format::R8UNorm;
+        case 63: return Format::R8SNorm;
+        case 71: return Format::BC1UNorm;
+        case 72: return Format::BC1UNorm_sRGB;
+        case 74: return Format::BC2UNorm;
+        case 75: return Format::BC2UNorm_sRGB;
+        case 77: return Format::BC3UNorm;
+        case 78: return Format::BC3UNorm_sRGB;
+        case 80: return Format::BC4UNorm;
+        case 81: return Format::BC4SNorm;
+        case 83: return Format::BC5UNorm;
+        case 84: return Format::BC5SNorm;
+        case 87: return Format::BGRA8UNorm;
+        case 91: return Format::BGRA8UNorm_sRGB;
+        default: return Format::Undefined;
+    }
+}
+
+static Format MapVkFormat(std::uint32_t vkFormat)
+{
+    switch (vkFormat)
+    {
+        case   9: return Format::R8UNorm;
+        case  10: return Format::R8SNorm;
+        case  16: return Format::RG8UNorm;
+        case  17: return Format::RG8SNorm;
+        case  37: return Format::RGBA8UNorm;
+        case  38: return Format::RGBA8SNorm;
+        case  43: return Format::RGBA8UNorm_sRGB;
+        case  44: return Format::BGRA8UNorm;
+        case  50: return Format::BGRA8UNorm_sRGB;
+        case  70: return Format::R16UNorm;
+        case  71: return Format::R16SNorm;
+        case  76: return Format::R16Float;
+        case  77: return Format::RG16UNorm;
+        case  78: return Format::RG16SNorm;
+        case  83: return Format::RG16Float;
+        case  91: return Format::RGBA16UNorm;
+        case  92: return Format::RGBA16SNorm;
+        case  97: return Format::RGBA16Float;
+        case 100: return Format::R32Float;
+        case 103: return Format::RG32Float;
+        case 109: return Format::RGBA32Float;
+        case 131: // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 133: return Format::BC1UNorm;
+        case 132: // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+        case 134: return Format::BC1UNorm_sRGB;
+        case 135: return Format::BC2UNorm;
+        case 136: return Format::BC2UNorm_sRGB;
+        case 137: return Format::BC3UNorm;
+        case 138: return Format::BC3UNorm_sRGB;
+        case 139: return Format::BC4UNorm;
+        case 140: return Format::BC4SNorm;
+        case 141: return Format::BC5UNorm;
+        case 142: return Format::BC5SNorm;
+        default:  return Format::Undefined;
+    }
+}
+
+static Extent3D GetContainerMipExtent(const TextureDescriptor& textureDesc, std::uint32_t mipLevel)
+{
+    return Extent3D
+    {
+        std::max(1u, textureDesc.extent.width  >> mipLevel),
+        std::max(1u, textureDesc.extent.height >> mipLevel),
+        std::max(1u, textureDesc.extent.depth  >> mipLevel)
+    };
+}
+
+// Returns the size of a single array layer of a tightly packed MIP-map level; compressed formats are rounded up to whole blocks.
+static std::uint64_t GetContainerLayerDataSize(const TextureDescriptor& textureDesc, std::uint32_t mipLevel)
+{
+    const FormatAttributes& formatAttribs = GetFormatAttribs(textureDesc.format);
+    const Extent3D extent = GetContainerMipExtent(textureDesc, mipLevel);
+    const std::uint64_t numBlocksX = (extent.width  + formatAttribs.blockWidth  - 1) / formatAttribs.blockWidth;
+    const std::uint64_t numBlocksY = (extent.height + formatAttribs.blockHeight - 1) / formatAttribs.blockHeight;
+    return (numBlocksX * numBlocksY * extent.depth * formatAttribs.bitSize / 8);
+}
+
+// Returns the region of the specified MIP-map level for the specified range of array layers.
+static TextureRegion GetContainerMipRegion(const TextureDescriptor& textureDesc, std::uint32_t mipLevel, std::uint32_t firstLayer, std::uint32_t numLayers)
+{
+    const Extent3D extent = GetContainerMipExtent(textureDesc, mipLevel);
+    return TextureRegion
+    {
+        TextureSubresource{ firstLayer, numLayers, mipLevel, 1 },
+        Offset3D{ 0, 0, 0 },
+        Extent3D
+        {
+            extent.width,
+            (textureDesc.type == TextureType::Texture1D || textureDesc.type == TextureType::Texture1DArray ? 1u : extent.height),
+            (textureDesc.type == TextureType::Texture3D ? extent.depth : 1u)
+        }
+    };
+}
+
+// Upper limits of the extent and number of array layers (including cube faces) of container textures, to reject corrupted headers before anything is allocated.
+static constexpr std::uint32_t  g_containerMaxExtent        = 16384;
+static constexpr std::uint64_t  g_containerMaxArrayLayers   = 2048;
+
+// Returns true if the specified extent and number of array layers are within the limits for container textures.
+static bool IsContainerSizeValid(const Extent3D& extent, std::uint64_t numArrayLayers)
+{
+    return
+    (
+        extent.width    <= g_containerMaxExtent &&
+        extent.height   <= g_containerMaxExtent &&
+        extent.depth    <= g_containerMaxExtent &&
+        numArrayLayers  >= 1                    &&
+        numArrayLayers  <= g_containerMaxArrayLayers
+    );
+}
+
+static TextureType GetContainerTextureType(bool is1D, bool is3D, bool isCube, bool isArray)
+{
+    if (is3D)
+        return TextureType::Texture3D;
+    if (isCube)
+        return (isArray ? TextureType::TextureCubeArray : TextureType::TextureCube);
+    if (is1D)
+        return (isArray ? TextureType::Texture1DArray : TextureType::Texture1D);
+    return (isArray ? TextureType::Texture2DArray : TextureType::Texture2D);
+}
+
+
+/*
+ * TextureContainer::Pimpl struct
+ */
+
+struct TextureContainer::Pimpl
+{
+    std::unique_ptr<MappedFile>     file;
+    TextureContainerFormat          fileFormat      = TextureContainerFormat::Undefined;
+    TextureDescriptor               textureDesc;
+    ImageFormat                     imageFormat     = ImageFormat::RGBA;
+    DataType                        dataType        = DataType::UInt8;
+    bool                            interleaved     = false;    // True if all array layers of each MIP-map level are stored contiguously.
+    std::vector<std::uint64_t>      layerOffsets;               // Offset of each subresource, indexed by (mipLevel * arrayLayers + arrayLayer).
+
+    bool Load(std::unique_ptr<MappedFile>&& mappedFile);
+    bool LoadDDS(const char* data, std::size_t size);
+    bool LoadKTX2(const char* data, std::size_t size);
+    bool FinalizeFormat(Format format);
+
+    const char* GetData() const;
+    std::size_t GetLayerDataSize(std::uint32_t mipLevel) const;
+    std::uint64_t GetLayerOffset(std::uint32_t mipLevel, std::uint32_t arrayLayer) const;
+};
+
+bool TextureContainer::Pimpl::Load(std::unique_ptr<MappedFile>&& mappedFile)
+{
+    const char* data = static_cast<const char*>(mappedFile->GetData());
+    const std::size_t size = mappedFile->GetSize();
+
+    textureDesc = TextureDescriptor{};
+
+    if (size >= sizeof(g_ddsMagic) && ::memcmp(data, g_ddsMagic, sizeof(g_ddsMagic)) == 0)
+    {
+        if (!LoadDDS(data, size))
+            return false;
+        fileFormat = TextureContainerFormat::DDS;
+    }
+    else if (size >= sizeof(g_ktx2Identifier) && ::memcmp(data, g_ktx2Identifier, sizeof(g_ktx2Identifier)) == 0)
+    {
+        if (!LoadKTX2(data, size))
+            return false;
+        fileFormat = TextureContainerFormat::KTX2;
+    }
+    else
+        return false;
+
+    file = std::move(mappedFile);
+
+    return true;
+}
+
+bool TextureContainer::Pimpl::LoadDDS(const char* data, std::size_t size)
+{
+    std::size_t offset = sizeof(g_ddsMagic);
+    if (size < offset + sizeof(DDSHeader))
+        return false;
+
+    DDSHeader header;
+    ::memcpy(&header, data + offset, sizeof(header));
+    offset += sizeof(header);
+
+    if (header.size != sizeof(DDSHeader) || header.pixelFormat.size != sizeof(DDSPixelFormat) || header.width == 0)
+        return false;
+
+    const bool  hasMips     = ((header.flags & g_ddsFlagMipMapCount) != 0 && header.mipMapCount > 1);
+    bool        is1D        = false;
+    bool        is3D        = ((header.flags & g_ddsFlagDepth) != 0 && (header.caps2 & g_ddsCaps2Volume) != 0);
+    bool        isCube      = ((header.caps2 & g_ddsCaps2CubeMap) != 0);
+    std::uint32_t numLayers = 1;
+    Format      format      = Format::Undefined;
+
+    if ((header.pixelFormat.flags & g_ddsPixelFlagFourCC) != 0 && IsFourCC(header.pixelFormat, "DX10"))
+    {
+        /* Read header extension for DXGI formats and texture arrays */
+        if (size < offset + sizeof(DDSHeaderDX10))
+            return false;
+
+        DDSHeaderDX10 headerDX10;
+        ::memcpy(&headerDX10, data + offset, sizeof(headerDX10));
+        offset += sizeof(headerDX10);
+
+        format      = MapDXGIFormat(headerDX10.dxgiFormat);
+        is1D        = (headerDX10.resourceDimension == g_ddsDX10Dimension1D);
+        is3D        = (headerDX10.resourceDimension == g_ddsDX10Dimension3D);
+        isCube      = (headerDX10.resourceDimension == g_ddsDX10Dimension2D && (headerDX10.miscFlag & g_ddsDX10MiscTextureCube) != 0);
+        numLayers   = std::max(1u, headerDX10.arraySize);
+
+        if (!is1D && !is3D && headerDX10.resourceDimension != g_ddsDX10Dimension2D)
+            return false;
+    }
+    else if ((header.pixelFormat.flags & g_ddsPixelFlagFourCC) != 0)
+        format = MapDDSFourCCFormat(header.pixelFormat);
+    else
+        format = MapDDSMaskedFormat(header.pixelFormat);
+
+    if (is3D && (isCube || numLayers > 1))
+        return false;
+
+    const Extent3D      extent          = Extent3D{ header.width, (is1D ? 1u : std::max(1u, header.height)), (is3D ? std::max(1u, header.depth) : 1u) };
+    const std::uint64_t numArrayLayers  = (isCube ? static_cast<std::uint64_t>(numLayers) * 6 : numLayers);
+    if (!IsContainerSizeValid(extent, numArrayLayers))
+        return false;
+
+    textureDesc.type        = GetContainerTextureType(is1D, is3D, isCube, (numLayers > 1));
+    textureDesc.format      = format;
+    textureDesc.extent      = extent;
+    textureDesc.arrayLayers = static_cast<std::uint32_t>(numArrayLayers);
+    textureDesc.mipLevels   = (hasMips ? std::min(header.mipMapCount, NumMipLevels(textureDesc.type, textureDesc.extent)) : 1u);
+
+    if (!FinalizeFormat(format))
+        return false;
+
+    /* DDS stores the entire MIP-map chain of each array layer (or cube face) one after another */
+    interleaved = (textureDesc.arrayLayers == 1);
+    layerOffsets.resize(static_cast<std::size_t>(textureDesc.mipLevels) * textureDesc.arrayLayers);
+
+    std::uint64_t layerOffset = offset;
+    for_range(arrayLayer, textureDesc.arrayLayers)
+    {
+        for_range(mipLevel, textureDesc.mipLevels)
+        {
+            /* Check every subresource against the file size, so a truncated file is rejected before the offsets can overflow */
+            const std::uint64_t layerDataSize = GetContainerLayerDataSize(textureDesc, mipLevel);
+            if (layerOffset > size || layerDataSize > size - layerOffset)
+                return false;
+
+            layerOffsets[static_cast<std::size_t>(mipLevel) * textureDesc.arrayLayers + arrayLayer] = layerOffset;
+            layerOffset += layerDataSize;
+        }
+    }
+
+    return true;
+}
+
+bool TextureContainer::Pimpl::LoadKTX2(const char* data, std::size_t size)
+{
+    if (size < sizeof(KTX2Header))
+        return false;
+
+    KTX2Header header;
+    ::memcpy(&header, data, sizeof(header));
+
+    /* Supercompressed files, e.g. with Basis Universal, and formats without a direct hardware mapping would require transcoding */
+    if (header.supercompressionScheme != 0 || header.vkFormat == 0)
+        return false;
+
+    if (header.pixelWidth == 0 || (header.faceCount != 1 && header.faceCount != 6))
+        return false;
+
+    const std::uint32_t numLevels = std::max(1u, header.levelCount);
+    if (numLevels > (size - sizeof(KTX2Header)) / sizeof(KTX2LevelIndex))
+        return false;
+
+    const bool  is1D        = (header.pixelHeight == 0);
+    const bool  is3D        = (header.pixelDepth != 0);
+    const bool  isCube      = (header.faceCount == 6);
+    const bool  isArray     = (header.layerCount != 0);
+    const Format format     = MapVkFormat(header.vkFormat);
+
+    if (is3D && (isCube || isArray))
+        return false;
+
+    const Extent3D      extent          = Extent3D{ header.pixelWidth, std::max(1u, header.pixelHeight), std::max(1u, header.pixelDepth) };
+    const std::uint64_t numArrayLayers  = static_cast<std::uint64_t>(std::max(1u, header.layerCount)) * header.faceCount;
+    if (!IsContainerSizeValid(extent, numArrayLayers))
+        return false;
+
+    textureDesc.type        = GetContainerTextureType(is1D, is3D, isCube, isArray);
+    textureDesc.format      = format;
+    textureDesc.extent      = extent;
+    textureDesc.arrayLayers = static_cast<std::uint32_t>(numArrayLayers);
+    textureDesc.mipLevels   = std::min(numLevels, NumMipLevels(textureDesc.type, textureDesc.extent));
+
+    if (!FinalizeFormat(format))
+        return false;
+
+    /* KTX2 stores all array layers and cube faces of each MIP-map level contiguously */
+    interleaved = true;
+    layerOffsets.resize(static_cast<std::size_t>(textureDesc.mipLevels) * textureDesc.arrayLayers);
+
+    for_range(mipLevel, textureDesc.mipLevels)
+    {
+        KTX2LevelIndex level;
+        ::memcpy(&level, data + sizeof(KTX2Header) + mipLevel * sizeof(KTX2LevelIndex), sizeof(level));
+
+        const std::uint64_t layerDataSize = GetContainerLayerDataSize(textureDesc, mipLevel);
+        if (level.byteLength != layerDataSize * textureDesc.arrayLayers || level.byteOffset > size || level.byteLength > size - level.byteOffset)
+            return false;
+
+        for_range(arrayLayer, textureDesc.arrayLayers)
+            layerOffsets[static_cast<std::size_t>(mipLevel) * textureDesc.arrayLayers + arrayLayer] = level.byteOffset + arrayLayer * layerDataSize;
+    }
+
+    return true;
+}
+
+bool TextureContainer::Pimpl::FinalizeFormat(Format format)
+{
+    return (format != Format::Undefined && GetPassthroughImageFormat(format, imageFormat, dataType));
+}
+
+const char* TextureContainer::Pimpl::GetData() const
+{
+    return static_cast<const char*>(file->GetData());
+}
+
+std::size_t TextureContainer::Pimpl::GetLayerDataSize(std::uint32_t mipLevel) const
+{
+    return static_cast<std::size_t>(GetContainerLayerDataSize(textureDesc, mipLevel));
+}
+
+std::uint64_t TextureContainer::Pimpl::GetLayerOffset(std::uint32_t mipLevel, std::uint32_t arrayLayer) const
+{
+    return layerOffsets[mipLevel * textureDesc.arrayLayers + arrayLayer];
+}
+
+
+/*
+ * TextureContainer class
+ */
+
+TextureContainer::TextureContainer() :
+    pimpl_ { new Pimpl{} }
+{
+}
+
+TextureContainer::TextureContainer(const char* filename) :
+    TextureContainer {}
+{
+    Open(filename);
+}
+
+TextureContainer::~TextureContainer()
+{
+    delete pimpl_;
+}
+
+bool TextureContainer::Open(const char* filename)
+{
+    Close();
+
+    if (filename == nullptr)
+        return false;
+
+    std::unique_ptr<MappedFile> mappedFile = MappedFile::Open(filename);
+    if (!mappedFile)
+        return false;
+
+    if (!pimpl_->Load(std::move(mappedFile)))
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void TextureContainer::Close()
+{
+    pimpl_->file.reset();
+    pimpl_->fileFormat  = TextureContainerFormat::Undefined;
+    pimpl_->textureDesc = TextureDescriptor{};
+    pimpl_->layerOffsets.clear();
+}
+
+bool TextureContainer::IsOpen() const
+{
+    return (pimpl_->file != nullptr);
+}
+
+TextureContainerFormat TextureContainer::GetFileFormat() const
+{
+    return pimpl_->fileFormat;
+}
+
+const TextureDescriptor& TextureContainer::GetTextureDesc() const
+{
+    return pimpl_->textureDesc;
+}
+
+bool TextureContainer::GetImageDesc(std::uint32_t mipLevel, std::uint32_t arrayLayer, SrcImageDescriptor& outImageDesc) const
+{
+    if (!IsOpen() || mipLevel >= pimpl_->textureDesc.mipLevels || arrayLayer >= pimpl_->textureDesc.arrayLayers)
+        return false;
+
+    outImageDesc.format     = pimpl_->imageFormat;
+    outImageDesc.dataType   = pimpl_->dataType;
+    outImageDesc.data       = pimpl_->GetData() + pimpl_->GetLayerOffset(mipLevel, arrayLayer);
+    outImageDesc.dataSize   = pimpl_->GetLayerDataSize(mipLevel);
+
+    return true;
+}
+
+Texture* TextureContainer::CreateTexture(RenderSystem& renderSystem, long bindFlags) const
+{
+    if (!IsOpen())
+        return nullptr;
+
+    /* Reject texture formats that the render system cannot sample, since the texel data is never converted */
+    const std::vector<Format>& supportedFormats = renderSystem.GetRenderingCaps().textureFormats;
+    if (!supportedFormats.empty() && std::find(supportedFormats.begin(), supportedFormats.end(), pimpl_->textureDesc.format) == supportedFormats.end())
+        return nullptr;
+
+    /* All levels are stored, so none must be generated */
+    TextureDescriptor textureDesc = pimpl_->textureDesc;
+    textureDesc.bindFlags   = bindFlags;
+    textureDesc.miscFlags   = MiscFlags::FixedSamples;
+
+    const TextureDescriptor& containerDesc = pimpl_->textureDesc;
+    const char* data = pimpl_->GetData();
+
+    if (pimpl_->interleaved)
+    {
+        /* Create texture with all array layers of the first MIP-map level and upload each remaining level with a single write */
+        const SrcImageDescriptor mip0ImageDesc
+        {
+            pimpl_->imageFormat,
+            pimpl_->dataType,
+            data + pimpl_->GetLayerOffset(0, 0),
+            pimpl_->GetLayerDataSize(0) * containerDesc.arrayLayers
+        };
+
+        Texture* texture = renderSystem.CreateTexture(textureDesc, &mip0ImageDesc);
+        if (texture == nullptr)
+            return nullptr;
+
+        for_subrange(mipLevel, 1u, containerDesc.mipLevels)
+        {
+            const SrcImageDescriptor mipImageDesc
+            {
+                pimpl_->imageFormat,
+                pimpl_->dataType,
+                data + pimpl_->GetLayerOffset(mipLevel, 0),
+                pimpl_->GetLayerDataSize(mipLevel) * containerDesc.arrayLayers
+            };
+            renderSystem.WriteTexture(*texture, GetContainerMipRegion(containerDesc, mipLevel, 0, containerDesc.arrayLayers), mipImageDesc);
+        }
+
+        return texture;
+    }
+    else
+    {
+        /* Array layers are not contiguous, so each subresource is uploaded individually */
+        Texture* texture = renderSystem.CreateTexture(textureDesc);
+        if (texture == nullptr)
+            return nullptr;
+
+        for_range(arrayLayer, containerDesc.arrayLayers)
+        {
+            for_range(mipLevel, containerDesc.mipLevels)
+            {
+                SrcImageDescriptor imageDesc;
+                GetImageDesc(mipLevel, arrayLayer, imageDesc);
+                renderSystem.WriteTexture(*texture, GetContainerMipRegion(containerDesc, mipLevel, arrayLayer, 1), imageDesc);
+            }
+        }
+
+        return texture;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,774 @@
+/*
+ * TextureStreamer.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/TextureStreamer.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/CommandQueue.h>
+#include <LLGL/Fence.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Buffer.h>
+#include <LLGL/Format.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include "TextureUtils.h"
+#include "../Core/Assertion.h"
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Offset of staging data within a staging buffer; this is the placement alignment of Direct3D 12, which satisfies all backends.
+static constexpr std::uint64_t g_stagingAlignment = 512;
+
+struct TextureStreamerEntry
+{
+    TextureDescriptor               desc;                       // Descriptor of the full texture with all MIP-map levels
+    TextureStreamingLoadFunction    loadFunc;
+    Texture*                        texture             = nullptr;
+    bool                            sparse              = false;
+    bool                            compressed          = false;    // Compressed formats are uploaded with WriteTexture
+    ImageFormat                     imageFormat         = ImageFormat::RGBA;
+    DataType                        dataType            = DataType::UInt8;
+    std::uint32_t                   tailMipLevel        = 0;        // First MIP-map level of the tail that is always resident
+    std::uint32_t                   residentMipLevel    = 0;        // Most detailed MIP-map level that is resident
+    std::uint32_t                   targetMipLevel      = 0;        // Most detailed MIP-map level that fits into the budget
+    std::uint32_t                   requestedMipLevel   = 0;
+    float                           priority            = 1.0f;
+};
+
+// Texel data of a single MIP-map level either in the staging buffer or, for compressed formats, in the scratch buffer.
+struct TextureStreamerUpload
+{
+    std::uint32_t   mipLevel;
+    std::uint64_t   offset;
+    std::uint64_t   size;
+};
+
+// Residency change of a single texture within an update.
+struct TextureStreamerOperation
+{
+    std::uint32_t                       entryIndex;
+    std::uint32_t                       mipLevel;               // New most detailed resident MIP-map level
+    std::vector<TextureStreamerUpload>  uploads;
+};
+
+// Staging resources of a single update, which are reused once their fence has been signaled.
+struct TextureStreamerBatch
+{
+    CommandBuffer*          commandBuffer       = nullptr;
+    Fence*                  fence               = nullptr;
+    Buffer*                 stagingBuffer       = nullptr;
+    bool                    pending             = false;
+    std::vector<Texture*>   releasedTextures;                   // Textures that are released once the fence has been signaled
+};
+
+struct TextureStreamer::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem, const TextureStreamerDescriptor& streamerDesc) :
+        renderSystem    { renderSystem                  },
+        streamerDesc    { streamerDesc                  },
+        commandQueue    { renderSystem.GetCommandQueue() }
+    {
+    }
+
+    TextureStreamerEntry& GetEntry(StreamedTexture texture);
+    const TextureStreamerEntry& GetEntry(StreamedTexture texture) const;
+
+    std::uint64_t GetMipDataSize(const TextureStreamerEntry& entry, std::uint32_t mipLevel) const;
+    std::uint64_t GetResidentSize(const TextureStreamerEntry& entry, std::uint32_t mipLevel) const;
+    TextureRegion GetMipRegion(const TextureStreamerEntry& entry, std::uint32_t mipLevel, std::uint32_t baseMipLevel) const;
+    ResourceViewDescriptor GetResourceView(const TextureStreamerEntry& entry) const;
+
+    Texture* CreateHardwareTexture(const TextureStreamerEntry& entry, std::uint32_t baseMipLevel);
+    void UpdateMipResidency(TextureStreamerEntry& entry, std::uint32_t firstMipLevel, std::uint32_t lastMipLevel, bool resident);
+    void WriteMipLevel(TextureStreamerEntry& entry, std::uint32_t mipLevel, std::uint32_t baseMipLevel, const void* data, std::size_t dataSize);
+
+    std::uint64_t ComputeEffectiveBudget();
+    void AssignTargetMipLevels(std::uint64_t budget);
+    void StageMipLevels(TextureStreamerBatch& batch, std::vector<TextureStreamerOperation>& operations);
+    void ApplyOperation(TextureStreamerBatch& batch, const TextureStreamerOperation& operation);
+
+    void PrepareBatch(TextureStreamerBatch& batch);
+    void RetireBatches(std::uint64_t timeout);
+
+    RenderSystem&                       renderSystem;
+    TextureStreamerDescriptor           streamerDesc;
+    CommandQueue*                       commandQueue        = nullptr;
+    bool                                sparseSupported     = false;
+
+    mutable std::mutex                  mutex;
+    std::vector<TextureStreamerEntry>   entries;                // Entries with a null texture are unused
+    std::vector<StreamedTexture>        freeHandles;
+    std::vector<TextureStreamerBatch>   batches;
+    std::vector<Texture*>               releasedTextures;       // Textures released by the client, which are retired with the next batch
+    std::vector<char>                   scratch;                // Texel data of compressed formats
+
+    std::uint64_t                       effectiveBudget     = 0;
+    std::uint64_t                       uploadedSize        = 0;
+    std::uint64_t                       evictedSize         = 0;
+};
+
+
+/*
+ * Internal functions
+ */
+
+static std::uint64_t AlignStagingOffset(std::uint64_t offset)
+{
+    return (offset + g_stagingAlignment - 1) / g_stagingAlignment * g_stagingAlignment;
+}
+
+
+/*
+ * TextureStreamer::Pimpl structure
+ */
+
+TextureStreamerEntry& TextureStreamer::Pimpl::GetEntry(StreamedTexture texture)
+{
+    LLGL_ASSERT(texture > 0 && texture <= entries.size() && entries[texture - 1].texture != nullptr, "invalid streamed texture handle");
+    return entries[texture - 1];
+}
+
+const TextureStreamerEntry& TextureStreamer::Pimpl::GetEntry(StreamedTexture texture) const
+{
+    LLGL_ASSERT(texture > 0 && texture <= entries.size() && entries[texture - 1].texture != nullptr, "invalid streamed texture handle");
+    return entries[texture - 1];
+}
+
+std::uint64_t TextureStreamer::Pimpl::GetMipDataSize(const TextureStreamerEntry& entry, std::uint32_t mipLevel) const
+{
+    /* Extent includes the array layers in its depth component; compressed formats are rounded up to whole blocks */
+    const FormatAttributes& formatAttribs = GetFormatAttribs(entry.desc.format);
+    const Extent3D extent = GetMipExtent(entry.desc, mipLevel);
+    const std::uint64_t numBlocksX = (extent.width  + formatAttribs.blockWidth  - 1) / formatAttribs.blockWidth;
+    const std::uint64_t numBlocksY = (extent.height + formatAttribs.blockHeight - 1) / formatAttribs.blockHeight;
+    return (numBlocksX * numBlocksY * extent.depth * formatAttribs.bitSize / 8);
+}
+
+std::uint64_t TextureStreamer::Pimpl::GetResidentSize(const TextureStreamerEntry& entry, std::uint32_t mipLevel) const
+{
+    std::uint64_t size = 0;
+    for_subrange(level, mipLevel, entry.desc.mipLevels)
+        size += GetMipDataSize(entry, level);
+    return size;
+}
+
+TextureRegion TextureStreamer::Pimpl::GetMipRegion(const TextureStreamerEntry& entry, std::uint32_t mipLevel, std::uint32_t baseMipLevel) const
+{
+    const Extent3D extent = GetMipExtent(entry.desc, mipLevel);
+    return TextureRegion
+    {
+        TextureSubresource{ 0, entry.desc.arrayLayers, mipLevel - baseMipLevel, 1 },
+        Offset3D{ 0, 0, 0 },
+        Extent3D{ extent.width, extent.height, 1 }
+    };
+}
+
+ResourceViewDescriptor TextureStreamer::Pimpl::GetResourceView(const TextureStreamerEntry& entry) const
+{
+    /* Non-sparse textures only contain their resident MIP-map levels */
+    if (!entry.sparse)
+        return ResourceViewDescriptor{ entry.texture };
+
+    /* Clamp sparse textures to their resident MIP-map levels, so shaders never sample uncommitted tiles */
+    TextureViewDescriptor viewDesc;
+    {
+        viewDesc.type                       = entry.desc.type;
+        viewDesc.format                     = entry.desc.format;
+        viewDesc.subresource.baseArrayLayer = 0;
+        viewDesc.subresource.numArrayLayers = entry.desc.arrayLayers;
+        viewDesc.subresource.baseMipLevel   = entry.residentMipLevel;
+        viewDesc.subresource.numMipLevels   = entry.desc.mipLevels - entry.residentMipLevel;
+    }
+    return ResourceViewDescriptor{ entry.texture, viewDesc };
+}
+
+// Creates a sparse texture with all MIP-map levels, or a non-sparse texture that begins with the specified MIP-map level.
+Texture* TextureStreamer::Pimpl::CreateHardwareTexture(const TextureStreamerEntry& entry, std::uint32_t baseMipLevel)
+{
+    TextureDescriptor textureDesc = entry.desc;
+    if (!entry.sparse)
+    {
+        const Extent3D extent = GetMipExtent(entry.desc, baseMipLevel);
+        textureDesc.extent.width    = extent.width;
+        textureDesc.extent.height   = extent.height;
+        textureDesc.mipLevels       = entry.desc.mipLevels - baseMipLevel;
+    }
+    return renderSystem.CreateTexture(textureDesc);
+}
+
+// Commits or releases the memory of the MIP-map levels in the half-open range [firstMipLevel, lastMipLevel) of a sparse texture.
+void TextureStreamer::Pimpl::UpdateMipResidency(TextureStreamerEntry& entry, std::uint32_t firstMipLevel, std::uint32_t lastMipLevel, bool resident)
+{
+    std::vector<TextureTileMapping> mappings;
+    mappings.reserve(lastMipLevel - firstMipLevel);
+
+    for_subrange(mipLevel, firstMipLevel, lastMipLevel)
+    {
+        TextureTileMapping mapping;
+        {
+            mapping.region      = GetMipRegion(entry, mipLevel, 0);
+            mapping.resident    = resident;
+        }
+        mappings.push_back(mapping);
+    }
+
+    if (!mappings.empty())
+        commandQueue->UpdateTileMappings(*entry.texture, static_cast<std::uint32_t>(mappings.size()), mappings.data());
+}
+
+void TextureStreamer::Pimpl::WriteMipLevel(TextureStreamerEntry& entry, std::uint32_t mipLevel, std::uint32_t baseMipLevel, const void* data, std::size_t dataSize)
+{
+    const SrcImageDescriptor imageDesc{ entry.imageFormat, entry.dataType, data, dataSize };
+    renderSystem.WriteTexture(*entry.texture, GetMipRegion(entry, mipLevel, baseMipLevel), imageDesc);
+}
+
+std::uint64_t TextureStreamer::Pimpl::ComputeEffectiveBudget()
+{
+    std::uint64_t budget = streamerDesc.memoryBudget;
+
+    if (streamerDesc.adaptToSystemBudget)
+    {
+        MemoryStatistics stats;
+        if (renderSystem.QueryMemoryStatistics(stats))
+        {
+            /* Limit budget to the streamed memory plus the headroom the driver reports; the usage already includes the streamed memory */
+            std::uint64_t headroom = 0;
+            bool hasSystemBudget = false;
+
+            for (const MemoryHeapStatistics& heap : stats.heaps)
+            {
+                if (heap.deviceLocal && heap.budget > 0)
+                {
+                    headroom += heap.budget - std::min(heap.usage, heap.budget);
+                    hasSystemBudget = true;
+                }
+            }
+
+            if (hasSystemBudget)
+            {
+                std::uint64_t residentSize = 0;
+                for (const TextureStreamerEntry& entry : entries)
+                {
+                    if (entry.texture != nullptr)
+                        residentSize += GetResidentSize(entry, entry.residentMipLevel);
+                }
+                budget = std::min(budget, residentSize + headroom);
+            }
+        }
+    }
+
+    return budget;
+}
+
+void TextureStreamer::Pimpl::AssignTargetMipLevels(std::uint64_t budget)
+{
+    /* Sort textures by priority; the MIP-map tails are always resident */
+    std::vector<std::uint32_t> order;
+    std::uint64_t usedSize = 0;
+
+    for_range(i, entries.size())
+    {
+        TextureStreamerEntry& entry = entries[i];
+        if (entry.texture != nullptr)
+        {
+            entry.targetMipLevel = entry.tailMipLevel;
+            usedSize += GetResidentSize(entry, entry.tailMipLevel);
+            order.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    std::stable_sort(
+        order.begin(), order.end(),
+        [this](std::uint32_t lhs, std::uint32_t rhs)
+        {
+            return (entries[lhs].priority > entries[rhs].priority);
+        }
+    );
+
+    /* Refine all textures by one MIP-map level per pass, so the budget is spread across all textures before single textures get their most detailed levels */
+    for (bool refined = true; refined;)
+    {
+        refined = false;
+        for (std::uint32_t i : order)
+        {
+            TextureStreamerEntry& entry = entries[i];
+            if (entry.priority <= 0.0f || entry.targetMipLevel <= entry.requestedMipLevel)
+                continue;
+
+            /* Skip levels that exceed the remaining budget or can never be staged */
+            const std::uint64_t size = GetMipDataSize(entry, entry.targetMipLevel - 1);
+            if (size > streamerDesc.uploadBudget || usedSize + size > budget)
+                continue;
+
+            usedSize += size;
+            entry.targetMipLevel--;
+            refined = true;
+        }
+    }
+}
+
+// Loads the texel data of MIP-map levels that are to be streamed in, in order of priority, until the upload budget is exhausted.
+void TextureStreamer::Pimpl::StageMipLevels(TextureStreamerBatch& batch, std::vector<TextureStreamerOperation>& operations)
+{
+    std::vector<std::uint32_t> order;
+    for_range(i, entries.size())
+    {
+        const TextureStreamerEntry& entry = entries[i];
+        if (entry.texture != nullptr && entry.targetMipLevel < entry.residentMipLevel)
+            order.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    if (order.empty())
+        return;
+
+    std::stable_sort(
+        order.begin(), order.end(),
+        [this](std::uint32_t lhs, std::uint32_t rhs)
+        {
+            return (entries[lhs].priority > entries[rhs].priority);
+        }
+    );
+
+    char*           stagingData     = nullptr;
+    std::uint64_t   stagingOffset   = 0;
+    std::uint64_t   uploadSize      = 0;
+
+    scratch.clear();
+
+    for (std::uint32_t i : order)
+    {
+        TextureStreamerEntry& entry = entries[i];
+
+        TextureStreamerOperation operation;
+        {
+            operation.entryIndex    = i;
+            operation.mipLevel      = entry.residentMipLevel;
+        }
+
+        /* Load levels from coarse to fine, since only a contiguous range of levels can be resident */
+        while (operation.mipLevel > entry.targetMipLevel)
+        {
+            const std::uint32_t mipLevel = operation.mipLevel - 1;
+            const std::uint64_t size = GetMipDataSize(entry, mipLevel);
+            if (uploadSize + size > streamerDesc.uploadBudget)
+                break;
+
+            TextureStreamerUpload upload{ mipLevel, 0, size };
+            void* dst = nullptr;
+
+            if (entry.compressed)
+            {
+                upload.offset = scratch.size();
+                scratch.resize(static_cast<std::size_t>(upload.offset + size));
+                dst = &scratch[static_cast<std::size_t>(upload.offset)];
+            }
+            else
+            {
+                upload.offset = AlignStagingOffset(stagingOffset);
+                if (upload.offset + size > streamerDesc.uploadBudget)
+                    break;
+
+                if (stagingData == nullptr)
+                {
+                    PrepareBatch(batch);
+                    stagingData = static_cast<char*>(renderSystem.MapBuffer(*batch.stagingBuffer, CPUAccess::WriteDiscard));
+                    if (stagingData == nullptr)
+                        break;
+                }
+                dst = stagingData + upload.offset;
+            }
+
+            if (!entry.loadFunc(mipLevel, dst, static_cast<std::size_t>(size)))
+            {
+                if (entry.compressed)
+                    scratch.resize(static_cast<std::size_t>(upload.offset));
+                break;
+            }
+
+            if (!entry.compressed)
+                stagingOffset = upload.offset + size;
+
+            uploadSize += size;
+            operation.uploads.push_back(upload);
+            operation.mipLevel = mipLevel;
+        }
+
+        if (!operation.uploads.empty())
+            operations.push_back(std::move(operation));
+    }
+
+    if (stagingData != nullptr)
+        renderSystem.UnmapBuffer(*batch.stagingBuffer);
+}
+
+void TextureStreamer::Pimpl::ApplyOperation(TextureStreamerBatch& batch, const TextureStreamerOperation& operation)
+{
+    TextureStreamerEntry& entry = entries[operation.entryIndex];
+
+    const std::uint32_t oldMipLevel = entry.residentMipLevel;
+    const std::uint32_t newMipLevel = operation.mipLevel;
+
+    if (newMipLevel < oldMipLevel)
+        uploadedSize += GetResidentSize(entry, newMipLevel) - GetResidentSize(entry, oldMipLevel);
+    else
+        evictedSize += GetResidentSize(entry, oldMipLevel) - GetResidentSize(entry, newMipLevel);
+
+    std::uint32_t baseMipLevel = 0;
+
+    if (entry.sparse)
+    {
+        /* Tile mappings are updated in submission order, so previously submitted command buffers still see evicted levels */
+        if (newMipLevel < oldMipLevel)
+            UpdateMipResidency(entry, newMipLevel, oldMipLevel, true);
+        else
+            UpdateMipResidency(entry, oldMipLevel, newMipLevel, false);
+    }
+    else
+    {
+        /* Re-create texture with the new resident levels and copy the levels that remain resident */
+        Texture* newTexture = CreateHardwareTexture(entry, newMipLevel);
+        LLGL_ASSERT_PTR(newTexture);
+
+        for_subrange(mipLevel, std::max(oldMipLevel, newMipLevel), entry.desc.mipLevels)
+        {
+            batch.commandBuffer->CopyTexture(
+                *newTexture,
+                TextureLocation{ Offset3D{ 0, 0, 0 }, 0, mipLevel - newMipLevel },
+                *entry.texture,
+                TextureLocation{ Offset3D{ 0, 0, 0 }, 0, mipLevel - oldMipLevel },
+                GetMipExtent(entry.desc, mipLevel)
+            );
+        }
+
+        batch.releasedTextures.push_back(entry.texture);
+        entry.texture   = newTexture;
+        baseMipLevel    = newMipLevel;
+    }
+
+    entry.residentMipLevel = newMipLevel;
+
+    for (const TextureStreamerUpload& upload : operation.uploads)
+    {
+        if (entry.compressed)
+            WriteMipLevel(entry, upload.mipLevel, baseMipLevel, &scratch[static_cast<std::size_t>(upload.offset)], static_cast<std::size_t>(upload.size));
+        else
+            batch.commandBuffer->CopyTextureFromBuffer(*entry.texture, GetMipRegion(entry, upload.mipLevel, baseMipLevel), *batch.stagingBuffer, upload.offset);
+    }
+}
+
+// Creates the command buffer, fence, and staging buffer of the specified batch on first use.
+void TextureStreamer::Pimpl::PrepareBatch(TextureStreamerBatch& batch)
+{
+    if (batch.commandBuffer == nullptr)
+    {
+        batch.commandBuffer = renderSystem.CreateCommandBuffer();
+        LLGL_ASSERT_PTR(batch.commandBuffer);
+    }
+    if (batch.fence == nullptr)
+    {
+        batch.fence = renderSystem.CreateFence();
+        LLGL_ASSERT_PTR(batch.fence);
+    }
+    if (batch.stagingBuffer == nullptr)
+    {
+        BufferDescriptor bufferDesc;
+        {
+            bufferDesc.size             = streamerDesc.uploadBudget;
+            bufferDesc.bindFlags        = BindFlags::CopySrc;
+            bufferDesc.cpuAccessFlags   = CPUAccessFlags::Write;
+            bufferDesc.miscFlags        = MiscFlags::HostVisible;
+        }
+        batch.stagingBuffer = renderSystem.CreateBuffer(bufferDesc);
+        LLGL_ASSERT_PTR(batch.stagingBuffer);
+    }
+}
+
+void TextureStreamer::Pimpl::RetireBatches(std::uint64_t timeout)
+{
+    for (TextureStreamerBatch& batch : batches)
+    {
+        if (batch.pending && commandQueue->WaitFence(*batch.fence, timeout))
+        {
+            for (Texture* texture : batch.releasedTextures)
+                renderSystem.Release(*texture);
+            batch.releasedTextures.clear();
+            batch.pending = false;
+        }
+    }
+}
+
+
+/*
+ * TextureStreamer class
+ */
+
+TextureStreamer::TextureStreamer(RenderSystem& renderSystem, const TextureStreamerDescriptor& streamerDesc) :
+    pimpl_ { new Pimpl{ renderSystem, streamerDesc } }
+{
+    LLGL_ASSERT_PTR(pimpl_->commandQueue);
+    LLGL_ASSERT(streamerDesc.numUploadsInFlight > 0, "texture streamer requires at least one upload in flight");
+    LLGL_ASSERT(streamerDesc.uploadBudget > 0, "texture streamer requires a non-zero upload budget");
+    pimpl_->sparseSupported = (streamerDesc.useSparse && renderSystem.GetRenderingCaps().features.hasSparseResources);
+    pimpl_->batches.resize(streamerDesc.numUploadsInFlight);
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    WaitIdle();
+    for (TextureStreamerEntry& entry : pimpl_->entries)
+    {
+        if (entry.texture != nullptr)
+            pimpl_->renderSystem.Release(*entry.texture);
+    }
+    for (Texture* texture : pimpl_->releasedTextures)
+        pimpl_->renderSystem.Release(*texture);
+    for (TextureStreamerBatch& batch : pimpl_->batches)
+    {
+        if (batch.commandBuffer != nullptr)
+            pimpl_->renderSystem.Release(*batch.commandBuffer);
+        if (batch.fence != nullptr)
+            pimpl_->renderSystem.Release(*batch.fence);
+        if (batch.stagingBuffer != nullptr)
+            pimpl_->renderSystem.Release(*batch.stagingBuffer);
+    }
+    delete pimpl_;
+}
+
+StreamedTexture TextureStreamer::CreateTexture(const TextureDescriptor& textureDesc, const TextureStreamingLoadFunction& loadFunc)
+{
+    LLGL_ASSERT(loadFunc != nullptr, "texture streaming requires a load function");
+
+    if (!(textureDesc.type == TextureType::Texture2D || textureDesc.type == TextureType::Texture2DArray))
+        return 0;
+
+    TextureStreamerEntry entry;
+    if (!GetPassthroughImageFormat(textureDesc.format, entry.imageFormat, entry.dataType))
+        return 0;
+
+    entry.desc              = textureDesc;
+    entry.desc.bindFlags    |= (BindFlags::Sampled | BindFlags::CopySrc | BindFlags::CopyDst);
+    entry.desc.miscFlags    = ((entry.desc.miscFlags | MiscFlags::NoInitialData) & ~MiscFlags::GenerateMips);
+    entry.desc.mipLevels    = NumMipLevels(textureDesc);
+    entry.loadFunc          = loadFunc;
+    entry.compressed        = IsCompressedFormat(textureDesc.format);
+
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+
+    /* Sparse textures cannot be exported, see MiscFlags::External */
+    entry.sparse = (pimpl_->sparseSupported && (entry.desc.miscFlags & (MiscFlags::External | MiscFlags::Transient)) == 0);
+    if (entry.sparse)
+        entry.desc.miscFlags |= MiscFlags::Sparse;
+
+    /* Find first level of the MIP-map tail */
+    while (entry.tailMipLevel + 1 < entry.desc.mipLevels)
+    {
+        const Extent3D extent = GetMipExtent(entry.desc, entry.tailMipLevel);
+        if (std::max(extent.width, extent.height) <= pimpl_->streamerDesc.mipTailSize)
+            break;
+        entry.tailMipLevel++;
+    }
+
+    entry.residentMipLevel  = entry.tailMipLevel;
+    entry.targetMipLevel    = entry.tailMipLevel;
+
+    entry.texture = pimpl_->CreateHardwareTexture(entry, entry.tailMipLevel);
+    if (entry.texture == nullptr)
+        return 0;
+
+    /* Load MIP-map tail immediately; this is small enough to avoid the staging buffers */
+    if (entry.sparse)
+        pimpl_->UpdateMipResidency(entry, entry.tailMipLevel, entry.desc.mipLevels, true);
+
+    const std::uint32_t baseMipLevel = (entry.sparse ? 0 : entry.tailMipLevel);
+    std::vector<char> data;
+
+    for_subrange(mipLevel, entry.tailMipLevel, entry.desc.mipLevels)
+    {
+        data.resize(static_cast<std::size_t>(pimpl_->GetMipDataSize(entry, mipLevel)));
+        if (!entry.loadFunc(mipLevel, data.data(), data.size()))
+        {
+            pimpl_->renderSystem.Release(*entry.texture);
+            return 0;
+        }
+        pimpl_->WriteMipLevel(entry, mipLevel, baseMipLevel, data.data(), data.size());
+    }
+
+    /* Store entry in a free slot */
+    StreamedTexture texture = 0;
+    if (!pimpl_->freeHandles.empty())
+    {
+        texture = pimpl_->freeHandles.back();
+        pimpl_->freeHandles.pop_back();
+        pimpl_->entries[texture - 1] = std::move(entry);
+    }
+    else
+    {
+        pimpl_->entries.push_back(std::move(entry));
+        texture = static_cast<StreamedTexture>(pimpl_->entries.size());
+    }
+
+    return texture;
+}
+
+void TextureStreamer::ReleaseTexture(StreamedTexture texture)
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    TextureStreamerEntry& entry = pimpl_->GetEntry(texture);
+
+    /* Defer release until the fence of the next update, which is submitted after all command buffers that may still use this texture */
+    pimpl_->releasedTextures.push_back(entry.texture);
+    entry = TextureStreamerEntry{};
+    pimpl_->freeHandles.push_back(texture);
+}
+
+void TextureStreamer::SetPriority(StreamedTexture texture, float priority, std::uint32_t mostDetailedMipLevel)
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    TextureStreamerEntry& entry = pimpl_->GetEntry(texture);
+    entry.priority          = priority;
+    entry.requestedMipLevel = std::min(mostDetailedMipLevel, entry.tailMipLevel);
+}
+
+void TextureStreamer::Update()
+{
+    std::unique_lock<std::mutex> guard{ pimpl_->mutex };
+
+    /* Recycle completed batches without blocking */
+    pimpl_->RetireBatches(0);
+
+    auto batchIt = std::find_if(
+        pimpl_->batches.begin(), pimpl_->batches.end(),
+        [](const TextureStreamerBatch& batch)
+        {
+            return !batch.pending;
+        }
+    );
+
+    if (batchIt == pimpl_->batches.end())
+        return;
+
+    TextureStreamerBatch& batch = *batchIt;
+
+    pimpl_->uploadedSize    = 0;
+    pimpl_->evictedSize     = 0;
+    pimpl_->effectiveBudget = pimpl_->ComputeEffectiveBudget();
+    pimpl_->AssignTargetMipLevels(pimpl_->effectiveBudget);
+
+    /* Evict levels first to free memory for the levels that are streamed in */
+    std::vector<TextureStreamerOperation> operations;
+    for_range(i, pimpl_->entries.size())
+    {
+        const TextureStreamerEntry& entry = pimpl_->entries[i];
+        if (entry.texture != nullptr && entry.targetMipLevel > entry.residentMipLevel)
+            operations.push_back(TextureStreamerOperation{ static_cast<std::uint32_t>(i), entry.targetMipLevel, {} });
+    }
+
+    pimpl_->StageMipLevels(batch, operations);
+
+    if (operations.empty() && pimpl_->releasedTextures.empty())
+        return;
+
+    /* Encode copies and submit them followed by the fence that retires the staging buffer and all released textures */
+    pimpl_->PrepareBatch(batch);
+
+    batch.commandBuffer->Begin();
+    {
+        for (const TextureStreamerOperation& operation : operations)
+            pimpl_->ApplyOperation(batch, operation);
+    }
+    batch.commandBuffer->End();
+
+    batch.releasedTextures.insert(batch.releasedTextures.end(), pimpl_->releasedTextures.begin(), pimpl_->releasedTextures.end());
+    pimpl_->releasedTextures.clear();
+
+    pimpl_->commandQueue->Submit(*batch.commandBuffer);
+    pimpl_->commandQueue->Submit(*batch.fence);
+    batch.pending = true;
+
+    /* Notify client about new resource views without holding the lock, so the callback can query this streamer */
+    if (pimpl_->streamerDesc.residencyChanged)
+    {
+        std::vector<std::pair<StreamedTexture, ResourceViewDescriptor>> resourceViews;
+        resourceViews.reserve(operations.size());
+        for (const TextureStreamerOperation& operation : operations)
+        {
+            const StreamedTexture texture = operation.entryIndex + 1;
+            resourceViews.emplace_back(texture, pimpl_->GetResourceView(pimpl_->entries[operation.entryIndex]));
+        }
+
+        guard.unlock();
+
+        for (const auto& resourceView : resourceViews)
+            pimpl_->streamerDesc.residencyChanged(resourceView.first, resourceView.second);
+    }
+}
+
+void TextureStreamer::WaitIdle()
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    pimpl_->RetireBatches(~0ull);
+}
+
+ResourceViewDescriptor TextureStreamer::GetResourceView(StreamedTexture texture) const
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    return pimpl_->GetResourceView(pimpl_->GetEntry(texture));
+}
+
+Texture* TextureStreamer::GetTexture(StreamedTexture texture) const
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    return pimpl_->GetEntry(texture).texture;
+}
+
+std::uint32_t TextureStreamer::GetResidentMipLevel(StreamedTexture texture) const
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+    return pimpl_->GetEntry(texture).residentMipLevel;
+}
+
+TextureStreamerStatistics TextureStreamer::GetStatistics() const
+{
+    std::lock_guard<std::mutex> guard{ pimpl_->mutex };
+
+    TextureStreamerStatistics stats;
+    {
+        for (const TextureStreamerEntry& entry : pimpl_->entries)
+        {
+            if (entry.texture == nullptr)
+                continue;
+            stats.numTextures++;
+            if (entry.sparse)
+                stats.numSparseTextures++;
+            if (entry.targetMipLevel < entry.residentMipLevel)
+                stats.numPendingTextures++;
+            stats.residentSize += pimpl_->GetResidentSize(entry, entry.residentMipLevel);
+        }
+        stats.effectiveBudget   = pimpl_->effectiveBudget;
+        stats.uploadedSize      = pimpl_->uploadedSize;
+        stats.evictedSize       = pimpl_->evictedSize;
+    }
+    return stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
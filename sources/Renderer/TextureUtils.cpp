@@ -111,6 +111,38 @@ LLGL_EXPORT bool MustGenerateMipsOnCreate(const TextureDescriptor& textureDesc)
     );
 }
 
+LLGL_EXPORT bool GetPassthroughImageFormat(const Format format, ImageFormat& outImageFormat, DataType& outDataType)
+{
+    const FormatAttributes& formatAttribs = GetFormatAttribs(format);
+    if (formatAttribs.bitSize == 0 || (formatAttribs.flags & (FormatFlags::HasDepth | FormatFlags::HasStencil | FormatFlags::IsPacked)) != 0)
+        return false;
+
+    if ((formatAttribs.flags & FormatFlags::IsCompressed) != 0)
+    {
+        /* Texel data of compressed formats is passed through by all backends, so only the block compression must match */
+        switch (format)
+        {
+            case Format::BC1UNorm:
+            case Format::BC1UNorm_sRGB: outImageFormat = ImageFormat::BC1; break;
+            case Format::BC2UNorm:
+            case Format::BC2UNorm_sRGB: outImageFormat = ImageFormat::BC2; break;
+            case Format::BC3UNorm:
+            case Format::BC3UNorm_sRGB: outImageFormat = ImageFormat::BC3; break;
+            case Format::BC4UNorm:
+            case Format::BC4SNorm:      outImageFormat = ImageFormat::BC4; break;
+            case Format::BC5UNorm:
+            case Format::BC5SNorm:      outImageFormat = ImageFormat::BC5; break;
+            default:                    return false;
+        }
+        outDataType = DataType::UInt8;
+        return true;
+    }
+
+    outImageFormat  = formatAttribs.format;
+    outDataType     = formatAttribs.dataType;
+    return true;
+}
+
 LLGL_EXPORT std::uint32_t GetClampedSamples(std::uint32_t samples)
 {
     return std::max(1u, std::min(samples, LLGL_MAX_NUM_SAMPLES));
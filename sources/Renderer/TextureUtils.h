@@ -71,6 +71,9 @@ LLGL_EXPORT SubresourceFootprint CalcPackedSubresourceFootprint(
 // Returns true if the specified flags for texture creation require MIP-map generation at creation time.
 LLGL_EXPORT bool MustGenerateMipsOnCreate(const TextureDescriptor& textureDesc);
 
+// Returns the image format and data type to pass texel data of the specified hardware format through to WriteTexture without conversion, or false if there is none.
+LLGL_EXPORT bool GetPassthroughImageFormat(const Format format, ImageFormat& outImageFormat, DataType& outDataType);
+
 // Returns the samples clamped to the range [1, LLGL_MAX_NUM_SAMPLES].
 LLGL_EXPORT std::uint32_t GetClampedSamples(std::uint32_t samples);
 
@@ -0,0 +1,56 @@
+/*
+ * TimestampUtils.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_TIMESTAMP_UTILS_H
+#define LLGL_TIMESTAMP_UTILS_H
+
+
+#include <LLGL/QueryHeapFlags.h>
+#include <LLGL/Timer.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Converts the specified number of CPU ticks of Timer::Frequency into nanoseconds.
+inline std::uint64_t CPUTicksToNanosecs(std::uint64_t ticks)
+{
+    const std::uint64_t frequency = Timer::Frequency();
+    return (ticks / frequency) * 1000000000ull + ((ticks % frequency) * 1000000000ull) / frequency;
+}
+
+/*
+Samples a GPU timestamp with the specified function and brackets it with two CPU timestamps.
+The output CPU timestamp is the midpoint of both CPU samples and their distance is the maximum deviation.
+The function must have the signature bool(std::uint64_t& outGPUTimestamp) and return false if no GPU timestamp could be sampled.
+*/
+template <typename TSampleGPUFunc>
+bool SampleCalibratedTimestamps(CalibratedTimestamps& outTimestamps, const TSampleGPUFunc& sampleGPUFunc)
+{
+    std::uint64_t gpuTimestamp = 0;
+    const std::uint64_t cpuTicksBegin = Timer::Tick();
+    if (!sampleGPUFunc(gpuTimestamp))
+        return false;
+    const std::uint64_t cpuTicksEnd = Timer::Tick();
+
+    outTimestamps.cpuTicks      = cpuTicksBegin + (cpuTicksEnd - cpuTicksBegin) / 2;
+    outTimestamps.gpuTimestamp  = gpuTimestamp;
+    outTimestamps.maxDeviation  = CPUTicksToNanosecs(cpuTicksEnd - cpuTicksBegin);
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
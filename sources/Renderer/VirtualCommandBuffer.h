@@ -34,10 +34,13 @@ struct DefaultBufferGrowPolicy
 };
 
 // Container class to manage the memory for virtual command buffers.
-template <typename TOpcode, typename TGrowPolicy = DefaultBufferGrowPolicy>
+// Opcodes and commands are padded to a multiple of 'TAlignment' bytes, so every command starts at an offset that is a multiple of this alignment.
+template <typename TOpcode, std::size_t TAlignment = 1, typename TGrowPolicy = DefaultBufferGrowPolicy>
 class VirtualCommandBuffer
 {
 
+        static_assert(TAlignment > 0 && (TAlignment & (TAlignment - 1)) == 0, "VirtualCommandBuffer alignment must be a power of two");
+
     private:
 
         // POD structure for the memory chunks. These chunks contain a payload at the end of the struct.
@@ -49,6 +52,40 @@ class VirtualCommandBuffer
             // <payload>
         };
 
+        static_assert(TAlignment <= alignof(Chunk), "VirtualCommandBuffer alignment must not exceed the alignment of its memory chunks");
+
+        // Thread-local free-list of memory chunks, so command buffers that are re-packed or re-created every frame don't hit the heap allocator each time.
+        // This must be trivially destructible, so it can still be accessed after its releaser has been destroyed at thread exit.
+        struct ChunkFreeList
+        {
+            static constexpr std::size_t maxNumChunks       = 32;
+            static constexpr std::size_t maxTotalCapacity   = 16u * 1024u * 1024u;
+
+            Chunk*      first           = nullptr;
+            std::size_t numChunks       = 0;
+            std::size_t totalCapacity   = 0;
+            bool        released        = false;
+        };
+
+        // Deletes all chunks of the thread-local free-list at thread exit.
+        struct ChunkFreeListReleaser
+        {
+            ChunkFreeList& freeList;
+
+            ~ChunkFreeListReleaser()
+            {
+                for (Chunk* c = freeList.first, *next = nullptr; c != nullptr; c = next)
+                {
+                    next = c->next;
+                    VirtualCommandBuffer::DeleteChunk(c);
+                }
+                freeList.first          = nullptr;
+                freeList.numChunks      = 0;
+                freeList.totalCapacity  = 0;
+                freeList.released       = true;
+            }
+        };
+
     public:
 
         // View structure for a chunk iterator.
@@ -133,17 +170,13 @@ class VirtualCommandBuffer
         // Takes the ownership of the specified virtual command buffer memory.
         VirtualCommandBuffer(VirtualCommandBuffer&& rhs)
         {
-            std::swap(first_, rhs.first_);
-            std::swap(current_, rhs.current_);
-            std::swap(size_, rhs.size_);
+            Swap(rhs);
         }
 
         // Takes the ownership of the specified virtual command buffer memory.
         VirtualCommandBuffer& operator = (VirtualCommandBuffer&& rhs)
         {
-            std::swap(first_, rhs.first_);
-            std::swap(current_, rhs.current_);
-            std::swap(size_, rhs.size_);
+            Swap(rhs);
             return *this;
         }
 
@@ -189,7 +222,7 @@ class VirtualCommandBuffer
             }
         }
 
-        // Deletes all memory chunks.
+        // Returns all memory chunks to the thread-local free-list or deletes them if the free-list is full.
         void Release()
         {
             for (Chunk* c = first_, *next = nullptr; c != nullptr; c = next)
@@ -204,7 +237,8 @@ class VirtualCommandBuffer
             size_       = 0;
         }
 
-        // Packs the entire buffer to one consecutive memory block.
+        // Packs the entire buffer to one consecutive memory block for better locality when the commands are replayed.
+        // The replaced chunks are returned to the thread-local free-list, so packing every frame does not allocate new memory in the steady state.
         void Pack()
         {
             /* Only pack if there is more than one memory chunk */
@@ -222,7 +256,7 @@ class VirtualCommandBuffer
         // Allocates a new opcode in this virtual command buffer.
         void AllocOpcode(const TOpcode opcode)
         {
-            char* data = AllocData(sizeof(opcode));
+            char* data = AllocData(OpcodeSize());
             *reinterpret_cast<TOpcode*>(data) = opcode;
         }
 
@@ -230,9 +264,23 @@ class VirtualCommandBuffer
         template <typename TCommand>
         TCommand* AllocCommand(const TOpcode opcode, std::size_t payloadSize = 0)
         {
-            char* data = AllocData(sizeof(opcode) + sizeof(TCommand) + payloadSize);
+            char* data = AllocData(OpcodeSize() + AlignSize(sizeof(TCommand) + payloadSize));
             *reinterpret_cast<TOpcode*>(data) = opcode;
-            return reinterpret_cast<TCommand*>(data + sizeof(opcode));
+            return reinterpret_cast<TCommand*>(data + OpcodeSize());
+        }
+
+    public:
+
+        // Returns the specified size (in bytes) rounded up to the command alignment. Command executors must advance their program counter by this size.
+        static constexpr std::size_t AlignSize(std::size_t size)
+        {
+            return ((size + TAlignment - 1) & ~(TAlignment - 1));
+        }
+
+        // Returns the size (in bytes) of an opcode including its padding, i.e. the offset from an opcode to its command.
+        static constexpr std::size_t OpcodeSize()
+        {
+            return AlignSize(sizeof(TOpcode));
         }
 
     public:
@@ -263,28 +311,80 @@ class VirtualCommandBuffer
 
     private:
 
-        // Allocates a new memory chunk of the specified capacity plus sizeof(Chunk).
+        // Returns the free-list of the calling thread.
+        static ChunkFreeList& GetChunkFreeList()
+        {
+            static thread_local ChunkFreeList           freeList;
+            static thread_local ChunkFreeListReleaser   releaser{ freeList };
+            return freeList;
+        }
+
+        // Takes the smallest chunk from the free-list that has at least the specified capacity. Larger chunks are only taken up to twice the requested capacity.
+        static Chunk* TakeChunkFromFreeList(std::size_t capacity)
+        {
+            ChunkFreeList& freeList = GetChunkFreeList();
+            if (freeList.released)
+                return nullptr;
+
+            Chunk** bestLink = nullptr;
+            for (Chunk** link = &(freeList.first); *link != nullptr; link = &((*link)->next))
+            {
+                const std::size_t linkCapacity = (*link)->capacity;
+                if (linkCapacity >= capacity && linkCapacity / 2 <= capacity && (bestLink == nullptr || linkCapacity < (*bestLink)->capacity))
+                    bestLink = link;
+            }
+
+            if (bestLink == nullptr)
+                return nullptr;
+
+            Chunk* chunk = *bestLink;
+            *bestLink = chunk->next;
+            freeList.numChunks      -= 1;
+            freeList.totalCapacity  -= chunk->capacity;
+            return chunk;
+        }
+
+        // Allocates a new memory chunk of at least the specified capacity plus sizeof(Chunk). Chunks are recycled from the thread-local free-list if possible.
         static Chunk* AllocChunk(std::size_t capacity, Chunk* next = nullptr)
         {
-            Chunk* chunk = reinterpret_cast<Chunk*>(::new std::uint8_t[sizeof(Chunk) + capacity]);
+            Chunk* chunk = VirtualCommandBuffer::TakeChunkFromFreeList(capacity);
+            if (chunk == nullptr)
             {
+                chunk = reinterpret_cast<Chunk*>(::new std::uint8_t[sizeof(Chunk) + capacity]);
                 chunk->capacity = capacity;
-                chunk->size     = 0;
-                chunk->next     = next;
             }
+            chunk->size = 0;
+            chunk->next = next;
             return chunk;
         }
 
-        // Deletes the specified memory chunk.
+        // Returns the specified memory chunk to the thread-local free-list or deletes it if the free-list is full.
         static void FreeChunk(Chunk* chunk)
         {
             if (chunk != nullptr)
             {
-                std::uint8_t* buf = reinterpret_cast<std::uint8_t*>(chunk);
-                delete [] buf;
+                ChunkFreeList& freeList = GetChunkFreeList();
+                if (!freeList.released &&
+                    freeList.numChunks < ChunkFreeList::maxNumChunks &&
+                    freeList.totalCapacity + chunk->capacity <= ChunkFreeList::maxTotalCapacity)
+                {
+                    chunk->next = freeList.first;
+                    freeList.first          = chunk;
+                    freeList.numChunks      += 1;
+                    freeList.totalCapacity  += chunk->capacity;
+                }
+                else
+                    VirtualCommandBuffer::DeleteChunk(chunk);
             }
         }
 
+        // Deletes the specified memory chunk.
+        static void DeleteChunk(Chunk* chunk)
+        {
+            std::uint8_t* buf = reinterpret_cast<std::uint8_t*>(chunk);
+            delete [] buf;
+        }
+
         // Returns a raw pointer to the beginning of the chunk data.
         static char* GetChunkData(Chunk* chunk)
         {
@@ -299,6 +399,17 @@ class VirtualCommandBuffer
 
     private:
 
+        // Swaps the memory and all its references with the specified virtual command buffer.
+        void Swap(VirtualCommandBuffer& rhs)
+        {
+            std::swap(first_, rhs.first_);
+            std::swap(current_, rhs.current_);
+            std::swap(biggest_, rhs.biggest_);
+            std::swap(capacity_, rhs.capacity_);
+            std::swap(size_, rhs.size_);
+            std::swap(initialCapacity_, rhs.initialCapacity_);
+        }
+
         // Returns whether the specified byte size fits into the current chunk.
         bool FitsIntoCurrentChunk(std::size_t size) const
         {
@@ -310,8 +421,8 @@ class VirtualCommandBuffer
         {
             current_->next = VirtualCommandBuffer::AllocChunk(capacity, next);
             current_ = current_->next;
-            capacity_ += capacity;
-            if (biggest_ == nullptr || capacity > biggest_->capacity)
+            capacity_ += current_->capacity;
+            if (biggest_ == nullptr || current_->capacity > biggest_->capacity)
                 biggest_ = current_;
         }
 
@@ -335,6 +446,7 @@ class VirtualCommandBuffer
                         Chunk* secondNext = current_->next->next;
                         if (biggest_ == current_->next)
                             biggest_ = secondNext;
+                        capacity_ -= current_->next->capacity;
                         VirtualCommandBuffer::FreeChunk(current_->next);
                         AllocNextChunkAndMakeCurrent(capacity, secondNext);
                     }
@@ -351,7 +463,7 @@ class VirtualCommandBuffer
                 first_      = VirtualCommandBuffer::AllocChunk(capacity);
                 current_    = first_;
                 biggest_    = first_;
-                capacity_   = capacity;
+                capacity_   = first_->capacity;
             }
         }
 
@@ -430,7 +542,7 @@ class VirtualCommandBuffer
             first_      = chunk;
             current_    = chunk;
             biggest_    = chunk;
-            capacity_   = chunk->size;
+            capacity_   = chunk->capacity;
         }
 
         // Packs the entire virtual command buffer into a new single memory chunk.
@@ -455,7 +567,7 @@ class VirtualCommandBuffer
             first_      = chunk;
             current_    = chunk;
             biggest_    = chunk;
-            capacity_   = chunk->size;
+            capacity_   = chunk->capacity;
         }
 
     private:
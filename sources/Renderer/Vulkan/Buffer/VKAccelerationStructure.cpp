@@ -0,0 +1,448 @@
+/*
+ * VKAccelerationStructure.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKAccelerationStructure.h"
+#include "VKBuffer.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include "../RenderState/VKBarrierAccumulator.h"
+#include "../Ext/VKExtensions.h"
+#include "../VKCore.h"
+#include "../VKTypes.h"
+#include "../../ContainerTypes.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Maximum number of instances that are converted on the stack per vkCmdUpdateBuffer; this is limited to 65536 bytes per command.
+static constexpr std::uint32_t g_maxInstancesPerUpdate = 256;
+
+static VkBuildAccelerationStructureFlagsKHR GetVkBuildAccelerationStructureFlags(long flags)
+{
+    VkBuildAccelerationStructureFlagsKHR vkFlags = 0;
+
+    if ((flags & AccelerationStructureFlags::AllowUpdate) != 0)
+        vkFlags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+    if ((flags & AccelerationStructureFlags::AllowCompaction) != 0)
+        vkFlags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+    if ((flags & AccelerationStructureFlags::PreferFastTrace) != 0)
+        vkFlags |= VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+    if ((flags & AccelerationStructureFlags::PreferFastBuild) != 0)
+        vkFlags |= VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR;
+
+    return vkFlags;
+}
+
+static VkAccelerationStructureTypeKHR GetVkAccelerationStructureType(const AccelerationStructureType type)
+{
+    return (type == AccelerationStructureType::TopLevel ? VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR : VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR);
+}
+
+static VkDeviceAddress GetVkBufferDeviceAddress(VkDevice device, VkBuffer buffer)
+{
+    VkBufferDeviceAddressInfoKHR addressInfo;
+    {
+        addressInfo.sType   = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+        addressInfo.pNext   = nullptr;
+        addressInfo.buffer  = buffer;
+    }
+    return vkGetBufferDeviceAddressKHR(device, &addressInfo);
+}
+
+static VkDeviceAddress GetBufferDeviceAddress(VkDevice device, Buffer* buffer, std::uint64_t offset)
+{
+    if (buffer == nullptr)
+        return 0;
+    auto* bufferVK = LLGL_CAST(VKBuffer*, buffer);
+    return GetVkBufferDeviceAddress(device, bufferVK->GetVkBuffer()) + static_cast<VkDeviceAddress>(offset);
+}
+
+// Converts the specified triangle geometry and returns its number of primitives. Buffer addresses are zero for null buffers, which is only valid for size queries.
+static std::uint32_t ConvertGeometry(VkAccelerationStructureGeometryKHR& dst, VkDevice device, const AccelerationStructureGeometryDescriptor& src)
+{
+    dst.sType                                       = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+    dst.pNext                                       = nullptr;
+    dst.geometryType                                = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+    dst.flags                                       = (src.opaque ? VK_GEOMETRY_OPAQUE_BIT_KHR : 0);
+
+    VkAccelerationStructureGeometryTrianglesDataKHR& triangles = dst.geometry.triangles;
+    triangles.sType                                 = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+    triangles.pNext                                 = nullptr;
+    triangles.vertexFormat                          = VKTypes::Map(src.vertexFormat);
+    triangles.vertexData.deviceAddress              = GetBufferDeviceAddress(device, src.vertexBuffer, src.vertexOffset);
+    triangles.vertexStride                          = static_cast<VkDeviceSize>(src.vertexStride);
+    triangles.maxVertex                             = (src.numVertices > 0 ? src.numVertices - 1 : 0);
+    triangles.transformData.deviceAddress           = 0;
+
+    if (src.indexBuffer != nullptr || src.numIndices > 0)
+    {
+        triangles.indexType                         = VKTypes::ToVkIndexType(src.indexFormat);
+        triangles.indexData.deviceAddress           = GetBufferDeviceAddress(device, src.indexBuffer, src.indexOffset);
+        return (src.numIndices / 3);
+    }
+    else
+    {
+        triangles.indexType                         = VK_INDEX_TYPE_NONE_KHR;
+        triangles.indexData.deviceAddress           = 0;
+        return (src.numVertices / 3);
+    }
+}
+
+static void ConvertInstanceGeometry(VkAccelerationStructureGeometryKHR& dst, VkDeviceAddress instanceAddress)
+{
+    dst.sType                                       = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+    dst.pNext                                       = nullptr;
+    dst.geometryType                                = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+    dst.flags                                       = 0;
+    dst.geometry.instances.sType                    = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+    dst.geometry.instances.pNext                    = nullptr;
+    dst.geometry.instances.arrayOfPointers          = VK_FALSE;
+    dst.geometry.instances.data.deviceAddress       = instanceAddress;
+}
+
+static void ConvertInstance(VkAccelerationStructureInstanceKHR& dst, const AccelerationStructureInstance& src)
+{
+    auto* blasVK = LLGL_CAST(VKAccelerationStructure*, src.accelerationStructure);
+    static_assert(sizeof(dst.transform.matrix) == sizeof(src.transform), "VkTransformMatrixKHR must have the same size as AccelerationStructureInstance::transform");
+    std::memcpy(dst.transform.matrix, src.transform, sizeof(src.transform));
+    dst.instanceCustomIndex                         = (src.instanceID & 0x00FFFFFFu);
+    dst.mask                                        = (src.mask & 0xFFu);
+    dst.instanceShaderBindingTableRecordOffset      = 0;
+    dst.flags                                       = static_cast<VkGeometryInstanceFlagsKHR>(src.flags & 0xFF); // Bits of AccelerationStructureInstanceFlags match VkGeometryInstanceFlagBitsKHR
+    dst.accelerationStructureReference              = blasVK->GetDeviceAddress();
+}
+
+VKAccelerationStructure::VKAccelerationStructure(
+    VkDevice                                                    device,
+    VKDeviceMemoryManager&                                      deviceMemoryManager,
+    const VkPhysicalDeviceAccelerationStructurePropertiesKHR&   properties,
+    const AccelerationStructureDescriptor&                      desc)
+:
+    AccelerationStructure { desc.type                                       },
+    device_               { device                                          },
+    memoryMngr_           { deviceMemoryManager                             },
+    accelStruct_          { device, vkDestroyAccelerationStructureKHR       },
+    buildFlags_           { GetVkBuildAccelerationStructureFlags(desc.flags) },
+    storageBuffer_        { device                                          },
+    scratchBuffer_        { device                                          },
+    instanceBuffer_       { device                                          },
+    compactedSizeQuery_   { device, vkDestroyQueryPool                      }
+{
+    if (desc.compactedSize > 0)
+    {
+        /* Compaction destinations are only written by vkCmdCopyAccelerationStructureKHR and don't need a scratch buffer */
+        CreateStorageBuffer(static_cast<VkDeviceSize>(desc.compactedSize));
+        CreateVkAccelerationStructure(static_cast<VkDeviceSize>(desc.compactedSize));
+        return;
+    }
+
+    /* Determine memory requirements with the maximum number of primitives */
+    SmallVector<VkAccelerationStructureGeometryKHR, 4u> geometries;
+    SmallVector<std::uint32_t, 4u> maxPrimitiveCounts;
+
+    if (desc.type == AccelerationStructureType::TopLevel)
+    {
+        CreateInstanceBuffer(desc.maxInstances);
+        geometries.resize(1);
+        ConvertInstanceGeometry(geometries[0], instanceAddress_);
+        maxPrimitiveCounts.push_back(desc.maxInstances);
+    }
+    else
+    {
+        geometries.resize(desc.geometries.size());
+        for_range(i, desc.geometries.size())
+            maxPrimitiveCounts.push_back(ConvertGeometry(geometries[i], device, desc.geometries[i]));
+    }
+
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo = {};
+    {
+        buildInfo.sType         = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+        buildInfo.type          = GetVkAccelerationStructureType(desc.type);
+        buildInfo.flags         = buildFlags_;
+        buildInfo.mode          = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        buildInfo.geometryCount = static_cast<std::uint32_t>(geometries.size());
+        buildInfo.pGeometries   = geometries.data();
+    }
+    VkAccelerationStructureBuildSizesInfoKHR sizeInfo = {};
+    sizeInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+    vkGetAccelerationStructureBuildSizesKHR(device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, maxPrimitiveCounts.data(), &sizeInfo);
+
+    /* Create storage and a single scratch buffer that is large enough for both builds and updates */
+    CreateStorageBuffer(sizeInfo.accelerationStructureSize);
+    CreateScratchBuffer(
+        std::max(sizeInfo.buildScratchSize, sizeInfo.updateScratchSize),
+        static_cast<VkDeviceSize>(properties.minAccelerationStructureScratchOffsetAlignment)
+    );
+    CreateVkAccelerationStructure(sizeInfo.accelerationStructureSize);
+
+    if ((desc.flags & AccelerationStructureFlags::AllowCompaction) != 0)
+        CreateCompactedSizeQuery();
+}
+
+VKAccelerationStructure::~VKAccelerationStructure()
+{
+    accelStruct_.Release();
+    storageBuffer_.ReleaseMemoryRegion(memoryMngr_);
+    scratchBuffer_.ReleaseMemoryRegion(memoryMngr_);
+    instanceBuffer_.ReleaseMemoryRegion(memoryMngr_);
+}
+
+std::uint64_t VKAccelerationStructure::GetCompactedSize()
+{
+    if (compactedSizeQuery_.Get() == VK_NULL_HANDLE)
+        return 0;
+
+    /* Don't wait for the query, since the size is only available after the command buffer has been completed */
+    VkDeviceSize compactedSize = 0;
+    VkResult result = vkGetQueryPoolResults(
+        device_,
+        compactedSizeQuery_,
+        0,
+        1,
+        sizeof(compactedSize),
+        &compactedSize,
+        sizeof(compactedSize),
+        VK_QUERY_RESULT_64_BIT
+    );
+    return (result == VK_SUCCESS ? static_cast<std::uint64_t>(compactedSize) : 0);
+}
+
+void VKAccelerationStructure::Build(VkCommandBuffer commandBuffer, VKBarrierAccumulator& barriers, const AccelerationStructureBuildDescriptor& buildDesc)
+{
+    SmallVector<VkAccelerationStructureGeometryKHR, 4u> geometries;
+    SmallVector<VkAccelerationStructureBuildRangeInfoKHR, 4u> buildRanges;
+
+    if (GetType() == AccelerationStructureType::TopLevel)
+    {
+        WriteInstances(commandBuffer, barriers, buildDesc.instances);
+        geometries.resize(1);
+        ConvertInstanceGeometry(geometries[0], instanceAddress_);
+        buildRanges.push_back(VkAccelerationStructureBuildRangeInfoKHR{ static_cast<std::uint32_t>(buildDesc.instances.size()), 0, 0, 0 });
+    }
+    else
+    {
+        geometries.resize(buildDesc.geometries.size());
+        for_range(i, buildDesc.geometries.size())
+        {
+            const std::uint32_t numPrimitives = ConvertGeometry(geometries[i], device_, buildDesc.geometries[i]);
+            buildRanges.push_back(VkAccelerationStructureBuildRangeInfoKHR{ numPrimitives, 0, 0, 0 });
+        }
+    }
+
+    /* Updates read the previous build of the same acceleration structure */
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo;
+    {
+        buildInfo.sType                     = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+        buildInfo.pNext                     = nullptr;
+        buildInfo.type                      = GetVkAccelerationStructureType(GetType());
+        buildInfo.flags                     = buildFlags_;
+        buildInfo.mode                      = (buildDesc.update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
+        buildInfo.srcAccelerationStructure  = (buildDesc.update ? accelStruct_.Get() : VK_NULL_HANDLE);
+        buildInfo.dstAccelerationStructure  = accelStruct_.Get();
+        buildInfo.geometryCount             = static_cast<std::uint32_t>(geometries.size());
+        buildInfo.pGeometries               = geometries.data();
+        buildInfo.ppGeometries              = nullptr;
+        buildInfo.scratchData.deviceAddress = scratchAddress_;
+    }
+    const VkAccelerationStructureBuildRangeInfoKHR* buildRangeInfos = buildRanges.data();
+
+    barriers.Flush(commandBuffer);
+    vkCmdBuildAccelerationStructuresKHR(commandBuffer, 1, &buildInfo, &buildRangeInfos);
+
+    /* Subsequent builds, copies, and shaders read this acceleration structure; the next build of this acceleration structure also reuses its scratch buffer */
+    barriers.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+        VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR | VK_ACCESS_SHADER_READ_BIT
+    );
+
+    if (compactedSizeQuery_.Get() != VK_NULL_HANDLE)
+        WriteCompactedSize(commandBuffer, barriers);
+}
+
+void VKAccelerationStructure::Copy(VkCommandBuffer commandBuffer, VKBarrierAccumulator& barriers, VKAccelerationStructure& source, bool compact)
+{
+    VkCopyAccelerationStructureInfoKHR copyInfo;
+    {
+        copyInfo.sType  = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+        copyInfo.pNext  = nullptr;
+        copyInfo.src    = source.GetVkAccelerationStructure();
+        copyInfo.dst    = GetVkAccelerationStructure();
+        copyInfo.mode   = (compact ? VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR : VK_COPY_ACCELERATION_STRUCTURE_MODE_CLONE_KHR);
+    }
+    barriers.Flush(commandBuffer);
+    vkCmdCopyAccelerationStructureKHR(commandBuffer, &copyInfo);
+
+    barriers.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+        VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_SHADER_READ_BIT
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKAccelerationStructure::CreateStorageBuffer(VkDeviceSize size)
+{
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = size;
+        createInfo.usage                    = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    storageBuffer_.CreateVkBufferAndMemoryRegion(device_, createInfo, memoryMngr_, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
+void VKAccelerationStructure::CreateScratchBuffer(VkDeviceSize size, VkDeviceSize alignment)
+{
+    /* Allocate additional space to align the scratch address, since the buffer offset is only aligned to the memory requirements */
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = size + alignment;
+        createInfo.usage                    = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    scratchBuffer_.CreateVkBufferAndMemoryRegion(device_, createInfo, memoryMngr_, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    scratchAddress_ = GetAlignedSize<VkDeviceAddress>(GetVkBufferDeviceAddress(device_, scratchBuffer_.GetVkBuffer()), alignment);
+}
+
+void VKAccelerationStructure::CreateInstanceBuffer(std::uint32_t maxInstances)
+{
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = std::max<VkDeviceSize>(1u, maxInstances) * sizeof(VkAccelerationStructureInstanceKHR);
+        createInfo.usage                    = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    instanceBuffer_.CreateVkBufferAndMemoryRegion(device_, createInfo, memoryMngr_, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    instanceAddress_ = GetVkBufferDeviceAddress(device_, instanceBuffer_.GetVkBuffer());
+}
+
+void VKAccelerationStructure::CreateCompactedSizeQuery()
+{
+    VkQueryPoolCreateInfo createInfo;
+    {
+        createInfo.sType                = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.pNext                = nullptr;
+        createInfo.flags                = 0;
+        createInfo.queryType            = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+        createInfo.queryCount           = 1;
+        createInfo.pipelineStatistics   = 0;
+    }
+    VkResult result = vkCreateQueryPool(device_, &createInfo, nullptr, compactedSizeQuery_.ReleaseAndGetAddressOf());
+    VKThrowIfCreateFailed(result, "VkQueryPool", "for compacted acceleration structure size");
+}
+
+void VKAccelerationStructure::CreateVkAccelerationStructure(VkDeviceSize size)
+{
+    VkAccelerationStructureCreateInfoKHR createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+        createInfo.pNext            = nullptr;
+        createInfo.createFlags      = 0;
+        createInfo.buffer           = storageBuffer_.GetVkBuffer();
+        createInfo.offset           = 0;
+        createInfo.size             = size;
+        createInfo.type             = GetVkAccelerationStructureType(GetType());
+        createInfo.deviceAddress    = 0;
+    }
+    VkResult result = vkCreateAccelerationStructureKHR(device_, &createInfo, nullptr, accelStruct_.ReleaseAndGetAddressOf());
+    VKThrowIfCreateFailed(result, "VkAccelerationStructureKHR");
+
+    VkAccelerationStructureDeviceAddressInfoKHR addressInfo;
+    {
+        addressInfo.sType                   = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+        addressInfo.pNext                   = nullptr;
+        addressInfo.accelerationStructure   = accelStruct_.Get();
+    }
+    deviceAddress_ = vkGetAccelerationStructureDeviceAddressKHR(device_, &addressInfo);
+}
+
+void VKAccelerationStructure::WriteInstances(VkCommandBuffer commandBuffer, VKBarrierAccumulator& barriers, const ArrayView<AccelerationStructureInstance>& instances)
+{
+    if (instances.empty())
+        return;
+
+    VkBuffer instanceBuffer = instanceBuffer_.GetVkBuffer();
+    barriers.FlushForTransfer(commandBuffer, VK_NULL_HANDLE, instanceBuffer);
+
+    /* Convert and upload instances in chunks, since vkCmdUpdateBuffer is limited to 65536 bytes */
+    VkAccelerationStructureInstanceKHR instancesVK[g_maxInstancesPerUpdate];
+    for (std::size_t first = 0; first < instances.size(); first += g_maxInstancesPerUpdate)
+    {
+        const std::size_t count = std::min<std::size_t>(instances.size() - first, g_maxInstancesPerUpdate);
+        for_range(i, count)
+            ConvertInstance(instancesVK[i], instances[first + i]);
+        vkCmdUpdateBuffer(
+            commandBuffer,
+            instanceBuffer,
+            static_cast<VkDeviceSize>(first * sizeof(VkAccelerationStructureInstanceKHR)),
+            static_cast<VkDeviceSize>(count * sizeof(VkAccelerationStructureInstanceKHR)),
+            instancesVK
+        );
+    }
+
+    barriers.InsertBufferBarrier(
+        instanceBuffer,
+        0,
+        static_cast<VkDeviceSize>(instances.size() * sizeof(VkAccelerationStructureInstanceKHR)),
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT
+    );
+}
+
+void VKAccelerationStructure::WriteCompactedSize(VkCommandBuffer commandBuffer, VKBarrierAccumulator& barriers)
+{
+    /* Properties can only be written once the build has finished, so flush the barrier that was inserted after the build */
+    barriers.Flush(commandBuffer);
+    vkCmdResetQueryPool(commandBuffer, compactedSizeQuery_, 0, 1);
+
+    VkAccelerationStructureKHR accelStruct = accelStruct_.Get();
+    vkCmdWriteAccelerationStructuresPropertiesKHR(
+        commandBuffer,
+        1,
+        &accelStruct,
+        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+        compactedSizeQuery_,
+        0
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,109 @@
+/*
+ * VKAccelerationStructure.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_ACCELERATION_STRUCTURE_H
+#define LLGL_VK_ACCELERATION_STRUCTURE_H
+
+
+#include <LLGL/AccelerationStructure.h>
+#include "VKDeviceBuffer.h"
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+
+
+namespace LLGL
+{
+
+
+class VKDeviceMemoryManager;
+class VKBarrierAccumulator;
+
+/*
+Vulkan acceleration structure (see VK_KHR_acceleration_structure).
+The acceleration structure, its scratch buffer, and the instance buffer of top-level acceleration structures are allocated once at creation time
+with the sizes reported by vkGetAccelerationStructureBuildSizesKHR, so builds and updates never allocate memory.
+*/
+class VKAccelerationStructure final : public AccelerationStructure
+{
+
+    public:
+
+        std::uint64_t GetCompactedSize() override;
+
+    public:
+
+        VKAccelerationStructure(
+            VkDevice                                                    device,
+            VKDeviceMemoryManager&                                      deviceMemoryManager,
+            const VkPhysicalDeviceAccelerationStructurePropertiesKHR&   properties,
+            const AccelerationStructureDescriptor&                      desc
+        );
+        ~VKAccelerationStructure();
+
+        /*
+        Records the build or update of this acceleration structure, including the upload of its instances for top-level acceleration structures.
+        Barriers for the build results are inserted into the specified accumulator, so subsequent builds and shaders can read them.
+        */
+        void Build(VkCommandBuffer commandBuffer, VKBarrierAccumulator& barriers, const AccelerationStructureBuildDescriptor& buildDesc);
+
+        // Records a copy from the specified acceleration structure into this one, which is compacted if 'compact' is true.
+        void Copy(VkCommandBuffer commandBuffer, VKBarrierAccumulator& barriers, VKAccelerationStructure& source, bool compact);
+
+        // Returns the native VkAccelerationStructureKHR handle.
+        inline VkAccelerationStructureKHR GetVkAccelerationStructure() const
+        {
+            return accelStruct_.Get();
+        }
+
+        // Returns the device address that is referenced by instances of top-level acceleration structures.
+        inline VkDeviceAddress GetDeviceAddress() const
+        {
+            return deviceAddress_;
+        }
+
+    private:
+
+        void CreateStorageBuffer(VkDeviceSize size);
+        void CreateScratchBuffer(VkDeviceSize size, VkDeviceSize alignment);
+        void CreateInstanceBuffer(std::uint32_t maxInstances);
+        void CreateCompactedSizeQuery();
+        void CreateVkAccelerationStructure(VkDeviceSize size);
+
+        // Uploads the instances into the instance buffer with vkCmdUpdateBuffer.
+        void WriteInstances(VkCommandBuffer commandBuffer, VKBarrierAccumulator& barriers, const ArrayView<AccelerationStructureInstance>& instances);
+
+        // Writes the compacted size of this acceleration structure into the query pool once the build has finished.
+        void WriteCompactedSize(VkCommandBuffer commandBuffer, VKBarrierAccumulator& barriers);
+
+    private:
+
+        VkDevice                                device_             = VK_NULL_HANDLE;
+        VKDeviceMemoryManager&                  memoryMngr_;
+
+        VKPtr<VkAccelerationStructureKHR>       accelStruct_;
+        VkDeviceAddress                         deviceAddress_      = 0;
+        VkBuildAccelerationStructureFlagsKHR    buildFlags_         = 0;
+
+        VKDeviceBuffer                          storageBuffer_;
+        VKDeviceBuffer                          scratchBuffer_;
+        VkDeviceAddress                         scratchAddress_     = 0;
+        VKDeviceBuffer                          instanceBuffer_;
+        VkDeviceAddress                         instanceAddress_    = 0;
+
+        VKPtr<VkQueryPool>                      compactedSizeQuery_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
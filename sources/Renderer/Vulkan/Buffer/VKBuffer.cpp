@@ -9,16 +9,27 @@
 #include "../VKCore.h"
 #include "../VKTypes.h"
 #include "../VKDevice.h"
+#include "../VKCommandQueue.h"
+#include "../Memory/VKSparseTileMap.h"
+#include "../Memory/VKDeviceMemoryRegion.h"
+#include "../Memory/VKExternalHandle.h"
 #include "../Ext/VKExtensions.h"
 #include "../Ext/VKExtensionRegistry.h"
 #include "../../ResourceUtils.h"
+#include "../../BufferUtils.h"
 #include "../../../Core/Exception.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+// Size (in bytes) of the transform feedback counter that is stored after the content of each stream-output buffer.
+static constexpr VkDeviceSize g_soCounterSize = sizeof(std::uint32_t);
+
 static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
 {
     VkBufferUsageFlags flags = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
@@ -38,8 +49,8 @@ static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
     {
         if (HasExtension(VKExt::EXT_transform_feedback))
         {
-            /* Enable transform feedback with extension VK_EXT_transform_feedback */
-            flags |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
+            /* Enable transform feedback with extension VK_EXT_transform_feedback; the counter is stored in the same buffer */
+            flags |= (VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT | VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_COUNTER_BUFFER_BIT_EXT);
         }
         else
         {
@@ -51,38 +62,104 @@ static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
     if ((desc.cpuAccessFlags & CPUAccessFlags::Read) != 0 || (desc.bindFlags & BindFlags::CopySrc) != 0)
         flags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 
+    if ((desc.bindFlags & BindFlags::DeviceAddress) != 0)
+    {
+        if (HasExtension(VKExt::KHR_buffer_device_address))
+        {
+            /* Enable shader access via GPU virtual address with extension VK_KHR_buffer_device_address */
+            flags |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
+        }
+        else
+        {
+            /* Error: feature not supported due to missing extension */
+            LLGL_TRAP("buffer device address not supported by Vulkan renderer");
+        }
+    }
+
+    /* Vertex, index, and storage buffers can be used as geometry input for acceleration structure builds, which requires their device addresses */
+    if ((desc.bindFlags & (BindFlags::VertexBuffer | BindFlags::IndexBuffer | BindFlags::Storage)) != 0 && HasExtension(VKExt::KHR_acceleration_structure))
+        flags |= (VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR);
+
     return flags;
 }
 
-VKBuffer::VKBuffer(VkDevice device, const BufferDescriptor& desc) :
+// Returns true if the buffer memory can be exported via RenderSystem::ExportMemoryHandle.
+static bool IsExportableBuffer(const BufferDescriptor& desc)
+{
+    return ((desc.miscFlags & (MiscFlags::External | MiscFlags::Sparse)) == MiscFlags::External && VKIsExternalMemorySupported());
+}
+
+VKBuffer::VKBuffer(const VKDevice& device, const BufferDescriptor& desc) :
     Buffer            { desc.bindFlags },
     bufferObj_        { device         },
     bufferObjStaging_ { device         },
-    size_             { desc.size      }
+    size_             { desc.size      },
+    hostVisible_      { IsHostVisibleBuffer(desc) },
+    readback_         { IsReadbackBuffer(desc)    },
+    exportable_       { IsExportableBuffer(desc)  }
 {
     if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
         indexType_ = VKTypes::ToVkIndexType(desc.format);
+    if (!desc.vertexAttribs.empty())
+        vertexStride_ = desc.vertexAttribs.front().stride;
 
+    /* Reserve space for the transform feedback counter behind the buffer content; counter offsets must be 4-byte aligned */
+    VkDeviceSize internalSize = desc.size;
+    if ((desc.bindFlags & BindFlags::StreamOutputBuffer) != 0)
+    {
+        soCounterOffset_    = GetAlignedSize<VkDeviceSize>(desc.size, g_soCounterSize);
+        internalSize        = soCounterOffset_ + g_soCounterSize;
+    }
+
+    VkExternalMemoryBufferCreateInfoKHR externalInfo;
+    {
+        externalInfo.sType                  = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO_KHR;
+        externalInfo.pNext                  = nullptr;
+        externalInfo.handleTypes            = VKGetExternalMemoryHandleType();
+    }
     VkBufferCreateInfo createInfo;
     {
         createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
-        createInfo.flags                    = 0;
-        createInfo.size                     = desc.size;
+        createInfo.pNext                    = (exportable_ ? &externalInfo : nullptr);
+        createInfo.flags                    = ((desc.miscFlags & MiscFlags::Sparse) != 0 ? VK_BUFFER_CREATE_SPARSE_BINDING_BIT | VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT : 0);
+        createInfo.size                     = internalSize;
         createInfo.usage                    = GetVkBufferUsageFlags(desc);
-        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
-        createInfo.queueFamilyIndexCount    = 0;
-        createInfo.pQueueFamilyIndices      = nullptr;
+
+        /* Share buffer between all queue families, so it can be used by the compute and copy queues without ownership transfers */
+        const ArrayView<std::uint32_t> sharedQueueFamilies = device.GetSharedQueueFamilies();
+        if (sharedQueueFamilies.size() > 1)
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount    = static_cast<std::uint32_t>(sharedQueueFamilies.size());
+            createInfo.pQueueFamilyIndices      = sharedQueueFamilies.data();
+        }
+        else
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
     }
     bufferObj_.CreateVkBuffer(device, createInfo);
 }
 
+VKBuffer::~VKBuffer()
+{
+    // dummy
+}
+
 BufferDescriptor VKBuffer::GetDesc() const
 {
     BufferDescriptor bufferDesc;
 
     bufferDesc.size             = GetSize();
     bufferDesc.bindFlags        = GetBindFlags();
+    if (IsSparse())
+        bufferDesc.miscFlags    = MiscFlags::Sparse;
+    else if (IsHostVisible())
+        bufferDesc.miscFlags    = MiscFlags::HostVisible;
+    if (IsExportable())
+        bufferDesc.miscFlags    |= MiscFlags::External;
     #if 0//TODO
     bufferDesc.cpuAccessFlags   = 0;
     bufferDesc.miscFlags        = 0;
@@ -91,9 +168,15 @@ BufferDescriptor VKBuffer::GetDesc() const
     return bufferDesc;
 }
 
+std::uint64_t VKBuffer::GetDeviceAddress() const
+{
+    return deviceAddress_;
+}
+
 void VKBuffer::BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion)
 {
     bufferObj_.BindMemoryRegion(device, memoryRegion);
+    QueryDeviceAddress(device);
 }
 
 void VKBuffer::TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer)
@@ -101,8 +184,98 @@ void VKBuffer::TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer)
     bufferObjStaging_ = std::move(deviceBuffer);
 }
 
+void VKBuffer::CreateSparseTileMap(VKDeviceMemoryManager& deviceMemoryMngr)
+{
+    sparseTileMap_ = MakeUnique<VKSparseTileMap>(deviceMemoryMngr, bufferObj_.GetRequirements());
+
+    /* Device address of a sparse buffer is valid without memory being bound to it */
+    QueryDeviceAddress(deviceMemoryMngr.GetVkDevice());
+}
+
+void VKBuffer::UpdateTileMappings(VKCommandQueue& commandQueue, std::uint32_t numMappings, const BufferTileMapping* mappings)
+{
+    if (!IsSparse())
+        return;
+
+    const VkDeviceSize tileSize = sparseTileMap_->GetTileSize();
+    const VkDeviceSize numTiles = (GetSize() + tileSize - 1) / tileSize;
+
+    std::vector<VkSparseMemoryBind>     binds;
+    std::vector<VKDeviceMemoryRegion*>  retiredRegions;
+
+    for_range(i, numMappings)
+    {
+        const BufferTileMapping& mapping = mappings[i];
+
+        /* Determine range of tiles: rounded outwards if made resident and inwards otherwise */
+        const VkDeviceSize end = std::min<VkDeviceSize>(mapping.offset + mapping.size, GetSize());
+        VkDeviceSize beginTile = 0, endTile = 0;
+        if (mapping.resident)
+        {
+            beginTile   = mapping.offset / tileSize;
+            endTile     = (end + tileSize - 1) / tileSize;
+        }
+        else
+        {
+            beginTile   = (mapping.offset + tileSize - 1) / tileSize;
+            endTile     = (end == GetSize() ? numTiles : end / tileSize);
+        }
+        endTile = std::min(endTile, numTiles);
+
+        for (VkDeviceSize tile = beginTile; tile < endTile; ++tile)
+        {
+            /* Allocate a new tile or retire the old one; memory regions of retired tiles are released once the unbinding has completed */
+            VKDeviceMemoryRegion* region = nullptr;
+            if (mapping.resident)
+            {
+                region = sparseTileMap_->AllocTile(tile);
+                if (region == nullptr)
+                    continue;
+            }
+            else
+            {
+                VKDeviceMemoryRegion* retiredRegion = sparseTileMap_->RemoveTile(tile);
+                if (retiredRegion == nullptr)
+                    continue;
+                retiredRegions.push_back(retiredRegion);
+            }
+
+            VkSparseMemoryBind bind;
+            {
+                bind.resourceOffset = tile * tileSize;
+                bind.size           = std::min(tileSize, bufferObj_.GetRequirements().size - tile * tileSize);
+                bind.memory         = (region != nullptr ? region->GetParentChunk()->GetVkDeviceMemory() : VK_NULL_HANDLE);
+                bind.memoryOffset   = (region != nullptr ? region->GetOffset() : 0);
+                bind.flags          = 0;
+            }
+            binds.push_back(bind);
+        }
+    }
+
+    if (binds.empty())
+        return;
+
+    VkSparseBufferMemoryBindInfo bufferBindInfo;
+    {
+        bufferBindInfo.buffer       = GetVkBuffer();
+        bufferBindInfo.bindCount    = static_cast<std::uint32_t>(binds.size());
+        bufferBindInfo.pBinds       = binds.data();
+    }
+    VkBindSparseInfo bindInfo = {};
+    {
+        bindInfo.sType              = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+        bindInfo.bufferBindCount    = 1;
+        bindInfo.pBufferBinds       = &bufferBindInfo;
+    }
+    commandQueue.BindSparseMemory(bindInfo, retiredRegions);
+}
+
 void* VKBuffer::Map(VKDevice& device, const CPUAccess access, VkDeviceSize offset, VkDeviceSize length)
 {
+    /* Map host-visible buffer directly, since the GPU accesses the same memory */
+    if (IsHostVisible())
+        return bufferObj_.Map(device);
+
     if (auto stagingBuffer = GetStagingVkBuffer())
     {
         /* Copy GPU local buffer into staging buffer for read accces */
@@ -123,6 +296,13 @@ void* VKBuffer::Map(VKDevice& device, const CPUAccess access, VkDeviceSize offse
 
 void VKBuffer::Unmap(VKDevice& device)
 {
+    /* Host-visible buffers are allocated with coherent memory, so no copy or flush is required */
+    if (IsHostVisible())
+    {
+        bufferObj_.Unmap(device);
+        return;
+    }
+
     if (auto stagingBuffer = GetStagingVkBuffer())
     {
         /* Unmap staging buffer */
@@ -141,6 +321,25 @@ void VKBuffer::Unmap(VKDevice& device)
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void VKBuffer::QueryDeviceAddress(VkDevice device)
+{
+    if ((GetBindFlags() & BindFlags::DeviceAddress) != 0)
+    {
+        VkBufferDeviceAddressInfoKHR addressInfo;
+        {
+            addressInfo.sType   = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+            addressInfo.pNext   = nullptr;
+            addressInfo.buffer  = GetVkBuffer();
+        }
+        deviceAddress_ = vkGetBufferDeviceAddressKHR(device, &addressInfo);
+    }
+}
+
+
 } // /namespace LLGL
 
 
@@ -12,6 +12,7 @@
 #include <LLGL/Buffer.h>
 #include "VKDeviceBuffer.h"
 #include "../Memory/VKDeviceMemory.h"
+#include <memory>
 
 
 namespace LLGL
@@ -19,6 +20,9 @@ namespace LLGL
 
 
 class VKDevice;
+class VKCommandQueue;
+class VKSparseTileMap;
+class VKDeviceMemoryManager;
 
 class VKBuffer : public Buffer
 {
@@ -27,13 +31,22 @@ class VKBuffer : public Buffer
 
         BufferDescriptor GetDesc() const override;
 
+        std::uint64_t GetDeviceAddress() const override;
+
     public:
 
-        VKBuffer(VkDevice device, const BufferDescriptor& desc);
+        VKBuffer(const VKDevice& device, const BufferDescriptor& desc);
+        ~VKBuffer();
 
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
         void TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer);
 
+        // Creates the tile map for a sparse buffer, which is bound to device memory per tile instead of a single memory region.
+        void CreateSparseTileMap(VKDeviceMemoryManager& deviceMemoryMngr);
+
+        // Binds or unbinds device memory for the tiles of this sparse buffer.
+        void UpdateTileMappings(VKCommandQueue& commandQueue, std::uint32_t numMappings, const BufferTileMapping* mappings);
+
         void* Map(VKDevice& device, const CPUAccess access, VkDeviceSize offset, VkDeviceSize length);
         void Unmap(VKDevice& device);
 
@@ -79,21 +92,76 @@ class VKBuffer : public Buffer
             return size_;
         }
 
+        // Returns the stride (in bytes) of the first vertex attribute specified at creation time, or 0 if there are no vertex attributes.
+        inline std::uint32_t GetVertexStride() const
+        {
+            return vertexStride_;
+        }
+
+        // Returns true if this buffer was created with BindFlags::StreamOutputBuffer and stores a transform feedback counter.
+        inline bool HasSOCounter() const
+        {
+            return (soCounterOffset_ != VK_WHOLE_SIZE);
+        }
+
+        // Returns the offset (in bytes) of the transform feedback counter within this buffer. Only valid if HasSOCounter() returns true.
+        inline VkDeviceSize GetSOCounterOffset() const
+        {
+            return soCounterOffset_;
+        }
+
         // Returns the VkIndexType specified at creation time.
         inline VkIndexType GetIndexType() const
         {
             return indexType_;
         }
 
+        // Returns true if this buffer was created with the MiscFlags::Sparse flag.
+        inline bool IsSparse() const
+        {
+            return (sparseTileMap_ != nullptr);
+        }
+
+        // Returns true if this buffer is bound to host-visible memory and is mapped directly, i.e. without staging buffer.
+        inline bool IsHostVisible() const
+        {
+            return hostVisible_;
+        }
+
+        // Returns true if this buffer is a host-visible buffer with CPU read access only, i.e. its memory is preferably host-cached.
+        inline bool IsReadback() const
+        {
+            return readback_;
+        }
+
+        // Returns true if this buffer was created with MiscFlags::External and is bound to its own exportable device memory.
+        inline bool IsExportable() const
+        {
+            return exportable_;
+        }
+
     private:
 
-        VKDeviceBuffer  bufferObj_;
-        VKDeviceBuffer  bufferObjStaging_;
+        // Queries the device address if this buffer has been created with BindFlags::DeviceAddress.
+        void QueryDeviceAddress(VkDevice device);
+
+    private:
+
+        VKDeviceBuffer                      bufferObj_;
+        VKDeviceBuffer                      bufferObjStaging_;
+
+        VkDeviceSize                        size_                   = 0;
+        VkDeviceSize                        mappedWriteRange_[2]    = { 0, 0 };
 
-        VkDeviceSize    size_                   = 0;
-        VkDeviceSize    mappedWriteRange_[2]    = { 0, 0 };
+        VkDeviceAddress                     deviceAddress_          = 0;
+        VkDeviceSize                        soCounterOffset_        = VK_WHOLE_SIZE;
+        VkIndexType                         indexType_              = VK_INDEX_TYPE_MAX_ENUM;
+        std::uint32_t                       vertexStride_           = 0;
+        bool                                hostVisible_            = false;
+        bool                                readback_               = false;
+        bool                                exportable_             = false;
 
-        VkIndexType     indexType_              = VK_INDEX_TYPE_MAX_ENUM;
+        std::unique_ptr<VKSparseTileMap>    sparseTileMap_;                     // Only created for sparse buffers
 
 };
 
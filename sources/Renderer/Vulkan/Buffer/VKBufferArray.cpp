@@ -25,6 +25,8 @@ VKBufferArray::VKBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArr
 
     while (auto next = NextArrayResource<VKBuffer>(numBuffers, bufferArray))
     {
+        if (firstBuffer_ == nullptr)
+            firstBuffer_ = next;
         buffers_.push_back(next->GetVkBuffer());
         offsets_.push_back(0);//next->GetOffset()
     }
@@ -20,6 +20,7 @@ namespace LLGL
 
 
 class Buffer;
+class VKBuffer;
 
 class VKBufferArray final : public BufferArray
 {
@@ -40,10 +41,17 @@ class VKBufferArray final : public BufferArray
             return offsets_;
         }
 
+        // Returns the first buffer of this array, which is used as source for stream-output draw commands.
+        inline VKBuffer* GetFirstBuffer() const
+        {
+            return firstBuffer_;
+        }
+
     private:
 
         std::vector<VkBuffer>       buffers_;
         std::vector<VkDeviceSize>   offsets_;
+        VKBuffer*                   firstBuffer_    = nullptr;
 
 };
 
@@ -0,0 +1,278 @@
+/*
+ * VKIndirectArgumentCompactor.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKIndirectArgumentCompactor.h"
+#include "VKBuffer.h"
+#include "../VKCore.h"
+#include "../RenderState/VKBarrierAccumulator.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
+#include <stdint.h>
+
+#ifdef LLGL_VK_ENABLE_BUILTIN_SHADERS
+#   include "CompactIndirectArguments.comp.spv.h"
+#endif
+
+
+namespace LLGL
+{
+
+
+// Push constants of the CompactIndirectArguments compute shader. All offsets and the stride are in 32-bit words.
+struct VKIndirectArgumentCompactionConstants
+{
+    std::uint32_t   numCommands;
+    std::uint32_t   stride;
+    std::uint32_t   dstOffset;
+    std::uint32_t   countOffset;
+    std::uint32_t   srcOffset;
+    std::uint32_t   visibilityOffset;
+};
+
+// Number of draw commands that are tested by each work group.
+static constexpr std::uint32_t g_compactionGroupSize = 64;
+
+// Number of storage buffers the compute shader binds: destination, count, source, and visibility.
+static constexpr std::uint32_t g_compactionNumBuffers = 4;
+
+VKIndirectArgumentCompactor& VKIndirectArgumentCompactor::Get()
+{
+    static VKIndirectArgumentCompactor instance;
+    return instance;
+}
+
+void VKIndirectArgumentCompactor::InitializeDevice(VkDevice device, VkPipelineCache pipelineCache)
+{
+    Clear();
+
+    #ifdef LLGL_VK_ENABLE_BUILTIN_SHADERS
+
+    /* Storage buffers are pushed directly, so the compaction does not interfere with the descriptor sets of the client */
+    if (!HasExtension(VKExt::KHR_push_descriptor))
+        return;
+
+    CreateDescriptorSetLayout(device);
+    CreatePipelineLayout(device);
+    CreateComputePipeline(device, pipelineCache, g_spirvCompactIndirectArguments, sizeof(g_spirvCompactIndirectArguments));
+
+    #endif // /LLGL_VK_ENABLE_BUILTIN_SHADERS
+}
+
+void VKIndirectArgumentCompactor::Clear()
+{
+    pipeline_.Release();
+    pipelineLayout_.Release();
+    descriptorSetLayout_.Release();
+}
+
+bool VKIndirectArgumentCompactor::IsAvailable() const
+{
+    return (pipeline_.Get() != VK_NULL_HANDLE);
+}
+
+// Returns the specified byte offset in 32-bit words.
+static std::uint32_t ToWordOffset(VkDeviceSize offset)
+{
+    return static_cast<std::uint32_t>(offset / sizeof(std::uint32_t));
+}
+
+void VKIndirectArgumentCompactor::CompactIndirectArguments(
+    VkCommandBuffer         commandBuffer,
+    VKBarrierAccumulator&   barriers,
+    VKBuffer&               dstBuffer,
+    VkDeviceSize            dstOffset,
+    VKBuffer&               countBuffer,
+    VkDeviceSize            countOffset,
+    VKBuffer&               srcBuffer,
+    VkDeviceSize            srcOffset,
+    VKBuffer&               visibilityBuffer,
+    VkDeviceSize            visibilityOffset,
+    std::uint32_t           numCommands,
+    std::uint32_t           stride)
+{
+    if (!IsAvailable())
+        return;
+
+    /*
+    Wait for previous indirect commands that read the count and for previous writes to the source arguments and visibility bitmask,
+    e.g. from a culling compute shader, before the count is reset and the compute shader reads its inputs.
+    */
+    barriers.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_MEMORY_WRITE_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+    barriers.Flush(commandBuffer);
+
+    /* Reset count to zero; the compute shader only increments it */
+    const VkBuffer countBufferVK = countBuffer.GetVkBuffer();
+    vkCmdFillBuffer(commandBuffer, countBufferVK, countOffset, sizeof(std::uint32_t), 0);
+
+    if (numCommands > 0)
+    {
+        barriers.InsertBufferBarrier(
+            countBufferVK,
+            countOffset,
+            sizeof(std::uint32_t),
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+        );
+        barriers.Flush(commandBuffer);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_);
+
+        /* Push all buffers as a whole, since their offsets are not necessarily aligned to minStorageBufferOffsetAlignment */
+        VkDescriptorBufferInfo bufferInfos[g_compactionNumBuffers];
+        {
+            bufferInfos[0] = VkDescriptorBufferInfo{ dstBuffer.GetVkBuffer(),        0, VK_WHOLE_SIZE };
+            bufferInfos[1] = VkDescriptorBufferInfo{ countBufferVK,                  0, VK_WHOLE_SIZE };
+            bufferInfos[2] = VkDescriptorBufferInfo{ srcBuffer.GetVkBuffer(),        0, VK_WHOLE_SIZE };
+            bufferInfos[3] = VkDescriptorBufferInfo{ visibilityBuffer.GetVkBuffer(), 0, VK_WHOLE_SIZE };
+        }
+
+        VkWriteDescriptorSet writes[g_compactionNumBuffers];
+        for (std::uint32_t i = 0; i < g_compactionNumBuffers; ++i)
+        {
+            writes[i].sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].pNext             = nullptr;
+            writes[i].dstSet            = VK_NULL_HANDLE;
+            writes[i].dstBinding        = i;
+            writes[i].dstArrayElement   = 0;
+            writes[i].descriptorCount   = 1;
+            writes[i].descriptorType    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pImageInfo        = nullptr;
+            writes[i].pBufferInfo       = &bufferInfos[i];
+            writes[i].pTexelBufferView  = nullptr;
+        }
+        vkCmdPushDescriptorSetKHR(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0, g_compactionNumBuffers, writes);
+
+        VKIndirectArgumentCompactionConstants constants;
+        {
+            constants.numCommands       = numCommands;
+            constants.stride            = stride / sizeof(std::uint32_t);
+            constants.dstOffset         = ToWordOffset(dstOffset);
+            constants.countOffset       = ToWordOffset(countOffset);
+            constants.srcOffset         = ToWordOffset(srcOffset);
+            constants.visibilityOffset  = ToWordOffset(visibilityOffset);
+        }
+        vkCmdPushConstants(commandBuffer, pipelineLayout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+
+        /* Dispatch one invocation per draw command */
+        vkCmdDispatch(commandBuffer, (numCommands + g_compactionGroupSize - 1) / g_compactionGroupSize, 1, 1);
+    }
+
+    /* Make compacted arguments and count visible to subsequent indirect commands; this is recorded before the next draw or dispatch */
+    barriers.InsertMemoryBarrier(
+        (numCommands > 0 ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT),
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        (numCommands > 0 ? VK_ACCESS_SHADER_WRITE_BIT : VK_ACCESS_TRANSFER_WRITE_BIT),
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKIndirectArgumentCompactor::CreateDescriptorSetLayout(VkDevice device)
+{
+    /* Create push descriptor set layout with destination, count, source, and visibility buffers */
+    VkDescriptorSetLayoutBinding bindings[g_compactionNumBuffers];
+    for (std::uint32_t i = 0; i < g_compactionNumBuffers; ++i)
+    {
+        bindings[i].binding             = i;
+        bindings[i].descriptorType      = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount     = 1;
+        bindings[i].stageFlags          = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[i].pImmutableSamplers  = nullptr;
+    }
+    VkDescriptorSetLayoutCreateInfo createInfo;
+    {
+        createInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        createInfo.pNext        = nullptr;
+        createInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+        createInfo.bindingCount = g_compactionNumBuffers;
+        createInfo.pBindings    = bindings;
+    }
+    descriptorSetLayout_ = VKPtr<VkDescriptorSetLayout>{ device, vkDestroyDescriptorSetLayout };
+    VkResult result = vkCreateDescriptorSetLayout(device, &createInfo, nullptr, descriptorSetLayout_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor set layout for indirect argument compaction");
+}
+
+void VKIndirectArgumentCompactor::CreatePipelineLayout(VkDevice device)
+{
+    const VkDescriptorSetLayout setLayout = descriptorSetLayout_.Get();
+
+    VkPushConstantRange pushConstantRange;
+    {
+        pushConstantRange.stageFlags    = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset        = 0;
+        pushConstantRange.size          = sizeof(VKIndirectArgumentCompactionConstants);
+    }
+    VkPipelineLayoutCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.setLayoutCount           = 1;
+        createInfo.pSetLayouts              = &setLayout;
+        createInfo.pushConstantRangeCount   = 1;
+        createInfo.pPushConstantRanges      = &pushConstantRange;
+    }
+    pipelineLayout_ = VKPtr<VkPipelineLayout>{ device, vkDestroyPipelineLayout };
+    VkResult result = vkCreatePipelineLayout(device, &createInfo, nullptr, pipelineLayout_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline layout for indirect argument compaction");
+}
+
+void VKIndirectArgumentCompactor::CreateComputePipeline(VkDevice device, VkPipelineCache pipelineCache, const std::uint32_t* code, std::size_t codeSize)
+{
+    /* Create temporary shader module; it is no longer needed once the pipeline has been created */
+    VKPtr<VkShaderModule> shaderModule{ device, vkDestroyShaderModule };
+    {
+        VkShaderModuleCreateInfo createInfo;
+        {
+            createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            createInfo.pNext    = nullptr;
+            createInfo.flags    = 0;
+            createInfo.codeSize = codeSize;
+            createInfo.pCode    = code;
+        }
+        VkResult result = vkCreateShaderModule(device, &createInfo, nullptr, shaderModule.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan shader module for indirect argument compaction");
+    }
+
+    VkComputePipelineCreateInfo createInfo;
+    {
+        createInfo.sType                        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        createInfo.pNext                        = nullptr;
+        createInfo.flags                        = 0;
+        createInfo.stage.sType                  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        createInfo.stage.pNext                  = nullptr;
+        createInfo.stage.flags                  = 0;
+        createInfo.stage.stage                  = VK_SHADER_STAGE_COMPUTE_BIT;
+        createInfo.stage.module                 = shaderModule.Get();
+        createInfo.stage.pName                  = "main";
+        createInfo.stage.pSpecializationInfo    = nullptr;
+        createInfo.layout                       = pipelineLayout_.Get();
+        createInfo.basePipelineHandle           = VK_NULL_HANDLE;
+        createInfo.basePipelineIndex            = 0;
+    }
+    pipeline_ = VKPtr<VkPipeline>{ device, vkDestroyPipeline };
+    VkResult result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, pipeline_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan compute pipeline for indirect argument compaction");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,99 @@
+/*
+ * VKIndirectArgumentCompactor.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_INDIRECT_ARGUMENT_COMPACTOR_H
+#define LLGL_VK_INDIRECT_ARGUMENT_COMPACTOR_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class VKBuffer;
+class VKBarrierAccumulator;
+
+/*
+Vulkan indirect argument compactor singleton.
+Copies the arguments of all visible draw commands into a destination buffer and counts them with a compute shader,
+so the result can be consumed by vkCmdDrawIndirectCount without CPU readback.
+*/
+class VKIndirectArgumentCompactor
+{
+
+    public:
+
+        // Returns the singleton instance.
+        static VKIndirectArgumentCompactor& Get();
+
+    public:
+
+        VKIndirectArgumentCompactor(const VKIndirectArgumentCompactor&) = delete;
+        VKIndirectArgumentCompactor& operator = (const VKIndirectArgumentCompactor&) = delete;
+
+        VKIndirectArgumentCompactor(VKIndirectArgumentCompactor&&) = delete;
+        VKIndirectArgumentCompactor& operator = (VKIndirectArgumentCompactor&&) = delete;
+
+        // Creates the compute pipeline if the device supports push descriptors.
+        void InitializeDevice(VkDevice device, VkPipelineCache pipelineCache);
+
+        // Releases all Vulkan objects (used by VKRenderSystem).
+        void Clear();
+
+        // Returns true if the compute pipeline has been created. See RenderingFeatures::hasIndirectArgumentCompaction.
+        bool IsAvailable() const;
+
+        /*
+        Records the commands to reset the count and compact the indirect arguments with the visibility bitmask.
+        All offsets and the stride are in bytes and must be multiples of 4. This replaces the compute pipeline binding of the command buffer.
+        A barrier is inserted into the accumulator, so that subsequent indirect commands can read the arguments and the count.
+        */
+        void CompactIndirectArguments(
+            VkCommandBuffer         commandBuffer,
+            VKBarrierAccumulator&   barriers,
+            VKBuffer&               dstBuffer,
+            VkDeviceSize            dstOffset,
+            VKBuffer&               countBuffer,
+            VkDeviceSize            countOffset,
+            VKBuffer&               srcBuffer,
+            VkDeviceSize            srcOffset,
+            VKBuffer&               visibilityBuffer,
+            VkDeviceSize            visibilityOffset,
+            std::uint32_t           numCommands,
+            std::uint32_t           stride
+        );
+
+    private:
+
+        VKIndirectArgumentCompactor() = default;
+
+        void CreateDescriptorSetLayout(VkDevice device);
+        void CreatePipelineLayout(VkDevice device);
+        void CreateComputePipeline(VkDevice device, VkPipelineCache pipelineCache, const std::uint32_t* code, std::size_t codeSize);
+
+    private:
+
+        VKPtr<VkDescriptorSetLayout>    descriptorSetLayout_;
+        VKPtr<VkPipelineLayout>         pipelineLayout_;
+        VKPtr<VkPipeline>               pipeline_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,308 @@
+/*
+ * VKStagingRing.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKStagingRing.h"
+#include "../VKDevice.h"
+#include "../VKCore.h"
+#include "../Texture/VKTexture.h"
+#include "../../../Core/CoreUtils.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+static std::uint32_t FindStagingMemoryType(const VkPhysicalDeviceMemoryProperties& memoryProperties)
+{
+    return VKFindMemoryType(
+        memoryProperties,
+        ~0u,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    );
+}
+
+VKStagingRing::VKStagingRing(
+    VKDevice&                               device,
+    const VkPhysicalDeviceMemoryProperties& memoryProperties,
+    VkDeviceSize                            size)
+:
+    device_ { device                                                    },
+    memory_ { device, size, FindStagingMemoryType(memoryProperties)     },
+    buffer_ { device                                                    },
+    size_   { size                                                      }
+{
+    /* Create buffer object that spans the entire ring and bind it to the dedicated memory chunk */
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = size;
+        createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    buffer_.CreateVkBuffer(device, createInfo);
+
+    auto result = vkBindBufferMemory(device, buffer_.GetVkBuffer(), memory_.GetVkDeviceMemory(), 0);
+    VKThrowIfFailed(result, "failed to bind Vulkan staging ring buffer to device memory");
+
+    /* Map ring persistently, since this memory chunk is not shared with any other resource */
+    mappedData_ = reinterpret_cast<char*>(memory_.Map(device, 0, VK_WHOLE_SIZE));
+
+    /* Create one fence per batch; fences are created in signaled state so the first wait never blocks */
+    for (Batch& batch : batches_)
+    {
+        batch.fence = VKPtr<VkFence>{ device, vkDestroyFence };
+        VkFenceCreateInfo fenceInfo;
+        {
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            fenceInfo.pNext = nullptr;
+            fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        }
+        result = vkCreateFence(device, &fenceInfo, nullptr, batch.fence.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan fence for staging ring");
+
+        batch.commandBuffer = device.AllocCommandBuffer(false);
+    }
+}
+
+VKStagingRing::~VKStagingRing()
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+
+    WaitIdle();
+    for (Batch& batch : batches_)
+        vkFreeCommandBuffers(device_, device_.GetVkCommandPool(), 1, &batch.commandBuffer);
+    memory_.Unmap(device_);
+}
+
+bool VKStagingRing::Fits(VkDeviceSize dataSize) const
+{
+    /* Leave enough space for alignment padding at the end of the ring */
+    return (dataSize > 0 && dataSize <= size_ / 2);
+}
+
+void VKStagingRing::WriteBuffer(
+    VkBuffer        dstBuffer,
+    VkDeviceSize    dstOffset,
+    const void*     data,
+    VkDeviceSize    dataSize)
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+
+    /* Copy data into ring and record copy command */
+    const VkDeviceSize srcOffset = Allocate(dataSize, 4);
+    ::memcpy(mappedData_ + srcOffset, data, static_cast<std::size_t>(dataSize));
+
+    VkBufferCopy region;
+    {
+        region.srcOffset    = srcOffset;
+        region.dstOffset    = dstOffset;
+        region.size         = dataSize;
+    }
+    vkCmdCopyBuffer(GetRecordingCommandBuffer(), buffer_.GetVkBuffer(), dstBuffer, 1, &region);
+}
+
+void VKStagingRing::WriteImage(
+    VKTexture&                  dstTexture,
+    const VkOffset3D&           offset,
+    const VkExtent3D&           extent,
+    const TextureSubresource&   subresource,
+    const void*                 data,
+    VkDeviceSize                dataSize,
+    VkDeviceSize                alignment)
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+
+    /* Copy image data into ring */
+    const VkDeviceSize srcOffset = Allocate(dataSize, alignment);
+    ::memcpy(mappedData_ + srcOffset, data, static_cast<std::size_t>(dataSize));
+
+    /* Record image layout transitions and copy command */
+    VkCommandBuffer cmdBuffer = GetRecordingCommandBuffer();
+
+    VkImageLayout oldLayout = dstTexture.TransitionImageLayout(device_, cmdBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresource);
+    {
+        VkBufferImageCopy region;
+        {
+            region.bufferOffset                     = srcOffset;
+            region.bufferRowLength                  = 0;
+            region.bufferImageHeight                = 0;
+            region.imageSubresource.aspectMask      = dstTexture.GetAspectFlags();
+            region.imageSubresource.mipLevel        = subresource.baseMipLevel;
+            region.imageSubresource.baseArrayLayer  = subresource.baseArrayLayer;
+            region.imageSubresource.layerCount      = subresource.numArrayLayers;
+            region.imageOffset                      = offset;
+            region.imageExtent                      = extent;
+        }
+        vkCmdCopyBufferToImage(cmdBuffer, buffer_.GetVkBuffer(), dstTexture.GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+    dstTexture.TransitionImageLayout(device_, cmdBuffer, oldLayout, subresource);
+}
+
+void VKStagingRing::Flush()
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+
+    if (!recording_)
+        return;
+
+    Batch& batch = batches_[batchIndex_];
+
+    /*
+    Make all transfer writes of this batch visible to every command that comes later in submission order.
+    The second synchronization scope of a pipeline barrier includes subsequent submissions on the same queue.
+    */
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+    }
+    vkCmdPipelineBarrier(
+        batch.commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+
+    auto result = vkEndCommandBuffer(batch.commandBuffer);
+    VKThrowIfFailed(result, "failed to end recording Vulkan staging ring command buffer");
+
+    /* Submit batch without waiting for its completion */
+    VkSubmitInfo submitInfo = {};
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &(batch.commandBuffer);
+    }
+    result = vkQueueSubmit(device_.GetVkQueue(), 1, &submitInfo, batch.fence);
+    VKThrowIfFailed(result, "failed to submit Vulkan staging ring command buffer");
+
+    batch.head      = head_;
+    batch.inFlight  = true;
+    recording_      = false;
+    batchIndex_     = (batchIndex_ + 1) % maxNumBatches;
+}
+
+void VKStagingRing::WaitIdle()
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+
+    Flush();
+    while (batches_[oldestBatch_].inFlight)
+        RetireBatches(true);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VkDeviceSize VKStagingRing::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    for (;;)
+    {
+        RetireBatches(false);
+
+        /* Skip the remainder of the ring if the region would wrap around its end */
+        std::uint64_t offset = GetAlignedSize<std::uint64_t>(head_ % size_, alignment);
+        std::uint64_t padding = offset - (head_ % size_);
+
+        if (offset + size > size_)
+        {
+            padding += (size_ - offset);
+            offset = 0;
+        }
+
+        if (GetUsedSize() + padding + size <= size_)
+        {
+            head_ += padding + size;
+            return offset;
+        }
+
+        /* Ring is full: submit the current batch and wait for the oldest one to be completed */
+        if (recording_ && !batches_[oldestBatch_].inFlight)
+            Flush();
+        RetireBatches(true);
+    }
+}
+
+VkCommandBuffer VKStagingRing::GetRecordingCommandBuffer()
+{
+    Batch& batch = batches_[batchIndex_];
+
+    if (!recording_)
+    {
+        /* Wait until this batch slot has been completed before it can be recorded again */
+        if (batch.inFlight)
+        {
+            vkWaitForFences(device_, 1, batch.fence.GetAddressOf(), VK_TRUE, UINT64_MAX);
+            RetireBatches(false);
+        }
+
+        vkResetFences(device_, 1, batch.fence.GetAddressOf());
+
+        VkCommandBufferBeginInfo beginInfo;
+        {
+            beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.pNext             = nullptr;
+            beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo  = nullptr;
+        }
+        auto result = vkBeginCommandBuffer(batch.commandBuffer, &beginInfo);
+        VKThrowIfFailed(result, "failed to begin recording Vulkan staging ring command buffer");
+
+        recording_ = true;
+    }
+
+    return batch.commandBuffer;
+}
+
+void VKStagingRing::RetireBatches(bool wait)
+{
+    while (batches_[oldestBatch_].inFlight)
+    {
+        Batch& batch = batches_[oldestBatch_];
+
+        /* Only block on the oldest batch and only once */
+        VkResult result;
+        if (wait)
+        {
+            result = vkWaitForFences(device_, 1, batch.fence.GetAddressOf(), VK_TRUE, UINT64_MAX);
+            wait = false;
+        }
+        else
+            result = vkGetFenceStatus(device_, batch.fence);
+
+        if (result != VK_SUCCESS)
+            break;
+
+        /* Reclaim memory of completed batch */
+        tail_           = batch.head;
+        batch.inFlight  = false;
+        oldestBatch_    = (oldestBatch_ + 1) % maxNumBatches;
+    }
+
+    /* Reset ring positions when all memory has been reclaimed to reduce wrap-around padding */
+    if (!recording_ && head_ == tail_ && !batches_[oldestBatch_].inFlight)
+        head_ = tail_ = 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
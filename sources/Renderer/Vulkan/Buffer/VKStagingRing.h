@@ -0,0 +1,146 @@
+/*
+ * VKStagingRing.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_STAGING_RING_H
+#define LLGL_VK_STAGING_RING_H
+
+
+#include <LLGL/TextureFlags.h>
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include "VKDeviceBuffer.h"
+#include "../Memory/VKDeviceMemory.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKTexture;
+
+/*
+Persistently mapped staging ring buffer for deferred uploads.
+All copy commands are batched into a single transfer command buffer that is submitted to the graphics queue
+on the next call to Flush(), i.e. before any other command buffer is submitted, without waiting for its completion.
+Memory of a batch is reclaimed as soon as its fence has been signaled.
+All public functions are synchronized with the queue mutex of the device.
+*/
+class VKStagingRing
+{
+
+    public:
+
+        VKStagingRing(
+            VKDevice&                               device,
+            const VkPhysicalDeviceMemoryProperties& memoryProperties,
+            VkDeviceSize                            size
+        );
+
+        ~VKStagingRing();
+
+        VKStagingRing(const VKStagingRing&) = delete;
+        VKStagingRing& operator = (const VKStagingRing&) = delete;
+
+        // Returns true if the specified data size can be written into this staging ring at all.
+        bool Fits(VkDeviceSize dataSize) const;
+
+        // Writes the specified data into the ring and records a copy command into the destination buffer.
+        void WriteBuffer(
+            VkBuffer        dstBuffer,
+            VkDeviceSize    dstOffset,
+            const void*     data,
+            VkDeviceSize    dataSize
+        );
+
+        // Writes the specified image data into the ring and records a copy command into the destination texture.
+        void WriteImage(
+            VKTexture&                  dstTexture,
+            const VkOffset3D&           offset,
+            const VkExtent3D&           extent,
+            const TextureSubresource&   subresource,
+            const void*                 data,
+            VkDeviceSize                dataSize,
+            VkDeviceSize                alignment
+        );
+
+        // Submits the pending transfer command buffer to the graphics queue without waiting for it.
+        void Flush();
+
+        // Flushes all pending uploads and waits until all batches in flight have been completed.
+        void WaitIdle();
+
+        // Returns true if there are recorded copy commands that have not been submitted yet.
+        inline bool HasPendingUploads() const
+        {
+            return recording_;
+        }
+
+        // Returns true if there are neither pending uploads nor batches in flight.
+        inline bool IsIdle() const
+        {
+            return (!recording_ && !batches_[oldestBatch_].inFlight);
+        }
+
+    private:
+
+        static constexpr std::uint32_t maxNumBatches = 4;
+
+        struct Batch
+        {
+            VkCommandBuffer commandBuffer   = VK_NULL_HANDLE;
+            VKPtr<VkFence>  fence;
+            std::uint64_t   head            = 0;
+            bool            inFlight        = false;
+        };
+
+    private:
+
+        // Allocates a region of the specified size within the ring and returns its offset.
+        VkDeviceSize Allocate(VkDeviceSize size, VkDeviceSize alignment);
+
+        // Returns the command buffer of the current batch and begins recording if necessary.
+        VkCommandBuffer GetRecordingCommandBuffer();
+
+        // Reclaims the memory of all completed batches. If 'wait' is true, blocks until the oldest batch has been completed.
+        void RetireBatches(bool wait);
+
+        // Returns the number of bytes that are currently in use.
+        inline std::uint64_t GetUsedSize() const
+        {
+            return (head_ - tail_);
+        }
+
+    private:
+
+        VKDevice&       device_;
+
+        VKDeviceMemory  memory_;
+        VKDeviceBuffer  buffer_;
+        char*           mappedData_     = nullptr;
+
+        VkDeviceSize    size_           = 0;
+        std::uint64_t   head_           = 0; // Monotonically increasing write position
+        std::uint64_t   tail_           = 0; // Monotonically increasing position of the oldest region in use
+
+        Batch           batches_[maxNumBatches];
+        std::uint32_t   batchIndex_     = 0; // Index of the batch that is currently being recorded
+        std::uint32_t   oldestBatch_    = 0; // Index of the oldest batch in flight
+        bool            recording_      = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -107,12 +107,211 @@ static bool DECL_LOADVKEXT_PROC(KHR_get_physical_device_properties2)
     return true;
 }
 
+static bool DECL_LOADVKEXT_PROC(KHR_timeline_semaphore)
+{
+    LOAD_VKPROC( vkGetSemaphoreCounterValueKHR );
+    LOAD_VKPROC( vkWaitSemaphoresKHR           );
+    LOAD_VKPROC( vkSignalSemaphoreKHR          );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_descriptor_update_template)
+{
+    LOAD_VKPROC( vkCreateDescriptorUpdateTemplateKHR  );
+    LOAD_VKPROC( vkDestroyDescriptorUpdateTemplateKHR );
+    LOAD_VKPROC( vkUpdateDescriptorSetWithTemplateKHR );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_push_descriptor)
+{
+    LOAD_VKPROC( vkCmdPushDescriptorSetKHR );
+
+    /* Only available if VK_KHR_descriptor_update_template is supported as well */
+    LoadVKProc(handle, vkCmdPushDescriptorSetWithTemplateKHR, "vkCmdPushDescriptorSetWithTemplateKHR");
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_dynamic_rendering)
+{
+    LOAD_VKPROC( vkCmdBeginRenderingKHR );
+    LOAD_VKPROC( vkCmdEndRenderingKHR   );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_draw_indirect_count)
+{
+    LOAD_VKPROC( vkCmdDrawIndirectCountKHR        );
+    LOAD_VKPROC( vkCmdDrawIndexedIndirectCountKHR );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_present_wait)
+{
+    LOAD_VKPROC( vkWaitForPresentKHR );
+    return true;
+}
+
+#ifdef LLGL_OS_WIN32
+
+static bool DECL_LOADVKEXT_PROC(KHR_external_memory_win32)
+{
+    LOAD_VKPROC( vkGetMemoryWin32HandleKHR );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_external_semaphore_win32)
+{
+    LOAD_VKPROC( vkGetSemaphoreWin32HandleKHR );
+    return true;
+}
+
+#else
+
+static bool DECL_LOADVKEXT_PROC(KHR_external_memory_fd)
+{
+    LOAD_VKPROC( vkGetMemoryFdKHR );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_external_semaphore_fd)
+{
+    LOAD_VKPROC( vkGetSemaphoreFdKHR );
+    return true;
+}
+
+#endif // /LLGL_OS_WIN32
+
+static bool DECL_LOADVKEXT_PROC(EXT_host_query_reset)
+{
+    LOAD_VKPROC( vkResetQueryPoolEXT );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(EXT_mesh_shader)
+{
+    LOAD_VKPROC( vkCmdDrawMeshTasksEXT         );
+    LOAD_VKPROC( vkCmdDrawMeshTasksIndirectEXT );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(EXT_extended_dynamic_state)
+{
+    LOAD_VKPROC( vkCmdSetCullModeEXT          );
+    LOAD_VKPROC( vkCmdSetFrontFaceEXT         );
+    LOAD_VKPROC( vkCmdSetPrimitiveTopologyEXT );
+    LOAD_VKPROC( vkCmdSetDepthTestEnableEXT   );
+    LOAD_VKPROC( vkCmdSetDepthWriteEnableEXT  );
+    LOAD_VKPROC( vkCmdSetDepthCompareOpEXT    );
+    LOAD_VKPROC( vkCmdSetStencilTestEnableEXT );
+    LOAD_VKPROC( vkCmdSetStencilOpEXT         );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(EXT_extended_dynamic_state2)
+{
+    LOAD_VKPROC( vkCmdSetDepthBiasEnableEXT         );
+    LOAD_VKPROC( vkCmdSetPrimitiveRestartEnableEXT  );
+    LOAD_VKPROC( vkCmdSetRasterizerDiscardEnableEXT );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(EXT_calibrated_timestamps)
+{
+    LOAD_VKPROC( vkGetCalibratedTimestampsEXT );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(EXT_host_image_copy)
+{
+    LOAD_VKPROC( vkCopyMemoryToImageEXT     );
+    LOAD_VKPROC( vkTransitionImageLayoutEXT );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(EXT_pageable_device_local_memory)
+{
+    LOAD_VKPROC( vkSetDeviceMemoryPriorityEXT );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_buffer_device_address)
+{
+    LOAD_VKPROC( vkGetBufferDeviceAddressKHR );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(KHR_acceleration_structure)
+{
+    LOAD_VKPROC( vkCreateAccelerationStructureKHR               );
+    LOAD_VKPROC( vkDestroyAccelerationStructureKHR              );
+    LOAD_VKPROC( vkGetAccelerationStructureBuildSizesKHR        );
+    LOAD_VKPROC( vkGetAccelerationStructureDeviceAddressKHR     );
+    LOAD_VKPROC( vkCmdBuildAccelerationStructuresKHR            );
+    LOAD_VKPROC( vkCmdCopyAccelerationStructureKHR              );
+    LOAD_VKPROC( vkCmdWriteAccelerationStructuresPropertiesKHR  );
+    return true;
+}
+
+static bool DECL_LOADVKEXT_PROC(AMD_buffer_marker)
+{
+    LOAD_VKPROC( vkCmdWriteBufferMarkerAMD );
+    return true;
+}
+
 #undef DECL_LOADVKEXT_PROC_BASE
 #undef DECL_LOADVKEXT_PROC_INSTANCE
 #undef DECL_LOADVKEXT_PROC
 #undef LOAD_VKPROC
 
 
+/* --- Deferred extension loading functions --- */
+
+using LoadVKExtensionDeviceFunc = bool (*)(VkDevice device, const char* extName, bool abortOnFailure);
+
+struct VKDeferredExtension
+{
+    VKExt                       extensionID;
+    const char*                 extName;
+    LoadVKExtensionDeviceFunc   extLoadingProc;
+};
+
+#define DEFERRED_VKEXT(NAME) \
+    VKDeferredExtension{ VKExt::NAME, "VK_" #NAME, Load_VK_##NAME }
+
+/*
+Optional device extensions whose procedures are only loaded on first use, i.e. when HasExtension() is queried for them the first time.
+Every call site of their procedures must be guarded by HasExtension() with the same extension ID.
+*/
+static const VKDeferredExtension g_deferredExtensions[] =
+{
+    DEFERRED_VKEXT( EXT_debug_marker          ),
+    DEFERRED_VKEXT( EXT_host_query_reset      ),
+    DEFERRED_VKEXT( EXT_calibrated_timestamps ),
+};
+
+#undef DEFERRED_VKEXT
+
+static VkDevice g_deferredExtensionDevice = VK_NULL_HANDLE;
+
+static const VKDeferredExtension* FindDeferredExtension(VKExt extensionID)
+{
+    for (const VKDeferredExtension& ext : g_deferredExtensions)
+    {
+        if (ext.extensionID == extensionID)
+            return &ext;
+    }
+    return nullptr;
+}
+
+static bool LoadDeferredExtension(VKExt extensionID)
+{
+    if (const VKDeferredExtension* ext = FindDeferredExtension(extensionID))
+        return ext->extLoadingProc(g_deferredExtensionDevice, ext->extName, /*abortOnFailure:*/ true);
+    return false;
+}
+
+
 /* --- Common extension loading functions --- */
 
 bool VKLoadInstanceExtensions(VkInstance instance)
@@ -169,21 +368,73 @@ bool VKLoadDeviceExtensions(VkDevice device, const std::vector<const char*>& sup
             RegisterExtension(extensionID);
     };
 
+    auto DeferExtension = [&IsSupported](const VKExt extensionID)
+    {
+        /* Only register deferred loader if Vulkan extension is supported by the device */
+        const VKDeferredExtension* ext = FindDeferredExtension(extensionID);
+        if (IsSupported(ext->extName))
+            RegisterDeferredExtension(extensionID, LoadDeferredExtension);
+    };
+
     #define LOAD_VKEXT(NAME) \
         LoadExtension(VKExt::NAME, "VK_" #NAME, Load_VK_##NAME)
 
+    #define DEFER_VKEXT(NAME) \
+        DeferExtension(VKExt::NAME)
+
+    /* Optional extensions are loaded on first use to reduce startup time */
+    g_deferredExtensionDevice = device;
+
     #define ENABLE_VKEXT(NAME) \
         EnableExtension(VKExt::NAME, "VK_" #NAME)
 
     /* Multi-vendor extensions */
     LOAD_VKEXT( KHR_get_physical_device_properties2 );
-    LOAD_VKEXT( EXT_debug_marker                    );
+    LOAD_VKEXT( KHR_timeline_semaphore              );
+    LOAD_VKEXT( KHR_descriptor_update_template      );
+    LOAD_VKEXT( KHR_push_descriptor                 );
+    LOAD_VKEXT( KHR_dynamic_rendering               );
+    LOAD_VKEXT( KHR_draw_indirect_count             );
+    LOAD_VKEXT( KHR_present_wait                    );
+    DEFER_VKEXT( EXT_debug_marker                   );
     LOAD_VKEXT( EXT_conditional_rendering           );
     LOAD_VKEXT( EXT_transform_feedback              );
-
+    DEFER_VKEXT( EXT_host_query_reset               );
+    LOAD_VKEXT( EXT_mesh_shader                     );
+    LOAD_VKEXT( EXT_extended_dynamic_state          );
+    LOAD_VKEXT( EXT_extended_dynamic_state2         );
+    DEFER_VKEXT( EXT_calibrated_timestamps          );
+    LOAD_VKEXT( EXT_host_image_copy                 );
+    LOAD_VKEXT( EXT_pageable_device_local_memory    );
+    LOAD_VKEXT( KHR_buffer_device_address           );
+    LOAD_VKEXT( KHR_acceleration_structure          );
+
+    /* Platform specific extensions */
+    #ifdef LLGL_OS_WIN32
+    LOAD_VKEXT( KHR_external_memory_win32           );
+    LOAD_VKEXT( KHR_external_semaphore_win32        );
+    #else
+    LOAD_VKEXT( KHR_external_memory_fd              );
+    LOAD_VKEXT( KHR_external_semaphore_fd           );
+    #endif
+
+    /* Vendor specific extensions */
+    LOAD_VKEXT( AMD_buffer_marker                   );
+
+    ENABLE_VKEXT( KHR_maintenance2               );
+    ENABLE_VKEXT( KHR_present_id                 );
+    ENABLE_VKEXT( KHR_fragment_shading_rate      );
+    ENABLE_VKEXT( KHR_dedicated_allocation       );
     ENABLE_VKEXT( EXT_conservative_rasterization );
+    ENABLE_VKEXT( EXT_descriptor_indexing        );
+    ENABLE_VKEXT( EXT_memory_budget              );
+    ENABLE_VKEXT( EXT_memory_priority            );
+    ENABLE_VKEXT( KHR_pipeline_library           );
+    ENABLE_VKEXT( EXT_graphics_pipeline_library  );
+    ENABLE_VKEXT( KHR_ray_query                  );
 
     #undef LOAD_VKEXT
+    #undef DEFER_VKEXT
 
     return true;
 }
@@ -9,33 +9,115 @@
 #include "../Vulkan.h"
 #include <LLGL/Container/Strings.h>
 #include <LLGL/Platform/Platform.h>
+#include <atomic>
+#include <mutex>
 
 
 namespace LLGL
 {
 
 
-static bool g_VKRegisteredExtensions[static_cast<std::size_t>(VKExt::Count)] = {};
+static std::atomic<bool>                        g_VKRegisteredExtensions[static_cast<std::size_t>(VKExt::Count)] = {};
+static std::atomic<VKDeferredExtensionLoader>   g_VKDeferredExtensionLoaders[static_cast<std::size_t>(VKExt::Count)] = {};
+static std::mutex                               g_VKDeferredExtensionMutex;
 
 static const char* g_VKOptionalExtensions[] =
 {
     VK_KHR_SAMPLER_MIRROR_CLAMP_TO_EDGE_EXTENSION_NAME,
     VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
+    VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
+    VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
+    VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME,
+    VK_KHR_MAINTENANCE2_EXTENSION_NAME,
+    VK_KHR_MAINTENANCE3_EXTENSION_NAME,
+    VK_KHR_MULTIVIEW_EXTENSION_NAME,
+    VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+    VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME,
+    VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
+    VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,
+    VK_KHR_PRESENT_ID_EXTENSION_NAME,
+    VK_KHR_PRESENT_WAIT_EXTENSION_NAME,
+    VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME,
+    VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME,
+    VK_KHR_SPIRV_1_4_EXTENSION_NAME,
+    VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
+    VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+    VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME,
+    VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,
+    VK_KHR_EXTERNAL_SEMAPHORE_EXTENSION_NAME,
+    VK_KHR_COPY_COMMANDS_2_EXTENSION_NAME,
+    VK_KHR_FORMAT_FEATURE_FLAGS_2_EXTENSION_NAME,
+    VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
+    VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME,
+    VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
+    VK_KHR_RAY_QUERY_EXTENSION_NAME,
+    #ifdef LLGL_OS_WIN32
+    VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME,
+    VK_KHR_EXTERNAL_SEMAPHORE_WIN32_EXTENSION_NAME,
+    #else
+    VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME,
+    VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME,
+    #endif
     VK_EXT_DEBUG_MARKER_EXTENSION_NAME,
     VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME,
     VK_EXT_CONSERVATIVE_RASTERIZATION_EXTENSION_NAME,
-    //VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME,
+    VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
+    VK_EXT_HOST_QUERY_RESET_EXTENSION_NAME,
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+    VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME,
+    VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME,
+    VK_EXT_MESH_SHADER_EXTENSION_NAME,
+    VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME,
+    VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME,
+    VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME,
+    VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME,
+    VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME,
+    VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME,
+    VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME,
+    VK_AMD_BUFFER_MARKER_EXTENSION_NAME,
     nullptr,
 };
 
 void RegisterExtension(VKExt extension)
 {
-    g_VKRegisteredExtensions[static_cast<std::size_t>(extension)] = true;
+    g_VKRegisteredExtensions[static_cast<std::size_t>(extension)].store(true, std::memory_order_release);
+}
+
+void RegisterDeferredExtension(VKExt extension, VKDeferredExtensionLoader loader)
+{
+    g_VKDeferredExtensionLoaders[static_cast<std::size_t>(extension)].store(loader, std::memory_order_release);
+}
+
+// Loads the procedures of a deferred extension once; other threads wait until the loader has finished.
+static bool LoadDeferredExtensionOnce(const VKExt extension)
+{
+    const std::size_t idx = static_cast<std::size_t>(extension);
+    std::lock_guard<std::mutex> guard{ g_VKDeferredExtensionMutex };
+
+    if (g_VKRegisteredExtensions[idx].load(std::memory_order_acquire))
+        return true;
+
+    if (VKDeferredExtensionLoader loader = g_VKDeferredExtensionLoaders[idx].load(std::memory_order_acquire))
+    {
+        /* Clear loader only after the result has been stored, so no thread observes neither of them */
+        if (loader(extension))
+            g_VKRegisteredExtensions[idx].store(true, std::memory_order_release);
+        g_VKDeferredExtensionLoaders[idx].store(nullptr, std::memory_order_release);
+    }
+
+    return g_VKRegisteredExtensions[idx].load(std::memory_order_acquire);
 }
 
 bool HasExtension(const VKExt extension)
 {
-    return g_VKRegisteredExtensions[static_cast<std::size_t>(extension)];
+    const std::size_t idx = static_cast<std::size_t>(extension);
+    if (g_VKRegisteredExtensions[idx].load(std::memory_order_acquire))
+        return true;
+    if (g_VKDeferredExtensionLoaders[idx].load(std::memory_order_acquire) != nullptr)
+        return LoadDeferredExtensionOnce(extension);
+
+    /* Check registry again in case another thread has finished loading this extension in the meantime */
+    return g_VKRegisteredExtensions[idx].load(std::memory_order_acquire);
 }
 
 const char** GetOptionalExtensions()
@@ -62,6 +144,8 @@ static bool IsVulkanInstanceExtOptional(const StringView& name)
     return
     (
         name == VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME
+        || name == VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME
+        || name == VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME
     );
 }
 
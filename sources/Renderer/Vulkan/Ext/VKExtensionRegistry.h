@@ -22,13 +22,45 @@ enum class VKExt
 {
     /* Khronos extensions */
     KHR_maintenance1,
+    KHR_maintenance2,
     KHR_get_physical_device_properties2,
+    KHR_timeline_semaphore,
+    KHR_push_descriptor,
+    KHR_descriptor_update_template,
+    KHR_dynamic_rendering,
+    KHR_draw_indirect_count,
+    KHR_present_id,
+    KHR_present_wait,
+    KHR_fragment_shading_rate,
+    KHR_dedicated_allocation,
+    KHR_external_memory_fd,
+    KHR_external_memory_win32,
+    KHR_external_semaphore_fd,
+    KHR_external_semaphore_win32,
+    KHR_pipeline_library,
+    KHR_buffer_device_address,
+    KHR_acceleration_structure,
+    KHR_ray_query,
 
     /* Multivendor extensions */
     EXT_debug_marker,
     EXT_conditional_rendering,
     EXT_transform_feedback,
     EXT_conservative_rasterization,
+    EXT_descriptor_indexing,
+    EXT_host_query_reset,
+    EXT_memory_budget,
+    EXT_memory_priority,
+    EXT_pageable_device_local_memory,
+    EXT_mesh_shader,
+    EXT_extended_dynamic_state,
+    EXT_extended_dynamic_state2,
+    EXT_graphics_pipeline_library,
+    EXT_calibrated_timestamps,
+    EXT_host_image_copy,
+
+    /* Vendor specific extensions */
+    AMD_buffer_marker,
 
     /* Enumeration entry counter */
     Count,
@@ -44,10 +76,16 @@ enum class VKExtSupport
 };
 
 
+// Loads the procedures of a deferred Vulkan extension and returns true on success.
+using VKDeferredExtensionLoader = bool (*)(VKExt extension);
+
 // Registers the specified Vulkan extension support.
 void RegisterExtension(VKExt extension);
 
-// Returns true if the specified Vulkan extension is supported.
+// Registers the specified Vulkan extension as supported, but defers loading its procedures until the first call to HasExtension.
+void RegisterDeferredExtension(VKExt extension, VKDeferredExtensionLoader loader);
+
+// Returns true if the specified Vulkan extension is supported. Loads the procedures of a deferred extension on first use.
 bool HasExtension(const VKExt extension);
 
 // Returns the null-terminated list of optional extensions.
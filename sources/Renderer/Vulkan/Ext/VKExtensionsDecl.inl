@@ -71,6 +71,110 @@ DECL_VKPROC( vkGetPhysicalDeviceQueueFamilyProperties2KHR       );
 DECL_VKPROC( vkGetPhysicalDeviceMemoryProperties2KHR            );
 DECL_VKPROC( vkGetPhysicalDeviceSparseImageFormatProperties2KHR );
 
+/* VK_KHR_timeline_semaphore */
+
+DECL_VKPROC( vkGetSemaphoreCounterValueKHR );
+DECL_VKPROC( vkWaitSemaphoresKHR           );
+DECL_VKPROC( vkSignalSemaphoreKHR          );
+
+/* VK_KHR_descriptor_update_template */
+
+DECL_VKPROC( vkCreateDescriptorUpdateTemplateKHR  );
+DECL_VKPROC( vkDestroyDescriptorUpdateTemplateKHR );
+DECL_VKPROC( vkUpdateDescriptorSetWithTemplateKHR );
+
+/* VK_KHR_push_descriptor */
+
+DECL_VKPROC( vkCmdPushDescriptorSetKHR             );
+DECL_VKPROC( vkCmdPushDescriptorSetWithTemplateKHR );
+
+/* VK_KHR_dynamic_rendering */
+
+DECL_VKPROC( vkCmdBeginRenderingKHR );
+DECL_VKPROC( vkCmdEndRenderingKHR   );
+
+/* VK_KHR_draw_indirect_count */
+
+DECL_VKPROC( vkCmdDrawIndirectCountKHR        );
+DECL_VKPROC( vkCmdDrawIndexedIndirectCountKHR );
+
+/* VK_KHR_present_wait */
+
+DECL_VKPROC( vkWaitForPresentKHR );
+
+/* VK_KHR_external_memory_win32 and VK_KHR_external_semaphore_win32 */
+
+#if defined(LLGL_OS_WIN32)
+
+DECL_VKPROC( vkGetMemoryWin32HandleKHR    );
+DECL_VKPROC( vkGetSemaphoreWin32HandleKHR );
+
+#else
+
+/* VK_KHR_external_memory_fd and VK_KHR_external_semaphore_fd */
+
+DECL_VKPROC( vkGetMemoryFdKHR    );
+DECL_VKPROC( vkGetSemaphoreFdKHR );
+
+#endif
+
+/* VK_EXT_host_query_reset */
+
+DECL_VKPROC( vkResetQueryPoolEXT );
+
+/* VK_EXT_mesh_shader */
+
+DECL_VKPROC( vkCmdDrawMeshTasksEXT         );
+DECL_VKPROC( vkCmdDrawMeshTasksIndirectEXT );
+
+/* VK_EXT_extended_dynamic_state */
+
+DECL_VKPROC( vkCmdSetCullModeEXT          );
+DECL_VKPROC( vkCmdSetFrontFaceEXT         );
+DECL_VKPROC( vkCmdSetPrimitiveTopologyEXT );
+DECL_VKPROC( vkCmdSetDepthTestEnableEXT   );
+DECL_VKPROC( vkCmdSetDepthWriteEnableEXT  );
+DECL_VKPROC( vkCmdSetDepthCompareOpEXT    );
+DECL_VKPROC( vkCmdSetStencilTestEnableEXT );
+DECL_VKPROC( vkCmdSetStencilOpEXT         );
+
+/* VK_EXT_extended_dynamic_state2 */
+
+DECL_VKPROC( vkCmdSetDepthBiasEnableEXT         );
+DECL_VKPROC( vkCmdSetPrimitiveRestartEnableEXT  );
+DECL_VKPROC( vkCmdSetRasterizerDiscardEnableEXT );
+
+/* VK_EXT_calibrated_timestamps */
+
+DECL_VKPROC( vkGetCalibratedTimestampsEXT );
+
+/* VK_EXT_host_image_copy */
+
+DECL_VKPROC( vkCopyMemoryToImageEXT     );
+DECL_VKPROC( vkTransitionImageLayoutEXT );
+
+/* VK_EXT_pageable_device_local_memory */
+
+DECL_VKPROC( vkSetDeviceMemoryPriorityEXT );
+
+/* VK_KHR_buffer_device_address */
+
+DECL_VKPROC( vkGetBufferDeviceAddressKHR );
+
+/* VK_KHR_acceleration_structure */
+
+DECL_VKPROC( vkCreateAccelerationStructureKHR               );
+DECL_VKPROC( vkDestroyAccelerationStructureKHR              );
+DECL_VKPROC( vkGetAccelerationStructureBuildSizesKHR        );
+DECL_VKPROC( vkGetAccelerationStructureDeviceAddressKHR     );
+DECL_VKPROC( vkCmdBuildAccelerationStructuresKHR            );
+DECL_VKPROC( vkCmdCopyAccelerationStructureKHR              );
+DECL_VKPROC( vkCmdWriteAccelerationStructuresPropertiesKHR  );
+
+/* VK_AMD_buffer_marker */
+
+DECL_VKPROC( vkCmdWriteBufferMarkerAMD );
+
 #undef DECL_VKPROC
 
 
@@ -7,24 +7,67 @@
 
 #include "VKDeviceMemory.h"
 #include "../VKCore.h"
+#include "../Ext/VKExtensionRegistry.h"
+#include "../Ext/VKExtensions.h"
 #include "../../ContainerTypes.h"
+#include "../../../Core/Assertion.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
 
 
 namespace LLGL
 {
 
 
-VKDeviceMemory::VKDeviceMemory(VkDevice device, VkDeviceSize size, std::uint32_t memoryTypeIndex) :
+// Returns the zero-based index of the most significant bit. The input must not be zero.
+static std::uint32_t FindLastBitSet(std::uint64_t x)
+{
+    #ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanReverse64(&index, x);
+    return static_cast<std::uint32_t>(index);
+    #else
+    return static_cast<std::uint32_t>(63 - __builtin_clzll(x));
+    #endif
+}
+
+// Returns the zero-based index of the least significant bit. The input must not be zero.
+static std::uint32_t FindFirstBitSet(std::uint64_t x)
+{
+    #ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(&index, x);
+    return static_cast<std::uint32_t>(index);
+    #else
+    return static_cast<std::uint32_t>(__builtin_ctzll(x));
+    #endif
+}
+
+VKDeviceMemory::VKDeviceMemory(VkDevice device, VkDeviceSize size, std::uint32_t memoryTypeIndex, bool dedicated, const void* allocInfoNext) :
     deviceMemory_    { device, vkFreeMemory },
     size_            { size                 },
     memoryTypeIndex_ { memoryTypeIndex      },
-    maxNewBlockSize_ { size                 }
+    dedicated_       { dedicated            }
 {
+    /* Allow device addresses for all allocations when buffer device addresses are enabled, since memory chunks are shared between buffers */
+    VkMemoryAllocateFlagsInfo allocFlagsInfo;
+    if (HasExtension(VKExt::KHR_buffer_device_address))
+    {
+        allocFlagsInfo.sType        = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+        allocFlagsInfo.pNext        = allocInfoNext;
+        allocFlagsInfo.flags        = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+        allocFlagsInfo.deviceMask   = 0;
+        allocInfoNext = &allocFlagsInfo;
+    }
+
     /* Allocate device memory */
     VkMemoryAllocateInfo allocInfo;
     {
         allocInfo.sType             = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.pNext             = nullptr;
+        allocInfo.pNext             = allocInfoNext;
         allocInfo.allocationSize    = size;
         allocInfo.memoryTypeIndex   = memoryTypeIndex;
     }
@@ -35,95 +78,147 @@ VKDeviceMemory::VKDeviceMemory(VkDevice device, VkDeviceSize size, std::uint32_t
         std::string info = "failed to allocate Vulkan device memory of " + std::to_string(size) + " bytes";
         VKThrowIfFailed(result, info.c_str());
     }
+
+    /* Initialize size classes up to the size of this chunk and insert a single free block that covers the entire chunk */
+    std::uint32_t fl = 0, sl = 0;
+    MapSize(size, fl, sl);
+    flCount_ = fl + 1;
+    slBitmaps_.resize(flCount_, 0u);
+    freeLists_.resize(flCount_ * slCount, nullptr);
+
+    if (size > 0)
+    {
+        firstBlock_ = new VKDeviceMemoryRegion{ this, size, 0, memoryTypeIndex };
+        InsertFreeBlock(firstBlock_);
+    }
 }
 
-void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size)
+VKDeviceMemory::~VKDeviceMemory()
 {
-    void* data = nullptr;
+    /* Delete all blocks in physical order */
+    for (VKDeviceMemoryRegion* block = firstBlock_; block != nullptr;)
+    {
+        VKDeviceMemoryRegion* nextBlock = block->nextPhysical_;
+        delete block;
+        block = nextBlock;
+    }
+}
+
+void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize /*size*/)
+{
+    std::lock_guard<std::mutex> guard{ mapMutex_ };
 
-    auto result = vkMapMemory(device, deviceMemory_, offset, size, 0, &data);
-    VKThrowIfFailed(result, "failed to map Vulkan buffer into CPU memory space");
+    /* Map entire chunk on first use, so all blocks share the same mapping */
+    if (mapCount_ == 0)
+    {
+        void* data = nullptr;
+        auto result = vkMapMemory(device, deviceMemory_, 0, VK_WHOLE_SIZE, 0, &data);
+        VKThrowIfFailed(result, "failed to map Vulkan buffer into CPU memory space");
+        mappedData_ = static_cast<char*>(data);
+    }
 
-    return data;
+    ++mapCount_;
+    return (mappedData_ + offset);
 }
 
 void VKDeviceMemory::Unmap(VkDevice device)
 {
-    vkUnmapMemory(device, deviceMemory_);
+    std::lock_guard<std::mutex> guard{ mapMutex_ };
+    LLGL_ASSERT(mapCount_ > 0, "unbalanced unmapping of Vulkan device memory");
+    if (--mapCount_ == 0)
+    {
+        vkUnmapMemory(device, deviceMemory_);
+        mappedData_ = nullptr;
+    }
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation)
+void VKDeviceMemory::SetPriority(VkDevice device, float priority)
 {
-    if (size > 0 && alignment > 0)
-    {
-        /* Adjust size and offset by alignment */
-        auto alignedSize    = GetAlignedSize(size, alignment);
-        auto alignedOffset  = GetAlignedSize(GetNextOffset(), alignment);
+    LLGL_ASSERT_VK_EXT(EXT_pageable_device_local_memory);
+    vkSetDeviceMemoryPriorityEXT(device, deviceMemory_, priority);
+    priority_ = priority;
+}
 
-        if (reduceFragmentation)
-        {
-            /* Reuse fragmented block */
-            if (alignedSize <= maxFragmentedBlockSize_)
-                return FindReusableBlock(alignedSize, alignment);
+VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    if (size == 0 || alignment == 0)
+        return nullptr;
 
-            /* Allocate block with aligned size and offset */
-            if (alignedSize + alignedOffset <= GetSize())
-                return AllocAndAppendBlock(alignedSize, alignedOffset);
-        }
-        else
-        {
-            /* Allocate block with aligned size and offset */
-            if (alignedSize + alignedOffset <= GetSize())
-                return AllocAndAppendBlock(alignedSize, alignedOffset);
+    const VkDeviceSize alignedSize = GetAlignedSize(size, alignment);
+    if (alignedSize > GetSize())
+        return nullptr;
 
-            /* Reuse fragmented block */
-            if (alignedSize <= maxFragmentedBlockSize_)
-                return FindReusableBlock(alignedSize, alignment);
-        }
+    VKDeviceMemoryRegion* block = FindFreeBlock(alignedSize, alignment);
+    if (block == nullptr)
+        return nullptr;
+
+    RemoveFreeBlock(block);
+
+    /* Split off lower part of the block that is skipped by the alignment */
+    const VkDeviceSize alignedOffset = GetAlignedSize(block->GetOffset(), alignment);
+    if (alignedOffset > block->GetOffset())
+    {
+        const VkDeviceSize paddingSize = alignedOffset - block->GetOffset();
+        InsertFreeBlock(MakeBlockBefore(block, paddingSize));
+        block->MoveAt(block->GetSize() - paddingSize, alignedOffset);
     }
-    return nullptr;
+
+    /* Split off upper part of the block that remains unused */
+    if (block->GetSize() > alignedSize)
+    {
+        const VkDeviceSize remainingSize = block->GetSize() - alignedSize;
+        block->MoveAt(alignedSize, alignedOffset);
+        InsertFreeBlock(MakeBlockAfter(block, remainingSize));
+    }
+
+    ++numBlocks_;
+    allocatedSize_ += block->GetSize();
+
+    return block;
 }
 
 void VKDeviceMemory::Release(VKDeviceMemoryRegion* region)
 {
-    if (region)
+    if (region != nullptr && !region->isFree_)
     {
-        /* Increase maximal size of fragmented blocks */
-        maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, region->GetSize());
+        LLGL_ASSERT(region->GetParentChunk() == this);
+
+        --numBlocks_;
+        allocatedSize_ -= region->GetSize();
 
-        auto it = std::find_if(
-            blocks_.begin(), blocks_.end(),
-            [region](const std::unique_ptr<VKDeviceMemoryRegion>& entry)
+        /* Merge block with its physical neighbors if they are free; two free blocks are never adjacent */
+        if (VKDeviceMemoryRegion* nextBlock = region->nextPhysical_)
+        {
+            if (nextBlock->isFree_)
             {
-                return (entry.get() == region);
+                RemoveFreeBlock(nextBlock);
+                MergeWithNextBlock(region);
             }
-        );
+        }
 
-        if (it != blocks_.end())
+        if (VKDeviceMemoryRegion* prevBlock = region->prevPhysical_)
         {
-            InsertBlockToFragmentsSorted(std::move(*it));
-            blocks_.erase(it);
+            if (prevBlock->isFree_)
+            {
+                RemoveFreeBlock(prevBlock);
+                MergeWithNextBlock(prevBlock);
+                region = prevBlock;
+            }
         }
-    }
-}
-
-bool VKDeviceMemory::IsEmpty() const
-{
-    return blocks_.empty();
-}
 
-VkDeviceSize VKDeviceMemory::GetMaxAllocationSize() const
-{
-    return std::max(maxNewBlockSize_, maxFragmentedBlockSize_);
+        InsertFreeBlock(region);
+    }
 }
 
 void VKDeviceMemory::AccumDetails(VKDeviceMemoryDetails& details) const
 {
     details.numChunks               += 1;
-    details.numBlocks               += blocks_.size();
-    details.numFragments            += fragmentedBlocks_.size();
-    details.maxNewBlockSize         = std::max(details.maxNewBlockSize, maxNewBlockSize_);
-    details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, maxFragmentedBlockSize_);
+    details.numDedicatedChunks      += (dedicated_ ? 1 : 0);
+    details.numBlocks               += numBlocks_;
+    details.numFragments            += numFragments_;
+    details.totalSize               += size_;
+    details.allocatedSize           += allocatedSize_;
+    details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, GetMaxFreeBlockSize());
 }
 
 #ifdef LLGL_DEBUG
@@ -179,20 +274,26 @@ static void PrintDeviceMemoryRegion(std::ostream& s, VKDeviceMemoryRegion& regio
 void VKDeviceMemory::PrintBlocks(std::ostream& s) const
 {
     VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : blocks_)
+    for (VKDeviceMemoryRegion* block = firstBlock_; block != nullptr; block = block->nextPhysical_)
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        if (!block->isFree_)
+        {
+            PrintDeviceMemoryRegion(s, *block, prevBlock);
+            prevBlock = block;
+        }
     }
 }
 
 void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
 {
     VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : fragmentedBlocks_)
+    for (VKDeviceMemoryRegion* block = firstBlock_; block != nullptr; block = block->nextPhysical_)
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        if (block->isFree_)
+        {
+            PrintDeviceMemoryRegion(s, *block, prevBlock);
+            prevBlock = block;
+        }
     }
 }
 
@@ -203,238 +304,194 @@ void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
  * ======= Private: =======
  */
 
-VkDeviceSize VKDeviceMemory::GetNextOffset() const
+void VKDeviceMemory::MapSize(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl)
 {
-    if (blocks_.empty())
-        return 0;
+    if (size < smallBlockSize)
+    {
+        /* Map small sizes linearly into the first size class */
+        fl = 0;
+        sl = static_cast<std::uint32_t>(size);
+    }
     else
-        return blocks_.back()->GetOffsetWithSize();
+    {
+        /* Map size to power of two (first level) and its linear subdivision (second level) */
+        const std::uint32_t msb = FindLastBitSet(size);
+        fl = msb - slCountLog2 + 1;
+        sl = static_cast<std::uint32_t>(size >> (msb - slCountLog2)) ^ slCount;
+    }
 }
 
-std::unique_ptr<VKDeviceMemoryRegion> VKDeviceMemory::MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
+// Returns true if the specified block can hold the specified size at the specified alignment.
+static bool BlockFits(const VKDeviceMemoryRegion& block, VkDeviceSize size, VkDeviceSize alignment)
 {
-    return MakeUnique<VKDeviceMemoryRegion>(this, alignedSize, alignedOffset, memoryTypeIndex_);
+    return (GetAlignedSize(block.GetOffset(), alignment) + size <= block.GetOffsetWithSize());
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
+VKDeviceMemoryRegion* VKDeviceMemory::FindFreeBlock(VkDeviceSize size, VkDeviceSize alignment) const
 {
-    /* Update maximal free block size */
-    maxNewBlockSize_ = GetSize() - (alignedSize + alignedOffset);
+    /* Find free block for the size first, then for the worst case of an additional alignment padding */
+    VKDeviceMemoryRegion* block = FindFreeBlockInSizeClass(size);
+    if (block != nullptr && BlockFits(*block, size, alignment))
+        return block;
 
-    /* Check if the aligned offset results in a new fragment */
-    const auto nextOffset = GetNextOffset();
-
-    if (nextOffset < alignedOffset)
-    {
-        /*
-        Check if new fragment can be immediately merged with previous fragment:
-        Before: blocks:    [++]........[++++]
-                fragments: ....[++++]
-        After:  blocks:    [++]........[++++]
-                fragments: ....[++++++]
-        */
-        if (!fragmentedBlocks_.empty() && fragmentedBlocks_.back()->GetOffset() == nextOffset)
-        {
-            /* Resize last fragmented block */
-            fragmentedBlocks_.back()->MoveAt(alignedOffset - nextOffset, nextOffset);
-        }
-        else
-        {
-            /* Append new fragmented block at the end */
-            fragmentedBlocks_.push_back(MakeUniqueBlock(alignedOffset - nextOffset, nextOffset));
-        }
-    }
-    else
+    if (alignment > 1)
     {
-        /* Check if last fragmented block can be replaced by new block */
-        if (!fragmentedBlocks_.empty() && fragmentedBlocks_.back()->GetOffset() == nextOffset)
-        {
-            /* Move fragmented block into main blocks and resize it */
-            auto block = TakeOwnership(blocks_, std::move(fragmentedBlocks_.back()));
-            block->MoveAt(alignedSize, alignedOffset);
-            fragmentedBlocks_.pop_back();
+        block = FindFreeBlockInSizeClass(size + alignment - 1);
+        if (block != nullptr)
             return block;
-        }
     }
 
-    /* Allocate new block */
-    return TakeOwnership(blocks_, MakeUniqueBlock(alignedSize, alignedOffset));
-}
+    /*
+    Fall back to linear search in the size class of the unrounded size,
+    since rounding up the size skips blocks of that class that might still be large enough, e.g. for dedicated chunks.
+    */
+    std::uint32_t fl = 0, sl = 0;
+    MapSize(size, fl, sl);
 
-VKDeviceMemoryRegion* VKDeviceMemory::InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region)
-{
-    auto regionRef = region.get();
-
-    /* Add block by insertion sort */
-    if (!blocks_.empty())
+    if (fl < flCount_)
     {
-        for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it)
+        for (block = GetFreeList(fl, sl); block != nullptr; block = block->nextFree_)
         {
-            if ((*it)->GetOffset() < region->GetOffset())
-            {
-                blocks_.insert(it.base(), std::move(region));
-                break;
-            }
+            if (BlockFits(*block, size, alignment))
+                return block;
         }
     }
-    else
-        blocks_.emplace_back(std::move(region));
 
-    return regionRef;
+    return nullptr;
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment)
+VKDeviceMemoryRegion* VKDeviceMemory::FindFreeBlockInSizeClass(VkDeviceSize size) const
 {
-    VKDeviceMemoryRegion* prevBlock = nullptr;
-    VKDeviceMemoryRegion* nextBlock = nullptr;
-
-    /* Search for fragmented block that fits the requirement */
-    for (auto it = fragmentedBlocks_.begin(); it != fragmentedBlocks_.end(); ++it)
-    {
-        auto block = it->get();
-
-        /* Check if required size plus the additional aligned offset fits into the current block */
-        const auto alignedOffset = GetAlignedSize(block->GetOffset(), alignment);
-        if (alignedSize + alignedOffset - block->GetOffset() <= block->GetSize())
-        {
-            /* If this block has the maximum fragmented block size, this value must be updated */
-            const bool mustUpdateMaxSize = (block->GetSize() == maxFragmentedBlockSize_);
-
-            /* If block can be reused with its entire size, it can be removed from the fragmented blocks */
-            InsertBlock(std::move(*it));
-
-            it = fragmentedBlocks_.erase(it);
-            if (it != fragmentedBlocks_.end())
-                nextBlock = it->get();
-
-            /* Check if block must be split up at the lower part */
-            if (block->GetOffset() < alignedOffset)
-            {
-                /* Allocate fragmented lower block (left to the current block) */
-                auto blockLower = MakeUniqueBlock(alignedOffset - block->GetOffset(), block->GetOffset());
-
-                if (!prevBlock || !MergeFragmentedBlockWith(*prevBlock, *blockLower))
-                {
-                    it = fragmentedBlocks_.insert(it, std::move(blockLower));
-                    ++it;
-                }
-            }
-
-            /* Check if block must be split up at the upper part */
-            auto alignedSizeWithOffset = alignedSize + alignedOffset - block->GetOffset();
-            if (alignedSizeWithOffset < block->GetSize())
-            {
-                /* Allocate fragmented upper block (right to the current block) */
-                auto blockUpperSize = block->GetSize() - alignedSizeWithOffset;
-                auto blockUpper     = MakeUniqueBlock(blockUpperSize, block->GetOffsetWithSize() - blockUpperSize);
-
-                if (!nextBlock || !MergeFragmentedBlockWith(*blockUpper, *nextBlock))
-                    fragmentedBlocks_.insert(it, std::move(blockUpper));
-            }
+    /* Round up size to the next size class, so any block in the respective free list is large enough */
+    if (size >= smallBlockSize)
+        size += (VkDeviceSize(1) << (FindLastBitSet(size) - slCountLog2)) - 1;
 
-            /* Move reused block to new offset and size */
-            block->MoveAt(alignedSize, alignedOffset);
+    std::uint32_t fl = 0, sl = 0;
+    MapSize(size, fl, sl);
 
-            if (mustUpdateMaxSize)
-                UpdateMaxFragmentedBlockSize();
+    if (fl >= flCount_)
+        return nullptr;
 
-            /* Reuse current block */
-            return block;
-        }
+    /* Search for non-empty free list in the same first level, or otherwise in the next larger first level */
+    std::uint32_t slBitmap = (slBitmaps_[fl] & (~0u << sl));
+    if (slBitmap == 0)
+    {
+        const std::uint64_t flBitmap = (fl + 1 < 64 ? (flBitmap_ & (~0ull << (fl + 1))) : 0);
+        if (flBitmap == 0)
+            return nullptr;
 
-        prevBlock = block;
+        fl = FindFirstBitSet(flBitmap);
+        slBitmap = slBitmaps_[fl];
     }
 
-    /* No reusable block found */
-    return nullptr;
+    sl = FindFirstBitSet(slBitmap);
+
+    return GetFreeList(fl, sl);
 }
 
-void VKDeviceMemory::UpdateMaxFragmentedBlockSize()
+void VKDeviceMemory::InsertFreeBlock(VKDeviceMemoryRegion* block)
 {
-    maxFragmentedBlockSize_ = 0;
-    for (const auto& block : fragmentedBlocks_)
-        maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, block->GetSize());
+    std::uint32_t fl = 0, sl = 0;
+    MapSize(block->GetSize(), fl, sl);
+
+    /* Insert block at the front of its free list */
+    VKDeviceMemoryRegion*& head = GetFreeList(fl, sl);
+    block->isFree_      = true;
+    block->prevFree_    = nullptr;
+    block->nextFree_    = head;
+    if (head != nullptr)
+        head->prevFree_ = block;
+    head = block;
+
+    flBitmap_       |= (1ull << fl);
+    slBitmaps_[fl]  |= (1u << sl);
+    ++numFragments_;
 }
 
-void VKDeviceMemory::InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region)
+void VKDeviceMemory::RemoveFreeBlock(VKDeviceMemoryRegion* block)
 {
-    auto offset = region->GetOffset();
-    auto count  = fragmentedBlocks_.size();
+    std::uint32_t fl = 0, sl = 0;
+    MapSize(block->GetSize(), fl, sl);
 
-    /* Start serach in half-open range [begin, end) */
-    decltype(count) begin = 0, end = count;
+    /* Unlink block from its free list */
+    if (block->prevFree_ != nullptr)
+        block->prevFree_->nextFree_ = block->nextFree_;
+    if (block->nextFree_ != nullptr)
+        block->nextFree_->prevFree_ = block->prevFree_;
 
-    while (begin + 2 < end)
+    VKDeviceMemoryRegion*& head = GetFreeList(fl, sl);
+    if (head == block)
     {
-        /* Check if region's offset is before or after the middle's element */
-        auto center = (begin + end) / 2;
-
-        if (offset < fragmentedBlocks_[center]->GetOffset())
+        head = block->nextFree_;
+        if (head == nullptr)
         {
-            /* Restrict search to lower half */
-            end = center + 1;
-        }
-        else
-        {
-            /* Restrict search to upper half */
-            begin = center;
+            /* Clear bits of empty free list */
+            slBitmaps_[fl] &= ~(1u << sl);
+            if (slBitmaps_[fl] == 0)
+                flBitmap_ &= ~(1ull << fl);
         }
     }
 
-    /* Insert region by insertion-sort of the remaining half-open range [begin, begin + 2) */
-    if (begin < count && offset < fragmentedBlocks_[begin]->GetOffset())
-        InsertBlockToFragmentsAt(std::move(region), begin);
-    else if (begin + 1 < count)
-    {
-        if (offset < fragmentedBlocks_[begin + 1]->GetOffset())
-            InsertBlockToFragmentsAt(std::move(region), begin + 1);
-        else
-            InsertBlockToFragmentsAt(std::move(region), begin + 2);
-    }
-    else
-        InsertBlockToFragmentsAt(std::move(region), count);
+    block->isFree_      = false;
+    block->prevFree_    = nullptr;
+    block->nextFree_    = nullptr;
+    --numFragments_;
 }
 
-void VKDeviceMemory::InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position)
+VKDeviceMemoryRegion* VKDeviceMemory::MakeBlockBefore(VKDeviceMemoryRegion* block, VkDeviceSize size)
 {
-    auto count = fragmentedBlocks_.size();
+    auto* newBlock = new VKDeviceMemoryRegion{ this, size, block->GetOffset(), memoryTypeIndex_ };
 
-    /* Try to merge region into lower part: [LOWER][BLOCK] --> [+++LOWER++++] */
-    if (position > 0 && MergeFragmentedBlockWith(*fragmentedBlocks_[position - 1], *region))
-    {
-        /* Try to merge upper part into lower part: [+++LOWER++++][UPPER] --> [+++++++LOWER+++++++] */
-        if (position < count && MergeFragmentedBlockWith(*fragmentedBlocks_[position - 1], *fragmentedBlocks_[position]))
-        {
-            /* Remove previous upper part after two-phase-merge */
-            fragmentedBlocks_.erase(fragmentedBlocks_.begin() + position);
-        }
-    }
-    /* Try to merge region into upper part: [BLOCK][UPPER] --> [+++UPPER++++] */
-    else if (position >= count || !MergeFragmentedBlockWith(*fragmentedBlocks_[position], *region))
-    {
-        /* Insert new fragmented block: [LOWER]..[BLOCK]..[UPPER] */
-        fragmentedBlocks_.insert(fragmentedBlocks_.begin() + position, std::move(region));
-    }
+    newBlock->prevPhysical_ = block->prevPhysical_;
+    newBlock->nextPhysical_ = block;
+    if (block->prevPhysical_ != nullptr)
+        block->prevPhysical_->nextPhysical_ = newBlock;
+    else
+        firstBlock_ = newBlock;
+    block->prevPhysical_ = newBlock;
+
+    return newBlock;
 }
 
-bool VKDeviceMemory::MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion)
+VKDeviceMemoryRegion* VKDeviceMemory::MakeBlockAfter(VKDeviceMemoryRegion* block, VkDeviceSize size)
 {
-    if (region.MergeWith(appendixRegion))
-    {
-        IncMaxFragmentedBlockSize(region.GetSize());
-        return true;
-    }
-    return false;
+    auto* newBlock = new VKDeviceMemoryRegion{ this, size, block->GetOffsetWithSize(), memoryTypeIndex_ };
+
+    newBlock->prevPhysical_ = block;
+    newBlock->nextPhysical_ = block->nextPhysical_;
+    if (block->nextPhysical_ != nullptr)
+        block->nextPhysical_->prevPhysical_ = newBlock;
+    block->nextPhysical_ = newBlock;
+
+    return newBlock;
 }
 
-VkDeviceSize VKDeviceMemory::GetFragmentBlockOffsetEnd(std::size_t position) const
+void VKDeviceMemory::MergeWithNextBlock(VKDeviceMemoryRegion* block)
 {
-    return fragmentedBlocks_[position]->GetOffsetWithSize();
+    VKDeviceMemoryRegion* nextBlock = block->nextPhysical_;
+
+    block->MoveAt(block->GetSize() + nextBlock->GetSize(), block->GetOffset());
+    block->nextPhysical_ = nextBlock->nextPhysical_;
+    if (nextBlock->nextPhysical_ != nullptr)
+        nextBlock->nextPhysical_->prevPhysical_ = block;
+
+    delete nextBlock;
 }
 
-void VKDeviceMemory::IncMaxFragmentedBlockSize(VkDeviceSize size)
+VkDeviceSize VKDeviceMemory::GetMaxFreeBlockSize() const
 {
-    maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, size);
+    if (flBitmap_ == 0)
+        return 0;
+
+    /* The largest free block must be in the highest non-empty size class */
+    const std::uint32_t fl = FindLastBitSet(flBitmap_);
+    const std::uint32_t sl = FindLastBitSet(slBitmaps_[fl]);
+
+    VkDeviceSize maxSize = 0;
+    for (VKDeviceMemoryRegion* block = GetFreeList(fl, sl); block != nullptr; block = block->nextFree_)
+        maxSize = std::max(maxSize, block->GetSize());
+
+    return maxSize;
 }
 
 
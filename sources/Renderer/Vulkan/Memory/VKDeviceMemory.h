@@ -14,7 +14,7 @@
 #include <vulkan/vulkan.h>
 #include <cstdint>
 #include <vector>
-#include <memory>
+#include <mutex>
 
 #ifdef LLGL_DEBUG
 #   include <ostream>
@@ -29,40 +29,46 @@ namespace LLGL
 struct VKDeviceMemoryDetails
 {
     std::size_t     numChunks               = 0;
+    std::size_t     numDedicatedChunks      = 0;
     std::size_t     numBlocks               = 0;
     std::size_t     numFragments            = 0;
-    VkDeviceSize    maxNewBlockSize         = 0;
+    VkDeviceSize    totalSize               = 0;
+    VkDeviceSize    allocatedSize           = 0;
     VkDeviceSize    maxFragmentedBlockSize  = 0;
 };
 
-// An instance of this class holds a single VkDeviceMemory allocation chunk.
+/*
+An instance of this class holds a single VkDeviceMemory allocation chunk.
+Blocks are sub-allocated with a two-level segregated fit (TLSF) allocator, i.e. allocation and release take constant time.
+Free blocks are sorted into size classes of a power of two (first level) that are linearly subdivided (second level).
+*/
 class VKDeviceMemory
 {
 
     public:
 
-        VKDeviceMemory(VkDevice device, VkDeviceSize size, std::uint32_t memoryTypeIndex);
+        // Allocates the device memory chunk. The optional 'allocInfoNext' chain is passed to VkMemoryAllocateInfo, e.g. to export the memory.
+        VKDeviceMemory(VkDevice device, VkDeviceSize size, std::uint32_t memoryTypeIndex, bool dedicated = false, const void* allocInfoNext = nullptr);
+        ~VKDeviceMemory();
 
         VKDeviceMemory(const VKDeviceMemory&) = delete;
         VKDeviceMemory& operator = (const VKDeviceMemory&) = delete;
 
-        VKDeviceMemory(VKDeviceMemory&&) = default;
-        VKDeviceMemory& operator = (VKDeviceMemory&&) = default;
-
+        /*
+        Maps the specified range of this chunk into CPU memory space. Mappings are reference counted and synchronized,
+        since a VkDeviceMemory object can only be mapped once but its blocks can be mapped independently from multiple threads.
+        */
         void* Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size);
         void Unmap(VkDevice device);
 
         // Tries to allocate a new block within this device memory chunk, and returns null of failure.
-        VKDeviceMemoryRegion* Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation = false);
+        VKDeviceMemoryRegion* Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
         // Releases the specified block within this device memory chunk.
         void Release(VKDeviceMemoryRegion* region);
 
-        // Returns true if this device memory has no more blocks.
-        bool IsEmpty() const;
-
-        // Returns the maximal size that can be allocated for a device memory region within this device memory chunk.
-        VkDeviceSize GetMaxAllocationSize() const;
+        // Changes the priority of this device memory chunk with vkSetDeviceMemoryPriorityEXT. Requires VK_EXT_pageable_device_local_memory.
+        void SetPriority(VkDevice device, float priority);
 
         // Accumulates the memory details of this device memory into the output structure.
         void AccumDetails(VKDeviceMemoryDetails& details) const;
@@ -74,6 +80,18 @@ class VKDeviceMemory
 
         #endif
 
+        // Returns true if this device memory has no more blocks.
+        inline bool IsEmpty() const
+        {
+            return (numBlocks_ == 0);
+        }
+
+        // Returns true if this device memory chunk was allocated for a single resource.
+        inline bool IsDedicated() const
+        {
+            return dedicated_;
+        }
+
         // Returns the hardware buffer object.
         inline VkDeviceMemory GetVkDeviceMemory() const
         {
@@ -92,52 +110,80 @@ class VKDeviceMemory
             return memoryTypeIndex_;
         }
 
+        // Returns the memory priority of this device memory chunk. By default 0.5.
+        inline float GetPriority() const
+        {
+            return priority_;
+        }
+
     private:
 
-        // Returns the next offset after the last block.
-        VkDeviceSize GetNextOffset() const;
+        // Number of second-level subdivisions per first-level size class (as power of two).
+        static constexpr std::uint32_t  slCountLog2     = 5;
+        static constexpr std::uint32_t  slCount         = (1u << slCountLog2);
 
-        // Makes a new device memory block.
-        std::unique_ptr<VKDeviceMemoryRegion> MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+        // Blocks smaller than this size are mapped linearly into the first size class.
+        static constexpr VkDeviceSize   smallBlockSize  = slCount;
 
-        // Allocates a new block.
-        VKDeviceMemoryRegion* AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+    private:
 
-        // Inserts the specified region into the main block list by insertion-sort.
-        VKDeviceMemoryRegion* InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region);
+        // Maps the specified size to its first- and second-level index.
+        static void MapSize(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl);
 
-        // Tries to find a fragmented block that can be reused.
-        VKDeviceMemoryRegion* FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment);
+        // Returns a free block that can hold the specified size at the specified alignment, or null if there is none.
+        VKDeviceMemoryRegion* FindFreeBlock(VkDeviceSize size, VkDeviceSize alignment) const;
 
-        // Updates the maximal size of fragmanted blocks.
-        void UpdateMaxFragmentedBlockSize();
+        // Returns a free block that is at least as large as the specified size from the next size class, or null if there is none.
+        VKDeviceMemoryRegion* FindFreeBlockInSizeClass(VkDeviceSize size) const;
 
-        // Inserts the specified region into the fragmented block list by insertion-sort.
-        void InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region);
+        // Inserts the specified block into the free list of its size class.
+        void InsertFreeBlock(VKDeviceMemoryRegion* block);
 
-        // Inserts the specified region into the fragmented block list at the specified position and merges it with surrounding blocks if possible.
-        void InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position);
+        // Removes the specified block from the free list of its size class.
+        void RemoveFreeBlock(VKDeviceMemoryRegion* block);
 
-        // Merges the two fragmented blocks and records the maximal fragmented block size.
-        bool MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion);
+        // Makes a new free block and links it physically before or after the specified block.
+        VKDeviceMemoryRegion* MakeBlockBefore(VKDeviceMemoryRegion* block, VkDeviceSize size);
+        VKDeviceMemoryRegion* MakeBlockAfter(VKDeviceMemoryRegion* block, VkDeviceSize size);
 
-        // Returns the offset after the specified fragmented block.
-        VkDeviceSize GetFragmentBlockOffsetEnd(std::size_t position) const;
+        // Merges the physically next block into the specified block and deletes the next block.
+        void MergeWithNextBlock(VKDeviceMemoryRegion* block);
 
-        // Increases the maximal fragmented block size.
-        void IncMaxFragmentedBlockSize(VkDeviceSize size);
+        // Returns the size of the largest free block.
+        VkDeviceSize GetMaxFreeBlockSize() const;
 
-    private:
+        // Returns the head of the free list for the specified size class.
+        inline VKDeviceMemoryRegion*& GetFreeList(std::uint32_t fl, std::uint32_t sl)
+        {
+            return freeLists_[fl * slCount + sl];
+        }
 
-        VKPtr<VkDeviceMemory>                               deviceMemory_;
-        VkDeviceSize                                        size_                   = 0;
-        std::uint32_t                                       memoryTypeIndex_        = 0;
+        inline VKDeviceMemoryRegion* GetFreeList(std::uint32_t fl, std::uint32_t sl) const
+        {
+            return freeLists_[fl * slCount + sl];
+        }
 
-        VkDeviceSize                                        maxNewBlockSize_        = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  blocks_;
+    private:
 
-        VkDeviceSize                                        maxFragmentedBlockSize_ = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  fragmentedBlocks_;
+        VKPtr<VkDeviceMemory>               deviceMemory_;
+        VkDeviceSize                        size_               = 0;
+        std::uint32_t                       memoryTypeIndex_    = 0;
+        bool                                dedicated_          = false;
+        float                               priority_           = 0.5f;
+
+        VKDeviceMemoryRegion*               firstBlock_         = nullptr; // First block in physical order; blocks cover the entire chunk
+        std::size_t                         numBlocks_          = 0;
+        std::size_t                         numFragments_       = 0;
+        VkDeviceSize                        allocatedSize_      = 0;
+
+        std::uint32_t                       flCount_            = 0;
+        std::uint64_t                       flBitmap_           = 0;
+        std::vector<std::uint32_t>          slBitmaps_;
+        std::vector<VKDeviceMemoryRegion*>  freeLists_;
+
+        std::mutex                          mapMutex_;
+        char*                               mappedData_         = nullptr;
+        std::uint32_t                       mapCount_           = 0;
 
 };
 
@@ -6,14 +6,21 @@
  */
 
 #include "VKDeviceMemoryManager.h"
+#include "VKExternalHandle.h"
 #include "../VKCore.h"
+#include "../Ext/VKExtensionRegistry.h"
 #include "../../ContainerTypes.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+// Priority of all device memory chunks until it's changed with vkSetDeviceMemoryPriorityEXT; this is the default of VK_EXT_memory_priority.
+static constexpr float g_defaultMemoryPriority = 0.5f;
+
 VKDeviceMemoryManager::VKDeviceMemoryManager(
     VkDevice                                device,
     const VkPhysicalDeviceMemoryProperties& memoryProperties,
@@ -33,14 +40,25 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     std::uint32_t           memoryTypeBits,
     VkMemoryPropertyFlags   properties)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
     const auto alignedSize      = GetAlignedSize(size, alignment);
     const auto memoryTypeIndex  = FindMemoryType(memoryTypeBits, properties);
-    const auto allocationSize   = std::max(minAllocationSize_, alignedSize);
 
-    if (auto chunk = FindOrAllocChunk(allocationSize, memoryTypeIndex, alignedSize))
-        return chunk->Allocate(size, alignment);
+    /* Allocate large resources in their own chunk */
+    if (alignedSize >= minAllocationSize_)
+        return AllocChunk(alignedSize, memoryTypeIndex, true)->Allocate(size, alignment);
+
+    /* Allocate block from pooled chunks or allocate a new chunk */
+    if (auto region = AllocFromPool(size, alignment, memoryTypeIndex))
+    {
+        /* Retained empty chunk is no longer empty */
+        if (emptyChunks_[memoryTypeIndex] == region->GetParentChunk())
+            emptyChunks_[memoryTypeIndex] = nullptr;
+        return region;
+    }
     else
-        return nullptr;
+        return AllocChunk(minAllocationSize_, memoryTypeIndex, false)->Allocate(size, alignment);
 }
 
 VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
@@ -55,24 +73,100 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     );
 }
 
+VKDeviceMemoryRegion* VKDeviceMemoryManager::AllocateExportable(
+    const VkMemoryRequirements& requirements,
+    VkMemoryPropertyFlags       properties,
+    VkBuffer                    buffer,
+    VkImage                     image)
+{
+    /* Bind the allocation to its resource if supported, since some drivers only export dedicated allocations */
+    VkMemoryDedicatedAllocateInfoKHR dedicatedInfo;
+    {
+        dedicatedInfo.sType     = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO_KHR;
+        dedicatedInfo.pNext     = nullptr;
+        dedicatedInfo.image     = image;
+        dedicatedInfo.buffer    = buffer;
+    }
+    VkExportMemoryAllocateInfoKHR exportInfo;
+    {
+        exportInfo.sType        = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO_KHR;
+        exportInfo.pNext        = (HasExtension(VKExt::KHR_dedicated_allocation) ? &dedicatedInfo : nullptr);
+        exportInfo.handleTypes  = VKGetExternalMemoryHandleType();
+    }
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Exported memory is never shared with other resources, so it always gets its own chunk that is released with the resource */
+    const auto memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, properties);
+    return AllocChunk(requirements.size, memoryTypeIndex, true, &exportInfo)->Allocate(requirements.size, requirements.alignment);
+}
+
 void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
 {
     if (region)
     {
+        std::lock_guard<std::mutex> guard{ mutex_ };
         if (auto chunk = region->GetParentChunk())
         {
             /* Release block in chunk */
             chunk->Release(region);
 
-            /* Release chunk if it's empty */
+            /* Release chunk if it's empty, but retain one pooled chunk per memory type for frequently re-created resources */
             if (chunk->IsEmpty())
-                chunks_.erase(chunk);
+            {
+                VKDeviceMemory*& emptyChunk = emptyChunks_[chunk->GetMemoryTypeIndex()];
+                if (!chunk->IsDedicated() && emptyChunk == nullptr)
+                {
+                    /* Reset priority of retained chunk, so it doesn't outlive the resources it has been raised for */
+                    if (chunk->GetPriority() != g_defaultMemoryPriority)
+                        chunk->SetPriority(device_, g_defaultMemoryPriority);
+                    emptyChunk = chunk;
+                }
+                else
+                    ReleaseChunk(chunk);
+            }
+        }
+    }
+}
+
+bool VKDeviceMemoryManager::SetPriority(VKDeviceMemoryRegion* region, float priority)
+{
+    if (region == nullptr || !HasExtension(VKExt::EXT_pageable_device_local_memory))
+        return false;
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    if (auto chunk = region->GetParentChunk())
+    {
+        if (chunk->IsDedicated() || priority > chunk->GetPriority())
+            chunk->SetPriority(device_, priority);
+        return true;
+    }
+
+    return false;
+}
+
+VkDeviceSize VKDeviceMemoryManager::ReleaseRetainedChunks(VkDeviceSize budget)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    VkDeviceSize releasedSize = 0;
+
+    for (VKDeviceMemory*& chunk : emptyChunks_)
+    {
+        if (chunk != nullptr && releasedSize + chunk->GetSize() <= budget)
+        {
+            releasedSize += chunk->GetSize();
+            ReleaseChunk(chunk);
+            chunk = nullptr;
         }
     }
+
+    return releasedSize;
 }
 
 VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     VKDeviceMemoryDetails details;
     {
         for (const auto& chunk : chunks_)
@@ -81,10 +175,35 @@ VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
     return details;
 }
 
+VKDeviceMemoryDetails VKDeviceMemoryManager::QueryHeapDetails(std::uint32_t heapIndex) const
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    VKDeviceMemoryDetails details;
+    {
+        for (const auto& chunk : chunks_)
+        {
+            if (memoryProperties_.memoryTypes[chunk->GetMemoryTypeIndex()].heapIndex == heapIndex)
+                chunk->AccumDetails(details);
+        }
+    }
+    return details;
+}
+
+bool VKDeviceMemoryManager::HasMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const
+{
+    for_range(i, memoryProperties_.memoryTypeCount)
+    {
+        if ((memoryTypeBits & (1 << i)) != 0 && (memoryProperties_.memoryTypes[i].propertyFlags & properties) == properties)
+            return true;
+    }
+    return false;
+}
+
 #ifdef LLGL_DEBUG
 
 void VKDeviceMemoryManager::PrintBlocks(std::ostream& s, const std::string& title) const
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     std::size_t i = 0;
     for (const auto& chunk : chunks_)
     {
@@ -119,22 +238,54 @@ std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits
     return VKFindMemoryType(memoryProperties_, memoryTypeBits, properties);
 }
 
-VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex)
+VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex, bool dedicated, const void* allocInfoNext)
 {
-    return chunks_.emplace<VKDeviceMemory>(device_, size, memoryTypeIndex);
+    VKDeviceMemory* chunk = chunks_.emplace<VKDeviceMemory>(device_, size, memoryTypeIndex, dedicated, allocInfoNext);
+    if (!dedicated)
+        pools_[memoryTypeIndex].push_back(chunk);
+    return chunk;
 }
 
-VKDeviceMemory* VKDeviceMemoryManager::FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize)
+void VKDeviceMemoryManager::ReleaseChunk(VKDeviceMemory* chunk)
 {
-    /* Search for a suitable chunk */
-    for (const auto& chunk : chunks_)
+    if (!chunk->IsDedicated())
     {
-        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize && chunk->GetMemoryTypeIndex() == memoryTypeIndex)
-            return chunk.get();
+        /* Remove chunk from its pool by swapping it with the last entry */
+        std::vector<VKDeviceMemory*>& pool = pools_[chunk->GetMemoryTypeIndex()];
+        auto it = std::find(pool.begin(), pool.end(), chunk);
+        if (it != pool.end())
+        {
+            *it = pool.back();
+            pool.pop_back();
+        }
+    }
+    chunks_.erase(chunk);
+}
+
+VKDeviceMemoryRegion* VKDeviceMemoryManager::AllocFromPool(VkDeviceSize size, VkDeviceSize alignment, std::uint32_t memoryTypeIndex)
+{
+    const std::vector<VKDeviceMemory*>& pool = pools_[memoryTypeIndex];
+
+    if (reduceFragmentation_)
+    {
+        /* Try oldest chunks first to keep newer chunks sparse, so they are more likely to be released */
+        for (VKDeviceMemory* chunk : pool)
+        {
+            if (auto region = chunk->Allocate(size, alignment))
+                return region;
+        }
+    }
+    else
+    {
+        /* Try newest chunks first, since they are the most likely to have free blocks left */
+        for (auto it = pool.rbegin(); it != pool.rend(); ++it)
+        {
+            if (auto region = (*it)->Allocate(size, alignment))
+                return region;
+        }
     }
 
-    /* Allocate new chunk */
-    return AllocChunk(allocationSize, memoryTypeIndex);
+    return nullptr;
 }
 
 
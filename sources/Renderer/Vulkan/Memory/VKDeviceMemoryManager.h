@@ -17,6 +17,7 @@
 #include "VKDeviceMemoryRegion.h"
 #include <vector>
 #include <memory>
+#include <mutex>
 
 
 namespace LLGL
@@ -28,6 +29,8 @@ Vulkan device memory manager. Memory allocations are stored in a small hierarchy
  - Chunk: denotes a single Vulkan memory allocation of type VkDeviceMemory
  - Block: denotes one of multiple regions inside a chunk of type VkBuffer
  - Region: denotes a sub-range inside a block and holds a reference to the VkBuffer and its offset and size (both of type VkDeviceSize).
+Chunks are pooled per memory type. Allocations that are at least as large as the minimal allocation size get their own dedicated chunk.
+All public functions are synchronized, so resources can be created and released on multiple threads.
 */
 class VKDeviceMemoryManager
 {
@@ -58,18 +61,45 @@ class VKDeviceMemoryManager
             VkMemoryPropertyFlags       properties
         );
 
+        /*
+        Allocates a dedicated device memory chunk for the specified buffer or image that can be exported as native handle.
+        Exactly one of 'buffer' and 'image' must be specified; the resource must have been created with the external memory handle type.
+        */
+        VKDeviceMemoryRegion* AllocateExportable(
+            const VkMemoryRequirements& requirements,
+            VkMemoryPropertyFlags       properties,
+            VkBuffer                    buffer,
+            VkImage                     image
+        );
+
         // Releases the specified device memory block.
         void Release(VKDeviceMemoryRegion* region);
 
+        /*
+        Sets the priority of the chunk the specified region has been allocated from. Returns false if VK_EXT_pageable_device_local_memory is not supported.
+        Dedicated chunks take the priority as is. Shared chunks are only raised, so other resources in the same chunk are never demoted,
+        and they are reset to the default priority once they are empty.
+        */
+        bool SetPriority(VKDeviceMemoryRegion* region, float priority);
+
+        // Releases retained empty chunks up to the specified budget (in bytes) and returns the number of bytes that have been released.
+        VkDeviceSize ReleaseRetainedChunks(VkDeviceSize budget);
+
         // Queries the memory details of all chunks.
         VKDeviceMemoryDetails QueryDetails() const;
 
+        // Queries the memory details of all chunks that have been allocated from the specified memory heap.
+        VKDeviceMemoryDetails QueryHeapDetails(std::uint32_t heapIndex) const;
+
         #ifdef LLGL_DEBUG
 
         void PrintBlocks(std::ostream& s, const std::string& title = "") const;
 
         #endif
 
+        // Returns true if there is a memory type with the specified attributes.
+        bool HasMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
+
         // Returns the VkDevice object used for this device memory manager.
         inline VkDevice GetVkDevice() const
         {
@@ -82,10 +112,13 @@ class VKDeviceMemoryManager
         std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
 
         // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
-        VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
+        VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, bool dedicated, const void* allocInfoNext = nullptr);
 
-        // Finds a suitable device memory chunk or allocates a new one.
-        VKDeviceMemory* FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize);
+        // Releases the specified VkDeviceMemory chunk and removes it from its pool.
+        void ReleaseChunk(VKDeviceMemory* chunk);
+
+        // Tries to allocate a block from the pooled chunks of the specified memory type.
+        VKDeviceMemoryRegion* AllocFromPool(VkDeviceSize size, VkDeviceSize alignment, std::uint32_t memoryTypeIndex);
 
     private:
 
@@ -96,6 +129,10 @@ class VKDeviceMemoryManager
         bool                                        reduceFragmentation_    = false;
 
         UnorderedUniquePtrVector<VKDeviceMemory>    chunks_;
+        std::vector<VKDeviceMemory*>                pools_[VK_MAX_MEMORY_TYPES];
+        VKDeviceMemory*                             emptyChunks_[VK_MAX_MEMORY_TYPES]   = {}; // One retained empty chunk per memory type
+
+        mutable std::mutex                          mutex_;
 
 };
 
@@ -67,18 +67,22 @@ class VKDeviceMemoryRegion
 
         friend class VKDeviceMemory;
 
-        // Tries to merge the specified region into this region, and returns true on success.
-        bool MergeWith(VKDeviceMemoryRegion& other);
-
         // Sets the new size and offset.
         void MoveAt(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
 
     private:
 
-        VKDeviceMemory* deviceMemory_       = nullptr;
-        VkDeviceSize    size_               = 0;
-        VkDeviceSize    offset_             = 0;
-        std::uint32_t   memoryTypeIndex_    = 0;
+        VKDeviceMemory*         deviceMemory_       = nullptr;
+        VkDeviceSize            size_               = 0;
+        VkDeviceSize            offset_             = 0;
+        std::uint32_t           memoryTypeIndex_    = 0;
+
+        /* Links that are managed by the TLSF allocator of the parent chunk */
+        bool                    isFree_             = false;
+        VKDeviceMemoryRegion*   prevPhysical_       = nullptr;
+        VKDeviceMemoryRegion*   nextPhysical_       = nullptr;
+        VKDeviceMemoryRegion*   prevFree_           = nullptr;
+        VKDeviceMemoryRegion*   nextFree_           = nullptr;
 
 };
 
@@ -0,0 +1,148 @@
+/*
+ * VKExternalHandle.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKExternalHandle.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
+
+
+namespace LLGL
+{
+
+
+#ifdef LLGL_OS_WIN32
+static constexpr ExternalHandleType g_externalHandleType = ExternalHandleType::OpaqueWin32;
+#else
+static constexpr ExternalHandleType g_externalHandleType = ExternalHandleType::OpaqueFD;
+#endif
+
+bool VKIsExternalMemorySupported()
+{
+    #ifdef LLGL_OS_WIN32
+    return HasExtension(VKExt::KHR_external_memory_win32);
+    #else
+    return HasExtension(VKExt::KHR_external_memory_fd);
+    #endif
+}
+
+bool VKIsExternalSemaphoreSupported()
+{
+    #ifdef LLGL_OS_WIN32
+    return HasExtension(VKExt::KHR_external_semaphore_win32);
+    #else
+    return HasExtension(VKExt::KHR_external_semaphore_fd);
+    #endif
+}
+
+VkExternalMemoryHandleTypeFlagBitsKHR VKGetExternalMemoryHandleType()
+{
+    #ifdef LLGL_OS_WIN32
+    return VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT_KHR;
+    #else
+    return VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT_KHR;
+    #endif
+}
+
+VkExternalSemaphoreHandleTypeFlagBitsKHR VKGetExternalSemaphoreHandleType()
+{
+    #ifdef LLGL_OS_WIN32
+    return VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_WIN32_BIT_KHR;
+    #else
+    return VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT_KHR;
+    #endif
+}
+
+bool VKExportMemoryHandle(VkDevice device, VkDeviceMemory deviceMemory, VkDeviceSize size, ExternalHandle& outHandle)
+{
+    if (!VKIsExternalMemorySupported() || deviceMemory == VK_NULL_HANDLE)
+        return false;
+
+    #ifdef LLGL_OS_WIN32
+
+    VkMemoryGetWin32HandleInfoKHR getInfo;
+    {
+        getInfo.sType       = VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR;
+        getInfo.pNext       = nullptr;
+        getInfo.memory      = deviceMemory;
+        getInfo.handleType  = VKGetExternalMemoryHandleType();
+    }
+    HANDLE handle = nullptr;
+    if (vkGetMemoryWin32HandleKHR(device, &getInfo, &handle) != VK_SUCCESS)
+        return false;
+
+    outHandle.handle    = reinterpret_cast<std::intptr_t>(handle);
+
+    #else
+
+    VkMemoryGetFdInfoKHR getInfo;
+    {
+        getInfo.sType       = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
+        getInfo.pNext       = nullptr;
+        getInfo.memory      = deviceMemory;
+        getInfo.handleType  = VKGetExternalMemoryHandleType();
+    }
+    int fd = -1;
+    if (vkGetMemoryFdKHR(device, &getInfo, &fd) != VK_SUCCESS)
+        return false;
+
+    outHandle.handle    = static_cast<std::intptr_t>(fd);
+
+    #endif
+
+    outHandle.type      = g_externalHandleType;
+    outHandle.size      = static_cast<std::uint64_t>(size);
+    return true;
+}
+
+bool VKExportSemaphoreHandle(VkDevice device, VkSemaphore semaphore, ExternalHandle& outHandle)
+{
+    if (!VKIsExternalSemaphoreSupported() || semaphore == VK_NULL_HANDLE)
+        return false;
+
+    #ifdef LLGL_OS_WIN32
+
+    VkSemaphoreGetWin32HandleInfoKHR getInfo;
+    {
+        getInfo.sType       = VK_STRUCTURE_TYPE_SEMAPHORE_GET_WIN32_HANDLE_INFO_KHR;
+        getInfo.pNext       = nullptr;
+        getInfo.semaphore   = semaphore;
+        getInfo.handleType  = VKGetExternalSemaphoreHandleType();
+    }
+    HANDLE handle = nullptr;
+    if (vkGetSemaphoreWin32HandleKHR(device, &getInfo, &handle) != VK_SUCCESS)
+        return false;
+
+    outHandle.handle    = reinterpret_cast<std::intptr_t>(handle);
+
+    #else
+
+    VkSemaphoreGetFdInfoKHR getInfo;
+    {
+        getInfo.sType       = VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR;
+        getInfo.pNext       = nullptr;
+        getInfo.semaphore   = semaphore;
+        getInfo.handleType  = VKGetExternalSemaphoreHandleType();
+    }
+    int fd = -1;
+    if (vkGetSemaphoreFdKHR(device, &getInfo, &fd) != VK_SUCCESS)
+        return false;
+
+    outHandle.handle    = static_cast<std::intptr_t>(fd);
+
+    #endif
+
+    outHandle.type      = g_externalHandleType;
+    outHandle.size      = 0;
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
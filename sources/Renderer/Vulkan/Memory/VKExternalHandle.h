@@ -0,0 +1,46 @@
+/*
+ * VKExternalHandle.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_EXTERNAL_HANDLE_H
+#define LLGL_VK_EXTERNAL_HANDLE_H
+
+
+#include "../Vulkan.h"
+#include <LLGL/RenderSystemFlags.h>
+
+
+namespace LLGL
+{
+
+
+// Returns true if device memory can be exported as native handle, i.e. VK_KHR_external_memory_win32 or VK_KHR_external_memory_fd is supported.
+bool VKIsExternalMemorySupported();
+
+// Returns true if timeline semaphores can be exported as native handle, i.e. VK_KHR_external_semaphore_win32 or VK_KHR_external_semaphore_fd is supported.
+bool VKIsExternalSemaphoreSupported();
+
+// Returns the native handle type for exported device memory on this platform, i.e. Win32 handles on Windows and POSIX file descriptors otherwise.
+VkExternalMemoryHandleTypeFlagBitsKHR VKGetExternalMemoryHandleType();
+
+// Returns the native handle type for exported semaphores on this platform.
+VkExternalSemaphoreHandleTypeFlagBitsKHR VKGetExternalSemaphoreHandleType();
+
+// Exports the specified device memory as new native handle. The size is only forwarded to the output handle.
+bool VKExportMemoryHandle(VkDevice device, VkDeviceMemory deviceMemory, VkDeviceSize size, ExternalHandle& outHandle);
+
+// Exports the specified semaphore as new native handle.
+bool VKExportSemaphoreHandle(VkDevice device, VkSemaphore semaphore, ExternalHandle& outHandle);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
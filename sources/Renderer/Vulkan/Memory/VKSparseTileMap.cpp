@@ -0,0 +1,73 @@
+/*
+ * VKSparseTileMap.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKSparseTileMap.h"
+#include "VKDeviceMemoryManager.h"
+
+
+namespace LLGL
+{
+
+
+VKSparseTileMap::VKSparseTileMap(VKDeviceMemoryManager& deviceMemoryMngr, const VkMemoryRequirements& requirements) :
+    deviceMemoryMngr_ { deviceMemoryMngr },
+    requirements_     { requirements     }
+{
+}
+
+VKSparseTileMap::~VKSparseTileMap()
+{
+    for (const auto& it : tiles_)
+        deviceMemoryMngr_.Release(it.second);
+    for (VKDeviceMemoryRegion* region : persistentRegions_)
+        deviceMemoryMngr_.Release(region);
+}
+
+VKDeviceMemoryRegion* VKSparseTileMap::AllocTile(std::uint64_t key)
+{
+    VKDeviceMemoryRegion*& region = tiles_[key];
+    if (region != nullptr)
+        return nullptr;
+
+    region = deviceMemoryMngr_.Allocate(
+        requirements_.alignment,
+        requirements_.alignment,
+        requirements_.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+    );
+    return region;
+}
+
+VKDeviceMemoryRegion* VKSparseTileMap::RemoveTile(std::uint64_t key)
+{
+    auto it = tiles_.find(key);
+    if (it == tiles_.end())
+        return nullptr;
+
+    VKDeviceMemoryRegion* region = it->second;
+    tiles_.erase(it);
+    return region;
+}
+
+VKDeviceMemoryRegion* VKSparseTileMap::AllocPersistentRegion(VkDeviceSize size)
+{
+    VKDeviceMemoryRegion* region = deviceMemoryMngr_.Allocate(
+        size,
+        requirements_.alignment,
+        requirements_.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+    );
+    persistentRegions_.push_back(region);
+    return region;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,76 @@
+/*
+ * VKSparseTileMap.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_SPARSE_TILE_MAP_H
+#define LLGL_VK_SPARSE_TILE_MAP_H
+
+
+#include <vulkan/vulkan.h>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class VKDeviceMemoryRegion;
+class VKDeviceMemoryManager;
+
+/*
+Keeps track of the device memory regions that are bound to the tiles of a single sparse resource.
+Each tile is allocated as its own region with the size and alignment of the resource's sparse block size.
+All regions are released when the tile map is destroyed; the owner must ensure that the GPU no longer accesses them at that point.
+*/
+class VKSparseTileMap
+{
+
+    public:
+
+        VKSparseTileMap(VKDeviceMemoryManager& deviceMemoryMngr, const VkMemoryRequirements& requirements);
+        ~VKSparseTileMap();
+
+        VKSparseTileMap(const VKSparseTileMap&) = delete;
+        VKSparseTileMap& operator = (const VKSparseTileMap&) = delete;
+
+        // Allocates a memory region for the tile with the specified key. Returns null if the tile is already resident.
+        VKDeviceMemoryRegion* AllocTile(std::uint64_t key);
+
+        /*
+        Removes the tile with the specified key and returns its memory region. Returns null if the tile is not resident.
+        The caller takes ownership of the region and must release it once the GPU has completed the unbinding.
+        */
+        VKDeviceMemoryRegion* RemoveTile(std::uint64_t key);
+
+        // Allocates a memory region of the specified size that remains bound for the lifetime of the resource, e.g. the MIP tail.
+        VKDeviceMemoryRegion* AllocPersistentRegion(VkDeviceSize size);
+
+        // Returns the size (in bytes) of each tile, i.e. the sparse block size.
+        inline VkDeviceSize GetTileSize() const
+        {
+            return requirements_.alignment;
+        }
+
+    private:
+
+        VKDeviceMemoryManager&                                      deviceMemoryMngr_;
+        VkMemoryRequirements                                        requirements_       = {};
+        std::unordered_map<std::uint64_t, VKDeviceMemoryRegion*>    tiles_;
+        std::vector<VKDeviceMemoryRegion*>                          persistentRegions_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
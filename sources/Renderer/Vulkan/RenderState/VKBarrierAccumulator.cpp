@@ -0,0 +1,319 @@
+/*
+ * VKBarrierAccumulator.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKBarrierAccumulator.h"
+#include "../VKCore.h"
+
+
+namespace LLGL
+{
+
+
+VKBarrierAccumulator::VKBarrierAccumulator(VkDevice device) :
+    device_ { device }
+{
+}
+
+void VKBarrierAccumulator::InsertMemoryBarrier(
+    VkPipelineStageFlags    srcStageMask,
+    VkPipelineStageFlags    dstStageMask,
+    VkAccessFlags           srcAccessMask,
+    VkAccessFlags           dstAccessMask)
+{
+    pending_.srcStageMask |= srcStageMask;
+    pending_.dstStageMask |= dstStageMask;
+    pending_.MergeMemoryBarrier(srcAccessMask, dstAccessMask);
+}
+
+void VKBarrierAccumulator::InsertBufferBarrier(
+    VkBuffer                buffer,
+    VkDeviceSize            offset,
+    VkDeviceSize            size,
+    VkPipelineStageFlags    srcStageMask,
+    VkPipelineStageFlags    dstStageMask,
+    VkAccessFlags           srcAccessMask,
+    VkAccessFlags           dstAccessMask,
+    bool                    deferrable)
+{
+    VkBufferMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = srcAccessMask;
+        barrier.dstAccessMask       = dstAccessMask;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer              = buffer;
+        barrier.offset              = offset;
+        barrier.size                = size;
+    }
+
+    /* Split barriers require events, so deferrable barriers are treated as regular ones without a device */
+    BarrierBatch& batch = (deferrable && device_ != VK_NULL_HANDLE ? deferred_ : pending_);
+    batch.srcStageMask |= srcStageMask;
+    batch.dstStageMask |= dstStageMask;
+    batch.MergeBufferBarrier(barrier);
+}
+
+void VKBarrierAccumulator::InsertImageBarrier(
+    VkImage                         image,
+    const VkImageSubresourceRange&  subresourceRange,
+    VkImageLayout                   oldLayout,
+    VkImageLayout                   newLayout,
+    VkPipelineStageFlags            srcStageMask,
+    VkPipelineStageFlags            dstStageMask,
+    VkAccessFlags                   srcAccessMask,
+    VkAccessFlags                   dstAccessMask)
+{
+    VkImageMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = srcAccessMask;
+        barrier.dstAccessMask       = dstAccessMask;
+        barrier.oldLayout           = oldLayout;
+        barrier.newLayout           = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image               = image;
+        barrier.subresourceRange    = subresourceRange;
+    }
+    pending_.srcStageMask |= srcStageMask;
+    pending_.dstStageMask |= dstStageMask;
+    pending_.MergeImageBarrier(barrier);
+}
+
+void VKBarrierAccumulator::FlushForTransfer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer)
+{
+    if (!deferred_.IsEmpty())
+    {
+        if (deferred_.References(srcBuffer) || deferred_.References(dstBuffer))
+        {
+            /* Transfer command depends on a deferred barrier, so it must also be visible to transfer commands */
+            for (VkBufferMemoryBarrier& barrier : deferred_.bufferBarriers)
+                barrier.dstAccessMask |= (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+            deferred_.dstStageMask |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+            pending_.Append(deferred_);
+        }
+        else
+        {
+            /* Begin split barrier right after its producers; the barriers are recorded with the matching vkCmdWaitEvents */
+            VkEvent event = AllocEvent();
+            vkCmdSetEvent(commandBuffer, event, deferred_.srcStageMask);
+            signaledEvents_.push_back(event);
+            signaled_.Append(deferred_);
+        }
+        deferred_.Clear();
+    }
+    SubmitBarrierBatch(commandBuffer, pending_);
+}
+
+void VKBarrierAccumulator::Flush(VkCommandBuffer commandBuffer)
+{
+    /* End all split barriers that have been signaled since the last flush */
+    if (!signaledEvents_.empty())
+    {
+        vkCmdWaitEvents(
+            commandBuffer,
+            static_cast<std::uint32_t>(signaledEvents_.size()),
+            signaledEvents_.data(),
+            signaled_.srcStageMask,
+            signaled_.dstStageMask,
+            (signaled_.hasMemoryBarrier ? 1u : 0u),
+            (signaled_.hasMemoryBarrier ? &(signaled_.memoryBarrier) : nullptr),
+            static_cast<std::uint32_t>(signaled_.bufferBarriers.size()),
+            signaled_.bufferBarriers.data(),
+            static_cast<std::uint32_t>(signaled_.imageBarriers.size()),
+            signaled_.imageBarriers.data()
+        );
+        signaledEvents_.clear();
+        signaled_.Clear();
+    }
+
+    /* Deferrable barriers that have not been signaled yet have no independent work to overlap with */
+    if (!deferred_.IsEmpty())
+    {
+        pending_.Append(deferred_);
+        deferred_.Clear();
+    }
+
+    SubmitBarrierBatch(commandBuffer, pending_);
+}
+
+void VKBarrierAccumulator::Reset()
+{
+    for (std::size_t i = 0; i < numEventsInUse_; ++i)
+        vkResetEvent(device_, events_[i]);
+    numEventsInUse_ = 0;
+
+    pending_.Clear();
+    deferred_.Clear();
+    signaled_.Clear();
+    signaledEvents_.clear();
+}
+
+bool VKBarrierAccumulator::IsEmpty() const
+{
+    return (pending_.IsEmpty() && deferred_.IsEmpty() && signaledEvents_.empty());
+}
+
+
+/*
+ * BarrierBatch structure
+ */
+
+static bool IsEqualVkImageSubresourceRange(const VkImageSubresourceRange& lhs, const VkImageSubresourceRange& rhs)
+{
+    return
+    (
+        lhs.aspectMask      == rhs.aspectMask       &&
+        lhs.baseMipLevel    == rhs.baseMipLevel     &&
+        lhs.levelCount      == rhs.levelCount       &&
+        lhs.baseArrayLayer  == rhs.baseArrayLayer   &&
+        lhs.layerCount      == rhs.layerCount
+    );
+}
+
+void VKBarrierAccumulator::BarrierBatch::MergeMemoryBarrier(VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask)
+{
+    if (hasMemoryBarrier)
+    {
+        memoryBarrier.srcAccessMask |= srcAccessMask;
+        memoryBarrier.dstAccessMask |= dstAccessMask;
+    }
+    else
+    {
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext         = nullptr;
+        memoryBarrier.srcAccessMask = srcAccessMask;
+        memoryBarrier.dstAccessMask = dstAccessMask;
+        hasMemoryBarrier            = true;
+    }
+}
+
+void VKBarrierAccumulator::BarrierBatch::MergeBufferBarrier(const VkBufferMemoryBarrier& barrier)
+{
+    for (VkBufferMemoryBarrier& entry : bufferBarriers)
+    {
+        if (entry.buffer == barrier.buffer && entry.offset == barrier.offset && entry.size == barrier.size)
+        {
+            entry.srcAccessMask |= barrier.srcAccessMask;
+            entry.dstAccessMask |= barrier.dstAccessMask;
+            return;
+        }
+    }
+    bufferBarriers.push_back(barrier);
+}
+
+void VKBarrierAccumulator::BarrierBatch::MergeImageBarrier(const VkImageMemoryBarrier& barrier)
+{
+    for (VkImageMemoryBarrier& entry : imageBarriers)
+    {
+        if (entry.image == barrier.image && IsEqualVkImageSubresourceRange(entry.subresourceRange, barrier.subresourceRange))
+        {
+            /*
+            Fold consecutive transitions of the same subresource range, since barriers within a single command are not ordered.
+            No command has accessed the intermediate layout, so the image can be transitioned from the pending old layout directly.
+            */
+            entry.newLayout     =  barrier.newLayout;
+            entry.srcAccessMask |= barrier.srcAccessMask;
+            entry.dstAccessMask |= barrier.dstAccessMask;
+            return;
+        }
+    }
+    imageBarriers.push_back(barrier);
+}
+
+void VKBarrierAccumulator::BarrierBatch::Append(const BarrierBatch& rhs)
+{
+    srcStageMask |= rhs.srcStageMask;
+    dstStageMask |= rhs.dstStageMask;
+
+    if (rhs.hasMemoryBarrier)
+        MergeMemoryBarrier(rhs.memoryBarrier.srcAccessMask, rhs.memoryBarrier.dstAccessMask);
+    for (const VkBufferMemoryBarrier& barrier : rhs.bufferBarriers)
+        MergeBufferBarrier(barrier);
+    for (const VkImageMemoryBarrier& barrier : rhs.imageBarriers)
+        MergeImageBarrier(barrier);
+}
+
+void VKBarrierAccumulator::BarrierBatch::Clear()
+{
+    srcStageMask        = 0;
+    dstStageMask        = 0;
+    hasMemoryBarrier    = false;
+    bufferBarriers.clear();
+    imageBarriers.clear();
+}
+
+bool VKBarrierAccumulator::BarrierBatch::IsEmpty() const
+{
+    return (!hasMemoryBarrier && bufferBarriers.empty() && imageBarriers.empty());
+}
+
+bool VKBarrierAccumulator::BarrierBatch::References(VkBuffer buffer) const
+{
+    if (buffer != VK_NULL_HANDLE)
+    {
+        for (const VkBufferMemoryBarrier& barrier : bufferBarriers)
+        {
+            if (barrier.buffer == buffer)
+                return true;
+        }
+    }
+    return false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKBarrierAccumulator::SubmitBarrierBatch(VkCommandBuffer commandBuffer, BarrierBatch& batch)
+{
+    if (batch.IsEmpty())
+        return;
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        batch.srcStageMask,
+        batch.dstStageMask,
+        0, // VkDependencyFlags
+        (batch.hasMemoryBarrier ? 1u : 0u),
+        (batch.hasMemoryBarrier ? &(batch.memoryBarrier) : nullptr),
+        static_cast<std::uint32_t>(batch.bufferBarriers.size()),
+        batch.bufferBarriers.data(),
+        static_cast<std::uint32_t>(batch.imageBarriers.size()),
+        batch.imageBarriers.data()
+    );
+    batch.Clear();
+}
+
+VkEvent VKBarrierAccumulator::AllocEvent()
+{
+    if (numEventsInUse_ == events_.size())
+    {
+        VkEventCreateInfo createInfo;
+        {
+            createInfo.sType    = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+            createInfo.pNext    = nullptr;
+            createInfo.flags    = 0;
+        }
+        VKPtr<VkEvent> event{ device_, vkDestroyEvent };
+        VkResult result = vkCreateEvent(device_, &createInfo, nullptr, event.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan event for split barrier");
+        events_.push_back(std::move(event));
+    }
+    return events_[numEventsInUse_++].Get();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,150 @@
+/*
+ * VKBarrierAccumulator.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_BARRIER_ACCUMULATOR_H
+#define LLGL_VK_BARRIER_ACCUMULATOR_H
+
+
+#include <LLGL/Container/SmallVector.h>
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Accumulates pending memory, buffer, and image barriers of a command buffer and records them with a single vkCmdPipelineBarrier.
+Barriers must be flushed before any command that depends on them, i.e. before draw, dispatch, and transfer commands and before a render pass begins.
+Deferrable barriers are turned into split barriers: They are signaled with vkCmdSetEvent before the next independent transfer command
+and only waited for with vkCmdWaitEvents on the next full flush, so the transfer commands in between can overlap with the producer.
+*/
+class VKBarrierAccumulator
+{
+
+    public:
+
+        // Initializes the accumulator. Split barriers are only used if a valid device is specified to create VkEvent objects.
+        VKBarrierAccumulator(VkDevice device = VK_NULL_HANDLE);
+
+        VKBarrierAccumulator(const VKBarrierAccumulator&) = delete;
+        VKBarrierAccumulator& operator = (const VKBarrierAccumulator&) = delete;
+
+        // Inserts a global memory barrier. All global memory barriers are merged into a single one.
+        void InsertMemoryBarrier(
+            VkPipelineStageFlags    srcStageMask,
+            VkPipelineStageFlags    dstStageMask,
+            VkAccessFlags           srcAccessMask,
+            VkAccessFlags           dstAccessMask
+        );
+
+        /*
+        Inserts a buffer memory barrier. Barriers for the same buffer range are merged.
+        If 'deferrable' is true, the barrier only guards accesses from subsequent draw and dispatch commands and may be split.
+        */
+        void InsertBufferBarrier(
+            VkBuffer                buffer,
+            VkDeviceSize            offset,
+            VkDeviceSize            size,
+            VkPipelineStageFlags    srcStageMask,
+            VkPipelineStageFlags    dstStageMask,
+            VkAccessFlags           srcAccessMask,
+            VkAccessFlags           dstAccessMask,
+            bool                    deferrable      = false
+        );
+
+        /*
+        Inserts an image memory barrier. A pending transition of the same subresource range is folded into the new one,
+        e.g. a pending transition A -> B followed by B -> C results in a single transition A -> C.
+        Pending transitions of partially overlapping subresource ranges must be flushed before a new one is inserted.
+        */
+        void InsertImageBarrier(
+            VkImage                         image,
+            const VkImageSubresourceRange&  subresourceRange,
+            VkImageLayout                   oldLayout,
+            VkImageLayout                   newLayout,
+            VkPipelineStageFlags            srcStageMask,
+            VkPipelineStageFlags            dstStageMask,
+            VkAccessFlags                   srcAccessMask,
+            VkAccessFlags                   dstAccessMask
+        );
+
+        /*
+        Records all pending barriers in front of a transfer command that accesses the specified buffers.
+        Deferrable barriers that are independent of these buffers are signaled as split barriers instead.
+        */
+        void FlushForTransfer(
+            VkCommandBuffer commandBuffer,
+            VkBuffer        srcBuffer   = VK_NULL_HANDLE,
+            VkBuffer        dstBuffer   = VK_NULL_HANDLE
+        );
+
+        // Waits for all signaled split barriers and records all pending barriers, e.g. in front of a draw or dispatch command.
+        void Flush(VkCommandBuffer commandBuffer);
+
+        /*
+        Resets all events of previous split barriers. This must only be called once the command buffer that used them has completed.
+        Each event is signaled at most once between two resets, so split barriers must not be used in command buffers that are submitted multiple times.
+        */
+        void Reset();
+
+        // Returns true if there are no barriers left to be recorded.
+        bool IsEmpty() const;
+
+    private:
+
+        struct BarrierBatch
+        {
+            VkPipelineStageFlags                    srcStageMask        = 0;
+            VkPipelineStageFlags                    dstStageMask        = 0;
+            VkMemoryBarrier                         memoryBarrier;
+            bool                                    hasMemoryBarrier    = false;
+            SmallVector<VkBufferMemoryBarrier, 4u>  bufferBarriers;
+            SmallVector<VkImageMemoryBarrier, 4u>   imageBarriers;
+
+            void MergeMemoryBarrier(VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask);
+            void MergeBufferBarrier(const VkBufferMemoryBarrier& barrier);
+            void MergeImageBarrier(const VkImageMemoryBarrier& barrier);
+            void Append(const BarrierBatch& rhs);
+            void Clear();
+            bool IsEmpty() const;
+            bool References(VkBuffer buffer) const;
+        };
+
+    private:
+
+        // Records all barriers of the specified batch with a single vkCmdPipelineBarrier.
+        static void SubmitBarrierBatch(VkCommandBuffer commandBuffer, BarrierBatch& batch);
+
+        // Returns an unused event from the pool and creates a new one if necessary.
+        VkEvent AllocEvent();
+
+    private:
+
+        VkDevice                        device_             = VK_NULL_HANDLE;
+
+        BarrierBatch                    pending_;                               // Barriers that are recorded on the next flush
+        BarrierBatch                    deferred_;                              // Deferrable barriers that have not been signaled yet
+        BarrierBatch                    signaled_;                              // Barriers of split barriers that wait for 'signaledEvents_'
+
+        SmallVector<VkEvent, 4u>        signaledEvents_;
+        std::vector<VKPtr<VkEvent>>     events_;
+        std::size_t                     numEventsInUse_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -19,12 +19,29 @@ namespace LLGL
 {
 
 
-VKComputePSO::VKComputePSO(VkDevice device, const ComputePipelineDescriptor& desc)
+VKComputePSO::VKComputePSO(
+    VkDevice                            device,
+"    const ComputePipelineDescriptor&    desc,
+    bool                                hasSubgroupSizeControl,
+    VkPipelineCache                     pipelineCache,
+    bool                                isAsync,
+    PipelineState*                      fallbackPipelineState)
 :
     VKPipelineState { device, VK_PIPELINE_BIND_POINT_COMPUTE, GetShadersAsArray(desc), desc.pipelineLayout }
 {
     /* Create Vulkan compute pipeline object */
-    CreateVkPipeline(device, desc);
+    if (isAsync)
+    {
+        CreateVkPipelineAsync(
+            [this, device, desc, hasSubgroupSizeControl, pipelineCache]()
+            {
+                this->CreateVkPipeline(device, desc, hasSubgroupSizeControl, pipelineCache);
+            },
+            fallbackPipelineState
+        );
+    }
+    else
+        CreateVkPipeline(device, desc, hasSubgroupSizeControl, pipelineCache);
 }
 
 
@@ -32,7 +49,11 @@ VKComputePSO::VKComputePSO(VkDevice device, const ComputePipelineDescriptor& des
  * ======= Private: =======
  */
 
-void VKComputePSO::CreateVkPipeline(VkDevice device, const ComputePipelineDescriptor& desc)
+void VKComputePSO::CreateVkPipeline(
+    VkDevice                            device,
+    const ComputePipelineDescriptor&    desc,
+    bool                                hasSubgroupSizeControl,
+    VkPipelineCache                     pipelineCache)
 {
     /* Get compute shader */
     auto computeShaderVK = LLGL_CAST(VKShader*, desc.computeShader);
@@ -43,6 +64,17 @@ void VKComputePSO::CreateVkPipeline(VkDevice device, const ComputePipelineDescri
     VkPipelineShaderStageCreateInfo shaderStageCreateInfo;
     GetShaderCreateInfoAndOptionalPermutation(*computeShaderVK, shaderStageCreateInfo);
 
+    /* Require subgroup size with full subgroups if specified */
+    VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT requiredSubgroupSizeInfo;
+    if (hasSubgroupSizeControl && desc.requiredSubgroupSize != 0)
+    {
+        requiredSubgroupSizeInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO_EXT;
+        requiredSubgroupSizeInfo.pNext                  = const_cast<void*>(shaderStageCreateInfo.pNext);
+        requiredSubgroupSizeInfo.requiredSubgroupSize   = desc.requiredSubgroupSize;
+        shaderStageCreateInfo.pNext                     = &requiredSubgroupSizeInfo;
+        shaderStageCreateInfo.flags                     |= VK_PIPELINE_SHADER_STAGE_CREATE_REQUIRE_FULL_SUBGROUPS_BIT_EXT;
+    }
+
     /* Create graphics pipeline state object */
     VkComputePipelineCreateInfo createInfo;
     {
@@ -54,7 +86,7 @@ void VKComputePSO::CreateVkPipeline(VkDevice device, const ComputePipelineDescri
         createInfo.basePipelineHandle   = VK_NULL_HANDLE;
         createInfo.basePipelineIndex    = 0;
     }
-    auto result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, ReleaseAndGetAddressOfVkPipeline());
+    auto result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, ReleaseAndGetAddressOfVkPipeline());
     VKThrowIfFailed(result, "failed to create Vulkan compute pipeline");
 }
 
@@ -23,11 +23,23 @@ class VKComputePSO final : public VKPipelineState
 
     public:
 
-        VKComputePSO(VkDevice device, const ComputePipelineDescriptor& desc);
+        VKComputePSO(
+            VkDevice                            device,
+            const ComputePipelineDescriptor&    desc,
+            bool                                hasSubgroupSizeControl,
+            VkPipelineCache                     pipelineCache           = VK_NULL_HANDLE,
+            bool                                isAsync                 = false,
+            PipelineState*                      fallbackPipelineState   = nullptr
+        );
 
     private:
 
-        void CreateVkPipeline(VkDevice device, const ComputePipelineDescriptor& desc);
+        void CreateVkPipeline(
+            VkDevice                            device,
+            const ComputePipelineDescriptor&    desc,
+            bool                                hasSubgroupSizeControl,
+            VkPipelineCache                     pipelineCache
+        );
 
 };
 
@@ -8,10 +8,15 @@
 #include "VKDescriptorCache.h"
 #include "VKStagingDescriptorSetPool.h"
 #include "../VKCore.h"
+#include "../VKStaticLimits.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
 #include "../Buffer/VKBuffer.h"
 #include "../Texture/VKTexture.h"
 #include "../Texture/VKSampler.h"
+#include "../Buffer/VKAccelerationStructure.h"
 #include "../../CheckedCast.h"
+#include "../../../Core/Assertion.h"
 #include <LLGL/Utils/ForRange.h>
 #include <vector>
 #include <algorithm>
@@ -59,18 +64,37 @@ VKDescriptorCache::VKDescriptorCache(
     BuildCopyDescriptors(bindings);
 }
 
+VKDescriptorCache::VKDescriptorCache(
+    VkDevice                            device,
+    const ArrayView<VKLayoutBinding>&   bindings)
+:
+    device_         { device                                     },
+    numDescriptors_ { static_cast<std::uint32_t>(bindings.size()) }
+{
+    LLGL_ASSERT(bindings.size() <= LLGL_VK_MAX_NUM_PUSH_DESCRIPTORS);
+
+    /* Pre-allocate VkWriteDescriptorSet array for all push descriptors */
+    BuildPushDescriptorWrites(bindings);
+}
+
 void VKDescriptorCache::Reset()
 {
     setWriter_.Reset();
     dirty_ = true;
 }
 
-void VKDescriptorCache::EmplaceDescriptor(Resource& resource, const VKLayoutBinding& binding)
+void VKDescriptorCache::EmplaceDescriptor(std::uint32_t descriptor, Resource& resource, const VKLayoutBinding& binding)
 {
+    if (IsPushDescriptorSet())
+    {
+        EmplacePushDescriptor(descriptor, resource);
+        return;
+    }
+
     switch (resource.GetResourceType())
     {
         case ResourceType::Buffer:
-            EmplaceBufferDescriptor(LLGL_CAST(VKBuffer&, resource), binding);
+            EmplaceBufferDescriptor(LLGL_CAST(VKBuffer&, resource), 0, VK_WHOLE_SIZE, binding);
             dirty_ = true;
             break;
 
@@ -84,11 +108,32 @@ void VKDescriptorCache::EmplaceDescriptor(Resource& resource, const VKLayoutBind
             dirty_ = true;
             break;
 
+        case ResourceType::AccelerationStructure:
+            EmplaceAccelerationStructureDescriptor(LLGL_CAST(VKAccelerationStructure&, resource), binding);
+            dirty_ = true;
+            break;
+
         default:
             break;
     }
 }
 
+void VKDescriptorCache::EmplaceBufferRangeDescriptor(std::uint32_t descriptor, VKBuffer& bufferVK, VkDeviceSize offset, VkDeviceSize range, const VKLayoutBinding& binding)
+{
+    if (IsPushDescriptorSet())
+    {
+        /* Only the buffer info of push descriptors must be updated, which makes per-draw offsets cheap */
+        auto& info = pushInfos_[descriptor];
+        info.buffer.buffer  = bufferVK.GetVkBuffer();
+        info.buffer.offset  = offset;
+        info.buffer.range   = range;
+        pushWritesMask_ |= (1u << descriptor);
+    }
+    else
+        EmplaceBufferDescriptor(bufferVK, offset, range, binding);
+    dirty_ = true;
+}
+
 VkDescriptorSet VKDescriptorCache::FlushDescriptorSet(VKStagingDescriptorSetPool& pool)
 {
     if (!dirty_ || setLayout_ == VK_NULL_HANDLE)
@@ -117,6 +162,53 @@ VkDescriptorSet VKDescriptorCache::FlushDescriptorSet(VKStagingDescriptorSetPool
     return descriptorSetCopy;
 }
 
+void VKDescriptorCache::FlushPushDescriptorSet(
+    VkCommandBuffer     commandBuffer,
+    VkPipelineBindPoint bindPoint,
+    VkPipelineLayout    pipelineLayout,
+    std::uint32_t       set)
+{
+    if (!dirty_)
+        return;
+
+    const std::uint32_t allWritesMask = (numDescriptors_ < 32 ? (1u << numDescriptors_) - 1u : ~0u);
+
+    if (pushWritesMask_ == allWritesMask)
+    {
+        /* Push entire descriptor set with a single update template if the pipeline layout is compatible */
+        VkDescriptorUpdateTemplateKHR updateTemplate = VK_NULL_HANDLE;
+        if (pipelineLayout == pushLayout_ && set == pushSet_)
+            updateTemplate = GetOrCreatePushDescriptorTemplate(bindPoint);
+
+        if (updateTemplate != VK_NULL_HANDLE)
+            vkCmdPushDescriptorSetWithTemplateKHR(commandBuffer, updateTemplate, pipelineLayout, set, pushInfos_.data());
+        else
+            vkCmdPushDescriptorSetKHR(commandBuffer, bindPoint, pipelineLayout, set, numDescriptors_, pushWrites_.data());
+    }
+    else if (pushWritesMask_ != 0)
+    {
+        /* Only push descriptors that have been written so far, since unwritten entries have no valid handles */
+        SmallVector<VkWriteDescriptorSet, LLGL_VK_MAX_NUM_PUSH_DESCRIPTORS> writes;
+        for_range(i, numDescriptors_)
+        {
+            if ((pushWritesMask_ & (1u << i)) != 0)
+                writes.push_back(pushWrites_[i]);
+        }
+        vkCmdPushDescriptorSetKHR(commandBuffer, bindPoint, pipelineLayout, set, static_cast<std::uint32_t>(writes.size()), writes.data());
+    }
+
+    dirty_ = false;
+}
+
+void VKDescriptorCache::SetPushDescriptorTemplateLayout(VkPipelineLayout pipelineLayout, std::uint32_t set)
+{
+    if (IsPushDescriptorSet() && HasExtension(VKExt::KHR_descriptor_update_template) && vkCmdPushDescriptorSetWithTemplateKHR != nullptr)
+    {
+        pushLayout_ = pipelineLayout;
+        pushSet_    = set;
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -148,13 +240,26 @@ VkDescriptorImageInfo* VKDescriptorCache::NextImageInfoOrUpdateCache()
     return info;
 }
 
-void VKDescriptorCache::EmplaceBufferDescriptor(VKBuffer& bufferVK, const VKLayoutBinding& binding)
+VkWriteDescriptorSetAccelerationStructureKHR* VKDescriptorCache::NextAccelerationStructureInfoOrUpdateCache(VkAccelerationStructureKHR accelerationStructure)
+{
+    auto info = setWriter_.NextAccelerationStructureInfo(accelerationStructure);
+    if (info == nullptr)
+    {
+        /* Flush descriptor set update */
+        setWriter_.UpdateDescriptorSets(device_);
+        setWriter_.Reset();
+        return setWriter_.NextAccelerationStructureInfo(accelerationStructure);
+    }
+    return info;
+}
+
+void VKDescriptorCache::EmplaceBufferDescriptor(VKBuffer& bufferVK, VkDeviceSize offset, VkDeviceSize range, const VKLayoutBinding& binding)
 {
     auto bufferInfo = NextBufferInfoOrUpdateCache();
     {
         bufferInfo->buffer  = bufferVK.GetVkBuffer();
-        bufferInfo->offset  = 0;
-        bufferInfo->range   = VK_WHOLE_SIZE;
+        bufferInfo->offset  = offset;
+        bufferInfo->range   = range;
     }
     auto writeDesc = setWriter_.NextWriteDescriptor();
     {
@@ -211,6 +316,23 @@ void VKDescriptorCache::EmplaceSamplerDescriptor(VKSampler& samplerVK, const VKL
     }
 }
 
+void VKDescriptorCache::EmplaceAccelerationStructureDescriptor(VKAccelerationStructure& accelStructVK, const VKLayoutBinding& binding)
+{
+    auto accelStructInfo = NextAccelerationStructureInfoOrUpdateCache(accelStructVK.GetVkAccelerationStructure());
+    auto writeDesc = setWriter_.NextWriteDescriptor();
+    {
+        writeDesc->pNext            = accelStructInfo;
+        writeDesc->dstSet           = descriptorSet_;
+        writeDesc->dstBinding       = binding.dstBinding;
+        writeDesc->dstArrayElement  = 0;
+        writeDesc->descriptorCount  = 1;
+        writeDesc->descriptorType   = binding.descriptorType;
+        writeDesc->pImageInfo       = nullptr;
+        writeDesc->pBufferInfo      = nullptr;
+        writeDesc->pTexelBufferView = nullptr;
+    }
+}
+
 // Returns true if the specified bindings are already sorted by 'dstBinding' in ascending order.
 static bool AreLayoutBindingsSorted(const ArrayView<VKLayoutBinding>& bindings)
 {
@@ -291,6 +413,123 @@ void VKDescriptorCache::UpdateCopyDescriptorSet(VkDescriptorSet dstSet)
         copyDesc.dstSet = dstSet;
 }
 
+static bool IsBufferDescriptorType(VkDescriptorType type)
+{
+    return (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+}
+
+void VKDescriptorCache::BuildPushDescriptorWrites(const ArrayView<VKLayoutBinding>& bindings)
+{
+    /* Build one write descriptor for each binding that refers to its entry in the push descriptor data */
+    pushInfos_.resize(bindings.size());
+    pushWrites_.resize(bindings.size());
+
+    for_range(i, bindings.size())
+    {
+        const bool isBuffer = IsBufferDescriptorType(bindings[i].descriptorType);
+        auto& writeDesc = pushWrites_[i];
+        {
+            writeDesc.sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writeDesc.pNext             = nullptr;
+            writeDesc.dstSet            = VK_NULL_HANDLE; // Ignored for push descriptors
+            writeDesc.dstBinding        = bindings[i].dstBinding;
+            writeDesc.dstArrayElement   = 0;
+            writeDesc.descriptorCount   = 1;
+            writeDesc.descriptorType    = bindings[i].descriptorType;
+            writeDesc.pImageInfo        = (isBuffer ? nullptr : &(pushInfos_[i].image));
+            writeDesc.pBufferInfo       = (isBuffer ? &(pushInfos_[i].buffer) : nullptr);
+            writeDesc.pTexelBufferView  = nullptr;
+        }
+    }
+}
+
+void VKDescriptorCache::EmplacePushDescriptor(std::uint32_t descriptor, Resource& resource)
+{
+    auto& info = pushInfos_[descriptor];
+
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            auto& bufferVK = LLGL_CAST(VKBuffer&, resource);
+            info.buffer.buffer          = bufferVK.GetVkBuffer();
+            info.buffer.offset          = 0;
+            info.buffer.range           = VK_WHOLE_SIZE;
+        }
+        break;
+
+        case ResourceType::Texture:
+        {
+            auto& textureVK = LLGL_CAST(VKTexture&, resource);
+            info.image.sampler          = VK_NULL_HANDLE;
+            info.image.imageView        = textureVK.GetVkImageView();
+            info.image.imageLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+        break;
+
+        case ResourceType::Sampler:
+        {
+            auto& samplerVK = LLGL_CAST(VKSampler&, resource);
+            info.image.sampler          = samplerVK.GetVkSampler();
+            info.image.imageView        = VK_NULL_HANDLE;
+            info.image.imageLayout      = VK_IMAGE_LAYOUT_UNDEFINED;
+        }
+        break;
+
+        default:
+            return;
+    }
+
+    pushWritesMask_ |= (1u << descriptor);
+    dirty_ = true;
+}
+
+VkDescriptorUpdateTemplateKHR VKDescriptorCache::GetOrCreatePushDescriptorTemplate(VkPipelineBindPoint bindPoint)
+{
+    if (bindPoint != VK_PIPELINE_BIND_POINT_GRAPHICS && bindPoint != VK_PIPELINE_BIND_POINT_COMPUTE)
+        return VK_NULL_HANDLE;
+
+    auto& updateTemplate = pushTemplates_[bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS ? 0 : 1];
+    if (updateTemplate.Get() == VK_NULL_HANDLE)
+    {
+        /* Build one template entry for each binding with the same order as the push descriptor data */
+        SmallVector<VkDescriptorUpdateTemplateEntryKHR, LLGL_VK_MAX_NUM_PUSH_DESCRIPTORS> entries;
+        entries.resize(pushWrites_.size());
+
+        for_range(i, pushWrites_.size())
+        {
+            auto& entry = entries[i];
+            {
+                entry.dstBinding        = pushWrites_[i].dstBinding;
+                entry.dstArrayElement   = 0;
+                entry.descriptorCount   = 1;
+                entry.descriptorType    = pushWrites_[i].descriptorType;
+                entry.offset            = i * sizeof(VKDescriptorInfo);
+                entry.stride            = sizeof(VKDescriptorInfo);
+            }
+        }
+
+        VkDescriptorUpdateTemplateCreateInfoKHR createInfo;
+        {
+            createInfo.sType                        = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+            createInfo.pNext                        = nullptr;
+            createInfo.flags                        = 0;
+            createInfo.descriptorUpdateEntryCount   = static_cast<std::uint32_t>(entries.size());
+            createInfo.pDescriptorUpdateEntries     = entries.data();
+            createInfo.templateType                 = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+            createInfo.descriptorSetLayout          = VK_NULL_HANDLE; // Ignored for push descriptors
+            createInfo.pipelineBindPoint            = bindPoint;
+            createInfo.pipelineLayout               = pushLayout_;
+            createInfo.set                          = pushSet_;
+        }
+        updateTemplate = VKPtr<VkDescriptorUpdateTemplateKHR>{ device_, vkDestroyDescriptorUpdateTemplateKHR };
+        auto result = vkCreateDescriptorUpdateTemplateKHR(device_, &createInfo, nullptr, updateTemplate.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan descriptor update template for push descriptors");
+    }
+
+    return updateTemplate.Get();
+}
+
 
 } // /namespace LLGL
 
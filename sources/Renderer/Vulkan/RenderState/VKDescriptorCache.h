@@ -10,10 +10,12 @@
 
 
 #include "../Vulkan.h"
+#include "../VKPtr.h"
 #include "VKPipelineLayout.h"
 #include "VKDescriptorSetWriter.h"
 #include <LLGL/Container/SmallVector.h>
 #include <LLGL/Container/ArrayView.h>
+#include <vector>
 
 
 namespace LLGL
@@ -23,15 +25,21 @@ namespace LLGL
 class VKBuffer;
 class VKTexture;
 class VKSampler;
+class VKAccelerationStructure;
 class VKStagingDescriptorSetPool;
 struct VKLayoutBinding;
 
-// Vulkan descriptor wrapper to manage dynamic descriptor bindings.
+/*
+Vulkan descriptor wrapper to manage dynamic descriptor bindings.
+If the descriptor set layout was created with VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR,
+no descriptor sets are allocated and all descriptors are pushed directly into the command buffer (see FlushPushDescriptorSet).
+*/
 class VKDescriptorCache
 {
 
     public:
 
+        // Initializes the descriptor cache with an intermediate descriptor set, whose descriptors are copied into a new set with each flush.
         VKDescriptorCache(
             VkDevice                            device,
             VkDescriptorPool                    descriptorPool,
@@ -41,11 +49,20 @@ class VKDescriptorCache
             const ArrayView<VKLayoutBinding>&   bindings
         );
 
+        // Initializes the descriptor cache for push descriptors. The number of bindings must not exceed LLGL_VK_MAX_NUM_PUSH_DESCRIPTORS.
+        VKDescriptorCache(
+            VkDevice                            device,
+            const ArrayView<VKLayoutBinding>&   bindings
+        );
+
         // Resets the descriptor cache.
         void Reset();
 
-        // Emplaces a descriptor into the cache for the specified resource.
-        void EmplaceDescriptor(Resource& resource, const VKLayoutBinding& binding);
+        // Emplaces a descriptor into the cache for the specified resource. 'descriptor' is the index of 'binding' within the list of dynamic bindings.
+        void EmplaceDescriptor(std::uint32_t descriptor, Resource& resource, const VKLayoutBinding& binding);
+
+        // Emplaces a descriptor into the cache for the specified buffer range. 'range' can be VK_WHOLE_SIZE.
+        void EmplaceBufferRangeDescriptor(std::uint32_t descriptor, VKBuffer& bufferVK, VkDeviceSize offset, VkDeviceSize range, const VKLayoutBinding& binding);
 
         /*
         Flushes all changed descriptor by allocating a new descriptor set.
@@ -53,24 +70,63 @@ class VKDescriptorCache
         */
         VkDescriptorSet FlushDescriptorSet(VKStagingDescriptorSetPool& pool);
 
+        /*
+        Flushes all changed descriptors by pushing them into the specified command buffer with 'vkCmdPushDescriptorSet(WithTemplate)KHR'.
+        Only valid if this is a push descriptor cache (i.e. IsPushDescriptorSet() is true).
+        */
+        void FlushPushDescriptorSet(
+            VkCommandBuffer     commandBuffer,
+            VkPipelineBindPoint bindPoint,
+            VkPipelineLayout    pipelineLayout,
+            std::uint32_t       set
+        );
+
+        /*
+        Specifies the pipeline layout for which descriptor update templates can be used.
+        Layout permutations with push constants are not compatible with that layout, so those fall back to 'vkCmdPushDescriptorSetKHR'.
+        */
+        void SetPushDescriptorTemplateLayout(VkPipelineLayout pipelineLayout, std::uint32_t set);
+
         // Returns true if any cache entries are invalidated and need to be flushed again.
         inline bool IsInvalidated() const
         {
             return dirty_;
         }
 
+        // Returns true if this cache pushes its descriptors instead of allocating descriptor sets.
+        inline bool IsPushDescriptorSet() const
+        {
+            return !pushWrites_.empty();
+        }
+
+    private:
+
+        // Raw descriptor data for a single binding; This is the entry layout of the descriptor update templates.
+        union VKDescriptorInfo
+        {
+            VkDescriptorImageInfo   image;
+            VkDescriptorBufferInfo  buffer;
+        };
+
     private:
 
         VkDescriptorBufferInfo* NextBufferInfoOrUpdateCache();
         VkDescriptorImageInfo* NextImageInfoOrUpdateCache();
+        VkWriteDescriptorSetAccelerationStructureKHR* NextAccelerationStructureInfoOrUpdateCache(VkAccelerationStructureKHR accelerationStructure);
 
-        void EmplaceBufferDescriptor(VKBuffer& bufferVK, const VKLayoutBinding& binding);
+        void EmplaceBufferDescriptor(VKBuffer& bufferVK, VkDeviceSize offset, VkDeviceSize range, const VKLayoutBinding& binding);
         void EmplaceTextureDescriptor(VKTexture& textureVK, const VKLayoutBinding& binding);
         void EmplaceSamplerDescriptor(VKSampler& samplerVK, const VKLayoutBinding& binding);
+        void EmplaceAccelerationStructureDescriptor(VKAccelerationStructure& accelStructVK, const VKLayoutBinding& binding);
 
         void BuildCopyDescriptors(ArrayView<VKLayoutBinding> bindings);
         void UpdateCopyDescriptorSet(VkDescriptorSet dstSet);
 
+        void BuildPushDescriptorWrites(const ArrayView<VKLayoutBinding>& bindings);
+        void EmplacePushDescriptor(std::uint32_t descriptor, Resource& resource);
+
+        VkDescriptorUpdateTemplateKHR GetOrCreatePushDescriptorTemplate(VkPipelineBindPoint bindPoint);
+
     private:
 
         VkDevice                                device_         = VK_NULL_HANDLE;
@@ -82,6 +138,13 @@ class VKDescriptorCache
         VKDescriptorSetWriter                   setWriter_;
         SmallVector<VkCopyDescriptorSet, 4>     copyDescs_;
 
+        std::vector<VKDescriptorInfo>           pushInfos_;                         // Push descriptor data; One entry for each binding.
+        std::vector<VkWriteDescriptorSet>       pushWrites_;                        // Push descriptor writes; One entry for each binding.
+        std::uint32_t                           pushWritesMask_ = 0;                // Bitmask of push descriptors that have been written at least once.
+        VKPtr<VkDescriptorUpdateTemplateKHR>    pushTemplates_[2];                  // Push descriptor templates for graphics and compute bind points.
+        VkPipelineLayout                        pushLayout_     = VK_NULL_HANDLE;   // Pipeline layout the push descriptor templates are created with.
+        std::uint32_t                           pushSet_        = 0;
+
         bool                                    dirty_          = false;
 
 };
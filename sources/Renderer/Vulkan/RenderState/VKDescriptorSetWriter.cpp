@@ -18,8 +18,10 @@ VKDescriptorSetWriter::VKDescriptorSetWriter(
     std::uint32_t numReservedWrites,
     std::uint32_t numReservedCopies)
 :
-    bufferInfos_ { numResourceViewsMax },
-    imageInfos_  { numResourceViewsMax }
+    bufferInfos_                { numResourceViewsMax },
+    imageInfos_                 { numResourceViewsMax },
+    accelerationStructureInfos_ { numResourceViewsMax },
+    accelerationStructures_     { numResourceViewsMax }
 {
     writes_.reserve(numReservedWrites);
     copies_.reserve(numReservedCopies);
@@ -31,6 +33,7 @@ void VKDescriptorSetWriter::Reset()
     copies_.clear();
     numBufferInfos_ = 0;
     numImageInfos_ = 0;
+    numAccelerationStructureInfos_ = 0;
 }
 
 VkDescriptorBufferInfo* VKDescriptorSetWriter::NextBufferInfo()
@@ -49,6 +52,27 @@ VkDescriptorImageInfo* VKDescriptorSetWriter::NextImageInfo()
         return nullptr;
 }
 
+VkWriteDescriptorSetAccelerationStructureKHR* VKDescriptorSetWriter::NextAccelerationStructureInfo(VkAccelerationStructureKHR accelerationStructure)
+{
+    if (numAccelerationStructureInfos_ < accelerationStructureInfos_.size())
+    {
+        /* Each info refers to its own handle, since the write descriptors are only consumed when the descriptor sets are updated */
+        VkAccelerationStructureKHR& handle = accelerationStructures_[numAccelerationStructureInfos_];
+        handle = accelerationStructure;
+
+        VkWriteDescriptorSetAccelerationStructureKHR& info = accelerationStructureInfos_[numAccelerationStructureInfos_++];
+        {
+            info.sType                      = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+            info.pNext                      = nullptr;
+            info.accelerationStructureCount = 1;
+            info.pAccelerationStructures    = &handle;
+        }
+        return &info;
+    }
+    else
+        return nullptr;
+}
+
 VkWriteDescriptorSet* VKDescriptorSetWriter::NextWriteDescriptor()
 {
     VkWriteDescriptorSet initialWriteDescriptor = {};
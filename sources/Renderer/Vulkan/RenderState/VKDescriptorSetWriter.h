@@ -36,6 +36,9 @@ class VKDescriptorSetWriter
         VkDescriptorBufferInfo* NextBufferInfo();
         VkDescriptorImageInfo* NextImageInfo();
 
+        // Returns the next acceleration structure info that refers to the specified handle. This must be chained into the pNext field of the write descriptor.
+        VkWriteDescriptorSetAccelerationStructureKHR* NextAccelerationStructureInfo(VkAccelerationStructureKHR accelerationStructure);
+
         VkWriteDescriptorSet* NextWriteDescriptor();
         VkCopyDescriptorSet* NextCopyDescriptor();
 
@@ -74,6 +77,10 @@ class VKDescriptorSetWriter
         std::vector<VkDescriptorImageInfo>  imageInfos_;
         std::uint32_t                       numImageInfos_      = 0;
 
+        std::vector<VkWriteDescriptorSetAccelerationStructureKHR>   accelerationStructureInfos_;
+        std::vector<VkAccelerationStructureKHR>                     accelerationStructures_;
+        std::uint32_t                                               numAccelerationStructureInfos_  = 0;
+
         std::vector<VkWriteDescriptorSet>   writes_;
         std::vector<VkCopyDescriptorSet>    copies_;
 
@@ -0,0 +1,259 @@
+/*
+ * VKDynamicRendering.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKDynamicRendering.h"
+#include "VKRenderPass.h"
+#include "VKBarrierAccumulator.h"
+#include "../Ext/VKExtensions.h"
+#include "../../../Core/Assertion.h"
+#include <LLGL/Utils/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+void VKInitRenderingAttachment(
+    VKRenderingAttachment&      outAttachment,
+    VkImage                     image,
+    VkImageView                 imageView,
+    VkImageAspectFlags          aspectMask,
+    VkImageLayout               finalLayout,
+    std::uint32_t               mipLevel,
+    std::uint32_t               arrayLayer,
+    VkResolveModeFlagBitsKHR    resolveMode)
+{
+    outAttachment.image                         = image;
+    outAttachment.imageView                     = imageView;
+    outAttachment.subresource.aspectMask        = aspectMask;
+    outAttachment.subresource.baseMipLevel      = mipLevel;
+    outAttachment.subresource.levelCount        = 1;
+    outAttachment.subresource.baseArrayLayer    = arrayLayer;
+    outAttachment.subresource.layerCount        = 1;
+    outAttachment.finalLayout                   = finalLayout;
+    outAttachment.resolveMode                   = resolveMode;
+}
+
+static bool IsColorAttachment(const VKRenderingAttachment& attachment)
+{
+    return ((attachment.subresource.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) != 0);
+}
+
+static VkImageLayout GetRenderingLayout(const VKRenderingAttachment& attachment)
+{
+    return (IsColorAttachment(attachment) ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+}
+
+static VkAccessFlags GetRenderingAccessFlags(const VKRenderingAttachment& attachment)
+{
+    if (IsColorAttachment(attachment))
+        return (VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    else
+        return (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+}
+
+static constexpr VkPipelineStageFlags g_renderingStageMask =
+(
+    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT   |
+    VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT      |
+    VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
+);
+
+static void InsertImageLayoutBarrier(
+    VKBarrierAccumulator&           barriers,
+    const VKRenderingAttachment&    attachment,
+    VkImageLayout                   oldLayout,
+    VkImageLayout                   newLayout,
+    VkPipelineStageFlags            srcStageMask,
+    VkPipelineStageFlags            dstStageMask,
+    VkAccessFlags                   srcAccessMask,
+    VkAccessFlags                   dstAccessMask)
+{
+    if (attachment.image != VK_NULL_HANDLE)
+        barriers.InsertImageBarrier(attachment.image, attachment.subresource, oldLayout, newLayout, srcStageMask, dstStageMask, srcAccessMask, dstAccessMask);
+}
+
+static const VkClearValue* GetClearValue(const VkClearValue* clearValues, std::uint32_t index)
+{
+    return (clearValues != nullptr ? &clearValues[index] : nullptr);
+}
+
+static void ConvertRenderingAttachmentInfo(
+    VkRenderingAttachmentInfoKHR&   dst,
+    const VKRenderingAttachment&    attachment,
+    const VKRenderingAttachment*    resolveAttachment,
+    VkAttachmentLoadOp              loadOp,
+    VkAttachmentStoreOp             storeOp,
+    const VkClearValue*             clearValue)
+{
+    const bool hasResolve = (resolveAttachment != nullptr && resolveAttachment->image != VK_NULL_HANDLE);
+
+    dst.sType               = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+    dst.pNext               = nullptr;
+    dst.imageView           = attachment.imageView;
+    dst.imageLayout         = GetRenderingLayout(attachment);
+    dst.resolveMode         = (hasResolve ? resolveAttachment->resolveMode : VK_RESOLVE_MODE_NONE_KHR);
+    dst.resolveImageView    = (hasResolve ? resolveAttachment->imageView : VK_NULL_HANDLE);
+    dst.resolveImageLayout  = (hasResolve ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED);
+    dst.loadOp              = loadOp;
+    dst.storeOp             = storeOp;
+
+    if (loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR && clearValue != nullptr)
+        dst.clearValue = *clearValue;
+    else
+        dst.clearValue = {};
+}
+
+void VKCmdBeginRendering(
+    VkCommandBuffer                 commandBuffer,
+    VKBarrierAccumulator&           barriers,
+    const VKRenderingAttachments&   attachments,
+    const VKRenderPass&             renderPass,
+    const VkRect2D&                 renderArea,
+    const VkClearValue*             clearValues,
+    bool                            resume,
+    VkRenderingFlagsKHR             flags)
+{
+    /* Uninitialized stack memory for attachment descriptors */
+    VkRenderingAttachmentInfoKHR    colorAttachmentInfos[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    VkRenderingAttachmentInfoKHR    depthAttachmentInfo;
+    VkRenderingAttachmentInfoKHR    stencilAttachmentInfo;
+
+    /* Render pass must declare all color attachments, since pipelines are created with the same attachment formats */
+    const std::uint32_t numColorAttachments = attachments.numColorAttachments;
+    LLGL_ASSERT(numColorAttachments <= renderPass.GetNumColorAttachments(), "too many color attachments for Vulkan render pass");
+
+    /*
+    Previous contents only need to be preserved for attachments that are loaded; they are stored in their final layout.
+    Resolve attachments are always overwritten entirely at the end of the render pass.
+    */
+    constexpr VkAccessFlags srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+
+    for_range(i, numColorAttachments)
+    {
+        const VkAttachmentDescription&  attachmentDesc      = renderPass.GetAttachmentDesc(i);
+        const VKRenderingAttachment&    colorAttachment     = attachments.colorAttachments[i];
+        const VKRenderingAttachment&    resolveAttachment   = attachments.resolveAttachments[i];
+        const VkAttachmentLoadOp        loadOp              = (resume ? VK_ATTACHMENT_LOAD_OP_LOAD : attachmentDesc.loadOp);
+        const VkImageLayout             oldLayout           = (loadOp == VK_ATTACHMENT_LOAD_OP_LOAD ? colorAttachment.finalLayout : VK_IMAGE_LAYOUT_UNDEFINED);
+
+        InsertImageLayoutBarrier(barriers, colorAttachment, oldLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, g_renderingStageMask, srcAccessMask, GetRenderingAccessFlags(colorAttachment));
+        InsertImageLayoutBarrier(barriers, resolveAttachment, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, g_renderingStageMask, srcAccessMask, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+        ConvertRenderingAttachmentInfo(colorAttachmentInfos[i], colorAttachment, &resolveAttachment, loadOp, attachmentDesc.storeOp, GetClearValue(clearValues, i));
+    }
+
+    /* Depth and stencil aspects refer to the same image view, but have separate load and store operations */
+    const VKRenderingAttachment&    depthStencilAttachment  = attachments.depthStencilAttachment;
+    const std::uint8_t              depthStencilIndex       = renderPass.GetDepthStencilIndex();
+    const bool                      hasDepthStencil         = (depthStencilAttachment.image != VK_NULL_HANDLE && depthStencilIndex != 0xFFu);
+
+    if (hasDepthStencil)
+    {
+        const VkAttachmentDescription&  attachmentDesc  = renderPass.GetAttachmentDesc(depthStencilIndex);
+        const VkAttachmentLoadOp        loadOp          = (resume ? VK_ATTACHMENT_LOAD_OP_LOAD : attachmentDesc.loadOp);
+        const VkAttachmentLoadOp        stencilLoadOp   = (resume ? VK_ATTACHMENT_LOAD_OP_LOAD : attachmentDesc.stencilLoadOp);
+        const bool                      isLoaded        = (loadOp == VK_ATTACHMENT_LOAD_OP_LOAD || stencilLoadOp == VK_ATTACHMENT_LOAD_OP_LOAD);
+        const VkImageLayout             oldLayout       = (isLoaded ? depthStencilAttachment.finalLayout : VK_IMAGE_LAYOUT_UNDEFINED);
+
+        InsertImageLayoutBarrier(barriers, depthStencilAttachment, oldLayout, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, g_renderingStageMask, srcAccessMask, GetRenderingAccessFlags(depthStencilAttachment));
+        ConvertRenderingAttachmentInfo(depthAttachmentInfo, depthStencilAttachment, nullptr, loadOp, attachmentDesc.storeOp, GetClearValue(clearValues, depthStencilIndex));
+        ConvertRenderingAttachmentInfo(stencilAttachmentInfo, depthStencilAttachment, nullptr, stencilLoadOp, attachmentDesc.stencilStoreOp, GetClearValue(clearValues, depthStencilIndex));
+    }
+
+    /* Shading-rate image is only read during rendering, so it is transitioned from its final layout that is kept outside of render passes */
+    const VKRenderingAttachment& shadingRateAttachment = attachments.shadingRateAttachment;
+    const bool hasShadingRateAttachment = (shadingRateAttachment.image != VK_NULL_HANDLE);
+
+    VkRenderingFragmentShadingRateAttachmentInfoKHR shadingRateAttachmentInfo;
+    if (hasShadingRateAttachment)
+    {
+        InsertImageLayoutBarrier(
+            barriers,
+            shadingRateAttachment,
+            shadingRateAttachment.finalLayout,
+            VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR,
+            srcAccessMask,
+            VK_ACCESS_FRAGMENT_SHADING_RATE_ATTACHMENT_READ_BIT_KHR
+        );
+        shadingRateAttachmentInfo.sType                             = VK_STRUCTURE_TYPE_RENDERING_FRAGMENT_SHADING_RATE_ATTACHMENT_INFO_KHR;
+        shadingRateAttachmentInfo.pNext                             = nullptr;
+        shadingRateAttachmentInfo.imageView                         = shadingRateAttachment.imageView;
+        shadingRateAttachmentInfo.imageLayout                       = VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR;
+        shadingRateAttachmentInfo.shadingRateAttachmentTexelSize    = attachments.shadingRateTexelSize;
+    }
+
+    /* Record all layout transitions together with other pending barriers of the command buffer */
+    barriers.Flush(commandBuffer);
+
+    /* Begin rendering into attachments without VkRenderPass and VkFramebuffer objects */
+    const VkImageAspectFlags depthStencilAspect = (hasDepthStencil ? depthStencilAttachment.subresource.aspectMask : 0);
+
+    VkRenderingInfoKHR renderingInfo;
+    {
+        renderingInfo.sType                 = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        renderingInfo.pNext                 = (hasShadingRateAttachment ? &shadingRateAttachmentInfo : nullptr);
+        renderingInfo.flags                 = flags;
+        renderingInfo.renderArea            = renderArea;
+        renderingInfo.layerCount            = 1;
+        renderingInfo.viewMask              = renderPass.GetViewMask();
+        renderingInfo.colorAttachmentCount  = numColorAttachments;
+        renderingInfo.pColorAttachments     = colorAttachmentInfos;
+        renderingInfo.pDepthAttachment      = ((depthStencilAspect & VK_IMAGE_ASPECT_DEPTH_BIT) != 0 ? &depthAttachmentInfo : nullptr);
+        renderingInfo.pStencilAttachment    = ((depthStencilAspect & VK_IMAGE_ASPECT_STENCIL_BIT) != 0 ? &stencilAttachmentInfo : nullptr);
+    }
+    vkCmdBeginRenderingKHR(commandBuffer, &renderingInfo);
+}
+
+void VKCmdEndRendering(
+    VkCommandBuffer                 commandBuffer,
+    VKBarrierAccumulator&           barriers,
+    const VKRenderingAttachments&   attachments)
+{
+    vkCmdEndRenderingKHR(commandBuffer);
+
+    /* Transition all attachments into their final layouts, e.g. to be sampled or presented; these are recorded on the next flush */
+    constexpr VkAccessFlags dstAccessMask = (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+
+    auto InsertFinalLayoutBarrier = [&barriers, dstAccessMask](const VKRenderingAttachment& attachment)
+    {
+        const VkImageLayout renderingLayout = GetRenderingLayout(attachment);
+        if (attachment.finalLayout != renderingLayout)
+        {
+            const VkAccessFlags srcAccessMask = (IsColorAttachment(attachment) ? VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT : VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+            InsertImageLayoutBarrier(barriers, attachment, renderingLayout, attachment.finalLayout, g_renderingStageMask, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, srcAccessMask, dstAccessMask);
+        }
+    };
+
+    for_range(i, attachments.numColorAttachments)
+    {
+        InsertFinalLayoutBarrier(attachments.colorAttachments[i]);
+        InsertFinalLayoutBarrier(attachments.resolveAttachments[i]);
+    }
+    InsertFinalLayoutBarrier(attachments.depthStencilAttachment);
+
+    /* Transition shading-rate image back into its final layout; it has only been read, so there are no writes to make available */
+    const VKRenderingAttachment& shadingRateAttachment = attachments.shadingRateAttachment;
+    InsertImageLayoutBarrier(
+        barriers,
+        shadingRateAttachment,
+        VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR,
+        shadingRateAttachment.finalLayout,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        dstAccessMask
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,92 @@
+/*
+ * VKDynamicRendering.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_DYNAMIC_RENDERING_H
+#define LLGL_VK_DYNAMIC_RENDERING_H
+
+
+#include "../Vulkan.h"
+#include <LLGL/StaticLimits.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class VKRenderPass;
+class VKBarrierAccumulator;
+
+// Image of a single framebuffer attachment that is rendered into with VK_KHR_dynamic_rendering.
+struct VKRenderingAttachment
+{
+    VkImage                     image       = VK_NULL_HANDLE;
+    VkImageView                 imageView   = VK_NULL_HANDLE;
+    VkImageSubresourceRange     subresource = {};
+    VkImageLayout               finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;    // Layout the image is transitioned into at the end of a render pass.
+    VkResolveModeFlagBitsKHR    resolveMode = VK_RESOLVE_MODE_NONE_KHR;     // Resolve mode if this is a resolve attachment.
+};
+
+/*
+Framebuffer attachments that replace a VkFramebuffer object with VK_KHR_dynamic_rendering.
+Image layout transitions that are otherwise performed by the VkRenderPass are recorded explicitly.
+*/
+struct VKRenderingAttachments
+{
+    std::uint32_t           numColorAttachments = 0;
+    VKRenderingAttachment   colorAttachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    VKRenderingAttachment   resolveAttachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS]; // Image is VK_NULL_HANDLE for disabled resolve attachments.
+    VKRenderingAttachment   depthStencilAttachment;                             // Image is VK_NULL_HANDLE if there is no depth-stencil attachment.
+    VKRenderingAttachment   shadingRateAttachment;                              // Image is VK_NULL_HANDLE if there is no shading-rate image.
+    VkExtent2D              shadingRateTexelSize    = { 0, 0 };                 // Size of the pixel area that is covered by each texel of the shading-rate image.
+};
+
+// Initializes the specified rendering attachment for a single MIP-map and array layer of an image.
+void VKInitRenderingAttachment(
+    VKRenderingAttachment&      outAttachment,
+    VkImage                     image,
+    VkImageView                 imageView,
+    VkImageAspectFlags          aspectMask,
+    VkImageLayout               finalLayout,
+    std::uint32_t               mipLevel    = 0,
+    std::uint32_t               arrayLayer  = 0,
+    VkResolveModeFlagBitsKHR    resolveMode = VK_RESOLVE_MODE_NONE_KHR
+);
+
+/*
+Records the image layout transitions into the attachment layouts together with all pending barriers and begins dynamic rendering.
+The load operations are taken from the specified render pass unless 'resume' is true, in which case all attachments are loaded.
+Clear values must be indexed like the attachments of the render pass, i.e. color attachments first followed by the depth-stencil attachment.
+The rendering flags specify VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR if the contents are recorded by secondary command buffers.
+*/
+void VKCmdBeginRendering(
+    VkCommandBuffer                 commandBuffer,
+    VKBarrierAccumulator&           barriers,
+    const VKRenderingAttachments&   attachments,
+    const VKRenderPass&             renderPass,
+    const VkRect2D&                 renderArea,
+    const VkClearValue*             clearValues,
+    bool                            resume,
+    VkRenderingFlagsKHR             flags
+);
+
+// Ends dynamic rendering and inserts the image layout transitions into the final layouts of all attachments into the barrier accumulator.
+void VKCmdEndRendering(
+    VkCommandBuffer                 commandBuffer,
+    VKBarrierAccumulator&           barriers,
+    const VKRenderingAttachments&   attachments
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,32 +7,87 @@
 
 #include "VKFence.h"
 #include "../VKCore.h"
+#include "../Memory/VKExternalHandle.h"
+#include "../Ext/VKExtensions.h"
 
 
 namespace LLGL
 {
 
 
-VKFence::VKFence(VkDevice device) :
-    fence_ { device, vkDestroyFence }
+VKFence::VKFence(VkDevice device, bool timeline, bool exportable) :
+    fence_     { device, vkDestroyFence     },
+    semaphore_ { device, vkDestroySemaphore }
 {
-    VkFenceCreateInfo createInfo;
+    if (timeline)
     {
-        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
+        /* Create timeline semaphore with initial value of zero */
+        VkExportSemaphoreCreateInfoKHR exportInfo;
+        {
+            exportInfo.sType        = VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO_KHR;
+            exportInfo.pNext        = nullptr;
+            exportInfo.handleTypes  = VKGetExternalSemaphoreHandleType();
+        }
+        VkSemaphoreTypeCreateInfoKHR typeInfo;
+        {
+            typeInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+            typeInfo.pNext          = (exportable ? &exportInfo : nullptr);
+            typeInfo.semaphoreType  = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+            typeInfo.initialValue   = 0;
+        }
+        VkSemaphoreCreateInfo createInfo;
+        {
+            createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            createInfo.pNext = &typeInfo;
+            createInfo.flags = 0;
+        }
+        auto result = vkCreateSemaphore(device, &createInfo, nullptr, semaphore_.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan timeline semaphore");
+    }
+    else
+    {
+        VkFenceCreateInfo createInfo;
+        {
+            createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+        }
+        auto result = vkCreateFence(device, &createInfo, nullptr, fence_.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan fence");
     }
-    auto result = vkCreateFence(device, &createInfo, nullptr, fence_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan fence");
 }
 
 void VKFence::Reset(VkDevice device)
 {
-    vkResetFences(device, 1, fence_.GetAddressOf());
+    if (!IsTimeline())
+        vkResetFences(device, 1, fence_.GetAddressOf());
 }
 
 bool VKFence::Wait(VkDevice device, std::uint64_t timeout)
 {
+    return Wait(device, signaledValue_, timeout);
+}
+
+bool VKFence::Wait(VkDevice device, std::uint64_t value, std::uint64_t timeout)
+{
+    if (IsTimeline())
+    {
+        VkSemaphoreWaitInfoKHR waitInfo;
+        {
+            waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+            waitInfo.pNext          = nullptr;
+            waitInfo.flags          = 0;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores    = semaphore_.GetAddressOf();
+            waitInfo.pValues        = &value;
+        }
+        return (vkWaitSemaphoresKHR(device, &waitInfo, timeout) == VK_SUCCESS);
+    }
+
+    /* Binary fences can only represent the last submitted value */
+    if (value > signaledValue_)
+        return false;
+
     return (vkWaitForFences(device, 1, fence_.GetAddressOf(), VK_TRUE, timeout) == VK_SUCCESS);
 }
 
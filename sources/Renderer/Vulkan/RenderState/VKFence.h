@@ -19,25 +19,59 @@ namespace LLGL
 {
 
 
+// Fence that is backed by a timeline semaphore if VK_KHR_timeline_semaphore is supported, or a binary VkFence otherwise.
 class VKFence final : public Fence
 {
 
     public:
 
-        VKFence(VkDevice device);
+        // Creates the fence. Only timeline semaphores can be exportable, i.e. they can be exported via RenderSystem::ExportFenceHandle.
+        VKFence(VkDevice device, bool timeline = false, bool exportable = false);
 
+        // Resets the binary fence. Has no effect for timeline semaphores.
         void Reset(VkDevice device);
+
+        // Waits until the last submitted value has been signaled.
         bool Wait(VkDevice device, std::uint64_t timeout);
 
-        // Returns the native VkFence handle.
+        // Waits until the fence has reached the specified value. Binary fences can only wait for the last submitted value.
+        bool Wait(VkDevice device, std::uint64_t value, std::uint64_t timeout);
+
+        // Stores the value that will be signaled by the last submission of this fence.
+        inline void SetSignaledValue(std::uint64_t value)
+        {
+            signaledValue_ = value;
+        }
+
+        // Returns the value that will be signaled by the last submission of this fence.
+        inline std::uint64_t GetSignaledValue() const
+        {
+            return signaledValue_;
+        }
+
+        // Returns true if this fence is backed by a timeline semaphore.
+        inline bool IsTimeline() const
+        {
+            return (semaphore_.Get() != VK_NULL_HANDLE);
+        }
+
+        // Returns the native VkFence handle. This is null for timeline semaphores.
         inline VkFence GetVkFence() const
         {
             return fence_;
         }
 
+        // Returns the native VkSemaphore handle. This is null for binary fences.
+        inline VkSemaphore GetVkSemaphore() const
+        {
+            return semaphore_;
+        }
+
     private:
 
-        VKPtr<VkFence> fence_;
+        VKPtr<VkFence>      fence_;
+        VKPtr<VkSemaphore>  semaphore_;
+        std::uint64_t       signaledValue_  = 0;
 
 };
 
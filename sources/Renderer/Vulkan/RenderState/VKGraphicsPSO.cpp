@@ -8,6 +8,7 @@
 #include "VKGraphicsPSO.h"
 #include "VKPipelineLayout.h"
 #include "VKRenderPass.h"
+#include "VKPipelinePool.h"
 #include "../Ext/VKExtensionRegistry.h"
 #include "../Shader/VKShader.h"
 #include "../VKTypes.h"
@@ -30,7 +31,10 @@ VKGraphicsPSO::VKGraphicsPSO(
     VkDevice                            device,
     const RenderPass*                   defaultRenderPass,
     const GraphicsPipelineDescriptor&   desc,
-    const VKGraphicsPipelineLimits&     limits)
+    const VKGraphicsPipelineLimits&     limits,
+    VkPipelineCache                     pipelineCache,
+    bool                                isAsync,
+    PipelineState*                      fallbackPipelineState)
 :
     VKPipelineState    { device, VK_PIPELINE_BIND_POINT_GRAPHICS, GetShadersAsArray(desc), desc.pipelineLayout },
     scissorEnabled_    { desc.rasterizer.scissorTestEnabled                                                    },
@@ -40,12 +44,70 @@ VKGraphicsPSO::VKGraphicsPSO(
     {
         /* Create Vulkan graphics pipeline object */
         auto renderPassVK = LLGL_CAST(const VKRenderPass*, renderPass);
-        CreateVkPipeline(device, *renderPassVK, limits, desc);
+        if (isAsync)
+        {
+            /* Compile with a copy of the descriptor in the background; the objects it refers to must outlive the compilation */
+            CreateVkPipelineAsync(
+                [this, device, renderPassVK, limits, desc, pipelineCache]()
+                {
+                    this->CreateVkPipeline(device, *renderPassVK, limits, desc, pipelineCache);
+                },
+                fallbackPipelineState
+            );
+        }
+        else
+            CreateVkPipeline(device, *renderPassVK, limits, desc, pipelineCache);
     }
     else
         throw std::invalid_argument("cannot create Vulkan graphics pipeline without render pass");
 }
 
+void VKGraphicsPSO::BindDynamicState(VkCommandBuffer commandBuffer) const
+{
+    /* Skip PSOs whose creation in the background has failed, since they are not bound either */
+    const VKGraphicsDynamicState& state = dynamicState_;
+    if (!state.enabled || GetVkPipeline() == VK_NULL_HANDLE)
+        return;
+
+    vkCmdSetLineWidth(commandBuffer, state.lineWidth);
+    vkCmdSetDepthBias(commandBuffer, state.depthBiasConstantFactor, state.depthBiasClamp, state.depthBiasSlopeFactor);
+    vkCmdSetStencilCompareMask(commandBuffer, VK_STENCIL_FACE_FRONT_BIT, state.stencilFront.compareMask);
+    vkCmdSetStencilCompareMask(commandBuffer, VK_STENCIL_FACE_BACK_BIT, state.stencilBack.compareMask);
+    vkCmdSetStencilWriteMask(commandBuffer, VK_STENCIL_FACE_FRONT_BIT, state.stencilFront.writeMask);
+    vkCmdSetStencilWriteMask(commandBuffer, VK_STENCIL_FACE_BACK_BIT, state.stencilBack.writeMask);
+
+    if (state.setStencilReference)
+    {
+        vkCmdSetStencilReference(commandBuffer, VK_STENCIL_FACE_FRONT_BIT, state.stencilFront.reference);
+        vkCmdSetStencilReference(commandBuffer, VK_STENCIL_FACE_BACK_BIT, state.stencilBack.reference);
+    }
+
+    if (state.setBlendConstants)
+        vkCmdSetBlendConstants(commandBuffer, state.blendConstants);
+
+    if (state.hasExtendedState)
+    {
+        vkCmdSetCullModeEXT(commandBuffer, state.cullMode);
+        vkCmdSetFrontFaceEXT(commandBuffer, state.frontFace);
+        if (state.hasPrimitiveTopology)
+            vkCmdSetPrimitiveTopologyEXT(commandBuffer, state.primitiveTopology);
+        vkCmdSetDepthTestEnableEXT(commandBuffer, state.depthTestEnable);
+        vkCmdSetDepthWriteEnableEXT(commandBuffer, state.depthWriteEnable);
+        vkCmdSetDepthCompareOpEXT(commandBuffer, state.depthCompareOp);
+        vkCmdSetStencilTestEnableEXT(commandBuffer, state.stencilTestEnable);
+        vkCmdSetStencilOpEXT(commandBuffer, VK_STENCIL_FACE_FRONT_BIT, state.stencilFront.failOp, state.stencilFront.passOp, state.stencilFront.depthFailOp, state.stencilFront.compareOp);
+        vkCmdSetStencilOpEXT(commandBuffer, VK_STENCIL_FACE_BACK_BIT, state.stencilBack.failOp, state.stencilBack.passOp, state.stencilBack.depthFailOp, state.stencilBack.compareOp);
+    }
+
+    if (state.hasExtendedState2)
+    {
+        vkCmdSetDepthBiasEnableEXT(commandBuffer, state.depthBiasEnable);
+        if (state.hasPrimitiveTopology)
+            vkCmdSetPrimitiveRestartEnableEXT(commandBuffer, state.primitiveRestartEnable);
+        vkCmdSetRasterizerDiscardEnableEXT(commandBuffer, state.rasterizerDiscardEnable);
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -267,8 +329,64 @@ static void CreateColorBlendState(
     createInfo.blendConstants[3]    = desc.blendFactor[3];
 }
 
+// Returns the first primitive topology of the same topology class, since a dynamic topology only has to match the class of the pipeline.
+static VkPrimitiveTopology GetPrimitiveTopologyClass(VkPrimitiveTopology topology)
+{
+    switch (topology)
+    {
+        case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+            return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+        case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+            return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+        case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+            return VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+        default:
+            return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    }
+}
+
+static void CreatePooledDynamicState(
+    const GraphicsPipelineDescriptor&               desc,
+    const VKGraphicsPipelineLimits&                 limits,
+    bool                                            isMeshPipeline,
+    const VkPipelineInputAssemblyStateCreateInfo&   inputAssembly,
+    const VkPipelineRasterizationStateCreateInfo&   rasterizerState,
+    const VkPipelineDepthStencilStateCreateInfo&    depthStencilState,
+    const VkPipelineColorBlendStateCreateInfo&      colorBlendState,
+    VKGraphicsDynamicState&                         outState)
+{
+    outState.enabled                    = true;
+    outState.hasExtendedState           = limits.hasExtendedDynamicState;
+    outState.hasExtendedState2          = limits.hasExtendedDynamicState2;
+    outState.hasPrimitiveTopology       = !isMeshPipeline;
+    outState.setBlendConstants          = !desc.blend.blendFactorDynamic;
+    outState.setStencilReference        = !desc.stencil.referenceDynamic;
+    outState.lineWidth                  = rasterizerState.lineWidth;
+    outState.depthBiasConstantFactor    = rasterizerState.depthBiasConstantFactor;
+    outState.depthBiasClamp             = rasterizerState.depthBiasClamp;
+    outState.depthBiasSlopeFactor       = rasterizerState.depthBiasSlopeFactor;
+    for_range(i, 4)
+        outState.blendConstants[i]      = colorBlendState.blendConstants[i];
+    outState.cullMode                   = rasterizerState.cullMode;
+    outState.frontFace                  = rasterizerState.frontFace;
+    outState.primitiveTopology          = inputAssembly.topology;
+    outState.primitiveRestartEnable     = inputAssembly.primitiveRestartEnable;
+    outState.depthTestEnable            = depthStencilState.depthTestEnable;
+    outState.depthWriteEnable           = depthStencilState.depthWriteEnable;
+    outState.depthCompareOp             = depthStencilState.depthCompareOp;
+    outState.depthBiasEnable            = rasterizerState.depthBiasEnable;
+    outState.stencilTestEnable          = depthStencilState.stencilTestEnable;
+    outState.stencilFront               = depthStencilState.front;
+    outState.stencilBack                = depthStencilState.back;
+    outState.rasterizerDiscardEnable    = rasterizerState.rasterizerDiscardEnable;
+}
+
 static void CreateDynamicState(
     const GraphicsPipelineDescriptor&   desc,
+    const VKGraphicsDynamicState&       pooledState,
     VkPipelineDynamicStateCreateInfo&   createInfo,
     std::vector<VkDynamicState>&        dynamicStatesVK)
 {
@@ -276,11 +394,41 @@ static void CreateDynamicState(
         dynamicStatesVK.push_back(VK_DYNAMIC_STATE_VIEWPORT);
     if (desc.scissors.empty())
         dynamicStatesVK.push_back(VK_DYNAMIC_STATE_SCISSOR);
-    if (desc.blend.blendFactorDynamic)
+    if (desc.blend.blendFactorDynamic || pooledState.enabled)
         dynamicStatesVK.push_back(VK_DYNAMIC_STATE_BLEND_CONSTANTS);
-    if (desc.stencil.referenceDynamic)
+    if (desc.stencil.referenceDynamic || pooledState.enabled)
         dynamicStatesVK.push_back(VK_DYNAMIC_STATE_STENCIL_REFERENCE);
 
+    /* Pooled pipelines leave all supported states dynamic, so they can be shared by as many PSOs as possible */
+    if (pooledState.enabled)
+    {
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_LINE_WIDTH);
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_DEPTH_BIAS);
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK);
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_STENCIL_WRITE_MASK);
+
+        if (pooledState.hasExtendedState)
+        {
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_CULL_MODE_EXT);
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_FRONT_FACE_EXT);
+            if (pooledState.hasPrimitiveTopology)
+                dynamicStatesVK.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT);
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT);
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT);
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT);
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_STENCIL_OP_EXT);
+        }
+
+        if (pooledState.hasExtendedState2)
+        {
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT);
+            if (pooledState.hasPrimitiveTopology)
+                dynamicStatesVK.push_back(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE_EXT);
+            dynamicStatesVK.push_back(VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE_EXT);
+        }
+    }
+
     createInfo.sType                = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
     createInfo.pNext                = nullptr;
     createInfo.flags                = 0;
@@ -288,16 +436,414 @@ static void CreateDynamicState(
     createInfo.pDynamicStates       = (dynamicStatesVK.empty() ? nullptr : dynamicStatesVK.data());
 }
 
+static void CreateRenderingInfo(
+    const VKRenderPass&                 renderPass,
+    VkPipelineRenderingCreateInfoKHR&   createInfo,
+    VkFormat*                           colorAttachmentFormats)
+{
+    const std::uint32_t numColorAttachments = renderPass.GetNumColorAttachments();
+    for_range(i, numColorAttachments)
+        colorAttachmentFormats[i] = renderPass.GetAttachmentDesc(i).format;
+
+    /* Depth and stencil formats are the same, since both aspects share a single attachment */
+    VkFormat depthStencilFormat = VK_FORMAT_UNDEFINED;
+    if (renderPass.GetDepthStencilIndex() != 0xFFu)
+        depthStencilFormat = renderPass.GetAttachmentDesc(renderPass.GetDepthStencilIndex()).format;
+
+    createInfo.sType                    = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+    createInfo.pNext                    = nullptr;
+    createInfo.viewMask                 = renderPass.GetViewMask();
+    createInfo.colorAttachmentCount     = numColorAttachments;
+    createInfo.pColorAttachmentFormats  = colorAttachmentFormats;
+    createInfo.depthAttachmentFormat    = (VKTypes::IsVkFormatDepthStencil(depthStencilFormat) && depthStencilFormat != VK_FORMAT_S8_UINT ? depthStencilFormat : VK_FORMAT_UNDEFINED);
+    createInfo.stencilAttachmentFormat  = (VKTypes::IsVkFormatStencil(depthStencilFormat) ? depthStencilFormat : VK_FORMAT_UNDEFINED);
+}
+
+static VkExtent2D ToVkFragmentSize(const ShadingRate rate)
+{
+    switch (rate)
+    {
+        case ShadingRate::Rate1x1:  return VkExtent2D{ 1, 1 };
+        case ShadingRate::Rate1x2:  return VkExtent2D{ 1, 2 };
+        case ShadingRate::Rate2x1:  return VkExtent2D{ 2, 1 };
+        case ShadingRate::Rate2x2:  return VkExtent2D{ 2, 2 };
+        case ShadingRate::Rate2x4:  return VkExtent2D{ 2, 4 };
+        case ShadingRate::Rate4x2:  return VkExtent2D{ 4, 2 };
+        case ShadingRate::Rate4x4:  return VkExtent2D{ 4, 4 };
+    }
+    return VkExtent2D{ 1, 1 };
+}
+
+static VkFragmentShadingRateCombinerOpKHR ToVkShadingRateCombinerOp(const ShadingRateCombiner combiner, bool hasCombinerMinMax)
+{
+    switch (combiner)
+    {
+        case ShadingRateCombiner::Keep:     return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR;
+        case ShadingRateCombiner::Replace:  return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_REPLACE_KHR;
+        case ShadingRateCombiner::Min:      return (hasCombinerMinMax ? VK_FRAGMENT_SHADING_RATE_COMBINER_OP_MIN_KHR : VK_FRAGMENT_SHADING_RATE_COMBINER_OP_REPLACE_KHR);
+        case ShadingRateCombiner::Max:      return (hasCombinerMinMax ? VK_FRAGMENT_SHADING_RATE_COMBINER_OP_MAX_KHR : VK_FRAGMENT_SHADING_RATE_COMBINER_OP_REPLACE_KHR);
+    }
+    return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR;
+}
+
+static void CreateShadingRateState(
+    const ShadingRateDescriptor&                        desc,
+    const VKGraphicsPipelineLimits&                     limits,
+    VkPipelineFragmentShadingRateStateCreateInfoKHR&    createInfo)
+{
+    /* The first combiner applies to the per-primitive rate, which is not exposed, so it always keeps the pipeline rate */
+    createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_FRAGMENT_SHADING_RATE_STATE_CREATE_INFO_KHR;
+    createInfo.pNext            = nullptr;
+    createInfo.fragmentSize     = ToVkFragmentSize(desc.rate);
+    createInfo.combinerOps[0]   = VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR;
+    createInfo.combinerOps[1]   = (limits.hasShadingRateImage ? ToVkShadingRateCombinerOp(desc.imageCombiner, limits.hasShadingRateCombinerMinMax) : VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR);
+}
+
+static void AppendRenderingInfoKey(VKPipelineKey& key, const VkPipelineRenderingCreateInfoKHR& createInfo)
+{
+    key.Append(createInfo.viewMask);
+    key.Append(createInfo.colorAttachmentCount);
+    for_range(i, createInfo.colorAttachmentCount)
+        key.Append(createInfo.pColorAttachmentFormats[i]);
+    key.Append(createInfo.depthAttachmentFormat);
+    key.Append(createInfo.stencilAttachmentFormat);
+}
+
+static void AppendShadingRateKey(VKPipelineKey& key, const VkPipelineFragmentShadingRateStateCreateInfoKHR* createInfo)
+{
+    if (createInfo != nullptr)
+    {
+        key.Append(createInfo->fragmentSize.width);
+        key.Append(createInfo->fragmentSize.height);
+        key.Append(createInfo->combinerOps[0]);
+        key.Append(createInfo->combinerOps[1]);
+    }
+}
+
+static void AppendMultisampleKey(VKPipelineKey& key, const VkPipelineMultisampleStateCreateInfo& createInfo)
+{
+    key.Append(createInfo.rasterizationSamples);
+    key.Append(createInfo.sampleShadingEnable);
+    key.Append(createInfo.minSampleShading);
+    key.Append(createInfo.pSampleMask != nullptr ? createInfo.pSampleMask[0] : ~0u);
+    key.Append(createInfo.alphaToCoverageEnable);
+    key.Append(createInfo.alphaToOneEnable);
+}
+
+// Appends the vertex input interface state; vertex attributes are derived from the vertex shader.
+static void AppendVertexInputKey(
+    VKPipelineKey&                      key,
+    const GraphicsPipelineDescriptor&   desc,
+    const VkGraphicsPipelineCreateInfo& createInfo,
+    const VKGraphicsDynamicState&       dynamicState)
+{
+    key.AppendDependency(desc.vertexShader);
+
+    const VkPipelineInputAssemblyStateCreateInfo& inputAssembly = *createInfo.pInputAssemblyState;
+    key.Append(dynamicState.hasExtendedState ? GetPrimitiveTopologyClass(inputAssembly.topology) : inputAssembly.topology);
+    if (!dynamicState.hasExtendedState2)
+        key.Append(inputAssembly.primitiveRestartEnable);
+}
+
+// Appends the pre-rasterization shaders and their fixed-function state.
+static void AppendPreRasterizationKey(
+    VKPipelineKey&                                          key,
+    const GraphicsPipelineDescriptor&                       desc,
+    const VkGraphicsPipelineCreateInfo&                     createInfo,
+    const VKGraphicsDynamicState&                           dynamicState,
+    const VkPipelineRenderingCreateInfoKHR&                 renderingInfo,
+    const VkPipelineFragmentShadingRateStateCreateInfoKHR*  shadingRateState)
+{
+    key.AppendDependency(desc.pipelineLayout);
+    key.AppendDependency(desc.vertexShader);
+    key.AppendDependency(desc.tessControlShader);
+    key.AppendDependency(desc.tessEvaluationShader);
+    key.AppendDependency(desc.geometryShader);
+    key.AppendDependency(desc.taskShader);
+    key.AppendDependency(desc.meshShader);
+
+    const VkPipelineViewportStateCreateInfo& viewportState = *createInfo.pViewportState;
+    key.Append(viewportState.viewportCount);
+    key.Append(viewportState.scissorCount);
+    if (viewportState.pViewports != nullptr)
+    {
+        for_range(i, viewportState.viewportCount)
+        {
+            const VkViewport& viewport = viewportState.pViewports[i];
+            key.Append(viewport.x);
+            key.Append(viewport.y);
+            key.Append(viewport.width);
+            key.Append(viewport.height);
+            key.Append(viewport.minDepth);
+            key.Append(viewport.maxDepth);
+        }
+    }
+    if (viewportState.pScissors != nullptr)
+    {
+        for_range(i, viewportState.scissorCount)
+        {
+            const VkRect2D& scissor = viewportState.pScissors[i];
+            key.Append(scissor.offset.x);
+            key.Append(scissor.offset.y);
+            key.Append(scissor.extent.width);
+            key.Append(scissor.extent.height);
+        }
+    }
+
+    const VkPipelineRasterizationStateCreateInfo& rasterizerState = *createInfo.pRasterizationState;
+    key.Append(rasterizerState.depthClampEnable);
+    key.Append(rasterizerState.polygonMode);
+    key.Append(rasterizerState.pNext != nullptr); // Conservative rasterization
+    if (!dynamicState.hasExtendedState)
+    {
+        key.Append(rasterizerState.cullMode);
+        key.Append(rasterizerState.frontFace);
+    }
+    if (!dynamicState.hasExtendedState2)
+    {
+        key.Append(rasterizerState.rasterizerDiscardEnable);
+        key.Append(rasterizerState.depthBiasEnable);
+    }
+
+    if (createInfo.pTessellationState != nullptr)
+        key.Append(createInfo.pTessellationState->patchControlPoints);
+
+    AppendRenderingInfoKey(key, renderingInfo);
+    AppendShadingRateKey(key, shadingRateState);
+}
+
+// Appends the fragment shader and the depth-stencil and multi-sample states.
+static void AppendFragmentShaderKey(
+    VKPipelineKey&                                          key,
+    const GraphicsPipelineDescriptor&                       desc,
+    const VkGraphicsPipelineCreateInfo&                     createInfo,
+    const VKGraphicsDynamicState&                           dynamicState,
+    const VkPipelineRenderingCreateInfoKHR&                 renderingInfo,
+    const VkPipelineFragmentShadingRateStateCreateInfoKHR*  shadingRateState)
+{
+    key.AppendDependency(desc.pipelineLayout);
+    key.AppendDependency(desc.fragmentShader);
+
+    const VkPipelineDepthStencilStateCreateInfo& depthStencilState = *createInfo.pDepthStencilState;
+    key.Append(depthStencilState.depthBoundsTestEnable);
+    if (!dynamicState.hasExtendedState)
+    {
+        key.Append(depthStencilState.depthTestEnable);
+        key.Append(depthStencilState.depthWriteEnable);
+        key.Append(depthStencilState.depthCompareOp);
+        key.Append(depthStencilState.stencilTestEnable);
+        for (const VkStencilOpState* stencilOp : { &depthStencilState.front, &depthStencilState.back })
+        {
+            key.Append(stencilOp->failOp);
+            key.Append(stencilOp->passOp);
+            key.Append(stencilOp->depthFailOp);
+            key.Append(stencilOp->compareOp);
+        }
+    }
+
+    AppendMultisampleKey(key, *createInfo.pMultisampleState);
+    AppendRenderingInfoKey(key, renderingInfo);
+    AppendShadingRateKey(key, shadingRateState);
+}
+
+// Appends the color-blend state and the attachment formats.
+static void AppendFragmentOutputKey(
+    VKPipelineKey&                              key,
+    const VkGraphicsPipelineCreateInfo&         createInfo,
+    const VkPipelineRenderingCreateInfoKHR&     renderingInfo)
+{
+    const VkPipelineColorBlendStateCreateInfo& colorBlendState = *createInfo.pColorBlendState;
+    key.Append(colorBlendState.logicOpEnable);
+    key.Append(colorBlendState.logicOp);
+    key.Append(colorBlendState.attachmentCount);
+    for_range(i, colorBlendState.attachmentCount)
+    {
+        const VkPipelineColorBlendAttachmentState& attachmentState = colorBlendState.pAttachments[i];
+        key.Append(attachmentState.blendEnable);
+        key.Append(attachmentState.srcColorBlendFactor);
+        key.Append(attachmentState.dstColorBlendFactor);
+        key.Append(attachmentState.colorBlendOp);
+        key.Append(attachmentState.srcAlphaBlendFactor);
+        key.Append(attachmentState.dstAlphaBlendFactor);
+        key.Append(attachmentState.alphaBlendOp);
+        key.Append(attachmentState.colorWriteMask);
+    }
+
+    AppendMultisampleKey(key, *createInfo.pMultisampleState);
+    AppendRenderingInfoKey(key, renderingInfo);
+}
+
+static void CreateGraphicsPipeline(
+    VkDevice                            device,
+    VkPipelineCache                     pipelineCache,
+    const VkGraphicsPipelineCreateInfo& createInfo,
+    VKPtr<VkPipeline>&                  outPipeline,
+    const char*                         errorInfo)
+{
+    outPipeline = VKPtr<VkPipeline>{ device, vkDestroyPipeline };
+    auto result = vkCreateGraphicsPipelines(device, pipelineCache, 1, &createInfo, nullptr, outPipeline.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, errorInfo);
+}
+
+// Returns a create info with only the members that are shared by all graphics pipeline library subsets.
+static VkGraphicsPipelineCreateInfo GetPipelineLibraryBaseCreateInfo(const VkGraphicsPipelineCreateInfo& createInfo)
+{
+    VkGraphicsPipelineCreateInfo baseCreateInfo = {};
+    {
+        baseCreateInfo.sType            = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        baseCreateInfo.flags            = createInfo.flags;
+        baseCreateInfo.pDynamicState    = createInfo.pDynamicState;
+        baseCreateInfo.layout           = createInfo.layout;
+        baseCreateInfo.renderPass       = VK_NULL_HANDLE;
+        baseCreateInfo.subpass          = 0;
+    }
+    return baseCreateInfo;
+}
+
+// Returns the graphics pipeline library for the specified subset of the pipeline state from the pool or creates a new one.
+static VKPooledPipeline* GetOrCreatePipelineLibrary(
+    VkDevice                            device,
+    VkPipelineCache                     pipelineCache,
+    const VKPipelineKey&                key,
+    VkGraphicsPipelineLibraryFlagsEXT   libraryFlags,
+    VkGraphicsPipelineCreateInfo        createInfo)
+{
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryCreateInfo;
+    {
+        libraryCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+        libraryCreateInfo.pNext = const_cast<void*>(createInfo.pNext);
+        libraryCreateInfo.flags = libraryFlags;
+    }
+    createInfo.pNext = &libraryCreateInfo;
+    createInfo.flags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+
+    return VKPipelinePool::Get().GetOrCreatePipeline(
+        key,
+        [device, pipelineCache, &createInfo](VKPtr<VkPipeline>& outPipeline, std::vector<VKPooledPipeline*>& /*outLibraries*/)
+        {
+            CreateGraphicsPipeline(device, pipelineCache, createInfo, outPipeline, "failed to create Vulkan graphics pipeline library");
+        }
+    );
+}
+
+/*
+Creates the pipeline from libraries for the vertex input interface, the pre-rasterization shaders, the fragment shader, and the fragment output interface.
+Each library is shared by all pipelines with the same state for its subset, so new combinations only need to be linked.
+*/
+static void LinkGraphicsPipelineLibraries(
+    VkDevice                                                device,
+    VkPipelineCache                                         pipelineCache,
+    const GraphicsPipelineDescriptor&                       desc,
+    const VkGraphicsPipelineCreateInfo&                     createInfo,
+    const VKGraphicsDynamicState&                           dynamicState,
+    const VkPipelineRenderingCreateInfoKHR&                 renderingInfo,
+    const VkPipelineFragmentShadingRateStateCreateInfoKHR*  shadingRateState,
+    VKPtr<VkPipeline>&                                      outPipeline,
+    std::vector<VKPooledPipeline*>&                         outLibraries)
+{
+    /* Split shader stages into pre-rasterization and fragment shader stages */
+    SmallVector<VkPipelineShaderStageCreateInfo, 5> preRasterStages;
+    SmallVector<VkPipelineShaderStageCreateInfo, 1> fragmentStages;
+    for_range(i, createInfo.stageCount)
+    {
+        if (createInfo.pStages[i].stage == VK_SHADER_STAGE_FRAGMENT_BIT)
+            fragmentStages.push_back(createInfo.pStages[i]);
+        else
+            preRasterStages.push_back(createInfo.pStages[i]);
+    }
+
+    /* Get or create vertex input interface library */
+    {
+        VKPipelineKey key;
+        key.Append(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT);
+        key.Append(createInfo.flags);
+        AppendVertexInputKey(key, desc, createInfo, dynamicState);
+
+        VkGraphicsPipelineCreateInfo libraryCreateInfo = GetPipelineLibraryBaseCreateInfo(createInfo);
+        libraryCreateInfo.pVertexInputState     = createInfo.pVertexInputState;
+        libraryCreateInfo.pInputAssemblyState   = createInfo.pInputAssemblyState;
+        outLibraries.push_back(GetOrCreatePipelineLibrary(device, pipelineCache, key, VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, libraryCreateInfo));
+    }
+
+    /* Get or create pre-rasterization shaders library */
+    {
+        VKPipelineKey key;
+        key.Append(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT);
+        key.Append(createInfo.flags);
+        AppendPreRasterizationKey(key, desc, createInfo, dynamicState, renderingInfo, shadingRateState);
+
+        VkGraphicsPipelineCreateInfo libraryCreateInfo = GetPipelineLibraryBaseCreateInfo(createInfo);
+        libraryCreateInfo.pNext                 = createInfo.pNext;
+        libraryCreateInfo.stageCount            = static_cast<std::uint32_t>(preRasterStages.size());
+        libraryCreateInfo.pStages               = preRasterStages.data();
+        libraryCreateInfo.pTessellationState    = createInfo.pTessellationState;
+        libraryCreateInfo.pViewportState        = createInfo.pViewportState;
+        libraryCreateInfo.pRasterizationState   = createInfo.pRasterizationState;
+        outLibraries.push_back(GetOrCreatePipelineLibrary(device, pipelineCache, key, VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT, libraryCreateInfo));
+    }
+
+    /* Get or create fragment shader library; this library is also required without fragment shader for the depth-stencil state */
+    {
+        VKPipelineKey key;
+        key.Append(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT);
+        key.Append(createInfo.flags);
+        AppendFragmentShaderKey(key, desc, createInfo, dynamicState, renderingInfo, shadingRateState);
+
+        VkGraphicsPipelineCreateInfo libraryCreateInfo = GetPipelineLibraryBaseCreateInfo(createInfo);
+        libraryCreateInfo.pNext                 = createInfo.pNext;
+        libraryCreateInfo.stageCount            = static_cast<std::uint32_t>(fragmentStages.size());
+        libraryCreateInfo.pStages               = (fragmentStages.empty() ? nullptr : fragmentStages.data());
+        libraryCreateInfo.pMultisampleState     = createInfo.pMultisampleState;
+        libraryCreateInfo.pDepthStencilState    = createInfo.pDepthStencilState;
+        outLibraries.push_back(GetOrCreatePipelineLibrary(device, pipelineCache, key, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, libraryCreateInfo));
+    }
+
+    /* Get or create fragment output interface library */
+    {
+        VKPipelineKey key;
+        key.Append(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT);
+        key.Append(createInfo.flags);
+        AppendFragmentOutputKey(key, createInfo, renderingInfo);
+
+        VkGraphicsPipelineCreateInfo libraryCreateInfo = GetPipelineLibraryBaseCreateInfo(createInfo);
+        libraryCreateInfo.pNext                 = &renderingInfo;
+        libraryCreateInfo.pMultisampleState     = createInfo.pMultisampleState;
+        libraryCreateInfo.pColorBlendState      = createInfo.pColorBlendState;
+        outLibraries.push_back(GetOrCreatePipelineLibrary(device, pipelineCache, key, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT, libraryCreateInfo));
+    }
+
+    /* Link libraries without link-time optimization, so new combinations are ready to be used almost immediately */
+    VkPipeline libraries[4];
+    for_range(i, 4)
+        libraries[i] = outLibraries[i]->pipeline.Get();
+
+    VkPipelineLibraryCreateInfoKHR libraryInfo;
+    {
+        libraryInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+        libraryInfo.pNext           = nullptr;
+        libraryInfo.libraryCount    = 4;
+        libraryInfo.pLibraries      = libraries;
+    }
+    VkGraphicsPipelineCreateInfo linkCreateInfo = GetPipelineLibraryBaseCreateInfo(createInfo);
+    {
+        linkCreateInfo.pNext            = &libraryInfo;
+        linkCreateInfo.pDynamicState    = nullptr;
+    }
+    CreateGraphicsPipeline(device, pipelineCache, linkCreateInfo, outPipeline, "failed to link Vulkan graphics pipeline libraries");
+}
+
 void VKGraphicsPSO::CreateVkPipeline(
     VkDevice                            device,
     const VKRenderPass&                 renderPass,
     const VKGraphicsPipelineLimits&     limits,
-    const GraphicsPipelineDescriptor&   desc)
+    const GraphicsPipelineDescriptor&   desc,
+    VkPipelineCache                     pipelineCache)
 {
-    /* Get shader program object */
+    /* Get shader program object; mesh pipelines have neither vertex input nor input assembly state */
     auto vertexShaderVK = LLGL_CAST(const VKShader*, desc.vertexShader);
-    if (!vertexShaderVK)
-        throw std::invalid_argument("cannot create Vulkan graphics pipeline without vertex shader");
+    const bool isMeshPipeline = (desc.meshShader != nullptr);
+    if (!vertexShaderVK && !isMeshPipeline)
+        throw std::invalid_argument("cannot create Vulkan graphics pipeline without vertex or mesh shader");
 
     auto FillAndAppendShaderStageCreateInfo = [this](
         Shader*                                             shader,
@@ -318,11 +864,14 @@ void VKGraphicsPSO::CreateVkPipeline(
     FillAndAppendShaderStageCreateInfo(desc.tessControlShader,      shaderStageCreateInfos);
     FillAndAppendShaderStageCreateInfo(desc.tessEvaluationShader,   shaderStageCreateInfos);
     FillAndAppendShaderStageCreateInfo(desc.geometryShader,         shaderStageCreateInfos);
+    FillAndAppendShaderStageCreateInfo(desc.taskShader,             shaderStageCreateInfos);
+    FillAndAppendShaderStageCreateInfo(desc.meshShader,             shaderStageCreateInfos);
     FillAndAppendShaderStageCreateInfo(desc.fragmentShader,         shaderStageCreateInfos);
 
     /* Initialize vertex input descriptor */
-    VkPipelineVertexInputStateCreateInfo vertexInputCreateInfo;
-    vertexShaderVK->FillVertexInputStateCreateInfo(vertexInputCreateInfo);
+    VkPipelineVertexInputStateCreateInfo vertexInputCreateInfo = {};
+    if (vertexShaderVK != nullptr)
+        vertexShaderVK->FillVertexInputStateCreateInfo(vertexInputCreateInfo);
 
     /* Initialize input assembly state */
     VkPipelineInputAssemblyStateCreateInfo inputAssembly;
@@ -357,22 +906,51 @@ void VKGraphicsPSO::CreateVkPipeline(
     VkPipelineColorBlendStateCreateInfo colorBlendState;
     CreateColorBlendState(desc.blend, colorBlendState, attachmentStatesVK, renderPass.GetNumColorAttachments());
 
+    /*
+    Pipelines without render pass object are shared via VKPipelinePool, in which case all supported states are dynamic.
+    Otherwise, the render pass handle would be part of the identity of each pipeline.
+    */
+    const bool hasDynamicRendering = HasExtension(VKExt::KHR_dynamic_rendering);
+    if (hasDynamicRendering)
+        CreatePooledDynamicState(desc, limits, isMeshPipeline, inputAssembly, rasterizerState, depthStencilState, colorBlendState, dynamicState_);
+
     /* Initialize dynamic state */
     std::vector<VkDynamicState> dynamicStatesVK;
     VkPipelineDynamicStateCreateInfo dynamicState;
-    CreateDynamicState(desc, dynamicState, dynamicStatesVK);
+    CreateDynamicState(desc, dynamicState_, dynamicState, dynamicStatesVK);
+
+    /* Initialize attachment formats for pipelines without render pass object */
+    VkFormat colorAttachmentFormats[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    VkPipelineRenderingCreateInfoKHR renderingCreateInfo;
+    if (hasDynamicRendering)
+        CreateRenderingInfo(renderPass, renderingCreateInfo, colorAttachmentFormats);
+
+    /* Initialize variable rate shading state; this is chained in front of the rendering info */
+    VkPipelineFragmentShadingRateStateCreateInfoKHR shadingRateState;
+    const void* next = (hasDynamicRendering ? &renderingCreateInfo : nullptr);
+    if (limits.hasShadingRate)
+    {
+        CreateShadingRateState(desc.shadingRate, limits, shadingRateState);
+        shadingRateState.pNext = next;
+        next = &shadingRateState;
+    }
+
+    /* Pipelines must declare that they can be used with a shading-rate attachment, since any render target might provide one */
+    VkPipelineCreateFlags createFlags = 0;
+    if (limits.hasShadingRateImage)
+        createFlags |= VK_PIPELINE_CREATE_RENDERING_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
 
     /* Create graphics pipeline state object */
     VkGraphicsPipelineCreateInfo createInfo;
     {
         createInfo.sType                        = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        createInfo.pNext                        = nullptr;
-        createInfo.flags                        = 0;
+        createInfo.pNext                        = next;
+        createInfo.flags                        = createFlags;
         createInfo.stageCount                   = static_cast<std::uint32_t>(shaderStageCreateInfos.size());
         createInfo.pStages                      = shaderStageCreateInfos.data();
-        createInfo.pVertexInputState            = (&vertexInputCreateInfo);
-        createInfo.pInputAssemblyState          = (&inputAssembly);
-        createInfo.pTessellationState           = (inputAssembly.topology == VK_PRIMITIVE_TOPOLOGY_PATCH_LIST ? &tessellationState : nullptr);
+        createInfo.pVertexInputState            = (isMeshPipeline ? nullptr : &vertexInputCreateInfo);
+        createInfo.pInputAssemblyState          = (isMeshPipeline ? nullptr : &inputAssembly);
+        createInfo.pTessellationState           = (!isMeshPipeline && inputAssembly.topology == VK_PRIMITIVE_TOPOLOGY_PATCH_LIST ? &tessellationState : nullptr);
         createInfo.pViewportState               = (&viewportState);
         createInfo.pRasterizationState          = (&rasterizerState);
         createInfo.pMultisampleState            = (&multisampleState);
@@ -385,8 +963,41 @@ void VKGraphicsPSO::CreateVkPipeline(
         createInfo.basePipelineHandle           = VK_NULL_HANDLE;
         createInfo.basePipelineIndex            = 0;
     }
-    auto result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, ReleaseAndGetAddressOfVkPipeline());
-    VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
+
+    if (!dynamicState_.enabled)
+    {
+        auto result = vkCreateGraphicsPipelines(device, pipelineCache, 1, &createInfo, nullptr, ReleaseAndGetAddressOfVkPipeline());
+        VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
+        return;
+    }
+
+    /* Share native pipeline with all PSOs whose remaining static state is identical */
+    const VkPipelineFragmentShadingRateStateCreateInfoKHR* shadingRateStatePtr = (limits.hasShadingRate ? &shadingRateState : nullptr);
+
+    VKPipelineKey pipelineKey;
+    pipelineKey.Append(createInfo.flags);
+    pipelineKey.Append(isMeshPipeline);
+    if (!isMeshPipeline)
+        AppendVertexInputKey(pipelineKey, desc, createInfo, dynamicState_);
+    AppendPreRasterizationKey(pipelineKey, desc, createInfo, dynamicState_, renderingCreateInfo, shadingRateStatePtr);
+    AppendFragmentShaderKey(pipelineKey, desc, createInfo, dynamicState_, renderingCreateInfo, shadingRateStatePtr);
+    AppendFragmentOutputKey(pipelineKey, createInfo, renderingCreateInfo);
+
+    /* Mesh pipelines have no vertex input interface, so they are always created as a whole */
+    const bool useLibraries = (limits.hasGraphicsPipelineLibrary && !isMeshPipeline);
+
+    SetPooledPipeline(
+        VKPipelinePool::Get().GetOrCreatePipeline(
+            pipelineKey,
+            [&](VKPtr<VkPipeline>& outPipeline, std::vector<VKPooledPipeline*>& outLibraries)
+            {
+                if (useLibraries)
+                    LinkGraphicsPipelineLibraries(device, pipelineCache, desc, createInfo, dynamicState_, renderingCreateInfo, shadingRateStatePtr, outPipeline, outLibraries);
+                else
+                    CreateGraphicsPipeline(device, pipelineCache, createInfo, outPipeline, "failed to create Vulkan graphics pipeline");
+            }
+        )
+    );
 }
 
 
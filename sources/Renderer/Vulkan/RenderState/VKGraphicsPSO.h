@@ -22,6 +22,40 @@ struct VKGraphicsPipelineLimits
 {
     float lineWidthRange[2];
     float lineWidthGranularity;
+    bool  hasShadingRate;                   // VK_KHR_fragment_shading_rate with pipelineFragmentShadingRate
+    bool  hasShadingRateImage;              // VK_KHR_fragment_shading_rate with attachmentFragmentShadingRate and VK_KHR_dynamic_rendering
+    bool  hasShadingRateCombinerMinMax;     // fragmentShadingRateNonTrivialCombinerOps
+    bool  hasExtendedDynamicState;          // VK_EXT_extended_dynamic_state
+    bool  hasExtendedDynamicState2;         // VK_EXT_extended_dynamic_state2
+    bool  hasGraphicsPipelineLibrary;       // VK_EXT_graphics_pipeline_library and VK_KHR_pipeline_library
+};
+
+// States of a graphics PSO that are set dynamically when its native pipeline is shared via VKPipelinePool.
+struct VKGraphicsDynamicState
+{
+    bool                enabled                 = false;
+    bool                hasExtendedState        = false;    // VK_EXT_extended_dynamic_state
+    bool                hasExtendedState2       = false;    // VK_EXT_extended_dynamic_state2
+    bool                hasPrimitiveTopology    = false;    // Primitive topology and restart are not dynamic for mesh pipelines
+    bool                setBlendConstants       = false;    // Blend constants unless they are dynamic for the client
+    bool                setStencilReference     = false;    // Stencil reference unless it is dynamic for the client
+    float               lineWidth               = 1.0f;
+    float               depthBiasConstantFactor = 0.0f;
+    float               depthBiasClamp          = 0.0f;
+    float               depthBiasSlopeFactor    = 0.0f;
+    float               blendConstants[4]       = {};
+    VkCullModeFlags     cullMode                = VK_CULL_MODE_NONE;
+    VkFrontFace         frontFace               = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    VkPrimitiveTopology primitiveTopology       = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    VkBool32            primitiveRestartEnable  = VK_FALSE;
+    VkBool32            depthTestEnable         = VK_FALSE;
+    VkBool32            depthWriteEnable        = VK_FALSE;
+    VkCompareOp         depthCompareOp          = VK_COMPARE_OP_LESS;
+    VkBool32            depthBiasEnable         = VK_FALSE;
+    VkBool32            stencilTestEnable       = VK_FALSE;
+    VkStencilOpState    stencilFront            = {};
+    VkStencilOpState    stencilBack             = {};
+    VkBool32            rasterizerDiscardEnable = VK_FALSE;
 };
 
 struct GraphicsPipelineDescriptor;
@@ -37,7 +71,10 @@ class VKGraphicsPSO final : public VKPipelineState
             VkDevice                            device,
             const RenderPass*                   defaultRenderPass,
             const GraphicsPipelineDescriptor&   desc,
-            const VKGraphicsPipelineLimits&     limits
+            const VKGraphicsPipelineLimits&     limits,
+            VkPipelineCache                     pipelineCache           = VK_NULL_HANDLE,
+            bool                                isAsync                 = false,
+            PipelineState*                      fallbackPipelineState   = nullptr
         );
 
         // Returns true if scissors are enabled.
@@ -52,19 +89,24 @@ class VKGraphicsPSO final : public VKPipelineState
             return hasDynamicScissor_;
         }
 
+        // Sets the states of this PSO that are dynamic in its shared native pipeline. This must be called after the PSO has been bound.
+        void BindDynamicState(VkCommandBuffer commandBuffer) const;
+
     private:
 
         void CreateVkPipeline(
             VkDevice                            device,
             const VKRenderPass&                 renderPass,
             const VKGraphicsPipelineLimits&     limits,
-            const GraphicsPipelineDescriptor&   desc
+            const GraphicsPipelineDescriptor&   desc,
+            VkPipelineCache                     pipelineCache
         );
 
     private:
 
-        bool scissorEnabled_    = false;
-        bool hasDynamicScissor_ = false;
+        bool                    scissorEnabled_     = false;
+        bool                    hasDynamicScissor_  = false;
+        VKGraphicsDynamicState  dynamicState_;
 
 };
 
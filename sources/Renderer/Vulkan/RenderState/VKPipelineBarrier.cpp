@@ -6,6 +6,7 @@
  */
 
 #include "VKPipelineBarrier.h"
+#include "VKBarrierAccumulator.h"
 #include "../Buffer/VKBuffer.h"
 //#include "../Texture/VKTexture.h"
 #include "../../CheckedCast.h"
@@ -38,6 +39,14 @@ void VKPipelineBarrier::Submit(VkCommandBuffer commandBuffer)
     );
 }
 
+void VKPipelineBarrier::InsertInto(VKBarrierAccumulator& barriers) const
+{
+    for (const VkMemoryBarrier& barrier : memoryBarrier_)
+        barriers.InsertMemoryBarrier(srcStageMask_, dstStageMask_, barrier.srcAccessMask, barrier.dstAccessMask);
+    for (const VkBufferMemoryBarrier& barrier : bufferBarriers_)
+        barriers.InsertBufferBarrier(barrier.buffer, barrier.offset, barrier.size, srcStageMask_, dstStageMask_, barrier.srcAccessMask, barrier.dstAccessMask);
+}
+
 bool VKPipelineBarrier::Emplace(std::uint32_t slot, Resource* resource, VkPipelineStageFlags stageFlags)
 {
     /* Emplace resource binding into sorted array */
@@ -101,6 +110,7 @@ bool VKPipelineBarrier::Update()
     srcStageMask_ = 0;
     dstStageMask_ = 0;
     memoryBarrier_.clear();
+    bufferBarriers_.clear();
 
     /* Iterate over all bindings and re-generate all barriers */
     for (const auto& binding : bindings_)
@@ -20,6 +20,7 @@ namespace LLGL
 
 
 class Resource;
+class VKBarrierAccumulator;
 
 // Helper class to manage information for a Vulkan pipeline barrier command.
 class VKPipelineBarrier
@@ -33,6 +34,9 @@ class VKPipelineBarrier
         // Submits this pipeline barrier into the specified command buffer.
         void Submit(VkCommandBuffer commandBuffer);
 
+        // Inserts all barriers of this pipeline barrier into the specified accumulator to be merged with other pending barriers.
+        void InsertInto(VKBarrierAccumulator& barriers) const;
+
         // Emplaces the specified resource into the pipeline barrier.
         bool Emplace(std::uint32_t slot, Resource* resource, VkPipelineStageFlags stageFlags);
 
@@ -6,7 +6,9 @@
  */
 
 #include "VKPipelineCache.h"
+#include "../VKCore.h"
 #include <cstdint>
+#include <string.h>
 
 
 namespace LLGL
@@ -29,8 +31,16 @@ VKPipelineCache::VKPipelineCache(
     const void*                         initialData,
     std::size_t                         initialDataSize)
 :
-    cache_ { device, vkDestroyPipelineCache }
+    device_ { device                         },
+    cache_  { device, vkDestroyPipelineCache }
 {
+    /* Ignore initial data that was serialized with a different driver or device */
+    if (!IsCompatibleData(physicalDeviceProperties, initialData, initialDataSize))
+    {
+        initialData     = nullptr;
+        initialDataSize = 0;
+    }
+
     VkPipelineCacheCreateInfo createInfo;
     {
         createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
@@ -39,7 +49,8 @@ VKPipelineCache::VKPipelineCache(
         createInfo.initialDataSize  = initialDataSize;
         createInfo.pInitialData     = initialData;
     }
-    vkCreatePipelineCache(device, &createInfo, nullptr, cache_.ReleaseAndGetAddressOf());
+    auto result = vkCreatePipelineCache(device, &createInfo, nullptr, cache_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline cache");
 }
 
 std::size_t VKPipelineCache::GetDataSize() const
@@ -49,9 +60,33 @@ std::size_t VKPipelineCache::GetDataSize() const
     return dataSize;
 }
 
-void VKPipelineCache::GetData(void* data, std::size_t dataSize) const
+std::size_t VKPipelineCache::GetData(void* data, std::size_t dataSize) const
 {
-    vkGetPipelineCacheData(device_, cache_, &dataSize, data);
+    auto result = vkGetPipelineCacheData(device_, cache_, &dataSize, data);
+    return (result == VK_SUCCESS || result == VK_INCOMPLETE ? dataSize : 0);
+}
+
+bool VKPipelineCache::IsCompatibleData(
+    const VkPhysicalDeviceProperties&   physicalDeviceProperties,
+    const void*                         data,
+    std::size_t                         dataSize)
+{
+    if (data == nullptr || dataSize < sizeof(VKPipelineCacheDataHeader))
+        return false;
+
+    /* Copy header since the input data is not required to be aligned */
+    VKPipelineCacheDataHeader header;
+    ::memcpy(&header, data, sizeof(header));
+
+    return
+    (
+        header.length   >= sizeof(VKPipelineCacheDataHeader)                                        &&
+        header.length   <= dataSize                                                                 &&
+        header.version  == VK_PIPELINE_CACHE_HEADER_VERSION_ONE                                     &&
+        header.vendorID == physicalDeviceProperties.vendorID                                        &&
+        header.deviceID == physicalDeviceProperties.deviceID                                        &&
+        ::memcmp(header.pipelineCacheUUID, physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0
+    );
 }
 
 
@@ -17,6 +17,10 @@ namespace LLGL
 {
 
 
+/*
+Wrapper for a Vulkan pipeline cache that is shared by all pipeline state objects of a device.
+Initial cache data is only passed to the driver if its header matches the physical device.
+*/
 class VKPipelineCache
 {
 
@@ -32,8 +36,15 @@ class VKPipelineCache
         // Returns the size (in bytes) of the serialized cache data.
         std::size_t GetDataSize() const;
 
-        // Writes the serialized cache data to the output buffer <data>.
-        void GetData(void* data, std::size_t dataSize) const;
+        // Writes the serialized cache data to the output buffer <data> and returns the number of bytes written.
+        std::size_t GetData(void* data, std::size_t dataSize) const;
+
+        // Returns true if the specified data has a valid header for the specified physical device.
+        static bool IsCompatibleData(
+            const VkPhysicalDeviceProperties&   physicalDeviceProperties,
+            const void*                         data,
+            std::size_t                         dataSize
+        );
 
         // Returns the native pipeline cache object.
         inline VkPipelineCache GetNative() const
@@ -7,9 +7,11 @@
 
 #include "VKPipelineLayout.h"
 #include "VKPoolSizeAccumulator.h"
+#include "VKPipelinePool.h"
 #include "../VKTypes.h"
 #include "../VKCore.h"
 #include "../VKStaticLimits.h"
+#include "../Ext/VKExtensionRegistry.h"
 #include "../Texture/VKSampler.h"
 #include "../Shader/VKShader.h"
 #include "../Shader/VKShaderModulePool.h"
@@ -26,7 +28,29 @@ namespace LLGL
 
 VKPtr<VkPipelineLayout> VKPipelineLayout::defaultPipelineLayout_;
 
-VKPipelineLayout::VKPipelineLayout(VkDevice device, const PipelineLayoutDescriptor& desc) :
+// Returns true if the specified dynamic bindings can be pushed directly into the command buffer via VK_KHR_push_descriptor.
+static bool IsPushDescriptorSetSupported(const std::vector<BindingDescriptor>& bindings)
+{
+    if (bindings.empty() || !HasExtension(VKExt::KHR_push_descriptor))
+        return false;
+
+    std::uint32_t numDescriptors = 0;
+    for (const auto& binding : bindings)
+    {
+        /* Acceleration structures are written with a chained VkWriteDescriptorSetAccelerationStructureKHR, which the push descriptor path does not provide */
+        if (binding.type == ResourceType::AccelerationStructure)
+            return false;
+        numDescriptors += std::max(1u, binding.arraySize);
+    }
+
+    return (numDescriptors <= LLGL_VK_MAX_NUM_PUSH_DESCRIPTORS);
+}
+
+VKPipelineLayout::VKPipelineLayout(
+    VkDevice                                                device,
+    const PipelineLayoutDescriptor&                         desc,
+    const VkPhysicalDeviceDescriptorIndexingFeaturesEXT&    descriptorIndexingFeatures)
+:
     pipelineLayout_ { device, vkDestroyPipelineLayout          },
     setLayouts_     { { device, vkDestroyDescriptorSetLayout },
                       { device, vkDestroyDescriptorSetLayout },
@@ -34,19 +58,30 @@ VKPipelineLayout::VKPipelineLayout(VkDevice device, const PipelineLayoutDescript
     descriptorPool_ { device, vkDestroyDescriptorPool          },
     uniformDescs_   { desc.uniforms                            }
 {
+    /* Dynamic bindings are pushed directly into the command buffer if supported, so no descriptor sets must be allocated */
+    const bool isPushDescriptorSet = IsPushDescriptorSetSupported(desc.bindings);
+
     /* Create Vulkan descriptor set layouts */
     if (!desc.heapBindings.empty())
-        CreateBindingSetLayout(device, desc.heapBindings, heapBindings_, SetLayoutType_HeapBindings);
+    {
+        if (desc.bindlessHeap)
+            CreateBindlessHeapSetLayout(device, desc.heapBindings, descriptorIndexingFeatures);
+        else
+            CreateBindingSetLayout(device, desc.heapBindings, heapBindings_, SetLayoutType_HeapBindings);
+    }
     if (!desc.bindings.empty())
-        CreateBindingSetLayout(device, desc.bindings, bindings_, SetLayoutType_DynamicBindings);
+    {
+        const VkDescriptorSetLayoutCreateFlags flags = (isPushDescriptorSet ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0);
+        CreateBindingSetLayout(device, desc.bindings, bindings_, SetLayoutType_DynamicBindings, flags);
+    }
     if (!desc.staticSamplers.empty())
         CreateImmutableSamplers(device, desc.staticSamplers);
 
     /* Create descriptor pool for dynamic descriptors and immutable samplers */
-    if (!desc.bindings.empty() || !desc.staticSamplers.empty())
-        CreateDescriptorPool(device);
+    if ((!desc.bindings.empty() && !isPushDescriptorSet) || !desc.staticSamplers.empty())
+        CreateDescriptorPool(device, isPushDescriptorSet);
     if (!desc.bindings.empty())
-        CreateDescriptorCache(device, setLayouts_[SetLayoutType_DynamicBindings].Get());
+        CreateDescriptorCache(device, setLayouts_[SetLayoutType_DynamicBindings].Get(), isPushDescriptorSet);
     if (!desc.staticSamplers.empty())
         CreateStaticDescriptorSet(device, setLayouts_[SetLayoutType_ImmutableSamplers].Get());
 
@@ -55,12 +90,17 @@ VKPipelineLayout::VKPipelineLayout(VkDevice device, const PipelineLayoutDescript
     {
         BuildDescriptorSetBindingTables(desc);
         pipelineLayout_ = CreateVkPipelineLayout(device);
+
+        /* Descriptor update templates are only compatible with this layout, i.e. not with its permutations for push constants */
+        if (isPushDescriptorSet && uniformDescs_.empty())
+            descriptorCache_->SetPushDescriptorTemplateLayout(pipelineLayout_.Get(), GetBindPointForDynamicBindings());
     }
 }
 
 VKPipelineLayout::~VKPipelineLayout()
 {
     VKShaderModulePool::Get().NotifyReleasePipelineLayout(this);
+    VKPipelinePool::Get().NotifyReleaseObject(this);
 }
 
 std::uint32_t VKPipelineLayout::GetNumHeapBindings() const
@@ -178,10 +218,11 @@ bool VKPipelineLayout::NeedsShaderModulePermutation(const VKShader& shaderVK) co
     );
 }
 
-VKPtr<VkShaderModule> VKPipelineLayout::CreateVkShaderModulePermutation(VKShader& shaderVK) const
+bool VKPipelineLayout::PermuteShaderBindingLayout(const VKShader& shaderVK, VKShaderBindingLayout& outBindingLayout) const
 {
-    return shaderVK.CreateVkShaderModulePermutation(
-        std::bind(&VKPipelineLayout::GetBindingSlotsAssignment, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)
+    return shaderVK.PermuteBindingLayout(
+        std::bind(&VKPipelineLayout::GetBindingSlotsAssignment, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+        outBindingLayout
     );
 }
 
@@ -222,6 +263,8 @@ static VkShaderStageFlags GetVkShaderStageFlags(long flags)
     if ((flags & StageFlags::GeometryStage      ) != 0) { bitmask |= VK_SHADER_STAGE_GEOMETRY_BIT;                }
     if ((flags & StageFlags::FragmentStage      ) != 0) { bitmask |= VK_SHADER_STAGE_FRAGMENT_BIT;                }
     if ((flags & StageFlags::ComputeStage       ) != 0) { bitmask |= VK_SHADER_STAGE_COMPUTE_BIT;                 }
+    if ((flags & StageFlags::TaskStage          ) != 0) { bitmask |= VK_SHADER_STAGE_TASK_BIT_EXT;                }
+    if ((flags & StageFlags::MeshStage          ) != 0) { bitmask |= VK_SHADER_STAGE_MESH_BIT_EXT;                }
 
     return bitmask;
 }
@@ -241,6 +284,8 @@ static VkDescriptorType GetVkDescriptorType(const BindingDescriptor& desc)
             if ((desc.bindFlags & (BindFlags::Sampled | BindFlags::Storage)) != 0)
                 return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             break;
+        case ResourceType::AccelerationStructure:
+            return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
         default:
             break;
     }
@@ -250,13 +295,15 @@ static VkDescriptorType GetVkDescriptorType(const BindingDescriptor& desc)
 void VKPipelineLayout::CreateVkDescriptorSetLayout(
     VkDevice                                        device,
     SetLayoutType                                   setLayoutType,
-    const ArrayView<VkDescriptorSetLayoutBinding>&  setLayoutBindings)
+    const ArrayView<VkDescriptorSetLayoutBinding>&  setLayoutBindings,
+    VkDescriptorSetLayoutCreateFlags                flags,
+    const void*                                     next)
 {
     VkDescriptorSetLayoutCreateInfo createInfo;
     {
         createInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        createInfo.pNext        = nullptr;
-        createInfo.flags        = 0;
+        createInfo.pNext        = next;
+        createInfo.flags        = flags;
         createInfo.bindingCount = static_cast<std::uint32_t>(setLayoutBindings.size());
         createInfo.pBindings    = setLayoutBindings.data();
     }
@@ -277,7 +324,8 @@ void VKPipelineLayout::CreateBindingSetLayout(
     VkDevice                                device,
     const std::vector<BindingDescriptor>&   inBindings,
     std::vector<VKLayoutBinding>&           outBindings,
-    SetLayoutType                           setLayoutType)
+    SetLayoutType                           setLayoutType,
+    VkDescriptorSetLayoutCreateFlags        flags)
 {
     /* Convert heap bindings to native descriptor set layout bindings and create Vulkan descriptor set layout */
     const auto numBindings = inBindings.size();
@@ -286,7 +334,7 @@ void VKPipelineLayout::CreateBindingSetLayout(
     for_range(i, numBindings)
         Convert(setLayoutBindings[i], inBindings[i]);
 
-    CreateVkDescriptorSetLayout(device, setLayoutType, setLayoutBindings);
+    CreateVkDescriptorSetLayout(device, setLayoutType, setLayoutBindings, flags);
 
     /* Create list of binding points (for later pass to 'VkWriteDescriptorSet::dstBinding') */
     outBindings.reserve(numBindings);
@@ -297,12 +345,99 @@ void VKPipelineLayout::CreateBindingSetLayout(
             {
                 inBindings[i].slot.index,
                 inBindings[i].stageFlags,
-                setLayoutBindings[i].descriptorType
+                setLayoutBindings[i].descriptorType,
+                0,
+                0
             }
         );
     }
 }
 
+// Returns true if descriptors of the specified type can be updated after their descriptor set has been bound.
+static bool IsUpdateAfterBindSupported(VkDescriptorType type, const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& features)
+{
+    switch (type)
+    {
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            return (features.descriptorBindingSampledImageUpdateAfterBind != VK_FALSE);
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            return (features.descriptorBindingStorageImageUpdateAfterBind != VK_FALSE);
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            return (features.descriptorBindingUniformBufferUpdateAfterBind != VK_FALSE);
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            return (features.descriptorBindingStorageBufferUpdateAfterBind != VK_FALSE);
+        default:
+            return false;
+    }
+}
+
+// Returns the descriptor binding flags for a bindless heap binding of the specified type.
+static VkDescriptorBindingFlagsEXT GetVkDescriptorBindingFlags(VkDescriptorType type, const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& features)
+{
+    VkDescriptorBindingFlagsEXT flags = 0;
+
+    if (features.descriptorBindingPartiallyBound != VK_FALSE)
+        flags |= VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+    if (features.descriptorBindingUpdateUnusedWhilePending != VK_FALSE)
+        flags |= VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+    if (IsUpdateAfterBindSupported(type, features))
+        flags |= VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
+
+    return flags;
+}
+
+void VKPipelineLayout::CreateBindlessHeapSetLayout(
+    VkDevice                                                device,
+    const std::vector<BindingDescriptor>&                   inBindings,
+    const VkPhysicalDeviceDescriptorIndexingFeaturesEXT&    descriptorIndexingFeatures)
+{
+    /* Convert heap bindings to native descriptor set layout bindings with binding flags for partially bound descriptor arrays */
+    const auto numBindings = inBindings.size();
+    std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings(numBindings);
+    std::vector<VkDescriptorBindingFlagsEXT> bindingFlags(numBindings);
+
+    VkDescriptorSetLayoutCreateFlags flags = 0;
+
+    for_range(i, numBindings)
+    {
+        Convert(setLayoutBindings[i], inBindings[i]);
+        bindingFlags[i] = GetVkDescriptorBindingFlags(setLayoutBindings[i].descriptorType, descriptorIndexingFeatures);
+
+        /* Descriptor sets with update-after-bind bindings must be allocated from a pool with the same flag */
+        if ((bindingFlags[i] & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT) != 0)
+            flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo;
+    {
+        bindingFlagsInfo.sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        bindingFlagsInfo.pNext          = nullptr;
+        bindingFlagsInfo.bindingCount   = static_cast<std::uint32_t>(bindingFlags.size());
+        bindingFlagsInfo.pBindingFlags  = bindingFlags.data();
+    }
+    CreateVkDescriptorSetLayout(device, SetLayoutType_HeapBindings, setLayoutBindings, flags, &bindingFlagsInfo);
+
+    /* Create list of binding points with one entry per array element, so each element occupies its own descriptor in a resource heap */
+    for_range(i, numBindings)
+    {
+        for_range(arrayElement, setLayoutBindings[i].descriptorCount)
+        {
+            heapBindings_.push_back(
+                VKLayoutBinding
+                {
+                    inBindings[i].slot.index,
+                    inBindings[i].stageFlags,
+                    setLayoutBindings[i].descriptorType,
+                    arrayElement,
+                    bindingFlags[i]
+                }
+            );
+        }
+    }
+}
+
 static void Convert(VkDescriptorSetLayoutBinding& dst, const StaticSamplerDescriptor& src, const VkSampler* immutableSamplerVK)
 {
     dst.binding             = src.slot.index;
@@ -364,13 +499,16 @@ VKPtr<VkPipelineLayout> VKPipelineLayout::CreateVkPipelineLayout(VkDevice device
     return pipelineLayout;
 }
 
-void VKPipelineLayout::CreateDescriptorPool(VkDevice device)
+void VKPipelineLayout::CreateDescriptorPool(VkDevice device, bool isPushDescriptorSet)
 {
-    /* Accumulate descriptor pool sizes for all dynamic resources and immutable samplers */
+    /* Accumulate descriptor pool sizes for all dynamic resources (unless they are pushed) and immutable samplers */
     VKPoolSizeAccumulator poolSizeAccum;
 
-    for (const auto binding : bindings_)
-        poolSizeAccum.Accumulate(binding.descriptorType);
+    if (!isPushDescriptorSet)
+    {
+        for (const auto binding : bindings_)
+            poolSizeAccum.Accumulate(binding.descriptorType);
+    }
 
     if (!immutableSamplers_.empty())
         poolSizeAccum.Accumulate(VK_DESCRIPTOR_TYPE_SAMPLER, static_cast<std::uint32_t>(immutableSamplers_.size()));
@@ -391,8 +529,15 @@ void VKPipelineLayout::CreateDescriptorPool(VkDevice device)
     VKThrowIfFailed(result, "failed to create Vulkan descriptor pool for static samplers");
 }
 
-void VKPipelineLayout::CreateDescriptorCache(VkDevice device, VkDescriptorSetLayout setLayout)
+void VKPipelineLayout::CreateDescriptorCache(VkDevice device, VkDescriptorSetLayout setLayout, bool isPushDescriptorSet)
 {
+    /* Push descriptors don't need any descriptor pool or intermediate descriptor set */
+    if (isPushDescriptorSet)
+    {
+        descriptorCache_ = MakeUnique<VKDescriptorCache>(device, bindings_);
+        return;
+    }
+
     /*
     Don't account descriptors in the dynamic cache for immutable samplers,
     so accumulate pool sizes only for dynamiuc resources here
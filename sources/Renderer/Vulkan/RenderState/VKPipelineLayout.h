@@ -28,9 +28,11 @@ class VKPoolSizeAccumulator;
 
 struct VKLayoutBinding
 {
-    std::uint32_t       dstBinding;
-    long                stageFlags;
-    VkDescriptorType    descriptorType;
+    std::uint32_t               dstBinding;
+    long                        stageFlags;
+    VkDescriptorType            descriptorType;
+    std::uint32_t               dstArrayElement;    // Array element within the binding; only non-zero for bindless heap bindings.
+    VkDescriptorBindingFlagsEXT bindingFlags;       // Descriptor binding flags; only non-zero for bindless heap bindings.
 };
 
 class VKPipelineLayout final : public PipelineLayout
@@ -42,7 +44,11 @@ class VKPipelineLayout final : public PipelineLayout
 
     public:
 
-        VKPipelineLayout(VkDevice device, const PipelineLayoutDescriptor& desc);
+        VKPipelineLayout(
+            VkDevice                                                device,
+            const PipelineLayoutDescriptor&                         desc,
+            const VkPhysicalDeviceDescriptorIndexingFeaturesEXT&    descriptorIndexingFeatures
+        );
         ~VKPipelineLayout();
 
         /*
@@ -58,8 +64,8 @@ class VKPipelineLayout final : public PipelineLayout
         // Returns true if a permutation is required for the specified shader.
         bool NeedsShaderModulePermutation(const VKShader& shaderVK) const;
 
-        // Creates a permutation of the specified shader. Should only be used by VKShaderModulePool.
-        VKPtr<VkShaderModule> CreateVkShaderModulePermutation(VKShader& shaderVK) const;
+        // Re-assigns the binding slots of the specified shader for this pipeline layout. Returns false if no permutation is needed. Should only be used by VKShaderModulePool.
+        bool PermuteShaderBindingLayout(const VKShader& shaderVK, VKShaderBindingLayout& outBindingLayout) const;
 
         // Returns the native VkPipelineLayout object.
         inline VkPipelineLayout GetVkPipelineLayout() const
@@ -103,7 +109,7 @@ class VKPipelineLayout final : public PipelineLayout
             return staticDescriptorSet_;
         }
 
-        // Returns the list of binding points that must be passed to 'VkWriteDescriptorSet' members.
+        // Returns the list of binding points that must be passed to 'VkWriteDescriptorSet' members. For bindless heaps, this contains one entry per array element.
         inline const std::vector<VKLayoutBinding>& GetLayoutHeapBindings() const
         {
             return heapBindings_;
@@ -162,14 +168,23 @@ class VKPipelineLayout final : public PipelineLayout
         void CreateVkDescriptorSetLayout(
             VkDevice                                        device,
             SetLayoutType                                   setLayoutType,
-            const ArrayView<VkDescriptorSetLayoutBinding>&  setLayoutBindings
+            const ArrayView<VkDescriptorSetLayoutBinding>&  setLayoutBindings,
+            VkDescriptorSetLayoutCreateFlags                flags = 0,
+            const void*                                     next  = nullptr
         );
 
         void CreateBindingSetLayout(
             VkDevice                                device,
             const std::vector<BindingDescriptor>&   inBindings,
             std::vector<VKLayoutBinding>&           outBindings,
-            SetLayoutType                           setLayoutType
+            SetLayoutType                           setLayoutType,
+            VkDescriptorSetLayoutCreateFlags        flags = 0
+        );
+
+        void CreateBindlessHeapSetLayout(
+            VkDevice                                                device,
+            const std::vector<BindingDescriptor>&                   inBindings,
+            const VkPhysicalDeviceDescriptorIndexingFeaturesEXT&    descriptorIndexingFeatures
         );
 
         void CreateImmutableSamplers(
@@ -182,8 +197,8 @@ class VKPipelineLayout final : public PipelineLayout
             const ArrayView<VkPushConstantRange>&   pushConstantRanges = {}
         ) const;
 
-        void CreateDescriptorPool(VkDevice device);
-        void CreateDescriptorCache(VkDevice device, VkDescriptorSetLayout setLayout);
+        void CreateDescriptorPool(VkDevice device, bool isPushDescriptorSet);
+        void CreateDescriptorCache(VkDevice device, VkDescriptorSetLayout setLayout, bool isPushDescriptorSet);
         void CreateStaticDescriptorSet(VkDevice device, VkDescriptorSetLayout setLayout);
 
         void BuildDescriptorSetBindingTables(const PipelineLayoutDescriptor& desc);
@@ -0,0 +1,193 @@
+/*
+ * VKPipelinePool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKPipelinePool.h"
+#include "../../../Core/CoreUtils.h"
+#include "../../../Core/MacroUtils.h"
+#include <algorithm>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * VKPipelineKey class
+ */
+
+void VKPipelineKey::AppendBytes(const void* data, std::size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    data_.insert(data_.end(), bytes, bytes + size);
+}
+
+void VKPipelineKey::AppendDependency(const void* object)
+{
+    Append(object);
+    if (object != nullptr)
+        dependencies_.push_back(object);
+}
+
+std::uint64_t VKPipelineKey::GetHash() const
+{
+    return HashFNV1a(data_.data(), data_.size());
+}
+
+
+/*
+ * VKPipelinePool class
+ */
+
+VKPipelinePool& VKPipelinePool::Get()
+{
+    static VKPipelinePool instance;
+    return instance;
+}
+
+void VKPipelinePool::Clear()
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    pipelines_.clear();
+    orphans_.clear();
+}
+
+VKPooledPipeline* VKPipelinePool::GetOrCreatePipeline(const VKPipelineKey& key, const CreatePipelineFunction& createFunc)
+{
+    const std::uint64_t hash = key.GetHash();
+
+    /* Try to find existing pipeline with the same key */
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        if (VKPooledPipeline* pipeline = FindPipeline(hash, key.GetData(), nullptr))
+        {
+            pipeline->numRefs++;
+            return pipeline;
+        }
+    }
+
+    /* Create native pipeline outside of the lock; libraries that have already been acquired are released if creation fails */
+    auto newPipeline = MakeUnique<VKPooledPipeline>();
+    {
+        newPipeline->hash           = hash;
+        newPipeline->key            = key.GetData();
+        newPipeline->dependencies   = key.GetDependencies();
+    }
+
+    try
+    {
+        createFunc(newPipeline->pipeline, newPipeline->libraries);
+    }
+    catch (...)
+    {
+        for (VKPooledPipeline* library : newPipeline->libraries)
+            ReleasePipeline(library);
+        throw;
+    }
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Another thread might have created the same pipeline in the meantime, in which case the new one is discarded */
+    std::size_t insertionPos = 0;
+    if (VKPooledPipeline* pipeline = FindPipeline(hash, newPipeline->key, &insertionPos))
+    {
+        pipeline->numRefs++;
+        newPipeline->pipeline.Release();
+        for (VKPooledPipeline* library : newPipeline->libraries)
+            ReleasePipelineLocked(library);
+        return pipeline;
+    }
+
+    VKPooledPipeline* pipeline = newPipeline.get();
+    pipeline->numRefs = 1;
+    pipelines_.insert(pipelines_.begin() + insertionPos, std::move(newPipeline));
+    return pipeline;
+}
+
+void VKPipelinePool::ReleasePipeline(VKPooledPipeline* pipeline)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    ReleasePipelineLocked(pipeline);
+}
+
+void VKPipelinePool::NotifyReleaseObject(const void* object)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Move all dependent pipelines into the orphan list; they are released by the PSOs that still refer to them */
+    for (std::unique_ptr<VKPooledPipeline>& entry : pipelines_)
+    {
+        if (std::find(entry->dependencies.begin(), entry->dependencies.end(), object) != entry->dependencies.end())
+            orphans_.push_back(std::move(entry));
+    }
+
+    RemoveAllFromListIf(
+        pipelines_,
+        [](const std::unique_ptr<VKPooledPipeline>& entry) -> bool
+        {
+            return (entry.get() == nullptr);
+        }
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VKPooledPipeline* VKPipelinePool::FindPipeline(std::uint64_t hash, const std::vector<char>& key, std::size_t* insertionPos)
+{
+    const std::size_t keySize = key.size();
+    auto* pipelineRef = FindInSortedArray<std::unique_ptr<VKPooledPipeline>>(
+        pipelines_.data(),
+        pipelines_.size(),
+        [hash, keySize, &key](const std::unique_ptr<VKPooledPipeline>& entry) -> int
+        {
+            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(hash, entry->hash);
+            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(keySize, entry->key.size());
+            return (keySize > 0 ? ::memcmp(key.data(), entry->key.data(), keySize) : 0);
+        },
+        insertionPos
+    );
+    return (pipelineRef != nullptr ? pipelineRef->get() : nullptr);
+}
+
+void VKPipelinePool::ReleasePipelineLocked(VKPooledPipeline* pipeline)
+{
+    /* Only dereference the pipeline once it's been found in this pool, since it might have been released with Clear() already */
+    for (std::vector<std::unique_ptr<VKPooledPipeline>>* list : { &pipelines_, &orphans_ })
+    {
+        auto it = std::find_if(
+            list->begin(),
+            list->end(),
+            [pipeline](const std::unique_ptr<VKPooledPipeline>& entry) -> bool
+            {
+                return (entry.get() == pipeline);
+            }
+        );
+        if (it != list->end())
+        {
+            if (--pipeline->numRefs == 0)
+            {
+                /* Release linked pipeline before the libraries it has been linked from */
+                std::unique_ptr<VKPooledPipeline> releasedPipeline = std::move(*it);
+                list->erase(it);
+                releasedPipeline->pipeline.Release();
+                for (VKPooledPipeline* library : releasedPipeline->libraries)
+                    ReleasePipelineLocked(library);
+            }
+            return;
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,141 @@
+/*
+ * VKPipelinePool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_PIPELINE_POOL_H
+#define LLGL_VK_PIPELINE_POOL_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Identity of the state a pooled pipeline is created with.
+Values must be appended member by member, since native Vulkan structures can have undefined padding bytes.
+Objects the native state was derived from, such as shaders and pipeline layouts, are appended as dependencies,
+so a pipeline is no longer shared once any of them has been released and its address might be reused.
+*/
+class VKPipelineKey
+{
+
+    public:
+
+        template <typename T>
+        void Append(const T& value)
+        {
+            AppendBytes(&value, sizeof(value));
+        }
+
+        void AppendBytes(const void* data, std::size_t size);
+
+        // Appends the address of the specified object to the key and records it as dependency.
+        void AppendDependency(const void* object);
+
+        // Returns the 64-bit FNV-1a hash of this key.
+        std::uint64_t GetHash() const;
+
+        // Returns the byte representation of this key.
+        inline const std::vector<char>& GetData() const
+        {
+            return data_;
+        }
+
+        // Returns the list of objects this key depends on.
+        inline const std::vector<const void*>& GetDependencies() const
+        {
+            return dependencies_;
+        }
+
+    private:
+
+        std::vector<char>           data_;
+        std::vector<const void*>    dependencies_;
+
+};
+
+// Native pipeline or pipeline library that is shared by all PSOs with the same key.
+struct VKPooledPipeline
+{
+    std::uint64_t                   hash            = 0;
+    std::vector<char>               key;
+    std::vector<const void*>        dependencies;
+    std::vector<VKPooledPipeline*>  libraries;          // Pipeline libraries this pipeline has been linked from; holds a reference to each of them.
+    std::uint32_t                   numRefs         = 0;
+    VKPtr<VkPipeline>               pipeline;
+};
+
+/*
+Singleton pool of native graphics pipelines and graphics pipeline libraries.
+PSOs whose remaining static state is identical share a single VkPipeline, which is the case for many PSOs when most states are dynamic.
+All public functions are thread-safe, since pipelines are also requested by PSOs that are compiled in the background.
+*/
+class VKPipelinePool
+{
+
+    public:
+
+        // Creates the native pipeline for a new pool entry and appends the pool entries it has been linked from to the output list.
+        using CreatePipelineFunction = std::function<void(VKPtr<VkPipeline>& outPipeline, std::vector<VKPooledPipeline*>& outLibraries)>;
+
+    public:
+
+        VKPipelinePool(const VKPipelinePool&) = delete;
+        VKPipelinePool& operator = (const VKPipelinePool&) = delete;
+
+        // Returns the instance of this pool.
+        static VKPipelinePool& Get();
+
+        // Clear all resource containers of this pool (used by VKRenderSystem).
+        void Clear();
+
+        /*
+        Returns the pipeline with the specified key or creates a new one with the specified function. Increments its reference counter.
+        The pipeline is created outside of the lock, so multiple threads can create different pipelines at the same time.
+        */
+        VKPooledPipeline* GetOrCreatePipeline(const VKPipelineKey& key, const CreatePipelineFunction& createFunc);
+
+        // Decrements the reference counter of the specified pipeline and releases it if it's no longer used.
+        void ReleasePipeline(VKPooledPipeline* pipeline);
+
+        // Removes all pipelines that depend on the specified object from the lookup, so they are no longer shared with new PSOs.
+        void NotifyReleaseObject(const void* object);
+
+    private:
+
+        VKPipelinePool() = default;
+
+        VKPooledPipeline* FindPipeline(std::uint64_t hash, const std::vector<char>& key, std::size_t* insertionPos);
+
+        void ReleasePipelineLocked(VKPooledPipeline* pipeline);
+
+    private:
+
+        std::vector<std::unique_ptr<VKPooledPipeline>>  pipelines_; // Sorted by hash and key
+        std::vector<std::unique_ptr<VKPooledPipeline>>  orphans_;   // Pipelines that are still in use but whose dependencies have been released
+        std::mutex                                      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,7 @@
 
 #include "VKPipelineState.h"
 #include "VKPipelineLayout.h"
+#include "VKDescriptorCache.h"
 #include "../Shader/VKShader.h"
 #include "../Shader/VKShaderModulePool.h"
 #include "../../CheckedCast.h"
@@ -33,13 +34,50 @@ VKPipelineState::VKPipelineState(
     }
 }
 
+VKPipelineState::~VKPipelineState()
+{
+    /* Drop pending creation or wait until the worker has finished with this PSO */
+    if (creationTask_)
+        creationTask_->Cancel();
+    if (pooledPipeline_ != nullptr)
+        VKPipelinePool::Get().ReleasePipeline(pooledPipeline_);
+}
+
 const Report* VKPipelineState::GetReport() const
 {
-    return nullptr; //TODO
+    if (creationTask_)
+        creationTask_->Wait();
+    return (report_ ? &report_ : nullptr);
+}
+
+bool VKPipelineState::IsReady() const
+{
+    return (!creationTask_ || creationTask_->IsDone());
+}
+
+void VKPipelineState::Wait()
+{
+    if (creationTask_)
+        creationTask_->Wait();
+}
+
+VKPipelineState& VKPipelineState::GetReadyOrFallback()
+{
+    if (creationTask_ && !creationTask_->IsDone())
+    {
+        if (fallback_ != nullptr)
+            return fallback_->GetReadyOrFallback();
+        creationTask_->Wait();
+    }
+    return *this;
 }
 
 void VKPipelineState::BindPipelineAndStaticDescriptorSet(VkCommandBuffer commandBuffer)
 {
+    /* Skip PSOs whose creation in the background has failed; the error is in the report */
+    if (GetVkPipeline() == VK_NULL_HANDLE)
+        return;
+
     vkCmdBindPipeline(commandBuffer, GetBindPoint(), GetVkPipeline());
 
     if (pipelineLayout_ != nullptr)
@@ -86,6 +124,12 @@ void VKPipelineState::BindDynamicDescriptorSet(VkCommandBuffer commandBuffer, Vk
         BindDescriptorSets(commandBuffer, pipelineLayout_->GetBindPointForDynamicBindings(), 1, &descriptorSet);
 }
 
+void VKPipelineState::PushDynamicDescriptorSet(VkCommandBuffer commandBuffer, VKDescriptorCache& descriptorCache)
+{
+    if (pipelineLayout_ != nullptr)
+        descriptorCache.FlushPushDescriptorSet(commandBuffer, GetBindPoint(), GetVkPipelineLayout(), pipelineLayout_->GetBindPointForDynamicBindings());
+}
+
 void VKPipelineState::BindHeapDescriptorSet(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet)
 {
     if (pipelineLayout_ != nullptr && descriptorSet != VK_NULL_HANDLE)
@@ -125,6 +169,33 @@ VkPipeline* VKPipelineState::ReleaseAndGetAddressOfVkPipeline()
     return pipeline_.ReleaseAndGetAddressOf();
 }
 
+void VKPipelineState::SetPooledPipeline(VKPooledPipeline* pooledPipeline)
+{
+    if (pooledPipeline_ != nullptr)
+        VKPipelinePool::Get().ReleasePipeline(pooledPipeline_);
+    pooledPipeline_ = pooledPipeline;
+}
+
+void VKPipelineState::CreateVkPipelineAsync(const std::function<void()>& createFunc, PipelineState* fallbackPipelineState)
+{
+    if (fallbackPipelineState != nullptr)
+        fallback_ = LLGL_CAST(VKPipelineState*, fallbackPipelineState);
+
+    creationTask_ = DoAsync(
+        [this, createFunc]()
+        {
+            try
+            {
+                createFunc();
+            }
+            catch (const std::exception& e)
+            {
+                report_.Errorf("%s\n", e.what());
+            }
+        }
+    );
+}
+
 VkPipelineLayout VKPipelineState::GetVkPipelineLayout() const
 {
     if (pipelineLayoutPerm_.Get() != VK_NULL_HANDLE)
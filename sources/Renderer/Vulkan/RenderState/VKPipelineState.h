@@ -10,9 +10,12 @@
 
 
 #include <LLGL/PipelineState.h>
+#include <LLGL/Report.h>
 #include <LLGL/Container/ArrayView.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
+#include "VKPipelinePool.h"
+#include "../../../Core/Threading.h"
 #include <vector>
 
 
@@ -24,6 +27,7 @@ class Shader;
 class PipelineLayout;
 class VKShader;
 class VKPipelineLayout;
+class VKDescriptorCache;
 
 class VKPipelineState : public PipelineState
 {
@@ -36,27 +40,39 @@ class VKPipelineState : public PipelineState
             const ArrayView<Shader*>&   shaders,
             const PipelineLayout*       pipelineLayout = nullptr
         );
+        ~VKPipelineState();
 
         const Report* GetReport() const override;
+        bool IsReady() const override;
+        void Wait() override;
 
     public:
 
+        /*
+        Returns this PSO if it has been compiled or if it has no fallback, in which case this blocks until it has been compiled.
+        Otherwise, returns the fallback PSO that is bound in place of this PSO while it is still being compiled in the background.
+        */
+        VKPipelineState& GetReadyOrFallback();
+
         // Binds this pipeline state and optional static descriptor sets (for immutable samplers) to the specified Vulkan command buffer.
         void BindPipelineAndStaticDescriptorSet(VkCommandBuffer commandBuffer);
 
         // Binds the specified descriptor set to the dynamic descriptor set binding point.
         void BindDynamicDescriptorSet(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet);
 
+        // Pushes all changed descriptors of the specified cache to the dynamic descriptor set binding point.
+        void PushDynamicDescriptorSet(VkCommandBuffer commandBuffer, VKDescriptorCache& descriptorCache);
+
         // Binds the specified descriptor set to teh heap descriptor set binding point.
         void BindHeapDescriptorSet(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet);
 
         // Pushes the specified values to the command buffer as push-constants.
         void PushConstants(VkCommandBuffer commandBuffer, std::uint32_t first, const char* data, std::uint32_t size);
 
-        // Returns the native PSO.
+        // Returns the native PSO. This is either owned by this PSO or shared via VKPipelinePool.
         inline VkPipeline GetVkPipeline() const
         {
-            return pipeline_.Get();
+            return (pooledPipeline_ != nullptr ? pooledPipeline_->pipeline.Get() : pipeline_.Get());
         }
 
         // Returns the pipeline binding point.
@@ -76,6 +92,15 @@ class VKPipelineState : public PipelineState
         // Releases the native PSO and returns its address.
         VkPipeline* ReleaseAndGetAddressOfVkPipeline();
 
+        // Uses the specified pipeline from VKPipelinePool in place of an owned native PSO. This PSO takes over the reference that was acquired from the pool.
+        void SetPooledPipeline(VKPooledPipeline* pooledPipeline);
+
+        /*
+        Runs the specified function to create the native PSO on the worker thread pool. Creation errors are written to the report.
+        The function must only access the state of this base class, since the task is cancelled or waited on in its destructor.
+        */
+        void CreateVkPipelineAsync(const std::function<void()>& createFunc, PipelineState* fallbackPipelineState);
+
         // Returns the native Vulkan pipeline layout this PSO was created with or the specified layout if there was no layout specified.
         VkPipelineLayout GetVkPipelineLayout() const;
 
@@ -99,11 +124,16 @@ class VKPipelineState : public PipelineState
     private:
 
         VKPtr<VkPipeline>                   pipeline_;
+        VKPooledPipeline*                   pooledPipeline_     = nullptr;
         VKPtr<VkPipelineLayout>             pipelineLayoutPerm_;
         const VKPipelineLayout*             pipelineLayout_     = nullptr;
         VkPipelineBindPoint                 bindPoint_          = VK_PIPELINE_BIND_POINT_MAX_ENUM;
         std::vector<VkPushConstantRange>    uniformRanges_;     // Push constant ranges; One range for each uniform descriptor. See UniformDescriptor.
 
+        AsyncTaskSPtr                       creationTask_;
+        VKPipelineState*                    fallback_           = nullptr;
+        Report                              report_;
+
 };
 
 
@@ -6,6 +6,7 @@
  */
 
 #include "VKPoolSizeAccumulator.h"
+#include "../VKCore.h"
 #include <LLGL/Utils/ForRange.h>
 
 
@@ -13,18 +14,9 @@ namespace LLGL
 {
 
 
-// Returns the zero-based index of a descriptor pool for the specified descriptor type
-static std::uint32_t GetPoolIndex(VkDescriptorType type)
-{
-    if (type >= VK_DESCRIPTOR_TYPE_SAMPLER && type <= VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT)
-        return static_cast<std::uint32_t>(type);
-    else
-        return -1;
-}
-
 void VKPoolSizeAccumulator::Accumulate(VkDescriptorType type, std::uint32_t count)
 {
-    const auto poolIndex = GetPoolIndex(type);
+    const auto poolIndex = VKDescriptorTypeToIndex(type);
     countsPerType_[poolIndex] += count;
 }
 
@@ -36,7 +28,7 @@ void VKPoolSizeAccumulator::Finalize()
         {
             VkDescriptorPoolSize poolSizeInfo;
             {
-                poolSizeInfo.type               = static_cast<VkDescriptorType>(i);
+                poolSizeInfo.type               = VKIndexToDescriptorType(i);
                 poolSizeInfo.descriptorCount    = countsPerType_[i];
             }
             poolSizes_.push_back(poolSizeInfo);
@@ -10,6 +10,7 @@
 
 
 #include <vulkan/vulkan.h>
+#include "../VKStaticLimits.h"
 #include <LLGL/Container/SmallVector.h>
 #include <cstdint>
 
@@ -24,7 +25,7 @@ class VKPoolSizeAccumulator
 
     public:
 
-        static constexpr auto numDescriptorTypes = (static_cast<std::uint32_t>(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT) + 1);
+        static constexpr auto numDescriptorTypes = LLGL_VK_NUM_DESCRIPTOR_TYPES;
 
     public:
 
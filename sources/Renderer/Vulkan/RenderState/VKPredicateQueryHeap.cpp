@@ -22,9 +22,9 @@ VKPredicateQueryHeap::VKPredicateQueryHeap(
     VKDeviceMemoryManager&      deviceMemoryManager,
     const QueryHeapDescriptor&  desc)
 :
-    VKQueryHeap   { device, desc        },
-    resultBuffer_ { device              },
-    memoryMngr_   { deviceMemoryManager }
+    VKQueryHeap   { device, deviceMemoryManager, desc },
+    resultBuffer_ { device                            },
+    memoryMngr_   { deviceMemoryManager               }
 {
     /* Create result buffer for occlusion predicates */
     VkBufferCreateInfo createInfo;
@@ -6,8 +6,13 @@
  */
 
 #include "VKQueryHeap.h"
+#include "../Memory/VKDeviceMemoryManager.h"
 #include "../VKCore.h"
 #include "../VKTypes.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
+#include <LLGL/Utils/ForRange.h>
+#include <string.h>
 
 
 namespace LLGL
@@ -52,13 +57,25 @@ static VkQueryControlFlags GetQueryControlFlags(const QueryHeapDescriptor& desc)
     return flags;
 }
 
-VKQueryHeap::VKQueryHeap(VkDevice device, const QueryHeapDescriptor& desc) :
-    QueryHeap      { desc.type                    },
-    queryPool_     { device, vkDestroyQueryPool   },
-    controlFlags_  { GetQueryControlFlags(desc)   },
-    groupSize_     { GetQueryGroupSize(desc)      },
-    numQueries_    { desc.numQueries * groupSize_ },
-    hasPredicates_ { desc.renderCondition         }
+// Availability value of native queries that must be retrieved from the query pool; the device only writes 0 or 1
+static constexpr std::uint64_t g_uncachedQueryAvailability = ~0ull;
+
+VKQueryHeap::VKQueryHeap(
+    VkDevice                    device,
+    VKDeviceMemoryManager&      deviceMemoryManager,
+    const QueryHeapDescriptor&  desc,
+    float                       timestampPeriod)
+:
+    QueryHeap           { desc.type                    },
+    device_             { device                       },
+    queryPool_          { device, vkDestroyQueryPool   },
+    controlFlags_       { GetQueryControlFlags(desc)   },
+    groupSize_          { GetQueryGroupSize(desc)      },
+    numQueries_         { desc.numQueries * groupSize_ },
+    hasPredicates_      { desc.renderCondition         },
+    timestampPeriod_    { timestampPeriod              },
+    readbackBuffer_     { device                       },
+    readbackMemoryMngr_ { deviceMemoryManager          }
 {
     /* Create query pool object */
     VkQueryPoolCreateInfo createInfo;
@@ -72,6 +89,167 @@ VKQueryHeap::VKQueryHeap(VkDevice device, const QueryHeapDescriptor& desc) :
     }
     auto result = vkCreateQueryPool(device, &createInfo, nullptr, queryPool_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan query pool");
+
+    /* Queries must be reset before their first use */
+    if (HasExtension(VKExt::EXT_host_query_reset))
+    {
+        vkResetQueryPoolEXT(device, queryPool_, 0, numQueries_);
+
+        /* Queries can only be reset outside of command buffers with host query reset, so results are only cached in that case */
+        if (desc.type == QueryType::PipelineStatistics)
+            numResultValues_ = sizeof(QueryPipelineStatistics) / sizeof(std::uint64_t);
+        CreateReadbackBuffer();
+    }
+}
+
+VKQueryHeap::~VKQueryHeap()
+{
+    if (readbackData_ != nullptr)
+    {
+        readbackBuffer_.Unmap(device_);
+        readbackBuffer_.ReleaseMemoryRegion(readbackMemoryMngr_);
+    }
+}
+
+void VKQueryHeap::ResetQueries(std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    vkResetQueryPoolEXT(device_, queryPool_, firstQuery, numQueries);
+
+    /* Invalidate availability of results until they are copied again */
+    const std::uint32_t stride = numResultValues_ + 1;
+    for_range(i, numQueries)
+        readbackData_[(firstQuery + i) * stride + numResultValues_] = 0;
+}
+
+void VKQueryHeap::MarkQueriesUncached(std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    const std::uint32_t stride = numResultValues_ + 1;
+    for_range(i, numQueries)
+        readbackData_[(firstQuery + i) * stride + numResultValues_] = g_uncachedQueryAvailability;
+}
+
+void VKQueryHeap::CopyResults(VkCommandBuffer commandBuffer, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    /* Waiting for availability only stalls the device, since all of these queries have been ended before */
+    const VkDeviceSize stride = (numResultValues_ + 1) * sizeof(std::uint64_t);
+    vkCmdCopyQueryPoolResults(
+        commandBuffer,
+        GetVkQueryPool(),
+        firstQuery,
+        numQueries,
+        readbackBuffer_.GetVkBuffer(),
+        firstQuery * stride,
+        stride,
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+    );
+}
+
+VkResult VKQueryHeap::ReadCachedResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize) const
+{
+    /* Determine output format */
+    const bool isPipelineStats = (GetType() == QueryType::PipelineStatistics);
+    bool is64Bit = false;
+
+    if (dataSize == numQueries * (isPipelineStats ? sizeof(QueryPipelineStatistics) : sizeof(std::uint64_t)))
+        is64Bit = true;
+    else if (!isPipelineStats && dataSize == numQueries * sizeof(std::uint32_t))
+        is64Bit = false;
+    else
+        return VK_ERROR_VALIDATION_FAILED_EXT;
+
+    /* Query timestamps only as 64-bit values, since their 32-bit values would overflow */
+    if (GetType() == QueryType::Timestamp && !is64Bit)
+        return VK_ERROR_VALIDATION_FAILED_EXT;
+
+    /* Check availability of all native queries before any output is written */
+    const std::uint32_t stride          = numResultValues_ + 1;
+    const std::uint32_t firstNative     = firstQuery * groupSize_;
+    const std::uint32_t numNative       = numQueries * groupSize_;
+    const std::uint64_t* results        = readbackData_ + firstNative * stride;
+
+    for_range(i, numNative)
+    {
+        const std::uint64_t availability = results[i * stride + numResultValues_];
+        if (availability == g_uncachedQueryAvailability)
+            return VK_INCOMPLETE;
+        if (availability == 0)
+            return VK_NOT_READY;
+    }
+
+    if (isPipelineStats)
+    {
+        /* Copy statistics in the same order they are retrieved from the query pool */
+        auto dst = static_cast<std::uint64_t*>(data);
+        for_range(i, numQueries)
+        {
+            ::memcpy(dst, results + i * stride, numResultValues_ * sizeof(std::uint64_t));
+            dst += sizeof(QueryPipelineStatistics) / sizeof(std::uint64_t);
+        }
+        return VK_SUCCESS;
+    }
+
+    for_range(i, numQueries)
+    {
+        std::uint64_t value = 0;
+
+        if (GetType() == QueryType::TimeElapsed)
+        {
+            /* Get elapsed time from difference between start and end timestamps */
+            const std::uint64_t* timestamps = results + i * 2 * stride;
+            value = ConvertTimestamp(timestamps[stride] - timestamps[0]);
+        }
+        else if (GetType() == QueryType::Timestamp)
+            value = ConvertTimestamp(results[i * stride]);
+        else
+            value = results[i * stride];
+
+        if (is64Bit)
+            static_cast<std::uint64_t*>(data)[i] = value;
+        else
+            static_cast<std::uint32_t*>(data)[i] = static_cast<std::uint32_t>(value);
+    }
+
+    return VK_SUCCESS;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKQueryHeap::CreateReadbackBuffer()
+{
+    /* Create host-visible buffer that stores the results of all native queries with their availability */
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = numQueries_ * (numResultValues_ + 1) * sizeof(std::uint64_t);
+        createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    readbackBuffer_.CreateVkBufferAndMemoryRegion(
+        device_,
+        createInfo,
+        readbackMemoryMngr_,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    );
+
+    /* Keep buffer persistently mapped, so results can be read without calling into the driver */
+    if (void* mappedData = readbackBuffer_.Map(device_))
+    {
+        readbackData_ = static_cast<std::uint64_t*>(mappedData);
+        ::memset(readbackData_, 0, static_cast<std::size_t>(createInfo.size));
+    }
+}
+
+std::uint64_t VKQueryHeap::ConvertTimestamp(std::uint64_t ticks) const
+{
+    /* Convert timestamp from ticks to nanoseconds */
+    return static_cast<std::uint64_t>(static_cast<double>(ticks) * static_cast<double>(timestampPeriod_) + 0.5);
 }
 
 
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/QueryHeap.h>
+#include "../Buffer/VKDeviceBuffer.h"
 #include "../Vulkan.h"
 #include "../VKPtr.h"
 
@@ -18,13 +19,37 @@ namespace LLGL
 {
 
 
+class VKDeviceMemoryManager;
+
 // Base class for Vulkan query heaps (sub class: VKPredicateQueryHeap).
 class VKQueryHeap : public QueryHeap
 {
 
     public:
 
-        VKQueryHeap(VkDevice device, const QueryHeapDescriptor& desc);
+        VKQueryHeap(
+            VkDevice                    device,
+            VKDeviceMemoryManager&      deviceMemoryManager,
+            const QueryHeapDescriptor&  desc,
+            float                       timestampPeriod = 1.0f
+        );
+        ~VKQueryHeap();
+
+        // Resets the specified native queries on the host and invalidates their results in the readback buffer.
+        void ResetQueries(std::uint32_t firstQuery, std::uint32_t numQueries);
+
+        // Marks the specified native queries to be retrieved from the query pool, because their results cannot be copied into the readback buffer.
+        void MarkQueriesUncached(std::uint32_t firstQuery, std::uint32_t numQueries);
+
+        // Records a command to copy the results of the specified native queries into the readback buffer. All of these queries must have been ended before.
+        void CopyResults(VkCommandBuffer commandBuffer, std::uint32_t firstQuery, std::uint32_t numQueries);
+
+        /*
+        Reads the results of the specified queries from the readback buffer without calling into the driver.
+        Returns VK_NOT_READY if any of these results has not been copied yet,
+        or VK_INCOMPLETE if any of them must be retrieved from the query pool instead.
+        */
+        VkResult ReadCachedResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize) const;
 
         // Returns the Vulkan VkQueryPool object.
         inline VkQueryPool GetVkQueryPool() const
@@ -50,6 +75,18 @@ class VKQueryHeap : public QueryHeap
             return numQueries_;
         }
 
+        // Returns the number of nanoseconds per timestamp tick.
+        inline float GetTimestampPeriod() const
+        {
+            return timestampPeriod_;
+        }
+
+        // Returns true if query results are copied into a readback buffer. This requires VK_EXT_host_query_reset.
+        inline bool HasReadbackBuffer() const
+        {
+            return (readbackData_ != nullptr);
+        }
+
         // Returns true if this query heap has predicates for conditional rendering, i.e. it can be casted to <VKPredicateQueryHeap>.
         inline bool HasPredicates() const
         {
@@ -58,11 +95,24 @@ class VKQueryHeap : public QueryHeap
 
     private:
 
-        VKPtr<VkQueryPool>  queryPool_;
-        VkQueryControlFlags controlFlags_   = 0;
-        std::uint32_t       groupSize_      = 1;
-        std::uint32_t       numQueries_     = 0;
-        bool                hasPredicates_  = false;
+        void CreateReadbackBuffer();
+
+        std::uint64_t ConvertTimestamp(std::uint64_t ticks) const;
+
+    private:
+
+        VkDevice                device_             = VK_NULL_HANDLE;
+        VKPtr<VkQueryPool>      queryPool_;
+        VkQueryControlFlags     controlFlags_       = 0;
+        std::uint32_t           groupSize_          = 1;
+        std::uint32_t           numQueries_         = 0;
+        bool                    hasPredicates_      = false;
+        float                   timestampPeriod_    = 1.0f;     // Nanoseconds per timestamp tick
+
+        VKDeviceBuffer          readbackBuffer_;
+        VKDeviceMemoryManager&  readbackMemoryMngr_;
+        std::uint64_t*          readbackData_       = nullptr;  // Persistently mapped readback buffer; each native query stores its values followed by its availability
+        std::uint32_t           numResultValues_    = 1;        // Number of 64-bit values per native query
 
 };
 
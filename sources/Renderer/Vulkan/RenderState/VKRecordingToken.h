@@ -0,0 +1,46 @@
+/*
+ * VKRecordingToken.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_RECORDING_TOKEN_H
+#define LLGL_VK_RECORDING_TOKEN_H
+
+
+#include <atomic>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+/*
+Shared completion state of a single recording of a native Vulkan command buffer.
+Objects that are referenced by a recording keep a reference to its token and can be reused once the token has been completed,
+which happens when the command buffer has waited for its fence before it is recorded again.
+*/
+struct VKRecordingToken
+{
+    std::atomic<bool> completed { false };
+};
+
+using VKRecordingTokenPtr = std::shared_ptr<VKRecordingToken>;
+
+// Returns true if the specified recording token is null or has been completed.
+inline bool IsVKRecordingCompleted(const VKRecordingTokenPtr& token)
+{
+    return (!token || token->completed.load(std::memory_order_acquire));
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
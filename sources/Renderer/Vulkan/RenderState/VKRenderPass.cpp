@@ -8,10 +8,12 @@
 #include "VKRenderPass.h"
 #include "../VKCore.h"
 #include "../VKTypes.h"
+#include "../Ext/VKExtensionRegistry.h"
 #include "../../RenderPassUtils.h"
 #include "../../../Core/Assertion.h"
 #include <LLGL/Utils/ForRange.h>
 #include <limits>
+#include <algorithm>
 
 
 namespace LLGL
@@ -119,7 +121,7 @@ void VKRenderPass::CreateVkRenderPass(VkDevice device, const RenderPassDescripto
     }
 
     /* Create render pass with native attachment descriptors */
-    CreateVkRenderPassWithDescriptors(device, numAttachments, numColorAttachments, attachmentDescs, sampleCountBits);
+    CreateVkRenderPassWithDescriptors(device, numAttachments, numColorAttachments, attachmentDescs, sampleCountBits, desc.viewMask);
 }
 
 void VKRenderPass::CreateVkRenderPassWithDescriptors(
@@ -127,7 +129,8 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
     std::uint32_t                   numAttachments,
     std::uint32_t                   numColorAttachments,
     const VkAttachmentDescription*  attachmentDescs,
-    VkSampleCountFlagBits           sampleCountBits)
+    VkSampleCountFlagBits           sampleCountBits,
+    std::uint32_t                   viewMask)
 {
     LLGL_ASSERT(numAttachments <= LLGL_MAX_NUM_ATTACHMENTS);
     LLGL_ASSERT(numColorAttachments <= LLGL_MAX_NUM_COLOR_ATTACHMENTS);
@@ -140,13 +143,17 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
     /* Store sample count bits and number of color attachments (required for default blend states in VKGraphicsPipeline) */
     sampleCountBits_        = sampleCountBits;
     numColorAttachments_    = static_cast<std::uint8_t>(numColorAttachments);
+    viewMask_               = viewMask;
+
+    /* Store attachment descriptors to begin rendering and create pipelines without render pass object */
+    std::copy(attachmentDescs, attachmentDescs + numAttachments, attachmentDescs_);
 
     /* Build bitmask for clear values: least significant bit (LSB) is used for the first attachment */
     clearValuesMask_ = 0;
 
     for_range(i, numAttachments)
     {
-        if (attachmentDescs[i].loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR)
+        if (attachmentDescs[i].loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR || attachmentDescs[i].stencilLoadOp == VK_ATTACHMENT_LOAD_OP_CLEAR)
         {
             clearValuesMask_ |= (0x1ull << i);
             numClearValues_ = std::max(numClearValues_, static_cast<std::uint8_t>(i + 1));
@@ -168,6 +175,10 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
         depthStencilAttachmentRef.layout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
     }
 
+    /* Render pass object is not needed if render passes are recorded with VK_KHR_dynamic_rendering */
+    if (HasExtension(VKExt::KHR_dynamic_rendering))
+        return;
+
     const bool hasMultiSampling = (sampleCountBits > VK_SAMPLE_COUNT_1_BIT);
     if (hasMultiSampling)
     {
@@ -214,11 +225,24 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
         subpassDep.dependencyFlags  = 0;
     }
 
+    /* Broadcast the sub-pass to all views of the multiview mask; all views are correlated, since they are usually rendered from nearby viewpoints */
+    VkRenderPassMultiviewCreateInfoKHR multiviewInfo;
+    {
+        multiviewInfo.sType                 = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO_KHR;
+        multiviewInfo.pNext                 = nullptr;
+        multiviewInfo.subpassCount          = 1;
+        multiviewInfo.pViewMasks            = (&viewMask);
+        multiviewInfo.dependencyCount       = 0;
+        multiviewInfo.pViewOffsets          = nullptr;
+        multiviewInfo.correlationMaskCount  = 1;
+        multiviewInfo.pCorrelationMasks     = (&viewMask);
+    }
+
     /* Create swap-chain render pass */
     VkRenderPassCreateInfo createInfo;
     {
         createInfo.sType            = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        createInfo.pNext            = nullptr;
+        createInfo.pNext            = (viewMask != 0 ? &multiviewInfo : nullptr);
         createInfo.flags            = 0;
         createInfo.attachmentCount  = (hasMultiSampling ? numAttachments + numColorAttachments : numAttachments);
         createInfo.pAttachments     = attachmentDescs;
@@ -231,6 +255,21 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
     VKThrowIfFailed(result, "failed to create Vulkan render pass");
 }
 
+void VKRenderPass::AttachSecondaryCommandBuffer() const
+{
+    ++numSecondaryCmdBuffers_;
+}
+
+void VKRenderPass::DetachSecondaryCommandBuffer() const
+{
+    --numSecondaryCmdBuffers_;
+}
+
+bool VKRenderPass::HasSecondaryCommandBuffers() const
+{
+    return (numSecondaryCmdBuffers_ > 0);
+}
+
 
 } // /namespace LLGL
 
@@ -10,8 +10,10 @@
 
 
 #include <LLGL/RenderPass.h>
+#include <LLGL/StaticLimits.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
+#include <atomic>
 #include <cstdint>
 
 
@@ -40,10 +42,11 @@ class VKRenderPass final : public RenderPass
             std::uint32_t                   numAttachments,
             std::uint32_t                   numColorAttachments,
             const VkAttachmentDescription*  attachmentDescs,
-            VkSampleCountFlagBits           sampleCountBits
+            VkSampleCountFlagBits           sampleCountBits,
+            std::uint32_t                   viewMask            = 0
         );
 
-        // Returns the Vulkan render pass object.
+        // Returns the Vulkan render pass object. This is VK_NULL_HANDLE if VK_KHR_dynamic_rendering is used.
         inline VkRenderPass GetVkRenderPass() const
         {
             return renderPass_;
@@ -82,6 +85,28 @@ class VKRenderPass final : public RenderPass
             return sampleCountBits_;
         }
 
+        // Returns the multiview mask of this render pass or 0 if multiview rendering is disabled (see RenderPassDescriptor::viewMask).
+        inline std::uint32_t GetViewMask() const
+        {
+            return viewMask_;
+        }
+
+        // Returns the descriptor of the specified attachment: color attachments first, followed by the depth-stencil attachment.
+        inline const VkAttachmentDescription& GetAttachmentDesc(std::uint32_t index) const
+        {
+            return attachmentDescs_[index];
+        }
+
+        /*
+        Registers or unregisters a secondary command buffer that inherits this render pass (see CommandBufferDescriptor::renderPass).
+        These functions are const, since the inheritance state is not part of the render pass configuration.
+        */
+        void AttachSecondaryCommandBuffer() const;
+        void DetachSecondaryCommandBuffer() const;
+
+        // Returns true if any secondary command buffer inherits this render pass, i.e. its contents must be recorded with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS.
+        bool HasSecondaryCommandBuffers() const;
+
     private:
 
         VKPtr<VkRenderPass>     renderPass_;
@@ -91,6 +116,11 @@ class VKRenderPass final : public RenderPass
         std::uint8_t            numClearValues_         = 0;
         std::uint8_t            numColorAttachments_    = 0;
         VkSampleCountFlagBits   sampleCountBits_        = VK_SAMPLE_COUNT_1_BIT;
+        std::uint32_t           viewMask_               = 0;
+
+        VkAttachmentDescription attachmentDescs_[LLGL_MAX_NUM_ATTACHMENTS] = {}; // Load/store operations and formats for VK_KHR_dynamic_rendering
+
+        mutable std::atomic<std::uint32_t> numSecondaryCmdBuffers_ { 0 };
 
 };
 
@@ -10,6 +10,7 @@
 #include "VKDescriptorSetWriter.h"
 #include "VKPoolSizeAccumulator.h"
 #include "../Buffer/VKBuffer.h"
+#include "../Buffer/VKAccelerationStructure.h"
 #include "../Texture/VKSampler.h"
 #include "../Texture/VKTexture.h"
 #include "../VKTypes.h"
@@ -24,6 +25,7 @@
 #include <LLGL/ResourceHeapFlags.h>
 #include <LLGL/Utils/ForRange.h>
 #include <map>
+#include <algorithm>
 
 
 namespace LLGL
@@ -48,10 +50,19 @@ VKResourceHeap::VKResourceHeap(
     const auto numBindings      = static_cast<std::uint32_t>(bindings_.size());
     const auto numResourceViews = GetNumResourceViewsOrThrow(numBindings, desc, initialResourceViews);
 
-    /* Create descriptor pool and array of descriptor sets */
+    /* Create descriptor pool and array of descriptor sets with all their versions */
     const auto numDescriptorSets = (numResourceViews / numBindings);
-    CreateDescriptorPool(device, numDescriptorSets);
-    CreateDescriptorSets(device, numDescriptorSets, pipelineLayoutVK->GetSetLayoutForHeapBindings());
+    numDescriptorSets_  = numDescriptorSets;
+    numVersions_        = std::max(1u, desc.numVersions);
+    CreateDescriptorPool(device, numDescriptorSets * numVersions_);
+    CreateDescriptorSets(device, numDescriptorSets * numVersions_, pipelineLayoutVK->GetSetLayoutForHeapBindings());
+
+    if (IsVersioned())
+    {
+        currentVersions_.resize(numDescriptorSets, 0);
+        versionRecordings_.resize(numDescriptorSets * numVersions_);
+        writtenDescriptors_.resize(numDescriptorSets * numBindings, false);
+    }
 
     /* Allocate array for descriptor set barriers */
     if ((desc.barrierFlags & BarrierFlags::Storage) != 0)
@@ -64,7 +75,7 @@ VKResourceHeap::VKResourceHeap(
 
 std::uint32_t VKResourceHeap::GetNumDescriptorSets() const
 {
-    return static_cast<std::uint32_t>(descriptorSets_.size());
+    return numDescriptorSets_;
 }
 
 std::uint32_t VKResourceHeap::WriteResourceViews(
@@ -86,9 +97,19 @@ std::uint32_t VKResourceHeap::WriteResourceViews(
     if (firstDescriptor + resourceViews.size() > numDescriptors)
         return 0;
 
+    /* Versioned heaps can be written from multiple threads while they are bound on others, so the version states must be locked */
+    std::unique_lock<std::mutex> versionLock;
+    if (IsVersioned())
+    {
+        versionLock = std::unique_lock<std::mutex>{ mutex_ };
+        ReleaseRetiredImageViews();
+        PrepareDescriptorSetVersions(device, firstDescriptor, resourceViews);
+    }
+
     const auto numResourceViewWrites = static_cast<std::uint32_t>(resourceViews.size());
     VKDescriptorSetWriter setWriter{ numResourceViewWrites, numResourceViewWrites };
     VKDescriptorBarrierWriter barrierWriter;
+    bool updateWhilePending = true;
 
     for (const auto& desc : resourceViews)
     {
@@ -101,6 +122,9 @@ std::uint32_t VKResourceHeap::WriteResourceViews(
 
         auto descriptorSet = firstDescriptor / numBindings;
 
+        if ((binding.bindingFlags & VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT) == 0)
+            updateWhilePending = false;
+
         switch (binding.descriptorType)
         {
             case VK_DESCRIPTOR_TYPE_SAMPLER:
@@ -123,18 +147,30 @@ std::uint32_t VKResourceHeap::WriteResourceViews(
                 FillWriteDescriptorWithBufferRange(device, desc, descriptorSet, binding, setWriter, barrierWriter);
                 break;
 
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                FillWriteDescriptorWithAccelerationStructure(desc, descriptorSet, binding, setWriter);
+                break;
+
             default:
                 LLGL_TRAP("invalid descriptor type in Vulkan descriptor set: %s", IntToHex(static_cast<std::uint32_t>(binding.descriptorType)));
                 break;
         }
 
+        if (IsVersioned())
+            writtenDescriptors_[firstDescriptor] = true;
+
         ++firstDescriptor;
     }
 
     if (setWriter.GetNumWrites() > 0)
     {
-        /* All command buffers must have finished execution before any affected descriptor set can be updated */
-        vkDeviceWaitIdle(device);
+        /*
+        All command buffers must have finished execution before any affected descriptor set can be updated,
+        unless all affected bindings of a bindless heap allow updating descriptors that are not used by pending command buffers,
+        or the heap is versioned, in which case only versions that are not referenced by pending command buffers are written
+        */
+        if (!updateWhilePending && !IsVersioned())
+            vkDeviceWaitIdle(device);
         setWriter.UpdateDescriptorSets(device);
     }
 
@@ -151,8 +187,29 @@ std::uint32_t VKResourceHeap::WriteResourceViews(
     return setWriter.GetNumWrites();
 }
 
+VkDescriptorSet VKResourceHeap::AcquireDescriptorSet(std::uint32_t descriptorSet, const VKRecordingTokenPtr& recording)
+{
+    if (!(descriptorSet < numDescriptorSets_))
+        return VK_NULL_HANDLE;
+
+    if (IsVersioned())
+    {
+        /* Keep reference to recording, so this version is not rewritten while the command buffer is pending */
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        const std::size_t index = descriptorSet * numVersions_ + currentVersions_[descriptorSet];
+        versionRecordings_[index] = recording;
+        return descriptorSets_[index];
+    }
+
+    return descriptorSets_[descriptorSet];
+}
+
 void VKResourceHeap::SubmitPipelineBarrier(VkCommandBuffer commandBuffer, std::uint32_t descriptorSet)
 {
+    std::unique_lock<std::mutex> versionLock;
+    if (IsVersioned())
+        versionLock = std::unique_lock<std::mutex>{ mutex_ };
+
     if (descriptorSet < barriers_.size())
     {
         if (auto barrier = barriers_[descriptorSet].get())
@@ -163,6 +220,22 @@ void VKResourceHeap::SubmitPipelineBarrier(VkCommandBuffer commandBuffer, std::u
     }
 }
 
+void VKResourceHeap::InsertPipelineBarrier(VKBarrierAccumulator& accumulator, std::uint32_t descriptorSet)
+{
+    std::unique_lock<std::mutex> versionLock;
+    if (IsVersioned())
+        versionLock = std::unique_lock<std::mutex>{ mutex_ };
+
+    if (descriptorSet < barriers_.size())
+    {
+        if (auto barrier = barriers_[descriptorSet].get())
+        {
+            if (barrier->IsActive())
+                barrier->InsertInto(accumulator);
+        }
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -184,6 +257,10 @@ static VkPipelineStageFlags ToVkStageFlags(long stageFlags)
         bitmask |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     if ((stageFlags & StageFlags::ComputeStage) != 0)
         bitmask |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    if ((stageFlags & StageFlags::TaskStage) != 0)
+        bitmask |= VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT;
+    if ((stageFlags & StageFlags::MeshStage) != 0)
+        bitmask |= VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT;
 
     return bitmask;
 }
@@ -220,7 +297,9 @@ void VKResourceHeap::CopyLayoutBindings(const ArrayView<VKLayoutBinding>& layout
 void VKResourceHeap::CopyLayoutBinding(VKDescriptorBinding& dst, const VKLayoutBinding& src)
 {
     dst.dstBinding      = src.dstBinding;
+    dst.dstArrayElement = src.dstArrayElement;
     dst.descriptorType  = src.descriptorType;
+    dst.bindingFlags    = src.bindingFlags;
     dst.stageFlags      = ToVkStageFlags(src.stageFlags);
     dst.imageViewIndex  = (IsDescriptorTypeImageView(src.descriptorType) ? numImageViewsPerSet_++ : VKResourceHeap::invalidViewIndex);
     dst.bufferViewIndex = (IsDescriptorTypeBufferView(src.descriptorType) ? numBufferViewsPerSet_++ : VKResourceHeap::invalidViewIndex);
@@ -230,8 +309,14 @@ void VKResourceHeap::CreateDescriptorPool(VkDevice device, std::uint32_t numDesc
 {
     /* Accumulate descriptor pool sizes */
     VKPoolSizeAccumulator poolSizeAccum;
+    VkDescriptorPoolCreateFlags flags = 0;
+
     for (const auto& binding : bindings_)
+    {
         poolSizeAccum.Accumulate(binding.descriptorType, numDescriptorSets);
+        if ((binding.bindingFlags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT) != 0)
+            flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    }
     poolSizeAccum.Finalize();
 
     /* Create Vulkan descriptor pool */
@@ -239,7 +324,7 @@ void VKResourceHeap::CreateDescriptorPool(VkDevice device, std::uint32_t numDesc
     {
         poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         poolCreateInfo.pNext            = nullptr;
-        poolCreateInfo.flags            = 0;
+        poolCreateInfo.flags            = flags;
         poolCreateInfo.maxSets          = numDescriptorSets;
         poolCreateInfo.poolSizeCount    = poolSizeAccum.Size();
         poolCreateInfo.pPoolSizes       = poolSizeAccum.Data();
@@ -273,6 +358,153 @@ void VKResourceHeap::CreateDescriptorSets(
     VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
 }
 
+void VKResourceHeap::PrepareDescriptorSetVersions(
+    VkDevice                                    device,
+    std::uint32_t                               firstDescriptor,
+    const ArrayView<ResourceViewDescriptor>&    resourceViews)
+{
+    const auto numBindings      = static_cast<std::uint32_t>(bindings_.size());
+    const auto numWrites        = static_cast<std::uint32_t>(resourceViews.size());
+    const auto firstSet         = firstDescriptor / numBindings;
+    const auto lastSet          = (firstDescriptor + numWrites - 1) / numBindings;
+
+    VKDescriptorSetWriter copyWriter{ 0, 0, numBindings };
+    bool waitedIdle = false;
+
+    for_subrange(descriptorSet, firstSet, lastSet + 1)
+    {
+        /* Write into the current version directly if no pending recording refers to it */
+        const std::uint32_t currentVersion  = currentVersions_[descriptorSet];
+        const std::size_t   currentIndex    = descriptorSet * numVersions_ + currentVersion;
+
+        if (IsVKRecordingCompleted(versionRecordings_[currentIndex]))
+        {
+            versionRecordings_[currentIndex].reset();
+            continue;
+        }
+
+        /* Switch to a free version of this descriptor set */
+        std::uint32_t newVersion = FindFreeVersion(descriptorSet);
+        if (newVersion == VKResourceHeap::invalidVersion)
+        {
+            /*
+            All versions are pending, so wait for the GPU once and take the next version.
+            Recordings that have not been submitted yet will refer to overwritten descriptors just as with non-versioned heaps
+            */
+            if (!waitedIdle)
+            {
+                vkDeviceWaitIdle(device);
+                waitedIdle = true;
+            }
+            newVersion = (currentVersion + 1) % numVersions_;
+        }
+
+        const std::size_t newIndex = descriptorSet * numVersions_ + newVersion;
+        versionRecordings_[newIndex].reset();
+
+        /* Copy all descriptors into the new version that have been written before and are not overwritten now */
+        for_range(i, numBindings)
+        {
+            const std::uint32_t descriptor = descriptorSet * numBindings + i;
+            if (!writtenDescriptors_[descriptor])
+                continue;
+            if (descriptor >= firstDescriptor && descriptor < firstDescriptor + numWrites && resourceViews[descriptor - firstDescriptor].resource != nullptr)
+                continue;
+
+            const VKDescriptorBinding& binding = bindings_[i];
+            auto copyDesc = copyWriter.NextCopyDescriptor();
+            {
+                copyDesc->srcSet            = descriptorSets_[currentIndex];
+                copyDesc->srcBinding        = binding.dstBinding;
+                copyDesc->srcArrayElement   = binding.dstArrayElement;
+                copyDesc->dstSet            = descriptorSets_[newIndex];
+                copyDesc->dstBinding        = binding.dstBinding;
+                copyDesc->dstArrayElement   = binding.dstArrayElement;
+                copyDesc->descriptorCount   = 1;
+            }
+        }
+
+        currentVersions_[descriptorSet] = newVersion;
+    }
+
+    /* Copies must be performed before the new descriptors are written, since vkUpdateDescriptorSets performs all writes first */
+    copyWriter.UpdateDescriptorSets(device);
+}
+
+std::uint32_t VKResourceHeap::FindFreeVersion(std::uint32_t descriptorSet) const
+{
+    const std::uint32_t currentVersion = currentVersions_[descriptorSet];
+    for_subrange(i, 1u, numVersions_)
+    {
+        const std::uint32_t version = (currentVersion + i) % numVersions_;
+        if (IsVKRecordingCompleted(versionRecordings_[descriptorSet * numVersions_ + version]))
+            return version;
+    }
+    return VKResourceHeap::invalidVersion;
+}
+
+VkDescriptorSet VKResourceHeap::GetCurrentVkDescriptorSet(std::uint32_t descriptorSet) const
+{
+    if (IsVersioned())
+        return descriptorSets_[descriptorSet * numVersions_ + currentVersions_[descriptorSet]];
+    else
+        return descriptorSets_[descriptorSet];
+}
+
+void VKResourceHeap::ReleaseImageView(std::size_t imageViewIndex)
+{
+    if (!(imageViewIndex < imageViews_.size() && imageViews_[imageViewIndex]))
+        return;
+
+    if (IsVersioned())
+    {
+        /* Any version of this descriptor set might still refer to the image view, so gather all their pending recordings */
+        const std::size_t descriptorSet = imageViewIndex / numImageViewsPerSet_;
+
+        VKRetiredImageView retiredImageView;
+        for_range(version, numVersions_)
+        {
+            const VKRecordingTokenPtr& recording = versionRecordings_[descriptorSet * numVersions_ + version];
+            if (!IsVKRecordingCompleted(recording))
+                retiredImageView.pendingRecordings.push_back(recording);
+        }
+
+        if (!retiredImageView.pendingRecordings.empty())
+        {
+            retiredImageView.imageView = std::move(imageViews_[imageViewIndex]);
+            retiredImageViews_.push_back(std::move(retiredImageView));
+            return;
+        }
+    }
+
+    imageViews_[imageViewIndex].Release();
+}
+
+static bool AreVKRecordingsCompleted(const SmallVector<VKRecordingTokenPtr, 3>& recordings)
+{
+    for (const VKRecordingTokenPtr& recording : recordings)
+    {
+        if (!IsVKRecordingCompleted(recording))
+            return false;
+    }
+    return true;
+}
+
+void VKResourceHeap::ReleaseRetiredImageViews()
+{
+    retiredImageViews_.erase(
+        std::remove_if(
+            retiredImageViews_.begin(),
+            retiredImageViews_.end(),
+            [](const VKRetiredImageView& entry) -> bool
+            {
+                return AreVKRecordingsCompleted(entry.pendingRecordings);
+            }
+        ),
+        retiredImageViews_.end()
+    );
+}
+
 void VKResourceHeap::FillWriteDescriptorWithSampler(
     const ResourceViewDescriptor&   desc,
     std::uint32_t                   descriptorSet,
@@ -292,9 +524,9 @@ void VKResourceHeap::FillWriteDescriptorWithSampler(
     /* Initialize write descriptor */
     auto writeDesc = setWriter.NextWriteDescriptor();
     {
-        writeDesc->dstSet           = descriptorSets_[descriptorSet];
+        writeDesc->dstSet           = GetCurrentVkDescriptorSet(descriptorSet);
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = binding.dstArrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = imageInfo;
@@ -324,9 +556,9 @@ void VKResourceHeap::FillWriteDescriptorWithImageView(
     /* Initialize write descriptor */
     auto writeDesc = setWriter.NextWriteDescriptor();
     {
-        writeDesc->dstSet           = descriptorSets_[descriptorSet];
+        writeDesc->dstSet           = GetCurrentVkDescriptorSet(descriptorSet);
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = binding.dstArrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = imageInfo;
@@ -364,9 +596,9 @@ void VKResourceHeap::FillWriteDescriptorWithBufferRange(
     /* Initialize write descriptor */
     auto writeDesc = setWriter.NextWriteDescriptor();
     {
-        writeDesc->dstSet           = descriptorSets_[descriptorSet];
+        writeDesc->dstSet           = GetCurrentVkDescriptorSet(descriptorSet);
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = binding.dstArrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = nullptr;
@@ -382,14 +614,42 @@ void VKResourceHeap::FillWriteDescriptorWithBufferRange(
     }
 }
 
+void VKResourceHeap::FillWriteDescriptorWithAccelerationStructure(
+    const ResourceViewDescriptor&   desc,
+    std::uint32_t                   descriptorSet,
+    const VKDescriptorBinding&      binding,
+    VKDescriptorSetWriter&          setWriter)
+{
+    auto accelStructVK = LLGL_CAST(VKAccelerationStructure*, desc.resource);
+
+    /* Initialize acceleration structure information, which is chained into the write descriptor */
+    auto accelStructInfo = setWriter.NextAccelerationStructureInfo(accelStructVK->GetVkAccelerationStructure());
+
+    /* Initialize write descriptor */
+    auto writeDesc = setWriter.NextWriteDescriptor();
+    {
+        writeDesc->pNext            = accelStructInfo;
+        writeDesc->dstSet           = GetCurrentVkDescriptorSet(descriptorSet);
+        writeDesc->dstBinding       = binding.dstBinding;
+        writeDesc->dstArrayElement  = binding.dstArrayElement;
+        writeDesc->descriptorCount  = 1;
+        writeDesc->descriptorType   = binding.descriptorType;
+        writeDesc->pImageInfo       = nullptr;
+        writeDesc->pBufferInfo      = nullptr;
+        writeDesc->pTexelBufferView = nullptr;
+    }
+}
+
 bool VKResourceHeap::ExchangeBufferBarrier(std::uint32_t descriptorSet, Buffer* resource, const VKDescriptorBinding& binding)
 {
     if (descriptorSet < barriers_.size())
     {
+        /* Use binding index as barrier slot, since array elements of bindless heaps share the same binding point */
+        const auto slot = static_cast<std::uint32_t>(&binding - bindings_.data());
         if ((resource->GetBindFlags() & BindFlags::Storage) != 0)
-            return EmplaceBarrier(descriptorSet, binding.dstBinding, resource, binding.stageFlags);
+            return EmplaceBarrier(descriptorSet, slot, resource, binding.stageFlags);
         else
-            return RemoveBarrier(descriptorSet, binding.dstBinding);
+            return RemoveBarrier(descriptorSet, slot);
     }
     return false;
 }
@@ -432,8 +692,7 @@ VkImageView VKResourceHeap::GetOrCreateImageView(
         textureVK.CreateImageView(device, desc.textureView, imageView);
 
         /* Remove previous image view entry */
-        if (imageViewIndex < imageViews_.size() && imageViews_[imageViewIndex])
-            imageViews_[imageViewIndex].Release();
+        ReleaseImageView(imageViewIndex);
 
         /* Increase image view container for new entry */
         if (imageViewIndex >= imageViews_.size())
@@ -446,8 +705,7 @@ VkImageView VKResourceHeap::GetOrCreateImageView(
     else
     {
         /* Remove previous image view entry */
-        if (imageViewIndex < imageViews_.size() && imageViews_[imageViewIndex])
-            imageViews_[imageViewIndex].Release();
+        ReleaseImageView(imageViewIndex);
 
         /* Returns the standard image view */
         return textureVK.GetVkImageView();
@@ -14,9 +14,11 @@
 #include <LLGL/Container/SmallVector.h>
 #include "VKPipelineBarrier.h"
 #include "VKPipelineLayout.h"
+#include "VKRecordingToken.h"
 #include "../Vulkan.h"
 #include "../VKPtr.h"
 #include <vector>
+#include <mutex>
 
 
 namespace LLGL
@@ -27,6 +29,7 @@ class Buffer;
 class VKBuffer;
 class VKTexture;
 class VKDescriptorSetWriter;
+class VKBarrierAccumulator;
 struct ResourceHeapDescriptor;
 struct ResourceViewDescriptor;
 struct TextureViewDescriptor;
@@ -55,29 +58,35 @@ class VKResourceHeap final : public ResourceHeap
         // Inserts a pipeline barrier command into the command buffer if this resource heap requires it.
         void SubmitPipelineBarrier(VkCommandBuffer commandBuffer, std::uint32_t descriptorSet);
 
+        // Inserts the pipeline barrier of this resource heap into the barrier accumulator if this resource heap requires it.
+        void InsertPipelineBarrier(VKBarrierAccumulator& accumulator, std::uint32_t descriptorSet);
+
         // Returns the native Vulkan descritpor pool.
         inline VkDescriptorPool GetVkDescriptorPool() const
         {
             return descriptorPool_.Get();
         }
 
-        // Returns the list of native Vulkan descriptor sets.
-        inline const std::vector<VkDescriptorSet>& GetVkDescriptorSets() const
-        {
-            return descriptorSets_;
-        }
+        /*
+        Returns the native Vulkan descriptor set for the current version of the specified descriptor set or VK_NULL_HANDLE if it is out of bounds.
+        For versioned resource heaps, the version keeps a reference to the specified recording and is not rewritten until that recording has completed.
+        */
+        VkDescriptorSet AcquireDescriptorSet(std::uint32_t descriptorSet, const VKRecordingTokenPtr& recording);
 
     private:
 
-        static constexpr std::uint32_t invalidViewIndex = 0xFFFF;
+        static constexpr std::uint32_t invalidViewIndex = 0xFFFFFFFF;
+        static constexpr std::uint32_t invalidVersion   = 0xFFFFFFFF;
 
         struct VKDescriptorBinding
         {
-            std::uint32_t           dstBinding;
-            VkDescriptorType        descriptorType;
-            VkPipelineStageFlags    stageFlags;
-            std::uint32_t           imageViewIndex  : 16; // Index (per descriptor set) to the intermediate VkImageView or 0xFFFF if unused.
-            std::uint32_t           bufferViewIndex : 16; // Index (per descriptor set) to the intermediate VkBufferView or 0xFFFF if unused.
+            std::uint32_t               dstBinding;
+            std::uint32_t               dstArrayElement;
+            VkDescriptorType            descriptorType;
+            VkDescriptorBindingFlagsEXT bindingFlags;
+            VkPipelineStageFlags        stageFlags;
+            std::uint32_t               imageViewIndex;     // Index (per descriptor set) to the intermediate VkImageView or 0xFFFFFFFF if unused.
+            std::uint32_t               bufferViewIndex;    // Index (per descriptor set) to the intermediate VkBufferView or 0xFFFFFFFF if unused.
         };
 
         struct VKDescriptorBarrierWriter
@@ -85,6 +94,13 @@ class VKResourceHeap final : public ResourceHeap
             std::uint32_t barrierChangeRanges[2] = {};
         };
 
+        // Image view that was replaced while a pending recording might still refer to it.
+        struct VKRetiredImageView
+        {
+            VKPtr<VkImageView>                  imageView;
+            SmallVector<VKRecordingTokenPtr, 3> pendingRecordings;
+        };
+
     private:
 
         void CopyLayoutBindings(const ArrayView<VKLayoutBinding>& layoutBindings);
@@ -98,6 +114,30 @@ class VKResourceHeap final : public ResourceHeap
             VkDescriptorSetLayout   globalSetLayout
         );
 
+        // Switches each descriptor set in the specified range that is referenced by a pending recording to a free version and copies all descriptors that are not overwritten.
+        void PrepareDescriptorSetVersions(
+            VkDevice                                    device,
+            std::uint32_t                               firstDescriptor,
+            const ArrayView<ResourceViewDescriptor>&    resourceViews
+        );
+
+        // Returns a version of the specified descriptor set that is not referenced by any pending recording or invalidVersion if there is none.
+        std::uint32_t FindFreeVersion(std::uint32_t descriptorSet) const;
+
+        // Returns the native descriptor set of the current version of the specified descriptor set.
+        VkDescriptorSet GetCurrentVkDescriptorSet(std::uint32_t descriptorSet) const;
+
+        // Releases the specified image view or retires it if a pending recording might still refer to it.
+        void ReleaseImageView(std::size_t imageViewIndex);
+
+        // Releases all retired image views whose recordings have completed.
+        void ReleaseRetiredImageViews();
+
+        inline bool IsVersioned() const
+        {
+            return (numVersions_ > 1);
+        }
+
         void FillWriteDescriptorWithSampler(
             const ResourceViewDescriptor&   desc,
             std::uint32_t                   descriptorSet,
@@ -122,6 +162,13 @@ class VKResourceHeap final : public ResourceHeap
             VKDescriptorBarrierWriter&      barrierWriter
         );
 
+        void FillWriteDescriptorWithAccelerationStructure(
+            const ResourceViewDescriptor&   desc,
+            std::uint32_t                   descriptorSet,
+            const VKDescriptorBinding&      binding,
+            VKDescriptorSetWriter&          setWriter
+        );
+
         bool ExchangeBufferBarrier(std::uint32_t descriptorSet, Buffer* resource, const VKDescriptorBinding& binding);
         bool EmplaceBarrier(std::uint32_t descriptorSet, std::uint32_t slot, Resource* resource, VkPipelineStageFlags stageFlags);
         bool RemoveBarrier(std::uint32_t descriptorSet, std::uint32_t slot);
@@ -137,8 +184,10 @@ class VKResourceHeap final : public ResourceHeap
     private:
 
         VKPtr<VkDescriptorPool>             descriptorPool_;
-        std::vector<VkDescriptorSet>        descriptorSets_;
+        std::vector<VkDescriptorSet>        descriptorSets_;                // Native descriptor sets; all versions of the same descriptor set are consecutive.
         SmallVector<VKDescriptorBinding>    bindings_;
+        std::uint32_t                       numDescriptorSets_      = 0;
+        std::uint32_t                       numVersions_            = 1;
 
         std::vector<VKPtr<VkImageView>>     imageViews_;
       //std::vector<VKPtr<VkBufferView>>    bufferViews_;
@@ -147,6 +196,12 @@ class VKResourceHeap final : public ResourceHeap
 
         std::vector<VKPipelineBarrierPtr>   barriers_;
 
+        std::vector<std::uint32_t>          currentVersions_;               // Current version of each descriptor set. Only used for versioned heaps.
+        std::vector<VKRecordingTokenPtr>    versionRecordings_;             // Last recording that refers to each native descriptor set. Only used for versioned heaps.
+        std::vector<bool>                   writtenDescriptors_;            // Descriptors that must be copied into a new version. Only used for versioned heaps.
+        std::vector<VKRetiredImageView>     retiredImageViews_;
+        std::mutex                          mutex_;                         // Guards all version states, since versioned heaps can be written from multiple threads.
+
 };
 
 
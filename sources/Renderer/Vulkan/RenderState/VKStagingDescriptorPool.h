@@ -11,6 +11,7 @@
 
 #include "../Vulkan.h"
 #include "../VKPtr.h"
+#include "../VKStaticLimits.h"
 #include <vector>
 #include <cstdint>
 
@@ -26,7 +27,7 @@ class VKStagingDescriptorPool
     public:
 
         // Number of descriptor types.
-        static constexpr int numDescriptorTypes = (static_cast<int>(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT) + 1);
+        static constexpr int numDescriptorTypes = static_cast<int>(LLGL_VK_NUM_DESCRIPTOR_TYPES);
 
     public:
 
@@ -6,6 +6,7 @@
  */
 
 #include "VKStagingDescriptorSetPool.h"
+#include "../VKCore.h"
 #include <LLGL/Utils/ForRange.h>
 #include <algorithm>
 
@@ -14,19 +15,37 @@ namespace LLGL
 {
 
 
-VKStagingDescriptorSetPool::VKStagingDescriptorSetPool(VkDevice device) :
-    device_ { device }
+constexpr std::uint32_t VKStagingDescriptorSetPool::numUsageHistoryFrames;
+
+VKStagingDescriptorSetPool::VKStagingDescriptorSetPool(VkDevice device, std::uint32_t minCapacity) :
+    device_         { device                    },
+    minCapacity_    { std::max(1u, minCapacity) }
 {
 }
 
 void VKStagingDescriptorSetPool::Reset()
 {
-    if (!descriptorPools_.empty())
+    /* Store descriptor usage of the previous recording in the history */
+    usageHistory_[usageHistoryIndex_] = currentUsage_;
+    usageHistoryIndex_ = (usageHistoryIndex_ + 1) % VKStagingDescriptorSetPool::numUsageHistoryFrames;
+    currentUsage_ = DescriptorUsage{};
+
+    if (descriptorPools_.empty())
+        return;
+
+    const DescriptorUsage highWaterMark = GetHighWaterMark();
+    if (IsResizeRequired(highWaterMark))
+    {
+        /* Replace all descriptor pools by a single one that fits the recent recordings, so subsequent recordings don't need new pools */
+        descriptorPools_.clear();
+        AllocateDescriptorPool(highWaterMark);
+    }
+    else
     {
         for_range(i, descriptorPoolIndex_ + 1)
             descriptorPools_[i].Reset();
-        descriptorPoolIndex_ = 0;
     }
+    descriptorPoolIndex_ = 0;
 }
 
 VkDescriptorSet VKStagingDescriptorSetPool::AllocateDescriptorSet(
@@ -34,18 +53,14 @@ VkDescriptorSet VKStagingDescriptorSetPool::AllocateDescriptorSet(
     std::uint32_t               numSizes,
     const VkDescriptorPoolSize* sizes)
 {
-    if (descriptorPools_.empty())
-    {
-        /* Allocate initial descriptor pool */
-        AllocateDescriptorPool();
-    }
-    else if (!descriptorPools_[descriptorPoolIndex_].Capacity(numSizes, sizes))
-    {
-        /* Move to next descriptor pool and allocate new one as needed */
-        ++descriptorPoolIndex_;
-        if (descriptorPoolIndex_ == descriptorPools_.size())
-            AllocateDescriptorPool();
-    }
+    if (descriptorPools_.empty() || !descriptorPools_[descriptorPoolIndex_].Capacity(numSizes, sizes))
+        SelectDescriptorPool(numSizes, sizes);
+
+    /* Track descriptor usage of the current recording */
+    ++currentUsage_.numSets;
+    for_range(i, numSizes)
+        currentUsage_.numDescriptors[VKDescriptorTypeToIndex(sizes[i].type)] += sizes[i].descriptorCount;
+
     return descriptorPools_[descriptorPoolIndex_].AllocateDescriptorSet(setLayout, numSizes, sizes);
 }
 
@@ -54,35 +69,118 @@ VkDescriptorSet VKStagingDescriptorSetPool::AllocateDescriptorSet(
  * ======= Private: =======
  */
 
-static std::uint32_t GetDescriptorSetCapacity(std::uint32_t level)
+// Descriptor types that are commonly used by resource heaps and pipeline layouts; descriptor pools always provide a minimal capacity for them.
+static const VkDescriptorType g_commonDescriptorTypes[] =
+{
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+// Returns the capacity for the specified demand with 50% headroom.
+static std::uint32_t GetCapacityWithHeadroom(std::uint32_t demand, std::uint32_t minCapacity)
 {
-    constexpr std::uint32_t initialCapacity = 256;
-    return (initialCapacity << std::min(level, 5u));
+    return (demand > 0 ? std::max(demand + demand / 2, minCapacity) : 0);
 }
 
-static std::uint32_t GetDescriptorPoolCapacity(std::uint32_t level)
+void VKStagingDescriptorSetPool::SelectDescriptorPool(std::uint32_t numSizes, const VkDescriptorPoolSize* sizes)
 {
-    constexpr std::uint32_t initialCapacity = 1024;
-    return (initialCapacity << std::min(level, 5u));
+    /* Move to next free descriptor pool that fits the descriptor set */
+    while (descriptorPoolIndex_ + 1 < descriptorPools_.size())
+    {
+        ++descriptorPoolIndex_;
+        if (descriptorPools_[descriptorPoolIndex_].Capacity(numSizes, sizes))
+            return;
+    }
+
+    /* Allocate new descriptor pool that fits the entire demand of the current recording, i.e. the current usage including this descriptor set */
+    DescriptorUsage demand = GetHighWaterMark();
+    {
+        demand.numSets = std::max(demand.numSets, currentUsage_.numSets + 1);
+        for_range(i, VKStagingDescriptorPool::numDescriptorTypes)
+            demand.numDescriptors[i] = std::max(demand.numDescriptors[i], currentUsage_.numDescriptors[i]);
+        for_range(i, numSizes)
+        {
+            const std::uint32_t typeIndex = VKDescriptorTypeToIndex(sizes[i].type);
+            demand.numDescriptors[typeIndex] = std::max(demand.numDescriptors[typeIndex], currentUsage_.numDescriptors[typeIndex] + sizes[i].descriptorCount);
+        }
+    }
+    AllocateDescriptorPool(demand);
+    descriptorPoolIndex_ = descriptorPools_.size() - 1;
 }
 
-void VKStagingDescriptorSetPool::AllocateDescriptorPool()
+void VKStagingDescriptorSetPool::AllocateDescriptorPool(const DescriptorUsage& demand)
 {
-    const std::uint32_t descriptorPoolSize = GetDescriptorPoolCapacity(capacityLevel_);
-    const VkDescriptorPoolSize poolSizes[] =
+    /* Determine capacity with headroom for each descriptor type */
+    DescriptorUsage capacity;
+    {
+        capacity.numSets = std::max(GetCapacityWithHeadroom(demand.numSets, minCapacity_), minCapacity_);
+        for_range(i, VKStagingDescriptorPool::numDescriptorTypes)
+            capacity.numDescriptors[i] = GetCapacityWithHeadroom(demand.numDescriptors[i], minCapacity_);
+        for (VkDescriptorType type : g_commonDescriptorTypes)
+            capacity.numDescriptors[VKDescriptorTypeToIndex(type)] = std::max(capacity.numDescriptors[VKDescriptorTypeToIndex(type)], minCapacity_);
+    }
+
+    /* Only declare pool sizes for descriptor types that are actually used */
+    VkDescriptorPoolSize poolSizes[VKStagingDescriptorPool::numDescriptorTypes];
+    std::uint32_t numPoolSizes = 0;
+
+    for_range(i, VKStagingDescriptorPool::numDescriptorTypes)
     {
-        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_SAMPLER,        descriptorPoolSize },
-        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,  descriptorPoolSize },
-        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  descriptorPoolSize },
-        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, descriptorPoolSize },
-        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, descriptorPoolSize },
-    };
-    const std::uint32_t setCapacity = GetDescriptorSetCapacity(capacityLevel_);
+        if (capacity.numDescriptors[i] > 0)
+            poolSizes[numPoolSizes++] = VkDescriptorPoolSize{ VKIndexToDescriptorType(i), capacity.numDescriptors[i] };
+    }
+
     descriptorPools_.emplace_back(device_);
-    descriptorPools_.back().Initialize(setCapacity, sizeof(poolSizes)/sizeof(poolSizes[0]), poolSizes);
-    ++capacityLevel_;
+    descriptorPools_.back().Initialize(capacity.numSets, numPoolSizes, poolSizes);
+
+    /* Remember capacity of the first descriptor pool to decide when it must be resized */
+    if (descriptorPools_.size() == 1)
+        poolCapacity_ = capacity;
+}
+
+VKStagingDescriptorSetPool::DescriptorUsage VKStagingDescriptorSetPool::GetHighWaterMark() const
+{
+    DescriptorUsage highWaterMark;
+
+    for (const DescriptorUsage& usage : usageHistory_)
+    {
+        highWaterMark.numSets = std::max(highWaterMark.numSets, usage.numSets);
+        for_range(i, VKStagingDescriptorPool::numDescriptorTypes)
+            highWaterMark.numDescriptors[i] = std::max(highWaterMark.numDescriptors[i], usage.numDescriptors[i]);
+    }
+
+    return highWaterMark;
 }
 
+bool VKStagingDescriptorSetPool::IsResizeRequired(const DescriptorUsage& highWaterMark) const
+{
+    /* Grow if any recent recording didn't fit into the first pool */
+    if (highWaterMark.numSets > poolCapacity_.numSets)
+        return true;
+
+    for_range(i, VKStagingDescriptorPool::numDescriptorTypes)
+    {
+        if (highWaterMark.numDescriptors[i] > poolCapacity_.numDescriptors[i])
+            return true;
+    }
+
+    /* Shrink only if the first pool exceeds the high-water mark by far, to avoid re-creating pools for small fluctuations */
+    constexpr std::uint32_t shrinkFactor = 4;
+
+    if (poolCapacity_.numSets < highWaterMark.numSets * shrinkFactor || poolCapacity_.numSets <= minCapacity_)
+        return false;
+
+    for_range(i, VKStagingDescriptorPool::numDescriptorTypes)
+    {
+        if (poolCapacity_.numDescriptors[i] > minCapacity_ && poolCapacity_.numDescriptors[i] < highWaterMark.numDescriptors[i] * shrinkFactor)
+            return false;
+    }
+
+    return true;
+}
 
 
 } // /namespace LLGL
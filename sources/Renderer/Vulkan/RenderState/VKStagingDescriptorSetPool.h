@@ -17,15 +17,29 @@ namespace LLGL
 {
 
 
-// Pool of Vulkan staging descriptor sets.
+/*
+Pool of Vulkan staging descriptor sets for a single native command buffer.
+The descriptor pools are sized to the high-water marks of the descriptor usage over recent recordings,
+so steady-state recordings allocate all descriptor sets from one descriptor pool that is re-used after each reset.
+*/
 class VKStagingDescriptorSetPool
 {
 
     public:
 
-        VKStagingDescriptorSetPool(VkDevice device);
+        // Number of recordings whose descriptor usage determines the size of the descriptor pools.
+        static constexpr std::uint32_t numUsageHistoryFrames = 16;
+
+    public:
+
+        // Initializes the pool with the minimal number of descriptor sets and descriptors per type of each descriptor pool (see VendorTuningProfile::descriptorPoolCapacity).
+        VKStagingDescriptorSetPool(VkDevice device, std::uint32_t minCapacity);
 
-        // Resets all chunks in the pool.
+        /*
+        Resets all descriptor pools and records the descriptor usage of the previous recording.
+        If the descriptor pools don't match the high-water marks of recent recordings, they are replaced by a single descriptor pool that does.
+        This must only be called when the previous recording of the command buffer has been completed by the GPU.
+        */
         void Reset();
 
         // Copies the specified source descriptors into the native D3D descriptor heap.
@@ -37,15 +51,38 @@ class VKStagingDescriptorSetPool
 
     private:
 
-        // Allocates a new descriptor pool with increased capacity.
-        void AllocateDescriptorPool();
+        // Number of descriptor sets and descriptors per type.
+        struct DescriptorUsage
+        {
+            std::uint32_t numSets                                                       = 0;
+            std::uint32_t numDescriptors[VKStagingDescriptorPool::numDescriptorTypes]   = {};
+        };
 
     private:
 
-        VkDevice                                device_                 = VK_NULL_HANDLE;
-        std::vector<VKStagingDescriptorPool>    descriptorPools_;
-        std::size_t                             descriptorPoolIndex_    = 0;
-        std::uint32_t                           capacityLevel_          = 0;
+        // Moves to the next free descriptor pool that can allocate the specified descriptor set or allocates a new one.
+        void SelectDescriptorPool(std::uint32_t numSizes, const VkDescriptorPoolSize* sizes);
+
+        // Allocates a new descriptor pool that fits the specified demand with some headroom and appends it to the list of descriptor pools.
+        void AllocateDescriptorPool(const DescriptorUsage& demand);
+
+        // Returns the maximum descriptor usage over all recordings in the usage history.
+        DescriptorUsage GetHighWaterMark() const;
+
+        // Returns true if the capacity of the first descriptor pool doesn't fit the specified high-water mark or exceeds it by far.
+        bool IsResizeRequired(const DescriptorUsage& highWaterMark) const;
+
+    private:
+
+        VkDevice                                device_                                     = VK_NULL_HANDLE;
+        std::uint32_t                           minCapacity_                                = 0;
+        std::vector<VKStagingDescriptorPool>    descriptorPools_;                                           // Pools after the current index are reset and free for re-use
+        std::size_t                             descriptorPoolIndex_                        = 0;
+        DescriptorUsage                         poolCapacity_;                                              // Capacity of the first descriptor pool
+
+        DescriptorUsage                         currentUsage_;
+        DescriptorUsage                         usageHistory_[numUsageHistoryFrames];
+        std::uint32_t                           usageHistoryIndex_                          = 0;
 
 };
 
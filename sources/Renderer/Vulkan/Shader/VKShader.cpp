@@ -7,6 +7,7 @@
 
 #include "VKShader.h"
 #include "VKShaderModulePool.h"
+#include "../RenderState/VKPipelinePool.h"
 #include "../VKCore.h"
 #include "../VKTypes.h"
 #include "../../../Core/CoreUtils.h"
@@ -20,6 +21,7 @@
 
 #ifdef LLGL_ENABLE_SPIRV_REFLECT
 #   include "../../SPIRV/SpirvReflect.h"
+#   include "../../SPIRV/SpirvStrip.h"
 #endif
 
 
@@ -56,6 +58,7 @@ VKShader::VKShader(VkDevice device, const ShaderDescriptor& desc) :
 VKShader::~VKShader()
 {
     VKShaderModulePool::Get().NotifyReleaseShader(this);
+    VKPipelinePool::Get().NotifyReleaseObject(this);
 }
 
 const Report* VKShader::GetReport() const
@@ -121,13 +124,13 @@ bool VKShader::NeedsShaderModulePermutation(const PermutationBindingFunc& permut
     return false;
 }
 
-VKPtr<VkShaderModule> VKShader::CreateVkShaderModulePermutation(const PermutationBindingFunc& permutationBindingFunc)
+bool VKShader::PermuteBindingLayout(const PermutationBindingFunc& permutationBindingFunc, VKShaderBindingLayout& outBindingLayout) const
 {
     if (!permutationBindingFunc)
-        return VK_NULL_HANDLE;
+        return false;
 
     /* Re-assign binding slots with a permutation of the binding layout */
-    auto bindingLayoutPerm = bindingLayout_;
+    outBindingLayout = bindingLayout_;
 
     ConstFieldRangeIterator<BindingSlot> bindingSlotIter;
     std::uint32_t dstSet;
@@ -135,19 +138,18 @@ VKPtr<VkShaderModule> VKShader::CreateVkShaderModulePermutation(const Permutatio
 
     for (unsigned index = 0; permutationBindingFunc(index, bindingSlotIter, dstSet); ++index)
     {
-        if (bindingLayoutPerm.AssignBindingSlots(bindingSlotIter, dstSet) > 0)
+        if (outBindingLayout.AssignBindingSlots(bindingSlotIter, dstSet) > 0)
             modified = true;
     }
 
-    /* Create shader module permuation if there is at least one modified binding slot */
-    if (modified)
-    {
-        auto shaderCodePerm = shaderCode_;
-        bindingLayoutPerm.UpdateSpirvModule(shaderCodePerm.data(), shaderCodePerm.size() * sizeof(std::uint32_t));
-        return CreateVkShaderModule(device_, shaderCodePerm);
-    }
+    return modified;
+}
 
-    return VK_NULL_HANDLE;
+VKPtr<VkShaderModule> VKShader::CreateVkShaderModulePermutation(const VKShaderBindingLayout& bindingLayout) const
+{
+    auto shaderCodePerm = shaderCode_;
+    bindingLayout.UpdateSpirvModule(shaderCodePerm.data(), shaderCodePerm.size() * sizeof(std::uint32_t));
+    return CreateVkShaderModuleFromCode(shaderCodePerm);
 }
 
 static const char* GetOptString(const char* s)
@@ -165,6 +167,8 @@ static long ShaderTypeToStageFlags(const ShaderType type)
         case ShaderType::Geometry:          return StageFlags::GeometryStage;
         case ShaderType::Fragment:          return StageFlags::FragmentStage;
         case ShaderType::Compute:           return StageFlags::ComputeStage;
+        case ShaderType::Task:              return StageFlags::TaskStage;
+        case ShaderType::Mesh:              return StageFlags::MeshStage;
         default:                            return 0;
     }
 }
@@ -380,63 +384,14 @@ static ShaderResourceReflection* FindOrAppendShaderResource(ShaderReflection& re
 
 bool VKShader::Reflect(ShaderReflection& reflection) const
 {
-    /* Parse shader module */
-    SpirvReflect spvReflect;
-    if (spvReflect.Reflect(SpirvModuleView{ shaderCode_ }) != SpirvResult::NoError)
-        return false;
+    std::lock_guard<std::mutex> guard{ reflectionCache_.mutex };
+    BuildReflectionCache();
 
-    /* Gather input/output attributes */
-    for (const auto& it : spvReflect.GetVaryings())
-    {
-        const auto& var = it.second;
-        if (GetType() == ShaderType::Vertex)
-        {
-            std::uint32_t numVectors = 1;
-
-            /* Determine vertex attribute data */
-            VertexAttribute attrib;
-            {
-                attrib.name         = GetOptString(var.name);
-                attrib.format       = SpvTypeToFormat(var.type, &numVectors);
-                attrib.location     = var.location;
-                attrib.systemValue  = SpvBuiltinToSystemValue(var.builtin);
-            }
-
-            /* Append vertex attributes for each semantic index */
-            for_range(i, numVectors)
-            {
-                attrib.semanticIndex = i;
-                if (var.input)
-                    reflection.vertex.inputAttribs.push_back(attrib);
-                else
-                    reflection.vertex.outputAttribs.push_back(attrib);
-            }
-        }
-        else if (GetType() == ShaderType::Fragment && !var.input)
-        {
-            /* Determine and append fragment attribute data */
-            FragmentAttribute attrib;
-            {
-                attrib.name         = GetOptString(var.name);
-                attrib.format       = SpvTypeToFormat(var.type);
-                attrib.location     = var.location;
-                attrib.systemValue  = SpvBuiltinToFragmentOutputSV(var.builtin);
-            }
-            reflection.fragment.outputAttribs.push_back(attrib);
-        }
-    }
-
-    /* Gather shader resources */
-    for (const auto& it : spvReflect.GetUniforms())
-    {
-        const auto& var = it.second;
-        if (auto resource = FindOrAppendShaderResource(reflection, var))
-            resource->binding.stageFlags |= ShaderTypeToStageFlags(GetType());
-    }
-
-    /* Gather push constants */
-    //TODO
+    /* Return copy of cached reflection */
+    if (!reflectionCache_.reflectionValid)
+        return false;
 
+    reflection = reflectionCache_.reflection;
     return true;
 }
 
@@ -445,11 +400,11 @@ bool VKShader::ReflectLocalSize(Extent3D& outLocalSize) const
     if (GetType() != ShaderType::Compute)
         return false;
 
-    /* Parse shader module for execution mode */
-    SpirvReflect::SpvExecutionMode executionMode;
-    SpirvReflectExecutionMode(SpirvModuleView{ shaderCode_ }, executionMode);
+    std::lock_guard<std::mutex> guard{ reflectionCache_.mutex };
+    BuildReflectionCache();
 
     /* Return local work group size */
+    const SpirvReflect::SpvExecutionMode& executionMode = reflectionCache_.executionMode;
     outLocalSize.width  = executionMode.localSizeX;
     outLocalSize.height = executionMode.localSizeY;
     outLocalSize.depth  = executionMode.localSizeZ;
@@ -464,13 +419,14 @@ bool VKShader::ReflectPushConstants(
     /* Initialize output container with zero-ranges */
     outUniformRanges.resize(inUniformDescs.size());
 
-    /* Parse shader module for push-constants */
-    SpirvReflect::SpvBlock block;
-    SpirvResult result = SpirvReflectPushConstants(SpirvModuleView{ shaderCode_ }, block);
-    if (result != SpirvResult::NoError)
+    std::lock_guard<std::mutex> guard{ reflectionCache_.mutex };
+    BuildReflectionCache();
+
+    if (!reflectionCache_.pushConstantsValid)
         return false;
 
     /* Build push constant ranges */
+    const SpirvReflect::SpvBlock& block = reflectionCache_.pushConstants;
     for_range(i, inUniformDescs.size())
     {
         /* Find name of uniform descriptor in push-constant block fields */
@@ -518,6 +474,85 @@ bool VKShader::ReflectPushConstants(
  * ======= Private: =======
  */
 
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+bool VKShader::ReflectSpirvModule(ShaderReflection& reflection) const
+{
+    /* Parse shader module */
+    SpirvReflect spvReflect;
+    if (spvReflect.Reflect(SpirvModuleView{ shaderCode_ }) != SpirvResult::NoError)
+        return false;
+
+    /* Gather input/output attributes */
+    for (const auto& it : spvReflect.GetVaryings())
+    {
+        const auto& var = it.second;
+        if (GetType() == ShaderType::Vertex)
+        {
+            std::uint32_t numVectors = 1;
+
+            /* Determine vertex attribute data */
+            VertexAttribute attrib;
+            {
+                attrib.name         = GetOptString(var.name);
+                attrib.format       = SpvTypeToFormat(var.type, &numVectors);
+                attrib.location     = var.location;
+                attrib.systemValue  = SpvBuiltinToSystemValue(var.builtin);
+            }
+
+            /* Append vertex attributes for each semantic index */
+            for_range(i, numVectors)
+            {
+                attrib.semanticIndex = i;
+                if (var.input)
+                    reflection.vertex.inputAttribs.push_back(attrib);
+                else
+                    reflection.vertex.outputAttribs.push_back(attrib);
+            }
+        }
+        else if (GetType() == ShaderType::Fragment && !var.input)
+        {
+            /* Determine and append fragment attribute data */
+            FragmentAttribute attrib;
+            {
+                attrib.name         = GetOptString(var.name);
+                attrib.format       = SpvTypeToFormat(var.type);
+                attrib.location     = var.location;
+                attrib.systemValue  = SpvBuiltinToFragmentOutputSV(var.builtin);
+            }
+            reflection.fragment.outputAttribs.push_back(attrib);
+        }
+    }
+
+    /* Gather shader resources */
+    for (const auto& it : spvReflect.GetUniforms())
+    {
+        const auto& var = it.second;
+        if (auto resource = FindOrAppendShaderResource(reflection, var))
+            resource->binding.stageFlags |= ShaderTypeToStageFlags(GetType());
+    }
+
+    /* Gather push constants */
+    //TODO
+
+    return true;
+}
+
+void VKShader::BuildReflectionCache() const
+{
+    if (reflectionCache_.isBuilt)
+        return;
+
+    /* Parse immutable SPIR-V module only once for all reflection queries */
+    const SpirvModuleView module{ shaderCode_ };
+    reflectionCache_.reflectionValid    = ReflectSpirvModule(reflectionCache_.reflection);
+    reflectionCache_.pushConstantsValid = (SpirvReflectPushConstants(module, reflectionCache_.pushConstants) == SpirvResult::NoError);
+    SpirvReflectExecutionMode(module, reflectionCache_.executionMode);
+    reflectionCache_.isBuilt            = true;
+}
+
+#endif // /LLGL_ENABLE_SPIRV_REFLECT
+
 bool VKShader::BuildShader(const ShaderDescriptor& shaderDesc)
 {
     if (IsShaderSourceCode(shaderDesc.sourceType))
@@ -649,13 +684,31 @@ bool VKShader::LoadBinary(const ShaderDescriptor& shaderDesc)
         entryPoint_ = shaderDesc.entryPoint;
 
     /* Create shader module */
-    shaderModule_ = CreateVkShaderModule(device_, shaderCode_);
+    stripBinary_ = ((shaderDesc.flags & ShaderCompileFlags::StripBinary) != 0);
+    shaderModule_ = CreateVkShaderModuleFromCode(shaderCode_);
 
     loadBinaryResult_ = LoadBinaryResult::Successful;
 
     return true;
 }
 
+VKPtr<VkShaderModule> VKShader::CreateVkShaderModuleFromCode(const std::vector<std::uint32_t>& shaderCode) const
+{
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    if (stripBinary_)
+    {
+        /*
+        Strip a copy of the module, since 'shaderCode_' must keep its debug names for reflection
+        and its word offsets for the binding layout. If stripping fails, the original module is used as is.
+        */
+        SpirvModule strippedModule{ ArrayView<std::uint32_t>{ shaderCode.data(), shaderCode.size() } };
+        if (SpirvStripModule(strippedModule) == SpirvResult::NoError)
+            return CreateVkShaderModule(device_, strippedModule.Words());
+    }
+    #endif
+    return CreateVkShaderModule(device_, shaderCode);
+}
+
 
 } // /namespace LLGL
 
@@ -16,6 +16,12 @@
 #include "VKShaderBindingLayout.h"
 #include <vector>
 #include <functional>
+#include <mutex>
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+#   include <LLGL/ShaderReflection.h>
+#   include "../../SPIRV/SpirvReflect.h"
+#endif
 
 
 namespace LLGL
@@ -69,11 +75,14 @@ class VKShader final : public Shader
         bool NeedsShaderModulePermutation(const PermutationBindingFunc& permutationBindingFunc) const;
 
         /*
-        Creates a shader module permutation with re-assigned binding slots using the specified function callback.
+        Re-assigns the binding slots of a copy of this shader's binding layout using the specified function callback.
         Re-assigned descriptor sets for [0, N) invocations of the callback until 'permutationBindingFunc' returns false.
-        Returns VK_NULL_HANDLE if no permutation was created. Should only be used by VKPipelineLayout.
+        Returns false if no binding slot was modified, in which case no permutation is needed. Should only be used by VKPipelineLayout.
         */
-        VKPtr<VkShaderModule> CreateVkShaderModulePermutation(const PermutationBindingFunc& permutationBindingFunc);
+        bool PermuteBindingLayout(const PermutationBindingFunc& permutationBindingFunc, VKShaderBindingLayout& outBindingLayout) const;
+
+        // Creates a shader module permutation from this shader's SPIR-V module with the binding slots of the specified layout, which must have been returned by 'PermuteBindingLayout'.
+        VKPtr<VkShaderModule> CreateVkShaderModulePermutation(const VKShaderBindingLayout& bindingLayout) const;
 
         // Returns the Vulkan shader module.
         inline const VKPtr<VkShaderModule>& GetShaderModule() const
@@ -102,6 +111,19 @@ class VKShader final : public Shader
         bool CompileSource(const ShaderDescriptor& shaderDesc);
         bool LoadBinary(const ShaderDescriptor& shaderDesc);
 
+        // Creates a Vulkan shader module from the specified SPIR-V code, which is stripped first if ShaderCompileFlags::StripBinary was specified.
+        VKPtr<VkShaderModule> CreateVkShaderModuleFromCode(const std::vector<std::uint32_t>& shaderCode) const;
+
+        #ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+        // Parses the SPIR-V module and converts it into the specified shader reflection.
+        bool ReflectSpirvModule(ShaderReflection& outReflection) const;
+
+        // Builds the reflection cache on first use. The mutex of the cache must be locked.
+        void BuildReflectionCache() const;
+
+        #endif
+
     private:
 
         struct VertexInputLayout
@@ -110,6 +132,25 @@ class VKShader final : public Shader
             std::vector<VkVertexInputAttributeDescription>  attribDescs;
         };
 
+        #ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+        /*
+        Reflection of the SPIR-V module that is built on first use, since the module is immutable after the shader has been created.
+        All names refer to strings within 'shaderCode_'. This makes repeated calls to Reflect() and pipeline layout permutations O(1).
+        */
+        struct ReflectionCache
+        {
+            std::mutex                      mutex;
+            bool                            isBuilt             = false;
+            bool                            reflectionValid     = false;
+            bool                            pushConstantsValid  = false;
+            ShaderReflection                reflection;
+            SpirvReflect::SpvBlock          pushConstants;
+            SpirvReflect::SpvExecutionMode  executionMode;
+        };
+
+        #endif
+
     private:
 
         VkDevice                    device_             = VK_NULL_HANDLE;
@@ -119,11 +160,16 @@ class VKShader final : public Shader
         VKShaderBindingLayout       bindingLayout_;
 
         LoadBinaryResult            loadBinaryResult_   = LoadBinaryResult::Undefined;
+        bool                        stripBinary_        = false;
         VertexInputLayout           inputLayout_;
 
         std::string                 entryPoint_;
         Report                      report_;
 
+        #ifdef LLGL_ENABLE_SPIRV_REFLECT
+        mutable ReflectionCache     reflectionCache_;
+        #endif
+
 };
 
 
@@ -24,6 +24,8 @@ namespace LLGL
 
 bool VKShaderBindingLayout::BuildFromSpirvModule(const void* data, std::size_t size)
 {
+    moduleHash_ = HashFNV1a(data, size);
+
     #ifdef LLGL_ENABLE_SPIRV_REFLECT
 
     /* Reflect all SPIR-V binding points */
@@ -173,7 +175,7 @@ std::uint32_t VKShaderBindingLayout::AssignBindingSlots(
     return numBindings;
 }
 
-void VKShaderBindingLayout::UpdateSpirvModule(void* data, std::size_t size)
+void VKShaderBindingLayout::UpdateSpirvModule(void* data, std::size_t size) const
 {
     auto* words = reinterpret_cast<std::uint32_t*>(data);
     const auto numWords = size/4;
@@ -187,6 +189,17 @@ void VKShaderBindingLayout::UpdateSpirvModule(void* data, std::size_t size)
     }
 }
 
+std::uint64_t VKShaderBindingLayout::GetPermutationHash() const
+{
+    std::uint64_t hash = moduleHash_;
+    for (const auto& binding : bindings_)
+    {
+        hash = HashFNV1a(&binding.dstDescriptorSet, sizeof(binding.dstDescriptorSet), hash);
+        hash = HashFNV1a(&binding.dstBinding, sizeof(binding.dstBinding), hash);
+    }
+    return hash;
+}
+
 
 } // /namespace LLGL
 
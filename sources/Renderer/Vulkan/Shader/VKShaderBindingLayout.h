@@ -49,7 +49,13 @@ class VKShaderBindingLayout
         Writes the updated resource bindings to the specified SPIR-V module.
         This SPIR-V module must be identical to the one used when the layout was built, except for the binding values.
         */
-        void UpdateSpirvModule(void* data, std::size_t size);
+        void UpdateSpirvModule(void* data, std::size_t size) const;
+
+        /*
+        Returns a 64-bit hash of the SPIR-V module this layout was built from and all of its re-assigned binding slots.
+        Two layouts with equal hashes produce identical SPIR-V words with 'UpdateSpirvModule', so their shader modules can be shared.
+        */
+        std::uint64_t GetPermutationHash() const;
 
     private:
 
@@ -82,7 +88,8 @@ class VKShaderBindingLayout
 
     private:
 
-        std::vector<ModuleBinding> bindings_;
+        std::vector<ModuleBinding>  bindings_;
+        std::uint64_t               moduleHash_ = 0; // Hash of the unmodified SPIR-V module
 
 };
 
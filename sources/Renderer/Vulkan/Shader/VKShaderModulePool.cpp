@@ -6,6 +6,7 @@
  */
 
 #include "VKShaderModulePool.h"
+#include "VKShader.h"
 #include "../RenderState/VKPipelineLayout.h"
 #include "../../../Core/CoreUtils.h"
 #include "../../../Core/MacroUtils.h"
@@ -23,11 +24,15 @@ VKShaderModulePool& VKShaderModulePool::Get()
 
 void VKShaderModulePool::Clear()
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     permutations_.clear();
+    sharedModules_.clear();
 }
 
 VkShaderModule VKShaderModulePool::GetOrCreateVkShaderModulePermutation(VKShader& shader, const VKPipelineLayout& pipelineLayout)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
     /* Try to find existing pair of shader/pipeline-layout */
     const auto* shaderPtr = &shader;
     const auto* pipelineLayoutPtr = &pipelineLayout;
@@ -47,28 +52,36 @@ VkShaderModule VKShaderModulePool::GetOrCreateVkShaderModulePermutation(VKShader
 
     if (permutation == nullptr)
     {
-        /* Create new shader module permutation */
-        VKPtr<VkShaderModule> shaderModule = pipelineLayout.CreateVkShaderModulePermutation(shader);
-        VkShaderModule nativeHandle = shaderModule.Get();
+        /* Re-assign binding slots and share the patched shader module with all permutations that produce the same remap */
+        VKShaderBindingLayout bindingLayout;
+        if (!pipelineLayout.PermuteShaderBindingLayout(shader, bindingLayout))
+            return VK_NULL_HANDLE;
+
+        SharedShaderModule* sharedModule = GetOrCreateSharedShaderModule(shader, bindingLayout);
 
-        if (nativeHandle != VK_NULL_HANDLE)
+        ShaderModulePermutation newPermutation;
         {
-            ShaderModulePermutation newPermutation;
-            {
-                newPermutation.pipelineLayout   = pipelineLayoutPtr;
-                newPermutation.shader           = shaderPtr;
-                newPermutation.shaderModule     = std::move(shaderModule);
-            }
-            permutations_.insert(permutations_.begin() + insertionPos, std::move(newPermutation));
+            newPermutation.pipelineLayout   = pipelineLayoutPtr;
+            newPermutation.shader           = shaderPtr;
+            newPermutation.sharedModule     = sharedModule;
         }
-        return nativeHandle;
+        permutations_.insert(permutations_.begin() + insertionPos, newPermutation);
+
+        return sharedModule->shaderModule.Get();
     }
 
-    return permutation->shaderModule.Get();
+    return permutation->sharedModule->shaderModule.Get();
 }
 
 void VKShaderModulePool::NotifyReleaseShader(VKShader* shader)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    for (const ShaderModulePermutation& entry : permutations_)
+    {
+        if (entry.shader == shader)
+            ReleaseSharedShaderModule(entry.sharedModule);
+    }
+
     /* Since shader is the second key, we have to iterate over the entire list */
     RemoveAllFromListIf(
         permutations_,
@@ -81,6 +94,13 @@ void VKShaderModulePool::NotifyReleaseShader(VKShader* shader)
 
 void VKShaderModulePool::NotifyReleasePipelineLayout(VKPipelineLayout* pipelineLayout)
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    for (const ShaderModulePermutation& entry : permutations_)
+    {
+        if (entry.pipelineLayout == pipelineLayout)
+            ReleaseSharedShaderModule(entry.sharedModule);
+    }
+
     /* Since pipeline layout is the first key, we can search for the first occurance and then delete all consecutive entries that match the key */
     RemoveAllConsecutiveFromListIf(
         permutations_,
@@ -92,6 +112,62 @@ void VKShaderModulePool::NotifyReleasePipelineLayout(VKPipelineLayout* pipelineL
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+VKShaderModulePool::SharedShaderModule* VKShaderModulePool::GetOrCreateSharedShaderModule(VKShader& shader, const VKShaderBindingLayout& bindingLayout)
+{
+    const std::uint64_t hash = bindingLayout.GetPermutationHash();
+
+    /* Try to find shared shader module with the same content hash */
+    std::size_t insertionPos = 0;
+    auto* sharedModuleRef = FindInSortedArray<std::unique_ptr<SharedShaderModule>>(
+        sharedModules_.data(),
+        sharedModules_.size(),
+        [hash](const std::unique_ptr<SharedShaderModule>& entry) -> int
+        {
+            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(hash, entry->hash);
+            return 0;
+        },
+        &insertionPos
+    );
+
+    SharedShaderModule* sharedModule = nullptr;
+
+    if (sharedModuleRef == nullptr)
+    {
+        /* Patch SPIR-V module only once for each unique binding remap */
+        auto newSharedModule = MakeUnique<SharedShaderModule>();
+        {
+            newSharedModule->hash           = hash;
+            newSharedModule->shaderModule   = shader.CreateVkShaderModulePermutation(bindingLayout);
+        }
+        sharedModule = newSharedModule.get();
+        sharedModules_.insert(sharedModules_.begin() + insertionPos, std::move(newSharedModule));
+    }
+    else
+        sharedModule = sharedModuleRef->get();
+
+    sharedModule->numRefs++;
+    return sharedModule;
+}
+
+void VKShaderModulePool::ReleaseSharedShaderModule(SharedShaderModule* sharedModule)
+{
+    if (--sharedModule->numRefs == 0)
+    {
+        RemoveFromListIf(
+            sharedModules_,
+            [sharedModule](const std::unique_ptr<SharedShaderModule>& entry) -> bool
+            {
+                return (entry.get() == sharedModule);
+            }
+        );
+    }
+}
+
+
 } // /namespace LLGL
 
 
@@ -12,6 +12,9 @@
 #include "../Vulkan.h"
 #include "../VKPtr.h"
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
 
 
 namespace LLGL
@@ -19,9 +22,15 @@ namespace LLGL
 
 
 class VKShader;
+class VKShaderBindingLayout;
 class VKPipelineLayout;
 
-// Singleton pool for Vulkan shader/pipeline-layout permutations.
+/*
+Singleton pool for Vulkan shader/pipeline-layout permutations.
+Patched shader modules are identified by a hash of their SPIR-V module and re-assigned binding slots,
+so all pipeline layouts that produce the same binding remap for the same SPIR-V module share a single VkShaderModule.
+All public functions are thread-safe, since permutations are also requested by PSOs that are compiled in the background.
+*/
 class VKShaderModulePool
 {
 
@@ -45,20 +54,36 @@ class VKShaderModulePool
 
     private:
 
+        // Patched shader module that is shared by all permutations with the same hash.
+        struct SharedShaderModule
+        {
+            std::uint64_t           hash            = 0;
+            std::uint32_t           numRefs         = 0;
+            VKPtr<VkShaderModule>   shaderModule;
+        };
+
         struct ShaderModulePermutation
         {
             const VKPipelineLayout* pipelineLayout  = nullptr;
             const VKShader*         shader          = nullptr;
-            VKPtr<VkShaderModule>   shaderModule;
+            SharedShaderModule*     sharedModule    = nullptr;
         };
 
     private:
 
         VKShaderModulePool() = default;
 
+        // Returns the shared shader module with the specified hash or creates a new one. Increments its reference counter.
+        SharedShaderModule* GetOrCreateSharedShaderModule(VKShader& shader, const VKShaderBindingLayout& bindingLayout);
+
+        // Decrements the reference counter of the specified shared shader module and releases it if it's no longer used.
+        void ReleaseSharedShaderModule(SharedShaderModule* sharedModule);
+
     private:
 
-        std::vector<ShaderModulePermutation> permutations_;
+        std::vector<ShaderModulePermutation>                permutations_;  // Sorted by pipeline layout and shader
+        std::vector<std::unique_ptr<SharedShaderModule>>    sharedModules_; // Sorted by hash
+        std::mutex                                          mutex_;
 
 };
 
@@ -9,7 +9,10 @@
 #include "../VKDevice.h"
 #include "../Memory/VKDeviceMemory.h"
 #include "../Memory/VKDeviceMemoryManager.h"
+#include "../Memory/VKExternalHandle.h"
 #include "../VKCore.h"
+#include "../Ext/VKExtensions.h"
+#include <LLGL/TextureFlags.h>
 
 
 namespace LLGL
@@ -21,20 +24,39 @@ VKDeviceImage::VKDeviceImage(VkDevice device) :
 {
 }
 
-void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr)
+void VKDeviceImage::QueryMemoryRequirements(VkDevice device)
+{
+    vkGetImageMemoryRequirements(device, image_, &memoryRequirements_);
+}
+
+void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr, bool lazilyAllocated)
 {
     auto device = deviceMemoryMngr.GetVkDevice();
 
     /* Get memory requirements for the image */
-    vkGetImageMemoryRequirements(device, image_, &memoryRequirements_);
+    QueryMemoryRequirements(device);
 
-    /* Allocate device memory */
-    memoryRegion_ = deviceMemoryMngr.Allocate(
-        memoryRequirements_.size,
-        memoryRequirements_.alignment,
-        memoryRequirements_.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-    );
+    /* Prefer lazily allocated memory if requested, which is usually only provided by tile-based GPUs */
+    VkMemoryPropertyFlags memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    if (lazilyAllocated)
+    {
+        constexpr VkMemoryPropertyFlags lazyMemoryProperties = (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+        if (deviceMemoryMngr.HasMemoryType(memoryRequirements_.memoryTypeBits, lazyMemoryProperties))
+            memoryProperties = lazyMemoryProperties;
+    }
+
+    /* Allocate device memory; exportable images get their own device memory chunk */
+    if (exportable_)
+        memoryRegion_ = deviceMemoryMngr.AllocateExportable(memoryRequirements_, memoryProperties, VK_NULL_HANDLE, image_);
+    else
+    {
+        memoryRegion_ = deviceMemoryMngr.Allocate(
+            memoryRequirements_.size,
+            memoryRequirements_.alignment,
+            memoryRequirements_.memoryTypeBits,
+            memoryProperties
+        );
+    }
 
     /* Bind image to device memory region */
     if (memoryRegion_)
@@ -59,21 +81,31 @@ void VKDeviceImage::BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memo
 }
 
 void VKDeviceImage::CreateVkImage(
-    VkDevice                device,
-    VkImageType             imageType,
-    VkFormat                format,
-    const VkExtent3D&       extent,
-    std::uint32_t           numMipLevels,
-    std::uint32_t           numArrayLayers,
-    VkImageCreateFlags      createFlags,
-    VkSampleCountFlagBits   sampleCountBits,
-    VkImageUsageFlags       usageFlags)
+    VkDevice                    device,
+    VkImageType                 imageType,
+    VkFormat                    format,
+    const VkExtent3D&           extent,
+    std::uint32_t               numMipLevels,
+    std::uint32_t               numArrayLayers,
+    VkImageCreateFlags          createFlags,
+    VkSampleCountFlagBits       sampleCountBits,
+    VkImageUsageFlags           usageFlags,
+    ArrayView<std::uint32_t>    sharedQueueFamilies,
+    bool                        exportable)
 {
-    /* Create image object */
+    exportable_ = exportable;
+
+    /* Create image object; exportable images must declare the external memory handle type they are bound to */
+    VkExternalMemoryImageCreateInfoKHR externalInfo;
+    {
+        externalInfo.sType                  = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO_KHR;
+        externalInfo.pNext                  = nullptr;
+        externalInfo.handleTypes            = VKGetExternalMemoryHandleType();
+    }
     VkImageCreateInfo createInfo;
     {
         createInfo.sType                    = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
+        createInfo.pNext                    = (exportable ? &externalInfo : nullptr);
         createInfo.flags                    = createFlags;
         createInfo.imageType                = imageType;
         createInfo.format                   = format;
@@ -83,9 +115,18 @@ void VKDeviceImage::CreateVkImage(
         createInfo.samples                  = sampleCountBits;
         createInfo.tiling                   = VK_IMAGE_TILING_OPTIMAL;
         createInfo.usage                    = usageFlags;
-        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE; // only used by graphics queue
-        createInfo.queueFamilyIndexCount    = 0;
-        createInfo.pQueueFamilyIndices      = nullptr;
+        if (sharedQueueFamilies.size() > 1)
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount    = static_cast<std::uint32_t>(sharedQueueFamilies.size());
+            createInfo.pQueueFamilyIndices      = sharedQueueFamilies.data();
+        }
+        else
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
         createInfo.initialLayout            = VK_IMAGE_LAYOUT_UNDEFINED;
     }
     VkResult result = vkCreateImage(device, &createInfo, nullptr, image_.ReleaseAndGetAddressOf());
@@ -103,13 +144,22 @@ void VKDeviceImage::CreateVkImageView(
     VkFormat                        format,
     const VkImageSubresourceRange&  subresourceRange,
     VKPtr<VkImageView>&             outImageView,
-    const VkComponentMapping*       components)
+    const VkComponentMapping*       components,
+    VkImageUsageFlags               usageFlags)
 {
+    /* Restrict usage of the image view if the image was created with VK_IMAGE_CREATE_EXTENDED_USAGE_BIT */
+    VkImageViewUsageCreateInfoKHR usageInfo;
+    {
+        usageInfo.sType             = VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO_KHR;
+        usageInfo.pNext             = nullptr;
+        usageInfo.usage             = usageFlags;
+    }
+
     /* Create image view object */
     VkImageViewCreateInfo createInfo;
     {
         createInfo.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        createInfo.pNext            = nullptr;
+        createInfo.pNext            = (usageFlags != 0 ? &usageInfo : nullptr);
         createInfo.flags            = 0;
         createInfo.image            = image_;
         createInfo.viewType         = viewType;
@@ -146,6 +196,35 @@ VkImageLayout VKDeviceImage::TransitionImageLayout(
     return oldLayout;
 }
 
+VkImageLayout VKDeviceImage::TransitionImageLayoutOnHost(
+    VkDevice                    device,
+    VkImageAspectFlags          aspectMask,
+    VkImageLayout               newLayout,
+    const TextureSubresource&   subresource)
+{
+    VkImageLayout oldLayout = layout_;
+    if (newLayout != oldLayout)
+    {
+        VkHostImageLayoutTransitionInfoEXT transitionInfo;
+        {
+            transitionInfo.sType                            = VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT;
+            transitionInfo.pNext                            = nullptr;
+            transitionInfo.image                            = image_;
+            transitionInfo.oldLayout                        = oldLayout;
+            transitionInfo.newLayout                        = newLayout;
+            transitionInfo.subresourceRange.aspectMask      = aspectMask;
+            transitionInfo.subresourceRange.baseMipLevel    = subresource.baseMipLevel;
+            transitionInfo.subresourceRange.levelCount      = subresource.numMipLevels;
+            transitionInfo.subresourceRange.baseArrayLayer  = subresource.baseArrayLayer;
+            transitionInfo.subresourceRange.layerCount      = subresource.numArrayLayers;
+        }
+        VkResult result = vkTransitionImageLayoutEXT(device, 1, &transitionInfo);
+        VKThrowIfFailed(result, "failed to transition Vulkan image layout on host");
+        layout_ = newLayout;
+    }
+    return oldLayout;
+}
+
 
 } // /namespace LLGL
 
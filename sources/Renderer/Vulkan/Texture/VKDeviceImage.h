@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Texture.h>
+#include <LLGL/Container/ArrayView.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include <cstdint>
@@ -38,21 +39,30 @@ class VKDeviceImage
         VKDeviceImage(VKDeviceImage&&) = default;
         VKDeviceImage& operator = (VKDeviceImage&&) = default;
 
-        void AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
+        // Queries the memory requirements for this image without allocating memory, e.g. for sparse images.
+        void QueryMemoryRequirements(VkDevice device);
+
+        /*
+        Allocates a device memory region for this image and binds it to the image.
+        If 'lazilyAllocated' is true, memory with VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT is preferred, e.g. for transient attachments.
+        */
+        void AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr, bool lazilyAllocated = false);
         void ReleaseMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
 
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
 
         void CreateVkImage(
-            VkDevice                device,
-            VkImageType             imageType,
-            VkFormat                format,
-            const VkExtent3D&       extent,
-            std::uint32_t           numMipLevels,
-            std::uint32_t           numArrayLayers,
-            VkImageCreateFlags      createFlags,
-            VkSampleCountFlagBits   sampleCountBits,
-            VkImageUsageFlags       usageFlags
+            VkDevice                    device,
+            VkImageType                 imageType,
+            VkFormat                    format,
+            const VkExtent3D&           extent,
+            std::uint32_t               numMipLevels,
+            std::uint32_t               numArrayLayers,
+            VkImageCreateFlags          createFlags,
+            VkSampleCountFlagBits       sampleCountBits,
+            VkImageUsageFlags           usageFlags,
+            ArrayView<std::uint32_t>    sharedQueueFamilies = {},
+            bool                        exportable          = false
         );
 
         void ReleaseVkImage();
@@ -63,7 +73,8 @@ class VKDeviceImage
             VkFormat                        format,
             const VkImageSubresourceRange&  subresourceRange,
             VKPtr<VkImageView>&             outImageView,
-            const VkComponentMapping*       components          = nullptr
+            const VkComponentMapping*       components          = nullptr,
+            VkImageUsageFlags               usageFlags          = 0
         );
 
         VkImageLayout TransitionImageLayout(
@@ -74,6 +85,23 @@ class VKDeviceImage
             const TextureSubresource&   subresource
         );
 
+        /*
+        Transitions this image to the specified new layout on the host and returns the old layout (see VK_EXT_host_image_copy).
+        The image must have been created with VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT and must not be in use by the device.
+        */
+        VkImageLayout TransitionImageLayoutOnHost(
+            VkDevice                    device,
+            VkImageAspectFlags          aspectMask,
+            VkImageLayout               newLayout,
+            const TextureSubresource&   subresource
+        );
+
+        // Returns the current layout of this image.
+        inline VkImageLayout GetLayout() const
+        {
+            return layout_;
+        }
+
         // Returns the native VkImage handle.
         inline VkImage GetVkImage() const
         {
@@ -92,12 +120,19 @@ class VKDeviceImage
             return memoryRequirements_;
         }
 
+        // Returns true if this image was created with the external memory handle type and is bound to its own exportable device memory.
+        inline bool IsExportable() const
+        {
+            return exportable_;
+        }
+
     private:
 
         VKPtr<VkImage>          image_;
         VkImageLayout           layout_             = VK_IMAGE_LAYOUT_UNDEFINED;
         VkMemoryRequirements    memoryRequirements_ = {};
         VKDeviceMemoryRegion*   memoryRegion_       = nullptr;
+        bool                    exportable_         = false;
 
 };
 
@@ -0,0 +1,164 @@
+/*
+ * VKHostImageCopy.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKHostImageCopy.h"
+#include "VKTexture.h"
+#include "../VKPhysicalDevice.h"
+#include "../VKCore.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
+#include <LLGL/TextureFlags.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Maximum size (in bytes) of image data that is copied on the host; larger images are uploaded with staging buffers.
+static constexpr VkDeviceSize g_maxHostImageCopySize = 4u * 1024u * 1024u;
+
+// Image layout that all host image copies are performed in.
+static constexpr VkImageLayout g_hostImageCopyLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+VKHostImageCopy& VKHostImageCopy::Get()
+{
+    static VKHostImageCopy instance;
+    return instance;
+}
+
+void VKHostImageCopy::InitializeDevice(VkDevice device, const VKPhysicalDevice& physicalDevice)
+{
+    Clear();
+
+    /* Format features and image format properties are queried via VK_KHR_get_physical_device_properties2 */
+    if (!physicalDevice.HasHostImageCopy() ||
+        !HasExtension(VKExt::EXT_host_image_copy) ||
+        !HasExtension(VKExt::KHR_get_physical_device_properties2))
+    {
+        return;
+    }
+
+    const std::vector<VkImageLayout>& dstLayouts = physicalDevice.GetHostImageCopyDstLayouts();
+    if (std::find(dstLayouts.begin(), dstLayouts.end(), g_hostImageCopyLayout) == dstLayouts.end())
+        return;
+
+    device_         = device;
+    physicalDevice_ = physicalDevice.GetVkPhysicalDevice();
+}
+
+void VKHostImageCopy::Clear()
+{
+    device_         = VK_NULL_HANDLE;
+    physicalDevice_ = VK_NULL_HANDLE;
+}
+
+bool VKHostImageCopy::IsAvailable() const
+{
+    return (device_ != VK_NULL_HANDLE);
+}
+
+bool VKHostImageCopy::IsSupported(
+    VkImageType         imageType,
+    VkFormat            format,
+    VkImageCreateFlags  createFlags,
+    VkImageUsageFlags   usageFlags) const
+{
+    if (!IsAvailable())
+        return false;
+
+    /* Format must support host transfers with optimal tiling */
+    VkFormatProperties3KHR formatProps3 = {};
+    formatProps3.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3_KHR;
+
+    VkFormatProperties2KHR formatProps2 = {};
+    {
+        formatProps2.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2_KHR;
+        formatProps2.pNext = &formatProps3;
+    }
+    vkGetPhysicalDeviceFormatProperties2KHR(physicalDevice_, format, &formatProps2);
+
+    if ((formatProps3.optimalTilingFeatures & VK_FORMAT_FEATURE_2_HOST_IMAGE_TRANSFER_BIT_EXT) == 0)
+        return false;
+
+    /* Host transfer usage must not disable device optimizations such as framebuffer compression */
+    VkPhysicalDeviceImageFormatInfo2KHR imageFormatInfo = {};
+    {
+        imageFormatInfo.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2_KHR;
+        imageFormatInfo.format  = format;
+        imageFormatInfo.type    = imageType;
+        imageFormatInfo.tiling  = VK_IMAGE_TILING_OPTIMAL;
+        imageFormatInfo.usage   = usageFlags;
+        imageFormatInfo.flags   = createFlags;
+    }
+    VkHostImageCopyDevicePerformanceQueryEXT performanceQuery = {};
+    performanceQuery.sType = VK_STRUCTURE_TYPE_HOST_IMAGE_COPY_DEVICE_PERFORMANCE_QUERY_EXT;
+
+    VkImageFormatProperties2KHR imageFormatProps = {};
+    {
+        imageFormatProps.sType = VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2_KHR;
+        imageFormatProps.pNext = &performanceQuery;
+    }
+    if (vkGetPhysicalDeviceImageFormatProperties2KHR(physicalDevice_, &imageFormatInfo, &imageFormatProps) != VK_SUCCESS)
+        return false;
+
+    return (performanceQuery.optimalDeviceAccess != VK_FALSE);
+}
+
+bool VKHostImageCopy::IsPreferred(const VKTexture& texture, VkDeviceSize dataSize) const
+{
+    if (!IsAvailable() || !texture.HasHostImageCopy() || dataSize > g_maxHostImageCopySize)
+        return false;
+
+    const VkImageLayout layout = texture.GetVkImageLayout();
+    return (layout == VK_IMAGE_LAYOUT_UNDEFINED || layout == g_hostImageCopyLayout);
+}
+
+void VKHostImageCopy::CopyMemoryToImage(
+    VKTexture&                  texture,
+    const void*                 data,
+    const VkOffset3D&           offset,
+    const VkExtent3D&           extent,
+    const TextureSubresource&   subresource)
+{
+    /* Transition image out of its initial layout; the previous content is undefined anyway */
+    texture.TransitionImageLayoutOnHost(device_, g_hostImageCopyLayout);
+
+    VkMemoryToImageCopyEXT region;
+    {
+        region.sType                            = VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT;
+        region.pNext                            = nullptr;
+        region.pHostPointer                     = data;
+        region.memoryRowLength                  = 0;
+        region.memoryImageHeight                = 0;
+        region.imageSubresource.aspectMask      = texture.GetAspectFlags();
+        region.imageSubresource.mipLevel        = subresource.baseMipLevel;
+        region.imageSubresource.baseArrayLayer  = subresource.baseArrayLayer;
+        region.imageSubresource.layerCount      = subresource.numArrayLayers;
+        region.imageOffset                      = offset;
+        region.imageExtent                      = extent;
+    }
+    VkCopyMemoryToImageInfoEXT copyInfo;
+    {
+        copyInfo.sType          = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT;
+        copyInfo.pNext          = nullptr;
+        copyInfo.flags          = 0;
+        copyInfo.dstImage       = texture.GetVkImage();
+        copyInfo.dstImageLayout = g_hostImageCopyLayout;
+        copyInfo.regionCount    = 1;
+        copyInfo.pRegions       = &region;
+    }
+    VkResult result = vkCopyMemoryToImageEXT(device_, &copyInfo);
+    VKThrowIfFailed(result, "failed to copy memory to Vulkan image on host");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,101 @@
+/*
+ * VKHostImageCopy.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_HOST_IMAGE_COPY_H
+#define LLGL_VK_HOST_IMAGE_COPY_H
+
+
+#include "../Vulkan.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class VKTexture;
+class VKPhysicalDevice;
+struct TextureSubresource;
+
+/*
+Vulkan host image copy singleton (see VK_EXT_host_image_copy).
+Writes image data from host memory directly into textures with vkCopyMemoryToImageEXT, i.e. without a staging buffer and queue submission.
+Textures are only created with VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT if the driver reports optimal device access for that usage,
+and all host copies are performed in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, which is the layout textures are in after their initial upload.
+*/
+class VKHostImageCopy
+{
+
+    public:
+
+        // Returns the singleton instance.
+        static VKHostImageCopy& Get();
+
+    public:
+
+        VKHostImageCopy(const VKHostImageCopy&) = delete;
+        VKHostImageCopy& operator = (const VKHostImageCopy&) = delete;
+
+        VKHostImageCopy(VKHostImageCopy&&) = delete;
+        VKHostImageCopy& operator = (VKHostImageCopy&&) = delete;
+
+        // Enables host image copies if the physical device supports VK_EXT_host_image_copy with VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL as destination layout.
+        void InitializeDevice(VkDevice device, const VKPhysicalDevice& physicalDevice);
+
+        // Disables host image copies (used by VKRenderSystem).
+        void Clear();
+
+        // Returns true if host image copies are enabled.
+        bool IsAvailable() const;
+
+        // Returns true if images with the specified parameters can be created with VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT without impairing device access.
+        bool IsSupported(
+            VkImageType         imageType,
+            VkFormat            format,
+            VkImageCreateFlags  createFlags,
+            VkImageUsageFlags   usageFlags
+        ) const;
+
+        /*
+        Returns true if image data of the specified size should be copied on the host into the specified texture.
+        This requires the texture to be created with host transfer usage and to be either in its initial layout or ready for sampling.
+        Larger images are uploaded with staging buffers, since the host copy cannot overlap with other CPU work.
+        */
+        bool IsPreferred(const VKTexture& texture, VkDeviceSize dataSize) const;
+
+        /*
+        Copies the tightly packed image data from host memory into the specified region of the texture.
+        The texture must not be in use by the device and is transitioned into VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL on the host if it is still in its initial layout.
+        */
+        void CopyMemoryToImage(
+            VKTexture&                  texture,
+            const void*                 data,
+            const VkOffset3D&           offset,
+            const VkExtent3D&           extent,
+            const TextureSubresource&   subresource
+        );
+
+    private:
+
+        VKHostImageCopy() = default;
+
+    private:
+
+        VkDevice            device_         = VK_NULL_HANDLE;
+        VkPhysicalDevice    physicalDevice_ = VK_NULL_HANDLE;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
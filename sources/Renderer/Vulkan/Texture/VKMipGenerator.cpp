@@ -0,0 +1,415 @@
+/*
+ * VKMipGenerator.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKMipGenerator.h"
+#include "VKTexture.h"
+#include "../VKDevice.h"
+#include "../VKPhysicalDevice.h"
+#include "../VKCore.h"
+#include "../RenderState/VKBarrierAccumulator.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <stdint.h>
+
+#ifdef LLGL_VK_ENABLE_BUILTIN_SHADERS
+#   include "GenerateMips2D.comp.spv.h"
+#   include "GenerateMips2D.sRGB.comp.spv.h"
+#endif
+
+
+namespace LLGL
+{
+
+
+constexpr std::uint32_t VKMipGenerator::maxNumMipLevelsPerDispatch;
+
+// Push constants of the GenerateMips2D compute shader.
+struct VKMipGenerationConstants
+{
+    float           texelSize[2];
+    std::uint32_t   srcExtent[2];
+    std::uint32_t   numMipLevels;
+    std::uint32_t   baseArrayLayer;
+};
+
+// Extent of the source tile that is reduced by each work group.
+static constexpr std::uint32_t g_mipGenerationTileSize = 64;
+
+VKMipGenerator& VKMipGenerator::Get()
+{
+    static VKMipGenerator instance;
+    return instance;
+}
+
+VkFormat VKMipGenerator::GetStorageFormat(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_R8G8B8A8_SRGB:   return VK_FORMAT_R8G8B8A8_UNORM;
+        case VK_FORMAT_B8G8R8A8_SRGB:   return VK_FORMAT_B8G8R8A8_UNORM;
+        default:                        return format;
+    }
+}
+
+void VKMipGenerator::InitializeDevice(
+    VkDevice                device,
+    const VKPhysicalDevice& physicalDevice,
+    VkPipelineCache         pipelineCache,
+    bool                    enabled)
+{
+    Clear();
+
+    #ifdef LLGL_VK_ENABLE_BUILTIN_SHADERS
+
+    /* Storage images are written without format qualifier and descriptors are pushed directly into the command buffer */
+    if (!enabled ||
+        !HasExtension(VKExt::KHR_push_descriptor) ||
+        physicalDevice.GetFeatures().shaderStorageImageWriteWithoutFormat == VK_FALSE)
+    {
+        return;
+    }
+
+    physicalDevice_     = physicalDevice.GetVkPhysicalDevice();
+    hasExtendedUsage_   = HasExtension(VKExt::KHR_maintenance2);
+
+    CreateDescriptorSetLayout(device);
+    CreatePipelineLayout(device);
+    CreateComputePipeline(device, pipelineCache, g_spirvGenerateMips2D, sizeof(g_spirvGenerateMips2D), pipeline_);
+    CreateComputePipeline(device, pipelineCache, g_spirvGenerateMips2DsRGB, sizeof(g_spirvGenerateMips2DsRGB), pipelineSRGB_);
+
+    #endif // /LLGL_VK_ENABLE_BUILTIN_SHADERS
+}
+
+void VKMipGenerator::Clear()
+{
+    pipelineSRGB_.Release();
+    pipeline_.Release();
+    pipelineLayout_.Release();
+    descriptorSetLayout_.Release();
+    linearClampSampler_.Release();
+    physicalDevice_     = VK_NULL_HANDLE;
+    hasExtendedUsage_   = false;
+}
+
+bool VKMipGenerator::IsSupported(const TextureType type, VkFormat format) const
+{
+    if (pipeline_.Get() == VK_NULL_HANDLE)
+        return false;
+
+    /* Only 2D textures (including arrays and cube maps) can be written with the GenerateMips2D compute shader */
+    if (!(type == TextureType::Texture2D || type == TextureType::Texture2DArray || IsCubeTexture(type)))
+        return false;
+
+    /* Views with a different format than the image itself require VK_IMAGE_CREATE_EXTENDED_USAGE_BIT */
+    const VkFormat storageFormat = GetStorageFormat(format);
+    if (storageFormat != format && !hasExtendedUsage_)
+        return false;
+
+    VkFormatProperties sampledFormatProps, storageFormatProps;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice_, format, &sampledFormatProps);
+    vkGetPhysicalDeviceFormatProperties(physicalDevice_, storageFormat, &storageFormatProps);
+
+    return
+    (
+        (sampledFormatProps.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0 &&
+        (storageFormatProps.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0
+    );
+}
+
+// Returns the size of the specified MIP level but at least 1.
+static std::uint32_t GetMipLevelSize(std::uint32_t size, std::uint32_t mipLevel)
+{
+    return std::max(1u, size >> mipLevel);
+}
+
+bool VKMipGenerator::GenerateMips(
+    VKDevice&                   device,
+    VkCommandBuffer             commandBuffer,
+    VKBarrierAccumulator&       barriers,
+    VKTexture&                  texture,
+    const TextureSubresource&   subresource)
+{
+    const VkImage image = texture.GetVkImage();
+
+    if (!texture.HasComputeMipGeneration())
+    {
+        /* Fall back to chain of blit commands */
+        device.GenerateMips(commandBuffer, barriers, image, texture.GetVkFormat(), texture.GetVkExtent(), subresource);
+        return false;
+    }
+
+    if (subresource.numMipLevels < 2)
+        return false;
+
+    const bool isSRGB = (GetStorageFormat(texture.GetVkFormat()) != texture.GetVkFormat());
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, (isSRGB ? pipelineSRGB_.Get() : pipeline_.Get()));
+
+    /*
+    Make previous writes to the source MIP level visible to the compute shader.
+    Destination MIP levels are transitioned across all array layers, because their image views cover all array layers as well.
+    */
+    barriers.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_MEMORY_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+
+    VkImageSubresourceRange dstRange;
+    {
+        dstRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        dstRange.baseMipLevel   = 0;
+        dstRange.levelCount     = 0;
+        dstRange.baseArrayLayer = 0;
+        dstRange.layerCount     = texture.GetNumArrayLayers();
+    }
+
+    const VkExtent3D&   extent          = texture.GetVkExtent();
+    const std::uint32_t lastMipLevel    = subresource.baseMipLevel + subresource.numMipLevels - 1;
+
+    for (std::uint32_t srcMipLevel = subresource.baseMipLevel; srcMipLevel < lastMipLevel;)
+    {
+        const std::uint32_t numMipLevels = std::min(maxNumMipLevelsPerDispatch, lastMipLevel - srcMipLevel);
+
+        /* Transition destination MIP levels to general layout for storage access */
+        dstRange.baseMipLevel   = srcMipLevel + 1;
+        dstRange.levelCount     = numMipLevels;
+
+        barriers.InsertImageBarrier(
+            image,
+            dstRange,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            VK_ACCESS_SHADER_WRITE_BIT
+        );
+        barriers.Flush(commandBuffer);
+
+        /* Push source MIP level and destination MIP levels; unused destinations alias the last one, but are never written */
+        VkDescriptorImageInfo srcImageInfo;
+        {
+            srcImageInfo.sampler        = VK_NULL_HANDLE;
+            srcImageInfo.imageView      = texture.GetOrCreateMipLevelView(device, srcMipLevel, false);
+            srcImageInfo.imageLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+
+        VkDescriptorImageInfo dstImageInfos[maxNumMipLevelsPerDispatch];
+        for_range(i, maxNumMipLevelsPerDispatch)
+        {
+            const std::uint32_t dstMipLevel = srcMipLevel + 1 + std::min(i, numMipLevels - 1);
+            dstImageInfos[i].sampler        = VK_NULL_HANDLE;
+            dstImageInfos[i].imageView      = texture.GetOrCreateMipLevelView(device, dstMipLevel, true);
+            dstImageInfos[i].imageLayout    = VK_IMAGE_LAYOUT_GENERAL;
+        }
+
+        VkWriteDescriptorSet writes[2];
+        {
+            writes[0].sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[0].pNext             = nullptr;
+            writes[0].dstSet            = VK_NULL_HANDLE;
+            writes[0].dstBinding        = 0;
+            writes[0].dstArrayElement   = 0;
+            writes[0].descriptorCount   = 1;
+            writes[0].descriptorType    = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[0].pImageInfo        = &srcImageInfo;
+            writes[0].pBufferInfo       = nullptr;
+            writes[0].pTexelBufferView  = nullptr;
+
+            writes[1].sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[1].pNext             = nullptr;
+            writes[1].dstSet            = VK_NULL_HANDLE;
+            writes[1].dstBinding        = 1;
+            writes[1].dstArrayElement   = 0;
+            writes[1].descriptorCount   = maxNumMipLevelsPerDispatch;
+            writes[1].descriptorType    = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[1].pImageInfo        = dstImageInfos;
+            writes[1].pBufferInfo       = nullptr;
+            writes[1].pTexelBufferView  = nullptr;
+        }
+        vkCmdPushDescriptorSetKHR(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0, 2, writes);
+
+        /* Push constants for source MIP level and dispatch one work group per tile and array layer */
+        const std::uint32_t srcWidth    = GetMipLevelSize(extent.width,  srcMipLevel);
+        const std::uint32_t srcHeight   = GetMipLevelSize(extent.height, srcMipLevel);
+
+        VKMipGenerationConstants constants;
+        {
+            constants.texelSize[0]      = 1.0f / static_cast<float>(srcWidth);
+            constants.texelSize[1]      = 1.0f / static_cast<float>(srcHeight);
+            constants.srcExtent[0]      = srcWidth;
+            constants.srcExtent[1]      = srcHeight;
+            constants.numMipLevels      = numMipLevels;
+            constants.baseArrayLayer    = subresource.baseArrayLayer;
+        }
+        vkCmdPushConstants(commandBuffer, pipelineLayout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+
+        vkCmdDispatch(
+            commandBuffer,
+            (srcWidth  + g_mipGenerationTileSize - 1) / g_mipGenerationTileSize,
+            (srcHeight + g_mipGenerationTileSize - 1) / g_mipGenerationTileSize,
+            subresource.numArrayLayers
+        );
+
+        /* Transition destination MIP levels back to read-only layout; the last one is the source of the next dispatch */
+        barriers.InsertImageBarrier(
+            image,
+            dstRange,
+            VK_IMAGE_LAYOUT_GENERAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT
+        );
+
+        srcMipLevel += numMipLevels;
+    }
+
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKMipGenerator::CreateDescriptorSetLayout(VkDevice device)
+{
+    /* Create immutable linear-clamp sampler for the source MIP level */
+    VkSamplerCreateInfo samplerInfo;
+    {
+        samplerInfo.sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.pNext                   = nullptr;
+        samplerInfo.flags                   = 0;
+        samplerInfo.magFilter               = VK_FILTER_LINEAR;
+        samplerInfo.minFilter               = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode              = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.mipLodBias              = 0.0f;
+        samplerInfo.anisotropyEnable        = VK_FALSE;
+        samplerInfo.maxAnisotropy           = 1.0f;
+        samplerInfo.compareEnable           = VK_FALSE;
+        samplerInfo.compareOp               = VK_COMPARE_OP_NEVER;
+        samplerInfo.minLod                  = 0.0f;
+        samplerInfo.maxLod                  = 0.0f;
+        samplerInfo.borderColor             = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+        samplerInfo.unnormalizedCoordinates = VK_FALSE;
+    }
+    linearClampSampler_ = VKPtr<VkSampler>{ device, vkDestroySampler };
+    VkResult result = vkCreateSampler(device, &samplerInfo, nullptr, linearClampSampler_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan sampler for MIP-map generation");
+
+    /* Create push descriptor set layout with source MIP level and destination MIP levels */
+    const VkSampler immutableSampler = linearClampSampler_.Get();
+
+    VkDescriptorSetLayoutBinding bindings[2];
+    {
+        bindings[0].binding             = 0;
+        bindings[0].descriptorType      = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount     = 1;
+        bindings[0].stageFlags          = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[0].pImmutableSamplers  = &immutableSampler;
+
+        bindings[1].binding             = 1;
+        bindings[1].descriptorType      = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[1].descriptorCount     = maxNumMipLevelsPerDispatch;
+        bindings[1].stageFlags          = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[1].pImmutableSamplers  = nullptr;
+    }
+    VkDescriptorSetLayoutCreateInfo createInfo;
+    {
+        createInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        createInfo.pNext        = nullptr;
+        createInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+        createInfo.bindingCount = 2;
+        createInfo.pBindings    = bindings;
+    }
+    descriptorSetLayout_ = VKPtr<VkDescriptorSetLayout>{ device, vkDestroyDescriptorSetLayout };
+    result = vkCreateDescriptorSetLayout(device, &createInfo, nullptr, descriptorSetLayout_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor set layout for MIP-map generation");
+}
+
+void VKMipGenerator::CreatePipelineLayout(VkDevice device)
+{
+    const VkDescriptorSetLayout setLayout = descriptorSetLayout_.Get();
+
+    VkPushConstantRange pushConstantRange;
+    {
+        pushConstantRange.stageFlags    = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset        = 0;
+        pushConstantRange.size          = sizeof(VKMipGenerationConstants);
+    }
+    VkPipelineLayoutCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.setLayoutCount           = 1;
+        createInfo.pSetLayouts              = &setLayout;
+        createInfo.pushConstantRangeCount   = 1;
+        createInfo.pPushConstantRanges      = &pushConstantRange;
+    }
+    pipelineLayout_ = VKPtr<VkPipelineLayout>{ device, vkDestroyPipelineLayout };
+    VkResult result = vkCreatePipelineLayout(device, &createInfo, nullptr, pipelineLayout_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline layout for MIP-map generation");
+}
+
+void VKMipGenerator::CreateComputePipeline(
+    VkDevice                device,
+    VkPipelineCache         pipelineCache,
+    const std::uint32_t*    code,
+    std::size_t             codeSize,
+    VKPtr<VkPipeline>&      outPipeline)
+{
+    /* Create temporary shader module; it is no longer needed once the pipeline has been created */
+    VKPtr<VkShaderModule> shaderModule{ device, vkDestroyShaderModule };
+    {
+        VkShaderModuleCreateInfo createInfo;
+        {
+            createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            createInfo.pNext    = nullptr;
+            createInfo.flags    = 0;
+            createInfo.codeSize = codeSize;
+            createInfo.pCode    = code;
+        }
+        VkResult result = vkCreateShaderModule(device, &createInfo, nullptr, shaderModule.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan shader module for MIP-map generation");
+    }
+
+    VkComputePipelineCreateInfo createInfo;
+    {
+        createInfo.sType                        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        createInfo.pNext                        = nullptr;
+        createInfo.flags                        = 0;
+        createInfo.stage.sType                  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        createInfo.stage.pNext                  = nullptr;
+        createInfo.stage.flags                  = 0;
+        createInfo.stage.stage                  = VK_SHADER_STAGE_COMPUTE_BIT;
+        createInfo.stage.module                 = shaderModule.Get();
+        createInfo.stage.pName                  = "main";
+        createInfo.stage.pSpecializationInfo    = nullptr;
+        createInfo.layout                       = pipelineLayout_.Get();
+        createInfo.basePipelineHandle           = VK_NULL_HANDLE;
+        createInfo.basePipelineIndex            = 0;
+    }
+    outPipeline = VKPtr<VkPipeline>{ device, vkDestroyPipeline };
+    VkResult result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, outPipeline.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan compute pipeline for MIP-map generation");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,120 @@
+/*
+ * VKMipGenerator.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_MIP_GENERATOR_H
+#define LLGL_VK_MIP_GENERATOR_H
+
+
+#include <LLGL/TextureFlags.h>
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKTexture;
+class VKPhysicalDevice;
+class VKBarrierAccumulator;
+struct TextureSubresource;
+
+/*
+Vulkan MIP-map generator singleton.
+Generates up to 6 MIP levels per dispatch with a compute shader and falls back to a chain of blit commands
+for all textures that cannot be written as storage images.
+*/
+class VKMipGenerator
+{
+
+    public:
+
+        // Maximum number of MIP levels that are generated with a single dispatch.
+        static constexpr std::uint32_t maxNumMipLevelsPerDispatch = 6;
+
+    public:
+
+        // Returns the singleton instance.
+        static VKMipGenerator& Get();
+
+        // Returns the format that is used for storage image views of the specified format, i.e. the UNORM equivalent of sRGB formats.
+        static VkFormat GetStorageFormat(VkFormat format);
+
+    public:
+
+        VKMipGenerator(const VKMipGenerator&) = delete;
+        VKMipGenerator& operator = (const VKMipGenerator&) = delete;
+
+        VKMipGenerator(VKMipGenerator&&) = delete;
+        VKMipGenerator& operator = (VKMipGenerator&&) = delete;
+
+        // Creates the compute pipelines if 'enabled' is true and the physical device supports all required features.
+        void InitializeDevice(
+            VkDevice                device,
+            const VKPhysicalDevice& physicalDevice,
+            VkPipelineCache         pipelineCache,
+            bool                    enabled
+        );
+
+        // Releases all Vulkan objects (used by VKRenderSystem).
+        void Clear();
+
+        // Returns true if textures of the specified type and format can generate their MIP-maps with the compute shader.
+        bool IsSupported(const TextureType type, VkFormat format) const;
+
+        /*
+        Records the commands to generate the MIP-maps of the specified texture subresource into the command buffer.
+        Returns true if the compute shader was used, in which case the compute pipeline binding of the command buffer has been replaced.
+        Otherwise, the MIP-maps were generated with blit commands.
+        */
+        bool GenerateMips(
+            VKDevice&                   device,
+            VkCommandBuffer             commandBuffer,
+            VKBarrierAccumulator&       barriers,
+            VKTexture&                  texture,
+            const TextureSubresource&   subresource
+        );
+
+    private:
+
+        VKMipGenerator() = default;
+
+        void CreateDescriptorSetLayout(VkDevice device);
+        void CreatePipelineLayout(VkDevice device);
+        void CreateComputePipeline(
+            VkDevice                device,
+            VkPipelineCache         pipelineCache,
+            const std::uint32_t*    code,
+            std::size_t             codeSize,
+            VKPtr<VkPipeline>&      outPipeline
+        );
+
+    private:
+
+        VkPhysicalDevice                physicalDevice_         = VK_NULL_HANDLE;
+        bool                            hasExtendedUsage_       = false;
+
+        VKPtr<VkSampler>                linearClampSampler_;
+        VKPtr<VkDescriptorSetLayout>    descriptorSetLayout_;
+        VKPtr<VkPipelineLayout>         pipelineLayout_;
+        VKPtr<VkPipeline>               pipeline_;
+        VKPtr<VkPipeline>               pipelineSRGB_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
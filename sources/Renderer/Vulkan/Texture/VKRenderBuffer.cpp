@@ -7,6 +7,7 @@
 
 #include "VKRenderBuffer.h"
 #include "../Memory/VKDeviceMemoryManager.h"
+#include <utility>
 
 
 namespace LLGL
@@ -19,6 +20,31 @@ VKRenderBuffer::VKRenderBuffer(VkDevice device) :
 {
 }
 
+VKRenderBuffer::VKRenderBuffer(VKRenderBuffer&& rhs) :
+    VKDeviceImage { std::move(rhs)            },
+    imageView_    { std::move(rhs.imageView_) },
+    format_       { rhs.format_               },
+    memoryMngr_   { rhs.memoryMngr_           }
+{
+    rhs.format_     = VK_FORMAT_UNDEFINED;
+    rhs.memoryMngr_ = nullptr;
+}
+
+VKRenderBuffer& VKRenderBuffer::operator = (VKRenderBuffer&& rhs)
+{
+    if (this != &rhs)
+    {
+        Release();
+        VKDeviceImage::operator = (std::move(rhs));
+        imageView_      = std::move(rhs.imageView_);
+        format_         = rhs.format_;
+        memoryMngr_     = rhs.memoryMngr_;
+        rhs.format_     = VK_FORMAT_UNDEFINED;
+        rhs.memoryMngr_ = nullptr;
+    }
+    return *this;
+}
+
 VKRenderBuffer::~VKRenderBuffer()
 {
     Release();
@@ -30,7 +56,8 @@ void VKRenderBuffer::Create(
     VkFormat                format,
     VkImageAspectFlags      aspectFlags,
     VkSampleCountFlagBits   sampleCountBits,
-    VkImageUsageFlags       usageFlags)
+    VkImageUsageFlags       usageFlags,
+    bool                    isTransient)
 {
     if (format == VK_FORMAT_UNDEFINED)
         return;
@@ -51,11 +78,11 @@ void VKRenderBuffer::Create(
         /*numArrayLayers:*/     1,
         /*createFlags:*/        0,
         /*sampleCountBits:*/    sampleCountBits,
-        /*usageFlags:*/         usageFlags
+        /*usageFlags:*/         (isTransient ? usageFlags | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT : usageFlags)
     );
 
     /* Allocate device memory region */
-    AllocateMemoryRegion(deviceMemoryMngr);
+    AllocateMemoryRegion(deviceMemoryMngr, isTransient);
 
     /* Create depth-stencil image view */
     VkImageSubresourceRange subresourceRange;
@@ -25,17 +25,22 @@ class VKRenderBuffer : private VKDeviceImage
         VKRenderBuffer(VkDevice device);
         ~VKRenderBuffer();
 
-        // Explicit default move constructors required for GCC (to be used in VKSwapChain c'tor)
-        VKRenderBuffer(VKRenderBuffer&&) = default;
-        VKRenderBuffer& operator = (VKRenderBuffer&&) = default;
-
+        // Moved-from render buffers no longer own their device memory region, so their d'tor does not release it a second time.
+        VKRenderBuffer(VKRenderBuffer&& rhs);
+        VKRenderBuffer& operator = (VKRenderBuffer&& rhs);
+
+        /*
+        Creates the render buffer image and allocates its device memory.
+        If 'isTransient' is true, the image is created as transient attachment and bound to lazily allocated memory if available.
+        */
         void Create(
             VKDeviceMemoryManager&  deviceMemoryMngr,
             const Extent2D&         extent,
             VkFormat                format,
             VkImageAspectFlags      aspectFlags,
             VkSampleCountFlagBits   sampleCountBits,
-            VkImageUsageFlags       usageFlags
+            VkImageUsageFlags       usageFlags,
+            bool                    isTransient     = false
         );
 
         void Release();
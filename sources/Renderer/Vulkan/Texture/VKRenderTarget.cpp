@@ -10,9 +10,11 @@
 #include "../Memory/VKDeviceMemoryManager.h"
 #include "../../CheckedCast.h"
 #include "../../RenderTargetUtils.h"
+#include "../../RenderPassUtils.h"
 #include "../../../Core/CoreUtils.h"
 #include "../VKCore.h"
 #include "../VKTypes.h"
+#include "../Ext/VKExtensionRegistry.h"
 #include <vector>
 #include <algorithm>
 #include <LLGL/Utils/ForRange.h>
@@ -25,7 +27,8 @@ namespace LLGL
 VKRenderTarget::VKRenderTarget(
     VkDevice                        device,
     VKDeviceMemoryManager&          deviceMemoryMngr,
-    const RenderTargetDescriptor&   desc)
+    const RenderTargetDescriptor&   desc,
+    std::uint32_t                   shadingRateTexelSize)
 :
     resolution_          { desc.resolution                            },
     framebuffer_         { device, vkDestroyFramebuffer               },
@@ -39,6 +42,7 @@ VKRenderTarget::VKRenderTarget(
     {
         /* Get render pass from descriptor */
         renderPass_ = LLGL_CAST(const VKRenderPass*, desc.renderPass);
+        viewMask_   = renderPass_->GetViewMask();
     }
     else
     {
@@ -46,8 +50,14 @@ VKRenderTarget::VKRenderTarget(
         CreateDefaultRenderPass(device, desc);
         renderPass_ = (&defaultRenderPass_);
     }
-    CreateSecondaryRenderPass(device, desc);
+    /* Secondary render pass is only needed to resume a VkRenderPass; dynamic rendering loads all attachments on its own */
+    if (!HasExtension(VKExt::KHR_dynamic_rendering))
+        CreateSecondaryRenderPass(device, desc);
     CreateFramebuffer(device, deviceMemoryMngr, desc);
+
+    /* Shading-rate images are only supported with VK_KHR_dynamic_rendering */
+    if (desc.shadingRateImage != nullptr && shadingRateTexelSize > 0)
+        CreateShadingRateAttachment(device, *desc.shadingRateImage, shadingRateTexelSize);
 }
 
 Extent2D VKRenderTarget::GetResolution() const
@@ -98,6 +108,23 @@ static VkImageLayout GetFinalLayoutForAttachment(VkFormat format, long bindFlags
         return (VKTypes::IsVkFormatDepthStencil(format) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 }
 
+static VkImageAspectFlags GetDepthStencilAspectFlags(VkFormat format)
+{
+    if (VKTypes::IsVkFormatStencil(format))
+        return (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT);
+    else
+        return VK_IMAGE_ASPECT_DEPTH_BIT;
+}
+
+static VkResolveModeFlagBitsKHR GetResolveModeForFormat(const Format format)
+{
+    /* Integer formats cannot be averaged, so the first sample is taken instead */
+    if (IsIntegralFormat(format) && !IsNormalizedFormat(format))
+        return VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
+    else
+        return VK_RESOLVE_MODE_AVERAGE_BIT_KHR;
+}
+
 static void InitVkAttachmentDesc(
     VkAttachmentDescription&    outDesc,
     VkFormat                    format,
@@ -187,7 +214,7 @@ void VKRenderTarget::CreateRenderPass(
     }
 
     /* Create native Vulkan render pass with attachment descriptors */
-    renderPass.CreateVkRenderPassWithDescriptors(device, numTargetAttachments, numColorAttachments_, attachmentDescs, sampleCountBits_);
+    renderPass.CreateVkRenderPassWithDescriptors(device, numTargetAttachments, numColorAttachments_, attachmentDescs, sampleCountBits_, viewMask_);
 }
 
 void VKRenderTarget::CreateDefaultRenderPass(VkDevice device, const RenderTargetDescriptor& desc)
@@ -209,32 +236,45 @@ VkImageView VKRenderTarget::CreateAttachmentImageView(
     /* Validate texture resolution to render target (to validate correlation between attachments) */
     ValidateMipResolution(textureVK, attachmentDesc.mipLevel);
 
-    /* Create new image view for MIP-level and array layer specified in attachment descriptor */
+    /* Create new image view for MIP-level and array layer specified in attachment descriptor; multiview attachments cover one array layer per view */
+    const std::uint32_t numArrayLayers = (viewMask_ != 0 ? NumMultiviewArrayLayers(viewMask_) : 1);
     VKPtr<VkImageView> imageView{ device, vkDestroyImageView };
     {
-        textureVK.CreateImageView(device, TextureSubresource{ attachmentDesc.arrayLayer, attachmentDesc.mipLevel }, format, imageView);
+        textureVK.CreateImageView(device, TextureSubresource{ attachmentDesc.arrayLayer, numArrayLayers, attachmentDesc.mipLevel, 1 }, format, imageView);
     }
     imageViews_.emplace_back(std::move(imageView));
 
     return imageViews_.back().Get();
 }
 
-VkImageView VKRenderTarget::CreateColorBuffer(VKDeviceMemoryManager& deviceMemoryMngr, Format format)
+bool VKRenderTarget::IsTransientAttachment(std::uint32_t attachmentIndex) const
+{
+    const VkAttachmentDescription& attachmentDesc = renderPass_->GetAttachmentDesc(attachmentIndex);
+    return
+    (
+        attachmentDesc.loadOp           != VK_ATTACHMENT_LOAD_OP_LOAD   &&
+        attachmentDesc.storeOp          != VK_ATTACHMENT_STORE_OP_STORE &&
+        attachmentDesc.stencilLoadOp    != VK_ATTACHMENT_LOAD_OP_LOAD   &&
+        attachmentDesc.stencilStoreOp   != VK_ATTACHMENT_STORE_OP_STORE
+    );
+}
+
+VkImageView VKRenderTarget::CreateColorBuffer(VKDeviceMemoryManager& deviceMemoryMngr, Format format, bool isTransient)
 {
     /* Create new color buffer with sampling information */
     auto colorBuffer = MakeUnique<VKColorBuffer>(deviceMemoryMngr.GetVkDevice());
     {
-        colorBuffer->Create(deviceMemoryMngr, GetResolution(), VKTypes::Map(format), sampleCountBits_);
+        colorBuffer->Create(deviceMemoryMngr, GetResolution(), VKTypes::Map(format), sampleCountBits_, isTransient);
     }
     colorBuffers_.push_back(std::move(colorBuffer));
 
     return colorBuffers_.back()->GetVkImageView();
 }
 
-VkImageView VKRenderTarget::CreateDepthStencilBuffer(VKDeviceMemoryManager& deviceMemoryMngr, Format format)
+VkImageView VKRenderTarget::CreateDepthStencilBuffer(VKDeviceMemoryManager& deviceMemoryMngr, Format format, bool isTransient)
 {
     /* Create depth-stencil buffer */
-    depthStencilBuffer_.Create(deviceMemoryMngr, GetResolution(), GetDepthStencilVkFormat(format), sampleCountBits_);
+    depthStencilBuffer_.Create(deviceMemoryMngr, GetResolution(), GetDepthStencilVkFormat(format), sampleCountBits_, isTransient);
 
     /* Add depth-stencil image view to attachments */
     return depthStencilBuffer_.GetVkImageView();
@@ -263,11 +303,27 @@ void VKRenderTarget::CreateFramebuffer(
             auto& textureVK = LLGL_CAST(VKTexture&, *texture);
             const Format colorFormat = GetAttachmentFormat(colorAttachment);
             attachmentImageViews[i] = CreateAttachmentImageView(device, textureVK, colorFormat, colorAttachment);
+            VKInitRenderingAttachment(
+                renderingAttachments_.colorAttachments[i],
+                textureVK.GetVkImage(),
+                attachmentImageViews[i],
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                GetFinalLayoutForAttachment(VKTypes::Map(colorFormat), texture->GetBindFlags()),
+                colorAttachment.mipLevel,
+                colorAttachment.arrayLayer
+            );
         }
         else
         {
-            /* Create internal color buffer */
-            attachmentImageViews[i] = CreateColorBuffer(deviceMemoryMngr, colorAttachment.format);
+            /* Create internal color buffer; it can be transient if its content never leaves the render pass */
+            attachmentImageViews[i] = CreateColorBuffer(deviceMemoryMngr, colorAttachment.format, IsTransientAttachment(i));
+            VKInitRenderingAttachment(
+                renderingAttachments_.colorAttachments[i],
+                colorBuffers_.back()->GetVkImage(),
+                attachmentImageViews[i],
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+            );
         }
     }
 
@@ -281,11 +337,27 @@ void VKRenderTarget::CreateFramebuffer(
             /* Use attachment texture for depth-stencil view */
             auto& textureVK = LLGL_CAST(VKTexture&, *texture);
             attachmentImageViews[numColorAttachments_] = CreateAttachmentImageView(device, textureVK, depthStencilFormat_, depthStencilAttachment);
+            VKInitRenderingAttachment(
+                renderingAttachments_.depthStencilAttachment,
+                textureVK.GetVkImage(),
+                attachmentImageViews[numColorAttachments_],
+                GetDepthStencilAspectFlags(VKTypes::Map(depthStencilFormat_)),
+                GetFinalLayoutForAttachment(VKTypes::Map(depthStencilFormat_), texture->GetBindFlags()),
+                depthStencilAttachment.mipLevel,
+                depthStencilAttachment.arrayLayer
+            );
         }
         else
         {
-            /* Create internal depth-stencil buffer */
-            attachmentImageViews[numColorAttachments_] = CreateDepthStencilBuffer(deviceMemoryMngr, depthStencilFormat_);
+            /* Create internal depth-stencil buffer; it can be transient if its content never leaves the render pass */
+            attachmentImageViews[numColorAttachments_] = CreateDepthStencilBuffer(deviceMemoryMngr, depthStencilFormat_, IsTransientAttachment(numColorAttachments_));
+            VKInitRenderingAttachment(
+                renderingAttachments_.depthStencilAttachment,
+                depthStencilBuffer_.GetVkImage(),
+                attachmentImageViews[numColorAttachments_],
+                GetDepthStencilAspectFlags(depthStencilBuffer_.GetVkFormat()),
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+            );
         }
     }
 
@@ -302,11 +374,39 @@ void VKRenderTarget::CreateFramebuffer(
                 /* Use attachment texture for color buffer view */
                 auto& textureVK = LLGL_CAST(VKTexture&, *texture);
                 const Format colorFormat = GetAttachmentFormat(resolveAttachment);
-                attachmentImageViews[attachmentCount++] = CreateAttachmentImageView(device, textureVK, colorFormat, resolveAttachment);
+                attachmentImageViews[attachmentCount] = CreateAttachmentImageView(device, textureVK, colorFormat, resolveAttachment);
+                VKInitRenderingAttachment(
+                    renderingAttachments_.resolveAttachments[i],
+                    textureVK.GetVkImage(),
+                    attachmentImageViews[attachmentCount],
+                    VK_IMAGE_ASPECT_COLOR_BIT,
+                    GetFinalLayoutForAttachment(VKTypes::Map(colorFormat), texture->GetBindFlags()),
+                    resolveAttachment.mipLevel,
+                    resolveAttachment.arrayLayer,
+                    GetResolveModeForFormat(colorFormat)
+                );
+                ++attachmentCount;
             }
         }
     }
 
+    /* Layout transitions of multiview attachments must cover all array layers that are rendered into */
+    if (viewMask_ != 0)
+    {
+        const std::uint32_t numArrayLayers = NumMultiviewArrayLayers(viewMask_);
+        for_range(i, numColorAttachments_)
+        {
+            renderingAttachments_.colorAttachments[i].subresource.layerCount = numArrayLayers;
+            renderingAttachments_.resolveAttachments[i].subresource.layerCount = numArrayLayers;
+        }
+        renderingAttachments_.depthStencilAttachment.subresource.layerCount = numArrayLayers;
+    }
+
+    /* Attachments are rendered directly with VK_KHR_dynamic_rendering, so no framebuffer object is created */
+    renderingAttachments_.numColorAttachments = numColorAttachments_;
+    if (HasExtension(VKExt::KHR_dynamic_rendering))
+        return;
+
     /* Create framebuffer object */
     const Extent2D resolution = GetResolution();
     VkFramebufferCreateInfo createInfo;
@@ -325,6 +425,27 @@ void VKRenderTarget::CreateFramebuffer(
     VKThrowIfFailed(result, "failed to create Vulkan framebuffer");
 }
 
+void VKRenderTarget::CreateShadingRateAttachment(VkDevice device, Texture& texture, std::uint32_t texelSize)
+{
+    /* Create image view for the first MIP-map of the shading-rate image */
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+    VKPtr<VkImageView> imageView{ device, vkDestroyImageView };
+    {
+        textureVK.CreateImageView(device, TextureSubresource{ 0, 0 }, Format::R8UInt, imageView);
+    }
+    imageViews_.emplace_back(std::move(imageView));
+
+    /* Shading-rate image is kept in the same layout as any other uploaded texture outside of render passes */
+    VKInitRenderingAttachment(
+        renderingAttachments_.shadingRateAttachment,
+        textureVK.GetVkImage(),
+        imageViews_.back().Get(),
+        VK_IMAGE_ASPECT_COLOR_BIT,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    );
+    renderingAttachments_.shadingRateTexelSize = VkExtent2D{ texelSize, texelSize };
+}
+
 
 } // /namespace LLGL
 
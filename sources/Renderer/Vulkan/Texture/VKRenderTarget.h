@@ -13,6 +13,7 @@
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include "../RenderState/VKRenderPass.h"
+#include "../RenderState/VKDynamicRendering.h"
 #include "VKDepthStencilBuffer.h"
 #include "VKColorBuffer.h"
 #include <memory>
@@ -36,7 +37,8 @@ class VKRenderTarget final : public RenderTarget
         VKRenderTarget(
             VkDevice                        device,
             VKDeviceMemoryManager&          deviceMemoryMngr,
-            const RenderTargetDescriptor&   desc
+            const RenderTargetDescriptor&   desc,
+            std::uint32_t                   shadingRateTexelSize    = 0
         );
 
     public:
@@ -62,6 +64,12 @@ class VKRenderTarget final : public RenderTarget
             return secondaryRenderPass_.GetVkRenderPass();
         }
 
+        // Returns the framebuffer attachments for VK_KHR_dynamic_rendering.
+        inline const VKRenderingAttachments& GetRenderingAttachments() const
+        {
+            return renderingAttachments_;
+        }
+
         // Returns the render target resolution as VkExtent2D.
         inline VkExtent2D GetVkExtent() const
         {
@@ -87,8 +95,11 @@ class VKRenderTarget final : public RenderTarget
             const AttachmentDescriptor& attachmentDesc
         );
 
-        VkImageView CreateColorBuffer(VKDeviceMemoryManager& deviceMemoryMngr, Format format);
-        VkImageView CreateDepthStencilBuffer(VKDeviceMemoryManager& deviceMemoryMngr, Format format);
+        // Returns true if the render pass neither loads nor stores the specified attachment, so an internal buffer can be transient.
+        bool IsTransientAttachment(std::uint32_t attachmentIndex) const;
+
+        VkImageView CreateColorBuffer(VKDeviceMemoryManager& deviceMemoryMngr, Format format, bool isTransient);
+        VkImageView CreateDepthStencilBuffer(VKDeviceMemoryManager& deviceMemoryMngr, Format format, bool isTransient);
 
         void CreateFramebuffer(
             VkDevice                        device,
@@ -96,6 +107,8 @@ class VKRenderTarget final : public RenderTarget
             const RenderTargetDescriptor&   desc
         );
 
+        void CreateShadingRateAttachment(VkDevice device, Texture& texture, std::uint32_t texelSize);
+
     private:
 
         using VKColorBufferPtr = std::unique_ptr<VKColorBuffer>;
@@ -108,6 +121,8 @@ class VKRenderTarget final : public RenderTarget
         VKRenderPass                    secondaryRenderPass_;
 
         std::vector<VKPtr<VkImageView>> imageViews_;
+        VKRenderingAttachments          renderingAttachments_;
+        std::uint32_t                   viewMask_               = 0;                    // Multiview mask from the render pass in the descriptor
 
         VKDepthStencilBuffer            depthStencilBuffer_;
         Format                          depthStencilFormat_     = Format::Undefined;    // Format either from internal depth-stencil buffer or attachmed texture.
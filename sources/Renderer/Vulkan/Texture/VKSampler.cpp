@@ -15,9 +15,35 @@ namespace LLGL
 {
 
 
-VKSampler::VKSampler(VkDevice device, const SamplerDescriptor& desc) :
-    sampler_ { VKSampler::CreateVkSampler(device, desc) }
+VKSampler::VKSampler(VkDevice device, SamplerCache<VkSampler>& samplerCache, const SamplerDescriptor& desc) :
+    device_       { device       },
+    samplerCache_ { samplerCache },
+    desc_         { desc         }
 {
+    sampler_ = samplerCache_.Acquire(
+        desc,
+        [device](const SamplerDescriptor& samplerDesc) -> VkSampler
+        {
+            VkSamplerCreateInfo createInfo;
+            VKSampler::ConvertDesc(createInfo, samplerDesc);
+            VkSampler sampler = VK_NULL_HANDLE;
+            VkResult result = vkCreateSampler(device, &createInfo, nullptr, &sampler);
+            VKThrowIfFailed(result, "failed to create Vulkan sampler");
+            return sampler;
+        }
+    );
+}
+
+VKSampler::~VKSampler()
+{
+    VkDevice device = device_;
+    samplerCache_.Release(
+        desc_,
+        [device](VkSampler sampler)
+        {
+            vkDestroySampler(device, sampler, nullptr);
+        }
+    );
 }
 
 static VkFilter GetVkFilter(const SamplerFilter filter)
@@ -12,6 +12,7 @@
 #include <LLGL/Sampler.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
+#include "../../SamplerCache.h"
 
 
 namespace LLGL
@@ -23,12 +24,14 @@ class VKSampler final : public Sampler
 
     public:
 
-        VKSampler(VkDevice device, const SamplerDescriptor& desc);
+        // Acquires a Vulkan sampler from the specified cache; identical descriptors share one VkSampler.
+        VKSampler(VkDevice device, SamplerCache<VkSampler>& samplerCache, const SamplerDescriptor& desc);
+        ~VKSampler();
 
         // Returns the Vulkan sampler object.
         inline VkSampler GetVkSampler() const
         {
-            return sampler_.Get();
+            return sampler_;
         }
 
     public:
@@ -41,7 +44,10 @@ class VKSampler final : public Sampler
 
     private:
 
-        VKPtr<VkSampler> sampler_;
+        VkDevice                    device_         = VK_NULL_HANDLE;
+        SamplerCache<VkSampler>&    samplerCache_;
+        VkSampler                   sampler_        = VK_NULL_HANDLE;
+        SamplerDescriptor           desc_;
 
 };
 
@@ -6,13 +6,21 @@
  */
 
 #include "VKTexture.h"
+#include "VKMipGenerator.h"
+#include "VKTextureCompressor.h"
+#include "VKHostImageCopy.h"
 #include "../VKDevice.h"
+#include "../VKCommandQueue.h"
 #include "../Memory/VKDeviceMemory.h"
+#include "../Memory/VKSparseTileMap.h"
+#include "../Memory/VKExternalHandle.h"
 #include "../../TextureUtils.h"
 #include "../../../Core/CoreUtils.h"
 #include "../VKTypes.h"
 #include "../VKCore.h"
+#include <LLGL/Utils/ForRange.h>
 #include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -20,7 +28,7 @@ namespace LLGL
 
 
 VKTexture::VKTexture(
-    VkDevice                    device,
+    const VKDevice&             device,
     VKDeviceMemoryManager&      deviceMemoryMngr,
     const TextureDescriptor&    desc)
 :
@@ -31,7 +39,20 @@ VKTexture::VKTexture(
 {
     /* Create Vulkan image and allocate memory region */
     CreateImage(device, desc);
-    image_.AllocateMemoryRegion(deviceMemoryMngr);
+    if ((desc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        /* Sparse images are bound to device memory per tile via the command queue */
+        image_.QueryMemoryRequirements(device);
+        sparseTileMap_ = MakeUnique<VKSparseTileMap>(deviceMemoryMngr, image_.GetMemoryRequirements());
+        QuerySparseMemoryRequirements(device);
+    }
+    else
+        image_.AllocateMemoryRegion(deviceMemoryMngr, ((desc.miscFlags & MiscFlags::Transient) != 0));
+}
+
+VKTexture::~VKTexture()
+{
+    // dummy
 }
 
 Extent3D VKTexture::GetMipExtent(std::uint32_t mipLevel) const
@@ -119,6 +140,9 @@ TextureDescriptor VKTexture::GetDesc() const
             break;
     }
 
+    if (IsSparse())
+        texDesc.miscFlags |= MiscFlags::Sparse;
+
     return texDesc;
 }
 
@@ -135,6 +159,16 @@ SubresourceFootprint VKTexture::GetSubresourceFootprint(std::uint32_t mipLevel)
     return footprint;
 }
 
+Extent3D VKTexture::GetSparseTileExtent() const
+{
+    if (IsSparse())
+    {
+        const VkExtent3D& granularity = sparseRequirements_.formatProperties.imageGranularity;
+        return Extent3D{ granularity.width, granularity.height, granularity.depth };
+    }
+    return Extent3D{};
+}
+
 void VKTexture::CreateImageView(
     VkDevice                    device,
     const TextureSubresource&   subresource,
@@ -149,7 +183,7 @@ void VKTexture::CreateImageView(
         subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
         subresourceRange.layerCount     = subresource.numArrayLayers;
     }
-    image_.CreateVkImageView(device, VKTypes::Map(GetType()), VKTypes::Map(format), subresourceRange, outImageView);
+    image_.CreateVkImageView(device, VKTypes::Map(GetType()), VKTypes::Map(format), subresourceRange, outImageView, nullptr, viewUsageFlags_);
 }
 
 void VKTexture::CreateImageView(
@@ -172,7 +206,9 @@ void VKTexture::CreateImageView(
             VKTypes::Map(textureViewDesc.type),
             VKTypes::Map(textureViewDesc.format),
             subresourceRange,
-            outImageView
+            outImageView,
+            nullptr,
+            viewUsageFlags_
         );
     }
     else
@@ -190,7 +226,8 @@ void VKTexture::CreateImageView(
             VKTypes::Map(textureViewDesc.format),
             subresourceRange,
             outImageView,
-            &components
+            &components,
+            viewUsageFlags_
         );
     }
 }
@@ -205,7 +242,49 @@ void VKTexture::CreateInternalImageView(VkDevice device)
         subresourceRange.baseArrayLayer = 0;
         subresourceRange.layerCount     = GetNumArrayLayers();
     }
-    image_.CreateVkImageView(device, VKTypes::Map(GetType()), format_, subresourceRange, imageView_);
+    image_.CreateVkImageView(device, VKTypes::Map(GetType()), format_, subresourceRange, imageView_, nullptr, viewUsageFlags_);
+}
+
+VkImageView VKTexture::GetOrCreateMipLevelView(VkDevice device, std::uint32_t mipLevel, bool storage)
+{
+    /* Allocate container for a sampled and storage view per MIP level on first use */
+    if (mipLevelViews_.empty())
+    {
+        mipLevelViews_.reserve(numMipLevels_ * 2);
+        for_range(i, numMipLevels_ * 2)
+            mipLevelViews_.emplace_back(device, vkDestroyImageView);
+    }
+
+    VKPtr<VkImageView>& imageView = mipLevelViews_[mipLevel * 2 + (storage ? 1 : 0)];
+    if (imageView.Get() == VK_NULL_HANDLE)
+    {
+        VkImageSubresourceRange subresourceRange;
+        {
+            subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            subresourceRange.baseMipLevel   = mipLevel;
+            subresourceRange.levelCount     = 1;
+            subresourceRange.baseArrayLayer = 0;
+            subresourceRange.layerCount     = numArrayLayers_;
+        }
+        if (storage)
+        {
+            /* Storage views of compressed textures reinterpret each block as a single texel of an uncompressed format */
+            const VkFormat storageFormat = (computeCompression_ ? VKTextureCompressor::GetBlockFormat(format_) : VKMipGenerator::GetStorageFormat(format_));
+            image_.CreateVkImageView(
+                device,
+                VK_IMAGE_VIEW_TYPE_2D_ARRAY,
+                storageFormat,
+                subresourceRange,
+                imageView,
+                nullptr,
+                (storageFormat != format_ ? VK_IMAGE_USAGE_STORAGE_BIT : 0)
+            );
+        }
+        else
+            image_.CreateVkImageView(device, VK_IMAGE_VIEW_TYPE_2D_ARRAY, format_, subresourceRange, imageView, nullptr, viewUsageFlags_);
+    }
+
+    return imageView.Get();
 }
 
 VkImageLayout VKTexture::TransitionImageLayout(
@@ -230,6 +309,213 @@ VkImageLayout VKTexture::TransitionImageLayout(
     return image_.TransitionImageLayout(device, commandBuffer, GetVkFormat(), newLayout, subresource);
 }
 
+VkImageLayout VKTexture::TransitionImageLayoutOnHost(VkDevice device, VkImageLayout newLayout)
+{
+    return image_.TransitionImageLayoutOnHost(
+        device,
+        GetAspectFlags(),
+        newLayout,
+        TextureSubresource{ 0, numArrayLayers_, 0, numMipLevels_ }
+    );
+}
+
+static VkSparseMemoryBind AllocSparseOpaqueBind(
+    VKSparseTileMap&        tileMap,
+    VkDeviceSize            resourceOffset,
+    VkDeviceSize            size,
+    VkSparseMemoryBindFlags flags)
+{
+    VKDeviceMemoryRegion* region = tileMap.AllocPersistentRegion(size);
+    if (region == nullptr)
+        throw std::runtime_error("failed to allocate device memory for Vulkan sparse image MIP tail");
+
+    VkSparseMemoryBind bind;
+    {
+        bind.resourceOffset = resourceOffset;
+        bind.size           = size;
+        bind.memory         = region->GetParentChunk()->GetVkDeviceMemory();
+        bind.memoryOffset   = region->GetOffset();
+        bind.flags          = flags;
+    }
+    return bind;
+}
+
+static void AppendSparseMipTailBinds(
+    std::vector<VkSparseMemoryBind>&        binds,
+    VKSparseTileMap&                        tileMap,
+    const VkSparseImageMemoryRequirements&  requirements,
+    std::uint32_t                           numArrayLayers,
+    VkSparseMemoryBindFlags                 flags)
+{
+    /* Either all array layers share a single MIP tail or each array layer has its own MIP tail */
+    const bool isSingleMipTail = ((requirements.formatProperties.flags & VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT) != 0);
+    const std::uint32_t numMipTails = (isSingleMipTail ? 1u : numArrayLayers);
+    for_range(arrayLayer, numMipTails)
+    {
+        const VkDeviceSize offset = requirements.imageMipTailOffset + requirements.imageMipTailStride * arrayLayer;
+        binds.push_back(AllocSparseOpaqueBind(tileMap, offset, requirements.imageMipTailSize, flags));
+    }
+}
+
+void VKTexture::BindSparseMipTail(VKCommandQueue& commandQueue)
+{
+    if (!IsSparse())
+        return;
+
+    std::vector<VkSparseMemoryBind> binds;
+
+    /* Bind MIP tail if there are any MIP-maps smaller than the tile size */
+    if (sparseRequirements_.imageMipTailFirstLod < numMipLevels_)
+        AppendSparseMipTailBinds(binds, *sparseTileMap_, sparseRequirements_, numArrayLayers_, 0);
+
+    /* Bind metadata if the implementation requires it */
+    if (hasSparseMetadata_)
+        AppendSparseMipTailBinds(binds, *sparseTileMap_, sparseMetadataRequirements_, numArrayLayers_, VK_SPARSE_MEMORY_BIND_METADATA_BIT);
+
+    if (binds.empty())
+        return;
+
+    VkSparseImageOpaqueMemoryBindInfo opaqueBindInfo;
+    {
+        opaqueBindInfo.image        = GetVkImage();
+        opaqueBindInfo.bindCount    = static_cast<std::uint32_t>(binds.size());
+        opaqueBindInfo.pBinds       = binds.data();
+    }
+    VkBindSparseInfo bindInfo = {};
+    {
+        bindInfo.sType                  = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+        bindInfo.imageOpaqueBindCount   = 1;
+        bindInfo.pImageOpaqueBinds      = &opaqueBindInfo;
+    }
+    std::vector<VKDeviceMemoryRegion*> retiredRegions;
+    commandQueue.BindSparseMemory(bindInfo, retiredRegions);
+}
+
+// Returns the range of tiles covered by the specified texel range: rounded outwards if made resident and inwards otherwise.
+static void GetTileRange(
+    std::uint32_t   offset,
+    std::uint32_t   extent,
+    std::uint32_t   mipSize,
+    std::uint32_t   tileSize,
+    bool            resident,
+    std::uint32_t&  outBegin,
+    std::uint32_t&  outEnd)
+{
+    const std::uint32_t numTiles    = (mipSize + tileSize - 1) / tileSize;
+    const std::uint32_t end         = std::min(offset + extent, mipSize);
+    if (resident)
+    {
+        outBegin    = offset / tileSize;
+        outEnd      = (end + tileSize - 1) / tileSize;
+    }
+    else
+    {
+        outBegin    = (offset + tileSize - 1) / tileSize;
+        outEnd      = (end == mipSize ? numTiles : end / tileSize);
+    }
+    outEnd = std::min(outEnd, numTiles);
+}
+
+void VKTexture::UpdateTileMappings(VKCommandQueue& commandQueue, std::uint32_t numMappings, const TextureTileMapping* mappings)
+{
+    if (!IsSparse())
+        return;
+
+    const VkExtent3D& granularity = sparseRequirements_.formatProperties.imageGranularity;
+    const VkImageAspectFlags aspectMask = sparseRequirements_.formatProperties.aspectMask;
+
+    std::vector<VkSparseImageMemoryBind> binds;
+    std::vector<VKDeviceMemoryRegion*> retiredRegions;
+
+    for_range(i, numMappings)
+    {
+        const TextureTileMapping&   mapping     = mappings[i];
+        const TextureSubresource&   subresource = mapping.region.subresource;
+
+        /* Ignore MIP-maps that are part of the MIP tail */
+        const std::uint32_t mipLevel = subresource.baseMipLevel;
+        if (mipLevel >= sparseRequirements_.imageMipTailFirstLod || mipLevel >= numMipLevels_)
+            continue;
+
+        /* Determine range of tiles within the MIP-map */
+        const std::uint32_t mipWidth    = std::max(1u, extent_.width  >> mipLevel);
+        const std::uint32_t mipHeight   = std::max(1u, extent_.height >> mipLevel);
+
+        std::uint32_t beginX = 0, endX = 0, beginY = 0, endY = 0;
+        GetTileRange(static_cast<std::uint32_t>(mapping.region.offset.x), mapping.region.extent.width,  mipWidth,  granularity.width,  mapping.resident, beginX, endX);
+        GetTileRange(static_cast<std::uint32_t>(mapping.region.offset.y), mapping.region.extent.height, mipHeight, granularity.height, mapping.resident, beginY, endY);
+
+        const std::uint32_t endArrayLayer = std::min(subresource.baseArrayLayer + subresource.numArrayLayers, numArrayLayers_);
+        for (std::uint32_t arrayLayer = subresource.baseArrayLayer; arrayLayer < endArrayLayer; ++arrayLayer)
+        {
+            for (std::uint32_t y = beginY; y < endY; ++y)
+            {
+                for (std::uint32_t x = beginX; x < endX; ++x)
+                {
+                    const std::uint64_t key =
+                    (
+                        (static_cast<std::uint64_t>(arrayLayer) << 40) |
+                        (static_cast<std::uint64_t>(mipLevel)   << 32) |
+                        (static_cast<std::uint64_t>(y)          << 16) |
+                        x
+                    );
+
+                    /* Allocate a new tile or retire the old one; memory regions of retired tiles are released once the unbinding has completed */
+                    VKDeviceMemoryRegion* region = nullptr;
+                    if (mapping.resident)
+                    {
+                        region = sparseTileMap_->AllocTile(key);
+                        if (region == nullptr)
+                            continue;
+                    }
+                    else
+                    {
+                        VKDeviceMemoryRegion* retiredRegion = sparseTileMap_->RemoveTile(key);
+                        if (retiredRegion == nullptr)
+                            continue;
+                        retiredRegions.push_back(retiredRegion);
+                    }
+
+                    /* Tiles at the right and bottom edges of a MIP-map may be smaller than the granularity */
+                    VkSparseImageMemoryBind bind;
+                    {
+                        bind.subresource.aspectMask = aspectMask;
+                        bind.subresource.mipLevel   = mipLevel;
+                        bind.subresource.arrayLayer = arrayLayer;
+                        bind.offset.x               = static_cast<std::int32_t>(x * granularity.width);
+                        bind.offset.y               = static_cast<std::int32_t>(y * granularity.height);
+                        bind.offset.z               = 0;
+                        bind.extent.width           = std::min(granularity.width,  mipWidth  - x * granularity.width);
+                        bind.extent.height          = std::min(granularity.height, mipHeight - y * granularity.height);
+                        bind.extent.depth           = 1;
+                        bind.memory                 = (region != nullptr ? region->GetParentChunk()->GetVkDeviceMemory() : VK_NULL_HANDLE);
+                        bind.memoryOffset           = (region != nullptr ? region->GetOffset() : 0);
+                        bind.flags                  = 0;
+                    }
+                    binds.push_back(bind);
+                }
+            }
+        }
+    }
+
+    if (binds.empty())
+        return;
+
+    VkSparseImageMemoryBindInfo imageBindInfo;
+    {
+        imageBindInfo.image     = GetVkImage();
+        imageBindInfo.bindCount = static_cast<std::uint32_t>(binds.size());
+        imageBindInfo.pBinds    = binds.data();
+    }
+    VkBindSparseInfo bindInfo = {};
+    {
+        bindInfo.sType          = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+        bindInfo.imageBindCount = 1;
+        bindInfo.pImageBinds    = &imageBindInfo;
+    }
+    commandQueue.BindSparseMemory(bindInfo, retiredRegions);
+}
+
 static VkImageAspectFlags GetAspectFlagsByFormat(VkFormat format)
 {
     switch (format)
@@ -278,6 +564,10 @@ static VkImageCreateFlags GetVkImageCreateFlags(const TextureDescriptor& desc)
             break;
     }
 
+    /* Sparse textures are bound to device memory per tile and may have non-resident tiles */
+    if ((desc.miscFlags & MiscFlags::Sparse) != 0)
+        createFlags |= (VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT);
+
     return createFlags;
 }
 
@@ -359,6 +649,15 @@ static VkSampleCountFlagBits GetVkImageSampleCountFlags(const TextureDescriptor&
 
 static VkImageUsageFlags GetVkImageUsageFlags(const TextureDescriptor& desc)
 {
+    /* Transient attachments can only be used as attachments, not for sampling, storage, or transfer operations */
+    if ((desc.miscFlags & MiscFlags::Transient) != 0)
+    {
+        if ((desc.bindFlags & BindFlags::ColorAttachment) != 0)
+            return (VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+        if ((desc.bindFlags & BindFlags::DepthStencilAttachment) != 0)
+            return (VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    }
+
     VkImageUsageFlags usageFlags = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
     /* Enable TRANSFER_SRC_BIT image usage when MIP-maps are enabled */
@@ -379,6 +678,10 @@ static VkImageUsageFlags GetVkImageUsageFlags(const TextureDescriptor& desc)
     if ((desc.bindFlags & BindFlags::Storage) != 0)
         usageFlags |= VK_IMAGE_USAGE_STORAGE_BIT;
 
+    /* Enable usage as shading-rate image for variable rate shading */
+    if ((desc.bindFlags & BindFlags::ShadingRateAttachment) != 0)
+        usageFlags |= VK_IMAGE_USAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
+
     #if 0//???
     /* Enable input attachment bit when used for reading AND as attachment */
     if ( (desc.bindFlags & (BindFlags::Sampled         | BindFlags::Storage               )) != 0 &&
@@ -391,7 +694,13 @@ static VkImageUsageFlags GetVkImageUsageFlags(const TextureDescriptor& desc)
     return usageFlags;
 }
 
-void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc)
+// Returns true if the texture memory can be exported via RenderSystem::ExportMemoryHandle.
+static bool IsExportableTexture(const TextureDescriptor& desc)
+{
+    return ((desc.miscFlags & (MiscFlags::External | MiscFlags::Sparse | MiscFlags::Transient)) == MiscFlags::External && VKIsExternalMemorySupported());
+}
+
+void VKTexture::CreateImage(const VKDevice& device, const TextureDescriptor& desc)
 {
     /* Setup texture parameters */
     VkImageType imageType = GetVkImageType(desc.type);
@@ -401,6 +710,41 @@ void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc)
     numArrayLayers_     = GetVkImageArrayLayers(desc, imageType);
     sampleCountBits_    = GetVkImageSampleCountFlags(desc);
 
+    VkImageCreateFlags  createFlags = GetVkImageCreateFlags(desc);
+    VkImageUsageFlags   usageFlags  = GetVkImageUsageFlags(desc);
+
+    /* Enable storage usage to generate MIP-maps with a compute shader; sparse textures fall back to blit commands and transient textures have no MIP-maps */
+    if (numMipLevels_ > 1 && (desc.miscFlags & (MiscFlags::Sparse | MiscFlags::Transient)) == 0 && VKMipGenerator::Get().IsSupported(desc.type, format_))
+    {
+        usageFlags |= (VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT);
+        computeMipGeneration_ = true;
+
+        /* Storage views of sRGB formats use their UNORM equivalent, which requires extended usage for all other views */
+        if (VKMipGenerator::GetStorageFormat(format_) != format_)
+        {
+            createFlags |= (VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT_KHR);
+            viewUsageFlags_ = GetVkImageUsageFlags(desc) | VK_IMAGE_USAGE_SAMPLED_BIT;
+        }
+    }
+    else if ((desc.bindFlags & BindFlags::Storage) != 0 && (desc.miscFlags & (MiscFlags::Sparse | MiscFlags::Transient)) == 0 && VKTextureCompressor::Get().IsSupported(format_))
+    {
+        /* Compressed formats cannot be written as storage images, so only their block-texel views have storage usage */
+        createFlags |= (VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_BLOCK_TEXEL_VIEW_COMPATIBLE_BIT_KHR | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT_KHR);
+        viewUsageFlags_ = (usageFlags & ~VK_IMAGE_USAGE_STORAGE_BIT);
+        computeCompression_ = true;
+    }
+
+    /* Enable host image copies for initial data and small texture updates if this does not impair device access */
+    if ((desc.miscFlags & (MiscFlags::Sparse | MiscFlags::Transient)) == 0 && sampleCountBits_ == VK_SAMPLE_COUNT_1_BIT)
+    {
+        const VkImageUsageFlags hostUsageFlags = (usageFlags | VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT);
+        if (VKHostImageCopy::Get().IsSupported(imageType, format_, createFlags, hostUsageFlags))
+        {
+            usageFlags      = hostUsageFlags;
+            hostImageCopy_  = true;
+        }
+    }
+
     /* Create image object */
     image_.CreateVkImage(
         device,
@@ -409,12 +753,39 @@ void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc)
         extent_,
         numMipLevels_,
         numArrayLayers_,
-        GetVkImageCreateFlags(desc),
+        createFlags,
         sampleCountBits_,
-        GetVkImageUsageFlags(desc)
+        usageFlags,
+        device.GetSharedQueueFamilies(),
+        IsExportableTexture(desc)
     );
 }
 
+void VKTexture::QuerySparseMemoryRequirements(VkDevice device)
+{
+    std::uint32_t numRequirements = 0;
+    vkGetImageSparseMemoryRequirements(device, GetVkImage(), &numRequirements, nullptr);
+
+    std::vector<VkSparseImageMemoryRequirements> requirements(numRequirements);
+    vkGetImageSparseMemoryRequirements(device, GetVkImage(), &numRequirements, requirements.data());
+
+    /* Store requirements for the image aspect and the optional metadata aspect */
+    const VkImageAspectFlags aspectMask = GetAspectFlags();
+    for (const VkSparseImageMemoryRequirements& req : requirements)
+    {
+        if ((req.formatProperties.aspectMask & VK_IMAGE_ASPECT_METADATA_BIT) != 0)
+        {
+            sparseMetadataRequirements_ = req;
+            hasSparseMetadata_          = true;
+        }
+        else if ((req.formatProperties.aspectMask & aspectMask) != 0)
+            sparseRequirements_ = req;
+    }
+
+    if (sparseRequirements_.formatProperties.imageGranularity.width == 0)
+        throw std::runtime_error("failed to query sparse memory requirements for Vulkan image");
+}
+
 
 } // /namespace LLGL
 
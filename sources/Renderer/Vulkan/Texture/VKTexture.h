@@ -14,6 +14,8 @@
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include <cstdint>
+#include <vector>
+#include <memory>
 
 
 namespace LLGL
@@ -23,6 +25,8 @@ namespace LLGL
 class VKDevice;
 class VKDeviceMemoryRegion;
 class VKDeviceMemoryManager;
+class VKCommandQueue;
+class VKSparseTileMap;
 
 class VKTexture final : public Texture
 {
@@ -34,10 +38,11 @@ class VKTexture final : public Texture
     public:
 
         VKTexture(
-            VkDevice                    device,
+            const VKDevice&             device,
             VKDeviceMemoryManager&      deviceMemoryMngr,
             const TextureDescriptor&    desc
         );
+        ~VKTexture();
 
     public:
 
@@ -74,6 +79,25 @@ class VKTexture final : public Texture
             const TextureSubresource&   subresource
         );
 
+        // Transitions this entire image to the specified new layout on the host and returns the old layout. See HasHostImageCopy().
+        VkImageLayout TransitionImageLayoutOnHost(VkDevice device, VkImageLayout newLayout);
+
+        /*
+        Returns a 2D-array image view of the specified MIP level that covers all array layers and creates it on demand.
+        Storage views use the UNORM equivalent of sRGB formats. These views are used to generate MIP-maps with a compute shader.
+        */
+        VkImageView GetOrCreateMipLevelView(
+            VkDevice        device,
+            std::uint32_t   mipLevel,
+            bool            storage
+        );
+
+        // Binds persistent device memory to the MIP tail of this sparse texture. This has no effect if this is not a sparse texture.
+        void BindSparseMipTail(VKCommandQueue& commandQueue);
+
+        // Binds or unbinds device memory for the tiles of this sparse texture.
+        void UpdateTileMappings(VKCommandQueue& commandQueue, std::uint32_t numMappings, const TextureTileMapping* mappings);
+
         // Returns the image ascpect flags for the VkFormat of this texture.
         VkImageAspectFlags GetAspectFlags() const;
 
@@ -125,20 +149,68 @@ class VKTexture final : public Texture
             return image_.GetMemoryRegion();
         }
 
-    private:
+        // Returns the current layout of the image.
+        inline VkImageLayout GetVkImageLayout() const
+        {
+            return image_.GetLayout();
+        }
+
+        // Returns true if this texture was created with the image usage to generate its MIP-maps with a compute shader.
+        inline bool HasComputeMipGeneration() const
+        {
+            return computeMipGeneration_;
+        }
+
+        // Returns true if this compressed texture was created with block-texel views to be written by the texture compressor.
+        inline bool HasComputeCompression() const
+        {
+            return computeCompression_;
+        }
+
+        // Returns true if this texture was created with VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT, i.e. it can be written on the host. See VKHostImageCopy.
+        inline bool HasHostImageCopy() const
+        {
+            return hostImageCopy_;
+        }
+
+        // Returns true if this texture was created with the MiscFlags::Sparse flag.
+        inline bool IsSparse() const
+        {
+            return (sparseTileMap_ != nullptr);
+        }
 
-        void CreateImage(VkDevice device, const TextureDescriptor& desc);
+        // Returns true if this texture was created with MiscFlags::External and is bound to its own exportable device memory.
+        inline bool IsExportable() const
+        {
+            return image_.IsExportable();
+        }
 
     private:
 
-        VKDeviceImage           image_;
-        VKPtr<VkImageView>      imageView_;
+        void CreateImage(const VKDevice& device, const TextureDescriptor& desc);
+        void QuerySparseMemoryRequirements(VkDevice device);
+
+    private:
 
-        VkFormat                format_             = VK_FORMAT_UNDEFINED;
-        VkExtent3D              extent_;
-        std::uint32_t           numMipLevels_       = 0;
-        std::uint32_t           numArrayLayers_     = 0;
-        VkSampleCountFlagBits   sampleCountBits_    = VK_SAMPLE_COUNT_1_BIT;
+        VKDeviceImage                       image_;
+        VKPtr<VkImageView>                  imageView_;
+
+        VkFormat                            format_                     = VK_FORMAT_UNDEFINED;
+        VkExtent3D                          extent_;
+        std::uint32_t                       numMipLevels_               = 0;
+        std::uint32_t                       numArrayLayers_             = 0;
+        VkSampleCountFlagBits               sampleCountBits_            = VK_SAMPLE_COUNT_1_BIT;
+
+        VkImageUsageFlags                   viewUsageFlags_             = 0;        // Usage of image views in the texture format; only non-zero for images with extended usage
+        bool                                computeMipGeneration_       = false;
+        bool                                computeCompression_         = false;
+        bool                                hostImageCopy_              = false;
+        std::vector<VKPtr<VkImageView>>     mipLevelViews_;                         // Sampled and storage view for each MIP level
+
+        std::unique_ptr<VKSparseTileMap>    sparseTileMap_;                         // Only created for sparse textures
+        VkSparseImageMemoryRequirements     sparseRequirements_         = {};
+        VkSparseImageMemoryRequirements     sparseMetadataRequirements_ = {};
+        bool                                hasSparseMetadata_          = false;
 
 };
 
@@ -0,0 +1,419 @@
+/*
+ * VKTextureCompressor.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VKTextureCompressor.h"
+#include "VKTexture.h"
+#include "../VKDevice.h"
+#include "../VKPhysicalDevice.h"
+#include "../VKCore.h"
+#include "../RenderState/VKBarrierAccumulator.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
+#include <LLGL/TextureFlags.h>
+#include <LLGL/Format.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <stdint.h>
+
+#ifdef LLGL_VK_ENABLE_BUILTIN_SHADERS
+#   include "CompressBC.comp.spv.h"
+#endif
+
+
+namespace LLGL
+{
+
+
+// Push constants of the CompressBC compute shader.
+struct VKTextureCompressionConstants
+{
+    std::uint32_t   baseArrayLayer;
+    std::uint32_t   linearToSRGB;
+};
+
+// Number of blocks that are encoded by each work group along each dimension.
+static constexpr std::uint32_t g_compressionGroupSize = 8;
+
+VKTextureCompressor& VKTextureCompressor::Get()
+{
+    static VKTextureCompressor instance;
+    return instance;
+}
+
+VkFormat VKTextureCompressor::GetBlockFormat(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            return VK_FORMAT_R32G32_UINT;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            return VK_FORMAT_R32G32B32A32_UINT;
+        default:
+            return VK_FORMAT_UNDEFINED;
+    }
+}
+
+void VKTextureCompressor::InitializeDevice(
+    VkDevice                device,
+    const VKPhysicalDevice& physicalDevice,
+    VkPipelineCache         pipelineCache)
+{
+    Clear();
+
+    #ifdef LLGL_VK_ENABLE_BUILTIN_SHADERS
+
+    /* Block-texel views require VK_KHR_maintenance2; storage images are written without format qualifier and descriptors are pushed directly */
+    if (!HasExtension(VKExt::KHR_push_descriptor) ||
+        !HasExtension(VKExt::KHR_maintenance2) ||
+        physicalDevice.GetFeatures().shaderStorageImageWriteWithoutFormat == VK_FALSE)
+    {
+        return;
+    }
+
+    physicalDevice_ = physicalDevice.GetVkPhysicalDevice();
+
+    CreateDescriptorSetLayout(device);
+    CreatePipelineLayout(device);
+    CreateComputePipelines(device, pipelineCache, g_spirvCompressBC, sizeof(g_spirvCompressBC));
+
+    #endif // /LLGL_VK_ENABLE_BUILTIN_SHADERS
+}
+
+void VKTextureCompressor::Clear()
+{
+    for (VKPtr<VkPipeline>& pipeline : pipelines_)
+        pipeline.Release();
+    pipelineLayout_.Release();
+    descriptorSetLayout_.Release();
+    nearestClampSampler_.Release();
+    physicalDevice_ = VK_NULL_HANDLE;
+}
+
+bool VKTextureCompressor::IsAvailable() const
+{
+    return (pipelines_[0].Get() != VK_NULL_HANDLE);
+}
+
+bool VKTextureCompressor::IsSupported(VkFormat format) const
+{
+    BlockFormat blockFormat;
+    if (!IsAvailable() || !GetBlockFormatIndex(format, blockFormat))
+        return false;
+
+    /* The compressed format must be sampled and its block-sized format must be writable as storage image */
+    VkFormatProperties compressedFormatProps, blockFormatProps;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice_, format, &compressedFormatProps);
+    vkGetPhysicalDeviceFormatProperties(physicalDevice_, GetBlockFormat(format), &blockFormatProps);
+
+    return
+    (
+        (compressedFormatProps.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0 &&
+        (blockFormatProps.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0
+    );
+}
+
+// Returns the size of the specified MIP level but at least 1.
+static std::uint32_t GetMipLevelSize(std::uint32_t size, std::uint32_t mipLevel)
+{
+    return std::max(1u, size >> mipLevel);
+}
+
+void VKTextureCompressor::CompressTexture(
+    VKDevice&                   device,
+    VkCommandBuffer             commandBuffer,
+    VKBarrierAccumulator&       barriers,
+    VKTexture&                  dstTexture,
+    VKTexture&                  srcTexture,
+    const TextureSubresource&   subresource)
+{
+    BlockFormat blockFormat;
+    if (!dstTexture.HasComputeCompression() || !GetBlockFormatIndex(dstTexture.GetVkFormat(), blockFormat))
+        return;
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelines_[blockFormat]);
+
+    /*
+    Make previous writes to the source texture visible to the compute shader.
+    Destination MIP levels are transitioned across all array layers, because their image views cover all array layers as well.
+    */
+    barriers.InsertMemoryBarrier(
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_MEMORY_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT
+    );
+
+    VkImageSubresourceRange dstRange;
+    {
+        dstRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        dstRange.baseMipLevel   = subresource.baseMipLevel;
+        dstRange.levelCount     = subresource.numMipLevels;
+        dstRange.baseArrayLayer = 0;
+        dstRange.layerCount     = dstTexture.GetNumArrayLayers();
+    }
+    barriers.InsertImageBarrier(
+        dstTexture.GetVkImage(),
+        dstRange,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_IMAGE_LAYOUT_GENERAL,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        VK_ACCESS_SHADER_WRITE_BIT
+    );
+    barriers.Flush(commandBuffer);
+
+    /* Sampled colors of sRGB sources are linear and must be converted back, since blocks store the same encoding as the source */
+    VKTextureCompressionConstants constants;
+    {
+        constants.baseArrayLayer    = subresource.baseArrayLayer;
+        constants.linearToSRGB      = ((GetFormatAttribs(srcTexture.GetFormat()).flags & FormatFlags::IsColorSpace_sRGB) != 0 ? 1u : 0u);
+    }
+    vkCmdPushConstants(commandBuffer, pipelineLayout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+
+    const VkExtent3D& extent = dstTexture.GetVkExtent();
+
+    for_subrange(mipLevel, subresource.baseMipLevel, subresource.baseMipLevel + subresource.numMipLevels)
+    {
+        /* Push source MIP level and destination MIP level as block-sized texels */
+        VkDescriptorImageInfo srcImageInfo;
+        {
+            srcImageInfo.sampler        = VK_NULL_HANDLE;
+            srcImageInfo.imageView      = srcTexture.GetOrCreateMipLevelView(device, mipLevel, false);
+            srcImageInfo.imageLayout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+
+        VkDescriptorImageInfo dstImageInfo;
+        {
+            dstImageInfo.sampler        = VK_NULL_HANDLE;
+            dstImageInfo.imageView      = dstTexture.GetOrCreateMipLevelView(device, mipLevel, true);
+            dstImageInfo.imageLayout    = VK_IMAGE_LAYOUT_GENERAL;
+        }
+
+        VkWriteDescriptorSet writes[2];
+        {
+            writes[0].sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[0].pNext             = nullptr;
+            writes[0].dstSet            = VK_NULL_HANDLE;
+            writes[0].dstBinding        = 0;
+            writes[0].dstArrayElement   = 0;
+            writes[0].descriptorCount   = 1;
+            writes[0].descriptorType    = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[0].pImageInfo        = &srcImageInfo;
+            writes[0].pBufferInfo       = nullptr;
+            writes[0].pTexelBufferView  = nullptr;
+
+            writes[1].sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[1].pNext             = nullptr;
+            writes[1].dstSet            = VK_NULL_HANDLE;
+            writes[1].dstBinding        = 1;
+            writes[1].dstArrayElement   = 0;
+            writes[1].descriptorCount   = 1;
+            writes[1].descriptorType    = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[1].pImageInfo        = &dstImageInfo;
+            writes[1].pBufferInfo       = nullptr;
+            writes[1].pTexelBufferView  = nullptr;
+        }
+        vkCmdPushDescriptorSetKHR(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0, 2, writes);
+
+        /* Dispatch one invocation per block and one work group layer per array layer */
+        const std::uint32_t numBlocksX = (GetMipLevelSize(extent.width,  mipLevel) + 3) / 4;
+        const std::uint32_t numBlocksY = (GetMipLevelSize(extent.height, mipLevel) + 3) / 4;
+
+        vkCmdDispatch(
+            commandBuffer,
+            (numBlocksX + g_compressionGroupSize - 1) / g_compressionGroupSize,
+            (numBlocksY + g_compressionGroupSize - 1) / g_compressionGroupSize,
+            subresource.numArrayLayers
+        );
+    }
+
+    /* Transition destination MIP levels back to read-only layout */
+    barriers.InsertImageBarrier(
+        dstTexture.GetVkImage(),
+        dstRange,
+        VK_IMAGE_LAYOUT_GENERAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKTextureCompressor::CreateDescriptorSetLayout(VkDevice device)
+{
+    /* Create immutable nearest-clamp sampler for the source MIP level; texels are only fetched without filtering */
+    VkSamplerCreateInfo samplerInfo;
+    {
+        samplerInfo.sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.pNext                   = nullptr;
+        samplerInfo.flags                   = 0;
+        samplerInfo.magFilter               = VK_FILTER_NEAREST;
+        samplerInfo.minFilter               = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode              = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW            = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.mipLodBias              = 0.0f;
+        samplerInfo.anisotropyEnable        = VK_FALSE;
+        samplerInfo.maxAnisotropy           = 1.0f;
+        samplerInfo.compareEnable           = VK_FALSE;
+        samplerInfo.compareOp               = VK_COMPARE_OP_NEVER;
+        samplerInfo.minLod                  = 0.0f;
+        samplerInfo.maxLod                  = 0.0f;
+        samplerInfo.borderColor             = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+        samplerInfo.unnormalizedCoordinates = VK_FALSE;
+    }
+    nearestClampSampler_ = VKPtr<VkSampler>{ device, vkDestroySampler };
+    VkResult result = vkCreateSampler(device, &samplerInfo, nullptr, nearestClampSampler_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan sampler for texture compression");
+
+    /* Create push descriptor set layout with source MIP level and destination MIP level */
+    const VkSampler immutableSampler = nearestClampSampler_.Get();
+
+    VkDescriptorSetLayoutBinding bindings[2];
+    {
+        bindings[0].binding             = 0;
+        bindings[0].descriptorType      = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount     = 1;
+        bindings[0].stageFlags          = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[0].pImmutableSamplers  = &immutableSampler;
+
+        bindings[1].binding             = 1;
+        bindings[1].descriptorType      = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[1].descriptorCount     = 1;
+        bindings[1].stageFlags          = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[1].pImmutableSamplers  = nullptr;
+    }
+    VkDescriptorSetLayoutCreateInfo createInfo;
+    {
+        createInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        createInfo.pNext        = nullptr;
+        createInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+        createInfo.bindingCount = 2;
+        createInfo.pBindings    = bindings;
+    }
+    descriptorSetLayout_ = VKPtr<VkDescriptorSetLayout>{ device, vkDestroyDescriptorSetLayout };
+    result = vkCreateDescriptorSetLayout(device, &createInfo, nullptr, descriptorSetLayout_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor set layout for texture compression");
+}
+
+void VKTextureCompressor::CreatePipelineLayout(VkDevice device)
+{
+    const VkDescriptorSetLayout setLayout = descriptorSetLayout_.Get();
+
+    VkPushConstantRange pushConstantRange;
+    {
+        pushConstantRange.stageFlags    = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset        = 0;
+        pushConstantRange.size          = sizeof(VKTextureCompressionConstants);
+    }
+    VkPipelineLayoutCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.setLayoutCount           = 1;
+        createInfo.pSetLayouts              = &setLayout;
+        createInfo.pushConstantRangeCount   = 1;
+        createInfo.pPushConstantRanges      = &pushConstantRange;
+    }
+    pipelineLayout_ = VKPtr<VkPipelineLayout>{ device, vkDestroyPipelineLayout };
+    VkResult result = vkCreatePipelineLayout(device, &createInfo, nullptr, pipelineLayout_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline layout for texture compression");
+}
+
+void VKTextureCompressor::CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, const std::uint32_t* code, std::size_t codeSize)
+{
+    /* Create temporary shader module; it is shared by all pipelines and no longer needed once they have been created */
+    VKPtr<VkShaderModule> shaderModule{ device, vkDestroyShaderModule };
+    {
+        VkShaderModuleCreateInfo createInfo;
+        {
+            createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            createInfo.pNext    = nullptr;
+            createInfo.flags    = 0;
+            createInfo.codeSize = codeSize;
+            createInfo.pCode    = code;
+        }
+        VkResult result = vkCreateShaderModule(device, &createInfo, nullptr, shaderModule.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan shader module for texture compression");
+    }
+
+    /* Specialize block format with constant_id = 0 */
+    const VkSpecializationMapEntry specializationEntry{ 0, 0, sizeof(std::uint32_t) };
+
+    for (std::uint32_t blockFormat = 0; blockFormat < NumBlockFormats; ++blockFormat)
+    {
+        VkSpecializationInfo specializationInfo;
+        {
+            specializationInfo.mapEntryCount    = 1;
+            specializationInfo.pMapEntries      = &specializationEntry;
+            specializationInfo.dataSize         = sizeof(blockFormat);
+            specializationInfo.pData            = &blockFormat;
+        }
+        VkComputePipelineCreateInfo createInfo;
+        {
+            createInfo.sType                        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            createInfo.pNext                        = nullptr;
+            createInfo.flags                        = 0;
+            createInfo.stage.sType                  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            createInfo.stage.pNext                  = nullptr;
+            createInfo.stage.flags                  = 0;
+            createInfo.stage.stage                  = VK_SHADER_STAGE_COMPUTE_BIT;
+            createInfo.stage.module                 = shaderModule.Get();
+            createInfo.stage.pName                  = "main";
+            createInfo.stage.pSpecializationInfo    = &specializationInfo;
+            createInfo.layout                       = pipelineLayout_.Get();
+            createInfo.basePipelineHandle           = VK_NULL_HANDLE;
+            createInfo.basePipelineIndex            = 0;
+        }
+        pipelines_[blockFormat] = VKPtr<VkPipeline>{ device, vkDestroyPipeline };
+        VkResult result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, pipelines_[blockFormat].ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan compute pipeline for texture compression");
+    }
+}
+
+bool VKTextureCompressor::GetBlockFormatIndex(VkFormat format, BlockFormat& outBlockFormat)
+{
+    switch (format)
+    {
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            outBlockFormat = BlockFormatBC1;
+            return true;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+            outBlockFormat = BlockFormatBC3;
+            return true;
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            outBlockFormat = BlockFormatBC4;
+            return true;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            outBlockFormat = BlockFormatBC5;
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,124 @@
+/*
+ * VKTextureCompressor.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VK_TEXTURE_COMPRESSOR_H
+#define LLGL_VK_TEXTURE_COMPRESSOR_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKTexture;
+class VKPhysicalDevice;
+class VKBarrierAccumulator;
+struct TextureSubresource;
+
+/*
+Vulkan texture compressor singleton.
+Encodes BC1, BC3, BC4, and BC5 blocks with a compute shader that writes into an uncompressed view of the destination texture,
+which requires the image to be created with VK_IMAGE_CREATE_BLOCK_TEXEL_VIEW_COMPATIBLE_BIT (see VK_KHR_maintenance2).
+*/
+class VKTextureCompressor
+{
+
+    public:
+
+        // Returns the singleton instance.
+        static VKTextureCompressor& Get();
+
+        // Returns the uncompressed format with the size of one block of the specified compressed format or VK_FORMAT_UNDEFINED if the format cannot be encoded.
+        static VkFormat GetBlockFormat(VkFormat format);
+
+    public:
+
+        VKTextureCompressor(const VKTextureCompressor&) = delete;
+        VKTextureCompressor& operator = (const VKTextureCompressor&) = delete;
+
+        VKTextureCompressor(VKTextureCompressor&&) = delete;
+        VKTextureCompressor& operator = (VKTextureCompressor&&) = delete;
+
+        // Creates the compute pipelines if the physical device supports all required extensions and features.
+        void InitializeDevice(
+            VkDevice                device,
+            const VKPhysicalDevice& physicalDevice,
+            VkPipelineCache         pipelineCache
+        );
+
+        // Releases all Vulkan objects (used by VKRenderSystem).
+        void Clear();
+
+        // Returns true if the compute pipelines have been created. See RenderingFeatures::hasTextureCompression.
+        bool IsAvailable() const;
+
+        // Returns true if textures of the specified format can be encoded with the compute shader.
+        bool IsSupported(VkFormat format) const;
+
+        /*
+        Records the commands to compress the specified subresource of the source texture into the destination texture.
+        This replaces the compute pipeline binding of the command buffer.
+        */
+        void CompressTexture(
+            VKDevice&                   device,
+            VkCommandBuffer             commandBuffer,
+            VKBarrierAccumulator&       barriers,
+            VKTexture&                  dstTexture,
+            VKTexture&                  srcTexture,
+            const TextureSubresource&   subresource
+        );
+
+    private:
+
+        // Block formats the compute shader is specialized for; must match the BLOCK_FORMAT_* macros in CompressBC.comp.
+        enum BlockFormat : std::uint32_t
+        {
+            BlockFormatBC1 = 0,
+            BlockFormatBC3,
+            BlockFormatBC4,
+            BlockFormatBC5,
+
+            NumBlockFormats,
+        };
+
+    private:
+
+        VKTextureCompressor() = default;
+
+        void CreateDescriptorSetLayout(VkDevice device);
+        void CreatePipelineLayout(VkDevice device);
+        void CreateComputePipelines(VkDevice device, VkPipelineCache pipelineCache, const std::uint32_t* code, std::size_t codeSize);
+
+        // Returns the block format the compute shader is specialized with for the specified compressed format.
+        static bool GetBlockFormatIndex(VkFormat format, BlockFormat& outBlockFormat);
+
+    private:
+
+        VkPhysicalDevice                physicalDevice_         = VK_NULL_HANDLE;
+
+        VKPtr<VkSampler>                nearestClampSampler_;
+        VKPtr<VkDescriptorSetLayout>    descriptorSetLayout_;
+        VKPtr<VkPipelineLayout>         pipelineLayout_;
+        VKPtr<VkPipeline>               pipelines_[NumBlockFormats];
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
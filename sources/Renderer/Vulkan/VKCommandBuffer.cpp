@@ -13,6 +13,7 @@
 #include "Ext/VKExtensionRegistry.h"
 #include "Ext/VKExtensions.h"
 #include "RenderState/VKRenderPass.h"
+#include "RenderState/VKDynamicRendering.h"
 #include "RenderState/VKGraphicsPSO.h"
 #include "RenderState/VKComputePSO.h"
 #include "RenderState/VKResourceHeap.h"
@@ -20,14 +21,22 @@
 #include "Texture/VKSampler.h"
 #include "Texture/VKTexture.h"
 #include "Texture/VKRenderTarget.h"
+#include "Texture/VKMipGenerator.h"
+#include "Texture/VKTextureCompressor.h"
 #include "Buffer/VKBuffer.h"
 #include "Buffer/VKBufferArray.h"
+#include "Buffer/VKAccelerationStructure.h"
+#include "Buffer/VKIndirectArgumentCompactor.h"
+#include "../BufferUtils.h"
 #include "../CheckedCast.h"
+#include "../FrameCounters.h"
 #include "../../Core/Exception.h"
 #include <LLGL/Utils/ForRange.h>
 #include <LLGL/StaticLimits.h>
 #include <LLGL/TypeInfo.h>
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 #include <LLGL/Backend/Vulkan/NativeHandle.h>
 
@@ -38,6 +47,12 @@ namespace LLGL
 
 constexpr std::uint32_t VKCommandBuffer::maxNumCommandBuffers;
 
+// Size (in bytes) of the device-local buffer fill patterns are replicated into. Larger fill ranges are covered by multiple copy regions.
+static constexpr VkDeviceSize g_patternBufferSize = 65536;
+
+// Size (in bytes) of the first pattern block that is written into the pattern buffer with the command stream.
+static constexpr std::uint32_t g_patternBlockSize = 4096;
+
 // Returns the maximum for a indirect multi draw command
 static std::uint32_t GetMaxDrawIndirectCount(const VKPhysicalDevice& physicalDevice)
 {
@@ -51,21 +66,29 @@ VKCommandBuffer::VKCommandBuffer(
     const VKPhysicalDevice&         physicalDevice,
     VKDevice&                       device,
     VkQueue                         commandQueue,
-    const QueueFamilyIndices&       queueFamilyIndices,
-    const CommandBufferDescriptor&  desc)
+    std::uint32_t                   queueFamilyIndex,
+    const CommandBufferDescriptor&  desc,
+    bool                            breadcrumbsEnabled)
 :
+    physicalDevice_         { physicalDevice                                },
     device_                 { device                                        },
     commandQueue_           { commandQueue                                  },
     commandPool_            { device, vkDestroyCommandPool                  },
     numCommandBuffers_      { VKCommandBuffer::GetNumVkCommandBuffers(desc) },
-    queuePresentFamily_     { queueFamilyIndices.presentFamily              },
     maxDrawIndirectCount_   { GetMaxDrawIndirectCount(physicalDevice)       },
     recordingFenceArray_    { VKPtr<VkFence>{ device, vkDestroyFence },
                               VKPtr<VkFence>{ device, vkDestroyFence },
                               VKPtr<VkFence>{ device, vkDestroyFence }      },
-    descriptorSetPoolArray_ { device.GetVkDevice().Get(),
+    descriptorSetPoolArray_ { { device.GetVkDevice().Get(), device.GetTuningProfile().descriptorPoolCapacity },
+                              { device.GetVkDevice().Get(), device.GetTuningProfile().descriptorPoolCapacity },
+                              { device.GetVkDevice().Get(), device.GetTuningProfile().descriptorPoolCapacity } },
+    barrierAccumulatorArray_{ device.GetVkDevice().Get(),
                               device.GetVkDevice().Get(),
-                              device.GetVkDevice().Get()                    }
+                              device.GetVkDevice().Get()                    },
+    breadcrumbBuffer_       { device, vkDestroyBuffer                       },
+    breadcrumbMemory_       { device, vkFreeMemory                          },
+    patternBuffer_          { device, vkDestroyBuffer                       },
+    patternMemory_          { device, vkFreeMemory                          }
 {
     /* Translate creation flags */
     VkCommandBufferLevel bufferLevel = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -80,23 +103,44 @@ VKCommandBuffer::VKCommandBuffer(
         if ((desc.flags & CommandBufferFlags::Secondary) != 0)
         {
             bufferLevel = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            secondary_  = true;
             usageFlags_ |= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+
+            /* Register secondary command buffer to be recorded entirely inside the specified render pass of a primary command buffer */
+            if (desc.renderPass != nullptr)
+            {
+                inheritedRenderPass_ = LLGL_CAST(const VKRenderPass*, desc.renderPass);
+                inheritedRenderPass_->AttachSecondaryCommandBuffer();
+                usageFlags_ |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            }
         }
         if ((desc.flags & CommandBufferFlags::MultiSubmit) == 0)
             usageFlags_ |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     }
 
+    /*
+    Events of split barriers are only reset between recordings, so they can't be used for command buffers that are submitted more than once.
+    The tuning profile disables them for vendors where events don't overlap more work than pipeline barriers.
+    */
+    splitBarriers_ = (device.GetTuningProfile().splitBarriers && (usageFlags_ & VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT) != 0 && (usageFlags_ & VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT) == 0);
+
     /* Create native command buffer objects */
-    CreateVkCommandPool(queueFamilyIndices.graphicsFamily);
+    CreateVkCommandPool(queueFamilyIndex);
     CreateVkCommandBuffers(bufferLevel);
     CreateVkRecordingFences();
 
     /* Acquire first native command buffer */
     AcquireNextBuffer();
+
+    /* Secondary command buffers can't write breadcrumbs, since their markers would be indistinguishable between multiple executions */
+    if (breadcrumbsEnabled && bufferLevel == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
+        CreateBreadcrumbBuffer(physicalDevice);
 }
 
 VKCommandBuffer::~VKCommandBuffer()
 {
+    if (inheritedRenderPass_ != nullptr)
+        inheritedRenderPass_->DetachSecondaryCommandBuffer();
     vkFreeCommandBuffers(device_, commandPool_, numCommandBuffers_, commandBufferArray_);
 }
 
@@ -104,6 +148,8 @@ VKCommandBuffer::~VKCommandBuffer()
 
 void VKCommandBuffer::Begin()
 {
+    LLGL_FRAME_COUNTER_BEGIN();
+
     /* Use next internal VkCommandBuffer object to reduce latency */
     AcquireNextBuffer();
 
@@ -111,28 +157,74 @@ void VKCommandBuffer::Begin()
     vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
     vkResetFences(device_, 1, &recordingFence_);
 
+    /* Previous recording of this command buffer has completed, so its split barrier events and descriptor sets can be reused */
+    barriers_->Reset();
+    descriptorSetPool_->Reset();
+    pendingIndirectBarrier_ = false;
+    pendingStreamOutputBarrier_ = false;
+    boundVertexBuffer_ = nullptr;
+
+    /* Complete previous recording token, so resource heap versions it refers to can be rewritten; reuse the token if nothing else refers to it */
+    if (*recordingToken_ && recordingToken_->use_count() == 1)
+        (*recordingToken_)->completed.store(false, std::memory_order_relaxed);
+    else
+    {
+        if (*recordingToken_)
+            (*recordingToken_)->completed.store(true, std::memory_order_release);
+        *recordingToken_ = std::make_shared<VKRecordingToken>();
+    }
+
+    if (breadcrumbs_.IsRegistered())
+        breadcrumbs_.Begin();
+
+    /* Secondary command buffers must always specify inheritance info; the render pass is only inherited if one was specified at creation time */
+    VkCommandBufferInheritanceInfo              inheritanceInfo;
+    VkCommandBufferInheritanceRenderingInfoKHR  inheritanceRenderingInfo;
+    VkFormat                                    colorAttachmentFormats[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+
+    if (IsSecondaryCmdBuffer())
+        GetInheritanceInfo(inheritanceInfo, inheritanceRenderingInfo, colorAttachmentFormats);
+
     /* Begin recording of current command buffer */
     VkCommandBufferBeginInfo beginInfo;
     {
         beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         beginInfo.pNext             = nullptr;
         beginInfo.flags             = usageFlags_;
-        beginInfo.pInheritanceInfo  = nullptr;
+        beginInfo.pInheritanceInfo  = (IsSecondaryCmdBuffer() ? &inheritanceInfo : nullptr);
     }
     VkResult result = vkBeginCommandBuffer(commandBuffer_, &beginInfo);
     VKThrowIfFailed(result, "failed to begin Vulkan command buffer");
 
-    #if 0//TODO: optimize
-    /* Reset all query pools that were in flight during last encoding */
-    ResetQueryPoolsInFlight();
-    #endif
+    /* Discard query ranges of a previous encoding that has not been ended */
+    queryRangesInFlight_.clear();
 
-    /* Store new record state */
-    recordState_ = RecordState::OutsideRenderPass;
+    if (inheritedRenderPass_ != nullptr)
+    {
+        /* Framebuffer of the primary command buffer is unknown, so the default scissor rectangle must cover any render area */
+        boundRenderPass_        = inheritedRenderPass_;
+        framebufferRenderArea_  = VkRect2D{ { 0, 0 }, { 0x7FFFFFFFu, 0x7FFFFFFFu } };
+        numColorAttachments_    = inheritedRenderPass_->GetNumColorAttachments();
+        recordState_            = RecordState::InsideRenderPass;
+    }
+    else
+    {
+        /* Store new record state */
+        recordState_ = RecordState::OutsideRenderPass;
+    }
 }
 
 void VKCommandBuffer::End()
 {
+    /* Record remaining barriers, e.g. final image layout transitions of the last render pass; pipeline barriers are not allowed inside an inherited render pass */
+    if (inheritedRenderPass_ == nullptr)
+    {
+        barriers_->Flush(commandBuffer_);
+        CopyQueryResultsInFlight();
+    }
+    else
+        boundRenderPass_ = nullptr;
+
     /* End encoding of current command buffer */
     VkResult result = vkEndCommandBuffer(commandBuffer_);
     VKThrowIfFailed(result, "failed to end Vulkan command buffer");
@@ -143,8 +235,10 @@ void VKCommandBuffer::End()
     /* Execute command buffer right after encoding for immediate command buffers */
     if (IsImmediateCmdBuffer())
     {
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+        device_.FlushPendingUploads(commandQueue_);
         VkResult result = VKSubmitCommandBuffer(commandQueue_, commandBuffer_, GetQueueSubmitFence());
-        VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
+        VKThrowIfFailed(result, "failed to submit command buffer to Vulkan queue");
     }
 
     ResetBindingStates();
@@ -154,7 +248,15 @@ void VKCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& cmdBufferVK = LLGL_CAST(VKCommandBuffer&, deferredCommandBuffer);
     VkCommandBuffer cmdBuffers[] = { cmdBufferVK.GetVkCommandBuffer() };
+    if (!IsInsideRenderPass())
+        barriers_->Flush(commandBuffer_);
     vkCmdExecuteCommands(commandBuffer_, 1, cmdBuffers);
+    LLGL_FRAME_COUNTER_EXECUTE(cmdBufferVK.GetFrameCounters());
+}
+
+void VKCommandBuffer::TrimMemory()
+{
+    /* Buffer updates are encoded inline with vkCmdUpdateBuffer and the staging descriptor pools already follow the usage of recent recordings */
 }
 
 /* ----- Blitting ----- */
@@ -165,6 +267,8 @@ void VKCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferUpdates);
+
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
 
     auto size   = static_cast<VkDeviceSize>(dataSize);
@@ -173,12 +277,14 @@ void VKCommandBuffer::UpdateBuffer(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        barriers_->FlushForTransfer(commandBuffer_, VK_NULL_HANDLE, dstBufferVK.GetVkBuffer());
         vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, data);
         BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
         ResumeRenderPass();
     }
     else
     {
+        barriers_->FlushForTransfer(commandBuffer_, VK_NULL_HANDLE, dstBufferVK.GetVkBuffer());
         vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, data);
         BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
     }
@@ -191,6 +297,8 @@ void VKCommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
     auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
 
@@ -204,11 +312,17 @@ void VKCommandBuffer::CopyBuffer(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        barriers_->FlushForTransfer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer());
         vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
         ResumeRenderPass();
     }
     else
+    {
+        barriers_->FlushForTransfer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer());
         vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
+    }
+
+    HostReadBarrier(dstBufferVK, region.dstOffset, region.size);
 }
 
 void VKCommandBuffer::CopyBufferFromTexture(
@@ -219,6 +333,8 @@ void VKCommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(bufferCopies);
+
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
     auto& srcTextureVK = LLGL_CAST(VKTexture&, srcTexture);
 
@@ -238,11 +354,17 @@ void VKCommandBuffer::CopyBufferFromTexture(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        barriers_->FlushForTransfer(commandBuffer_, VK_NULL_HANDLE, dstBufferVK.GetVkBuffer());
         device_.CopyImageToBuffer(commandBuffer_, srcTextureVK, dstBufferVK, region);
         ResumeRenderPass();
     }
     else
+    {
+        barriers_->FlushForTransfer(commandBuffer_, VK_NULL_HANDLE, dstBufferVK.GetVkBuffer());
         device_.CopyImageToBuffer(commandBuffer_, srcTextureVK, dstBufferVK, region);
+    }
+
+    HostReadBarrier(dstBufferVK, region.bufferOffset, VK_WHOLE_SIZE);
 }
 
 void VKCommandBuffer::FillBuffer(
@@ -251,6 +373,8 @@ void VKCommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
 
     /* Determine destination buffer range and ignore <dstOffset> if the whole buffer is meant to be filled */
@@ -270,11 +394,67 @@ void VKCommandBuffer::FillBuffer(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        barriers_->FlushForTransfer(commandBuffer_, VK_NULL_HANDLE, dstBufferVK.GetVkBuffer());
         vkCmdFillBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, value);
         ResumeRenderPass();
     }
     else
+    {
+        barriers_->FlushForTransfer(commandBuffer_, VK_NULL_HANDLE, dstBufferVK.GetVkBuffer());
         vkCmdFillBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, value);
+    }
+}
+
+void VKCommandBuffer::FillBufferPattern(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     pattern,
+    std::uint32_t   patternSize,
+    std::uint64_t   fillSize)
+{
+    /* Forward patterns of a single 32-bit value to vkCmdFillBuffer */
+    std::uint32_t value = 0;
+    if (GetUniformFillPatternValue(pattern, patternSize, value))
+        return FillBuffer(dstBuffer, dstOffset, value, fillSize);
+
+    LLGL_FRAME_COUNTER_INC(bufferFills);
+
+    auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
+
+    /* Determine destination buffer range and ignore <dstOffset> if the whole buffer is meant to be filled */
+    VkDeviceSize offset, size;
+    if (fillSize == Constants::wholeSize)
+    {
+        offset  = 0;
+        size    = dstBufferVK.GetSize();
+    }
+    else
+    {
+        offset  = static_cast<VkDeviceSize>(dstOffset);
+        size    = static_cast<VkDeviceSize>(fillSize);
+    }
+
+    if (size == 0)
+        return;
+
+    if (patternBuffer_.Get() == VK_NULL_HANDLE)
+        CreatePatternBuffer();
+
+    /*
+    Replicate pattern into the device-local pattern buffer and copy it into the destination buffer.
+    vkCmdFillBuffer only supports 32-bit values, but this keeps the entire fill on the GPU without a staging buffer.
+    */
+    const bool insideRenderPass = IsInsideRenderPass();
+    if (insideRenderPass)
+        PauseRenderPass();
+    {
+        WritePatternBuffer(pattern, patternSize, std::min(size, g_patternBufferSize));
+        CopyPatternBuffer(dstBufferVK.GetVkBuffer(), offset, size);
+    }
+    if (insideRenderPass)
+        ResumeRenderPass();
+
+    HostReadBarrier(dstBufferVK, offset, size);
 }
 
 void VKCommandBuffer::CopyTexture(
@@ -284,6 +464,8 @@ void VKCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureVK = LLGL_CAST(VKTexture&, dstTexture);
     auto& srcTextureVK = LLGL_CAST(VKTexture&, srcTexture);
 
@@ -305,11 +487,15 @@ void VKCommandBuffer::CopyTexture(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        barriers_->FlushForTransfer(commandBuffer_);
         device_.CopyTexture(commandBuffer_, srcTextureVK, dstTextureVK, region);
         ResumeRenderPass();
     }
     else
+    {
+        barriers_->FlushForTransfer(commandBuffer_);
         device_.CopyTexture(commandBuffer_, srcTextureVK, dstTextureVK, region);
+    }
 }
 
 void VKCommandBuffer::CopyTextureFromBuffer(
@@ -320,6 +506,8 @@ void VKCommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     auto& dstTextureVK = LLGL_CAST(VKTexture&, dstTexture);
     auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
 
@@ -339,11 +527,15 @@ void VKCommandBuffer::CopyTextureFromBuffer(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        barriers_->FlushForTransfer(commandBuffer_, srcBufferVK.GetVkBuffer());
         device_.CopyBufferToImage(commandBuffer_, srcBufferVK, dstTextureVK, region);
         ResumeRenderPass();
     }
     else
+    {
+        barriers_->FlushForTransfer(commandBuffer_, srcBufferVK.GetVkBuffer());
         device_.CopyBufferToImage(commandBuffer_, srcBufferVK, dstTextureVK, region);
+    }
 }
 
 void VKCommandBuffer::CopyTextureFromFramebuffer(
@@ -351,6 +543,8 @@ void VKCommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
+    LLGL_FRAME_COUNTER_INC(textureCopies);
+
     if (boundSwapChain_ == nullptr)
         return /*No bound framebuffer*/;
 
@@ -370,6 +564,7 @@ void VKCommandBuffer::CopyTextureFromFramebuffer(
         boundSwapChain_->CopyImage(
             device_,
             commandBuffer_,
+            *barriers_,
             dstTextureVK.GetVkImage(),
             VK_IMAGE_LAYOUT_UNDEFINED, //TODO: use state management of image layouts
             dstRegion,
@@ -384,6 +579,7 @@ void VKCommandBuffer::CopyTextureFromFramebuffer(
         boundSwapChain_->CopyImage(
             device_,
             commandBuffer_,
+            *barriers_,
             dstTextureVK.GetVkImage(),
             VK_IMAGE_LAYOUT_UNDEFINED, //TODO: use state management of image layouts
             dstRegion,
@@ -396,18 +592,16 @@ void VKCommandBuffer::CopyTextureFromFramebuffer(
 
 void VKCommandBuffer::GenerateMips(Texture& texture)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
-    device_.GenerateMips(
-        commandBuffer_,
-        textureVK.GetVkImage(),
-        textureVK.GetVkFormat(),
-        textureVK.GetVkExtent(),
-        TextureSubresource{ 0, textureVK.GetNumArrayLayers(), 0, textureVK.GetNumMipLevels() }
-    );
+    GenerateMipsForSubresource(textureVK, TextureSubresource{ 0, textureVK.GetNumArrayLayers(), 0, textureVK.GetNumMipLevels() });
 }
 
 void VKCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    LLGL_FRAME_COUNTER_INC(mipMapsGenerations);
+
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
 
     const auto maxNumMipLevels      = textureVK.GetNumMipLevels();
@@ -416,16 +610,24 @@ void VKCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& s
     if (subresource.baseMipLevel   < maxNumMipLevels   && subresource.numMipLevels   > 0 &&
         subresource.baseArrayLayer < maxNumArrayLayers && subresource.numArrayLayers > 0)
     {
-        device_.GenerateMips(
-            commandBuffer_,
-            textureVK.GetVkImage(),
-            textureVK.GetVkFormat(),
-            textureVK.GetVkExtent(),
-            subresource
-        );
+        GenerateMipsForSubresource(textureVK, subresource);
     }
 }
 
+void VKCommandBuffer::CompressTexture(Texture& dstTexture, Texture& srcTexture, const TextureSubresource& subresource)
+{
+    auto& dstTextureVK = LLGL_CAST(VKTexture&, dstTexture);
+    auto& srcTextureVK = LLGL_CAST(VKTexture&, srcTexture);
+
+    if (subresource.numMipLevels == 0 || subresource.numArrayLayers == 0)
+        return;
+
+    MarkBreadcrumb("CompressTexture");
+
+    VKTextureCompressor::Get().CompressTexture(device_, commandBuffer_, *barriers_, dstTextureVK, srcTextureVK, subresource);
+    RestoreComputePipeline();
+}
+
 /* ----- Viewport and Scissor ----- */
 
 void VKCommandBuffer::SetViewport(const Viewport& viewport)
@@ -478,16 +680,21 @@ void VKCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scis
 
 void VKCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
     VkBuffer buffers[] = { bufferVK.GetVkBuffer() };
     VkDeviceSize offsets[] = { 0 };
 
     vkCmdBindVertexBuffers(commandBuffer_, 0, 1, buffers, offsets);
+    boundVertexBuffer_ = &bufferVK;
 }
 
 void VKCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_FRAME_COUNTER_INC(vertexBufferBindings);
+
     auto& bufferArrayVK = LLGL_CAST(VKBufferArray&, bufferArray);
     vkCmdBindVertexBuffers(
         commandBuffer_,
@@ -496,16 +703,21 @@ void VKCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         bufferArrayVK.GetBuffers().data(),
         bufferArrayVK.GetOffsets().data()
     );
+    boundVertexBuffer_ = bufferArrayVK.GetFirstBuffer();
 }
 
 void VKCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdBindIndexBuffer(commandBuffer_, bufferVK.GetVkBuffer(), 0, bufferVK.GetIndexType());
 }
 
 void VKCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(indexBufferBindings);
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdBindIndexBuffer(commandBuffer_, bufferVK.GetVkBuffer(), offset, VKTypes::ToVkIndexType(format));
 }
@@ -514,24 +726,47 @@ void VKCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::u
 
 void VKCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
+    LLGL_FRAME_COUNTER_INC(resourceHeapBindings);
+
     if (boundPipelineState_ == nullptr)
         return /*No PSO bound*/;
 
     /* Bind resource heap to pipeline bind point and insert resource barrier into command buffer */
     auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
-    if (!(descriptorSet < resourceHeapVK.GetVkDescriptorSets().size()))
+    VkDescriptorSet nativeDescriptorSet = resourceHeapVK.AcquireDescriptorSet(descriptorSet, *recordingToken_);
+    if (nativeDescriptorSet == VK_NULL_HANDLE)
         return /*Descriptor set out of bounds*/;
 
-    boundPipelineState_->BindHeapDescriptorSet(commandBuffer_, resourceHeapVK.GetVkDescriptorSets()[descriptorSet]);
-    resourceHeapVK.SubmitPipelineBarrier(commandBuffer_, descriptorSet);
+    boundPipelineState_->BindHeapDescriptorSet(commandBuffer_, nativeDescriptorSet);
+
+    /* Barriers can't be deferred into a render pass, but outside of one they are merged with other pending barriers before the next dispatch */
+    if (IsInsideRenderPass())
+        resourceHeapVK.SubmitPipelineBarrier(commandBuffer_, descriptorSet);
+    else
+        resourceHeapVK.InsertPipelineBarrier(*barriers_, descriptorSet);
 }
 
 void VKCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
+    LLGL_FRAME_COUNTER_RESOURCE(resource);
+
     if (boundPipelineLayout_ != nullptr && descriptor < boundPipelineLayout_->GetLayoutDynamicBindings().size())
     {
         const auto& binding = boundPipelineLayout_->GetLayoutDynamicBindings()[descriptor];
-        descriptorCache_->EmplaceDescriptor(resource, binding);
+        descriptorCache_->EmplaceDescriptor(descriptor, resource, binding);
+    }
+}
+
+void VKCommandBuffer::SetResource(std::uint32_t descriptor, Buffer& buffer, std::uint64_t offset, std::uint64_t size)
+{
+    LLGL_FRAME_COUNTER_RESOURCE(buffer);
+
+    if (boundPipelineLayout_ != nullptr && descriptor < boundPipelineLayout_->GetLayoutDynamicBindings().size())
+    {
+        const auto& binding = boundPipelineLayout_->GetLayoutDynamicBindings()[descriptor];
+        auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+        const VkDeviceSize range = (size == Constants::wholeSize ? VK_WHOLE_SIZE : static_cast<VkDeviceSize>(size));
+        descriptorCache_->EmplaceBufferRangeDescriptor(descriptor, bufferVK, static_cast<VkDeviceSize>(offset), range, binding);
     }
 }
 
@@ -547,6 +782,13 @@ void VKCommandBuffer::ResetResourceSlots(
 
 /* ----- Render Passes ----- */
 
+// Returns the framebuffer extent limited to the active extent of the specified render target (see RenderTarget::SetActiveExtent).
+static VkExtent2D GetActiveVkExtent(const RenderTarget& renderTarget, const VkExtent2D& framebufferExtent)
+{
+    const Extent2D activeExtent = renderTarget.GetActiveExtent();
+    return VkExtent2D{ std::min(activeExtent.width, framebufferExtent.width), std::min(activeExtent.height, framebufferExtent.height) };
+}
+
 void VKCommandBuffer::BeginRenderPass(
     RenderTarget&       renderTarget,
     const RenderPass*   renderPass,
@@ -554,6 +796,8 @@ void VKCommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       swapBufferIndex)
 {
+    LLGL_FRAME_COUNTER_INC(renderPassSections);
+
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
     {
         /* Get Vulkan swap-chain object */
@@ -565,7 +809,9 @@ void VKCommandBuffer::BeginRenderPass(
         renderPass_                     = swapChainVK.GetSwapChainRenderPass().GetVkRenderPass();
         secondaryRenderPass_            = swapChainVK.GetSecondaryVkRenderPass();
         framebuffer_                    = swapChainVK.GetVkFramebuffer(currentColorBuffer_);
-        framebufferRenderArea_.extent   = swapChainVK.GetVkExtent();
+        boundRenderPass_                = &(swapChainVK.GetSwapChainRenderPass());
+        renderingAttachments_           = &(swapChainVK.GetRenderingAttachments(currentColorBuffer_));
+        framebufferRenderArea_.extent   = GetActiveVkExtent(swapChainVK, swapChainVK.GetVkExtent());
         numColorAttachments_            = swapChainVK.GetNumColorAttachments();
         hasDepthStencilAttachment_      = (swapChainVK.HasDepthAttachment() || swapChainVK.HasStencilAttachment());
     }
@@ -578,13 +824,19 @@ void VKCommandBuffer::BeginRenderPass(
         renderPass_                     = renderTargetVK.GetVkRenderPass();
         secondaryRenderPass_            = renderTargetVK.GetSecondaryVkRenderPass();
         framebuffer_                    = renderTargetVK.GetVkFramebuffer();
-        framebufferRenderArea_.extent   = renderTargetVK.GetVkExtent();
+        boundRenderPass_                = LLGL_CAST(const VKRenderPass*, renderTargetVK.GetRenderPass());
+        renderingAttachments_           = &(renderTargetVK.GetRenderingAttachments());
+        framebufferRenderArea_.extent   = GetActiveVkExtent(renderTargetVK, renderTargetVK.GetVkExtent());
         numColorAttachments_            = renderTargetVK.GetNumColorAttachments();
         hasDepthStencilAttachment_      = (renderTargetVK.HasDepthAttachment() || renderTargetVK.HasStencilAttachment());
     }
 
     scissorRectInvalidated_ = true;
 
+    /* Draw commands inside the render pass may read indirect arguments that have been written by previous dispatch commands */
+    InsertIndirectArgumentBarrier();
+    InsertStreamOutputBarrier();
+
     /* Uninitialized stack memory for clear values */
     VkClearValue clearValuesVK[LLGL_MAX_NUM_COLOR_ATTACHMENTS * 2 + 1];
     std::uint32_t numClearValuesVK = 0;
@@ -594,22 +846,41 @@ void VKCommandBuffer::BeginRenderPass(
     {
         /* Get native VkRenderPass object */
         auto renderPassVK = LLGL_CAST(const VKRenderPass*, renderPass);
-        renderPass_ = renderPassVK->GetVkRenderPass();
+        renderPass_         = renderPassVK->GetVkRenderPass();
+        boundRenderPass_    = renderPassVK;
         ConvertRenderPassClearValues(*renderPassVK, numClearValuesVK, clearValuesVK, numClearValues, clearValues);
     }
 
-    /* Record begin of render pass */
-    VkRenderPassBeginInfo beginInfo;
+    /* Render pass contents are recorded by secondary command buffers if any of them inherits this render pass */
+    subpassContents_ = (boundRenderPass_->HasSecondaryCommandBuffers() ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+
+    if (HasExtension(VKExt::KHR_dynamic_rendering))
     {
-        beginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        beginInfo.pNext             = nullptr;
-        beginInfo.renderPass        = renderPass_;
-        beginInfo.framebuffer       = framebuffer_;
-        beginInfo.renderArea        = framebufferRenderArea_;
-        beginInfo.clearValueCount   = numClearValuesVK;
-        beginInfo.pClearValues      = clearValuesVK;
+        /* Render pass of the render target itself may clear attachments as well */
+        if (renderPass == nullptr)
+            ConvertRenderPassClearValues(*boundRenderPass_, numClearValuesVK, clearValuesVK, numClearValues, clearValues);
+
+        /* Record begin of dynamic rendering directly into the framebuffer attachments */
+        VKCmdBeginRendering(commandBuffer_, *barriers_, *renderingAttachments_, *boundRenderPass_, framebufferRenderArea_, clearValuesVK, false, GetRenderingFlags());
+    }
+    else
+    {
+        /* Record pending barriers before the render pass begins */
+        barriers_->Flush(commandBuffer_);
+
+        /* Record begin of render pass */
+        VkRenderPassBeginInfo beginInfo;
+        {
+            beginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            beginInfo.pNext             = nullptr;
+            beginInfo.renderPass        = renderPass_;
+            beginInfo.framebuffer       = framebuffer_;
+            beginInfo.renderArea        = framebufferRenderArea_;
+            beginInfo.clearValueCount   = numClearValuesVK;
+            beginInfo.pClearValues      = clearValuesVK;
+        }
+        vkCmdBeginRenderPass(commandBuffer_, &beginInfo, subpassContents_);
     }
-    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
     /* Store new record state */
     recordState_ = RecordState::InsideRenderPass;
@@ -618,11 +889,17 @@ void VKCommandBuffer::BeginRenderPass(
 void VKCommandBuffer::EndRenderPass()
 {
     /* Record and of render pass */
-    vkCmdEndRenderPass(commandBuffer_);
+    if (HasExtension(VKExt::KHR_dynamic_rendering))
+        VKCmdEndRendering(commandBuffer_, *barriers_, *renderingAttachments_);
+    else
+        vkCmdEndRenderPass(commandBuffer_);
 
     /* Reset render pass and framebuffer attributes */
-    renderPass_     = VK_NULL_HANDLE;
-    framebuffer_    = VK_NULL_HANDLE;
+    renderPass_             = VK_NULL_HANDLE;
+    framebuffer_            = VK_NULL_HANDLE;
+    boundRenderPass_        = nullptr;
+    renderingAttachments_   = nullptr;
+    subpassContents_        = VK_SUBPASS_CONTENTS_INLINE;
 
     /* Store new record state */
     recordState_ = RecordState::OutsideRenderPass;
@@ -650,6 +927,8 @@ static VkImageAspectFlags GetDepthStencilAspectMask(long flags)
 
 void VKCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     VkClearAttachment attachments[LLGL_MAX_NUM_ATTACHMENTS];
 
     std::uint32_t numAttachments = 0;
@@ -690,6 +969,8 @@ void VKCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 
 void VKCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    LLGL_FRAME_COUNTER_INC(attachmentClears);
+
     /* Convert clear attachment descriptors */
     VkClearAttachment attachmentsVK[LLGL_MAX_NUM_ATTACHMENTS];
 
@@ -736,8 +1017,8 @@ void VKCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Attac
 
 void VKCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    /* Bind native PSO */
-    auto& pipelineStateVK = LLGL_CAST(VKPipelineState&, pipelineState);
+    /* Bind native PSO or its fallback while it is still being compiled in the background */
+    auto& pipelineStateVK = LLGL_CAST(VKPipelineState&, pipelineState).GetReadyOrFallback();
     pipelineStateVK.BindPipelineAndStaticDescriptorSet(commandBuffer_);
 
     /* Handle special case for graphics PSOs */
@@ -745,6 +1026,7 @@ void VKCommandBuffer::SetPipelineState(PipelineState& pipelineState)
     if (pipelineBindPoint_ == VK_PIPELINE_BIND_POINT_GRAPHICS)
     {
         auto& graphicsPSO = LLGL_CAST(VKGraphicsPSO&, pipelineStateVK);
+        LLGL_FRAME_COUNTER_INC(graphicsPipelineBindings);
 
         /* Scissor rectangle must be updated (if scissor test is disabled) */
         scissorEnabled_ = graphicsPSO.IsScissorEnabled();
@@ -756,7 +1038,12 @@ void VKCommandBuffer::SetPipelineState(PipelineState& pipelineState)
             /* Avoid scissor update with each graphics pipeline binding (as long as render pass does not change) */
             scissorRectInvalidated_ = false;
         }
+
+        /* Set states that are dynamic in native pipelines that are shared between PSOs */
+        graphicsPSO.BindDynamicState(commandBuffer_);
     }
+    else
+        LLGL_FRAME_COUNTER_INC(computePipelineBindings);
 
     /* Keep reference to bound piepline layout (can be null) */
     boundPipelineState_     = &pipelineStateVK;
@@ -793,10 +1080,20 @@ void VKCommandBuffer::SetUniforms(std::uint32_t first, const void* data, std::ui
 
 void VKCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    LLGL_FRAME_COUNTER_INC(querySections);
+
     auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
 
+    /* Single timestamps are only written in EndQuery() */
+    if (queryHeapVK.GetType() == QueryType::Timestamp)
+        return;
+
     query *= queryHeapVK.GetGroupSize();
 
+    /* Reset queries on the host, so they can be reset inside render passes without any commands */
+    if (queryHeapVK.HasReadbackBuffer())
+        queryHeapVK.ResetQueries(query, queryHeapVK.GetGroupSize());
+
     if (queryHeapVK.GetType() == QueryType::TimeElapsed)
     {
         /* Record first timestamp */
@@ -827,19 +1124,37 @@ void VKCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
         /* Record second timestamp */
         vkCmdWriteTimestamp(commandBuffer_, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryHeapVK.GetVkQueryPool(), query + 1);
     }
+    else if (queryHeapVK.GetType() == QueryType::Timestamp)
+    {
+        /* Reset query before it is written again; without host query reset, this is only possible outside of render passes */
+        if (queryHeapVK.HasReadbackBuffer())
+            queryHeapVK.ResetQueries(query, 1);
+        else if (!IsInsideRenderPass())
+            vkCmdResetQueryPool(commandBuffer_, queryHeapVK.GetVkQueryPool(), query, 1);
+
+        /* Record single timestamp once all previous commands have been completed */
+        vkCmdWriteTimestamp(commandBuffer_, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryHeapVK.GetVkQueryPool(), query);
+    }
     else
     {
         /* End query section */
         vkCmdEndQuery(commandBuffer_, queryHeapVK.GetVkQueryPool(), query);
     }
 
-    #if 0//TEST
-    AppendQueryPoolInFlight(&queryHeapVK);
-    #endif
+    if (queryHeapVK.HasReadbackBuffer())
+    {
+        /* Results can only be copied outside of render passes, which is not possible in secondary command buffers that inherit a render pass */
+        if (inheritedRenderPass_ == nullptr)
+            AppendQueryRangeInFlight(queryHeapVK, query, queryHeapVK.GetGroupSize());
+        else
+            queryHeapVK.MarkQueriesUncached(query, queryHeapVK.GetGroupSize());
+    }
 }
 
 void VKCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    LLGL_FRAME_COUNTER_INC(renderConditionSections);
+
     LLGL_ASSERT_VK_EXT(EXT_conditional_rendering);
 
     auto& queryHeapVK = LLGL_CAST(VKPredicateQueryHeap&, queryHeap);
@@ -880,93 +1195,141 @@ void VKCommandBuffer::EndRenderCondition()
 
 /* ----- Stream Output ------ */
 
-#if 0
-void VKCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
+void VKCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
+    LLGL_FRAME_COUNTER_INC(streamOutputSections);
+
     LLGL_ASSERT_VK_EXT(EXT_transform_feedback);
 
-    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    /* Bind stream-output buffers without their counters, so each section starts capturing at the beginning of each buffer */
+    numBuffers = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
 
-    VkBuffer buffers[] = { bufferVK.GetVkBuffer() };
-    VkDeviceSize offsets[] = { 0 };
-    VkDeviceSize sizes[] = { bufferVK.GetSize() };
+    VkBuffer        buffersVK[LLGL_MAX_NUM_SO_BUFFERS];
+    VkDeviceSize    offsetsVK[LLGL_MAX_NUM_SO_BUFFERS];
+    VkDeviceSize    sizesVK[LLGL_MAX_NUM_SO_BUFFERS];
 
-    vkCmdBindTransformFeedbackBuffersEXT(commandBuffer_, 0, 1, buffers, offsets, sizes);
-}
-#endif
+    for_range(i, numBuffers)
+    {
+        auto* bufferVK = LLGL_CAST(VKBuffer*, buffers[i]);
+        buffersVK[i]            = bufferVK->GetVkBuffer();
+        offsetsVK[i]            = 0;
+        sizesVK[i]              = bufferVK->GetSize();
+        soCounterBuffers_[i]    = bufferVK->GetVkBuffer();
+        soCounterOffsets_[i]    = bufferVK->GetSOCounterOffset();
+    }
+    numSOCounterBuffers_ = numBuffers;
 
-void VKCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
-{
-    LLGL_ASSERT_VK_EXT(EXT_transform_feedback);
-    //TODO: bind buffers
+    vkCmdBindTransformFeedbackBuffersEXT(commandBuffer_, 0, numBuffers, buffersVK, offsetsVK, sizesVK);
     vkCmdBeginTransformFeedbackEXT(commandBuffer_, 0, 0, nullptr, nullptr);
 }
 
 void VKCommandBuffer::EndStreamOutput()
 {
     LLGL_ASSERT_VK_EXT(EXT_transform_feedback);
-    vkCmdEndTransformFeedbackEXT(commandBuffer_, 0, 0, nullptr, nullptr);
+
+    /* Write the byte count of each stream-output buffer into its counter, so it can be drawn with DrawStreamOutput */
+    vkCmdEndTransformFeedbackEXT(commandBuffer_, 0, numSOCounterBuffers_, soCounterBuffers_, soCounterOffsets_);
+    numSOCounterBuffers_        = 0;
+    pendingStreamOutputBarrier_ = true;
 }
 
 /* ----- Drawing ----- */
 
 void VKCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     vkCmdDraw(commandBuffer_, numVertices, 1, firstVertex, 0);
+
+    MarkBreadcrumb("Draw");
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, 0, 0);
+
+    MarkBreadcrumb("DrawIndexed");
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, vertexOffset, 0);
+
+    MarkBreadcrumb("DrawIndexed");
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, 0);
+
+    MarkBreadcrumb("DrawInstanced");
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, firstInstance);
+
+    MarkBreadcrumb("DrawInstanced");
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, 0, 0);
+
+    MarkBreadcrumb("DrawIndexedInstanced");
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, 0);
+
+    MarkBreadcrumb("DrawIndexedInstanced");
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+
+    MarkBreadcrumb("DrawIndexedInstanced");
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
+
+    MarkBreadcrumb("DrawIndirect");
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (maxDrawIndirectCount_ < numCommands)
@@ -982,17 +1345,25 @@ void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::ui
     }
     else
         vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, numCommands, stride);
+
+    MarkBreadcrumb("DrawIndirect");
 }
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
+
+    MarkBreadcrumb("DrawIndexedIndirect");
 }
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
     FlushDescriptorCache();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (maxDrawIndirectCount_ < numCommands)
@@ -1008,21 +1379,186 @@ void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
     }
     else
         vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, numCommands, stride);
+
+    MarkBreadcrumb("DrawIndexedIndirect");
+}
+
+void VKCommandBuffer::DrawIndirectCount(
+    Buffer&         argsBuffer,
+    std::uint64_t   argsOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    std::uint32_t   maxNumCommands,
+    std::uint32_t   stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushDescriptorCache();
+    auto& argsBufferVK  = LLGL_CAST(VKBuffer&, argsBuffer);
+    auto& countBufferVK = LLGL_CAST(VKBuffer&, countBuffer);
+    vkCmdDrawIndirectCountKHR(
+        commandBuffer_,
+        argsBufferVK.GetVkBuffer(),
+        argsOffset,
+        countBufferVK.GetVkBuffer(),
+        countOffset,
+        std::min(maxNumCommands, maxDrawIndirectCount_),
+        stride
+    );
+
+    MarkBreadcrumb("DrawIndirectCount");
+}
+
+void VKCommandBuffer::DrawIndexedIndirectCount(
+    Buffer&         argsBuffer,
+    std::uint64_t   argsOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    std::uint32_t   maxNumCommands,
+    std::uint32_t   stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushDescriptorCache();
+    auto& argsBufferVK  = LLGL_CAST(VKBuffer&, argsBuffer);
+    auto& countBufferVK = LLGL_CAST(VKBuffer&, countBuffer);
+    vkCmdDrawIndexedIndirectCountKHR(
+        commandBuffer_,
+        argsBufferVK.GetVkBuffer(),
+        argsOffset,
+        countBufferVK.GetVkBuffer(),
+        countOffset,
+        std::min(maxNumCommands, maxDrawIndirectCount_),
+        stride
+    );
+
+    MarkBreadcrumb("DrawIndexedIndirectCount");
+}
+
+void VKCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushDescriptorCache();
+    vkCmdDrawMeshTasksEXT(commandBuffer_, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+
+    MarkBreadcrumb("DrawMeshTasks");
+}
+
+void VKCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    FlushDescriptorCache();
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    vkCmdDrawMeshTasksIndirectEXT(commandBuffer_, bufferVK.GetVkBuffer(), offset, numCommands, stride);
+
+    MarkBreadcrumb("DrawMeshTasksIndirect");
+}
+
+void VKCommandBuffer::DrawStreamOutput()
+{
+    LLGL_FRAME_COUNTER_INC(drawCommands);
+
+    LLGL_ASSERT_VK_EXT(EXT_transform_feedback);
+
+    if (boundVertexBuffer_ != nullptr && boundVertexBuffer_->HasSOCounter())
+    {
+        /* Vertex count is determined by the byte count that EndStreamOutput has written into the counter of the vertex buffer */
+        FlushDescriptorCache();
+        vkCmdDrawIndirectByteCountEXT(
+            commandBuffer_,
+            1,
+            0,
+            boundVertexBuffer_->GetVkBuffer(),
+            boundVertexBuffer_->GetSOCounterOffset(),
+            0,
+            boundVertexBuffer_->GetVertexStride()
+        );
+    }
+
+    MarkBreadcrumb("DrawStreamOutput");
 }
 
 /* ----- Compute ----- */
 
 void VKCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     FlushDescriptorCache();
+    barriers_->Flush(commandBuffer_);
     vkCmdDispatch(commandBuffer_, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    pendingIndirectBarrier_ = true;
+
+    MarkBreadcrumb("Dispatch");
 }
 
 void VKCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
     FlushDescriptorCache();
+    InsertIndirectArgumentBarrier();
+    barriers_->Flush(commandBuffer_);
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDispatchIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset);
+    pendingIndirectBarrier_ = true;
+
+    MarkBreadcrumb("DispatchIndirect");
+}
+
+void VKCommandBuffer::CompactIndirectArguments(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    Buffer&         countBuffer,
+    std::uint64_t   countOffset,
+    Buffer&         srcBuffer,
+    std::uint64_t   srcOffset,
+    Buffer&         visibilityBuffer,
+    std::uint64_t   visibilityOffset,
+    std::uint32_t   numCommands,
+    std::uint32_t   stride)
+{
+    LLGL_FRAME_COUNTER_INC(dispatchCommands);
+
+    auto& dstBufferVK           = LLGL_CAST(VKBuffer&, dstBuffer);
+    auto& countBufferVK         = LLGL_CAST(VKBuffer&, countBuffer);
+    auto& srcBufferVK           = LLGL_CAST(VKBuffer&, srcBuffer);
+    auto& visibilityBufferVK    = LLGL_CAST(VKBuffer&, visibilityBuffer);
+
+    MarkBreadcrumb("CompactIndirectArguments");
+
+    VKIndirectArgumentCompactor::Get().CompactIndirectArguments(
+        commandBuffer_,
+        *barriers_,
+        dstBufferVK,        dstOffset,
+        countBufferVK,      countOffset,
+        srcBufferVK,        srcOffset,
+        visibilityBufferVK, visibilityOffset,
+        numCommands,
+        stride
+    );
+    RestoreComputePipeline();
+}
+
+/* ----- Ray Tracing ----- */
+
+void VKCommandBuffer::BuildAccelerationStructure(AccelerationStructure& accelerationStructure, const AccelerationStructureBuildDescriptor& buildDesc)
+{
+    auto& accelStructVK = LLGL_CAST(VKAccelerationStructure&, accelerationStructure);
+    accelStructVK.Build(commandBuffer_, *barriers_, buildDesc);
+
+    MarkBreadcrumb("BuildAccelerationStructure");
+}
+
+void VKCommandBuffer::CopyAccelerationStructure(AccelerationStructure& dstAccelerationStructure, AccelerationStructure& srcAccelerationStructure, bool compact)
+{
+    auto& dstAccelStructVK = LLGL_CAST(VKAccelerationStructure&, dstAccelerationStructure);
+    auto& srcAccelStructVK = LLGL_CAST(VKAccelerationStructure&, srcAccelerationStructure);
+    dstAccelStructVK.Copy(commandBuffer_, *barriers_, srcAccelStructVK, compact);
+
+    MarkBreadcrumb("CopyAccelerationStructure");
 }
 
 /* ----- Debugging ----- */
@@ -1043,12 +1579,18 @@ void VKCommandBuffer::PushDebugGroup(const char* name)
         }
         vkCmdDebugMarkerBeginEXT(commandBuffer_, &markerInfo);
     }
+
+    if (breadcrumbs_.IsRegistered())
+        WriteBreadcrumb(breadcrumbs_.PushDebugGroup(name));
 }
 
 void VKCommandBuffer::PopDebugGroup()
 {
     if (HasExtension(VKExt::EXT_debug_marker))
         vkCmdDebugMarkerEndEXT(commandBuffer_);
+
+    if (breadcrumbs_.IsRegistered())
+        WriteBreadcrumb(breadcrumbs_.PopDebugGroup());
 }
 
 /* ----- Extensions ----- */
@@ -1121,6 +1663,180 @@ void VKCommandBuffer::CreateVkRecordingFences()
     }
 }
 
+void VKCommandBuffer::CreateBreadcrumbBuffer(const VKPhysicalDevice& physicalDevice)
+{
+    /* Create buffer for the last started and last completed marker */
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = sizeof(std::uint32_t) * 2;
+        createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    VkResult result = vkCreateBuffer(device_, &createInfo, nullptr, breadcrumbBuffer_.ReleaseAndGetAddressOf());
+    VKThrowIfCreateFailed(result, "VkBuffer", "for GPU breadcrumbs");
+
+    /* Allocate host-coherent memory, so the markers can still be read after the device has been lost */
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device_, breadcrumbBuffer_, &requirements);
+
+    VkMemoryAllocateInfo allocInfo;
+    {
+        allocInfo.sType             = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.pNext             = nullptr;
+        allocInfo.allocationSize    = requirements.size;
+        allocInfo.memoryTypeIndex   = physicalDevice.FindMemoryType(
+            requirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        );
+    }
+    result = vkAllocateMemory(device_, &allocInfo, nullptr, breadcrumbMemory_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to allocate Vulkan device memory for GPU breadcrumbs");
+
+    result = vkBindBufferMemory(device_, breadcrumbBuffer_, breadcrumbMemory_, 0);
+    VKThrowIfFailed(result, "failed to bind Vulkan buffer to device memory for GPU breadcrumbs");
+
+    /* Keep memory persistently mapped; it's implicitly unmapped when the memory is freed */
+    void* mappedMemory = nullptr;
+    result = vkMapMemory(device_, breadcrumbMemory_, 0, VK_WHOLE_SIZE, 0, &mappedMemory);
+    VKThrowIfFailed(result, "failed to map Vulkan device memory for GPU breadcrumbs");
+
+    ::memset(mappedMemory, 0, sizeof(std::uint32_t) * 2);
+    breadcrumbs_.Register(static_cast<const volatile std::uint32_t*>(mappedMemory));
+}
+
+void VKCommandBuffer::CreatePatternBuffer()
+{
+    /* Create scratch buffer that is both source and destination of the pattern replication */
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = g_patternBufferSize;
+        createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    VkResult result = vkCreateBuffer(device_, &createInfo, nullptr, patternBuffer_.ReleaseAndGetAddressOf());
+    VKThrowIfCreateFailed(result, "VkBuffer", "for buffer fill patterns");
+
+    /* Allocate device-local memory, since this buffer is only accessed by transfer commands */
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device_, patternBuffer_, &requirements);
+
+    VkMemoryAllocateInfo allocInfo;
+    {
+        allocInfo.sType             = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.pNext             = nullptr;
+        allocInfo.allocationSize    = requirements.size;
+        allocInfo.memoryTypeIndex   = physicalDevice_.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+    result = vkAllocateMemory(device_, &allocInfo, nullptr, patternMemory_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to allocate Vulkan device memory for buffer fill patterns");
+
+    result = vkBindBufferMemory(device_, patternBuffer_, patternMemory_, 0);
+    VKThrowIfFailed(result, "failed to bind Vulkan buffer to device memory for buffer fill patterns");
+}
+
+void VKCommandBuffer::WritePatternBuffer(const void* pattern, std::uint32_t patternSize, VkDeviceSize size)
+{
+    /* Previous copies from the pattern buffer must be complete before it is overwritten */
+    barriers_->InsertBufferBarrier(
+        patternBuffer_,
+        0,
+        VK_WHOLE_SIZE,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT
+    );
+    barriers_->FlushForTransfer(commandBuffer_, VK_NULL_HANDLE, patternBuffer_);
+
+    /* Write first block of the replicated pattern inline with the command stream */
+    std::uint8_t patternBlock[g_patternBlockSize];
+    const VkDeviceSize blockSize = std::min<VkDeviceSize>(size, g_patternBlockSize);
+
+    for (VkDeviceSize offset = 0; offset < blockSize; offset += patternSize)
+        ::memcpy(patternBlock + offset, pattern, patternSize);
+
+    vkCmdUpdateBuffer(commandBuffer_, patternBuffer_, 0, blockSize, patternBlock);
+
+    /* Double the replicated range with non-overlapping copies within the pattern buffer */
+    for (VkDeviceSize replicatedSize = blockSize; replicatedSize < size; replicatedSize *= 2)
+    {
+        barriers_->InsertBufferBarrier(
+            patternBuffer_,
+            0,
+            replicatedSize,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_TRANSFER_READ_BIT
+        );
+        barriers_->FlushForTransfer(commandBuffer_, patternBuffer_, patternBuffer_);
+
+        VkBufferCopy region;
+        {
+            region.srcOffset    = 0;
+            region.dstOffset    = replicatedSize;
+            region.size         = std::min(replicatedSize, size - replicatedSize);
+        }
+        vkCmdCopyBuffer(commandBuffer_, patternBuffer_, patternBuffer_, 1, &region);
+    }
+
+    /* Make replicated pattern visible to the copy into the destination buffer */
+    barriers_->InsertBufferBarrier(
+        patternBuffer_,
+        0,
+        size,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_TRANSFER_READ_BIT
+    );
+}
+
+void VKCommandBuffer::CopyPatternBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize size)
+{
+    barriers_->FlushForTransfer(commandBuffer_, patternBuffer_, dstBuffer);
+
+    /* Copy pattern buffer into consecutive destination ranges; the pattern buffer size is a multiple of all pattern sizes */
+    constexpr std::uint32_t maxNumRegions = 64;
+
+    VkBufferCopy regions[maxNumRegions];
+    std::uint32_t numRegions = 0;
+
+    for (VkDeviceSize offset = 0; offset < size; offset += g_patternBufferSize)
+    {
+        VkBufferCopy& region = regions[numRegions++];
+        {
+            region.srcOffset    = 0;
+            region.dstOffset    = dstOffset + offset;
+            region.size         = std::min(g_patternBufferSize, size - offset);
+        }
+        if (numRegions == maxNumRegions)
+        {
+            vkCmdCopyBuffer(commandBuffer_, patternBuffer_, dstBuffer, numRegions, regions);
+            numRegions = 0;
+        }
+    }
+
+    if (numRegions > 0)
+        vkCmdCopyBuffer(commandBuffer_, patternBuffer_, dstBuffer, numRegions, regions);
+}
+
+void VKCommandBuffer::WriteBreadcrumb(std::uint32_t marker)
+{
+    vkCmdWriteBufferMarkerAMD(commandBuffer_, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, breadcrumbBuffer_, 0, marker);
+    vkCmdWriteBufferMarkerAMD(commandBuffer_, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, breadcrumbBuffer_, sizeof(std::uint32_t), marker);
+}
+
 void VKCommandBuffer::ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments)
 {
     if (numAttachments > 0)
@@ -1195,11 +1911,24 @@ void VKCommandBuffer::ConvertRenderPassClearValues(
 
 void VKCommandBuffer::PauseRenderPass()
 {
-    vkCmdEndRenderPass(commandBuffer_);
+    if (HasExtension(VKExt::KHR_dynamic_rendering))
+        VKCmdEndRendering(commandBuffer_, *barriers_, *renderingAttachments_);
+    else
+        vkCmdEndRenderPass(commandBuffer_);
 }
 
 void VKCommandBuffer::ResumeRenderPass()
 {
+    /* Resume dynamic rendering by loading the contents of all attachments */
+    if (HasExtension(VKExt::KHR_dynamic_rendering))
+    {
+        VKCmdBeginRendering(commandBuffer_, *barriers_, *renderingAttachments_, *boundRenderPass_, framebufferRenderArea_, nullptr, true, GetRenderingFlags());
+        return;
+    }
+
+    /* Record pending barriers of the transfer commands before the render pass resumes */
+    barriers_->Flush(commandBuffer_);
+
     /* Record begin of render pass */
     VkRenderPassBeginInfo beginInfo;
     {
@@ -1211,7 +1940,7 @@ void VKCommandBuffer::ResumeRenderPass()
         beginInfo.clearValueCount   = 0;
         beginInfo.pClearValues      = nullptr;
     }
-    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, subpassContents_);
 }
 
 bool VKCommandBuffer::IsInsideRenderPass() const
@@ -1219,6 +1948,11 @@ bool VKCommandBuffer::IsInsideRenderPass() const
     return (recordState_ == RecordState::InsideRenderPass);
 }
 
+VkRenderingFlagsKHR VKCommandBuffer::GetRenderingFlags() const
+{
+    return (subpassContents_ == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0);
+}
+
 void VKCommandBuffer::BufferPipelineBarrier(
     VkBuffer                buffer,
     VkDeviceSize            offset,
@@ -1228,27 +1962,93 @@ void VKCommandBuffer::BufferPipelineBarrier(
     VkPipelineStageFlags    srcStageMask,
     VkPipelineStageFlags    dstStageMask)
 {
-    VkBufferMemoryBarrier barrier;
+    barriers_->InsertBufferBarrier(buffer, offset, size, srcStageMask, dstStageMask, srcAccessMask, dstAccessMask, splitBarriers_);
+}
+
+void VKCommandBuffer::HostReadBarrier(const VKBuffer& bufferVK, VkDeviceSize offset, VkDeviceSize size)
+{
+    /* Make transfer writes into host-visible buffers available to the host; this must not be a split barrier, since host accesses cannot wait for events */
+    if (bufferVK.IsHostVisible())
     {
-        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-        barrier.pNext               = nullptr;
-        barrier.srcAccessMask       = srcAccessMask;
-        barrier.dstAccessMask       = dstAccessMask;
-        barrier.srcQueueFamilyIndex = 0;
-        barrier.dstQueueFamilyIndex = 0;
-        barrier.buffer              = buffer;
-        barrier.offset              = offset;
-        barrier.size                = size;
+        barriers_->InsertBufferBarrier(
+            bufferVK.GetVkBuffer(),
+            offset,
+            size,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_HOST_READ_BIT
+        );
     }
-    vkCmdPipelineBarrier(commandBuffer_, srcStageMask, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
 }
 
 void VKCommandBuffer::FlushDescriptorCache()
 {
     if (descriptorCache_ != nullptr && descriptorCache_->IsInvalidated())
     {
-        VkDescriptorSet descriptorSet = descriptorCache_->FlushDescriptorSet(*descriptorSetPool_);
-        boundPipelineState_->BindDynamicDescriptorSet(commandBuffer_, descriptorSet);
+        if (descriptorCache_->IsPushDescriptorSet())
+        {
+            /* Push descriptors directly into the command buffer without allocating a new descriptor set */
+            boundPipelineState_->PushDynamicDescriptorSet(commandBuffer_, *descriptorCache_);
+        }
+        else
+        {
+            VkDescriptorSet descriptorSet = descriptorCache_->FlushDescriptorSet(*descriptorSetPool_);
+            boundPipelineState_->BindDynamicDescriptorSet(commandBuffer_, descriptorSet);
+        }
+    }
+}
+
+void VKCommandBuffer::GenerateMipsForSubresource(VKTexture& textureVK, const TextureSubresource& subresource)
+{
+    if (VKMipGenerator::Get().GenerateMips(device_, commandBuffer_, *barriers_, textureVK, subresource))
+        RestoreComputePipeline();
+}
+
+void VKCommandBuffer::InsertIndirectArgumentBarrier()
+{
+    /*
+    Compute shaders commonly write the arguments of subsequent indirect commands, but LLGL has no explicit barrier for that.
+    This barrier is only inserted once indirect arguments may actually be read, so consecutive dispatch commands are not serialized.
+    */
+    if (pendingIndirectBarrier_)
+    {
+        barriers_->InsertMemoryBarrier(
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+        );
+        pendingIndirectBarrier_ = false;
+    }
+}
+
+void VKCommandBuffer::InsertStreamOutputBarrier()
+{
+    /*
+    Stream-outputs can only be drawn in a subsequent render pass, since barriers inside a render pass would require a subpass self-dependency.
+    This makes the captured vertices and the transform feedback counters visible to the vertex input and indirect draw stages.
+    */
+    if (pendingStreamOutputBarrier_)
+    {
+        barriers_->InsertMemoryBarrier(
+            VK_PIPELINE_STAGE_TRANSFORM_FEEDBACK_BIT_EXT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+            VK_ACCESS_TRANSFORM_FEEDBACK_WRITE_BIT_EXT | VK_ACCESS_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT,
+            VK_ACCESS_TRANSFORM_FEEDBACK_COUNTER_READ_BIT_EXT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+        );
+        pendingStreamOutputBarrier_ = false;
+    }
+}
+
+void VKCommandBuffer::RestoreComputePipeline()
+{
+    /* Rebind compute PSO that was replaced by a built-in compute shader; dynamic resources must be set again as after SetPipelineState */
+    if (boundPipelineState_ != nullptr && pipelineBindPoint_ == VK_PIPELINE_BIND_POINT_COMPUTE)
+    {
+        boundPipelineState_->BindPipelineAndStaticDescriptorSet(commandBuffer_);
+        if (descriptorCache_ != nullptr)
+            descriptorCache_->Reset();
     }
 }
 
@@ -1258,7 +2058,8 @@ void VKCommandBuffer::AcquireNextBuffer()
     commandBuffer_      = commandBufferArray_[commandBufferIndex_];
     recordingFence_     = recordingFenceArray_[commandBufferIndex_].Get();
     descriptorSetPool_  = &(descriptorSetPoolArray_[commandBufferIndex_]);
-    descriptorSetPool_->Reset();
+    barriers_           = &(barrierAccumulatorArray_[commandBufferIndex_]);
+    recordingToken_     = &(recordingTokenArray_[commandBufferIndex_]);
 }
 
 void VKCommandBuffer::ResetBindingStates()
@@ -1269,28 +2070,93 @@ void VKCommandBuffer::ResetBindingStates()
     descriptorCache_        = nullptr;
 }
 
-void VKCommandBuffer::ResetQueryPoolsInFlight()
+void VKCommandBuffer::GetInheritanceInfo(
+    VkCommandBufferInheritanceInfo&             outInheritanceInfo,
+    VkCommandBufferInheritanceRenderingInfoKHR& outRenderingInfo,
+    VkFormat*                                   outColorAttachmentFormats) const
 {
-    for_range(i, numQueryHeapsInFlight_)
+    /* Inherit subpass 0 with an unspecified framebuffer, since the render pass can be begun with any compatible framebuffer */
+    outInheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    outInheritanceInfo.pNext                = nullptr;
+    outInheritanceInfo.renderPass           = VK_NULL_HANDLE;
+    outInheritanceInfo.subpass              = 0;
+    outInheritanceInfo.framebuffer          = VK_NULL_HANDLE;
+    outInheritanceInfo.occlusionQueryEnable = VK_FALSE;
+    outInheritanceInfo.queryFlags           = 0;
+    outInheritanceInfo.pipelineStatistics   = 0;
+
+    if (inheritedRenderPass_ == nullptr)
+        return;
+
+    if (HasExtension(VKExt::KHR_dynamic_rendering))
     {
-        auto& queryHeapVK = *(queryHeapsInFlight_[0]);
-        vkCmdResetQueryPool(
-            commandBuffer_,
-            queryHeapVK.GetVkQueryPool(),
-            0,
-            queryHeapVK.GetNumQueries()
-        );
+        /* Attachment formats must match the dynamic render pass of the primary command buffer, just like for graphics pipelines */
+        const std::uint32_t numColorAttachments = inheritedRenderPass_->GetNumColorAttachments();
+        for_range(i, numColorAttachments)
+            outColorAttachmentFormats[i] = inheritedRenderPass_->GetAttachmentDesc(i).format;
+
+        VkFormat depthStencilFormat = VK_FORMAT_UNDEFINED;
+        if (inheritedRenderPass_->GetDepthStencilIndex() != 0xFFu)
+            depthStencilFormat = inheritedRenderPass_->GetAttachmentDesc(inheritedRenderPass_->GetDepthStencilIndex()).format;
+
+        outRenderingInfo.sType                      = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+        outRenderingInfo.pNext                      = nullptr;
+        outRenderingInfo.flags                      = 0;
+        outRenderingInfo.viewMask                   = inheritedRenderPass_->GetViewMask();
+        outRenderingInfo.colorAttachmentCount       = numColorAttachments;
+        outRenderingInfo.pColorAttachmentFormats    = outColorAttachmentFormats;
+        outRenderingInfo.depthAttachmentFormat      = (VKTypes::IsVkFormatDepthStencil(depthStencilFormat) && depthStencilFormat != VK_FORMAT_S8_UINT ? depthStencilFormat : VK_FORMAT_UNDEFINED);
+        outRenderingInfo.stencilAttachmentFormat    = (VKTypes::IsVkFormatStencil(depthStencilFormat) ? depthStencilFormat : VK_FORMAT_UNDEFINED);
+        outRenderingInfo.rasterizationSamples       = inheritedRenderPass_->GetSampleCountBits();
+
+        outInheritanceInfo.pNext = &outRenderingInfo;
     }
-    numQueryHeapsInFlight_ = 0;
+    else
+        outInheritanceInfo.renderPass = inheritedRenderPass_->GetVkRenderPass();
 }
 
-void VKCommandBuffer::AppendQueryPoolInFlight(VKQueryHeap* queryHeap)
+void VKCommandBuffer::CopyQueryResultsInFlight()
 {
-    if (numQueryHeapsInFlight_ >= queryHeapsInFlight_.size())
-        queryHeapsInFlight_.push_back(queryHeap);
-    else
-        queryHeapsInFlight_[numQueryHeapsInFlight_] = queryHeap;
-    ++numQueryHeapsInFlight_;
+    if (queryRangesInFlight_.empty())
+        return;
+
+    for (const QueryRangeInFlight& range : queryRangesInFlight_)
+        range.queryHeap->CopyResults(commandBuffer_, range.firstQuery, range.numQueries);
+
+    /* Make query results visible to the host once this command buffer has been completed */
+    VkMemoryBarrier memoryBarrier;
+    {
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext         = nullptr;
+        memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    }
+    vkCmdPipelineBarrier(
+        commandBuffer_,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        1, &memoryBarrier,
+        0, nullptr,
+        0, nullptr
+    );
+
+    queryRangesInFlight_.clear();
+}
+
+void VKCommandBuffer::AppendQueryRangeInFlight(VKQueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    /* Merge with previous range if queries are ended consecutively */
+    if (!queryRangesInFlight_.empty())
+    {
+        QueryRangeInFlight& prevRange = queryRangesInFlight_.back();
+        if (prevRange.queryHeap == &queryHeap && prevRange.firstQuery + prevRange.numQueries == firstQuery)
+        {
+            prevRange.numQueries += numQueries;
+            return;
+        }
+    }
+    queryRangesInFlight_.push_back(QueryRangeInFlight{ &queryHeap, firstQuery, numQueries });
 }
 
 std::uint32_t VKCommandBuffer::GetNumVkCommandBuffers(const CommandBufferDescriptor& desc)
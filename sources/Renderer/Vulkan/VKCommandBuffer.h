@@ -10,11 +10,16 @@
 
 
 #include <LLGL/CommandBuffer.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/StaticLimits.h>
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "RenderState/VKStagingDescriptorSetPool.h"
 #include "RenderState/VKDescriptorCache.h"
+#include "RenderState/VKBarrierAccumulator.h"
+#include "RenderState/VKRecordingToken.h"
+#include "../GPUBreadcrumbs.h"
 #include <vector>
 
 
@@ -29,6 +34,9 @@ class VKRenderPass;
 class VKQueryHeap;
 class VKSwapChain;
 class VKPipelineState;
+class VKTexture;
+class VKBuffer;
+struct VKRenderingAttachments;
 
 class VKCommandBuffer final : public CommandBuffer
 {
@@ -43,8 +51,9 @@ class VKCommandBuffer final : public CommandBuffer
             const VKPhysicalDevice&         physicalDevice,
             VKDevice&                       device,
             VkQueue                         commandQueue,
-            const QueueFamilyIndices&       queueFamilyIndices,
-            const CommandBufferDescriptor&  desc
+            std::uint32_t                   queueFamilyIndex,
+            const CommandBufferDescriptor&  desc,
+            bool                            breadcrumbsEnabled
         );
 
         ~VKCommandBuffer();
@@ -71,6 +80,18 @@ class VKCommandBuffer final : public CommandBuffer
             return immediateSubmit_;
         }
 
+        // Returns true if this is a secondary command buffer, i.e. it was created with CommandBufferFlags::Secondary.
+        inline bool IsSecondaryCmdBuffer() const
+        {
+            return secondary_;
+        }
+
+        // Returns the frame counters of the current encoding. See LLGL_ENABLE_FRAME_COUNTERS.
+        inline const FrameProfile& GetFrameCounters() const
+        {
+            return frameCounters_;
+        }
+
     private:
 
         enum class RecordState
@@ -81,12 +102,42 @@ class VKCommandBuffer final : public CommandBuffer
             ReadyForSubmit,     // after "End"
         };
 
+        // Range of native queries that have been ended in this command buffer.
+        struct QueryRangeInFlight
+        {
+            VKQueryHeap*    queryHeap;
+            std::uint32_t   firstQuery;
+            std::uint32_t   numQueries;
+        };
+
     private:
 
         void CreateVkCommandPool(std::uint32_t queueFamilyIndex);
         void CreateVkCommandBuffers(VkCommandBufferLevel level);
         void CreateVkRecordingFences();
 
+        // Creates the host-visible buffer the breadcrumb markers are written into. See RenderSystemFlags::GPUBreadcrumbs.
+        void CreateBreadcrumbBuffer(const VKPhysicalDevice& physicalDevice);
+
+        // Creates the device-local buffer fill patterns are replicated into. See VKCommandBuffer::FillBufferPattern.
+        void CreatePatternBuffer();
+
+        // Replicates the specified pattern into the first 'size' bytes of the pattern buffer; 'size' must not exceed the pattern buffer size.
+        void WritePatternBuffer(const void* pattern, std::uint32_t patternSize, VkDeviceSize size);
+
+        // Copies the replicated pattern from the pattern buffer into the specified destination buffer range.
+        void CopyPatternBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize size);
+
+        // Writes the specified marker as the last started and last completed command into the breadcrumb buffer.
+        void WriteBreadcrumb(std::uint32_t marker);
+
+        // Writes a breadcrumb marker for the specified command if breadcrumbs are enabled.
+        inline void MarkBreadcrumb(const char* command)
+        {
+            if (breadcrumbs_.IsRegistered())
+                WriteBreadcrumb(breadcrumbs_.MarkCommand(command));
+        }
+
         void ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments);
 
         void ConvertRenderPassClearValues(
@@ -102,6 +153,10 @@ class VKCommandBuffer final : public CommandBuffer
 
         bool IsInsideRenderPass() const;
 
+        // Returns the flags for VK_KHR_dynamic_rendering that correspond to the subpass contents of the current render pass.
+        VkRenderingFlagsKHR GetRenderingFlags() const;
+
+        // Inserts a buffer barrier into the barrier accumulator, which is recorded before the next draw, dispatch, or transfer command.
         void BufferPipelineBarrier(
             VkBuffer                buffer,
             VkDeviceSize            offset,
@@ -112,17 +167,38 @@ class VKCommandBuffer final : public CommandBuffer
             VkPipelineStageFlags    dstStageMask    = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
         );
 
+        // Inserts a barrier that makes preceding transfer writes into the specified buffer visible to the host, if the buffer is host-visible.
+        void HostReadBarrier(const VKBuffer& bufferVK, VkDeviceSize offset, VkDeviceSize size);
+
         void FlushDescriptorCache();
 
+        // Generates the MIP-maps of the specified texture subresource and restores the compute pipeline if it was replaced.
+        void GenerateMipsForSubresource(VKTexture& textureVK, const TextureSubresource& subresource);
+
+        // Inserts a barrier from previous dispatch commands to indirect commands, if a dispatch has been recorded since the last one.
+        void InsertIndirectArgumentBarrier();
+
+        // Inserts a barrier from the previous stream-output section to vertex input and indirect draw commands, if a stream-output has ended since the last one.
+        void InsertStreamOutputBarrier();
+
+        // Restores the compute pipeline binding after it has been replaced by a built-in compute shader, e.g. for MIP-map generation.
+        void RestoreComputePipeline();
+
         // Acquires the next native VkCommandBuffer object.
         void AcquireNextBuffer();
 
         void ResetBindingStates();
 
-        #if 1//TODO: optimize
-        void ResetQueryPoolsInFlight();
-        void AppendQueryPoolInFlight(VKQueryHeap* queryHeap);
-        #endif
+        // Returns the inheritance info for secondary command buffers. The rendering info is only chained for an inherited render pass with VK_KHR_dynamic_rendering.
+        void GetInheritanceInfo(
+            VkCommandBufferInheritanceInfo&             outInheritanceInfo,
+            VkCommandBufferInheritanceRenderingInfoKHR& outRenderingInfo,
+            VkFormat*                                   outColorAttachmentFormats
+        ) const;
+
+        // Records commands to copy the results of all queries that have been ended in this command buffer into their readback buffers.
+        void CopyQueryResultsInFlight();
+        void AppendQueryRangeInFlight(VKQueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries);
 
     private:
 
@@ -133,6 +209,7 @@ class VKCommandBuffer final : public CommandBuffer
 
         static constexpr std::uint32_t maxNumCommandBuffers = 3;
 
+        const VKPhysicalDevice&         physicalDevice_;
         VKDevice&                       device_;
 
         VkQueue                         commandQueue_               = VK_NULL_HANDLE;
@@ -150,6 +227,8 @@ class VKCommandBuffer final : public CommandBuffer
 
         VkCommandBufferUsageFlags       usageFlags_                 = 0;
         bool                            immediateSubmit_            = false;
+        bool                            secondary_                  = false;
+        const VKRenderPass*             inheritedRenderPass_        = nullptr;        // render pass a secondary command buffer is recorded into (see CommandBufferDescriptor::renderPass)
 
         VKSwapChain*                    boundSwapChain_             = nullptr;
         std::uint32_t                   currentColorBuffer_         = 0;
@@ -157,12 +236,13 @@ class VKCommandBuffer final : public CommandBuffer
         VkRenderPass                    renderPass_                 = VK_NULL_HANDLE; // primary render pass
         VkRenderPass                    secondaryRenderPass_        = VK_NULL_HANDLE; // to pause/resume render pass (load and store content)
         VkFramebuffer                   framebuffer_                = VK_NULL_HANDLE; // active framebuffer handle
+        const VKRenderPass*             boundRenderPass_            = nullptr;        // active render pass for VK_KHR_dynamic_rendering
+        const VKRenderingAttachments*   renderingAttachments_       = nullptr;        // active framebuffer attachments for VK_KHR_dynamic_rendering
         VkRect2D                        framebufferRenderArea_      = { { 0, 0 }, { 0, 0 } };
+        VkSubpassContents               subpassContents_            = VK_SUBPASS_CONTENTS_INLINE;
         std::uint32_t                   numColorAttachments_        = 0;
         bool                            hasDepthStencilAttachment_  = false;
 
-        std::uint32_t                   queuePresentFamily_         = 0;
-
         bool                            scissorEnabled_             = false;
         bool                            scissorRectInvalidated_     = true;
         VkPipelineBindPoint             pipelineBindPoint_          = VK_PIPELINE_BIND_POINT_MAX_ENUM;
@@ -171,14 +251,34 @@ class VKCommandBuffer final : public CommandBuffer
 
         std::uint32_t                   maxDrawIndirectCount_       = 0;
 
+        VKBuffer*                       boundVertexBuffer_          = nullptr;        // First bound vertex buffer, which is the source for DrawStreamOutput
+        VkBuffer                        soCounterBuffers_[LLGL_MAX_NUM_SO_BUFFERS];
+        VkDeviceSize                    soCounterOffsets_[LLGL_MAX_NUM_SO_BUFFERS];
+        std::uint32_t                   numSOCounterBuffers_        = 0;
+
         VKStagingDescriptorSetPool      descriptorSetPoolArray_[maxNumCommandBuffers];
         VKStagingDescriptorSetPool*     descriptorSetPool_          = nullptr;
         VKDescriptorCache*              descriptorCache_            = nullptr;
 
-        #if 1//TODO: optimize usage of query pools
-        std::vector<VKQueryHeap*>       queryHeapsInFlight_;
-        std::size_t                     numQueryHeapsInFlight_      = 0;
-        #endif
+        VKBarrierAccumulator            barrierAccumulatorArray_[maxNumCommandBuffers];
+        VKBarrierAccumulator*           barriers_                   = nullptr;
+
+        VKRecordingTokenPtr             recordingTokenArray_[maxNumCommandBuffers];   // Completion state of the current recording of each native command buffer, for versioned resource heaps
+        VKRecordingTokenPtr*            recordingToken_             = nullptr;
+        bool                            splitBarriers_              = false;          // Use split barriers for deferrable barriers
+        bool                            pendingIndirectBarrier_     = false;          // Dispatch commands may have written indirect arguments since the last indirect barrier
+        bool                            pendingStreamOutputBarrier_ = false;          // Stream-output has written vertices and counters since the last stream-output barrier
+
+        std::vector<QueryRangeInFlight> queryRangesInFlight_;                         // Ranges of native queries whose results are copied at the end of this command buffer
+
+        FrameProfile                    frameCounters_;
+
+        VKPtr<VkBuffer>                 breadcrumbBuffer_;
+        VKPtr<VkDeviceMemory>           breadcrumbMemory_;                            // Dedicated allocation to keep it persistently mapped
+        GPUBreadcrumbTrail              breadcrumbs_;                                 // Must be destroyed before its memory is released
+
+        VKPtr<VkBuffer>                 patternBuffer_;                               // Device-local scratch buffer for FillBufferPattern, created on first use
+        VKPtr<VkDeviceMemory>           patternMemory_;
 
 };
 
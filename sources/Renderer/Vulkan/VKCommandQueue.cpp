@@ -7,10 +7,21 @@
 
 #include "VKCommandQueue.h"
 #include "VKCommandBuffer.h"
+#include "VKDevice.h"
+#include "VKPhysicalDevice.h"
+#include "VKSwapChain.h"
+#include "Ext/VKExtensionRegistry.h"
+#include "Ext/VKExtensions.h"
 #include "RenderState/VKFence.h"
 #include "RenderState/VKQueryHeap.h"
+#include "Buffer/VKBuffer.h"
+#include "Texture/VKTexture.h"
+#include "Memory/VKDeviceMemoryManager.h"
 #include "../CheckedCast.h"
 #include "VKCore.h"
+#include "../HostTrace.h"
+#include <LLGL/Utils/ForRange.h>
+#include <LLGL/Container/SmallVector.h>
 
 
 namespace LLGL
@@ -34,19 +45,93 @@ VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuff
     return vkQueueSubmit(commandQueue, 1, &submitInfo, fence);
 }
 
-VKCommandQueue::VKCommandQueue(VkDevice device, VkQueue queue) :
-    device_ { device },
-    native_ { queue  }
+VKCommandQueue::VKCommandQueue(const VKPhysicalDevice& physicalDevice, VKDevice& device, VkQueue queue, VKDeviceMemoryManager& deviceMemoryMngr) :
+    physicalDevice_       { physicalDevice                                                  },
+    device_               { device                                                          },
+    native_               { queue                                                           },
+    deviceMemoryMngr_     { deviceMemoryMngr                                                },
+    sparseBindSemaphores_ { { device, vkDestroySemaphore }, { device, vkDestroySemaphore }  },
+    sparseBindFence_      { device, vkDestroyFence                                          }
 {
 }
 
+VKCommandQueue::~VKCommandQueue()
+{
+    WaitForSparseBinding();
+}
+
+void VKCommandQueue::BindSparseMemory(VkBindSparseInfo& bindInfo, std::vector<VKDeviceMemoryRegion*>& retiredRegions)
+{
+    /* Fence and semaphores can only be reused once the previous sparse binding has completed */
+    if (sparseBindFence_.Get() == VK_NULL_HANDLE)
+        CreateSparseBindObjects();
+    else
+        WaitForSparseBinding();
+
+    /* Queue submissions must be externally synchronized */
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+    device_.FlushPendingUploads(native_);
+
+    /*
+    Queue submissions and sparse bindings are not implicitly ordered, even on the same queue.
+    Enclose the binding between two empty batches that signal and wait for the binary semaphores.
+    */
+    VkSubmitInfo signalInfo;
+    {
+        signalInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        signalInfo.pNext                = nullptr;
+        signalInfo.waitSemaphoreCount   = 0;
+        signalInfo.pWaitSemaphores      = nullptr;
+        signalInfo.pWaitDstStageMask    = nullptr;
+        signalInfo.commandBufferCount   = 0;
+        signalInfo.pCommandBuffers      = nullptr;
+        signalInfo.signalSemaphoreCount = 1;
+        signalInfo.pSignalSemaphores    = sparseBindSemaphores_[0].GetAddressOf();
+    }
+    VkResult result = vkQueueSubmit(native_, 1, &signalInfo, VK_NULL_HANDLE);
+    VKThrowIfFailed(result, "failed to submit Vulkan semaphore signal before sparse binding");
+
+    bindInfo.waitSemaphoreCount     = 1;
+    bindInfo.pWaitSemaphores        = sparseBindSemaphores_[0].GetAddressOf();
+    bindInfo.signalSemaphoreCount   = 1;
+    bindInfo.pSignalSemaphores      = sparseBindSemaphores_[1].GetAddressOf();
+
+    result = vkQueueBindSparse(native_, 1, &bindInfo, sparseBindFence_);
+    VKThrowIfFailed(result, "failed to bind Vulkan sparse memory");
+
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo waitInfo;
+    {
+        waitInfo.sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        waitInfo.pNext                  = nullptr;
+        waitInfo.waitSemaphoreCount     = 1;
+        waitInfo.pWaitSemaphores        = sparseBindSemaphores_[1].GetAddressOf();
+        waitInfo.pWaitDstStageMask      = &waitStage;
+        waitInfo.commandBufferCount     = 0;
+        waitInfo.pCommandBuffers        = nullptr;
+        waitInfo.signalSemaphoreCount   = 0;
+        waitInfo.pSignalSemaphores      = nullptr;
+    }
+    result = vkQueueSubmit(native_, 1, &waitInfo, VK_NULL_HANDLE);
+    VKThrowIfFailed(result, "failed to submit Vulkan semaphore wait after sparse binding");
+
+    /* Take ownership of retired memory regions until the fence is signaled */
+    retiredSparseRegions_.insert(retiredSparseRegions_.end(), retiredRegions.begin(), retiredRegions.end());
+    retiredRegions.clear();
+    sparseBindPending_ = true;
+}
+
 /* ----- Command Buffers ----- */
 
 void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_HOST_TRACE_SCOPE("Submit");
+
     auto& commandBufferVK = LLGL_CAST(VKCommandBuffer&, commandBuffer);
     if (!commandBufferVK.IsImmediateCmdBuffer())
     {
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+        device_.FlushPendingUploads(native_);
         auto result = VKSubmitCommandBuffer(
             native_,
             commandBufferVK.GetVkCommandBuffer(),
@@ -54,6 +139,118 @@ void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
         );
         VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
     }
+    frameCounters_.SubmitCommandBuffer(commandBufferVK.GetFrameCounters());
+}
+
+/* ----- Presentation ----- */
+
+void VKCommandQueue::Present(std::uint32_t numSwapChains, SwapChain* const * swapChains)
+{
+    LLGL_HOST_TRACE_SCOPE("Present");
+
+    SmallVector<VKSwapChain*, 8>    batchSwapChains;
+    SmallVector<VkSwapchainKHR, 8>  nativeSwapChains;
+    SmallVector<std::uint32_t, 8>   imageIndices;
+    SmallVector<VkSemaphore, 8>     signalSemaphores;
+    SmallVector<VkFence, 8>         frameFences;
+    SmallVector<std::uint64_t, 8>   presentIDs;
+    VkQueue                         presentQueue    = VK_NULL_HANDLE;
+
+    for_range(i, numSwapChains)
+    {
+        if (swapChains[i] == nullptr)
+            continue;
+
+        /* Swap-chains that are rendered or presented with other queues cannot be part of the same batch */
+        auto* swapChainVK = LLGL_CAST(VKSwapChain*, swapChains[i]);
+        if (swapChainVK->GetVkGraphicsQueue() != native_ ||
+            (presentQueue != VK_NULL_HANDLE && swapChainVK->GetVkPresentQueue() != presentQueue))
+        {
+            swapChainVK->Present();
+            continue;
+        }
+
+        /* Acquire images of all swap-chains before any of them is submitted */
+        VkSemaphore signalSemaphore = VK_NULL_HANDLE;
+        VkFence     frameFence      = VK_NULL_HANDLE;
+        imageIndices.push_back(swapChainVK->BeginPresent(signalSemaphore, frameFence));
+        signalSemaphores.push_back(signalSemaphore);
+        frameFences.push_back(frameFence);
+        nativeSwapChains.push_back(swapChainVK->GetVkSwapchain());
+        presentIDs.push_back(swapChainVK->GetNextPresentID());
+        batchSwapChains.push_back(swapChainVK);
+        presentQueue = swapChainVK->GetVkPresentQueue();
+    }
+
+    if (batchSwapChains.empty())
+        return;
+
+    const std::uint32_t numBatchSwapChains = static_cast<std::uint32_t>(batchSwapChains.size());
+
+    /* Submit all signal semaphores with a single batch; queue submissions must be externally synchronized */
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+
+    VkSubmitInfo submitInfo;
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                = nullptr;
+        submitInfo.waitSemaphoreCount   = 0;
+        submitInfo.pWaitSemaphores      = nullptr;
+        submitInfo.pWaitDstStageMask    = nullptr;
+        submitInfo.commandBufferCount   = 0;
+        submitInfo.pCommandBuffers      = nullptr;
+        submitInfo.signalSemaphoreCount = numBatchSwapChains;
+        submitInfo.pSignalSemaphores    = signalSemaphores.data();
+    }
+    VkResult result = vkQueueSubmit(native_, 1, &submitInfo, frameFences[0]);
+    VKThrowIfFailed(result, "failed to submit semaphores to Vulkan graphics queue");
+
+    /* Only one fence can be signaled per submission, so the frame fences of the other swap-chains are signaled without any batches */
+    for_subrange(i, 1, numBatchSwapChains)
+    {
+        result = vkQueueSubmit(native_, 0, nullptr, frameFences[i]);
+        VKThrowIfFailed(result, "failed to submit fence to Vulkan graphics queue");
+    }
+
+    /* Present all swap-chains with a single call */
+    VkPresentIdKHR presentIdInfo;
+    {
+        presentIdInfo.sType             = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        presentIdInfo.pNext             = nullptr;
+        presentIdInfo.swapchainCount    = numBatchSwapChains;
+        presentIdInfo.pPresentIds       = presentIDs.data();
+    }
+
+    VkPresentInfoKHR presentInfo;
+    {
+        presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.pNext               = (batchSwapChains[0]->HasPresentWait() ? &presentIdInfo : nullptr);
+        presentInfo.waitSemaphoreCount  = numBatchSwapChains;
+        presentInfo.pWaitSemaphores     = signalSemaphores.data();
+        presentInfo.swapchainCount      = numBatchSwapChains;
+        presentInfo.pSwapchains         = nativeSwapChains.data();
+        presentInfo.pImageIndices       = imageIndices.data();
+        presentInfo.pResults            = nullptr;
+    }
+    result = vkQueuePresentKHR(presentQueue, &presentInfo);
+    VKThrowIfFailed(result, "failed to present Vulkan graphics queue");
+
+    for_range(i, numBatchSwapChains)
+        batchSwapChains[i]->EndPresent(presentIDs[i]);
+}
+
+/* ----- Sparse Resources ----- */
+
+void VKCommandQueue::UpdateTileMappings(Texture& texture, std::uint32_t numMappings, const TextureTileMapping* mappings)
+{
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+    textureVK.UpdateTileMappings(*this, numMappings, mappings);
+}
+
+void VKCommandQueue::UpdateTileMappings(Buffer& buffer, std::uint32_t numMappings, const BufferTileMapping* mappings)
+{
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    bufferVK.UpdateTileMappings(*this, numMappings, mappings);
 }
 
 /* ----- Queries ----- */
@@ -67,6 +264,19 @@ bool VKCommandQueue::QueryResult(
 {
     auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
 
+    if (queryHeapVK.HasReadbackBuffer())
+    {
+        /* Read results from readback buffer unless they have been recorded in a secondary command buffer within a render pass */
+        VkResult cachedResult = queryHeapVK.ReadCachedResults(firstQuery, numQueries, data, dataSize);
+        if (cachedResult == VK_NOT_READY)
+            return false;
+        if (cachedResult != VK_INCOMPLETE)
+        {
+            VKThrowIfFailed(cachedResult, "failed to retrieve results from Vulkan query heap");
+            return true;
+        }
+    }
+
     /* Store result directly into output parameter */
     auto stateResult = GetQueryResults(queryHeapVK, firstQuery, numQueries, data, dataSize);
     if (stateResult == VK_NOT_READY)
@@ -77,6 +287,40 @@ bool VKCommandQueue::QueryResult(
     return true;
 }
 
+bool VKCommandQueue::QueryFrameCounters(FrameProfile& outProfile)
+{
+    return frameCounters_.Query(outProfile);
+}
+
+bool VKCommandQueue::GetCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    if (!physicalDevice_.HasCalibratedTimestamps() || !HasExtension(VKExt::EXT_calibrated_timestamps))
+        return false;
+
+    /* Sample device and host timestamps at the same time; the host time domain matches Timer::Tick on this platform */
+    VkCalibratedTimestampInfoEXT timestampInfos[2];
+    {
+        timestampInfos[0].sType         = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+        timestampInfos[0].pNext         = nullptr;
+        timestampInfos[0].timeDomain    = VK_TIME_DOMAIN_DEVICE_EXT;
+        timestampInfos[1].sType         = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+        timestampInfos[1].pNext         = nullptr;
+        timestampInfos[1].timeDomain    = physicalDevice_.GetHostTimeDomain();
+    }
+    std::uint64_t timestamps[2] = {};
+    std::uint64_t maxDeviation = 0;
+    if (vkGetCalibratedTimestampsEXT(device_, 2, timestampInfos, timestamps, &maxDeviation) != VK_SUCCESS)
+        return false;
+
+    /* Convert device timestamp into nanoseconds like the results of timestamp queries */
+    const double timestampPeriod = static_cast<double>(physicalDevice_.GetProperties().limits.timestampPeriod);
+
+    outTimestamps.cpuTicks      = timestamps[1];
+    outTimestamps.gpuTimestamp  = static_cast<std::uint64_t>(static_cast<double>(timestamps[0]) * timestampPeriod + 0.5);
+    outTimestamps.maxDeviation  = maxDeviation;
+    return true;
+}
+
 #if 0
 bool VKCommandBuffer::QueryPipelineStatisticsResult(QueryHeap& queryHeap, QueryPipelineStatistics& result)
 {
@@ -103,8 +347,57 @@ bool VKCommandBuffer::QueryPipelineStatisticsResult(QueryHeap& queryHeap, QueryP
 void VKCommandQueue::Submit(Fence& fence)
 {
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
-    fenceVK.Reset(device_);
-    vkQueueSubmit(native_, 0, nullptr, fenceVK.GetVkFence());
+    SignalFence(fenceVK, fenceVK.GetSignaledValue() + 1);
+    frameCounters_.SubmitFence();
+}
+
+void VKCommandQueue::Submit(Fence& fence, std::uint64_t value)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    SignalFence(fenceVK, value);
+    frameCounters_.SubmitFence();
+}
+
+void VKCommandQueue::SubmitWait(Fence& fence, std::uint64_t value)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    if (fenceVK.IsTimeline())
+    {
+        /*
+        Submit an empty batch that waits for the timeline value on the GPU.
+        The second synchronization scope of a semaphore wait operation includes all commands that come later in submission order.
+        */
+        VkTimelineSemaphoreSubmitInfoKHR timelineInfo;
+        {
+            timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+            timelineInfo.pNext                      = nullptr;
+            timelineInfo.waitSemaphoreValueCount    = 1;
+            timelineInfo.pWaitSemaphoreValues       = &value;
+            timelineInfo.signalSemaphoreValueCount  = 0;
+            timelineInfo.pSignalSemaphoreValues     = nullptr;
+        }
+        const VkSemaphore           semaphore   = fenceVK.GetVkSemaphore();
+        const VkPipelineStageFlags  waitStage   = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        VkSubmitInfo submitInfo;
+        {
+            submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext                = &timelineInfo;
+            submitInfo.waitSemaphoreCount   = 1;
+            submitInfo.pWaitSemaphores      = &semaphore;
+            submitInfo.pWaitDstStageMask    = &waitStage;
+            submitInfo.commandBufferCount   = 0;
+            submitInfo.pCommandBuffers      = nullptr;
+            submitInfo.signalSemaphoreCount = 0;
+            submitInfo.pSignalSemaphores    = nullptr;
+        }
+        auto result = vkQueueSubmit(native_, 1, &submitInfo, VK_NULL_HANDLE);
+        VKThrowIfFailed(result, "failed to submit Vulkan timeline semaphore wait");
+    }
+    else
+    {
+        /* Binary fences cannot be waited on by the GPU, so wait on the CPU instead */
+        fenceVK.Wait(device_, value, UINT64_MAX);
+    }
 }
 
 bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
@@ -113,9 +406,20 @@ bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
     return fenceVK.Wait(device_, timeout);
 }
 
+bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    return fenceVK.Wait(device_, value, timeout);
+}
+
 void VKCommandQueue::WaitIdle()
 {
-    vkQueueWaitIdle(native_);
+    {
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+        device_.FlushPendingUploads(native_);
+        vkQueueWaitIdle(native_);
+    }
+    WaitForSparseBinding();
 }
 
 
@@ -123,6 +427,87 @@ void VKCommandQueue::WaitIdle()
  * ======= Private: =======
  */
 
+void VKCommandQueue::CreateSparseBindObjects()
+{
+    VkSemaphoreCreateInfo semaphoreInfo;
+    {
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = nullptr;
+        semaphoreInfo.flags = 0;
+    }
+    for (VKPtr<VkSemaphore>& semaphore : sparseBindSemaphores_)
+    {
+        VkResult result = vkCreateSemaphore(device_, &semaphoreInfo, nullptr, semaphore.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan semaphore for sparse binding");
+    }
+
+    VkFenceCreateInfo fenceInfo;
+    {
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceInfo.pNext = nullptr;
+        fenceInfo.flags = 0;
+    }
+    VkResult result = vkCreateFence(device_, &fenceInfo, nullptr, sparseBindFence_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan fence for sparse binding");
+}
+
+void VKCommandQueue::WaitForSparseBinding()
+{
+    if (!sparseBindPending_)
+        return;
+
+    /* The binding usually has long been completed at this point, so this rarely blocks */
+    VkFence fence = sparseBindFence_.Get();
+    vkWaitForFences(device_, 1, &fence, VK_TRUE, UINT64_MAX);
+    vkResetFences(device_, 1, &fence);
+    sparseBindPending_ = false;
+
+    for (VKDeviceMemoryRegion* region : retiredSparseRegions_)
+        deviceMemoryMngr_.Release(region);
+    retiredSparseRegions_.clear();
+}
+
+void VKCommandQueue::SignalFence(VKFence& fenceVK, std::uint64_t value)
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+    device_.FlushPendingUploads(native_);
+
+    if (fenceVK.IsTimeline())
+    {
+        VkTimelineSemaphoreSubmitInfoKHR timelineInfo;
+        {
+            timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+            timelineInfo.pNext                      = nullptr;
+            timelineInfo.waitSemaphoreValueCount    = 0;
+            timelineInfo.pWaitSemaphoreValues       = nullptr;
+            timelineInfo.signalSemaphoreValueCount  = 1;
+            timelineInfo.pSignalSemaphoreValues     = &value;
+        }
+        const VkSemaphore semaphore = fenceVK.GetVkSemaphore();
+        VkSubmitInfo submitInfo;
+        {
+            submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext                = &timelineInfo;
+            submitInfo.waitSemaphoreCount   = 0;
+            submitInfo.pWaitSemaphores      = nullptr;
+            submitInfo.pWaitDstStageMask    = nullptr;
+            submitInfo.commandBufferCount   = 0;
+            submitInfo.pCommandBuffers      = nullptr;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores    = &semaphore;
+        }
+        auto result = vkQueueSubmit(native_, 1, &submitInfo, VK_NULL_HANDLE);
+        VKThrowIfFailed(result, "failed to submit Vulkan timeline semaphore signal");
+    }
+    else
+    {
+        fenceVK.Reset(device_);
+        vkQueueSubmit(native_, 0, nullptr, fenceVK.GetVkFence());
+    }
+
+    fenceVK.SetSignaledValue(value);
+}
+
 VkResult VKCommandQueue::GetQueryResults(
     VKQueryHeap&    queryHeapVK,
     std::uint32_t   firstQuery,
@@ -148,7 +533,27 @@ VkResult VKCommandQueue::GetQueryResults(
     else
         return VK_ERROR_VALIDATION_FAILED_EXT;
 
-    if (queryHeapVK.GetType() == QueryType::TimeElapsed)
+    if (queryHeapVK.GetType() == QueryType::Timestamp)
+    {
+        /* Query timestamps only as 64-bit values, since their 32-bit values would overflow */
+        if (stride != sizeof(std::uint64_t))
+            return VK_ERROR_VALIDATION_FAILED_EXT;
+
+        VkResult result = GetQueryBatchedResults(queryHeapVK, firstQuery, numQueries, data, dataSize, stride, flags);
+        if (result == VK_SUCCESS)
+        {
+            /* Convert timestamps from ticks to nanoseconds */
+            const double timestampPeriod = static_cast<double>(queryHeapVK.GetTimestampPeriod());
+            if (timestampPeriod != 1.0)
+            {
+                auto timestamps = reinterpret_cast<std::uint64_t*>(data);
+                for_range(i, numQueries)
+                    timestamps[i] = static_cast<std::uint64_t>(static_cast<double>(timestamps[i]) * timestampPeriod + 0.5);
+            }
+        }
+        return result;
+    }
+    else if (queryHeapVK.GetType() == QueryType::TimeElapsed)
     {
         /* Get elapsed time values from difference between start and end timestamps */
         auto dataByteAligned = reinterpret_cast<std::uint8_t*>(data);
@@ -219,8 +624,8 @@ VkResult VKCommandQueue::GetQuerySingleResult(
 
         if (result == VK_SUCCESS)
         {
-            /* Store difference between timestamps in output buffer */
-            const auto elapsedTime = (timestamps[1] - timestamps[0]);
+            /* Store difference between timestamps in nanoseconds in output buffer */
+            const auto elapsedTime = static_cast<std::uint64_t>(static_cast<double>(timestamps[1] - timestamps[0]) * queryHeapVK.GetTimestampPeriod() + 0.5);
             if (stride == sizeof(std::uint64_t))
             {
                 auto dst = reinterpret_cast<std::uint64_t*>(data);
@@ -14,13 +14,19 @@
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "RenderState/VKFence.h"
+#include "../FrameCounters.h"
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class VKDevice;
+class VKPhysicalDevice;
 class VKQueryHeap;
+class VKDeviceMemoryRegion;
+class VKDeviceMemoryManager;
 
 // Helper function to submit the specified Vulkan command buffer to a command queue.
 VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuffer, VkFence fence);
@@ -32,12 +38,33 @@ class VKCommandQueue final : public CommandQueue
 
         #include <LLGL/Backend/CommandQueue.inl>
 
+        void Present(std::uint32_t numSwapChains, SwapChain* const * swapChains) override;
+
     public:
 
-        VKCommandQueue(VkDevice device, VkQueue queue);
+        VKCommandQueue(const VKPhysicalDevice& physicalDevice, VKDevice& device, VkQueue queue, VKDeviceMemoryManager& deviceMemoryMngr);
+        ~VKCommandQueue();
+
+    public:
+
+        /*
+        Submits the specified sparse memory bindings with vkQueueBindSparse. Semaphores of 'bindInfo' are overwritten.
+        The binding is ordered with all previous and subsequent submissions to this queue.
+        Ownership of the retired memory regions is taken and they are released once the GPU has completed the binding.
+        */
+        void BindSparseMemory(VkBindSparseInfo& bindInfo, std::vector<VKDeviceMemoryRegion*>& retiredRegions);
 
     private:
 
+        // Creates the semaphores and fence for sparse memory bindings on demand.
+        void CreateSparseBindObjects();
+
+        // Waits until the previous sparse memory binding has completed and releases its retired memory regions.
+        void WaitForSparseBinding();
+
+        // Submits an empty batch that signals the specified value of the fence.
+        void SignalFence(VKFence& fenceVK, std::uint64_t value);
+
         VkResult GetQueryResults(
             VKQueryHeap&    queryHeapVK,
             std::uint32_t   firstQuery,
@@ -66,8 +93,17 @@ class VKCommandQueue final : public CommandQueue
 
     private:
 
-        VkDevice    device_ = VK_NULL_HANDLE;
-        VkQueue     native_ = VK_NULL_HANDLE;
+        const VKPhysicalDevice&             physicalDevice_;
+        VKDevice&                           device_;
+        VkQueue                             native_                 = VK_NULL_HANDLE;
+        VKDeviceMemoryManager&              deviceMemoryMngr_;
+
+        VKPtr<VkSemaphore>                  sparseBindSemaphores_[2];           // Semaphores to order vkQueueBindSparse between vkQueueSubmit calls
+        VKPtr<VkFence>                      sparseBindFence_;
+        bool                                sparseBindPending_      = false;
+        std::vector<VKDeviceMemoryRegion*>  retiredSparseRegions_;              // Memory regions that are released once 'sparseBindFence_' is signaled
+
+        FrameCounterAccumulator             frameCounters_;
 
 };
 
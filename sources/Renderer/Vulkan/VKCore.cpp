@@ -6,10 +6,15 @@
  */
 
 #include "VKCore.h"
+#include "VKStaticLimits.h"
+#include "../GPUBreadcrumbs.h"
 #include "../../Core/StringUtils.h"
 #include "../../Core/MacroUtils.h"
 #include "../../Core/Exception.h"
+#include "../../Core/Assertion.h"
+#include "../../Core/Vendor.h"
 #include <LLGL/Utils/ForRange.h>
+#include <cstring>
 
 
 namespace LLGL
@@ -106,6 +111,10 @@ void VKThrowIfFailed(const VkResult result, const char* details)
 {
     if (result != VK_SUCCESS)
     {
+        /* Report the last commands that were executed by the GPU before the device was lost */
+        if (result == VK_ERROR_DEVICE_LOST)
+            ReportGPUBreadcrumbs();
+
         std::string resultStr = VKResultToStrOrHex(result);
         if (details != nullptr && *details != '\0')
             LLGL_TRAP("%s (error code = %s)", details, resultStr.c_str());
@@ -152,6 +161,26 @@ VkBool32 VKBoolean(bool value)
     return (value ? VK_TRUE : VK_FALSE);
 }
 
+// Index of VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, which follows the core descriptor types.
+static constexpr std::uint32_t g_accelStructDescriptorTypeIndex = (static_cast<std::uint32_t>(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT) + 1u);
+
+static_assert(g_accelStructDescriptorTypeIndex + 1u == LLGL_VK_NUM_DESCRIPTOR_TYPES, "LLGL_VK_NUM_DESCRIPTOR_TYPES does not match number of Vulkan descriptor types");
+
+std::uint32_t VKDescriptorTypeToIndex(VkDescriptorType type)
+{
+    if (type == VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR)
+        return g_accelStructDescriptorTypeIndex;
+    LLGL_ASSERT(type >= VK_DESCRIPTOR_TYPE_SAMPLER && type <= VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT);
+    return static_cast<std::uint32_t>(type);
+}
+
+VkDescriptorType VKIndexToDescriptorType(std::uint32_t index)
+{
+    if (index == g_accelStructDescriptorTypeIndex)
+        return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+    return static_cast<VkDescriptorType>(index);
+}
+
 
 /* ----- Query Functions ----- */
 
@@ -195,6 +224,51 @@ std::vector<VkPhysicalDevice> VKQueryPhysicalDevices(VkInstance instance)
     return devices;
 }
 
+VideoAdapterDescriptor VKGetVideoAdapterDesc(VkInstance instance, VkPhysicalDevice device)
+{
+    VideoAdapterDescriptor videoAdapterDesc;
+
+    /* Query device properties with device IDs if VK_KHR_get_physical_device_properties2 is available */
+    VkPhysicalDeviceIDPropertiesKHR idProperties = {};
+    idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES_KHR;
+
+    VkPhysicalDeviceProperties2KHR propertiesExt = {};
+    propertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+
+    auto getPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")
+    );
+    if (getPhysicalDeviceProperties2 != nullptr)
+    {
+        propertiesExt.pNext = &idProperties;
+        getPhysicalDeviceProperties2(device, &propertiesExt);
+
+        static_assert(sizeof(videoAdapterDesc.uuid) == VK_UUID_SIZE, "VideoAdapterDescriptor::uuid must have the same size as VK_UUID_SIZE");
+        std::memcpy(videoAdapterDesc.uuid, idProperties.deviceUUID, VK_UUID_SIZE);
+
+        static_assert(sizeof(videoAdapterDesc.luid) == VK_LUID_SIZE, "VideoAdapterDescriptor::luid must have the same size as VK_LUID_SIZE");
+        if (idProperties.deviceLUIDValid != VK_FALSE)
+            std::memcpy(&(videoAdapterDesc.luid), idProperties.deviceLUID, VK_LUID_SIZE);
+    }
+    else
+        vkGetPhysicalDeviceProperties(device, &(propertiesExt.properties));
+
+    videoAdapterDesc.name   = ToUTF16String(propertiesExt.properties.deviceName);
+    videoAdapterDesc.vendor = GetVendorName(GetVendorByID(propertiesExt.properties.vendorID));
+
+    /* Accumulate size of all device local memory heaps */
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(device, &memoryProperties);
+
+    for_range(i, memoryProperties.memoryHeapCount)
+    {
+        if ((memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0)
+            videoAdapterDesc.videoMemory += memoryProperties.memoryHeaps[i].size;
+    }
+
+    return videoAdapterDesc;
+}
+
 std::vector<VkExtensionProperties> VKQueryDeviceExtensionProperties(VkPhysicalDevice device)
 {
     std::uint32_t propertyCount = 0;
@@ -254,6 +328,22 @@ SurfaceSupportDetails VKQuerySurfaceSupport(VkPhysicalDevice device, VkSurfaceKH
     return details;
 }
 
+// Returns the index of the first queue family that supports the required flags but none of the excluded flags, or the fallback index if there is none.
+static std::uint32_t FindDedicatedQueueFamily(
+    const std::vector<VkQueueFamilyProperties>& queueFamilies,
+    VkQueueFlags                                requiredFlags,
+    VkQueueFlags                                excludedFlags,
+    std::uint32_t                               fallbackIndex)
+{
+    for_range(i, queueFamilies.size())
+    {
+        const auto& family = queueFamilies[i];
+        if (family.queueCount > 0 && (family.queueFlags & requiredFlags) == requiredFlags && (family.queueFlags & excludedFlags) == 0)
+            return static_cast<std::uint32_t>(i);
+    }
+    return fallbackIndex;
+}
+
 QueueFamilyIndices VKFindQueueFamilies(VkPhysicalDevice device, const VkQueueFlags flags, VkSurfaceKHR* surface)
 {
     QueueFamilyIndices indices;
@@ -289,6 +379,13 @@ QueueFamilyIndices VKFindQueueFamilies(VkPhysicalDevice device, const VkQueueFla
         ++i;
     }
 
+    /* Find dedicated queue families for asynchronous compute and transfer work */
+    if (indices.graphicsFamily != QueueFamilyIndices::invalidIndex)
+    {
+        indices.computeFamily   = FindDedicatedQueueFamily(queueFamilies, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT, indices.graphicsFamily);
+        indices.transferFamily  = FindDedicatedQueueFamily(queueFamilies, VK_QUEUE_TRANSFER_BIT, (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT), indices.computeFamily);
+    }
+
     return indices;
 }
 
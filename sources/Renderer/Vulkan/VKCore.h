@@ -10,6 +10,7 @@
 
 
 #include "Vulkan.h"
+#include <LLGL/VideoAdapter.h>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -27,18 +28,21 @@ struct QueueFamilyIndices
 
     QueueFamilyIndices() :
         graphicsFamily { invalidIndex },
-        presentFamily  { invalidIndex }
+        presentFamily  { invalidIndex },
+        computeFamily  { invalidIndex },
+        transferFamily { invalidIndex }
     {
     }
 
     union
     {
-        std::uint32_t indices[2];
+        std::uint32_t indices[4];
         struct
         {
             std::uint32_t graphicsFamily;
             std::uint32_t presentFamily;
-            //std::uint32_t transferFamily;
+            std::uint32_t computeFamily;    // Dedicated compute family or graphics family if there is none.
+            std::uint32_t transferFamily;   // Dedicated transfer family or compute family if there is none.
         };
     };
 
@@ -70,6 +74,12 @@ std::string VKApiVersionToString(std::uint32_t version);
 // Converts the boolean value into a VkBool322 value.
 VkBool32 VKBoolean(bool value);
 
+// Returns the zero-based index of the specified descriptor type, which is less than LLGL_VK_NUM_DESCRIPTOR_TYPES. Extension types don't have consecutive values.
+std::uint32_t VKDescriptorTypeToIndex(VkDescriptorType type);
+
+// Returns the descriptor type of the specified zero-based index. This is the inverse of VKDescriptorTypeToIndex.
+VkDescriptorType VKIndexToDescriptorType(std::uint32_t index);
+
 
 
 /* ----- Query Functions ----- */
@@ -80,6 +90,9 @@ std::vector<VkPhysicalDevice> VKQueryPhysicalDevices(VkInstance instance);
 std::vector<VkExtensionProperties> VKQueryDeviceExtensionProperties(VkPhysicalDevice device);
 std::vector<VkQueueFamilyProperties> VKQueryQueueFamilyProperties(VkPhysicalDevice device);
 
+// Returns the video adapter descriptor for the specified physical device. The UUID and LUID are only queried if VK_KHR_get_physical_device_properties2 is available.
+VideoAdapterDescriptor VKGetVideoAdapterDesc(VkInstance instance, VkPhysicalDevice device);
+
 SurfaceSupportDetails VKQuerySurfaceSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
 QueueFamilyIndices VKFindQueueFamilies(VkPhysicalDevice device, const VkQueueFlags flags, VkSurfaceKHR* surface = nullptr);
 VkFormat VKFindSupportedImageFormat(VkPhysicalDevice device, const VkFormat* candidates, std::size_t numCandidates, VkImageTiling tiling, VkFormatFeatureFlags features);
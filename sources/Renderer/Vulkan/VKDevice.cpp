@@ -8,7 +8,9 @@
 #include "VKDevice.h"
 #include "VKTypes.h"
 #include "RenderState/VKFence.h"
+#include "RenderState/VKBarrierAccumulator.h"
 #include "Buffer/VKBuffer.h"
+#include "Buffer/VKStagingRing.h"
 #include "Texture/VKTexture.h"
 #include "Memory/VKDeviceMemoryRegion.h"
 #include "Memory/VKDeviceMemory.h"
@@ -31,24 +33,36 @@ VKDevice::VKDevice() :
 }
 
 VKDevice::VKDevice(VKDevice&& device) :
-    device_             { std::move(device.device_)      },
-    queueFamilyIndices_ { device.queueFamilyIndices_     },
-    graphicsQueue_      { device.graphicsQueue_          },
-    commandPool_        { std::move(device.commandPool_) }
+    device_                 { std::move(device.device_)         },
+    queueFamilyIndices_     { device.queueFamilyIndices_        },
+    graphicsQueue_          { device.graphicsQueue_             },
+    computeQueue_           { device.computeQueue_              },
+    transferQueue_          { device.transferQueue_             },
+    numSharedQueueFamilies_ { device.numSharedQueueFamilies_    },
+    commandPool_            { std::move(device.commandPool_)    },
+    stagingRing_            { device.stagingRing_               }
 {
+    ::memcpy(sharedQueueFamilies_, device.sharedQueueFamilies_, sizeof(sharedQueueFamilies_));
 }
 
 VKDevice& VKDevice::operator = (VKDevice&& device)
 {
-    device_             = std::move(device.device_);
-    queueFamilyIndices_ = device.queueFamilyIndices_;
-    graphicsQueue_      = device.graphicsQueue_;
-    commandPool_        = std::move(device.commandPool_);
+    device_                 = std::move(device.device_);
+    queueFamilyIndices_     = device.queueFamilyIndices_;
+    graphicsQueue_          = device.graphicsQueue_;
+    computeQueue_           = device.computeQueue_;
+    transferQueue_          = device.transferQueue_;
+    numSharedQueueFamilies_ = device.numSharedQueueFamilies_;
+    commandPool_            = std::move(device.commandPool_);
+    stagingRing_            = device.stagingRing_;
+    ::memcpy(sharedQueueFamilies_, device.sharedQueueFamilies_, sizeof(sharedQueueFamilies_));
     return *this;
 }
 
 void VKDevice::WaitIdle()
 {
+    std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+    FlushPendingUploads();
     vkDeviceWaitIdle(device_);
 }
 
@@ -58,15 +72,25 @@ void VKDevice::CreateLogicalDevice(
     VkPhysicalDevice                physicalDevice,
     const VkPhysicalDeviceFeatures* features,
     const char* const*              extensions,
-    std::uint32_t                   numExtensions)
+    std::uint32_t                   numExtensions,
+    const void*                     next)
 {
     /* Initialize queue create description */
     queueFamilyIndices_ = VKFindQueueFamilies(physicalDevice, (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT));
 
-    SmallVector<VkDeviceQueueCreateInfo, 2> queueCreateInfos;
+    SmallVector<VkDeviceQueueCreateInfo, 4> queueCreateInfos;
 
-    auto AddQueueFamily = [&queueCreateInfos](std::uint32_t family, float queuePriority)
+    static const float queuePriority = 1.0f;
+
+    auto AddQueueFamily = [&queueCreateInfos](std::uint32_t family)
     {
+        /* Each queue family must only be specified once */
+        for (const VkDeviceQueueCreateInfo& info : queueCreateInfos)
+        {
+            if (info.queueFamilyIndex == family)
+                return;
+        }
+
         VkDeviceQueueCreateInfo info;
         {
             info.sType              = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
@@ -79,18 +103,22 @@ void VKDevice::CreateLogicalDevice(
         queueCreateInfos.push_back(info);
     };
 
-    constexpr float queuePriority = 1.0f;
+    AddQueueFamily(queueFamilyIndices_.graphicsFamily);
+    AddQueueFamily(queueFamilyIndices_.computeFamily);
+    AddQueueFamily(queueFamilyIndices_.transferFamily);
 
-    AddQueueFamily(queueFamilyIndices_.graphicsFamily, queuePriority);
+    /* Resources are shared between the graphics, compute, and transfer queue families */
+    numSharedQueueFamilies_ = 0;
+    for (const VkDeviceQueueCreateInfo& info : queueCreateInfos)
+        sharedQueueFamilies_[numSharedQueueFamilies_++] = info.queueFamilyIndex;
 
-    if (queueFamilyIndices_.graphicsFamily != queueFamilyIndices_.presentFamily)
-        AddQueueFamily(queueFamilyIndices_.presentFamily, queuePriority);
+    AddQueueFamily(queueFamilyIndices_.presentFamily);
 
     /* Create logical device */
     VkDeviceCreateInfo createInfo;
     {
         createInfo.sType                    = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
+        createInfo.pNext                    = next;
         createInfo.flags                    = 0;
         createInfo.queueCreateInfoCount     = static_cast<std::uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos        = queueCreateInfos.data();
@@ -103,8 +131,10 @@ void VKDevice::CreateLogicalDevice(
     VkResult result = vkCreateDevice(physicalDevice, &createInfo, nullptr, device_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan logical device");
 
-    /* Query device graphics queue */
+    /* Query device queues; compute and transfer queues refer to the graphics queue if there are no dedicated queue families */
     vkGetDeviceQueue(device_, queueFamilyIndices_.graphicsFamily, 0, &graphicsQueue_);
+    vkGetDeviceQueue(device_, queueFamilyIndices_.computeFamily, 0, &computeQueue_);
+    vkGetDeviceQueue(device_, queueFamilyIndices_.transferFamily, 0, &transferQueue_);
 
     /* Create default command pool */
     commandPool_ = CreateCommandPool();
@@ -130,6 +160,8 @@ VKPtr<VkCommandPool> VKDevice::CreateCommandPool()
 
 VkCommandBuffer VKDevice::AllocCommandBuffer(bool begin)
 {
+    std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+
     VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
 
     /* Allocate new primary level command buffer via staging command pool */
@@ -163,10 +195,15 @@ VkCommandBuffer VKDevice::AllocCommandBuffer(bool begin)
 
 void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
 {
+    std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+
     /* End command buffer record */
     VkResult result = vkEndCommandBuffer(cmdBuffer);
     VKThrowIfFailed(result, "failed to end recording Vulkan command buffer");
 
+    /* Submit deferred uploads first to preserve their order with this command buffer */
+    FlushPendingUploads();
+
     /* Create fence to ensure the command buffer has finished execution */
     {
         VKFence fence{ device_ };
@@ -189,6 +226,53 @@ void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
         vkFreeCommandBuffers(device_, commandPool_, 1, &cmdBuffer);
 }
 
+/* ----- Queue ----- */
+
+VkQueue VKDevice::GetVkQueue(const CommandQueueType type) const
+{
+    switch (type)
+    {
+        case CommandQueueType::Compute: return computeQueue_;
+        case CommandQueueType::Copy:    return transferQueue_;
+        default:                        return graphicsQueue_;
+    }
+}
+
+std::uint32_t VKDevice::GetQueueFamily(const CommandQueueType type) const
+{
+    switch (type)
+    {
+        case CommandQueueType::Compute: return queueFamilyIndices_.computeFamily;
+        case CommandQueueType::Copy:    return queueFamilyIndices_.transferFamily;
+        default:                        return queueFamilyIndices_.graphicsFamily;
+    }
+}
+
+/* ----- Deferred uploads ----- */
+
+void VKDevice::SetStagingRing(VKStagingRing* stagingRing)
+{
+    stagingRing_ = stagingRing;
+}
+
+void VKDevice::SetTuningProfile(const VendorTuningProfile& tuningProfile)
+{
+    tuningProfile_ = tuningProfile;
+}
+
+void VKDevice::FlushPendingUploads(VkQueue queue)
+{
+    if (stagingRing_ != nullptr)
+    {
+        std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+
+        if (queue != VK_NULL_HANDLE && queue != graphicsQueue_)
+            stagingRing_->WaitIdle();
+        else
+            stagingRing_->Flush();
+    }
+}
+
 // Returns the image aspect for the specified Vulkan format
 static VkImageAspectFlags GetImageAspectForVkFormat(VkFormat format)
 {
@@ -211,46 +295,52 @@ void VKDevice::TransitionImageLayout(
     VkImageLayout               newLayout,
     const TextureSubresource&   subresource)
 {
-    /* Initialize image memory barrier descriptor */
-    VkImageMemoryBarrier barrier;
+    /* Record image barrier command */
+    VKBarrierAccumulator barriers;
+    TransitionImageLayout(barriers, image, format, oldLayout, newLayout, subresource);
+    barriers.Flush(commandBuffer);
+}
+
+void VKDevice::TransitionImageLayout(
+    VKBarrierAccumulator&       barriers,
+    VkImage                     image,
+    VkFormat                    format,
+    VkImageLayout               oldLayout,
+    VkImageLayout               newLayout,
+    const TextureSubresource&   subresource)
+{
+    /* Initialize image subresource range */
+    VkImageSubresourceRange subresourceRange;
     {
-        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.pNext                           = nullptr;
-        barrier.srcAccessMask                   = 0;
-        barrier.dstAccessMask                   = 0;
-        barrier.oldLayout                       = oldLayout;
-        barrier.newLayout                       = newLayout;
-        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image                           = image;
-        barrier.subresourceRange.aspectMask     = GetImageAspectForVkFormat(format);
-        barrier.subresourceRange.baseMipLevel   = subresource.baseMipLevel;
-        barrier.subresourceRange.levelCount     = subresource.numMipLevels;
-        barrier.subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
-        barrier.subresourceRange.layerCount     = subresource.numArrayLayers;
+        subresourceRange.aspectMask     = GetImageAspectForVkFormat(format);
+        subresourceRange.baseMipLevel   = subresource.baseMipLevel;
+        subresourceRange.levelCount     = subresource.numMipLevels;
+        subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
+        subresourceRange.layerCount     = subresource.numArrayLayers;
     }
 
-    /* Initialize pipeline state flags */
-    VkPipelineStageFlags srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-    VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    /* Initialize pipeline state and access flags */
+    VkAccessFlags           srcAccessMask   = 0;
+    VkAccessFlags           dstAccessMask   = 0;
+    VkPipelineStageFlags    srcStageMask    = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    VkPipelineStageFlags    dstStageMask    = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
 
     if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
     {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        srcAccessMask   = 0;
+        dstAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        srcStageMask    = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        dstStageMask    = VK_PIPELINE_STAGE_TRANSFER_BIT;
     }
     else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
     {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+        srcStageMask    = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dstStageMask    = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     }
 
-    /* Record image barrier command */
-    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    barriers.InsertImageBarrier(image, subresourceRange, oldLayout, newLayout, srcStageMask, dstStageMask, srcAccessMask, dstAccessMask);
 }
 
 void VKDevice::CopyBuffer(
@@ -277,6 +367,8 @@ void VKDevice::CopyBuffer(
     VkDeviceSize    srcOffset,
     VkDeviceSize    dstOffset)
 {
+    std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+
     VkCommandBuffer cmdBuffer = AllocCommandBuffer();
     {
         CopyBuffer(cmdBuffer, srcBuffer, dstBuffer, size, srcOffset, dstOffset);
@@ -302,28 +394,31 @@ void VKDevice::CopyTexture(
 }
 
 void VKDevice::CopyImage(
-    VkCommandBuffer     commandBuffer,
-    VkImage             srcImage,
-    VkImageLayout       srcImageLayout,
-    VkImage             dstImage,
-    VkImageLayout       dstImageLayout,
-    const VkImageCopy&  region,
-    VkFormat            format)
+    VkCommandBuffer         commandBuffer,
+    VKBarrierAccumulator&   barriers,
+    VkImage                 srcImage,
+    VkImageLayout           srcImageLayout,
+    VkImage                 dstImage,
+    VkImageLayout           dstImageLayout,
+    const VkImageCopy&      region,
+    VkFormat                format)
 {
     const TextureSubresource srcImageSubresource{ region.srcSubresource.baseArrayLayer, region.srcSubresource.layerCount, region.srcSubresource.mipLevel, 1u };
     const TextureSubresource dstImageSubresource{ region.dstSubresource.baseArrayLayer, region.dstSubresource.layerCount, region.dstSubresource.mipLevel, 1u };
 
-    TransitionImageLayout(commandBuffer, srcImage, format, srcImageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageSubresource);
-    TransitionImageLayout(commandBuffer, dstImage, format, dstImageLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstImageSubresource);
+    TransitionImageLayout(barriers, srcImage, format, srcImageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageSubresource);
+    TransitionImageLayout(barriers, dstImage, format, dstImageLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstImageSubresource);
+    barriers.FlushForTransfer(commandBuffer);
 
     vkCmdCopyImage(commandBuffer, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
-    TransitionImageLayout(commandBuffer, srcImage, format, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageLayout, srcImageSubresource);
-    TransitionImageLayout(commandBuffer, dstImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstImageLayout, dstImageSubresource);
+    TransitionImageLayout(barriers, srcImage, format, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageLayout, srcImageSubresource);
+    TransitionImageLayout(barriers, dstImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstImageLayout, dstImageSubresource);
 }
 
 void VKDevice::ResolveImage(
     VkCommandBuffer         commandBuffer,
+    VKBarrierAccumulator&   barriers,
     VkImage                 srcImage,
     VkImageLayout           srcImageLayout,
     VkImage                 dstImage,
@@ -334,13 +429,14 @@ void VKDevice::ResolveImage(
     const TextureSubresource srcImageSubresource{ region.srcSubresource.baseArrayLayer, region.srcSubresource.layerCount, region.srcSubresource.mipLevel, 1u };
     const TextureSubresource dstImageSubresource{ region.dstSubresource.baseArrayLayer, region.dstSubresource.layerCount, region.dstSubresource.mipLevel, 1u };
 
-    TransitionImageLayout(commandBuffer, srcImage, format, srcImageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageSubresource);
-    TransitionImageLayout(commandBuffer, dstImage, format, dstImageLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstImageSubresource);
+    TransitionImageLayout(barriers, srcImage, format, srcImageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageSubresource);
+    TransitionImageLayout(barriers, dstImage, format, dstImageLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstImageSubresource);
+    barriers.FlushForTransfer(commandBuffer);
 
     vkCmdResolveImage(commandBuffer, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
-    TransitionImageLayout(commandBuffer, srcImage, format, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageLayout, srcImageSubresource);
-    TransitionImageLayout(commandBuffer, dstImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstImageLayout, dstImageSubresource);
+    TransitionImageLayout(barriers, srcImage, format, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageLayout, srcImageSubresource);
+    TransitionImageLayout(barriers, dstImage, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dstImageLayout, dstImageSubresource);
 }
 
 void VKDevice::CopyBufferToImage(
@@ -350,11 +446,12 @@ void VKDevice::CopyBufferToImage(
     VkFormat                    format,
     const VkOffset3D&           offset,
     const VkExtent3D&           extent,
-    const TextureSubresource&   subresource)
+    const TextureSubresource&   subresource,
+    VkDeviceSize                bufferOffset)
 {
     VkBufferImageCopy region;
     {
-        region.bufferOffset                     = 0;
+        region.bufferOffset                     = bufferOffset;
         region.bufferRowLength                  = 0;
         region.bufferImageHeight                = 0;
         region.imageSubresource.aspectMask      = GetImageAspectForVkFormat(format);
@@ -425,45 +522,45 @@ void VKDevice::CopyImageToBuffer(
 
 void VKDevice::GenerateMips(
     VkCommandBuffer             commandBuffer,
+    VKBarrierAccumulator&       barriers,
     VkImage                     image,
     VkFormat                    format,
     const VkExtent3D&           extent,
     const TextureSubresource&   subresource)
 {
+    /*
+    Transition entire subresource range separately, since its barrier must not overlap with pending barriers
+    of individual subresources, e.g. from a previous render pass, nor with the barriers of individual MIP levels
+    */
+    barriers.FlushForTransfer(commandBuffer);
     TransitionImageLayout(
-        commandBuffer,
+        barriers,
         image,
         VK_FORMAT_UNDEFINED,
         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
         subresource
     );
+    barriers.FlushForTransfer(commandBuffer);
 
-    /* Initialize image memory barrier */
-    VkImageMemoryBarrier barrier;
+    /* Initialize image subresource range of a single MIP level */
+    VkImageSubresourceRange subresourceRange;
 
     const VkImageAspectFlags aspectMask = GetImageAspectForVkFormat(format);
 
-    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.pNext                           = nullptr;
-    barrier.srcAccessMask                   = 0;
-    barrier.dstAccessMask                   = 0;
-    barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.newLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image                           = image;
-    barrier.subresourceRange.aspectMask     = aspectMask;
-    barrier.subresourceRange.baseMipLevel   = subresource.baseMipLevel;
-    barrier.subresourceRange.levelCount     = 1;
-    barrier.subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
-    barrier.subresourceRange.layerCount     = 1;
+    subresourceRange.aspectMask     = aspectMask;
+    subresourceRange.baseMipLevel   = subresource.baseMipLevel;
+    subresourceRange.levelCount     = 1;
+    subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
+    subresourceRange.layerCount     = 1;
 
     /* Blit each MIP-map from previous (lower) MIP level */
     for_range(arrayLayer, subresource.numArrayLayers)
     {
         VkExtent3D currExtent = extent;
 
+        subresourceRange.baseArrayLayer = subresource.baseArrayLayer + arrayLayer;
+
         for_subrange(mipLevel, 1, subresource.numMipLevels)
         {
             /* Determine extent of next MIP level */
@@ -473,21 +570,20 @@ void VKDevice::GenerateMips(
             nextExtent.height   = std::max(1u, currExtent.height / 2);
             nextExtent.depth    = std::max(1u, currExtent.depth  / 2);
 
-            /* Transition previous MIP level to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL */
-            barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_READ_BIT;
-            barrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.subresourceRange.baseMipLevel   = subresource.baseMipLevel + mipLevel - 1;
-            barrier.subresourceRange.baseArrayLayer = subresource.baseArrayLayer + arrayLayer;
-
-            vkCmdPipelineBarrier(
-                commandBuffer,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
-                0, nullptr,
-                0, nullptr,
-                1, &barrier
+            /* Transition previous MIP level to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL; this also records the pending transition of the MIP level before */
+            subresourceRange.baseMipLevel = subresource.baseMipLevel + mipLevel - 1;
+
+            barriers.InsertImageBarrier(
+                image,
+                subresourceRange,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_ACCESS_TRANSFER_READ_BIT
             );
+            barriers.FlushForTransfer(commandBuffer);
 
             /* Blit previous MIP level into next higher MIP level (with smaller extent) */
             VkImageBlit blit;
@@ -517,18 +613,16 @@ void VKDevice::GenerateMips(
                 VK_FILTER_LINEAR
             );
 
-            /* Transition previous MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
-            barrier.srcAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
-            barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
-            barrier.oldLayout       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.newLayout       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            vkCmdPipelineBarrier(
-                commandBuffer,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-                0, nullptr,
-                0, nullptr,
-                1, &barrier
+            /* Transition previous MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL with the barrier of the next MIP level */
+            barriers.InsertImageBarrier(
+                image,
+                subresourceRange,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_ACCESS_TRANSFER_READ_BIT,
+                VK_ACCESS_SHADER_READ_BIT
             );
 
             /* Reduce image extent to next MIP level */
@@ -536,18 +630,17 @@ void VKDevice::GenerateMips(
         }
 
         /* Transition last MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
-        barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
-        barrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.newLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.subresourceRange.baseMipLevel   = subresource.numMipLevels - 1;
-
-        vkCmdPipelineBarrier(
-            commandBuffer,
-            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-            0, nullptr,
-            0, nullptr,
-            1, &barrier
+        subresourceRange.baseMipLevel = subresource.baseMipLevel + subresource.numMipLevels - 1;
+
+        barriers.InsertImageBarrier(
+            image,
+            subresourceRange,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT
         );
     }
 }
@@ -10,10 +10,14 @@
 
 
 #include <LLGL/TextureFlags.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/Container/ArrayView.h>
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "Buffer/VKDeviceBuffer.h"
+#include "../../Core/VendorTuning.h"
+#include <mutex>
 
 
 namespace LLGL
@@ -22,6 +26,8 @@ namespace LLGL
 
 class VKBuffer;
 class VKTexture;
+class VKStagingRing;
+class VKBarrierAccumulator;
 
 class VKDevice
 {
@@ -39,7 +45,8 @@ class VKDevice
             VkPhysicalDevice                physicalDevice,
             const VkPhysicalDeviceFeatures* features,
             const char* const*              extensions,
-            std::uint32_t                   numExtensions
+            std::uint32_t                   numExtensions,
+            const void*                     next            = nullptr
         );
 
         // Blocks until the VkDevice becomes idle.
@@ -54,6 +61,35 @@ class VKDevice
         VkCommandBuffer AllocCommandBuffer(bool begin = true);
         void FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release = true);
 
+        /* ----- Deferred uploads ----- */
+
+        // Sets the staging ring for deferred uploads. Pending uploads are flushed before any other work is submitted to the graphics queue.
+        void SetStagingRing(VKStagingRing* stagingRing);
+
+        /*
+        Submits all pending deferred uploads to the graphics queue without waiting for their completion.
+        If 'queue' specifies a queue other than the graphics queue, this function also waits for their completion,
+        because deferred uploads are only ordered with respect to other commands on the graphics queue.
+        */
+        void FlushPendingUploads(VkQueue queue = VK_NULL_HANDLE);
+
+        // Returns the staging ring for deferred uploads or null if deferred uploads are disabled.
+        inline VKStagingRing* GetStagingRing() const
+        {
+            return stagingRing_;
+        }
+
+        /* ----- Tuning ----- */
+
+        // Sets the tuning profile with all overrides from the renderer configuration applied. This must be called before any command buffer is created.
+        void SetTuningProfile(const VendorTuningProfile& tuningProfile);
+
+        // Returns the tuning profile for the vendor of the physical device.
+        inline const VendorTuningProfile& GetTuningProfile() const
+        {
+            return tuningProfile_;
+        }
+
         /* ----- Buffer/Image operatons ----- */
 
         void TransitionImageLayout(
@@ -65,6 +101,16 @@ class VKDevice
             const TextureSubresource&   subresource
         );
 
+        // Inserts an image layout transition into the specified barrier accumulator without recording it yet.
+        void TransitionImageLayout(
+            VKBarrierAccumulator&       barriers,
+            VkImage                     image,
+            VkFormat                    format,
+            VkImageLayout               oldLayout,
+            VkImageLayout               newLayout,
+            const TextureSubresource&   subresource
+        );
+
         void CopyBuffer(
             VkCommandBuffer commandBuffer,
             VkBuffer        srcBuffer,
@@ -89,18 +135,22 @@ class VKDevice
             const VkImageCopy&  region
         );
 
+        // Copies the source image into the destination image. Transitions back into the original layouts are left pending in the barrier accumulator.
         void CopyImage(
-            VkCommandBuffer     commandBuffer,
-            VkImage             srcImage,
-            VkImageLayout       srcImageLayout,
-            VkImage             dstImage,
-            VkImageLayout       dstImageLayout,
-            const VkImageCopy&  region,
-            VkFormat            format
+            VkCommandBuffer         commandBuffer,
+            VKBarrierAccumulator&   barriers,
+            VkImage                 srcImage,
+            VkImageLayout           srcImageLayout,
+            VkImage                 dstImage,
+            VkImageLayout           dstImageLayout,
+            const VkImageCopy&      region,
+            VkFormat                format
         );
 
+        // Resolves the source image into the destination image. Transitions back into the original layouts are left pending in the barrier accumulator.
         void ResolveImage(
             VkCommandBuffer         commandBuffer,
+            VKBarrierAccumulator&   barriers,
             VkImage                 srcImage,
             VkImageLayout           srcImageLayout,
             VkImage                 dstImage,
@@ -117,7 +167,8 @@ class VKDevice
             VkFormat                    format,
             const VkOffset3D&           offset,
             const VkExtent3D&           extent,
-            const TextureSubresource&   subresource
+            const TextureSubresource&   subresource,
+            VkDeviceSize                bufferOffset    = 0
         );
 
         void CopyBufferToImage(
@@ -145,8 +196,14 @@ class VKDevice
             const VkBufferImageCopy&    region
         );
 
+        /*
+        Generates the MIP-map chain by blitting each MIP level from the previous one.
+        Transitions back into VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL are merged into the barriers of the next MIP level
+        and the transitions of the last MIP levels are left pending in the barrier accumulator.
+        */
         void GenerateMips(
             VkCommandBuffer             commandBuffer,
+            VKBarrierAccumulator&       barriers,
             VkImage                     image,
             VkFormat                    format,
             const VkExtent3D&           extent,
@@ -189,18 +246,46 @@ class VKDevice
             return graphicsQueue_;
         }
 
+        // Returns the native VkQueue handle for the specified queue type. Falls back to the graphics queue if there is no dedicated queue.
+        VkQueue GetVkQueue(const CommandQueueType type) const;
+
+        // Returns the queue family index for the specified queue type.
+        std::uint32_t GetQueueFamily(const CommandQueueType type) const;
+
+        // Returns the unique queue families resources are shared between. If this contains more than one entry, resources must be created with VK_SHARING_MODE_CONCURRENT.
+        inline ArrayView<std::uint32_t> GetSharedQueueFamilies() const
+        {
+            return ArrayView<std::uint32_t>{ sharedQueueFamilies_, numSharedQueueFamilies_ };
+        }
+
         // Returns the native VkCommandPool handle.
         inline const VKPtr<VkCommandPool>& GetVkCommandPool() const
         {
             return commandPool_;
         }
 
+        /*
+        Returns the mutex that guards the internal command pool and all submissions to the device queues.
+        This must be locked while recording into a command buffer allocated with AllocCommandBuffer() until it has been flushed.
+        */
+        inline std::recursive_mutex& GetQueueMutex()
+        {
+            return queueMutex_;
+        }
+
     private:
 
         VKPtr<VkDevice>         device_;
         QueueFamilyIndices      queueFamilyIndices_;
-        VkQueue                 graphicsQueue_      = VK_NULL_HANDLE;
+        VkQueue                 graphicsQueue_          = VK_NULL_HANDLE;
+        VkQueue                 computeQueue_           = VK_NULL_HANDLE;
+        VkQueue                 transferQueue_          = VK_NULL_HANDLE;
+        std::uint32_t           sharedQueueFamilies_[3] = {};   // Unique graphics, compute, and transfer queue families
+        std::uint32_t           numSharedQueueFamilies_ = 0;
         VKPtr<VkCommandPool>    commandPool_;
+        VKStagingRing*          stagingRing_            = nullptr;
+        VendorTuningProfile     tuningProfile_;
+        std::recursive_mutex    queueMutex_;
 
 };
 
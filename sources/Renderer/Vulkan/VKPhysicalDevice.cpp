@@ -7,6 +7,7 @@
 
 #include "VKPhysicalDevice.h"
 #include "Ext/VKExtensionRegistry.h"
+#include "Ext/VKExtensions.h"
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "RenderState/VKGraphicsPSO.h"
@@ -17,6 +18,7 @@
 #include <set>
 #include <limits>
 #include <algorithm>
+#include <iterator>
 
 
 namespace LLGL
@@ -25,11 +27,17 @@ namespace LLGL
 
 static const char* g_requiredVulkanExtensions[] =
 {
-    VK_KHR_SWAPCHAIN_EXTENSION_NAME,
     VK_KHR_MAINTENANCE1_EXTENSION_NAME,
     nullptr,
 };
 
+// Extensions that are only required if the render system is not headless (see RenderSystemFlags::Headless)
+static const char* g_presentVulkanExtensions[] =
+{
+    VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+    nullptr,
+};
+
 static bool CheckDeviceExtensionSupport(
     VkPhysicalDevice                    physicalDevice,
     const char* const*                  requiredExtensions,
@@ -54,14 +62,20 @@ static bool CheckDeviceExtensionSupport(
 
 static bool IsPhysicalDeviceSuitable(
     VkPhysicalDevice                    physicalDevice,
-    std::vector<VkExtensionProperties>& supportedExtensions)
+    std::vector<VkExtensionProperties>& supportedExtensions,
+    bool                                headless)
 {
+    /* Swap-chain extensions are only required if the device must present images */
+    std::vector<const char*> requiredExtensions(std::begin(g_requiredVulkanExtensions), std::end(g_requiredVulkanExtensions) - 1);
+    if (!headless)
+        requiredExtensions.insert(requiredExtensions.end(), std::begin(g_presentVulkanExtensions), std::end(g_presentVulkanExtensions) - 1);
+
     /* Check if physical devices supports at least these extensions */
     std::vector<VkExtensionProperties> extensions;
     bool suitable = CheckDeviceExtensionSupport(
         physicalDevice,
-        g_requiredVulkanExtensions,
-        (sizeof(g_requiredVulkanExtensions) / sizeof(g_requiredVulkanExtensions[0]) - 1),
+        requiredExtensions.data(),
+        requiredExtensions.size(),
         extensions
     );
 
@@ -75,20 +89,18 @@ static bool IsPhysicalDeviceSuitable(
     return false;
 }
 
-bool VKPhysicalDevice::PickPhysicalDevice(VkInstance instance)
+bool VKPhysicalDevice::PickPhysicalDevice(VkInstance instance, const ArrayView<VkPhysicalDevice>& candidates, bool headless)
 {
-    /* Query all physical devices and pick suitable */
-    std::vector<VkPhysicalDevice> physicalDevices = VKQueryPhysicalDevices(instance);
-
-    for (VkPhysicalDevice device : physicalDevices)
+    /* Pick first suitable physical device */
+    for (VkPhysicalDevice device : candidates)
     {
-        if (IsPhysicalDeviceSuitable(device, supportedExtensions_))
+        if (IsPhysicalDeviceSuitable(device, supportedExtensions_, headless))
         {
             /* Store reference to all extension names */
             for (const VkExtensionProperties& extension : supportedExtensions_)
                 supportedExtensionNames_.insert(extension.extensionName);
 
-            if (!EnableExtensions(g_requiredVulkanExtensions, true))
+            if (!EnableExtensions(g_requiredVulkanExtensions, true) || !EnableExtensions(g_presentVulkanExtensions, !headless))
             {
                 /* Stop considering this physical device, because some required extensions are not supported */
                 supportedExtensionNames_.clear();
@@ -100,6 +112,19 @@ bool VKPhysicalDevice::PickPhysicalDevice(VkInstance instance)
             /* Store device and store properties */
             physicalDevice_ = device;
             QueryDeviceInfo();
+            QueryDescriptorIndexingFeatures(instance);
+            QueryPresentWaitFeatures(instance);
+            QueryFragmentShadingRateFeatures(instance);
+            QueryMeshShaderFeatures(instance);
+            QuerySubgroupProperties(instance);
+            QueryDynamicStateFeatures(instance);
+            QueryCalibrateableTimeDomains(instance);
+            QueryHostImageCopyFeatures(instance);
+            QueryMultiviewFeatures(instance);
+            QueryTransformFeedbackFeatures(instance);
+            QueryMemoryPriorityFeatures(instance);
+            QueryBufferDeviceAddressFeatures(instance);
+            QueryRayTracingFeatures(instance);
 
             return true;
         }
@@ -147,6 +172,76 @@ static std::vector<Format> GetCompressedVKTextureFormatsS3TC()
     };
 }
 
+// Returns true if the specified descriptor indexing features are sufficient for bindless resource heaps.
+static bool IsBindlessHeapSupported(const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& features)
+{
+    return
+    (
+        features.runtimeDescriptorArray                         != VK_FALSE &&
+        features.descriptorBindingPartiallyBound                != VK_FALSE &&
+        features.descriptorBindingSampledImageUpdateAfterBind   != VK_FALSE
+    );
+}
+
+// Returns true if the specified physical device supports sparse 2D images and buffers on its graphics queue, which is used to bind the MIP tails of sparse textures.
+static bool IsSparseResidencySupported(VkPhysicalDevice physicalDevice, const VkPhysicalDeviceFeatures& features)
+{
+    if (features.sparseBinding == VK_FALSE || features.sparseResidencyBuffer == VK_FALSE || features.sparseResidencyImage2D == VK_FALSE)
+        return false;
+
+    for (const VkQueueFamilyProperties& family : VKQueryQueueFamilyProperties(physicalDevice))
+    {
+        if ((family.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0)
+            return ((family.queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0);
+    }
+
+    return false;
+}
+
+// Returns the square texel size of shading-rate attachments, which is the default tile size of 16 clamped to the range supported by the device.
+static std::uint32_t GetShadingRateAttachmentTexelSize(const VkPhysicalDeviceFragmentShadingRatePropertiesKHR& props)
+{
+    constexpr std::uint32_t defaultTexelSize = 16;
+    const std::uint32_t minTexelSize = std::max(props.minFragmentShadingRateAttachmentTexelSize.width, props.minFragmentShadingRateAttachmentTexelSize.height);
+    const std::uint32_t maxTexelSize = std::min(props.maxFragmentShadingRateAttachmentTexelSize.width, props.maxFragmentShadingRateAttachmentTexelSize.height);
+    return std::max(minTexelSize, std::min(defaultTexelSize, maxTexelSize));
+}
+
+// Returns true if shading-rate attachments are supported with a square texel size.
+static bool IsShadingRateAttachmentSupported(
+    const VkPhysicalDeviceFragmentShadingRateFeaturesKHR&   features,
+    const VkPhysicalDeviceFragmentShadingRatePropertiesKHR& props)
+{
+    if (features.attachmentFragmentShadingRate == VK_FALSE)
+        return false;
+    const std::uint32_t minTexelSize = std::max(props.minFragmentShadingRateAttachmentTexelSize.width, props.minFragmentShadingRateAttachmentTexelSize.height);
+    const std::uint32_t maxTexelSize = std::min(props.maxFragmentShadingRateAttachmentTexelSize.width, props.maxFragmentShadingRateAttachmentTexelSize.height);
+    return (minTexelSize > 0 && minTexelSize <= maxTexelSize);
+}
+
+// Converts the specified Vulkan shader stage flags into StageFlags entries.
+static long GetStageFlagsFromVkShaderStages(VkShaderStageFlags stages)
+{
+    long flags = 0;
+    if ((stages & VK_SHADER_STAGE_VERTEX_BIT) != 0)
+        flags |= StageFlags::VertexStage;
+    if ((stages & VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT) != 0)
+        flags |= StageFlags::TessControlStage;
+    if ((stages & VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT) != 0)
+        flags |= StageFlags::TessEvaluationStage;
+    if ((stages & VK_SHADER_STAGE_GEOMETRY_BIT) != 0)
+        flags |= StageFlags::GeometryStage;
+    if ((stages & VK_SHADER_STAGE_FRAGMENT_BIT) != 0)
+        flags |= StageFlags::FragmentStage;
+    if ((stages & VK_SHADER_STAGE_COMPUTE_BIT) != 0)
+        flags |= StageFlags::ComputeStage;
+    if ((stages & VK_SHADER_STAGE_TASK_BIT_EXT) != 0)
+        flags |= StageFlags::TaskStage;
+    if ((stages & VK_SHADER_STAGE_MESH_BIT_EXT) != 0)
+        flags |= StageFlags::MeshStage;
+    return flags;
+}
+
 void VKPhysicalDevice::QueryDeviceProperties(
     RendererInfo&               info,
     RenderingCapabilities&      caps,
@@ -195,12 +290,26 @@ void VKPhysicalDevice::QueryDeviceProperties(
     caps.features.hasInstancing                     = true;
     caps.features.hasOffsetInstancing               = true;
     caps.features.hasIndirectDrawing                = (features_.drawIndirectFirstInstance != VK_FALSE);
+    caps.features.hasIndirectCountDrawing           = (caps.features.hasIndirectDrawing && SupportsExtension(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME));
     caps.features.hasViewportArrays                 = (features_.multiViewport != VK_FALSE);
     caps.features.hasConservativeRasterization      = SupportsExtension(VK_EXT_CONSERVATIVE_RASTERIZATION_EXTENSION_NAME);
-    caps.features.hasStreamOutputs                  = SupportsExtension(VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME);
+    caps.features.hasStreamOutputs                  = HasTransformFeedback();
     caps.features.hasLogicOp                        = (features_.logicOp != VK_FALSE);
     caps.features.hasPipelineStatistics             = (features_.pipelineStatisticsQuery != VK_FALSE);
     caps.features.hasRenderCondition                = SupportsExtension(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+    caps.features.hasBindlessResources              = IsBindlessHeapSupported(descriptorIndexingFeatures_);
+    caps.features.hasSparseResources                = IsSparseResidencySupported(physicalDevice_, features_);
+    caps.features.hasThreadSafeResourceCreation     = true;
+    caps.features.hasVariableRateShading            = (shadingRateFeatures_.pipelineFragmentShadingRate != VK_FALSE);
+    caps.features.hasShadingRateImage               = IsShadingRateAttachmentSupported(shadingRateFeatures_, shadingRateProps_);
+    caps.features.hasMeshShaders                    = (meshShaderFeatures_.meshShader != VK_FALSE);
+    caps.features.hasTextureCompression             = false; // Updated by VKRenderSystem once the compute pipelines have been created
+    caps.features.hasSubgroupSizeControl            = HasSubgroupSizeControl();
+    caps.features.hasNativeIOQueue                  = false;
+    caps.features.hasMultiview                      = HasMultiview();
+    caps.features.hasRayTracing                     = HasRayTracing();
+    caps.features.hasBufferDeviceAddress            = HasBufferDeviceAddress();
+    caps.features.hasIndirectArgumentCompaction     = false; // Updated by VKRenderSystem once the compute pipeline has been created
 
     /* Query limits */
     caps.limits.lineWidthRange[0]                   = limits.lineWidthRange[0];
@@ -224,7 +333,7 @@ void VKPhysicalDevice::QueryDeviceProperties(
     caps.limits.maxViewportSize[1]                  = limits.maxViewportDimensions[1];
     caps.limits.maxBufferSize                       = std::numeric_limits<VkDeviceSize>::max();
     caps.limits.maxConstantBufferSize               = limits.maxUniformBufferRange;
-    caps.limits.maxStreamOutputs                    = 0; //TODO
+    caps.limits.maxStreamOutputs                    = (caps.features.hasStreamOutputs ? std::min(transformFeedbackProps_.maxTransformFeedbackBuffers, LLGL_MAX_NUM_SO_BUFFERS) : 0u);
     caps.limits.maxTessFactor                       = limits.maxTessellationGenerationLevel;
     caps.limits.minConstantBufferAlignment          = limits.minUniformBufferOffsetAlignment;
     caps.limits.minSampledBufferAlignment           = limits.minStorageBufferOffsetAlignment; // Use SSBO for both sampled and storage buffers
@@ -233,27 +342,242 @@ void VKPhysicalDevice::QueryDeviceProperties(
     caps.limits.maxDepthBufferSamples               = VKTypes::GetMaxVkSampleCounts(limits.framebufferDepthSampleCounts);
     caps.limits.maxStencilBufferSamples             = VKTypes::GetMaxVkSampleCounts(limits.framebufferStencilSampleCounts);
     caps.limits.maxNoAttachmentSamples              = VKTypes::GetMaxVkSampleCounts(limits.framebufferNoAttachmentsSampleCounts);
+    caps.limits.shadingRateImageTileSize            = (caps.features.hasShadingRateImage ? GetShadingRateAttachmentTexelSize(shadingRateProps_) : 0u);
+    caps.limits.maxMultiviewViewCount               = (caps.features.hasMultiview ? multiviewProps_.maxMultiviewViewCount : 0u);
+    caps.limits.maxAccelerationStructureInstances   = (caps.features.hasRayTracing ? static_cast<std::uint32_t>(std::min<std::uint64_t>(accelStructProps_.maxInstanceCount, std::numeric_limits<std::uint32_t>::max())) : 0u);
 
-    /* Store graphics pipeline spcific limitations */
-    pipelineLimits.lineWidthRange[0]    = limits.lineWidthRange[0];
-    pipelineLimits.lineWidthRange[1]    = limits.lineWidthRange[1];
-    pipelineLimits.lineWidthGranularity = limits.lineWidthGranularity;
+    if (subgroupProps_.subgroupSize > 0)
+    {
+        /* Bits of VkSubgroupFeatureFlagBits match SubgroupOperationFlags */
+        caps.limits.minSubgroupSize                 = (HasSubgroupSizeControl() ? subgroupSizeProps_.minSubgroupSize : subgroupProps_.subgroupSize);
+        caps.limits.maxSubgroupSize                 = (HasSubgroupSizeControl() ? subgroupSizeProps_.maxSubgroupSize : subgroupProps_.subgroupSize);
+        caps.limits.subgroupOperations              = static_cast<long>(subgroupProps_.supportedOperations & 0xFF);
+        caps.limits.subgroupStages                  = GetStageFlagsFromVkShaderStages(subgroupProps_.supportedStages);
+    }
 
-    /*
-    TODO: extension limits
-    - VkPhysicalDeviceTransformFeedbackFeaturesEXT
-    - VkPhysicalDeviceTransformFeedbackPropertiesEXT
-    */
+    /* Store graphics pipeline spcific limitations */
+    pipelineLimits.lineWidthRange[0]            = limits.lineWidthRange[0];
+    pipelineLimits.lineWidthRange[1]            = limits.lineWidthRange[1];
+    pipelineLimits.lineWidthGranularity         = limits.lineWidthGranularity;
+    pipelineLimits.hasShadingRate               = caps.features.hasVariableRateShading;
+    pipelineLimits.hasShadingRateImage          = caps.features.hasShadingRateImage;
+    pipelineLimits.hasShadingRateCombinerMinMax = (shadingRateProps_.fragmentShadingRateNonTrivialCombinerOps != VK_FALSE);
+    pipelineLimits.hasExtendedDynamicState      = (dynamicStateFeatures_.extendedDynamicState != VK_FALSE);
+    pipelineLimits.hasExtendedDynamicState2     = (dynamicState2Features_.extendedDynamicState2 != VK_FALSE);
+    pipelineLimits.hasGraphicsPipelineLibrary   = (pipelineLibraryFeatures_.graphicsPipelineLibrary != VK_FALSE);
 }
 
 VKDevice VKPhysicalDevice::CreateLogicalDevice()
 {
+    /* Enable timeline semaphores if supported; this feature is mandatory for devices that support this extension */
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures;
+    {
+        timelineSemaphoreFeatures.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        timelineSemaphoreFeatures.pNext             = nullptr;
+        timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+    }
+    const bool hasTimelineSemaphores = SupportsExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+
+    /* Enable dynamic rendering if supported; this feature is mandatory for devices that support this extension */
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures;
+    {
+        dynamicRenderingFeatures.sType              = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        dynamicRenderingFeatures.pNext              = nullptr;
+        dynamicRenderingFeatures.dynamicRendering   = VK_TRUE;
+    }
+    const bool hasDynamicRendering = SupportsExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+
+    /* Enable host query reset if supported, so timestamp queries can be reset inside of render passes */
+    VkPhysicalDeviceHostQueryResetFeaturesEXT hostQueryResetFeatures;
+    {
+        hostQueryResetFeatures.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES_EXT;
+        hostQueryResetFeatures.pNext                = nullptr;
+        hostQueryResetFeatures.hostQueryReset       = VK_TRUE;
+    }
+    const bool hasHostQueryReset = SupportsExtension(VK_EXT_HOST_QUERY_RESET_EXTENSION_NAME);
+
+    /* Enable present IDs and present wait if supported, so swap-chains can limit their frame latency */
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures;
+    {
+        presentWaitFeatures.sType                   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+        presentWaitFeatures.pNext                   = nullptr;
+        presentWaitFeatures.presentWait             = VK_TRUE;
+    }
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures;
+    {
+        presentIdFeatures.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+        presentIdFeatures.pNext                     = &presentWaitFeatures;
+        presentIdFeatures.presentId                 = VK_TRUE;
+    }
+
+    /* Enable pipeline and attachment shading rates for variable rate shading if supported; structure type is only set if these features have been queried */
+    VkPhysicalDeviceFragmentShadingRateFeaturesKHR shadingRateFeatures = shadingRateFeatures_;
+    shadingRateFeatures.pNext                           = nullptr;
+    shadingRateFeatures.primitiveFragmentShadingRate    = VK_FALSE;
+    const bool hasShadingRate = (shadingRateFeatures.sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR);
+
+    /* Enable task and mesh shaders if supported; structure type is only set if these features have been queried */
+    VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures = meshShaderFeatures_;
+    meshShaderFeatures.pNext = nullptr;
+    const bool hasMeshShader = (meshShaderFeatures.sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT);
+
+    /* Enable subgroup size control for compute shaders if supported; structure type is only set if these features have been queried */
+    VkPhysicalDeviceSubgroupSizeControlFeaturesEXT subgroupSizeFeatures = subgroupSizeFeatures_;
+    subgroupSizeFeatures.pNext = nullptr;
+    const bool hasSubgroupSizeControl = HasSubgroupSizeControl();
+
+    /* Enable extended dynamic states and graphics pipeline libraries if supported; structure types are only set if these features have been queried */
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT dynamicStateFeatures = dynamicStateFeatures_;
+    dynamicStateFeatures.pNext = nullptr;
+    const bool hasDynamicState = (dynamicStateFeatures.extendedDynamicState != VK_FALSE);
+
+    VkPhysicalDeviceExtendedDynamicState2FeaturesEXT dynamicState2Features = dynamicState2Features_;
+    dynamicState2Features.pNext = nullptr;
+    const bool hasDynamicState2 = (dynamicState2Features.extendedDynamicState2 != VK_FALSE);
+
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipelineLibraryFeatures = pipelineLibraryFeatures_;
+    pipelineLibraryFeatures.pNext = nullptr;
+    const bool hasPipelineLibrary = (pipelineLibraryFeatures.graphicsPipelineLibrary != VK_FALSE);
+
+    /* Enable host image copies if supported, so small textures can be uploaded without a queue submission */
+    VkPhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures = hostImageCopyFeatures_;
+    hostImageCopyFeatures.pNext = nullptr;
+    const bool hasHostImageCopy = HasHostImageCopy();
+
+    /* Enable multiview rendering if supported, so draw calls can be broadcast to multiple array layers */
+    VkPhysicalDeviceMultiviewFeaturesKHR multiviewFeatures = multiviewFeatures_;
+    multiviewFeatures.pNext = nullptr;
+    const bool hasMultiview = HasMultiview();
+
+    /* Enable transform feedback if supported, so stream-outputs can be captured and drawn with their byte count */
+    VkPhysicalDeviceTransformFeedbackFeaturesEXT transformFeedbackFeatures = transformFeedbackFeatures_;
+    transformFeedbackFeatures.pNext = nullptr;
+    const bool hasTransformFeedback = HasTransformFeedback();
+
+    /* Enable memory priorities and pageable device local memory if supported, so the OS can demote cold allocations first under oversubscription */
+    VkPhysicalDeviceMemoryPriorityFeaturesEXT memoryPriorityFeatures = memoryPriorityFeatures_;
+    memoryPriorityFeatures.pNext = nullptr;
+    const bool hasMemoryPriority = (memoryPriorityFeatures.memoryPriority != VK_FALSE);
+
+    VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT pageableMemoryFeatures = pageableMemoryFeatures_;
+    pageableMemoryFeatures.pNext = nullptr;
+    const bool hasPageableMemory = HasPageableDeviceLocalMemory();
+
+    /* Enable buffer device addresses if supported; these are also required for acceleration structure builds */
+    VkPhysicalDeviceBufferDeviceAddressFeaturesKHR bufferAddressFeatures = bufferAddressFeatures_;
+    bufferAddressFeatures.pNext = nullptr;
+    const bool hasBufferDeviceAddress = HasBufferDeviceAddress();
+
+    /* Enable acceleration structures and ray queries if supported */
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR accelStructFeatures = accelStructFeatures_;
+    accelStructFeatures.pNext = nullptr;
+
+    VkPhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures = rayQueryFeatures_;
+    rayQueryFeatures.pNext = &accelStructFeatures;
+    const bool hasRayTracing = HasRayTracing();
+
+    /* Enable all supported descriptor indexing features for bindless resource heaps; structure type is only set if these features have been queried */
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures = descriptorIndexingFeatures_;
+    descriptorIndexingFeatures.pNext = nullptr;
+    const bool hasDescriptorIndexing = (descriptorIndexingFeatures.sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT);
+
+    /* Chain extension features into device create info */
+    const void* next = nullptr;
+    if (hasDescriptorIndexing)
+        next = &descriptorIndexingFeatures;
+    if (hasTimelineSemaphores)
+    {
+        timelineSemaphoreFeatures.pNext = const_cast<void*>(next);
+        next = &timelineSemaphoreFeatures;
+    }
+    if (hasDynamicRendering)
+    {
+        dynamicRenderingFeatures.pNext = const_cast<void*>(next);
+        next = &dynamicRenderingFeatures;
+    }
+    if (hasHostQueryReset)
+    {
+        hostQueryResetFeatures.pNext = const_cast<void*>(next);
+        next = &hostQueryResetFeatures;
+    }
+    if (hasPresentWait_)
+    {
+        presentWaitFeatures.pNext = const_cast<void*>(next);
+        next = &presentIdFeatures;
+    }
+    if (hasShadingRate)
+    {
+        shadingRateFeatures.pNext = const_cast<void*>(next);
+        next = &shadingRateFeatures;
+    }
+    if (hasMeshShader)
+    {
+        meshShaderFeatures.pNext = const_cast<void*>(next);
+        next = &meshShaderFeatures;
+    }
+    if (hasSubgroupSizeControl)
+    {
+        subgroupSizeFeatures.pNext = const_cast<void*>(next);
+        next = &subgroupSizeFeatures;
+    }
+    if (hasDynamicState)
+    {
+        dynamicStateFeatures.pNext = const_cast<void*>(next);
+        next = &dynamicStateFeatures;
+    }
+    if (hasDynamicState2)
+    {
+        dynamicState2Features.pNext = const_cast<void*>(next);
+        next = &dynamicState2Features;
+    }
+    if (hasPipelineLibrary)
+    {
+        pipelineLibraryFeatures.pNext = const_cast<void*>(next);
+        next = &pipelineLibraryFeatures;
+    }
+    if (hasHostImageCopy)
+    {
+        hostImageCopyFeatures.pNext = const_cast<void*>(next);
+        next = &hostImageCopyFeatures;
+    }
+    if (hasMultiview)
+    {
+        multiviewFeatures.pNext = const_cast<void*>(next);
+        next = &multiviewFeatures;
+    }
+    if (hasTransformFeedback)
+    {
+        transformFeedbackFeatures.pNext = const_cast<void*>(next);
+        next = &transformFeedbackFeatures;
+    }
+    if (hasMemoryPriority)
+    {
+        memoryPriorityFeatures.pNext = const_cast<void*>(next);
+        next = &memoryPriorityFeatures;
+    }
+    if (hasPageableMemory)
+    {
+        pageableMemoryFeatures.pNext = const_cast<void*>(next);
+        next = &pageableMemoryFeatures;
+    }
+    if (hasBufferDeviceAddress)
+    {
+        bufferAddressFeatures.pNext = const_cast<void*>(next);
+        next = &bufferAddressFeatures;
+    }
+    if (hasRayTracing)
+    {
+        accelStructFeatures.pNext = const_cast<void*>(next);
+        next = &rayQueryFeatures;
+    }
+
     VKDevice device;
     device.CreateLogicalDevice(
         physicalDevice_,
         &features_,
         enabledExtensionNames_.data(),
-        static_cast<std::uint32_t>(enabledExtensionNames_.size())
+        static_cast<std::uint32_t>(enabledExtensionNames_.size()),
+        next
     );
     return device;
 }
@@ -263,6 +587,25 @@ std::uint32_t VKPhysicalDevice::FindMemoryType(std::uint32_t memoryTypeBits, VkM
     return VKFindMemoryType(memoryProperties_, memoryTypeBits, properties);
 }
 
+bool VKPhysicalDevice::QueryMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& outBudget) const
+{
+    /* VK_EXT_memory_budget is queried via VK_KHR_get_physical_device_properties2 */
+    if (!HasExtension(VKExt::EXT_memory_budget) || !HasExtension(VKExt::KHR_get_physical_device_properties2))
+        return false;
+
+    outBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    outBudget.pNext = nullptr;
+
+    VkPhysicalDeviceMemoryProperties2 memoryPropertiesExt;
+    {
+        memoryPropertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memoryPropertiesExt.pNext = &outBudget;
+    }
+    vkGetPhysicalDeviceMemoryProperties2KHR(physicalDevice_, &memoryPropertiesExt);
+
+    return true;
+}
+
 bool VKPhysicalDevice::SupportsExtension(const char* extension) const
 {
     auto it = std::find_if(
@@ -376,6 +719,660 @@ void VKPhysicalDevice::QueryDeviceMemoryPropertiesWithExtensions()
     vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &memoryProperties_);
 }
 
+void VKPhysicalDevice::QueryDescriptorIndexingFeatures(VkInstance instance)
+{
+    /* VK_EXT_descriptor_indexing requires VK_KHR_maintenance3 on the device and VK_KHR_get_physical_device_properties2 on the instance */
+    if (!SupportsExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) || !SupportsExtension(VK_KHR_MAINTENANCE3_EXTENSION_NAME))
+        return;
+
+    auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+    );
+    if (getPhysicalDeviceFeatures2 == nullptr)
+        return;
+
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures = {};
+    descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2KHR featuresExt = {};
+    {
+        featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        featuresExt.pNext = &descriptorIndexingFeatures;
+    }
+    getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+    descriptorIndexingFeatures_ = descriptorIndexingFeatures;
+}
+
+void VKPhysicalDevice::QueryPresentWaitFeatures(VkInstance instance)
+{
+    if (SupportsExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME) && SupportsExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr)
+        {
+            VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+            presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+            VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+            presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+            presentIdFeatures.pNext = &presentWaitFeatures;
+
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &presentIdFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            hasPresentWait_ = (presentIdFeatures.presentId != VK_FALSE && presentWaitFeatures.presentWait != VK_FALSE);
+        }
+    }
+
+    /* Extensions must not be enabled without their features, since they would be reported as available */
+    if (!hasPresentWait_)
+    {
+        DisableExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        DisableExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    }
+}
+
+void VKPhysicalDevice::QueryFragmentShadingRateFeatures(VkInstance instance)
+{
+    /* VK_KHR_fragment_shading_rate requires VK_KHR_create_renderpass2 on the device and VK_KHR_get_physical_device_properties2 on the instance */
+    if (SupportsExtension(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME) && SupportsExtension(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        auto getPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr && getPhysicalDeviceProperties2 != nullptr)
+        {
+            VkPhysicalDeviceFragmentShadingRateFeaturesKHR shadingRateFeatures = {};
+            shadingRateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR;
+
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &shadingRateFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            VkPhysicalDeviceFragmentShadingRatePropertiesKHR shadingRateProps = {};
+            shadingRateProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_PROPERTIES_KHR;
+
+            VkPhysicalDeviceProperties2KHR propertiesExt = {};
+            {
+                propertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+                propertiesExt.pNext = &shadingRateProps;
+            }
+            getPhysicalDeviceProperties2(physicalDevice_, &propertiesExt);
+
+            /* Only pipeline and attachment shading rates are exposed */
+            if (shadingRateFeatures.pipelineFragmentShadingRate != VK_FALSE)
+            {
+                if (!SupportsExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME))
+                    shadingRateFeatures.attachmentFragmentShadingRate = VK_FALSE;
+                shadingRateFeatures_    = shadingRateFeatures;
+                shadingRateProps_       = shadingRateProps;
+            }
+        }
+    }
+
+    /* Extension must not be enabled without its features, since the pipeline shading rate is the minimum that is exposed */
+    if (shadingRateFeatures_.pipelineFragmentShadingRate == VK_FALSE)
+        DisableExtension(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME);
+}
+
+void VKPhysicalDevice::QueryMeshShaderFeatures(VkInstance instance)
+{
+    /* VK_EXT_mesh_shader requires VK_KHR_spirv_1_4 on the device and VK_KHR_get_physical_device_properties2 on the instance */
+    if (SupportsExtension(VK_EXT_MESH_SHADER_EXTENSION_NAME) && SupportsExtension(VK_KHR_SPIRV_1_4_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr)
+        {
+            VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures = {};
+            meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &meshShaderFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            /* Only task and mesh shaders are exposed; multiview and primitive shading rates would require additional device features */
+            if (meshShaderFeatures.meshShader != VK_FALSE)
+            {
+                meshShaderFeatures.multiviewMeshShader                       = VK_FALSE;
+                meshShaderFeatures.primitiveFragmentShadingRateMeshShader    = VK_FALSE;
+                meshShaderFeatures.meshShaderQueries                         = VK_FALSE;
+                meshShaderFeatures_ = meshShaderFeatures;
+            }
+        }
+    }
+
+    /* Extension must not be enabled without its features */
+    if (meshShaderFeatures_.meshShader == VK_FALSE)
+        DisableExtension(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+}
+
+void VKPhysicalDevice::QuerySubgroupProperties(VkInstance instance)
+{
+    /* VkPhysicalDeviceSubgroupProperties and VK_EXT_subgroup_size_control require Vulkan 1.1 on the device */
+    if (properties_.apiVersion >= VK_API_VERSION_1_1)
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        auto getPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr && getPhysicalDeviceProperties2 != nullptr)
+        {
+            const bool hasSizeControlExt = SupportsExtension(VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME);
+
+            VkPhysicalDeviceSubgroupSizeControlPropertiesEXT subgroupSizeProps = {};
+            subgroupSizeProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_PROPERTIES_EXT;
+
+            VkPhysicalDeviceSubgroupProperties subgroupProps = {};
+            subgroupProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+            subgroupProps.pNext = (hasSizeControlExt ? &subgroupSizeProps : nullptr);
+
+            VkPhysicalDeviceProperties2KHR propertiesExt = {};
+            {
+                propertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+                propertiesExt.pNext = &subgroupProps;
+            }
+            getPhysicalDeviceProperties2(physicalDevice_, &propertiesExt);
+
+            subgroupProps.pNext = nullptr;
+            subgroupProps_ = subgroupProps;
+
+            if (hasSizeControlExt)
+            {
+                VkPhysicalDeviceSubgroupSizeControlFeaturesEXT subgroupSizeFeatures = {};
+                subgroupSizeFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_FEATURES_EXT;
+
+                VkPhysicalDeviceFeatures2KHR featuresExt = {};
+                {
+                    featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                    featuresExt.pNext = &subgroupSizeFeatures;
+                }
+                getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+                /* Only required subgroup sizes with full subgroups in compute shaders are exposed */
+                if (subgroupSizeFeatures.subgroupSizeControl != VK_FALSE &&
+                    subgroupSizeFeatures.computeFullSubgroups != VK_FALSE &&
+                    (subgroupSizeProps.requiredSubgroupSizeStages & VK_SHADER_STAGE_COMPUTE_BIT) != 0)
+                {
+                    subgroupSizeProps.pNext = nullptr;
+                    subgroupSizeFeatures_   = subgroupSizeFeatures;
+                    subgroupSizeProps_      = subgroupSizeProps;
+                }
+            }
+        }
+    }
+
+    /* Extension must not be enabled without its features */
+    if (!HasSubgroupSizeControl())
+        DisableExtension(VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME);
+}
+
+void VKPhysicalDevice::QueryDynamicStateFeatures(VkInstance instance)
+{
+    const bool hasDynamicStateExt       = SupportsExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+    const bool hasDynamicState2Ext      = SupportsExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+    const bool hasPipelineLibraryExt    = (SupportsExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) && SupportsExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME));
+
+    if (hasDynamicStateExt || hasDynamicState2Ext || hasPipelineLibraryExt)
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr)
+        {
+            VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipelineLibraryFeatures = {};
+            pipelineLibraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+            VkPhysicalDeviceExtendedDynamicState2FeaturesEXT dynamicState2Features = {};
+            dynamicState2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+
+            VkPhysicalDeviceExtendedDynamicStateFeaturesEXT dynamicStateFeatures = {};
+            dynamicStateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+
+            /* Only chain structures of supported extensions */
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+            if (hasPipelineLibraryExt)
+            {
+                pipelineLibraryFeatures.pNext = featuresExt.pNext;
+                featuresExt.pNext = &pipelineLibraryFeatures;
+            }
+            if (hasDynamicState2Ext)
+            {
+                dynamicState2Features.pNext = featuresExt.pNext;
+                featuresExt.pNext = &dynamicState2Features;
+            }
+            if (hasDynamicStateExt)
+            {
+                dynamicStateFeatures.pNext = featuresExt.pNext;
+                featuresExt.pNext = &dynamicStateFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            if (dynamicStateFeatures.extendedDynamicState != VK_FALSE)
+            {
+                dynamicStateFeatures.pNext = nullptr;
+                dynamicStateFeatures_ = dynamicStateFeatures;
+            }
+
+            /* Only depth bias, primitive restart, and rasterizer discard are set dynamically; logic op and patch control points would require additional device features */
+            if (dynamicState2Features.extendedDynamicState2 != VK_FALSE)
+            {
+                dynamicState2Features.pNext                                     = nullptr;
+                dynamicState2Features.extendedDynamicState2LogicOp              = VK_FALSE;
+                dynamicState2Features.extendedDynamicState2PatchControlPoints   = VK_FALSE;
+                dynamicState2Features_ = dynamicState2Features;
+            }
+
+            if (pipelineLibraryFeatures.graphicsPipelineLibrary != VK_FALSE)
+            {
+                pipelineLibraryFeatures.pNext = nullptr;
+                pipelineLibraryFeatures_ = pipelineLibraryFeatures;
+            }
+        }
+    }
+
+    /* Extensions must not be enabled without their features */
+    if (dynamicStateFeatures_.extendedDynamicState == VK_FALSE)
+        DisableExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+    if (dynamicState2Features_.extendedDynamicState2 == VK_FALSE)
+        DisableExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+    if (pipelineLibraryFeatures_.graphicsPipelineLibrary == VK_FALSE)
+        DisableExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+}
+
+// Returns the Vulkan time domain that corresponds to Timer::Tick on the current platform.
+static bool GetHostTimeDomainForPlatform(VkTimeDomainEXT& outTimeDomain)
+{
+    #if defined LLGL_OS_WIN32
+    outTimeDomain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+    return true;
+    #elif defined LLGL_OS_LINUX || defined LLGL_OS_ANDROID
+    outTimeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+void VKPhysicalDevice::QueryCalibrateableTimeDomains(VkInstance instance)
+{
+    VkTimeDomainEXT hostTimeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    if (SupportsExtension(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) && GetHostTimeDomainForPlatform(hostTimeDomain))
+    {
+        auto getPhysicalDeviceCalibrateableTimeDomains = reinterpret_cast<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT")
+        );
+        if (getPhysicalDeviceCalibrateableTimeDomains != nullptr)
+        {
+            std::uint32_t numTimeDomains = 0;
+            getPhysicalDeviceCalibrateableTimeDomains(physicalDevice_, &numTimeDomains, nullptr);
+
+            std::vector<VkTimeDomainEXT> timeDomains(numTimeDomains);
+            getPhysicalDeviceCalibrateableTimeDomains(physicalDevice_, &numTimeDomains, timeDomains.data());
+
+            /* Both the device and the host time domain must be calibrateable */
+            bool hasDeviceDomain = false, hasHostDomain = false;
+            for (VkTimeDomainEXT timeDomain : timeDomains)
+            {
+                if (timeDomain == VK_TIME_DOMAIN_DEVICE_EXT)
+                    hasDeviceDomain = true;
+                else if (timeDomain == hostTimeDomain)
+                    hasHostDomain = true;
+            }
+
+            if (hasDeviceDomain && hasHostDomain)
+            {
+                hasCalibratedTimestamps_    = true;
+                hostTimeDomain_             = hostTimeDomain;
+            }
+        }
+    }
+
+    /* Extensions must not be enabled if none of their time domains can be used */
+    if (!hasCalibratedTimestamps_)
+        DisableExtension(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+}
+
+void VKPhysicalDevice::QueryHostImageCopyFeatures(VkInstance instance)
+{
+    /* VK_EXT_host_image_copy depends on VK_KHR_copy_commands2 and VK_KHR_format_feature_flags2 */
+    if (SupportsExtension(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME) &&
+        SupportsExtension(VK_KHR_COPY_COMMANDS_2_EXTENSION_NAME) &&
+        SupportsExtension(VK_KHR_FORMAT_FEATURE_FLAGS_2_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        auto getPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr && getPhysicalDeviceProperties2 != nullptr)
+        {
+            VkPhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures = {};
+            hostImageCopyFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &hostImageCopyFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            if (hostImageCopyFeatures.hostImageCopy != VK_FALSE)
+            {
+                /* Query number of destination layouts first, then query the layouts themselves */
+                VkPhysicalDeviceHostImageCopyPropertiesEXT hostImageCopyProps = {};
+                hostImageCopyProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_PROPERTIES_EXT;
+
+                VkPhysicalDeviceProperties2KHR propertiesExt = {};
+                {
+                    propertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+                    propertiesExt.pNext = &hostImageCopyProps;
+                }
+                getPhysicalDeviceProperties2(physicalDevice_, &propertiesExt);
+
+                hostImageCopyDstLayouts_.resize(hostImageCopyProps.copyDstLayoutCount);
+                hostImageCopyProps.copySrcLayoutCount   = 0;
+                hostImageCopyProps.pCopyDstLayouts      = hostImageCopyDstLayouts_.data();
+                getPhysicalDeviceProperties2(physicalDevice_, &propertiesExt);
+                hostImageCopyDstLayouts_.resize(hostImageCopyProps.copyDstLayoutCount);
+
+                hostImageCopyFeatures.pNext = nullptr;
+                hostImageCopyFeatures_ = hostImageCopyFeatures;
+            }
+        }
+    }
+
+    /* Extensions must not be enabled without their features */
+    if (hostImageCopyFeatures_.hostImageCopy == VK_FALSE)
+        DisableExtension(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME);
+}
+
+void VKPhysicalDevice::QueryMultiviewFeatures(VkInstance instance)
+{
+    /* The multiview feature is mandatory for VK_KHR_multiview, but query it anyway to determine the view count limit */
+    if (SupportsExtension(VK_KHR_MULTIVIEW_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        auto getPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr && getPhysicalDeviceProperties2 != nullptr)
+        {
+            VkPhysicalDeviceMultiviewFeaturesKHR multiviewFeatures = {};
+            multiviewFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES_KHR;
+
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &multiviewFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            if (multiviewFeatures.multiview != VK_FALSE)
+            {
+                VkPhysicalDeviceMultiviewPropertiesKHR multiviewProps = {};
+                multiviewProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_PROPERTIES_KHR;
+
+                VkPhysicalDeviceProperties2KHR propertiesExt = {};
+                {
+                    propertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+                    propertiesExt.pNext = &multiviewProps;
+                }
+                getPhysicalDeviceProperties2(physicalDevice_, &propertiesExt);
+
+                multiviewFeatures.pNext = nullptr;
+                multiviewFeatures_ = multiviewFeatures;
+                multiviewProps.pNext = nullptr;
+                multiviewProps_ = multiviewProps;
+            }
+        }
+    }
+
+    /* Extension is kept enabled even without its feature, since VK_KHR_create_renderpass2 depends on it */
+}
+
+void VKPhysicalDevice::QueryTransformFeedbackFeatures(VkInstance instance)
+{
+    if (SupportsExtension(VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        auto getPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr && getPhysicalDeviceProperties2 != nullptr)
+        {
+            VkPhysicalDeviceTransformFeedbackFeaturesEXT transformFeedbackFeatures = {};
+            transformFeedbackFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TRANSFORM_FEEDBACK_FEATURES_EXT;
+
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &transformFeedbackFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            if (transformFeedbackFeatures.transformFeedback != VK_FALSE)
+            {
+                VkPhysicalDeviceTransformFeedbackPropertiesEXT transformFeedbackProps = {};
+                transformFeedbackProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TRANSFORM_FEEDBACK_PROPERTIES_EXT;
+
+                VkPhysicalDeviceProperties2KHR propertiesExt = {};
+                {
+                    propertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+                    propertiesExt.pNext = &transformFeedbackProps;
+                }
+                getPhysicalDeviceProperties2(physicalDevice_, &propertiesExt);
+
+                /* Only the rasterization stream 0 is used, so geometry streams are not enabled */
+                transformFeedbackFeatures.pNext             = nullptr;
+                transformFeedbackFeatures.geometryStreams   = VK_FALSE;
+                transformFeedbackFeatures_ = transformFeedbackFeatures;
+                transformFeedbackProps.pNext = nullptr;
+                transformFeedbackProps_ = transformFeedbackProps;
+            }
+        }
+    }
+
+    /* Extensions must not be enabled without their features */
+    if (transformFeedbackFeatures_.transformFeedback == VK_FALSE)
+        DisableExtension(VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME);
+}
+
+void VKPhysicalDevice::QueryMemoryPriorityFeatures(VkInstance instance)
+{
+    if (SupportsExtension(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr)
+        {
+            const bool hasPageableMemoryExt = SupportsExtension(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME);
+
+            VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT pageableMemoryFeatures = {};
+            pageableMemoryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT;
+
+            VkPhysicalDeviceMemoryPriorityFeaturesEXT memoryPriorityFeatures = {};
+            {
+                memoryPriorityFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT;
+                memoryPriorityFeatures.pNext = (hasPageableMemoryExt ? &pageableMemoryFeatures : nullptr);
+            }
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &memoryPriorityFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            if (memoryPriorityFeatures.memoryPriority != VK_FALSE)
+            {
+                memoryPriorityFeatures.pNext = nullptr;
+                memoryPriorityFeatures_ = memoryPriorityFeatures;
+
+                /* VK_EXT_pageable_device_local_memory depends on VK_EXT_memory_priority */
+                if (pageableMemoryFeatures.pageableDeviceLocalMemory != VK_FALSE)
+                {
+                    pageableMemoryFeatures.pNext = nullptr;
+                    pageableMemoryFeatures_ = pageableMemoryFeatures;
+                }
+            }
+        }
+    }
+
+    /* Extensions must not be enabled without their features */
+    if (memoryPriorityFeatures_.memoryPriority == VK_FALSE)
+        DisableExtension(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME);
+    if (pageableMemoryFeatures_.pageableDeviceLocalMemory == VK_FALSE)
+        DisableExtension(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME);
+}
+
+void VKPhysicalDevice::QueryBufferDeviceAddressFeatures(VkInstance instance)
+{
+    if (SupportsExtension(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr)
+        {
+            VkPhysicalDeviceBufferDeviceAddressFeaturesKHR bufferAddressFeatures = {};
+            bufferAddressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR;
+
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &bufferAddressFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            if (bufferAddressFeatures.bufferDeviceAddress != VK_FALSE)
+            {
+                /* Only enable the features that are used by LLGL */
+                bufferAddressFeatures.pNext                             = nullptr;
+                bufferAddressFeatures.bufferDeviceAddressCaptureReplay  = VK_FALSE;
+                bufferAddressFeatures.bufferDeviceAddressMultiDevice    = VK_FALSE;
+                bufferAddressFeatures_ = bufferAddressFeatures;
+            }
+        }
+    }
+
+    /* Extension must not be enabled without its feature */
+    if (!HasBufferDeviceAddress())
+        DisableExtension(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
+}
+
+void VKPhysicalDevice::QueryRayTracingFeatures(VkInstance instance)
+{
+    /* VK_KHR_acceleration_structure requires Vulkan 1.1, VK_EXT_descriptor_indexing, VK_KHR_buffer_device_address, and VK_KHR_deferred_host_operations */
+    if (properties_.apiVersion >= VK_API_VERSION_1_1 &&
+        HasBufferDeviceAddress() &&
+        SupportsExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) &&
+        SupportsExtension(VK_KHR_RAY_QUERY_EXTENSION_NAME) &&
+        SupportsExtension(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME) &&
+        SupportsExtension(VK_KHR_SPIRV_1_4_EXTENSION_NAME) &&
+        SupportsExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+    {
+        auto getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+        );
+        auto getPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")
+        );
+        if (getPhysicalDeviceFeatures2 != nullptr && getPhysicalDeviceProperties2 != nullptr)
+        {
+            VkPhysicalDeviceAccelerationStructureFeaturesKHR accelStructFeatures = {};
+            accelStructFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+
+            VkPhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures = {};
+            {
+                rayQueryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR;
+                rayQueryFeatures.pNext = &accelStructFeatures;
+            }
+            VkPhysicalDeviceFeatures2KHR featuresExt = {};
+            {
+                featuresExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                featuresExt.pNext = &rayQueryFeatures;
+            }
+            getPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+            if (rayQueryFeatures.rayQuery                   != VK_FALSE &&
+                accelStructFeatures.accelerationStructure   != VK_FALSE)
+            {
+                VkPhysicalDeviceAccelerationStructurePropertiesKHR accelStructProps = {};
+                accelStructProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
+
+                VkPhysicalDeviceProperties2KHR propertiesExt = {};
+                {
+                    propertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+                    propertiesExt.pNext = &accelStructProps;
+                }
+                getPhysicalDeviceProperties2(physicalDevice_, &propertiesExt);
+
+                /* Only enable the features that are used by LLGL */
+                accelStructFeatures.pNext                                           = nullptr;
+                accelStructFeatures.accelerationStructureCaptureReplay              = VK_FALSE;
+                accelStructFeatures.accelerationStructureIndirectBuild              = VK_FALSE;
+                accelStructFeatures.accelerationStructureHostCommands               = VK_FALSE;
+                accelStructFeatures_ = accelStructFeatures;
+
+                rayQueryFeatures.pNext = nullptr;
+                rayQueryFeatures_ = rayQueryFeatures;
+
+                accelStructProps.pNext = nullptr;
+                accelStructProps_ = accelStructProps;
+            }
+        }
+    }
+
+    /* Extensions must not be enabled without their features */
+    if (rayQueryFeatures_.rayQuery == VK_FALSE)
+    {
+        DisableExtension(VK_KHR_RAY_QUERY_EXTENSION_NAME);
+        DisableExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);
+        DisableExtension(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+    }
+}
+
+void VKPhysicalDevice::DisableExtension(const char* extension)
+{
+    enabledExtensionNames_.erase(
+        std::remove_if(
+            enabledExtensionNames_.begin(),
+            enabledExtensionNames_.end(),
+            [extension](const char* entry)
+            {
+                return (std::strcmp(extension, entry) == 0);
+            }
+        ),
+        enabledExtensionNames_.end()
+    );
+}
+
 
 } // /namespace LLGL
 
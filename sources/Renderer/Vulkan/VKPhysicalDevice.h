@@ -12,6 +12,7 @@
 #include "Vulkan.h"
 #include "VKDevice.h"
 #include <LLGL/RenderSystemFlags.h>
+#include <LLGL/Container/ArrayView.h>
 #include <vector>
 #include <set>
 #include <cstring>
@@ -30,7 +31,8 @@ class VKPhysicalDevice
 
         /* ----- Common ----- */
 
-        bool PickPhysicalDevice(VkInstance instance);
+        // Picks the first suitable physical device from the specified candidates. Returns false if none of them is suitable. Headless devices don't require VK_KHR_swapchain.
+        bool PickPhysicalDevice(VkInstance instance, const ArrayView<VkPhysicalDevice>& candidates, bool headless = false);
 
         void QueryDeviceProperties(
             RendererInfo&               info,
@@ -42,6 +44,9 @@ class VKPhysicalDevice
 
         std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
 
+        // Queries the current memory budget and usage of all memory heaps. Returns false if VK_EXT_memory_budget is not supported.
+        bool QueryMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& outBudget) const;
+
         // Returns true if the specified Vulkan extension is supported by this physical device.
         bool SupportsExtension(const char* extension) const;
 
@@ -77,6 +82,84 @@ class VKPhysicalDevice
             return memoryProperties_;
         }
 
+        // Returns the descriptor indexing features of the physical device. All features are disabled if VK_EXT_descriptor_indexing is not supported.
+        inline const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& GetDescriptorIndexingFeatures() const
+        {
+            return descriptorIndexingFeatures_;
+        }
+
+        // Returns true if VK_EXT_subgroup_size_control is supported including the features to require a subgroup size for compute shaders.
+        inline bool HasSubgroupSizeControl() const
+        {
+            return (subgroupSizeFeatures_.subgroupSizeControl != VK_FALSE);
+        }
+
+        // Returns true if VK_KHR_present_id and VK_KHR_present_wait are supported including their device features.
+        inline bool HasPresentWait() const
+        {
+            return hasPresentWait_;
+        }
+
+        // Returns true if VK_EXT_host_image_copy is supported including its device feature.
+        inline bool HasHostImageCopy() const
+        {
+            return (hostImageCopyFeatures_.hostImageCopy != VK_FALSE);
+        }
+
+        // Returns true if VK_KHR_multiview is supported including its device feature.
+        inline bool HasMultiview() const
+        {
+            return (multiviewFeatures_.multiview != VK_FALSE);
+        }
+
+        // Returns true if VK_EXT_transform_feedback is supported including its device feature.
+        inline bool HasTransformFeedback() const
+        {
+            return (transformFeedbackFeatures_.transformFeedback != VK_FALSE);
+        }
+
+        // Returns true if VK_EXT_pageable_device_local_memory is supported including its device feature, i.e. memory priorities can be changed after allocation.
+        inline bool HasPageableDeviceLocalMemory() const
+        {
+            return (pageableMemoryFeatures_.pageableDeviceLocalMemory != VK_FALSE);
+        }
+
+        // Returns true if VK_KHR_buffer_device_address is supported including its device feature.
+        inline bool HasBufferDeviceAddress() const
+        {
+            return (bufferAddressFeatures_.bufferDeviceAddress != VK_FALSE);
+        }
+
+        // Returns true if VK_KHR_acceleration_structure, VK_KHR_ray_query, and VK_KHR_buffer_device_address are supported including their device features.
+        inline bool HasRayTracing() const
+        {
+            return (rayQueryFeatures_.rayQuery != VK_FALSE);
+        }
+
+        // Returns the properties of VK_KHR_acceleration_structure. Only valid if HasRayTracing() returns true.
+        inline const VkPhysicalDeviceAccelerationStructurePropertiesKHR& GetAccelerationStructureProperties() const
+        {
+            return accelStructProps_;
+        }
+
+        // Returns the image layouts that are supported as destination of host image copies. Empty if VK_EXT_host_image_copy is not supported.
+        inline const std::vector<VkImageLayout>& GetHostImageCopyDstLayouts() const
+        {
+            return hostImageCopyDstLayouts_;
+        }
+
+        // Returns true if VK_EXT_calibrated_timestamps is supported including the host time domain that matches Timer::Tick.
+        inline bool HasCalibratedTimestamps() const
+        {
+            return hasCalibratedTimestamps_;
+        }
+
+        // Returns the host time domain for calibrated timestamps, i.e. CLOCK_MONOTONIC or QueryPerformanceCounter. Only valid if HasCalibratedTimestamps() returns true.
+        inline VkTimeDomainEXT GetHostTimeDomain() const
+        {
+            return hostTimeDomain_;
+        }
+
         // Returns the list of names of all supported and enabled extensions.
         inline const std::vector<const char*>& GetExtensionNames() const
         {
@@ -102,6 +185,21 @@ class VKPhysicalDevice
         void QueryDeviceFeaturesWithExtensions();
         void QueryDevicePropertiesWithExtensions();
         void QueryDeviceMemoryPropertiesWithExtensions();
+        void QueryDescriptorIndexingFeatures(VkInstance instance);
+        void QueryPresentWaitFeatures(VkInstance instance);
+        void QueryFragmentShadingRateFeatures(VkInstance instance);
+        void QueryMeshShaderFeatures(VkInstance instance);
+        void QuerySubgroupProperties(VkInstance instance);
+        void QueryDynamicStateFeatures(VkInstance instance);
+        void QueryCalibrateableTimeDomains(VkInstance instance);
+        void QueryHostImageCopyFeatures(VkInstance instance);
+        void QueryMultiviewFeatures(VkInstance instance);
+        void QueryTransformFeedbackFeatures(VkInstance instance);
+        void QueryMemoryPriorityFeatures(VkInstance instance);
+        void QueryBufferDeviceAddressFeatures(VkInstance instance);
+        void QueryRayTracingFeatures(VkInstance instance);
+
+        void DisableExtension(const char* extension);
 
     private:
 
@@ -118,6 +216,31 @@ class VKPhysicalDevice
 
         // Extension specific
         VkPhysicalDeviceConservativeRasterizationPropertiesEXT  conservRasterProps_         = {};
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT           descriptorIndexingFeatures_ = {};
+        VkPhysicalDeviceFragmentShadingRateFeaturesKHR          shadingRateFeatures_        = {};
+        VkPhysicalDeviceFragmentShadingRatePropertiesKHR        shadingRateProps_           = {};
+        VkPhysicalDeviceMeshShaderFeaturesEXT                   meshShaderFeatures_         = {};
+        VkPhysicalDeviceSubgroupProperties                      subgroupProps_              = {};
+        VkPhysicalDeviceSubgroupSizeControlFeaturesEXT          subgroupSizeFeatures_       = {};
+        VkPhysicalDeviceSubgroupSizeControlPropertiesEXT        subgroupSizeProps_          = {};
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT         dynamicStateFeatures_       = {};
+        VkPhysicalDeviceExtendedDynamicState2FeaturesEXT        dynamicState2Features_      = {};
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT      pipelineLibraryFeatures_    = {};
+        VkPhysicalDeviceHostImageCopyFeaturesEXT                hostImageCopyFeatures_      = {};
+        std::vector<VkImageLayout>                              hostImageCopyDstLayouts_;
+        VkPhysicalDeviceMultiviewFeaturesKHR                    multiviewFeatures_          = {};
+        VkPhysicalDeviceMultiviewPropertiesKHR                  multiviewProps_             = {};
+        VkPhysicalDeviceTransformFeedbackFeaturesEXT            transformFeedbackFeatures_  = {};
+        VkPhysicalDeviceTransformFeedbackPropertiesEXT          transformFeedbackProps_     = {};
+        VkPhysicalDeviceMemoryPriorityFeaturesEXT               memoryPriorityFeatures_     = {};
+        VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT    pageableMemoryFeatures_     = {};
+        VkPhysicalDeviceBufferDeviceAddressFeaturesKHR          bufferAddressFeatures_      = {};
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR        accelStructFeatures_        = {};
+        VkPhysicalDeviceAccelerationStructurePropertiesKHR      accelStructProps_           = {};
+        VkPhysicalDeviceRayQueryFeaturesKHR                     rayQueryFeatures_           = {};
+        bool                                                    hasPresentWait_             = false;
+        bool                                                    hasCalibratedTimestamps_    = false;
+        VkTimeDomainEXT                                         hostTimeDomain_             = VK_TIME_DOMAIN_DEVICE_EXT;
 
 };
 
@@ -11,20 +11,35 @@
 #include "Ext/VKExtensions.h"
 #include "Ext/VKExtensionRegistry.h"
 #include "Memory/VKDeviceMemory.h"
+#include "Memory/VKExternalHandle.h"
 #include "../RenderSystemUtils.h"
+#include "../FileLoadUtils.h"
 #include "../TextureUtils.h"
+#include "../BufferUtils.h"
 #include "../CheckedCast.h"
 #include "../../Core/CoreUtils.h"
+#include "../../Core/StringUtils.h"
 #include "../../Core/Vendor.h"
+#include "../../Core/VendorTuning.h"
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "VKInitializers.h"
 #include "RenderState/VKPredicateQueryHeap.h"
 #include "RenderState/VKComputePSO.h"
+#include "RenderState/VKBarrierAccumulator.h"
+#include "RenderState/VKPipelinePool.h"
 #include "Shader/VKShaderModulePool.h"
+#include "Texture/VKMipGenerator.h"
+#include "Texture/VKTextureCompressor.h"
+#include "Texture/VKHostImageCopy.h"
+#include "Buffer/VKIndirectArgumentCompactor.h"
 #include "../../Platform/Debug.h"
+#include "../HostTrace.h"
 #include <LLGL/ImageFlags.h>
+#include <LLGL/Utils/ForRange.h>
 #include <limits>
+#include <algorithm>
+#include <string.h>
 
 #include <LLGL/Backend/Vulkan/NativeHandle.h>
 
@@ -33,18 +48,35 @@ namespace LLGL
 {
 
 
+// Returns the tuning profile for the vendor of the specified physical device with all overrides of the renderer configuration applied.
+static VendorTuningProfile GetVKTuningProfile(const VKPhysicalDevice& physicalDevice, const RendererConfigurationVulkan* config)
+{
+    VendorTuningProfile profile = GetVendorTuningProfile(GetVendorByID(static_cast<std::uint16_t>(physicalDevice.GetProperties().vendorID)));
+    if (config != nullptr)
+    {
+        profile.descriptorPoolCapacity  = GetTuningSize(config->descriptorPoolCapacity, profile.descriptorPoolCapacity);
+        profile.splitBarriers           = GetTuningOverride(config->splitBarriers, profile.splitBarriers);
+    }
+    return profile;
+}
+
 VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
-    instance_          { vkDestroyInstance                                                },
-    debugLayerEnabled_ { ((renderSystemDesc.flags & RenderSystemFlags::DebugDevice) != 0) }
+    instance_           { vkDestroyInstance                                                   },
+    debugLayerEnabled_  { ((renderSystemDesc.flags & RenderSystemFlags::DebugDevice) != 0)    },
+    breadcrumbsEnabled_ { ((renderSystemDesc.flags & RenderSystemFlags::GPUBreadcrumbs) != 0) },
+    headless_           { ((renderSystemDesc.flags & RenderSystemFlags::Headless) != 0)       }
 {
     /* Extract optional renderer configuartion */
     auto rendererConfigVK = GetRendererConfiguration<RendererConfigurationVulkan>(renderSystemDesc);
 
     /* Create Vulkan instance and device objects */
     CreateInstance(rendererConfigVK);
-    PickPhysicalDevice();
+    PickPhysicalDevice(renderSystemDesc);
     CreateLogicalDevice();
 
+    /* Select tuning profile by the vendor of the physical device before any command buffer is created */
+    device_.SetTuningProfile(GetVKTuningProfile(physicalDevice_, rendererConfigVK));
+
     /* Create default resources */
     VKPipelineLayout::CreateDefault(device_);
 
@@ -55,12 +87,64 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
         (rendererConfigVK != nullptr ? rendererConfigVK->minDeviceMemoryAllocationSize : 1024*1024),
         (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false)
     );
+
+    /* Create command queues after the device memory manager, which they need to release the memory of unbound sparse tiles */
+    CreateCommandQueues();
+
+    /* Create staging ring for deferred uploads (if enabled) */
+    if (rendererConfigVK != nullptr && rendererConfigVK->deferredUploadRingSize > 0)
+    {
+        stagingRing_ = MakeUnique<VKStagingRing>(
+            device_,
+            physicalDevice_.GetMemoryProperties(),
+            static_cast<VkDeviceSize>(rendererConfigVK->deferredUploadRingSize)
+        );
+        device_.SetStagingRing(stagingRing_.get());
+    }
+
+    /* Create device-wide pipeline cache that is shared by all PSOs */
+    pipelineCache_ = MakeUnique<VKPipelineCache>(
+        device_,
+        physicalDevice_.GetProperties(),
+        (rendererConfigVK != nullptr ? rendererConfigVK->pipelineCacheData.data() : nullptr),
+        (rendererConfigVK != nullptr ? rendererConfigVK->pipelineCacheData.size() : 0)
+    );
+
+    /* Create compute pipelines for MIP-map generation (if enabled) */
+    VKMipGenerator::Get().InitializeDevice(
+        device_,
+        physicalDevice_,
+        pipelineCache_->GetNative(),
+        (rendererConfigVK != nullptr ? rendererConfigVK->computeMipGeneration : false)
+    );
+
+    /* Create compute pipelines for texture compression and report whether they are available */
+    VKTextureCompressor::Get().InitializeDevice(device_, physicalDevice_, pipelineCache_->GetNative());
+
+    /* Create compute pipeline for indirect argument compaction and report whether it is available */
+    VKIndirectArgumentCompactor::Get().InitializeDevice(device_, pipelineCache_->GetNative());
+
+    /* Enable host image copies for texture uploads (if supported) */
+    VKHostImageCopy::Get().InitializeDevice(device_, physicalDevice_);
+
+    RenderingCapabilities caps = GetRenderingCaps();
+    caps.features.hasTextureCompression = VKTextureCompressor::Get().IsAvailable();
+    caps.features.hasIndirectArgumentCompaction = VKIndirectArgumentCompactor::Get().IsAvailable();
+    SetRenderingCaps(caps);
 }
 
 VKRenderSystem::~VKRenderSystem()
 {
     device_.WaitIdle();
+    device_.SetStagingRing(nullptr);
+    stagingRing_.reset();
+    VKMipGenerator::Get().Clear();
+    VKTextureCompressor::Get().Clear();
+    VKIndirectArgumentCompactor::Get().Clear();
+    VKHostImageCopy::Get().Clear();
+    pipelineCache_.reset();
     VKShaderModulePool::Get().Clear();
+    VKPipelinePool::Get().Clear();
     VKPipelineLayout::ReleaseDefault();
 }
 
@@ -68,6 +152,8 @@ VKRenderSystem::~VKRenderSystem()
 
 SwapChain* VKRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
 {
+    if (headless_)
+        LLGL_TRAP("cannot create swap-chain for headless Vulkan render system");
     return swapChains_.emplace<VKSwapChain>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, swapChainDesc, surface);
 }
 
@@ -78,8 +164,25 @@ void VKRenderSystem::Release(SwapChain& swapChain)
 
 /* ----- Command queues ----- */
 
-CommandQueue* VKRenderSystem::GetCommandQueue()
+CommandQueue* VKRenderSystem::GetCommandQueue(const CommandQueueType type)
 {
+    switch (type)
+    {
+        case CommandQueueType::Compute:
+            if (computeQueue_)
+                return computeQueue_.get();
+            break;
+
+        case CommandQueueType::Copy:
+            if (copyQueue_)
+                return copyQueue_.get();
+            if (computeQueue_ && device_.GetVkQueue(CommandQueueType::Copy) == device_.GetVkQueue(CommandQueueType::Compute))
+                return computeQueue_.get();
+            break;
+
+        default:
+            break;
+    }
     return commandQueue_.get();
 }
 
@@ -87,7 +190,14 @@ CommandQueue* VKRenderSystem::GetCommandQueue()
 
 CommandBuffer* VKRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
-    return commandBuffers_.emplace<VKCommandBuffer>(physicalDevice_, device_, device_.GetVkQueue(), device_.GetQueueFamilyIndices(), commandBufferDesc);
+    return commandBuffers_.emplace<VKCommandBuffer>(
+        physicalDevice_,
+        device_,
+        device_.GetVkQueue(commandBufferDesc.queueType),
+        device_.GetQueueFamily(commandBufferDesc.queueType),
+        commandBufferDesc,
+        (breadcrumbsEnabled_ && HasExtension(VKExt::AMD_buffer_marker))
+    );
 }
 
 void VKRenderSystem::Release(CommandBuffer& commandBuffer)
@@ -109,6 +219,24 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const v
 {
     RenderSystem::AssertCreateBuffer(bufferDesc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
 
+    if ((bufferDesc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        /* Sparse buffers have neither initial data nor CPU access; their memory is bound per tile via UpdateTileMappings */
+        VKBuffer* bufferVK = buffers_.emplace<VKBuffer>(device_, bufferDesc);
+        bufferVK->CreateSparseTileMap(*deviceMemoryMngr_);
+        return bufferVK;
+    }
+
+    if (IsHostVisibleBuffer(bufferDesc))
+    {
+        /* Host-visible buffers are initialized and mapped directly, so they don't need a staging buffer */
+        VKBuffer* bufferVK = buffers_.emplace<VKBuffer>(device_, bufferDesc);
+        bufferVK->BindMemoryRegion(device_, AllocateBufferMemory(*bufferVK));
+        if (initialData != nullptr)
+            device_.WriteBuffer(bufferVK->GetDeviceBuffer(), initialData, static_cast<VkDeviceSize>(bufferDesc.size));
+        return bufferVK;
+    }
+
     /* Create staging buffer */
     VkBufferCreateInfo stagingCreateInfo;
     BuildVkBufferCreateInfo(
@@ -123,11 +251,7 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const v
     VKBuffer* bufferVK = buffers_.emplace<VKBuffer>(device_, bufferDesc);
 
     /* Allocate device memory */
-    VKDeviceMemoryRegion* memoryRegion = deviceMemoryMngr_->Allocate(
-        bufferVK->GetDeviceBuffer().GetRequirements(),
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-    );
-    bufferVK->BindMemoryRegion(device_, memoryRegion);
+    bufferVK->BindMemoryRegion(device_, AllocateBufferMemory(*bufferVK));
 
     /* Copy staging buffer into hardware buffer */
     device_.CopyBuffer(stagingBuffer.GetVkBuffer(), bufferVK->GetVkBuffer(), static_cast<VkDeviceSize>(bufferDesc.size));
@@ -146,6 +270,110 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const v
     return bufferVK;
 }
 
+void VKRenderSystem::CreateBuffers(std::uint32_t numBuffers, const BufferDescriptor* bufferDescs, const void* const * initialData, Buffer** outBuffers)
+{
+    RenderSystem::AssertCreateBuffers(numBuffers, bufferDescs, outBuffers);
+
+    struct BufferUpload
+    {
+        VKBuffer*       dstBuffer;
+        VkBuffer        srcBuffer;  // Null handle to copy from the shared staging buffer
+        VkDeviceSize    srcOffset;
+        VkDeviceSize    size;
+        const void*     data;
+    };
+
+    std::vector<BufferUpload> uploads;
+    uploads.reserve(numBuffers);
+
+    /* Create all buffers and determine the layout of their initial data within a single shared staging buffer */
+    VkDeviceSize stagingSize = 0;
+
+    for_range(i, numBuffers)
+    {
+        const BufferDescriptor& bufferDesc  = bufferDescs[i];
+        const void*             data        = (initialData != nullptr ? initialData[i] : nullptr);
+        const VkDeviceSize      size        = static_cast<VkDeviceSize>(bufferDesc.size);
+
+        RenderSystem::AssertCreateBuffer(bufferDesc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
+
+        VKBuffer* bufferVK = buffers_.emplace<VKBuffer>(device_, bufferDesc);
+        outBuffers[i] = bufferVK;
+
+        if ((bufferDesc.miscFlags & MiscFlags::Sparse) != 0)
+        {
+            /* Sparse buffers have neither initial data nor CPU access; their memory is bound per tile via UpdateTileMappings */
+            bufferVK->CreateSparseTileMap(*deviceMemoryMngr_);
+            continue;
+        }
+
+        /* Sub-allocate device memory */
+        bufferVK->BindMemoryRegion(device_, AllocateBufferMemory(*bufferVK));
+
+        if (bufferVK->IsHostVisible())
+        {
+            /* Host-visible buffers are initialized directly, so they neither need a staging buffer nor a copy command */
+            if (data != nullptr)
+                device_.WriteBuffer(bufferVK->GetDeviceBuffer(), data, size);
+        }
+        else if (bufferDesc.cpuAccessFlags != 0 || (bufferDesc.miscFlags & MiscFlags::DynamicUsage) != 0)
+        {
+            /* Buffers with CPU access keep their own staging buffer, so initialize it right away and copy from there */
+            VkBufferCreateInfo stagingCreateInfo;
+            BuildVkBufferCreateInfo(stagingCreateInfo, size, GetStagingVkBufferUsageFlags(bufferDesc.cpuAccessFlags));
+            bufferVK->TakeStagingBuffer(CreateStagingBufferAndInitialize(stagingCreateInfo, data, size));
+            if (data != nullptr)
+                uploads.push_back(BufferUpload{ bufferVK, bufferVK->GetStagingVkBuffer(), 0, size, nullptr });
+        }
+        else if (data != nullptr)
+        {
+            const VkDeviceSize srcOffset = GetAlignedSize<VkDeviceSize>(stagingSize, 16u);
+            uploads.push_back(BufferUpload{ bufferVK, VK_NULL_HANDLE, srcOffset, size, data });
+            stagingSize = srcOffset + size;
+        }
+    }
+
+    if (uploads.empty())
+        return;
+
+    /* Copy initial data of all buffers into the shared staging buffer with a single mapping */
+    VKDeviceBuffer stagingBuffer{ device_ };
+
+    if (stagingSize > 0)
+    {
+        VkBufferCreateInfo stagingCreateInfo;
+        BuildVkBufferCreateInfo(stagingCreateInfo, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        stagingBuffer = CreateStagingBuffer(stagingCreateInfo);
+
+        if (char* mappedData = static_cast<char*>(stagingBuffer.Map(device_)))
+        {
+            for (const BufferUpload& upload : uploads)
+            {
+                if (upload.data != nullptr)
+                    ::memcpy(mappedData + upload.srcOffset, upload.data, static_cast<std::size_t>(upload.size));
+            }
+            stagingBuffer.Unmap(device_);
+        }
+    }
+
+    /* Record all copy commands into a single command buffer and wait for a single fence */
+    {
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+        VkCommandBuffer cmdBuffer = device_.AllocCommandBuffer();
+        {
+            for (const BufferUpload& upload : uploads)
+            {
+                VkBuffer srcBuffer = (upload.srcBuffer != VK_NULL_HANDLE ? upload.srcBuffer : stagingBuffer.GetVkBuffer());
+                device_.CopyBuffer(cmdBuffer, srcBuffer, upload.dstBuffer->GetVkBuffer(), upload.size, upload.srcOffset, 0);
+            }
+        }
+        device_.FlushCommandBuffer(cmdBuffer);
+    }
+
+    /* Release shared staging buffer */
+    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+}
+
 BufferArray* VKRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
     RenderSystem::AssertCreateBufferArray(numBuffers, bufferArray);
@@ -156,6 +384,7 @@ void VKRenderSystem::Release(Buffer& buffer)
 {
     /* Release device memory regions for primary buffer and internal staging buffer, then release buffer object */
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    WaitForPendingUploads();
     bufferVK.GetDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
     bufferVK.GetStagingDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
     buffers_.erase(&buffer);
@@ -170,7 +399,17 @@ void VKRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const voi
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
-    if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
+    if (bufferVK.IsHostVisible())
+    {
+        /* Copy input data directly into host-visible buffer memory */
+        device_.WriteBuffer(bufferVK.GetDeviceBuffer(), data, dataSize, offset);
+    }
+    else if (stagingRing_ && stagingRing_->Fits(dataSize))
+    {
+        /* Copy input data into staging ring and defer copy command until next queue submission */
+        stagingRing_->WriteBuffer(bufferVK.GetVkBuffer(), offset, data, dataSize);
+    }
+    else if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
     {
         /* Copy input data to staging buffer memory */
         device_.WriteBuffer(bufferVK.GetStagingDeviceBuffer(), data, dataSize, offset);
@@ -202,7 +441,12 @@ void VKRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
-    if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
+    if (bufferVK.IsHostVisible())
+    {
+        /* Copy host-visible buffer memory directly to output data */
+        device_.ReadBuffer(bufferVK.GetDeviceBuffer(), data, dataSize, offset);
+    }
+    else if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
     {
         /* Copy hardware buffer into staging buffer */
         device_.CopyBuffer(bufferVK.GetVkBuffer(), bufferVK.GetStagingVkBuffer(), dataSize, offset, offset);
@@ -255,62 +499,25 @@ void VKRenderSystem::UnmapBuffer(Buffer& buffer)
 
 Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
-    /* Determine size of image for staging buffer */
-    const std::uint32_t imageSize       = NumMipTexels(textureDesc, 0);
-    const std::size_t   initialDataSize = GetMemoryFootprint(textureDesc.format, imageSize);
-
     /* Set up initial image data */
-    const void* initialData = nullptr;
     ByteBuffer intermediateData;
-
-    if (imageDesc)
-    {
-        /* Check if image data must be converted */
-        const auto& formatAttribs = GetFormatAttribs(textureDesc.format);
-        if (formatAttribs.bitSize > 0 && (formatAttribs.flags & FormatFlags::IsCompressed) == 0)
-        {
-            /* Convert image format (will be null if no conversion is necessary) */
-            intermediateData = ConvertImageBuffer(*imageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
-        }
-
-        if (intermediateData)
-        {
-            /*
-            Validate that source image data was large enough so conversion is valid,
-            then use temporary image buffer as source for initial data
-            */
-            const std::size_t srcImageDataSize = GetMemoryFootprint(imageDesc->format, imageDesc->dataType, imageSize);
-            RenderSystem::AssertImageDataSize(imageDesc->dataSize, srcImageDataSize);
-            initialData = intermediateData.get();
-        }
-        else
-        {
-            /*
-            Validate that image data is large enough,
-            then use input data as source for initial data
-            */
-            RenderSystem::AssertImageDataSize(imageDesc->dataSize, initialDataSize);
-            initialData = imageDesc->data;
-        }
-    }
-    else if ((textureDesc.miscFlags & MiscFlags::NoInitialData) == 0)
-    {
-        /* Allocate default image data */
-        const auto& formatAttribs = GetFormatAttribs(textureDesc.format);
-        if (formatAttribs.bitSize > 0 && (formatAttribs.flags & FormatFlags::IsCompressed) == 0)
-            intermediateData = GenerateImageBuffer(formatAttribs.format, formatAttribs.dataType, imageSize, textureDesc.clearValue.color);
-        else
-            intermediateData = AllocateByteBuffer(initialDataSize, UninitializeTag{});
-
-        initialData = intermediateData.get();
-    }
+    const void* initialData = GetInitialTextureData(textureDesc, imageDesc, intermediateData);
 
     /* Create device texture */
     VKTexture* textureVK = textures_.emplace<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
 
-    if (initialData != nullptr)
+    /* Sparse textures have no initial data; only their MIP tail is bound to device memory when they are created */
+    if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0)
+        textureVK->BindSparseMipTail(*commandQueue_);
+
+    const bool generateMips = (imageDesc != nullptr && MustGenerateMipsOnCreate(textureDesc));
+
+    /* Copy initial data on the host if possible; otherwise, upload it with a staging buffer */
+    if (initialData != nullptr && (generateMips || !WriteInitialTextureDataOnHost(*textureVK, textureDesc, initialData)))
     {
         /* Create staging buffer */
+        const std::size_t initialDataSize = GetMemoryFootprint(textureDesc.format, NumMipTexels(textureDesc, 0));
+
         VkBufferCreateInfo stagingCreateInfo;
         BuildVkBufferCreateInfo(
             stagingCreateInfo,
@@ -321,35 +528,10 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
         VKDeviceBuffer stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, initialData, initialDataSize);
 
         /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
         VkCommandBuffer cmdBuffer = device_.AllocCommandBuffer();
         {
-            const TextureSubresource subresource{ 0, textureVK->GetNumArrayLayers(), 0, textureVK->GetNumMipLevels() };
-
-            textureVK->TransitionImageLayout(device_, cmdBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-            device_.CopyBufferToImage(
-                cmdBuffer,
-                stagingBuffer.GetVkBuffer(),
-                textureVK->GetVkImage(),
-                textureVK->GetVkFormat(),
-                VkOffset3D{ 0, 0, 0 },
-                textureVK->GetVkExtent(),
-                subresource
-            );
-
-            textureVK->TransitionImageLayout(device_, cmdBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-            /* Generate MIP-maps if enabled */
-            if (imageDesc != nullptr && MustGenerateMipsOnCreate(textureDesc))
-            {
-                device_.GenerateMips(
-                    cmdBuffer,
-                    textureVK->GetVkImage(),
-                    textureVK->GetVkFormat(),
-                    textureVK->GetVkExtent(),
-                    subresource
-                );
-            }
+            RecordInitialTextureUpload(cmdBuffer, *textureVK, stagingBuffer.GetVkBuffer(), 0, generateMips);
         }
         device_.FlushCommandBuffer(cmdBuffer);
 
@@ -363,16 +545,107 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     return textureVK;
 }
 
+void VKRenderSystem::CreateTextures(std::uint32_t numTextures, const TextureDescriptor* textureDescs, const SrcImageDescriptor* const * imageDescs, Texture** outTextures)
+{
+    RenderSystem::AssertCreateTextures(numTextures, textureDescs, outTextures);
+
+    std::vector<VKTexture*>     texturesVK(numTextures, nullptr);
+    std::vector<ByteBuffer>     intermediateData(numTextures);
+    std::vector<const void*>    initialData(numTextures, nullptr);
+    std::vector<VkDeviceSize>   stagingOffsets(numTextures, 0);
+    std::vector<VkDeviceSize>   stagingSizes(numTextures, 0);
+
+    /* Create all textures and determine the layout of their initial data within a single shared staging buffer */
+    VkDeviceSize stagingSize = 0;
+
+    for_range(i, numTextures)
+    {
+        const TextureDescriptor&    textureDesc = textureDescs[i];
+        const SrcImageDescriptor*   imageDesc   = (imageDescs != nullptr ? imageDescs[i] : nullptr);
+
+        initialData[i] = GetInitialTextureData(textureDesc, imageDesc, intermediateData[i]);
+
+        texturesVK[i] = textures_.emplace<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
+        outTextures[i] = texturesVK[i];
+
+        if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0)
+            texturesVK[i]->BindSparseMipTail(*commandQueue_);
+
+        /* Copy initial data on the host if possible, so this texture does not need any space in the shared staging buffer */
+        if (initialData[i] != nullptr && !(imageDesc != nullptr && MustGenerateMipsOnCreate(textureDesc)))
+        {
+            if (WriteInitialTextureDataOnHost(*texturesVK[i], textureDesc, initialData[i]))
+                initialData[i] = nullptr;
+        }
+
+        if (initialData[i] != nullptr)
+        {
+            /* Buffer offset for image copies must be a multiple of both 4 and the texel block size */
+            const VkDeviceSize blockSize = std::max<VkDeviceSize>(1u, GetFormatAttribs(textureDesc.format).bitSize / 8u);
+            stagingOffsets[i]   = GetAlignedSize<VkDeviceSize>(stagingSize, blockSize * 4u);
+            stagingSizes[i]     = static_cast<VkDeviceSize>(GetMemoryFootprint(textureDesc.format, NumMipTexels(textureDesc, 0)));
+            stagingSize         = stagingOffsets[i] + stagingSizes[i];
+        }
+    }
+
+    if (stagingSize > 0)
+    {
+        /* Copy initial data of all textures into the shared staging buffer with a single mapping */
+        VkBufferCreateInfo stagingCreateInfo;
+        BuildVkBufferCreateInfo(stagingCreateInfo, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        VKDeviceBuffer stagingBuffer = CreateStagingBuffer(stagingCreateInfo);
+
+        if (char* mappedData = static_cast<char*>(stagingBuffer.Map(device_)))
+        {
+            for_range(i, numTextures)
+            {
+                if (initialData[i] != nullptr)
+                    ::memcpy(mappedData + stagingOffsets[i], initialData[i], static_cast<std::size_t>(stagingSizes[i]));
+            }
+            stagingBuffer.Unmap(device_);
+        }
+
+        /* Intermediate image data is no longer needed once it has been copied into the staging buffer */
+        intermediateData.clear();
+
+        /* Record all uploads and MIP-map generations into a single command buffer and wait for a single fence */
+        {
+            std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+            VkCommandBuffer cmdBuffer = device_.AllocCommandBuffer();
+            {
+                for_range(i, numTextures)
+                {
+                    if (initialData[i] == nullptr)
+                        continue;
+                    const bool generateMips = (imageDescs != nullptr && imageDescs[i] != nullptr && MustGenerateMipsOnCreate(textureDescs[i]));
+                    RecordInitialTextureUpload(cmdBuffer, *texturesVK[i], stagingBuffer.GetVkBuffer(), stagingOffsets[i], generateMips);
+                }
+            }
+            device_.FlushCommandBuffer(cmdBuffer);
+        }
+
+        /* Release shared staging buffer */
+        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    }
+
+    /* Create image views for all textures */
+    for (VKTexture* textureVK : texturesVK)
+        textureVK->CreateInternalImageView(device_);
+}
+
 void VKRenderSystem::Release(Texture& texture)
 {
     /* Release device memory region, then release texture object */
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
+    WaitForPendingUploads();
     deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
     textures_.erase(&texture);
 }
 
 void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("WriteTexture");
+
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
 
     /* Determine size of image for staging buffer */
@@ -416,6 +689,41 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
         imageData = imageDesc.data;
     }
 
+    if (stagingRing_ && stagingRing_->Fits(imageDataSize))
+    {
+        /* Copy image data into staging ring; buffer offset must be a multiple of both 4 and the texel block size */
+        const VkDeviceSize blockSize = std::max<VkDeviceSize>(1u, formatAttribs.bitSize / 8u);
+        stagingRing_->WriteImage(
+            textureVK,
+            VkOffset3D{ offset.x, offset.y, offset.z },
+            VkExtent3D{ extent.width, extent.height, extent.depth },
+            subresource,
+            imageData,
+            imageDataSize,
+            blockSize * 4u
+        );
+        return;
+    }
+
+    if (VKHostImageCopy::Get().IsPreferred(textureVK, imageDataSize))
+    {
+        /*
+        Copy image data on the host without a staging buffer and queue submission.
+        The image must not be in use by the device, so wait for all previous work that may still access it.
+        */
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+        device_.FlushPendingUploads();
+        vkQueueWaitIdle(device_.GetVkQueue());
+        VKHostImageCopy::Get().CopyMemoryToImage(
+            textureVK,
+            imageData,
+            VkOffset3D{ offset.x, offset.y, offset.z },
+            VkExtent3D{ extent.width, extent.height, extent.depth },
+            subresource
+        );
+        return;
+    }
+
     /* Create staging buffer */
     VkBufferCreateInfo stagingCreateInfo;
     BuildVkBufferCreateInfo(
@@ -427,6 +735,7 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
     VKDeviceBuffer stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, imageData, imageDataSize);
 
     /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
     VkCommandBuffer cmdBuffer = device_.AllocCommandBuffer();
     {
         VkImageLayout oldLayout = textureVK.TransitionImageLayout(device_, cmdBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresource);
@@ -470,6 +779,7 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
     VKDeviceBuffer stagingBuffer = CreateStagingBuffer(stagingCreateInfo);
 
     /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
     VkCommandBuffer cmdBuffer = device_.AllocCommandBuffer();
     {
         VkImageLayout oldLayout = textureVK.TransitionImageLayout(device_, cmdBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, subresource);
@@ -510,7 +820,7 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
 
 Sampler* VKRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    return samplers_.emplace<VKSampler>(device_, samplerDesc);
+    return samplers_.emplace<VKSampler>(device_, samplerCache_, samplerDesc);
 }
 
 void VKRenderSystem::Release(Sampler& sampler)
@@ -552,7 +862,7 @@ void VKRenderSystem::Release(RenderPass& renderPass)
 
 RenderTarget* VKRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& renderTargetDesc)
 {
-    return renderTargets_.emplace<VKRenderTarget>(device_, *deviceMemoryMngr_, renderTargetDesc);
+    return renderTargets_.emplace<VKRenderTarget>(device_, *deviceMemoryMngr_, renderTargetDesc, GetRenderingCaps().limits.shadingRateImageTileSize);
 }
 
 void VKRenderSystem::Release(RenderTarget& renderTarget)
@@ -564,6 +874,8 @@ void VKRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* VKRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateShader");
+
     RenderSystem::AssertCreateShader(shaderDesc);
     return shaders_.emplace<VKShader>(device_, shaderDesc);
 }
@@ -577,7 +889,7 @@ void VKRenderSystem::Release(Shader& shader)
 
 PipelineLayout* VKRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& pipelineLayoutDesc)
 {
-    return pipelineLayouts_.emplace<VKPipelineLayout>(device_, pipelineLayoutDesc);
+    return pipelineLayouts_.emplace<VKPipelineLayout>(device_, pipelineLayoutDesc, physicalDevice_.GetDescriptorIndexingFeatures());
 }
 
 void VKRenderSystem::Release(PipelineLayout& pipelineLayout)
@@ -594,17 +906,51 @@ PipelineState* VKRenderSystem::CreatePipelineState(const Blob& /*serializedCache
 
 PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
 {
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineState");
+
     return pipelineStates_.emplace<VKGraphicsPSO>(
         device_,
         (!swapChains_.empty() ? (*swapChains_.begin())->GetRenderPass() : nullptr),
         pipelineStateDesc,
-        gfxPipelineLimits_
+        gfxPipelineLimits_,
+        pipelineCache_->GetNative()
     );
 }
 
 PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, Blob* /*serializedCache*/)
 {
-    return pipelineStates_.emplace<VKComputePSO>(device_, pipelineStateDesc);
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineState");
+
+    return pipelineStates_.emplace<VKComputePSO>(device_, pipelineStateDesc, physicalDevice_.HasSubgroupSizeControl(), pipelineCache_->GetNative());
+}
+
+PipelineState* VKRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState)
+{
+    LLGL_HOST_TRACE_SCOPE("CreateGraphicsPipelineStateAsync");
+
+    return pipelineStates_.emplace<VKGraphicsPSO>(
+        device_,
+        (!swapChains_.empty() ? (*swapChains_.begin())->GetRenderPass() : nullptr),
+        pipelineStateDesc,
+        gfxPipelineLimits_,
+        pipelineCache_->GetNative(),
+        /*isAsync:*/ true,
+        fallbackPipelineState
+    );
+}
+
+PipelineState* VKRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, PipelineState* fallbackPipelineState)
+{
+    LLGL_HOST_TRACE_SCOPE("CreateComputePipelineStateAsync");
+
+    return pipelineStates_.emplace<VKComputePSO>(
+        device_,
+        pipelineStateDesc,
+        physicalDevice_.HasSubgroupSizeControl(),
+        pipelineCache_->GetNative(),
+        /*isAsync:*/ true,
+        fallbackPipelineState
+    );
 }
 
 void VKRenderSystem::Release(PipelineState& pipelineState)
@@ -619,7 +965,7 @@ QueryHeap* VKRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& queryHeapD
     if (queryHeapDesc.renderCondition)
         return queryHeaps_.emplace<VKPredicateQueryHeap>(device_, *deviceMemoryMngr_, queryHeapDesc);
     else
-        return queryHeaps_.emplace<VKQueryHeap>(device_, queryHeapDesc);
+        return queryHeaps_.emplace<VKQueryHeap>(device_, *deviceMemoryMngr_, queryHeapDesc, physicalDevice_.GetProperties().limits.timestampPeriod);
 }
 
 void VKRenderSystem::Release(QueryHeap& queryHeap)
@@ -627,11 +973,31 @@ void VKRenderSystem::Release(QueryHeap& queryHeap)
     queryHeaps_.erase(&queryHeap);
 }
 
+/* ----- Acceleration structures ----- */
+
+AccelerationStructure* VKRenderSystem::CreateAccelerationStructure(const AccelerationStructureDescriptor& accelerationStructureDesc)
+{
+    if (!physicalDevice_.HasRayTracing())
+        LLGL_TRAP_FEATURE_NOT_SUPPORTED("acceleration structures");
+    return accelStructs_.emplace<VKAccelerationStructure>(
+        device_,
+        *deviceMemoryMngr_,
+        physicalDevice_.GetAccelerationStructureProperties(),
+        accelerationStructureDesc
+    );
+}
+
+void VKRenderSystem::Release(AccelerationStructure& accelerationStructure)
+{
+    accelStructs_.erase(&accelerationStructure);
+}
+
 /* ----- Fences ----- */
 
 Fence* VKRenderSystem::CreateFence()
 {
-    return fences_.emplace<VKFence>(device_);
+    const bool timeline = HasExtension(VKExt::KHR_timeline_semaphore);
+    return fences_.emplace<VKFence>(device_, timeline, (timeline && VKIsExternalSemaphoreSupported()));
 }
 
 void VKRenderSystem::Release(Fence& fence)
@@ -657,6 +1023,102 @@ bool VKRenderSystem::GetNativeHandle(void* nativeHandle, std::size_t nativeHandl
     return false;
 }
 
+std::uint64_t VKRenderSystem::ReleaseRetainedMemory(std::uint64_t budget)
+{
+    return deviceMemoryMngr_->ReleaseRetainedChunks(budget);
+}
+
+bool VKRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStatistics)
+{
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = physicalDevice_.GetMemoryProperties();
+
+    /* Query budget and usage from the OS if VK_EXT_memory_budget is supported */
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+    const bool hasBudget = physicalDevice_.QueryMemoryBudget(budgetProperties);
+
+    outStatistics.heaps.clear();
+    outStatistics.heaps.resize(memoryProperties.memoryHeapCount);
+
+    for_range(i, memoryProperties.memoryHeapCount)
+    {
+        const VKDeviceMemoryDetails details = deviceMemoryMngr_->QueryHeapDetails(i);
+
+        MemoryHeapStatistics& heap = outStatistics.heaps[i];
+        {
+            heap.deviceLocal    = ((memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0);
+            heap.allocatedSize  = details.totalSize;
+            heap.usedSize       = details.allocatedSize;
+            heap.numChunks      = static_cast<std::uint32_t>(details.numChunks);
+            if (hasBudget)
+            {
+                heap.budget     = budgetProperties.heapBudget[i];
+                heap.usage      = budgetProperties.heapUsage[i];
+            }
+        }
+    }
+
+    return true;
+}
+
+bool VKRenderSystem::SetMemoryPriority(Resource& resource, float priority)
+{
+    VKDeviceMemoryRegion* memoryRegion = nullptr;
+
+    if (resource.GetResourceType() == ResourceType::Buffer)
+        memoryRegion = LLGL_CAST(VKBuffer&, resource).GetDeviceBuffer().GetMemoryRegion();
+    else if (resource.GetResourceType() == ResourceType::Texture)
+        memoryRegion = LLGL_CAST(VKTexture&, resource).GetMemoryRegion();
+
+    /* Sparse textures are not bound to a single memory region */
+    if (memoryRegion == nullptr)
+        return false;
+
+    return deviceMemoryMngr_->SetPriority(memoryRegion, Clamp(priority, 0.0f, 1.0f));
+}
+
+Blob VKRenderSystem::GetPipelineCache()
+{
+    std::vector<char> data(pipelineCache_->GetDataSize());
+    data.resize(pipelineCache_->GetData(data.data(), data.size()));
+    return Blob::CreateStrongRef(std::move(data));
+}
+
+bool VKRenderSystem::ExportMemoryHandle(Resource& resource, ExternalHandle& outHandle)
+{
+    VKDeviceMemoryRegion* memoryRegion = nullptr;
+
+    if (resource.GetResourceType() == ResourceType::Buffer)
+    {
+        auto& bufferVK = LLGL_CAST(VKBuffer&, resource);
+        if (bufferVK.IsExportable())
+            memoryRegion = bufferVK.GetDeviceBuffer().GetMemoryRegion();
+    }
+    else if (resource.GetResourceType() == ResourceType::Texture)
+    {
+        auto& textureVK = LLGL_CAST(VKTexture&, resource);
+        if (textureVK.IsExportable())
+            memoryRegion = textureVK.GetMemoryRegion();
+    }
+
+    if (memoryRegion == nullptr)
+        return false;
+
+    /* Export the entire dedicated chunk, which only contains this resource */
+    VKDeviceMemory* chunk = memoryRegion->GetParentChunk();
+    return VKExportMemoryHandle(device_, chunk->GetVkDeviceMemory(), chunk->GetSize(), outHandle);
+}
+
+bool VKRenderSystem::ExportFenceHandle(Fence& fence, ExternalHandle& outHandle)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    return VKExportSemaphoreHandle(device_, fenceVK.GetVkSemaphore(), outHandle);
+}
+
+bool VKRenderSystem::SubmitFileLoads(const ArrayView<FileLoadDescriptor>& loads, Fence* fence)
+{
+    return SubmitFileLoadsEmulated(*this, loads, fence);
+}
+
 
 /*
  * ======= Private: =======
@@ -682,11 +1144,12 @@ void VKRenderSystem::CreateInstance(const RendererConfigurationVulkan* config)
     auto extensionProperties = VKQueryInstanceExtensionProperties();
     std::vector<const char*> extensionNames;
 
+    /* Required extensions are only the surface extensions, which are omitted for headless render systems */
     auto IsVKExtSupportIncluded = [this](VKExtSupport extSupport)
     {
         return
         (
-            extSupport == VKExtSupport::Required ||
+            (!this->headless_ && extSupport == VKExtSupport::Required) ||
             extSupport == VKExtSupport::Optional ||
             (this->debugLayerEnabled_ && extSupport == VKExtSupport::DebugOnly)
         );
@@ -823,10 +1286,25 @@ void VKRenderSystem::CreateDebugReportCallback()
     VKThrowIfFailed(result, "failed to create Vulkan debug report callback");
 }
 
-void VKRenderSystem::PickPhysicalDevice()
+void VKRenderSystem::PickPhysicalDevice(const RenderSystemDescriptor& renderSystemDesc)
 {
-    /* Pick physical device with Vulkan support */
-    if (!physicalDevice_.PickPhysicalDevice(instance_))
+    /* Enumerate all physical devices as video adapters */
+    const std::vector<VkPhysicalDevice> physicalDevices = VKQueryPhysicalDevices(instance_);
+
+    std::vector<VideoAdapterDescriptor> videoAdapters;
+    videoAdapters.reserve(physicalDevices.size());
+
+    for (VkPhysicalDevice device : physicalDevices)
+        videoAdapters.push_back(VKGetVideoAdapterDesc(instance_, device));
+
+    /* Pick explicitly selected physical device or the first one with Vulkan support */
+    const std::uint32_t selectedAdapter = FindSelectedVideoAdapter(renderSystemDesc, videoAdapters);
+    if (selectedAdapter != Constants::defaultAdapter)
+    {
+        if (!physicalDevice_.PickPhysicalDevice(instance_, ArrayView<VkPhysicalDevice>(&physicalDevices[selectedAdapter], 1), headless_))
+            LLGL_TRAP("selected Vulkan device is not suitable: %s", ToUTF8String(videoAdapters[selectedAdapter].name).c_str());
+    }
+    else if (!physicalDevice_.PickPhysicalDevice(instance_, physicalDevices, headless_))
         throw std::runtime_error("failed to find suitable Vulkan device");
 
     /* Query and store rendering capabilities */
@@ -835,6 +1313,11 @@ void VKRenderSystem::PickPhysicalDevice()
 
     physicalDevice_.QueryDeviceProperties(info, caps, gfxPipelineLimits_);
 
+    /* Store all video adapters and the index of the picked one */
+    const auto pickedDeviceIt = std::find(physicalDevices.begin(), physicalDevices.end(), physicalDevice_.GetVkPhysicalDevice());
+    info.videoAdapters  = std::move(videoAdapters);
+    info.adapterIndex   = static_cast<std::uint32_t>(std::distance(physicalDevices.begin(), pickedDeviceIt));
+
     /* Store Vulkan extension names */
     const auto& extensions = physicalDevice_.GetExtensionNames();
     info.extensionNames = std::vector<std::string>(extensions.begin(), extensions.end());
@@ -848,13 +1331,30 @@ void VKRenderSystem::CreateLogicalDevice()
     /* Create logical device with all supported physical device feature */
     device_ = physicalDevice_.CreateLogicalDevice();
 
-    /* Create command queue interface */
-    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue());
-
     /* Load Vulkan device extensions */
     VKLoadDeviceExtensions(device_, physicalDevice_.GetExtensionNames());
 }
 
+void VKRenderSystem::CreateCommandQueues()
+{
+    /* Create command queue interfaces; compute and copy queues are only created for dedicated queue families */
+    commandQueue_ = MakeUnique<VKCommandQueue>(physicalDevice_, device_, device_.GetVkQueue(), *deviceMemoryMngr_);
+
+    VkQueue computeQueue = device_.GetVkQueue(CommandQueueType::Compute);
+    if (computeQueue != device_.GetVkQueue())
+        computeQueue_ = MakeUnique<VKCommandQueue>(physicalDevice_, device_, computeQueue, *deviceMemoryMngr_);
+
+    VkQueue transferQueue = device_.GetVkQueue(CommandQueueType::Copy);
+    if (transferQueue != device_.GetVkQueue() && transferQueue != computeQueue)
+        copyQueue_ = MakeUnique<VKCommandQueue>(physicalDevice_, device_, transferQueue, *deviceMemoryMngr_);
+}
+
+void VKRenderSystem::WaitForPendingUploads()
+{
+    if (stagingRing_ && !stagingRing_->IsIdle())
+        stagingRing_->WaitIdle();
+}
+
 bool VKRenderSystem::IsLayerRequired(const char* name, const RendererConfigurationVulkan* config) const
 {
     if (config != nullptr)
@@ -875,6 +1375,143 @@ bool VKRenderSystem::IsLayerRequired(const char* name, const RendererConfigurati
     return false;
 }
 
+const void* VKRenderSystem::GetInitialTextureData(
+    const TextureDescriptor&    textureDesc,
+    const SrcImageDescriptor*   imageDesc,
+    ByteBuffer&                 intermediateData)
+{
+    /* Transient textures cannot be written by transfer commands, so their initial data is ignored just like for sparse textures */
+    if ((textureDesc.miscFlags & (MiscFlags::Sparse | MiscFlags::Transient)) != 0)
+        return nullptr;
+
+    /* Determine size of image for staging buffer */
+    const std::uint32_t imageSize       = NumMipTexels(textureDesc, 0);
+    const std::size_t   initialDataSize = GetMemoryFootprint(textureDesc.format, imageSize);
+    const auto&         formatAttribs   = GetFormatAttribs(textureDesc.format);
+
+    if (imageDesc != nullptr)
+    {
+        /* Check if image data must be converted */
+        if (formatAttribs.bitSize > 0 && (formatAttribs.flags & FormatFlags::IsCompressed) == 0)
+        {
+            /* Convert image format (will be null if no conversion is necessary) */
+            intermediateData = ConvertImageBuffer(*imageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
+        }
+
+        if (intermediateData)
+        {
+            /*
+            Validate that source image data was large enough so conversion is valid,
+            then use temporary image buffer as source for initial data
+            */
+            const std::size_t srcImageDataSize = GetMemoryFootprint(imageDesc->format, imageDesc->dataType, imageSize);
+            RenderSystem::AssertImageDataSize(imageDesc->dataSize, srcImageDataSize);
+            return intermediateData.get();
+        }
+
+        /*
+        Validate that image data is large enough,
+        then use input data as source for initial data
+        */
+        RenderSystem::AssertImageDataSize(imageDesc->dataSize, initialDataSize);
+        return imageDesc->data;
+    }
+
+    if ((textureDesc.miscFlags & MiscFlags::NoInitialData) == 0)
+    {
+        /* Allocate default image data */
+        if (formatAttribs.bitSize > 0 && (formatAttribs.flags & FormatFlags::IsCompressed) == 0)
+            intermediateData = GenerateImageBuffer(formatAttribs.format, formatAttribs.dataType, imageSize, textureDesc.clearValue.color);
+        else
+            intermediateData = AllocateByteBuffer(initialDataSize, UninitializeTag{});
+        return intermediateData.get();
+    }
+
+    return nullptr;
+}
+
+bool VKRenderSystem::WriteInitialTextureDataOnHost(VKTexture& textureVK, const TextureDescriptor& textureDesc, const void* initialData)
+{
+    const VkDeviceSize initialDataSize = static_cast<VkDeviceSize>(GetMemoryFootprint(textureDesc.format, NumMipTexels(textureDesc, 0)));
+
+    if (!VKHostImageCopy::Get().IsPreferred(textureVK, initialDataSize))
+        return false;
+
+    /* New textures are not in use by the device yet, so they can be written on the host without synchronization */
+    VKHostImageCopy::Get().CopyMemoryToImage(
+        textureVK,
+        initialData,
+        VkOffset3D{ 0, 0, 0 },
+        textureVK.GetVkExtent(),
+        TextureSubresource{ 0, textureVK.GetNumArrayLayers(), 0, 1 }
+    );
+    return true;
+}
+
+void VKRenderSystem::RecordInitialTextureUpload(
+    VkCommandBuffer cmdBuffer,
+    VKTexture&      textureVK,
+    VkBuffer        stagingBuffer,
+    VkDeviceSize    stagingOffset,
+    bool            generateMips)
+{
+    const TextureSubresource subresource{ 0, textureVK.GetNumArrayLayers(), 0, textureVK.GetNumMipLevels() };
+
+    textureVK.TransitionImageLayout(device_, cmdBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+    device_.CopyBufferToImage(
+        cmdBuffer,
+        stagingBuffer,
+        textureVK.GetVkImage(),
+        textureVK.GetVkFormat(),
+        VkOffset3D{ 0, 0, 0 },
+        textureVK.GetVkExtent(),
+        subresource,
+        stagingOffset
+    );
+
+    textureVK.TransitionImageLayout(device_, cmdBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    /* Generate MIP-maps if enabled */
+    if (generateMips)
+    {
+        VKBarrierAccumulator barriers;
+        VKMipGenerator::Get().GenerateMips(device_, cmdBuffer, barriers, textureVK, subresource);
+        barriers.Flush(cmdBuffer);
+    }
+}
+
+VKDeviceMemoryRegion* VKRenderSystem::AllocateBufferMemory(const VKBuffer& bufferVK)
+{
+    const VkMemoryRequirements& requirements = bufferVK.GetDeviceBuffer().GetRequirements();
+    const VkMemoryPropertyFlags hostVisibleFlags = (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    if (bufferVK.IsReadback())
+    {
+        /* Prefer host-cached memory for readback buffers, since uncached memory is slow to read from */
+        if (deviceMemoryMngr_->HasMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_CACHED_BIT | hostVisibleFlags))
+            properties = (VK_MEMORY_PROPERTY_HOST_CACHED_BIT | hostVisibleFlags);
+        else
+            properties = hostVisibleFlags;
+    }
+    else if (bufferVK.IsHostVisible())
+    {
+        /* Prefer device-local memory that is also host-visible (UMA or resizable BAR), otherwise fall back to host-visible system memory */
+        if (deviceMemoryMngr_->HasMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | hostVisibleFlags))
+            properties = (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | hostVisibleFlags);
+        else
+            properties = hostVisibleFlags;
+    }
+
+    /* External buffers get their own device memory, so it can be exported without exposing any other resource */
+    if (bufferVK.IsExportable())
+        return deviceMemoryMngr_->AllocateExportable(requirements, properties, bufferVK.GetVkBuffer(), VK_NULL_HANDLE);
+
+    return deviceMemoryMngr_->Allocate(requirements, properties);
+}
+
 VKDeviceBuffer VKRenderSystem::CreateStagingBuffer(const VkBufferCreateInfo& createInfo)
 {
     return VKDeviceBuffer
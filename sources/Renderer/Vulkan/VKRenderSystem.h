@@ -21,6 +21,8 @@
 
 #include "Buffer/VKBuffer.h"
 #include "Buffer/VKBufferArray.h"
+#include "Buffer/VKStagingRing.h"
+#include "Buffer/VKAccelerationStructure.h"
 
 #include "Shader/VKShader.h"
 
@@ -33,6 +35,7 @@
 #include "RenderState/VKRenderPass.h"
 #include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKGraphicsPSO.h"
+#include "RenderState/VKPipelineCache.h"
 #include "RenderState/VKResourceHeap.h"
 
 #include <string>
@@ -62,11 +65,37 @@ class VKRenderSystem final : public RenderSystem
 
         void CreateInstance(const RendererConfigurationVulkan* config);
         void CreateDebugReportCallback();
-        void PickPhysicalDevice();
+        void PickPhysicalDevice(const RenderSystemDescriptor& renderSystemDesc);
         void CreateLogicalDevice();
+        void CreateCommandQueues();
 
         bool IsLayerRequired(const char* name, const RendererConfigurationVulkan* config) const;
 
+        // Submits pending deferred uploads and waits for their completion, so resources can be released safely.
+        void WaitForPendingUploads();
+
+        // Returns the initial image data for the specified texture or null if it has none. Converted or generated image data is stored in 'intermediateData'.
+        const void* GetInitialTextureData(
+            const TextureDescriptor&    textureDesc,
+            const SrcImageDescriptor*   imageDesc,
+            ByteBuffer&                 intermediateData
+        );
+
+        // Copies the initial image data of the first MIP-map level on the host if supported for the new texture. Returns false if a staging buffer must be used instead.
+        bool WriteInitialTextureDataOnHost(VKTexture& textureVK, const TextureDescriptor& textureDesc, const void* initialData);
+
+        // Records the commands to copy the initial image data from the staging buffer into all MIP-map levels of the texture and to generate MIP-maps (if enabled).
+        void RecordInitialTextureUpload(
+            VkCommandBuffer cmdBuffer,
+            VKTexture&      textureVK,
+            VkBuffer        stagingBuffer,
+            VkDeviceSize    stagingOffset,
+            bool            generateMips
+        );
+
+        // Allocates the device memory for the specified buffer, which is host-visible or host-cached memory for buffers created with MiscFlags::HostVisible.
+        VKDeviceMemoryRegion* AllocateBufferMemory(const VKBuffer& bufferVK);
+
         VKDeviceBuffer CreateStagingBuffer(const VkBufferCreateInfo& createInfo);
 
         VKDeviceBuffer CreateStagingBufferAndInitialize(
@@ -87,15 +116,23 @@ class VKRenderSystem final : public RenderSystem
         VKPtr<VkDebugReportCallbackEXT>         debugReportCallback_;
 
         bool                                    debugLayerEnabled_      = false;
+        bool                                    breadcrumbsEnabled_     = false;
+        bool                                    headless_               = false;    // See RenderSystemFlags::Headless
 
         std::unique_ptr<VKDeviceMemoryManager>  deviceMemoryMngr_;
+        std::unique_ptr<VKStagingRing>          stagingRing_;
+        std::unique_ptr<VKPipelineCache>        pipelineCache_;
 
         VKGraphicsPipelineLimits                gfxPipelineLimits_;
 
+        SamplerCache<VkSampler>                 samplerCache_;          // Must outlive 'samplers_'
+
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<VKSwapChain>          swapChains_;
         HWObjectInstance<VKCommandQueue>        commandQueue_;
+        HWObjectInstance<VKCommandQueue>        computeQueue_;
+        HWObjectInstance<VKCommandQueue>        copyQueue_;
         HWObjectContainer<VKCommandBuffer>      commandBuffers_;
         HWObjectContainer<VKBuffer>             buffers_;
         HWObjectContainer<VKBufferArray>        bufferArrays_;
@@ -109,6 +146,7 @@ class VKRenderSystem final : public RenderSystem
         HWObjectContainer<VKResourceHeap>       resourceHeaps_;
         HWObjectContainer<VKQueryHeap>          queryHeaps_;
         HWObjectContainer<VKFence>              fences_;
+        HWObjectContainer<VKAccelerationStructure> accelStructs_;
 
 };
 
@@ -12,6 +12,12 @@
 // Maximum number of Vulkan shader stages per pipeline state object (PSO).
 #define LLGL_VK_MAX_NUM_PSO_SHADER_STAGES (5u)
 
+// Maximum number of descriptors in a push descriptor set; Minimum value for 'VkPhysicalDevicePushDescriptorPropertiesKHR::maxPushDescriptors' required by the spec.
+#define LLGL_VK_MAX_NUM_PUSH_DESCRIPTORS (32u)
+
+// Number of descriptor types that are tracked by descriptor pools, i.e. all core descriptor types and VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR. See VKDescriptorTypeToIndex.
+#define LLGL_VK_NUM_DESCRIPTOR_TYPES (12u)
+
 
 #endif
 
@@ -10,13 +10,17 @@
 #include "VKTypes.h"
 #include "VKDevice.h"
 #include "Memory/VKDeviceMemoryManager.h"
+#include "Ext/VKExtensionRegistry.h"
 #include "../TextureUtils.h"
 #include "../../Core/CoreUtils.h"
 #include "../../Core/Exception.h"
+#include "../HostTrace.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 #include <limits.h>
 #include <set>
+#include <utility>
 
 
 namespace LLGL
@@ -26,6 +30,8 @@ namespace LLGL
 /* ----- Common ----- */
 
 const std::uint32_t VKSwapChain::maxNumColorBuffers;
+const std::uint32_t VKSwapChain::maxNumFramesInFlight;
+const std::uint32_t VKSwapChain::defaultNumFramesInFlight;
 
 static const std::vector<const char*> g_deviceExtensions
 {
@@ -47,10 +53,15 @@ static VKPtr<VkSemaphore> NullVkSemaphore(VkDevice device)
     return VKPtr<VkSemaphore>{ device, vkDestroySemaphore };
 }
 
+static VKPtr<VkFence> NullVkFence(VkDevice device)
+{
+    return VKPtr<VkFence>{ device, vkDestroyFence };
+}
+
 VKSwapChain::VKSwapChain(
     VkInstance                      instance,
     VkPhysicalDevice                physicalDevice,
-    VkDevice                        device,
+    VKDevice&                       device,
     VKDeviceMemoryManager&          deviceMemoryMngr,
     const SwapChainDescriptor&      desc,
     const std::shared_ptr<Surface>& surface)
@@ -78,13 +89,21 @@ VKSwapChain::VKSwapChain(
                                NullVkSemaphore(device_)        },
     renderFinishedSemaphore_ { NullVkSemaphore(device_),
                                NullVkSemaphore(device_),
-                               NullVkSemaphore(device_)        }
+                               NullVkSemaphore(device_)        },
+    frameFences_             { NullVkFence(device_),
+                               NullVkFence(device_),
+                               NullVkFence(device_)            }
 {
     SetOrCreateSurface(surface, desc.resolution, desc.fullscreen, nullptr);
 
     CreatePresentSemaphores();
+    CreateFrameFences();
     CreateGpuSurface();
 
+    /* Only keep explicit presentation mode if the surface supports it */
+    if (IsPresentModeSupported(desc.presentMode))
+        presentMode_ = desc.presentMode;
+
     /* Pick image count for swap-chain and depth-stencil format */
     numColorBuffers_    = PickSwapChainSize(desc.swapBuffers);
     depthStencilFormat_ = PickDepthStencilFormat(desc.depthBits, desc.stencilBits);
@@ -99,37 +118,47 @@ VKSwapChain::VKSwapChain(
 
 void VKSwapChain::Present()
 {
-    /* Get image index for next presentation */
-    const std::uint32_t presentableImageIndex = GetPresentableImageIndex();
+    LLGL_HOST_TRACE_SCOPE("Present");
 
-    /* Initialize semaphores */
-    VkSemaphore waitSemaphorse[] = { imageAvailableSemaphore_[currentColorBuffer_] };
-    VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    VkSemaphore signalSemaphores[] = { renderFinishedSemaphore_[currentColorBuffer_] };
+    /* Acquire image for this presentation if the back buffer has not been used since the last presentation */
+    VkSemaphore signalSemaphores[1];
+    VkFence frameFence = VK_NULL_HANDLE;
+    const std::uint32_t presentableImageIndex = BeginPresent(signalSemaphores[0], frameFence);
+
+    /* Submit signal semaphore and fence of this frame to graphics queue; queue submissions must be externally synchronized */
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
 
-    /* Submit signal semaphore to graphics queue */
     VkSubmitInfo submitInfo;
     {
         submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.pNext                = nullptr;
-        submitInfo.waitSemaphoreCount   = 1;
-        submitInfo.pWaitSemaphores      = waitSemaphorse;
-        submitInfo.pWaitDstStageMask    = waitStages;
+        submitInfo.waitSemaphoreCount   = 0;
+        submitInfo.pWaitSemaphores      = nullptr;
+        submitInfo.pWaitDstStageMask    = nullptr;
         submitInfo.commandBufferCount   = 0;
         submitInfo.pCommandBuffers      = nullptr;
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores    = signalSemaphores;
     }
-    VkResult result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
+    VkResult result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, frameFence);
     VKThrowIfFailed(result, "failed to submit semaphore to Vulkan graphics queue");
 
-    /* Present result on screen */
+    /* Present result on screen and identify the presentation to wait on it later */
     VkSwapchainKHR swapChains[] = { swapChain_ };
 
+    const std::uint64_t presentID = GetNextPresentID();
+    VkPresentIdKHR presentIdInfo;
+    {
+        presentIdInfo.sType             = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        presentIdInfo.pNext             = nullptr;
+        presentIdInfo.swapchainCount    = 1;
+        presentIdInfo.pPresentIds       = &presentID;
+    }
+
     VkPresentInfoKHR presentInfo;
     {
         presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        presentInfo.pNext               = nullptr;
+        presentInfo.pNext               = (HasPresentWait() ? &presentIdInfo : nullptr);
         presentInfo.waitSemaphoreCount  = 1;
         presentInfo.pWaitSemaphores     = signalSemaphores;
         presentInfo.swapchainCount      = 1;
@@ -140,13 +169,13 @@ void VKSwapChain::Present()
     result = vkQueuePresentKHR(presentQueue_, &presentInfo);
     VKThrowIfFailed(result, "failed to present Vulkan graphics queue");
 
-    /* Move to next frame */
-    currentColorBuffer_ = (presentableImageIndex + 1) % numColorBuffers_;
+    EndPresent(presentID);
 }
 
 std::uint32_t VKSwapChain::GetCurrentSwapIndex() const
 {
-    return currentColorBuffer_;
+    /* Swap-chain images are acquired lazily, so the current swap index is only known after acquisition */
+    return const_cast<VKSwapChain*>(this)->AcquireNextImage();
 }
 
 std::uint32_t VKSwapChain::GetNumSwapBuffers() const
@@ -176,9 +205,10 @@ const RenderPass* VKSwapChain::GetRenderPass() const
 
 bool VKSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
 {
-    /* Recreate swap-chain with new vsnyc settings */
-    if (vsyncInterval_ != vsyncInterval)
+    /* Recreate swap-chain with new vsnyc settings; an explicit presentation mode does not depend on the V-sync interval */
+    if (vsyncInterval_ != vsyncInterval && presentMode_ == PresentMode::Default)
     {
+        RetireSwapChain(false);
         CreateSwapChain(GetResolution(), vsyncInterval);
         CreateSwapChainFramebuffers();
         vsyncInterval_ = vsyncInterval;
@@ -186,16 +216,125 @@ bool VKSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
     return true;
 }
 
+bool VKSwapChain::SetMaxFrameLatency(std::uint32_t maxFrameLatency)
+{
+    if (maxFrameLatency == 0)
+        return false;
+
+    /* Limit the number of frames the CPU can record ahead of the GPU */
+    SetNumFramesInFlight(std::min(maxFrameLatency, VKSwapChain::maxNumFramesInFlight));
+
+    /* Additionally limit the number of pending presentations if they can be waited on */
+    if (HasPresentWait())
+        maxFrameLatency_ = maxFrameLatency;
+
+    return true;
+}
+
+static VkPresentModeKHR ToVkPresentMode(PresentMode presentMode)
+{
+    switch (presentMode)
+    {
+        case PresentMode::FifoRelaxed:  return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        case PresentMode::Mailbox:      return VK_PRESENT_MODE_MAILBOX_KHR;
+        case PresentMode::Immediate:    return VK_PRESENT_MODE_IMMEDIATE_KHR;
+        default:                        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+}
+
+bool VKSwapChain::IsPresentModeSupported(PresentMode presentMode) const
+{
+    /* FIFO mode is required to be supported by all Vulkan implementations */
+    if (presentMode == PresentMode::Default || presentMode == PresentMode::Fifo)
+        return true;
+
+    const VkPresentModeKHR presentModeVK = ToVkPresentMode(presentMode);
+    const std::vector<VkPresentModeKHR>& presentModes = surfaceSupportDetails_.presentModes;
+    return (std::find(presentModes.begin(), presentModes.end(), presentModeVK) != presentModes.end());
+}
+
 /* --- Extended functions --- */
 
-std::uint32_t VKSwapChain::TranslateSwapIndex(std::uint32_t swapBufferIndex) const
+std::uint32_t VKSwapChain::TranslateSwapIndex(std::uint32_t swapBufferIndex)
 {
     if (swapBufferIndex == Constants::currentSwapIndex)
-        return currentColorBuffer_;
+        return AcquireNextImage();
     else
         return std::min(swapBufferIndex, numColorBuffers_ - 1);
 }
 
+std::uint32_t VKSwapChain::AcquireNextImage()
+{
+    if (!imageAcquired_)
+    {
+        /* Wait until the GPU has completed the frame that used the same frame resources */
+        VkFence frameFence = frameFences_[frameIndex_].Get();
+        vkWaitForFences(device_, 1, &frameFence, VK_TRUE, UINT64_MAX);
+
+        /* Destroy previous swap-chains whose frames have been completed */
+        if (!retiredSwapChains_.empty())
+            ReleaseRetiredSwapChains();
+
+        /* Acquire next image; this only blocks if the presentation engine has no image available */
+        vkAcquireNextImageKHR(
+            device_,
+            swapChain_,
+            UINT64_MAX,
+            imageAvailableSemaphore_[frameIndex_],
+            VK_NULL_HANDLE,
+            &currentColorBuffer_
+        );
+
+        /* Submit empty batch that makes all subsequent submissions wait until the image is available; queue submissions must be externally synchronized */
+        VkSemaphore waitSemaphores[] = { imageAvailableSemaphore_[frameIndex_] };
+        VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT };
+
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+        VkSubmitInfo submitInfo;
+        {
+            submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext                = nullptr;
+            submitInfo.waitSemaphoreCount   = 1;
+            submitInfo.pWaitSemaphores      = waitSemaphores;
+            submitInfo.pWaitDstStageMask    = waitStages;
+            submitInfo.commandBufferCount   = 0;
+            submitInfo.pCommandBuffers      = nullptr;
+            submitInfo.signalSemaphoreCount = 0;
+            submitInfo.pSignalSemaphores    = nullptr;
+        }
+        VkResult result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
+        VKThrowIfFailed(result, "failed to submit semaphore to Vulkan graphics queue");
+
+        imageAcquired_ = true;
+    }
+    return currentColorBuffer_;
+}
+
+std::uint32_t VKSwapChain::BeginPresent(VkSemaphore& outSignalSemaphore, VkFence& outFrameFence)
+{
+    const std::uint32_t presentableImageIndex = AcquireNextImage();
+
+    /* Reset fence of this frame, so it can be signaled by the submission that precedes the presentation */
+    outSignalSemaphore  = renderFinishedSemaphore_[presentableImageIndex];
+    outFrameFence       = frameFences_[frameIndex_].Get();
+    vkResetFences(device_, 1, &outFrameFence);
+
+    return presentableImageIndex;
+}
+
+void VKSwapChain::EndPresent(std::uint64_t presentID)
+{
+    presentID_ = presentID;
+
+    /* Move to next frame in flight; the next image is only acquired once the back buffer is used again */
+    frameIndex_     = (frameIndex_ + 1) % numFramesInFlight_;
+    imageAcquired_  = false;
+
+    /* Block until the next frame can be queued */
+    if (maxFrameLatency_ > 0)
+        WaitForFrameLatency();
+}
+
 bool VKSwapChain::HasDepthStencilBuffer() const
 {
     return (depthStencilFormat_ != VK_FORMAT_UNDEFINED);
@@ -231,6 +370,7 @@ void CopyVkImageRegion(TDst& outRegion, const TextureRegion& dstRegion, const Of
 void VKSwapChain::CopyImage(
     VKDevice&               device,
     VkCommandBuffer         commandBuffer,
+    VKBarrierAccumulator&   barriers,
     VkImage                 dstImage,
     VkImageLayout           dstImageLayout,
     const TextureRegion&    dstRegion,
@@ -252,12 +392,12 @@ void VKSwapChain::CopyImage(
                 return /*No depth-stencil buffer*/;
 
             VkImage srcImage = depthStencilBuffer_.GetVkImage();
-            device.ResolveImage(commandBuffer, srcImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, dstImage, dstImageLayout, resolveRegion, format);
+            device.ResolveImage(commandBuffer, barriers, srcImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, dstImage, dstImageLayout, resolveRegion, format);
         }
         else
         {
             VkImage srcImage = colorBuffers_[srcColorBuffer].GetVkImage();
-            device.ResolveImage(commandBuffer, srcImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, dstImage, dstImageLayout, resolveRegion, format);
+            device.ResolveImage(commandBuffer, barriers, srcImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, dstImage, dstImageLayout, resolveRegion, format);
         }
     }
     else
@@ -271,12 +411,12 @@ void VKSwapChain::CopyImage(
                 return /*No depth-stencil buffer*/;
 
             VkImage srcImage = depthStencilBuffer_.GetVkImage();
-            device.CopyImage(commandBuffer, srcImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, dstImage, dstImageLayout, copyRegion, format);
+            device.CopyImage(commandBuffer, barriers, srcImage, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, dstImage, dstImageLayout, copyRegion, format);
         }
         else
         {
             VkImage srcImage = swapChainImages_[srcColorBuffer];
-            device.CopyImage(commandBuffer, srcImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, dstImage, dstImageLayout, copyRegion, format);
+            device.CopyImage(commandBuffer, barriers, srcImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, dstImage, dstImageLayout, copyRegion, format);
         }
     }
 }
@@ -292,15 +432,14 @@ bool VKSwapChain::ResizeBuffersPrimary(const Extent2D& resolution)
     if (swapChainExtent_.width  != resolution.width ||
         swapChainExtent_.height != resolution.height)
     {
-        /* Wait until graphics queue is idle before resources are destroyed and recreated */
-        vkQueueWaitIdle(graphicsQueue_);
-
-        /* Recreate presenting semaphores and Vulkan surface */
-        CreatePresentSemaphores();
-        CreateGpuSurface();
-
-        /* Recreate color and depth-stencil buffers */
-        ReleaseRenderBuffers();
+        /* Surface capabilities, such as the current extent, change with the window size */
+        surfaceSupportDetails_ = VKQuerySurfaceSupport(physicalDevice_, surface_);
+
+        /*
+        Hand over the current swap-chain to its successor instead of waiting for the graphics queue to be idle.
+        Previous images, framebuffers, and render buffers are destroyed once the frames that referenced them have been completed.
+        */
+        RetireSwapChain(true);
         CreateResolutionDependentResources(resolution);
     }
     return true;
@@ -321,11 +460,27 @@ void VKSwapChain::CreateGpuSemaphore(VKPtr<VkSemaphore>& semaphore)
 
 void VKSwapChain::CreatePresentSemaphores()
 {
-    /* Create presentation semaphorse */
-    for_range(i, numColorBuffers_)
-    {
+    /* Create presentation semaphores for all frames in flight and all swap-chain images, since their numbers can change */
+    for_range(i, VKSwapChain::maxNumFramesInFlight)
         CreateGpuSemaphore(imageAvailableSemaphore_[i]);
+    for_range(i, VKSwapChain::maxNumColorBuffers)
         CreateGpuSemaphore(renderFinishedSemaphore_[i]);
+}
+
+void VKSwapChain::CreateFrameFences()
+{
+    /* Create all frame fences with their initial state being signaled */
+    VkFenceCreateInfo createInfo;
+    {
+        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    }
+
+    for_range(i, VKSwapChain::maxNumFramesInFlight)
+    {
+        VkResult result = vkCreateFence(device_, &createInfo, nullptr, frameFences_[i].ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan fence");
     }
 }
 
@@ -453,11 +608,14 @@ void VKSwapChain::CreateSwapChain(const Extent2D& resolution, std::uint32_t vsyn
         createInfo.compositeAlpha               = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
         createInfo.presentMode                  = presentMode;
         createInfo.clipped                      = VK_TRUE;
-        createInfo.oldSwapchain                 = VK_NULL_HANDLE;
+        createInfo.oldSwapchain                 = (retiredSwapChains_.empty() ? VK_NULL_HANDLE : retiredSwapChains_.back().swapChain.Get());
     }
     VkResult result = vkCreateSwapchainKHR(device_, &createInfo, nullptr, swapChain_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan swap-chain");
 
+    /* Present IDs are specific to each native swap-chain */
+    presentID_ = 0;
+
     /* Query swap-chain images */
     result = vkGetSwapchainImagesKHR(device_, swapChain_, &numColorBuffers_, nullptr);
     VKThrowIfFailed(result, "failed to query number of Vulkan swap-chain images");
@@ -468,8 +626,9 @@ void VKSwapChain::CreateSwapChain(const Extent2D& resolution, std::uint32_t vsyn
     /* Create swap-chain image views */
     CreateSwapChainImageViews();
 
-    /* Get initial color buffer index for new Vulkan swap-chain */
-    currentColorBuffer_ = GetPresentableImageIndex();
+    /* Images of the previous swap-chain are no longer valid; the first image of the new swap-chain is acquired lazily */
+    currentColorBuffer_ = 0;
+    imageAcquired_      = false;
 }
 
 void VKSwapChain::CreateSwapChainImageViews()
@@ -508,6 +667,13 @@ void VKSwapChain::CreateSwapChainImageViews()
 
 void VKSwapChain::CreateSwapChainFramebuffers()
 {
+    /* Attachments are rendered directly with VK_KHR_dynamic_rendering, so no framebuffer objects are created */
+    if (HasExtension(VKExt::KHR_dynamic_rendering))
+    {
+        CreateSwapChainRenderingAttachments();
+        return;
+    }
+
     /* Initialize image view attachments */
     VkImageView attachments[3] = {};
     std::uint32_t numAttachments = 0;
@@ -554,6 +720,32 @@ void VKSwapChain::CreateSwapChainFramebuffers()
     }
 }
 
+void VKSwapChain::CreateSwapChainRenderingAttachments()
+{
+    for_range(i, numColorBuffers_)
+    {
+        VKRenderingAttachments& attachments = renderingAttachments_[i];
+        attachments.numColorAttachments = 1;
+
+        /* Swap-chain images remain presentable after each render pass; multi-sampled color buffers are resolved into them */
+        if (HasMultiSampling())
+        {
+            VKInitRenderingAttachment(attachments.colorAttachments[0], colorBuffers_[i].GetVkImage(), colorBuffers_[i].GetVkImageView(), VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+            VKInitRenderingAttachment(attachments.resolveAttachments[0], swapChainImages_[i], swapChainImageViews_[i], VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, 0, 0, VK_RESOLVE_MODE_AVERAGE_BIT_KHR);
+        }
+        else
+            VKInitRenderingAttachment(attachments.colorAttachments[0], swapChainImages_[i], swapChainImageViews_[i], VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+        if (HasDepthStencilBuffer())
+        {
+            const VkImageAspectFlags aspectMask = (VKTypes::IsVkFormatStencil(depthStencilFormat_) ? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_DEPTH_BIT);
+            VKInitRenderingAttachment(attachments.depthStencilAttachment, depthStencilBuffer_.GetVkImage(), depthStencilBuffer_.GetVkImageView(), aspectMask, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+        }
+        else
+            attachments.depthStencilAttachment = VKRenderingAttachment{};
+    }
+}
+
 void VKSwapChain::CreateDepthStencilBuffer(const Extent2D& resolution)
 {
     const auto sampleCountBits = VKTypes::ToVkSampleCountBits(swapChainSamples_);
@@ -568,16 +760,6 @@ void VKSwapChain::CreateColorBuffers(const Extent2D& resolution)
         colorBuffers_[i].Create(deviceMemoryMngr_, resolution, swapChainFormat_.format, sampleCountBits);
 }
 
-void VKSwapChain::ReleaseRenderBuffers()
-{
-    depthStencilBuffer_.Release();
-    if (HasMultiSampling())
-    {
-        for_range(i, numColorBuffers_)
-            colorBuffers_[i].Release();
-    }
-}
-
 void VKSwapChain::CreateResolutionDependentResources(const Extent2D& resolution)
 {
     CreateSwapChain(resolution, vsyncInterval_);
@@ -610,6 +792,10 @@ VkSurfaceFormatKHR VKSwapChain::PickSwapSurfaceFormat(const std::vector<VkSurfac
 
 VkPresentModeKHR VKSwapChain::PickSwapPresentMode(const std::vector<VkPresentModeKHR>& presentModes, std::uint32_t vsyncInterval) const
 {
+    /* Explicit presentation mode has already been validated against the surface capabilities */
+    if (presentMode_ != PresentMode::Default)
+        return ToVkPresentMode(presentMode_);
+
     if (vsyncInterval == 0)
     {
         /* Check if MAILBOX or IMMEDIATE presentation mode is available, to avoid vertical synchronization */
@@ -667,18 +853,113 @@ std::uint32_t VKSwapChain::PickSwapChainSize(std::uint32_t swapBuffers) const
     );
 }
 
-std::uint32_t VKSwapChain::GetPresentableImageIndex() const
+void VKSwapChain::SetNumFramesInFlight(std::uint32_t numFramesInFlight)
+{
+    if (numFramesInFlight_ != numFramesInFlight)
+    {
+        /* Wait until graphics queue is idle, so all semaphores and fences of the frames in flight can be re-used in any order */
+        {
+            std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+            vkQueueWaitIdle(graphicsQueue_);
+        }
+        numFramesInFlight_  = numFramesInFlight;
+        retiredSwapChains_.clear();
+        frameIndex_         = 0;
+    }
+}
+
+void VKSwapChain::RetireSwapChain(bool retireRenderBuffers)
+{
+    if (swapChain_.Get() == VK_NULL_HANDLE)
+        return;
+
+    /*
+    Work that has been submitted since the last presentation is not covered by any frame fence,
+    so the resources can only be retired with the last presented frame if no image has been acquired since then
+    */
+    if (imageAcquired_)
+    {
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetQueueMutex() };
+        vkQueueWaitIdle(graphicsQueue_);
+    }
+
+    RetiredSwapChain retired;
+    {
+        retired.swapChain   = std::move(swapChain_);
+        retired.frameIndex  = (frameIndex_ + numFramesInFlight_ - 1) % numFramesInFlight_;
+
+        for_range(i, numColorBuffers_)
+        {
+            retired.imageViews.push_back(std::move(swapChainImageViews_[i]));
+            retired.framebuffers.push_back(std::move(swapChainFramebuffers_[i]));
+            retired.renderFinishedSemaphores.push_back(std::move(renderFinishedSemaphore_[i]));
+        }
+
+        if (retireRenderBuffers)
+        {
+            retired.depthStencilBuffers.push_back(std::move(depthStencilBuffer_));
+            if (HasMultiSampling())
+            {
+                for_range(i, numColorBuffers_)
+                    retired.colorBuffers.push_back(std::move(colorBuffers_[i]));
+            }
+        }
+    }
+    retiredSwapChains_.push_back(std::move(retired));
+
+    /* Moved-from objects lose their deleters, so they must be re-initialized */
+    swapChain_ = VKPtr<VkSwapchainKHR>{ device_, vkDestroySwapchainKHR };
+
+    for_range(i, numColorBuffers_)
+    {
+        swapChainImageViews_[i]     = NullVkImageView(device_);
+        swapChainFramebuffers_[i]   = NullVkFramebuffer(device_);
+        renderFinishedSemaphore_[i] = NullVkSemaphore(device_);
+
+        /* The presentation engine may still wait on the previous semaphores, so they cannot be signaled for the new swap-chain images */
+        CreateGpuSemaphore(renderFinishedSemaphore_[i]);
+    }
+
+    if (retireRenderBuffers)
+    {
+        depthStencilBuffer_ = VKDepthStencilBuffer{ device_ };
+        if (HasMultiSampling())
+        {
+            for_range(i, numColorBuffers_)
+                colorBuffers_[i] = VKColorBuffer{ device_ };
+        }
+    }
+}
+
+void VKSwapChain::ReleaseRetiredSwapChains()
 {
-    std::uint32_t presentableImageIndex = 0;
-    vkAcquireNextImageKHR(
-        device_,
-        swapChain_,
-        UINT64_MAX,
-        imageAvailableSemaphore_[currentColorBuffer_],
-        VK_NULL_HANDLE,
-        &presentableImageIndex
+    /* Frame fences are only reset after they have been waited on, so a signaled fence implies the retired resources are no longer in use */
+    retiredSwapChains_.erase(
+        std::remove_if(
+            retiredSwapChains_.begin(),
+            retiredSwapChains_.end(),
+            [this](const RetiredSwapChain& retired) -> bool
+            {
+                return (vkGetFenceStatus(device_, frameFences_[retired.frameIndex]) == VK_SUCCESS);
+            }
+        ),
+        retiredSwapChains_.end()
     );
-    return presentableImageIndex;
+}
+
+bool VKSwapChain::HasPresentWait() const
+{
+    return (HasExtension(VKExt::KHR_present_id) && HasExtension(VKExt::KHR_present_wait));
+}
+
+void VKSwapChain::WaitForFrameLatency()
+{
+    if (presentID_ >= maxFrameLatency_)
+    {
+        /* Use a timeout of one second, so a minimized window cannot block the application indefinitely */
+        constexpr std::uint64_t timeout = 1000000000ull;
+        vkWaitForPresentKHR(device_, swapChain_, presentID_ - maxFrameLatency_ + 1, timeout);
+    }
 }
 
 
@@ -14,6 +14,7 @@
 #include "VKCore.h"
 #include "VKPtr.h"
 #include "RenderState/VKRenderPass.h"
+#include "RenderState/VKDynamicRendering.h"
 #include "Texture/VKDepthStencilBuffer.h"
 #include "Texture/VKColorBuffer.h"
 #include <memory>
@@ -27,6 +28,7 @@ namespace LLGL
 class VKDevice;
 class VKDeviceMemoryManager;
 class VKDeviceMemoryRegion;
+class VKBarrierAccumulator;
 
 class VKSwapChain final : public SwapChain
 {
@@ -36,7 +38,7 @@ class VKSwapChain final : public SwapChain
         VKSwapChain(
             VkInstance                      instance,
             VkPhysicalDevice                physicalDevice,
-            VkDevice                        device,
+            VKDevice&                       device,
             VKDeviceMemoryManager&          deviceMemoryMngr,
             const SwapChainDescriptor&      desc,
             const std::shared_ptr<Surface>& surface
@@ -54,6 +56,8 @@ class VKSwapChain final : public SwapChain
         const RenderPass* GetRenderPass() const override;
 
         bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+        bool SetMaxFrameLatency(std::uint32_t maxFrameLatency) override;
+        bool IsPresentModeSupported(PresentMode presentMode) const override;
 
     public:
 
@@ -69,8 +73,50 @@ class VKSwapChain final : public SwapChain
             return secondaryRenderPass_.GetVkRenderPass();
         }
 
-        // Returns the actual swap buffer index.
-        std::uint32_t TranslateSwapIndex(std::uint32_t swapBufferIndex) const;
+        // Returns the actual swap buffer index. The next swap-chain image is acquired if the current swap index is requested.
+        std::uint32_t TranslateSwapIndex(std::uint32_t swapBufferIndex);
+
+        /*
+        Acquires the next swap-chain image if it has not been acquired since the last presentation and returns its index.
+        This is deferred until the back buffer is first used, e.g. by BeginRenderPass, so Present does not block the CPU when the GPU is behind.
+        */
+        std::uint32_t AcquireNextImage();
+
+        /*
+        Acquires the image for the next presentation and resets the fence of the current frame.
+        The caller must submit a batch that signals 'outSignalSemaphore' and 'outFrameFence', present the returned image index, and then call EndPresent.
+        */
+        std::uint32_t BeginPresent(VkSemaphore& outSignalSemaphore, VkFence& outFrameFence);
+
+        // Moves to the next frame in flight after the image from BeginPresent has been presented with the specified present ID.
+        void EndPresent(std::uint64_t presentID);
+
+        // Returns the ID for the next presentation. Only used if present waits are supported.
+        inline std::uint64_t GetNextPresentID() const
+        {
+            return presentID_ + 1;
+        }
+
+        // Returns true if presentations can be waited on via VK_KHR_present_id and VK_KHR_present_wait.
+        bool HasPresentWait() const;
+
+        // Returns the native Vulkan swap-chain object.
+        inline VkSwapchainKHR GetVkSwapchain() const
+        {
+            return swapChain_.Get();
+        }
+
+        // Returns the queue this swap-chain is presented with.
+        inline VkQueue GetVkPresentQueue() const
+        {
+            return presentQueue_;
+        }
+
+        // Returns the queue that renders into this swap-chain.
+        inline VkQueue GetVkGraphicsQueue() const
+        {
+            return graphicsQueue_;
+        }
 
         // Returns the native VkFramebuffer object that is currently used from swap-chain.
         inline VkFramebuffer GetVkFramebuffer(std::uint32_t swapBufferIndex) const
@@ -78,6 +124,12 @@ class VKSwapChain final : public SwapChain
             return swapChainFramebuffers_[swapBufferIndex].Get();
         }
 
+        // Returns the framebuffer attachments of the specified swap buffer for VK_KHR_dynamic_rendering.
+        inline const VKRenderingAttachments& GetRenderingAttachments(std::uint32_t swapBufferIndex) const
+        {
+            return renderingAttachments_[swapBufferIndex];
+        }
+
         // Returns the swap-chain resolution as VkExtent2D.
         inline const VkExtent2D& GetVkExtent() const
         {
@@ -90,10 +142,11 @@ class VKSwapChain final : public SwapChain
         // Returns true if this swap-chain has multi-sampling enabled.
         bool HasMultiSampling() const;
 
-        // Copies the specified backbuffer into the destination image.
+        // Copies the specified backbuffer into the destination image. Transitions back into the original image layouts are left pending in the barrier accumulator.
         void CopyImage(
             VKDevice&               device,
             VkCommandBuffer         commandBuffer,
+            VKBarrierAccumulator&   barriers,
             VkImage                 dstImage,
             VkImageLayout           dstImageLayout,
             const TextureRegion&    dstRegion,
@@ -102,12 +155,27 @@ class VKSwapChain final : public SwapChain
             VkFormat                format
         );
 
+    private:
+
+        // Resources of a previous native swap-chain that are destroyed once the GPU has completed the last frame that referenced them.
+        struct RetiredSwapChain
+        {
+            VKPtr<VkSwapchainKHR>               swapChain;
+            std::vector<VKPtr<VkImageView>>     imageViews;
+            std::vector<VKPtr<VkFramebuffer>>   framebuffers;
+            std::vector<VKPtr<VkSemaphore>>     renderFinishedSemaphores;
+            std::vector<VKColorBuffer>          colorBuffers;
+            std::vector<VKDepthStencilBuffer>   depthStencilBuffers;
+            std::uint32_t                       frameIndex                  = 0; // Index of the frame fence that is signaled once the resources are no longer in use
+        };
+
     private:
 
         bool ResizeBuffersPrimary(const Extent2D& resolution) override;
 
         void CreateGpuSemaphore(VKPtr<VkSemaphore>& semaphore);
         void CreatePresentSemaphores();
+        void CreateFrameFences();
         void CreateGpuSurface();
 
         void CreateRenderPass(VKRenderPass& renderPass, bool isSecondary);
@@ -117,10 +185,10 @@ class VKSwapChain final : public SwapChain
         void CreateSwapChain(const Extent2D& resolution, std::uint32_t vsyncInterval);
         void CreateSwapChainImageViews();
         void CreateSwapChainFramebuffers();
+        void CreateSwapChainRenderingAttachments();
 
         void CreateDepthStencilBuffer(const Extent2D& resolution);
         void CreateColorBuffers(const Extent2D& resolution);
-        void ReleaseRenderBuffers();
 
         void CreateResolutionDependentResources(const Extent2D& resolution);
 
@@ -130,15 +198,30 @@ class VKSwapChain final : public SwapChain
         VkFormat PickDepthStencilFormat(int depthBits, int stencilBits) const;
         std::uint32_t PickSwapChainSize(std::uint32_t swapBuffers) const;
 
-        std::uint32_t GetPresentableImageIndex() const;
+        /*
+        Moves the current native swap-chain and its image views, framebuffers, and presentation semaphores into the list of retired swap-chains.
+        The next native swap-chain is created with the retired one as 'oldSwapchain'. If 'retireRenderBuffers' is true, the depth-stencil and multi-sampled color buffers are retired as well.
+        */
+        void RetireSwapChain(bool retireRenderBuffers);
+
+        // Destroys all retired swap-chains whose last frame has been completed by the GPU.
+        void ReleaseRetiredSwapChains();
+
+        // Waits until the graphics queue is idle and restarts with the specified number of frames in flight.
+        void SetNumFramesInFlight(std::uint32_t numFramesInFlight);
+
+        // Waits until at most 'maxFrameLatency_ - 1' presentations are still pending.
+        void WaitForFrameLatency();
 
     private:
 
-        static constexpr std::uint32_t maxNumColorBuffers = 3;
+        static constexpr std::uint32_t maxNumColorBuffers       = 3;
+        static constexpr std::uint32_t maxNumFramesInFlight     = 3;
+        static constexpr std::uint32_t defaultNumFramesInFlight = 2;
 
         VkInstance              instance_                                   = VK_NULL_HANDLE;
         VkPhysicalDevice        physicalDevice_                             = VK_NULL_HANDLE;
-        VkDevice                device_;
+        VKDevice&               device_;
 
         VKDeviceMemoryManager&  deviceMemoryMngr_;
 
@@ -153,10 +236,15 @@ class VKSwapChain final : public SwapChain
         VkImage                 swapChainImages_[maxNumColorBuffers];
         VKPtr<VkImageView>      swapChainImageViews_[maxNumColorBuffers];
         VKPtr<VkFramebuffer>    swapChainFramebuffers_[maxNumColorBuffers];
+        VKRenderingAttachments  renderingAttachments_[maxNumColorBuffers];
 
         std::uint32_t           numColorBuffers_                            = 2;
         std::uint32_t           currentColorBuffer_                         = 0;
+        bool                    imageAcquired_                              = false; // True if 'currentColorBuffer_' has been acquired but not yet presented
         std::uint32_t           vsyncInterval_                              = 0;
+        PresentMode             presentMode_                                = PresentMode::Default; // Explicit presentation mode or Default if it's determined by the V-sync interval
+        std::uint32_t           maxFrameLatency_                            = 0; // Zero if the frame latency is not limited
+        std::uint64_t           presentID_                                  = 0; // Present ID of the last presentation; restarts for each native swap-chain
 
         VKRenderPass            secondaryRenderPass_;
         VkFormat                depthStencilFormat_                         = VK_FORMAT_UNDEFINED;
@@ -166,8 +254,14 @@ class VKSwapChain final : public SwapChain
         VkQueue                 graphicsQueue_                              = VK_NULL_HANDLE;
         VkQueue                 presentQueue_                               = VK_NULL_HANDLE;
 
-        VKPtr<VkSemaphore>      imageAvailableSemaphore_[maxNumColorBuffers];
-        VKPtr<VkSemaphore>      renderFinishedSemaphore_[maxNumColorBuffers];
+        VKPtr<VkSemaphore>      imageAvailableSemaphore_[maxNumFramesInFlight]; // Indexed by frame in flight
+        VKPtr<VkSemaphore>      renderFinishedSemaphore_[maxNumColorBuffers];   // Indexed by swap-chain image
+
+        VKPtr<VkFence>          frameFences_[maxNumFramesInFlight];             // Signaled when the GPU has completed a frame in flight
+        std::uint32_t           numFramesInFlight_                          = defaultNumFramesInFlight;
+        std::uint32_t           frameIndex_                                 = 0;
+
+        std::vector<RetiredSwapChain> retiredSwapChains_;                          // Must be destroyed before 'surface_'
 
 };
 
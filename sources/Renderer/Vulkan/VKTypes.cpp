@@ -37,6 +37,8 @@ VkShaderStageFlagBits Map(const ShaderType shaderType)
         case ShaderType::Geometry:          return VK_SHADER_STAGE_GEOMETRY_BIT;
         case ShaderType::Fragment:          return VK_SHADER_STAGE_FRAGMENT_BIT;
         case ShaderType::Compute:           return VK_SHADER_STAGE_COMPUTE_BIT;
+        case ShaderType::Task:              return VK_SHADER_STAGE_TASK_BIT_EXT;
+        case ShaderType::Mesh:              return VK_SHADER_STAGE_MESH_BIT_EXT;
     }
     MapFailed("ShaderType", "VkShaderStageFlagBits");
 }
@@ -337,6 +339,7 @@ VkQueryType Map(const QueryType queryType)
         case QueryType::StreamOutPrimitivesWritten:     break;
         case QueryType::StreamOutOverflow:              break;
         case QueryType::PipelineStatistics:             return VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        case QueryType::Timestamp:                      return VK_QUERY_TYPE_TIMESTAMP;
     }
     MapFailed("QueryType", "VkQueryType");
 }
@@ -1,4 +1,6 @@
 glslangValidator -V -S vert -o Triangle.vert.spv Triangle.vert
 glslangValidator -V -S frag -o Triangle.frag.spv Triangle.frag
 glslangValidator -V -S comp -o SpirvReflectTest.comp.spv SpirvReflectTest.comp
+glslangValidator -V -S vert -o DrawBenchmark.450core.vert.spv DrawBenchmark.450core.vert
+glslangValidator -V -S frag -o DrawBenchmark.450core.frag.spv DrawBenchmark.450core.frag
 pause
\ No newline at end of file
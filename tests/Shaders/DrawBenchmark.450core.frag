@@ -0,0 +1,13 @@
+#version 450 core
+
+layout(push_constant) uniform Uniforms
+{
+	vec4 tint;
+};
+
+layout(location = 0) out vec4 fColor;
+
+void main()
+{
+	fColor = tint;
+}
@@ -0,0 +1,18 @@
+#version 450 core
+
+layout(std140, binding = 1) uniform Scene
+{
+	vec4 sceneOffset;
+};
+
+layout(std140, binding = 2) uniform Object
+{
+	vec4 objectOffset;
+};
+
+layout(location = 0) in vec2 position;
+
+void main()
+{
+	gl_Position = vec4(position + sceneOffset.xy + objectOffset.xy, 0, 1);
+}
@@ -0,0 +1,10 @@
+#version 330 core
+
+uniform vec4 tint;
+
+out vec4 fColor;
+
+void main()
+{
+	fColor = tint;
+}
@@ -0,0 +1,27 @@
+// DrawBenchmark.hlsl
+// Shader for the draw-call throughput benchmark
+
+cbuffer Scene : register(b1)
+{
+    float4 sceneOffset;
+};
+
+cbuffer Object : register(b2)
+{
+    float4 objectOffset;
+};
+
+cbuffer Uniforms : register(b3)
+{
+    float4 tint;
+};
+
+float4 VS(float2 position : POSITION) : SV_Position
+{
+    return float4(position + sceneOffset.xy + objectOffset.xy, 0, 1);
+}
+
+float4 PS() : SV_Target
+{
+    return tint;
+}
@@ -0,0 +1,39 @@
+// DrawBenchmark.metal
+// Shader for the draw-call throughput benchmark
+
+#include <metal_stdlib>
+
+using namespace metal;
+
+struct Scene
+{
+    float4 sceneOffset;
+};
+
+struct Object
+{
+    float4 objectOffset;
+};
+
+struct Uniforms
+{
+    float4 tint;
+};
+
+struct VertexIn
+{
+    float2 position [[attribute(0)]];
+};
+
+vertex float4 VS(
+    VertexIn        inp     [[stage_in]],
+    constant Scene& scene   [[buffer(1)]],
+    constant Object& object [[buffer(2)]])
+{
+    return float4(inp.position + scene.sceneOffset.xy + object.objectOffset.xy, 0, 1);
+}
+
+fragment float4 PS(constant Uniforms& uniforms [[buffer(3)]])
+{
+    return uniforms.tint;
+}
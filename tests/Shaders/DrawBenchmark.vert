@@ -0,0 +1,18 @@
+#version 330 core
+
+layout(std140) uniform Scene
+{
+	vec4 sceneOffset;
+};
+
+layout(std140) uniform Object
+{
+	vec4 objectOffset;
+};
+
+in vec2 position;
+
+void main()
+{
+	gl_Position = vec4(position + sceneOffset.xy + objectOffset.xy, 0, 1);
+}
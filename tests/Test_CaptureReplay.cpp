@@ -0,0 +1,169 @@
+/*
+ * Test_CaptureReplay.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utils/CaptureReplay.h>
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+Capture replay tool.
+Replays the frames of a capture file that has been recorded with LLGL::RenderingDebugger::BeginCapture
+and measures the CPU time per replayed frame, including the time to wait for the GPU at the end of each run.
+
+Usage: Test_CaptureReplay FILE [MODULE] [--runs=N]
+
+If no module is specified, the capture is replayed with the backend it has been recorded with.
+*/
+
+static const char* FindArgumentValue(int argc, char* argv[], const char* search)
+{
+    const std::size_t searchLen = ::strlen(search);
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strncmp(argv[i], search, searchLen) == 0)
+            return argv[i] + searchLen;
+    }
+    return nullptr;
+}
+
+static std::uint32_t FindArgumentUInt(int argc, char* argv[], const char* search, std::uint32_t defaultValue)
+{
+    if (const char* value = FindArgumentValue(argc, argv, search))
+        return std::max(1u, static_cast<std::uint32_t>(::strtoul(value, nullptr, 10)));
+    return defaultValue;
+}
+
+static const char* GetRendererModule(const std::string& name)
+{
+    if (name == "gl" || name == "opengl")
+        return "OpenGL";
+    if (name == "vk" || name == "vulkan")
+        return "Vulkan";
+    if (name == "mt" || name == "mtl" || name == "metal")
+        return "Metal";
+    if (name == "d3d11" || name == "dx11" || name == "direct3d11")
+        return "Direct3D11";
+    if (name == "d3d12" || name == "dx12" || name == "direct3d12")
+        return "Direct3D12";
+    if (name == "null")
+        return "Null";
+    return name.c_str();
+}
+
+static const char* GetRendererModuleFromID(int rendererID)
+{
+    switch (rendererID)
+    {
+        case LLGL::RendererID::Null:        return "Null";
+        case LLGL::RendererID::OpenGL:      return "OpenGL";
+        case LLGL::RendererID::OpenGLES3:   return "OpenGLES3";
+        case LLGL::RendererID::Direct3D11:  return "Direct3D11";
+        case LLGL::RendererID::Direct3D12:  return "Direct3D12";
+        case LLGL::RendererID::Vulkan:      return "Vulkan";
+        case LLGL::RendererID::Metal:       return "Metal";
+        default:                            return nullptr;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    // Gather capture filename and optional module name
+    std::vector<std::string> positionalArgs;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-')
+            positionalArgs.push_back(argv[i]);
+    }
+
+    if (positionalArgs.empty())
+    {
+        LLGL::Log::Errorf("Usage: Test_CaptureReplay FILE [MODULE] [--runs=N]\n");
+        return 1;
+    }
+
+    const std::uint32_t numRuns = FindArgumentUInt(argc, argv, "--runs=", 10);
+
+    LLGL::CaptureReplay replay;
+    if (!replay.LoadFromFile(positionalArgs[0].c_str()))
+        return 1;
+
+    const char* moduleName = (positionalArgs.size() > 1 ? GetRendererModule(positionalArgs[1]) : GetRendererModuleFromID(replay.GetRendererID()));
+    if (moduleName == nullptr)
+    {
+        LLGL::Log::Errorf("Unknown renderer ID in capture: 0x%08X\n", static_cast<unsigned>(replay.GetRendererID()));
+        return 1;
+    }
+
+    // Load renderer without debug layer, since it would dominate the measured costs
+    LLGL::RenderSystemPtr renderer = LLGL::RenderSystem::Load(moduleName);
+    if (!renderer)
+        return 1;
+
+    LLGL::SwapChainDescriptor swapChainDesc;
+    {
+        swapChainDesc.resolution = replay.GetResolution();
+        if (swapChainDesc.resolution.width == 0 || swapChainDesc.resolution.height == 0)
+            swapChainDesc.resolution = { 800, 600 };
+
+        // Present without blocking, so the measured frame times are not capped by the display refresh rate
+        swapChainDesc.presentMode = LLGL::PresentMode::Immediate;
+    }
+    LLGL::SwapChain* swapChain = renderer->CreateSwapChain(swapChainDesc);
+    swapChain->SetVsyncInterval(0);
+
+    auto& window = LLGL::CastTo<LLGL::Window>(swapChain->GetSurface());
+    window.SetTitle(std::string("LLGL Capture Replay - ") + moduleName);
+    window.Show();
+
+    if (!replay.Prepare(*renderer, *swapChain))
+        return 1;
+
+    const std::uint32_t numFrames = replay.GetNumFrames();
+    LLGL::Log::Printf("Replay capture: %s (%u frame(s), %u run(s), %s)\n", positionalArgs[0].c_str(), numFrames, numRuns, moduleName);
+
+    // Replay all frames of the capture for each run and only record the fastest run to reduce noise
+    double minMsPerFrame = 0.0;
+
+    for (std::uint32_t run = 0; run < numRuns && numFrames > 0 && swapChain->GetSurface().ProcessEvents(); ++run)
+    {
+        const std::uint64_t startTime = LLGL::Timer::Tick();
+        {
+            for (std::uint32_t frame = 0; frame < numFrames; ++frame)
+                replay.ReplayFrame(frame);
+            renderer->GetCommandQueue()->WaitIdle();
+        }
+        const std::uint64_t elapsedTicks = LLGL::Timer::Tick() - startTime;
+
+        const double msPerFrame = (static_cast<double>(elapsedTicks) * 1.0e3) / (static_cast<double>(LLGL::Timer::Frequency()) * static_cast<double>(numFrames));
+        LLGL::Log::Printf("Run %u: %.3f ms/frame\n", run + 1, msPerFrame);
+
+        if (run == 0 || msPerFrame < minMsPerFrame)
+            minMsPerFrame = msPerFrame;
+    }
+
+    LLGL::Log::Printf("Fastest run: %.3f ms/frame (%s)\n", minMsPerFrame, renderer->GetRendererInfo().deviceName.c_str());
+
+    replay.Release();
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
+
+
+
+// ================================================================================
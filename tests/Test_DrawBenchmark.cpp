@@ -0,0 +1,529 @@
+/*
+ * Test_DrawBenchmark.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utils/Parse.h>
+#include <LLGL/Utils/Utility.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+Draw-call throughput benchmark.
+Encodes and submits millions of draw calls and measures the CPU time per draw for each kind of state change in between,
+producing a cost matrix in nanoseconds per draw for each backend.
+
+Usage: Test_DrawBenchmark [MODULES...] [--draws=N] [--batch=N] [--runs=N] [--replay] [--csv=FILE]
+
+With --replay, each batch is recorded only once into a multi-submit command buffer and only its resubmission is measured,
+i.e. the replay cost of emulated command buffers (e.g. OpenGL and Metal) without the encoding cost.
+*/
+
+enum class StateChange
+{
+    None,                   // Only draw calls, all states are bound once per batch
+    PipelineState,          // Alternate between two PSOs with the same layout
+    PipelineStateRedundant, // Set the same PSO before each draw
+    ResourceHeap,           // Alternate between two resource heaps
+    ResourceHeapRedundant,  // Set the same resource heap before each draw
+    Resource,               // Alternate between two individually bound constant buffers
+    VertexBuffer,           // Alternate between two vertex buffers
+    VertexBufferRedundant,  // Set the same vertex buffer before each draw
+    Uniforms,               // Write different uniform values before each draw
+    All,                    // Alternate all of the above before each draw
+};
+
+struct StateChangeCase
+{
+    const char* name;
+    StateChange change;
+};
+
+static const StateChangeCase g_stateChangeCases[] =
+{
+    { "Draw",                       StateChange::None                   },
+    { "SetPipelineState",           StateChange::PipelineState          },
+    { "SetPipelineState (same)",    StateChange::PipelineStateRedundant },
+    { "SetResourceHeap",            StateChange::ResourceHeap           },
+    { "SetResourceHeap (same)",     StateChange::ResourceHeapRedundant  },
+    { "SetResource",                StateChange::Resource               },
+    { "SetVertexBuffer",            StateChange::VertexBuffer           },
+    { "SetVertexBuffer (same)",     StateChange::VertexBufferRedundant  },
+    { "SetUniforms",                StateChange::Uniforms               },
+    { "All",                        StateChange::All                    },
+};
+
+static constexpr std::size_t g_numStateChangeCases = sizeof(g_stateChangeCases)/sizeof(g_stateChangeCases[0]);
+
+struct BenchmarkConfig
+{
+    std::uint32_t numDraws      = 1000000;
+    std::uint32_t drawsPerBatch = 10000; // Number of draws per command buffer submission
+    std::uint32_t numRuns       = 3;     // Only the fastest run is recorded to reduce noise
+    bool          replay        = false; // Only measure resubmission of pre-recorded command buffers
+};
+
+struct BenchmarkResult
+{
+    std::string moduleName;
+    std::string deviceName;
+    double      nsPerDraw[g_numStateChangeCases] = {};
+};
+
+class DrawBenchmark
+{
+
+    private:
+
+        LLGL::RenderSystemPtr   renderer;
+        LLGL::SwapChain*        swapChain           = nullptr;
+        LLGL::CommandQueue*     commandQueue        = nullptr;
+        LLGL::CommandBuffer*    commands            = nullptr;
+        LLGL::CommandBuffer*    replayCommands      = nullptr;
+
+        LLGL::PipelineLayout*   pipelineLayout      = nullptr;
+        LLGL::PipelineState*    pipelines[2]        = {};
+        LLGL::ResourceHeap*     resourceHeaps[2]    = {};
+        LLGL::Buffer*           sceneBuffers[2]     = {};
+        LLGL::Buffer*           objectBuffers[2]    = {};
+        LLGL::Buffer*           vertexBuffers[2]    = {};
+
+    private:
+
+        bool Supported(LLGL::ShadingLanguage language) const
+        {
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            return (std::find(languages.begin(), languages.end(), language) != languages.end());
+        }
+
+        LLGL::Shader* LoadShader(LLGL::ShaderType type, const LLGL::VertexFormat& vertexFormat)
+        {
+            const bool isVertex = (type == LLGL::ShaderType::Vertex);
+
+            LLGL::ShaderDescriptor shaderDesc;
+            if (Supported(LLGL::ShadingLanguage::GLSL))
+                shaderDesc = LLGL::ShaderDescFromFile(type, (isVertex ? "Shaders/DrawBenchmark.vert" : "Shaders/DrawBenchmark.frag"));
+            else if (Supported(LLGL::ShadingLanguage::SPIRV))
+                shaderDesc = LLGL::ShaderDescFromFile(type, (isVertex ? "Shaders/DrawBenchmark.450core.vert.spv" : "Shaders/DrawBenchmark.450core.frag.spv"));
+            else if (Supported(LLGL::ShadingLanguage::HLSL))
+                shaderDesc = LLGL::ShaderDescFromFile(type, "Shaders/DrawBenchmark.hlsl", (isVertex ? "VS" : "PS"), (isVertex ? "vs_5_0" : "ps_5_0"));
+            else if (Supported(LLGL::ShadingLanguage::Metal))
+                shaderDesc = LLGL::ShaderDescFromFile(type, "Shaders/DrawBenchmark.metal", (isVertex ? "VS" : "PS"), "1.1");
+            else
+                return nullptr;
+
+            if (isVertex)
+                shaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+            LLGL::Shader* shader = renderer->CreateShader(shaderDesc);
+            if (const LLGL::Report* report = shader->GetReport())
+            {
+                if (report->HasErrors())
+                {
+                    LLGL::Log::Errorf("%s", report->GetText());
+                    return nullptr;
+                }
+            }
+            return shader;
+        }
+
+        LLGL::Buffer* CreateConstantBuffer(float x, float y)
+        {
+            const float data[4] = { x, y, 0.0f, 0.0f };
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size         = sizeof(data);
+                bufferDesc.bindFlags    = LLGL::BindFlags::ConstantBuffer;
+            }
+            return renderer->CreateBuffer(bufferDesc, data);
+        }
+
+        LLGL::Buffer* CreateVertexBuffer(const LLGL::VertexFormat& vertexFormat, float scale)
+        {
+            // Small triangle to keep the GPU workload negligible compared to the CPU cost of each draw
+            const float vertices[] =
+            {
+                 0.0f,  scale,
+                 scale, -scale,
+                -scale, -scale,
+            };
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size             = sizeof(vertices);
+                bufferDesc.bindFlags        = LLGL::BindFlags::VertexBuffer;
+                bufferDesc.vertexAttribs    = vertexFormat.attributes;
+            }
+            return renderer->CreateBuffer(bufferDesc, vertices);
+        }
+
+        // Binds all states once, so every draw is valid regardless of which state is changed in between.
+        void BindInitialStates(LLGL::CommandBuffer& cmdBuffer)
+        {
+            const float tint[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            cmdBuffer.SetViewport(swapChain->GetResolution());
+            cmdBuffer.SetPipelineState(*pipelines[0]);
+            cmdBuffer.SetResourceHeap(*resourceHeaps[0]);
+            cmdBuffer.SetResource(0, *objectBuffers[0]);
+            cmdBuffer.SetVertexBuffer(*vertexBuffers[0]);
+            cmdBuffer.SetUniforms(0, tint, sizeof(tint));
+        }
+
+        void EncodeDraws(LLGL::CommandBuffer& cmdBuffer, StateChange change, std::uint32_t numDraws)
+        {
+            const float tints[2][4] =
+            {
+                { 1.0f, 0.5f, 0.0f, 1.0f },
+                { 0.0f, 0.5f, 1.0f, 1.0f },
+            };
+
+            for (std::uint32_t i = 0; i < numDraws; ++i)
+            {
+                const std::uint32_t alt = (i & 1u);
+                switch (change)
+                {
+                    case StateChange::None:
+                        break;
+                    case StateChange::PipelineState:
+                        cmdBuffer.SetPipelineState(*pipelines[alt]);
+                        break;
+                    case StateChange::PipelineStateRedundant:
+                        cmdBuffer.SetPipelineState(*pipelines[0]);
+                        break;
+                    case StateChange::ResourceHeap:
+                        cmdBuffer.SetResourceHeap(*resourceHeaps[alt]);
+                        break;
+                    case StateChange::ResourceHeapRedundant:
+                        cmdBuffer.SetResourceHeap(*resourceHeaps[0]);
+                        break;
+                    case StateChange::Resource:
+                        cmdBuffer.SetResource(0, *objectBuffers[alt]);
+                        break;
+                    case StateChange::VertexBuffer:
+                        cmdBuffer.SetVertexBuffer(*vertexBuffers[alt]);
+                        break;
+                    case StateChange::VertexBufferRedundant:
+                        cmdBuffer.SetVertexBuffer(*vertexBuffers[0]);
+                        break;
+                    case StateChange::Uniforms:
+                        cmdBuffer.SetUniforms(0, tints[alt], sizeof(tints[alt]));
+                        break;
+                    case StateChange::All:
+                        cmdBuffer.SetPipelineState(*pipelines[alt]);
+                        cmdBuffer.SetResourceHeap(*resourceHeaps[alt]);
+                        cmdBuffer.SetResource(0, *objectBuffers[alt]);
+                        cmdBuffer.SetVertexBuffer(*vertexBuffers[alt]);
+                        cmdBuffer.SetUniforms(0, tints[alt], sizeof(tints[alt]));
+                        break;
+                }
+                cmdBuffer.Draw(3, 0);
+            }
+        }
+
+    public:
+
+        bool Load(const std::string& moduleName)
+        {
+            // Load renderer without debug layer, since it would dominate the measured costs
+            renderer = LLGL::RenderSystem::Load(moduleName);
+            if (!renderer)
+                return false;
+
+            // Create swap-chain
+            LLGL::SwapChainDescriptor swapChainDesc;
+            {
+                swapChainDesc.resolution = { 320, 240 };
+            }
+            swapChain = renderer->CreateSwapChain(swapChainDesc);
+            swapChain->SetVsyncInterval(0);
+
+            auto& window = LLGL::CastTo<LLGL::Window>(swapChain->GetSurface());
+            window.SetTitle("LLGL Draw Benchmark - " + moduleName);
+            window.Show();
+
+            // Create command buffer that is submitted explicitly, so the submission cost of deferred command buffers is included
+            commands        = renderer->CreateCommandBuffer();
+            replayCommands  = renderer->CreateCommandBuffer(LLGL::CommandBufferFlags::MultiSubmit);
+            commandQueue    = renderer->GetCommandQueue();
+
+            // Create pipeline layout with one heap binding, one individual binding, and one uniform
+            pipelineLayout = renderer->CreatePipelineLayout(
+                LLGL::Parse("heap{cbuffer(Scene@1):vert}, cbuffer(Object@2):vert, float4(tint)")
+            );
+
+            // Create resources in pairs to alternate between them
+            LLGL::VertexFormat vertexFormat;
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+            for (int i = 0; i < 2; ++i)
+            {
+                sceneBuffers[i]     = CreateConstantBuffer(0.01f * i, 0.0f);
+                objectBuffers[i]    = CreateConstantBuffer(0.0f, 0.01f * i);
+                vertexBuffers[i]    = CreateVertexBuffer(vertexFormat, 0.01f + 0.005f * i);
+                resourceHeaps[i]    = renderer->CreateResourceHeap(pipelineLayout, { sceneBuffers[i] });
+            }
+
+            // Create two PSOs that only differ in their blend states
+            LLGL::Shader* vertexShader      = LoadShader(LLGL::ShaderType::Vertex, vertexFormat);
+            LLGL::Shader* fragmentShader    = LoadShader(LLGL::ShaderType::Fragment, vertexFormat);
+            if (vertexShader == nullptr || fragmentShader == nullptr)
+            {
+                LLGL::Log::Errorf("Failed to load shaders for renderer: %s\n", moduleName.c_str());
+                return false;
+            }
+
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.vertexShader       = vertexShader;
+                pipelineDesc.fragmentShader     = fragmentShader;
+                pipelineDesc.pipelineLayout     = pipelineLayout;
+                pipelineDesc.renderPass         = swapChain->GetRenderPass();
+            }
+            for (int i = 0; i < 2; ++i)
+            {
+                pipelineDesc.blend.targets[0].blendEnabled = (i == 1);
+                pipelines[i] = renderer->CreatePipelineState(pipelineDesc);
+                if (const LLGL::Report* report = pipelines[i]->GetReport())
+                {
+                    if (report->HasErrors())
+                    {
+                        LLGL::Log::Errorf("%s", report->GetText());
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void RecordBatch(LLGL::CommandBuffer& cmdBuffer, StateChange change, std::uint32_t numDraws)
+        {
+            cmdBuffer.Begin();
+            {
+                cmdBuffer.BeginRenderPass(*swapChain);
+                {
+                    BindInitialStates(cmdBuffer);
+                    EncodeDraws(cmdBuffer, change, numDraws);
+                }
+                cmdBuffer.EndRenderPass();
+            }
+            cmdBuffer.End();
+        }
+
+        // Returns the CPU time in nanoseconds per draw, including its state changes and the command buffer submission.
+        // In replay mode, only the resubmission of a pre-recorded batch is measured.
+        double Run(StateChange change, const BenchmarkConfig& config)
+        {
+            double bestTime = 0.0;
+
+            if (config.replay)
+                RecordBatch(*replayCommands, change, config.drawsPerBatch);
+
+            for (std::uint32_t run = 0; run < config.numRuns && swapChain->GetSurface().ProcessEvents(); ++run)
+            {
+                std::uint64_t elapsedTicks = 0;
+                std::uint64_t numDrawsTotal = 0;
+
+                for (std::uint32_t firstDraw = 0; firstDraw < config.numDraws; firstDraw += config.drawsPerBatch)
+                {
+                    const std::uint32_t numDraws = (config.replay ? config.drawsPerBatch : std::min(config.drawsPerBatch, config.numDraws - firstDraw));
+
+                    const std::uint64_t startTime = LLGL::Timer::Tick();
+                    if (config.replay)
+                    {
+                        commandQueue->Submit(*replayCommands);
+                    }
+                    else
+                    {
+                        RecordBatch(*commands, change, numDraws);
+                        commandQueue->Submit(*commands);
+                    }
+                    elapsedTicks += LLGL::Timer::Tick() - startTime;
+                    numDrawsTotal += numDraws;
+
+                    // Don't measure the GPU, only the CPU cost of encoding and submission
+                    commandQueue->WaitIdle();
+                }
+
+                swapChain->Present();
+
+                const double nsPerDraw = (static_cast<double>(elapsedTicks) * 1.0e9) / (static_cast<double>(LLGL::Timer::Frequency()) * static_cast<double>(numDrawsTotal));
+                if (run == 0 || nsPerDraw < bestTime)
+                    bestTime = nsPerDraw;
+            }
+
+            return bestTime;
+        }
+
+        std::string GetDeviceName() const
+        {
+            return renderer->GetRendererInfo().deviceName;
+        }
+
+};
+
+static const char* FindArgumentValue(int argc, char* argv[], const char* search)
+{
+    const std::size_t searchLen = ::strlen(search);
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strncmp(argv[i], search, searchLen) == 0)
+            return argv[i] + searchLen;
+    }
+    return nullptr;
+}
+
+static std::uint32_t FindArgumentUInt(int argc, char* argv[], const char* search, std::uint32_t defaultValue)
+{
+    if (const char* value = FindArgumentValue(argc, argv, search))
+        return std::max(1u, static_cast<std::uint32_t>(::strtoul(value, nullptr, 10)));
+    return defaultValue;
+}
+
+static bool HasArgument(int argc, char* argv[], const char* search)
+{
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strcmp(argv[i], search) == 0)
+            return true;
+    }
+    return false;
+}
+
+static const char* GetRendererModule(const std::string& name)
+{
+    if (name == "gl" || name == "opengl")
+        return "OpenGL";
+    if (name == "vk" || name == "vulkan")
+        return "Vulkan";
+    if (name == "mt" || name == "mtl" || name == "metal")
+        return "Metal";
+    if (name == "d3d11" || name == "dx11" || name == "direct3d11")
+        return "Direct3D11";
+    if (name == "d3d12" || name == "dx12" || name == "direct3d12")
+        return "Direct3D12";
+    if (name == "null")
+        return "Null";
+    return name.c_str();
+}
+
+static void PrintCostMatrix(const std::vector<BenchmarkResult>& results)
+{
+    // Print header with one column per backend
+    LLGL::Log::Printf("\n%-26s", "ns/draw (ns/state change)");
+    for (const BenchmarkResult& result : results)
+        LLGL::Log::Printf(" | %-22s", result.moduleName.c_str());
+    LLGL::Log::Printf("\n");
+
+    for (std::size_t i = 0; i < g_numStateChangeCases; ++i)
+    {
+        LLGL::Log::Printf("%-26s", g_stateChangeCases[i].name);
+        for (const BenchmarkResult& result : results)
+        {
+            // State change costs are relative to the draw-only baseline
+            char cell[64];
+            if (i == 0)
+                ::snprintf(cell, sizeof(cell), "%8.1f", result.nsPerDraw[i]);
+            else
+                ::snprintf(cell, sizeof(cell), "%8.1f (%+8.1f)", result.nsPerDraw[i], result.nsPerDraw[i] - result.nsPerDraw[0]);
+            LLGL::Log::Printf(" | %-22s", cell);
+        }
+        LLGL::Log::Printf("\n");
+    }
+
+    LLGL::Log::Printf("\n");
+    for (const BenchmarkResult& result : results)
+        LLGL::Log::Printf("%s: %s\n", result.moduleName.c_str(), result.deviceName.c_str());
+}
+
+static void SaveCostMatrixCSV(const std::vector<BenchmarkResult>& results, const char* filename)
+{
+    std::ofstream file{ filename };
+    if (!file.good())
+    {
+        LLGL::Log::Errorf("Failed to write CSV file: %s\n", filename);
+        return;
+    }
+
+    file << "module,device,case,nsPerDraw,nsPerStateChange\n";
+    for (const BenchmarkResult& result : results)
+    {
+        for (std::size_t i = 0; i < g_numStateChangeCases; ++i)
+        {
+            file << result.moduleName << ",\"" << result.deviceName << "\",\"" << g_stateChangeCases[i].name << "\","
+                 << result.nsPerDraw[i] << ',' << (i == 0 ? 0.0 : result.nsPerDraw[i] - result.nsPerDraw[0]) << '\n';
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    BenchmarkConfig config;
+    {
+        config.numDraws         = FindArgumentUInt(argc, argv, "--draws=", config.numDraws);
+        config.drawsPerBatch    = FindArgumentUInt(argc, argv, "--batch=", config.drawsPerBatch);
+        config.numRuns          = FindArgumentUInt(argc, argv, "--runs=",  config.numRuns);
+        config.replay           = HasArgument(argc, argv, "--replay");
+    }
+
+    // Gather all explicitly specified module names
+    std::vector<std::string> enabledModules;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-')
+            enabledModules.push_back(GetRendererModule(argv[i]));
+    }
+
+    if (enabledModules.empty())
+        enabledModules = LLGL::RenderSystem::FindModules();
+
+    // Run all state change cases for each backend
+    std::vector<BenchmarkResult> results;
+
+    for (const std::string& moduleName : enabledModules)
+    {
+        LLGL::Log::Printf(
+            "Run draw benchmark: %s (%u draws, %u per batch%s)\n",
+            moduleName.c_str(), config.numDraws, config.drawsPerBatch, (config.replay ? ", replay only" : "")
+        );
+
+        DrawBenchmark benchmark;
+        if (!benchmark.Load(moduleName))
+            continue;
+
+        BenchmarkResult result;
+        {
+            result.moduleName = moduleName;
+            result.deviceName = benchmark.GetDeviceName();
+        }
+        for (std::size_t i = 0; i < g_numStateChangeCases; ++i)
+            result.nsPerDraw[i] = benchmark.Run(g_stateChangeCases[i].change, config);
+
+        results.push_back(result);
+    }
+
+    if (!results.empty())
+    {
+        PrintCostMatrix(results);
+        if (const char* csvFilename = FindArgumentValue(argc, argv, "--csv="))
+            SaveCostMatrixCSV(results, csvFilename);
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
@@ -6,7 +6,11 @@
  */
 
 #include <LLGL/Utils/Image.h>
+#include <LLGL/Timer.h>
+#include <LLGL/Constants.h>
 #include <iostream>
+#include <vector>
+#include <cstring>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -108,6 +112,105 @@ void Test_Resize()
     SaveImagePNG(img1, "Output/img1-resize-smaller.png");
 }
 
+// Measures the conversion of an image with the specified number of pixels and compares the result with a per-pixel reference conversion.
+void Test_ConvertEntry(
+    const char*         name,
+    LLGL::ImageFormat   srcFormat,
+    LLGL::DataType      srcDataType,
+    LLGL::ImageFormat   dstFormat,
+    LLGL::DataType      dstDataType,
+    std::size_t         numPixels)
+{
+    const std::size_t srcPixelSize = LLGL::GetMemoryFootprint(srcFormat, srcDataType, 1);
+    const std::size_t dstPixelSize = LLGL::GetMemoryFootprint(dstFormat, dstDataType, 1);
+
+    /* Fill source image with values within the normalized range [0, 1] */
+    std::vector<char> srcData(srcPixelSize * numPixels);
+    if (srcDataType == LLGL::DataType::Float32)
+    {
+        float* srcValues = reinterpret_cast<float*>(srcData.data());
+        for (std::size_t i = 0, n = srcData.size() / sizeof(float); i < n; ++i)
+            srcValues[i] = static_cast<float>(i % 1024) / 1023.0f;
+    }
+    else
+    {
+        for (std::size_t i = 0; i < srcData.size(); ++i)
+            srcData[i] = static_cast<char>((i * 37) & 0xFF);
+    }
+
+    std::vector<char> dstData(dstPixelSize * numPixels);
+
+    const LLGL::SrcImageDescriptor srcImageDesc{ srcFormat, srcDataType, srcData.data(), srcData.size() };
+    const LLGL::DstImageDescriptor dstImageDesc{ dstFormat, dstDataType, dstData.data(), dstData.size() };
+
+    /* Measure conversion time */
+    for (unsigned threadCount : { 1u, LLGL::Constants::maxThreadCount })
+    {
+        const std::uint64_t startTime = LLGL::Timer::Tick();
+        LLGL::ConvertImageBuffer(srcImageDesc, dstImageDesc, threadCount);
+        const std::uint64_t endTime = LLGL::Timer::Tick();
+
+        const double elapsedMS = static_cast<double>(endTime - startTime) * 1000.0 / static_cast<double>(LLGL::Timer::Frequency());
+        std::cout << name << " (" << (threadCount == 1 ? "single" : "multi") << "-threaded): " << elapsedMS << " ms" << std::endl;
+    }
+
+    /* Compare with reference conversion of the last pixels via 64-bit floats, which is not handled by any specialized kernel */
+    std::vector<char> tmpData(LLGL::GetMemoryFootprint(srcFormat, LLGL::DataType::Float64, 1));
+    std::vector<char> refData(dstPixelSize);
+
+    for (std::size_t i = numPixels - 64; i < numPixels; ++i)
+    {
+        const LLGL::SrcImageDescriptor pixelSrcDesc{ srcFormat, srcDataType, srcData.data() + i*srcPixelSize, srcPixelSize };
+        const LLGL::DstImageDescriptor tmpDstDesc{ srcFormat, LLGL::DataType::Float64, tmpData.data(), tmpData.size() };
+        LLGL::ConvertImageBuffer(pixelSrcDesc, tmpDstDesc, 1);
+
+        if (srcFormat == dstFormat)
+        {
+            const LLGL::SrcImageDescriptor tmpSrcDesc{ srcFormat, LLGL::DataType::Float64, tmpData.data(), tmpData.size() };
+            const LLGL::DstImageDescriptor refDstDesc{ dstFormat, dstDataType, refData.data(), refData.size() };
+            LLGL::ConvertImageBuffer(tmpSrcDesc, refDstDesc, 1);
+        }
+        else
+        {
+            /* Swizzle components manually for format conversions; a missing alpha channel is 1.0 */
+            std::vector<char> swizzledData(LLGL::GetMemoryFootprint(dstFormat, LLGL::DataType::Float64, 1));
+            const double* tmpValues = reinterpret_cast<const double*>(tmpData.data());
+            double* swizzledValues = reinterpret_cast<double*>(swizzledData.data());
+
+            auto IsBGR = [](LLGL::ImageFormat format) { return (format == LLGL::ImageFormat::BGR || format == LLGL::ImageFormat::BGRA); };
+            const bool swapRB = (IsBGR(srcFormat) != IsBGR(dstFormat));
+
+            for (std::size_t c = 0; c < LLGL::ImageFormatSize(dstFormat); ++c)
+            {
+                const std::size_t srcComponent = (swapRB && c != 1 && c != 3 ? 2 - c : c);
+                swizzledValues[c] = (srcComponent < LLGL::ImageFormatSize(srcFormat) ? tmpValues[srcComponent] : 1.0);
+            }
+
+            const LLGL::SrcImageDescriptor tmpSrcDesc{ dstFormat, LLGL::DataType::Float64, swizzledData.data(), swizzledData.size() };
+            const LLGL::DstImageDescriptor refDstDesc{ dstFormat, dstDataType, refData.data(), refData.size() };
+            LLGL::ConvertImageBuffer(tmpSrcDesc, refDstDesc, 1);
+        }
+
+        if (std::memcmp(refData.data(), dstData.data() + i*dstPixelSize, dstPixelSize) != 0)
+        {
+            std::cerr << name << ": mismatch at pixel " << i << std::endl;
+            return;
+        }
+    }
+}
+
+void Test_ConvertPerformance()
+{
+    constexpr std::size_t numPixels = 4096 * 4096;
+
+    Test_ConvertEntry("RGB8 -> RGBA8",      LLGL::ImageFormat::RGB,  LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   numPixels);
+    Test_ConvertEntry("BGRA8 -> RGBA8",     LLGL::ImageFormat::BGRA, LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   numPixels);
+    Test_ConvertEntry("RGBA8 -> BGR8",      LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   LLGL::ImageFormat::BGR,  LLGL::DataType::UInt8,   numPixels);
+    Test_ConvertEntry("RGBA8 -> RGBA16F",   LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::Float16, numPixels);
+    Test_ConvertEntry("RGBA8 -> RGBA32F",   LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::Float32, numPixels);
+    Test_ConvertEntry("RGBA32F -> RGBA8",   LLGL::ImageFormat::RGBA, LLGL::DataType::Float32, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   numPixels);
+}
+
 int main(int argc, char* argv[])
 {
     try
@@ -115,6 +218,7 @@ int main(int argc, char* argv[])
         //Test_PixelOperations();
         //Test_Blit();
         Test_Resize();
+        //Test_ConvertPerformance();
     }
     catch (const std::exception& e)
     {
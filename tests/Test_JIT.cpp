@@ -9,19 +9,92 @@
 #include <iostream>
 
 
-#if defined LLGL_ENABLE_JIT_COMPILER && defined LLGL_DEBUG
+#ifdef LLGL_ENABLE_JIT_COMPILER
 
+#ifdef LLGL_DEBUG
 namespace LLGL
 {
 LLGL_EXPORT void TestJIT1();
 }
+#endif
 
+// Records state changes that are neither merged nor eliminated, so both command buffers contain the same commands.
+static void RecordReplayCommands(LLGL::CommandBuffer& cmdBuffer, std::uint32_t numCommands)
+{
+    cmdBuffer.Begin();
+    {
+        for (std::uint32_t i = 0; i < numCommands; ++i)
+        {
+            cmdBuffer.SetViewport(LLGL::Viewport{ 0.0f, 0.0f, static_cast<float>(1 + i % 640), 480.0f });
+            cmdBuffer.SetStencilReference(i % 256);
+        }
+    }
+    cmdBuffer.End();
+}
+
+// Returns the average CPU time (in microseconds) to submit the specified command buffer.
+static double MeasureReplayTime(LLGL::CommandQueue& commandQueue, LLGL::CommandBuffer& cmdBuffer, std::uint32_t numSubmits)
+{
+    commandQueue.WaitIdle();
+
+    const std::uint64_t startTime = LLGL::Timer::Tick();
+    {
+        for (std::uint32_t i = 0; i < numSubmits; ++i)
+            commandQueue.Submit(cmdBuffer);
+    }
+    const std::uint64_t endTime = LLGL::Timer::Tick();
+
+    commandQueue.WaitIdle();
+
+    const double elapsedSeconds = static_cast<double>(endTime - startTime) / static_cast<double>(LLGL::Timer::Frequency());
+    return (elapsedSeconds * 1000000.0 / static_cast<double>(numSubmits));
+}
+
+static void BenchmarkGLReplay()
+{
+    constexpr std::uint32_t numCommands = 10000;
+    constexpr std::uint32_t numSubmits  = 100;
+
+    // Load OpenGL renderer and create swap-chain for the GL context
+    LLGL::RenderSystemPtr renderer = LLGL::RenderSystem::Load("OpenGL");
+
+    LLGL::SwapChainDescriptor swapChainDesc;
+    {
+        swapChainDesc.resolution = { 640, 480 };
+    }
+    renderer->CreateSwapChain(swapChainDesc);
+
+    LLGL::CommandQueue* commandQueue = renderer->GetCommandQueue();
+
+    // Multi-submit command buffers are JIT compiled, all other deferred command buffers are interpreted
+    LLGL::CommandBuffer* cmdBufferJIT       = renderer->CreateCommandBuffer(LLGL::CommandBufferFlags::MultiSubmit);
+    LLGL::CommandBuffer* cmdBufferInterp    = renderer->CreateCommandBuffer();
+
+    RecordReplayCommands(*cmdBufferJIT, numCommands);
+    RecordReplayCommands(*cmdBufferInterp, numCommands);
+
+    // Warm up both paths once before measuring
+    commandQueue->Submit(*cmdBufferJIT);
+    commandQueue->Submit(*cmdBufferInterp);
+
+    const double timeInterp = MeasureReplayTime(*commandQueue, *cmdBufferInterp, numSubmits);
+    const double timeJIT    = MeasureReplayTime(*commandQueue, *cmdBufferJIT, numSubmits);
+
+    std::cout << "replay of " << (numCommands * 2) << " GL commands (average of " << numSubmits << " submissions):" << std::endl;
+    std::cout << "\tinterpreter: " << timeInterp << "us" << std::endl;
+    std::cout << "\tJIT:         " << timeJIT << "us" << std::endl;
+    std::cout << "\tspeedup:     " << (timeJIT > 0.0 ? timeInterp / timeJIT : 0.0) << "x" << std::endl;
+}
 
 int main()
 {
     try
     {
+        #ifdef LLGL_DEBUG
         LLGL::TestJIT1();
+        #endif
+
+        BenchmarkGLReplay();
     }
     catch (const std::exception& e)
     {
@@ -40,3 +113,7 @@ int main()
 }
 
 #endif // /LLGL_ENABLE_JIT_COMPILER
+
+
+
+// ================================================================================
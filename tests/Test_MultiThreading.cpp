@@ -0,0 +1,499 @@
+/*
+ * Test_MultiThreading.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utils/Utility.h>
+#include <LLGL/Utils/Parse.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+
+/*
+Benchmark for multithreaded command recording.
+Records one primary command buffer per thread and submits all of them at once with CommandQueue::Submit(numCommandBuffers, ...).
+
+Usage: Test_MultiThreading [MODULE ...] [-threads=N] [-draws=N] [-resources=N] [-resource-switch=N] [-pipelines=N] [-pipeline-switch=N] [-frames=N]
+    MODULE             Renderer modules to benchmark, e.g. "OpenGL" or "Vulkan". By default all available modules.
+    -threads=N         Number of threads and command buffers. By default the number of hardware threads.
+    -draws=N           Number of draw commands per command buffer. By default 1000.
+    -resources=N       Number of distinct resource heaps. By default 4.
+    -resource-switch=N Number of draw commands after which the resource heap is switched. By default 1; 0 disables switching.
+    -pipelines=N       Number of distinct pipeline states. By default 4.
+    -pipeline-switch=N Number of draw commands after which the pipeline state is switched. By default 10; 0 disables switching.
+    -frames=N          Number of measured frames. By default 100.
+*/
+
+struct BenchmarkConfig
+{
+    std::uint32_t   numThreads              = 1;
+    std::uint32_t   numDrawsPerThread       = 1000;
+    std::uint32_t   numResourceHeaps        = 4;
+    std::uint32_t   resourceSwitchInterval  = 1;
+    std::uint32_t   numPipelines            = 4;
+    std::uint32_t   pipelineSwitchInterval  = 10;
+    std::uint32_t   numFrames               = 100;
+};
+
+struct BenchmarkResult
+{
+    double          recordTime              = 0.0; // Wall time of the parallel recording phase in milliseconds
+    double          recordTimePerThread     = 0.0; // Average recording time of a single thread in milliseconds
+    double          submitTime              = 0.0; // CPU time of CommandQueue::Submit in milliseconds
+    double          gpuTime                 = 0.0; // Sum of the GPU time of all command buffers in milliseconds
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double MillisecondsSince(Clock::time_point startTime)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+}
+
+class MultiThreadingBenchmark
+{
+
+    private:
+
+        struct Vertex
+        {
+            float position[3];
+            float normal[3];
+            float texCoord[2];
+        };
+
+        struct Scene
+        {
+            float wvpMatrix[16];
+            float wMatrix[16];
+            float solidColor[4];
+            float lightVec[3];
+            float pad0;
+        };
+
+    private:
+
+        LLGL::RenderSystemPtr               renderer;
+        LLGL::SwapChain*                    swapChain       = nullptr;
+        LLGL::CommandQueue*                 commandQueue    = nullptr;
+
+        LLGL::Buffer*                       vertexBuffer    = nullptr;
+        LLGL::PipelineLayout*               pipelineLayout  = nullptr;
+        LLGL::QueryHeap*                    timerQuery      = nullptr;
+
+        std::vector<LLGL::Buffer*>          constantBuffers;
+        std::vector<LLGL::ResourceHeap*>    resourceHeaps;
+        std::vector<LLGL::PipelineState*>   pipelines;
+        std::vector<LLGL::CommandBuffer*>   commandBuffers;
+
+        BenchmarkConfig                     config;
+
+    private:
+
+        bool IsShadingLanguageSupported(LLGL::ShadingLanguage language) const
+        {
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            return (std::find(languages.begin(), languages.end(), language) != languages.end());
+        }
+
+        LLGL::Shader* LoadShader(LLGL::ShaderType type, const std::string& filename, const LLGL::VertexFormat& vertexFormat, const char* entry = nullptr, const char* profile = nullptr)
+        {
+            const std::string filePath = "Testbed/Shaders/" + filename;
+            LLGL::ShaderDescriptor shaderDesc = LLGL::ShaderDescFromFile(type, filePath.c_str(), entry, profile);
+            if (type == LLGL::ShaderType::Vertex)
+                shaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+            LLGL::Shader* shader = renderer->CreateShader(shaderDesc);
+            if (const LLGL::Report* report = shader->GetReport())
+            {
+                if (report->HasErrors())
+                    throw std::runtime_error(report->GetText());
+            }
+            return shader;
+        }
+
+        void CreateResources()
+        {
+            // Create vertex buffer for a single triangle
+            LLGL::VertexFormat vertexFormat;
+            {
+                vertexFormat.AppendAttribute({ "position", LLGL::Format::RGB32Float });
+                vertexFormat.AppendAttribute({ "normal",   LLGL::Format::RGB32Float });
+                vertexFormat.AppendAttribute({ "texCoord", LLGL::Format::RG32Float  });
+            }
+
+            const Vertex vertices[] =
+            {
+                { { -1.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f } },
+                { {  0.0f, +1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.5f, 0.0f } },
+                { { +1.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 1.0f } },
+            };
+            vertexBuffer = renderer->CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices);
+
+            // Create one constant buffer and resource heap per resource set
+            pipelineLayout = renderer->CreatePipelineLayout(LLGL::Parse("cbuffer(Scene@1):vert:frag"));
+
+            for_range(i, config.numResourceHeaps)
+            {
+                const float scale = 0.1f;
+                const float x = -0.9f + 1.8f * static_cast<float>(i % 8) / 7.0f;
+                const float y = -0.9f + 1.8f * static_cast<float>(i / 8 % 8) / 7.0f;
+
+                // Column-major scale-translation matrix
+                Scene scene = {};
+                {
+                    scene.wvpMatrix[ 0] = scale;
+                    scene.wvpMatrix[ 5] = scale;
+                    scene.wvpMatrix[10] = 1.0f;
+                    scene.wvpMatrix[12] = x;
+                    scene.wvpMatrix[13] = y;
+                    scene.wvpMatrix[14] = 0.5f;
+                    scene.wvpMatrix[15] = 1.0f;
+                    scene.wMatrix[ 0]   = 1.0f;
+                    scene.wMatrix[ 5]   = 1.0f;
+                    scene.wMatrix[10]   = 1.0f;
+                    scene.wMatrix[15]   = 1.0f;
+                    scene.solidColor[0] = static_cast<float>((i + 1) % 2);
+                    scene.solidColor[1] = static_cast<float>((i + 1) / 2 % 2);
+                    scene.solidColor[2] = static_cast<float>((i + 1) / 4 % 2);
+                    scene.solidColor[3] = 1.0f;
+                    scene.lightVec[2]   = -1.0f;
+                }
+                LLGL::Buffer* constantBuffer = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(scene)), &scene);
+                constantBuffers.push_back(constantBuffer);
+
+                const LLGL::ResourceViewDescriptor resourceViews[] = { constantBuffer };
+                resourceHeaps.push_back(renderer->CreateResourceHeap(pipelineLayout, resourceViews));
+            }
+
+            // Load shaders for the current backend
+            LLGL::Shader* vertexShader      = nullptr;
+            LLGL::Shader* fragmentShader    = nullptr;
+
+            if (IsShadingLanguageSupported(LLGL::ShadingLanguage::HLSL))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "TriangleMesh.hlsl", vertexFormat, "VSMain", "vs_5_0");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "TriangleMesh.hlsl", vertexFormat, "PSMain", "ps_5_0");
+            }
+            else if (IsShadingLanguageSupported(LLGL::ShadingLanguage::GLSL))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "TriangleMesh.330core.vert", vertexFormat);
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "TriangleMesh.330core.frag", vertexFormat);
+            }
+            else if (IsShadingLanguageSupported(LLGL::ShadingLanguage::Metal))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "TriangleMesh.metal", vertexFormat, "VSMain", "1.1");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "TriangleMesh.metal", vertexFormat, "PSMain", "1.1");
+            }
+            else if (IsShadingLanguageSupported(LLGL::ShadingLanguage::SPIRV))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "TriangleMesh.450core.vert.spv", vertexFormat);
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "TriangleMesh.450core.frag.spv", vertexFormat);
+            }
+            else
+                throw std::runtime_error("no shaders provided for this backend");
+
+            // Create distinct pipeline states; the depth bias only differentiates their native PSOs
+            for_range(i, config.numPipelines)
+            {
+                LLGL::GraphicsPipelineDescriptor pipelineDesc;
+                {
+                    pipelineDesc.pipelineLayout                         = pipelineLayout;
+                    pipelineDesc.vertexShader                           = vertexShader;
+                    pipelineDesc.fragmentShader                         = fragmentShader;
+                    pipelineDesc.renderPass                             = swapChain->GetRenderPass();
+                    pipelineDesc.rasterizer.depthBias.constantFactor    = static_cast<float>(i);
+                }
+                LLGL::PipelineState* pipeline = renderer->CreatePipelineState(pipelineDesc);
+                if (const LLGL::Report* report = pipeline->GetReport())
+                {
+                    if (report->HasErrors())
+                        throw std::runtime_error(report->GetText());
+                }
+                pipelines.push_back(pipeline);
+            }
+
+            // Create one timer query per command buffer
+            LLGL::QueryHeapDescriptor queryDesc;
+            {
+                queryDesc.type          = LLGL::QueryType::TimeElapsed;
+                queryDesc.numQueries    = config.numThreads;
+            }
+            timerQuery = renderer->CreateQueryHeap(queryDesc);
+
+            // Create one primary command buffer per thread
+            for_range(i, config.numThreads)
+                commandBuffers.push_back(renderer->CreateCommandBuffer());
+        }
+
+        void RecordCommandBuffer(std::uint32_t threadIndex)
+        {
+            LLGL::CommandBuffer& cmdBuffer = *commandBuffers[threadIndex];
+
+            cmdBuffer.Begin();
+            {
+                cmdBuffer.BeginQuery(*timerQuery, threadIndex);
+                {
+                    cmdBuffer.SetVertexBuffer(*vertexBuffer);
+
+                    cmdBuffer.BeginRenderPass(*swapChain);
+                    {
+                        if (threadIndex == 0)
+                            cmdBuffer.Clear(LLGL::ClearFlags::Color);
+
+                        cmdBuffer.SetViewport(swapChain->GetResolution());
+
+                        std::uint32_t pipelineIndex = threadIndex % config.numPipelines;
+                        std::uint32_t resourceIndex = threadIndex % config.numResourceHeaps;
+
+                        cmdBuffer.SetPipelineState(*pipelines[pipelineIndex]);
+                        cmdBuffer.SetResourceHeap(*resourceHeaps[resourceIndex]);
+
+                        for_range(i, config.numDrawsPerThread)
+                        {
+                            if (i > 0)
+                            {
+                                /* Switching the PSO invalidates the resource bindings, so the heap is bound again after each pipeline switch */
+                                const bool switchPipeline = (config.pipelineSwitchInterval > 0 && i % config.pipelineSwitchInterval == 0);
+                                const bool switchResource = (config.resourceSwitchInterval > 0 && i % config.resourceSwitchInterval == 0);
+
+                                if (switchPipeline)
+                                {
+                                    pipelineIndex = (pipelineIndex + 1) % config.numPipelines;
+                                    cmdBuffer.SetPipelineState(*pipelines[pipelineIndex]);
+                                }
+                                if (switchResource)
+                                    resourceIndex = (resourceIndex + 1) % config.numResourceHeaps;
+                                if (switchPipeline || switchResource)
+                                    cmdBuffer.SetResourceHeap(*resourceHeaps[resourceIndex]);
+                            }
+                            cmdBuffer.Draw(3, 0);
+                        }
+                    }
+                    cmdBuffer.EndRenderPass();
+                }
+                cmdBuffer.EndQuery(*timerQuery, threadIndex);
+            }
+            cmdBuffer.End();
+        }
+
+        void RecordCommandBuffersAndMeasureTime(double* outThreadTimes)
+        {
+            std::vector<std::thread> workerThreads;
+            workerThreads.reserve(config.numThreads);
+
+            for_range(i, config.numThreads)
+            {
+                workerThreads.emplace_back(
+                    [this, i, outThreadTimes]()
+                    {
+                        const Clock::time_point startTime = Clock::now();
+                        RecordCommandBuffer(i);
+                        outThreadTimes[i] = MillisecondsSince(startTime);
+                    }
+                );
+            }
+
+            for (std::thread& thread : workerThreads)
+                thread.join();
+        }
+
+        double QueryGPUTime()
+        {
+            std::vector<std::uint64_t> results(config.numThreads, 0);
+            while (!commandQueue->QueryResult(*timerQuery, 0, config.numThreads, results.data(), results.size() * sizeof(std::uint64_t)))
+            {
+                /* wait until the results are available */
+            }
+
+            std::uint64_t totalTime = 0;
+            for (std::uint64_t result : results)
+                totalTime += result;
+
+            return (static_cast<double>(totalTime) / 1000000.0);
+        }
+
+    public:
+
+        void Load(const std::string& rendererModule, const BenchmarkConfig& benchmarkConfig)
+        {
+            config = benchmarkConfig;
+
+            // Load renderer
+            renderer = LLGL::RenderSystem::Load(rendererModule);
+
+            // Create swap-chain without vsync, so the presentation does not throttle the measurement
+            LLGL::SwapChainDescriptor swapChainDesc;
+            {
+                swapChainDesc.resolution = { 800, 600 };
+            }
+            swapChain = renderer->CreateSwapChain(swapChainDesc);
+            swapChain->SetVsyncInterval(0);
+
+            commandQueue = renderer->GetCommandQueue();
+
+            CreateResources();
+        }
+
+        void Unload()
+        {
+            LLGL::RenderSystem::Unload(std::move(renderer));
+        }
+
+        BenchmarkResult Run()
+        {
+            BenchmarkResult result;
+
+            std::vector<double> threadTimes(config.numThreads, 0.0);
+
+            for_range(frame, config.numFrames + 1)
+            {
+                // Record all command buffers in parallel
+                const Clock::time_point recordStartTime = Clock::now();
+                RecordCommandBuffersAndMeasureTime(threadTimes.data());
+                const double recordTime = MillisecondsSince(recordStartTime);
+
+                // Submit all command buffers at once
+                const Clock::time_point submitStartTime = Clock::now();
+                commandQueue->Submit(config.numThreads, commandBuffers.data());
+                const double submitTime = MillisecondsSince(submitStartTime);
+
+                swapChain->Present();
+
+                // Wait for GPU; this also ensures the command buffers can be recorded again in the next frame
+                const double gpuTime = QueryGPUTime();
+                commandQueue->WaitIdle();
+
+                // Skip first frame to exclude one-time initialization costs from the measurement
+                if (frame > 0)
+                {
+                    double threadTimeSum = 0.0;
+                    for (double threadTime : threadTimes)
+                        threadTimeSum += threadTime;
+
+                    result.recordTime           += recordTime;
+                    result.recordTimePerThread  += threadTimeSum / static_cast<double>(config.numThreads);
+                    result.submitTime           += submitTime;
+                    result.gpuTime              += gpuTime;
+                }
+            }
+
+            const double numFrames = static_cast<double>(std::max(1u, config.numFrames));
+            result.recordTime           /= numFrames;
+            result.recordTimePerThread  /= numFrames;
+            result.submitTime           /= numFrames;
+            result.gpuTime              /= numFrames;
+
+            return result;
+        }
+
+        std::string GetRendererName() const
+        {
+            return renderer->GetName();
+        }
+
+};
+
+static bool ParseArgument(const char* arg, const char* name, std::uint32_t& outValue)
+{
+    const std::size_t nameLen = std::strlen(name);
+    if (std::strncmp(arg, name, nameLen) == 0 && arg[nameLen] == '=')
+    {
+        outValue = static_cast<std::uint32_t>(std::strtoul(arg + nameLen + 1, nullptr, 10));
+        return true;
+    }
+    return false;
+}
+
+static void PrintResult(const std::string& rendererName, const BenchmarkResult& result)
+{
+    std::cout << rendererName << ":\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\tCPU recording time:            " << result.recordTime << " ms\n";
+    std::cout << "\tCPU recording time per thread: " << result.recordTimePerThread << " ms\n";
+    std::cout << "\tCPU submit time:               " << result.submitTime << " ms\n";
+    std::cout << "\tGPU time:                      " << result.gpuTime << " ms\n";
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkConfig config;
+    config.numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::string> rendererModules;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (arg[0] != '-')
+            rendererModules.push_back(arg);
+        else if (!( ParseArgument(arg, "-threads",          config.numThreads            ) ||
+                    ParseArgument(arg, "-draws",            config.numDrawsPerThread     ) ||
+                    ParseArgument(arg, "-resources",        config.numResourceHeaps      ) ||
+                    ParseArgument(arg, "-resource-switch",  config.resourceSwitchInterval) ||
+                    ParseArgument(arg, "-pipelines",        config.numPipelines          ) ||
+                    ParseArgument(arg, "-pipeline-switch",  config.pipelineSwitchInterval) ||
+                    ParseArgument(arg, "-frames",           config.numFrames             ) ))
+        {
+            std::cerr << "unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    config.numThreads       = std::max(1u, config.numThreads);
+    config.numResourceHeaps = std::max(1u, config.numResourceHeaps);
+    config.numPipelines     = std::max(1u, config.numPipelines);
+
+    // Benchmark all available renderer modules by default
+    if (rendererModules.empty())
+    {
+        for (const std::string& module : LLGL::RenderSystem::FindModules())
+        {
+            if (module != "Null")
+                rendererModules.push_back(module);
+        }
+    }
+
+    std::cout << "benchmark multithreaded command recording:\n";
+    std::cout << "\tthreads:         " << config.numThreads << '\n';
+    std::cout << "\tdraws/thread:    " << config.numDrawsPerThread << '\n';
+    std::cout << "\tresource heaps:  " << config.numResourceHeaps << " (switch every " << config.resourceSwitchInterval << " draws)\n";
+    std::cout << "\tpipeline states: " << config.numPipelines << " (switch every " << config.pipelineSwitchInterval << " draws)\n";
+    std::cout << "\tframes:          " << config.numFrames << '\n';
+    std::cout << std::endl;
+
+    for (const std::string& module : rendererModules)
+    {
+        try
+        {
+            MultiThreadingBenchmark benchmark;
+            benchmark.Load(module, config);
+            const BenchmarkResult result = benchmark.Run();
+            PrintResult(benchmark.GetRendererName(), result);
+            benchmark.Unload();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << module << ": " << e.what() << std::endl;
+        }
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
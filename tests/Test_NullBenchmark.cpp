@@ -0,0 +1,578 @@
+/*
+ * Test_NullBenchmark.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utils/Parse.h>
+#include <LLGL/Utils/Utility.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+CPU overhead benchmark for build agents without GPU.
+Runs the draw-throughput and resource-churn scenarios against the Null renderer, which executes all commands on the CPU
+with a fixed synthetic cost per command, so the measured time only varies with the CPU paths of LLGL itself.
+No window is created; all draws are rendered into an offscreen render target.
+
+Usage: Test_NullBenchmark [--draws=N] [--churn=N] [--runs=N] [--validate] [--csv=FILE] [--baseline=FILE] [--tolerance=PERCENT]
+                          [--draw-cost=NS] [--dispatch-cost=NS] [--state-cost=NS] [--pass-cost=NS] [--submit-cost=NS] [--transfer-cost=NS]
+
+With --baseline, the results are compared against a CSV file that was previously written with --csv,
+and the process exits with a non-zero code if any case is slower than its baseline by more than the tolerance (10% by default).
+With --validate, the Null renderer validates each command buffer and the process fails on any validation error.
+*/
+
+enum class DrawCase
+{
+    Draw,
+    DrawIndexed,
+    PipelineState,
+    ResourceHeap,
+    Resource,
+    VertexBuffer,
+    Uniforms,
+    All,
+};
+
+enum class ChurnCase
+{
+    CreateBuffer,
+    CreateTexture,
+    CreateResourceHeap,
+    WriteResourceHeap,
+    WriteBuffer,
+    UpdateBuffer,
+};
+
+struct DrawCaseEntry
+{
+    const char* name;
+    DrawCase    drawCase;
+};
+
+struct ChurnCaseEntry
+{
+    const char* name;
+    ChurnCase   churnCase;
+};
+
+static const DrawCaseEntry g_drawCases[] =
+{
+    { "Draw",               DrawCase::Draw          },
+    { "DrawIndexed",        DrawCase::DrawIndexed   },
+    { "SetPipelineState",   DrawCase::PipelineState },
+    { "SetResourceHeap",    DrawCase::ResourceHeap  },
+    { "SetResource",        DrawCase::Resource      },
+    { "SetVertexBuffer",    DrawCase::VertexBuffer  },
+    { "SetUniforms",        DrawCase::Uniforms      },
+    { "All",                DrawCase::All           },
+};
+
+static const ChurnCaseEntry g_churnCases[] =
+{
+    { "CreateBuffer",       ChurnCase::CreateBuffer         },
+    { "CreateTexture",      ChurnCase::CreateTexture        },
+    { "CreateResourceHeap", ChurnCase::CreateResourceHeap   },
+    { "WriteResourceHeap",  ChurnCase::WriteResourceHeap    },
+    { "WriteBuffer",        ChurnCase::WriteBuffer          },
+    { "UpdateBuffer",       ChurnCase::UpdateBuffer         },
+};
+
+struct BenchmarkConfig
+{
+    std::uint32_t numDraws      = 1000000;
+    std::uint32_t drawsPerBatch = 10000;
+    std::uint32_t numChurnOps   = 20000;
+    std::uint32_t numRuns       = 5; // Only the fastest run is recorded to reduce noise
+};
+
+struct BenchmarkResult
+{
+    std::string scenario;
+    std::string name;
+    double      nsPerOp;
+};
+
+class NullBenchmark
+{
+
+    private:
+
+        LLGL::RenderSystemPtr   renderer;
+        LLGL::CommandQueue*     commandQueue        = nullptr;
+        LLGL::CommandBuffer*    commands            = nullptr;
+        LLGL::Texture*          colorTarget         = nullptr;
+        LLGL::RenderTarget*     renderTarget        = nullptr;
+
+        LLGL::PipelineLayout*   pipelineLayout      = nullptr;
+        LLGL::PipelineState*    pipelines[2]        = {};
+        LLGL::ResourceHeap*     resourceHeaps[2]    = {};
+        LLGL::Buffer*           sceneBuffers[2]     = {};
+        LLGL::Buffer*           objectBuffers[2]    = {};
+        LLGL::Buffer*           vertexBuffers[2]    = {};
+        LLGL::Buffer*           indexBuffer         = nullptr;
+
+    private:
+
+        LLGL::Buffer* CreateConstantBuffer(float x, float y)
+        {
+            const float data[4] = { x, y, 0.0f, 0.0f };
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size         = sizeof(data);
+                bufferDesc.bindFlags    = LLGL::BindFlags::ConstantBuffer;
+            }
+            return renderer->CreateBuffer(bufferDesc, data);
+        }
+
+        LLGL::Buffer* CreateVertexBuffer(const LLGL::VertexFormat& vertexFormat, float scale)
+        {
+            const float vertices[] =
+            {
+                 0.0f,  scale,
+                 scale, -scale,
+                -scale, -scale,
+            };
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size             = sizeof(vertices);
+                bufferDesc.bindFlags        = LLGL::BindFlags::VertexBuffer;
+                bufferDesc.vertexAttribs    = vertexFormat.attributes;
+            }
+            return renderer->CreateBuffer(bufferDesc, vertices);
+        }
+
+        LLGL::Shader* CreateShader(LLGL::ShaderType type, const LLGL::VertexFormat& vertexFormat)
+        {
+            // The Null renderer does not compile shaders, so any source is accepted
+            LLGL::ShaderDescriptor shaderDesc;
+            {
+                shaderDesc.type         = type;
+                shaderDesc.source       = "void main() {}";
+                shaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+            }
+            if (type == LLGL::ShaderType::Vertex)
+                shaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+            return renderer->CreateShader(shaderDesc);
+        }
+
+        void BindInitialStates(LLGL::CommandBuffer& cmdBuffer)
+        {
+            const float tint[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            cmdBuffer.SetViewport(renderTarget->GetResolution());
+            cmdBuffer.SetPipelineState(*pipelines[0]);
+            cmdBuffer.SetResourceHeap(*resourceHeaps[0]);
+            cmdBuffer.SetResource(0, *objectBuffers[0]);
+            cmdBuffer.SetVertexBuffer(*vertexBuffers[0]);
+            cmdBuffer.SetIndexBuffer(*indexBuffer);
+            cmdBuffer.SetUniforms(0, tint, sizeof(tint));
+        }
+
+        void EncodeDraws(LLGL::CommandBuffer& cmdBuffer, DrawCase drawCase, std::uint32_t numDraws)
+        {
+            const float tints[2][4] =
+            {
+                { 1.0f, 0.5f, 0.0f, 1.0f },
+                { 0.0f, 0.5f, 1.0f, 1.0f },
+            };
+
+            for (std::uint32_t i = 0; i < numDraws; ++i)
+            {
+                const std::uint32_t alt = (i & 1u);
+                switch (drawCase)
+                {
+                    case DrawCase::Draw:
+                    case DrawCase::DrawIndexed:
+                        break;
+                    case DrawCase::PipelineState:
+                        cmdBuffer.SetPipelineState(*pipelines[alt]);
+                        break;
+                    case DrawCase::ResourceHeap:
+                        cmdBuffer.SetResourceHeap(*resourceHeaps[alt]);
+                        break;
+                    case DrawCase::Resource:
+                        cmdBuffer.SetResource(0, *objectBuffers[alt]);
+                        break;
+                    case DrawCase::VertexBuffer:
+                        cmdBuffer.SetVertexBuffer(*vertexBuffers[alt]);
+                        break;
+                    case DrawCase::Uniforms:
+                        cmdBuffer.SetUniforms(0, tints[alt], sizeof(tints[alt]));
+                        break;
+                    case DrawCase::All:
+                        cmdBuffer.SetPipelineState(*pipelines[alt]);
+                        cmdBuffer.SetResourceHeap(*resourceHeaps[alt]);
+                        cmdBuffer.SetResource(0, *objectBuffers[alt]);
+                        cmdBuffer.SetVertexBuffer(*vertexBuffers[alt]);
+                        cmdBuffer.SetUniforms(0, tints[alt], sizeof(tints[alt]));
+                        break;
+                }
+                if (drawCase == DrawCase::DrawIndexed)
+                    cmdBuffer.DrawIndexed(3, 0);
+                else
+                    cmdBuffer.Draw(3, 0);
+            }
+        }
+
+        // Runs a single resource churn operation.
+        void RunChurnOp(ChurnCase churnCase, std::uint32_t iteration)
+        {
+            const float data[4] = { static_cast<float>(iteration), 0.0f, 0.0f, 1.0f };
+
+            switch (churnCase)
+            {
+                case ChurnCase::CreateBuffer:
+                {
+                    LLGL::Buffer* buffer = CreateConstantBuffer(data[0], data[1]);
+                    renderer->Release(*buffer);
+                }
+                break;
+
+                case ChurnCase::CreateTexture:
+                {
+                    static const std::uint32_t texels[16 * 16] = {};
+                    LLGL::TextureDescriptor textureDesc;
+                    {
+                        textureDesc.format  = LLGL::Format::RGBA8UNorm;
+                        textureDesc.extent  = { 16, 16, 1 };
+                    }
+                    LLGL::SrcImageDescriptor imageView;
+                    {
+                        imageView.format    = LLGL::ImageFormat::RGBA;
+                        imageView.dataType  = LLGL::DataType::UInt8;
+                        imageView.data      = texels;
+                        imageView.dataSize  = sizeof(texels);
+                    }
+                    LLGL::Texture* texture = renderer->CreateTexture(textureDesc, &imageView);
+                    renderer->Release(*texture);
+                }
+                break;
+
+                case ChurnCase::CreateResourceHeap:
+                {
+                    LLGL::ResourceHeap* resourceHeap = renderer->CreateResourceHeap(pipelineLayout, { sceneBuffers[iteration & 1u] });
+                    renderer->Release(*resourceHeap);
+                }
+                break;
+
+                case ChurnCase::WriteResourceHeap:
+                {
+                    renderer->WriteResourceHeap(*resourceHeaps[0], 0, { sceneBuffers[iteration & 1u] });
+                }
+                break;
+
+                case ChurnCase::WriteBuffer:
+                {
+                    renderer->WriteBuffer(*objectBuffers[0], 0, data, sizeof(data));
+                }
+                break;
+
+                case ChurnCase::UpdateBuffer:
+                {
+                    commands->Begin();
+                    commands->UpdateBuffer(*objectBuffers[0], 0, data, sizeof(data));
+                    commands->End();
+                    commandQueue->Submit(*commands);
+                }
+                break;
+            }
+        }
+
+    public:
+
+        bool Load(const LLGL::RendererConfigurationNull& rendererConfig)
+        {
+            LLGL::RenderSystemDescriptor rendererDesc;
+            {
+                rendererDesc.moduleName         = "Null";
+                rendererDesc.rendererConfig     = &rendererConfig;
+                rendererDesc.rendererConfigSize = sizeof(rendererConfig);
+            }
+            renderer = LLGL::RenderSystem::Load(rendererDesc);
+            if (!renderer)
+                return false;
+
+            commands        = renderer->CreateCommandBuffer();
+            commandQueue    = renderer->GetCommandQueue();
+
+            // Create offscreen render target, so no window or display is required
+            LLGL::TextureDescriptor colorTargetDesc;
+            {
+                colorTargetDesc.bindFlags   = LLGL::BindFlags::ColorAttachment;
+                colorTargetDesc.format      = LLGL::Format::RGBA8UNorm;
+                colorTargetDesc.extent      = { 320, 240, 1 };
+                colorTargetDesc.mipLevels   = 1;
+            }
+            colorTarget = renderer->CreateTexture(colorTargetDesc);
+
+            LLGL::RenderTargetDescriptor renderTargetDesc;
+            {
+                renderTargetDesc.resolution         = { 320, 240 };
+                renderTargetDesc.colorAttachments[0] = colorTarget;
+            }
+            renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+            // Create the same pipeline layout and resources as the draw benchmark
+            pipelineLayout = renderer->CreatePipelineLayout(
+                LLGL::Parse("heap{cbuffer(Scene@1):vert}, cbuffer(Object@2):vert, float4(tint)")
+            );
+
+            LLGL::VertexFormat vertexFormat;
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+            for (int i = 0; i < 2; ++i)
+            {
+                sceneBuffers[i]     = CreateConstantBuffer(0.01f * i, 0.0f);
+                objectBuffers[i]    = CreateConstantBuffer(0.0f, 0.01f * i);
+                vertexBuffers[i]    = CreateVertexBuffer(vertexFormat, 0.01f + 0.005f * i);
+                resourceHeaps[i]    = renderer->CreateResourceHeap(pipelineLayout, { sceneBuffers[i] });
+            }
+
+            const std::uint16_t indices[3] = { 0, 1, 2 };
+            indexBuffer = renderer->CreateBuffer(LLGL::IndexBufferDesc(sizeof(indices), LLGL::Format::R16UInt), indices);
+
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.vertexShader       = CreateShader(LLGL::ShaderType::Vertex, vertexFormat);
+                pipelineDesc.fragmentShader     = CreateShader(LLGL::ShaderType::Fragment, vertexFormat);
+                pipelineDesc.pipelineLayout     = pipelineLayout;
+                pipelineDesc.renderPass         = renderTarget->GetRenderPass();
+            }
+            for (int i = 0; i < 2; ++i)
+            {
+                pipelineDesc.blend.targets[0].blendEnabled = (i == 1);
+                pipelines[i] = renderer->CreatePipelineState(pipelineDesc);
+            }
+
+            return true;
+        }
+
+        // Returns the CPU time in nanoseconds per draw, including its state changes and the command buffer submission.
+        double RunDraws(DrawCase drawCase, const BenchmarkConfig& config)
+        {
+            double bestTime = 0.0;
+
+            for (std::uint32_t run = 0; run < config.numRuns; ++run)
+            {
+                const std::uint64_t startTime = LLGL::Timer::Tick();
+
+                for (std::uint32_t firstDraw = 0; firstDraw < config.numDraws; firstDraw += config.drawsPerBatch)
+                {
+                    const std::uint32_t numDraws = std::min(config.drawsPerBatch, config.numDraws - firstDraw);
+                    commands->Begin();
+                    {
+                        commands->BeginRenderPass(*renderTarget);
+                        {
+                            BindInitialStates(*commands);
+                            EncodeDraws(*commands, drawCase, numDraws);
+                        }
+                        commands->EndRenderPass();
+                    }
+                    commands->End();
+                    commandQueue->Submit(*commands);
+                }
+
+                const std::uint64_t elapsedTicks = LLGL::Timer::Tick() - startTime;
+                const double nsPerDraw = (static_cast<double>(elapsedTicks) * 1.0e9) / (static_cast<double>(LLGL::Timer::Frequency()) * static_cast<double>(config.numDraws));
+                if (run == 0 || nsPerDraw < bestTime)
+                    bestTime = nsPerDraw;
+            }
+
+            return bestTime;
+        }
+
+        // Returns the CPU time in nanoseconds per resource churn operation.
+        double RunChurn(ChurnCase churnCase, const BenchmarkConfig& config)
+        {
+            double bestTime = 0.0;
+
+            for (std::uint32_t run = 0; run < config.numRuns; ++run)
+            {
+                const std::uint64_t startTime = LLGL::Timer::Tick();
+
+                for (std::uint32_t i = 0; i < config.numChurnOps; ++i)
+                    RunChurnOp(churnCase, i);
+
+                const std::uint64_t elapsedTicks = LLGL::Timer::Tick() - startTime;
+                const double nsPerOp = (static_cast<double>(elapsedTicks) * 1.0e9) / (static_cast<double>(LLGL::Timer::Frequency()) * static_cast<double>(config.numChurnOps));
+                if (run == 0 || nsPerOp < bestTime)
+                    bestTime = nsPerOp;
+            }
+
+            return bestTime;
+        }
+
+};
+
+static const char* FindArgumentValue(int argc, char* argv[], const char* search)
+{
+    const std::size_t searchLen = ::strlen(search);
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strncmp(argv[i], search, searchLen) == 0)
+            return argv[i] + searchLen;
+    }
+    return nullptr;
+}
+
+static std::uint32_t FindArgumentUInt(int argc, char* argv[], const char* search, std::uint32_t defaultValue, std::uint32_t minValue = 1)
+{
+    if (const char* value = FindArgumentValue(argc, argv, search))
+        return std::max(minValue, static_cast<std::uint32_t>(::strtoul(value, nullptr, 10)));
+    return defaultValue;
+}
+
+static bool HasArgument(int argc, char* argv[], const char* search)
+{
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strcmp(argv[i], search) == 0)
+            return true;
+    }
+    return false;
+}
+
+static void SaveResultsCSV(const std::vector<BenchmarkResult>& results, const char* filename)
+{
+    std::ofstream file{ filename };
+    if (!file.good())
+    {
+        LLGL::Log::Errorf("Failed to write CSV file: %s\n", filename);
+        return;
+    }
+
+    file << "scenario,case,nsPerOp\n";
+    for (const BenchmarkResult& result : results)
+        file << result.scenario << ',' << result.name << ',' << result.nsPerOp << '\n';
+}
+
+// Compares the results against a baseline CSV file and returns the number of regressions.
+static int CompareWithBaseline(const std::vector<BenchmarkResult>& results, const char* filename, double tolerance)
+{
+    std::ifstream file{ filename };
+    if (!file.good())
+    {
+        LLGL::Log::Errorf("Failed to read baseline CSV file: %s\n", filename);
+        return 1;
+    }
+
+    int numRegressions = 0;
+
+    std::string line;
+    std::getline(file, line); // Skip header
+    while (std::getline(file, line))
+    {
+        std::stringstream lineStream{ line };
+        std::string scenario, name, value;
+        if (!std::getline(lineStream, scenario, ',') || !std::getline(lineStream, name, ',') || !std::getline(lineStream, value))
+            continue;
+
+        const double baselineNs = ::strtod(value.c_str(), nullptr);
+        for (const BenchmarkResult& result : results)
+        {
+            if (result.scenario == scenario && result.name == name)
+            {
+                const double deltaPercent = (baselineNs > 0.0 ? (result.nsPerOp - baselineNs) * 100.0 / baselineNs : 0.0);
+                if (deltaPercent > tolerance)
+                {
+                    LLGL::Log::Errorf("Regression: %s/%s: %.1f ns (baseline %.1f ns, %+.1f%%)\n", scenario.c_str(), name.c_str(), result.nsPerOp, baselineNs, deltaPercent);
+                    ++numRegressions;
+                }
+                break;
+            }
+        }
+    }
+
+    return numRegressions;
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    // Count all errors, including the validation errors of the Null renderer
+    static std::atomic<int> numErrors{ 0 };
+    LLGL::Log::RegisterCallback(
+        [](LLGL::Log::ReportType type, const char* /*text*/, void* /*userData*/)
+        {
+            if (type == LLGL::Log::ReportType::Error)
+                ++numErrors;
+        }
+    );
+
+    BenchmarkConfig config;
+    {
+        config.numDraws         = FindArgumentUInt(argc, argv, "--draws=", config.numDraws);
+        config.drawsPerBatch    = FindArgumentUInt(argc, argv, "--batch=", config.drawsPerBatch);
+        config.numChurnOps      = FindArgumentUInt(argc, argv, "--churn=", config.numChurnOps);
+        config.numRuns          = FindArgumentUInt(argc, argv, "--runs=",  config.numRuns);
+    }
+
+    LLGL::RendererConfigurationNull rendererConfig;
+    {
+        rendererConfig.validateCommands     = HasArgument(argc, argv, "--validate");
+        rendererConfig.drawCost             = FindArgumentUInt(argc, argv, "--draw-cost=",       rendererConfig.drawCost,          0);
+        rendererConfig.dispatchCost         = FindArgumentUInt(argc, argv, "--dispatch-cost=",   rendererConfig.dispatchCost,      0);
+        rendererConfig.stateChangeCost      = FindArgumentUInt(argc, argv, "--state-cost=",      rendererConfig.stateChangeCost,   0);
+        rendererConfig.renderPassCost       = FindArgumentUInt(argc, argv, "--pass-cost=",       rendererConfig.renderPassCost,    0);
+        rendererConfig.submitCost           = FindArgumentUInt(argc, argv, "--submit-cost=",     rendererConfig.submitCost,        0);
+        rendererConfig.transferCostPerKB    = FindArgumentUInt(argc, argv, "--transfer-cost=",   rendererConfig.transferCostPerKB, 0);
+    }
+
+    LLGL::Log::Printf(
+        "Run Null benchmark (%u draws, %u per batch, %u churn operations%s)\n",
+        config.numDraws, config.drawsPerBatch, config.numChurnOps, (rendererConfig.validateCommands ? ", validated" : "")
+    );
+
+    NullBenchmark benchmark;
+    if (!benchmark.Load(rendererConfig))
+    {
+        LLGL::Log::Errorf("Failed to load Null renderer\n");
+        return 1;
+    }
+
+    std::vector<BenchmarkResult> results;
+
+    for (const DrawCaseEntry& entry : g_drawCases)
+        results.push_back(BenchmarkResult{ "draw", entry.name, benchmark.RunDraws(entry.drawCase, config) });
+
+    for (const ChurnCaseEntry& entry : g_churnCases)
+        results.push_back(BenchmarkResult{ "churn", entry.name, benchmark.RunChurn(entry.churnCase, config) });
+
+    LLGL::Log::Printf("\n%-8s %-22s %12s\n", "Scenario", "Case", "ns/op");
+    for (const BenchmarkResult& result : results)
+        LLGL::Log::Printf("%-8s %-22s %12.1f\n", result.scenario.c_str(), result.name.c_str(), result.nsPerOp);
+
+    if (const char* csvFilename = FindArgumentValue(argc, argv, "--csv="))
+        SaveResultsCSV(results, csvFilename);
+
+    // Validation errors or failures are counted before the comparison, since a regression is reported as error as well
+    int exitCode = (numErrors > 0 ? 1 : 0);
+
+    if (const char* baselineFilename = FindArgumentValue(argc, argv, "--baseline="))
+    {
+        const char* toleranceValue = FindArgumentValue(argc, argv, "--tolerance=");
+        const double tolerance = (toleranceValue != nullptr ? ::strtod(toleranceValue, nullptr) : 10.0);
+        if (CompareWithBaseline(results, baselineFilename, tolerance) > 0)
+            exitCode = 1;
+    }
+
+    return exitCode;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,646 @@
+/*
+ * Test_PipelineBenchmark.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utils/Parse.h>
+#include <LLGL/Utils/Utility.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <Windows.h>
+#   include <psapi.h>
+#   include <direct.h>
+#   ifdef _MSC_VER
+#       pragma comment(lib, "psapi.lib")
+#   endif
+#else
+#   include <sys/resource.h>
+#   include <sys/stat.h>
+#endif
+
+
+/*
+Startup-time and PSO creation benchmark.
+Measures the time from RenderSystem::Load to the first presented frame for each backend, including the creation of N shaders and PSOs,
+and reports the peak resident set size (RSS) of the process. Each run is executed in a separate child process, so nothing is shared between runs
+other than the cache files on disk.
+
+Usage: Test_PipelineBenchmark [MODULES...] [--shaders=N] [--psos=N] [--mode=cold|warm|both] [--cache-dir=DIR] [--csv=FILE]
+
+In cold mode, all caches of a module are discarded and the shader sources are salted with a new macro, so neither LLGL nor the driver can hit a previous cache.
+The caches are written to the cache directory at the end of a cold run and a warm run reuses them with the same salt:
+- Per-PSO serialized caches (i.e. the Blob of CreatePipelineState), which restore program binaries in OpenGL and binary archives in Metal.
+- The device-wide pipeline cache (RenderSystem::GetPipelineCache) for Vulkan and the pipeline library for Direct3D 12.
+- The shader bytecode cache (shaderCachePath) for Direct3D 11 and Direct3D 12.
+*/
+
+enum class CacheMode
+{
+    Cold,
+    Warm,
+};
+
+struct BenchmarkConfig
+{
+    std::uint32_t   numShaders  = 16;   // Number of distinct vertex and fragment shader pairs
+    std::uint32_t   numPSOs     = 64;   // Number of distinct PSOs, which iterate over all shader pairs
+    std::string     cacheDir    = "PipelineBenchmarkCache";
+};
+
+struct BenchmarkResult
+{
+    std::string     moduleName;
+    std::string     mode;
+    double          loadMs;
+    double          swapChainMs;
+    double          shadersMs;
+    double          psosMs;
+    double          firstFrameMs;
+    double          totalMs;
+    double          peakRSSMB;
+    std::uint64_t   cacheBytes; // Size of all cache data that was read (warm) or written (cold)
+};
+
+static double TicksToMs(std::uint64_t ticks)
+{
+    return (static_cast<double>(ticks) * 1000.0 / static_cast<double>(LLGL::Timer::Frequency()));
+}
+
+// Returns the peak resident set size of this process in MB.
+static double GetPeakRSSMB()
+{
+    #if defined _WIN32
+    PROCESS_MEMORY_COUNTERS memCounters = {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters)))
+        return static_cast<double>(memCounters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+    return 0.0;
+    #else
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0.0;
+    #   if defined __APPLE__
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0); // Bytes on macOS
+    #   else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0; // Kilobytes on Linux
+    #   endif
+    #endif
+}
+
+static void MakeDirectory(const std::string& path)
+{
+    #ifdef _WIN32
+    _mkdir(path.c_str());
+    #else
+    mkdir(path.c_str(), 0755);
+    #endif
+}
+
+static bool WriteFile(const std::string& filename, const void* data, std::size_t size)
+{
+    std::ofstream file{ filename, std::ios::out | std::ios::binary };
+    if (!file.good())
+        return false;
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return true;
+}
+
+class PipelineBenchmark
+{
+
+    private:
+
+        const BenchmarkConfig&              config;
+        const std::string                   moduleName;
+        const CacheMode                     mode;
+        const std::string                   moduleCacheDir;
+
+        std::string                         salt;
+        std::string                         shaderCachePath;
+        std::vector<LLGL::Blob>             psoCaches;
+        LLGL::Blob                          deviceCache;
+        std::uint64_t                       cacheBytes      = 0;
+
+        LLGL::RenderSystemPtr               renderer;
+        LLGL::SwapChain*                    swapChain       = nullptr;
+        LLGL::PipelineLayout*               pipelineLayout  = nullptr;
+        std::vector<LLGL::Shader*>          shaders;
+        std::vector<LLGL::PipelineState*>   pipelines;
+
+    private:
+
+        bool Supported(LLGL::ShadingLanguage language) const
+        {
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            return (std::find(languages.begin(), languages.end(), language) != languages.end());
+        }
+
+        std::string GetPSOCacheFilename(std::uint32_t index) const
+        {
+            return (moduleCacheDir + "/PSO" + std::to_string(index) + ".bin");
+        }
+
+        // Discards the previous caches in cold mode or reads them in warm mode.
+        void PrepareCaches()
+        {
+            MakeDirectory(config.cacheDir);
+            MakeDirectory(moduleCacheDir);
+
+            const std::string saltFilename = moduleCacheDir + "/Salt.txt";
+            psoCaches.resize(config.numPSOs);
+
+            if (mode == CacheMode::Cold)
+            {
+                /* Salt shader sources with a new value, so the shader cache directory and driver caches can't match any previous run */
+                salt = std::to_string(LLGL::Timer::Tick());
+                WriteFile(saltFilename, salt.data(), salt.size());
+                for (std::uint32_t i = 0; i < config.numPSOs; ++i)
+                    ::remove(GetPSOCacheFilename(i).c_str());
+                ::remove((moduleCacheDir + "/Device.bin").c_str());
+            }
+            else
+            {
+                std::ifstream saltFile{ saltFilename };
+                std::getline(saltFile, salt);
+                for (std::uint32_t i = 0; i < config.numPSOs; ++i)
+                {
+                    psoCaches[i] = LLGL::Blob::CreateFromFile(GetPSOCacheFilename(i));
+                    cacheBytes += psoCaches[i].GetSize();
+                }
+                deviceCache = LLGL::Blob::CreateFromFile(moduleCacheDir + "/Device.bin");
+                cacheBytes += deviceCache.GetSize();
+            }
+
+            /* The D3D backends create the shader cache directory on demand */
+            shaderCachePath = moduleCacheDir + "/Shaders";
+        }
+
+        // Writes the caches at the end of a cold run.
+        void StoreCaches()
+        {
+            if (mode != CacheMode::Cold)
+                return;
+
+            for (std::uint32_t i = 0; i < config.numPSOs; ++i)
+            {
+                if (psoCaches[i])
+                {
+                    WriteFile(GetPSOCacheFilename(i), psoCaches[i].GetData(), psoCaches[i].GetSize());
+                    cacheBytes += psoCaches[i].GetSize();
+                }
+            }
+
+            LLGL::Blob pipelineCache = renderer->GetPipelineCache();
+            if (pipelineCache)
+            {
+                WriteFile(moduleCacheDir + "/Device.bin", pipelineCache.GetData(), pipelineCache.GetSize());
+                cacheBytes += pipelineCache.GetSize();
+            }
+        }
+
+        LLGL::Shader* CreateShader(LLGL::ShaderType type, const LLGL::VertexFormat& vertexFormat, std::uint32_t variant)
+        {
+            const bool isVertex = (type == LLGL::ShaderType::Vertex);
+
+            LLGL::ShaderDescriptor shaderDesc;
+            if (Supported(LLGL::ShadingLanguage::GLSL))
+                shaderDesc = LLGL::ShaderDescFromFile(type, (isVertex ? "Shaders/DrawBenchmark.vert" : "Shaders/DrawBenchmark.frag"));
+            else if (Supported(LLGL::ShadingLanguage::SPIRV))
+                shaderDesc = LLGL::ShaderDescFromFile(type, (isVertex ? "Shaders/DrawBenchmark.450core.vert.spv" : "Shaders/DrawBenchmark.450core.frag.spv"));
+            else if (Supported(LLGL::ShadingLanguage::HLSL))
+                shaderDesc = LLGL::ShaderDescFromFile(type, "Shaders/DrawBenchmark.hlsl", (isVertex ? "VS" : "PS"), (isVertex ? "vs_5_0" : "ps_5_0"));
+            else if (Supported(LLGL::ShadingLanguage::Metal))
+                shaderDesc = LLGL::ShaderDescFromFile(type, "Shaders/DrawBenchmark.metal", (isVertex ? "VS" : "PS"), "1.1");
+            else
+                return nullptr;
+
+            if (isVertex)
+                shaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+            /* Make each shader variant unique with macros that are not referenced by the shader code; SPIR-V and Metal ignore them */
+            const std::string variantValue = std::to_string(variant);
+            const LLGL::ShaderMacro defines[] =
+            {
+                { "BENCHMARK_SALT",     salt.c_str()            },
+                { "BENCHMARK_VARIANT",  variantValue.c_str()    },
+                { nullptr,              nullptr                 },
+            };
+            shaderDesc.defines = defines;
+
+            LLGL::Shader* shader = renderer->CreateShader(shaderDesc);
+            if (const LLGL::Report* report = shader->GetReport())
+            {
+                if (report->HasErrors())
+                {
+                    LLGL::Log::Errorf("%s", report->GetText());
+                    return nullptr;
+                }
+            }
+            return shader;
+        }
+
+        LLGL::PipelineState* CreatePipelineState(std::uint32_t index)
+        {
+            const std::uint32_t shaderPair = (index % config.numShaders) * 2;
+
+            /* Vary blend, rasterizer, and depth states to make each PSO unique */
+            const std::uint32_t variant = index / config.numShaders;
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.vertexShader                   = shaders[shaderPair];
+                pipelineDesc.fragmentShader                 = shaders[shaderPair + 1];
+                pipelineDesc.pipelineLayout                 = pipelineLayout;
+                pipelineDesc.renderPass                     = swapChain->GetRenderPass();
+                pipelineDesc.blend.targets[0].blendEnabled  = ((variant & 1u) != 0);
+                pipelineDesc.rasterizer.cullMode            = ((variant & 2u) != 0 ? LLGL::CullMode::Back : LLGL::CullMode::Disabled);
+                pipelineDesc.depth.testEnabled              = ((variant & 4u) != 0);
+                pipelineDesc.depth.writeEnabled             = ((variant & 4u) != 0);
+                pipelineDesc.blend.targets[0].colorMask     = static_cast<std::uint8_t>(0xF - ((variant >> 3) & 0x7u));
+            }
+
+            /* OpenGL and Metal also read from the serialized cache if it is not empty */
+            LLGL::PipelineState* pipeline = renderer->CreatePipelineState(pipelineDesc, &psoCaches[index]);
+            if (const LLGL::Report* report = pipeline->GetReport())
+            {
+                if (report->HasErrors())
+                {
+                    LLGL::Log::Errorf("%s", report->GetText());
+                    return nullptr;
+                }
+            }
+            return pipeline;
+        }
+
+        LLGL::RenderSystemPtr LoadRenderer()
+        {
+            LLGL::RenderSystemDescriptor rendererDesc;
+            rendererDesc.moduleName = moduleName;
+
+            const LLGL::ArrayView<char> deviceCacheData{ reinterpret_cast<const char*>(deviceCache.GetData()), deviceCache.GetSize() };
+
+            LLGL::RendererConfigurationVulkan       configVK;
+            LLGL::RendererConfigurationDirect3D11   configD3D11;
+            LLGL::RendererConfigurationDirect3D12   configD3D12;
+
+            if (moduleName == "Vulkan")
+            {
+                configVK.pipelineCacheData          = deviceCacheData;
+                rendererDesc.rendererConfig         = &configVK;
+                rendererDesc.rendererConfigSize     = sizeof(configVK);
+            }
+            else if (moduleName == "Direct3D11")
+            {
+                configD3D11.shaderCachePath         = shaderCachePath.c_str();
+                rendererDesc.rendererConfig         = &configD3D11;
+                rendererDesc.rendererConfigSize     = sizeof(configD3D11);
+            }
+            else if (moduleName == "Direct3D12")
+            {
+                configD3D12.pipelineLibraryEnabled  = true;
+                configD3D12.pipelineLibraryData     = deviceCacheData;
+                configD3D12.shaderCachePath         = shaderCachePath.c_str();
+                rendererDesc.rendererConfig         = &configD3D12;
+                rendererDesc.rendererConfigSize     = sizeof(configD3D12);
+            }
+
+            return LLGL::RenderSystem::Load(rendererDesc);
+        }
+
+    public:
+
+        PipelineBenchmark(const BenchmarkConfig& config, const std::string& moduleName, CacheMode mode) :
+            config          { config                                 },
+            moduleName      { moduleName                             },
+            mode            { mode                                   },
+            moduleCacheDir  { config.cacheDir + "/" + moduleName     }
+        {
+        }
+
+        bool Run(BenchmarkResult& result)
+        {
+            PrepareCaches();
+
+            const std::uint64_t startTime = LLGL::Timer::Tick();
+
+            /* Load render system with its device-wide caches */
+            renderer = LoadRenderer();
+            if (!renderer)
+                return false;
+
+            const std::uint64_t loadTime = LLGL::Timer::Tick();
+
+            /* Create swap-chain */
+            LLGL::SwapChainDescriptor swapChainDesc;
+            {
+                swapChainDesc.resolution = { 320, 240 };
+            }
+            swapChain = renderer->CreateSwapChain(swapChainDesc);
+            swapChain->SetVsyncInterval(0);
+
+            auto& window = LLGL::CastTo<LLGL::Window>(swapChain->GetSurface());
+            window.SetTitle("LLGL Pipeline Benchmark - " + moduleName);
+            window.Show();
+
+            const std::uint64_t swapChainTime = LLGL::Timer::Tick();
+
+            /* Create all shader variants */
+            LLGL::VertexFormat vertexFormat;
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+            for (std::uint32_t i = 0; i < config.numShaders; ++i)
+            {
+                LLGL::Shader* vertexShader      = CreateShader(LLGL::ShaderType::Vertex, vertexFormat, i);
+                LLGL::Shader* fragmentShader    = CreateShader(LLGL::ShaderType::Fragment, vertexFormat, i);
+                if (vertexShader == nullptr || fragmentShader == nullptr)
+                {
+                    LLGL::Log::Errorf("Failed to load shaders for renderer: %s\n", moduleName.c_str());
+                    return false;
+                }
+                shaders.push_back(vertexShader);
+                shaders.push_back(fragmentShader);
+            }
+
+            const std::uint64_t shadersTime = LLGL::Timer::Tick();
+
+            /* Create all PSOs */
+            pipelineLayout = renderer->CreatePipelineLayout(
+                LLGL::Parse("heap{cbuffer(Scene@1):vert}, cbuffer(Object@2):vert, float4(tint)")
+            );
+
+            for (std::uint32_t i = 0; i < config.numPSOs; ++i)
+            {
+                LLGL::PipelineState* pipeline = CreatePipelineState(i);
+                if (pipeline == nullptr)
+                    return false;
+                pipelines.push_back(pipeline);
+            }
+
+            const std::uint64_t psosTime = LLGL::Timer::Tick();
+
+            /* Render first frame with one draw call and wait for the GPU, since some drivers only finalize PSOs when they are first used */
+            const float vertices[] = { 0.0f, 0.1f, 0.1f, -0.1f, -0.1f, -0.1f };
+            const float offsets[4] = {};
+
+            LLGL::Buffer* sceneBuffer   = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(offsets)), offsets);
+            LLGL::Buffer* objectBuffer  = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(offsets)), offsets);
+            LLGL::Buffer* vertexBuffer  = renderer->CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices);
+            LLGL::ResourceHeap* resourceHeap = renderer->CreateResourceHeap(pipelineLayout, { sceneBuffer });
+
+            LLGL::CommandBuffer* commands = renderer->CreateCommandBuffer(LLGL::CommandBufferFlags::ImmediateSubmit);
+            commands->Begin();
+            {
+                commands->BeginRenderPass(*swapChain);
+                {
+                    const float tint[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+                    commands->Clear(LLGL::ClearFlags::ColorDepth);
+                    commands->SetViewport(swapChain->GetResolution());
+                    commands->SetPipelineState(*pipelines[0]);
+                    commands->SetResourceHeap(*resourceHeap);
+                    commands->SetResource(0, *objectBuffer);
+                    commands->SetVertexBuffer(*vertexBuffer);
+                    commands->SetUniforms(0, tint, sizeof(tint));
+                    commands->Draw(3, 0);
+                }
+                commands->EndRenderPass();
+            }
+            commands->End();
+            swapChain->Present();
+            renderer->GetCommandQueue()->WaitIdle();
+
+            const std::uint64_t firstFrameTime = LLGL::Timer::Tick();
+
+            StoreCaches();
+
+            result.moduleName   = moduleName;
+            result.mode         = (mode == CacheMode::Cold ? "cold" : "warm");
+            result.loadMs       = TicksToMs(loadTime - startTime);
+            result.swapChainMs  = TicksToMs(swapChainTime - loadTime);
+            result.shadersMs    = TicksToMs(shadersTime - swapChainTime);
+            result.psosMs       = TicksToMs(psosTime - shadersTime);
+            result.firstFrameMs = TicksToMs(firstFrameTime - psosTime);
+            result.totalMs      = TicksToMs(firstFrameTime - startTime);
+            result.peakRSSMB    = GetPeakRSSMB();
+            result.cacheBytes   = cacheBytes;
+
+            return true;
+        }
+
+};
+
+static const char* FindArgumentValue(int argc, char* argv[], const char* search)
+{
+    const std::size_t searchLen = ::strlen(search);
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strncmp(argv[i], search, searchLen) == 0)
+            return argv[i] + searchLen;
+    }
+    return nullptr;
+}
+
+static std::uint32_t FindArgumentUInt(int argc, char* argv[], const char* search, std::uint32_t defaultValue)
+{
+    if (const char* value = FindArgumentValue(argc, argv, search))
+        return std::max(1u, static_cast<std::uint32_t>(::strtoul(value, nullptr, 10)));
+    return defaultValue;
+}
+
+static bool HasArgument(int argc, char* argv[], const char* search)
+{
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strcmp(argv[i], search) == 0)
+            return true;
+    }
+    return false;
+}
+
+static const char* GetRendererModule(const std::string& name)
+{
+    if (name == "gl" || name == "opengl")
+        return "OpenGL";
+    if (name == "vk" || name == "vulkan")
+        return "Vulkan";
+    if (name == "mt" || name == "mtl" || name == "metal")
+        return "Metal";
+    if (name == "d3d11" || name == "dx11" || name == "direct3d11")
+        return "Direct3D11";
+    if (name == "d3d12" || name == "dx12" || name == "direct3d12")
+        return "Direct3D12";
+    if (name == "null")
+        return "Null";
+    return name.c_str();
+}
+
+static void WriteResultLine(std::ostream& stream, const BenchmarkResult& result)
+{
+    stream  << result.moduleName << ',' << result.mode << ',' << result.loadMs << ',' << result.swapChainMs << ','
+            << result.shadersMs << ',' << result.psosMs << ',' << result.firstFrameMs << ',' << result.totalMs << ','
+            << result.peakRSSMB << ',' << result.cacheBytes << '\n';
+}
+
+static bool ReadResultLine(const std::string& line, BenchmarkResult& result)
+{
+    std::stringstream lineStream{ line };
+    std::string values[10];
+    for (std::string& value : values)
+    {
+        if (!std::getline(lineStream, value, ','))
+            return false;
+    }
+    result.moduleName   = values[0];
+    result.mode         = values[1];
+    result.loadMs       = ::strtod(values[2].c_str(), nullptr);
+    result.swapChainMs  = ::strtod(values[3].c_str(), nullptr);
+    result.shadersMs    = ::strtod(values[4].c_str(), nullptr);
+    result.psosMs       = ::strtod(values[5].c_str(), nullptr);
+    result.firstFrameMs = ::strtod(values[6].c_str(), nullptr);
+    result.totalMs      = ::strtod(values[7].c_str(), nullptr);
+    result.peakRSSMB    = ::strtod(values[8].c_str(), nullptr);
+    result.cacheBytes   = ::strtoull(values[9].c_str(), nullptr, 10);
+    return true;
+}
+
+// Runs a single benchmark in this process and appends its result to the specified file.
+static int RunChild(int argc, char* argv[], const BenchmarkConfig& config)
+{
+    const char* moduleName      = FindArgumentValue(argc, argv, "--module=");
+    const char* modeName        = FindArgumentValue(argc, argv, "--mode=");
+    const char* resultFilename  = FindArgumentValue(argc, argv, "--result=");
+    if (moduleName == nullptr || modeName == nullptr || resultFilename == nullptr)
+        return 1;
+
+    PipelineBenchmark benchmark{ config, moduleName, (::strcmp(modeName, "warm") == 0 ? CacheMode::Warm : CacheMode::Cold) };
+    BenchmarkResult result;
+    if (!benchmark.Run(result))
+        return 1;
+
+    std::ofstream resultFile{ resultFilename, std::ios::app };
+    WriteResultLine(resultFile, result);
+    return 0;
+}
+
+static void PrintResults(const std::vector<BenchmarkResult>& results, const BenchmarkConfig& config)
+{
+    LLGL::Log::Printf(
+        "\n%-12s %-5s %10s %10s %10s %10s %10s %10s %10s %10s %12s\n",
+        "Module", "Mode", "Load", "SwapChain", "Shaders", "PSOs", "us/PSO", "1st frame", "Total", "Peak RSS", "Cache"
+    );
+    for (const BenchmarkResult& result : results)
+    {
+        LLGL::Log::Printf(
+            "%-12s %-5s %8.1fms %8.1fms %8.1fms %8.1fms %10.1f %8.1fms %8.1fms %8.1fMB %10lluKB\n",
+            result.moduleName.c_str(), result.mode.c_str(), result.loadMs, result.swapChainMs, result.shadersMs, result.psosMs,
+            result.psosMs * 1000.0 / config.numPSOs, result.firstFrameMs, result.totalMs, result.peakRSSMB,
+            static_cast<unsigned long long>(result.cacheBytes / 1024)
+        );
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    BenchmarkConfig config;
+    {
+        config.numShaders   = FindArgumentUInt(argc, argv, "--shaders=", config.numShaders);
+        config.numPSOs      = FindArgumentUInt(argc, argv, "--psos=", config.numPSOs);
+        if (const char* cacheDir = FindArgumentValue(argc, argv, "--cache-dir="))
+            config.cacheDir = cacheDir;
+    }
+
+    if (HasArgument(argc, argv, "--child"))
+        return RunChild(argc, argv, config);
+
+    // Gather all explicitly specified module names
+    std::vector<std::string> enabledModules;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-')
+            enabledModules.push_back(GetRendererModule(argv[i]));
+    }
+
+    if (enabledModules.empty())
+        enabledModules = LLGL::RenderSystem::FindModules();
+
+    std::vector<std::string> modes;
+    const char* modeArg = FindArgumentValue(argc, argv, "--mode=");
+    if (modeArg == nullptr || ::strcmp(modeArg, "both") == 0)
+        modes = { "cold", "warm" };
+    else
+        modes = { modeArg };
+
+    // Run each module and mode in a separate child process, so driver-internal state and the peak RSS are not shared between runs
+    const std::string resultFilename = config.cacheDir + "/Results.csv";
+    MakeDirectory(config.cacheDir);
+    ::remove(resultFilename.c_str());
+
+    for (const std::string& moduleName : enabledModules)
+    {
+        for (const std::string& mode : modes)
+        {
+            LLGL::Log::Printf(
+                "Run pipeline benchmark: %s (%s, %u shaders, %u PSOs)\n",
+                moduleName.c_str(), mode.c_str(), config.numShaders, config.numPSOs
+            );
+
+            std::string command =
+                "\"" + std::string(argv[0]) + "\" --child --module=" + moduleName + " --mode=" + mode +
+                " --shaders=" + std::to_string(config.numShaders) + " --psos=" + std::to_string(config.numPSOs) +
+                " \"--cache-dir=" + config.cacheDir + "\" \"--result=" + resultFilename + "\"";
+
+            #ifdef _WIN32
+            // cmd.exe strips the outermost quotes of the command line
+            command = "\"" + command + "\"";
+            #endif
+
+            if (::system(command.c_str()) != 0)
+                LLGL::Log::Errorf("Pipeline benchmark failed: %s (%s)\n", moduleName.c_str(), mode.c_str());
+        }
+    }
+
+    // Gather results of all child processes
+    std::vector<BenchmarkResult> results;
+    std::ifstream resultFile{ resultFilename };
+    for (std::string line; std::getline(resultFile, line);)
+    {
+        BenchmarkResult result;
+        if (ReadResultLine(line, result))
+            results.push_back(result);
+    }
+
+    if (!results.empty())
+    {
+        PrintResults(results, config);
+
+        if (const char* csvFilename = FindArgumentValue(argc, argv, "--csv="))
+        {
+            std::ofstream file{ csvFilename };
+            file << "module,mode,loadMs,swapChainMs,shadersMs,psosMs,firstFrameMs,totalMs,peakRSSMB,cacheBytes\n";
+            for (const BenchmarkResult& result : results)
+                WriteResultLine(file, result);
+        }
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
+
+
+
+// ================================================================================
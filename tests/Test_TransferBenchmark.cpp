@@ -0,0 +1,452 @@
+/*
+ * Test_TransferBenchmark.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+Upload/readback bandwidth benchmark.
+Sweeps every transfer path from 64 B up to 256 MB (in steps of 4x) and reports the median latency per operation
+and the bandwidth in GB/s for each backend. Each operation is followed by CommandQueue::WaitIdle, so the latency includes GPU completion.
+
+Usage: Test_TransferBenchmark [MODULES...] [--min-size=BYTES] [--max-size=BYTES] [--csv=FILE]
+*/
+
+enum class TransferPath
+{
+    WriteBuffer,
+    UpdateBuffer,
+    MapBufferReadOnly,
+    MapBufferWriteOnly,
+    MapBufferWriteDiscard,
+    MapBufferReadWrite,
+    MapBufferHostVisible, // MapBuffer with CPUAccess::WriteOnly on a buffer with MiscFlags::HostVisible
+    CopyBuffer,
+    CopyTextureFromBuffer,
+    ReadTexture,
+    ReadBuffer,
+};
+
+struct TransferPathCase
+{
+    const char*     name;
+    TransferPath    path;
+};
+
+static const TransferPathCase g_transferPathCases[] =
+{
+    { "WriteBuffer",                TransferPath::WriteBuffer           },
+    { "UpdateBuffer",               TransferPath::UpdateBuffer          },
+    { "MapBuffer(ReadOnly)",        TransferPath::MapBufferReadOnly     },
+    { "MapBuffer(WriteOnly)",       TransferPath::MapBufferWriteOnly    },
+    { "MapBuffer(WriteDiscard)",    TransferPath::MapBufferWriteDiscard },
+    { "MapBuffer(ReadWrite)",       TransferPath::MapBufferReadWrite    },
+    { "MapBuffer(HostVisible)",     TransferPath::MapBufferHostVisible  },
+    { "CopyBuffer",                 TransferPath::CopyBuffer            },
+    { "CopyTextureFromBuffer",      TransferPath::CopyTextureFromBuffer },
+    { "ReadTexture",                TransferPath::ReadTexture           },
+    { "ReadBuffer",                 TransferPath::ReadBuffer            },
+};
+
+struct BenchmarkConfig
+{
+    std::uint64_t minSize           = 64;
+    std::uint64_t maxSize           = 256ull * 1024 * 1024;
+    std::uint64_t bytesPerSample    = 256ull * 1024 * 1024; // Number of bytes to transfer per size, to determine the number of iterations
+    std::uint32_t minIterations     = 5;
+    std::uint32_t maxIterations     = 1000;
+};
+
+// Resources that are created for a single transfer path and size.
+struct TransferResources
+{
+    std::vector<LLGL::Buffer*>  buffers;
+    std::vector<LLGL::Texture*> textures;
+};
+
+struct TransferResult
+{
+    std::string     moduleName;
+    std::string     pathName;
+    std::uint64_t   size        = 0;
+    double          latencyUs   = 0.0; // Median time per operation in microseconds
+    double          gbPerSec    = 0.0; // Total bytes divided by total time
+};
+
+class TransferBenchmark
+{
+
+    private:
+
+        LLGL::RenderSystemPtr   renderer;
+        LLGL::CommandQueue*     commandQueue    = nullptr;
+        LLGL::CommandBuffer*    commands        = nullptr;
+        std::string             moduleName;
+
+        std::vector<char>       hostMemory;
+
+    private:
+
+        LLGL::Buffer* CreateBuffer(std::uint64_t size, long cpuAccessFlags = 0, long miscFlags = 0)
+        {
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size             = size;
+                bufferDesc.bindFlags        = LLGL::BindFlags::CopySrc | LLGL::BindFlags::CopyDst;
+                bufferDesc.cpuAccessFlags   = cpuAccessFlags;
+                bufferDesc.miscFlags        = miscFlags;
+            }
+            return renderer->CreateBuffer(bufferDesc);
+        }
+
+        // Returns the 2D extent of an RGBA8 texture with the specified size (in bytes), or an empty extent if the size is not supported.
+        LLGL::Extent3D GetTextureExtent(std::uint64_t size) const
+        {
+            const std::uint64_t numTexels   = size / 4;
+            const std::uint64_t maxSize     = renderer->GetRenderingCaps().limits.max2DTextureSize;
+            const std::uint64_t width       = std::min(numTexels, maxSize);
+            if (width == 0 || numTexels % width != 0 || numTexels / width > maxSize)
+                return {};
+            return LLGL::Extent3D{ static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(numTexels / width), 1 };
+        }
+
+        LLGL::Texture* CreateTexture(const LLGL::Extent3D& extent)
+        {
+            LLGL::TextureDescriptor textureDesc;
+            {
+                textureDesc.type        = LLGL::TextureType::Texture2D;
+                textureDesc.bindFlags   = LLGL::BindFlags::Sampled | LLGL::BindFlags::CopySrc | LLGL::BindFlags::CopyDst;
+                textureDesc.format      = LLGL::Format::RGBA8UNorm;
+                textureDesc.extent      = extent;
+                textureDesc.mipLevels   = 1;
+            }
+            return renderer->CreateTexture(textureDesc);
+        }
+
+        void MapAndCopy(LLGL::Buffer& buffer, LLGL::CPUAccess access, std::uint64_t size)
+        {
+            if (void* data = renderer->MapBuffer(buffer, access))
+            {
+                if (access == LLGL::CPUAccess::ReadOnly)
+                    ::memcpy(hostMemory.data(), data, static_cast<std::size_t>(size));
+                else
+                    ::memcpy(data, hostMemory.data(), static_cast<std::size_t>(size));
+                renderer->UnmapBuffer(buffer);
+            }
+        }
+
+        void UpdateBufferInChunks(LLGL::Buffer& buffer, std::uint64_t size)
+        {
+            // UpdateBuffer is limited to 65536 bytes per command, but its size parameter is 16-bit, so use the largest power of two that fits
+            constexpr std::uint64_t maxChunkSize = 32768;
+            commands->Begin();
+            {
+                for (std::uint64_t offset = 0; offset < size; offset += maxChunkSize)
+                {
+                    const std::uint64_t chunkSize = std::min(size - offset, maxChunkSize);
+                    commands->UpdateBuffer(buffer, offset, hostMemory.data() + offset, static_cast<std::uint16_t>(chunkSize));
+                }
+            }
+            commands->End();
+            commandQueue->Submit(*commands);
+        }
+
+        // Creates the resources for the specified path and returns the operation to benchmark. Returns null if the transfer path is not supported.
+        std::function<void()> CreateTransferOp(TransferPath path, std::uint64_t size, TransferResources& resources)
+        {
+            switch (path)
+            {
+                case TransferPath::WriteBuffer:
+                {
+                    LLGL::Buffer* buffer = CreateBuffer(size);
+                    resources.buffers.push_back(buffer);
+                    return [this, buffer, size]() { renderer->WriteBuffer(*buffer, 0, hostMemory.data(), size); };
+                }
+
+                case TransferPath::UpdateBuffer:
+                {
+                    LLGL::Buffer* buffer = CreateBuffer(size);
+                    resources.buffers.push_back(buffer);
+                    return [this, buffer, size]() { UpdateBufferInChunks(*buffer, size); };
+                }
+
+                case TransferPath::MapBufferReadOnly:
+                case TransferPath::MapBufferWriteOnly:
+                case TransferPath::MapBufferWriteDiscard:
+                case TransferPath::MapBufferReadWrite:
+                case TransferPath::MapBufferHostVisible:
+                {
+                    const LLGL::CPUAccess access =
+                    (
+                        path == TransferPath::MapBufferReadOnly     ? LLGL::CPUAccess::ReadOnly     :
+                        path == TransferPath::MapBufferWriteDiscard ? LLGL::CPUAccess::WriteDiscard :
+                        path == TransferPath::MapBufferReadWrite    ? LLGL::CPUAccess::ReadWrite    :
+                                                                      LLGL::CPUAccess::WriteOnly
+                    );
+                    const long miscFlags = (path == TransferPath::MapBufferHostVisible ? LLGL::MiscFlags::HostVisible : 0);
+                    LLGL::Buffer* buffer = CreateBuffer(size, LLGL::CPUAccessFlags::ReadWrite, miscFlags);
+                    resources.buffers.push_back(buffer);
+                    return [this, buffer, access, size]() { MapAndCopy(*buffer, access, size); };
+                }
+
+                case TransferPath::CopyBuffer:
+                {
+                    LLGL::Buffer* srcBuffer = CreateBuffer(size);
+                    LLGL::Buffer* dstBuffer = CreateBuffer(size);
+                    resources.buffers.push_back(srcBuffer);
+                    resources.buffers.push_back(dstBuffer);
+                    return [this, srcBuffer, dstBuffer, size]()
+                    {
+                        commands->Begin();
+                        commands->CopyBuffer(*dstBuffer, 0, *srcBuffer, 0, size);
+                        commands->End();
+                        commandQueue->Submit(*commands);
+                    };
+                }
+
+                case TransferPath::CopyTextureFromBuffer:
+                {
+                    const LLGL::Extent3D extent = GetTextureExtent(size);
+                    if (extent.width == 0)
+                        return nullptr;
+                    LLGL::Buffer* srcBuffer = CreateBuffer(size);
+                    LLGL::Texture* dstTexture = CreateTexture(extent);
+                    resources.buffers.push_back(srcBuffer);
+                    resources.textures.push_back(dstTexture);
+                    return [this, srcBuffer, dstTexture, extent]()
+                    {
+                        commands->Begin();
+                        commands->CopyTextureFromBuffer(*dstTexture, LLGL::TextureRegion{ LLGL::Offset3D{}, extent }, *srcBuffer, 0);
+                        commands->End();
+                        commandQueue->Submit(*commands);
+                    };
+                }
+
+                case TransferPath::ReadTexture:
+                {
+                    const LLGL::Extent3D extent = GetTextureExtent(size);
+                    if (extent.width == 0)
+                        return nullptr;
+                    LLGL::Texture* srcTexture = CreateTexture(extent);
+                    resources.textures.push_back(srcTexture);
+                    return [this, srcTexture, extent, size]()
+                    {
+                        const LLGL::DstImageDescriptor imageDesc{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, hostMemory.data(), static_cast<std::size_t>(size) };
+                        renderer->ReadTexture(*srcTexture, LLGL::TextureRegion{ LLGL::Offset3D{}, extent }, imageDesc);
+                    };
+                }
+
+                case TransferPath::ReadBuffer:
+                {
+                    LLGL::Buffer* buffer = CreateBuffer(size);
+                    resources.buffers.push_back(buffer);
+                    return [this, buffer, size]() { renderer->ReadBuffer(*buffer, 0, hostMemory.data(), size); };
+                }
+            }
+
+            return nullptr;
+        }
+
+    public:
+
+        bool Load(const std::string& moduleName)
+        {
+            // Load renderer without debug layer, since it would dominate the measured latencies
+            renderer = LLGL::RenderSystem::Load(moduleName);
+            if (!renderer)
+                return false;
+
+            this->moduleName    = moduleName;
+            commandQueue        = renderer->GetCommandQueue();
+            commands            = renderer->CreateCommandBuffer();
+
+            return true;
+        }
+
+        void Run(const BenchmarkConfig& config, std::vector<TransferResult>& results)
+        {
+            const std::uint64_t maxBufferSize = renderer->GetRenderingCaps().limits.maxBufferSize;
+
+            for (const TransferPathCase& pathCase : g_transferPathCases)
+            {
+                for (std::uint64_t size = config.minSize; size <= config.maxSize; size *= 4)
+                {
+                    if (maxBufferSize != 0 && size > maxBufferSize)
+                        break;
+
+                    if (hostMemory.size() < size)
+                        hostMemory.resize(static_cast<std::size_t>(size));
+
+                    TransferResources resources;
+                    std::function<void()> transferOp = CreateTransferOp(pathCase.path, size, resources);
+
+                    if (transferOp)
+                    {
+                        const std::uint32_t numIterations = static_cast<std::uint32_t>(
+                            std::max<std::uint64_t>(config.minIterations, std::min<std::uint64_t>(config.maxIterations, config.bytesPerSample / size))
+                        );
+
+                        // Warm up once to exclude lazy allocations of staging buffers from the measurement
+                        transferOp();
+                        commandQueue->WaitIdle();
+
+                        std::vector<double> times;
+                        times.reserve(numIterations);
+                        std::uint64_t totalTicks = 0;
+
+                        for (std::uint32_t i = 0; i < numIterations; ++i)
+                        {
+                            const std::uint64_t startTime = LLGL::Timer::Tick();
+                            transferOp();
+                            commandQueue->WaitIdle();
+                            const std::uint64_t elapsedTicks = LLGL::Timer::Tick() - startTime;
+                            totalTicks += elapsedTicks;
+                            times.push_back(static_cast<double>(elapsedTicks));
+                        }
+
+                        std::sort(times.begin(), times.end());
+
+                        const double frequency = static_cast<double>(LLGL::Timer::Frequency());
+
+                        TransferResult result;
+                        {
+                            result.moduleName   = moduleName;
+                            result.pathName     = pathCase.name;
+                            result.size         = size;
+                            result.latencyUs    = times[times.size() / 2] * 1.0e6 / frequency;
+                            result.gbPerSec     = (static_cast<double>(size) * numIterations / 1.0e9) / (static_cast<double>(totalTicks) / frequency);
+                        }
+                        results.push_back(result);
+
+                        LLGL::Log::Printf(
+                            "%-24s %10s: %12.2f us, %8.3f GB/s\n",
+                            result.pathName.c_str(), FormatSize(size).c_str(), result.latencyUs, result.gbPerSec
+                        );
+                    }
+
+                    for (LLGL::Buffer* buffer : resources.buffers)
+                        renderer->Release(*buffer);
+                    for (LLGL::Texture* texture : resources.textures)
+                        renderer->Release(*texture);
+                }
+            }
+        }
+
+        static std::string FormatSize(std::uint64_t size)
+        {
+            if (size >= 1024ull * 1024)
+                return std::to_string(size / (1024ull * 1024)) + " MB";
+            if (size >= 1024ull)
+                return std::to_string(size / 1024ull) + " KB";
+            return std::to_string(size) + " B";
+        }
+
+};
+
+static const char* FindArgumentValue(int argc, char* argv[], const char* search)
+{
+    const std::size_t searchLen = ::strlen(search);
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strncmp(argv[i], search, searchLen) == 0)
+            return argv[i] + searchLen;
+    }
+    return nullptr;
+}
+
+static std::uint64_t FindArgumentUInt64(int argc, char* argv[], const char* search, std::uint64_t defaultValue)
+{
+    if (const char* value = FindArgumentValue(argc, argv, search))
+        return std::max<std::uint64_t>(1, ::strtoull(value, nullptr, 10));
+    return defaultValue;
+}
+
+static const char* GetRendererModule(const std::string& name)
+{
+    if (name == "gl" || name == "opengl")
+        return "OpenGL";
+    if (name == "vk" || name == "vulkan")
+        return "Vulkan";
+    if (name == "mt" || name == "mtl" || name == "metal")
+        return "Metal";
+    if (name == "d3d11" || name == "dx11" || name == "direct3d11")
+        return "Direct3D11";
+    if (name == "d3d12" || name == "dx12" || name == "direct3d12")
+        return "Direct3D12";
+    if (name == "null")
+        return "Null";
+    return name.c_str();
+}
+
+static void SaveResultsCSV(const std::vector<TransferResult>& results, const char* filename)
+{
+    std::ofstream file{ filename };
+    if (!file.good())
+    {
+        LLGL::Log::Errorf("Failed to write CSV file: %s\n", filename);
+        return;
+    }
+
+    file << "module,path,size,latencyUs,gbPerSec\n";
+    for (const TransferResult& result : results)
+        file << result.moduleName << ',' << result.pathName << ',' << result.size << ',' << result.latencyUs << ',' << result.gbPerSec << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    BenchmarkConfig config;
+    {
+        config.minSize = FindArgumentUInt64(argc, argv, "--min-size=", config.minSize);
+        config.maxSize = FindArgumentUInt64(argc, argv, "--max-size=", config.maxSize);
+    }
+
+    // Gather all explicitly specified module names
+    std::vector<std::string> enabledModules;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-')
+            enabledModules.push_back(GetRendererModule(argv[i]));
+    }
+
+    if (enabledModules.empty())
+        enabledModules = LLGL::RenderSystem::FindModules();
+
+    // Run all transfer paths for each backend
+    std::vector<TransferResult> results;
+
+    for (const std::string& moduleName : enabledModules)
+    {
+        LLGL::Log::Printf("Run transfer benchmark: %s\n", moduleName.c_str());
+        LLGL::Log::Printf("=============================\n");
+
+        TransferBenchmark benchmark;
+        if (benchmark.Load(moduleName))
+            benchmark.Run(config, results);
+
+        LLGL::Log::Printf("=============================\n\n");
+    }
+
+    if (const char* csvFilename = FindArgumentValue(argc, argv, "--csv="))
+        SaveResultsCSV(results, csvFilename);
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
@@ -82,6 +82,36 @@ DEF_TEST( BufferFill )
         }
     }
 
+    // Fill buf2 with 128-bit pattern, then overwrite its second half with a 64-bit pattern
+    const std::uint32_t fillData01Only[4] = { fillData[0], fillData[1], fillData[0], fillData[1] };
+
+    cmdBuffer->Begin();
+    {
+        cmdBuffer->FillBufferPattern(*buf2, 0, fillData, sizeof(fillData));
+        cmdBuffer->FillBufferPattern(*buf2, buf2Desc.size / 2, fillData, sizeof(std::uint32_t) * 2, buf2Desc.size / 2);
+    }
+    cmdBuffer->End();
+
+    for (std::uint64_t buf2Off = 0; buf2Off + sizeof(fillData) <= buf2Desc.size; buf2Off += sizeof(fillData))
+    {
+        // Reset previous data
+        ::memset(buf2DataFeedback, 0, sizeof(buf2DataFeedback));
+
+        const std::uint32_t* expectedData = (buf2Off < buf2Desc.size / 2 ? fillData : fillData01Only);
+
+        renderer->ReadBuffer(*buf2, buf2Off, buf2DataFeedback, sizeof(buf2DataFeedback));
+        if (::memcmp(buf2DataFeedback, expectedData, sizeof(buf2DataFeedback)) != 0)
+        {
+            Log::Errorf(
+                "Mismatch between data of buffer 2 feedback data (offset = %" PRIu64 ") [0x%08X, 0x%08X, 0x%08X, 0x%08X] and fill pattern [0x%08X, 0x%08X, 0x%08X, 0x%08X]\n",
+                buf2Off,
+                buf2DataFeedback[0], buf2DataFeedback[1], buf2DataFeedback[2], buf2DataFeedback[3],
+                expectedData[0], expectedData[1], expectedData[2], expectedData[3]
+            );
+            return TestResult::FailedMismatch;
+        }
+    }
+
     // Delete old buffers
     renderer->Release(*buf1);
     renderer->Release(*buf2);
@@ -0,0 +1,249 @@
+/*
+ * TestMemoryFootprint.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <fstream>
+#include <stdio.h>
+
+
+// Minimal absolute growth (in bytes) before a relative growth is considered a regression, to ignore driver-internal allocations
+static constexpr std::uint64_t g_memMinRegressionSize = 4ull * 1024ull * 1024ull;
+
+// Number of frames with small uploads after the streaming phase; this must exceed the trim interval of the staging pools (120 frames) several times
+static constexpr unsigned g_memNumSteadyFrames = 400;
+
+struct MemoryCheckpoint
+{
+    const char*     name;
+    std::uint64_t   deviceLocal;
+    std::uint64_t   system;
+};
+
+// Returns the number of bytes the OS reports for this process, or the number of bytes LLGL has allocated if the usage is unknown.
+static std::uint64_t GetHeapFootprint(const MemoryHeapStatistics& heap)
+{
+    return (heap.usage > 0 ? heap.usage : heap.allocatedSize);
+}
+
+static bool QueryMemoryCheckpoint(RenderSystem& renderer, const char* name, MemoryCheckpoint& outCheckpoint)
+{
+    MemoryStatistics stats;
+    if (!renderer.QueryMemoryStatistics(stats))
+        return false;
+
+    outCheckpoint = MemoryCheckpoint{ name, 0, 0 };
+    for (const MemoryHeapStatistics& heap : stats.heaps)
+    {
+        if (heap.deviceLocal)
+            outCheckpoint.deviceLocal += GetHeapFootprint(heap);
+        else
+            outCheckpoint.system += GetHeapFootprint(heap);
+    }
+
+    return true;
+}
+
+static double BytesToMB(std::uint64_t size)
+{
+    return static_cast<double>(size) / (1024.0 * 1024.0);
+}
+
+static bool IsMemoryRegression(std::uint64_t baselineSize, std::uint64_t currentSize, double threshold)
+{
+    if (currentSize <= baselineSize)
+        return false;
+    const std::uint64_t tolerance = std::max(static_cast<std::uint64_t>(static_cast<double>(baselineSize) * threshold), g_memMinRegressionSize);
+    return (currentSize - baselineSize > tolerance);
+}
+
+/*
+Runs a fixed load/stream/unload scenario and records the memory footprint at each checkpoint.
+The footprint of the steady state after all resources have been released must not exceed the reference baseline,
+which catches leaks as well as staging pools that grow during a burst of uploads but never shrink again.
+Baselines are written and parsed in the same JSON layout as the performance baselines (see TestbedPerf.cpp).
+*/
+DEF_TEST( MemoryFootprint )
+{
+    std::vector<MemoryCheckpoint> checkpoints;
+    checkpoints.reserve(4);
+
+    MemoryCheckpoint checkpoint;
+    if (!QueryMemoryCheckpoint(*renderer, "Initial", checkpoint))
+    {
+        if (verbose)
+            Log::Printf("Memory statistics not supported: Skip memory footprint test\n");
+        return TestResult::Passed;
+    }
+    checkpoints.push_back(checkpoint);
+
+    // Load phase: Create a fixed set of buffers and textures with initial data
+    constexpr unsigned      numBuffers  = 16;
+    constexpr unsigned      numTextures = 8;
+    constexpr std::uint64_t bufferSize  = 1024 * 1024;
+    constexpr std::uint32_t textureSize = 512;
+
+    std::vector<std::uint8_t> initialData(textureSize * textureSize * 4, 0xA5);
+    Buffer* buffers[numBuffers] = {};
+    Texture* textures[numTextures] = {};
+
+    BufferDescriptor bufDesc;
+    {
+        bufDesc.size        = bufferSize;
+        bufDesc.bindFlags   = BindFlags::VertexBuffer | BindFlags::CopyDst;
+    }
+    for_range(i, numBuffers)
+    {
+        TestResult result = CreateBuffer(bufDesc, "buf{size=1MB,vert}", &buffers[i], initialData.data());
+        if (result != TestResult::Passed)
+            return result;
+    }
+
+    TextureDescriptor texDesc;
+    {
+        texDesc.type        = TextureType::Texture2D;
+        texDesc.format      = Format::RGBA8UNorm;
+        texDesc.extent      = { textureSize, textureSize, 1 };
+        texDesc.mipLevels   = 1;
+        texDesc.bindFlags   = BindFlags::Sampled;
+    }
+    SrcImageDescriptor texImage;
+    {
+        texImage.data       = initialData.data();
+        texImage.dataSize   = initialData.size();
+    }
+    for_range(i, numTextures)
+    {
+        TestResult result = CreateTexture(texDesc, "tex{512x512,rgba8}", &textures[i], &texImage);
+        if (result != TestResult::Passed)
+            return result;
+    }
+
+    cmdQueue->WaitIdle();
+    QueryMemoryCheckpoint(*renderer, "Loaded", checkpoint);
+    checkpoints.push_back(checkpoint);
+
+    // Streaming phase: Upload the entire buffer content several times per frame to make the staging pools grow
+    constexpr unsigned      numStreamingFrames  = 8;
+    constexpr std::uint16_t updateSize          = 32768;
+
+    for_range(frameIndex, numStreamingFrames)
+    {
+        cmdBuffer->Begin();
+        {
+            for (Buffer* buf : buffers)
+            {
+                for (std::uint64_t offset = 0; offset < bufferSize; offset += updateSize)
+                    cmdBuffer->UpdateBuffer(*buf, offset, initialData.data(), updateSize);
+            }
+        }
+        cmdBuffer->End();
+    }
+
+    cmdQueue->WaitIdle();
+    QueryMemoryCheckpoint(*renderer, "Streaming", checkpoint);
+    checkpoints.push_back(checkpoint);
+
+    // Unload phase: Release all resources and return unused device memory
+    for (Buffer* buf : buffers)
+        renderer->Release(*buf);
+    for (Texture* tex : textures)
+        renderer->Release(*tex);
+
+    cmdQueue->WaitIdle();
+    renderer->ReleaseRetainedMemory(~0ull);
+
+    // Steady phase: Keep submitting frames with small uploads, so the staging pools can trim the memory they only needed for streaming
+    for_range(frameIndex, g_memNumSteadyFrames)
+    {
+        cmdBuffer->Begin();
+        {
+            cmdBuffer->UpdateBuffer(*sceneCbuffer, 0, &sceneConstants, sizeof(sceneConstants));
+        }
+        cmdBuffer->End();
+    }
+
+    cmdQueue->WaitIdle();
+    renderer->ReleaseRetainedMemory(~0ull);
+    QueryMemoryCheckpoint(*renderer, "SteadyState", checkpoint);
+    checkpoints.push_back(checkpoint);
+
+    if (verbose || showTiming)
+    {
+        for (const MemoryCheckpoint& entry : checkpoints)
+            Log::Printf("Memory %s: device-local = %.2f MB, system = %.2f MB\n", entry.name, BytesToMB(entry.deviceLocal), BytesToMB(entry.system));
+    }
+
+    // Write current checkpoints into output folder
+    const std::string baselineName  = GetBaselineName("Memory");
+    const std::string resultPath    = outputDir + moduleName + "/" + baselineName + ".Result.json";
+    const std::string refPath       = "Reference/" + baselineName + ".Ref.json";
+
+    std::ofstream file{ resultPath };
+    if (file.good())
+    {
+        file << "{\n";
+        file << "  \"module\": \"" << moduleName << "\",\n";
+        file << "  \"checkpoints\": {\n";
+
+        char line[256];
+        for_range(i, checkpoints.size())
+        {
+            ::snprintf(
+                line, sizeof(line),
+                "    \"%s\": { \"deviceLocal\": %" PRIu64 ", \"system\": %" PRIu64 " }%s\n",
+                checkpoints[i].name, checkpoints[i].deviceLocal, checkpoints[i].system,
+                (i + 1 < checkpoints.size() ? "," : "")
+            );
+            file << line;
+        }
+
+        file << "  }\n";
+        file << "}\n";
+    }
+    else
+        Log::Errorf("Failed to save memory footprint results: %s\n", resultPath.c_str());
+
+    // Compare steady state with baseline; the other checkpoints are only recorded, since they depend on driver-side allocation strategies
+    std::ifstream refFile{ refPath };
+    if (!refFile.good())
+    {
+        Log::Printf("No memory footprint baseline found: %s (copy %s to create it)\n", refPath.c_str(), resultPath.c_str());
+        return TestResult::Passed;
+    }
+
+    const MemoryCheckpoint& steadyState = checkpoints.back();
+
+    for (std::string line; std::getline(refFile, line);)
+    {
+        std::uint64_t deviceLocal = 0, system = 0;
+        if (::sscanf(line.c_str(), " \"SteadyState\" : { \"deviceLocal\" : %" SCNu64 " , \"system\" : %" SCNu64, &deviceLocal, &system) != 2)
+            continue;
+
+        const bool deviceLocalRegression    = IsMemoryRegression(deviceLocal, steadyState.deviceLocal, memThreshold);
+        const bool systemRegression         = IsMemoryRegression(system, steadyState.system, memThreshold);
+
+        if (deviceLocalRegression || systemRegression)
+        {
+            Log::Errorf(
+                "Memory SteadyState: [ REGRESSION ] device-local %.2f MB (baseline %.2f MB), system %.2f MB (baseline %.2f MB)\n",
+                BytesToMB(steadyState.deviceLocal), BytesToMB(deviceLocal), BytesToMB(steadyState.system), BytesToMB(system)
+            );
+            return TestResult::FailedMismatch;
+        }
+
+        return TestResult::Passed;
+    }
+
+    if (verbose)
+        Log::Printf("Memory SteadyState: No baseline\n");
+
+    return TestResult::Passed;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,124 @@
+/*
+ * TestRenderTargetActiveExtent.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+
+
+/*
+Renders into a render target at a smaller active extent as it is used for dynamic resolution scaling.
+The content within the active extent must be updated, while the clamping rules of RenderTarget::SetActiveExtent must hold.
+The content outside the active extent is not verified, since backends without a render area clear the entire attachments.
+*/
+DEF_TEST( RenderTargetActiveExtent )
+{
+    const Extent2D maxResolution{ 256, 256 };
+
+    TextureDescriptor texDesc;
+    {
+        texDesc.format          = Format::RGBA8UNorm;
+        texDesc.extent.width    = maxResolution.width;
+        texDesc.extent.height   = maxResolution.height;
+        texDesc.bindFlags       = BindFlags::ColorAttachment | BindFlags::Sampled | BindFlags::CopySrc;
+        texDesc.mipLevels       = 1;
+    }
+    CREATE_TEXTURE(colorTex, texDesc, "colorTex{256x256,rgba8}", nullptr);
+
+    RenderTargetDescriptor targetDesc;
+    {
+        targetDesc.resolution           = maxResolution;
+        targetDesc.colorAttachments[0]  = colorTex;
+    }
+    CREATE_RENDER_TARGET(target, targetDesc, "target{256x256,rgba8}");
+
+    // Active extent defaults to the entire resolution and clamps larger extents
+    TestResult result = TestResult::Passed;
+
+    auto ExpectActiveExtent = [&result, target](const Extent2D& extent, const Extent2D& expectedExtent)
+    {
+        target->SetActiveExtent(extent);
+        const Extent2D activeExtent = target->GetActiveExtent();
+        if (activeExtent != expectedExtent)
+        {
+            Log::Errorf(
+                "Mismatch between active extent (%ux%u) and expected extent (%ux%u) after setting %ux%u\n",
+                activeExtent.width, activeExtent.height, expectedExtent.width, expectedExtent.height, extent.width, extent.height
+            );
+            result = TestResult::FailedMismatch;
+        }
+    };
+
+    ExpectActiveExtent(Extent2D{ 0, 0 }, maxResolution);
+    ExpectActiveExtent(Extent2D{ 1024, 64 }, Extent2D{ 256, 64 });
+    ExpectActiveExtent(Extent2D{ 128, 0 }, maxResolution);
+
+    // Clear entire render target, then clear it again with a smaller active extent, which must not reallocate any attachment
+    const Extent2D activeExtent{ 128, 64 };
+
+    cmdBuffer->Begin();
+    {
+        target->SetActiveExtent(Extent2D{});
+        cmdBuffer->BeginRenderPass(*target);
+        {
+            cmdBuffer->Clear(ClearFlags::Color, ClearValue{ 0.0f, 0.0f, 1.0f, 1.0f });
+        }
+        cmdBuffer->EndRenderPass();
+
+        target->SetActiveExtent(activeExtent);
+        cmdBuffer->BeginRenderPass(*target);
+        {
+            cmdBuffer->SetViewport(target->GetActiveExtent());
+            cmdBuffer->Clear(ClearFlags::Color, ClearValue{ 1.0f, 0.0f, 0.0f, 1.0f });
+        }
+        cmdBuffer->EndRenderPass();
+    }
+    cmdBuffer->End();
+
+    if (target->GetResolution() != maxResolution)
+    {
+        Log::Errorf("Render target resolution changed after rendering with smaller active extent\n");
+        result = TestResult::FailedMismatch;
+    }
+
+    // Read back texels at the corners of the active extent
+    const Offset3D readbackPositions[] =
+    {
+        Offset3D{ 0, 0, 0 },
+        Offset3D{ static_cast<std::int32_t>(activeExtent.width - 1), static_cast<std::int32_t>(activeExtent.height - 1), 0 },
+    };
+
+    for (const Offset3D& pos : readbackPositions)
+    {
+        std::uint8_t texel[4] = {};
+
+        DstImageDescriptor dstImageDesc;
+        {
+            dstImageDesc.format     = ImageFormat::RGBA;
+            dstImageDesc.dataType   = DataType::UInt8;
+            dstImageDesc.data       = texel;
+            dstImageDesc.dataSize   = sizeof(texel);
+        }
+        renderer->ReadTexture(*colorTex, TextureRegion{ pos, Extent3D{ 1, 1, 1 } }, dstImageDesc);
+
+        if (texel[0] != 0xFF || texel[1] != 0x00 || texel[2] != 0x00)
+        {
+            Log::Errorf(
+                "Mismatch between texel at (%d, %d) inside active extent (%02X%02X%02X) and expected color (FF0000)\n",
+                pos.x, pos.y, texel[0], texel[1], texel[2]
+            );
+            result = TestResult::FailedMismatch;
+        }
+    }
+
+    renderer->Release(*target);
+    renderer->Release(*colorTex);
+
+    return result;
+}
+
+
+
+// ================================================================================
@@ -11,6 +11,8 @@
 #include <LLGL/Utils/TypeNames.h>
 #include <Gauss/ProjectionMatrix4.h>
 #include <string.h>
+#include <stdlib.h>
+#include <algorithm>
 #include <fstream>
 
 
@@ -39,6 +41,24 @@ static std::string FindOutputDir(int argc, char* argv[])
     return g_defaultOutputDir;
 }
 
+static const char* FindArgumentValue(int argc, char* argv[], const char* search)
+{
+    const std::size_t searchLen = ::strlen(search);
+    for (int i = 0; i < argc; ++i)
+    {
+        if (::strncmp(argv[i], search, searchLen) == 0)
+            return argv[i] + searchLen;
+    }
+    return nullptr;
+}
+
+static unsigned FindArgumentUInt(int argc, char* argv[], const char* search, unsigned defaultValue)
+{
+    if (const char* value = FindArgumentValue(argc, argv, search))
+        return static_cast<unsigned>(::strtoul(value, nullptr, 10));
+    return defaultValue;
+}
+
 static std::string SanitizePath(std::string path)
 {
     for (char& chr : path)
@@ -52,11 +72,16 @@ static std::string SanitizePath(std::string path)
 }
 
 TestbedContext::TestbedContext(const char* moduleName, int argc, char* argv[]) :
-    moduleName { moduleName                                                            },
-    outputDir  { SanitizePath(FindOutputDir(argc, argv))                               },
-    verbose    { HasArgument(argc, argv, "-v") || HasArgument(argc, argv, "--verbose") },
-    showTiming { HasArgument(argc, argv, "-t") || HasArgument(argc, argv, "--timing")  },
-    fastTest   { HasArgument(argc, argv, "-f") || HasArgument(argc, argv, "--fast")    }
+    moduleName     { moduleName                                                            },
+    outputDir      { SanitizePath(FindOutputDir(argc, argv))                               },
+    verbose        { HasArgument(argc, argv, "-v") || HasArgument(argc, argv, "--verbose") },
+    showTiming     { HasArgument(argc, argv, "-t") || HasArgument(argc, argv, "--timing")  },
+    fastTest       { HasArgument(argc, argv, "-f") || HasArgument(argc, argv, "--fast")    },
+    perfMode       { HasArgument(argc, argv, "--perf")                                     },
+    perfWarmup     { FindArgumentUInt(argc, argv, "--perf-warmup=", 2)                     },
+    perfIterations { std::max(1u, FindArgumentUInt(argc, argv, "--perf-iterations=", 10))  },
+    perfThreshold  { FindArgumentUInt(argc, argv, "--perf-threshold=", 10) / 100.0         },
+    memThreshold   { FindArgumentUInt(argc, argv, "--mem-threshold=", 10) / 100.0          }
 {
     RenderSystemDescriptor rendererDesc;
     {
@@ -109,6 +134,10 @@ TestbedContext::TestbedContext(const char* moduleName, int argc, char* argv[]) :
         CreateConstantBuffers();
         LoadShaders();
         LoadProjectionMatrix();
+
+        // Create resources to measure GPU times in performance mode
+        if (perfMode)
+            CreatePerfResources();
     }
 }
 
@@ -131,12 +160,11 @@ static void PrintTestResult(TestResult result, const char* name)
 
 void TestbedContext::RunAllTests()
 {
-    #define RUN_TEST(TEST)                                                          \
-        {                                                                           \
-            const TestResult result = RunTest(                                      \
-                std::bind(&TestbedContext::Test##TEST, this, std::placeholders::_1) \
-            );                                                                      \
-            RecordTestResult(result, #TEST);                                        \
+    #define RUN_TEST(TEST)                                                                              \
+        {                                                                                               \
+            const auto callback = std::bind(&TestbedContext::Test##TEST, this, std::placeholders::_1);  \
+            const TestResult result = (perfMode ? RunPerfTest(callback, #TEST) : RunTest(callback));    \
+            RecordTestResult(result, #TEST);                                                            \
         }
 
     // Run all unit tests
@@ -156,9 +184,15 @@ void TestbedContext::RunAllTests()
     RUN_TEST( RenderTargetNoAttachments );
     RUN_TEST( RenderTarget1Attachment   );
     RUN_TEST( RenderTargetNAttachments  );
+    RUN_TEST( RenderTargetActiveExtent  );
+    RUN_TEST( MemoryFootprint           );
 
     #undef RUN_TEST
 
+    // Compare timings with performance baseline; regressions count as failures
+    if (perfMode)
+        failures += ComparePerfRecordsWithBaseline();
+
     // Print summary
     if (failures == 1)
         Log::Printf(" ==> 1 TEST FAILED\n", failures);
@@ -46,6 +46,9 @@ class TestbedContext
 
         TestResult RunTest(const std::function<TestResult(unsigned)>& callback);
 
+        // Runs the specified test repeatedly and records its CPU and GPU times. Only used in performance mode (--perf).
+        TestResult RunPerfTest(const std::function<TestResult(unsigned)>& callback, const char* name);
+
         TestResult CreateBuffer(
             const LLGL::BufferDescriptor&   desc,
             const char*                     name,
@@ -128,6 +131,15 @@ class TestbedContext
             void FinalizeMesh(IndexedTriangleMesh& outMesh);
         };
 
+        struct PerfRecord
+        {
+            std::string name;
+            double      cpuMedian   = 0.0; // CPU times in milliseconds
+            double      cpuP95      = 0.0;
+            double      gpuMedian   = 0.0; // GPU times in milliseconds; zero if timestamp queries are not supported
+            double      gpuP95      = 0.0;
+        };
+
         struct SceneConstants
         {
             Gs::Matrix4f wvpMatrix;
@@ -144,6 +156,11 @@ class TestbedContext
         const bool                  verbose;
         const bool                  showTiming;
         const bool                  fastTest; // Skip slow buffer/texture creations to speed up test run
+        const bool                  perfMode; // Repeat each test and compare its timings against the reference baseline
+        const unsigned              perfWarmup;
+        const unsigned              perfIterations;
+        const double                perfThreshold; // Relative slowdown of the median time that is considered a regression, e.g. 0.1 for 10%
+        const double                memThreshold; // Relative growth of the steady-state memory footprint that is considered a regression
 
         unsigned                    failures                = 0;
 
@@ -163,6 +180,10 @@ class TestbedContext
         LLGL::Shader*               shaders[ShaderCount]    = {};
         Gs::Matrix4f                projection;
 
+        LLGL::QueryHeap*            perfTimerHeap           = nullptr;
+        LLGL::CommandBuffer*        perfCmdBuffer           = nullptr;
+        std::vector<PerfRecord>     perfRecords;
+
     private:
 
         #define DECL_TEST(NAME) \
@@ -184,6 +205,8 @@ class TestbedContext
         DECL_TEST( RenderTargetNoAttachments );
         DECL_TEST( RenderTarget1Attachment );
         DECL_TEST( RenderTargetNAttachments );
+        DECL_TEST( RenderTargetActiveExtent );
+        DECL_TEST( MemoryFootprint );
 
         #undef DECL_TEST
 
@@ -207,6 +230,14 @@ class TestbedContext
 
         void RecordTestResult(TestResult result, const char* name);
 
+        void CreatePerfResources();
+
+        // Returns the name of a baseline for the current renderer and device, e.g. "Perf.OpenGL.NVIDIA_GeForce_GTX_1070" for category "Perf".
+        std::string GetBaselineName(const char* category) const;
+
+        // Writes the performance records into the output folder and compares them against the reference baseline. Returns the number of regressions.
+        unsigned ComparePerfRecordsWithBaseline();
+
         std::string FormatByteArray(const void* data, std::size_t size);
 
 };
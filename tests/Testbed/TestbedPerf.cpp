@@ -0,0 +1,311 @@
+/*
+ * TestbedPerf.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <fstream>
+#include <ctype.h>
+#include <stdio.h>
+
+
+// Minimal absolute slowdown (in milliseconds) before a relative slowdown is considered a regression, to ignore timer noise of very short tests
+static constexpr double g_perfMinRegressionMs = 0.05;
+
+static double TicksToMilliseconds(std::uint64_t ticks)
+{
+    return (static_cast<double>(ticks) * 1000.0) / static_cast<double>(Timer::Frequency());
+}
+
+static double NanosecondsToMilliseconds(std::uint64_t nanoseconds)
+{
+    return static_cast<double>(nanoseconds) / 1000000.0;
+}
+
+static double GetMedian(const std::vector<double>& sortedSamples)
+{
+    const std::size_t n = sortedSamples.size();
+    if (n == 0)
+        return 0.0;
+    if (n % 2 == 0)
+        return (sortedSamples[n/2 - 1] + sortedSamples[n/2]) * 0.5;
+    return sortedSamples[n/2];
+}
+
+// Returns the sample at the specified percentile (in the range [0, 1]) using the nearest-rank method.
+static double GetPercentile(const std::vector<double>& sortedSamples, double percentile)
+{
+    const std::size_t n = sortedSamples.size();
+    if (n == 0)
+        return 0.0;
+    const std::size_t rank = static_cast<std::size_t>(percentile * static_cast<double>(n) + 0.999999);
+    return sortedSamples[std::max<std::size_t>(1, std::min(rank, n)) - 1];
+}
+
+static std::string SanitizeBaselineName(const std::string& name)
+{
+    std::string s;
+    s.reserve(name.size());
+    for (char chr : name)
+    {
+        if (::isalnum(static_cast<unsigned char>(chr)) != 0)
+            s.push_back(chr);
+        else if (!s.empty() && s.back() != '_')
+            s.push_back('_');
+    }
+    while (!s.empty() && s.back() == '_')
+        s.pop_back();
+    return s;
+}
+
+static bool RendererSupportsTimestampQueries(int rendererID)
+{
+    switch (rendererID)
+    {
+        case RendererID::OpenGL:
+        case RendererID::Direct3D11:
+        case RendererID::Direct3D12:
+        case RendererID::Vulkan:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void TestbedContext::CreatePerfResources()
+{
+    // Create separate command buffer to write timestamps before and after each test iteration
+    if (RendererSupportsTimestampQueries(renderer->GetRendererID()))
+    {
+        QueryHeapDescriptor queryDesc;
+        {
+            queryDesc.type          = QueryType::Timestamp;
+            queryDesc.numQueries    = 2;
+        }
+        perfTimerHeap = renderer->CreateQueryHeap(queryDesc);
+
+        CommandBufferDescriptor cmdBufferDesc;
+        {
+            cmdBufferDesc.flags = CommandBufferFlags::ImmediateSubmit;
+        }
+        perfCmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
+    }
+    else
+        Log::Printf("Timestamp queries not supported: Only CPU times are recorded\n");
+}
+
+std::string TestbedContext::GetBaselineName(const char* category) const
+{
+    const RendererInfo& info = renderer->GetRendererInfo();
+    return std::string(category) + "." + SanitizeBaselineName(moduleName) + "." + SanitizeBaselineName(info.deviceName);
+}
+
+TestResult TestbedContext::RunPerfTest(const std::function<TestResult(unsigned)>& callback, const char* name)
+{
+    std::vector<double> cpuTimes, gpuTimes;
+    cpuTimes.reserve(perfIterations);
+    gpuTimes.reserve(perfIterations);
+
+    for (unsigned i = 0, numRuns = perfWarmup + perfIterations; i < numRuns; ++i)
+    {
+        // Write timestamp before the test is encoded
+        if (perfCmdBuffer != nullptr)
+        {
+            perfCmdBuffer->Begin();
+            perfCmdBuffer->EndQuery(*perfTimerHeap, 0);
+            perfCmdBuffer->End();
+        }
+
+        const std::uint64_t startTime = Timer::Tick();
+        const TestResult result = RunTest(callback);
+        const std::uint64_t endTime = Timer::Tick();
+
+        // Only record timings of passed tests; failures are reported by the caller
+        if (result != TestResult::Passed)
+            return result;
+
+        // Write timestamp after all commands of the test and wait for the GPU to retrieve both timestamps
+        if (perfCmdBuffer != nullptr)
+        {
+            perfCmdBuffer->Begin();
+            perfCmdBuffer->EndQuery(*perfTimerHeap, 1);
+            perfCmdBuffer->End();
+        }
+
+        cmdQueue->WaitIdle();
+
+        // Discard warmup runs, since they include driver-side shader compilation and allocations
+        if (i < perfWarmup)
+            continue;
+
+        cpuTimes.push_back(TicksToMilliseconds(endTime - startTime));
+
+        std::uint64_t timestamps[2] = {};
+        if (perfTimerHeap != nullptr && cmdQueue->QueryResult(*perfTimerHeap, 0, 2, timestamps, sizeof(timestamps)) && timestamps[1] > timestamps[0])
+            gpuTimes.push_back(NanosecondsToMilliseconds(timestamps[1] - timestamps[0]));
+    }
+
+    std::sort(cpuTimes.begin(), cpuTimes.end());
+    std::sort(gpuTimes.begin(), gpuTimes.end());
+
+    PerfRecord record;
+    {
+        record.name         = name;
+        record.cpuMedian    = GetMedian(cpuTimes);
+        record.cpuP95       = GetPercentile(cpuTimes, 0.95);
+        record.gpuMedian    = GetMedian(gpuTimes);
+        record.gpuP95       = GetPercentile(gpuTimes, 0.95);
+    }
+    perfRecords.push_back(record);
+
+    if (verbose || showTiming)
+    {
+        Log::Printf(
+            "Perf %s: CPU median = %.3f ms, p95 = %.3f ms; GPU median = %.3f ms, p95 = %.3f ms\n",
+            name, record.cpuMedian, record.cpuP95, record.gpuMedian, record.gpuP95
+        );
+    }
+
+    return TestResult::Passed;
+}
+
+/*
+Baselines are written and parsed as JSON with one test per line, so a result file can be copied into the Reference folder as is:
+{
+  "module": "OpenGL",
+  "device": "NVIDIA GeForce GTX 1070/PCIe/SSE2",
+  "tests": {
+    "BufferMap": { "cpuMedian": 0.512, "cpuP95": 0.640, "gpuMedian": 0.101, "gpuP95": 0.120 },
+    ...
+  }
+}
+*/
+static std::string EscapeJSONString(const std::string& str)
+{
+    std::string s;
+    s.reserve(str.size());
+    for (char chr : str)
+    {
+        if (chr == '\"' || chr == '\\')
+            s.push_back('\\');
+        if (static_cast<unsigned char>(chr) >= 0x20)
+            s.push_back(chr);
+    }
+    return s;
+}
+
+static bool IsPerfRegression(double baselineTime, double currentTime, double threshold)
+{
+    return (baselineTime > 0.0 && currentTime - baselineTime > std::max(baselineTime * threshold, g_perfMinRegressionMs));
+}
+
+unsigned TestbedContext::ComparePerfRecordsWithBaseline()
+{
+    const std::string baselineName  = GetBaselineName("Perf");
+    const std::string resultPath    = outputDir + moduleName + "/" + baselineName + ".Result.json";
+    const std::string refPath       = "Reference/" + baselineName + ".Ref.json";
+
+    // Write current records into output folder
+    std::ofstream file{ resultPath };
+    if (file.good())
+    {
+        file << "{\n";
+        file << "  \"module\": \"" << EscapeJSONString(moduleName) << "\",\n";
+        file << "  \"device\": \"" << EscapeJSONString(renderer->GetRendererInfo().deviceName) << "\",\n";
+        file << "  \"tests\": {\n";
+
+        char line[512];
+        for_range(i, perfRecords.size())
+        {
+            const PerfRecord& record = perfRecords[i];
+            ::snprintf(
+                line, sizeof(line),
+                "    \"%s\": { \"cpuMedian\": %.4f, \"cpuP95\": %.4f, \"gpuMedian\": %.4f, \"gpuP95\": %.4f }%s\n",
+                record.name.c_str(), record.cpuMedian, record.cpuP95, record.gpuMedian, record.gpuP95,
+                (i + 1 < perfRecords.size() ? "," : "")
+            );
+            file << line;
+        }
+
+        file << "  }\n";
+        file << "}\n";
+
+        if (verbose)
+            Log::Printf("Save performance results: %s [ Ok ]\n", resultPath.c_str());
+    }
+    else
+        Log::Errorf("Failed to save performance results: %s\n", resultPath.c_str());
+
+    // Read baseline records from reference folder
+    std::ifstream refFile{ refPath };
+    if (!refFile.good())
+    {
+        Log::Printf("No performance baseline found: %s (copy %s to create it)\n", refPath.c_str(), resultPath.c_str());
+        return 0;
+    }
+
+    std::vector<PerfRecord> baselineRecords;
+    for (std::string line; std::getline(refFile, line);)
+    {
+        char name[128] = {};
+        PerfRecord record;
+        const int numFields = ::sscanf(
+            line.c_str(),
+            " \"%127[^\"]\" : { \"cpuMedian\" : %lf , \"cpuP95\" : %lf , \"gpuMedian\" : %lf , \"gpuP95\" : %lf",
+            name, &record.cpuMedian, &record.cpuP95, &record.gpuMedian, &record.gpuP95
+        );
+        if (numFields == 5)
+        {
+            record.name = name;
+            baselineRecords.push_back(record);
+        }
+    }
+
+    // Compare median times with baseline; p95 times are only reported since they are too noisy for a reliable comparison
+    unsigned numRegressions = 0;
+
+    for (const PerfRecord& record : perfRecords)
+    {
+        auto it = std::find_if(
+            baselineRecords.begin(), baselineRecords.end(),
+            [&record](const PerfRecord& entry) -> bool
+            {
+                return (entry.name == record.name);
+            }
+        );
+
+        if (it == baselineRecords.end())
+        {
+            if (verbose)
+                Log::Printf("Perf %s: No baseline\n", record.name.c_str());
+            continue;
+        }
+
+        const bool cpuRegression = IsPerfRegression(it->cpuMedian, record.cpuMedian, perfThreshold);
+        const bool gpuRegression = (record.gpuMedian > 0.0 && IsPerfRegression(it->gpuMedian, record.gpuMedian, perfThreshold));
+
+        if (cpuRegression || gpuRegression)
+        {
+            Log::Errorf(
+                "Perf %s: [ REGRESSION ] CPU median %.3f ms (baseline %.3f ms), GPU median %.3f ms (baseline %.3f ms)\n",
+                record.name.c_str(), record.cpuMedian, it->cpuMedian, record.gpuMedian, it->gpuMedian
+            );
+            ++numRegressions;
+        }
+    }
+
+    if (numRegressions == 1)
+        Log::Printf(" ==> 1 PERFORMANCE REGRESSION (threshold = %.0f%%)\n", perfThreshold * 100.0);
+    else if (numRegressions > 1)
+        Log::Printf(" ==> %u PERFORMANCE REGRESSIONS (threshold = %.0f%%)\n", numRegressions, perfThreshold * 100.0);
+
+    return numRegressions;
+}
+
+
+
+// ================================================================================
@@ -39,6 +39,12 @@ LLGL_C_EXPORT void llglExecute(LLGLCommandBuffer deferredCommandBuffer)
     g_CurrentCmdBuf->Execute(LLGL_REF(CommandBuffer, deferredCommandBuffer));
 }
 
+LLGL_C_EXPORT void llglTrimCommandBufferMemory(LLGLCommandBuffer commandBuffer)
+{
+    LLGL_ASSERT(g_CurrentCmdBuf != LLGL_PTR(CommandBuffer, commandBuffer));
+    LLGL_PTR(CommandBuffer, commandBuffer)->TrimMemory();
+}
+
 LLGL_C_EXPORT void llglUpdateBuffer(LLGLBuffer dstBuffer, uint64_t dstOffset, const void* data, uint16_t dataSize)
 {
     g_CurrentCmdBuf->UpdateBuffer(LLGL_REF(Buffer, dstBuffer), dstOffset, data, dataSize);
@@ -59,6 +65,11 @@ LLGL_C_EXPORT void llglFillBuffer(LLGLBuffer dstBuffer, uint64_t dstOffset, uint
     g_CurrentCmdBuf->FillBuffer(LLGL_REF(Buffer, dstBuffer), dstOffset, value, fillSize);
 }
 
+LLGL_C_EXPORT void llglFillBufferPattern(LLGLBuffer dstBuffer, uint64_t dstOffset, const void* pattern, uint32_t patternSize, uint64_t fillSize)
+{
+    g_CurrentCmdBuf->FillBufferPattern(LLGL_REF(Buffer, dstBuffer), dstOffset, pattern, patternSize, fillSize);
+}
+
 LLGL_C_EXPORT void llglCopyTexture(LLGLTexture dstTexture, const LLGLTextureLocation* dstLocation, LLGLTexture srcTexture, const LLGLTextureLocation* srcLocation, const LLGLExtent3D* extent)
 {
     g_CurrentCmdBuf->CopyTexture(LLGL_REF(Texture, dstTexture), *(const TextureLocation*)dstLocation, LLGL_REF(Texture, srcTexture), *(const TextureLocation*)srcLocation, *(const Extent3D*)extent);
@@ -84,6 +95,11 @@ LLGL_C_EXPORT void llglGenerateMipsRange(LLGLTexture texture, const LLGLTextureS
     g_CurrentCmdBuf->GenerateMips(LLGL_REF(Texture, texture), *(const TextureSubresource*)subresource);
 }
 
+LLGL_C_EXPORT void llglCompressTexture(LLGLTexture dstTexture, LLGLTexture srcTexture, const LLGLTextureSubresource* subresource)
+{
+    g_CurrentCmdBuf->CompressTexture(LLGL_REF(Texture, dstTexture), LLGL_REF(Texture, srcTexture), *(const TextureSubresource*)subresource);
+}
+
 LLGL_C_EXPORT void llglSetViewport(const LLGLViewport* viewport)
 {
     g_CurrentCmdBuf->SetViewport(*(const Viewport*)viewport);
@@ -134,6 +150,11 @@ LLGL_C_EXPORT void llglSetResource(uint32_t descriptor, LLGLResource resource)
     g_CurrentCmdBuf->SetResource(descriptor, LLGL_REF(Resource, resource));
 }
 
+LLGL_C_EXPORT void llglSetResourceExt(uint32_t descriptor, LLGLBuffer buffer, uint64_t offset, uint64_t size)
+{
+    g_CurrentCmdBuf->SetResource(descriptor, LLGL_REF(Buffer, buffer), offset, size);
+}
+
 LLGL_C_EXPORT void llglResetResourceSlots(LLGLResourceType resourceType, uint32_t firstSlot, uint32_t numSlots, long bindFlags, long stageFlags)
 {
     g_CurrentCmdBuf->ResetResourceSlots((ResourceType)resourceType, firstSlot, numSlots, bindFlags, stageFlags);
@@ -272,6 +293,31 @@ LLGL_C_EXPORT void llglDrawIndexedIndirectExt(LLGLBuffer buffer, uint64_t offset
     g_CurrentCmdBuf->DrawIndexedIndirect(LLGL_REF(Buffer, buffer), offset, numCommands, stride);
 }
 
+LLGL_C_EXPORT void llglDrawIndirectCount(LLGLBuffer argsBuffer, uint64_t argsOffset, LLGLBuffer countBuffer, uint64_t countOffset, uint32_t maxNumCommands, uint32_t stride)
+{
+    g_CurrentCmdBuf->DrawIndirectCount(LLGL_REF(Buffer, argsBuffer), argsOffset, LLGL_REF(Buffer, countBuffer), countOffset, maxNumCommands, stride);
+}
+
+LLGL_C_EXPORT void llglDrawIndexedIndirectCount(LLGLBuffer argsBuffer, uint64_t argsOffset, LLGLBuffer countBuffer, uint64_t countOffset, uint32_t maxNumCommands, uint32_t stride)
+{
+    g_CurrentCmdBuf->DrawIndexedIndirectCount(LLGL_REF(Buffer, argsBuffer), argsOffset, LLGL_REF(Buffer, countBuffer), countOffset, maxNumCommands, stride);
+}
+
+LLGL_C_EXPORT void llglDrawMeshTasks(uint32_t numWorkGroupsX, uint32_t numWorkGroupsY, uint32_t numWorkGroupsZ)
+{
+    g_CurrentCmdBuf->DrawMeshTasks(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+}
+
+LLGL_C_EXPORT void llglDrawMeshTasksIndirect(LLGLBuffer buffer, uint64_t offset, uint32_t numCommands, uint32_t stride)
+{
+    g_CurrentCmdBuf->DrawMeshTasksIndirect(LLGL_REF(Buffer, buffer), offset, numCommands, stride);
+}
+
+LLGL_C_EXPORT void llglDrawStreamOutput()
+{
+    g_CurrentCmdBuf->DrawStreamOutput();
+}
+
 LLGL_C_EXPORT void llglDispatch(uint32_t numWorkGroupsX, uint32_t numWorkGroupsY, uint32_t numWorkGroupsZ)
 {
     g_CurrentCmdBuf->Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
@@ -282,6 +328,17 @@ LLGL_C_EXPORT void llglDispatchIndirect(LLGLBuffer buffer, uint64_t offset)
     g_CurrentCmdBuf->DispatchIndirect(LLGL_REF(Buffer, buffer), offset);
 }
 
+LLGL_C_EXPORT void llglCompactIndirectArguments(LLGLBuffer dstBuffer, uint64_t dstOffset, LLGLBuffer countBuffer, uint64_t countOffset, LLGLBuffer srcBuffer, uint64_t srcOffset, LLGLBuffer visibilityBuffer, uint64_t visibilityOffset, uint32_t numCommands, uint32_t stride)
+{
+    g_CurrentCmdBuf->CompactIndirectArguments(
+        LLGL_REF(Buffer, dstBuffer), dstOffset,
+        LLGL_REF(Buffer, countBuffer), countOffset,
+        LLGL_REF(Buffer, srcBuffer), srcOffset,
+        LLGL_REF(Buffer, visibilityBuffer), visibilityOffset,
+        numCommands, stride
+    );
+}
+
 LLGL_C_EXPORT void llglPushDebugGroup(const char* name)
 {
     g_CurrentCmdBuf->PushDebugGroup(name);
@@ -302,6 +359,221 @@ LLGL_C_EXPORT bool llglGetNativeHandle(void* nativeHandle, size_t nativeHandleSi
     return g_CurrentCmdBuf->GetNativeHandle(nativeHandle, nativeHandleSize);
 }
 
+// Returns the command structure that follows the header or null if the command is too small to hold it.
+template <typename T>
+static const T* GetStreamCommand(const LLGLCommandStreamHeader* header, size_t extraSize = 0)
+{
+    if (header->size < sizeof(LLGLCommandStreamHeader) + sizeof(T) + extraSize)
+        return NULL;
+    return reinterpret_cast<const T*>(header + 1);
+}
+
+// Encodes the specified command into the command buffer. Returns false if the command is malformed or its opcode is unknown.
+static bool ExecuteStreamCommand(CommandBuffer& cmdBuf, const LLGLCommandStreamHeader* header)
+{
+    switch (header->opcode)
+    {
+        case LLGLCommandOpcodeUpdateBuffer:
+        {
+            const LLGLCommandUpdateBuffer* cmd = GetStreamCommand<LLGLCommandUpdateBuffer>(header);
+            if (cmd == NULL || header->size < sizeof(*header) + sizeof(*cmd) + cmd->dataSize)
+                return false;
+            cmdBuf.UpdateBuffer(LLGL_REF(Buffer, cmd->dstBuffer), cmd->dstOffset, cmd + 1, cmd->dataSize);
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetViewport:
+        {
+            const LLGLCommandSetViewport* cmd = GetStreamCommand<LLGLCommandSetViewport>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetViewport(*(const Viewport*)&(cmd->viewport));
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetScissor:
+        {
+            const LLGLCommandSetScissor* cmd = GetStreamCommand<LLGLCommandSetScissor>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetScissor(*(const Scissor*)&(cmd->scissor));
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetVertexBuffer:
+        {
+            const LLGLCommandSetVertexBuffer* cmd = GetStreamCommand<LLGLCommandSetVertexBuffer>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetVertexBuffer(LLGL_REF(Buffer, cmd->buffer));
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetVertexBufferArray:
+        {
+            const LLGLCommandSetVertexBufferArray* cmd = GetStreamCommand<LLGLCommandSetVertexBufferArray>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetVertexBufferArray(LLGL_REF(BufferArray, cmd->bufferArray));
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetIndexBuffer:
+        {
+            const LLGLCommandSetIndexBuffer* cmd = GetStreamCommand<LLGLCommandSetIndexBuffer>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetIndexBuffer(LLGL_REF(Buffer, cmd->buffer));
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetIndexBufferExt:
+        {
+            const LLGLCommandSetIndexBufferExt* cmd = GetStreamCommand<LLGLCommandSetIndexBufferExt>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetIndexBuffer(LLGL_REF(Buffer, cmd->buffer), (Format)cmd->format, cmd->offset);
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetResourceHeap:
+        {
+            const LLGLCommandSetResourceHeap* cmd = GetStreamCommand<LLGLCommandSetResourceHeap>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetResourceHeap(LLGL_REF(ResourceHeap, cmd->resourceHeap), cmd->descriptorSet);
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetResource:
+        {
+            const LLGLCommandSetResource* cmd = GetStreamCommand<LLGLCommandSetResource>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetResource(cmd->descriptor, LLGL_REF(Resource, cmd->resource));
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetPipelineState:
+        {
+            const LLGLCommandSetPipelineState* cmd = GetStreamCommand<LLGLCommandSetPipelineState>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.SetPipelineState(LLGL_REF(PipelineState, cmd->pipelineState));
+        }
+        return true;
+
+        case LLGLCommandOpcodeSetUniforms:
+        {
+            const LLGLCommandSetUniforms* cmd = GetStreamCommand<LLGLCommandSetUniforms>(header);
+            if (cmd == NULL || header->size < sizeof(*header) + sizeof(*cmd) + cmd->dataSize)
+                return false;
+            cmdBuf.SetUniforms(cmd->first, cmd + 1, cmd->dataSize);
+        }
+        return true;
+
+        case LLGLCommandOpcodeDraw:
+        {
+            const LLGLCommandDraw* cmd = GetStreamCommand<LLGLCommandDraw>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.Draw(cmd->numVertices, cmd->firstVertex);
+        }
+        return true;
+
+        case LLGLCommandOpcodeDrawIndexed:
+        {
+            const LLGLCommandDrawIndexed* cmd = GetStreamCommand<LLGLCommandDrawIndexed>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.DrawIndexed(cmd->numIndices, cmd->firstIndex, cmd->vertexOffset);
+        }
+        return true;
+
+        case LLGLCommandOpcodeDrawInstanced:
+        {
+            const LLGLCommandDrawInstanced* cmd = GetStreamCommand<LLGLCommandDrawInstanced>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.DrawInstanced(cmd->numVertices, cmd->firstVertex, cmd->numInstances, cmd->firstInstance);
+        }
+        return true;
+
+        case LLGLCommandOpcodeDrawIndexedInstanced:
+        {
+            const LLGLCommandDrawIndexedInstanced* cmd = GetStreamCommand<LLGLCommandDrawIndexedInstanced>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.DrawIndexedInstanced(cmd->numIndices, cmd->numInstances, cmd->firstIndex, cmd->vertexOffset, cmd->firstInstance);
+        }
+        return true;
+
+        case LLGLCommandOpcodeDrawIndirect:
+        {
+            const LLGLCommandDrawIndirect* cmd = GetStreamCommand<LLGLCommandDrawIndirect>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.DrawIndirect(LLGL_REF(Buffer, cmd->buffer), cmd->offset, cmd->numCommands, cmd->stride);
+        }
+        return true;
+
+        case LLGLCommandOpcodeDrawIndexedIndirect:
+        {
+            const LLGLCommandDrawIndirect* cmd = GetStreamCommand<LLGLCommandDrawIndirect>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.DrawIndexedIndirect(LLGL_REF(Buffer, cmd->buffer), cmd->offset, cmd->numCommands, cmd->stride);
+        }
+        return true;
+
+        case LLGLCommandOpcodeDispatch:
+        {
+            const LLGLCommandDispatch* cmd = GetStreamCommand<LLGLCommandDispatch>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.Dispatch(cmd->numWorkGroupsX, cmd->numWorkGroupsY, cmd->numWorkGroupsZ);
+        }
+        return true;
+
+        case LLGLCommandOpcodeDispatchIndirect:
+        {
+            const LLGLCommandDispatchIndirect* cmd = GetStreamCommand<LLGLCommandDispatchIndirect>(header);
+            if (cmd == NULL)
+                return false;
+            cmdBuf.DispatchIndirect(LLGL_REF(Buffer, cmd->buffer), cmd->offset);
+        }
+        return true;
+
+        default:
+        return false;
+    }
+}
+
+LLGL_C_EXPORT size_t llglExecuteCommandStream(const void* commands, size_t commandsSize)
+{
+    LLGL_ASSERT(g_CurrentCmdBuf != NULL);
+    LLGL_ASSERT_PTR(commands);
+    LLGL_ASSERT((reinterpret_cast<uintptr_t>(commands) & 0x7) == 0, "command stream must be 8-byte aligned");
+
+    /* Resolve thread-local command buffer only once for the entire stream */
+    CommandBuffer& cmdBuf = *g_CurrentCmdBuf;
+
+    const char* byteAlignedCommands = static_cast<const char*>(commands);
+    size_t numCommands = 0;
+
+    for (size_t offset = 0; offset + sizeof(LLGLCommandStreamHeader) <= commandsSize; ++numCommands)
+    {
+        const LLGLCommandStreamHeader* header = reinterpret_cast<const LLGLCommandStreamHeader*>(byteAlignedCommands + offset);
+        if (header->size < sizeof(LLGLCommandStreamHeader) || (header->size & 0x7) != 0 || header->size > commandsSize - offset)
+            break;
+        if (!ExecuteStreamCommand(cmdBuf, header))
+            break;
+        offset += header->size;
+    }
+
+    return numCommands;
+}
+
 
 // } /namespace LLGL
 
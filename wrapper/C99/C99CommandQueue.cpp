@@ -24,21 +24,51 @@ LLGL_C_EXPORT void llglSubmitCommandBuffer(LLGLCommandBuffer commandBuffer)
     g_CurrentCmdQueue->Submit(LLGL_REF(CommandBuffer, commandBuffer));
 }
 
+LLGL_C_EXPORT void llglUpdateTextureTileMappings(LLGLTexture texture, uint32_t numMappings, const LLGLTextureTileMapping* mappings)
+{
+    g_CurrentCmdQueue->UpdateTileMappings(LLGL_REF(Texture, texture), numMappings, reinterpret_cast<const TextureTileMapping*>(mappings));
+}
+
+LLGL_C_EXPORT void llglUpdateBufferTileMappings(LLGLBuffer buffer, uint32_t numMappings, const LLGLBufferTileMapping* mappings)
+{
+    g_CurrentCmdQueue->UpdateTileMappings(LLGL_REF(Buffer, buffer), numMappings, reinterpret_cast<const BufferTileMapping*>(mappings));
+}
+
 LLGL_C_EXPORT bool llglQueryResult(LLGLQueryHeap queryHeap, uint32_t firstQuery, uint32_t numQueries, void* data, size_t dataSize)
 {
     return g_CurrentCmdQueue->QueryResult(LLGL_REF(QueryHeap, queryHeap), firstQuery, numQueries, data, dataSize);
 }
 
+LLGL_C_EXPORT bool llglGetCalibratedTimestamps(LLGLCalibratedTimestamps* outTimestamps)
+{
+    return g_CurrentCmdQueue->GetCalibratedTimestamps(*reinterpret_cast<CalibratedTimestamps*>(outTimestamps));
+}
+
 LLGL_C_EXPORT void llglSubmitFence(LLGLFence fence)
 {
     g_CurrentCmdQueue->Submit(LLGL_REF(Fence, fence));
 }
 
+LLGL_C_EXPORT void llglSubmitFenceValue(LLGLFence fence, uint64_t value)
+{
+    g_CurrentCmdQueue->Submit(LLGL_REF(Fence, fence), value);
+}
+
+LLGL_C_EXPORT void llglSubmitWaitFence(LLGLFence fence, uint64_t value)
+{
+    g_CurrentCmdQueue->SubmitWait(LLGL_REF(Fence, fence), value);
+}
+
 LLGL_C_EXPORT bool llglWaitFence(LLGLFence fence, uint64_t timeout)
 {
     return g_CurrentCmdQueue->WaitFence(LLGL_REF(Fence, fence), timeout);
 }
 
+LLGL_C_EXPORT bool llglWaitFenceValue(LLGLFence fence, uint64_t value, uint64_t timeout)
+{
+    return g_CurrentCmdQueue->WaitFence(LLGL_REF(Fence, fence), value, timeout);
+}
+
 LLGL_C_EXPORT void llglWaitIdle()
 {
     g_CurrentCmdQueue->WaitIdle();
@@ -442,6 +442,9 @@ static void ConvertShaderDesc(ShaderDescriptor& dst, const LLGLShaderDescriptor&
     ConvertVertexShaderAttribs(dst.vertex, src.vertex);
     ConvertFragmentShaderAttribs(dst.fragment, src.fragment);
     ConvertComputeShaderAttribs(dst.compute, src.compute);
+
+    const ShaderSpecializationConstant* specializationConstants = reinterpret_cast<const ShaderSpecializationConstant*>(src.specializationConstants);
+    dst.specializationConstants.assign(specializationConstants, specializationConstants + src.numSpecializationConstants);
 }
 
 LLGL_C_EXPORT LLGLShader llglCreateShader(const LLGLShaderDescriptor* shaderDesc)
@@ -500,6 +503,8 @@ static void ConvertPipelineLayoutDesc(PipelineLayoutDescriptor& dst, const LLGLP
     dst.uniforms.resize(src.numUniforms);
     for_range(i, src.numUniforms)
         ConvertUniformDesc(dst.uniforms[i], src.uniforms[i]);
+
+    dst.bindlessHeap = src.bindlessHeap;
 }
 
 LLGL_C_EXPORT LLGLPipelineLayout llglCreatePipelineLayout(const LLGLPipelineLayoutDescriptor* pipelineLayoutDesc)
@@ -525,6 +530,8 @@ static void ConvertGraphicsPipelineDesc(GraphicsPipelineDescriptor& dst, const L
     dst.tessEvaluationShader    = LLGL_PTR(Shader, src.tessEvaluationShader);
     dst.geometryShader          = LLGL_PTR(Shader, src.geometryShader);
     dst.fragmentShader          = LLGL_PTR(Shader, src.fragmentShader);
+    dst.taskShader              = LLGL_PTR(Shader, src.taskShader);
+    dst.meshShader              = LLGL_PTR(Shader, src.meshShader);
     dst.primitiveTopology       = static_cast<PrimitiveTopology>(src.primitiveTopology);
 
     dst.viewports.resize(src.numViewports);
@@ -538,6 +545,8 @@ static void ConvertGraphicsPipelineDesc(GraphicsPipelineDescriptor& dst, const L
     ::memcpy(&(dst.rasterizer), &(src.rasterizer), sizeof(LLGLRasterizerDescriptor));
     ::memcpy(&(dst.blend), &(src.blend), sizeof(LLGLBlendDescriptor));
     ::memcpy(&(dst.tessellation), &(src.tessellation), sizeof(LLGLTessellationDescriptor));
+    ::memcpy(&(dst.shadingRate), &(src.shadingRate), sizeof(LLGLShadingRateDescriptor));
+    dst.viewMask                = src.viewMask;
 }
 
 LLGL_C_EXPORT LLGLPipelineState llglCreateGraphicsPipelineState(const LLGLGraphicsPipelineDescriptor* pipelineStateDesc)
@@ -551,8 +560,9 @@ LLGL_C_EXPORT LLGLPipelineState llglCreateGraphicsPipelineState(const LLGLGraphi
 
 static void ConvertComputePipelineDesc(ComputePipelineDescriptor& dst, const LLGLComputePipelineDescriptor& src)
 {
-    dst.pipelineLayout  = LLGL_PTR(PipelineLayout, src.pipelineLayout);
-    dst.computeShader   = LLGL_PTR(Shader, src.computeShader);
+    dst.pipelineLayout          = LLGL_PTR(PipelineLayout, src.pipelineLayout);
+    dst.computeShader           = LLGL_PTR(Shader, src.computeShader);
+    dst.requiredSubgroupSize    = src.requiredSubgroupSize;
 }
 
 LLGL_C_EXPORT LLGLPipelineState llglCreateComputePipelineState(const LLGLComputePipelineDescriptor* pipelineStateDesc)
@@ -47,6 +47,18 @@ LLGL_C_EXPORT LLGLRenderPass llglGetRenderTargetRenderPass(LLGLRenderTarget rend
     return LLGLRenderPass{ const_cast<RenderPass*>(LLGL_PTR(RenderTarget, renderTarget)->GetRenderPass()) };
 }
 
+LLGL_C_EXPORT void llglSetRenderTargetActiveExtent(LLGLRenderTarget renderTarget, const LLGLExtent2D* extent)
+{
+    LLGL_PTR(RenderTarget, renderTarget)->SetActiveExtent(Extent2D{ extent->width, extent->height });
+}
+
+LLGL_C_EXPORT void llglGetRenderTargetActiveExtent(LLGLRenderTarget renderTarget, LLGLExtent2D* outExtent)
+{
+    Extent2D extent = LLGL_PTR(RenderTarget, renderTarget)->GetActiveExtent();
+    outExtent->width = extent.width;
+    outExtent->height = extent.height;
+}
+
 
 // } /namespace LLGL
 
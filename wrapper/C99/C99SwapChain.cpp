@@ -50,6 +50,16 @@ LLGL_C_EXPORT bool llglSetVsyncInterval(LLGLSwapChain swapChain, uint32_t vsyncI
     return LLGL_PTR(SwapChain, swapChain)->SetVsyncInterval(vsyncInterval);
 }
 
+LLGL_C_EXPORT bool llglSetMaxFrameLatency(LLGLSwapChain swapChain, uint32_t maxFrameLatency)
+{
+    return LLGL_PTR(SwapChain, swapChain)->SetMaxFrameLatency(maxFrameLatency);
+}
+
+LLGL_C_EXPORT bool llglIsPresentModeSupported(LLGLSwapChain swapChain, LLGLPresentMode presentMode)
+{
+    return LLGL_PTR(SwapChain, swapChain)->IsPresentModeSupported(static_cast<PresentMode>(presentMode));
+}
+
 LLGL_C_EXPORT bool llglSwitchFullscreen(LLGLSwapChain swapChain, bool enable)
 {
     return LLGL_PTR(SwapChain, swapChain)->SwitchFullscreen(enable);
@@ -51,6 +51,13 @@ LLGL_C_EXPORT void llglGetTextureSubresourceFootprint(LLGLTexture texture, uint3
     *outFootprint = *reinterpret_cast<const LLGLSubresourceFootprint*>(&internalFootprint);
 }
 
+LLGL_C_EXPORT void llglGetTextureSparseTileExtent(LLGLTexture texture, LLGLExtent3D* outExtent)
+{
+    LLGL_ASSERT_PTR(outExtent);
+    const Extent3D internalExtent = LLGL_PTR(Texture, texture)->GetSparseTileExtent();
+    *outExtent = *reinterpret_cast<const LLGLExtent3D*>(&internalExtent);
+}
+
 
 // } /namespace LLGL
 
@@ -199,6 +199,19 @@ LLGL_STATIC_ASSERT_ENUM(TessellationPartition, Pow2);
 LLGL_STATIC_ASSERT_ENUM(TessellationPartition, FractionalOdd);
 LLGL_STATIC_ASSERT_ENUM(TessellationPartition, FractionalEven);
 
+LLGL_STATIC_ASSERT_ENUM(ShadingRate, Rate1x1);
+LLGL_STATIC_ASSERT_ENUM(ShadingRate, Rate1x2);
+LLGL_STATIC_ASSERT_ENUM(ShadingRate, Rate2x1);
+LLGL_STATIC_ASSERT_ENUM(ShadingRate, Rate2x2);
+LLGL_STATIC_ASSERT_ENUM(ShadingRate, Rate2x4);
+LLGL_STATIC_ASSERT_ENUM(ShadingRate, Rate4x2);
+LLGL_STATIC_ASSERT_ENUM(ShadingRate, Rate4x4);
+
+LLGL_STATIC_ASSERT_ENUM(ShadingRateCombiner, Keep);
+LLGL_STATIC_ASSERT_ENUM(ShadingRateCombiner, Replace);
+LLGL_STATIC_ASSERT_ENUM(ShadingRateCombiner, Min);
+LLGL_STATIC_ASSERT_ENUM(ShadingRateCombiner, Max);
+
 LLGL_STATIC_ASSERT_ENUM(RenderConditionMode, Wait);
 LLGL_STATIC_ASSERT_ENUM(RenderConditionMode, NoWait);
 LLGL_STATIC_ASSERT_ENUM(RenderConditionMode, ByRegionWait);
@@ -212,6 +225,10 @@ LLGL_STATIC_ASSERT_ENUM(StencilFace, FrontAndBack);
 LLGL_STATIC_ASSERT_ENUM(StencilFace, Front);
 LLGL_STATIC_ASSERT_ENUM(StencilFace, Back);
 
+LLGL_STATIC_ASSERT_ENUM(CommandQueueType, Graphics);
+LLGL_STATIC_ASSERT_ENUM(CommandQueueType, Compute);
+LLGL_STATIC_ASSERT_ENUM(CommandQueueType, Copy);
+
 LLGL_STATIC_ASSERT_ENUM(Format, Undefined);
 LLGL_STATIC_ASSERT_ENUM(Format, A8UNorm);
 LLGL_STATIC_ASSERT_ENUM(Format, R8UNorm);
@@ -356,6 +373,12 @@ LLGL_STATIC_ASSERT_ENUM(TextureSwizzle, Green);
 LLGL_STATIC_ASSERT_ENUM(TextureSwizzle, Blue);
 LLGL_STATIC_ASSERT_ENUM(TextureSwizzle, Alpha);
 
+LLGL_STATIC_ASSERT_ENUM(PresentMode, Default);
+LLGL_STATIC_ASSERT_ENUM(PresentMode, Fifo);
+LLGL_STATIC_ASSERT_ENUM(PresentMode, FifoRelaxed);
+LLGL_STATIC_ASSERT_ENUM(PresentMode, Mailbox);
+LLGL_STATIC_ASSERT_ENUM(PresentMode, Immediate);
+
 LLGL_STATIC_ASSERT_ENUM(SamplerAddressMode, Repeat);
 LLGL_STATIC_ASSERT_ENUM(SamplerAddressMode, Mirror);
 LLGL_STATIC_ASSERT_ENUM(SamplerAddressMode, Clamp);
@@ -372,6 +395,8 @@ LLGL_STATIC_ASSERT_ENUM(ShaderType, TessEvaluation);
 LLGL_STATIC_ASSERT_ENUM(ShaderType, Geometry);
 LLGL_STATIC_ASSERT_ENUM(ShaderType, Fragment);
 LLGL_STATIC_ASSERT_ENUM(ShaderType, Compute);
+LLGL_STATIC_ASSERT_ENUM(ShaderType, Task);
+LLGL_STATIC_ASSERT_ENUM(ShaderType, Mesh);
 
 LLGL_STATIC_ASSERT_ENUM(ShaderSourceType, CodeString);
 LLGL_STATIC_ASSERT_ENUM(ShaderSourceType, CodeFile);
@@ -425,6 +450,7 @@ LLGL_STATIC_ASSERT_ENUM(ResourceType, Undefined);
 LLGL_STATIC_ASSERT_ENUM(ResourceType, Buffer);
 LLGL_STATIC_ASSERT_ENUM(ResourceType, Texture);
 LLGL_STATIC_ASSERT_ENUM(ResourceType, Sampler);
+LLGL_STATIC_ASSERT_ENUM(ResourceType, AccelerationStructure);
 
 LLGL_STATIC_ASSERT_ENUM(Key, LButton);
 LLGL_STATIC_ASSERT_ENUM(Key, RButton);
@@ -597,6 +623,7 @@ LLGL_STATIC_ASSERT_ENUM(QueryType, TimeElapsed);
 LLGL_STATIC_ASSERT_ENUM(QueryType, StreamOutPrimitivesWritten);
 LLGL_STATIC_ASSERT_ENUM(QueryType, StreamOutOverflow);
 LLGL_STATIC_ASSERT_ENUM(QueryType, PipelineStatistics);
+LLGL_STATIC_ASSERT_ENUM(QueryType, Timestamp);
 
 LLGL_STATIC_ASSERT_ENUM(AttachmentLoadOp, Undefined);
 LLGL_STATIC_ASSERT_ENUM(AttachmentLoadOp, Load);
@@ -650,6 +677,7 @@ LLGL_STATIC_ASSERT_FLAG(ShaderCompile, OptimizationLevel3);
 LLGL_STATIC_ASSERT_FLAG(ShaderCompile, WarningsAreErrors);
 LLGL_STATIC_ASSERT_FLAG(ShaderCompile, PatchClippingOrigin);
 LLGL_STATIC_ASSERT_FLAG(ShaderCompile, SeparateShader);
+LLGL_STATIC_ASSERT_FLAG(ShaderCompile, StripBinary);
 
 LLGL_STATIC_ASSERT_FLAG(Stage, VertexStage);
 LLGL_STATIC_ASSERT_FLAG(Stage, TessControlStage);
@@ -657,8 +685,11 @@ LLGL_STATIC_ASSERT_FLAG(Stage, TessEvaluationStage);
 LLGL_STATIC_ASSERT_FLAG(Stage, GeometryStage);
 LLGL_STATIC_ASSERT_FLAG(Stage, FragmentStage);
 LLGL_STATIC_ASSERT_FLAG(Stage, ComputeStage);
+LLGL_STATIC_ASSERT_FLAG(Stage, TaskStage);
+LLGL_STATIC_ASSERT_FLAG(Stage, MeshStage);
 LLGL_STATIC_ASSERT_FLAG(Stage, AllTessStages);
 LLGL_STATIC_ASSERT_FLAG(Stage, AllGraphicsStages);
+LLGL_STATIC_ASSERT_FLAG(Stage, AllMeshStages);
 LLGL_STATIC_ASSERT_FLAG(Stage, AllStages);
 
 LLGL_STATIC_ASSERT_FLAG(Bind, VertexBuffer);
@@ -673,6 +704,8 @@ LLGL_STATIC_ASSERT_FLAG(Bind, DepthStencilAttachment);
 LLGL_STATIC_ASSERT_FLAG(Bind, CombinedSampler);
 LLGL_STATIC_ASSERT_FLAG(Bind, CopySrc);
 LLGL_STATIC_ASSERT_FLAG(Bind, CopyDst);
+LLGL_STATIC_ASSERT_FLAG(Bind, ShadingRateAttachment);
+LLGL_STATIC_ASSERT_FLAG(Bind, DeviceAddress);
 
 LLGL_STATIC_ASSERT_FLAG(CPUAccess, Read);
 LLGL_STATIC_ASSERT_FLAG(CPUAccess, Write);
@@ -782,6 +815,10 @@ LLGL_STATIC_ASSERT_OFFSET(TessellationDescriptor, indexFormat);
 LLGL_STATIC_ASSERT_OFFSET(TessellationDescriptor, maxTessFactor);
 LLGL_STATIC_ASSERT_OFFSET(TessellationDescriptor, outputWindingCCW);
 
+LLGL_STATIC_ASSERT_SIZE(ShadingRateDescriptor);
+LLGL_STATIC_ASSERT_OFFSET(ShadingRateDescriptor, rate);
+LLGL_STATIC_ASSERT_OFFSET(ShadingRateDescriptor, imageCombiner);
+
 LLGL_STATIC_ASSERT_SIZE(ClearValue);
 LLGL_STATIC_ASSERT_OFFSET(ClearValue, color);
 LLGL_STATIC_ASSERT_OFFSET(ClearValue, depth);
@@ -796,6 +833,14 @@ LLGL_STATIC_ASSERT_SIZE(CommandBufferDescriptor);
 LLGL_STATIC_ASSERT_OFFSET(CommandBufferDescriptor, flags);
 LLGL_STATIC_ASSERT_OFFSET(CommandBufferDescriptor, numNativeBuffers);
 LLGL_STATIC_ASSERT_OFFSET(CommandBufferDescriptor, minStagingPoolSize);
+LLGL_STATIC_ASSERT_OFFSET(CommandBufferDescriptor, stagingPoolTrimFrames);
+LLGL_STATIC_ASSERT_OFFSET(CommandBufferDescriptor, queueType);
+LLGL_STATIC_ASSERT_OFFSET(CommandBufferDescriptor, renderPass);
+
+LLGL_STATIC_ASSERT_SIZE(BufferTileMapping);
+LLGL_STATIC_ASSERT_OFFSET(BufferTileMapping, offset);
+LLGL_STATIC_ASSERT_OFFSET(BufferTileMapping, size);
+LLGL_STATIC_ASSERT_OFFSET(BufferTileMapping, resident);
 
 LLGL_STATIC_ASSERT_SIZE(FormatAttributes);
 LLGL_STATIC_ASSERT_OFFSET(FormatAttributes, bitSize);
@@ -828,6 +873,10 @@ LLGL_STATIC_ASSERT_OFFSET(TextureRegion, subresource);
 LLGL_STATIC_ASSERT_OFFSET(TextureRegion, offset);
 LLGL_STATIC_ASSERT_OFFSET(TextureRegion, extent);
 
+LLGL_STATIC_ASSERT_SIZE(TextureTileMapping);
+LLGL_STATIC_ASSERT_OFFSET(TextureTileMapping, region);
+LLGL_STATIC_ASSERT_OFFSET(TextureTileMapping, resident);
+
 LLGL_STATIC_ASSERT_SIZE(TextureDescriptor);
 LLGL_STATIC_ASSERT_OFFSET(TextureDescriptor, type);
 LLGL_STATIC_ASSERT_OFFSET(TextureDescriptor, bindFlags);
@@ -861,6 +910,7 @@ LLGL_STATIC_ASSERT_OFFSET(SwapChainDescriptor, stencilBits);
 LLGL_STATIC_ASSERT_OFFSET(SwapChainDescriptor, samples);
 LLGL_STATIC_ASSERT_OFFSET(SwapChainDescriptor, swapBuffers);
 LLGL_STATIC_ASSERT_OFFSET(SwapChainDescriptor, fullscreen);
+LLGL_STATIC_ASSERT_OFFSET(SwapChainDescriptor, presentMode);
 
 LLGL_STATIC_ASSERT_SIZE(RenderingFeatures);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasRenderTargets);
@@ -884,12 +934,26 @@ LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasComputeShaders);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasInstancing);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasOffsetInstancing);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasIndirectDrawing);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasIndirectCountDrawing);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasViewportArrays);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasConservativeRasterization);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasStreamOutputs);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasLogicOp);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasPipelineStatistics);
 LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasRenderCondition);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasBindlessResources);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasSparseResources);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasThreadSafeResourceCreation);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasVariableRateShading);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasShadingRateImage);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasMeshShaders);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasTextureCompression);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasSubgroupSizeControl);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasNativeIOQueue);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasMultiview);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasRayTracing);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasIndirectArgumentCompaction);
+LLGL_STATIC_ASSERT_OFFSET(RenderingFeatures, hasBufferDeviceAddress);
 
 LLGL_STATIC_ASSERT_SIZE(RenderingLimits);
 LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, lineWidthRange);
@@ -916,6 +980,13 @@ LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, maxColorBufferSamples);
 LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, maxDepthBufferSamples);
 LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, maxStencilBufferSamples);
 LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, maxNoAttachmentSamples);
+LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, shadingRateImageTileSize);
+LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, maxMultiviewViewCount);
+LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, minSubgroupSize);
+LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, maxSubgroupSize);
+LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, subgroupOperations);
+LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, subgroupStages);
+LLGL_STATIC_ASSERT_OFFSET(RenderingLimits, maxAccelerationStructureInstances);
 
 LLGL_STATIC_ASSERT_SIZE(SrcImageDescriptor);
 LLGL_STATIC_ASSERT_OFFSET(SrcImageDescriptor, format);
@@ -955,11 +1026,16 @@ LLGL_STATIC_ASSERT_SIZE(ResourceHeapDescriptor);
 LLGL_STATIC_ASSERT_OFFSET(ResourceHeapDescriptor, pipelineLayout);
 LLGL_STATIC_ASSERT_OFFSET(ResourceHeapDescriptor, numResourceViews);
 LLGL_STATIC_ASSERT_OFFSET(ResourceHeapDescriptor, barrierFlags);
+LLGL_STATIC_ASSERT_OFFSET(ResourceHeapDescriptor, numVersions);
 
 LLGL_STATIC_ASSERT_SIZE(ShaderMacro);
 LLGL_STATIC_ASSERT_OFFSET(ShaderMacro, name);
 LLGL_STATIC_ASSERT_OFFSET(ShaderMacro, definition);
 
+LLGL_STATIC_ASSERT_SIZE(ShaderSpecializationConstant);
+LLGL_STATIC_ASSERT_OFFSET(ShaderSpecializationConstant, id);
+LLGL_STATIC_ASSERT_OFFSET(ShaderSpecializationConstant, value);
+
 LLGL_STATIC_ASSERT_SIZE(ComputeShaderAttributes);
 LLGL_STATIC_ASSERT_OFFSET(ComputeShaderAttributes, workGroupSize);
 
@@ -976,6 +1052,7 @@ LLGL_STATIC_ASSERT_OFFSET(RenderTargetDescriptor, samples);
 LLGL_STATIC_ASSERT_OFFSET(RenderTargetDescriptor, colorAttachments);
 LLGL_STATIC_ASSERT_OFFSET(RenderTargetDescriptor, resolveAttachments);
 LLGL_STATIC_ASSERT_OFFSET(RenderTargetDescriptor, depthStencilAttachment);
+LLGL_STATIC_ASSERT_OFFSET(RenderTargetDescriptor, shadingRateImage);
 
 LLGL_STATIC_ASSERT_SIZE(BindingSlot);
 LLGL_STATIC_ASSERT_OFFSET(BindingSlot, index);
@@ -998,6 +1075,11 @@ LLGL_STATIC_ASSERT_OFFSET(QueryPipelineStatistics, tessControlShaderInvocations)
 LLGL_STATIC_ASSERT_OFFSET(QueryPipelineStatistics, tessEvaluationShaderInvocations);
 LLGL_STATIC_ASSERT_OFFSET(QueryPipelineStatistics, computeShaderInvocations);
 
+LLGL_STATIC_ASSERT_SIZE(CalibratedTimestamps);
+LLGL_STATIC_ASSERT_OFFSET(CalibratedTimestamps, cpuTicks);
+LLGL_STATIC_ASSERT_OFFSET(CalibratedTimestamps, gpuTimestamp);
+LLGL_STATIC_ASSERT_OFFSET(CalibratedTimestamps, maxDeviation);
+
 LLGL_STATIC_ASSERT_SIZE(QueryHeapDescriptor);
 LLGL_STATIC_ASSERT_OFFSET(QueryHeapDescriptor, type);
 LLGL_STATIC_ASSERT_OFFSET(QueryHeapDescriptor, numQueries);
@@ -1013,6 +1095,7 @@ LLGL_STATIC_ASSERT_OFFSET(RenderPassDescriptor, colorAttachments);
 LLGL_STATIC_ASSERT_OFFSET(RenderPassDescriptor, depthAttachment);
 LLGL_STATIC_ASSERT_OFFSET(RenderPassDescriptor, stencilAttachment);
 LLGL_STATIC_ASSERT_OFFSET(RenderPassDescriptor, samples);
+LLGL_STATIC_ASSERT_OFFSET(RenderPassDescriptor, viewMask);
 
 LLGL_STATIC_ASSERT_SIZE(DisplayModeDescriptor);
 LLGL_STATIC_ASSERT_OFFSET(DisplayModeDescriptor, resolution);
@@ -1040,6 +1123,9 @@ LLGL_STATIC_ASSERT_OFFSET(DrawPatchIndirectArguments, firstInstance);
 LLGL_STATIC_ASSERT_SIZE(DispatchIndirectArguments);
 LLGL_STATIC_ASSERT_OFFSET(DispatchIndirectArguments, numThreadGroups);
 
+LLGL_STATIC_ASSERT_SIZE(DrawMeshTasksIndirectArguments);
+LLGL_STATIC_ASSERT_OFFSET(DrawMeshTasksIndirectArguments, numThreadGroups);
+
 
 // } /namespace LLGL
 
@@ -117,6 +117,7 @@ static void ConvertWindowDesc(WindowDescriptor& dst, const LLGLWindowDescriptor&
     dst.resizable       = src.resizable;
     dst.acceptDropFiles = src.acceptDropFiles;
     dst.centered        = src.centered;
+    dst.threadedEvents  = src.threadedEvents;
     dst.windowContext   = src.windowContext;
 }
 
@@ -132,6 +133,7 @@ static void ConvertWindowDesc(LLGLWindowDescriptor& dst, const WindowDescriptor&
     dst.resizable       = src.resizable;
     dst.acceptDropFiles = src.acceptDropFiles;
     dst.centered        = src.centered;
+    dst.threadedEvents  = src.threadedEvents;
     dst.windowContext   = src.windowContext;
 }
 
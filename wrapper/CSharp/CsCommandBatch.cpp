@@ -0,0 +1,412 @@
+/*
+ * CsCommandBatch.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CsCommandBatch.h"
+#include <cstdint>
+#include <cstddef>
+
+
+/*
+ * Native command encoding
+ */
+
+#pragma unmanaged
+
+namespace SharpLLGL
+{
+
+
+enum class BatchOpcode : std::uint32_t
+{
+    UpdateBuffer,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    SetResourceHeap,
+    SetPipelineState,
+    Draw,
+    DrawInstanced,
+    DrawIndexed,
+    DrawIndexedInstanced,
+    Dispatch,
+};
+
+// Header of each command; commands are aligned to 8 bytes, so the native pointers within the payload remain aligned.
+struct BatchCommand
+{
+    BatchOpcode     opcode;
+    std::uint32_t   size;   // Size (in bytes) of this command including header and payload
+};
+
+struct BatchUpdateBuffer
+{
+    LLGL::Buffer*   buffer;
+    std::uint64_t   offset;
+    std::uint16_t   dataSize;   // Data follows this struct
+};
+
+struct BatchSetBuffer
+{
+    LLGL::Buffer*   buffer;
+};
+
+struct BatchSetResourceHeap
+{
+    LLGL::ResourceHeap* resourceHeap;
+    std::uint32_t       firstSet;
+};
+
+struct BatchSetPipelineState
+{
+    LLGL::PipelineState* pipelineState;
+};
+
+struct BatchDraw
+{
+    std::uint32_t   numVertices;
+    std::uint32_t   firstVertex;
+    std::uint32_t   numInstances;
+    std::uint32_t   firstInstance;
+};
+
+struct BatchDrawIndexed
+{
+    std::uint32_t   numIndices;
+    std::uint32_t   numInstances;
+    std::uint32_t   firstIndex;
+    std::int32_t    vertexOffset;
+    std::uint32_t   firstInstance;
+};
+
+struct BatchDispatch
+{
+    std::uint32_t   groupSizeX;
+    std::uint32_t   groupSizeY;
+    std::uint32_t   groupSizeZ;
+};
+
+// Encodes all batched commands without any transition back into managed code.
+static void ExecuteNativeCommandBatch(LLGL::CommandBuffer& cmdBuffer, const char* data, std::size_t size)
+{
+    const char* end = data + size;
+    while (data < end)
+    {
+        const BatchCommand* cmd = reinterpret_cast<const BatchCommand*>(data);
+        const void* payload = (cmd + 1);
+
+        switch (cmd->opcode)
+        {
+            case BatchOpcode::UpdateBuffer:
+            {
+                auto* cmdData = reinterpret_cast<const BatchUpdateBuffer*>(payload);
+                cmdBuffer.UpdateBuffer(*cmdData->buffer, cmdData->offset, cmdData + 1, cmdData->dataSize);
+            }
+            break;
+
+            case BatchOpcode::SetVertexBuffer:
+            {
+                auto* cmdData = reinterpret_cast<const BatchSetBuffer*>(payload);
+                cmdBuffer.SetVertexBuffer(*cmdData->buffer);
+            }
+            break;
+
+            case BatchOpcode::SetIndexBuffer:
+            {
+                auto* cmdData = reinterpret_cast<const BatchSetBuffer*>(payload);
+                cmdBuffer.SetIndexBuffer(*cmdData->buffer);
+            }
+            break;
+
+            case BatchOpcode::SetResourceHeap:
+            {
+                auto* cmdData = reinterpret_cast<const BatchSetResourceHeap*>(payload);
+                cmdBuffer.SetResourceHeap(*cmdData->resourceHeap, cmdData->firstSet);
+            }
+            break;
+
+            case BatchOpcode::SetPipelineState:
+            {
+                auto* cmdData = reinterpret_cast<const BatchSetPipelineState*>(payload);
+                cmdBuffer.SetPipelineState(*cmdData->pipelineState);
+            }
+            break;
+
+            case BatchOpcode::Draw:
+            {
+                auto* cmdData = reinterpret_cast<const BatchDraw*>(payload);
+                cmdBuffer.Draw(cmdData->numVertices, cmdData->firstVertex);
+            }
+            break;
+
+            case BatchOpcode::DrawInstanced:
+            {
+                auto* cmdData = reinterpret_cast<const BatchDraw*>(payload);
+                cmdBuffer.DrawInstanced(cmdData->numVertices, cmdData->firstVertex, cmdData->numInstances, cmdData->firstInstance);
+            }
+            break;
+
+            case BatchOpcode::DrawIndexed:
+            {
+                auto* cmdData = reinterpret_cast<const BatchDrawIndexed*>(payload);
+                cmdBuffer.DrawIndexed(cmdData->numIndices, cmdData->firstIndex, cmdData->vertexOffset);
+            }
+            break;
+
+            case BatchOpcode::DrawIndexedInstanced:
+            {
+                auto* cmdData = reinterpret_cast<const BatchDrawIndexed*>(payload);
+                cmdBuffer.DrawIndexedInstanced(cmdData->numIndices, cmdData->numInstances, cmdData->firstIndex, cmdData->vertexOffset, cmdData->firstInstance);
+            }
+            break;
+
+            case BatchOpcode::Dispatch:
+            {
+                auto* cmdData = reinterpret_cast<const BatchDispatch*>(payload);
+                cmdBuffer.Dispatch(cmdData->groupSizeX, cmdData->groupSizeY, cmdData->groupSizeZ);
+            }
+            break;
+        }
+
+        data += cmd->size;
+    }
+}
+
+
+} // /namespace SharpLLGL
+
+#pragma managed
+
+
+namespace SharpLLGL
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Appends a new command with the specified payload size to the batch and returns a pointer to its payload.
+static void* AllocBatchCommand(std::vector<char>& data, BatchOpcode opcode, std::size_t payloadSize)
+{
+    const std::size_t cmdSize   = (sizeof(BatchCommand) + payloadSize + 7u) & ~static_cast<std::size_t>(7u);
+    const std::size_t offset    = data.size();
+
+    data.resize(offset + cmdSize);
+
+    BatchCommand* cmd = reinterpret_cast<BatchCommand*>(data.data() + offset);
+    {
+        cmd->opcode = opcode;
+        cmd->size   = static_cast<std::uint32_t>(cmdSize);
+    }
+    return (cmd + 1);
+}
+
+template <typename T>
+static T* AllocBatchCommand(std::vector<char>& data, BatchOpcode opcode)
+{
+    return static_cast<T*>(AllocBatchCommand(data, opcode, sizeof(T)));
+}
+
+
+/*
+ * CommandBatch class
+ */
+
+CommandBatch::CommandBatch() :
+    data_ { new std::vector<char>() }
+{
+}
+
+CommandBatch::~CommandBatch()
+{
+    this->!CommandBatch();
+}
+
+CommandBatch::!CommandBatch()
+{
+    delete data_;
+    data_ = nullptr;
+}
+
+void CommandBatch::Clear()
+{
+    data_->clear();
+    numCommands_ = 0;
+}
+
+int CommandBatch::NumCommands::get()
+{
+    return numCommands_;
+}
+
+/* ----- Buffers ----- */
+
+generic <typename T>
+void CommandBatch::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data)
+{
+    UpdateBuffer(dstBuffer, dstOffset, data, 0, data->Length);
+}
+
+generic <typename T>
+void CommandBatch::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data, int startIndex, int count)
+{
+    if (count > 0)
+    {
+        pin_ptr<T> dataRef = &data[startIndex];
+        UpdateBuffer(dstBuffer, dstOffset, System::IntPtr(static_cast<void*>(dataRef)), static_cast<System::UInt16>(count * sizeof(T)));
+    }
+}
+
+void CommandBatch::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, System::IntPtr data, System::UInt16 dataSize)
+{
+    auto* cmd = static_cast<BatchUpdateBuffer*>(AllocBatchCommand(*data_, BatchOpcode::UpdateBuffer, sizeof(BatchUpdateBuffer) + dataSize));
+    {
+        cmd->buffer     = dstBuffer->NativeSub;
+        cmd->offset     = dstOffset;
+        cmd->dataSize   = dataSize;
+    }
+
+    /* Copy data with a managed memory copy to avoid a transition into the native CRT */
+    System::Buffer::MemoryCopy(data.ToPointer(), cmd + 1, dataSize, dataSize);
+    ++numCommands_;
+}
+
+/* ----- Input Assembly ------ */
+
+void CommandBatch::SetVertexBuffer(Buffer^ buffer)
+{
+    auto* cmd = AllocBatchCommand<BatchSetBuffer>(*data_, BatchOpcode::SetVertexBuffer);
+    cmd->buffer = buffer->NativeSub;
+    ++numCommands_;
+}
+
+void CommandBatch::SetIndexBuffer(Buffer^ buffer)
+{
+    auto* cmd = AllocBatchCommand<BatchSetBuffer>(*data_, BatchOpcode::SetIndexBuffer);
+    cmd->buffer = buffer->NativeSub;
+    ++numCommands_;
+}
+
+/* ----- Resource Heaps ----- */
+
+void CommandBatch::SetResourceHeap(ResourceHeap^ resourceHeap)
+{
+    SetResourceHeap(resourceHeap, 0);
+}
+
+void CommandBatch::SetResourceHeap(ResourceHeap^ resourceHeap, unsigned int firstSet)
+{
+    auto* cmd = AllocBatchCommand<BatchSetResourceHeap>(*data_, BatchOpcode::SetResourceHeap);
+    {
+        cmd->resourceHeap   = resourceHeap->Native;
+        cmd->firstSet       = firstSet;
+    }
+    ++numCommands_;
+}
+
+/* ----- Pipeline States ----- */
+
+void CommandBatch::SetPipelineState(PipelineState^ pipelineState)
+{
+    auto* cmd = AllocBatchCommand<BatchSetPipelineState>(*data_, BatchOpcode::SetPipelineState);
+    cmd->pipelineState = pipelineState->Native;
+    ++numCommands_;
+}
+
+/* ----- Drawing ----- */
+
+void CommandBatch::Draw(unsigned int numVertices, unsigned int firstVertex)
+{
+    auto* cmd = AllocBatchCommand<BatchDraw>(*data_, BatchOpcode::Draw);
+    {
+        cmd->numVertices    = numVertices;
+        cmd->firstVertex    = firstVertex;
+        cmd->numInstances   = 1;
+        cmd->firstInstance  = 0;
+    }
+    ++numCommands_;
+}
+
+void CommandBatch::DrawIndexed(unsigned int numIndices, unsigned int firstIndex)
+{
+    DrawIndexed(numIndices, firstIndex, 0);
+}
+
+void CommandBatch::DrawIndexed(unsigned int numIndices, unsigned int firstIndex, int vertexOffset)
+{
+    auto* cmd = AllocBatchCommand<BatchDrawIndexed>(*data_, BatchOpcode::DrawIndexed);
+    {
+        cmd->numIndices     = numIndices;
+        cmd->numInstances   = 1;
+        cmd->firstIndex     = firstIndex;
+        cmd->vertexOffset   = vertexOffset;
+        cmd->firstInstance  = 0;
+    }
+    ++numCommands_;
+}
+
+void CommandBatch::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances)
+{
+    DrawInstanced(numVertices, firstVertex, numInstances, 0);
+}
+
+void CommandBatch::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int firstInstance)
+{
+    auto* cmd = AllocBatchCommand<BatchDraw>(*data_, BatchOpcode::DrawInstanced);
+    {
+        cmd->numVertices    = numVertices;
+        cmd->firstVertex    = firstVertex;
+        cmd->numInstances   = numInstances;
+        cmd->firstInstance  = firstInstance;
+    }
+    ++numCommands_;
+}
+
+void CommandBatch::DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex)
+{
+    DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+}
+
+void CommandBatch::DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int firstInstance)
+{
+    auto* cmd = AllocBatchCommand<BatchDrawIndexed>(*data_, BatchOpcode::DrawIndexedInstanced);
+    {
+        cmd->numIndices     = numIndices;
+        cmd->numInstances   = numInstances;
+        cmd->firstIndex     = firstIndex;
+        cmd->vertexOffset   = vertexOffset;
+        cmd->firstInstance  = firstInstance;
+    }
+    ++numCommands_;
+}
+
+/* ----- Compute ----- */
+
+void CommandBatch::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ)
+{
+    auto* cmd = AllocBatchCommand<BatchDispatch>(*data_, BatchOpcode::Dispatch);
+    {
+        cmd->groupSizeX = groupSizeX;
+        cmd->groupSizeY = groupSizeY;
+        cmd->groupSizeZ = groupSizeZ;
+    }
+    ++numCommands_;
+}
+
+/* ----- Internal ----- */
+
+void CommandBatch::Execute(LLGL::CommandBuffer& commandBuffer)
+{
+    if (!data_->empty())
+        ExecuteNativeCommandBatch(commandBuffer, data_->data(), data_->size());
+}
+
+
+} // /namespace SharpLLGL
+
+
+
+// ================================================================================
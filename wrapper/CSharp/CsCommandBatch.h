@@ -0,0 +1,106 @@
+/*
+ * CsCommandBatch.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#pragma once
+
+#include <vcclr.h>
+#include <vector>
+#include <LLGL/CommandBuffer.h>
+#include "CsRenderSystemChild.h"
+
+#using <System.dll>
+#using <System.Core.dll>
+#using <System.Runtime.InteropServices.dll>
+
+
+using namespace System;
+using namespace System::Runtime::InteropServices;
+
+
+namespace SharpLLGL
+{
+
+
+/// <summary>
+/// Records commands into unmanaged memory without calling into the native command buffer.
+/// All recorded commands are encoded into a command buffer with a single managed-to-native transition (see CommandBuffer.ExecuteBatch).
+/// </summary>
+public ref class CommandBatch
+{
+
+    public:
+
+        CommandBatch();
+        ~CommandBatch();
+        !CommandBatch();
+
+        /// <summary>Removes all recorded commands. The batch keeps its memory for the next frame.</summary>
+        void Clear();
+
+        /// <summary>Returns the number of recorded commands.</summary>
+        property int NumCommands
+        {
+            int get();
+        }
+
+        /* ----- Buffers ----- */
+
+        generic <typename T>
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data);
+
+        generic <typename T>
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data, int startIndex, int count);
+
+        /// <summary>Copies the data from unmanaged memory, e.g. a pinned Span, into the batch.</summary>
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, System::IntPtr data, System::UInt16 dataSize);
+
+        /* ----- Input Assembly ------ */
+
+        void SetVertexBuffer(Buffer^ buffer);
+        void SetIndexBuffer(Buffer^ buffer);
+
+        /* ----- Resource Heaps ----- */
+
+        void SetResourceHeap(ResourceHeap^ resourceHeap);
+        void SetResourceHeap(ResourceHeap^ resourceHeap, unsigned int firstSet);
+
+        /* ----- Pipeline States ----- */
+
+        void SetPipelineState(PipelineState^ pipelineState);
+
+        /* ----- Drawing ----- */
+
+        void Draw(unsigned int numVertices, unsigned int firstVertex);
+        void DrawIndexed(unsigned int numIndices, unsigned int firstIndex);
+        void DrawIndexed(unsigned int numIndices, unsigned int firstIndex, int vertexOffset);
+        void DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances);
+        void DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int firstInstance);
+        void DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex);
+        void DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int firstInstance);
+
+        /* ----- Compute ----- */
+
+        void Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ);
+
+    internal:
+
+        // Encodes all recorded commands into the specified native command buffer.
+        void Execute(LLGL::CommandBuffer& commandBuffer);
+
+    private:
+
+        std::vector<char>*  data_           = nullptr;
+        int                 numCommands_    = 0;
+
+};
+
+
+} // /namespace SharpLLGL
+
+
+
+// ================================================================================
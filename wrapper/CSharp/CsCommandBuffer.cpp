@@ -59,8 +59,23 @@ void CommandBuffer::End()
 generic <typename T>
 void CommandBuffer::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data)
 {
-    pin_ptr<T> dataRef = &data[0];
-    native_->UpdateBuffer(*(dstBuffer->NativeSub), dstOffset, dataRef, static_cast<std::uint16_t>(data->Length * sizeof(T)));
+    UpdateBuffer(dstBuffer, dstOffset, data, 0, data->Length);
+}
+
+generic <typename T>
+void CommandBuffer::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data, int startIndex, int count)
+{
+    if (count > 0)
+    {
+        /* Pin managed array only for the duration of this call; the data is passed to the backend without a copy */
+        pin_ptr<T> dataRef = &data[startIndex];
+        native_->UpdateBuffer(*(dstBuffer->NativeSub), dstOffset, dataRef, static_cast<std::uint16_t>(count * sizeof(T)));
+    }
+}
+
+void CommandBuffer::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, System::IntPtr data, System::UInt16 dataSize)
+{
+    native_->UpdateBuffer(*(dstBuffer->NativeSub), dstOffset, data.ToPointer(), dataSize);
 }
 
 void CommandBuffer::CopyBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, Buffer^ srcBuffer, System::UInt64 srcOffset, System::UInt64 size)
@@ -380,6 +395,13 @@ void CommandBuffer::PopDebugGroup()
     native_->PopDebugGroup();
 }
 
+/* ----- Batches ----- */
+
+void CommandBuffer::ExecuteBatch(CommandBatch^ batch)
+{
+    batch->Execute(*native_);
+}
+
 /* ----- Extensions ----- */
 
 generic <typename T>
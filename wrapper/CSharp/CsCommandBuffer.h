@@ -15,6 +15,7 @@
 #include "CsPipelineStateFlags.h"
 #include "CsRenderTarget.h"
 #include "CsColor.h"
+#include "CsCommandBatch.h"
 
 #using <System.dll>
 #using <System.Core.dll>
@@ -53,6 +54,12 @@ public ref class CommandBuffer
         generic <typename T>
         void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data);
 
+        generic <typename T>
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data, int startIndex, int count);
+
+        /// <summary>Updates the buffer with data from unmanaged memory, e.g. a pinned Span, without any intermediate copy.</summary>
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, System::IntPtr data, System::UInt16 dataSize);
+
         void CopyBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, Buffer^ srcBuffer, System::UInt64 srcOffset, System::UInt64 size);
 
         void FillBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, unsigned int value, System::UInt64 fillSize /*= Constants::wholeSize*/);
@@ -149,6 +156,11 @@ public ref class CommandBuffer
         void PushDebugGroup(String^ name);
         void PopDebugGroup();
 
+        /* ----- Batches ----- */
+
+        /// <summary>Encodes all commands of the specified batch with a single managed-to-native transition.</summary>
+        void ExecuteBatch(CommandBatch^ batch);
+
         /* ----- Extensions ----- */
 
         generic <typename T>
@@ -61,6 +61,16 @@ static void Convert(LLGL::Extent3D& dst, Extent3D^ src)
     }
 }
 
+static void Convert(LLGL::Offset3D& dst, Offset3D^ src)
+{
+    if (src)
+    {
+        dst.x       = src->X;
+        dst.y       = src->Y;
+        dst.z       = src->Z;
+    }
+}
+
 
 /*
  * Internal classes
@@ -259,6 +269,7 @@ static void Convert(LLGL::SwapChainDescriptor& dst, SwapChainDescriptor^ src)
         dst.stencilBits         = src->StencilBits;
         dst.swapBuffers         = src->SwapBuffers;
         dst.fullscreen          = src->Fullscreen;
+        dst.presentMode         = static_cast<LLGL::PresentMode>(src->PresentMode);
     }
 }
 
@@ -435,8 +446,61 @@ void RenderSystem::Release(Texture^ texture)
     native_->Release(*texture->NativeSub);
 }
 
+static void Convert(LLGL::TextureSubresource& dst, TextureSubresource^ src)
+{
+    if (src)
+    {
+        dst.baseArrayLayer  = src->BaseArrayLayer;
+        dst.numArrayLayers  = src->NumArrayLayers;
+        dst.baseMipLevel    = src->BaseMipLevel;
+        dst.numMipLevels    = src->NumMipLevels;
+    }
+}
+
+static void Convert(LLGL::TextureRegion& dst, TextureRegion^ src)
+{
+    if (src)
+    {
+        Convert(dst.subresource, src->Subresource);
+        Convert(dst.offset, src->Offset);
+        Convert(dst.extent, src->Extent);
+    }
+}
+
+generic <typename T>
+void RenderSystem::WriteTexture(Texture^ texture, TextureRegion^ textureRegion, SrcImageDescriptor<T>^ imageDesc)
+{
+    if (imageDesc->Data == nullptr || imageDesc->Data->Length == 0)
+        return;
+
+    /* Pin managed array only for the duration of this call; the image data is passed to the backend without a copy */
+    pin_ptr<T> imageDataRef = &(imageDesc->Data[0]);
+    WriteTexture(
+        texture,
+        textureRegion,
+        imageDesc->Format,
+        imageDesc->DataType,
+        System::IntPtr(static_cast<void*>(imageDataRef)),
+        static_cast<System::UInt64>(imageDesc->Data->Length) * sizeof(T)
+    );
+}
+
+void RenderSystem::WriteTexture(Texture^ texture, TextureRegion^ textureRegion, ImageFormat format, DataType dataType, System::IntPtr data, System::UInt64 dataSize)
+{
+    LLGL::TextureRegion nativeTextureRegion;
+    Convert(nativeTextureRegion, textureRegion);
+
+    LLGL::SrcImageDescriptor nativeImageDesc;
+    {
+        nativeImageDesc.format      = static_cast<LLGL::ImageFormat>(format);
+        nativeImageDesc.dataType    = static_cast<LLGL::DataType>(dataType);
+        nativeImageDesc.data        = data.ToPointer();
+        nativeImageDesc.dataSize    = static_cast<std::size_t>(dataSize);
+    }
+    native_->WriteTexture(*texture->NativeSub, nativeTextureRegion, nativeImageDesc);
+}
+
 #if 0
-void RenderSystem::WriteTexture(Texture^ texture, SubTextureDescriptor^ subTextureDesc, SrcImageDescriptor^ imageDesc);
 void RenderSystem::ReadTexture(Texture^ texture, unsigned int mipLevel, DstImageDescriptor^ imageDesc);
 #endif
 
@@ -145,10 +145,13 @@ public ref class RenderSystem
 
         void Release(Texture^ texture);
 
-        #if 0
         generic <typename T>
         void WriteTexture(Texture^ texture, TextureRegion^ textureRegion, SrcImageDescriptor<T>^ imageDesc);
 
+        /// <summary>Writes the image data from unmanaged memory, e.g. a pinned Span, into the texture region without any intermediate copy.</summary>
+        void WriteTexture(Texture^ texture, TextureRegion^ textureRegion, ImageFormat format, DataType dataType, System::IntPtr data, System::UInt64 dataSize);
+
+        #if 0
         generic <typename T>
         void ReadTexture(Texture^ texture, unsigned int mipLevel, DstImageDescriptor<T>^ imageDesc);
         #endif
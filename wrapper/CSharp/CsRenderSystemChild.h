@@ -43,6 +43,7 @@ public enum class QueryType
     StreamOutPrimitivesWritten,
     StreamOutOverflow,
     PipelineStatistics,
+    Timestamp,
 };
 
 public ref class Resource
@@ -31,6 +31,7 @@ public enum class ResourceType
     Buffer,
     Texture,
     Sampler,
+    AccelerationStructure,
 };
 
 
@@ -52,6 +53,8 @@ public enum class BindFlags
     CombinedSampler         = (1 << 9),
     CopySrc                 = (1 << 10),
     CopyDst                 = (1 << 11),
+    ShadingRateAttachment   = (1 << 12),
+    DeviceAddress           = (1 << 13),
 };
 
 [Flags]
@@ -73,6 +76,10 @@ public enum class MiscFlags
     NoInitialData   = (1 << 3),
     Append          = (1 << 4),
     Counter         = (1 << 5),
+    Sparse          = (1 << 6),
+    Transient       = (1 << 7),
+    HostVisible     = (1 << 8),
+    External        = (1 << 9),
 };
 
 
@@ -34,6 +34,8 @@ public enum class ShaderType
     Geometry,
     Fragment,
     Compute,
+    Task,
+    Mesh,
 };
 
 public enum class ShaderSourceType
@@ -59,6 +61,7 @@ public enum class ShaderCompileFlags
     WarningsAreErrors   = (1 << 5),
     PatchClippingOrigin = (1 << 6),
     SeparateShader      = (1 << 7),
+    StripBinary         = (1 << 8),
 };
 
 [Flags]
@@ -71,9 +74,12 @@ public enum class StageFlags
     GeometryStage       = (1 << 3),
     FragmentStage       = (1 << 4),
     ComputeStage        = (1 << 5),
+    TaskStage           = (1 << 6),
+    MeshStage           = (1 << 7),
 
     AllTessStages       = (TessControlStage | TessEvaluationStage),
     AllGraphicsStages   = (VertexStage | AllTessStages | GeometryStage | FragmentStage),
+    AllMeshStages       = (TaskStage | MeshStage),
     AllStages           = (AllGraphicsStages | ComputeStage),
 };
 
@@ -43,6 +43,11 @@ bool SwapChain::SwitchFullscreen(bool Enable)
     return static_cast<LLGL::SwapChain*>(Native)->SwitchFullscreen(Enable);
 }
 
+bool SwapChain::IsPresentModeSupported(PresentMode Mode)
+{
+    return static_cast<LLGL::SwapChain*>(Native)->IsPresentModeSupported(static_cast<LLGL::PresentMode>(Mode));
+}
+
 /* ----- Configuration ----- */
 
 static void Convert(SwapChainDescriptor^ dst, const LLGL::SwapChainDescriptor& src)
@@ -55,6 +60,7 @@ static void Convert(SwapChainDescriptor^ dst, const LLGL::SwapChainDescriptor& s
     dst->StencilBits        = src.stencilBits;
     dst->SwapBuffers        = src.swapBuffers;
     dst->Fullscreen         = src.fullscreen;
+    dst->PresentMode        = static_cast<SharpLLGL::PresentMode>(src.presentMode);
 }
 
 void SwapChain::VsyncInterval::set(unsigned int value)
@@ -62,6 +68,11 @@ void SwapChain::VsyncInterval::set(unsigned int value)
     static_cast<LLGL::SwapChain*>(Native)->SetVsyncInterval(value);
 }
 
+void SwapChain::MaxFrameLatency::set(unsigned int value)
+{
+    static_cast<LLGL::SwapChain*>(Native)->SetMaxFrameLatency(value);
+}
+
 
 } // /namespace SharpLLGL
 
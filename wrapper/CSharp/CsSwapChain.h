@@ -46,6 +46,8 @@ public ref class SwapChain : public RenderTarget
 
         bool SwitchFullscreen(bool Enable);
 
+        bool IsPresentModeSupported(PresentMode Mode);
+
         property Window^ Surface
         {
             Window^ get();
@@ -58,6 +60,11 @@ public ref class SwapChain : public RenderTarget
             void set(unsigned int value);
         };
 
+        property unsigned int MaxFrameLatency
+        {
+            void set(unsigned int value);
+        };
+
     private:
 
         Window^ surface_ = nullptr;
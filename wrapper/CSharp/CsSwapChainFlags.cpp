@@ -28,6 +28,7 @@ SwapChainDescriptor::SwapChainDescriptor()
     StencilBits = 8;
     SwapBuffers = 2;
     Fullscreen  = false;
+    PresentMode = SharpLLGL::PresentMode::Default;
 }
 
 
@@ -26,6 +26,16 @@ public enum class OpenGLContextProfile
 };
 
 
+public enum class PresentMode
+{
+    Default,
+    Fifo,
+    FifoRelaxed,
+    Mailbox,
+    Immediate,
+};
+
+
 /* ----- Flags ----- */
 
 [Flags]
@@ -54,6 +64,7 @@ public ref class SwapChainDescriptor
         property int            StencilBits;
         property unsigned int   SwapBuffers;
         property bool           Fullscreen;
+        property PresentMode    PresentMode;
 
 };
 